@@ -5,5 +5,7 @@ namespace noisepage {
 // Instantiating the static variables in BenchmarkConfig here so that we don't have linker errors
 uint32_t BenchmarkConfig::num_threads = 1;
 std::string_view BenchmarkConfig::logfile_path = "/tmp/noisepage-benchmark.log";
+double BenchmarkConfig::scale_factor = 0.01;
+std::string_view BenchmarkConfig::results_path = "./benchmark_results.json";
 
 }  // namespace noisepage
@@ -34,6 +34,12 @@ int main(int argc, char **argv) {
   const char *env_logfile_path = std::getenv(noisepage::ENV_LOGFILE_PATH);
   if (env_logfile_path != nullptr) noisepage::BenchmarkConfig::logfile_path = std::string_view(env_logfile_path);
 
+  const char *env_scale_factor = std::getenv(noisepage::ENV_SCALE_FACTOR);
+  if (env_scale_factor != nullptr) noisepage::BenchmarkConfig::scale_factor = atof(env_scale_factor);
+
+  const char *env_results_path = std::getenv(noisepage::ENV_RESULTS_PATH);
+  if (env_results_path != nullptr) noisepage::BenchmarkConfig::results_path = std::string_view(env_results_path);
+
   benchmark::Initialize(&argc, argv);
   benchmark::RunSpecifiedBenchmarks();
 
@@ -0,0 +1,83 @@
+#include "benchmark_util/benchmark_results.h"
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cmath>
+#include <ctime>
+#include <fstream>
+#include <numeric>
+#include <thread>  // NOLINT
+#include <utility>
+
+#include "common/macros.h"
+
+namespace noisepage {
+
+void BenchmarkResults::AddResult(const Configuration &config, const uint64_t elapsed_us,
+                                 std::vector<uint64_t> latencies_us) {
+  auto result = ConfigurationToJson(config);
+  result["status"] = "ok";
+  result["error"] = "";
+  result["executions"] = latencies_us.size();
+  result["elapsed_us"] = elapsed_us;
+  result["throughput"] =
+      elapsed_us == 0 ? 0.0 : static_cast<double>(latencies_us.size()) * 1e6 / static_cast<double>(elapsed_us);
+
+  nlohmann::json latency = {{"mean", 0.0}, {"p50", 0}, {"p90", 0}, {"p99", 0}, {"max", 0}};
+  if (!latencies_us.empty()) {
+    std::sort(latencies_us.begin(), latencies_us.end());
+    latency["mean"] = std::accumulate(latencies_us.begin(), latencies_us.end(), 0.0) /
+                      static_cast<double>(latencies_us.size());
+    latency["p50"] = Percentile(latencies_us, 50);
+    latency["p90"] = Percentile(latencies_us, 90);
+    latency["p99"] = Percentile(latencies_us, 99);
+    latency["max"] = latencies_us.back();
+  }
+  result["latency_us"] = std::move(latency);
+
+  std::lock_guard<std::mutex> guard(latch_);
+  results_.emplace_back(std::move(result));
+}
+
+void BenchmarkResults::AddFailure(const Configuration &config, const std::string &status, const std::string &error) {
+  NOISEPAGE_ASSERT(status != "ok", "A failed configuration needs a status that tells why");
+  auto result = ConfigurationToJson(config);
+  result["status"] = status;
+  result["error"] = error;
+
+  std::lock_guard<std::mutex> guard(latch_);
+  results_.emplace_back(std::move(result));
+}
+
+nlohmann::json BenchmarkResults::ToJson() const {
+  char timestamp[32];
+  const std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+  std::tm utc{};
+  gmtime_r(&now, &utc);
+  std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", &utc);
+
+  std::lock_guard<std::mutex> guard(latch_);
+  return {{"schema_version", SCHEMA_VERSION},
+          {"timestamp", timestamp},
+          {"hardware_concurrency", std::thread::hardware_concurrency()},
+          {"results", results_}};
+}
+
+void BenchmarkResults::Write(const std::string &path) const {
+  std::ofstream file(path, std::ios_base::trunc);
+  file << ToJson().dump(2) << '\n';
+}
+
+uint64_t BenchmarkResults::Percentile(const std::vector<uint64_t> &sorted_latencies, const double percentile) {
+  NOISEPAGE_ASSERT(!sorted_latencies.empty(), "There is no percentile of no latencies");
+  const auto rank = static_cast<size_t>(std::ceil(percentile / 100 * static_cast<double>(sorted_latencies.size())));
+  return sorted_latencies[std::clamp<size_t>(rank, 1, sorted_latencies.size()) - 1];
+}
+
+nlohmann::json BenchmarkResults::ConfigurationToJson(const Configuration &config) {
+  return {{"benchmark", config.benchmark_},     {"workload", config.workload_},
+          {"mode", config.mode_},               {"num_threads", config.num_threads_},
+          {"scale_factor", config.scale_factor_}, {"logging", config.logging_}};
+}
+
+}  // namespace noisepage
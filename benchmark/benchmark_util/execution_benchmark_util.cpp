@@ -0,0 +1,15 @@
+#include "benchmark_util/execution_benchmark_util.h"
+
+namespace noisepage::execution {
+
+std::unique_ptr<exec::ExecutionContext> ExecutionBenchmarkUtil::MakeExecCtx(const uint32_t num_threads) {
+  // The context keeps a reference to its callback
+  static const exec::OutputCallback empty_callback = nullptr;
+  exec::ExecutionSettings exec_settings{};
+  exec_settings.is_parallel_execution_enabled_ = num_threads > 1;
+  exec_settings.number_of_parallel_execution_threads_ = static_cast<int>(num_threads);
+  return std::make_unique<exec::ExecutionContext>(catalog::db_oid_t(0), nullptr, empty_callback, nullptr, nullptr,
+                                                  exec_settings, nullptr, nullptr, nullptr);
+}
+
+}  // namespace noisepage::execution
@@ -0,0 +1,53 @@
+#include "benchmark/benchmark.h"
+#include "common/big_reader_latch.h"
+#include "common/shared_latch.h"
+
+namespace noisepage {
+
+/**
+ * These benchmarks compare the SharedLatch and the BigReaderLatch on read-mostly workloads, from 1 to 64 threads that
+ * latch the same latch. The argument is the number of latchings per exclusive latching, on the first thread only, or 0
+ * for read-only workloads.
+ */
+class SharedLatchBenchmark : public benchmark::Fixture {
+ public:
+  /** Latch one of the latches in a loop, mostly in shared mode */
+  template <typename Latch>
+  void ReadMostly(benchmark::State *state, Latch *latch) {
+    const auto write_interval = static_cast<uint64_t>(state->range(0));
+    uint64_t sum = 0;
+    uint64_t num_latchings = 0;
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      if (write_interval != 0 && state->thread_index == 0 && ++num_latchings % write_interval == 0) {
+        typename Latch::ScopedExclusiveLatch guard(latch);
+        value_++;
+      } else {
+        typename Latch::ScopedSharedLatch guard(latch);
+        sum += value_;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+    state->SetItemsProcessed(state->iterations());
+  }
+
+  /** The latch that wraps std::shared_mutex */
+  common::SharedLatch shared_latch_;
+  /** The latch with per-slot reader counters */
+  common::BigReaderLatch big_reader_latch_;
+  /** The value that the latches protect */
+  uint64_t value_ = 0;
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(SharedLatchBenchmark, SharedLatch)(benchmark::State &state) { ReadMostly(&state, &shared_latch_); }
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(SharedLatchBenchmark, BigReaderLatch)(benchmark::State &state) {
+  ReadMostly(&state, &big_reader_latch_);
+}
+
+BENCHMARK_REGISTER_F(SharedLatchBenchmark, SharedLatch)->Arg(0)->Arg(10000)->ThreadRange(1, 64)->UseRealTime();
+
+BENCHMARK_REGISTER_F(SharedLatchBenchmark, BigReaderLatch)->Arg(0)->Arg(10000)->ThreadRange(1, 64)->UseRealTime();
+}  // namespace noisepage
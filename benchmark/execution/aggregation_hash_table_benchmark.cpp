@@ -0,0 +1,241 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "benchmark_util/execution_benchmark_util.h"
+#include "common/scoped_timer.h"
+#include "execution/sql/aggregation_hash_table.h"
+#include "execution/sql/thread_state_container.h"
+#include "execution/sql/vector_projection.h"
+#include "execution/sql/vector_projection_iterator.h"
+
+namespace noisepage::execution::sql {
+
+/**
+ * These benchmarks count the rows of every group with AggregationHashTable::ProcessBatch(), with grouping keys of
+ * different types and numbers of columns. The first argument is the number of distinct groups in the input, which
+ * always has NUM_INPUT_TUPLES rows in random order. The parallel aggregation takes the number of threads as a second
+ * argument: every thread aggregates a share of the input into its own partitioned table, and the partitions are then
+ * merged in parallel.
+ */
+class AggregationHashTableBenchmark : public benchmark::Fixture {
+ public:
+  /** The number of input rows */
+  static constexpr uint32_t NUM_INPUT_TUPLES = 1 << 22;
+
+  /** Aggregate the input into one table */
+  template <typename KeyT, uint32_t NumKeys>
+  void Aggregate(benchmark::State *state) {
+    const auto num_groups = static_cast<uint32_t>(state->range(0));
+    const auto keys = MakeKeys<KeyT, NumKeys>(num_groups);
+    auto exec_ctx = ExecutionBenchmarkUtil::MakeExecCtx(1);
+
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      AggregationHashTable aht(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Agg<KeyT, NumKeys>));
+      uint64_t elapsed_us;
+      {
+        common::ScopedTimer<std::chrono::microseconds> timer(&elapsed_us);
+        ProcessInput<KeyT, NumKeys>(&aht, keys, 0, NUM_INPUT_TUPLES, false);
+      }
+      state->SetIterationTime(static_cast<double>(elapsed_us) / 1000000.0);
+      benchmark::DoNotOptimize(aht.GetTupleCount());
+    }
+    state->SetItemsProcessed(state->iterations() * NUM_INPUT_TUPLES);
+  }
+
+  /** Aggregate the input into thread-local tables, and merge their partitions */
+  template <typename KeyT, uint32_t NumKeys>
+  void ParallelAggregate(benchmark::State *state) {
+    const auto num_groups = static_cast<uint32_t>(state->range(0));
+    const auto num_threads = static_cast<uint32_t>(state->range(1));
+    const auto keys = MakeKeys<KeyT, NumKeys>(num_groups);
+    auto exec_ctx = ExecutionBenchmarkUtil::MakeExecCtx(num_threads);
+
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      ThreadStateContainer container(exec_ctx->GetMemoryPool());
+      container.Reset(
+          sizeof(AggregationHashTable),
+          [](void *ctx, void *s) {
+            auto *exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+            new (s) AggregationHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(Agg<KeyT, NumKeys>));
+          },
+          [](void *ctx, void *s) { std::destroy_at(reinterpret_cast<AggregationHashTable *>(s)); }, exec_ctx.get());
+      AggregationHashTable main_aht(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Agg<KeyT, NumKeys>));
+      std::atomic<uint64_t> num_aggregates{0};
+
+      uint64_t elapsed_us;
+      {
+        common::ScopedTimer<std::chrono::microseconds> timer(&elapsed_us);
+        // Every thread takes a contiguous share of the batches
+        const uint32_t num_batches = NUM_INPUT_TUPLES / common::Constants::K_DEFAULT_VECTOR_SIZE;
+        ExecutionBenchmarkUtil::RunThreads(num_threads, [&](uint32_t thread_idx) {
+          const uint32_t begin = num_batches / num_threads * thread_idx;
+          const uint32_t end = thread_idx + 1 == num_threads ? num_batches : begin + num_batches / num_threads;
+          ProcessInput<KeyT, NumKeys>(container.AccessCurrentThreadStateAs<AggregationHashTable>(), keys,
+                                      begin * common::Constants::K_DEFAULT_VECTOR_SIZE,
+                                      end * common::Constants::K_DEFAULT_VECTOR_SIZE, true);
+        });
+        main_aht.TransferMemoryAndPartitions(&container, 0, MergePartition<KeyT, NumKeys>);
+        main_aht.ExecuteParallelPartitionedScan(
+            &num_aggregates, &container, [](void *query_state, void *thread_state, const AggregationHashTable *aht) {
+              *reinterpret_cast<std::atomic<uint64_t> *>(query_state) += aht->GetTupleCount();
+            });
+      }
+      state->SetIterationTime(static_cast<double>(elapsed_us) / 1000000.0);
+      benchmark::DoNotOptimize(num_aggregates.load());
+    }
+    state->SetItemsProcessed(state->iterations() * NUM_INPUT_TUPLES);
+  }
+
+ private:
+  /** The grouping keys are packed at the start of the payload, as ProcessBatch() expects */
+  template <typename KeyT, uint32_t NumKeys>
+  struct Agg {
+    KeyT keys_[NumKeys];
+    int64_t count_;
+  };
+
+  /** Make the keys of the input, one column after the other */
+  template <typename KeyT, uint32_t NumKeys>
+  static std::vector<KeyT> MakeKeys(uint32_t num_groups) {
+    std::vector<KeyT> keys(static_cast<std::size_t>(NUM_INPUT_TUPLES) * NumKeys);
+    std::mt19937 generator(num_groups);
+    std::uniform_int_distribution<uint32_t> distribution(0, num_groups - 1);
+    for (uint32_t i = 0; i < NUM_INPUT_TUPLES; i++) {
+      const uint32_t group = distribution(generator);
+      for (uint32_t k = 0; k < NumKeys; k++) {
+        keys[static_cast<std::size_t>(k) * NUM_INPUT_TUPLES + i] = static_cast<KeyT>(group) * (k + 1);
+      }
+    }
+    return keys;
+  }
+
+  /** Feed the rows in [begin, end) to the table one vector at a time */
+  template <typename KeyT, uint32_t NumKeys>
+  static void ProcessInput(AggregationHashTable *aht, const std::vector<KeyT> &keys, uint32_t begin, uint32_t end,
+                           bool partitioned) {
+    constexpr TypeId key_type = sizeof(KeyT) == sizeof(int64_t) ? TypeId::BigInt : TypeId::Integer;
+    std::vector<uint32_t> key_indexes(NumKeys);
+    for (uint32_t k = 0; k < NumKeys; k++) key_indexes[k] = k;
+
+    VectorProjection vector_projection;
+    vector_projection.Initialize(std::vector<TypeId>(NumKeys, key_type));
+    for (uint32_t offset = begin; offset < end; offset += common::Constants::K_DEFAULT_VECTOR_SIZE) {
+      const uint32_t size = std::min(end - offset, common::Constants::K_DEFAULT_VECTOR_SIZE);
+      vector_projection.Reset(size);
+      for (uint32_t k = 0; k < NumKeys; k++) {
+        const KeyT *column_keys = &keys[static_cast<std::size_t>(k) * NUM_INPUT_TUPLES + offset];
+        std::memcpy(vector_projection.GetColumn(k)->GetData(), column_keys, size * sizeof(KeyT));
+      }
+      VectorProjectionIterator vpi(&vector_projection);
+      aht->ProcessBatch(&vpi, key_indexes, InitAggs<KeyT, NumKeys>, AdvanceAggs<KeyT, NumKeys>, partitioned);
+    }
+  }
+
+  template <typename KeyT, uint32_t NumKeys>
+  static void InitAggs(VectorProjectionIterator *new_aggs, VectorProjectionIterator *input) {
+    VectorProjectionIterator::SynchronizedForEach({new_aggs, input}, [&]() {
+      auto *entry = *new_aggs->GetValue<HashTableEntry *, false>(1, nullptr);
+      auto *agg = const_cast<Agg<KeyT, NumKeys> *>(entry->PayloadAs<Agg<KeyT, NumKeys>>());
+      for (uint32_t k = 0; k < NumKeys; k++) agg->keys_[k] = *input->GetValue<KeyT, false>(k, nullptr);
+      agg->count_ = 0;
+    });
+  }
+
+  template <typename KeyT, uint32_t NumKeys>
+  static void AdvanceAggs(VectorProjectionIterator *aggs, VectorProjectionIterator *input) {
+    VectorProjectionIterator::SynchronizedForEach({aggs, input}, [&]() {
+      auto *entry = *aggs->GetValue<HashTableEntry *, false>(1, nullptr);
+      const_cast<Agg<KeyT, NumKeys> *>(entry->PayloadAs<Agg<KeyT, NumKeys>>())->count_++;
+    });
+  }
+
+  template <typename KeyT, uint32_t NumKeys>
+  static bool KeysEqual(const void *lhs, const void *rhs) {
+    return std::memcmp(lhs, rhs, sizeof(KeyT) * NumKeys) == 0;
+  }
+
+  template <typename KeyT, uint32_t NumKeys>
+  static void MergePartition(void *ctx, AggregationHashTable *table, AHTOverflowPartitionIterator *iter) {
+    for (; iter->HasNext(); iter->Next()) {
+      auto *partial = iter->GetRowAs<Agg<KeyT, NumKeys>>();
+      auto *existing =
+          reinterpret_cast<Agg<KeyT, NumKeys> *>(table->Lookup(iter->GetRowHash(), KeysEqual<KeyT, NumKeys>, partial));
+      if (existing != nullptr) {
+        existing->count_ += partial->count_;
+      } else {
+        table->Insert(iter->GetEntryForRow());
+      }
+    }
+  }
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(AggregationHashTableBenchmark, IntegerKey)(benchmark::State &state) {
+  Aggregate<int32_t, 1>(&state);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(AggregationHashTableBenchmark, BigIntKey)(benchmark::State &state) {
+  Aggregate<int64_t, 1>(&state);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(AggregationHashTableBenchmark, TwoIntegerKeys)(benchmark::State &state) {
+  Aggregate<int32_t, 2>(&state);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(AggregationHashTableBenchmark, FourBigIntKeys)(benchmark::State &state) {
+  Aggregate<int64_t, 4>(&state);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(AggregationHashTableBenchmark, ParallelBigIntKey)(benchmark::State &state) {
+  ParallelAggregate<int64_t, 1>(&state);
+}
+
+/** From a few groups that stay in the caches to as many groups as a quarter of the input */
+static void GroupArgs(benchmark::internal::Benchmark *b) {
+  for (const int64_t num_groups : {16, 1 << 10, 1 << 16, 1 << 20}) b->Arg(num_groups);
+}
+
+/** Few and many groups on one to eight threads */
+static void ParallelArgs(benchmark::internal::Benchmark *b) {
+  for (const int64_t num_groups : {1 << 10, 1 << 20}) {
+    for (const int64_t num_threads : {1, 2, 4, 8}) b->Args({num_groups, num_threads});
+  }
+}
+
+BENCHMARK_REGISTER_F(AggregationHashTableBenchmark, IntegerKey)
+    ->Apply(GroupArgs)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+BENCHMARK_REGISTER_F(AggregationHashTableBenchmark, BigIntKey)
+    ->Apply(GroupArgs)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+BENCHMARK_REGISTER_F(AggregationHashTableBenchmark, TwoIntegerKeys)
+    ->Apply(GroupArgs)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+BENCHMARK_REGISTER_F(AggregationHashTableBenchmark, FourBigIntKeys)
+    ->Apply(GroupArgs)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+BENCHMARK_REGISTER_F(AggregationHashTableBenchmark, ParallelBigIntKey)
+    ->Apply(ParallelArgs)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+}  // namespace noisepage::execution::sql
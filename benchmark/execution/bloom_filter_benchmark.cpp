@@ -0,0 +1,130 @@
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "common/hash_util.h"
+#include "common/scoped_timer.h"
+#include "execution/sql/bloom_filter.h"
+#include "execution/sql/memory_pool.h"
+#include "execution/sql/tuple_id_list.h"
+#include "execution/sql/vector.h"
+
+namespace noisepage::execution::sql {
+
+/**
+ * These benchmarks build a bloom filter and probe it with NUM_PROBES keys, half of which were added to it. The probes
+ * check one key at a time or a vector of hashes at a time. The argument is the number of keys in the filter, from
+ * filters that fit in the caches to filters that do not.
+ */
+class BloomFilterBenchmark : public benchmark::Fixture {
+ public:
+  /** The number of keys checked against the filter in every iteration */
+  static constexpr uint32_t NUM_PROBES = 1 << 22;
+
+  /** Make the hashes of the keys in the filter and of the probes */
+  void MakeHashes(uint32_t num_keys) {
+    std::mt19937_64 generator(num_keys);
+    keys_.resize(num_keys);
+    for (auto &key : keys_) key = common::HashUtil::Hash(generator());
+    std::uniform_int_distribution<uint32_t> key_idx(0, num_keys - 1);
+    probes_.resize(NUM_PROBES);
+    for (uint32_t i = 0; i < NUM_PROBES; i++) {
+      probes_[i] = i % 2 == 0 ? keys_[key_idx(generator)] : common::HashUtil::Hash(generator());
+    }
+  }
+
+  /** The hashes of the keys in the filter */
+  std::vector<hash_t> keys_;
+  /** The hashes of the probes */
+  std::vector<hash_t> probes_;
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(BloomFilterBenchmark, Build)(benchmark::State &state) {
+  MakeHashes(static_cast<uint32_t>(state.range(0)));
+  MemoryPool memory(nullptr);
+
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    uint64_t elapsed_us;
+    {
+      common::ScopedTimer<std::chrono::microseconds> timer(&elapsed_us);
+      BloomFilter filter(&memory, keys_.size());
+      for (const auto hash : keys_) filter.Add(hash);
+      benchmark::DoNotOptimize(filter.GetSizeInBytes());
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_us) / 1000000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * keys_.size());
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(BloomFilterBenchmark, Probe)(benchmark::State &state) {
+  MakeHashes(static_cast<uint32_t>(state.range(0)));
+  MemoryPool memory(nullptr);
+  BloomFilter filter(&memory, keys_.size());
+  for (const auto hash : keys_) filter.Add(hash);
+
+  uint64_t num_found = 0;
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    uint64_t elapsed_us;
+    {
+      common::ScopedTimer<std::chrono::microseconds> timer(&elapsed_us);
+      for (const auto hash : probes_) num_found += static_cast<uint64_t>(filter.Contains(hash));
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_us) / 1000000.0);
+  }
+  benchmark::DoNotOptimize(num_found);
+  state.SetItemsProcessed(state.iterations() * NUM_PROBES);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(BloomFilterBenchmark, ProbeBatch)(benchmark::State &state) {
+  MakeHashes(static_cast<uint32_t>(state.range(0)));
+  MemoryPool memory(nullptr);
+  BloomFilter filter(&memory, keys_.size());
+  for (const auto hash : keys_) filter.Add(hash);
+
+  Vector hashes(TypeId::Hash, true, false);
+  TupleIdList tid_list(common::Constants::K_DEFAULT_VECTOR_SIZE);
+  uint64_t num_found = 0;
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    uint64_t elapsed_us;
+    {
+      common::ScopedTimer<std::chrono::microseconds> timer(&elapsed_us);
+      for (uint32_t offset = 0; offset < NUM_PROBES; offset += common::Constants::K_DEFAULT_VECTOR_SIZE) {
+        hashes.Resize(common::Constants::K_DEFAULT_VECTOR_SIZE);
+        std::memcpy(hashes.GetData(), &probes_[offset], common::Constants::K_DEFAULT_VECTOR_SIZE * sizeof(hash_t));
+        tid_list.AddAll();
+        filter.ContainsBatch(hashes, &tid_list);
+        num_found += tid_list.GetTupleCount();
+      }
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_us) / 1000000.0);
+  }
+  benchmark::DoNotOptimize(num_found);
+  state.SetItemsProcessed(state.iterations() * NUM_PROBES);
+}
+
+BENCHMARK_REGISTER_F(BloomFilterBenchmark, Build)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 24)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+BENCHMARK_REGISTER_F(BloomFilterBenchmark, Probe)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 24)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+BENCHMARK_REGISTER_F(BloomFilterBenchmark, ProbeBatch)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 24)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+}  // namespace noisepage::execution::sql
@@ -0,0 +1,105 @@
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "benchmark_util/execution_benchmark_util.h"
+#include "common/scoped_timer.h"
+#include "execution/sql/filter_manager.h"
+#include "execution/sql/vector_filter_executor.h"
+#include "execution/sql/vector_projection.h"
+#include "execution/sql/vector_projection_iterator.h"
+
+namespace noisepage::execution::sql {
+
+/**
+ * These benchmarks run a conjunction of three range filters over NUM_BATCHES vectors of uniform integers in [0, 100),
+ * with the filter manager reordering the terms as it learns their costs and selectivities or keeping them in the order
+ * they were given. The terms are given from the least to the most selective, which is the worst order. The argument is
+ * the selectivity of the last term, in percent.
+ */
+class FilterManagerBenchmark : public benchmark::Fixture {
+ public:
+  /** The number of vectors filtered in every iteration */
+  static constexpr uint32_t NUM_BATCHES = 256;
+
+  void SetUp(const benchmark::State &state) final {
+    std::mt19937 generator;
+    std::uniform_int_distribution<int32_t> distribution(0, 99);
+    batches_.clear();
+    for (uint32_t i = 0; i < NUM_BATCHES; i++) {
+      auto vector_projection = std::make_unique<VectorProjection>();
+      vector_projection->Initialize({TypeId::Integer, TypeId::Integer, TypeId::Integer});
+      vector_projection->Reset(common::Constants::K_DEFAULT_VECTOR_SIZE);
+      for (uint32_t col_idx = 0; col_idx < 3; col_idx++) {
+        auto *data = reinterpret_cast<int32_t *>(vector_projection->GetColumn(col_idx)->GetData());
+        for (uint32_t j = 0; j < common::Constants::K_DEFAULT_VECTOR_SIZE; j++) data[j] = distribution(generator);
+      }
+      batches_.emplace_back(std::move(vector_projection));
+    }
+  }
+
+  void TearDown(const benchmark::State &state) final { batches_.clear(); }
+
+  /** Filter every batch with the same filter manager */
+  void RunFilters(benchmark::State *state, bool adapt) {
+    // The thresholds of the terms on each column, in percent
+    int32_t thresholds[3] = {99, 50, static_cast<int32_t>(state->range(0))};
+    auto exec_ctx = ExecutionBenchmarkUtil::MakeExecCtx(1);
+
+    uint64_t num_selected = 0;
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      FilterManager filter(exec_ctx->GetExecutionSettings(), adapt, thresholds);
+      filter.StartNewClause();
+      filter.InsertClauseTerms({SelectLessThan<0>, SelectLessThan<1>, SelectLessThan<2>});
+      uint64_t elapsed_us;
+      {
+        common::ScopedTimer<std::chrono::microseconds> timer(&elapsed_us);
+        for (auto &vector_projection : batches_) {
+          // Clear the selections of the previous iteration
+          vector_projection->Reset(common::Constants::K_DEFAULT_VECTOR_SIZE);
+          VectorProjectionIterator vpi(vector_projection.get());
+          filter.RunFilters(exec_ctx.get(), &vpi);
+          num_selected += vector_projection->GetSelectedTupleCount();
+        }
+      }
+      state->SetIterationTime(static_cast<double>(elapsed_us) / 1000000.0);
+    }
+    benchmark::DoNotOptimize(num_selected);
+    state->SetItemsProcessed(state->iterations() * NUM_BATCHES * common::Constants::K_DEFAULT_VECTOR_SIZE);
+  }
+
+ private:
+  template <uint32_t ColIdx>
+  static void SelectLessThan(exec::ExecutionContext *exec_ctx, VectorProjection *vector_projection,
+                             TupleIdList *tid_list, void *ctx) {
+    const auto threshold = reinterpret_cast<const int32_t *>(ctx)[ColIdx];
+    VectorFilterExecutor::SelectLessThanVal(exec_ctx->GetExecutionSettings(), vector_projection, ColIdx,
+                                            GenericValue::CreateInteger(threshold), tid_list);
+  }
+
+  std::vector<std::unique_ptr<VectorProjection>> batches_;
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(FilterManagerBenchmark, Adaptive)(benchmark::State &state) { RunFilters(&state, true); }
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(FilterManagerBenchmark, FixedOrder)(benchmark::State &state) { RunFilters(&state, false); }
+
+BENCHMARK_REGISTER_F(FilterManagerBenchmark, Adaptive)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(50)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+BENCHMARK_REGISTER_F(FilterManagerBenchmark, FixedOrder)
+    ->Arg(1)
+    ->Arg(10)
+    ->Arg(50)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+}  // namespace noisepage::execution::sql
@@ -0,0 +1,176 @@
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "benchmark_util/execution_benchmark_util.h"
+#include "common/hash_util.h"
+#include "common/scoped_timer.h"
+#include "execution/sql/join_hash_table.h"
+#include "execution/sql/thread_state_container.h"
+
+namespace noisepage::execution::sql {
+
+/**
+ * These benchmarks build a join hash table from unique keys in random order and then probe it with every key, with the
+ * chaining and the concise tables. The first argument is the number of build tuples, and the second is the width of
+ * a tuple in bytes. The parallel build takes the number of threads as a third argument: every thread fills its own
+ * table, and the tables are merged into one chaining table, as parallel merges do not build concise tables.
+ */
+class JoinHashTableBenchmark : public benchmark::Fixture {
+ public:
+  /** Build a table of tuples of the given width and probe it with every key */
+  template <bool UseConcise, uint32_t Width>
+  void BuildAndProbe(benchmark::State *state) {
+    const auto num_tuples = static_cast<uint32_t>(state->range(0));
+    const auto keys = MakeKeys(num_tuples);
+    auto exec_ctx = ExecutionBenchmarkUtil::MakeExecCtx(1);
+
+    uint64_t num_matches = 0;
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      JoinHashTable jht(exec_ctx->GetExecutionSettings(), exec_ctx.get(), Width, UseConcise);
+      uint64_t elapsed_us;
+      {
+        common::ScopedTimer<std::chrono::microseconds> timer(&elapsed_us);
+        Populate<Width>(&jht, keys.data(), num_tuples);
+        jht.Build();
+        num_matches += Probe<UseConcise, Width>(jht, keys);
+      }
+      state->SetIterationTime(static_cast<double>(elapsed_us) / 1000000.0);
+    }
+    benchmark::DoNotOptimize(num_matches);
+    state->SetItemsProcessed(state->iterations() * num_tuples * 2);
+  }
+
+  /** Fill a table of tuples of the given width on every thread, and merge the tables in parallel */
+  template <uint32_t Width>
+  void ParallelBuild(benchmark::State *state) {
+    const auto num_tuples = static_cast<uint32_t>(state->range(0));
+    const auto num_threads = static_cast<uint32_t>(state->range(2));
+    const auto keys = MakeKeys(num_tuples);
+    auto exec_ctx = ExecutionBenchmarkUtil::MakeExecCtx(num_threads);
+
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      ThreadStateContainer container(exec_ctx->GetMemoryPool());
+      container.Reset(
+          sizeof(JoinHashTable),
+          [](void *ctx, void *s) {
+            auto *exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+            new (s) JoinHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, Width);
+          },
+          [](void *ctx, void *s) { std::destroy_at(reinterpret_cast<JoinHashTable *>(s)); }, exec_ctx.get());
+      JoinHashTable main_jht(exec_ctx->GetExecutionSettings(), exec_ctx.get(), Width);
+
+      uint64_t elapsed_us;
+      {
+        common::ScopedTimer<std::chrono::microseconds> timer(&elapsed_us);
+        // Every thread takes a contiguous share of the keys
+        ExecutionBenchmarkUtil::RunThreads(num_threads, [&](uint32_t thread_idx) {
+          const uint32_t begin = num_tuples / num_threads * thread_idx;
+          const uint32_t end = thread_idx + 1 == num_threads ? num_tuples : begin + num_tuples / num_threads;
+          Populate<Width>(container.AccessCurrentThreadStateAs<JoinHashTable>(), keys.data() + begin, end - begin);
+        });
+        main_jht.MergeParallel(&container, 0);
+      }
+      state->SetIterationTime(static_cast<double>(elapsed_us) / 1000000.0);
+      benchmark::DoNotOptimize(main_jht.GetTupleCount());
+    }
+    state->SetItemsProcessed(state->iterations() * num_tuples);
+  }
+
+ private:
+  template <uint32_t Width>
+  struct Tuple {
+    static_assert(Width >= sizeof(uint64_t), "A tuple must hold its key");
+    uint64_t key_;
+    byte payload_[Width - sizeof(uint64_t)];
+  };
+
+  static std::vector<uint64_t> MakeKeys(uint32_t num_tuples) {
+    std::vector<uint64_t> keys(num_tuples);
+    std::iota(keys.begin(), keys.end(), 0);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(num_tuples));
+    return keys;
+  }
+
+  template <uint32_t Width>
+  static void Populate(JoinHashTable *jht, const uint64_t *keys, uint32_t num_tuples) {
+    for (uint32_t i = 0; i < num_tuples; i++) {
+      auto *tuple = reinterpret_cast<Tuple<Width> *>(jht->AllocInputTuple(common::HashUtil::Hash(keys[i])));
+      tuple->key_ = keys[i];
+    }
+  }
+
+  template <bool UseConcise, uint32_t Width>
+  static uint64_t Probe(const JoinHashTable &jht, const std::vector<uint64_t> &keys) {
+    uint64_t num_matches = 0;
+    for (const auto key : keys) {
+      for (auto iter = jht.Lookup<UseConcise>(common::HashUtil::Hash(key)); iter.HasNext();) {
+        num_matches += reinterpret_cast<const Tuple<Width> *>(iter.GetMatchPayload())->key_ == key;
+      }
+    }
+    return num_matches;
+  }
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(JoinHashTableBenchmark, ChainingBuildAndProbe)(benchmark::State &state) {
+  if (state.range(1) == 16) {
+    BuildAndProbe<false, 16>(&state);
+  } else {
+    BuildAndProbe<false, 64>(&state);
+  }
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(JoinHashTableBenchmark, ConciseBuildAndProbe)(benchmark::State &state) {
+  if (state.range(1) == 16) {
+    BuildAndProbe<true, 16>(&state);
+  } else {
+    BuildAndProbe<true, 64>(&state);
+  }
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(JoinHashTableBenchmark, ParallelBuild)(benchmark::State &state) {
+  if (state.range(1) == 16) {
+    ParallelBuild<16>(&state);
+  } else {
+    ParallelBuild<64>(&state);
+  }
+}
+
+/** From tables that fit in the caches to tables that do not, with narrow and wide tuples */
+static void SerialArgs(benchmark::internal::Benchmark *b) {
+  for (const int64_t num_tuples : {1 << 12, 1 << 16, 1 << 20, 1 << 23}) {
+    for (const int64_t width : {16, 64}) b->Args({num_tuples, width});
+  }
+}
+
+/** A large build on one to eight threads */
+static void ParallelArgs(benchmark::internal::Benchmark *b) {
+  for (const int64_t width : {16, 64}) {
+    for (const int64_t num_threads : {1, 2, 4, 8}) b->Args({1 << 22, width, num_threads});
+  }
+}
+
+BENCHMARK_REGISTER_F(JoinHashTableBenchmark, ChainingBuildAndProbe)
+    ->Apply(SerialArgs)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+BENCHMARK_REGISTER_F(JoinHashTableBenchmark, ConciseBuildAndProbe)
+    ->Apply(SerialArgs)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+BENCHMARK_REGISTER_F(JoinHashTableBenchmark, ParallelBuild)
+    ->Apply(ParallelArgs)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+}  // namespace noisepage::execution::sql
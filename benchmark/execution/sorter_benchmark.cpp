@@ -0,0 +1,192 @@
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "benchmark_util/execution_benchmark_util.h"
+#include "common/scoped_timer.h"
+#include "execution/sql/sorter.h"
+#include "execution/sql/thread_state_container.h"
+
+namespace noisepage::execution::sql {
+
+/**
+ * These benchmarks sort tuples with random 8-byte keys. The first argument is always the number of input tuples. The
+ * serial sorts compare every pair of tuples or radix sort their normalized keys, and the top-k sorts take k as a second
+ * argument. The parallel sorts take the number of threads as a second argument: every thread fills its own sorter, and
+ * the sorters are merged in parallel.
+ */
+class SorterBenchmark : public benchmark::Fixture {
+ public:
+  /** The number of tuples kept by the parallel top-k sorts */
+  static constexpr uint64_t PARALLEL_TOP_K = 100;
+
+  /** Sort all tuples on one thread */
+  void Sort(benchmark::State *state, bool use_normalized_keys) {
+    const auto num_tuples = static_cast<uint32_t>(state->range(0));
+    const auto keys = MakeKeys(num_tuples);
+    auto exec_ctx = ExecutionBenchmarkUtil::MakeExecCtx(1);
+
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      Sorter sorter(exec_ctx.get(), CompareTuples, sizeof(Tuple));
+      if (use_normalized_keys) sorter.SetNormalizedKeyFunction(NormalizedKey);
+      uint64_t elapsed_us;
+      {
+        common::ScopedTimer<std::chrono::microseconds> timer(&elapsed_us);
+        for (const auto key : keys) reinterpret_cast<Tuple *>(sorter.AllocInputTuple())->key_ = key;
+        sorter.Sort();
+      }
+      state->SetIterationTime(static_cast<double>(elapsed_us) / 1000000.0);
+      benchmark::DoNotOptimize(sorter.GetTupleCount());
+    }
+    state->SetItemsProcessed(state->iterations() * num_tuples);
+  }
+
+  /** Keep the smallest k tuples on one thread */
+  void SortTopK(benchmark::State *state) {
+    const auto num_tuples = static_cast<uint32_t>(state->range(0));
+    const auto top_k = static_cast<uint64_t>(state->range(1));
+    const auto keys = MakeKeys(num_tuples);
+    auto exec_ctx = ExecutionBenchmarkUtil::MakeExecCtx(1);
+
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      Sorter sorter(exec_ctx.get(), CompareTuples, sizeof(Tuple));
+      uint64_t elapsed_us;
+      {
+        common::ScopedTimer<std::chrono::microseconds> timer(&elapsed_us);
+        for (const auto key : keys) {
+          reinterpret_cast<Tuple *>(sorter.AllocInputTupleTopK(top_k))->key_ = key;
+          sorter.AllocInputTupleTopKFinish(top_k);
+        }
+        sorter.Sort();
+      }
+      state->SetIterationTime(static_cast<double>(elapsed_us) / 1000000.0);
+      benchmark::DoNotOptimize(sorter.GetTupleCount());
+    }
+    state->SetItemsProcessed(state->iterations() * num_tuples);
+  }
+
+  /** Fill a sorter on every thread, and sort or keep the top PARALLEL_TOP_K of all of them in parallel */
+  void SortParallel(benchmark::State *state, bool top_k) {
+    const auto num_tuples = static_cast<uint32_t>(state->range(0));
+    const auto num_threads = static_cast<uint32_t>(state->range(1));
+    const auto keys = MakeKeys(num_tuples);
+    auto exec_ctx = ExecutionBenchmarkUtil::MakeExecCtx(num_threads);
+
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      ThreadStateContainer container(exec_ctx->GetMemoryPool());
+      container.Reset(
+          sizeof(Sorter),
+          [](void *ctx, void *s) {
+            new (s) Sorter(reinterpret_cast<exec::ExecutionContext *>(ctx), CompareTuples, sizeof(Tuple));
+          },
+          [](void *ctx, void *s) { std::destroy_at(reinterpret_cast<Sorter *>(s)); }, exec_ctx.get());
+      Sorter main_sorter(exec_ctx.get(), CompareTuples, sizeof(Tuple));
+
+      uint64_t elapsed_us;
+      {
+        common::ScopedTimer<std::chrono::microseconds> timer(&elapsed_us);
+        // Every thread takes a contiguous share of the keys
+        ExecutionBenchmarkUtil::RunThreads(num_threads, [&](uint32_t thread_idx) {
+          const uint32_t begin = num_tuples / num_threads * thread_idx;
+          const uint32_t end = thread_idx + 1 == num_threads ? num_tuples : begin + num_tuples / num_threads;
+          auto *sorter = container.AccessCurrentThreadStateAs<Sorter>();
+          for (uint32_t i = begin; i < end; i++) {
+            if (top_k) {
+              reinterpret_cast<Tuple *>(sorter->AllocInputTupleTopK(PARALLEL_TOP_K))->key_ = keys[i];
+              sorter->AllocInputTupleTopKFinish(PARALLEL_TOP_K);
+            } else {
+              reinterpret_cast<Tuple *>(sorter->AllocInputTuple())->key_ = keys[i];
+            }
+          }
+        });
+        if (top_k) {
+          main_sorter.SortTopKParallel(&container, 0, PARALLEL_TOP_K);
+        } else {
+          main_sorter.SortParallel(&container, 0);
+        }
+      }
+      state->SetIterationTime(static_cast<double>(elapsed_us) / 1000000.0);
+      benchmark::DoNotOptimize(main_sorter.GetTupleCount());
+    }
+    state->SetItemsProcessed(state->iterations() * num_tuples);
+  }
+
+ private:
+  struct Tuple {
+    int64_t key_;
+    int64_t payload_;
+  };
+
+  static std::vector<int64_t> MakeKeys(uint32_t num_tuples) {
+    std::vector<int64_t> keys(num_tuples);
+    std::mt19937_64 generator(num_tuples);
+    for (auto &key : keys) key = static_cast<int64_t>(generator());
+    return keys;
+  }
+
+  static int32_t CompareTuples(const void *lhs, const void *rhs) {
+    const auto l = reinterpret_cast<const Tuple *>(lhs)->key_;
+    const auto r = reinterpret_cast<const Tuple *>(rhs)->key_;
+    return l < r ? -1 : (l == r ? 0 : 1);
+  }
+
+  // Flipping the sign bit orders signed keys as unsigned ones
+  static uint64_t NormalizedKey(const void *tuple) {
+    return static_cast<uint64_t>(reinterpret_cast<const Tuple *>(tuple)->key_) ^ (uint64_t{1} << 63);
+  }
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(SorterBenchmark, Sort)(benchmark::State &state) { Sort(&state, false); }
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(SorterBenchmark, SortNormalizedKeys)(benchmark::State &state) { Sort(&state, true); }
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(SorterBenchmark, SortTopK)(benchmark::State &state) { SortTopK(&state); }
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(SorterBenchmark, SortParallel)(benchmark::State &state) { SortParallel(&state, false); }
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(SorterBenchmark, SortTopKParallel)(benchmark::State &state) { SortParallel(&state, true); }
+
+/** A few and many k for large inputs */
+static void TopKArgs(benchmark::internal::Benchmark *b) {
+  for (const int64_t top_k : {10, 1000, 100000}) b->Args({1 << 22, top_k});
+}
+
+/** A large input on one to eight threads */
+static void ParallelArgs(benchmark::internal::Benchmark *b) {
+  for (const int64_t num_threads : {1, 2, 4, 8}) b->Args({1 << 22, num_threads});
+}
+
+BENCHMARK_REGISTER_F(SorterBenchmark, Sort)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 24)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+BENCHMARK_REGISTER_F(SorterBenchmark, SortNormalizedKeys)
+    ->RangeMultiplier(16)
+    ->Range(1 << 12, 1 << 24)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+BENCHMARK_REGISTER_F(SorterBenchmark, SortTopK)->Apply(TopKArgs)->Unit(benchmark::kMillisecond)->UseManualTime();
+
+BENCHMARK_REGISTER_F(SorterBenchmark, SortParallel)
+    ->Apply(ParallelArgs)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+BENCHMARK_REGISTER_F(SorterBenchmark, SortTopKParallel)
+    ->Apply(ParallelArgs)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime();
+
+}  // namespace noisepage::execution::sql
@@ -0,0 +1,115 @@
+#include <random>
+
+#include "benchmark/benchmark.h"
+#include "execution/sql/tuple_id_list.h"
+
+namespace noisepage::execution::sql {
+
+/**
+ * These benchmarks run the operations of TupleIdList that filters and vector kernels use on lists as large as a vector.
+ * The argument is the percentage of the tuples in each list, which are chosen at random.
+ */
+class TupleIdListBenchmark : public benchmark::Fixture {
+ public:
+  void SetUp(const benchmark::State &state) final {
+    const auto percent_selected = static_cast<uint32_t>(state.range(0));
+    std::mt19937 generator(percent_selected);
+    std::uniform_int_distribution<uint32_t> distribution(0, 99);
+    left_.Clear();
+    right_.Clear();
+    for (uint32_t i = 0; i < common::Constants::K_DEFAULT_VECTOR_SIZE; i++) {
+      left_.Enable(i, distribution(generator) < percent_selected);
+      right_.Enable(i, distribution(generator) < percent_selected);
+    }
+  }
+
+  void TearDown(const benchmark::State &state) final {}
+
+  /** The first list */
+  TupleIdList left_{common::Constants::K_DEFAULT_VECTOR_SIZE};
+  /** The second list */
+  TupleIdList right_{common::Constants::K_DEFAULT_VECTOR_SIZE};
+  /** The list that operations write to */
+  TupleIdList result_{common::Constants::K_DEFAULT_VECTOR_SIZE};
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(TupleIdListBenchmark, IntersectWith)(benchmark::State &state) {
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    result_.AssignFrom(left_);
+    result_.IntersectWith(right_);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * common::Constants::K_DEFAULT_VECTOR_SIZE);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(TupleIdListBenchmark, UnionWith)(benchmark::State &state) {
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    result_.AssignFrom(left_);
+    result_.UnionWith(right_);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * common::Constants::K_DEFAULT_VECTOR_SIZE);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(TupleIdListBenchmark, UnsetFrom)(benchmark::State &state) {
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    result_.AssignFrom(left_);
+    result_.UnsetFrom(right_);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * common::Constants::K_DEFAULT_VECTOR_SIZE);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(TupleIdListBenchmark, Filter)(benchmark::State &state) {
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    result_.AssignFrom(left_);
+    result_.Filter([](const uint64_t tid) { return tid % 3 != 0; });
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * left_.GetTupleCount());
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(TupleIdListBenchmark, ForEach)(benchmark::State &state) {
+  uint64_t sum = 0;
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    left_.ForEach([&](const uint64_t tid) { sum += tid; });
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations() * left_.GetTupleCount());
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(TupleIdListBenchmark, SelectionVectorRoundTrip)(benchmark::State &state) {
+  sel_t sel_vector[common::Constants::K_DEFAULT_VECTOR_SIZE];
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    const uint32_t size = left_.ToSelectionVector(sel_vector);
+    result_.BuildFromSelectionVector(sel_vector, size);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * left_.GetTupleCount());
+}
+
+/** Sparse, half and full lists */
+static void SelectionArgs(benchmark::internal::Benchmark *b) {
+  for (const int64_t percent_selected : {1, 50, 100}) b->Arg(percent_selected);
+}
+
+BENCHMARK_REGISTER_F(TupleIdListBenchmark, IntersectWith)->Apply(SelectionArgs);
+BENCHMARK_REGISTER_F(TupleIdListBenchmark, UnionWith)->Apply(SelectionArgs);
+BENCHMARK_REGISTER_F(TupleIdListBenchmark, UnsetFrom)->Apply(SelectionArgs);
+BENCHMARK_REGISTER_F(TupleIdListBenchmark, Filter)->Apply(SelectionArgs);
+BENCHMARK_REGISTER_F(TupleIdListBenchmark, ForEach)->Apply(SelectionArgs);
+BENCHMARK_REGISTER_F(TupleIdListBenchmark, SelectionVectorRoundTrip)->Apply(SelectionArgs);
+
+}  // namespace noisepage::execution::sql
@@ -0,0 +1,209 @@
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "execution/exec/execution_settings.h"
+#include "execution/sql/tuple_id_list.h"
+#include "execution/sql/vector.h"
+#include "execution/sql/vector_operations/vector_operations.h"
+
+namespace noisepage::execution::sql {
+
+/**
+ * These benchmarks run vector kernels over one vector of random values at a time, on 4-byte and 8-byte integers. The
+ * argument is the percentage of the vector's elements that are selected, where 100 means the vector is not filtered.
+ */
+class VectorOperationsBenchmark : public benchmark::Fixture {
+ public:
+  /** Make a full vector of random values of the given type, seeded by the given seed */
+  template <typename T>
+  static std::unique_ptr<Vector> MakeVector(TypeId type_id, uint32_t seed) {
+    auto vector = std::make_unique<Vector>(type_id, true, false);
+    vector->Resize(common::Constants::K_DEFAULT_VECTOR_SIZE);
+    std::mt19937_64 generator(seed);
+    auto *data = reinterpret_cast<T *>(vector->GetData());
+    for (uint32_t i = 0; i < common::Constants::K_DEFAULT_VECTOR_SIZE; i++) data[i] = static_cast<T>(generator());
+    return vector;
+  }
+
+  /** Select the given percentage of elements at random, unless all of them are */
+  void MakeSelection(const benchmark::State &state) {
+    const auto percent_selected = static_cast<uint32_t>(state.range(0));
+    std::mt19937 generator(percent_selected);
+    std::uniform_int_distribution<uint32_t> distribution(0, 99);
+    tid_list_.Clear();
+    for (uint32_t i = 0; i < common::Constants::K_DEFAULT_VECTOR_SIZE; i++) {
+      tid_list_.Enable(i, distribution(generator) < percent_selected);
+    }
+  }
+
+  /** Apply the selection to a vector */
+  void Filter(const benchmark::State &state, Vector *vector) {
+    if (state.range(0) < 100) vector->SetFilteredTupleIdList(&tid_list_, tid_list_.GetTupleCount());
+  }
+
+  /** Hash every selected element */
+  template <typename T>
+  void Hash(benchmark::State *state, TypeId type_id) {
+    MakeSelection(*state);
+    auto input = MakeVector<T>(type_id, 0);
+    Filter(*state, input.get());
+    Vector result(TypeId::Hash, true, false);
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      VectorOps::Hash(*input, &result);
+      benchmark::ClobberMemory();
+    }
+    state->SetItemsProcessed(state->iterations() * input->GetCount());
+  }
+
+  /** Select the elements of one vector less than the ones of another */
+  template <typename T>
+  void SelectLessThan(benchmark::State *state, TypeId type_id) {
+    MakeSelection(*state);
+    auto left = MakeVector<T>(type_id, 0);
+    auto right = MakeVector<T>(type_id, 1);
+    Filter(*state, left.get());
+    Filter(*state, right.get());
+    TupleIdList result(common::Constants::K_DEFAULT_VECTOR_SIZE);
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      result.AssignFrom(tid_list_);
+      VectorOps::SelectLessThan(exec_settings_, *left, *right, &result);
+      benchmark::DoNotOptimize(result.GetTupleCount());
+    }
+    state->SetItemsProcessed(state->iterations() * left->GetCount());
+  }
+
+  /** Add the elements of two vectors */
+  template <typename T>
+  void Add(benchmark::State *state, TypeId type_id) {
+    MakeSelection(*state);
+    auto left = MakeVector<T>(type_id, 0);
+    auto right = MakeVector<T>(type_id, 1);
+    Filter(*state, left.get());
+    Filter(*state, right.get());
+    Vector result(type_id, true, false);
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      VectorOps::Add(exec_settings_, *left, *right, &result);
+      benchmark::ClobberMemory();
+    }
+    state->SetItemsProcessed(state->iterations() * left->GetCount());
+  }
+
+  /** Read a value out of every row that a vector of pointers points to */
+  template <typename T>
+  void Gather(benchmark::State *state, TypeId type_id) {
+    MakeSelection(*state);
+    // The rows are spread over more memory than the private caches hold, and are read in random order
+    struct Row {
+      uint64_t key_;
+      T value_;
+    };
+    std::vector<Row> rows(common::Constants::K_DEFAULT_VECTOR_SIZE * 64);
+    std::mt19937 generator;
+    std::uniform_int_distribution<std::size_t> row_idx(0, rows.size() - 1);
+    Vector pointers(TypeId::Pointer, true, false);
+    pointers.Resize(common::Constants::K_DEFAULT_VECTOR_SIZE);
+    auto *raw_pointers = reinterpret_cast<Row **>(pointers.GetData());
+    for (uint32_t i = 0; i < common::Constants::K_DEFAULT_VECTOR_SIZE; i++) raw_pointers[i] = &rows[row_idx(generator)];
+    Filter(*state, &pointers);
+    Vector result(type_id, true, false);
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      VectorOps::Gather(pointers, &result, offsetof(Row, value_));
+      benchmark::ClobberMemory();
+    }
+    state->SetItemsProcessed(state->iterations() * pointers.GetCount());
+  }
+
+  /** Sort the selected elements */
+  template <typename T>
+  void Sort(benchmark::State *state, TypeId type_id) {
+    MakeSelection(*state);
+    auto input = MakeVector<T>(type_id, 0);
+    Filter(*state, input.get());
+    sel_t result[common::Constants::K_DEFAULT_VECTOR_SIZE];
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      VectorOps::Sort(*input, result);
+      benchmark::ClobberMemory();
+    }
+    state->SetItemsProcessed(state->iterations() * input->GetCount());
+  }
+
+ private:
+  exec::ExecutionSettings exec_settings_{};
+  TupleIdList tid_list_{common::Constants::K_DEFAULT_VECTOR_SIZE};
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(VectorOperationsBenchmark, HashInteger)(benchmark::State &state) {
+  Hash<int32_t>(&state, TypeId::Integer);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(VectorOperationsBenchmark, HashBigInt)(benchmark::State &state) {
+  Hash<int64_t>(&state, TypeId::BigInt);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(VectorOperationsBenchmark, SelectLessThanInteger)(benchmark::State &state) {
+  SelectLessThan<int32_t>(&state, TypeId::Integer);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(VectorOperationsBenchmark, SelectLessThanBigInt)(benchmark::State &state) {
+  SelectLessThan<int64_t>(&state, TypeId::BigInt);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(VectorOperationsBenchmark, AddInteger)(benchmark::State &state) {
+  Add<int32_t>(&state, TypeId::Integer);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(VectorOperationsBenchmark, AddBigInt)(benchmark::State &state) {
+  Add<int64_t>(&state, TypeId::BigInt);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(VectorOperationsBenchmark, GatherInteger)(benchmark::State &state) {
+  Gather<int32_t>(&state, TypeId::Integer);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(VectorOperationsBenchmark, GatherBigInt)(benchmark::State &state) {
+  Gather<int64_t>(&state, TypeId::BigInt);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(VectorOperationsBenchmark, SortInteger)(benchmark::State &state) {
+  Sort<int32_t>(&state, TypeId::Integer);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(VectorOperationsBenchmark, SortBigInt)(benchmark::State &state) {
+  Sort<int64_t>(&state, TypeId::BigInt);
+}
+
+/** Sparse, half and fully selected vectors */
+static void SelectionArgs(benchmark::internal::Benchmark *b) {
+  for (const int64_t percent_selected : {1, 50, 100}) b->Arg(percent_selected);
+}
+
+BENCHMARK_REGISTER_F(VectorOperationsBenchmark, HashInteger)->Apply(SelectionArgs);
+BENCHMARK_REGISTER_F(VectorOperationsBenchmark, HashBigInt)->Apply(SelectionArgs);
+BENCHMARK_REGISTER_F(VectorOperationsBenchmark, SelectLessThanInteger)->Apply(SelectionArgs);
+BENCHMARK_REGISTER_F(VectorOperationsBenchmark, SelectLessThanBigInt)->Apply(SelectionArgs);
+BENCHMARK_REGISTER_F(VectorOperationsBenchmark, AddInteger)->Apply(SelectionArgs);
+BENCHMARK_REGISTER_F(VectorOperationsBenchmark, AddBigInt)->Apply(SelectionArgs);
+BENCHMARK_REGISTER_F(VectorOperationsBenchmark, GatherInteger)->Apply(SelectionArgs);
+BENCHMARK_REGISTER_F(VectorOperationsBenchmark, GatherBigInt)->Apply(SelectionArgs);
+BENCHMARK_REGISTER_F(VectorOperationsBenchmark, SortInteger)->Apply(SelectionArgs);
+BENCHMARK_REGISTER_F(VectorOperationsBenchmark, SortBigInt)->Apply(SelectionArgs);
+
+}  // namespace noisepage::execution::sql
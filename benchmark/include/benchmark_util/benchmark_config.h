@@ -16,6 +16,18 @@ constexpr char ENV_NUM_THREADS[] = "NOISEPAGE_BENCHMARK_THREADS";
  */
 constexpr char ENV_LOGFILE_PATH[] = "NOISEPAGE_BENCHMARK_LOGFILE_PATH";
 
+/**
+ * This string specifies the environment variable that we will use to set the
+ * scale factor of the benchmarks that generate their data.
+ */
+constexpr char ENV_SCALE_FACTOR[] = "NOISEPAGE_BENCHMARK_SCALE_FACTOR";
+
+/**
+ * This string specifies the environment variable that we will use to set the
+ * file path that benchmarks export their results to.
+ */
+constexpr char ENV_RESULTS_PATH[] = "NOISEPAGE_BENCHMARK_RESULTS_PATH";
+
 /**
  * This class is a placeholder for any global configuration parameters for benchmarks.
  * You have to define a parameter as a static data member in order to avoid linker errors.
@@ -37,6 +49,18 @@ class BenchmarkConfig {
    * @see noisepage::ENV_LOGFILE_PATH
    */
   static std::string_view logfile_path;
+
+  /**
+   * The scale factor of the benchmarks that generate their data, e.g., TPC-H and TPC-C.
+   * @see noisepage::ENV_SCALE_FACTOR
+   */
+  static double scale_factor;
+
+  /**
+   * The path of the JSON file that benchmarks export their results to.
+   * @see noisepage::ENV_RESULTS_PATH
+   */
+  static std::string_view results_path;
 };
 
 }  // namespace noisepage
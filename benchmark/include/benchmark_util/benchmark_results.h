@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>  // NOLINT
+#include <string>
+#include <vector>
+
+#include "common/json.h"
+
+namespace noisepage {
+
+/**
+ * Collects the results of benchmarks that run a matrix of configurations, and exports them in a JSON schema that stays
+ * stable across versions, so that throughput and latency can be tracked over time. A file looks like:
+ *
+ *   {"schema_version": 1, "timestamp": "2021-01-01T00:00:00Z", "hardware_concurrency": 16,
+ *    "results": [{"benchmark": "tpch", "workload": "q01", "mode": "compiled", "num_threads": 4,
+ *                 "scale_factor": 0.1, "logging": false, "status": "ok", "error": "", "executions": 120,
+ *                 "elapsed_us": 10000000, "throughput": 12.0,
+ *                 "latency_us": {"mean": 330000.0, "p50": 320000, "p90": 350000, "p99": 410000, "max": 420000}}]}
+ *
+ * A configuration is identified by (benchmark, workload, mode, num_threads, scale_factor, logging). Its throughput is
+ * in executions per second. Configurations that could not run have a status other than "ok", with the reason in
+ * "error". Fields may be added in later versions of the schema, but existing ones keep their meaning.
+ */
+class BenchmarkResults {
+ public:
+  /** Version of the schema of the exported results. */
+  static constexpr uint32_t SCHEMA_VERSION = 1;
+
+  /** The configuration that a result was measured in. */
+  struct Configuration {
+    /** Benchmark, e.g., tpch or tpcc */
+    std::string benchmark_;
+    /** Query or transaction of the benchmark */
+    std::string workload_;
+    /** Execution mode of the queries, or empty if not applicable */
+    std::string mode_;
+    /** Number of threads running the workload concurrently */
+    uint32_t num_threads_;
+    /** Scale factor of the data, which for TPC-C is its number of warehouses */
+    double scale_factor_;
+    /** Whether the WAL was written */
+    bool logging_;
+  };
+
+  /**
+   * Add the result of a configuration that ran
+   * @param config the configuration
+   * @param elapsed_us wall clock time that the threads ran the workload for
+   * @param latencies_us latency of every execution of the workload, in any order
+   */
+  void AddResult(const Configuration &config, uint64_t elapsed_us, std::vector<uint64_t> latencies_us);
+
+  /**
+   * Add a configuration that could not run
+   * @param config the configuration
+   * @param status why it did not run, e.g., unsupported
+   * @param error description of the error
+   */
+  void AddFailure(const Configuration &config, const std::string &status, const std::string &error);
+
+  /** @return the results in the exported schema */
+  nlohmann::json ToJson() const;
+
+  /**
+   * Write the results, replacing the file
+   * @param path path of the file
+   */
+  void Write(const std::string &path) const;
+
+  /**
+   * @param sorted_latencies latencies in ascending order, not empty
+   * @param percentile percentile in [0, 100]
+   * @return the latency at the percentile, by the nearest rank
+   */
+  static uint64_t Percentile(const std::vector<uint64_t> &sorted_latencies, double percentile);
+
+ private:
+  static nlohmann::json ConfigurationToJson(const Configuration &config);
+
+  mutable std::mutex latch_;
+  std::vector<nlohmann::json> results_;
+};
+
+}  // namespace noisepage
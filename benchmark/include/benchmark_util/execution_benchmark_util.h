@@ -0,0 +1,44 @@
+#pragma once
+
+#include <memory>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "execution/exec/execution_context.h"
+#include "execution/exec/execution_settings.h"
+
+namespace noisepage::execution {
+
+/**
+ * Helpers shared by the benchmarks of the execution engine's runtime data structures. The data structures only need an
+ * execution context for its memory pool and settings, so the contexts made here have no transaction or catalog.
+ */
+class ExecutionBenchmarkUtil {
+ public:
+  ExecutionBenchmarkUtil() = delete;
+
+  /**
+   * Make an execution context that runs the parallel steps of the data structures on at most the given threads.
+   * @param num_threads The number of threads that parallel steps may use.
+   * @return The execution context.
+   */
+  static std::unique_ptr<exec::ExecutionContext> MakeExecCtx(uint32_t num_threads);
+
+  /**
+   * Run a function on the given number of threads at once, and wait for all of them to finish.
+   * @tparam F The type of the function, which takes the index of its thread.
+   * @param num_threads The number of threads.
+   * @param f The function.
+   */
+  template <typename F>
+  static void RunThreads(uint32_t num_threads, const F &f) {
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (uint32_t thread_idx = 0; thread_idx < num_threads; thread_idx++) {
+      threads.emplace_back([&f, thread_idx] { f(thread_idx); });
+    }
+    for (auto &thread : threads) thread.join();
+  }
+};
+
+}  // namespace noisepage::execution
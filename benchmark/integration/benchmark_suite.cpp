@@ -0,0 +1,495 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <filesystem>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "benchmark_util/benchmark_config.h"
+#include "benchmark_util/benchmark_results.h"
+#include "binder/bind_node_visitor.h"
+#include "catalog/catalog.h"
+#include "common/dedicated_thread_registry.h"
+#include "common/macros.h"
+#include "common/scoped_timer.h"
+#include "common/worker_pool.h"
+#include "execution/compiler/compilation_context.h"
+#include "execution/compiler/executable_query.h"
+#include "execution/exec/execution_context.h"
+#include "execution/exec/execution_settings.h"
+#include "execution/exec/output.h"
+#include "execution/table_generator/table_reader.h"
+#include "execution/vm/module.h"
+#include "main/db_main.h"
+#include "optimizer/cost_model/trivial_cost_model.h"
+#include "optimizer/optimize_result.h"
+#include "parser/postgresparser.h"
+#include "planner/plannodes/abstract_plan_node.h"
+#include "planner/plannodes/output_schema.h"
+#include "storage/garbage_collector_thread.h"
+#include "test_util/fs_util.h"
+#include "test_util/tpcc/builder.h"
+#include "test_util/tpcc/database.h"
+#include "test_util/tpcc/loader.h"
+#include "test_util/tpcc/worker.h"
+#include "test_util/tpcc/workload.h"
+#include "test_util/tpch/tpch_generator.h"
+#include "traffic_cop/traffic_cop_util.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/transaction_manager.h"
+
+namespace noisepage {
+
+/**
+ * The end-to-end suite: the TPC-H queries in every execution mode and the TPC-C transactions with logging, on 1 to
+ * BenchmarkConfig::num_threads threads each, over data that the suite generates itself at
+ * BenchmarkConfig::scale_factor. Every configuration is exported to BenchmarkConfig::results_path in the schema of
+ * BenchmarkResults, so that runs can be compared against each other to catch regressions, e.g., with
+ * script/testing/microbench/benchmark_suite_compare.py.
+ */
+class BenchmarkSuite : public benchmark::Fixture {
+ public:
+  /** Time (us) that every thread runs a TPC-H query for, in every configuration */
+  const uint64_t tpch_us_per_configuration_ = 2000000;
+  /** Number of TPC-C txns to run per terminal (worker thread) */
+  const uint32_t tpcc_txns_per_worker_ = 20000;
+
+  const std::vector<std::pair<execution::vm::ExecutionMode, std::string>> modes_ = {
+      {execution::vm::ExecutionMode::Interpret, "interpret"},
+      {execution::vm::ExecutionMode::Adaptive, "adaptive"},
+      {execution::vm::ExecutionMode::Compiled, "compiled"}};
+
+  BenchmarkResults results_;
+
+  /** A TPC-H query that is planned and compiled from its SQL */
+  struct Query {
+    std::string name_;
+    std::unique_ptr<planner::AbstractPlanNode> plan_;
+    std::unique_ptr<execution::compiler::ExecutableQuery> executable_;
+    /** Why the query could not be planned or compiled, if it could not */
+    std::string error_;
+  };
+
+  void RunTPCH();
+  void RunTPCC();
+
+ private:
+  static std::vector<std::string> TPCHQueries();
+
+  // Plan and compile a query. Errors are kept in the query, as not every feature of SQL is supported.
+  static Query PrepareQuery(common::ManagedPointer<DBMain> db_main, catalog::db_oid_t db_oid, std::string name,
+                            const std::string &sql);
+
+  // Time (ms) that the optimizer may take to plan a query
+  static constexpr uint64_t optimizer_timeout_ = 5000;
+
+  // Execute a query once in its own txn
+  static void ExecuteQuery(common::ManagedPointer<DBMain> db_main, catalog::db_oid_t db_oid, const Query &query,
+                           execution::vm::ExecutionMode mode);
+};
+
+std::vector<std::string> BenchmarkSuite::TPCHQueries() {
+  // The TPC-H queries with the substitution parameters of the validation run (section 2.4 of the specification). The
+  // date intervals are computed ahead of time.
+  return {
+      // Q1
+      "SELECT l_returnflag, l_linestatus, SUM(l_quantity) AS sum_qty, SUM(l_extendedprice) AS sum_base_price, "
+      "SUM(l_extendedprice * (1 - l_discount)) AS sum_disc_price, "
+      "SUM(l_extendedprice * (1 - l_discount) * (1 + l_tax)) AS sum_charge, AVG(l_quantity) AS avg_qty, "
+      "AVG(l_extendedprice) AS avg_price, AVG(l_discount) AS avg_disc, COUNT(*) AS count_order FROM lineitem "
+      "WHERE l_shipdate <= date '1998-09-02' GROUP BY l_returnflag, l_linestatus "
+      "ORDER BY l_returnflag, l_linestatus;",
+      // Q2
+      "SELECT s_acctbal, s_name, n_name, p_partkey, p_mfgr, s_address, s_phone, s_comment "
+      "FROM part, supplier, partsupp, nation, region WHERE p_partkey = ps_partkey AND s_suppkey = ps_suppkey "
+      "AND p_size = 15 AND p_type LIKE '%BRASS' AND s_nationkey = n_nationkey AND n_regionkey = r_regionkey "
+      "AND r_name = 'EUROPE' AND ps_supplycost = (SELECT MIN(ps_supplycost) FROM partsupp, supplier, nation, region "
+      "WHERE p_partkey = ps_partkey AND s_suppkey = ps_suppkey AND s_nationkey = n_nationkey "
+      "AND n_regionkey = r_regionkey AND r_name = 'EUROPE') "
+      "ORDER BY s_acctbal DESC, n_name, s_name, p_partkey LIMIT 100;",
+      // Q3
+      "SELECT l_orderkey, SUM(l_extendedprice * (1 - l_discount)) AS revenue, o_orderdate, o_shippriority "
+      "FROM customer, orders, lineitem WHERE c_mktsegment = 'BUILDING' AND c_custkey = o_custkey "
+      "AND l_orderkey = o_orderkey AND o_orderdate < date '1995-03-15' AND l_shipdate > date '1995-03-15' "
+      "GROUP BY l_orderkey, o_orderdate, o_shippriority ORDER BY revenue DESC, o_orderdate LIMIT 10;",
+      // Q4
+      "SELECT o_orderpriority, COUNT(*) AS order_count FROM orders WHERE o_orderdate >= date '1993-07-01' "
+      "AND o_orderdate < date '1993-10-01' AND EXISTS (SELECT * FROM lineitem WHERE l_orderkey = o_orderkey "
+      "AND l_commitdate < l_receiptdate) GROUP BY o_orderpriority ORDER BY o_orderpriority;",
+      // Q5
+      "SELECT n_name, SUM(l_extendedprice * (1 - l_discount)) AS revenue "
+      "FROM customer, orders, lineitem, supplier, nation, region WHERE c_custkey = o_custkey "
+      "AND l_orderkey = o_orderkey AND l_suppkey = s_suppkey AND c_nationkey = s_nationkey "
+      "AND s_nationkey = n_nationkey AND n_regionkey = r_regionkey AND r_name = 'ASIA' "
+      "AND o_orderdate >= date '1994-01-01' AND o_orderdate < date '1995-01-01' GROUP BY n_name "
+      "ORDER BY revenue DESC;",
+      // Q6
+      "SELECT SUM(l_extendedprice * l_discount) AS revenue FROM lineitem WHERE l_shipdate >= date '1994-01-01' "
+      "AND l_shipdate < date '1995-01-01' AND l_discount BETWEEN 0.05 AND 0.07 AND l_quantity < 24;",
+      // Q7
+      "SELECT supp_nation, cust_nation, l_year, SUM(volume) AS revenue FROM (SELECT n1.n_name AS supp_nation, "
+      "n2.n_name AS cust_nation, EXTRACT(YEAR FROM l_shipdate) AS l_year, "
+      "l_extendedprice * (1 - l_discount) AS volume FROM supplier, lineitem, orders, customer, nation n1, nation n2 "
+      "WHERE s_suppkey = l_suppkey AND o_orderkey = l_orderkey AND c_custkey = o_custkey "
+      "AND s_nationkey = n1.n_nationkey AND c_nationkey = n2.n_nationkey AND ((n1.n_name = 'FRANCE' "
+      "AND n2.n_name = 'GERMANY') OR (n1.n_name = 'GERMANY' AND n2.n_name = 'FRANCE')) "
+      "AND l_shipdate BETWEEN date '1995-01-01' AND date '1996-12-31') AS shipping "
+      "GROUP BY supp_nation, cust_nation, l_year ORDER BY supp_nation, cust_nation, l_year;",
+      // Q8
+      "SELECT o_year, SUM(CASE WHEN nation = 'BRAZIL' THEN volume ELSE 0 END) / SUM(volume) AS mkt_share "
+      "FROM (SELECT EXTRACT(YEAR FROM o_orderdate) AS o_year, l_extendedprice * (1 - l_discount) AS volume, "
+      "n2.n_name AS nation FROM part, supplier, lineitem, orders, customer, nation n1, nation n2, region "
+      "WHERE p_partkey = l_partkey AND s_suppkey = l_suppkey AND l_orderkey = o_orderkey "
+      "AND o_custkey = c_custkey AND c_nationkey = n1.n_nationkey AND n1.n_regionkey = r_regionkey "
+      "AND r_name = 'AMERICA' AND s_nationkey = n2.n_nationkey "
+      "AND o_orderdate BETWEEN date '1995-01-01' AND date '1996-12-31' AND p_type = 'ECONOMY ANODIZED STEEL') "
+      "AS all_nations GROUP BY o_year ORDER BY o_year;",
+      // Q9
+      "SELECT nation, o_year, SUM(amount) AS sum_profit FROM (SELECT n_name AS nation, "
+      "EXTRACT(YEAR FROM o_orderdate) AS o_year, "
+      "l_extendedprice * (1 - l_discount) - ps_supplycost * l_quantity AS amount "
+      "FROM part, supplier, lineitem, partsupp, orders, nation WHERE s_suppkey = l_suppkey "
+      "AND ps_suppkey = l_suppkey AND ps_partkey = l_partkey AND p_partkey = l_partkey "
+      "AND o_orderkey = l_orderkey AND s_nationkey = n_nationkey AND p_name LIKE '%green%') AS profit "
+      "GROUP BY nation, o_year ORDER BY nation, o_year DESC;",
+      // Q10
+      "SELECT c_custkey, c_name, SUM(l_extendedprice * (1 - l_discount)) AS revenue, c_acctbal, n_name, "
+      "c_address, c_phone, c_comment FROM customer, orders, lineitem, nation WHERE c_custkey = o_custkey "
+      "AND l_orderkey = o_orderkey AND o_orderdate >= date '1993-10-01' AND o_orderdate < date '1994-01-01' "
+      "AND l_returnflag = 'R' AND c_nationkey = n_nationkey "
+      "GROUP BY c_custkey, c_name, c_acctbal, c_phone, n_name, c_address, c_comment ORDER BY revenue DESC LIMIT 20;",
+      // Q11, whose fraction is 0.0001 / SF
+      "SELECT ps_partkey, SUM(ps_supplycost * ps_availqty) AS value FROM partsupp, supplier, nation "
+      "WHERE ps_suppkey = s_suppkey AND s_nationkey = n_nationkey AND n_name = 'GERMANY' GROUP BY ps_partkey "
+      "HAVING SUM(ps_supplycost * ps_availqty) > (SELECT SUM(ps_supplycost * ps_availqty) * " +
+          std::to_string(0.0001 / BenchmarkConfig::scale_factor) +
+          " FROM partsupp, supplier, nation WHERE ps_suppkey = s_suppkey AND s_nationkey = n_nationkey "
+          "AND n_name = 'GERMANY') ORDER BY value DESC;",
+      // Q12
+      "SELECT l_shipmode, SUM(CASE WHEN o_orderpriority = '1-URGENT' OR o_orderpriority = '2-HIGH' THEN 1 ELSE 0 "
+      "END) AS high_line_count, SUM(CASE WHEN o_orderpriority <> '1-URGENT' AND o_orderpriority <> '2-HIGH' "
+      "THEN 1 ELSE 0 END) AS low_line_count FROM orders, lineitem WHERE o_orderkey = l_orderkey "
+      "AND l_shipmode IN ('MAIL', 'SHIP') AND l_commitdate < l_receiptdate AND l_shipdate < l_commitdate "
+      "AND l_receiptdate >= date '1994-01-01' AND l_receiptdate < date '1995-01-01' GROUP BY l_shipmode "
+      "ORDER BY l_shipmode;",
+      // Q13
+      "SELECT c_count, COUNT(*) AS custdist FROM (SELECT c_custkey, COUNT(o_orderkey) AS c_count "
+      "FROM customer LEFT OUTER JOIN orders ON c_custkey = o_custkey AND o_comment NOT LIKE '%special%requests%' "
+      "GROUP BY c_custkey) AS c_orders GROUP BY c_count ORDER BY custdist DESC, c_count DESC;",
+      // Q14
+      "SELECT 100.00 * SUM(CASE WHEN p_type LIKE 'PROMO%' THEN l_extendedprice * (1 - l_discount) ELSE 0 END) / "
+      "SUM(l_extendedprice * (1 - l_discount)) AS promo_revenue FROM lineitem, part WHERE l_partkey = p_partkey "
+      "AND l_shipdate >= date '1995-09-01' AND l_shipdate < date '1995-10-01';",
+      // Q15, with the view as a common table expression
+      "WITH revenue0 (supplier_no, total_revenue) AS (SELECT l_suppkey, SUM(l_extendedprice * (1 - l_discount)) "
+      "FROM lineitem WHERE l_shipdate >= date '1996-01-01' AND l_shipdate < date '1996-04-01' GROUP BY l_suppkey) "
+      "SELECT s_suppkey, s_name, s_address, s_phone, total_revenue FROM supplier, revenue0 "
+      "WHERE s_suppkey = supplier_no AND total_revenue = (SELECT MAX(total_revenue) FROM revenue0) "
+      "ORDER BY s_suppkey;",
+      // Q16
+      "SELECT p_brand, p_type, p_size, COUNT(DISTINCT ps_suppkey) AS supplier_cnt FROM partsupp, part "
+      "WHERE p_partkey = ps_partkey AND p_brand <> 'Brand#45' AND p_type NOT LIKE 'MEDIUM POLISHED%' "
+      "AND p_size IN (49, 14, 23, 45, 19, 3, 36, 9) AND ps_suppkey NOT IN (SELECT s_suppkey FROM supplier "
+      "WHERE s_comment LIKE '%Customer%Complaints%') GROUP BY p_brand, p_type, p_size "
+      "ORDER BY supplier_cnt DESC, p_brand, p_type, p_size;",
+      // Q17
+      "SELECT SUM(l_extendedprice) / 7.0 AS avg_yearly FROM lineitem, part WHERE p_partkey = l_partkey "
+      "AND p_brand = 'Brand#23' AND p_container = 'MED BOX' AND l_quantity < (SELECT 0.2 * AVG(l_quantity) "
+      "FROM lineitem WHERE l_partkey = p_partkey);",
+      // Q18
+      "SELECT c_name, c_custkey, o_orderkey, o_orderdate, o_totalprice, SUM(l_quantity) "
+      "FROM customer, orders, lineitem WHERE o_orderkey IN (SELECT l_orderkey FROM lineitem GROUP BY l_orderkey "
+      "HAVING SUM(l_quantity) > 300) AND c_custkey = o_custkey AND o_orderkey = l_orderkey "
+      "GROUP BY c_name, c_custkey, o_orderkey, o_orderdate, o_totalprice ORDER BY o_totalprice DESC, o_orderdate "
+      "LIMIT 100;",
+      // Q19
+      "SELECT SUM(l_extendedprice * (1 - l_discount)) AS revenue FROM lineitem, part WHERE (p_partkey = l_partkey "
+      "AND p_brand = 'Brand#12' AND p_container IN ('SM CASE', 'SM BOX', 'SM PACK', 'SM PKG') AND l_quantity >= 1 "
+      "AND l_quantity <= 11 AND p_size BETWEEN 1 AND 5 AND l_shipmode IN ('AIR', 'AIR REG') "
+      "AND l_shipinstruct = 'DELIVER IN PERSON') OR (p_partkey = l_partkey AND p_brand = 'Brand#23' "
+      "AND p_container IN ('MED BAG', 'MED BOX', 'MED PKG', 'MED PACK') AND l_quantity >= 10 AND l_quantity <= 20 "
+      "AND p_size BETWEEN 1 AND 10 AND l_shipmode IN ('AIR', 'AIR REG') AND l_shipinstruct = 'DELIVER IN PERSON') "
+      "OR (p_partkey = l_partkey AND p_brand = 'Brand#34' AND p_container IN ('LG CASE', 'LG BOX', 'LG PACK', "
+      "'LG PKG') AND l_quantity >= 20 AND l_quantity <= 30 AND p_size BETWEEN 1 AND 15 "
+      "AND l_shipmode IN ('AIR', 'AIR REG') AND l_shipinstruct = 'DELIVER IN PERSON');",
+      // Q20
+      "SELECT s_name, s_address FROM supplier, nation WHERE s_suppkey IN (SELECT ps_suppkey FROM partsupp "
+      "WHERE ps_partkey IN (SELECT p_partkey FROM part WHERE p_name LIKE 'forest%') AND ps_availqty > "
+      "(SELECT 0.5 * SUM(l_quantity) FROM lineitem WHERE l_partkey = ps_partkey AND l_suppkey = ps_suppkey "
+      "AND l_shipdate >= date '1994-01-01' AND l_shipdate < date '1995-01-01')) AND s_nationkey = n_nationkey "
+      "AND n_name = 'CANADA' ORDER BY s_name;",
+      // Q21
+      "SELECT s_name, COUNT(*) AS numwait FROM supplier, lineitem l1, orders, nation "
+      "WHERE s_suppkey = l1.l_suppkey AND o_orderkey = l1.l_orderkey AND o_orderstatus = 'F' "
+      "AND l1.l_receiptdate > l1.l_commitdate AND EXISTS (SELECT * FROM lineitem l2 "
+      "WHERE l2.l_orderkey = l1.l_orderkey AND l2.l_suppkey <> l1.l_suppkey) AND NOT EXISTS (SELECT * "
+      "FROM lineitem l3 WHERE l3.l_orderkey = l1.l_orderkey AND l3.l_suppkey <> l1.l_suppkey "
+      "AND l3.l_receiptdate > l3.l_commitdate) AND s_nationkey = n_nationkey AND n_name = 'SAUDI ARABIA' "
+      "GROUP BY s_name ORDER BY numwait DESC, s_name LIMIT 100;",
+      // Q22
+      "SELECT cntrycode, COUNT(*) AS numcust, SUM(c_acctbal) AS totacctbal FROM (SELECT SUBSTRING(c_phone, 1, 2) "
+      "AS cntrycode, c_acctbal FROM customer WHERE SUBSTRING(c_phone, 1, 2) IN ('13', '31', '23', '29', '30', '18', "
+      "'17') AND c_acctbal > (SELECT AVG(c_acctbal) FROM customer WHERE c_acctbal > 0.00 "
+      "AND SUBSTRING(c_phone, 1, 2) IN ('13', '31', '23', '29', '30', '18', '17')) AND NOT EXISTS (SELECT * "
+      "FROM orders WHERE o_custkey = c_custkey)) AS custsale GROUP BY cntrycode ORDER BY cntrycode;"};
+}
+
+BenchmarkSuite::Query BenchmarkSuite::PrepareQuery(common::ManagedPointer<DBMain> db_main, catalog::db_oid_t db_oid,
+                                                   std::string name, const std::string &sql) {
+  auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+  auto catalog = db_main->GetCatalogLayer()->GetCatalog();
+  Query query{std::move(name), nullptr, nullptr, ""};
+
+  auto *txn = txn_manager->BeginTransaction();
+  try {
+    auto accessor = catalog->GetAccessor(common::ManagedPointer(txn), db_oid, DISABLED);
+    auto stmt_list = parser::PostgresParser::BuildParseTree(sql);
+    binder::BindNodeVisitor binder(common::ManagedPointer(accessor), db_oid);
+    binder.BindNameToNode(common::ManagedPointer(stmt_list), nullptr, nullptr);
+    auto optimize_result = trafficcop::TrafficCopUtil::Optimize(
+        common::ManagedPointer(txn), common::ManagedPointer(accessor), common::ManagedPointer(stmt_list), db_oid,
+        db_main->GetStatsStorage(), std::make_unique<optimizer::TrivialCostModel>(), optimizer_timeout_, nullptr);
+    query.plan_ = optimize_result->TakePlanNodeOwnership();
+
+    execution::exec::ExecutionSettings exec_settings{};
+    query.executable_ = execution::compiler::CompilationContext::Compile(
+        *query.plan_, exec_settings, accessor.get(), execution::compiler::CompilationMode::OneShot);
+  } catch (const std::exception &e) {
+    query.plan_ = nullptr;
+    query.executable_ = nullptr;
+    query.error_ = e.what();
+    txn_manager->Abort(txn);
+    return query;
+  }
+  txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  return query;
+}
+
+void BenchmarkSuite::ExecuteQuery(common::ManagedPointer<DBMain> db_main, catalog::db_oid_t db_oid,
+                                  const Query &query, execution::vm::ExecutionMode mode) {
+  auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+  auto *txn = txn_manager->BeginTransaction();
+  auto accessor = db_main->GetCatalogLayer()->GetCatalog()->GetAccessor(common::ManagedPointer(txn), db_oid, DISABLED);
+
+  execution::exec::NoOpResultConsumer consumer;
+  execution::exec::OutputCallback callback = consumer;
+  execution::exec::ExecutionSettings exec_settings{};
+  execution::exec::ExecutionContext exec_ctx{db_oid,
+                                             common::ManagedPointer(txn),
+                                             callback,
+                                             query.plan_->GetOutputSchema().Get(),
+                                             common::ManagedPointer(accessor),
+                                             exec_settings,
+                                             DISABLED,
+                                             DISABLED,
+                                             DISABLED};
+  query.executable_->Run(common::ManagedPointer(&exec_ctx), mode);
+  txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+void BenchmarkSuite::RunTPCH() {
+  const auto scale_factor = BenchmarkConfig::scale_factor;
+  const auto table_root = std::filesystem::temp_directory_path() / ("noisepage_tpch_sf" + std::to_string(scale_factor));
+  std::filesystem::create_directories(table_root);
+  tpch::TPCHGenerator::Generate(scale_factor, table_root.string() + "/");
+
+  auto db_main = DBMain::Builder()
+                     .SetUseGC(true)
+                     .SetUseCatalog(true)
+                     .SetUseGCThread(true)
+                     .SetUseStatsStorage(true)
+                     .SetUseExecution(true)
+                     .SetBlockStoreSize(1000000)
+                     .SetBlockStoreReuse(1000000)
+                     .SetRecordBufferSegmentSize(1000000)
+                     .SetRecordBufferSegmentReuse(1000000)
+                     .SetBytecodeHandlersPath(common::GetBinaryArtifactPath("bytecode_handlers_ir.bc"))
+                     .Build();
+  const auto db_main_ptr = common::ManagedPointer(db_main);
+  auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+  auto catalog = db_main->GetCatalogLayer()->GetCatalog();
+
+  // Load the tables
+  auto *txn = txn_manager->BeginTransaction();
+  const auto db_oid = catalog->CreateDatabase(common::ManagedPointer(txn), "benchmark_suite_tpch", true);
+  {
+    auto accessor = catalog->GetAccessor(common::ManagedPointer(txn), db_oid, DISABLED);
+    execution::exec::ExecutionSettings exec_settings{};
+    execution::exec::ExecutionContext exec_ctx{
+        db_oid,   common::ManagedPointer(txn), nullptr, nullptr, common::ManagedPointer(accessor), exec_settings,
+        DISABLED, DISABLED,                    DISABLED};
+    execution::sql::TableReader table_reader(&exec_ctx, db_main->GetStorageLayer()->GetBlockStore().Get(),
+                                             accessor->GetDefaultNamespace());
+    for (const auto &table_name : tpch::TPCHGenerator::TABLE_NAMES) {
+      const auto table_path = (table_root / table_name).string();
+      table_reader.ReadTable(table_path + ".schema", table_path + ".data");
+    }
+  }
+  txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  std::filesystem::remove_all(table_root);
+
+  const auto sqls = TPCHQueries();
+  for (size_t i = 0; i < sqls.size(); i++) {
+    const auto name = std::string(i < 9 ? "q0" : "q") + std::to_string(i + 1);
+    const auto query = PrepareQuery(db_main_ptr, db_oid, name, sqls[i]);
+
+    for (const auto &[mode, mode_name] : modes_) {
+      if (query.plan_ == nullptr) {
+        results_.AddFailure({"tpch", name, mode_name, 1, scale_factor, false}, "unsupported", query.error_);
+        continue;
+      }
+
+      // Warm up, which is also when compiled code is generated, and make sure that the query runs at all
+      try {
+        ExecuteQuery(db_main_ptr, db_oid, query, mode);
+      } catch (const std::exception &e) {
+        results_.AddFailure({"tpch", name, mode_name, 1, scale_factor, false}, "error", e.what());
+        continue;
+      }
+
+      for (uint32_t num_threads = 1; num_threads <= BenchmarkConfig::num_threads; num_threads++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));  // Let GC clean up
+        std::vector<std::vector<uint64_t>> latencies_us(num_threads);
+        common::WorkerPool thread_pool{num_threads, {}};
+        thread_pool.Startup();
+
+        uint64_t elapsed_us;
+        {
+          common::ScopedTimer<std::chrono::microseconds> timer(&elapsed_us);
+          for (uint32_t thread = 0; thread < num_threads; thread++) {
+            thread_pool.SubmitTask([&, thread, mode = mode] {
+              const auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(tpch_us_per_configuration_);
+              do {
+                const auto start = std::chrono::steady_clock::now();
+                ExecuteQuery(db_main_ptr, db_oid, query, mode);
+                latencies_us[thread].push_back(static_cast<uint64_t>(
+                    std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start)
+                        .count()));
+              } while (std::chrono::steady_clock::now() < end);
+            });
+          }
+          thread_pool.WaitUntilAllFinished();
+        }
+        thread_pool.Shutdown();
+
+        std::vector<uint64_t> all_latencies_us;
+        for (const auto &thread_latencies_us : latencies_us) {
+          all_latencies_us.insert(all_latencies_us.end(), thread_latencies_us.begin(), thread_latencies_us.end());
+        }
+        results_.AddResult({"tpch", name, mode_name, num_threads, scale_factor, false}, elapsed_us,
+                           std::move(all_latencies_us));
+      }
+    }
+  }
+}
+
+void BenchmarkSuite::RunTPCC() {
+  // TPC-C scales out by its number of warehouses, which is one per terminal (worker thread)
+  std::default_random_engine generator;
+  tpcc::TransactionWeights txn_weights;
+  storage::BlockStore block_store{1000, 1000};
+  storage::RecordBufferSegmentPool buffer_pool{1000000, 1000000};
+  common::ConcurrentBlockingQueue<storage::BufferedLogWriter *> empty_buffer_queue;
+
+  for (uint32_t num_threads = 1; num_threads <= BenchmarkConfig::num_threads; num_threads++) {
+    common::WorkerPool thread_pool(num_threads, {});
+    std::vector<tpcc::Worker> workers;
+    workers.reserve(num_threads);
+    const auto precomputed_args = tpcc::PrecomputeArgs(&generator, txn_weights, num_threads, tpcc_txns_per_worker_);
+    std::vector<std::vector<uint64_t>> latencies_us(num_threads);
+
+    thread_pool.Startup();
+    unlink(BenchmarkConfig::logfile_path.data());
+    auto *thread_registry = new common::DedicatedThreadRegistry(DISABLED);
+    auto *log_manager = new storage::LogManager(
+        BenchmarkConfig::logfile_path.data(), 100, std::chrono::microseconds{100}, std::chrono::microseconds{100},
+        (1U << 20U), common::ManagedPointer(&buffer_pool), common::ManagedPointer(&empty_buffer_queue), DISABLED,
+        common::ManagedPointer(thread_registry));
+    log_manager->Start();
+    transaction::TimestampManager timestamp_manager;
+    transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+    transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                                common::ManagedPointer(&deferred_action_manager),
+                                                common::ManagedPointer(&buffer_pool),
+                                                true,
+                                                false,
+                                                common::ManagedPointer(log_manager)};
+    auto *gc = new storage::GarbageCollector(common::ManagedPointer(&timestamp_manager),
+                                             common::ManagedPointer(&deferred_action_manager),
+                                             common::ManagedPointer(&txn_manager), DISABLED);
+    catalog::Catalog catalog{common::ManagedPointer(&txn_manager), common::ManagedPointer(&block_store),
+                             common::ManagedPointer(gc)};
+    tpcc::Builder tpcc_builder{common::ManagedPointer(&block_store), common::ManagedPointer(&catalog),
+                               common::ManagedPointer(&txn_manager)};
+    auto *const tpcc_db = tpcc_builder.Build(storage::index::IndexType::HASHMAP);
+    for (uint32_t i = 0; i < num_threads; i++) workers.emplace_back(tpcc_db);
+
+    tpcc::Loader::PopulateDatabase(common::ManagedPointer(&txn_manager), tpcc_db, &workers, &thread_pool);
+    log_manager->ForceFlush();
+    auto *gc_thread = new storage::GarbageCollectorThread(common::ManagedPointer(gc), std::chrono::microseconds{1000},
+                                                          nullptr);
+    std::this_thread::sleep_for(std::chrono::seconds(2));  // Let GC clean up
+
+    uint64_t elapsed_us;
+    {
+      common::ScopedTimer<std::chrono::microseconds> timer(&elapsed_us);
+      for (uint32_t i = 0; i < num_threads; i++) {
+        thread_pool.SubmitTask([i, tpcc_db, &txn_manager, &precomputed_args, &workers, &latencies_us] {
+          tpcc::Workload(static_cast<int8_t>(i), tpcc_db, &txn_manager, precomputed_args, &workers, &latencies_us[i]);
+        });
+      }
+      thread_pool.WaitUntilAllFinished();
+      log_manager->ForceFlush();
+    }
+
+    // The specification only reports New Order, but most academic papers use all txn types
+    std::vector<uint64_t> all_latencies_us;
+    std::vector<uint64_t> new_order_latencies_us;
+    for (uint32_t i = 0; i < num_threads; i++) {
+      for (size_t txn = 0; txn < latencies_us[i].size(); txn++) {
+        all_latencies_us.push_back(latencies_us[i][txn]);
+        if (precomputed_args[i][txn].type_ == tpcc::TransactionType::NewOrder) {
+          new_order_latencies_us.push_back(latencies_us[i][txn]);
+        }
+      }
+    }
+    const auto warehouses = static_cast<double>(num_threads);
+    results_.AddResult({"tpcc", "all", "", num_threads, warehouses, true}, elapsed_us, std::move(all_latencies_us));
+    results_.AddResult({"tpcc", "new_order", "", num_threads, warehouses, true}, elapsed_us,
+                       std::move(new_order_latencies_us));
+
+    delete gc_thread;
+    catalog.TearDown();
+    deferred_action_manager.FullyPerformGC(common::ManagedPointer(gc), common::ManagedPointer(log_manager));
+    thread_pool.Shutdown();
+    log_manager->PersistAndStop();
+    delete log_manager;
+    delete gc;
+    delete thread_registry;
+    delete tpcc_db;
+    tpcc::CleanUpVarlensInPrecomputedArgs(&precomputed_args);
+  }
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(BenchmarkSuite, Suite)(benchmark::State &state) {
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      RunTPCH();
+      RunTPCC();
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  results_.Write(std::string(BenchmarkConfig::results_path));
+}
+
+BENCHMARK_REGISTER_F(BenchmarkSuite, Suite)->Unit(benchmark::kMillisecond)->UseManualTime()->Iterations(1);
+}  // namespace noisepage
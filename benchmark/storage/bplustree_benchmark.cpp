@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -262,6 +264,66 @@ BENCHMARK_DEFINE_F(BPlusTreeBenchmark, SequentialInsertSequentialRead)(benchmark
   }
 }
 
+// Random lookups while one of the threads keeps inserting new keys. The argument selects whether lookups descend with
+// optimistic lock coupling (1) or with shared latch crabbing (0).
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(BPlusTreeBenchmark, RandomReadConcurrentInsert)(benchmark::State &state) {
+  common::WorkerPool thread_pool(BenchmarkConfig::num_threads, {});
+  thread_pool.Startup();
+
+  {
+    auto tree = std::make_unique<storage::index::BPlusTree<int64_t, int64_t>>();
+    tree->SetOptimisticReads(state.range(0) != 0);
+    for (uint32_t i = 0; i < num_keys_; i++) {
+      storage::index::BPlusTree<int64_t, int64_t>::KeyElementPair p1;
+      p1.first = key_permutation_[i];
+      p1.second = key_permutation_[i];
+      tree->Insert(p1, predicate_);
+    }
+
+    int64_t next_key = num_keys_;
+    const uint32_t num_readers = std::max(BenchmarkConfig::num_threads - 1, 1U);
+    // NOLINTNEXTLINE
+    for (auto _ : state) {
+      std::atomic<uint32_t> readers_done = 0;
+      auto workload = [&](uint32_t id) {
+        if (id == num_readers) {
+          // Writer: insert new keys until the readers are done
+          while (readers_done < num_readers) {
+            storage::index::BPlusTree<int64_t, int64_t>::KeyElementPair p1;
+            p1.first = next_key;
+            p1.second = next_key;
+            tree->Insert(p1, predicate_);
+            next_key++;
+          }
+          return;
+        }
+
+        uint32_t start_key = num_keys_ / num_readers * id;
+        uint32_t end_key = start_key + num_keys_ / num_readers;
+
+        std::vector<int64_t> values;
+        values.reserve(1);
+
+        for (uint32_t i = start_key; i < end_key; i++) {
+          tree->FindValueOfKey(key_permutation_[i], &values);
+          values.clear();
+        }
+        readers_done++;
+      };
+
+      uint64_t elapsed_ms;
+      {
+        common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+        MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, num_readers + 1, workload);
+      }
+      state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+    }
+
+    state.SetItemsProcessed(state.iterations() * num_keys_);
+  }
+}
+
 // ----------------------------------------------------------------------------
 // BENCHMARK REGISTRATION
 // ----------------------------------------------------------------------------
@@ -290,6 +352,12 @@ BENCHMARK_REGISTER_F(BPlusTreeBenchmark, SequentialInsertSequentialRead)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
     ->MinTime(3);
+BENCHMARK_REGISTER_F(BPlusTreeBenchmark, RandomReadConcurrentInsert)
+    ->Arg(0)
+    ->Arg(1)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(3);
 // clang-format on
 
 }  // namespace noisepage
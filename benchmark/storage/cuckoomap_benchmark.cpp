@@ -5,6 +5,7 @@
 #include "benchmark_util/benchmark_config.h"
 #include "common/scoped_timer.h"
 #include "libcuckoo/cuckoohash_map.hh"
+#include "storage/index/concurrent_hash_table.h"
 #include "test_util/multithread_test_util.h"
 #include "xxHash/xxh3.h"
 
@@ -38,6 +39,8 @@ class CuckooMapBenchmark : public benchmark::Fixture {
   };
 
   using CuckooMap = cuckoohash_map<int64_t, int64_t, KeyHash>;
+  // HashIndex's table, for comparison
+  using HashTable = storage::index::ConcurrentHashTable<int64_t, KeyHash>;
 
   std::default_random_engine generator_;
   std::vector<int64_t> key_permutation_;
@@ -249,6 +252,76 @@ BENCHMARK_DEFINE_F(CuckooMapBenchmark, SequentialInsertSequentialRead)(benchmark
   state.SetItemsProcessed(state.iterations() * num_keys_);
 }
 
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(CuckooMapBenchmark, HashTableRandomInsert)(benchmark::State &state) {
+  common::WorkerPool thread_pool(BenchmarkConfig::num_threads, {});
+  thread_pool.Startup();
+  const auto never = [](storage::TupleSlot) { return false; };
+  size_t heap_usage = 0;
+
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    auto *const index = new HashTable();
+
+    auto workload = [&](uint32_t id) {
+      uint32_t start_key = num_keys_ / BenchmarkConfig::num_threads * id;
+      uint32_t end_key = start_key + num_keys_ / BenchmarkConfig::num_threads;
+
+      for (uint32_t i = start_key; i < end_key; i++) {
+        index->Insert(key_permutation_[i], storage::TupleSlot(), never);
+      }
+    };
+
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, BenchmarkConfig::num_threads, workload);
+    }
+    heap_usage = index->GetHeapUsage();
+    delete index;
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  state.SetItemsProcessed(state.iterations() * num_keys_);
+  state.counters["HeapUsage"] = static_cast<double>(heap_usage);
+}
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(CuckooMapBenchmark, HashTableRandomInsertRandomRead)(benchmark::State &state) {
+  common::WorkerPool thread_pool(BenchmarkConfig::num_threads, {});
+  thread_pool.Startup();
+
+  auto *const index = new HashTable();
+  for (uint32_t i = 0; i < num_keys_; i++) {
+    index->Insert(key_permutation_[i], storage::TupleSlot(), [](storage::TupleSlot) { return false; });
+  }
+
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    auto workload = [&](uint32_t id) {
+      uint32_t start_key = num_keys_ / BenchmarkConfig::num_threads * id;
+      uint32_t end_key = start_key + num_keys_ / BenchmarkConfig::num_threads;
+
+      std::vector<storage::TupleSlot> values;
+      values.reserve(1);
+
+      for (uint32_t i = start_key; i < end_key; i++) {
+        index->Lookup(key_permutation_[i], &values);
+        values.clear();
+      }
+    };
+
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, BenchmarkConfig::num_threads, workload);
+    }
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+
+  delete index;
+  state.SetItemsProcessed(state.iterations() * num_keys_);
+}
+
 // ----------------------------------------------------------------------------
 // BENCHMARK REGISTRATION
 // ----------------------------------------------------------------------------
@@ -277,6 +350,14 @@ BENCHMARK_REGISTER_F(CuckooMapBenchmark, SequentialInsertSequentialRead)
     ->Unit(benchmark::kMillisecond)
     ->UseManualTime()
     ->MinTime(3);
+BENCHMARK_REGISTER_F(CuckooMapBenchmark, HashTableRandomInsert)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(10);
+BENCHMARK_REGISTER_F(CuckooMapBenchmark, HashTableRandomInsertRandomRead)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->MinTime(3);
 // clang-format on
 
 }  // namespace noisepage
@@ -1,3 +1,4 @@
+#include <memory>
 #include <vector>
 
 #include "benchmark/benchmark.h"
@@ -20,6 +21,9 @@ namespace noisepage {
 class DataTableBenchmark : public benchmark::Fixture {
  public:
   void SetUp(const benchmark::State &state) final {
+    // The argument of every benchmark decides whether blocks are backed by huge pages
+    block_store_ = std::make_unique<storage::BlockStore>(1000, 1000, state.range(0) != 0);
+
     // generate a random redo ProjectedRow to Insert
     redo_buffer_ = common::AllocationUtil::AllocateAligned(initializer_.ProjectedRowSize());
     redo_ = initializer_.InitializeRow(redo_buffer_);
@@ -46,6 +50,7 @@ class DataTableBenchmark : public benchmark::Fixture {
     // google benchmark might run benchmark several iterations. We need to clear vectors.
     read_buffers_.clear();
     reads_.clear();
+    block_store_.reset();
   }
 
   // Tuple layout
@@ -63,7 +68,7 @@ class DataTableBenchmark : public benchmark::Fixture {
 
   // Test infrastructure
   std::default_random_engine generator_;
-  storage::BlockStore block_store_{1000, 1000};
+  std::unique_ptr<storage::BlockStore> block_store_;
   storage::RecordBufferSegmentPool buffer_pool_{num_inserts_, buffer_pool_reuse_limit_};
 
   // Insert buffer pointers
@@ -84,7 +89,7 @@ class DataTableBenchmark : public benchmark::Fixture {
 BENCHMARK_DEFINE_F(DataTableBenchmark, Insert)(benchmark::State &state) {
   // NOLINTNEXTLINE
   for (auto _ : state) {
-    storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout_,
+    storage::DataTable table(common::ManagedPointer<storage::BlockStore>(block_store_.get()), layout_,
                              storage::layout_version_t(0));
     auto workload = [&](uint32_t id) {
       // We can use dummy timestamps here since we're not invoking concurrency control
@@ -112,7 +117,7 @@ BENCHMARK_DEFINE_F(DataTableBenchmark, Insert)(benchmark::State &state) {
 // Read the num_reads_ of tuples in a random order from a DataTable concurrently
 // NOLINTNEXTLINE
 BENCHMARK_DEFINE_F(DataTableBenchmark, SelectRandom)(benchmark::State &state) {
-  storage::DataTable read_table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout_,
+  storage::DataTable read_table(common::ManagedPointer<storage::BlockStore>(block_store_.get()), layout_,
                                 storage::layout_version_t(0));
 
   // populate read_table_ by inserting tuples
@@ -161,7 +166,7 @@ BENCHMARK_DEFINE_F(DataTableBenchmark, SelectRandom)(benchmark::State &state) {
 // Read the num_reads_ of tuples in the sequential  order from a DataTable concurrently
 // NOLINTNEXTLINE
 BENCHMARK_DEFINE_F(DataTableBenchmark, SelectSequential)(benchmark::State &state) {
-  storage::DataTable read_table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout_,
+  storage::DataTable read_table(common::ManagedPointer<storage::BlockStore>(block_store_.get()), layout_,
                                 storage::layout_version_t(0));
 
   // populate read_table_ by inserting tuples
@@ -202,7 +207,7 @@ BENCHMARK_DEFINE_F(DataTableBenchmark, SelectSequential)(benchmark::State &state
 // Read the num_reads_ of tuples in the sequential  order from a DataTable concurrently
 // NOLINTNEXTLINE
 BENCHMARK_DEFINE_F(DataTableBenchmark, Scan)(benchmark::State &state) {
-  storage::DataTable read_table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout_,
+  storage::DataTable read_table(common::ManagedPointer<storage::BlockStore>(block_store_.get()), layout_,
                                 storage::layout_version_t(0));
 
   // populate read_table_ by inserting tuples
@@ -257,18 +262,30 @@ BENCHMARK_DEFINE_F(DataTableBenchmark, Scan)(benchmark::State &state) {
 // ----------------------------------------------------------------------------
 // clang-format off
 BENCHMARK_REGISTER_F(DataTableBenchmark, Insert)
+    ->ArgName("huge_pages")
+    ->Arg(0)
+    ->Arg(1)
     ->Unit(benchmark::kMillisecond)
     ->UseRealTime()
     ->UseManualTime();
 BENCHMARK_REGISTER_F(DataTableBenchmark, SelectRandom)
+    ->ArgName("huge_pages")
+    ->Arg(0)
+    ->Arg(1)
     ->Unit(benchmark::kMillisecond)
     ->UseRealTime()
     ->UseManualTime();
 BENCHMARK_REGISTER_F(DataTableBenchmark, SelectSequential)
+    ->ArgName("huge_pages")
+    ->Arg(0)
+    ->Arg(1)
     ->Unit(benchmark::kMillisecond)
     ->UseRealTime()
     ->UseManualTime();
 BENCHMARK_REGISTER_F(DataTableBenchmark, Scan)
+    ->ArgName("huge_pages")
+    ->Arg(0)
+    ->Arg(1)
     ->Unit(benchmark::kMillisecond)
     ->UseRealTime()
     ->UseManualTime();
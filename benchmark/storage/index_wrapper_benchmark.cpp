@@ -197,6 +197,7 @@ BENCHMARK_DEFINE_F(IndexBenchmark, HashIndexRandomScanKey)(benchmark::State &sta
   }
   // Determine total number of items processed
   state.SetItemsProcessed(state.iterations() * table_size_);
+  state.counters["HeapUsage"] = static_cast<double>(index_->EstimateHeapUsage());
 }
 
 // ----------------------------------------------------------------------------
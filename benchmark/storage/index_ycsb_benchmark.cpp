@@ -0,0 +1,340 @@
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "benchmark_util/benchmark_config.h"
+#include "common/hash_util.h"
+#include "common/scoped_timer.h"
+#include "main/db_main.h"
+#include "parser/expression/column_value_expression.h"
+#include "storage/garbage_collector.h"
+#include "storage/index/index.h"
+#include "storage/index/index_builder.h"
+#include "storage/sql_table.h"
+#include "test_util/catalog_test_util.h"
+#include "test_util/multithread_test_util.h"
+#include "test_util/storage_test_util.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace noisepage {
+
+/**
+ * Draws ranks in [0, n) with a Zipfian distribution, rank 0 being the most popular, as YCSB's ZipfianGenerator does
+ * (Gray et al., "Quickly Generating Billion-Record Synthetic Databases", SIGMOD 1994).
+ */
+class ZipfianGenerator {
+ public:
+  /** YCSB's default skew */
+  static constexpr double THETA = 0.99;
+
+  explicit ZipfianGenerator(uint64_t n) : n_(n) {
+    double zeta_n = 0;
+    for (uint64_t i = 1; i <= n; i++) zeta_n += 1.0 / std::pow(static_cast<double>(i), THETA);
+    const double zeta_2 = 1.0 + 1.0 / std::pow(2.0, THETA);
+    zeta_n_ = zeta_n;
+    alpha_ = 1.0 / (1.0 - THETA);
+    eta_ = (1.0 - std::pow(2.0 / static_cast<double>(n), 1.0 - THETA)) / (1.0 - zeta_2 / zeta_n);
+  }
+
+  /** @return the next rank */
+  template <typename Random>
+  uint64_t Next(Random *generator) const {
+    const double u = std::uniform_real_distribution<double>(0.0, 1.0)(*generator);
+    const double uz = u * zeta_n_;
+    if (uz < 1.0) return 0;
+    if (uz < 1.0 + std::pow(0.5, THETA)) return 1;
+    const auto rank = static_cast<uint64_t>(static_cast<double>(n_) * std::pow(eta_ * u - eta_ + 1.0, alpha_));
+    return std::min(rank, n_ - 1);
+  }
+
+ private:
+  uint64_t n_;
+  double zeta_n_;
+  double alpha_;
+  double eta_;
+};
+
+/**
+ * These benchmarks drive storage::index::Index implementations with the YCSB core workloads, each operation in its own
+ * transaction against a table that the index points into, with the garbage collector running:
+ * - A: 50% reads, 50% updates
+ * - B: 95% reads, 5% updates
+ * - C: 100% reads
+ * - D: 95% reads of the latest keys, 5% inserts
+ * - E: 95% short range scans, 5% inserts
+ * - F: 50% reads, 50% read-modify-writes
+ * An update moves a key to a new version of its tuple, i.e., it deletes the tuple and its index entry and inserts both
+ * again, which is what an index sees when an indexed column is updated. Keys are drawn from a scrambled Zipfian
+ * distribution, except for D's, which favor the keys inserted last.
+ *
+ * The arguments are the index type, whether the key is a CompactIntsKey or a GenericKey, and the workload. The number
+ * of threads is BenchmarkConfig::num_threads. Besides the throughput, every benchmark reports the 99th percentile
+ * latency of an operation and the heap usage of the index at the end of the run.
+ */
+class IndexYcsbBenchmark : public benchmark::Fixture {
+ public:
+  /** The number of keys loaded before the workload runs */
+  static constexpr uint64_t NUM_KEYS = 1 << 20;
+  /** The number of operations each thread runs in every iteration */
+  static constexpr uint32_t OPS_PER_THREAD = 1 << 18;
+  /** The longest range scan of workload E */
+  static constexpr uint32_t MAX_SCAN_LENGTH = 100;
+
+  /** The YCSB core workloads */
+  enum class Workload : uint8_t { A, B, C, D, E, F };
+
+  /** The index types that the benchmarks run on */
+  static constexpr storage::index::IndexType INDEX_TYPES[] = {
+      storage::index::IndexType::BWTREE, storage::index::IndexType::BPLUSTREE, storage::index::IndexType::ART,
+      storage::index::IndexType::HASHMAP};
+  /** The names of the arguments */
+  static constexpr const char *INDEX_TYPE_NAMES[] = {"BwTree", "BPlusTree", "Art", "Hash"};
+  static constexpr const char *KEY_NAMES[] = {"CompactIntsKey", "GenericKey"};
+  static constexpr const char *WORKLOAD_NAMES[] = {"A", "B", "C", "D", "E", "F"};
+
+  void SetUp(const benchmark::State &state) final {
+    db_main_ = DBMain::Builder().SetUseGC(true).SetUseGCThread(true).SetRecordBufferSegmentSize(1e6).Build();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+
+    auto col = catalog::Schema::Column("attribute", type::TypeId::BIGINT, false,
+                                       parser::ConstantValueExpression(type::TypeId::BIGINT));
+    StorageTestUtil::ForceOid(&(col), catalog::col_oid_t(1));
+    table_schema_ = catalog::Schema({col});
+    sql_table_ = new storage::SqlTable(db_main_->GetStorageLayer()->GetBlockStore(), table_schema_);
+    tuple_initializer_ = sql_table_->InitializerForProjectedRow({catalog::col_oid_t(1)});
+
+    // A NULL-able key can't be a CompactIntsKey, so the same BIGINT column makes a GenericKey
+    const bool generic_key = state.range(1) == 1;
+    std::vector<catalog::IndexSchema::Column> keycols;
+    keycols.emplace_back("", type::TypeId::BIGINT, generic_key,
+                         parser::ColumnValueExpression(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID,
+                                                       catalog::col_oid_t(1)));
+    StorageTestUtil::ForceOid(&(keycols[0]), catalog::indexkeycol_oid_t(1));
+    index_schema_ = catalog::IndexSchema(keycols, INDEX_TYPES[state.range(0)], false, false, false, true);
+    index_ = storage::index::IndexBuilder().SetKeySchema(index_schema_).Build();
+    db_main_->GetStorageLayer()->GetGarbageCollector()->RegisterIndexForGC(common::ManagedPointer(index_));
+
+    // Load the keys in a random order
+    std::vector<int64_t> keys(NUM_KEYS);
+    for (uint64_t i = 0; i < NUM_KEYS; i++) keys[i] = static_cast<int64_t>(i);
+    std::shuffle(keys.begin(), keys.end(), std::mt19937_64(NUM_KEYS));
+    auto *const key_buffer = common::AllocationUtil::AllocateAligned(KeySize());
+    auto *const load_txn = txn_manager_->BeginTransaction();
+    for (const auto key : keys) InsertKey(load_txn, key, key_buffer);
+    txn_manager_->Commit(load_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    delete[] key_buffer;
+    next_key_ = NUM_KEYS;
+  }
+
+  void TearDown(const benchmark::State &state) final {
+    db_main_->GetStorageLayer()->GetGarbageCollector()->UnregisterIndexForGC(common::ManagedPointer(index_));
+    auto *const sql_table = sql_table_;
+    auto *const index = index_;
+    db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() {
+      delete sql_table;
+      delete index;
+    });
+    db_main_.reset();
+  }
+
+  /** Run a workload on every thread, and report its throughput, tail latency and the heap usage of the index */
+  void RunWorkload(benchmark::State *state) {
+    const auto workload = static_cast<Workload>(state->range(2));
+    const uint32_t num_threads = BenchmarkConfig::num_threads;
+    common::WorkerPool thread_pool(num_threads, {});
+    thread_pool.Startup();
+    const ZipfianGenerator zipfian(NUM_KEYS);
+    std::vector<std::vector<uint64_t>> latencies_ns(num_threads);
+    std::atomic<uint64_t> num_aborts = 0;
+
+    // NOLINTNEXTLINE
+    for (auto _ : *state) {
+      auto run = [&](uint32_t thread_id) {
+        std::mt19937_64 generator(thread_id + 1);
+        auto *const key_buffer = common::AllocationUtil::AllocateAligned(KeySize());
+        auto *const high_key_buffer = common::AllocationUtil::AllocateAligned(KeySize());
+        auto &latencies = latencies_ns[thread_id];
+        latencies.reserve(latencies.size() + OPS_PER_THREAD);
+        for (uint32_t i = 0; i < OPS_PER_THREAD; i++) {
+          const auto percent = std::uniform_int_distribution<uint32_t>(0, 99)(generator);
+          uint64_t elapsed_ns;
+          bool committed;
+          {
+            common::ScopedTimer<std::chrono::nanoseconds> timer(&elapsed_ns);
+            committed = RunOperation(workload, percent, zipfian, &generator, key_buffer, high_key_buffer);
+          }
+          latencies.push_back(elapsed_ns);
+          if (!committed) num_aborts.fetch_add(1, std::memory_order_relaxed);
+        }
+        delete[] key_buffer;
+        delete[] high_key_buffer;
+      };
+
+      uint64_t elapsed_ms;
+      {
+        common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+        MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, num_threads, run);
+      }
+      state->SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+    }
+    thread_pool.Shutdown();
+
+    std::vector<uint64_t> all_latencies_ns;
+    for (const auto &latencies : latencies_ns) {
+      all_latencies_ns.insert(all_latencies_ns.end(), latencies.begin(), latencies.end());
+    }
+    const auto p99 = all_latencies_ns.begin() + all_latencies_ns.size() * 99 / 100;
+    std::nth_element(all_latencies_ns.begin(), p99, all_latencies_ns.end());
+
+    state->SetItemsProcessed(state->iterations() * num_threads * OPS_PER_THREAD);
+    state->SetLabel(std::string(INDEX_TYPE_NAMES[state->range(0)]) + "/" + KEY_NAMES[state->range(1)] + "/YCSB-" +
+                    WORKLOAD_NAMES[state->range(2)]);
+    state->counters["P99LatencyNs"] = static_cast<double>(*p99);
+    state->counters["Aborts"] = static_cast<double>(num_aborts.load());
+    state->counters["HeapUsage"] = static_cast<double>(index_->EstimateHeapUsage());
+  }
+
+ private:
+  uint32_t KeySize() const { return index_->GetProjectedRowInitializer().ProjectedRowSize(); }
+
+  storage::ProjectedRow *MakeKey(byte *key_buffer, const int64_t key) const {
+    auto *const key_pr = index_->GetProjectedRowInitializer().InitializeRow(key_buffer);
+    *reinterpret_cast<int64_t *>(key_pr->AccessForceNotNull(0)) = key;
+    return key_pr;
+  }
+
+  // A key that a scrambled Zipfian distribution picks, which spreads the popular keys over the key space
+  template <typename Random>
+  static int64_t ZipfianKey(const ZipfianGenerator &zipfian, Random *generator) {
+    return static_cast<int64_t>(common::HashUtil::Hash(zipfian.Next(generator)) % NUM_KEYS);
+  }
+
+  // Insert a tuple and its key
+  void InsertKey(transaction::TransactionContext *const txn, const int64_t key, byte *const key_buffer) {
+    auto *const redo =
+        txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_initializer_);
+    *reinterpret_cast<int64_t *>(redo->Delta()->AccessForceNotNull(0)) = key;
+    const auto slot = sql_table_->Insert(common::ManagedPointer(txn), redo);
+    index_->Insert(common::ManagedPointer(txn), *MakeKey(key_buffer, key), slot);
+  }
+
+  // Look a key up
+  void ReadKey(const transaction::TransactionContext &txn, const int64_t key, byte *const key_buffer) {
+    std::vector<storage::TupleSlot> results;
+    index_->ScanKey(txn, *MakeKey(key_buffer, key), &results);
+    benchmark::DoNotOptimize(results.data());
+  }
+
+  // Move a key to a new version of its tuple. Returns false on a write-write conflict.
+  bool UpdateKey(transaction::TransactionContext *const txn, const int64_t key, byte *const key_buffer) {
+    std::vector<storage::TupleSlot> results;
+    auto *const key_pr = MakeKey(key_buffer, key);
+    index_->ScanKey(*txn, *key_pr, &results);
+    if (results.empty()) return true;
+    txn->StageDelete(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, results[0]);
+    if (!sql_table_->Delete(common::ManagedPointer(txn), results[0])) return false;
+    index_->Delete(common::ManagedPointer(txn), *key_pr, results[0]);
+    InsertKey(txn, key, key_buffer);
+    return true;
+  }
+
+  // Scan a short range of keys
+  template <typename Random>
+  void ScanKeys(const transaction::TransactionContext &txn, const int64_t key, Random *generator,
+                byte *const key_buffer, byte *const high_key_buffer) {
+    const auto length = std::uniform_int_distribution<uint32_t>(1, MAX_SCAN_LENGTH)(*generator);
+    std::vector<storage::TupleSlot> results;
+    index_->ScanAscending(txn, storage::index::ScanType::Closed, 1, MakeKey(key_buffer, key),
+                          MakeKey(high_key_buffer, key + length - 1), length, &results);
+    benchmark::DoNotOptimize(results.data());
+  }
+
+  // Run one operation of a workload in its own txn, given a percentage that picks the operation. Returns whether the
+  // txn committed.
+  template <typename Random>
+  bool RunOperation(const Workload workload, const uint32_t percent, const ZipfianGenerator &zipfian,
+                    Random *generator, byte *const key_buffer, byte *const high_key_buffer) {
+    auto *const txn = txn_manager_->BeginTransaction();
+    bool ok = true;
+    switch (workload) {
+      case Workload::A:
+      case Workload::B:
+      case Workload::C: {
+        const uint32_t percent_updates = workload == Workload::A ? 50 : (workload == Workload::B ? 5 : 0);
+        const auto key = ZipfianKey(zipfian, generator);
+        if (percent < percent_updates) {
+          ok = UpdateKey(txn, key, key_buffer);
+        } else {
+          ReadKey(*txn, key, key_buffer);
+        }
+        break;
+      }
+      case Workload::D:
+      case Workload::E: {
+        if (percent < 5) {
+          InsertKey(txn, static_cast<int64_t>(next_key_.fetch_add(1)), key_buffer);
+        } else if (workload == Workload::D) {
+          // The latest keys are the most popular
+          const auto latest = next_key_.load() - 1;
+          ReadKey(*txn, static_cast<int64_t>(latest - std::min(zipfian.Next(generator), latest)), key_buffer);
+        } else {
+          ScanKeys(*txn, ZipfianKey(zipfian, generator), generator, key_buffer, high_key_buffer);
+        }
+        break;
+      }
+      case Workload::F: {
+        const auto key = ZipfianKey(zipfian, generator);
+        ReadKey(*txn, key, key_buffer);
+        if (percent < 50) ok = UpdateKey(txn, key, key_buffer);
+        break;
+      }
+    }
+    if (!ok) {
+      txn_manager_->Abort(txn);
+      return false;
+    }
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    return true;
+  }
+
+  std::unique_ptr<DBMain> db_main_;
+  common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  catalog::Schema table_schema_;
+  catalog::IndexSchema index_schema_;
+  storage::SqlTable *sql_table_;
+  storage::ProjectedRowInitializer tuple_initializer_ =
+      storage::ProjectedRowInitializer::Create(std::vector<uint16_t>{1}, std::vector<uint16_t>{1});  // This is a dummy
+  storage::index::Index *index_;
+  // The key that the next insert inserts
+  std::atomic<uint64_t> next_key_;
+};
+
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(IndexYcsbBenchmark, Ycsb)(benchmark::State &state) { RunWorkload(&state); }
+
+/** Every workload on every index type and key type, except for range scans on the hash index */
+static void YcsbArgs(benchmark::internal::Benchmark *b) {
+  for (int64_t index_type = 0; index_type < 4; index_type++) {
+    for (int64_t generic_key = 0; generic_key < 2; generic_key++) {
+      for (int64_t workload = 0; workload < 6; workload++) {
+        const bool range_scans = workload == static_cast<int64_t>(IndexYcsbBenchmark::Workload::E);
+        if (range_scans && IndexYcsbBenchmark::INDEX_TYPES[index_type] == storage::index::IndexType::HASHMAP) continue;
+        b->Args({index_type, generic_key, workload});
+      }
+    }
+  }
+}
+
+BENCHMARK_REGISTER_F(IndexYcsbBenchmark, Ycsb)
+    ->Apply(YcsbArgs)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->Iterations(3);
+
+}  // namespace noisepage
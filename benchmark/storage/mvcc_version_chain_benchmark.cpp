@@ -0,0 +1,268 @@
+#include <atomic>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "common/memory_accountant.h"
+#include "common/scoped_timer.h"
+#include "storage/data_table.h"
+#include "storage/garbage_collector.h"
+#include "storage/storage_util.h"
+#include "test_util/catalog_test_util.h"
+#include "test_util/storage_test_util.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace noisepage {
+
+/**
+ * Measures how reads slow down as version chains grow, and how long they grow when the GC falls behind. Snapshot
+ * readers that began before a tuple was updated walk its version chain back to their snapshot, and no version newer
+ * than the oldest running transaction can be unlinked, so long-running readers and an infrequent GC both leave hot
+ * tuples with long chains. The memory that the undo records hold meanwhile is reported as a counter.
+ */
+class MvccVersionChainBenchmark : public benchmark::Fixture {
+ public:
+  void SetUp(const benchmark::State &state) final {
+    timestamp_manager_ = std::make_unique<transaction::TimestampManager>();
+    txn_manager_ = std::make_unique<transaction::TransactionManager>(
+        common::ManagedPointer(timestamp_manager_.get()), DISABLED, common::ManagedPointer(&buffer_pool_), true, false,
+        DISABLED);
+    gc_ = std::make_unique<storage::GarbageCollector>(common::ManagedPointer(timestamp_manager_.get()), DISABLED,
+                                                      common::ManagedPointer(txn_manager_.get()), DISABLED);
+    table_ = std::make_unique<storage::DataTable>(common::ManagedPointer(&block_store_), layout_,
+                                                  storage::layout_version_t(0));
+
+    // populate the table, and make the inserts visible to everyone
+    auto *const txn = txn_manager_->BeginTransaction();
+    slots_.clear();
+    for (uint32_t i = 0; i < num_tuples_; i++) {
+      auto *const redo =
+          txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, row_initializer_);
+      StorageTestUtil::PopulateRandomRow(redo->Delta(), layout_, 0, &generator_);
+      slots_.emplace_back(table_->Insert(common::ManagedPointer(txn), *redo->Delta()));
+      redo->SetTupleSlot(slots_.back());
+    }
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    CollectAllGarbage();
+  }
+
+  void TearDown(const benchmark::State &state) final {
+    CollectAllGarbage();
+    gc_.reset();
+    table_.reset();
+    txn_manager_.reset();
+    timestamp_manager_.reset();
+  }
+
+  // Updates the given tuples in one transaction, which aborts if any of them conflicts with another writer
+  // @return true if the transaction committed
+  bool UpdateTuples(const storage::TupleSlot *const slots, const uint32_t num_slots) {
+    auto *const txn = txn_manager_->BeginTransaction();
+    for (uint32_t i = 0; i < num_slots; i++) {
+      auto *const redo =
+          txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, update_initializer_);
+      redo->SetTupleSlot(slots[i]);
+      if (!table_->Update(common::ManagedPointer(txn), slots[i], *redo->Delta())) {
+        txn_manager_->Abort(txn);
+        return false;
+      }
+    }
+    txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    return true;
+  }
+
+  // Runs the GC until it finds nothing more to unlink or deallocate, which takes two passes per transaction
+  void CollectAllGarbage() {
+    std::pair<uint32_t, uint32_t> result;
+    do {
+      result = gc_->PerformGarbageCollection();
+    } while (result.first != 0 || result.second != 0);
+  }
+
+  static int64_t UndoBytes() {
+    return common::MemoryAccountant::GetBytes(common::MemoryComponent::RECORD_BUFFERS);
+  }
+
+  // Tuple layout
+  const storage::BlockLayout layout_{{8, 8, 8}};
+  const storage::ProjectedRowInitializer row_initializer_ =
+      storage::ProjectedRowInitializer::Create(layout_, StorageTestUtil::ProjectionListAllColumns(layout_));
+  const storage::ProjectedRowInitializer update_initializer_ =
+      storage::ProjectedRowInitializer::Create(layout_, {storage::col_id_t(1)});
+
+  // Workload
+  const uint32_t num_tuples_ = 10000;
+  const uint32_t num_hot_tuples_ = 100;
+  const uint32_t num_updaters_ = 3;
+  const uint32_t num_update_txns_ = 100000;
+  const uint32_t scan_buffer_size_ = common::Constants::K_DEFAULT_VECTOR_SIZE;
+
+  // Test infrastructure. A small reuse limit returns the segments of reclaimed undo records to the system, so that the
+  // memory the undo records hold shows in the counters.
+  std::default_random_engine generator_;
+  storage::BlockStore block_store_{1000, 1000};
+  storage::RecordBufferSegmentPool buffer_pool_{10000000, 1000};
+  std::unique_ptr<transaction::TimestampManager> timestamp_manager_;
+  std::unique_ptr<transaction::TransactionManager> txn_manager_;
+  std::unique_ptr<storage::GarbageCollector> gc_;
+  std::unique_ptr<storage::DataTable> table_;
+  std::vector<storage::TupleSlot> slots_;
+};
+
+// Begin a snapshot, then update every tuple as many times as the argument in transactions that commit. Time the
+// snapshot selecting every tuple, which walks every version chain back to its first version.
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(MvccVersionChainBenchmark, SelectChainLength)(benchmark::State &state) {
+  const auto chain_length = static_cast<uint32_t>(state.range(0));
+  byte *const read_buffer = common::AllocationUtil::AllocateAligned(row_initializer_.ProjectedRowSize());
+  storage::ProjectedRow *const read = row_initializer_.InitializeRow(read_buffer);
+  int64_t undo_bytes = 0;
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    auto *const reader = txn_manager_->BeginTransaction(true);
+    const int64_t undo_bytes_before = UndoBytes();
+    for (uint32_t i = 0; i < chain_length; i++) UpdateTuples(slots_.data(), num_tuples_);
+    undo_bytes += UndoBytes() - undo_bytes_before;
+
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      for (const storage::TupleSlot slot : slots_) table_->Select(common::ManagedPointer(reader), slot, read);
+    }
+    txn_manager_->Commit(reader, transaction::TransactionUtil::EmptyCallback, nullptr);
+    CollectAllGarbage();
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  delete[] read_buffer;
+  state.SetItemsProcessed(state.iterations() * num_tuples_);
+  state.counters["undo_MB_per_iteration"] =
+      static_cast<double>(undo_bytes) / static_cast<double>(state.iterations()) / (1024.0 * 1024.0);
+}
+
+// The same as SelectChainLength, but the snapshot scans the table instead of selecting tuple by tuple
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(MvccVersionChainBenchmark, ScanChainLength)(benchmark::State &state) {
+  const auto chain_length = static_cast<uint32_t>(state.range(0));
+  storage::ProjectedColumnsInitializer initializer(layout_, StorageTestUtil::ProjectionListAllColumns(layout_),
+                                                   scan_buffer_size_);
+  byte *const scan_buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedColumnsSize());
+  storage::ProjectedColumns *const columns = initializer.Initialize(scan_buffer);
+  int64_t undo_bytes = 0;
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    auto *const reader = txn_manager_->BeginTransaction(true);
+    const int64_t undo_bytes_before = UndoBytes();
+    for (uint32_t i = 0; i < chain_length; i++) UpdateTuples(slots_.data(), num_tuples_);
+    undo_bytes += UndoBytes() - undo_bytes_before;
+
+    uint64_t elapsed_ms;
+    {
+      common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_ms);
+      auto it = table_->begin();
+      while (it != table_->end()) table_->Scan(common::ManagedPointer(reader), &it, columns);
+    }
+    txn_manager_->Commit(reader, transaction::TransactionUtil::EmptyCallback, nullptr);
+    CollectAllGarbage();
+    state.SetIterationTime(static_cast<double>(elapsed_ms) / 1000.0);
+  }
+  delete[] scan_buffer;
+  state.SetItemsProcessed(state.iterations() * num_tuples_);
+  state.counters["undo_MB_per_iteration"] =
+      static_cast<double>(undo_bytes) / static_cast<double>(state.iterations()) / (1024.0 * 1024.0);
+}
+
+/**
+ * Hot-spot updaters commit num_update_txns_ single-tuple updates to the first num_hot_tuples_ tuples, while the GC runs
+ * every state.range(0) milliseconds and a reader repeatedly selects the hot tuples in short snapshots. If
+ * state.range(1) is not 0, a snapshot that begins before the updaters stays open until they finish, so that no version
+ * can be unlinked in the meantime. Time the short snapshots, which walk the versions that the GC has not unlinked yet,
+ * and report the peak memory held by undo records and the number of transactions the GC still had to deallocate at the
+ * end.
+ */
+// NOLINTNEXTLINE
+BENCHMARK_DEFINE_F(MvccVersionChainBenchmark, GCLag)(benchmark::State &state) {
+  const std::chrono::milliseconds gc_period{state.range(0)};
+  const bool long_reader = state.range(1) != 0;
+  byte *const read_buffer = common::AllocationUtil::AllocateAligned(row_initializer_.ProjectedRowSize());
+  storage::ProjectedRow *const read = row_initializer_.InitializeRow(read_buffer);
+  uint64_t num_reads = 0;
+  uint64_t lag_count = 0;
+  int64_t peak_undo_bytes = 0;
+  // NOLINTNEXTLINE
+  for (auto _ : state) {
+    const int64_t undo_bytes_before = UndoBytes();
+    auto *const snapshot = long_reader ? txn_manager_->BeginTransaction(true) : nullptr;
+    std::atomic<uint32_t> update_txns_run = 0;
+    std::atomic<uint32_t> updaters_running = num_updaters_;
+
+    std::vector<std::thread> updaters;
+    for (uint32_t i = 0; i < num_updaters_; i++) {
+      updaters.emplace_back([&, i] {
+        std::default_random_engine thread_generator(i);
+        std::uniform_int_distribution<uint32_t> hot_tuple(0, num_hot_tuples_ - 1);
+        while (update_txns_run++ < num_update_txns_) UpdateTuples(&slots_[hot_tuple(thread_generator)], 1);
+        updaters_running--;
+      });
+    }
+    std::thread gc_thread([&] {
+      while (updaters_running > 0) {
+        std::this_thread::sleep_for(gc_period);
+        gc_->PerformGarbageCollection();
+        peak_undo_bytes = std::max(peak_undo_bytes, UndoBytes() - undo_bytes_before);
+      }
+    });
+
+    uint64_t elapsed_us = 0;
+    while (updaters_running > 0) {
+      uint64_t read_us;
+      {
+        common::ScopedTimer<std::chrono::microseconds> timer(&read_us);
+        auto *const reader = txn_manager_->BeginTransaction(true);
+        for (uint32_t i = 0; i < num_hot_tuples_; i++) {
+          table_->Select(common::ManagedPointer(reader), slots_[i], read);
+        }
+        txn_manager_->Commit(reader, transaction::TransactionUtil::EmptyCallback, nullptr);
+      }
+      elapsed_us += read_us;
+      num_reads += num_hot_tuples_;
+    }
+
+    for (auto &updater : updaters) updater.join();
+    gc_thread.join();
+    if (snapshot != nullptr) txn_manager_->Commit(snapshot, transaction::TransactionUtil::EmptyCallback, nullptr);
+    // The transactions left to deallocate after the workload are those the GC lagged behind on
+    gc_->PerformGarbageCollection();
+    lag_count += gc_->PerformGarbageCollection().first;
+    CollectAllGarbage();
+    state.SetIterationTime(static_cast<double>(elapsed_us) / 1000000.0);
+  }
+  delete[] read_buffer;
+  state.SetItemsProcessed(static_cast<int64_t>(num_reads));
+  state.counters["peak_undo_MB"] = static_cast<double>(peak_undo_bytes) / (1024.0 * 1024.0);
+  state.counters["gc_lag_txns"] = static_cast<double>(lag_count) / static_cast<double>(state.iterations());
+}
+
+BENCHMARK_REGISTER_F(MvccVersionChainBenchmark, SelectChainLength)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->RangeMultiplier(4)
+    ->Range(1, 256);
+BENCHMARK_REGISTER_F(MvccVersionChainBenchmark, ScanChainLength)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->RangeMultiplier(4)
+    ->Range(1, 256);
+BENCHMARK_REGISTER_F(MvccVersionChainBenchmark, GCLag)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->Args({1, 0})
+    ->Args({10, 0})
+    ->Args({100, 0})
+    ->Args({1, 1})
+    ->Args({10, 1})
+    ->Args({100, 1})
+    ->Iterations(3);
+}  // namespace noisepage
@@ -18,6 +18,9 @@ namespace noisepage {
 class SlotIteratorBenchmark : public benchmark::Fixture {
  public:
   void SetUp(const benchmark::State &state) final {
+    // The argument of every benchmark decides whether blocks are backed by huge pages
+    block_store_ = std::make_unique<storage::BlockStore>(1000, 1000, state.range(0) != 0);
+
     // generate a random redo ProjectedRow to Insert
     redo_buffer_ = common::AllocationUtil::AllocateAligned(initializer_.ProjectedRowSize());
     redo_ = initializer_.InitializeRow(redo_buffer_);
@@ -44,6 +47,7 @@ class SlotIteratorBenchmark : public benchmark::Fixture {
     // google benchmark might run benchmark several iterations. We need to clear vectors.
     read_buffers_.clear();
     reads_.clear();
+    block_store_.reset();
   }
 
   // Tuple layout
@@ -60,7 +64,7 @@ class SlotIteratorBenchmark : public benchmark::Fixture {
 
   // Test infrastructure
   std::default_random_engine generator_;
-  storage::BlockStore block_store_{1000, 1000};
+  std::unique_ptr<storage::BlockStore> block_store_;
   storage::RecordBufferSegmentPool buffer_pool_{num_reads_, buffer_pool_reuse_limit_};
 
   // Insert buffer pointers
@@ -79,7 +83,7 @@ class SlotIteratorBenchmark : public benchmark::Fixture {
 // Iterate the num_reads_ of tuples in the sequential  order from a DataTable concurrently
 // NOLINTNEXTLINE
 BENCHMARK_DEFINE_F(SlotIteratorBenchmark, ConcurrentSlotIterators)(benchmark::State &state) {
-  storage::DataTable read_table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout_,
+  storage::DataTable read_table(common::ManagedPointer<storage::BlockStore>(block_store_.get()), layout_,
                                 storage::layout_version_t(0));
 
   // populate read_table_ by inserting tuples
@@ -121,7 +125,7 @@ BENCHMARK_DEFINE_F(SlotIteratorBenchmark, ConcurrentSlotIterators)(benchmark::St
 // Iterate the num_reads_ of tuples in the sequential  order from a DataTable concurrently
 // NOLINTNEXTLINE
 BENCHMARK_DEFINE_F(SlotIteratorBenchmark, ConcurrentSlotIteratorsReads)(benchmark::State &state) {
-  storage::DataTable read_table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout_,
+  storage::DataTable read_table(common::ManagedPointer<storage::BlockStore>(block_store_.get()), layout_,
                                 storage::layout_version_t(0));
 
   // populate read_table_ by inserting tuples
@@ -168,10 +172,16 @@ BENCHMARK_DEFINE_F(SlotIteratorBenchmark, ConcurrentSlotIteratorsReads)(benchmar
 // ----------------------------------------------------------------------------
 // clang-format off
 BENCHMARK_REGISTER_F(SlotIteratorBenchmark, ConcurrentSlotIterators)
+    ->ArgName("huge_pages")
+    ->Arg(0)
+    ->Arg(1)
 ->Unit(benchmark::kMillisecond)
     ->UseRealTime()
     ->UseManualTime();
 BENCHMARK_REGISTER_F(SlotIteratorBenchmark, ConcurrentSlotIteratorsReads)
+    ->ArgName("huge_pages")
+    ->Arg(0)
+    ->Arg(1)
 ->Unit(benchmark::kMillisecond)
     ->UseRealTime()
     ->UseManualTime();
@@ -21,6 +21,7 @@ TODO(Ricky):
 from __future__ import annotations
 
 import atexit
+import base64
 import datetime
 import enum
 import json
@@ -38,6 +39,7 @@ import numpy as np
 import zmq
 from forecasting.forecaster import Forecaster, parse_model_config
 from modeling.info import data_info
+from modeling.model import export_model_map
 from modeling.interference_model_trainer import InterferenceModelTrainer
 from modeling.ou_model_trainer import OUModelTrainer
 from modeling.type import OpUnit
@@ -82,6 +84,7 @@ class Command(Enum):
     QUIT = auto()  # Quit the server
     PRINT = auto()  # Print the message
     INFER = auto()  # Do inference on a trained model
+    INFER_BATCH = auto()  # Do inference on many models of a kind in one message
 
     def __str__(self) -> str:
         return self.name
@@ -96,6 +99,8 @@ class Command(Enum):
             return Command.TRAIN
         elif cmd_str == "INFER":
             return Command.INFER
+        elif cmd_str == "INFER_BATCH":
+            return Command.INFER_BATCH
         else:
             raise ValueError("Invalid command")
 
@@ -135,6 +140,31 @@ class Message:
         return pprint.pformat(self.__dict__)
 
 
+def decode_matrix(encoded: Dict) -> np.ndarray:
+    """
+    Decode a matrix encoded by the ModelServerManager
+    :param encoded: {
+        shape: [rows, columns],
+        data: base64 of the little endian doubles of the matrix in row major order
+    }
+    :return: the matrix
+    """
+    return np.frombuffer(base64.b64decode(encoded["data"]), dtype="<f8").reshape(encoded["shape"])
+
+
+def encode_matrix(matrix: Any) -> Dict:
+    """
+    Encode a matrix the way the ModelServerManager decodes it, see decode_matrix()
+    :param matrix: matrix, or vector that is encoded as a single column
+    :return: the encoded matrix
+    """
+    matrix = np.asarray(matrix, dtype="<f8")
+    if matrix.ndim == 1:
+        matrix = matrix.reshape(-1, 1)
+    return {"shape": list(matrix.shape),
+            "data": base64.b64encode(np.ascontiguousarray(matrix).tobytes()).decode("ascii")}
+
+
 class AbstractModel(ABC):
     """
     Interface for all the models
@@ -163,6 +193,15 @@ class AbstractModel(ABC):
         """
         raise NotImplementedError("Should be implemented by child classes")
 
+    def infer_batch(self, data: Dict) -> Tuple[Any, bool, str]:
+        """
+        Do inference on many models in one go.
+        Only supported by the models that override it.
+        :param data: data used for inference
+        :return: {Predictions, if inference succeeds, error message}
+        """
+        return {}, False, "BATCH_NOT_SUPPORTED"
+
     def _load_model(self, save_path: str):
         """
         Check if a trained model exists at the path.
@@ -256,6 +295,9 @@ class OUModel(AbstractModel):
         with save_path.open(mode='wb') as f:
             pickle.dump((model_map, data_info.instance), f)
 
+        # Export the models next to it for the DBMS to infer with in-process, which the DBMS prefers to asking here
+        export_model_map(model_map, save_path.with_suffix('.json'))
+
         return True, ""
 
     def infer(self, data: Dict) -> Tuple[Any, bool, str]:
@@ -279,25 +321,63 @@ class OUModel(AbstractModel):
                 f"Model map at {str(model_path)} has not been trained")
             return [], False, "MODEL_MAP_NOT_TRAINED"
 
+        y_pred, err = self._predict(model_map, opunit, np.array(features))
+        if y_pred is None:
+            return [], False, err
+        return y_pred.tolist(), True, ""
+
+    def infer_batch(self, data: Dict) -> Tuple[Any, bool, str]:
+        """
+        Do inference on the models of many opunits, with their features encoded as matrices
+        :param data: {
+            features: {Opunit name: encoded 2D float array}, see decode_matrix()
+            model_path: model path
+        }
+        :return: {{Opunit name: encoded predictions}, if inference succeeds, error message}
+        """
+        model_path = data["model_path"]
+
+        # Load the model map
+        model_map = self._load_model(model_path)
+        if model_map is None:
+            logging.error(
+                f"Model map at {str(model_path)} has not been trained")
+            return {}, False, "MODEL_MAP_NOT_TRAINED"
+
+        result = {}
+        for opunit, encoded in data["features"].items():
+            y_pred, err = self._predict(model_map, opunit, decode_matrix(encoded))
+            if y_pred is None:
+                return {}, False, err
+            result[opunit] = encode_matrix(y_pred)
+        return result, True, ""
+
+    @staticmethod
+    def _predict(model_map: Dict, opunit: Any, features: np.ndarray) -> Tuple[Optional[np.ndarray], str]:
+        """
+        Predict with the model of an opunit
+        :param model_map: OU model map
+        :param opunit: Opunit name
+        :param features: 2D float array
+        :return: {predictions or None, error message}
+        """
         # Parameter validation
         if not isinstance(opunit, str):
-            return [], False, "INVALID_OPUNIT"
+            return None, "INVALID_OPUNIT"
         try:
             opunit = OpUnit[opunit]
         except KeyError as e:
             logging.error(f"{opunit} is not a valid Opunit name")
-            return [], False, "INVALID_OPUNIT"
+            return None, "INVALID_OPUNIT"
 
-        features = np.array(features)
         logging.debug(f"Using model on {opunit}")
 
         model = model_map[opunit]
         if model is None:
             logging.error(f"Model for {opunit} doesn't exist")
-            return [], False, "MODEL_NOT_FOUND"
+            return None, "MODEL_NOT_FOUND"
 
-        y_pred = model.predict(features)
-        return y_pred.tolist(), True, ""
+        return model.predict(features), ""
 
     def _load_model_from_disk(self, save_path: Path) -> Dict:
         """
@@ -666,18 +746,34 @@ class ModelServer:
         model_type = data["type"]
         return self.model_managers[ModelType[model_type]].infer(data)
 
-    def _recv(self) -> str:
+    def _infer_batch(self, data: Dict) -> Tuple[Any, bool, str]:
+        """
+        Do inference on many models of a kind at once
+        :param data: {
+            type: model type
+            model_path: model path
+            ...
+        }
+        :return: {Predictions, if inference succeeds, error message}
+        """
+        model_type = data["type"]
+        return self.model_managers[ModelType[model_type]].infer_batch(data)
+
+    def _recv(self) -> List[str]:
         """
         Receive from the ZMQ socket. This is a blocking call.
+        The Messenger may batch several payloads behind a single identity and delimiter.
 
-        :return: Message payload
+        :return: Message payloads
         """
         identity = self.socket.recv()
         _delim = self.socket.recv()
-        payload = self.socket.recv()
-        logging.debug(f"Python recv: {str(identity)}, {str(payload)}")
+        payloads = [self.socket.recv()]
+        while self.socket.getsockopt(zmq.RCVMORE):
+            payloads.append(self.socket.recv())
+        logging.debug(f"Python recv: {str(identity)}, {str(payloads)}")
 
-        return payload.decode("ascii")
+        return [payload.decode("ascii") for payload in payloads]
 
     def _execute_cmd(self, cmd: Command, data: Dict) -> Tuple[Dict, bool]:
         """
@@ -723,6 +819,14 @@ class ModelServer:
             result, ok, err = self._infer(data)
             response = self._make_response(Callback.NOOP, result, ok, err)
             return response, True
+        elif cmd == Command.INFER_BATCH:
+            try:
+                result, ok, err = self._infer_batch(data)
+            except (KeyError, ValueError, TypeError) as e:
+                logging.error(f"Data format wrong for INFER_BATCH: {e}")
+                result, ok, err = {}, False, "FAIL_DATA_FORMAT_ERROR"
+            response = self._make_response(Callback.NOOP, result, ok, err)
+            return response, True
 
     def run_loop(self):
         """
@@ -742,7 +846,7 @@ class ModelServer:
                             self._send_msg(msg_id, send_id, recv_id, data)
                     # Poll for up to 250 milliseconds to see if there are any incoming events.
                     data_available = 0 != self.socket.poll(ModelServer.POLL_TIMEOUT)
-                payload = self._recv()
+                payloads = self._recv()
             except UnicodeError as e:
                 logging.warning(f"Failed to decode : {e.reason}")
                 continue
@@ -755,23 +859,33 @@ class ModelServer:
                     self._closing = True
                     continue
 
-            msg_id, send_id, recv_id, msg = self._parse_msg(payload)
+            if not all(self._handle_payload(payload) for payload in payloads):
+                logging.info("Shutting down.")
+                break
 
-            # If this is an acknowledgment, clear the corresponding pending message.
-            if recv_id == MessengerCallback.ACK:
-                self.pending_msgs.pop(msg_id, None)
-                continue
-            if msg is None:
-                continue
-            else:
-                result, cont = self._execute_cmd(msg.cmd, msg.data)
-                if not cont:
-                    logging.info("Shutting down.")
-                    break
-
-                # Currently not expecting to invoke any callback on ModelServer
-                # side, so second parameter 0
-                self._send_msg(self._next_msg_id(), 0, send_id, result)
+    def _handle_payload(self, payload: str) -> bool:
+        """
+        Handle a single message payload received from the ModelServerManager
+        :param payload: the raw message payload
+        :return: if continue the server
+        """
+        msg_id, send_id, recv_id, msg = self._parse_msg(payload)
+
+        # If this is an acknowledgment, clear the corresponding pending message.
+        if recv_id == MessengerCallback.ACK:
+            self.pending_msgs.pop(msg_id, None)
+            return True
+        if msg is None:
+            return True
+
+        result, cont = self._execute_cmd(msg.cmd, msg.data)
+        if not cont:
+            return False
+
+        # Currently not expecting to invoke any callback on ModelServer
+        # side, so second parameter 0
+        self._send_msg(self._next_msg_id(), 0, send_id, result)
+        return True
 
 
 if __name__ == "__main__":
@@ -1,5 +1,9 @@
 #!/usr/bin/env python3
 
+import json
+import logging
+import os
+
 import numpy as np
 
 import lightgbm as lgb
@@ -12,6 +16,10 @@ from sklearn import neural_network
 from sklearn import multioutput
 from sklearn import svm
 
+from .info import data_info
+from .training_util import data_transforming_util
+from .type import Target, ExecutionFeature
+
 # import warnings filter
 from warnings import simplefilter
 
@@ -46,6 +54,111 @@ def _get_base_ml_model(method):
     return regressor
 
 
+def _flatten_tree(root, children, split, leaf_values, labels):
+    """Flatten a regression tree so that the children of every node follow it, the right one after the left one
+
+    :param root: the root node
+    :param children: function from a node to its left and right children, or None for a leaf
+    :param split: function from a node to the feature it splits on and the threshold that goes left, inclusive
+    :param leaf_values: function from a leaf to its values for the labels
+    :param labels: the labels that the leaves hold values for
+    :return: the exported tree
+    """
+    feature, threshold, left, value = [], [], [], []
+    nodes = [root]
+    for node in nodes:
+        node_children = children(node)
+        if node_children is None:
+            feature.append(-1)
+            threshold.append(0.0)
+            left.append(-1)
+            value += [float(v) for v in leaf_values(node)]
+        else:
+            split_feature, split_threshold = split(node)
+            feature.append(int(split_feature))
+            threshold.append(float(split_threshold))
+            left.append(len(nodes))
+            value += [0.0] * len(labels)
+            nodes += node_children
+    return {'labels': labels, 'feature': feature, 'threshold': threshold, 'left': left, 'value': value}
+
+
+def _export_sklearn_tree(estimator, num_labels):
+    tree = estimator.tree_
+    return _flatten_tree(0,
+                         lambda n: None if tree.children_left[n] == -1 else [tree.children_left[n],
+                                                                            tree.children_right[n]],
+                         lambda n: (tree.feature[n], tree.threshold[n]),
+                         lambda n: tree.value[n, :, 0],
+                         list(range(num_labels)))
+
+
+def _export_lightgbm_tree(tree_structure, label):
+    def split(node):
+        if node['decision_type'] != '<=':
+            raise ValueError("Unsupported LightGBM split {}".format(node['decision_type']))
+        return node['split_feature'], node['threshold']
+
+    return _flatten_tree(tree_structure,
+                         lambda n: [n['left_child'], n['right_child']] if 'left_child' in n else None,
+                         split,
+                         lambda n: [n['leaf_value']],
+                         [label])
+
+
+def _export_base_ml_model(regressor, num_labels):
+    """Export a regressor of _get_base_ml_model() for in-process inference
+
+    :param regressor: the trained regressor
+    :param num_labels: number of labels it predicts
+    :return: the exported regressor, or None if its method cannot be exported
+    """
+    if isinstance(regressor, linear_model.LinearRegression):
+        return {'kind': 'linear', 'coef': regressor.coef_.tolist(), 'intercept': regressor.intercept_.tolist()}
+
+    if isinstance(regressor, ensemble.RandomForestRegressor):
+        return {'kind': 'trees', 'float_features': True, 'base': [0.0] * num_labels,
+                'scale': 1.0 / len(regressor.estimators_),
+                'trees': [_export_sklearn_tree(estimator, num_labels) for estimator in regressor.estimators_]}
+
+    if isinstance(regressor, multioutput.MultiOutputRegressor):
+        estimators = regressor.estimators_
+        if all(isinstance(e, (linear_model.HuberRegressor, svm.LinearSVR)) for e in estimators):
+            return {'kind': 'linear', 'coef': [e.coef_.tolist() for e in estimators],
+                    'intercept': [float(np.ravel(e.intercept_)[0]) for e in estimators]}
+        if all(isinstance(e, lgb.LGBMRegressor) for e in estimators):
+            # The leaves of the first tree start out from the average label, so the trees only need to be summed
+            trees = []
+            for label, estimator in enumerate(estimators):
+                for tree_info in estimator.booster_.dump_model()['tree_info']:
+                    trees.append(_export_lightgbm_tree(tree_info['tree_structure'], label))
+            return {'kind': 'trees', 'float_features': False, 'base': [0.0] * num_labels, 'scale': 1.0,
+                    'trees': trees}
+
+    return None
+
+
+def export_model_map(model_map, path):
+    """Export the models of the opunits for in-process inference in the DBMS (see self_driving/modeling/ou_model.h),
+    which leaves out the models whose methods cannot be exported
+
+    :param model_map: the trained models by opunit
+    :param path: path to export the models to, which is replaced as a whole
+    """
+    models = {}
+    for opunit, regressor in model_map.items():
+        exported = regressor.export() if regressor is not None else None
+        if exported is None:
+            logging.info("Model of {} cannot be exported".format(opunit.name))
+            continue
+        models[opunit.name] = exported
+
+    temp_path = "{}.tmp".format(path)
+    with open(temp_path, 'w') as file:
+        json.dump({'version': 1, 'models': models}, file)
+    os.replace(temp_path, path)
+
+
 class Model:
     """
     The class that wraps around standard ML libraries.
@@ -71,6 +184,9 @@ class Model:
         self._x_transformer = x_transformer
 
     def train(self, x, y):
+        self._num_features = x.shape[1]
+        self._num_labels = y.shape[1]
+
         if self._y_transformer is not None:
             y = self._y_transformer[0](x, y)
 
@@ -113,3 +229,36 @@ class Model:
             y = self._y_transformer[1](original_x, y)
 
         return y
+
+    def export(self):
+        """Export the model for in-process inference in the DBMS
+
+        :return: the exported model, or None if its method cannot be exported
+        """
+        regressor = _export_base_ml_model(self._base_model, self._num_labels)
+        if regressor is None:
+            return None
+
+        names = data_transforming_util.TRANSFORMER_NAMES
+        x_transform = names[self._x_transformer] if self._x_transformer is not None else 'none'
+        y_transform = names[self._y_transformer] if self._y_transformer is not None else 'none'
+        # Only the transformations use the indexes, and the models without any may have fewer features or labels
+        uses_features = x_transform != 'none' or y_transform != 'none'
+        uses_memory = y_transform == 'num_rows_memory_cardinality_linear'
+        return {
+            'num_features': self._num_features,
+            'num_labels': self._num_labels,
+            'log_transform': self._log_transform,
+            'log_epsilon': _LOGTRANS_EPS,
+            'x_mean': self._xscaler.mean_.tolist() if self._normalize else [],
+            'x_scale': self._xscaler.scale_.tolist() if self._normalize else [],
+            'y_mean': self._yscaler.mean_.tolist() if self._normalize else [],
+            'y_scale': self._yscaler.scale_.tolist() if self._normalize else [],
+            'x_transform': x_transform,
+            'y_transform': y_transform,
+            'num_rows_index': data_info.instance.input_csv_index[ExecutionFeature.NUM_ROWS] if uses_features else 0,
+            'cardinality_index':
+                data_info.instance.input_csv_index[ExecutionFeature.EST_CARDINALITIES] if uses_features else 0,
+            'memory_label_index': data_info.instance.target_csv_index[Target.MEMORY_B] if uses_memory else 0,
+            'regressor': regressor,
+        }
@@ -196,3 +196,4 @@ if __name__ == '__main__':
     trained_model_map = trainer.train()
     with open(args.save_path + '/ou_model_map.pickle', 'wb') as file:
         pickle.dump((trained_model_map, data_info.instance), file)
+    model.export_model_map(trained_model_map, args.save_path + '/ou_model_map.json')
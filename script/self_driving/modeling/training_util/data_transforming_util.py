@@ -220,3 +220,15 @@ OPUNIT_X_TRANSFORMER_MAP = {
     OpUnit.INDEX_INSERT: None,
     OpUnit.INDEX_DELETE: None,
 }
+
+# Names of the transformers, by which the models exported for in-process inference refer to them (see
+# self_driving/modeling/ou_model.cpp, which implements their predict transformations)
+TRANSFORMER_NAMES = {
+    _num_rows_linear_transformer: 'num_rows_linear',
+    _num_rows_memory_cardinality_linear_transformer: 'num_rows_memory_cardinality_linear',
+    _num_rows_log_cardinality_linear_transformer: 'num_rows_log_cardinality_linear',
+    _num_rows_linear_log_transformer: 'num_rows_linear_log',
+    _num_rows_log_transformer: 'num_rows_log',
+    _cardinality_linear_transformer: 'cardinality_linear',
+    _num_rows_cardinality_linear_train_transform: 'num_rows_cardinality_linear',
+}
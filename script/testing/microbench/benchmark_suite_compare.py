@@ -0,0 +1,61 @@
+#!/usr/bin/env python3
+"""
+Compare two result files of benchmark_suite, and fail if a configuration regressed.
+
+A configuration regressed when its throughput dropped, or its p99 latency rose, by more than the threshold (in
+percent). Configurations that only ran in one of the files, or did not run ok in both, are listed but do not fail.
+
+Usage: python3 benchmark_suite_compare.py <baseline.json> <candidate.json> [--threshold 10]
+"""
+
+import argparse
+import json
+import sys
+
+SCHEMA_VERSION = 1
+CONFIGURATION_KEYS = ("benchmark", "workload", "mode", "num_threads", "scale_factor", "logging")
+
+
+def load_results(path):
+    with open(path) as f:
+        results = json.load(f)
+    if results.get("schema_version") != SCHEMA_VERSION:
+        raise ValueError(f"{path} has schema version {results.get('schema_version')}, expected {SCHEMA_VERSION}")
+    return {tuple(result[key] for key in CONFIGURATION_KEYS): result for result in results["results"]}
+
+
+def compare(baseline, candidate, threshold):
+    regressions = []
+    for config in sorted(set(baseline) | set(candidate), key=str):
+        name = "/".join(str(value) for value in config)
+        old, new = baseline.get(config), candidate.get(config)
+        if old is None or new is None:
+            print(f"{name}: only in the {'candidate' if old is None else 'baseline'}")
+            continue
+        if old["status"] != "ok" or new["status"] != "ok":
+            print(f"{name}: {old['status']} -> {new['status']}")
+            continue
+
+        throughput_change = 100.0 * (new["throughput"] - old["throughput"]) / max(old["throughput"], 1e-9)
+        p99_change = 100.0 * (new["latency_us"]["p99"] - old["latency_us"]["p99"]) / max(old["latency_us"]["p99"], 1)
+        regressed = throughput_change < -threshold or p99_change > threshold
+        print(f"{name}: throughput {old['throughput']:.2f} -> {new['throughput']:.2f} ({throughput_change:+.1f}%), "
+              f"p99 {old['latency_us']['p99']} -> {new['latency_us']['p99']} us ({p99_change:+.1f}%)"
+              f"{' REGRESSED' if regressed else ''}")
+        if regressed:
+            regressions.append(name)
+    return regressions
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Compare two result files of benchmark_suite.")
+    parser.add_argument("baseline", help="Results of the baseline")
+    parser.add_argument("candidate", help="Results to check for regressions")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="Change (percent) in throughput or p99 latency that is a regression [default=10]")
+    args = parser.parse_args()
+
+    regressions = compare(load_results(args.baseline), load_results(args.candidate), args.threshold)
+    if regressions:
+        print(f"{len(regressions)} configurations regressed by more than {args.threshold}%")
+        sys.exit(1)
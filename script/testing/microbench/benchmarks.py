@@ -5,6 +5,7 @@ BENCHMARKS_TO_RUN = {
     "catalog_benchmark": 20,
     "data_table_benchmark": 75,
     "garbage_collector_benchmark": DEFAULT_FAILURE_THRESHOLD,
+    "mvcc_version_chain_benchmark": DEFAULT_FAILURE_THRESHOLD,
     "large_transaction_benchmark": DEFAULT_FAILURE_THRESHOLD,
     "index_wrapper_benchmark": DEFAULT_FAILURE_THRESHOLD,
     "logging_benchmark": DEFAULT_FAILURE_THRESHOLD,
@@ -16,6 +17,14 @@ BENCHMARKS_TO_RUN = {
     "bwtree_benchmark": DEFAULT_FAILURE_THRESHOLD,
     "bplustree_benchmark": DEFAULT_FAILURE_THRESHOLD,
     "cuckoomap_benchmark": DEFAULT_FAILURE_THRESHOLD,
+    "index_ycsb_benchmark": DEFAULT_FAILURE_THRESHOLD,
     "parser_benchmark": 20,
     "slot_iterator_benchmark": DEFAULT_FAILURE_THRESHOLD,
+    "aggregation_hash_table_benchmark": DEFAULT_FAILURE_THRESHOLD,
+    "join_hash_table_benchmark": DEFAULT_FAILURE_THRESHOLD,
+    "sorter_benchmark": DEFAULT_FAILURE_THRESHOLD,
+    "filter_manager_benchmark": DEFAULT_FAILURE_THRESHOLD,
+    "bloom_filter_benchmark": DEFAULT_FAILURE_THRESHOLD,
+    "vector_operations_benchmark": DEFAULT_FAILURE_THRESHOLD,
+    "tuple_id_list_benchmark": DEFAULT_FAILURE_THRESHOLD,
 }
@@ -0,0 +1,49 @@
+import argparse
+import sys
+
+from ..util.constants import DEFAULT_DB_HOST, DEFAULT_DB_PORT, DEFAULT_DB_USER, LOG, ErrorCode
+from .replay import Replay, compare_results
+from .trace import group_by_connection, load_executions, load_queries
+
+# =========================================================
+# MAIN
+# =========================================================
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Replay a query trace, or compare the latencies of two replays.")
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    replay_parser = subparsers.add_parser("replay", help="Replay a trace against a running server")
+    replay_parser.add_argument("--query-text-file", default="query_text.csv",
+                               help="Query texts the server traced (default: %(default)s)")
+    replay_parser.add_argument("--query-trace-file", default="query_trace.csv",
+                               help="Query executions the server traced (default: %(default)s)")
+    replay_parser.add_argument("--db-host", default=DEFAULT_DB_HOST, help="DB Hostname (default: %(default)s)")
+    replay_parser.add_argument("--db-port", type=int, default=DEFAULT_DB_PORT, help="DB Port (default: %(default)s)")
+    replay_parser.add_argument("--db-user", default=DEFAULT_DB_USER, help="DB User (default: %(default)s)")
+    replay_parser.add_argument("--speedup", type=float, default=1.0,
+                               help="How much faster than traced the executions arrive, or 0 to send them back to "
+                                    "back (default: %(default)s)")
+    replay_parser.add_argument("--result-file", default="replay_result.csv",
+                               help="File to write the latency of every query to (default: %(default)s)")
+
+    compare_parser = subparsers.add_parser("compare", help="Compare the results of two replays")
+    compare_parser.add_argument("baseline", help="Result file of the baseline replay")
+    compare_parser.add_argument("candidate", help="Result file of the replay to compare to the baseline")
+    compare_parser.add_argument("--threshold", type=float, default=10.0,
+                                help="Change of a query's mean latency to report, in percent (default: %(default)s)")
+
+    args = parser.parse_args()
+
+    if args.command == "replay":
+        queries = load_queries(args.query_text_file)
+        sessions = group_by_connection(load_executions(args.query_trace_file, queries))
+        if not sessions:
+            LOG.error(f"No executions to replay in {args.query_trace_file}")
+            sys.exit(ErrorCode.ERROR)
+        replay = Replay(queries, sessions, args.db_host, args.db_port, args.db_user, args.speedup)
+        replay.run()
+        replay.write_results(args.result_file)
+        sys.exit(ErrorCode.SUCCESS)
+
+    sys.exit(ErrorCode.SUCCESS if compare_results(args.baseline, args.candidate, args.threshold) else ErrorCode.ERROR)
@@ -0,0 +1,142 @@
+"""
+Replay a query trace against a server over the Postgres protocol, and compare the latencies of two replays.
+"""
+
+import csv
+import threading
+import time
+from collections import defaultdict
+from typing import Dict, List
+
+import psycopg2 as psql
+
+from ..util.constants import LOG
+from .trace import Execution, Query
+
+# The columns of the file that a replay writes its latencies to
+RESULT_COLUMNS = ["query_id", "executions", "errors", "mean_us", "p50_us", "p99_us", "traced_mean_us", "query_text"]
+
+
+def percentile(sorted_values: List[float], percent: float) -> float:
+    """ The value that the given percentage of sorted values are at most, or 0 if there are none. """
+    if not sorted_values:
+        return 0
+    return sorted_values[min(len(sorted_values) - 1, int(len(sorted_values) * percent / 100))]
+
+
+class Replay:
+    """
+    A Replay re-issues the executions of a trace, one client connection per connection in the trace, so that the trace
+    runs with the concurrency it was captured with. Every execution starts when it started in the trace relative to the
+    first one, divided by the speedup, unless its connection is still busy with the previous one. A speedup of 0 runs
+    every connection's executions back to back.
+
+    The trace only has the queries that ran through the execution engine, so every execution runs in its own
+    transaction rather than in the transaction it was part of.
+    """
+
+    def __init__(self, queries: Dict[int, Query], sessions: Dict[int, List[Execution]], host: str, port: int,
+                 user: str, speedup: float):
+        self.queries = queries
+        self.sessions = sessions
+        self.host = host
+        self.port = port
+        self.user = user
+        self.speedup = speedup
+        # The latencies of every query, in microseconds, and the number of its executions that failed
+        self.latencies_us = defaultdict(list)
+        self.errors = defaultdict(int)
+        self.lock = threading.Lock()
+
+    def run(self) -> None:
+        """ Run every session on its own thread, and wait for all of them to finish. """
+        first_start_us = min(session[0].start_us for session in self.sessions.values())
+        replay_start = time.monotonic()
+        threads = [threading.Thread(target=self._run_session, args=(session, first_start_us, replay_start))
+                   for session in self.sessions.values()]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+        LOG.info(f"Replayed {sum(len(s) for s in self.sessions.values())} executions on {len(self.sessions)} "
+                 f"connections in {time.monotonic() - replay_start:.1f} s")
+
+    def _run_session(self, session: List[Execution], first_start_us: int, replay_start: float) -> None:
+        conn = psql.connect(host=self.host, port=self.port, user=self.user)
+        conn.set_session(autocommit=True)
+        latencies_us = defaultdict(list)
+        errors = defaultdict(int)
+        try:
+            with conn.cursor() as cursor:
+                for execution in session:
+                    if self.speedup > 0:
+                        offset_s = (execution.start_us - first_start_us) / 1e6 / self.speedup
+                        delay_s = replay_start + offset_s - time.monotonic()
+                        if delay_s > 0:
+                            time.sleep(delay_s)
+                    query = self.queries[execution.query_id]
+                    start = time.perf_counter()
+                    try:
+                        cursor.execute(query.text, execution.params)
+                        if cursor.description is not None:
+                            cursor.fetchall()
+                    except psql.Error:
+                        errors[execution.query_id] += 1
+                        continue
+                    latencies_us[execution.query_id].append((time.perf_counter() - start) * 1e6)
+        finally:
+            conn.close()
+        with self.lock:
+            for query_id, latencies in latencies_us.items():
+                self.latencies_us[query_id].extend(latencies)
+            for query_id, num_errors in errors.items():
+                self.errors[query_id] += num_errors
+
+    def write_results(self, result_file: str) -> None:
+        """ Write the latencies of every query next to the ones it had in the trace. """
+        traced_us = defaultdict(list)
+        for session in self.sessions.values():
+            for execution in session:
+                traced_us[execution.query_id].append(execution.latency_us)
+        with open(result_file, "w", newline="") as out:
+            writer = csv.writer(out)
+            writer.writerow(RESULT_COLUMNS)
+            for query_id in sorted(traced_us):
+                latencies = sorted(self.latencies_us[query_id])
+                mean = sum(latencies) / len(latencies) if latencies else 0
+                traced = traced_us[query_id]
+                writer.writerow([query_id, len(latencies), self.errors[query_id], round(mean, 1),
+                                 round(percentile(latencies, 50), 1), round(percentile(latencies, 99), 1),
+                                 round(sum(traced) / len(traced), 1), self.queries[query_id].text])
+        LOG.info(f"Wrote the latencies of {len(traced_us)} queries to {result_file}")
+
+
+def compare_results(baseline_file: str, candidate_file: str, threshold_percent: float) -> bool:
+    """
+    Compare the latencies of the queries in the results of two replays, e.g., on two builds, and log the queries whose
+    mean latency changed by more than the threshold. Returns whether no query got slower by more than the threshold.
+    """
+
+    def load(result_file):
+        with open(result_file, newline="") as f:
+            return {int(row["query_id"]): row for row in csv.DictReader(f)}
+
+    baseline = load(baseline_file)
+    candidate = load(candidate_file)
+    regressed = False
+    for query_id in sorted(baseline.keys() & candidate.keys()):
+        old, new = baseline[query_id], candidate[query_id]
+        old_mean, new_mean = float(old["mean_us"]), float(new["mean_us"])
+        if old_mean == 0:
+            continue
+        delta_percent = (new_mean - old_mean) / old_mean * 100
+        message = (f"query {query_id}: mean {old_mean:.1f} -> {new_mean:.1f} us ({delta_percent:+.1f}%), "
+                   f"p99 {float(old['p99_us']):.1f} -> {float(new['p99_us']):.1f} us: {new['query_text'][:80]}")
+        if delta_percent > threshold_percent:
+            regressed = True
+            LOG.error(message)
+        elif delta_percent < -threshold_percent:
+            LOG.info(message)
+    for query_id in sorted(baseline.keys() - candidate.keys()):
+        LOG.warning(f"query {query_id} is only in {baseline_file}")
+    return not regressed
@@ -0,0 +1,97 @@
+"""
+Load the query traces that the QueryTraceMetric writes, i.e., query_text.csv and query_trace.csv. The format is
+hardcoded and needs to be synced with the trace producer in src/include/metrics/query_trace_metric.h.
+"""
+
+import re
+from collections import defaultdict
+from typing import Dict, List, NamedTuple, Optional
+
+# A row of query_text.csv: db_oid, query_id, timestamp, "query_text", parameter_type. The text of a query may span
+# lines and contain anything, so a row ends with the quote before the parameter types, which are a list of type names.
+QUERY_TEXT_ROW = re.compile(r'^(\d+), (\d+), (\d+), "(.*?)", ([A-Z_;]*)$', re.MULTILINE | re.DOTALL)
+
+# The number of columns of query_trace.csv before the parameters, which go last because they may contain commas
+NUM_TRACE_COLUMNS_BEFORE_PARAMETERS = 5
+
+# A parameter such as $1 in the text of a query
+PARAMETER = re.compile(r"\$(\d+)")
+
+
+class Query(NamedTuple):
+    """ A query that the trace executed, with its parameters turned into the placeholders of psycopg2. """
+    query_id: int
+    text: str
+    param_types: List[str]
+
+
+class Execution(NamedTuple):
+    """ One execution of a query in the trace. """
+    query_id: int
+    # When the query started, in microseconds
+    start_us: int
+    # How long the query took when it was traced, in microseconds
+    latency_us: int
+    connection_id: int
+    params: Dict[str, object]
+
+
+def to_psycopg2_text(text: str) -> str:
+    """ Turn the $1, $2, ... parameters of a query into the %(p1)s, %(p2)s, ... placeholders of psycopg2. """
+    return PARAMETER.sub(r"%(p\1)s", text.replace("%", "%%"))
+
+
+def to_python_value(value: str, type_name: str) -> Optional[object]:
+    """ Turn the text of a traced parameter back into a value, where an empty text is NULL. """
+    if value == "":
+        return None
+    if type_name in ("TINYINT", "SMALLINT", "INTEGER", "BIGINT"):
+        return int(value)
+    if type_name in ("REAL", "DECIMAL"):
+        return float(value)
+    if type_name == "BOOLEAN":
+        return value == "true"
+    return value
+
+
+def load_queries(query_text_file: str) -> Dict[int, Query]:
+    """ Load the text and parameter types of every traced query, by query id. """
+    with open(query_text_file) as text_file:
+        contents = text_file.read()
+    queries = {}
+    for match in QUERY_TEXT_ROW.finditer(contents):
+        query_id = int(match.group(2))
+        param_types = [t for t in match.group(5).split(";") if t]
+        queries[query_id] = Query(query_id, to_psycopg2_text(match.group(4)), param_types)
+    return queries
+
+
+def load_executions(query_trace_file: str, queries: Dict[int, Query]) -> List[Execution]:
+    """ Load every execution of a query that the trace has the text of, in the order they started. """
+    executions = []
+    with open(query_trace_file) as trace_file:
+        # Skip the header
+        next(trace_file, None)
+        for line in trace_file:
+            fields = line.rstrip("\n").split(", ", NUM_TRACE_COLUMNS_BEFORE_PARAMETERS)
+            if len(fields) < NUM_TRACE_COLUMNS_BEFORE_PARAMETERS:
+                continue
+            query_id, timestamp_us, connection_id, latency_us = (int(f) for f in fields[1:5])
+            query = queries.get(query_id)
+            if query is None:
+                continue
+            # Every parameter is followed by a semicolon
+            values = fields[5].split(";")[:-1] if len(fields) > 5 else []
+            params = {f"p{i + 1}": to_python_value(value, type_name)
+                      for i, (value, type_name) in enumerate(zip(values, query.param_types))}
+            executions.append(Execution(query_id, timestamp_us - latency_us, latency_us, connection_id, params))
+    executions.sort(key=lambda execution: execution.start_us)
+    return executions
+
+
+def group_by_connection(executions: List[Execution]) -> Dict[int, List[Execution]]:
+    """ Split the executions into the sessions that sent them, each in the order it sent them. """
+    sessions = defaultdict(list)
+    for execution in executions:
+        sessions[execution.connection_id].append(execution)
+    return sessions
@@ -12,6 +12,7 @@
 #include "binder/binder_util.h"
 #include "catalog/catalog_accessor.h"
 #include "catalog/catalog_defs.h"
+#include "common/constants.h"
 #include "common/error/error_code.h"
 #include "common/error/exception.h"
 #include "common/managed_pointer.h"
@@ -161,6 +162,10 @@ void BindNodeVisitor::Visit(common::ManagedPointer<parser::CreateStatement> node
         throw BINDER_EXCEPTION(fmt::format("relation \"{}\" already exists", node->GetTableName()),
                                common::ErrorCode::ERRCODE_DUPLICATE_TABLE);
       }
+      if (node->GetColumns().size() > common::Constants::MAX_COL) {
+        throw BINDER_EXCEPTION(fmt::format("tables can have at most {} columns", common::Constants::MAX_COL),
+                               common::ErrorCode::ERRCODE_TOO_MANY_COLUMNS);
+      }
       context_->AddNewTable(node->GetTableName(), node->GetColumns());
       for (const auto &col : node->GetColumns()) {
         if (col->GetDefaultExpression() != nullptr)
@@ -224,17 +229,34 @@ void BindNodeVisitor::Visit(common::ManagedPointer<parser::CreateStatement> node
                                 node->GetTableName());
 
       for (auto &attr : node->GetIndexAttributes()) {
+        type::TypeId key_type;
         if (attr.HasExpr()) {
           attr.GetExpression()->Accept(common::ManagedPointer(this).CastManagedPointerTo<SqlNodeVisitor>());
+          key_type = attr.GetExpression()->GetReturnValueType();
         } else {
           // TODO(Matt): can an index attribute definition ever reference multiple tables? I don't think so. We should
           // probably move this out of the loop.
           auto tb_oid = catalog_accessor_->GetTableOid(node->GetTableName());
-          if (!BinderContext::ColumnInSchema(catalog_accessor_->GetSchema(tb_oid), attr.GetName()))
+          const auto &schema = catalog_accessor_->GetSchema(tb_oid);
+          if (!BinderContext::ColumnInSchema(schema, attr.GetName()))
             throw BINDER_EXCEPTION(fmt::format("No such column specified by the index attribute {}", attr.GetName()),
                                    common::ErrorCode::ERRCODE_INVALID_OBJECT_DEFINITION);
+          key_type = schema.GetColumn(attr.GetName()).Type();
+        }
+        // The adaptive radix tree orders keys by their binary-comparable encoding, which DECIMAL doesn't have
+        if (node->GetIndexType() == parser::IndexType::ART && key_type == type::TypeId::DECIMAL) {
+          throw BINDER_EXCEPTION("ART indexes do not support DECIMAL keys.",
+                                 common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED);
         }
       }
+      if (node->GetIndexPredicate() != nullptr) {
+        node->GetIndexPredicate()->Accept(common::ManagedPointer(this).CastManagedPointerTo<SqlNodeVisitor>());
+        node->GetIndexPredicate()->DeriveDepth();
+        node->GetIndexPredicate()->DeriveSubqueryFlag();
+        if (node->GetIndexPredicate()->HasSubquery())
+          throw BINDER_EXCEPTION("Cannot use subquery in index predicate.",
+                                 common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED);
+      }
       break;
     case parser::CreateStatement::CreateType::kTrigger:
       ValidateDatabaseName(node->GetDatabaseName());
@@ -255,6 +277,15 @@ void BindNodeVisitor::Visit(common::ManagedPointer<parser::CreateStatement> node
       NOISEPAGE_ASSERT(node->GetViewQuery() != nullptr, "View requires a query");
       node->GetViewQuery()->Accept(common::ManagedPointer(this).CastManagedPointerTo<SqlNodeVisitor>());
       break;
+    case parser::CreateStatement::CreateType::kMaterializedView:
+      ValidateDatabaseName(node->GetDatabaseName());
+      if (catalog_accessor_->GetTableOid(node->GetTableName()) != catalog::INVALID_TABLE_OID) {
+        throw BINDER_EXCEPTION(fmt::format("relation \"{}\" already exists", node->GetTableName()),
+                               common::ErrorCode::ERRCODE_DUPLICATE_TABLE);
+      }
+      NOISEPAGE_ASSERT(node->GetViewQuery() != nullptr, "Materialized view requires a query");
+      node->GetViewQuery()->Accept(common::ManagedPointer(this).CastManagedPointerTo<SqlNodeVisitor>());
+      break;
   }
 
   context_ = context_->GetUpperContext();
@@ -326,9 +357,12 @@ void BindNodeVisitor::Visit(UNUSED_ATTRIBUTE common::ManagedPointer<parser::Exec
   SqlNodeVisitor::Visit(node);
 }
 
-void BindNodeVisitor::Visit(UNUSED_ATTRIBUTE common::ManagedPointer<parser::ExplainStatement> node) {
+void BindNodeVisitor::Visit(common::ManagedPointer<parser::ExplainStatement> node) {
   BINDER_LOG_TRACE("Visiting ExplainStatement ...");
   SqlNodeVisitor::Visit(node);
+
+  // The explained statement is bound as if it were on its own
+  node->GetSQLStatement()->Accept(common::ManagedPointer(this).CastManagedPointerTo<SqlNodeVisitor>());
 }
 
 void BindNodeVisitor::Visit(common::ManagedPointer<parser::InsertStatement> node) {
@@ -15,6 +15,7 @@
 #include "storage/projected_row.h"
 #include "storage/sql_table.h"
 #include "storage/storage_defs.h"
+#include "storage/varlen_allocator.h"
 #include "transaction/deferred_action_manager.h"
 #include "transaction/transaction_manager.h"
 #include "transaction/transaction_util.h"
@@ -158,7 +159,7 @@ db_oid_t Catalog::GetDatabaseOid(const common::ManagedPointer<transaction::Trans
 
   // Clean up the varlen's buffer in the case it wasn't inlined.
   if (!name_varlen.IsInlined()) {
-    delete[] name_varlen.Content();
+    storage::VarlenAllocator::Deallocate(name_varlen.Content());
   }
 
   if (index_results.empty()) {
@@ -207,13 +208,16 @@ std::unique_ptr<CatalogAccessor> Catalog::GetAccessor(const common::ManagedPoint
                                                       const common::ManagedPointer<CatalogCache> cache) {
   auto dbc = this->GetDatabaseCatalog(common::ManagedPointer(txn), database);
   if (dbc == nullptr) return nullptr;
+  std::shared_ptr<CatalogCache::Version> cache_version = nullptr;
   if (cache != DISABLED) {
+    // The txn sees the catalog as of the last DDL change only if that change committed before the txn started. While
+    // a DDL change is in progress, or if one committed since, the txn looks everything up in the DatabaseCatalog.
     const auto last_ddl_change = dbc->write_lock_.load();
-    const bool invalidate_cache = transaction::TransactionUtil::Committed(last_ddl_change) &&
-                                  transaction::TransactionUtil::NewerThan(last_ddl_change, cache->OldestEntry());
-    if (invalidate_cache) cache->Reset(txn->StartTime());
+    const bool share_cache = transaction::TransactionUtil::Committed(last_ddl_change) &&
+                             transaction::TransactionUtil::NewerThan(txn->StartTime(), last_ddl_change);
+    if (share_cache) cache_version = cache->GetVersion(database, last_ddl_change);
   }
-  return std::make_unique<CatalogAccessor>(common::ManagedPointer(this), dbc, txn, cache);
+  return std::make_unique<CatalogAccessor>(common::ManagedPointer(this), dbc, txn, std::move(cache_version));
 }
 
 bool Catalog::CreateDatabaseEntry(const common::ManagedPointer<transaction::TransactionContext> txn, const db_oid_t db,
@@ -329,6 +333,25 @@ std::function<void()> Catalog::DeallocateDatabaseCatalog(DatabaseCatalog *const
   };
 }
 
+std::vector<db_oid_t> Catalog::GetDatabaseOids(const common::ManagedPointer<transaction::TransactionContext> txn) {
+  // Only one column, so we only need the initializer and not the ProjectionMap
+  const std::vector<col_oid_t> cols{postgres::PgDatabase::DATOID.oid_};
+  const auto pci = databases_->InitializerForProjectedColumns(cols, 100);
+  byte *buffer = common::AllocationUtil::AllocateAligned(pci.ProjectedColumnsSize());
+  auto pc = pci.Initialize(buffer);
+  auto db_oids = reinterpret_cast<db_oid_t *>(pc->ColumnStart(0));
+
+  std::vector<db_oid_t> result;
+  auto table_iter = databases_->begin();
+  while (table_iter != databases_->end()) {
+    databases_->Scan(txn, &table_iter, pc);
+    for (uint i = 0; i < pc->NumTuples(); i++) result.emplace_back(db_oids[i]);
+  }
+
+  delete[] buffer;
+  return result;
+}
+
 common::ManagedPointer<storage::BlockStore> Catalog::GetBlockStore() const {
   // TODO(Matt): at some point we may decide the Catalog owns this, but right now it doesn't. Taking ownership may
   // introduce life cycle issues (i.e. guaranteeing that all tables are freed and Blocks returned before this object
@@ -1,5 +1,6 @@
 #include "catalog/catalog_accessor.h"
 
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <vector>
@@ -8,6 +9,7 @@
 #include "catalog/catalog_cache.h"
 #include "catalog/database_catalog.h"
 #include "catalog/postgres/pg_proc.h"
+#include "transaction/transaction_context.h"
 
 namespace noisepage::catalog {
 db_oid_t CatalogAccessor::GetDatabaseOid(std::string name) const {
@@ -35,9 +37,18 @@ void CatalogAccessor::SetSearchPath(std::vector<namespace_oid_t> namespaces) {
   search_path_.emplace(search_path_.begin(), postgres::PgNamespace::NAMESPACE_CATALOG_NAMESPACE_OID);
 }
 
+void CatalogAccessor::SetTempNamespace(const namespace_oid_t ns_oid) {
+  NOISEPAGE_ASSERT(temp_namespace_ == INVALID_NAMESPACE_OID, "The temporary namespace is already set.");
+  temp_namespace_ = ns_oid;
+  const auto pos =
+      std::find(search_path_.begin(), search_path_.end(), postgres::PgNamespace::NAMESPACE_CATALOG_NAMESPACE_OID);
+  search_path_.insert(pos == search_path_.end() ? search_path_.begin() : pos + 1, ns_oid);
+}
+
 namespace_oid_t CatalogAccessor::GetNamespaceOid(std::string name) const {
   if (name.empty()) return catalog::postgres::PgNamespace::NAMESPACE_DEFAULT_NAMESPACE_OID;
   NormalizeObjectName(&name);
+  if (name == TEMP_NAMESPACE_ALIAS) return temp_namespace_;
   return dbc_->GetNamespaceOid(txn_, name);
 }
 
@@ -62,9 +73,10 @@ table_oid_t CatalogAccessor::GetTableOid(namespace_oid_t ns, std::string name) c
   return dbc_->GetTableOid(txn_, ns, name);
 }
 
-table_oid_t CatalogAccessor::CreateTable(namespace_oid_t ns, std::string name, const Schema &schema) const {
+table_oid_t CatalogAccessor::CreateTable(namespace_oid_t ns, std::string name, const Schema &schema,
+                                         const std::optional<std::string> &view_definition) const {
   NormalizeObjectName(&name);
-  return dbc_->CreateTable(txn_, ns, name, schema);
+  return dbc_->CreateTable(txn_, ns, name, schema, view_definition);
 }
 
 bool CatalogAccessor::RenameTable(table_oid_t table, std::string new_table_name) const {
@@ -79,14 +91,15 @@ bool CatalogAccessor::SetTablePointer(table_oid_t table, storage::SqlTable *tabl
 }
 
 common::ManagedPointer<storage::SqlTable> CatalogAccessor::GetTable(table_oid_t table) const {
-  if (cache_ != DISABLED) {
-    auto table_ptr = cache_->GetTable(table);
-    if (table_ptr == nullptr) {
+  auto *const cache = SharedCache();
+  if (cache != DISABLED) {
+    storage::SqlTable *table_ptr;
+    if (!CatalogCache::Version::Get(cache->tables_, table, &table_ptr)) {
       // not in the cache, get it from the actual catalog, stash it, and return retrieved value
-      table_ptr = dbc_->GetTable(txn_, table);
-      cache_->PutTable(table, table_ptr);
+      table_ptr = dbc_->GetTable(txn_, table).Get();
+      cache->tables_.Insert(table, table_ptr);
     }
-    return table_ptr;
+    return common::ManagedPointer(table_ptr);
   }
   return dbc_->GetTable(txn_, table);
 }
@@ -95,22 +108,38 @@ bool CatalogAccessor::UpdateSchema(table_oid_t table, Schema *new_schema) const
   return dbc_->UpdateSchema(txn_, table, new_schema);
 }
 
-const Schema &CatalogAccessor::GetSchema(table_oid_t table) const { return dbc_->GetSchema(txn_, table); }
+const Schema &CatalogAccessor::GetSchema(table_oid_t table) const {
+  auto *const cache = SharedCache();
+  if (cache != DISABLED) {
+    const Schema *schema;
+    if (!CatalogCache::Version::Get(cache->schemas_, table, &schema)) {
+      schema = &dbc_->GetSchema(txn_, table);
+      cache->schemas_.Insert(table, schema);
+    }
+    return *schema;
+  }
+  return dbc_->GetSchema(txn_, table);
+}
+
+std::optional<std::string> CatalogAccessor::GetViewDefinition(table_oid_t table) const {
+  return dbc_->GetViewDefinition(txn_, table);
+}
 
 std::vector<constraint_oid_t> CatalogAccessor::GetConstraints(table_oid_t table) const {
   return dbc_->GetConstraints(txn_, table);
 }
 
 std::vector<index_oid_t> CatalogAccessor::GetIndexOids(table_oid_t table) const {
-  if (cache_ != DISABLED) {
-    auto cache_lookup = cache_->GetIndexOids(table);
-    if (!cache_lookup.first) {
+  auto *const cache = SharedCache();
+  if (cache != DISABLED) {
+    // the list of a table without indexes is cached too, as an empty list
+    std::vector<index_oid_t> index_oids;
+    if (!CatalogCache::Version::Get(cache->index_oids_, table, &index_oids)) {
       // not in the cache, get it from the actual catalog, stash it, and return retrieved value
-      const auto index_oids = dbc_->GetIndexOids(txn_, table);
-      cache_->PutIndexOids(table, index_oids);
-      return index_oids;
+      index_oids = dbc_->GetIndexOids(txn_, table);
+      cache->index_oids_.Insert(table, index_oids);
     }
-    return cache_lookup.second;
+    return index_oids;
   }
   return dbc_->GetIndexOids(txn_, table);
 }
@@ -141,6 +170,15 @@ index_oid_t CatalogAccessor::CreateIndex(namespace_oid_t ns, table_oid_t table,
 }
 
 const IndexSchema &CatalogAccessor::GetIndexSchema(index_oid_t index) const {
+  auto *const cache = SharedCache();
+  if (cache != DISABLED) {
+    const IndexSchema *schema;
+    if (!CatalogCache::Version::Get(cache->index_schemas_, index, &schema)) {
+      schema = &dbc_->GetIndexSchema(txn_, index);
+      cache->index_schemas_.Insert(index, schema);
+    }
+    return *schema;
+  }
   return dbc_->GetIndexSchema(txn_, index);
 }
 
@@ -151,18 +189,37 @@ bool CatalogAccessor::SetIndexPointer(index_oid_t index, storage::index::Index *
 }
 
 common::ManagedPointer<storage::index::Index> CatalogAccessor::GetIndex(index_oid_t index) const {
-  if (cache_ != DISABLED) {
-    auto index_ptr = cache_->GetIndex(index);
-    if (index_ptr == nullptr) {
+  auto *const cache = SharedCache();
+  if (cache != DISABLED) {
+    storage::index::Index *index_ptr;
+    if (!CatalogCache::Version::Get(cache->indexes_, index, &index_ptr)) {
       // not in the cache, get it from the actual catalog, stash it, and return retrieved value
-      index_ptr = dbc_->GetIndex(txn_, index);
-      cache_->PutIndex(index, index_ptr);
+      index_ptr = dbc_->GetIndex(txn_, index).Get();
+      cache->indexes_.Insert(index, index_ptr);
     }
-    return index_ptr;
+    return common::ManagedPointer(index_ptr);
   }
   return dbc_->GetIndex(txn_, index);
 }
 
+bool CatalogAccessor::SetIndexValid(index_oid_t index, bool valid) const {
+  return dbc_->SetIndexValid(txn_, index, valid);
+}
+
+bool CatalogAccessor::IsIndexValid(index_oid_t index) const {
+  auto *const cache = SharedCache();
+  if (cache != DISABLED) {
+    bool valid;
+    if (!CatalogCache::Version::Get(cache->index_valid_, index, &valid)) {
+      // not in the cache, get it from the actual catalog, stash it, and return retrieved value
+      valid = dbc_->IsIndexValid(txn_, index);
+      cache->index_valid_.Insert(index, valid);
+    }
+    return valid;
+  }
+  return dbc_->IsIndexValid(txn_, index);
+}
+
 language_oid_t CatalogAccessor::CreateLanguage(const std::string &lanname) {
   return dbc_->CreateLanguage(txn_, lanname);
 }
@@ -186,9 +243,21 @@ proc_oid_t CatalogAccessor::CreateProcedure(const std::string &procname, languag
 bool CatalogAccessor::DropProcedure(proc_oid_t proc_oid) { return dbc_->DropProcedure(txn_, proc_oid); }
 
 proc_oid_t CatalogAccessor::GetProcOid(const std::string &procname, const std::vector<type_oid_t> &arg_types) {
+  auto *const cache = SharedCache();
   proc_oid_t ret;
   for (auto ns_oid : search_path_) {
-    ret = dbc_->GetProcOid(txn_, ns_oid, procname, arg_types);
+    if (cache != DISABLED) {
+      // procedures that don't exist are cached too, as INVALID_PROC_OID
+      std::string key = procname + '\0';
+      key.append(reinterpret_cast<const char *>(&ns_oid), sizeof(ns_oid));
+      key.append(reinterpret_cast<const char *>(arg_types.data()), arg_types.size() * sizeof(type_oid_t));
+      if (!CatalogCache::Version::Get(cache->proc_oids_, key, &ret)) {
+        ret = dbc_->GetProcOid(txn_, ns_oid, procname, arg_types);
+        cache->proc_oids_.Insert(key, ret);
+      }
+    } else {
+      ret = dbc_->GetProcOid(txn_, ns_oid, procname, arg_types);
+    }
     if (ret != catalog::INVALID_PROC_OID) {
       return ret;
     }
@@ -202,6 +271,15 @@ bool CatalogAccessor::SetFunctionContextPointer(proc_oid_t proc_oid,
 }
 
 common::ManagedPointer<execution::functions::FunctionContext> CatalogAccessor::GetFunctionContext(proc_oid_t proc_oid) {
+  auto *const cache = SharedCache();
+  if (cache != DISABLED) {
+    execution::functions::FunctionContext *func_context;
+    if (!CatalogCache::Version::Get(cache->function_contexts_, proc_oid, &func_context)) {
+      func_context = dbc_->GetFunctionContext(txn_, proc_oid).Get();
+      cache->function_contexts_.Insert(proc_oid, func_context);
+    }
+    return common::ManagedPointer(func_context);
+  }
   return dbc_->GetFunctionContext(txn_, proc_oid);
 }
 
@@ -216,6 +294,11 @@ optimizer::TableStats CatalogAccessor::GetTableStatistics(table_oid_t table_oid)
 
 type_oid_t CatalogAccessor::GetTypeOidFromTypeId(type::TypeId type) { return dbc_->GetTypeOidForType(type); }
 
+CatalogCache::Version *CatalogAccessor::SharedCache() const {
+  if (cache_ == nullptr || dbc_->write_lock_.load() == txn_->FinishTime()) return nullptr;
+  return cache_.get();
+}
+
 common::ManagedPointer<storage::BlockStore> CatalogAccessor::GetBlockStore() const {
   // TODO(Matt): at some point we may decide to adjust the source  (i.e. each DatabaseCatalog has one), stick it in a
   // pg_tablespace table, or we may eliminate the concept entirely. This works for now to allow CREATE nodes to bind a
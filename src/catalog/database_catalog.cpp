@@ -107,10 +107,11 @@ namespace_oid_t DatabaseCatalog::GetNamespaceOid(const common::ManagedPointer<tr
 }
 
 table_oid_t DatabaseCatalog::CreateTable(const common::ManagedPointer<transaction::TransactionContext> txn,
-                                         const namespace_oid_t ns, const std::string &name, const Schema &schema) {
+                                         const namespace_oid_t ns, const std::string &name, const Schema &schema,
+                                         const std::optional<std::string> &view_definition) {
   if (!TryLock(txn)) return INVALID_TABLE_OID;
   const table_oid_t table_oid = static_cast<table_oid_t>(next_oid_++);
-  return CreateTableEntry(txn, table_oid, ns, name, schema) ? table_oid : INVALID_TABLE_OID;
+  return CreateTableEntry(txn, table_oid, ns, name, schema, view_definition) ? table_oid : INVALID_TABLE_OID;
 }
 
 bool DatabaseCatalog::DeleteTable(const common::ManagedPointer<transaction::TransactionContext> txn,
@@ -164,14 +165,15 @@ bool DatabaseCatalog::SetIndexPointer(const common::ManagedPointer<transaction::
       write_lock_.load() == txn->FinishTime(),
       "Setting the object's pointer should only be done after successful DDL change request. i.e. this txn "
       "should already have the lock.");
-  if (index_ptr->Type() == storage::index::IndexType::BWTREE) {
+  // Every index type except the hash index frees unlinked nodes during garbage collection
+  if (index_ptr->Type() != storage::index::IndexType::HASHMAP) {
     garbage_collector_->RegisterIndexForGC(common::ManagedPointer(index_ptr));
   }
   // This needs to be deferred because if any items were subsequently inserted into this index, they will have deferred
   // abort actions that will be above this action on the abort stack.  The defer ensures we execute after them.
   txn->RegisterAbortAction(
       [=, garbage_collector{garbage_collector_}](transaction::DeferredActionManager *deferred_action_manager) {
-        if (index_ptr->Type() == storage::index::IndexType::BWTREE) {
+        if (index_ptr->Type() != storage::index::IndexType::HASHMAP) {
           garbage_collector->UnregisterIndexForGC(common::ManagedPointer(index_ptr));
         }
         deferred_action_manager->RegisterDeferredAction([=]() { delete index_ptr; });
@@ -199,6 +201,11 @@ index_oid_t DatabaseCatalog::GetIndexOid(const common::ManagedPointer<transactio
   return index_oid_t(oid_pair.first);
 }
 
+std::vector<table_oid_t> DatabaseCatalog::GetTableOids(
+    const common::ManagedPointer<transaction::TransactionContext> txn) {
+  return pg_core_.GetTableOids(txn);
+}
+
 common::ManagedPointer<storage::SqlTable> DatabaseCatalog::GetTable(
     const common::ManagedPointer<transaction::TransactionContext> txn, const table_oid_t table) {
   const auto ptr_pair = pg_core_.GetClassPtrKind(txn, table.UnderlyingValue());
@@ -236,6 +243,11 @@ const IndexSchema &DatabaseCatalog::GetIndexSchema(const common::ManagedPointer<
   return *reinterpret_cast<IndexSchema *>(ptr_pair.first);
 }
 
+std::optional<std::string> DatabaseCatalog::GetViewDefinition(
+    const common::ManagedPointer<transaction::TransactionContext> txn, const table_oid_t table) {
+  return pg_core_.GetViewDefinition(txn, table);
+}
+
 bool DatabaseCatalog::RenameTable(const common::ManagedPointer<transaction::TransactionContext> txn,
                                   const table_oid_t table, const std::string &name) {
   if (!TryLock(txn)) return false;
@@ -245,10 +257,9 @@ bool DatabaseCatalog::RenameTable(const common::ManagedPointer<transaction::Tran
 
 bool DatabaseCatalog::UpdateSchema(const common::ManagedPointer<transaction::TransactionContext> txn,
                                    const table_oid_t table, Schema *const new_schema) {
+  txn->RegisterAbortAction([=]() { delete new_schema; });
   if (!TryLock(txn)) return false;
-  // TODO(John): Implement
-  NOISEPAGE_ASSERT(false, "Not implemented");
-  return false;
+  return pg_core_.UpdateSchema(txn, table, new_schema);
 }
 
 template <typename Column, typename ClassOid, typename ColOid>
@@ -300,6 +311,17 @@ std::vector<index_oid_t> DatabaseCatalog::GetIndexOids(
   return pg_core_.GetIndexOids(txn, table);
 }
 
+bool DatabaseCatalog::SetIndexValid(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                    const index_oid_t index, const bool valid) {
+  if (!TryLock(txn)) return false;
+  return pg_core_.SetIndexValid(txn, index, valid);
+}
+
+bool DatabaseCatalog::IsIndexValid(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                   const index_oid_t index) {
+  return pg_core_.IsIndexValid(txn, index);
+}
+
 std::vector<std::pair<common::ManagedPointer<storage::index::Index>, const IndexSchema &>> DatabaseCatalog::GetIndexes(
     const common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table) {
   return pg_core_.GetIndexes(txn, table);
@@ -333,7 +355,8 @@ void DatabaseCatalog::BootstrapIndex(const common::ManagedPointer<transaction::T
 
 bool DatabaseCatalog::CreateTableEntry(const common::ManagedPointer<transaction::TransactionContext> txn,
                                        const table_oid_t table_oid, const namespace_oid_t ns_oid,
-                                       const std::string &name, const Schema &schema) {
+                                       const std::string &name, const Schema &schema,
+                                       const std::optional<std::string> &view_definition) {
   // Create associated entries in pg_statistic.
   {
     col_oid_t col_oid(1);
@@ -341,7 +364,7 @@ bool DatabaseCatalog::CreateTableEntry(const common::ManagedPointer<transaction:
       pg_stat_.CreateColumnStatistic(txn, table_oid, col_oid++, col);
     }
   }
-  return pg_core_.CreateTableEntry(txn, table_oid, ns_oid, name, schema);
+  return pg_core_.CreateTableEntry(txn, table_oid, ns_oid, name, schema, view_definition);
 }
 
 bool DatabaseCatalog::CreateIndexEntry(const common::ManagedPointer<transaction::TransactionContext> txn,
@@ -37,6 +37,7 @@ nlohmann::json IndexSchema::ToJson() const {
   j["primary"] = is_primary_;
   j["exclusion"] = is_exclusion_;
   j["immediate"] = is_immediate_;
+  j["predicate"] = predicate_ == nullptr ? nlohmann::json(nullptr) : predicate_->ToJson();
   return j;
 }
 
@@ -54,6 +55,11 @@ std::unique_ptr<IndexSchema> IndexSchema::DeserializeSchema(const nlohmann::json
   auto type = static_cast<storage::index::IndexType>(j.at("type").get<char>());
 
   auto schema = std::make_unique<IndexSchema>(columns, type, unique, primary, exclusion, immediate);
+  if (!j.at("predicate").is_null()) {
+    auto deserialized = parser::DeserializeExpression(j.at("predicate"));
+    NOISEPAGE_ASSERT(deserialized.non_owned_exprs_.empty(), "Index predicates should not own subqueries.");
+    schema->SetPredicate(std::move(deserialized.result_));
+  }
 
   return schema;
 }
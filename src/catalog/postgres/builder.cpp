@@ -218,6 +218,10 @@ Schema Builder::GetClassTableSchema() {
                        parser::ConstantValueExpression(type::TypeId::INTEGER));
   columns.back().SetOid(PgClass::REL_NEXTCOLOID.oid_);
 
+  columns.emplace_back("viewdef", type::TypeId::VARCHAR, 4096, true,
+                       parser::ConstantValueExpression(type::TypeId::VARCHAR));
+  columns.back().SetOid(PgClass::REL_VIEWDEF.oid_);
+
   return Schema(columns);
 }
 
@@ -313,6 +317,10 @@ Schema Builder::GetIndexTableSchema() {
                        parser::ConstantValueExpression(type::TypeId::TINYINT));
   columns.back().SetOid(PgIndex::IND_TYPE.oid_);
 
+  columns.emplace_back("indpred", type::TypeId::VARCHAR, 4096, true,
+                       parser::ConstantValueExpression(type::TypeId::VARCHAR));
+  columns.back().SetOid(PgIndex::INDPRED.oid_);
+
   return Schema(columns);
 }
 
@@ -707,6 +715,10 @@ Schema Builder::GetStatisticTableSchema() {
                        parser::ConstantValueExpression(type::TypeId::VARBINARY));
   columns.back().SetOid(PgStatistic::STA_HISTOGRAM.oid_);
 
+  columns.emplace_back("stacolgroups", type::TypeId::VARBINARY, true,
+                       parser::ConstantValueExpression(type::TypeId::VARBINARY));
+  columns.back().SetOid(PgStatistic::STA_COLGROUPS.oid_);
+
   return Schema(columns);
 }
 
@@ -1,5 +1,8 @@
 #include "catalog/postgres/pg_core_impl.h"
 
+#include <algorithm>
+#include <unordered_set>
+
 #include "catalog/database_catalog.h"
 #include "catalog/index_schema.h"
 #include "catalog/postgres/builder.h"
@@ -12,6 +15,7 @@
 #include "storage/garbage_collector.h"
 #include "storage/index/index.h"
 #include "storage/sql_table.h"
+#include "storage/varlen_allocator.h"
 #include "transaction/deferred_action_manager.h"
 
 namespace noisepage::catalog::postgres {
@@ -59,6 +63,9 @@ void PgCoreImpl::BootstrapPRIsPgClass() {
   const std::vector<col_oid_t> get_class_object_and_schema_oids{PgClass::REL_PTR.oid_, PgClass::REL_SCHEMA.oid_};
   get_class_object_and_schema_pri_ = classes_->InitializerForProjectedRow(get_class_object_and_schema_oids);
   get_class_object_and_schema_prm_ = classes_->ProjectionMapForOids(get_class_object_and_schema_oids);
+
+  const std::vector<col_oid_t> get_class_view_definition_oids{PgClass::REL_VIEWDEF.oid_};
+  get_class_view_definition_pri_ = classes_->InitializerForProjectedRow(get_class_view_definition_oids);
 }
 
 void PgCoreImpl::BootstrapPRIsPgIndex() {
@@ -73,6 +80,9 @@ void PgCoreImpl::BootstrapPRIsPgIndex() {
   const std::vector<col_oid_t> delete_index_oids{PgIndex::INDOID.oid_, PgIndex::INDRELID.oid_};
   delete_index_pri_ = indexes_->InitializerForProjectedRow(delete_index_oids);
   delete_index_prm_ = indexes_->ProjectionMapForOids(delete_index_oids);
+
+  const std::vector<col_oid_t> index_valid_oids{PgIndex::INDISVALID.oid_};
+  index_valid_pri_ = indexes_->InitializerForProjectedRow(index_valid_oids);
 }
 
 void PgCoreImpl::BootstrapPRIsPgAttribute() {
@@ -223,7 +233,7 @@ std::function<void(void)> PgCoreImpl::GetTearDownFn(common::ManagedPointer<trans
           table_schemas{std::move(table_schemas)}, index_schemas{std::move(index_schemas)}]() {
     for (auto table : tables) delete table;
     for (auto index : indexes) {
-      if (index->Type() == storage::index::IndexType::BWTREE) {
+      if (index->Type() != storage::index::IndexType::HASHMAP) {
         garbage_collector->UnregisterIndexForGC(common::ManagedPointer(index));
       }
       delete index;
@@ -388,7 +398,7 @@ namespace_oid_t PgCoreImpl::GetNamespaceOid(const common::ManagedPointer<transac
     pr->Set<storage::VarlenEntry, false>(0, name_varlen, false);
     namespaces_name_index_->ScanKey(*txn, *pr, &index_results);
     if (name_varlen.NeedReclaim()) {
-      delete[] name_varlen.Content();
+      storage::VarlenAllocator::Deallocate(name_varlen.Content());
     }
     if (index_results.empty()) {  // Namespace doesn't exist. Ask to abort.
       delete[] buffer;
@@ -453,7 +463,7 @@ bool PgCoreImpl::SetClassPointer(const common::ManagedPointer<transaction::Trans
 
 bool PgCoreImpl::CreateTableEntry(const common::ManagedPointer<transaction::TransactionContext> txn,
                                   const table_oid_t table_oid, const namespace_oid_t ns_oid, const std::string &name,
-                                  const Schema &schema) {
+                                  const Schema &schema, const std::optional<std::string> &view_definition) {
   auto *const insert_redo = txn->StageWrite(db_oid_, PgClass::CLASS_TABLE_OID, pg_class_all_cols_pri_);
   auto delta = common::ManagedPointer(insert_redo->Delta());
   auto &pm = pg_class_all_cols_prm_;
@@ -470,6 +480,11 @@ bool PgCoreImpl::CreateTableEntry(const common::ManagedPointer<transaction::Tran
     PgClass::REL_SCHEMA.Set(delta, pm, nullptr);  // Need to update once we've recreated the columns.
     PgClass::REL_PTR.SetNull(delta, pm);
     PgClass::REL_NEXTCOLOID.Set(delta, pm, next_col_oid);
+    if (view_definition.has_value()) {
+      PgClass::REL_VIEWDEF.Set(delta, pm, storage::StorageUtil::CreateVarlen(*view_definition));
+    } else {
+      PgClass::REL_VIEWDEF.SetNull(delta, pm);
+    }
   }
 
   // Insert into pg_class.
@@ -644,10 +659,13 @@ bool PgCoreImpl::DeleteTable(const common::ManagedPointer<transaction::Transacti
   txn->RegisterCommitAction([=](transaction::DeferredActionManager *deferred_action_manager) {
     deferred_action_manager->RegisterDeferredAction([=]() {
       deferred_action_manager->RegisterDeferredAction([=]() {
-        // Defer an action upon commit to delete the table. Delete table will need a double deferral because there could
-        // be transactions not yet unlinked by the GC that depend on the table
-        delete schema_ptr;
-        delete table_ptr;
+        deferred_action_manager->RegisterDeferredAction([=]() {
+          // Defer an action upon commit to delete the table. Delete table will need a double deferral because there
+          // could be transactions not yet unlinked by the GC that depend on the table, and a third one because the GC
+          // frees the slots of the tuples that those transactions deleted in a later epoch than it unlinks them
+          delete schema_ptr;
+          delete table_ptr;
+        });
       });
     });
   });
@@ -664,6 +682,43 @@ bool PgCoreImpl::RenameTable(const common::ManagedPointer<transaction::Transacti
   return false;
 }
 
+bool PgCoreImpl::UpdateSchema(const common::ManagedPointer<transaction::TransactionContext> txn,
+                              const table_oid_t table, Schema *const new_schema) {
+  const auto ptr_pair = GetClassSchemaPtrKind(txn, table.UnderlyingValue());
+  NOISEPAGE_ASSERT(ptr_pair.first != nullptr && ptr_pair.second == PgClass::RelKind::REGULAR_TABLE,
+                   "Requested a schema change for a non-table.");
+  auto *const old_schema = reinterpret_cast<Schema *>(ptr_pair.first);
+
+  // Only the columns in the table's layout can be kept, which are the columns of the current schema.
+  std::unordered_set<col_oid_t> dropped_oids;
+  for (const auto &col : old_schema->GetColumns()) dropped_oids.emplace(col.Oid());
+  for (const auto &col : new_schema->GetColumns()) {
+    const auto it = dropped_oids.find(col.Oid());
+    if (it == dropped_oids.end() || old_schema->GetColumn(col.Oid()).Type() != col.Type()) return false;
+    dropped_oids.erase(it);
+  }
+  // An index on a dropped column would go on reading it.
+  for (const auto &index : GetIndexes(txn, table)) {
+    for (const auto col_oid : index.second.GetIndexedColOids()) {
+      if (dropped_oids.count(col_oid) > 0) return false;
+    }
+  }
+
+  // Rewrite pg_attribute with the columns that are kept, whose OIDs are never handed out again.
+  if (!DeleteColumns<Schema::Column, table_oid_t>(txn, table)) return false;
+  for (const auto &col : new_schema->GetColumns()) {
+    if (!CreateColumn(txn, table, col.Oid(), col)) return false;
+  }
+  if (!SetClassPointer(txn, table, new_schema, PgClass::REL_SCHEMA.oid_)) return false;
+
+  // Transactions that began before the change may still be reading the old schema, like a dropped table's.
+  txn->RegisterCommitAction([=](transaction::DeferredActionManager *deferred_action_manager) {
+    deferred_action_manager->RegisterDeferredAction(
+        [=]() { deferred_action_manager->RegisterDeferredAction([=]() { delete old_schema; }); });
+  });
+  return true;
+}
+
 bool PgCoreImpl::CreateIndexEntry(const common::ManagedPointer<transaction::TransactionContext> txn,
                                   const namespace_oid_t ns_oid, const table_oid_t table_oid,
                                   const index_oid_t index_oid, const std::string &name, const IndexSchema &schema) {
@@ -683,6 +738,7 @@ bool PgCoreImpl::CreateIndexEntry(const common::ManagedPointer<transaction::Tran
     PgClass::REL_SCHEMA.Set(delta, pm, nullptr);
     PgClass::REL_PTR.SetNull(delta, pm);         // Set by execution layer after instantiation.
     PgClass::REL_NEXTCOLOID.SetNull(delta, pm);  // Indexes don't need col_oid.
+    PgClass::REL_VIEWDEF.SetNull(delta, pm);
   }
 
   // Insert into pg_class.
@@ -746,6 +802,10 @@ bool PgCoreImpl::CreateIndexEntry(const common::ManagedPointer<transaction::Tran
       PgIndex::INDISREADY.Set(delta, pm, true);
       PgIndex::INDISLIVE.Set(delta, pm, true);
       PgIndex::IND_TYPE.Set(delta, pm, static_cast<char>(schema.type_));
+      if (schema.predicate_ != nullptr)
+        PgIndex::INDPRED.Set(delta, pm, storage::StorageUtil::CreateVarlen(schema.predicate_->ToJson().dump()));
+      else
+        PgIndex::INDPRED.SetNull(delta, pm);
 
       // Insert into pg_index.
       const auto indexes_tuple_slot = indexes_->Insert(txn, indexes_insert_redo);
@@ -800,6 +860,7 @@ bool PgCoreImpl::CreateIndexEntry(const common::ManagedPointer<transaction::Tran
         GetColumns<IndexSchema::Column, index_oid_t, indexkeycol_oid_t>(txn, index_oid);
     auto *new_schema =
         new IndexSchema(cols, schema.Type(), schema.Unique(), schema.Primary(), schema.Exclusion(), schema.Immediate());
+    if (schema.predicate_ != nullptr) new_schema->SetPredicate(schema.predicate_->Copy());
     txn->RegisterAbortAction([=]() { delete new_schema; });
 
     auto *const update_redo = txn->StageWrite(db_oid_, PgClass::CLASS_TABLE_OID, set_class_schema_pri_);
@@ -966,7 +1027,7 @@ bool PgCoreImpl::DeleteIndex(const common::ManagedPointer<transaction::Transacti
     // txn manager. See base function comment.
     txn->RegisterCommitAction(
         [=, garbage_collector{dbc->garbage_collector_}](transaction::DeferredActionManager *deferred_action_manager) {
-          if (index_ptr->Type() == storage::index::IndexType::BWTREE) {
+          if (index_ptr->Type() != storage::index::IndexType::HASHMAP) {
             garbage_collector->UnregisterIndexForGC(common::ManagedPointer(index_ptr));
           }
           // Unregistering from GC can happen immediately, but we have to double-defer freeing the actual objects
@@ -1114,6 +1175,79 @@ std::vector<index_oid_t> PgCoreImpl::GetIndexOids(const common::ManagedPointer<t
   return index_oids;
 }
 
+bool PgCoreImpl::SetIndexValid(const common::ManagedPointer<transaction::TransactionContext> txn,
+                               const index_oid_t index, const bool valid) {
+  const auto oid_pri = indexes_oid_index_->GetProjectedRowInitializer();
+  auto *const buffer = common::AllocationUtil::AllocateAligned(oid_pri.ProjectedRowSize());
+
+  // Find the index entry using pg_index_oid_index.
+  std::vector<storage::TupleSlot> index_results;
+  {
+    auto *const key_pr = oid_pri.InitializeRow(buffer);
+    key_pr->Set<index_oid_t, false>(0, index, false);
+    indexes_oid_index_->ScanKey(*txn, *key_pr, &index_results);
+    NOISEPAGE_ASSERT(index_results.size() == 1, "Incorrect number of results from index scan. Expect 1 because it's a "
+                                                "unique index. 0 implies that function was called with a bad oid.");
+  }
+  delete[] buffer;
+
+  // Update pg_index. Like every other change to pg_index, this is logged, so recovery and replicas replay it.
+  auto *update_redo = txn->StageWrite(db_oid_, PgIndex::INDEX_TABLE_OID, index_valid_pri_);
+  update_redo->SetTupleSlot(index_results[0]);
+  update_redo->Delta()->Set<bool, false>(0, valid, false);
+  return indexes_->Update(txn, update_redo);
+}
+
+bool PgCoreImpl::IsIndexValid(const common::ManagedPointer<transaction::TransactionContext> txn,
+                              const index_oid_t index) {
+  const auto oid_pri = indexes_oid_index_->GetProjectedRowInitializer();
+  auto *const buffer = common::AllocationUtil::AllocateAligned(
+      std::max(oid_pri.ProjectedRowSize(), index_valid_pri_.ProjectedRowSize()));
+
+  // Find the index entry using pg_index_oid_index.
+  std::vector<storage::TupleSlot> index_results;
+  {
+    auto *const key_pr = oid_pri.InitializeRow(buffer);
+    key_pr->Set<index_oid_t, false>(0, index, false);
+    indexes_oid_index_->ScanKey(*txn, *key_pr, &index_results);
+    NOISEPAGE_ASSERT(index_results.size() == 1, "Incorrect number of results from index scan. Expect 1 because it's a "
+                                                "unique index. 0 implies that function was called with a bad oid.");
+  }
+
+  auto *const select_pr = index_valid_pri_.InitializeRow(buffer);
+  const auto result UNUSED_ATTRIBUTE = indexes_->Select(txn, index_results[0], select_pr);
+  NOISEPAGE_ASSERT(result, "Index already verified visibility. This shouldn't fail.");
+  const bool valid = *select_pr->Get<bool, false>(0, nullptr);
+  delete[] buffer;
+  return valid;
+}
+
+std::vector<table_oid_t> PgCoreImpl::GetTableOids(const common::ManagedPointer<transaction::TransactionContext> txn) {
+  const std::vector<col_oid_t> pg_class_oids{PgClass::RELOID.oid_, PgClass::RELKIND.oid_};
+
+  auto pci = classes_->InitializerForProjectedColumns(pg_class_oids, DatabaseCatalog::TEARDOWN_MAX_TUPLES);
+  auto pm = classes_->ProjectionMapForOids(pg_class_oids);
+
+  byte *buffer = common::AllocationUtil::AllocateAligned(pci.ProjectedColumnsSize());
+  auto pc = pci.Initialize(buffer);
+
+  // Fetch pointers to the start of each attribute in the projected columns.
+  auto oids = reinterpret_cast<table_oid_t *>(pc->ColumnStart(pm[PgClass::RELOID.oid_]));
+  auto kinds = reinterpret_cast<PgClass::RelKind *>(pc->ColumnStart(pm[PgClass::RELKIND.oid_]));
+
+  std::vector<table_oid_t> table_oids;
+  auto table_iter = classes_->begin();
+  while (table_iter != classes_->end()) {
+    classes_->Scan(txn, &table_iter, pc);
+    for (uint i = 0; i < pc->NumTuples(); i++) {
+      if (kinds[i] == PgClass::RelKind::REGULAR_TABLE) table_oids.emplace_back(oids[i]);
+    }
+  }
+
+  delete[] buffer;
+  return table_oids;
+}
+
 std::vector<std::pair<uint32_t, PgClass::RelKind>> PgCoreImpl::GetNamespaceClassOids(
     const common::ManagedPointer<transaction::TransactionContext> txn, const namespace_oid_t ns_oid) {
   // Initialize both PR initializers, allocate buffer using size of largest one so we can reuse buffer.
@@ -1257,7 +1391,7 @@ std::pair<uint32_t, PgClass::RelKind> PgCoreImpl::GetClassOidKind(
     classes_name_index_->ScanKey(*txn, *pr, &index_results);
 
     if (name_varlen.NeedReclaim()) {
-      delete[] name_varlen.Content();
+      storage::VarlenAllocator::Deallocate(name_varlen.Content());
     }
   }
 
@@ -1292,6 +1426,41 @@ std::pair<uint32_t, PgClass::RelKind> PgCoreImpl::GetClassOidKind(
   return std::make_pair(oid, kind);
 }
 
+std::optional<std::string> PgCoreImpl::GetViewDefinition(
+    const common::ManagedPointer<transaction::TransactionContext> txn, const table_oid_t table) {
+  const auto oid_pri = classes_oid_index_->GetProjectedRowInitializer();
+
+  NOISEPAGE_ASSERT(get_class_view_definition_pri_.ProjectedRowSize() >= oid_pri.ProjectedRowSize(),
+                   "Buffer must be allocated to fit largest PR");
+  auto *const buffer = common::AllocationUtil::AllocateAligned(get_class_view_definition_pri_.ProjectedRowSize());
+
+  // Find the entry using pg_class_oid_index.
+  std::vector<storage::TupleSlot> index_results;
+  {
+    auto *key_pr = oid_pri.InitializeRow(buffer);
+    key_pr->Set<table_oid_t, false>(0, table, false);
+    classes_oid_index_->ScanKey(*txn, *key_pr, &index_results);
+    NOISEPAGE_ASSERT(index_results.size() == 1,
+                     "Incorrect number of results from index scan. Expect 1 because it's a unique index. "
+                     "0 implies that function was called with an oid that doesn't exist in the Catalog.");
+  }
+
+  // Select the tuple out.
+  auto *select_pr = get_class_view_definition_pri_.InitializeRow(buffer);
+  {
+    const auto result UNUSED_ATTRIBUTE = classes_->Select(txn, index_results[0], select_pr);
+    NOISEPAGE_ASSERT(result, "Index already verified visibility. This shouldn't fail.");
+  }
+
+  // The definition is copied out, the varlen belongs to pg_class.
+  const auto *const view_def = select_pr->Get<storage::VarlenEntry, false>(0, nullptr);
+  std::optional<std::string> view_definition;
+  if (view_def != nullptr) view_definition = std::string(view_def->StringView());
+
+  delete[] buffer;
+  return view_definition;
+}
+
 template <typename Column, typename ClassOid, typename ColOid>
 bool PgCoreImpl::CreateColumn(const common::ManagedPointer<transaction::TransactionContext> txn,
                               const ClassOid class_oid, const ColOid col_oid, const Column &col) {
@@ -1335,7 +1504,7 @@ bool PgCoreImpl::CreateColumn(const common::ManagedPointer<transaction::Transact
     if (!columns_name_index_->InsertUnique(txn, *pr, tupleslot)) {  // Name conflict. Ask to abort.
       delete[] buffer;
       if (name_varlen.NeedReclaim()) {
-        delete[] name_varlen.Content();
+        storage::VarlenAllocator::Deallocate(name_varlen.Content());
       }
       return false;
     }
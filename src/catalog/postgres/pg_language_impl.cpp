@@ -7,6 +7,7 @@
 #include "catalog/schema.h"
 #include "storage/index/index.h"
 #include "storage/sql_table.h"
+#include "storage/varlen_allocator.h"
 
 namespace noisepage::catalog::postgres {
 
@@ -111,7 +112,7 @@ language_oid_t PgLanguageImpl::GetLanguageOid(const common::ManagedPointer<trans
   }
 
   if (name_varlen.NeedReclaim()) {
-    delete[] name_varlen.Content();
+    storage::VarlenAllocator::Deallocate(name_varlen.Content());
   }
 
   delete[] buffer;
@@ -12,6 +12,7 @@
 #include "execution/functions/function_context.h"
 #include "storage/index/index.h"
 #include "storage/sql_table.h"
+#include "storage/varlen_allocator.h"
 #include "transaction/deferred_action_manager.h"
 
 namespace noisepage::catalog::postgres {
@@ -304,7 +305,7 @@ proc_oid_t PgProcImpl::GetProcOid(const common::ManagedPointer<transaction::Tran
     procs_name_index_->ScanKey(*txn, *name_pr, &results);
 
     if (name_varlen.NeedReclaim()) {
-      delete[] name_varlen.Content();
+      storage::VarlenAllocator::Deallocate(name_varlen.Content());
     }
   }
 
@@ -337,10 +338,10 @@ proc_oid_t PgProcImpl::GetProcOid(const common::ManagedPointer<transaction::Tran
       }
     }
     if (variadic_varlen.NeedReclaim()) {
-      delete[] variadic_varlen.Content();
+      storage::VarlenAllocator::Deallocate(variadic_varlen.Content());
     }
     if (all_arg_types_varlen.NeedReclaim()) {
-      delete[] all_arg_types_varlen.Content();
+      storage::VarlenAllocator::Deallocate(all_arg_types_varlen.Content());
     }
   }
 
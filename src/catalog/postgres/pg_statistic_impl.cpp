@@ -211,35 +211,51 @@ std::unique_ptr<optimizer::ColumnStatsBase> PgStatisticImpl::CreateColumnStats(
   const auto *top_k_str = PgStatistic::STA_TOPK.Get(all_cols_pr, pg_statistic_all_cols_prm_);
   const auto *histogram_str = PgStatistic::STA_HISTOGRAM.Get(all_cols_pr, pg_statistic_all_cols_prm_);
 
+  std::unique_ptr<optimizer::ColumnStatsBase> column_stats;
   switch (type) {
     case type::TypeId::BOOLEAN:
-      return CreateColumnStats<execution::sql::BoolVal>(table_oid, col_oid, num_rows, non_null_rows, distinct_values,
-                                                        top_k_str, histogram_str, type);
+      column_stats = CreateColumnStats<execution::sql::BoolVal>(table_oid, col_oid, num_rows, non_null_rows,
+                                                                distinct_values, top_k_str, histogram_str, type);
+      break;
     case type::TypeId::TINYINT:
     case type::TypeId::SMALLINT:
     case type::TypeId::INTEGER:
     case type::TypeId::BIGINT:
-      return CreateColumnStats<execution::sql::Integer>(table_oid, col_oid, num_rows, non_null_rows, distinct_values,
-                                                        top_k_str, histogram_str, type);
+      column_stats = CreateColumnStats<execution::sql::Integer>(table_oid, col_oid, num_rows, non_null_rows,
+                                                                distinct_values, top_k_str, histogram_str, type);
+      break;
     case type::TypeId::REAL:
-      return CreateColumnStats<execution::sql::Real>(table_oid, col_oid, num_rows, non_null_rows, distinct_values,
-                                                     top_k_str, histogram_str, type);
+      column_stats = CreateColumnStats<execution::sql::Real>(table_oid, col_oid, num_rows, non_null_rows,
+                                                             distinct_values, top_k_str, histogram_str, type);
+      break;
     case type::TypeId::DECIMAL:
-      return CreateColumnStats<execution::sql::DecimalVal>(table_oid, col_oid, num_rows, non_null_rows, distinct_values,
-                                                           top_k_str, histogram_str, type);
+      column_stats = CreateColumnStats<execution::sql::DecimalVal>(table_oid, col_oid, num_rows, non_null_rows,
+                                                                   distinct_values, top_k_str, histogram_str, type);
+      break;
     case type::TypeId::TIMESTAMP:
-      return CreateColumnStats<execution::sql::TimestampVal>(table_oid, col_oid, num_rows, non_null_rows,
-                                                             distinct_values, top_k_str, histogram_str, type);
+      column_stats = CreateColumnStats<execution::sql::TimestampVal>(table_oid, col_oid, num_rows, non_null_rows,
+                                                                     distinct_values, top_k_str, histogram_str, type);
+      break;
     case type::TypeId::DATE:
-      return CreateColumnStats<execution::sql::DateVal>(table_oid, col_oid, num_rows, non_null_rows, distinct_values,
-                                                        top_k_str, histogram_str, type);
+      column_stats = CreateColumnStats<execution::sql::DateVal>(table_oid, col_oid, num_rows, non_null_rows,
+                                                                distinct_values, top_k_str, histogram_str, type);
+      break;
     case type::TypeId::VARCHAR:
     case type::TypeId::VARBINARY:
-      return CreateColumnStats<execution::sql::StringVal>(table_oid, col_oid, num_rows, non_null_rows, distinct_values,
-                                                          top_k_str, histogram_str, type);
+      column_stats = CreateColumnStats<execution::sql::StringVal>(table_oid, col_oid, num_rows, non_null_rows,
+                                                                  distinct_values, top_k_str, histogram_str, type);
+      break;
     default:
       UNREACHABLE("Invalid column type");
   }
+
+  // The statistics of the column groups are NULL unless the column starts a group that was analyzed
+  const auto *col_groups_str = PgStatistic::STA_COLGROUPS.Get(all_cols_pr, pg_statistic_all_cols_prm_);
+  if (col_groups_str != nullptr) {
+    column_stats->SetColumnGroupStats(
+        optimizer::ColumnGroupStats::Deserialize(col_groups_str->Content(), col_groups_str->Size()));
+  }
+  return column_stats;
 }
 
 template <typename T>
@@ -0,0 +1,40 @@
+#include "common/memory_accountant.h"
+
+namespace noisepage::common {
+
+thread_local MemoryAccountant::ThreadCounts MemoryAccountant::thread_counts;
+
+MemoryAccountant::ThreadCounts::~ThreadCounts() {
+  for (uint8_t i = 0; i < NUM_COMPONENTS; i++) {
+    if (unmerged_[i] != 0) Totals()[i].fetch_add(unmerged_[i], std::memory_order_relaxed);
+    unmerged_[i] = 0;
+  }
+}
+
+std::array<std::atomic<int64_t>, MemoryAccountant::NUM_COMPONENTS> &MemoryAccountant::Totals() {
+  // Never destroyed, so that threads that exit late can still merge their counts
+  static auto *const totals = new std::array<std::atomic<int64_t>, NUM_COMPONENTS>{};
+  return *totals;
+}
+
+int64_t MemoryAccountant::GetBytes(const MemoryComponent component) {
+  return Totals()[static_cast<uint8_t>(component)].load(std::memory_order_relaxed);
+}
+
+std::string_view MemoryAccountant::ComponentName(const MemoryComponent component) {
+  switch (component) {
+    case MemoryComponent::BLOCK_STORE:
+      return "block_store";
+    case MemoryComponent::RECORD_BUFFERS:
+      return "record_buffers";
+    case MemoryComponent::VARLEN:
+      return "varlen";
+    case MemoryComponent::EXECUTION:
+      return "execution";
+    default:
+      NOISEPAGE_ASSERT(false, "Unknown memory component.");
+      return "unknown";
+  }
+}
+
+}  // namespace noisepage::common
@@ -0,0 +1,59 @@
+#include "common/numa_topology.h"
+
+#include <sched.h>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace noisepage::common {
+
+const NumaTopology &NumaTopology::Get() {
+  static const NumaTopology topology;
+  return topology;
+}
+
+NumaTopology::NumaTopology() {
+#if __linux__
+  std::error_code ec;
+  for (const auto &entry : std::filesystem::directory_iterator("/sys/devices/system/node", ec)) {
+    const std::string name = entry.path().filename().string();
+    if (name.rfind("node", 0) != 0 || name.size() == 4 || !std::isdigit(name[4])) continue;
+    const auto node = static_cast<uint16_t>(std::stoul(name.substr(4)));
+    std::ifstream cpulist(entry.path() / "cpulist");
+    std::string ranges;
+    if (!std::getline(cpulist, ranges)) continue;
+    // The list looks like "0-7,16-23"
+    std::stringstream stream(ranges);
+    std::string range;
+    while (std::getline(stream, range, ',')) {
+      if (range.empty()) continue;
+      const auto dash = range.find('-');
+      const uint32_t first = std::stoul(range.substr(0, dash));
+      const uint32_t last = dash == std::string::npos ? first : std::stoul(range.substr(dash + 1));
+      if (cpu_to_node_.size() <= last) cpu_to_node_.resize(last + 1, 0);
+      for (uint32_t cpu = first; cpu <= last; cpu++) cpu_to_node_[cpu] = node;
+    }
+    num_nodes_ = std::max<uint16_t>(num_nodes_, node + 1);
+  }
+#endif
+}
+
+uint16_t NumaTopology::CurrentNode() const {
+  if (num_nodes_ == 1) return 0;
+  const int cpu = sched_getcpu();
+  return cpu >= 0 && static_cast<uint32_t>(cpu) < cpu_to_node_.size() ? cpu_to_node_[cpu] : 0;
+}
+
+std::vector<uint32_t> NumaTopology::CpusOf(const uint16_t node) const {
+  std::vector<uint32_t> cpus;
+  for (uint32_t cpu = 0; cpu < cpu_to_node_.size(); cpu++) {
+    if (cpu_to_node_[cpu] == node) cpus.push_back(cpu);
+  }
+  return cpus;
+}
+
+}  // namespace noisepage::common
@@ -62,6 +62,33 @@ void PosixIoWrappers::WriteFully(int fd, const void *buf, size_t nbyte) {
   }
 }
 
+uint32_t PosixIoWrappers::PreadFully(int fd, void *buf, size_t nbyte, off_t offset) {
+  ssize_t bytes_read = 0;
+  while (bytes_read < static_cast<ssize_t>(nbyte)) {
+    ssize_t ret = pread(fd, reinterpret_cast<char *>(buf) + bytes_read, static_cast<ssize_t>(nbyte) - bytes_read,
+                        offset + bytes_read);
+    if (ret == -1) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error("Read failed with errno " + std::to_string(errno));
+    }
+    if (ret == 0) break;  // no more bytes left in the file
+    bytes_read += ret;
+  }
+  return static_cast<uint32_t>(bytes_read);
+}
+
+void PosixIoWrappers::PwriteFully(int fd, const void *buf, size_t nbyte, off_t offset) {
+  ssize_t written = 0;
+  while (static_cast<size_t>(written) < nbyte) {
+    ssize_t ret = pwrite(fd, reinterpret_cast<const char *>(buf) + written, nbyte - written, offset + written);
+    if (ret == -1) {
+      if (errno == EINTR) continue;
+      throw std::runtime_error("Write failed with errno " + std::to_string(errno));
+    }
+    written += ret;
+  }
+}
+
 template int PosixIoWrappers::Open<>(const char *path, int oflag);
 template int PosixIoWrappers::Open<int>(const char *path, int oflag, int mode);
 
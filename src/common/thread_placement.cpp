@@ -0,0 +1,153 @@
+#include "common/thread_placement.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+
+#include "common/error/error_code.h"
+#include "common/error/exception.h"
+#include "common/macros.h"
+#include "common/numa_topology.h"
+#include "loggers/common_logger.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage::common {
+
+namespace {
+
+#if __linux__
+constexpr uint32_t MAX_CPUS = CPU_SETSIZE;
+#else
+constexpr uint32_t MAX_CPUS = 1024;
+#endif
+
+// Parse a decimal number that makes up all of the token
+bool ParseNumber(const std::string_view token, uint32_t *const number) {
+  if (token.empty() || token.size() > 9) return false;
+  *number = 0;
+  for (const char c : token) {
+    if (!std::isdigit(static_cast<unsigned char>(c))) return false;
+    *number = *number * 10 + static_cast<uint32_t>(c - '0');
+  }
+  return true;
+}
+
+}  // namespace
+
+ThreadPlacement::ThreadPlacement() {
+#if __linux__
+  cpu_set_t cpus;
+  CPU_ZERO(&cpus);
+  if (sched_getaffinity(0, sizeof(cpus), &cpus) == 0) {
+    for (uint32_t cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &cpus)) process_cpus_.push_back(cpu);
+    }
+  }
+#endif
+  if (process_cpus_.empty()) {
+    for (uint32_t cpu = 0; cpu < std::thread::hardware_concurrency(); cpu++) process_cpus_.push_back(cpu);
+  }
+}
+
+void ThreadPlacement::SetPolicy(const ThreadRole role, Policy policy) {
+  NOISEPAGE_ASSERT(role < ThreadRole::NUM_ROLES, "Not a role.");
+  std::sort(policy.cpus_.begin(), policy.cpus_.end());
+  policy.cpus_.erase(std::unique(policy.cpus_.begin(), policy.cpus_.end()), policy.cpus_.end());
+  policies_[static_cast<uint8_t>(role)] = std::move(policy);
+  enabled_ = std::any_of(policies_.cbegin(), policies_.cend(),
+                         [](const Policy &policy) { return !policy.cpus_.empty() || policy.realtime_; });
+}
+
+std::vector<uint32_t> ThreadPlacement::CpusOf(const ThreadRole role) const {
+  if (!enabled_) return {};
+  const Policy &policy = GetPolicy(role);
+  if (!policy.cpus_.empty()) return policy.cpus_;
+
+  // Everything but the CPUs of isolated roles. Even without isolated roles, this keeps a thread from inheriting the
+  // CPUs of a placed thread that started it.
+  std::vector<uint32_t> cpus = process_cpus_;
+  for (const auto &other : policies_) {
+    if (!other.isolated_) continue;
+    cpus.erase(std::remove_if(cpus.begin(), cpus.end(),
+                              [&](const uint32_t cpu) {
+                                return std::binary_search(other.cpus_.cbegin(), other.cpus_.cend(), cpu);
+                              }),
+               cpus.end());
+  }
+  // Never leave a thread without CPUs, even if the isolated roles took them all
+  return cpus.empty() ? process_cpus_ : cpus;
+}
+
+void ThreadPlacement::Apply(const ThreadRole role) const {
+  if (!enabled_) return;
+#if __linux__
+  const std::vector<uint32_t> cpus = CpusOf(role);
+  if (!cpus.empty()) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const uint32_t cpu : cpus) {
+      if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+    }
+    if (const int error = pthread_setaffinity_np(pthread_self(), sizeof(set), &set); error != 0) {
+      COMMON_LOG_WARN("Could not pin a thread of role {} to its CPUs: {}", static_cast<uint8_t>(role),
+                      std::strerror(error));
+    }
+  }
+
+  if (GetPolicy(role).realtime_) {
+    sched_param param{};
+    param.sched_priority = sched_get_priority_min(SCHED_FIFO);
+    if (const int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param); error != 0) {
+      COMMON_LOG_WARN("Could not give a thread of role {} real-time priority: {}", static_cast<uint8_t>(role),
+                      std::strerror(error));
+    }
+  }
+#endif
+}
+
+std::vector<uint32_t> ThreadPlacement::ParseCpuList(const std::string_view list) {
+  std::vector<uint32_t> cpus;
+  size_t start = 0;
+  while (start < list.size()) {
+    size_t end = list.find(',', start);
+    if (end == std::string_view::npos) end = list.size();
+    std::string_view token = list.substr(start, end - start);
+    start = end + 1;
+    while (!token.empty() && std::isspace(static_cast<unsigned char>(token.front()))) token.remove_prefix(1);
+    while (!token.empty() && std::isspace(static_cast<unsigned char>(token.back()))) token.remove_suffix(1);
+    if (token.empty()) continue;
+
+    uint32_t first;
+    uint32_t last;
+    if (token.rfind("node", 0) == 0) {
+      uint32_t node;
+      if (!ParseNumber(token.substr(4), &node) || node >= NumaTopology::Get().NumNodes()) {
+        throw SETTINGS_EXCEPTION(fmt::format("Unknown NUMA node \"{}\" in CPU list \"{}\"", token, list),
+                                 common::ErrorCode::ERRCODE_INVALID_PARAMETER_VALUE);
+      }
+      const std::vector<uint32_t> node_cpus = NumaTopology::Get().CpusOf(static_cast<uint16_t>(node));
+      cpus.insert(cpus.end(), node_cpus.cbegin(), node_cpus.cend());
+      continue;
+    }
+    const size_t dash = token.find('-');
+    const bool valid = dash == std::string_view::npos
+                           ? ParseNumber(token, &first) && ParseNumber(token, &last)
+                           : ParseNumber(token.substr(0, dash), &first) && ParseNumber(token.substr(dash + 1), &last);
+    if (!valid || first > last || last >= MAX_CPUS) {
+      throw SETTINGS_EXCEPTION(fmt::format("Malformed CPU range \"{}\" in CPU list \"{}\"", token, list),
+                               common::ErrorCode::ERRCODE_INVALID_PARAMETER_VALUE);
+    }
+    for (uint32_t cpu = first; cpu <= last; cpu++) cpus.push_back(cpu);
+  }
+  std::sort(cpus.begin(), cpus.end());
+  cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+  return cpus;
+}
+
+}  // namespace noisepage::common
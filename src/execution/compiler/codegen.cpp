@@ -521,6 +521,32 @@ ast::Expr *CodeGen::IndexIteratorScan(ast::Expr *iter_ptr, planner::IndexScanTyp
   return CallBuiltin(builtin, args);
 }
 
+ast::Expr *CodeGen::IterateIndexParallel(ast::Expr *iter_ptr, planner::IndexScanType scan_type,
+                                         ast::Expr *query_state, ast::Identifier worker_name) {
+  storage::index::ScanType asc_type;
+  switch (scan_type) {
+    case planner::IndexScanType::AscendingClosed:
+      asc_type = storage::index::ScanType::Closed;
+      break;
+    case planner::IndexScanType::AscendingOpenHigh:
+      asc_type = storage::index::ScanType::OpenHigh;
+      break;
+    case planner::IndexScanType::AscendingOpenLow:
+      asc_type = storage::index::ScanType::OpenLow;
+      break;
+    case planner::IndexScanType::AscendingOpenBoth:
+      asc_type = storage::index::ScanType::OpenBoth;
+      break;
+    default:
+      UNREACHABLE("Only ascending scans are parallel");
+  }
+  ast::Expr *scan_type_expr = Const64(static_cast<int64_t>(asc_type));
+  ast::Expr *call =
+      CallBuiltin(ast::Builtin::IndexIteratorParallel, {iter_ptr, scan_type_expr, query_state, MakeExpr(worker_name)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::PRGet(ast::Expr *pr, type::TypeId type, bool nullable, uint32_t attr_idx) {
   // @indexIteratorGetTypeNull(&iter, attr_idx)
   ast::Builtin builtin;
@@ -635,6 +661,39 @@ ast::Expr *CodeGen::TableIterClose(ast::Expr *table_iter) {
   return call;
 }
 
+ast::Expr *CodeGen::TableIterFilterBlocks(ast::Expr *table_iter, uint32_t col_idx, int64_t min, int64_t max) {
+  ast::Expr *call =
+      CallBuiltin(ast::Builtin::TableIterFilterBlocks, {table_iter, ConstU32(col_idx), Const64(min), Const64(max)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::TableIterFilterBlocksTopK(ast::Expr *table_iter, uint32_t col_idx, ast::Expr *sorter,
+                                              bool descending) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::TableIterFilterBlocksTopK,
+                                {table_iter, ConstU32(col_idx), sorter, ConstBool(descending)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::TableIterSampleBlocks(ast::Expr *table_iter, uint32_t num_blocks) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::TableIterSampleBlocks, {table_iter, ConstU32(num_blocks)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::TableIterLateMaterialize(ast::Expr *table_iter, uint32_t col_idx) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::TableIterLateMaterialize, {table_iter, ConstU32(col_idx)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::TableIterFetchLateColumns(ast::Expr *table_iter) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::TableIterFetchLateColumns, {table_iter});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::IterateTableParallel(catalog::table_oid_t table_oid, ast::Identifier col_oids,
                                          ast::Expr *query_state, ast::Expr *exec_ctx, ast::Identifier worker_name) {
   ast::Expr *call = CallBuiltin(
@@ -789,6 +848,12 @@ ast::Expr *CodeGen::FilterManagerInit(ast::Expr *filter_manager, ast::Expr *exec
   return call;
 }
 
+ast::Expr *CodeGen::FilterManagerInit(ast::Expr *filter_manager, ast::Expr *exec_ctx, ast::Expr *context) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::FilterManagerInit, {filter_manager, exec_ctx, context});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::FilterManagerFree(ast::Expr *filter_manager) {
   ast::Expr *call = CallBuiltin(ast::Builtin::FilterManagerFree, {filter_manager});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
@@ -813,6 +878,64 @@ ast::Expr *CodeGen::FilterManagerRunFilters(ast::Expr *filter_manager, ast::Expr
   return call;
 }
 
+// ---------------------------------------------------------
+// Vector Expressions
+// ---------------------------------------------------------
+
+ast::Expr *CodeGen::VectorProjectionInit(ast::Expr *vp, ast::Identifier col_types) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::VectorProjectionInit, {vp, MakeExpr(col_types)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::VectorProjectionExtend(ast::Expr *vp, ast::Expr *vpi) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::VectorProjectionExtend, {vp, vpi});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::VectorProjectionFree(ast::Expr *vp) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::VectorProjectionFree, {vp});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::VectorCast(ast::Expr *exec_ctx, ast::Expr *vp, uint32_t result_col_idx, uint32_t col_idx) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::VectorCast, {exec_ctx, vp, Const32(result_col_idx), Const32(col_idx)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::VectorDatePart(ast::Expr *exec_ctx, ast::Expr *vp, uint32_t result_col_idx, uint32_t col_idx,
+                                   sql::DatePartType part) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::VectorDatePart, {exec_ctx, vp, Const32(result_col_idx), Const32(col_idx),
+                                                               Const32(static_cast<int32_t>(part))});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::VectorArithmetic(ast::Expr *exec_ctx, ast::Expr *vp, parser::ExpressionType op_type,
+                                     uint32_t result_col_idx, ast::Expr *left, ast::Expr *right) {
+  ast::Builtin builtin;
+  switch (op_type) {
+    case parser::ExpressionType::OPERATOR_PLUS:
+      builtin = ast::Builtin::VectorAdd;
+      break;
+    case parser::ExpressionType::OPERATOR_MINUS:
+      builtin = ast::Builtin::VectorSub;
+      break;
+    case parser::ExpressionType::OPERATOR_MULTIPLY:
+      builtin = ast::Builtin::VectorMul;
+      break;
+    default:
+      throw NOT_IMPLEMENTED_EXCEPTION(
+          fmt::format("CodeGen: Vector arithmetic {} not supported.", parser::ExpressionTypeToString(op_type)));
+  }
+  ast::Expr *call = CallBuiltin(builtin, {exec_ctx, vp, Const32(result_col_idx), left, right});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::ExecCtxRegisterHook(ast::Expr *exec_ctx, uint32_t hook_idx, ast::Identifier hook) {
   ast::Expr *call =
       CallBuiltin(ast::Builtin::ExecutionContextRegisterHook, {exec_ctx, Const32(hook_idx), MakeExpr(hook)});
@@ -826,6 +949,33 @@ ast::Expr *CodeGen::ExecCtxClearHooks(ast::Expr *exec_ctx) {
   return call;
 }
 
+ast::Expr *CodeGen::ExecCtxCheckInterrupt(ast::Expr *exec_ctx) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::ExecutionContextCheckInterrupt, {exec_ctx});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::ExecCtxScaleSampledCount(ast::Expr *exec_ctx, ast::Expr *count) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::ExecutionContextScaleSampledCount, {exec_ctx, count});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Integer));
+  return call;
+}
+
+ast::Expr *CodeGen::ExecCtxScaleSampledDistinct(ast::Expr *exec_ctx, ast::Expr *num_distinct, ast::Expr *count) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::ExecutionContextScaleSampledDistinct, {exec_ctx, num_distinct, count});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Integer));
+  return call;
+}
+
+ast::Expr *CodeGen::ExecCtxAnalyzeColumnGroups(ast::Expr *exec_ctx, catalog::table_oid_t table_oid,
+                                               catalog::col_oid_t col_oid) {
+  ast::Expr *call =
+      CallBuiltin(ast::Builtin::ExecutionContextAnalyzeColumnGroups,
+                  {exec_ctx, ConstU32(table_oid.UnderlyingValue()), ConstU32(col_oid.UnderlyingValue())});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::StringVal));
+  return call;
+}
+
 ast::Expr *CodeGen::ExecCtxInitHooks(ast::Expr *exec_ctx, uint32_t num_hooks) {
   ast::Expr *call = CallBuiltin(ast::Builtin::ExecutionContextInitHooks, {exec_ctx, Const32(num_hooks)});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
@@ -937,6 +1087,51 @@ ast::Expr *CodeGen::JoinHashTableLookup(ast::Expr *join_hash_table, ast::Expr *e
   return call;
 }
 
+ast::Expr *CodeGen::JoinHashTableEnableSpilling(ast::Expr *join_hash_table, ast::Identifier probe_row_type_name) {
+  ast::Expr *call =
+      CallBuiltin(ast::Builtin::JoinHashTableEnableSpilling, {join_hash_table, SizeOf(probe_row_type_name)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableIsSpilled(ast::Expr *join_hash_table, ast::Expr *hash_val) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableIsSpilled, {join_hash_table, hash_val});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Bool));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableEnableRuntimeFilter(ast::Expr *join_hash_table) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableEnableRuntimeFilter, {join_hash_table});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableEnableCompactLayout(ast::Expr *join_hash_table) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableEnableCompactLayout, {join_hash_table});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableMayContain(ast::Expr *join_hash_table, ast::Expr *hash_val) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableMayContain, {join_hash_table, hash_val});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Bool));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableSpillProbe(ast::Expr *join_hash_table, ast::Expr *hash_val, ast::Expr *probe_row) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableSpillProbe, {join_hash_table, hash_val, probe_row});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::JoinHashTableProcessSpilled(ast::Expr *join_hash_table, ast::Expr *query_state,
+                                                ast::Expr *pipeline_state, ast::Identifier probe_fn) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableProcessSpilled,
+                                {join_hash_table, query_state, pipeline_state, MakeExpr(probe_fn)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::JoinHashTableFree(ast::Expr *join_hash_table) {
   ast::Expr *call = CallBuiltin(ast::Builtin::JoinHashTableFree, {join_hash_table});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
@@ -1015,6 +1210,31 @@ ast::Expr *CodeGen::AggHashTableLinkEntry(ast::Expr *agg_ht, ast::Expr *entry) {
   return call;
 }
 
+ast::Expr *CodeGen::AggHashTableInternString(ast::Expr *agg_ht, ast::Expr *key) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::AggHashTableInternString, {agg_ht, key});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::AggHashTableSetDenseDomain(ast::Expr *agg_ht, int64_t min_key, uint32_t num_keys) {
+  ast::Expr *call =
+      CallBuiltin(ast::Builtin::AggHashTableSetDenseDomain, {agg_ht, Const64(min_key), ConstU32(num_keys)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::AggHashTableLookupDense(ast::Expr *agg_ht, ast::Expr *key, ast::Identifier agg_payload_type) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::AggHashTableLookupDense, {agg_ht, key});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Uint8)->PointerTo());
+  return PtrCast(agg_payload_type, call);
+}
+
+ast::Expr *CodeGen::AggHashTableInsertDense(ast::Expr *agg_ht, ast::Expr *key, ast::Expr *agg_payload) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::AggHashTableInsertDense, {agg_ht, key, agg_payload});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::AggHashTableMovePartitions(ast::Expr *agg_ht, ast::Expr *tls, ast::Expr *tl_agg_ht_offset,
                                                ast::Identifier merge_partitions_fn_name) {
   std::initializer_list<ast::Expr *> args = {agg_ht, tls, tl_agg_ht_offset, MakeExpr(merge_partitions_fn_name)};
@@ -1117,6 +1337,18 @@ ast::Expr *CodeGen::AggregatorAdvance(ast::Expr *agg, ast::Expr *val) {
   return call;
 }
 
+ast::Expr *CodeGen::AggregatorAdvanceVector(ast::Expr *agg, ast::Expr *vpi, uint32_t col_idx) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::AggAdvanceVector, {agg, vpi, Const32(col_idx)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::AggregatorAdvanceVector(ast::Expr *agg, ast::Expr *vpi) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::AggAdvanceVector, {agg, vpi});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
 ast::Expr *CodeGen::AggregatorMerge(ast::Expr *agg1, ast::Expr *agg2) {
   ast::Expr *call = CallBuiltin(ast::Builtin::AggMerge, {agg1, agg2});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
@@ -1150,6 +1382,18 @@ ast::Expr *CodeGen::SorterInit(ast::Expr *sorter, ast::Expr *exec_ctx, ast::Iden
   return call;
 }
 
+ast::Expr *CodeGen::SorterSetNormalizedKey(ast::Expr *sorter, ast::Identifier key_func_name) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::SorterSetNormalizedKey, {sorter, MakeExpr(key_func_name)});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::SorterNormalizeKey(ast::Expr *value) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::SorterNormalizeKey, {value});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Uint64));
+  return call;
+}
+
 ast::Expr *CodeGen::SorterInsert(ast::Expr *sorter, ast::Identifier sort_row_type_name) {
   // @sorterInsert(sorter)
   ast::Expr *call = CallBuiltin(ast::Builtin::SorterInsert, {sorter});
@@ -1172,6 +1416,18 @@ ast::Expr *CodeGen::SorterInsertTopKFinish(ast::Expr *sorter, uint64_t top_k) {
   return call;
 }
 
+ast::Expr *CodeGen::SorterShareTopKBound(ast::Expr *sorter, ast::Expr *other) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::SorterShareTopKBound, {sorter, other});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
+  return call;
+}
+
+ast::Expr *CodeGen::SorterGetTopKBound(ast::Expr *sorter) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::SorterGetTopKBound, {sorter});
+  call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Uint64));
+  return call;
+}
+
 ast::Expr *CodeGen::SorterSort(ast::Expr *sorter) {
   ast::Expr *call = CallBuiltin(ast::Builtin::SorterSort, {sorter});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
@@ -1214,8 +1470,10 @@ ast::Expr *CodeGen::SorterIterNext(ast::Expr *iter) {
   return call;
 }
 
-ast::Expr *CodeGen::SorterIterSkipRows(ast::Expr *iter, uint32_t n) {
-  ast::Expr *call = CallBuiltin(ast::Builtin::SorterIterSkipRows, {iter, Const64(n)});
+ast::Expr *CodeGen::SorterIterSkipRows(ast::Expr *iter, uint32_t n) { return SorterIterSkipRows(iter, Const64(n)); }
+
+ast::Expr *CodeGen::SorterIterSkipRows(ast::Expr *iter, ast::Expr *n) {
+  ast::Expr *call = CallBuiltin(ast::Builtin::SorterIterSkipRows, {iter, n});
   call->SetType(ast::BuiltinType::Get(context_, ast::BuiltinType::Nil));
   return call;
 }
@@ -32,6 +32,7 @@
 #include "execution/compiler/operator/index_scan_translator.h"
 #include "execution/compiler/operator/insert_translator.h"
 #include "execution/compiler/operator/limit_translator.h"
+#include "execution/compiler/operator/merge_join_translator.h"
 #include "execution/compiler/operator/nested_loop_join_translator.h"
 #include "execution/compiler/operator/operator_translator.h"
 #include "execution/compiler/operator/output_translator.h"
@@ -40,6 +41,7 @@
 #include "execution/compiler/operator/sort_translator.h"
 #include "execution/compiler/operator/static_aggregation_translator.h"
 #include "execution/compiler/operator/update_translator.h"
+#include "execution/compiler/operator/window_translator.h"
 #include "execution/compiler/pipeline.h"
 #include "execution/exec/execution_settings.h"
 #include "parser/expression/abstract_expression.h"
@@ -62,12 +64,14 @@
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "planner/plannodes/insert_plan_node.h"
 #include "planner/plannodes/limit_plan_node.h"
+#include "planner/plannodes/merge_join_plan_node.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/projection_plan_node.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "planner/plannodes/set_op_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
+#include "planner/plannodes/window_plan_node.h"
 #include "self_driving/modeling/operating_unit_recorder.h"
 #include "spdlog/fmt/fmt.h"
 
@@ -88,7 +92,9 @@ CompilationContext::CompilationContext(ExecutableQuery *query, catalog::CatalogA
       query_state_type_(codegen_.MakeIdentifier("QueryState")),
       query_state_(query_state_type_, [this](CodeGen *codegen) { return codegen->MakeExpr(query_state_var_); }),
       counters_enabled_(settings.GetIsCountersEnabled()),
-      pipeline_metrics_enabled_(settings.GetIsPipelineMetricsEnabled()) {}
+      pipeline_metrics_enabled_(settings.GetIsPipelineMetricsEnabled()),
+      profiling_enabled_(settings.GetIsProfilingEnabled()),
+      analyze_sample_blocks_(settings.GetAnalyzeSampleBlocks()) {}
 
 ast::FunctionDecl *CompilationContext::GenerateInitFunction() {
   const auto name = codegen_.MakeIdentifier(GetFunctionPrefix() + "_Init");
@@ -144,17 +150,34 @@ void CompilationContext::GeneratePlan(const planner::AbstractPlanNode &plan) {
   // All fragments.
   std::vector<std::unique_ptr<ExecutableQuery::Fragment>> fragments;
 
+  // All fragments are compiled to machine code with the same pipeline.
+  const auto profile = query_->GetExecutionSettings().GetOptimizationProfile();
+
   // The main builder. The initialization and tear-down code go here. In
   // one-shot compilation, all query code goes here, too.
-  ExecutableQueryFragmentBuilder main_builder(query_->GetContext());
+  ExecutableQueryFragmentBuilder main_builder(query_->GetContext(), profile);
   main_builder.DeclareAll(top_level_structs);
   main_builder.DeclareAll(top_level_funcs);
   main_builder.RegisterStep(GenerateInitFunction());
 
+  // In interleaved compilation, every pipeline gets a fragment of its own.
+  // Each fragment is compiled when the query reaches it, after all pipelines
+  // before it ran.
+  std::vector<std::unique_ptr<ExecutableQueryFragmentBuilder>> pipeline_builders;
+
   // Generate each pipeline.
   std::vector<Pipeline *> execution_order;
   main_pipeline.CollectDependencies(&execution_order);
   for (auto *pipeline : execution_order) {
+    ExecutableQueryFragmentBuilder *builder = &main_builder;
+    if (mode_ == CompilationMode::Interleaved) {
+      auto &pipeline_builder = pipeline_builders.emplace_back(
+          std::make_unique<ExecutableQueryFragmentBuilder>(query_->GetContext(), profile));
+      builder = pipeline_builder.get();
+      builder->DeclareAll(top_level_structs);
+      builder->DeclareAll(top_level_funcs);
+    }
+
     // Extract and record the translators.
     // Pipelines require obtaining feature IDs, but features don't exist until translators are extracted.
     // Therefore translator extraction must happen before pipelines are generated.
@@ -171,19 +194,36 @@ void CompilationContext::GeneratePlan(const planner::AbstractPlanNode &plan) {
         (void)_;
         op->DefineTLSDependentHelperFunctions(*pipeline, &pipeline_decls);
       }
-      main_builder.DeclareAll(pipeline_decls);
+      builder->DeclareAll(pipeline_decls);
     }
-    pipeline->GeneratePipeline(&main_builder);
+    pipeline->GeneratePipeline(builder);
   }
 
   // Register the tear-down function.
   auto teardown = GenerateTearDownFunction();
-  main_builder.RegisterStep(teardown);
-
-  main_builder.AddTeardownFn(teardown);
+  if (mode_ == CompilationMode::Interleaved) {
+    // The query is torn down after its last pipeline ran, or by whichever
+    // fragment aborts first.
+    main_builder.DeclareFunction(teardown);
+    main_builder.AddTeardownFn(teardown);
+    fragments.emplace_back(main_builder.CompileOnFirstRun());
+    for (std::size_t i = 0; i < pipeline_builders.size(); i++) {
+      auto &builder = pipeline_builders[i];
+      if (i + 1 == pipeline_builders.size()) {
+        builder->RegisterStep(teardown);
+      } else {
+        builder->DeclareFunction(teardown);
+      }
+      builder->AddTeardownFn(teardown);
+      fragments.emplace_back(builder->CompileOnFirstRun());
+    }
+  } else {
+    main_builder.RegisterStep(teardown);
+    main_builder.AddTeardownFn(teardown);
 
-  // Compile and finish.
-  fragments.emplace_back(main_builder.Compile());
+    // Compile and finish.
+    fragments.emplace_back(main_builder.Compile());
+  }
   query_->Setup(std::move(fragments), query_state_.GetSize(), codegen_.ReleasePipelineOperatingUnits());
 }
 
@@ -249,6 +289,11 @@ void CompilationContext::Prepare(const planner::AbstractPlanNode &plan, Pipeline
       translator = std::make_unique<LimitTranslator>(limit, this, pipeline);
       break;
     }
+    case planner::PlanNodeType::MERGEJOIN: {
+      const auto &merge_join = dynamic_cast<const planner::MergeJoinPlanNode &>(plan);
+      translator = std::make_unique<MergeJoinTranslator>(merge_join, this, pipeline);
+      break;
+    }
     case planner::PlanNodeType::NESTLOOP: {
       const auto &nested_loop = dynamic_cast<const planner::NestedLoopJoinPlanNode &>(plan);
       translator = std::make_unique<NestedLoopJoinTranslator>(nested_loop, this, pipeline);
@@ -259,6 +304,11 @@ void CompilationContext::Prepare(const planner::AbstractPlanNode &plan, Pipeline
       translator = std::make_unique<SortTranslator>(sort, this, pipeline);
       break;
     }
+    case planner::PlanNodeType::WINDOW: {
+      const auto &window = dynamic_cast<const planner::WindowPlanNode &>(plan);
+      translator = std::make_unique<WindowTranslator>(window, this, pipeline);
+      break;
+    }
     case planner::PlanNodeType::PROJECTION: {
       const auto &projection = dynamic_cast<const planner::ProjectionPlanNode &>(plan);
       translator = std::make_unique<ProjectionTranslator>(projection, this, pipeline);
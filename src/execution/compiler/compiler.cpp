@@ -106,7 +106,7 @@ void Compiler::Run(Compiler::Callbacks *callbacks) {
     return;
   }
 
-  auto module = std::make_unique<vm::Module>(std::move(bytecode_module));
+  auto module = std::make_unique<vm::Module>(std::move(bytecode_module), input_.GetOptimizationProfile());
 
   // Errors?
   if (GetErrorReporter()->HasErrors()) {
@@ -9,6 +9,7 @@
 #include "execution/compiler/compiler.h"
 #include "execution/exec/execution_context.h"
 #include "execution/sema/error_reporter.h"
+#include "execution/sql/filter_manager.h"
 #include "execution/vm/module.h"
 #include "loggers/execution_logger.h"
 #include "self_driving/modeling/operating_unit.h"
@@ -22,28 +23,62 @@ namespace noisepage::execution::compiler {
 //
 //===----------------------------------------------------------------------===//
 
-ExecutableQuery::Fragment::Fragment(std::vector<std::string> &&functions, std::vector<std::string> &&teardown_fn,
-                                    std::unique_ptr<vm::Module> module)
-    : functions_(std::move(functions)), teardown_fn_(std::move(teardown_fn)), module_(std::move(module)) {}
+ExecutableQuery::Fragment::Fragment(std::vector<std::string> &&functions, std::vector<pipeline_id_t> &&step_pipelines,
+                                    std::vector<std::string> &&teardown_fn, std::unique_ptr<vm::Module> module)
+    : functions_(std::move(functions)),
+      step_pipelines_(std::move(step_pipelines)),
+      teardown_fn_(std::move(teardown_fn)),
+      module_(std::move(module)) {
+  NOISEPAGE_ASSERT(functions_.size() == step_pipelines_.size(), "Every step needs a pipeline.");
+}
+
+ExecutableQuery::Fragment::Fragment(std::vector<std::string> &&functions, std::vector<pipeline_id_t> &&step_pipelines,
+                                    std::vector<std::string> &&teardown_fn,
+                                    std::function<std::unique_ptr<vm::Module>()> compile_fn)
+    : functions_(std::move(functions)),
+      step_pipelines_(std::move(step_pipelines)),
+      teardown_fn_(std::move(teardown_fn)),
+      compile_fn_(std::move(compile_fn)) {
+  NOISEPAGE_ASSERT(functions_.size() == step_pipelines_.size(), "Every step needs a pipeline.");
+}
 
 ExecutableQuery::Fragment::~Fragment() = default;
 
-void ExecutableQuery::Fragment::Run(byte query_state[], vm::ExecutionMode mode) const {
+bool ExecutableQuery::Fragment::Run(byte query_state[], vm::ExecutionMode mode) {
   using Function = std::function<void(void *)>;
 
   auto exec_ctx = *reinterpret_cast<exec::ExecutionContext **>(query_state);
   if (exec_ctx->GetTxn()->MustAbort()) {
-    return;
+    return false;
+  }
+  if (compile_fn_ != nullptr) {
+    std::lock_guard guard(compile_mutex_);
+    if (module_ == nullptr) {
+      auto module = compile_fn_();
+      if (module == nullptr) {
+        throw EXECUTION_EXCEPTION("Could not compile query fragment.", common::ErrorCode::ERRCODE_INTERNAL_ERROR);
+      }
+      module_ = std::move(module);
+    }
   }
-  for (const auto &func_name : functions_) {
+  for (std::size_t step = 0; step < functions_.size(); step++) {
+    const auto &func_name = functions_[step];
     Function func;
     if (!module_->GetFunction(func_name, mode, &func)) {
       throw EXECUTION_EXCEPTION(fmt::format("Could not find function '{}' in query fragment.", func_name),
                                 common::ErrorCode::ERRCODE_INTERNAL_ERROR);
     }
+    exec_ctx->SetProfilePipeline(step_pipelines_[step]);
+    exec::SamplingProfiler::TagScope profile_tag(exec_ctx->GetProfileTag());
+    bool stop = false;
     try {
       func(query_state);
+      // A step that found an operator far off its estimate ends the query, so that it can be re-optimized
+      stop = exec_ctx->NeedsReoptimization();
     } catch (const AbortException &e) {
+      stop = true;
+    }
+    if (stop) {
       for (const auto &teardown_name : teardown_fn_) {
         if (!module_->GetFunction(teardown_name, mode, &func)) {
           throw EXECUTION_EXCEPTION(fmt::format("Could not find teardown function '{}' in query fragment.", func_name),
@@ -51,9 +86,10 @@ void ExecutableQuery::Fragment::Run(byte query_state[], vm::ExecutionMode mode)
         }
         func(query_state);
       }
-      return;
+      return false;
     }
   }
+  return true;
 }
 
 //===----------------------------------------------------------------------===//
@@ -86,6 +122,7 @@ ExecutableQuery::ExecutableQuery(const planner::AbstractPlanNode &plan, const ex
       ast_context_(std::make_unique<ast::Context>(context_region_.get(), errors_.get())),
       query_state_size_(0),
       pipeline_operating_units_(nullptr),
+      filter_order_cache_(std::make_unique<sql::FilterOrderCache>()),
       query_id_(query_identifier++) {}
 
 ExecutableQuery::ExecutableQuery(const std::string &contents,
@@ -117,8 +154,10 @@ ExecutableQuery::ExecutableQuery(const std::string &contents,
   auto module = compiler::Compiler::RunCompilationSimple(input);
 
   std::vector<std::string> functions{"main"};
+  std::vector<pipeline_id_t> step_pipelines{INVALID_PIPELINE_ID};
   std::vector<std::string> teardown_functions;
-  auto fragment = std::make_unique<Fragment>(std::move(functions), std::move(teardown_functions), std::move(module));
+  auto fragment = std::make_unique<Fragment>(std::move(functions), std::move(step_pipelines),
+                                             std::move(teardown_functions), std::move(module));
 
   std::vector<std::unique_ptr<Fragment>> fragments;
   fragments.emplace_back(std::move(fragment));
@@ -137,7 +176,7 @@ ExecutableQuery::~ExecutableQuery() = default;
 void ExecutableQuery::Setup(std::vector<std::unique_ptr<Fragment>> &&fragments, const std::size_t query_state_size,
                             std::unique_ptr<selfdriving::PipelineOperatingUnits> pipeline_operating_units) {
   NOISEPAGE_ASSERT(
-      std::all_of(fragments.begin(), fragments.end(), [](const auto &fragment) { return fragment->IsCompiled(); }),
+      std::all_of(fragments.begin(), fragments.end(), [](const auto &fragment) { return fragment->IsExecutable(); }),
       "All query fragments are not compiled!");
   NOISEPAGE_ASSERT(query_state_size >= sizeof(void *),
                    "Query state must be large enough to store at least an ExecutionContext pointer.");
@@ -158,11 +197,12 @@ void ExecutableQuery::Run(common::ManagedPointer<exec::ExecutionContext> exec_ct
 
   exec_ctx->SetExecutionMode(static_cast<uint8_t>(mode));
   exec_ctx->SetPipelineOperatingUnits(GetPipelineOperatingUnits());
+  exec_ctx->SetFilterOrderCache(GetFilterOrderCache());
   exec_ctx->SetQueryId(query_id_);
 
-  // Now run through fragments.
+  // Now run through fragments. An aborted fragment tore down the query state, so the rest must not run.
   for (const auto &fragment : fragments_) {
-    fragment->Run(query_state.get(), mode);
+    if (!fragment->Run(query_state.get(), mode)) break;
   }
 
   // We do not currently re-use ExecutionContexts. However, this is unset to help ensure
@@ -13,11 +13,13 @@
 
 namespace noisepage::execution::compiler {
 
-ExecutableQueryFragmentBuilder::ExecutableQueryFragmentBuilder(ast::Context *ctx) : ctx_(ctx) {}
+ExecutableQueryFragmentBuilder::ExecutableQueryFragmentBuilder(ast::Context *ctx, vm::OptimizationProfile profile)
+    : ctx_(ctx), profile_(profile) {}
 
-void ExecutableQueryFragmentBuilder::RegisterStep(ast::FunctionDecl *decl) {
+void ExecutableQueryFragmentBuilder::RegisterStep(ast::FunctionDecl *decl, pipeline_id_t pipeline_id) {
   functions_.push_back(decl);
   step_functions_.push_back(decl->Name().GetString());
+  step_pipelines_.push_back(pipeline_id);
 }
 
 namespace {
@@ -42,7 +44,7 @@ class Callbacks : public compiler::Compiler::Callbacks {
 
 }  // namespace
 
-std::unique_ptr<ExecutableQuery::Fragment> ExecutableQueryFragmentBuilder::Compile() {
+ast::File *ExecutableQueryFragmentBuilder::BuildFile() {
   // Build up the declaration list for the file.
   util::RegionVector<ast::Decl *> decls(ctx_->GetRegion());
   decls.reserve(structs_.size() + functions_.size());
@@ -50,25 +52,44 @@ std::unique_ptr<ExecutableQuery::Fragment> ExecutableQueryFragmentBuilder::Compi
   decls.insert(decls.end(), functions_.begin(), functions_.end());
 
   // The file we'll compile.
-  ast::File *generated_file = ctx_->GetNodeFactory()->NewFile({0, 0}, std::move(decls));
+  return ctx_->GetNodeFactory()->NewFile({0, 0}, std::move(decls));
+}
 
+std::unique_ptr<vm::Module> ExecutableQueryFragmentBuilder::CompileFile(ast::Context *ctx, ast::File *file,
+                                                                         vm::OptimizationProfile profile) {
   // Compile it!
-  compiler::Compiler::Input input("", ctx_, generated_file);
+  compiler::Compiler::Input input("", ctx, file);
+  input.SetOptimizationProfile(profile);
   Callbacks callbacks;
   compiler::TimePasses timer(&callbacks);
   compiler::Compiler::RunCompilation(input, &timer);
-  std::unique_ptr<vm::Module> module = callbacks.ReleaseModule();
 
   EXECUTION_LOG_DEBUG("Type-check: {:.2f} ms, Bytecode Gen: {:.2f} ms, Module Gen: {:.2f} ms", timer.GetSemaTimeMs(),
                       timer.GetBytecodeGenTimeMs(), timer.GetModuleGenTimeMs());
+  return callbacks.ReleaseModule();
+}
 
-  // Create the fragment.
+std::vector<std::string> ExecutableQueryFragmentBuilder::GetTeardownNames() const {
   std::vector<std::string> teardown_names;
   for (auto &decl : teardown_fn_) {
     teardown_names.push_back(decl->Name().GetString());
   }
-  return std::make_unique<ExecutableQuery::Fragment>(std::move(step_functions_), std::move(teardown_names),
-                                                     std::move(module));
+  return teardown_names;
+}
+
+std::unique_ptr<ExecutableQuery::Fragment> ExecutableQueryFragmentBuilder::Compile() {
+  std::unique_ptr<vm::Module> module = CompileFile(ctx_, BuildFile(), profile_);
+
+  // Create the fragment.
+  return std::make_unique<ExecutableQuery::Fragment>(std::move(step_functions_), std::move(step_pipelines_),
+                                                     GetTeardownNames(), std::move(module));
+}
+
+std::unique_ptr<ExecutableQuery::Fragment> ExecutableQueryFragmentBuilder::CompileOnFirstRun() {
+  // The file's nodes live in the AST context, which outlives the fragment.
+  return std::make_unique<ExecutableQuery::Fragment>(
+      std::move(step_functions_), std::move(step_pipelines_), GetTeardownNames(),
+      [ctx = ctx_, file = BuildFile(), profile = profile_] { return CompileFile(ctx, file, profile); });
 }
 
 }  // namespace noisepage::execution::compiler
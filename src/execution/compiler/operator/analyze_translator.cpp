@@ -6,6 +6,7 @@
 #include "execution/compiler/compilation_context.h"
 #include "execution/compiler/if.h"
 #include "execution/compiler/loop.h"
+#include "execution/compiler/operator/seq_scan_translator.h"
 #include "execution/compiler/pipeline.h"
 #include "planner/plannodes/output_schema.h"
 #include "spdlog/fmt/fmt.h"
@@ -33,6 +34,7 @@ AnalyzeTranslator::AnalyzeTranslator(const planner::AnalyzePlanNode &plan, Compi
       table_oid_(GetCodeGen()->MakeFreshIdentifier("table_oid")),
       col_oid_(GetCodeGen()->MakeFreshIdentifier("col_oid")),
       num_rows_(GetCodeGen()->MakeFreshIdentifier("num_rows")),
+      col_groups_(GetCodeGen()->MakeFreshIdentifier("col_groups")),
       pg_statistic_index_pr_(GetCodeGen()->MakeFreshIdentifier("pg_statistic_index_pr")),
       pg_statistic_update_pr_(GetCodeGen()->MakeFreshIdentifier("pg_statistic_update_pr")) {
   // Analyze is serial
@@ -41,9 +43,22 @@ AnalyzeTranslator::AnalyzeTranslator(const planner::AnalyzePlanNode &plan, Compi
   compilation_context->Prepare(*plan.GetChild(0), pipeline);
   auto *codegen = GetCodeGen();
 
+  // Large tables are only sampled. The aggregation below is already serial because of COUNT(DISTINCT col), so the scan
+  // is serial too.
+  const auto &aggregate = *plan.GetChild(0);
+  const uint32_t sample_blocks = compilation_context->GetAnalyzeSampleBlocks();
+  auto *scan = aggregate.GetChildrenSize() == 1
+                   ? dynamic_cast<SeqScanTranslator *>(compilation_context->LookupTranslator(*aggregate.GetChild(0)))
+                   : nullptr;
+  if (sample_blocks != 0 && scan != nullptr) {
+    scan->SampleBlocks(sample_blocks);
+    sampled_ = true;
+  }
+
   pg_statistic_column_lookup_[catalog::postgres::PgStatistic::STARELID.oid_] = table_oid_;
   pg_statistic_column_lookup_[catalog::postgres::PgStatistic::STAATTNUM.oid_] = col_oid_;
   pg_statistic_column_lookup_[catalog::postgres::PgStatistic::STA_NUMROWS.oid_] = num_rows_;
+  pg_statistic_column_lookup_[catalog::postgres::PgStatistic::STA_COLGROUPS.oid_] = col_groups_;
 
   for (const auto &col_info : catalog::postgres::PgStatisticImpl::ANALYZE_AGGREGATES) {
     auto agg_var = codegen->MakeFreshIdentifier("stat_col_" + std::to_string(col_info.column_oid_.UnderlyingValue()));
@@ -171,7 +186,12 @@ void AnalyzeTranslator::InitPgStatisticVariables(WorkContext *context, FunctionB
   function->Append(codegen->DeclareVarNoInit(col_oid_, ast::BuiltinType::Kind::Integer));
   // The first aggregate is COUNT(*)
   // var num_rows = @aggResult(queryState.execCtx, &aggRow.agg_term_attr0)
-  function->Append(codegen->DeclareVarWithInit(num_rows_, GetChildOutput(context, 0, 0)));
+  ast::Expr *num_rows = GetChildOutput(context, 0, 0);
+  if (sampled_) {
+    // var num_rows = @execCtxScaleSampledCount(execCtx, @aggResult(...))
+    num_rows = codegen->ExecCtxScaleSampledCount(GetExecutionContext(), num_rows);
+  }
+  function->Append(codegen->DeclareVarWithInit(num_rows_, num_rows));
 
   // var agg_col: type
   for (size_t i = 0; i < catalog::postgres::PgStatisticImpl::NUM_ANALYZE_AGGREGATES; i++) {
@@ -179,6 +199,8 @@ void AnalyzeTranslator::InitPgStatisticVariables(WorkContext *context, FunctionB
     auto type = sql::GetTypeId(pg_statistic_table_schema_.GetColumn(col_info.column_oid_).Type());
     function->Append(codegen->DeclareVarNoInit(aggregate_variables_[i], codegen->TplType(type)));
   }
+  // var col_groups: StringVal
+  function->Append(codegen->DeclareVarNoInit(col_groups_, ast::BuiltinType::Kind::StringVal));
 }
 
 void AnalyzeTranslator::DeclarePgStatisticIndexPR(FunctionBuilder *function) const {
@@ -197,15 +219,32 @@ void AnalyzeTranslator::AssignColumnStatistics(WorkContext *context, FunctionBui
   auto col_oid = plan.GetColumnOids().at(column_offset).UnderlyingValue();
   function->Append(codegen->Assign(codegen->MakeExpr(col_oid_), codegen->IntToSql(col_oid)));
 
+  // Offset into the row of aggregates of the first aggregate of the column, COUNT(col)
+  const size_t first_agg_offset = (column_offset * catalog::postgres::PgStatisticImpl::NUM_ANALYZE_AGGREGATES) + 1;
   for (size_t i = 0; i < catalog::postgres::PgStatisticImpl::NUM_ANALYZE_AGGREGATES; i++) {
     // Offset into the row of aggregates
-    size_t agg_offset = (column_offset * catalog::postgres::PgStatisticImpl::NUM_ANALYZE_AGGREGATES) + i + 1;
+    size_t agg_offset = first_agg_offset + i;
     auto agg_var = aggregate_variables_.at(i);
     auto *lhs = codegen->MakeExpr(agg_var);
     auto *rhs = GetChildOutput(context, 0, agg_offset);
+    // The sketches only describe the distribution of the values, so they are kept as computed over the sample
+    const auto stat_col_oid = catalog::postgres::PgStatisticImpl::ANALYZE_AGGREGATES.at(i).column_oid_;
+    if (sampled_ && stat_col_oid == catalog::postgres::PgStatistic::STA_NONNULLROWS.oid_) {
+      // agg_var = @execCtxScaleSampledCount(queryState.execCtx, @aggResult(...))
+      rhs = codegen->ExecCtxScaleSampledCount(GetExecutionContext(), rhs);
+    } else if (sampled_ && stat_col_oid == catalog::postgres::PgStatistic::STA_DISTINCTROWS.oid_) {
+      // agg_var = @execCtxScaleSampledDistinct(queryState.execCtx, @aggResult(...), @aggResult(<COUNT(col)>))
+      rhs = codegen->ExecCtxScaleSampledDistinct(GetExecutionContext(), rhs,
+                                                 GetChildOutput(context, 0, first_agg_offset));
+    }
     // agg_var = @aggResult(queryState.execCtx, &aggRow.agg_term_attr<agg_offset>)
     function->Append(codegen->Assign(lhs, rhs));
   }
+
+  // col_groups = @execCtxAnalyzeColumnGroups(queryState.execCtx, <table_oid>, <col_oid>)
+  auto *col_groups = codegen->ExecCtxAnalyzeColumnGroups(GetExecutionContext(), plan.GetTableOid(),
+                                                         plan.GetColumnOids().at(column_offset));
+  function->Append(codegen->Assign(codegen->MakeExpr(col_groups_), col_groups));
 }
 
 void AnalyzeTranslator::InitPgStatisticIterator(FunctionBuilder *function) const {
@@ -16,7 +16,8 @@ DeleteTranslator::DeleteTranslator(const planner::DeletePlanNode &plan, Compilat
                                    Pipeline *pipeline)
     : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::DELETE),
       col_oids_(GetCodeGen()->MakeFreshIdentifier("col_oids")) {
-  pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
+  // Every worker deletes through a storage interface of its own, @see transaction::TransactionContext::WorkerScope
+  pipeline->RegisterSource(this, Pipeline::Parallelism::Parallel);
   // Prepare the child.
   compilation_context->Prepare(*plan.GetChild(0), pipeline);
 
@@ -26,6 +27,7 @@ DeleteTranslator::DeleteTranslator(const planner::DeletePlanNode &plan, Compilat
     for (const auto &index_col : index_schema.GetColumns()) {
       compilation_context->Prepare(*index_col.StoredExpression());
     }
+    if (index_schema.Predicate() != nullptr) compilation_context->Prepare(*index_schema.Predicate());
   }
 
   num_deletes_ = CounterDeclare("num_deletes", pipeline);
@@ -46,8 +48,16 @@ void DeleteTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder
   // Delete from every index
   const auto &op = GetPlanAs<planner::DeletePlanNode>();
   const auto &indexes = op.GetIndexOids();
+  const auto &child = GetCompilationContext()->LookupTranslator(*op.GetChild(0));
   for (const auto &index_oid : indexes) {
-    GenIndexDelete(function, context, index_oid);
+    const auto predicate = GetCodeGen()->GetCatalogAccessor()->GetIndexSchema(index_oid).Predicate();
+    if (predicate != nullptr) {
+      // A partial index only has entries for the tuples that satisfy its predicate
+      If satisfies_predicate(function, context->DeriveValue(*predicate, child));
+      GenIndexDelete(function, context, index_oid);
+    } else {
+      GenIndexDelete(function, context, index_oid);
+    }
   }
 }
 
@@ -56,6 +66,8 @@ void DeleteTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionB
 }
 
 void DeleteTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+  // The counters of a parallel pipeline are spread over the thread states of its workers
+  if (pipeline.IsParallel()) return;
   FeatureRecord(function, selfdriving::ExecutionOperatingUnitType::DELETE,
                 selfdriving::ExecutionOperatingUnitFeatureAttribute::NUM_ROWS, pipeline, CounterVal(num_deletes_));
   FeatureRecord(function, selfdriving::ExecutionOperatingUnitType::DELETE,
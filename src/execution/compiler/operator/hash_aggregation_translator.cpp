@@ -1,5 +1,7 @@
 #include "execution/compiler/operator/hash_aggregation_translator.h"
 
+#include <vector>
+
 #include "execution/compiler/codegen.h"
 #include "execution/compiler/compilation_context.h"
 #include "execution/compiler/function_builder.h"
@@ -66,6 +68,27 @@ HashAggregationTranslator::HashAggregationTranslator(const planner::AggregatePla
     compilation_context->Prepare(*having_clause);
   }
 
+  // If the statistics show that the single integer grouping key spans only a
+  // few values, index the groups by the key directly.
+  if (plan.HasGroupByKeyRange() && plan.GetGroupByTerms().size() == 1) {
+    switch (plan.GetGroupByTerms()[0]->GetReturnValueType()) {
+      case type::TypeId::TINYINT:
+      case type::TypeId::SMALLINT:
+      case type::TypeId::INTEGER:
+      case type::TypeId::BIGINT: {
+        const auto min_key = plan.GetGroupByKeyMin(), max_key = plan.GetGroupByKeyMax();
+        const auto span = static_cast<uint64_t>(max_key) - static_cast<uint64_t>(min_key);
+        if (min_key <= max_key && span < sql::AggregationHashTable::MAX_DENSE_DOMAIN_SIZE) {
+          dense_min_key_ = min_key;
+          num_dense_keys_ = span + 1;
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
   // Declare the global hash table.
   auto *codegen = GetCodeGen();
   ast::Expr *agg_ht_type = codegen->BuiltinType(ast::BuiltinType::AggregationHashTable);
@@ -275,6 +298,9 @@ void HashAggregationTranslator::DefineHelperFunctions(util::RegionVector<ast::Fu
 
 void HashAggregationTranslator::InitializeAggregationHashTable(FunctionBuilder *function, ast::Expr *agg_ht) const {
   function->Append(GetCodeGen()->AggHashTableInit(agg_ht, GetExecutionContext(), agg_payload_type_));
+  if (IsDense()) {
+    function->Append(GetCodeGen()->AggHashTableSetDenseDomain(agg_ht, dense_min_key_, num_dense_keys_));
+  }
 }
 
 void HashAggregationTranslator::TearDownAggregationHashTable(FunctionBuilder *function, ast::Expr *agg_ht) const {
@@ -461,6 +487,10 @@ ast::Expr *HashAggregationTranslator::GetGroupByTerm(ast::Identifier agg_row, ui
   return codegen->AccessStructMember(codegen->MakeExpr(agg_row), member);
 }
 
+ast::Expr *HashAggregationTranslator::GetGroupByTermPtr(ast::Identifier agg_row, uint32_t attr_idx) const {
+  return GetCodeGen()->AddressOf(GetGroupByTerm(agg_row, attr_idx));
+}
+
 ast::Expr *HashAggregationTranslator::GetAggregateTerm(ast::Identifier agg_row, uint32_t attr_idx) const {
   auto *codegen = GetCodeGen();
   auto member = codegen->MakeIdentifier(AGGREGATE_TERM_ATTR_PREFIX + std::to_string(attr_idx));
@@ -523,6 +553,31 @@ ast::Identifier HashAggregationTranslator::PerformLookup(FunctionBuilder *functi
   return agg_payload;
 }
 
+ast::Identifier HashAggregationTranslator::PerformDenseLookup(FunctionBuilder *function, ast::Expr *agg_ht,
+                                                              ast::Identifier agg_values) const {
+  auto *codegen = GetCodeGen();
+  // var aggPayload = @ptrCast(*AggPayload, @aggHTLookupDense(agg_ht, aggValues.key))
+  auto lookup_call = codegen->AggHashTableLookupDense(agg_ht, GetGroupByTerm(agg_values, 0), agg_payload_type_);
+  auto agg_payload = codegen->MakeFreshIdentifier("aggPayload");
+  function->Append(codegen->DeclareVarWithInit(agg_payload, lookup_call));
+
+  // Keys outside the domain of the statistics, or NULL, and keys whose groups
+  // are new, go through the hash table. New groups are indexed after that.
+  If check_dense_miss(function, codegen->IsNilPointer(codegen->MakeExpr(agg_payload)));
+  auto hash_val = HashInputKeys(function, agg_values);
+  auto hash_lookup_call = codegen->AggHashTableLookup(agg_ht, codegen->MakeExpr(hash_val), key_check_fn_,
+                                                      codegen->AddressOf(codegen->MakeExpr(agg_values)),
+                                                      agg_payload_type_);
+  function->Append(codegen->Assign(codegen->MakeExpr(agg_payload), hash_lookup_call));
+  If check_new_agg(function, codegen->IsNilPointer(codegen->MakeExpr(agg_payload)));
+  ConstructNewAggregate(function, agg_ht, agg_payload, agg_values, hash_val);
+  function->Append(
+      codegen->AggHashTableInsertDense(agg_ht, GetGroupByTerm(agg_values, 0), codegen->MakeExpr(agg_payload)));
+  check_new_agg.EndIf();
+  check_dense_miss.EndIf();
+  return agg_payload;
+}
+
 void HashAggregationTranslator::ConstructNewAggregate(FunctionBuilder *function, ast::Expr *agg_ht,
                                                       ast::Identifier agg_payload, ast::Identifier agg_values,
                                                       ast::Identifier hash_val) const {
@@ -533,11 +588,16 @@ void HashAggregationTranslator::ConstructNewAggregate(FunctionBuilder *function,
   auto insert_call = codegen->AggHashTableInsert(agg_ht, codegen->MakeExpr(hash_val), partitioned, agg_payload_type_);
   function->Append(codegen->Assign(codegen->MakeExpr(agg_payload), insert_call));
 
-  // Copy the grouping keys.
-  for (uint32_t term_idx = 0; term_idx < GetAggPlan().GetGroupByTerms().size(); term_idx++) {
+  // Copy the grouping keys. String keys that are not inlined are copied into the hash table, so
+  // that they neither point into the input nor into memory that lives as long as the query.
+  const auto &group_by_terms = GetAggPlan().GetGroupByTerms();
+  for (uint32_t term_idx = 0; term_idx < group_by_terms.size(); term_idx++) {
     auto lhs = GetGroupByTerm(agg_payload, term_idx);
     auto rhs = GetGroupByTerm(agg_values, term_idx);
     function->Append(codegen->Assign(lhs, rhs));
+    if (group_by_terms[term_idx]->GetReturnValueType() == type::TypeId::VARCHAR) {
+      function->Append(codegen->AggHashTableInternString(agg_ht, GetGroupByTermPtr(agg_payload, term_idx)));
+    }
   }
 
   // Initialize all aggregate terms.
@@ -579,17 +639,29 @@ void HashAggregationTranslator::UpdateAggregates(WorkContext *context, FunctionB
                                                  ast::Expr *agg_ht) const {
   auto *codegen = GetCodeGen();
 
+  // Aggregates over the same expressions compute them once
+  std::vector<const parser::AbstractExpression *> input_exprs;
+  for (const auto &term : GetAggPlan().GetGroupByTerms()) input_exprs.push_back(term.Get());
+  for (const auto &term : GetAggPlan().GetAggregateTerms()) input_exprs.push_back(term->GetChild(0).Get());
+  context->DeriveCommonSubexpressions(input_exprs, this, function);
+
   auto agg_values = FillInputValues(function, context);
-  auto hash_val = HashInputKeys(function, agg_values);
-  auto agg_payload = PerformLookup(function, agg_ht, hash_val, agg_values);
+  ast::Identifier agg_payload;
+  if (IsDense()) {
+    agg_payload = PerformDenseLookup(function, agg_ht, agg_values);
+  } else {
+    auto hash_val = HashInputKeys(function, agg_values);
+    agg_payload = PerformLookup(function, agg_ht, hash_val, agg_values);
 
-  If check_new_agg(function, codegen->IsNilPointer(codegen->MakeExpr(agg_payload)));
-  ConstructNewAggregate(function, agg_ht, agg_payload, agg_values, hash_val);
-  check_new_agg.EndIf();
+    If check_new_agg(function, codegen->IsNilPointer(codegen->MakeExpr(agg_payload)));
+    ConstructNewAggregate(function, agg_ht, agg_payload, agg_values, hash_val);
+    check_new_agg.EndIf();
+  }
 
   // Advance aggregate.
   AdvanceAggregate(context, function, agg_payload, agg_values);
   CounterAdd(function, num_agg_inputs_, 1);
+  context->ClearCommonSubexpressions();
 }
 
 void HashAggregationTranslator::ScanAggregationHashTable(WorkContext *context, FunctionBuilder *function,
@@ -699,6 +771,16 @@ ast::Expr *HashAggregationTranslator::GetChildOutput(WorkContext *context, uint3
   return OperatorTranslator::GetChildOutput(context, child_idx, attr_idx);
 }
 
+void HashAggregationTranslator::CollectChildPipelineExpressions(
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> *exprs) const {
+  for (const auto &term : GetAggPlan().GetGroupByTerms()) {
+    exprs->push_back(term);
+  }
+  for (const auto &term : GetAggPlan().GetAggregateTerms()) {
+    exprs->push_back(term->GetChild(0));
+  }
+}
+
 util::RegionVector<ast::FieldDecl *> HashAggregationTranslator::GetWorkerParams() const {
   NOISEPAGE_ASSERT(build_pipeline_.IsParallel(), "Should not issue parallel scan if pipeline isn't parallelized.");
   auto *codegen = GetCodeGen();
@@ -5,6 +5,7 @@
 #include "execution/compiler/function_builder.h"
 #include "execution/compiler/if.h"
 #include "execution/compiler/loop.h"
+#include "execution/compiler/operator/seq_scan_translator.h"
 #include "execution/compiler/work_context.h"
 #include "execution/sql/join_hash_table.h"
 #include "planner/plannodes/hash_join_plan_node.h"
@@ -21,12 +22,16 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlanNode &plan, Co
     // The ExecutionOperatingUnitType depends on whether it is the build pipeline or probe pipeline.
     : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::DUMMY),
       join_consumer_flag_(false),
+      spilled_probe_flag_(false),
+      use_runtime_filter_(false),
       build_row_var_(GetCodeGen()->MakeFreshIdentifier("buildRow")),
       build_row_type_(GetCodeGen()->MakeFreshIdentifier("BuildRow")),
       build_mark_(GetCodeGen()->MakeFreshIdentifier("buildMark")),
+      probe_mark_(GetCodeGen()->MakeFreshIdentifier("probeMark")),
       probe_row_var_(GetCodeGen()->MakeFreshIdentifier("probeRow")),
       probe_row_type_(GetCodeGen()->MakeFreshIdentifier("ProbeRow")),
       join_consumer_(GetCodeGen()->MakeFreshIdentifier("joinConsumer")),
+      spilled_probe_(GetCodeGen()->MakeFreshIdentifier("spilledProbe")),
       left_pipeline_(this, Pipeline::Parallelism::Parallel) {
   NOISEPAGE_ASSERT(!plan.GetLeftHashKeys().empty(), "Hash-join must have join keys from left input");
   NOISEPAGE_ASSERT(!plan.GetRightHashKeys().empty(), "Hash-join must have join keys from right input");
@@ -56,6 +61,22 @@ HashJoinTranslator::HashJoinTranslator(const planner::HashJoinPlanNode &plan, Co
     local_join_ht_ = left_pipeline_.DeclarePipelineStateEntry("joinHashTable", join_ht_type);
   }
 
+  if (plan.GetLogicalJoinType() == planner::LogicalJoinType::RIGHT_MARK) {
+    build_has_null_key_ =
+        compilation_context->GetQueryState()->DeclareStateEntry(codegen, "buildHasNullKey", codegen->BoolType());
+  }
+
+  // Probe tuples without a build partner produce nothing, so a scan on the probe
+  // side can discard the ones the bloom filter over the build side rules out.
+  auto *probe_scan = dynamic_cast<SeqScanTranslator *>(compilation_context->LookupTranslator(*plan.GetChild(1)));
+  if (CanUseRuntimeFilter() && probe_scan != nullptr) {
+    use_runtime_filter_ = true;
+    probe_scan->RegisterRuntimeFilter([this](WorkContext *ctx, FunctionBuilder *function) {
+      auto hash_val = HashKeys(ctx, function, GetPlanAs<planner::HashJoinPlanNode>().GetRightHashKeys());
+      return GetCodeGen()->JoinHashTableMayContain(global_join_ht_.GetPtr(GetCodeGen()), hash_val);
+    });
+  }
+
   num_build_rows_ = CounterDeclare("num_build_rows", &left_pipeline_);
   num_probe_rows_ = CounterDeclare("num_probe_rows", pipeline);
   num_match_rows_ = CounterDeclare("num_match_rows", pipeline);
@@ -81,8 +102,8 @@ void HashJoinTranslator::DefineHelperStructs(util::RegionVector<ast::StructDecl
   struct_decl_ = struct_decl;
   decls->push_back(struct_decl);
 
-  /* Probe row declaration - only for left outer joins */
-  if (GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::LEFT) {
+  /* Probe row declaration - only for left outer joins and joins that can spill */
+  if (GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::LEFT || CanSpill()) {
     // TODO(abalakum): support mini-runners for this struct as well
     fields = codegen->MakeEmptyFieldList();
     GetAllChildOutputFields(1, row_attr_prefix, &fields);
@@ -112,6 +133,23 @@ void HashJoinTranslator::DefineHelperFunctions(util::RegionVector<ast::FunctionD
     join_consumer_flag_ = false;
     decls->push_back(function.Finish());
   }
+
+  if (CanSpill()) {
+    // Probe with a spilled probe row, just like the pipeline probes with its
+    // input rows.
+    auto cc = GetCompilationContext();
+    auto *pipeline = GetPipeline();
+    WorkContext ctx(cc, *pipeline);
+    ctx.SetSource(this);
+    auto *codegen = GetCodeGen();
+    util::RegionVector<ast::FieldDecl *> params = pipeline->PipelineParams();
+    params.push_back(codegen->MakeField(probe_row_var_, codegen->PointerType(probe_row_type_)));
+    spilled_probe_flag_ = true;
+    FunctionBuilder function(codegen, spilled_probe_, std::move(params), codegen->Nil());
+    { ProbeJoinHashTable(&ctx, &function); }
+    spilled_probe_flag_ = false;
+    decls->push_back(function.Finish());
+  }
 }
 
 ast::FunctionDecl *HashJoinTranslator::GenerateStartHookFunction() const {
@@ -158,6 +196,16 @@ void HashJoinTranslator::DefineTLSDependentHelperFunctions(const Pipeline &pipel
   }
 }
 
+bool HashJoinTranslator::CanSpill() const {
+  return GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::INNER;
+}
+
+bool HashJoinTranslator::CanUseRuntimeFilter() const {
+  const auto join_type = GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType();
+  return join_type == planner::LogicalJoinType::INNER || join_type == planner::LogicalJoinType::LEFT_SEMI ||
+         join_type == planner::LogicalJoinType::RIGHT_SEMI;
+}
+
 void HashJoinTranslator::InitializeJoinHashTable(FunctionBuilder *function, ast::Expr *jht_ptr) const {
   function->Append(GetCodeGen()->JoinHashTableInit(jht_ptr, GetExecutionContext(), build_row_type_));
 }
@@ -169,6 +217,17 @@ void HashJoinTranslator::TearDownJoinHashTable(FunctionBuilder *function, ast::E
 void HashJoinTranslator::InitializeQueryState(FunctionBuilder *function) const {
   auto *codegen = GetCodeGen();
   InitializeJoinHashTable(function, global_join_ht_.GetPtr(codegen));
+  if (CanSpill()) {
+    function->Append(codegen->JoinHashTableEnableSpilling(global_join_ht_.GetPtr(codegen), probe_row_type_));
+  }
+  if (use_runtime_filter_) {
+    function->Append(codegen->JoinHashTableEnableRuntimeFilter(global_join_ht_.GetPtr(codegen)));
+  }
+  // The table is only ever probed one tuple at a time, which the compact layout supports
+  function->Append(codegen->JoinHashTableEnableCompactLayout(global_join_ht_.GetPtr(codegen)));
+  if (GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::RIGHT_MARK) {
+    function->Append(codegen->Assign(build_has_null_key_.Get(codegen), codegen->ConstBool(false)));
+  }
 }
 
 void HashJoinTranslator::TearDownQueryState(FunctionBuilder *function) const {
@@ -284,6 +343,14 @@ void HashJoinTranslator::InsertIntoJoinHashTable(WorkContext *ctx, FunctionBuild
   // Fill row.
   FillBuildRow(ctx, function, codegen->MakeExpr(build_row_var_));
 
+  // Mark joins remember whether a build key is NULL, since that makes the mark of unmatched probe tuples NULL.
+  // if (@isValNull(key0) or ...) { buildHasNullKey = true }
+  if (GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::RIGHT_MARK) {
+    If check_null_key(function, AnyKeyIsNull(ctx, GetPlanAs<planner::HashJoinPlanNode>().GetLeftHashKeys()));
+    function->Append(codegen->Assign(build_has_null_key_.Get(codegen), codegen->ConstBool(true)));
+    check_null_key.EndIf();
+  }
+
   CounterAdd(function, num_build_rows_, 1);
 }
 
@@ -307,7 +374,10 @@ void HashJoinTranslator::ProbeJoinHashTable(WorkContext *ctx, FunctionBuilder *f
       codegen->MakeStmt(codegen->JoinHashTableLookup(global_join_ht_.GetPtr(codegen), entry_iter, hash_val));
   auto has_next_call = codegen->HTEntryIterHasNext(entry_iter);
 
-  CounterAdd(function, num_probe_rows_, 1);
+  // Spilled probe rows were counted when they were spilled
+  if (!spilled_probe_flag_) {
+    CounterAdd(function, num_probe_rows_, 1);
+  }
 
   // The probe depends on the join type
   if (join_plan.RequiresRightMark()) {
@@ -344,7 +414,28 @@ void HashJoinTranslator::ProbeJoinHashTable(WorkContext *ctx, FunctionBuilder *f
       ctx->Push(function);
       CounterAdd(function, num_match_rows_, 1);
       right_semi_check.EndIf();
+    } else if (join_plan.GetLogicalJoinType() == planner::LogicalJoinType::RIGHT_MARK) {
+      // Every probe tuple is pushed along with its mark.
+      ComputeMark(ctx, function, right_mark_var);
+      ctx->Push(function);
+      CounterAdd(function, num_match_rows_, 1);
+    }
+  } else if (CanSpill() && !spilled_probe_flag_) {
+    // if (@joinHTIsSpilled(...)) { spill } else { while (has_next) }
+    If check_spilled(function, codegen->JoinHashTableIsSpilled(global_join_ht_.GetPtr(codegen), hash_val));
+    SpillProbeRow(ctx, function, hash_val);
+    check_spilled.Else();
+    {
+      Loop entry_loop(function, lookup_call, has_next_call, nullptr);
+      {
+        // var buildRow = @ptrCast(*BuildRow, @htEntryIterGetRow())
+        function->Append(
+            codegen->DeclareVarWithInit(build_row_var_, codegen->HTEntryIterGetRow(entry_iter, build_row_type_)));
+        CheckJoinPredicate(ctx, function);
+      }
+      entry_loop.EndLoop();
     }
+    check_spilled.EndIf();
   } else {
     // For regular joins: while (has_next)
     Loop entry_loop(function, lookup_call, has_next_call, nullptr);
@@ -358,6 +449,17 @@ void HashJoinTranslator::ProbeJoinHashTable(WorkContext *ctx, FunctionBuilder *f
   }
 }
 
+void HashJoinTranslator::SpillProbeRow(WorkContext *ctx, FunctionBuilder *function, ast::Expr *hash_val) const {
+  auto *codegen = GetCodeGen();
+  // var probeRow : ProbeRow
+  function->Append(codegen->DeclareVarNoInit(probe_row_var_, codegen->MakeExpr(probe_row_type_)));
+  // Fill row.
+  FillProbeRow(ctx, function, codegen->MakeExpr(probe_row_var_));
+  // @joinHTSpillProbe(jht, hashVal, &probeRow)
+  auto probe_row = codegen->AddressOf(codegen->MakeExpr(probe_row_var_));
+  function->Append(codegen->JoinHashTableSpillProbe(global_join_ht_.GetPtr(codegen), hash_val, probe_row));
+}
+
 void HashJoinTranslator::CheckJoinPredicate(WorkContext *ctx, FunctionBuilder *function) const {
   const auto &join_plan = GetPlanAs<planner::HashJoinPlanNode>();
   auto *codegen = GetCodeGen();
@@ -419,6 +521,38 @@ void HashJoinTranslator::CheckRightMark(WorkContext *ctx, FunctionBuilder *funct
   check_condition.EndIf();
 }
 
+ast::Expr *HashJoinTranslator::AnyKeyIsNull(
+    WorkContext *ctx, const std::vector<common::ManagedPointer<parser::AbstractExpression>> &hash_keys) const {
+  auto *codegen = GetCodeGen();
+  ast::Expr *any_null = nullptr;
+  for (const auto hash_key : hash_keys) {
+    auto is_null = codegen->CallBuiltin(ast::Builtin::IsValNull, {ctx->DeriveValue(*hash_key, this)});
+    any_null = any_null == nullptr ? is_null : codegen->BinaryOp(parsing::Token::Type::OR, any_null, is_null);
+  }
+  return any_null;
+}
+
+void HashJoinTranslator::ComputeMark(WorkContext *ctx, FunctionBuilder *function, ast::Identifier right_mark) const {
+  auto *codegen = GetCodeGen();
+  const auto &join_plan = GetPlanAs<planner::HashJoinPlanNode>();
+
+  // The right mark is unset if the probe tuple found a join partner.
+  // var probeMark = @boolToSql(!rightMark)
+  auto found = codegen->UnaryOp(parsing::Token::Type::BANG, codegen->MakeExpr(right_mark));
+  function->Append(codegen->DeclareVarWithInit(probe_mark_, codegen->CallBuiltin(ast::Builtin::BoolToSql, {found})));
+
+  // Without a partner, the tuple may still be equal to a NULL build key, or its NULL key to any build key.
+  // if (rightMark and (buildHasNullKey or (@isValNull(key0) or ... and @joinHTGetTupleCount(jht) > 0)))
+  auto build_size = codegen->CallBuiltin(ast::Builtin::JoinHashTableGetTupleCount, {global_join_ht_.GetPtr(codegen)});
+  auto build_not_empty = codegen->Compare(parsing::Token::Type::GREATER, build_size, codegen->Const32(0));
+  auto null_probe_key =
+      codegen->BinaryOp(parsing::Token::Type::AND, AnyKeyIsNull(ctx, join_plan.GetRightHashKeys()), build_not_empty);
+  auto unknown = codegen->BinaryOp(parsing::Token::Type::OR, build_has_null_key_.Get(codegen), null_probe_key);
+  If check_unknown(function, codegen->BinaryOp(parsing::Token::Type::AND, codegen->MakeExpr(right_mark), unknown));
+  function->Append(codegen->Assign(codegen->MakeExpr(probe_mark_), codegen->ConstNull(type::TypeId::BOOLEAN)));
+  check_unknown.EndIf();
+}
+
 void HashJoinTranslator::CollectUnmatchedLeftRows(FunctionBuilder *function) const {
   auto *codegen = GetCodeGen();
 
@@ -512,11 +646,26 @@ void HashJoinTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBu
       function->Append(codegen->JoinHashTableBuild(jht));
       RecordCounters(pipeline, function);
     }
+
+    // Compare the size of the build side against its estimate, so the query can be re-optimized if it is far off.
+    // @execCtxCheckCardinality(execCtx, buildPlanNodeId, @joinHTGetTupleCount(jht))
+    auto build_plan_node_id = GetPlan().GetChild(0)->GetPlanNodeId().UnderlyingValue();
+    auto build_size = codegen->CallBuiltin(ast::Builtin::JoinHashTableGetTupleCount, {global_join_ht_.GetPtr(codegen)});
+    function->Append(codegen->MakeStmt(codegen->CallBuiltin(
+        ast::Builtin::ExecutionContextCheckCardinality,
+        {GetExecutionContext(), codegen->Const32(build_plan_node_id), build_size})));
   } else {
     if (GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::LEFT) {
       CollectUnmatchedLeftRows(function);
     }
 
+    if (CanSpill()) {
+      // @joinHTProcessSpilled(jht, queryState, pipelineState, spilledProbe)
+      function->Append(codegen->JoinHashTableProcessSpilled(global_join_ht_.GetPtr(codegen), GetQueryStatePtr(),
+                                                            codegen->MakeExpr(GetPipeline()->GetPipelineStateVar()),
+                                                            spilled_probe_));
+    }
+
     if (!pipeline.IsParallel()) {
       RecordCounters(pipeline, function);
     }
@@ -527,13 +676,19 @@ ast::Expr *HashJoinTranslator::GetChildOutput(WorkContext *context, uint32_t chi
   // If the request is in the probe pipeline and for an attribute in the left
   // child, we read it from the probe/materialized build row.
   //
-  // Otherwise if within the joinConsumer function we read from the ProbeRow and if not propagate
+  // Otherwise if within the joinConsumer or spilledProbe function we read from the ProbeRow and if not propagate
   // the request to the correct child
   if (IsRightPipeline(context->GetPipeline()) && child_idx == 0) {
     auto row = GetCodeGen()->MakeExpr(build_row_var_);
     return GetRowAttribute(row, attr_idx);
   }
-  if (IsRightPipeline(context->GetPipeline()) && child_idx == 1 && join_consumer_flag_) {
+  // The mark of a mark join follows the probe child's attributes.
+  if (IsRightPipeline(context->GetPipeline()) && child_idx == 1 &&
+      GetPlanAs<planner::HashJoinPlanNode>().GetLogicalJoinType() == planner::LogicalJoinType::RIGHT_MARK &&
+      attr_idx == GetPlan().GetChild(1)->GetOutputSchema()->GetColumns().size()) {
+    return GetCodeGen()->MakeExpr(probe_mark_);
+  }
+  if (IsRightPipeline(context->GetPipeline()) && child_idx == 1 && (join_consumer_flag_ || spilled_probe_flag_)) {
     auto row = GetCodeGen()->MakeExpr(probe_row_var_);
     return GetRowAttribute(row, attr_idx);
   }
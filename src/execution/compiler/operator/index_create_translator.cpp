@@ -1,5 +1,7 @@
 #include "execution/compiler/operator/index_create_translator.h"
 
+#include <algorithm>
+
 #include "catalog/catalog_accessor.h"
 #include "execution/ast/context.h"
 #include "execution/compiler/codegen.h"
@@ -11,7 +13,6 @@
 #include "execution/compiler/work_context.h"
 #include "execution/sql/ddl_executors.h"
 #include "execution/sql/table_vector_iterator.h"
-#include "parser/expression/column_value_expression.h"
 #include "parser/expression_util.h"
 #include "planner/plannodes/create_index_plan_node.h"
 #include "storage/index/index.h"
@@ -35,6 +36,7 @@ IndexCreateTranslator::IndexCreateTranslator(const planner::CreateIndexPlanNode
   for (const auto &index_col : index_schema.GetColumns()) {
     compilation_context->Prepare(*index_col.StoredExpression());
   }
+  if (index_schema.Predicate() != nullptr) compilation_context->Prepare(*index_schema.Predicate());
   pipeline->RegisterSource(this, Pipeline::Parallelism::Parallel);
 
   // col_oids is a global array
@@ -233,40 +235,39 @@ void IndexCreateTranslator::ScanVPI(WorkContext *ctx, FunctionBuilder *function,
       auto make_slot = codegen_->CallBuiltin(ast::Builtin::VPIGetSlot, {codegen_->MakeExpr(vpi_var_)});
       auto assign = codegen_->Assign(local_tuple_slot_.Get(codegen_), make_slot);
       function->Append(assign);
-      IndexInsert(ctx, function);
-      // We expect create index to be the end of a pipeline, so no need to push to parent
-      CounterAdd(function, num_inserts_, 1);
+      const auto predicate = codegen_->GetCatalogAccessor()->GetIndexSchema(index_oid_).Predicate();
+      if (predicate != nullptr) {
+        // A partial index only has entries for the tuples that satisfy its predicate
+        If satisfies_predicate(function, ctx->DeriveValue(*predicate, this));
+        IndexInsert(ctx, function);
+        CounterAdd(function, num_inserts_, 1);
+      } else {
+        IndexInsert(ctx, function);
+        // We expect create index to be the end of a pipeline, so no need to push to parent
+        CounterAdd(function, num_inserts_, 1);
+      }
     }
     vpi_loop.EndLoop();
   };
   gen_vpi_loop(false);
 }
 
+ast::Expr *IndexCreateTranslator::GetTableColumn(catalog::col_oid_t col_oid) const {
+  const auto &col = table_schema_.GetColumn(col_oid);
+  const auto scan_offset = std::find(all_oids_.cbegin(), all_oids_.cend(), col_oid) - all_oids_.cbegin();
+  return codegen_->VPIGet(codegen_->MakeExpr(vpi_var_), sql::GetTypeId(col.Type()), col.Nullable(),
+                          static_cast<uint32_t>(scan_offset));
+}
+
 void IndexCreateTranslator::IndexInsert(WorkContext *ctx, FunctionBuilder *function) const {
   const auto &index = codegen_->GetCatalogAccessor()->GetIndex(index_oid_);
   const auto &index_pm = index->GetKeyOidToOffsetMap();
   const auto &index_schema = codegen_->GetCatalogAccessor()->GetIndexSchema(index_oid_);
   auto *index_pr_expr = local_index_pr_.Get(codegen_);
 
-  std::unordered_map<catalog::col_oid_t, uint16_t> oid_offset;
-  for (uint16_t i = 0; i < all_oids_.size(); i++) {
-    oid_offset[all_oids_[i]] = i;
-  }
-
   for (const auto &index_col : index_schema.GetColumns()) {
-    auto stored_expr = index_col.StoredExpression();
-    NOISEPAGE_ASSERT(stored_expr->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE,
-                     "CREATE INDEX supported on base columns only");
-
-    // col_expr comes from the base table so we need to use TableSchema to get the correct scan_offset.
-    // col_expr = @VPIGet(vpi_var_, attr_sql_type, true, oid)
-    auto cve = stored_expr.CastManagedPointerTo<const parser::ColumnValueExpression>();
-    NOISEPAGE_ASSERT(cve->GetColumnOid() != catalog::INVALID_COLUMN_OID, "CREATE INDEX column oid not bound");
-    NOISEPAGE_ASSERT(oid_offset.find(cve->GetColumnOid()) != oid_offset.end(), "CREATE INDEX missing column scan");
-    auto &tbl_col = table_schema_.GetColumn(cve->GetColumnOid());
-    auto sql_type = sql::GetTypeId(tbl_col.Type());
-    auto scan_offset = oid_offset[cve->GetColumnOid()];
-    const auto &col_expr = codegen_->VPIGet(codegen_->MakeExpr(vpi_var_), sql_type, tbl_col.Nullable(), scan_offset);
+    // The key column's expression over the scanned tuple, which reads base columns with @VPIGet(vpi_var_, ...)
+    const auto &col_expr = ctx->DeriveValue(*index_col.StoredExpression(), this);
 
     // @prSet(insert_index_pr, attr_type, attr_idx, nullable, attr_index, col_expr, false)
     uint16_t attr_offset = index_pm.at(index_col.Oid());
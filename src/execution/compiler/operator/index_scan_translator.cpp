@@ -10,6 +10,7 @@
 #include "execution/compiler/loop.h"
 #include "execution/compiler/operator/operator_translator.h"
 #include "execution/compiler/work_context.h"
+#include "parser/expression/column_value_expression.h"
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "storage/index/index.h"
 #include "storage/sql_table.h"
@@ -24,13 +25,31 @@ IndexScanTranslator::IndexScanTranslator(const planner::IndexScanPlanNode &plan,
       table_pm_(GetCodeGen()->GetCatalogAccessor()->GetTable(plan.GetTableOid())->ProjectionMapForOids(input_oids_)),
       index_schema_(GetCodeGen()->GetCatalogAccessor()->GetIndexSchema(plan.GetIndexOid())),
       index_pm_(GetCodeGen()->GetCatalogAccessor()->GetIndex(plan.GetIndexOid())->GetKeyOidToOffsetMap()),
+      index_iter_var_(GetCodeGen()->MakeFreshIdentifier("indexIter")),
       col_oids_(GetCodeGen()->MakeFreshIdentifier("col_oids")),
       index_pr_(GetCodeGen()->MakeFreshIdentifier("index_pr")),
       lo_index_pr_(GetCodeGen()->MakeFreshIdentifier("lo_index_pr")),
       hi_index_pr_(GetCodeGen()->MakeFreshIdentifier("hi_index_pr")),
       table_pr_(GetCodeGen()->MakeFreshIdentifier("table_pr")),
       slot_(GetCodeGen()->MakeFreshIdentifier("slot")) {
-  pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
+  // Ranges are split between workers, which is only done when the rest of the plan neither needs the tuples in key
+  // order nor stops after a number of them
+  const auto scan_type = plan.GetScanType();
+  const bool ascending_range = scan_type == planner::IndexScanType::AscendingClosed ||
+                               scan_type == planner::IndexScanType::AscendingOpenHigh ||
+                               scan_type == planner::IndexScanType::AscendingOpenLow ||
+                               scan_type == planner::IndexScanType::AscendingOpenBoth;
+  const bool parallel = ascending_range && !plan.GetScanHasLimit() && !plan.IsOrdered();
+  pipeline->RegisterSource(this, parallel ? Pipeline::Parallelism::Parallel : Pipeline::Parallelism::Serial);
+  if (plan.IsIndexOnly()) {
+    // The optimizer only marks scans over base columns as index-only, so every key column names a table column
+    for (const auto &key_col : index_schema_.GetColumns()) {
+      auto cve = key_col.StoredExpression().CastManagedPointerTo<const parser::ColumnValueExpression>();
+      auto col_oid = cve->GetColumnOid();
+      if (col_oid == catalog::INVALID_COLUMN_OID) col_oid = table_schema_.GetColumn(cve->GetColumnName()).Oid();
+      key_cols_.emplace(col_oid, key_col.Oid());
+    }
+  }
   if (plan.GetScanPredicate() != nullptr) {
     compilation_context->Prepare(*plan.GetScanPredicate());
   }
@@ -68,32 +87,36 @@ void IndexScanTranslator::TearDownPipelineState(const Pipeline &pipeline, Functi
 
 void IndexScanTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const {
   const auto &op = GetPlanAs<planner::IndexScanPlanNode>();
-  // Either:
-  // (A) var index_pr = @indexIteratorGetPR(&index_iter)
-  // (B) var lo_index_pr = @indexIteratorGetLoPR(&index_iter)
-  //     var hi_index_pr = @indexIteratorGetHiPR(&index_iter)
-  DeclareIndexPR(function);
-  // The corresponding @prSet(pr, ...)
-  if (op.GetScanType() == planner::IndexScanType::Exact) {
-    FillKey(context, function, index_pr_, op.GetIndexColumns());
-  } else {
-    FillKey(context, function, lo_index_pr_, op.GetLoIndexColumns());
-    FillKey(context, function, hi_index_pr_, op.GetHiIndexColumns());
-  }
+  // A parallel scan hands each worker an iterator that already holds the tuples of its partition
+  ast::Stmt *loop_init = nullptr;
+  if (!IsPartitioned()) {
+    // Either:
+    // (A) var index_pr = @indexIteratorGetPR(&index_iter)
+    // (B) var lo_index_pr = @indexIteratorGetLoPR(&index_iter)
+    //     var hi_index_pr = @indexIteratorGetHiPR(&index_iter)
+    DeclareIndexPR(function);
+    // The corresponding @prSet(pr, ...)
+    if (op.GetScanType() == planner::IndexScanType::Exact) {
+      FillKey(context, function, index_pr_, op.GetIndexColumns());
+    } else {
+      FillKey(context, function, lo_index_pr_, op.GetLoIndexColumns());
+      FillKey(context, function, hi_index_pr_, op.GetHiIndexColumns());
+    }
 
-  // @indexIteratorScanKey(&pipelineState.indexIterator)
-  ast::Expr *scan_call =
-      GetCodeGen()->IndexIteratorScan(index_iter_.GetPtr(GetCodeGen()), op.GetScanType(), op.GetScanLimit());
-  ast::Stmt *loop_init = GetCodeGen()->MakeStmt(scan_call);
+    // @indexIteratorScanKey(&pipelineState.indexIterator)
+    ast::Expr *scan_call =
+        GetCodeGen()->IndexIteratorScan(index_iter_.GetPtr(GetCodeGen()), op.GetScanType(), op.GetScanLimit());
+    loop_init = GetCodeGen()->MakeStmt(scan_call);
+  }
   // @indexIteratorAdvance(&pipelineState.indexIterator)
-  ast::Expr *advance_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorAdvance, {index_iter_.GetPtr(GetCodeGen())});
+  ast::Expr *advance_call = GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorAdvance, {GetIterator()});
 
   // for (@indexIteratorScanKey(&index_iter); @indexIteratorAdvance(&index_iter);)
   Loop loop(function, loop_init, advance_call, nullptr);
   {
     // var table_pr = @indexIteratorGetTablePR(&pipelineState.indexIterator)
-    DeclareTablePR(function);
+    // Index-only scans read every column from the key instead.
+    if (!op.IsIndexOnly()) DeclareTablePR(function);
     // var slot = @indexIteratorGetSlot(&pipelineState.indexIterator)
     DeclareSlot(function);
 
@@ -113,6 +136,7 @@ void IndexScanTranslator::PerformPipelineWork(WorkContext *context, FunctionBuil
   }
   loop.EndLoop();
 
+  if (GetPipeline()->IsParallel()) return;
   FeatureRecord(function, selfdriving::ExecutionOperatingUnitType::IDX_SCAN,
                 selfdriving::ExecutionOperatingUnitFeatureAttribute::NUM_ROWS, context->GetPipeline(),
                 GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSize, {index_iter_.GetPtr(GetCodeGen())}));
@@ -122,10 +146,47 @@ void IndexScanTranslator::PerformPipelineWork(WorkContext *context, FunctionBuil
   FeatureArithmeticRecordSet(function, context->GetPipeline(), GetTranslatorId(), CounterVal(num_scans_index_));
 }
 
+util::RegionVector<ast::FieldDecl *> IndexScanTranslator::GetWorkerParams() const {
+  auto *codegen = GetCodeGen();
+  auto *index_iter_type = codegen->PointerType(ast::BuiltinType::IndexIterator);
+  return codegen->MakeFieldList({codegen->MakeField(index_iter_var_, index_iter_type)});
+}
+
+void IndexScanTranslator::LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const {
+  const auto &op = GetPlanAs<planner::IndexScanPlanNode>();
+  // The keys are set once in the iterator of the pipeline state, whose range is then split between the workers
+  WorkContext context(GetCompilationContext(), *GetPipeline());
+  DeclareIndexPR(function);
+  FillKey(&context, function, lo_index_pr_, op.GetLoIndexColumns());
+  FillKey(&context, function, hi_index_pr_, op.GetHiIndexColumns());
+  // @iterateIndexParallel(&pipelineState.indexIterator, scan_type, queryState, work_func)
+  function->Append(GetCodeGen()->MakeStmt(GetCodeGen()->IterateIndexParallel(
+      index_iter_.GetPtr(GetCodeGen()), op.GetScanType(), GetQueryStatePtr(), work_func_name)));
+}
+
+bool IndexScanTranslator::IsPartitioned() const {
+  // An index scan in the inner loop of a parallel nested loop join scans its whole range on every worker
+  return GetPipeline()->IsParallel() && GetPipeline()->IsDriver(this);
+}
+
+ast::Expr *IndexScanTranslator::GetIterator() const {
+  if (IsPartitioned()) {
+    // The worker function parameter
+    return GetCodeGen()->MakeExpr(index_iter_var_);
+  }
+  // &pipelineState.indexIterator
+  return index_iter_.GetPtr(GetCodeGen());
+}
+
 ast::Expr *IndexScanTranslator::GetTableColumn(catalog::col_oid_t col_oid) const {
-  // @prGet(table_pr, type, nullable, attr_idx)
   auto type = table_schema_.GetColumn(col_oid).Type();
   auto nullable = table_schema_.GetColumn(col_oid).Nullable();
+  if (GetPlanAs<planner::IndexScanPlanNode>().IsIndexOnly()) {
+    // @prGet(index_pr, type, nullable, attr_idx)
+    uint16_t attr_idx = index_pm_.at(key_cols_.at(col_oid));
+    return GetCodeGen()->PRGet(GetCodeGen()->MakeExpr(index_pr_), type, nullable, attr_idx);
+  }
+  // @prGet(table_pr, type, nullable, attr_idx)
   uint16_t attr_idx = table_pm_.find(col_oid)->second;
   return GetCodeGen()->PRGet(GetCodeGen()->MakeExpr(table_pr_), type, nullable, attr_idx);
 }
@@ -180,15 +241,13 @@ void IndexScanTranslator::DeclareIndexPR(noisepage::execution::compiler::Functio
 
 void IndexScanTranslator::DeclareTablePR(noisepage::execution::compiler::FunctionBuilder *builder) const {
   // var table_pr = @indexIteratorGetTablePR(&pipelineState.indexIterator)
-  ast::Expr *get_pr_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetTablePR, {index_iter_.GetPtr(GetCodeGen())});
+  ast::Expr *get_pr_call = GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetTablePR, {GetIterator()});
   builder->Append(GetCodeGen()->DeclareVar(table_pr_, nullptr, get_pr_call));
 }
 
 void IndexScanTranslator::DeclareSlot(noisepage::execution::compiler::FunctionBuilder *builder) const {
   // var slot = @indexIteratorGetSlot(&pipelineState.indexIterator)
-  ast::Expr *get_slot_call =
-      GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSlot, {index_iter_.GetPtr(GetCodeGen())});
+  ast::Expr *get_slot_call = GetCodeGen()->CallBuiltin(ast::Builtin::IndexIteratorGetSlot, {GetIterator()});
   builder->Append(GetCodeGen()->DeclareVar(slot_, nullptr, get_slot_call));
 }
 
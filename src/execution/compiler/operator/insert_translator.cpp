@@ -30,7 +30,10 @@ InsertTranslator::InsertTranslator(const planner::InsertPlanNode &plan, Compilat
                     ->GetCatalogAccessor()
                     ->GetTable(GetPlanAs<planner::InsertPlanNode>().GetTableOid())
                     ->ProjectionMapForOids(all_oids_)) {
-  pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
+  // The tuples of an INSERT ... SELECT are inserted by the workers of its child, each through a storage interface of
+  // its own, @see transaction::TransactionContext::WorkerScope. A list of values has no one to split the work with.
+  pipeline->RegisterSource(this, plan.GetInsertType() == parser::InsertType::SELECT ? Pipeline::Parallelism::Parallel
+                                                                                    : Pipeline::Parallelism::Serial);
 
   switch (plan.GetInsertType()) {
     case parser::InsertType::SELECT: {
@@ -58,6 +61,7 @@ InsertTranslator::InsertTranslator(const planner::InsertPlanNode &plan, Compilat
     for (const auto &index_col : index_schema.GetColumns()) {
       compilation_context->Prepare(*index_col.StoredExpression());
     }
+    if (index_schema.Predicate() != nullptr) compilation_context->Prepare(*index_schema.Predicate());
   }
 
   num_inserts_ = CounterDeclare("num_inserts", pipeline);
@@ -99,6 +103,8 @@ void InsertTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder
     }
   }
 
+  // The counters of a parallel pipeline are spread over the thread states of its workers
+  if (context->GetPipeline().IsParallel()) return;
   FeatureRecord(function, selfdriving::ExecutionOperatingUnitType::INSERT,
                 selfdriving::ExecutionOperatingUnitFeatureAttribute::NUM_ROWS, context->GetPipeline(),
                 CounterVal(num_inserts_));
@@ -124,7 +130,14 @@ void InsertTranslator::PerformInsertWork(
   function->Append(GetCodeGen()->ExecCtxAddRowsAffected(GetExecutionContext(), 1));
   const auto &index_oids = GetPlanAs<planner::InsertPlanNode>().GetIndexOids();
   for (const auto &index_oid : index_oids) {
-    GenIndexInsert(context, function, index_oid);
+    const auto predicate = GetCodeGen()->GetCatalogAccessor()->GetIndexSchema(index_oid).Predicate();
+    if (predicate != nullptr) {
+      // A partial index only has entries for the tuples that satisfy its predicate
+      If satisfies_predicate(function, context->DeriveValue(*predicate, this));
+      GenIndexInsert(context, function, index_oid);
+    } else {
+      GenIndexInsert(context, function, index_oid);
+    }
   }
 }
 
@@ -4,6 +4,7 @@
 #include "execution/compiler/compilation_context.h"
 #include "execution/compiler/function_builder.h"
 #include "execution/compiler/if.h"
+#include "execution/compiler/operator/seq_scan_translator.h"
 #include "execution/compiler/work_context.h"
 #include "planner/plannodes/limit_plan_node.h"
 
@@ -20,6 +21,18 @@ LimitTranslator::LimitTranslator(const planner::LimitPlanNode &plan, Compilation
   // Register state.
   auto *codegen = GetCodeGen();
   tuple_count_ = pipeline->DeclarePipelineStateEntry("numTuples", codegen->Int32Type());
+
+  // Tuples past the limit are discarded, so a scan feeding the limit stops reading the table once
+  // the limit has seen them all.
+  auto *scan = dynamic_cast<SeqScanTranslator *>(compilation_context->LookupTranslator(*plan.GetChild(0)));
+  if (plan.GetLimit() != 0 && scan != nullptr) {
+    scan->RegisterStopCondition([this]() {
+      // numTuples >= plan.offset + plan.limit
+      const auto &plan = GetPlanAs<planner::LimitPlanNode>();
+      return GetCodeGen()->Compare(parsing::Token::Type::GREATER_EQUAL, tuple_count_.Get(GetCodeGen()),
+                                   GetCodeGen()->Const32(plan.GetOffset() + plan.GetLimit()));
+    });
+  }
 }
 
 void LimitTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
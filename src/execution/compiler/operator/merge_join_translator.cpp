@@ -0,0 +1,346 @@
+#include "execution/compiler/operator/merge_join_translator.h"
+
+#include <string>
+
+#include "execution/compiler/compilation_context.h"
+#include "execution/compiler/function_builder.h"
+#include "execution/compiler/if.h"
+#include "execution/compiler/loop.h"
+#include "execution/compiler/work_context.h"
+#include "planner/plannodes/merge_join_plan_node.h"
+#include "planner/plannodes/output_schema.h"
+
+namespace noisepage::execution::compiler {
+
+namespace {
+constexpr const char LEFT_ROW_ATTR_PREFIX[] = "attr";
+constexpr const char PROBE_KEY_PREFIX[] = "key";
+}  // namespace
+
+MergeJoinTranslator::MergeJoinTranslator(const planner::MergeJoinPlanNode &plan,
+                                         CompilationContext *compilation_context, Pipeline *pipeline)
+    : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::DUMMY),
+      left_row_var_(GetCodeGen()->MakeFreshIdentifier("leftRow")),
+      left_row_type_(GetCodeGen()->MakeFreshIdentifier("LeftRow")),
+      lhs_row_(GetCodeGen()->MakeIdentifier("lhs")),
+      rhs_row_(GetCodeGen()->MakeIdentifier("rhs")),
+      probe_keys_var_(GetCodeGen()->MakeFreshIdentifier("probeKeys")),
+      probe_keys_type_(GetCodeGen()->MakeFreshIdentifier("ProbeKeys")),
+      compare_left_rows_func_(
+          GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("CompareLeftRows"))),
+      compare_probe_keys_func_(
+          GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("CompareProbeKeys"))),
+      left_pipeline_(this, Pipeline::Parallelism::Serial),
+      current_row_(CurrentRow::Child) {
+  NOISEPAGE_ASSERT(!plan.GetLeftMergeKeys().empty(), "Merge-join must have join keys from left input");
+  NOISEPAGE_ASSERT(plan.GetLeftMergeKeys().size() == plan.GetRightMergeKeys().size(),
+                   "Merge-join must have as many left as right join keys");
+  NOISEPAGE_ASSERT(plan.GetJoinPredicate() != nullptr, "Merge-join must have a join predicate!");
+  NOISEPAGE_ASSERT(plan.GetLogicalJoinType() == planner::LogicalJoinType::INNER, "Only inner merge-joins supported");
+
+  // The right rows must reach the merge in order, so the right pipeline is
+  // serial. Its merge begins after the left rows are sorted.
+  pipeline->UpdateParallelism(Pipeline::Parallelism::Serial);
+  pipeline->LinkSourcePipeline(&left_pipeline_);
+
+  // Register left and right child in their appropriate pipelines.
+  compilation_context->Prepare(*plan.GetChild(0), &left_pipeline_);
+  compilation_context->Prepare(*plan.GetChild(1), pipeline);
+
+  // Prepare join predicate, left, and right merge keys.
+  compilation_context->Prepare(*plan.GetJoinPredicate());
+  for (const auto left_merge_key : plan.GetLeftMergeKeys()) {
+    compilation_context->Prepare(*left_merge_key);
+  }
+  for (const auto right_merge_key : plan.GetRightMergeKeys()) {
+    compilation_context->Prepare(*right_merge_key);
+  }
+
+  // Register a Sorter instance in the global query state, and the cursor over
+  // its rows in the right pipeline's state.
+  auto *codegen = GetCodeGen();
+  ast::Expr *sorter_type = codegen->BuiltinType(ast::BuiltinType::Sorter);
+  global_sorter_ = compilation_context->GetQueryState()->DeclareStateEntry(codegen, "sorter", sorter_type);
+  left_iter_ = pipeline->DeclarePipelineStateEntry("leftIter", codegen->BuiltinType(ast::BuiltinType::SorterIterator));
+  left_pos_ = pipeline->DeclarePipelineStateEntry("leftPos", codegen->Int64Type());
+}
+
+void MergeJoinTranslator::DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) {
+  auto *codegen = GetCodeGen();
+
+  /* Left row declaration */
+  auto fields = codegen->MakeEmptyFieldList();
+  GetAllChildOutputFields(0, LEFT_ROW_ATTR_PREFIX, &fields);
+  decls->push_back(codegen->DeclareStruct(left_row_type_, std::move(fields)));
+
+  /* Probe keys declaration */
+  fields = codegen->MakeEmptyFieldList();
+  const auto &right_keys = GetPlanAs<planner::MergeJoinPlanNode>().GetRightMergeKeys();
+  for (uint32_t key_idx = 0; key_idx < right_keys.size(); key_idx++) {
+    auto name = codegen->MakeIdentifier(PROBE_KEY_PREFIX + std::to_string(key_idx));
+    auto type = codegen->TplType(sql::GetTypeId(right_keys[key_idx]->GetReturnValueType()));
+    fields.push_back(codegen->MakeField(name, type));
+  }
+  decls->push_back(codegen->DeclareStruct(probe_keys_type_, std::move(fields)));
+}
+
+void MergeJoinTranslator::GenerateComparisonFunction(FunctionBuilder *function, bool with_probe_keys) {
+  auto *codegen = GetCodeGen();
+  WorkContext context(GetCompilationContext(), left_pipeline_);
+  context.SetExpressionCacheEnable(false);
+
+  const auto &left_keys = GetPlanAs<planner::MergeJoinPlanNode>().GetLeftMergeKeys();
+  for (uint32_t key_idx = 0; key_idx < left_keys.size(); key_idx++) {
+    const auto lhs_key = [&]() {
+      current_row_ = CurrentRow::Lhs;
+      return context.DeriveValue(*left_keys[key_idx], this);
+    };
+    const auto rhs_key = [&]() {
+      if (with_probe_keys) return GetProbeKey(key_idx);
+      current_row_ = CurrentRow::Rhs;
+      return context.DeriveValue(*left_keys[key_idx], this);
+    };
+
+    // NULLs are larger than any value. Probe keys are never NULL.
+    If check_lhs_null(function, codegen->CallBuiltin(ast::Builtin::IsValNull, {lhs_key()}));
+    if (with_probe_keys) {
+      function->Append(codegen->Return(codegen->Const32(1)));
+    } else {
+      auto rhs_null = codegen->CallBuiltin(ast::Builtin::IsValNull, {rhs_key()});
+      If check_rhs_not_null(function, codegen->UnaryOp(parsing::Token::Type::BANG, rhs_null));
+      function->Append(codegen->Return(codegen->Const32(1)));
+      check_rhs_not_null.EndIf();
+
+      check_lhs_null.Else();
+      If check_rhs_null(function, codegen->CallBuiltin(ast::Builtin::IsValNull, {rhs_key()}));
+      function->Append(codegen->Return(codegen->Const32(-1)));
+      check_rhs_null.EndIf();
+    }
+    check_lhs_null.EndIf();
+
+    // Neither is NULL, or both are and the comparisons below are false.
+    int32_t ret_value = -1;
+    for (const auto tok : {parsing::Token::Type::LESS, parsing::Token::Type::GREATER}) {
+      If check_comparison(function, codegen->Compare(tok, lhs_key(), rhs_key()));
+      function->Append(codegen->Return(codegen->Const32(ret_value)));
+      check_comparison.EndIf();
+      ret_value = -ret_value;
+    }
+  }
+  current_row_ = CurrentRow::Child;
+}
+
+void MergeJoinTranslator::DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) {
+  auto *codegen = GetCodeGen();
+
+  // The sorter orders the left rows on the left keys.
+  auto params = codegen->MakeFieldList({
+      codegen->MakeField(lhs_row_, codegen->PointerType(left_row_type_)),
+      codegen->MakeField(rhs_row_, codegen->PointerType(left_row_type_)),
+  });
+  FunctionBuilder left_rows_builder(codegen, compare_left_rows_func_, std::move(params), codegen->Int32Type());
+  {
+    // Generate body.
+    GenerateComparisonFunction(&left_rows_builder, false);
+  }
+  decls->push_back(left_rows_builder.Finish(codegen->Const32(0)));
+
+  // The merge compares the left rows with the keys of the right row.
+  params = codegen->MakeFieldList({
+      codegen->MakeField(lhs_row_, codegen->PointerType(left_row_type_)),
+      codegen->MakeField(probe_keys_var_, codegen->PointerType(probe_keys_type_)),
+  });
+  FunctionBuilder probe_keys_builder(codegen, compare_probe_keys_func_, std::move(params), codegen->Int32Type());
+  {
+    // Generate body.
+    GenerateComparisonFunction(&probe_keys_builder, true);
+  }
+  decls->push_back(probe_keys_builder.Finish(codegen->Const32(0)));
+}
+
+void MergeJoinTranslator::InitializeQueryState(FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  function->Append(codegen->SorterInit(global_sorter_.GetPtr(codegen), GetExecutionContext(),
+                                       compare_left_rows_func_, left_row_type_));
+}
+
+void MergeJoinTranslator::TearDownQueryState(FunctionBuilder *function) const {
+  function->Append(GetCodeGen()->SorterFree(global_sorter_.GetPtr(GetCodeGen())));
+}
+
+void MergeJoinTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (IsRightPipeline(pipeline)) {
+    auto *codegen = GetCodeGen();
+    function->Append(codegen->SorterIterInit(left_iter_.GetPtr(codegen), global_sorter_.GetPtr(codegen)));
+    function->Append(codegen->Assign(left_pos_.Get(codegen), codegen->Const64(0)));
+  }
+}
+
+void MergeJoinTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (IsRightPipeline(pipeline)) {
+    function->Append(GetCodeGen()->SorterIterClose(left_iter_.GetPtr(GetCodeGen())));
+  }
+}
+
+ast::Expr *MergeJoinTranslator::GetLeftRowAttribute(ast::Identifier left_row, uint32_t attr_idx) const {
+  auto *codegen = GetCodeGen();
+  ast::Identifier attr_name = codegen->MakeIdentifier(LEFT_ROW_ATTR_PREFIX + std::to_string(attr_idx));
+  return codegen->AccessStructMember(codegen->MakeExpr(left_row), attr_name);
+}
+
+ast::Expr *MergeJoinTranslator::GetProbeKey(uint32_t key_idx) const {
+  auto *codegen = GetCodeGen();
+  ast::Identifier key_name = codegen->MakeIdentifier(PROBE_KEY_PREFIX + std::to_string(key_idx));
+  return codegen->AccessStructMember(codegen->MakeExpr(probe_keys_var_), key_name);
+}
+
+void MergeJoinTranslator::InsertIntoSorter(WorkContext *ctx, FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+
+  // var leftRow = @sorterInsert(...)
+  ast::Expr *insert_call = codegen->SorterInsert(global_sorter_.GetPtr(codegen), left_row_type_);
+  function->Append(codegen->DeclareVarWithInit(left_row_var_, insert_call));
+
+  // Fill row.
+  const auto child_schema = GetPlan().GetChild(0)->GetOutputSchema();
+  for (uint32_t attr_idx = 0; attr_idx < child_schema->GetColumns().size(); attr_idx++) {
+    ast::Expr *lhs = GetLeftRowAttribute(left_row_var_, attr_idx);
+    ast::Expr *rhs = GetChildOutput(ctx, 0, attr_idx);
+    function->Append(codegen->Assign(lhs, rhs));
+  }
+}
+
+void MergeJoinTranslator::MergeWithLeftRows(WorkContext *ctx, FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+
+  // var probeKeys: ProbeKeys
+  function->Append(codegen->DeclareVarNoInit(probe_keys_var_, codegen->MakeExpr(probe_keys_type_)));
+  ast::Expr *has_null_key = nullptr;
+  const auto &right_keys = GetPlanAs<planner::MergeJoinPlanNode>().GetRightMergeKeys();
+  for (uint32_t key_idx = 0; key_idx < right_keys.size(); key_idx++) {
+    function->Append(codegen->Assign(GetProbeKey(key_idx), ctx->DeriveValue(*right_keys[key_idx], this)));
+    auto is_null = codegen->CallBuiltin(ast::Builtin::IsValNull, {GetProbeKey(key_idx)});
+    has_null_key =
+        has_null_key == nullptr ? is_null : codegen->BinaryOp(parsing::Token::Type::OR, has_null_key, is_null);
+  }
+
+  // NULL keys equal nothing, so the row cannot find a join partner.
+  If check_keys(function, codegen->UnaryOp(parsing::Token::Type::BANG, has_null_key));
+  {
+    auto probe_keys = codegen->AddressOf(codegen->MakeExpr(probe_keys_var_));
+    auto left_iter = left_iter_.GetPtr(codegen);
+    auto advancing = codegen->MakeFreshIdentifier("advancing");
+    auto matched = codegen->MakeFreshIdentifier("matched");
+    function->Append(codegen->DeclareVarWithInit(advancing, codegen->ConstBool(true)));
+    function->Append(codegen->DeclareVarWithInit(matched, codegen->ConstBool(false)));
+
+    // Move the cursor past the left rows smaller than the probe keys. The right
+    // rows arrive in order, so those rows cannot join with any later row.
+    auto has_next = codegen->SorterIterHasNext(left_iter);
+    auto advance_cond = codegen->BinaryOp(parsing::Token::Type::AND, codegen->MakeExpr(advancing), has_next);
+    Loop advance_loop(function, advance_cond);
+    {
+      auto cmp = codegen->MakeFreshIdentifier("cmp");
+      auto left_row = codegen->SorterIterGetRow(left_iter_.GetPtr(codegen), left_row_type_);
+      auto compare_call = codegen->Call(compare_probe_keys_func_, {left_row, probe_keys});
+      function->Append(codegen->DeclareVarWithInit(cmp, compare_call));
+      If check_smaller(function, codegen->Compare(parsing::Token::Type::LESS, codegen->MakeExpr(cmp),
+                                                  codegen->Const32(0)));
+      {
+        function->Append(codegen->SorterIterNext(left_iter_.GetPtr(codegen)));
+        auto increment =
+            codegen->BinaryOp(parsing::Token::Type::PLUS, left_pos_.Get(codegen), codegen->Const64(1));
+        function->Append(codegen->Assign(left_pos_.Get(codegen), increment));
+      }
+      check_smaller.Else();
+      {
+        function->Append(codegen->Assign(codegen->MakeExpr(advancing), codegen->ConstBool(false)));
+        auto is_equal = codegen->Compare(parsing::Token::Type::EQUAL_EQUAL, codegen->MakeExpr(cmp),
+                                         codegen->Const32(0));
+        function->Append(codegen->Assign(codegen->MakeExpr(matched), is_equal));
+      }
+      check_smaller.EndIf();
+    }
+    advance_loop.EndLoop();
+
+    // Join with the run of left rows equal to the probe keys. It starts at the
+    // cursor, which stays there for the next right row with the same keys.
+    If check_matched(function, codegen->MakeExpr(matched));
+    {
+      // var matchIter = &matchIterBase
+      auto iter_base = codegen->MakeFreshIdentifier("matchIterBase");
+      auto iter_name = codegen->MakeFreshIdentifier("matchIter");
+      function->Append(codegen->DeclareVarNoInit(iter_base, ast::BuiltinType::SorterIterator));
+      function->Append(codegen->DeclareVarWithInit(iter_name, codegen->AddressOf(codegen->MakeExpr(iter_base))));
+      auto iter = codegen->MakeExpr(iter_name);
+      function->Append(codegen->SorterIterInit(iter, global_sorter_.GetPtr(codegen)));
+      function->Append(codegen->SorterIterSkipRows(iter, left_pos_.Get(codegen)));
+
+      auto match_cond =
+          codegen->BinaryOp(parsing::Token::Type::AND, codegen->MakeExpr(matched), codegen->SorterIterHasNext(iter));
+      Loop match_loop(function, nullptr, match_cond, codegen->MakeStmt(codegen->SorterIterNext(iter)));
+      {
+        // var leftRow = @ptrCast(*LeftRow, @sorterIterGetRow(matchIter))
+        function->Append(codegen->DeclareVarWithInit(left_row_var_, codegen->SorterIterGetRow(iter, left_row_type_)));
+        auto cmp = codegen->Call(compare_probe_keys_func_, {codegen->MakeExpr(left_row_var_), probe_keys});
+        If check_equal(function, codegen->Compare(parsing::Token::Type::EQUAL_EQUAL, cmp, codegen->Const32(0)));
+        CheckJoinPredicate(ctx, function);
+        check_equal.Else();
+        function->Append(codegen->Assign(codegen->MakeExpr(matched), codegen->ConstBool(false)));
+        check_equal.EndIf();
+      }
+      match_loop.EndLoop();
+
+      // Close iterator.
+      function->Append(codegen->SorterIterClose(iter));
+    }
+    check_matched.EndIf();
+  }
+  check_keys.EndIf();
+}
+
+void MergeJoinTranslator::CheckJoinPredicate(WorkContext *ctx, FunctionBuilder *function) const {
+  const auto &join_plan = GetPlanAs<planner::MergeJoinPlanNode>();
+  If check_condition(function, ctx->DeriveValue(*join_plan.GetJoinPredicate(), this));
+  {
+    // Just push forward
+    ctx->Push(function);
+  }
+  check_condition.EndIf();
+}
+
+void MergeJoinTranslator::PerformPipelineWork(WorkContext *ctx, FunctionBuilder *function) const {
+  if (IsLeftPipeline(ctx->GetPipeline())) {
+    InsertIntoSorter(ctx, function);
+  } else {
+    NOISEPAGE_ASSERT(IsRightPipeline(ctx->GetPipeline()), "Pipeline is unknown to join translator");
+    MergeWithLeftRows(ctx, function);
+  }
+}
+
+void MergeJoinTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (IsLeftPipeline(pipeline)) {
+    function->Append(GetCodeGen()->SorterSort(global_sorter_.GetPtr(GetCodeGen())));
+  }
+}
+
+ast::Expr *MergeJoinTranslator::GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const {
+  // Attributes of the left child are read from the rows being compared, or,
+  // in the right pipeline, from the matching left row.
+  if (child_idx == 0) {
+    switch (current_row_) {
+      case CurrentRow::Lhs:
+        return GetLeftRowAttribute(lhs_row_, attr_idx);
+      case CurrentRow::Rhs:
+        return GetLeftRowAttribute(rhs_row_, attr_idx);
+      case CurrentRow::Child:
+        if (IsRightPipeline(context->GetPipeline())) {
+          return GetLeftRowAttribute(left_row_var_, attr_idx);
+        }
+        break;
+    }
+  }
+  return OperatorTranslator::GetChildOutput(context, child_idx, attr_idx);
+}
+
+}  // namespace noisepage::execution::compiler
@@ -1,13 +1,93 @@
 #include "execution/compiler/operator/nested_loop_join_translator.h"
 
+#include <utility>
+#include <vector>
+
 #include "execution/compiler/compilation_context.h"
 #include "execution/compiler/if.h"
+#include "execution/compiler/operator/seq_scan_translator.h"
 #include "execution/compiler/pipeline.h"
 #include "execution/compiler/work_context.h"
+#include "parser/expression/derived_value_expression.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 
 namespace noisepage::execution::compiler {
 
+namespace {
+
+// Split the predicate into its conjuncts.
+void CollectConjuncts(common::ManagedPointer<parser::AbstractExpression> expr,
+                      std::vector<common::ManagedPointer<parser::AbstractExpression>> *conjuncts) {
+  if (expr->GetExpressionType() == parser::ExpressionType::CONJUNCTION_AND) {
+    for (const auto &child : expr->GetChildren()) {
+      CollectConjuncts(child, conjuncts);
+    }
+    return;
+  }
+  conjuncts->push_back(expr);
+}
+
+// True if the expression is computed from the outer tuple, constants and parameters only. It is then the same for
+// every inner tuple, and is evaluated once per outer tuple.
+bool IsOuterValue(common::ManagedPointer<parser::AbstractExpression> expr) {
+  switch (expr->GetExpressionType()) {
+    case parser::ExpressionType::VALUE_TUPLE:
+      return expr.CastManagedPointerTo<parser::DerivedValueExpression>()->GetTupleIdx() == 1;
+    case parser::ExpressionType::VALUE_CONSTANT:
+    case parser::ExpressionType::VALUE_PARAMETER:
+      return true;
+    case parser::ExpressionType::OPERATOR_PLUS:
+    case parser::ExpressionType::OPERATOR_MINUS:
+    case parser::ExpressionType::OPERATOR_MULTIPLY:
+    case parser::ExpressionType::OPERATOR_DIVIDE:
+    case parser::ExpressionType::OPERATOR_MOD:
+    case parser::ExpressionType::OPERATOR_UNARY_MINUS:
+    case parser::ExpressionType::OPERATOR_CAST:
+      for (const auto &child : expr->GetChildren()) {
+        if (!IsOuterValue(child)) return false;
+      }
+      return true;
+    default:
+      return false;
+  }
+}
+
+// The vector filters compare columns of these types with a constant.
+bool IsFilterableType(const type::TypeId type) {
+  switch (type) {
+    case type::TypeId::BOOLEAN:
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+    case type::TypeId::REAL:
+    case type::TypeId::DATE:
+    case type::TypeId::TIMESTAMP:
+    case type::TypeId::VARCHAR:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// The comparison with its operands swapped.
+parser::ExpressionType FlipComparison(const parser::ExpressionType cmp_type) {
+  switch (cmp_type) {
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+      return parser::ExpressionType::COMPARE_GREATER_THAN;
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+      return parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO;
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+      return parser::ExpressionType::COMPARE_LESS_THAN;
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      return parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO;
+    default:
+      return cmp_type;
+  }
+}
+
+}  // namespace
+
 NestedLoopJoinTranslator::NestedLoopJoinTranslator(const planner::NestedLoopJoinPlanNode &plan,
                                                    CompilationContext *compilation_context, Pipeline *pipeline)
     : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::DUMMY) {
@@ -25,19 +105,67 @@ NestedLoopJoinTranslator::NestedLoopJoinTranslator(const planner::NestedLoopJoin
   // Prepare join condition.
   if (const auto join_predicate = plan.GetJoinPredicate(); join_predicate != nullptr) {
     compilation_context->Prepare(*join_predicate);
+
+    // Comparisons of an inner column with an outer value become vector filters of an inner scan
+    auto *inner_scan = dynamic_cast<SeqScanTranslator *>(compilation_context->LookupTranslator(*plan.GetChild(0)));
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> conjuncts;
+    CollectConjuncts(join_predicate, &conjuncts);
+    for (const auto &conjunct : conjuncts) {
+      if (inner_scan == nullptr || !PushDownConjunct(inner_scan, conjunct)) {
+        residual_predicate_.push_back(conjunct);
+      }
+    }
   }
 }
 
+bool NestedLoopJoinTranslator::PushDownConjunct(SeqScanTranslator *inner_scan,
+                                                common::ManagedPointer<parser::AbstractExpression> conjunct) {
+  auto cmp_type = conjunct->GetExpressionType();
+  switch (cmp_type) {
+    case parser::ExpressionType::COMPARE_EQUAL:
+    case parser::ExpressionType::COMPARE_NOT_EQUAL:
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      break;
+    default:
+      return false;
+  }
+
+  auto inner = conjunct->GetChild(0), outer = conjunct->GetChild(1);
+  uint32_t col_idx;
+  if (!inner_scan->IsScannedColumn(inner, &col_idx)) {
+    std::swap(inner, outer);
+    cmp_type = FlipComparison(cmp_type);
+    if (!inner_scan->IsScannedColumn(inner, &col_idx)) return false;
+  }
+  const auto type = inner->GetReturnValueType();
+  if (!IsOuterValue(outer) || outer->GetReturnValueType() != type || !IsFilterableType(type)) {
+    return false;
+  }
+
+  inner_scan->RegisterOuterFilter(cmp_type, col_idx, sql::GetTypeId(type),
+                                  [this, outer](WorkContext *context) { return context->DeriveValue(*outer, this); });
+  return true;
+}
+
 void NestedLoopJoinTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const {
-  if (const auto join_predicate = GetNLJPlan().GetJoinPredicate(); join_predicate != nullptr) {
-    If cond(function, context->DeriveValue(*join_predicate, this));
+  if (!residual_predicate_.empty()) {
+    auto *codegen = GetCodeGen();
+    ast::Expr *cond_expr = context->DeriveValue(*residual_predicate_[0], this);
+    for (std::size_t i = 1; i < residual_predicate_.size(); i++) {
+      cond_expr = codegen->BinaryOp(parsing::Token::Type::AND, cond_expr,
+                                    context->DeriveValue(*residual_predicate_[i], this));
+    }
+    If cond(function, cond_expr);
     {
       // Valid tuple. Push to next operator in pipeline.
       context->Push(function);
     }
     cond.EndIf();
   } else {
-    // No join predicate. Push to next operator in pipeline.
+    // No join predicate, or all of it is filtered by the inner scan. Push to next operator in pipeline.
     context->Push(function);
   }
 }
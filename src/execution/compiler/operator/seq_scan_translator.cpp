@@ -1,5 +1,9 @@
 #include "execution/compiler/operator/seq_scan_translator.h"
 
+#include <algorithm>
+#include <limits>
+#include <set>
+
 #include "catalog/catalog_accessor.h"
 #include "common/error/error_code.h"
 #include "common/error/exception.h"
@@ -10,13 +14,64 @@
 #include "execution/compiler/loop.h"
 #include "execution/compiler/pipeline.h"
 #include "execution/compiler/work_context.h"
+#include "execution/functions/function_context.h"
 #include "parser/expression/column_value_expression.h"
+#include "parser/expression/constant_value_expression.h"
+#include "parser/expression/derived_value_expression.h"
+#include "parser/expression/function_expression.h"
 #include "parser/expression_util.h"
+#include "planner/plannodes/output_schema.h"
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "storage/sql_table.h"
 
 namespace noisepage::execution::compiler {
 
+namespace {
+
+// Is the expression an arithmetic operation that has a vector kernel? Division and modulo don't
+// qualify, as their kernels yield NULL on a zero divisor where the tuple-at-a-time code raises.
+bool IsVectorArithmetic(parser::ExpressionType type) {
+  return type == parser::ExpressionType::OPERATOR_PLUS || type == parser::ExpressionType::OPERATOR_MINUS ||
+         type == parser::ExpressionType::OPERATOR_MULTIPLY;
+}
+
+// The type arithmetic over values of the given type is carried out in. Like the tuple-at-a-time
+// code, all integers are computed as 64-bit integers and all reals as doubles.
+bool GetVectorComputeType(type::TypeId type, sql::TypeId *type_id) {
+  switch (type) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+      *type_id = sql::TypeId::BigInt;
+      return true;
+    case type::TypeId::REAL:
+      *type_id = sql::TypeId::Double;
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Does the date part have a vector kernel? The kernels cover the parts that DateTimeFunctions does.
+bool IsVectorDatePart(sql::DatePartType part) {
+  switch (part) {
+    case sql::DatePartType::CENTURY:
+    case sql::DatePartType::DECADE:
+    case sql::DatePartType::YEAR:
+    case sql::DatePartType::QUARTER:
+    case sql::DatePartType::MONTH:
+    case sql::DatePartType::DAY:
+    case sql::DatePartType::DOW:
+    case sql::DatePartType::DOY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
 SeqScanTranslator::SeqScanTranslator(const planner::SeqScanPlanNode &plan, CompilationContext *compilation_context,
                                      Pipeline *pipeline)
     : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::SEQ_SCAN),
@@ -52,9 +107,38 @@ catalog::table_oid_t SeqScanTranslator::GetTableOid() const {
   return GetPlanAs<planner::SeqScanPlanNode>().GetTableOid();
 }
 
-void SeqScanTranslator::GenerateGenericTerm(FunctionBuilder *function,
-                                            common::ManagedPointer<parser::AbstractExpression> term,
-                                            ast::Expr *vector_proj, ast::Expr *tid_list) {
+void SeqScanTranslator::SampleBlocks(uint32_t num_blocks) {
+  sample_blocks_ = num_blocks;
+  GetPipeline()->UpdateParallelism(Pipeline::Parallelism::Serial);
+}
+
+void SeqScanTranslator::RegisterRuntimeFilter(RuntimeFilter filter) {
+  // The filter manager is declared up front only if there's a predicate
+  if (!HasFilters()) {
+    ast::Expr *fm_type = GetCodeGen()->BuiltinType(ast::BuiltinType::FilterManager);
+    local_filter_manager_ = GetPipeline()->DeclarePipelineStateEntry("filterManager", fm_type);
+  }
+  runtime_filters_.emplace_back(std::move(filter));
+}
+
+void SeqScanTranslator::RegisterOuterFilter(const parser::ExpressionType cmp_type, const uint32_t col_idx,
+                                            const sql::TypeId value_type, OuterValue value) {
+  auto *codegen = GetCodeGen();
+  if (outer_filters_.empty()) {
+    ast::Expr *fm_type = codegen->BuiltinType(ast::BuiltinType::FilterManager);
+    outer_filter_manager_ = GetPipeline()->DeclarePipelineStateEntry("outerFilterManager", fm_type);
+  }
+  auto value_entry = GetPipeline()->DeclarePipelineStateEntry("outerValue", codegen->TplType(value_type));
+  outer_filters_.push_back({cmp_type, col_idx, value_entry, std::move(value)});
+}
+
+void SeqScanTranslator::RegisterVectorConsumer(VectorConsumer consumer) {
+  NOISEPAGE_ASSERT(!vector_consumer_, "Only one consumer of vector projections may be registered");
+  vector_consumer_ = std::move(consumer);
+}
+
+void SeqScanTranslator::GenerateMatchTerm(FunctionBuilder *function, const RuntimeFilter &filter,
+                                          ast::Expr *vector_proj, ast::Expr *tid_list) {
   auto *codegen = GetCodeGen();
 
   // var vpiBase: VectorProjectionIterator
@@ -73,8 +157,7 @@ void SeqScanTranslator::GenerateGenericTerm(FunctionBuilder *function,
                   codegen->MakeStmt(codegen->VPIAdvance(vpi, is_filtered)));  // @vpiAdvance[Filtered]()
     {
       WorkContext context(GetCompilationContext(), *GetPipeline());
-      auto cond_translator = GetCompilationContext()->LookupTranslator(*term);
-      auto match = cond_translator->DeriveValue(&context, this);
+      auto match = filter(&context, function);
       function->Append(codegen->VPIMatch(vpi, match));
     }
     vpi_loop.EndLoop();
@@ -87,6 +170,67 @@ void SeqScanTranslator::GenerateGenericTerm(FunctionBuilder *function,
   check_filtered.EndIf();
 }
 
+void SeqScanTranslator::GenerateGenericTerm(FunctionBuilder *function,
+                                            common::ManagedPointer<parser::AbstractExpression> term,
+                                            ast::Expr *vector_proj, ast::Expr *tid_list) {
+  auto cond_translator = GetCompilationContext()->LookupTranslator(*term);
+  GenerateMatchTerm(
+      function, [&](WorkContext *context, FunctionBuilder *) { return cond_translator->DeriveValue(context, this); },
+      vector_proj, tid_list);
+}
+
+ast::Identifier SeqScanTranslator::GenerateRuntimeFilterTerm(util::RegionVector<ast::FunctionDecl *> *decls,
+                                                             const RuntimeFilter &filter) {
+  // Same signature as the predicate's terms. The filter manager hands the query state in as the context.
+  auto *codegen = GetCodeGen();
+  auto fn_name = codegen->MakeFreshIdentifier(GetPipeline()->CreatePipelineFunctionName("RuntimeFilter"));
+  util::RegionVector<ast::FieldDecl *> params = codegen->MakeFieldList({
+      codegen->MakeField(codegen->MakeIdentifier("execCtx"), codegen->PointerType(ast::BuiltinType::ExecutionContext)),
+      codegen->MakeField(codegen->MakeIdentifier("vp"), codegen->PointerType(ast::BuiltinType::VectorProjection)),
+      codegen->MakeField(codegen->MakeIdentifier("tids"), codegen->PointerType(ast::BuiltinType::TupleIdList)),
+      codegen->MakeField(codegen->MakeIdentifier("context"), codegen->PointerType(ast::BuiltinType::Uint8)),
+  });
+  FunctionBuilder builder(codegen, fn_name, std::move(params), codegen->Nil());
+  {
+    // var queryState = @ptrCast(*QueryState, context)
+    ast::FieldDecl *query_state = GetCompilationContext()->QueryParams()[0];
+    ast::Identifier query_state_type = GetCompilationContext()->GetQueryState()->GetTypeName();
+    builder.Append(codegen->DeclareVarWithInit(query_state->Name(),
+                                               codegen->PtrCast(query_state_type, builder.GetParameterByPosition(3))));
+    GenerateMatchTerm(&builder, filter, builder.GetParameterByPosition(1), builder.GetParameterByPosition(2));
+  }
+  decls->push_back(builder.Finish());
+  return fn_name;
+}
+
+ast::Identifier SeqScanTranslator::GenerateOuterFilterTerm(util::RegionVector<ast::FunctionDecl *> *decls,
+                                                           const parser::ExpressionType cmp_type,
+                                                           const uint32_t col_idx,
+                                                           const StateDescriptor::Entry &value) {
+  // Same signature as the predicate's terms, but the filter manager hands the pipeline state in as the context.
+  auto *codegen = GetCodeGen();
+  auto fn_name = codegen->MakeFreshIdentifier(GetPipeline()->CreatePipelineFunctionName("OuterFilter"));
+  util::RegionVector<ast::FieldDecl *> params = codegen->MakeFieldList({
+      codegen->MakeField(codegen->MakeIdentifier("execCtx"), codegen->PointerType(ast::BuiltinType::ExecutionContext)),
+      codegen->MakeField(codegen->MakeIdentifier("vp"), codegen->PointerType(ast::BuiltinType::VectorProjection)),
+      codegen->MakeField(codegen->MakeIdentifier("tids"), codegen->PointerType(ast::BuiltinType::TupleIdList)),
+      codegen->MakeField(codegen->MakeIdentifier("context"), codegen->PointerType(ast::BuiltinType::Uint8)),
+  });
+  FunctionBuilder builder(codegen, fn_name, std::move(params), codegen->Nil());
+  {
+    // var pipelineState = @ptrCast(*PipelineState, context)
+    auto *pipeline = GetPipeline();
+    builder.Append(codegen->DeclareVarWithInit(
+        pipeline->GetPipelineStateVar(),
+        codegen->PtrCast(pipeline->GetPipelineStateTypeName(), builder.GetParameterByPosition(3))));
+    // @filterXX(execCtx, vp, col_idx, pipelineState.outerValue, tids)
+    builder.Append(codegen->VPIFilter(builder.GetParameterByPosition(0), builder.GetParameterByPosition(1), cmp_type,
+                                      col_idx, value.Get(codegen), builder.GetParameterByPosition(2)));
+  }
+  decls->push_back(builder.Finish());
+  return fn_name;
+}
+
 void SeqScanTranslator::GenerateFilterClauseFunctions(util::RegionVector<ast::FunctionDecl *> *decls,
                                                       common::ManagedPointer<parser::AbstractExpression> predicate,
                                                       std::vector<ast::Identifier> *curr_clause,
@@ -203,12 +347,357 @@ void SeqScanTranslator::GenerateFilterClauseFunctions(util::RegionVector<ast::Fu
   decls->push_back(builder.Finish());
 }
 
+void SeqScanTranslator::CollectBlockFilters(common::ManagedPointer<parser::AbstractExpression> predicate) {
+  // Only the terms of a top-most conjunction hold for every tuple, and blocks keep bounds of integer columns only
+  if (predicate->GetExpressionType() == parser::ExpressionType::CONJUNCTION_AND) {
+    for (const auto &child : predicate->GetChildren()) {
+      CollectBlockFilters(child);
+    }
+    return;
+  }
+  if (!parser::ExpressionUtil::IsColumnCompareWithConst(*predicate)) {
+    return;
+  }
+  auto is_integer = [](type::TypeId type) {
+    return type == type::TypeId::TINYINT || type == type::TypeId::SMALLINT || type == type::TypeId::INTEGER ||
+           type == type::TypeId::BIGINT;
+  };
+  auto cve = predicate->GetChild(0).CastManagedPointerTo<parser::ColumnValueExpression>();
+  auto constant = predicate->GetChild(1).CastManagedPointerTo<parser::ConstantValueExpression>();
+  const auto &schema = GetCodeGen()->GetCatalogAccessor()->GetSchema(GetTableOid());
+  if (!is_integer(schema.GetColumn(cve->GetColumnOid()).Type()) || !is_integer(constant->GetReturnValueType()) ||
+      constant->IsNull()) {
+    return;
+  }
+
+  constexpr int64_t lowest = std::numeric_limits<int64_t>::min(), highest = std::numeric_limits<int64_t>::max();
+  const auto val = constant->Peek<int64_t>();
+  const auto col_idx = GetColOidIndex(cve->GetColumnOid());
+  switch (predicate->GetExpressionType()) {
+    case parser::ExpressionType::COMPARE_EQUAL:
+      block_filters_.push_back({col_idx, val, val});
+      break;
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+      if (val != lowest) block_filters_.push_back({col_idx, lowest, val - 1});
+      break;
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+      block_filters_.push_back({col_idx, lowest, val});
+      break;
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+      if (val != highest) block_filters_.push_back({col_idx, val + 1, highest});
+      break;
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      block_filters_.push_back({col_idx, val, highest});
+      break;
+    default:
+      break;
+  }
+}
+
+void SeqScanTranslator::CollectLateColumns(common::ManagedPointer<parser::AbstractExpression> predicate) {
+  std::set<catalog::col_oid_t> filter_col_oids;
+  parser::ExpressionUtil::GetColumnOids(&filter_col_oids, predicate);
+  std::vector<bool> is_filtered(col_oids_.size(), false);
+  for (const auto &col_oid : filter_col_oids) is_filtered[GetColOidIndex(col_oid)] = true;
+  for (const auto &filter : outer_filters_) is_filtered[filter.col_idx_] = true;
+
+  // The filters need at least one column to run on
+  if (std::find(is_filtered.begin(), is_filtered.end(), true) == is_filtered.end()) return;
+  for (uint32_t col_idx = 0; col_idx < col_oids_.size(); col_idx++) {
+    if (!is_filtered[col_idx]) late_col_idxs_.push_back(col_idx);
+  }
+}
+
 void SeqScanTranslator::DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) {
   if (HasPredicate()) {
     std::vector<ast::Identifier> curr_clause;
     auto root_expr = GetPlanAs<planner::SeqScanPlanNode>().GetScanPredicate();
     GenerateFilterClauseFunctions(decls, root_expr, &curr_clause, false);
     filters_.emplace_back(std::move(curr_clause));
+    CollectBlockFilters(root_expr);
+  }
+
+  for (const auto &filter : outer_filters_) {
+    outer_filter_clause_.push_back(GenerateOuterFilterTerm(decls, filter.cmp_type_, filter.col_idx_, filter.value_));
+  }
+
+  // Runtime filters must hold in every clause
+  if (!runtime_filters_.empty()) {
+    if (filters_.empty()) {
+      filters_.emplace_back();
+    }
+    for (const auto &filter : runtime_filters_) {
+      const auto term = GenerateRuntimeFilterTerm(decls, filter);
+      for (auto &clause : filters_) {
+        clause.push_back(term);
+      }
+    }
+  }
+
+  // Runtime filters read columns that are only known as their terms are generated
+  if (HasPredicate() && runtime_filters_.empty()) {
+    CollectLateColumns(GetPlanAs<planner::SeqScanPlanNode>().GetScanPredicate());
+  }
+
+  PlanVectorExpressions();
+}
+
+common::ManagedPointer<parser::AbstractExpression> SeqScanTranslator::ResolveScanOutput(
+    common::ManagedPointer<parser::AbstractExpression> expr) const {
+  if (expr->GetExpressionType() != parser::ExpressionType::VALUE_TUPLE) {
+    return expr;
+  }
+  auto dve = expr.CastManagedPointerTo<parser::DerivedValueExpression>();
+  if (dve->GetTupleIdx() != 0) {
+    return expr;
+  }
+  return GetPlan().GetOutputSchema()->GetColumn(dve->GetValueIdx()).GetExpr();
+}
+
+bool SeqScanTranslator::IsScannedColumn(common::ManagedPointer<parser::AbstractExpression> expr,
+                                        uint32_t *col_idx) const {
+  const auto resolved = ResolveScanOutput(expr);
+  if (resolved->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) {
+    return false;
+  }
+  const auto col_oid = resolved.CastManagedPointerTo<parser::ColumnValueExpression>()->GetColumnOid();
+  if (std::find(col_oids_.begin(), col_oids_.end(), col_oid) == col_oids_.end()) {
+    return false;
+  }
+  *col_idx = GetColOidIndex(col_oid);
+  return true;
+}
+
+bool SeqScanTranslator::IsNotNullColumn(common::ManagedPointer<parser::AbstractExpression> expr,
+                                        uint32_t *col_idx) const {
+  if (!IsScannedColumn(expr, col_idx)) {
+    return false;
+  }
+  const auto &schema = GetCodeGen()->GetCatalogAccessor()->GetSchema(GetTableOid());
+  return !schema.GetColumn(col_oids_[*col_idx]).Nullable();
+}
+
+bool SeqScanTranslator::IsVectorizable(common::ManagedPointer<parser::AbstractExpression> expr,
+                                       sql::TypeId *type_id) const {
+  const auto resolved = ResolveScanOutput(expr);
+  switch (resolved->GetExpressionType()) {
+    case parser::ExpressionType::COLUMN_VALUE: {
+      const auto col_oid = resolved.CastManagedPointerTo<parser::ColumnValueExpression>()->GetColumnOid();
+      if (std::find(col_oids_.begin(), col_oids_.end(), col_oid) == col_oids_.end()) {
+        return false;
+      }
+      const auto &schema = GetCodeGen()->GetCatalogAccessor()->GetSchema(GetTableOid());
+      return GetVectorComputeType(schema.GetColumn(col_oid).Type(), type_id);
+    }
+    case parser::ExpressionType::VALUE_CONSTANT:
+      return !resolved.CastManagedPointerTo<parser::ConstantValueExpression>()->IsNull() &&
+             GetVectorComputeType(resolved->GetReturnValueType(), type_id);
+    case parser::ExpressionType::OPERATOR_PLUS:
+    case parser::ExpressionType::OPERATOR_MINUS:
+    case parser::ExpressionType::OPERATOR_MULTIPLY: {
+      if (resolved->GetChildrenSize() != 2) {
+        return false;
+      }
+      // Both operands are evaluated in the same type, and at least one of them is a column
+      auto is_constant = [&](uint32_t idx) {
+        return ResolveScanOutput(resolved->GetChild(idx))->GetExpressionType() ==
+               parser::ExpressionType::VALUE_CONSTANT;
+      };
+      sql::TypeId left_type, right_type;
+      return IsVectorizable(resolved->GetChild(0), &left_type) && IsVectorizable(resolved->GetChild(1), &right_type) &&
+             left_type == right_type && !(is_constant(0) && is_constant(1)) &&
+             GetVectorComputeType(resolved->GetReturnValueType(), type_id) && *type_id == left_type;
+    }
+    case parser::ExpressionType::FUNCTION: {
+      // Only date parts of scanned dates, yielding integers that are read as they are
+      sql::DatePartType part;
+      if (!IsDatePartOfColumn(resolved, &part)) {
+        return false;
+      }
+      *type_id = sql::TypeId::Integer;
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+bool SeqScanTranslator::IsDatePartOfColumn(common::ManagedPointer<parser::AbstractExpression> expr,
+                                           sql::DatePartType *part) const {
+  const auto func_context = GetCodeGen()->GetCatalogAccessor()->GetFunctionContext(
+      expr.CastManagedPointerTo<parser::FunctionExpression>()->GetProcOid());
+  if (!func_context->IsBuiltin() || func_context->GetBuiltin() != ast::Builtin::DatePart ||
+      expr->GetChildrenSize() != 2) {
+    return false;
+  }
+  const auto date = ResolveScanOutput(expr->GetChild(0));
+  const auto part_expr = ResolveScanOutput(expr->GetChild(1));
+  if (date->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE ||
+      part_expr->GetExpressionType() != parser::ExpressionType::VALUE_CONSTANT) {
+    return false;
+  }
+  const auto col_oid = date.CastManagedPointerTo<parser::ColumnValueExpression>()->GetColumnOid();
+  const auto part_val = part_expr.CastManagedPointerTo<parser::ConstantValueExpression>()->GetInteger();
+  if (std::find(col_oids_.begin(), col_oids_.end(), col_oid) == col_oids_.end() || part_val.is_null_) {
+    return false;
+  }
+  const auto &schema = GetCodeGen()->GetCatalogAccessor()->GetSchema(GetTableOid());
+  *part = static_cast<sql::DatePartType>(part_val.val_);
+  return schema.GetColumn(col_oid).Type() == type::TypeId::DATE && IsVectorDatePart(*part);
+}
+
+void SeqScanTranslator::CollectVectorExpressions(
+    common::ManagedPointer<parser::AbstractExpression> expr,
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> *roots) const {
+  sql::TypeId type_id;
+  const auto expr_type = ResolveScanOutput(expr)->GetExpressionType();
+  if ((IsVectorArithmetic(expr_type) || expr_type == parser::ExpressionType::FUNCTION) &&
+      IsVectorizable(expr, &type_id)) {
+    roots->push_back(expr);
+    return;
+  }
+  for (const auto &child : expr->GetChildren()) {
+    CollectVectorExpressions(child, roots);
+  }
+}
+
+uint32_t SeqScanTranslator::PlanVectorExpression(common::ManagedPointer<parser::AbstractExpression> expr) {
+  const auto resolved = ResolveScanOutput(expr);
+  // Common subexpressions are computed once
+  for (const auto &[planned, col_idx] : vector_exprs_) {
+    if (*planned == *resolved) {
+      return col_idx;
+    }
+  }
+
+  sql::TypeId type_id;
+  IsVectorizable(resolved, &type_id);
+  VectorStep step{resolved->GetExpressionType(), 0, 0, 0, nullptr, nullptr};
+  if (resolved->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE) {
+    // Scanned columns are used as they are, unless they need to be widened first
+    const auto col_oid = resolved.CastManagedPointerTo<parser::ColumnValueExpression>()->GetColumnOid();
+    const auto scan_idx = GetColOidIndex(col_oid);
+    if (expr_vp_types_[scan_idx] == type_id) {
+      return scan_idx;
+    }
+    step.op_type_ = parser::ExpressionType::OPERATOR_CAST;
+    step.left_idx_ = scan_idx;
+  } else if (resolved->GetExpressionType() == parser::ExpressionType::FUNCTION) {
+    // Date parts read the scanned column of dates as it is
+    IsDatePartOfColumn(resolved, &step.date_part_);
+    const auto date = ResolveScanOutput(resolved->GetChild(0));
+    step.left_idx_ = GetColOidIndex(date.CastManagedPointerTo<parser::ColumnValueExpression>()->GetColumnOid());
+  } else {
+    auto plan_operand = [&](uint32_t idx, uint32_t *col_idx,
+                            common::ManagedPointer<parser::AbstractExpression> *constant) {
+      const auto operand = ResolveScanOutput(resolved->GetChild(idx));
+      if (operand->GetExpressionType() == parser::ExpressionType::VALUE_CONSTANT) {
+        *constant = operand;
+      } else {
+        *col_idx = PlanVectorExpression(operand);
+      }
+    };
+    plan_operand(0, &step.left_idx_, &step.left_const_);
+    plan_operand(1, &step.right_idx_, &step.right_const_);
+  }
+
+  step.result_idx_ = expr_vp_types_.size();
+  expr_vp_types_.push_back(type_id);
+  vector_steps_.push_back(step);
+  vector_exprs_.emplace_back(resolved, step.result_idx_);
+  return step.result_idx_;
+}
+
+void SeqScanTranslator::PlanVectorExpressions() {
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> candidates;
+  for (const auto &col : GetPlan().GetOutputSchema()->GetColumns()) {
+    candidates.push_back(col.GetExpr());
+  }
+  // The operator consuming the scan derives its values in the scan's loop too
+  const Pipeline *pipeline = GetPipeline();
+  if (auto iter = std::find(pipeline->Begin(), pipeline->End(), this);
+      iter != pipeline->End() && ++iter != pipeline->End() && (*iter)->GetPlan().GetChildrenSize() > 0 &&
+      (*iter)->GetPlan().GetChild(0) == &GetPlan()) {
+    (*iter)->CollectChildPipelineExpressions(&candidates);
+  }
+
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> roots;
+  for (const auto &expr : candidates) {
+    CollectVectorExpressions(expr, &roots);
+  }
+  if (roots.empty()) {
+    return;
+  }
+
+  const auto &schema = GetCodeGen()->GetCatalogAccessor()->GetSchema(GetTableOid());
+  for (const auto &col_oid : col_oids_) {
+    expr_vp_types_.push_back(sql::GetTypeId(schema.GetColumn(col_oid).Type()));
+  }
+  for (const auto &root : roots) {
+    vector_roots_.emplace_back(root, PlanVectorExpression(root));
+  }
+
+  const auto num_operations = std::count_if(vector_steps_.begin(), vector_steps_.end(), [](const auto &step) {
+    return step.op_type_ != parser::ExpressionType::OPERATOR_CAST;
+  });
+  // Splitting Julian days costs enough that a single date part makes up for extending the projection
+  const bool has_date_part = std::any_of(vector_steps_.begin(), vector_steps_.end(), [](const auto &step) {
+    return step.op_type_ == parser::ExpressionType::FUNCTION;
+  });
+  if (num_operations < MIN_VECTOR_OPERATIONS && !has_date_part) {
+    expr_vp_types_.clear();
+    vector_steps_.clear();
+    vector_exprs_.clear();
+    vector_roots_.clear();
+    return;
+  }
+
+  ast::Expr *vp_type = GetCodeGen()->BuiltinType(ast::BuiltinType::VectorProjection);
+  expr_vp_ = GetPipeline()->DeclarePipelineStateEntry("exprVP", vp_type);
+}
+
+void SeqScanTranslator::GenerateVectorExpressions(WorkContext *ctx, FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+
+  // @vpExtend(&pipelineState.exprVP, vpi)
+  function->Append(codegen->VectorProjectionExtend(expr_vp_.GetPtr(codegen), codegen->MakeExpr(vpi_var_)));
+
+  auto make_operand = [&](common::ManagedPointer<parser::AbstractExpression> constant, uint32_t col_idx) {
+    if (constant != nullptr) {
+      return GetCompilationContext()->LookupTranslator(*constant)->DeriveValue(nullptr, nullptr);
+    }
+    return codegen->Const32(col_idx);
+  };
+  for (const auto &step : vector_steps_) {
+    if (step.op_type_ == parser::ExpressionType::OPERATOR_CAST) {
+      // @vectorCast(execCtx, &pipelineState.exprVP, result_idx, col_idx)
+      function->Append(
+          codegen->VectorCast(GetExecutionContext(), expr_vp_.GetPtr(codegen), step.result_idx_, step.left_idx_));
+    } else if (step.op_type_ == parser::ExpressionType::FUNCTION) {
+      // @vectorDatePart(execCtx, &pipelineState.exprVP, result_idx, col_idx, part)
+      function->Append(codegen->VectorDatePart(GetExecutionContext(), expr_vp_.GetPtr(codegen), step.result_idx_,
+                                               step.left_idx_, step.date_part_));
+    } else {
+      // @vector[Op](execCtx, &pipelineState.exprVP, result_idx, left, right)
+      function->Append(codegen->VectorArithmetic(GetExecutionContext(), expr_vp_.GetPtr(codegen), step.op_type_,
+                                                 step.result_idx_, make_operand(step.left_const_, step.left_idx_),
+                                                 make_operand(step.right_const_, step.right_idx_)));
+    }
+  }
+
+  // var exprVPIBase: VectorProjectionIterator
+  // @vpiInit(&exprVPIBase, &pipelineState.exprVP)
+  // vpi = &exprVPIBase
+  auto vpi_base = codegen->MakeFreshIdentifier("exprVPIBase");
+  function->Append(codegen->DeclareVarNoInit(vpi_base, ast::BuiltinType::VectorProjectionIterator));
+  function->Append(
+      codegen->VPIInit(codegen->AddressOf(codegen->MakeExpr(vpi_base)), expr_vp_.GetPtr(codegen), nullptr));
+  function->Append(codegen->Assign(codegen->MakeExpr(vpi_var_), codegen->AddressOf(codegen->MakeExpr(vpi_base))));
+
+  // Operators read the results instead of computing them one tuple at a time
+  for (const auto &[expr, col_idx] : vector_roots_) {
+    auto value = codegen->VPIGet(codegen->MakeExpr(vpi_var_), expr_vp_types_[col_idx], true, col_idx);
+    ctx->SetExpressionOverride(*expr, value);
   }
 }
 
@@ -229,8 +718,12 @@ void SeqScanTranslator::ScanVPI(WorkContext *ctx, FunctionBuilder *function, ast
     vpi_loop.EndLoop();
   };
   // TODO(Amadou): What if the predicate doesn't filter out anything?
-  gen_vpi_loop(HasPredicate());
+  gen_vpi_loop(HasFilters() || !outer_filters_.empty());
+  CountVPITuples(function);
+}
 
+void SeqScanTranslator::CountVPITuples(FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
   // var vpi_num_tuples = @tableIterGetNumTuples(tvi)
   ast::Identifier vpi_num_tuples = codegen->MakeFreshIdentifier("vpi_num_tuples");
   function->Append(codegen->DeclareVarWithInit(
@@ -240,34 +733,103 @@ void SeqScanTranslator::ScanVPI(WorkContext *ctx, FunctionBuilder *function, ast
 
 void SeqScanTranslator::ScanTable(WorkContext *ctx, FunctionBuilder *function) const {
   auto *codegen = GetCodeGen();
-  // for (@tableIterAdvance(tvi))
-  Loop tvi_loop(function, codegen->TableIterAdvance(codegen->MakeExpr(tvi_var_)));
+  // @tableIterFilterBlocks(tvi, col_idx, min, max), for every range the predicate restricts a column to
+  for (const auto &filter : block_filters_) {
+    function->Append(
+        codegen->TableIterFilterBlocks(codegen->MakeExpr(tvi_var_), filter.col_idx_, filter.min_, filter.max_));
+  }
+  for (const auto &filter : runtime_block_filters_) {
+    function->Append(filter(codegen->MakeExpr(tvi_var_)));
+  }
+  // pipelineState.outerValue = value, for every outer value compared with
+  for (const auto &filter : outer_filters_) {
+    function->Append(codegen->Assign(filter.value_.Get(codegen), filter.gen_value_(ctx)));
+  }
+  // @tableIterLateMaterialize(tvi, col_idx), for every column no filter reads
+  for (const auto col_idx : late_col_idxs_) {
+    function->Append(codegen->TableIterLateMaterialize(codegen->MakeExpr(tvi_var_), col_idx));
+  }
+  // @tableIterSampleBlocks(tvi, num_blocks)
+  if (sample_blocks_ != 0) {
+    function->Append(codegen->TableIterSampleBlocks(codegen->MakeExpr(tvi_var_), sample_blocks_));
+  }
+  // for (@tableIterAdvance(tvi) and !stop_condition)
+  ast::Expr *advance = codegen->TableIterAdvance(codegen->MakeExpr(tvi_var_));
+  for (const auto &condition : stop_conditions_) {
+    advance = codegen->BinaryOp(parsing::Token::Type::AND, advance,
+                                codegen->UnaryOp(parsing::Token::Type::BANG, condition()));
+  }
+  Loop tvi_loop(function, advance);
   {
+    // @execCtxCheckInterrupt(execCtx), once per vector
+    function->Append(codegen->ExecCtxCheckInterrupt(GetExecutionContext()));
+
     // var vpi = @tableIterGetVPI(tvi)
     auto vpi = codegen->MakeExpr(vpi_var_);
     function->Append(codegen->DeclareVarWithInit(vpi_var_, codegen->TableIterGetVPI(codegen->MakeExpr(tvi_var_))));
 
-    // if (predicate)
-    if (HasPredicate()) {
+    // if (filters)
+    if (HasFilters()) {
       auto filter_manager = local_filter_manager_.GetPtr(codegen);
       function->Append(codegen->FilterManagerRunFilters(filter_manager, vpi, GetExecutionContext()));
     }
+    if (!outer_filters_.empty()) {
+      auto filter_manager = outer_filter_manager_.GetPtr(codegen);
+      function->Append(codegen->FilterManagerRunFilters(filter_manager, vpi, GetExecutionContext()));
+    }
+    // @tableIterFetchLateColumns(tvi), for the tuples that passed the filters
+    if (!late_col_idxs_.empty()) {
+      function->Append(codegen->TableIterFetchLateColumns(codegen->MakeExpr(tvi_var_)));
+    }
+
+    // Evaluate arithmetic over the whole projection, the VPI then iterates the results
+    if (!vector_steps_.empty()) {
+      GenerateVectorExpressions(ctx, function);
+    }
 
-    if (!ctx->GetPipeline().IsVectorized()) {
+    if (vector_consumer_) {
+      vector_consumer_(function, vpi);
+      CountVPITuples(function);
+    } else if (!ctx->GetPipeline().IsVectorized()) {
       ScanVPI(ctx, function, vpi);
     }
+
+    if (!vector_steps_.empty()) {
+      ctx->ClearExpressionOverrides();
+    }
   }
   tvi_loop.EndLoop();
 }
 
 void SeqScanTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
   auto *codegen = GetCodeGen();
-  if (HasPredicate()) {
+  if (HasFilters()) {
     function->Append(codegen->FilterManagerInit(local_filter_manager_.GetPtr(codegen), GetExecutionContext()));
     for (const auto &clause : filters_) {
       function->Append(codegen->FilterManagerInsert(local_filter_manager_.GetPtr(codegen), clause));
     }
   }
+  if (!outer_filters_.empty()) {
+    // The terms of the outer filters read their values from the pipeline state
+    auto filter_manager = outer_filter_manager_.GetPtr(codegen);
+    function->Append(codegen->FilterManagerInit(filter_manager, GetExecutionContext(),
+                                                codegen->MakeExpr(pipeline.GetPipelineStateVar())));
+    function->Append(codegen->FilterManagerInsert(filter_manager, outer_filter_clause_));
+  }
+
+  if (!vector_steps_.empty()) {
+    // var exprVPTypes: [num_cols]uint32
+    auto col_types = codegen->MakeFreshIdentifier("exprVPTypes");
+    ast::Expr *arr_type = codegen->ArrayType(expr_vp_types_.size(), ast::BuiltinType::Kind::Uint32);
+    function->Append(codegen->DeclareVarNoInit(col_types, arr_type));
+    for (uint32_t i = 0; i < expr_vp_types_.size(); i++) {
+      ast::Expr *lhs = codegen->ArrayAccess(col_types, i);
+      ast::Expr *rhs = codegen->Const32(static_cast<uint32_t>(expr_vp_types_[i]));
+      function->Append(codegen->Assign(lhs, rhs));
+    }
+    // @vpInit(&pipelineState.exprVP, exprVPTypes)
+    function->Append(codegen->VectorProjectionInit(expr_vp_.GetPtr(codegen), col_types));
+  }
 
   InitializeCounters(pipeline, function);
 }
@@ -275,10 +837,17 @@ void SeqScanTranslator::InitializePipelineState(const Pipeline &pipeline, Functi
 void SeqScanTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
   auto *codegen = GetCodeGen();
 
-  if (HasPredicate()) {
+  if (HasFilters()) {
     auto filter_manager = local_filter_manager_.GetPtr(GetCodeGen());
     function->Append(GetCodeGen()->FilterManagerFree(filter_manager));
   }
+  if (!outer_filters_.empty()) {
+    function->Append(codegen->FilterManagerFree(outer_filter_manager_.GetPtr(codegen)));
+  }
+
+  if (!vector_steps_.empty()) {
+    function->Append(codegen->VectorProjectionFree(expr_vp_.GetPtr(codegen)));
+  }
 
   // if (pipelineState.tviNeedsFree)
   If need_free(function, tvi_needs_free_.Get(codegen));
@@ -6,6 +6,7 @@
 #include "execution/compiler/function_builder.h"
 #include "execution/compiler/if.h"
 #include "execution/compiler/loop.h"
+#include "execution/compiler/operator/seq_scan_translator.h"
 #include "execution/compiler/work_context.h"
 #include "execution/sql/sorter.h"
 #include "planner/plannodes/order_by_plan_node.h"
@@ -15,6 +16,41 @@ namespace noisepage::execution::compiler {
 
 namespace {
 constexpr const char SORT_ROW_ATTR_PREFIX[] = "attr";
+
+// Whether values of the given type can be encoded into a normalized sort key
+bool HasNormalizedKey(type::TypeId type) {
+  switch (type) {
+    case type::TypeId::BOOLEAN:
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+    case type::TypeId::REAL:
+    case type::TypeId::DATE:
+    case type::TypeId::TIMESTAMP:
+    case type::TypeId::VARCHAR:
+    case type::TypeId::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Whether the normalized keys of the given type order exactly like its values, as opposed to only
+// bounding their order like the prefixes of strings do
+bool HasExactNormalizedKey(type::TypeId type) {
+  switch (type) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+    case type::TypeId::DATE:
+    case type::TypeId::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
 }  // namespace
 
 SortTranslator::SortTranslator(const planner::OrderByPlanNode &plan, CompilationContext *compilation_context,
@@ -44,11 +80,21 @@ SortTranslator::SortTranslator(const planner::OrderByPlanNode &plan, Compilation
     compilation_context->Prepare(*expr);
   }
 
+  // If the first sort key can be normalized, the sorter radix sorts on it.
+  const auto &sort_keys = plan.GetSortKeys();
+  if (!sort_keys.empty() && HasNormalizedKey(sort_keys[0].first->GetReturnValueType())) {
+    normalized_key_func_ = GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("NormalizedKey"));
+  }
+
   // Register a Sorter instance in the global query state.
   CodeGen *codegen = compilation_context->GetCodeGen();
   ast::Expr *sorter_type = codegen->BuiltinType(ast::BuiltinType::Sorter);
   global_sorter_ = compilation_context->GetQueryState()->DeclareStateEntry(codegen, "sorter", sorter_type);
 
+  if (plan.HasLimit() && !normalized_key_func_.IsEmpty()) {
+    PushTopKBoundIntoScan(compilation_context);
+  }
+
   // Register another Sorter instance in the pipeline-local state if the
   // build pipeline is parallel.
   if (build_pipeline_.IsParallel()) {
@@ -72,6 +118,40 @@ SortTranslator::SortTranslator(const planner::OrderByPlanNode &plan, Compilation
   }
 }
 
+void SortTranslator::PushTopKBoundIntoScan(CompilationContext *compilation_context) {
+  // Once a heap holds K rows, a row whose first sort key is past the one of the heap's top compares
+  // greater than all K rows, and never makes it into the top-K. Rows are held against the bound
+  // through their normalized keys, which needs the keys to be exact and never NULL, as NULLs tie.
+  const auto &[expr, sort_order] = GetPlanAs<planner::OrderByPlanNode>().GetSortKeys()[0];
+  auto *scan = dynamic_cast<SeqScanTranslator *>(compilation_context->LookupTranslator(*GetPlan().GetChild(0)));
+  uint32_t col_idx;
+  const auto key_type = expr->GetReturnValueType();
+  if (scan == nullptr || !HasExactNormalizedKey(key_type) || !scan->IsNotNullColumn(expr, &col_idx)) {
+    return;
+  }
+
+  const bool descending = sort_order == optimizer::OrderByOrderingType::DESC;
+  scan->RegisterRuntimeFilter([this, expr = expr, descending](WorkContext *ctx, FunctionBuilder *) {
+    // @sorterNormalizeKey(key) <= @sorterGetTopKBound(&queryState.sorter)
+    auto *codegen = GetCodeGen();
+    ast::Expr *key = codegen->SorterNormalizeKey(ctx->DeriveValue(*expr, this));
+    if (descending) {
+      key = codegen->UnaryOp(parsing::Token::Type::BIT_NOT, key);
+    }
+    ast::Expr *bound = codegen->SorterGetTopKBound(global_sorter_.GetPtr(codegen));
+    return codegen->Compare(parsing::Token::Type::LESS_EQUAL, key, bound);
+  });
+
+  // Zone maps only bound integer columns
+  if (key_type == type::TypeId::TINYINT || key_type == type::TypeId::SMALLINT || key_type == type::TypeId::INTEGER ||
+      key_type == type::TypeId::BIGINT) {
+    scan->RegisterRuntimeBlockFilter([this, col_idx, descending](ast::Expr *tvi) {
+      auto *codegen = GetCodeGen();
+      return codegen->TableIterFilterBlocksTopK(tvi, col_idx, global_sorter_.GetPtr(codegen), descending);
+    });
+  }
+}
+
 void SortTranslator::DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) {
   auto *codegen = GetCodeGen();
   auto fields = codegen->MakeEmptyFieldList();
@@ -109,6 +189,21 @@ void SortTranslator::GenerateComparisonFunction(FunctionBuilder *function) {
   current_row_ = CurrentRow::Child;
 }
 
+void SortTranslator::GenerateNormalizedKeyFunction(FunctionBuilder *function) {
+  auto *codegen = GetCodeGen();
+  WorkContext context(GetCompilationContext(), build_pipeline_);
+  context.SetExpressionCacheEnable(false);
+  const auto &[expr, sort_order] = GetPlanAs<planner::OrderByPlanNode>().GetSortKeys()[0];
+  current_row_ = CurrentRow::Lhs;
+  ast::Expr *key = codegen->SorterNormalizeKey(context.DeriveValue(*expr, this));
+  if (sort_order == optimizer::OrderByOrderingType::DESC) {
+    // Inverting the bits reverses the order of the keys.
+    key = codegen->UnaryOp(parsing::Token::Type::BIT_NOT, key);
+  }
+  function->Append(codegen->Return(key));
+  current_row_ = CurrentRow::Child;
+}
+
 void SortTranslator::DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) {
   auto *codegen = GetCodeGen();
   auto params = codegen->MakeFieldList({
@@ -121,6 +216,17 @@ void SortTranslator::DefineHelperFunctions(util::RegionVector<ast::FunctionDecl
     GenerateComparisonFunction(&builder);
   }
   decls->push_back(builder.Finish(codegen->Const32(0)));
+
+  if (!normalized_key_func_.IsEmpty()) {
+    auto key_params = codegen->MakeFieldList({codegen->MakeField(lhs_row_, codegen->PointerType(sort_row_type_))});
+    FunctionBuilder key_builder(codegen, normalized_key_func_, std::move(key_params),
+                                codegen->BuiltinType(ast::BuiltinType::Uint64));
+    {
+      // Generate body.
+      GenerateNormalizedKeyFunction(&key_builder);
+    }
+    decls->push_back(key_builder.Finish());
+  }
 }
 
 void SortTranslator::DefineTLSDependentHelperFunctions(const Pipeline &pipeline,
@@ -137,6 +243,9 @@ void SortTranslator::DefineTLSDependentHelperFunctions(const Pipeline &pipeline,
 void SortTranslator::InitializeSorter(FunctionBuilder *function, ast::Expr *sorter_ptr) const {
   auto ctx = GetExecutionContext();
   function->Append(GetCodeGen()->SorterInit(sorter_ptr, ctx, compare_func_, sort_row_type_));
+  if (!normalized_key_func_.IsEmpty()) {
+    function->Append(GetCodeGen()->SorterSetNormalizedKey(sorter_ptr, normalized_key_func_));
+  }
 }
 
 void SortTranslator::TearDownSorter(FunctionBuilder *function, ast::Expr *sorter_ptr) const {
@@ -285,7 +394,12 @@ ast::FunctionDecl *SortTranslator::GenerateEndSingleSorterHookFunction() const {
 
 void SortTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
   if (IsBuildPipeline(pipeline) && build_pipeline_.IsParallel()) {
-    InitializeSorter(function, local_sorter_.GetPtr(GetCodeGen()));
+    auto *codegen = GetCodeGen();
+    InitializeSorter(function, local_sorter_.GetPtr(codegen));
+    // All threads tighten the one top-K bound the scan reads
+    if (GetPlanAs<planner::OrderByPlanNode>().HasLimit()) {
+      function->Append(codegen->SorterShareTopKBound(local_sorter_.GetPtr(codegen), global_sorter_.GetPtr(codegen)));
+    }
   }
 
   InitializeCounters(pipeline, function);
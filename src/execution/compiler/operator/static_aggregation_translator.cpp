@@ -1,10 +1,12 @@
 #include "execution/compiler/operator/static_aggregation_translator.h"
 
 #include <utility>
+#include <vector>
 
 #include "execution/compiler/compilation_context.h"
 #include "execution/compiler/function_builder.h"
 #include "execution/compiler/if.h"
+#include "execution/compiler/operator/seq_scan_translator.h"
 #include "execution/compiler/work_context.h"
 #include "planner/plannodes/aggregate_plan_node.h"
 
@@ -47,6 +49,14 @@ StaticAggregationTranslator::StaticAggregationTranslator(const planner::Aggregat
   // Prepare the child.
   compilation_context->Prepare(*plan.GetChild(0), &build_pipeline_);
 
+  // Aggregates over columns of a scan advance by a whole vector projection at a time, so the scan
+  // never iterates its tuples one at a time.
+  auto *scan = dynamic_cast<SeqScanTranslator *>(compilation_context->LookupTranslator(*plan.GetChild(0)));
+  if (scan != nullptr && PlanVectorAggregates(*scan)) {
+    scan->RegisterVectorConsumer(
+        [this](FunctionBuilder *function, ast::Expr *vpi) { AdvanceVectorAggregates(function, vpi); });
+  }
+
   // If there's a having clause, prepare it, too.
   if (const auto having_clause = plan.GetHavingClausePredicate(); having_clause != nullptr) {
     compilation_context->Prepare(*having_clause);
@@ -203,6 +213,11 @@ void StaticAggregationTranslator::UpdateGlobalAggregate(WorkContext *ctx, Functi
 
   const auto agg_payload = build_pipeline_.IsParallel() ? local_aggs_ : global_aggs_;
 
+  // Aggregates over the same expressions compute them once
+  std::vector<const parser::AbstractExpression *> input_exprs;
+  for (const auto &term : GetAggPlan().GetAggregateTerms()) input_exprs.push_back(term->GetChild(0).Get());
+  ctx->DeriveCommonSubexpressions(input_exprs, this, function);
+
   // var aggValues: AggValues
   auto agg_values = codegen->MakeFreshIdentifier("aggValues");
   function->Append(codegen->DeclareVarNoInit(agg_values, codegen->MakeExpr(agg_values_type_)));
@@ -233,6 +248,69 @@ void StaticAggregationTranslator::UpdateGlobalAggregate(WorkContext *ctx, Functi
       function->Append(agg_advance_call);
     }
   }
+  ctx->ClearCommonSubexpressions();
+}
+
+bool StaticAggregationTranslator::PlanVectorAggregates(const SeqScanTranslator &scan) {
+  for (const auto &term : GetAggPlan().GetAggregateTerms()) {
+    const auto input = term->GetChild(0);
+    if (term->IsDistinct()) {
+      vector_cols_.clear();
+      return false;
+    }
+    if (term->GetExpressionType() == parser::ExpressionType::AGGREGATE_COUNT &&
+        input->GetExpressionType() == parser::ExpressionType::STAR) {
+      vector_cols_.emplace_back(std::nullopt);
+      continue;
+    }
+
+    uint32_t col_idx;
+    bool vectorizable = scan.IsScannedColumn(input, &col_idx);
+    switch (term->GetExpressionType()) {
+      case parser::ExpressionType::AGGREGATE_COUNT:
+        break;
+      case parser::ExpressionType::AGGREGATE_SUM:
+      case parser::ExpressionType::AGGREGATE_MIN:
+      case parser::ExpressionType::AGGREGATE_MAX: {
+        // The vector kernels fold integers and reals only
+        const auto type = input->GetReturnValueType();
+        vectorizable &= type == type::TypeId::TINYINT || type == type::TypeId::SMALLINT ||
+                        type == type::TypeId::INTEGER || type == type::TypeId::BIGINT || type == type::TypeId::REAL;
+        break;
+      }
+      default:
+        vectorizable = false;
+        break;
+    }
+    if (!vectorizable) {
+      vector_cols_.clear();
+      return false;
+    }
+    vector_cols_.emplace_back(col_idx);
+  }
+  return true;
+}
+
+void StaticAggregationTranslator::AdvanceVectorAggregates(FunctionBuilder *function, ast::Expr *vpi) const {
+  auto *codegen = GetCodeGen();
+
+  const auto agg_payload = build_pipeline_.IsParallel() ? local_aggs_ : global_aggs_;
+  for (uint32_t term_idx = 0; term_idx < vector_cols_.size(); term_idx++) {
+    auto agg_payload_ptr = GetAggregateTermPtr(agg_payload.Get(codegen), term_idx);
+    if (const auto col_idx = vector_cols_[term_idx]; col_idx.has_value()) {
+      // @aggAdvanceVector(&aggs.term, vpi, col_idx)
+      function->Append(codegen->AggregatorAdvanceVector(agg_payload_ptr, vpi, *col_idx));
+    } else {
+      // @aggAdvanceVector(&aggs.term, vpi)
+      function->Append(codegen->AggregatorAdvanceVector(agg_payload_ptr, vpi));
+    }
+  }
+
+  // var num_agg_inputs = @vpiSelectedRowCount(vpi)
+  auto num_inputs = codegen->MakeFreshIdentifier("num_agg_inputs");
+  function->Append(
+      codegen->DeclareVarWithInit(num_inputs, codegen->CallBuiltin(ast::Builtin::VPIGetSelectedRowCount, {vpi})));
+  CounterAdd(function, num_agg_inputs_, num_inputs);
 }
 
 void StaticAggregationTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder *function) const {
@@ -307,4 +385,11 @@ ast::Expr *StaticAggregationTranslator::GetChildOutput(WorkContext *context, UNU
   return OperatorTranslator::GetChildOutput(context, child_idx, attr_idx);
 }
 
+void StaticAggregationTranslator::CollectChildPipelineExpressions(
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> *exprs) const {
+  for (const auto &term : GetAggPlan().GetAggregateTerms()) {
+    exprs->push_back(term->GetChild(0));
+  }
+}
+
 }  // namespace noisepage::execution::compiler
@@ -22,7 +22,8 @@ UpdateTranslator::UpdateTranslator(const planner::UpdatePlanNode &plan, Compilat
       table_schema_(GetCodeGen()->GetCatalogAccessor()->GetSchema(plan.GetTableOid())),
       all_oids_(CollectOids(table_schema_)),
       table_pm_(GetCodeGen()->GetCatalogAccessor()->GetTable(plan.GetTableOid())->ProjectionMapForOids(all_oids_)) {
-  pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
+  // Every worker updates through a storage interface of its own, @see transaction::TransactionContext::WorkerScope
+  pipeline->RegisterSource(this, Pipeline::Parallelism::Parallel);
   compilation_context->Prepare(*plan.GetChild(0), pipeline);
 
   for (const auto &clause : plan.GetSetClauses()) {
@@ -35,6 +36,7 @@ UpdateTranslator::UpdateTranslator(const planner::UpdatePlanNode &plan, Compilat
     for (const auto &index_col : index_schema.GetColumns()) {
       compilation_context->Prepare(*index_col.StoredExpression());
     }
+    if (index_schema.Predicate() != nullptr) compilation_context->Prepare(*index_schema.Predicate());
   }
 
   num_updates_ = CounterDeclare("num_updates", pipeline);
@@ -74,9 +76,24 @@ void UpdateTranslator::PerformPipelineWork(WorkContext *context, FunctionBuilder
     // var insert_slot = @tableInsert(&pipelineState.storageInterface)
     GenTableInsert(function);
     const auto &indexes = GetPlanAs<planner::UpdatePlanNode>().GetIndexOids();
+    const auto &child = GetCompilationContext()->LookupTranslator(*op.GetChild(0));
     for (const auto &index_oid : indexes) {
-      GenIndexDelete(function, context, index_oid);
-      GenIndexInsert(context, function, index_oid);
+      const auto predicate = GetCodeGen()->GetCatalogAccessor()->GetIndexSchema(index_oid).Predicate();
+      if (predicate == nullptr) {
+        GenIndexDelete(function, context, index_oid);
+        GenIndexInsert(context, function, index_oid);
+        continue;
+      }
+      // A partial index only has entries for the tuples that satisfy its predicate, so the old and the new version
+      // of the tuple are checked separately
+      {
+        If old_satisfies_predicate(function, context->DeriveValue(*predicate, child));
+        GenIndexDelete(function, context, index_oid);
+      }
+      {
+        If new_satisfies_predicate(function, context->DeriveValue(*predicate, this));
+        GenIndexInsert(context, function, index_oid);
+      }
     }
   } else {
     // Non-indexed updates just update.
@@ -93,6 +110,8 @@ void UpdateTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionB
 }
 
 void UpdateTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+  // The counters of a parallel pipeline are spread over the thread states of its workers
+  if (pipeline.IsParallel()) return;
   if (GetPlanAs<planner::UpdatePlanNode>().GetIndexOids().empty()) {
     FeatureRecord(function, selfdriving::ExecutionOperatingUnitType::UPDATE,
                   selfdriving::ExecutionOperatingUnitFeatureAttribute::NUM_ROWS, pipeline, CounterVal(num_updates_));
@@ -0,0 +1,494 @@
+#include "execution/compiler/operator/window_translator.h"
+
+#include <utility>
+#include <vector>
+
+#include "execution/compiler/compilation_context.h"
+#include "execution/compiler/function_builder.h"
+#include "execution/compiler/if.h"
+#include "execution/compiler/loop.h"
+#include "execution/compiler/work_context.h"
+#include "planner/plannodes/output_schema.h"
+#include "planner/plannodes/window_plan_node.h"
+
+namespace noisepage::execution::compiler {
+
+namespace {
+constexpr const char SORT_ROW_ATTR_PREFIX[] = "attr";
+constexpr const char AGG_ATTR_PREFIX[] = "agg";
+}  // namespace
+
+WindowTranslator::WindowTranslator(const planner::WindowPlanNode &plan, CompilationContext *compilation_context,
+                                   Pipeline *pipeline)
+    : OperatorTranslator(plan, compilation_context, pipeline, selfdriving::ExecutionOperatingUnitType::DUMMY),
+      sort_row_var_(GetCodeGen()->MakeFreshIdentifier("sortRow")),
+      sort_row_type_(GetCodeGen()->MakeFreshIdentifier("SortRow")),
+      lhs_row_(GetCodeGen()->MakeIdentifier("lhs")),
+      rhs_row_(GetCodeGen()->MakeIdentifier("rhs")),
+      lead_row_(GetCodeGen()->MakeFreshIdentifier("leadRow")),
+      compare_partition_func_(
+          GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("ComparePartition"))),
+      compare_order_func_(GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("CompareOrder"))),
+      compare_func_(GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("Compare"))),
+      aggs_var_(GetCodeGen()->MakeFreshIdentifier("windowAggs")),
+      aggs_type_(GetCodeGen()->MakeFreshIdentifier("WindowAggs")),
+      agg_values_var_(GetCodeGen()->MakeFreshIdentifier("windowAggValues")),
+      agg_values_type_(GetCodeGen()->MakeFreshIdentifier("WindowAggValues")),
+      num_partition_rows_(GetCodeGen()->MakeFreshIdentifier("numPartitionRows")),
+      num_peer_groups_(GetCodeGen()->MakeFreshIdentifier("numPeerGroups")),
+      peer_idx_(GetCodeGen()->MakeFreshIdentifier("peerIdx")),
+      build_pipeline_(this, Pipeline::Parallelism::Parallel),
+      current_row_(CurrentRow::Child) {
+  NOISEPAGE_ASSERT(plan.GetChildrenSize() == 1, "Windows expected to have a single child.");
+  // Register this as the source for the pipeline. It must be serial since
+  // the window functions are computed over the sorted partitions in order.
+  pipeline->RegisterSource(this, Pipeline::Parallelism::Serial);
+
+  // The build pipeline must complete before the produce pipeline.
+  pipeline->LinkSourcePipeline(&build_pipeline_);
+
+  // Prepare the child.
+  compilation_context->Prepare(*plan.GetChild(0), &build_pipeline_);
+
+  // Prepare the partition-by terms, the sort keys and the aggregate inputs.
+  for (const auto &term : plan.GetPartitionByTerms()) {
+    compilation_context->Prepare(*term);
+  }
+  for (const auto &[expr, _] : plan.GetSortKeys()) {
+    (void)_;
+    compilation_context->Prepare(*expr);
+  }
+  for (const auto &[type, aggregate] : plan.GetWindowFunctions()) {
+    if (type != planner::WindowFunctionType::AGGREGATE) continue;
+    NOISEPAGE_ASSERT(aggregate != nullptr && aggregate->GetChildren().size() == 1,
+                     "Aggregate window functions should have an aggregate with one child");
+    NOISEPAGE_ASSERT(!aggregate->IsDistinct(), "Distinct aggregate window functions are not supported");
+    compilation_context->Prepare(*aggregate->GetChild(0));
+    advance_func_ = GetCodeGen()->MakeFreshIdentifier(pipeline->CreatePipelineFunctionName("AdvanceAggregates"));
+  }
+
+  // Register a Sorter instance in the global query state.
+  CodeGen *codegen = compilation_context->GetCodeGen();
+  ast::Expr *sorter_type = codegen->BuiltinType(ast::BuiltinType::Sorter);
+  global_sorter_ = compilation_context->GetQueryState()->DeclareStateEntry(codegen, "sorter", sorter_type);
+
+  // Register another Sorter instance in the pipeline-local state if the
+  // build pipeline is parallel.
+  if (build_pipeline_.IsParallel()) {
+    local_sorter_ = build_pipeline_.DeclarePipelineStateEntry("sorter", sorter_type);
+  }
+}
+
+void WindowTranslator::DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) {
+  auto *codegen = GetCodeGen();
+  auto fields = codegen->MakeEmptyFieldList();
+  GetAllChildOutputFields(0, SORT_ROW_ATTR_PREFIX, &fields);
+  decls->push_back(codegen->DeclareStruct(sort_row_type_, std::move(fields)));
+
+  if (advance_func_.IsEmpty()) {
+    return;
+  }
+
+  // The running aggregates, and the inputs they are advanced by.
+  auto agg_fields = codegen->MakeEmptyFieldList();
+  auto value_fields = codegen->MakeEmptyFieldList();
+  const auto &window_functions = GetPlanAs<planner::WindowPlanNode>().GetWindowFunctions();
+  for (uint32_t func_idx = 0; func_idx < window_functions.size(); func_idx++) {
+    const auto &[type, aggregate] = window_functions[func_idx];
+    if (type != planner::WindowFunctionType::AGGREGATE) continue;
+    auto name = codegen->MakeIdentifier(AGG_ATTR_PREFIX + std::to_string(func_idx));
+    const auto ret_type = sql::GetTypeId(aggregate->GetReturnValueType());
+    const auto input_type = sql::GetTypeId(aggregate->GetChild(0)->GetReturnValueType());
+    auto agg_type = codegen->AggregateType(aggregate->GetExpressionType(), ret_type, input_type);
+    agg_fields.push_back(codegen->MakeField(name, agg_type));
+    value_fields.push_back(codegen->MakeField(name, codegen->TplType(input_type)));
+  }
+  decls->push_back(codegen->DeclareStruct(aggs_type_, std::move(agg_fields)));
+  decls->push_back(codegen->DeclareStruct(agg_values_type_, std::move(value_fields)));
+}
+
+void WindowTranslator::GenerateComparisonFunction(FunctionBuilder *function,
+                                                  const std::vector<planner::SortKey> &keys) {
+  auto *codegen = GetCodeGen();
+  WorkContext context(GetCompilationContext(), build_pipeline_);
+  context.SetExpressionCacheEnable(false);
+  for (const auto &[expr, sort_order] : keys) {
+    // NULLs are larger than any value.
+    const int32_t null_ret_value = sort_order == optimizer::OrderByOrderingType::ASC ? 1 : -1;
+    current_row_ = CurrentRow::Lhs;
+    ast::Expr *lhs_null = codegen->CallBuiltin(ast::Builtin::IsValNull, {context.DeriveValue(*expr, this)});
+    current_row_ = CurrentRow::Rhs;
+    ast::Expr *rhs_null = codegen->CallBuiltin(ast::Builtin::IsValNull, {context.DeriveValue(*expr, this)});
+    If check_lhs_null(function, lhs_null);
+    {
+      If check_rhs_not_null(function, codegen->UnaryOp(parsing::Token::Type::BANG, rhs_null));
+      function->Append(codegen->Return(codegen->Const32(null_ret_value)));
+      check_rhs_not_null.EndIf();
+    }
+    check_lhs_null.Else();
+    {
+      current_row_ = CurrentRow::Rhs;
+      If check_rhs_null(function,
+                        codegen->CallBuiltin(ast::Builtin::IsValNull, {context.DeriveValue(*expr, this)}));
+      function->Append(codegen->Return(codegen->Const32(-null_ret_value)));
+      check_rhs_null.EndIf();
+    }
+    check_lhs_null.EndIf();
+
+    // Neither is NULL, or both are and the comparisons below are false.
+    int32_t ret_value = sort_order == optimizer::OrderByOrderingType::ASC ? -1 : 1;
+    for (const auto tok : {parsing::Token::Type::LESS, parsing::Token::Type::GREATER}) {
+      current_row_ = CurrentRow::Lhs;
+      ast::Expr *lhs = context.DeriveValue(*expr, this);
+      current_row_ = CurrentRow::Rhs;
+      ast::Expr *rhs = context.DeriveValue(*expr, this);
+      If check_comparison(function, codegen->Compare(tok, lhs, rhs));
+      {
+        // Return the appropriate value based on ordering.
+        function->Append(codegen->Return(codegen->Const32(ret_value)));
+      }
+      check_comparison.EndIf();
+      ret_value = -ret_value;
+    }
+  }
+  current_row_ = CurrentRow::Child;
+}
+
+void WindowTranslator::GenerateAdvanceFunction(FunctionBuilder *function) {
+  auto *codegen = GetCodeGen();
+  WorkContext context(GetCompilationContext(), *GetPipeline());
+  context.SetExpressionCacheEnable(false);
+  const auto &window_functions = GetPlanAs<planner::WindowPlanNode>().GetWindowFunctions();
+
+  // var windowAggValues: WindowAggValues
+  function->Append(codegen->DeclareVarNoInit(agg_values_var_, codegen->MakeExpr(agg_values_type_)));
+
+  // Fill values from the lead row, then advance the aggregates.
+  current_row_ = CurrentRow::Lead;
+  for (uint32_t func_idx = 0; func_idx < window_functions.size(); func_idx++) {
+    const auto &[type, aggregate] = window_functions[func_idx];
+    if (type != planner::WindowFunctionType::AGGREGATE) continue;
+    ast::Expr *value = context.DeriveValue(*aggregate->GetChild(0), this);
+    function->Append(codegen->Assign(GetAggregateTerm(agg_values_var_, func_idx), value));
+  }
+  for (uint32_t func_idx = 0; func_idx < window_functions.size(); func_idx++) {
+    if (window_functions[func_idx].first != planner::WindowFunctionType::AGGREGATE) continue;
+    function->Append(codegen->AggregatorAdvance(GetAggregateTermPtr(aggs_var_, func_idx),
+                                                GetAggregateTermPtr(agg_values_var_, func_idx)));
+  }
+  current_row_ = CurrentRow::Child;
+}
+
+void WindowTranslator::DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) {
+  auto *codegen = GetCodeGen();
+  const auto &plan = GetPlanAs<planner::WindowPlanNode>();
+  auto make_compare_params = [&]() {
+    return codegen->MakeFieldList({
+        codegen->MakeField(lhs_row_, codegen->PointerType(sort_row_type_)),
+        codegen->MakeField(rhs_row_, codegen->PointerType(sort_row_type_)),
+    });
+  };
+
+  // Partitions are compared in ascending order of their terms.
+  std::vector<planner::SortKey> partition_keys;
+  for (const auto &term : plan.GetPartitionByTerms()) {
+    partition_keys.emplace_back(term, optimizer::OrderByOrderingType::ASC);
+  }
+  FunctionBuilder partition_builder(codegen, compare_partition_func_, make_compare_params(), codegen->Int32Type());
+  {
+    // Generate body.
+    GenerateComparisonFunction(&partition_builder, partition_keys);
+  }
+  decls->push_back(partition_builder.Finish(codegen->Const32(0)));
+
+  FunctionBuilder order_builder(codegen, compare_order_func_, make_compare_params(), codegen->Int32Type());
+  {
+    // Generate body.
+    GenerateComparisonFunction(&order_builder, plan.GetSortKeys());
+  }
+  decls->push_back(order_builder.Finish(codegen->Const32(0)));
+
+  // The sorter orders rows on their partition first.
+  FunctionBuilder builder(codegen, compare_func_, make_compare_params(), codegen->Int32Type());
+  {
+    auto cmp = codegen->MakeFreshIdentifier("cmp");
+    auto lhs = codegen->MakeExpr(lhs_row_), rhs = codegen->MakeExpr(rhs_row_);
+    builder.Append(codegen->DeclareVarWithInit(cmp, codegen->Call(compare_partition_func_, {lhs, rhs})));
+    If check_partition(&builder, codegen->Compare(parsing::Token::Type::BANG_EQUAL, codegen->MakeExpr(cmp),
+                                                  codegen->Const32(0)));
+    builder.Append(codegen->Return(codegen->MakeExpr(cmp)));
+    check_partition.EndIf();
+  }
+  decls->push_back(builder.Finish(codegen->Call(compare_order_func_,
+                                                {codegen->MakeExpr(lhs_row_), codegen->MakeExpr(rhs_row_)})));
+
+  if (!advance_func_.IsEmpty()) {
+    auto params = codegen->MakeFieldList({
+        codegen->MakeField(aggs_var_, codegen->PointerType(aggs_type_)),
+        codegen->MakeField(lead_row_, codegen->PointerType(sort_row_type_)),
+    });
+    FunctionBuilder advance_builder(codegen, advance_func_, std::move(params), codegen->Nil());
+    {
+      // Generate body.
+      GenerateAdvanceFunction(&advance_builder);
+    }
+    decls->push_back(advance_builder.Finish());
+  }
+}
+
+void WindowTranslator::InitializeQueryState(FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  function->Append(codegen->SorterInit(global_sorter_.GetPtr(codegen), GetExecutionContext(), compare_func_,
+                                       sort_row_type_));
+}
+
+void WindowTranslator::TearDownQueryState(FunctionBuilder *function) const {
+  function->Append(GetCodeGen()->SorterFree(global_sorter_.GetPtr(GetCodeGen())));
+}
+
+void WindowTranslator::InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (IsBuildPipeline(pipeline) && build_pipeline_.IsParallel()) {
+    auto *codegen = GetCodeGen();
+    function->Append(codegen->SorterInit(local_sorter_.GetPtr(codegen), GetExecutionContext(), compare_func_,
+                                         sort_row_type_));
+  }
+}
+
+void WindowTranslator::TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (IsBuildPipeline(pipeline) && pipeline.IsParallel()) {
+    function->Append(GetCodeGen()->SorterFree(local_sorter_.GetPtr(GetCodeGen())));
+  }
+}
+
+ast::Expr *WindowTranslator::GetSortRowAttribute(ast::Identifier sort_row, uint32_t attr_idx) const {
+  auto *codegen = GetCodeGen();
+  ast::Identifier attr_name = codegen->MakeIdentifier(SORT_ROW_ATTR_PREFIX + std::to_string(attr_idx));
+  return codegen->AccessStructMember(codegen->MakeExpr(sort_row), attr_name);
+}
+
+ast::Expr *WindowTranslator::GetAggregateTerm(ast::Identifier agg_row, uint32_t func_idx) const {
+  auto *codegen = GetCodeGen();
+  ast::Identifier member = codegen->MakeIdentifier(AGG_ATTR_PREFIX + std::to_string(func_idx));
+  return codegen->AccessStructMember(codegen->MakeExpr(agg_row), member);
+}
+
+ast::Expr *WindowTranslator::GetAggregateTermPtr(ast::Identifier agg_row, uint32_t func_idx) const {
+  return GetCodeGen()->AddressOf(GetAggregateTerm(agg_row, func_idx));
+}
+
+void WindowTranslator::InsertIntoSorter(WorkContext *ctx, FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+
+  // Collect correct sorter instance.
+  const auto sorter = ctx->GetPipeline().IsParallel() ? local_sorter_ : global_sorter_;
+  ast::Expr *insert_call = codegen->SorterInsert(sorter.GetPtr(codegen), sort_row_type_);
+  function->Append(codegen->DeclareVarWithInit(sort_row_var_, insert_call));
+
+  const auto child_schema = GetPlan().GetChild(0)->GetOutputSchema();
+  for (uint32_t attr_idx = 0; attr_idx < child_schema->GetColumns().size(); attr_idx++) {
+    ast::Expr *lhs = GetSortRowAttribute(sort_row_var_, attr_idx);
+    ast::Expr *rhs = GetChildOutput(ctx, 0, attr_idx);
+    function->Append(codegen->Assign(lhs, rhs));
+  }
+}
+
+void WindowTranslator::InitializeAggregates(FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  const auto &window_functions = GetPlanAs<planner::WindowPlanNode>().GetWindowFunctions();
+  for (uint32_t func_idx = 0; func_idx < window_functions.size(); func_idx++) {
+    if (window_functions[func_idx].first != planner::WindowFunctionType::AGGREGATE) continue;
+    function->Append(codegen->AggregatorInit(GetAggregateTermPtr(aggs_var_, func_idx)));
+  }
+}
+
+void WindowTranslator::FreeAggregates(FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+  for (const auto func_idx : GetPlanAs<planner::WindowPlanNode>().GetMemoryAllocatingAggregatorIndexes()) {
+    function->Append(codegen->AggregatorFree(GetAggregateTermPtr(aggs_var_, func_idx)));
+  }
+}
+
+void WindowTranslator::ScanSorter(WorkContext *ctx, FunctionBuilder *function) const {
+  auto *codegen = GetCodeGen();
+
+  // The lead iterator runs ahead to find the end of the current peer group,
+  // the trailing iterator then emits the peer group's rows.
+  auto iter_name = codegen->MakeFreshIdentifier("iter");
+  auto lead_name = codegen->MakeFreshIdentifier("lead");
+  for (const auto name : {iter_name, lead_name}) {
+    auto base_name = codegen->MakeFreshIdentifier("iterBase");
+    function->Append(codegen->DeclareVarNoInit(base_name, ast::BuiltinType::SorterIterator));
+    function->Append(codegen->DeclareVarWithInit(name, codegen->AddressOf(codegen->MakeExpr(base_name))));
+    function->Append(codegen->SorterIterInit(codegen->MakeExpr(name), global_sorter_.GetPtr(codegen)));
+  }
+  auto iter = codegen->MakeExpr(iter_name), lead = codegen->MakeExpr(lead_name);
+
+  // var windowAggs: WindowAggs
+  if (!advance_func_.IsEmpty()) {
+    function->Append(codegen->DeclareVarNoInit(aggs_var_, codegen->MakeExpr(aggs_type_)));
+    InitializeAggregates(function);
+  }
+
+  auto new_partition = codegen->MakeFreshIdentifier("newPartition");
+  auto num_peers = codegen->MakeFreshIdentifier("numPeers");
+  auto in_peer_group = codegen->MakeFreshIdentifier("inPeerGroup");
+  auto peer_row = codegen->MakeFreshIdentifier("peerRow");
+  for (const auto name : {num_partition_rows_, num_peer_groups_, num_peers, peer_idx_}) {
+    function->Append(codegen->DeclareVarNoInit(name, codegen->Int64Type()));
+    function->Append(codegen->Assign(codegen->MakeExpr(name), codegen->Const64(0)));
+  }
+  function->Append(codegen->DeclareVarWithInit(new_partition, codegen->ConstBool(false)));
+  function->Append(codegen->DeclareVarWithInit(in_peer_group, codegen->ConstBool(false)));
+
+  auto increment = [&](ast::Identifier name, ast::Expr *delta) {
+    return codegen->Assign(codegen->MakeExpr(name),
+                           codegen->BinaryOp(parsing::Token::Type::PLUS, codegen->MakeExpr(name), delta));
+  };
+
+  Loop group_loop(function, codegen->SorterIterHasNext(lead));
+  {
+    // var peerRow = @ptrCast(SortRow*, @sorterIterGetRow(iter))
+    function->Append(codegen->DeclareVarWithInit(peer_row, codegen->SorterIterGetRow(iter, sort_row_type_)));
+
+    // Restart the counters and the aggregates at the first row of a partition.
+    If check_new_partition(function, codegen->MakeExpr(new_partition));
+    {
+      function->Append(codegen->Assign(codegen->MakeExpr(num_partition_rows_), codegen->Const64(0)));
+      function->Append(codegen->Assign(codegen->MakeExpr(num_peer_groups_), codegen->Const64(0)));
+      FreeAggregates(function);
+      InitializeAggregates(function);
+      function->Append(codegen->Assign(codegen->MakeExpr(new_partition), codegen->ConstBool(false)));
+    }
+    check_new_partition.EndIf();
+
+    // Advance the lead iterator over the peer group.
+    function->Append(codegen->Assign(codegen->MakeExpr(num_peers), codegen->Const64(0)));
+    function->Append(codegen->Assign(codegen->MakeExpr(in_peer_group), codegen->ConstBool(true)));
+    Loop peer_loop(function, codegen->BinaryOp(parsing::Token::Type::AND, codegen->MakeExpr(in_peer_group),
+                                               codegen->SorterIterHasNext(lead)));
+    {
+      function->Append(codegen->DeclareVarWithInit(lead_row_, codegen->SorterIterGetRow(lead, sort_row_type_)));
+      auto compare = [&](ast::Identifier func) {
+        auto *cmp = codegen->Call(func, {codegen->MakeExpr(peer_row), codegen->MakeExpr(lead_row_)});
+        return codegen->Compare(parsing::Token::Type::BANG_EQUAL, cmp, codegen->Const32(0));
+      };
+      If check_partition(function, compare(compare_partition_func_));
+      {
+        function->Append(codegen->Assign(codegen->MakeExpr(new_partition), codegen->ConstBool(true)));
+        function->Append(codegen->Assign(codegen->MakeExpr(in_peer_group), codegen->ConstBool(false)));
+      }
+      check_partition.Else();
+      {
+        If check_order(function, compare(compare_order_func_));
+        function->Append(codegen->Assign(codegen->MakeExpr(in_peer_group), codegen->ConstBool(false)));
+        check_order.Else();
+        {
+          function->Append(increment(num_peers, codegen->Const64(1)));
+          if (!advance_func_.IsEmpty()) {
+            auto *aggs = codegen->AddressOf(codegen->MakeExpr(aggs_var_));
+            function->Append(codegen->Call(advance_func_, {aggs, codegen->MakeExpr(lead_row_)}));
+          }
+          function->Append(codegen->SorterIterNext(lead));
+        }
+        check_order.EndIf();
+      }
+      check_partition.EndIf();
+    }
+    peer_loop.EndLoop();
+    function->Append(increment(num_peer_groups_, codegen->Const64(1)));
+
+    // Emit the peer group's rows.
+    Loop emit_loop(function, codegen->Assign(codegen->MakeExpr(peer_idx_), codegen->Const64(0)),
+                   codegen->Compare(parsing::Token::Type::LESS, codegen->MakeExpr(peer_idx_),
+                                    codegen->MakeExpr(num_peers)),
+                   increment(peer_idx_, codegen->Const64(1)));
+    {
+      // var sortRow = @ptrCast(SortRow*, @sorterIterGetRow(iter))
+      function->Append(codegen->DeclareVarWithInit(sort_row_var_, codegen->SorterIterGetRow(iter, sort_row_type_)));
+      // Move along
+      ctx->Push(function);
+      function->Append(codegen->SorterIterNext(iter));
+    }
+    emit_loop.EndLoop();
+    function->Append(increment(num_partition_rows_, codegen->MakeExpr(num_peers)));
+  }
+  group_loop.EndLoop();
+
+  // @sorterIterClose()
+  function->Append(codegen->SorterIterClose(iter));
+  function->Append(codegen->SorterIterClose(lead));
+  FreeAggregates(function);
+}
+
+void WindowTranslator::PerformPipelineWork(WorkContext *ctx, FunctionBuilder *function) const {
+  if (IsScanPipeline(ctx->GetPipeline())) {
+    ScanSorter(ctx, function);
+  } else {
+    NOISEPAGE_ASSERT(IsBuildPipeline(ctx->GetPipeline()), "Pipeline is unknown to window translator");
+    InsertIntoSorter(ctx, function);
+  }
+}
+
+void WindowTranslator::FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const {
+  if (IsBuildPipeline(pipeline)) {
+    auto *codegen = GetCodeGen();
+    ast::Expr *sorter_ptr = global_sorter_.GetPtr(codegen);
+    if (build_pipeline_.IsParallel()) {
+      ast::Expr *offset = local_sorter_.OffsetFromState(codegen);
+      function->Append(codegen->SortParallel(sorter_ptr, GetThreadStateContainer(), offset));
+    } else {
+      function->Append(codegen->SorterSort(sorter_ptr));
+    }
+  }
+}
+
+ast::Expr *WindowTranslator::GetWindowValue(uint32_t func_idx) const {
+  auto *codegen = GetCodeGen();
+  const auto &[type, aggregate] = GetPlanAs<planner::WindowPlanNode>().GetWindowFunctions()[func_idx];
+  auto one = codegen->Const64(1);
+  switch (type) {
+    case planner::WindowFunctionType::ROW_NUMBER: {
+      auto *row_idx = codegen->BinaryOp(parsing::Token::Type::PLUS, codegen->MakeExpr(num_partition_rows_),
+                                        codegen->MakeExpr(peer_idx_));
+      auto *row_number = codegen->BinaryOp(parsing::Token::Type::PLUS, row_idx, one);
+      return codegen->CallBuiltin(ast::Builtin::IntToSql, {row_number});
+    }
+    case planner::WindowFunctionType::RANK: {
+      auto *rank = codegen->BinaryOp(parsing::Token::Type::PLUS, codegen->MakeExpr(num_partition_rows_), one);
+      return codegen->CallBuiltin(ast::Builtin::IntToSql, {rank});
+    }
+    case planner::WindowFunctionType::DENSE_RANK:
+      return codegen->CallBuiltin(ast::Builtin::IntToSql, {codegen->MakeExpr(num_peer_groups_)});
+    case planner::WindowFunctionType::AGGREGATE:
+      return codegen->AggregatorResult(GetExecutionContext(), GetAggregateTermPtr(aggs_var_, func_idx),
+                                       aggregate->GetExpressionType());
+    default:
+      UNREACHABLE("Unknown window function type");
+  }
+}
+
+ast::Expr *WindowTranslator::GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const {
+  if (child_idx == 1) {
+    NOISEPAGE_ASSERT(IsScanPipeline(context->GetPipeline()), "Window functions are only computed in the scan");
+    return GetWindowValue(attr_idx);
+  }
+
+  switch (current_row_) {
+    case CurrentRow::Lhs:
+      return GetSortRowAttribute(lhs_row_, attr_idx);
+    case CurrentRow::Rhs:
+      return GetSortRowAttribute(rhs_row_, attr_idx);
+    case CurrentRow::Lead:
+      return GetSortRowAttribute(lead_row_, attr_idx);
+    case CurrentRow::Child: {
+      if (IsScanPipeline(context->GetPipeline())) {
+        return GetSortRowAttribute(sort_row_var_, attr_idx);
+      }
+      NOISEPAGE_ASSERT(IsBuildPipeline(context->GetPipeline()), "Pipeline not known to window");
+      return OperatorTranslator::GetChildOutput(context, child_idx, attr_idx);
+    }
+  }
+  UNREACHABLE("Impossible output row option");
+}
+
+}  // namespace noisepage::execution::compiler
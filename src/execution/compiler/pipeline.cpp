@@ -140,6 +140,17 @@ void Pipeline::InjectEndResourceTracker(FunctionBuilder *builder, bool is_hook)
   }
 }
 
+void Pipeline::InjectOperatorRowCounter(FunctionBuilder *builder, const OperatorTranslator *op) const {
+  // The step consuming the rows of the pipeline has no counter
+  const auto step = std::find(steps_.begin(), steps_.end(), op) - steps_.begin();
+  if (compilation_context_->IsProfilingEnabled() && step > 0) {
+    // rows = rows + 1
+    ast::Expr *counter = operator_rows_[step].Get(codegen_);
+    ast::Expr *plus = codegen_->BinaryOp(parsing::Token::Type::PLUS, counter, codegen_->Const64(1));
+    builder->Append(codegen_->Assign(operator_rows_[step].Get(codegen_), plus));
+  }
+}
+
 util::RegionVector<ast::FieldDecl *> Pipeline::PipelineParams() const {
   // The main query parameters.
   util::RegionVector<ast::FieldDecl *> query_params = compilation_context_->QueryParams();
@@ -167,6 +178,14 @@ void Pipeline::Prepare(const exec::ExecutionSettings &exec_settings) {
     ast::Expr *type = codegen_->BuiltinType(ast::BuiltinType::ExecOUFeatureVector);
     oufeatures_ = DeclarePipelineStateEntry("execFeatures", type);
   }
+  if (compilation_context_->IsProfilingEnabled()) {
+    // Steps are registered from the last to the first, so the first step registered consumes the rows
+    operator_rows_.resize(steps_.size());
+    for (std::size_t step = 1; step < steps_.size(); step++) {
+      ast::Expr *type = codegen_->BuiltinType(ast::BuiltinType::Uint64);
+      operator_rows_[step] = DeclarePipelineStateEntry(fmt::format("operatorRows{}", step), type);
+    }
+  }
   state_.ConstructFinalType(codegen_);
 
   // Finalize the execution mode. We choose serial execution if ANY of the below
@@ -208,6 +227,12 @@ ast::FunctionDecl *Pipeline::GenerateSetupPipelineStateFunction() const {
     for (auto *op : steps_) {
       op->InitializePipelineState(*this, &builder);
     }
+
+    if (compilation_context_->IsProfilingEnabled()) {
+      for (std::size_t step = 1; step < steps_.size(); step++) {
+        builder.Append(codegen_->Assign(operator_rows_[step].Get(codegen_), codegen_->Const64(0)));
+      }
+    }
   }
   return builder.Finish();
 }
@@ -222,6 +247,18 @@ ast::FunctionDecl *Pipeline::GenerateTearDownPipelineStateFunction() const {
       op->TearDownPipelineState(*this, &builder);
     }
 
+    if (compilation_context_->IsProfilingEnabled()) {
+      // Report the rows this thread counted
+      auto *exec_ctx = compilation_context_->GetExecutionContextPtrFromQueryState();
+      for (std::size_t step = 1; step < steps_.size(); step++) {
+        auto plan_node_id = steps_[step]->GetPlan().GetPlanNodeId().UnderlyingValue();
+        std::vector<ast::Expr *> args{exec_ctx, codegen_->Const64(GetPipelineId().UnderlyingValue()),
+                                      codegen_->Const64(plan_node_id), operator_rows_[step].Get(codegen_)};
+        auto call = codegen_->CallBuiltin(ast::Builtin::ExecutionContextRecordOperatorRows, args);
+        builder.Append(codegen_->MakeStmt(call));
+      }
+    }
+
     if (compilation_context_->IsPipelineMetricsEnabled()) {
       // Reset the pipeline features
       auto args = {oufeatures_.GetPtr(codegen_)};
@@ -294,6 +331,13 @@ ast::FunctionDecl *Pipeline::GenerateRunPipelineFunction() const {
     // Begin a new code scope for fresh variables.
     CodeGen::CodeScope code_scope(codegen_);
 
+    if (compilation_context_->IsProfilingEnabled()) {
+      auto args = {compilation_context_->GetExecutionContextPtrFromQueryState(),
+                   codegen_->Const64(GetPipelineId().UnderlyingValue())};
+      auto call = codegen_->CallBuiltin(ast::Builtin::ExecutionContextStartPipelineProfile, args);
+      builder.Append(codegen_->MakeStmt(call));
+    }
+
     // TODO(abalakum): This shouldn't actually be dependent on order and the loop can be simplified
     // after issue #1154 is fixed
     // Let the operators perform some initialization work in this pipeline.
@@ -329,6 +373,13 @@ ast::FunctionDecl *Pipeline::GenerateRunPipelineFunction() const {
     if (started_tracker) {
       InjectEndResourceTracker(&builder, false);
     }
+
+    if (compilation_context_->IsProfilingEnabled()) {
+      auto args = {compilation_context_->GetExecutionContextPtrFromQueryState(),
+                   codegen_->Const64(GetPipelineId().UnderlyingValue())};
+      auto call = codegen_->CallBuiltin(ast::Builtin::ExecutionContextEndPipelineProfile, args);
+      builder.Append(codegen_->MakeStmt(call));
+    }
   }
 
   return builder.Finish();
@@ -362,10 +413,10 @@ void Pipeline::GeneratePipeline(ExecutableQueryFragmentBuilder *builder) const {
   builder->DeclareFunction(GeneratePipelineWorkFunction());
 
   // Register the main init, run, tear-down functions as steps, in that order.
-  builder->RegisterStep(GenerateInitPipelineFunction());
-  builder->RegisterStep(GenerateRunPipelineFunction());
+  builder->RegisterStep(GenerateInitPipelineFunction(), GetPipelineId());
+  builder->RegisterStep(GenerateRunPipelineFunction(), GetPipelineId());
   auto teardown = GenerateTearDownPipelineFunction();
-  builder->RegisterStep(teardown);
+  builder->RegisterStep(teardown, GetPipelineId());
   builder->AddTeardownFn(teardown);
 }
 
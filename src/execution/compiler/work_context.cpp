@@ -1,8 +1,14 @@
 #include "execution/compiler/work_context.h"
 
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+#include "execution/compiler/codegen.h"
 #include "execution/compiler/compilation_context.h"
 #include "execution/compiler/operator/operator_translator.h"
 #include "execution/compiler/pipeline.h"
+#include "parser/expression/abstract_expression.h"
 
 namespace noisepage::execution::compiler {
 
@@ -14,6 +20,9 @@ WorkContext::WorkContext(CompilationContext *compilation_context, const Pipeline
       cache_enabled_(true) {}
 
 ast::Expr *WorkContext::DeriveValue(const parser::AbstractExpression &expr, const ColumnValueProvider *provider) {
+  if (auto iter = overrides_.find(&expr); iter != overrides_.end()) {
+    return iter->second;
+  }
   if (cache_enabled_) {
     if (auto iter = cache_.find(CacheKey_t{&expr, provider}); iter != cache_.end()) {
       return iter->second;
@@ -28,7 +37,61 @@ ast::Expr *WorkContext::DeriveValue(const parser::AbstractExpression &expr, cons
   return result;
 }
 
+void WorkContext::DeriveCommonSubexpressions(const std::vector<const parser::AbstractExpression *> &exprs,
+                                             const ColumnValueProvider *provider, FunctionBuilder *function) {
+  // The occurrences of every subexpression, in post-order so that inner subexpressions are evaluated first
+  struct Occurrences {
+    common::hash_t hash_;
+    std::vector<const parser::AbstractExpression *> exprs_;
+  };
+  std::vector<Occurrences> subexprs;
+  std::function<void(const parser::AbstractExpression &)> collect = [&](const parser::AbstractExpression &expr) {
+    // Leaves are cheap to derive, and overridden expressions are evaluated already
+    if (expr.GetChildrenSize() == 0 || overrides_.count(&expr) != 0) return;
+    switch (expr.GetExpressionType()) {
+      case parser::ExpressionType::OPERATOR_CASE_EXPR:
+      case parser::ExpressionType::CONJUNCTION_AND:
+      case parser::ExpressionType::CONJUNCTION_OR:
+      case parser::ExpressionType::FUNCTION:
+        return;
+      default:
+        break;
+    }
+    for (const auto &child : expr.GetChildren()) collect(*child);
+    const common::hash_t hash = expr.Hash();
+    auto iter = std::find_if(subexprs.begin(), subexprs.end(), [&](const Occurrences &occurrences) {
+      return occurrences.hash_ == hash && *occurrences.exprs_[0] == expr;
+    });
+    if (iter == subexprs.end()) {
+      subexprs.push_back({hash, {&expr}});
+    } else {
+      iter->exprs_.push_back(&expr);
+    }
+  };
+  for (const auto *expr : exprs) collect(*expr);
+
+  auto *codegen = compilation_context_->GetCodeGen();
+  for (const auto &occurrences : subexprs) {
+    if (occurrences.exprs_.size() < 2) continue;
+    // var cse = expr
+    auto var = codegen->MakeFreshIdentifier("cse");
+    function->Append(codegen->DeclareVarWithInit(var, DeriveValue(*occurrences.exprs_[0], provider)));
+    for (const auto *expr : occurrences.exprs_) {
+      overrides_[expr] = codegen->MakeExpr(var);
+      common_subexprs_.push_back(expr);
+    }
+  }
+}
+
+void WorkContext::ClearCommonSubexpressions() {
+  for (const auto *expr : common_subexprs_) overrides_.erase(expr);
+  common_subexprs_.clear();
+  // The cached values of the expressions around them refer to the variables too
+  cache_.clear();
+}
+
 void WorkContext::Push(FunctionBuilder *function) {
+  pipeline_.InjectOperatorRowCounter(function, *pipeline_iter_);
   if (++pipeline_iter_ == pipeline_end_) {
     return;
   }
@@ -1,7 +1,11 @@
 #include "execution/exec/execution_context.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "common/error/error_code.h"
 #include "common/thread_context.h"
+#include "execution/exec/task_scheduler.h"
 #include "execution/sql/value.h"
 #include "metrics/metrics_manager.h"
 #include "metrics/metrics_store.h"
@@ -14,6 +18,12 @@
 
 namespace noisepage::execution::exec {
 
+ExecutionContext::~ExecutionContext() {
+  if (is_admitted_for_parallel_execution_) {
+    TaskScheduler::ReleaseQuery();
+  }
+}
+
 OutputBuffer *ExecutionContext::OutputBufferNew() {
   if (schema_ == nullptr) {
     return nullptr;
@@ -144,6 +154,29 @@ void ExecutionContext::EndPipelineTracker(query_id_t query_id, pipeline_id_t pip
   }
 }
 
+int64_t ExecutionContext::ScaleSampledCount(int64_t count) const {
+  return std::llround(static_cast<double>(count) * sample_scale_);
+}
+
+int64_t ExecutionContext::ScaleSampledDistinct(int64_t num_distinct, int64_t count) const {
+  // Like PostgreSQL, a column whose values are more than 10% distinct in the sample is taken to scale with the table
+  if (num_distinct * 10 <= count) return num_distinct;
+  return std::min(ScaleSampledCount(num_distinct), ScaleSampledCount(count));
+}
+
+void ExecutionContext::StartPipelineProfile(pipeline_id_t pipeline_id) {
+  query_profile_->StartPipeline(pipeline_id, mem_tracker_->GetTotalAllocatedSize());
+}
+
+void ExecutionContext::EndPipelineProfile(pipeline_id_t pipeline_id) {
+  query_profile_->EndPipeline(pipeline_id, mem_tracker_->GetTotalAllocatedSize());
+}
+
+void ExecutionContext::RecordOperatorRows(pipeline_id_t pipeline_id, planner::plan_node_id_t plan_node_id,
+                                          uint64_t num_rows) {
+  query_profile_->AddOperatorRows(pipeline_id, plan_node_id, num_rows);
+}
+
 void ExecutionContext::InitializeOUFeatureVector(selfdriving::ExecOUFeatureVector *ouvec, pipeline_id_t pipeline_id) {
   auto *vec = new (ouvec) selfdriving::ExecOUFeatureVector();
   vec->pipeline_id_ = pipeline_id;
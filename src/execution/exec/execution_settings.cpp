@@ -10,6 +10,16 @@ void ExecutionSettings::UpdateFromSettingsManager(common::ManagedPointer<setting
     number_of_parallel_execution_threads_ = settings->GetInt(settings::Param::num_parallel_execution_threads);
     is_counters_enabled_ = settings->GetBool(settings::Param::counters_enable);
     is_pipeline_metrics_enabled_ = settings->GetBool(settings::Param::pipeline_metrics_enable);
+    aggregation_memory_budget_ = settings->GetInt64(settings::Param::aggregation_memory_budget);
+    aggregation_bypass_threshold_ = settings->GetInt64(settings::Param::aggregation_bypass_threshold);
+    join_memory_budget_ = settings->GetInt64(settings::Param::join_memory_budget);
+    sort_memory_budget_ = settings->GetInt64(settings::Param::sort_memory_budget);
+    join_build_partition_bits_ = settings->GetInt64(settings::Param::join_build_partition_bits);
+    is_join_compact_layout_enabled_ = settings->GetBool(settings::Param::join_compact_layout);
+    max_parallel_queries_ = settings->GetInt(settings::Param::max_parallel_queries);
+    query_memory_budget_ = settings->GetInt64(settings::Param::query_memory_budget);
+    statement_timeout_ = settings->GetInt(settings::Param::statement_timeout);
+    analyze_sample_blocks_ = settings->GetInt(settings::Param::analyze_sample_blocks);
   }
 }
 
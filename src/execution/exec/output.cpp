@@ -92,13 +92,23 @@ void OutputPrinter::operator()(byte *tuples, uint32_t num_tuples, uint32_t tuple
   printed_++;
 }
 
+OutputWriter::OutputWriter(const common::ManagedPointer<planner::OutputSchema> schema,
+                           const common::ManagedPointer<network::PostgresPacketWriter> out,
+                           const std::vector<network::FieldFormat> &field_formats, const bool copy_out)
+    : schema_(schema),
+      out_(out),
+      field_formats_(field_formats),
+      copy_out_(copy_out),
+      layout_(network::PostgresPacketWriter::MakeDataRowLayout(schema->GetColumns(), field_formats)) {}
+
 void OutputWriter::operator()(byte *tuples, uint32_t num_tuples, uint32_t tuple_size) {
   std::scoped_lock latch(output_synchronization_);
 
   // Write out the rows for this batch
-  for (uint32_t row = 0; row < num_tuples; row++) {
-    const byte *const tuple = tuples + row * tuple_size;
-    out_->WriteDataRow(tuple, schema_->GetColumns(), field_formats_);
+  if (copy_out_) {
+    out_->WriteBinaryCopyRows(tuples, num_tuples, tuple_size, layout_);
+  } else {
+    out_->WriteDataRows(tuples, num_tuples, tuple_size, layout_);
   }
 
   num_rows_ += num_tuples;
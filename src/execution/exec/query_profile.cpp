@@ -0,0 +1,58 @@
+#include "execution/exec/query_profile.h"
+
+#include <x86intrin.h>
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+
+namespace noisepage::execution::exec {
+
+namespace {
+
+uint64_t NowNanoseconds() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+}  // namespace
+
+void QueryProfile::StartPipeline(const pipeline_id_t pipeline_id, const int64_t memory_bytes) {
+  running_pipelines_[pipeline_id] = RunningPipeline{__rdtsc(), NowNanoseconds(), memory_bytes};
+}
+
+void QueryProfile::EndPipeline(const pipeline_id_t pipeline_id, const int64_t memory_bytes) {
+  const uint64_t end_cycles = __rdtsc(), end_nanoseconds = NowNanoseconds();
+  auto iter = running_pipelines_.find(pipeline_id);
+  NOISEPAGE_ASSERT(iter != running_pipelines_.end(), "Pipeline profile ended without being started");
+  const RunningPipeline &running = iter->second;
+
+  if (pipelines_.find(pipeline_id) == pipelines_.end()) pipeline_ids_.push_back(pipeline_id);
+  PipelineProfile &profile = pipelines_[pipeline_id];
+  profile.cycles_ += end_cycles - running.start_cycles_;
+  profile.nanoseconds_ += end_nanoseconds - running.start_nanoseconds_;
+  profile.memory_bytes_ += memory_bytes - running.start_memory_bytes_;
+  running_pipelines_.erase(iter);
+}
+
+void QueryProfile::AddOperatorRows(const pipeline_id_t pipeline_id, const planner::plan_node_id_t plan_node_id,
+                                   const uint64_t num_rows) {
+  std::lock_guard guard(operators_mutex_);
+  OperatorProfile &profile = operators_[plan_node_id];
+  profile.rows_ += num_rows;
+  if (std::find(profile.pipelines_.begin(), profile.pipelines_.end(), pipeline_id) == profile.pipelines_.end()) {
+    profile.pipelines_.push_back(pipeline_id);
+  }
+}
+
+const QueryProfile::PipelineProfile *QueryProfile::GetPipelineProfile(const pipeline_id_t pipeline_id) const {
+  auto iter = pipelines_.find(pipeline_id);
+  return iter == pipelines_.end() ? nullptr : &iter->second;
+}
+
+const QueryProfile::OperatorProfile *QueryProfile::GetOperatorProfile(
+    const planner::plan_node_id_t plan_node_id) const {
+  auto iter = operators_.find(plan_node_id);
+  return iter == operators_.end() ? nullptr : &iter->second;
+}
+
+}  // namespace noisepage::execution::exec
@@ -0,0 +1,135 @@
+#include "execution/exec/sampling_profiler.h"
+
+#include <sys/time.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <vector>
+
+#include "metrics/metrics_sink.h"
+
+namespace noisepage::execution::exec {
+
+namespace {
+
+// Samples are counted under the tag packed into a key, offset by one so that 0 means no tag
+uint64_t TagToKey(const SamplingProfiler::Tag &tag) {
+  return ((static_cast<uint64_t>(tag.query_id_) << 32) | tag.pipeline_id_) + 1;
+}
+
+SamplingProfiler::Tag KeyToTag(const uint64_t key) {
+  return {static_cast<uint32_t>((key - 1) >> 32), static_cast<uint32_t>(key - 1)};
+}
+
+// The key of the tag of the thread. Only the thread itself reads it, from the signal handler.
+thread_local uint64_t thread_key = 0;
+
+std::atomic<bool> running{false};
+std::atomic<uint64_t> num_samples{0};
+
+// An open addressing hash table from the keys of tags to their numbers of samples. Keys are only ever added, with a
+// compare and swap, so the signal handler counts a sample without locks or allocation.
+std::array<std::atomic<uint64_t>, SamplingProfiler::MAX_TAGS> keys{};
+std::array<std::atomic<uint64_t>, SamplingProfiler::MAX_TAGS> counts{};
+
+void CountSample(const uint64_t key) {
+  uint32_t slot = static_cast<uint32_t>((key * 0x9E3779B97F4A7C15ULL) >> 32) % SamplingProfiler::MAX_TAGS;
+  for (uint32_t probe = 0; probe < SamplingProfiler::MAX_TAGS; probe++) {
+    uint64_t slot_key = keys[slot].load(std::memory_order_relaxed);
+    if (slot_key == 0 && keys[slot].compare_exchange_strong(slot_key, key, std::memory_order_relaxed)) slot_key = key;
+    if (slot_key == key) {
+      counts[slot].fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    slot = (slot + 1) % SamplingProfiler::MAX_TAGS;
+  }
+}
+
+void HandleSample(int signal UNUSED_ATTRIBUTE) {
+  const int saved_errno = errno;
+  num_samples.fetch_add(1, std::memory_order_relaxed);
+  const uint64_t key = thread_key;
+  if (key != 0) CountSample(key);
+  errno = saved_errno;
+}
+
+void SetTimer(const uint32_t interval_us) {
+  itimerval timer{};
+  timer.it_interval.tv_sec = interval_us / 1000000;
+  timer.it_interval.tv_usec = interval_us % 1000000;
+  timer.it_value = timer.it_interval;
+  setitimer(ITIMER_PROF, &timer, nullptr);
+}
+
+}  // namespace
+
+SamplingProfiler::TagScope::TagScope(const Tag tag) : previous_(thread_key) {
+  thread_key = TagToKey(tag);
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+SamplingProfiler::TagScope::~TagScope() {
+  thread_key = previous_;
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+void SamplingProfiler::SetThreadTag(const Tag *const tag) {
+  thread_key = tag == nullptr ? 0 : TagToKey(*tag);
+  std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+void SamplingProfiler::Start(const uint32_t frequency_hz) {
+  NOISEPAGE_ASSERT(frequency_hz > 0 && frequency_hz <= 1000000, "Invalid sampling frequency.");
+  Stop();
+  for (uint32_t slot = 0; slot < MAX_TAGS; slot++) {
+    keys[slot].store(0, std::memory_order_relaxed);
+    counts[slot].store(0, std::memory_order_relaxed);
+  }
+  num_samples.store(0, std::memory_order_relaxed);
+
+  struct sigaction action {};
+  action.sa_handler = HandleSample;
+  sigemptyset(&action.sa_mask);
+  // Sampling must not fail the system calls of the threads it interrupts
+  action.sa_flags = SA_RESTART;
+  sigaction(SIGPROF, &action, nullptr);
+  // The timer counts the CPU time of the whole process, and the kernel signals the thread that used up the interval
+  SetTimer(1000000 / frequency_hz);
+  running.store(true);
+}
+
+void SamplingProfiler::Stop() {
+  if (!running.exchange(false)) return;
+  SetTimer(0);
+  // A SIGPROF that is still pending would terminate the process with the default action
+  signal(SIGPROF, SIG_IGN);
+}
+
+bool SamplingProfiler::IsRunning() { return running.load(); }
+
+std::vector<SamplingProfiler::Samples> SamplingProfiler::GetSamples() {
+  std::vector<Samples> samples;
+  for (uint32_t slot = 0; slot < MAX_TAGS; slot++) {
+    const uint64_t key = keys[slot].load(std::memory_order_relaxed);
+    const uint64_t count = counts[slot].load(std::memory_order_relaxed);
+    if (key != 0 && count != 0) samples.push_back({KeyToTag(key), count});
+  }
+  std::sort(samples.begin(), samples.end(), [](const Samples &a, const Samples &b) {
+    return a.count_ != b.count_ ? a.count_ > b.count_ : TagToKey(a.tag_) < TagToKey(b.tag_);
+  });
+  return samples;
+}
+
+uint64_t SamplingProfiler::NumSamples() { return num_samples.load(std::memory_order_relaxed); }
+
+void SamplingProfiler::Write(metrics::MetricsRowWriter *const writer) {
+  for (const auto &samples : GetSamples()) {
+    *writer << samples.tag_.query_id_ << samples.tag_.pipeline_id_ << samples.count_;
+    writer->EndRow();
+  }
+}
+
+}  // namespace noisepage::execution::exec
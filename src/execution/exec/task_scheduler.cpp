@@ -0,0 +1,69 @@
+#include "execution/exec/task_scheduler.h"
+
+#include <tbb/task_scheduler_init.h>
+
+#include <atomic>
+
+#include "execution/sql/memory_pool.h"
+#include "execution/sql/memory_tracker.h"
+
+namespace noisepage::execution::exec {
+
+namespace {
+
+// Number of queries holding a slot to run parallel steps
+std::atomic<uint32_t> num_parallel_queries{0};
+
+// Number of pool workers held by running steps
+std::atomic<uint32_t> num_busy_workers{0};
+
+}  // namespace
+
+uint32_t TaskScheduler::NumWorkerThreads() {
+  return static_cast<uint32_t>(tbb::task_scheduler_init::default_num_threads());
+}
+
+uint32_t TaskScheduler::MaxConcurrency(const ExecutionSettings &exec_settings) {
+  // A non-positive setting leaves the query the whole pool
+  const int num_threads = exec_settings.GetNumberOfParallelExecutionThreads();
+  if (num_threads <= 0) return NumWorkerThreads();
+  return std::min(static_cast<uint32_t>(num_threads), NumWorkerThreads());
+}
+
+void TaskScheduler::ReleaseQuery() { num_parallel_queries.fetch_sub(1); }
+
+uint32_t TaskScheduler::AdmitStep(ExecutionContext *exec_ctx, uint64_t num_tasks) {
+  const auto &exec_settings = exec_ctx->GetExecutionSettings();
+  const uint32_t wanted = static_cast<uint32_t>(std::min<uint64_t>(MaxConcurrency(exec_settings), num_tasks));
+  if (wanted <= 1) return 1;
+
+  // Every thread of a parallel step holds its own state, so a query over its
+  // memory budget does not fan out any further
+  const int64_t memory_budget = exec_settings.GetQueryMemoryBudget();
+  if (memory_budget > 0 && exec_ctx->GetMemoryPool()->GetTracker()->GetTotalAllocatedSize() > memory_budget) {
+    return 1;
+  }
+
+  if (!exec_ctx->IsAdmittedForParallelExecution()) {
+    const auto max_queries = static_cast<uint32_t>(std::max(exec_settings.GetMaxParallelQueries(), 0));
+    uint32_t num_queries = num_parallel_queries.load();
+    do {
+      if (max_queries != 0 && num_queries >= max_queries) return 1;
+    } while (!num_parallel_queries.compare_exchange_weak(num_queries, num_queries + 1));
+    exec_ctx->SetAdmittedForParallelExecution();
+  }
+
+  // The query's own thread runs the step too, so it only takes the workers
+  // beyond that one
+  const uint32_t num_workers = NumWorkerThreads();
+  uint32_t num_busy = num_busy_workers.load();
+  uint32_t num_taken;
+  do {
+    num_taken = std::min(wanted - 1, num_workers - std::min(num_busy, num_workers));
+  } while (!num_busy_workers.compare_exchange_weak(num_busy, num_busy + num_taken));
+  return num_taken + 1;
+}
+
+void TaskScheduler::ReleaseStep(const uint32_t concurrency) { num_busy_workers.fetch_sub(concurrency - 1); }
+
+}  // namespace noisepage::execution::exec
@@ -342,6 +342,20 @@ void Sema::CheckBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builti
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
+    case ast::Builtin::AggHashTableInternString: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // Second argument is a pointer to the string key of a new group
+      const auto string_kind = ast::BuiltinType::StringVal;
+      if (!IsPointerToSpecificBuiltin(args[1]->GetType(), string_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(string_kind)->PointerTo());
+        return;
+      }
+      // Return nothing
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
     case ast::Builtin::AggHashTableLookup: {
       if (!CheckArgCount(call, 4)) {
         return;
@@ -361,6 +375,55 @@ void Sema::CheckBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builti
       call->SetType(GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
       break;
     }
+    case ast::Builtin::AggHashTableSetDenseDomain: {
+      if (!CheckArgCount(call, 3)) {
+        return;
+      }
+      // Second argument is the smallest key, third the number of keys
+      const auto int64_type = GetBuiltinType(ast::BuiltinType::Int64);
+      const auto uint32_type = GetBuiltinType(ast::BuiltinType::Uint32);
+      if (!args[1]->GetType()->IsIntegerType()) {
+        ReportIncorrectCallArg(call, 1, int64_type);
+        return;
+      }
+      if (!args[2]->GetType()->IsIntegerType()) {
+        ReportIncorrectCallArg(call, 2, uint32_type);
+        return;
+      }
+      if (args[1]->GetType() != int64_type) {
+        call->SetArgument(1, ImplCastExprToType(args[1], int64_type, ast::CastKind::IntegralCast));
+      }
+      if (args[2]->GetType() != uint32_type) {
+        call->SetArgument(2, ImplCastExprToType(args[2], uint32_type, ast::CastKind::IntegralCast));
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::AggHashTableLookupDense:
+    case ast::Builtin::AggHashTableInsertDense: {
+      const bool is_insert = builtin == ast::Builtin::AggHashTableInsertDense;
+      if (!CheckArgCount(call, is_insert ? 3 : 2)) {
+        return;
+      }
+      // Second argument is the SQL integer key
+      const auto integer_kind = ast::BuiltinType::Integer;
+      if (!args[1]->GetType()->IsSpecificBuiltin(integer_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(integer_kind));
+        return;
+      }
+      if (!is_insert) {
+        // Return a byte pointer
+        call->SetType(GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+        break;
+      }
+      // Third argument is the payload, but any pointer will do
+      if (!args[2]->GetType()->IsPointerType()) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
     case ast::Builtin::AggHashTableProcessBatch: {
       if (!CheckArgCount(call, 6)) {
         return;
@@ -584,6 +647,49 @@ void Sema::CheckBuiltinAggregatorCall(ast::CallExpr *call, ast::Builtin builtin)
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
+    case ast::Builtin::AggAdvanceVector: {
+      if (!CheckArgCountBetween(call, 2, 3)) {
+        return;
+      }
+      // First argument must be a SQL aggregator over numbers, or a count
+      if (!IsPointerToAggregatorValue(args[0]->GetType())) {
+        GetErrorReporter()->Report(call->Position(), ErrorMessages::kNotASQLAggregate, args[0]->GetType());
+        return;
+      }
+      const auto agg_kind = args[0]->GetType()->GetPointeeType()->As<ast::BuiltinType>()->GetKind();
+      switch (agg_kind) {
+        case ast::BuiltinType::Kind::CountAggregate:
+          break;
+        case ast::BuiltinType::Kind::IntegerSumAggregate:
+        case ast::BuiltinType::Kind::IntegerMaxAggregate:
+        case ast::BuiltinType::Kind::IntegerMinAggregate:
+        case ast::BuiltinType::Kind::RealSumAggregate:
+        case ast::BuiltinType::Kind::RealMaxAggregate:
+        case ast::BuiltinType::Kind::RealMinAggregate:
+          // Only counts advance by every tuple, without a column
+          if (!CheckArgCount(call, 3)) {
+            return;
+          }
+          break;
+        default:
+          ReportIncorrectCallArg(call, 0, "COUNT, SUM, MIN or MAX aggregate");
+          return;
+      }
+      // Second argument is the input VPI
+      const auto vpi_kind = ast::BuiltinType::VectorProjectionIterator;
+      if (!IsPointerToSpecificBuiltin(args[1]->GetType(), vpi_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(vpi_kind)->PointerTo());
+        return;
+      }
+      // Third argument is the index of the column
+      if (call->NumArgs() == 3 && !args[2]->IsIntegerLiteral()) {
+        ReportIncorrectCallArg(call, 2, "integer literal");
+        return;
+      }
+      // Advance returns nil
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
     case ast::Builtin::AggMerge: {
       if (!CheckArgCount(call, 2)) {
         return;
@@ -820,6 +926,107 @@ void Sema::CheckBuiltinJoinHashTableLookup(ast::CallExpr *call) {
   call->SetType(GetBuiltinType(ast::BuiltinType::HashTableEntryIterator));
 }
 
+void Sema::CheckBuiltinJoinHashTableSpillCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // First argument must be a pointer to a JoinHashTable
+  const auto jht_kind = ast::BuiltinType::JoinHashTable;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), jht_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(jht_kind)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::JoinHashTableEnableSpilling: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // Second argument is the size of the probe tuples
+      if (!args[1]->GetType()->IsIntegerType()) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint32));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::JoinHashTableIsSpilled: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // Second argument is a 64-bit unsigned hash value
+      if (!args[1]->GetType()->IsSpecificBuiltin(ast::BuiltinType::Uint64)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint64));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
+    case ast::Builtin::JoinHashTableEnableRuntimeFilter:
+    case ast::Builtin::JoinHashTableEnableCompactLayout: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::JoinHashTableMayContain: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // Second argument is a 64-bit unsigned hash value
+      if (!args[1]->GetType()->IsSpecificBuiltin(ast::BuiltinType::Uint64)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint64));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Bool));
+      break;
+    }
+    case ast::Builtin::JoinHashTableSpillProbe: {
+      if (!CheckArgCount(call, 3)) {
+        return;
+      }
+      // Second argument is a 64-bit unsigned hash value
+      if (!args[1]->GetType()->IsSpecificBuiltin(ast::BuiltinType::Uint64)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint64));
+        return;
+      }
+      // Third argument is a pointer to the probe tuple
+      if (!args[2]->GetType()->IsPointerType()) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::JoinHashTableProcessSpilled: {
+      if (!CheckArgCount(call, 4)) {
+        return;
+      }
+      // Second and third arguments are opaque query and pipeline state pointers
+      for (uint32_t idx = 1; idx < 3; idx++) {
+        if (!args[idx]->GetType()->IsPointerType()) {
+          ReportIncorrectCallArg(call, idx, GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+          return;
+        }
+      }
+      // Fourth argument is the function probing with a spilled tuple
+      if (!args[3]->GetType()->IsFunctionType()) {
+        ReportIncorrectCallArg(call, 3, GetBuiltinType(ast::BuiltinType::Nil));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible join hash table spill call");
+    }
+  }
+}
+
 void Sema::CheckBuiltinJoinHashTableFree(ast::CallExpr *call) {
   if (!CheckArgCount(call, 1)) {
     return;
@@ -936,20 +1143,28 @@ void Sema::CheckBuiltinExecutionContextCall(ast::CallExpr *call, ast::Builtin bu
     case ast::Builtin::ExecutionContextGetMemoryPool:
     case ast::Builtin::ExecutionContextGetTLS:
     case ast::Builtin::ExecutionContextClearHooks:
+    case ast::Builtin::ExecutionContextCheckInterrupt:
       expected_arg_count = 1;
       break;
     case ast::Builtin::ExecutionContextAddRowsAffected:
+    case ast::Builtin::ExecutionContextScaleSampledCount:
     case ast::Builtin::ExecutionContextInitHooks:
     case ast::Builtin::ExecutionContextStartResourceTracker:
     case ast::Builtin::ExecutionContextStartPipelineTracker:
     case ast::Builtin::ExecutionContextSetMemoryUseOverride:
     case ast::Builtin::ExecutionContextEndResourceTracker:
+    case ast::Builtin::ExecutionContextStartPipelineProfile:
+    case ast::Builtin::ExecutionContextEndPipelineProfile:
       expected_arg_count = 2;
       break;
     case ast::Builtin::ExecutionContextRegisterHook:
+    case ast::Builtin::ExecutionContextScaleSampledDistinct:
+    case ast::Builtin::ExecutionContextAnalyzeColumnGroups:
+    case ast::Builtin::ExecutionContextCheckCardinality:
       expected_arg_count = 3;
       break;
     case ast::Builtin::ExecutionContextEndPipelineTracker:
+    case ast::Builtin::ExecutionContextRecordOperatorRows:
       expected_arg_count = 4;
       break;
     case ast::Builtin::ExecOUFeatureVectorInitialize:
@@ -993,7 +1208,8 @@ void Sema::CheckBuiltinExecutionContextCall(ast::CallExpr *call, ast::Builtin bu
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
-    case ast::Builtin::ExecutionContextClearHooks: {
+    case ast::Builtin::ExecutionContextClearHooks:
+    case ast::Builtin::ExecutionContextCheckInterrupt: {
       if (!CheckArgCount(call, 1)) {
         return;
       }
@@ -1034,6 +1250,34 @@ void Sema::CheckBuiltinExecutionContextCall(ast::CallExpr *call, ast::Builtin bu
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
+    case ast::Builtin::ExecutionContextScaleSampledCount:
+    case ast::Builtin::ExecutionContextScaleSampledDistinct: {
+      // The counts over the sample, SQL integers
+      const auto integer_type = GetBuiltinType(ast::BuiltinType::Integer);
+      for (uint32_t arg_idx = 1; arg_idx < call_args.size(); arg_idx++) {
+        if (!call_args[arg_idx]->GetType()->IsSpecificBuiltin(ast::BuiltinType::Integer)) {
+          ReportIncorrectCallArg(call, arg_idx, integer_type);
+          return;
+        }
+      }
+      call->SetType(integer_type);
+      break;
+    }
+    case ast::Builtin::ExecutionContextAnalyzeColumnGroups: {
+      // The OIDs of the table and of the first column of the groups
+      ast::Type *uint_type = GetBuiltinType(ast::BuiltinType::Uint32);
+      for (uint32_t arg_idx = 1; arg_idx < call_args.size(); arg_idx++) {
+        if (!call_args[arg_idx]->GetType()->IsIntegerType()) {
+          ReportIncorrectCallArg(call, arg_idx, uint_type);
+          return;
+        }
+        if (call_args[arg_idx]->GetType() != uint_type) {
+          call->SetArgument(arg_idx, ImplCastExprToType(call_args[arg_idx], uint_type, ast::CastKind::IntegralCast));
+        }
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::StringVal));
+      break;
+    }
     case ast::Builtin::ExecutionContextGetMemoryPool: {
       call->SetType(GetBuiltinType(ast::BuiltinType::MemoryPool)->PointerTo());
       break;
@@ -1099,6 +1343,51 @@ void Sema::CheckBuiltinExecutionContextCall(ast::CallExpr *call, ast::Builtin bu
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
+    case ast::Builtin::ExecutionContextStartPipelineProfile:
+    case ast::Builtin::ExecutionContextEndPipelineProfile: {
+      // Pipeline ID.
+      if (!call_args[1]->IsIntegerLiteral()) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint32));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::ExecutionContextRecordOperatorRows: {
+      // Pipeline ID.
+      if (!call_args[1]->IsIntegerLiteral()) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint32));
+        return;
+      }
+      // Plan node ID.
+      if (!call_args[2]->IsIntegerLiteral()) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(ast::BuiltinType::Int32));
+        return;
+      }
+      // Number of rows.
+      const auto uint64_kind = ast::BuiltinType::Uint64;
+      if (!call_args[3]->GetType()->IsSpecificBuiltin(uint64_kind)) {
+        ReportIncorrectCallArg(call, 3, GetBuiltinType(uint64_kind));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::ExecutionContextCheckCardinality: {
+      // Plan node ID.
+      if (!call_args[1]->IsIntegerLiteral()) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Int32));
+        return;
+      }
+      // Number of rows.
+      const auto uint32_kind = ast::BuiltinType::Uint32;
+      if (!call_args[2]->GetType()->IsSpecificBuiltin(uint32_kind)) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(uint32_kind));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
     case ast::Builtin::ExecOUFeatureVectorInitialize: {
       auto ou_kind = ast::BuiltinType::ExecOUFeatureVector;
       auto *outype = call_args[1]->GetType();
@@ -1323,6 +1612,93 @@ void Sema::CheckBuiltinTableIterCall(ast::CallExpr *call, ast::Builtin builtin)
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
+    case ast::Builtin::TableIterFilterBlocks: {
+      if (!CheckArgCount(call, 4)) {
+        return;
+      }
+      // The second argument is the index of a column, the third and fourth are the bounds of its values
+      const auto arg_kinds = {ast::BuiltinType::Uint32, ast::BuiltinType::Int64, ast::BuiltinType::Int64};
+      uint32_t arg_idx = 1;
+      for (const auto kind : arg_kinds) {
+        ast::Type *arg_type = GetBuiltinType(kind);
+        if (!call_args[arg_idx]->GetType()->IsIntegerType()) {
+          ReportIncorrectCallArg(call, arg_idx, arg_type);
+          return;
+        }
+        if (call_args[arg_idx]->GetType() != arg_type) {
+          call->SetArgument(arg_idx, ImplCastExprToType(call_args[arg_idx], arg_type, ast::CastKind::IntegralCast));
+        }
+        arg_idx++;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::TableIterFilterBlocksTopK: {
+      if (!CheckArgCount(call, 4)) {
+        return;
+      }
+      // The second argument is the index of a column
+      ast::Type *uint_type = GetBuiltinType(ast::BuiltinType::Uint32);
+      if (!call_args[1]->GetType()->IsIntegerType()) {
+        ReportIncorrectCallArg(call, 1, uint_type);
+        return;
+      }
+      if (call_args[1]->GetType() != uint_type) {
+        call->SetArgument(1, ImplCastExprToType(call_args[1], uint_type, ast::CastKind::IntegralCast));
+      }
+      // The third argument is the sorter whose top-K bound is filtered on
+      const auto sorter_kind = ast::BuiltinType::Sorter;
+      if (!IsPointerToSpecificBuiltin(call_args[2]->GetType(), sorter_kind)) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(sorter_kind)->PointerTo());
+        return;
+      }
+      // The fourth argument is whether the column is sorted in descending order
+      if (!call_args[3]->GetType()->IsBoolType()) {
+        ReportIncorrectCallArg(call, 3, GetBuiltinType(ast::BuiltinType::Bool));
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::TableIterSampleBlocks: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // The second argument is the number of blocks to read
+      ast::Type *uint_type = GetBuiltinType(ast::BuiltinType::Uint32);
+      if (!call_args[1]->GetType()->IsIntegerType()) {
+        ReportIncorrectCallArg(call, 1, uint_type);
+        return;
+      }
+      if (call_args[1]->GetType() != uint_type) {
+        call->SetArgument(1, ImplCastExprToType(call_args[1], uint_type, ast::CastKind::IntegralCast));
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::TableIterLateMaterialize: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // The second argument is the index of the column in the projection
+      ast::Type *uint_type = GetBuiltinType(ast::BuiltinType::Uint32);
+      if (!call_args[1]->GetType()->IsIntegerType()) {
+        ReportIncorrectCallArg(call, 1, uint_type);
+        return;
+      }
+      if (call_args[1]->GetType() != uint_type) {
+        call->SetArgument(1, ImplCastExprToType(call_args[1], uint_type, ast::CastKind::IntegralCast));
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
+    case ast::Builtin::TableIterFetchLateColumns: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+      break;
+    }
     default: {
       UNREACHABLE("Impossible table iteration call");
     }
@@ -1640,7 +2016,7 @@ void Sema::CheckBuiltinFilterManagerCall(ast::CallExpr *const call, const ast::B
   const auto exec_ctx_kind = ast::BuiltinType::ExecutionContext;
   switch (builtin) {
     case ast::Builtin::FilterManagerInit: {
-      if (!CheckArgCount(call, 2)) {
+      if (!CheckArgCountAtLeast(call, 2)) {
         return;
       }
       // The second argument must be a pointer to the execution context.
@@ -1648,6 +2024,11 @@ void Sema::CheckBuiltinFilterManagerCall(ast::CallExpr *const call, const ast::B
         ReportIncorrectCallArg(call, 1, GetBuiltinType(exec_ctx_kind)->PointerTo());
         return;
       }
+      // The optional third argument is a pointer handed to the terms as their context.
+      if (call->NumArgs() > 2 && !call->Arguments()[2]->GetType()->IsPointerType()) {
+        ReportIncorrectCallArg(call, 2, GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
+        return;
+      }
       call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
       break;
     }
@@ -1741,6 +2122,132 @@ void Sema::CheckBuiltinVectorFilterCall(ast::CallExpr *call) {
   call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
 }
 
+void Sema::CheckBuiltinVectorProjectionCall(ast::CallExpr *call, ast::Builtin builtin) {
+  if (!CheckArgCountAtLeast(call, 1)) {
+    return;
+  }
+
+  // The first argument must be a *VectorProjection.
+  const auto &call_args = call->Arguments();
+  const auto vector_proj_kind = ast::BuiltinType::VectorProjection;
+  if (!IsPointerToSpecificBuiltin(call_args[0]->GetType(), vector_proj_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(vector_proj_kind)->PointerTo());
+    return;
+  }
+
+  switch (builtin) {
+    case ast::Builtin::VectorProjectionInit: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // The second argument is the uint32 array of the column types.
+      auto *arr_type = call_args[1]->GetType()->SafeAs<ast::ArrayType>();
+      if (arr_type == nullptr || !arr_type->GetElementType()->IsSpecificBuiltin(ast::BuiltinType::Uint32) ||
+          !arr_type->HasKnownLength()) {
+        ReportIncorrectCallArg(call, 1, "Second argument should be a fixed length uint32 array");
+        return;
+      }
+      break;
+    }
+    case ast::Builtin::VectorProjectionExtend: {
+      if (!CheckArgCount(call, 2)) {
+        return;
+      }
+      // The second argument is the *VectorProjectionIterator over the projection to extend.
+      const auto vpi_kind = ast::BuiltinType::VectorProjectionIterator;
+      if (!IsPointerToSpecificBuiltin(call_args[1]->GetType(), vpi_kind)) {
+        ReportIncorrectCallArg(call, 1, GetBuiltinType(vpi_kind)->PointerTo());
+        return;
+      }
+      break;
+    }
+    case ast::Builtin::VectorProjectionFree: {
+      if (!CheckArgCount(call, 1)) {
+        return;
+      }
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible VectorProjection call");
+    }
+  }
+
+  call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+}
+
+void Sema::CheckBuiltinVectorArithmeticCall(ast::CallExpr *call, ast::Builtin builtin) {
+  const uint32_t num_args = builtin == ast::Builtin::VectorCast ? 4 : 5;
+  if (!CheckArgCount(call, num_args)) {
+    return;
+  }
+
+  // The first argument must be a *ExecutionContext.
+  const auto exec_ctx_kind = ast::BuiltinType::ExecutionContext;
+  if (!IsPointerToSpecificBuiltin(call->Arguments()[0]->GetType(), exec_ctx_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(exec_ctx_kind)->PointerTo());
+    return;
+  }
+
+  // The second argument must be a *VectorProjection.
+  const auto vector_proj_kind = ast::BuiltinType::VectorProjection;
+  if (!IsPointerToSpecificBuiltin(call->Arguments()[1]->GetType(), vector_proj_kind)) {
+    ReportIncorrectCallArg(call, 1, GetBuiltinType(vector_proj_kind)->PointerTo());
+    return;
+  }
+
+  // The third argument is the index of the result column.
+  const auto &call_args = call->Arguments();
+  const auto int32_kind = ast::BuiltinType::Int32;
+  const auto uint32_kind = ast::BuiltinType::Uint32;
+  auto is_col_idx = [&](uint32_t arg_idx) {
+    return call_args[arg_idx]->GetType()->IsSpecificBuiltin(int32_kind) ||
+           call_args[arg_idx]->GetType()->IsSpecificBuiltin(uint32_kind);
+  };
+  if (!is_col_idx(2)) {
+    ReportIncorrectCallArg(call, 2, GetBuiltinType(int32_kind));
+    return;
+  }
+
+  // A cast reads a column.
+  if (builtin == ast::Builtin::VectorCast) {
+    if (!is_col_idx(3)) {
+      ReportIncorrectCallArg(call, 3, GetBuiltinType(int32_kind));
+      return;
+    }
+    call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+    return;
+  }
+
+  // A date part reads a column, and takes the part to extract as an integer literal.
+  if (builtin == ast::Builtin::VectorDatePart) {
+    if (!is_col_idx(3)) {
+      ReportIncorrectCallArg(call, 3, GetBuiltinType(int32_kind));
+      return;
+    }
+    if (!call_args[4]->IsIntegerLiteral()) {
+      ReportIncorrectCallArg(call, 4, GetBuiltinType(int32_kind));
+      return;
+    }
+    call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+    return;
+  }
+
+  // The operands are either column indexes or SQL values, but not both SQL values.
+  for (uint32_t arg_idx = 3; arg_idx < 5; arg_idx++) {
+    if (!is_col_idx(arg_idx) && !call_args[arg_idx]->GetType()->IsSqlValueType()) {
+      ReportIncorrectCallArg(call, arg_idx, GetBuiltinType(int32_kind));
+      return;
+    }
+  }
+  if (!is_col_idx(3) && !is_col_idx(4)) {
+    ReportIncorrectCallArg(call, 4, GetBuiltinType(int32_kind));
+    return;
+  }
+
+  // Done
+  call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+}
+
 void Sema::CheckMathTrigCall(ast::CallExpr *call, ast::Builtin builtin) {
   const auto real_kind = ast::BuiltinType::Real;
   const auto int_kind = ast::BuiltinType::Integer;
@@ -2147,6 +2654,49 @@ void Sema::CheckBuiltinSorterInit(ast::CallExpr *call) {
   call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
 }
 
+void Sema::CheckBuiltinSorterSetNormalizedKey(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 2)) {
+    return;
+  }
+
+  const auto &args = call->Arguments();
+
+  // First argument must be a pointer to a Sorter
+  const auto sorter_kind = ast::BuiltinType::Sorter;
+  if (!IsPointerToSpecificBuiltin(args[0]->GetType(), sorter_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(sorter_kind)->PointerTo());
+    return;
+  }
+
+  // Second argument must be a function from a tuple pointer to a 64-bit key
+  auto *const key_func_type = args[1]->GetType()->SafeAs<ast::FunctionType>();
+  if (key_func_type == nullptr || key_func_type->GetNumParams() != 1 ||
+      !key_func_type->GetReturnType()->IsSpecificBuiltin(ast::BuiltinType::Uint64) ||
+      !key_func_type->GetParams()[0].type_->IsPointerType()) {
+    GetErrorReporter()->Report(call->Position(), ErrorMessages::kBadNormalizedKeyFunctionForSorter, args[1]->GetType());
+    return;
+  }
+
+  // This call returns nothing
+  call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+}
+
+void Sema::CheckBuiltinSorterNormalizeKey(ast::CallExpr *call) {
+  if (!CheckArgCount(call, 1)) {
+    return;
+  }
+
+  // The argument must be a SQL value of a type with a normalized key
+  auto *const arg_type = call->Arguments()[0]->GetType();
+  if (!arg_type->IsSqlValueType() || arg_type->IsSpecificBuiltin(ast::BuiltinType::Decimal)) {
+    GetErrorReporter()->Report(call->Position(), ErrorMessages::kBadNormalizeKeyArg, arg_type);
+    return;
+  }
+
+  // Result is a normalized key
+  call->SetType(GetBuiltinType(ast::BuiltinType::Uint64));
+}
+
 void Sema::CheckBuiltinSorterGetTupleCount(ast::CallExpr *call) {
   if (!CheckArgCount(call, 1)) {
     return;
@@ -2202,6 +2752,30 @@ void Sema::CheckBuiltinSorterInsert(ast::CallExpr *call, ast::Builtin builtin) {
   call->SetType(GetBuiltinType(ast::BuiltinType::Uint8)->PointerTo());
 }
 
+void Sema::CheckBuiltinSorterTopKBoundCall(ast::CallExpr *call, ast::Builtin builtin) {
+  const auto num_args = builtin == ast::Builtin::SorterShareTopKBound ? 2 : 1;
+  if (!CheckArgCount(call, num_args)) {
+    return;
+  }
+
+  // All arguments must be pointers to Sorters
+  const auto &call_args = call->Arguments();
+  const auto sorter_kind = ast::BuiltinType::Sorter;
+  for (uint32_t arg_idx = 0; arg_idx < call_args.size(); arg_idx++) {
+    if (!IsPointerToSpecificBuiltin(call_args[arg_idx]->GetType(), sorter_kind)) {
+      ReportIncorrectCallArg(call, arg_idx, GetBuiltinType(sorter_kind)->PointerTo());
+      return;
+    }
+  }
+
+  // Sharing returns nothing, the bound is a normalized key
+  if (builtin == ast::Builtin::SorterShareTopKBound) {
+    call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+  } else {
+    call->SetType(GetBuiltinType(ast::BuiltinType::Uint64));
+  }
+}
+
 void Sema::CheckBuiltinSorterSort(ast::CallExpr *call, ast::Builtin builtin) {
   if (!CheckArgCountAtLeast(call, 1)) {
     return;
@@ -2446,6 +3020,53 @@ void Sema::CheckBuiltinIndexIteratorScan(execution::ast::CallExpr *call, ast::Bu
   call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
 }
 
+void Sema::CheckBuiltinIndexIteratorParCall(execution::ast::CallExpr *call) {
+  if (!CheckArgCount(call, 4)) {
+    return;
+  }
+
+  const auto &call_args = call->Arguments();
+
+  // The first argument must be a pointer to a IndexIterator
+  const auto index_kind = ast::BuiltinType::IndexIterator;
+  if (!IsPointerToSpecificBuiltin(call_args[0]->GetType(), index_kind)) {
+    ReportIncorrectCallArg(call, 0, GetBuiltinType(index_kind)->PointerTo());
+    return;
+  }
+
+  // The second argument is the scan type.
+  if (!call_args[1]->GetType()->IsIntegerType()) {
+    ReportIncorrectCallArg(call, 1, GetBuiltinType(ast::BuiltinType::Uint32));
+    return;
+  }
+
+  // The third argument is an opaque query state. For now, check it's a pointer.
+  const auto void_kind = ast::BuiltinType::Nil;
+  if (!call_args[2]->GetType()->IsPointerType()) {
+    ReportIncorrectCallArg(call, 2, GetBuiltinType(void_kind)->PointerTo());
+    return;
+  }
+
+  // The fourth argument is the scanner function.
+  auto *scan_fn_type = call_args[3]->GetType()->SafeAs<ast::FunctionType>();
+  if (scan_fn_type == nullptr) {
+    GetErrorReporter()->Report(call->Position(), ErrorMessages::kBadParallelScanFunction, call_args[3]->GetType());
+    return;
+  }
+  // Check the type of the scanner function parameters. See IndexIterator::ScanFn.
+  const auto &params = scan_fn_type->GetParams();
+  if (params.size() != 3                                              // Scan function has 3 arguments.
+      || !params[0].type_->IsPointerType()                            // QueryState, must contain execCtx.
+      || !params[1].type_->IsPointerType()                            // Thread state.
+      || !IsPointerToSpecificBuiltin(params[2].type_, index_kind)) {  // IndexIterator.
+    GetErrorReporter()->Report(call->Position(), ErrorMessages::kBadParallelScanFunction, call_args[3]->GetType());
+    return;
+  }
+
+  // This builtin does not return a value.
+  call->SetType(GetBuiltinType(ast::BuiltinType::Nil));
+}
+
 void Sema::CheckBuiltinIndexIteratorAdvance(execution::ast::CallExpr *call) {
   if (!CheckArgCount(call, 1)) {
     return;
@@ -3309,6 +3930,10 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::ExecutionContextAddRowsAffected:
     case ast::Builtin::ExecutionContextRegisterHook:
     case ast::Builtin::ExecutionContextClearHooks:
+    case ast::Builtin::ExecutionContextCheckInterrupt:
+    case ast::Builtin::ExecutionContextScaleSampledCount:
+    case ast::Builtin::ExecutionContextScaleSampledDistinct:
+    case ast::Builtin::ExecutionContextAnalyzeColumnGroups:
     case ast::Builtin::ExecutionContextInitHooks:
     case ast::Builtin::ExecutionContextGetMemoryPool:
     case ast::Builtin::ExecutionContextGetTLS:
@@ -3317,6 +3942,10 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::ExecutionContextEndResourceTracker:
     case ast::Builtin::ExecutionContextStartPipelineTracker:
     case ast::Builtin::ExecutionContextEndPipelineTracker:
+    case ast::Builtin::ExecutionContextStartPipelineProfile:
+    case ast::Builtin::ExecutionContextEndPipelineProfile:
+    case ast::Builtin::ExecutionContextRecordOperatorRows:
+    case ast::Builtin::ExecutionContextCheckCardinality:
     case ast::Builtin::ExecOUFeatureVectorInitialize: {
       CheckBuiltinExecutionContextCall(call, builtin);
       break;
@@ -3338,7 +3967,12 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     case ast::Builtin::TableIterAdvance:
     case ast::Builtin::TableIterGetVPINumTuples:
     case ast::Builtin::TableIterGetVPI:
-    case ast::Builtin::TableIterClose: {
+    case ast::Builtin::TableIterClose:
+    case ast::Builtin::TableIterFilterBlocks:
+    case ast::Builtin::TableIterFilterBlocksTopK:
+    case ast::Builtin::TableIterSampleBlocks:
+    case ast::Builtin::TableIterLateMaterialize:
+    case ast::Builtin::TableIterFetchLateColumns: {
       CheckBuiltinTableIterCall(call, builtin);
       break;
     }
@@ -3427,12 +4061,30 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinVectorFilterCall(call);
       break;
     }
+    case ast::Builtin::VectorProjectionInit:
+    case ast::Builtin::VectorProjectionExtend:
+    case ast::Builtin::VectorProjectionFree: {
+      CheckBuiltinVectorProjectionCall(call, builtin);
+      break;
+    }
+    case ast::Builtin::VectorCast:
+    case ast::Builtin::VectorDatePart:
+    case ast::Builtin::VectorAdd:
+    case ast::Builtin::VectorSub:
+    case ast::Builtin::VectorMul: {
+      CheckBuiltinVectorArithmeticCall(call, builtin);
+      break;
+    }
     case ast::Builtin::AggHashTableInit:
     case ast::Builtin::AggHashTableGetTupleCount:
     case ast::Builtin::AggHashTableGetInsertCount:
     case ast::Builtin::AggHashTableInsert:
     case ast::Builtin::AggHashTableLinkEntry:
+    case ast::Builtin::AggHashTableInternString:
     case ast::Builtin::AggHashTableLookup:
+    case ast::Builtin::AggHashTableSetDenseDomain:
+    case ast::Builtin::AggHashTableLookupDense:
+    case ast::Builtin::AggHashTableInsertDense:
     case ast::Builtin::AggHashTableProcessBatch:
     case ast::Builtin::AggHashTableMovePartitions:
     case ast::Builtin::AggHashTableParallelPartitionedScan:
@@ -3458,6 +4110,7 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
     }
     case ast::Builtin::AggInit:
     case ast::Builtin::AggAdvance:
+    case ast::Builtin::AggAdvanceVector:
     case ast::Builtin::AggMerge:
     case ast::Builtin::AggReset:
     case ast::Builtin::AggResult:
@@ -3486,6 +4139,16 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinJoinHashTableLookup(call);
       break;
     }
+    case ast::Builtin::JoinHashTableEnableSpilling:
+    case ast::Builtin::JoinHashTableIsSpilled:
+    case ast::Builtin::JoinHashTableEnableRuntimeFilter:
+    case ast::Builtin::JoinHashTableEnableCompactLayout:
+    case ast::Builtin::JoinHashTableMayContain:
+    case ast::Builtin::JoinHashTableSpillProbe:
+    case ast::Builtin::JoinHashTableProcessSpilled: {
+      CheckBuiltinJoinHashTableSpillCall(call, builtin);
+      break;
+    }
     case ast::Builtin::JoinHashTableFree: {
       CheckBuiltinJoinHashTableFree(call);
       break;
@@ -3507,6 +4170,14 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinSorterInit(call);
       break;
     }
+    case ast::Builtin::SorterSetNormalizedKey: {
+      CheckBuiltinSorterSetNormalizedKey(call);
+      break;
+    }
+    case ast::Builtin::SorterNormalizeKey: {
+      CheckBuiltinSorterNormalizeKey(call);
+      break;
+    }
     case ast::Builtin::SorterGetTupleCount: {
       CheckBuiltinSorterGetTupleCount(call);
       break;
@@ -3517,6 +4188,11 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinSorterInsert(call, builtin);
       break;
     }
+    case ast::Builtin::SorterShareTopKBound:
+    case ast::Builtin::SorterGetTopKBound: {
+      CheckBuiltinSorterTopKBoundCall(call, builtin);
+      break;
+    }
     case ast::Builtin::SorterSort:
     case ast::Builtin::SorterSortParallel:
     case ast::Builtin::SorterSortTopKParallel: {
@@ -3558,6 +4234,10 @@ void Sema::CheckBuiltinCall(ast::CallExpr *call) {
       CheckBuiltinIndexIteratorScan(call, builtin);
       break;
     }
+    case ast::Builtin::IndexIteratorParallel: {
+      CheckBuiltinIndexIteratorParCall(call);
+      break;
+    }
     case ast::Builtin::IndexIteratorAdvance: {
       CheckBuiltinIndexIteratorAdvance(call);
       break;
@@ -287,6 +287,15 @@ void Sema::VisitUnaryOpExpr(ast::UnaryOpExpr *node) {
       node->SetType(expr_type);
       break;
     }
+    case parsing::Token::Type::BIT_NOT: {
+      if (!expr_type->IsIntegerType()) {
+        GetErrorReporter()->Report(node->Position(), ErrorMessages::kInvalidOperation, node->Op(), expr_type);
+        return;
+      }
+
+      node->SetType(expr_type);
+      break;
+    }
     case parsing::Token::Type::STAR: {
       if (!expr_type->IsPointerType()) {
         GetErrorReporter()->Report(node->Position(), ErrorMessages::kInvalidOperation, node->Op(), expr_type);
@@ -1,11 +1,11 @@
 #include "execution/sql/aggregation_hash_table.h"
 
 #include <tbb/parallel_for_each.h>
-#include <tbb/task_scheduler_init.h>
 
 #include <algorithm>
+#include <atomic>
+#include <iterator>
 #include <memory>
-#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -13,8 +13,11 @@
 #include "common/math_util.h"
 #include "count/hll.h"
 #include "execution/exec/execution_context.h"
+#include "execution/exec/task_scheduler.h"
 #include "execution/sql/constant_vector.h"
 #include "execution/sql/generic_value.h"
+#include "execution/sql/memory_tracker.h"
+#include "execution/sql/spill_file.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/sql/vector_operations/unary_operation_executor.h"
 #include "execution/sql/vector_operations/vector_operations.h"
@@ -123,6 +126,10 @@ AggregationHashTable::BatchProcessState::BatchProcessState(std::unique_ptr<libco
 
 AggregationHashTable::BatchProcessState::~BatchProcessState() = default;
 
+void AggregationHashTable::BatchProcessState::ResetHLL() {
+  hll_estimator_ = libcount::HLL::Create(DEFAULT_HLL_PRECISION);
+}
+
 void AggregationHashTable::BatchProcessState::Reset(VectorProjectionIterator *input_batch) {
   // Resize the lists if they don't match the input. This should only happen
   // once, on the last input batch where the size may be less than one full
@@ -160,14 +167,23 @@ AggregationHashTable::AggregationHashTable(const exec::ExecutionSettings &exec_s
       payload_size_(payload_size),
       entries_(HashTableEntry::ComputeEntrySize(payload_size_), MemoryPoolAllocator<byte>(memory_)),
       owned_entries_(memory_),
+      owned_string_heaps_(memory_),
       hash_table_(DEFAULT_LOAD_FACTOR),
       batch_state_(nullptr),
+      dense_min_key_(0),
+      dense_groups_(memory_),
       merge_partition_fn_(nullptr),
       partition_heads_(nullptr),
       partition_tails_(nullptr),
       partition_estimates_(nullptr),
       partition_tables_(nullptr),
-      partition_shift_bits_(util::BitUtil::CountLeadingZeros(uint64_t(DEFAULT_NUM_PARTITIONS) - 1)) {
+      partition_shift_bits_(util::BitUtil::CountLeadingZeros(uint64_t(DEFAULT_NUM_PARTITIONS) - 1)),
+      memory_budget_(exec_settings.GetAggregationMemoryBudget()),
+      check_memory_budget_(false),
+      spill_file_(nullptr),
+      bypass_threshold_(exec_settings.GetAggregationBypassThreshold()),
+      bypass_(false),
+      num_sampled_tuples_(0) {
   hash_table_.SetSize(initial_size, memory_->GetTracker());
   max_fill_ = std::llround(hash_table_.GetCapacity() * hash_table_.GetLoadFactor());
 
@@ -255,6 +271,13 @@ byte *AggregationHashTable::AllocInputTuple(const hash_t hash) {
   return entry->payload_;
 }
 
+void AggregationHashTable::SetDenseDomain(const int64_t min_key, const uint32_t num_keys) {
+  NOISEPAGE_ASSERT(num_keys <= MAX_DENSE_DOMAIN_SIZE, "Dense domain is too large");
+  NOISEPAGE_ASSERT(GetTupleCount() == 0, "Dense domain must be set before any group is inserted");
+  dense_min_key_ = min_key;
+  dense_groups_.assign(num_keys, nullptr);
+}
+
 void AggregationHashTable::AllocateOverflowPartitions() {
   NOISEPAGE_ASSERT((partition_heads_ == nullptr) == (partition_tails_ == nullptr),
                    "Head and tail of overflow partitions list are not equally allocated");
@@ -267,6 +290,7 @@ void AggregationHashTable::AllocateOverflowPartitions() {
       partition_estimates_[i] = libcount::HLL::Create(DEFAULT_HLL_PRECISION).release();
     }
     partition_tables_ = memory_->AllocateArray<AggregationHashTable *>(DEFAULT_NUM_PARTITIONS, true);
+    partition_spills_.resize(DEFAULT_NUM_PARTITIONS);
   }
 }
 
@@ -294,12 +318,143 @@ void AggregationHashTable::FlushToOverflowPartitions() {
     }
     partition_estimates_[partition_idx]->Update(common::HashUtil::ScrambleHash(entry->hash_));
   });
+  std::fill(dense_groups_.begin(), dense_groups_.end(), nullptr);
 
   // Update stats
   stats_.num_flushes_++;
+  check_memory_budget_ = true;
+}
+
+void AggregationHashTable::SpillIfOverMemoryBudget() {
+  if (LIKELY(!check_memory_budget_)) {
+    return;
+  }
+  check_memory_budget_ = false;
+
+  // Only thread-local tables spill. They own all the entries in their overflow
+  // partitions, so that spilling can release the memory of every entry. The
+  // tracker counts what the thread allocated during the pipeline minus what it
+  // freed, which can be negative if it freed memory of another thread.
+  auto tracker = memory_->GetTracker();
+  if (memory_budget_ == 0 || tracker == nullptr || !owned_entries_.empty() ||
+      static_cast<int64_t>(tracker->GetAllocatedSize()) <= memory_budget_) {
+    return;
+  }
+
+  if (GetTupleCount() > 0) {
+    FlushToOverflowPartitions();
+    check_memory_budget_ = false;
+  }
+  SpillOverflowPartitions();
+}
+
+void AggregationHashTable::SpillOverflowPartitions() {
+  // A group inserted by the flush that preceded the spill may have been
+  // indexed after the flush, and its entry is about to be freed.
+  std::fill(dense_groups_.begin(), dense_groups_.end(), nullptr);
+
+  if (spill_file_ == nullptr) {
+    spill_files_.emplace_back(std::make_unique<SpillFile>());
+    spill_file_ = spill_files_.back().get();
+  }
+
+  // Partitions are written one after the other through a buffer, so that each
+  // partition ends up as one contiguous run in the file.
+  const std::size_t row_size = sizeof(hash_t) + payload_size_;
+  std::vector<byte> buffer;
+  buffer.reserve(std::max<std::size_t>(row_size, std::size_t{1} << 20));
+  for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
+    if (partition_heads_[part_idx] == nullptr) {
+      continue;
+    }
+    SpilledRun run{spill_file_, spill_file_->GetSize() + buffer.size(), 0};
+    for (const HashTableEntry *entry = partition_heads_[part_idx]; entry != nullptr; entry = entry->next_) {
+      if (buffer.size() + row_size > buffer.capacity()) {
+        spill_file_->Append(buffer.data(), buffer.size());
+        buffer.clear();
+      }
+      const std::size_t pos = buffer.size();
+      buffer.resize(pos + row_size);
+      std::memcpy(&buffer[pos], &entry->hash_, sizeof(hash_t));
+      std::memcpy(&buffer[pos + sizeof(hash_t)], entry->payload_, payload_size_);
+      run.num_entries_++;
+    }
+    partition_spills_[part_idx].push_back(run);
+    partition_heads_[part_idx] = partition_tails_[part_idx] = nullptr;
+  }
+  spill_file_->Append(buffer.data(), buffer.size());
+
+  // Every entry has been written out, so release their memory
+  entries_ = decltype(entries_)(entries_.ElementSize(), MemoryPoolAllocator<byte>(memory_));
+
+  // Update stats
+  stats_.num_spills_++;
+}
+
+void AggregationHashTable::MergeSpilledPartition(void *query_state, AggregationHashTable *target,
+                                                 const uint32_t partition_idx,
+                                                 const AggregationHashTable::MergePartitionFn merge_fn) {
+  if (partition_spills_[partition_idx].empty()) {
+    return;
+  }
+
+  // Spilled aggregates are materialized as entries again, a batch at a time,
+  // and handed to the merging function like an in-memory overflow partition.
+  // The merging function may link the entries into the target, so they are
+  // owned by the target. They are not part of its main entries, since those
+  // are relinked when the target grows.
+  const std::size_t row_size = sizeof(hash_t) + payload_size_;
+  std::vector<byte> rows(row_size * SPILL_READ_BATCH_SIZE);
+  decltype(entries_) spilled_entries(entries_.ElementSize(), MemoryPoolAllocator<byte>(target->memory_));
+
+  for (const SpilledRun &run : partition_spills_[partition_idx]) {
+    for (uint64_t done = 0; done < run.num_entries_;) {
+      const uint64_t count = std::min<uint64_t>(run.num_entries_ - done, SPILL_READ_BATCH_SIZE);
+      run.file_->Read(run.offset_ + done * row_size, rows.data(), count * row_size);
+
+      HashTableEntry *head = nullptr;
+      HashTableEntry *tail = nullptr;
+      for (uint64_t i = 0; i < count; i++) {
+        auto *entry = reinterpret_cast<HashTableEntry *>(spilled_entries.Append());
+        std::memcpy(&entry->hash_, &rows[i * row_size], sizeof(hash_t));
+        std::memcpy(entry->payload_, &rows[i * row_size + sizeof(hash_t)], payload_size_);
+        entry->next_ = nullptr;
+        (tail == nullptr ? head : tail->next_) = entry;
+        tail = entry;
+      }
+
+      AHTOverflowPartitionIterator iter(&head, &head + 1);
+      merge_fn(query_state, target, &iter);
+      done += count;
+    }
+  }
+
+  target->owned_entries_.emplace_back(std::move(spilled_entries));
+}
+
+void AggregationHashTable::TakeSpilledPartitions(AggregationHashTable *other) {
+  if (other->spill_files_.empty()) {
+    return;
+  }
+  for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
+    auto &runs = other->partition_spills_[part_idx];
+    partition_spills_[part_idx].insert(partition_spills_[part_idx].end(), runs.begin(), runs.end());
+    runs.clear();
+  }
+  std::move(other->spill_files_.begin(), other->spill_files_.end(), std::back_inserter(spill_files_));
+  other->spill_files_.clear();
+  other->spill_file_ = nullptr;
+}
+
+void AggregationHashTable::TakeStringKeys(AggregationHashTable *other) {
+  owned_string_heaps_.emplace_back(std::move(other->string_heap_));
+  std::move(other->owned_string_heaps_.begin(), other->owned_string_heaps_.end(),
+            std::back_inserter(owned_string_heaps_));
+  other->owned_string_heaps_.clear();
 }
 
 byte *AggregationHashTable::AllocInputTuplePartitioned(hash_t hash) {
+  SpillIfOverMemoryBudget();
   byte *ret = AllocInputTuple(hash);
   if (NeedsToFlushToOverflowPartitions()) {
     FlushToOverflowPartitions();
@@ -492,6 +647,60 @@ void AggregationHashTable::AdvanceGroups(VectorProjectionIterator *input_batch,
   advance_agg_fn(&iter, input_batch);
 }
 
+void AggregationHashTable::PartitionBatch(VectorProjectionIterator *input_batch,
+                                          const AggregationHashTable::VectorInitAggFn init_agg_fn,
+                                          const AggregationHashTable::VectorAdvanceAggFn advance_agg_fn) {
+  if (UNLIKELY(partition_heads_ == nullptr)) {
+    AllocateOverflowPartitions();
+  }
+
+  // Every tuple gets a new aggregate without probing the table. The aggregates
+  // of one group are combined when the overflow partitions are merged. The
+  // batch's HLL estimates how many groups pre-aggregating would have formed.
+  auto *RESTRICT raw_hashes = reinterpret_cast<const hash_t *>(batch_state_->Hashes()->GetData());
+  auto *RESTRICT raw_entries = reinterpret_cast<HashTableEntry **>(batch_state_->Entries()->GetData());
+  batch_state_->GroupsNotFound()->ForEach([&](const uint64_t i) {
+    auto *entry = reinterpret_cast<HashTableEntry *>(entries_.Append());
+    entry->hash_ = raw_hashes[i];
+    const uint64_t partition_idx = (entry->hash_ >> partition_shift_bits_);
+    entry->next_ = partition_heads_[partition_idx];
+    partition_heads_[partition_idx] = entry;
+    if (UNLIKELY(partition_tails_[partition_idx] == nullptr)) {
+      partition_tails_[partition_idx] = entry;
+    }
+    const hash_t scrambled_hash = common::HashUtil::ScrambleHash(entry->hash_);
+    partition_estimates_[partition_idx]->Update(scrambled_hash);
+    batch_state_->HLL()->Update(scrambled_hash);
+    raw_entries[i] = entry;
+  });
+
+  const uint64_t num_tuples = batch_state_->GroupsNotFound()->GetTupleCount();
+  stats_.num_bypassed_ += num_tuples;
+  num_sampled_tuples_ += num_tuples;
+
+  // Initialize the new aggregates, then update them with their tuple.
+  VectorProjectionIterator iter(batch_state_->Projection(), batch_state_->GroupsNotFound());
+  input_batch->SetVectorProjection(input_batch->GetVectorProjection(), batch_state_->GroupsNotFound());
+  init_agg_fn(&iter, input_batch);
+  batch_state_->GroupsFound()->AssignFrom(*batch_state_->GroupsNotFound());
+  AdvanceGroups(input_batch, advance_agg_fn);
+
+  // Sample as many tuples as fit into the table before it is flushed, and
+  // check the memory budget as often as a flush would.
+  if (num_sampled_tuples_ >= flush_threshold_) {
+    DecideBypass(batch_state_->HLL()->Estimate());
+    check_memory_budget_ = true;
+  }
+}
+
+void AggregationHashTable::DecideBypass(const uint64_t num_groups) {
+  // Pre-aggregation only pays off if it reduces the input. Bypass it while
+  // nearly every sampled tuple starts a group of its own.
+  bypass_ = bypass_threshold_ > 0 && num_groups * 100 >= num_sampled_tuples_ * bypass_threshold_;
+  num_sampled_tuples_ = 0;
+  batch_state_->ResetHLL();
+}
+
 void AggregationHashTable::ProcessBatch(VectorProjectionIterator *input_batch, const std::vector<uint32_t> &key_indexes,
                                         const AggregationHashTable::VectorInitAggFn init_agg_fn,
                                         const AggregationHashTable::VectorAdvanceAggFn advance_agg_fn,
@@ -508,12 +717,24 @@ void AggregationHashTable::ProcessBatch(VectorProjectionIterator *input_batch, c
         std::make_unique<HashToGroupIdMap>());         // The Hash-to-GroupID map
   }
 
+  // Aggregates from previous batches may be spilled before this batch starts
+  // creating and updating aggregates.
+  if (partitioned_aggregation) {
+    SpillIfOverMemoryBudget();
+  }
+
   // Reset state for the incoming batch.
   batch_state_->Reset(input_batch);
 
   // Compute the hashes.
   ComputeHash(input_batch, key_indexes);
 
+  // Partition the batch without pre-aggregating it if that yields too little.
+  if (partitioned_aggregation && bypass_) {
+    PartitionBatch(input_batch, init_agg_fn, advance_agg_fn);
+    return;
+  }
+
   // Find groups.
   FindGroups(input_batch, key_indexes);
 
@@ -523,7 +744,10 @@ void AggregationHashTable::ProcessBatch(VectorProjectionIterator *input_batch, c
   // If the caller requested a partitioned aggregation, drain the main hash
   // table out to the overflow partitions, but only if needed.
   if (partitioned_aggregation) {
+    num_sampled_tuples_ += input_batch->GetVectorProjection()->GetSelectedTupleCount();
     if (NeedsToFlushToOverflowPartitions()) {
+      // Everything in the table was formed since the last flush.
+      DecideBypass(GetTupleCount());
       FlushToOverflowPartitions();
     }
   } else {
@@ -567,14 +791,16 @@ void AggregationHashTable::TransferMemoryAndPartitions(ThreadStateContainer *thr
     stats_.num_inserts_ += table->stats_.num_inserts_;
     table->FlushToOverflowPartitions();
 
-    // Now, move over their memory
+    // Now, move over their memory, and the string keys their entries point to
     owned_entries_.emplace_back(std::move(table->entries_));
+    TakeStringKeys(table);
 
     NOISEPAGE_ASSERT(table->owned_entries_.empty(),
                      "A thread-local aggregation table should not have any owned "
                      "entries themselves. Nested/recursive aggregations not supported.");
 
-    // Now, move over their overflow partitions list
+    // Now, move over their overflow partitions list and their spilled runs
+    TakeSpilledPartitions(table);
     for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
       if (table->partition_heads_[part_idx] != nullptr) {
         // Link in the partition list
@@ -595,7 +821,7 @@ void AggregationHashTable::TransferMemoryAndPartitions(ThreadStateContainer *thr
 AggregationHashTable *AggregationHashTable::GetOrBuildTableOverPartition(void *query_state,
                                                                          const uint32_t partition_idx) {
   NOISEPAGE_ASSERT(partition_idx < DEFAULT_NUM_PARTITIONS, "Out-of-bounds partition access");
-  NOISEPAGE_ASSERT(partition_heads_[partition_idx] != nullptr,
+  NOISEPAGE_ASSERT(!IsPartitionEmpty(partition_idx),
                    "Should not build aggregation table over empty partition!");
   NOISEPAGE_ASSERT(merge_partition_fn_ != nullptr,
                    "Merging function was not provided! Did you forget to call TransferMemoryAndPartitions()?");
@@ -616,6 +842,7 @@ AggregationHashTable *AggregationHashTable::GetOrBuildTableOverPartition(void *q
   // Build it
   AHTOverflowPartitionIterator iter(partition_heads_ + partition_idx, partition_heads_ + partition_idx + 1);
   merge_partition_fn_(query_state, agg_table, &iter);
+  MergeSpilledPartition(query_state, agg_table, partition_idx, merge_partition_fn_);
 
   timer.Stop();
   EXECUTION_LOG_DEBUG("Overflow Partition {}: estimated size = {}, actual size = {}, build time = {:2f} ms",
@@ -628,6 +855,12 @@ AggregationHashTable *AggregationHashTable::GetOrBuildTableOverPartition(void *q
   return agg_table;
 }
 
+void AggregationHashTable::ReleasePartitionTable(const uint32_t partition_idx) {
+  partition_tables_[partition_idx]->~AggregationHashTable();
+  memory_->Deallocate(partition_tables_[partition_idx], sizeof(AggregationHashTable));
+  partition_tables_[partition_idx] = nullptr;
+}
+
 void AggregationHashTable::ExecutePartitionedScan(void *query_state, AggregationHashTable::ScanPartitionFn scan_fn) {
   NOISEPAGE_ASSERT(partition_heads_ != nullptr && merge_partition_fn_ != nullptr,
                    "No overflow partitions allocated, or no merging function allocated. Did you call "
@@ -635,11 +868,15 @@ void AggregationHashTable::ExecutePartitionedScan(void *query_state, Aggregation
 
   // Determine the non-empty overflow partitions.
   for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
-    if (partition_heads_[part_idx] != nullptr) {
+    if (!IsPartitionEmpty(part_idx)) {
       // Get or build the table on the partition.
       auto agg_table_partition = GetOrBuildTableOverPartition(query_state, part_idx);
       // Scan the partition.
       scan_fn(query_state, nullptr, agg_table_partition);
+      // Don't keep spilled aggregates in memory any longer than needed.
+      if (!partition_spills_[part_idx].empty()) {
+        ReleasePartitionTable(part_idx);
+      }
     }
   }
 }
@@ -662,7 +899,7 @@ void AggregationHashTable::ExecuteParallelPartitionedScan(void *query_state, Thr
   std::vector<uint32_t> nonempty_parts;
   nonempty_parts.reserve(DEFAULT_NUM_PARTITIONS);
   for (uint32_t i = 0; i < DEFAULT_NUM_PARTITIONS; i++) {
-    if (partition_heads_[i] != nullptr) {
+    if (!IsPartitionEmpty(i)) {
       nonempty_parts.push_back(i);
     }
   }
@@ -670,36 +907,34 @@ void AggregationHashTable::ExecuteParallelPartitionedScan(void *query_state, Thr
   util::Timer<std::milli> timer;
   timer.Start();
 
-  size_t num_threads = tbb::task_scheduler_init::default_num_threads();
-  size_t num_tasks = nonempty_parts.size();
-  size_t concurrent_estimate = std::min(num_threads, num_tasks);
-  exec_ctx_->SetNumConcurrentEstimate(concurrent_estimate);
+  std::atomic<uint64_t> tuple_count = 0;
+  exec::TaskScheduler::Execute(exec_ctx_, nonempty_parts.size(), [&] {
+    tbb::parallel_for_each(nonempty_parts, [&](const uint32_t part_idx) {
+      // TODO(wz2): Resource trackers are started and stopped within scan_fn. It might be more correct
+      // to start the trackers here manually -- or have TransferMemoryAndPartitions build all the tables
+      // over each partition (but that would require storing the agg table pointers).
 
-  tbb::parallel_for_each(nonempty_parts, [&](const uint32_t part_idx) {
-    // TODO(wz2): Resource trackers are started and stopped within scan_fn. It might be more correct
-    // to start the trackers here manually -- or have TransferMemoryAndPartitions build all the tables
-    // over each partition (but that would require storing the agg table pointers).
+      // Build a hash table over the given partition
+      auto agg_table_partition = GetOrBuildTableOverPartition(query_state, part_idx);
 
-    // Build a hash table over the given partition
-    auto agg_table_partition = GetOrBuildTableOverPartition(query_state, part_idx);
+      // Get a handle to the thread-local state of the executing thread
+      auto thread_state = thread_states->AccessCurrentThreadState();
 
-    // Get a handle to the thread-local state of the executing thread
-    auto thread_state = thread_states->AccessCurrentThreadState();
+      // Scan the partition
+      scan_fn(query_state, thread_state, agg_table_partition);
+      tuple_count += agg_table_partition->GetTupleCount();
 
-    // Scan the partition
-    scan_fn(query_state, thread_state, agg_table_partition);
+      // Don't keep spilled aggregates in memory any longer than needed
+      if (!partition_spills_[part_idx].empty()) {
+        ReleasePartitionTable(part_idx);
+      }
+    });
   });
-
-  exec_ctx_->SetNumConcurrentEstimate(0);
   timer.Stop();
 
-  const uint64_t tuple_count =
-      std::accumulate(nonempty_parts.begin(), nonempty_parts.end(), uint64_t{0},
-                      [&](const auto curr, const auto idx) { return curr + partition_tables_[idx]->GetTupleCount(); });
-
-  UNUSED_ATTRIBUTE double tps = (tuple_count / timer.GetElapsed()) / 1000.0;
+  UNUSED_ATTRIBUTE double tps = (tuple_count.load() / timer.GetElapsed()) / 1000.0;
   EXECUTION_LOG_TRACE("Built and scanned {} tables totalling {} tuples in {:.2f} ms ({:.2f} mtps)",
-                      nonempty_parts.size(), tuple_count, timer.GetElapsed(), tps);
+                      nonempty_parts.size(), tuple_count.load(), timer.GetElapsed(), tps);
 }
 
 void AggregationHashTable::BuildAllPartitions(void *query_state) {
@@ -710,14 +945,16 @@ void AggregationHashTable::BuildAllPartitions(void *query_state) {
   std::vector<uint32_t> nonempty_parts;
   nonempty_parts.reserve(DEFAULT_NUM_PARTITIONS);
   for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
-    if (partition_heads_[part_idx] != nullptr) {
+    if (!IsPartitionEmpty(part_idx)) {
       nonempty_parts.push_back(part_idx);
     }
   }
 
   // For each valid partition, build a hash table over its contents.
-  tbb::parallel_for_each(nonempty_parts,
-                         [&](const uint32_t part_idx) { GetOrBuildTableOverPartition(query_state, part_idx); });
+  exec::TaskScheduler::Execute(exec_ctx_, nonempty_parts.size(), [&] {
+    tbb::parallel_for_each(nonempty_parts,
+                           [&](const uint32_t part_idx) { GetOrBuildTableOverPartition(query_state, part_idx); });
+  });
 }
 
 void AggregationHashTable::Repartition() {
@@ -727,11 +964,15 @@ void AggregationHashTable::Repartition() {
   for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
     if (partition_tables_[part_idx] != nullptr) {
       nonempty_tables.push_back(partition_tables_[part_idx]);
+      // The spilled aggregates were merged into the table, and come back through its overflow partitions.
+      partition_spills_[part_idx].clear();
     }
   }
 
   // First, flush all hash table partitions to their own overflow buckets.
-  tbb::parallel_for_each(nonempty_tables, [&](auto table) { table->FlushToOverflowPartitions(); });
+  exec::TaskScheduler::Execute(exec_ctx_, nonempty_tables.size(), [&] {
+    tbb::parallel_for_each(nonempty_tables, [&](auto table) { table->FlushToOverflowPartitions(); });
+  });
 
   // Now, transfer each hash table partition's overflow buckets to us.
   for (auto *table : nonempty_tables) {
@@ -747,6 +988,7 @@ void AggregationHashTable::Repartition() {
 
     // Move partitioned hash table memory into this main hash table.
     owned_entries_.emplace_back(std::move(table->entries_));
+    TakeStringKeys(table);
   }
 }
 
@@ -760,23 +1002,27 @@ void AggregationHashTable::MergePartitions(AggregationHashTable *target, void *q
   std::vector<uint32_t> nonempty_parts;
   nonempty_parts.reserve(DEFAULT_NUM_PARTITIONS);
   for (uint32_t part_idx = 0; part_idx < DEFAULT_NUM_PARTITIONS; part_idx++) {
-    if (partition_heads_[part_idx] != nullptr) {
+    if (!IsPartitionEmpty(part_idx)) {
       nonempty_parts.push_back(part_idx);
     }
   }
 
   // Merge overflow data into the appropriate partitioned table in the target.
-  tbb::parallel_for_each(nonempty_parts, [&](const uint32_t part_idx) {
-    // Get the partitioned hash table from the target.
-    auto agg_table_partition = target->GetOrBuildTableOverPartition(query_state, part_idx);
-
-    // Merge our overflow partition into target table.
-    AHTOverflowPartitionIterator iter(partition_heads_ + part_idx, partition_heads_ + part_idx + 1);
-    merge_func(query_state, agg_table_partition, &iter);
+  exec::TaskScheduler::Execute(exec_ctx_, nonempty_parts.size(), [&] {
+    tbb::parallel_for_each(nonempty_parts, [&](const uint32_t part_idx) {
+      // Get the partitioned hash table from the target.
+      auto agg_table_partition = target->GetOrBuildTableOverPartition(query_state, part_idx);
+
+      // Merge our overflow partition into target table.
+      AHTOverflowPartitionIterator iter(partition_heads_ + part_idx, partition_heads_ + part_idx + 1);
+      merge_func(query_state, agg_table_partition, &iter);
+      MergeSpilledPartition(query_state, agg_table_partition, part_idx, merge_func);
+    });
   });
 
   // Move our memory to the target.
   target->owned_entries_.emplace_back(std::move(entries_));
+  target->TakeStringKeys(this);
 }
 
 }  // namespace noisepage::execution::sql
@@ -0,0 +1,305 @@
+#include "execution/sql/arrow_file_reader.h"
+
+#include <fcntl.h>
+#include <flatbuffers/flatbuffers.h>
+#include <flatbuffers/generated/Message_generated.h>
+#include <flatbuffers/generated/Schema_generated.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "common/error/error_code.h"
+#include "common/error/exception.h"
+#include "execution/util/bit_util.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage::execution::sql {
+
+namespace flatbuf = org::apache::arrow::flatbuf;
+
+namespace {
+
+// Every message starts with this marker, followed by the size of its metadata. A size of zero ends the stream.
+constexpr int32_t CONTINUATION_MARKER = -1;
+
+// Arrow stores the offsets of strings and the codes of dictionaries in 64-bit integers
+using Offset = uint64_t;
+
+}  // namespace
+
+ArrowFileReader::ArrowFileReader(const std::string &path) : path_(path) {
+  const int fd = open(path.c_str(), O_RDONLY);
+  struct stat file_stat;
+  if (fd < 0 || fstat(fd, &file_stat) != 0) {
+    if (fd >= 0) close(fd);
+    throw EXECUTION_EXCEPTION(fmt::format("Could not open Arrow file {}: {}", path, std::strerror(errno)),
+                              common::ErrorCode::ERRCODE_IO_ERROR);
+  }
+  size_ = file_stat.st_size;
+  if (size_ > 0) {
+    void *data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+      close(fd);
+      throw EXECUTION_EXCEPTION(fmt::format("Could not map Arrow file {}: {}", path, std::strerror(errno)),
+                                common::ErrorCode::ERRCODE_IO_ERROR);
+    }
+    data_ = static_cast<byte *>(data);
+  }
+  // The mapping stays valid after the descriptor is closed
+  close(fd);
+
+  try {
+    ParseStream();
+  } catch (...) {
+    if (data_ != nullptr) munmap(data_, size_);
+    throw;
+  }
+}
+
+ArrowFileReader::~ArrowFileReader() {
+  if (data_ != nullptr) munmap(data_, size_);
+}
+
+uint64_t ArrowFileReader::GetRowCount() const {
+  uint64_t num_rows = 0;
+  for (const auto &batch : batches_) num_rows += batch.num_rows_;
+  return num_rows;
+}
+
+void ArrowFileReader::ParseStream() {
+  auto corrupted = [&](const char *what) {
+    return EXECUTION_EXCEPTION(fmt::format("Arrow file {} is corrupted: {}", path_, what),
+                               common::ErrorCode::ERRCODE_DATA_CORRUPTED);
+  };
+
+  bool seen_schema = false;
+  std::size_t pos = 0;
+  while (true) {
+    // Streams written before the continuation marker was introduced start messages with the size right away
+    int32_t metadata_size;
+    if (pos + sizeof(int32_t) > size_) throw corrupted("stream ends without an end-of-stream marker");
+    std::memcpy(&metadata_size, data_ + pos, sizeof(int32_t));
+    pos += sizeof(int32_t);
+    if (metadata_size == CONTINUATION_MARKER) {
+      if (pos + sizeof(int32_t) > size_) throw corrupted("stream ends without an end-of-stream marker");
+      std::memcpy(&metadata_size, data_ + pos, sizeof(int32_t));
+      pos += sizeof(int32_t);
+    }
+    if (metadata_size == 0) break;
+    if (metadata_size < 0 || pos + metadata_size > size_) throw corrupted("message metadata is out of bounds");
+
+    const auto *metadata = reinterpret_cast<const uint8_t *>(data_ + pos);
+    flatbuffers::Verifier verifier(metadata, metadata_size);
+    if (!flatbuf::VerifyMessageBuffer(verifier)) throw corrupted("message metadata is malformed");
+    const flatbuf::Message *message = flatbuf::GetMessage(metadata);
+    pos += metadata_size;
+    const byte *body = data_ + pos;
+    if (message->bodyLength() < 0 || pos + message->bodyLength() > size_) {
+      throw corrupted("message body is out of bounds");
+    }
+    pos += message->bodyLength();
+
+    switch (message->header_type()) {
+      case flatbuf::MessageHeader_Schema:
+        ParseSchema(message->header_as_Schema());
+        seen_schema = true;
+        break;
+      case flatbuf::MessageHeader_DictionaryBatch:
+        if (!seen_schema) throw corrupted("dictionary batch before the schema");
+        ParseDictionaryBatch(message->header_as_DictionaryBatch(), body);
+        break;
+      case flatbuf::MessageHeader_RecordBatch:
+        if (!seen_schema) throw corrupted("record batch before the schema");
+        ParseRecordBatch(message->header_as_RecordBatch(), body);
+        break;
+      default:
+        throw EXECUTION_EXCEPTION(fmt::format("Arrow file {} holds unsupported messages", path_),
+                                  common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED);
+    }
+  }
+}
+
+void ArrowFileReader::ParseSchema(const flatbuf::Schema *schema) {
+  auto unsupported = [&](const std::string &what) {
+    return EXECUTION_EXCEPTION(fmt::format("Arrow file {} has a column of unsupported type {}", path_, what),
+                               common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED);
+  };
+
+  for (const flatbuf::Field *field : *schema->fields()) {
+    TypeId type;
+    uint32_t byte_width = 0;
+    switch (field->type_type()) {
+      case flatbuf::Type_Bool:
+        // ArrowSerializer writes a byte per boolean, rather than packing them into a bitmap
+        type = TypeId::Boolean;
+        byte_width = sizeof(bool);
+        break;
+      case flatbuf::Type_Int: {
+        const auto *int_type = field->type_as_Int();
+        switch (int_type->bitWidth()) {
+          case 8:
+            type = TypeId::TinyInt;
+            break;
+          case 16:
+            type = TypeId::SmallInt;
+            break;
+          case 32:
+            type = TypeId::Integer;
+            break;
+          case 64:
+            type = TypeId::BigInt;
+            break;
+          default:
+            throw unsupported(fmt::format("int{}", int_type->bitWidth()));
+        }
+        byte_width = int_type->bitWidth() / 8;
+        break;
+      }
+      case flatbuf::Type_Timestamp:
+        type = TypeId::Timestamp;
+        byte_width = sizeof(uint64_t);
+        break;
+      case flatbuf::Type_Decimal:
+        // ArrowSerializer labels doubles as decimals, which describe them as floating point numbers
+        NOISEPAGE_FALLTHROUGH;
+      case flatbuf::Type_FloatingPoint:
+        type = TypeId::Double;
+        byte_width = sizeof(double);
+        break;
+      case flatbuf::Type_LargeBinary:
+      case flatbuf::Type_LargeUtf8:
+        type = TypeId::Varchar;
+        break;
+      default:
+        throw unsupported(flatbuf::EnumNameType(field->type_type()));
+    }
+    if (field->dictionary() != nullptr && type != TypeId::Varchar) throw unsupported("dictionary of non-strings");
+    columns_.push_back({type, byte_width, field->dictionary() != nullptr ? field->dictionary()->id() : -1});
+  }
+}
+
+void ArrowFileReader::ParseDictionaryBatch(const flatbuf::DictionaryBatch *dictionary_batch, const byte *body) {
+  const flatbuf::RecordBatch *data = dictionary_batch->data();
+  if (data == nullptr || data->buffers()->size() < 3) {
+    throw EXECUTION_EXCEPTION(fmt::format("Arrow file {} has a malformed dictionary", path_),
+                              common::ErrorCode::ERRCODE_DATA_CORRUPTED);
+  }
+  if (dictionary_batch->isDelta()) {
+    throw EXECUTION_EXCEPTION(fmt::format("Arrow file {} has delta dictionaries", path_),
+                              common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED);
+  }
+
+  // The entries reference their strings in the file
+  const auto *offsets = reinterpret_cast<const Offset *>(body + data->buffers()->Get(1)->offset());
+  const byte *strings = body + data->buffers()->Get(2)->offset();
+  auto dictionary = std::make_unique<Dictionary>();
+  dictionary->reserve(data->length());
+  for (int64_t i = 0; i < data->length(); i++) {
+    const auto size = static_cast<uint32_t>(offsets[i + 1] - offsets[i]);
+    dictionary->push_back(size <= storage::VarlenEntry::InlineThreshold()
+                              ? storage::VarlenEntry::CreateInline(strings + offsets[i], size)
+                              : storage::VarlenEntry::Create(strings + offsets[i], size, false));
+  }
+  current_dictionaries_[dictionary_batch->id()] = dictionary.get();
+  dictionaries_.push_back(std::move(dictionary));
+}
+
+void ArrowFileReader::ParseRecordBatch(const flatbuf::RecordBatch *record_batch, const byte *body) {
+  auto corrupted = [&]() {
+    return EXECUTION_EXCEPTION(fmt::format("Arrow file {} has a malformed record batch", path_),
+                               common::ErrorCode::ERRCODE_DATA_CORRUPTED);
+  };
+  if (record_batch->nodes()->size() != columns_.size()) throw corrupted();
+
+  Batch batch{static_cast<uint64_t>(record_batch->length()), {}};
+  const auto *buffers = record_batch->buffers();
+  uint32_t buffer_idx = 0;
+  auto next_buffer = [&]() -> const byte * {
+    if (buffer_idx >= buffers->size()) throw corrupted();
+    const flatbuf::Buffer *buffer = buffers->Get(buffer_idx++);
+    return buffer->length() == 0 ? nullptr : body + buffer->offset();
+  };
+
+  for (uint32_t col_idx = 0; col_idx < columns_.size(); col_idx++) {
+    const Column &column = columns_[col_idx];
+    BatchColumn batch_column{nullptr, nullptr, nullptr, nullptr};
+    batch_column.validity_ = next_buffer();
+    if (record_batch->nodes()->Get(col_idx)->null_count() == 0) batch_column.validity_ = nullptr;
+    batch_column.data_ = next_buffer();
+    if (column.dictionary_id_ != -1) {
+      const auto dictionary = current_dictionaries_.find(column.dictionary_id_);
+      if (dictionary == current_dictionaries_.end()) throw corrupted();
+      batch_column.dictionary_ = dictionary->second;
+    } else if (column.type_ == TypeId::Varchar) {
+      batch_column.strings_ = next_buffer();
+    }
+    if (batch_column.data_ == nullptr && batch.num_rows_ > 0) throw corrupted();
+    batch.columns_.push_back(batch_column);
+  }
+  batches_.push_back(std::move(batch));
+}
+
+uint32_t ArrowFileReader::ReadBatch(const uint32_t batch_idx, const uint64_t row_offset,
+                                    const std::vector<uint32_t> &col_idxs, VectorProjection *vector_projection) const {
+  NOISEPAGE_ASSERT(batch_idx < GetBatchCount(), "Out-of-bounds batch access");
+  NOISEPAGE_ASSERT(vector_projection->GetColumnCount() == col_idxs.size(), "Projection must hold the read columns");
+  NOISEPAGE_ASSERT(vector_projection->OwnsData(), "Projection must own its data");
+  const Batch &batch = batches_[batch_idx];
+  const auto num_rows = static_cast<uint32_t>(std::min<uint64_t>(
+      row_offset < batch.num_rows_ ? batch.num_rows_ - row_offset : 0, common::Constants::K_DEFAULT_VECTOR_SIZE));
+
+  vector_projection->Reset(num_rows);
+  if (num_rows == 0) return 0;
+  for (uint32_t i = 0; i < col_idxs.size(); i++) {
+    NOISEPAGE_ASSERT(vector_projection->GetColumnType(i) == GetColumnType(col_idxs[i]), "Mismatched column types");
+    ReadColumn(columns_[col_idxs[i]], batch.columns_[col_idxs[i]], row_offset, num_rows,
+               vector_projection->GetColumn(i));
+  }
+  return num_rows;
+}
+
+void ArrowFileReader::ReadColumn(const Column &column, const BatchColumn &batch_column, const uint64_t row_offset,
+                                 const uint32_t num_rows, Vector *vector) const {
+  // Arrow's validity bitmap has a set bit for every value that is not NULL
+  Vector::NullMask *null_mask = vector->GetMutableNullMask();
+  null_mask->Reset();
+  if (batch_column.validity_ != nullptr) {
+    const auto *validity = reinterpret_cast<const uint8_t *>(batch_column.validity_);
+    for (uint32_t i = 0; i < num_rows; i++) {
+      const uint64_t row = row_offset + i;
+      if ((validity[row / 8] & (1u << (row % 8))) == 0) null_mask->Set(i);
+    }
+  }
+
+  if (column.type_ != TypeId::Varchar) {
+    std::memcpy(vector->GetData(), batch_column.data_ + row_offset * column.byte_width_, num_rows * column.byte_width_);
+    return;
+  }
+
+  auto *entries = reinterpret_cast<storage::VarlenEntry *>(vector->GetData());
+  if (batch_column.dictionary_ != nullptr) {
+    // Decode the strings, and keep the codes for operations that can work on the dictionary instead
+    const auto *codes = reinterpret_cast<const Offset *>(batch_column.data_) + row_offset;
+    const Dictionary &dictionary = *batch_column.dictionary_;
+    for (uint32_t i = 0; i < num_rows; i++) {
+      entries[i] = codes[i] < dictionary.size() ? dictionary[codes[i]] : storage::VarlenEntry::CreateInline(nullptr, 0);
+    }
+    vector->SetDictionary(codes, dictionary.data(), dictionary.size());
+    return;
+  }
+
+  // The entries reference their strings in the file
+  const auto *offsets = reinterpret_cast<const Offset *>(batch_column.data_) + row_offset;
+  for (uint32_t i = 0; i < num_rows; i++) {
+    const auto size = static_cast<uint32_t>(offsets[i + 1] - offsets[i]);
+    const byte *content = batch_column.strings_ + offsets[i];
+    entries[i] = size <= storage::VarlenEntry::InlineThreshold() ? storage::VarlenEntry::CreateInline(content, size)
+                                                                  : storage::VarlenEntry::Create(content, size, false);
+  }
+}
+
+}  // namespace noisepage::execution::sql
@@ -4,7 +4,11 @@
 #include <string>
 #include <vector>
 
+#include "execution/sql/tuple_id_list.h"
+#include "execution/sql/vector.h"
 #include "execution/util/bit_util.h"
+#include "execution/util/cpu_info.h"
+#include "execution/util/memory.h"
 #include "execution/util/simd.h"
 #include "loggers/execution_logger.h"
 
@@ -78,6 +82,29 @@ bool BloomFilter::Contains(hash_t hash) const {
   return block.AllBitsAtPositionsSet(masks);
 }
 
+void BloomFilter::ContainsBatch(const Vector &hashes, TupleIdList *tid_list) const {
+  NOISEPAGE_ASSERT(hashes.GetTypeId() == TypeId::Hash, "Input vector must contain hash values");
+  NOISEPAGE_ASSERT(!hashes.IsConstant(), "Input vector must not be constant");
+  NOISEPAGE_ASSERT(tid_list->GetCapacity() == hashes.GetSize(), "TID list capacity doesn't match vector size");
+
+  const auto *RESTRICT raw_hashes = reinterpret_cast<const hash_t *>(hashes.GetData());
+  const uint64_t num_hashes = hashes.GetSize();
+
+  // Blocks are probed in random order, so pull them in ahead of time when the
+  // filter doesn't fit in the cache.
+  const uint64_t l2_size = CpuInfo::Instance()->GetCacheSize(CpuInfo::L2_CACHE);
+  if (bool out_of_cache = GetSizeInBytes() > l2_size; out_of_cache) {
+    tid_list->Filter([&](const uint64_t i) {
+      if (const uint64_t prefetch_idx = i + common::Constants::K_PREFETCH_DISTANCE; prefetch_idx < num_hashes) {
+        util::Memory::Prefetch<true, Locality::Low>(blocks_[raw_hashes[prefetch_idx] & block_mask_]);
+      }
+      return Contains(raw_hashes[i]);
+    });
+  } else {
+    tid_list->Filter([&](const uint64_t i) { return Contains(raw_hashes[i]); });
+  }
+}
+
 uint64_t BloomFilter::GetTotalBitsSet() const {
   uint64_t count = 0;
   for (uint32_t i = 0; i < GetNumBlocks(); i++) {
@@ -4,6 +4,7 @@
 #include <limits>
 
 #include "common/math_util.h"
+#include "execution/util/simd.h"
 
 namespace noisepage::execution::sql {
 
@@ -76,6 +77,62 @@ std::tuple<uint64_t, uint64_t, float> ChainingHashTable<UseTags>::GetChainLength
   return {min, max, static_cast<float>(total) / capacity_};
 }
 
+template <bool UseTags>
+void ChainingHashTable<UseTags>::FindChainHeadBatch(const hash_t *hashes, const HashTableEntry **results,
+                                                    const uint64_t num_elems) const {
+  const uint64_t l3_size = CpuInfo::Instance()->GetCacheSize(CpuInfo::L3_CACHE);
+  if (bool out_of_cache = GetTotalMemoryUsage() > l3_size; out_of_cache) {
+    FindChainHeadBatchInternal<true>(hashes, results, num_elems);
+  } else {
+    FindChainHeadBatchInternal<false>(hashes, results, num_elems);
+  }
+}
+
+template <bool UseTags>
+template <bool Prefetch>
+void ChainingHashTable<UseTags>::FindChainHeadBatchInternal(const hash_t *RESTRICT hashes,
+                                                            const HashTableEntry **RESTRICT results,
+                                                            const uint64_t num_elems) const {
+  using Vec = util::simd::FilterVecSizer<int64_t>::Vec;
+  constexpr uint64_t group_size = Vec::Size();
+
+  const auto *RESTRICT directory = reinterpret_cast<const int64_t *>(entries_);
+  const Vec mask(static_cast<int64_t>(mask_));
+  const Vec pointer_mask(static_cast<int64_t>(MASK_POINTER));
+  const Vec tag_base(static_cast<int64_t>(NUM_POINTER_BITS));
+  const Vec zero(0), one(1);
+
+  uint64_t idx = 0;
+  for (; idx + group_size <= num_elems; idx += group_size) {
+    // Pull in the buckets of the group a prefetch distance ahead
+    if constexpr (Prefetch) {  // NOLINT
+      const uint64_t prefetch_idx = idx + common::Constants::K_PREFETCH_DISTANCE;
+      for (uint64_t i = prefetch_idx; i < std::min(prefetch_idx + group_size, num_elems); i++) {
+        PrefetchChainHead<true>(hashes[i]);
+      }
+    }
+
+    Vec hash_vec, heads;
+    hash_vec.Load(hashes + idx);
+    heads.Gather(directory, hash_vec & mask);
+
+    // The chain can only hold the hash if the head's tag has the hash's bit
+    // set, see TagHash(). Clear the heads that fail the check, and strip the
+    // tags from the rest.
+    if constexpr (UseTags) {  // NOLINT
+      const Vec tag_pos = (hash_vec >> (sizeof(hash_t) * 8 - 4)) + tag_base;
+      const Vec tagged = (heads >> tag_pos) & one;
+      heads = heads & pointer_mask & (zero - tagged);
+    }
+
+    heads.Store(reinterpret_cast<int64_t *>(results + idx));
+  }
+
+  for (; idx < num_elems; idx++) {
+    results[idx] = FindChainHead(hashes[idx]);
+  }
+}
+
 template class ChainingHashTable<true>;
 template class ChainingHashTable<false>;
 
@@ -0,0 +1,189 @@
+#include "execution/sql/column_group_analyzer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "catalog/catalog_accessor.h"
+#include "execution/exec/execution_context.h"
+#include "execution/exec/execution_settings.h"
+#include "execution/sql/table_vector_iterator.h"
+#include "execution/sql/vector_operations/vector_operations.h"
+#include "optimizer/statistics/column_group_stats.h"
+#include "optimizer/statistics/hyperloglog.h"
+#include "parser/expression/column_value_expression.h"
+
+namespace noisepage::execution::sql {
+
+namespace {
+
+/** Whether VectorOps::Hash() supports the vectors of a column of the type */
+bool IsHashable(const type::TypeId type) {
+  switch (type) {
+    case type::TypeId::BOOLEAN:
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+    case type::TypeId::REAL:
+    case type::TypeId::DATE:
+    case type::TypeId::TIMESTAMP:
+    case type::TypeId::VARCHAR:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/** Sketches of the distinct values of a column group, and of each of its columns alone and of the others together */
+struct GroupSketches {
+  explicit GroupSketches(const size_t num_cols)
+      : group_(std::make_unique<optimizer::HyperLogLog<hash_t>>(ColumnGroupAnalyzer::HLL_PRECISION)) {
+    for (size_t i = 0; i < num_cols; i++) {
+      columns_.emplace_back(std::make_unique<optimizer::HyperLogLog<hash_t>>(ColumnGroupAnalyzer::HLL_PRECISION));
+      others_.emplace_back(std::make_unique<optimizer::HyperLogLog<hash_t>>(ColumnGroupAnalyzer::HLL_PRECISION));
+    }
+  }
+
+  std::unique_ptr<optimizer::HyperLogLog<hash_t>> group_;
+  std::vector<std::unique_ptr<optimizer::HyperLogLog<hash_t>>> columns_;
+  std::vector<std::unique_ptr<optimizer::HyperLogLog<hash_t>>> others_;
+};
+
+/** Hash the columns of the vector projection at col_idxs together, except for the one at position skip */
+void HashColumns(const VectorProjection &vector_projection, const std::vector<uint32_t> &col_idxs, const size_t skip,
+                 Vector *hashes) {
+  bool first = true;
+  for (size_t i = 0; i < col_idxs.size(); i++) {
+    if (i == skip) continue;
+    const Vector &column = *vector_projection.GetColumn(col_idxs[i]);
+    if (first) {
+      VectorOps::Hash(column, hashes);
+    } else {
+      VectorOps::HashCombine(column, hashes);
+    }
+    first = false;
+  }
+}
+
+void UpdateSketch(const Vector &hashes, optimizer::HyperLogLog<hash_t> *sketch) {
+  const auto *raw_hashes = reinterpret_cast<const hash_t *>(hashes.GetData());
+  VectorOps::Exec(hashes, [&](const uint64_t i, UNUSED_ATTRIBUTE const uint64_t k) { sketch->Update(raw_hashes[i]); });
+}
+
+/**
+ * The degree to which the other columns determine a column. Uniformly, 1 / ndistinct(group) of the rows match
+ * equalities on all of the columns, and that is 1 / ndistinct(others) * (degree + (1 - degree) / ndistinct(column)).
+ */
+double DependencyDegree(const double num_distinct_group, const double num_distinct_others,
+                        const double num_distinct_column) {
+  if (num_distinct_column <= 1.0 || num_distinct_group <= 0.0) return 1.0;
+  const double ratio = std::min(num_distinct_others / num_distinct_group, 1.0);
+  const double degree = (ratio - 1.0 / num_distinct_column) / (1.0 - 1.0 / num_distinct_column);
+  return std::clamp(degree, 0.0, 1.0);
+}
+
+}  // namespace
+
+std::vector<std::vector<catalog::col_oid_t>> ColumnGroupAnalyzer::GetColumnGroups(catalog::CatalogAccessor *accessor,
+                                                                                   catalog::table_oid_t table_oid) {
+  const auto &schema = accessor->GetSchema(table_oid);
+  std::vector<std::vector<catalog::col_oid_t>> groups;
+  for (const auto &[index, index_schema] : accessor->GetIndexes(table_oid)) {
+    // Only keys made of plain columns are groups
+    std::vector<catalog::col_oid_t> group;
+    for (const auto &key : index_schema.GetColumns()) {
+      const auto expr = key.StoredExpression();
+      if (expr->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) {
+        group.clear();
+        break;
+      }
+      const auto col_oid = expr.CastManagedPointerTo<const parser::ColumnValueExpression>()->GetColumnOid();
+      const bool repeated = std::find(group.begin(), group.end(), col_oid) != group.end();
+      if (!IsHashable(schema.GetColumn(col_oid).Type()) || repeated) {
+        group.clear();
+        break;
+      }
+      group.emplace_back(col_oid);
+    }
+    if (group.size() > 1 && std::find(groups.begin(), groups.end(), group) == groups.end()) {
+      groups.emplace_back(std::move(group));
+    }
+  }
+  return groups;
+}
+
+StringVal ColumnGroupAnalyzer::Analyze(exec::ExecutionContext *exec_ctx, catalog::table_oid_t table_oid,
+                                       catalog::col_oid_t col_oid) {
+  std::vector<std::vector<catalog::col_oid_t>> groups;
+  for (auto &group : GetColumnGroups(exec_ctx->GetAccessor(), table_oid)) {
+    if (group.front() == col_oid) groups.emplace_back(std::move(group));
+  }
+  if (groups.empty()) return StringVal::Null();
+
+  // Every column of the groups is read once, and each group looks up its columns in the vector projection
+  std::vector<uint32_t> col_oids;
+  std::vector<std::vector<uint32_t>> group_col_idxs;
+  std::vector<GroupSketches> sketches;
+  for (const auto &group : groups) {
+    auto &col_idxs = group_col_idxs.emplace_back();
+    for (const auto group_col_oid : group) {
+      auto it = std::find(col_oids.begin(), col_oids.end(), group_col_oid.UnderlyingValue());
+      if (it == col_oids.end()) it = col_oids.insert(it, group_col_oid.UnderlyingValue());
+      col_idxs.emplace_back(std::distance(col_oids.begin(), it));
+    }
+    sketches.emplace_back(group.size());
+  }
+
+  // The scan samples as many blocks as the one of ANALYZE. The scale of that one is kept for the other statistics.
+  const double analyze_sample_scale = exec_ctx->GetSampleScale();
+  exec_ctx->SetSampleScale(1.0);
+  TableVectorIterator iter(exec_ctx, table_oid.UnderlyingValue(), col_oids.data(), col_oids.size());
+  iter.Init();
+  iter.SampleBlocks(exec_ctx->GetExecutionSettings().GetAnalyzeSampleBlocks());
+
+  uint64_t num_rows = 0;
+  Vector hashes(TypeId::Hash, true, false);
+  while (iter.Advance()) {
+    const VectorProjection &vector_projection = *iter.GetVectorProjectionIterator()->GetVectorProjection();
+    num_rows += vector_projection.GetSelectedTupleCount();
+    for (size_t group_idx = 0; group_idx < groups.size(); group_idx++) {
+      const auto &col_idxs = group_col_idxs[group_idx];
+      auto &group_sketches = sketches[group_idx];
+      HashColumns(vector_projection, col_idxs, col_idxs.size(), &hashes);
+      UpdateSketch(hashes, group_sketches.group_.get());
+      for (size_t i = 0; i < col_idxs.size(); i++) {
+        VectorOps::Hash(*vector_projection.GetColumn(col_idxs[i]), &hashes);
+        UpdateSketch(hashes, group_sketches.columns_[i].get());
+        HashColumns(vector_projection, col_idxs, i, &hashes);
+        UpdateSketch(hashes, group_sketches.others_[i].get());
+      }
+    }
+  }
+
+  std::vector<optimizer::ColumnGroupStats> group_stats;
+  for (size_t group_idx = 0; group_idx < groups.size(); group_idx++) {
+    const auto &group_sketches = sketches[group_idx];
+    const auto num_distinct = static_cast<double>(group_sketches.group_->EstimateCardinality());
+    std::vector<double> dependency_degrees;
+    for (size_t i = 0; i < groups[group_idx].size(); i++) {
+      dependency_degrees.emplace_back(
+          DependencyDegree(num_distinct, static_cast<double>(group_sketches.others_[i]->EstimateCardinality()),
+                           static_cast<double>(group_sketches.columns_[i]->EstimateCardinality())));
+    }
+    // The degrees are ratios that the sample keeps, but the number of distinct combinations grows with the table
+    const int64_t scaled_num_distinct =
+        exec_ctx->ScaleSampledDistinct(static_cast<int64_t>(num_distinct), static_cast<int64_t>(num_rows));
+    group_stats.emplace_back(groups[group_idx], scaled_num_distinct, std::move(dependency_degrees));
+  }
+  exec_ctx->SetSampleScale(analyze_sample_scale);
+
+  size_t size;
+  auto data = optimizer::ColumnGroupStats::Serialize(group_stats, &size);
+  char *const ptr = exec_ctx->GetStringAllocator()->PreAllocate(size);
+  std::memcpy(ptr, data.get(), size);
+  return StringVal(ptr, size);
+}
+
+}  // namespace noisepage::execution::sql
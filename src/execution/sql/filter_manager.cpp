@@ -1,6 +1,7 @@
 #include "execution/sql/filter_manager.h"
 
 #include <algorithm>
+#include <cmath>
 
 #include "common/settings.h"
 #include "execution/exec/execution_settings.h"
@@ -11,6 +12,17 @@
 
 namespace noisepage::execution::sql {
 
+namespace {
+
+// While a clause runs with a learned order, it samples at this fraction of the configured frequency, which is enough
+// to notice when the selectivities drift.
+constexpr double K_LEARNED_ORDER_SAMPLE_RATIO = 0.1;
+
+// A sampled selectivity farther than this from the learned one means the data changed since the order was learned.
+constexpr double K_MAX_SELECTIVITY_DRIFT = 0.1;
+
+}  // namespace
+
 //===----------------------------------------------------------------------===//
 //
 // Filter Manager Clause
@@ -22,6 +34,7 @@ FilterManager::Clause::Clause(void *opaque_context, double stat_sample_freq)
       input_copy_(common::Constants::K_DEFAULT_VECTOR_SIZE),
       temp_(common::Constants::K_DEFAULT_VECTOR_SIZE),
       sample_freq_(stat_sample_freq),
+      full_sample_freq_(stat_sample_freq),
       sample_count_(0),
       overhead_micros_(0),
 #ifndef NDEBUG
@@ -78,11 +91,26 @@ void FilterManager::Clause::RunFilter(exec::ExecutionContext *exec_ctx, VectorPr
     const auto term_selectivity = temp_.ComputeSelectivity();
     const auto term_cost = exec_ns / tuple_count;
     term->rank_ = (input_selectivity - term_selectivity) / term_cost;
+    term->selectivity_ = term_selectivity / input_selectivity;
     EXECUTION_LOG_TRACE("Term [{}]: term-selectivity={:04.3f}, cost={:>06.3f}, rank={:.8f}", term->insertion_index_,
                         term_selectivity, term_cost, term->rank_);
     tid_list->IntersectWith(temp_);
   }
 
+  // Go back to sampling at the full frequency once the selectivities drift from the ones the order was learned with
+  if (!learned_selectivities_.empty()) {
+    for (const auto &term : terms_) {
+      if (std::abs(term->selectivity_ - learned_selectivities_[term->insertion_index_]) > K_MAX_SELECTIVITY_DRIFT) {
+        EXECUTION_LOG_DEBUG("Term [{}] drifted from the learned selectivity {:04.3f} to {:04.3f}",
+                            term->insertion_index_, learned_selectivities_[term->insertion_index_],
+                            term->selectivity_);
+        learned_selectivities_.clear();
+        sample_freq_ = full_sample_freq_;
+        break;
+      }
+    }
+  }
+
 #ifndef NDEBUG
   // Log a message if the term ordering after re-ranking has changed.
   const auto old_order = GetOptimalTermOrder();
@@ -108,22 +136,66 @@ std::vector<uint32_t> FilterManager::Clause::GetOptimalTermOrder() const {
   return result;
 }
 
+std::vector<FilterManager::MatchFn> FilterManager::Clause::GetTermFunctions() const {
+  std::vector<MatchFn> result(terms_.size());
+  for (const auto &term : terms_) {
+    result[term->insertion_index_] = term->fn_;
+  }
+  return result;
+}
+
+void FilterManager::Clause::RestoreOrder(const FilterOrderCache &order_cache) {
+  FilterOrderCache::LearnedOrder order;
+  if (!order_cache.Lookup(GetTermFunctions(), &order)) return;
+
+  for (const auto &term : terms_) {
+    term->rank_ = order.ranks_[term->insertion_index_];
+    term->selectivity_ = order.selectivities_[term->insertion_index_];
+  }
+  std::sort(terms_.begin(), terms_.end(), [](const auto &a, const auto &b) { return a->rank_ > b->rank_; });
+  learned_selectivities_ = std::move(order.selectivities_);
+  sample_freq_ = full_sample_freq_ * K_LEARNED_ORDER_SAMPLE_RATIO;
+}
+
+void FilterManager::Clause::SaveOrder(FilterOrderCache *order_cache) const {
+  if (sample_count_ == 0) return;
+
+  FilterOrderCache::LearnedOrder order;
+  order.ranks_.resize(terms_.size());
+  order.selectivities_.resize(terms_.size());
+  for (const auto &term : terms_) {
+    order.ranks_[term->insertion_index_] = term->rank_;
+    order.selectivities_[term->insertion_index_] = term->selectivity_;
+  }
+  order_cache->Save(GetTermFunctions(), std::move(order));
+}
+
 //===----------------------------------------------------------------------===//
 //
 // Filter Manager
 //
 //===----------------------------------------------------------------------===//
 
-FilterManager::FilterManager(const exec::ExecutionSettings &exec_settings, bool adapt, void *context)
+FilterManager::FilterManager(const exec::ExecutionSettings &exec_settings, bool adapt, void *context,
+                             common::ManagedPointer<FilterOrderCache> order_cache)
     : exec_settings_(exec_settings),
       adapt_(adapt),
       opaque_context_(context),
+      order_cache_(order_cache),
+      orders_restored_(false),
       input_list_(common::Constants::K_DEFAULT_VECTOR_SIZE),
       output_list_(common::Constants::K_DEFAULT_VECTOR_SIZE),
       tmp_list_(common::Constants::K_DEFAULT_VECTOR_SIZE) {
   clauses_.reserve(4);
 }
 
+FilterManager::~FilterManager() {
+  if (!IsAdaptive() || order_cache_ == nullptr) return;
+  for (const auto &clause : clauses_) {
+    clause->SaveOrder(order_cache_.Get());
+  }
+}
+
 void FilterManager::StartNewClause() {
   double sample_freq = exec_settings_.GetAdaptivePredicateOrderSamplingFrequency();
   if (!IsAdaptive()) sample_freq = 0.0;
@@ -144,6 +216,16 @@ void FilterManager::InsertClauseTerms(const std::vector<MatchFn> &terms) {
 }
 
 void FilterManager::RunFilters(exec::ExecutionContext *exec_ctx, VectorProjection *input_batch) {
+  // The clauses are complete by the first time they run, and can start from the orders learned for them
+  if (UNLIKELY(!orders_restored_)) {
+    if (IsAdaptive() && order_cache_ != nullptr) {
+      for (const auto &clause : clauses_) {
+        clause->RestoreOrder(*order_cache_);
+      }
+    }
+    orders_restored_ = true;
+  }
+
   // Initialize the input, output, and temporary tuple ID lists for processing
   // this projection. This check just ensures they're all the same shape.
   if (const uint32_t projection_size = input_batch->GetTotalTupleCount();
@@ -196,4 +278,33 @@ std::vector<const FilterManager::Clause *> FilterManager::GetOptimalClauseOrder(
   return opt;
 }
 
+//===----------------------------------------------------------------------===//
+//
+// Filter Order Cache
+//
+//===----------------------------------------------------------------------===//
+
+std::vector<uintptr_t> FilterOrderCache::MakeKey(const std::vector<FilterManager::MatchFn> &terms) {
+  std::vector<uintptr_t> key(terms.size());
+  for (uint32_t i = 0; i < terms.size(); i++) {
+    key[i] = reinterpret_cast<uintptr_t>(terms[i]);
+  }
+  return key;
+}
+
+bool FilterOrderCache::Lookup(const std::vector<FilterManager::MatchFn> &terms, LearnedOrder *order) const {
+  const auto key = MakeKey(terms);
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  const auto iter = orders_.find(key);
+  if (iter == orders_.end()) return false;
+  *order = iter->second;
+  return true;
+}
+
+void FilterOrderCache::Save(const std::vector<FilterManager::MatchFn> &terms, LearnedOrder order) {
+  auto key = MakeKey(terms);
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  orders_[std::move(key)] = std::move(order);
+}
+
 }  // namespace noisepage::execution::sql
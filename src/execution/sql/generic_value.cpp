@@ -199,6 +199,9 @@ GenericValue GenericValue::CreateVarchar(std::string_view str) {
 }
 
 GenericValue GenericValue::CreateFromRuntimeValue(const TypeId type_id, const Val &val) {
+  if (val.is_null_) {
+    return GenericValue::CreateNull(type_id);
+  }
   switch (type_id) {
     case TypeId::Boolean:
       return GenericValue::CreateBoolean(static_cast<const BoolVal &>(val).val_);
@@ -1,8 +1,17 @@
 #include "execution/sql/index_iterator.h"
 
+#include <tbb/parallel_for.h>
+
+#include <utility>
+#include <vector>
+
 #include "catalog/catalog_accessor.h"
+#include "execution/exec/execution_settings.h"
+#include "execution/exec/task_scheduler.h"
+#include "execution/sql/thread_state_container.h"
 #include "execution/sql/value.h"
 #include "storage/sql_table.h"
+#include "transaction/transaction_context.h"
 
 namespace noisepage::execution::sql {
 
@@ -14,6 +23,12 @@ IndexIterator::IndexIterator(exec::ExecutionContext *exec_ctx, uint32_t num_attr
       index_(exec_ctx_->GetAccessor()->GetIndex(catalog::index_oid_t(index_oid))),
       table_(exec_ctx_->GetAccessor()->GetTable(catalog::table_oid_t(table_oid))) {}
 
+IndexIterator::IndexIterator(exec::ExecutionContext *exec_ctx, uint32_t num_attrs,
+                             std::vector<catalog::col_oid_t> col_oids,
+                             common::ManagedPointer<storage::index::Index> index,
+                             common::ManagedPointer<storage::SqlTable> table)
+    : exec_ctx_(exec_ctx), num_attrs_(num_attrs), col_oids_(std::move(col_oids)), index_(index), table_(table) {}
+
 void IndexIterator::Init() {
   // Initialize projected rows for the index and the table
   NOISEPAGE_ASSERT(!col_oids_.empty(), "There must be at least one col oid!");
@@ -72,6 +87,38 @@ storage::ProjectedRow *IndexIterator::TablePR() {
   return table_pr_;
 }
 
+void IndexIterator::ParallelScan(IndexIterator *const iter, const storage::index::ScanType scan_type,
+                                 void *const query_state, const IndexIterator::ScanFn scan_fn) {
+  exec::ExecutionContext *const exec_ctx = iter->exec_ctx_;
+  ThreadStateContainer *const thread_state_container = exec_ctx->GetThreadStateContainer();
+  const uint32_t max_partitions =
+      exec::TaskScheduler::MaxConcurrency(exec_ctx->GetExecutionSettings()) * PARTITIONS_PER_THREAD;
+  const auto partitions = iter->index_->PartitionAscending(scan_type, iter->num_attrs_, iter->index_pr_,
+                                                           iter->hi_index_pr_, max_partitions);
+
+  if (partitions == nullptr) {
+    iter->ScanAscending(scan_type, 0);
+    scan_fn(query_state, thread_state_container->AccessCurrentThreadState(), iter);
+  } else {
+    tbb::blocked_range<uint32_t> partition_range(0, partitions->NumPartitions(), 1);
+    exec::TaskScheduler::Execute(exec_ctx, partitions->NumPartitions(), [&] {
+      tbb::parallel_for(partition_range, [&](const tbb::blocked_range<uint32_t> &range) {
+        for (uint32_t partition = range.begin(); partition < range.end(); partition++) {
+          IndexIterator partition_iter(exec_ctx, iter->num_attrs_, iter->col_oids_, iter->index_, iter->table_);
+          partition_iter.Init();
+          partitions->Scan(*exec_ctx->GetTxn(), partition, &partition_iter.tuples_);
+          transaction::TransactionContext::WorkerScope worker_scope(exec_ctx->GetTxn());
+          scan_fn(query_state, thread_state_container->AccessCurrentThreadState(), &partition_iter);
+        }
+      });
+    });
+    exec_ctx->GetTxn()->MergeWorkerWrites();
+  }
+
+  auto *tls = thread_state_container->AccessCurrentThreadState();
+  exec_ctx->InvokeHook(static_cast<uint32_t>(HookOffsets::EndHook), tls, nullptr);
+}
+
 IndexIterator::~IndexIterator() {
   // Free allocated buffers
   exec_ctx_->GetMemoryPool()->Deallocate(table_buffer_, table_pr_->Size());
@@ -1,17 +1,25 @@
 #include "execution/sql/join_hash_table.h"
 
 #include <llvm/ADT/STLExtras.h>
+#include <llvm/Support/MathExtras.h>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_for_each.h>
-#include <tbb/task_scheduler_init.h>
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
 #include <limits>
+#include <numeric>
 #include <utility>
 #include <vector>
 
 #include "count/hll.h"
 #include "execution/exec/execution_context.h"
+#include "execution/exec/execution_settings.h"
+#include "execution/exec/task_scheduler.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/spill_file.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/sql/vector.h"
 #include "execution/sql/vector_operations/unary_operation_executor.h"
@@ -32,10 +40,25 @@ JoinHashTable::JoinHashTable(const exec::ExecutionSettings &exec_settings, exec:
       hll_estimator_(libcount::HLL::Create(DEFAULT_HLL_PRECISION)),
       built_(false),
       use_concise_ht_(use_concise_ht),
-      tracker_(exec_ctx->GetMemoryPool()->GetTracker()) {}
-
-// Needed because we forward-declared HLL from libcount
-JoinHashTable::~JoinHashTable() = default;
+      use_runtime_filter_(false),
+      use_compact_layout_(false),
+      tuple_size_(tuple_size),
+      compact_tuples_(nullptr),
+      compact_directory_(nullptr),
+      compact_mask_(0),
+      tracker_(exec_ctx->GetMemoryPool()->GetTracker()),
+      memory_budget_(0),
+      probe_tuple_size_(0),
+      spilled_partitions_(0) {}
+
+// Defined here because we forward-declared HLL from libcount
+JoinHashTable::~JoinHashTable() {
+  if (UsingCompactLayout()) {
+    MemoryPool *memory = exec_ctx_->GetMemoryPool();
+    memory->DeallocateArray(compact_tuples_, GetBufferedTupleMemoryUsage());
+    memory->DeallocateArray(compact_directory_, compact_mask_ + 2);
+  }
+}
 
 byte *JoinHashTable::AllocInputTuple(const hash_t hash) {
   // Add to unique_count estimation
@@ -500,11 +523,16 @@ void JoinHashTable::Build() {
   util::Timer<> timer;
   timer.Start();
 
+  // Spill what does not fit, then build over the resident partitions
+  SpillIfOverMemoryBudget({&entries_});
+  BuildRuntimeFilter({&entries_});
+
   // Build
   if (UsingConciseHashTable()) {
     BuildConciseHashTable();
   } else {
     BuildChainingHashTable();
+    CompactEntries();
   }
 
   timer.Stop();
@@ -518,9 +546,23 @@ void JoinHashTable::Build() {
 // TODO(pmenon): Implement prefetching.
 
 void JoinHashTable::LookupBatchInChainingHashTable(const Vector &hashes, Vector *results) const {
-  UnaryOperationExecutor::Execute<hash_t, const HashTableEntry *>(
-      exec_settings_, hashes,
-      results, [&](const hash_t hash_val) noexcept { return chaining_hash_table_.FindChainHead(hash_val); });
+  // Sparse or constant inputs are probed one at a time. Otherwise, we probe
+  // every element, selected or not, so the directory can be searched in SIMD.
+  const TupleIdList *tid_list = hashes.GetFilteredTupleIdList();
+  if (hashes.IsConstant() ||
+      (tid_list != nullptr && tid_list->ComputeSelectivity() < exec_settings_.GetArithmeticFullComputeOptThreshold())) {
+    UnaryOperationExecutor::Execute<hash_t, const HashTableEntry *>(
+        exec_settings_, hashes,
+        results, [&](const hash_t hash_val) noexcept { return chaining_hash_table_.FindChainHead(hash_val); });
+    return;
+  }
+
+  results->Resize(hashes.GetSize());
+  results->GetMutableNullMask()->Copy(hashes.GetNullMask());
+  results->SetFilteredTupleIdList(tid_list, hashes.GetCount());
+  chaining_hash_table_.FindChainHeadBatch(reinterpret_cast<const hash_t *>(hashes.GetData()),
+                                          reinterpret_cast<const HashTableEntry **>(results->GetData()),
+                                          hashes.GetSize());
 }
 
 void JoinHashTable::LookupBatchInConciseHashTable(const Vector &hashes, Vector *results) const {
@@ -533,6 +575,7 @@ void JoinHashTable::LookupBatchInConciseHashTable(const Vector &hashes, Vector *
 
 void JoinHashTable::LookupBatch(const Vector &hashes, Vector *results) const {
   NOISEPAGE_ASSERT(IsBuilt(), "Cannot perform lookup before table is built!");
+  NOISEPAGE_ASSERT(!UsingCompactLayout(), "Tables in the compact layout have no entries to hand out!");
   if (UsingConciseHashTable()) {
     LookupBatchInConciseHashTable(hashes, results);
   } else {
@@ -558,6 +601,19 @@ void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container,
   std::vector<JoinHashTable *> tl_join_tables;
   thread_state_container->CollectThreadLocalStateElementsAs(&tl_join_tables, jht_offset);
 
+  // If the build side does not fit, spill partitions of it and build serially
+  // over the rest. The thread-local tuples are moved into our own entries.
+  std::vector<decltype(entries_) *> tl_entries;
+  for (auto *jht : tl_join_tables) {
+    tl_entries.push_back(&jht->entries_);
+  }
+  if (SpillIfOverMemoryBudget(tl_entries)) {
+    BuildChainingHashTable();
+    built_ = true;
+    return;
+  }
+  BuildRuntimeFilter(tl_entries);
+
   // Combine HLL counts to get a global estimate
   for (auto *jht : tl_join_tables) {
     hll_estimator_->Merge(jht->hll_estimator_.get());
@@ -589,27 +645,30 @@ void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container,
     llvm::for_each(tl_join_tables, [this](auto *source) { MergeIncomplete<false>(source); });
 
     exec_ctx_->InvokeHook(post_hook, tls, reinterpret_cast<void *>(num_elem_estimate));
+  } else if (const uint32_t radix_bits = ComputeBuildPartitionBits(); radix_bits > 0) {
+    EXECUTION_LOG_TRACE("JHT: Estimated {} elements >= {} element parallel threshold. Using {}-bit radix merge.",
+                        num_elem_estimate, DEFAULT_MIN_SIZE_FOR_PARALLEL_MERGE, radix_bits);
+    MergeRadixPartitioned(thread_state_container, tl_join_tables, radix_bits);
   } else {
     EXECUTION_LOG_TRACE("JHT: Estimated {} elements >= {} element parallel threshold. Using parallel merge.",
                         num_elem_estimate, DEFAULT_MIN_SIZE_FOR_PARALLEL_MERGE);
 
-    size_t num_threads = tbb::task_scheduler_init::default_num_threads();
-    size_t num_tasks = tl_join_tables.size();
-    auto estimate = std::min(num_threads, num_tasks);
-    exec_ctx_->SetNumConcurrentEstimate(estimate);
-    tbb::parallel_for_each(tl_join_tables, [this, thread_state_container](auto source) {
-      auto pre_hook = static_cast<uint32_t>(HookOffsets::StartHook);
-      auto post_hook = static_cast<uint32_t>(HookOffsets::EndHook);
-      auto *tls = thread_state_container->AccessCurrentThreadState();
-      exec_ctx_->InvokeHook(pre_hook, tls, nullptr);
+    exec::TaskScheduler::Execute(exec_ctx_, tl_join_tables.size(), [&] {
+      tbb::parallel_for_each(tl_join_tables, [this, thread_state_container](auto source) {
+        auto pre_hook = static_cast<uint32_t>(HookOffsets::StartHook);
+        auto post_hook = static_cast<uint32_t>(HookOffsets::EndHook);
+        auto *tls = thread_state_container->AccessCurrentThreadState();
+        exec_ctx_->InvokeHook(pre_hook, tls, nullptr);
 
-      size_t size = source->entries_.size();
-      MergeIncomplete<true>(source);
-      exec_ctx_->InvokeHook(post_hook, tls, reinterpret_cast<void *>(size));
+        size_t size = source->entries_.size();
+        MergeIncomplete<true>(source);
+        exec_ctx_->InvokeHook(post_hook, tls, reinterpret_cast<void *>(size));
+      });
     });
-    exec_ctx_->SetNumConcurrentEstimate(0);
   }
 
+  CompactEntries();
+
   timer.Stop();
 
   UNUSED_ATTRIBUTE const double tps = (chaining_hash_table_.GetElementCount() / timer.GetElapsed()) / 1000.0;
@@ -620,4 +679,361 @@ void JoinHashTable::MergeParallel(ThreadStateContainer *thread_state_container,
   built_ = true;
 }
 
+uint32_t JoinHashTable::ComputeBuildPartitionBits() const {
+  const auto directory_bits = static_cast<uint32_t>(llvm::Log2_64(chaining_hash_table_.GetCapacity()));
+  const int64_t configured_bits = exec_settings_.GetJoinBuildPartitionBits();
+  if (configured_bits >= 0) {
+    return std::min(static_cast<uint32_t>(configured_bits), directory_bits);
+  }
+
+  // Pick the fewest partitions whose directory slices each fit in the L2.
+  const uint64_t directory_size = chaining_hash_table_.GetTotalMemoryUsage();
+  const uint64_t l2_size = CpuInfo::Instance()->GetCacheSize(CpuInfo::L2_CACHE);
+  if (l2_size == 0 || directory_size <= l2_size) {
+    return 0;
+  }
+  const auto bits = static_cast<uint32_t>(llvm::Log2_64_Ceil(directory_size / l2_size));
+  return std::min({bits, MAX_BUILD_PARTITION_BITS, directory_bits});
+}
+
+void JoinHashTable::MergeRadixPartitioned(ThreadStateContainer *thread_state_container,
+                                          const std::vector<JoinHashTable *> &tl_join_tables,
+                                          const uint32_t radix_bits) {
+  // A partition is a contiguous slice of the directory: the top bits of the
+  // bucket index. Probes need no routing, they land in the right slice.
+  const uint32_t num_partitions = 1u << radix_bits;
+  const auto num_sources = static_cast<uint32_t>(tl_join_tables.size());
+  const uint64_t mask = chaining_hash_table_.GetCapacity() - 1;
+  const uint32_t shift = llvm::Log2_64(chaining_hash_table_.GetCapacity()) - radix_bits;
+  const auto partition_of = [=](const byte *entry) {
+    return static_cast<uint32_t>((reinterpret_cast<const HashTableEntry *>(entry)->hash_ & mask) >> shift);
+  };
+
+  // First pass: count each source's entries per partition.
+  std::vector<std::vector<uint64_t>> cursors(num_sources, std::vector<uint64_t>(num_partitions, 0));
+  exec::TaskScheduler::Execute(exec_ctx_, num_sources, [&] {
+    tbb::parallel_for(uint32_t{0}, num_sources, [&](const uint32_t source_idx) {
+      for (const byte *entry : tl_join_tables[source_idx]->entries_) {
+        cursors[source_idx][partition_of(entry)]++;
+      }
+    });
+  });
+
+  // Lay the partitions out one after the other, each holding the entries of
+  // all sources. The counts become every source's write cursors.
+  std::vector<uint64_t> partition_starts(num_partitions + 1);
+  uint64_t num_entries = 0;
+  for (uint32_t part_idx = 0; part_idx < num_partitions; part_idx++) {
+    partition_starts[part_idx] = num_entries;
+    for (auto &source_cursors : cursors) {
+      const uint64_t count = source_cursors[part_idx];
+      source_cursors[part_idx] = num_entries;
+      num_entries += count;
+    }
+  }
+  partition_starts[num_partitions] = num_entries;
+
+  // Second pass: scatter pointers to the entries into their partitions. The
+  // entries themselves stay where they are.
+  std::vector<HashTableEntry *> partitioned(num_entries);
+  exec::TaskScheduler::Execute(exec_ctx_, num_sources, [&] {
+    tbb::parallel_for(uint32_t{0}, num_sources, [&](const uint32_t source_idx) {
+      for (byte *entry : tl_join_tables[source_idx]->entries_) {
+        partitioned[cursors[source_idx][partition_of(entry)]++] = reinterpret_cast<HashTableEntry *>(entry);
+      }
+    });
+  });
+
+  // Build each partition's slice of the directory. No two partitions share a
+  // bucket, so the inserts need no synchronization.
+  exec::TaskScheduler::Execute(exec_ctx_, num_partitions, [&] {
+    tbb::parallel_for(uint32_t{0}, num_partitions, [&](const uint32_t part_idx) {
+      auto pre_hook = static_cast<uint32_t>(HookOffsets::StartHook);
+      auto post_hook = static_cast<uint32_t>(HookOffsets::EndHook);
+      auto *tls = thread_state_container->AccessCurrentThreadState();
+      exec_ctx_->InvokeHook(pre_hook, tls, nullptr);
+
+      const uint64_t size = partition_starts[part_idx + 1] - partition_starts[part_idx];
+      chaining_hash_table_.InsertBatch<false>(&partitioned[partition_starts[part_idx]], size);
+      exec_ctx_->InvokeHook(post_hook, tls, reinterpret_cast<void *>(size));
+    });
+  });
+
+  // Take ownership of the thread-local tables' memory
+  for (auto *source : tl_join_tables) {
+    owned_.emplace_back(std::move(source->entries_));
+  }
+}
+
+void JoinHashTable::EnableSpilling(const uint32_t probe_tuple_size) {
+  NOISEPAGE_ASSERT(!IsBuilt(), "Spilling must be enabled before the table is built");
+  // The concise hash table is built over all tuples at once, so it never spills.
+  if (UsingConciseHashTable()) {
+    return;
+  }
+  memory_budget_ = exec_settings_.GetJoinMemoryBudget();
+  probe_tuple_size_ = probe_tuple_size;
+}
+
+void JoinHashTable::EnableCompactLayout() {
+  NOISEPAGE_ASSERT(!IsBuilt(), "The compact layout must be enabled before the table is built");
+  // The concise hash table already stores its entries in bucket order.
+  if (UsingConciseHashTable() || tuple_size_ == 0) {
+    return;
+  }
+  use_compact_layout_ = exec_settings_.GetIsJoinCompactLayoutEnabled();
+}
+
+void JoinHashTable::CompactEntries() {
+  const uint64_t num_tuples = GetTupleCount();
+  if (!use_compact_layout_ || HasSpilledPartitions() || num_tuples == 0) {
+    return;
+  }
+
+  // The compact directory has the buckets of the chaining table, so that its
+  // chains, visited in bucket order, yield the tuples in their final order.
+  // Each task lays out a slice of the buckets.
+  const uint64_t num_buckets = chaining_hash_table_.GetCapacity();
+  const uint64_t num_tasks = (num_buckets + COMPACT_BUCKETS_PER_TASK - 1) / COMPACT_BUCKETS_PER_TASK;
+  const auto for_each_task = [&](auto &&task) {
+    if (num_tasks == 1) {
+      task(uint64_t{0});
+      return;
+    }
+    exec::TaskScheduler::Execute(exec_ctx_, num_tasks, [&] { tbb::parallel_for(uint64_t{0}, num_tasks, task); });
+  };
+  const auto slice_end = [&](const uint64_t task_idx) {
+    return std::min(num_buckets, (task_idx + 1) * COMPACT_BUCKETS_PER_TASK);
+  };
+
+  // First pass: count the tuples in each slice to find where they go. A
+  // single slice holds all tuples.
+  std::vector<uint64_t> task_starts(num_tasks + 1, 0);
+  if (num_tasks > 1) {
+    for_each_task([&](const uint64_t task_idx) {
+      uint64_t count = 0;
+      chaining_hash_table_.ForEachEntry(task_idx * COMPACT_BUCKETS_PER_TASK, slice_end(task_idx),
+                                        [&](uint64_t, const HashTableEntry *) { count++; });
+      task_starts[task_idx + 1] = count;
+    });
+    std::partial_sum(task_starts.begin(), task_starts.end(), task_starts.begin());
+  }
+  task_starts[num_tasks] = num_tuples;
+
+  // Second pass: copy the tuples out of their entries, recording where each
+  // bucket begins and the tags of the hashes in it.
+  MemoryPool *memory = exec_ctx_->GetMemoryPool();
+  auto *tuples = memory->AllocateArray<byte>(num_tuples * tuple_size_, alignof(std::max_align_t), false);
+  auto *directory = memory->AllocateArray<uint64_t>(num_buckets + 1, false);
+  for_each_task([&](const uint64_t task_idx) {
+    uint64_t tuple_idx = task_starts[task_idx];
+    uint64_t next_bucket = task_idx * COMPACT_BUCKETS_PER_TASK;
+    chaining_hash_table_.ForEachEntry(next_bucket, slice_end(task_idx),
+                                      [&](const uint64_t bucket, const HashTableEntry *entry) {
+                                        for (; next_bucket <= bucket; next_bucket++) {
+                                          directory[next_bucket] = tuple_idx;
+                                        }
+                                        directory[bucket] |= CompactTag(entry->hash_);
+                                        std::memcpy(tuples + tuple_idx * tuple_size_, entry->payload_, tuple_size_);
+                                        tuple_idx++;
+                                      });
+    for (; next_bucket < slice_end(task_idx); next_bucket++) {
+      directory[next_bucket] = tuple_idx;
+    }
+    NOISEPAGE_ASSERT(tuple_idx == task_starts[task_idx + 1], "Slice holds a different number of tuples than counted");
+  });
+  directory[num_buckets] = num_tuples;
+
+  // The entries and the chaining table are no longer needed
+  const MemoryPoolAllocator<byte> allocator(memory);
+  entries_ = decltype(entries_)(entries_.ElementSize(), allocator);
+  owned_.clear();
+  chaining_hash_table_.SetSize(0, tracker_);
+
+  compact_tuples_ = tuples;
+  compact_directory_ = directory;
+  compact_mask_ = num_buckets - 1;
+  EXECUTION_LOG_DEBUG("JHT: compacted {} tuples into {} buckets", num_tuples, num_buckets);
+}
+
+void JoinHashTable::EnableRuntimeFilter() {
+  NOISEPAGE_ASSERT(!IsBuilt(), "The runtime filter must be enabled before the table is built");
+  use_runtime_filter_ = true;
+}
+
+void JoinHashTable::BuildRuntimeFilter(const std::vector<decltype(entries_) *> &sources) {
+  if (!use_runtime_filter_ || HasBloomFilter()) {
+    return;
+  }
+
+  uint64_t num_entries = 0;
+  for (const auto *source : sources) {
+    num_entries += source->size();
+  }
+  if (num_entries == 0) {
+    return;
+  }
+
+  bloom_filter_.Init(exec_ctx_->GetMemoryPool(), static_cast<uint32_t>(num_entries));
+  for (const auto *source : sources) {
+    for (const byte *entry : *source) {
+      bloom_filter_.Add(reinterpret_cast<const HashTableEntry *>(entry)->hash_);
+    }
+  }
+}
+
+bool JoinHashTable::SpillIfOverMemoryBudget(const std::vector<decltype(entries_) *> &sources) {
+  if (memory_budget_ == 0) {
+    return false;
+  }
+
+  const uint64_t entry_size = entries_.ElementSize();
+  const auto budget = static_cast<uint64_t>(memory_budget_);
+  uint64_t num_entries = 0;
+  for (const auto *source : sources) {
+    num_entries += source->size();
+  }
+  if (num_entries * entry_size <= budget) {
+    return false;
+  }
+
+  // Size the radix partitions. The bloom filter covers the whole build side,
+  // so that probe tuples without a partner are dropped rather than spilled.
+  std::array<uint64_t, NUM_SPILL_PARTITIONS> partition_sizes{};
+  bloom_filter_.Init(exec_ctx_->GetMemoryPool(), static_cast<uint32_t>(num_entries));
+  for (const auto *source : sources) {
+    for (const byte *entry : *source) {
+      const hash_t hash = reinterpret_cast<const HashTableEntry *>(entry)->hash_;
+      partition_sizes[SpillPartitionOf(hash)]++;
+      bloom_filter_.Add(hash);
+    }
+  }
+
+  // Spill the highest partitions until the rest fits
+  uint64_t num_resident = num_entries;
+  for (uint32_t part_idx = NUM_SPILL_PARTITIONS; part_idx-- > 0 && num_resident * entry_size > budget;) {
+    spilled_partitions_ |= uint64_t{1} << part_idx;
+    num_resident -= partition_sizes[part_idx];
+  }
+
+  spill_file_ = std::make_unique<SpillFile>();
+  build_spills_ = std::make_unique<SpilledPartition[]>(NUM_SPILL_PARTITIONS);
+  probe_spills_ = std::make_unique<SpilledPartition[]>(NUM_SPILL_PARTITIONS);
+
+  // Write out the spilled tuples and compact the resident ones. Each source is
+  // released as soon as it has been distributed.
+  const MemoryPoolAllocator<byte> allocator(exec_ctx_->GetMemoryPool());
+  decltype(entries_) resident_entries(entry_size, allocator);
+  for (auto *source : sources) {
+    for (const byte *entry : *source) {
+      const hash_t hash = reinterpret_cast<const HashTableEntry *>(entry)->hash_;
+      if (IsSpilled(hash)) {
+        SpilledPartition *partition = &build_spills_[SpillPartitionOf(hash)];
+        partition->buffer_.insert(partition->buffer_.end(), entry, entry + entry_size);
+        if (partition->buffer_.size() >= SPILL_BUFFER_SIZE) {
+          FlushSpilledPartition(partition);
+        }
+      } else {
+        std::memcpy(resident_entries.Append(), entry, entry_size);
+      }
+    }
+    *source = decltype(entries_)(entry_size, allocator);
+  }
+  for (uint32_t part_idx = 0; part_idx < NUM_SPILL_PARTITIONS; part_idx++) {
+    FlushSpilledPartition(&build_spills_[part_idx]);
+  }
+  entries_ = std::move(resident_entries);
+
+  EXECUTION_LOG_DEBUG("JHT: {} of {} build tuples over budget of {} bytes, spilled partitions {:#x}",
+                      num_entries - num_resident, num_entries, budget, spilled_partitions_);
+  return true;
+}
+
+void JoinHashTable::FlushSpilledPartition(SpilledPartition *partition) {
+  if (partition->buffer_.empty()) {
+    return;
+  }
+  uint64_t offset;
+  {
+    common::SpinLatch::ScopedSpinLatch latch(&spill_file_latch_);
+    offset = spill_file_->Append(partition->buffer_.data(), partition->buffer_.size());
+  }
+  partition->runs_.emplace_back(offset, partition->buffer_.size());
+  partition->buffer_.clear();
+}
+
+template <typename F>
+void JoinHashTable::ReadSpilledPartition(const SpilledPartition &partition, const std::size_t tuple_size,
+                                         F &&consumer) const {
+  // Runs only ever hold whole tuples, so reading a multiple of the tuple size
+  // at a time never splits one.
+  std::vector<byte> tuples(tuple_size * SPILL_READ_BATCH_SIZE);
+  for (const auto &[offset, size] : partition.runs_) {
+    for (uint64_t done = 0; done < size;) {
+      const uint64_t count = std::min<uint64_t>(size - done, tuples.size());
+      spill_file_->Read(offset + done, tuples.data(), count);
+      for (uint64_t pos = 0; pos < count; pos += tuple_size) {
+        consumer(&tuples[pos]);
+      }
+      done += count;
+    }
+  }
+}
+
+void JoinHashTable::SpillProbeTuple(const hash_t hash, const byte *probe_tuple) {
+  NOISEPAGE_ASSERT(IsSpilled(hash), "Probe tuple does not belong to a spilled partition");
+  if (!bloom_filter_.Contains(hash)) {
+    return;
+  }
+  SpilledPartition *partition = &probe_spills_[SpillPartitionOf(hash)];
+  common::SpinLatch::ScopedSpinLatch latch(&partition->latch_);
+  partition->buffer_.insert(partition->buffer_.end(), probe_tuple, probe_tuple + probe_tuple_size_);
+  if (partition->buffer_.size() >= SPILL_BUFFER_SIZE) {
+    FlushSpilledPartition(partition);
+  }
+}
+
+void JoinHashTable::ProcessSpilledPartitions(void *query_state, void *pipeline_state,
+                                             const JoinHashTable::SpilledProbeFn probe_fn) {
+  if (!HasSpilledPartitions()) {
+    return;
+  }
+
+  // All resident partitions have been probed, so their tuples can go. From
+  // now on, the table holds one spilled partition at a time.
+  const uint64_t spilled_partitions = spilled_partitions_;
+  spilled_partitions_ = 0;
+
+  const uint64_t entry_size = entries_.ElementSize();
+  const MemoryPoolAllocator<byte> allocator(exec_ctx_->GetMemoryPool());
+  for (uint32_t part_idx = 0; part_idx < NUM_SPILL_PARTITIONS; part_idx++) {
+    if ((spilled_partitions & (uint64_t{1} << part_idx)) == 0) {
+      continue;
+    }
+
+    // Nothing to do if no probe tuple made it past the bloom filter
+    SpilledPartition *probe_partition = &probe_spills_[part_idx];
+    FlushSpilledPartition(probe_partition);
+    if (probe_partition->runs_.empty()) {
+      continue;
+    }
+
+    // Load and index the build side of the partition
+    entries_ = decltype(entries_)(entry_size, allocator);
+    ReadSpilledPartition(build_spills_[part_idx], entry_size,
+                         [&](const byte *entry) { std::memcpy(entries_.Append(), entry, entry_size); });
+    BuildChainingHashTable();
+
+    // Probe it
+    ReadSpilledPartition(*probe_partition, probe_tuple_size_,
+                         [&](const byte *probe_tuple) { probe_fn(query_state, pipeline_state, probe_tuple); });
+  }
+
+  entries_ = decltype(entries_)(entry_size, allocator);
+  chaining_hash_table_.SetSize(0, tracker_);
+  spill_file_.reset();
+  build_spills_.reset();
+  probe_spills_.reset();
+}
+
 }  // namespace noisepage::execution::sql
@@ -6,7 +6,11 @@ JoinHashTableIterator::JoinHashTableIterator(const JoinHashTable &table)
     : entry_list_iter_(table.owned_.begin()),
       entry_list_end_(table.owned_.end()),
       entry_iter_(table.entries_.begin()),
-      entry_end_(table.entries_.end()) {
+      entry_end_(table.entries_.end()),
+      tuple_(table.compact_tuples_),
+      tuples_end_(table.UsingCompactLayout() ? table.compact_tuples_ + table.GetBufferedTupleMemoryUsage()
+                                             : table.compact_tuples_),
+      tuple_size_(table.tuple_size_) {
   NOISEPAGE_ASSERT(table.IsBuilt(), "Cannot iterate over a JoinHashTable that hasn't been built yet!");
   if (!table.owned_.empty()) FindNextNonEmptyList();
 }
@@ -1,26 +1,166 @@
 #include "execution/sql/memory_pool.h"
 
+#include <tbb/enumerable_thread_specific.h>
+
+#include <array>
 #include <cstdlib>
 #include <memory>
+#include <vector>
 
 #include "common/constants.h"
+#include "common/math_util.h"
+#include "common/strong_typedef.h"
 #include "execution/sql/memory_tracker.h"
 #include "execution/util/memory.h"
 
 namespace noisepage::execution::sql {
 
+/**
+ * Serves the small allocations of a memory pool from slabs. Every size class has its own slabs, which are carved
+ * into blocks of the class' size. A thread allocates from and frees to its own cache of free blocks. When its cache of
+ * a class runs empty, it takes a magazine of free blocks from the allocator, or carves one from a slab. When the cache
+ * grows beyond two magazines, it hands one back.
+ */
+class SlabAllocator {
+ public:
+  /** @return The size class of allocations of @em size bytes. */
+  static uint32_t SizeClass(const std::size_t size) {
+    const auto block_size = std::max<uint64_t>(common::MathUtil::PowerOf2Ceil(size), MIN_BLOCK_SIZE);
+    return static_cast<uint32_t>(__builtin_ctzll(block_size) - MIN_BLOCK_SIZE_LOG);
+  }
+
+  ~SlabAllocator() {
+    for (const auto &[slab, size] : slabs_) {
+      std::free(slab);
+    }
+  }
+
+  void *Allocate(const uint32_t size_class) {
+    FreeList &cache = caches_.local()[size_class];
+    if (cache.head_ == nullptr) {
+      cache = TakeMagazine(size_class);
+    }
+    FreeBlock *block = cache.head_;
+    cache.head_ = block->next_;
+    cache.count_--;
+    return block;
+  }
+
+  void Deallocate(void *ptr, const uint32_t size_class) {
+    FreeList &cache = caches_.local()[size_class];
+    auto *block = static_cast<FreeBlock *>(ptr);
+    block->next_ = cache.head_;
+    cache.head_ = block;
+    cache.count_++;
+    if (cache.count_ > 2 * MagazineSize(size_class)) {
+      ReturnMagazine(size_class, &cache);
+    }
+  }
+
+ private:
+  static constexpr uint32_t MIN_BLOCK_SIZE_LOG = 6;
+  static constexpr std::size_t MIN_BLOCK_SIZE = std::size_t{1} << MIN_BLOCK_SIZE_LOG;
+  static constexpr uint32_t NUM_SIZE_CLASSES = 11;
+  static_assert(MIN_BLOCK_SIZE == MemoryPool::SLAB_ALLOCATION_ALIGNMENT, "Blocks are aligned to the minimum size");
+  static_assert((MIN_BLOCK_SIZE << (NUM_SIZE_CLASSES - 1)) == MemoryPool::MAX_SLAB_ALLOCATION_SIZE,
+                "The largest size class must hold the largest slab allocation");
+  // The bytes of blocks in a magazine, and in a slab.
+  static constexpr std::size_t MAGAZINE_BYTES = 128 * 1024;
+  static constexpr std::size_t MIN_SLAB_SIZE = 256 * 1024;
+
+  struct FreeBlock {
+    FreeBlock *next_;
+  };
+
+  struct FreeList {
+    FreeBlock *head_{nullptr};
+    std::size_t count_{0};
+  };
+
+  // The region of the current slab of a size class that isn't carved into blocks yet.
+  struct SlabCursor {
+    byte *pos_{nullptr};
+    byte *end_{nullptr};
+  };
+
+  static std::size_t BlockSize(const uint32_t size_class) { return MIN_BLOCK_SIZE << size_class; }
+
+  static std::size_t MagazineSize(const uint32_t size_class) {
+    return std::max<std::size_t>(MAGAZINE_BYTES / BlockSize(size_class), 1);
+  }
+
+  FreeList TakeMagazine(const uint32_t size_class) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    auto &magazines = magazines_[size_class];
+    if (!magazines.empty()) {
+      FreeList magazine = magazines.back();
+      magazines.pop_back();
+      return magazine;
+    }
+
+    // Carve a new magazine from the current slab, starting a new slab if it's used up.
+    const std::size_t block_size = BlockSize(size_class), magazine_size = MagazineSize(size_class);
+    SlabCursor &cursor = cursors_[size_class];
+    if (cursor.pos_ == cursor.end_) {
+      const std::size_t slab_size = std::max(MIN_SLAB_SIZE, block_size * magazine_size);
+      auto *slab = static_cast<byte *>(util::Memory::MallocAligned(slab_size, MIN_BLOCK_SIZE));
+      slabs_.emplace_back(slab, slab_size);
+      cursor = {slab, slab + slab_size};
+    }
+    FreeList magazine;
+    for (std::size_t i = 0; i < magazine_size && cursor.pos_ != cursor.end_; i++, cursor.pos_ += block_size) {
+      auto *block = reinterpret_cast<FreeBlock *>(cursor.pos_);
+      block->next_ = magazine.head_;
+      magazine.head_ = block;
+      magazine.count_++;
+    }
+    return magazine;
+  }
+
+  void ReturnMagazine(const uint32_t size_class, FreeList *cache) {
+    FreeList magazine{cache->head_, MagazineSize(size_class)};
+    FreeBlock *last = magazine.head_;
+    for (std::size_t i = 1; i < magazine.count_; i++) {
+      last = last->next_;
+    }
+    cache->head_ = last->next_;
+    cache->count_ -= magazine.count_;
+    last->next_ = nullptr;
+
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    magazines_[size_class].push_back(magazine);
+  }
+
+  // The free blocks cached by every thread, per size class.
+  tbb::enumerable_thread_specific<std::array<FreeList, NUM_SIZE_CLASSES>> caches_;
+  // Guards everything below.
+  common::SpinLatch latch_;
+  std::array<std::vector<FreeList>, NUM_SIZE_CLASSES> magazines_;
+  std::array<SlabCursor, NUM_SIZE_CLASSES> cursors_;
+  std::vector<std::pair<byte *, std::size_t>> slabs_;
+};
+
 // If the allocation size is larger than this value, use huge pages
 std::atomic<std::size_t> MemoryPool::mmap_threshold = 64 * common::Constants::MB;
 
 // Minimum alignment to abide by
 static constexpr uint32_t MIN_MALLOC_ALIGNMENT = 8;
 
-MemoryPool::MemoryPool(common::ManagedPointer<sql::MemoryTracker> tracker) : tracker_(tracker) { (void)tracker_; }
+MemoryPool::MemoryPool(common::ManagedPointer<sql::MemoryTracker> tracker)
+    : tracker_(tracker), slab_allocator_(std::make_unique<SlabAllocator>()) {}
+
+MemoryPool::~MemoryPool() = default;
 
 void *MemoryPool::AllocateAligned(const std::size_t size, const std::size_t alignment, const bool clear) {
   void *buf = nullptr;
 
-  if (size >= mmap_threshold.load(std::memory_order_relaxed)) {
+  if (size <= MAX_SLAB_ALLOCATION_SIZE) {
+    NOISEPAGE_ASSERT(alignment <= SLAB_ALLOCATION_ALIGNMENT, "Slab allocations don't support larger alignments");
+    buf = slab_allocator_->Allocate(SlabAllocator::SizeClass(size));
+    if (clear) {
+      std::memset(buf, 0, size);
+    }
+  } else if (size >= mmap_threshold.load(std::memory_order_relaxed)) {
     buf = util::Memory::MallocHuge(size, true);
     NOISEPAGE_ASSERT(buf != nullptr, "Null memory pointer");
     // No need to clear memory, guaranteed on Linux
@@ -46,7 +186,9 @@ void *MemoryPool::AllocateAligned(const std::size_t size, const std::size_t alig
 }
 
 void MemoryPool::Deallocate(void *ptr, std::size_t size) {
-  if (size >= mmap_threshold.load(std::memory_order_relaxed)) {
+  if (size <= MAX_SLAB_ALLOCATION_SIZE) {
+    if (ptr != nullptr) slab_allocator_->Deallocate(ptr, SlabAllocator::SizeClass(size));
+  } else if (size >= mmap_threshold.load(std::memory_order_relaxed)) {
     util::Memory::FreeHuge(ptr, size);
   } else {
     std::free(ptr);
@@ -80,22 +80,9 @@ uint32_t BuildJulianDate(uint32_t year, uint32_t month, uint32_t day) {
   return julian;
 }
 
-// Based on j2date().
+// Split a Julian day, see Date::SplitJulianDay().
 void SplitJulianDate(int32_t jd, int32_t *year, int32_t *month, int32_t *day) {
-  uint32_t julian = jd;
-  julian += 32044;
-  uint32_t quad = julian / 146097;
-  uint32_t extra = (julian - quad * 146097) * 4 + 3;
-  julian += 60 + quad * 3 + extra / 146097;
-  quad = julian / 1461;
-  julian -= quad * 1461;
-  int32_t y = julian * 4 / 1461;
-  julian = ((y != 0) ? ((julian + 305) % 365) : ((julian + 306) % 366)) + 123;
-  y += quad * 4;
-  *year = y - 4800;
-  quad = julian * 2141 / 65536;
-  *day = julian - 7834 * quad / 256;
-  *month = (quad + 10) % K_MONTHS_PER_YEAR + 1;
+  Date::SplitJulianDay(jd, year, month, day);
 }
 
 // Split a Julian time (i.e., Julian date in microseconds) into a time and date
@@ -1,15 +1,20 @@
 #include "execution/sql/sorter.h"
 
 #include <llvm/ADT/STLExtras.h>
+#include <tbb/parallel_for.h>
 #include <tbb/parallel_for_each.h>
-#include <tbb/task_scheduler_init.h>
 
 #include <algorithm>
+#include <array>
+#include <iterator>
+#include <memory>
 #include <queue>
 #include <utility>
 #include <vector>
 
 #include "execution/exec/execution_context.h"
+#include "execution/exec/task_scheduler.h"
+#include "execution/sql/spill_file.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/util/stage_timer.h"
 #include "ips4o/ips4o.hpp"
@@ -19,6 +24,113 @@
 
 namespace noisepage::execution::sql {
 
+namespace {
+
+// Sorted runs keep a copy of every SPILL_FENCE_INTERVAL-th tuple in memory
+constexpr const uint64_t SPILL_FENCE_INTERVAL = 1024;
+
+// The size of the buffers that spilled tuples are written and merged through
+constexpr const std::size_t SPILL_BUFFER_SIZE_IN_BYTES = 1024 * 1024;
+constexpr const std::size_t MERGE_BUFFER_SIZE_IN_BYTES = 64 * 1024;
+
+// Reads a range of a sorted run, one buffer at a time.
+class RunCursor {
+ public:
+  RunCursor(const SpillFile *file, uint64_t offset, uint64_t num_tuples, std::size_t tuple_size)
+      : file_(file),
+        offset_(offset),
+        num_unread_(num_tuples),
+        tuple_size_(tuple_size),
+        buffer_(std::max<std::size_t>(1, MERGE_BUFFER_SIZE_IN_BYTES / tuple_size) * tuple_size) {
+    Load();
+  }
+
+  bool HasNext() const { return pos_ != end_; }
+
+  const byte *Get() const { return pos_; }
+
+  void Next() {
+    pos_ += tuple_size_;
+    if (pos_ == end_) {
+      Load();
+    }
+  }
+
+ private:
+  void Load() {
+    const std::size_t size = std::min<uint64_t>(num_unread_ * tuple_size_, buffer_.size());
+    if (size > 0) {
+      file_->Read(offset_, buffer_.data(), size);
+    }
+    offset_ += size;
+    num_unread_ -= size / tuple_size_;
+    pos_ = buffer_.data();
+    end_ = pos_ + size;
+  }
+
+ private:
+  const SpillFile *file_;
+  uint64_t offset_;
+  uint64_t num_unread_;
+  std::size_t tuple_size_;
+  std::vector<byte> buffer_;
+  const byte *pos_;
+  const byte *end_;
+};
+
+// A tree of losers that merges K sorted cursors with log(K) comparisons per
+// tuple (Knuth, TAOCP Vol. 3, 5.4.1). Each inner node holds the cursor that
+// lost the match played there, and the root holds the overall winner, so
+// that advancing the winner only replays the matches on its path to the
+// root. Exhausted cursors lose every match.
+class LoserTree {
+ public:
+  LoserTree(std::vector<RunCursor> *cursors, Sorter::ComparisonFunction cmp_fn)
+      : cursors_(*cursors), cmp_fn_(cmp_fn), tree_(std::max<std::size_t>(1, cursors_.size())) {
+    const uint32_t k = cursors_.size();
+    std::vector<uint32_t> winners(2 * k);
+    for (uint32_t i = 0; i < k; i++) {
+      winners[k + i] = i;
+    }
+    for (uint32_t i = k; i-- > 1;) {
+      const uint32_t left = winners[2 * i], right = winners[2 * i + 1];
+      const bool right_wins = Beats(right, left);
+      winners[i] = right_wins ? right : left;
+      tree_[i] = right_wins ? left : right;
+    }
+    tree_[0] = k > 1 ? winners[1] : 0;
+  }
+
+  bool HasNext() const { return !cursors_.empty() && cursors_[tree_[0]].HasNext(); }
+
+  const byte *Get() const { return cursors_[tree_[0]].Get(); }
+
+  void Next() {
+    uint32_t winner = tree_[0];
+    cursors_[winner].Next();
+    for (uint32_t i = (cursors_.size() + winner) / 2; i > 0; i /= 2) {
+      if (Beats(tree_[i], winner)) {
+        std::swap(tree_[i], winner);
+      }
+    }
+    tree_[0] = winner;
+  }
+
+ private:
+  bool Beats(const uint32_t a, const uint32_t b) const {
+    if (!cursors_[a].HasNext()) return false;
+    if (!cursors_[b].HasNext()) return true;
+    return cmp_fn_(cursors_[a].Get(), cursors_[b].Get()) < 0;
+  }
+
+ private:
+  std::vector<RunCursor> &cursors_;
+  Sorter::ComparisonFunction cmp_fn_;
+  std::vector<uint32_t> tree_;
+};
+
+}  // namespace
+
 //===----------------------------------------------------------------------===//
 //
 // Sorter
@@ -31,18 +143,35 @@ Sorter::Sorter(exec::ExecutionContext *exec_ctx, ComparisonFunction cmp_fn, uint
       tuple_storage_(tuple_size, MemoryPoolAllocator<byte>(exec_ctx->GetMemoryPool())),
       owned_tuples_(exec_ctx->GetMemoryPool()),
       cmp_fn_(cmp_fn),
+      key_fn_(nullptr),
       tuples_(exec_ctx->GetMemoryPool()),
-      sorted_(false) {}
+      own_top_k_bound_(~uint64_t{0}),
+      top_k_bound_(&own_top_k_bound_),
+      sorted_(false),
+      memory_budget_(exec_ctx->GetExecutionSettings().GetSortMemoryBudget()),
+      spill_file_(nullptr),
+      num_spilled_tuples_(0) {}
 
 Sorter::~Sorter() = default;
 
 byte *Sorter::AllocInputTuple() {
+  // The tuples handed out before have been written by now, so they can be
+  // spilled if they take up more than the budget.
+  if (UNLIKELY(memory_budget_ != 0) &&
+      tuples_.size() * tuple_storage_.ElementSize() >= static_cast<uint64_t>(memory_budget_)) {
+    SpillRun();
+  }
   byte *ret = tuple_storage_.Append();
   tuples_.push_back(ret);
   return ret;
 }
 
-byte *Sorter::AllocInputTupleTopK(UNUSED_ATTRIBUTE uint64_t top_k) { return AllocInputTuple(); }
+byte *Sorter::AllocInputTupleTopK(UNUSED_ATTRIBUTE uint64_t top_k) {
+  // The heap only ever holds K tuples, so they are never spilled.
+  byte *ret = tuple_storage_.Append();
+  tuples_.push_back(ret);
+  return ret;
+}
 
 void Sorter::AllocInputTupleTopKFinish(const uint64_t top_k) {
   // If the number of buffered tuples is less than top_k, we're done.
@@ -54,6 +183,7 @@ void Sorter::AllocInputTupleTopKFinish(const uint64_t top_k) {
   // triggered once!
   if (tuples_.size() == top_k) {
     BuildHeap();
+    TightenTopKBound();
     return;
   }
 
@@ -71,6 +201,19 @@ void Sorter::AllocInputTupleTopKFinish(const uint64_t top_k) {
     // and sift it down.
     tuples_.front() = last_insert;
     HeapSiftDown();
+    TightenTopKBound();
+  }
+}
+
+void Sorter::TightenTopKBound() {
+  if (key_fn_ == nullptr) {
+    return;
+  }
+  // The root is the K-th best tuple of this heap, so at least K tuples are no worse than it. Other
+  // threads may have tightened the bound further already.
+  const uint64_t bound = key_fn_(tuples_.front());
+  uint64_t current = top_k_bound_->load(std::memory_order_relaxed);
+  while (bound < current && !top_k_bound_->compare_exchange_weak(current, bound, std::memory_order_relaxed)) {
   }
 }
 
@@ -113,6 +256,16 @@ void Sorter::Sort() {
     return;
   }
 
+  // Spilled tuples are merged on disk along with the ones still buffered
+  if (IsSpilled()) {
+    if (!tuples_.empty()) {
+      SpillRun();
+    }
+    MergeRuns(nullptr, 1);
+    sorted_ = true;
+    return;
+  }
+
   // Exit if there are no input tuples
   if (tuples_.empty()) {
     return;
@@ -123,8 +276,7 @@ void Sorter::Sort() {
   timer.Start();
 
   // Sort the sucker
-  const auto compare = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
-  ips4o::sort(tuples_.begin(), tuples_.end(), compare);
+  SortTuples();
 
   timer.Stop();
 
@@ -135,6 +287,223 @@ void Sorter::Sort() {
   sorted_ = true;
 }
 
+void Sorter::SortTuples() {
+  const auto compare = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
+
+  // Input that arrives in order, e.g., from an index scan, only costs a pass
+  // checking that order.
+  if (std::is_sorted(tuples_.begin(), tuples_.end(), compare)) {
+    return;
+  }
+
+  if (key_fn_ == nullptr) {
+    ips4o::sort(tuples_.begin(), tuples_.end(), compare);
+    return;
+  }
+
+  const std::size_t num_tuples = tuples_.size();
+  std::vector<std::pair<uint64_t, const byte *>> entries(num_tuples), scratch(num_tuples);
+  for (std::size_t i = 0; i < num_tuples; i++) {
+    entries[i] = {key_fn_(tuples_[i]), tuples_[i]};
+  }
+
+  // Histograms of all key bytes, built in one pass over the entries
+  std::array<std::array<std::size_t, 256>, sizeof(uint64_t)> counts{};
+  for (const auto &entry : entries) {
+    for (uint32_t b = 0; b < sizeof(uint64_t); b++) {
+      counts[b][(entry.first >> (b * 8)) & 0xFF]++;
+    }
+  }
+
+  // LSD radix sort on the keys, one byte per pass. Passes over bytes that are
+  // the same in every key would not move anything, so they are skipped.
+  for (uint32_t b = 0; b < sizeof(uint64_t) && num_tuples > 0; b++) {
+    const uint32_t shift = b * 8;
+    if (counts[b][(entries[0].first >> shift) & 0xFF] == num_tuples) {
+      continue;
+    }
+    std::array<std::size_t, 256> offsets;
+    for (std::size_t digit = 0, offset = 0; digit < 256; digit++) {
+      offsets[digit] = offset;
+      offset += counts[b][digit];
+    }
+    for (const auto &entry : entries) {
+      scratch[offsets[(entry.first >> shift) & 0xFF]++] = entry;
+    }
+    entries.swap(scratch);
+  }
+
+  // The comparison function only orders tuples whose keys tie
+  for (std::size_t i = 0; i < num_tuples;) {
+    std::size_t j = i + 1;
+    while (j < num_tuples && entries[j].first == entries[i].first) {
+      j++;
+    }
+    if (j - i > 1) {
+      std::sort(entries.begin() + i, entries.begin() + j,
+                [&](const auto &left, const auto &right) { return compare(left.second, right.second); });
+    }
+    i = j;
+  }
+
+  for (std::size_t i = 0; i < num_tuples; i++) {
+    tuples_[i] = entries[i].second;
+  }
+}
+
+void Sorter::SpillRun() {
+  const std::size_t tuple_size = tuple_storage_.ElementSize();
+  SortTuples();
+
+  if (spill_file_ == nullptr) {
+    spill_files_.emplace_back(std::make_unique<SpillFile>());
+    spill_file_ = spill_files_.back().get();
+  }
+
+  // Only this sorter appends to its file, so the run ends up contiguous
+  SortedRun run{spill_file_, spill_file_->GetSize(), tuples_.size(), {}};
+  std::vector<byte> buffer;
+  buffer.reserve(std::max(tuple_size, SPILL_BUFFER_SIZE_IN_BYTES));
+  for (uint64_t i = 0; i < tuples_.size(); i++) {
+    if (buffer.size() + tuple_size > buffer.capacity()) {
+      spill_file_->Append(buffer.data(), buffer.size());
+      buffer.clear();
+    }
+    buffer.insert(buffer.end(), tuples_[i], tuples_[i] + tuple_size);
+    if (i % SPILL_FENCE_INTERVAL == 0) {
+      run.fences_.insert(run.fences_.end(), tuples_[i], tuples_[i] + tuple_size);
+    }
+  }
+  spill_file_->Append(buffer.data(), buffer.size());
+  num_spilled_tuples_ += run.num_tuples_;
+  runs_.emplace_back(std::move(run));
+
+  // Every tuple has been written out, so release their memory
+  tuples_.clear();
+  tuple_storage_ = decltype(tuple_storage_)(tuple_size, MemoryPoolAllocator<byte>(memory_));
+  owned_tuples_.clear();
+
+  EXECUTION_LOG_DEBUG("Spilled sorted run of {} tuples", runs_.back().num_tuples_);
+}
+
+uint64_t Sorter::FindRunBoundary(const SortedRun &run, const byte *key) const {
+  const std::size_t tuple_size = tuple_storage_.ElementSize();
+
+  // The number of elements of the given sorted array that are less than or
+  // equal to the key
+  const auto upper_bound = [&](const byte *tuples, uint64_t num_tuples) {
+    uint64_t lo = 0, hi = num_tuples;
+    while (lo < hi) {
+      const uint64_t mid = lo + (hi - lo) / 2;
+      if (cmp_fn_(key, tuples + mid * tuple_size) < 0) {
+        hi = mid;
+      } else {
+        lo = mid + 1;
+      }
+    }
+    return lo;
+  };
+
+  // The boundary lies after the last fence that is not greater than the key,
+  // and no later than the next fence.
+  const uint64_t num_fences = upper_bound(run.fences_.data(), run.fences_.size() / tuple_size);
+  if (num_fences == 0) {
+    return 0;
+  }
+  const uint64_t begin = (num_fences - 1) * SPILL_FENCE_INTERVAL + 1;
+  const uint64_t end = std::min(num_fences * SPILL_FENCE_INTERVAL, run.num_tuples_);
+  if (begin >= end) {
+    return begin;
+  }
+  std::vector<byte> block((end - begin) * tuple_size);
+  run.file_->Read(run.offset_ + begin * tuple_size, block.data(), block.size());
+  return begin + upper_bound(block.data(), end - begin);
+}
+
+void Sorter::MergeRuns(ThreadStateContainer *thread_state_container, uint64_t num_partitions) {
+  const std::size_t tuple_size = tuple_storage_.ElementSize();
+  const auto comp = [this](const byte *left, const byte *right) { return cmp_fn_(left, right) < 0; };
+
+  // The key ranges are split by splitters chosen evenly among the sorted
+  // fences of all runs. Each fence stands for as many tuples, so the ranges
+  // hold about as many tuples each.
+  std::vector<const byte *> splitters;
+  if (num_partitions > 1) {
+    std::vector<const byte *> fences;
+    for (const auto &run : runs_) {
+      for (std::size_t pos = 0; pos < run.fences_.size(); pos += tuple_size) {
+        fences.push_back(&run.fences_[pos]);
+      }
+    }
+    ips4o::sort(fences.begin(), fences.end(), comp);
+    num_partitions = std::min<uint64_t>(num_partitions, fences.size());
+    for (uint64_t i = 1; i < num_partitions; i++) {
+      splitters.push_back(fences[i * fences.size() / num_partitions]);
+    }
+  }
+  num_partitions = splitters.size() + 1;
+
+  // Each key range is merged into a file of its own. A range takes the tuples
+  // greater than the splitter before it and no greater than its own.
+  std::vector<std::unique_ptr<SpillFile>> merged_files(num_partitions);
+  std::vector<SortedRun> merged_runs(num_partitions);
+  const auto merge_partition = [&](const uint64_t part_idx) {
+    auto pre_hook = static_cast<uint32_t>(HookOffsets::StartTLMergeHook);
+    auto post_hook = static_cast<uint32_t>(HookOffsets::EndTLMergeHook);
+    auto *tls = thread_state_container == nullptr ? nullptr : thread_state_container->AccessCurrentThreadState();
+    exec_ctx_->InvokeHook(pre_hook, tls, nullptr);
+
+    std::vector<RunCursor> cursors;
+    cursors.reserve(runs_.size());
+    for (const auto &run : runs_) {
+      const uint64_t begin = part_idx == 0 ? 0 : FindRunBoundary(run, splitters[part_idx - 1]);
+      const uint64_t end = part_idx == splitters.size() ? run.num_tuples_ : FindRunBoundary(run, splitters[part_idx]);
+      if (begin < end) {
+        cursors.emplace_back(run.file_, run.offset_ + begin * tuple_size, end - begin, tuple_size);
+      }
+    }
+    if (cursors.empty()) {
+      exec_ctx_->InvokeHook(post_hook, tls, nullptr);
+      return;
+    }
+
+    merged_files[part_idx] = std::make_unique<SpillFile>();
+    SpillFile *file = merged_files[part_idx].get();
+    merged_runs[part_idx] = SortedRun{file, 0, 0, {}};
+    std::vector<byte> buffer;
+    buffer.reserve(std::max(tuple_size, SPILL_BUFFER_SIZE_IN_BYTES));
+    for (LoserTree tree(&cursors, cmp_fn_); tree.HasNext(); tree.Next()) {
+      if (buffer.size() + tuple_size > buffer.capacity()) {
+        file->Append(buffer.data(), buffer.size());
+        buffer.clear();
+      }
+      buffer.insert(buffer.end(), tree.Get(), tree.Get() + tuple_size);
+      merged_runs[part_idx].num_tuples_++;
+    }
+    file->Append(buffer.data(), buffer.size());
+
+    exec_ctx_->InvokeHook(post_hook, tls, reinterpret_cast<void *>(merged_runs[part_idx].num_tuples_));
+  };
+
+  if (num_partitions == 1) {
+    merge_partition(0);
+  } else {
+    exec::TaskScheduler::Execute(exec_ctx_, num_partitions,
+                                 [&] { tbb::parallel_for(uint64_t{0}, num_partitions, merge_partition); });
+  }
+
+  // The merged ranges replace the input runs, whose files are dropped
+  runs_.clear();
+  spill_files_.clear();
+  spill_file_ = nullptr;
+  for (uint64_t part_idx = 0; part_idx < num_partitions; part_idx++) {
+    if (merged_runs[part_idx].num_tuples_ > 0) {
+      runs_.emplace_back(std::move(merged_runs[part_idx]));
+      spill_files_.emplace_back(std::move(merged_files[part_idx]));
+    }
+  }
+}
+
 namespace {
 
 // Structure we use to track a package of merging work.
@@ -167,6 +536,12 @@ void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::siz
     return;
   }
 
+  // If any thread-local sorter has spilled, everything is merged on disk.
+  if (std::any_of(tl_sorters.begin(), tl_sorters.end(), [](const Sorter *sorter) { return sorter->IsSpilled(); })) {
+    SortParallelSpilled(thread_state_container, tl_sorters);
+    return;
+  }
+
   const uint64_t num_tuples =
       std::accumulate(tl_sorters.begin(), tl_sorters.end(), uint64_t(0),
                       [](const auto partial, const auto *sorter) { return partial + sorter->GetTupleCount(); });
@@ -234,27 +609,19 @@ void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::siz
   util::StageTimer<std::milli> timer;
   timer.EnterStage("Parallel Sort Thread-Local Instances");
 
-  tbb::task_scheduler_init sched;
-  {
-    size_t num_threads = tbb::task_scheduler_init::default_num_threads();
-    size_t num_tasks = tl_sorters.size();
-    size_t num_concurrent = std::min(num_threads, num_tasks);
-    exec_ctx_->SetNumConcurrentEstimate(num_concurrent);
-  }
+  exec::TaskScheduler::Execute(exec_ctx_, tl_sorters.size(), [&] {
+    tbb::parallel_for_each(tl_sorters, [thread_state_container, this](Sorter *sorter) {
+      auto pre_hook = static_cast<uint32_t>(HookOffsets::StartTLSortHook);
+      auto post_hook = static_cast<uint32_t>(HookOffsets::EndTLSortHook);
+      auto *tls = thread_state_container->AccessCurrentThreadState();
+      auto *exec_ctx = this->exec_ctx_;
+      exec_ctx->InvokeHook(pre_hook, tls, nullptr);
 
-  tbb::parallel_for_each(tl_sorters, [thread_state_container, this](Sorter *sorter) {
-    auto pre_hook = static_cast<uint32_t>(HookOffsets::StartTLSortHook);
-    auto post_hook = static_cast<uint32_t>(HookOffsets::EndTLSortHook);
-    auto *tls = thread_state_container->AccessCurrentThreadState();
-    auto *exec_ctx = this->exec_ctx_;
-    exec_ctx->InvokeHook(pre_hook, tls, nullptr);
-
-    sorter->Sort();
+      sorter->Sort();
 
-    exec_ctx->InvokeHook(post_hook, tls, nullptr);
+      exec_ctx->InvokeHook(post_hook, tls, nullptr);
+    });
   });
-
-  exec_ctx_->SetNumConcurrentEstimate(0);
   timer.ExitStage();
 
   // -------------------------------------------------------
@@ -359,39 +726,32 @@ void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::siz
     return cmp_fn_(*l.first, *r.first) >= 0;
   };
 
-  {
-    size_t num_threads = tbb::task_scheduler_init::default_num_threads();
-    size_t num_tasks = merge_work.size();
-    size_t concurrent = std::min(num_threads, num_tasks);
-    exec_ctx_->SetNumConcurrentEstimate(concurrent);
-  }
-
-  tbb::parallel_for_each(merge_work, [&heap_cmp, thread_state_container, this](const MergeWork<SeqTypeIter> &work) {
-    auto pre_hook = static_cast<uint32_t>(HookOffsets::StartTLMergeHook);
-    auto post_hook = static_cast<uint32_t>(HookOffsets::EndTLMergeHook);
-    auto *tls = thread_state_container->AccessCurrentThreadState();
-    auto *exec_ctx = this->exec_ctx_;
-    exec_ctx->InvokeHook(pre_hook, tls, nullptr);
-
-    std::priority_queue<MergeWorkType::Range, std::vector<MergeWorkType::Range>, decltype(heap_cmp)> heap(
-        heap_cmp, work.input_ranges_);
-    SeqTypeIter dest = work.destination_;
-    size_t num_iters = 0;
-    while (!heap.empty()) {
-      num_iters++;
-
-      auto top = heap.top();
-      heap.pop();
-      *dest++ = *top.first;
-      if (top.first + 1 != top.second) {
-        heap.emplace(top.first + 1, top.second);
+  exec::TaskScheduler::Execute(exec_ctx_, merge_work.size(), [&] {
+    tbb::parallel_for_each(merge_work, [&heap_cmp, thread_state_container, this](const MergeWork<SeqTypeIter> &work) {
+      auto pre_hook = static_cast<uint32_t>(HookOffsets::StartTLMergeHook);
+      auto post_hook = static_cast<uint32_t>(HookOffsets::EndTLMergeHook);
+      auto *tls = thread_state_container->AccessCurrentThreadState();
+      auto *exec_ctx = this->exec_ctx_;
+      exec_ctx->InvokeHook(pre_hook, tls, nullptr);
+
+      std::priority_queue<MergeWorkType::Range, std::vector<MergeWorkType::Range>, decltype(heap_cmp)> heap(
+          heap_cmp, work.input_ranges_);
+      SeqTypeIter dest = work.destination_;
+      size_t num_iters = 0;
+      while (!heap.empty()) {
+        num_iters++;
+
+        auto top = heap.top();
+        heap.pop();
+        *dest++ = *top.first;
+        if (top.first + 1 != top.second) {
+          heap.emplace(top.first + 1, top.second);
+        }
       }
-    }
 
-    exec_ctx->InvokeHook(post_hook, tls, reinterpret_cast<void *>(num_iters));
+      exec_ctx->InvokeHook(post_hook, tls, reinterpret_cast<void *>(num_iters));
+    });
   });
-
-  exec_ctx_->SetNumConcurrentEstimate(0);
   timer.ExitStage();
 
   // -------------------------------------------------------
@@ -421,13 +781,85 @@ void Sorter::SortParallel(ThreadStateContainer *thread_state_container, std::siz
   }
 }
 
+void Sorter::SortParallelSpilled(ThreadStateContainer *thread_state_container,
+                                 const std::vector<Sorter *> &tl_sorters) {
+  util::StageTimer<std::milli> timer;
+
+  // -------------------------------------------------------
+  // 1. Spill the tuples each thread-local sorter still buffers, in parallel
+  // -------------------------------------------------------
+
+  timer.EnterStage("Parallel Spill Thread-Local Instances");
+
+  exec::TaskScheduler::Execute(exec_ctx_, tl_sorters.size(), [&] {
+    tbb::parallel_for_each(tl_sorters, [thread_state_container, this](Sorter *sorter) {
+      auto pre_hook = static_cast<uint32_t>(HookOffsets::StartTLSortHook);
+      auto post_hook = static_cast<uint32_t>(HookOffsets::EndTLSortHook);
+      auto *tls = thread_state_container->AccessCurrentThreadState();
+      exec_ctx_->InvokeHook(pre_hook, tls, nullptr);
+
+      if (!sorter->tuples_.empty()) {
+        sorter->SpillRun();
+      }
+
+      exec_ctx_->InvokeHook(post_hook, tls, nullptr);
+    });
+  });
+  timer.ExitStage();
+
+  // -------------------------------------------------------
+  // 2. Take over all sorted runs
+  // -------------------------------------------------------
+
+  if (!tuples_.empty()) {
+    SpillRun();
+  }
+  for (auto *tl_sorter : tl_sorters) {
+    runs_.insert(runs_.end(), std::make_move_iterator(tl_sorter->runs_.begin()),
+                 std::make_move_iterator(tl_sorter->runs_.end()));
+    spill_files_.insert(spill_files_.end(), std::make_move_iterator(tl_sorter->spill_files_.begin()),
+                        std::make_move_iterator(tl_sorter->spill_files_.end()));
+    num_spilled_tuples_ += tl_sorter->num_spilled_tuples_;
+    tl_sorter->runs_.clear();
+    tl_sorter->spill_files_.clear();
+    tl_sorter->spill_file_ = nullptr;
+    tl_sorter->num_spilled_tuples_ = 0;
+  }
+
+  // -------------------------------------------------------
+  // 3. Merge key ranges of all runs in parallel
+  // -------------------------------------------------------
+
+  timer.EnterStage("Parallel Merge Spilled Runs");
+  MergeRuns(thread_state_container, exec::TaskScheduler::MaxConcurrency(exec_ctx_->GetExecutionSettings()));
+  timer.ExitStage();
+
+  sorted_ = true;
+
+  EXECUTION_LOG_DEBUG("Sort Stats: {} spilled tuples in {} runs", GetTupleCount(), runs_.size());
+  for (UNUSED_ATTRIBUTE const auto &stage : timer.GetStages()) {
+    EXECUTION_LOG_DEBUG("  {}: {.2f} ms", stage.Name(), stage.Time());
+  }
+}
+
 void Sorter::SortTopKParallel(ThreadStateContainer *thread_state_container, uint32_t sorter_offset, uint64_t top_k) {
   // Parallel sort
   SortParallel(thread_state_container, sorter_offset);
 
   // Trim to top-K
   if (top_k < GetTupleCount()) {
-    tuples_.resize(top_k);
+    if (IsSpilled()) {
+      // Only the leading runs are kept, the last of them cut short
+      uint64_t num_kept = 0;
+      llvm::erase_if(runs_, [&](SortedRun &run) {
+        run.num_tuples_ = std::min(run.num_tuples_, top_k - num_kept);
+        num_kept += run.num_tuples_;
+        return run.num_tuples_ == 0;
+      });
+      num_spilled_tuples_ = top_k;
+    } else {
+      tuples_.resize(top_k);
+    }
   }
 }
 
@@ -437,14 +869,78 @@ void Sorter::SortTopKParallel(ThreadStateContainer *thread_state_container, uint
 //
 //===----------------------------------------------------------------------===//
 
-SorterIterator::SorterIterator(const Sorter &sorter) : iter_(sorter.tuples_.begin()), end_(sorter.tuples_.end()) {}
+SorterIterator::SorterIterator(const Sorter &sorter)
+    : sorter_(sorter),
+      spilled_rows_(sorter.memory_),
+      iter_(sorter.tuples_.begin()),
+      end_(sorter.tuples_.end()),
+      spilled_buffer_idx_(0),
+      spilled_run_idx_(0),
+      spilled_run_pos_(0),
+      num_spilled_remaining_(sorter.num_spilled_tuples_) {
+  if (iter_ == end_ && num_spilled_remaining_ > 0) {
+    LoadSpilledRows();
+  }
+}
 
 void SorterIterator::AdvanceBy(uint64_t n) {
   if (n > NumRemaining()) {
     iter_ = end_;
+    num_spilled_remaining_ = 0;
+    return;
+  }
+
+  const auto num_in_block = static_cast<uint64_t>(std::distance(iter_, end_));
+  if (n < num_in_block) {
+    iter_ += n;
     return;
   }
-  iter_ += n;
+
+  // Skip the rest of the current block, then skip spilled rows without
+  // reading them.
+  iter_ = end_;
+  SkipSpilledRows(n - num_in_block);
+  if (num_spilled_remaining_ > 0) {
+    LoadSpilledRows();
+  }
+}
+
+void SorterIterator::LoadSpilledRows() {
+  const std::size_t tuple_size = sorter_.tuple_storage_.ElementSize();
+  const uint64_t num_rows =
+      std::min<uint64_t>(num_spilled_remaining_, common::Constants::K_DEFAULT_VECTOR_SIZE);
+
+  // Rows of the current block stay valid while the next block is read
+  spilled_buffer_idx_ ^= 1;
+  auto &buffer = spilled_buffers_[spilled_buffer_idx_];
+  buffer.resize(num_rows * tuple_size);
+  for (uint64_t pos = 0; pos < num_rows;) {
+    const auto &run = sorter_.runs_[spilled_run_idx_];
+    const uint64_t n = std::min(num_rows - pos, run.num_tuples_ - spilled_run_pos_);
+    run.file_->Read(run.offset_ + spilled_run_pos_ * tuple_size, &buffer[pos * tuple_size], n * tuple_size);
+    pos += n;
+    SkipSpilledRows(n);
+  }
+
+  spilled_rows_.resize(num_rows);
+  for (uint64_t i = 0; i < num_rows; i++) {
+    spilled_rows_[i] = &buffer[i * tuple_size];
+  }
+  iter_ = spilled_rows_.begin();
+  end_ = spilled_rows_.end();
+}
+
+void SorterIterator::SkipSpilledRows(uint64_t n) {
+  num_spilled_remaining_ -= n;
+  while (n > 0) {
+    const uint64_t num_skipped = std::min(n, sorter_.runs_[spilled_run_idx_].num_tuples_ - spilled_run_pos_);
+    spilled_run_pos_ += num_skipped;
+    n -= num_skipped;
+    if (spilled_run_pos_ == sorter_.runs_[spilled_run_idx_].num_tuples_) {
+      spilled_run_idx_++;
+      spilled_run_pos_ = 0;
+    }
+  }
 }
 
 }  // namespace noisepage::execution::sql
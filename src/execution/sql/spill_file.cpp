@@ -0,0 +1,51 @@
+#include "execution/sql/spill_file.h"
+
+#include <algorithm>
+
+#include "common/error/error_code.h"
+#include "common/error/exception.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage::execution::sql {
+
+namespace {
+
+// File reads and writes report their size as a 32-bit integer, so larger requests are split up
+constexpr std::size_t MAX_IO_SIZE = std::size_t{1} << 30;
+
+}  // namespace
+
+SpillFile::SpillFile() {
+  file_.CreateTemp(true);
+  if (file_.HasError()) {
+    throw EXECUTION_EXCEPTION(
+        fmt::format("Could not create spill file: {}", util::File::ErrorToString(file_.GetErrorIndicator())),
+        common::ErrorCode::ERRCODE_IO_ERROR);
+  }
+}
+
+uint64_t SpillFile::Append(const byte *data, std::size_t size) {
+  const uint64_t offset = size_;
+  for (std::size_t done = 0; done < size;) {
+    const std::size_t chunk = std::min(size - done, MAX_IO_SIZE);
+    if (file_.WriteFullAtPosition(size_, data + done, chunk) != static_cast<int32_t>(chunk)) {
+      throw EXECUTION_EXCEPTION("Could not write to spill file.", common::ErrorCode::ERRCODE_DISK_FULL);
+    }
+    size_ += chunk;
+    done += chunk;
+  }
+  return offset;
+}
+
+void SpillFile::Read(uint64_t offset, byte *data, std::size_t size) const {
+  NOISEPAGE_ASSERT(offset + size <= size_, "Read past the end of the spill file");
+  for (std::size_t done = 0; done < size;) {
+    const std::size_t chunk = std::min(size - done, MAX_IO_SIZE);
+    if (file_.ReadFullFromPosition(offset + done, data + done, chunk) != static_cast<int32_t>(chunk)) {
+      throw EXECUTION_EXCEPTION("Could not read from spill file.", common::ErrorCode::ERRCODE_IO_ERROR);
+    }
+    done += chunk;
+  }
+}
+
+}  // namespace noisepage::execution::sql
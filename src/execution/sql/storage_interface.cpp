@@ -1,6 +1,8 @@
 #include "execution/sql/storage_interface.h"
 
 #include <algorithm>
+#include <cstring>
+#include <utility>
 #include <vector>
 
 #include "catalog/catalog_accessor.h"
@@ -8,6 +10,8 @@
 #include "execution/util/execution_common.h"
 #include "storage/index/index.h"
 #include "storage/sql_table.h"
+#include "storage/storage_util.h"
+#include "type/type_util.h"
 
 namespace noisepage::execution::sql {
 
@@ -34,6 +38,8 @@ StorageInterface::StorageInterface(exec::ExecutionContext *exec_ctx, catalog::ta
 }
 
 StorageInterface::~StorageInterface() {
+  // Entries of a txn that must abort are never applied, so that the abort has nothing to undo for them
+  if (!exec_ctx_->GetTxn()->MustAbort()) FlushIndexBatches();
   if (need_indexes_) exec_ctx_->GetMemoryPool()->Deallocate(index_pr_buffer_, max_pr_size_);
 }
 
@@ -45,6 +51,7 @@ storage::ProjectedRow *StorageInterface::GetTablePR() {
 
 storage::ProjectedRow *StorageInterface::GetIndexPR(catalog::index_oid_t index_oid) {
   curr_index_ = exec_ctx_->GetAccessor()->GetIndex(index_oid);
+  curr_index_oid_ = index_oid;
   // index is created after the initialization of storage interface
   if (curr_index_ != nullptr && !need_indexes_) {
     max_pr_size_ = curr_index_->GetProjectedRowInitializer().ProjectedRowSize();
@@ -73,11 +80,15 @@ bool StorageInterface::TableUpdate(storage::TupleSlot table_tuple_slot) {
   return table_->Update(exec_ctx_->GetTxn(), table_redo_);
 }
 
-uint64_t StorageInterface::IndexGetSize() const { return curr_index_->GetSize(); }
+uint64_t StorageInterface::IndexGetSize() {
+  FlushIndexBatches();
+  return curr_index_->GetSize();
+}
 
 bool StorageInterface::IndexInsert() {
   NOISEPAGE_ASSERT(need_indexes_, "Index PR not allocated!");
-  return curr_index_->Insert(exec_ctx_->GetTxn(), *index_pr_, table_redo_->GetTupleSlot());
+  BufferIndexEntry(&insert_batches_, table_redo_->GetTupleSlot(), true);
+  return true;
 }
 
 bool StorageInterface::IndexInsertUnique() {
@@ -87,7 +98,7 @@ bool StorageInterface::IndexInsertUnique() {
 
 void StorageInterface::IndexDelete(storage::TupleSlot table_tuple_slot) {
   NOISEPAGE_ASSERT(need_indexes_, "Index PR not allocated!");
-  curr_index_->Delete(exec_ctx_->GetTxn(), *index_pr_, table_tuple_slot);
+  BufferIndexEntry(&delete_batches_, table_tuple_slot, false);
 }
 
 bool StorageInterface::IndexInsertWithTuple(storage::TupleSlot table_tuple_slot, bool unique) {
@@ -98,4 +109,63 @@ bool StorageInterface::IndexInsertWithTuple(storage::TupleSlot table_tuple_slot,
   return curr_index_->Insert(exec_ctx_->GetTxn(), *index_pr_, table_tuple_slot);
 }
 
+void StorageInterface::BufferIndexEntry(std::unordered_map<catalog::index_oid_t, IndexBatch> *batches,
+                                        storage::TupleSlot slot, bool insert) {
+  auto it = batches->find(curr_index_oid_);
+  if (it == batches->end()) {
+    IndexBatch batch;
+    batch.index_ = curr_index_;
+    const auto &schema = exec_ctx_->GetAccessor()->GetIndexSchema(curr_index_oid_);
+    for (const auto &col : schema.GetColumns()) {
+      if (type::TypeUtil::GetTypeSize(col.Type()) == storage::VARLEN_COLUMN) {
+        batch.varlen_offsets_.emplace_back(curr_index_->GetKeyOidToOffsetMap().at(col.Oid()));
+      }
+    }
+    it = batches->emplace(curr_index_oid_, std::move(batch)).first;
+  }
+  auto *batch = &it->second;
+
+  // Every key of an index has the same size, so the copies are laid out back to back
+  const uint32_t key_words = storage::StorageUtil::PadUpToSize(sizeof(uint64_t), index_pr_->Size()) / sizeof(uint64_t);
+  batch->keys_.resize(batch->keys_.size() + key_words);
+  auto *key = reinterpret_cast<storage::ProjectedRow *>(&batch->keys_[batch->keys_.size() - key_words]);
+  std::memcpy(static_cast<void *>(key), index_pr_, index_pr_->Size());
+  for (const auto offset : batch->varlen_offsets_) {
+    auto *varlen = reinterpret_cast<storage::VarlenEntry *>(key->AccessWithNullCheck(offset));
+    if (varlen == nullptr || varlen->IsInlined()) continue;
+    auto content = std::make_unique<byte[]>(varlen->Size());
+    std::memcpy(content.get(), varlen->Content(), varlen->Size());
+    *varlen = storage::VarlenEntry::Create(content.get(), varlen->Size(), false);
+    batch->varlens_.emplace_back(std::move(content));
+  }
+  batch->slots_.emplace_back(slot);
+
+  if (batch->slots_.size() >= INDEX_BATCH_SIZE) FlushIndexBatch(batch, insert);
+}
+
+void StorageInterface::FlushIndexBatch(IndexBatch *batch, bool insert) {
+  if (batch->slots_.empty()) return;
+  const size_t key_words = batch->keys_.size() / batch->slots_.size();
+  std::vector<std::pair<const storage::ProjectedRow *, storage::TupleSlot>> entries;
+  entries.reserve(batch->slots_.size());
+  for (size_t i = 0; i < batch->slots_.size(); i++) {
+    entries.emplace_back(reinterpret_cast<const storage::ProjectedRow *>(&batch->keys_[i * key_words]),
+                         batch->slots_[i]);
+  }
+
+  if (insert) {
+    batch->index_->InsertBatch(exec_ctx_->GetTxn(), entries);
+  } else {
+    batch->index_->DeleteBatch(exec_ctx_->GetTxn(), entries);
+  }
+  batch->keys_.clear();
+  batch->slots_.clear();
+  batch->varlens_.clear();
+}
+
+void StorageInterface::FlushIndexBatches() {
+  for (auto &[oid, batch] : insert_batches_) FlushIndexBatch(&batch, true);
+  for (auto &[oid, batch] : delete_batches_) FlushIndexBatch(&batch, false);
+}
+
 }  // namespace noisepage::execution::sql
@@ -1,21 +1,26 @@
 #include "execution/sql/table_vector_iterator.h"
 
 #include <tbb/parallel_for.h>
-#include <tbb/task_arena.h>
-#include <tbb/task_scheduler_init.h>
 
+#include <algorithm>
+#include <atomic>
 #include <limits>
 #include <numeric>
+#include <random>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog_accessor.h"
 #include "execution/exec/execution_context.h"
 #include "execution/exec/execution_settings.h"
+#include "execution/exec/task_scheduler.h"
+#include "execution/sql/sorter.h"
 #include "execution/sql/thread_state_container.h"
 #include "execution/util/timer.h"
 #include "loggers/execution_logger.h"
+#include "storage/block_store.h"
 #include "storage/index/index.h"
+#include "transaction/transaction_context.h"
 
 namespace noisepage::execution::sql {
 
@@ -23,7 +28,14 @@ TableVectorIterator::TableVectorIterator(exec::ExecutionContext *exec_ctx, uint3
                                          uint32_t num_oids)
     : exec_ctx_(exec_ctx), table_oid_(table_oid), col_oids_(col_oids, col_oids + num_oids) {}
 
-TableVectorIterator::~TableVectorIterator() = default;
+TableVectorIterator::~TableVectorIterator() { ReleaseInPlaceBlock(); }
+
+void TableVectorIterator::ReleaseInPlaceBlock() {
+  if (in_place_block_ == nullptr) return;
+  storage::DataTable::ReleaseInPlaceRead(in_place_block_);
+  in_place_block_ = nullptr;
+  vector_projection_.Reset(common::Constants::K_DEFAULT_VECTOR_SIZE);
+}
 
 bool TableVectorIterator::Init() { return Init(0, storage::DataTable::GetMaxBlocks()); }
 
@@ -36,7 +48,14 @@ bool TableVectorIterator::Init(uint32_t block_start, uint32_t block_end) {
   // Set up the table and the iterator.
   table_ = exec_ctx_->GetAccessor()->GetTable(table_oid_);
   NOISEPAGE_ASSERT(table_ != nullptr, "Table must exist!!");
-  if (block_start == 0 && block_end == storage::DataTable::GetMaxBlocks()) {
+  shared_scan_ = block_start == 0 && block_end == storage::DataTable::GetMaxBlocks() &&
+                 table_->table_.data_table_->HasSharedScans();
+  if (shared_scan_) {
+    // Join the scans already running, and read the blocks before where they are at the end
+    wrap_end_ = table_->table_.data_table_->GetSharedScanStart();
+    iter_ = std::make_unique<storage::DataTable::SlotIterator>(
+        table_->GetBlockedSlotIterator(wrap_end_, table_->GetNumBlocks()));
+  } else if (block_start == 0 && block_end == storage::DataTable::GetMaxBlocks()) {
     iter_ = std::make_unique<storage::DataTable::SlotIterator>(table_->begin());
   } else {
     iter_ = std::make_unique<storage::DataTable::SlotIterator>(table_->GetBlockedSlotIterator(block_start, block_end));
@@ -59,6 +78,8 @@ bool TableVectorIterator::Init(uint32_t block_start, uint32_t block_end) {
   vector_projection_.SetStorageColIds(col_ids);
   vector_projection_.Initialize(col_types);
   vector_projection_.Reset(common::Constants::K_DEFAULT_VECTOR_SIZE);
+  early_col_idxs_.resize(col_oids_.size());
+  std::iota(early_col_idxs_.begin(), early_col_idxs_.end(), 0);
 
   // All good.
   initialized_ = true;
@@ -71,18 +92,102 @@ bool TableVectorIterator::Advance() {
     return false;
   }
 
-  // If the iterator is out of data, then we are done.
-  if (*iter_ == table_->end() || (**iter_).GetBlock() == nullptr) {
-    return false;
-  }
+  // The previous projection is done with
+  ReleaseInPlaceBlock();
+
+  while (true) {
+    // Blocks are skipped before any of their tuples are read
+    while (*iter_ != table_->end() && (**iter_).GetBlock() != nullptr && (**iter_).GetOffset() == 0 &&
+           !BlockMayPass()) {
+      table_->SkipBlock(iter_.get());
+    }
+    if (*iter_ != table_->end() && (**iter_).GetBlock() != nullptr) break;
 
-  // Otherwise, scan the table to set the vector projection.
-  table_->Scan(exec_ctx_->GetTxn(), iter_.get(), &vector_projection_);
+    // If the iterator is out of data, then we are done, unless a shared scan has yet to read the blocks it skipped
+    if (wrap_end_ == 0) return false;
+    *iter_ = table_->GetBlockedSlotIterator(0, wrap_end_);
+    wrap_end_ = 0;
+  }
+  if (shared_scan_ && (**iter_).GetOffset() == 0) table_->table_.data_table_->ReportScanPosition(*iter_);
+
+  // Otherwise, scan the table to set the vector projection. Frozen blocks are read without copying their tuples, and
+  // the late columns are left out of copied tuples while the filters are selective enough.
+  in_place_block_ = table_->ScanInPlace(exec_ctx_->GetTxn(), iter_.get(), &vector_projection_);
+  late_columns_pending_ = false;
+  if (in_place_block_ == nullptr) {
+    late_columns_pending_ =
+        !late_col_idxs_.empty() && static_cast<double>(num_selected_) <=
+                                       static_cast<double>(num_scanned_) * K_MAX_LATE_MATERIALIZATION_SELECTIVITY;
+    table_->Scan(exec_ctx_->GetTxn(), iter_.get(), &vector_projection_,
+                 late_columns_pending_ ? &early_col_idxs_ : nullptr);
+  }
   vector_projection_iterator_.SetVectorProjection(&vector_projection_);
 
   return true;
 }
 
+void TableVectorIterator::SampleBlocks(const uint32_t num_blocks) {
+  NOISEPAGE_ASSERT(IsInitialized(), "Blocks are sampled from the table the iterator was initialized over.");
+  const std::vector<storage::RawBlock *> blocks = table_->table_.data_table_->GetBlocks();
+  if (num_blocks == 0 || num_blocks >= blocks.size()) return;
+
+  // Algorithm R: the i-th block replaces a random block of the reservoir with probability num_blocks / (i + 1)
+  std::vector<storage::RawBlock *> reservoir(blocks.begin(), blocks.begin() + num_blocks);
+  std::mt19937_64 generator(std::random_device{}());  // NOLINT
+  for (uint64_t i = num_blocks; i < blocks.size(); i++) {
+    const uint64_t j = std::uniform_int_distribution<uint64_t>(0, i)(generator);
+    if (j < num_blocks) reservoir[j] = blocks[i];
+  }
+
+  // The last block may only be partly filled, so the scale is the ratio of slots rather than the one of blocks
+  uint64_t num_slots = 0;
+  for (auto *const block : blocks) num_slots += block->GetInsertHead();
+  uint64_t num_sampled_slots = 0;
+  for (auto *const block : reservoir) {
+    num_sampled_slots += block->GetInsertHead();
+    sampled_blocks_.insert(block);
+  }
+  if (num_sampled_slots > 0) {
+    exec_ctx_->SetSampleScale(static_cast<double>(num_slots) / static_cast<double>(num_sampled_slots));
+  }
+}
+
+void TableVectorIterator::LateMaterialize(const uint32_t col_idx) {
+  NOISEPAGE_ASSERT(IsInitialized(), "Late columns are picked amongst the columns the iterator was initialized with.");
+  const auto early = std::find(early_col_idxs_.begin(), early_col_idxs_.end(), col_idx);
+  if (early == early_col_idxs_.end()) return;
+  early_col_idxs_.erase(early);
+  late_col_idxs_.insert(std::upper_bound(late_col_idxs_.begin(), late_col_idxs_.end(), col_idx), col_idx);
+  NOISEPAGE_ASSERT(!early_col_idxs_.empty(), "At least one column must be read with the projections.");
+}
+
+void TableVectorIterator::FetchLateColumns() {
+  num_scanned_ += vector_projection_.GetTotalTupleCount();
+  num_selected_ += vector_projection_.GetSelectedTupleCount();
+  if (!late_columns_pending_) return;
+  late_columns_pending_ = false;
+  table_->SelectColumns(exec_ctx_->GetTxn(), &vector_projection_, late_col_idxs_);
+}
+
+bool TableVectorIterator::BlockMayPass() const {
+  const storage::RawBlock *const block = (**iter_).GetBlock();
+  if (!sampled_blocks_.empty() && sampled_blocks_.count(block) == 0) return false;
+  for (const auto &filter : block_filters_) {
+    const storage::col_id_t col_id = vector_projection_.ColumnIds()[filter.col_idx_];
+    if (!table_->BlockMayContain(block, col_id, filter.min_, filter.max_)) return false;
+  }
+  for (const auto &filter : top_k_block_filters_) {
+    // Integers are normalized by flipping their sign bit, and descending keys are inverted on top of that
+    const uint64_t bound = filter.sorter_->GetTopKBound();
+    const auto limit = static_cast<int64_t>((filter.descending_ ? ~bound : bound) ^ (uint64_t{1} << 63u));
+    const int64_t min = filter.descending_ ? limit : std::numeric_limits<int64_t>::min();
+    const int64_t max = filter.descending_ ? std::numeric_limits<int64_t>::max() : limit;
+    const storage::col_id_t col_id = vector_projection_.ColumnIds()[filter.col_idx_];
+    if (!table_->BlockMayContain(block, col_id, min, max)) return false;
+  }
+  return true;
+}
+
 namespace {
 
 class ScanTask {
@@ -108,7 +213,8 @@ class ScanTask {
 
     // Pull out the thread-local state
     byte *const thread_state = thread_state_container_->AccessCurrentThreadState();
-    // Call scanning function
+    // Call scanning function, which writes to buffers of this thread if it modifies the table
+    transaction::TransactionContext::WorkerScope worker_scope(exec_ctx_->GetTxn());
     scanner_(query_state_, thread_state, &iter);
   }
 
@@ -122,6 +228,67 @@ class ScanTask {
   TableVectorIterator::ScanFn scanner_ = nullptr;
 };
 
+// A contiguous range of blocks that were all placed on the same NUMA node
+struct BlockMorsel {
+  uint32_t begin_;
+  uint32_t end_;
+};
+
+// Hands out the blocks of a table in morsels, preferring morsels on the NUMA node of the calling thread. Once the local
+// morsels are used up, a thread steals the morsels of other nodes.
+class NumaMorselQueue {
+ public:
+  NumaMorselQueue(const std::vector<storage::RawBlock *> &blocks, const uint32_t grain_size)
+      : morsels_(storage::BlockStore::NumNodes()), next_(storage::BlockStore::NumNodes()) {
+    for (uint32_t begin = 0; begin < blocks.size();) {
+      const uint16_t node = storage::BlockStore::NodeOf(blocks[begin]);
+      uint32_t end = begin + 1;
+      while (end < blocks.size() && end - begin < grain_size && storage::BlockStore::NodeOf(blocks[end]) == node) end++;
+      morsels_[node].push_back({begin, end});
+      num_morsels_++;
+      begin = end;
+    }
+  }
+
+  uint32_t NumMorsels() const { return num_morsels_; }
+
+  // There are exactly as many calls as there are morsels, so every call finds one
+  BlockMorsel Next() {
+    const uint16_t local = storage::BlockStore::CurrentNode();
+    for (uint16_t i = 0; i < morsels_.size(); i++) {
+      const uint16_t node = (local + i) % morsels_.size();
+      if (next_[node].load(std::memory_order_relaxed) >= morsels_[node].size()) continue;
+      const uint32_t index = next_[node].fetch_add(1, std::memory_order_relaxed);
+      if (index < morsels_[node].size()) return morsels_[node][index];
+    }
+    NOISEPAGE_ASSERT(false, "More morsels requested than there are.");
+    return {0, 0};
+  }
+
+ private:
+  std::vector<std::vector<BlockMorsel>> morsels_;
+  std::vector<std::atomic<uint32_t>> next_;
+  uint32_t num_morsels_ = 0;
+};
+
+// Every index of the range of a NumaScanTask stands for one morsel, which is only picked once the task runs, on the
+// thread that runs it
+class NumaScanTask {
+ public:
+  NumaScanTask(ScanTask scan_task, NumaMorselQueue *morsels) : scan_task_(scan_task), morsels_(morsels) {}
+
+  void operator()(const tbb::blocked_range<uint32_t> &morsel_range) const {
+    for (uint32_t i = morsel_range.begin(); i != morsel_range.end(); i++) {
+      const BlockMorsel morsel = morsels_->Next();
+      scan_task_(tbb::blocked_range<uint32_t>(morsel.begin_, morsel.end_));
+    }
+  }
+
+ private:
+  const ScanTask scan_task_;
+  NumaMorselQueue *const morsels_;
+};
+
 }  // namespace
 
 bool TableVectorIterator::ParallelScan(uint32_t table_oid, uint32_t *col_oids, uint32_t num_oids,
@@ -138,24 +305,36 @@ bool TableVectorIterator::ParallelScan(uint32_t table_oid, uint32_t *col_oids, u
   timer.Start();
 
   // Execute parallel scan
-  size_t num_threads = std::max(exec_ctx->GetExecutionSettings().GetNumberOfParallelExecutionThreads(), 0);
-  size_t num_tasks = std::ceil(table->table_.data_table_->GetNumBlocks() * 1.0 / min_grain_size);
-  size_t concurrent = std::min(num_threads, num_tasks);
-  exec_ctx->SetNumConcurrentEstimate(concurrent);
-
-  tbb::task_arena limited_arena(num_threads);
-  tbb::blocked_range<uint32_t> block_range(0, table->table_.data_table_->GetNumBlocks(), min_grain_size);
-  const bool is_static_partitioned = exec_ctx->GetExecutionSettings().GetIsStaticPartitionerEnabled();
-  limited_arena.execute(
-      [&block_range, &table_oid, &col_oids, &num_oids, &query_state, &exec_ctx, &scan_fn, is_static_partitioned] {
-        is_static_partitioned
-            ? tbb::parallel_for(block_range, ScanTask(table_oid, col_oids, num_oids, query_state, exec_ctx, scan_fn),
-                                tbb::static_partitioner())
-            : tbb::parallel_for(block_range, ScanTask(table_oid, col_oids, num_oids, query_state, exec_ctx, scan_fn));
-      });
-
-  exec_ctx->SetNumConcurrentEstimate(0);
+  const size_t num_tasks = std::ceil(table->table_.data_table_->GetNumBlocks() * 1.0 / min_grain_size);
+  if (storage::BlockStore::NumNodes() > 1) {
+    // Threads scan the blocks on their own NUMA node first, so morsels are claimed dynamically instead of partitioning
+    // the block range up front
+    NumaMorselQueue morsels(table->table_.data_table_->GetBlocks(), min_grain_size);
+    tbb::blocked_range<uint32_t> morsel_range(0, morsels.NumMorsels(), 1);
+    exec::TaskScheduler::Execute(
+        exec_ctx, num_tasks,
+        [&morsel_range, &morsels, &table_oid, &col_oids, &num_oids, &query_state, &exec_ctx, &scan_fn] {
+          tbb::parallel_for(morsel_range,
+                            NumaScanTask(ScanTask(table_oid, col_oids, num_oids, query_state, exec_ctx, scan_fn),
+                                         &morsels));
+        });
+  } else {
+    tbb::blocked_range<uint32_t> block_range(0, table->table_.data_table_->GetNumBlocks(), min_grain_size);
+    const bool is_static_partitioned = exec_ctx->GetExecutionSettings().GetIsStaticPartitionerEnabled();
+    exec::TaskScheduler::Execute(
+        exec_ctx, num_tasks,
+        [&block_range, &table_oid, &col_oids, &num_oids, &query_state, &exec_ctx, &scan_fn, is_static_partitioned] {
+          is_static_partitioned
+              ? tbb::parallel_for(block_range,
+                                  ScanTask(table_oid, col_oids, num_oids, query_state, exec_ctx, scan_fn),
+                                  tbb::static_partitioner())
+              : tbb::parallel_for(block_range,
+                                  ScanTask(table_oid, col_oids, num_oids, query_state, exec_ctx, scan_fn));
+        });
+  }
+
   timer.Stop();
+  exec_ctx->GetTxn()->MergeWorkerWrites();
 
   auto *tsc = exec_ctx->GetThreadStateContainer();
   auto *tls = tsc->AccessCurrentThreadState();
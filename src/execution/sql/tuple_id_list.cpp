@@ -8,9 +8,7 @@
 namespace noisepage::execution::sql {
 
 void TupleIdList::BuildFromSelectionVector(const sel_t *sel_vector, uint32_t size) {
-  for (uint32_t i = 0; i < size; i++) {
-    bit_vector_.Set(sel_vector[i]);
-  }
+  util::VectorUtil::SelectionVectorToBitVector(sel_vector, size, bit_vector_.GetWords());
 }
 
 uint32_t TupleIdList::ToSelectionVector(sel_t *sel_vec) const {
@@ -13,7 +13,15 @@
 
 namespace noisepage::execution::sql {
 
-Vector::Vector(TypeId type) : type_(type), count_(0), num_elements_(0), data_(nullptr), tid_list_(nullptr) {
+Vector::Vector(TypeId type)
+    : type_(type),
+      count_(0),
+      num_elements_(0),
+      data_(nullptr),
+      tid_list_(nullptr),
+      dictionary_codes_(nullptr),
+      dictionary_(nullptr),
+      dictionary_size_(0) {
   // Since vector capacity can never exceed common::Constants::K_DEFAULT_VECTOR_SIZE, we reserve upon
   // creation to remove allocations as the vector is resized.
   null_mask_.Reserve(common::Constants::K_DEFAULT_VECTOR_SIZE);
@@ -21,7 +29,14 @@ Vector::Vector(TypeId type) : type_(type), count_(0), num_elements_(0), data_(nu
 }
 
 Vector::Vector(TypeId type, bool create_data, bool clear)
-    : type_(type), count_(0), num_elements_(0), data_(nullptr), tid_list_(nullptr) {
+    : type_(type),
+      count_(0),
+      num_elements_(0),
+      data_(nullptr),
+      tid_list_(nullptr),
+      dictionary_codes_(nullptr),
+      dictionary_(nullptr),
+      dictionary_size_(0) {
   // Since vector capacity can never exceed common::Constants::K_DEFAULT_VECTOR_SIZE, we reserve upon
   // creation to remove allocations as the vector is resized.
   null_mask_.Reserve(common::Constants::K_DEFAULT_VECTOR_SIZE);
@@ -35,6 +50,7 @@ Vector::~Vector() { Destroy(); }
 
 void Vector::Initialize(const TypeId new_type, const bool clear) {
   varlen_heap_.Destroy();
+  ClearDictionary();
   type_ = new_type;
 
   // By default, we always allocate common::Constants::K_DEFAULT_VECTOR_SIZE since a vector
@@ -56,6 +72,7 @@ void Vector::Destroy() {
   num_elements_ = 0;
   tid_list_ = nullptr;
   null_mask_.Reset();
+  ClearDictionary();
 }
 
 GenericValue Vector::GetValue(const uint64_t index) const {
@@ -110,6 +127,7 @@ GenericValue Vector::GetValue(const uint64_t index) const {
 void Vector::Resize(uint32_t size) {
   NOISEPAGE_ASSERT(size <= GetCapacity(), "New size exceeds vector capacity.");
   tid_list_ = nullptr;
+  ClearDictionary();
   count_ = size;
   num_elements_ = size;
   null_mask_.Resize(num_elements_);
@@ -118,6 +136,7 @@ void Vector::Resize(uint32_t size) {
 void Vector::SetValue(const uint64_t index, const GenericValue &val) {
   NOISEPAGE_ASSERT(index < count_, "Out-of-bounds vector access");
   NOISEPAGE_ASSERT(type_ == val.GetTypeId(), "Mismatched types");
+  ClearDictionary();
   SetNull(index, val.IsNull());
   const uint64_t actual_index = tid_list_ != nullptr ? (*tid_list_)[index] : index;
   switch (type_) {
@@ -262,6 +281,7 @@ void Vector::Reference(byte *data, const uint32_t *null_mask, uint64_t size) {
   data_ = data;
   tid_list_ = nullptr;
   null_mask_.Resize(num_elements_);
+  ClearDictionary();
 
   // TODO(pmenon): Optimize me if this is a bottleneck
   if (null_mask == nullptr) {
@@ -280,6 +300,7 @@ void Vector::ReferenceNullMask(byte *data, const NullMask *null_mask, uint64_t s
   data_ = data;
   tid_list_ = nullptr;
   null_mask_.Resize(num_elements_);
+  ClearDictionary();
 
   // TODO(pmenon): Optimize me if this is a bottleneck
   if (null_mask == nullptr) {
@@ -299,6 +320,18 @@ void Vector::Reference(const Vector *other) {
   data_ = other->data_;
   tid_list_ = other->tid_list_;
   null_mask_ = other->null_mask_;
+  dictionary_codes_ = other->dictionary_codes_;
+  dictionary_ = other->dictionary_;
+  dictionary_size_ = other->dictionary_size_;
+}
+
+void Vector::SetDictionary(const uint64_t *codes, const storage::VarlenEntry *dictionary,
+                           const uint32_t dictionary_size) {
+  NOISEPAGE_ASSERT(type_ == TypeId::Varchar, "Only vectors of strings can be dictionary-encoded");
+  NOISEPAGE_ASSERT(codes != nullptr && dictionary != nullptr, "Dictionary encoding cannot be NULL");
+  dictionary_codes_ = codes;
+  dictionary_ = dictionary;
+  dictionary_size_ = dictionary_size;
 }
 
 void Vector::Pack() {
@@ -340,6 +373,9 @@ void Vector::MoveTo(Vector *other) {
   other->data_ = data_;
   other->tid_list_ = tid_list_;
   other->null_mask_ = std::move(null_mask_);
+  other->dictionary_codes_ = dictionary_codes_;
+  other->dictionary_ = dictionary_;
+  other->dictionary_size_ = dictionary_size_;
   other->owned_data_ = std::move(owned_data_);
   other->varlen_heap_ = std::move(varlen_heap_);
 
@@ -417,6 +453,7 @@ void Vector::Append(const Vector &other) {
   uint64_t old_size = count_;
   num_elements_ += other.GetCount();
   count_ += other.GetCount();
+  ClearDictionary();
 
   // Since the vector's size has changed, we need to also resize the NULL bit mask.
   null_mask_.Resize(num_elements_);
@@ -0,0 +1,142 @@
+#include <algorithm>
+#include <limits>
+
+#include "common/error/error_code.h"
+#include "common/error/exception.h"
+#include "execution/sql/tuple_id_list.h"
+#include "execution/sql/vector_operations/vector_operations.h"
+#include "execution/util/bit_util.h"
+#include "execution/util/bit_vector.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage::execution::sql {
+
+namespace {
+
+void CheckAggregateArguments(const Vector &input, const bool floating_point) {
+  const bool valid = floating_point ? IsTypeFloatingPoint(input.GetTypeId()) : IsTypeIntegral(input.GetTypeId());
+  if (!valid) {
+    throw EXECUTION_EXCEPTION(fmt::format("Invalid type {} for vector aggregation.", TypeIdToString(input.GetTypeId())),
+                              common::ErrorCode::ERRCODE_INTERNAL_ERROR);
+  }
+}
+
+// Fold the active, non-NULL elements of the input into the identity with the given operation, and return the number
+// of elements folded. The TID list and the NULL mask are combined a word at a time. Words whose elements all take
+// part are folded without testing any bit, as are vectors without a TID list or NULLs, in loops the compiler
+// vectorizes. Only the remaining words are walked a set bit at a time.
+template <typename T, typename R, typename Op>
+uint64_t TemplatedFold(const Vector &input, const R identity, R *result, Op op) {
+  constexpr uint64_t word_bits = common::Constants::K_BITS_PER_BYTE * sizeof(uint64_t);
+
+  const auto *RESTRICT data = reinterpret_cast<const T *>(input.GetData());
+  const TupleIdList *tid_list = input.GetFilteredTupleIdList();
+  const Vector::NullMask &null_mask = input.GetNullMask();
+  const uint64_t size = input.GetSize();
+
+  R acc = identity;
+  uint64_t num_folded = 0;
+  if (tid_list == nullptr && null_mask.None()) {
+    for (uint64_t i = 0; i < size; i++) {
+      acc = op(acc, static_cast<R>(data[i]));
+    }
+    num_folded = size;
+  } else {
+    const uint32_t num_words = util::BitVector<uint64_t>::NumNeededWords(size);
+    for (uint32_t word_idx = 0; word_idx < num_words; word_idx++) {
+      const uint64_t base = static_cast<uint64_t>(word_idx) * word_bits;
+      uint64_t word = tid_list != nullptr ? tid_list->GetBits().GetWord(word_idx) : ~uint64_t(0);
+      word &= ~null_mask.GetWord(word_idx);
+      if (size - base < word_bits) {
+        word &= (uint64_t(1) << (size - base)) - 1;
+      }
+      if (word == ~uint64_t(0)) {
+        for (uint64_t i = base; i < base + word_bits; i++) {
+          acc = op(acc, static_cast<R>(data[i]));
+        }
+        num_folded += word_bits;
+        continue;
+      }
+      num_folded += util::BitUtil::CountPopulation(word);
+      for (; word != 0; word &= word - 1) {
+        acc = op(acc, static_cast<R>(data[base + util::BitUtil::CountTrailingZeros(word)]));
+      }
+    }
+  }
+
+  if (num_folded != 0) {
+    *result = acc;
+  }
+  return num_folded;
+}
+
+template <typename R, typename Op>
+bool FoldOperation(const Vector &input, const R identity, R *result, Op op) {
+  CheckAggregateArguments(input, std::is_floating_point_v<R>);
+
+  switch (input.GetTypeId()) {
+    case TypeId::TinyInt:
+      return TemplatedFold<int8_t>(input, identity, result, op) != 0;
+    case TypeId::SmallInt:
+      return TemplatedFold<int16_t>(input, identity, result, op) != 0;
+    case TypeId::Integer:
+      return TemplatedFold<int32_t>(input, identity, result, op) != 0;
+    case TypeId::BigInt:
+      return TemplatedFold<int64_t>(input, identity, result, op) != 0;
+    case TypeId::Float:
+      return TemplatedFold<float>(input, identity, result, op) != 0;
+    case TypeId::Double:
+      return TemplatedFold<double>(input, identity, result, op) != 0;
+    default:
+      UNREACHABLE("Impossible type in vector aggregation.");
+  }
+}
+
+template <typename R>
+bool SumOperation(const Vector &input, R *result) {
+  return FoldOperation(input, R(0), result, [](const R acc, const R val) { return acc + val; });
+}
+
+template <typename R>
+bool MinOperation(const Vector &input, R *result) {
+  return FoldOperation(input, std::numeric_limits<R>::max(), result,
+                       [](const R acc, const R val) { return std::min(acc, val); });
+}
+
+template <typename R>
+bool MaxOperation(const Vector &input, R *result) {
+  return FoldOperation(input, std::numeric_limits<R>::lowest(), result,
+                       [](const R acc, const R val) { return std::max(acc, val); });
+}
+
+}  // namespace
+
+uint64_t VectorOps::CountNotNull(const Vector &input) {
+  if (input.GetNullMask().None()) {
+    return input.GetCount();
+  }
+  const TupleIdList *tid_list = input.GetFilteredTupleIdList();
+  if (tid_list == nullptr) {
+    return input.GetSize() - input.GetNullMask().CountOnes();
+  }
+  uint64_t count = 0;
+  for (uint32_t word_idx = 0; word_idx < tid_list->GetBits().GetNumWords(); word_idx++) {
+    count += util::BitUtil::CountPopulation(tid_list->GetBits().GetWord(word_idx) &
+                                            ~input.GetNullMask().GetWord(word_idx));
+  }
+  return count;
+}
+
+bool VectorOps::Sum(const Vector &input, int64_t *result) { return SumOperation(input, result); }
+
+bool VectorOps::Sum(const Vector &input, double *result) { return SumOperation(input, result); }
+
+bool VectorOps::Min(const Vector &input, int64_t *result) { return MinOperation(input, result); }
+
+bool VectorOps::Min(const Vector &input, double *result) { return MinOperation(input, result); }
+
+bool VectorOps::Max(const Vector &input, int64_t *result) { return MaxOperation(input, result); }
+
+bool VectorOps::Max(const Vector &input, double *result) { return MaxOperation(input, result); }
+
+}  // namespace noisepage::execution::sql
@@ -0,0 +1,87 @@
+#include "common/error/error_code.h"
+#include "common/error/exception.h"
+#include "execution/exec/execution_settings.h"
+#include "execution/sql/operators/date_time_operators.h"
+#include "execution/sql/vector_operations/unary_operation_executor.h"
+#include "execution/sql/vector_operations/vector_operations.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage::execution::sql {
+
+namespace traits {
+
+// Extracting a part is branch-free arithmetic that is safe on any value, so it is cheaper to extract it from every
+// element than to go through the selected ones.
+template <template <DatePartType> typename Op, DatePartType Part>
+struct ShouldPerformFullCompute<Op<Part>,
+                                std::enable_if_t<std::is_same_v<Op<Part>, ExtractDatePartFromDate<Part>> ||
+                                                 std::is_same_v<Op<Part>, ExtractDatePartFromTimestamp<Part>>>> {
+  bool operator()(const exec::ExecutionSettings &exec_settings, const TupleIdList *tid_list) const {
+    auto full_compute_threshold = exec_settings.GetArithmeticFullComputeOptThreshold();
+    return tid_list == nullptr || full_compute_threshold <= tid_list->ComputeSelectivity();
+  }
+};
+
+}  // namespace traits
+
+namespace {
+
+template <DatePartType Part>
+void TemplatedDatePartOperation(const exec::ExecutionSettings &exec_settings, const Vector &input, Vector *result) {
+  switch (input.GetTypeId()) {
+    case TypeId::Date:
+      UnaryOperationExecutor::Execute<Date::NativeType, int32_t, ExtractDatePartFromDate<Part>>(exec_settings, input,
+                                                                                                 result);
+      break;
+    case TypeId::Timestamp:
+      UnaryOperationExecutor::Execute<Timestamp::NativeType, int32_t, ExtractDatePartFromTimestamp<Part>>(
+          exec_settings, input, result);
+      break;
+    default:
+      throw EXECUTION_EXCEPTION(
+          fmt::format("Date parts can only be extracted from dates and timestamps, not {}.",
+                      TypeIdToString(input.GetTypeId())),
+          common::ErrorCode::ERRCODE_INTERNAL_ERROR);
+  }
+}
+
+}  // namespace
+
+void VectorOps::DatePart(const exec::ExecutionSettings &exec_settings, const Vector &input, const DatePartType part,
+                         Vector *result) {
+  static_assert(sizeof(Date) == sizeof(Date::NativeType) && sizeof(Timestamp) == sizeof(Timestamp::NativeType),
+                "Vectors of dates and timestamps must be arrays of their native values");
+  if (result->GetTypeId() != TypeId::Integer) {
+    throw EXECUTION_EXCEPTION(fmt::format("Date parts are extracted into Integer vectors, not {}.",
+                                          TypeIdToString(result->GetTypeId())),
+                              common::ErrorCode::ERRCODE_INTERNAL_ERROR);
+  }
+
+#define DATE_PART_CASE(PART)                                                      \
+  case DatePartType::PART:                                                        \
+    TemplatedDatePartOperation<DatePartType::PART>(exec_settings, input, result); \
+    break;
+
+  switch (part) {
+    DATE_PART_CASE(CENTURY)
+    DATE_PART_CASE(DECADE)
+    DATE_PART_CASE(YEAR)
+    DATE_PART_CASE(QUARTER)
+    DATE_PART_CASE(MONTH)
+    DATE_PART_CASE(DAY)
+    DATE_PART_CASE(DOW)
+    DATE_PART_CASE(DOY)
+    DATE_PART_CASE(HOUR)
+    DATE_PART_CASE(MINUTE)
+    DATE_PART_CASE(SECOND)
+    DATE_PART_CASE(MILLISECOND)
+    DATE_PART_CASE(MICROSECOND)
+    default:
+      throw EXECUTION_EXCEPTION(fmt::format("Date part {} is not supported.", static_cast<uint32_t>(part)),
+                                common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED);
+  }
+
+#undef DATE_PART_CASE
+}
+
+}  // namespace noisepage::execution::sql
@@ -0,0 +1,133 @@
+#include "common/error/error_code.h"
+#include "common/error/exception.h"
+#include "execution/sql/operators/decimal_operators.h"
+#include "execution/sql/operators/numeric_binary_operators.h"
+#include "execution/sql/vector_operations/vector_operations.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage::execution::sql {
+
+namespace {
+
+// Decimals are carried in vectors as their encoded 64-bit values.
+void CheckDecimalVector(const Vector &vector) {
+  if (vector.GetTypeId() != TypeId::BigInt) {
+    throw EXECUTION_EXCEPTION(
+        fmt::format("Decimal vectors must hold encoded BigInt values, got {}.", TypeIdToString(vector.GetTypeId())),
+        common::ErrorCode::ERRCODE_INTERNAL_ERROR);
+  }
+}
+
+void ThrowDecimalOutOfRange() {
+  throw EXECUTION_EXCEPTION("Decimal value out of range.", common::ErrorCode::ERRCODE_NUMERIC_VALUE_OUT_OF_RANGE);
+}
+
+// Apply an overflow-checked operation to the active elements of the input. The overflow flags of the elements are
+// gathered and only checked once all elements are done, so that the loop has no branch that keeps it from being
+// vectorized.
+template <typename Op>
+void DecimalUnaryOperation(const Vector &input, Vector *result, const Op &op) {
+  CheckDecimalVector(input);
+  CheckDecimalVector(*result);
+
+  const auto *input_data = reinterpret_cast<const int64_t *>(input.GetData());
+  auto *result_data = reinterpret_cast<int64_t *>(result->GetData());
+
+  result->Resize(input.GetSize());
+  result->GetMutableNullMask()->Copy(input.GetNullMask());
+  result->SetFilteredTupleIdList(input.GetFilteredTupleIdList(), input.GetCount());
+
+  bool overflow = false;
+  if (input.IsConstant()) {
+    overflow = !input.IsNull(0) && op(input_data[0], &result_data[0]);
+  } else if (input.GetNullMask().Any()) {
+    const auto &null_mask = input.GetNullMask();
+    VectorOps::Exec(input,
+                    [&](uint64_t i, uint64_t k) { overflow |= op(input_data[i], &result_data[i]) & !null_mask[i]; });
+  } else {
+    VectorOps::Exec(input, [&](uint64_t i, uint64_t k) { overflow |= op(input_data[i], &result_data[i]); });
+  }
+  if (overflow) ThrowDecimalOutOfRange();
+}
+
+// Apply an overflow-checked operation to the active elements of the inputs, at most one of which may be a constant
+template <typename Op>
+void DecimalBinaryOperation(const Vector &left, const Vector &right, Vector *result, const Op &op) {
+  CheckDecimalVector(left);
+  CheckDecimalVector(right);
+  CheckDecimalVector(*result);
+  NOISEPAGE_ASSERT(!left.IsConstant() || !right.IsConstant(), "Both inputs to binary cannot be constants");
+  if (!left.IsConstant() && !right.IsConstant() && left.GetCount() != right.GetCount()) {
+    throw EXECUTION_EXCEPTION(
+        fmt::format("Left and right input vectors to binary operation must have the same size, left {} right {}.",
+                    left.GetCount(), right.GetCount()),
+        common::ErrorCode::ERRCODE_INTERNAL_ERROR);
+  }
+
+  const auto *left_data = reinterpret_cast<const int64_t *>(left.GetData());
+  const auto *right_data = reinterpret_cast<const int64_t *>(right.GetData());
+  auto *result_data = reinterpret_cast<int64_t *>(result->GetData());
+  // A constant input repeats its only element
+  const uint64_t left_step = left.IsConstant() ? 0 : 1;
+  const uint64_t right_step = right.IsConstant() ? 0 : 1;
+
+  const Vector &shape = left.IsConstant() ? right : left;
+  result->Resize(shape.GetSize());
+  result->SetFilteredTupleIdList(shape.GetFilteredTupleIdList(), shape.GetCount());
+
+  if ((left.IsConstant() && left.IsNull(0)) || (right.IsConstant() && right.IsNull(0))) {
+    VectorOps::FillNull(result);
+    return;
+  }
+  if (left.IsConstant()) {
+    result->GetMutableNullMask()->Copy(right.GetNullMask());
+  } else if (right.IsConstant()) {
+    result->GetMutableNullMask()->Copy(left.GetNullMask());
+  } else {
+    result->GetMutableNullMask()->Copy(left.GetNullMask()).Union(right.GetNullMask());
+  }
+
+  bool overflow = false;
+  if (result->GetNullMask().Any()) {
+    const auto &null_mask = result->GetNullMask();
+    VectorOps::Exec(shape, [&](uint64_t i, uint64_t k) {
+      overflow |= op(left_data[i * left_step], right_data[i * right_step], &result_data[i]) & !null_mask[i];
+    });
+  } else {
+    VectorOps::Exec(shape, [&](uint64_t i, uint64_t k) {
+      overflow |= op(left_data[i * left_step], right_data[i * right_step], &result_data[i]);
+    });
+  }
+  if (overflow) ThrowDecimalOutOfRange();
+}
+
+}  // namespace
+
+void VectorOps::DecimalRescale(const Vector &input, const uint32_t from_scale, const uint32_t to_scale,
+                               Vector *result) {
+  DecimalUnaryOperation(input, result, DecimalRescaleWithOverflow<int64_t>(from_scale, to_scale));
+}
+
+void VectorOps::DecimalAdd(const Vector &left, const uint32_t left_scale, const Vector &right,
+                           const uint32_t right_scale, Vector *result) {
+  if (left_scale == right_scale) {
+    DecimalBinaryOperation(left, right, result, AddWithOverflow<int64_t>{});
+  } else {
+    DecimalBinaryOperation(left, right, result, DecimalAddWithOverflow<int64_t>(left_scale, right_scale));
+  }
+}
+
+void VectorOps::DecimalSubtract(const Vector &left, const uint32_t left_scale, const Vector &right,
+                                const uint32_t right_scale, Vector *result) {
+  if (left_scale == right_scale) {
+    DecimalBinaryOperation(left, right, result, SubtractWithOverflow<int64_t>{});
+  } else {
+    DecimalBinaryOperation(left, right, result, DecimalSubtractWithOverflow<int64_t>(left_scale, right_scale));
+  }
+}
+
+void VectorOps::DecimalMultiply(const Vector &left, const Vector &right, Vector *result) {
+  DecimalBinaryOperation(left, right, result, MultiplyWithOverflow<int64_t>{});
+}
+
+}  // namespace noisepage::execution::sql
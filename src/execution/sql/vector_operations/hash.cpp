@@ -1,3 +1,5 @@
+#include <vector>
+
 #include "common/error/error_code.h"
 #include "common/error/exception.h"
 #include "execution/sql/operators/hash_operators.h"
@@ -25,6 +27,22 @@ void TemplatedHashOperation(const Vector &input, Vector *result) {
   result->GetMutableNullMask()->Reset();
   result->SetFilteredTupleIdList(input.GetFilteredTupleIdList(), input.GetCount());
 
+  // Hash every distinct value of a dictionary-encoded input only once, if there are fewer of them than elements
+  if constexpr (std::is_same_v<InputType, storage::VarlenEntry>) {  // NOLINT
+    if (input.IsDictionaryEncoded() && input.GetDictionarySize() <= input.GetCount()) {
+      std::vector<hash_t> hashes(input.GetDictionarySize());
+      for (uint32_t code = 0; code < input.GetDictionarySize(); code++) {
+        hashes[code] = noisepage::execution::sql::Hash<InputType>{}(input.GetDictionary()[code], false);
+      }
+      const uint64_t *RESTRICT codes = input.GetDictionaryCodes();
+      VectorOps::Exec(input, [&](uint64_t i, uint64_t k) {
+        result_data[i] = input.GetNullMask()[i] ? noisepage::execution::sql::Hash<InputType>{}(input_data[i], true)
+                                                : hashes[codes[i]];
+      });
+      return;
+    }
+  }
+
   if (input.GetNullMask().Any()) {
     VectorOps::Exec(input, [&](uint64_t i, uint64_t k) {
       result_data[i] = noisepage::execution::sql::Hash<InputType>{}(input_data[i], input.GetNullMask()[i]);
@@ -57,6 +75,47 @@ void TemplatedHashCombineOperation(const Vector &input, Vector *result) {
   }
 }
 
+template <typename FirstType, typename SecondType>
+void TemplatedHashPairOperation(const Vector &first, const Vector &second, Vector *result) {
+  auto *RESTRICT first_data = reinterpret_cast<FirstType *>(first.GetData());
+  auto *RESTRICT second_data = reinterpret_cast<SecondType *>(second.GetData());
+  auto *RESTRICT result_data = reinterpret_cast<hash_t *>(result->GetData());
+
+  result->Resize(first.GetSize());
+  result->GetMutableNullMask()->Reset();
+  result->SetFilteredTupleIdList(first.GetFilteredTupleIdList(), first.GetCount());
+
+  if (first.GetNullMask().Any() || second.GetNullMask().Any()) {
+    VectorOps::Exec(first, [&](uint64_t i, uint64_t k) {
+      const hash_t seed = noisepage::execution::sql::Hash<FirstType>{}(first_data[i], first.GetNullMask()[i]);
+      result_data[i] =
+          noisepage::execution::sql::HashCombine<SecondType>{}(second_data[i], second.GetNullMask()[i], seed);
+    });
+  } else {
+    VectorOps::Exec(first, [&](uint64_t i, uint64_t k) {
+      const hash_t seed = noisepage::execution::sql::Hash<FirstType>{}(first_data[i], false);
+      result_data[i] = noisepage::execution::sql::HashCombine<SecondType>{}(second_data[i], false, seed);
+    });
+  }
+}
+
+template <typename FirstType>
+bool TemplatedHashPairDispatch(const Vector &first, const Vector &second, Vector *result) {
+  switch (second.GetTypeId()) {
+    case TypeId::Integer:
+      TemplatedHashPairOperation<FirstType, int32_t>(first, second, result);
+      return true;
+    case TypeId::BigInt:
+      TemplatedHashPairOperation<FirstType, int64_t>(first, second, result);
+      return true;
+    case TypeId::Date:
+      TemplatedHashPairOperation<FirstType, Date>(first, second, result);
+      return true;
+    default:
+      return false;
+  }
+}
+
 }  // namespace
 
 void VectorOps::Hash(const Vector &input, Vector *result) {
@@ -143,4 +202,34 @@ void VectorOps::HashCombine(const Vector &input, Vector *result) {
   }
 }
 
+void VectorOps::Hash(const Vector &first, const Vector &second, Vector *result) {
+  // Sanity check
+  CheckHashArguments(first, result);
+  NOISEPAGE_ASSERT(first.GetFilteredTupleIdList() == second.GetFilteredTupleIdList() &&
+                       first.GetSize() == second.GetSize(),
+                   "Vectors hashed together must hold the same tuples.");
+
+  // Lift-off
+  bool fused;
+  switch (first.GetTypeId()) {
+    case TypeId::Integer:
+      fused = TemplatedHashPairDispatch<int32_t>(first, second, result);
+      break;
+    case TypeId::BigInt:
+      fused = TemplatedHashPairDispatch<int64_t>(first, second, result);
+      break;
+    case TypeId::Date:
+      fused = TemplatedHashPairDispatch<Date>(first, second, result);
+      break;
+    default:
+      fused = false;
+      break;
+  }
+
+  if (!fused) {
+    Hash(first, result);
+    HashCombine(second, result);
+  }
+}
+
 }  // namespace noisepage::execution::sql
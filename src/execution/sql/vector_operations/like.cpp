@@ -1,8 +1,12 @@
+#include <string_view>
+#include <type_traits>
+
 #include "common/error/error_code.h"
 #include "common/error/exception.h"
 #include "common/macros.h"
 #include "execution/sql/operators/like_operators.h"
 #include "execution/sql/tuple_id_list.h"
+#include "execution/sql/vector_operations/string_kernels.h"
 #include "execution/sql/vector_operations/vector_operations.h"
 #include "spdlog/fmt/fmt.h"
 
@@ -10,6 +14,73 @@ namespace noisepage::execution::sql {
 
 namespace {
 
+// A LIKE pattern that is a literal string with '%' wildcards at its ends only. Such patterns are
+// matched with the string kernels rather than with the general LIKE implementation.
+struct SimplePattern {
+  enum class Kind : uint8_t { Exact, Prefix, Suffix, Contains };
+  Kind kind_;
+  std::string_view literal_;
+};
+
+// Recognize a simple pattern. Returns false if the pattern needs the general implementation.
+bool ParseSimplePattern(const storage::VarlenEntry &pattern, SimplePattern *result) {
+  std::string_view literal(reinterpret_cast<const char *>(pattern.Content()), pattern.Size());
+  if (literal.find('_') != std::string_view::npos || literal.find(DEFAULT_ESCAPE) != std::string_view::npos) {
+    return false;
+  }
+  const auto begin = literal.find_first_not_of('%');
+  if (begin == std::string_view::npos) {
+    // Only wildcards, every string matches
+    *result = {literal.empty() ? SimplePattern::Kind::Exact : SimplePattern::Kind::Contains, std::string_view()};
+    return true;
+  }
+  const auto end = literal.find_last_not_of('%') + 1;
+  const bool leading = begin > 0, trailing = end < literal.size();
+  literal = literal.substr(begin, end - begin);
+  if (literal.find('%') != std::string_view::npos) {
+    return false;
+  }
+  if (leading) {
+    *result = {trailing ? SimplePattern::Kind::Contains : SimplePattern::Kind::Suffix, literal};
+  } else {
+    *result = {trailing ? SimplePattern::Kind::Prefix : SimplePattern::Kind::Exact, literal};
+  }
+  return true;
+}
+
+// Does the string match the simple pattern?
+bool MatchSimplePattern(const SimplePattern &pattern, const storage::VarlenEntry &value) {
+  const std::string_view str(reinterpret_cast<const char *>(value.Content()), value.Size());
+  const auto &literal = pattern.literal_;
+  switch (pattern.kind_) {
+    case SimplePattern::Kind::Exact:
+      return str == literal;
+    case SimplePattern::Kind::Prefix:
+      return str.size() >= literal.size() && str.compare(0, literal.size(), literal) == 0;
+    case SimplePattern::Kind::Suffix:
+      return str.size() >= literal.size() && str.compare(str.size() - literal.size(), literal.size(), literal) == 0;
+    case SimplePattern::Kind::Contains:
+      return StringKernels::Contains(str, literal);
+  }
+  UNREACHABLE("Impossible pattern kind");
+}
+
+// Match the strings against a simple pattern. Exact and prefix patterns first discard most
+// non-matching strings by their inline prefixes, a whole vector at a time.
+template <typename Op>
+void SelectSimplePattern(const storage::VarlenEntry *a_data, const SimplePattern &pattern, TupleIdList *tid_list) {
+  constexpr bool negated = std::is_same_v<Op, NotLike>;
+  if (!negated && (pattern.kind_ == SimplePattern::Kind::Exact || pattern.kind_ == SimplePattern::Kind::Prefix)) {
+    StringKernels::SelectPrefixCandidates(a_data, pattern.literal_, pattern.kind_ == SimplePattern::Kind::Exact,
+                                          tid_list);
+    // Inline prefixes decide short literals entirely
+    if (pattern.literal_.size() <= storage::VarlenEntry::PrefixSize()) {
+      return;
+    }
+  }
+  tid_list->Filter([&](const uint64_t i) { return MatchSimplePattern(pattern, a_data[i]) != negated; });
+}
+
 template <typename Op>
 void TemplatedLikeOperationVectorConstant(const Vector &a, const Vector &b, TupleIdList *tid_list) {
   if (b.IsNull(0)) {
@@ -20,10 +91,20 @@ void TemplatedLikeOperationVectorConstant(const Vector &a, const Vector &b, Tupl
   const auto *RESTRICT a_data = reinterpret_cast<const storage::VarlenEntry *>(a.GetData());
   const auto *RESTRICT b_data = reinterpret_cast<const storage::VarlenEntry *>(b.GetData());
 
+  // Match every distinct value of a dictionary-encoded input only once
+  if (VectorOps::SelectDictionary(
+          a, [&](const storage::VarlenEntry &value) { return Op{}(value, b_data[0]); }, tid_list)) {
+    return;
+  }
+
   // Remove NULL entries from the left input
   tid_list->GetMutableBits()->Difference(a.GetNullMask());
 
   // Lift-off
+  if (SimplePattern pattern; ParseSimplePattern(b_data[0], &pattern)) {
+    SelectSimplePattern<Op>(a_data, pattern, tid_list);
+    return;
+  }
   tid_list->Filter([&](const uint64_t i) { return Op{}(a_data[i], b_data[0]); });
 }
 
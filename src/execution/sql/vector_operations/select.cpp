@@ -5,6 +5,7 @@
 #include "execution/sql/operators/like_operators.h"
 #include "execution/sql/runtime_types.h"
 #include "execution/sql/tuple_id_list.h"
+#include "execution/sql/vector_operations/string_kernels.h"
 #include "execution/sql/vector_operations/vector_operations.h"
 #include "spdlog/fmt/fmt.h"
 
@@ -99,6 +100,16 @@ void TemplatedSelectOperationVectorConstant(const exec::ExecutionSettings &exec_
   // Remove all NULL entries from left input. Right constant is guaranteed non-NULL by this point.
   tid_list->GetMutableBits()->Difference(left.GetNullMask());
 
+  // Strings equal to the constant have its size and inline prefix. Checking those for the whole
+  // vector first leaves few strings to compare in full, and none if the prefix holds all of it.
+  if constexpr (std::is_same_v<Op, Equal<storage::VarlenEntry>>) {  // NOLINT
+    const std::string_view str(reinterpret_cast<const char *>(constant.Content()), constant.Size());
+    StringKernels::SelectPrefixCandidates(left_data, str, true, tid_list);
+    if (constant.Size() <= storage::VarlenEntry::PrefixSize()) {
+      return;
+    }
+  }
+
   // Filter
   tid_list->Filter([&](uint64_t i) { return Op{}(left_data[i], constant); });
 }
@@ -129,9 +140,34 @@ void TemplatedSelectOperationVectorVector(const exec::ExecutionSettings &exec_se
   tid_list->Filter([&](uint64_t i) { return Op{}(left_data[i], right_data[i]); });
 }
 
+// A dictionary-encoded vector is compared with a constant once for every distinct value. Returns false if the
+// comparison must be done element-wise instead.
+template <typename Op>
+bool TemplatedSelectDictionaryConstant(const Vector &left, const Vector &right, TupleIdList *tid_list) {
+  if (!left.IsDictionaryEncoded()) return false;
+
+  // If the scalar constant is NULL, all comparisons are NULL.
+  if (right.IsNull(0)) {
+    tid_list->Clear();
+    return true;
+  }
+
+  const auto &constant = *reinterpret_cast<const storage::VarlenEntry *>(right.GetData());
+  return VectorOps::SelectDictionary(
+      left, [&](const storage::VarlenEntry &value) { return Op{}(value, constant); }, tid_list);
+}
+
 template <typename T, template <typename> typename Op>
 void TemplatedSelectOperation(const exec::ExecutionSettings &exec_settings, const Vector &left, const Vector &right,
                               TupleIdList *tid_list) {
+  if constexpr (std::is_same_v<T, storage::VarlenEntry>) {  // NOLINT
+    if (right.IsConstant() && TemplatedSelectDictionaryConstant<Op<T>>(left, right, tid_list)) return;
+    // NOLINTNEXTLINE re-arrange arguments
+    if (left.IsConstant() && TemplatedSelectDictionaryConstant<typename Op<T>::SymmetricOp>(right, left, tid_list)) {
+      return;
+    }
+  }
+
   if (right.IsConstant()) {
     TemplatedSelectOperationVectorConstant<T, Op<T>>(exec_settings, left, right, tid_list);
   } else if (left.IsConstant()) {
@@ -0,0 +1,97 @@
+#include "execution/sql/vector_operations/string_kernels.h"
+
+#include <immintrin.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/constants.h"
+#include "execution/sql/tuple_id_list.h"
+#include "execution/util/bit_util.h"
+
+namespace noisepage::execution::sql {
+
+void StringKernels::SelectPrefixCandidates(const storage::VarlenEntry *strings, const std::string_view prefix,
+                                           const bool exact_size, TupleIdList *tid_list) {
+  // The inline prefix is compared as one 32-bit word, masked to the bytes the prefix provides.
+  // Inline prefixes of strings shorter than the word are zero-padded.
+  const auto size = static_cast<uint32_t>(prefix.size());
+  const auto prefix_len = std::min(size, storage::VarlenEntry::PrefixSize());
+  uint32_t prefix_word = 0;
+  std::memcpy(&prefix_word, prefix.data(), prefix_len);
+  const uint32_t prefix_mask = prefix_len == sizeof(uint32_t) ? ~0u : (1u << (prefix_len * 8)) - 1;
+
+  auto matches = [&](const storage::VarlenEntry &str) {
+    uint32_t str_prefix;
+    std::memcpy(&str_prefix, str.Prefix(), sizeof(uint32_t));
+    return (exact_size ? str.Size() == size : str.Size() >= size) && (str_prefix & prefix_mask) == prefix_word;
+  };
+
+  // A VarlenEntry is four 32-bit words: the size, whose sign bit is the reclaim flag, the inline
+  // prefix and the content pointer. Eight entries are gathered and compared at a time.
+  const auto *entry_words = reinterpret_cast<const int32_t *>(strings);
+  const __m256i offsets = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+  const __m256i size_bits = _mm256_set1_epi32(INT32_MAX);
+  const __m256i sizes_wanted = _mm256_set1_epi32(static_cast<int32_t>(size));
+  const __m256i prefix_bits = _mm256_set1_epi32(static_cast<int32_t>(prefix_mask));
+  const __m256i prefixes_wanted = _mm256_set1_epi32(static_cast<int32_t>(prefix_word));
+  auto match_eight = [&](const uint32_t i) {
+    const __m256i sizes = _mm256_and_si256(_mm256_i32gather_epi32(entry_words + 4 * i, offsets, 4), size_bits);
+    const __m256i prefixes = _mm256_and_si256(_mm256_i32gather_epi32(entry_words + 4 * i + 1, offsets, 4), prefix_bits);
+    const __m256i prefix_ok = _mm256_cmpeq_epi32(prefixes, prefixes_wanted);
+    const __m256i ok = exact_size ? _mm256_and_si256(_mm256_cmpeq_epi32(sizes, sizes_wanted), prefix_ok)
+                                  : _mm256_andnot_si256(_mm256_cmpgt_epi32(sizes_wanted, sizes), prefix_ok);
+    return static_cast<uint64_t>(_mm256_movemask_ps(_mm256_castsi256_ps(ok)));
+  };
+
+  // Words of the TID list with no TIDs left are skipped. Unselected entries are compared too, but
+  // only the inline parts of entries are read, so garbage in them is harmless.
+  TupleIdList::BitVectorType *bits = tid_list->GetMutableBits();
+  constexpr uint32_t word_size = sizeof(uint64_t) * common::Constants::K_BITS_PER_BYTE;
+  const uint32_t num_full_words = bits->GetNumBits() / word_size;
+  for (uint32_t w = 0; w < num_full_words; w++) {
+    const uint64_t word = bits->GetWord(w);
+    if (word == 0) continue;
+    uint64_t word_matches = 0;
+    for (uint32_t j = 0; j < word_size; j += 8) {
+      word_matches |= match_eight(w * word_size + j) << j;
+    }
+    bits->SetWord(w, word & word_matches);
+  }
+
+  // Tail
+  for (uint32_t i = num_full_words * word_size; i < bits->GetNumBits(); i++) {
+    if (bits->Test(i) && !matches(strings[i])) {
+      bits->Unset(i);
+    }
+  }
+}
+
+bool StringKernels::Contains(const std::string_view haystack, const std::string_view needle) {
+  const std::size_t n = haystack.size(), k = needle.size();
+  if (k == 0) return true;
+  if (k > n) return false;
+
+  // Compare the first and the last byte of the needle at 32 candidate positions at a time. Only
+  // where both match is the rest of the needle compared.
+  const char *const str = haystack.data();
+  const __m256i first = _mm256_set1_epi8(needle[0]);
+  const __m256i last = _mm256_set1_epi8(needle[k - 1]);
+  std::size_t i = 0;
+  for (; i + k - 1 + 32 <= n; i += 32) {
+    const __m256i block_first = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(str + i));
+    const __m256i block_last = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(str + i + k - 1));
+    const __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(first, block_first), _mm256_cmpeq_epi8(last, block_last));
+    for (auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq)); mask != 0; mask &= mask - 1) {
+      const auto pos = i + util::BitUtil::CountTrailingZeros(mask);
+      if (k <= 2 || std::memcmp(str + pos + 1, needle.data() + 1, k - 2) == 0) {
+        return true;
+      }
+    }
+  }
+
+  // Tail
+  return haystack.substr(i).find(needle) != std::string_view::npos;
+}
+
+}  // namespace noisepage::execution::sql
@@ -153,8 +153,13 @@ void VectorProjection::ProjectColumns(const std::vector<uint32_t> &cols, VectorP
 
 void VectorProjection::Hash(const std::vector<uint32_t> &cols, Vector *result) const {
   NOISEPAGE_ASSERT(!cols.empty(), "Must provide at least one column to hash.");
-  VectorOps::Hash(*GetColumn(cols[0]), result);
-  for (uint32_t i = 1; i < cols.size(); i++) {
+  if (cols.size() == 1) {
+    VectorOps::Hash(*GetColumn(cols[0]), result);
+    return;
+  }
+  // The first two columns are hashed together in one pass
+  VectorOps::Hash(*GetColumn(cols[0]), *GetColumn(cols[1]), result);
+  for (uint32_t i = 2; i < cols.size(); i++) {
     VectorOps::HashCombine(*GetColumn(cols[i]), result);
   }
 }
@@ -93,6 +93,18 @@ void VectorUtil::SelectionVectorToByteVector(const sel_t *sel_vector, const uint
   }
 }
 
+void VectorUtil::SelectionVectorToBitVector(const sel_t *sel_vector, const uint32_t num_elems, uint64_t *bit_vector) {
+  uint32_t i = 0;
+  while (i < num_elems) {
+    const uint32_t word_idx = sel_vector[i] / 64;
+    uint64_t word = 0;
+    for (; i < num_elems && sel_vector[i] / 64 == word_idx; i++) {
+      word |= uint64_t{1} << (sel_vector[i] % 64);
+    }
+    bit_vector[word_idx] |= word;
+  }
+}
+
 // TODO(pmenon): Consider splitting into dense and sparse implementations.
 uint32_t VectorUtil::ByteVectorToSelectionVector(const uint8_t *byte_vector, const uint32_t num_bytes,
                                                  sel_t *sel_vector) {
@@ -215,20 +227,24 @@ uint32_t VectorUtil::BitVectorToSelectionVectorDenseAvX2(const uint64_t *bit_vec
   // Selection vector size
   uint32_t k = 0;
 
-  const uint32_t num_words = common::MathUtil::DivRoundUp(num_bits, 64);
-  for (uint32_t i = 0; i < num_words; i++) {
-    uint64_t word = bit_vector[i];
-    for (uint32_t j = 0; j < 8; j++) {
-      const auto mask = static_cast<uint8_t>(word);
-      word >>= 8u;
-      const __m128i match_pos_scaled =
-          _mm_loadl_epi64(reinterpret_cast<const __m128i *>(&simd::K8_BIT_MATCH_LUT[mask]));
-      const __m128i match_pos = _mm_cvtepi8_epi16(match_pos_scaled);
-      const __m128i pos_vec = _mm_add_epi16(idx, match_pos);
-      idx = _mm_add_epi16(idx, eight);
-      _mm_storeu_si128(reinterpret_cast<__m128i *>(sel_vector + k), pos_vec);
-      k += BitUtil::CountPopulation(static_cast<uint32_t>(mask));
-    }
+  // Every byte of bits stores eight positions from k on, of which only the selected ones are kept. Since k is at most
+  // the position of the byte, the stores stay within num_bits as long as the byte is whole.
+  const auto *bytes = reinterpret_cast<const uint8_t *>(bit_vector);
+  const uint32_t num_whole_bytes = num_bits / 8;
+  for (uint32_t i = 0; i < num_whole_bytes; i++) {
+    const uint8_t mask = bytes[i];
+    const __m128i match_pos_scaled = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(&simd::K8_BIT_MATCH_LUT[mask]));
+    const __m128i match_pos = _mm_cvtepi8_epi16(match_pos_scaled);
+    const __m128i pos_vec = _mm_add_epi16(idx, match_pos);
+    idx = _mm_add_epi16(idx, eight);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(sel_vector + k), pos_vec);
+    k += BitUtil::CountPopulation(static_cast<uint32_t>(mask));
+  }
+
+  // The bits of a last partial byte are extracted one at a time
+  for (uint32_t i = num_whole_bytes * 8; i < num_bits; i++) {
+    sel_vector[k] = i;
+    k += static_cast<uint32_t>((bit_vector[i / 64] >> (i % 64)) & 1u);
   }
 
   return k;
@@ -252,7 +268,7 @@ uint32_t VectorUtil::BitVectorToSelectionVectorDenseAVX512(const uint64_t *bit_v
     _mm512_mask_compressstoreu_epi16(sel_vector + k, mask, indexes);
 
     // Bump indexes
-    _mm512_add_epi16(indexes, _32);
+    indexes = _mm512_add_epi16(indexes, _32);
     k += BitUtil::CountPopulation(mask);
 
     // Second word
@@ -260,7 +276,7 @@ uint32_t VectorUtil::BitVectorToSelectionVectorDenseAVX512(const uint64_t *bit_v
     _mm512_mask_compressstoreu_epi16(sel_vector + k, mask, indexes);
 
     // Bump indexes again
-    _mm512_add_epi16(indexes, _32);
+    indexes = _mm512_add_epi16(indexes, _32);
     k += BitUtil::CountPopulation(mask);
   }
 
@@ -296,11 +312,11 @@ uint32_t VectorUtil::BitVectorToSelectionVector(const uint64_t *bit_vector, cons
     count += util::BitUtil::CountPopulation(bit_vector[i]);
   }
 
-  // TODO(pmenon): Use settings
-  // Sparse is defined as < 15% ones
+  // The callers have no execution settings at hand, so this is the default of the setting
   const float density = static_cast<float>(count) / static_cast<float>(num_bits);
-  return density <= 0.15 ? BitVectorToSelectionVectorSparse(bit_vector, num_bits, sel_vector)
-                         : BitVectorToSelectionVectorDense(bit_vector, num_bits, sel_vector);
+  return density <= common::Constants::BIT_DENSITY_THRESHOLD_FOR_AVX_INDEX_DECODE
+             ? BitVectorToSelectionVectorSparse(bit_vector, num_bits, sel_vector)
+             : BitVectorToSelectionVectorDense(bit_vector, num_bits, sel_vector);
 }
 
 }  // namespace noisepage::execution::util
@@ -291,11 +291,20 @@ void BytecodeEmitter::EmitTableIterInit(Bytecode bytecode, LocalVar iter, LocalV
   EmitAll(bytecode, iter, exec_ctx, table_oid, col_oids, num_oids);
 }
 
+void BytecodeEmitter::EmitVectorProjectionInit(LocalVar vector_projection, LocalVar col_types, uint32_t num_cols) {
+  EmitAll(Bytecode::VectorProjectionInit, vector_projection, col_types, num_cols);
+}
+
 void BytecodeEmitter::EmitParallelTableScan(LocalVar table_oid, LocalVar col_oids, uint32_t num_oids,
                                             LocalVar query_state, LocalVar exec_ctx, FunctionId scan_fn) {
   EmitAll(Bytecode::ParallelScanTable, table_oid, col_oids, num_oids, query_state, exec_ctx, scan_fn);
 }
 
+void BytecodeEmitter::EmitParallelIndexScan(LocalVar iter, LocalVar scan_type, LocalVar query_state,
+                                            FunctionId scan_fn) {
+  EmitAll(Bytecode::ParallelScanIndex, iter, scan_type, query_state, scan_fn);
+}
+
 void BytecodeEmitter::EmitRegisterHook(LocalVar exec_ctx, LocalVar hook_idx, FunctionId hook_fn) {
   EmitAll(Bytecode::ExecutionContextRegisterHook, exec_ctx, hook_idx, hook_fn);
 }
@@ -308,6 +317,10 @@ void BytecodeEmitter::EmitVPISet(Bytecode bytecode, LocalVar vpi, LocalVar input
   EmitAll(bytecode, vpi, input, col_idx);
 }
 
+void BytecodeEmitter::EmitAggAdvanceVector(Bytecode bytecode, LocalVar agg, LocalVar vpi, uint32_t col_idx) {
+  EmitAll(bytecode, agg, vpi, col_idx);
+}
+
 void BytecodeEmitter::EmitFilterManagerInsertFilter(LocalVar filter_manager, FunctionId func) {
   EmitAll(Bytecode::FilterManagerInsertFilter, filter_manager, func);
 }
@@ -336,11 +349,20 @@ void BytecodeEmitter::EmitAggHashTableParallelPartitionedScan(LocalVar agg_ht, L
   EmitAll(Bytecode::AggregationHashTableParallelPartitionedScan, agg_ht, context, tls, scan_part_fn);
 }
 
+void BytecodeEmitter::EmitJoinHashTableProcessSpilled(LocalVar join_ht, LocalVar query_state, LocalVar pipeline_state,
+                                                      FunctionId probe_fn) {
+  EmitAll(Bytecode::JoinHashTableProcessSpilled, join_ht, query_state, pipeline_state, probe_fn);
+}
+
 void BytecodeEmitter::EmitSorterInit(Bytecode bytecode, LocalVar sorter, LocalVar exec_ctx, FunctionId cmp_fn,
                                      LocalVar tuple_size) {
   EmitAll(bytecode, sorter, exec_ctx, cmp_fn, tuple_size);
 }
 
+void BytecodeEmitter::EmitSorterSetNormalizedKey(LocalVar sorter, FunctionId key_fn) {
+  EmitAll(Bytecode::SorterSetNormalizedKey, sorter, key_fn);
+}
+
 #if 0
 void BytecodeEmitter::EmitCSVReaderInit(LocalVar reader, LocalVar file_name, uint32_t file_name_len) {
   EmitAll(Bytecode::CSVReaderInit, reader, file_name, file_name_len);
@@ -10,9 +10,11 @@
 #include "execution/ast/builtins.h"
 #include "execution/ast/context.h"
 #include "execution/ast/type.h"
+#include "execution/sql/runtime_types.h"
 #include "execution/sql/sql_def.h"
 #include "execution/vm/bytecode_label.h"
 #include "execution/vm/bytecode_module.h"
+#include "execution/vm/bytecode_optimizer.h"
 #include "execution/vm/control_flow_builders.h"
 #include "loggers/execution_logger.h"
 #include "spdlog/fmt/fmt.h"
@@ -274,6 +276,8 @@ void BytecodeGenerator::VisitImplicitCastExpr(ast::ImplicitCastExpr *node) {
         if (!fits_in_int) {
           bytecode = Bytecode::InitInteger64;
         }
+      } else if (arg->GetType()->IsSpecificBuiltin(ast::BuiltinType::Int64)) {
+        bytecode = Bytecode::InitInteger64;
       }
       GetEmitter()->Emit(bytecode, dest, input);
       GetExecutionResult()->SetDestination(dest);
@@ -533,6 +537,8 @@ void BytecodeGenerator::VisitSqlConversionCall(ast::CallExpr *call, ast::Builtin
         if (!fits_in_int) {
           bytecode = Bytecode::InitInteger64;
         }
+      } else if (arg->GetType()->IsSpecificBuiltin(ast::BuiltinType::Int64)) {
+        bytecode = Bytecode::InitInteger64;
       }
       auto input = VisitExpressionForRValue(arg);
       GetEmitter()->Emit(bytecode, dest, input);
@@ -544,6 +550,9 @@ void BytecodeGenerator::VisitSqlConversionCall(ast::CallExpr *call, ast::Builtin
       break;
     }
     case ast::Builtin::DateToSql: {
+      if (EmitDateLiteral(call, dest)) {
+        break;
+      }
       auto year = VisitExpressionForRValue(call->Arguments()[0]);
       auto month = VisitExpressionForRValue(call->Arguments()[1]);
       auto day = VisitExpressionForRValue(call->Arguments()[2]);
@@ -627,6 +636,26 @@ void BytecodeGenerator::VisitNullValueCall(ast::CallExpr *call, UNUSED_ATTRIBUTE
   }
 }
 
+bool BytecodeGenerator::EmitDateLiteral(ast::CallExpr *call, LocalVar dest) {
+  const auto &args = call->Arguments();
+  if (!args[0]->IsIntegerLiteral() || !args[1]->IsIntegerLiteral() || !args[2]->IsIntegerLiteral()) {
+    return false;
+  }
+  sql::Date date;
+  try {
+    date = sql::Date::FromYMD(args[0]->As<ast::LitExpr>()->Int64Val(), args[1]->As<ast::LitExpr>()->Int64Val(),
+                              args[2]->As<ast::LitExpr>()->Int64Val());
+  } catch (const ConversionException &) {
+    // Leave invalid dates to InitDate, which fails when the query runs and not when it is compiled
+    return false;
+  }
+  LocalVar julian_day =
+      GetCurrentFunction()->NewLocal(ast::BuiltinType::Get(call->GetType()->GetContext(), ast::BuiltinType::Int32));
+  GetEmitter()->EmitAssignImm4(julian_day, date.ToNative());
+  GetEmitter()->Emit(Bytecode::InitDateFromJulianDay, dest, julian_day.ValueOf());
+  return true;
+}
+
 void BytecodeGenerator::VisitSqlStringLikeCall(ast::CallExpr *call) {
   auto dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
   auto input = VisitExpressionForSQLValue(call->Arguments()[0]);
@@ -692,6 +721,34 @@ void BytecodeGenerator::VisitBuiltinTableIterCall(ast::CallExpr *call, ast::Buil
       GetEmitter()->Emit(Bytecode::TableVectorIteratorFree, iter);
       break;
     }
+    case ast::Builtin::TableIterFilterBlocks: {
+      LocalVar col_idx = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar min = VisitExpressionForRValue(call->Arguments()[2]);
+      LocalVar max = VisitExpressionForRValue(call->Arguments()[3]);
+      GetEmitter()->Emit(Bytecode::TableVectorIteratorFilterBlocks, iter, col_idx, min, max);
+      break;
+    }
+    case ast::Builtin::TableIterFilterBlocksTopK: {
+      LocalVar col_idx = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar sorter = VisitExpressionForRValue(call->Arguments()[2]);
+      LocalVar descending = VisitExpressionForRValue(call->Arguments()[3]);
+      GetEmitter()->Emit(Bytecode::TableVectorIteratorFilterBlocksTopK, iter, col_idx, sorter, descending);
+      break;
+    }
+    case ast::Builtin::TableIterSampleBlocks: {
+      LocalVar num_blocks = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::TableVectorIteratorSampleBlocks, iter, num_blocks);
+      break;
+    }
+    case ast::Builtin::TableIterLateMaterialize: {
+      LocalVar col_idx = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::TableVectorIteratorLateMaterialize, iter, col_idx);
+      break;
+    }
+    case ast::Builtin::TableIterFetchLateColumns: {
+      GetEmitter()->Emit(Bytecode::TableVectorIteratorFetchLateColumns, iter);
+      break;
+    }
     default: {
       UNREACHABLE("Impossible table iteration call");
     }
@@ -914,7 +971,12 @@ void BytecodeGenerator::VisitBuiltinFilterManagerCall(ast::CallExpr *call, ast::
   switch (builtin) {
     case ast::Builtin::FilterManagerInit: {
       LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[1]);
-      GetEmitter()->Emit(Bytecode::FilterManagerInit, filter_manager, exec_ctx);
+      if (call->NumArgs() > 2) {
+        LocalVar context = VisitExpressionForRValue(call->Arguments()[2]);
+        GetEmitter()->Emit(Bytecode::FilterManagerInitWithContext, filter_manager, exec_ctx, context);
+      } else {
+        GetEmitter()->Emit(Bytecode::FilterManagerInit, filter_manager, exec_ctx);
+      }
       break;
     }
     case ast::Builtin::FilterManagerInsertFilter: {
@@ -999,6 +1061,95 @@ void BytecodeGenerator::VisitBuiltinVectorFilterCall(ast::CallExpr *call, ast::B
 #undef GEN_CASE
 }
 
+void BytecodeGenerator::VisitBuiltinVectorProjectionCall(ast::CallExpr *call, ast::Builtin builtin) {
+  LocalVar vector_projection = VisitExpressionForRValue(call->Arguments()[0]);
+
+  switch (builtin) {
+    case ast::Builtin::VectorProjectionInit: {
+      auto *arr_type = call->Arguments()[1]->GetType()->As<ast::ArrayType>();
+      LocalVar col_types = VisitExpressionForLValue(call->Arguments()[1]);
+      GetEmitter()->EmitVectorProjectionInit(vector_projection, col_types,
+                                             static_cast<uint32_t>(arr_type->GetLength()));
+      break;
+    }
+    case ast::Builtin::VectorProjectionExtend: {
+      LocalVar vpi = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::VectorProjectionExtend, vector_projection, vpi);
+      break;
+    }
+    case ast::Builtin::VectorProjectionFree: {
+      GetEmitter()->Emit(Bytecode::VectorProjectionFree, vector_projection);
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible vector projection call");
+    }
+  }
+}
+
+void BytecodeGenerator::VisitBuiltinVectorArithmeticCall(ast::CallExpr *call, ast::Builtin builtin) {
+  LocalVar exec_ctx = VisitExpressionForRValue(call->Arguments()[0]);
+  LocalVar vector_projection = VisitExpressionForRValue(call->Arguments()[1]);
+  LocalVar result_col = VisitExpressionForRValue(call->Arguments()[2]);
+
+  if (builtin == ast::Builtin::VectorCast) {
+    LocalVar col = VisitExpressionForRValue(call->Arguments()[3]);
+    GetEmitter()->Emit(Bytecode::VectorCast, exec_ctx, vector_projection, result_col, col);
+    return;
+  }
+
+  if (builtin == ast::Builtin::VectorDatePart) {
+    LocalVar col = VisitExpressionForRValue(call->Arguments()[3]);
+    LocalVar part = VisitExpressionForRValue(call->Arguments()[4]);
+    GetEmitter()->Emit(Bytecode::VectorDatePart, exec_ctx, vector_projection, result_col, col, part);
+    return;
+  }
+
+  // A constant operand is passed as a SQL value, a column as its index. Commutative operations
+  // take a constant on the left as one on the right.
+  ast::Expr *left = call->Arguments()[3];
+  ast::Expr *right = call->Arguments()[4];
+  const bool left_is_val = !left->GetType()->IsIntegerType();
+  if (left_is_val && builtin == ast::Builtin::VectorSub) {
+    LocalVar left_val = VisitExpressionForSQLValue(left);
+    LocalVar right_col = VisitExpressionForRValue(right);
+    GetEmitter()->Emit(Bytecode::VectorSubFromVal, exec_ctx, vector_projection, result_col, left_val, right_col);
+    return;
+  }
+  if (left_is_val) {
+    std::swap(left, right);
+  }
+
+#define GEN_CASE(BYTECODE)                                                                             \
+  LocalVar left_col = VisitExpressionForRValue(left);                                                  \
+  if (!right->GetType()->IsIntegerType()) {                                                            \
+    LocalVar right_val = VisitExpressionForSQLValue(right);                                            \
+    GetEmitter()->Emit(BYTECODE##Val, exec_ctx, vector_projection, result_col, left_col, right_val);   \
+  } else {                                                                                             \
+    LocalVar right_col = VisitExpressionForRValue(right);                                              \
+    GetEmitter()->Emit(BYTECODE, exec_ctx, vector_projection, result_col, left_col, right_col);        \
+  }
+
+  switch (builtin) {
+    case ast::Builtin::VectorAdd: {
+      GEN_CASE(Bytecode::VectorAdd);
+      break;
+    }
+    case ast::Builtin::VectorSub: {
+      GEN_CASE(Bytecode::VectorSub);
+      break;
+    }
+    case ast::Builtin::VectorMul: {
+      GEN_CASE(Bytecode::VectorMul);
+      break;
+    }
+    default: {
+      UNREACHABLE("Impossible vector arithmetic call");
+    }
+  }
+#undef GEN_CASE
+}
+
 void BytecodeGenerator::VisitBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builtin) {
   switch (builtin) {
     case ast::Builtin::AggHashTableInit: {
@@ -1043,6 +1194,12 @@ void BytecodeGenerator::VisitBuiltinAggHashTableCall(ast::CallExpr *call, ast::B
       GetEmitter()->Emit(Bytecode::AggregationHashTableLinkHashTableEntry, agg_ht, entry);
       break;
     }
+    case ast::Builtin::AggHashTableInternString: {
+      LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar key = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::AggregationHashTableInternStringKey, agg_ht, key);
+      break;
+    }
     case ast::Builtin::AggHashTableLookup: {
       LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
       LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
@@ -1053,6 +1210,28 @@ void BytecodeGenerator::VisitBuiltinAggHashTableCall(ast::CallExpr *call, ast::B
       GetExecutionResult()->SetDestination(dest.ValueOf());
       break;
     }
+    case ast::Builtin::AggHashTableSetDenseDomain: {
+      LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar min_key = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar num_keys = VisitExpressionForRValue(call->Arguments()[2]);
+      GetEmitter()->Emit(Bytecode::AggregationHashTableSetDenseDomain, agg_ht, min_key, num_keys);
+      break;
+    }
+    case ast::Builtin::AggHashTableLookupDense: {
+      LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar key = VisitExpressionForSQLValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::AggregationHashTableLookupDense, dest, agg_ht, key);
+      GetExecutionResult()->SetDestination(dest.ValueOf());
+      break;
+    }
+    case ast::Builtin::AggHashTableInsertDense: {
+      LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar key = VisitExpressionForSQLValue(call->Arguments()[1]);
+      LocalVar payload = VisitExpressionForRValue(call->Arguments()[2]);
+      GetEmitter()->Emit(Bytecode::AggregationHashTableInsertDense, agg_ht, key, payload);
+      break;
+    }
     case ast::Builtin::AggHashTableProcessBatch: {
       LocalVar agg_ht = VisitExpressionForRValue(call->Arguments()[0]);
       LocalVar vpi = VisitExpressionForRValue(call->Arguments()[1]);
@@ -1397,6 +1576,46 @@ void BytecodeGenerator::VisitBuiltinAggregatorCall(ast::CallExpr *call, ast::Bui
       GetEmitter()->Emit(bytecode, agg, input);
       break;
     }
+    case ast::Builtin::AggAdvanceVector: {
+      const auto &args = call->Arguments();
+      const auto agg_kind = args[0]->GetType()->GetPointeeType()->As<ast::BuiltinType>()->GetKind();
+      LocalVar agg = VisitExpressionForRValue(args[0]);
+      LocalVar vpi = VisitExpressionForRValue(args[1]);
+      if (args.size() == 2) {
+        // Every selected tuple counts
+        GetEmitter()->Emit(Bytecode::CountAggregateAdvanceTuples, agg, vpi);
+        break;
+      }
+      Bytecode bytecode;
+      switch (agg_kind) {
+        case ast::BuiltinType::CountAggregate:
+          bytecode = Bytecode::CountAggregateAdvanceVector;
+          break;
+        case ast::BuiltinType::IntegerSumAggregate:
+          bytecode = Bytecode::IntegerSumAggregateAdvanceVector;
+          break;
+        case ast::BuiltinType::IntegerMaxAggregate:
+          bytecode = Bytecode::IntegerMaxAggregateAdvanceVector;
+          break;
+        case ast::BuiltinType::IntegerMinAggregate:
+          bytecode = Bytecode::IntegerMinAggregateAdvanceVector;
+          break;
+        case ast::BuiltinType::RealSumAggregate:
+          bytecode = Bytecode::RealSumAggregateAdvanceVector;
+          break;
+        case ast::BuiltinType::RealMaxAggregate:
+          bytecode = Bytecode::RealMaxAggregateAdvanceVector;
+          break;
+        case ast::BuiltinType::RealMinAggregate:
+          bytecode = Bytecode::RealMinAggregateAdvanceVector;
+          break;
+        default:
+          UNREACHABLE("Impossible aggregate type");
+      }
+      const uint32_t col_idx = args[2]->As<ast::LitExpr>()->Int64Val();
+      GetEmitter()->EmitAggAdvanceVector(bytecode, agg, vpi, col_idx);
+      break;
+    }
     case ast::Builtin::AggMerge: {
       const auto &args = call->Arguments();
       const auto agg_kind = args[0]->GetType()->GetPointeeType()->As<ast::BuiltinType>()->GetKind();
@@ -1469,6 +1688,46 @@ void BytecodeGenerator::VisitBuiltinJoinHashTableCall(ast::CallExpr *call, ast::
       GetEmitter()->Emit(Bytecode::JoinHashTableLookup, join_hash_table, ht_entry_iter, hash);
       break;
     }
+    case ast::Builtin::JoinHashTableEnableSpilling: {
+      LocalVar probe_tuple_size = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::JoinHashTableEnableSpilling, join_hash_table, probe_tuple_size);
+      break;
+    }
+    case ast::Builtin::JoinHashTableIsSpilled: {
+      LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar hash = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::JoinHashTableIsSpilled, dest, join_hash_table, hash);
+      GetExecutionResult()->SetDestination(dest.ValueOf());
+      break;
+    }
+    case ast::Builtin::JoinHashTableEnableRuntimeFilter: {
+      GetEmitter()->Emit(Bytecode::JoinHashTableEnableRuntimeFilter, join_hash_table);
+      break;
+    }
+    case ast::Builtin::JoinHashTableEnableCompactLayout: {
+      GetEmitter()->Emit(Bytecode::JoinHashTableEnableCompactLayout, join_hash_table);
+      break;
+    }
+    case ast::Builtin::JoinHashTableMayContain: {
+      LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar hash = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::JoinHashTableMayContain, dest, join_hash_table, hash);
+      GetExecutionResult()->SetDestination(dest.ValueOf());
+      break;
+    }
+    case ast::Builtin::JoinHashTableSpillProbe: {
+      LocalVar hash = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar probe_tuple = VisitExpressionForRValue(call->Arguments()[2]);
+      GetEmitter()->Emit(Bytecode::JoinHashTableSpillProbe, join_hash_table, hash, probe_tuple);
+      break;
+    }
+    case ast::Builtin::JoinHashTableProcessSpilled: {
+      LocalVar query_state = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar pipeline_state = VisitExpressionForRValue(call->Arguments()[2]);
+      auto probe_fn = LookupFuncIdByName(call->Arguments()[3]->As<ast::IdentifierExpr>()->Name().GetData());
+      GetEmitter()->EmitJoinHashTableProcessSpilled(join_hash_table, query_state, pipeline_state, probe_fn);
+      break;
+    }
     case ast::Builtin::JoinHashTableFree: {
       GetEmitter()->Emit(Bytecode::JoinHashTableFree, join_hash_table);
       break;
@@ -1552,6 +1811,40 @@ void BytecodeGenerator::VisitBuiltinSorterCall(ast::CallExpr *call, ast::Builtin
                                    entry_size);
       break;
     }
+    case ast::Builtin::SorterSetNormalizedKey: {
+      LocalVar sorter = VisitExpressionForRValue(call->Arguments()[0]);
+      const std::string key_func_name = call->Arguments()[1]->As<ast::IdentifierExpr>()->Name().GetData();
+      GetEmitter()->EmitSorterSetNormalizedKey(sorter, LookupFuncIdByName(key_func_name));
+      break;
+    }
+    case ast::Builtin::SorterNormalizeKey: {
+      LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar input = VisitExpressionForSQLValue(call->Arguments()[0]);
+      switch (call->Arguments()[0]->GetType()->As<ast::BuiltinType>()->GetKind()) {
+        case ast::BuiltinType::Integer:
+          GetEmitter()->Emit(Bytecode::SorterNormalizeKeyInt, dest, input);
+          break;
+        case ast::BuiltinType::Boolean:
+          GetEmitter()->Emit(Bytecode::SorterNormalizeKeyBool, dest, input);
+          break;
+        case ast::BuiltinType::Real:
+          GetEmitter()->Emit(Bytecode::SorterNormalizeKeyReal, dest, input);
+          break;
+        case ast::BuiltinType::Date:
+          GetEmitter()->Emit(Bytecode::SorterNormalizeKeyDate, dest, input);
+          break;
+        case ast::BuiltinType::Timestamp:
+          GetEmitter()->Emit(Bytecode::SorterNormalizeKeyTimestamp, dest, input);
+          break;
+        case ast::BuiltinType::StringVal:
+          GetEmitter()->Emit(Bytecode::SorterNormalizeKeyString, dest, input);
+          break;
+        default:
+          UNREACHABLE("Normalizing this type isn't supported!");
+      }
+      GetExecutionResult()->SetDestination(dest.ValueOf());
+      break;
+    }
     case ast::Builtin::SorterGetTupleCount: {
       LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
       LocalVar sorter = VisitExpressionForRValue(call->Arguments()[0]);
@@ -1600,6 +1893,19 @@ void BytecodeGenerator::VisitBuiltinSorterCall(ast::CallExpr *call, ast::Builtin
       GetEmitter()->Emit(Bytecode::SorterSortTopKParallel, sorter, tls, sorter_offset, top_k);
       break;
     }
+    case ast::Builtin::SorterShareTopKBound: {
+      LocalVar sorter = VisitExpressionForRValue(call->Arguments()[0]);
+      LocalVar other = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::SorterShareTopKBound, sorter, other);
+      break;
+    }
+    case ast::Builtin::SorterGetTopKBound: {
+      LocalVar dest = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar sorter = VisitExpressionForRValue(call->Arguments()[0]);
+      GetEmitter()->Emit(Bytecode::SorterGetTopKBound, dest, sorter);
+      GetExecutionResult()->SetDestination(dest.ValueOf());
+      break;
+    }
     case ast::Builtin::SorterFree: {
       LocalVar sorter = VisitExpressionForRValue(call->Arguments()[0]);
       GetEmitter()->Emit(Bytecode::SorterFree, sorter);
@@ -1741,6 +2047,33 @@ void BytecodeGenerator::VisitExecutionContextCall(ast::CallExpr *call, ast::Buil
       GetEmitter()->Emit(Bytecode::ExecutionContextClearHooks, exec_ctx);
       break;
     }
+    case ast::Builtin::ExecutionContextCheckInterrupt: {
+      GetEmitter()->Emit(Bytecode::ExecutionContextCheckInterrupt, exec_ctx);
+      break;
+    }
+    case ast::Builtin::ExecutionContextScaleSampledCount: {
+      LocalVar result = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar count = VisitExpressionForSQLValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::ExecutionContextScaleSampledCount, result, exec_ctx, count);
+      GetExecutionResult()->SetDestination(result);
+      break;
+    }
+    case ast::Builtin::ExecutionContextScaleSampledDistinct: {
+      LocalVar result = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar num_distinct = VisitExpressionForSQLValue(call->Arguments()[1]);
+      LocalVar count = VisitExpressionForSQLValue(call->Arguments()[2]);
+      GetEmitter()->Emit(Bytecode::ExecutionContextScaleSampledDistinct, result, exec_ctx, num_distinct, count);
+      GetExecutionResult()->SetDestination(result);
+      break;
+    }
+    case ast::Builtin::ExecutionContextAnalyzeColumnGroups: {
+      LocalVar result = GetExecutionResult()->GetOrCreateDestination(call->GetType());
+      LocalVar table_oid = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar col_oid = VisitExpressionForRValue(call->Arguments()[2]);
+      GetEmitter()->Emit(Bytecode::ExecutionContextAnalyzeColumnGroups, result, exec_ctx, table_oid, col_oid);
+      GetExecutionResult()->SetDestination(result);
+      break;
+    }
     case ast::Builtin::ExecutionContextInitHooks: {
       auto num_hooks = VisitExpressionForRValue(call->Arguments()[1]);
       GetEmitter()->Emit(Bytecode::ExecutionContextInitHooks, exec_ctx, num_hooks);
@@ -1773,6 +2106,29 @@ void BytecodeGenerator::VisitExecutionContextCall(ast::CallExpr *call, ast::Buil
       GetEmitter()->Emit(Bytecode::ExecutionContextEndPipelineTracker, exec_ctx, query_id, pipeline_id, ouvec);
       break;
     }
+    case ast::Builtin::ExecutionContextStartPipelineProfile: {
+      LocalVar pipeline_id = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::ExecutionContextStartPipelineProfile, exec_ctx, pipeline_id);
+      break;
+    }
+    case ast::Builtin::ExecutionContextEndPipelineProfile: {
+      LocalVar pipeline_id = VisitExpressionForRValue(call->Arguments()[1]);
+      GetEmitter()->Emit(Bytecode::ExecutionContextEndPipelineProfile, exec_ctx, pipeline_id);
+      break;
+    }
+    case ast::Builtin::ExecutionContextRecordOperatorRows: {
+      LocalVar pipeline_id = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar plan_node_id = VisitExpressionForRValue(call->Arguments()[2]);
+      LocalVar num_rows = VisitExpressionForRValue(call->Arguments()[3]);
+      GetEmitter()->Emit(Bytecode::ExecutionContextRecordOperatorRows, exec_ctx, pipeline_id, plan_node_id, num_rows);
+      break;
+    }
+    case ast::Builtin::ExecutionContextCheckCardinality: {
+      LocalVar plan_node_id = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar num_rows = VisitExpressionForRValue(call->Arguments()[2]);
+      GetEmitter()->Emit(Bytecode::ExecutionContextCheckCardinality, exec_ctx, plan_node_id, num_rows);
+      break;
+    }
     case ast::Builtin::ExecOUFeatureVectorInitialize: {
       LocalVar ouvector = VisitExpressionForRValue(call->Arguments()[1]);
       LocalVar pipeline_id = VisitExpressionForRValue(call->Arguments()[2]);
@@ -2704,6 +3060,10 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::ExecutionContextAddRowsAffected:
     case ast::Builtin::ExecutionContextRegisterHook:
     case ast::Builtin::ExecutionContextClearHooks:
+    case ast::Builtin::ExecutionContextCheckInterrupt:
+    case ast::Builtin::ExecutionContextScaleSampledCount:
+    case ast::Builtin::ExecutionContextScaleSampledDistinct:
+    case ast::Builtin::ExecutionContextAnalyzeColumnGroups:
     case ast::Builtin::ExecutionContextInitHooks:
     case ast::Builtin::ExecutionContextGetMemoryPool:
     case ast::Builtin::ExecutionContextGetTLS:
@@ -2712,6 +3072,10 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::ExecutionContextEndResourceTracker:
     case ast::Builtin::ExecutionContextStartPipelineTracker:
     case ast::Builtin::ExecutionContextEndPipelineTracker:
+    case ast::Builtin::ExecutionContextStartPipelineProfile:
+    case ast::Builtin::ExecutionContextEndPipelineProfile:
+    case ast::Builtin::ExecutionContextRecordOperatorRows:
+    case ast::Builtin::ExecutionContextCheckCardinality:
     case ast::Builtin::ExecOUFeatureVectorInitialize: {
       VisitExecutionContextCall(call, builtin);
       break;
@@ -2749,7 +3113,12 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::TableIterAdvance:
     case ast::Builtin::TableIterGetVPINumTuples:
     case ast::Builtin::TableIterGetVPI:
-    case ast::Builtin::TableIterClose: {
+    case ast::Builtin::TableIterClose:
+    case ast::Builtin::TableIterFilterBlocks:
+    case ast::Builtin::TableIterFilterBlocksTopK:
+    case ast::Builtin::TableIterSampleBlocks:
+    case ast::Builtin::TableIterLateMaterialize:
+    case ast::Builtin::TableIterFetchLateColumns: {
       VisitBuiltinTableIterCall(call, builtin);
       break;
     }
@@ -2838,12 +3207,30 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       VisitBuiltinVectorFilterCall(call, builtin);
       break;
     }
+    case ast::Builtin::VectorProjectionInit:
+    case ast::Builtin::VectorProjectionExtend:
+    case ast::Builtin::VectorProjectionFree: {
+      VisitBuiltinVectorProjectionCall(call, builtin);
+      break;
+    }
+    case ast::Builtin::VectorCast:
+    case ast::Builtin::VectorDatePart:
+    case ast::Builtin::VectorAdd:
+    case ast::Builtin::VectorSub:
+    case ast::Builtin::VectorMul: {
+      VisitBuiltinVectorArithmeticCall(call, builtin);
+      break;
+    }
     case ast::Builtin::AggHashTableInit:
     case ast::Builtin::AggHashTableGetTupleCount:
     case ast::Builtin::AggHashTableGetInsertCount:
     case ast::Builtin::AggHashTableInsert:
     case ast::Builtin::AggHashTableLinkEntry:
+    case ast::Builtin::AggHashTableInternString:
     case ast::Builtin::AggHashTableLookup:
+    case ast::Builtin::AggHashTableSetDenseDomain:
+    case ast::Builtin::AggHashTableLookupDense:
+    case ast::Builtin::AggHashTableInsertDense:
     case ast::Builtin::AggHashTableProcessBatch:
     case ast::Builtin::AggHashTableMovePartitions:
     case ast::Builtin::AggHashTableParallelPartitionedScan:
@@ -2869,6 +3256,7 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     }
     case ast::Builtin::AggInit:
     case ast::Builtin::AggAdvance:
+    case ast::Builtin::AggAdvanceVector:
     case ast::Builtin::AggMerge:
     case ast::Builtin::AggReset:
     case ast::Builtin::AggResult:
@@ -2882,6 +3270,13 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::JoinHashTableBuild:
     case ast::Builtin::JoinHashTableBuildParallel:
     case ast::Builtin::JoinHashTableLookup:
+    case ast::Builtin::JoinHashTableEnableSpilling:
+    case ast::Builtin::JoinHashTableIsSpilled:
+    case ast::Builtin::JoinHashTableSpillProbe:
+    case ast::Builtin::JoinHashTableEnableRuntimeFilter:
+    case ast::Builtin::JoinHashTableEnableCompactLayout:
+    case ast::Builtin::JoinHashTableMayContain:
+    case ast::Builtin::JoinHashTableProcessSpilled:
     case ast::Builtin::JoinHashTableFree: {
       VisitBuiltinJoinHashTableCall(call, builtin);
       break;
@@ -2900,10 +3295,14 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
       break;
     }
     case ast::Builtin::SorterInit:
+    case ast::Builtin::SorterSetNormalizedKey:
+    case ast::Builtin::SorterNormalizeKey:
     case ast::Builtin::SorterGetTupleCount:
     case ast::Builtin::SorterInsert:
     case ast::Builtin::SorterInsertTopK:
     case ast::Builtin::SorterInsertTopKFinish:
+    case ast::Builtin::SorterShareTopKBound:
+    case ast::Builtin::SorterGetTopKBound:
     case ast::Builtin::SorterSort:
     case ast::Builtin::SorterSortParallel:
     case ast::Builtin::SorterSortTopKParallel:
@@ -2943,6 +3342,7 @@ void BytecodeGenerator::VisitBuiltinCallExpr(ast::CallExpr *call) {
     case ast::Builtin::IndexIteratorScanAscending:
     case ast::Builtin::IndexIteratorScanDescending:
     case ast::Builtin::IndexIteratorScanLimitDescending:
+    case ast::Builtin::IndexIteratorParallel:
     case ast::Builtin::IndexIteratorAdvance:
     case ast::Builtin::IndexIteratorFree:
     case ast::Builtin::IndexIteratorGetPR:
@@ -3197,6 +3597,14 @@ void BytecodeGenerator::VisitBuiltinIndexIteratorCall(ast::CallExpr *call, ast::
       GetEmitter()->Emit(Bytecode::IndexIteratorScanLimitDescending, iterator, limit);
       break;
     }
+    case ast::Builtin::IndexIteratorParallel: {
+      auto asc_type = VisitExpressionForRValue(call->Arguments()[1]);
+      LocalVar query_state = VisitExpressionForRValue(call->Arguments()[2]);
+      // The scan function as an identifier.
+      const auto scan_fn_name = call->Arguments()[3]->As<ast::IdentifierExpr>()->Name();
+      GetEmitter()->EmitParallelIndexScan(iterator, asc_type, query_state, LookupFuncIdByName(scan_fn_name.GetData()));
+      break;
+    }
     case ast::Builtin::IndexIteratorAdvance: {
       LocalVar cond = GetExecutionResult()->GetOrCreateDestination(ast::BuiltinType::Get(ctx, ast::BuiltinType::Bool));
       GetEmitter()->Emit(Bytecode::IndexIteratorAdvance, cond, iterator);
@@ -3921,6 +4329,9 @@ std::unique_ptr<BytecodeModule> BytecodeGenerator::Compile(ast::AstNode *root, c
   BytecodeGenerator generator{};
   generator.Visit(root);
 
+  // Clean up the bytecode, since the interpreter doesn't run it through LLVM's optimizer
+  BytecodeOptimizer::Optimize(&generator.code_, &generator.functions_);
+
   // Create the bytecode module. Note that we move the bytecode and functions
   // array from the generator into the module.
   return std::make_unique<BytecodeModule>(name, std::move(generator.code_), std::move(generator.data_),
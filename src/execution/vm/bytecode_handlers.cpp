@@ -1,7 +1,10 @@
 #include "execution/vm/bytecode_handlers.h"
 
+#include <vector>
+
 #include "catalog/catalog_defs.h"
 #include "execution/exec/execution_context.h"
+#include "execution/sql/column_group_analyzer.h"
 #include "execution/sql/index_iterator.h"
 #include "execution/sql/storage_interface.h"
 #include "execution/sql/vector_projection_iterator.h"
@@ -30,6 +33,35 @@ void OpTableVectorIteratorFree(noisepage::execution::sql::TableVectorIterator *i
   iter->~TableVectorIterator();
 }
 
+void OpTableVectorIteratorFilterBlocks(noisepage::execution::sql::TableVectorIterator *iter, uint32_t col_idx,
+                                       int64_t min, int64_t max) {
+  NOISEPAGE_ASSERT(iter != nullptr, "NULL iterator given to filter");
+  iter->FilterBlocks(col_idx, min, max);
+}
+
+void OpTableVectorIteratorFilterBlocksTopK(noisepage::execution::sql::TableVectorIterator *iter, uint32_t col_idx,
+                                           const noisepage::execution::sql::Sorter *sorter, bool descending) {
+  NOISEPAGE_ASSERT(iter != nullptr, "NULL iterator given to filter");
+  iter->FilterBlocksTopK(col_idx, sorter, descending);
+}
+
+void OpTableVectorIteratorSampleBlocks(noisepage::execution::sql::TableVectorIterator *iter, uint32_t num_blocks) {
+  NOISEPAGE_ASSERT(iter != nullptr, "NULL iterator given to sample");
+  iter->SampleBlocks(num_blocks);
+}
+
+void OpTableVectorIteratorLateMaterialize(noisepage::execution::sql::TableVectorIterator *iter, uint32_t col_idx) {
+  NOISEPAGE_ASSERT(iter != nullptr, "NULL iterator given to materialize late");
+  iter->LateMaterialize(col_idx);
+}
+
+void OpExecutionContextAnalyzeColumnGroups(noisepage::execution::sql::StringVal *result,
+                                           noisepage::execution::exec::ExecutionContext *exec_ctx,
+                                           uint32_t table_oid, uint32_t col_oid) {
+  *result = noisepage::execution::sql::ColumnGroupAnalyzer::Analyze(
+      exec_ctx, noisepage::catalog::table_oid_t(table_oid), noisepage::catalog::col_oid_t(col_oid));
+}
+
 void OpVPIInit(noisepage::execution::sql::VectorProjectionIterator *vpi,
                noisepage::execution::sql::VectorProjection *vp) {
   new (vpi) noisepage::execution::sql::VectorProjectionIterator(vp);
@@ -48,8 +80,16 @@ void OpVPIFree(noisepage::execution::sql::VectorProjectionIterator *vpi) { vpi->
 // ---------------------------------------------------------
 
 void OpFilterManagerInit(noisepage::execution::sql::FilterManager *filter_manager,
-                         const noisepage::execution::exec::ExecutionSettings &exec_settings) {
-  new (filter_manager) noisepage::execution::sql::FilterManager(exec_settings);
+                         noisepage::execution::exec::ExecutionContext *exec_ctx) {
+  // Terms get the query state as their context, to reach query-wide state such as runtime filters
+  new (filter_manager) noisepage::execution::sql::FilterManager(
+      exec_ctx->GetExecutionSettings(), true, exec_ctx->GetQueryState(), exec_ctx->GetFilterOrderCache());
+}
+
+void OpFilterManagerInitWithContext(noisepage::execution::sql::FilterManager *filter_manager,
+                                    noisepage::execution::exec::ExecutionContext *exec_ctx, void *context) {
+  new (filter_manager) noisepage::execution::sql::FilterManager(exec_ctx->GetExecutionSettings(), true, context,
+                                                                exec_ctx->GetFilterOrderCache());
 }
 
 void OpFilterManagerStartNewClause(noisepage::execution::sql::FilterManager *filter_manager) {
@@ -69,6 +109,25 @@ void OpFilterManagerRunFilters(noisepage::execution::sql::FilterManager *filter_
 
 void OpFilterManagerFree(noisepage::execution::sql::FilterManager *filter_manager) { filter_manager->~FilterManager(); }
 
+// ---------------------------------------------------------
+// Vector Expression Executor
+// ---------------------------------------------------------
+
+void OpVectorProjectionInit(noisepage::execution::sql::VectorProjection *vector_projection, const uint32_t *col_types,
+                            uint32_t num_cols) {
+  std::vector<noisepage::execution::sql::TypeId> types;
+  types.reserve(num_cols);
+  for (uint32_t i = 0; i < num_cols; i++) {
+    types.push_back(static_cast<noisepage::execution::sql::TypeId>(col_types[i]));
+  }
+  new (vector_projection) noisepage::execution::sql::VectorProjection();
+  vector_projection->Initialize(types);
+}
+
+void OpVectorProjectionFree(noisepage::execution::sql::VectorProjection *vector_projection) {
+  vector_projection->~VectorProjection();
+}
+
 // ---------------------------------------------------------
 // Join Hash Table
 // ---------------------------------------------------------
@@ -87,6 +146,30 @@ void OpJoinHashTableBuildParallel(noisepage::execution::sql::JoinHashTable *join
   join_hash_table->MergeParallel(thread_state_container, jht_offset);
 }
 
+void OpJoinHashTableEnableSpilling(noisepage::execution::sql::JoinHashTable *join_hash_table,
+                                   uint32_t probe_tuple_size) {
+  join_hash_table->EnableSpilling(probe_tuple_size);
+}
+
+void OpJoinHashTableEnableRuntimeFilter(noisepage::execution::sql::JoinHashTable *join_hash_table) {
+  join_hash_table->EnableRuntimeFilter();
+}
+
+void OpJoinHashTableEnableCompactLayout(noisepage::execution::sql::JoinHashTable *join_hash_table) {
+  join_hash_table->EnableCompactLayout();
+}
+
+void OpJoinHashTableSpillProbe(noisepage::execution::sql::JoinHashTable *join_hash_table, noisepage::hash_t hash_val,
+                               const noisepage::byte *probe_tuple) {
+  join_hash_table->SpillProbeTuple(hash_val, probe_tuple);
+}
+
+void OpJoinHashTableProcessSpilled(noisepage::execution::sql::JoinHashTable *join_hash_table, void *query_state,
+                                   void *pipeline_state,
+                                   noisepage::execution::sql::JoinHashTable::SpilledProbeFn probe_fn) {
+  join_hash_table->ProcessSpilledPartitions(query_state, pipeline_state, probe_fn);
+}
+
 void OpJoinHashTableFree(noisepage::execution::sql::JoinHashTable *join_hash_table) {
   join_hash_table->~JoinHashTable();
 }
@@ -121,6 +204,11 @@ void OpAggregationHashTableGetInsertCount(uint32_t *result,
   *result = agg_hash_table->GetInsertCount();
 }
 
+void OpAggregationHashTableSetDenseDomain(noisepage::execution::sql::AggregationHashTable *const agg_hash_table,
+                                          const int64_t min_key, const uint32_t num_keys) {
+  agg_hash_table->SetDenseDomain(min_key, num_keys);
+}
+
 void OpAggregationHashTableFree(noisepage::execution::sql::AggregationHashTable *const agg_hash_table) {
   agg_hash_table->~AggregationHashTable();
 }
@@ -303,6 +391,27 @@ void OpExecutionContextEndPipelineTracker(noisepage::execution::exec::ExecutionC
   exec_ctx->EndPipelineTracker(query_id, pipeline_id, ouvec);
 }
 
+void OpExecutionContextStartPipelineProfile(noisepage::execution::exec::ExecutionContext *const exec_ctx,
+                                            noisepage::execution::pipeline_id_t pipeline_id) {
+  exec_ctx->StartPipelineProfile(pipeline_id);
+}
+
+void OpExecutionContextEndPipelineProfile(noisepage::execution::exec::ExecutionContext *const exec_ctx,
+                                          noisepage::execution::pipeline_id_t pipeline_id) {
+  exec_ctx->EndPipelineProfile(pipeline_id);
+}
+
+void OpExecutionContextRecordOperatorRows(noisepage::execution::exec::ExecutionContext *const exec_ctx,
+                                          noisepage::execution::pipeline_id_t pipeline_id,
+                                          noisepage::planner::plan_node_id_t plan_node_id, uint64_t num_rows) {
+  exec_ctx->RecordOperatorRows(pipeline_id, plan_node_id, num_rows);
+}
+
+void OpExecutionContextCheckCardinality(noisepage::execution::exec::ExecutionContext *const exec_ctx,
+                                        noisepage::planner::plan_node_id_t plan_node_id, uint32_t num_rows) {
+  exec_ctx->CheckCardinality(plan_node_id, num_rows);
+}
+
 void OpExecOUFeatureVectorRecordFeature(
     noisepage::selfdriving::ExecOUFeatureVector *ouvec, noisepage::execution::pipeline_id_t pipeline_id,
     noisepage::execution::feature_id_t feature_id,
@@ -0,0 +1,633 @@
+#include "execution/vm/bytecode_optimizer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "execution/ast/type.h"
+#include "execution/vm/bytecode_iterator.h"
+#include "execution/vm/bytecodes.h"
+
+namespace noisepage::execution::vm {
+
+namespace {
+
+// Every pass can expose more work for the others, so they're repeated until nothing changes, but at most this often
+constexpr uint32_t K_MAX_ROUNDS = 4;
+
+// Jumps are threaded through at most this many unconditional jumps, which also stops at loops of jumps
+constexpr uint32_t K_MAX_JUMP_THREADING_HOPS = 8;
+
+// How an instruction treats the locals it refers to
+enum class OpKind : uint8_t {
+  // An arbitrary bytecode handler, which may read and write all memory it gets a pointer to
+  Opaque,
+  // Writes its first operand and reads the values of the others, e.g., arithmetic and assignments
+  PureValue,
+  // Writes its first operand and reads the memory the others point to, e.g., dereferences and VPI reads
+  PureLoad,
+  // A jump, which only reads its condition
+  Jump,
+};
+
+OpKind GetOpKind(const Bytecode bytecode) {
+  // Primitive arithmetic and comparisons come first in the bytecode list
+  if (Bytecodes::ToByte(bytecode) <= Bytecodes::ToByte(Bytecode::Not)) return OpKind::PureValue;
+  if (Bytecodes::ToByte(bytecode) >= Bytecodes::ToByte(Bytecode::VPIGetBool) &&
+      Bytecodes::ToByte(bytecode) <= Bytecodes::ToByte(Bytecode::VPIGetStringNull)) {
+    return OpKind::PureLoad;
+  }
+  switch (bytecode) {
+    case Bytecode::Assign1:
+    case Bytecode::Assign2:
+    case Bytecode::Assign4:
+    case Bytecode::Assign8:
+    case Bytecode::AssignImm1:
+    case Bytecode::AssignImm2:
+    case Bytecode::AssignImm4:
+    case Bytecode::AssignImm8:
+    case Bytecode::AssignImm4F:
+    case Bytecode::AssignImm8F:
+    case Bytecode::Lea:
+    case Bytecode::LeaScaled:
+      return OpKind::PureValue;
+    case Bytecode::Deref1:
+    case Bytecode::Deref2:
+    case Bytecode::Deref4:
+    case Bytecode::Deref8:
+    case Bytecode::DerefN:
+    case Bytecode::IsNullPtr:
+    case Bytecode::IsNotNullPtr:
+      return OpKind::PureLoad;
+    case Bytecode::JumpIfTrue:
+    case Bytecode::JumpIfFalse:
+      return OpKind::Jump;
+    default:
+      return OpKind::Opaque;
+  }
+}
+
+bool IsPure(const OpKind kind) { return kind == OpKind::PureValue || kind == OpKind::PureLoad; }
+
+bool IsAssign(const Bytecode bytecode) {
+  return Bytecodes::ToByte(bytecode) >= Bytecodes::ToByte(Bytecode::Assign1) &&
+         Bytecodes::ToByte(bytecode) <= Bytecodes::ToByte(Bytecode::AssignImm8F);
+}
+
+bool IsAssignFromLocal(const Bytecode bytecode) {
+  return bytecode == Bytecode::Assign1 || bytecode == Bytecode::Assign2 || bytecode == Bytecode::Assign4 ||
+         bytecode == Bytecode::Assign8;
+}
+
+// An instruction of a function being optimized
+struct Instruction {
+  // The bytecode of the instruction
+  Bytecode bytecode_;
+  // The encoded instruction, including its bytecode
+  std::vector<uint8_t> bytes_;
+  // The index of the instruction a jump jumps to. It may be removed, which makes the jump go to the next instruction
+  // that isn't.
+  std::size_t target_{0};
+  // Whether the instruction was removed
+  bool removed_{false};
+};
+
+// The offset of the first operand of every bytecode, which pure instructions write
+constexpr uint32_t K_FIRST_OPERAND_OFFSET = sizeof(std::underlying_type_t<Bytecode>);
+
+LocalVar ReadLocal(const Instruction &inst, const uint32_t byte_offset) {
+  uint32_t encoded_local;
+  std::memcpy(&encoded_local, inst.bytes_.data() + byte_offset, sizeof(encoded_local));
+  return LocalVar::Decode(encoded_local);
+}
+
+void WriteLocal(Instruction *inst, const uint32_t byte_offset, const LocalVar local) {
+  const uint32_t encoded_local = local.Encode();
+  std::memcpy(inst->bytes_.data() + byte_offset, &encoded_local, sizeof(encoded_local));
+}
+
+// Call f(operand_index, byte_offset) for every local the instruction refers to, including the locals in counted lists
+template <typename F>
+void ForEachLocalOperand(const Instruction &inst, F &&f) {
+  for (uint32_t i = 0; i < Bytecodes::NumOperands(inst.bytecode_); i++) {
+    const uint32_t offset = Bytecodes::GetNthOperandOffset(inst.bytecode_, i);
+    switch (Bytecodes::GetNthOperandType(inst.bytecode_, i)) {
+      case OperandType::Local:
+        f(i, offset);
+        break;
+      case OperandType::LocalCount: {
+        uint16_t num_locals;
+        std::memcpy(&num_locals, inst.bytes_.data() + offset, sizeof(num_locals));
+        for (uint32_t j = 0; j < num_locals; j++) {
+          f(i, static_cast<uint32_t>(offset + sizeof(num_locals) + j * sizeof(uint32_t)));
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+}
+
+// Whether the operand at the given index reads the local it refers to, rather than writes it or only uses its address
+bool IsRead(const OpKind kind, const uint32_t operand_index, const LocalVar local) {
+  if (local.GetAddressMode() == LocalVar::AddressMode::Value) return true;
+  if (operand_index == 0 && IsPure(kind)) return false;
+  return kind == OpKind::PureLoad || kind == OpKind::Jump;
+}
+
+// The number of bytes a pure instruction writes to its first operand, if it's known to write all of them, or zero
+uint32_t GetWriteWidth(const Instruction &inst) {
+  switch (inst.bytecode_) {
+    case Bytecode::Assign1:
+    case Bytecode::AssignImm1:
+    case Bytecode::Deref1:
+      return 1;
+    case Bytecode::Assign2:
+    case Bytecode::AssignImm2:
+    case Bytecode::Deref2:
+      return 2;
+    case Bytecode::Assign4:
+    case Bytecode::AssignImm4:
+    case Bytecode::AssignImm4F:
+    case Bytecode::Deref4:
+      return 4;
+    case Bytecode::Assign8:
+    case Bytecode::AssignImm8:
+    case Bytecode::AssignImm8F:
+    case Bytecode::Deref8:
+      return 8;
+    case Bytecode::DerefN: {
+      uint32_t len;
+      std::memcpy(&len, inst.bytes_.data() + Bytecodes::GetNthOperandOffset(Bytecode::DerefN, 2), sizeof(len));
+      return len;
+    }
+    default:
+      return 0;
+  }
+}
+
+// Whether values of the given type are assigned as integers, rather than copied through pointers
+bool IsAssignable(const ast::Type *type) {
+  if (type->IsPointerType()) return true;
+  const auto *builtin = type->SafeAs<ast::BuiltinType>();
+  return builtin != nullptr && builtin->IsPrimitive() && !builtin->IsFloatingPoint();
+}
+
+// Replace an instruction with one copying the local src into dest, both of the given type
+void RewriteAsCopy(Instruction *inst, const LocalVar dest, const LocalVar src, const ast::Type *type) {
+  // Like the generator, assign primitive values and copy everything else through pointers
+  const uint32_t size = type->GetSize();
+  const bool is_primitive = IsAssignable(type);
+  const auto append = [inst](const auto value) {
+    const auto *raw = reinterpret_cast<const uint8_t *>(&value);
+    inst->bytes_.insert(inst->bytes_.end(), raw, raw + sizeof(value));
+  };
+  switch (is_primitive ? size : 0) {
+    case 1:
+      inst->bytecode_ = Bytecode::Assign1;
+      break;
+    case 2:
+      inst->bytecode_ = Bytecode::Assign2;
+      break;
+    case 4:
+      inst->bytecode_ = Bytecode::Assign4;
+      break;
+    case 8:
+      inst->bytecode_ = Bytecode::Assign8;
+      break;
+    default:
+      inst->bytecode_ = Bytecode::DerefN;
+      break;
+  }
+  inst->bytes_.clear();
+  append(Bytecodes::ToByte(inst->bytecode_));
+  append(dest.Encode());
+  if (inst->bytecode_ == Bytecode::DerefN) {
+    append(src.AddressOf().Encode());
+    append(size);
+  } else {
+    append(src.ValueOf().Encode());
+  }
+}
+
+/**
+ * Optimizes the bytecode of one function.
+ */
+class FunctionOptimizer {
+ public:
+  FunctionOptimizer(const std::vector<uint8_t> &code, const FunctionInfo &func) {
+    for (const auto &local : func.GetLocals()) locals_.push_back(&local);
+    std::sort(locals_.begin(), locals_.end(),
+              [](const LocalInfo *a, const LocalInfo *b) { return a->GetOffset() < b->GetOffset(); });
+
+    // Decode the instructions, and translate the positions jumps go to into instruction indexes
+    const auto [start, end] = func.GetBytecodeRange();
+    std::unordered_map<std::size_t, std::size_t> index_of_position;
+    for (BytecodeIterator iter(code, start, end); !iter.Done(); iter.Advance()) {
+      const std::size_t position = iter.GetPosition();
+      index_of_position[position] = instructions_.size();
+      Instruction inst;
+      inst.bytecode_ = iter.CurrentBytecode();
+      inst.bytes_.assign(code.begin() + start + position, code.begin() + start + position + iter.CurrentBytecodeSize());
+      if (Bytecodes::IsJump(inst.bytecode_)) {
+        const uint32_t operand_index = Bytecodes::IsConditionalJump(inst.bytecode_) ? 1 : 0;
+        inst.target_ = position + Bytecodes::GetNthOperandOffset(inst.bytecode_, operand_index) +
+                       iter.GetJumpOffsetOperand(operand_index);
+      }
+      instructions_.push_back(std::move(inst));
+    }
+    index_of_position[end - start] = instructions_.size();
+    for (auto &inst : instructions_) {
+      if (Bytecodes::IsJump(inst.bytecode_)) {
+        NOISEPAGE_ASSERT(index_of_position.count(inst.target_) != 0, "Jump into the middle of an instruction");
+        inst.target_ = index_of_position[inst.target_];
+      }
+    }
+  }
+
+  void Run() {
+    for (uint32_t round = 0; round < K_MAX_ROUNDS; round++) {
+      bool changed = SimplifyJumps();
+      FindEscapedLocals();
+      changed |= PropagateInBlocks();
+      changed |= RemoveUnreadStores();
+      if (!changed) break;
+    }
+  }
+
+  // Append the optimized bytecode to the given code, and return the range it was written to
+  std::pair<std::size_t, std::size_t> Encode(std::vector<uint8_t> *code) const {
+    // A removed instruction is at the position of the next instruction that isn't, where jumps to it go
+    std::vector<std::size_t> positions(instructions_.size() + 1);
+    std::size_t position = code->size();
+    for (std::size_t i = 0; i < instructions_.size(); i++) {
+      positions[i] = position;
+      if (!instructions_[i].removed_) position += instructions_[i].bytes_.size();
+    }
+    positions[instructions_.size()] = position;
+
+    const std::size_t start = code->size();
+    for (std::size_t i = 0; i < instructions_.size(); i++) {
+      const Instruction &inst = instructions_[i];
+      if (inst.removed_) continue;
+      const std::size_t inst_start = code->size();
+      code->insert(code->end(), inst.bytes_.begin(), inst.bytes_.end());
+      if (Bytecodes::IsJump(inst.bytecode_)) {
+        const uint32_t operand_offset =
+            Bytecodes::GetNthOperandOffset(inst.bytecode_, Bytecodes::IsConditionalJump(inst.bytecode_) ? 1 : 0);
+        const auto delta = static_cast<int32_t>(static_cast<int64_t>(positions[inst.target_]) -
+                                                static_cast<int64_t>(positions[i] + operand_offset));
+        std::memcpy(code->data() + inst_start + operand_offset, &delta, sizeof(delta));
+      }
+    }
+    return {start, code->size()};
+  }
+
+ private:
+  // A value known to be held by a local, because it was assigned in the current basic block
+  struct AssignedValue {
+    // The assignment with its destination cleared, which assigns the same value
+    std::vector<uint8_t> key_;
+    // The local the value was copied from, or -1 for an immediate
+    int32_t source_;
+    // Whether reads of the local may read the source instead, which requires them to be of the same type
+    bool is_copy_;
+  };
+
+  // A value computed by a pure instruction in the current basic block, which is still held by a local
+  struct AvailableValue {
+    // The instruction with its destination cleared, which computes the same value
+    std::vector<uint8_t> key_;
+    // The local holding the value
+    int32_t holder_;
+    // The locals the instruction read
+    std::vector<int32_t> operands_;
+  };
+
+  // The index of the local the given frame offset lies in, or -1
+  int32_t FindLocal(const uint32_t offset) const {
+    auto iter = std::upper_bound(locals_.begin(), locals_.end(), offset,
+                                 [](const uint32_t o, const LocalInfo *local) { return o < local->GetOffset(); });
+    if (iter == locals_.begin()) return -1;
+    --iter;
+    if (offset >= (*iter)->GetOffset() + std::max((*iter)->GetSize(), 1u)) return -1;
+    return static_cast<int32_t>(iter - locals_.begin());
+  }
+
+  // The index of the local the given variable refers to as a whole, or -1
+  int32_t FindExactLocal(const LocalVar local) const {
+    const int32_t idx = FindLocal(local.GetOffset());
+    return idx >= 0 && locals_[idx]->GetOffset() == local.GetOffset() ? idx : -1;
+  }
+
+  bool IsTracked(const int32_t idx) const { return idx >= 0 && !escaped_[idx]; }
+
+  bool HaveSameType(const int32_t a, const int32_t b) const {
+    return locals_[a]->GetType() == locals_[b]->GetType() && locals_[a]->GetSize() == locals_[b]->GetSize();
+  }
+
+  std::size_t NextLive(std::size_t i) const {
+    while (i < instructions_.size() && instructions_[i].removed_) i++;
+    return i;
+  }
+
+  std::unordered_set<std::size_t> FindJumpTargets() const {
+    std::unordered_set<std::size_t> targets;
+    for (const auto &inst : instructions_) {
+      if (!inst.removed_ && Bytecodes::IsJump(inst.bytecode_)) targets.insert(NextLive(inst.target_));
+    }
+    return targets;
+  }
+
+  // Thread jumps through unconditional jumps, remove jumps to the next instruction and code that can't be reached
+  bool SimplifyJumps() {
+    bool changed = false;
+    for (std::size_t i = 0; i < instructions_.size(); i++) {
+      Instruction &inst = instructions_[i];
+      if (inst.removed_ || !Bytecodes::IsJump(inst.bytecode_)) continue;
+      std::size_t target = NextLive(inst.target_);
+      for (uint32_t hops = 0; hops < K_MAX_JUMP_THREADING_HOPS && target < instructions_.size() &&
+                              Bytecodes::IsUnconditionalJump(instructions_[target].bytecode_);
+           hops++) {
+        const std::size_t next_target = NextLive(instructions_[target].target_);
+        if (next_target == target) break;
+        target = next_target;
+        changed = true;
+      }
+      inst.target_ = target;
+      if (target == NextLive(i + 1)) {
+        inst.removed_ = true;
+        changed = true;
+      }
+    }
+
+    const auto targets = FindJumpTargets();
+    bool reachable = true;
+    for (std::size_t i = 0; i < instructions_.size(); i++) {
+      Instruction &inst = instructions_[i];
+      if (inst.removed_) continue;
+      if (targets.count(i) != 0) reachable = true;
+      if (!reachable) {
+        inst.removed_ = true;
+        changed = true;
+        continue;
+      }
+      if (Bytecodes::IsUnconditionalJump(inst.bytecode_) || Bytecodes::IsReturn(inst.bytecode_)) reachable = false;
+    }
+    return changed;
+  }
+
+  // Find the locals whose address is handed to a bytecode handler that may keep it, or that are accessed in parts
+  void FindEscapedLocals() {
+    escaped_.assign(locals_.size(), false);
+    for (const auto &inst : instructions_) {
+      if (inst.removed_) continue;
+      const OpKind kind = GetOpKind(inst.bytecode_);
+      ForEachLocalOperand(inst, [&](const uint32_t operand_index, const uint32_t byte_offset) {
+        const LocalVar local = ReadLocal(inst, byte_offset);
+        const int32_t idx = FindLocal(local.GetOffset());
+        if (idx < 0) return;
+        if (locals_[idx]->GetOffset() != local.GetOffset()) {
+          escaped_[idx] = true;
+        } else if (local.GetAddressMode() == LocalVar::AddressMode::Address && !IsRead(kind, operand_index, local) &&
+                   !(operand_index == 0 && IsPure(kind))) {
+          escaped_[idx] = true;
+        }
+      });
+    }
+  }
+
+  // Forget what is known about the value of a local that is written
+  void KillLocal(const int32_t idx) {
+    assigned_.erase(idx);
+    for (auto iter = assigned_.begin(); iter != assigned_.end();) {
+      iter = iter->second.source_ == idx ? assigned_.erase(iter) : std::next(iter);
+    }
+    available_.erase(std::remove_if(available_.begin(), available_.end(),
+                                    [idx](const AvailableValue &value) {
+                                      return value.holder_ == idx || std::find(value.operands_.begin(),
+                                                                               value.operands_.end(),
+                                                                               idx) != value.operands_.end();
+                                    }),
+                     available_.end());
+  }
+
+  // The generator copies a local into another by dereferencing its address. Turn such copies of primitive values into
+  // assignments, which copy propagation understands.
+  bool CanonicalizeCopy(Instruction *inst) const {
+    if (inst->bytecode_ != Bytecode::Deref1 && inst->bytecode_ != Bytecode::Deref2 &&
+        inst->bytecode_ != Bytecode::Deref4 && inst->bytecode_ != Bytecode::Deref8) {
+      return false;
+    }
+    const LocalVar dest = ReadLocal(*inst, K_FIRST_OPERAND_OFFSET);
+    const LocalVar src = ReadLocal(*inst, Bytecodes::GetNthOperandOffset(inst->bytecode_, 1));
+    if (dest.GetAddressMode() != LocalVar::AddressMode::Address ||
+        src.GetAddressMode() != LocalVar::AddressMode::Address) {
+      return false;
+    }
+    const int32_t dest_idx = FindExactLocal(dest), src_idx = FindExactLocal(src);
+    if (dest_idx < 0 || src_idx < 0 || !HaveSameType(dest_idx, src_idx) ||
+        !IsAssignable(locals_[dest_idx]->GetType()) || GetWriteWidth(*inst) != locals_[dest_idx]->GetSize()) {
+      return false;
+    }
+    RewriteAsCopy(inst, dest, src, locals_[dest_idx]->GetType());
+    return true;
+  }
+
+  // Copy propagation, and removal of redundant assignments, loads and stores within basic blocks
+  bool PropagateInBlocks() {
+    bool changed = false;
+    const auto targets = FindJumpTargets();
+    assigned_.clear();
+    available_.clear();
+    // The last store to each local, which is dead if the local is overwritten before it's read
+    std::unordered_map<int32_t, std::size_t> last_stores;
+
+    for (std::size_t i = 0; i < instructions_.size(); i++) {
+      Instruction &inst = instructions_[i];
+      if (inst.removed_) continue;
+      if (targets.count(i) != 0) {
+        assigned_.clear();
+        available_.clear();
+        last_stores.clear();
+      }
+
+      // Read copied locals from where they were copied from
+      changed |= CanonicalizeCopy(&inst);
+      OpKind kind = GetOpKind(inst.bytecode_);
+      ForEachLocalOperand(inst, [&](const uint32_t, const uint32_t byte_offset) {
+        const LocalVar local = ReadLocal(inst, byte_offset);
+        if (local.GetAddressMode() != LocalVar::AddressMode::Value) return;
+        const int32_t idx = FindExactLocal(local);
+        if (!IsTracked(idx)) return;
+        if (auto iter = assigned_.find(idx); iter != assigned_.end() && iter->second.is_copy_) {
+          WriteLocal(&inst, byte_offset, LocalVar(locals_[iter->second.source_]->GetOffset(), local.GetAddressMode()));
+          changed = true;
+        }
+      });
+
+      // The local a pure instruction writes as a whole, or -1
+      const LocalVar dest = IsPure(kind) ? ReadLocal(inst, K_FIRST_OPERAND_OFFSET) : LocalVar();
+      const int32_t dest_idx = IsPure(kind) && dest.GetAddressMode() == LocalVar::AddressMode::Address
+                                   ? FindExactLocal(dest)
+                                   : -1;
+      std::vector<uint8_t> key;
+      if (dest_idx >= 0) {
+        key = inst.bytes_;
+        std::fill(key.begin() + K_FIRST_OPERAND_OFFSET, key.begin() + K_FIRST_OPERAND_OFFSET + sizeof(uint32_t), 0);
+      }
+
+      if (dest_idx >= 0 && IsAssign(inst.bytecode_)) {
+        // Remove assignments of the value the local already holds
+        const auto iter = assigned_.find(dest_idx);
+        const bool is_self_copy = IsAssignFromLocal(inst.bytecode_) &&
+                                  ReadLocal(inst, Bytecodes::GetNthOperandOffset(inst.bytecode_, 1)) == dest.ValueOf();
+        if (is_self_copy || (iter != assigned_.end() && iter->second.key_ == key)) {
+          inst.removed_ = true;
+          changed = true;
+          continue;
+        }
+      } else if (dest_idx >= 0) {
+        // Copy values that were already computed instead of computing them again
+        const auto iter = std::find_if(available_.begin(), available_.end(),
+                                       [&](const AvailableValue &value) { return value.key_ == key; });
+        if (iter != available_.end() && iter->holder_ == dest_idx) {
+          inst.removed_ = true;
+          changed = true;
+          continue;
+        }
+        if (iter != available_.end() && HaveSameType(iter->holder_, dest_idx)) {
+          RewriteAsCopy(&inst, dest, LocalVar(locals_[iter->holder_]->GetOffset(), LocalVar::AddressMode::Address),
+                        locals_[dest_idx]->GetType());
+          kind = GetOpKind(inst.bytecode_);
+          key = inst.bytes_;
+          std::fill(key.begin() + K_FIRST_OPERAND_OFFSET, key.begin() + K_FIRST_OPERAND_OFFSET + sizeof(uint32_t), 0);
+          changed = true;
+        }
+      }
+
+      // Reads keep the last stores to locals alive
+      std::vector<int32_t> operands;
+      ForEachLocalOperand(inst, [&](const uint32_t operand_index, const uint32_t byte_offset) {
+        const LocalVar local = ReadLocal(inst, byte_offset);
+        if (operand_index == 0 && IsPure(kind) && local.GetAddressMode() == LocalVar::AddressMode::Address) return;
+        const int32_t idx = FindLocal(local.GetOffset());
+        if (idx < 0) return;
+        operands.push_back(idx);
+        if (IsRead(kind, operand_index, local)) last_stores.erase(idx);
+      });
+      if (kind == OpKind::Jump || Bytecodes::IsTerminal(inst.bytecode_)) last_stores.clear();
+
+      // Writes invalidate what is known about the local written, and about memory if they may write it
+      if (!IsPure(kind)) {
+        if (kind == OpKind::Opaque) available_.clear();
+        continue;
+      }
+      if (dest.GetAddressMode() == LocalVar::AddressMode::Value) {
+        available_.clear();
+        continue;
+      }
+      if (const int32_t written_idx = FindLocal(dest.GetOffset()); written_idx < 0 || escaped_[written_idx]) {
+        if (written_idx >= 0) KillLocal(written_idx);
+        available_.clear();
+      } else {
+        KillLocal(written_idx);
+      }
+      if (!IsTracked(dest_idx)) continue;
+
+      // Remove the last store to a local this one overwrites as a whole
+      if (GetWriteWidth(inst) == locals_[dest_idx]->GetSize()) {
+        if (auto iter = last_stores.find(dest_idx); iter != last_stores.end()) {
+          instructions_[iter->second].removed_ = true;
+          changed = true;
+        }
+        last_stores[dest_idx] = i;
+      } else {
+        last_stores.erase(dest_idx);
+      }
+
+      // Remember the value the local now holds
+      if (std::find(operands.begin(), operands.end(), dest_idx) != operands.end()) continue;
+      if (IsAssignFromLocal(inst.bytecode_)) {
+        const int32_t source_idx = FindExactLocal(ReadLocal(inst, Bytecodes::GetNthOperandOffset(inst.bytecode_, 1)));
+        const auto source = ReadLocal(inst, Bytecodes::GetNthOperandOffset(inst.bytecode_, 1));
+        if (IsTracked(source_idx) && source.GetAddressMode() == LocalVar::AddressMode::Value) {
+          const bool is_copy =
+              HaveSameType(source_idx, dest_idx) && GetWriteWidth(inst) == locals_[dest_idx]->GetSize();
+          assigned_[dest_idx] = AssignedValue{std::move(key), source_idx, is_copy};
+        }
+      } else if (IsAssign(inst.bytecode_)) {
+        assigned_[dest_idx] = AssignedValue{std::move(key), -1, false};
+      } else {
+        available_.push_back(AvailableValue{std::move(key), dest_idx, std::move(operands)});
+      }
+    }
+    return changed;
+  }
+
+  // Remove stores to locals that are never read
+  bool RemoveUnreadStores() {
+    std::vector<bool> read(locals_.size(), false);
+    for (const auto &inst : instructions_) {
+      if (inst.removed_) continue;
+      const OpKind kind = GetOpKind(inst.bytecode_);
+      ForEachLocalOperand(inst, [&](const uint32_t operand_index, const uint32_t byte_offset) {
+        const LocalVar local = ReadLocal(inst, byte_offset);
+        if (const int32_t idx = FindLocal(local.GetOffset()); idx >= 0 && IsRead(kind, operand_index, local)) {
+          read[idx] = true;
+        }
+      });
+    }
+
+    bool changed = false;
+    for (auto &inst : instructions_) {
+      if (inst.removed_ || !IsPure(GetOpKind(inst.bytecode_))) continue;
+      const LocalVar dest = ReadLocal(inst, K_FIRST_OPERAND_OFFSET);
+      if (dest.GetAddressMode() != LocalVar::AddressMode::Address) continue;
+      if (const int32_t idx = FindExactLocal(dest); IsTracked(idx) && !read[idx]) {
+        inst.removed_ = true;
+        changed = true;
+      }
+    }
+    return changed;
+  }
+
+ private:
+  // The locals of the function, ordered by their offset in the frame
+  std::vector<const LocalInfo *> locals_;
+  // The instructions of the function
+  std::vector<Instruction> instructions_;
+  // Whether the address of each local escapes, which keeps it from being optimized
+  std::vector<bool> escaped_;
+  // The values assigned to locals in the current basic block
+  std::unordered_map<int32_t, AssignedValue> assigned_;
+  // The values computed in the current basic block
+  std::vector<AvailableValue> available_;
+};
+
+}  // namespace
+
+void BytecodeOptimizer::Optimize(std::vector<uint8_t> *code, std::vector<FunctionInfo> *functions) {
+  // Functions are laid out in the order they were generated, which isn't necessarily the order of their ids
+  std::vector<FunctionInfo *> ordered;
+  for (auto &func : *functions) ordered.push_back(&func);
+  std::sort(ordered.begin(), ordered.end(), [](const FunctionInfo *a, const FunctionInfo *b) {
+    return a->GetBytecodeRange().first < b->GetBytecodeRange().first;
+  });
+
+  std::vector<uint8_t> optimized;
+  optimized.reserve(code->size());
+  for (auto *func : ordered) {
+    if (func->GetBytecodeRange().first == func->GetBytecodeRange().second) continue;
+    FunctionOptimizer optimizer(*code, *func);
+    optimizer.Run();
+    const auto [start, end] = optimizer.Encode(&optimized);
+    func->SetBytecodeRange(start, end);
+  }
+  *code = std::move(optimized);
+}
+
+}  // namespace noisepage::execution::vm
@@ -11,6 +11,7 @@
 #include <llvm/IR/LegacyPassManager.h>
 #include <llvm/IR/Verifier.h>
 #include <llvm/MC/MCContext.h>
+#include <llvm/Object/SymbolSize.h>
 #include <llvm/Support/DynamicLibrary.h>
 #include <llvm/Support/Path.h>
 #include <llvm/Support/SmallVectorMemoryBuffer.h>
@@ -20,11 +21,19 @@
 #include <llvm/Transforms/IPO.h>
 #include <llvm/Transforms/IPO/AlwaysInliner.h>
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#include <unistd.h>
 
+#include <algorithm>
+#include <fstream>
 #include <map>
 #include <memory>
+#include <mutex>  // NOLINT
+#include <numeric>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -32,6 +41,7 @@
 #include "execution/vm/bytecode_module.h"
 #include "execution/vm/bytecode_traits.h"
 #include "loggers/execution_logger.h"
+#include "spdlog/fmt/fmt.h"
 
 extern void *__dso_handle __attribute__((__visibility__("hidden")));  // NOLINT
 
@@ -49,6 +59,100 @@ bool FunctionHasDirectReturn(const ast::FunctionType *func_type) {
   return (!ret_type->IsNilType() && ret_type->GetSize() <= sizeof(int64_t));
 }
 
+// Every partition parses the bytecode handlers and optimizes its code separately, which only pays
+// off for partitions with enough bytecode to compile.
+constexpr std::size_t MIN_PARTITION_BYTECODE_SIZE = 8192;
+
+// The inlining threshold of the max-performance pipeline, four times the threshold at -O3.
+constexpr int MAX_PERFORMANCE_INLINE_THRESHOLD = 1000;
+
+// Split the functions of the module into at most 'max_partitions' partitions of similar bytecode
+// size. Functions that call each other or take each other's address stay in one partition, so
+// calls between them can still be inlined.
+std::vector<std::vector<const FunctionInfo *>> PartitionFunctions(const BytecodeModule &module,
+                                                                  const uint32_t max_partitions) {
+  // Group functions that refer to each other.
+  std::vector<FunctionId> group(module.GetFunctionCount());
+  std::iota(group.begin(), group.end(), FunctionId{0});
+  const auto find = [&](FunctionId id) {
+    while (group[id] != id) {
+      id = group[id] = group[group[id]];
+    }
+    return id;
+  };
+  for (const auto &func_info : module.GetFunctionsInfo()) {
+    for (auto iter = module.GetBytecodeForFunction(func_info); !iter.Done(); iter.Advance()) {
+      const Bytecode bytecode = iter.CurrentBytecode();
+      for (uint32_t i = 0; i < Bytecodes::NumOperands(bytecode); i++) {
+        if (Bytecodes::GetNthOperandType(bytecode, i) == OperandType::FunctionId) {
+          group[find(func_info.GetId())] = find(iter.GetFunctionIdOperand(i));
+        }
+      }
+    }
+  }
+
+  // Collect the groups and their sizes.
+  std::unordered_map<FunctionId, std::pair<std::size_t, std::vector<const FunctionInfo *>>> groups;
+  std::size_t total_size = 0;
+  for (const auto &func_info : module.GetFunctionsInfo()) {
+    const auto [start, end] = func_info.GetBytecodeRange();
+    auto &[size, functions] = groups[find(func_info.GetId())];
+    size += end - start;
+    functions.push_back(&func_info);
+    total_size += end - start;
+  }
+
+  const std::size_t num_partitions =
+      std::max(std::size_t{1}, std::min({static_cast<std::size_t>(max_partitions), groups.size(),
+                                         total_size / MIN_PARTITION_BYTECODE_SIZE}));
+
+  // Assign the largest groups first, each to the smallest partition so far.
+  std::vector<std::pair<std::size_t, std::vector<const FunctionInfo *>>> sorted_groups;
+  sorted_groups.reserve(groups.size());
+  for (auto &[_, size_and_functions] : groups) {
+    sorted_groups.emplace_back(std::move(size_and_functions));
+  }
+  std::sort(sorted_groups.begin(), sorted_groups.end(), [](const auto &a, const auto &b) {
+    return a.first != b.first ? a.first > b.first : a.second[0]->GetId() < b.second[0]->GetId();
+  });
+
+  std::vector<std::size_t> partition_sizes(num_partitions, 0);
+  std::vector<std::vector<const FunctionInfo *>> partitions(num_partitions);
+  for (const auto &[size, functions] : sorted_groups) {
+    const auto smallest = std::min_element(partition_sizes.begin(), partition_sizes.end()) - partition_sizes.begin();
+    partition_sizes[smallest] += size;
+    partitions[smallest].insert(partitions[smallest].end(), functions.begin(), functions.end());
+  }
+  return partitions;
+}
+
+// Append the functions of the loaded objects to the perf map of the process, a line of the address, size and name of
+// each in /tmp/perf-<pid>.map. perf reads it to name the samples it takes in JIT compiled code, which it otherwise
+// can't attribute to anything.
+void WritePerfMap(llvm::RuntimeDyld *loader, const std::vector<std::unique_ptr<llvm::object::ObjectFile>> &objects) {
+  std::string lines;
+  for (const auto &object : objects) {
+    for (const auto &[symbol, size] : llvm::object::computeSymbolSizes(*object)) {
+      auto type = symbol.getType();
+      auto name = symbol.getName();
+      if (!type || !name) {
+        llvm::consumeError(type.takeError());
+        llvm::consumeError(name.takeError());
+        continue;
+      }
+      if (*type != llvm::object::SymbolRef::ST_Function || size == 0) continue;
+      const auto address = loader->getSymbol(*name).getAddress();
+      if (address != 0) lines += fmt::format("{:x} {:x} {}\n", address, size, name->str());
+    }
+  }
+
+  // Modules are loaded by many threads at once
+  static std::mutex perf_map_mutex;
+  std::lock_guard guard(perf_map_mutex);
+  std::ofstream perf_map(fmt::format("/tmp/perf-{}.map", ::getpid()), std::ios_base::out | std::ios_base::app);
+  perf_map << lines;
+}
+
 }  // namespace
 
 // ---------------------------------------------------------
@@ -358,7 +462,8 @@ llvm::Value *LLVMEngine::FunctionLocalsMap::GetArgumentById(LocalVar var) {
 /** A builder for compiled modules. We need this because compiled modules are immutable after creation. */
 class LLVMEngine::CompiledModuleBuilder {
  public:
-  CompiledModuleBuilder(const CompilerOptions &options, const BytecodeModule &tpl_module);
+  CompiledModuleBuilder(const CompilerOptions &options, const BytecodeModule &tpl_module,
+                        std::vector<const FunctionInfo *> functions);
 
   // No copying or moving this class
   DISALLOW_COPY_AND_MOVE(CompiledModuleBuilder);
@@ -369,11 +474,15 @@ class LLVMEngine::CompiledModuleBuilder {
   // Generate function declarations for each function in the TPL bytecode module
   void DeclareFunctions();
 
-  // Generate an LLVM function implementation for each function defined in the
-  // TPL bytecode module. DeclareFunctions() must be called to generate function
-  // declarations before they can be defined.
+  // Generate an LLVM function implementation for each function of the TPL
+  // bytecode module this builder compiles. DeclareFunctions() must be called to
+  // generate function declarations before they can be defined.
   void DefineFunctions();
 
+  // Make the bytecode handlers private to the module. Every partition of a
+  // TPL module carries its own copy, which must not clash when linked.
+  void InternalizeHandlers();
+
   // Verify that all generated code is good
   void Verify();
 
@@ -383,8 +492,8 @@ class LLVMEngine::CompiledModuleBuilder {
   // Optimize the generate code
   void Optimize();
 
-  // Perform finalization logic and create a compiled module
-  std::unique_ptr<CompiledModule> Finalize();
+  // Perform finalization logic and emit the module's object code
+  std::unique_ptr<llvm::MemoryBuffer> Finalize();
 
   // Print the contents of the module to a string and return it
   std::string DumpModuleIR();
@@ -412,6 +521,9 @@ class LLVMEngine::CompiledModuleBuilder {
  private:
   const CompilerOptions &options_;
   const BytecodeModule &tpl_module_;
+  // The functions of the TPL module this builder defines. Others are only
+  // declared, and linked in from another partition's object.
+  const std::vector<const FunctionInfo *> functions_;
   std::unique_ptr<llvm::TargetMachine> target_machine_;
   std::unique_ptr<llvm::LLVMContext> context_;
   std::unique_ptr<llvm::Module> llvm_module_;
@@ -424,9 +536,11 @@ class LLVMEngine::CompiledModuleBuilder {
 // ---------------------------------------------------------
 
 LLVMEngine::CompiledModuleBuilder::CompiledModuleBuilder(const CompilerOptions &options,
-                                                         const BytecodeModule &tpl_module)
+                                                         const BytecodeModule &tpl_module,
+                                                         std::vector<const FunctionInfo *> functions)
     : options_(options),
       tpl_module_(tpl_module),
+      functions_(std::move(functions)),
       target_machine_(nullptr),
       context_(std::make_unique<llvm::LLVMContext>()),
       llvm_module_(nullptr),
@@ -468,7 +582,9 @@ LLVMEngine::CompiledModuleBuilder::CompiledModuleBuilder(const CompilerOptions &
     // Both relocation=PIC or JIT=true work. Use the latter for now.
     llvm::TargetOptions target_options;
     llvm::Optional<llvm::Reloc::Model> reloc;
-    const llvm::CodeGenOpt::Level opt_level = llvm::CodeGenOpt::Aggressive;
+    const llvm::CodeGenOpt::Level opt_level =
+        options.GetOptimizationProfile() == OptimizationProfile::FastCompile ? llvm::CodeGenOpt::Less
+                                                                             : llvm::CodeGenOpt::Aggressive;
     target_machine_.reset(target->createTargetMachine(target_triple, llvm::sys::getHostCPUName(),
                                                       target_features.getString(), target_options, reloc, {}, opt_level,
                                                       true));
@@ -922,8 +1038,21 @@ void LLVMEngine::CompiledModuleBuilder::DefineFunction(const FunctionInfo &func_
 
 void LLVMEngine::CompiledModuleBuilder::DefineFunctions() {
   llvm::IRBuilder<> ir_builder(*context_);
+  for (const auto *func_info : functions_) {
+    DefineFunction(*func_info, &ir_builder);
+  }
+}
+
+void LLVMEngine::CompiledModuleBuilder::InternalizeHandlers() {
+  std::unordered_set<std::string> tpl_functions;
   for (const auto &func_info : tpl_module_.GetFunctionsInfo()) {
-    DefineFunction(func_info, &ir_builder);
+    tpl_functions.insert(func_info.GetName());
+  }
+  for (auto &func : *llvm_module_) {
+    if (!func.isDeclaration() && tpl_functions.count(func.getName().str()) == 0) {
+      func.setLinkage(llvm::GlobalValue::InternalLinkage);
+      func.setComdat(nullptr);
+    }
   }
 }
 
@@ -957,10 +1086,25 @@ void LLVMEngine::CompiledModuleBuilder::Optimize() {
   module_passes.add(new llvm::TargetLibraryInfoWrapperPass(*target_library_info_impl));
   module_passes.add(llvm::createTargetTransformInfoWrapperPass(target_machine_->getTargetIRAnalysis()));
 
-  // Build up optimization pipeline
+  // Build up optimization pipeline. The bytecode handlers were inlined when
+  // simplifying, so a fast compile gets by with a light cleanup.
+  const auto profile = options_.GetOptimizationProfile();
   llvm::PassManagerBuilder pm_builder;
-  pm_builder.OptLevel = 3;
-  pm_builder.Inliner = llvm::createFunctionInliningPass(3, 0, false);
+  switch (profile) {
+    case OptimizationProfile::FastCompile:
+      pm_builder.OptLevel = 1;
+      break;
+    case OptimizationProfile::Balanced:
+      pm_builder.OptLevel = 3;
+      pm_builder.Inliner = llvm::createFunctionInliningPass(3, 0, false);
+      break;
+    case OptimizationProfile::MaxPerformance:
+      pm_builder.OptLevel = 3;
+      pm_builder.Inliner = llvm::createFunctionInliningPass(MAX_PERFORMANCE_INLINE_THRESHOLD);
+      pm_builder.LoopVectorize = true;
+      pm_builder.SLPVectorize = true;
+      break;
+  }
   pm_builder.populateFunctionPassManager(function_passes);
   pm_builder.populateModulePassManager(module_passes);
 
@@ -971,16 +1115,27 @@ void LLVMEngine::CompiledModuleBuilder::Optimize() {
   }
   function_passes.doFinalization();
   module_passes.run(*llvm_module_);
+
+  // The handlers not referenced by TPL functions are internal, so the module
+  // is a closed world. Run the link-time pipeline over it, which inlines and
+  // propagates constants across TPL functions and the helpers they call.
+  if (profile == OptimizationProfile::MaxPerformance) {
+    llvm::legacy::PassManager lto_passes;
+    lto_passes.add(new llvm::TargetLibraryInfoWrapperPass(*target_library_info_impl));
+    lto_passes.add(llvm::createTargetTransformInfoWrapperPass(target_machine_->getTargetIRAnalysis()));
+    pm_builder.populateLTOPassManager(lto_passes);
+    lto_passes.run(*llvm_module_);
+  }
 }
 
-std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::CompiledModuleBuilder::Finalize() {
+std::unique_ptr<llvm::MemoryBuffer> LLVMEngine::CompiledModuleBuilder::Finalize() {
   std::unique_ptr<llvm::MemoryBuffer> obj = EmitObject();
 
   if (options_.ShouldPersistObjectFile()) {
     PersistObjectToFile(*obj);
   }
 
-  return std::make_unique<CompiledModule>(std::move(obj));
+  return obj;
 }
 
 std::unique_ptr<llvm::MemoryBuffer> LLVMEngine::CompiledModuleBuilder::EmitObject() {
@@ -1048,6 +1203,13 @@ std::string LLVMEngine::CompiledModuleBuilder::DumpModuleAsm() {
 // ---------------------------------------------------------
 
 LLVMEngine::CompiledModule::CompiledModule(std::unique_ptr<llvm::MemoryBuffer> object_code)
+    : loaded_(false), memory_manager_(std::make_unique<LLVMEngine::TPLMemoryManager>()) {
+  if (object_code != nullptr) {
+    object_code_.emplace_back(std::move(object_code));
+  }
+}
+
+LLVMEngine::CompiledModule::CompiledModule(std::vector<std::unique_ptr<llvm::MemoryBuffer>> &&object_code)
     : loaded_(false),
       object_code_(std::move(object_code)),
       memory_manager_(std::make_unique<LLVMEngine::TPLMemoryManager>()) {}
@@ -1079,7 +1241,7 @@ void LLVMEngine::CompiledModule::Load(const BytecodeModule &module) {
   // directory.
   //
 
-  if (object_code_ == nullptr) {
+  if (object_code_.empty()) {
     llvm::SmallString<128> path;
     if (std::error_code error = llvm::sys::fs::current_path(path)) {
       EXECUTION_LOG_ERROR("LLVMEngine: Error reading current path '{}'", error.message());
@@ -1091,31 +1253,40 @@ void LLVMEngine::CompiledModule::Load(const BytecodeModule &module) {
       EXECUTION_LOG_ERROR("LLVMEngine: Error reading object file '{}'", error.message());
       return;
     }
-    object_code_ = std::move(file_buffer.get());
+    object_code_.emplace_back(std::move(file_buffer.get()));
   }
 
   EXECUTION_LOG_DEBUG("Object code size: {:.2f} KB", GetModuleObjectCodeSizeInBytes() / 1024.0);
 
   //
-  // We've loaded the object file into an in-memory buffer. We need to convert
-  // it into an object file, load it, and link it into our address space to make
-  // its functions available for execution.
+  // We've loaded the object files into in-memory buffers. We need to convert
+  // them into object files, load them, and link them into our address space to
+  // make their functions available for execution. Calls between partitions are
+  // resolved when the loader is finalized, once all objects are loaded.
   //
 
-  auto object = llvm::object::ObjectFile::createObjectFile(object_code_->getMemBufferRef());
-  if (auto error = object.takeError()) {
-    EXECUTION_LOG_ERROR("LLVMEngine: Error constructing object file '{}'", llvm::toString(std::move(error)));
-    return;
-  }
-
   llvm::RuntimeDyld loader(*memory_manager_, *memory_manager_);
-  loader.loadObject(*object.get());
-  if (loader.hasError()) {
-    EXECUTION_LOG_ERROR("LLVMEngine: Error loading object file {}", loader.getErrorString().str());
-    return;
+  std::vector<std::unique_ptr<llvm::object::ObjectFile>> objects;
+  for (const auto &object_code : object_code_) {
+    auto object = llvm::object::ObjectFile::createObjectFile(object_code->getMemBufferRef());
+    if (auto error = object.takeError()) {
+      EXECUTION_LOG_ERROR("LLVMEngine: Error constructing object file '{}'", llvm::toString(std::move(error)));
+      return;
+    }
+
+    loader.loadObject(*object.get());
+    if (loader.hasError()) {
+      EXECUTION_LOG_ERROR("LLVMEngine: Error loading object file {}", loader.getErrorString().str());
+      return;
+    }
+    objects.emplace_back(std::move(object.get()));
   }
   loader.finalizeWithMemoryManagerLocking();
 
+  if (engine_settings != nullptr && engine_settings->ShouldWritePerfMap()) {
+    WritePerfMap(&loader, objects);
+  }
+
   //
   // Now, the object has successfully been loaded and is executable. We pull out
   // all module functions into a handy cache.
@@ -1158,21 +1329,42 @@ void LLVMEngine::Shutdown() {
 
 std::unique_ptr<LLVMEngine::CompiledModule> LLVMEngine::Compile(const BytecodeModule &module,
                                                                 const CompilerOptions &options) {
-  CompiledModuleBuilder builder(options, module);
+  // Persisted modules are loaded from a single object file.
+  const uint32_t max_partitions = options.ShouldPersistObjectFile() ? 1
+                                  : options.GetMaxPartitions() != 0
+                                      ? options.GetMaxPartitions()
+                                      : static_cast<uint32_t>(tbb::this_task_arena::max_concurrency());
+  const auto partitions = PartitionFunctions(module, max_partitions);
 
-  builder.DeclareStaticLocals();
+  std::vector<std::unique_ptr<llvm::MemoryBuffer>> object_code(partitions.size());
+  const auto compile_partition = [&](const std::size_t idx) {
+    // Every partition has its own LLVM context, so they can be compiled concurrently.
+    CompiledModuleBuilder builder(options, module, partitions[idx]);
 
-  builder.DeclareFunctions();
+    builder.DeclareStaticLocals();
 
-  builder.DefineFunctions();
+    builder.DeclareFunctions();
 
-  builder.Simplify();
+    builder.DefineFunctions();
 
-  builder.Verify();
+    builder.InternalizeHandlers();
 
-  builder.Optimize();
+    builder.Simplify();
+
+    builder.Verify();
+
+    builder.Optimize();
+
+    object_code[idx] = builder.Finalize();
+  };
+
+  if (partitions.size() == 1) {
+    compile_partition(0);
+  } else {
+    tbb::parallel_for(std::size_t{0}, partitions.size(), compile_partition);
+  }
 
-  auto compiled_module = builder.Finalize();
+  auto compiled_module = std::make_unique<CompiledModule>(std::move(object_code));
 
   compiled_module->Load(module);
 
@@ -40,7 +40,10 @@ class Module::AsyncCompileTask : public tbb::task {
 // Module
 // ---------------------------------------------------------
 
-Module::Module(std::unique_ptr<BytecodeModule> bytecode_module) : Module(std::move(bytecode_module), nullptr) {}
+Module::Module(std::unique_ptr<BytecodeModule> bytecode_module, const OptimizationProfile profile)
+    : Module(std::move(bytecode_module), nullptr) {
+  profile_ = profile;
+}
 
 Module::Module(std::unique_ptr<BytecodeModule> bytecode_module, std::unique_ptr<LLVMEngine::CompiledModule> llvm_module)
     : bytecode_module_(std::move(bytecode_module)),
@@ -77,11 +80,14 @@ namespace {
 // TODO(pmenon): **LOTS** of shit to make this fully ABI compliant ....
 class TrampolineGenerator : public Xbyak::CodeGenerator {
  public:
-  TrampolineGenerator(const Module &module, const FunctionInfo &func_info, void *mem)
-      : Xbyak::CodeGenerator(Xbyak::DEFAULT_MAX_CODE_SIZE, mem), module_(module), func_(func_info) {}
+  TrampolineGenerator(const Module &module, const FunctionInfo &func_info, const std::atomic<void *> *impl, void *mem)
+      : Xbyak::CodeGenerator(Xbyak::DEFAULT_MAX_CODE_SIZE, mem), module_(module), func_(func_info), impl_(impl) {}
 
   /// Generate trampoline code for the given function in the given module
   void Generate() {
+    // Jump to the compiled implementation, if there is one by now
+    SwitchToCompiledCode();
+
     // Compute the stack space needed for all arguments
     const uint32_t required_stack_space = ComputeRequiredStackSpace();
 
@@ -127,6 +133,21 @@ class TrampolineGenerator : public Xbyak::CodeGenerator {
     return common::MathUtil::AlignTo(required_stack_space, common::Constants::CACHELINE_SIZE);
   }
 
+  // Callers may keep calling the trampoline after the module was compiled in
+  // the background, e.g., a parallel scan calls it for every morsel. Those
+  // calls tail-jump into the compiled implementation. The caller's arguments
+  // are still in their registers and the return address is on the stack, so
+  // it returns directly to the caller.
+  void SwitchToCompiledCode() {
+    mov(rax, reinterpret_cast<std::size_t>(impl_));
+    mov(rax, ptr[rax]);
+    mov(r11, reinterpret_cast<std::size_t>(getCode()));
+    cmp(rax, r11);
+    je("@f");
+    jmp(rax);
+    L("@@");
+  }
+
   void Prologue() { push(rbx); }
 
   void Epilogue() { pop(rbx); }
@@ -216,6 +237,8 @@ class TrampolineGenerator : public Xbyak::CodeGenerator {
  private:
   const Module &module_;
   const FunctionInfo &func_;
+  // The module's current implementation of the function.
+  const std::atomic<void *> *impl_;
 };
 
 }  // namespace
@@ -234,7 +257,7 @@ void Module::CreateFunctionTrampoline(const FunctionInfo &func, Trampoline *tram
   }
 
   // Generate code!
-  TrampolineGenerator generator(*this, func, memory.base());
+  TrampolineGenerator generator(*this, func, &functions_[func.GetId()], memory.base());
   generator.Generate();
 
   // Now that the code's been generated and finalized, let's remove write
@@ -272,6 +295,7 @@ void Module::CompileToMachineCode() {
 
     // JIT the module.
     LLVMEngine::CompilerOptions options;
+    options.SetOptimizationProfile(profile_);
     jit_module_ = LLVMEngine::Compile(*bytecode_module_, options);
 
     // JIT completed successfully. For each function in the module, pull out its
@@ -285,6 +309,16 @@ void Module::CompileToMachineCode() {
   });
 }
 
+void Module::RecordHotness(const uint64_t hotness) const {
+  if (!is_adaptive_.load(std::memory_order_relaxed) || compile_requested_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  if (hotness_.fetch_add(hotness, std::memory_order_relaxed) + hotness >= ADAPTIVE_COMPILE_HOTNESS &&
+      !compile_requested_.exchange(true)) {
+    const_cast<Module *>(this)->CompileToMachineCodeAsync();
+  }
+}
+
 void Module::CompileToMachineCodeAsync() {
   auto *compile_task = new (tbb::task::allocate_root()) AsyncCompileTask(this);
   tbb::task::enqueue(*compile_task);
@@ -110,6 +110,7 @@ void VM::InvokeFunction(const Module *module, const FunctionId func_id, const ui
   VM vm(module);
   Frame frame(raw_frame, frame_size);
   vm.Interpret(module->GetBytecodeModule()->AccessBytecodeForFunctionRaw(*func_info), &frame);
+  module->RecordHotness(vm.hotness_);
 
   // Done. Now, let's cleanup.
   if (used_heap) {
@@ -117,6 +118,18 @@ void VM::InvokeFunction(const Module *module, const FunctionId func_id, const ui
   }
 }
 
+// The loop iterations counted before they're reported to the module. Keeps the
+// shared counter off the interpreter's hot path while still letting long loops
+// trigger compilation.
+static constexpr const uint64_t HOTNESS_REPORT_INTERVAL = 1ull << 10ull;
+
+void VM::RecordLoopIteration() {
+  if (++hotness_ == HOTNESS_REPORT_INTERVAL) {
+    module_->RecordHotness(hotness_);
+    hotness_ = 0;
+  }
+}
+
 namespace {
 
 template <typename T>
@@ -183,6 +196,31 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     goto *kDispatchTable[op];     \
   } while (false)
 
+  // Conditional jumps almost always test the bool the bytecode right before
+  // them produced, e.g., a comparison or an iterator's HasNext(). Bytecodes
+  // producing a bool dispatch through this macro, which performs a directly
+  // following conditional jump on that bool in place, saving its dispatch.
+#define DISPATCH_NEXT_TEST(cond)                                                                 \
+  do {                                                                                           \
+    const auto next_op = Bytecodes::FromByte(Peek<std::underlying_type_t<Bytecode>>(&ip));       \
+    if (Bytecodes::IsConditionalJump(next_op)) {                                                 \
+      const uint8_t *jump_ip = ip + sizeof(std::underlying_type_t<Bytecode>);                    \
+      const auto jump_cond = LocalVar::Decode(Peek<uint32_t>(&jump_ip));                         \
+      if (jump_cond.GetAddressMode() == LocalVar::AddressMode::Value &&                          \
+          frame->PtrToLocalAt(jump_cond) == (cond)) {                                            \
+        DEBUG_TRACE_INSTRUCTIONS(static_cast<std::underlying_type_t<Bytecode>>(next_op));        \
+        ip = jump_ip + sizeof(uint32_t);                                                         \
+        auto skip = PEEK_JMP_OFFSET();                                                           \
+        if (*(cond) == (next_op == Bytecode::JumpIfTrue)) {                                      \
+          ip += skip;                                                                            \
+        } else {                                                                                 \
+          READ_JMP_OFFSET();                                                                     \
+        }                                                                                        \
+      }                                                                                          \
+    }                                                                                            \
+    DISPATCH_NEXT();                                                                             \
+  } while (false)
+
   /*****************************************************************************
    *
    * Below this comment begins the primary section of TPL's register-based
@@ -222,7 +260,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     auto lhs = frame->LocalAt<type>(READ_LOCAL_ID());     \
     auto rhs = frame->LocalAt<type>(READ_LOCAL_ID());     \
     Op##op##_##type(dest, lhs, rhs);                      \
-    DISPATCH_NEXT();                                      \
+    DISPATCH_NEXT_TEST(dest);                             \
   }
 #define GEN_COMPARISON_TYPES(type, ...)     \
   DO_GEN_COMPARISON(GreaterThan, type)      \
@@ -312,7 +350,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     auto *dest = frame->LocalAt<bool *>(READ_LOCAL_ID());
     auto input = frame->LocalAt<bool>(READ_LOCAL_ID());
     OpNot(dest, input);
-    DISPATCH_NEXT();
+    DISPATCH_NEXT_TEST(dest);
   }
 
   OP(NotSql) : {
@@ -329,6 +367,10 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
   OP(Jump) : {
     auto skip = PEEK_JMP_OFFSET();
     if (LIKELY(OpJump())) {
+      // Loops jump back to their header
+      if (skip < 0) {
+        RecordLoopIteration();
+      }
       ip += skip;
     }
     DISPATCH_NEXT();
@@ -364,14 +406,14 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
     auto *input_ptr = frame->LocalAt<const void *>(READ_LOCAL_ID());
     OpIsNullPtr(result, input_ptr);
-    DISPATCH_NEXT();
+    DISPATCH_NEXT_TEST(result);
   }
 
   OP(IsNotNullPtr) : {
     auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
     auto *input_ptr = frame->LocalAt<const void *>(READ_LOCAL_ID());
     OpIsNotNullPtr(result, input_ptr);
-    DISPATCH_NEXT();
+    DISPATCH_NEXT_TEST(result);
   }
 
 #define GEN_DEREF(type, size)                             \
@@ -489,6 +531,38 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(ExecutionContextCheckInterrupt) : {
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    OpExecutionContextCheckInterrupt(exec_ctx);
+    DISPATCH_NEXT();
+  }
+
+  OP(ExecutionContextScaleSampledCount) : {
+    auto *result = frame->LocalAt<sql::Integer *>(READ_LOCAL_ID());
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto *count = frame->LocalAt<const sql::Integer *>(READ_LOCAL_ID());
+    OpExecutionContextScaleSampledCount(result, exec_ctx, count);
+    DISPATCH_NEXT();
+  }
+
+  OP(ExecutionContextScaleSampledDistinct) : {
+    auto *result = frame->LocalAt<sql::Integer *>(READ_LOCAL_ID());
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto *num_distinct = frame->LocalAt<const sql::Integer *>(READ_LOCAL_ID());
+    auto *count = frame->LocalAt<const sql::Integer *>(READ_LOCAL_ID());
+    OpExecutionContextScaleSampledDistinct(result, exec_ctx, num_distinct, count);
+    DISPATCH_NEXT();
+  }
+
+  OP(ExecutionContextAnalyzeColumnGroups) : {
+    auto *result = frame->LocalAt<sql::StringVal *>(READ_LOCAL_ID());
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto table_oid = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    auto col_oid = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpExecutionContextAnalyzeColumnGroups(result, exec_ctx, table_oid, col_oid);
+    DISPATCH_NEXT();
+  }
+
   OP(ExecutionContextInitHooks) : {
     auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
     auto size = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
@@ -540,6 +614,37 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(ExecutionContextStartPipelineProfile) : {
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto pipeline_id = execution::pipeline_id_t{frame->LocalAt<uint32_t>(READ_LOCAL_ID())};
+    OpExecutionContextStartPipelineProfile(exec_ctx, pipeline_id);
+    DISPATCH_NEXT();
+  }
+
+  OP(ExecutionContextEndPipelineProfile) : {
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto pipeline_id = execution::pipeline_id_t{frame->LocalAt<uint32_t>(READ_LOCAL_ID())};
+    OpExecutionContextEndPipelineProfile(exec_ctx, pipeline_id);
+    DISPATCH_NEXT();
+  }
+
+  OP(ExecutionContextRecordOperatorRows) : {
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto pipeline_id = execution::pipeline_id_t{frame->LocalAt<uint32_t>(READ_LOCAL_ID())};
+    auto plan_node_id = planner::plan_node_id_t{frame->LocalAt<int32_t>(READ_LOCAL_ID())};
+    auto num_rows = frame->LocalAt<uint64_t>(READ_LOCAL_ID());
+    OpExecutionContextRecordOperatorRows(exec_ctx, pipeline_id, plan_node_id, num_rows);
+    DISPATCH_NEXT();
+  }
+
+  OP(ExecutionContextCheckCardinality) : {
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto plan_node_id = planner::plan_node_id_t{frame->LocalAt<int32_t>(READ_LOCAL_ID())};
+    auto num_rows = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpExecutionContextCheckCardinality(exec_ctx, plan_node_id, num_rows);
+    DISPATCH_NEXT();
+  }
+
   OP(ExecOUFeatureVectorRecordFeature) : {
     auto *ouvec = frame->LocalAt<selfdriving::ExecOUFeatureVector *>(READ_LOCAL_ID());
     auto pipeline_id = execution::pipeline_id_t{frame->LocalAt<uint32_t>(READ_LOCAL_ID())};
@@ -655,7 +760,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
     auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
     OpTableVectorIteratorNext(has_more, iter);
-    DISPATCH_NEXT();
+    DISPATCH_NEXT_TEST(has_more);
   }
 
   OP(TableVectorIteratorFree) : {
@@ -678,6 +783,44 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(TableVectorIteratorFilterBlocks) : {
+    auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
+    auto col_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    auto min = frame->LocalAt<int64_t>(READ_LOCAL_ID());
+    auto max = frame->LocalAt<int64_t>(READ_LOCAL_ID());
+    OpTableVectorIteratorFilterBlocks(iter, col_idx, min, max);
+    DISPATCH_NEXT();
+  }
+
+  OP(TableVectorIteratorFilterBlocksTopK) : {
+    auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
+    auto col_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    auto *sorter = frame->LocalAt<const sql::Sorter *>(READ_LOCAL_ID());
+    auto descending = frame->LocalAt<bool>(READ_LOCAL_ID());
+    OpTableVectorIteratorFilterBlocksTopK(iter, col_idx, sorter, descending);
+    DISPATCH_NEXT();
+  }
+
+  OP(TableVectorIteratorSampleBlocks) : {
+    auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
+    auto num_blocks = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpTableVectorIteratorSampleBlocks(iter, num_blocks);
+    DISPATCH_NEXT();
+  }
+
+  OP(TableVectorIteratorLateMaterialize) : {
+    auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
+    auto col_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpTableVectorIteratorLateMaterialize(iter, col_idx);
+    DISPATCH_NEXT();
+  }
+
+  OP(TableVectorIteratorFetchLateColumns) : {
+    auto *iter = frame->LocalAt<sql::TableVectorIterator *>(READ_LOCAL_ID());
+    OpTableVectorIteratorFetchLateColumns(iter);
+    DISPATCH_NEXT();
+  }
+
   OP(ParallelScanTable) : {
     auto table_oid = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
     auto col_oids = frame->LocalAt<uint32_t *>(READ_LOCAL_ID());
@@ -735,14 +878,14 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
     auto *iter = frame->LocalAt<sql::VectorProjectionIterator *>(READ_LOCAL_ID());
     OpVPIHasNext(has_more, iter);
-    DISPATCH_NEXT();
+    DISPATCH_NEXT_TEST(has_more);
   }
 
   OP(VPIHasNextFiltered) : {
     auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
     auto *iter = frame->LocalAt<sql::VectorProjectionIterator *>(READ_LOCAL_ID());
     OpVPIHasNextFiltered(has_more, iter);
-    DISPATCH_NEXT();
+    DISPATCH_NEXT_TEST(has_more);
   }
 
   OP(VPIAdvance) : {
@@ -892,7 +1035,15 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
   OP(FilterManagerInit) : {
     auto *filter_manager = frame->LocalAt<sql::FilterManager *>(READ_LOCAL_ID());
     auto *exec_context = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
-    OpFilterManagerInit(filter_manager, exec_context->GetExecutionSettings());
+    OpFilterManagerInit(filter_manager, exec_context);
+    DISPATCH_NEXT();
+  }
+
+  OP(FilterManagerInitWithContext) : {
+    auto *filter_manager = frame->LocalAt<sql::FilterManager *>(READ_LOCAL_ID());
+    auto *exec_context = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto *context = frame->LocalAt<void *>(READ_LOCAL_ID());
+    OpFilterManagerInitWithContext(filter_manager, exec_context, context);
     DISPATCH_NEXT();
   }
 
@@ -959,6 +1110,86 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
 
 #undef GEN_VEC_FILTER
 
+  // ------------------------------------------------------
+  // Vector Expression Executor
+  // ------------------------------------------------------
+
+  OP(VectorProjectionInit) : {
+    auto *vector_projection = frame->LocalAt<sql::VectorProjection *>(READ_LOCAL_ID());
+    auto *col_types = frame->LocalAt<uint32_t *>(READ_LOCAL_ID());
+    auto num_cols = READ_UIMM4();
+    OpVectorProjectionInit(vector_projection, col_types, num_cols);
+    DISPATCH_NEXT();
+  }
+
+  OP(VectorProjectionExtend) : {
+    auto *vector_projection = frame->LocalAt<sql::VectorProjection *>(READ_LOCAL_ID());
+    auto *vpi = frame->LocalAt<sql::VectorProjectionIterator *>(READ_LOCAL_ID());
+    OpVectorProjectionExtend(vector_projection, vpi);
+    DISPATCH_NEXT();
+  }
+
+  OP(VectorProjectionFree) : {
+    auto *vector_projection = frame->LocalAt<sql::VectorProjection *>(READ_LOCAL_ID());
+    OpVectorProjectionFree(vector_projection);
+    DISPATCH_NEXT();
+  }
+
+  OP(VectorCast) : {
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto *vector_projection = frame->LocalAt<sql::VectorProjection *>(READ_LOCAL_ID());
+    auto result_col_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    auto col_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpVectorCast(exec_ctx, vector_projection, result_col_idx, col_idx);
+    DISPATCH_NEXT();
+  }
+
+  OP(VectorDatePart) : {
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto *vector_projection = frame->LocalAt<sql::VectorProjection *>(READ_LOCAL_ID());
+    auto result_col_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    auto col_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    auto part = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpVectorDatePart(exec_ctx, vector_projection, result_col_idx, col_idx, part);
+    DISPATCH_NEXT();
+  }
+
+#define GEN_VEC_ARITHMETIC(BYTECODE)                                                         \
+  OP(BYTECODE) : {                                                                           \
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());              \
+    auto *vector_projection = frame->LocalAt<sql::VectorProjection *>(READ_LOCAL_ID());      \
+    auto result_col_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());                         \
+    auto left_col_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());                           \
+    auto right_col_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());                          \
+    Op##BYTECODE(exec_ctx, vector_projection, result_col_idx, left_col_idx, right_col_idx);  \
+    DISPATCH_NEXT();                                                                         \
+  }                                                                                          \
+  OP(BYTECODE##Val) : {                                                                      \
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());              \
+    auto *vector_projection = frame->LocalAt<sql::VectorProjection *>(READ_LOCAL_ID());      \
+    auto result_col_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());                         \
+    auto left_col_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());                           \
+    auto right_val = frame->LocalAt<sql::Val *>(READ_LOCAL_ID());                            \
+    Op##BYTECODE##Val(exec_ctx, vector_projection, result_col_idx, left_col_idx, right_val); \
+    DISPATCH_NEXT();                                                                         \
+  }
+
+  GEN_VEC_ARITHMETIC(VectorAdd)
+  GEN_VEC_ARITHMETIC(VectorSub)
+  GEN_VEC_ARITHMETIC(VectorMul)
+
+#undef GEN_VEC_ARITHMETIC
+
+  OP(VectorSubFromVal) : {
+    auto *exec_ctx = frame->LocalAt<exec::ExecutionContext *>(READ_LOCAL_ID());
+    auto *vector_projection = frame->LocalAt<sql::VectorProjection *>(READ_LOCAL_ID());
+    auto result_col_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    auto left_val = frame->LocalAt<sql::Val *>(READ_LOCAL_ID());
+    auto right_col_idx = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpVectorSubFromVal(exec_ctx, vector_projection, result_col_idx, left_val, right_col_idx);
+    DISPATCH_NEXT();
+  }
+
   // -------------------------------------------------------
   // SQL Value Creation.
   // -------------------------------------------------------
@@ -967,7 +1198,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
     auto *sql_bool = frame->LocalAt<sql::BoolVal *>(READ_LOCAL_ID());
     OpForceBoolTruth(result, sql_bool);
-    DISPATCH_NEXT();
+    DISPATCH_NEXT_TEST(result);
   }
 
   OP(InitSqlNull) : {
@@ -1013,6 +1244,13 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(InitDateFromJulianDay) : {
+    auto *sql_date = frame->LocalAt<sql::DateVal *>(READ_LOCAL_ID());
+    auto julian_day = frame->LocalAt<int32_t>(READ_LOCAL_ID());
+    OpInitDateFromJulianDay(sql_date, julian_day);
+    DISPATCH_NEXT();
+  }
+
   OP(InitTimestamp) : {
     auto *sql_timestamp = frame->LocalAt<sql::TimestampVal *>(READ_LOCAL_ID());
     auto usec = frame->LocalAt<uint64_t>(READ_LOCAL_ID());
@@ -1251,6 +1489,13 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(AggregationHashTableInternStringKey) : {
+    auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
+    auto *key = frame->LocalAt<sql::StringVal *>(READ_LOCAL_ID());
+    OpAggregationHashTableInternStringKey(agg_hash_table, key);
+    DISPATCH_NEXT();
+  }
+
   OP(AggregationHashTableLookup) : {
     auto *result = frame->LocalAt<byte **>(READ_LOCAL_ID());
     auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
@@ -1263,6 +1508,30 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(AggregationHashTableSetDenseDomain) : {
+    auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
+    auto min_key = frame->LocalAt<int64_t>(READ_LOCAL_ID());
+    auto num_keys = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpAggregationHashTableSetDenseDomain(agg_hash_table, min_key, num_keys);
+    DISPATCH_NEXT();
+  }
+
+  OP(AggregationHashTableLookupDense) : {
+    auto *result = frame->LocalAt<byte **>(READ_LOCAL_ID());
+    auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
+    auto *key = frame->LocalAt<sql::Integer *>(READ_LOCAL_ID());
+    OpAggregationHashTableLookupDense(result, agg_hash_table, key);
+    DISPATCH_NEXT();
+  }
+
+  OP(AggregationHashTableInsertDense) : {
+    auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
+    auto *key = frame->LocalAt<sql::Integer *>(READ_LOCAL_ID());
+    auto *payload = frame->LocalAt<byte *>(READ_LOCAL_ID());
+    OpAggregationHashTableInsertDense(agg_hash_table, key, payload);
+    DISPATCH_NEXT();
+  }
+
   OP(AggregationHashTableProcessBatch) : {
     auto *agg_hash_table = frame->LocalAt<sql::AggregationHashTable *>(READ_LOCAL_ID());
     auto *vpi = frame->LocalAt<sql::VectorProjectionIterator *>(READ_LOCAL_ID());
@@ -1346,7 +1615,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
     auto *iter = frame->LocalAt<sql::AHTIterator *>(READ_LOCAL_ID());
     OpAggregationHashTableIteratorHasNext(has_more, iter);
-    DISPATCH_NEXT();
+    DISPATCH_NEXT_TEST(has_more);
   }
 
   OP(AggregationHashTableIteratorNext) : {
@@ -1372,7 +1641,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
     auto *overflow_iter = frame->LocalAt<sql::AHTOverflowPartitionIterator *>(READ_LOCAL_ID());
     OpAggregationOverflowPartitionIteratorHasNext(has_more, overflow_iter);
-    DISPATCH_NEXT();
+    DISPATCH_NEXT_TEST(has_more);
   }
 
   OP(AggregationOverflowPartitionIteratorNext) : {
@@ -1451,6 +1720,21 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
 
 #undef GEN_COUNT_AGG
 
+  OP(CountAggregateAdvanceVector) : {
+    auto *agg = frame->LocalAt<sql::CountAggregate *>(READ_LOCAL_ID());
+    auto *vpi = frame->LocalAt<sql::VectorProjectionIterator *>(READ_LOCAL_ID());
+    auto col_idx = READ_UIMM4();
+    OpCountAggregateAdvanceVector(agg, vpi, col_idx);
+    DISPATCH_NEXT();
+  }
+
+  OP(CountAggregateAdvanceTuples) : {
+    auto *agg = frame->LocalAt<sql::CountAggregate *>(READ_LOCAL_ID());
+    auto *vpi = frame->LocalAt<sql::VectorProjectionIterator *>(READ_LOCAL_ID());
+    OpCountAggregateAdvanceTuples(agg, vpi);
+    DISPATCH_NEXT();
+  }
+
 #define GEN_AGGREGATE(SQL_TYPE, AGG_TYPE)                            \
   OP(AGG_TYPE##Init) : {                                             \
     auto *agg = frame->LocalAt<sql::AGG_TYPE *>(READ_LOCAL_ID());    \
@@ -1499,6 +1783,24 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
 
 #undef GEN_AGGREGATE
 
+#define GEN_VECTOR_AGGREGATE(AGG_TYPE)                                            \
+  OP(AGG_TYPE##AdvanceVector) : {                                                 \
+    auto *agg = frame->LocalAt<sql::AGG_TYPE *>(READ_LOCAL_ID());                 \
+    auto *vpi = frame->LocalAt<sql::VectorProjectionIterator *>(READ_LOCAL_ID()); \
+    auto col_idx = READ_UIMM4();                                                  \
+    Op##AGG_TYPE##AdvanceVector(agg, vpi, col_idx);                               \
+    DISPATCH_NEXT();                                                              \
+  }
+
+  GEN_VECTOR_AGGREGATE(IntegerSumAggregate);
+  GEN_VECTOR_AGGREGATE(IntegerMaxAggregate);
+  GEN_VECTOR_AGGREGATE(IntegerMinAggregate);
+  GEN_VECTOR_AGGREGATE(RealSumAggregate);
+  GEN_VECTOR_AGGREGATE(RealMaxAggregate);
+  GEN_VECTOR_AGGREGATE(RealMinAggregate);
+
+#undef GEN_VECTOR_AGGREGATE
+
   OP(AvgAggregateInit) : {
     auto *agg = frame->LocalAt<sql::AvgAggregate *>(READ_LOCAL_ID());
     OpAvgAggregateInit(agg);
@@ -1647,6 +1949,60 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(JoinHashTableEnableSpilling) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto probe_tuple_size = frame->LocalAt<uint32_t>(READ_LOCAL_ID());
+    OpJoinHashTableEnableSpilling(join_hash_table, probe_tuple_size);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableIsSpilled) : {
+    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto hash_val = frame->LocalAt<hash_t>(READ_LOCAL_ID());
+    OpJoinHashTableIsSpilled(result, join_hash_table, hash_val);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableEnableRuntimeFilter) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableEnableRuntimeFilter(join_hash_table);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableEnableCompactLayout) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    OpJoinHashTableEnableCompactLayout(join_hash_table);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableMayContain) : {
+    auto *result = frame->LocalAt<bool *>(READ_LOCAL_ID());
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto hash_val = frame->LocalAt<hash_t>(READ_LOCAL_ID());
+    OpJoinHashTableMayContain(result, join_hash_table, hash_val);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableSpillProbe) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto hash_val = frame->LocalAt<hash_t>(READ_LOCAL_ID());
+    auto *probe_tuple = frame->LocalAt<const byte *>(READ_LOCAL_ID());
+    OpJoinHashTableSpillProbe(join_hash_table, hash_val, probe_tuple);
+    DISPATCH_NEXT();
+  }
+
+  OP(JoinHashTableProcessSpilled) : {
+    auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
+    auto *query_state = frame->LocalAt<void *>(READ_LOCAL_ID());
+    auto *pipeline_state = frame->LocalAt<void *>(READ_LOCAL_ID());
+    auto probe_fn_id = READ_FUNC_ID();
+
+    auto probe_fn = reinterpret_cast<sql::JoinHashTable::SpilledProbeFn>(module_->GetRawFunctionImpl(probe_fn_id));
+    OpJoinHashTableProcessSpilled(join_hash_table, query_state, pipeline_state, probe_fn);
+    DISPATCH_NEXT();
+  }
+
   OP(JoinHashTableFree) : {
     auto *join_hash_table = frame->LocalAt<sql::JoinHashTable *>(READ_LOCAL_ID());
     OpJoinHashTableFree(join_hash_table);
@@ -1657,7 +2013,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     auto *has_next = frame->LocalAt<bool *>(READ_LOCAL_ID());
     auto *ht_entry_iter = frame->LocalAt<sql::HashTableEntryIterator *>(READ_LOCAL_ID());
     OpHashTableEntryIteratorHasNext(has_next, ht_entry_iter);
-    DISPATCH_NEXT();
+    DISPATCH_NEXT_TEST(has_next);
   }
 
   OP(HashTableEntryIteratorGetRow) : {
@@ -1678,7 +2034,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
     auto *iter = frame->LocalAt<sql::JoinHashTableIterator *>(READ_LOCAL_ID());
     OpJoinHashTableIteratorHasNext(has_more, iter);
-    DISPATCH_NEXT();
+    DISPATCH_NEXT_TEST(has_more);
   }
 
   OP(JoinHashTableIteratorNext) : {
@@ -1715,6 +2071,31 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(SorterSetNormalizedKey) : {
+    auto *sorter = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
+    auto key_func_id = READ_FUNC_ID();
+
+    auto key_fn = reinterpret_cast<sql::Sorter::NormalizedKeyFunction>(module_->GetRawFunctionImpl(key_func_id));
+    OpSorterSetNormalizedKey(sorter, key_fn);
+    DISPATCH_NEXT();
+  }
+
+#define GEN_SORTER_NORMALIZE_KEY(NAME, CPP_TYPE)                      \
+  OP(SorterNormalizeKey##NAME) : {                                    \
+    auto *result = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());       \
+    auto *input = frame->LocalAt<const CPP_TYPE *>(READ_LOCAL_ID());  \
+    OpSorterNormalizeKey##NAME(result, input);                        \
+    DISPATCH_NEXT();                                                  \
+  }
+
+  GEN_SORTER_NORMALIZE_KEY(Int, sql::Integer)
+  GEN_SORTER_NORMALIZE_KEY(Bool, sql::BoolVal)
+  GEN_SORTER_NORMALIZE_KEY(Real, sql::Real)
+  GEN_SORTER_NORMALIZE_KEY(Date, sql::DateVal)
+  GEN_SORTER_NORMALIZE_KEY(Timestamp, sql::TimestampVal)
+  GEN_SORTER_NORMALIZE_KEY(String, sql::StringVal)
+#undef GEN_SORTER_NORMALIZE_KEY
+
   OP(SorterGetTupleCount) : {
     auto *result = frame->LocalAt<uint32_t *>(READ_LOCAL_ID());
     auto *sorter = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
@@ -1744,6 +2125,20 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(SorterShareTopKBound) : {
+    auto *sorter = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
+    auto *other = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
+    OpSorterShareTopKBound(sorter, other);
+    DISPATCH_NEXT();
+  }
+
+  OP(SorterGetTopKBound) : {
+    auto *result = frame->LocalAt<uint64_t *>(READ_LOCAL_ID());
+    auto *sorter = frame->LocalAt<const sql::Sorter *>(READ_LOCAL_ID());
+    OpSorterGetTopKBound(result, sorter);
+    DISPATCH_NEXT();
+  }
+
   OP(SorterSort) : {
     auto *sorter = frame->LocalAt<sql::Sorter *>(READ_LOCAL_ID());
     OpSorterSort(sorter);
@@ -1784,7 +2179,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
     auto *iter = frame->LocalAt<sql::SorterIterator *>(READ_LOCAL_ID());
     OpSorterIteratorHasNext(has_more, iter);
-    DISPATCH_NEXT();
+    DISPATCH_NEXT_TEST(has_more);
   }
 
   OP(SorterIteratorNext) : {
@@ -1866,7 +2261,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
     auto *reader = frame->LocalAt<util::CSVReader *>(READ_LOCAL_ID());
     OpCSVReaderAdvance(has_more, reader);
-    DISPATCH_NEXT();
+    DISPATCH_NEXT_TEST(has_more);
   }
 
   OP(CSVReaderGetField) : {
@@ -1945,6 +2340,17 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     DISPATCH_NEXT();
   }
 
+  OP(ParallelScanIndex) : {
+    auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
+    auto scan_type = frame->LocalAt<storage::index::ScanType>(READ_LOCAL_ID());
+    auto query_state = frame->LocalAt<void *>(READ_LOCAL_ID());
+    auto scan_fn_id = READ_FUNC_ID();
+
+    auto scan_fn = reinterpret_cast<sql::IndexIterator::ScanFn>(module_->GetRawFunctionImpl(scan_fn_id));
+    OpParallelScanIndex(iter, scan_type, query_state, scan_fn);
+    DISPATCH_NEXT();
+  }
+
   OP(IndexIteratorFree) : {
     auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
     OpIndexIteratorFree(iter);
@@ -1955,7 +2361,7 @@ void VM::Interpret(const uint8_t *ip, Frame *frame) {  // NOLINT
     auto *has_more = frame->LocalAt<bool *>(READ_LOCAL_ID());
     auto *iter = frame->LocalAt<sql::IndexIterator *>(READ_LOCAL_ID());
     OpIndexIteratorAdvance(has_more, iter);
-    DISPATCH_NEXT();
+    DISPATCH_NEXT_TEST(has_more);
   }
 
   OP(IndexIteratorGetPR) : {
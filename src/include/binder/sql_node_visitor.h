@@ -15,6 +15,7 @@ class DeleteStatement;
 class DropStatement;
 class ExplainStatement;
 class PrepareStatement;
+class RefreshStatement;
 class ExecuteStatement;
 class TransactionStatement;
 class UpdateStatement;
@@ -118,6 +119,12 @@ class SqlNodeVisitor {
    */
   virtual void Visit(common::ManagedPointer<parser::PrepareStatement> node) {}
 
+  /**
+   * Visitor pattern for RefreshStatement.
+   * @param node node to be visited
+   */
+  virtual void Visit(common::ManagedPointer<parser::RefreshStatement> node) {}
+
   /**
    * Visitor pattern for SelectStatement.
    * @param node node to be visited
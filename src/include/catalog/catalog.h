@@ -109,6 +109,13 @@ class Catalog {
    */
   db_oid_t GetDatabaseOid(common::ManagedPointer<transaction::TransactionContext> txn, const std::string &name);
 
+  /**
+   * Get the OIDs of all databases visible to the transaction.
+   * @param txn for the catalog query
+   * @return OIDs of all visible databases
+   */
+  std::vector<db_oid_t> GetDatabaseOids(common::ManagedPointer<transaction::TransactionContext> txn);
+
   /**
    * Gets the database-specific catalog object.
    * @param txn for the catalog query
@@ -123,7 +130,7 @@ class Catalog {
    * Creates a new accessor into the catalog which will handle transactionality and sequencing of catalog operations.
    * @param txn for all subsequent catalog queries
    * @param database in which this transaction is scoped
-   * @param cache CatalogCache object for this connection, or nullptr if disabled
+   * @param cache CatalogCache shared by all connections, or nullptr if disabled
    * @return a CatalogAccessor object for use with this transaction
    */
   std::unique_ptr<CatalogAccessor> GetAccessor(common::ManagedPointer<transaction::TransactionContext> txn,
@@ -2,10 +2,12 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "catalog/catalog_cache.h"
 #include "catalog/catalog_defs.h"
 #include "catalog/postgres/pg_namespace.h"
 #include "catalog/postgres/pg_proc.h"
@@ -33,7 +35,6 @@ class TransactionContext;
 namespace noisepage::catalog {
 class Catalog;
 class DatabaseCatalog;
-class CatalogCache;
 class IndexSchema;
 
 /**
@@ -88,10 +89,18 @@ class EXPORT CatalogAccessor {
    */
   namespace_oid_t GetDefaultNamespace() const { return default_namespace_; }
 
+  /**
+   * Sets the temporary namespace of the connection. It is searched right after pg_catalog, like in Postgres, and
+   * TEMP_NAMESPACE_ALIAS refers to it. It does not become the default namespace.
+   * @param ns_oid the temporary namespace
+   */
+  void SetTempNamespace(namespace_oid_t ns_oid);
+
   /**
    * Given a namespace name, resolve it to the corresponding OID
    * @param name of the namespace
-   * @return OID of the namespace, INVALID_NAMESPACE_OID if the namespace was not found
+   * @return OID of the namespace, INVALID_NAMESPACE_OID if the namespace was not found. TEMP_NAMESPACE_ALIAS resolves
+   *         to the temporary namespace, if one was set.
    */
   namespace_oid_t GetNamespaceOid(std::string name) const;
 
@@ -131,6 +140,7 @@ class EXPORT CatalogAccessor {
    * @param ns in which the new table will exist
    * @param name of the new table
    * @param schema object describing the new table
+   * @param view_definition the query of a materialized view, whose rows the new table holds
    * @return OID for the table, INVALID_TABLE_OID if the table already exists
    * @warning The catalog accessor assumes it takes ownership of the schema object
    * that is passed.  As such, there is no guarantee that the pointer is still
@@ -138,7 +148,8 @@ class EXPORT CatalogAccessor {
    * schema object after this call, they should use the GetSchema function to
    * obtain the authoritative schema for this table.
    */
-  table_oid_t CreateTable(namespace_oid_t ns, std::string name, const Schema &schema) const;
+  table_oid_t CreateTable(namespace_oid_t ns, std::string name, const Schema &schema,
+                          const std::optional<std::string> &view_definition = std::nullopt) const;
 
   /**
    * Rename the table from its current string to the new one.  The renaming could fail
@@ -199,6 +210,14 @@ class EXPORT CatalogAccessor {
    */
   const Schema &GetSchema(table_oid_t table) const;
 
+  /**
+   * Get the query of a materialized view.
+   * @param table the table holding the rows of the view, this must be a valid oid from GetTableOid. Invalid input will
+   * trigger an assert
+   * @return the query as it was written, nullopt if the table is not a materialized view
+   */
+  std::optional<std::string> GetViewDefinition(table_oid_t table) const;
+
   /**
    * A list of all constraints on this table
    * @param table being queried, this must be a valid oid from GetTableOid. Invalid input will trigger an assert
@@ -282,6 +301,21 @@ class EXPORT CatalogAccessor {
    */
   common::ManagedPointer<storage::index::Index> GetIndex(index_oid_t index) const;
 
+  /**
+   * Mark whether an index holds every tuple of its table. Writers maintain an index whether or not it is valid, but
+   * lookups must only go through valid indexes. An index is valid when it is created.
+   * @param index this must be a valid oid from GetIndexOid. Invalid input will trigger an assert
+   * @param valid whether the index is valid
+   * @return whether the operation succeeded
+   */
+  bool SetIndexValid(index_oid_t index, bool valid) const;
+
+  /**
+   * @param index this must be a valid oid from GetIndexOid. Invalid input will trigger an assert
+   * @return whether lookups may go through the index
+   */
+  bool IsIndexValid(index_oid_t index) const;
+
   /**
    * Adds a language to the catalog (with default parameters for now) if
    * it doesn't exist in pg_language already
@@ -395,19 +429,19 @@ class EXPORT CatalogAccessor {
    * @param catalog pointer to the catalog being accessed
    * @param dbc pointer to the database catalog being accessed
    * @param txn the transaction context for this accessor
-   * @param cache CatalogCache object for this connection, or nullptr if disabled
+   * @param cache Version of the CatalogCache that this transaction shares, or nullptr if disabled
    * @warning This constructor should never be called directly.  Instead you should get accessors from the catalog.
    */
   CatalogAccessor(const common::ManagedPointer<Catalog> catalog, const common::ManagedPointer<DatabaseCatalog> dbc,
                   const common::ManagedPointer<transaction::TransactionContext> txn,
-                  const common::ManagedPointer<CatalogCache> cache)
+                  std::shared_ptr<CatalogCache::Version> cache)
       : catalog_(catalog),
         dbc_(dbc),
         txn_(txn),
         search_path_({postgres::PgNamespace::NAMESPACE_CATALOG_NAMESPACE_OID,
                       postgres::PgNamespace::NAMESPACE_DEFAULT_NAMESPACE_OID}),
         default_namespace_(postgres::PgNamespace::NAMESPACE_DEFAULT_NAMESPACE_OID),
-        cache_(cache) {}
+        cache_(std::move(cache)) {}
 
  private:
   const common::ManagedPointer<Catalog> catalog_;
@@ -415,7 +449,14 @@ class EXPORT CatalogAccessor {
   const common::ManagedPointer<transaction::TransactionContext> txn_;
   std::vector<namespace_oid_t> search_path_;
   namespace_oid_t default_namespace_;
-  const common::ManagedPointer<CatalogCache> cache_ = nullptr;
+  namespace_oid_t temp_namespace_ = INVALID_NAMESPACE_OID;
+  const std::shared_ptr<CatalogCache::Version> cache_ = nullptr;
+
+  /**
+   * The cached lookups are only valid for the catalog as it was before this transaction changed it.
+   * @return the Version of the CatalogCache to look in, nullptr if there is none or this txn made DDL changes
+   */
+  CatalogCache::Version *SharedCache() const;
 
   /**
    * A helper function to ensure that user-defined object names are standardized prior to doing catalog operations
@@ -1,13 +1,21 @@
 #pragma once
 
+#include <memory>
+#include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog_defs.h"
+#include "common/container/concurrent_map.h"
 #include "common/managed_pointer.h"
+#include "common/spin_latch.h"
 #include "transaction/transaction_defs.h"
 
+namespace noisepage::execution::functions {
+class FunctionContext;
+}  // namespace noisepage::execution::functions
+
 namespace noisepage::storage {
 class SqlTable;
 namespace index {
@@ -17,91 +25,85 @@ class Index;
 
 namespace noisepage::catalog {
 class CatalogAccessor;
+class IndexSchema;
+class Schema;
 
 /**
- * Simple cache for DatabaseCatalog lookups that's scoped per connection (ownership and lifecycle). This is designed to
+ * Process-wide cache for DatabaseCatalog lookups, shared by the transactions of all connections. This is designed to
  * be injected as a dependency of CatalogAccessor at its instantiation, and components requesting information from the
- * CatalogAccessor will transparently look in a cache first if it exists. If the cache is passed in as nullptr, then the
- * CatalogAccessor performs its lookup from the DatabaseCatalog as normal. Most operations are expected to only be
- * performed by CatalogAccessor, which is why most of this class is private and the CatalogAccessor is designated as a
- * friend class.
+ * CatalogAccessor will transparently look in the cache first if it exists. If the cache is passed in as nullptr, then
+ * the CatalogAccessor performs its lookup from the DatabaseCatalog as normal.
+ *
+ * The cache keeps one Version of every database: the lookups as of the last DDL change committed in that database.
+ * A txn shares the Version only if it started after that change committed, because then it sees exactly the catalog
+ * that the Version is filled from, and the Version never has to be invalidated. The first txn that starts after the
+ * next DDL commit replaces it with a new, empty Version, while the txns still reading the old Version keep it alive
+ * until they are done. A txn stops using its Version once it makes a DDL change of its own.
  *
- * Right now it only caches lookups for table and index pointers, and indexes on a table. In the future if we see other
- * DatabaseCatalog requests proving expensive, we can add them to the cache.
+ * It caches table and index pointers, their schemas, the indexes on a table and whether they are valid, procedure oids
+ * and function contexts.
+ * Lookups in a Version don't take any locks, and entries are only ever added to it, so two threads that both missed
+ * the cache may both insert the same entry and the first one wins.
  */
 class CatalogCache {
  public:
   /**
-   * Clear the cache, and stash a timestamp associated with the start time of the transaction that cleared it. This acts
-   * as a watermark for when this snapshot of the DatabaseCatalog is valid.
-   * @param now start time of the TransactionContext performing the reset
+   * The cached lookups of one database as of one committed DDL change. Only the CatalogAccessor reads and fills it.
    */
-  void Reset(const transaction::timestamp_t now) {
-    oldest_entry_ = now;
-    pointers_.clear();
-    indexes_.clear();
-  }
+  class Version {
+   public:
+    /**
+     * @param ddl_commit_time commit time of the DDL change that the cached lookups are as of
+     */
+    explicit Version(const transaction::timestamp_t ddl_commit_time) : ddl_commit_time_(ddl_commit_time) {}
 
-  /**
-   * @return The oldest possible age of an entry in this cache, corresponding to the last cache reset
-   */
-  transaction::timestamp_t OldestEntry() const { return oldest_entry_; }
-
- private:
-  common::ManagedPointer<storage::SqlTable> GetTable(const table_oid_t table) {
-    const auto key = table.UnderlyingValue();
-    const auto it = pointers_.find(key);
-    if (it != pointers_.end()) {
-      const auto value = it->second;
-      return common::ManagedPointer(reinterpret_cast<storage::SqlTable *>(value));
-    }
-    return nullptr;
-  }
+    /**
+     * @return commit time of the DDL change that the cached lookups are as of
+     */
+    transaction::timestamp_t DDLCommitTime() const { return ddl_commit_time_; }
 
-  void PutTable(const table_oid_t table, const common::ManagedPointer<storage::SqlTable> table_ptr) {
-    const auto key = table.UnderlyingValue();
-    const auto value = reinterpret_cast<uintptr_t>(table_ptr.Get());
-    NOISEPAGE_ASSERT(pointers_.count(key) == 0, "Shouldn't be inserting something that already exists.");
-    pointers_[key] = value;
-  }
+   private:
+    friend class CatalogAccessor;
 
-  common::ManagedPointer<storage::index::Index> GetIndex(const index_oid_t index) {
-    const auto key = index.UnderlyingValue();
-    const auto it = pointers_.find(key);
-    if (it != pointers_.end()) {
-      const auto value = it->second;
-      return common::ManagedPointer(reinterpret_cast<storage::index::Index *>(value));
+    // Find a cached value, returns false if there is none
+    template <typename K, typename V>
+    static bool Get(const common::ConcurrentMap<K, V> &map, const K &key, V *const value) {
+      const auto it = map.Find(key);
+      if (it == map.cend()) return false;
+      *value = it->second;
+      return true;
     }
-    return nullptr;
-  }
 
-  void PutIndex(const index_oid_t index, const common::ManagedPointer<storage::index::Index> index_ptr) {
-    const auto key = index.UnderlyingValue();
-    const auto value = reinterpret_cast<uintptr_t>(index_ptr.Get());
-    NOISEPAGE_ASSERT(pointers_.count(key) == 0, "Shouldn't be inserting something that already exists.");
-    pointers_[key] = value;
-  }
+    const transaction::timestamp_t ddl_commit_time_;
+    common::ConcurrentMap<table_oid_t, storage::SqlTable *> tables_;
+    common::ConcurrentMap<table_oid_t, const Schema *> schemas_;
+    common::ConcurrentMap<table_oid_t, std::vector<index_oid_t>> index_oids_;
+    common::ConcurrentMap<index_oid_t, storage::index::Index *> indexes_;
+    common::ConcurrentMap<index_oid_t, const IndexSchema *> index_schemas_;
+    common::ConcurrentMap<index_oid_t, bool> index_valid_;
+    // Keyed by the namespace, name and argument types of the procedure, @see CatalogAccessor::GetProcOid
+    common::ConcurrentMap<std::string, proc_oid_t> proc_oids_;
+    common::ConcurrentMap<proc_oid_t, execution::functions::FunctionContext *> function_contexts_;
+  };
 
-  std::pair<bool, std::vector<index_oid_t>> GetIndexOids(const table_oid_t table) {
-    const auto it = indexes_.find(table);
-    if (it != indexes_.end()) {
-      // return true to indicate table was found, but list could still be empty
-      return {true, it->second};
+  /**
+   * Get the Version of a database that a txn can share.
+   * @param db database the txn runs in
+   * @param ddl_commit_time commit time of the last DDL change in the database, which committed before the txn started
+   * @return the Version as of that change, nullptr if a newer Version replaced it already
+   */
+  std::shared_ptr<Version> GetVersion(const db_oid_t db, const transaction::timestamp_t ddl_commit_time) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    auto &version = versions_[db];
+    if (version == nullptr || version->DDLCommitTime() < ddl_commit_time) {
+      version = std::make_shared<Version>(ddl_commit_time);
     }
-    // return false to indidcate table was not found
-    return {false, {}};
+    return version->DDLCommitTime() == ddl_commit_time ? version : nullptr;
   }
 
-  void PutIndexOids(const table_oid_t table, std::vector<index_oid_t> indexes) {
-    NOISEPAGE_ASSERT(indexes_.count(table) == 0, "Shouldn't be inserting something that already exists.");
-    indexes_[table] = std::move(indexes);
-  }
-
-  friend class CatalogAccessor;
-
-  std::unordered_map<uint32_t, uintptr_t> pointers_;
-  std::unordered_map<table_oid_t, std::vector<index_oid_t>> indexes_;
-  transaction::timestamp_t oldest_entry_ = transaction::INITIAL_TXN_TIMESTAMP;
+ private:
+  std::unordered_map<db_oid_t, std::shared_ptr<Version>> versions_;
+  common::SpinLatch latch_;
 };
 
 }  // namespace noisepage::catalog
@@ -40,5 +40,7 @@ constexpr type_oid_t INVALID_TYPE_OID = type_oid_t(NULL_OID);
 constexpr view_oid_t INVALID_VIEW_OID = view_oid_t(NULL_OID);
 
 constexpr char DEFAULT_DATABASE[] = "noisepage";
+/** Name that refers to the temporary namespace of the connection, as in Postgres */
+constexpr char TEMP_NAMESPACE_ALIAS[] = "pg_temp";
 
 }  // namespace noisepage::catalog
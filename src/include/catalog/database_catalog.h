@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -56,9 +57,10 @@ class DatabaseCatalog {
   /** @brief Get the OID of the specified namespace. @see PgCoreImpl::GetNamespaceOid */
   namespace_oid_t GetNamespaceOid(common::ManagedPointer<transaction::TransactionContext> txn, const std::string &name);
 
-  /** @brief Create a new table, may fail with INVALID_TABLE_OID. @see PgCoreImpl::CreateTable */
+  /** @brief Create a new table, may fail with INVALID_TABLE_OID. @see PgCoreImpl::CreateTableEntry */
   table_oid_t CreateTable(common::ManagedPointer<transaction::TransactionContext> txn, namespace_oid_t ns,
-                          const std::string &name, const Schema &schema);
+                          const std::string &name, const Schema &schema,
+                          const std::optional<std::string> &view_definition = std::nullopt);
   /** @brief Delete the specified table. @see PgCoreImpl::DeleteTable */
   bool DeleteTable(common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table);
   /** @brief Rename a table. @see PgCoreImpl::RenameTable */
@@ -103,6 +105,9 @@ class DatabaseCatalog {
   index_oid_t GetIndexOid(common::ManagedPointer<transaction::TransactionContext> txn, namespace_oid_t ns,
                           const std::string &name);
 
+  /** @brief Get the OIDs of all REGULAR_TABLEs in this database. @see PgCoreImpl::GetTableOids */
+  std::vector<table_oid_t> GetTableOids(common::ManagedPointer<transaction::TransactionContext> txn);
+
   /** @brief Get the storage pointer for the specified table, or nullptr if no such REGULAR_TABLE exists. */
   common::ManagedPointer<storage::SqlTable> GetTable(common::ManagedPointer<transaction::TransactionContext> txn,
                                                      table_oid_t table);
@@ -114,6 +119,9 @@ class DatabaseCatalog {
   const Schema &GetSchema(common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table);
   /** @brief Get the index schema for the specified index. */
   const IndexSchema &GetIndexSchema(common::ManagedPointer<transaction::TransactionContext> txn, index_oid_t index);
+  /** @brief Get the query of the specified materialized view. @see PgCoreImpl::GetViewDefinition */
+  std::optional<std::string> GetViewDefinition(common::ManagedPointer<transaction::TransactionContext> txn,
+                                               table_oid_t table);
 
   /**
    * @brief Update the schema of the table.
@@ -121,6 +129,7 @@ class DatabaseCatalog {
    * Apply a new schema to the given table.
    * The changes will modify the latest schema as provided by the catalog.
    * There is no guarantee that the OIDs for modified columns will be stable across a schema change.
+   * Only dropping columns is supported so far, which does not touch the tuples. @see PgCoreImpl::UpdateSchema
    *
    * @param txn         The transaction to update the table's schema in.
    * @param table       The table whose schema should be updated.
@@ -141,6 +150,10 @@ class DatabaseCatalog {
   bool DeleteIndex(common::ManagedPointer<transaction::TransactionContext> txn, index_oid_t index);
   /** @brief Get all of the index OIDs for a specific table. @see PgCoreImpl::GetIndexOids */
   std::vector<index_oid_t> GetIndexOids(common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table);
+  /** @brief Set whether lookups may go through an index. @see PgCoreImpl::SetIndexValid */
+  bool SetIndexValid(common::ManagedPointer<transaction::TransactionContext> txn, index_oid_t index, bool valid);
+  /** @brief Get whether lookups may go through an index. @see PgCoreImpl::IsIndexValid */
+  bool IsIndexValid(common::ManagedPointer<transaction::TransactionContext> txn, index_oid_t index);
   /** @brief More efficient way of getting all the indexes for a specific table. @see PgCoreImpl::GetIndexes */
   std::vector<std::pair<common::ManagedPointer<storage::index::Index>, const IndexSchema &>> GetIndexes(
       common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table);
@@ -207,6 +220,7 @@ class DatabaseCatalog {
   friend class postgres::PgStatisticImpl;
   ///@}
   friend class Catalog;                   ///< Accesses write_lock_ (creating accessor) and TearDown (cleanup).
+  friend class CatalogAccessor;           ///< Accesses write_lock_ (bypassing the CatalogCache after DDL changes).
   friend class postgres::Builder;         ///< Initializes DatabaseCatalog's tables.
   friend class storage::RecoveryManager;  ///< Directly modifies DatabaseCatalog's tables.
 
@@ -279,7 +293,8 @@ class DatabaseCatalog {
    * @see   PgCoreImpl::CreateTableEntry
    */
   bool CreateTableEntry(common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table_oid,
-                        namespace_oid_t ns_oid, const std::string &name, const Schema &schema);
+                        namespace_oid_t ns_oid, const std::string &name, const Schema &schema,
+                        const std::optional<std::string> &view_definition = std::nullopt);
   /**
    * @brief Create a new table entry WITHOUT TAKING THE DDL LOCK. Used by other members of DatabaseCatalog.
    * @see   PgCoreImpl::CreateIndexEntry
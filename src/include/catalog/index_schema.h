@@ -282,6 +282,49 @@ class IndexSchema {
 
   IndexSchema() = default;
 
+  /**
+   * Overrides default copy constructor to ensure we do a deep copy on the predicate
+   * @param other index schema to be copied
+   */
+  IndexSchema(const IndexSchema &other)
+      : columns_(other.columns_),
+        type_(other.type_),
+        indexed_oids_(other.indexed_oids_),
+        is_unique_(other.is_unique_),
+        is_primary_(other.is_primary_),
+        is_exclusion_(other.is_exclusion_),
+        is_immediate_(other.is_immediate_),
+        predicate_(other.predicate_ == nullptr ? nullptr : other.predicate_->Copy()) {}
+
+  /**
+   * Allows operator= to call IndexSchema's custom copy-constructor.
+   * @param other index schema to be copied
+   * @return the current index schema after update
+   */
+  IndexSchema &operator=(const IndexSchema &other) {
+    columns_ = other.columns_;
+    type_ = other.type_;
+    indexed_oids_ = other.indexed_oids_;
+    is_unique_ = other.is_unique_;
+    is_primary_ = other.is_primary_;
+    is_exclusion_ = other.is_exclusion_;
+    is_immediate_ = other.is_immediate_;
+    predicate_ = other.predicate_ == nullptr ? nullptr : other.predicate_->Copy();
+    return *this;
+  }
+
+  /** Move constructor */
+  IndexSchema(IndexSchema &&other) = default;
+
+  /**
+   * Move assignment
+   * @param other index schema to be moved
+   * @return the current index schema after update
+   */
+  IndexSchema &operator=(IndexSchema &&other) = default;
+
+  ~IndexSchema() = default;
+
   /**
    * @return the columns which define the index's schema
    */
@@ -329,6 +372,19 @@ class IndexSchema {
    */
   bool Immediate() const { return is_immediate_; }
 
+  /**
+   * @return the predicate of a partial index, which a tuple must satisfy to have an entry in the index. nullptr if the
+   * index covers every tuple of the table.
+   */
+  common::ManagedPointer<const parser::AbstractExpression> Predicate() const {
+    return common::ManagedPointer(static_cast<const parser::AbstractExpression *>(predicate_.get()));
+  }
+
+  /**
+   * @param predicate that makes this a partial index, or nullptr to index every tuple
+   */
+  void SetPredicate(std::unique_ptr<parser::AbstractExpression> predicate) { predicate_ = std::move(predicate); }
+
   /**
    * @return the backend that should be used to implement this index
    */
@@ -411,6 +467,7 @@ class IndexSchema {
     hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(is_primary_));
     hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(is_exclusion_));
     hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(is_immediate_));
+    if (predicate_ != nullptr) hash = common::HashUtil::CombineHashes(hash, predicate_->Hash());
     return hash;
   }
 
@@ -427,6 +484,8 @@ class IndexSchema {
     if (is_immediate_ != rhs.is_immediate_) return false;
     // TODO(Ling): Does column order matter for compare equal?
     if (indexed_oids_ != rhs.indexed_oids_) return false;
+    if ((predicate_ == nullptr) != (rhs.predicate_ == nullptr)) return false;
+    if (predicate_ != nullptr && *predicate_ != *rhs.predicate_) return false;
     return columns_ == rhs.columns_;
   }
 
@@ -451,6 +510,7 @@ class IndexSchema {
   bool is_primary_;
   bool is_exclusion_;
   bool is_immediate_;
+  std::unique_ptr<parser::AbstractExpression> predicate_;
 };
 
 DEFINE_JSON_HEADER_DECLARATIONS(IndexSchema::Column);
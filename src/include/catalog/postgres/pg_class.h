@@ -60,11 +60,13 @@ class PgClass {
   static constexpr CatalogColumnDef<storage::SqlTable *, uint64_t> REL_PTR{
       col_oid_t{6}};  // BIGINT (assumes 64-bit pointers)
   static constexpr CatalogColumnDef<col_oid_t, uint32_t> REL_NEXTCOLOID{col_oid_t{7}};  // INTEGER
+  static constexpr CatalogColumnDef<storage::VarlenEntry> REL_VIEWDEF{col_oid_t{8}};      // VARCHAR (nullable)
 
-  static constexpr uint8_t NUM_PG_CLASS_COLS = 7;
+  static constexpr uint8_t NUM_PG_CLASS_COLS = 8;
 
   static constexpr std::array<col_oid_t, NUM_PG_CLASS_COLS> PG_CLASS_ALL_COL_OIDS = {
-      RELOID.oid_, RELNAME.oid_, RELNAMESPACE.oid_, RELKIND.oid_, REL_SCHEMA.oid_, REL_PTR.oid_, REL_NEXTCOLOID.oid_};
+      RELOID.oid_,     RELNAME.oid_, RELNAMESPACE.oid_,   RELKIND.oid_,
+      REL_SCHEMA.oid_, REL_PTR.oid_, REL_NEXTCOLOID.oid_, REL_VIEWDEF.oid_};
 };
 
 }  // namespace noisepage::catalog::postgres
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -157,10 +158,12 @@ class PgCoreImpl {
    * @param ns_oid      The OID of the namespace to create a table in.
    * @param name        The name of the table to be created.
    * @param schema      The schema to use for the created table.
+   * @param view_definition The query of a materialized view, whose rows the table holds. nullopt for other tables.
    * @return            True if successful. False otherwise.
    */
   bool CreateTableEntry(common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table_oid,
-                        namespace_oid_t ns_oid, const std::string &name, const Schema &schema);
+                        namespace_oid_t ns_oid, const std::string &name, const Schema &schema,
+                        const std::optional<std::string> &view_definition = std::nullopt);
   /**
    * @brief Delete a table and all the table's child objects (e.g., columns, indexes) from the database.
    *
@@ -184,6 +187,22 @@ class PgCoreImpl {
   bool RenameTable(common::ManagedPointer<transaction::TransactionContext> txn,
                    common::ManagedPointer<DatabaseCatalog> dbc, table_oid_t table, const std::string &name);
 
+  /**
+   * @brief Drop columns from a table without touching its tuples.
+   *
+   * The new schema must keep a subset of the columns of the current one, with the same OIDs and types. The storage of
+   * the dropped columns stays in the table's layout, where it is never read again and is null in new tuples.
+   * Columns cannot be added, as the SqlTable only has the one layout for its tuples.
+   *
+   * @param txn         The transaction to update the schema in.
+   * @param table       The table whose schema should be updated.
+   * @param new_schema  The new schema, which is deleted when the transaction aborts.
+   * @return            True if the update succeeded. False if the schema is not a subset of the current one, a
+   *                    dropped column is indexed, or there was a write-write conflict.
+   */
+  bool UpdateSchema(common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table,
+                    Schema *new_schema);
+
   /**
    * @brief Create an index.
    *
@@ -230,6 +249,34 @@ class PgCoreImpl {
    */
   std::vector<index_oid_t> GetIndexOids(common::ManagedPointer<transaction::TransactionContext> txn, table_oid_t table);
 
+  /**
+   * @brief Set whether an index holds every tuple of its table, in pg_index's indisvalid. An index that is not valid is
+   * still maintained by writers, but lookups must not go through it.
+   *
+   * @param txn     The transaction to update the index in.
+   * @param index   The OID of the index.
+   * @param valid   Whether the index is valid.
+   * @return        True if the update succeeded. False if there was a write-write conflict.
+   */
+  bool SetIndexValid(common::ManagedPointer<transaction::TransactionContext> txn, index_oid_t index, bool valid);
+
+  /**
+   * @brief Get whether an index holds every tuple of its table. @see SetIndexValid
+   *
+   * @param txn     The transaction to query in.
+   * @param index   The OID of the index.
+   * @return        True if the index is valid.
+   */
+  bool IsIndexValid(common::ManagedPointer<transaction::TransactionContext> txn, index_oid_t index);
+
+  /**
+   * @brief Get a list of all the REGULAR_TABLEs in pg_class, given as OIDs. This includes the catalog tables.
+   *
+   * @param txn     The transaction used for the operation.
+   * @return        The tables visible to the transaction.
+   */
+  std::vector<table_oid_t> GetTableOids(common::ManagedPointer<transaction::TransactionContext> txn);
+
   /**
    * @brief Get an object pointer from pg_class.
    *
@@ -261,6 +308,16 @@ class PgCoreImpl {
   std::pair<uint32_t, PgClass::RelKind> GetClassOidKind(common::ManagedPointer<transaction::TransactionContext> txn,
                                                         namespace_oid_t ns_oid, const std::string &name);
 
+  /**
+   * @brief Get the query of a materialized view from pg_class.
+   *
+   * @param txn     The transaction to query in.
+   * @param table   The OID of the table.
+   * @return        The query whose rows the table holds, nullopt if the table is not a materialized view.
+   */
+  std::optional<std::string> GetViewDefinition(common::ManagedPointer<transaction::TransactionContext> txn,
+                                               table_oid_t table);
+
   /**
    * Add a new column entry in pg_attribute.
    *
@@ -359,6 +416,7 @@ class PgCoreImpl {
   storage::ProjectedRowInitializer get_class_schema_pointer_kind_pri_;
   storage::ProjectedRowInitializer get_class_object_and_schema_pri_;
   storage::ProjectionMap get_class_object_and_schema_prm_;
+  storage::ProjectedRowInitializer get_class_view_definition_pri_;
   ///@}
 
   /**
@@ -373,6 +431,7 @@ class PgCoreImpl {
   storage::ProjectedRowInitializer get_indexes_pri_;
   storage::ProjectedRowInitializer delete_index_pri_;
   storage::ProjectionMap delete_index_prm_;
+  storage::ProjectedRowInitializer index_valid_pri_;
   storage::ProjectedRowInitializer pg_index_all_cols_pri_;
   storage::ProjectionMap pg_index_all_cols_prm_;
   ///@}
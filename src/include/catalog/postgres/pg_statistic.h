@@ -41,12 +41,13 @@ class PgStatistic {
   static constexpr CatalogColumnDef<uint32_t, uint32_t> STA_DISTINCTROWS{col_oid_t{5}};
   static constexpr CatalogColumnDef<storage::VarlenEntry> STA_TOPK{col_oid_t{6}};
   static constexpr CatalogColumnDef<storage::VarlenEntry> STA_HISTOGRAM{col_oid_t{7}};
+  static constexpr CatalogColumnDef<storage::VarlenEntry> STA_COLGROUPS{col_oid_t{8}};
 
-  static constexpr uint8_t NUM_PG_STATISTIC_COLS = 7;
+  static constexpr uint8_t NUM_PG_STATISTIC_COLS = 8;
 
   static constexpr std::array<col_oid_t, NUM_PG_STATISTIC_COLS> PG_STATISTIC_ALL_COL_OIDS = {
-      STARELID.oid_,         STAATTNUM.oid_, STA_NUMROWS.oid_,  STA_NONNULLROWS.oid_,
-      STA_DISTINCTROWS.oid_, STA_TOPK.oid_,  STA_HISTOGRAM.oid_};
+      STARELID.oid_,         STAATTNUM.oid_, STA_NUMROWS.oid_,   STA_NONNULLROWS.oid_,
+      STA_DISTINCTROWS.oid_, STA_TOPK.oid_,  STA_HISTOGRAM.oid_, STA_COLGROUPS.oid_};
 };
 
 }  // namespace noisepage::catalog::postgres
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>  // NOLINT
+#include <thread>  // NOLINT
+
+#include "common/constants.h"
+#include "common/macros.h"
+#include "common/shared_latch.h"
+#include "common/thread_ordinal.h"
+
+namespace noisepage::common {
+
+/**
+ * A big-reader latch: a reader-writer latch for read-mostly structures, with the same interface as SharedLatch.
+ *
+ * Readers count themselves in one of NUM_SLOTS counters, each on its own cache line, so that readers on different
+ * threads do not bounce a shared word between their cores. A writer raises a flag that turns new readers away, and
+ * then drains the counters of all slots. This makes shared latching nearly free and exclusive latching expensive.
+ *
+ * A writer that cannot drain the readers within a short while lowers its flag again and retries later, so that a
+ * thread which takes the latch in shared mode again while it holds it already never deadlocks with a waiting writer.
+ * Under a steady stream of long readers, writers may wait for a long time.
+ */
+class BigReaderLatch : public SharedLockAdapter<BigReaderLatch>, public UniqueLockAdapter<BigReaderLatch> {
+ public:
+  /** Number of reader counters, which is the number of threads that latch in shared mode without sharing a counter */
+  static constexpr uint32_t NUM_SLOTS = 64;
+
+  /**
+   * Acquire exclusive lock on mutex.
+   */
+  void LockExclusive() {
+    writers_latch_.lock();
+    while (!TryDrainReaders(MAX_DRAIN_SPINS)) std::this_thread::yield();
+  }
+
+  /**
+   * Acquire shared lock on mutex.
+   */
+  void LockShared() {
+    while (!TryLockShared()) {
+      while (writer_.load(std::memory_order_relaxed)) std::this_thread::yield();
+    }
+  }
+
+  /**
+   * Try to acquire exclusive lock on mutex.
+   * @return true if lock acquired, false otherwise.
+   */
+  bool TryExclusiveLock() {
+    if (!writers_latch_.try_lock()) return false;
+    if (TryDrainReaders(0)) return true;
+    writers_latch_.unlock();
+    return false;
+  }
+
+  /**
+   * Try to acquire shared lock on mutex.
+   * @return true if lock acquired, false otherwise.
+   */
+  bool TryLockShared() {
+    auto &readers = slots_[SlotIndex()].readers_;
+    // Announce the reader before looking for a writer. A writer raises its flag before it counts the readers, so
+    // either it sees this reader, or this reader sees its flag.
+    readers.fetch_add(1);
+    if (!writer_.load()) return true;
+    readers.fetch_sub(1, std::memory_order_release);
+    return false;
+  }
+
+  /**
+   * Release exclusive ownership of lock.
+   */
+  void UnlockExclusive() {
+    writer_.store(false, std::memory_order_release);
+    writers_latch_.unlock();
+  }
+
+  /**
+   * Release shared ownership of lock. Any thread may release it, not only the one that acquired it.
+   */
+  void UnlockShared() { slots_[SlotIndex()].readers_.fetch_sub(1, std::memory_order_release); }
+
+  /**
+   * Scoped read latch that guarantees releasing the latch when destructed.
+   */
+  class ScopedSharedLatch {
+   public:
+    /**
+     * Acquire read lock on BigReaderLatch.
+     * @param rw_latch pointer to BigReaderLatch to acquire
+     */
+    explicit ScopedSharedLatch(BigReaderLatch *const rw_latch) : rw_latch_(rw_latch) { rw_latch_->LockShared(); }
+    /**
+     * Release read lock (if acquired).
+     */
+    ~ScopedSharedLatch() { rw_latch_->UnlockShared(); }
+    DISALLOW_COPY_AND_MOVE(ScopedSharedLatch)
+
+   private:
+    BigReaderLatch *const rw_latch_;
+  };
+
+  /**
+   * Scoped write latch that guarantees releasing the latch when destructed.
+   */
+  class ScopedExclusiveLatch {
+   public:
+    /**
+     * Acquire write lock on BigReaderLatch.
+     * @param rw_latch pointer to BigReaderLatch to acquire
+     */
+    explicit ScopedExclusiveLatch(BigReaderLatch *const rw_latch) : rw_latch_(rw_latch) {
+      rw_latch_->LockExclusive();
+    }
+    /**
+     * Release write lock (if acquired).
+     */
+    ~ScopedExclusiveLatch() { rw_latch_->UnlockExclusive(); }
+    DISALLOW_COPY_AND_MOVE(ScopedExclusiveLatch)
+   private:
+    BigReaderLatch *const rw_latch_;
+  };
+
+ private:
+  // Number of times that a writer checks for readers before it lets them in again
+  static constexpr uint32_t MAX_DRAIN_SPINS = 1024;
+
+  struct alignas(Constants::CACHELINE_SIZE) Slot {
+    // Readers that latched through this slot minus the ones that released through it. It can go negative for a while
+    // if a latch is released on another thread, so only the sum over all slots is meaningful.
+    std::atomic<int32_t> readers_{0};
+  };
+
+  static uint32_t SlotIndex() { return ThreadOrdinal() % NUM_SLOTS; }
+
+  // Raise the writer flag and wait until no reader holds the latch. Lowers the flag again if the readers did not drain
+  // within the given number of checks.
+  bool TryDrainReaders(const uint32_t max_spins) {
+    writer_.store(true);
+    for (uint32_t spins = 0;; spins++) {
+      int64_t readers = 0;
+      for (const auto &slot : slots_) readers += slot.readers_.load();
+      if (readers == 0) return true;
+      if (spins >= max_spins) break;
+      std::this_thread::yield();
+    }
+    writer_.store(false, std::memory_order_release);
+    return false;
+  }
+
+  Slot slots_[NUM_SLOTS];
+  // Whether a writer holds the latch or is draining the readers
+  alignas(Constants::CACHELINE_SIZE) std::atomic<bool> writer_{false};
+  // Serializes the writers
+  std::mutex writers_latch_;
+};
+
+/** exclusive movable write latch on a BigReaderLatch */
+using BigReaderUniqueLatch = BasicUniqueLatch<BigReaderLatch>;
+
+/** shared movable read latch on a BigReaderLatch */
+using BigReaderLatchGuard = BasicSharedLatchGuard<BigReaderLatch>;
+
+}  // namespace noisepage::common
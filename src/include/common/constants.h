@@ -19,8 +19,16 @@ struct Constants {
    * Maximum number of columns a table is allowed to have. It should be sufficiently small such that  if all
    * columns are as large as they can be there is still at last one slot for every block.
    */
-  // TODO(Tianyu): This number currently is obtained through empirical experiments.
-  static const uint16_t MAX_COL = 12500;
+  // TODO(Tianyu): This number currently is obtained through empirical experiments. The zone map and the encoded copy
+  // every column keeps in the block header leave room for about 7700 varlen columns in a block. Both are kept for
+  // every column, since the header is sized for any layout, which lowered this limit from 12500. CREATE TABLE refuses
+  // tables that have more columns.
+  static const uint16_t MAX_COL = 7500;
+
+  /**
+   * Largest varlen content, in bytes, that recovery accepts from the log. This is the limit Postgres puts on a field.
+   */
+  static const uint32_t MAX_VARLEN_SIZE = 1 << 30;
 
   /**
    * The size of the buffers the log manager uses to buffer serialized logs and "group commit" them when writing to disk
@@ -122,6 +130,68 @@ struct Constants {
    */
   static constexpr const bool IS_PIPELINE_METRICS_ENABLED = true;
 
+  /**
+   * Number of bytes a thread may take up during a parallel aggregation before it spills aggregates to disk, 0 for no
+   * limit. This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const int64_t AGGREGATION_MEMORY_BUDGET = 0;
+
+  /**
+   * Percentage of input tuples that start a new group in a thread-local pre-aggregation at or above which input tuples
+   * are partitioned without being pre-aggregated, 0 to always pre-aggregate. This value will be overwritten by the
+   * SettingsManager (if enabled).
+   */
+  static constexpr const int64_t AGGREGATION_BYPASS_THRESHOLD = 90;
+
+  /**
+   * Number of bytes of build-side tuples a hash join may keep in memory before it spills partitions to disk, 0 for no
+   * limit. This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const int64_t JOIN_MEMORY_BUDGET = 0;
+
+  /**
+   * Number of bytes of tuples a sorter may buffer in memory before it spills them to disk as a sorted run, 0 for no
+   * limit. This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const int64_t SORT_MEMORY_BUDGET = 0;
+
+  /**
+   * Number of radix bits a parallel hash join build partitions its tuples on, 0 to insert from all threads at once and
+   * -1 to size the partitions to the L2 cache. This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const int64_t JOIN_BUILD_PARTITION_BITS = -1;
+
+  /**
+   * Flag indicating if hash join tables that are only probed one tuple at a time store their tuples grouped by bucket,
+   * without per-tuple chain pointers and hash values, once built. This value will be overwritten by the
+   * SettingsManager (if enabled).
+   */
+  static constexpr const bool IS_JOIN_COMPACT_LAYOUT_ENABLED = true;
+
+  /**
+   * Number of queries that may run parallel steps at the same time, 0 for no limit. Queries past the limit run their
+   * parallel steps serially. This value will be overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const int MAX_PARALLEL_QUERIES = 0;
+
+  /**
+   * Number of bytes a query may allocate before its parallel steps run serially, 0 for no limit. This value will be
+   * overwritten by the SettingsManager (if enabled).
+   */
+  static constexpr const int64_t QUERY_MEMORY_BUDGET = 0;
+
+  /**
+   * Milliseconds a statement may run before it is canceled, 0 for no limit. This value will be overwritten by the
+   * SettingsManager (if enabled).
+   */
+  static constexpr const int STATEMENT_TIMEOUT = 0;
+
+  /**
+   * Number of blocks of a table that ANALYZE samples, 0 to read the whole table. This value will be overwritten by the
+   * SettingsManager (if enabled).
+   */
+  static constexpr const int ANALYZE_SAMPLE_BLOCKS = 100;
+
   /**
    * Flag indicating if static partitioner is used
    */
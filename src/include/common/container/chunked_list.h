@@ -0,0 +1,169 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+
+namespace noisepage::common {
+
+/**
+ * An append-only list that stores its elements in chunks of many elements each, meant for collecting data points on a
+ * hot path. Adding an element constructs it in place at the end of the last chunk, so memory is only allocated once per
+ * chunk instead of once per element like a std::list, and elements never move once added. Moving the elements of one
+ * list to the end of another hands over whole chunks without touching the elements.
+ * @tparam T type of the elements
+ */
+template <typename T>
+class ChunkedList {
+ public:
+  /** Number of elements in a chunk, so that a chunk takes about 16 KB. */
+  static constexpr uint32_t CHUNK_SIZE = std::max<uint32_t>(1, (1U << 14) / sizeof(T));
+
+ private:
+  struct Chunk {
+    Chunk() = default;
+    DISALLOW_COPY_AND_MOVE(Chunk);
+    ~Chunk() {
+      for (uint32_t i = 0; i < size_; i++) Get(i)->~T();
+    }
+    T *Get(const uint32_t i) { return reinterpret_cast<T *>(storage_ + i * sizeof(T)); }
+
+    alignas(T) std::byte storage_[CHUNK_SIZE * sizeof(T)];
+    uint32_t size_ = 0;
+  };
+
+  template <bool IS_CONST>
+  class IteratorBase {
+   public:
+    using Value = std::conditional_t<IS_CONST, const T, T>;
+    using Chunks = std::conditional_t<IS_CONST, const std::vector<std::unique_ptr<Chunk>>,
+                                      std::vector<std::unique_ptr<Chunk>>>;
+
+    IteratorBase(Chunks *const chunks, const size_t chunk, const uint32_t element)
+        : chunks_(chunks), chunk_(chunk), element_(element) {}
+
+    Value &operator*() const { return *(*chunks_)[chunk_]->Get(element_); }
+
+    Value *operator->() const { return (*chunks_)[chunk_]->Get(element_); }
+
+    IteratorBase &operator++() {
+      // Chunks are never empty, so the next element is either in this chunk or first in the next one
+      if (++element_ == (*chunks_)[chunk_]->size_) {
+        chunk_++;
+        element_ = 0;
+      }
+      return *this;
+    }
+
+    IteratorBase operator++(int) {
+      IteratorBase result = *this;
+      ++(*this);
+      return result;
+    }
+
+    bool operator==(const IteratorBase &other) const { return chunk_ == other.chunk_ && element_ == other.element_; }
+
+    bool operator!=(const IteratorBase &other) const { return !(*this == other); }
+
+   private:
+    Chunks *chunks_;
+    size_t chunk_;
+    uint32_t element_;
+  };
+
+ public:
+  /** Iterator over the elements, in the order they were added. */
+  using Iterator = IteratorBase<false>;
+  /** Const iterator over the elements, in the order they were added. */
+  using ConstIterator = IteratorBase<true>;
+
+  ChunkedList() = default;
+
+  /**
+   * Copies the elements of another list.
+   * @param other list to copy
+   */
+  ChunkedList(const ChunkedList &other) {
+    for (const auto &element : other) EmplaceBack(element);
+  }
+
+  /**
+   * Takes the elements of another list.
+   * @param other list to take the elements of
+   */
+  ChunkedList(ChunkedList &&other) noexcept : chunks_(std::move(other.chunks_)), size_(other.size_) {
+    other.chunks_.clear();
+    other.size_ = 0;
+  }
+
+  ChunkedList &operator=(const ChunkedList &other) = delete;
+  ChunkedList &operator=(ChunkedList &&other) = delete;
+
+  ~ChunkedList() = default;
+
+  /**
+   * Construct an element at the end of the list.
+   * @param args arguments of the constructor of the element
+   * @return the new element
+   */
+  template <typename... Args>
+  T &EmplaceBack(Args &&... args) {
+    // Not std::make_unique, which would zero the storage of the chunk
+    if (chunks_.empty() || chunks_.back()->size_ == CHUNK_SIZE) chunks_.emplace_back(new Chunk);
+    Chunk *const chunk = chunks_.back().get();
+    T *const element = new (chunk->Get(chunk->size_)) T(std::forward<Args>(args)...);
+    chunk->size_++;
+    size_++;
+    return *element;
+  }
+
+  /**
+   * Move all the elements of another list to the end of this one, leaving the other list empty.
+   * @param other list to take the elements of
+   */
+  void Splice(ChunkedList *const other) {
+    NOISEPAGE_ASSERT(other != this, "Can't splice a list into itself.");
+    chunks_.reserve(chunks_.size() + other->chunks_.size());
+    std::move(other->chunks_.begin(), other->chunks_.end(), std::back_inserter(chunks_));
+    size_ += other->size_;
+    other->chunks_.clear();
+    other->size_ = 0;
+  }
+
+  /** Destroy all the elements, and free the memory they took. */
+  void Clear() {
+    chunks_.clear();
+    size_ = 0;
+  }
+
+  /** @return number of elements in the list */
+  uint64_t Size() const { return size_; }
+
+  /** @return true if the list has no elements */
+  bool Empty() const { return size_ == 0; }
+
+  /** @return iterator to the first element */
+  Iterator begin() { return Iterator(&chunks_, 0, 0); }  // NOLINT for STL name compability
+
+  /** @return iterator past the last element */
+  Iterator end() { return Iterator(&chunks_, chunks_.size(), 0); }  // NOLINT for STL name compability
+
+  /** @return const iterator to the first element */
+  ConstIterator begin() const { return ConstIterator(&chunks_, 0, 0); }  // NOLINT for STL name compability
+
+  /** @return const iterator past the last element */
+  ConstIterator end() const { return ConstIterator(&chunks_, chunks_.size(), 0); }  // NOLINT for STL name compability
+
+ private:
+  std::vector<std::unique_ptr<Chunk>> chunks_;
+  uint64_t size_ = 0;
+};
+
+}  // namespace noisepage::common
@@ -1,5 +1,10 @@
 #pragma once
 
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
 #include <cstring>
 #include <memory>
 
@@ -111,7 +116,7 @@ class RawConcurrentBitmap {
 
     const uint32_t num_bytes = RawBitmap::SizeInBytes(bitmap_num_bits);  // maximum number of bytes in the bitmap
     uint32_t byte_pos = start_pos / BYTE_SIZE;                           // current byte position
-    uint32_t bits_left = bitmap_num_bits - start_pos;                    // number of bits remaining
+    uint32_t bits_left = bitmap_num_bits - byte_pos * BYTE_SIZE;         // number of bits remaining from byte_pos on
     bool found_unset_bit = false;                                        // whether we found an unset bit previously
 
     while (byte_pos < num_bytes && bits_left > 0) {
@@ -154,13 +159,86 @@ class RawConcurrentBitmap {
         // e.g. the only free bit available was before start_pos
         // so we always want to increment our byte_pos to ensure progress
         byte_pos += 1;
-        // Also decrease bits_left, making sure that start_pos is taken into account
-        bits_left -= BYTE_SIZE - (start_pos % BYTE_SIZE);
+        // Also decrease bits_left to the bits from the next byte on, which only the first byte has fewer than 8 of
+        bits_left = bitmap_num_bits > byte_pos * BYTE_SIZE ? bitmap_num_bits - byte_pos * BYTE_SIZE : 0;
       }
     }
     return false;
   }
 
+  /**
+   * Counts the bits that are set. Bits flipped concurrently may or may not be counted.
+   * @param num_bits number of bits in the bitmap
+   * @return number of bits that are 1
+   */
+  uint32_t NumSet(const uint32_t num_bits) const {
+    uint32_t result = 0;
+    for (uint32_t i = 0; i < num_bits / BYTE_SIZE; i++) result += __builtin_popcount(bits_[i].load());
+    // Only the low bits of the last byte belong to the bitmap
+    if (num_bits % BYTE_SIZE != 0) {
+      result += __builtin_popcount(bits_[num_bits / BYTE_SIZE].load() & ((1U << (num_bits % BYTE_SIZE)) - 1));
+    }
+    return result;
+  }
+
+  /**
+   * Reads 64 bits of the bitmap at once, so that scans can skip over unset bits a word at a time. The bitmap has to be
+   * aligned to 8 bytes and padded up to a multiple of 64 bits, like the bitmaps of a block. Bits flipped concurrently
+   * may or may not be seen.
+   * @param word_index index of the word to read
+   * @return bits 64 * word_index to 64 * word_index + 63 of the bitmap, starting from the least significant bit
+   */
+  uint64_t Word(const uint32_t word_index) const {
+    return reinterpret_cast<const std::atomic<uint64_t> *>(bits_)[word_index].load();
+  }
+
+  /**
+   * Sets a range of bits that are all 0, with one atomic OR per word of 64 bits instead of a compare-and-swap per bit.
+   * The bitmap has to be aligned and padded like for Word(). Bits outside of the range may be flipped concurrently.
+   * @param start first bit of the range
+   * @param num_bits number of bits in the range
+   */
+  void SetRange(const uint32_t start, const uint32_t num_bits) {
+    auto *const words = reinterpret_cast<std::atomic<uint64_t> *>(bits_);
+    const uint32_t end = start + num_bits;
+    for (uint32_t pos = start; pos < end;) {
+      const uint32_t offset = pos % WORD_BITS;
+      const uint32_t num_in_word = std::min(WORD_BITS - offset, end - pos);
+      const uint64_t mask = (num_in_word == WORD_BITS ? ~uint64_t{0} : (uint64_t{1} << num_in_word) - 1) << offset;
+      const uint64_t UNUSED_ATTRIBUTE old_word = words[pos / WORD_BITS].fetch_or(mask);
+      NOISEPAGE_ASSERT((old_word & mask) == 0, "the bits of the range should all be unset");
+      pos += num_in_word;
+    }
+  }
+
+  /**
+   * Returns the position of the first unset bit at or after start_pos, like FirstUnsetPos(), but skips over set bits
+   * SIMD_WORDS words at a time, i.e., 512 bits with AVX-512 and 256 bits otherwise. The bitmap has to be aligned and
+   * padded like for Word(). Bits flipped concurrently may or may not be seen.
+   * @param bitmap_num_bits number of bits in the bitmap.
+   * @param start_pos start searching from this bit location.
+   * @param[out] out_pos the position of the first unset bit will be written here, if it exists.
+   * @return true if an unset bit was found, and false otherwise.
+   */
+  bool FirstUnsetPosWide(const uint32_t bitmap_num_bits, const uint32_t start_pos, uint32_t *const out_pos) const {
+    if (start_pos >= bitmap_num_bits) return false;
+    const uint32_t num_words = (bitmap_num_bits + WORD_BITS - 1) / WORD_BITS;
+    uint32_t word_index = start_pos / WORD_BITS;
+    // The bits before start_pos in its word do not count
+    uint64_t unset = ~Word(word_index) & (~uint64_t{0} << (start_pos % WORD_BITS));
+    while (unset == 0) {
+      word_index++;
+      while (word_index + SIMD_WORDS <= num_words && AllSet(word_index)) word_index += SIMD_WORDS;
+      if (word_index >= num_words) return false;
+      unset = ~Word(word_index);
+    }
+    // The padding after the last bit is unset
+    const uint32_t pos = word_index * WORD_BITS + static_cast<uint32_t>(__builtin_ctzll(unset));
+    if (pos >= bitmap_num_bits) return false;
+    *out_pos = pos;
+    return true;
+  }
+
   /**
    * Clears the bitmap by setting bits to 0.
    * @param num_bits number of bits to clear. This should be equal to the number of elements of the entire bitmap or
@@ -177,8 +255,30 @@ class RawConcurrentBitmap {
   // bulk flips. This thing is embarrassingly easy to vectorize.
 
  private:
+  static constexpr uint32_t WORD_BITS = 64;
+#if defined(__AVX512F__)
+  static constexpr uint32_t SIMD_WORDS = 8;
+#else
+  static constexpr uint32_t SIMD_WORDS = 4;
+#endif
+
   std::atomic<uint8_t> bits_[0];
 
+  // Whether the SIMD_WORDS words from word_index on have all their bits set
+  bool AllSet(const uint32_t word_index) const {
+    const auto *const words = reinterpret_cast<const uint64_t *>(bits_) + word_index;
+#if defined(__AVX512F__)
+    return _mm512_cmpneq_epi64_mask(_mm512_loadu_si512(words), _mm512_set1_epi64(-1)) == 0;
+#elif defined(__AVX2__)
+    const __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(words));
+    return _mm256_testc_si256(bits, _mm256_set1_epi64x(-1)) != 0;
+#else
+    uint64_t all = ~uint64_t{0};
+    for (uint32_t i = 0; i < SIMD_WORDS; i++) all &= words[i];
+    return all == ~uint64_t{0};
+#endif
+  }
+
   /**
    * Looks for an unset bit in a T-sized word from the bitmap, starting at byte_pos.
    * If an unset bit is found, returns true.
@@ -85,6 +85,14 @@ class ConcurrentVector {
    */
   Iterator PushBack(const T &item) { return Iterator(vector_.push_back(item)); }
 
+  /**
+   * Adds a new element at the end of the vector, after its current last element. Elements are never moved, so other
+   * threads may read the elements that were added before while this is in progress.
+   * @param item element to be added.
+   * @return the position of the new element.
+   */
+  uint64_t Append(const T &item) { return static_cast<uint64_t>(vector_.push_back(item) - vector_.begin()); }
+
   /**
    * Returns a reference to the element at position n in the vector.
    * @param index position of an element in the vector.
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/constants.h"
+#include "common/macros.h"
+
+namespace noisepage::common {
+
+/**
+ * A Chase-Lev work-stealing deque of pointers. Its owner pushes and pops at the bottom without any contention, while
+ * any other thread may steal from the top. The deque grows when it is full, and keeps the smaller arrays around until
+ * it is destroyed, because a thief may still be reading them.
+ *
+ * The memory orders follow Lê et al., "Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013.
+ *
+ * @tparam T type of the elements that the deque points to. The deque does not own them.
+ */
+template <typename T>
+class WorkStealingDeque {
+ public:
+  /**
+   * Create an empty deque
+   * @param log_capacity log2 of the number of elements that the deque holds before it first grows
+   */
+  explicit WorkStealingDeque(const uint32_t log_capacity = 8) {
+    arrays_.emplace_back(std::make_unique<Array>(int64_t{1} << log_capacity));
+    array_.store(arrays_.back().get(), std::memory_order_relaxed);
+  }
+
+  DISALLOW_COPY_AND_MOVE(WorkStealingDeque)
+
+  /**
+   * Push an element at the bottom. Only the owner of the deque may push.
+   * @param elem element to push, not null
+   */
+  void Push(T *const elem) {
+    NOISEPAGE_ASSERT(elem != nullptr, "Null is reserved for an empty deque");
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed);
+    const int64_t top = top_.load(std::memory_order_acquire);
+    Array *array = array_.load(std::memory_order_relaxed);
+    if (bottom - top > array->Capacity() - 1) array = Grow(array, top, bottom);
+    array->Put(bottom, elem);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(bottom + 1, std::memory_order_relaxed);
+  }
+
+  /**
+   * Pop the element at the bottom, which is the one pushed last. Only the owner of the deque may pop.
+   * @return the element, or nullptr if the deque is empty
+   */
+  T *Pop() {
+    const int64_t bottom = bottom_.load(std::memory_order_relaxed) - 1;
+    Array *const array = array_.load(std::memory_order_relaxed);
+    bottom_.store(bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t top = top_.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+      // Empty
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    T *elem = array->Get(bottom);
+    if (top == bottom) {
+      // The last element, which a thief may be taking at the same time
+      if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        elem = nullptr;
+      }
+      bottom_.store(bottom + 1, std::memory_order_relaxed);
+    }
+    return elem;
+  }
+
+  /**
+   * Steal the element at the top, which is the one pushed first. Any thread may steal.
+   * @return the element, or nullptr if the deque is empty or another thread took the element first
+   */
+  T *Steal() {
+    int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const int64_t bottom = bottom_.load(std::memory_order_acquire);
+    if (top >= bottom) return nullptr;
+
+    T *const elem = array_.load(std::memory_order_acquire)->Get(top);
+    if (!top_.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      return nullptr;
+    }
+    return elem;
+  }
+
+  /**
+   * @return true if the deque looked empty. The answer may be stale by the time it returns if other threads use the
+   * deque at the same time.
+   */
+  bool Empty() const {
+    const int64_t top = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return bottom_.load(std::memory_order_acquire) <= top;
+  }
+
+ private:
+  // A circular array whose capacity is a power of 2
+  class Array {
+   public:
+    explicit Array(const int64_t capacity)
+        : capacity_(capacity), elems_(std::make_unique<std::atomic<T *>[]>(static_cast<size_t>(capacity))) {}
+
+    int64_t Capacity() const { return capacity_; }
+
+    T *Get(const int64_t i) const { return elems_[i & (capacity_ - 1)].load(std::memory_order_relaxed); }
+
+    void Put(const int64_t i, T *const elem) { elems_[i & (capacity_ - 1)].store(elem, std::memory_order_relaxed); }
+
+   private:
+    const int64_t capacity_;
+    std::unique_ptr<std::atomic<T *>[]> elems_;
+  };
+
+  Array *Grow(Array *const array, const int64_t top, const int64_t bottom) {
+    arrays_.emplace_back(std::make_unique<Array>(array->Capacity() * 2));
+    Array *const grown = arrays_.back().get();
+    for (int64_t i = top; i < bottom; i++) grown->Put(i, array->Get(i));
+    array_.store(grown, std::memory_order_release);
+    return grown;
+  }
+
+  // The owner and the thieves contend on different ends, so keep them on different cache lines
+  alignas(common::Constants::CACHELINE_SIZE) std::atomic<int64_t> top_{0};
+  alignas(common::Constants::CACHELINE_SIZE) std::atomic<int64_t> bottom_{0};
+  std::atomic<Array *> array_;
+  // Every array the deque ever had, which only the owner touches
+  std::vector<std::unique_ptr<Array>> arrays_;
+};
+
+}  // namespace noisepage::common
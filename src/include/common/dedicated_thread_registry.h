@@ -10,6 +10,7 @@
 #include "common/macros.h"
 #include "common/managed_pointer.h"
 #include "common/spin_latch.h"
+#include "common/thread_placement.h"
 #include "metrics/metrics_manager.h"
 
 namespace noisepage::common {
@@ -29,9 +30,11 @@ class DedicatedThreadRegistry {
   /**
    * @param metrics_manager pointer to the metrics manager if metrics are enabled. Necessary for worker threads to
    * register themselves
+   * @param thread_placement decides which CPUs the dedicated threads run on, by their role, if not null
    */
-  explicit DedicatedThreadRegistry(common::ManagedPointer<metrics::MetricsManager> metrics_manager)
-      : metrics_manager_(metrics_manager) {}
+  explicit DedicatedThreadRegistry(common::ManagedPointer<metrics::MetricsManager> metrics_manager,
+                                   common::ManagedPointer<ThreadPlacement> thread_placement = nullptr)
+      : metrics_manager_(metrics_manager), thread_placement_(thread_placement) {}
 
   ~DedicatedThreadRegistry() {
     // Note that if registry is shutting down, it doesn't matter whether
@@ -78,6 +81,7 @@ class DedicatedThreadRegistry {
     auto *task = new T(args...);  // Create task
     thread_owners_table_[requester].insert(task);
     threads_table_.emplace(task, std::thread([=] {
+                             if (thread_placement_ != nullptr) thread_placement_->Apply(task->GetThreadRole());
                              if (metrics_manager_ != DISABLED) metrics_manager_->RegisterThread();
                              task->RunTask();
                            }));
@@ -141,6 +145,7 @@ class DedicatedThreadRegistry {
   // not controlled by the registry
   std::unordered_map<DedicatedThreadOwner *, std::unordered_set<DedicatedThreadTask *>> thread_owners_table_;
   const common::ManagedPointer<metrics::MetricsManager> metrics_manager_;
+  const common::ManagedPointer<ThreadPlacement> thread_placement_;
 };
 
 }  // namespace noisepage::common
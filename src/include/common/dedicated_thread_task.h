@@ -1,5 +1,7 @@
 #pragma once
 
+#include "common/thread_placement.h"
+
 namespace noisepage::common {
 /**
  * @brief Interface for a task to be run on a dedicated thread
@@ -28,5 +30,10 @@ class DedicatedThreadTask {
    * until terminate is explicitly called.
    */
   virtual void RunTask() = 0;
+
+  /**
+   * @return the role of the dedicated thread, which decides where the thread registry places it
+   */
+  virtual ThreadRole GetThreadRole() const { return ThreadRole::OTHER; }
 };
 }  // namespace noisepage::common
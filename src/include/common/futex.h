@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+#if __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <climits>
+#else
+#include <condition_variable>  // NOLINT
+#include <functional>
+#include <mutex>  // NOLINT
+#endif
+
+namespace noisepage::common {
+
+/**
+ * Parks threads on the value of an atomic word, like std::atomic::wait and notify in C++20. On Linux, this is a futex,
+ * so that threads that wait and wake each other only make a system call when one of them is actually asleep. Elsewhere,
+ * the words are hashed onto a few mutexes and condition variables.
+ */
+class Futex {
+ public:
+  Futex() = delete;
+
+  /**
+   * Block as long as the word holds the expected value. It may return early, so callers check their condition again.
+   * @param word word to wait on
+   * @param expected value that the word held when the caller decided to wait
+   */
+  static void Wait(std::atomic<uint32_t> *const word, const uint32_t expected) {
+#if __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+#else
+    auto &bucket = GetBucket(word);
+    std::unique_lock<std::mutex> lock(bucket.latch_);
+    if (word->load() == expected) bucket.cv_.wait(lock);
+#endif
+  }
+
+  /**
+   * Wake the threads that wait on a word. Call it after changing the word.
+   * @param word word that threads wait on
+   * @param num_threads maximum number of threads to wake
+   */
+  static void Wake(std::atomic<uint32_t> *const word, const uint32_t num_threads) {
+#if __linux__
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(word), FUTEX_WAKE_PRIVATE,
+            static_cast<int>(std::min<uint32_t>(num_threads, INT_MAX)), nullptr, nullptr, 0);
+#else
+    // Other words share the condition variable, so wake everyone, and the waiters of other words check again
+    auto &bucket = GetBucket(word);
+    std::lock_guard<std::mutex> lock(bucket.latch_);
+    bucket.cv_.notify_all();
+#endif
+  }
+
+  /**
+   * Wake every thread that waits on a word. Call it after changing the word.
+   * @param word word that threads wait on
+   */
+  static void WakeAll(std::atomic<uint32_t> *const word) { Wake(word, UINT32_MAX); }
+
+#if !__linux__
+ private:
+  struct Bucket {
+    std::mutex latch_;
+    std::condition_variable cv_;
+  };
+
+  static Bucket &GetBucket(const std::atomic<uint32_t> *const word) {
+    static Bucket buckets[NUM_BUCKETS];
+    return buckets[std::hash<const void *>()(word) % NUM_BUCKETS];
+  }
+
+  static constexpr uint32_t NUM_BUCKETS = 16;
+#endif
+};
+
+}  // namespace noisepage::common
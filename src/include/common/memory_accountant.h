@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string_view>
+
+#include "common/macros.h"
+
+namespace noisepage::common {
+
+/** The components whose memory the MemoryAccountant counts. */
+enum class MemoryComponent : uint8_t {
+  /** Blocks of the tables, handed out by the BlockStores */
+  BLOCK_STORE = 0,
+  /** Segments of the undo and redo buffers of transactions */
+  RECORD_BUFFERS,
+  /** Contents of varlens that are too long to be inlined */
+  VARLEN,
+  /** Memory the execution engine allocates for running queries, e.g., hash tables and sorters */
+  EXECUTION,
+  NUM_COMPONENTS
+};
+
+/**
+ * Counts the bytes that every component of the system holds, so that what consumes memory under load can be queried
+ * (SHOW memory_usage) before the OOM killer decides for us. The sizes of the tables and indexes, and the memory of the
+ * query every connection runs, are broken out when they are queried.
+ *
+ * Components allocate memory on hot paths, so every thread counts its allocations locally and merges them into the
+ * shared totals only once they add up to MERGE_THRESHOLD bytes, like the MemoryTracker of a query does. The totals are
+ * off by less than MERGE_THRESHOLD per thread and component. Memory may be freed by another thread than the one that
+ * allocated it, so the counts of a single thread may be negative.
+ */
+class MemoryAccountant {
+ public:
+  MemoryAccountant() = delete;
+
+  /** The bytes a thread allocates or frees in a component before merging them into the total. */
+  static constexpr int64_t MERGE_THRESHOLD = 64 * 1024;
+
+  /** Number of components. */
+  static constexpr uint8_t NUM_COMPONENTS = static_cast<uint8_t>(MemoryComponent::NUM_COMPONENTS);
+
+  /**
+   * Counts memory a component allocated.
+   * @param component component that allocated the memory
+   * @param bytes number of bytes allocated
+   */
+  static void Allocate(const MemoryComponent component, const uint64_t bytes) {
+    Add(component, static_cast<int64_t>(bytes));
+  }
+
+  /**
+   * Counts memory a component freed.
+   * @param component component that freed the memory
+   * @param bytes number of bytes freed
+   */
+  static void Free(const MemoryComponent component, const uint64_t bytes) {
+    Add(component, -static_cast<int64_t>(bytes));
+  }
+
+  /**
+   * @param component component to get the memory of
+   * @return number of bytes the component holds, as merged by all threads so far
+   */
+  static int64_t GetBytes(MemoryComponent component);
+
+  /**
+   * @param component component to name
+   * @return name of the component, as SHOW memory_usage shows it
+   */
+  static std::string_view ComponentName(MemoryComponent component);
+
+ private:
+  // Bytes a thread allocated less bytes it freed since it last merged them, per component. Merged when the thread
+  // exits, too.
+  struct ThreadCounts {
+    ~ThreadCounts();
+    std::array<int64_t, NUM_COMPONENTS> unmerged_{};
+  };
+
+  static void Add(const MemoryComponent component, const int64_t bytes) {
+    const auto index = static_cast<uint8_t>(component);
+    int64_t &unmerged = thread_counts.unmerged_[index];
+    unmerged += bytes;
+    if (unmerged >= MERGE_THRESHOLD || unmerged <= -MERGE_THRESHOLD) {
+      Totals()[index].fetch_add(unmerged, std::memory_order_relaxed);
+      unmerged = 0;
+    }
+  }
+
+  static std::array<std::atomic<int64_t>, NUM_COMPONENTS> &Totals();
+
+  static thread_local ThreadCounts thread_counts;
+};
+
+}  // namespace noisepage::common
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace noisepage::common {
+
+/**
+ * Maps every CPU to its NUMA node, as exposed by the kernel in sysfs. There is no dependency on libnuma. A machine
+ * without NUMA nodes, or one whose nodes cannot be determined, looks like a single node that holds every CPU.
+ */
+class NumaTopology {
+ public:
+  /** @return the topology of this machine, which is read once */
+  static const NumaTopology &Get();
+
+  /** @return number of NUMA nodes of this machine */
+  uint16_t NumNodes() const { return num_nodes_; }
+
+  /** @return NUMA node of the CPU the calling thread currently runs on */
+  uint16_t CurrentNode() const;
+
+  /**
+   * @param node NUMA node
+   * @return the CPUs of the node, or an empty list if they are unknown
+   */
+  std::vector<uint32_t> CpusOf(uint16_t node) const;
+
+ private:
+  NumaTopology();
+
+  uint16_t num_nodes_ = 1;
+  std::vector<uint16_t> cpu_to_node_;
+};
+
+}  // namespace noisepage::common
@@ -1,12 +1,17 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <queue>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "common/allocator.h"
+#include "common/constants.h"
 #include "common/spin_latch.h"
 #include "common/strong_typedef.h"
+#include "common/thread_ordinal.h"
 
 namespace noisepage::common {
 // TODO(Yangjun): this class should be moved somewhere else.
@@ -51,6 +56,12 @@ class AllocatorFailureException : public std::exception {
  *
  * This prevents liberal calls to malloc and new in the code and makes tracking
  * our memory performance easier.
+ *
+ * Threads keep the objects they release in small per-thread caches (magazines) and take them from there again, so that
+ * the common case never touches the latch of the pool. A magazine that runs empty or full is refilled from or handed
+ * back to the pool half at a time. Magazines are only used when the reuse limit is large enough to give every one of
+ * them a few objects, and they hold at most as many objects as the reuse limit in total, so the number of reusable
+ * objects may exceed the reuse limit by up to that much. The size limit is always exact.
  * @tparam T the type of objects in the pool.
  * @tparam The allocator to use when constructing and destructing a new object.
  *         In most cases it can be left out and the default allocator will
@@ -71,7 +82,10 @@ class ObjectPool {
    * @param reuse_limit the maximum number of reusable objects
    */
   ObjectPool(uint64_t size_limit, uint64_t reuse_limit)
-      : size_limit_(size_limit), reuse_limit_(reuse_limit), current_size_(0) {}
+      : size_limit_(size_limit),
+        reuse_limit_(reuse_limit),
+        current_size_(0),
+        magazine_capacity_(MagazineCapacity(reuse_limit)) {}
 
   /**
    * Destructs the memory pool. Frees any memory it holds.
@@ -86,6 +100,9 @@ class ObjectPool {
       alloc_.Delete(result);
       reuse_queue_.pop();
     }
+    for (auto &magazine : magazines_) {
+      for (T *obj : magazine.objects_) alloc_.Delete(obj);
+    }
   }
 
   /**
@@ -95,20 +112,32 @@ class ObjectPool {
    * @return pointer to memory that can hold T
    */
   T *Get() {
-    SpinLatch::ScopedSpinLatch guard(&latch_);
-    if (reuse_queue_.empty() && current_size_ >= size_limit_) throw NoMoreObjectException(size_limit_);
-    T *result = nullptr;
-    if (reuse_queue_.empty()) {
-      result = alloc_.New();  // result could be null because the allocator may not find enough memory space
-      if (result != nullptr) current_size_++;
-    } else {
-      result = reuse_queue_.front();
-      reuse_queue_.pop();
-      alloc_.Reuse(result);
+    if (const uint64_t capacity = magazine_capacity_.load(std::memory_order_relaxed); capacity > 0) {
+      Magazine &magazine = magazines_[MagazineIndex()];
+      SpinLatch::ScopedSpinLatch magazine_guard(&magazine.latch_);
+      if (magazine.objects_.empty()) {
+        SpinLatch::ScopedSpinLatch guard(&latch_);
+        while (!reuse_queue_.empty() && magazine.objects_.size() < (capacity + 1) / 2) {
+          magazine.objects_.push_back(reuse_queue_.front());
+          reuse_queue_.pop();
+        }
+      }
+      if (!magazine.objects_.empty()) {
+        T *result = magazine.objects_.back();
+        magazine.objects_.pop_back();
+        alloc_.Reuse(result);
+        return result;
+      }
     }
-    // If result is nullptr. The call to alloc_.New() failed (i.e. can't allocate more memory from the system).
-    if (result == nullptr) throw AllocatorFailureException();
-    NOISEPAGE_ASSERT(current_size_ <= size_limit_, "Object pool has exceeded its size limit.");
+
+    {
+      SpinLatch::ScopedSpinLatch guard(&latch_);
+      if (!reuse_queue_.empty() || current_size_ < size_limit_) return GetLocked();
+    }
+    // The pool is out of objects, but other threads may still keep some that they released in their magazines
+    T *result = TakeFromMagazines();
+    if (result == nullptr) throw NoMoreObjectException(size_limit_);
+    alloc_.Reuse(result);
     return result;
   }
 
@@ -148,6 +177,14 @@ class ObjectPool {
    * @param new_reuse_limit
    */
   void SetReuseLimit(uint64_t new_reuse_limit) {
+    magazine_capacity_.store(MagazineCapacity(new_reuse_limit), std::memory_order_relaxed);
+    // Hand back the cached objects, so that the new limit applies to them too
+    for (auto &magazine : magazines_) {
+      SpinLatch::ScopedSpinLatch magazine_guard(&magazine.latch_);
+      SpinLatch::ScopedSpinLatch guard(&latch_);
+      for (T *obj : magazine.objects_) reuse_queue_.push(obj);
+      magazine.objects_.clear();
+    }
     SpinLatch::ScopedSpinLatch guard(&latch_);
     reuse_limit_ = new_reuse_limit;
     T *obj = nullptr;
@@ -168,7 +205,65 @@ class ObjectPool {
    */
   void Release(T *obj) {
     NOISEPAGE_ASSERT(obj != nullptr, "releasing a null pointer");
+    if (const uint64_t capacity = magazine_capacity_.load(std::memory_order_relaxed); capacity > 0) {
+      Magazine &magazine = magazines_[MagazineIndex()];
+      SpinLatch::ScopedSpinLatch magazine_guard(&magazine.latch_);
+      if (magazine.objects_.size() >= capacity) {
+        SpinLatch::ScopedSpinLatch guard(&latch_);
+        while (magazine.objects_.size() > capacity / 2) {
+          ReleaseLocked(magazine.objects_.back());
+          magazine.objects_.pop_back();
+        }
+      }
+      magazine.objects_.push_back(obj);
+      return;
+    }
     SpinLatch::ScopedSpinLatch guard(&latch_);
+    ReleaseLocked(obj);
+  }
+
+  /**
+   * @return size limit of the object pool
+   */
+  uint64_t GetSizeLimit() const { return size_limit_; }
+
+ private:
+  // Number of magazines, which threads share round-robin
+  static constexpr uint64_t NUM_MAGAZINES = 64;
+  // Maximum number of objects in a magazine
+  static constexpr uint64_t MAGAZINE_SIZE = 32;
+
+  struct alignas(Constants::CACHELINE_SIZE) Magazine {
+    SpinLatch latch_;
+    // Released objects, which are handed out again last in, first out
+    std::vector<T *> objects_;
+  };
+
+  static uint64_t MagazineIndex() { return ThreadOrdinal() % NUM_MAGAZINES; }
+
+  static uint64_t MagazineCapacity(const uint64_t reuse_limit) {
+    return std::min(MAGAZINE_SIZE, reuse_limit / NUM_MAGAZINES);
+  }
+
+  // Hand out an object from the reuse queue, or a new one. The caller holds latch_ and checked that either is possible.
+  T *GetLocked() {
+    T *result = nullptr;
+    if (reuse_queue_.empty()) {
+      result = alloc_.New();  // result could be null because the allocator may not find enough memory space
+      if (result != nullptr) current_size_++;
+    } else {
+      result = reuse_queue_.front();
+      reuse_queue_.pop();
+      alloc_.Reuse(result);
+    }
+    // If result is nullptr. The call to alloc_.New() failed (i.e. can't allocate more memory from the system).
+    if (result == nullptr) throw AllocatorFailureException();
+    NOISEPAGE_ASSERT(current_size_ <= size_limit_, "Object pool has exceeded its size limit.");
+    return result;
+  }
+
+  // Put an object on the reuse queue, or free it if the queue is full. The caller holds latch_.
+  void ReleaseLocked(T *obj) {
     if (reuse_queue_.size() >= reuse_limit_) {
       alloc_.Delete(obj);
       current_size_--;
@@ -177,13 +272,22 @@ class ObjectPool {
     }
   }
 
-  /**
-   * @return size limit of the object pool
-   */
-  uint64_t GetSizeLimit() const { return size_limit_; }
+  // Take an object from the magazine of any thread, or return nullptr if they are all empty
+  T *TakeFromMagazines() {
+    for (auto &magazine : magazines_) {
+      SpinLatch::ScopedSpinLatch magazine_guard(&magazine.latch_);
+      if (!magazine.objects_.empty()) {
+        T *result = magazine.objects_.back();
+        magazine.objects_.pop_back();
+        return result;
+      }
+    }
+    return nullptr;
+  }
 
- private:
   Allocator alloc_;
+  // Protects everything but the magazines, which have their own latches. A thread that holds both took the latch of the
+  // magazine first.
   SpinLatch latch_;
   // TODO(yangjuns): We don't need to reuse objects in a FIFO pattern. We could potentially pass a second template
   // parameter to define the backing container for the std::queue. That way we can measure each backing container.
@@ -193,5 +297,8 @@ class ObjectPool {
   // current_size_ represents the number of objects the object pool has allocated,
   // including objects that have been given out to callers and those reside in reuse_queue
   uint64_t current_size_;
+  // the maximum number of objects in each magazine, which is 0 if threads do not cache objects
+  std::atomic<uint64_t> magazine_capacity_;
+  Magazine magazines_[NUM_MAGAZINES];
 };
 }  // namespace noisepage::common
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <sys/types.h>
+
 #include "common/macros.h"
 
 namespace noisepage::storage {
@@ -53,6 +55,30 @@ class PosixIoWrappers {
    * @throws runtime_error if the underlying posix call failed
    */
   static void WriteFully(int fd, const void *buf, size_t nbyte);
+
+  /**
+   * Wrapper around the posix pread call, where a single function call will always read the specified amount of bytes
+   * unless eof is read. Concurrent calls on the same file descriptor do not interfere with each other.
+   * @param fd posix fildes arg
+   * @param buf posix buf arg
+   * @param nbyte posix nbyte arg
+   * @param offset posix offset arg
+   * @throws runtime_error if the underlying posix call failed
+   * @return nbyte if the read is successful, or the number of bytes actually read if eof is read before nbytes are
+   *         read.
+   */
+  static uint32_t PreadFully(int fd, void *buf, size_t nbyte, off_t offset);
+
+  /**
+   * Wrapper around the posix pwrite call, where a single function call will always write the entire buffer out.
+   * Concurrent calls on the same file descriptor do not interfere with each other.
+   * @param fd posix fildes arg
+   * @param buf posix buf arg
+   * @param nbyte posix nbyte arg
+   * @param offset posix offset arg
+   * @throws runtime_error if the underlying posix call failed
+   */
+  static void PwriteFully(int fd, const void *buf, size_t nbyte, off_t offset);
 };
 
 extern template int PosixIoWrappers::Open<>(const char *path, int oflag);
@@ -5,6 +5,7 @@
 #include "common/perf_monitor.h"
 #include "common/rusage_monitor.h"
 #include "execution/util/cpu_info.h"
+#include "metrics/metrics_sink.h"
 #include "metrics/metrics_util.h"
 
 namespace noisepage::execution::exec {
@@ -39,18 +40,17 @@ class ResourceTracker {
     uint64_t memory_b_;
 
     /**
-     * Writes the metrics out to ofstreams
-     * @param outfile opened ofstream to write to
+     * Writes the metrics out as the last fields of a row
+     * @param writer writer of the row
      */
-    void ToCSV(std::ofstream &outfile) const {
+    void Write(metrics::MetricsRowWriter *const writer) const {
       auto ref_cycles = execution::CpuInfo::Instance()->GetRefCyclesUs();
-      outfile << start_ << ", " << cpu_id_ << ", " << counters_.cpu_cycles_ << ", " << counters_.instructions_ << ", "
-              << counters_.cache_references_ << ", " << counters_.cache_misses_ << ", "
-              << ((ref_cycles == 0) ? 0 : counters_.ref_cpu_cycles_ / ref_cycles) << ", " << rusage_.ru_inblock << ", "
-              << rusage_.ru_oublock << ", " << memory_b_ << ", " << elapsed_us_;
+      *writer << start_ << cpu_id_ << counters_.cpu_cycles_ << counters_.instructions_ << counters_.cache_references_
+              << counters_.cache_misses_ << ((ref_cycles == 0) ? 0 : counters_.ref_cpu_cycles_ / ref_cycles)
+              << rusage_.ru_inblock << rusage_.ru_oublock << memory_b_ << elapsed_us_;
     }
 
-    /** Column headers to emit when writing to CSV */
+    /** Column headers of the metrics */
     static constexpr std::string_view COLUMNS = {
         "start_time, cpu_id, cpu_cycles, instructions, cache_ref, cache_miss, ref_cpu_cycles, "
         "block_read, block_write, memory_b, elapsed_us"};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mutex>  // NOLINT
 #include <shared_mutex>
 
 #include "common/macros.h"
@@ -150,32 +151,42 @@ class SharedLatch : public SharedLockAdapter<SharedLatch>, public UniqueLockAdap
 
 /**
  * exclusive movable write latch that guarantees releasing the latch when destructed.
+ * @tparam Latch type of the reader-writer latch, e.g., SharedLatch or BigReaderLatch
  */
-class UniqueLatch {
+template <typename Latch>
+class BasicUniqueLatch {
  public:
   /**
    * Acquire write latch on ReaderWriterLatch.
    * @param rw_latch pointer to ReaderWriterLatch to acquire
    */
-  explicit UniqueLatch(SharedLatch *const rw_latch) : unique_lock_(*rw_latch) {}
+  explicit BasicUniqueLatch(Latch *const rw_latch) : unique_lock_(*rw_latch) {}
 
  private:
-  std::unique_lock<SharedLatch> unique_lock_;
+  std::unique_lock<Latch> unique_lock_;
 };
 
 /**
  * shared movable read latch that guarantees releasing the latch when destructed.
+ * @tparam Latch type of the reader-writer latch, e.g., SharedLatch or BigReaderLatch
  */
-class SharedLatchGuard {
+template <typename Latch>
+class BasicSharedLatchGuard {
  public:
   /**
    * Acquire read latch on ReaderWriterLatch.
    * @param rw_latch pointer to ReaderWriterLatch to acquire
    */
-  explicit SharedLatchGuard(SharedLatch *const rw_latch) : shared_lock_(*rw_latch) {}
+  explicit BasicSharedLatchGuard(Latch *const rw_latch) : shared_lock_(*rw_latch) {}
 
  private:
-  std::shared_lock<SharedLatch> shared_lock_;
+  std::shared_lock<Latch> shared_lock_;
 };
 
+/** exclusive movable write latch on a SharedLatch */
+using UniqueLatch = BasicUniqueLatch<SharedLatch>;
+
+/** shared movable read latch on a SharedLatch */
+using SharedLatchGuard = BasicSharedLatchGuard<SharedLatch>;
+
 }  // namespace noisepage::common
@@ -339,6 +339,17 @@ struct atomic<noisepage::common::StrongTypeAlias<Tag, IntType>> {
     return underlying_.compare_exchange_strong(expected.UnderlyingValue(), desired.UnderlyingValue(), order);
   }
 
+  /**
+   * Atomically adds arg to the underlying value. The operation is read-modify-write operation.
+   * @param arg value to add.
+   * @param order memory order constraints to enforce.
+   * @return The value of the atomic variable before the call.
+   */
+  // NOLINTNEXTLINE match underlying API
+  t fetch_add(IntType arg, memory_order order = memory_order_seq_cst) volatile noexcept {
+    return t(underlying_.fetch_add(arg, order));
+  }
+
   /**
    * Atomic pre-increment.
    * @return the value of the atomic variable after the modification.
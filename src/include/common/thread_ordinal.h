@@ -0,0 +1,19 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace noisepage::common {
+
+/**
+ * @return a number that is unique to the calling thread, counting from 0 in the order that threads first ask for one.
+ * Structures that keep per-thread slots, e.g., of counters or caches, take it modulo their number of slots, which
+ * spreads threads evenly over the slots.
+ */
+inline uint32_t ThreadOrdinal() {
+  static std::atomic<uint32_t> next_ordinal{0};
+  static thread_local const uint32_t ordinal = next_ordinal.fetch_add(1, std::memory_order_relaxed);
+  return ordinal;
+}
+
+}  // namespace noisepage::common
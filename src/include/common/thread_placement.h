@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace noisepage::common {
+
+/** The kinds of threads that a ThreadPlacement places separately */
+enum class ThreadRole : uint8_t {
+  /** Any thread without a more specific role, including the execution workers */
+  OTHER = 0,
+  /** The log serializer and disk log consumer threads, which make up the write-ahead log pipeline */
+  WAL,
+  /** The garbage collector thread */
+  GARBAGE_COLLECTION,
+  /** The connection dispatcher and connection handler threads */
+  NETWORK,
+  /** The metrics, messenger and recovery threads */
+  BACKGROUND,
+  /** Number of roles, not a role itself */
+  NUM_ROLES
+};
+
+/**
+ * Decides which CPUs the threads of each role run on, and with which scheduling policy. Threads place themselves by
+ * calling Apply with their role when they start.
+ *
+ * A role without CPUs of its own runs on the CPUs that the process was allowed to run on when the placement was
+ * created, minus the CPUs of isolated roles. A role can thus get cores to itself, e.g. to keep the execution workers
+ * from preempting the WAL pipeline. A placement without any policy leaves every thread alone.
+ */
+class ThreadPlacement {
+ public:
+  /** How the threads of one role are placed */
+  struct Policy {
+    /** CPUs that the threads run on, or empty to use the CPUs that no isolated role holds */
+    std::vector<uint32_t> cpus_;
+    /** Whether no other role may use the CPUs */
+    bool isolated_ = false;
+    /** Whether to run the threads with the SCHED_FIFO real-time policy, which needs CAP_SYS_NICE */
+    bool realtime_ = false;
+  };
+
+  /** Create a placement without any policy, remembering the CPUs that the calling thread may run on */
+  ThreadPlacement();
+
+  /**
+   * Set how the threads of a role are placed, from now on
+   * @param role role of the threads
+   * @param policy how to place them
+   */
+  void SetPolicy(ThreadRole role, Policy policy);
+
+  /**
+   * @param role role of the threads
+   * @return how the threads of the role are placed
+   */
+  const Policy &GetPolicy(ThreadRole role) const { return policies_[static_cast<uint8_t>(role)]; }
+
+  /** @return true if any role has a policy, false if the placement leaves every thread alone */
+  bool IsEnabled() const { return enabled_; }
+
+  /**
+   * @param role role of the threads
+   * @return the CPUs that the threads of the role run on, or an empty list if the placement leaves them alone
+   */
+  std::vector<uint32_t> CpusOf(ThreadRole role) const;
+
+  /**
+   * Place the calling thread. Failures, e.g. for a lack of privileges, are logged and otherwise ignored.
+   * @param role role of the calling thread
+   */
+  void Apply(ThreadRole role) const;
+
+  /**
+   * Parse a list of CPUs like "0-3,8,node1", where "nodeN" stands for all CPUs of NUMA node N.
+   * @param list the list, which may be empty
+   * @return the CPUs in the list, sorted and without duplicates
+   * @throw SettingsException if the list is malformed
+   */
+  static std::vector<uint32_t> ParseCpuList(std::string_view list);
+
+ private:
+  std::array<Policy, static_cast<uint8_t>(ThreadRole::NUM_ROLES)> policies_;
+  // The CPUs that the process may run on
+  std::vector<uint32_t> process_cpus_;
+  bool enabled_ = false;
+};
+
+}  // namespace noisepage::common
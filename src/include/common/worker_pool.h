@@ -1,34 +1,40 @@
 #pragma once
 #include <atomic>
-#include <condition_variable>  // NOLINT
 #include <functional>
-#include <mutex>  // NOLINT
+#include <memory>
 #include <queue>
 #include <string>
 #include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
+#include "common/constants.h"
+#include "common/container/concurrent_queue.h"
+#include "common/container/work_stealing_deque.h"
+#include "common/futex.h"
 #include "common/macros.h"
 
 namespace noisepage::common {
 
 /**
  * A task queue is a FIFO list of functions that we will execute.
- * This queue by itself is not threadsafe so the WorkerPool class has to protect
- * it on its own with latches.
+ * It holds the tasks that a WorkerPool starts with.
  */
 using TaskQueue = std::queue<std::function<void()>>;
 
 /**
- * A worker pool that maintains a group of worker threads and a task queue.
+ * A work-stealing worker pool that maintains a group of worker threads.
  *
- * As soon as there is a task in the task queue, a worker thread will be
- * assigned to run that task. A task must be a function that takes no argument.
- * After a worker finishes a task, it will eagerly try to get a new task.
+ * Every worker owns a deque of tasks. Tasks that a worker submits go to the bottom of its own deque, where it picks
+ * them up again without contending with anyone. Tasks from other threads go through a shared concurrent queue
+ * instead. A worker that runs out of tasks takes them from the shared queue, and then steals them from the top of the
+ * other workers' deques. Only when there is nothing left anywhere does it park, on a futex, until new tasks wake it.
+ * A task must be a function that takes no argument.
+ *
+ * Tasks are not run in the order they are submitted.
  *
  * This pool is restartable, meaning it can be started again after it has been
- * shutdown. Calls to Startup() and Shutdown() are thread-safe.
+ * shutdown. Tasks that did not run before a shutdown run after the next startup.
  */
 class WorkerPool {
  public:
@@ -39,39 +45,31 @@ class WorkerPool {
    * @param task_queue a queue of tasks
    */
   // NOLINTNEXTLINE  lint thinks it has only one arguement
-  WorkerPool(uint32_t num_workers, TaskQueue task_queue)
-      : num_workers_(num_workers), is_running_(false), task_queue_(std::move(task_queue)), busy_workers_{0} {
-    // Walk it off, son. We have nothing else to do here...
+  WorkerPool(uint32_t num_workers, TaskQueue task_queue) : num_workers_(num_workers) {
+    pending_tasks_.store(static_cast<uint32_t>(task_queue.size()));
+    for (; !task_queue.empty(); task_queue.pop()) injected_tasks_.Enqueue(new Task(std::move(task_queue.front())));
   }
 
+  DISALLOW_COPY_AND_MOVE(WorkerPool)
+
   /**
    * Destructor. Wake up all workers and let them finish before it's destroyed.
    */
   ~WorkerPool() {
-    std::unique_lock<std::mutex> lock(task_lock_);  // grab the lock
-    is_running_ = false;                            // signal all the threads to shutdown
-    task_cv_.notify_all();                          // wake up all the threads
-    lock.unlock();                                  // free the lock
-    for (auto &thread : workers_) thread.join();
+    Shutdown();
+    Task *task;
+    while (injected_tasks_.Dequeue(&task)) delete task;
   }
 
   /**
-   * Start the worker pool. If the task queue is empty or we run out of tasks,
+   * Start the worker pool. If there are no tasks or we run out of tasks,
    * workers will be put into sleep.
    */
   void Startup() {
     NOISEPAGE_ASSERT(!is_running_, "Trying to start a WorkerPool that is already running");
-    {
-      std::lock_guard lock(task_lock_);
-      is_running_ = true;
-    }
-
-    // Create enough workers if necessary
-    while (workers_.size() < num_workers_) {
-      AddThread();
-    }
-    // Cut down the number of workers if we have too many workers
-    if (workers_.size() > num_workers_) workers_.resize(num_workers_);
+    is_running_.store(true);
+    for (uint32_t i = 0; i < num_workers_; i++) deques_.emplace_back(std::make_unique<WorkStealingDeque<Task>>());
+    for (uint32_t i = 0; i < num_workers_; i++) workers_.emplace_back([this, i] { Work(i); });
   }
 
   /**
@@ -79,20 +77,24 @@ class WorkerPool {
    * No more tasks will be consumed. It waits until all worker threads stop working.
    */
   void Shutdown() {
-    {
-      std::lock_guard<std::mutex> lock(task_lock_);
-      is_running_ = false;
-    }
+    is_running_.store(false);
     // tell everyone to stop working
-    task_cv_.notify_all();
+    sleep_epoch_.fetch_add(1);
+    Futex::WakeAll(&sleep_epoch_);
     for (auto &worker : workers_) {
       worker.join();
     }
     workers_.clear();
+
+    // Keep the tasks that did not run for the next startup. The owners of the deques are gone.
+    for (auto &deque : deques_) {
+      while (auto *task = deque->Pop()) injected_tasks_.Enqueue(task);
+    }
+    deques_.clear();
   }
 
   /**
-   * Add a task to the task queue and inform worker threads.
+   * Add a task to the pool and inform worker threads.
    * You can only submit tasks after the thread pool has started up.
    *
    * @param func the new task
@@ -100,22 +102,37 @@ class WorkerPool {
   template <typename F>
   void SubmitTask(const F &func) {
     NOISEPAGE_ASSERT(is_running_, "Only allow to submit task after the thread pool has been started up");
-    {
-      std::lock_guard<std::mutex> lock(task_lock_);
-      task_queue_.emplace(std::move(func));
+    auto *task = new Task(func);
+    // Count the task before anyone can run it, so that it is never seen as finished before it is started
+    pending_tasks_.fetch_add(1);
+
+    const WorkerId &current = CurrentWorker();
+    if (current.pool_ == this) {
+      deques_[current.id_]->Push(task);
+    } else {
+      injected_tasks_.Enqueue(task);
+    }
+
+    // Only go to the kernel if some worker is asleep or about to be. Either it sees the task, or we see it.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (idle_workers_.load(std::memory_order_relaxed) > 0) {
+      sleep_epoch_.fetch_add(1);
+      Futex::Wake(&sleep_epoch_, 1);
     }
-    task_cv_.notify_one();
   }
 
   /**
-   * Block until all the tasks in the task queue has been completed
+   * Block until all the submitted tasks have been completed
    */
   void WaitUntilAllFinished() {
-    std::unique_lock<std::mutex> lock(task_lock_);
-    // wait for all the tasks to complete
-
-    // If finished_cv_ is notified by worker threads. Lost notify can happen.
-    finished_cv_.wait(lock, [&] { return busy_workers_ == 0 && task_queue_.empty(); });
+    while (true) {
+      const uint32_t pending = pending_tasks_.load();
+      if (pending == 0) return;
+      waiters_.fetch_add(1);
+      // Returns right away if the tasks were finished in between
+      Futex::Wait(&pending_tasks_, pending);
+      waiters_.fetch_sub(1);
+    }
   }
 
   /**
@@ -137,54 +154,83 @@ class WorkerPool {
   }
 
  private:
+  using Task = std::function<void()>;
+
+  // The pool and the index of the worker that the current thread is, if any
+  struct WorkerId {
+    const WorkerPool *pool_;
+    uint32_t id_;
+  };
+
+  static WorkerId &CurrentWorker() {
+    static thread_local WorkerId current{nullptr, 0};
+    return current;
+  }
+
   // The worker threads
   std::vector<std::thread> workers_;
+  // The deque of every worker, by its index
+  std::vector<std::unique_ptr<WorkStealingDeque<Task>>> deques_;
   // The number of worker threads
   uint32_t num_workers_;
   // Flag indicating whether the pool is running
-  bool is_running_;
-  // The queue where workers pick up tasks
-  TaskQueue task_queue_;
-
-  uint32_t busy_workers_;
-
-  std::mutex task_lock_;
-
-  std::condition_variable task_cv_;
-
-  std::condition_variable finished_cv_;
-
-  void AddThread() {
-    workers_.emplace_back([this] {
-      std::function<void(void)> task;
-
-      // keep the thread alive
-      while (true) {
-        {
-          // grab the lock
-          std::unique_lock<std::mutex> lock(task_lock_);
-          // task_cv_ is notified by new tasks and shutdown command, but lost notify can happen.
-          task_cv_.wait(lock, [&] { return !is_running_ || !task_queue_.empty(); });
-          if (!is_running_) {
-            // we are shutting down.
-            return;
-          }
-          // Grab a new task
-          task = std::move(task_queue_.front());
-          task_queue_.pop();
-          ++busy_workers_;
-        }
-        // We don't hold locks at this point
-        task();
-        {
-          // hold the lock for updating the counter
-          std::lock_guard<std::mutex> lock(task_lock_);
-          --busy_workers_;
-        }
-        // After completing the task, we only need to tell the master thread
-        finished_cv_.notify_one();
+  std::atomic<bool> is_running_{false};
+  // Tasks submitted by threads that are not workers of this pool
+  ConcurrentQueue<Task *> injected_tasks_;
+
+  // Tasks that were submitted and did not finish yet, which WaitUntilAllFinished waits on
+  alignas(Constants::CACHELINE_SIZE) std::atomic<uint32_t> pending_tasks_{0};
+  // Threads in WaitUntilAllFinished
+  std::atomic<uint32_t> waiters_{0};
+  // Changes whenever parked workers should look for tasks again, which they wait on
+  alignas(Constants::CACHELINE_SIZE) std::atomic<uint32_t> sleep_epoch_{0};
+  // Workers that are parked or about to park
+  std::atomic<uint32_t> idle_workers_{0};
+
+  void Work(const uint32_t id) {
+    CurrentWorker() = {this, id};
+    // xorshift state to pick the first worker to steal from
+    uint32_t victim_seed = id * 2654435761U + 1;
+
+    while (is_running_.load(std::memory_order_relaxed)) {
+      if (Task *task = FindTask(id, &victim_seed); task != nullptr) {
+        (*task)();
+        delete task;
+        if (pending_tasks_.fetch_sub(1) == 1 && waiters_.load() > 0) Futex::WakeAll(&pending_tasks_);
+        continue;
       }
-    });
+
+      // Park. Announce it first, so that a thread that submits a task after we last looked wakes us.
+      idle_workers_.fetch_add(1);
+      const uint32_t epoch = sleep_epoch_.load();
+      if (is_running_.load() && !HasTasks()) Futex::Wait(&sleep_epoch_, epoch);
+      idle_workers_.fetch_sub(1);
+    }
+    CurrentWorker() = {nullptr, 0};
+  }
+
+  Task *FindTask(const uint32_t id, uint32_t *const victim_seed) {
+    if (Task *task = deques_[id]->Pop(); task != nullptr) return task;
+    if (Task *task; injected_tasks_.Dequeue(&task)) return task;
+
+    *victim_seed ^= *victim_seed << 13;
+    *victim_seed ^= *victim_seed >> 17;
+    *victim_seed ^= *victim_seed << 5;
+    const auto num_deques = static_cast<uint32_t>(deques_.size());
+    for (uint32_t i = 0; i < num_deques; i++) {
+      const uint32_t victim = (*victim_seed + i) % num_deques;
+      if (victim == id) continue;
+      if (Task *task = deques_[victim]->Steal(); task != nullptr) return task;
+    }
+    return nullptr;
+  }
+
+  bool HasTasks() {
+    if (!injected_tasks_.Empty()) return true;
+    for (const auto &deque : deques_) {
+      if (!deque->Empty()) return true;
+    }
+    return false;
   }
 };
 }  // namespace noisepage::common
@@ -41,6 +41,10 @@ namespace noisepage::execution::ast {
   F(ExecutionContextGetTLS, execCtxGetTLS)                              \
   F(ExecutionContextRegisterHook, execCtxRegisterHook)                  \
   F(ExecutionContextClearHooks, execCtxClearHooks)                      \
+  F(ExecutionContextCheckInterrupt, execCtxCheckInterrupt)              \
+  F(ExecutionContextScaleSampledCount, execCtxScaleSampledCount)        \
+  F(ExecutionContextScaleSampledDistinct, execCtxScaleSampledDistinct)  \
+  F(ExecutionContextAnalyzeColumnGroups, execCtxAnalyzeColumnGroups)    \
   F(ExecutionContextInitHooks, execCtxInitHooks)                        \
   F(ThreadStateContainerReset, tlsReset)                                \
   F(ThreadStateContainerGetState, tlsGetCurrentThreadState)             \
@@ -57,6 +61,11 @@ namespace noisepage::execution::ast {
   F(TableIterGetVPINumTuples, tableIterGetVPINumTuples)                 \
   F(TableIterGetVPI, tableIterGetVPI)                                   \
   F(TableIterClose, tableIterClose)                                     \
+  F(TableIterFilterBlocks, tableIterFilterBlocks)                       \
+  F(TableIterFilterBlocksTopK, tableIterFilterBlocksTopK)               \
+  F(TableIterSampleBlocks, tableIterSampleBlocks)                       \
+  F(TableIterLateMaterialize, tableIterLateMaterialize)                 \
+  F(TableIterFetchLateColumns, tableIterFetchLateColumns)               \
   F(TableIterParallel, iterateTableParallel)                            \
   F(TableIterCreateIndexParallel, iterateTableCreateIndexParallel)      \
                                                                         \
@@ -135,6 +144,15 @@ namespace noisepage::execution::ast {
   F(VectorFilterNotEqual, filterNe)                                     \
   F(VectorFilterLike, filterLike)                                       \
   F(VectorFilterNotLike, filterNotLike)                                 \
+  /* Vector Expression Execution */                                     \
+  F(VectorProjectionInit, vpInit)                                       \
+  F(VectorProjectionExtend, vpExtend)                                   \
+  F(VectorProjectionFree, vpFree)                                       \
+  F(VectorCast, vectorCast)                                             \
+  F(VectorDatePart, vectorDatePart)                                     \
+  F(VectorAdd, vectorAdd)                                               \
+  F(VectorSub, vectorSub)                                               \
+  F(VectorMul, vectorMul)                                               \
                                                                         \
   /* Aggregations */                                                    \
   F(AggHashTableInit, aggHTInit)                                        \
@@ -142,7 +160,11 @@ namespace noisepage::execution::ast {
   F(AggHashTableGetInsertCount, aggHTGetInsertCount)                    \
   F(AggHashTableInsert, aggHTInsert)                                    \
   F(AggHashTableLinkEntry, aggHTLink)                                   \
+  F(AggHashTableInternString, aggHTInternString)                        \
   F(AggHashTableLookup, aggHTLookup)                                    \
+  F(AggHashTableSetDenseDomain, aggHTSetDenseDomain)                    \
+  F(AggHashTableLookupDense, aggHTLookupDense)                          \
+  F(AggHashTableInsertDense, aggHTInsertDense)                          \
   F(AggHashTableProcessBatch, aggHTProcessBatch)                        \
   F(AggHashTableMovePartitions, aggHTMoveParts)                         \
   F(AggHashTableParallelPartitionedScan, aggHTParallelPartScan)         \
@@ -159,6 +181,7 @@ namespace noisepage::execution::ast {
   F(AggPartIterGetRowEntry, aggPartIterGetRowEntry)                     \
   F(AggInit, aggInit)                                                   \
   F(AggAdvance, aggAdvance)                                             \
+  F(AggAdvanceVector, aggAdvanceVector)                                 \
   F(AggMerge, aggMerge)                                                 \
   F(AggReset, aggReset)                                                 \
   F(AggResult, aggResult)                                               \
@@ -171,6 +194,13 @@ namespace noisepage::execution::ast {
   F(JoinHashTableBuildParallel, joinHTBuildParallel)                    \
   F(JoinHashTableGetTupleCount, joinHTGetTupleCount)                    \
   F(JoinHashTableLookup, joinHTLookup)                                  \
+  F(JoinHashTableEnableSpilling, joinHTEnableSpilling)                  \
+  F(JoinHashTableIsSpilled, joinHTIsSpilled)                            \
+  F(JoinHashTableSpillProbe, joinHTSpillProbe)                          \
+  F(JoinHashTableEnableRuntimeFilter, joinHTEnableRuntimeFilter)        \
+  F(JoinHashTableEnableCompactLayout, joinHTEnableCompactLayout)        \
+  F(JoinHashTableMayContain, joinHTMayContain)                          \
+  F(JoinHashTableProcessSpilled, joinHTProcessSpilled)                  \
   F(JoinHashTableFree, joinHTFree)                                      \
                                                                         \
   /* Hash Table Entry Iterator (for hash joins) */                      \
@@ -185,10 +215,14 @@ namespace noisepage::execution::ast {
                                                                         \
   /* Sorting */                                                         \
   F(SorterInit, sorterInit)                                             \
+  F(SorterSetNormalizedKey, sorterSetNormalizedKey)                     \
+  F(SorterNormalizeKey, sorterNormalizeKey)                             \
   F(SorterGetTupleCount, sorterGetTupleCount)                           \
   F(SorterInsert, sorterInsert)                                         \
   F(SorterInsertTopK, sorterInsertTopK)                                 \
   F(SorterInsertTopKFinish, sorterInsertTopKFinish)                     \
+  F(SorterShareTopKBound, sorterShareTopKBound)                         \
+  F(SorterGetTopKBound, sorterGetTopKBound)                             \
   F(SorterSort, sorterSort)                                             \
   F(SorterSortParallel, sorterSortParallel)                             \
   F(SorterSortTopKParallel, sorterSortTopKParallel)                     \
@@ -213,6 +247,7 @@ namespace noisepage::execution::ast {
   F(IndexIteratorScanAscending, indexIteratorScanAscending)             \
   F(IndexIteratorScanDescending, indexIteratorScanDescending)           \
   F(IndexIteratorScanLimitDescending, indexIteratorScanLimitDescending) \
+  F(IndexIteratorParallel, iterateIndexParallel)                        \
   F(IndexIteratorAdvance, indexIteratorAdvance)                         \
   F(IndexIteratorGetPR, indexIteratorGetPR)                             \
   F(IndexIteratorGetLoPR, indexIteratorGetLoPR)                         \
@@ -376,6 +411,10 @@ namespace noisepage::execution::ast {
   F(ExecutionContextEndResourceTracker, execCtxEndResourceTracker)      \
   F(ExecutionContextStartPipelineTracker, execCtxStartPipelineTracker)  \
   F(ExecutionContextEndPipelineTracker, execCtxEndPipelineTracker)      \
+  F(ExecutionContextStartPipelineProfile, execCtxStartPipelineProfile)  \
+  F(ExecutionContextEndPipelineProfile, execCtxEndPipelineProfile)      \
+  F(ExecutionContextRecordOperatorRows, execCtxRecordOperatorRows)      \
+  F(ExecutionContextCheckCardinality, execCtxCheckCardinality)          \
                                                                         \
   F(RegisterThreadWithMetricsManager, registerThreadWithMetricsManager) \
   F(EnsureTrackersStopped, ensureTrackersStopped)                       \
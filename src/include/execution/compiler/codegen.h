@@ -16,6 +16,7 @@
 #include "execution/ast/type.h"
 #include "execution/sql/runtime_types.h"
 #include "execution/sql/sql.h"
+#include "execution/sql/sql_def.h"
 #include "parser/expression_defs.h"
 #include "planner/plannodes/plan_node_defs.h"
 #include "self_driving/modeling/operating_unit.h"
@@ -585,6 +586,51 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *TableIterClose(ast::Expr *table_iter);
 
+  /**
+   * Call \@tableIterFilterBlocks(). Skip the blocks whose zone maps rule out every value within [min, max] in a column.
+   * @param table_iter The table vector iterator.
+   * @param col_idx The index of the column amongst the columns the iterator reads.
+   * @param min The lower bound of the values of interest, inclusive.
+   * @param max The upper bound of the values of interest, inclusive.
+   * @return The call expression.
+   */
+  [[nodiscard]] ast::Expr *TableIterFilterBlocks(ast::Expr *table_iter, uint32_t col_idx, int64_t min, int64_t max);
+
+  /**
+   * Call \@tableIterFilterBlocksTopK(). Skip the blocks whose zone maps rule out every value of a column that may still
+   * make it into the top-K of a sorter.
+   * @param table_iter The table vector iterator.
+   * @param col_idx The index of the column amongst the columns the iterator reads.
+   * @param sorter The sorter whose top-K bound is filtered on.
+   * @param descending True if the sorter sorts the column in descending order.
+   * @return The call expression.
+   */
+  [[nodiscard]] ast::Expr *TableIterFilterBlocksTopK(ast::Expr *table_iter, uint32_t col_idx, ast::Expr *sorter,
+                                                     bool descending);
+
+  /**
+   * Call \@tableIterSampleBlocks(). Only read a random sample of the blocks of the table.
+   * @param table_iter The table vector iterator.
+   * @param num_blocks The number of blocks to read.
+   * @return The call expression.
+   */
+  [[nodiscard]] ast::Expr *TableIterSampleBlocks(ast::Expr *table_iter, uint32_t num_blocks);
+
+  /**
+   * Call \@tableIterLateMaterialize(). Only read a column for the tuples that pass the filters of the scan.
+   * @param table_iter The table vector iterator.
+   * @param col_idx The index of the column amongst the columns the iterator reads.
+   * @return The call expression.
+   */
+  [[nodiscard]] ast::Expr *TableIterLateMaterialize(ast::Expr *table_iter, uint32_t col_idx);
+
+  /**
+   * Call \@tableIterFetchLateColumns(). Read the late columns of the tuples that passed the filters of the scan.
+   * @param table_iter The table vector iterator.
+   * @return The call expression.
+   */
+  [[nodiscard]] ast::Expr *TableIterFetchLateColumns(ast::Expr *table_iter);
+
   /**
    * Call \@iterateTableParallel(). Performs a parallel scan over the table with the provided name,
    * using the provided query state and thread-state container and calling the provided scan
@@ -651,6 +697,18 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *IndexIteratorScan(ast::Expr *iter_ptr, planner::IndexScanType scan_type, uint32_t limit);
 
+  /**
+   * Call \@iterateIndexParallel(iter_ptr, scan_type, query_state, worker_name). Scans the range between the keys of
+   * the index iterator in parallel, calling the work function on the partitions of the range.
+   * @param iter_ptr Pointer to the index iterator whose keys bound the range.
+   * @param scan_type The type of scan to perform, which must be an ascending scan.
+   * @param query_state The query state pointer.
+   * @param worker_name The work function name.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *IterateIndexParallel(ast::Expr *iter_ptr, planner::IndexScanType scan_type,
+                                                ast::Expr *query_state, ast::Identifier worker_name);
+
   // -------------------------------------------------------
   //
   // VPI stuff
@@ -759,6 +817,15 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *FilterManagerInit(ast::Expr *filter_manager, ast::Expr *exec_ctx);
 
+  /**
+   * Call \@filterManagerInit(). Initialize the provided filter manager instance, whose terms get the provided
+   * context instead of the query state.
+   * @param filter_manager The filter manager pointer.
+   * @param exec_ctx The execution context variable.
+   * @param context The pointer passed to the terms.
+   */
+  [[nodiscard]] ast::Expr *FilterManagerInit(ast::Expr *filter_manager, ast::Expr *exec_ctx, ast::Expr *context);
+
   /**
    * Call \@filterManagerFree(). Destroy and clean up the provided filter manager instance.
    * @param filter_manager The filter manager pointer.
@@ -781,6 +848,67 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *FilterManagerRunFilters(ast::Expr *filter_manager, ast::Expr *vpi, ast::Expr *exec_ctx);
 
+  // -------------------------------------------------------
+  //
+  // Vector expression stuff
+  //
+  // -------------------------------------------------------
+
+  /**
+   * Call \@vpInit(). Initialize the provided vector projection with columns of the given types.
+   * @param vp The vector projection pointer.
+   * @param col_types The name of the uint32 array holding the sql::TypeId of every column.
+   */
+  [[nodiscard]] ast::Expr *VectorProjectionInit(ast::Expr *vp, ast::Identifier col_types);
+
+  /**
+   * Call \@vpExtend(). Extend the projection the provided VPI iterates over into the provided
+   * vector projection, whose leading columns then reference the columns of the iterated one.
+   * @param vp The vector projection pointer.
+   * @param vpi The vector projection iterator.
+   */
+  [[nodiscard]] ast::Expr *VectorProjectionExtend(ast::Expr *vp, ast::Expr *vpi);
+
+  /**
+   * Call \@vpFree(). Destroy and clean up the provided vector projection.
+   * @param vp The vector projection pointer.
+   */
+  [[nodiscard]] ast::Expr *VectorProjectionFree(ast::Expr *vp);
+
+  /**
+   * Call \@vectorCast(). Cast a column of the vector projection into another of its columns.
+   * @param exec_ctx The execution context that we are running in.
+   * @param vp The vector projection.
+   * @param result_col_idx The index of the column to write into.
+   * @param col_idx The index of the column to cast.
+   */
+  [[nodiscard]] ast::Expr *VectorCast(ast::Expr *exec_ctx, ast::Expr *vp, uint32_t result_col_idx, uint32_t col_idx);
+
+  /**
+   * Call \@vectorDatePart(). Extract a part of the dates in a column of the vector projection into
+   * another of its columns.
+   * @param exec_ctx The execution context that we are running in.
+   * @param vp The vector projection.
+   * @param result_col_idx The index of the column to write into.
+   * @param col_idx The index of the column of dates.
+   * @param part The part to extract.
+   */
+  [[nodiscard]] ast::Expr *VectorDatePart(ast::Expr *exec_ctx, ast::Expr *vp, uint32_t result_col_idx, uint32_t col_idx,
+                                          sql::DatePartType part);
+
+  /**
+   * Call \@vector[Operation](). Apply an arithmetic operation to whole columns of the vector
+   * projection, writing the results into another of its columns.
+   * @param exec_ctx The execution context that we are running in.
+   * @param vp The vector projection.
+   * @param op_type The arithmetic operation, one of addition, subtraction or multiplication.
+   * @param result_col_idx The index of the column to write into.
+   * @param left The left operand, either a column index or a constant SQL value.
+   * @param right The right operand, either a column index or a constant SQL value.
+   */
+  [[nodiscard]] ast::Expr *VectorArithmetic(ast::Expr *exec_ctx, ast::Expr *vp, parser::ExpressionType op_type,
+                                            uint32_t result_col_idx, ast::Expr *left, ast::Expr *right);
+
   /**
    * Call \@execCtxRegisterHook(exec_ctx, hook_idx, hook).
    * @param exec_ctx The execution context to modify.
@@ -797,6 +925,42 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *ExecCtxClearHooks(ast::Expr *exec_ctx);
 
+  /**
+   * Call \@execCtxCheckInterrupt(exec_ctx). Stops the query if it was canceled or ran out of time.
+   * @param exec_ctx The execution context of the query.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *ExecCtxCheckInterrupt(ast::Expr *exec_ctx);
+
+  /**
+   * Call \@execCtxScaleSampledCount(exec_ctx, count). Scales a count over the sample of a table up to the whole table.
+   * @param exec_ctx The execution context of the query.
+   * @param count The SQL integer count over the sample.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *ExecCtxScaleSampledCount(ast::Expr *exec_ctx, ast::Expr *count);
+
+  /**
+   * Call \@execCtxScaleSampledDistinct(exec_ctx, num_distinct, count). Estimates the number of distinct values of a
+   * column in the whole table from the ones in the sample of the table.
+   * @param exec_ctx The execution context of the query.
+   * @param num_distinct The SQL integer number of distinct values in the sample.
+   * @param count The SQL integer number of non-NULL values in the sample.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *ExecCtxScaleSampledDistinct(ast::Expr *exec_ctx, ast::Expr *num_distinct, ast::Expr *count);
+
+  /**
+   * Call \@execCtxAnalyzeColumnGroups(exec_ctx, table_oid, col_oid). Computes the statistics of the groups of columns
+   * of a table that start with a column, @see sql::ColumnGroupAnalyzer.
+   * @param exec_ctx The execution context of the query.
+   * @param table_oid The OID of the analyzed table.
+   * @param col_oid The OID of the first column of the groups.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *ExecCtxAnalyzeColumnGroups(ast::Expr *exec_ctx, catalog::table_oid_t table_oid,
+                                                      catalog::col_oid_t col_oid);
+
   /**
    * Call \@execCtxInitHooks(exec_ctx, num_hooks).
    * @param exec_ctx The execution context to modify.
@@ -954,6 +1118,73 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *JoinHashTableLookup(ast::Expr *join_hash_table, ast::Expr *entry_iter, ast::Expr *hash_val);
 
+  /**
+   * Call \@joinHTEnableSpilling(). Allow the provided join hash table to spill partitions of its
+   * build side when it is larger than the join memory budget.
+   * @param join_hash_table The join hash table.
+   * @param probe_row_type_name The name of the struct type of the probe tuples that are spilled.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableEnableSpilling(ast::Expr *join_hash_table,
+                                                       ast::Identifier probe_row_type_name);
+
+  /**
+   * Call \@joinHTIsSpilled(). Determine if probe tuples with the provided hash value fall into a
+   * spilled partition of the join hash table, and must be spilled rather than looked up.
+   * @param join_hash_table The join hash table.
+   * @param hash_val The hash value of the probe key.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableIsSpilled(ast::Expr *join_hash_table, ast::Expr *hash_val);
+
+  /**
+   * Call \@joinHTEnableRuntimeFilter(). Have the provided join hash table build a bloom filter over
+   * its whole build side, to discard probe tuples before they are probed.
+   * @param join_hash_table The join hash table.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableEnableRuntimeFilter(ast::Expr *join_hash_table);
+
+  /**
+   * Call \@joinHTEnableCompactLayout(). Have the provided join hash table store its tuples without
+   * entry headers, grouped by bucket, once it is built.
+   * @param join_hash_table The join hash table.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableEnableCompactLayout(ast::Expr *join_hash_table);
+
+  /**
+   * Call \@joinHTMayContain(). Determine if a build tuple of the provided join hash table may have
+   * the provided hash value, according to its runtime filter.
+   * @param join_hash_table The join hash table.
+   * @param hash_val The hash value of the probe key.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableMayContain(ast::Expr *join_hash_table, ast::Expr *hash_val);
+
+  /**
+   * Call \@joinHTSpillProbe(). Set the provided probe tuple aside until its partition is joined.
+   * @param join_hash_table The join hash table.
+   * @param hash_val The hash value of the probe key.
+   * @param probe_row A pointer to the probe tuple.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableSpillProbe(ast::Expr *join_hash_table, ast::Expr *hash_val,
+                                                   ast::Expr *probe_row);
+
+  /**
+   * Call \@joinHTProcessSpilled(). Join the spilled partitions of the join hash table one at a time,
+   * calling the provided function with the query state, the pipeline state and each spilled probe
+   * tuple.
+   * @param join_hash_table The join hash table.
+   * @param query_state The query state.
+   * @param pipeline_state The pipeline state.
+   * @param probe_fn The name of the function probing the table with a spilled tuple.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *JoinHashTableProcessSpilled(ast::Expr *join_hash_table, ast::Expr *query_state,
+                                                       ast::Expr *pipeline_state, ast::Identifier probe_fn);
+
   /**
    * Call \@joinHTFree(). Cleanup and destroy the provided join hash table instance.
    * @param join_hash_table The join hash table.
@@ -1064,6 +1295,45 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *AggHashTableLinkEntry(ast::Expr *agg_ht, ast::Expr *entry);
 
+  /**
+   * Call \@aggHTInternString(). Copies the string key of a new group into the provided aggregation
+   * hash table, so that it stays valid for as long as the table does.
+   * @param agg_ht A pointer to the aggregation hash table.
+   * @param key A pointer to the string key of the group.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *AggHashTableInternString(ast::Expr *agg_ht, ast::Expr *key);
+
+  /**
+   * Call \@aggHTSetDenseDomain(). Index the groups of keys in the given range by their keys.
+   * @param agg_ht A pointer to the aggregation hash table.
+   * @param min_key The smallest key in the range.
+   * @param num_keys The number of keys in the range.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *AggHashTableSetDenseDomain(ast::Expr *agg_ht, int64_t min_key, uint32_t num_keys);
+
+  /**
+   * Call \@aggHTLookupDense(). Looks up the group of a key in the dense domain of an aggregation
+   * hash table. The result of the lookup is casted to the provided type.
+   * @param agg_ht A pointer to the aggregation hash table.
+   * @param key The SQL integer key.
+   * @param agg_payload_type The name of the struct representing the aggregation payload.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *AggHashTableLookupDense(ast::Expr *agg_ht, ast::Expr *key,
+                                                   ast::Identifier agg_payload_type);
+
+  /**
+   * Call \@aggHTInsertDense(). Indexes a newly inserted group in the dense domain of an aggregation
+   * hash table.
+   * @param agg_ht A pointer to the aggregation hash table.
+   * @param key The SQL integer key of the group.
+   * @param agg_payload A pointer to the payload of the group.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *AggHashTableInsertDense(ast::Expr *agg_ht, ast::Expr *key, ast::Expr *agg_payload);
+
   /**
    * Call \@aggHTMoveParts(). Move all overflow partitions stored in thread-local aggregation hash
    * tables at the given offset inside the provided thread state container into the global hash
@@ -1189,6 +1459,25 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *AggregatorAdvance(ast::Expr *agg, ast::Expr *val);
 
+  /**
+   * Call \@aggAdvanceVector(). Advance an aggregator with the active, non-NULL values of a column of
+   * a vector projection, all at once.
+   * @param agg A pointer to the aggregator.
+   * @param vpi The vector projection iterator over the values.
+   * @param col_idx The index of the column.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *AggregatorAdvanceVector(ast::Expr *agg, ast::Expr *vpi, uint32_t col_idx);
+
+  /**
+   * Call \@aggAdvanceVector() without a column. Advance a count by the number of active tuples of a
+   * vector projection, as COUNT(*) does.
+   * @param agg A pointer to the count aggregator.
+   * @param vpi The vector projection iterator over the tuples.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *AggregatorAdvanceVector(ast::Expr *agg, ast::Expr *vpi);
+
   /**
    * Call \@aggMerge(). Merges two aggregators storing the result in the first argument.
    * @param agg1 A pointer to the aggregator.
@@ -1232,6 +1521,22 @@ class CodeGen {
   [[nodiscard]] ast::Expr *SorterInit(ast::Expr *sorter, ast::Expr *exec_ctx, ast::Identifier cmp_func_name,
                                       ast::Identifier sort_row_type_name);
 
+  /**
+   * Call \@sorterSetNormalizedKey(). Make the provided sorter radix sort on the normalized keys
+   * that the given function computes.
+   * @param sorter The sorter instance.
+   * @param key_func_name The name of the normalized key function to use.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *SorterSetNormalizedKey(ast::Expr *sorter, ast::Identifier key_func_name);
+
+  /**
+   * Call \@sorterNormalizeKey(). Encode the given SQL value into a normalized sort key.
+   * @param value The value to encode.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *SorterNormalizeKey(ast::Expr *value);
+
   /**
    * Call \@sorterInsert(). Prepare an insert into the provided sorter whose type is the given type.
    * @param sorter The sorter instance.
@@ -1258,6 +1563,22 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *SorterInsertTopKFinish(ast::Expr *sorter, uint64_t top_k);
 
+  /**
+   * Call \@sorterShareTopKBound(). Make the provided sorter tighten the top-K bound of another one.
+   * @param sorter The sorter instance, usually thread-local.
+   * @param other The sorter whose bound is tightened.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *SorterShareTopKBound(ast::Expr *sorter, ast::Expr *other);
+
+  /**
+   * Call \@sorterGetTopKBound(). Get the largest normalized key of a tuple that may still make it
+   * into the top-K of the provided sorter.
+   * @param sorter The sorter instance.
+   * @return The call.
+   */
+  [[nodiscard]] ast::Expr *SorterGetTopKBound(ast::Expr *sorter);
+
   /**
    * Call \@sorterSort().  Sort the provided sorter instance.
    * @param sorter The sorter instance.
@@ -1324,6 +1645,14 @@ class CodeGen {
    */
   [[nodiscard]] ast::Expr *SorterIterSkipRows(ast::Expr *iter, uint32_t n);
 
+  /**
+   * Call \@sorterIterSkipRows(). Skips N rows in the provided sorter iterator.
+   * @param iter The iterator.
+   * @param n The expression computing the number of rows to skip.
+   * @return The call expression.
+   */
+  [[nodiscard]] ast::Expr *SorterIterSkipRows(ast::Expr *iter, ast::Expr *n);
+
   /**
    * Call \@sorterIterGetRow(). Retrieves a pointer to the current iterator row casted to the
    * provided row type.
@@ -27,8 +27,9 @@ enum class CompilationMode : uint8_t {
   // generated up-front at once before execution.
   OneShot,
 
-  // Interleaved compilation is a mode that mixes code generation and execution.
-  // Query fragments are generated and executed in lock step.
+  // Interleaved compilation is a mode that mixes compilation and execution.
+  // Every pipeline becomes a query fragment of its own, which is compiled
+  // when execution reaches it, after the pipelines before it have run.
   Interleaved,
 };
 
@@ -123,6 +124,12 @@ class CompilationContext {
   /** @return True if we should record pipeline metrics */
   bool IsPipelineMetricsEnabled() const { return pipeline_metrics_enabled_; }
 
+  /** @return True if we should count the rows of operators and time pipelines for EXPLAIN ANALYZE */
+  bool IsProfilingEnabled() const { return profiling_enabled_; }
+
+  /** @return Number of blocks of a table that ANALYZE samples, 0 to read the whole table */
+  uint32_t GetAnalyzeSampleBlocks() const { return analyze_sample_blocks_; }
+
   /** @return Query Id associated with the query */
   query_id_t GetQueryId() const { return query_id_t{unique_id_}; }
 
@@ -176,6 +183,12 @@ class CompilationContext {
 
   // Whether pipeline metrics are enabled.
   bool pipeline_metrics_enabled_;
+
+  // Whether operators and pipelines are profiled.
+  bool profiling_enabled_;
+
+  // Number of blocks of a table that ANALYZE samples.
+  uint32_t analyze_sample_blocks_;
 };
 
 }  // namespace noisepage::execution::compiler
@@ -8,6 +8,7 @@
 #include "common/macros.h"
 #include "common/managed_pointer.h"
 #include "execution/util/timer.h"
+#include "execution/vm/vm_defs.h"
 
 namespace noisepage::execution {
 
@@ -94,6 +95,17 @@ class Compiler {
      */
     ast::Context *GetContext() const noexcept { return context_; }
 
+    /**
+     * Set the optimization pipeline the generated module is compiled to machine code with.
+     * @param profile The optimization profile.
+     */
+    void SetOptimizationProfile(vm::OptimizationProfile profile) noexcept { profile_ = profile; }
+
+    /**
+     * @return The optimization pipeline the generated module is compiled to machine code with.
+     */
+    vm::OptimizationProfile GetOptimizationProfile() const noexcept { return profile_; }
+
    private:
     // The name to assign the input
     const std::string name_;
@@ -103,6 +115,8 @@ class Compiler {
     ast::AstNode *root_;
     // The TPL source, if any
     const std::string *source_;
+    // The optimization pipeline of the generated module
+    vm::OptimizationProfile profile_{vm::OptimizationProfile::Balanced};
   };
 
   /**
@@ -1,7 +1,9 @@
 #pragma once
 
+#include <functional>
 #include <iosfwd>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
 #include <vector>
 
@@ -27,6 +29,10 @@ namespace sema {
 class ErrorReporter;
 }  // namespace sema
 
+namespace sql {
+class FilterOrderCache;
+}  // namespace sql
+
 namespace util {
 class Region;
 }  // namespace util
@@ -64,11 +70,23 @@ class ExecutableQuery {
     /**
      * Construct a fragment composed of the given functions from the given module.
      * @param functions The name of the functions to execute, in order.
+     * @param step_pipelines The pipeline each function runs, or INVALID_PIPELINE_ID if none.
      * @param teardown_fns The name of the teardown functions in the module, in order.
      * @param module The module that contains the functions.
      */
-    Fragment(std::vector<std::string> &&functions, std::vector<std::string> &&teardown_fns,
-             std::unique_ptr<vm::Module> module);
+    Fragment(std::vector<std::string> &&functions, std::vector<pipeline_id_t> &&step_pipelines,
+             std::vector<std::string> &&teardown_fns, std::unique_ptr<vm::Module> module);
+
+    /**
+     * Construct a fragment composed of the given functions, whose module is compiled the first
+     * time the fragment runs.
+     * @param functions The name of the functions to execute, in order.
+     * @param step_pipelines The pipeline each function runs, or INVALID_PIPELINE_ID if none.
+     * @param teardown_fns The name of the teardown functions in the module, in order.
+     * @param compile_fn The function compiling the module, returning null if compilation fails.
+     */
+    Fragment(std::vector<std::string> &&functions, std::vector<pipeline_id_t> &&step_pipelines,
+             std::vector<std::string> &&teardown_fns, std::function<std::unique_ptr<vm::Module>()> compile_fn);
 
     /**
      * Destructor.
@@ -76,26 +94,39 @@ class ExecutableQuery {
     ~Fragment();
 
     /**
-     * Run this fragment using the provided opaque query state object.
+     * Run this fragment using the provided opaque query state object, compiling it first if it has
+     * not been compiled yet.
      * @param query_state The query state.
      * @param mode The execution mode to run the query with.
+     * @return True if the fragment ran to completion; false if the query was aborted.
      */
-    void Run(std::byte query_state[], vm::ExecutionMode mode) const;
+    bool Run(std::byte query_state[], vm::ExecutionMode mode);
 
     /**
      * @return True if this fragment is compiled and executable.
      */
     bool IsCompiled() const { return module_ != nullptr; }
 
+    /**
+     * @return True if this fragment is compiled, or compiles itself the first time it runs.
+     */
+    bool IsExecutable() const { return module_ != nullptr || compile_fn_ != nullptr; }
+
    private:
     // The functions that must be run (in the provided order) to execute this
     // query fragment.
     std::vector<std::string> functions_;
+    // The pipeline each function runs, for the samples of the SamplingProfiler.
+    std::vector<pipeline_id_t> step_pipelines_;
 
     std::vector<std::string> teardown_fn_;
 
     // The module.
     std::unique_ptr<vm::Module> module_;
+    // Compiles the module if it has not been compiled yet. Cached queries can
+    // be run by several connections at once, one of them compiles.
+    std::function<std::unique_ptr<vm::Module>()> compile_fn_;
+    std::mutex compile_mutex_;
   };
 
   /**
@@ -152,6 +183,11 @@ class ExecutableQuery {
     return common::ManagedPointer(pipeline_operating_units_);
   }
 
+  /** @return The filter orders learned by the executions of this query. */
+  common::ManagedPointer<sql::FilterOrderCache> GetFilterOrderCache() const {
+    return common::ManagedPointer(filter_order_cache_);
+  }
+
   /** @return The Query Identifier */
   query_id_t GetQueryId() { return query_id_; }
 
@@ -180,6 +216,9 @@ class ExecutableQuery {
   // The pipeline operating units that were generated as part of this query.
   std::unique_ptr<selfdriving::PipelineOperatingUnits> pipeline_operating_units_;
 
+  // The filter orders learned by the executions of this query, which the next execution starts from.
+  std::unique_ptr<sql::FilterOrderCache> filter_order_cache_;
+
   // For mini_runners.cpp
 
   /** Legacy constructor that creates a hardcoded fragment with main(ExecutionContext*)->int32. */
@@ -10,6 +10,7 @@
 #include "execution/ast/ast_fwd.h"
 #include "execution/compiler/executable_query.h"
 #include "execution/util/region_containers.h"
+#include "execution/vm/vm_defs.h"
 
 namespace noisepage::execution::vm {
 class Module;
@@ -27,8 +28,10 @@ class ExecutableQueryFragmentBuilder {
   /**
    * Create a new TPL code container.
    * @param ctx The AST context to use.
+   * @param profile The optimization pipeline to compile the container's code to machine code with.
    */
-  explicit ExecutableQueryFragmentBuilder(ast::Context *ctx);
+  explicit ExecutableQueryFragmentBuilder(ast::Context *ctx,
+                                          vm::OptimizationProfile profile = vm::OptimizationProfile::Balanced);
 
   /**
    * This class cannot be copied or moved.
@@ -71,8 +74,9 @@ class ExecutableQueryFragmentBuilder {
   /**
    * Register the given function in this container;
    * @param decl The function declaration.
+   * @param pipeline_id The pipeline the function runs, if any.
    */
-  void RegisterStep(ast::FunctionDecl *decl);
+  void RegisterStep(ast::FunctionDecl *decl, pipeline_id_t pipeline_id = INVALID_PIPELINE_ID);
 
   /**
    * Compile the code in the container.
@@ -80,20 +84,40 @@ class ExecutableQueryFragmentBuilder {
    */
   std::unique_ptr<ExecutableQuery::Fragment> Compile();
 
+  /**
+   * Create a fragment of the code in the container that is compiled the first time it runs.
+   * @return The fragment.
+   */
+  std::unique_ptr<ExecutableQuery::Fragment> CompileOnFirstRun();
+
   /**
    * Add the teardown function to the query.
    * @param teardown_fn The teardown function to be added.
    */
   void AddTeardownFn(ast::FunctionDecl *teardown_fn) { teardown_fn_.push_back(teardown_fn); }
 
+ private:
+  // Build the file holding all declarations in the container.
+  ast::File *BuildFile();
+
+  // Compile the given file into a module, returning null on error.
+  static std::unique_ptr<vm::Module> CompileFile(ast::Context *ctx, ast::File *file, vm::OptimizationProfile profile);
+
+  // The names of the teardown functions.
+  std::vector<std::string> GetTeardownNames() const;
+
  private:
   // The AST context used to generate the TPL ast
   ast::Context *ctx_;
+  // The optimization pipeline of the compiled modules.
+  vm::OptimizationProfile profile_;
   // The list of all functions and structs.
   llvm::SmallVector<ast::StructDecl *, 16> structs_;
   llvm::SmallVector<ast::FunctionDecl *, 16> functions_;
   // The list of function steps in the fragment.
   std::vector<std::string> step_functions_;
+  // The pipeline each function step runs.
+  std::vector<pipeline_id_t> step_pipelines_;
 
   std::vector<ast::FunctionDecl *> teardown_fn_;
 };
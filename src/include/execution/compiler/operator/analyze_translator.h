@@ -83,12 +83,16 @@ class AnalyzeTranslator : public OperatorTranslator, public PipelineDriver {
   ast::Identifier col_oid_;
   ast::Identifier num_rows_;
   std::vector<ast::Identifier> aggregate_variables_;
+  // Statistics of the groups of columns that start with the current column
+  ast::Identifier col_groups_;
   // Maps a column oid to the variable that holds the value to insert into that column
   std::unordered_map<catalog::col_oid_t, ast::Identifier> pg_statistic_column_lookup_;
   StateDescriptor::Entry pg_statistic_index_iterator_;  ///< IndexIterator on pg_statistic.
   ast::Identifier pg_statistic_index_pr_;
   StateDescriptor::Entry pg_statistic_updater_;  ///< Storage interface for updates.
   ast::Identifier pg_statistic_update_pr_;
+  // True if the scan only reads a sample of the table, and the statistics are scaled up to the whole table
+  bool sampled_ = false;
 
   void SetPgStatisticColOids(FunctionBuilder *function) const;
   void InitPgStatisticVariables(WorkContext *context, FunctionBuilder *function) const;
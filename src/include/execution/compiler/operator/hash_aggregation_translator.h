@@ -1,6 +1,7 @@
 #pragma once
 
 #include <unordered_map>
+#include <vector>
 
 #include "execution/compiler/operator/distinct_aggregation_util.h"
 #include "execution/compiler/operator/operator_translator.h"
@@ -112,6 +113,13 @@ class HashAggregationTranslator : public OperatorTranslator, public PipelineDriv
    */
   ast::Expr *GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const override;
 
+  /**
+   * Collect the grouping terms and the input values of all aggregate terms.
+   * @param[out] exprs The collected expressions.
+   */
+  void CollectChildPipelineExpressions(
+      std::vector<common::ManagedPointer<parser::AbstractExpression>> *exprs) const override;
+
   /**
    * Hash-based aggregations do not produce columns from base tables.
    */
@@ -127,6 +135,9 @@ class HashAggregationTranslator : public OperatorTranslator, public PipelineDriv
   // Access the plan.
   const planner::AggregatePlanNode &GetAggPlan() const { return GetPlanAs<planner::AggregatePlanNode>(); }
 
+  // Are groups indexed by their key, in addition to the hash table?
+  bool IsDense() const { return num_dense_keys_ > 0; }
+
   // Check if the input pipeline is either the build-side or producer-side.
   bool IsBuildPipeline(const Pipeline &pipeline) const { return &build_pipeline_ == &pipeline; }
   bool IsProducePipeline(const Pipeline &pipeline) const { return GetPipeline() == &pipeline; }
@@ -148,6 +159,7 @@ class HashAggregationTranslator : public OperatorTranslator, public PipelineDriv
 
   // Access an attribute at the given index in the provided aggregate row.
   ast::Expr *GetGroupByTerm(ast::Identifier agg_row, uint32_t attr_idx) const;
+  ast::Expr *GetGroupByTermPtr(ast::Identifier agg_row, uint32_t attr_idx) const;
   ast::Expr *GetAggregateTerm(ast::Identifier agg_row, uint32_t attr_idx) const;
   ast::Expr *GetAggregateTermPtr(ast::Identifier agg_row, uint32_t attr_idx) const;
 
@@ -162,6 +174,9 @@ class HashAggregationTranslator : public OperatorTranslator, public PipelineDriv
   ast::Identifier HashInputKeys(FunctionBuilder *function, ast::Identifier agg_values) const;
   ast::Identifier PerformLookup(FunctionBuilder *function, ast::Expr *agg_ht, ast::Identifier hash_val,
                                 ast::Identifier agg_values) const;
+  // 2-3 for a dense aggregation. Look the group up by its key, and only go
+  // through the hash table if it's not found.
+  ast::Identifier PerformDenseLookup(FunctionBuilder *function, ast::Expr *agg_ht, ast::Identifier agg_values) const;
   void ConstructNewAggregate(FunctionBuilder *function, ast::Expr *agg_ht, ast::Identifier agg_payload,
                              ast::Identifier agg_values, ast::Identifier hash_val) const;
   void AdvanceAggregate(WorkContext *ctx, FunctionBuilder *function, ast::Identifier agg_payload,
@@ -204,6 +219,11 @@ class HashAggregationTranslator : public OperatorTranslator, public PipelineDriv
   StateDescriptor::Entry global_agg_ht_;
   StateDescriptor::Entry local_agg_ht_;
 
+  // The domain of the grouping key in which groups are indexed by their key,
+  // if the aggregation is dense.
+  int64_t dense_min_key_{0};
+  uint32_t num_dense_keys_{0};
+
   std::unordered_map<size_t, DistinctAggregationFilter> distinct_filters_;
 
   // For minirunners
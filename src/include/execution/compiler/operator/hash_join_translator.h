@@ -23,6 +23,12 @@ class FunctionBuilder;
 
 /**
  * A translator for hash joins.
+ *
+ * Right semi, anti and mark joins emit every probe tuple at most once, so their probe stops at the first join partner.
+ * A mark join emits every probe tuple along with its mark, a SQL boolean that is the probe-side attribute following
+ * the probe child's output columns. The mark has the semantics of IN: it's true if the tuple found a join partner and
+ * false if it didn't, unless the build side has a NULL key, or the probe key is NULL and the build side isn't empty,
+ * in which case it's NULL. A filter on NOT of the mark is thus a NOT IN.
  */
 class HashJoinTranslator : public OperatorTranslator {
  public:
@@ -38,7 +44,7 @@ class HashJoinTranslator : public OperatorTranslator {
 
   /**
    * Declare the build-row struct used to materialize tuples from the build side of the join. In the
-   * case of left outer joins additionally declare a probe-row struct which lets us
+   * case of left outer and inner joins additionally declare a probe-row struct which lets us
    * materialize tuples from the probe side of the join.
    * @param decls The top-level declarations for the query. The declared structs will be registered
    *              here after they've been constructed.
@@ -47,7 +53,8 @@ class HashJoinTranslator : public OperatorTranslator {
 
   /**
    * Only for left outer joins - declare a function joinConsumer which encapsulates the parent translator's
-   * functionality
+   * functionality. Only for inner joins - declare a function spilledProbe which probes the join hash table
+   * with a spilled probe row.
    * @param decls
    */
   void DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) override;
@@ -129,6 +136,15 @@ class HashJoinTranslator : public OperatorTranslator {
   // Is the given pipeline this join's right pipeline?
   bool IsRightPipeline(const Pipeline &pipeline) const { return GetPipeline() == &pipeline; }
 
+  // Can the join hash table spill? Only inner joins can be joined one
+  // partition at a time, since no other join needs to see all build or all
+  // matching rows of a probe tuple at once.
+  bool CanSpill() const;
+
+  // Can probe tuples be discarded by a runtime filter before the probe? Only
+  // if tuples without a build partner contribute nothing to the join.
+  bool CanUseRuntimeFilter() const;
+
   // Initialize the given join hash table instance, provided as a *JHT.
   void InitializeJoinHashTable(FunctionBuilder *function, ast::Expr *jht_ptr) const;
 
@@ -143,6 +159,10 @@ class HashJoinTranslator : public OperatorTranslator {
   ast::Expr *HashKeys(WorkContext *ctx, FunctionBuilder *function,
                       const std::vector<common::ManagedPointer<parser::AbstractExpression>> &hash_keys) const;
 
+  // Return a boolean that is true if any of the provided hash keys is NULL.
+  ast::Expr *AnyKeyIsNull(WorkContext *ctx,
+                          const std::vector<common::ManagedPointer<parser::AbstractExpression>> &hash_keys) const;
+
   // Fill the build row with the columns from the given context.
   void FillBuildRow(WorkContext *ctx, FunctionBuilder *function, ast::Expr *build_row) const;
 
@@ -158,12 +178,19 @@ class HashJoinTranslator : public OperatorTranslator {
   // Check the right mark.
   void CheckRightMark(WorkContext *ctx, FunctionBuilder *function, ast::Identifier right_mark) const;
 
+  // Only for mark joins - compute the mark of the probe tuple from the right mark.
+  void ComputeMark(WorkContext *ctx, FunctionBuilder *function, ast::Identifier right_mark) const;
+
   // Check the join predicate.
   void CheckJoinPredicate(WorkContext *ctx, FunctionBuilder *function) const;
 
   // Only for left outer joins - iterate the hash table and output unmatched left rows
   void CollectUnmatchedLeftRows(FunctionBuilder *function) const;
 
+  // Only for inner joins - set aside the probe row if it falls into a spilled
+  // partition of the build side
+  void SpillProbeRow(WorkContext *ctx, FunctionBuilder *function, ast::Expr *hash_val) const;
+
   /** @return The struct that was declared, used for the minirunner. */
   ast::StructDecl *GetStructDecl() const { return struct_decl_; }
 
@@ -176,12 +203,18 @@ class HashJoinTranslator : public OperatorTranslator {
  private:
   // Flag to indicate whether or not we are in the joinConsumer function
   bool join_consumer_flag_;
+  // Flag to indicate whether or not we are in the spilledProbe function
+  bool spilled_probe_flag_;
+  // Does the probe-side scan filter its tuples with the join hash table's bloom filter?
+  bool use_runtime_filter_;
 
   // The name of the materialized row when inserting into join hash table.
   ast::Identifier build_row_var_;
   ast::Identifier build_row_type_;
   // For mark-based joins.
   ast::Identifier build_mark_;
+  // For mark joins, the mark of the probe tuple.
+  ast::Identifier probe_mark_;
 
   // The name of the materialized probe row
   ast::Identifier probe_row_var_;
@@ -190,6 +223,9 @@ class HashJoinTranslator : public OperatorTranslator {
   // The name of the function which encapuslates the join conumser
   ast::Identifier join_consumer_;
 
+  // The name of the function which probes with a spilled probe row
+  ast::Identifier spilled_probe_;
+
   // The left build-side pipeline.
   Pipeline left_pipeline_;
 
@@ -197,6 +233,8 @@ class HashJoinTranslator : public OperatorTranslator {
   // table is stored.
   StateDescriptor::Entry global_join_ht_;
   StateDescriptor::Entry local_join_ht_;
+  // For mark joins, whether a build tuple has a NULL key.
+  StateDescriptor::Entry build_has_null_key_;
 
   // The number of rows that are inserted into the hash table.
   StateDescriptor::Entry num_build_rows_;
@@ -82,8 +82,12 @@ class IndexCreateTranslator : public OperatorTranslator, public PipelineDriver {
     UNREACHABLE("index create doesn't have child");
   };
 
-  /** @return Not implemented */
-  ast::Expr *GetTableColumn(catalog::col_oid_t col_oid) const override { UNREACHABLE("Not implemented"); };
+  /**
+   * Used by the predicate of a partial index to read the columns of the scanned tuple.
+   * @param col_oid The column to read.
+   * @return The value of the column in the current tuple.
+   */
+  ast::Expr *GetTableColumn(catalog::col_oid_t col_oid) const override;
 
   /** @return a collection of parameters for the scan function */
   util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override;
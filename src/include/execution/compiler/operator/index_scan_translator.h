@@ -52,13 +52,17 @@ class IndexScanTranslator : public OperatorTranslator, public PipelineDriver {
 
   ast::Expr *GetSlotAddress() const override;
 
-  /** @return Throw an error, this is serial for now. */
-  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override { UNREACHABLE("Index scan is serial."); };
+  /**
+   * @return The pipeline work function parameters. Just the *IndexIterator over a partition of the range.
+   */
+  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override;
 
-  /** @return Throw an error, this is serial for now. */
-  void LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const override {
-    UNREACHABLE("Index scan is serial.");
-  };
+  /**
+   * Launch a parallel scan of the index range.
+   * @param function The pipeline generating function.
+   * @param work_func_name The worker function that'll be called on every partition of the range.
+   */
+  void LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const override;
 
  private:
   void DeclareIterator(FunctionBuilder *builder) const;
@@ -69,6 +73,10 @@ class IndexScanTranslator : public OperatorTranslator, public PipelineDriver {
   void DeclareIndexPR(FunctionBuilder *builder) const;
   void DeclareTablePR(FunctionBuilder *builder) const;
   void DeclareSlot(FunctionBuilder *builder) const;
+  // Whether this scan drives a parallel pipeline, so that its range is split between the workers
+  bool IsPartitioned() const;
+  // The iterator that the scan loop advances, which is the worker's own one in parallel scans
+  ast::Expr *GetIterator() const;
 
  private:
   std::vector<catalog::col_oid_t> input_oids_;
@@ -76,9 +84,12 @@ class IndexScanTranslator : public OperatorTranslator, public PipelineDriver {
   storage::ProjectionMap table_pm_;
   const catalog::IndexSchema &index_schema_;
   const std::unordered_map<catalog::indexkeycol_oid_t, uint16_t> &index_pm_;
+  // Key column of every table column, only for index-only scans
+  std::unordered_map<catalog::col_oid_t, catalog::indexkeycol_oid_t> key_cols_;
 
   // Structs and local variables
   StateDescriptor::Entry index_iter_;
+  ast::Identifier index_iter_var_;
   ast::Identifier col_oids_;
   ast::Identifier index_pr_;
   ast::Identifier lo_index_pr_;
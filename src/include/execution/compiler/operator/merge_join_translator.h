@@ -0,0 +1,155 @@
+#pragma once
+
+#include <vector>
+
+#include "execution/compiler/operator/operator_translator.h"
+#include "execution/compiler/pipeline.h"
+
+namespace noisepage::planner {
+class MergeJoinPlanNode;
+}  // namespace noisepage::planner
+
+namespace noisepage::execution::compiler {
+
+class FunctionBuilder;
+
+/**
+ * A translator for inner sort-merge joins. The left child's rows are materialized into a sorter in
+ * the order of the left join keys; when the left child already produces them in that order, the
+ * sort is a single pass checking the order. The right child streams its rows in the order of the
+ * right join keys. A cursor over the sorted left rows only ever moves forward: each right row
+ * advances it past the smaller left rows and then joins with the run of equal left rows.
+ */
+class MergeJoinTranslator : public OperatorTranslator {
+ public:
+  /**
+   * Create a new translator for the given merge join plan. The compilation occurs within the
+   * provided compilation context and the operator is participating in the provided pipeline.
+   * @param plan The plan.
+   * @param compilation_context The context of compilation this translation is occurring in.
+   * @param pipeline The pipeline this operator is participating in.
+   */
+  MergeJoinTranslator(const planner::MergeJoinPlanNode &plan, CompilationContext *compilation_context,
+                      Pipeline *pipeline);
+
+  /**
+   * Declare the row struct materializing the left child's tuples, and the struct holding the join
+   * keys of the current right tuple.
+   * @param decls The top-level declarations for the query.
+   */
+  void DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) override;
+
+  /**
+   * Declare the functions comparing two left rows, and a left row with the keys of a right row.
+   * @param decls The top-level declarations for the query.
+   */
+  void DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) override;
+
+  /**
+   * Initialize the sorter instance.
+   */
+  void InitializeQueryState(FunctionBuilder *function) const override;
+
+  /**
+   * Tear-down the sorter instance.
+   */
+  void TearDownQueryState(FunctionBuilder *function) const override;
+
+  /**
+   * If the pipeline is the right pipeline, position the cursor on the first sorted left row.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  /**
+   * If the pipeline is the right pipeline, close the cursor over the sorted left rows.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  /**
+   * Implement main join logic. If the context is coming from the left pipeline, the input tuples
+   * are materialized into the sorter. If the context is coming from the right pipeline, the input
+   * tuples are merged with the sorted left rows.
+   * @param ctx The context of the work.
+   * @param function The pipeline generating function.
+   */
+  void PerformPipelineWork(WorkContext *ctx, FunctionBuilder *function) const override;
+
+  /**
+   * If the pipeline is the left pipeline, sort the materialized rows.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  /**
+   * @return The value of the attribute at the given index (@em attr_idx) produced by the child at
+   *         the given index (@em child_idx).
+   */
+  ast::Expr *GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const override;
+
+  /**
+   * Merge-joins do not produce columns from base tables.
+   */
+  ast::Expr *GetTableColumn(catalog::col_oid_t col_oid) const override {
+    UNREACHABLE("Merge-joins do not produce columns from base tables.");
+  }
+
+ private:
+  // Is the given pipeline this join's left pipeline?
+  bool IsLeftPipeline(const Pipeline &pipeline) const { return &left_pipeline_ == &pipeline; }
+
+  // Is the given pipeline this join's right pipeline?
+  bool IsRightPipeline(const Pipeline &pipeline) const { return GetPipeline() == &pipeline; }
+
+  // Access the attribute at the given index within the provided left row.
+  ast::Expr *GetLeftRowAttribute(ast::Identifier left_row, uint32_t attr_idx) const;
+
+  // Access the join key at the given index within the probe keys.
+  ast::Expr *GetProbeKey(uint32_t key_idx) const;
+
+  // Generate a function comparing a left row with another left row or with the probe keys. Left
+  // keys that are NULL are larger than any value.
+  void GenerateComparisonFunction(FunctionBuilder *function, bool with_probe_keys);
+
+  // Insert tuple data into the sorter instance.
+  void InsertIntoSorter(WorkContext *ctx, FunctionBuilder *function) const;
+
+  // Merge the input tuple with the sorted left rows.
+  void MergeWithLeftRows(WorkContext *ctx, FunctionBuilder *function) const;
+
+  // Check the join predicate.
+  void CheckJoinPredicate(WorkContext *ctx, FunctionBuilder *function) const;
+
+ private:
+  // The materialized left row, and the names of the rows in the comparison
+  // functions.
+  ast::Identifier left_row_var_;
+  ast::Identifier left_row_type_;
+  ast::Identifier lhs_row_, rhs_row_;
+  // The join keys of the right row the cursor is merged with.
+  ast::Identifier probe_keys_var_;
+  ast::Identifier probe_keys_type_;
+  // The functions comparing two left rows, which is what the sorter orders
+  // on, and a left row with the probe keys.
+  ast::Identifier compare_left_rows_func_;
+  ast::Identifier compare_probe_keys_func_;
+
+  // The left build-side pipeline.
+  Pipeline left_pipeline_;
+
+  // Where the sorter instance is.
+  StateDescriptor::Entry global_sorter_;
+
+  // The cursor over the sorted left rows, and the number of rows it has passed.
+  StateDescriptor::Entry left_iter_;
+  StateDescriptor::Entry left_pos_;
+
+  enum class CurrentRow { Child, Lhs, Rhs };
+  CurrentRow current_row_;
+};
+
+}  // namespace noisepage::execution::compiler
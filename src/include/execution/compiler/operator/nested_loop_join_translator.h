@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "execution/compiler/operator/operator_translator.h"
 
 namespace noisepage::planner {
@@ -8,8 +10,12 @@ class NestedLoopJoinPlanNode;
 
 namespace noisepage::execution::compiler {
 
+class SeqScanTranslator;
+
 /**
- * A translator for nested-loop joins.
+ * A translator for nested-loop joins. When the inner side is a sequential scan, the conjuncts of the join predicate
+ * that compare an inner column with a value of the outer tuple are evaluated by the scan's vector filters, one vector
+ * of inner tuples at a time. Only the rest of the predicate is evaluated for every pair of tuples.
  */
 class NestedLoopJoinTranslator : public OperatorTranslator {
  public:
@@ -39,6 +45,12 @@ class NestedLoopJoinTranslator : public OperatorTranslator {
  private:
   // Get the NLJ plan node.
   const planner::NestedLoopJoinPlanNode &GetNLJPlan() const { return GetPlanAs<planner::NestedLoopJoinPlanNode>(); }
+
+  // Hand the conjunct to the inner scan if it is a comparison of an inner column with an outer value.
+  bool PushDownConjunct(SeqScanTranslator *inner_scan, common::ManagedPointer<parser::AbstractExpression> conjunct);
+
+  // The conjuncts of the join predicate that are evaluated for every pair of tuples.
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> residual_predicate_;
 };
 
 }  // namespace noisepage::execution::compiler
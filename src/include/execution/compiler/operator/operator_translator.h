@@ -2,8 +2,10 @@
 
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "common/macros.h"
+#include "common/managed_pointer.h"
 #include "execution/ast/ast_fwd.h"
 #include "execution/compiler/expression/column_value_provider.h"
 #include "execution/compiler/state_descriptor.h"
@@ -224,6 +226,15 @@ class OperatorTranslator : public ColumnValueProvider {
    */
   virtual void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const {}
 
+  /**
+   * Collect the expressions this operator derives on every tuple its child pushes to it in the
+   * pipeline they share. The child may evaluate them ahead of this operator, a batch at a time,
+   * and hand the values over through the work context. By default, no expressions are collected.
+   * @param[out] exprs The collected expressions.
+   */
+  virtual void CollectChildPipelineExpressions(
+      std::vector<common::ManagedPointer<parser::AbstractExpression>> *exprs) const {}
+
   /**
    * @return The value (vector) of the attribute at the given index in this operator's output.
    */
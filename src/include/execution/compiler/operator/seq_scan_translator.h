@@ -1,11 +1,16 @@
 #pragma once
 
+#include <functional>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "execution/compiler/operator/operator_translator.h"
 #include "execution/compiler/pipeline.h"
 #include "execution/compiler/pipeline_driver.h"
+#include "execution/sql/sql.h"
+#include "execution/sql/sql_def.h"
+#include "parser/expression_defs.h"
 
 namespace noisepage::catalog {
 class Schema;
@@ -22,12 +27,43 @@ class SeqScanPlanNode;
 namespace noisepage::execution::compiler {
 
 class FunctionBuilder;
+class WorkContext;
 
 /**
  * A translator for sequential table scans.
  */
 class SeqScanTranslator : public OperatorTranslator, public PipelineDriver {
  public:
+  /**
+   * A generator of a boolean expression that a tuple must pass. It is called with a context over
+   * the scan's pipeline and the function the expression is generated into.
+   */
+  using RuntimeFilter = std::function<ast::Expr *(WorkContext *, FunctionBuilder *)>;
+
+  /**
+   * A generator of a call restricting the blocks a table vector iterator reads, given the iterator.
+   */
+  using RuntimeBlockFilter = std::function<ast::Expr *(ast::Expr *)>;
+
+  /**
+   * A generator of a boolean expression that is true once the scan may stop reading the table.
+   */
+  using StopCondition = std::function<ast::Expr *()>;
+
+  /**
+   * A generator of a value that is the same for a whole scan of the table, but may change from one
+   * scan to the next, such as a column of the outer side of a nested-loop join the scan is the inner
+   * side of. It is called with a context over the scan's pipeline, in the function the scan is
+   * generated into, right before the table is read.
+   */
+  using OuterValue = std::function<ast::Expr *(WorkContext *)>;
+
+  /**
+   * A generator of work over a whole vector projection at once, given the function the scan is
+   * generated into and the vector projection iterator over the tuples passing the scan's filters.
+   */
+  using VectorConsumer = std::function<void(FunctionBuilder *, ast::Expr *)>;
+
   /**
    * Create a translator for the given plan.
    * @param plan The plan.
@@ -41,6 +77,79 @@ class SeqScanTranslator : public OperatorTranslator, public PipelineDriver {
    */
   DISALLOW_COPY_AND_MOVE(SeqScanTranslator);
 
+  /**
+   * Register a filter that is only known when the query runs, such as one derived from the build
+   * side of a join, as an extra term of every filter clause of the scan. Tuples failing it are
+   * discarded before any downstream operator sees them. The query state is in scope in the function
+   * the filter is generated into. Must be called before helper functions are defined.
+   * @param filter The generator of the filter.
+   */
+  void RegisterRuntimeFilter(RuntimeFilter filter);
+
+  /**
+   * Register a restriction of the blocks the scan reads that is only known when the query runs,
+   * such as the top-K bound of a sorter the scan feeds. It is applied to every table vector
+   * iterator the scan uses, before any block is read.
+   * @param filter The generator of the call applying the restriction.
+   */
+  void RegisterRuntimeBlockFilter(RuntimeBlockFilter filter) { runtime_block_filters_.emplace_back(std::move(filter)); }
+
+  /**
+   * Register a condition under which the rest of the table need not be read, such as a limit
+   * having seen all the tuples it produces. It is checked before every vector projection, in the
+   * function the scan is generated into.
+   * @param condition The generator of the condition.
+   */
+  void RegisterStopCondition(StopCondition condition) { stop_conditions_.emplace_back(std::move(condition)); }
+
+  /**
+   * Register a comparison of a scanned column with an outer value as a filter of the scan. The value
+   * is evaluated once before every scan of the table, and is then compared with whole vectors of the
+   * column by the vector filters, rather than with one tuple at a time. Tuples failing it are
+   * discarded before any downstream operator sees them. Must be called before helper functions are
+   * defined.
+   * @param cmp_type The comparison, with the column on its left.
+   * @param col_idx The index of the column amongst the columns the scan reads.
+   * @param value_type The type of the value, which is the one of the column.
+   * @param value The generator of the value.
+   */
+  void RegisterOuterFilter(parser::ExpressionType cmp_type, uint32_t col_idx, sql::TypeId value_type,
+                           OuterValue value);
+
+  /**
+   * Hand every vector projection of the scan to its parent as a whole, such as an aggregation
+   * advancing its aggregates a column at a time, rather than pushing one tuple at a time. The
+   * consumer is called once the filters of the scan ran; the work of the parent is then never
+   * generated for single tuples. At most one consumer may be registered.
+   * @param consumer The generator of the work over a vector projection.
+   */
+  void RegisterVectorConsumer(VectorConsumer consumer);
+
+  /**
+   * Only read a random sample of the blocks of the table, such as for ANALYZE. The sample is
+   * picked over the whole table, so the pipeline of the scan is made serial. Operators that
+   * already checked the parallelism of the pipeline are not revisited.
+   * @param num_blocks The number of blocks to read.
+   */
+  void SampleBlocks(uint32_t num_blocks);
+
+  /**
+   * Find the scanned column an expression over the scan's output reads as is.
+   * @param expr An expression over the output of the scan.
+   * @param[out] col_idx The index of the column amongst the columns the scan reads.
+   * @return True if the expression reads such a column.
+   */
+  bool IsScannedColumn(common::ManagedPointer<parser::AbstractExpression> expr, uint32_t *col_idx) const;
+
+  /**
+   * Find the scanned column an expression over the scan's output reads as is, if it holds no
+   * NULLs. The zone maps of the column then bound the values of the expression in every block.
+   * @param expr An expression over the output of the scan.
+   * @param[out] col_idx The index of the column amongst the columns the scan reads.
+   * @return True if the expression reads such a column.
+   */
+  bool IsNotNullColumn(common::ManagedPointer<parser::AbstractExpression> expr, uint32_t *col_idx) const;
+
   /**
    * If the scan has a predicate, this function will define all clause functions.
    * @param decls The top-level declarations.
@@ -96,27 +205,76 @@ class SeqScanTranslator : public OperatorTranslator, public PipelineDriver {
   // Does the scan have a predicate?
   bool HasPredicate() const;
 
+  // Does the scan run a filter manager, for its predicate or its runtime filters?
+  bool HasFilters() const { return HasPredicate() || !runtime_filters_.empty(); }
+
   // Get the OID of the table being scanned.
   catalog::table_oid_t GetTableOid() const;
 
   // Set col_oids_var_ to contain the column OIDs that are being scanned over.
   void DeclareColOids(FunctionBuilder *function) const;
 
+  // Generate a term matching the tuples of the vector projection that pass the given filter, one at a time.
+  void GenerateMatchTerm(FunctionBuilder *function, const RuntimeFilter &filter, ast::Expr *vector_proj,
+                         ast::Expr *tid_list);
+
   // Generate a generic filter term.
   void GenerateGenericTerm(FunctionBuilder *function, common::ManagedPointer<parser::AbstractExpression> term,
                            ast::Expr *vector_proj, ast::Expr *tid_list);
 
+  // Generate the term function of a runtime filter, returning its name.
+  ast::Identifier GenerateRuntimeFilterTerm(util::RegionVector<ast::FunctionDecl *> *decls,
+                                            const RuntimeFilter &filter);
+
+  // Generate the term function of a filter comparing with an outer value, returning its name.
+  ast::Identifier GenerateOuterFilterTerm(util::RegionVector<ast::FunctionDecl *> *decls,
+                                          parser::ExpressionType cmp_type, uint32_t col_idx,
+                                          const StateDescriptor::Entry &value);
+
   // Generate all filter clauses.
   void GenerateFilterClauseFunctions(util::RegionVector<ast::FunctionDecl *> *decls,
                                      common::ManagedPointer<parser::AbstractExpression> predicate,
                                      std::vector<ast::Identifier> *curr_clause, bool seen_conjunction);
 
+  // Collect the ranges of column values that every tuple passing the predicate lies in, for the TVI to skip blocks.
+  void CollectBlockFilters(common::ManagedPointer<parser::AbstractExpression> predicate);
+
+  // Collect the scanned columns that no filter reads, for the TVI to read them only for the tuples passing the filters.
+  void CollectLateColumns(common::ManagedPointer<parser::AbstractExpression> predicate);
+
+  // Plan the evaluation of the arithmetic in the scan's output, and in the expressions of the
+  // operator consuming the scan, over whole vector projections.
+  void PlanVectorExpressions();
+
+  // Resolve a value derived from the scan's output into the expression the scan computes it with.
+  common::ManagedPointer<parser::AbstractExpression> ResolveScanOutput(
+      common::ManagedPointer<parser::AbstractExpression> expr) const;
+
+  // Can the expression be evaluated over whole vector projections? If so, write the type it is evaluated in.
+  bool IsVectorizable(common::ManagedPointer<parser::AbstractExpression> expr, sql::TypeId *type_id) const;
+
+  // Is the function expression a date part with a vector kernel of a scanned date column? If so, write the part.
+  bool IsDatePartOfColumn(common::ManagedPointer<parser::AbstractExpression> expr, sql::DatePartType *part) const;
+
+  // Collect the largest vectorizable arithmetic expressions within the given expression.
+  void CollectVectorExpressions(common::ManagedPointer<parser::AbstractExpression> expr,
+                                std::vector<common::ManagedPointer<parser::AbstractExpression>> *roots) const;
+
+  // Plan the steps computing a vectorizable expression, returning the index of the column holding its values.
+  uint32_t PlanVectorExpression(common::ManagedPointer<parser::AbstractExpression> expr);
+
+  // Evaluate the planned vector expressions over the vector projection the scan's VPI iterates.
+  void GenerateVectorExpressions(WorkContext *ctx, FunctionBuilder *function) const;
+
   // Perform a table scan using the provided table vector iterator pointer.
   void ScanTable(WorkContext *ctx, FunctionBuilder *function) const;
 
   // Generate a scan over the VPI.
   void ScanVPI(WorkContext *ctx, FunctionBuilder *function, ast::Expr *vpi) const;
 
+  // Add the tuples of the current VPI to the number of rows that are scanned.
+  void CountVPITuples(FunctionBuilder *function) const;
+
  private:
   // When the plan's oid list is empty (like in "SELECT COUNT(*)"), then we just read the first column of the table.
   // Otherwise we just read the plan's oid list.
@@ -141,12 +299,78 @@ class SeqScanTranslator : public OperatorTranslator, public PipelineDriver {
   StateDescriptor::Entry local_filter_manager_;
 
   // The list of filter manager clauses. Populated during helper function
-  // definition, but only if there's a predicate.
+  // definition, but only if there's a predicate or a runtime filter.
   std::vector<std::vector<ast::Identifier>> filters_;
 
+  // The runtime filters registered by other operators.
+  std::vector<RuntimeFilter> runtime_filters_;
+
+  // The runtime block filters and stop conditions registered by other operators.
+  std::vector<RuntimeBlockFilter> runtime_block_filters_;
+  std::vector<StopCondition> stop_conditions_;
+
+  // The consumer of whole vector projections registered by the parent, if any.
+  VectorConsumer vector_consumer_;
+
+  // A comparison of a column with an outer value, which is kept in the pipeline state.
+  struct OuterFilter {
+    parser::ExpressionType cmp_type_;
+    uint32_t col_idx_;
+    StateDescriptor::Entry value_;
+    OuterValue gen_value_;
+  };
+  // The filters comparing with outer values run in a filter manager of their own, which hands the
+  // pipeline state to their terms as the context. Its only clause is populated during helper
+  // function definition.
+  std::vector<OuterFilter> outer_filters_;
+  StateDescriptor::Entry outer_filter_manager_;
+  std::vector<ast::Identifier> outer_filter_clause_;
+
+  // The number of blocks passed to \@tableIterSampleBlocks(), 0 to read every block.
+  uint32_t sample_blocks_ = 0;
+
+  // A range of values of a column that every tuple passing the predicate lies in
+  struct BlockFilter {
+    uint32_t col_idx_;
+    int64_t min_;
+    int64_t max_;
+  };
+  // The ranges passed to \@tableIterFilterBlocks(). Populated during helper function definition.
+  std::vector<BlockFilter> block_filters_;
+
+  // The columns passed to \@tableIterLateMaterialize(). Populated during helper function definition.
+  std::vector<uint32_t> late_col_idxs_;
+
   // The version of col_oids that we use for translation. See MakeInputOids for justification.
   std::vector<catalog::col_oid_t> col_oids_;
 
+  // An operation over whole columns of the expression projection. Operands are either columns or,
+  // when set, constants. Casts have the type OPERATOR_CAST and a left operand only, and so do date
+  // parts, which have the type FUNCTION.
+  struct VectorStep {
+    parser::ExpressionType op_type_;
+    uint32_t result_idx_;
+    uint32_t left_idx_;
+    uint32_t right_idx_;
+    common::ManagedPointer<parser::AbstractExpression> left_const_;
+    common::ManagedPointer<parser::AbstractExpression> right_const_;
+    sql::DatePartType date_part_ = sql::DatePartType::INVALID;
+  };
+  // The fewest arithmetic operations worth evaluating a batch at a time. Below it, extending the
+  // projection costs more than the vector kernels save over the tuple-at-a-time code.
+  static constexpr uint32_t MIN_VECTOR_OPERATIONS = 2;
+  // The projection the vector expressions are evaluated into. Its leading columns reference the
+  // scanned columns, the remaining ones hold results.
+  StateDescriptor::Entry expr_vp_;
+  // The types of all columns of the expression projection.
+  std::vector<sql::TypeId> expr_vp_types_;
+  // The steps in the order they are evaluated in. Populated during helper function definition.
+  std::vector<VectorStep> vector_steps_;
+  // The planned expressions and the columns holding their values.
+  std::vector<std::pair<common::ManagedPointer<parser::AbstractExpression>, uint32_t>> vector_exprs_;
+  // The expressions derived from the projection instead of tuple-at-a-time, and their columns.
+  std::vector<std::pair<common::ManagedPointer<parser::AbstractExpression>, uint32_t>> vector_roots_;
+
   // The number of rows that are scanned.
   StateDescriptor::Entry num_scans_;
 };
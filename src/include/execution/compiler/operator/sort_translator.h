@@ -161,6 +161,12 @@ class SortTranslator : public OperatorTranslator, public PipelineDriver {
   // Generate comparison function.
   void GenerateComparisonFunction(FunctionBuilder *function);
 
+  // Generate the function encoding the first sort key into a normalized key.
+  void GenerateNormalizedKeyFunction(FunctionBuilder *function);
+
+  // Make a scan feeding a top-K sorter discard the rows that can't make it into the top-K.
+  void PushTopKBoundIntoScan(CompilationContext *compilation_context);
+
   // For minirunners.
   ast::StructDecl *GetStructDecl() const { return struct_decl_; }
 
@@ -171,6 +177,9 @@ class SortTranslator : public OperatorTranslator, public PipelineDriver {
   ast::Identifier sort_row_type_;
   ast::Identifier lhs_row_, rhs_row_;
   ast::Identifier compare_func_;
+  // The function computing normalized keys, empty if the first sort key has
+  // no normalized encoding.
+  ast::Identifier normalized_key_func_;
 
   // Build-side pipeline.
   Pipeline build_pipeline_;
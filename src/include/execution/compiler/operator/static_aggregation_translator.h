@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <unordered_map>
 #include <vector>
 
@@ -15,6 +16,7 @@ class AggregatePlanNode;
 namespace noisepage::execution::compiler {
 
 class FunctionBuilder;
+class SeqScanTranslator;
 
 /**
  * A translator for static aggregations.
@@ -102,6 +104,13 @@ class StaticAggregationTranslator : public OperatorTranslator, public PipelineDr
    */
   ast::Expr *GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const override;
 
+  /**
+   * Collect the input values of all aggregate terms.
+   * @param[out] exprs The collected expressions.
+   */
+  void CollectChildPipelineExpressions(
+      std::vector<common::ManagedPointer<parser::AbstractExpression>> *exprs) const override;
+
   ast::Expr *GetTableColumn(catalog::col_oid_t col_oid) const override {
     UNREACHABLE("Static aggregations do not produce columns from base tables.");
   }
@@ -128,6 +137,13 @@ class StaticAggregationTranslator : public OperatorTranslator, public PipelineDr
 
   void UpdateGlobalAggregate(WorkContext *ctx, FunctionBuilder *function) const;
 
+  // Find the scanned columns the aggregates read, if all of them can advance by a whole vector
+  // projection of the scan at a time.
+  bool PlanVectorAggregates(const SeqScanTranslator &scan);
+
+  // Advance all aggregates by the tuples of a vector projection of the scan.
+  void AdvanceVectorAggregates(FunctionBuilder *function, ast::Expr *vpi) const;
+
   // For minirunners.
   ast::StructDecl *GetStructDecl() const { return struct_decl_; }
 
@@ -153,6 +169,10 @@ class StaticAggregationTranslator : public OperatorTranslator, public PipelineDr
 
   // For distinct aggregations
   std::unordered_map<size_t, DistinctAggregationFilter> distinct_filters_;
+
+  // The column of the scan every aggregate advances by a vector projection at a time, or nothing
+  // for COUNT(*). Empty when the aggregates advance a tuple at a time.
+  std::vector<std::optional<uint32_t>> vector_cols_;
   // The number of input rows to the aggregation.
   StateDescriptor::Entry num_agg_inputs_;
 
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <vector>
+
+#include "execution/compiler/operator/operator_translator.h"
+#include "execution/compiler/pipeline.h"
+#include "execution/compiler/pipeline_driver.h"
+#include "planner/plannodes/order_by_plan_node.h"
+
+namespace noisepage::planner {
+class WindowPlanNode;
+}  // namespace noisepage::planner
+
+namespace noisepage::execution::compiler {
+
+class FunctionBuilder;
+
+/**
+ * A translator for window plans. The build-side materializes the child's rows into a sorter that
+ * orders them on the partition-by terms and then on the sort keys. The scan-side walks the sorted
+ * rows one peer group at a time: a lead iterator advances the running aggregates over the group,
+ * then a trailing iterator emits the group's rows with their window function values.
+ */
+class WindowTranslator : public OperatorTranslator, public PipelineDriver {
+ public:
+  /**
+   * Create a translator for the given window plan node.
+   * @param plan The plan.
+   * @param compilation_context The context this translator belongs to.
+   * @param pipeline The pipeline this translator is participating in.
+   */
+  WindowTranslator(const planner::WindowPlanNode &plan, CompilationContext *compilation_context, Pipeline *pipeline);
+
+  /**
+   * Define the sort-row structure that's materialized in the sorter, and the structures holding
+   * the running aggregates and their inputs.
+   * @param decls The top-level declarations.
+   */
+  void DefineHelperStructs(util::RegionVector<ast::StructDecl *> *decls) override;
+
+  /**
+   * Define the functions comparing two sort rows.
+   * @param decls The top-level declarations.
+   */
+  void DefineHelperFunctions(util::RegionVector<ast::FunctionDecl *> *decls) override;
+
+  /**
+   * Initialize the sorter instance.
+   */
+  void InitializeQueryState(FunctionBuilder *function) const override;
+
+  /**
+   * Tear-down the sorter instance.
+   */
+  void TearDownQueryState(FunctionBuilder *function) const override;
+
+  /**
+   * If the given pipeline is for the build-size and is parallel, initialize the thread-local sorter
+   * instance we declared inside.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void InitializePipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  /**
+   * If the given pipeline is for the build-size and is parallel, destroy the thread-local sorter
+   * instance we declared inside.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void TearDownPipelineState(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  /**
+   * Implement either the build-side or scan-side of the window depending on the pipeline this
+   * context contains.
+   * @param ctx The context of the work.
+   * @param function The pipeline function generator.
+   */
+  void PerformPipelineWork(WorkContext *ctx, FunctionBuilder *function) const override;
+
+  /**
+   * If the given pipeline is for the build-side, sort the materialized rows.
+   * @param pipeline The current pipeline.
+   * @param function The pipeline generating function.
+   */
+  void FinishPipelineWork(const Pipeline &pipeline, FunctionBuilder *function) const override;
+
+  /**
+   * Windows are never launched in parallel, so this should never occur.
+   */
+  util::RegionVector<ast::FieldDecl *> GetWorkerParams() const override { UNREACHABLE("Impossible"); }
+
+  /**
+   * Windows are never launched in parallel, so this should never occur.
+   */
+  void LaunchWork(FunctionBuilder *function, ast::Identifier work_func_name) const override {
+    UNREACHABLE("Impossible");
+  }
+
+  /**
+   * @return The value of the attribute at the given index (@em attr_idx) of the child's row if
+   *         @em child_idx is 0, or the value of the window function at the given index if
+   *         @em child_idx is 1.
+   */
+  ast::Expr *GetChildOutput(WorkContext *context, uint32_t child_idx, uint32_t attr_idx) const override;
+
+  /**
+   * Window operators do not produce columns from base tables.
+   */
+  ast::Expr *GetTableColumn(catalog::col_oid_t col_oid) const override {
+    UNREACHABLE("Window operators do not produce columns from base tables");
+  }
+
+ private:
+  // Check if the given pipelines are build or scan
+  bool IsBuildPipeline(const Pipeline &pipeline) const { return &build_pipeline_ == &pipeline; }
+  bool IsScanPipeline(const Pipeline &pipeline) const { return GetPipeline() == &pipeline; }
+
+  // Access the attribute at the given index within the provided sort row.
+  ast::Expr *GetSortRowAttribute(ast::Identifier sort_row, uint32_t attr_idx) const;
+
+  // Access the running aggregate or the aggregate input of the window function at the given index.
+  ast::Expr *GetAggregateTerm(ast::Identifier agg_row, uint32_t func_idx) const;
+  ast::Expr *GetAggregateTermPtr(ast::Identifier agg_row, uint32_t func_idx) const;
+
+  // Generate a function comparing two sort rows on the given keys, ordering NULLs last in
+  // ascending and first in descending order.
+  void GenerateComparisonFunction(FunctionBuilder *function, const std::vector<planner::SortKey> &keys);
+
+  // Insert tuple data into the sorter instance.
+  void InsertIntoSorter(WorkContext *ctx, FunctionBuilder *function) const;
+
+  // Generate a function advancing the running aggregates by the lead row.
+  void GenerateAdvanceFunction(FunctionBuilder *function);
+
+  // Reset and free the running aggregates.
+  void InitializeAggregates(FunctionBuilder *function) const;
+  void FreeAggregates(FunctionBuilder *function) const;
+
+  // Called to scan the global sorter instance and compute the window functions.
+  void ScanSorter(WorkContext *ctx, FunctionBuilder *function) const;
+
+  // The window function value for the row the scan is currently emitting.
+  ast::Expr *GetWindowValue(uint32_t func_idx) const;
+
+ private:
+  // The sort row, and the names of the rows in the comparison functions and
+  // the row the lead iterator is on.
+  ast::Identifier sort_row_var_;
+  ast::Identifier sort_row_type_;
+  ast::Identifier lhs_row_, rhs_row_;
+  ast::Identifier lead_row_;
+  // The functions comparing sort rows on the partition-by terms, on the sort
+  // keys, and on both, which is what the sorter orders on.
+  ast::Identifier compare_partition_func_;
+  ast::Identifier compare_order_func_;
+  ast::Identifier compare_func_;
+  // The function advancing the running aggregates, empty if the plan has no
+  // aggregate window functions.
+  ast::Identifier advance_func_;
+  // The running aggregates and their inputs.
+  ast::Identifier aggs_var_, aggs_type_;
+  ast::Identifier agg_values_var_, agg_values_type_;
+  // Scan-side counters: the rows of the partition emitted before the current
+  // peer group, the peer groups of the partition, and the current row's index
+  // in its peer group.
+  ast::Identifier num_partition_rows_;
+  ast::Identifier num_peer_groups_;
+  ast::Identifier peer_idx_;
+
+  // Build-side pipeline.
+  Pipeline build_pipeline_;
+
+  // Where the global and thread-local sorter instances are.
+  StateDescriptor::Entry global_sorter_;
+  StateDescriptor::Entry local_sorter_;
+
+  enum class CurrentRow { Child, Lhs, Rhs, Lead };
+  CurrentRow current_row_;
+};
+
+}  // namespace noisepage::execution::compiler
@@ -178,7 +178,12 @@ class Pipeline {
   /**
    * @return Pipeline state variable
    */
-  ast::Identifier GetPipelineStateVar() { return state_var_; }
+  ast::Identifier GetPipelineStateVar() const { return state_var_; }
+
+  /**
+   * @return The name of the type of the pipeline state.
+   */
+  ast::Identifier GetPipelineStateTypeName() const { return state_.GetTypeName(); }
 
   /** @return The unique ID of this pipeline. */
   pipeline_id_t GetPipelineId() const { return pipeline_id_t{id_}; }
@@ -197,6 +202,13 @@ class Pipeline {
    */
   void InjectEndResourceTracker(FunctionBuilder *builder, bool is_hook) const;
 
+  /**
+   * Inject counting a row produced by the given operator into function, if profiling is enabled
+   * @param builder Function being built
+   * @param op The operator in this pipeline that produced the row
+   */
+  void InjectOperatorRowCounter(FunctionBuilder *builder, const OperatorTranslator *op) const;
+
   /**
    * @return query identifier of the query that we are codegen-ing
    */
@@ -266,6 +278,9 @@ class Pipeline {
   StateDescriptor state_;
   // The pipeline operating unit feature vector state.
   StateDescriptor::Entry oufeatures_;
+  // The number of rows every step produced, in the pipeline state, when profiling is enabled. The entry of the
+  // last step, which consumes rows without producing any, is left empty.
+  std::vector<StateDescriptor::Entry> operator_rows_;
 };
 
 }  // namespace noisepage::execution::compiler
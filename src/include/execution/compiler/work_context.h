@@ -3,6 +3,7 @@
 #include <functional>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "execution/compiler/ast_fwd.h"
 #include "execution/compiler/expression/expression_translator.h"
@@ -44,6 +45,38 @@ class WorkContext {
    */
   ast::Expr *DeriveValue(const parser::AbstractExpression &expr, const ColumnValueProvider *provider);
 
+  /**
+   * Use the given value for the given expression instead of deriving it, no matter which provider
+   * it is derived for. Operators evaluating expressions ahead of the operators consuming them, a
+   * batch at a time for example, hand their results to the consumers this way.
+   * @param expr The expression.
+   * @param value The TPL value of the expression.
+   */
+  void SetExpressionOverride(const parser::AbstractExpression &expr, ast::Expr *value) { overrides_[&expr] = value; }
+
+  /**
+   * Derive all expressions again, dropping the values set through SetExpressionOverride().
+   */
+  void ClearExpressionOverrides() { overrides_.clear(); }
+
+  /**
+   * Evaluate the subexpressions that occur more than once among the given expressions into variables, so that deriving
+   * the expressions afterwards computes each of them only once. Subexpressions are matched by their structure, like
+   * the price * (1 - disc) of both SUM(price * (1 - disc)) and AVG(price * (1 - disc)). Only the subexpressions that
+   * are always evaluated are hoisted, not the ones under a CASE, a conjunction or a function call.
+   * @param exprs The expressions to be derived.
+   * @param provider The provider from which column values can be obtained.
+   * @param function The function that's being built. The variables are declared in its current scope.
+   */
+  void DeriveCommonSubexpressions(const std::vector<const parser::AbstractExpression *> &exprs,
+                                  const ColumnValueProvider *provider, FunctionBuilder *function);
+
+  /**
+   * Derive the subexpressions hoisted by DeriveCommonSubexpressions() again, before leaving the scope of their
+   * variables.
+   */
+  void ClearCommonSubexpressions();
+
   /**
    * Push this context through to the next step in the pipeline.
    * @param function The function that's being built.
@@ -96,6 +129,10 @@ class WorkContext {
     }
   };
 
+  // Values of expressions evaluated ahead of their consumers.
+  std::unordered_map<const parser::AbstractExpression *, ast::Expr *> overrides_;
+  // Expressions whose values are the variables of common subexpressions.
+  std::vector<const parser::AbstractExpression *> common_subexprs_;
   // Cache of expression results.
   std::unordered_map<CacheKey_t, ast::Expr *, HashKey> cache_;
   // The current pipeline step and last pipeline step.
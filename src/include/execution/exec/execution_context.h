@@ -1,12 +1,20 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
 #include <memory>
+#include <optional>
 #include <utility>
 #include <vector>
 
+#include "common/error/error_code.h"
+#include "common/error/exception.h"
 #include "common/managed_pointer.h"
 #include "execution/exec/execution_settings.h"
 #include "execution/exec/output.h"
+#include "execution/exec/query_profile.h"
+#include "execution/exec/sampling_profiler.h"
 #include "execution/exec_defs.h"
 #include "execution/sql/memory_tracker.h"
 #include "execution/sql/runtime_types.h"
@@ -14,6 +22,7 @@
 #include "execution/util/region.h"
 #include "metrics/metrics_defs.h"
 #include "planner/plannodes/output_schema.h"
+#include "planner/plannodes/plan_meta_data.h"
 #include "self_driving/modeling/operating_unit.h"
 #include "self_driving/modeling/operating_unit_defs.h"
 
@@ -21,6 +30,10 @@ namespace noisepage::catalog {
 class CatalogAccessor;
 }  // namespace noisepage::catalog
 
+namespace noisepage::execution::sql {
+class FilterOrderCache;
+}  // namespace noisepage::execution::sql
+
 namespace noisepage::metrics {
 class MetricsManager;
 }  // namespace noisepage::metrics
@@ -105,7 +118,17 @@ class EXPORT ExecutionContext {
         accessor_(accessor),
         metrics_manager_(metrics_manager),
         replication_manager_(replication_manager),
-        recovery_manager_(recovery_manager) {}
+        recovery_manager_(recovery_manager) {
+    if (exec_settings_.GetIsProfilingEnabled()) query_profile_ = std::make_unique<QueryProfile>();
+    if (exec_settings_.GetStatementTimeout() > 0) {
+      deadline_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(exec_settings_.GetStatementTimeout());
+    }
+  }
+
+  /**
+   * Destructor. Gives up the query's slot among the queries running parallel steps, if it holds one.
+   */
+  ~ExecutionContext();
 
   /**
    * @return the transaction used by this query
@@ -128,6 +151,11 @@ class EXPORT ExecutionContext {
    */
   sql::MemoryPool *GetMemoryPool() { return mem_pool_.get(); }
 
+  /**
+   * @return the tracker of the memory the query allocates
+   */
+  const sql::MemoryTracker *GetMemoryTracker() const { return mem_tracker_.get(); }
+
   /**
    * @return the string allocator
    */
@@ -173,6 +201,31 @@ class EXPORT ExecutionContext {
    */
   void EndPipelineTracker(query_id_t query_id, pipeline_id_t pipeline_id, selfdriving::ExecOUFeatureVector *ouvec);
 
+  /**
+   * @return The measurements of the query for EXPLAIN ANALYZE, or nullptr if profiling isn't enabled.
+   */
+  QueryProfile *GetQueryProfile() { return query_profile_.get(); }
+
+  /**
+   * Start timing a pipeline for the query profile.
+   * @param pipeline_id id of the pipeline
+   */
+  void StartPipelineProfile(pipeline_id_t pipeline_id);
+
+  /**
+   * Stop timing a pipeline for the query profile.
+   * @param pipeline_id id of the pipeline
+   */
+  void EndPipelineProfile(pipeline_id_t pipeline_id);
+
+  /**
+   * Add to the rows an operator produced in the query profile.
+   * @param pipeline_id id of the pipeline the rows were produced in
+   * @param plan_node_id id of the plan node of the operator
+   * @param num_rows number of rows
+   */
+  void RecordOperatorRows(pipeline_id_t pipeline_id, planner::plan_node_id_t plan_node_id, uint64_t num_rows);
+
   /**
    * Initializes an OU feature vector for a given pipeline
    * @param ouvec OU Feature Vector to initialize
@@ -235,11 +288,48 @@ class EXPORT ExecutionContext {
     return pipeline_operating_units_;
   }
 
+  /**
+   * Set the cache of the filter orders learned by earlier executions of the query
+   * @param order_cache the cache kept by the executable query
+   */
+  void SetFilterOrderCache(common::ManagedPointer<sql::FilterOrderCache> order_cache) {
+    filter_order_cache_ = order_cache;
+  }
+
+  /** @return the cache of learned filter orders, nullptr if the query does not keep one */
+  common::ManagedPointer<sql::FilterOrderCache> GetFilterOrderCache() { return filter_order_cache_; }
+
   /** @return The number of rows affected by the current execution, e.g., INSERT/DELETE/UPDATE. */
-  uint32_t GetRowsAffected() const { return rows_affected_; }
+  uint32_t GetRowsAffected() const { return rows_affected_.load(std::memory_order_relaxed); }
+
+  /** Increment or decrement the number of rows affected. The workers of a parallel pipeline may do so at once. */
+  void AddRowsAffected(int64_t num_rows) {
+    rows_affected_.fetch_add(static_cast<uint32_t>(num_rows), std::memory_order_relaxed);
+  }
 
-  /** Increment or decrement the number of rows affected. */
-  void AddRowsAffected(int64_t num_rows) { rows_affected_ += num_rows; }
+  /**
+   * Record that the query only read a sample of a table, @see sql::TableVectorIterator::SampleBlocks().
+   * @param scale how many times more tuples the table holds than the sample
+   */
+  void SetSampleScale(double scale) { sample_scale_ = scale; }
+
+  /** @return how many times more tuples the sampled table holds than the sample, 1 if the query read all of it */
+  double GetSampleScale() const { return sample_scale_; }
+
+  /**
+   * @param count number of tuples counted in the sample of the table
+   * @return estimate of the number of such tuples in the whole table
+   */
+  int64_t ScaleSampledCount(int64_t count) const;
+
+  /**
+   * Estimate the number of distinct values of a column in the whole table. A column with few distinct values in the
+   * sample is assumed to have all of them in the sample, and one with many to have more of them the larger the table.
+   * @param num_distinct number of distinct values in the sample of the table
+   * @param count number of non-NULL values of the column in the sample
+   * @return estimate of the number of distinct values in the whole table
+   */
+  int64_t ScaleSampledDistinct(int64_t num_distinct, int64_t count) const;
 
   /**
    * @return    On the primary, returns the ID of the last txn sent.
@@ -277,13 +367,26 @@ class EXPORT ExecutionContext {
   /**
    * @return query identifier
    */
-  execution::query_id_t GetQueryId() { return query_id_; }
+  execution::query_id_t GetQueryId() const { return query_id_; }
 
   /**
    * Set the current executing query identifier
    */
   void SetQueryId(execution::query_id_t query_id) { query_id_ = query_id; }
 
+  /**
+   * Set the pipeline that the query runs, which the samples of the SamplingProfiler count toward
+   * @param pipeline_id pipeline being run, or INVALID_PIPELINE_ID for the steps of the query outside of its pipelines
+   */
+  void SetProfilePipeline(pipeline_id_t pipeline_id) { profile_pipeline_id_ = pipeline_id; }
+
+  /**
+   * @return what the samples of the SamplingProfiler that the threads running the query take count toward
+   */
+  SamplingProfiler::Tag GetProfileTag() const {
+    return {query_id_.UnderlyingValue(), profile_pipeline_id_.UnderlyingValue()};
+  }
+
   /**
    * Overrides recording from memory tracker
    * This should never be used by parallel threads directly
@@ -300,6 +403,9 @@ class EXPORT ExecutionContext {
    */
   void SetQueryState(void *query_state) { query_state_ = query_state; }
 
+  /** @return The opaque query state pointer for the current query invocation. */
+  void *GetQueryState() const { return query_state_; }
+
   /**
    * Sets the estimated concurrency of a parallel operation.
    * This value is used when initializing an ExecOUFeatureVector
@@ -309,6 +415,12 @@ class EXPORT ExecutionContext {
    */
   void SetNumConcurrentEstimate(uint32_t estimate) { num_concurrent_estimate_ = estimate; }
 
+  /** @return True if the query holds a slot among the queries that may run parallel steps. */
+  bool IsAdmittedForParallelExecution() const { return is_admitted_for_parallel_execution_; }
+
+  /** Record that the query took a slot among the queries that may run parallel steps. */
+  void SetAdmittedForParallelExecution() { is_admitted_for_parallel_execution_ = true; }
+
   /**
    * Invoke a hook function if a hook function is available
    * @param hook_index Index of hook function to invoke
@@ -335,8 +447,65 @@ class EXPORT ExecutionContext {
    */
   void ClearHooks() { hooks_.clear(); }
 
+  /**
+   * Ask the query to stop. It stops at its next interrupt check, see CheckInterrupt(). This may be called from any
+   * thread, e.g., by the connection that a client sent a CancelRequest for the query on.
+   */
+  void Cancel() { canceled_.store(true, std::memory_order_relaxed); }
+
+  /**
+   * Stop the query with an ExecutionException if it was canceled or ran out of time. Generated code checks for this
+   * at the start of every morsel a scan reads, so that a query stops soon without paying for a check per tuple.
+   */
+  void CheckInterrupt() const {
+    if (canceled_.load(std::memory_order_relaxed)) {
+      throw EXECUTION_EXCEPTION("canceling statement due to user request", common::ErrorCode::ERRCODE_QUERY_CANCELED);
+    }
+    if (deadline_.has_value() && std::chrono::steady_clock::now() >= *deadline_) {
+      throw EXECUTION_EXCEPTION("canceling statement due to statement timeout",
+                                common::ErrorCode::ERRCODE_QUERY_CANCELED);
+    }
+  }
+
+  /**
+   * Compare the rows that operators produce against the optimizer's estimates, see CheckCardinality().
+   * @param estimates The optimizer's estimates for the plan being run.
+   * @param max_error The factor by which the rows of an operator may be off its estimate, in either direction.
+   */
+  void SetCardinalityCheck(common::ManagedPointer<planner::PlanMetaData> estimates, int64_t max_error) {
+    cardinality_estimates_ = estimates;
+    max_cardinality_error_ = max_error;
+  }
+
+  /**
+   * Record the rows an operator produced. Once an operator is off its estimate by more than the allowed factor, the
+   * query asks to be re-optimized, and it stops after the step that is running, see NeedsReoptimization().
+   * @param plan_node_id The plan node of the operator.
+   * @param num_rows The number of rows the operator produced.
+   */
+  void CheckCardinality(planner::plan_node_id_t plan_node_id, uint64_t num_rows) {
+    if (cardinality_estimates_ == nullptr || !cardinality_estimates_->HasPlanNodeMetaData(plan_node_id)) return;
+    const int estimate = cardinality_estimates_->GetPlanNodeMetaData(plan_node_id).GetCardinality();
+    if (estimate < 0) return;
+    observed_cardinalities_.emplace_back(plan_node_id, num_rows);
+    const double actual = std::max(static_cast<double>(num_rows), 1.0);
+    const double expected = std::max(static_cast<double>(estimate), 1.0);
+    if (std::max(actual / expected, expected / actual) > static_cast<double>(max_cardinality_error_)) {
+      needs_reoptimization_ = true;
+    }
+  }
+
+  /** @return True if an operator was off its estimate by more than the allowed factor. */
+  bool NeedsReoptimization() const { return needs_reoptimization_; }
+
+  /** @return The plan nodes whose rows were checked, with the rows they produced. */
+  const std::vector<std::pair<planner::plan_node_id_t, uint64_t>> &GetObservedCardinalities() const {
+    return observed_cardinalities_;
+  }
+
  private:
   query_id_t query_id_{execution::query_id_t(0)};
+  pipeline_id_t profile_pipeline_id_{INVALID_PIPELINE_ID};
   exec::ExecutionSettings exec_settings_;
   catalog::db_oid_t db_oid_;
   common::ManagedPointer<transaction::TransactionContext> txn_;
@@ -351,12 +520,14 @@ class EXPORT ExecutionContext {
   // TODO(WAN): EXEC PORT we used to push the memory tracker into the string allocator, do this
   sql::VarlenHeap string_allocator_;
   common::ManagedPointer<selfdriving::PipelineOperatingUnits> pipeline_operating_units_{nullptr};
+  common::ManagedPointer<sql::FilterOrderCache> filter_order_cache_{nullptr};
 
   common::ManagedPointer<catalog::CatalogAccessor> accessor_;
   common::ManagedPointer<metrics::MetricsManager> metrics_manager_;
   common::ManagedPointer<const std::vector<parser::ConstantValueExpression>> params_;
   uint8_t execution_mode_;
-  uint32_t rows_affected_ = 0;
+  std::atomic<uint32_t> rows_affected_{0};
+  double sample_scale_ = 1.0;
 
   common::ManagedPointer<replication::ReplicationManager> replication_manager_;
   common::ManagedPointer<storage::RecoveryManager> recovery_manager_;
@@ -364,7 +535,15 @@ class EXPORT ExecutionContext {
   bool memory_use_override_ = false;
   uint32_t memory_use_override_value_ = 0;
   uint32_t num_concurrent_estimate_ = 0;
+  bool is_admitted_for_parallel_execution_ = false;
   std::vector<HookFn> hooks_{};
-  void *query_state_;
+  void *query_state_{nullptr};
+  std::unique_ptr<QueryProfile> query_profile_;
+  std::atomic<bool> canceled_{false};
+  std::optional<std::chrono::steady_clock::time_point> deadline_;
+  common::ManagedPointer<planner::PlanMetaData> cardinality_estimates_{nullptr};
+  int64_t max_cardinality_error_ = 0;
+  std::vector<std::pair<planner::plan_node_id_t, uint64_t>> observed_cardinalities_;
+  bool needs_reoptimization_ = false;
 };
 }  // namespace noisepage::execution::exec
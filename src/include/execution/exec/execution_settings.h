@@ -3,6 +3,7 @@
 #include "common/constants.h"
 #include "common/managed_pointer.h"
 #include "execution/util/execution_common.h"
+#include "execution/vm/vm_defs.h"
 
 namespace noisepage::settings {
 class SettingsManager;
@@ -13,6 +14,7 @@ class ExecutionRunners;
 }  // namespace noisepage::runner
 
 namespace noisepage::execution {
+class ExecutionBenchmarkUtil;
 class SqlBasedTest;
 }  // namespace noisepage::execution
 
@@ -70,9 +72,59 @@ class EXPORT ExecutionSettings {
   /** @return number of threads used for parallel execution. */
   int GetNumberOfParallelExecutionThreads() const { return number_of_parallel_execution_threads_; }
 
+  /** @return Number of bytes a thread may take up during a parallel aggregation before it spills, 0 for no limit. */
+  int64_t GetAggregationMemoryBudget() const { return aggregation_memory_budget_; }
+
+  /** @return Percentage of tuples starting new groups at which pre-aggregation is bypassed, 0 to never bypass it. */
+  int64_t GetAggregationBypassThreshold() const { return aggregation_bypass_threshold_; }
+
+  /** @return Number of bytes of build-side tuples a hash join may keep in memory before it spills, 0 for no limit. */
+  int64_t GetJoinMemoryBudget() const { return join_memory_budget_; }
+
+  /** @return Number of bytes of tuples a sorter may buffer in memory before it spills, 0 for no limit. */
+  int64_t GetSortMemoryBudget() const { return sort_memory_budget_; }
+
+  /** @return Number of radix bits a parallel hash join build partitions on, 0 for none, -1 to fit the L2 cache. */
+  int64_t GetJoinBuildPartitionBits() const { return join_build_partition_bits_; }
+
+  /** @return True if built hash join tables store their tuples grouped by bucket, without entry headers. */
+  bool GetIsJoinCompactLayoutEnabled() const { return is_join_compact_layout_enabled_; }
+
+  /** @return Number of queries that may run parallel steps at the same time, 0 for no limit. */
+  int GetMaxParallelQueries() const { return max_parallel_queries_; }
+
+  /** @return Number of bytes a query may allocate before its parallel steps run serially, 0 for no limit. */
+  int64_t GetQueryMemoryBudget() const { return query_memory_budget_; }
+
+  /** @return Milliseconds the query may execute before it is canceled, 0 for no limit. */
+  int GetStatementTimeout() const { return statement_timeout_; }
+
+  /** @return Number of blocks of a table that ANALYZE samples, 0 to read the whole table. */
+  int GetAnalyzeSampleBlocks() const { return analyze_sample_blocks_; }
+
   /** @return True if static partitioner is enabled. */
   constexpr bool GetIsStaticPartitionerEnabled() const { return is_static_partitioner_enabled_; }
 
+  /** @return The optimization pipeline the query is compiled to machine code with. */
+  vm::OptimizationProfile GetOptimizationProfile() const { return optimization_profile_; }
+
+  /**
+   * Set the optimization pipeline the query is compiled to machine code with. It is picked per query by whoever
+   * knows its expected amount of work, e.g., from the optimizer's cardinality estimates.
+   * @param profile The optimization profile.
+   */
+  void SetOptimizationProfile(vm::OptimizationProfile profile) { optimization_profile_ = profile; }
+
+  /** @return True if the query is compiled to count the rows of its operators and time its pipelines. */
+  bool GetIsProfilingEnabled() const { return is_profiling_enabled_; }
+
+  /**
+   * Set whether the query is compiled to count the rows of its operators and time its pipelines. It is enabled per
+   * query by EXPLAIN ANALYZE, whose measurements are collected in the execution context's QueryProfile.
+   * @param enabled True to enable profiling.
+   */
+  void SetIsProfilingEnabled(bool enabled) { is_profiling_enabled_ = enabled; }
+
  private:
   double select_opt_threshold_{common::Constants::SELECT_OPT_THRESHOLD};
   double arithmetic_full_compute_opt_threshold_{common::Constants::ARITHMETIC_FULL_COMPUTE_THRESHOLD};
@@ -83,11 +135,24 @@ class EXPORT ExecutionSettings {
   bool is_pipeline_metrics_enabled_{common::Constants::IS_PIPELINE_METRICS_ENABLED};
   int number_of_parallel_execution_threads_{common::Constants::NUM_PARALLEL_EXECUTION_THREADS};
   bool is_static_partitioner_enabled_{common::Constants::IS_STATIC_PARTITIONER_ENABLED};
+  int64_t aggregation_memory_budget_{common::Constants::AGGREGATION_MEMORY_BUDGET};
+  int64_t aggregation_bypass_threshold_{common::Constants::AGGREGATION_BYPASS_THRESHOLD};
+  int64_t join_memory_budget_{common::Constants::JOIN_MEMORY_BUDGET};
+  int64_t sort_memory_budget_{common::Constants::SORT_MEMORY_BUDGET};
+  int64_t join_build_partition_bits_{common::Constants::JOIN_BUILD_PARTITION_BITS};
+  bool is_join_compact_layout_enabled_{common::Constants::IS_JOIN_COMPACT_LAYOUT_ENABLED};
+  int max_parallel_queries_{common::Constants::MAX_PARALLEL_QUERIES};
+  int64_t query_memory_budget_{common::Constants::QUERY_MEMORY_BUDGET};
+  int statement_timeout_{common::Constants::STATEMENT_TIMEOUT};
+  int analyze_sample_blocks_{common::Constants::ANALYZE_SAMPLE_BLOCKS};
+  vm::OptimizationProfile optimization_profile_{vm::OptimizationProfile::Balanced};
+  bool is_profiling_enabled_{false};
 
   // MiniRunners needs to set query_identifier and pipeline_operating_units_.
   friend class noisepage::runner::ExecutionRunners;
   friend class noisepage::tpch::Workload;
   friend class noisepage::execution::SqlBasedTest;
+  friend class noisepage::execution::ExecutionBenchmarkUtil;
   friend class noisepage::optimizer::IdxJoinTest_SimpleIdxJoinTest_Test;
   friend class noisepage::optimizer::IdxJoinTest_MultiPredicateJoin_Test;
   friend class noisepage::optimizer::IdxJoinTest_MultiPredicateJoinWithExtra_Test;
@@ -12,12 +12,9 @@
 #include "execution/sql/memory_pool.h"
 #include "execution/util/execution_common.h"
 #include "network/network_defs.h"
+#include "network/postgres/postgres_packet_writer.h"
 #include "parser/parser_defs.h"
 
-namespace noisepage::network {
-class PostgresPacketWriter;
-}  // namespace noisepage::network
-
 namespace noisepage::planner {
 class OutputSchema;
 }  // namespace noisepage::planner
@@ -137,11 +134,12 @@ class OutputWriter {
    * @param schema final schema to output for this query
    * @param out packet writer to use
    * @param field_formats reference to the field formats for this query
+   * @param copy_out true if the results are streamed as the binary COPY format of a COPY ... TO STDOUT rather than as
+   * DataRow messages
    */
-  OutputWriter(const common::ManagedPointer<planner::OutputSchema> schema,
-               const common::ManagedPointer<network::PostgresPacketWriter> out,
-               const std::vector<network::FieldFormat> &field_formats)
-      : schema_(schema), out_(out), field_formats_(field_formats) {}
+  OutputWriter(common::ManagedPointer<planner::OutputSchema> schema,
+               common::ManagedPointer<network::PostgresPacketWriter> out,
+               const std::vector<network::FieldFormat> &field_formats, bool copy_out = false);
 
   /**
    * Callback that writes results to PostgresPacketWriter.
@@ -168,6 +166,9 @@ class OutputWriter {
   const common::ManagedPointer<planner::OutputSchema> schema_;
   const common::ManagedPointer<network::PostgresPacketWriter> out_;
   const std::vector<network::FieldFormat> &field_formats_;
+  const bool copy_out_;
+  /** Where every attribute is in the output tuples and how it's written, resolved once for the whole result. */
+  const std::vector<network::DataRowAttribute> layout_;
 };
 
 /**
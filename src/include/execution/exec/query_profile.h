@@ -0,0 +1,90 @@
+#pragma once
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "common/macros.h"
+#include "execution/exec_defs.h"
+#include "execution/util/execution_common.h"
+#include "planner/plannodes/plan_node_defs.h"
+
+namespace noisepage::execution::exec {
+
+/**
+ * The measurements EXPLAIN ANALYZE collects while a query runs. Code compiled with profiling enabled counts the rows
+ * every operator produces in its pipeline's state, and reports them once per thread when the state is torn down.
+ * Every pipeline is timed with the CPU's cycle counter and a steady clock around its run function, and the memory
+ * the query holds when the pipeline is done is compared to what it held when it started.
+ *
+ * Pipelines fuse their operators into one loop, so the time and memory of a pipeline aren't split any further among
+ * the operators in it.
+ */
+class EXPORT QueryProfile {
+ public:
+  /** The measurements of a pipeline. */
+  struct PipelineProfile {
+    /** The CPU cycles spent running the pipeline. */
+    uint64_t cycles_{0};
+    /** The nanoseconds spent running the pipeline. */
+    uint64_t nanoseconds_{0};
+    /** The bytes the query held more after the pipeline ran than before, e.g., in hash tables it built. */
+    int64_t memory_bytes_{0};
+  };
+
+  /** The measurements of an operator. */
+  struct OperatorProfile {
+    /** The rows the operator produced. */
+    uint64_t rows_{0};
+    /** The pipelines the operator is part of, in the order they reported. */
+    std::vector<pipeline_id_t> pipelines_;
+  };
+
+  /**
+   * Start timing a pipeline.
+   * @param pipeline_id The pipeline about to run.
+   * @param memory_bytes The bytes the query holds before the pipeline runs.
+   */
+  void StartPipeline(pipeline_id_t pipeline_id, int64_t memory_bytes);
+
+  /**
+   * Stop timing a pipeline and record its measurements.
+   * @param pipeline_id The pipeline that ran.
+   * @param memory_bytes The bytes the query holds after the pipeline ran.
+   */
+  void EndPipeline(pipeline_id_t pipeline_id, int64_t memory_bytes);
+
+  /**
+   * Add to the rows an operator produced. This is called from every thread that ran part of the pipeline.
+   * @param pipeline_id The pipeline the rows were produced in.
+   * @param plan_node_id The plan node of the operator.
+   * @param num_rows The number of rows.
+   */
+  void AddOperatorRows(pipeline_id_t pipeline_id, planner::plan_node_id_t plan_node_id, uint64_t num_rows);
+
+  /** @return The measurements of the pipeline with id @em pipeline_id, or nullptr if it didn't run. */
+  const PipelineProfile *GetPipelineProfile(pipeline_id_t pipeline_id) const;
+
+  /** @return The measurements of the operator of plan node @em plan_node_id, or nullptr if it didn't run. */
+  const OperatorProfile *GetOperatorProfile(planner::plan_node_id_t plan_node_id) const;
+
+  /** @return The ids of all pipelines that ran, in the order they ran. */
+  const std::vector<pipeline_id_t> &GetPipelineIds() const { return pipeline_ids_; }
+
+ private:
+  // A pipeline that is running
+  struct RunningPipeline {
+    uint64_t start_cycles_;
+    uint64_t start_nanoseconds_;
+    int64_t start_memory_bytes_;
+  };
+
+  std::unordered_map<pipeline_id_t, RunningPipeline> running_pipelines_;
+  std::unordered_map<pipeline_id_t, PipelineProfile> pipelines_;
+  std::vector<pipeline_id_t> pipeline_ids_;
+  // Guards operators_, which threads of a parallel pipeline report to concurrently
+  std::mutex operators_mutex_;
+  std::unordered_map<planner::plan_node_id_t, OperatorProfile> operators_;
+};
+
+}  // namespace noisepage::execution::exec
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+#include "common/macros.h"
+
+namespace noisepage::metrics {
+class MetricsRowWriter;
+}  // namespace noisepage::metrics
+
+namespace noisepage::execution::exec {
+
+/**
+ * Attributes the CPU time of queries to their pipelines by sampling, cheaply enough to leave on in production. While
+ * the profiler runs, the threads that use CPU get a SIGPROF at the sampling frequency, and each counts a sample toward
+ * its tag: the query and pipeline it runs, which the ExecutionContext of the query sets. Samples of threads that don't
+ * run a query are only counted in total.
+ *
+ * perf can name JIT compiled functions through the perf map of the LLVMEngine, but neither it nor the interpreter
+ * knows which query a function runs for, nor the code of the runtime that pipelines call into. Tags cover all of it.
+ *
+ * There is a single profiler per process, since signal handlers and the profiling timer are per process.
+ */
+class SamplingProfiler {
+ public:
+  /** What the samples of a thread count toward. */
+  struct Tag {
+    /** Query the thread runs. */
+    uint32_t query_id_;
+    /** Pipeline of the query the thread runs, 0 if the thread runs a step of the query outside of its pipelines. */
+    uint32_t pipeline_id_;
+  };
+
+  /** The samples counted toward a tag. */
+  struct Samples {
+    /** Tag of the samples. */
+    Tag tag_;
+    /** Number of samples. */
+    uint64_t count_;
+  };
+
+  /**
+   * Tags the samples that the calling thread takes while the scope lives, and restores the previous tag when it ends.
+   * Scopes are cheap enough to open whether the profiler runs or not.
+   */
+  class TagScope {
+   public:
+    /** @param tag what the samples of the thread count toward */
+    explicit TagScope(Tag tag);
+    ~TagScope();
+    DISALLOW_COPY_AND_MOVE(TagScope);
+
+   private:
+    const uint64_t previous_;
+  };
+
+  /** Number of different tags that samples are counted for. The samples of any more are only counted in total. */
+  static constexpr uint32_t MAX_TAGS = 4096;
+
+  /** Columns of the rows that Write() writes. */
+  static constexpr std::string_view COLUMNS = "query_id, pipeline_id, samples";
+
+  SamplingProfiler() = delete;
+
+  /**
+   * Start sampling, dropping the samples counted so far.
+   * @param frequency_hz number of samples to take per second of CPU time
+   */
+  static void Start(uint32_t frequency_hz);
+
+  /** Stop sampling. The samples counted so far are kept. */
+  static void Stop();
+
+  /** @return true if the profiler is sampling */
+  static bool IsRunning();
+
+  /** @return the samples counted toward each tag, most first */
+  static std::vector<Samples> GetSamples();
+
+  /** @return number of samples taken, tagged or not */
+  static uint64_t NumSamples();
+
+  /**
+   * Writes the samples counted toward each tag, as a row per tag, most first.
+   * @param writer writer for the rows
+   */
+  static void Write(metrics::MetricsRowWriter *writer);
+
+  /**
+   * Sets the tag of the calling thread without restoring it, for threads that join and leave work of a query on their
+   * own, like the workers of a parallel step.
+   * @param tag what the samples of the thread count toward, or nullptr to not count them toward a tag
+   */
+  static void SetThreadTag(const Tag *tag);
+};
+
+}  // namespace noisepage::execution::exec
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <tbb/task_arena.h>
+#include <tbb/task_scheduler_observer.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <utility>
+
+#include "execution/exec/execution_context.h"
+#include "execution/exec/execution_settings.h"
+#include "execution/exec/sampling_profiler.h"
+
+namespace noisepage::execution::exec {
+
+/**
+ * The engine-wide scheduler that the parallel steps of query execution submit their morsels to.
+ *
+ * All queries share a single pool of worker threads sized to the machine, and idle workers steal
+ * morsels from busy ones. Each parallel step runs in an arena capped at its query's number of
+ * parallel execution threads, so concurrent queries divide the workers between them instead of
+ * each starting as many threads as there are cores.
+ *
+ * The scheduler also admits steps. A step only gets the workers that no other step holds, and it
+ * runs serially on the query's own thread when no worker is free, when its query is over its
+ * memory budget, or when the maximum number of queries already run parallel steps. A query holds
+ * its slot among those from its first parallel step until its execution context is destroyed.
+ * Serial steps leave the remaining workers to the queries that already hold them, which keeps one
+ * large query from starving short ones.
+ */
+class EXPORT TaskScheduler {
+ public:
+  /**
+   * @return The number of threads in the engine-wide worker pool.
+   */
+  static uint32_t NumWorkerThreads();
+
+  /**
+   * @param exec_settings The settings of the query.
+   * @return The number of threads the parallel steps of the query run on at most.
+   */
+  static uint32_t MaxConcurrency(const ExecutionSettings &exec_settings);
+
+  /**
+   * Run a parallel step of the query executing in the given context. The function spawns the
+   * step's morsels, and this call returns once all of them are done. The query's concurrency
+   * estimate is set for the duration of the step.
+   * @tparam F A function taking no arguments.
+   * @param exec_ctx The context of the query the step belongs to.
+   * @param num_tasks The number of morsels the step is split into.
+   * @param f The function spawning the morsels.
+   */
+  template <typename F>
+  static void Execute(ExecutionContext *exec_ctx, uint64_t num_tasks, F &&f) {
+    const uint32_t concurrency = AdmitStep(exec_ctx, num_tasks);
+    exec_ctx->SetNumConcurrentEstimate(static_cast<uint32_t>(std::min<uint64_t>(concurrency, num_tasks)));
+    tbb::task_arena arena(static_cast<int>(concurrency));
+    std::optional<ProfileTagObserver> profile_tag;
+    if (SamplingProfiler::IsRunning()) profile_tag.emplace(&arena, exec_ctx->GetProfileTag());
+    arena.execute(std::forward<F>(f));
+    exec_ctx->SetNumConcurrentEstimate(0);
+    ReleaseStep(concurrency);
+  }
+
+  /**
+   * Give up a slot among the queries that may run parallel steps.
+   */
+  static void ReleaseQuery();
+
+ private:
+  // Tags the samples of the workers that join an arena with the query and pipeline the arena runs.
+  class ProfileTagObserver : public tbb::task_scheduler_observer {
+   public:
+    ProfileTagObserver(tbb::task_arena *arena, SamplingProfiler::Tag tag)
+        : tbb::task_scheduler_observer(*arena), tag_(tag) {
+      observe(true);
+    }
+    ~ProfileTagObserver() override { observe(false); }
+    void on_scheduler_entry(bool is_worker) override {
+      if (is_worker) SamplingProfiler::SetThreadTag(&tag_);
+    }
+    void on_scheduler_exit(bool is_worker) override {
+      if (is_worker) SamplingProfiler::SetThreadTag(nullptr);
+    }
+
+   private:
+    const SamplingProfiler::Tag tag_;
+  };
+
+  // Decide how many threads a step runs on, taking the workers beyond the
+  // query's own thread from the pool.
+  static uint32_t AdmitStep(ExecutionContext *exec_ctx, uint64_t num_tasks);
+
+  // Return the workers a step took to the pool.
+  static void ReleaseStep(uint32_t concurrency);
+};
+
+}  // namespace noisepage::execution::exec
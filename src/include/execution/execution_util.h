@@ -17,10 +17,12 @@ class ExecutionUtil {
 
   /**
    * Initialize all TPL subsystems
+   * @param bytecode_handlers_path path to the bytecode handlers bitcode file
+   * @param write_perf_map whether to list the JIT compiled functions in /tmp/perf-<pid>.map for perf
    */
-  static void InitTPL(std::string_view bytecode_handlers_path) {
+  static void InitTPL(std::string_view bytecode_handlers_path, bool write_perf_map = false) {
     execution::CpuInfo::Instance();
-    auto settings = std::make_unique<const typename vm::LLVMEngine::Settings>(bytecode_handlers_path);
+    auto settings = std::make_unique<const typename vm::LLVMEngine::Settings>(bytecode_handlers_path, write_perf_map);
     execution::vm::LLVMEngine::Initialize(std::move(settings));
   }
 
@@ -71,6 +71,9 @@ namespace sema {
   F(BadArgToPtrCast, "ptrCast() expects (compile-time *Type, Expr) arguments. Received type '%0' in position %1",     \
     (ast::Type *, uint32_t))                                                                                          \
   F(BadHashArg, "cannot hash type '%0'", (ast::Type *))                                                               \
+  F(BadNormalizedKeyFunctionForSorter,                                                                                \
+    "sorterSetNormalizedKey requires a key function of type (*)->uint64. Received type '%0'", (ast::Type *))          \
+  F(BadNormalizeKeyArg, "cannot normalize type '%0' into a sort key", (ast::Type *))                                  \
   F(MissingArrayLength, "missing array length (either compile-time number or '*')", ())                               \
   F(NotASQLAggregate, "'%0' is not a SQL aggregator type", (ast::Type *))                                             \
   F(BadParallelScanFunction,                                                                                          \
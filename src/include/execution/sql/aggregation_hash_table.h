@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstring>
 #include <functional>
 #include <memory>
 #include <utility>
@@ -9,6 +10,7 @@
 #include "common/managed_pointer.h"
 #include "execution/sql/chaining_hash_table.h"
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/value.h"
 #include "execution/sql/vector.h"
 #include "execution/sql/vector_projection.h"
 #include "execution/util/chunked_vector.h"
@@ -25,6 +27,7 @@ class ExecutionContext;
 
 namespace noisepage::execution::sql {
 
+class SpillFile;
 class ThreadStateContainer;
 class VectorProjectionIterator;
 
@@ -64,6 +67,12 @@ class EXPORT AggregationHashTable {
   /** The default precision used to configure the HyperLogLog instances. Set to optimize accuracy and space manually. */
   static constexpr uint32_t DEFAULT_HLL_PRECISION = 10;
 
+  /** The number of spilled aggregates that are read back and merged at a time. */
+  static constexpr uint32_t SPILL_READ_BATCH_SIZE = 1024;
+
+  /** The largest number of keys a dense group index may span, so that the index stays cache-resident. */
+  static constexpr uint32_t MAX_DENSE_DOMAIN_SIZE = 4096;
+
   // -------------------------------------------------------
   // Callback functions to customize aggregations
   // -------------------------------------------------------
@@ -114,6 +123,10 @@ class EXPORT AggregationHashTable {
     uint64_t num_flushes_ = 0;
     /** Number of times that the hash table has been inserted into. */
     uint64_t num_inserts_ = 0;
+    /** Number of times that the overflow partitions have been spilled to disk. */
+    uint64_t num_spills_ = 0;
+    /** Number of input tuples that were partitioned without being pre-aggregated. */
+    uint64_t num_bypassed_ = 0;
   };
 
   // -------------------------------------------------------
@@ -173,6 +186,15 @@ class EXPORT AggregationHashTable {
    */
   void Insert(HashTableEntry *entry) { hash_table_.Insert<false>(entry); }
 
+  /**
+   * Copy the contents of the string key of a newly inserted group into this table, unless the key is short enough to
+   * be inlined. The copies are freed all at once along with the table, and stay valid after the strings they were
+   * copied from are gone. Since keys keep their size and prefix inline, probes mostly reject groups without reading the
+   * copies at all.
+   * @param[in,out] key The string key of the new group, which is updated to point to its copy in this table.
+   */
+  void InternStringKey(StringVal *key);
+
   /**
    * Lookup and return an entry in the aggregation table that matches a given hash and key. The hash
    * value is provided here, keys are checked using the provided callback function.
@@ -183,6 +205,35 @@ class EXPORT AggregationHashTable {
    */
   byte *Lookup(hash_t hash, KeyEqFn key_eq_fn, const void *probe_tuple);
 
+  /**
+   * Index the groups of an aggregation on a single integer key by their keys directly, for keys in the range
+   * [@em min_key, @em min_key + @em num_keys). The groups of keys in the range can then be found with LookupDense()
+   * without hashing the key, walking a chain or comparing keys. Keys outside the range, and NULL, must still be looked
+   * up through Lookup(), so that the range needn't hold for all the input.
+   * @param min_key The smallest key in the range.
+   * @param num_keys The number of keys in the range, at most MAX_DENSE_DOMAIN_SIZE.
+   */
+  void SetDenseDomain(int64_t min_key, uint32_t num_keys);
+
+  /**
+   * @return A pointer to the payload of the group with key @em key; null if the key isn't in the dense domain, or its
+   *         group hasn't been indexed with InsertDense().
+   */
+  byte *LookupDense(const Integer &key) const {
+    const auto offset = static_cast<uint64_t>(key.val_) - static_cast<uint64_t>(dense_min_key_);
+    return key.is_null_ || offset >= dense_groups_.size() ? nullptr : dense_groups_[offset];
+  }
+
+  /**
+   * Index the group with key @em key in the dense domain. Does nothing if the key isn't in the domain.
+   * @param key The key of the group.
+   * @param payload The payload of the group, as returned when it was inserted.
+   */
+  void InsertDense(const Integer &key, byte *payload) {
+    const auto offset = static_cast<uint64_t>(key.val_) - static_cast<uint64_t>(dense_min_key_);
+    if (!key.is_null_ && offset < dense_groups_.size()) dense_groups_[offset] = payload;
+  }
+
   /**
    * Ingest and process a batch of input into the aggregation table.
    * @param input_batch The vector projection to process.
@@ -214,7 +265,8 @@ class EXPORT AggregationHashTable {
    * in a partitioned manner, otherwise use a simple tpl::sql::AHTITerator. This function builds a
    * hash table for any non-empty  overflow partition (if one doesn't exist), merges the contents of
    * the partition (using the merging function provided to the call to
-   * @em TransferMemoryAndPartitions()), and invokes the scan callback function.
+   * @em TransferMemoryAndPartitions()), and invokes the scan callback function. The tables over partitions that were
+   * spilled to disk are freed once they have been scanned, so the scan can only be run once.
    *
    * @param query_state The (opaque) query state.
    * @param scan_fn The callback scan function, called once for each overflow partition hash table.
@@ -227,7 +279,8 @@ class EXPORT AggregationHashTable {
    * overflow partition (if one doesn't exist), merges the contents of the partition (using the
    * merging function provided to the call to @em TransferMemoryAndPartitions()), and invokes the
    * scan callback function. All steps are performed in parallel; hence, the callback function
-   * must be thread-safe.
+   * must be thread-safe. The tables over partitions that were spilled to disk are freed once they
+   * have been scanned, so the scan can only be run once.
    *
    * The thread states container is assumed to already have been configured prior to this scan call.
    *
@@ -242,7 +295,8 @@ class EXPORT AggregationHashTable {
   void ExecuteParallelPartitionedScan(void *query_state, ThreadStateContainer *thread_states, ScanPartitionFn scan_fn);
 
   /**
-   * Construct a new aggregation hash table instance for each non-empty overflow partition.
+   * Construct a new aggregation hash table instance for each non-empty overflow partition. Spilled aggregates are read
+   * back and merged into the table of their partition.
    * @param query_state An opaque state object pointer
    */
   void BuildAllPartitions(void *query_state);
@@ -309,6 +363,33 @@ class EXPORT AggregationHashTable {
   // Allocate all overflow partition information if unallocated
   void AllocateOverflowPartitions();
 
+  // Does the overflow partition hold any aggregates, in memory or spilled?
+  bool IsPartitionEmpty(uint32_t partition_idx) const {
+    return partition_heads_[partition_idx] == nullptr && partition_spills_[partition_idx].empty();
+  }
+
+  // If a flush happened since the last check and the thread is over its memory
+  // budget, write all aggregates out to disk and release their memory. Only
+  // called when no payload returned to the caller is still to be written.
+  void SpillIfOverMemoryBudget();
+
+  // Write all entries in the overflow partitions to the spill file and free them
+  void SpillOverflowPartitions();
+
+  // Read the spilled aggregates of a partition back and merge them into the
+  // given table.
+  void MergeSpilledPartition(void *query_state, AggregationHashTable *target, uint32_t partition_idx,
+                             MergePartitionFn merge_fn);
+
+  // Take over the spill files and spilled runs of another table
+  void TakeSpilledPartitions(AggregationHashTable *other);
+
+  // Take over the string keys of another table, whose entries are taken over as well
+  void TakeStringKeys(AggregationHashTable *other);
+
+  // Destroy the aggregation hash table built over a partition
+  void ReleasePartitionTable(uint32_t partition_idx);
+
   // Called from ProcessBatch() to compute hash values for tuples in batch.
   void ComputeHash(VectorProjectionIterator *input_batch, const std::vector<uint32_t> &key_indexes);
 
@@ -330,6 +411,16 @@ class EXPORT AggregationHashTable {
   void CreateMissingGroups(VectorProjectionIterator *input_batch, const std::vector<uint32_t> &key_indexes,
                            VectorInitAggFn init_agg_fn);
 
+  // Called from ProcessBatch() to turn every tuple of the batch into an
+  // aggregate of its own, linked straight into the overflow partitions.
+  void PartitionBatch(VectorProjectionIterator *input_batch, VectorInitAggFn init_agg_fn,
+                      VectorAdvanceAggFn advance_agg_fn);
+
+  // Called from ProcessBatch() when enough input tuples have been sampled to
+  // decide whether to bypass pre-aggregation, given the number of groups the
+  // sampled tuples formed.
+  void DecideBypass(uint64_t num_groups);
+
   // Called from ProcessBatch() to update aggregates with tuples from batch that
   // found matching group.
   void AdvanceGroups(VectorProjectionIterator *input_batch, VectorAdvanceAggFn advance_agg_fn);
@@ -353,6 +444,7 @@ class EXPORT AggregationHashTable {
     void Reset(VectorProjectionIterator *input_batch);
 
     libcount::HLL *HLL() { return hll_estimator_.get(); }
+    void ResetHLL();
     VectorProjection *Projection() { return &hash_and_entries_; }
     Vector *Hashes() { return hash_and_entries_.GetColumn(0); }
     Vector *Entries() { return hash_and_entries_.GetColumn(1); }
@@ -396,12 +488,25 @@ class EXPORT AggregationHashTable {
   // Entries taken from other tables.
   MemPoolVector<decltype(entries_)> owned_entries_;
 
+  // The contents of the string keys of the groups, which are not inlined.
+  VarlenHeap string_heap_;
+
+  // String keys taken from other tables, along with their entries.
+  MemPoolVector<VarlenHeap> owned_string_heaps_;
+
   // The hash index.
   UntaggedChainingHashTable hash_table_;
 
   // State used during batch processing.
   MemPoolPtr<BatchProcessState> batch_state_;
 
+  // The groups indexed by their key minus the smallest key of the dense
+  // domain, or null. Empty if there is no dense domain. Only groups that are
+  // in the hash table are indexed, so the index is cleared whenever the table
+  // is flushed into the overflow partitions.
+  int64_t dense_min_key_;
+  MemPoolVector<byte *> dense_groups_;
+
   // -------------------------------------------------------
   // Overflow partitions
   // -------------------------------------------------------
@@ -428,6 +533,44 @@ class EXPORT AggregationHashTable {
   // partition an entry is linked into.
   uint64_t partition_shift_bits_;
 
+  // -------------------------------------------------------
+  // Spilled overflow partitions
+  // -------------------------------------------------------
+
+  // A contiguous run of spilled aggregates of one overflow partition. Each is
+  // stored as its hash value followed by its payload.
+  struct SpilledRun {
+    const SpillFile *file_;
+    uint64_t offset_;
+    uint64_t num_entries_;
+  };
+  // The number of bytes a thread may take up before aggregates are spilled,
+  // zero if there is no limit.
+  int64_t memory_budget_;
+  // Set by a flush, cleared by the next memory budget check.
+  bool check_memory_budget_;
+  // The file this table spills into, created on the first spill.
+  SpillFile *spill_file_;
+  // All spill files holding aggregates of this table, including those taken
+  // from other tables.
+  std::vector<std::unique_ptr<SpillFile>> spill_files_;
+  // The spilled runs of each overflow partition. Sized along with the other
+  // overflow partition arrays.
+  std::vector<std::vector<SpilledRun>> partition_spills_;
+
+  // -------------------------------------------------------
+  // Adaptive pre-aggregation
+  // -------------------------------------------------------
+
+  // The percentage of input tuples starting a new group at or above which
+  // batches are partitioned without being pre-aggregated, zero to always
+  // pre-aggregate them.
+  int64_t bypass_threshold_;
+  // Are batches currently partitioned without being pre-aggregated?
+  bool bypass_;
+  // The number of input tuples seen since the last bypass decision.
+  uint64_t num_sampled_tuples_;
+
   // Runtime stats.
   Stats stats_;
 
@@ -457,6 +600,16 @@ inline byte *AggregationHashTable::Lookup(hash_t hash, AggregationHashTable::Key
   return (entry == nullptr ? nullptr : entry->payload_);
 }
 
+inline void AggregationHashTable::InternStringKey(StringVal *key) {
+  if (key->is_null_ || key->val_.IsInlined()) {
+    return;
+  }
+  const uint32_t size = key->val_.Size();
+  char *content = string_heap_.PreAllocate(size);
+  std::memcpy(content, key->val_.Content(), size);
+  key->val_ = storage::VarlenEntry::Create(reinterpret_cast<const byte *>(content), size, false);
+}
+
 //===----------------------------------------------------------------------===//
 //
 // Aggregation Hash Table Iterator
@@ -3,9 +3,12 @@
 #include <algorithm>
 #include <limits>
 
+#include "common/error/error_code.h"
+#include "common/error/exception.h"
 #include "common/macros.h"
 #include "execution/exec/execution_context.h"
 #include "execution/sql/value.h"
+#include "execution/sql/vector_operations/vector_operations.h"
 #include "optimizer/statistics/histogram.h"
 #include "optimizer/statistics/top_k_elements.h"
 
@@ -29,6 +32,16 @@ class CountAggregate {
    */
   void Advance(const Val &val) { count_ += static_cast<uint64_t>(!val.is_null_); }
 
+  /**
+   * Advance the count by the active, non-NULL elements of the vector @em input.
+   */
+  void AdvanceVector(const Vector &input) { count_ += VectorOps::CountNotNull(input); }
+
+  /**
+   * Advance the count by @em num_tuples tuples, none of which is NULL.
+   */
+  void AdvanceTuples(const uint64_t num_tuples) { count_ += num_tuples; }
+
   /**
    * Merge this count with the @em that count.
    */
@@ -114,6 +127,17 @@ class SumAggregate {
     sum_.val_ += val.val_;
   }
 
+  /**
+   * Advance the aggregate by the active, non-NULL elements of the vector @em input.
+   * @param input The vector of values to advance the sum by.
+   */
+  void AdvanceVector(const Vector &input) {
+    decltype(T::val_) partial;
+    if (VectorOps::Sum(input, &partial)) {
+      Advance(T(partial));
+    }
+  }
+
   /**
    * Merge a partial sum aggregate into this aggregate.
    * If the partial sum is NULL, no change is applied to this aggregate.
@@ -151,6 +175,76 @@ class IntegerSumAggregate : public SumAggregate<Integer> {};
 /** Real sums. */
 class RealSumAggregate : public SumAggregate<Real> {};
 
+/**
+ * Sums of decimals. The sum is accumulated in 128 bits, so that no intermediate sum overflows; only a final sum that
+ * does not fit into a decimal is an error. The sum has the scale of its inputs.
+ */
+class DecimalSumAggregate {
+ public:
+  /**
+   * Constructor.
+   */
+  DecimalSumAggregate() = default;
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(DecimalSumAggregate);
+
+  /**
+   * Advance the aggregate by a given input value.
+   * If the input is NULL, no change is applied to the aggregate.
+   * @param val The (potentially NULL) value to advance the sum by.
+   */
+  void Advance(const DecimalVal &val) {
+    if (val.is_null_) {
+      return;
+    }
+    is_null_ = false;
+    sum_ += static_cast<int64_t>(val.val_);
+  }
+
+  /**
+   * Merge a partial sum aggregate into this aggregate.
+   * If the partial sum is NULL, no change is applied to this aggregate.
+   * @param that The (potentially NULL) value to merge into this aggregate.
+   */
+  void Merge(const DecimalSumAggregate &that) {
+    if (that.is_null_) {
+      return;
+    }
+    is_null_ = false;
+    sum_ += that.sum_;
+  }
+
+  /**
+   * Reset the summation.
+   */
+  void Reset() {
+    is_null_ = true;
+    sum_ = 0;
+  }
+
+  /**
+   * Return the result of the summation.
+   * @return The current value of the sum.
+   * @throw ExecutionException If the sum does not fit into a decimal.
+   */
+  DecimalVal GetResultSum() const {
+    if (is_null_) {
+      return DecimalVal::Null();
+    }
+    if (sum_ > std::numeric_limits<int64_t>::max() || sum_ < std::numeric_limits<int64_t>::min()) {
+      throw EXECUTION_EXCEPTION("Decimal sum out of range.", common::ErrorCode::ERRCODE_NUMERIC_VALUE_OUT_OF_RANGE);
+    }
+    return DecimalVal(static_cast<int64_t>(sum_));
+  }
+
+ private:
+  int128_t sum_{0};
+  bool is_null_{true};
+};
+
 /** Generic max. */
 template <typename T>
 class MaxAggregate {
@@ -183,6 +277,16 @@ class MaxAggregate {
     max_.is_null_ = false;
   }
 
+  /**
+   * Advance the aggregate by the active, non-NULL elements of the vector @em input.
+   */
+  void AdvanceVector(const Vector &input) {
+    decltype(T::val_) partial;
+    if (VectorOps::Max(input, &partial)) {
+      Advance(T(partial));
+    }
+  }
+
   /**
    * Merge a partial max aggregate into this aggregate.
    */
@@ -263,6 +367,16 @@ class MinAggregate {
     min_.is_null_ = false;
   }
 
+  /**
+   * Advance the aggregate by the active, non-NULL elements of the vector @em input.
+   */
+  void AdvanceVector(const Vector &input) {
+    decltype(T::val_) partial;
+    if (VectorOps::Min(input, &partial)) {
+      Advance(T(partial));
+    }
+  }
+
   /**
    * Merge a partial min aggregate into this aggregate.
    */
@@ -367,6 +481,70 @@ class AvgAggregate {
   uint64_t count_{0};
 };
 
+/**
+ * Average of decimals. Unlike AvgAggregate, the average is exact: the sum is accumulated in 128 bits and the average
+ * has the scale of its inputs, rounded half away from zero.
+ */
+class DecimalAvgAggregate {
+ public:
+  /**
+   * Constructor.
+   */
+  DecimalAvgAggregate() = default;
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(DecimalAvgAggregate);
+
+  /**
+   * Advance the aggregate by the input value @em val.
+   */
+  void Advance(const DecimalVal &val) {
+    if (val.is_null_) {
+      return;
+    }
+    sum_ += static_cast<int64_t>(val.val_);
+    count_++;
+  }
+
+  /**
+   * Merge a partial average aggregate into this aggregate.
+   */
+  void Merge(const DecimalAvgAggregate &that) {
+    sum_ += that.sum_;
+    count_ += that.count_;
+  }
+
+  /**
+   * Reset the aggregate.
+   */
+  void Reset() {
+    sum_ = 0;
+    count_ = 0;
+  }
+
+  /**
+   * Return the result of the average.
+   */
+  DecimalVal GetResultAvg() const {
+    if (count_ == 0) {
+      return DecimalVal::Null();
+    }
+    const auto count = static_cast<int128_t>(count_);
+    const int128_t quotient = sum_ / count;
+    const int128_t remainder = sum_ % count;
+    const int128_t magnitude = remainder < 0 ? -remainder : remainder;
+    const bool round_away = magnitude >= count - magnitude;
+    // The average of decimals lies between the smallest and the largest of them, so it always fits
+    return DecimalVal(static_cast<int64_t>(quotient + (round_away ? (sum_ < 0 ? -1 : 1) : 0)));
+  }
+
+ private:
+  int128_t sum_{0};
+  uint64_t count_{0};
+};
+
 /** Top K Aggregate */
 template <typename T>
 class TopKAggregate {
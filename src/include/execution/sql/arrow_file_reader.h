@@ -0,0 +1,185 @@
+#pragma once
+
+#include <tbb/parallel_for.h>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/macros.h"
+#include "execution/exec/execution_context.h"
+#include "execution/exec/task_scheduler.h"
+#include "execution/sql/sql.h"
+#include "execution/sql/vector_projection.h"
+#include "storage/storage_defs.h"
+
+namespace org::apache::arrow::flatbuf {
+struct DictionaryBatch;
+struct RecordBatch;
+struct Schema;
+}  // namespace org::apache::arrow::flatbuf
+
+namespace noisepage::execution::sql {
+
+/**
+ * Reads Arrow IPC streams, as written by storage::ArrowSerializer, into vector projections. The file is mapped into
+ * memory when it is opened, and only the metadata of its messages is parsed then. A read decodes only the columns it
+ * projects, a vector of rows at a time, and references strings in the mapped file rather than copying them. Every
+ * record batch is read independently of the others, which makes it a morsel of a parallel scan.
+ *
+ * Columns of dictionary-encoded strings keep their encoding in the vectors they are read into, so that operations
+ * on them can work on the dictionary.
+ */
+class ArrowFileReader {
+ public:
+  /**
+   * Open the Arrow IPC stream in the file at the given path and parse its metadata.
+   * @param path The path of the file.
+   * @throw ExecutionException if the file can't be read, or isn't a stream of a supported schema.
+   */
+  explicit ArrowFileReader(const std::string &path);
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(ArrowFileReader);
+
+  /**
+   * Unmap the file.
+   */
+  ~ArrowFileReader();
+
+  /**
+   * @return The number of columns in the file.
+   */
+  uint32_t GetColumnCount() const { return columns_.size(); }
+
+  /**
+   * @return The SQL type of the column at index @em col_idx.
+   */
+  TypeId GetColumnType(const uint32_t col_idx) const {
+    NOISEPAGE_ASSERT(col_idx < GetColumnCount(), "Out-of-bounds column access");
+    return columns_[col_idx].type_;
+  }
+
+  /**
+   * @return The number of record batches in the file.
+   */
+  uint32_t GetBatchCount() const { return batches_.size(); }
+
+  /**
+   * @return The number of rows in the record batch at index @em batch_idx.
+   */
+  uint64_t GetBatchRowCount(const uint32_t batch_idx) const {
+    NOISEPAGE_ASSERT(batch_idx < GetBatchCount(), "Out-of-bounds batch access");
+    return batches_[batch_idx].num_rows_;
+  }
+
+  /**
+   * @return The number of rows in all record batches of the file.
+   */
+  uint64_t GetRowCount() const;
+
+  /**
+   * Read rows of a record batch into a vector projection, as many as fit into one vector.
+   * @param batch_idx The index of the record batch to read.
+   * @param row_offset The index of the first row to read within the record batch.
+   * @param col_idxs The indexes of the columns to read.
+   * @param[out] vector_projection The projection to read into. It must own its data and have been initialized with the
+   *                               types of the columns in @em col_idxs, in that order.
+   * @return The number of rows read, which is zero once @em row_offset is past the end of the batch.
+   */
+  uint32_t ReadBatch(uint32_t batch_idx, uint64_t row_offset, const std::vector<uint32_t> &col_idxs,
+                     VectorProjection *vector_projection) const;
+
+  /**
+   * Scan all record batches of the file in parallel, every batch as one morsel. Every morsel reads its batch into its
+   * own vector projection, a vector at a time, and calls @em f with the projection after every read.
+   * @tparam F A function taking a VectorProjection pointer. It is called concurrently from many threads.
+   * @param exec_ctx The context of the query the scan belongs to.
+   * @param col_idxs The indexes of the columns to read.
+   * @param f The function to call with every vector of rows read.
+   */
+  template <typename F>
+  void ParallelScan(exec::ExecutionContext *exec_ctx, const std::vector<uint32_t> &col_idxs, F &&f) const {
+    std::vector<TypeId> col_types;
+    for (const auto col_idx : col_idxs) col_types.push_back(GetColumnType(col_idx));
+    exec::TaskScheduler::Execute(exec_ctx, GetBatchCount(), [&] {
+      tbb::parallel_for(uint32_t{0}, GetBatchCount(), [&](const uint32_t batch_idx) {
+        VectorProjection vector_projection;
+        vector_projection.Initialize(col_types);
+        uint64_t row_offset = 0;
+        for (uint32_t n; (n = ReadBatch(batch_idx, row_offset, col_idxs, &vector_projection)) > 0; row_offset += n) {
+          f(&vector_projection);
+        }
+      });
+    });
+  }
+
+ private:
+  // A column of the file
+  struct Column {
+    // The SQL type of the column
+    TypeId type_;
+    // The width of a value in bytes, for columns of fixed-length values
+    uint32_t byte_width_;
+    // The id of the dictionary of a dictionary-encoded column, or -1
+    int64_t dictionary_id_;
+  };
+
+  // The decoded entries of a dictionary, which reference the dictionary message in the file
+  using Dictionary = std::vector<storage::VarlenEntry>;
+
+  // A column of a record batch
+  struct BatchColumn {
+    // The validity bitmap, or nullptr if no value is NULL
+    const byte *validity_;
+    // The values of fixed-length columns, the offsets of strings, or the dictionary codes
+    const byte *data_;
+    // The bytes of the strings of string columns
+    const byte *strings_;
+    // The dictionary the codes refer to, for dictionary-encoded columns
+    const Dictionary *dictionary_;
+  };
+
+  // A record batch
+  struct Batch {
+    uint64_t num_rows_;
+    std::vector<BatchColumn> columns_;
+  };
+
+  // Parse the messages of the stream
+  void ParseStream();
+
+  // Parse the schema message
+  void ParseSchema(const org::apache::arrow::flatbuf::Schema *schema);
+
+  // Parse a record batch message with the given body
+  void ParseRecordBatch(const org::apache::arrow::flatbuf::RecordBatch *record_batch, const byte *body);
+
+  // Parse a dictionary batch message with the given body
+  void ParseDictionaryBatch(const org::apache::arrow::flatbuf::DictionaryBatch *dictionary_batch, const byte *body);
+
+  // Read the values of a column at the given rows of a batch into a vector
+  void ReadColumn(const Column &column, const BatchColumn &batch_column, uint64_t row_offset, uint32_t num_rows,
+                  Vector *vector) const;
+
+ private:
+  // The path of the file, for error messages
+  std::string path_;
+  // The mapped file
+  byte *data_{nullptr};
+  std::size_t size_{0};
+  // The columns of the file
+  std::vector<Column> columns_;
+  // The record batches of the file
+  std::vector<Batch> batches_;
+  // Every dictionary ever sent. A dictionary batch replaces the dictionary with its id for the record batches after
+  // it, but record batches before it keep referring to the old one.
+  std::vector<std::unique_ptr<Dictionary>> dictionaries_;
+  // The latest dictionary with each id
+  std::unordered_map<int64_t, const Dictionary *> current_dictionaries_;
+};
+
+}  // namespace noisepage::execution::sql
@@ -10,6 +10,9 @@
 
 namespace noisepage::execution::sql {
 
+class TupleIdList;
+class Vector;
+
 /**
  * A SIMD-optimized blocked bloom filter. The filter is composed of a contiguous set of partitions,
  * known as blocks. A block is 64-bytes, and thus, fits within a cache line (in most systems). A
@@ -80,6 +83,14 @@ class BloomFilter {
    */
   bool Contains(hash_t hash) const;
 
+  /**
+   * Check a vector of hash values against the filter, removing the TIDs of all elements that are
+   * definitely not in the filter from @em tid_list.
+   * @param hashes The hash values to check.
+   * @param tid_list The list of TIDs to check, and the TIDs of elements that may be in the filter.
+   */
+  void ContainsBatch(const Vector &hashes, TupleIdList *tid_list) const;
+
   /**
    * @return The size of the filter in bytes.
    */
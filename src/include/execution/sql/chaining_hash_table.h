@@ -44,7 +44,7 @@ namespace noisepage::execution::sql {
  *         linked list bucket chain.
  */
 class ChainingHashTableBase {
- private:
+ protected:
   /** X86_64 has 48-bit VM address space, leaving 16 for us to re-purpose. */
   static constexpr uint32_t NUM_TAG_BITS = 16;
   /** The number of bits to use for the physical pointer. */
@@ -310,6 +310,18 @@ class ChainingHashTable : public ChainingHashTableBase {
   template <bool Concurrent, typename Allocator>
   void InsertBatch(util::ChunkedVector<Allocator> *entries);
 
+  /**
+   * Insert the given array of entries into this hash table. All entries must have their hash values
+   * already computed. Unlike the vector overload, this does not prefetch: callers pass batches whose
+   * buckets fall into a cache-resident slice of the directory.
+   * @pre All hash values must have been computed already.
+   * @tparam Concurrent Is the insert occurring concurrently with other inserts.
+   * @param entries The entries to insert.
+   * @param num_entries The number of entries to insert.
+   */
+  template <bool Concurrent>
+  void InsertBatch(HashTableEntry *const *entries, uint64_t num_entries);
+
   /**
    * Return the head of the bucket chain for a key with the provided hash value. Probing assumes no
    * concurrent modifications to the hash table. Thus, is suitable for WORM based workloads.
@@ -318,6 +330,17 @@ class ChainingHashTable : public ChainingHashTableBase {
    */
   HashTableEntry *FindChainHead(hash_t hash) const;
 
+  /**
+   * Find the heads of the bucket chains for a batch of hash values. Chain heads are gathered from
+   * the directory with SIMD, tags are checked in-register, and when the directory exceeds the L3
+   * the buckets of upcoming groups are prefetched. Like FindChainHead(), this assumes no concurrent
+   * modifications to the hash table.
+   * @param hashes The hash values of the keys to find.
+   * @param[out] results Where the (potentially null) chain head of each hash is written.
+   * @param num_elems The number of hash values.
+   */
+  void FindChainHeadBatch(const hash_t *hashes, const HashTableEntry **results, uint64_t num_elems) const;
+
   /**
    * Empty all entries in this hash table into the sink functor. After this function exits, the hash
    * table is empty.
@@ -327,6 +350,17 @@ class ChainingHashTable : public ChainingHashTableBase {
   template <typename F>
   void FlushEntries(F &&sink);
 
+  /**
+   * Visit all entries in the buckets [begin_bucket, end_bucket) of the directory, in bucket order.
+   * Assumes no concurrent modifications to the hash table.
+   * @tparam F The function must be of the form void(*)(uint64_t bucket, const HashTableEntry*)
+   * @param begin_bucket The first bucket to visit.
+   * @param end_bucket The bucket after the last one to visit.
+   * @param visitor The function called with each entry and the bucket it is in.
+   */
+  template <typename F>
+  void ForEachEntry(uint64_t begin_bucket, uint64_t end_bucket, F &&visitor) const;
+
   /**
    * @return Collect and return a tuple containing the minimum, maximum, and average bucket
    * chain in this hash table. This is not a concurrent operation!
@@ -351,6 +385,10 @@ class ChainingHashTable : public ChainingHashTableBase {
   template <bool Prefetch, bool Concurrent, typename Allocator>
   void InsertBatchInternal(util::ChunkedVector<Allocator> *entries);
 
+  // Batched chain-head lookup with configurable pre-fetching.
+  template <bool Prefetch>
+  void FindChainHeadBatchInternal(const hash_t *hashes, const HashTableEntry **results, uint64_t num_elems) const;
+
  private:
   // The current number of elements stored in the table.
   std::atomic<uint64_t> num_elements_;
@@ -404,6 +442,22 @@ inline void ChainingHashTable<UseTags>::InsertBatch(util::ChunkedVector<Allocato
   AddElementCount(entries->size());
 }
 
+template <bool UseTags>
+template <bool Concurrent>
+inline void ChainingHashTable<UseTags>::InsertBatch(HashTableEntry *const *entries, const uint64_t num_entries) {
+  for (uint64_t idx = 0; idx < num_entries; idx++) {
+    HashTableEntry *entry = entries[idx];
+    if constexpr (UseTags) {  // NOLINT
+      InsertTagged<Concurrent>(entry, entry->hash_);
+    } else {
+      InsertUntagged<Concurrent>(entry, entry->hash_);
+    }
+  }
+
+  // Update element count.
+  AddElementCount(num_entries);
+}
+
 template <bool UseTags>
 inline HashTableEntry *ChainingHashTable<UseTags>::FindChainHead(hash_t hash) const {
   if constexpr (UseTags) {  // NOLINT
@@ -437,6 +491,26 @@ inline void ChainingHashTable<UseTags>::FlushEntries(F &&sink) {
   num_elements_ = 0;
 }
 
+template <bool UseTags>
+template <typename F>
+inline void ChainingHashTable<UseTags>::ForEachEntry(const uint64_t begin_bucket, const uint64_t end_bucket,
+                                                     F &&visitor) const {
+  static_assert(std::is_invocable_v<F, uint64_t, const HashTableEntry *>);
+  NOISEPAGE_ASSERT(end_bucket <= capacity_, "Bucket range exceeds capacity!");
+
+  for (uint64_t idx = begin_bucket; idx < end_bucket; idx++) {
+    const HashTableEntry *entry = entries_[idx];
+
+    if constexpr (UseTags) {  // NOLINT
+      entry = UntagPointer(entry);
+    }
+
+    for (; entry != nullptr; entry = entry->next_) {
+      visitor(idx, entry);
+    }
+  }
+}
+
 // Useful aliases.
 using TaggedChainingHashTable = ChainingHashTable<true>;
 using UntaggedChainingHashTable = ChainingHashTable<false>;
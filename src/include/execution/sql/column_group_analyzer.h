@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "execution/util/execution_common.h"
+#include "execution/sql/value.h"
+
+namespace noisepage::catalog {
+class CatalogAccessor;
+}  // namespace noisepage::catalog
+
+namespace noisepage::execution::exec {
+class ExecutionContext;
+}  // namespace noisepage::execution::exec
+
+namespace noisepage::execution::sql {
+
+/**
+ * Computes the statistics of the groups of columns of a table for ANALYZE, @see optimizer::ColumnGroupStats. The
+ * groups are the keys of the multi-column indexes of the table, which are the columns that queries filter and join on
+ * together. The statistics are computed over a scan of the group columns of their own, which samples as many blocks
+ * as the scan of ANALYZE.
+ */
+class EXPORT ColumnGroupAnalyzer {
+ public:
+  /** Precision of the HyperLogLogs that count the distinct combinations of values. */
+  static constexpr int HLL_PRECISION = 14;
+
+  /**
+   * @param accessor catalog accessor of the query
+   * @param table_oid table whose indexes are looked at
+   * @return the groups of columns of the table that get statistics of their own, in the order of the index keys
+   */
+  static std::vector<std::vector<catalog::col_oid_t>> GetColumnGroups(catalog::CatalogAccessor *accessor,
+                                                                      catalog::table_oid_t table_oid);
+
+  /**
+   * Compute the statistics of the column groups that start with a column. They are stored in the row of pg_statistic
+   * of that column, so that they are refreshed together with its statistics.
+   * @param exec_ctx execution context of ANALYZE
+   * @param table_oid table to analyze
+   * @param col_oid first column of the groups
+   * @return the serialized statistics of the groups, NULL if the column does not start a group
+   */
+  static StringVal Analyze(exec::ExecutionContext *exec_ctx, catalog::table_oid_t table_oid,
+                           catalog::col_oid_t col_oid);
+};
+
+}  // namespace noisepage::execution::sql
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <map>
 #include <memory>
 #include <random>
 #include <utility>
@@ -7,6 +8,7 @@
 
 #include "common/macros.h"
 #include "common/managed_pointer.h"
+#include "common/spin_latch.h"
 #include "execution/sql/tuple_id_list.h"
 
 namespace noisepage::execution::exec {
@@ -16,6 +18,7 @@ class ExecutionSettings;
 
 namespace noisepage::execution::sql {
 
+class FilterOrderCache;
 class VectorProjection;
 class VectorProjectionIterator;
 
@@ -99,10 +102,26 @@ class FilterManager {
      */
     double GetOverheadMicros() const { return overhead_micros_; }
 
+    /**
+     * Start from the term order that an earlier execution learned, if the cache has one for this clause. The clause
+     * then samples less often, until the sampled selectivities drift from the learned ones.
+     * @param order_cache The cache of learned orders.
+     */
+    void RestoreOrder(const FilterOrderCache &order_cache);
+
+    /**
+     * Save the term order learned by this clause, if it sampled its terms at all.
+     * @param order_cache The cache of learned orders.
+     */
+    void SaveOrder(FilterOrderCache *order_cache) const;
+
    private:
     // Indicates if statistics for all terms should be recollected.
     bool ShouldReRank();
 
+    // The term functions, in insertion order.
+    std::vector<MatchFn> GetTermFunctions() const;
+
     // A term in the clause.
     struct Term {
       // The index of the term when it was inserted into the clause.
@@ -111,8 +130,11 @@ class FilterManager {
       const MatchFn fn_;
       // The current rank.
       double rank_;
+      // The fraction of its input that passed the term when it was last sampled.
+      double selectivity_;
       // Create a new term with no rank.
-      Term(uint32_t insertion_index, MatchFn term_fn) : insertion_index_(insertion_index), fn_(term_fn), rank_(0.0) {}
+      Term(uint32_t insertion_index, MatchFn term_fn)
+          : insertion_index_(insertion_index), fn_(term_fn), rank_(0.0), selectivity_(1.0) {}
     };
 
    private:
@@ -125,6 +147,10 @@ class FilterManager {
     TupleIdList temp_;
     // Frequency at which to sample stats, a number in the range [0.0, 1.0].
     double sample_freq_;
+    // The frequency the clause was created with. sample_freq_ is lowered from it while a learned order holds.
+    double full_sample_freq_;
+    // The selectivities of the learned order by insertion index, empty if no order was learned or it drifted.
+    std::vector<double> learned_selectivities_;
     // The number of times samples have been collected.
     uint32_t sample_count_;
     double overhead_micros_;
@@ -135,8 +161,19 @@ class FilterManager {
 
   /**
    * Construct an empty filter.
+   * @param exec_settings The execution settings to run with.
+   * @param adapt True if the filter should reorder its terms as it learns their costs and selectivities.
+   * @param context The opaque context handed to the terms.
+   * @param order_cache If not null, the orders learned by earlier executions of the query, which an adaptive filter
+   *                    starts from and updates when it is destroyed.
    */
-  explicit FilterManager(const exec::ExecutionSettings &exec_settings, bool adapt = true, void *context = nullptr);
+  explicit FilterManager(const exec::ExecutionSettings &exec_settings, bool adapt = true, void *context = nullptr,
+                         common::ManagedPointer<FilterOrderCache> order_cache = nullptr);
+
+  /**
+   * Destructor. Saves the orders learned by the clauses in the order cache.
+   */
+  ~FilterManager();
 
   /**
    * This class cannot be copied or moved.
@@ -215,6 +252,10 @@ class FilterManager {
   bool adapt_;
   // An injected context object.
   void *opaque_context_;
+  // The orders learned by earlier executions, nullptr if they are not kept.
+  common::ManagedPointer<FilterOrderCache> order_cache_;
+  // Whether the clauses started from the learned orders, which happens once they are all built.
+  bool orders_restored_;
   // The clauses in the filter.
   std::vector<std::unique_ptr<Clause>> clauses_;
   // The input and output TID lists, and a temporary list. These are used during
@@ -224,4 +265,43 @@ class FilterManager {
   TupleIdList tmp_list_;
 };
 
+/**
+ * The term orders that the filters of a query learned, kept by the query across its executions so that every execution
+ * starts from the order the previous ones converged to. A clause is identified by its term functions, which are the
+ * same in every execution of the same compiled query. Filters running in parallel share the cache.
+ */
+class FilterOrderCache {
+ public:
+  /**
+   * What a clause learned about its terms, indexed by the order in which the terms were inserted.
+   */
+  struct LearnedOrder {
+    /** The rank of every term. */
+    std::vector<double> ranks_;
+    /** The fraction of its input that passed every term. */
+    std::vector<double> selectivities_;
+  };
+
+  /**
+   * Find the order learned for a clause.
+   * @param terms The term functions of the clause, in insertion order.
+   * @param[out] order The learned order, if there is one.
+   * @return True if an order was learned for the clause; false otherwise.
+   */
+  bool Lookup(const std::vector<FilterManager::MatchFn> &terms, LearnedOrder *order) const;
+
+  /**
+   * Save the order learned for a clause, replacing the one saved before.
+   * @param terms The term functions of the clause, in insertion order.
+   * @param order The learned order.
+   */
+  void Save(const std::vector<FilterManager::MatchFn> &terms, LearnedOrder order);
+
+ private:
+  static std::vector<uintptr_t> MakeKey(const std::vector<FilterManager::MatchFn> &terms);
+
+  mutable common::SpinLatch latch_;
+  std::map<std::vector<uintptr_t>, LearnedOrder> orders_;
+};
+
 }  // namespace noisepage::execution::sql
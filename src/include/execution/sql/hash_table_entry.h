@@ -50,8 +50,10 @@ struct HashTableEntry {
 };
 
 /**
- * An iterator over a chain of hash table entries that match a provided initial hash value.
- * This iterator cannot resolve hash collisions, it is the responsibility of the user to do so.
+ * An iterator over a chain of hash table entries that match a provided initial hash value, or over
+ * a contiguous range of payloads of a table stored without entry headers. The latter produces every
+ * payload in the bucket of the hash value. This iterator cannot resolve hash collisions, it is the
+ * responsibility of the user to do so.
  * Use as follows:
  *
  * @code
@@ -73,13 +75,27 @@ struct HashTableEntryIterator {
    * @param initial The first matching entry in the chain of entries
    * @param hash The hash value of the probe tuple
    */
-  HashTableEntryIterator(const HashTableEntry *initial, hash_t hash) : next_(initial), hash_(hash) {}
+  HashTableEntryIterator(const HashTableEntry *initial, hash_t hash)
+      : next_(initial), hash_(hash), payload_end_(nullptr), payload_size_(0) {}
+
+  /**
+   * Construct an iterator over the payloads in [begin, end), stored back to back. This iterator is
+   * returned from JoinHashTable::Lookup() for tables using the compact layout.
+   * @param begin The first payload.
+   * @param end The end of the last payload.
+   * @param payload_size The size of each payload, in bytes. Must be non-zero.
+   */
+  HashTableEntryIterator(const byte *begin, const byte *end, uint32_t payload_size)
+      : next_payload_(begin), hash_(0), payload_end_(end), payload_size_(payload_size) {}
 
   /**
    * Advance to the next match and return true if it is found.
    * @return True if there is at least one more potential match.
    */
   bool HasNext() {
+    if (payload_size_ != 0) {
+      return next_payload_ != payload_end_;
+    }
     while (next_ != nullptr) {
       if (next_->hash_ == hash_) {
         return true;
@@ -89,22 +105,38 @@ struct HashTableEntryIterator {
     return false;
   }
 
-  /** @return The next match. */
+  /** @return The next match. Not available when iterating over payloads. */
   const HashTableEntry *GetMatch() {
+    NOISEPAGE_ASSERT(payload_size_ == 0, "Payloads stored without entry headers have no entry");
     const HashTableEntry *result = next_;
     next_ = next_->next_;
     return result;
   }
 
   /** @return The payload of the next matched entry. */
-  const byte *GetMatchPayload() { return GetMatch()->PayloadAs<byte>(); }
+  const byte *GetMatchPayload() {
+    if (payload_size_ != 0) {
+      const byte *result = next_payload_;
+      next_payload_ += payload_size_;
+      return result;
+    }
+    return GetMatch()->PayloadAs<byte>();
+  }
 
  private:
-  // The next element the iterator produces.
-  const HashTableEntry *next_;
+  union {
+    // The next element the iterator produces.
+    const HashTableEntry *next_;
+    // The next payload the iterator produces, when iterating over payloads.
+    const byte *next_payload_;
+  };
 
   // The hash value we're looking up. Used as a cheap pre-filter in key-equality checks.
   hash_t hash_;
+
+  // The end of the payloads and their size, or zero when iterating over a chain of entries.
+  const byte *payload_end_;
+  uint32_t payload_size_;
 };
 
 }  // namespace noisepage::execution::sql
@@ -18,6 +18,13 @@ namespace noisepage::execution::sql {
  */
 class EXPORT IndexIterator {
  public:
+  /** Used to denote the offsets into ExecutionContext::hooks_ of particular functions */
+  enum class HookOffsets : uint32_t {
+    EndHook = 0,
+
+    NUM_HOOKS
+  };
+
   /**
    * Constructor
    * @param exec_ctx execution containing of this query
@@ -100,7 +107,38 @@ class EXPORT IndexIterator {
    */
   uint32_t GetIndexSize() const { return index_->GetSize(); }
 
+  /**
+   * Scan function callback used to scan a partition of an index range.
+   * Convention: First argument is the opaque query state (that must contain execCtx as a member),
+   *             second argument is the thread state,
+   *             third argument is the index iterator positioned before the first tuple of the partition.
+   *             The first two arguments are void because their types are only known at runtime
+   *             (i.e., defined in generated code).
+   */
+  using ScanFn = void (*)(void *, void *, IndexIterator *iter);
+
+  /**
+   * Perform a parallel ascending scan over the range between the low and high keys of @em iter. The index splits the
+   * range into partitions, and the callback function @em scan_fn is invoked on each partition, possibly on different
+   * threads, in an order that is non-deterministic. An index that cannot split the range is scanned on the calling
+   * thread as a whole.
+   * @param iter The iterator whose keys bound the range. Its own results are only used when the range is not split.
+   * @param scan_type The type of the ascending scan.
+   * @param query_state An opaque pointer to some query-specific state. Passed to scan functions.
+   * @param scan_fn The callback function invoked for each partition of the range.
+   */
+  static void ParallelScan(IndexIterator *iter, storage::index::ScanType scan_type, void *query_state,
+                           ScanFn scan_fn);
+
  private:
+  // Number of partitions that the range of a parallel scan is split into per thread, so that threads that finish early
+  // pick up the work of the others
+  static constexpr uint32_t PARTITIONS_PER_THREAD = 4;
+
+  // Iterator over the same table columns and index as another one, for a partition of a parallel scan
+  IndexIterator(exec::ExecutionContext *exec_ctx, uint32_t num_attrs, std::vector<catalog::col_oid_t> col_oids,
+                common::ManagedPointer<storage::index::Index> index, common::ManagedPointer<storage::SqlTable> table);
+
   exec::ExecutionContext *exec_ctx_;
   uint32_t num_attrs_;
   std::vector<catalog::col_oid_t> col_oids_;
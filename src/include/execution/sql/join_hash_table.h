@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "common/macros.h"
@@ -23,6 +24,7 @@ class ExecutionContext;
 
 namespace noisepage::execution::sql {
 
+class SpillFile;
 class ThreadStateContainer;
 class Vector;
 
@@ -46,6 +48,21 @@ class Vector;
  * In parallel mode, thread-local join hash tables are lazily built and merged in parallel into a
  * global join hash table through a call to JoinHashTable::MergeParallel(). After this call, the
  * global table takes ownership of all thread-local allocated memory and hash index.
+ *
+ * If spilling is enabled through JoinHashTable::EnableSpilling() and the build side is larger than
+ * the join memory budget, the table becomes a hybrid hash join. Build tuples are radix-partitioned
+ * on the top bits of their hash, and the highest partitions are written to disk until the rest fits
+ * into the budget. Only the resident partitions are indexed. Probe tuples that fall into a spilled
+ * partition (see JoinHashTable::IsSpilled()) are handed to JoinHashTable::SpillProbeTuple(), and are
+ * joined one partition at a time by JoinHashTable::ProcessSpilledPartitions() once the probe side is
+ * exhausted.
+ *
+ * If the compact layout is enabled through JoinHashTable::EnableCompactLayout(), the built chaining
+ * table is rewritten once: tuples are copied out of their entries into one array, grouped by bucket,
+ * and the directory only keeps where each bucket's tuples begin and the tags of their hashes. The
+ * 16 bytes of chain pointer and hash value stored in front of every tuple are dropped, half the
+ * memory of a build side of 16-byte tuples, and the walk of a bucket chain becomes a scan of
+ * adjacent tuples.
  */
 class EXPORT JoinHashTable {
  public:
@@ -63,6 +80,36 @@ class EXPORT JoinHashTable {
   /** Minimum number of expected elements to merge before triggering a parallel merge. */
   static constexpr uint32_t DEFAULT_MIN_SIZE_FOR_PARALLEL_MERGE = 1024;
 
+  /** Largest number of radix bits a parallel build partitions the thread-local tuples on. */
+  static constexpr uint32_t MAX_BUILD_PARTITION_BITS = 10;
+
+  /** Number of radix bits build and probe tuples are partitioned on when the table spills. */
+  static constexpr uint32_t NUM_SPILL_PARTITION_BITS = 6;
+
+  /** Number of radix partitions build and probe tuples are split into when the table spills. */
+  static constexpr uint32_t NUM_SPILL_PARTITIONS = 1u << NUM_SPILL_PARTITION_BITS;
+
+  /** Number of bytes of a spilled partition that are buffered in memory before they are written out. */
+  static constexpr uint32_t SPILL_BUFFER_SIZE = 64 * 1024;
+
+  /** Number of spilled tuples that are read back at a time. */
+  static constexpr uint32_t SPILL_READ_BATCH_SIZE = 1024;
+
+  /** Number of low bits of a compact directory word that hold the index of the bucket's first tuple. */
+  static constexpr uint32_t COMPACT_INDEX_BITS = 48;
+
+  /** Mask of the tuple index in a compact directory word. The remaining high bits are hash tags. */
+  static constexpr uint64_t COMPACT_INDEX_MASK = (uint64_t{1} << COMPACT_INDEX_BITS) - 1;
+
+  /** Number of buckets of the compact directory that are laid out by one task. */
+  static constexpr uint64_t COMPACT_BUCKETS_PER_TASK = 16 * 1024;
+
+  /**
+   * Function called with the query state, the pipeline state and a spilled probe tuple once the build
+   * side of the tuple's partition has been loaded into the table.
+   */
+  using SpilledProbeFn = void (*)(void *, void *, const byte *);
+
   /**
    * Construct a join hash table. All memory allocations are sourced from the injected @em memory,
    * and thus, are ephemeral.
@@ -126,17 +173,81 @@ class EXPORT JoinHashTable {
    */
   void MergeParallel(ThreadStateContainer *thread_state_container, std::size_t jht_offset);
 
+  /**
+   * Allow the table to spill partitions of the build side to disk when it is built, if the join
+   * memory budget in the execution settings is set. Tables using a concise hash table never spill.
+   * @pre The table must not have been built yet.
+   * @param probe_tuple_size The size of the probe tuples that are handed to SpillProbeTuple().
+   */
+  void EnableSpilling(uint32_t probe_tuple_size);
+
+  /**
+   * Build a bloom filter over the hash values of all build tuples when the table is built, so that
+   * the probe side can discard tuples without a join partner before probing, through MayContain().
+   * @pre The table must not have been built yet.
+   */
+  void EnableRuntimeFilter();
+
+  /**
+   * Store the tuples grouped by bucket, without their entry headers, once the table is built, if
+   * the compact layout is enabled in the execution settings. Tables using a concise hash table, and
+   * tables that spill, keep their entries.
+   * @pre The table must not have been built yet. It must only be probed through Lookup() and read
+   *      through a JoinHashTableIterator, since LookupBatch() hands out entries.
+   */
+  void EnableCompactLayout();
+
+  /**
+   * @return False if no build tuple has the hash value @em hash; true if one may have it, or if
+   *         the table has no bloom filter.
+   */
+  bool MayContain(const hash_t hash) const { return !HasBloomFilter() || bloom_filter_.Contains(hash); }
+
+  /**
+   * @return True if the partition that a probe tuple with hash value @em hash falls into was spilled
+   *         when the table was built. Such tuples must be passed to SpillProbeTuple() rather than
+   *         looked up in the table.
+   */
+  bool IsSpilled(const hash_t hash) const noexcept {
+    return (spilled_partitions_ & (uint64_t{1} << SpillPartitionOf(hash))) != 0;
+  }
+
+  /**
+   * Set a probe tuple aside until its partition is joined. Tuples that the bloom filter over the
+   * whole build side rules out are dropped right away. This function is thread-safe.
+   * @pre IsSpilled(hash) must be true.
+   * @param hash The hash value of the probe tuple.
+   * @param probe_tuple The probe tuple, of the size given to EnableSpilling().
+   */
+  void SpillProbeTuple(hash_t hash, const byte *probe_tuple);
+
+  /**
+   * Join the spilled partitions, one at a time. The build side of each partition is read back and
+   * indexed in place of the resident partitions, and @em probe_fn is called on each of the spilled
+   * probe tuples of the partition. The function looks them up in this table as usual. Once this
+   * returns, all spilled data has been released and nothing is reported as spilled anymore.
+   * @param query_state The query state passed to @em probe_fn.
+   * @param pipeline_state The pipeline state passed to @em probe_fn.
+   * @param probe_fn The function probing the table with a spilled probe tuple.
+   */
+  void ProcessSpilledPartitions(void *query_state, void *pipeline_state, SpilledProbeFn probe_fn);
+
   /**
    * @return The total number of bytes used to materialize tuples. This excludes space required for
    *         the join index.
    */
-  uint64_t GetBufferedTupleMemoryUsage() const { return entries_.size() * entries_.ElementSize(); }
+  uint64_t GetBufferedTupleMemoryUsage() const {
+    return UsingCompactLayout() ? GetTupleCount() * tuple_size_ : entries_.size() * entries_.ElementSize();
+  }
 
   /**
    * @return The total number of bytes used by the join index only. The join index (also referred to
    *         as the hash table directory), excludes storage for materialized tuple contents.
    */
   uint64_t GetJoinIndexMemoryUsage() const {
+    if (UsingCompactLayout()) {
+      return sizeof(uint64_t) * (compact_mask_ + 2);
+    }
     return UsingConciseHashTable() ? concise_hash_table_.GetTotalMemoryUsage()
                                    : chaining_hash_table_.GetTotalMemoryUsage();
   }
@@ -159,6 +270,11 @@ class EXPORT JoinHashTable {
    * @return The total number of elements in the table, including duplicates.
    */
   uint64_t GetTupleCount() const {
+    // The word past the last bucket of the compact directory holds the count
+    if (UsingCompactLayout()) {
+      return compact_directory_[compact_mask_ + 1] & COMPACT_INDEX_MASK;
+    }
+
     // We don't know if this hash table was built in parallel. To be safe, we
     // acquire the lock before checking the owned entries vector. This isn't a
     // performance critical function, so locking should be okay ...
@@ -184,6 +300,16 @@ class EXPORT JoinHashTable {
    */
   bool UsingConciseHashTable() const { return use_concise_ht_; }
 
+  /**
+   * @return True if the tuples are stored grouped by bucket, without entry headers.
+   */
+  bool UsingCompactLayout() const { return compact_directory_ != nullptr; }
+
+  /**
+   * @return True if partitions of the build side were spilled to disk and have not been processed yet.
+   */
+  bool HasSpilledPartitions() const { return spilled_partitions_ != 0; }
+
   /**
    * @return The underlying bloom filter.
    */
@@ -194,6 +320,25 @@ class EXPORT JoinHashTable {
   FRIEND_TEST(JoinHashTableTest, LazyInsertionTest);
   FRIEND_TEST(JoinHashTableTest, PerfTest);
 
+  // A spilled radix partition of the build or probe side. Tuples are gathered
+  // in the buffer and appended to the spill file in runs of (offset, size).
+  struct SpilledPartition {
+    common::SpinLatch latch_;
+    std::vector<byte> buffer_;
+    std::vector<std::pair<uint64_t, uint64_t>> runs_;
+  };
+
+  // The radix partition of a hash value, taken from its top bits.
+  static uint32_t SpillPartitionOf(const hash_t hash) noexcept {
+    return static_cast<uint32_t>(hash >> (sizeof(hash_t) * 8 - NUM_SPILL_PARTITION_BITS));
+  }
+
+  // The tag bit a hash value sets in the compact directory word of its bucket.
+  // It is picked by the top bits of the hash, as in the chaining table.
+  static uint64_t CompactTag(const hash_t hash) noexcept {
+    return uint64_t{1} << (COMPACT_INDEX_BITS + (hash >> (sizeof(hash_t) * 8 - 4)));
+  }
+
   // Access a stored entry by index
   HashTableEntry *EntryAt(const uint64_t idx) { return reinterpret_cast<HashTableEntry *>(entries_[idx]); }
 
@@ -225,6 +370,38 @@ class EXPORT JoinHashTable {
   template <bool Concurrent>
   void MergeIncomplete(JoinHashTable *source);
 
+  // The number of radix bits a parallel merge into the sized chaining table
+  // should partition on, or 0 if it should insert from all threads at once.
+  uint32_t ComputeBuildPartitionBits() const;
+
+  // Merge the thread-local tables by partitioning their entries on the top
+  // 'radix_bits' bits of their bucket index, then building each partition's
+  // slice of the directory independently.
+  void MergeRadixPartitioned(ThreadStateContainer *thread_state_container,
+                             const std::vector<JoinHashTable *> &tl_join_tables, uint32_t radix_bits);
+
+  // If spilling is enabled and the given build tuples exceed the memory
+  // budget, build the bloom filter over all of them, spill the highest radix
+  // partitions until the rest fits, and move the rest into 'entries_'. The
+  // sources are emptied. Returns true if anything was spilled.
+  bool SpillIfOverMemoryBudget(const std::vector<util::ChunkedVector<MemoryPoolAllocator<byte>> *> &sources);
+
+  // Build the runtime filter over the hash values of all tuples in the given
+  // sources, if it was enabled and spilling did not already build it.
+  void BuildRuntimeFilter(const std::vector<util::ChunkedVector<MemoryPoolAllocator<byte>> *> &sources);
+
+  // Append the buffered tuples of a spilled partition to the spill file.
+  void FlushSpilledPartition(SpilledPartition *partition);
+
+  // Read back the tuples of a spilled partition in batches, calling the
+  // consumer with each one.
+  template <typename F>
+  void ReadSpilledPartition(const SpilledPartition &partition, std::size_t tuple_size, F &&consumer) const;
+
+  // Switch the built chaining table to the compact layout, if it was enabled,
+  // and release the entries and the chaining table.
+  void CompactEntries();
+
  private:
   // The execution context to run with.
   const exec::ExecutionSettings &exec_settings_;
@@ -259,8 +436,46 @@ class EXPORT JoinHashTable {
   // Should we use a concise hash table?
   bool use_concise_ht_;
 
+  // Should the bloom filter be built over the whole build side?
+  bool use_runtime_filter_;
+
+  // Should the tuples be stored in the compact layout once built?
+  bool use_compact_layout_;
+
+  // The size of the tuples stored in this table.
+  uint32_t tuple_size_;
+
+  // The compact layout, once the table is built with it. The tuples are
+  // stored back to back, grouped by bucket. The low bits of each directory
+  // word hold the index of the first tuple of the bucket, the high bits the
+  // tags of the hashes in it. A bucket ends where the next one begins, and
+  // one word past the last bucket holds the number of tuples.
+  byte *compact_tuples_;
+  uint64_t *compact_directory_;
+  uint64_t compact_mask_;
+
   // MemoryTracker
   common::ManagedPointer<MemoryTracker> tracker_;
+
+  // The number of bytes of build tuples that may stay resident, zero if the
+  // table never spills.
+  int64_t memory_budget_;
+
+  // The size of spilled probe tuples.
+  uint32_t probe_tuple_size_;
+
+  // Bit i is set if radix partition i is spilled and not yet processed.
+  uint64_t spilled_partitions_;
+
+  // The file spilled partitions are written to, and the latch protecting
+  // appends to it.
+  std::unique_ptr<SpillFile> spill_file_;
+  common::SpinLatch spill_file_latch_;
+
+  // The spilled build and probe tuples of each radix partition. Build tuples
+  // are stored as whole entries, probe tuples as they are given.
+  std::unique_ptr<SpilledPartition[]> build_spills_;
+  std::unique_ptr<SpilledPartition[]> probe_spills_;
 };
 
 // ---------------------------------------------------------
@@ -270,6 +485,16 @@ class EXPORT JoinHashTable {
 /** Look up the specified hash, do not use the concise hash table. */
 template <>
 inline HashTableEntryIterator JoinHashTable::Lookup<false>(const hash_t hash) const {
+  if (UsingCompactLayout()) {
+    const uint64_t *bucket = &compact_directory_[hash & compact_mask_];
+    if ((bucket[0] & CompactTag(hash)) == 0) {
+      return HashTableEntryIterator(compact_tuples_, compact_tuples_, tuple_size_);
+    }
+    const byte *begin = compact_tuples_ + (bucket[0] & COMPACT_INDEX_MASK) * tuple_size_;
+    const byte *end = compact_tuples_ + (bucket[1] & COMPACT_INDEX_MASK) * tuple_size_;
+    return HashTableEntryIterator(begin, end, tuple_size_);
+  }
+
   HashTableEntry *entry = chaining_hash_table_.FindChainHead(hash);
   while (entry != nullptr && entry->hash_ != hash) {
     entry = entry->next_;
@@ -317,11 +542,16 @@ class JoinHashTableIterator {
   /**
    * @return True if there is more data in the iterator; false otherwise.
    */
-  bool HasNext() const noexcept { return entry_iter_ != entry_end_; }
+  bool HasNext() const noexcept { return tuple_ != tuples_end_ || entry_iter_ != entry_end_; }
   /**
    * Advance to the next tuple.
    */
   void Next() noexcept {
+    // Tables in the compact layout have no entries, only tuples
+    if (tuple_ != tuples_end_) {
+      tuple_ += tuple_size_;
+      return;
+    }
     // Advance the entry iterator by one.
     ++entry_iter_;
     // If we've exhausted the current entry list, find another.
@@ -336,6 +566,9 @@ class JoinHashTableIterator {
    */
   const byte *GetCurrentRow() const noexcept {
     NOISEPAGE_ASSERT(HasNext(), "HasNext() indicates no more data!");
+    if (tuple_ != tuples_end_) {
+      return tuple_;
+    }
     const auto entry = reinterpret_cast<const HashTableEntry *>(*entry_iter_);
     return entry->payload_;
   }
@@ -362,6 +595,9 @@ class JoinHashTableIterator {
   EntryListIterator entry_list_iter_, entry_list_end_;
   // An iterator over the entries in a single entry list.
   EntryIterator entry_iter_, entry_end_;
+  // The tuples of a table in the compact layout, and their size.
+  const byte *tuple_, *tuples_end_;
+  uint32_t tuple_size_;
 };
 
 }  // namespace noisepage::execution::sql
@@ -14,6 +14,7 @@
 namespace noisepage::execution::sql {
 
 class MemoryTracker;
+class SlabAllocator;
 
 /**
  * A thin wrapper around a pointer to an object allocated from a memory pool.
@@ -118,7 +119,13 @@ inline bool operator!=(const MemPoolPtr<T> &a, std::nullptr_t) noexcept {
 }
 
 /**
- * A memory pool
+ * A memory pool.
+ *
+ * Allocations of up to MAX_SLAB_ALLOCATION_SIZE bytes are served from slabs the pool owns, which are carved into
+ * blocks of power-of-two size classes. Every thread caches the blocks it frees, and exchanges them with the pool in
+ * magazines of many blocks at a time, so threads allocating in parallel rarely synchronize. Slabs are returned to the
+ * system when the pool is destroyed. Larger allocations go to the system allocator, or to huge pages above the
+ * threshold set with SetMMapSizeThreshold().
  */
 class EXPORT MemoryPool {
  public:
@@ -133,6 +140,17 @@ class EXPORT MemoryPool {
    */
   DISALLOW_COPY_AND_MOVE(MemoryPool);
 
+  /**
+   * Destructor. Returns all slabs to the system.
+   */
+  ~MemoryPool();
+
+  /** The largest allocation served from slabs. */
+  static constexpr std::size_t MAX_SLAB_ALLOCATION_SIZE = 64 * 1024;
+
+  /** The alignment of all allocations served from slabs. */
+  static constexpr std::size_t SLAB_ALLOCATION_ALIGNMENT = 64;
+
   /**
    * Allocate @em size bytes of memory from this pool. The returned memory is not initialized.
    * @param size The number of bytes to allocate.
@@ -161,6 +179,7 @@ class EXPORT MemoryPool {
   /**
    * Allocate @em size bytes of memory from this pool with a specific alignment.
    * If @em alignment is less than the default minimum alignment of 8-bytes, a standard allocation is performed.
+   * Allocations served from slabs are aligned to SLAB_ALLOCATION_ALIGNMENT bytes, which is the most they support.
    * If @em clear is set, the memory chunk is zeroed out before returning.
    *
    * @param size The number of bytes to allocate.
@@ -264,6 +283,8 @@ class EXPORT MemoryPool {
  private:
   // Metadata tracker for memory allocations
   common::ManagedPointer<MemoryTracker> tracker_;
+  // The allocator for small allocations
+  std::unique_ptr<SlabAllocator> slab_allocator_;
 
   // Variable storing the threshold above which to use MMap allocations
   static std::atomic<std::size_t> mmap_threshold;
@@ -2,11 +2,17 @@
 
 #include <tbb/enumerable_thread_specific.h>
 
+#include <atomic>
+
+#include "common/memory_accountant.h"
+
 namespace noisepage::execution::sql {
 
 /**
  * Class for tracking memory on a per-thread granularity.
- * Currently tracks allocation size in bytes during thread's execution.
+ * Currently tracks allocation size in bytes during thread's execution, and the bytes the query
+ * holds across all threads. Every thread accounts for its allocations locally and merges them into
+ * the total once they add up to MERGE_THRESHOLD bytes, so parallel allocations don't contend on it.
  */
 class EXPORT MemoryTracker {
  public:
@@ -20,17 +26,44 @@ class EXPORT MemoryTracker {
    */
   size_t GetAllocatedSize() { return stats_.local().allocated_bytes_; }
 
+  /**
+   * @returns number of bytes currently allocated by all threads, which resetting does not affect. The bytes other
+   *          threads haven't merged yet are off by less than MERGE_THRESHOLD per thread.
+   */
+  int64_t GetTotalAllocatedSize() {
+    return total_allocated_bytes_.load(std::memory_order_relaxed) + stats_.local().unmerged_bytes_;
+  }
+
   /**
    * Increments number of allocated bytes
    * @param size number to increment by
    */
-  void Increment(size_t size) { stats_.local().allocated_bytes_ += size; }
+  void Increment(size_t size) {
+    auto &stats = stats_.local();
+    stats.allocated_bytes_ += size;
+    AddUnmergedBytes(&stats, static_cast<int64_t>(size));
+    common::MemoryAccountant::Allocate(common::MemoryComponent::EXECUTION, size);
+  }
 
   /**
    * Decrements number of allocated bytes
    * @param size number to decrement by
    */
-  void Decrement(size_t size) { stats_.local().allocated_bytes_ -= size; }
+  void Decrement(size_t size) {
+    auto &stats = stats_.local();
+    stats.allocated_bytes_ -= size;
+    AddUnmergedBytes(&stats, -static_cast<int64_t>(size));
+    common::MemoryAccountant::Free(common::MemoryComponent::EXECUTION, size);
+  }
+
+  /** The bytes a thread allocates or frees before merging them into the total. */
+  static constexpr int64_t MERGE_THRESHOLD = 256 * 1024;
+
+  /**
+   * @returns number of bytes allocated by all threads as merged so far, which any thread may ask for. It is off by less
+   *          than MERGE_THRESHOLD per thread that allocates for the query.
+   */
+  int64_t GetMergedAllocatedSize() const { return total_allocated_bytes_.load(std::memory_order_relaxed); }
 
  private:
   /**
@@ -39,8 +72,22 @@ class EXPORT MemoryTracker {
   struct Stats {
     // Number of bytes allocated
     size_t allocated_bytes_ = 0;
+    // Bytes allocated less bytes freed since the last merge into the total
+    int64_t unmerged_bytes_ = 0;
   };
+
+  void AddUnmergedBytes(Stats *stats, const int64_t bytes) {
+    stats->unmerged_bytes_ += bytes;
+    if (stats->unmerged_bytes_ >= MERGE_THRESHOLD || stats->unmerged_bytes_ <= -MERGE_THRESHOLD) {
+      total_allocated_bytes_.fetch_add(stats->unmerged_bytes_, std::memory_order_relaxed);
+      stats->unmerged_bytes_ = 0;
+    }
+  }
+
   tbb::enumerable_thread_specific<Stats> stats_;
+  // Bytes allocated by all threads. Memory may be freed by another thread than
+  // the one that allocated it, so only the total is exact.
+  std::atomic<int64_t> total_allocated_bytes_{0};
 };
 
 }  // namespace noisepage::execution::sql
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstdint>
+
+#include "execution/sql/runtime_types.h"
+#include "execution/sql/sql_def.h"
+
+namespace noisepage::execution::sql {
+
+// This file contains function objects that extract a part of dates and timestamps. They work on the native values in
+// vectors -- Julian days for dates, and Julian microseconds for timestamps -- and are small enough to be inlined into
+// the loops of the vector kernels, which the compiler can then vectorize. Their results are the same as the ones of
+// the member functions of Date and Timestamp, and of DateTimeFunctions.
+
+/**
+ * Function object for extracting a part of a day and a time of day.
+ * @tparam Part The part to extract.
+ */
+template <DatePartType Part>
+struct ExtractDatePart {
+  /**
+   * @param julian_day The Julian day.
+   * @param time_of_day The microseconds since midnight.
+   * @return The part of the day and the time of day.
+   */
+  int32_t operator()(const int32_t julian_day, const int64_t time_of_day) const {
+    if constexpr (Part == DatePartType::DOW) {
+      const int32_t dow = (julian_day + 1) % 7;
+      return dow < 0 ? dow + 7 : dow;
+    } else if constexpr (Part == DatePartType::HOUR) {  // NOLINT
+      return time_of_day / K_MICRO_SECONDS_PER_HOUR;
+    } else if constexpr (Part == DatePartType::MINUTE) {  // NOLINT
+      return time_of_day % K_MICRO_SECONDS_PER_HOUR / K_MICRO_SECONDS_PER_MINUTE;
+    } else if constexpr (Part == DatePartType::SECOND) {  // NOLINT
+      return time_of_day % K_MICRO_SECONDS_PER_MINUTE / K_MICRO_SECONDS_PER_SECOND;
+    } else if constexpr (Part == DatePartType::MILLISECOND) {  // NOLINT
+      return time_of_day % K_MICRO_SECONDS_PER_SECOND / 1000;
+    } else if constexpr (Part == DatePartType::MICROSECOND) {  // NOLINT
+      return time_of_day % 1000;
+    } else {  // NOLINT
+      int32_t year, month, day;
+      Date::SplitJulianDay(julian_day, &year, &month, &day);
+      if constexpr (Part == DatePartType::CENTURY) {
+        return year > 0 ? (year + 99) / 100 : -((99 - (year - 1)) / 100);
+      } else if constexpr (Part == DatePartType::DECADE) {  // NOLINT
+        return year >= 0 ? year / 10 : -((8 - (year - 1)) / 10);
+      } else if constexpr (Part == DatePartType::YEAR) {  // NOLINT
+        return year;
+      } else if constexpr (Part == DatePartType::QUARTER) {  // NOLINT
+        return (month - 1) / 3 + 1;
+      } else if constexpr (Part == DatePartType::MONTH) {  // NOLINT
+        return month;
+      } else if constexpr (Part == DatePartType::DAY) {  // NOLINT
+        return day;
+      } else {  // NOLINT
+        static_assert(Part == DatePartType::DOY, "Unsupported date part");
+        constexpr int32_t days_before_month[2][12] = {{0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334},
+                                                      {0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335}};
+        const bool leap = year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+        return days_before_month[leap][month - 1] + day;
+      }
+    }
+  }
+};
+
+/**
+ * Function object for extracting a part of dates. The time of a date is midnight.
+ * @tparam Part The part to extract.
+ */
+template <DatePartType Part>
+struct ExtractDatePartFromDate {
+  /**
+   * @param julian_day The native value of the date.
+   * @return The part of the date.
+   */
+  int32_t operator()(const Date::NativeType julian_day) const { return ExtractDatePart<Part>{}(julian_day, 0); }
+};
+
+/**
+ * Function object for extracting a part of timestamps.
+ * @tparam Part The part to extract.
+ */
+template <DatePartType Part>
+struct ExtractDatePartFromTimestamp {
+  /**
+   * @param julian_usec The native value of the timestamp.
+   * @return The part of the timestamp.
+   */
+  int32_t operator()(const Timestamp::NativeType julian_usec) const {
+    const auto usec = static_cast<int64_t>(julian_usec);
+    const int64_t julian_day = usec / K_MICRO_SECONDS_PER_DAY;
+    return ExtractDatePart<Part>{}(static_cast<int32_t>(julian_day), usec - julian_day * K_MICRO_SECONDS_PER_DAY);
+  }
+};
+
+}  // namespace noisepage::execution::sql
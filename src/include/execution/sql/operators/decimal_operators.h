@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#include "common/macros.h"
+#include "execution/util/arithmetic_overflow.h"
+#include "execution/util/execution_common.h"
+
+namespace noisepage::execution::sql {
+
+// This file contains function objects that implement fixed point arithmetic on the encoded values of decimals. The
+// encoded value v of a decimal of scale s stands for v / 10^s. Decimals of up to 18 digits are encoded in 64 bits, and
+// of up to 38 digits in 128 bits. The scales of the operands are only known at runtime, so every function object works
+// out how to align them once, when it is constructed, and not for every value.
+
+/** The largest scale of a decimal, which is the largest power of ten that a 128-bit decimal holds */
+constexpr uint32_t MAX_DECIMAL_SCALE = 38;
+
+namespace detail {
+constexpr std::array<int128_t, MAX_DECIMAL_SCALE + 1> ComputePowersOfTen() {
+  std::array<int128_t, MAX_DECIMAL_SCALE + 1> powers{};
+  powers[0] = 1;
+  for (uint32_t i = 1; i <= MAX_DECIMAL_SCALE; i++) powers[i] = powers[i - 1] * 10;
+  return powers;
+}
+constexpr std::array<int128_t, MAX_DECIMAL_SCALE + 1> POWERS_OF_TEN = ComputePowersOfTen();
+}  // namespace detail
+
+/**
+ * @tparam T The type of the encoded decimal values.
+ * @param exponent The exponent, at most MAX_DECIMAL_SCALE.
+ * @param[out] result Where 10^exponent is written to, if it fits into T.
+ * @return True if 10^exponent does not fit into T; false otherwise.
+ */
+template <typename T>
+constexpr bool DecimalPowerOfTen(const uint32_t exponent, T *const result) {
+  NOISEPAGE_ASSERT(exponent <= MAX_DECIMAL_SCALE, "Scale of decimal out of range");
+  const int128_t power = detail::POWERS_OF_TEN[exponent];
+  if (power > static_cast<int128_t>(std::numeric_limits<T>::max())) return true;
+  *result = static_cast<T>(power);
+  return false;
+}
+
+/**
+ * Function object for changing the scale of an encoded decimal value with overflow-checking. Scaling down rounds half
+ * away from zero, and never overflows.
+ * @tparam T The type of the encoded decimal values.
+ */
+template <typename T>
+struct DecimalRescaleWithOverflow {
+  /**
+   * @param from_scale The scale of the input values.
+   * @param to_scale The scale of the results.
+   */
+  DecimalRescaleWithOverflow(const uint32_t from_scale, const uint32_t to_scale)
+      : scale_up_(to_scale >= from_scale),
+        factor_overflows_(
+            DecimalPowerOfTen<T>(scale_up_ ? to_scale - from_scale : from_scale - to_scale, &factor_)) {}
+
+  /**
+   * @return True if the rescaled value of a overflows; false otherwise. @em result stores the result regardless.
+   */
+  bool operator()(const T a, T *const result) const {
+    if (factor_overflows_) {
+      // Only 0 can be scaled up by a factor that does not even fit, and anything scaled down by it rounds to 0
+      *result = 0;
+      return scale_up_ && a != 0;
+    }
+    if (scale_up_) return util::ArithmeticOverflow::Mul(a, factor_, result);
+    const T quotient = a / factor_;
+    const T remainder = a % factor_;
+    // Compare the remainder with half of the factor without computing 2 * remainder, which may overflow
+    const T magnitude = remainder < 0 ? -remainder : remainder;
+    const bool round_away = magnitude >= factor_ - magnitude;
+    *result = quotient + (round_away ? (a < 0 ? -1 : 1) : 0);
+    return false;
+  }
+
+ private:
+  bool scale_up_;
+  T factor_ = 1;
+  bool factor_overflows_;
+};
+
+/**
+ * Function object for adding encoded decimal values of possibly different scales with overflow-checking. The result
+ * has the larger of the two scales.
+ * @tparam T The type of the encoded decimal values.
+ */
+template <typename T>
+struct DecimalAddWithOverflow {
+  /**
+   * @param left_scale The scale of the left input values.
+   * @param right_scale The scale of the right input values.
+   */
+  DecimalAddWithOverflow(const uint32_t left_scale, const uint32_t right_scale)
+      : rescale_left_(left_scale < right_scale),
+        rescale_(std::min(left_scale, right_scale), std::max(left_scale, right_scale)) {}
+
+  /**
+   * @return True if a+b overflows; false otherwise. @em result stores the result regardless.
+   */
+  bool operator()(const T a, const T b, T *const result) const {
+    T rescaled;
+    if (rescale_left_) return rescale_(a, &rescaled) | util::ArithmeticOverflow::Add(rescaled, b, result);
+    return rescale_(b, &rescaled) | util::ArithmeticOverflow::Add(a, rescaled, result);
+  }
+
+ private:
+  bool rescale_left_;
+  DecimalRescaleWithOverflow<T> rescale_;
+};
+
+/**
+ * Function object for subtracting encoded decimal values of possibly different scales with overflow-checking. The
+ * result has the larger of the two scales.
+ * @tparam T The type of the encoded decimal values.
+ */
+template <typename T>
+struct DecimalSubtractWithOverflow {
+  /**
+   * @param left_scale The scale of the left input values.
+   * @param right_scale The scale of the right input values.
+   */
+  DecimalSubtractWithOverflow(const uint32_t left_scale, const uint32_t right_scale)
+      : rescale_left_(left_scale < right_scale),
+        rescale_(std::min(left_scale, right_scale), std::max(left_scale, right_scale)) {}
+
+  /**
+   * @return True if a-b overflows; false otherwise. @em result stores the result regardless.
+   */
+  bool operator()(const T a, const T b, T *const result) const {
+    T rescaled;
+    if (rescale_left_) return rescale_(a, &rescaled) | util::ArithmeticOverflow::Sub(rescaled, b, result);
+    return rescale_(b, &rescaled) | util::ArithmeticOverflow::Sub(a, rescaled, result);
+  }
+
+ private:
+  bool rescale_left_;
+  DecimalRescaleWithOverflow<T> rescale_;
+};
+
+/**
+ * Function object for comparing encoded decimal values of possibly different scales. Unlike rescaling, the comparison
+ * never fails: a value that does not fit once it is scaled up is larger in magnitude than any value that does.
+ * @tparam T The type of the encoded decimal values.
+ */
+template <typename T>
+struct DecimalCompare {
+  /**
+   * @param left_scale The scale of the left input values.
+   * @param right_scale The scale of the right input values.
+   */
+  DecimalCompare(const uint32_t left_scale, const uint32_t right_scale)
+      : rescale_left_(left_scale < right_scale),
+        rescale_(std::min(left_scale, right_scale), std::max(left_scale, right_scale)) {}
+
+  /**
+   * @return A negative value if a < b, 0 if a == b, and a positive value if a > b.
+   */
+  int32_t operator()(const T a, const T b) const {
+    T rescaled;
+    if (rescale_left_) {
+      if (rescale_(a, &rescaled)) return a < 0 ? -1 : 1;
+      return rescaled < b ? -1 : (rescaled > b ? 1 : 0);
+    }
+    if (rescale_(b, &rescaled)) return b < 0 ? 1 : -1;
+    return a < rescaled ? -1 : (a > rescaled ? 1 : 0);
+  }
+
+ private:
+  bool rescale_left_;
+  DecimalRescaleWithOverflow<T> rescale_;
+};
+
+}  // namespace noisepage::execution::sql
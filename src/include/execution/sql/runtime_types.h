@@ -155,6 +155,32 @@ class EXPORT Date {
    */
   static bool IsValidDate(int32_t year, int32_t month, int32_t day);
 
+  /**
+   * Split a Julian day into its year, month, and day. This is defined here, and not with the other
+   * calendar functions, so that the loops of vectorized date functions can inline it.
+   * @param julian_day The Julian day.
+   * @param[out] year The year of the day.
+   * @param[out] month The month (1-12) of the day.
+   * @param[out] day The day (1-31) of the month.
+   */
+  static void SplitJulianDay(const NativeType julian_day, int32_t *year, int32_t *month, int32_t *day) {
+    // Based on j2date() in Postgres
+    uint32_t julian = julian_day;
+    julian += 32044;
+    uint32_t quad = julian / 146097;
+    const uint32_t extra = (julian - quad * 146097) * 4 + 3;
+    julian += 60 + quad * 3 + extra / 146097;
+    quad = julian / 1461;
+    julian -= quad * 1461;
+    int32_t y = julian * 4 / 1461;
+    julian = ((y != 0) ? ((julian + 305) % 365) : ((julian + 306) % 366)) + 123;
+    y += quad * 4;
+    *year = y - 4800;
+    quad = julian * 2141 / 65536;
+    *day = julian - 7834 * quad / 256;
+    *month = (quad + 10) % 12 + 1;
+  }
+
  private:
   friend class Timestamp;
   friend struct DateVal;
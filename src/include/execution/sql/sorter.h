@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <iterator>
 #include <memory>
 #include <vector>
@@ -15,6 +16,7 @@ class ExecutionContext;
 
 namespace noisepage::execution::sql {
 
+class SpillFile;
 class ThreadStateContainer;
 class VectorProjection;
 class VectorProjectionIterator;
@@ -67,6 +69,17 @@ class VectorProjectionIterator;
  * thread-local Sorter, but <b>without calling</b> Sorter::Sort(). When all insertions are complete
  * across all threads, the primary thread uses Sorter::SortParallel() or Sorter::SortTopKParallel()
  * for parallel sort and parallel Top-K, respectively.
+ *
+ * Sorters spill to disk when their execution settings give them a memory budget. Once the tuples
+ * buffered through Sorter::AllocInputTuple() take up more than the budget, they are sorted and
+ * written out to a temporary file as a sorted run. Sorting a sorter that has spilled merges all of
+ * its runs, and those of the thread-local sorters in a parallel sort, into one sorted sequence on
+ * disk, which iterators then read back one block at a time. Top-K insertions never spill.
+ *
+ * A Top-K sorter with a normalized key function publishes the key of the K-th best tuple it holds
+ * as its top-K bound. Tuples whose key is greater than the bound can never make it into the top-K,
+ * so scans feeding the sorter use it to discard them early. Thread-local sorters share the bound
+ * of the sorter they are merged into, see Sorter::ShareTopKBound().
  */
 class EXPORT Sorter {
  public:
@@ -96,6 +109,13 @@ class EXPORT Sorter {
    */
   using ComparisonFunction = int32_t (*)(const void *lhs, const void *rhs);
 
+  /**
+   * The function that encodes the leading sort key of a tuple into an unsigned integer whose
+   * order matches the comparison function's: if a tuple compares less than another, its key is
+   * less than or equal to the other's.
+   */
+  using NormalizedKeyFunction = uint64_t (*)(const void *tuple);
+
   /**
    * Construct a sorter using @em memory as the memory allocator, storing tuples @em tuple_size
    * size in bytes, and using the comparison function @em cmp_fn.
@@ -122,6 +142,13 @@ class EXPORT Sorter {
    */
   byte *AllocInputTuple();
 
+  /**
+   * Sort on normalized keys produced by the given function. Tuples are radix sorted on their keys
+   * and the comparison function only orders tuples whose keys are equal.
+   * @param key_fn The function encoding a tuple's normalized key.
+   */
+  void SetNormalizedKeyFunction(NormalizedKeyFunction key_fn) noexcept { key_fn_ = key_fn; }
+
   /**
    * Tuple allocation for TopK. This call is must be paired with a subsequent call to
    * Sorter::AllocInputTupleTopKFinish() after the tuple's contents have been written into the
@@ -139,6 +166,19 @@ class EXPORT Sorter {
    */
   void AllocInputTupleTopKFinish(uint64_t top_k);
 
+  /**
+   * Publish the top-K bound of this sorter into the bound of @em other, typically the sorter the
+   * thread-local sorter is merged into, so that every thread tightens the same bound.
+   * @param other The sorter whose bound this sorter tightens.
+   */
+  void ShareTopKBound(Sorter *other) noexcept { top_k_bound_ = other->top_k_bound_; }
+
+  /**
+   * @return The largest normalized key a tuple may have to still make it into the top-K. Before
+   *         any heap is full, or without a normalized key function, every key is within bound.
+   */
+  uint64_t GetTopKBound() const noexcept { return top_k_bound_->load(std::memory_order_relaxed); }
+
   /**
    * Sort all inserted entries.
    */
@@ -168,7 +208,7 @@ class EXPORT Sorter {
   /**
    * @return The number of tuples currently in this sorter.
    */
-  uint64_t GetTupleCount() const noexcept { return tuples_.size(); }
+  uint64_t GetTupleCount() const noexcept { return tuples_.size() + num_spilled_tuples_; }
 
   /**
    * @return True if this sorter contains no tuples; false otherwise.
@@ -180,6 +220,45 @@ class EXPORT Sorter {
    */
   bool IsSorted() const noexcept { return sorted_; }
 
+  /**
+   * @return True if some of this sorter's tuples have been spilled to disk; false otherwise.
+   */
+  bool IsSpilled() const noexcept { return !runs_.empty(); }
+
+ private:
+  // A run of tuples in a spill file. Before the sorter is sorted, each run is
+  // sorted on its own. Afterwards, the runs are consecutive pieces of the one
+  // sorted sequence of all tuples.
+  struct SortedRun {
+    // The file the run is stored in
+    const SpillFile *file_;
+    // The offset in the file at which the run starts
+    uint64_t offset_;
+    // The number of tuples in the run
+    uint64_t num_tuples_;
+    // Copies of every SPILL_FENCE_INTERVAL-th tuple of the run, the first one
+    // included, so that merges can be split without reading the whole run
+    std::vector<byte> fences_;
+  };
+
+  // Sort the tuples buffered in memory, on their normalized keys if there is a
+  // key function
+  void SortTuples();
+
+  // Sort the tuples buffered in memory and write them out as a new sorted run
+  void SpillRun();
+
+  // The part of SortParallel() that runs if some thread-local sorter spilled
+  void SortParallelSpilled(ThreadStateContainer *thread_state_container, const std::vector<Sorter *> &tl_sorters);
+
+  // Merge all sorted runs into one sorted sequence of runs, split into at most
+  // the given number of key ranges that are merged in parallel
+  void MergeRuns(ThreadStateContainer *thread_state_container, uint64_t num_partitions);
+
+  // The number of tuples of the given run that are less than or equal to the
+  // given key, found through the run's fences and one read of the run
+  uint64_t FindRunBoundary(const SortedRun &run, const byte *key) const;
+
  private:
   // Build a max heap from the tuples currently stored in the sorter instance
   void BuildHeap();
@@ -188,6 +267,9 @@ class EXPORT Sorter {
   // property
   void HeapSiftDown();
 
+  // Lower the top-K bound to the normalized key of the root of the heap
+  void TightenTopKBound();
+
  private:
   friend class SorterIterator;
   friend class SorterVectorIterator;
@@ -205,15 +287,38 @@ class EXPORT Sorter {
   // The function used to compare two tuples
   ComparisonFunction cmp_fn_;
 
+  // The function encoding the normalized keys to radix sort on, if any
+  NormalizedKeyFunction key_fn_;
+
   // Vector of pointers to each entry. This is the vector that's sorted.
   MemPoolVector<const byte *> tuples_;
 
+  // The top-K bound this sorter owns, and the one it tightens, which is another sorter's if shared
+  std::atomic<uint64_t> own_top_k_bound_;
+  std::atomic<uint64_t> *top_k_bound_;
+
   // Flag indicating if the contents of the sorter have been sorted
   bool sorted_;
+
+  // The number of bytes of tuples this sorter buffers before it spills them,
+  // zero if there is no limit
+  int64_t memory_budget_;
+  // The file this sorter spills into, created on the first spill
+  SpillFile *spill_file_;
+  // The files this sorter's runs are stored in
+  std::vector<std::unique_ptr<SpillFile>> spill_files_;
+  // The sorted runs of tuples that have been spilled
+  std::vector<SortedRun> runs_;
+  // The number of tuples in all sorted runs
+  uint64_t num_spilled_tuples_;
 };
 
 /**
  * An iterator over the elements in a sorter instance.
+ *
+ * If the sorter has spilled, the iterator reads its tuples back from disk one block at a time. A
+ * row returned by the iterator then stays valid until the iterator has been advanced by another
+ * common::Constants::K_DEFAULT_VECTOR_SIZE rows.
  */
 class SorterIterator {
   using IteratorType = decltype(Sorter::tuples_)::const_iterator;
@@ -233,7 +338,11 @@ class SorterIterator {
   /**
    * Advance the iterator by one tuple.
    */
-  void Next() { ++iter_; }
+  void Next() {
+    if (++iter_ == end_ && num_spilled_remaining_ > 0) {
+      LoadSpilledRows();
+    }
+  }
 
   /**
    * Advance the iterator by @em n rows. If there are fewer than @em n rows remaining in this
@@ -245,7 +354,7 @@ class SorterIterator {
   /**
    * @return The number of tuples remaining in the iterator.
    */
-  uint64_t NumRemaining() const { return std::distance(iter_, end_); }
+  uint64_t NumRemaining() const { return std::distance(iter_, end_) + num_spilled_remaining_; }
 
   /**
    * @return A pointer to the current row. It assumed the called has checked the iterator is valid.
@@ -282,10 +391,32 @@ class SorterIterator {
   }
 
  private:
+  // Read the next block of spilled rows into the buffer not holding the
+  // current block, and point the iterator at it
+  void LoadSpilledRows();
+
+  // Skip the given number of spilled rows that haven't been read yet
+  void SkipSpilledRows(uint64_t n);
+
+ private:
+  // The sorter being iterated
+  const Sorter &sorter_;
+  // Pointers to the rows of the current block of spilled rows
+  MemPoolVector<const byte *> spilled_rows_;
   // The current iterator position
   IteratorType iter_;
   // The ending iterator position
-  const IteratorType end_;
+  IteratorType end_;
+  // The two buffers that blocks of spilled rows are read into in turn
+  std::vector<byte> spilled_buffers_[2];
+  // The buffer holding the current block of spilled rows
+  uint32_t spilled_buffer_idx_;
+  // The run the next block of spilled rows is read from
+  std::size_t spilled_run_idx_;
+  // The position in that run of the next spilled row to read
+  uint64_t spilled_run_pos_;
+  // The number of spilled rows that haven't been read yet
+  uint64_t num_spilled_remaining_;
 };
 
 /**
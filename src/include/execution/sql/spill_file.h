@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "common/macros.h"
+#include "common/strong_typedef.h"
+#include "execution/util/execution_common.h"
+#include "execution/util/file.h"
+
+namespace noisepage::execution::sql {
+
+/**
+ * An anonymous temporary file that operators write data to when it does not fit into their memory budget, and read it
+ * back from later on. The file is deleted as soon as it is closed, so nothing is left behind if the query fails.
+ *
+ * Appends must not race with each other. Reads may run concurrently with each other.
+ */
+class SpillFile {
+ public:
+  /**
+   * Create an empty spill file.
+   * @throw ExecutionException if the file could not be created.
+   */
+  SpillFile();
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(SpillFile);
+
+  /**
+   * Append the given data to the end of the file.
+   * @param data The data to write.
+   * @param size The number of bytes to write.
+   * @return The offset in the file at which the data starts.
+   * @throw ExecutionException if the data could not be written.
+   */
+  uint64_t Append(const byte *data, std::size_t size);
+
+  /**
+   * Read back data that was appended before.
+   * @param offset The offset in the file to read from.
+   * @param[out] data Where to read the data into.
+   * @param size The number of bytes to read.
+   * @throw ExecutionException if the data could not be read.
+   */
+  void Read(uint64_t offset, byte *data, std::size_t size) const;
+
+  /**
+   * @return The number of bytes in the file.
+   */
+  uint64_t GetSize() const noexcept { return size_; }
+
+ private:
+  // The underlying file
+  util::File file_;
+  // The number of bytes in the file
+  uint64_t size_{0};
+};
+
+}  // namespace noisepage::execution::sql
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "catalog/catalog_defs.h"
@@ -42,7 +44,7 @@ class EXPORT StorageInterface {
                             uint32_t num_oids, bool need_indexes);
 
   /**
-   * Destructor.
+   * Destructor. Applies the index entries that are still buffered, unless the txn must abort.
    */
   ~StorageInterface();
 
@@ -77,17 +79,19 @@ class EXPORT StorageInterface {
    */
   storage::ProjectedRow *GetIndexPR(catalog::index_oid_t index_oid);
 
-  /** @return The size of the current index. */
-  uint64_t IndexGetSize() const;
+  /** @return The size of the current index, including the entries that are still buffered. */
+  uint64_t IndexGetSize();
 
   /**
-   * Delete item from the current index.
+   * Delete item from the current index. The delete is buffered and applied with the other deletes from the same index
+   * in a batch, which is safe because an index delete only takes effect after the txn commits anyway.
    * @param table_tuple_slot slot corresponding to the item.
    */
   void IndexDelete(storage::TupleSlot table_tuple_slot);
 
   /**
-   * Insert into the current index
+   * Insert into the current index, which must not be unique. The insert is buffered and applied with the other inserts
+   * into the same index in a batch, once the batch is full or the storage interface is freed.
    * @return Whether insertion was successful.
    */
   bool IndexInsert();
@@ -111,7 +115,44 @@ class EXPORT StorageInterface {
    */
   uint32_t GetIndexHeapSize();
 
+  /**
+   * Applies the buffered inserts and deletes of every index.
+   */
+  void FlushIndexBatches();
+
  protected:
+  /**
+   * Number of buffered entries at which a batch is applied to its index.
+   */
+  static constexpr uint32_t INDEX_BATCH_SIZE = 4096;
+
+  /**
+   * Index entries that are buffered to be applied to one index together, see IndexInsert and IndexDelete.
+   */
+  struct IndexBatch {
+    /** The index that the entries belong to. */
+    common::ManagedPointer<storage::index::Index> index_;
+    /** Offsets of the varlen columns in the index PR. */
+    std::vector<uint16_t> varlen_offsets_;
+    /** Copies of the keys, each in a slot of the same size. */
+    std::vector<uint64_t> keys_;
+    /** The tuple slot of each key. */
+    std::vector<storage::TupleSlot> slots_;
+    /** Contents of the keys' varlens that are not inlined, since the originals may not outlive the current tuple. */
+    std::vector<std::unique_ptr<byte[]>> varlens_;
+  };
+
+  /**
+   * Copies the current index PR into the batch of the current index, and applies the batch if it is full.
+   */
+  void BufferIndexEntry(std::unordered_map<catalog::index_oid_t, IndexBatch> *batches, storage::TupleSlot slot,
+                        bool insert);
+
+  /**
+   * Applies the buffered entries of a batch to its index and empties the batch.
+   */
+  void FlushIndexBatch(IndexBatch *batch, bool insert);
+
   /**
    * Oid of the table being accessed.
    */
@@ -162,6 +203,18 @@ class EXPORT StorageInterface {
    * Current index being accessed.
    */
   common::ManagedPointer<storage::index::Index> curr_index_{nullptr};
+  /**
+   * OID of the current index.
+   */
+  catalog::index_oid_t curr_index_oid_;
+  /**
+   * Buffered inserts, by index.
+   */
+  std::unordered_map<catalog::index_oid_t, IndexBatch> insert_batches_;
+  /**
+   * Buffered deletes, by index.
+   */
+  std::unordered_map<catalog::index_oid_t, IndexBatch> delete_batches_;
 };
 }  // namespace sql
 }  // namespace noisepage::execution
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <unordered_set>
 #include <vector>
 
 #include "execution/sql/vector_projection.h"
@@ -17,6 +18,7 @@ class SqlTable;
 
 namespace noisepage::execution::sql {
 
+class Sorter;
 class ThreadStateContainer;
 
 /**
@@ -36,6 +38,12 @@ class EXPORT TableVectorIterator {
    */
   static constexpr const uint32_t K_MIN_BLOCK_RANGE_SIZE = 2;
 
+  /**
+   * The late columns are only read for the tuples that pass the filters while at most this fraction of the tuples
+   * scanned so far did. Reading a tuple one at a time costs more than copying it along with the rest of its vector.
+   */
+  static constexpr const double K_MAX_LATE_MATERIALIZATION_SELECTIVITY = 0.25;
+
   /**
    * Create a new vectorized iterator over the given table
    * @param exec_ctx execution context of the query
@@ -66,7 +74,8 @@ class EXPORT TableVectorIterator {
    * Initialize the iterator over a chunk of blocks [start, end), returning true if the iteration succeeded.
    *
    * If block_start == 0 and block_end == storage::DataTable::GetMaxBlocks(),
-   * then iteration begins at the start of the table and continues until the current last block.
+   * then iteration begins at the start of the table and continues until the current last block. A table that shares
+   * its scans is read from the block the latest scan is at instead, wrapping around to the blocks before it.
    *
    * @param block_start The starting block to iterate at.
    * @param block_end The ending block to stop iterating at, non-inclusive.
@@ -85,6 +94,53 @@ class EXPORT TableVectorIterator {
    */
   bool IsInitialized() const { return initialized_; }
 
+  /**
+   * Skip the blocks that hold no value within [min, max] in the given column, according to their zone maps. Every
+   * filter added must hold for a block to be read, and blocks are only skipped as a whole, so the projections may still
+   * contain tuples outside of the range. Columns whose blocks keep no zone map are not filtered on.
+   * @param col_idx index of the column amongst the columns the iterator reads
+   * @param min lower bound of the values of interest, inclusive
+   * @param max upper bound of the values of interest, inclusive
+   */
+  void FilterBlocks(uint32_t col_idx, int64_t min, int64_t max) { block_filters_.push_back({col_idx, min, max}); }
+
+  /**
+   * Skip the blocks that hold no value of the given integer column that may still make it into the top-K of a sorter,
+   * according to their zone maps. The sorter's bound is read anew for every block, so more blocks are skipped as the
+   * sorter's heaps fill up. The column must not hold NULLs, since zone maps don't record them.
+   * @param col_idx index of the column amongst the columns the iterator reads, the first sort key of the sorter
+   * @param sorter the sorter whose top-K bound is filtered on, @see Sorter::GetTopKBound()
+   * @param descending true if the sorter sorts the column in descending order
+   */
+  void FilterBlocksTopK(uint32_t col_idx, const Sorter *sorter, bool descending) {
+    top_k_block_filters_.push_back({col_idx, sorter, descending});
+  }
+
+  /**
+   * Only read a uniform random sample of the blocks of the table, picked by reservoir sampling. Every tuple of a block
+   * in the sample is read. The execution context records how many times more slots the table has than the sample, for
+   * the counts over the sample to be scaled up, @see exec::ExecutionContext::ScaleSampledCount(). Nothing is skipped if
+   * the table has no more than the given number of blocks. Must be called after Init(), on an iterator over the whole
+   * table.
+   * @param num_blocks number of blocks to read
+   */
+  void SampleBlocks(uint32_t num_blocks);
+
+  /**
+   * Leave a column out of the projections until FetchLateColumns() is called, which reads it only for the tuples that
+   * passed the filters of the scan. Columns that filters read must not be late. The scan falls back to reading every
+   * column while the filters pass too many tuples, @see K_MAX_LATE_MATERIALIZATION_SELECTIVITY. Must be called after
+   * Init(), and at least one column must be read eagerly.
+   * @param col_idx index of the column amongst the columns the iterator reads
+   */
+  void LateMaterialize(uint32_t col_idx);
+
+  /**
+   * Read the late columns of the tuples selected in the current projection, once its filters ran. Also records how many
+   * of its tuples passed the filters, for the next projections to decide whether to read the late columns lazily.
+   */
+  void FetchLateColumns();
+
   /** @return The total number of tuples in the vector projection iterator. */
   uint64_t GetVectorProjectionIteratorNumTuples() const { return vector_projection_iterator_.GetTotalTupleCount(); }
 
@@ -133,11 +189,54 @@ class EXPORT TableVectorIterator {
 
   std::unique_ptr<storage::DataTable::SlotIterator> iter_ = nullptr;
 
+  // True if the iterator shares its scan with the others of the table, @see storage::DataTable::SetSharedScans()
+  bool shared_scan_{false};
+  // The blocks [0, wrap_end_) a shared scan reads once it reached the end of the table
+  uint32_t wrap_end_{0};
+
   VectorProjection vector_projection_;
 
   // An iterator over the currently active projection.
   VectorProjectionIterator vector_projection_iterator_;
 
+  // A range of values of a column, and the blocks that hold none of them are skipped
+  struct BlockFilter {
+    uint32_t col_idx_;
+    int64_t min_;
+    int64_t max_;
+  };
+  std::vector<BlockFilter> block_filters_;
+
+  // A column sorted by a top-K sorter, and the blocks holding no value within the sorter's bound are skipped
+  struct TopKBlockFilter {
+    uint32_t col_idx_;
+    const Sorter *sorter_;
+    bool descending_;
+  };
+  std::vector<TopKBlockFilter> top_k_block_filters_;
+
+  // The blocks to read if the table is sampled, empty to read all of them
+  std::unordered_set<const storage::RawBlock *> sampled_blocks_;
+
+  // The indexes of the columns read with the projection and of the ones read by FetchLateColumns(), in projection order
+  std::vector<uint16_t> early_col_idxs_;
+  std::vector<uint16_t> late_col_idxs_;
+  // True if the current projection was read without its late columns
+  bool late_columns_pending_{false};
+  // The number of tuples scanned and passing the filters so far, in the projections FetchLateColumns() was called on
+  uint64_t num_scanned_{0};
+  uint64_t num_selected_{0};
+
+  // True if the block at the iterator may hold tuples that pass every block filter
+  bool BlockMayPass() const;
+
+  // The FROZEN block the projection currently points into, if it was read in place
+  storage::RawBlock *in_place_block_{nullptr};
+
+  // Lets writers into the block read in place for the current projection, and points the projection back at its own
+  // buffer.
+  void ReleaseInPlaceBlock();
+
   // True if the iterator has been initialized.
   bool initialized_{false};
 };
@@ -309,6 +309,11 @@ class TupleIdList {
    */
   BitVectorType *GetMutableBits() { return &bit_vector_; }
 
+  /**
+   * @return The internal bit vector representation of the list.
+   */
+  const BitVectorType &GetBits() const { return bit_vector_; }
+
   /**
    * @return The number of active tuples in the list.
    */
@@ -6,6 +6,7 @@
 #include "execution/sql/runtime_types.h"
 #include "execution/util/string_heap.h"
 #include "storage/storage_defs.h"
+#include "storage/varlen_allocator.h"
 #include "type/type_id.h"
 
 namespace noisepage::execution::sql {
@@ -200,8 +201,7 @@ struct StringVal : public Val {
     }
     if (str.GetLength() > storage::VarlenEntry::InlineThreshold()) {
       if (own) {
-        // TODO(WAN): smarter allocation?
-        byte *contents = common::AllocationUtil::AllocateAligned(str.GetLength());
+        byte *contents = storage::VarlenAllocator::Allocate(str.GetLength());
         std::memcpy(contents, str.GetContent(), str.GetLength());
         return noisepage::storage::VarlenEntry::Create(contents, str.GetLength(), true);
       }
@@ -76,6 +76,14 @@ namespace noisepage::execution::sql {
  * ecosystem; the rich library of vector operations in tpl::sql::VectorOps can be executed on native
  * arrays.
  *
+ * <h3>Dictionary-encoded vectors</h3>
+ * A vector of strings can additionally carry a dictionary encoding (see Vector::SetDictionary()),
+ * e.g., when it references a dictionary-compressed column of a frozen block. The vector's data
+ * still holds the decoded strings, so every operation can read it as usual. Operations that know
+ * about the encoding, like selections against a constant or hashing, instead evaluate once per
+ * distinct value and then work on the integer codes of the elements. Any operation that changes
+ * the vector's data drops the encoding.
+ *
  * <h3>Owning-vectors</h3>
  * Owning vectors, as their name implies, create and own the underlying vector data upon creation.
  * Owning vectors are created empty (i.e., with a size of 0) and must be explicitly resized after
@@ -185,6 +193,27 @@ class EXPORT Vector {
    */
   byte *GetData() const noexcept { return data_; }
 
+  /**
+   * @return True if this vector carries a dictionary encoding; false otherwise.
+   */
+  bool IsDictionaryEncoded() const noexcept { return dictionary_ != nullptr; }
+
+  /**
+   * @return The dictionary code of every element in the vector. Only valid if the vector is
+   *         dictionary-encoded.
+   */
+  const uint64_t *GetDictionaryCodes() const noexcept { return dictionary_codes_; }
+
+  /**
+   * @return The distinct values of the vector. Only valid if the vector is dictionary-encoded.
+   */
+  const storage::VarlenEntry *GetDictionary() const noexcept { return dictionary_; }
+
+  /**
+   * @return The number of distinct values in the dictionary of the vector.
+   */
+  uint32_t GetDictionarySize() const noexcept { return dictionary_size_; }
+
   /**
    * @return The list of active TIDs in the vector. If all TIDs are visible, the list is NULL.
    */
@@ -356,6 +385,15 @@ class EXPORT Vector {
    */
   void ReferenceNullMask(byte *data, const NullMask *null_mask, uint64_t size);
 
+  /**
+   * Attach a dictionary encoding to this vector of strings. The vector must already hold the
+   * decoded strings, i.e., element i must be equal to dictionary[codes[i]] unless it is NULL.
+   * @param codes The dictionary code of every element in the vector.
+   * @param dictionary The distinct values of the vector.
+   * @param dictionary_size The number of distinct values.
+   */
+  void SetDictionary(const uint64_t *codes, const storage::VarlenEntry *dictionary, uint32_t dictionary_size);
+
   /**
    * Change this vector to reference data held (and potentially owned) by the provided vector.
    * @param other The vector to reference.
@@ -394,6 +432,13 @@ class EXPORT Vector {
   void CheckIntegrity() const;
 
  private:
+  // Drop the dictionary encoding, if any
+  void ClearDictionary() {
+    dictionary_codes_ = nullptr;
+    dictionary_ = nullptr;
+    dictionary_size_ = 0;
+  }
+
   // Create a new vector with the provided type. Any existing data is destroyed.
   void Initialize(TypeId new_type, bool clear);
 
@@ -423,6 +468,12 @@ class EXPORT Vector {
   // The null mask used to indicate if an element in the vector is NULL.
   NullMask null_mask_;
 
+  // The dictionary encoding of the vector's strings. The dictionary is NULL if the vector is not
+  // dictionary-encoded. Neither array is owned by the vector.
+  const uint64_t *dictionary_codes_;
+  const storage::VarlenEntry *dictionary_;
+  uint32_t dictionary_size_;
+
   // Heap container for strings owned by this vector.
   VarlenHeap varlen_heap_;
 
@@ -0,0 +1,231 @@
+#pragma once
+
+#include <vector>
+
+#include "execution/sql/constant_vector.h"
+#include "execution/sql/generic_value.h"
+#include "execution/sql/sql.h"
+#include "execution/sql/value.h"
+#include "execution/sql/vector_operations/vector_operations.h"
+#include "execution/sql/vector_projection.h"
+
+namespace noisepage::execution::sql {
+
+/**
+ * This is a helper class to evaluate arithmetic expressions over whole vector projections. Results
+ * are written into columns of an extended projection, one that references all columns of the
+ * projection it was extended from and appends one column for every intermediate result.
+ */
+class VectorExpressionExecutor {
+ public:
+  /** This class cannot be instantiated. */
+  DISALLOW_INSTANTIATION(VectorExpressionExecutor);
+  /** This class cannot be copied or moved. */
+  DISALLOW_COPY_AND_MOVE(VectorExpressionExecutor);
+
+  /**
+   * Extend the vector projection @em input into @em result. The leading columns of @em result
+   * reference the columns of @em input, the remaining ones are resized to hold the results of
+   * expressions over them. The selections and tuple slots of @em input are carried over.
+   * @param result The extended projection. Must have been initialized with the types of all
+   *               columns of @em input, followed by the types of all computed columns.
+   * @param input The projection to extend.
+   */
+  static void Extend(VectorProjection *result, VectorProjection *input);
+
+  /**
+   * Cast the column at index @em col_idx into the column at index @em result_col_idx.
+   * @param exec_settings The execution settings to use.
+   * @param vector_projection The vector projection to run on.
+   * @param result_col_idx The index of the column to write the result into.
+   * @param col_idx The index of the column to cast.
+   */
+  static void Cast(const exec::ExecutionSettings &exec_settings, VectorProjection *vector_projection,
+                   uint32_t result_col_idx, uint32_t col_idx);
+
+  /**
+   * Extract a part of the dates or timestamps in the column at index @em col_idx into the Integer
+   * column at index @em result_col_idx.
+   * @param exec_settings The execution settings to use.
+   * @param vector_projection The vector projection to run on.
+   * @param result_col_idx The index of the column to write the result into.
+   * @param col_idx The index of the column to extract from.
+   * @param part The part to extract.
+   */
+  static void DatePart(const exec::ExecutionSettings &exec_settings, VectorProjection *vector_projection,
+                       uint32_t result_col_idx, uint32_t col_idx, DatePartType part);
+
+  /**
+   * Add the values of two columns.
+   * @param exec_settings The execution settings to use.
+   * @param vector_projection The vector projection to run on.
+   * @param result_col_idx The index of the column to write the result into.
+   * @param left_col_idx The index of the left column.
+   * @param right_col_idx The index of the right column.
+   */
+  static void Add(const exec::ExecutionSettings &exec_settings, VectorProjection *vector_projection,
+                  uint32_t result_col_idx, uint32_t left_col_idx, uint32_t right_col_idx);
+
+  /**
+   * Add a constant value (@em val) to the values of a column.
+   * @param exec_settings The execution settings to use.
+   * @param vector_projection The vector projection to run on.
+   * @param result_col_idx The index of the column to write the result into.
+   * @param left_col_idx The index of the left column.
+   * @param val The value to add.
+   */
+  static void AddVal(const exec::ExecutionSettings &exec_settings, VectorProjection *vector_projection,
+                     uint32_t result_col_idx, uint32_t left_col_idx, const Val &val);
+
+  /**
+   * Subtract the values of the right column from the values of the left column.
+   * @param exec_settings The execution settings to use.
+   * @param vector_projection The vector projection to run on.
+   * @param result_col_idx The index of the column to write the result into.
+   * @param left_col_idx The index of the left column.
+   * @param right_col_idx The index of the right column.
+   */
+  static void Subtract(const exec::ExecutionSettings &exec_settings, VectorProjection *vector_projection,
+                       uint32_t result_col_idx, uint32_t left_col_idx, uint32_t right_col_idx);
+
+  /**
+   * Subtract a constant value (@em val) from the values of a column.
+   * @param exec_settings The execution settings to use.
+   * @param vector_projection The vector projection to run on.
+   * @param result_col_idx The index of the column to write the result into.
+   * @param left_col_idx The index of the left column.
+   * @param val The value to subtract.
+   */
+  static void SubtractVal(const exec::ExecutionSettings &exec_settings, VectorProjection *vector_projection,
+                          uint32_t result_col_idx, uint32_t left_col_idx, const Val &val);
+
+  /**
+   * Subtract the values of a column from a constant value (@em val).
+   * @param exec_settings The execution settings to use.
+   * @param vector_projection The vector projection to run on.
+   * @param result_col_idx The index of the column to write the result into.
+   * @param val The value to subtract from.
+   * @param right_col_idx The index of the right column.
+   */
+  static void SubtractFromVal(const exec::ExecutionSettings &exec_settings, VectorProjection *vector_projection,
+                              uint32_t result_col_idx, const Val &val, uint32_t right_col_idx);
+
+  /**
+   * Multiply the values of two columns.
+   * @param exec_settings The execution settings to use.
+   * @param vector_projection The vector projection to run on.
+   * @param result_col_idx The index of the column to write the result into.
+   * @param left_col_idx The index of the left column.
+   * @param right_col_idx The index of the right column.
+   */
+  static void Multiply(const exec::ExecutionSettings &exec_settings, VectorProjection *vector_projection,
+                       uint32_t result_col_idx, uint32_t left_col_idx, uint32_t right_col_idx);
+
+  /**
+   * Multiply the values of a column with a constant value (@em val).
+   * @param exec_settings The execution settings to use.
+   * @param vector_projection The vector projection to run on.
+   * @param result_col_idx The index of the column to write the result into.
+   * @param left_col_idx The index of the left column.
+   * @param val The value to multiply with.
+   */
+  static void MultiplyVal(const exec::ExecutionSettings &exec_settings, VectorProjection *vector_projection,
+                          uint32_t result_col_idx, uint32_t left_col_idx, const Val &val);
+
+ private:
+  // Create a constant vector of the given type holding the runtime value.
+  static ConstantVector MakeConstant(TypeId type_id, const Val &val) {
+    return ConstantVector(val.is_null_ ? GenericValue::CreateNull(type_id)
+                                       : GenericValue::CreateFromRuntimeValue(type_id, val));
+  }
+};
+
+// ---------------------------------------------------------
+//
+// Implementation
+//
+// ---------------------------------------------------------
+
+inline void VectorExpressionExecutor::Extend(VectorProjection *result, VectorProjection *input) {
+  NOISEPAGE_ASSERT(result->GetColumnCount() >= input->GetColumnCount(), "Extended projection is too narrow");
+  const uint32_t num_tuples = input->GetTotalTupleCount();
+  result->Reset(num_tuples);
+  for (uint32_t i = 0; i < input->GetColumnCount(); i++) {
+    result->GetColumn(i)->Reference(input->GetColumn(i));
+  }
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    result->SetTupleSlot(input->GetTupleSlot(i), i);
+  }
+  if (input->IsFiltered()) {
+    result->SetFilteredSelections(*input->GetFilteredTupleIdList());
+  }
+}
+
+inline void VectorExpressionExecutor::Cast(const exec::ExecutionSettings &exec_settings,
+                                           VectorProjection *vector_projection, const uint32_t result_col_idx,
+                                           const uint32_t col_idx) {
+  VectorOps::Cast(exec_settings, *vector_projection->GetColumn(col_idx), vector_projection->GetColumn(result_col_idx));
+}
+
+inline void VectorExpressionExecutor::DatePart(const exec::ExecutionSettings &exec_settings,
+                                               VectorProjection *vector_projection, const uint32_t result_col_idx,
+                                               const uint32_t col_idx, const DatePartType part) {
+  VectorOps::DatePart(exec_settings, *vector_projection->GetColumn(col_idx), part,
+                      vector_projection->GetColumn(result_col_idx));
+}
+
+inline void VectorExpressionExecutor::Add(const exec::ExecutionSettings &exec_settings,
+                                          VectorProjection *vector_projection, const uint32_t result_col_idx,
+                                          const uint32_t left_col_idx, const uint32_t right_col_idx) {
+  VectorOps::Add(exec_settings, *vector_projection->GetColumn(left_col_idx),
+                 *vector_projection->GetColumn(right_col_idx), vector_projection->GetColumn(result_col_idx));
+}
+
+inline void VectorExpressionExecutor::AddVal(const exec::ExecutionSettings &exec_settings,
+                                             VectorProjection *vector_projection, const uint32_t result_col_idx,
+                                             const uint32_t left_col_idx, const Val &val) {
+  auto *result = vector_projection->GetColumn(result_col_idx);
+  VectorOps::Add(exec_settings, *vector_projection->GetColumn(left_col_idx), MakeConstant(result->GetTypeId(), val),
+                 result);
+}
+
+inline void VectorExpressionExecutor::Subtract(const exec::ExecutionSettings &exec_settings,
+                                               VectorProjection *vector_projection, const uint32_t result_col_idx,
+                                               const uint32_t left_col_idx, const uint32_t right_col_idx) {
+  VectorOps::Subtract(exec_settings, *vector_projection->GetColumn(right_col_idx),
+                      vector_projection->GetColumn(result_col_idx), *vector_projection->GetColumn(left_col_idx));
+}
+
+inline void VectorExpressionExecutor::SubtractVal(const exec::ExecutionSettings &exec_settings,
+                                                  VectorProjection *vector_projection, const uint32_t result_col_idx,
+                                                  const uint32_t left_col_idx, const Val &val) {
+  auto *result = vector_projection->GetColumn(result_col_idx);
+  VectorOps::Subtract(exec_settings, MakeConstant(result->GetTypeId(), val), result,
+                      *vector_projection->GetColumn(left_col_idx));
+}
+
+inline void VectorExpressionExecutor::SubtractFromVal(const exec::ExecutionSettings &exec_settings,
+                                                      VectorProjection *vector_projection,
+                                                      const uint32_t result_col_idx, const Val &val,
+                                                      const uint32_t right_col_idx) {
+  auto *result = vector_projection->GetColumn(result_col_idx);
+  VectorOps::Subtract(exec_settings, *vector_projection->GetColumn(right_col_idx), result,
+                      MakeConstant(result->GetTypeId(), val));
+}
+
+inline void VectorExpressionExecutor::Multiply(const exec::ExecutionSettings &exec_settings,
+                                               VectorProjection *vector_projection, const uint32_t result_col_idx,
+                                               const uint32_t left_col_idx, const uint32_t right_col_idx) {
+  VectorOps::Multiply(exec_settings, *vector_projection->GetColumn(left_col_idx),
+                      *vector_projection->GetColumn(right_col_idx), vector_projection->GetColumn(result_col_idx));
+}
+
+inline void VectorExpressionExecutor::MultiplyVal(const exec::ExecutionSettings &exec_settings,
+                                                  VectorProjection *vector_projection, const uint32_t result_col_idx,
+                                                  const uint32_t left_col_idx, const Val &val) {
+  auto *result = vector_projection->GetColumn(result_col_idx);
+  VectorOps::Multiply(exec_settings, *vector_projection->GetColumn(left_col_idx),
+                      MakeConstant(result->GetTypeId(), val), result);
+}
+
+}  // namespace noisepage::execution::sql
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+#include "common/macros.h"
+#include "storage/storage_defs.h"
+
+namespace noisepage::execution::sql {
+
+class TupleIdList;
+
+/**
+ * SIMD kernels for predicates over strings. Rather than comparing strings one at a time through
+ * VarlenEntry's comparison functions, the kernels first look at the size and the prefix every
+ * VarlenEntry stores inline for a whole vector at a time, touching the out-of-line contents of
+ * strings only when their prefixes can't decide the predicate.
+ */
+class StringKernels {
+ public:
+  /** This class cannot be instantiated. */
+  DISALLOW_INSTANTIATION(StringKernels);
+  /** This class cannot be copied or moved. */
+  DISALLOW_COPY_AND_MOVE(StringKernels);
+
+  /**
+   * Remove all TIDs from @em tid_list whose strings can't begin with @em prefix: strings that are
+   * shorter than it, or whose inline prefixes differ from its first bytes. The TIDs that remain may
+   * still not match when @em prefix is longer than the inline prefix and must be checked in full.
+   * @param strings The strings to filter.
+   * @param prefix The prefix the strings must begin with.
+   * @param exact_size If true, strings must be exactly as long as @em prefix, not just at least.
+   * @param[in,out] tid_list The TIDs of the strings to check, updated to those that may match.
+   */
+  static void SelectPrefixCandidates(const storage::VarlenEntry *strings, std::string_view prefix, bool exact_size,
+                                     TupleIdList *tid_list);
+
+  /**
+   * @return True if @em needle occurs anywhere in @em haystack. An empty needle occurs in every string.
+   */
+  static bool Contains(std::string_view haystack, std::string_view needle);
+};
+
+}  // namespace noisepage::execution::sql
@@ -4,6 +4,7 @@
 
 #include "common/constants.h"
 #include "execution/sql/generic_value.h"
+#include "execution/sql/sql_def.h"
 #include "execution/sql/vector.h"
 
 namespace noisepage::execution::exec {
@@ -177,6 +178,71 @@ class EXPORT VectorOps {
    */
   static void BitwiseAndInPlace(const exec::ExecutionSettings &exec_settings, Vector *left, const Vector &right);
 
+  /**
+   * Change the scale of the encoded decimals in @em input and store the result into @em result. Comparisons of
+   * decimals of different scales are comparisons of integers once both sides have the same scale, so the selection
+   * functions apply as they are to vectors that were rescaled here first.
+   *
+   * @param input The encoded decimals, in a BigInt vector.
+   * @param from_scale The scale of the decimals in @em input.
+   * @param to_scale The scale of the decimals in @em result.
+   * @param[out] result The rescaled decimals, in a BigInt vector.
+   * @throw ExecutionException if a rescaled decimal does not fit into 64 bits.
+   */
+  static void DecimalRescale(const Vector &input, uint32_t from_scale, uint32_t to_scale, Vector *result);
+
+  /**
+   * Add the encoded decimals in @em left and @em right and store the result into @em result, at the larger of the two
+   * scales. Vectors of the same scale are added without any rescaling.
+   *
+   * @param left The left input into the addition, in a BigInt vector.
+   * @param left_scale The scale of the decimals in @em left.
+   * @param right The right input into the addition, in a BigInt vector.
+   * @param right_scale The scale of the decimals in @em right.
+   * @param[out] result The sums, in a BigInt vector.
+   * @throw ExecutionException if a sum does not fit into 64 bits.
+   */
+  static void DecimalAdd(const Vector &left, uint32_t left_scale, const Vector &right, uint32_t right_scale,
+                         Vector *result);
+
+  /**
+   * Subtract the encoded decimals in @em right from @em left and store the result into @em result, at the larger of
+   * the two scales. Vectors of the same scale are subtracted without any rescaling.
+   *
+   * @param left The left input into the subtraction, in a BigInt vector.
+   * @param left_scale The scale of the decimals in @em left.
+   * @param right The right input into the subtraction, in a BigInt vector.
+   * @param right_scale The scale of the decimals in @em right.
+   * @param[out] result The differences, in a BigInt vector.
+   * @throw ExecutionException if a difference does not fit into 64 bits.
+   */
+  static void DecimalSubtract(const Vector &left, uint32_t left_scale, const Vector &right, uint32_t right_scale,
+                              Vector *result);
+
+  /**
+   * Multiply the encoded decimals in @em left with @em right and store the result into @em result. The scale of a
+   * product is the sum of the scales of its factors, so no rescaling is ever needed.
+   *
+   * @param left The left input into the multiplication, in a BigInt vector.
+   * @param right The right input into the multiplication, in a BigInt vector.
+   * @param[out] result The products, in a BigInt vector.
+   * @throw ExecutionException if a product does not fit into 64 bits.
+   */
+  static void DecimalMultiply(const Vector &left, const Vector &right, Vector *result);
+
+  /**
+   * Extract the part @em part of the dates or timestamps in @em input and store it into the Integer vector
+   * @em result, like EXTRACT(part FROM input). Dates have a time of midnight.
+   *
+   * @param exec_settings The execution settings.
+   * @param input The dates or timestamps to extract from.
+   * @param part The part to extract.
+   * @param[out] result The extracted parts, in an Integer vector.
+   * @throw ExecutionException if @em part can not be extracted.
+   */
+  static void DatePart(const exec::ExecutionSettings &exec_settings, const Vector &input, DatePartType part,
+                       Vector *result);
+
   // -------------------------------------------------------
   //
   // Selections
@@ -322,6 +388,17 @@ class EXPORT VectorOps {
    */
   static void HashCombine(const Vector &input, Vector *result);
 
+  /**
+   * Hash the elements of two vectors of the same tuples together into @em result, as VectorOps::Hash() of @em first
+   * followed by VectorOps::HashCombine() of @em second would. Pairs of fixed-width integer and date columns, the
+   * most common multi-column keys, are hashed in a single pass by a kernel specialized for their types. Other pairs
+   * fall back to the two passes.
+   * @param first The first input to hash.
+   * @param second The second input to hash, combined with the hashes of @em first.
+   * @param[out] result The vector where hash results are stored.
+   */
+  static void Hash(const Vector &first, const Vector &second, Vector *result);
+
   // -------------------------------------------------------
   //
   // Gather / Scatter
@@ -423,6 +500,66 @@ class EXPORT VectorOps {
    */
   static void Sort(const Vector &input, sel_t result[]);
 
+  // -------------------------------------------------------
+  //
+  // Aggregations
+  //
+  // -------------------------------------------------------
+
+  /**
+   * @param input The input vector.
+   * @return The number of active elements in @em input that are not NULL.
+   */
+  static uint64_t CountNotNull(const Vector &input);
+
+  /**
+   * Sum the active, non-NULL elements of the integer vector @em input.
+   * @param input The input vector, of any integer type.
+   * @param[out] result The sum, only written if there is an element to sum.
+   * @return True if there is an active, non-NULL element; false otherwise.
+   */
+  static bool Sum(const Vector &input, int64_t *result);
+
+  /**
+   * Sum the active, non-NULL elements of the floating point vector @em input.
+   * @param input The input vector, of any floating point type.
+   * @param[out] result The sum, only written if there is an element to sum.
+   * @return True if there is an active, non-NULL element; false otherwise.
+   */
+  static bool Sum(const Vector &input, double *result);
+
+  /**
+   * Find the smallest active, non-NULL element of the integer vector @em input.
+   * @param input The input vector, of any integer type.
+   * @param[out] result The smallest element, only written if there is one.
+   * @return True if there is an active, non-NULL element; false otherwise.
+   */
+  static bool Min(const Vector &input, int64_t *result);
+
+  /**
+   * Find the smallest active, non-NULL element of the floating point vector @em input.
+   * @param input The input vector, of any floating point type.
+   * @param[out] result The smallest element, only written if there is one.
+   * @return True if there is an active, non-NULL element; false otherwise.
+   */
+  static bool Min(const Vector &input, double *result);
+
+  /**
+   * Find the largest active, non-NULL element of the integer vector @em input.
+   * @param input The input vector, of any integer type.
+   * @param[out] result The largest element, only written if there is one.
+   * @return True if there is an active, non-NULL element; false otherwise.
+   */
+  static bool Max(const Vector &input, int64_t *result);
+
+  /**
+   * Find the largest active, non-NULL element of the floating point vector @em input.
+   * @param input The input vector, of any floating point type.
+   * @param[out] result The largest element, only written if there is one.
+   * @return True if there is an active, non-NULL element; false otherwise.
+   */
+  static bool Max(const Vector &input, double *result);
+
   // -------------------------------------------------------
   //
   // Vector Iteration Logic
@@ -521,6 +658,36 @@ class EXPORT VectorOps {
     const auto *RESTRICT data = reinterpret_cast<const T *>(vector.GetData());
     Exec(vector, [&](const uint64_t i, const uint64_t k) { f(data[i], i, k); });
   }
+
+  /**
+   * Filter the TID list @em tid_list by a predicate on the strings of the dictionary-encoded
+   * vector @em input. The predicate is evaluated once for every distinct value, and the TIDs are
+   * then filtered on their codes. This only pays off if the vector has fewer distinct values than
+   * there are TIDs to filter, so nothing is done otherwise. NULL elements are always removed.
+   *
+   * @tparam P Predicate accepting a const-reference to a string.
+   * @param input The vector to filter, which need not be dictionary-encoded.
+   * @param p The predicate.
+   * @param[in,out] tid_list The list of TIDs to filter.
+   * @return True if the TID list was filtered; false if the caller must filter it element-wise.
+   */
+  template <typename P>
+  static bool SelectDictionary(const Vector &input, P &&p, TupleIdList *tid_list) {
+    if (!input.IsDictionaryEncoded() || input.GetDictionarySize() > tid_list->GetTupleCount()) {
+      return false;
+    }
+
+    const storage::VarlenEntry *RESTRICT dictionary = input.GetDictionary();
+    util::BitVector<uint64_t> matches(input.GetDictionarySize());
+    for (uint32_t code = 0; code < input.GetDictionarySize(); code++) {
+      matches.Set(code, p(dictionary[code]));
+    }
+
+    const uint64_t *RESTRICT codes = input.GetDictionaryCodes();
+    tid_list->GetMutableBits()->Difference(input.GetNullMask());
+    tid_list->Filter([&](const uint64_t i) { return matches.Test(codes[i]); });
+    return true;
+  }
 };
 
 }  // namespace noisepage::execution::sql
@@ -14,6 +14,7 @@
 
 namespace noisepage::storage {
 class BlockLayout;
+class SqlTable;
 }
 
 namespace noisepage::execution::sql {
@@ -91,12 +92,16 @@ class EXPORT VectorProjection {
     /**
      * @return number of columns stored in the ProjectedColumns
      */
-    uint16_t NumColumns() const { return underlying_->GetColumnCount(); }
+    uint16_t NumColumns() const {
+      return col_idxs_ == nullptr ? underlying_->GetColumnCount() : static_cast<uint16_t>(col_idxs_->size());
+    }
 
     /**
      * @return pointer to the start of the array of column ids
      */
-    const std::vector<storage::col_id_t> &ColumnIds() const { return underlying_->ColumnIds(); }
+    const std::vector<storage::col_id_t> &ColumnIds() const {
+      return col_ids_ == nullptr ? underlying_->ColumnIds() : *col_ids_;
+    }
 
     /**
      * Set the attribute in the row to be null using the internal bitmap
@@ -104,7 +109,7 @@ class EXPORT VectorProjection {
      */
     void SetNull(const uint16_t projection_list_index) {
       NOISEPAGE_ASSERT(projection_list_index < NumColumns(), "Column offset out of bounds.");
-      underlying_->GetColumn(projection_list_index)->SetNull(row_offset_, true);
+      Column(projection_list_index)->SetNull(row_offset_, true);
     }
 
     /**
@@ -113,7 +118,7 @@ class EXPORT VectorProjection {
      */
     void SetNotNull(const uint16_t projection_list_index) {
       NOISEPAGE_ASSERT(projection_list_index < NumColumns(), "Column offset out of bounds.");
-      underlying_->GetColumn(projection_list_index)->SetNull(row_offset_, false);
+      Column(projection_list_index)->SetNull(row_offset_, false);
     }
 
     /**
@@ -123,7 +128,7 @@ class EXPORT VectorProjection {
      */
     bool IsNull(const uint16_t projection_list_index) const {
       NOISEPAGE_ASSERT(projection_list_index < NumColumns(), "Column offset out of bounds.");
-      return underlying_->GetColumn(projection_list_index)->IsNull(row_offset_);
+      return Column(projection_list_index)->IsNull(row_offset_);
     }
 
     /**
@@ -135,7 +140,7 @@ class EXPORT VectorProjection {
     byte *AccessWithNullCheck(const uint16_t projection_list_index) {
       NOISEPAGE_ASSERT(projection_list_index < NumColumns(), "Column offset out of bounds.");
       if (IsNull(projection_list_index)) return nullptr;
-      return underlying_->GetColumn(projection_list_index)->GetValuePointer(row_offset_);
+      return Column(projection_list_index)->GetValuePointer(row_offset_);
     }
 
     /**
@@ -147,7 +152,7 @@ class EXPORT VectorProjection {
     const byte *AccessWithNullCheck(const uint16_t projection_list_index) const {
       NOISEPAGE_ASSERT(projection_list_index < NumColumns(), "Column offset out of bounds.");
       if (IsNull(projection_list_index)) return nullptr;
-      return underlying_->GetColumn(projection_list_index)->GetValuePointer(row_offset_);
+      return Column(projection_list_index)->GetValuePointer(row_offset_);
     }
 
     /**
@@ -158,7 +163,7 @@ class EXPORT VectorProjection {
     byte *AccessForceNotNull(const uint16_t projection_list_index) {
       NOISEPAGE_ASSERT(projection_list_index < NumColumns(), "Column offset out of bounds.");
       if (IsNull(projection_list_index)) SetNotNull(projection_list_index);
-      return underlying_->GetColumn(projection_list_index)->GetValuePointer(row_offset_);
+      return Column(projection_list_index)->GetValuePointer(row_offset_);
     }
 
     /** Associate the current row offset with the provided tuple slot. */
@@ -166,9 +171,17 @@ class EXPORT VectorProjection {
 
    private:
     friend class VectorProjection;
-    RowView(VectorProjection *underlying, uint32_t row_offset) : underlying_(underlying), row_offset_(row_offset) {}
+    RowView(VectorProjection *underlying, uint32_t row_offset, const std::vector<uint16_t> *col_idxs,
+            const std::vector<storage::col_id_t> *col_ids)
+        : underlying_(underlying), row_offset_(row_offset), col_idxs_(col_idxs), col_ids_(col_ids) {}
+    Vector *Column(const uint16_t projection_list_index) const {
+      return underlying_->GetColumn(col_idxs_ == nullptr ? projection_list_index : (*col_idxs_)[projection_list_index]);
+    }
     VectorProjection *const underlying_;
     const uint32_t row_offset_;
+    // The columns of the projection the row is made of, all of them if null
+    const std::vector<uint16_t> *const col_idxs_;
+    const std::vector<storage::col_id_t> *const col_ids_;
   };
 
   /**
@@ -281,6 +294,11 @@ class EXPORT VectorProjection {
    */
   void Reset(uint64_t num_tuples);
 
+  /**
+   * @return True if this projection owns the memory of its vectors, which they point to after Reset().
+   */
+  bool OwnsData() const { return owned_buffer_ != nullptr; }
+
   /**
    * Packing (or compressing) a projection rearranges contained vector data by contiguously storing
    * only active vector elements, removing any filtered TID list.
@@ -380,13 +398,26 @@ class EXPORT VectorProjection {
   void RefreshFilteredTupleIdList();
 
   friend class storage::DataTable;
+  friend class storage::SqlTable;
 
   /**
-   * Should only be used by storage::DataTable.
+   * Should only be used by storage::DataTable and storage::SqlTable.
    * @param row_offset the row offset within the ProjectedColumns to look at
    * @return a view into the desired row within the ProjectedColumns
    */
-  RowView InterpretAsRow(uint32_t row_offset) { return {this, row_offset}; }
+  RowView InterpretAsRow(uint32_t row_offset) { return {this, row_offset, nullptr, nullptr}; }
+
+  /**
+   * Should only be used by storage::DataTable and storage::SqlTable.
+   * @param row_offset the row offset within the ProjectedColumns to look at
+   * @param col_idxs the indexes of the columns the row is made of, in the order of the projection
+   * @param col_ids the storage column ids of these columns, which outlive the view
+   * @return a view into some of the columns of the desired row within the ProjectedColumns
+   */
+  RowView InterpretAsRow(uint32_t row_offset, const std::vector<uint16_t> *col_idxs,
+                         const std::vector<storage::col_id_t> *col_ids) {
+    return {this, row_offset, col_idxs, col_ids};
+  }
 
   // Vector containing column data for all columns in this projection.
   std::vector<std::unique_ptr<Vector>> columns_;
@@ -733,6 +733,11 @@ class BitVector {
    */
   const WordType *GetWords() const noexcept { return words_.data(); }
 
+  /**
+   * @return A mutable view of the words making up the bit vector. The bits past the end must stay unset.
+   */
+  WordType *GetWords() noexcept { return words_.data(); }
+
  private:
   // The number of bits in the last word
   uint32_t GetNumExtraBits() const { return num_bits_ % WORD_SIZE_BITS; }
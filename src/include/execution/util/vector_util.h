@@ -75,6 +75,19 @@ class VectorUtil {
    */
   static void SelectionVectorToByteVector(const sel_t *sel_vector, uint32_t num_elems, uint8_t *byte_vector);
 
+  /**
+   * Convert a selection vector into a bit vector. For each index in @em sel_vector set the corresponding bit in
+   * @em bit_vector, leaving the other bits as they are. The bits of consecutive indexes in the same word are collected
+   * in a register and written together, so this is fastest when the selection vector is sorted.
+   *
+   * @pre The capacity of the bit vector must be larger than every index in the selection vector.
+   *
+   * @param sel_vector The input selection index vector.
+   * @param num_elems The number of elements in the selection vector.
+   * @param[out] bit_vector The output bit vector, passed along as an array of words.
+   */
+  static void SelectionVectorToBitVector(const sel_t *sel_vector, uint32_t num_elems, uint64_t *bit_vector);
+
   /**
    * Convert a byte vector into a selection vector. Store the indexes positions of all saturated byte values 0xFF into
    * the selection vector @em sel_vector.
@@ -131,6 +144,7 @@ class VectorUtil {
 
  private:
   FRIEND_TEST(VectorUtilTest, BitToSelectionVector_Sparse_vs_Dense);
+  FRIEND_TEST(VectorUtilTest, BitToSelectionVector_PartialByte);
   FRIEND_TEST(VectorUtilTest, DiffSelected);
   FRIEND_TEST(VectorUtilTest, DiffSelectedWithScratchPad);
   FRIEND_TEST(VectorUtilTest, IntersectScalar);
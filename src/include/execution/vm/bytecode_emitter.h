@@ -319,10 +319,16 @@ class BytecodeEmitter {
   void EmitTableIterInit(Bytecode bytecode, LocalVar iter, LocalVar exec_ctx, LocalVar table_oid, LocalVar col_oids,
                          uint32_t num_oids);
 
+  /** Initialize a vector projection with columns of the given types. */
+  void EmitVectorProjectionInit(LocalVar vector_projection, LocalVar col_types, uint32_t num_cols);
+
   /** Emit a parallel table scan. */
   void EmitParallelTableScan(LocalVar table_oid, LocalVar col_oids, uint32_t num_oids, LocalVar query_state,
                              LocalVar exec_ctx, FunctionId scan_fn);
 
+  /** Emit a parallel ascending index scan. */
+  void EmitParallelIndexScan(LocalVar iter, LocalVar scan_type, LocalVar query_state, FunctionId scan_fn);
+
   /** Emit a register hook function. */
   void EmitRegisterHook(LocalVar exec_ctx, LocalVar hook_idx, FunctionId hook_fn);
 
@@ -332,6 +338,9 @@ class BytecodeEmitter {
   /** Setting values in an iterator. */
   void EmitVPISet(Bytecode bytecode, LocalVar vpi, LocalVar input, uint32_t col_idx);
 
+  /** Advancing an aggregate by a column of an iterator. */
+  void EmitAggAdvanceVector(Bytecode bytecode, LocalVar agg, LocalVar vpi, uint32_t col_idx);
+
   /** Insert a filter flavor into the filter manager builder. */
   void EmitFilterManagerInsertFilter(LocalVar filter_manager, FunctionId func);
 
@@ -349,9 +358,16 @@ class BytecodeEmitter {
   void EmitAggHashTableParallelPartitionedScan(LocalVar agg_ht, LocalVar context, LocalVar tls,
                                                FunctionId scan_part_fn);
 
+  /** Emit code to join the spilled partitions of a join hash table. */
+  void EmitJoinHashTableProcessSpilled(LocalVar join_ht, LocalVar query_state, LocalVar pipeline_state,
+                                       FunctionId probe_fn);
+
   /** Initialize a sorter instance. */
   void EmitSorterInit(Bytecode bytecode, LocalVar sorter, LocalVar exec_ctx, FunctionId cmp_fn, LocalVar tuple_size);
 
+  /** Set the function a sorter computes normalized keys with. */
+  void EmitSorterSetNormalizedKey(LocalVar sorter, FunctionId key_fn);
+
   /** Initialize a CSV reader. */
   // void EmitCSVReaderInit(LocalVar creader, LocalVar file_name, uint32_t file_name_len);
 
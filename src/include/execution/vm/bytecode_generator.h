@@ -79,6 +79,9 @@ class BytecodeGenerator final : public ast::AstVisitor<BytecodeGenerator> {
   // Dispatched from VisitBuiltinCallExpr() to handle the various builtin
   // functions, including filtering, hash table interaction, sorting etc.
   void VisitSqlConversionCall(ast::CallExpr *call, ast::Builtin builtin);
+  // Initialize the date of a @dateToSql() call with literal arguments once, when it is compiled.
+  // Returns false if the call is to be evaluated when the query runs.
+  bool EmitDateLiteral(ast::CallExpr *call, LocalVar dest);
   void VisitNullValueCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitSqlStringLikeCall(ast::CallExpr *call);
   void VisitBuiltinDateFunctionCall(ast::CallExpr *call, ast::Builtin builtin);
@@ -88,6 +91,8 @@ class BytecodeGenerator final : public ast::AstVisitor<BytecodeGenerator> {
   void VisitBuiltinHashCall(ast::CallExpr *call);
   void VisitBuiltinFilterManagerCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinVectorFilterCall(ast::CallExpr *call, ast::Builtin builtin);
+  void VisitBuiltinVectorProjectionCall(ast::CallExpr *call, ast::Builtin builtin);
+  void VisitBuiltinVectorArithmeticCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinAggHashTableCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinAggHashTableIterCall(ast::CallExpr *call, ast::Builtin builtin);
   void VisitBuiltinAggPartIterCall(ast::CallExpr *call, ast::Builtin builtin);
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <string>
 
 #include "catalog/catalog_accessor.h"
@@ -24,9 +26,11 @@
 #include "execution/sql/storage_interface.h"
 #include "execution/sql/table_vector_iterator.h"
 #include "execution/sql/thread_state_container.h"
+#include "execution/sql/vector_expression_executor.h"
 #include "execution/sql/vector_filter_executor.h"
 #include "metrics/metrics_manager.h"
 #include "parser/expression/constant_value_expression.h"
+#include "util/portable_endian.h"
 
 // #include "execution/util/csv_reader.h" Fix later.
 
@@ -214,6 +218,29 @@ VM_OP_COLD void OpExecutionContextRegisterHook(noisepage::execution::exec::Execu
 
 VM_OP_COLD void OpExecutionContextClearHooks(noisepage::execution::exec::ExecutionContext *exec_ctx);
 
+VM_OP_HOT void OpExecutionContextCheckInterrupt(const noisepage::execution::exec::ExecutionContext *exec_ctx) {
+  exec_ctx->CheckInterrupt();
+}
+
+VM_OP_WARM void OpExecutionContextScaleSampledCount(noisepage::execution::sql::Integer *result,
+                                                    const noisepage::execution::exec::ExecutionContext *exec_ctx,
+                                                    const noisepage::execution::sql::Integer *count) {
+  result->is_null_ = count->is_null_;
+  result->val_ = exec_ctx->ScaleSampledCount(count->val_);
+}
+
+VM_OP_WARM void OpExecutionContextScaleSampledDistinct(noisepage::execution::sql::Integer *result,
+                                                       const noisepage::execution::exec::ExecutionContext *exec_ctx,
+                                                       const noisepage::execution::sql::Integer *num_distinct,
+                                                       const noisepage::execution::sql::Integer *count) {
+  result->is_null_ = num_distinct->is_null_;
+  result->val_ = exec_ctx->ScaleSampledDistinct(num_distinct->val_, count->is_null_ ? 0 : count->val_);
+}
+
+VM_OP_COLD void OpExecutionContextAnalyzeColumnGroups(noisepage::execution::sql::StringVal *result,
+                                                      noisepage::execution::exec::ExecutionContext *exec_ctx,
+                                                      uint32_t table_oid, uint32_t col_oid);
+
 VM_OP_COLD void OpExecutionContextInitHooks(noisepage::execution::exec::ExecutionContext *exec_ctx, uint32_t num_hooks);
 
 VM_OP_WARM void OpExecutionContextGetMemoryPool(noisepage::execution::sql::MemoryPool **const memory,
@@ -242,6 +269,20 @@ VM_OP_COLD void OpExecutionContextEndPipelineTracker(noisepage::execution::exec:
                                                      noisepage::execution::pipeline_id_t pipeline_id,
                                                      noisepage::selfdriving::ExecOUFeatureVector *ouvec);
 
+VM_OP_COLD void OpExecutionContextStartPipelineProfile(noisepage::execution::exec::ExecutionContext *exec_ctx,
+                                                       noisepage::execution::pipeline_id_t pipeline_id);
+
+VM_OP_COLD void OpExecutionContextEndPipelineProfile(noisepage::execution::exec::ExecutionContext *exec_ctx,
+                                                     noisepage::execution::pipeline_id_t pipeline_id);
+
+VM_OP_COLD void OpExecutionContextRecordOperatorRows(noisepage::execution::exec::ExecutionContext *exec_ctx,
+                                                     noisepage::execution::pipeline_id_t pipeline_id,
+                                                     noisepage::planner::plan_node_id_t plan_node_id,
+                                                     uint64_t num_rows);
+
+VM_OP_COLD void OpExecutionContextCheckCardinality(noisepage::execution::exec::ExecutionContext *exec_ctx,
+                                                   noisepage::planner::plan_node_id_t plan_node_id, uint32_t num_rows);
+
 VM_OP_COLD void OpExecOUFeatureVectorRecordFeature(
     noisepage::selfdriving::ExecOUFeatureVector *ouvec, noisepage::execution::pipeline_id_t pipeline_id,
     noisepage::execution::feature_id_t feature_id,
@@ -319,6 +360,20 @@ VM_OP_HOT void OpTableVectorIteratorGetVPI(noisepage::execution::sql::VectorProj
   *vpi = iter->GetVectorProjectionIterator();
 }
 
+VM_OP void OpTableVectorIteratorFilterBlocks(noisepage::execution::sql::TableVectorIterator *iter, uint32_t col_idx,
+                                             int64_t min, int64_t max);
+
+VM_OP void OpTableVectorIteratorFilterBlocksTopK(noisepage::execution::sql::TableVectorIterator *iter, uint32_t col_idx,
+                                                 const noisepage::execution::sql::Sorter *sorter, bool descending);
+
+VM_OP void OpTableVectorIteratorSampleBlocks(noisepage::execution::sql::TableVectorIterator *iter, uint32_t num_blocks);
+
+VM_OP void OpTableVectorIteratorLateMaterialize(noisepage::execution::sql::TableVectorIterator *iter, uint32_t col_idx);
+
+VM_OP_HOT void OpTableVectorIteratorFetchLateColumns(noisepage::execution::sql::TableVectorIterator *iter) {
+  iter->FetchLateColumns();
+}
+
 VM_OP_HOT void OpParallelScanTable(uint32_t table_oid, uint32_t *col_oids, uint32_t num_oids, void *const query_state,
                                    noisepage::execution::exec::ExecutionContext *exec_ctx,
                                    const noisepage::execution::sql::TableVectorIterator::ScanFn scanner) {
@@ -500,7 +555,10 @@ VM_OP_HOT void OpHashCombine(noisepage::hash_t *hash_val, noisepage::hash_t new_
 // ---------------------------------------------------------
 
 VM_OP void OpFilterManagerInit(noisepage::execution::sql::FilterManager *filter_manager,
-                               const noisepage::execution::exec::ExecutionSettings &exec_settings);
+                               noisepage::execution::exec::ExecutionContext *exec_ctx);
+
+VM_OP void OpFilterManagerInitWithContext(noisepage::execution::sql::FilterManager *filter_manager,
+                                          noisepage::execution::exec::ExecutionContext *exec_ctx, void *context);
 
 VM_OP void OpFilterManagerStartNewClause(noisepage::execution::sql::FilterManager *filter_manager);
 
@@ -544,6 +602,66 @@ GEN_VECTOR_FILTER(NotLike)
 
 #undef GEN_VECTOR_FILTER
 
+// ---------------------------------------------------------
+// Vector Expression Executor
+// ---------------------------------------------------------
+
+VM_OP void OpVectorProjectionInit(noisepage::execution::sql::VectorProjection *vector_projection,
+                                  const uint32_t *col_types, uint32_t num_cols);
+
+VM_OP_HOT void OpVectorProjectionExtend(noisepage::execution::sql::VectorProjection *vector_projection,
+                                        noisepage::execution::sql::VectorProjectionIterator *vpi) {
+  noisepage::execution::sql::VectorExpressionExecutor::Extend(vector_projection, vpi->GetVectorProjection());
+}
+
+VM_OP void OpVectorProjectionFree(noisepage::execution::sql::VectorProjection *vector_projection);
+
+VM_OP_HOT void OpVectorCast(noisepage::execution::exec::ExecutionContext *exec_ctx,
+                            noisepage::execution::sql::VectorProjection *vector_projection,
+                            const uint32_t result_col_idx, const uint32_t col_idx) {
+  noisepage::execution::sql::VectorExpressionExecutor::Cast(exec_ctx->GetExecutionSettings(), vector_projection,
+                                                            result_col_idx, col_idx);
+}
+
+VM_OP_HOT void OpVectorDatePart(noisepage::execution::exec::ExecutionContext *exec_ctx,
+                                noisepage::execution::sql::VectorProjection *vector_projection,
+                                const uint32_t result_col_idx, const uint32_t col_idx, const uint32_t part) {
+  noisepage::execution::sql::VectorExpressionExecutor::DatePart(exec_ctx->GetExecutionSettings(), vector_projection,
+                                                                result_col_idx, col_idx,
+                                                                noisepage::execution::sql::DatePartType(part));
+}
+
+#define GEN_VECTOR_ARITHMETIC(Name, Op)                                                                              \
+  VM_OP_HOT void OpVector##Name(noisepage::execution::exec::ExecutionContext *exec_ctx,                              \
+                                noisepage::execution::sql::VectorProjection *vector_projection,                      \
+                                const uint32_t result_col_idx, const uint32_t left_col_idx,                          \
+                                const uint32_t right_col_idx) {                                                      \
+    noisepage::execution::sql::VectorExpressionExecutor::Op(exec_ctx->GetExecutionSettings(), vector_projection,     \
+                                                            result_col_idx, left_col_idx, right_col_idx);            \
+  }                                                                                                                  \
+  VM_OP_HOT void OpVector##Name##Val(noisepage::execution::exec::ExecutionContext *exec_ctx,                         \
+                                     noisepage::execution::sql::VectorProjection *vector_projection,                 \
+                                     const uint32_t result_col_idx, const uint32_t left_col_idx,                     \
+                                     const noisepage::execution::sql::Val *val) {                                    \
+    noisepage::execution::sql::VectorExpressionExecutor::Op##Val(exec_ctx->GetExecutionSettings(), vector_projection, \
+                                                                 result_col_idx, left_col_idx, *val);                \
+  }
+
+GEN_VECTOR_ARITHMETIC(Add, Add)
+GEN_VECTOR_ARITHMETIC(Sub, Subtract)
+GEN_VECTOR_ARITHMETIC(Mul, Multiply)
+
+#undef GEN_VECTOR_ARITHMETIC
+
+VM_OP_HOT void OpVectorSubFromVal(noisepage::execution::exec::ExecutionContext *exec_ctx,
+                                  noisepage::execution::sql::VectorProjection *vector_projection,
+                                  const uint32_t result_col_idx, const noisepage::execution::sql::Val *val,
+                                  const uint32_t right_col_idx) {
+  noisepage::execution::sql::VectorExpressionExecutor::SubtractFromVal(exec_ctx->GetExecutionSettings(),
+                                                                       vector_projection, result_col_idx, *val,
+                                                                       right_col_idx);
+}
+
 // ---------------------------------------------------------
 // Scalar SQL comparisons
 // ---------------------------------------------------------
@@ -579,6 +697,11 @@ VM_OP_HOT void OpInitDate(noisepage::execution::sql::DateVal *result, int32_t ye
   result->val_ = noisepage::execution::sql::Date::FromYMD(year, month, day);
 }
 
+VM_OP_HOT void OpInitDateFromJulianDay(noisepage::execution::sql::DateVal *result, int32_t julian_day) {
+  result->is_null_ = false;
+  result->val_ = noisepage::execution::sql::Date::FromNative(julian_day);
+}
+
 VM_OP_HOT void OpInitTimestamp(noisepage::execution::sql::TimestampVal *result, uint64_t usec) {
   result->is_null_ = false;
   result->val_ = noisepage::execution::sql::Timestamp::FromMicroseconds(usec);
@@ -827,6 +950,11 @@ VM_OP_HOT void OpAggregationHashTableLinkHashTableEntry(noisepage::execution::sq
   agg_hash_table->Insert(entry);
 }
 
+VM_OP_HOT void OpAggregationHashTableInternStringKey(noisepage::execution::sql::AggregationHashTable *agg_hash_table,
+                                                     noisepage::execution::sql::StringVal *key) {
+  agg_hash_table->InternStringKey(key);
+}
+
 VM_OP_HOT void OpAggregationHashTableLookup(noisepage::byte **result,
                                             noisepage::execution::sql::AggregationHashTable *const agg_hash_table,
                                             const noisepage::hash_t hash_val,
@@ -835,6 +963,21 @@ VM_OP_HOT void OpAggregationHashTableLookup(noisepage::byte **result,
   *result = agg_hash_table->Lookup(hash_val, key_eq_fn, probe_tuple);
 }
 
+VM_OP void OpAggregationHashTableSetDenseDomain(noisepage::execution::sql::AggregationHashTable *agg_hash_table,
+                                                int64_t min_key, uint32_t num_keys);
+
+VM_OP_HOT void OpAggregationHashTableLookupDense(noisepage::byte **result,
+                                                 const noisepage::execution::sql::AggregationHashTable *agg_hash_table,
+                                                 const noisepage::execution::sql::Integer *key) {
+  *result = agg_hash_table->LookupDense(*key);
+}
+
+VM_OP_HOT void OpAggregationHashTableInsertDense(noisepage::execution::sql::AggregationHashTable *agg_hash_table,
+                                                 const noisepage::execution::sql::Integer *key,
+                                                 noisepage::byte *payload) {
+  agg_hash_table->InsertDense(*key, payload);
+}
+
 VM_OP_HOT void OpAggregationHashTableProcessBatch(
     noisepage::execution::sql::AggregationHashTable *const agg_hash_table,
     noisepage::execution::sql::VectorProjectionIterator *vpi, const uint32_t num_keys, const uint32_t key_cols[],
@@ -923,6 +1066,17 @@ VM_OP_HOT void OpCountAggregateAdvance(noisepage::execution::sql::CountAggregate
   agg->Advance(*val);
 }
 
+VM_OP_HOT void OpCountAggregateAdvanceVector(noisepage::execution::sql::CountAggregate *agg,
+                                             const noisepage::execution::sql::VectorProjectionIterator *vpi,
+                                             const uint32_t col_idx) {
+  agg->AdvanceVector(*vpi->GetVectorProjection()->GetColumn(col_idx));
+}
+
+VM_OP_HOT void OpCountAggregateAdvanceTuples(noisepage::execution::sql::CountAggregate *agg,
+                                             const noisepage::execution::sql::VectorProjectionIterator *vpi) {
+  agg->AdvanceTuples(vpi->GetSelectedTupleCount());
+}
+
 VM_OP_HOT void OpCountAggregateMerge(noisepage::execution::sql::CountAggregate *agg_1,
                                      const noisepage::execution::sql::CountAggregate *agg_2) {
   agg_1->Merge(*agg_2);
@@ -979,6 +1133,12 @@ VM_OP_HOT void OpIntegerSumAggregateAdvance(noisepage::execution::sql::IntegerSu
   agg->Advance(*val);
 }
 
+VM_OP_HOT void OpIntegerSumAggregateAdvanceVector(noisepage::execution::sql::IntegerSumAggregate *agg,
+                                                  const noisepage::execution::sql::VectorProjectionIterator *vpi,
+                                                  const uint32_t col_idx) {
+  agg->AdvanceVector(*vpi->GetVectorProjection()->GetColumn(col_idx));
+}
+
 VM_OP_HOT void OpIntegerSumAggregateMerge(noisepage::execution::sql::IntegerSumAggregate *agg_1,
                                           const noisepage::execution::sql::IntegerSumAggregate *agg_2) {
   agg_1->Merge(*agg_2);
@@ -1004,6 +1164,12 @@ VM_OP_HOT void OpRealSumAggregateAdvance(noisepage::execution::sql::RealSumAggre
   agg->Advance(*val);
 }
 
+VM_OP_HOT void OpRealSumAggregateAdvanceVector(noisepage::execution::sql::RealSumAggregate *agg,
+                                               const noisepage::execution::sql::VectorProjectionIterator *vpi,
+                                               const uint32_t col_idx) {
+  agg->AdvanceVector(*vpi->GetVectorProjection()->GetColumn(col_idx));
+}
+
 VM_OP_HOT void OpRealSumAggregateMerge(noisepage::execution::sql::RealSumAggregate *agg_1,
                                        const noisepage::execution::sql::RealSumAggregate *agg_2) {
   agg_1->Merge(*agg_2);
@@ -1031,6 +1197,12 @@ VM_OP_HOT void OpIntegerMaxAggregateAdvance(noisepage::execution::sql::IntegerMa
   agg->Advance(*val);
 }
 
+VM_OP_HOT void OpIntegerMaxAggregateAdvanceVector(noisepage::execution::sql::IntegerMaxAggregate *agg,
+                                                  const noisepage::execution::sql::VectorProjectionIterator *vpi,
+                                                  const uint32_t col_idx) {
+  agg->AdvanceVector(*vpi->GetVectorProjection()->GetColumn(col_idx));
+}
+
 VM_OP_HOT void OpIntegerMaxAggregateMerge(noisepage::execution::sql::IntegerMaxAggregate *agg_1,
                                           const noisepage::execution::sql::IntegerMaxAggregate *agg_2) {
   agg_1->Merge(*agg_2);
@@ -1056,6 +1228,12 @@ VM_OP_HOT void OpRealMaxAggregateAdvance(noisepage::execution::sql::RealMaxAggre
   agg->Advance(*val);
 }
 
+VM_OP_HOT void OpRealMaxAggregateAdvanceVector(noisepage::execution::sql::RealMaxAggregate *agg,
+                                               const noisepage::execution::sql::VectorProjectionIterator *vpi,
+                                               const uint32_t col_idx) {
+  agg->AdvanceVector(*vpi->GetVectorProjection()->GetColumn(col_idx));
+}
+
 VM_OP_HOT void OpRealMaxAggregateMerge(noisepage::execution::sql::RealMaxAggregate *agg_1,
                                        const noisepage::execution::sql::RealMaxAggregate *agg_2) {
   agg_1->Merge(*agg_2);
@@ -1131,6 +1309,12 @@ VM_OP_HOT void OpIntegerMinAggregateAdvance(noisepage::execution::sql::IntegerMi
   agg->Advance(*val);
 }
 
+VM_OP_HOT void OpIntegerMinAggregateAdvanceVector(noisepage::execution::sql::IntegerMinAggregate *agg,
+                                                  const noisepage::execution::sql::VectorProjectionIterator *vpi,
+                                                  const uint32_t col_idx) {
+  agg->AdvanceVector(*vpi->GetVectorProjection()->GetColumn(col_idx));
+}
+
 VM_OP_HOT void OpIntegerMinAggregateMerge(noisepage::execution::sql::IntegerMinAggregate *agg_1,
                                           const noisepage::execution::sql::IntegerMinAggregate *agg_2) {
   agg_1->Merge(*agg_2);
@@ -1156,6 +1340,12 @@ VM_OP_HOT void OpRealMinAggregateAdvance(noisepage::execution::sql::RealMinAggre
   agg->Advance(*val);
 }
 
+VM_OP_HOT void OpRealMinAggregateAdvanceVector(noisepage::execution::sql::RealMinAggregate *agg,
+                                               const noisepage::execution::sql::VectorProjectionIterator *vpi,
+                                               const uint32_t col_idx) {
+  agg->AdvanceVector(*vpi->GetVectorProjection()->GetColumn(col_idx));
+}
+
 VM_OP_HOT void OpRealMinAggregateMerge(noisepage::execution::sql::RealMinAggregate *agg_1,
                                        const noisepage::execution::sql::RealMinAggregate *agg_2) {
   agg_1->Merge(*agg_2);
@@ -1324,6 +1514,30 @@ VM_OP_HOT void OpJoinHashTableLookup(noisepage::execution::sql::JoinHashTable *j
   *ht_entry_iter = join_hash_table->Lookup<false>(hash_val);
 }
 
+VM_OP void OpJoinHashTableEnableSpilling(noisepage::execution::sql::JoinHashTable *join_hash_table,
+                                         uint32_t probe_tuple_size);
+
+VM_OP_HOT void OpJoinHashTableIsSpilled(bool *result, noisepage::execution::sql::JoinHashTable *join_hash_table,
+                                        const noisepage::hash_t hash_val) {
+  *result = join_hash_table->IsSpilled(hash_val);
+}
+
+VM_OP void OpJoinHashTableEnableRuntimeFilter(noisepage::execution::sql::JoinHashTable *join_hash_table);
+
+VM_OP void OpJoinHashTableEnableCompactLayout(noisepage::execution::sql::JoinHashTable *join_hash_table);
+
+VM_OP_HOT void OpJoinHashTableMayContain(bool *result, const noisepage::execution::sql::JoinHashTable *join_hash_table,
+                                         const noisepage::hash_t hash_val) {
+  *result = join_hash_table->MayContain(hash_val);
+}
+
+VM_OP void OpJoinHashTableSpillProbe(noisepage::execution::sql::JoinHashTable *join_hash_table,
+                                     noisepage::hash_t hash_val, const noisepage::byte *probe_tuple);
+
+VM_OP void OpJoinHashTableProcessSpilled(noisepage::execution::sql::JoinHashTable *join_hash_table, void *query_state,
+                                         void *pipeline_state,
+                                         noisepage::execution::sql::JoinHashTable::SpilledProbeFn probe_fn);
+
 VM_OP void OpJoinHashTableFree(noisepage::execution::sql::JoinHashTable *join_hash_table);
 
 VM_OP_HOT void OpHashTableEntryIteratorHasNext(bool *has_next,
@@ -1360,6 +1574,51 @@ VM_OP void OpSorterInit(noisepage::execution::sql::Sorter *sorter,
                         noisepage::execution::exec::ExecutionContext *exec_ctx,
                         noisepage::execution::sql::Sorter::ComparisonFunction cmp_fn, uint32_t tuple_size);
 
+VM_OP_HOT void OpSorterSetNormalizedKey(noisepage::execution::sql::Sorter *sorter,
+                                        noisepage::execution::sql::Sorter::NormalizedKeyFunction key_fn) {
+  sorter->SetNormalizedKeyFunction(key_fn);
+}
+
+// Normalized keys compare as unsigned integers in the same order as the values they encode. NULLs
+// get the largest key, so that they sort last like they do in Postgres.
+
+VM_OP_HOT void OpSorterNormalizeKeyInt(uint64_t *const result, const noisepage::execution::sql::Integer *const input) {
+  *result = input->is_null_ ? ~uint64_t{0} : static_cast<uint64_t>(input->val_) ^ (uint64_t{1} << 63u);
+}
+
+VM_OP_HOT void OpSorterNormalizeKeyBool(uint64_t *const result, const noisepage::execution::sql::BoolVal *const input) {
+  *result = input->is_null_ ? ~uint64_t{0} : static_cast<uint64_t>(input->val_);
+}
+
+VM_OP_HOT void OpSorterNormalizeKeyReal(uint64_t *const result, const noisepage::execution::sql::Real *const input) {
+  // Flip all bits of negative numbers and only the sign bit of positive ones
+  uint64_t bits;
+  std::memcpy(&bits, &input->val_, sizeof(bits));
+  bits = (bits >> 63u) != 0 ? ~bits : bits ^ (uint64_t{1} << 63u);
+  *result = input->is_null_ ? ~uint64_t{0} : bits;
+}
+
+VM_OP_HOT void OpSorterNormalizeKeyDate(uint64_t *const result, const noisepage::execution::sql::DateVal *const input) {
+  *result = input->is_null_ ? ~uint64_t{0} : static_cast<uint32_t>(input->val_.ToNative()) ^ 0x80000000u;
+}
+
+VM_OP_HOT void OpSorterNormalizeKeyTimestamp(uint64_t *const result,
+                                             const noisepage::execution::sql::TimestampVal *const input) {
+  *result = input->is_null_ ? ~uint64_t{0} : input->val_.ToNative();
+}
+
+VM_OP_HOT void OpSorterNormalizeKeyString(uint64_t *const result,
+                                          const noisepage::execution::sql::StringVal *const input) {
+  if (input->is_null_) {
+    *result = ~uint64_t{0};
+    return;
+  }
+  // The first eight bytes, read big-endian so that integer order matches memcmp order
+  uint64_t prefix = 0;
+  std::memcpy(&prefix, input->val_.Content(), std::min<std::size_t>(input->val_.Size(), sizeof(prefix)));
+  *result = be64toh(prefix);
+}
+
 VM_OP_HOT void OpSorterGetTupleCount(uint32_t *result, noisepage::execution::sql::Sorter *sorter) {
   *result = sorter->GetTupleCount();
 }
@@ -1377,6 +1636,15 @@ VM_OP_HOT void OpSorterAllocTupleTopKFinish(noisepage::execution::sql::Sorter *s
   sorter->AllocInputTupleTopKFinish(top_k);
 }
 
+VM_OP_HOT void OpSorterShareTopKBound(noisepage::execution::sql::Sorter *sorter,
+                                      noisepage::execution::sql::Sorter *other) {
+  sorter->ShareTopKBound(other);
+}
+
+VM_OP_HOT void OpSorterGetTopKBound(uint64_t *result, const noisepage::execution::sql::Sorter *sorter) {
+  *result = sorter->GetTopKBound();
+}
+
 VM_OP void OpSorterSort(noisepage::execution::sql::Sorter *sorter);
 
 VM_OP void OpSorterSortParallel(noisepage::execution::sql::Sorter *sorter,
@@ -1876,6 +2144,12 @@ VM_OP_WARM void OpIndexIteratorScanLimitDescending(noisepage::execution::sql::In
   iter->ScanLimitDescending(limit);
 }
 
+VM_OP_HOT void OpParallelScanIndex(noisepage::execution::sql::IndexIterator *iter,
+                                   noisepage::storage::index::ScanType scan_type, void *const query_state,
+                                   const noisepage::execution::sql::IndexIterator::ScanFn scanner) {
+  noisepage::execution::sql::IndexIterator::ParallelScan(iter, scan_type, query_state, scanner);
+}
+
 VM_OP_WARM void OpIndexIteratorAdvance(bool *has_more, noisepage::execution::sql::IndexIterator *iter) {
   *has_more = iter->Advance();
 }
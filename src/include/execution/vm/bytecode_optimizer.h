@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "execution/vm/bytecode_function_info.h"
+
+namespace noisepage::execution::vm {
+
+/**
+ * A lightweight optimizer for the bytecode the BytecodeGenerator emits. The generator translates the AST one node at a
+ * time, so its bytecode copies values into temporaries that are read once, loads the same value repeatedly, and jumps
+ * to jumps. The interpreter never sees LLVM's optimizations, so the optimizer cleans these up for it with a few passes
+ * over every function:
+ *  - Jumps to unconditional jumps are threaded to their final target, jumps to the next instruction are removed, and
+ *    so is code no jump reaches.
+ *  - Within a basic block, reads of a local copied from another local read the original (copy propagation), and
+ *    assignments of the value a local already holds are removed.
+ *  - Within a basic block, a second load of the same memory, e.g., the same column of a vector projection iterator, is
+ *    replaced with a copy of the first one.
+ *  - Stores to locals that are never read, or that are overwritten before they are read, are removed.
+ *
+ * Only locals whose address never escapes into a bytecode handler are rewritten, since the optimizer doesn't know what
+ * a handler does with a pointer. Loads are only reused while no instruction that may write memory runs in between.
+ */
+class BytecodeOptimizer {
+ public:
+  /**
+   * Optimize the bytecode of all functions in @em code in place, and update the bytecode range of every function.
+   * @param code The bytecode of all functions, stored contiguously.
+   * @param functions The functions whose bytecode is in @em code.
+   */
+  static void Optimize(std::vector<uint8_t> *code, std::vector<FunctionInfo> *functions);
+};
+
+}  // namespace noisepage::execution::vm
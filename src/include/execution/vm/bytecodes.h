@@ -106,9 +106,20 @@ namespace noisepage::execution::vm {
   F(ExecutionContextStartPipelineTracker, OperandType::Local, OperandType::Local)                                     \
   F(ExecutionContextEndPipelineTracker, OperandType::Local, OperandType::Local, OperandType::Local,                   \
     OperandType::Local)                                                                                               \
+  F(ExecutionContextStartPipelineProfile, OperandType::Local, OperandType::Local)                                     \
+  F(ExecutionContextEndPipelineProfile, OperandType::Local, OperandType::Local)                                       \
+  F(ExecutionContextRecordOperatorRows, OperandType::Local, OperandType::Local, OperandType::Local,                   \
+    OperandType::Local)                                                                                               \
+  F(ExecutionContextCheckCardinality, OperandType::Local, OperandType::Local, OperandType::Local)                     \
   F(ExecutionContextInitHooks, OperandType::Local, OperandType::Local)                                                \
   F(ExecutionContextRegisterHook, OperandType::Local, OperandType::Local, OperandType::FunctionId)                    \
   F(ExecutionContextClearHooks, OperandType::Local)                                                                   \
+  F(ExecutionContextCheckInterrupt, OperandType::Local)                                                               \
+  F(ExecutionContextScaleSampledCount, OperandType::Local, OperandType::Local, OperandType::Local)                    \
+  F(ExecutionContextScaleSampledDistinct, OperandType::Local, OperandType::Local, OperandType::Local,                 \
+    OperandType::Local)                                                                                               \
+  F(ExecutionContextAnalyzeColumnGroups, OperandType::Local, OperandType::Local, OperandType::Local,                  \
+    OperandType::Local)                                                                                               \
   F(ExecOUFeatureVectorRecordFeature, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local, \
     OperandType::Local, OperandType::Local)                                                                           \
   F(ExecOUFeatureVectorInitialize, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)    \
@@ -135,6 +146,12 @@ namespace noisepage::execution::vm {
   F(TableVectorIteratorFree, OperandType::Local)                                                                      \
   F(TableVectorIteratorGetVPINumTuples, OperandType::Local, OperandType::Local)                                       \
   F(TableVectorIteratorGetVPI, OperandType::Local, OperandType::Local)                                                \
+  F(TableVectorIteratorFilterBlocks, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)  \
+  F(TableVectorIteratorFilterBlocksTopK, OperandType::Local, OperandType::Local, OperandType::Local,                  \
+    OperandType::Local)                                                                                               \
+  F(TableVectorIteratorSampleBlocks, OperandType::Local, OperandType::Local)                                          \
+  F(TableVectorIteratorLateMaterialize, OperandType::Local, OperandType::Local)                                       \
+  F(TableVectorIteratorFetchLateColumns, OperandType::Local)                                                          \
   F(ParallelScanTable, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Local,                \
     OperandType::Local, OperandType::FunctionId)                                                                      \
                                                                                                                       \
@@ -203,6 +220,7 @@ namespace noisepage::execution::vm {
                                                                                                                       \
   /* Filter Manager */                                                                                                \
   F(FilterManagerInit, OperandType::Local, OperandType::Local)                                                        \
+  F(FilterManagerInitWithContext, OperandType::Local, OperandType::Local, OperandType::Local)                         \
   F(FilterManagerStartNewClause, OperandType::Local)                                                                  \
   F(FilterManagerInsertFilter, OperandType::Local, OperandType::FunctionId)                                           \
   F(FilterManagerRunFilters, OperandType::Local, OperandType::Local, OperandType::Local)                              \
@@ -242,6 +260,28 @@ namespace noisepage::execution::vm {
   F(VectorFilterNotLikeVal, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local,           \
     OperandType::Local)                                                                                               \
                                                                                                                       \
+  /* Vector Expression Executor */                                                                                    \
+  F(VectorProjectionInit, OperandType::Local, OperandType::Local, OperandType::UImm4)                                 \
+  F(VectorProjectionExtend, OperandType::Local, OperandType::Local)                                                   \
+  F(VectorProjectionFree, OperandType::Local)                                                                         \
+  F(VectorCast, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)                       \
+  F(VectorDatePart, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local,                   \
+    OperandType::Local)                                                                                               \
+  F(VectorAdd, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local,                        \
+    OperandType::Local)                                                                                               \
+  F(VectorAddVal, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local,                     \
+    OperandType::Local)                                                                                               \
+  F(VectorSub, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local,                        \
+    OperandType::Local)                                                                                               \
+  F(VectorSubVal, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local,                     \
+    OperandType::Local)                                                                                               \
+  F(VectorSubFromVal, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local,                 \
+    OperandType::Local)                                                                                               \
+  F(VectorMul, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local,                        \
+    OperandType::Local)                                                                                               \
+  F(VectorMulVal, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local,                     \
+    OperandType::Local)                                                                                               \
+                                                                                                                      \
   /* SQL value creation */                                                                                            \
   F(ForceBoolTruth, OperandType::Local, OperandType::Local)                                                           \
   F(InitSqlNull, OperandType::Local)                                                                                  \
@@ -250,6 +290,7 @@ namespace noisepage::execution::vm {
   F(InitInteger64, OperandType::Local, OperandType::Local)                                                            \
   F(InitReal, OperandType::Local, OperandType::Local)                                                                 \
   F(InitDate, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)                         \
+  F(InitDateFromJulianDay, OperandType::Local, OperandType::Local)                                                    \
   F(InitTimestamp, OperandType::Local, OperandType::Local)                                                            \
   F(InitTimestampYMDHMSMU, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local,            \
     OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)               \
@@ -342,8 +383,12 @@ namespace noisepage::execution::vm {
   F(AggregationHashTableAllocTuple, OperandType::Local, OperandType::Local, OperandType::Local)                       \
   F(AggregationHashTableAllocTuplePartitioned, OperandType::Local, OperandType::Local, OperandType::Local)            \
   F(AggregationHashTableLinkHashTableEntry, OperandType::Local, OperandType::Local)                                   \
+  F(AggregationHashTableInternStringKey, OperandType::Local, OperandType::Local)                                      \
   F(AggregationHashTableLookup, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::FunctionId,  \
     OperandType::Local)                                                                                               \
+  F(AggregationHashTableSetDenseDomain, OperandType::Local, OperandType::Local, OperandType::Local)                   \
+  F(AggregationHashTableLookupDense, OperandType::Local, OperandType::Local, OperandType::Local)                      \
+  F(AggregationHashTableInsertDense, OperandType::Local, OperandType::Local, OperandType::Local)                      \
   F(AggregationHashTableProcessBatch, OperandType::Local, OperandType::Local, OperandType::UImm4, OperandType::Local, \
     OperandType::FunctionId, OperandType::FunctionId, OperandType::Local)                                             \
   F(AggregationHashTableTransferPartitions, OperandType::Local, OperandType::Local, OperandType::Local,               \
@@ -368,6 +413,8 @@ namespace noisepage::execution::vm {
   /* COUNT Aggregates */                                                                                              \
   F(CountAggregateInit, OperandType::Local)                                                                           \
   F(CountAggregateAdvance, OperandType::Local, OperandType::Local)                                                    \
+  F(CountAggregateAdvanceVector, OperandType::Local, OperandType::Local, OperandType::UImm4)                          \
+  F(CountAggregateAdvanceTuples, OperandType::Local, OperandType::Local)                                              \
   F(CountAggregateMerge, OperandType::Local, OperandType::Local)                                                      \
   F(CountAggregateReset, OperandType::Local)                                                                          \
   F(CountAggregateGetResult, OperandType::Local, OperandType::Local)                                                  \
@@ -381,12 +428,14 @@ namespace noisepage::execution::vm {
   /* SUM Aggregates */                                                                                                \
   F(IntegerSumAggregateInit, OperandType::Local)                                                                      \
   F(IntegerSumAggregateAdvance, OperandType::Local, OperandType::Local)                                               \
+  F(IntegerSumAggregateAdvanceVector, OperandType::Local, OperandType::Local, OperandType::UImm4)                     \
   F(IntegerSumAggregateMerge, OperandType::Local, OperandType::Local)                                                 \
   F(IntegerSumAggregateReset, OperandType::Local)                                                                     \
   F(IntegerSumAggregateGetResult, OperandType::Local, OperandType::Local)                                             \
   F(IntegerSumAggregateFree, OperandType::Local)                                                                      \
   F(RealSumAggregateInit, OperandType::Local)                                                                         \
   F(RealSumAggregateAdvance, OperandType::Local, OperandType::Local)                                                  \
+  F(RealSumAggregateAdvanceVector, OperandType::Local, OperandType::Local, OperandType::UImm4)                        \
   F(RealSumAggregateMerge, OperandType::Local, OperandType::Local)                                                    \
   F(RealSumAggregateReset, OperandType::Local)                                                                        \
   F(RealSumAggregateGetResult, OperandType::Local, OperandType::Local)                                                \
@@ -394,12 +443,14 @@ namespace noisepage::execution::vm {
   /* MAX Aggregates */                                                                                                \
   F(IntegerMaxAggregateInit, OperandType::Local)                                                                      \
   F(IntegerMaxAggregateAdvance, OperandType::Local, OperandType::Local)                                               \
+  F(IntegerMaxAggregateAdvanceVector, OperandType::Local, OperandType::Local, OperandType::UImm4)                     \
   F(IntegerMaxAggregateMerge, OperandType::Local, OperandType::Local)                                                 \
   F(IntegerMaxAggregateReset, OperandType::Local)                                                                     \
   F(IntegerMaxAggregateGetResult, OperandType::Local, OperandType::Local)                                             \
   F(IntegerMaxAggregateFree, OperandType::Local)                                                                      \
   F(RealMaxAggregateInit, OperandType::Local)                                                                         \
   F(RealMaxAggregateAdvance, OperandType::Local, OperandType::Local)                                                  \
+  F(RealMaxAggregateAdvanceVector, OperandType::Local, OperandType::Local, OperandType::UImm4)                        \
   F(RealMaxAggregateMerge, OperandType::Local, OperandType::Local)                                                    \
   F(RealMaxAggregateReset, OperandType::Local)                                                                        \
   F(RealMaxAggregateGetResult, OperandType::Local, OperandType::Local)                                                \
@@ -419,12 +470,14 @@ namespace noisepage::execution::vm {
   /* MIN Aggregates */                                                                                                \
   F(IntegerMinAggregateInit, OperandType::Local)                                                                      \
   F(IntegerMinAggregateAdvance, OperandType::Local, OperandType::Local)                                               \
+  F(IntegerMinAggregateAdvanceVector, OperandType::Local, OperandType::Local, OperandType::UImm4)                     \
   F(IntegerMinAggregateMerge, OperandType::Local, OperandType::Local)                                                 \
   F(IntegerMinAggregateReset, OperandType::Local)                                                                     \
   F(IntegerMinAggregateGetResult, OperandType::Local, OperandType::Local)                                             \
   F(IntegerMinAggregateFree, OperandType::Local)                                                                      \
   F(RealMinAggregateInit, OperandType::Local)                                                                         \
   F(RealMinAggregateAdvance, OperandType::Local, OperandType::Local)                                                  \
+  F(RealMinAggregateAdvanceVector, OperandType::Local, OperandType::Local, OperandType::UImm4)                        \
   F(RealMinAggregateMerge, OperandType::Local, OperandType::Local)                                                    \
   F(RealMinAggregateReset, OperandType::Local)                                                                        \
   F(RealMinAggregateGetResult, OperandType::Local, OperandType::Local)                                                \
@@ -543,6 +596,13 @@ namespace noisepage::execution::vm {
   F(JoinHashTableBuild, OperandType::Local)                                                                           \
   F(JoinHashTableBuildParallel, OperandType::Local, OperandType::Local, OperandType::Local)                           \
   F(JoinHashTableLookup, OperandType::Local, OperandType::Local, OperandType::Local)                                  \
+  F(JoinHashTableEnableSpilling, OperandType::Local, OperandType::Local)                                              \
+  F(JoinHashTableIsSpilled, OperandType::Local, OperandType::Local, OperandType::Local)                               \
+  F(JoinHashTableSpillProbe, OperandType::Local, OperandType::Local, OperandType::Local)                              \
+  F(JoinHashTableEnableRuntimeFilter, OperandType::Local)                                                             \
+  F(JoinHashTableEnableCompactLayout, OperandType::Local)                                                             \
+  F(JoinHashTableMayContain, OperandType::Local, OperandType::Local, OperandType::Local)                              \
+  F(JoinHashTableProcessSpilled, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::FunctionId) \
   F(JoinHashTableFree, OperandType::Local)                                                                            \
   F(HashTableEntryIteratorHasNext, OperandType::Local, OperandType::Local)                                            \
   F(HashTableEntryIteratorGetRow, OperandType::Local, OperandType::Local)                                             \
@@ -554,10 +614,19 @@ namespace noisepage::execution::vm {
                                                                                                                       \
   /* Sorting */                                                                                                       \
   F(SorterInit, OperandType::Local, OperandType::Local, OperandType::FunctionId, OperandType::Local)                  \
+  F(SorterSetNormalizedKey, OperandType::Local, OperandType::FunctionId)                                              \
+  F(SorterNormalizeKeyInt, OperandType::Local, OperandType::Local)                                                    \
+  F(SorterNormalizeKeyBool, OperandType::Local, OperandType::Local)                                                   \
+  F(SorterNormalizeKeyReal, OperandType::Local, OperandType::Local)                                                   \
+  F(SorterNormalizeKeyDate, OperandType::Local, OperandType::Local)                                                   \
+  F(SorterNormalizeKeyTimestamp, OperandType::Local, OperandType::Local)                                              \
+  F(SorterNormalizeKeyString, OperandType::Local, OperandType::Local)                                                 \
   F(SorterGetTupleCount, OperandType::Local, OperandType::Local)                                                      \
   F(SorterAllocTuple, OperandType::Local, OperandType::Local)                                                         \
   F(SorterAllocTupleTopK, OperandType::Local, OperandType::Local, OperandType::Local)                                 \
   F(SorterAllocTupleTopKFinish, OperandType::Local, OperandType::Local)                                               \
+  F(SorterShareTopKBound, OperandType::Local, OperandType::Local)                                                     \
+  F(SorterGetTopKBound, OperandType::Local, OperandType::Local)                                                       \
   F(SorterSort, OperandType::Local)                                                                                   \
   F(SorterSortParallel, OperandType::Local, OperandType::Local, OperandType::Local)                                   \
   F(SorterSortTopKParallel, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::Local)           \
@@ -584,6 +653,7 @@ namespace noisepage::execution::vm {
   F(IndexIteratorScanAscending, OperandType::Local, OperandType::Local, OperandType::Local)                           \
   F(IndexIteratorScanDescending, OperandType::Local)                                                                  \
   F(IndexIteratorScanLimitDescending, OperandType::Local, OperandType::Local)                                         \
+  F(ParallelScanIndex, OperandType::Local, OperandType::Local, OperandType::Local, OperandType::FunctionId)          \
   F(IndexIteratorFree, OperandType::Local)                                                                            \
   F(IndexIteratorAdvance, OperandType::Local, OperandType::Local)                                                     \
   F(IndexIteratorGetPR, OperandType::Local, OperandType::Local)                                                       \
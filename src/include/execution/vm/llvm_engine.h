@@ -6,9 +6,11 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "common/macros.h"
 #include "execution/util/execution_common.h"
+#include "execution/vm/vm_defs.h"
 
 namespace noisepage::execution::ast {
 class Type;
@@ -53,7 +55,8 @@ class LLVMEngine {
   static void Shutdown();
 
   /**
-   * JIT compile a TPL bytecode module to native code
+   * JIT compile a TPL bytecode module to native code. Large modules are split into partitions of
+   * functions that don't refer to each other, which are compiled in parallel and linked together.
    * @param module The module to compile
    * @param options The compiler options
    * @return The JIT compiled module
@@ -125,10 +128,42 @@ class LLVMEngine {
      */
     const std::string &GetOutputObjectFileName() const { return output_file_name_; }
 
+    /**
+     * Set the maximum number of partitions a module is split into and compiled in parallel
+     * @param max_partitions the maximum number of partitions, 0 for one per available thread
+     * @return the updated object
+     */
+    CompilerOptions &SetMaxPartitions(uint32_t max_partitions) {
+      max_partitions_ = max_partitions;
+      return *this;
+    }
+
+    /**
+     * @return the maximum number of partitions, 0 for one per available thread
+     */
+    uint32_t GetMaxPartitions() const { return max_partitions_; }
+
+    /**
+     * Set the optimization pipeline to generate code with
+     * @param profile the optimization profile
+     * @return the updated object
+     */
+    CompilerOptions &SetOptimizationProfile(OptimizationProfile profile) {
+      profile_ = profile;
+      return *this;
+    }
+
+    /**
+     * @return the optimization pipeline to generate code with
+     */
+    OptimizationProfile GetOptimizationProfile() const { return profile_; }
+
    private:
     bool debug_{false};
     bool write_obj_file_{false};
     std::string output_file_name_;
+    uint32_t max_partitions_{0};
+    OptimizationProfile profile_{OptimizationProfile::Balanced};
   };
 
   // -------------------------------------------------------
@@ -154,6 +189,13 @@ class LLVMEngine {
      */
     explicit CompiledModule(std::unique_ptr<llvm::MemoryBuffer> object_code);
 
+    /**
+     * Construct a compiled module from the object files of its separately compiled partitions,
+     * which are linked together when the module is loaded.
+     * @param object_code The object files containing code for this module.
+     */
+    explicit CompiledModule(std::vector<std::unique_ptr<llvm::MemoryBuffer>> &&object_code);
+
     /**
      * This class cannot be copied or moved
      */
@@ -174,7 +216,13 @@ class LLVMEngine {
     /**
      * Return the size of the module's object code in-memory in bytes.
      */
-    std::size_t GetModuleObjectCodeSizeInBytes() const { return object_code_->getBufferSize(); }
+    std::size_t GetModuleObjectCodeSizeInBytes() const {
+      std::size_t size = 0;
+      for (const auto &object : object_code_) {
+        size += object->getBufferSize();
+      }
+      return size;
+    }
 
     /**
      * Load the given module @em module into memory. If this module has already
@@ -189,7 +237,7 @@ class LLVMEngine {
 
    private:
     bool loaded_;
-    std::unique_ptr<llvm::MemoryBuffer> object_code_;
+    std::vector<std::unique_ptr<llvm::MemoryBuffer>> object_code_;
     std::unique_ptr<TPLMemoryManager> memory_manager_;
     std::unordered_map<std::string, void *> functions_;
   };
@@ -206,16 +254,24 @@ class LLVMEngine {
     /**
      * Construct a settings instance from the relevant configuration parameters.
      * @param bytecode_handlers_path The path to the bytecode handlers bitcode file.
+     * @param write_perf_map Whether to list the JIT compiled functions in /tmp/perf-<pid>.map for perf.
      */
-    explicit Settings(std::string_view bytecode_handlers_path) : bytecode_handlers_path_{bytecode_handlers_path} {}
+    explicit Settings(std::string_view bytecode_handlers_path, bool write_perf_map = false)
+        : bytecode_handlers_path_{bytecode_handlers_path}, write_perf_map_{write_perf_map} {}
 
     /**
      * @return The path to the bytecode handlers bitcode file.
      */
     const std::string &GetBytecodeHandlersBcPath() const noexcept { return bytecode_handlers_path_; }
 
+    /**
+     * @return True if the JIT compiled functions are listed in /tmp/perf-<pid>.map, so that perf can name them.
+     */
+    bool ShouldWritePerfMap() const noexcept { return write_perf_map_; }
+
    private:
     const std::string bytecode_handlers_path_;
+    const bool write_perf_map_;
   };
 
   // -------------------------------------------------------
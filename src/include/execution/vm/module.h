@@ -32,8 +32,10 @@ class Module {
   /**
    * Create a TPL module using the given bytecode module as the initial implementation.
    * @param bytecode_module The bytecode module implementation.
+   * @param profile The optimization pipeline to use when compiling the module to machine code.
    */
-  explicit Module(std::unique_ptr<BytecodeModule> bytecode_module);
+  explicit Module(std::unique_ptr<BytecodeModule> bytecode_module,
+                  OptimizationProfile profile = OptimizationProfile::Balanced);
 
   /**
    * Construct a TPL module with the given bytecode and LLVM implementations.
@@ -99,6 +101,25 @@ class Module {
    */
   const BytecodeModule *GetBytecodeModule() const { return bytecode_module_.get(); }
 
+  /**
+   * @return The optimization pipeline used when compiling the module to machine code.
+   */
+  OptimizationProfile GetOptimizationProfile() const { return profile_; }
+
+  /**
+   * Record work the interpreter did on this module's bytecode, counted in function invocations and
+   * loop iterations. Once a module requested in adaptive mode has run hot enough, it is compiled
+   * in the background.
+   * @param hotness The number of invocations and loop iterations to record.
+   */
+  void RecordHotness(uint64_t hotness) const;
+
+  /**
+   * The number of function invocations and loop iterations interpreted in a module requested in
+   * adaptive mode before it is compiled to machine code.
+   */
+  static constexpr uint64_t ADAPTIVE_COMPILE_HOTNESS = 100000;
+
  private:
   friend class VM;                            // For the VM to access raw bytecode.
   friend class test::BytecodeTrampolineTest;  // For the tests to check private methods.
@@ -157,6 +178,9 @@ class Module {
   // The module containing compiled machine code for the TPL program.
   std::unique_ptr<LLVMEngine::CompiledModule> jit_module_;
 
+  // The optimization pipeline to compile the module with.
+  OptimizationProfile profile_{OptimizationProfile::Balanced};
+
   // Function pointers for all functions defined in the TPL program. Pointers
   // may point into bytecode stub functions (i.e., interpreted implementations),
   // or into compiled machine-code implementations.
@@ -168,6 +192,14 @@ class Module {
 
   // Flag to indicate if the JIT compilation has occurred.
   std::once_flag compiled_flag_;
+
+  // Set once a function of the module is requested in adaptive mode. Only such
+  // modules are compiled when they run hot.
+  std::atomic<bool> is_adaptive_{false};
+  // The interpreted invocations and loop iterations recorded so far, and
+  // whether they triggered a compilation already.
+  mutable std::atomic<uint64_t> hotness_{0};
+  mutable std::atomic<bool> compile_requested_{false};
 };
 
 // ---------------------------------------------------------
@@ -208,8 +240,31 @@ inline bool Module::GetFunction(const std::string &name, const ExecutionMode exe
 
   switch (exec_mode) {
     case ExecutionMode::Adaptive: {
-      CompileToMachineCodeAsync();
-      FALLTHROUGH;
+      // The module is compiled once the interpreter finds it hot. Every call
+      // checks for the compiled implementation, and trampolines switch to it
+      // too, so long-running steps swap in machine code at their next call
+      // into a function of the module.
+      is_adaptive_ = true;
+      *func = [this, func_info](ArgTypes... args) -> Ret {
+        void *raw_func = functions_[func_info->GetId()].load(std::memory_order_relaxed);
+        if (raw_func == GetBytecodeImpl(func_info->GetId())) {
+          if constexpr (std::is_void_v<Ret>) {
+            uint8_t arg_buffer[(0ul + ... + sizeof(args))];
+            detail::CopyAll(arg_buffer, args...);
+            VM::InvokeFunction(this, func_info->GetId(), arg_buffer);
+            return;
+          } else {  // NOLINT
+            Ret rv{};
+            uint8_t arg_buffer[sizeof(Ret *) + (0ul + ... + sizeof(args))];
+            detail::CopyAll(arg_buffer, &rv, args...);
+            VM::InvokeFunction(this, func_info->GetId(), arg_buffer);
+            return rv;
+          }
+        }
+        auto *jit_f = reinterpret_cast<Ret (*)(ArgTypes...)>(raw_func);
+        return jit_f(args...);
+      };
+      break;
     }
     case ExecutionMode::Interpret: {
       *func = [this, func_info](ArgTypes... args) -> Ret {
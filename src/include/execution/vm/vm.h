@@ -33,9 +33,15 @@ class VM {
   // Execute a call instruction
   const uint8_t *ExecuteCall(const uint8_t *ip, Frame *caller);
 
+  // Record a loop iteration, reporting the interpreted work to the module now
+  // and then so that hot modules are compiled while they run.
+  void RecordLoopIteration();
+
  private:
   // The module
   const Module *module_;
+  // The invocations and loop iterations not yet reported to the module.
+  uint64_t hotness_{1};
 };
 
 }  // namespace noisepage::execution::vm
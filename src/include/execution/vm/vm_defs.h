@@ -16,4 +16,19 @@ enum class ExecutionMode : uint8_t {
   Compiled
 };
 
+/**
+ * An enumeration of the optimization pipelines machine code can be generated with, trading
+ * compilation time for the quality of the generated code.
+ */
+enum class OptimizationProfile : uint8_t {
+  // Run a light pipeline for queries that touch few tuples, e.g., OLTP-style
+  // point queries, where compilation time dominates execution time.
+  FastCompile,
+  // Run the standard -O3 pipeline.
+  Balanced,
+  // Additionally inline aggressively and vectorize loops, for long-running
+  // analytical queries where execution time dominates compilation time.
+  MaxPerformance
+};
+
 }  // namespace noisepage::execution::vm
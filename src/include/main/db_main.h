@@ -1,20 +1,27 @@
 #pragma once
 
+#include <chrono>  // NOLINT
+#include <future>  // NOLINT
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "catalog/catalog.h"
 #include "common/action_context.h"
 #include "common/dedicated_thread_registry.h"
 #include "common/managed_pointer.h"
+#include "common/scoped_timer.h"
+#include "common/thread_placement.h"
+#include "loggers/common_logger.h"
 #include "messenger/messenger.h"
 #include "metrics/metrics_thread.h"
 #include "network/connection_handle_factory.h"
 #include "network/noisepage_server.h"
 #include "network/postgres/postgres_command_factory.h"
 #include "network/postgres/postgres_protocol_interpreter.h"
+#include "optimizer/statistics/auto_analyze_thread.h"
 #include "optimizer/statistics/stats_storage.h"
 #include "replication/primary_replication_manager.h"
 #include "replication/replica_replication_manager.h"
@@ -81,10 +88,12 @@ class DBMain {
      * rather than waiting until durable on disk and being invoked by the WAL worker. Doesn't make sense to set to true
      * if WAL is not enabled.
      * @param log_manager argument to the TransactionManager
+     * @param commit_batching argument to the TransactionManager
      */
     TransactionLayer(const common::ManagedPointer<storage::RecordBufferSegmentPool> buffer_segment_pool,
                      const bool gc_enabled, const bool wal_async_commit_enable,
-                     const common::ManagedPointer<storage::LogManager> log_manager) {
+                     const common::ManagedPointer<storage::LogManager> log_manager,
+                     const bool commit_batching = false) {
       NOISEPAGE_ASSERT(buffer_segment_pool != nullptr, "Need a buffer segment pool for Transaction layer.");
       NOISEPAGE_ASSERT(!wal_async_commit_enable || (wal_async_commit_enable && log_manager != DISABLED),
                        "Doesn't make sense to enable async commit without enabling logging.");
@@ -93,7 +102,7 @@ class DBMain {
           std::make_unique<transaction::DeferredActionManager>(common::ManagedPointer(timestamp_manager_));
       txn_manager_ = std::make_unique<transaction::TransactionManager>(
           common::ManagedPointer(timestamp_manager_), common::ManagedPointer(deferred_action_manager_),
-          buffer_segment_pool, gc_enabled, wal_async_commit_enable, log_manager);
+          buffer_segment_pool, gc_enabled, wal_async_commit_enable, log_manager, commit_batching);
     }
 
     /**
@@ -137,20 +146,27 @@ class DBMain {
      * @param use_gc enable GarbageCollector
      * @param log_manager needed for safe destruction of StorageLayer
      * @param empty_buffer_queue The common buffer queue that all empty buffers are pulled from and returned to.
+     * @param gc_num_threads argument to the GarbageCollector
+     * @param block_store_huge_pages argument to the BlockStore
+     * @param index_maintenance_interval argument to the GarbageCollector
      */
     StorageLayer(const common::ManagedPointer<TransactionLayer> txn_layer, const uint64_t block_store_size_limit,
                  const uint64_t block_store_reuse_limit, const bool use_gc,
                  const common::ManagedPointer<storage::LogManager> log_manager,
-                 std::unique_ptr<common::ConcurrentBlockingQueue<storage::BufferedLogWriter *>> empty_buffer_queue)
+                 std::unique_ptr<common::ConcurrentBlockingQueue<storage::BufferedLogWriter *>> empty_buffer_queue,
+                 const uint32_t gc_num_threads = 1, const bool block_store_huge_pages = false,
+                 const std::chrono::microseconds index_maintenance_interval = std::chrono::microseconds{0})
         : empty_buffer_queue_(std::move(empty_buffer_queue)),
           deferred_action_manager_(txn_layer->GetDeferredActionManager()),
           log_manager_(log_manager) {
       if (use_gc)
         garbage_collector_ = std::make_unique<storage::GarbageCollector>(txn_layer->GetTimestampManager(),
                                                                          txn_layer->GetDeferredActionManager(),
-                                                                         txn_layer->GetTransactionManager(), DISABLED);
+                                                                         txn_layer->GetTransactionManager(), DISABLED,
+                                                                         gc_num_threads, index_maintenance_interval);
 
-      block_store_ = std::make_unique<storage::BlockStore>(block_store_size_limit, block_store_reuse_limit);
+      block_store_ = std::make_unique<storage::BlockStore>(block_store_size_limit, block_store_reuse_limit,
+                                                           block_store_huge_pages);
     }
 
     ~StorageLayer() {
@@ -287,17 +303,20 @@ class DBMain {
      * @param port argument to TerrierServer
      * @param connection_thread_count argument to TerrierServer
      * @param socket_directory argument to TerrierServer
+     * @param worker_thread_count argument to TerrierServer
+     * @param reuse_port argument to TerrierServer
      */
     NetworkLayer(const common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
                  const common::ManagedPointer<trafficcop::TrafficCop> traffic_cop, const uint16_t port,
-                 const uint16_t connection_thread_count, const std::string &socket_directory) {
+                 const uint16_t connection_thread_count, const std::string &socket_directory,
+                 const uint16_t worker_thread_count, const bool reuse_port) {
       connection_handle_factory_ = std::make_unique<network::ConnectionHandleFactory>(traffic_cop);
       command_factory_ = std::make_unique<network::PostgresCommandFactory>();
       provider_ =
           std::make_unique<network::PostgresProtocolInterpreter::Provider>(common::ManagedPointer(command_factory_));
       server_ = std::make_unique<network::TerrierServer>(
           common::ManagedPointer(provider_), common::ManagedPointer(connection_handle_factory_), thread_registry, port,
-          connection_thread_count, socket_directory);
+          connection_thread_count, socket_directory, worker_thread_count, reuse_port);
     }
 
     /**
@@ -321,8 +340,10 @@ class DBMain {
    public:
     /**
      * @param bytecode_handlers_path path to the bytecode handlers bitcode file
+     * @param jit_perf_map true if functions compiled by LLVM should be written to the perf map of the process
+     * @param sampling_profiler_hz samples per second of the SamplingProfiler, 0 to not start it
      */
-    explicit ExecutionLayer(const std::string &bytecode_handlers_path);
+    ExecutionLayer(const std::string &bytecode_handlers_path, bool jit_perf_map, uint32_t sampling_profiler_hz);
     ~ExecutionLayer();
   };
 
@@ -364,26 +385,68 @@ class DBMain {
       // ordering so things get destructed in the right order.
       auto db_main = std::make_unique<DBMain>();
 
+      // How long every phase of the startup took, in microseconds, for slow startups to be diagnosable from the log
+      std::vector<std::pair<std::string, uint64_t>> startup_timings;
+      const auto startup_start = std::chrono::steady_clock::now();
+      auto phase_start = startup_start;
+      const auto end_phase = [&startup_timings, &phase_start](const char *phase) {
+        const auto now = std::chrono::steady_clock::now();
+        startup_timings.emplace_back(
+            phase, std::chrono::duration_cast<std::chrono::microseconds>(now - phase_start).count());
+        phase_start = now;
+      };
+
       std::unique_ptr<settings::SettingsManager> settings_manager =
           use_settings_manager_ ? BootstrapSettingsManager(common::ManagedPointer(db_main)) : DISABLED;
 
+      // Replication ships a single log stream to the replicas, which would miss the records of every other stream
+      if (use_replication_ && use_logging_ && network_identity_ == "primary" && wal_num_streams_ > 1) {
+        throw SETTINGS_EXCEPTION(
+            fmt::format("wal_num_streams is {}, but a primary with replication_enable can only write 1 log stream",
+                        wal_num_streams_),
+            common::ErrorCode::ERRCODE_INVALID_PARAMETER_VALUE);
+      }
+
       std::unique_ptr<metrics::MetricsManager> metrics_manager = DISABLED;
       if (use_metrics_) metrics_manager = BootstrapMetricsManager();
 
+      std::unique_ptr<common::ThreadPlacement> thread_placement = DISABLED;
+      if (!thread_policies_.empty()) {
+        thread_placement = std::make_unique<common::ThreadPlacement>();
+        for (const auto &[role, policy] : thread_policies_) thread_placement->SetPolicy(role, policy);
+        // Threads that are started from here on without a role, like the execution workers, inherit these CPUs
+        thread_placement->Apply(common::ThreadRole::OTHER);
+      }
+
+      // Initializing the execution engine (LLVM and the bytecode handlers) only depends on the configuration, so it
+      // runs alongside the rest of the startup, notably the catalog bootstrap, until the TrafficCop needs it. If the
+      // startup throws in the meantime, the future's destructor waits for the initialization and tears it down again.
+      uint64_t execution_init_us = 0;
+      std::future<std::unique_ptr<ExecutionLayer>> execution_layer_future;
+      if (use_execution_) {
+        execution_layer_future = std::async(std::launch::async, [this, &execution_init_us] {
+          common::ScopedTimer<std::chrono::microseconds> timer(&execution_init_us);
+          return std::make_unique<ExecutionLayer>(bytecode_handlers_path_, jit_perf_map_, sampling_profiler_hz_);
+        });
+      }
+
       std::unique_ptr<metrics::MetricsThread> metrics_thread = DISABLED;
       if (use_metrics_thread_) {
         NOISEPAGE_ASSERT(use_metrics_ && metrics_manager != DISABLED,
                          "Can't have a MetricsThread without a MetricsManager.");
         metrics_thread = std::make_unique<metrics::MetricsThread>(common::ManagedPointer(metrics_manager),
-                                                                  std::chrono::microseconds{metrics_interval_});
+                                                                  std::chrono::microseconds{metrics_interval_},
+                                                                  common::ManagedPointer(thread_placement));
       }
 
       std::unique_ptr<common::DedicatedThreadRegistry> thread_registry = DISABLED;
       if (use_thread_registry_ || use_logging_ || use_network_)
-        thread_registry = std::make_unique<common::DedicatedThreadRegistry>(common::ManagedPointer(metrics_manager));
+        thread_registry = std::make_unique<common::DedicatedThreadRegistry>(common::ManagedPointer(metrics_manager),
+                                                                            common::ManagedPointer(thread_placement));
 
       auto buffer_segment_pool =
           std::make_unique<storage::RecordBufferSegmentPool>(record_buffer_segment_size_, record_buffer_segment_reuse_);
+      end_phase("settings and metrics");
 
       std::unique_ptr<MessengerLayer> messenger_layer = DISABLED;
       std::unique_ptr<replication::ReplicationManager> replication_manager = DISABLED;
@@ -400,7 +463,7 @@ class DBMain {
         if (network_identity_ == "primary") {
           replication_manager = std::make_unique<replication::PrimaryReplicationManager>(
               messenger_layer->GetMessenger(), network_identity_, replication_port_, replication_hosts_path_,
-              common::ManagedPointer(empty_buffer_queue));
+              common::ManagedPointer(empty_buffer_queue), replication_quorum_size_, checkpoint_path_);
         } else {
           replication_manager = std::make_unique<replication::ReplicaReplicationManager>(
               messenger_layer->GetMessenger(), network_identity_, replication_port_, replication_hosts_path_,
@@ -408,6 +471,8 @@ class DBMain {
         }
       }
 
+      end_phase("messenger and replication");
+
       std::unique_ptr<storage::LogManager> log_manager = DISABLED;
       if (use_logging_) {
         auto rep_manager_ptr = network_identity_ == "primary"
@@ -418,17 +483,23 @@ class DBMain {
             wal_file_path_, wal_num_buffers_, std::chrono::microseconds{wal_serialization_interval_},
             std::chrono::microseconds{wal_persist_interval_}, wal_persist_threshold_,
             common::ManagedPointer(buffer_segment_pool), common::ManagedPointer(empty_buffer_queue), rep_manager_ptr,
-            common::ManagedPointer(thread_registry));
+            common::ManagedPointer(thread_registry), wal_num_streams_, wal_preallocation_size_,
+            wal_compression_enable_, wal_segment_size_, wal_ring_path_, wal_ring_size_);
         log_manager->Start();
       }
+      end_phase("log manager");
 
       auto txn_layer =
           std::make_unique<TransactionLayer>(common::ManagedPointer(buffer_segment_pool), use_gc_,
-                                             wal_async_commit_enable_, common::ManagedPointer(log_manager));
+                                             wal_async_commit_enable_, common::ManagedPointer(log_manager),
+                                             txn_commit_batching_);
 
       auto storage_layer =
           std::make_unique<StorageLayer>(common::ManagedPointer(txn_layer), block_store_size_, block_store_reuse_,
-                                         use_gc_, common::ManagedPointer(log_manager), std::move(empty_buffer_queue));
+                                         use_gc_, common::ManagedPointer(log_manager), std::move(empty_buffer_queue),
+                                         gc_num_threads_, block_store_huge_pages_,
+                                         std::chrono::microseconds{index_maintenance_interval_});
+      end_phase("transactions and storage");
 
       std::unique_ptr<CatalogLayer> catalog_layer = DISABLED;
       if (use_catalog_) {
@@ -438,6 +509,7 @@ class DBMain {
             std::make_unique<CatalogLayer>(common::ManagedPointer(txn_layer), common::ManagedPointer(storage_layer),
                                            common::ManagedPointer(log_manager), create_default_database_);
       }
+      end_phase("catalog bootstrap");
 
       std::unique_ptr<storage::RecoveryManager> recovery_manager = DISABLED;
       if (use_replication_) {
@@ -449,17 +521,34 @@ class DBMain {
         recovery_manager = std::make_unique<storage::RecoveryManager>(
             log_provider, catalog_layer->GetCatalog(), txn_layer->GetTransactionManager(),
             txn_layer->GetDeferredActionManager(), common::ManagedPointer(replication_manager),
-            common::ManagedPointer(thread_registry), common::ManagedPointer(storage_layer->GetBlockStore()));
+            common::ManagedPointer(thread_registry), common::ManagedPointer(storage_layer->GetBlockStore()),
+            recovery_replay_threads_);
+        if (replication_manager->IsReplica() && replication_checkpoint_catchup_) {
+          // Load the user tables from the primary's latest checkpoint instead of replaying their changes up to it
+          auto checkpoint = replication_manager->GetAsReplica()->RequestCheckpoint(checkpoint_path_);
+          if (checkpoint.has_value()) recovery_manager->SetCheckpoint(std::move(*checkpoint));
+        }
+        if (replication_manager->IsReplica() && !logical_decoding_subscriber_.empty()) {
+          // Stream the row changes that the replica applies to the subscriber, for change data capture
+          auto replica = replication_manager->GetAsReplica();
+          recovery_manager->SetLogicalDecoder(std::make_unique<storage::LogicalDecoder>(
+              logical_decoding_batch_size_,
+              [replica, subscriber = logical_decoding_subscriber_](transaction::timestamp_t last_txn_id,
+                                                                   std::string changes) {
+                replica->SendChangeBatch(subscriber, last_txn_id, std::move(changes));
+              }));
+        }
         recovery_manager->StartRecovery();
       }
+      end_phase("recovery");
 
       std::unique_ptr<storage::GarbageCollectorThread> gc_thread = DISABLED;
       if (use_gc_thread_) {
         NOISEPAGE_ASSERT(use_gc_ && storage_layer->GetGarbageCollector() != DISABLED,
                          "GarbageCollectorThread needs GarbageCollector.");
-        gc_thread = std::make_unique<storage::GarbageCollectorThread>(storage_layer->GetGarbageCollector(),
-                                                                      std::chrono::microseconds{gc_interval_},
-                                                                      common::ManagedPointer(metrics_manager));
+        gc_thread = std::make_unique<storage::GarbageCollectorThread>(
+            storage_layer->GetGarbageCollector(), std::chrono::microseconds{gc_interval_},
+            common::ManagedPointer(metrics_manager), common::ManagedPointer(thread_placement));
       }
 
       std::unique_ptr<optimizer::StatsStorage> stats_storage = DISABLED;
@@ -467,10 +556,14 @@ class DBMain {
         stats_storage = std::make_unique<optimizer::StatsStorage>();
       }
 
+      end_phase("garbage collector and statistics");
+
       std::unique_ptr<ExecutionLayer> execution_layer = DISABLED;
       if (use_execution_) {
-        execution_layer = std::make_unique<ExecutionLayer>(bytecode_handlers_path_);
+        execution_layer = execution_layer_future.get();
+        startup_timings.emplace_back("execution engine (in parallel)", execution_init_us);
       }
+      end_phase("waiting for the execution engine");
 
       std::unique_ptr<trafficcop::TrafficCop> traffic_cop = DISABLED;
       if (use_traffic_cop_) {
@@ -482,22 +575,40 @@ class DBMain {
             txn_layer->GetTransactionManager(), catalog_layer->GetCatalog(),
             common::ManagedPointer(replication_manager), common::ManagedPointer(recovery_manager),
             common::ManagedPointer(settings_manager), common::ManagedPointer(stats_storage), optimizer_timeout_,
-            use_query_cache_, execution_mode_);
+            use_query_cache_, execution_mode_, result_cache_size_,
+            txn_serializable_ ? transaction::IsolationLevel::SERIALIZABLE : transaction::IsolationLevel::SNAPSHOT);
+      }
+
+      std::unique_ptr<optimizer::AutoAnalyzeThread> auto_analyze_thread = DISABLED;
+      if (use_auto_analyze_) {
+        NOISEPAGE_ASSERT(use_catalog_ && catalog_layer->GetCatalog() != DISABLED,
+                         "AutoAnalyzeThread needs the CatalogLayer.");
+        NOISEPAGE_ASSERT(use_stats_storage_ && stats_storage != DISABLED, "AutoAnalyzeThread needs StatsStorage.");
+        NOISEPAGE_ASSERT(use_execution_ && execution_layer != DISABLED, "AutoAnalyzeThread needs ExecutionLayer.");
+        NOISEPAGE_ASSERT(use_gc_thread_, "AutoAnalyzeThread needs the GarbageCollectorThread to count modifications.");
+        auto_analyze_thread = std::make_unique<optimizer::AutoAnalyzeThread>(
+            catalog_layer->GetCatalog(), txn_layer->GetTransactionManager(), common::ManagedPointer(stats_storage),
+            common::ManagedPointer(settings_manager), std::chrono::microseconds{auto_analyze_interval_},
+            auto_analyze_threshold_, auto_analyze_scale_factor_, optimizer_timeout_);
       }
 
       std::unique_ptr<NetworkLayer> network_layer = DISABLED;
       if (use_network_) {
         NOISEPAGE_ASSERT(use_traffic_cop_ && traffic_cop != DISABLED, "NetworkLayer needs TrafficCopLayer.");
-        network_layer =
-            std::make_unique<NetworkLayer>(common::ManagedPointer(thread_registry), common::ManagedPointer(traffic_cop),
-                                           network_port_, connection_thread_count_, uds_file_directory_);
+        network_layer = std::make_unique<NetworkLayer>(
+            common::ManagedPointer(thread_registry), common::ManagedPointer(traffic_cop), network_port_,
+            connection_thread_count_, uds_file_directory_, network_worker_thread_count_, network_reuse_port_);
       }
+      end_phase("traffic cop and network");
 
       std::unique_ptr<modelserver::ModelServerManager> model_server_manager = DISABLED;
       if (use_model_server_) {
         NOISEPAGE_ASSERT(use_messenger_, "Pilot requires messenger layer.");
         model_server_manager = std::make_unique<modelserver::ModelServerManager>(
             model_server_path_, messenger_layer->GetMessenger(), model_server_enable_python_coverage_);
+        if (use_traffic_cop_) {
+          traffic_cop->SetModelServerManager(common::ManagedPointer(model_server_manager), model_save_path_);
+        }
       }
 
       std::unique_ptr<selfdriving::PilotThread> pilot_thread = DISABLED;
@@ -513,13 +624,15 @@ class DBMain {
             common::ManagedPointer(pilot), std::chrono::microseconds{pilot_interval_},
             std::chrono::microseconds{forecast_train_interval_}, pilot_planning_);
       }
+      end_phase("model server and pilot");
 
       // If replication is enabled, configure the replication policy for all transactions.
       if (use_replication_) {
         if (replication_manager->IsPrimary()) {
-          // On the primary, perform synchronous replication by default.
+          // On the primary, perform synchronous replication by default, or wait for a quorum to receive the logs.
           txn_layer->GetTransactionManager()->SetDefaultTransactionReplicationPolicy(
-              transaction::ReplicationPolicy::SYNC);
+              replication_quorum_size_ > 0 ? transaction::ReplicationPolicy::QUORUM
+                                           : transaction::ReplicationPolicy::SYNC);
         } else {
           // On a replica, do not replicate any buffers by default.
           txn_layer->GetTransactionManager()->SetDefaultTransactionReplicationPolicy(
@@ -533,7 +646,20 @@ class DBMain {
                                      transaction::ReplicationPolicyToString(default_txn_policy.replication_)));
       }
 
+      {
+        const auto total_us =
+            std::chrono::duration_cast<std::chrono::microseconds>(phase_start - startup_start).count();
+        std::string summary = fmt::format("Startup took {:.1f} ms:", static_cast<double>(total_us) / 1000);
+        for (const auto &[phase, elapsed_us] : startup_timings) {
+          summary += fmt::format(" {} {:.1f} ms,", phase, static_cast<double>(elapsed_us) / 1000);
+        }
+        summary.pop_back();
+        COMMON_LOG_INFO(summary);
+      }
+
+      db_main->startup_timings_ = std::move(startup_timings);
       db_main->settings_manager_ = std::move(settings_manager);
+      db_main->thread_placement_ = std::move(thread_placement);
       db_main->metrics_manager_ = std::move(metrics_manager);
       db_main->metrics_thread_ = std::move(metrics_thread);
       db_main->thread_registry_ = std::move(thread_registry);
@@ -547,6 +673,7 @@ class DBMain {
       db_main->stats_storage_ = std::move(stats_storage);
       db_main->execution_layer_ = std::move(execution_layer);
       db_main->traffic_cop_ = std::move(traffic_cop);
+      db_main->auto_analyze_thread_ = std::move(auto_analyze_thread);
       db_main->network_layer_ = std::move(network_layer);
       db_main->pilot_thread_ = std::move(pilot_thread);
       db_main->pilot_ = std::move(pilot);
@@ -611,6 +738,24 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value where the MetricsManager writes metrics: "csv", "binary" or "ring_buffer"
+     * @return self reference for chaining
+     */
+    Builder &SetMetricsSink(std::string value) {
+      metrics_sink_ = std::move(value);
+      return *this;
+    }
+
+    /**
+     * @param value number of rows per output that a ring buffer metrics sink keeps
+     * @return self reference for chaining
+     */
+    Builder &SetMetricsRingBufferRows(const uint32_t value) {
+      metrics_ring_buffer_rows_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -629,6 +774,34 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value TransactionManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetTxnCommitBatching(const bool value) {
+      txn_commit_batching_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value TrafficCop argument, true if client transactions run at IsolationLevel::SERIALIZABLE unless they ask
+     * otherwise. Internal transactions always run at snapshot isolation.
+     * @return self reference for chaining
+     */
+    Builder &SetTxnSerializable(const bool value) {
+      txn_serializable_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetWalCompression(const bool value) {
+      wal_compression_enable_ = value;
+      return *this;
+    }
+
     /**
      * @param value LogManager argument
      * @return self reference for chaining
@@ -638,6 +811,15 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetWalNumStreams(const uint32_t value) {
+      wal_num_streams_ = value;
+      return *this;
+    }
+
     /**
      * @param value LogManager argument
      * @return self reference for chaining
@@ -647,6 +829,60 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value RecoveryManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetRecoveryReplayThreads(const uint32_t value) {
+      recovery_replay_threads_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value PrimaryReplicationManager argument, 0 for synchronous replication
+     * @return self reference for chaining
+     */
+    Builder &SetReplicationQuorumSize(const uint32_t value) {
+      replication_quorum_size_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value directory of the checkpoints that the primary ships to replicas and replicas receive them in
+     * @return self reference for chaining
+     */
+    Builder &SetCheckpointPath(std::string value) {
+      checkpoint_path_ = std::move(value);
+      return *this;
+    }
+
+    /**
+     * @param value whether a replica starts from the primary's latest checkpoint
+     * @return self reference for chaining
+     */
+    Builder &SetReplicationCheckpointCatchup(const bool value) {
+      replication_checkpoint_catchup_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value node that a replica streams the row changes it applies to, empty to disable
+     * @return self reference for chaining
+     */
+    Builder &SetLogicalDecodingSubscriber(std::string value) {
+      logical_decoding_subscriber_ = std::move(value);
+      return *this;
+    }
+
+    /**
+     * @param value number of row changes after which a replica sends a batch of them to the subscriber
+     * @return self reference for chaining
+     */
+    Builder &SetLogicalDecodingBatchSize(const uint32_t value) {
+      logical_decoding_batch_size_ = value;
+      return *this;
+    }
+
     /**
      * @param value LogManager argument
      * @return self reference for chaining
@@ -665,6 +901,42 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetWalPreallocationSize(const uint64_t value) {
+      wal_preallocation_size_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetWalSegmentSize(const uint64_t value) {
+      wal_segment_size_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetWalRingPath(const std::string &value) {
+      wal_ring_path_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value LogManager argument
+     * @return self reference for chaining
+     */
+    Builder &SetWalRingSize(const uint64_t value) {
+      wal_ring_size_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -701,6 +973,24 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value GarbageCollector argument
+     * @return self reference for chaining
+     */
+    Builder &SetGCNumThreads(const uint32_t value) {
+      gc_num_threads_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value GarbageCollector argument, interval (us) of the background maintenance of indexes, 0 to disable
+     * @return self reference for chaining
+     */
+    Builder &SetIndexMaintenanceInterval(const int32_t value) {
+      index_maintenance_interval_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -719,6 +1009,42 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value use component
+     * @return self reference for chaining
+     */
+    Builder &SetUseAutoAnalyze(const bool value) {
+      use_auto_analyze_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value AutoAnalyzeThread argument, interval (us) between two checks of the tables
+     * @return self reference for chaining
+     */
+    Builder &SetAutoAnalyzeInterval(const uint64_t value) {
+      auto_analyze_interval_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value AutoAnalyzeThread argument, number of modified tuples that triggers an ANALYZE
+     * @return self reference for chaining
+     */
+    Builder &SetAutoAnalyzeThreshold(const uint64_t value) {
+      auto_analyze_threshold_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value AutoAnalyzeThread argument, fraction of the rows that has to be modified to trigger an ANALYZE
+     * @return self reference for chaining
+     */
+    Builder &SetAutoAnalyzeScaleFactor(const double value) {
+      auto_analyze_scale_factor_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -755,6 +1081,24 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value TerrierServer argument, threads that execute the queries, 0 to execute them on the handler threads
+     * @return self reference for chaining
+     */
+    Builder &SetNetworkWorkerThreadCount(const uint16_t value) {
+      network_worker_thread_count_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value TerrierServer argument, whether every handler thread gets its own socket with SO_REUSEPORT
+     * @return self reference for chaining
+     */
+    Builder &SetNetworkReusePort(const bool value) {
+      network_reuse_port_ = value;
+      return *this;
+    }
+
     /**
      * @param port Messenger port
      * @return self reference for chaining
@@ -800,6 +1144,15 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value BlockStore argument
+     * @return self reference for chaining
+     */
+    Builder &SetBlockStoreHugePages(const bool value) {
+      block_store_huge_pages_ = value;
+      return *this;
+    }
+
     /**
      * @param value TrafficCop argument
      * @return self reference for chaining
@@ -818,6 +1171,15 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value bytes of query results the traffic cop caches, 0 to disable the cache
+     * @return self reference for chaining
+     */
+    Builder &SetResultCacheSize(const uint64_t value) {
+      result_cache_size_ = value;
+      return *this;
+    }
+
     /**
      * @param value use component
      * @return self reference for chaining
@@ -872,6 +1234,34 @@ class DBMain {
       return *this;
     }
 
+    /**
+     * @param value true if functions compiled by LLVM should be written to the perf map of the process
+     * @return self reference for chaining
+     */
+    Builder &SetJitPerfMap(const bool value) {
+      jit_perf_map_ = value;
+      return *this;
+    }
+
+    /**
+     * @param value samples per second of CPU time of the SamplingProfiler, 0 to disable it
+     * @return self reference for chaining
+     */
+    Builder &SetSamplingProfilerHz(const uint32_t value) {
+      sampling_profiler_hz_ = value;
+      return *this;
+    }
+
+    /**
+     * @param role role of the threads to place
+     * @param policy which CPUs the threads of the role run on, and with which priority
+     * @return self reference for chaining
+     */
+    Builder &SetThreadPlacementPolicy(const common::ThreadRole role, common::ThreadPlacement::Policy policy) {
+      thread_policies_.emplace_back(role, std::move(policy));
+      return *this;
+    }
+
    private:
     std::unordered_map<settings::Param, settings::ParamInfo> param_map_;
 
@@ -885,21 +1275,33 @@ class DBMain {
     uint64_t record_buffer_segment_size_ = 1e5;
     uint64_t record_buffer_segment_reuse_ = 1e4;
     uint64_t wal_num_buffers_ = 100;
+    uint32_t wal_num_streams_ = 1;
     uint64_t wal_persist_threshold_ = static_cast<uint64_t>(1 << 20);
+    uint64_t wal_preallocation_size_ = 0;
+    uint64_t wal_segment_size_ = 0;
+    uint64_t wal_ring_size_ = static_cast<uint64_t>(1 << 24);
     uint64_t pilot_interval_ = 1e7;
     uint64_t forecast_train_interval_ = 120e7;
     uint64_t workload_forecast_interval_ = 1e7;
     uint64_t block_store_size_ = 1e5;
     uint64_t block_store_reuse_ = 1e3;
+    bool block_store_huge_pages_ = false;
     uint64_t optimizer_timeout_ = 5000;
+    uint64_t auto_analyze_interval_ = 6e7;
+    uint64_t auto_analyze_threshold_ = 50;
+    double auto_analyze_scale_factor_ = 0.1;
 
     std::string wal_file_path_ = "wal.log";
+    std::string wal_ring_path_;
     std::string model_save_path_;
     std::string forecast_model_save_path_;
     std::string bytecode_handlers_path_ = "./bytecode_handlers_ir.bc";
     std::string network_identity_ = "primary";
     std::string uds_file_directory_ = "/tmp/";
     std::string replication_hosts_path_ = "./replication.config";
+    std::string checkpoint_path_ = "./checkpoints";
+    std::string logical_decoding_subscriber_;
+    uint32_t logical_decoding_batch_size_ = 1024;
     /**
      * The ModelServer script is located at PROJECT_ROOT/script/model by default, and also assume
      * the build binary at PROJECT_ROOT/build/bin/noisepage. This should be override or set explicitly
@@ -921,31 +1323,49 @@ class DBMain {
     bool gc_metrics_ = false;
     bool bind_command_metrics_ = false;
     bool execute_command_metrics_ = false;
+    bool replication_metrics_ = false;
+    std::string metrics_sink_ = "csv";
+    uint32_t metrics_ring_buffer_rows_ = 100000;
 
     int32_t wal_serialization_interval_ = 100;
     int32_t wal_persist_interval_ = 100;
     int32_t gc_interval_ = 1000;
+    uint32_t gc_num_threads_ = 1;
+    int32_t index_maintenance_interval_ = 0;
 
     uint16_t connection_thread_count_ = 4;
+    uint16_t network_worker_thread_count_ = 0;
     uint16_t network_port_ = 15721;
     uint16_t messenger_port_ = 9022;
     uint16_t replication_port_ = 15445;
+    uint32_t recovery_replay_threads_ = 1;
+    uint32_t replication_quorum_size_ = 0;
 
     execution::vm::ExecutionMode execution_mode_ = execution::vm::ExecutionMode::Interpret;
+    uint32_t sampling_profiler_hz_ = 0;
+    bool jit_perf_map_ = false;
+    std::vector<std::pair<common::ThreadRole, common::ThreadPlacement::Policy>> thread_policies_;
 
+    bool network_reuse_port_ = false;
     bool use_logging_ = false;
     bool wal_async_commit_enable_ = false;
+    bool txn_commit_batching_ = false;
+    bool txn_serializable_ = false;
+    bool wal_compression_enable_ = false;
     bool use_gc_ = false;
     bool use_catalog_ = false;
     bool create_default_database_ = true;
     bool use_gc_thread_ = false;
     bool use_stats_storage_ = false;
+    bool use_auto_analyze_ = false;
     bool use_execution_ = false;
     bool use_traffic_cop_ = false;
     bool use_query_cache_ = true;
+    uint64_t result_cache_size_ = 0;
     bool use_network_ = false;
     bool use_messenger_ = false;
     bool use_replication_ = false;
+    bool replication_checkpoint_catchup_ = false;
     bool use_model_server_ = false;
     bool model_server_enable_python_coverage_ = false;
     bool use_pilot_thread_ = false;
@@ -966,16 +1386,27 @@ class DBMain {
           static_cast<uint64_t>(settings_manager->GetInt(settings::Param::record_buffer_segment_reuse));
       block_store_size_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::block_store_size));
       block_store_reuse_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::block_store_reuse));
+      block_store_huge_pages_ = settings_manager->GetBool(settings::Param::block_store_huge_pages);
+
+      txn_commit_batching_ = settings_manager->GetBool(settings::Param::txn_commit_batching);
+      txn_serializable_ = settings_manager->GetBool(settings::Param::txn_serializable);
 
       use_logging_ = settings_manager->GetBool(settings::Param::wal_enable);
       if (use_logging_) {
         wal_file_path_ = settings_manager->GetString(settings::Param::wal_file_path);
         wal_async_commit_enable_ = settings_manager->GetBool(settings::Param::wal_async_commit_enable);
+        wal_compression_enable_ = settings_manager->GetBool(settings::Param::wal_compression_enable);
         wal_num_buffers_ = static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::wal_num_buffers));
+        wal_num_streams_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::wal_num_streams));
         wal_serialization_interval_ = settings_manager->GetInt(settings::Param::wal_serialization_interval);
         wal_persist_interval_ = settings_manager->GetInt(settings::Param::wal_persist_interval);
         wal_persist_threshold_ =
             static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::wal_persist_threshold));
+        wal_preallocation_size_ =
+            static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::wal_preallocation_size));
+        wal_segment_size_ = static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::wal_segment_size));
+        wal_ring_path_ = settings_manager->GetString(settings::Param::wal_ring_path);
+        wal_ring_size_ = static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::wal_ring_size));
       }
 
       use_metrics_ = settings_manager->GetBool(settings::Param::metrics);
@@ -984,6 +1415,8 @@ class DBMain {
       pilot_planning_ = settings_manager->GetBool(settings::Param::pilot_planning);
 
       gc_interval_ = settings_manager->GetInt(settings::Param::gc_interval);
+      gc_num_threads_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::gc_num_threads));
+      index_maintenance_interval_ = settings_manager->GetInt(settings::Param::index_maintenance_interval);
       pilot_interval_ = settings_manager->GetInt64(settings::Param::pilot_interval);
       forecast_train_interval_ = settings_manager->GetInt64(settings::Param::forecast_train_interval);
       workload_forecast_interval_ = settings_manager->GetInt64(settings::Param::workload_forecast_interval);
@@ -998,13 +1431,41 @@ class DBMain {
       network_identity_ = settings_manager->GetString(settings::Param::network_identity);
       connection_thread_count_ =
           static_cast<uint16_t>(settings_manager->GetInt(settings::Param::connection_thread_count));
+      network_worker_thread_count_ =
+          static_cast<uint16_t>(settings_manager->GetInt(settings::Param::network_worker_thread_count));
+      network_reuse_port_ = settings_manager->GetBool(settings::Param::network_reuse_port);
       optimizer_timeout_ = static_cast<uint64_t>(settings_manager->GetInt(settings::Param::task_execution_timeout));
       use_query_cache_ = settings_manager->GetBool(settings::Param::use_query_cache);
+      result_cache_size_ = static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::result_cache_size));
+
+      use_auto_analyze_ = settings_manager->GetBool(settings::Param::auto_analyze);
+      auto_analyze_interval_ =
+          static_cast<uint64_t>(settings_manager->GetInt64(settings::Param::auto_analyze_interval));
+      auto_analyze_threshold_ =
+          static_cast<uint64_t>(settings_manager->GetInt(settings::Param::auto_analyze_threshold));
+      auto_analyze_scale_factor_ = settings_manager->GetDouble(settings::Param::auto_analyze_scale_factor);
 
       execution_mode_ = settings_manager->GetBool(settings::Param::compiled_query_execution)
                             ? execution::vm::ExecutionMode::Compiled
                             : execution::vm::ExecutionMode::Interpret;
       bytecode_handlers_path_ = settings_manager->GetString(settings::Param::bytecode_handlers_path);
+      jit_perf_map_ = settings_manager->GetBool(settings::Param::jit_perf_map);
+      sampling_profiler_hz_ = static_cast<uint32_t>(settings_manager->GetInt(settings::Param::sampling_profiler_hz));
+
+      const auto place_threads = [&](const common::ThreadRole role, const settings::Param cpus, const bool isolated,
+                                     const bool realtime) {
+        common::ThreadPlacement::Policy policy;
+        policy.cpus_ = common::ThreadPlacement::ParseCpuList(settings_manager->GetString(cpus));
+        policy.isolated_ = isolated;
+        policy.realtime_ = realtime;
+        if (!policy.cpus_.empty() || policy.realtime_) thread_policies_.emplace_back(role, std::move(policy));
+      };
+      place_threads(common::ThreadRole::WAL, settings::Param::thread_wal_cpus,
+                    settings_manager->GetBool(settings::Param::thread_wal_isolate),
+                    settings_manager->GetBool(settings::Param::thread_wal_realtime));
+      place_threads(common::ThreadRole::GARBAGE_COLLECTION, settings::Param::thread_gc_cpus, false, false);
+      place_threads(common::ThreadRole::NETWORK, settings::Param::thread_network_cpus, false, false);
+      place_threads(common::ThreadRole::BACKGROUND, settings::Param::thread_background_cpus, false, false);
 
       query_trace_metrics_ = settings_manager->GetBool(settings::Param::query_trace_metrics_enable);
       pipeline_metrics_ = settings_manager->GetBool(settings::Param::pipeline_metrics_enable);
@@ -1015,12 +1476,25 @@ class DBMain {
       gc_metrics_ = settings_manager->GetBool(settings::Param::gc_metrics_enable);
       bind_command_metrics_ = settings_manager->GetBool(settings::Param::bind_command_metrics_enable);
       execute_command_metrics_ = settings_manager->GetBool(settings::Param::execute_command_metrics_enable);
+      replication_metrics_ = settings_manager->GetBool(settings::Param::replication_metrics_enable);
+      metrics_sink_ = settings_manager->GetString(settings::Param::metrics_sink);
+      metrics_ring_buffer_rows_ =
+          static_cast<uint32_t>(settings_manager->GetInt(settings::Param::metrics_ring_buffer_rows));
 
       use_messenger_ = settings_manager->GetBool(settings::Param::messenger_enable);
       messenger_port_ = settings_manager->GetInt(settings::Param::messenger_port);
       use_replication_ = settings_manager->GetBool(settings::Param::replication_enable);
       replication_port_ = settings_manager->GetInt(settings::Param::replication_port);
       replication_hosts_path_ = settings_manager->GetString(settings::Param::replication_hosts_path);
+      recovery_replay_threads_ =
+          static_cast<uint32_t>(settings_manager->GetInt(settings::Param::recovery_replay_threads));
+      replication_quorum_size_ =
+          static_cast<uint32_t>(settings_manager->GetInt(settings::Param::replication_quorum_size));
+      replication_checkpoint_catchup_ = settings_manager->GetBool(settings::Param::replication_checkpoint_catchup);
+      checkpoint_path_ = settings_manager->GetString(settings::Param::checkpoint_path);
+      logical_decoding_subscriber_ = settings_manager->GetString(settings::Param::logical_decoding_subscriber);
+      logical_decoding_batch_size_ =
+          static_cast<uint32_t>(settings_manager->GetInt(settings::Param::logical_decoding_batch_size));
       use_model_server_ = settings_manager->GetBool(settings::Param::model_server_enable);
       model_server_path_ = settings_manager->GetString(settings::Param::model_server_path);
 
@@ -1032,7 +1506,8 @@ class DBMain {
      * @return
      */
     std::unique_ptr<metrics::MetricsManager> BootstrapMetricsManager() {
-      std::unique_ptr<metrics::MetricsManager> metrics_manager = std::make_unique<metrics::MetricsManager>();
+      std::unique_ptr<metrics::MetricsManager> metrics_manager = std::make_unique<metrics::MetricsManager>(
+          metrics::MetricsSink::Create(metrics_sink_, metrics_ring_buffer_rows_));
       metrics_manager->SetMetricSampleRate(metrics::MetricsComponent::EXECUTION_PIPELINE,
                                            pipeline_metrics_sample_rate_);
       metrics_manager->SetMetricSampleRate(metrics::MetricsComponent::LOGGING, logging_metrics_sample_rate_);
@@ -1044,6 +1519,7 @@ class DBMain {
       if (gc_metrics_) metrics_manager->EnableMetric(metrics::MetricsComponent::GARBAGECOLLECTION);
       if (bind_command_metrics_) metrics_manager->EnableMetric(metrics::MetricsComponent::BIND_COMMAND);
       if (execute_command_metrics_) metrics_manager->EnableMetric(metrics::MetricsComponent::EXECUTE_COMMAND);
+      if (replication_metrics_) metrics_manager->EnableMetric(metrics::MetricsComponent::REPLICATION);
 
       return metrics_manager;
     }
@@ -1077,6 +1553,13 @@ class DBMain {
     return common::ManagedPointer(thread_registry_);
   }
 
+  /**
+   * @return ManagedPointer to the component, can be nullptr if no thread placement was configured
+   */
+  common::ManagedPointer<common::ThreadPlacement> GetThreadPlacement() const {
+    return common::ManagedPointer(thread_placement_);
+  }
+
   /**
    * @return ManagedPointer to the component
    */
@@ -1135,6 +1618,13 @@ class DBMain {
    */
   common::ManagedPointer<trafficcop::TrafficCop> GetTrafficCop() const { return common::ManagedPointer(traffic_cop_); }
 
+  /**
+   * @return ManagedPointer to the component, can be nullptr if disabled
+   */
+  common::ManagedPointer<optimizer::AutoAnalyzeThread> GetAutoAnalyzeThread() const {
+    return common::ManagedPointer(auto_analyze_thread_);
+  }
+
   /**
    * @return ManagedPointer to the component, can be nullptr if disabled
    */
@@ -1160,9 +1650,17 @@ class DBMain {
     return common::ManagedPointer(model_server_manager_);
   }
 
+  /**
+   * @return the phases of the startup in the order they ran, with how long each took in microseconds. The execution
+   * engine initializes in parallel with the phases before it is waited for, so its time doesn't add up to the total.
+   */
+  const std::vector<std::pair<std::string, uint64_t>> &GetStartupTimings() const { return startup_timings_; }
+
  private:
+  std::vector<std::pair<std::string, uint64_t>> startup_timings_;
   // Order matters here for destruction order
   std::unique_ptr<settings::SettingsManager> settings_manager_;
+  std::unique_ptr<common::ThreadPlacement> thread_placement_;  // Outlives every thread that it placed
   std::unique_ptr<metrics::MetricsManager> metrics_manager_;
   std::unique_ptr<metrics::MetricsThread> metrics_thread_;
   std::unique_ptr<common::DedicatedThreadRegistry> thread_registry_;
@@ -1176,6 +1674,7 @@ class DBMain {
   std::unique_ptr<optimizer::StatsStorage> stats_storage_;
   std::unique_ptr<ExecutionLayer> execution_layer_;
   std::unique_ptr<trafficcop::TrafficCop> traffic_cop_;
+  std::unique_ptr<optimizer::AutoAnalyzeThread> auto_analyze_thread_;  // Runs queries, needs to die before execution
   std::unique_ptr<NetworkLayer> network_layer_;
   std::unique_ptr<MessengerLayer> messenger_layer_;
   std::unique_ptr<replication::ReplicationManager> replication_manager_;  // Depends on messenger.
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>              // NOLINT
 #include <condition_variable>  // NOLINT
 #include <functional>
 #include <map>
@@ -53,7 +55,7 @@ class ZmqMessage {
   std::string_view GetMessage() const { return message_; }
 
   /** @return The raw payload of the message. */
-  std::string_view GetRawPayload() const { return std::string_view(payload_); }
+  std::string_view GetRawPayload() const { return payload_; }
 
  private:
   friend Messenger;
@@ -72,20 +74,28 @@ class ZmqMessage {
                           const std::string &routing_id, std::string_view message);
 
   /**
-   * Parse the given payload into a ZmqMessage.
+   * Parse the given payload into a ZmqMessage without copying it.
    * @param routing_id      The message's routing ID.
-   * @param message         The message for the destination.
+   * @param payload_owner   The owner of the memory that payload refers to, e.g., the received ZeroMQ frame.
+   * @param payload         The payload for the destination, of form ID-MESSAGE.
    * @return A ZmqMessage encapsulating the given message.
    */
-  static ZmqMessage Parse(const std::string &routing_id, const std::string &message);
+  static ZmqMessage Parse(std::string routing_id, std::shared_ptr<const void> payload_owner, std::string_view payload);
 
   /** Construct a new ZmqMessage with the given routing ID and payload. Payload of form ID-MESSAGE. */
-  ZmqMessage(std::string routing_id, std::string payload);
+  ZmqMessage(std::string routing_id, std::shared_ptr<const void> payload_owner, std::string_view payload);
 
   /** The routing ID of the message. */
   std::string routing_id_;
+  /**
+   * The owner of the bytes that payload_ refers to: a std::string for messages that were built locally, or the ZeroMQ
+   * frame for messages that were received. Ownership is shared so that copies of the message are cheap and so that
+   * ZeroMQ can send the payload without copying it, holding a reference until it is done with the bytes. That may be
+   * after the message has been acknowledged and dropped from the pending messages.
+   */
+  std::shared_ptr<const void> payload_owner_;
   /** The payload in the message, of form ID-MESSAGE.  */
-  std::string payload_;
+  std::string_view payload_;
 
   /** The cached id of the message. */
   message_id_t message_id_;
@@ -213,6 +223,9 @@ class Messenger : public common::DedicatedThreadTask {
   /** Terminate the Messenger. */
   void Terminate() override;
 
+  /** @return the role of the messenger thread */
+  common::ThreadRole GetThreadRole() const override { return common::ThreadRole::BACKGROUND; }
+
   /**
    * Listen for new connections on the specified target destination. Blocks until the listen is ready.
    *
@@ -276,6 +289,21 @@ class Messenger : public common::DedicatedThreadTask {
   void SendMessage(router_id_t router_id, const std::string &recv_id, const std::string &message, CallbackFn callback,
                    callback_id_t remote_cb_id);
 
+  /**
+   * Block until fewer than @p max_pending messages that were sent over the specified connection are still waiting to
+   * be acknowledged. Senders use this to apply back-pressure instead of queueing messages without bound.
+   *
+   * @warning   Must not be invoked from the Messenger's own thread, e.g., from a callback, since that thread is the one
+   *            that processes acknowledgements.
+   *
+   * @param connection_id   The connection that the messages were sent over.
+   * @param max_pending     The number of unacknowledged messages to wait for the connection to drop below.
+   * @param timeout         The maximum amount of time to wait for.
+   * @return                True if the connection has fewer than max_pending unacknowledged messages, false on timeout.
+   */
+  bool WaitForPendingMessagesBelow(connection_id_t connection_id, uint32_t max_pending,
+                                   std::chrono::milliseconds timeout);
+
  private:
   friend ConnectionId;
   friend ConnectionRouter;
@@ -283,10 +311,20 @@ class Messenger : public common::DedicatedThreadTask {
   static constexpr const char *MESSENGER_DEFAULT_TCP = "*";
   static constexpr const char *MESSENGER_DEFAULT_IPC = "./noisepage-ipc-{}";
   static constexpr const char *MESSENGER_DEFAULT_INPROC = "noisepage-inproc-{}";
-  static constexpr const std::chrono::milliseconds MESSENGER_RESEND_TIMER = std::chrono::milliseconds(6666);
+  /** The retransmission timeout for a destination whose round-trip time has not been measured yet. */
+  static constexpr const std::chrono::milliseconds MESSENGER_INITIAL_RTO = std::chrono::milliseconds(1000);
+  /** The lower bound on retransmission timeouts, so that jitter on a fast link does not cause spurious resends. */
+  static constexpr const std::chrono::milliseconds MESSENGER_MIN_RTO = std::chrono::milliseconds(20);
+  /** The upper bound on retransmission timeouts, including after exponential backoff. */
+  static constexpr const std::chrono::milliseconds MESSENGER_MAX_RTO = std::chrono::milliseconds(6666);
+  /** The longest that the server loop blocks in poll. The loop is otherwise woken up whenever there is work to do. */
   static constexpr const std::chrono::milliseconds MESSENGER_POLL_TIMER = std::chrono::milliseconds(250);
+  /** The maximum number of messages to a destination that have been sent but not yet acknowledged. */
+  static constexpr const uint32_t MESSENGER_MAX_IN_FLIGHT = 256;
   /** The maximum timeout that a send or recv operation is allowed to block for. TODO(WAN): 30, really? */
   static constexpr const std::chrono::milliseconds MESSENGER_SNDRCV_TIMEOUT = std::chrono::seconds(30);
+  /** The maximum number of pending messages to the same destination that are sent as a single multipart message. */
+  static constexpr const uint32_t MESSENGER_MAX_BATCH_SIZE = 64;
 
   /** @return The next callback ID to be used when sending messages. */
   callback_id_t GetNextSendCallbackId();
@@ -297,19 +335,56 @@ class Messenger : public common::DedicatedThreadTask {
   void ServerLoopAddRouters();
   /** Make new connections to other listening points. */
   void ServerLoopMakeConnections();
-  /** Send all queued messages. */
-  void ServerLoopSendMessages();
-  /** Receive and process any outstanding messages. */
-  void ServerLoopRecvAndProcessMessages();
+  /**
+   * Send all queued messages that are due, batching the messages that are going to the same destination.
+   * New messages are only sent while their destination's window has room; unacknowledged messages are resent once
+   * their retransmission timeout expires.
+   * @return The amount of time until the next retransmission is due, capped at MESSENGER_POLL_TIMER.
+   */
+  std::chrono::milliseconds ServerLoopSendMessages();
+  /**
+   * Receive and process any outstanding messages.
+   * @param timeout The maximum amount of time to wait for messages.
+   */
+  void ServerLoopRecvAndProcessMessages(std::chrono::milliseconds timeout);
+
+  /** Wake up the server loop if it is blocked in poll, e.g., because there are new messages to be sent. */
+  void WakeUpServerLoop();
 
+  /** A message that has been queued to be sent and has not been acknowledged yet. */
   struct PendingMessage {
     common::ManagedPointer<zmq::socket_t> zmq_socket_;
     std::string destination_id_;
     ZmqMessage msg_;
     bool is_router_socket_;
-    std::time_t last_send_time_;
+    /** The number of times that the message has been sent. */
+    uint32_t num_sends_{0};
+    /** The time at which the message was first sent, used to sample the round-trip time. */
+    std::chrono::steady_clock::time_point first_send_time_{};
+    /** The time after which the message is resent if it still has not been acknowledged. */
+    std::chrono::steady_clock::time_point resend_time_{};
   };
 
+  /** The flow control state of a destination, with the round-trip time estimated as in RFC 6298. */
+  struct DestinationState {
+    /** The smoothed round-trip time. Zero if no round-trip time has been measured yet. */
+    std::chrono::microseconds srtt_{0};
+    /** The round-trip time variation. */
+    std::chrono::microseconds rttvar_{0};
+    /** The retransmission timeout. */
+    std::chrono::microseconds rto_{MESSENGER_INITIAL_RTO};
+    /** The number of messages that have been sent but not acknowledged yet. */
+    uint32_t num_in_flight_{0};
+    /** The number of messages that have been queued but not acknowledged yet, including those in flight. */
+    uint32_t num_pending_{0};
+  };
+
+  /** Queue the given message to be sent. */
+  void AddPendingMessage(message_id_t msg_id, PendingMessage msg);
+
+  /** Update the round-trip time estimate and retransmission timeout of a destination with a new sample. */
+  static void UpdateRoundTripTime(DestinationState *destination, std::chrono::microseconds rtt);
+
   /**
    * Processes messages.
    * Responsible for special callback functions specified by message ID.
@@ -354,7 +429,14 @@ class Messenger : public common::DedicatedThreadTask {
   std::unordered_map<connection_id_t, std::unique_ptr<ConnectionId>> connections_;
 
   std::map<message_id_t, PendingMessage> pending_messages_;
+  /** The flow control state of every destination that messages have been sent to, keyed by destination ID. */
+  std::unordered_map<std::string, DestinationState> destinations_;
+  /** Protects pending_messages_ and destinations_. */
   std::mutex pending_messages_mutex_;
+  /** Notified whenever a pending message is acknowledged. */
+  std::condition_variable pending_messages_cvar_;
+  /** A pipe whose read end is polled by the server loop, written to by WakeUpServerLoop(). */
+  std::array<int, 2> wakeup_pipe_{-1, -1};
 
   std::unordered_map<std::string, std::unordered_set<message_id_t>> seen_messages_complement_;
   std::unordered_map<std::string, message_id_t> seen_messages_max_;
@@ -3,7 +3,9 @@
 #include <vector>
 
 #include "common/macros.h"
+#include "metrics/latency_histogram.h"
 #include "metrics/metrics_defs.h"
+#include "metrics/metrics_sink.h"
 
 namespace noisepage::metrics {
 /**
@@ -36,9 +38,16 @@ class AbstractRawData {
   virtual MetricsComponent GetMetricType() const = 0;
 
   /**
-   * Writes the data to files, and then clears the data
-   * @param outfile vector of ofstreams to write to that have been opened by the MetricsManager
+   * Writes the data out, and then clears the data
+   * @param writers writers for the outputs of the metric, one per entry of its FILES, from the MetricsManager's sink
    */
-  virtual void ToCSV(std::vector<std::ofstream> *outfile) = 0;
+  virtual void Write(const std::vector<MetricsRowWriter *> &writers) = 0;
+
+  /**
+   * Adds the latency histograms of the data to others, and then clears them. Metrics without latency histograms have
+   * nothing to add.
+   * @param histograms histograms to add the latency histograms of the data to
+   */
+  virtual void TakeLatencyHistograms(LatencyHistograms *histograms UNUSED_ATTRIBUTE) {}
 };
 }  // namespace noisepage::metrics
@@ -3,13 +3,13 @@
 #include <algorithm>
 #include <chrono>  //NOLINT
 #include <fstream>
-#include <list>
 #include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog_defs.h"
+#include "common/container/chunked_list.h"
 #include "common/resource_tracker.h"
 #include "metrics/abstract_metric.h"
 #include "metrics/metrics_util.h"
@@ -25,9 +25,7 @@ class BindCommandMetricRawData : public AbstractRawData {
  public:
   void Aggregate(AbstractRawData *const other) override {
     auto other_db_metric = dynamic_cast<BindCommandMetricRawData *>(other);
-    if (!other_db_metric->bind_command_data_.empty()) {
-      bind_command_data_.splice(bind_command_data_.cend(), other_db_metric->bind_command_data_);
-    }
+    bind_command_data_.Splice(&other_db_metric->bind_command_data_);
   }
 
   /**
@@ -36,25 +34,22 @@ class BindCommandMetricRawData : public AbstractRawData {
   MetricsComponent GetMetricType() const override { return MetricsComponent::BIND_COMMAND; }
 
   /**
-   * Writes the data out to ofstreams
-   * @param outfiles vector of ofstreams to write to that have been opened by the MetricsManager
+   * Writes the data out to the sink
+   * @param writers writers for the outputs of the metric that have been opened by the MetricsManager
    */
-  void ToCSV(std::vector<std::ofstream> *const outfiles) final {
-    NOISEPAGE_ASSERT(outfiles->size() == FILES.size(), "Number of files passed to metric is wrong.");
-    NOISEPAGE_ASSERT(std::count_if(outfiles->cbegin(), outfiles->cend(),
-                                   [](const std::ofstream &outfile) { return !outfile.is_open(); }) == 0,
-                     "Not all files are open.");
+  void Write(const std::vector<MetricsRowWriter *> &writers) final {
+    NOISEPAGE_ASSERT(writers.size() == FILES.size(), "Number of outputs passed to metric is wrong.");
 
-    auto &outfile = (*outfiles)[0];
+    auto *const writer = writers[0];
 
     for (auto &data : bind_command_data_) {
-      outfile << (data.param_num_) << ", ";
-      outfile << (data.query_text_size_) << ", ";
+      *writer << data.param_num_;
+      *writer << data.query_text_size_;
 
-      data.resource_metrics_.ToCSV(outfile);
-      outfile << std::endl;
+      data.resource_metrics_.Write(writer);
+      writer->EndRow();
     }
-    bind_command_data_.clear();
+    bind_command_data_.Clear();
   }
 
   /**
@@ -73,7 +68,7 @@ class BindCommandMetricRawData : public AbstractRawData {
 
   void RecordBindCommandData(uint64_t param_num, uint64_t query_text_size,
                              const common::ResourceTracker::Metrics &resource_metrics) {
-    bind_command_data_.emplace_front(param_num, query_text_size, resource_metrics);
+    bind_command_data_.EmplaceBack(param_num, query_text_size, resource_metrics);
   }
 
   struct BindCommandData {
@@ -86,7 +81,7 @@ class BindCommandMetricRawData : public AbstractRawData {
     const common::ResourceTracker::Metrics resource_metrics_;
   };
 
-  std::list<BindCommandData> bind_command_data_;
+  common::ChunkedList<BindCommandData> bind_command_data_;
 };
 
 /**
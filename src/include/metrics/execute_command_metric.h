@@ -3,13 +3,13 @@
 #include <algorithm>
 #include <chrono>  //NOLINT
 #include <fstream>
-#include <list>
 #include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog_defs.h"
+#include "common/container/chunked_list.h"
 #include "common/resource_tracker.h"
 #include "metrics/abstract_metric.h"
 #include "metrics/metrics_util.h"
@@ -25,9 +25,7 @@ class ExecuteCommandMetricRawData : public AbstractRawData {
  public:
   void Aggregate(AbstractRawData *const other) override {
     auto other_db_metric = dynamic_cast<ExecuteCommandMetricRawData *>(other);
-    if (!other_db_metric->execute_command_data_.empty()) {
-      execute_command_data_.splice(execute_command_data_.cend(), other_db_metric->execute_command_data_);
-    }
+    execute_command_data_.Splice(&other_db_metric->execute_command_data_);
   }
 
   /**
@@ -36,24 +34,21 @@ class ExecuteCommandMetricRawData : public AbstractRawData {
   MetricsComponent GetMetricType() const override { return MetricsComponent::EXECUTE_COMMAND; }
 
   /**
-   * Writes the data out to ofstreams
-   * @param outfiles vector of ofstreams to write to that have been opened by the MetricsManager
+   * Writes the data out to the sink
+   * @param writers writers for the outputs of the metric that have been opened by the MetricsManager
    */
-  void ToCSV(std::vector<std::ofstream> *const outfiles) final {
-    NOISEPAGE_ASSERT(outfiles->size() == FILES.size(), "Number of files passed to metric is wrong.");
-    NOISEPAGE_ASSERT(std::count_if(outfiles->cbegin(), outfiles->cend(),
-                                   [](const std::ofstream &outfile) { return !outfile.is_open(); }) == 0,
-                     "Not all files are open.");
+  void Write(const std::vector<MetricsRowWriter *> &writers) final {
+    NOISEPAGE_ASSERT(writers.size() == FILES.size(), "Number of outputs passed to metric is wrong.");
 
-    auto &outfile = (*outfiles)[0];
+    auto *const writer = writers[0];
 
     for (auto &data : execute_command_data_) {
-      outfile << (data.portal_name_size_) << ", ";
+      *writer << data.portal_name_size_;
 
-      data.resource_metrics_.ToCSV(outfile);
-      outfile << std::endl;
+      data.resource_metrics_.Write(writer);
+      writer->EndRow();
     }
-    execute_command_data_.clear();
+    execute_command_data_.Clear();
   }
 
   /**
@@ -71,7 +66,7 @@ class ExecuteCommandMetricRawData : public AbstractRawData {
   struct ExecuteCommandData;
 
   void RecordExecuteCommandData(uint64_t portal_name_size, const common::ResourceTracker::Metrics &resource_metrics) {
-    execute_command_data_.emplace_front(portal_name_size, resource_metrics);
+    execute_command_data_.EmplaceBack(portal_name_size, resource_metrics);
   }
 
   struct ExecuteCommandData {
@@ -82,7 +77,7 @@ class ExecuteCommandMetricRawData : public AbstractRawData {
     const common::ResourceTracker::Metrics resource_metrics_;
   };
 
-  std::list<ExecuteCommandData> execute_command_data_;
+  common::ChunkedList<ExecuteCommandData> execute_command_data_;
 };
 
 /**
@@ -3,12 +3,12 @@
 #include <algorithm>
 #include <chrono>  //NOLINT
 #include <fstream>
-#include <list>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog_defs.h"
+#include "common/container/chunked_list.h"
 #include "common/resource_tracker.h"
 #include "metrics/abstract_metric.h"
 #include "metrics/metrics_util.h"
@@ -23,9 +23,7 @@ class ExecutionMetricRawData : public AbstractRawData {
  public:
   void Aggregate(AbstractRawData *const other) override {
     auto other_db_metric = dynamic_cast<ExecutionMetricRawData *>(other);
-    if (!other_db_metric->execution_data_.empty()) {
-      execution_data_.splice(execution_data_.cend(), other_db_metric->execution_data_);
-    }
+    execution_data_.Splice(&other_db_metric->execution_data_);
   }
 
   /**
@@ -34,23 +32,20 @@ class ExecutionMetricRawData : public AbstractRawData {
   MetricsComponent GetMetricType() const override { return MetricsComponent::EXECUTION; }
 
   /**
-   * Writes the data out to ofstreams
-   * @param outfiles vector of ofstreams to write to that have been opened by the MetricsManager
+   * Writes the data out to the sink
+   * @param writers writers for the outputs of the metric that have been opened by the MetricsManager
    */
-  void ToCSV(std::vector<std::ofstream> *const outfiles) final {
-    NOISEPAGE_ASSERT(outfiles->size() == FILES.size(), "Number of files passed to metric is wrong.");
-    NOISEPAGE_ASSERT(std::count_if(outfiles->cbegin(), outfiles->cend(),
-                                   [](const std::ofstream &outfile) { return !outfile.is_open(); }) == 0,
-                     "Not all files are open.");
+  void Write(const std::vector<MetricsRowWriter *> &writers) final {
+    NOISEPAGE_ASSERT(writers.size() == FILES.size(), "Number of outputs passed to metric is wrong.");
 
-    auto &outfile = (*outfiles)[0];
+    auto *const writer = writers[0];
 
     for (const auto &data : execution_data_) {
-      outfile << data.feature_ << ", " << static_cast<uint32_t>(data.execution_mode_) << ", ";
-      data.resource_metrics_.ToCSV(outfile);
-      outfile << std::endl;
+      *writer << data.feature_ << static_cast<uint32_t>(data.execution_mode_);
+      data.resource_metrics_.Write(writer);
+      writer->EndRow();
     }
-    execution_data_.clear();
+    execution_data_.Clear();
   }
 
   /**
@@ -69,7 +64,7 @@ class ExecutionMetricRawData : public AbstractRawData {
 
   void RecordExecutionData(const char *feature, uint32_t len, uint8_t execution_mode,
                            const common::ResourceTracker::Metrics &resource_metrics) {
-    execution_data_.emplace_back(feature, len, execution_mode, resource_metrics);
+    execution_data_.EmplaceBack(feature, len, execution_mode, resource_metrics);
   }
 
   struct ExecutionData {
@@ -81,7 +76,7 @@ class ExecutionMetricRawData : public AbstractRawData {
     const common::ResourceTracker::Metrics resource_metrics_;
   };
 
-  std::list<ExecutionData> execution_data_;
+  common::ChunkedList<ExecutionData> execution_data_;
 };
 
 /**
@@ -3,11 +3,11 @@
 #include <algorithm>
 #include <chrono>  //NOLINT
 #include <fstream>
-#include <list>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog_defs.h"
+#include "common/container/chunked_list.h"
 #include "common/resource_tracker.h"
 #include "metrics/abstract_metric.h"
 #include "metrics/metrics_util.h"
@@ -22,9 +22,9 @@ class GarbageCollectionMetricRawData : public AbstractRawData {
  public:
   void Aggregate(AbstractRawData *const other) override {
     auto other_db_metric = dynamic_cast<GarbageCollectionMetricRawData *>(other);
-    if (!other_db_metric->gc_data_.empty()) {
-      gc_data_.splice(gc_data_.cend(), other_db_metric->gc_data_);
-    }
+    gc_data_.Splice(&other_db_metric->gc_data_);
+    index_data_.Splice(&other_db_metric->index_data_);
+    latency_histograms_.Merge(other_db_metric->latency_histograms_);
   }
 
   /**
@@ -33,66 +33,123 @@ class GarbageCollectionMetricRawData : public AbstractRawData {
   MetricsComponent GetMetricType() const override { return MetricsComponent::GARBAGECOLLECTION; }
 
   /**
-   * Writes the data out to ofstreams
-   * @param outfiles vector of ofstreams to write to that have been opened by the MetricsManager
+   * Writes the data out to the sink
+   * @param writers writers for the outputs of the metric that have been opened by the MetricsManager
    */
-  void ToCSV(std::vector<std::ofstream> *const outfiles) final {
-    NOISEPAGE_ASSERT(outfiles->size() == FILES.size(), "Number of files passed to metric is wrong.");
-    NOISEPAGE_ASSERT(std::count_if(outfiles->cbegin(), outfiles->cend(),
-                                   [](const std::ofstream &outfile) { return !outfile.is_open(); }) == 0,
-                     "Not all files are open.");
+  void Write(const std::vector<MetricsRowWriter *> &writers) final {
+    NOISEPAGE_ASSERT(writers.size() == FILES.size(), "Number of outputs passed to metric is wrong.");
 
-    auto &outfile = (*outfiles)[0];
+    auto *const writer = writers[0];
+    auto *const index_writer = writers[1];
 
     for (const auto &data : gc_data_) {
-      outfile << data.txns_deallocated_ << ", " << data.txns_unlinked_ << ", " << data.buffer_unlinked_ << ", "
-              << data.readonly_unlinked_ << ", " << data.interval_ << ", ";
-      data.resource_metrics_.ToCSV(outfile);
-      outfile << std::endl;
+      *writer << data.txns_deallocated_ << data.txns_unlinked_ << data.buffer_unlinked_ << data.readonly_unlinked_
+              << data.version_chains_truncated_ << data.num_threads_ << data.interval_;
+      data.resource_metrics_.Write(writer);
+      writer->EndRow();
+    }
+    for (const auto &data : index_data_) {
+      *index_writer << data.index_type_ << data.num_keys_ << data.heap_usage_ << data.consolidations_
+                    << data.background_consolidations_ << data.consolidated_deltas_ << data.longest_chain_
+                    << data.modifications_ << data.gc_elapsed_us_;
+      data.resource_metrics_.Write(index_writer);
+      index_writer->EndRow();
     }
-    gc_data_.clear();
+    gc_data_.Clear();
+    index_data_.Clear();
   }
 
   /**
    * Files to use for writing to CSV.
    */
-  static constexpr std::array<std::string_view, 1> FILES = {"./gc.csv"};
+  static constexpr std::array<std::string_view, 2> FILES = {"./gc.csv", "./gc_index_maintenance.csv"};
   /**
    * Columns to use for writing to CSV.
    * Note: This includes the columns for the input feature, but not the output (resource counters)
    */
-  static constexpr std::array<std::string_view, 1> FEATURE_COLUMNS = {
-      "txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval"};
+  static constexpr std::array<std::string_view, 2> FEATURE_COLUMNS = {
+      "txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, version_chains_truncated, num_threads, "
+      "interval",
+      "index_type, num_keys, heap_usage, consolidations, background_consolidations, consolidated_deltas, "
+      "longest_chain, modifications, gc_elapsed_us"};
+
+  void TakeLatencyHistograms(LatencyHistograms *const histograms) override {
+    histograms->Merge(latency_histograms_);
+    latency_histograms_.Clear();
+  }
 
  private:
   friend class GarbageCollectionMetric;
   FRIEND_TEST(MetricsTests, LoggingCSVTest);
 
   void RecordGCData(uint64_t txns_deallocated, uint64_t txns_unlinked, uint64_t buffer_unlinked,
-                    uint64_t readonly_unlinked, const uint64_t interval,
-                    const common::ResourceTracker::Metrics &resource_metrics) {
-    gc_data_.emplace_back(txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval,
-                          resource_metrics);
+                    uint64_t readonly_unlinked, uint64_t version_chains_truncated, uint64_t num_threads,
+                    const uint64_t interval, const common::ResourceTracker::Metrics &resource_metrics) {
+    gc_data_.EmplaceBack(txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked,
+                         version_chains_truncated, num_threads, interval, resource_metrics);
+    latency_histograms_.Record(LatencyKind::GC_PAUSE, resource_metrics.elapsed_us_);
+  }
+
+  void RecordIndexMaintenanceData(char index_type, uint64_t num_keys, uint64_t heap_usage, uint64_t consolidations,
+                                  uint64_t background_consolidations, uint64_t consolidated_deltas,
+                                  uint64_t longest_chain, uint64_t modifications, uint64_t gc_elapsed_us,
+                                  const common::ResourceTracker::Metrics &resource_metrics) {
+    index_data_.EmplaceBack(index_type, num_keys, heap_usage, consolidations, background_consolidations,
+                            consolidated_deltas, longest_chain, modifications, gc_elapsed_us, resource_metrics);
   }
 
   struct GCData {
     GCData(uint64_t txns_deallocated, uint64_t txns_unlinked, uint64_t buffer_unlinked, uint64_t readonly_unlinked,
-           const uint64_t interval, const common::ResourceTracker::Metrics &resource_metrics)
+           uint64_t version_chains_truncated, uint64_t num_threads, const uint64_t interval,
+           const common::ResourceTracker::Metrics &resource_metrics)
         : txns_deallocated_(txns_deallocated),
           txns_unlinked_(txns_unlinked),
           buffer_unlinked_(buffer_unlinked),
           readonly_unlinked_(readonly_unlinked),
+          version_chains_truncated_(version_chains_truncated),
+          num_threads_(num_threads),
           interval_(interval),
           resource_metrics_(resource_metrics) {}
     const uint64_t txns_deallocated_;
     const uint64_t txns_unlinked_;
     const uint64_t buffer_unlinked_;
     const uint64_t readonly_unlinked_;
+    const uint64_t version_chains_truncated_;
+    const uint64_t num_threads_;
     const uint64_t interval_;
     const common::ResourceTracker::Metrics resource_metrics_;
   };
 
-  std::list<GCData> gc_data_;
+  struct IndexMaintenanceData {
+    IndexMaintenanceData(char index_type, uint64_t num_keys, uint64_t heap_usage, uint64_t consolidations,
+                         uint64_t background_consolidations, uint64_t consolidated_deltas, uint64_t longest_chain,
+                         uint64_t modifications, uint64_t gc_elapsed_us,
+                         const common::ResourceTracker::Metrics &resource_metrics)
+        : index_type_(index_type),
+          num_keys_(num_keys),
+          heap_usage_(heap_usage),
+          consolidations_(consolidations),
+          background_consolidations_(background_consolidations),
+          consolidated_deltas_(consolidated_deltas),
+          longest_chain_(longest_chain),
+          modifications_(modifications),
+          gc_elapsed_us_(gc_elapsed_us),
+          resource_metrics_(resource_metrics) {}
+    const char index_type_;
+    const uint64_t num_keys_;
+    const uint64_t heap_usage_;
+    const uint64_t consolidations_;
+    const uint64_t background_consolidations_;
+    const uint64_t consolidated_deltas_;
+    const uint64_t longest_chain_;
+    const uint64_t modifications_;
+    const uint64_t gc_elapsed_us_;
+    const common::ResourceTracker::Metrics resource_metrics_;
+  };
+
+  common::ChunkedList<GCData> gc_data_;
+  common::ChunkedList<IndexMaintenanceData> index_data_;
+  LatencyHistograms latency_histograms_;
 };
 
 /**
@@ -103,10 +160,19 @@ class GarbageCollectionMetric : public AbstractMetric<GarbageCollectionMetricRaw
   friend class MetricsStore;
 
   void RecordGCData(uint64_t txns_deallocated, uint64_t txns_unlinked, uint64_t buffer_unlinked,
-                    uint64_t readonly_unlinked, uint64_t interval,
-                    const common::ResourceTracker::Metrics &resource_metrics) {
-    GetRawData()->RecordGCData(txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval,
-                               resource_metrics);
+                    uint64_t readonly_unlinked, uint64_t version_chains_truncated, uint64_t num_threads,
+                    uint64_t interval, const common::ResourceTracker::Metrics &resource_metrics) {
+    GetRawData()->RecordGCData(txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked,
+                               version_chains_truncated, num_threads, interval, resource_metrics);
+  }
+
+  void RecordIndexMaintenanceData(char index_type, uint64_t num_keys, uint64_t heap_usage, uint64_t consolidations,
+                                  uint64_t background_consolidations, uint64_t consolidated_deltas,
+                                  uint64_t longest_chain, uint64_t modifications, uint64_t gc_elapsed_us,
+                                  const common::ResourceTracker::Metrics &resource_metrics) {
+    GetRawData()->RecordIndexMaintenanceData(index_type, num_keys, heap_usage, consolidations,
+                                             background_consolidations, consolidated_deltas, longest_chain,
+                                             modifications, gc_elapsed_us, resource_metrics);
   }
 };
 }  // namespace noisepage::metrics
@@ -0,0 +1,205 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <string_view>
+#include <utility>
+
+#include "common/macros.h"
+#include "metrics/metrics_sink.h"
+
+namespace noisepage::metrics {
+
+/**
+ * A histogram of latencies in microseconds that takes a fixed amount of memory no matter how many latencies it holds,
+ * in the style of an HDR histogram. Latencies below 32 get a bucket each. Above that, every power of two is split into
+ * 16 buckets of equal width, so that a percentile is off by at most 1/16 of its value.
+ *
+ * Recording a latency is a few instructions, so a histogram can count every data point on the hot path where keeping
+ * the data point itself is too expensive, and histograms of different threads merge by adding their buckets.
+ */
+class LatencyHistogram {
+ public:
+  /** Number of bits of a latency that its bucket keeps, with the highest bit set. */
+  static constexpr uint32_t PRECISION_BITS = 5;
+  /** Number of buckets every power of two is split into. */
+  static constexpr uint32_t SUB_BUCKETS = 1U << (PRECISION_BITS - 1);
+  /** Number of buckets, enough for any uint64_t. */
+  static constexpr uint32_t NUM_BUCKETS = (64 - PRECISION_BITS + 2) * SUB_BUCKETS;
+
+  /**
+   * @param latency_us latency to count, in microseconds
+   */
+  void Record(const uint64_t latency_us) {
+    buckets_[BucketIndex(latency_us)]++;
+    count_++;
+    sum_ += latency_us;
+    max_ = std::max(max_, latency_us);
+  }
+
+  /**
+   * Adds the latencies of another histogram to this one.
+   * @param other histogram to add the latencies of
+   */
+  void Merge(const LatencyHistogram &other) {
+    for (uint32_t i = 0; i < NUM_BUCKETS; i++) buckets_[i] += other.buckets_[i];
+    count_ += other.count_;
+    sum_ += other.sum_;
+    max_ = std::max(max_, other.max_);
+  }
+
+  /**
+   * @param percentile between 0 and 100
+   * @return the highest latency that falls in the same bucket as the latency at the percentile, or 0 if the histogram
+   * is empty
+   */
+  uint64_t Percentile(const double percentile) const {
+    NOISEPAGE_ASSERT(percentile >= 0 && percentile <= 100, "Invalid percentile.");
+    if (count_ == 0) return 0;
+    const auto rank =
+        std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100 * static_cast<double>(count_))));
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < NUM_BUCKETS; i++) {
+      seen += buckets_[i];
+      if (seen >= rank) return std::min(BucketUpperBound(i), max_);
+    }
+    return max_;
+  }
+
+  /** @return number of latencies in the histogram */
+  uint64_t Count() const { return count_; }
+
+  /** @return mean of the latencies in the histogram, or 0 if it is empty */
+  uint64_t Mean() const { return count_ == 0 ? 0 : sum_ / count_; }
+
+  /** @return highest latency in the histogram, or 0 if it is empty */
+  uint64_t Max() const { return max_; }
+
+  /**
+   * @param latency_us a latency in microseconds
+   * @return index of the bucket that counts the latency
+   */
+  static uint32_t BucketIndex(const uint64_t latency_us) {
+    if (latency_us < 2 * SUB_BUCKETS) return static_cast<uint32_t>(latency_us);
+    // The position of the highest bit picks the power of two, and the bits below it the bucket within it
+    const auto highest_bit = static_cast<uint32_t>(63 - __builtin_clzll(latency_us));
+    const uint32_t shift = highest_bit - PRECISION_BITS + 1;
+    return (shift + 1) * SUB_BUCKETS + static_cast<uint32_t>(latency_us >> shift) - SUB_BUCKETS;
+  }
+
+  /**
+   * @param index index of a bucket
+   * @return highest latency that the bucket counts
+   */
+  static uint64_t BucketUpperBound(const uint32_t index) {
+    NOISEPAGE_ASSERT(index < NUM_BUCKETS, "Invalid bucket.");
+    if (index < 2 * SUB_BUCKETS) return index;
+    const uint32_t shift = index / SUB_BUCKETS - 1;
+    const uint64_t lower_bound = static_cast<uint64_t>(index % SUB_BUCKETS + SUB_BUCKETS) << shift;
+    return lower_bound + ((uint64_t{1} << shift) - 1);
+  }
+
+ private:
+  std::array<uint64_t, NUM_BUCKETS> buckets_{};
+  uint64_t count_ = 0;
+  uint64_t sum_ = 0;
+  uint64_t max_ = 0;
+};
+
+/** The latencies that the metrics keep a LatencyHistogram of. */
+enum class LatencyKind : uint8_t {
+  /** Time to commit a transaction, from the TRANSACTION component. */
+  TXN_COMMIT,
+  /** Time to run a statement, per query, from the QUERY_TRACE component. */
+  STATEMENT,
+  /** Time to run a pipeline, per query, from the EXECUTION_PIPELINE component. */
+  PIPELINE,
+  /** Time to persist a group commit of the log, from the LOGGING component. */
+  LOG_FSYNC,
+  /** Time of a run of the garbage collector, from the GARBAGECOLLECTION component. */
+  GC_PAUSE
+};
+
+/**
+ * @param kind a kind of latency
+ * @return name of the kind of latency
+ */
+constexpr std::string_view LatencyKindToString(const LatencyKind kind) {
+  switch (kind) {
+    case LatencyKind::TXN_COMMIT:
+      return "txn_commit";
+    case LatencyKind::STATEMENT:
+      return "statement";
+    case LatencyKind::PIPELINE:
+      return "pipeline";
+    case LatencyKind::LOG_FSYNC:
+      return "log_fsync";
+    case LatencyKind::GC_PAUSE:
+      return "gc_pause";
+  }
+  return "unknown";
+}
+
+/**
+ * The latency histograms of a metric, one per kind of latency and query. Latencies that do not belong to a query are
+ * kept under query id 0. A histogram only takes memory once a latency was recorded for its kind and query.
+ */
+class LatencyHistograms {
+ public:
+  /** Identifies a histogram: the kind of latency and the id of the query. */
+  using Key = std::pair<LatencyKind, uint32_t>;
+
+  /** Output of the sink that the histograms are written to. */
+  static constexpr std::string_view FILE = "./latency_histograms.csv";
+
+  /** Columns of the output that the histograms are written to. */
+  static constexpr std::string_view COLUMNS =
+      "latency, query_id, count, mean_us, p50_us, p90_us, p99_us, p999_us, max_us";
+
+  /**
+   * @param kind kind of the latency
+   * @param latency_us latency to count, in microseconds
+   * @param query_id id of the query the latency belongs to, if any
+   */
+  void Record(const LatencyKind kind, const uint64_t latency_us, const uint32_t query_id = 0) {
+    histograms_[{kind, query_id}].Record(latency_us);
+  }
+
+  /**
+   * Adds the latencies of other histograms to these ones.
+   * @param other histograms to add the latencies of
+   */
+  void Merge(const LatencyHistograms &other) {
+    for (const auto &histogram : other.histograms_) histograms_[histogram.first].Merge(histogram.second);
+  }
+
+  /** Drop all the histograms. */
+  void Clear() { histograms_.clear(); }
+
+  /** @return true if no latency was recorded */
+  bool Empty() const { return histograms_.empty(); }
+
+  /** @return the histograms, ordered by kind of latency and then query id */
+  const std::map<Key, LatencyHistogram> &Histograms() const { return histograms_; }
+
+  /**
+   * Writes every histogram as a row of its count, mean, percentiles and maximum.
+   * @param writer writer for the rows
+   */
+  void Write(MetricsRowWriter *const writer) const {
+    for (const auto &[key, histogram] : histograms_) {
+      *writer << LatencyKindToString(key.first) << key.second << histogram.Count() << histogram.Mean()
+              << histogram.Percentile(50) << histogram.Percentile(90) << histogram.Percentile(99)
+              << histogram.Percentile(99.9) << histogram.Max();
+      writer->EndRow();
+    }
+  }
+
+ private:
+  std::map<Key, LatencyHistogram> histograms_;
+};
+
+}  // namespace noisepage::metrics
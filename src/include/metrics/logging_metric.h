@@ -3,11 +3,11 @@
 #include <algorithm>
 #include <chrono>  //NOLINT
 #include <fstream>
-#include <list>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog_defs.h"
+#include "common/container/chunked_list.h"
 #include "common/resource_tracker.h"
 #include "metrics/abstract_metric.h"
 #include "metrics/metrics_util.h"
@@ -22,12 +22,10 @@ class LoggingMetricRawData : public AbstractRawData {
  public:
   void Aggregate(AbstractRawData *const other) override {
     auto other_db_metric = dynamic_cast<LoggingMetricRawData *>(other);
-    if (!other_db_metric->serializer_data_.empty()) {
-      serializer_data_.splice(serializer_data_.cend(), other_db_metric->serializer_data_);
-    }
-    if (!other_db_metric->consumer_data_.empty()) {
-      consumer_data_.splice(consumer_data_.cend(), other_db_metric->consumer_data_);
-    }
+    serializer_data_.Splice(&other_db_metric->serializer_data_);
+    consumer_data_.Splice(&other_db_metric->consumer_data_);
+    group_commit_data_.Splice(&other_db_metric->group_commit_data_);
+    latency_histograms_.Merge(other_db_metric->latency_histograms_);
   }
 
   /**
@@ -36,44 +34,53 @@ class LoggingMetricRawData : public AbstractRawData {
   MetricsComponent GetMetricType() const override { return MetricsComponent::LOGGING; }
 
   /**
-   * Writes the data out to ofstreams
-   * @param outfiles vector of ofstreams to write to that have been opened by the MetricsManager
+   * Writes the data out to the sink
+   * @param writers writers for the outputs of the metric that have been opened by the MetricsManager
    */
-  void ToCSV(std::vector<std::ofstream> *const outfiles) final {
-    NOISEPAGE_ASSERT(outfiles->size() == FILES.size(), "Number of files passed to metric is wrong.");
-    NOISEPAGE_ASSERT(std::count_if(outfiles->cbegin(), outfiles->cend(),
-                                   [](const std::ofstream &outfile) { return !outfile.is_open(); }) == 0,
-                     "Not all files are open.");
+  void Write(const std::vector<MetricsRowWriter *> &writers) final {
+    NOISEPAGE_ASSERT(writers.size() == FILES.size(), "Number of outputs passed to metric is wrong.");
 
-    auto &serializer_outfile = (*outfiles)[0];
-    auto &consumer_outfile = (*outfiles)[1];
+    auto *const serializer_writer = writers[0];
+    auto *const consumer_writer = writers[1];
+    auto *const group_commit_writer = writers[2];
 
     for (const auto &data : serializer_data_) {
-      serializer_outfile << data.num_bytes_ << ", " << data.num_records_ << ", " << data.num_txns_ << ", "
-                         << data.interval_ << ", ";
-      data.resource_metrics_.ToCSV(serializer_outfile);
-      serializer_outfile << std::endl;
+      *serializer_writer << data.num_bytes_ << data.num_records_ << data.num_txns_ << data.interval_;
+      data.resource_metrics_.Write(serializer_writer);
+      serializer_writer->EndRow();
     }
     for (const auto &data : consumer_data_) {
-      consumer_outfile << data.num_bytes_ << ", " << data.num_buffers_ << ", " << data.interval_ << ", ";
-      data.resource_metrics_.ToCSV(consumer_outfile);
-      consumer_outfile << std::endl;
+      *consumer_writer << data.num_bytes_ << data.num_buffers_ << data.interval_;
+      data.resource_metrics_.Write(consumer_writer);
+      consumer_writer->EndRow();
     }
-    serializer_data_.clear();
-    consumer_data_.clear();
+    for (const auto &data : group_commit_data_) {
+      *group_commit_writer << data.group_size_ << data.num_bytes_ << data.fsync_latency_us_ << data.delay_us_;
+      data.resource_metrics_.Write(group_commit_writer);
+      group_commit_writer->EndRow();
+    }
+    serializer_data_.Clear();
+    consumer_data_.Clear();
+    group_commit_data_.Clear();
   }
 
   /**
    * Files to use for writing to CSV.
    */
-  static constexpr std::array<std::string_view, 2> FILES = {"./log_serializer_task.csv",
-                                                            "./disk_log_consumer_task.csv"};
+  static constexpr std::array<std::string_view, 3> FILES = {
+      "./log_serializer_task.csv", "./disk_log_consumer_task.csv", "./log_group_commit.csv"};
   /**
    * Columns to use for writing to CSV.
    * Note: This includes the columns for the input feature, but not the output (resource counters)
    */
-  static constexpr std::array<std::string_view, 2> FEATURE_COLUMNS = {"num_bytes, num_records, num_txns, interval",
-                                                                      "num_bytes, num_buffers, interval"};
+  static constexpr std::array<std::string_view, 3> FEATURE_COLUMNS = {
+      "num_bytes, num_records, num_txns, interval", "num_bytes, num_buffers, interval",
+      "group_size, num_bytes, fsync_latency_us, delay_us"};
+
+  void TakeLatencyHistograms(LatencyHistograms *const histograms) override {
+    histograms->Merge(latency_histograms_);
+    latency_histograms_.Clear();
+  }
 
  private:
   friend class LoggingMetric;
@@ -81,12 +88,18 @@ class LoggingMetricRawData : public AbstractRawData {
 
   void RecordSerializerData(const uint64_t num_bytes, const uint64_t num_records, const uint64_t num_txns,
                             const uint64_t interval, const common::ResourceTracker::Metrics &resource_metrics) {
-    serializer_data_.emplace_back(num_bytes, num_records, num_txns, interval, resource_metrics);
+    serializer_data_.EmplaceBack(num_bytes, num_records, num_txns, interval, resource_metrics);
   }
 
   void RecordConsumerData(const uint64_t num_bytes, const uint64_t num_buffers, const uint64_t interval,
                           const common::ResourceTracker::Metrics &resource_metrics) {
-    consumer_data_.emplace_back(num_bytes, num_buffers, interval, resource_metrics);
+    consumer_data_.EmplaceBack(num_bytes, num_buffers, interval, resource_metrics);
+  }
+
+  void RecordGroupCommitData(const uint64_t group_size, const uint64_t num_bytes, const uint64_t fsync_latency_us,
+                             const uint64_t delay_us, const common::ResourceTracker::Metrics &resource_metrics) {
+    group_commit_data_.EmplaceBack(group_size, num_bytes, fsync_latency_us, delay_us, resource_metrics);
+    latency_histograms_.Record(LatencyKind::LOG_FSYNC, fsync_latency_us);
   }
 
   struct SerializerData {
@@ -114,13 +127,30 @@ class LoggingMetricRawData : public AbstractRawData {
     const common::ResourceTracker::Metrics resource_metrics_;
   };
 
-  std::list<SerializerData> serializer_data_;
-  std::list<ConsumerData> consumer_data_;
+  struct GroupCommitData {
+    GroupCommitData(const uint64_t group_size, const uint64_t num_bytes, const uint64_t fsync_latency_us,
+                    const uint64_t delay_us, const common::ResourceTracker::Metrics &resource_metrics)
+        : group_size_(group_size),
+          num_bytes_(num_bytes),
+          fsync_latency_us_(fsync_latency_us),
+          delay_us_(delay_us),
+          resource_metrics_(resource_metrics) {}
+    const uint64_t group_size_;
+    const uint64_t num_bytes_;
+    const uint64_t fsync_latency_us_;
+    const uint64_t delay_us_;
+    const common::ResourceTracker::Metrics resource_metrics_;
+  };
+
+  common::ChunkedList<SerializerData> serializer_data_;
+  common::ChunkedList<ConsumerData> consumer_data_;
+  common::ChunkedList<GroupCommitData> group_commit_data_;
+  LatencyHistograms latency_histograms_;
 };
 
 /**
- * Metrics for the logging components of the system: currently buffer consumer (writes to disk) and the record
- * serializer
+ * Metrics for the logging components of the system: currently buffer consumer (writes to disk), the record
+ * serializer, and the group commits of the buffer consumer
  */
 class LoggingMetric : public AbstractMetric<LoggingMetricRawData> {
  private:
@@ -134,5 +164,9 @@ class LoggingMetric : public AbstractMetric<LoggingMetricRawData> {
                           const common::ResourceTracker::Metrics &resource_metrics) {
     GetRawData()->RecordConsumerData(num_bytes, num_buffers, interval, resource_metrics);
   }
+  void RecordGroupCommitData(const uint64_t group_size, const uint64_t num_bytes, const uint64_t fsync_latency_us,
+                             const uint64_t delay_us, const common::ResourceTracker::Metrics &resource_metrics) {
+    GetRawData()->RecordGroupCommitData(group_size, num_bytes, fsync_latency_us, delay_us, resource_metrics);
+  }
 };
 }  // namespace noisepage::metrics
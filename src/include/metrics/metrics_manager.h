@@ -2,6 +2,7 @@
 
 #include <bitset>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <thread>  // NOLINT
 #include <unordered_map>
 #include <vector>
@@ -10,6 +11,8 @@
 #include "common/spin_latch.h"
 #include "common/thread_context.h"
 #include "metrics/abstract_raw_data.h"
+#include "metrics/latency_histogram.h"
+#include "metrics/metrics_sink.h"
 #include "metrics/metrics_store.h"
 
 namespace noisepage::settings {
@@ -23,7 +26,10 @@ namespace noisepage::metrics {
  */
 class MetricsManager {
  public:
-  MetricsManager();
+  /**
+   * @param sink where the aggregated metrics are written
+   */
+  explicit MetricsManager(std::unique_ptr<MetricsSink> sink = std::make_unique<CsvMetricsSink>());
 
   /**
    * Aggregate metrics from all threads which have collected stats, combine with what was previously collected
@@ -60,9 +66,24 @@ class MetricsManager {
   }
 
   /**
-   * Dump aggregated metrics to CSV files.
+   * Write aggregated metrics to the sink, and clear them. The latency histograms of the metrics are written to their
+   * own output, covering the latencies since the previous dump, and added to the ones that GetLatencyHistograms()
+   * returns.
+   */
+  void Dump() const;
+
+  /**
+   * @return the latency histograms of all the metrics that were dumped since the MetricsManager was created
+   */
+  LatencyHistograms GetLatencyHistograms() const {
+    std::lock_guard guard(latency_histograms_mutex_);
+    return latency_histograms_;
+  }
+
+  /**
+   * @return where the aggregated metrics are written
    */
-  void ToCSV() const;
+  common::ManagedPointer<MetricsSink> GetSink() const { return common::ManagedPointer(sink_); }
 
   /**
    * @param component to be enabled
@@ -95,6 +116,7 @@ class MetricsManager {
   void ResetMetric(MetricsComponent component) const;
 
   mutable common::SpinLatch latch_;
+  const std::unique_ptr<MetricsSink> sink_;
   std::unordered_map<std::thread::id, std::unique_ptr<MetricsStore>> stores_map_;
 
   std::array<std::unique_ptr<AbstractRawData>, NUM_COMPONENTS> aggregated_metrics_;
@@ -102,6 +124,10 @@ class MetricsManager {
   std::bitset<NUM_COMPONENTS> enabled_metrics_ = 0x0;
 
   std::array<std::vector<bool>, NUM_COMPONENTS> samples_mask_;  // std::vector<bool> may use a bitset for efficiency
+
+  // Protects the latency histograms, which are read by other threads than the one that dumps the metrics
+  mutable std::mutex latency_histograms_mutex_;
+  mutable LatencyHistograms latency_histograms_;
 };
 
 }  // namespace noisepage::metrics
@@ -21,6 +21,7 @@
 #include "metrics/metrics_defs.h"
 #include "metrics/pipeline_metric.h"
 #include "metrics/query_trace_metric.h"
+#include "metrics/replication_metric.h"
 #include "metrics/transaction_metric.h"
 #include "parser/expression/constant_value_expression.h"
 
@@ -73,25 +74,72 @@ class MetricsStore {
     logging_metric_->RecordConsumerData(num_bytes, num_records, interval, resource_metrics);
   }
 
+  /**
+   * Record a group commit of the LogConsumerTask
+   * @param group_size number of commits persisted together
+   * @param num_bytes bytes persisted
+   * @param fsync_latency_us duration of the fsync
+   * @param delay_us how long the group commit policy held back the commits
+   * @param resource_metrics metrics of the LogConsumerTask
+   */
+  void RecordGroupCommitData(const uint64_t group_size, const uint64_t num_bytes, const uint64_t fsync_latency_us,
+                             const uint64_t delay_us, const common::ResourceTracker::Metrics &resource_metrics) {
+    if (!ComponentEnabled(MetricsComponent::LOGGING))
+      METRICS_LOG_WARN(
+          "RecordGroupCommitData() called without logging metrics enabled. Was it recently disabled and the component "
+          "is just lagging?");
+    NOISEPAGE_ASSERT(logging_metric_ != nullptr, "LoggingMetric not allocated. Check MetricsStore constructor.");
+    logging_metric_->RecordGroupCommitData(group_size, num_bytes, fsync_latency_us, delay_us, resource_metrics);
+  }
+
   /**
    * Record metrics from GC
    * @param txns_deallocated first entry of metrics datapoint
    * @param txns_unlinked second entry of metrics datapoint
    * @param buffer_unlinked third entry of metrics datapoint
    * @param readonly_unlinked fourth entry of metrics datapoint
-   * @param interval fifth entry of metrics datapoint
-   * @param resource_metrics sixth entry of metrics datapoint
+   * @param version_chains_truncated fifth entry of metrics datapoint
+   * @param num_threads sixth entry of metrics datapoint
+   * @param interval seventh entry of metrics datapoint
+   * @param resource_metrics eighth entry of metrics datapoint
    */
   void RecordGCData(uint64_t txns_deallocated, uint64_t txns_unlinked, uint64_t buffer_unlinked,
-                    uint64_t readonly_unlinked, uint64_t interval,
-                    const common::ResourceTracker::Metrics &resource_metrics) {
+                    uint64_t readonly_unlinked, uint64_t version_chains_truncated, uint64_t num_threads,
+                    uint64_t interval, const common::ResourceTracker::Metrics &resource_metrics) {
     if (!ComponentEnabled(MetricsComponent::GARBAGECOLLECTION))
       METRICS_LOG_WARN(
           "RecordUnlinkData() called without GC metrics enabled. Was it recently disabled and the component is just "
           "lagging?");
     NOISEPAGE_ASSERT(gc_metric_ != nullptr, "GarbageCollectionMetric not allocated. Check MetricsStore constructor.");
-    gc_metric_->RecordGCData(txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked, interval,
-                             resource_metrics);
+    gc_metric_->RecordGCData(txns_deallocated, txns_unlinked, buffer_unlinked, readonly_unlinked,
+                             version_chains_truncated, num_threads, interval, resource_metrics);
+  }
+
+  /**
+   * Record the maintenance work of an index during a GC invocation
+   * @param index_type physical type of the index
+   * @param num_keys number of keys in the index
+   * @param heap_usage approximate heap usage of the index
+   * @param consolidations number of consolidations since the last record
+   * @param background_consolidations number of those consolidations done by a background maintenance thread
+   * @param consolidated_deltas total length of the consolidated delta chains
+   * @param longest_chain length of the longest consolidated delta chain
+   * @param modifications number of keys inserted or deleted since the index was last garbage collected
+   * @param gc_elapsed_us time spent garbage collecting the index in this invocation
+   * @param resource_metrics metrics of the GC invocation
+   */
+  void RecordIndexMaintenanceData(char index_type, uint64_t num_keys, uint64_t heap_usage, uint64_t consolidations,
+                                  uint64_t background_consolidations, uint64_t consolidated_deltas,
+                                  uint64_t longest_chain, uint64_t modifications, uint64_t gc_elapsed_us,
+                                  const common::ResourceTracker::Metrics &resource_metrics) {
+    if (!ComponentEnabled(MetricsComponent::GARBAGECOLLECTION))
+      METRICS_LOG_WARN(
+          "RecordIndexMaintenanceData() called without GC metrics enabled. Was it recently disabled and the component "
+          "is just lagging?");
+    NOISEPAGE_ASSERT(gc_metric_ != nullptr, "GarbageCollectionMetric not allocated. Check MetricsStore constructor.");
+    gc_metric_->RecordIndexMaintenanceData(index_type, num_keys, heap_usage, consolidations,
+                                           background_consolidations, consolidated_deltas, longest_chain, modifications,
+                                           gc_elapsed_us, resource_metrics);
   }
 
   /**
@@ -200,13 +248,78 @@ class MetricsStore {
    * @param db_oid Database OID
    * @param query_id id of the query
    * @param timestamp time of the query execution
+   * @param latency_us time it took to run the query, in microseconds
+   * @param connection_id connection that sent the query
    * @param param parameter associated with this query
    */
   void RecordQueryTrace(catalog::db_oid_t db_oid, const execution::query_id_t query_id, const uint64_t timestamp,
+                        const uint64_t latency_us, const uint64_t connection_id,
                         common::ManagedPointer<const std::vector<parser::ConstantValueExpression>> param) {
     NOISEPAGE_ASSERT(ComponentEnabled(MetricsComponent::QUERY_TRACE), "QueryTraceMetric not enabled.");
     NOISEPAGE_ASSERT(query_trace_metric_ != nullptr, "QueryTraceMetric not allocated. Check MetricsStore constructor.");
-    query_trace_metric_->RecordQueryTrace(db_oid, query_id, timestamp, param);
+    query_trace_metric_->RecordQueryTrace(db_oid, query_id, timestamp, latency_us, connection_id, param);
+  }
+
+  /**
+   * Record a batch of log records that the primary sent to its replicas
+   * @param batch_id id of the batch
+   * @param num_bytes size of the serialized batch sent to each replica
+   * @param num_replicas number of replicas that the batch was sent to
+   * @param newest_txn newest transaction in the batch
+   */
+  void RecordReplicationBatchSentData(uint64_t batch_id, uint64_t num_bytes, uint64_t num_replicas,
+                                      uint64_t newest_txn) {
+    NOISEPAGE_ASSERT(ComponentEnabled(MetricsComponent::REPLICATION), "ReplicationMetric not enabled.");
+    NOISEPAGE_ASSERT(replication_metric_ != nullptr,
+                     "ReplicationMetric not allocated. Check MetricsStore constructor.");
+    replication_metric_->RecordBatchSentData(batch_id, num_bytes, num_replicas, newest_txn);
+  }
+
+  /**
+   * Record the progress of a replica, as seen by the primary
+   * @param replica name of the replica
+   * @param last_sent_batch_id id of the last batch that the primary sent
+   * @param received_batch_id id of the last batch that the replica received, along with all the ones before
+   * @param newest_txn_sent newest transaction that the primary sent
+   * @param applied_txn_id newest transaction that the replica applied
+   */
+  void RecordReplicaProgressData(std::string replica, uint64_t last_sent_batch_id, uint64_t received_batch_id,
+                                 uint64_t newest_txn_sent, uint64_t applied_txn_id) {
+    NOISEPAGE_ASSERT(ComponentEnabled(MetricsComponent::REPLICATION), "ReplicationMetric not enabled.");
+    NOISEPAGE_ASSERT(replication_metric_ != nullptr,
+                     "ReplicationMetric not allocated. Check MetricsStore constructor.");
+    replication_metric_->RecordReplicaProgressData(std::move(replica), last_sent_batch_id, received_batch_id,
+                                                   newest_txn_sent, applied_txn_id);
+  }
+
+  /**
+   * Record a transaction that a replica applied
+   * @param txn_id id of the transaction
+   * @param apply_latency_us time from the commit record arriving to the transaction being applied
+   */
+  void RecordReplicationApplyData(uint64_t txn_id, uint64_t apply_latency_us) {
+    NOISEPAGE_ASSERT(ComponentEnabled(MetricsComponent::REPLICATION), "ReplicationMetric not enabled.");
+    NOISEPAGE_ASSERT(replication_metric_ != nullptr,
+                     "ReplicationMetric not allocated. Check MetricsStore constructor.");
+    replication_metric_->RecordApplyData(txn_id, apply_latency_us);
+  }
+
+  /**
+   * Record a round of the Messenger sending messages to a destination
+   * @param destination name of the destination
+   * @param num_sent number of messages sent for the first time
+   * @param num_resent number of unacknowledged messages sent again
+   * @param num_pending number of messages to the destination that have not been acknowledged
+   * @param srtt_us smoothed round-trip time to the destination
+   * @param rto_us retransmission timeout of the destination
+   */
+  void RecordMessengerData(std::string destination, uint64_t num_sent, uint64_t num_resent, uint64_t num_pending,
+                           uint64_t srtt_us, uint64_t rto_us) {
+    NOISEPAGE_ASSERT(ComponentEnabled(MetricsComponent::REPLICATION), "ReplicationMetric not enabled.");
+    NOISEPAGE_ASSERT(replication_metric_ != nullptr,
+                     "ReplicationMetric not allocated. Check MetricsStore constructor.");
+    replication_metric_->RecordMessengerData(std::move(destination), num_sent, num_resent, num_pending, srtt_us,
+                                             rto_us);
   }
 
   /**
@@ -258,6 +371,7 @@ class MetricsStore {
   std::unique_ptr<PipelineMetric> pipeline_metric_;
   std::unique_ptr<BindCommandMetric> bind_command_metric_;
   std::unique_ptr<ExecuteCommandMetric> execute_command_metric_;
+  std::unique_ptr<ReplicationMetric> replication_metric_;
 
   const std::bitset<NUM_COMPONENTS> &enabled_metrics_;
   const std::array<std::vector<bool>, NUM_COMPONENTS> &samples_mask_;
@@ -3,6 +3,7 @@
 #include <chrono>  //NOLINT
 #include <thread>  //NOLINT
 
+#include "common/thread_placement.h"
 #include "metrics/metrics_manager.h"
 
 namespace noisepage::metrics {
@@ -16,19 +17,24 @@ class MetricsThread {
   /**
    * @param metrics_manager pointer to the object to be run on this thread
    * @param metrics_period sleep time between metrics invocations
+   * @param thread_placement decides which CPUs the metrics thread runs on, if not null
    */
   MetricsThread(common::ManagedPointer<MetricsManager> metrics_manager,
-                const std::chrono::microseconds metrics_period)  // NOLINT
+                const std::chrono::microseconds metrics_period,  // NOLINT
+                common::ManagedPointer<common::ThreadPlacement> thread_placement = nullptr)
       : metrics_manager_(metrics_manager),
         run_metrics_(true),
         metrics_paused_(false),
         metrics_period_(metrics_period),
-        metrics_thread_(std::thread([this] { MetricsThreadLoop(); })) {}
+        metrics_thread_(std::thread([this, thread_placement] {
+          if (thread_placement != nullptr) thread_placement->Apply(common::ThreadRole::BACKGROUND);
+          MetricsThreadLoop();
+        })) {}
 
   ~MetricsThread() {
     run_metrics_ = false;
     metrics_thread_.join();
-    metrics_manager_->ToCSV();
+    metrics_manager_->Dump();
   }
 
   /**
@@ -64,7 +70,7 @@ class MetricsThread {
       std::this_thread::sleep_for(metrics_period_);
       if (!metrics_paused_) {
         metrics_manager_->Aggregate();
-        metrics_manager_->ToCSV();
+        metrics_manager_->Dump();
       }
     }
   }
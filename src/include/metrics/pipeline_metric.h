@@ -3,13 +3,13 @@
 #include <algorithm>
 #include <chrono>  //NOLINT
 #include <fstream>
-#include <list>
 #include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog_defs.h"
+#include "common/container/chunked_list.h"
 #include "common/resource_tracker.h"
 #include "metrics/abstract_metric.h"
 #include "metrics/metrics_util.h"
@@ -31,9 +31,8 @@ class PipelineMetricRawData : public AbstractRawData {
  public:
   void Aggregate(AbstractRawData *const other) override {
     auto other_db_metric = dynamic_cast<PipelineMetricRawData *>(other);
-    if (!other_db_metric->pipeline_data_.empty()) {
-      pipeline_data_.splice(pipeline_data_.cend(), other_db_metric->pipeline_data_);
-    }
+    pipeline_data_.Splice(&other_db_metric->pipeline_data_);
+    latency_histograms_.Merge(other_db_metric->latency_histograms_);
   }
 
   /**
@@ -42,37 +41,34 @@ class PipelineMetricRawData : public AbstractRawData {
   MetricsComponent GetMetricType() const override { return MetricsComponent::EXECUTION_PIPELINE; }
 
   /**
-   * Writes the data out to ofstreams
-   * @param outfiles vector of ofstreams to write to that have been opened by the MetricsManager
+   * Writes the data out to the sink
+   * @param writers writers for the outputs of the metric that have been opened by the MetricsManager
    */
-  void ToCSV(std::vector<std::ofstream> *const outfiles) final {
-    NOISEPAGE_ASSERT(outfiles->size() == FILES.size(), "Number of files passed to metric is wrong.");
-    NOISEPAGE_ASSERT(std::count_if(outfiles->cbegin(), outfiles->cend(),
-                                   [](const std::ofstream &outfile) { return !outfile.is_open(); }) == 0,
-                     "Not all files are open.");
+  void Write(const std::vector<MetricsRowWriter *> &writers) final {
+    NOISEPAGE_ASSERT(writers.size() == FILES.size(), "Number of outputs passed to metric is wrong.");
 
-    auto &outfile = (*outfiles)[0];
+    auto *const writer = writers[0];
     auto context = MetricsUtil::GetHardwareContext();
 
     for (auto &data : pipeline_data_) {
-      outfile << data.query_id_.UnderlyingValue() << ", ";
-      outfile << data.pipeline_id_.UnderlyingValue() << ", ";
-      outfile << data.features_.size() << ", ";
-      outfile << data.GetFeatureVectorString() << ", ";
-      outfile << context.cpu_mhz_ << ", ";
-      outfile << static_cast<uint32_t>(data.execution_mode_) << ", ";
-      outfile << data.GetEstRowsVectorString() << ", ";
-      outfile << data.GetKeySizeVectorString() << ", ";
-      outfile << data.GetNumKeysVectorString() << ", ";
-      outfile << data.GetCardinalityVectorString() << ", ";
-      outfile << data.GetMemFactorsVectorString() << ", ";
-      outfile << data.GetNumLoopsVectorString() << ", ";
-      outfile << data.GetNumConcurrentVectorString() << ", ";
-
-      data.resource_metrics_.ToCSV(outfile);
-      outfile << std::endl;
+      *writer << data.query_id_.UnderlyingValue();
+      *writer << data.pipeline_id_.UnderlyingValue();
+      *writer << data.features_.size();
+      *writer << data.GetFeatureVectorString();
+      *writer << context.cpu_mhz_;
+      *writer << static_cast<uint32_t>(data.execution_mode_);
+      *writer << data.GetEstRowsVectorString();
+      *writer << data.GetKeySizeVectorString();
+      *writer << data.GetNumKeysVectorString();
+      *writer << data.GetCardinalityVectorString();
+      *writer << data.GetMemFactorsVectorString();
+      *writer << data.GetNumLoopsVectorString();
+      *writer << data.GetNumConcurrentVectorString();
+
+      data.resource_metrics_.Write(writer);
+      writer->EndRow();
     }
-    pipeline_data_.clear();
+    pipeline_data_.Clear();
   }
 
   /**
@@ -88,6 +84,11 @@ class PipelineMetricRawData : public AbstractRawData {
       "query_id, pipeline_id, num_features, features, cpu_freq, exec_mode, num_rows, key_sizes, num_keys, "
       "est_cardinalities, mem_factor, num_loops, num_concurrent"};
 
+  void TakeLatencyHistograms(LatencyHistograms *const histograms) override {
+    histograms->Merge(latency_histograms_);
+    latency_histograms_.Clear();
+  }
+
  private:
   friend class PipelineMetric;
   friend class selfdriving::PilotUtil;
@@ -98,7 +99,8 @@ class PipelineMetricRawData : public AbstractRawData {
   void RecordPipelineData(execution::query_id_t query_id, execution::pipeline_id_t pipeline_id, uint8_t execution_mode,
                           std::vector<selfdriving::ExecutionOperatingUnitFeature> &&features,
                           const common::ResourceTracker::Metrics &resource_metrics) {
-    pipeline_data_.emplace_back(query_id, pipeline_id, execution_mode, std::move(features), resource_metrics);
+    pipeline_data_.EmplaceBack(query_id, pipeline_id, execution_mode, std::move(features), resource_metrics);
+    latency_histograms_.Record(LatencyKind::PIPELINE, resource_metrics.elapsed_us_, query_id.UnderlyingValue());
   }
 
   struct PipelineData {
@@ -108,7 +110,7 @@ class PipelineMetricRawData : public AbstractRawData {
         : query_id_(query_id),
           pipeline_id_(pipeline_id),
           execution_mode_(execution_mode),
-          features_(features),
+          features_(std::move(features)),
           resource_metrics_(resource_metrics) {}
 
     template <class T>
@@ -195,7 +197,8 @@ class PipelineMetricRawData : public AbstractRawData {
     const common::ResourceTracker::Metrics resource_metrics_;
   };
 
-  std::list<PipelineData> pipeline_data_;
+  common::ChunkedList<PipelineData> pipeline_data_;
+  LatencyHistograms latency_histograms_;
 };
 
 /**
@@ -3,13 +3,13 @@
 #include <algorithm>
 #include <chrono>  //NOLINT
 #include <fstream>
-#include <list>
 #include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog_defs.h"
+#include "common/container/chunked_list.h"
 #include "common/managed_pointer.h"
 #include "execution/exec_defs.h"
 #include "metrics/abstract_metric.h"
@@ -26,12 +26,9 @@ class QueryTraceMetricRawData : public AbstractRawData {
  public:
   void Aggregate(AbstractRawData *const other) override {
     auto other_db_metric = dynamic_cast<QueryTraceMetricRawData *>(other);
-    if (!other_db_metric->query_text_.empty()) {
-      query_text_.splice(query_text_.cend(), other_db_metric->query_text_);
-    }
-    if (!other_db_metric->query_trace_.empty()) {
-      query_trace_.splice(query_trace_.cend(), other_db_metric->query_trace_);
-    }
+    query_text_.Splice(&other_db_metric->query_text_);
+    query_trace_.Splice(&other_db_metric->query_trace_);
+    latency_histograms_.Merge(other_db_metric->latency_histograms_);
   }
 
   /**
@@ -40,30 +37,27 @@ class QueryTraceMetricRawData : public AbstractRawData {
   MetricsComponent GetMetricType() const override { return MetricsComponent::QUERY_TRACE; }
 
   /**
-   * Writes the data out to ofstreams
-   * @param outfiles vector of ofstreams to write to that have been opened by the MetricsManager
+   * Writes the data out to the sink
+   * @param writers writers for the outputs of the metric that have been opened by the MetricsManager
    */
-  void ToCSV(std::vector<std::ofstream> *const outfiles) final {
-    NOISEPAGE_ASSERT(outfiles->size() == FILES.size(), "Number of files passed to metric is wrong.");
-    NOISEPAGE_ASSERT(std::count_if(outfiles->cbegin(), outfiles->cend(),
-                                   [](const std::ofstream &outfile) { return !outfile.is_open(); }) == 0,
-                     "Not all files are open.");
+  void Write(const std::vector<MetricsRowWriter *> &writers) final {
+    NOISEPAGE_ASSERT(writers.size() == FILES.size(), "Number of outputs passed to metric is wrong.");
 
-    auto &query_text_outfile = (*outfiles)[0];
-    auto &query_trace_outfile = (*outfiles)[1];
+    auto *const query_text_writer = writers[0];
+    auto *const query_trace_writer = writers[1];
 
     for (const auto &data : query_text_) {
-      query_text_outfile << data.db_oid_ << ", " << data.query_id_ << ", " << data.timestamp_ << ", "
-                         << data.query_text_ << ", " << data.type_string_ << ", ";
-      query_text_outfile << std::endl;
+      *query_text_writer << data.db_oid_.UnderlyingValue() << data.query_id_.UnderlyingValue() << data.timestamp_
+                         << data.query_text_ << data.type_string_;
+      query_text_writer->EndRow();
     }
     for (const auto &data : query_trace_) {
-      query_trace_outfile << data.db_oid_ << ", " << data.query_id_ << ", " << data.timestamp_ << ", "
-                          << data.param_string_ << ", ";
-      query_trace_outfile << std::endl;
+      *query_trace_writer << data.db_oid_.UnderlyingValue() << data.query_id_.UnderlyingValue() << data.timestamp_
+                          << data.connection_id_ << data.latency_us_ << data.param_string_;
+      query_trace_writer->EndRow();
     }
-    query_text_.clear();
-    query_trace_.clear();
+    query_text_.Clear();
+    query_trace_.Clear();
   }
 
   /**
@@ -72,10 +66,17 @@ class QueryTraceMetricRawData : public AbstractRawData {
   static constexpr std::array<std::string_view, 2> FILES = {"./query_text.csv", "./query_trace.csv"};
   /**
    * Columns to use for writing to CSV.
-   * Note: This includes the columns for the input feature, but not the output (resource counters)
+   * Note: This includes the columns for the input feature, but not the output (resource counters). The parameters go
+   * last because their values may contain commas.
    */
   static constexpr std::array<std::string_view, 2> FEATURE_COLUMNS = {
-      "db_oid, query_id, timestamp, query_text, parameter_type", "db_oid, query_id, timestamp, parameters"};
+      "db_oid, query_id, timestamp, query_text, parameter_type",
+      "db_oid, query_id, timestamp, connection_id, latency_us, parameters"};
+
+  void TakeLatencyHistograms(LatencyHistograms *const histograms) override {
+    histograms->Merge(latency_histograms_);
+    latency_histograms_.Clear();
+  }
 
  private:
   friend class QueryTraceMetric;
@@ -83,12 +84,13 @@ class QueryTraceMetricRawData : public AbstractRawData {
 
   void RecordQueryText(catalog::db_oid_t db_oid, const execution::query_id_t query_id, const std::string &query_text,
                        const std::string &type_string, const uint64_t timestamp) {
-    query_text_.emplace_back(db_oid, query_id, query_text, type_string, timestamp);
+    query_text_.EmplaceBack(db_oid, query_id, query_text, type_string, timestamp);
   }
 
   void RecordQueryTrace(catalog::db_oid_t db_oid, const execution::query_id_t query_id, const uint64_t timestamp,
-                        const std::string &param_string) {
-    query_trace_.emplace_back(db_oid, query_id, timestamp, param_string);
+                        const uint64_t latency_us, const uint64_t connection_id, const std::string &param_string) {
+    query_trace_.EmplaceBack(db_oid, query_id, timestamp, latency_us, connection_id, param_string);
+    latency_histograms_.Record(LatencyKind::STATEMENT, latency_us, query_id.UnderlyingValue());
   }
 
   struct QueryText {
@@ -108,16 +110,26 @@ class QueryTraceMetricRawData : public AbstractRawData {
 
   struct QueryTrace {
     QueryTrace(catalog::db_oid_t db_oid, const execution::query_id_t query_id, const uint64_t timestamp,
-               std::string param_string)
-        : db_oid_(db_oid), query_id_(query_id), timestamp_(timestamp), param_string_(std::move(param_string)) {}
+               const uint64_t latency_us, const uint64_t connection_id, std::string param_string)
+        : db_oid_(db_oid),
+          query_id_(query_id),
+          timestamp_(timestamp),
+          latency_us_(latency_us),
+          connection_id_(connection_id),
+          param_string_(std::move(param_string)) {}
     const catalog::db_oid_t db_oid_;
     const execution::query_id_t query_id_;
+    // When the query finished, which is latency_us_ after it started
     const uint64_t timestamp_;
+    const uint64_t latency_us_;
+    // Which connection sent the query, which is what a replay of the trace needs to tell sessions apart
+    const uint64_t connection_id_;
     const std::string param_string_;
   };
 
-  std::list<QueryText> query_text_;
-  std::list<QueryTrace> query_trace_;
+  common::ChunkedList<QueryText> query_text_;
+  common::ChunkedList<QueryTrace> query_trace_;
+  LatencyHistograms latency_histograms_;
 };
 
 /**
@@ -138,6 +150,7 @@ class QueryTraceMetric : public AbstractMetric<QueryTraceMetricRawData> {
     GetRawData()->RecordQueryText(db_oid, query_id, "\"" + query_text + "\"", type_stream.str(), timestamp);
   }
   void RecordQueryTrace(catalog::db_oid_t db_oid, const execution::query_id_t query_id, const uint64_t timestamp,
+                        const uint64_t latency_us, const uint64_t connection_id,
                         common::ManagedPointer<const std::vector<parser::ConstantValueExpression>> param) {
     std::ostringstream param_stream;
 
@@ -149,7 +162,7 @@ class QueryTraceMetric : public AbstractMetric<QueryTraceMetricRawData> {
       }
       param_stream << ";";
     }
-    GetRawData()->RecordQueryTrace(db_oid, query_id, timestamp, param_stream.str());
+    GetRawData()->RecordQueryTrace(db_oid, query_id, timestamp, latency_us, connection_id, param_stream.str());
   }
 };
 }  // namespace noisepage::metrics
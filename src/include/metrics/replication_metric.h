@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/container/chunked_list.h"
+#include "metrics/abstract_metric.h"
+#include "metrics/metrics_util.h"
+
+namespace noisepage::metrics {
+
+/**
+ * Raw data object for holding stats collected for replication, on both the primary and the replicas
+ */
+class ReplicationMetricRawData : public AbstractRawData {
+ public:
+  void Aggregate(AbstractRawData *const other) override {
+    auto other_db_metric = dynamic_cast<ReplicationMetricRawData *>(other);
+    batch_sent_data_.Splice(&other_db_metric->batch_sent_data_);
+    replica_progress_data_.Splice(&other_db_metric->replica_progress_data_);
+    apply_data_.Splice(&other_db_metric->apply_data_);
+    messenger_data_.Splice(&other_db_metric->messenger_data_);
+  }
+
+  /**
+   * @return the type of the metric this object is holding the data for
+   */
+  MetricsComponent GetMetricType() const override { return MetricsComponent::REPLICATION; }
+
+  /**
+   * Writes the data out to the sink
+   * @param writers writers for the outputs of the metric that have been opened by the MetricsManager
+   */
+  void Write(const std::vector<MetricsRowWriter *> &writers) final {
+    NOISEPAGE_ASSERT(writers.size() == FILES.size(), "Number of outputs passed to metric is wrong.");
+
+    auto *const batch_sent_writer = writers[0];
+    auto *const replica_progress_writer = writers[1];
+    auto *const apply_writer = writers[2];
+    auto *const messenger_writer = writers[3];
+
+    for (const auto &data : batch_sent_data_) {
+      *batch_sent_writer << data.timestamp_ << data.batch_id_ << data.num_bytes_ << data.num_replicas_
+                         << data.newest_txn_;
+      batch_sent_writer->EndRow();
+    }
+    for (const auto &data : replica_progress_data_) {
+      *replica_progress_writer << data.timestamp_ << data.replica_ << data.last_sent_batch_id_
+                               << data.received_batch_id_ << data.newest_txn_sent_ << data.applied_txn_id_;
+      replica_progress_writer->EndRow();
+    }
+    for (const auto &data : apply_data_) {
+      *apply_writer << data.timestamp_ << data.txn_id_ << data.apply_latency_us_;
+      apply_writer->EndRow();
+    }
+    for (const auto &data : messenger_data_) {
+      *messenger_writer << data.timestamp_ << data.destination_ << data.num_sent_ << data.num_resent_
+                        << data.num_pending_ << data.srtt_us_ << data.rto_us_;
+      messenger_writer->EndRow();
+    }
+    batch_sent_data_.Clear();
+    replica_progress_data_.Clear();
+    apply_data_.Clear();
+    messenger_data_.Clear();
+  }
+
+  /**
+   * Files to use for writing to CSV.
+   */
+  static constexpr std::array<std::string_view, 4> FILES = {"./replication_batch_sent.csv",
+                                                            "./replication_replica_progress.csv",
+                                                            "./replication_apply.csv", "./replication_messenger.csv"};
+  /**
+   * Columns to use for writing to CSV.
+   * Note: This includes the columns for the input feature, but not the output (resource counters)
+   */
+  static constexpr std::array<std::string_view, 4> FEATURE_COLUMNS = {
+      "timestamp, batch_id, num_bytes, num_replicas, newest_txn",
+      "timestamp, replica, last_sent_batch_id, received_batch_id, newest_txn_sent, applied_txn_id",
+      "timestamp, txn_id, apply_latency_us",
+      "timestamp, destination, num_sent, num_resent, num_pending, srtt_us, rto_us"};
+
+ private:
+  friend class ReplicationMetric;
+  FRIEND_TEST(MetricsTests, ReplicationCSVTest);
+
+  void RecordBatchSentData(uint64_t batch_id, uint64_t num_bytes, uint64_t num_replicas, uint64_t newest_txn) {
+    batch_sent_data_.EmplaceBack(batch_id, num_bytes, num_replicas, newest_txn);
+  }
+
+  void RecordReplicaProgressData(std::string replica, uint64_t last_sent_batch_id, uint64_t received_batch_id,
+                                 uint64_t newest_txn_sent, uint64_t applied_txn_id) {
+    replica_progress_data_.EmplaceBack(std::move(replica), last_sent_batch_id, received_batch_id, newest_txn_sent,
+                                       applied_txn_id);
+  }
+
+  void RecordApplyData(uint64_t txn_id, uint64_t apply_latency_us) {
+    apply_data_.EmplaceBack(txn_id, apply_latency_us);
+  }
+
+  void RecordMessengerData(std::string destination, uint64_t num_sent, uint64_t num_resent, uint64_t num_pending,
+                           uint64_t srtt_us, uint64_t rto_us) {
+    messenger_data_.EmplaceBack(std::move(destination), num_sent, num_resent, num_pending, srtt_us, rto_us);
+  }
+
+  struct BatchSentData {
+    BatchSentData(uint64_t batch_id, uint64_t num_bytes, uint64_t num_replicas, uint64_t newest_txn)
+        : timestamp_(MetricsUtil::Now()),
+          batch_id_(batch_id),
+          num_bytes_(num_bytes),
+          num_replicas_(num_replicas),
+          newest_txn_(newest_txn) {}
+    const uint64_t timestamp_;
+    const uint64_t batch_id_;
+    const uint64_t num_bytes_;
+    const uint64_t num_replicas_;
+    const uint64_t newest_txn_;
+  };
+
+  struct ReplicaProgressData {
+    ReplicaProgressData(std::string replica, uint64_t last_sent_batch_id, uint64_t received_batch_id,
+                        uint64_t newest_txn_sent, uint64_t applied_txn_id)
+        : timestamp_(MetricsUtil::Now()),
+          replica_(std::move(replica)),
+          last_sent_batch_id_(last_sent_batch_id),
+          received_batch_id_(received_batch_id),
+          newest_txn_sent_(newest_txn_sent),
+          applied_txn_id_(applied_txn_id) {}
+    const uint64_t timestamp_;
+    const std::string replica_;
+    const uint64_t last_sent_batch_id_;
+    const uint64_t received_batch_id_;
+    const uint64_t newest_txn_sent_;
+    const uint64_t applied_txn_id_;
+  };
+
+  struct ApplyData {
+    ApplyData(uint64_t txn_id, uint64_t apply_latency_us)
+        : timestamp_(MetricsUtil::Now()), txn_id_(txn_id), apply_latency_us_(apply_latency_us) {}
+    const uint64_t timestamp_;
+    const uint64_t txn_id_;
+    const uint64_t apply_latency_us_;
+  };
+
+  struct MessengerData {
+    MessengerData(std::string destination, uint64_t num_sent, uint64_t num_resent, uint64_t num_pending,
+                  uint64_t srtt_us, uint64_t rto_us)
+        : timestamp_(MetricsUtil::Now()),
+          destination_(std::move(destination)),
+          num_sent_(num_sent),
+          num_resent_(num_resent),
+          num_pending_(num_pending),
+          srtt_us_(srtt_us),
+          rto_us_(rto_us) {}
+    const uint64_t timestamp_;
+    const std::string destination_;
+    const uint64_t num_sent_;
+    const uint64_t num_resent_;
+    const uint64_t num_pending_;
+    const uint64_t srtt_us_;
+    const uint64_t rto_us_;
+  };
+
+  common::ChunkedList<BatchSentData> batch_sent_data_;
+  common::ChunkedList<ReplicaProgressData> replica_progress_data_;
+  common::ChunkedList<ApplyData> apply_data_;
+  common::ChunkedList<MessengerData> messenger_data_;
+};
+
+/**
+ * Metrics for replication: the batches of records that the primary sends, how far along each replica is in receiving
+ * and applying them, how long replicas take to apply transactions, and the Messenger's sends and resends
+ */
+class ReplicationMetric : public AbstractMetric<ReplicationMetricRawData> {
+ private:
+  friend class MetricsStore;
+
+  void RecordBatchSentData(uint64_t batch_id, uint64_t num_bytes, uint64_t num_replicas, uint64_t newest_txn) {
+    GetRawData()->RecordBatchSentData(batch_id, num_bytes, num_replicas, newest_txn);
+  }
+  void RecordReplicaProgressData(std::string replica, uint64_t last_sent_batch_id, uint64_t received_batch_id,
+                                 uint64_t newest_txn_sent, uint64_t applied_txn_id) {
+    GetRawData()->RecordReplicaProgressData(std::move(replica), last_sent_batch_id, received_batch_id, newest_txn_sent,
+                                            applied_txn_id);
+  }
+  void RecordApplyData(uint64_t txn_id, uint64_t apply_latency_us) {
+    GetRawData()->RecordApplyData(txn_id, apply_latency_us);
+  }
+  void RecordMessengerData(std::string destination, uint64_t num_sent, uint64_t num_resent, uint64_t num_pending,
+                           uint64_t srtt_us, uint64_t rto_us) {
+    GetRawData()->RecordMessengerData(std::move(destination), num_sent, num_resent, num_pending, srtt_us, rto_us);
+  }
+};
+}  // namespace noisepage::metrics
@@ -3,11 +3,11 @@
 #include <algorithm>
 #include <chrono>  //NOLINT
 #include <fstream>
-#include <list>
 #include <utility>
 #include <vector>
 
 #include "catalog/catalog_defs.h"
+#include "common/container/chunked_list.h"
 #include "metrics/abstract_metric.h"
 #include "metrics/metrics_util.h"
 #include "transaction/transaction_defs.h"
@@ -21,12 +21,9 @@ class TransactionMetricRawData : public AbstractRawData {
  public:
   void Aggregate(AbstractRawData *const other) override {
     auto other_db_metric = dynamic_cast<TransactionMetricRawData *>(other);
-    if (!other_db_metric->begin_data_.empty()) {
-      begin_data_.splice(begin_data_.cend(), other_db_metric->begin_data_);
-    }
-    if (!other_db_metric->commit_data_.empty()) {
-      commit_data_.splice(commit_data_.cend(), other_db_metric->commit_data_);
-    }
+    begin_data_.Splice(&other_db_metric->begin_data_);
+    commit_data_.Splice(&other_db_metric->commit_data_);
+    latency_histograms_.Merge(other_db_metric->latency_histograms_);
   }
 
   /**
@@ -35,29 +32,26 @@ class TransactionMetricRawData : public AbstractRawData {
   MetricsComponent GetMetricType() const override { return MetricsComponent::TRANSACTION; }
 
   /**
-   * Writes the data out to ofstreams
-   * @param outfiles vector of ofstreams to write to that have been opened by the MetricsManager
+   * Writes the data out to the sink
+   * @param writers writers for the outputs of the metric that have been opened by the MetricsManager
    */
-  void ToCSV(std::vector<std::ofstream> *const outfiles) final {
-    NOISEPAGE_ASSERT(outfiles->size() == FILES.size(), "Number of files passed to metric is wrong.");
-    NOISEPAGE_ASSERT(std::count_if(outfiles->cbegin(), outfiles->cend(),
-                                   [](const std::ofstream &outfile) { return !outfile.is_open(); }) == 0,
-                     "Not all files are open.");
+  void Write(const std::vector<MetricsRowWriter *> &writers) final {
+    NOISEPAGE_ASSERT(writers.size() == FILES.size(), "Number of outputs passed to metric is wrong.");
 
-    auto &begin_outfile = (*outfiles)[0];
-    auto &commit_outfile = (*outfiles)[1];
+    auto *const begin_writer = writers[0];
+    auto *const commit_writer = writers[1];
 
     for (const auto &data : begin_data_) {
-      data.resource_metrics_.ToCSV(begin_outfile);
-      begin_outfile << std::endl;
+      data.resource_metrics_.Write(begin_writer);
+      begin_writer->EndRow();
     }
     for (const auto &data : commit_data_) {
-      commit_outfile << data.is_readonly_ << ", ";
-      data.resource_metrics_.ToCSV(commit_outfile);
-      commit_outfile << std::endl;
+      *commit_writer << data.is_readonly_;
+      data.resource_metrics_.Write(commit_writer);
+      commit_writer->EndRow();
     }
-    begin_data_.clear();
-    commit_data_.clear();
+    begin_data_.Clear();
+    commit_data_.Clear();
   }
 
   /**
@@ -70,16 +64,22 @@ class TransactionMetricRawData : public AbstractRawData {
    */
   static constexpr std::array<std::string_view, 2> FEATURE_COLUMNS = {"", "is_readonly"};
 
+  void TakeLatencyHistograms(LatencyHistograms *const histograms) override {
+    histograms->Merge(latency_histograms_);
+    latency_histograms_.Clear();
+  }
+
  private:
   friend class TransactionMetric;
   FRIEND_TEST(MetricsTests, TransactionCSVTest);
 
   void RecordBeginData(const common::ResourceTracker::Metrics &resource_metrics) {
-    begin_data_.emplace_back(resource_metrics);
+    begin_data_.EmplaceBack(resource_metrics);
   }
 
   void RecordCommitData(const uint64_t is_readonly, const common::ResourceTracker::Metrics &resource_metrics) {
-    commit_data_.emplace_back(is_readonly, resource_metrics);
+    commit_data_.EmplaceBack(is_readonly, resource_metrics);
+    latency_histograms_.Record(LatencyKind::TXN_COMMIT, resource_metrics.elapsed_us_);
   }
 
   struct BeginData {
@@ -95,8 +95,9 @@ class TransactionMetricRawData : public AbstractRawData {
     const common::ResourceTracker::Metrics resource_metrics_;
   };
 
-  std::list<BeginData> begin_data_;
-  std::list<CommitData> commit_data_;
+  common::ChunkedList<BeginData> begin_data_;
+  common::ChunkedList<CommitData> commit_data_;
+  LatencyHistograms latency_histograms_;
 };
 
 /**
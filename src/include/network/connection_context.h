@@ -1,12 +1,14 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <optional>
 #include <string>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <utility>
 
 #include "catalog/catalog_accessor.h"
-#include "catalog/catalog_cache.h"
 #include "catalog/catalog_defs.h"
 #include "network/network_defs.h"
 #include "transaction/transaction_context.h"
@@ -33,10 +35,13 @@ class ConnectionContext {
     db_name_.clear();
     temp_namespace_oid_ = catalog::INVALID_NAMESPACE_OID;
     txn_ = nullptr;
+    txn_catalog_version_ = std::nullopt;
     accessor_ = nullptr;
     callback_ = nullptr;
     callback_arg_ = nullptr;
-    catalog_cache_.Reset(transaction::INITIAL_TXN_TIMESTAMP);
+    processing_ = false;
+    num_pending_ = 0;
+    num_deferred_commits_ = 0;
   }
 
   /**
@@ -122,6 +127,20 @@ class ConnectionContext {
    */
   void SetTransaction(const common::ManagedPointer<transaction::TransactionContext> txn) { txn_ = txn; }
 
+  /**
+   * @return the version of the catalog the current txn sees, or std::nullopt if it's unknown or the txn changed the
+   * catalog itself. Plans cached for another catalog version may be invalid for the txn.
+   */
+  std::optional<uint64_t> TransactionCatalogVersion() const { return txn_catalog_version_; }
+
+  /**
+   * @param catalog_version new value
+   * @warning this should only be used by the TrafficCop
+   */
+  void SetTransactionCatalogVersion(const std::optional<uint64_t> catalog_version) {
+    txn_catalog_version_ = catalog_version;
+  }
+
   /**
    * @return current CatalogAccesor for connection
    */
@@ -150,21 +169,63 @@ class ConnectionContext {
   }
 
   /**
-   * @return handle to the ConnectionHandle callback to issue a libevent wakeup in the event of WAIT_ON_NOISEPAGE
-   * state. Currently not used, but may in the future for asynchronous execution.
+   * @return handle to the ConnectionHandle callback that wakes up a connection waiting for its commits to be durable
    */
   network::NetworkCallback Callback() const { return callback_; }
 
   /**
-   * @return args to the ConnectionHandle callback to issue a libevent wakeup in the event of WAIT_ON_NOISEPAGE
-   * state. Currently not used, but may in the future for asynchronous execution.
+   * @return args to the ConnectionHandle callback that wakes up a connection waiting for its commits to be durable
    */
   void *CallbackArg() const { return callback_arg_; }
 
   /**
-   * @return CatalogCache to be injected into requests for CatalogAcessors
+   * Start processing the connection's input. Until EndProcessing(), commits may be deferred with DeferCommit().
+   * @warning only to be used by ConnectionHandle
    */
-  common::ManagedPointer<catalog::CatalogCache> GetCatalogCache() { return common::ManagedPointer(&catalog_cache_); }
+  void BeginProcessing() {
+    num_pending_ = 1;
+    processing_ = true;
+  }
+
+  /**
+   * Finish processing the connection's input.
+   * @return true if the responses can be sent; false if a deferred commit is not durable yet, in which case the
+   * callback is invoked once every one of them is
+   * @warning only to be used by ConnectionHandle
+   */
+  bool EndProcessing() {
+    processing_ = false;
+    return num_pending_.fetch_sub(1) == 1;
+  }
+
+  /**
+   * Defer a commit's acknowledgement until it is durable, instead of waiting for it on the thread that processes the
+   * input. The responses to the client are held back until DeferredCommitDurable() is called for the commit.
+   * @return false if the commit cannot be deferred because no input is being processed, in which case the caller has
+   * to wait for the commit to be durable
+   */
+  bool DeferCommit() {
+    if (!processing_ || callback_ == nullptr) return false;
+    num_deferred_commits_++;
+    num_pending_++;
+    return true;
+  }
+
+  /**
+   * Mark a deferred commit durable, and wake up the connection if it waits on nothing else. This is thread-safe.
+   */
+  void DeferredCommitDurable() {
+    if (num_pending_.fetch_sub(1) == 1) callback_(callback_arg_);
+    // The connection may go away as soon as this is visible, so it is the last access
+    num_deferred_commits_--;
+  }
+
+  /**
+   * Wait until every deferred commit is durable, as their callbacks refer to this connection.
+   */
+  void WaitForDeferredCommits() const {
+    while (num_deferred_commits_.load() != 0) std::this_thread::yield();
+  }
 
  private:
   /**
@@ -201,6 +262,11 @@ class ConnectionContext {
    */
   common::ManagedPointer<transaction::TransactionContext> txn_ = nullptr;
 
+  /**
+   * The version of the catalog the current txn sees, read when it began.
+   */
+  std::optional<uint64_t> txn_catalog_version_ = std::nullopt;
+
   /**
    * The ConnectionContext owns this, and I don't expect that should ever change. It's life cycle dominates objects
    * later in the pipeline so this is a reasonable owner and will just hand out ManagedPointers for other components.
@@ -208,13 +274,19 @@ class ConnectionContext {
   std::unique_ptr<catalog::CatalogAccessor> accessor_ = nullptr;
 
   /**
-   * ConnectionHandle callback stuff to issue a libevent wakeup in the event of WAIT_ON_NOISEPAGE state. Currently
-   * not used, but may in the future for asynchronous execution.
+   * ConnectionHandle callback stuff to issue a libevent wakeup once the deferred commits are durable.
    */
-  network::NetworkCallback callback_;
-  void *callback_arg_;
+  network::NetworkCallback callback_ = nullptr;
+  void *callback_arg_ = nullptr;
+
+  /** True while the connection's input is processed. */
+  bool processing_ = false;
+
+  /** The number of deferred commits that are not durable yet, plus one while the input is processed. */
+  std::atomic<uint32_t> num_pending_ = 0;
 
-  catalog::CatalogCache catalog_cache_;
+  /** The number of deferred commits whose callbacks have not returned yet. */
+  std::atomic<uint32_t> num_deferred_commits_ = 0;
 };
 
 }  // namespace noisepage::network
@@ -8,6 +8,7 @@
 namespace noisepage::common {
 class DedicatedThreadRegistry;
 class DedicatedThreadOwner;
+class WorkerPool;
 }  // namespace noisepage::common
 
 namespace noisepage::network {
@@ -40,12 +41,16 @@ class ConnectionDispatcherTask : public common::NotifiableTask {
    * @param connection_handle_factory The connection handle factory pointer to pass down to the handlers.
    * @param thread_registry DedicatedThreadRegistry, needed because it eventually spawns more threads in RunTask.
    * @param file_descriptors The list of file descriptors to listen on.
+   * @param handler_file_descriptors Either empty, or one file descriptor per handler for the handler to listen on.
+   * @param worker_pool The workers that the handlers hand the queries off to, or nullptr to execute them on the
+   *                    handlers.
    */
   ConnectionDispatcherTask(uint32_t num_handlers, common::DedicatedThreadOwner *dedicated_thread_owner,
                            common::ManagedPointer<ProtocolInterpreterProvider> interpreter_provider,
                            common::ManagedPointer<ConnectionHandleFactory> connection_handle_factory,
                            common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
-                           std::initializer_list<int> file_descriptors);
+                           const std::vector<int> &file_descriptors, std::vector<int> handler_file_descriptors,
+                           common::ManagedPointer<common::WorkerPool> worker_pool);
 
   /**
    * @brief Dispatches the supplied client connection to a handler.
@@ -65,6 +70,11 @@ class ConnectionDispatcherTask : public common::NotifiableTask {
    */
   void Terminate() override;
 
+  /**
+   * @return the role of the connection dispatcher thread
+   */
+  common::ThreadRole GetThreadRole() const override { return common::ThreadRole::NETWORK; }
+
  private:
   /** @return The offset in handlers_ of the next handler to dispatch to. This function mutates internal state. */
   uint64_t NextDispatchHandlerOffset();
@@ -75,6 +85,8 @@ class ConnectionDispatcherTask : public common::NotifiableTask {
   const common::ManagedPointer<ConnectionHandleFactory> connection_handle_factory_;
   const common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry_;
   const common::ManagedPointer<ProtocolInterpreterProvider> interpreter_provider_;
+  const std::vector<int> handler_file_descriptors_;
+  const common::ManagedPointer<common::WorkerPool> worker_pool_;
   std::vector<common::ManagedPointer<ConnectionHandlerTask>> handlers_;
   std::atomic<uint64_t> next_handler_;
 };
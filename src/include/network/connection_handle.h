@@ -73,6 +73,10 @@ class ConnectionHandle {
 
   /**
    * @brief Processes the client's input that has been fed into the ReadBuffer
+   *
+   * If the handler has workers, the input is processed by one of them and NEED_RESULT is returned right away.
+   * If the responses acknowledge commits that are not durable yet, NEED_DURABILITY is returned to hold them back.
+   *
    * @return The transition to trigger in the state machine after
    */
   Transition Process();
@@ -83,6 +87,12 @@ class ConnectionHandle {
    */
   Transition GetResult();
 
+  /**
+   * @brief Picks the connection up once the commits that its responses acknowledge are durable
+   * @return The transition to trigger in the state machine after
+   */
+  Transition ResumeAfterCommitsDurable();
+
   /**
    * @brief Tries to close the current client connection
    * @return The transition to trigger in the state machine after
@@ -106,12 +116,19 @@ class ConnectionHandle {
   void StopReceivingNetworkEvent();
 
   /**
-   * issues a libevent to wake up the state machine in the WAIT_ON_NOISEPAGE state
-   * @param callback_args this for a ConnectionHandle in WAIT_ON_NOISEPAGE state
+   * issues a libevent to wake up the state machine in the WAIT_DURABLE state
+   * @param callback_args this for a ConnectionHandle in WAIT_DURABLE state
    */
   static void Callback(void *callback_args);
 
  private:
+  /**
+   * Finish processing the input, holding the responses back if a commit was deferred while processing it.
+   * @param result The transition that the input resulted in.
+   * @return The transition to trigger in the state machine after
+   */
+  Transition FinishProcessing(Transition result);
+
   /** Reset the state of this connection handle for reuse. This should only be called by ConnectionHandleFactory. */
   void ResetForReuse(connection_id_t connection_id, common::ManagedPointer<ConnectionHandlerTask> task,
                      std::unique_ptr<ProtocolInterpreter> interpreter);
@@ -172,6 +189,8 @@ class ConnectionHandle {
   StateMachine state_machine_{};
   struct event *network_event_ = nullptr;
   struct event *workpool_event_ = nullptr;
+  /** The transition that the input resulted in, when it was processed by a worker or waits on durable commits. */
+  Transition process_result_ = Transition::PROCEED;
 
   ConnectionContext context_;
 };
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <deque>
+#include <functional>
 #include <memory>
 #include <utility>
 
@@ -8,6 +10,10 @@
 #include "network/network_defs.h"
 #include "network/protocol_interpreter.h"
 
+namespace noisepage::common {
+class WorkerPool;
+}  // namespace noisepage::common
+
 namespace noisepage::network {
 
 class ConnectionHandleFactory;
@@ -19,6 +25,9 @@ class ConnectionHandleFactory;
  * A client connection, once taken by the dispatch, is sent to a handler.
  * Then all related client events are registered in the handler task.
  * All client interaction happens on the same ConnectionHandlerTask thread for the entire lifetime of the connection.
+ *
+ * A handler may also accept connections by itself, on a socket that it listens on. And if there is a worker pool, the
+ * queries of its connections are executed there, so that a slow query does not hold up the other connections.
  */
 class ConnectionHandlerTask : public common::NotifiableTask {
  public:
@@ -26,8 +35,23 @@ class ConnectionHandlerTask : public common::NotifiableTask {
    * Constructs a new ConnectionHandlerTask instance.
    * @param task_id task_id a unique id assigned to this task.
    * @param connection_handle_factory The pointer to the connection handle factory
+   * @param interpreter_provider Provider that constructs protocol interpreters for the connections this task accepts
+   * @param worker_pool The workers to hand the work of the connections off to, or nullptr to do it on this task
+   * @param listen_fd The socket to accept connections on, or -1 if the connections are only dispatched to this task
    */
-  ConnectionHandlerTask(int task_id, common::ManagedPointer<ConnectionHandleFactory> connection_handle_factory);
+  ConnectionHandlerTask(int task_id, common::ManagedPointer<ConnectionHandleFactory> connection_handle_factory,
+                        common::ManagedPointer<ProtocolInterpreterProvider> interpreter_provider,
+                        common::ManagedPointer<common::WorkerPool> worker_pool, int listen_fd);
+
+  /**
+   * Runs the event loop until the task is stopped, then waits for the work that is still being done by the workers.
+   */
+  void RunTask() override;
+
+  /**
+   * @return the role of the connection handler thread
+   */
+  common::ThreadRole GetThreadRole() const override { return common::ThreadRole::NETWORK; }
 
   /**
    * @brief Notifies this ConnectionHandlerTask that a new client connection
@@ -42,7 +66,20 @@ class ConnectionHandlerTask : public common::NotifiableTask {
    */
   void Notify(int conn_fd, std::unique_ptr<ProtocolInterpreter> protocol_interpreter);
 
+  /** @return True if the work of the connections is handed off to a worker pool. */
+  bool HasWorkers() const { return worker_pool_ != nullptr; }
+
+  /**
+   * Hands work off to the worker pool. Once the work is done, done_event is activated to resume on this task's thread.
+   * @param work the work to do
+   * @param done_event an event of this task
+   */
+  void HandOff(std::function<void()> work, struct event *done_event);
+
  private:
+  /** Accepts a new client connection at the socket that this handler listens on. */
+  void HandleAccept(int listen_fd);
+
   /**
    * @brief Handles a new client assigned to this handler by the dispatcher.
    *
@@ -63,6 +100,10 @@ class ConnectionHandlerTask : public common::NotifiableTask {
   std::deque<std::pair<int, std::unique_ptr<ProtocolInterpreter>>> jobs_;
   event *notify_event_;
   common::ManagedPointer<ConnectionHandleFactory> connection_handle_factory_;
+  common::ManagedPointer<ProtocolInterpreterProvider> interpreter_provider_;
+  common::ManagedPointer<common::WorkerPool> worker_pool_;
+  /** The number of HandOff calls whose work is not done yet. The events of this task must outlive them. */
+  std::atomic<uint32_t> num_handed_off_ = 0;
 };
 
 }  // namespace noisepage::network
@@ -32,6 +32,12 @@ constexpr int INVALID_TYPE_ID = 0;
 //===--------------------------------------------------------------------===//
 #define SOCKET_BUFFER_CAPACITY 8192
 
+// Number of flushed write buffers that a connection keeps around for its next replies
+#define WRITE_QUEUE_SPARE_BUFFERS 16
+
+// Number of write buffers that are flushed with a single vectored write
+#define WRITE_QUEUE_MAX_IOVECS 64
+
 /* byte type */
 using uchar = unsigned char;
 
@@ -62,15 +68,22 @@ enum class NetworkMessageType : unsigned char {
   PG_CLOSE_COMPLETE = '3',
   PG_COMMAND_COMPLETE = 'C',
   PG_PARAMETER_STATUS = 'S',
+  PG_BACKEND_KEY_DATA = 'K',
   PG_AUTHENTICATION_REQUEST = 'R',
   PG_NOTICE_RESPONSE = 'N',
   PG_ERROR_RESPONSE = 'E',
   PG_EMPTY_QUERY_RESPONSE = 'I',
   PG_NO_DATA_RESPONSE = 'n',
+  PG_PORTAL_SUSPENDED = 's',
   PG_READY_FOR_QUERY = 'Z',
   PG_PARAMETER_DESCRIPTION = 't',
   PG_ROW_DESCRIPTION = 'T',
   PG_DATA_ROW = 'D',
+  PG_COPY_OUT_RESPONSE = 'H',
+  PG_COPY_DATA = 'd',
+  PG_COPY_DONE = 'c',
+  PG_COPY_IN_RESPONSE = 'G',
+  PG_COPY_FAIL = 'f',
   // Commands
   PG_EXECUTE_COMMAND = 'E',
   PG_SYNC_COMMAND = 'S',
@@ -80,6 +93,7 @@ enum class NetworkMessageType : unsigned char {
   PG_PARSE_COMMAND = 'P',
   PG_SIMPLE_QUERY_COMMAND = 'Q',
   PG_CLOSE_COMMAND = 'C',
+  PG_FLUSH_COMMAND = 'H',
 
   ////////////////////////
   // ITP message types  //
@@ -110,6 +124,7 @@ enum class QueryType : uint8_t {
   QUERY_CREATE_TRIGGER,
   QUERY_CREATE_SCHEMA,
   QUERY_CREATE_VIEW,
+  QUERY_CREATE_MATERIALIZED_VIEW,
   QUERY_DROP_TABLE,
   QUERY_DROP_DB,
   QUERY_DROP_INDEX,
@@ -128,6 +143,7 @@ enum class QueryType : uint8_t {
   QUERY_EXECUTE,
   // Misc
   QUERY_COPY,
+  QUERY_REFRESH,
   QUERY_OTHER,
   QUERY_EXPLAIN,
   QUERY_INVALID
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <arpa/inet.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 #include <algorithm>
@@ -209,6 +210,12 @@ class ReadBufferView {
     return result;
   }
 
+  /**
+   * Read the rest of the view as a string
+   * @return the bytes from the read head to the end of the view
+   */
+  std::string ReadRemaining() { return ReadString(size_ - offset_); }
+
   /**
    * Read a value of type T off of the buffer, advancing cursor by appropriate
    * amount. Does NOT convert from network bytes order. It is the caller's
@@ -388,6 +395,9 @@ class WriteBuffer : public Buffer {
  * A WriteQueue is a series of WriteBuffers that can buffer an uncapped amount
  * of writes without the need to copy and resize.
  *
+ * The buffers are flushed together with vectored writes, and the ones that
+ * were flushed are kept around for the next replies instead of being freed.
+ *
  * It is expected that a specific protocol will wrap this to expose a better
  * API for protocol-specific behavior.
  */
@@ -402,6 +412,13 @@ class WriteQueue {
    * Reset the write queue to its default state.
    */
   void Reset() {
+    while (buffers_.size() > 1) {
+      if (spare_buffers_.size() < WRITE_QUEUE_SPARE_BUFFERS) {
+        buffers_.back()->Reset();
+        spare_buffers_.emplace_back(std::move(buffers_.back()));
+      }
+      buffers_.pop_back();
+    }
     buffers_.resize(1);
     offset_ = 0;
     flush_ = false;
@@ -424,6 +441,46 @@ class WriteQueue {
    */
   void MarkHeadFlushed() { offset_++; }
 
+  /**
+   * Describe the bytes that were not flushed yet, one entry per buffer, for
+   * a vectored write.
+   * @param iov entries to fill in
+   * @param max_iov number of entries available
+   * @return number of entries filled in, 0 if there is nothing to flush
+   */
+  size_t GatherUnflushed(struct iovec *const iov, const size_t max_iov) {
+    size_t num_iov = 0;
+    for (size_t i = offset_; i < buffers_.size() && num_iov < max_iov; i++) {
+      WriteBuffer &buf = *buffers_[i];
+      if (!buf.HasMore()) continue;
+      iov[num_iov].iov_base = &buf.buf_[buf.offset_];
+      iov[num_iov].iov_len = buf.size_ - buf.offset_;
+      num_iov++;
+    }
+    return num_iov;
+  }
+
+  /**
+   * Mark the given number of bytes as flushed, starting from the head of the
+   * queue. Buffers that are flushed completely are skipped from then on.
+   * @param bytes number of bytes that were written out
+   */
+  void MarkFlushed(size_t bytes) {
+    while (offset_ < buffers_.size()) {
+      WriteBuffer &buf = *buffers_[offset_];
+      const size_t unflushed = buf.size_ - buf.offset_;
+      if (bytes < unflushed) {
+        buf.Skip(bytes);
+        return;
+      }
+      buf.Skip(unflushed);
+      bytes -= unflushed;
+      // The last buffer stays the head, since it is the one that new writes go to
+      if (offset_ + 1 == buffers_.size()) return;
+      offset_++;
+    }
+  }
+
   /**
    * Force this WriteQueue to be flushed next time the network layer
    * is available to do so.
@@ -455,7 +512,7 @@ class WriteQueue {
       // Only write partially if we are allowed to
       size_t written = breakup ? tail.RemainingCapacity() : 0;
       tail.AppendRaw(src, written);
-      buffers_.push_back(std::make_unique<WriteBuffer>());
+      AddBuffer();
       BufferWriteRaw(reinterpret_cast<const uchar *>(src) + written, len - written);
     }
   }
@@ -476,7 +533,19 @@ class WriteQueue {
 
  private:
   friend class PacketWriter;
+
+  // Append an empty buffer to the queue, reusing a spare one if there is any
+  void AddBuffer() {
+    if (spare_buffers_.empty()) {
+      buffers_.push_back(std::make_unique<WriteBuffer>());
+      return;
+    }
+    buffers_.emplace_back(std::move(spare_buffers_.back()));
+    spare_buffers_.pop_back();
+  }
+
   std::vector<std::unique_ptr<WriteBuffer>> buffers_;
+  std::vector<std::unique_ptr<WriteBuffer>> spare_buffers_;
   size_t offset_ = 0;
   bool flush_ = false;
 };
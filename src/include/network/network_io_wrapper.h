@@ -9,7 +9,6 @@
 namespace noisepage::network {
 
 class ReadBuffer;
-class WriteBuffer;
 class WriteQueue;
 
 /**
@@ -32,9 +31,11 @@ class NetworkIoWrapper {
 
   /**
    * @brief Fills the read buffer of this IOWrapper from the assigned fd.
+   * @param packet_buf The buffer of a packet that is larger than the read buffer and still incomplete, if any. Once the
+   *                   read buffer is drained, the rest of the packet is read into it directly.
    * @return The next transition for this client's state machine.
    */
-  Transition FillReadBuffer();
+  Transition FillReadBuffer(common::ManagedPointer<ReadBuffer> packet_buf = nullptr);
 
   /**
    * @return Whether or not this IOWrapper is configured to flush its writes when this is called
@@ -42,13 +43,7 @@ class NetworkIoWrapper {
   bool ShouldFlush();
 
   /**
-   * @brief Flushes the write buffer of this IOWrapper to the assigned fd
-   * @return The next transition for this client's state machine
-   */
-  Transition FlushWriteBuffer(common::ManagedPointer<WriteBuffer> wbuf);
-
-  /**
-   * @brief Flushes all writes to this IOWrapper
+   * @brief Flushes all writes to this IOWrapper, several buffers at a time
    * @return The next transition for this client's state machine
    */
   Transition FlushAllWrites();
@@ -88,5 +83,6 @@ class NetworkIoWrapper {
   std::unique_ptr<WriteQueue> out_;
 
   void RestartState();
+  Transition FillBufferFrom(common::ManagedPointer<ReadBuffer> buf);
 };
 }  // namespace noisepage::network
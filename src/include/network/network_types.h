@@ -6,11 +6,12 @@ namespace noisepage::network {
  * @see ConnectionHandle::StateMachine
  */
 enum class ConnState {
-  READ,      // State that reads data from the network
-  WRITE,     // State the writes data to the network
-  PROCESS,   // State that runs the network protocol on received data
-  CLOSING,   // State for closing the client connection
-  SSL_INIT,  // State to flush out responses and doing (Real) SSL handshake
+  READ,          // State that reads data from the network
+  WRITE,         // State the writes data to the network
+  PROCESS,       // State that runs the network protocol on received data
+  CLOSING,       // State for closing the client connection
+  WAIT_DURABLE,  // State that holds back responses until the commits they acknowledge are durable
+  SSL_INIT,      // State to flush out responses and doing (Real) SSL handshake
 };
 
 /**
@@ -25,6 +26,7 @@ enum class Transition {
   NEED_READ,
   NEED_READ_TIMEOUT,
   NEED_RESULT,
+  NEED_DURABILITY,
   TERMINATE,
   NEED_SSL_HANDSHAKE,
   NEED_WRITE
@@ -35,12 +35,21 @@ class NetworkUtil {
     return type >= QueryType::QUERY_SELECT && type <= QueryType::QUERY_ANALYZE;
   }
 
+  /**
+   * @param type query type from the parser
+   * @return true if a SELECT, INSERT, UPDATE, or DELETE, whose plans may be shared by all connections. Order of
+   * QueryType enum matters here.
+   */
+  static bool SharedStatementQueryType(const QueryType type) {
+    return type >= QueryType::QUERY_SELECT && type <= QueryType::QUERY_DELETE;
+  }
+
   /**
    * @param type query type from the parser
    * @return true if a CREATE. Order of QueryType enum matters here.
    */
   static bool CreateQueryType(const QueryType type) {
-    return type >= QueryType::QUERY_CREATE_TABLE && type <= QueryType::QUERY_CREATE_VIEW;
+    return type >= QueryType::QUERY_CREATE_TABLE && type <= QueryType::QUERY_CREATE_MATERIALIZED_VIEW;
   }
 
   /**
@@ -1,10 +1,13 @@
 #pragma once
 
 #include <condition_variable>  // NOLINT
-#include <mutex>               // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
 #include <string>
+#include <vector>
 
 #include "common/dedicated_thread_owner.h"
+#include "common/worker_pool.h"
 
 namespace noisepage::network {
 
@@ -18,11 +21,25 @@ constexpr std::string_view UNIX_DOMAIN_SOCKET_FORMAT_STRING = "{0}/.s.PGSQL.{1}"
 /** TerrierServer is the entry point to the network layer. */
 class TerrierServer : public common::DedicatedThreadOwner {
  public:
-  /** @brief Construct a new TerrierServer instance. */
+  /**
+   * @brief Construct a new TerrierServer instance.
+   *
+   * @param protocol_provider Provider that constructs protocol interpreters.
+   * @param connection_handle_factory The connection handle factory pointer to pass down to the handlers.
+   * @param thread_registry DedicatedThreadRegistry that the network threads are registered with.
+   * @param port The network port to listen on.
+   * @param connection_thread_count The number of connection handler threads.
+   * @param socket_directory The directory to store the Unix domain socket.
+   * @param worker_thread_count The number of threads that execute the queries of the connections, or 0 to execute
+   *                            them on the connection handler threads.
+   * @param reuse_port True if every connection handler thread should accept connections on a networked socket of its
+   *                   own, bound to the same port with SO_REUSEPORT.
+   */
   TerrierServer(common::ManagedPointer<ProtocolInterpreterProvider> protocol_provider,
                 common::ManagedPointer<ConnectionHandleFactory> connection_handle_factory,
                 common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry, uint16_t port,
-                uint16_t connection_thread_count, std::string socket_directory);
+                uint16_t connection_thread_count, std::string socket_directory, uint16_t worker_thread_count,
+                bool reuse_port);
 
   /** @brief Destructor. */
   ~TerrierServer() override = default;
@@ -52,8 +69,9 @@ class TerrierServer : public common::DedicatedThreadOwner {
   bool OnThreadRemoval(common::ManagedPointer<common::DedicatedThreadTask> task) override { return true; }
   enum SocketType { UNIX_DOMAIN_SOCKET, NETWORKED_SOCKET };
 
+  /** @return The file descriptor of a new socket of the given type that is listening for connections. */
   template <SocketType type>
-  void RegisterSocket();
+  int RegisterSocket();
 
   std::mutex running_mutex_;
   bool running_;
@@ -63,12 +81,21 @@ class TerrierServer : public common::DedicatedThreadOwner {
   uint16_t port_;
   /** The networked socket file descriptor that the server is listening on. */
   int network_socket_fd_ = -1;
+  /**
+   * The networked socket file descriptors of the connection handlers with SO_REUSEPORT, one per handler. The first one
+   * is network_socket_fd_.
+   */
+  std::vector<int> handler_socket_fds_;
   /** The unix-based local socket file descriptor that the server may be listening on. */
   int unix_domain_socket_fd_ = -1;
   /** The directory to store the Unix domain socket. */
   const std::string socket_directory_;
   /** The maximum number of connections to the server. */
   const uint32_t max_connections_;
+  /** Whether every connection handler accepts connections on its own networked socket. */
+  const bool reuse_port_;
+  /** The threads that execute the queries of the connections, or nullptr if the connection handlers execute them. */
+  std::unique_ptr<common::WorkerPool> worker_pool_;
 
   common::ManagedPointer<ConnectionHandleFactory> connection_handle_factory_;
   common::ManagedPointer<ProtocolInterpreterProvider> provider_;
@@ -35,6 +35,12 @@ class PacketWriter {
    */
   bool IsPacketEmpty() { return curr_packet_len_ == nullptr; }
 
+  /**
+   * Sends what was written so far once the current message is processed, for replies to a message that doesn't
+   * flush on its own
+   */
+  void ForceFlush() { queue_->ForceFlush(); }
+
   /**
    * Write out a single type
    * @param type to write to the queue
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "common/error/error_data.h"
+#include "parser/parser_defs.h"
+#include "storage/bulk_loader.h"
+#include "type/type_id.h"
+
+namespace noisepage::network {
+
+/**
+ * Reads the data of a COPY ... FROM STDIN and inserts its rows into the table.
+ *
+ * The client sends the data in CopyData messages whose boundaries have nothing to do with the rows, so the reader
+ * buffers whatever is left of a row until the rest of it arrives. It understands the three COPY formats of Postgres:
+ * text, where values are separated by the delimiter and special characters are escaped with a backslash, CSV, where
+ * they may be quoted, and binary, where every tuple is a count of fields followed by their lengths and values.
+ *
+ * Rows are inserted as soon as they are read, through a BulkLoader that batches the maintenance of the indexes. The
+ * first bad row stops the COPY with an error that says where it was found, and the transaction has to abort then.
+ */
+class CopyInReader {
+ public:
+  /** A column of the table, in the order its values come in */
+  struct Column {
+    /** name of the column */
+    std::string name_;
+    /** type of the column */
+    type::TypeId type_;
+    /** whether the column allows NULL */
+    bool nullable_;
+  };
+
+  /**
+   * Creates a reader for the data of a COPY
+   * @param table_name name of the table, for error messages
+   * @param loader inserts the rows into the table. Its staged rows have the columns in the order given.
+   * @param columns the columns of the table
+   * @param format format of the data
+   * @param delimiter character that separates the values of a row in the text and CSV formats
+   * @param quote character that quotes values in the CSV format
+   * @param escape character that escapes quotes inside quoted values in the CSV format
+   */
+  CopyInReader(std::string table_name, std::unique_ptr<storage::BulkLoader> loader, std::vector<Column> columns,
+               parser::ExternalFileFormat format, char delimiter, char quote, char escape);
+
+  /**
+   * Reads the data of a CopyData message and inserts the rows that are complete.
+   * @param data the data
+   * @return false if the data is bad, see GetError. The rest of the data is ignored then.
+   */
+  bool Feed(std::string_view data);
+
+  /**
+   * Reads what is left of the data once the client says that it is done, and finishes maintaining the indexes.
+   * @return false if the data is bad, see GetError
+   */
+  bool Finish();
+
+  /**
+   * @return what was wrong with the data, if anything
+   */
+  const std::optional<common::ErrorData> &GetError() const { return error_; }
+
+  /**
+   * @return number of rows inserted so far
+   */
+  uint64_t NumRows() const { return loader_->NumRows(); }
+
+  /**
+   * @return format of the data
+   */
+  parser::ExternalFileFormat Format() const { return format_; }
+
+  /**
+   * @return number of columns in a row
+   */
+  uint16_t NumColumns() const { return static_cast<uint16_t>(columns_.size()); }
+
+ private:
+  // The value of a field, converted to the type of its column. Fixed length values are kept in the layout of their
+  // attributes, variable length ones as their bytes until the row is written.
+  struct Value {
+    bool null_ = false;
+    uint64_t fixed_ = 0;
+    std::string varlen_;
+  };
+
+  // Each of these consumes the complete rows at the start of pending_, and returns false on an error
+  bool ReadTextRows(bool at_end);
+  bool ReadCsvRows(bool at_end);
+  bool ReadBinaryRows();
+
+  // Split a line of the text format into its fields
+  bool SplitTextLine(std::string_view line, std::vector<std::optional<std::string>> *fields);
+
+  // Convert the fields of a text or CSV row and insert it
+  bool InsertTextRow(const std::vector<std::optional<std::string>> &fields);
+
+  bool ConvertText(uint16_t col, std::string_view text, Value *value);
+  bool ConvertBinary(uint16_t col, std::string_view bytes, Value *value);
+  bool InsertRow();
+
+  bool Fail(common::ErrorCode code, std::string_view message, std::optional<uint16_t> col = std::nullopt);
+
+  const std::string table_name_;
+  const std::unique_ptr<storage::BulkLoader> loader_;
+  const std::vector<Column> columns_;
+  const parser::ExternalFileFormat format_;
+  const char delimiter_;
+  const char quote_;
+  const char escape_;
+
+  // Data that was received but is not a complete row yet
+  std::string pending_;
+  std::vector<Value> values_;
+  // Line of the data being read, or tuple in the binary format, for error messages
+  uint64_t line_ = 0;
+  bool read_header_ = false;
+  // Whether the end of the data was marked, by \. in the text and CSV formats or by the trailer in the binary format
+  bool done_ = false;
+  std::optional<common::ErrorData> error_;
+};
+
+}  // namespace noisepage::network
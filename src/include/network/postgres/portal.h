@@ -8,6 +8,7 @@
 #include "network/postgres/postgres_defs.h"
 #include "network/postgres/statement.h"
 #include "parser/expression/constant_value_expression.h"
+#include "traffic_cop/result_cache.h"
 
 namespace noisepage::planner {
 class AbstractPlanNode;
@@ -20,6 +21,9 @@ namespace noisepage::network {
  * https://www.postgresql.org/docs/current/protocol-flow.html#PROTOCOL-FLOW-EXT-QUERY)
  * It encapsulates a reference to its originating statement, the parameters (if any), the output formats, and the
  * optimized physical plan. It represents a query ready to be executed.
+ *
+ * An Execute with a row limit runs a SELECT to completion and suspends the portal, which then holds the output tuples
+ * and hands them out over this and the following Executes of the portal, until the last row clears it again.
  */
 class Portal {
  public:
@@ -62,10 +66,45 @@ class Portal {
     return common::ManagedPointer(&params_);
   }
 
+  /**
+   * Suspend the portal with the output of its query, whose rows are fetched from the first one on.
+   * @param result the output tuples of the query
+   */
+  void Suspend(std::shared_ptr<const trafficcop::ResultCache::Result> result) {
+    suspended_result_ = std::move(result);
+    next_row_ = 0;
+  }
+
+  /**
+   * @return true if the portal holds rows of its query that an Execute has not fetched yet
+   */
+  bool IsSuspended() const { return suspended_result_ != nullptr; }
+
+  /**
+   * @return the output tuples of the query of the suspended portal
+   */
+  const trafficcop::ResultCache::Result &SuspendedResult() const { return *suspended_result_; }
+
+  /**
+   * @return the index of the first row that the next Execute fetches
+   */
+  uint32_t NextRow() const { return next_row_; }
+
+  /**
+   * Mark rows of the suspended portal fetched, and release its output tuples once the last one is.
+   * @param num_rows the number of rows fetched
+   */
+  void FetchRows(const uint32_t num_rows) {
+    next_row_ += num_rows;
+    if (next_row_ == suspended_result_->GetNumTuples()) suspended_result_ = nullptr;
+  }
+
  private:
   const common::ManagedPointer<network::Statement> statement_;
   const std::vector<parser::ConstantValueExpression> params_;
   const std::vector<FieldFormat> result_formats_;
+  std::shared_ptr<const trafficcop::ResultCache::Result> suspended_result_ = nullptr;
+  uint32_t next_row_ = 0;
 };
 
 }  // namespace noisepage::network
@@ -30,6 +30,16 @@ constexpr std::string_view POSTGRES_BOOLEAN_STR_TRUE = "t";
  */
 constexpr std::string_view POSTGRES_BOOLEAN_STR_FALSE = "f";
 
+/**
+ * The Julian day of 2000-01-01, which the binary format of dates and timestamps counts from
+ */
+constexpr int32_t POSTGRES_EPOCH_JULIAN_DAY = 2451545;
+
+/**
+ * The signature the binary COPY format starts with
+ */
+constexpr std::string_view POSTGRES_BINARY_COPY_SIGNATURE{"PGCOPY\n\377\r\n\0", 11};
+
 /**
  * Hardcoded server parameter values to send to the client
  */
@@ -41,15 +41,19 @@ class PostgresNetworkCommand : public NetworkCommand {
   PostgresNetworkCommand(const common::ManagedPointer<InputPacket> in, bool flush) : NetworkCommand(in, flush) {}
 };
 
-// Set all to force flush for now
+// Commands a client waits on force a flush, the replies to the others are sent along with it
 DEFINE_POSTGRES_COMMAND(SimpleQueryCommand, true);
 DEFINE_POSTGRES_COMMAND(ParseCommand, false);
 DEFINE_POSTGRES_COMMAND(BindCommand, false);
 DEFINE_POSTGRES_COMMAND(DescribeCommand, false);
 DEFINE_POSTGRES_COMMAND(ExecuteCommand, false);
 DEFINE_POSTGRES_COMMAND(SyncCommand, true);
-DEFINE_POSTGRES_COMMAND(CloseCommand, true);
+DEFINE_POSTGRES_COMMAND(CloseCommand, false);
+DEFINE_POSTGRES_COMMAND(FlushCommand, true);
 DEFINE_POSTGRES_COMMAND(TerminateCommand, true);
 DEFINE_POSTGRES_COMMAND(EmptyCommand, true);  // (Matt): This seems to be only for testing? Not a big fan of that.
+DEFINE_POSTGRES_COMMAND(CopyDataCommand, false);
+DEFINE_POSTGRES_COMMAND(CopyDoneCommand, true);
+DEFINE_POSTGRES_COMMAND(CopyFailCommand, true);
 
 }  // namespace noisepage::network
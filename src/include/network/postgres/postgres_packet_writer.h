@@ -18,6 +18,19 @@ class ErrorData;
 }
 
 namespace noisepage::network {
+
+/**
+ * Where an attribute is in the tuples the execution engine outputs, and how to write it into a DataRow message.
+ */
+struct DataRowAttribute {
+  /** The offset of the attribute in the tuple. */
+  uint32_t offset_;
+  /** The type of the attribute. */
+  type::TypeId type_;
+  /** The format to write the attribute in. */
+  FieldFormat format_;
+};
+
 /**
  * Wrapper around an I/O layer WriteQueue to provide Postgres-specific
  * helper methods.
@@ -38,8 +51,10 @@ class PostgresPacketWriter : public PacketWriter {
 
   /**
    * Writes response to startup message
+   * @param process_id ID that the client has to send in a CancelRequest for this connection
+   * @param cancel_key secret key that the client has to send in a CancelRequest for this connection
    */
-  void WriteStartupResponse();
+  void WriteStartupResponse(int32_t process_id, int32_t cancel_key);
 
   /**
    * Writes a simple query
@@ -63,6 +78,11 @@ class PostgresPacketWriter : public PacketWriter {
    */
   void WriteNoData();
 
+  /**
+   * Writes a portal suspended response, which ends an Execute that hit its row limit before the portal's last row
+   */
+  void WritePortalSuspended();
+
   /**
    * Writes parameter description (used in Describe command)
    * @param param_types The types of the parameters in the statement
@@ -171,22 +191,74 @@ class PostgresPacketWriter : public PacketWriter {
   void WriteDataRow(const byte *tuple, const std::vector<planner::OutputSchema::Column> &columns,
                     const std::vector<FieldFormat> &field_formats);
 
+  /**
+   * Write a batch of data rows from the execution engine back to the client. The layout of the rows is resolved once
+   * for the whole result, so each attribute is written straight from the tuple into the write queue.
+   * @param tuples pointer to the start of the first row
+   * @param num_tuples number of rows to write
+   * @param tuple_size size of each row
+   * @param attributes layout of the rows, as computed by MakeDataRowLayout()
+   */
+  void WriteDataRows(const byte *tuples, uint32_t num_tuples, uint32_t tuple_size,
+                     const std::vector<DataRowAttribute> &attributes);
+
+  /**
+   * Start streaming the result of a COPY ... TO STDOUT in binary format: a CopyOutResponse, followed by the header of
+   * the binary COPY format
+   * @param num_columns number of columns in each row
+   */
+  void WriteBinaryCopyOutStart(uint16_t num_columns);
+
+  /**
+   * Write a batch of rows from the execution engine as CopyData messages in the binary COPY format, one per row
+   * @param tuples pointer to the start of the first row
+   * @param num_tuples number of rows to write
+   * @param tuple_size size of each row
+   * @param attributes layout of the rows, as computed by MakeDataRowLayout() with binary formats
+   */
+  void WriteBinaryCopyRows(const byte *tuples, uint32_t num_tuples, uint32_t tuple_size,
+                           const std::vector<DataRowAttribute> &attributes);
+
+  /**
+   * Finish streaming the result of a COPY ... TO STDOUT in binary format: the trailer of the binary COPY format,
+   * followed by a CopyDone
+   */
+  void WriteBinaryCopyOutEnd();
+
+  /**
+   * Tells the client to start sending the data of a COPY ... FROM STDIN
+   * @param num_columns number of columns in each row
+   * @param format binary for the binary COPY format, text for the text and CSV formats
+   */
+  void WriteCopyInResponse(uint16_t num_columns, FieldFormat format);
+
+  /**
+   * @param columns OutputSchema describing the rows
+   * @param field_formats vector formats for the attributes to write
+   * @return The layout of the rows the execution engine outputs with the given schema.
+   */
+  static std::vector<DataRowAttribute> MakeDataRowLayout(const std::vector<planner::OutputSchema::Column> &columns,
+                                                         const std::vector<FieldFormat> &field_formats);
+
  private:
   template <class native_type, class val_type>
   void WriteBinaryVal(const execution::sql::Val *val, type::TypeId type);
 
-  template <class native_type, class val_type>
-  void WriteBinaryValNeedsToNative(const execution::sql::Val *val, type::TypeId type);
-
-  uint32_t WriteBinaryAttribute(const execution::sql::Val *val, type::TypeId type);
+  /**
+   * Write an attribute in Postgres' binary format coming from an OutputBuffer in the execution engine. This is the
+   * format of both DataRow messages for results a Bind asked for in binary, and of the binary COPY format.
+   * @param val the attribute
+   * @param type the type of the attribute
+   */
+  void WriteBinaryAttribute(const execution::sql::Val *val, type::TypeId type);
 
   /**
-   * Write a data row in Postgres' text format coming from an OutputBuffer in the execution engine. Simple Query
+   * Write an attribute in Postgres' text format coming from an OutputBuffer in the execution engine. Simple Query
    * messages always reply with text format data.
-   * @param tuple pointer to the start of the row
-   * @param columns OutputSchema describing the tuple
+   * @param val the attribute
+   * @param type the type of the attribute
    */
-  uint32_t WriteTextAttribute(const execution::sql::Val *val, type::TypeId type);
+  void WriteTextAttribute(const execution::sql::Val *val, type::TypeId type);
 };
 
 }  // namespace noisepage::network
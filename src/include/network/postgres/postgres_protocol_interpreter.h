@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -8,6 +9,7 @@
 #include "loggers/network_logger.h"
 #include "network/connection_context.h"
 #include "network/connection_handle.h"
+#include "network/postgres/copy_in_reader.h"
 #include "network/postgres/portal.h"
 #include "network/postgres/postgres_command_factory.h"
 #include "network/postgres/postgres_network_commands.h"
@@ -18,10 +20,6 @@
 
 namespace noisepage::network {
 
-constexpr uint32_t INITIAL_BACKOFF_TIME = 2;
-constexpr uint32_t BACKOFF_FACTOR = 2;
-constexpr uint32_t MAX_BACKOFF_TIME = 20;
-
 /**
  * Interprets the network protocol for postgres clients. Any state/logic that is Postgres protocol-specific should live
  * at this layer.
@@ -148,6 +146,33 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
     waiting_for_sync_ = false;
   }
 
+  /**
+   * @return the reader of the COPY ... FROM STDIN whose data the client is sending, nullptr if there is none
+   */
+  common::ManagedPointer<CopyInReader> GetCopyIn() const { return common::ManagedPointer(copy_in_); }
+
+  /**
+   * Starts reading the data of a COPY ... FROM STDIN from the CopyData messages that follow
+   * @param copy_in reader for the data
+   */
+  void SetCopyIn(std::unique_ptr<CopyInReader> &&copy_in) { copy_in_ = std::move(copy_in); }
+
+  /**
+   * Called once the client is done sending the data of a COPY ... FROM STDIN
+   */
+  void ResetCopyIn() { copy_in_.reset(); }
+
+  /**
+   * Ends the COPY ... FROM STDIN in progress: reports how it went, ends the txn unless it is in a transaction block,
+   * and tells the client that it's ready for the next query
+   * @param out writer for the replies
+   * @param t_cop traffic cop to end the txn with
+   * @param context context of the connection
+   * @param error what went wrong, or std::nullopt if the data was inserted
+   */
+  void EndCopyIn(common::ManagedPointer<PostgresPacketWriter> out, common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                 common::ManagedPointer<ConnectionContext> context, const std::optional<common::ErrorData> &error);
+
   /**
    * @param name statement to look up
    * @return managed pointer to statement if it exists, nullptr otherwise
@@ -230,6 +255,10 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
   void SetPacketMessageType(common::ManagedPointer<ReadBuffer> in) override;
 
  private:
+  // Execute the command in the current input packet.
+  Transition ProcessPacket(common::ManagedPointer<WriteQueue> out, common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                           common::ManagedPointer<ConnectionContext> context);
+
   bool startup_ = true;
   bool waiting_for_sync_ = false;
   bool explicit_txn_block_ = false;
@@ -244,6 +273,9 @@ class PostgresProtocolInterpreter : public ProtocolInterpreter {
   // name to portal
   std::unordered_map<std::string, std::unique_ptr<network::Portal>> portals_;
 
+  // reader of the COPY ... FROM STDIN in progress, which inserts into the current txn
+  std::unique_ptr<CopyInReader> copy_in_;
+
   /**
    * close all Portals constructed from a Statement. We don't care about return value since it's not an error to call
    * Close on non-existent statement
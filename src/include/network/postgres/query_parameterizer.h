@@ -0,0 +1,43 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "parser/expression/constant_value_expression.h"
+
+namespace noisepage::network {
+
+/**
+ * Simple Query protocol clients send their constants inline, so two queries that only differ in a constant have
+ * different text and share no cached plan. The QueryParameterizer rewrites the constants of a SELECT, INSERT, UPDATE or
+ * DELETE into parameters, e.g., "SELECT * FROM foo WHERE id = 42" into "SELECT * FROM foo WHERE id = $1" with 42 as
+ * its parameter, which makes the query look like a prepared statement to the rest of the system.
+ *
+ * The rewrite works on the query text so that it is done before the query is parsed. It is conservative: a constant is
+ * only replaced where a parameter means the same thing, i.e., as an operand in a predicate, an INSERT's VALUES or an
+ * UPDATE's SET clause. Constants in a select list, ORDER BY and GROUP BY lists, LIMIT and OFFSET, function arguments,
+ * typed literals (DATE '...') and casts are left alone, and so are queries with comments or dollar-quoting.
+ */
+class QueryParameterizer {
+ public:
+  /**
+   * Replace the constants of a query by parameters.
+   * @param query_text The text of the query.
+   * @param[out] parameters The constants that were replaced, in the order of their parameters.
+   * @return The text of the query with parameters, or std::nullopt if no constant was replaced.
+   */
+  static std::optional<std::string> Parameterize(const std::string &query_text,
+                                                 std::vector<parser::ConstantValueExpression> *parameters);
+
+  /**
+   * Split the text of a Simple Query into its statements. Semicolons in strings, quoted identifiers, dollar-quoted
+   * strings and comments do not end a statement, and statements that are only whitespace are dropped.
+   * @param query_text The text of the query.
+   * @return The text of every statement, without the semicolon that ends it. A query with no statement at all is
+   * returned as it is, so that it still gets the response to an empty query.
+   */
+  static std::vector<std::string> SplitStatements(const std::string &query_text);
+};
+
+}  // namespace noisepage::network
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <deque>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -80,9 +82,14 @@ class Statement {
    * @return the optimize result of the query
    */
   common::ManagedPointer<optimizer::OptimizeResult> OptimizeResult() const {
-    return common::ManagedPointer(optimize_result_);
+    return common::ManagedPointer(optimize_result_.get());
   }
 
+  /**
+   * @return shared ownership of the optimize result, for caches that outlive this Statement
+   */
+  std::shared_ptr<optimizer::OptimizeResult> ShareOptimizeResult() const { return optimize_result_; }
+
   /**
    * @return the optimized physical plan for this query
    */
@@ -92,13 +99,13 @@ class Statement {
    * @return the compiled executable query
    */
   common::ManagedPointer<execution::compiler::ExecutableQuery> GetExecutableQuery() const {
-    return common::ManagedPointer(executable_query_);
+    return common::ManagedPointer(executable_query_.get());
   }
 
   /**
-   * @param optimize_result optimize result to take ownership of
+   * @param optimize_result optimize result to take (possibly shared) ownership of
    */
-  void SetOptimizeResult(std::unique_ptr<optimizer::OptimizeResult> &&optimize_result) {
+  void SetOptimizeResult(std::shared_ptr<optimizer::OptimizeResult> optimize_result) {
     optimize_result_ = std::move(optimize_result);
   }
 
@@ -112,9 +119,9 @@ class Statement {
     optimize_result_->SetPlanNode(std::move(physical_plan));
   }
   /**
-   * @param executable_query executable query to take ownership of
+   * @param executable_query executable query to take (possibly shared) ownership of
    */
-  void SetExecutableQuery(std::unique_ptr<execution::compiler::ExecutableQuery> &&executable_query) {
+  void SetExecutableQuery(std::shared_ptr<execution::compiler::ExecutableQuery> executable_query) {
     executable_query_ = std::move(executable_query);
   }
 
@@ -135,6 +142,41 @@ class Statement {
    */
   const std::vector<type::TypeId> &GetDesiredParamTypes() const { return desired_param_types_; }
 
+  /** Number of plans, besides the current one, that are kept for other selectivity buckets of the parameters. */
+  static constexpr std::size_t MAX_PLAN_VARIANTS = 4;
+
+  /**
+   * Switch to the plan for parameters that fall into the given selectivity buckets. The current plan is set aside
+   * for its own buckets, evicting the oldest plan set aside if there are too many. The plan for the given buckets
+   * becomes current if one was set aside, otherwise the Statement is left without a plan to be optimized again.
+   * A plan whose buckets are unknown, e.g. one shared by another connection, is taken to be the plan for them.
+   * @param selectivity_buckets selectivity buckets of the parameters being bound, see
+   * TrafficCopUtil::ParameterSelectivityBuckets
+   */
+  void UsePlanVariant(std::vector<uint8_t> &&selectivity_buckets) {
+    if (optimize_result_ != nullptr && !selectivity_buckets_.has_value()) {
+      selectivity_buckets_ = std::move(selectivity_buckets);
+      return;
+    }
+    if (selectivity_buckets_ == selectivity_buckets) return;
+
+    if (optimize_result_ != nullptr) {
+      if (plan_variants_.size() == MAX_PLAN_VARIANTS) plan_variants_.pop_front();
+      plan_variants_.push_back({std::move(*selectivity_buckets_), optimize_result_, executable_query_});
+    }
+    optimize_result_ = nullptr;
+    executable_query_ = nullptr;
+    for (auto it = plan_variants_.begin(); it != plan_variants_.end(); ++it) {
+      if (it->selectivity_buckets_ == selectivity_buckets) {
+        optimize_result_ = std::move(it->optimize_result_);
+        executable_query_ = std::move(it->executable_query_);
+        plan_variants_.erase(it);
+        break;
+      }
+    }
+    selectivity_buckets_ = std::move(selectivity_buckets);
+  }
+
   /**
    * Remove the cached objects related to query execution for this Statement. This should be done any time there is a
    * DDL change related to this statement.
@@ -143,6 +185,8 @@ class Statement {
     optimize_result_ = nullptr;
     executable_query_ = nullptr;
     desired_param_types_ = {};
+    selectivity_buckets_ = std::nullopt;
+    plan_variants_.clear();
   }
 
  private:
@@ -155,9 +199,19 @@ class Statement {
   // The following objects can be "cached" in Statement objects for future statement invocations. Though they don't
   // relate to the Postgres Statement concept, these objects should be compatible with future queries that match the
   // same query text. The exception to this that DDL changes can break these cached objects.
-  std::unique_ptr<optimizer::OptimizeResult> optimize_result_ = nullptr;              // generated in the Bind phase
-  std::unique_ptr<execution::compiler::ExecutableQuery> executable_query_ = nullptr;  // generated in the Execute phase
+  // The optimize result and executable query may be shared with the compiled query cache.
+  std::shared_ptr<optimizer::OptimizeResult> optimize_result_ = nullptr;              // generated in the Bind phase
+  std::shared_ptr<execution::compiler::ExecutableQuery> executable_query_ = nullptr;  // generated in the Execute phase
   std::vector<type::TypeId> desired_param_types_;                                     // generated in the Bind phase
+
+  // Plans for parameters whose selectivities fall into other buckets than those of the current plan, oldest first.
+  struct PlanVariant {
+    std::vector<uint8_t> selectivity_buckets_;
+    std::shared_ptr<optimizer::OptimizeResult> optimize_result_;
+    std::shared_ptr<execution::compiler::ExecutableQuery> executable_query_;
+  };
+  std::optional<std::vector<uint8_t>> selectivity_buckets_;  // of the current plan, unknown if it came from elsewhere
+  std::deque<PlanVariant> plan_variants_;
 };
 
 }  // namespace noisepage::network
@@ -48,6 +48,17 @@ class ProtocolInterpreter {
    */
   virtual void GetResult(common::ManagedPointer<WriteQueue> out) = 0;
 
+  /**
+   * @return The buffer of the packet being read if it is larger than the read buffer and still incomplete, nullptr
+   *         otherwise. The rest of such a packet can be read into its buffer directly.
+   */
+  common::ManagedPointer<ReadBuffer> IncompleteExtendedPacket() {
+    if (!curr_input_packet_.header_parsed_ || !curr_input_packet_.extended_ || curr_input_packet_.buf_->Full()) {
+      return nullptr;
+    }
+    return common::ManagedPointer(curr_input_packet_.buf_);
+  }
+
   /**
    * Default destructor for ProtocolInterpreter
    */
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <algorithm>
+
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+#include "optimizer/cost_model/abstract_cost_model.h"
+#include "optimizer/optimizer_defs.h"
+
+namespace noisepage::optimizer {
+
+class Memo;
+class GroupExpression;
+class StatsStorage;
+
+/**
+ * Cost model that charges every operator for the tuples it touches. The number of tuples comes from the cardinality
+ * that the StatsCalculator estimated for the groups of the operator and its children, and the number of tuples in a
+ * table from its TableStats. Every kind of work on a tuple has a coefficient relative to reading a tuple in a
+ * sequential scan, which accounts for both its CPU cost and the memory it needs (e.g. building a hash table).
+ *
+ * Unlike the TrivialCostModel, this lets join order and access paths depend on the size of the data: a nested loop
+ * join wins when one of its inputs is tiny, a hash join when both are large, and an index scan only when it is
+ * selective enough.
+ *
+ * The cost is the time the work takes rather than the work itself. The execution engine splits the work of sequential
+ * scans, hash joins, hash and plain aggregations and sorts among its threads. Their cost is divided by the number of
+ * threads that parallel execution uses, so with more threads the optimizer prefers plans that run in parallel.
+ * Index scans, index joins, nested loop joins and merge joins make the pipeline that runs them serial, so their cost
+ * stays whole.
+ */
+class CardinalityCostModel : public AbstractCostModel {
+ public:
+  /** Cost of reading a tuple in a sequential scan, which the other coefficients are relative to */
+  static constexpr double SEQ_SCAN_TUPLE_COST = 1.0;
+
+  /** Cost of reading a tuple through an index, which is a random access to the table */
+  static constexpr double INDEX_SCAN_TUPLE_COST = 2.0;
+
+  /** Cost of descending an index to the first key that matches */
+  static constexpr double INDEX_PROBE_COST = 20.0;
+
+  /** Cost of evaluating the join predicate on a pair of tuples in a nested loop join */
+  static constexpr double NLJOIN_PAIR_COST = 0.5;
+
+  /** Cost of inserting a tuple into a hash table, including the memory for it */
+  static constexpr double HASH_BUILD_TUPLE_COST = 3.0;
+
+  /** Cost of looking a tuple up in a hash table */
+  static constexpr double HASH_PROBE_TUPLE_COST = 1.5;
+
+  /** Cost of advancing past a tuple in a merge join */
+  static constexpr double MERGE_TUPLE_COST = 1.0;
+
+  /** Cost of a comparison while sorting, of which there are n log n for n tuples */
+  static constexpr double SORT_TUPLE_COST = 2.0;
+
+  /** Cost of updating an aggregate with a tuple */
+  static constexpr double AGG_TUPLE_COST = 1.0;
+
+  /** Cost of producing an output tuple of a join */
+  static constexpr double OUTPUT_TUPLE_COST = 0.1;
+
+  /** Number of tuples assumed for a table that was never analyzed, or a group whose cardinality is unknown */
+  static constexpr double DEFAULT_NUM_ROWS = 1000.0;
+
+  /**
+   * Constructor
+   * @param stats_storage where the statistics of the tables are kept
+   * @param num_threads number of threads that parallel execution uses, 1 if it is disabled
+   */
+  explicit CardinalityCostModel(common::ManagedPointer<StatsStorage> stats_storage, uint32_t num_threads = 1)
+      : stats_storage_(stats_storage), num_threads_(std::max(num_threads, 1U)) {}
+
+  /**
+   * @return number of threads that the work of operators that run in parallel is divided among
+   */
+  uint32_t GetNumThreads() const { return num_threads_; }
+
+  /**
+   * Costs a GroupExpression
+   * @param txn TransactionContext that query is generated under
+   * @param accessor CatalogAccessor
+   * @param memo Memo object containing all relevant groups
+   * @param gexpr GroupExpression to calculate cost for
+   */
+  double CalculateCost(transaction::TransactionContext *txn, catalog::CatalogAccessor *accessor, Memo *memo,
+                       GroupExpression *gexpr) override;
+
+  /**
+   * Visit a SeqScan operator
+   * @param op operator
+   */
+  void Visit(const SeqScan *op) override;
+
+  /**
+   * Visit a IndexScan operator
+   * @param op operator
+   */
+  void Visit(const IndexScan *op) override;
+
+  /**
+   * Visit a QueryDerivedScan operator
+   * @param op operator
+   */
+  void Visit(const QueryDerivedScan *op) override;
+
+  /**
+   * Visit a OrderBy operator
+   * @param op operator
+   */
+  void Visit(const OrderBy *op) override;
+
+  /**
+   * Visit a Limit operator
+   * @param op operator
+   */
+  void Visit(const Limit *op) override;
+
+  /**
+   * Visit a InnerIndexJoin operator
+   * @param op operator
+   */
+  void Visit(const InnerIndexJoin *op) override;
+
+  /**
+   * Visit a InnerNLJoin operator
+   * @param op operator
+   */
+  void Visit(const InnerNLJoin *op) override;
+
+  /**
+   * Visit a LeftNLJoin operator
+   * @param op operator
+   */
+  void Visit(const LeftNLJoin *op) override;
+
+  /**
+   * Visit a RightNLJoin operator
+   * @param op operator
+   */
+  void Visit(const RightNLJoin *op) override;
+
+  /**
+   * Visit a OuterNLJoin operator
+   * @param op operator
+   */
+  void Visit(const OuterNLJoin *op) override;
+
+  /**
+   * Visit a InnerHashJoin operator
+   * @param op operator
+   */
+  void Visit(const InnerHashJoin *op) override;
+
+  /**
+   * Visit a LeftHashJoin operator
+   * @param op operator
+   */
+  void Visit(const LeftHashJoin *op) override;
+
+  /**
+   * Visit a RightHashJoin operator
+   * @param op operator
+   */
+  void Visit(const RightHashJoin *op) override;
+
+  /**
+   * Visit a OuterHashJoin operator
+   * @param op operator
+   */
+  void Visit(const OuterHashJoin *op) override;
+
+  /**
+   * Visit a LeftSemiHashJoin operator
+   * @param op operator
+   */
+  void Visit(const LeftSemiHashJoin *op) override;
+
+  /**
+   * Visit a InnerMergeJoin operator
+   * @param op operator
+   */
+  void Visit(const InnerMergeJoin *op) override;
+
+  /**
+   * Visit a HashGroupBy operator
+   * @param op operator
+   */
+  void Visit(const HashGroupBy *op) override;
+
+  /**
+   * Visit a SortGroupBy operator
+   * @param op operator
+   */
+  void Visit(const SortGroupBy *op) override;
+
+  /**
+   * Visit a Aggregate operator
+   * @param op operator
+   */
+  void Visit(const Aggregate *op) override;
+
+ private:
+  /** @return estimated number of tuples that the group produces */
+  double GroupRows(group_id_t group_id) const;
+
+  /** @return estimated number of tuples that the expression being costed produces */
+  double OutputRows() const;
+
+  /** @return estimated number of tuples that the child of the expression being costed produces */
+  double ChildRows(size_t child_idx) const;
+
+  void CostNLJoin();
+  void CostHashJoin();
+
+  /** @return time that work of the given cost takes when it is split among the threads */
+  double InParallel(double cost) const { return cost / num_threads_; }
+
+  /**
+   * Statistics of the tables
+   */
+  const common::ManagedPointer<StatsStorage> stats_storage_;
+
+  /**
+   * Number of threads that parallel execution uses
+   */
+  const uint32_t num_threads_;
+
+  /**
+   * GroupExpression to cost
+   */
+  GroupExpression *gexpr_;
+
+  /**
+   * Memo table to use
+   */
+  Memo *memo_;
+
+  /**
+   * Accessor
+   */
+  catalog::CatalogAccessor *accessor_;
+
+  /**
+   * Computed output cost
+   */
+  double output_cost_ = 0;
+};
+
+}  // namespace noisepage::optimizer
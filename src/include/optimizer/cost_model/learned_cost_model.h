@@ -0,0 +1,260 @@
+#pragma once
+
+#include <chrono>  // NOLINT
+#include <memory>
+#include <mutex>  // NOLINT
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+#include "optimizer/cost_model/abstract_cost_model.h"
+#include "optimizer/optimizer_defs.h"
+#include "parser/expression/abstract_expression.h"
+#include "self_driving/modeling/operating_unit_defs.h"
+#include "self_driving/modeling/ou_model.h"
+
+namespace noisepage::modelserver {
+class ModelServerManager;
+}  // namespace noisepage::modelserver
+
+namespace noisepage::optimizer {
+
+class Memo;
+class GroupExpression;
+class StatsStorage;
+
+/**
+ * Predictions of the operating unit models, shared by the optimizations of all queries. The same features come up
+ * again and again, both among the candidate plans of a query and across queries, so most of them never have to be
+ * sent to the model server.
+ */
+class OUPredictionCache {
+ public:
+  /** Number of predictions after which the cache starts over */
+  static constexpr size_t MAX_ENTRIES = 1 << 16;
+
+  /**
+   * @param type operating unit
+   * @param features features of the operating unit
+   * @return predicted elapsed time of the operating unit, if it is cached
+   */
+  std::optional<double> Get(selfdriving::ExecutionOperatingUnitType type, const std::vector<double> &features);
+
+  /**
+   * Caches a prediction
+   * @param type operating unit
+   * @param features features of the operating unit
+   * @param elapsed_us predicted elapsed time of the operating unit
+   */
+  void Put(selfdriving::ExecutionOperatingUnitType type, const std::vector<double> &features, double elapsed_us);
+
+ private:
+  using Key = std::pair<selfdriving::ExecutionOperatingUnitType, std::vector<double>>;
+  struct KeyHasher {
+    size_t operator()(const Key &key) const;
+  };
+
+  std::mutex latch_;
+  std::unordered_map<Key, double, KeyHasher> predictions_;
+};
+
+/**
+ * Cost model that asks the operating unit models of the self-driving infrastructure for the elapsed time of every
+ * physical operator. The operator is translated into the operating units that its translator would record, with the
+ * cardinalities that the StatsCalculator estimated, and the predictions for all of them are requested in one batch per
+ * operating unit type, after looking them up in an OUPredictionCache.
+ *
+ * The models that the model server exported are evaluated in-process, which takes microseconds. The model server is
+ * only asked for the rest, with a tight timeout, since the query waits for it. Once a request fails or times out, the
+ * model stops asking and costs the rest of the query with the fallback cost model.
+ */
+class LearnedCostModel : public AbstractCostModel {
+ public:
+  /**
+   * Constructor
+   * @param stats_storage where the statistics of the tables are kept
+   * @param db_oid database that the query runs in
+   * @param model_server_manager the model server, which must be started
+   * @param model_save_path path to the trained operating unit models
+   * @param timeout how long to wait for a batch of predictions
+   * @param ou_models the exported models to evaluate in-process, or nullptr to ask the model server for all of them
+   * @param cache predictions that were already made
+   * @param execution_mode mode that the query is executed in, which is a feature of the models
+   * @param fallback cost model for when the model server cannot be asked
+   */
+  LearnedCostModel(common::ManagedPointer<StatsStorage> stats_storage, catalog::db_oid_t db_oid,
+                   common::ManagedPointer<modelserver::ModelServerManager> model_server_manager,
+                   std::string model_save_path, std::chrono::milliseconds timeout,
+                   std::shared_ptr<const selfdriving::OUModelMap> ou_models,
+                   common::ManagedPointer<OUPredictionCache> cache, uint8_t execution_mode,
+                   std::unique_ptr<AbstractCostModel> fallback);
+
+  /**
+   * Costs a GroupExpression
+   * @param txn TransactionContext that query is generated under
+   * @param accessor CatalogAccessor
+   * @param memo Memo object containing all relevant groups
+   * @param gexpr GroupExpression to calculate cost for
+   */
+  double CalculateCost(transaction::TransactionContext *txn, catalog::CatalogAccessor *accessor, Memo *memo,
+                       GroupExpression *gexpr) override;
+
+  /**
+   * @return whether the model server failed, so that the fallback cost model is used
+   */
+  bool UsingFallback() const { return use_fallback_; }
+
+  /**
+   * Visit a SeqScan operator
+   * @param op operator
+   */
+  void Visit(const SeqScan *op) override;
+
+  /**
+   * Visit a IndexScan operator
+   * @param op operator
+   */
+  void Visit(const IndexScan *op) override;
+
+  /**
+   * Visit a OrderBy operator
+   * @param op operator
+   */
+  void Visit(const OrderBy *op) override;
+
+  /**
+   * Visit a InnerIndexJoin operator
+   * @param op operator
+   */
+  void Visit(const InnerIndexJoin *op) override;
+
+  /**
+   * Visit a InnerNLJoin operator
+   * @param op operator
+   */
+  void Visit(const InnerNLJoin *op) override;
+
+  /**
+   * Visit a LeftNLJoin operator
+   * @param op operator
+   */
+  void Visit(const LeftNLJoin *op) override;
+
+  /**
+   * Visit a RightNLJoin operator
+   * @param op operator
+   */
+  void Visit(const RightNLJoin *op) override;
+
+  /**
+   * Visit a OuterNLJoin operator
+   * @param op operator
+   */
+  void Visit(const OuterNLJoin *op) override;
+
+  /**
+   * Visit a InnerHashJoin operator
+   * @param op operator
+   */
+  void Visit(const InnerHashJoin *op) override;
+
+  /**
+   * Visit a LeftHashJoin operator
+   * @param op operator
+   */
+  void Visit(const LeftHashJoin *op) override;
+
+  /**
+   * Visit a RightHashJoin operator
+   * @param op operator
+   */
+  void Visit(const RightHashJoin *op) override;
+
+  /**
+   * Visit a OuterHashJoin operator
+   * @param op operator
+   */
+  void Visit(const OuterHashJoin *op) override;
+
+  /**
+   * Visit a LeftSemiHashJoin operator
+   * @param op operator
+   */
+  void Visit(const LeftSemiHashJoin *op) override;
+
+  /**
+   * Visit a InnerMergeJoin operator
+   * @param op operator
+   */
+  void Visit(const InnerMergeJoin *op) override;
+
+  /**
+   * Visit a HashGroupBy operator
+   * @param op operator
+   */
+  void Visit(const HashGroupBy *op) override;
+
+  /**
+   * Visit a SortGroupBy operator
+   * @param op operator
+   */
+  void Visit(const SortGroupBy *op) override;
+
+  /**
+   * Visit a Aggregate operator
+   * @param op operator
+   */
+  void Visit(const Aggregate *op) override;
+
+ private:
+  /** @return estimated number of tuples that the group produces */
+  double GroupRows(group_id_t group_id) const;
+  double OutputRows() const;
+  double ChildRows(size_t child_idx) const;
+
+  /** @return number of tuples in the table, according to its statistics */
+  double TableRows(catalog::table_oid_t table_oid) const;
+
+  /** Adds an operating unit of the operator being costed */
+  void AddOU(selfdriving::ExecutionOperatingUnitType type, double num_rows, size_t key_size, size_t num_keys,
+             double cardinality, double num_loops = 0);
+
+  void AddNLJoin();
+  void AddHashJoin(const std::vector<common::ManagedPointer<parser::AbstractExpression>> &left_keys);
+
+  /** @return size of the keys in the layout of the execution engine, like the OperatingUnitRecorder computes it */
+  static size_t KeySize(const std::vector<common::ManagedPointer<parser::AbstractExpression>> &keys, size_t *num_keys);
+
+  /** @return predicted elapsed time of the operating units in ous_, or nullopt if the models failed */
+  std::optional<double> Predict();
+
+  const common::ManagedPointer<StatsStorage> stats_storage_;
+  const catalog::db_oid_t db_oid_;
+  const common::ManagedPointer<modelserver::ModelServerManager> model_server_manager_;
+  const std::string model_save_path_;
+  const std::chrono::milliseconds timeout_;
+  const std::shared_ptr<const selfdriving::OUModelMap> ou_models_;
+  const common::ManagedPointer<OUPredictionCache> cache_;
+  const std::unique_ptr<AbstractCostModel> fallback_;
+
+  /** Features that every prediction starts with */
+  const double cpu_mhz_;
+  const double execution_mode_;
+
+  GroupExpression *gexpr_;
+  Memo *memo_;
+  catalog::CatalogAccessor *accessor_;
+
+  /** Operating units of the operator being costed, with their features */
+  std::vector<std::pair<selfdriving::ExecutionOperatingUnitType, std::vector<double>>> ous_;
+
+  /** Whether the model server failed during this optimization */
+  bool use_fallback_ = false;
+};
+
+}  // namespace noisepage::optimizer
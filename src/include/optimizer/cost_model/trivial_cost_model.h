@@ -132,6 +132,13 @@ class TrivialCostModel : public AbstractCostModel {
    */
   void Visit(UNUSED_ATTRIBUTE const LeftSemiHashJoin *op) override { output_cost_ = 1.f; }
 
+  /**
+   * Visit a InnerMergeJoin operator. Merge joins are only planned when both inputs are index-ordered,
+   * in which case they are preferred over nested loop and hash joins.
+   * @param op operator
+   */
+  void Visit(UNUSED_ATTRIBUTE const InnerMergeJoin *op) override { output_cost_ = NLJOIN_COST - 0.5f; }
+
   /**
    * Visit a Insert operator
    * @param op operator
@@ -14,6 +14,7 @@
 #include "optimizer/property.h"
 #include "optimizer/property_set.h"
 #include "optimizer/statistics/column_stats.h"
+#include "optimizer/statistics/derived_column_stats.h"
 
 namespace noisepage::optimizer {
 
@@ -134,6 +135,32 @@ class Group {
    */
   bool HasNumRows() { return num_rows_ != UNINITIALIZED_NUM_ROWS; }
 
+  /**
+   * Sets the statistics of a column in the output of the group
+   * @param column_name full name of the column, [table alias].[column name], or the full names of the columns of a
+   *                    column group in sorted order joined by ','
+   * @param stats statistics of the column
+   */
+  void AddStats(const std::string &column_name, DerivedColumnStats stats) {
+    stats_.insert_or_assign(column_name, std::move(stats));
+  }
+
+  /**
+   * Gets the statistics of a column in the output of the group
+   * @param column_name full name of the column, as given to AddStats()
+   * @returns statistics of the column, nullptr if none were derived
+   */
+  const DerivedColumnStats *GetStats(const std::string &column_name) const {
+    const auto it = stats_.find(column_name);
+    return it == stats_.end() ? nullptr : &it->second;
+  }
+
+  /**
+   * Gets the statistics of all of the columns in the output of the group
+   * @returns statistics of the columns by their full name
+   */
+  const std::unordered_map<std::string, DerivedColumnStats> &GetAllStats() const { return stats_; }
+
   /**
    * Gets this Group's GroupID
    * @returns GroupID of this group
@@ -201,6 +228,11 @@ class Group {
    */
   int num_rows_ = UNINITIALIZED_NUM_ROWS;
 
+  /**
+   * Statistics of the columns in the output of the group, derived together with the number of rows
+   */
+  std::unordered_map<std::string, DerivedColumnStats> stats_;
+
   /**
    * Cost Lower Bound
    */
@@ -53,7 +53,8 @@ class IndexUtil {
   /**
    * Checks whether a given index can be used to satisfy a property.
    * For an index to fulfill the sort property, the columns sorted
-   * on must be in the same order and in the same direction.
+   * on must be in the same order and in the same direction. A partial
+   * index misses the tuples outside of its predicate, so it never does.
    *
    * @param accessor CatalogAccessor
    * @param prop PropertySort to satisfy
@@ -65,7 +66,9 @@ class IndexUtil {
                                      catalog::table_oid_t tbl_oid, catalog::index_oid_t idx_oid);
 
   /**
-   * Checks whether a set of predicates can be satisfied with an index
+   * Checks whether a set of predicates can be satisfied with an index. Predicates bound a key column either through
+   * the column itself or, for a key column that stores an expression, through the same expression. A partial index is
+   * only considered if the predicates imply its predicate.
    * @param accessor CatalogAccessor
    * @param tbl_oid OID of the table
    * @param tbl_alias Name of the table
@@ -84,6 +87,42 @@ class IndexUtil {
       planner::IndexScanType *scan_type,
       std::unordered_map<catalog::indexkeycol_oid_t, std::vector<planner::IndexExpression>> *bounds);
 
+  /**
+   * Checks whether an index scan can produce the given columns from its key alone, without reading the table. An
+   * exact scan binds every column of the index to a value, and an indexed update moves the tuple to a new slot, so an
+   * entry that the scan finds visible holds the same key values as the tuple it points to.
+   * @param accessor CatalogAccessor
+   * @param tbl_oid OID of the table
+   * @param index_oid OID of the index
+   * @param scan_type IndexScanType that the scan uses
+   * @param col_oids columns that the scan reads
+   * @returns TRUE if every column is a base column of the index and the scan is exact
+   */
+  static bool SatisfiesColumnsWithIndexKey(catalog::CatalogAccessor *accessor, catalog::table_oid_t tbl_oid,
+                                           catalog::index_oid_t index_oid, planner::IndexScanType scan_type,
+                                           const std::vector<catalog::col_oid_t> &col_oids);
+
+  /**
+   * Checks whether the predicates of a scan imply the predicate of a partial index, in which case every tuple the scan
+   * returns has an entry in the index. Each conjunct of the index predicate has to appear among the scan's predicates.
+   * @param schema IndexSchema of the index
+   * @param predicates Predicates of the scan, which are conjuncts
+   * @returns TRUE if the index has no predicate or the predicates imply it
+   */
+  static bool SatisfiesIndexPredicate(const catalog::IndexSchema &schema,
+                                      const std::vector<AnnotatedExpression> &predicates);
+
+  /**
+   * Checks whether an expression computes the same value as an expression stored in an index schema. Unlike
+   * AbstractExpression::operator==, this ignores names and aliases, which differ between the CREATE INDEX statement
+   * and a query, and compares columns by their oids.
+   * @param index_expr Expression stored in the index schema
+   * @param expr Expression of a query
+   * @returns TRUE if the expressions match
+   */
+  static bool MatchesIndexExpression(const parser::AbstractExpression &index_expr,
+                                     const parser::AbstractExpression &expr);
+
  private:
   /**
    * Check whether predicate can take part in index computation
@@ -107,8 +146,8 @@ class IndexUtil {
       std::unordered_map<catalog::indexkeycol_oid_t, std::vector<planner::IndexExpression>> *bounds);
 
   /**
-   * Retrieves the catalog::col_oid_t equivalent for the index
-   * @requires SatisfiesBaseColumnRequirement(schema)
+   * Retrieves the catalog::col_oid_t equivalent for the base columns of the index. Key columns that store an
+   * expression are skipped.
    * @param accessor CatalogAccessor to use
    * @param tbl_oid Table the index belongs to
    * @param schema Schema
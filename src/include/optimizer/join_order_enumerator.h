@@ -0,0 +1,94 @@
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "optimizer/abstract_optimizer_node.h"
+#include "optimizer/optimizer_defs.h"
+
+namespace noisepage::optimizer {
+
+class OptimizerContext;
+
+/**
+ * Picks the join order of multi-way inner joins before the rules explore the Memo.
+ *
+ * Exploring every join order with the associativity and commutativity rules blows the Memo up exponentially, so a
+ * query with more than a handful of tables never finishes optimizing within its task budget. Instead, every maximal
+ * tree of inner joins is flattened into its relations and the join predicates between them, which form a query
+ * hypergraph. The cheapest bushy tree over that hypergraph is found by dynamic programming over the connected subsets
+ * of the relations, or greedily by repeatedly joining the pair with the smallest result (GOO) when there are too many
+ * relations for that. The tree is costed by the sum of the cardinalities of its intermediate results (C_out), and it
+ * replaces the logical expression of the join in the Memo. Cross products are only considered for relations that no
+ * predicate connects.
+ */
+class JoinOrderEnumerator {
+ public:
+  /** Smallest number of relations whose join order is enumerated, below which the rules are cheap enough */
+  static constexpr size_t MIN_RELATIONS = 4;
+  /** Largest number of relations that are enumerated with dynamic programming instead of greedily */
+  static constexpr size_t MAX_DP_RELATIONS = 15;
+  /** Largest number of relations that can be ordered at all */
+  static constexpr size_t MAX_RELATIONS = 64;
+  /** Cardinality of a relation whose stats could not be derived */
+  static constexpr double DEFAULT_NUM_ROWS = 1000;
+
+  /**
+   * Constructor
+   * @param context OptimizerContext whose Memo holds the rewritten query
+   */
+  explicit JoinOrderEnumerator(OptimizerContext *context) : context_(context) {}
+
+  /**
+   * Orders every multi-way inner join under a group
+   * @param root_group_id group to start at
+   * @return whether the order of any join was picked
+   */
+  bool OrderJoins(group_id_t root_group_id);
+
+ private:
+  /** Set of relations, one bit for every relation in leaves_ */
+  using RelationSet = uint64_t;
+
+  struct JoinPredicate {
+    AnnotatedExpression expr_;
+    /** Relations that the predicate refers to */
+    RelationSet relations_;
+    double selectivity_;
+  };
+
+  struct JoinPlan {
+    double rows_;
+    double cost_;
+    /** Sides of the join, which are both empty for a single relation */
+    RelationSet left_;
+    RelationSet right_;
+  };
+
+  void CollectJoinTree(group_id_t group_id);
+  void DeriveStats(group_id_t group_id);
+  void ReorderJoin(group_id_t group_id);
+
+  RelationSet Relations(const AnnotatedExpression &predicate) const;
+  double Selectivity(const AnnotatedExpression &predicate, RelationSet relations) const;
+  double Rows(RelationSet relations) const;
+  bool Connected(RelationSet left, RelationSet right) const;
+  JoinPlan MakePlan(const JoinPlan &left, RelationSet left_relations, const JoinPlan &right,
+                    RelationSet right_relations) const;
+
+  void EnumerateDP();
+  void EnumerateGreedy();
+  std::unique_ptr<AbstractOptimizerNode> BuildTree(RelationSet relations, std::vector<bool> *applied) const;
+
+  OptimizerContext *const context_;
+
+  /** Groups that the join being ordered joins, and the cardinality of each of them */
+  std::vector<group_id_t> leaves_;
+  std::vector<double> leaf_rows_;
+  std::vector<JoinPredicate> predicates_;
+  /** Best plan of every set of relations that the chosen join tree is made of */
+  std::unordered_map<RelationSet, JoinPlan> plans_;
+};
+
+}  // namespace noisepage::optimizer
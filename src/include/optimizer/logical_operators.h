@@ -1277,11 +1277,14 @@ class LogicalCreateIndex : public OperatorNodeContents<LogicalCreateIndex> {
    * @param unique If the index to be created should be unique
    * @param index_name Name of the index
    * @param index_attrs Attributes of the index
+   * @param index_predicate Predicate of a partial index, nullptr if the index covers every tuple
    * @return
    */
   static Operator Make(catalog::namespace_oid_t namespace_oid, catalog::table_oid_t table_oid,
                        parser::IndexType index_type, bool unique, std::string index_name,
-                       std::vector<common::ManagedPointer<parser::AbstractExpression>> index_attrs);
+                       std::vector<common::ManagedPointer<parser::AbstractExpression>> index_attrs,
+                       common::ManagedPointer<parser::AbstractExpression> index_predicate =
+                           common::ManagedPointer<parser::AbstractExpression>(nullptr));
 
   /**
    * Copy
@@ -1322,6 +1325,11 @@ class LogicalCreateIndex : public OperatorNodeContents<LogicalCreateIndex> {
    */
   const std::vector<common::ManagedPointer<parser::AbstractExpression>> &GetIndexAttr() const { return index_attrs_; }
 
+  /**
+   * @return Predicate of a partial index, nullptr if there is none
+   */
+  const common::ManagedPointer<parser::AbstractExpression> &GetIndexPredicate() const { return index_predicate_; }
+
  private:
   /**
    * OID of the namespace
@@ -1352,6 +1360,11 @@ class LogicalCreateIndex : public OperatorNodeContents<LogicalCreateIndex> {
    * Index attributes
    */
   std::vector<common::ManagedPointer<parser::AbstractExpression>> index_attrs_;
+
+  /**
+   * Partial index predicate
+   */
+  common::ManagedPointer<parser::AbstractExpression> index_predicate_;
 };
 
 /**
@@ -4,6 +4,7 @@
 #include <unordered_set>
 #include <vector>
 
+#include "common/shared_latch.h"
 #include "optimizer/group.h"
 #include "optimizer/group_expression.h"
 #include "optimizer/operator_node.h"
@@ -41,6 +42,9 @@ struct GExprPtrEq {
 /**
  * Memo class provides for tracking Groups and GroupExpressions and provides the
  * mechanisms by which we can do duplicate group detection.
+ *
+ * The Memo is latched so that optimizer tasks on several threads can look up groups and insert expressions at once.
+ * The Groups themselves are not: the tasks of concurrently optimized groups never touch the same group.
  */
 class Memo {
  public:
@@ -97,9 +101,14 @@ class Memo {
    * @returns Group with specified ID
    */
   Group *GetGroupByID(group_id_t id) const {
-    auto idx = id.UnderlyingValue();
-    NOISEPAGE_ASSERT(idx >= 0 && static_cast<size_t>(idx) < groups_.size(), "group_id out of bounds");
-    return groups_[idx];
+    common::SharedLatch::ScopedSharedLatch guard(&latch_);
+    return GetGroupByIDUnlatched(id);
+  }
+
+  /** @return number of groups in the memo */
+  size_t NumGroups() const {
+    common::SharedLatch::ScopedSharedLatch guard(&latch_);
+    return groups_.size();
   }
 
   /**
@@ -109,15 +118,19 @@ class Memo {
    * @param group_id GroupID of Group to erase
    */
   void EraseExpression(group_id_t group_id) {
-    auto idx = group_id.UnderlyingValue();
-    NOISEPAGE_ASSERT(idx >= 0 && static_cast<size_t>(idx) < groups_.size(), "group_id out of bounds");
-
-    auto gexpr = groups_[idx]->GetLogicalExpression();
-    group_expressions_.erase(gexpr);
-    groups_[idx]->EraseLogicalExpression();
+    common::SharedLatch::ScopedExclusiveLatch guard(&latch_);
+    auto *group = GetGroupByIDUnlatched(group_id);
+    group_expressions_.erase(group->GetLogicalExpression());
+    group->EraseLogicalExpression();
   }
 
  private:
+  Group *GetGroupByIDUnlatched(group_id_t id) const {
+    auto idx = id.UnderlyingValue();
+    NOISEPAGE_ASSERT(idx >= 0 && static_cast<size_t>(idx) < groups_.size(), "group_id out of bounds");
+    return groups_[idx];
+  }
+
   /**
    * Creates a new group
    * @param gexpr GroupExpression to collect metadata from
@@ -135,6 +148,11 @@ class Memo {
    * Vector of groups tracked
    */
   std::vector<Group *> groups_;
+
+  /**
+   * Guards group_expressions_ and groups_
+   */
+  mutable common::SharedLatch latch_;
 };
 
 }  // namespace noisepage::optimizer
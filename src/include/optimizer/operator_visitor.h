@@ -20,6 +20,7 @@ class LeftHashJoin;
 class LeftSemiHashJoin;
 class RightHashJoin;
 class OuterHashJoin;
+class InnerMergeJoin;
 class Insert;
 class InsertSelect;
 class Delete;
@@ -192,6 +193,12 @@ class OperatorVisitor {
    */
   virtual void Visit(const LeftSemiHashJoin *left_semi_hash_join) {}
 
+  /**
+   * Visit a InnerMergeJoin operator
+   * @param inner_merge_join operator
+   */
+  virtual void Visit(const InnerMergeJoin *inner_merge_join) {}
+
   /**
    * Visit a Insert operator
    * @param insert operator
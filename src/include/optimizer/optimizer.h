@@ -40,15 +40,21 @@ class Optimizer : public AbstractOptimizer {
    */
   DISALLOW_COPY_AND_MOVE(Optimizer);
 
+  /** Smallest number of independent groups that are worth optimizing on several threads */
+  static constexpr size_t MIN_PARALLEL_GROUPS = 8;
+
   /**
    * Constructor for Optimizer with a cost_model
    * @param model Cost Model to use for the optimizer
    * @param task_execution_timeout time in ms to spend on a task
+   * @param num_threads number of threads that optimize independent groups at once, 1 to optimize serially
    */
-  explicit Optimizer(std::unique_ptr<AbstractCostModel> model, const uint64_t task_execution_timeout)
+  explicit Optimizer(std::unique_ptr<AbstractCostModel> model, const uint64_t task_execution_timeout,
+                     const uint32_t num_threads = 1)
       : cost_model_(std::move(model)),
         context_(std::make_unique<OptimizerContext>(common::ManagedPointer(cost_model_))),
-        task_execution_timeout_(task_execution_timeout) {}
+        task_execution_timeout_(task_execution_timeout),
+        num_threads_(num_threads) {}
 
   /**
    * Build the plan tree for query execution
@@ -70,6 +76,15 @@ class Optimizer : public AbstractOptimizer {
    */
   void Reset() override;
 
+  /**
+   * Optimize the next queries with the numbers of rows observed for some of their relations in place of the
+   * estimates, such as when a query is optimized again after its execution found an estimate to be far off.
+   * @param feedback the observed numbers of rows, which must outlive the optimization; nullptr for none
+   */
+  void SetCardinalityFeedback(common::ManagedPointer<const CardinalityFeedback> feedback) {
+    cardinality_feedback_ = feedback;
+  }
+
  private:
   /**
    * Invoke a single optimization pass through the entire query.
@@ -79,6 +94,42 @@ class Optimizer : public AbstractOptimizer {
    */
   void OptimizeLoop(group_id_t root_group_id, PropertySet *required_props);
 
+  /**
+   * Plans a point query without exploring the memo: a SELECT, UPDATE or DELETE of a single table whose predicates pin
+   * every column of a unique index to a value. Its only sensible plan is a lookup of that index, so the rules that
+   * implement the operators are applied directly, and the costing, stats derivation and enforcing of the Cascades
+   * search are skipped. Queries of any other shape, or that require a sort, are left untouched.
+   *
+   * @param root_group_id Group of the query, after the rewrite
+   * @param required_props Physical properties to enforce
+   * @param root_context OptimizationContext the rules are applied in
+   * @returns true if the query was planned
+   */
+  bool OptimizePointQuery(group_id_t root_group_id, PropertySet *required_props, OptimizationContext *root_context);
+
+  /**
+   * Optimizes the groups under a group whose subtrees share no group with each other on several threads, for no
+   * required properties, so that optimizing the whole query later finds them done. The groups are optimized in waves,
+   * children before their parents.
+   *
+   * @param root_group_id Group of the query
+   * @returns time in ms that the optimization took
+   */
+  uint64_t OptimizeIndependentGroups(group_id_t root_group_id);
+
+  /**
+   * Collects the children of every operator with several children under a group, by how many such operators are
+   * above them
+   *
+   * @param group_id Group to start at
+   * @param depth number of operators with several children above the group
+   * @param waves groups by depth
+   * @param visited groups seen so far
+   * @returns false if some group is in several subtrees, whose groups are then not independent
+   */
+  bool CollectIndependentGroups(group_id_t group_id, size_t depth, std::vector<std::vector<group_id_t>> *waves,
+                                std::vector<bool> *visited);
+
   /**
    * Retrieve the lowest cost execution plan with the given properties
    *
@@ -103,12 +154,16 @@ class Optimizer : public AbstractOptimizer {
    * @param task_stack Optimizer's Task Stack to execute through
    * @param root_group_id Root Group ID to check whether there is a plan or not
    * @param root_context OptimizerContext to use that maintains required properties
+   * @param elapsed_time time in ms already spent on optimizing the query
    */
-  void ExecuteTaskStack(OptimizerTaskStack *task_stack, group_id_t root_group_id, OptimizationContext *root_context);
+  void ExecuteTaskStack(OptimizerTaskStack *task_stack, group_id_t root_group_id, OptimizationContext *root_context,
+                        uint64_t elapsed_time);
 
   std::unique_ptr<AbstractCostModel> cost_model_;
   std::unique_ptr<OptimizerContext> context_;
   const uint64_t task_execution_timeout_;
+  const uint32_t num_threads_;
+  common::ManagedPointer<const CardinalityFeedback> cardinality_feedback_{nullptr};
 };
 
 }  // namespace optimizer
@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "common/settings.h"
+#include "common/spin_latch.h"
 #include "optimizer/cost_model/abstract_cost_model.h"
 #include "optimizer/group_expression.h"
 #include "optimizer/memo.h"
@@ -22,6 +23,7 @@ class CatalogAccessor;
 
 namespace optimizer {
 
+class CardinalityFeedback;
 class OptimizerTaskPool;
 class RuleSet;
 
@@ -85,7 +87,10 @@ class OptimizerContext {
    * Adds a OptimizationContext to the tracking list
    * @param ctx OptimizationContext to add to tracking
    */
-  void AddOptimizationContext(OptimizationContext *ctx) { track_list_.push_back(ctx); }
+  void AddOptimizationContext(OptimizationContext *ctx) {
+    common::SpinLatch::ScopedSpinLatch guard(&track_list_latch_);
+    track_list_.push_back(ctx);
+  }
 
   /**
    * Pushes a task to the task pool managed
@@ -99,6 +104,17 @@ class OptimizerContext {
    */
   AbstractCostModel *GetCostModel() { return cost_model_.Get(); }
 
+  /**
+   * Costs a GroupExpression with the cost model. The cost model keeps state while it visits an expression, so tasks
+   * on different threads take turns.
+   * @param gexpr GroupExpression to cost
+   * @returns cost of the expression
+   */
+  double CalculateCost(GroupExpression *gexpr) {
+    common::SpinLatch::ScopedSpinLatch guard(&cost_model_latch_);
+    return cost_model_->CalculateCost(txn_, accessor_, &memo_, gexpr);
+  }
+
   /**
    * Gets the transaction
    * @returns transaction
@@ -201,6 +217,30 @@ class OptimizerContext {
     NOISEPAGE_ASSERT(ret, "Root expr should always be inserted");
   }
 
+  /**
+   * @return whether the inner joins of the query were already ordered by the JoinOrderEnumerator
+   */
+  bool JoinsOrdered() const { return joins_ordered_; }
+
+  /**
+   * Records that the inner joins of the query were ordered by the JoinOrderEnumerator, so that the rules do not
+   * explore other join orders again
+   */
+  void SetJoinsOrdered() { joins_ordered_ = true; }
+
+  /**
+   * @return the numbers of rows observed for relations of the query, which replace their estimates; nullptr if none
+   */
+  common::ManagedPointer<const CardinalityFeedback> GetCardinalityFeedback() const { return cardinality_feedback_; }
+
+  /**
+   * Set the numbers of rows observed for relations of the query, which replace their estimates
+   * @param feedback the observed numbers of rows, nullptr for none
+   */
+  void SetCardinalityFeedback(common::ManagedPointer<const CardinalityFeedback> feedback) {
+    cardinality_feedback_ = feedback;
+  }
+
   /**
    * Registers expr to be deleted on txn_ commit/abort
    * @param expr Expression to register
@@ -219,7 +259,11 @@ class OptimizerContext {
   StatsStorage *stats_storage_{};
   transaction::TransactionContext *txn_{};
   std::vector<OptimizationContext *> track_list_;
+  common::SpinLatch track_list_latch_;
+  common::SpinLatch cost_model_latch_;
   common::ManagedPointer<std::vector<parser::ConstantValueExpression>> params_;
+  bool joins_ordered_ = false;
+  common::ManagedPointer<const CardinalityFeedback> cardinality_feedback_{nullptr};
 };
 
 }  // namespace optimizer
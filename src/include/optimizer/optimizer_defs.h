@@ -101,6 +101,7 @@ enum class OpType {
   RIGHTHASHJOIN,
   OUTERHASHJOIN,
   LEFTSEMIHASHJOIN,
+  INNERMERGEJOIN,
   INSERT,
   INSERTSELECT,
   DELETE,
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <exception>
 #include <memory>
 #include <stack>
+#include <vector>
 
+#include "common/spin_latch.h"
+#include "common/worker_pool.h"
 #include "optimizer/optimizer_task.h"
 
 namespace noisepage::optimizer {
@@ -84,4 +89,60 @@ class OptimizerTaskStack : public OptimizerTaskPool {
   std::stack<OptimizerTask *> task_stack_;
 };
 
+/**
+ * Multi-threaded implementation of the OptimizerTaskPool, which runs independent jobs at once.
+ *
+ * A job is a task pushed from outside of any job, together with every task that it pushes in turn. The tasks of a job
+ * depend on running in stack order, so every job runs to completion on one worker thread with its own
+ * OptimizerTaskStack, and Push, Pop and Empty act on the stack of the job that the calling thread runs. The jobs must
+ * not touch the same groups.
+ */
+class ConcurrentOptimizerTaskPool : public OptimizerTaskPool {
+ public:
+  /**
+   * Constructor, which starts the worker threads
+   * @param num_threads number of jobs that run at once
+   */
+  explicit ConcurrentOptimizerTaskPool(uint32_t num_threads);
+
+  /**
+   * Destructor, which stops the worker threads and deletes the jobs that never ran
+   */
+  ~ConcurrentOptimizerTaskPool() override;
+
+  /**
+   * Implementation of the Pop interface of OptimizerTaskPool
+   * @returns Next OptimizerTask of the calling thread's job, or a job that has not run yet outside of any job
+   */
+  OptimizerTask *Pop() override;
+
+  /**
+   * Implementation of the Push interface of OptimizerTaskPool
+   * @param task OptimizerTask to add to the calling thread's job, or to start a new job with outside of any job
+   */
+  void Push(OptimizerTask *task) override;
+
+  /**
+   * @returns TRUE if the calling thread's job, or the jobs that have not run yet outside of any job, are empty
+   */
+  bool Empty() override;
+
+  /**
+   * Runs every job pushed since the last call on the worker threads, and waits for all of them to finish
+   * @throws the first exception that a task threw, after the other jobs stopped
+   */
+  void ExecuteJobs();
+
+ private:
+  void ExecuteJob(OptimizerTask *job);
+
+  common::WorkerPool workers_;
+  /** Jobs that have not run yet */
+  std::vector<OptimizerTask *> jobs_;
+  /** Set when a task throws, which stops the other jobs early */
+  std::atomic<bool> failed_{false};
+  common::SpinLatch exception_latch_;
+  std::exception_ptr exception_;
+};
+
 }  // namespace noisepage::optimizer
@@ -44,6 +44,7 @@ namespace optimizer {
 
 class PropertySet;
 class OperatorNode;
+class StatsStorage;
 
 /**
  * Plan Generator for generating plans from Operators
@@ -52,8 +53,11 @@ class PlanGenerator : public OperatorVisitor {
  public:
   /**
    * Constructor
+   * @param plan_meta_data Plan meta data to add the meta data of generated plan nodes to
+   * @param stats_storage Column statistics to annotate plan nodes with, or nullptr if there are none
    */
-  explicit PlanGenerator(common::ManagedPointer<planner::PlanMetaData> plan_meta_data);
+  explicit PlanGenerator(common::ManagedPointer<planner::PlanMetaData> plan_meta_data,
+                         common::ManagedPointer<StatsStorage> stats_storage = nullptr);
 
   /**
    * Converts an operator node into a plan node.
@@ -178,6 +182,12 @@ class PlanGenerator : public OperatorVisitor {
    */
   void Visit(const LeftSemiHashJoin *op) override;
 
+  /**
+   * Visitor function for a InnerMergeJoin operator
+   * @param op InnerMergeJoin operator being visited
+   */
+  void Visit(const InnerMergeJoin *op) override;
+
   /**
    * Visitor function for a Insert operator
    * @param op Insert operator being visited
@@ -374,6 +384,16 @@ class PlanGenerator : public OperatorVisitor {
                           const std::vector<common::ManagedPointer<parser::AbstractExpression>> *groupby_cols,
                           common::ManagedPointer<parser::AbstractExpression> having_predicate);
 
+  /**
+   * Looks up the range of an integer GroupBy column in the column statistics
+   * @param groupby_col The GroupBy expression
+   * @param[out] min_key Smallest value of the column
+   * @param[out] max_key Largest value of the column
+   * @return true if the expression is an integer column whose statistics have a range
+   */
+  bool GetGroupByKeyRange(common::ManagedPointer<parser::AbstractExpression> groupby_col, int64_t *min_key,
+                          int64_t *max_key) const;
+
   /**
    * @returns the next plan node id and increase the counter
    */
@@ -432,6 +452,11 @@ class PlanGenerator : public OperatorVisitor {
    */
   common::ManagedPointer<planner::PlanMetaData> plan_meta_data_;
 
+  /**
+   * Column statistics, may be nullptr
+   */
+  common::ManagedPointer<StatsStorage> stats_storage_;
+
   /**
    * Plan node meta data
    */
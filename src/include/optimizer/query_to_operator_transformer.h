@@ -88,6 +88,27 @@ class QueryToOperatorTransformer : public binder::SqlNodeVisitor {
   void CollectPredicates(common::ManagedPointer<parser::AbstractExpression> expr,
                          std::vector<AnnotatedExpression> *predicates);
 
+  /**
+   * Simplify an expression before its predicates are extracted, so that the execution engine does not evaluate the
+   * same constants for every tuple. Arithmetic and comparisons on constants are folded with the functions the execution
+   * engine runs, so that the results are exactly the same, and are left alone if they would overflow or divide by
+   * zero. Casts of constants the binder already converted are dropped, conjunctions with constant TRUE or FALSE are
+   * shortened, identities like x * 1 are removed, and comparisons of a constant with a column are turned around so
+   * that the column comes first. New expressions are owned by the parse result.
+   *
+   * @param expr The expression to simplify, in place where possible
+   * @return The simplified expression, which is expr unless its root had to be replaced
+   */
+  common::ManagedPointer<parser::AbstractExpression> SimplifyExpression(
+      common::ManagedPointer<parser::AbstractExpression> expr);
+
+  /**
+   * Simplify the children of an expression, and the expression itself if that does not replace it.
+   * @param expr The expression to simplify
+   * @return The expression that replaces expr, nullptr if expr stays
+   */
+  static std::unique_ptr<parser::AbstractExpression> Simplify(common::ManagedPointer<parser::AbstractExpression> expr);
+
   /**
    * Transform a sub-query in an expression to use
    * @param expr The potential sub-query expression
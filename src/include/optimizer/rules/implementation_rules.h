@@ -459,6 +459,46 @@ class LogicalInnerJoinToPhysicalInnerHashJoin : public Rule {
                  OptimizationContext *context) const override;
 };
 
+/**
+ * Rule transforms Logical Inner Join to InnerMergeJoin. The rule only applies when both children
+ * are table scans that an index can produce in the order of their join keys.
+ */
+class LogicalInnerJoinToPhysicalInnerMergeJoin : public Rule {
+ public:
+  /**
+   * Constructor
+   */
+  LogicalInnerJoinToPhysicalInnerMergeJoin();
+
+  /**
+   * Checks whether the given rule can be applied
+   * @param plan AbstractOptimizerNode to check
+   * @param context Current OptimizationContext executing under
+   * @returns Whether the input AbstractOptimizerNode passes the check
+   */
+  bool Check(common::ManagedPointer<AbstractOptimizerNode> plan, OptimizationContext *context) const override;
+
+  /**
+   * Transforms the input expression using the given rule
+   * @param input Input AbstractOptimizerNode to transform
+   * @param transformed Vector of transformed AbstractOptimizerNodes
+   * @param context Current OptimizationContext executing under
+   */
+  void Transform(common::ManagedPointer<AbstractOptimizerNode> input,
+                 std::vector<std::unique_ptr<AbstractOptimizerNode>> *transformed,
+                 OptimizationContext *context) const override;
+
+ private:
+  /**
+   * @param context Current OptimizationContext executing under
+   * @param group_id Group whose rows are to be ordered
+   * @param keys Keys to order the rows on
+   * @returns The number of leading keys an index scan of the group can produce its rows sorted on
+   */
+  static size_t NumIndexOrderedKeys(OptimizationContext *context, group_id_t group_id,
+                                    const std::vector<common::ManagedPointer<parser::AbstractExpression>> &keys);
+};
+
 /**
  * Rule transforms Logical Left Join to LeftHashJoin
  */
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <mutex>               // NOLINT
+#include <thread>              // NOLINT
+#include <unordered_map>
+
+#include "catalog/catalog_defs.h"
+#include "common/managed_pointer.h"
+#include "optimizer/statistics/stats_storage.h"
+
+namespace noisepage::catalog {
+class Catalog;
+}  // namespace noisepage::catalog
+
+namespace noisepage::settings {
+class SettingsManager;
+}  // namespace noisepage::settings
+
+namespace noisepage::transaction {
+class TransactionManager;
+}  // namespace noisepage::transaction
+
+namespace noisepage::optimizer {
+
+/**
+ * Class for spinning off a thread that keeps the statistics of the user tables fresh without an explicit ANALYZE. At a
+ * fixed interval it checks how many tuples committed transactions modified in every table since it last analyzed the
+ * table, and runs ANALYZE on the tables where that exceeds threshold + scale_factor * (rows seen by the last
+ * ANALYZE), like autovacuum does in PostgreSQL. The modifications are counted by the GarbageCollector, so the GC has to
+ * be running for any table to be picked up.
+ */
+class AutoAnalyzeThread {
+ public:
+  /**
+   * @param catalog catalog to find the tables in
+   * @param txn_manager transaction manager to run ANALYZE with
+   * @param stats_storage statistics cache to invalidate after an ANALYZE
+   * @param settings_manager settings for the execution of ANALYZE, may be DISABLED
+   * @param interval sleep time between checks of the tables
+   * @param threshold number of modified tuples that triggers an ANALYZE regardless of the table size
+   * @param scale_factor fraction of the rows of a table that has to be modified, on top of threshold, to trigger one
+   * @param optimizer_timeout timeout (in ms) of the optimizer when planning ANALYZE
+   */
+  AutoAnalyzeThread(common::ManagedPointer<catalog::Catalog> catalog,
+                    common::ManagedPointer<transaction::TransactionManager> txn_manager,
+                    common::ManagedPointer<StatsStorage> stats_storage,
+                    common::ManagedPointer<settings::SettingsManager> settings_manager,
+                    std::chrono::microseconds interval, uint64_t threshold, double scale_factor,
+                    uint64_t optimizer_timeout);
+
+  ~AutoAnalyzeThread() { StopAutoAnalyze(); }
+
+  /**
+   * Wake up and join the thread. An ANALYZE that is running is finished first.
+   */
+  void StopAutoAnalyze();
+
+  /**
+   * Check every user table once, and ANALYZE the ones that were modified enough since they were last analyzed
+   * @return number of tables analyzed
+   */
+  uint32_t AnalyzeModifiedTables();
+
+ private:
+  /**
+   * Run ANALYZE on all of the columns of a table in a transaction of its own
+   * @return true if the ANALYZE committed
+   */
+  bool AnalyzeTable(catalog::db_oid_t db_oid, catalog::table_oid_t table_oid);
+
+  void AutoAnalyzeThreadLoop();
+
+  const common::ManagedPointer<catalog::Catalog> catalog_;
+  const common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  const common::ManagedPointer<StatsStorage> stats_storage_;
+  const common::ManagedPointer<settings::SettingsManager> settings_manager_;
+  const std::chrono::microseconds interval_;
+  const uint64_t threshold_;
+  const double scale_factor_;
+  const uint64_t optimizer_timeout_;
+
+  // Number of modifications of every table when it was last analyzed. Only touched by AnalyzeModifiedTables, which is
+  // only called from one thread at a time.
+  std::unordered_map<TableStatsKey, uint64_t> analyzed_modifications_;
+
+  std::mutex run_mutex_;
+  std::condition_variable run_cvar_;
+  bool run_;
+  std::thread auto_analyze_thread_;
+};
+
+}  // namespace noisepage::optimizer
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace noisepage::optimizer {
+
+/**
+ * CardinalityFeedback holds the number of rows that a query was observed to produce for some of its relations, so
+ * that it can be optimized again with them in place of the estimates. A relation is either a table scan or a join of
+ * tables, and is known by the aliases of the tables in it, which identify the same relation in every plan of a query.
+ */
+class CardinalityFeedback {
+ public:
+  /**
+   * Record the number of rows of a relation.
+   * @param table_aliases The aliases of the tables in the relation.
+   * @param num_rows The number of rows the relation was observed to have.
+   */
+  void Add(const std::unordered_set<std::string> &table_aliases, uint64_t num_rows) {
+    num_rows_[GetKey(table_aliases)] = num_rows;
+  }
+
+  /**
+   * @param table_aliases The aliases of the tables in a relation.
+   * @return The number of rows the relation was observed to have, if it was.
+   */
+  std::optional<uint64_t> Lookup(const std::unordered_set<std::string> &table_aliases) const {
+    if (num_rows_.empty()) return std::nullopt;
+    const auto iter = num_rows_.find(GetKey(table_aliases));
+    if (iter == num_rows_.end()) return std::nullopt;
+    return iter->second;
+  }
+
+  /** @return True if no relation was observed. */
+  bool Empty() const { return num_rows_.empty(); }
+
+ private:
+  // The aliases are unordered, so they are sorted into the key.
+  static std::string GetKey(const std::unordered_set<std::string> &table_aliases) {
+    std::vector<std::string> aliases(table_aliases.begin(), table_aliases.end());
+    std::sort(aliases.begin(), aliases.end());
+    std::string key;
+    for (const auto &alias : aliases) {
+      key += alias;
+      key += '\0';
+    }
+    return key;
+  }
+
+  std::unordered_map<std::string, uint64_t> num_rows_;
+};
+
+}  // namespace noisepage::optimizer
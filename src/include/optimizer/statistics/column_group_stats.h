@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/json.h"
+#include "common/macros.h"
+
+namespace noisepage::optimizer {
+
+/**
+ * Statistics of a group of columns of a table that are used together, e.g. as the key of a multi-column index. The
+ * statistics of the single columns assume that the columns are independent, which underestimates conjunctions over
+ * correlated columns like (city, zip code) by orders of magnitude. A group records how many distinct combinations of
+ * values its columns take, and for each column the degree to which the other columns of the group determine it, like
+ * the functional dependencies of CREATE STATISTICS in PostgreSQL.
+ */
+class ColumnGroupStats {
+ public:
+  /**
+   * Constructor
+   * @param col_oids columns of the group
+   * @param num_distinct number of distinct combinations of the values of the columns
+   * @param dependency_degrees for each column, the fraction of the rows in which the values of the other columns
+   *                           determine its value, between 0 (independent) and 1 (functionally dependent)
+   */
+  ColumnGroupStats(std::vector<catalog::col_oid_t> col_oids, size_t num_distinct,
+                   std::vector<double> dependency_degrees)
+      : col_oids_(std::move(col_oids)),
+        num_distinct_(num_distinct),
+        dependency_degrees_(std::move(dependency_degrees)) {
+    NOISEPAGE_ASSERT(col_oids_.size() == dependency_degrees_.size(), "Every column should have a dependency degree");
+  }
+
+  /**
+   * Default constructor for deserialization
+   */
+  ColumnGroupStats() = default;
+
+  /**
+   * @return columns of the group
+   */
+  const std::vector<catalog::col_oid_t> &GetColumnOids() const { return col_oids_; }
+
+  /**
+   * @return number of distinct combinations of the values of the columns
+   */
+  size_t GetDistinctValues() const { return num_distinct_; }
+
+  /**
+   * @param idx index of a column in the group
+   * @return degree to which the other columns of the group determine the column
+   */
+  double GetDependencyDegree(size_t idx) const { return dependency_degrees_.at(idx); }
+
+  /**
+   * Estimate the selectivity of equality predicates on all of the columns of the group together. The column that
+   * depends the most on the others is only filtered by its own predicate in the rows where it is not determined by the
+   * others, so sel = sel(others) * (degree + (1 - degree) * sel(column)) as in PostgreSQL.
+   * @param selectivities selectivity of the predicate on each column of the group, in the order of the group
+   * @return selectivity of the conjunction of the predicates
+   */
+  double EstimateEqualitySelectivity(const std::vector<double> &selectivities) const {
+    NOISEPAGE_ASSERT(selectivities.size() == col_oids_.size(), "Every column should have a selectivity");
+    size_t dependent = 0;
+    for (size_t i = 1; i < dependency_degrees_.size(); i++) {
+      if (dependency_degrees_[i] > dependency_degrees_[dependent]) dependent = i;
+    }
+    double selectivity = 1.0;
+    for (size_t i = 0; i < selectivities.size(); i++) {
+      if (i != dependent) selectivity *= selectivities[i];
+    }
+    const double degree = dependency_degrees_[dependent];
+    return selectivity * (degree + (1.0 - degree) * selectivities[dependent]);
+  }
+
+  /**
+   * Convert ColumnGroupStats to json
+   * @return json representation of the ColumnGroupStats
+   */
+  nlohmann::json ToJson() const {
+    nlohmann::json j;
+    j["col_oids"] = col_oids_;
+    j["num_distinct"] = num_distinct_;
+    j["dependency_degrees"] = dependency_degrees_;
+    return j;
+  }
+
+  /**
+   * Convert json to ColumnGroupStats
+   * @param j json representation of a ColumnGroupStats
+   * @return ColumnGroupStats object parsed from json
+   */
+  static ColumnGroupStats FromJson(const nlohmann::json &j) {
+    return ColumnGroupStats(j.at("col_oids").get<std::vector<catalog::col_oid_t>>(),
+                            j.at("num_distinct").get<size_t>(), j.at("dependency_degrees").get<std::vector<double>>());
+  }
+
+  /**
+   * Serialize the statistics of several groups into a byte array
+   * @param groups statistics of the groups
+   * @param[out] size length of byte array
+   * @return byte array representation of the groups
+   */
+  static std::unique_ptr<byte[]> Serialize(const std::vector<ColumnGroupStats> &groups, size_t *size) {
+    nlohmann::json j = nlohmann::json::array();
+    for (const auto &group : groups) j.push_back(group.ToJson());
+    const std::string json_str = j.dump();
+    *size = json_str.size();
+    auto buffer = std::make_unique<byte[]>(*size);
+    std::memcpy(buffer.get(), json_str.c_str(), *size);
+    return buffer;
+  }
+
+  /**
+   * Deserialize the statistics of several groups from a byte array
+   * @param buffer byte array representation of the groups
+   * @param size length of byte array
+   * @return statistics of the groups
+   */
+  static std::vector<ColumnGroupStats> Deserialize(const byte *buffer, size_t size) {
+    std::string json_str(reinterpret_cast<const char *>(buffer), size);
+    std::vector<ColumnGroupStats> groups;
+    for (const auto &j : nlohmann::json::parse(json_str)) groups.emplace_back(FromJson(j));
+    return groups;
+  }
+
+ private:
+  std::vector<catalog::col_oid_t> col_oids_;
+  size_t num_distinct_ = 0;
+  std::vector<double> dependency_degrees_;
+};
+
+}  // namespace noisepage::optimizer
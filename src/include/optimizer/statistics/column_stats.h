@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -8,6 +10,7 @@
 #include "common/json_header.h"
 #include "common/macros.h"
 #include "execution/sql/value.h"
+#include "optimizer/statistics/column_group_stats.h"
 #include "optimizer/statistics/histogram.h"
 #include "optimizer/statistics/top_k_elements.h"
 
@@ -62,6 +65,21 @@ class ColumnStatsBase {
    * @return type id of the column
    */
   virtual type::TypeId GetTypeId() = 0;
+  /**
+   * Gets the statistics of the groups of columns that start with the column
+   * @return statistics of the column groups
+   */
+  virtual const std::vector<ColumnGroupStats> &GetColumnGroupStats() const = 0;
+  /**
+   * Sets the statistics of the groups of columns that start with the column
+   * @param column_group_stats statistics of the column groups
+   */
+  virtual void SetColumnGroupStats(std::vector<ColumnGroupStats> column_group_stats) = 0;
+  /**
+   * Gets the most common values of the column, which are compared across columns of the same type by their hashes
+   * @return the hash of each value in the top-k list and the fraction of the rows of the column that hold it
+   */
+  virtual std::vector<std::pair<hash_t, double>> GetMostCommonValues() = 0;
   /**
    * Returns whether or not this stat is stale
    * @return true if stale false otherwise
@@ -131,6 +149,7 @@ class ColumnStats : public ColumnStatsBase {
         non_null_rows_(other.non_null_rows_),
         frac_null_(other.frac_null_),
         distinct_values_(other.distinct_values_),
+        column_group_stats_(other.column_group_stats_),
         type_id_(other.type_id_),
         stale_(other.stale_) {
     top_k_ = std::make_unique<TopKElements<CppType>>(*other.top_k_);
@@ -163,6 +182,7 @@ class ColumnStats : public ColumnStatsBase {
     distinct_values_ = other.distinct_values_;
     top_k_ = std::make_unique<TopKElements<CppType>>(*other.top_k_);
     histogram_ = std::make_unique<Histogram<CppType>>(*other.histogram_);
+    column_group_stats_ = other.column_group_stats_;
     type_id_ = other.type_id_;
     stale_ = other.stale_;
     return *this;
@@ -235,6 +255,37 @@ class ColumnStats : public ColumnStatsBase {
    */
   type::TypeId GetTypeId() override { return type_id_; }
 
+  /**
+   * Gets the statistics of the groups of columns that start with the column
+   * @return statistics of the column groups
+   */
+  const std::vector<ColumnGroupStats> &GetColumnGroupStats() const override { return column_group_stats_; }
+
+  /**
+   * Sets the statistics of the groups of columns that start with the column
+   * @param column_group_stats statistics of the column groups
+   */
+  void SetColumnGroupStats(std::vector<ColumnGroupStats> column_group_stats) override {
+    column_group_stats_ = std::move(column_group_stats);
+  }
+
+  /**
+   * Gets the most common values of the column, which are compared across columns of the same type by their hashes
+   * @return the hash of each value in the top-k list and the fraction of the rows of the column that hold it
+   */
+  std::vector<std::pair<hash_t, double>> GetMostCommonValues() override {
+    std::vector<std::pair<hash_t, double>> most_common_values;
+    const auto total = static_cast<double>(top_k_->GetTotalCount());
+    if (total <= 0) return most_common_values;
+    // ANALYZE may have built the top-k over a sample of the table, so its counts are taken relative to the sample
+    const double non_null_frac = 1.0 - frac_null_;
+    for (const auto &key : top_k_->GetSortedTopKeys()) {
+      const auto frequency = static_cast<double>(top_k_->EstimateItemCount(key)) / total * non_null_frac;
+      most_common_values.emplace_back(std::hash<CppType>{}(key), std::min(frequency, non_null_frac));
+    }
+    return most_common_values;
+  }
+
   /**
    * Returns whether or not this stat is stale
    * @return true if stale false otherwise
@@ -292,6 +343,11 @@ class ColumnStats : public ColumnStatsBase {
    */
   std::unique_ptr<Histogram<CppType>> histogram_;
 
+  /**
+   * Statistics of the groups of columns that start with this column.
+   */
+  std::vector<ColumnGroupStats> column_group_stats_;
+
   /**
    * Type Id of underlying column.
    */
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "common/hash_util.h"
+
+namespace noisepage::optimizer {
+
+/**
+ * Statistics of a column in the output of a Group, derived by the StatsCalculator from the statistics of the base
+ * table and the operators below the Group. They are what join estimation needs of the column: the number of distinct
+ * values, the fraction of nulls and the most common values. The statistics of a column group are kept in the same way,
+ * with only the number of distinct combinations of values.
+ */
+class DerivedColumnStats {
+ public:
+  /**
+   * Constructor
+   * @param num_distinct number of distinct values of the column
+   * @param frac_null fraction of the rows where the column is null
+   * @param most_common_values hash of each most common value and the fraction of the rows that hold it
+   */
+  DerivedColumnStats(double num_distinct, double frac_null, std::vector<std::pair<hash_t, double>> most_common_values)
+      : num_distinct_(num_distinct), frac_null_(frac_null), most_common_values_(std::move(most_common_values)) {}
+
+  /**
+   * @return number of distinct values of the column
+   */
+  double GetDistinctValues() const { return num_distinct_; }
+
+  /**
+   * @return fraction of the rows where the column is null
+   */
+  double GetFracNull() const { return frac_null_; }
+
+  /**
+   * @return hash of each most common value and the fraction of the rows that hold it
+   */
+  const std::vector<std::pair<hash_t, double>> &GetMostCommonValues() const { return most_common_values_; }
+
+  /**
+   * The statistics of the column in an output of num_rows rows. The column cannot have more distinct values than
+   * the output has rows, and the values are otherwise assumed to be spread over the rows like before.
+   * @param num_rows number of rows of the output
+   * @return statistics of the column in the output
+   */
+  DerivedColumnStats Limit(double num_rows) const {
+    return DerivedColumnStats(std::min(num_distinct_, std::max(num_rows, 1.0)), frac_null_, most_common_values_);
+  }
+
+ private:
+  double num_distinct_;
+  double frac_null_;
+  std::vector<std::pair<hash_t, double>> most_common_values_;
+};
+
+}  // namespace noisepage::optimizer
@@ -5,6 +5,7 @@
 
 #include "common/managed_pointer.h"
 #include "optimizer/statistics/column_stats.h"
+#include "optimizer/statistics/derived_column_stats.h"
 #include "optimizer/statistics/table_stats.h"
 #include "optimizer/statistics/value_condition.h"
 #include "parser/expression/constant_value_expression.h"
@@ -40,6 +41,27 @@ class SelectivityUtil {
    */
   static double ComputeSelectivity(const TableStats &table_stats, const ValueCondition &condition);
 
+  /**
+   * Compute selectivity of an equality between the columns of the two sides of a join, as eqjoinsel in PostgreSQL.
+   * The most common values of the two columns are matched against each other, and the rest of the values of either
+   * column are assumed to find a match among the distinct values of the other column that are not common ones.
+   * @param left_stats statistics of the column of the left side
+   * @param right_stats statistics of the column of the right side
+   * @return fraction of the cross product of the two sides that satisfies the equality
+   */
+  static double ComputeJoinSelectivity(const DerivedColumnStats &left_stats, const DerivedColumnStats &right_stats);
+
+  /**
+   * Compute selectivity of an equality between the columns of the two sides of a semi join, as eqjoinsel_semi in
+   * PostgreSQL. The rows of the left side that hold a common value of the right side are known to have a match, and
+   * the other rows are assumed to have one when the right column has at least as many distinct values.
+   * @param left_stats statistics of the column of the left side
+   * @param right_stats statistics of the column of the right side
+   * @return fraction of the rows of the left side that have a match on the right side
+   */
+  static double ComputeSemiJoinSelectivity(const DerivedColumnStats &left_stats,
+                                           const DerivedColumnStats &right_stats);
+
   /**
    * Compute selectivity of a condition
    * @param column_stats Column Statistics
@@ -62,6 +62,19 @@ class StatsCalculator : public OperatorVisitor {
    */
   void Visit(const LogicalLimit *op) override;
 
+  /**
+   * Estimate the selectivity of the join predicates between the outputs of two groups from the statistics of their
+   * columns. The equalities between the columns of the two sides are estimated from the distinct and most common
+   * values of the columns, and a key over several columns from the statistics of its column group if there is one.
+   * The other predicates are not estimated.
+   * @param left_group group of the left side, with its stats derived
+   * @param right_group group of the right side, with its stats derived
+   * @param predicates join predicates
+   * @returns fraction of the cross product of the two sides that satisfies the predicates
+   */
+  static double EstimateJoinSelectivity(Group *left_group, Group *right_group,
+                                        const std::vector<AnnotatedExpression> &predicates);
+
  private:
   /**
    * Return estimated cardinality for a filter
@@ -82,6 +95,24 @@ class StatsCalculator : public OperatorVisitor {
   double CalculateSelectivityForPredicate(const TableStats &predicate_table_stats,
                                           common::ManagedPointer<parser::AbstractExpression> expr);
 
+  /**
+   * Calculates the selectivity of the conjunction of equality predicates on single columns. The predicates on the
+   * columns of a group with statistics of its own are estimated together, the others as if they were independent.
+   * @param predicate_table_stats Table Statistics
+   * @param equality_selectivities selectivity of the equality predicate on each column, consumed by the estimate
+   * @returns selectivity estimate
+   */
+  double CalculateSelectivityForEqualities(const TableStats &predicate_table_stats,
+                                           std::unordered_map<catalog::col_oid_t, double> *equality_selectivities);
+
+  /**
+   * Derive the statistics of the columns in the output of a LogicalGet from the statistics of the table
+   * @param op LogicalGet whose group the statistics are derived for
+   * @param table_stats statistics of the table
+   * @param num_rows estimated number of rows of the output
+   */
+  void DeriveColumnStats(const LogicalGet *op, const TableStats &table_stats, double num_rows);
+
   /**
    * GroupExpression
    */
@@ -11,7 +11,7 @@
 #include "common/hash_util.h"
 #include "common/macros.h"
 #include "common/managed_pointer.h"
-#include "common/shared_latch.h"
+#include "common/big_reader_latch.h"
 #include "optimizer/statistics/table_stats.h"
 
 namespace noisepage::optimizer {
@@ -38,7 +38,7 @@ struct TableStatsValue {
   /** Table Statistics */
   TableStats table_stats_;
   /** Shared Latch for Table Statistics */
-  common::SharedLatch shared_latch_;
+  common::BigReaderLatch shared_latch_;
 };
 
 /** Thread safe value to return back to consumers of cache */
@@ -49,17 +49,18 @@ struct LatchedTableStatsReference {
    * @param table_stats_shared_latch acquired read latch on the table stats
    * @param stats_storage_shared_latch acquired read latch on stats storage
    */
-  explicit LatchedTableStatsReference(const TableStats &table_stats, common::SharedLatchGuard table_stats_shared_latch,
-                                      common::SharedLatchGuard stats_storage_shared_latch)
+  explicit LatchedTableStatsReference(const TableStats &table_stats,
+                                      common::BigReaderLatchGuard table_stats_shared_latch,
+                                      common::BigReaderLatchGuard stats_storage_shared_latch)
       : table_stats_(table_stats),
         table_stats_shared_latch_(std::move(table_stats_shared_latch)),
         stats_storage_shared_latch_(std::move(stats_storage_shared_latch)) {}
   /** Table Statistics */
   const TableStats &table_stats_;
   /** Acquired Shared Latch on Table Stats */
-  common::SharedLatchGuard table_stats_shared_latch_;
+  common::BigReaderLatchGuard table_stats_shared_latch_;
   /** Acquired Shared Latch on Stats Storage */
-  common::SharedLatchGuard stats_storage_shared_latch_;
+  common::BigReaderLatchGuard stats_storage_shared_latch_;
 };
 }  // namespace noisepage::optimizer
 
@@ -146,7 +147,7 @@ class StatsStorage {
   /**
    * latch for reading and modifying table_stats_storage_.
    */
-  common::SharedLatch stats_storage_latch_;
+  common::BigReaderLatch stats_storage_latch_;
 
   /**
    * Checks with StatsStorage contains stats for a certain table
@@ -238,6 +238,11 @@ class TopKElements {
    */
   size_t GetSize() const { return entries_.size(); }
 
+  /**
+   * @return the sum of the counts of all keys added, including the ones not in the top-k list
+   */
+  size_t GetTotalCount() const { return sketch_.GetTotalCount(); }
+
   /**
    * Generate a vector of the top-k keys sorted by their current counts
    * @return the vector of the top-k keys
@@ -58,6 +58,19 @@ class OptimizerUtil {
                                   const std::unordered_set<std::string> &left_alias,
                                   const std::unordered_set<std::string> &right_alias);
 
+  /**
+   * Infers the predicates implied by equalities between the columns of two tables. Given (a.x = b.y) and a
+   * comparison of a.x with a constant or a parameter, like (a.x < 5), the same comparison holds for b.y on every tuple
+   * the equality keeps, so (b.y < 5) is added as well. Once pushed down, it filters the tuples of b before they reach
+   * the join. Inferred predicates are themselves used to infer more, and predicates that are already present are not
+   * added.
+   *
+   * @param predicates conjunctive predicates, to which the inferred predicates are appended
+   * @param inferred_exprs output vector owning the expressions of the inferred predicates
+   */
+  static void InferTransitivePredicates(std::vector<AnnotatedExpression> *predicates,
+                                        std::vector<std::unique_ptr<parser::AbstractExpression>> *inferred_exprs);
+
   /**
    * Generate all tuple value expressions of a base table
    *
@@ -387,7 +387,7 @@ class CreateStatement : public TableRefStatement {
   /**
    * Create statement type.
    */
-  enum CreateType { kTable, kDatabase, kIndex, kTrigger, kSchema, kView };
+  enum CreateType { kTable, kDatabase, kIndex, kTrigger, kSchema, kView, kMaterializedView };
 
   /**
    * CREATE TABLE and CREATE DATABASE
@@ -411,15 +411,19 @@ class CreateStatement : public TableRefStatement {
    * @param unique true if index should be unique, false otherwise
    * @param index_name index name
    * @param index_attrs index attributes
+   * @param index_predicate WHERE clause of a partial index, nullptr if the index covers every tuple
    */
   CreateStatement(std::unique_ptr<TableInfo> table_info, IndexType index_type, bool unique, std::string index_name,
-                  std::vector<IndexAttr> index_attrs)
+                  std::vector<IndexAttr> index_attrs,
+                  common::ManagedPointer<AbstractExpression> index_predicate =
+                      common::ManagedPointer<AbstractExpression>(nullptr))
       : TableRefStatement(StatementType::CREATE, std::move(table_info)),
         create_type_(kIndex),
         index_type_(index_type),
         unique_index_(unique),
         index_name_(std::move(index_name)),
-        index_attrs_(std::move(index_attrs)) {}
+        index_attrs_(std::move(index_attrs)),
+        index_predicate_(index_predicate) {}
 
   /**
    * CREATE SCHEMA
@@ -465,6 +469,21 @@ class CreateStatement : public TableRefStatement {
         view_name_(std::move(view_name)),
         view_query_(std::move(view_query)) {}
 
+  /**
+   * CREATE MATERIALIZED VIEW
+   * @param table_info table information of the view
+   * @param view_query query associated with view
+   * @param view_columns names of the columns of the view, empty if they are named after the output of the query
+   * @param with_data true if the view is populated as it is created, false if it starts out empty (WITH NO DATA)
+   */
+  CreateStatement(std::unique_ptr<TableInfo> table_info, std::unique_ptr<SelectStatement> view_query,
+                  std::vector<std::string> view_columns, bool with_data)
+      : TableRefStatement(StatementType::CREATE, std::move(table_info)),
+        create_type_(kMaterializedView),
+        view_query_(std::move(view_query)),
+        view_columns_(std::move(view_columns)),
+        with_data_(with_data) {}
+
   ~CreateStatement() override = default;
 
   void Accept(common::ManagedPointer<binder::SqlNodeVisitor> v) override { v->Visit(common::ManagedPointer(this)); }
@@ -504,6 +523,9 @@ class CreateStatement : public TableRefStatement {
   /** @return index attributes for [CREATE INDEX] */
   const std::vector<IndexAttr> &GetIndexAttributes() const { return index_attrs_; }
 
+  /** @return partial index predicate for [CREATE INDEX], nullptr if there is none */
+  common::ManagedPointer<AbstractExpression> GetIndexPredicate() const { return index_predicate_; }
+
   /** @return true if "IF NOT EXISTS" for [CREATE SCHEMA], false otherwise */
   bool IsIfNotExists() { return if_not_exists_; }
 
@@ -528,9 +550,15 @@ class CreateStatement : public TableRefStatement {
   /** @return view name for [CREATE VIEW] */
   std::string GetViewName() { return view_name_; }
 
-  /** @return view query for [CREATE VIEW] */
+  /** @return view query for [CREATE VIEW, CREATE MATERIALIZED VIEW] */
   common::ManagedPointer<SelectStatement> GetViewQuery() { return common::ManagedPointer(view_query_); }
 
+  /** @return names of the columns for [CREATE MATERIALIZED VIEW], empty if named after the output of the query */
+  const std::vector<std::string> &GetViewColumns() const { return view_columns_; }
+
+  /** @return true if the view is populated as it is created for [CREATE MATERIALIZED VIEW] */
+  bool IsWithData() const { return with_data_; }
+
  private:
   // ALL
   const CreateType create_type_;
@@ -544,6 +572,8 @@ class CreateStatement : public TableRefStatement {
   const bool unique_index_ = false;
   const std::string index_name_;
   const std::vector<IndexAttr> index_attrs_;
+  const common::ManagedPointer<AbstractExpression> index_predicate_ =
+      common::ManagedPointer<AbstractExpression>(nullptr);
 
   // CREATE SCHEMA
   const bool if_not_exists_ = false;
@@ -556,9 +586,13 @@ class CreateStatement : public TableRefStatement {
   const common::ManagedPointer<AbstractExpression> trigger_when_ = common::ManagedPointer<AbstractExpression>(nullptr);
   const int16_t trigger_type_ = 0;
 
-  // CREATE VIEW
+  // CREATE VIEW, CREATE MATERIALIZED VIEW
   const std::string view_name_;
   const std::unique_ptr<SelectStatement> view_query_;
+
+  // CREATE MATERIALIZED VIEW
+  const std::vector<std::string> view_columns_;
+  const bool with_data_ = false;
 };
 
 }  // namespace parser
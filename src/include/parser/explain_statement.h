@@ -12,9 +12,12 @@ namespace noisepage::parser {
  */
 class ExplainStatement : public SQLStatement {
  public:
-  /** @param real_sql_stmt the SQL statement to be explained */
-  explicit ExplainStatement(std::unique_ptr<SQLStatement> real_sql_stmt)
-      : SQLStatement(StatementType::EXPLAIN), real_sql_stmt_(std::move(real_sql_stmt)) {}
+  /**
+   * @param real_sql_stmt the SQL statement to be explained
+   * @param analyze true if the statement is run to annotate its plan with what it did, i.e., EXPLAIN ANALYZE
+   */
+  explicit ExplainStatement(std::unique_ptr<SQLStatement> real_sql_stmt, bool analyze = false)
+      : SQLStatement(StatementType::EXPLAIN), real_sql_stmt_(std::move(real_sql_stmt)), analyze_(analyze) {}
 
   ~ExplainStatement() override = default;
 
@@ -23,8 +26,12 @@ class ExplainStatement : public SQLStatement {
   /** @return the SQL statement to be explained */
   common::ManagedPointer<SQLStatement> GetSQLStatement() { return common::ManagedPointer(real_sql_stmt_); }
 
+  /** @return true if the statement is run to annotate its plan with what it did */
+  bool IsAnalyze() const { return analyze_; }
+
  private:
   std::unique_ptr<SQLStatement> real_sql_stmt_;
+  bool analyze_;
 };
 
 }  // namespace noisepage::parser
@@ -740,6 +740,22 @@ using ViewStmt = struct ViewStmt {
   ViewCheckOption with_check_option_; /* WITH CHECK OPTION */
 };
 
+using CreateTableAsStmt = struct CreateTableAsStmt {
+  NodeTag type_;
+  Node *query_;          /* the query (see comments above) */
+  IntoClause *into_;     /* destination table */
+  ObjectType relkind_;   /* OBJECT_TABLE or OBJECT_MATVIEW */
+  bool is_select_into_;  /* it was written as SELECT INTO */
+  bool if_not_exists_;   /* just do nothing if it already exists? */
+};
+
+using RefreshMatViewStmt = struct RefreshMatViewStmt {
+  NodeTag type_;
+  bool concurrent_;     /* allow concurrent access? */
+  bool skip_data_;      /* true for WITH NO DATA */
+  RangeVar *relation_;  /* relation to insert into */
+};
+
 using ParamRef = struct ParamRef {
   NodeTag type_;
   int number_;   /* the number of the parameter */
@@ -27,6 +27,7 @@ enum class StatementType {
   CREATE_FUNC = 17,
   EXPLAIN = 18,
   VARIABLE_SHOW = 19,
+  REFRESH = 20,
 };
 
 enum class FKConstrMatchType { SIMPLE = 0, PARTIAL = 1, FULL = 2 };
@@ -62,11 +63,12 @@ enum class IndexType {
   BWTREE = 1,
   HASH = 2,
   BPLUSTREE = 3,
+  ART = 4,
 };
 
 enum class InsertType { INVALID = INVALID_TYPE_ID, VALUES = 1, SELECT = 2 };
 
-enum class ExternalFileFormat { CSV, BINARY };
+enum class ExternalFileFormat { CSV, BINARY, TEXT };
 
 // CREATE FUNCTION helpers
 
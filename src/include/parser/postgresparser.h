@@ -138,6 +138,8 @@ class PostgresParser {
   static std::unique_ptr<SQLStatement> CreateSchemaTransform(ParseResult *parse_result, CreateSchemaStmt *root);
   static std::unique_ptr<SQLStatement> CreateTriggerTransform(ParseResult *parse_result, CreateTrigStmt *root);
   static std::unique_ptr<SQLStatement> CreateViewTransform(ParseResult *parse_result, ViewStmt *root);
+  static std::unique_ptr<SQLStatement> CreateMaterializedViewTransform(ParseResult *parse_result,
+                                                                       CreateTableAsStmt *root);
 
   // CREATE helpers
   using ColumnDefTransResult = struct {
@@ -185,6 +187,9 @@ class PostgresParser {
   // PREPARE statements
   static std::unique_ptr<PrepareStatement> PrepareTransform(ParseResult *parse_result, PrepareStmt *root);
 
+  // REFRESH statements
+  static std::unique_ptr<RefreshStatement> RefreshTransform(ParseResult *parse_result, RefreshMatViewStmt *root);
+
   static std::unique_ptr<DeleteStatement> TruncateTransform(ParseResult *parse_result, TruncateStmt *truncate_stmt);
 
   /**
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include "binder/sql_node_visitor.h"
+#include "common/managed_pointer.h"
+#include "parser/sql_statement.h"
+#include "parser/table_ref.h"
+
+namespace noisepage {
+namespace parser {
+/**
+ * RefreshStatement represents the sql "REFRESH MATERIALIZED VIEW ...".
+ */
+class RefreshStatement : public SQLStatement {
+ public:
+  /**
+   * Creates a new RefreshStatement.
+   * @param view materialized view to be refreshed
+   * @param with_data true if the view is recomputed, false if it is only emptied (WITH NO DATA)
+   */
+  RefreshStatement(std::unique_ptr<TableRef> view, bool with_data)
+      : SQLStatement(StatementType::REFRESH), view_(std::move(view)), with_data_(with_data) {}
+
+  ~RefreshStatement() override = default;
+
+  void Accept(common::ManagedPointer<binder::SqlNodeVisitor> v) override { v->Visit(common::ManagedPointer(this)); }
+
+  /** @return materialized view to be refreshed */
+  common::ManagedPointer<TableRef> GetView() { return common::ManagedPointer(view_); }
+
+  /** @return true if the view is recomputed, false if it is only emptied */
+  bool IsWithData() const { return with_data_; }
+
+ private:
+  const std::unique_ptr<TableRef> view_;
+  const bool with_data_;
+};
+
+}  // namespace parser
+}  // namespace noisepage
@@ -11,6 +11,7 @@
 #include "parser/explain_statement.h"
 #include "parser/insert_statement.h"
 #include "parser/prepare_statement.h"
+#include "parser/refresh_statement.h"
 #include "parser/select_statement.h"
 #include "parser/sql_statement.h"
 #include "parser/transaction_statement.h"
@@ -1,13 +1,16 @@
 #pragma once
 
+#include <optional>
+
 #include "binder/sql_node_visitor.h"
 #include "parser/sql_statement.h"
+#include "transaction/transaction_defs.h"
 
 namespace noisepage::parser {
 
 /**
  * @class TransactionStatement
- * @brief Represents "BEGIN or COMMIT or ROLLBACK [TRANSACTION]"
+ * @brief Represents "BEGIN [ISOLATION LEVEL level] [READ ONLY | READ WRITE] or COMMIT or ROLLBACK [TRANSACTION]"
  */
 class TransactionStatement : public SQLStatement {
  public:
@@ -22,8 +25,15 @@ class TransactionStatement : public SQLStatement {
 
   /**
    * @param type transaction command
+   * @param read_only whether a BEGIN starts a READ ONLY transaction
+   * @param isolation_level isolation level a BEGIN asks for, if any
    */
-  explicit TransactionStatement(CommandType type) : SQLStatement(StatementType::TRANSACTION), type_(type) {}
+  explicit TransactionStatement(CommandType type, bool read_only = false,
+                                std::optional<transaction::IsolationLevel> isolation_level = std::nullopt)
+      : SQLStatement(StatementType::TRANSACTION),
+        type_(type),
+        read_only_(read_only),
+        isolation_level_(isolation_level) {}
 
   void Accept(common::ManagedPointer<binder::SqlNodeVisitor> v) override { v->Visit(common::ManagedPointer(this)); }
 
@@ -32,8 +42,20 @@ class TransactionStatement : public SQLStatement {
    */
   CommandType GetTransactionType() { return type_; }
 
+  /**
+   * @return whether this is a BEGIN READ ONLY
+   */
+  bool IsReadOnly() const { return read_only_; }
+
+  /**
+   * @return the isolation level of a BEGIN ISOLATION LEVEL, or std::nullopt for the default isolation level
+   */
+  std::optional<transaction::IsolationLevel> GetIsolationLevel() const { return isolation_level_; }
+
  private:
   const CommandType type_;
+  const bool read_only_;
+  const std::optional<transaction::IsolationLevel> isolation_level_;
 };
 
 }  // namespace noisepage::parser
@@ -112,6 +112,7 @@ class AbstractJoinPlanNode : public AbstractPlanNode {
     switch (join_type_) {
       case LogicalJoinType::RIGHT_SEMI:
       case LogicalJoinType::RIGHT_ANTI:
+      case LogicalJoinType::RIGHT_MARK:
         return true;
       default:
         return false;
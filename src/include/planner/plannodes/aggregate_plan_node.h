@@ -75,6 +75,18 @@ class AggregatePlanNode : public AbstractPlanNode {
       return *this;
     }
 
+    /**
+     * @param min_key smallest value the single integer group by term is expected to take
+     * @param max_key largest value the single integer group by term is expected to take
+     * @return builder object
+     */
+    Builder &SetGroupByKeyRange(int64_t min_key, int64_t max_key) {
+      has_group_by_key_range_ = true;
+      group_by_key_min_ = min_key;
+      group_by_key_max_ = max_key;
+      return *this;
+    }
+
     /**
      * Build the aggregate plan node
      * @return plan node
@@ -98,6 +110,15 @@ class AggregatePlanNode : public AbstractPlanNode {
      * Strategy to use for aggregation
      */
     AggregateStrategyType aggregate_strategy_;
+    /**
+     * Whether the range of the group by key is known
+     */
+    bool has_group_by_key_range_{false};
+    /**
+     * Expected range of the group by key
+     */
+    int64_t group_by_key_min_{0};
+    int64_t group_by_key_max_{0};
   };
 
  private:
@@ -108,12 +129,16 @@ class AggregatePlanNode : public AbstractPlanNode {
    * @param having_clause_predicate unique pointer to possible having clause predicate
    * @param aggregate_terms vector of aggregate terms for the aggregation
    * @param aggregate_strategy aggregation strategy to be used
+   * @param has_group_by_key_range whether the range of the group by key is known
+   * @param group_by_key_min smallest expected value of the group by key
+   * @param group_by_key_max largest expected value of the group by key
    * @param plan_node_id Plan node id
    */
   AggregatePlanNode(std::vector<std::unique_ptr<AbstractPlanNode>> &&children,
                     std::unique_ptr<OutputSchema> output_schema, std::vector<GroupByTerm> groupby_terms,
                     common::ManagedPointer<parser::AbstractExpression> having_clause_predicate,
                     std::vector<AggregateTerm> aggregate_terms, AggregateStrategyType aggregate_strategy,
+                    bool has_group_by_key_range, int64_t group_by_key_min, int64_t group_by_key_max,
                     plan_node_id_t plan_node_id);
 
  public:
@@ -150,6 +175,23 @@ class AggregatePlanNode : public AbstractPlanNode {
    */
   AggregateStrategyType GetAggregateStrategyType() const { return aggregate_strategy_; }
 
+  /**
+   * The range of the group by key is known from column statistics when the aggregation groups by a single integer
+   * column. It is only an expectation, since the statistics may be stale.
+   * @return true if the range of the group by key is known
+   */
+  bool HasGroupByKeyRange() const { return has_group_by_key_range_; }
+
+  /**
+   * @return smallest expected value of the group by key
+   */
+  int64_t GetGroupByKeyMin() const { return group_by_key_min_; }
+
+  /**
+   * @return largest expected value of the group by key
+   */
+  int64_t GetGroupByKeyMax() const { return group_by_key_max_; }
+
   /**
    * @return the type of this plan node
    */
@@ -185,6 +227,9 @@ class AggregatePlanNode : public AbstractPlanNode {
   common::ManagedPointer<parser::AbstractExpression> having_clause_predicate_;
   std::vector<AggregateTerm> aggregate_terms_;
   AggregateStrategyType aggregate_strategy_;
+  bool has_group_by_key_range_{false};
+  int64_t group_by_key_min_{0};
+  int64_t group_by_key_max_{0};
 };
 DEFINE_JSON_HEADER_DECLARATIONS(AggregatePlanNode);
 }  // namespace noisepage::planner
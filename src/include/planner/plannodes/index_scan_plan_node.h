@@ -119,6 +119,24 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
       return *this;
     }
 
+    /**
+     * @param index_only whether the index key holds every column the scan reads, so the table is not read
+     * @return builder object
+     */
+    Builder &SetIndexOnly(bool index_only) {
+      index_only_ = index_only;
+      return *this;
+    }
+
+    /**
+     * @param ordered whether the plan relies on the scan producing its tuples in key order
+     * @return builder object
+     */
+    Builder &SetOrdered(bool ordered) {
+      ordered_ = ordered;
+      return *this;
+    }
+
     /**
      * Build the Index scan plan node
      * @return plan node
@@ -135,6 +153,8 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
     std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> hi_index_cols_{};
     uint64_t index_size_{0};
     bool cover_all_columns_{false};
+    bool index_only_{false};
+    bool ordered_{false};
   };
 
  private:
@@ -152,6 +172,8 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
    * @param hi_index_cols upper bound of the scan
    * @param index_size number of tuples in index
    * @param cover_all_columns whether the index covers all predicate columns
+   * @param index_only whether the scan reads its columns from the index key instead of the table
+   * @param ordered whether the plan relies on the scan producing its tuples in key order
    * @param plan_node_id Plan node id
    */
   IndexScanPlanNode(std::vector<std::unique_ptr<AbstractPlanNode>> &&children,
@@ -162,7 +184,8 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
                     std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> &&lo_index_cols,
                     std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> &&hi_index_cols,
                     uint32_t scan_limit, bool scan_has_limit, uint32_t scan_offset, bool scan_has_offset,
-                    uint64_t index_size, uint64_t table_num_tuple, bool cover_all_columns, plan_node_id_t plan_node_id);
+                    uint64_t index_size, uint64_t table_num_tuple, bool cover_all_columns, bool index_only,
+                    bool ordered, plan_node_id_t plan_node_id);
 
  public:
   /**
@@ -233,6 +256,17 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
    */
   bool GetCoverAllColumns() const { return cover_all_columns_; }
 
+  /**
+   * @return whether every column the scan reads is bound by the exact key, so that the scan never reads the table
+   */
+  bool IsIndexOnly() const { return index_only_; }
+
+  /**
+   * @return whether the plan relies on the scan producing its tuples in key order, which rules out scanning the range
+   * in parallel
+   */
+  bool IsOrdered() const { return ordered_; }
+
   /**
    * @return the hashed value of this plan node
    */
@@ -254,6 +288,8 @@ class IndexScanPlanNode : public AbstractScanPlanNode {
   uint64_t table_num_tuple_;
   uint64_t index_size_;
   bool cover_all_columns_;
+  bool index_only_;
+  bool ordered_;
 };
 
 DEFINE_JSON_HEADER_DECLARATIONS(IndexScanPlanNode);
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 
 #include "planner/plannodes/plan_node_defs.h"
 
@@ -24,13 +27,27 @@ class PlanMetaData {
      */
     explicit PlanNodeMetaData(int cardinality) : cardinality_(cardinality) {}
 
+    /**
+     * Construct a PlanNodeMetaData with a cardinality value for a relation of the query
+     * @param cardinality output cardinality of the plan node
+     * @param table_aliases aliases of the tables whose scan or join the plan node produces
+     */
+    PlanNodeMetaData(int cardinality, std::unordered_set<std::string> table_aliases)
+        : cardinality_(cardinality), table_aliases_(std::move(table_aliases)) {}
+
     /**
      * @return the output cardinality
      */
-    int GetCardinality() { return cardinality_; }
+    int GetCardinality() const { return cardinality_; }
+
+    /**
+     * @return aliases of the tables whose scan or join the plan node produces, empty if it produces something else
+     */
+    const std::unordered_set<std::string> &GetTableAliases() const { return table_aliases_; }
 
    private:
     int cardinality_ = -1;
+    std::unordered_set<std::string> table_aliases_;
   };
 
   /**
@@ -43,6 +60,12 @@ class PlanMetaData {
     plan_node_meta_data_[plan_node_id] = meta_data;
   }
 
+  /**
+   * @param plan_node_id plan node id
+   * @return whether there is meta data for the plan node
+   */
+  bool HasPlanNodeMetaData(plan_node_id_t plan_node_id) const { return plan_node_meta_data_.count(plan_node_id) != 0; }
+
   /**
    * Get the meta data for a plan node
    * @param plan_node_id plan node id
@@ -43,6 +43,7 @@ enum class PlanNodeType {
   // Join Nodes
   NESTLOOP,
   HASHJOIN,
+  MERGEJOIN,
   INDEXNLJOIN,
 
   // Mutator Nodes
@@ -74,6 +75,7 @@ enum class PlanNodeType {
   DISTINCT,
   HASH,
   SETOP,
+  WINDOW,
 
   // Utility
   EXPORT_EXTERNAL_FILE,
@@ -93,6 +95,17 @@ enum class AggregateStrategyType {
   PLAIN = 3  // no group-by
 };
 
+//===--------------------------------------------------------------------===//
+// Window Function Types
+//===--------------------------------------------------------------------===//
+enum class WindowFunctionType {
+  INVALID = INVALID_TYPE_ID,
+  ROW_NUMBER = 1,  // position of the row in its partition
+  RANK = 2,        // position of the row's first peer in its partition
+  DENSE_RANK = 3,  // number of distinct peer groups up to the row's in its partition
+  AGGREGATE = 4    // aggregate over the partition up to the row's last peer
+};
+
 //===--------------------------------------------------------------------===//
 // Logical Join Types
 //===--------------------------------------------------------------------===//
@@ -106,7 +119,8 @@ enum class LogicalJoinType {
   ANTI = 6,                   // returns a row ONLY if it has NO join partner, no duplicates
   LEFT_SEMI = 7,              // Left semi join
   RIGHT_SEMI = 8,             // Right semi join
-  RIGHT_ANTI = 9              // Right anti join
+  RIGHT_ANTI = 9,             // Right anti join
+  RIGHT_MARK = 10             // Right mark join, returns every right row with whether it has a join partner
 };
 
 /**
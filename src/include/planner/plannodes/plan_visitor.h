@@ -25,6 +25,7 @@ class IndexJoinPlanNode;
 class IndexScanPlanNode;
 class InsertPlanNode;
 class LimitPlanNode;
+class MergeJoinPlanNode;
 class NestedLoopJoinPlanNode;
 class OrderByPlanNode;
 class ProjectionPlanNode;
@@ -32,6 +33,7 @@ class SeqScanPlanNode;
 class UpdatePlanNode;
 class SetOpPlanNode;
 class ResultPlanNode;
+class WindowPlanNode;
 
 /**
  * Utility class for visitor pattern for plan nodes
@@ -178,6 +180,12 @@ class PlanVisitor {
    */
   virtual void Visit(UNUSED_ATTRIBUTE const LimitPlanNode *plan) {}
 
+  /**
+   * Visit an MergeJoinPlanNode
+   * @param plan MergeJoinPlanNode
+   */
+  virtual void Visit(UNUSED_ATTRIBUTE const MergeJoinPlanNode *plan) {}
+
   /**
    * Visit an NestedLoopJoinPlanNode
    * @param plan NestedLoopJoinPlanNode
@@ -219,6 +227,12 @@ class PlanVisitor {
    * @param plan ResultPlanNode
    */
   virtual void Visit(UNUSED_ATTRIBUTE const ResultPlanNode *plan) {}
+
+  /**
+   * Visit an WindowPlanNode
+   * @param plan WindowPlanNode
+   */
+  virtual void Visit(UNUSED_ATTRIBUTE const WindowPlanNode *plan) {}
 };
 
 }  // namespace noisepage::planner
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "parser/expression/abstract_expression.h"
+#include "parser/expression/aggregate_expression.h"
+#include "planner/plannodes/abstract_plan_node.h"
+#include "planner/plannodes/order_by_plan_node.h"
+#include "planner/plannodes/plan_visitor.h"
+
+namespace noisepage::planner {
+
+using PartitionByTerm = common::ManagedPointer<parser::AbstractExpression>;
+using WindowFunction = std::pair<WindowFunctionType, common::ManagedPointer<parser::AggregateExpression>>;
+
+/**
+ * Plan node for window functions. All window functions of the node share one window: the input is
+ * partitioned on the partition-by terms and ordered within each partition on the sort keys. Rows
+ * that are equal on all sort keys are peers. Aggregates use the default frame, which spans from
+ * the start of the partition to the row's last peer.
+ *
+ * The output columns refer to the child's columns through DerivedValueExpressions with tuple index
+ * 0, and to the window functions through DerivedValueExpressions with tuple index 1.
+ */
+class WindowPlanNode : public AbstractPlanNode {
+ public:
+  /**
+   * Builder for window plan node
+   */
+  class Builder : public AbstractPlanNode::Builder<Builder> {
+   public:
+    Builder() = default;
+
+    /**
+     * Don't allow builder to be copied or moved
+     */
+    DISALLOW_COPY_AND_MOVE(Builder);
+
+    /**
+     * @param term expression to partition the input on
+     * @return builder object
+     */
+    Builder &AddPartitionByTerm(PartitionByTerm term) {
+      partition_by_terms_.emplace_back(term);
+      return *this;
+    }
+
+    /**
+     * @param key expression to order the rows of a partition on
+     * @param ordering ordering (ASC or DESC) for key
+     * @return builder object
+     */
+    Builder &AddSortKey(common::ManagedPointer<parser::AbstractExpression> key,
+                        optimizer::OrderByOrderingType ordering) {
+      sort_keys_.emplace_back(key, ordering);
+      return *this;
+    }
+
+    /**
+     * @param type type of the window function
+     * @param aggregate the aggregate the function computes if it is an aggregate, nullptr otherwise
+     * @return builder object
+     */
+    Builder &AddWindowFunction(WindowFunctionType type,
+                               common::ManagedPointer<parser::AggregateExpression> aggregate = nullptr) {
+      window_functions_.emplace_back(type, aggregate);
+      return *this;
+    }
+
+    /**
+     * Build the window plan node
+     * @return plan node
+     */
+    std::unique_ptr<WindowPlanNode> Build();
+
+   protected:
+    /**
+     * Expressions the input is partitioned on
+     */
+    std::vector<PartitionByTerm> partition_by_terms_;
+    /**
+     * Expressions and orderings the rows of a partition are ordered on
+     */
+    std::vector<SortKey> sort_keys_;
+    /**
+     * Window functions computed for each row
+     */
+    std::vector<WindowFunction> window_functions_;
+  };
+
+ private:
+  /**
+   * @param children child plan nodes
+   * @param output_schema Schema representing the structure of the output of this plan node
+   * @param partition_by_terms expressions the input is partitioned on
+   * @param sort_keys expressions and orderings the rows of a partition are ordered on
+   * @param window_functions window functions computed for each row
+   * @param plan_node_id Plan node id
+   */
+  WindowPlanNode(std::vector<std::unique_ptr<AbstractPlanNode>> &&children,
+                 std::unique_ptr<OutputSchema> output_schema, std::vector<PartitionByTerm> partition_by_terms,
+                 std::vector<SortKey> sort_keys, std::vector<WindowFunction> window_functions,
+                 plan_node_id_t plan_node_id);
+
+ public:
+  /**
+   * Default constructor used for deserialization
+   */
+  WindowPlanNode() = default;
+
+  DISALLOW_COPY_AND_MOVE(WindowPlanNode)
+
+  /**
+   * @return expressions the input is partitioned on
+   */
+  const std::vector<PartitionByTerm> &GetPartitionByTerms() const { return partition_by_terms_; }
+
+  /**
+   * @return expressions and orderings the rows of a partition are ordered on
+   */
+  const std::vector<SortKey> &GetSortKeys() const { return sort_keys_; }
+
+  /**
+   * @return window functions computed for each row
+   */
+  const std::vector<WindowFunction> &GetWindowFunctions() const { return window_functions_; }
+
+  /**
+   * @return a list of indexes corresponding to the aggregate window functions that allocate memory
+   */
+  std::vector<size_t> GetMemoryAllocatingAggregatorIndexes() const;
+
+  /**
+   * @return the type of this plan node
+   */
+  PlanNodeType GetPlanNodeType() const override { return PlanNodeType::WINDOW; }
+
+  /**
+   * @return the hashed value of this plan node
+   */
+  common::hash_t Hash() const override;
+
+  bool operator==(const AbstractPlanNode &rhs) const override;
+
+  void Accept(common::ManagedPointer<PlanVisitor> v) const override { v->Visit(this); }
+
+  nlohmann::json ToJson() const override;
+  std::vector<std::unique_ptr<parser::AbstractExpression>> FromJson(const nlohmann::json &j) override;
+
+ private:
+  /* Expressions the input is partitioned on */
+  std::vector<PartitionByTerm> partition_by_terms_;
+
+  /* Expressions and orderings ([ASC] or [DESC]) the rows of a partition are ordered on */
+  std::vector<SortKey> sort_keys_;
+
+  /* Window functions computed for each row */
+  std::vector<WindowFunction> window_functions_;
+};
+
+DEFINE_JSON_HEADER_DECLARATIONS(WindowPlanNode);
+
+}  // namespace noisepage::planner
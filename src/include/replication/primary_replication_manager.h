@@ -1,9 +1,11 @@
 #pragma once
 
+#include <chrono>  // NOLINT
 #include <queue>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "replication/replication_manager.h"
@@ -24,11 +26,16 @@ class PrimaryReplicationManager final : public ReplicationManager {
    * @param port                        The port to listen on.
    * @param replication_hosts_path      The path to the replication.config file.
    * @param empty_buffer_queue          A queue of empty buffers that the replication manager may return buffers to.
+   * @param quorum_size                 The number of replicas that must receive a batch of records before the commit
+   *                                    callbacks of its transactions are invoked under ReplicationPolicy::QUORUM.
+   * @param checkpoint_root             The directory of the checkpoints that are shipped to replicas which ask for
+   *                                    them, empty if none are shipped. @see storage::CheckpointManager
    */
   PrimaryReplicationManager(
       common::ManagedPointer<messenger::Messenger> messenger, const std::string &network_identity, uint16_t port,
       const std::string &replication_hosts_path,
-      common::ManagedPointer<common::ConcurrentBlockingQueue<storage::BufferedLogWriter *>> empty_buffer_queue);
+      common::ManagedPointer<common::ConcurrentBlockingQueue<storage::BufferedLogWriter *>> empty_buffer_queue,
+      uint32_t quorum_size = 1, std::string checkpoint_root = "");
 
   /** Destructor. */
   ~PrimaryReplicationManager() final;
@@ -68,10 +75,28 @@ class PrimaryReplicationManager final : public ReplicationManager {
   /** Process every transaction callback where the associated transaction has been applied by all replicas. */
   void ProcessTxnCallbacks();
 
+  /** Process every quorum transaction callback whose batch of records has been received by a quorum of replicas. */
+  void ProcessQuorumCallbacks();
+
+  /** Record the latest known progress of the given replica in the replication metrics. Requires callbacks_mutex_. */
+  void RecordReplicaProgress(const std::string &replica);
+
   /** @return The next batch ID that should be assigned in ReplicateBatchOfRecords(). */
   record_batch_id_t GetNextBatchId();
 
   void Handle(const messenger::ZmqMessage &zmq_msg, const TxnAppliedMsg &msg);
+  void Handle(const messenger::ZmqMessage &zmq_msg, const BatchesReceivedMsg &msg);
+  void Handle(const messenger::ZmqMessage &zmq_msg, const CheckpointRequestMsg &msg);
+
+  /** Wait for every replica to have few enough unacknowledged messages before sending it another batch of records. */
+  void WaitForReplicasToKeepUp();
+
+  /** The largest piece of a checkpoint file that is sent in a single message. */
+  static constexpr uint64_t CHECKPOINT_CHUNK_SIZE = 1 << 20;
+  /** The number of unacknowledged messages to a replica at which sending further batches of records blocks. */
+  static constexpr uint32_t MAX_PENDING_MESSAGES_PER_REPLICA = 1024;
+  /** How long sending a batch of records blocks on a replica that is not keeping up before giving up on it. */
+  static constexpr std::chrono::milliseconds BACKPRESSURE_TIMEOUT = std::chrono::milliseconds(1000);
 
   /**
    * Queue of batches of commit callbacks. Each batch is tagged with whether there are corresponding commit records.
@@ -82,7 +107,24 @@ class PrimaryReplicationManager final : public ReplicationManager {
   std::queue<std::vector<storage::CommitCallback>> txn_callbacks_;
   /** Map from transaction start times (aka transaction ID) to list of replicas that have applied the transaction. */
   std::unordered_map<transaction::timestamp_t, std::unordered_set<std::string>> txns_applied_on_replicas_;
-  std::mutex callbacks_mutex_;  ///< Protecting txn_callbacks_ and txns_applied_on_replicas_.
+  /**
+   * Queue of batches of commit callbacks under ReplicationPolicy::QUORUM, each tagged with the ID of the batch of
+   * records that must be received by a quorum before the callbacks are invoked in order of addition.
+   */
+  std::queue<std::pair<record_batch_id_t, std::vector<storage::CommitCallback>>> quorum_callbacks_;
+  /** Map from replica to the ID of the last batch that the replica has received, along with all the ones before. */
+  std::unordered_map<std::string, record_batch_id_t> batches_received_on_replicas_;
+  /** Map from replica to the newest transaction that the replica has applied, as of the replica's notifications. */
+  std::unordered_map<std::string, transaction::timestamp_t> last_txn_applied_on_replicas_;
+  /** The number of replicas that form a quorum, capped by the number of replicas. */
+  const uint32_t quorum_size_;
+  /** The directory of the checkpoints that are shipped to replicas, empty if none are shipped. */
+  const std::string checkpoint_root_;
+  /**
+   * Protecting txn_callbacks_, txns_applied_on_replicas_, quorum_callbacks_, batches_received_on_replicas_ and
+   * last_txn_applied_on_replicas_.
+   */
+  std::mutex callbacks_mutex_;
 
   /** ID of the next batch of log records to be sent out to all replicas. */
   record_batch_id_t next_batch_id_{1};
@@ -90,6 +132,11 @@ class PrimaryReplicationManager final : public ReplicationManager {
   record_batch_id_t last_sent_batch_id_ = INVALID_RECORD_BATCH_ID;
   /** ID of the newest transaction that was sent out to all replicas. */
   transaction::timestamp_t newest_txn_sent_ = transaction::INITIAL_TXN_TIMESTAMP;
+  /**
+   * Replicas that timed out on back-pressure. Sending is not blocked on them again until they have caught up, so that
+   * an unreachable replica does not stall the primary on every batch. Only accessed from ReplicateBatchOfRecords().
+   */
+  std::unordered_set<std::string> lagging_replicas_;
 };
 
 }  // namespace noisepage::replication
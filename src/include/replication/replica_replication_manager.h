@@ -1,8 +1,14 @@
 #pragma once
 
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <mutex>               // NOLINT
+#include <optional>
+#include <set>
 #include <string>
 
 #include "replication/replication_manager.h"
+#include "storage/checkpoint/checkpoint_manager.h"
 #include "storage/recovery/replication_log_provider.h"
 #include "transaction/transaction_defs.h"
 
@@ -48,6 +54,26 @@ class ReplicaReplicationManager final : public ReplicationManager {
    */
   void NotifyPrimaryTransactionApplied(transaction::timestamp_t txn_start_time);
 
+  /**
+   * Ask the primary for its latest checkpoint, and wait until all of it has been shipped. A replica that calls this
+   * before its recovery starts can load the user tables from the checkpoint rather than replaying their changes up to
+   * the checkpoint's timestamp, @see storage::RecoveryManager::SetCheckpoint.
+   *
+   * @param checkpoint_root             The directory that the shipped checkpoint is written to.
+   * @return The shipped checkpoint, or std::nullopt if the primary has none.
+   */
+  std::optional<storage::CheckpointInfo> RequestCheckpoint(const std::string &checkpoint_root);
+
+  /**
+   * Send a batch of decoded row changes to a change data capture subscriber, @see storage::LogicalDecoder. Blocks while
+   * the subscriber has too many batches left to acknowledge, unless it already failed to keep up.
+   *
+   * @param subscriber                  The name of the subscriber in the replication.config file.
+   * @param last_txn_id                 The ID of the last transaction whose changes are in the batch.
+   * @param changes                     The changes, one per line.
+   */
+  void SendChangeBatch(const std::string &subscriber, transaction::timestamp_t last_txn_id, std::string changes);
+
  protected:
   /** The main event loop that all replicas run. This handles receiving messages. */
   void EventLoop(common::ManagedPointer<messenger::Messenger> messenger, const messenger::ZmqMessage &zmq_msg,
@@ -56,8 +82,38 @@ class ReplicaReplicationManager final : public ReplicationManager {
  private:
   void Handle(const messenger::ZmqMessage &zmq_msg, const NotifyOATMsg &msg);
   void Handle(const messenger::ZmqMessage &zmq_msg, const RecordsBatchMsg &msg);
+  void Handle(const messenger::ZmqMessage &zmq_msg, const CheckpointChunkMsg &msg);
+  void Handle(const messenger::ZmqMessage &zmq_msg, const CheckpointShippedMsg &msg);
+
+  /** The number of unacknowledged batches of changes to a subscriber at which sending further ones blocks. */
+  static constexpr uint32_t MAX_PENDING_CHANGE_BATCHES = 256;
+  /** How long sending a batch of changes blocks on a subscriber that is not keeping up before giving up on it. */
+  static constexpr std::chrono::milliseconds CHANGE_BATCH_BACKPRESSURE_TIMEOUT = std::chrono::milliseconds(1000);
+
+  /** Notify the primary of the last batch of records that was received along with all the ones before it. */
+  void NotifyPrimaryBatchesReceived();
 
   storage::ReplicationLogProvider provider_;  ///< The log records being provided to recovery.
+  /** ID of the last batch of log records that was received along with every batch before it. */
+  record_batch_id_t last_received_batch_id_ = INVALID_RECORD_BATCH_ID;
+  /** IDs of the batches of log records that were received ahead of some batch before them. */
+  std::set<record_batch_id_t> batches_received_early_;
+
+  /** The directory that a requested checkpoint is written to, empty if none was requested. */
+  std::string checkpoint_root_;
+  /** The number of pieces of the requested checkpoint that were written. */
+  uint64_t checkpoint_chunks_received_ = 0;
+  /** The description of the requested checkpoint, once the primary has sent all of it. */
+  std::optional<CheckpointShippedMsg> checkpoint_shipped_ = std::nullopt;
+  /** Protecting the requested checkpoint, and signalled whenever a piece of it arrives. */
+  std::mutex checkpoint_mutex_;
+  std::condition_variable checkpoint_cv_;
+
+  /**
+   * True if the subscriber timed out the last time it was waited on. It is then only checked, not waited on, until it
+   * catches up, so that an unreachable subscriber does not stall replay. Only accessed from SendChangeBatch().
+   */
+  bool subscriber_lagging_ = false;
 };
 
 }  // namespace noisepage::replication
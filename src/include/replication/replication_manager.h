@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>  // NOLINT
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -88,6 +89,15 @@ class ReplicationManager {
   void Send(const std::string &destination, msg_id_t msg_id, const std::string &message,
             const messenger::CallbackFn &source_callback, messenger::callback_id_t destination_callback);
 
+  /**
+   * Wait until fewer than @p max_pending messages sent to the given destination are waiting to be acknowledged.
+   * @param destination                 The destination that messages were sent to.
+   * @param max_pending                 The number of unacknowledged messages to wait for the destination to drop below.
+   * @param timeout                     The maximum amount of time to wait for.
+   * @return                            True if the destination is below max_pending, false on timeout.
+   */
+  bool WaitForPendingMessages(const std::string &destination, uint32_t max_pending, std::chrono::milliseconds timeout);
+
   /** The main event loop that all nodes run. This handles receiving messages. */
   virtual void EventLoop(common::ManagedPointer<messenger::Messenger> messenger, const messenger::ZmqMessage &zmq_msg,
                          common::ManagedPointer<BaseReplicationMessage> msg);
@@ -3,9 +3,12 @@
 #include <limits>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
+#include "catalog/catalog_defs.h"
 #include "common/enum_defs.h"
-#include "common/json_header.h"
 #include "messenger/messenger_defs.h"
 #include "replication/replication_defs.h"
 #include "transaction/transaction_defs.h"
@@ -16,15 +19,25 @@ class BufferedLogWriter;
 
 namespace noisepage::replication {
 
-#define REPLICATION_MESSAGE_TYPE_ENUM(T)                                                    \
-  /** Invalid message type (for uninitialized or invalid state only!). */                   \
-  T(ReplicationMessageType, INVALID)                                                        \
-  /** Primary notifying the replica of the oldest active txn time. */                       \
-  T(ReplicationMessageType, NOTIFY_OAT)                                                     \
-  /** Primary sending the replica a batch of log records.*/                                 \
-  T(ReplicationMessageType, RECORDS_BATCH)                                                  \
-  /** Replica notifying the primary that the replica has applied a specific transaction. */ \
-  T(ReplicationMessageType, TXN_APPLIED)
+#define REPLICATION_MESSAGE_TYPE_ENUM(T)                                                       \
+  /** Invalid message type (for uninitialized or invalid state only!). */                      \
+  T(ReplicationMessageType, INVALID)                                                           \
+  /** Primary notifying the replica of the oldest active txn time. */                          \
+  T(ReplicationMessageType, NOTIFY_OAT)                                                        \
+  /** Primary sending the replica a batch of log records.*/                                    \
+  T(ReplicationMessageType, RECORDS_BATCH)                                                     \
+  /** Replica notifying the primary that the replica has applied a specific transaction. */    \
+  T(ReplicationMessageType, TXN_APPLIED)                                                       \
+  /** Replica notifying the primary that the replica has received every batch up to one. */    \
+  T(ReplicationMessageType, BATCHES_RECEIVED)                                                  \
+  /** Replica asking the primary for its latest checkpoint. */                                 \
+  T(ReplicationMessageType, CHECKPOINT_REQUEST)                                                \
+  /** Primary sending the replica a piece of a checkpoint file. */                             \
+  T(ReplicationMessageType, CHECKPOINT_CHUNK)                                                  \
+  /** Primary notifying the replica that every piece of a checkpoint was sent. */              \
+  T(ReplicationMessageType, CHECKPOINT_SHIPPED)                                                \
+  /** Replica streaming a batch of decoded row changes to a change data capture subscriber. */ \
+  T(ReplicationMessageType, CHANGE_BATCH)
 
 /** The type of message that is being sent. */
 ENUM_DEFINE(ReplicationMessageType, uint8_t, REPLICATION_MESSAGE_TYPE_ENUM);
@@ -35,21 +48,26 @@ class ReplicationMessageMetadata {
  public:
   /** Constructor (to send). */
   explicit ReplicationMessageMetadata(msg_id_t msg_id);
-  /** Constructor (to receive). */
-  explicit ReplicationMessageMetadata(const common::json &json);
+  /** Constructor (to receive), consuming the metadata from the front of @p in. */
+  explicit ReplicationMessageMetadata(std::string_view *in);
 
-  /** @return     The JSON form of this metadata. */
-  common::json ToJson() const;
+  /** Append the binary form of this metadata to @p out. */
+  void Serialize(std::string *out) const;
 
   /** @return     The ID of the message. */
   msg_id_t GetMessageId() const { return msg_id_; }
 
  private:
-  static const char *key_message_id;  ///< JSON key for the message ID.
-  msg_id_t msg_id_;                   ///< The ID of this message.
+  msg_id_t msg_id_;  ///< The ID of this message.
 };
 
-/** Base class for all replicated messages. */
+/**
+ * Base class for all replicated messages.
+ *
+ * Messages are sent in a binary form: the message type, the metadata and then the fields of the message, each one
+ * copied as it is laid out in memory. The nodes of a replication network run the same build, so they agree on the
+ * layout and the byte order of the fields, just like the log files that the contents of a RecordsBatchMsg come from.
+ */
 class BaseReplicationMessage {
  public:
   /** Destructor. */
@@ -58,11 +76,15 @@ class BaseReplicationMessage {
   /** @return     The type of replication message that this is. */
   virtual ReplicationMessageType GetMessageType() const { return type_; }
 
-  /** @return     The JSON form of this message. */
-  virtual common::json ToJson() const;
+  /** @return     The binary form of this message, to be sent. */
+  virtual std::string Serialize() const;
 
-  /** @return     The parsed replication message. */
-  static std::unique_ptr<BaseReplicationMessage> ParseFromJson(const common::json &json);
+  /**
+   * @param message   The binary form of a message, as it was received.
+   * @return          The parsed replication message.
+   * @throw           ReplicationException if the message is malformed.
+   */
+  static std::unique_ptr<BaseReplicationMessage> ParseFromBinary(std::string_view message);
 
   /** @return     The metadata for this message. */
   const ReplicationMessageMetadata &GetMetadata() const { return metadata_; }
@@ -73,13 +95,13 @@ class BaseReplicationMessage {
  protected:
   /** Constructor (to send). */
   explicit BaseReplicationMessage(ReplicationMessageType type, ReplicationMessageMetadata metadata);
-  /** Constructor (to receive). */
-  explicit BaseReplicationMessage(const common::json &json);
+  /** Constructor (to receive), consuming the type and the metadata from the front of @p in. */
+  explicit BaseReplicationMessage(std::string_view *in);
 
- private:
-  static const char *key_message_type;  ///< JSON key for the message type.
-  static const char *key_metadata;      ///< JSON key for the message metadata.
+  /** Append the type and the metadata of this message to @p out. */
+  void SerializeHeader(std::string *out) const;
 
+ private:
   ReplicationMessageType type_;          ///< The type of this message.
   ReplicationMessageMetadata metadata_;  ///< The metadata for this message.
 };
@@ -99,13 +121,13 @@ class NotifyOATMsg : public BaseReplicationMessage {
    */
   NotifyOATMsg(ReplicationMessageMetadata metadata, record_batch_id_t batch_id,
                transaction::timestamp_t oldest_active_txn);
-  /** Constructor (to receive). */
-  explicit NotifyOATMsg(const common::json &json);
+  /** Constructor (to receive), consuming the message from the front of @p in. */
+  explicit NotifyOATMsg(std::string_view *in);
   /** Destructor. */
   ~NotifyOATMsg() override = default;
 
   ReplicationMessageType GetMessageType() const override { return ReplicationMessageType::NOTIFY_OAT; }
-  common::json ToJson() const override;
+  std::string Serialize() const override;
 
   /** @return The ID of the last batch of log records that was sent. */
   record_batch_id_t GetBatchId() const { return batch_id_; }
@@ -114,9 +136,6 @@ class NotifyOATMsg : public BaseReplicationMessage {
   transaction::timestamp_t GetOldestActiveTxn() const { return oldest_active_txn_; }
 
  private:
-  static const char *key_batch_id;           ///< JSON key for the batch ID.
-  static const char *key_oldest_active_txn;  ///< JSON key for the oldest active transaction.
-
   record_batch_id_t batch_id_;  ///< The batch ID identifies the batch that must be received before applying this OAT.
   transaction::timestamp_t oldest_active_txn_;  ///< Oldest active transaction.
 };
@@ -132,22 +151,23 @@ class RecordsBatchMsg : public BaseReplicationMessage {
    *
    * @param metadata            The metadata of the message.
    * @param batch_id            The ID for this batch of log records.
-   * @param buffer              The contents of this batch of log records.
+   * @param buffer              The contents of this batch of log records. Uncompressed contents are read from the
+   *                            buffer when the message is serialized, so it must stay untouched until then.
    */
   RecordsBatchMsg(ReplicationMessageMetadata metadata, record_batch_id_t batch_id, storage::BufferedLogWriter *buffer);
-  /** Constructor (to receive). */
-  explicit RecordsBatchMsg(const common::json &json);
+  /** Constructor (to receive), consuming the message from the front of @p in. */
+  explicit RecordsBatchMsg(std::string_view *in);
   /** Destructor. */
   ~RecordsBatchMsg() override = default;
 
   ReplicationMessageType GetMessageType() const override { return ReplicationMessageType::RECORDS_BATCH; }
-  common::json ToJson() const override;
+  std::string Serialize() const override;
 
   /** @return The ID of this batch of log records. */
   record_batch_id_t GetBatchId() const { return batch_id_; }
 
-  /** @return The contents of this batch of log records. */
-  std::string GetContents() const { return contents_; }
+  /** @return The contents of this batch of log records, once received. */
+  const std::string &GetContents() const { return contents_; }
 
   /** @return The batch ID that should appear after the given batch ID. */
   static record_batch_id_t NextBatchId(record_batch_id_t batch_id) {
@@ -158,11 +178,13 @@ class RecordsBatchMsg : public BaseReplicationMessage {
   }
 
  private:
-  static const char *key_batch_id;  ///< JSON key for the batch ID.
-  static const char *key_contents;  ///< JSON key for the contents.
+  /** @return The contents to send, which are read from the buffer unless they were compressed. */
+  std::string_view GetContentsToSend() const;
 
   record_batch_id_t batch_id_;  ///< The batch ID identifies the order of records sent by the remote origin.
-  std::string contents_;        ///< The actual contents of the buffer.
+  std::string contents_;        ///< The contents of a received or compressed batch.
+  const storage::BufferedLogWriter *buffer_;  ///< The buffer uncompressed contents are sent from, nullptr otherwise.
+  bool compressed_;  ///< True if the contents are a compressed frame. @see storage::LogCompression
 };
 
 /** TxnAppliedMsg is sent from replica -> primary, indicating that a given transaction has been successfully applied. */
@@ -170,20 +192,171 @@ class TxnAppliedMsg : public BaseReplicationMessage {
  public:
   /** Constructor (to send). */
   explicit TxnAppliedMsg(ReplicationMessageMetadata metadata, transaction::timestamp_t applied_txn_id);
-  /** Constructor (to receive). */
-  explicit TxnAppliedMsg(const common::json &json);
+  /** Constructor (to receive), consuming the message from the front of @p in. */
+  explicit TxnAppliedMsg(std::string_view *in);
   /** Destructor. */
   ~TxnAppliedMsg() override = default;
 
   ReplicationMessageType GetMessageType() const override { return ReplicationMessageType::TXN_APPLIED; }
-  common::json ToJson() const override;
+  std::string Serialize() const override;
 
   /** @return The ID of the transaction that was applied on the replica. */
   transaction::timestamp_t GetAppliedTxnId() const { return applied_txn_id_; }
 
  private:
-  static const char *key_applied_txn_id;     ///< JSON key for the applied transaction ID.
   transaction::timestamp_t applied_txn_id_;  ///< The ID of the transaction that was applied on the replica.
 };
 
+/**
+ * BatchesReceivedMsg is sent from replica -> primary, indicating that the replica has received every batch of log
+ * records up to and including a given batch. One message acknowledges all the batches that arrived since the last one.
+ */
+class BatchesReceivedMsg : public BaseReplicationMessage {
+ public:
+  /** Constructor (to send). */
+  explicit BatchesReceivedMsg(ReplicationMessageMetadata metadata, record_batch_id_t batch_id);
+  /** Constructor (to receive), consuming the message from the front of @p in. */
+  explicit BatchesReceivedMsg(std::string_view *in);
+  /** Destructor. */
+  ~BatchesReceivedMsg() override = default;
+
+  ReplicationMessageType GetMessageType() const override { return ReplicationMessageType::BATCHES_RECEIVED; }
+  std::string Serialize() const override;
+
+  /** @return The ID of the last batch that the replica received, along with all the batches before it. */
+  record_batch_id_t GetBatchId() const { return batch_id_; }
+
+ private:
+  record_batch_id_t batch_id_;  ///< The ID of the last batch that the replica received.
+};
+
+/** CheckpointRequestMsg is sent from replica -> primary, asking for the primary's latest checkpoint to be shipped. */
+class CheckpointRequestMsg : public BaseReplicationMessage {
+ public:
+  /** Constructor (to send). */
+  explicit CheckpointRequestMsg(ReplicationMessageMetadata metadata);
+  /** Constructor (to receive), consuming the message from the front of @p in. */
+  explicit CheckpointRequestMsg(std::string_view *in);
+  /** Destructor. */
+  ~CheckpointRequestMsg() override = default;
+
+  ReplicationMessageType GetMessageType() const override { return ReplicationMessageType::CHECKPOINT_REQUEST; }
+};
+
+/**
+ * CheckpointChunkMsg is sent from primary -> replica, containing a piece of one of the files of a checkpoint. Files are
+ * sent in pieces so that no single message has to hold a whole table.
+ */
+class CheckpointChunkMsg : public BaseReplicationMessage {
+ public:
+  /**
+   * Constructor (to send).
+   *
+   * @param metadata            The metadata of the message.
+   * @param timestamp           The snapshot timestamp of the checkpoint.
+   * @param file_name           The name of the file in the checkpoint's directory.
+   * @param offset              The offset of the piece in the file.
+   * @param contents            The contents of the piece.
+   */
+  CheckpointChunkMsg(ReplicationMessageMetadata metadata, transaction::timestamp_t timestamp, std::string file_name,
+                     uint64_t offset, std::string contents);
+  /** Constructor (to receive), consuming the message from the front of @p in. */
+  explicit CheckpointChunkMsg(std::string_view *in);
+  /** Destructor. */
+  ~CheckpointChunkMsg() override = default;
+
+  ReplicationMessageType GetMessageType() const override { return ReplicationMessageType::CHECKPOINT_CHUNK; }
+  std::string Serialize() const override;
+
+  /** @return The snapshot timestamp of the checkpoint. */
+  transaction::timestamp_t GetTimestamp() const { return timestamp_; }
+
+  /** @return The name of the file in the checkpoint's directory. */
+  const std::string &GetFileName() const { return file_name_; }
+
+  /** @return The offset of the piece in the file. */
+  uint64_t GetOffset() const { return offset_; }
+
+  /** @return The contents of the piece. */
+  const std::string &GetContents() const { return contents_; }
+
+ private:
+  transaction::timestamp_t timestamp_;  ///< The snapshot timestamp of the checkpoint.
+  std::string file_name_;               ///< The name of the file in the checkpoint's directory.
+  uint64_t offset_;                     ///< The offset of the piece in the file.
+  std::string contents_;                ///< The contents of the piece.
+};
+
+/**
+ * CheckpointShippedMsg is sent from primary -> replica after all the pieces of a checkpoint, describing the checkpoint.
+ * A primary without a checkpoint answers a CheckpointRequestMsg with just this message and an invalid timestamp.
+ */
+class CheckpointShippedMsg : public BaseReplicationMessage {
+ public:
+  /**
+   * Constructor (to send).
+   *
+   * @param metadata            The metadata of the message.
+   * @param timestamp           The snapshot timestamp of the checkpoint, INVALID_TXN_TIMESTAMP if there is none.
+   * @param num_chunks          The number of CheckpointChunkMsgs that the checkpoint was sent in.
+   * @param tables              The tables contained in the checkpoint.
+   */
+  CheckpointShippedMsg(ReplicationMessageMetadata metadata, transaction::timestamp_t timestamp, uint64_t num_chunks,
+                       std::vector<std::pair<catalog::db_oid_t, catalog::table_oid_t>> tables);
+  /** Constructor (to receive), consuming the message from the front of @p in. */
+  explicit CheckpointShippedMsg(std::string_view *in);
+  /** Destructor. */
+  ~CheckpointShippedMsg() override = default;
+
+  ReplicationMessageType GetMessageType() const override { return ReplicationMessageType::CHECKPOINT_SHIPPED; }
+  std::string Serialize() const override;
+
+  /** @return The snapshot timestamp of the checkpoint, INVALID_TXN_TIMESTAMP if the primary has none. */
+  transaction::timestamp_t GetTimestamp() const { return timestamp_; }
+
+  /** @return The number of CheckpointChunkMsgs that the checkpoint was sent in. */
+  uint64_t GetNumChunks() const { return num_chunks_; }
+
+  /** @return The tables contained in the checkpoint. */
+  const std::vector<std::pair<catalog::db_oid_t, catalog::table_oid_t>> &GetTables() const { return tables_; }
+
+ private:
+  transaction::timestamp_t timestamp_;  ///< The snapshot timestamp of the checkpoint.
+  uint64_t num_chunks_;                 ///< The number of pieces that the checkpoint was sent in.
+  std::vector<std::pair<catalog::db_oid_t, catalog::table_oid_t>> tables_;  ///< The tables in the checkpoint.
+};
+
+/**
+ * ChangeBatchMsg is sent from replica -> change data capture subscriber, containing the decoded row changes of a batch
+ * of applied transactions. @see storage::LogicalDecoder for the form of the changes.
+ */
+class ChangeBatchMsg : public BaseReplicationMessage {
+ public:
+  /**
+   * Constructor (to send).
+   *
+   * @param metadata            The metadata of the message.
+   * @param last_txn_id         The ID of the last transaction whose changes are in the batch.
+   * @param changes             The changes, one per line.
+   */
+  ChangeBatchMsg(ReplicationMessageMetadata metadata, transaction::timestamp_t last_txn_id, std::string changes);
+  /** Constructor (to receive), consuming the message from the front of @p in. */
+  explicit ChangeBatchMsg(std::string_view *in);
+  /** Destructor. */
+  ~ChangeBatchMsg() override = default;
+
+  ReplicationMessageType GetMessageType() const override { return ReplicationMessageType::CHANGE_BATCH; }
+  std::string Serialize() const override;
+
+  /** @return The ID of the last transaction whose changes are in the batch. */
+  transaction::timestamp_t GetLastTxnId() const { return last_txn_id_; }
+
+  /** @return The changes, one per line. */
+  const std::string &GetChanges() const { return changes_; }
+
+ private:
+  transaction::timestamp_t last_txn_id_;  ///< The ID of the last transaction whose changes are in the batch.
+  std::string changes_;                   ///< The changes, one per line.
+};
+
 }  // namespace noisepage::replication
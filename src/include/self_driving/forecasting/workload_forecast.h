@@ -1,5 +1,6 @@
 #pragma once
 
+#include <ios>
 #include <map>
 #include <memory>
 #include <string>
@@ -7,6 +8,7 @@
 #include <utility>
 #include <vector>
 
+#include "common/macros.h"
 #include "parser/expression/constant_value_expression.h"
 #include "self_driving/forecasting/workload_forecast_segment.h"
 
@@ -17,15 +19,23 @@ using WorkloadForecastPrediction = std::unordered_map<uint64_t, std::unordered_m
 /**
  * Breaking predicted queries passed in by the Pilot into segments by their associated timestamps
  * Executing each query while extracting pipeline features
+ *
+ * The forecast follows the query traces as the metrics thread appends to them: an update only reads what was appended
+ * since the last one and counts it into the latest segments.
  */
 class WorkloadForecast {
  public:
   /**
    * Constructor for WorkloadForecast
    * @param forecast_interval Interval used to partition the queries into segments
-   *
+   * @param max_segments Number of the most recent segments to keep, 0 to keep all of them
    */
-  explicit WorkloadForecast(uint64_t forecast_interval);
+  explicit WorkloadForecast(uint64_t forecast_interval, uint64_t max_segments = 0);
+
+  /**
+   * Load the queries traced since the forecast was built or last updated, and count them into its segments
+   */
+  void Update();
 
   /**
    * Get number of forecasted segments
@@ -35,6 +45,7 @@ class WorkloadForecast {
 
  private:
   friend class PilotUtil;
+  FRIEND_TEST(WorkloadForecastTests, UpdateTest);
   const WorkloadForecastSegment &GetSegmentByIndex(uint64_t segment_index) {
     NOISEPAGE_ASSERT(segment_index < num_forecast_segment_, "invalid index");
     return forecast_segments_[segment_index];
@@ -66,6 +77,7 @@ class WorkloadForecast {
   void LoadQueryText();
   void CreateSegments();
 
+  // Queries loaded since the last update, by timestamp
   std::multimap<uint64_t, execution::query_id_t> query_timestamp_to_id_;
   std::unordered_map<execution::query_id_t, std::vector<std::vector<parser::ConstantValueExpression>>>
       query_id_to_params_;
@@ -76,8 +88,17 @@ class WorkloadForecast {
   uint64_t num_sample_{5};
 
   std::vector<WorkloadForecastSegment> forecast_segments_;
-  uint64_t num_forecast_segment_;
+  uint64_t num_forecast_segment_{0};
   uint64_t forecast_interval_;
+  uint64_t max_segments_;
+
+  // The queries of the last segment, which later updates still count queries into
+  std::unordered_map<execution::query_id_t, uint64_t> open_segment_;
+  uint64_t open_segment_start_{0};
+
+  // How far each file has been read
+  std::streamoff query_text_offset_{0};
+  std::streamoff query_trace_offset_{0};
   uint64_t optimizer_timeout_{10000000};
 };
 
@@ -3,6 +3,7 @@
  *  Currently, the operations supported are:
  *  - Training an Opunit model map from a sequence file directory.
  *  - Inferencing on one trained Opunit model with features.
+ *  - Inferencing on many trained Opunit models in one message, with the features encoded in binary.
  *  - Sending string message to the ModelServer
  *  - Quiting the ModelServer
  *
@@ -13,7 +14,10 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>  // NOLINT
 #include <condition_variable>  // NOLINT
+#include <map>
+#include <optional>
 #include <string>
 #include <thread>  // NOLINT
 #include <utility>
@@ -99,6 +103,19 @@ class ModelServerFuture {
     return {result_, success_};
   }
 
+  /**
+   * Suspends the current thread until the result is ready or the timeout expires, whichever comes first
+   * @param timeout how long to wait for the result
+   * @return Result, and success/fail. A future that timed out fails.
+   */
+  std::pair<Result, bool> WaitFor(std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (!cvar_.wait_for(lock, timeout, [&] { return done_.load(); })) {
+      return {Result(), false};
+    }
+    return {result_, success_};
+  }
+
   /**
    * Indicate a future is done by parsing the message from the ModelServer
    * this will unblock waiters that have called future->Wait()
@@ -178,6 +195,28 @@ class ModelServerFuture {
   std::mutex mtx_;
 };
 
+/**
+ * Features to infer with the models of many opunits, or the predictions of those models, by the name of the opunit.
+ */
+using OUMatrices = std::map<std::string, std::vector<std::vector<double>>>;
+
+/**
+ * Encodes a matrix for the ModelServer as {"shape": [rows, columns], "data": base64 of its doubles}. The doubles are
+ * little endian in row major order, so that the ModelServer decodes them with a single numpy call rather than parsing
+ * every number of a nested JSON array.
+ * @param matrix matrix whose rows all have the same size
+ * @return the encoded matrix
+ */
+nlohmann::json EncodeMatrix(const std::vector<std::vector<double>> &matrix);
+
+/**
+ * Decodes a matrix encoded the way EncodeMatrix() does
+ * @param encoded the encoded matrix
+ * @param[out] matrix the decoded matrix
+ * @return true if the encoded matrix was well formed
+ */
+bool DecodeMatrix(const nlohmann::json &encoded, std::vector<std::vector<double>> *matrix);
+
 /**
  * This initializes a connection to the model by opening up a zmq connection
  * @param messenger
@@ -329,12 +368,41 @@ class ModelServerManager {
    * @param opunit Model for which to invoke
    * @param model_path Path to a model that has been trained. (In pickle format)
    * @param features Feature vectors
+   * @param timeout how long to wait for the ModelServer, forever if not given
    * @return a vector of results returned by ModelServer and if API succeeds (True when succeeds)
-   *    When API fails, the return results will be an empty vector
+   *    When API fails or times out, the return results will be an empty vector
+   */
+  std::pair<std::vector<std::vector<double>>, bool> InferOUModel(
+      const std::string &opunit, const std::string &model_path, const std::vector<std::vector<double>> &features,
+      std::optional<std::chrono::milliseconds> timeout = std::nullopt);
+
+  /**
+   * Perform inference with the OU models of many opunits in one message, with the features encoded in binary
+   *
+   * This function will be invoked asynchronously, so that the caller can go on while the ModelServer infers.
+   * The future must live until it is done.
+   *
+   * @param model_path Path to a model that has been trained. (In pickle format)
+   * @param features Feature vectors by the name of the opunit to infer with
+   * @param future A future object which is done with the predictions by the name of the opunit
+   * @return True if sending the inference request succeeds
    */
-  std::pair<std::vector<std::vector<double>>, bool> InferOUModel(const std::string &opunit,
-                                                                 const std::string &model_path,
-                                                                 const std::vector<std::vector<double>> &features);
+  bool InferOUModelsAsync(const std::string &model_path, const OUMatrices &features,
+                          common::ManagedPointer<ModelServerFuture<OUMatrices>> future);
+
+  /**
+   * Perform inference with the OU models of many opunits in one message, with the features encoded in binary
+   *
+   * This function is a blocking API call to the ModelServer, and only returns when result is sent back.
+   *
+   * @param model_path Path to a model that has been trained. (In pickle format)
+   * @param features Feature vectors by the name of the opunit to infer with
+   * @param timeout how long to wait for the ModelServer, forever if not given
+   * @return the predictions by the name of the opunit and if API succeeds (True when succeeds)
+   *    When API fails or times out, the return results will be an empty map
+   */
+  std::pair<OUMatrices, bool> InferOUModels(const std::string &model_path, const OUMatrices &features,
+                                            std::optional<std::chrono::milliseconds> timeout = std::nullopt);
 
   /**
    * Perform inference on the given data file using the interference model
@@ -358,10 +426,22 @@ class ModelServerManager {
    * @param model type of model to invoke (i.e., forecast or mini-runner)
    * @param model_path Path to a model that has been trained. (In pickle format)
    * @param payload Payload to pass as the "data" field to the ModelServer
+   * @param timeout how long to wait for the ModelServer, forever if not given
    * @return pair comprising the result and a bool flag for success/failure
    */
   template <class Result>
-  std::pair<Result, bool> InferModel(ModelType::Type model, const std::string &model_path, nlohmann::json *payload);
+  std::pair<Result, bool> InferModel(ModelType::Type model, const std::string &model_path, nlohmann::json *payload,
+                                     std::optional<std::chrono::milliseconds> timeout = std::nullopt);
+
+  /**
+   * Send a batched inference request to the OU models
+   * @param model_path Path to a model that has been trained. (In pickle format)
+   * @param features Feature vectors by the name of the opunit to infer with
+   * @param future A future object which is done with the predictions by the name of the opunit
+   * @return True if sending succeeds
+   */
+  template <class FuturePtr>
+  bool SendInferOUBatch(const std::string &model_path, const OUMatrices &features, FuturePtr future);
 
   /**
    * This should be run as a thread routine.
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/json.h"
+#include "common/macros.h"
+#include "self_driving/modeling/operating_unit_defs.h"
+
+namespace noisepage::selfdriving {
+
+/**
+ * The trained model of one operating unit, evaluated in-process. The model server exports what it trains (see
+ * export_model_map() in script/self_driving/modeling/model.py): the normalization and transformations of the features
+ * and labels, and a linear model or an ensemble of regression trees.
+ *
+ * The trees of all labels are flattened into one array of nodes, where the right child of a node directly follows
+ * its left child and a leaf is its own left child that no feature is greater than. Every tree is then evaluated for a
+ * batch of rows at once by stepping all of them down one level at a time for as many levels as the tree is deep, which
+ * takes no branches and lets the compiler vectorize the loop over the rows.
+ */
+class OUModel {
+ public:
+  /** Number of rows that a tree is evaluated for at once. */
+  static constexpr uint32_t BATCH_SIZE = 16;
+
+  /**
+   * @param exported the exported model
+   * @throw nlohmann::json::exception or std::invalid_argument if the model is malformed
+   */
+  explicit OUModel(const nlohmann::json &exported);
+
+  /** @return number of features that the model predicts from */
+  uint32_t NumFeatures() const { return num_features_; }
+
+  /** @return number of labels that the model predicts */
+  uint32_t NumLabels() const { return num_labels_; }
+
+  /**
+   * @param features features of the operating units, NumFeatures() per row
+   * @return the predicted labels of every row, like the model server answers an inference request
+   */
+  std::vector<std::vector<double>> Predict(const std::vector<std::vector<double>> &features) const;
+
+ private:
+  /** How the features or labels are scaled by the number of rows or the cardinality (data_transforming_util.py). */
+  enum class Transform : uint8_t {
+    NONE,
+    NUM_ROWS_LINEAR,
+    NUM_ROWS_MEMORY_CARDINALITY_LINEAR,
+    NUM_ROWS_LOG_CARDINALITY_LINEAR,
+    NUM_ROWS_LINEAR_LOG,
+    NUM_ROWS_LOG,
+    CARDINALITY_LINEAR,
+    NUM_ROWS_CARDINALITY_LINEAR
+  };
+
+  struct Tree {
+    uint32_t root_;
+    uint32_t depth_;
+    /** Labels that the leaves of the tree hold a value for, in the order of the values. */
+    std::vector<uint32_t> labels_;
+    /** Offset of the values of the leaves, which are indexed by the node minus the root. */
+    uint32_t values_offset_;
+  };
+
+  static Transform ParseTransform(const std::string &name);
+  void LoadTrees(const nlohmann::json &regressor);
+
+  /** Transforms the features of a row into what the regressor was trained on, like Model.predict() does. */
+  void TransformFeatures(const std::vector<double> &features, double *x) const;
+  /** Predicts the labels of a batch of rows of transformed features, as the regressor was trained to. */
+  void Regress(const double *x, uint32_t num_rows, double *y) const;
+  /** Transforms the labels that the regressor predicted for a row back. */
+  void TransformLabels(const std::vector<double> &features, const double *y, std::vector<double> *labels) const;
+
+  uint32_t num_features_;
+  uint32_t num_labels_;
+
+  bool log_transform_;
+  double log_epsilon_;
+  std::vector<double> x_mean_, x_scale_, y_mean_, y_scale_;
+  Transform x_transform_;
+  Transform y_transform_;
+  uint32_t num_rows_index_;
+  uint32_t cardinality_index_;
+  uint32_t memory_label_index_;
+
+  /** Linear model, per label. */
+  std::vector<std::vector<double>> coef_;
+  std::vector<double> intercept_;
+
+  /** Tree ensemble. Trees that features are compared to as floats, like scikit-learn does, set float_features_. */
+  bool float_features_ = false;
+  std::vector<double> base_;
+  double tree_scale_ = 1;
+  std::vector<Tree> trees_;
+  std::vector<uint32_t> feature_;
+  std::vector<double> threshold_;
+  std::vector<uint32_t> left_;
+  std::vector<double> values_;
+};
+
+/**
+ * The exported models of all operating units that the model server trained into one model map.
+ */
+class OUModelMap {
+ public:
+  /**
+   * @param model_save_path path of the model map that the model server trained
+   * @return path that the model server exports the model map to, which has the extension replaced by .json
+   */
+  static std::string ExportPath(const std::string &model_save_path);
+
+  /**
+   * @param path path of an exported model map
+   * @return the models, or nullptr if there is no exported model map at the path or it is malformed
+   */
+  static std::unique_ptr<OUModelMap> Load(const std::string &path);
+
+  /**
+   * @param type an operating unit
+   * @return the model of the operating unit, or nullptr if none was exported for it
+   */
+  const OUModel *GetModel(ExecutionOperatingUnitType type) const;
+
+ private:
+  std::unordered_map<std::string, std::unique_ptr<OUModel>> models_;
+};
+
+/**
+ * Keeps the exported models of the model map at a path loaded for the queries to share, and loads them again once the
+ * model server exports them anew.
+ */
+class OUModelMapLoader {
+ public:
+  /**
+   * @param model_save_path path of the model map that the model server trained
+   * @return the exported models, or nullptr if there are none
+   */
+  std::shared_ptr<const OUModelMap> Get(const std::string &model_save_path);
+
+ private:
+  std::mutex latch_;
+  std::string path_;
+  timespec modified_{};
+  std::shared_ptr<const OUModelMap> models_;
+};
+
+}  // namespace noisepage::selfdriving
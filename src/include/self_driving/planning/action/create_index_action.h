@@ -47,6 +47,16 @@ class CreateIndexAction : public AbstractAction {
    */
   const std::string &GetIndexName() const { return index_name_; }
 
+  /**
+   * @return Name of the table to create the index on
+   */
+  const std::string &GetTableName() const { return table_name_; }
+
+  /**
+   * @return The columns to build the index on
+   */
+  const std::vector<IndexColumn> &GetColumns() const { return columns_; }
+
  private:
   std::string index_name_;
   std::string table_name_;
@@ -41,6 +41,11 @@ class MonteCarloTreeSearch {
   void BestAction(uint64_t simulation_number,
                   std::vector<std::pair<const std::string, catalog::db_oid_t>> *best_action_seq);
 
+  /**
+   * @return the average cost of the forecasted segments without any action applied
+   */
+  double GetSegmentCost() const { return segment_cost_; }
+
  private:
   const common::ManagedPointer<Pilot> pilot_;
   const common::ManagedPointer<selfdriving::WorkloadForecast> forecast_;
@@ -48,6 +53,7 @@ class MonteCarloTreeSearch {
   std::unique_ptr<TreeNode> root_;
   std::map<action_id_t, std::unique_ptr<AbstractAction>> action_map_;
   std::vector<action_id_t> candidate_actions_;
+  double segment_cost_;
   bool use_min_cost_;  // Use the minimum cost of all leaves (instead of the average) as the cost for internal nodes
 };
 }  // namespace pilot
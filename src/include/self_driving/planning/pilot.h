@@ -15,6 +15,7 @@
 #include "common/managed_pointer.h"
 #include "execution/exec_defs.h"
 #include "self_driving/forecasting/workload_forecast.h"
+#include "self_driving/modeling/operating_unit_defs.h"
 #include "self_driving/planning/action/action_defs.h"
 
 namespace noisepage {
@@ -94,7 +95,8 @@ class Pilot {
   common::ManagedPointer<modelserver::ModelServerManager> GetModelServerManager() { return model_server_manager_; }
 
   /**
-   * Performs Pilot Logic, load and execute the predicted queries while extracting pipeline features
+   * Performs Pilot Logic, load and execute the predicted queries while extracting pipeline features. The forecast is
+   * built on the first call and follows the query traces from then on.
    */
   void PerformPlanning();
 
@@ -115,6 +117,23 @@ class Pilot {
    */
   std::unique_ptr<selfdriving::WorkloadForecast> forecast_;
 
+  /**
+   * Number of ou predictions to cache before the cache is dropped
+   */
+  static constexpr uint64_t MAX_CACHED_OU_PREDICTIONS = 1000000;
+
+  /**
+   * Share of the CPU that an index the pilot creates is built with at least, however loaded the system is forecasted
+   */
+  static constexpr double MIN_INDEX_BUILD_CPU_SHARE = 0.05;
+
+  /**
+   * The ou predictions of the model server by the features they were inferred from. The rollouts of a search mostly
+   * execute the same pipelines over the same data, and a prediction holds until the ou models change.
+   */
+  std::unordered_map<ExecutionOperatingUnitType, std::map<std::vector<double>, std::vector<double>>>
+      ou_prediction_cache_;
+
   /**
    * Empty Setter Callback for setting bool value for flags
    */
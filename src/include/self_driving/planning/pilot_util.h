@@ -3,14 +3,17 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "common/container/chunked_list.h"
 #include "metrics/metrics_store.h"
 #include "parser/expression/constant_value_expression.h"
+#include "self_driving/planning/action/action_defs.h"
 
 namespace noisepage {
 namespace catalog {
@@ -22,6 +25,7 @@ class ModelServerManager;
 }
 
 namespace transaction {
+class TransactionContext;
 class TransactionManager;
 }
 
@@ -31,6 +35,7 @@ class StatsStorage;
 
 namespace planner {
 class AbstractPlanNode;
+class CreateIndexPlanNode;
 }
 }  // namespace noisepage
 
@@ -38,6 +43,10 @@ namespace noisepage::selfdriving {
 class WorkloadForecast;
 class Pilot;
 
+namespace pilot {
+class AbstractAction;
+}  // namespace pilot
+
 /**
  * Utility class for helper functions
  */
@@ -53,7 +62,7 @@ class PilotUtil {
    * forecasted qids due to the auto-incremental nature of the qids in pipeline metrics)
    * @returns const pointer to the collected pipeline data
    */
-  static const std::list<metrics::PipelineMetricRawData::PipelineData> &CollectPipelineFeatures(
+  static const common::ChunkedList<metrics::PipelineMetricRawData::PipelineData> &CollectPipelineFeatures(
       common::ManagedPointer<Pilot> pilot, common::ManagedPointer<WorkloadForecast> forecast,
       uint64_t start_segment_index, uint64_t end_segment_index, std::vector<execution::query_id_t> *pipeline_qids);
 
@@ -65,22 +74,42 @@ class PilotUtil {
    * @param pipeline_qids vector of real qids (those from forecast) for pipelines in pipeline data; necessary since the
    * auto-incremental nature of qid in pipeline metrics
    * @param pipeline_data collected pipeline metrics after executing the forecasted queries
+   * @param ou_prediction_cache predictions by the features they were inferred from, only the features missing from it
+   * are sent to the model server and it is filled with their predictions
    * @param pipeline_to_prediction list of tuples of query id, pipeline id and result of prediction
    */
-  static void InferenceWithFeatures(const std::string &model_save_path,
-                                    common::ManagedPointer<modelserver::ModelServerManager> model_server_manager,
-                                    const std::vector<execution::query_id_t> &pipeline_qids,
-                                    const std::list<metrics::PipelineMetricRawData::PipelineData> &pipeline_data,
-                                    std::map<std::pair<execution::query_id_t, execution::pipeline_id_t>,
-                                             std::vector<std::vector<std::vector<double>>>> *pipeline_to_prediction);
+  static void InferenceWithFeatures(
+      const std::string &model_save_path, common::ManagedPointer<modelserver::ModelServerManager> model_server_manager,
+      const std::vector<execution::query_id_t> &pipeline_qids,
+      const common::ChunkedList<metrics::PipelineMetricRawData::PipelineData> &pipeline_data,
+      common::ManagedPointer<
+          std::unordered_map<ExecutionOperatingUnitType, std::map<std::vector<double>, std::vector<double>>>>
+          ou_prediction_cache,
+      std::map<std::pair<execution::query_id_t, execution::pipeline_id_t>,
+               std::vector<std::vector<std::vector<double>>>> *pipeline_to_prediction);
 
   /**
    * Apply an action supplied through its query string to the database specified
    * @param pilot pointer to the pilot
    * @param sql_query query of the action to be executed
    * @param db_oid oid of the database where this action should be applied
+   * @param index_build_cpu_share if set, an index that the action creates is built online, with its threads throttled
+   * to this share of their time, instead of at full speed within the transaction of the action. The searches for
+   * actions build indexes at full speed, and only the action that the pilot picks is built online.
+   */
+  static void ApplyAction(common::ManagedPointer<Pilot> pilot, const std::string &sql_query, catalog::db_oid_t db_oid,
+                          std::optional<double> index_build_cpu_share = std::nullopt);
+
+  /**
+   * Predict the time it takes to build the indexes of the create index actions with the CREATE_INDEX model, and set it
+   * as their estimated elapsed time, which the search counts into the cost of applying them
+   * @param pilot pointer to the pilot
+   * @param txn the transaction to look the tables up with
+   * @param action_map the actions of the search
    */
-  static void ApplyAction(common::ManagedPointer<Pilot> pilot, const std::string &sql_query, catalog::db_oid_t db_oid);
+  static void EstimateCreateIndexActions(common::ManagedPointer<Pilot> pilot, transaction::TransactionContext *txn,
+                                         const std::map<pilot::action_id_t, std::unique_ptr<pilot::AbstractAction>>
+                                             &action_map);
 
   /**
    * Retrieve all query plans associated with queries in the interval of forecasted segments
@@ -126,6 +155,24 @@ class PilotUtil {
                             uint64_t start_segment_index, uint64_t end_segment_index);
 
  private:
+  /**
+   * Publish the index that the plan created within the transaction as invalid by committing the transaction, fill it
+   * with an OnlineIndexBuilder, and mark it valid in pg_index in a later transaction. An index that cannot be built is
+   * dropped again.
+   * @param pilot pointer to the pilot
+   * @param txn the transaction that created the index
+   * @param accessor catalog accessor of the transaction
+   * @param plan plan of the CREATE INDEX
+   * @param db_oid oid of the database of the index
+   * @param cpu_share share of their time that the threads building the index may spend working
+   * @return false, without committing the transaction, if the keys of the index are not all plain columns, which only
+   * the CREATE INDEX query itself can build
+   */
+  static bool CreateIndexOnline(common::ManagedPointer<Pilot> pilot, transaction::TransactionContext *txn,
+                                common::ManagedPointer<catalog::CatalogAccessor> accessor,
+                                common::ManagedPointer<planner::CreateIndexPlanNode> plan, catalog::db_oid_t db_oid,
+                                double cpu_share);
+
   /**
    * Group pipeline features by ou for block inference
    * To recover the result for each pipeline, also maintain a multimap pipeline_to_ou_position
@@ -141,7 +188,7 @@ class PilotUtil {
       std::list<std::tuple<execution::query_id_t, execution::pipeline_id_t,
                            std::vector<std::pair<ExecutionOperatingUnitType, uint64_t>>>> *pipeline_to_ou_position,
       const std::vector<execution::query_id_t> &pipeline_qids,
-      const std::list<metrics::PipelineMetricRawData::PipelineData> &pipeline_data,
+      const common::ChunkedList<metrics::PipelineMetricRawData::PipelineData> &pipeline_data,
       std::unordered_map<ExecutionOperatingUnitType, std::vector<std::vector<double>>> *ou_to_features);
 };
 
@@ -88,6 +88,16 @@ class Callbacks {
   static void WalSerializationInterval(void *old_value, void *new_value, DBMain *db_main,
                                        common::ManagedPointer<common::ActionContext> action_context);
 
+  /**
+   * Changes the interval that the garbage collector thread runs at.
+   * @param old_value old settings value
+   * @param new_value new settings value
+   * @param db_main pointer to db_main
+   * @param action_context pointer to the action context for this settings change
+   */
+  static void GcInterval(void *old_value, void *new_value, DBMain *db_main,
+                         common::ManagedPointer<common::ActionContext> action_context);
+
   /**
    * Enable or disable metrics collection for Logging component
    * @param old_value old settings value
@@ -188,6 +198,16 @@ class Callbacks {
   static void MetricsQueryTrace(void *old_value, void *new_value, DBMain *db_main,
                                 common::ManagedPointer<common::ActionContext> action_context);
 
+  /**
+   * Enable or disable metrics collection for Replication component
+   * @param old_value old settings value
+   * @param new_value new settings value
+   * @param db_main pointer to db_main
+   * @param action_context pointer to the action context for this settings change
+   */
+  static void MetricsReplication(void *old_value, void *new_value, DBMain *db_main,
+                                 common::ManagedPointer<common::ActionContext> action_context);
+
   /**
    * Enable or disable planning in Pilot thread
    * @param old_value old settings value
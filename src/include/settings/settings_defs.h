@@ -33,6 +33,26 @@ SETTING_int(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Threads that execute the queries of the connections
+SETTING_int(
+    network_worker_thread_count,
+    "Threads that execute queries off the connection handler threads, 0 to execute them on the handlers (default: 0)",
+    0,
+    0,
+    1024,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Per-handler networked sockets with SO_REUSEPORT
+SETTING_bool(
+    network_reuse_port,
+    "Give every connection handler thread its own networked socket with SO_REUSEPORT (default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Path to socket file for Unix domain sockets
 SETTING_string(
     uds_file_directory,
@@ -86,6 +106,38 @@ SETTING_int(
     noisepage::settings::Callbacks::BlockStoreReuseLimit
 )
 
+// BlockStore huge pages
+SETTING_bool(
+    block_store_huge_pages,
+    "Allocate storage blocks from an arena of huge pages reserved for block_store_size blocks. (default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Number of threads that truncate version chains
+SETTING_int(
+    gc_num_threads,
+    "The number of garbage collector threads that truncate version chains in parallel (default: 1)",
+    1,
+    1,
+    64,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Interval of the background maintenance of the indexes registered with the garbage collector
+SETTING_int(
+    index_maintenance_interval,
+    "Interval (us) at which every index consolidates and garbage collects in a background thread, 0 to disable "
+    "(default: 0)",
+    0,
+    0,
+    1000000,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Garbage collector thread interval
 SETTING_int(
     gc_interval,
@@ -93,8 +145,8 @@ SETTING_int(
     1000,
     1,
     10000,
-    false,
-    noisepage::settings::Callbacks::NoOp
+    true,
+    noisepage::settings::Callbacks::GcInterval
 )
 
 // Write ahead logging
@@ -124,6 +176,34 @@ SETTING_bool(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Batched commit timestamps
+SETTING_bool(
+    txn_commit_batching,
+    "Let concurrently committing transactions check out their commit timestamps as a group. (default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Serializable isolation
+SETTING_bool(
+    txn_serializable,
+    "Run client transactions at serializable isolation unless they ask for another level. (default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Compression of log buffers
+SETTING_bool(
+    wal_compression_enable,
+    "Compress log buffers before they are written to the log file and sent to replicas. A log file must be written "
+    "with the same setting throughout. (default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Number of buffers log manager can use to buffer logs
 SETTING_int64(
     wal_num_buffers,
@@ -135,6 +215,17 @@ SETTING_int64(
     noisepage::settings::Callbacks::WalNumBuffers
 )
 
+// Number of independent log streams
+SETTING_int(
+    wal_num_streams,
+    "The number of independent log streams, each with its own serializer, consumer and log file (default: 1)",
+    1,
+    1,
+    64,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Log Serialization interval
 SETTING_int(
     wal_serialization_interval,
@@ -157,12 +248,159 @@ SETTING_int(
     noisepage::settings::Callbacks::NoOp
 )
 
+// Log file preallocation size
+SETTING_int64(
+    wal_preallocation_size,
+    "Size of the chunks of disk space reserved ahead of the end of the log file (bytes), 0 to disable (default: 0)",
+    0,
+    0,
+    (1 << 30) /* 1GB */,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Log segment size
+SETTING_int64(
+    wal_segment_size,
+    "Size after which the log file is continued in a new segment (bytes), 0 to never start a new segment (default: 0)",
+    0,
+    0,
+    (1 << 30) /* 1GB */,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Path to the log ring in persistent memory
+SETTING_string(
+    wal_ring_path,
+    "Path to a ring on persistent memory (e.g., a DAX file system) that commits are acknowledged from before the log "
+    "file is persisted, empty to disable (default: empty)",
+    "",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Log ring size
+SETTING_int64(
+    wal_ring_size,
+    "Capacity of the log ring of each log stream (bytes) (default: 16MB)",
+    (1 << 24) /* 16MB */,
+    (1 << 20) /* 1MB */,
+    (1 << 30) /* 1GB */,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Optimizer timeout
 SETTING_int(task_execution_timeout,
             "Maximum allowed length of time (in ms) for task execution step of optimizer, "
             "assuming one plan has been found (default 5000)",
             5000, 1000, 60000, false, noisepage::settings::Callbacks::NoOp)
 
+SETTING_int(
+    optimizer_num_threads,
+    "Number of threads that optimize the independent parts of a query at once, 1 to optimize it on one thread "
+    "(default: 1)",
+    1,
+    1,
+    64,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Optimizer cost model
+SETTING_bool(
+    cardinality_cost_model,
+    "Whether the optimizer costs plans by the estimated cardinality of their operators instead of by fixed "
+    "preferences (default: false)",
+    false,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_bool(
+    learned_cost_model,
+    "Whether the optimizer costs plans by the elapsed time that the operating unit models predict for their operators, "
+    "when the model server is running (default: false)",
+    false,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_bool(
+    learned_cost_model_in_process,
+    "Whether the optimizer evaluates the operating unit models that the model server exported in-process, and only "
+    "asks the model server for the models that it could not export (default: true)",
+    true,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int(
+    learned_cost_model_timeout,
+    "Time (in ms) that the optimizer waits for the operating unit models before it falls back to the other cost model "
+    "(default: 10)",
+    10,
+    1,
+    10000,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Re-optimization of queries whose estimates were far off
+SETTING_int(
+    reoptimization_cardinality_error,
+    "Factor by which the number of rows of a hash join's build side may differ from its estimate before a SELECT "
+    "stops, is optimized again with the observed numbers of rows and restarts, 0 to never re-optimize (default: 0)",
+    0,
+    0,
+    1000000000,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Automatic statistics collection
+SETTING_bool(
+    auto_analyze,
+    "Whether a background thread runs ANALYZE on the tables that were modified enough since their last ANALYZE "
+    "(default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    auto_analyze_interval,
+    "Time (in us) between two checks of the tables by the automatic ANALYZE thread (default: 60000000)",
+    60000000,
+    1000,
+    86400000000,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int(
+    auto_analyze_threshold,
+    "Number of modified tuples that triggers an automatic ANALYZE of a table, on top of the scale factor "
+    "(default: 50)",
+    50,
+    0,
+    INT32_MAX,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_double(
+    auto_analyze_scale_factor,
+    "Fraction of the rows of a table that has to be modified, on top of the threshold, to trigger an automatic "
+    "ANALYZE (default: 0.1)",
+    0.1,
+    0.0,
+    100.0,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 // Parallel Execution
 SETTING_bool(
     parallel_execution,
@@ -239,6 +477,24 @@ SETTING_bool(
     noisepage::settings::Callbacks::NoOp
 )
 
+SETTING_string(
+    metrics_sink,
+    "Where metrics are written: csv, binary or ring_buffer (default: csv). The pilot reads the query trace CSV files.",
+    "csv",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int(
+    metrics_ring_buffer_rows,
+    "Number of rows of each metrics output that the ring_buffer sink keeps in memory (default: 100000).",
+    100000,
+    1,
+    100000000,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_bool(
     use_pilot_thread,
     "Use a thread for the pilot (default: false).",
@@ -255,6 +511,27 @@ SETTING_bool(
     noisepage::settings::Callbacks::PilotEnablePlanning
 )
 
+SETTING_int(
+    pilot_index_build_threads,
+    "Number of threads that build an index that the pilot creates, online while the table is written to (default: 1).",
+    1,
+    1,
+    128,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int(
+    pilot_index_build_cpu_share,
+    "Percentage of their time that the threads building an index that the pilot creates may spend working. The pilot "
+    "lowers it further by the share of the CPU that the forecasted workload will take (default: 50).",
+    50,
+    1,
+    100,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_bool(
     logging_metrics_enable,
     "Metrics collection for the Logging component (default: false).",
@@ -339,6 +616,14 @@ SETTING_bool(
     noisepage::settings::Callbacks::MetricsExecuteCommand
 )
 
+SETTING_bool(
+    replication_metrics_enable,
+    "Metrics collection for replication and the Messenger sends it depends on.",
+    false,
+    true,
+    noisepage::settings::Callbacks::MetricsReplication
+)
+
 SETTING_bool(
     use_query_cache,
     "Extended Query protocol caches physical plans and generated code after first execution. Warning: bugs with DDL changes.",
@@ -347,6 +632,16 @@ SETTING_bool(
     noisepage::settings::Callbacks::NoOp
 )
 
+SETTING_int64(
+    result_cache_size,
+    "Bytes of results of read-only queries the traffic cop caches and serves without execution, 0 to disable (default: 0)",
+    0,
+    0,
+    (1 << 30) /* 1GB */,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_bool(
     compiled_query_execution,
     "Compile queries to native machine code using LLVM, rather than relying on TPL interpretation (default: false).",
@@ -381,6 +676,107 @@ SETTING_int(
     noisepage::settings::Callbacks::NoOp
 )
 
+SETTING_int64(
+    aggregation_memory_budget,
+    "Memory a thread may use in a parallel aggregation before spilling to disk (bytes), 0 for no limit (default: 0)",
+    0,
+    0,
+    (int64_t{1} << 40) /* 1TB */,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    aggregation_bypass_threshold,
+    "Percentage of input tuples starting new groups at which parallel pre-aggregation is bypassed, 0 to disable "
+    "(default: 90)",
+    90,
+    0,
+    100,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    join_memory_budget,
+    "Memory a hash join may use for build-side tuples before spilling to disk (bytes), 0 for no limit (default: 0)",
+    0,
+    0,
+    (int64_t{1} << 40) /* 1TB */,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    sort_memory_budget,
+    "Memory a sorter may use for buffered tuples before spilling a sorted run to disk (bytes), 0 for no limit "
+    "(default: 0)",
+    0,
+    0,
+    (int64_t{1} << 40) /* 1TB */,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    join_build_partition_bits,
+    "Radix bits a parallel hash join build partitions on, 0 to disable, -1 to fit partitions to the L2 (default: -1)",
+    -1,
+    -1,
+    10,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_bool(
+    join_compact_layout,
+    "Store the tuples of a built hash join table grouped by bucket, without per-tuple chain pointers and hashes "
+    "(default: true)",
+    true,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int(
+    max_parallel_queries,
+    "Number of queries that may run parallel steps at the same time, 0 for no limit (default: 0)",
+    0,
+    0,
+    1024,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int64(
+    query_memory_budget,
+    "Memory a query may allocate before its parallel steps run serially (bytes), 0 for no limit (default: 0)",
+    0,
+    0,
+    (int64_t{1} << 40) /* 1TB */,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int(
+    statement_timeout,
+    "Time a statement may execute before it is canceled (ms), 0 for no limit (default: 0)",
+    0,
+    0,
+    INT32_MAX,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int(
+    analyze_sample_blocks,
+    "Number of blocks of a table that ANALYZE samples, 0 to read the whole table (default: 100)",
+    100,
+    0,
+    INT32_MAX,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_bool(
     counters_enable,
     "Whether to use counters (default: false)",
@@ -425,6 +821,74 @@ SETTING_int(
     noisepage::settings::Callbacks::NoOp
 )
 
+SETTING_int(
+    replication_quorum_size,
+    "Number of replicas that must receive the logs of a transaction before it commits on the primary. 0 waits for "
+    "every replica to apply them instead (default: 0)",
+    0,
+    0,
+    64,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_bool(
+    replication_checkpoint_catchup,
+    "Whether a replica loads the latest checkpoint of the primary before it replays logs (default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_string(
+    checkpoint_path,
+    "The directory of the checkpoints that the primary ships to replicas (default: ./checkpoints)",
+    "./checkpoints",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int(
+    recovery_replay_threads,
+    "Number of threads that replay committed transactions during recovery and on replicas (default: 1)",
+    1,
+    1,
+    64,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int(
+    replica_max_staleness,
+    "Time (in ms) that a transaction on a replica may lag behind the transactions it received from the primary, it "
+    "waits for them to be applied otherwise. -1 does not wait (default: -1)",
+    -1,
+    -1,
+    3600000,
+    true,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_string(
+    logical_decoding_subscriber,
+    "Name of a node in the replication hosts file that a replica streams the row changes it applies to, for change "
+    "data capture. Empty to disable (default: empty)",
+    "",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int(
+    logical_decoding_batch_size,
+    "Number of row changes after which a replica sends a batch of them to the logical decoding subscriber "
+    "(default: 1024)",
+    1024,
+    1,
+    1000000,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
 SETTING_string(
     replication_hosts_path,
     "The path to the hosts.conf file for replication (default: ./replication.config)",
@@ -474,4 +938,71 @@ SETTING_string(
     false,
     noisepage::settings::Callbacks::NoOp
 )
+
+SETTING_bool(
+    jit_perf_map,
+    "Write the functions compiled by LLVM to /tmp/perf-<pid>.map for perf to name them (default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+// Placement of the dedicated threads on CPUs
+SETTING_string(
+    thread_wal_cpus,
+    "The CPUs that the log serializer and disk log writer threads run on, like 0-3,8 or node1 (default: any)",
+    "",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_bool(
+    thread_wal_isolate,
+    "Keep every other thread, including the execution workers, off the thread_wal_cpus (default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_bool(
+    thread_wal_realtime,
+    "Run the log serializer and disk log writer threads with real-time priority, needs CAP_SYS_NICE (default: false)",
+    false,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_string(
+    thread_gc_cpus,
+    "The CPUs that the garbage collector thread runs on, like 0-3,8 or node1 (default: any)",
+    "",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_string(
+    thread_network_cpus,
+    "The CPUs that the connection dispatcher and handler threads run on, like 0-3,8 or node1 (default: any)",
+    "",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_string(
+    thread_background_cpus,
+    "The CPUs that the metrics, messenger and recovery threads run on, like 0-3,8 or node1 (default: any)",
+    "",
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
+
+SETTING_int(
+    sampling_profiler_hz,
+    "Samples per second of CPU time that attribute query CPU time to pipelines, 0 to disable (default: 0)",
+    0,
+    0,
+    10000,
+    false,
+    noisepage::settings::Callbacks::NoOp
+)
     // clang-format on
@@ -8,7 +8,7 @@
 
 #include "common/action_context.h"
 #include "common/error/exception.h"
-#include "common/shared_latch.h"
+#include "common/big_reader_latch.h"
 #include "gflags/gflags.h"
 #include "loggers/settings_logger.h"
 #include "settings/settings_param.h"
@@ -157,7 +157,8 @@ class SettingsManager {
   std::unordered_map<settings::Param, settings::ParamInfo> param_map_;
   std::unordered_map<std::string, settings::Param> param_name_map_;
 
-  common::SharedLatch latch_;
+  // Settings are read on every query, and rarely changed
+  common::BigReaderLatch latch_;
 
   void ValidateSetting(Param param, const parser::ConstantValueExpression &min_value,
                        const parser::ConstantValueExpression &max_value);
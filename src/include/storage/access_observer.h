@@ -18,11 +18,43 @@ class RawBlock;
 // (GC is still invoked less frequently), but at least it lowers the impact because the access observer
 // will not wait for some fixed number of invocations.
 #define COLD_DATA_EPOCH_THRESHOLD 10
+
+/**
+ * The knobs of the policy the AccessObserver freezes blocks by. A full block that has not been written to for long
+ * enough is weighed: freezing it pays off through the memory compaction reclaims and through scans reading it in
+ * place, and it costs when writes preempt it and make all the work go to waste. The write and scan frequencies of a
+ * block are measured per GC invocation, and decay over time.
+ *
+ * The defaults freeze a block that was written to once COLD_DATA_EPOCH_THRESHOLD GC invocations later.
+ */
+struct FreezePolicy {
+  /** Number of GC invocations without writes after which a block is considered for freezing */
+  uint64_t cold_epochs_ = COLD_DATA_EPOCH_THRESHOLD;
+  /** Fraction of the write and scan frequencies of a block that carries over into the next GC invocation */
+  double decay_ = 0.5;
+  /** Benefit of freezing any block, as its varlens are gathered into Arrow buffers */
+  double freeze_benefit_ = 1.0;
+  /** Additional benefit of freezing a block with no allocated slots, which scales with the fraction of empty slots */
+  double gap_benefit_ = 1.0;
+  /** Benefit of freezing a block per scan per GC invocation */
+  double scan_benefit_ = 0.1;
+  /** Cost of freezing a block per write per GC invocation */
+  double write_cost_ = 16.0;
+  /** Every preemption doubles the number of GC invocations a block has to go without writes, up to this many times */
+  uint32_t max_backoff_ = 6;
+  /** Number of GC invocations after which a preemption no longer backs off the block */
+  uint64_t preemption_memory_ = 1000;
+};
+
 /**
  * The access observer is attached to the storage engine's garbage collector in order to make decisions about
  * whether a block is cooling down from frequent access. Its observe methods are invoked from the garbage collector
  * when relavent events fire. It is then free to make a decision whether to send a block into the compactor's queue
- * to freeze asynchronously.
+ * to freeze asynchronously. @see FreezePolicy for how the decision is made.
+ *
+ * A block that is written to while hot after it was sent to the compactor was preempted: either the compaction failed,
+ * or a frozen block had to be thawed. The preemptions are counted in the block header, so that blocks that keep
+ * getting preempted are frozen less eagerly instead of thrashing between COOLING and HOT.
  *
  * Notice that although the observation step is light weight, it does happen on the garbage collection thread and thus
  * has some minor performance impact on GC and consequently the rest of the system. Care should be taken to not do
@@ -34,8 +66,10 @@ class AccessObserver {
   /**
    * Constructs a new AccessObserver that will send its observations to the given block compactor
    * @param compactor the compactor to use after identifying a cold block
+   * @param policy the knobs of the freezing policy
    */
-  explicit AccessObserver(BlockCompactor *compactor) : compactor_(compactor) {}
+  explicit AccessObserver(BlockCompactor *compactor, FreezePolicy policy = {})
+      : compactor_(compactor), policy_(policy) {}
 
   /**
    * Signals to the AccessObserver that a new GC run has begun. This is useful as a measurement of time to the
@@ -52,11 +86,22 @@ class AccessObserver {
   void ObserveWrite(RawBlock *block);
 
  private:
+  // What is known about a block that was written to and has not been sent to the compactor since
+  struct BlockTemperature {
+    uint64_t last_touched_;  // GC epoch of the last write
+    double writes_;          // writes per GC invocation, decayed
+    double scans_;           // scans per GC invocation, decayed
+  };
+
+  // Updates the frequencies of the block for a new GC invocation, and decides if it should be frozen
+  bool ShouldFreeze(RawBlock *block, BlockTemperature *temperature) const;
+
   uint64_t gc_epoch_ = 0;  // estimate time using the number of times GC has run
   // Here RawBlock * should suffice as a unique identifier of the block. Although a block can be
   // reused, that process should only be triggered through compaction, which happens only if the
   // reference to said block is identified as cold and leaves the table.
-  std::unordered_map<RawBlock *, uint64_t> last_touched_;
+  std::unordered_map<RawBlock *, BlockTemperature> last_touched_;
   BlockCompactor *compactor_;
+  const FreezePolicy policy_;
 };
 }  // namespace noisepage::storage
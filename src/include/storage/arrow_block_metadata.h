@@ -1,10 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <limits>
 #include <map>
 #include <unordered_set>
 #include <utility>
 
 #include "storage/block_layout.h"
+#include "storage/column_encoding.h"
 #include "storage/storage_defs.h"
 #include "storage/storage_util.h"
 
@@ -123,7 +126,8 @@ class ArrowVarlenColumn {
  * All columns has a type associated with it. Gathered varlen columns has an ArrowVarlenColumn. If the column
  * is dictionary-compressed, it has an ArrowVarlenColumn that is the dictionary, and an indices array that encodes
  * the values. Notice here that the meaning of the ArrowVarlenColumn is different for dictionary-encoded columns
- * and simple gathered columns.
+ * and simple gathered columns. A dictionary-compressed column additionally keeps the dictionary as VarlenEntrys
+ * pointing into the ArrowVarlenColumn, so that the execution engine can evaluate on the distinct values.
  */
 class ArrowColumnInfo {
  public:
@@ -137,8 +141,13 @@ class ArrowColumnInfo {
    * @param other the object to move from
    */
   ArrowColumnInfo(ArrowColumnInfo &&other) noexcept
-      : type_(other.type_), varlen_column_(std::move(other.varlen_column_)), indices_(other.indices_) {
+      : type_(other.type_),
+        varlen_column_(std::move(other.varlen_column_)),
+        indices_(other.indices_),
+        dictionary_(other.dictionary_),
+        encoded_(std::move(other.encoded_)) {
     other.indices_ = nullptr;
+    other.dictionary_ = nullptr;
   }
 
   /**
@@ -158,6 +167,10 @@ class ArrowColumnInfo {
       delete[] indices_;
       indices_ = other.indices_;
       other.indices_ = nullptr;
+      delete[] reinterpret_cast<byte *>(dictionary_);
+      dictionary_ = other.dictionary_;
+      other.dictionary_ = nullptr;
+      encoded_ = std::move(other.encoded_);
     }
     return *this;
   }
@@ -183,11 +196,31 @@ class ArrowColumnInfo {
   }
 
   /**
-   * Deallocates all associated buffers in the ArrowVarlenColumn
+   * Returns the dictionary as an array of VarlenEntrys, where entry i has the dictionary code i. This array is only
+   * meaningful if the column is dictionary compressed. Its size is equal to the number of words in the dictionary.
+   * @return the dictionary array
+   */
+  VarlenEntry *&Dictionary() {
+    NOISEPAGE_ASSERT(type_ == ArrowColumnType::DICTIONARY_COMPRESSED,
+                     "this array is only meaningful if the column is dicationary compressed");
+    return dictionary_;
+  }
+
+  /**
+   * Returns the encoded copy of the values of a fixed-length column, which is PLAIN unless the column was encoded when
+   * the block was last frozen. It is only meaningful while the block is frozen.
+   * @return the encoded column
+   */
+  EncodedColumn &Encoded() { return encoded_; }
+
+  /**
+   * Deallocates all associated buffers in the ArrowVarlenColumn, and the encoded column
    */
   void Deallocate() {
     delete[] indices_;
+    delete[] reinterpret_cast<byte *>(dictionary_);
     varlen_column_.Deallocate();
+    encoded_.Deallocate();
   }
 
  private:
@@ -197,7 +230,95 @@ class ArrowColumnInfo {
   ArrowColumnType type_;
   ArrowVarlenColumn varlen_column_;  // For varlen and dictionary
   // TODO(Tianyu): Add null bitmap
-  uint64_t *indices_ = nullptr;  // for dictionary
+  uint64_t *indices_ = nullptr;        // for dictionary
+  VarlenEntry *dictionary_ = nullptr;  // for dictionary
+  EncodedColumn encoded_;              // for fixed-length columns
+};
+
+/**
+ * Bounds of the values of a fixed-length column in a block, read as signed integers of the size of the attribute. The
+ * bounds of a block that is not frozen only ever widen, so they cover every value the block held since it was last
+ * frozen (or emptied) and are not tight. For a FROZEN block they are the exact bounds of its values.
+ */
+struct ColumnZone {
+  /** smallest value, or INT64_MAX if there is none */
+  std::atomic<int64_t> min_;
+  /** largest value, or INT64_MIN if there is none */
+  std::atomic<int64_t> max_;
+
+  /** Forget all values */
+  void Clear() {
+    min_.store(std::numeric_limits<int64_t>::max());
+    max_.store(std::numeric_limits<int64_t>::min());
+  }
+
+  /**
+   * Widens the bounds to cover the given value. Concurrent writers of the block may widen them at the same time.
+   * @param value the value
+   */
+  void Widen(const int64_t value) {
+    int64_t current = min_.load(std::memory_order_acquire);
+    while (value < current && !min_.compare_exchange_weak(current, value, std::memory_order_acq_rel)) {
+    }
+    current = max_.load(std::memory_order_acquire);
+    while (value > current && !max_.compare_exchange_weak(current, value, std::memory_order_acq_rel)) {
+    }
+  }
+
+  /**
+   * Replaces the bounds with tighter ones, while no one writes the block. Readers see bounds that cover the values of
+   * the block at every point in between, since the old bounds cover the new ones.
+   * @param min smallest value, or INT64_MAX if there is none
+   * @param max largest value, or INT64_MIN if there is none
+   */
+  void Tighten(const int64_t min, const int64_t max) {
+    min_.store(min, std::memory_order_release);
+    max_.store(max, std::memory_order_release);
+  }
+
+  /**
+   * @param min lower bound of a range, inclusive
+   * @param max upper bound of a range, inclusive
+   * @return false if no value the bounds cover lies in the range
+   */
+  bool Overlaps(const int64_t min, const int64_t max) const {
+    return min_.load(std::memory_order_acquire) <= max && max_.load(std::memory_order_acquire) >= min;
+  }
+
+  /**
+   * @param value pointer to a fixed-length attribute
+   * @param size size of the attribute, at most 8 bytes
+   * @return the attribute as a signed integer
+   */
+  static int64_t Read(const byte *const value, const uint8_t size) {
+    switch (size) {
+      case 1:
+        return *reinterpret_cast<const int8_t *>(value);
+      case 2:
+        return *reinterpret_cast<const int16_t *>(value);
+      case 4:
+        return *reinterpret_cast<const int32_t *>(value);
+      default:
+        return *reinterpret_cast<const int64_t *>(value);
+    }
+  }
+};
+
+/**
+ * How a block has been accessed lately, which the AccessObserver decides to freeze it by. The statistics start over
+ * whenever the block is initialized.
+ */
+struct BlockAccessStats {
+  /** Number of scans that read the block since the AccessObserver last looked at it */
+  std::atomic<uint32_t> num_scans_;
+  /** Number of writes to the block after it was sent to be frozen. Only accessed by the GC thread. */
+  uint32_t num_preemptions_;
+  /** GC invocation of the last preemption. Only accessed by the GC thread. */
+  uint64_t last_preemption_epoch_;
+  /** True if the block was sent to be frozen, and not preempted since. Only accessed by the GC thread. */
+  bool queued_;
+  /** Set by accesses to the block while it is frozen, and cleared by the clock hand of the BlockBufferManager */
+  std::atomic<bool> referenced_;
 };
 
 /**
@@ -219,7 +340,8 @@ class ArrowBlockMetadata {
    */
   static uint32_t Size(uint16_t num_cols) {
     return StorageUtil::PadUpToSize(sizeof(uint64_t), static_cast<uint32_t>(sizeof(uint32_t)) * (num_cols + 1)) +
-           num_cols * static_cast<uint32_t>(sizeof(ArrowColumnInfo));
+           num_cols * static_cast<uint32_t>(sizeof(ArrowColumnInfo) + sizeof(ColumnZone)) +
+           static_cast<uint32_t>(sizeof(BlockAccessStats));
   }
 
   /**
@@ -229,6 +351,7 @@ class ArrowBlockMetadata {
   void Initialize(uint16_t num_cols) {
     // Need to 0 out this block to make sure all the counts are 0 and all the pointers are nullptrs
     memset(this, 0, Size(num_cols));
+    for (uint16_t i = 0; i < num_cols; i++) Zones(num_cols)[i].Clear();
   }
 
   /**
@@ -280,9 +403,42 @@ class ArrowBlockMetadata {
     return reinterpret_cast<ArrowColumnInfo *>(null_count_end)[col_id.UnderlyingValue()];
   }
 
+  /**
+   * @param layout layout object of the Block
+   * @param col_id the column of interest, which must be fixed-length and at most 8 bytes large
+   * @return bounds of the values of the given column
+   */
+  ColumnZone &GetColumnZone(const BlockLayout &layout, col_id_t col_id) {
+    return Zones(layout.NumColumns())[col_id.UnderlyingValue()];
+  }
+
+  /**
+   * @param layout layout object of the Block
+   * @param col_id the column of interest, which must be fixed-length and at most 8 bytes large
+   * @return bounds of the values of the given column
+   */
+  const ColumnZone &GetColumnZone(const BlockLayout &layout, col_id_t col_id) const {
+    return const_cast<ArrowBlockMetadata *>(this)->Zones(layout.NumColumns())[col_id.UnderlyingValue()];
+  }
+
+  /**
+   * @param layout layout object of the Block
+   * @return access statistics of the block
+   */
+  BlockAccessStats &GetAccessStats(const BlockLayout &layout) {
+    return *reinterpret_cast<BlockAccessStats *>(Zones(layout.NumColumns()) + layout.NumColumns());
+  }
+
  private:
+  ColumnZone *Zones(const uint16_t num_cols) {
+    byte *null_count_end =
+        storage::StorageUtil::AlignedPtr(sizeof(uint64_t), varlen_content_ + sizeof(uint32_t) * num_cols);
+    return reinterpret_cast<ColumnZone *>(reinterpret_cast<ArrowColumnInfo *>(null_count_end) + num_cols);
+  }
+
   uint32_t num_records_;  // number of actual records
-  // null_count[num_cols] (32-bit) | padding up to 8 byte-aligned | arrow_varlen_buffers[num_cols] |
+  // null_count[num_cols] (32-bit) | padding up to 8 byte-aligned | arrow_varlen_buffers[num_cols] | zones[num_cols] |
+  // access_stats
   byte varlen_content_[];
 };
 }  // namespace noisepage::storage
@@ -3,18 +3,83 @@
 #include <flatbuffers/generated/Message_generated.h>
 #include <flatbuffers/generated/Schema_generated.h>
 
+#include <fstream>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "common/managed_pointer.h"
 #include "storage/arrow_block_metadata.h"
 #include "storage/data_table.h"
 #include "type/type_id.h"
 
 namespace flatbuf = org::apache::arrow::flatbuf;
 
+namespace noisepage::transaction {
+class TransactionContext;
+}  // namespace noisepage::transaction
+
 namespace noisepage::storage {
 
+/**
+ * Receives an Arrow IPC stream as it is produced by an ArrowSerializer. The buffers of a frozen block are handed to the
+ * sink straight from the block, so a sink must not hold on to them after Write returns.
+ */
+class ArrowIpcSink {
+ public:
+  virtual ~ArrowIpcSink() = default;
+
+  /**
+   * Appends bytes to the stream.
+   * @param src start of the bytes
+   * @param len number of bytes
+   */
+  virtual void Write(const char *src, size_t len) = 0;
+
+  /**
+   * Called after every complete message of the stream.
+   */
+  virtual void Flush() {}
+};
+
+/**
+ * Writes an Arrow IPC stream to an output file stream.
+ */
+class ArrowIpcFileSink : public ArrowIpcSink {
+ public:
+  /**
+   * @param outfile the stream to write to, which must outlive the sink
+   */
+  explicit ArrowIpcFileSink(std::ofstream *outfile) : outfile_(outfile) {}
+
+  void Write(const char *src, size_t len) override { outfile_->write(src, len); }
+
+  void Flush() override { outfile_->flush(); }
+
+ private:
+  std::ofstream *outfile_;
+};
+
+/**
+ * Writes an Arrow IPC stream to a file descriptor, e.g. a connected socket.
+ */
+class ArrowIpcFdSink : public ArrowIpcSink {
+ public:
+  /**
+   * @param fd the file descriptor to write to. It stays owned by the caller.
+   */
+  explicit ArrowIpcFdSink(int fd) : fd_(fd) {}
+
+  /**
+   * @throw runtime_error if the write fails
+   */
+  void Write(const char *src, size_t len) override;
+
+ private:
+  int fd_;
+};
+
 /**
  * An Arrow Serializer is an auxiliary object bound to a data table so that the in-memory blocks
  * which are organized in arrow format can be exported to external storage in arrow IPC format.
@@ -56,22 +121,43 @@ class ArrowSerializer {
    * block and is exactly the same concept as the Buffer above. Therefore, by parsing the metadata_flatbuffer, we can
    * pinpoint and read the corresponding data.
    *
+   * The stream ends with an end-of-stream marker. Every block is waited on until it is frozen.
+   *
    * @param file_name the file that the table will be exported to
    * @param col_types since in the data table level, we don't know the type of each column. We need to use this
    *        parameter that is provided to get the types of columns.
    */
   void ExportTable(const std::string &file_name, std::vector<noisepage::type::TypeId> *col_types);
 
+  /**
+   * Stream a table in the same Arrow IPC format into a sink, one record batch per block, without going through a file.
+   *
+   * A frozen block is exported in place: its null bitmaps, fixed-length columns, gathered varlens, dictionaries and
+   * dictionary indices are handed to the sink without being copied. A block that is not frozen is materialized with
+   * the given transaction instead, so the batch holds the tuples visible to it. Varlen columns of such a block are
+   * gathered, and are dictionary-encoded with one dictionary entry per row if the schema says so.
+   *
+   * @param sink the sink to write the stream to
+   * @param col_types types of the columns, as for the file export
+   * @param txn the transaction to materialize blocks that are not frozen with, or nullptr to wait for every block to
+   *        be frozen
+   */
+  void ExportTable(ArrowIpcSink *sink, std::vector<noisepage::type::TypeId> *col_types,
+                   common::ManagedPointer<transaction::TransactionContext> txn = nullptr);
+
  private:
+  // A buffer of a message body, which is padded to arrow alignment when written
+  using BodyBuffer = std::pair<const char *, size_t>;
+
   const DataTable &data_table_;
   /**
-   * WriteDataBlock write a memory block to file. Such a memory block can be: offsets of varlen column,
+   * WriteDataBlock write a memory block to the stream. Such a memory block can be: offsets of varlen column,
    * data of a fixed-size column, bitmap of a column, etc.
-   * @param outfile the output file
+   * @param sink the output stream
    * @param src the memory block
-   * @param len the size, will be padded to arrow alignment according to the specification
+   * @param len the size, will be padded with zeros to arrow alignment according to the specification
    */
-  void WriteDataBlock(std::ofstream &outfile, const char *src, size_t len);
+  void WriteDataBlock(ArrowIpcSink *sink, const char *src, size_t len);
 
   /**
    * AddBufferInfo adds a buffer info to the buffers array. A buffer is a continuous memory region defined by its
@@ -84,21 +170,21 @@ class ArrowSerializer {
   void AddBufferInfo(size_t *offset, size_t len, std::vector<flatbuf::Buffer> *buffers);
 
   /**
-   * Build the metadata_flatbuffer from all its components and export it to the file.
-   * @param outfile the output file
+   * Build the metadata_flatbuffer from all its components and export it to the stream.
+   * @param sink the output stream
    * @param header_type one of MessageHeader_Schema, MessageHeader_RecordBatch, or MessageHeader_DictionaryBatch
    * @param header the auto-generated offset of the header
    * @param body_len the length of follwoing message body (not the length of this metadata_flatbuffer)
    * @param flatbuf_builder flatbuffer builder
    */
-  void AssembleMetadataBuffer(std::ofstream &outfile, flatbuf::MessageHeader header_type,
+  void AssembleMetadataBuffer(ArrowIpcSink *sink, flatbuf::MessageHeader header_type,
                               flatbuffers::Offset<void> header, int64_t body_len,
                               flatbuffers::FlatBufferBuilder *flatbuf_builder);
 
   /**
    * This function write a Schema message. The Schema message provides metadata describing the following RecordBatch
    * messages (you may think of it as a batch of rows), which includes but not limited to the logical type of each
-   * column, the byte-width, etc. It's serialized via Flatbuffer and should be written to the file at the very
+   * column, the byte-width, etc. It's serialized via Flatbuffer and should be written to the stream at the very
    * beginning.
    *
    * For the detailed definition of Schema message and RecordBatch message, please refer to:
@@ -107,13 +193,13 @@ class ArrowSerializer {
    * For the flatbuffer schema of Schema message, please refer to:
    *    https://github.com/apache/arrow/blob/master/format/Schema.fbs
    *
-   * @param outfile the output file
+   * @param sink the output stream
    * @param dictionary_ids The dictionary entries and the indices for a batch of rows are written seperately.
    *                       Therefore, when a column is dictionary-compressed, we need to assign an id to it,
    *                       so that the dictionary and the indices can be paired.
    * @param flatbuf_builder flatbuffer builder
    */
-  void WriteSchemaMessage(std::ofstream &outfile, std::unordered_map<col_id_t, int64_t> *dictionary_ids,
+  void WriteSchemaMessage(ArrowIpcSink *sink, std::unordered_map<col_id_t, int64_t> *dictionary_ids,
                           std::vector<type::TypeId> *col_types, flatbuffers::FlatBufferBuilder *flatbuf_builder);
 
   /**
@@ -126,12 +212,53 @@ class ArrowSerializer {
    * For the flatbuffer schema of Dictionary message, please refer to:
    *    https://github.com/apache/arrow/blob/master/format/Message.fbs
    *
-   * @param outfile the output file
+   * @param sink the output stream
    * @param dictionary_id id of this dictionary, should have been assigned previously when writing the schema message.
-   * @param varlen_col varlen_col stores the dictionray for a dictionary compressed column
+   * @param offsets offsets of the dictionary entries, one more than there are entries
+   * @param offsets_length number of offsets
+   * @param values the dictionary entries
+   * @param values_length length of the dictionary entries in bytes
+   * @param flatbuf_builder flatbuffer builder
+   */
+  void WriteDictionaryMessage(ArrowIpcSink *sink, int64_t dictionary_id, const uint64_t *offsets,
+                              uint32_t offsets_length, const byte *values, uint32_t values_length,
+                              flatbuffers::FlatBufferBuilder *flatbuf_builder);
+
+  /**
+   * Write a RecordBatch message and its body.
+   * @param sink the output stream
+   * @param num_rows number of rows in the batch
+   * @param field_nodes length and null count of each column
+   * @param body buffers of all columns, in order
+   * @param flatbuf_builder flatbuffer builder
+   */
+  void WriteRecordBatchMessage(ArrowIpcSink *sink, uint32_t num_rows,
+                               const std::vector<flatbuf::FieldNode> &field_nodes, const std::vector<BodyBuffer> &body,
+                               flatbuffers::FlatBufferBuilder *flatbuf_builder);
+
+  /**
+   * Export a frozen block in place. Requires an in-place read on the block.
+   * @param sink the output stream
+   * @param block the block to export
+   * @param dictionary_ids ids of the dictionaries, as assigned by the schema message
+   * @param flatbuf_builder flatbuffer builder
+   */
+  void WriteFrozenBlock(ArrowIpcSink *sink, RawBlock *block, std::unordered_map<col_id_t, int64_t> *dictionary_ids,
+                        flatbuffers::FlatBufferBuilder *flatbuf_builder);
+
+  /**
+   * Export the tuples of a block that are visible to a transaction, encoding the columns as the schema says.
+   * @param sink the output stream
+   * @param block the block to export
+   * @param txn the transaction to read the tuples with
+   * @param export_types how each column is encoded, as decided by the schema message
+   * @param dictionary_ids ids of the dictionaries, as assigned by the schema message
    * @param flatbuf_builder flatbuffer builder
    */
-  void WriteDictionaryMessage(std::ofstream &outfile, int64_t dictionary_id, const ArrowVarlenColumn &varlen_col,
+  void WriteMaterializedBlock(ArrowIpcSink *sink, RawBlock *block,
+                              common::ManagedPointer<transaction::TransactionContext> txn,
+                              const std::vector<ArrowColumnType> &export_types,
+                              std::unordered_map<col_id_t, int64_t> *dictionary_ids,
                               flatbuffers::FlatBufferBuilder *flatbuf_builder);
 };
 }  // namespace noisepage::storage
@@ -4,6 +4,7 @@
 
 #include <atomic>
 #include <cstring>
+#include <thread>  // NOLINT
 #include <utility>
 
 #include "common/macros.h"
@@ -35,7 +36,22 @@ enum class BlockState : uint32_t {
    * This block is fully Arrow-compatible, and can be read in-place by readers. Transactions need to wait
    * for active readers to finish and flip block status back to hot before proceeding.
    */
-  FROZEN
+  FROZEN,
+  /**
+   * This block is frozen and marked for eviction by the BlockBufferManager, which evicts it once no running transaction
+   * can be reading it anymore. Any access cancels the eviction by flipping the block status back to frozen.
+   */
+  EVICTING,
+  /**
+   * The BlockBufferManager is writing this block out to disk or reading it back in. Accessors need to wait until the
+   * block is either evicted or frozen again.
+   */
+  PAGING,
+  /**
+   * The contents of this block past its header are on disk and their memory is returned to the system. Accessors
+   * need to fault the block back in through the BlockBufferManager, which makes it frozen again.
+   */
+  EVICTED
 };
 
 // TODO(Tianyu): I need a better name for this...
@@ -90,15 +106,25 @@ class BlockAccessController {
   }
 
   /**
-   * blocks until all in-place readers have left to be able to perform in-place modifications.
+   * blocks until all in-place readers have left to be able to perform in-place modifications. An evicted block needs to
+   * be faulted back in before.
+   * @return false if the block was evicted, in which case it needs to be faulted back in before trying again
    */
-  void WaitUntilHot() {
+  bool WaitUntilHot() {
     while (true) {
       BlockState current_state = GetBlockState()->load();
       switch (current_state) {
         case BlockState::FREEZING:
           continue;  // Wait until the compactor finishes before doing anything
+        case BlockState::PAGING:
+          // Wait until the block is either written out or read back in
+          std::this_thread::yield();
+          continue;
+        case BlockState::EVICTED:
+          return false;
         case BlockState::COOLING:
+        case BlockState::EVICTING:
+          // Preempts the compactor or the eviction
           if (!GetBlockState()->compare_exchange_strong(current_state, BlockState::HOT)) continue;
           // wait until the compactor finishes before doing anything
           // intentional fall through
@@ -108,11 +134,10 @@ class BlockAccessController {
         case BlockState::HOT:
           // Although the block is already hot, we may need to wait for any straggling readers to finish
           while (GetReaderCount()->load() != 0) _mm_pause();
-          break;
+          return true;
         default:
           throw std::runtime_error("unexpected control flow");
       }
-      break;
     }
   }
 
@@ -123,6 +148,7 @@ class BlockAccessController {
 
  private:
   friend class BlockCompactor;
+  friend class BlockBufferManager;
   // we are breaking this down to two fields, (| BlockState (32-bits) | Reader Count (32-bits) |)
   // but may need to compare and swap on the two together sometimes
   byte bytes_[sizeof(uint64_t)];
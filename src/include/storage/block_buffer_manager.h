@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+#include "common/spin_latch.h"
+
+namespace noisepage::transaction {
+class DeferredActionManager;
+}  // namespace noisepage::transaction
+
+namespace noisepage::storage {
+class DataTable;
+class RawBlock;
+
+/**
+ * The block buffer manager keeps the memory used by the blocks of its tables under a budget, by evicting FROZEN blocks
+ * to a block file on disk and faulting them back in when they are accessed again.
+ *
+ * Blocks are chosen with the CLOCK algorithm. Every access to a frozen block sets its reference bit in the block
+ * header, and the clock hand clears it, so that only blocks that went a full turn of the hand without being accessed
+ * are evicted. An evicted block keeps its address, so the TupleSlots that indexes and version chains hold stay valid.
+ * Only the contents past its header are written out, and their memory is returned to the system. The header stays
+ * in memory, so the zone maps of an evicted block still let scans skip it without faulting it in.
+ *
+ * Transactional readers do not latch a frozen block. Eviction is therefore done in two steps. A block is first marked
+ * EVICTING, which any access cancels, and is written out by a deferred action once no transaction that could have
+ * started reading it before it was marked is running anymore.
+ *
+ * Arrow buffers of gathered varlens, dictionaries and encoded columns are allocated outside the block and are not
+ * evicted.
+ */
+class BlockBufferManager {
+ public:
+  /**
+   * Creates the block file, replacing any file at the path.
+   * @param path path of the block file
+   * @param memory_budget number of bytes the blocks of the registered tables may take up in memory
+   * @param deferred_action_manager deferred action manager to wait for running transactions with
+   * @throw runtime_error if the block file cannot be created
+   */
+  BlockBufferManager(std::string path, uint64_t memory_budget,
+                     common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager);
+
+  /**
+   * Closes and removes the block file. All registered tables need to be destroyed or unregistered before, and the
+   * deferred actions of all evictions need to have run.
+   */
+  ~BlockBufferManager();
+
+  DISALLOW_COPY_AND_MOVE(BlockBufferManager)
+
+  /**
+   * Starts managing the blocks of a table. A table can only be registered with one buffer manager.
+   * @param table the table
+   */
+  void RegisterTable(DataTable *table);
+
+  /**
+   * Stops managing the blocks of a table and forgets about their copies in the block file. Evicted blocks of the table
+   * are not faulted back in, so the table may only be destroyed afterwards. This is called by the table's destructor.
+   * @param table a registered table
+   */
+  void UnregisterTable(DataTable *table);
+
+  /**
+   * Moves the clock hand until enough frozen blocks are marked for eviction to fit the blocks of all registered tables
+   * into the memory budget, or until a full turn of the hand found no more blocks to evict. The marked blocks are
+   * evicted by deferred actions, once no running transaction can be reading them.
+   * @return number of blocks marked for eviction
+   */
+  uint32_t EvictColdBlocks();
+
+  /**
+   * Brings an evicted block back into memory, cancels its eviction if it was only marked, or waits for it to be written
+   * out first if that is in progress. On return, the block is resident until it is marked for eviction again.
+   * @param block a block of a registered table
+   */
+  void Fault(RawBlock *block);
+
+  /**
+   * @param memory_budget number of bytes the blocks of the registered tables may take up in memory
+   */
+  void SetMemoryBudget(uint64_t memory_budget) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    memory_budget_ = memory_budget;
+  }
+
+  /**
+   * @return number of bytes the blocks of the registered tables may take up in memory
+   */
+  uint64_t GetMemoryBudget() const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return memory_budget_;
+  }
+
+  /**
+   * @return number of blocks of the registered tables that are evicted
+   */
+  uint64_t NumEvictedBlocks() const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return num_evicted_;
+  }
+
+ private:
+  static constexpr uint64_t NO_FILE_SLOT = UINT64_MAX;
+
+  // What the manager knows about a frozen block it came across
+  struct Frame {
+    DataTable *table_;
+    // Slot of the block in the block file, where it is written every time it is evicted
+    uint64_t file_slot_ = NO_FILE_SLOT;
+    // Tells the deferred action of an eviction apart from later evictions of the same block
+    uint64_t eviction_id_ = 0;
+    // Set while the block is written out or read back, which the table has to wait for before it can be destroyed
+    bool paging_ = false;
+  };
+
+  // Forgets about the blocks of the table, unless some of them are written out or read back right now
+  bool TryUnregisterTable(DataTable *table);
+
+  // Marks a frozen block that no one reads in place for eviction. Requires the latch.
+  bool TryMarkForEviction(RawBlock *block, Frame *frame);
+
+  // Writes out a block marked by the eviction with the given id, unless the eviction was cancelled since
+  void FinishEviction(RawBlock *block, uint64_t eviction_id);
+
+  // Reads back an evicted block whose status this thread flipped to PAGING
+  void ReadBack(RawBlock *block);
+
+  // Returns a free file slot or a new one. Requires the latch.
+  uint64_t AllocateFileSlot();
+
+  const std::string path_;
+  const int fd_;
+  const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager_;
+
+  mutable common::SpinLatch latch_;
+  uint64_t memory_budget_;
+  std::unordered_set<DataTable *> tables_;
+  std::unordered_map<RawBlock *, Frame> frames_;
+  // The blocks the clock hand goes around, in the order they were first seen frozen
+  std::vector<RawBlock *> clock_;
+  uint64_t clock_hand_ = 0;
+  uint64_t next_eviction_id_ = 0;
+  uint64_t num_evicted_ = 0;
+  uint64_t num_file_slots_ = 0;
+  std::vector<uint64_t> free_file_slots_;
+};
+
+}  // namespace noisepage::storage
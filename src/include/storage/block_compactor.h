@@ -1,9 +1,12 @@
 #pragma once
+#include <memory>
 #include <queue>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "common/spin_latch.h"
+#include "common/worker_pool.h"
 #include "storage/arrow_block_metadata.h"
 #include "storage/data_table.h"
 #include "storage/storage_defs.h"
@@ -22,6 +25,11 @@ using VarlenEntryMap = std::unordered_map<VarlenEntry, T, VarlenContentHasher, V
  * arrow-compatible. In the process, any gaps resulting from deletes or aborted transactions are also eliminated.
  * If the compaction is successful, the block is considered to be fully cold and will be accessed mostly as read-only
  * data.
+ *
+ * Every block is compacted in its own compaction group, so the groups of one pass are independent of each other. With
+ * a pool of compaction workers, they are processed concurrently. A cooling block that cannot be gathered yet, because
+ * the GC has not pruned its versions, is parked in the queue and resumed in a later pass instead of holding up the
+ * pass.
  */
 class BlockCompactor {
  private:
@@ -50,12 +58,26 @@ class BlockCompactor {
   };
 
  public:
+  /**
+   * Constructs a new block compactor.
+   * @param num_workers number of compaction workers that process the groups of a pass concurrently, or 0 to process
+   *                    them on the calling thread
+   */
+  explicit BlockCompactor(uint32_t num_workers = 0) {
+    if (num_workers == 0) return;
+    workers_ = std::make_unique<common::WorkerPool>(num_workers, common::TaskQueue());
+    workers_->Startup();
+  }
+
   FAKED_IN_TEST ~BlockCompactor() = default;
 
+  DISALLOW_COPY_AND_MOVE(BlockCompactor)
+
   /**
    * Processes the compaction queue and mark processed blocks as cold if successful. The compaction can fail due
    * to live versions or contention. There will be a brief window where user transactions writing to the block
-   * can be aborted, but no readers would be blocked.
+   * can be aborted, but no readers would be blocked. Returns once all blocks taken from the queue were processed or
+   * parked for the next pass. Only one pass may run at a time.
    */
   void ProcessCompactionQueue(transaction::DeferredActionManager *deferred_action_manager,
                               transaction::TransactionManager *txn_manager);
@@ -64,9 +86,21 @@ class BlockCompactor {
    * Adds a block associated with a data table to the compaction to be processed in the future.
    * @param block the block that needs to be processed by the compactor
    */
-  FAKED_IN_TEST void PutInQueue(RawBlock *block) { compaction_queue_.push(block); }
+  FAKED_IN_TEST void PutInQueue(RawBlock *block) {
+    common::SpinLatch::ScopedSpinLatch guard(&queue_latch_);
+    compaction_queue_.push(block);
+  }
+
+  /**
+   * @return number of compaction workers, 0 if blocks are processed on the thread calling ProcessCompactionQueue
+   */
+  uint32_t NumWorkers() const { return workers_ == nullptr ? 0 : workers_->NumWorkers(); }
 
  private:
+  // Performs the next compaction step of a block, depending on its state
+  void ProcessBlock(RawBlock *block, transaction::DeferredActionManager *deferred_action_manager,
+                    transaction::TransactionManager *txn_manager);
+
   bool EliminateGaps(CompactionGroup *cg);
 
   bool CheckForVersionsAndGaps(const TupleAccessStrategy &accessor, RawBlock *block);
@@ -77,10 +111,12 @@ class BlockCompactor {
   void GatherVarlens(std::vector<const byte *> *loose_ptrs, RawBlock *block, DataTable *table);
 
   void CopyToArrowVarlen(std::vector<const byte *> *loose_ptrs, ArrowBlockMetadata *metadata, col_id_t col_id,
-                         common::RawConcurrentBitmap *column_bitmap, ArrowColumnInfo *col, VarlenEntry *values);
+                         common::RawConcurrentBitmap *column_bitmap, ArrowColumnInfo *col, byte *values,
+                         uint16_t stride);
 
   void BuildDictionary(std::vector<const byte *> *loose_ptrs, ArrowBlockMetadata *metadata, col_id_t col_id,
-                       common::RawConcurrentBitmap *column_bitmap, ArrowColumnInfo *col, VarlenEntry *values);
+                       common::RawConcurrentBitmap *column_bitmap, ArrowColumnInfo *col, byte *values,
+                       uint16_t stride);
 
   void ComputeFilled(const BlockLayout &layout, std::vector<uint32_t> *filled, const std::vector<uint32_t> &empty) {
     // Reconstruct the list of filled slots
@@ -95,6 +131,10 @@ class BlockCompactor {
     }
   }
 
+  // PutInQueue is called by the GC thread and by the compaction workers, while a pass may be running on another thread
+  common::SpinLatch queue_latch_;
   std::queue<RawBlock *> compaction_queue_;
+  // nullptr if blocks are processed on the calling thread
+  std::unique_ptr<common::WorkerPool> workers_;
 };
 }  // namespace noisepage::storage
@@ -29,6 +29,19 @@ class BlockLayout {
    */
   explicit BlockLayout(std::vector<uint16_t> attr_sizes);
 
+  /**
+   * Constructs a new block layout that stores some of its columns row-wise, in groups. The values of all columns of a
+   * group are stored together for every tuple, so a tuple touches one cache line per group instead of one per column.
+   * Columns that are in no group are stored in columns of their own, as in a purely columnar layout.
+   *
+   * @warning Column ids are reordered the same way as with the other constructor, and the groups refer to the
+   * reordered ids. The reserved columns cannot be in a group.
+   *
+   * @param attr_sizes vector of attribute sizes.
+   * @param column_groups columns to store together, each group having at least two of them
+   */
+  BlockLayout(std::vector<uint16_t> attr_sizes, std::vector<std::vector<col_id_t>> column_groups);
+
   /**
    * @return number of columns.
    *
@@ -50,6 +63,37 @@ class BlockLayout {
    */
   bool IsVarlen(col_id_t col_id) const { return static_cast<int16_t>(attr_sizes_.at(col_id.UnderlyingValue())) < 0; }
 
+  /**
+   * @param col_id the column id to check for
+   * @return distance, in bytes, between the values of the column of two consecutive slots. It is the attribute size
+   * for columns that are stored on their own, and the padded size of a row of the group otherwise.
+   */
+  uint16_t AttrStride(col_id_t col_id) const { return attr_strides_.at(col_id.UnderlyingValue()); }
+
+  /**
+   * @param col_id the column id to check for
+   * @return offset, in bytes, of the column's value within a row of its group
+   */
+  uint16_t AttrGroupOffset(col_id_t col_id) const { return attr_group_offsets_.at(col_id.UnderlyingValue()); }
+
+  /**
+   * @param col_id the column id to check for
+   * @return index of the group of the column within ColumnGroups()
+   */
+  uint16_t ColumnGroup(col_id_t col_id) const { return attr_groups_.at(col_id.UnderlyingValue()); }
+
+  /**
+   * @param col_id the column id to check for
+   * @return whether the values of the column are stored contiguously, with nothing in between
+   */
+  bool IsColumnar(col_id_t col_id) const { return column_groups_[ColumnGroup(col_id)].size() == 1; }
+
+  /**
+   * @return the groups of columns in the order they are laid out within a block, columns that are stored on their own
+   * forming a group each. Every group lists its columns in ascending order, which is the order within a row.
+   */
+  const std::vector<std::vector<col_id_t>> &ColumnGroups() const { return column_groups_; }
+
   /**
    * @return all the varlen columns in the layout
    */
@@ -86,6 +130,11 @@ class BlockLayout {
   std::vector<uint16_t> attr_sizes_;
   // keeps track of all the varlens to make iteration through all varlen columns faster
   std::vector<col_id_t> varlens_;
+  // All columns grouped the way they are laid out, and the group, stride and offset within the group of every column
+  std::vector<std::vector<col_id_t>> column_groups_;
+  std::vector<uint16_t> attr_groups_;
+  std::vector<uint16_t> attr_strides_;
+  std::vector<uint16_t> attr_group_offsets_;
   // These fields below should be declared const but then that deletes the assignment operator for BlockLayout. With
   // const-only accessors we should be safe from making changes to a BlockLayout that would break stuff.
 
@@ -100,6 +149,7 @@ class BlockLayout {
   uint32_t ComputeTupleSize() const;
   // static header is the size of header that does not depend on the number of slots in the block
   uint32_t ComputeStaticHeaderSize() const;
+  void ComputeColumnGroups(std::vector<std::vector<col_id_t>> column_groups);
   uint32_t ComputeNumSlots() const;
   uint32_t ComputeHeaderSize() const;
 };
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstdint>
+#include <queue>
+#include <vector>
+
+#include "common/constants.h"
+#include "common/macros.h"
+#include "common/object_pool.h"
+#include "common/spin_latch.h"
+
+namespace noisepage::storage {
+
+class RawBlock;
+
+/**
+ * A block store is essentially an object pool of blocks. All blocks should be aligned, so we will need to use the
+ * default constructor instead of raw malloc.
+ *
+ * On a machine with several NUMA nodes, the store keeps a separate pool of reusable blocks for every node. A block is
+ * handed out from the pool of the node the calling thread runs on and its memory is placed on that node, so that the
+ * thread that fills a block, and the threads of parallel scans running on the same node, access local memory. A node
+ * whose pool ran dry only takes a reusable block of another node once the size limit does not allow allocating a new
+ * one. The size and reuse limits apply to all nodes together.
+ *
+ * Optionally, blocks are carved out of an arena of huge pages that is reserved up front for as many blocks as the size
+ * limit allows. Scans over many blocks then need far fewer TLB entries. The arena is backed by pages of the kernel's
+ * default huge page size (2 MB, or 1 GB if the system is configured with default_hugepagesz=1G) if the huge page pool
+ * can reserve all of it, and by transparent huge pages otherwise. Memory of the arena is only returned to the system
+ * when the store is destroyed, so blocks handed out by it must not outlive the store.
+ */
+class BlockStore {
+ public:
+  /**
+   * Initializes a new block store.
+   * @param size_limit the maximum number of blocks the store may hand out
+   * @param reuse_limit the maximum number of released blocks the store keeps around for reuse
+   * @param huge_pages whether to allocate blocks from an arena of huge pages
+   */
+  BlockStore(uint64_t size_limit, uint64_t reuse_limit, bool huge_pages = false);
+
+  /**
+   * Destructs the store and frees all reusable blocks. Blocks that were handed out and never released are not freed,
+   * unless they belong to the huge page arena.
+   */
+  ~BlockStore();
+
+  DISALLOW_COPY_AND_MOVE(BlockStore)
+
+  /**
+   * Returns a block that is placed on the NUMA node of the calling thread, if possible.
+   * @throw NoMoreObjectException if the store has reached the limit of how many blocks it may hand out.
+   * @throw AllocatorFailureException if the system fails to allocate memory for a new block.
+   * @return pointer to the block
+   */
+  RawBlock *Get() { return Get(CurrentNode()); }
+
+  /**
+   * Returns a block that is placed on the given NUMA node, if possible.
+   * @param node the NUMA node to place the block on
+   * @throw NoMoreObjectException if the store has reached the limit of how many blocks it may hand out.
+   * @throw AllocatorFailureException if the system fails to allocate memory for a new block.
+   * @return pointer to the block
+   */
+  RawBlock *Get(uint16_t node);
+
+  /**
+   * Releases the given block, allowing it to be freed or reused for later. It will be unsafe to access after entering
+   * this call.
+   * @param block pointer to the block to release
+   */
+  void Release(RawBlock *block);
+
+  /**
+   * Set the store's size limit. The operation fails if the store has already allocated more blocks than the new limit.
+   * @param new_size the new size limit
+   * @return true if new_size is successfully set and false if the operation fails
+   */
+  bool SetSizeLimit(uint64_t new_size);
+
+  /**
+   * Set the reuse limit to a new value, freeing reusable blocks above the limit. This function always succeeds.
+   * @param new_reuse_limit the new reuse limit
+   */
+  void SetReuseLimit(uint64_t new_reuse_limit);
+
+  /**
+   * @return size limit of the store
+   */
+  uint64_t GetSizeLimit() const { return size_limit_; }
+
+  /**
+   * @return true if some blocks of this store are allocated from an arena of huge pages
+   */
+  bool UsesHugePages() const { return arena_ != nullptr; }
+
+  /**
+   * @return number of NUMA nodes of this machine, 1 if it has none or they cannot be determined
+   */
+  static uint16_t NumNodes();
+
+  /**
+   * @return NUMA node of the CPU the calling thread currently runs on
+   */
+  static uint16_t CurrentNode();
+
+  /**
+   * @param block a block handed out by a BlockStore
+   * @return NUMA node the block was placed on
+   */
+  static uint16_t NodeOf(const RawBlock *block);
+
+ private:
+  // Blocks are aligned to their size, and transparent huge pages need an aligned range
+  static constexpr uint64_t ARENA_ALIGNMENT = 2 * common::Constants::BLOCK_SIZE;
+
+  // Reserves the huge page arena, or leaves it disabled if neither kind of huge page is available
+  void ReserveArena(uint64_t num_blocks);
+
+  // Allocates a new block on the given node, or returns nullptr if the system is out of memory. Requires the latch.
+  RawBlock *Allocate(uint16_t node);
+  // Requires the latch
+  void Free(RawBlock *block);
+
+  bool InArena(const RawBlock *block) const {
+    const auto *const address = reinterpret_cast<const byte *>(block);
+    return arena_ != nullptr && address >= arena_ && address < arena_ + arena_capacity_ * common::Constants::BLOCK_SIZE;
+  }
+
+  // Takes one reusable block, preferring the given node's pool, or returns nullptr if all pools are empty. Requires
+  // the latch.
+  RawBlock *TakeReusable(uint16_t preferred_node);
+
+  common::SpinLatch latch_;
+  // One pool of reusable blocks for each NUMA node
+  std::vector<std::queue<RawBlock *>> reuse_queues_;
+  uint64_t size_limit_;   // the maximum number of blocks the store can have
+  uint64_t reuse_limit_;  // the maximum number of reusable blocks in all reuse queues
+  // current_size_ represents the number of blocks the store has allocated, including blocks that have been given out
+  // to callers and those that reside in reuse queues
+  uint64_t current_size_ = 0;
+  uint64_t num_reusable_ = 0;
+
+  // Huge page arena, nullptr if disabled. Blocks are carved out of it in order, and freed blocks are kept for later.
+  byte *arena_ = nullptr;
+  void *arena_mapping_ = nullptr;
+  uint64_t arena_mapping_size_ = 0;
+  uint64_t arena_capacity_ = 0;
+  uint64_t arena_next_ = 0;
+  std::vector<RawBlock *> arena_free_;
+};
+
+}  // namespace noisepage::storage
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/managed_pointer.h"
+#include "storage/projected_row.h"
+#include "storage/storage_defs.h"
+
+namespace noisepage::catalog {
+class IndexSchema;
+class Schema;
+}  // namespace noisepage::catalog
+
+namespace noisepage::transaction {
+class TransactionContext;
+}  // namespace noisepage::transaction
+
+namespace noisepage::storage {
+
+class RedoRecord;
+class SqlTable;
+
+namespace index {
+class Index;
+}  // namespace index
+
+/**
+ * Inserts a stream of rows into a table and its indexes within one transaction, the way COPY FROM ingests data.
+ *
+ * Each row is staged, filled in by the caller and inserted into the table right away. The keys of unique indexes are
+ * inserted right away too, since a duplicate has to fail the row that caused it. The keys of the other indexes are
+ * buffered and inserted in batches, which indexes that support it sort so that neighbouring keys share one traversal.
+ * Only indexes whose keys are plain columns of the table and that cover every row are supported, see SupportsIndex.
+ */
+class BulkLoader {
+ public:
+  /**
+   * Number of keys buffered for an index before they are inserted into it.
+   */
+  static constexpr uint32_t INDEX_BATCH_SIZE = 4096;
+
+  /**
+   * The loader copies the values of columns into keys and does not evaluate expressions, so it cannot maintain
+   * expression keys or the predicates of partial indexes.
+   * @param index_schema key schema of an index
+   * @return true if the loader can maintain the index
+   */
+  static bool SupportsIndex(const catalog::IndexSchema &index_schema);
+
+  /**
+   * Creates a loader for a table
+   * @param txn transaction the rows are inserted in
+   * @param db_oid database of the table
+   * @param table_oid the table
+   * @param table the storage of the table
+   * @param schema schema of the table. Staged rows have an attribute for every one of its columns.
+   * @param indexes the indexes of the table along with their key schemas, which have to be supported
+   */
+  BulkLoader(common::ManagedPointer<transaction::TransactionContext> txn, catalog::db_oid_t db_oid,
+             catalog::table_oid_t table_oid, common::ManagedPointer<SqlTable> table, const catalog::Schema &schema,
+             const std::vector<std::pair<common::ManagedPointer<index::Index>, const catalog::IndexSchema &>> &indexes);
+
+  /**
+   * Stages the next row. Staged rows are written to the log, so once a row is staged, the transaction has to abort
+   * unless the row is inserted.
+   * @return the row to fill in. It stays valid until the next call.
+   */
+  ProjectedRow *StageRow();
+
+  /**
+   * @param col position of a column in the schema of the table
+   * @return offset of the attribute of the column in staged rows
+   */
+  uint16_t ColumnOffset(const uint32_t col) const { return column_offsets_[col]; }
+
+  /**
+   * Inserts the staged row into the table and its indexes.
+   * @return false if the row has the key of another row in a unique index. The transaction has to abort then.
+   */
+  bool InsertRow();
+
+  /**
+   * Inserts the buffered keys into their indexes. Has to be called once all rows are inserted, before the transaction
+   * commits.
+   */
+  void Flush();
+
+  /**
+   * @return number of rows inserted so far
+   */
+  uint64_t NumRows() const { return num_rows_; }
+
+ private:
+  // Where the value of a key column comes from in staged rows
+  struct KeyColumn {
+    uint16_t key_offset_;
+    uint16_t row_offset_;
+    uint8_t size_;
+  };
+
+  struct IndexKeys {
+    common::ManagedPointer<index::Index> index_;
+    bool unique_;
+    std::vector<KeyColumn> columns_;
+    // Size of a key in words, so that keys can be laid out back to back
+    uint32_t key_words_;
+    // Buffered keys and the slots of their tuples
+    std::vector<uint64_t> keys_;
+    std::vector<TupleSlot> slots_;
+  };
+
+  // Copies the key of the staged row into the memory at dest
+  ProjectedRow *BuildKey(const IndexKeys &index_keys, uint64_t *dest) const;
+
+  void FlushIndex(IndexKeys *index_keys);
+
+  const common::ManagedPointer<transaction::TransactionContext> txn_;
+  const catalog::db_oid_t db_oid_;
+  const catalog::table_oid_t table_oid_;
+  const common::ManagedPointer<SqlTable> table_;
+  ProjectedRowInitializer initializer_;
+  std::vector<uint16_t> column_offsets_;
+  std::vector<IndexKeys> indexes_;
+  // Room for the key of a unique index
+  std::vector<uint64_t> unique_key_;
+  RedoRecord *redo_ = nullptr;
+  uint64_t num_rows_ = 0;
+};
+
+}  // namespace noisepage::storage
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/managed_pointer.h"
+#include "storage/projected_columns.h"
+#include "transaction/transaction_defs.h"
+
+namespace noisepage::catalog {
+class Catalog;
+}  // namespace noisepage::catalog
+
+namespace noisepage::transaction {
+class TransactionManager;
+}  // namespace noisepage::transaction
+
+namespace noisepage::storage {
+class BufferedLogWriter;
+class SqlTable;
+
+/**
+ * Describes a completed checkpoint on disk.
+ */
+struct CheckpointInfo {
+  /** Snapshot timestamp of the checkpoint. Transactions that committed before it are contained in the checkpoint. */
+  transaction::timestamp_t timestamp_;
+  /** Directory that contains one file per checkpointed table. */
+  std::string path_;
+  /** The tables contained in the checkpoint. */
+  std::vector<std::pair<catalog::db_oid_t, catalog::table_oid_t>> tables_;
+};
+
+/**
+ * The CheckpointManager takes fuzzy checkpoints of all user tables. A checkpoint is a consistent snapshot of every
+ * SqlTable as seen by a single snapshot transaction, so concurrent writers are never blocked. Each table is scanned one
+ * block at a time and written out as REDO records in the write-ahead log's serialization format, which allows the
+ * RecoveryManager to read a checkpoint back with a DiskLogProvider.
+ *
+ * On-disk layout:
+ *   <checkpoint_root>/checkpoint_<timestamp>/<db_oid>_<table_oid>.ckpt   one file per table
+ *   <checkpoint_root>/checkpoint_<timestamp>/MANIFEST                    written last, marks the checkpoint complete
+ *
+ * Only user tables are checkpointed. Catalog tables are still rebuilt from the WAL, which means that the WAL must
+ * continue to contain the DDL history. User table changes of transactions that committed before the checkpoint's
+ * timestamp are skipped during replay. @see RecoveryManager::SetCheckpoint
+ */
+class CheckpointManager {
+ public:
+  /** File name of the manifest that marks a checkpoint as complete. */
+  static constexpr const char *MANIFEST_FILE_NAME = "MANIFEST";
+
+  /**
+   * @param checkpoint_root directory that checkpoints are written to, created if it does not exist
+   * @param txn_manager transaction manager used to begin the snapshot transaction
+   * @param catalog catalog used to enumerate the tables to checkpoint
+   */
+  CheckpointManager(std::string checkpoint_root, common::ManagedPointer<transaction::TransactionManager> txn_manager,
+                    common::ManagedPointer<catalog::Catalog> catalog);
+
+  /**
+   * Take a checkpoint of all user tables. Concurrent transactions are not blocked.
+   * @return the snapshot timestamp of the checkpoint
+   */
+  transaction::timestamp_t TakeCheckpoint();
+
+  /**
+   * Remove every complete or partially written checkpoint older than the latest complete one.
+   */
+  void PurgeOldCheckpoints() const;
+
+  /** @return the latest complete checkpoint under checkpoint_root, or std::nullopt if there is none */
+  static std::optional<CheckpointInfo> GetLatestCheckpoint(const std::string &checkpoint_root);
+
+  /** @return the name of the checkpoint file for the given table */
+  static std::string TableFileName(catalog::db_oid_t db_oid, catalog::table_oid_t table_oid);
+
+  /** @return the directory of the checkpoint with the given snapshot timestamp under checkpoint_root */
+  static std::string CheckpointDirectory(const std::string &checkpoint_root, transaction::timestamp_t timestamp);
+
+  /**
+   * Mark a checkpoint complete once all of its table files are written, like a checkpoint shipped from another node.
+   * @param checkpoint_dir directory of the checkpoint, @see CheckpointDirectory
+   * @param timestamp snapshot timestamp of the checkpoint
+   * @param tables the tables contained in the checkpoint
+   */
+  static void WriteManifest(const std::string &checkpoint_dir, transaction::timestamp_t timestamp,
+                            const std::vector<std::pair<catalog::db_oid_t, catalog::table_oid_t>> &tables);
+
+  /** @return the root directory that checkpoints are written to */
+  const std::string &GetCheckpointRoot() const { return checkpoint_root_; }
+
+ private:
+  const std::string checkpoint_root_;
+  const common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  const common::ManagedPointer<catalog::Catalog> catalog_;
+
+  /**
+   * Write the contents of a table to the given file, one block-sized batch at a time.
+   * @param txn snapshot transaction
+   * @param db_oid database of the table
+   * @param table_oid oid of the table
+   * @param table table to write out
+   * @param file_path checkpoint file to write to
+   * @return number of tuples written
+   */
+  uint64_t CheckpointTable(common::ManagedPointer<transaction::TransactionContext> txn, catalog::db_oid_t db_oid,
+                           catalog::table_oid_t table_oid, common::ManagedPointer<SqlTable> table,
+                           const std::string &file_path);
+
+  /**
+   * Serialize a tuple as a REDO record. The format must match LogSerializerTask::SerializeRecord.
+   * @param compression_buffer scratch buffer for compressing large varlens
+   */
+  static void SerializeTuple(BufferedLogWriter *out, transaction::timestamp_t timestamp, catalog::db_oid_t db_oid,
+                             catalog::table_oid_t table_oid, uint32_t record_size, TupleSlot slot,
+                             const ProjectedColumns::RowView &row, std::vector<byte> *compression_buffer);
+
+  /** Write size bytes from val to the writer, flushing the writer whenever its buffer fills up. */
+  static void WriteValue(BufferedLogWriter *out, const void *val, uint32_t size);
+
+  /** Write a value of type T to the writer. */
+  template <class T>
+  static void WriteValue(BufferedLogWriter *out, const T &val) {
+    WriteValue(out, &val, sizeof(T));
+  }
+};
+
+}  // namespace noisepage::storage
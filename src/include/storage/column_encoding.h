@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+#include "common/container/concurrent_bitmap.h"
+#include "common/macros.h"
+#include "common/strong_typedef.h"
+
+namespace noisepage::storage {
+
+/**
+ * Lightweight encodings of the values of a fixed-length integer column.
+ */
+enum class ColumnEncoding : uint8_t {
+  /** The values are not encoded */
+  PLAIN = 0,
+  /** The distance of every value to a reference value is packed into as few bits as the largest distance needs */
+  FRAME_OF_REFERENCE,
+  /** Runs of equal values are stored once, together with the offset their run ends at */
+  RUN_LENGTH
+};
+
+/**
+ * An encoded copy of a fixed-length integer column of a frozen block, which in-place scans decode instead of reading
+ * the column itself. Decoding is cheaper than bringing the plain values in from memory, so scans over columns with few
+ * distinct values or a small range need less memory bandwidth.
+ *
+ * Values are read as signed integers of the size of the attribute (1, 2, 4 or 8 bytes), and present values decode to
+ * exactly the same bytes. Null slots decode to some value within the bounds of the column instead of whatever the slot
+ * holds, which does not matter because they are masked by the presence bitmap of the block as always.
+ *
+ * A zeroed EncodedColumn is a valid PLAIN column without any buffers, so that it can live in block headers that are
+ * initialized with memset.
+ */
+class EncodedColumn {
+ public:
+  /** Number of values that are packed together under frame-of-reference encoding */
+  static constexpr uint32_t GROUP_SIZE = 64;
+
+  /**
+   * Creates an empty PLAIN column
+   */
+  EncodedColumn() = default;
+
+  /**
+   * Move constructor
+   * @param other the column to move from
+   */
+  EncodedColumn(EncodedColumn &&other) noexcept
+      : encoding_(other.encoding_),
+        bit_width_(other.bit_width_),
+        num_values_(other.num_values_),
+        num_runs_(other.num_runs_),
+        reference_(other.reference_),
+        data_(other.data_) {
+    other.encoding_ = ColumnEncoding::PLAIN;
+    other.data_ = nullptr;
+  }
+
+  /**
+   * Move-assignment operator
+   * @param other the column to move from
+   * @return self-reference
+   */
+  EncodedColumn &operator=(EncodedColumn &&other) noexcept {
+    if (this != &other) {
+      Deallocate();
+      encoding_ = other.encoding_;
+      bit_width_ = other.bit_width_;
+      num_values_ = other.num_values_;
+      num_runs_ = other.num_runs_;
+      reference_ = other.reference_;
+      data_ = other.data_;
+      other.encoding_ = ColumnEncoding::PLAIN;
+      other.data_ = nullptr;
+    }
+    return *this;
+  }
+
+  DISALLOW_COPY(EncodedColumn)
+
+  /**
+   * Destructor
+   */
+  ~EncodedColumn() { Deallocate(); }
+
+  /**
+   * Encodes a column with whichever encoding takes the least space. The column is left PLAIN if no encoding is smaller
+   * than the plain values.
+   * @param values start of the column
+   * @param size size of the attribute, 1, 2, 4 or 8 bytes
+   * @param present presence bitmap of the column
+   * @param num_values number of values to encode, starting at the first slot
+   * @param min smallest value amongst the present values
+   * @param max largest value amongst the present values
+   * @return the encoded column
+   */
+  static EncodedColumn Encode(const byte *values, uint8_t size, const common::RawConcurrentBitmap *present,
+                              uint32_t num_values, int64_t min, int64_t max);
+
+  /**
+   * Decodes a range of values.
+   * @param begin first value to decode, a multiple of GROUP_SIZE
+   * @param count number of values to decode, such that begin + count is at most the number of encoded values
+   * @param size size of the attribute, 1, 2, 4 or 8 bytes
+   * @param[out] out buffer of at least count values of the size of the attribute
+   */
+  void Decode(uint32_t begin, uint32_t count, uint8_t size, byte *out) const;
+
+  /**
+   * @return the encoding of the column
+   */
+  ColumnEncoding Encoding() const { return encoding_; }
+
+  /**
+   * @return number of bits every value is packed into, only meaningful under frame-of-reference encoding
+   */
+  uint8_t BitWidth() const { return bit_width_; }
+
+  /**
+   * @return number of runs, only meaningful under run-length encoding
+   */
+  uint32_t NumRuns() const { return num_runs_; }
+
+  /**
+   * @return number of bytes the encoded values take up
+   */
+  uint64_t EncodedSize() const;
+
+  /**
+   * Frees the encoded values and turns the column PLAIN
+   */
+  void Deallocate() {
+    delete[] data_;
+    data_ = nullptr;
+    encoding_ = ColumnEncoding::PLAIN;
+  }
+
+ private:
+  // Under run-length encoding, the buffer holds the exclusive end offset of every run, followed by its value
+  const uint32_t *RunEnds() const { return reinterpret_cast<const uint32_t *>(data_); }
+  const int64_t *RunValues() const {
+    return reinterpret_cast<const int64_t *>(data_ + RunValuesOffset(num_runs_));
+  }
+  template <typename T>
+  void DecodeValues(uint32_t begin, uint32_t count, T *out) const;
+
+  static uint64_t RunValuesOffset(const uint32_t num_runs) {
+    // The values are aligned to 8 bytes
+    return (static_cast<uint64_t>(num_runs) * sizeof(uint32_t) + sizeof(int64_t) - 1) / sizeof(int64_t) *
+           sizeof(int64_t);
+  }
+
+  ColumnEncoding encoding_ = ColumnEncoding::PLAIN;
+  uint8_t bit_width_ = 0;
+  uint32_t num_values_ = 0;
+  uint32_t num_runs_ = 0;
+  // Under frame-of-reference encoding, the value all distances are taken from
+  int64_t reference_ = 0;
+  byte *data_ = nullptr;
+};
+
+}  // namespace noisepage::storage
@@ -2,19 +2,27 @@
 
 #include <algorithm>
 #include <cstring>
+#include <functional>
 #include <limits>
+#include <memory>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <vector>
 
+#include "common/constants.h"
+#include "common/container/concurrent_vector.h"
 #include "common/macros.h"
 #include "common/managed_pointer.h"
 #include "common/shared_latch.h"
+#include "common/spin_latch.h"
+#include "storage/free_space_map.h"
 #include "storage/projected_columns.h"
 #include "storage/storage_defs.h"
 #include "storage/tuple_access_strategy.h"
 #include "storage/undo_record.h"
 
 namespace noisepage::execution::sql {
+class TupleIdList;
 class VectorProjection;
 }  // namespace noisepage::execution::sql
 
@@ -25,6 +33,8 @@ class TransactionManager;
 
 namespace noisepage::storage {
 
+class BlockBufferManager;
+
 namespace index {
 class Index;
 template <typename KeyType>
@@ -33,6 +43,8 @@ template <typename KeyType>
 class HashIndex;
 template <typename KeyType>
 class BPlusTreeIndex;
+template <typename KeyType>
+class ArtIndex;
 }  // namespace index
 
 /**
@@ -121,11 +133,7 @@ class DataTable {
           return;
         }
 
-        RawBlock *b;
-        {
-          common::SharedLatch::ScopedSharedLatch latch(&table_->blocks_latch_);
-          b = table_->blocks_[block_index_];
-        }
+        RawBlock *const b = table_->blocks_[block_index_];
         slot_num_ = 0;
         max_slot_num_ = b->GetInsertHead();
         current_slot_ = {b, slot_num_};
@@ -169,6 +177,20 @@ class DataTable {
   bool Select(common::ManagedPointer<transaction::TransactionContext> txn, TupleSlot slot,
               ProjectedRow *out_buffer) const;
 
+  /**
+   * Materializes a batch of tuples, as visible to the transaction given, into the rows of the given output buffer. The
+   * tuples from the same block share one SIREAD lock check, and the version pointers of the whole batch are fetched
+   * before the first tuple is materialized, so that their cache misses overlap.
+   *
+   * @param txn the calling transaction
+   * @param slots the tuple slots to read. Row i of the output buffer receives slots[i].
+   * @param out_buffer output buffer. The object should already contain projection list information and have room for as
+   *                   many rows as the capacity of tids. It is reset, and only the visible tuples are selected.
+   * @param tids the rows of the output buffer to read. Rows whose tuple is not visible to this txn are removed.
+   */
+  void SelectBatch(common::ManagedPointer<transaction::TransactionContext> txn, const TupleSlot *slots,
+                   execution::sql::VectorProjection *out_buffer, execution::sql::TupleIdList *tids) const;
+
   // TODO(Tianyu): Should this be updated in place or return a new iterator? Does the caller ever want to
   // save a point of scan and come back to it later?
   // Alternatively, we can provide an easy wrapper that takes in a const SlotIterator & and returns a SlotIterator,
@@ -198,9 +220,132 @@ class DataTable {
    * @param txn The calling transaction.
    * @param start_pos Iterator to the starting location for the sequential scan.
    * @param out_buffer Output buffer. This buffer is always cleared of old values.
+   * @param col_idxs The columns of the output buffer to fill, in the order of the projection, or nullptr to fill all of
+   *                 them. The other columns are left unfilled, for SelectColumns to read for the rows that are needed.
    */
   void Scan(common::ManagedPointer<transaction::TransactionContext> txn, SlotIterator *start_pos,
-            execution::sql::VectorProjection *out_buffer) const;
+            execution::sql::VectorProjection *out_buffer, const std::vector<uint16_t> *col_idxs = nullptr) const;
+
+  /**
+   * Fills columns that Scan left unfilled, for the selected rows of its output buffer only. The tuples are read as they
+   * were by Scan, since the snapshot of the transaction is the same, so that every row stays one version of a tuple.
+   *
+   * @param txn The calling transaction, which made the Scan.
+   * @param out_buffer The output buffer of the Scan, whose selections are the rows to fill.
+   * @param col_idxs The columns of the output buffer to fill, in the order of the projection.
+   */
+  void SelectColumns(common::ManagedPointer<transaction::TransactionContext> txn,
+                     execution::sql::VectorProjection *out_buffer, const std::vector<uint16_t> &col_idxs) const;
+
+  /**
+   * Reads the tuples at the given iterator in place if they are in a FROZEN block. Instead of copying the tuples, the
+   * column vectors of the output buffer are pointed directly at the columns of the block, whose varlen entries point
+   * into its Arrow buffers. The vectors of dictionary-compressed columns also carry the dictionary codes of the block.
+   * As many tuples as fit into the output buffer are read, up to the end of the block, and the given iterator is
+   * advanced past them.
+   *
+   * The caller holds an in-place read on the block until it passes the returned block to ReleaseInPlaceRead, and
+   * writers to the block wait until then. The output buffer must not be read after the block is released, and it must
+   * be reset before it is used by Scan again. Only transactions declared read-only read in place, because a writer
+   * would wait for its own in-place read when it writes to a tuple it read.
+   *
+   * @param txn the calling transaction
+   * @param start_pos iterator to the starting location for the scan
+   * @param out_buffer output buffer. The object should already contain projection list information, with column types
+   *                   as large as the attributes they read. Columns stored in a column group of the layout are not
+   *                   contiguous and cannot be read in place.
+   * @return the block that was read in place, or nullptr if nothing was read because the tuples at the iterator are not
+   * in a FROZEN block
+   */
+  RawBlock *ScanInPlace(common::ManagedPointer<transaction::TransactionContext> txn, SlotIterator *start_pos,
+                        execution::sql::VectorProjection *out_buffer) const;
+
+  /**
+   * Ends an in-place read started by ScanInPlace.
+   * @param block the block returned by ScanInPlace
+   */
+  static void ReleaseInPlaceRead(RawBlock *const block) { block->controller_.ReleaseInPlaceRead(); }
+
+  /**
+   * Checks the zone map of a block, which bounds the values its tuples hold in a fixed-length column of at most 8
+   * bytes, read as signed integers. The bounds are exact for a FROZEN block and only ever widen otherwise, so they
+   * cover every version any transaction can see. Nulls are not covered, as they never satisfy a comparison.
+   *
+   * @param block the block to check
+   * @param col_id the column to check. Columns without a zone map are assumed to contain every value.
+   * @param min lower bound of the values of interest, inclusive
+   * @param max upper bound of the values of interest, inclusive
+   * @return false if no tuple in the block holds a value within [min, max] in the column
+   */
+  bool BlockMayContain(const RawBlock *block, col_id_t col_id, int64_t min, int64_t max) const;
+
+  /**
+   * Moves the given iterator past the remaining slots of its block, for scans that found nothing of interest in it.
+   * @param pos the iterator to advance. It must not be at the end of the table.
+   */
+  void SkipBlock(SlotIterator *const pos) const {
+    NOISEPAGE_ASSERT(*pos != end() && (**pos).GetBlock() != nullptr, "cannot skip past the end of the table");
+    pos->block_index_++;
+    pos->UpdateFromNextBlock();
+  }
+
+  /**
+   * Partitions the table by ranges of values of a column, like a RANGE partitioned table: every block only receives the
+   * tuples of one range, so that scans filtering on the column skip the blocks of the other ranges by their zone maps
+   * (@see BlockMayContain). Tuples whose value is null go to the first range. The partitioning only decides where a
+   * tuple is inserted. Tuples that are later updated to a value of another range, or that the BlockCompactor moves,
+   * widen the zone maps of their blocks instead, which keeps scans correct but prunes less.
+   *
+   * Must be called before the first insert into the table.
+   * @param col_id the column to partition by, which must have a zone map
+   * @param bounds the lower bounds of every range but the first, in ascending order
+   */
+  void SetRangePartitioning(col_id_t col_id, std::vector<int64_t> bounds);
+
+  /**
+   * @return the number of ranges the table is partitioned by, 1 if it is not partitioned
+   */
+  uint32_t NumPartitions() const { return static_cast<uint32_t>(partition_bounds_.size()) + 1; }
+
+  /**
+   * Lets the full scans of the table share their reads, like synchronized sequential scans: a scan starts at the block
+   * the latest scan reported reading, goes on to the end of the table and then wraps around to the blocks before where
+   * it started. Concurrent scans of a large table then move through it together and read the blocks the others just
+   * brought into the caches, instead of each one starting over from the first block. Full scans of the table then
+   * return its tuples in no particular order.
+   * @param shared true if full scans start where the latest scan is
+   */
+  void SetSharedScans(const bool shared) { shared_scans_.store(shared, std::memory_order_relaxed); }
+
+  /**
+   * @return true if full scans start where the latest scan is, @see SetSharedScans
+   */
+  bool HasSharedScans() const { return shared_scans_.load(std::memory_order_relaxed); }
+
+  /**
+   * @return the index of the block a full scan starts at if the table shares its scans, @see SetSharedScans
+   */
+  uint32_t GetSharedScanStart() const {
+    const uint64_t position = scan_position_.load(std::memory_order_relaxed);
+    return position < blocks_size_ ? static_cast<uint32_t>(position) : 0;
+  }
+
+  /**
+   * Records the block a scan is about to read, for the scans that begin next to start there. @see SetSharedScans
+   * @param pos an iterator at the first slot of the block
+   */
+  void ReportScanPosition(const SlotIterator &pos) {
+    scan_position_.store(pos.block_index_, std::memory_order_relaxed);
+  }
+
+  /**
+   * @param col_id a column of the table
+   * @return true if blocks keep a zone map of the column (@see BlockMayContain)
+   */
+  bool HasColumnZone(const col_id_t col_id) const {
+    const BlockLayout &layout = accessor_.GetBlockLayout();
+    return col_id != VERSION_POINTER_COLUMN_ID && !layout.IsVarlen(col_id) && layout.AttrSize(col_id) <= 8;
+  }
 
   /**
    * @return the first tuple slot contained in the data table
@@ -244,6 +389,9 @@ class DataTable {
    * equivalent to a noop and false is returned. If return is false, undo's table pointer is nullptr (used in Abort and
    * GC)
    *
+   * If txn already holds the head of the tuple's version chain, and that record already has the before-image of every
+   * attribute the update changes, no new undo record is allocated and the tuple is updated in place.
+   *
    * @param txn the calling transaction
    * @param slot the slot of the tuple to update.
    * @param redo the desired change to be applied. This should be the after-image of the attributes of interest. Should
@@ -257,12 +405,36 @@ class DataTable {
    * delta record. The slot allocated for the tuple is returned.
    *
    * @param txn the calling transaction
-   * @param redo after-image of the inserted tuple. Should not reference col_id 0
+   * @param redo after-image of the inserted tuple. Should not reference col_id 0. The columns it leaves out are null.
    * @return the TupleSlot allocated for this insert, used to identify this tuple's physical location for indexes and
    * such.
    */
   TupleSlot Insert(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &redo);
 
+  /**
+   * Inserts every tuple of the given buffer, as Insert does. The slots for the tuples are allocated a block at a time,
+   * and their undo records a buffer segment at a time.
+   *
+   * @param txn the calling transaction
+   * @param redos after-images of the inserted tuples, which are not modified. Should not reference col_id 0
+   * @param[out] results receives the TupleSlot allocated for every tuple, in the order of the buffer. It must have room
+   *                     for redos->NumTuples() slots.
+   */
+  void InsertBatch(common::ManagedPointer<transaction::TransactionContext> txn, ProjectedColumns *redos,
+                   TupleSlot *results);
+
+  /**
+   * Inserts every selected tuple of the given buffer, as Insert does. The slots for the tuples are allocated a block at
+   * a time, and their undo records a buffer segment at a time.
+   *
+   * @param txn the calling transaction
+   * @param redos after-images of the inserted tuples, which are not modified. Should not reference col_id 0
+   * @param[out] results receives the TupleSlot allocated for every selected tuple, in the order of the buffer. It must
+   *                     have room for redos->GetSelectedTupleCount() slots.
+   */
+  void InsertBatch(common::ManagedPointer<transaction::TransactionContext> txn,
+                   execution::sql::VectorProjection *redos, TupleSlot *results);
+
   /**
    * Deletes the given TupleSlot, this will call StageDelete on the provided txn to generate the RedoRecord for delete.
    * The rest of the behavior follows Update's behavior.
@@ -272,12 +444,26 @@ class DataTable {
    */
   bool Delete(common::ManagedPointer<transaction::TransactionContext> txn, TupleSlot slot);
 
+  /**
+   * Takes the write lock on the given TupleSlot without changing the tuple, as in SELECT ... FOR UPDATE. The lock is an
+   * UndoRecord without a delta at the head of the version chain, which conflicts with the writes of other transactions
+   * like any uncommitted version, and is released when the txn commits or aborts. Nothing is logged. Once released, it
+   * does not conflict with anyone. The rest of the behavior follows Update's behavior.
+   * @param txn the calling transaction
+   * @param slot the slot of the tuple to lock
+   * @return true if successful, false otherwise
+   */
+  bool Lock(common::ManagedPointer<transaction::TransactionContext> txn, TupleSlot slot);
+
   /**
    * @return pointer to underlying vector of blocks
    */
   std::vector<RawBlock *> GetBlocks() const {
-    common::SharedLatch::ScopedSharedLatch latch(&blocks_latch_);
-    return std::vector<RawBlock *>(blocks_.begin(), blocks_.end());
+    const uint64_t size = blocks_size_;
+    std::vector<RawBlock *> blocks;
+    blocks.reserve(size);
+    for (uint64_t i = 0; i < size; i++) blocks.push_back(blocks_[i]);
+    return blocks;
   }
 
   /**
@@ -298,6 +484,11 @@ class DataTable {
    */
   uint64_t GetNumTuple() const { return GetBlockLayout().NumSlots() * blocks_size_; }
 
+  /**
+   * @return Approximate number of slots that deletes freed and inserts did not fill again yet
+   */
+  uint64_t GetNumFreeSlots() const { return free_space_map_.NumFreeSlots(); }
+
   /**
    * @return Approximate heap usage of the table
    */
@@ -307,6 +498,18 @@ class DataTable {
     return blocks_size_ * common::Constants::BLOCK_SIZE;
   }
 
+  /**
+   * @return Number of tuples inserted, updated or deleted by committed transactions since the table was created. The
+   * GarbageCollector counts them as it unlinks the transactions, so the count lags behind the commits.
+   */
+  uint64_t GetNumModifications() const { return num_modifications_.load(std::memory_order_relaxed); }
+
+  /**
+   * @return Commit time of the last transaction that changed the table, INITIAL_TXN_TIMESTAMP if none did. A
+   * transaction that starts after a commit sees the commit time once it has begun.
+   */
+  transaction::timestamp_t GetLastCommitTime() const { return last_commit_time_.load(std::memory_order_acquire); }
+
  private:
   // The GarbageCollector needs to modify VersionPtrs when pruning version chains
   friend class GarbageCollector;
@@ -320,6 +523,8 @@ class DataTable {
   friend class index::HashIndex;
   template <typename KeyType>
   friend class index::BPlusTreeIndex;
+  template <typename KeyType>
+  friend class index::ArtIndex;
   // The block compactor elides transactional protection in the gather/compression phase and
   // needs raw access to the underlying table.
   friend class BlockCompactor;
@@ -328,6 +533,8 @@ class DataTable {
   // The ArrowSerializer utilizes the accessor directly in order to do fast reads on the underlying
   // data to minimize copies and increase efficiency.
   friend class ArrowSerializer;
+  // The BlockBufferManager evicts frozen blocks and needs to know their layout
+  friend class BlockBufferManager;
 
   /**
    * accessor_ tuple access strategy for DataTable
@@ -336,21 +543,145 @@ class DataTable {
 
   std::atomic<uint64_t> blocks_size_ = 0;
   std::atomic<uint64_t> insert_index_ = 0;
+  // Only written by the GarbageCollector, which keeps the bookkeeping off the path of the writing transactions
+  std::atomic<uint64_t> num_modifications_ = 0;
+  // Only written by the TransactionManager in its commit critical sections, @see UpdateLastCommitTime()
+  std::atomic<transaction::timestamp_t> last_commit_time_{transaction::INITIAL_TXN_TIMESTAMP};
   common::ManagedPointer<BlockStore> const block_store_;
 
-  // protected by blocks_latch_
-  std::vector<RawBlock *> blocks_;
-  mutable common::SharedLatch blocks_latch_;
+  // Append-only. Blocks are published to readers in order, only the first blocks_size_ of them may be read.
+  common::ConcurrentVector<RawBlock *> blocks_;
   const layout_version_t layout_version_;
 
+  // The block an inserting thread tries first. Threads on the same insertion head share its block, and move on to a
+  // block of their own once they find it busy, so that concurrent inserters end up spread over different blocks.
+  // A head can also point to a block that deletes left with free slots, which inserters fill from reuse_offset_ on.
+  struct alignas(common::Constants::CACHELINE_SIZE) InsertHead {
+    std::atomic<RawBlock *> block_ = nullptr;
+    std::atomic<uint32_t> reuse_offset_ = NO_REUSE;
+  };
+  static constexpr uint32_t NO_REUSE = std::numeric_limits<uint32_t>::max();
+  static constexpr uint32_t NUM_INSERT_HEADS = 32;
+  InsertHead insert_heads_[NUM_INSERT_HEADS];
+
+  // Transactions commit concurrently in separate critical sections, so the stores of their commit times may race. The
+  // time only ever moves forward, and is visible to every transaction that begins after the critical section ends.
+  void UpdateLastCommitTime(const transaction::timestamp_t commit_time) {
+    transaction::timestamp_t last = last_commit_time_.load(std::memory_order_relaxed);
+    while (last < commit_time && !last_commit_time_.compare_exchange_weak(last, commit_time)) {
+    }
+  }
+
+  // The block the tuples of a range are inserted into, @see SetRangePartitioning(). The blocks of a range are filled
+  // one at a time, as a block that inserters moved on from would keep its free slots forever.
+  struct alignas(common::Constants::CACHELINE_SIZE) Partition {
+    common::SpinLatch latch_;
+    RawBlock *block_ = nullptr;
+  };
+  // The column the table is partitioned by, the version pointer column if it is not partitioned
+  col_id_t partition_col_id_ = VERSION_POINTER_COLUMN_ID;
+  std::vector<int64_t> partition_bounds_;
+  std::unique_ptr<Partition[]> partitions_;
+
+  bool IsPartitioned() const { return partition_col_id_ != VERSION_POINTER_COLUMN_ID; }
+
+  // Whether full scans start at the block the latest scan reported reading, @see SetSharedScans()
+  std::atomic<bool> shared_scans_ = false;
+  std::atomic<uint64_t> scan_position_ = 0;
+
+  // The range the tuple of the given row belongs to
+  template <class RowType>
+  uint32_t PartitionOf(const RowType &redo) const;
+
+  // Allocates a slot in the current block of the range, or in a new block once that one is full
+  void AllocateSlotInPartition(uint32_t partition, TupleSlot *result);
+
+  InsertHead &InsertHeadForThread() {
+    static thread_local const size_t thread_hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return insert_heads_[thread_hash % NUM_INSERT_HEADS];
+  }
+
+  // Blocks with slots that deletes freed behind their insertion heads
+  FreeSpaceMap free_space_map_;
+
+  // Evicts the frozen blocks of this table when memory runs short, nullptr if the table is not registered with one
+  BlockBufferManager *buffer_manager_ = nullptr;
+
+  // Readers that apply more deltas than this while reconstructing a version prune the version chain behind them
+  static constexpr uint32_t PRUNE_TRAVERSAL_THRESHOLD = 8;
+
   // A templatized version for select, so that we can use the same code for both row and column access.
   // the method is explicitly instantiated for ProjectedRow and ProjectedColumns::RowView
+  // The SIREAD lock on the block of the slot is only taken if register_read is set.
   template <class RowType>
   bool SelectIntoBuffer(common::ManagedPointer<transaction::TransactionContext> txn, TupleSlot slot,
-                        RowType *out_buffer) const;
+                        RowType *out_buffer, bool register_read = true) const;
+
+  // Same as SelectIntoBuffer, for a slot that is known to be allocated, in a block that is resident and that the caller
+  // took the SIREAD lock on if it needed to
+  template <class RowType>
+  bool SelectAllocatedIntoBuffer(common::ManagedPointer<transaction::TransactionContext> txn, TupleSlot slot,
+                                 RowType *out_buffer) const;
+
+  // Reads the tuples of the block at the iterator, until read_slot returned true for num_rows of them or the block
+  // ends, and advances the iterator past them. read_slot is called for allocated slots only, and returns whether the
+  // tuple was visible and read. Defined in the translation unit only.
+  template <class ReadSlot>
+  uint32_t ScanBlock(common::ManagedPointer<transaction::TransactionContext> txn, SlotIterator *pos, uint32_t num_rows,
+                     ReadSlot read_slot) const;
 
   void InsertInto(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &redo,
                   TupleSlot dest);
+
+  // Installs the given undo record for the allocated slot dest and writes the tuple. Defined in the translation unit
+  // only, for ProjectedRow and the row views of ProjectedColumns and VectorProjection.
+  template <class RowType>
+  void InstallInsert(const RowType &redo, TupleSlot dest, UndoRecord *undo);
+
+  // Counts a scan of the block, which the AccessObserver takes into account when deciding to freeze it
+  void RecordScan(RawBlock *const block) const {
+    accessor_.GetArrowBlockMetadata(block)
+        .GetAccessStats(accessor_.GetBlockLayout())
+        .num_scans_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  // Faults the block back in if it was evicted. A frozen block is marked as referenced, so that the
+  // BlockBufferManager keeps it in memory for a while longer.
+  void MakeResident(RawBlock *const block) const {
+    const BlockState state = block->controller_.GetBlockState()->load(std::memory_order_acquire);
+    if (LIKELY(state < BlockState::FROZEN) || buffer_manager_ == nullptr) return;
+    if (state == BlockState::FROZEN) {
+      std::atomic<bool> &referenced =
+          accessor_.GetArrowBlockMetadata(block).GetAccessStats(accessor_.GetBlockLayout()).referenced_;
+      // Readers of the same block do not keep writing to its header
+      if (!referenced.load(std::memory_order_relaxed)) referenced.store(true, std::memory_order_relaxed);
+      return;
+    }
+    FaultIn(block);
+  }
+
+  // Slow path of MakeResident
+  void FaultIn(RawBlock *block) const;
+
+  // Faults the block back in if it was evicted, and waits until it is hot so that it can be written to
+  void MakeHot(RawBlock *const block) const {
+    MakeResident(block);
+    // The block may have been evicted again before it became hot
+    while (!block->controller_.WaitUntilHot()) FaultIn(block);
+  }
+
+  // Widens the zone maps of the block of the slot to cover the values the given row wrote to it
+  template <class RowType>
+  void WidenColumnZones(const RowType &redo, TupleSlot slot);
+
+  // Inserts num_tuples tuples, the i-th of which is row_at(i). Defined in the translation unit only.
+  template <class RowAt>
+  void InsertRows(common::ManagedPointer<transaction::TransactionContext> txn, uint32_t num_tuples, RowAt row_at,
+                  TupleSlot *results);
+
+  // Allocates num_slots slots, filling a block before moving on to the next one, and clears the busy status of every
+  // block used.
+  void AllocateSlots(uint32_t num_slots, TupleSlot *results);
   // Atomically read out the version pointer value.
   UndoRecord *AtomicallyReadVersionPtr(TupleSlot slot, const TupleAccessStrategy &accessor) const;
 
@@ -358,6 +689,16 @@ class DataTable {
   // contention
   void AtomicallyWriteVersionPtr(TupleSlot slot, const TupleAccessStrategy &accessor, UndoRecord *desired);
 
+  // Unlinks the part of the version chain below from that no running transaction can see anymore, judged by the
+  // txn's cached oldest active transaction. from itself is never unlinked. The unlinked UndoRecords remain owned by
+  // their transactions and are freed by the GarbageCollector as before.
+  void PruneVersionChain(common::ManagedPointer<transaction::TransactionContext> txn, UndoRecord *from) const;
+
+  // Applies an update of a tuple that txn already wrote without a new undo record, if the record at the head of the
+  // version chain, which txn owns, restores every attribute the update changes. Returns false if it cannot.
+  bool CoalesceUpdate(common::ManagedPointer<transaction::TransactionContext> txn, TupleSlot slot,
+                      const ProjectedRow &redo);
+
   // Checks for Snapshot Isolation conflicts, used by Update
   bool HasConflict(const transaction::TransactionContext &txn, UndoRecord *version_ptr) const;
 
@@ -378,6 +719,36 @@ class DataTable {
   // Allocates a new block to be used as insertion head.
   RawBlock *NewBlock();
 
+  // Appends a block to the table without taking a latch and publishes it once all blocks before it are published.
+  // Returns the index of the block.
+  uint64_t AppendBlock(RawBlock *block);
+
+  // Finds a block that no other thread is inserting into and that has a free slot, starting from the insertion index,
+  // and allocates a slot in it. Past the last block, refills a block from the free-space map before appending a new
+  // block. Sets reuse_offset for the block it returns, @see AllocateInBlock().
+  RawBlock *AllocateFromInsertionIndex(TupleSlot *result, uint32_t *reuse_offset);
+
+  // Allocates a slot in a block that the caller set busy, behind the insertion head from reuse_offset on if it is not
+  // NO_REUSE. Advances reuse_offset past the slot, or sets it to NO_REUSE once the block has no free slot left.
+  bool AllocateInBlock(RawBlock *block, uint32_t *reuse_offset, TupleSlot *result);
+
+  // Allocates up to num_slots slots in a block that the caller set busy, like AllocateInBlock, claiming the slots from
+  // the insertion head on as one run. Returns the number of slots allocated.
+  uint32_t AllocateInBlock(RawBlock *block, uint32_t *reuse_offset, uint32_t num_slots, TupleSlot *results);
+
+  // Takes a block with free slots from the free-space map and sets it busy, or returns nullptr if there is none
+  RawBlock *TakeBlockWithFreeSlots();
+
+  // Whether inserts may fill the free slots of a block that the caller set busy. Blocks that the AccessObserver handed
+  // to the BlockCompactor are left to it. The observer only does so while it holds the busy status of the block.
+  bool CanReuseFreeSlots(RawBlock *block) const;
+
+  // Frees the slot of a deleted tuple that no transaction can see anymore, so that inserts may fill it again
+  void ReclaimSlot(const TupleSlot slot) {
+    accessor_.Deallocate(slot);
+    free_space_map_.SlotFreed(slot.GetBlock());
+  }
+
   /**
    * Determine if a Tuple is visible (present and not deleted) to the given transaction. It's effectively Select's logic
    * (follow a version chain if present) without the materialization. If the logic of Select changes, this should change
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+
+#include "common/macros.h"
+#include "common/spin_latch.h"
+
+namespace noisepage::storage {
+
+class RawBlock;
+
+/**
+ * Tracks the blocks of a DataTable that have slots freed behind their insertion heads. Inserts only ever fill a block
+ * up to its insertion head, so these slots would otherwise stay empty until the BlockCompactor packs the block, while
+ * the table keeps growing under a workload that deletes as much as it inserts.
+ *
+ * A block becomes a candidate for reuse once a reuse threshold of its slots were freed, and is then handed to an
+ * inserter, who fills all of its free slots before the block can become a candidate again. Blocks with only a few
+ * free slots are thus left to the compactor rather than refilled one slot at a time. The counts are approximate: a
+ * block that is handed out but turns out to be unusable loses the count of its free slots.
+ */
+class FreeSpaceMap {
+ public:
+  /**
+   * @param num_slots number of slots in a block of the table
+   */
+  explicit FreeSpaceMap(const uint32_t num_slots)
+      : reuse_threshold_(std::max<uint32_t>(1, num_slots / REUSE_FRACTION)) {}
+
+  DISALLOW_COPY_AND_MOVE(FreeSpaceMap)
+
+  /**
+   * Counts a slot that was freed in the block.
+   * @param block block that the slot is in
+   */
+  void SlotFreed(RawBlock *const block) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    num_free_slots_++;
+    if (++free_slots_[block] == reuse_threshold_) candidates_.push_back(block);
+  }
+
+  /**
+   * Takes the block that became a candidate first. Its count starts over, as the caller is expected to fill it.
+   * @return a block with at least the reuse threshold of free slots, or nullptr if there is none
+   */
+  RawBlock *TakeBlock() {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    if (candidates_.empty()) return nullptr;
+    RawBlock *const block = candidates_.front();
+    candidates_.pop_front();
+    const auto it = free_slots_.find(block);
+    NOISEPAGE_ASSERT(it != free_slots_.end(), "Candidates have a count.");
+    num_free_slots_ -= it->second;
+    free_slots_.erase(it);
+    return block;
+  }
+
+  /**
+   * @return number of slots freed in the blocks of the table that were not handed out again since, which is a lower
+   * bound of the free slots behind the insertion heads
+   */
+  uint64_t NumFreeSlots() const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return num_free_slots_;
+  }
+
+  /**
+   * @param block block of the table
+   * @return number of slots freed in the block that were not handed out again since
+   */
+  uint32_t NumFreeSlots(RawBlock *const block) const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    const auto it = free_slots_.find(block);
+    return it == free_slots_.end() ? 0 : it->second;
+  }
+
+  /** @return number of free slots a block needs to become a candidate for reuse */
+  uint32_t ReuseThreshold() const { return reuse_threshold_; }
+
+ private:
+  // A block becomes a candidate once this fraction of its slots is free
+  static constexpr uint32_t REUSE_FRACTION = 8;
+
+  const uint32_t reuse_threshold_;
+  mutable common::SpinLatch latch_;
+  std::unordered_map<RawBlock *, uint32_t> free_slots_;
+  std::deque<RawBlock *> candidates_;
+  uint64_t num_free_slots_ = 0;
+};
+
+}  // namespace noisepage::storage
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <memory>
 #include <queue>
 #include <tuple>
-#include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/shared_latch.h"
+#include "common/worker_pool.h"
+#include "storage/index/index_defs.h"
 #include "storage/storage_defs.h"
 #include "transaction/transaction_defs.h"
 
@@ -44,16 +49,23 @@ class GarbageCollector {
    *                 it is not null. The observer can then gain insight invoke other components to perform actions.
    *                 The observer's function implementation needs to be lightweight because it is called on the GC
    *                 thread.
+   * @param num_gc_threads number of threads that truncate version chains. With more than one, the version chains are
+   *                       sharded by tuple slot across a pool of GC workers.
+   * @param index_maintenance_interval if not 0, every registered index runs background maintenance at this interval
+   *                                   (see Index::StartBackgroundMaintenance) until it is unregistered
    */
   // TODO(Tianyu): Eventually the GC will be re-written to be purely on the deferred action manager. which will
   //  eliminate this perceived redundancy of taking in a transaction manager.
   GarbageCollector(common::ManagedPointer<transaction::TimestampManager> timestamp_manager,
                    common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
-                   common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer);
+                   common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer,
+                   uint32_t num_gc_threads = 1,
+                   std::chrono::microseconds index_maintenance_interval = std::chrono::microseconds{0});
 
   ~GarbageCollector() {
     NOISEPAGE_ASSERT(txns_to_deallocate_.empty(), "Not all txns have been deallocated");
     NOISEPAGE_ASSERT(txns_to_unlink_.empty(), "Not all txns have been unlinked");
+    if (gc_workers_ != nullptr) gc_workers_->Shutdown();
   }
 
   /**
@@ -80,12 +92,27 @@ class GarbageCollector {
   void UnregisterIndexForGC(common::ManagedPointer<index::Index> index);
 
   /**
-   * Set the GC interval for metrics collection
-   * TODO(lma): this need to be called in the settings callback after we add the ability to change the GC interval
+   * Set the GC interval for metrics collection. The GarbageCollectorThread sets it whenever its period changes.
    * @param gc_interval interval to set (in us)
    */
   void SetGCInterval(uint64_t gc_interval) { gc_interval_ = gc_interval; }
 
+  /** @return number of threads that truncate version chains */
+  uint32_t GetNumGCThreads() const { return num_gc_threads_; }
+
+  /**
+   * Time that a GC invocation spends garbage collecting indexes at most, beyond the first index it visits. The indexes
+   * it does not get to are visited first by the next invocation.
+   */
+  static constexpr std::chrono::microseconds INDEX_GC_BUDGET{1000};
+
+  /**
+   * Number of GC invocations that visit an index after it was last modified. Epoch-based reclamation can only free
+   * garbage once every thread that could see it is gone, so the garbage left by the last modifications is freed by
+   * the passes that follow.
+   */
+  static constexpr uint32_t INDEX_GC_PASSES = 2;
+
  private:
   /**
    * Process the deallocate queue
@@ -98,22 +125,59 @@ class GarbageCollector {
    * @return a tuple
    *   first element - number of txns processed
    *   second element - number UndoRecords processed
-   *   first element - number of read-only txns processed
+   *   third element - number of read-only txns processed
+   *   fourth element - number of version chains truncated
+   */
+  std::tuple<uint32_t, uint32_t, uint32_t, uint32_t> ProcessUnlinkQueue(transaction::timestamp_t oldest_txn);
+
+  /**
+   * Truncate the version chain of every tuple slot written by the given transactions, on the GC workers if there are
+   * any. Every version chain is truncated once, by a single thread.
+   * @return number of version chains truncated
    */
-  std::tuple<uint32_t, uint32_t, uint32_t> ProcessUnlinkQueue(transaction::timestamp_t oldest_txn);
+  uint32_t TruncateVersionChains(const transaction::TransactionQueue &txns, transaction::timestamp_t oldest_txn);
 
   /**
    * Process deferred actions
    */
   void ProcessDeferredActions(transaction::timestamp_t oldest_txn);
 
-  void ReclaimSlotIfDeleted(UndoRecord *undo_record) const;
+  // Frees the slots of the deleted tuples once the deletes from indexes that the deleting transactions deferred are
+  // applied. Until then an index may still point a key of the deleted tuple at the slot, so inserts must not fill it.
+  void ReclaimSlots(std::vector<TupleSlot> &&slots);
 
   void ReclaimBufferIfVarlen(transaction::TransactionContext *txn, UndoRecord *undo_record) const;
 
   void TruncateVersionChain(DataTable *table, TupleSlot slot, transaction::timestamp_t oldest) const;
 
-  void ProcessIndexes();
+  /**
+   * Maintenance work of one index, see Index::CollectMaintenanceStats
+   */
+  struct IndexMaintenanceData {
+    index::IndexType type_;
+    uint64_t num_keys_;
+    size_t heap_usage_;
+    index::IndexMaintenanceStats stats_;
+    uint64_t modifications_;
+    uint64_t gc_elapsed_us_;
+  };
+
+  /**
+   * An index registered for garbage collection
+   */
+  struct RegisteredIndex {
+    common::ManagedPointer<index::Index> index_;
+    // GC invocations left that visit the index even if it is not modified again, see INDEX_GC_PASSES
+    uint32_t passes_left_;
+  };
+
+  /**
+   * Invoke garbage collection on the registered indexes that were modified in the last INDEX_GC_PASSES visits, in
+   * round-robin order starting after the last index visited, until INDEX_GC_BUDGET runs out
+   * @param[out] maintenance_data if not nullptr, the indexes that were garbage collected or consolidated anything since
+   *                              the last call are appended here
+   */
+  void ProcessIndexes(std::vector<IndexMaintenanceData> *maintenance_data);
 
   const common::ManagedPointer<transaction::TimestampManager> timestamp_manager_;
   const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager_;
@@ -126,10 +190,18 @@ class GarbageCollector {
   // queue of txns that need to be unlinked
   transaction::TransactionQueue txns_to_unlink_;
 
-  std::unordered_set<common::ManagedPointer<index::Index>> indexes_;
+  // Only the GC thread modifies passes_left_ and next_index_, so ProcessIndexes takes indexes_latch_ in shared mode
+  std::vector<RegisteredIndex> indexes_;
+  // position in indexes_ where the next invocation starts visiting indexes
+  size_t next_index_ = 0;
   common::SharedLatch indexes_latch_;
 
-  uint64_t gc_interval_{0};
+  std::atomic<uint64_t> gc_interval_{0};
+
+  const uint32_t num_gc_threads_;
+  const std::chrono::microseconds index_maintenance_interval_;
+  // Truncate version chains in parallel, nullptr if there is a single GC thread
+  std::unique_ptr<common::WorkerPool> gc_workers_ = nullptr;
 };
 
 }  // namespace noisepage::storage
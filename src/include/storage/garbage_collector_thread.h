@@ -1,8 +1,10 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>  //NOLINT
 #include <thread>  //NOLINT
 
+#include "common/thread_placement.h"
 #include "storage/garbage_collector.h"
 #include "transaction/transaction_defs.h"
 
@@ -22,9 +24,11 @@ class GarbageCollectorThread {
    * @param gc pointer to the garbage collector object to be run on this thread
    * @param gc_period sleep time between GC invocations
    * @param metrics_manager Metrics Manager
+   * @param thread_placement decides which CPUs the GC thread runs on, if not null
    */
   GarbageCollectorThread(common::ManagedPointer<GarbageCollector> gc, std::chrono::microseconds gc_period,
-                         common::ManagedPointer<metrics::MetricsManager> metrics_manager);
+                         common::ManagedPointer<metrics::MetricsManager> metrics_manager,
+                         common::ManagedPointer<common::ThreadPlacement> thread_placement = nullptr);
 
   ~GarbageCollectorThread() { StopGC(); }
 
@@ -47,7 +51,10 @@ class GarbageCollectorThread {
     NOISEPAGE_ASSERT(!run_gc_, "GC should not already be running.");
     run_gc_ = true;
     gc_paused_ = false;
-    gc_thread_ = std::thread([this] { GCThreadLoop(); });
+    gc_thread_ = std::thread([this] {
+      if (thread_placement_ != nullptr) thread_placement_->Apply(common::ThreadRole::GARBAGE_COLLECTION);
+      GCThreadLoop();
+    });
   }
 
   /**
@@ -66,6 +73,18 @@ class GarbageCollectorThread {
     gc_paused_ = false;
   }
 
+  /**
+   * Change the sleep time between GC invocations, starting after the current one
+   * @param gc_period new sleep time between GC invocations
+   */
+  void SetGCPeriod(std::chrono::microseconds gc_period) {
+    gc_period_ = gc_period;
+    gc_->SetGCInterval(gc_period.count());
+  }
+
+  /** @return sleep time between GC invocations */
+  std::chrono::microseconds GetGCPeriod() const { return gc_period_.load(); }
+
   /**
    * @return the underlying GC object, mostly to register indexes currently.
    */
@@ -74,14 +93,15 @@ class GarbageCollectorThread {
  private:
   const common::ManagedPointer<storage::GarbageCollector> gc_;
   const common::ManagedPointer<metrics::MetricsManager> metrics_manager_;
+  const common::ManagedPointer<common::ThreadPlacement> thread_placement_;
   volatile bool run_gc_;
   volatile bool gc_paused_;
-  std::chrono::microseconds gc_period_;
+  std::atomic<std::chrono::microseconds> gc_period_;
   std::thread gc_thread_;
 
   void GCThreadLoop() {
     while (run_gc_) {
-      std::this_thread::sleep_for(gc_period_);
+      std::this_thread::sleep_for(gc_period_.load());
       if (!gc_paused_) gc_->PerformGarbageCollection();
     }
   }
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "common/macros.h"
+#include "storage/index/node_reclaimer.h"
+#include "storage/storage_defs.h"
+
+namespace noisepage::storage::index {
+
+/**
+ * Adaptive Radix Tree (Leis et al., ICDE 2013) that maps binary-comparable keys to lists of TupleSlots.
+ *
+ * Keys are byte strings ordered by std::memcmp, and no key may be a prefix of another key. Inner nodes grow and shrink
+ * between 4, 16, 48 and 256 children, and store the bytes that all keys below them share (path compression). A leaf
+ * holds a whole key and its values, so a lookup touches one node per distinguishing byte and compares the key once.
+ *
+ * The tree is synchronized with optimistic lock coupling (Leis et al., DaMoN 2016). Every inner node has a version that
+ * writers bump when they unlock the node. Readers take no locks: they read a node and then check that its version did
+ * not change, and restart from the root otherwise. Writers descend the same way and lock only the nodes they change.
+ * Leaves are never changed in place, a writer replaces the leaf in its parent instead. Unlinked nodes and leaves are
+ * freed once no reader can reach them any more, see NodeReclaimer.
+ */
+class AdaptiveRadixTree {
+ public:
+  AdaptiveRadixTree();
+
+  /**
+   * Frees all nodes. The tree must not be accessed concurrently.
+   */
+  ~AdaptiveRadixTree();
+
+  DISALLOW_COPY_AND_MOVE(AdaptiveRadixTree)
+
+  /**
+   * Adds a value to the values of a key. Checking the existing values and adding the new one is atomic.
+   * @param key key bytes
+   * @param key_len number of key bytes
+   * @param value value to add
+   * @param predicate called on the existing values of the key, and the value is not added if it returns true for any
+   * @return false if the value already exists or the predicate returned true for an existing value, true otherwise
+   */
+  bool Insert(const byte *key, uint32_t key_len, TupleSlot value, const std::function<bool(TupleSlot)> &predicate);
+
+  /**
+   * Removes a value from the values of a key, and the key once it has no values left.
+   * @param key key bytes
+   * @param key_len number of key bytes
+   * @param value value to remove
+   * @return false if the key did not have the value, true otherwise
+   */
+  bool Delete(const byte *key, uint32_t key_len, TupleSlot value);
+
+  /**
+   * @param key key bytes
+   * @param key_len number of key bytes
+   * @param[out] values the values of the key are appended here
+   */
+  void Lookup(const byte *key, uint32_t key_len, std::vector<TupleSlot> *values);
+
+  /**
+   * Appends the values of the keys between the bounds, in ascending key order. A key is within the high key if its
+   * first high_key_len bytes are not greater than the high key, so that a prefix of a key can bound a scan.
+   * @param low_key smallest key to scan, or nullptr to start at the smallest key in the tree
+   * @param low_key_len number of bytes of the low key
+   * @param high_key high key as described above, or nullptr to end at the largest key in the tree
+   * @param high_key_len number of bytes of the high key
+   * @param limit number of values to append at most, or 0 for no limit
+   * @param predicate only values that the predicate returns true for are appended and count towards the limit
+   * @param[out] values the values are appended here
+   */
+  void ScanAscending(const byte *low_key, uint32_t low_key_len, const byte *high_key, uint32_t high_key_len,
+                     uint32_t limit, const std::function<bool(TupleSlot)> &predicate, std::vector<TupleSlot> *values);
+
+  /**
+   * Same as ScanAscending, but appends the values in descending key order.
+   * @param low_key smallest key to scan, or nullptr to end at the smallest key in the tree
+   * @param low_key_len number of bytes of the low key
+   * @param high_key high key as described in ScanAscending, or nullptr to start at the largest key in the tree
+   * @param high_key_len number of bytes of the high key
+   * @param limit number of values to append at most, or 0 for no limit
+   * @param predicate only values that the predicate returns true for are appended and count towards the limit
+   * @param[out] values the values are appended here
+   */
+  void ScanDescending(const byte *low_key, uint32_t low_key_len, const byte *high_key, uint32_t high_key_len,
+                      uint32_t limit, const std::function<bool(TupleSlot)> &predicate, std::vector<TupleSlot> *values);
+
+  /**
+   * Frees the nodes that were unlinked from the tree and that no reader can reach any more.
+   */
+  void ReclaimRetiredNodes() { reclaimer_.Reclaim(); }
+
+  /** @return number of keys in the tree */
+  uint64_t GetSize() const { return num_keys_.load(); }
+
+  /** @return number of bytes allocated for the nodes and leaves that are linked into the tree */
+  size_t GetHeapUsage() const { return heap_usage_.load(); }
+
+ private:
+  struct Node;
+  struct Node4;
+  struct Node16;
+  struct Node48;
+  struct Node256;
+  struct Leaf;
+  struct ScanState;
+
+  enum class ScanResult : uint8_t { CONTINUE, DONE, RESTART };
+
+  // Each Try* function returns false if it has to restart from the root because a node changed under it
+  bool TryInsert(const uint8_t *key, uint32_t key_len, TupleSlot value, const std::function<bool(TupleSlot)> &predicate,
+                 bool *inserted);
+  bool TryDelete(const uint8_t *key, uint32_t key_len, TupleSlot value, bool *deleted);
+  bool TryLookup(const uint8_t *key, uint32_t key_len, std::vector<TupleSlot> *values);
+
+  void Scan(ScanState *state);
+  ScanResult ScanNode(Node *node, uint64_t version, uint32_t depth, bool low_eq, bool high_eq, ScanState *state);
+  static ScanResult ScanLeaf(const Leaf *leaf, ScanState *state);
+
+  Node *NewLeaf(const uint8_t *key, uint32_t key_len, TupleSlot value);
+  Node *NewLeafWith(const Leaf *leaf, TupleSlot value);
+  Node *NewLeafWithout(const Leaf *leaf, TupleSlot value);
+  Node *TrackNode(Node *node);
+  void Retire(Node *node);
+
+  static void FreeNode(Node *node);
+  static void FreeSubtree(Node *node);
+
+  // Permanent Node256, so that the root never has to be replaced
+  Node *const root_;
+  std::atomic<uint64_t> num_keys_ = 0;
+  std::atomic<size_t> heap_usage_ = 0;
+  NodeReclaimer<Node> reclaimer_{&FreeNode};
+};
+
+}  // namespace noisepage::storage::index
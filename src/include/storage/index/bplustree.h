@@ -1,19 +1,24 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cstring>
 #include <functional>
 #include <iostream>
 #include <list>
+#include <numeric>
 #include <queue>
 #include <set>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "common/macros.h"
 #include "common/shared_latch.h"
 #include "loggers/index_logger.h"
 #include "storage/index/index.h"
 #include "storage/index/index_defs.h"
+#include "storage/index/node_reclaimer.h"
 
 namespace noisepage::storage::index {
 
@@ -105,10 +110,16 @@ class BPlusTreeBase {
  *  top to bottom. Thus, before accessing a child node pointer, it is ensured that the pointer cannot be
  *  deleted no matter what (the parent latch is also being held at that point).
  *
- * Optimistic latch crabbing is used to acquire node latches for reads and writes.
+ * Optimistic latch crabbing is used to acquire node latches for writes. Reads use optimistic lock coupling.
  *  Read:
- *    Acquire latches starting from root, in the path to find the key. Release shared latch of parent
- *    once the latch on current node is obtained and so on...
+ *    Every node latch carries a version that changes whenever the node is latched exclusively. Readers descend
+ *    through the inner nodes without taking latches: they remember the version of a node, read the child pointer and
+ *    check that the version did not change, restarting from the root otherwise. Only the leaf is latched in shared
+ *    mode, after which the version of its parent is checked once more. Readers thus do not write to the cache lines
+ *    of the upper levels of the tree. Nodes unlinked from the tree are only freed once no reader that descended
+ *    without latches can still reach them, see ReclaimRetiredNodes. With SetOptimisticReads(false), readers instead
+ *    acquire shared latches starting from the root, releasing the latch of the parent once the latch on the child is
+ *    obtained.
  *
  *  Write:
  *    Happens in 2 phases:
@@ -193,6 +204,70 @@ class BPlusTree : public BPlusTreeBase {
    */
   bool ValueCmpEqual(const ValueType &v1, const ValueType &v2) { return value_eq_obj_(v1, v2); }
 
+  /**
+   * class NodeLatch - Shared latch of a node, along with a version that changes whenever the node is latched
+   * exclusively. The version is odd while the node is latched exclusively. Readers that do not take the latch read the
+   * version before and after reading the node, and discard what they read if it changed.
+   */
+  class NodeLatch {
+   public:
+    /** Acquire the latch in exclusive mode, making the version odd */
+    void LockExclusive() {
+      latch_.LockExclusive();
+      version_.fetch_add(1);
+    }
+
+    /** Acquire the latch in shared mode */
+    void LockShared() { latch_.LockShared(); }
+
+    /** @return true if the latch was acquired in exclusive mode, false otherwise */
+    bool TryExclusiveLock() {
+      if (!latch_.TryExclusiveLock()) return false;
+      version_.fetch_add(1);
+      return true;
+    }
+
+    /** @return true if the latch was acquired in shared mode, false otherwise */
+    bool TryLockShared() { return latch_.TryLockShared(); }
+
+    /** Release the exclusive latch, making the version even again */
+    void UnlockExclusive() {
+      version_.fetch_add(1);
+      latch_.UnlockExclusive();
+    }
+
+    /** Release the shared latch */
+    void UnlockShared() { latch_.UnlockShared(); }
+
+    /**
+     * Reads the version of the node before reading its contents without the latch
+     * @param[out] version the version to later validate with ValidateVersion
+     * @return false if the node is latched exclusively or unlinked from the tree, so that its contents cannot be read
+     */
+    bool ReadVersion(uint64_t *version) const {
+      *version = version_.load();
+      return (*version & (OBSOLETE_BIT | 1)) == 0;
+    }
+
+    /**
+     * @param version version returned by ReadVersion
+     * @return true if the node did not change since the version was read, so that what was read from it is valid
+     */
+    bool ValidateVersion(const uint64_t version) const {
+      // Keep the reads of the node contents from moving past the version check
+      std::atomic_thread_fence(std::memory_order_acquire);
+      return version_.load() == version;
+    }
+
+    /** Mark the node as unlinked from the tree, which fails all validations of versions read before */
+    void MarkObsolete() { version_.fetch_or(OBSOLETE_BIT); }
+
+   private:
+    static constexpr uint64_t OBSOLETE_BIT = uint64_t{1} << 63;
+    common::SharedLatch latch_;
+    std::atomic<uint64_t> version_ = 0;
+  };
+
   /**
    * class NodeMetaData - Holds node metadata in an object
    *
@@ -216,7 +291,7 @@ class BPlusTree : public BPlusTreeBase {
     int item_count_;
 
     /** Latch for each node */
-    common::SharedLatch node_latch_;
+    NodeLatch node_latch_;
 
     /**
      * Constructor
@@ -327,7 +402,7 @@ class BPlusTree : public BPlusTreeBase {
     /**
      * GetLatchPointer() - Get the Latch Pointer of current node's latch
      */
-    common::SharedLatch *GetLatchPointer() { return &(metadata_.node_latch_); }
+    NodeLatch *GetLatchPointer() { return &(metadata_.node_latch_); }
 
     /**
      * TryExclusiveLock() - Try to get the exclusive lock
@@ -339,6 +414,21 @@ class BPlusTree : public BPlusTreeBase {
      */
     bool TrySharedLock() { return metadata_.node_latch_.TryLockShared(); }
 
+    /**
+     * ReadVersion() - Read the version of the node before reading it without the latch, see NodeLatch::ReadVersion
+     */
+    bool ReadVersion(uint64_t *version) const { return metadata_.node_latch_.ReadVersion(version); }
+
+    /**
+     * ValidateVersion() - Check that the node did not change since the version was read
+     */
+    bool ValidateVersion(const uint64_t version) const { return metadata_.node_latch_.ValidateVersion(version); }
+
+    /**
+     * MarkObsolete() - Mark the node as unlinked from the tree
+     */
+    void MarkObsolete() { metadata_.node_latch_.MarkObsolete(); }
+
     /**
      * SetLowKeyPair() - Sets the low key pair of metadata
      */
@@ -741,10 +831,30 @@ class BPlusTree : public BPlusTreeBase {
   const ValueEqualityChecker value_eq_obj_;
 
  private:
-  BaseNode *root_;
-  common::SharedLatch root_latch_;
+  // Fraction of the capacity of a node that BulkLoad fills
+  static constexpr double BULK_LOAD_FILL_FACTOR = 0.9;
+
+  std::atomic<BaseNode *> root_;
+  NodeLatch root_latch_;
   std::atomic_uint64_t num_keys_;
   std::atomic_uint64_t num_values_;
+  bool optimistic_reads_ = true;
+  // Frees unlinked nodes once no reader that descended without latches can reach them
+  NodeReclaimer<BaseNode> reclaimer_{&FreeNode};
+
+  /**
+   * Marks a node that was unlinked from the tree as obsolete, and frees it once no reader can reach it any more. The
+   * caller must not hold the latch of the node any more.
+   */
+  void RetireNode(BaseNode *node) {
+    node->MarkObsolete();
+    reclaimer_.Retire(node);
+  }
+
+  /**
+   * Frees the memory of a node without touching the value lists of a leaf, which the retired node does not own
+   */
+  static void FreeNode(BaseNode *node) { reinterpret_cast<ElasticNode<KeyNodePointerPair> *>(node)->FreeElasticNode(); }
 
  public:
   /**
@@ -752,6 +862,24 @@ class BPlusTree : public BPlusTreeBase {
    */
   BaseNode *GetRoot() { return root_; }
 
+  /**
+   * Selects how lookups and scans descend the tree. This exists to compare the two approaches, and should only be
+   * changed while no reads are running.
+   * @param optimistic_reads true to descend with optimistic lock coupling, false to descend with shared latch crabbing
+   */
+  void SetOptimisticReads(const bool optimistic_reads) { optimistic_reads_ = optimistic_reads; }
+
+  /**
+   * @return whether lookups and scans descend the tree with optimistic lock coupling
+   */
+  bool GetOptimisticReads() const { return optimistic_reads_; }
+
+  /**
+   * Frees the nodes unlinked from the tree that no reader can reach any more, see NodeReclaimer. Writers call this
+   * whenever they unlink a node, so calling it separately only matters to free the last batch.
+   */
+  void ReclaimRetiredNodes() { reclaimer_.Reclaim(); }
+
   /**
    * Get Element Returns a constructed KeyElementPair
    */
@@ -801,20 +929,46 @@ class BPlusTree : public BPlusTreeBase {
   }
 
   /**
-   * Tries to find key by Traversing down the BplusTree
-   * Returns the list of values of the key from leaf if found in result vector
-   * Returns null if not found
+   * Descends to the leaf that a key belongs in, and returns it with its shared latch held. The caller releases the
+   * latch.
+   * @param key key to look for, or nullptr to descend to the leftmost leaf
+   * @return the leaf, or nullptr if the tree is empty
    */
-  void FindValueOfKey(KeyType key, std::vector<ValueType> *result) {
+  BaseNode *LatchLeafForRead(const KeyType *key) {
+    if (!optimistic_reads_) return LatchLeafByCrabbing(key);
+    BaseNode *leaf;
+    while (!TryLatchLeafOptimistically(key, &leaf)) {
+    }
+    return leaf;
+  }
+
+  /**
+   * Returns the child of an inner node that a key belongs in, or the leftmost child if key is nullptr
+   */
+  BaseNode *FindChild(BaseNode *current_node, const KeyType *key) {
+    auto node = reinterpret_cast<ElasticNode<KeyNodePointerPair> *>(current_node);
+    if (key == nullptr) return node->GetLowKeyPair().second;
+    // Note that Find Location returns the location of first element
+    // that compare greater than
+    auto index_pointer = static_cast<InnerNode *>(node)->FindLocation(*key, this);
+    // Thus we have to go in the left side of location which will be the
+    // pointer of the previous location.
+    if (index_pointer != node->Begin()) return (index_pointer - 1)->second;
+    return node->GetLowKeyPair().second;
+  }
+
+  /**
+   * Descends to a leaf with shared latch crabbing, see LatchLeafForRead
+   */
+  BaseNode *LatchLeafByCrabbing(const KeyType *key) {
     root_latch_.LockShared();
 
     if (root_ == nullptr) {
       root_latch_.UnlockShared();
-      return;
+      return nullptr;
     }
 
     BaseNode *current_node = root_;
-    BaseNode *parent = nullptr;
 
     // Get the shared latch of next node, release the root_latch
     current_node->GetNodeSharedLatch();
@@ -822,24 +976,73 @@ class BPlusTree : public BPlusTreeBase {
 
     // Traversing Down to the right leaf node
     while (current_node->GetType() != NodeType::LeafType) {
-      auto node = reinterpret_cast<ElasticNode<KeyNodePointerPair> *>(current_node);
-      // Note that Find Location returns the location of first element
-      // that compare greater than
-      auto index_pointer = static_cast<InnerNode *>(node)->FindLocation(key, this);
-      // Thus we have to go in the left side of location which will be the
-      // pointer of the previous location.
-      parent = current_node;
-      if (index_pointer != node->Begin()) {
-        index_pointer -= 1;
-        current_node = index_pointer->second;
-      } else {
-        current_node = node->GetLowKeyPair().second;
-      }
+      BaseNode *const parent = current_node;
+      current_node = FindChild(parent, key);
 
       // Get the shared latch for next node and release the parent
       current_node->GetNodeSharedLatch();
       parent->ReleaseNodeSharedLatch();
     }
+    return current_node;
+  }
+
+  /**
+   * Descends to a leaf with optimistic lock coupling, see LatchLeafForRead. The inner nodes are read without latches,
+   * and only the leaf is latched.
+   * @param key key to look for, or nullptr to descend to the leftmost leaf
+   * @param[out] leaf the latched leaf, or nullptr if the tree is empty
+   * @return false if a concurrent writer changed a node on the way, and the descent has to restart from the root
+   */
+  bool TryLatchLeafOptimistically(const KeyType *key, BaseNode **leaf) {
+    typename NodeReclaimer<BaseNode>::ReadGuard guard(&reclaimer_);
+    BaseNode *current_node = root_;
+    if (current_node == nullptr) {
+      *leaf = nullptr;
+      return true;
+    }
+
+    BaseNode *parent = nullptr;
+    uint64_t parent_version = 0;
+    if (current_node->IsInnerNode()) {
+      uint64_t version;
+      // A root that is being split stays latched until the new root is published
+      if (!current_node->ReadVersion(&version) || current_node != root_) return false;
+      while (true) {
+        BaseNode *const child = FindChild(current_node, key);
+        // The child pointer is garbage unless the node did not change while it was read
+        if (!current_node->ValidateVersion(version)) return false;
+        if (!child->IsInnerNode()) {
+          parent = current_node;
+          parent_version = version;
+          current_node = child;
+          break;
+        }
+        uint64_t child_version;
+        if (!child->ReadVersion(&child_version) || !current_node->ValidateVersion(version)) return false;
+        current_node = child;
+        version = child_version;
+      }
+    }
+
+    // Writers only change the leaf under its exclusive latch, and they change the parent before unlinking the leaf
+    current_node->GetNodeSharedLatch();
+    const bool linked = parent != nullptr ? parent->ValidateVersion(parent_version) : current_node == root_;
+    if (!linked) {
+      current_node->ReleaseNodeSharedLatch();
+      return false;
+    }
+    *leaf = current_node;
+    return true;
+  }
+
+  /**
+   * Tries to find key by Traversing down the BplusTree
+   * Returns the list of values of the key from leaf if found in result vector
+   * Returns null if not found
+   */
+  void FindValueOfKey(KeyType key, std::vector<ValueType> *result) {
+    BaseNode *current_node = LatchLeafForRead(&key);
+    if (current_node == nullptr) return;
 
     auto node = reinterpret_cast<ElasticNode<KeyValuePair> *>(current_node);
     for (KeyValuePair *element_p = node->Begin(); element_p != node->End(); element_p++) {
@@ -860,6 +1063,45 @@ class BPlusTree : public BPlusTreeBase {
     current_node->ReleaseNodeSharedLatch();
   }
 
+  /**
+   * FindValuesOfKeys - Looks up a batch of keys, see FindValueOfKey.
+   *
+   * The keys are probed in ascending order, so that keys which fall into the same leaf share one descent. After a key
+   * is searched for in a leaf, the next key stays in the same leaf for as long as it is no greater than the leaf's last
+   * key, and its search resumes where the previous one stopped.
+   * @param keys keys to look up, in any order
+   * @param[out] results the values of keys[i] are appended to (*results)[i]
+   */
+  void FindValuesOfKeys(const std::vector<KeyType> &keys, std::vector<std::vector<ValueType>> *results) {
+    NOISEPAGE_ASSERT(results->size() == keys.size(), "There must be one result vector for each key");
+    std::vector<uint32_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&](const uint32_t lhs, const uint32_t rhs) { return KeyCmpLess(keys[lhs], keys[rhs]); });
+
+    ElasticNode<KeyValuePair> *leaf = nullptr;
+    KeyValuePair *element_p = nullptr;
+    for (const uint32_t key_idx : order) {
+      const KeyType &key = keys[key_idx];
+      if (leaf != nullptr && (leaf->GetSize() == 0 || KeyCmpGreater(key, (leaf->End() - 1)->first))) {
+        leaf->ReleaseNodeSharedLatch();
+        leaf = nullptr;
+      }
+      if (leaf == nullptr) {
+        leaf = reinterpret_cast<ElasticNode<KeyValuePair> *>(LatchLeafForRead(&key));
+        if (leaf == nullptr) return;
+        element_p = leaf->Begin();
+      }
+
+      while (element_p != leaf->End() && KeyCmpLess(element_p->first, key)) element_p++;
+      if (element_p != leaf->End() && KeyCmpEqual(element_p->first, key)) {
+        (*results)[key_idx].insert((*results)[key_idx].end(), element_p->second->begin(), element_p->second->end());
+      }
+    }
+
+    if (leaf != nullptr) leaf->ReleaseNodeSharedLatch();
+  }
+
   /**
    * Traverses Down the root in a BFS manner and frees all the nodes. Used in
    * the B+ Tree destructor.
@@ -867,6 +1109,8 @@ class BPlusTree : public BPlusTreeBase {
    * (normally it should be safe since the Tree is being deleted)
    */
   void FreeTree() {
+    reclaimer_.FreeAll();
+
     if (root_ == nullptr) return;
     std::queue<BaseNode *> bfs_queue;
     std::queue<BaseNode *> all_nodes;
@@ -1187,52 +1431,16 @@ class BPlusTree : public BPlusTreeBase {
    * @param value_list List of values scanned
    * @param metadata Index metadata
    * @param predicate Predicate to be satisfied to add a value to the result
+   * @param end_key Key to stop before, or nullptr to only stop at high key
    */
   bool ScanAscending(KeyType index_low_key, KeyType index_high_key, bool low_key_exists, uint32_t num_attrs,
                      bool high_key_exists, uint32_t limit, std::vector<TupleSlot> *value_list,
-                     const IndexMetadata *metadata, std::function<bool(const ValueType)> predicate) {
-    root_latch_.LockShared();
-
-    if (root_ == nullptr) {
-      root_latch_.UnlockShared();
-      return true;
-    }
-
-    BaseNode *current_node = root_;
+                     const IndexMetadata *metadata, std::function<bool(const ValueType)> predicate,
+                     const KeyType *end_key = nullptr) {
+    BaseNode *current_node = LatchLeafForRead(low_key_exists ? &index_low_key : nullptr);
+    if (current_node == nullptr) return true;
     BaseNode *parent = nullptr;
 
-    // Acquire latch on the root, release root_latch
-    current_node->GetNodeSharedLatch();
-    root_latch_.UnlockShared();
-
-    // Traversing Down to the correct leaf node
-    while (current_node->GetType() != NodeType::LeafType) {
-      // Set parent for releasing the lock
-      parent = current_node;
-
-      if (low_key_exists) {
-        auto node = reinterpret_cast<ElasticNode<KeyNodePointerPair> *>(current_node);
-        // Note that Find Location returns the location of first element
-        // that compare greater than
-        auto index_pointer = static_cast<InnerNode *>(node)->FindLocation(index_low_key, this);
-        // Thus we have to go in the left side of location which will be the
-        // pointer of the previous location.
-
-        if (index_pointer != node->Begin()) {
-          index_pointer -= 1;
-          current_node = index_pointer->second;
-        } else {
-          current_node = node->GetLowKeyPair().second;
-        }
-      } else {
-        current_node = current_node->GetLowKeyPair().second;
-      }
-
-      // Get shared latch on current node, and release the parent.
-      current_node->GetNodeSharedLatch();
-      parent->ReleaseNodeSharedLatch();
-    }
-
     auto node = reinterpret_cast<ElasticNode<KeyValuePair> *>(current_node);
     KeyValuePair *element_p;
     if (low_key_exists) {
@@ -1266,7 +1474,8 @@ class BPlusTree : public BPlusTreeBase {
     }
 
     while ((limit == 0 || value_list->size() < limit) &&
-           (!high_key_exists || element_p->first.PartialLessThan(index_high_key, metadata, num_attrs))) {
+           (!high_key_exists || element_p->first.PartialLessThan(index_high_key, metadata, num_attrs)) &&
+           (end_key == nullptr || KeyCmpLess(element_p->first, *end_key))) {
       auto itr_list = element_p->second->begin();
       while (itr_list != element_p->second->end()) {
         if (!predicate(*itr_list)) {
@@ -1302,6 +1511,61 @@ class BPlusTree : public BPlusTreeBase {
     return true;
   }
 
+  /**
+   * Collects the separators of the upper levels of the tree that fall in a key range, which split a scan of the range
+   * into sub-ranges of similar size. Goes down one level at a time, until it found enough separators or reached the
+   * leaves. The tree may change right after, so the separators are only a hint of where the keys are.
+   * @param low_key separators are greater than this key, or nullptr if the range has no lower bound
+   * @param high_key separators are at most this key, or nullptr if the range has no upper bound
+   * @param num_separators number of separators that are enough
+   * @return the separators, in ascending order
+   */
+  std::vector<KeyType> GetSeparators(const KeyType *low_key, const KeyType *high_key, const size_t num_separators) {
+    // Nodes are only latched one at a time, and the guard keeps the ones that writers unlink meanwhile readable
+    typename NodeReclaimer<BaseNode>::ReadGuard guard(&reclaimer_);
+    std::vector<KeyType> separators;
+    // The nodes of the current level whose keys overlap the range
+    std::vector<BaseNode *> level;
+    BaseNode *const root = root_;
+    if (root != nullptr) level.push_back(root);
+
+    while (separators.size() < num_separators && !level.empty()) {
+      std::vector<BaseNode *> children;
+      for (BaseNode *const current_node : level) {
+        if (!current_node->IsInnerNode()) continue;
+        auto node = reinterpret_cast<ElasticNode<KeyNodePointerPair> *>(current_node);
+        current_node->GetNodeSharedLatch();
+        // The low key pair points to the child below the first separator, and every separator to the child above it
+        BaseNode *child = node->GetLowKeyPair().second;
+        const KeyType *child_low_key = nullptr;
+        for (KeyNodePointerPair *element_p = node->Begin();; element_p++) {
+          const bool last = element_p == node->End();
+          // The child holds the keys from child_low_key up to the current separator
+          const bool above_low = last || low_key == nullptr || KeyCmpGreater(element_p->first, *low_key);
+          const bool child_below_high =
+              child_low_key == nullptr || high_key == nullptr || KeyCmpLessEqual(*child_low_key, *high_key);
+          if (above_low && child_below_high) children.push_back(child);
+          if (last) break;
+          if (above_low && (high_key == nullptr || KeyCmpLessEqual(element_p->first, *high_key))) {
+            separators.push_back(element_p->first);
+          }
+          child_low_key = &element_p->first;
+          child = element_p->second;
+        }
+        current_node->ReleaseNodeSharedLatch();
+      }
+      level = std::move(children);
+    }
+
+    // A separator moves up when its node splits, so the levels hold different separators that interleave
+    std::sort(separators.begin(), separators.end(),
+              [this](const KeyType &lhs, const KeyType &rhs) { return KeyCmpLess(lhs, rhs); });
+    separators.erase(std::unique(separators.begin(), separators.end(),
+                                 [this](const KeyType &lhs, const KeyType &rhs) { return KeyCmpEqual(lhs, rhs); }),
+                     separators.end());
+    return separators;
+  }
+
   /**
    * Scan Descending - Scan keys starting from high key and moves till low key, and populates a vector
    * with the values found, if they are visible to the transaction. Since there is a possibility of
@@ -1315,44 +1579,10 @@ class BPlusTree : public BPlusTreeBase {
    * @return true on success, false on failure
    */
   bool ScanDescending(KeyType index_low_key, KeyType index_high_key, std::vector<TupleSlot> *value_list) {
-    root_latch_.LockShared();
-
-    if (root_ == nullptr) {
-      root_latch_.UnlockShared();
-      return true;
-    }
-
-    BaseNode *current_node = root_;
+    BaseNode *current_node = LatchLeafForRead(&index_high_key);
+    if (current_node == nullptr) return true;
     BaseNode *parent = nullptr;
 
-    // Unlock root latch and get shared latch on root node
-    current_node->GetNodeSharedLatch();
-    root_latch_.UnlockShared();
-
-    // Traversing Down to the right leaf node
-    while (current_node->GetType() != NodeType::LeafType) {
-      auto node = reinterpret_cast<ElasticNode<KeyNodePointerPair> *>(current_node);
-      // Note that Find Location returns the location of first element
-      // that compare greater than
-      auto index_pointer = static_cast<InnerNode *>(node)->FindLocation(index_high_key, this);
-      // Thus we have to go in the left side of location which will be the
-      // pointer of the previous location.
-
-      // set parent for crabbing
-      parent = node;
-
-      if (index_pointer != node->Begin()) {
-        index_pointer -= 1;
-        current_node = index_pointer->second;
-      } else {
-        current_node = node->GetLowKeyPair().second;
-      }
-
-      // Unlock parent and get shared latch on current node
-      current_node->GetNodeSharedLatch();
-      parent->ReleaseNodeSharedLatch();
-    }
-
     auto node = reinterpret_cast<ElasticNode<KeyValuePair> *>(current_node);
     KeyValuePair *element_p;
     element_p = static_cast<LeafNode *>(node)->FindLocation(index_high_key, this);
@@ -1427,43 +1657,10 @@ class BPlusTree : public BPlusTreeBase {
    */
   bool ScanLimitDescending(KeyType index_low_key, KeyType index_high_key, std::vector<TupleSlot> *value_list,
                            uint32_t limit, std::function<bool(const ValueType)> predicate) {
-    root_latch_.LockShared();
-
-    if (root_ == nullptr) {
-      root_latch_.UnlockShared();
-      return true;
-    }
-
-    BaseNode *current_node = root_;
+    BaseNode *current_node = LatchLeafForRead(&index_high_key);
+    if (current_node == nullptr) return true;
     BaseNode *parent = nullptr;
 
-    // Release root latch and get shared latch on the root node
-    current_node->GetNodeSharedLatch();
-    root_latch_.UnlockShared();
-
-    // Traversing Down to the right leaf node
-    while (current_node->GetType() != NodeType::LeafType) {
-      auto node = reinterpret_cast<ElasticNode<KeyNodePointerPair> *>(current_node);
-      // Note that Find Location returns the location of first element
-      // that compare greater than
-      auto index_pointer = static_cast<InnerNode *>(node)->FindLocation(index_high_key, this);
-      // Thus we have to go in the left side of location which will be the
-      // pointer of the previous location.
-
-      // set parent for crabbing
-      parent = node;
-      if (index_pointer != node->Begin()) {
-        index_pointer -= 1;
-        current_node = index_pointer->second;
-      } else {
-        current_node = node->GetLowKeyPair().second;
-      }
-
-      // Unlock parent and get shared latch on current node
-      current_node->GetNodeSharedLatch();
-      parent->ReleaseNodeSharedLatch();
-    }
-
     auto node = reinterpret_cast<ElasticNode<KeyValuePair> *>(current_node);
     KeyValuePair *element_p;
     element_p = static_cast<LeafNode *>(node)->FindLocation(index_high_key, this);
@@ -1546,38 +1743,11 @@ class BPlusTree : public BPlusTreeBase {
   }
 
   /**
-   * This function adds an element in the tree
-   * The structure followed in the code is the lowKeyPointerPair's pointer represents
-   * the leftmost pointer. While for all other nodes their pointer go to a node on their
-   * right, ie containing values with keys greater than them.
-   * @param element The element to be inserted
-   * @param predicate The predicate function that should be satisfied while insertion
-   * @return true on successful insertion, false otherwise
+   * LatchLeafForWrite - Descends to the leaf that the key belongs into with shared latches, and returns the leaf with
+   * an exclusive latch. The caller must hold root_latch_ exclusively and the tree must have a root. The root latch and
+   * the latches on the way down are released.
    */
-  bool Insert(const KeyElementPair element, std::function<bool(const ValueType)> predicate) {
-    /*
-     * Try Optimistic Insert
-     * Assuming insert will not cause any overflows, get shared latch for all nodes except the
-     * leaf node. For the leaf node where insert occurs, get exclusive access.
-     */
-
-    // Get access to the Tree
-    root_latch_.LockExclusive();
-
-    if (root_ == nullptr) {
-      // If root is nullptr then we make a Leaf Node.
-      KeyNodePointerPair p1, p2;
-      p1.first = element.first;
-      p2.first = element.first;
-      p1.second = nullptr;
-      p2.second = nullptr;
-
-      root_ = ElasticNode<KeyValuePair>::Get(leaf_node_size_upper_threshold_, NodeType::LeafType, 0,
-                                             leaf_node_size_upper_threshold_, p1, p2);
-    }
-
-    // NOTE: At this point, exclusive lock to tree (root_latch_) is held.
-
+  ElasticNode<KeyValuePair> *LatchLeafForWrite(const KeyType &key) {
     BaseNode *current_node = root_;
     BaseNode *parent_node = nullptr;
 
@@ -1597,7 +1767,7 @@ class BPlusTree : public BPlusTreeBase {
       }
 
       // NOTE: FindLocation returns the location of first element that compares greater than
-      auto index_pointer = static_cast<InnerNode *>(node)->FindLocation(element.first, this);
+      auto index_pointer = static_cast<InnerNode *>(node)->FindLocation(key, this);
       // Thus we have to go in the left side of location which will be the
       // pointer of the previous location.
       if (index_pointer != node->Begin()) {
@@ -1613,8 +1783,6 @@ class BPlusTree : public BPlusTreeBase {
       current_node->GetNodeSharedLatch();
     }
 
-    // Try optimistic insertion into the leaf node, if insertion without splitting is possible.
-
     // Get current node's exclusive lock and release lock on the parent
     current_node->ReleaseNodeSharedLatch();
     current_node->GetNodeExclusiveLatch();
@@ -1623,67 +1791,90 @@ class BPlusTree : public BPlusTreeBase {
     } else {
       root_latch_.UnlockExclusive();
     }
+    return reinterpret_cast<ElasticNode<KeyValuePair> *>(current_node);
+  }
 
-    // Beyond this we only have exclusive latch on the current_node
-
-    bool finished_insertion = false;
-    // We maintain the element that we have to recursively insert up.
-    // This is the element that has to be inserted into the inner nodes.
-    auto node = reinterpret_cast<ElasticNode<KeyValuePair> *>(current_node);
+  /** Outcome of inserting into a leaf without splitting it */
+  enum class LeafInsertResult : uint8_t { INSERTED, REJECTED, FULL };
 
+  /**
+   * InsertIntoLatchedLeaf - Inserts an element into a leaf that the caller holds an exclusive latch on, unless that
+   * would split the leaf. The latch is kept.
+   * @return REJECTED if the value is already present or the predicate holds for a value of the key, FULL if a new key
+   * does not fit into the leaf, INSERTED otherwise
+   */
+  LeafInsertResult InsertIntoLatchedLeaf(ElasticNode<KeyValuePair> *node, const KeyElementPair &element,
+                                         const std::function<bool(const ValueType)> &predicate) {
     auto location_greater_key_leaf = static_cast<LeafNode *>(node)->FindLocation(element.first, this);
-    if (location_greater_key_leaf != node->Begin()) {
-      if (KeyCmpEqual((location_greater_key_leaf - 1)->first, element.first)) {
-        // Key present in tree => insert into value list
-        auto itr_list = (location_greater_key_leaf - 1)->second->begin();
-        while (itr_list != (location_greater_key_leaf - 1)->second->end()) {
-          if (ValueCmpEqual(*itr_list, element.second) || predicate(*itr_list)) {
-            // Release all locks if the value is already present
-            current_node->ReleaseNodeLatch();
-            return false;
-          }
-          itr_list++;
-        }
-        (location_greater_key_leaf - 1)->second->push_back(element.second);
-
-        // Release the latch, insertion is complete
-        current_node->ReleaseNodeLatch();
-
-        num_values_++;
-        finished_insertion = true;
+    if (location_greater_key_leaf != node->Begin() &&
+        KeyCmpEqual((location_greater_key_leaf - 1)->first, element.first)) {
+      // Key present in tree => insert into value list
+      auto value_list = (location_greater_key_leaf - 1)->second;
+      for (auto itr_list = value_list->begin(); itr_list != value_list->end(); itr_list++) {
+        if (ValueCmpEqual(*itr_list, element.second) || predicate(*itr_list)) return LeafInsertResult::REJECTED;
       }
+      value_list->push_back(element.second);
+      num_values_++;
+      return LeafInsertResult::INSERTED;
     }
 
-    // Insertion not done yet as key is not present
-    if (!finished_insertion) {
-      auto value_list = new std::list<ValueType>();
-      value_list->push_back(element.second);
-      KeyValuePair key_list_value;
-      key_list_value.first = element.first;
-      key_list_value.second = value_list;
-      if (node->InsertElementIfPossible(key_list_value,
-                                        static_cast<LeafNode *>(node)->FindLocation(element.first, this))) {
-        // If you can directly insert in the leaf - Insertion is over
-        finished_insertion = true;
-        // Insertion is done, release the latch
-        current_node->ReleaseNodeLatch();
-        num_keys_++;
-        num_values_++;
-      } else {
-        delete value_list;
-      }
-      // Otherwise, split the node
-      // Optimistic approach failed
+    auto value_list = new std::list<ValueType>();
+    value_list->push_back(element.second);
+    KeyValuePair key_list_value;
+    key_list_value.first = element.first;
+    key_list_value.second = value_list;
+    if (!node->InsertElementIfPossible(key_list_value, location_greater_key_leaf)) {
+      delete value_list;
+      return LeafInsertResult::FULL;
     }
+    num_keys_++;
+    num_values_++;
+    return LeafInsertResult::INSERTED;
+  }
 
-    if (!finished_insertion) {
-      // Optimistic approach failed. Release the latch, and start grabbing
-      // exclusive latches.
-      current_node->ReleaseNodeLatch();
-    } else {
-      return true;
+  /**
+   * This function adds an element in the tree
+   * The structure followed in the code is the lowKeyPointerPair's pointer represents
+   * the leftmost pointer. While for all other nodes their pointer go to a node on their
+   * right, ie containing values with keys greater than them.
+   * @param element The element to be inserted
+   * @param predicate The predicate function that should be satisfied while insertion
+   * @return true on successful insertion, false otherwise
+   */
+  bool Insert(const KeyElementPair element, std::function<bool(const ValueType)> predicate) {
+    /*
+     * Try Optimistic Insert
+     * Assuming insert will not cause any overflows, get shared latch for all nodes except the
+     * leaf node. For the leaf node where insert occurs, get exclusive access.
+     */
+
+    // Get access to the Tree
+    root_latch_.LockExclusive();
+
+    if (root_ == nullptr) {
+      // If root is nullptr then we make a Leaf Node.
+      KeyNodePointerPair p1, p2;
+      p1.first = element.first;
+      p2.first = element.first;
+      p1.second = nullptr;
+      p2.second = nullptr;
+
+      root_ = ElasticNode<KeyValuePair>::Get(leaf_node_size_upper_threshold_, NodeType::LeafType, 0,
+                                             leaf_node_size_upper_threshold_, p1, p2);
     }
 
+    // Try optimistic insertion into the leaf node, if insertion without splitting is possible.
+    auto node = LatchLeafForWrite(element.first);
+    const LeafInsertResult optimistic_result = InsertIntoLatchedLeaf(node, element, predicate);
+
+    // Otherwise, the optimistic approach failed. Release the latch, and start grabbing exclusive latches.
+    node->ReleaseNodeLatch();
+    if (optimistic_result != LeafInsertResult::FULL) return optimistic_result == LeafInsertResult::INSERTED;
+
+    BaseNode *current_node;
+    bool finished_insertion;
+    KeyValuePair *location_greater_key_leaf;
+
     /*
      ****************************************
       if not successful -> pessimistic insert
@@ -1824,7 +2015,8 @@ class BPlusTree : public BPlusTreeBase {
         inner_node_element.second = splitted_node;
       }
 
-      current_node->ReleaseNodeLatch();
+      // A split root stays latched until the new root is published, so that readers do not descend from it
+      if (finished_insertion || current_node != root_) current_node->ReleaseNodeLatch();
       num_keys_++;
       num_values_++;
     }
@@ -1856,24 +2048,27 @@ class BPlusTree : public BPlusTreeBase {
         inner_node_element.second = splitted_node;
         splitted_node->PopBegin();
       }
-      inner_node->ReleaseNodeLatch();
+      if (finished_insertion || inner_node != root_) inner_node->ReleaseNodeLatch();
     }
 
     // If still insertion is not finished we have to split the root node.
     // Remember the root must have been split by now.
     if (!finished_insertion) {
       NOISEPAGE_ASSERT(got_root_latch, "Root Latch should be held here");
-      auto old_root = root_;
+      BaseNode *const old_root = root_;
       KeyNodePointerPair p1, p2;
       p1.first = inner_node_element.first; /* This is a dummy initialization */
       p2.first = inner_node_element.first; /* This is a dummy initialization */
       p1.second = old_root;                /* This initialization matters */
       p2.second = nullptr;                 /* This is a dummy initialization */
-      root_ = ElasticNode<KeyNodePointerPair>::Get(inner_node_size_upper_threshold_, NodeType::InnerType,
-                                                   root_->GetDepth() + 1, inner_node_size_upper_threshold_, p1, p2);
-      auto new_root_node = reinterpret_cast<ElasticNode<KeyNodePointerPair> *>(root_);
+      auto new_root_node = ElasticNode<KeyNodePointerPair>::Get(inner_node_size_upper_threshold_, NodeType::InnerType,
+                                                                old_root->GetDepth() + 1,
+                                                                inner_node_size_upper_threshold_, p1, p2);
       new_root_node->InsertElementIfPossible(
           inner_node_element, static_cast<InnerNode *>(new_root_node)->FindLocation(inner_node_element.first, this));
+      // Readers may find the new root as soon as it is published, so it is filled first
+      root_ = new_root_node;
+      old_root->ReleaseNodeLatch();
     }
 
     if (got_root_latch) {
@@ -1884,6 +2079,99 @@ class BPlusTree : public BPlusTreeBase {
     return true;
   }
 
+  /**
+   * BulkLoad - Builds the tree bottom-up from elements sorted by key. Leaves are packed with consecutive keys and
+   * linked to their siblings, then each level of inner nodes is built over the level below it, until a level fits in
+   * a single root. Nodes are filled to BULK_LOAD_FILL_FACTOR of their capacity, so that the first inserts after loading
+   * do not split every node they touch, and never below the lower thresholds.
+   *
+   * NOTE: The tree must be empty, and must not be accessed concurrently while it is loaded.
+   * @param elements key-value pairs sorted by key. Elements with equal keys share a value list.
+   */
+  void BulkLoad(const std::vector<KeyElementPair> &elements) {
+    NOISEPAGE_ASSERT(root_ == nullptr, "Only an empty tree can be bulk loaded");
+    if (elements.empty()) return;
+
+    // Group the values of equal keys
+    std::vector<KeyValuePair> key_values;
+    for (const auto &element : elements) {
+      NOISEPAGE_ASSERT(key_values.empty() || KeyCmpLessEqual(key_values.back().first, element.first),
+                       "Elements must be sorted by key");
+      if (key_values.empty() || !KeyCmpEqual(key_values.back().first, element.first)) {
+        key_values.emplace_back(element.first, new std::list<ValueType>());
+      }
+      key_values.back().second->push_back(element.second);
+    }
+
+    // Each level holds the nodes along with the smallest key below them, which the level above uses as separators
+    std::vector<KeyNodePointerPair> level;
+    const auto leaf_ranges = BulkLoadRanges(static_cast<int>(key_values.size()), leaf_node_size_lower_threshold_,
+                                            leaf_node_size_upper_threshold_);
+    ElasticNode<KeyValuePair> *previous_leaf = nullptr;
+    for (const auto &range : leaf_ranges) {
+      KeyNodePointerPair p1, p2;
+      p1.first = key_values[range.first].first;
+      p2.first = key_values[range.first].first;
+      p1.second = previous_leaf;
+      p2.second = nullptr;
+      auto *leaf = ElasticNode<KeyValuePair>::Get(leaf_node_size_upper_threshold_, NodeType::LeafType, 0,
+                                                  leaf_node_size_upper_threshold_, p1, p2);
+      for (int i = range.first; i < range.second; i++) leaf->InsertElementIfPossible(key_values[i], leaf->End());
+      if (previous_leaf != nullptr) previous_leaf->GetElasticHighKeyPair()->second = leaf;
+      previous_leaf = leaf;
+      level.emplace_back(key_values[range.first].first, leaf);
+    }
+
+    // An inner node with n elements has n + 1 children
+    for (int depth = 1; level.size() > 1; depth++) {
+      std::vector<KeyNodePointerPair> parents;
+      const auto inner_ranges = BulkLoadRanges(static_cast<int>(level.size()), inner_node_size_lower_threshold_ + 1,
+                                               inner_node_size_upper_threshold_ + 1);
+      for (const auto &range : inner_ranges) {
+        KeyNodePointerPair p1, p2;
+        p1.first = level[range.first].first;
+        p2.first = level[range.first].first;
+        p1.second = level[range.first].second;
+        p2.second = nullptr;
+        auto *inner = ElasticNode<KeyNodePointerPair>::Get(inner_node_size_upper_threshold_, NodeType::InnerType, depth,
+                                                           inner_node_size_upper_threshold_, p1, p2);
+        for (int i = range.first + 1; i < range.second; i++) inner->InsertElementIfPossible(level[i], inner->End());
+        parents.emplace_back(level[range.first].first, inner);
+      }
+      level = std::move(parents);
+    }
+
+    // Publish the root last, under the root latch, so that the tree only becomes visible once it is complete
+    root_latch_.LockExclusive();
+    num_keys_ += key_values.size();
+    num_values_ += elements.size();
+    root_ = level.front().second;
+    root_latch_.UnlockExclusive();
+  }
+
+  /**
+   * BulkLoadRanges - Splits num_items consecutive items into ranges of one node each, for BulkLoad. The ranges are as
+   * even as possible, and hold at least min_items and at most max_items unless all items fit in a single node.
+   */
+  std::vector<std::pair<int, int>> BulkLoadRanges(const int num_items, const int min_items, const int max_items) const {
+    const int target = std::max(min_items, static_cast<int>(max_items * BULK_LOAD_FILL_FACTOR));
+    int num_nodes = std::max(1, (num_items + target - 1) / target);
+    while (num_nodes > 1 && num_items / num_nodes < min_items) num_nodes--;
+    NOISEPAGE_ASSERT(num_nodes == 1 || (num_items + num_nodes - 1) / num_nodes <= max_items,
+                     "The thresholds leave no way to split the items into nodes");
+
+    std::vector<std::pair<int, int>> ranges;
+    ranges.reserve(num_nodes);
+    int start = 0;
+    for (int i = 0; i < num_nodes; i++) {
+      // The first num_items % num_nodes nodes hold one more item
+      const int end = start + num_items / num_nodes + (i < num_items % num_nodes ? 1 : 0);
+      ranges.emplace_back(start, end);
+      start = end;
+    }
+    return ranges;
+  }
+
   /**
    * DeleteRebalance - Function that deletes and rebalances the tree by borrowing from siblings or by
    * merging nodes.
@@ -2116,8 +2404,8 @@ class BPlusTree : public BPlusTreeBase {
       input_child_pointer->ReleaseNodeLatch();
       left_sibling_base_node->ReleaseNodeLatch();
 
-      child->FreeElasticNode();
       parent->Erase(index);
+      RetireNode(child);
 
     } else {
       BaseNode *right_sibling_base_node = (parent->Begin() + index + 1)->second;
@@ -2163,21 +2451,64 @@ class BPlusTree : public BPlusTreeBase {
       input_child_pointer->ReleaseNodeLatch();
       right_sibling_base_node->ReleaseNodeLatch();
 
-      right_sibling->FreeElasticNode();
       parent->Erase(index + 1);
+      RetireNode(right_sibling);
     }
   }
 
   /**
    * RelaseLastLocksDelete - Releases the node's latch and pops it from the list
    */
-  void RelaseLastLocksDelete(std::vector<common::SharedLatch *> *lock_list) {
+  void RelaseLastLocksDelete(std::vector<NodeLatch *> *lock_list) {
     if (!lock_list->empty()) {
       (*lock_list->rbegin())->UnlockExclusive();
       lock_list->pop_back();
     }
   }
 
+  /**
+   * InsertElements - Inserts a batch of elements that no predicate applies to, see Insert.
+   *
+   * The elements are inserted in ascending key order, so that elements which fall into the same leaf share one
+   * descent. After an element is inserted, the leaf stays latched for the next element for as long as its key is no
+   * greater than the leaf's last key. An element that does not fit into the leaf any more is inserted on its own, which
+   * splits the leaf.
+   * @param elements elements to insert, sorted by key
+   * @return number of elements that were inserted, the others were already present
+   */
+  uint64_t InsertElements(const std::vector<KeyElementPair> &elements) {
+    const std::function<bool(const ValueType)> never = [](const ValueType) { return false; };
+    uint64_t num_inserted = 0;
+    ElasticNode<KeyValuePair> *leaf = nullptr;
+    for (const auto &element : elements) {
+      if (leaf != nullptr && (leaf->GetSize() == 0 || KeyCmpGreater(element.first, (leaf->End() - 1)->first))) {
+        leaf->ReleaseNodeLatch();
+        leaf = nullptr;
+      }
+      if (leaf == nullptr) {
+        root_latch_.LockExclusive();
+        if (root_ == nullptr) {
+          root_latch_.UnlockExclusive();
+          if (Insert(element, never)) num_inserted++;
+          continue;
+        }
+        leaf = LatchLeafForWrite(element.first);
+      }
+
+      const LeafInsertResult result = InsertIntoLatchedLeaf(leaf, element, never);
+      if (result == LeafInsertResult::FULL) {
+        leaf->ReleaseNodeLatch();
+        leaf = nullptr;
+        if (Insert(element, never)) num_inserted++;
+      } else if (result == LeafInsertResult::INSERTED) {
+        num_inserted++;
+      }
+    }
+
+    if (leaf != nullptr) leaf->ReleaseNodeLatch();
+    return num_inserted;
+  }
+
   /**
    * This function tries to perform optimistic deletion of an element, if not possible, performs
    * pessimistic deletion and rebalances the tree. If the element is not found, it returns false.
@@ -2322,7 +2653,7 @@ class BPlusTree : public BPlusTreeBase {
      ****************************************
     */
 
-    std::vector<common::SharedLatch *> lock_list;
+    std::vector<NodeLatch *> lock_list;
     root_latch_.LockExclusive();
     lock_list.push_back(&root_latch_);
     bool is_deleted = Delete(root_, element, &lock_list);
@@ -2337,7 +2668,7 @@ class BPlusTree : public BPlusTreeBase {
    * exist. Return true if delete succeeds
    *
    */
-  bool Delete(BaseNode *current_node, const KeyElementPair &element, std::vector<common::SharedLatch *> *lock_list) {
+  bool Delete(BaseNode *current_node, const KeyElementPair &element, std::vector<NodeLatch *> *lock_list) {
     // If tree is empty, return false
     if (current_node == nullptr) {
       return false;
@@ -2414,14 +2745,16 @@ class BPlusTree : public BPlusTreeBase {
           // If now the list is empty delete key-emptylist from the tree
           delete leaf_position->second;
           bool is_deleted = node->Erase(leaf_position - node->Begin());
-          if (is_deleted && node->GetSize() == 0) {
+          const bool tree_emptied = is_deleted && node->GetSize() == 0;
+          if (tree_emptied) {
             // All elements of tree are now deleted
-            node->FreeElasticNode();  // Important - we need to free node
             root_ = nullptr;
           }
 
           // Release the lock
           RelaseLastLocksDelete(lock_list);
+          // Important - we need to free node
+          if (tree_emptied) RetireNode(node);
           num_values_--;
           num_keys_--;
 
@@ -2470,7 +2803,7 @@ class BPlusTree : public BPlusTreeBase {
 
           // Release the lock and free the node
           RelaseLastLocksDelete(lock_list);
-          node->FreeElasticNode();
+          RetireNode(node);
           return true;
         }
 
@@ -2494,6 +2827,11 @@ class BPlusTree : public BPlusTreeBase {
    */
   uint64_t GetSize() { return num_keys_; }
 
+  /**
+   * @return true if the tree has no nodes yet, which BulkLoad requires
+   */
+  bool IsEmpty() const { return root_ == nullptr; }
+
   /**
    * Returns the estimated heap usage of the B+ Tree. This function returns an estimate. For the
    * actual heap usage, GetHeapUsage() can be used.
@@ -2505,7 +2843,7 @@ class BPlusTree : public BPlusTreeBase {
       return 0;
     }
 
-    auto depth = root_->GetDepth();
+    auto depth = root_.load()->GetDepth();
     size_t heap_usage = (depth * GetInnerNodeSizeLowerThreshold() *
                          sizeof(KeyNodePointerPair)) +  // InnerNode size (assuming half full)
                         (num_keys_ * sizeof(KeyType)) +
@@ -29,6 +29,13 @@ class BPlusTreeIndex final : public Index {
  private:
   explicit BPlusTreeIndex(IndexMetadata &&metadata);
 
+  // Sub-ranges of an ascending scan, delimited by separators of the B+ Tree, see PartitionAscending
+  class ScanPartitions;
+
+  // Builds the keys of the entries, sorted by key
+  std::vector<std::pair<KeyType, TupleSlot>> SortedElements(
+      const std::vector<std::pair<const ProjectedRow *, TupleSlot>> &entries) const;
+
   const std::unique_ptr<BPlusTree<KeyType, TupleSlot,
                                   std::less<KeyType>,      // NOLINT transparent functors can't figure out template
                                   std::equal_to<KeyType>,  // NOLINT transparent functors can't figure out template
@@ -43,6 +50,11 @@ class BPlusTreeIndex final : public Index {
    */
   IndexType Type() const final { return IndexType::BPLUSTREE; }
 
+  /**
+   * Frees the nodes that the B+ Tree unlinked and that no reader can reach any more.
+   */
+  void PerformGarbageCollection() final;
+
   /**
    * @return approximate number of bytes allocated on the heap for this index data structure
    */
@@ -69,6 +81,34 @@ class BPlusTreeIndex final : public Index {
   bool InsertUnique(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple,
                     TupleSlot location) final;
 
+  /**
+   * Sorts the entries by key and builds the B+ Tree bottom-up from them, which is much cheaper than inserting them one
+   * at a time. If the tree already holds entries, they are inserted one at a time instead.
+   * @param txn txn context for the calling txn, used to register abort actions
+   * @param entries keys and their values, in any order
+   * @return false if the index is unique and a key repeats, in which case nothing is loaded and the txn must abort
+   */
+  bool BulkLoad(common::ManagedPointer<transaction::TransactionContext> txn,
+                const std::vector<std::pair<const ProjectedRow *, TupleSlot>> &entries) final;
+
+  /**
+   * Sorts the entries by key and inserts them in key order, so that consecutive entries in the same leaf share one
+   * descent. Registers a single abort action for the whole batch.
+   * @param txn txn context for the calling txn, used to register abort actions
+   * @param entries keys and their values, in any order
+   */
+  void InsertBatch(common::ManagedPointer<transaction::TransactionContext> txn,
+                   const std::vector<std::pair<const ProjectedRow *, TupleSlot>> &entries) final;
+
+  /**
+   * Registers a single commit action for the whole batch, which registers a deferred action for the GC that deletes
+   * the entries in key order.
+   * @param txn txn context for the calling txn, used to register commit actions for deferred GC actions
+   * @param entries keys and their values, in any order
+   */
+  void DeleteBatch(common::ManagedPointer<transaction::TransactionContext> txn,
+                   const std::vector<std::pair<const ProjectedRow *, TupleSlot>> &entries) final;
+
   /**
    * Doesn't immediately call delete on the index. Registers a commit action in the txn that will eventually register a
    * deferred action for the GC to safely call delete on the index when no more transactions need to access the key.
@@ -88,6 +128,15 @@ class BPlusTreeIndex final : public Index {
   void ScanKey(const transaction::TransactionContext &txn, const ProjectedRow &key,
                std::vector<TupleSlot> *value_list) final;
 
+  /**
+   * Probes the keys in ascending order, so that keys in the same leaf share one descent of the B+ Tree.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param keys the keys to look for
+   * @param[out] value_lists the values associated with keys[i] are placed in (*value_lists)[i]
+   */
+  void ScanKeyBatch(const transaction::TransactionContext &txn, const std::vector<const ProjectedRow *> &keys,
+                    std::vector<std::vector<TupleSlot>> *value_lists) final;
+
   /**
    * Finds all the values between the given keys in our index, sorted in ascending order.
    * @param txn txn context for the calling txn, used for visibility checks
@@ -102,6 +151,19 @@ class BPlusTreeIndex final : public Index {
                      ProjectedRow *low_key, ProjectedRow *high_key, uint32_t limit,
                      std::vector<TupleSlot> *value_list) final;
 
+  /**
+   * Splits the range of an ascending scan at separators of the upper levels of the B+ Tree.
+   * @param scan_type Scan Type
+   * @param num_attrs Number of attributes to compare
+   * @param low_key the key to start at
+   * @param high_key the key to end at
+   * @param max_partitions number of sub-ranges to split the range into at most
+   * @return the sub-ranges
+   */
+  std::unique_ptr<IndexScanPartitions> PartitionAscending(ScanType scan_type, uint32_t num_attrs,
+                                                          ProjectedRow *low_key, ProjectedRow *high_key,
+                                                          uint32_t max_partitions) final;
+
   /**
    * Finds all the values between the given keys in our index, sorted in descending order.
    * @param txn txn context for the calling txn, used for visibility checks
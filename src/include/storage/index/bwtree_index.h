@@ -1,7 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>  // NOLINT
 #include <functional>
 #include <memory>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
@@ -36,6 +39,9 @@ class BwTreeIndex final : public Index {
  private:
   explicit BwTreeIndex(IndexMetadata metadata);
 
+  // Sub-ranges of an ascending scan, delimited by separators of the BwTree, see PartitionAscending
+  class ScanPartitions;
+
   const std::unique_ptr<third_party::bwtree::BwTree<
       KeyType, TupleSlot, std::less<KeyType>,  // NOLINT transparent functors can't figure out template
       std::equal_to<KeyType>,                  // NOLINT transparent functors can't figure out template
@@ -43,7 +49,18 @@ class BwTreeIndex final : public Index {
       bwtree_;
   mutable common::SpinLatch transaction_context_latch_;  // latch used to protect transaction context
 
+  // The BwTree's epoch manager expects a single thread to perform garbage collection at a time, but both the
+  // GarbageCollector and the maintenance thread do
+  common::SpinLatch epoch_gc_latch_;
+  std::atomic<bool> run_maintenance_ = false;
+  std::thread maintenance_thread_;
+
  public:
+  /**
+   * Stops the background maintenance thread, if there is one.
+   */
+  ~BwTreeIndex() override;
+
   /**
    * @return type of the index. Note that this is the physical type, not extracted from the underlying schema or other
    * catalog metadata. This is mostly used for debugging purposes.
@@ -55,6 +72,24 @@ class BwTreeIndex final : public Index {
    */
   void PerformGarbageCollection() final;
 
+  /**
+   * Starts a thread that consolidates the delta chains that reached half of the length at which workers consolidate
+   * them, and then invokes garbage collection, every period. Hot nodes are then mostly consolidated in the background
+   * instead of by the worker that happens to exceed the threshold.
+   * @param period sleep time between maintenance passes
+   */
+  void StartBackgroundMaintenance(std::chrono::microseconds period) final;
+
+  /**
+   * Stops the thread started by StartBackgroundMaintenance, if there is one.
+   */
+  void StopBackgroundMaintenance() final;
+
+  /**
+   * @return the consolidations of delta chains since the last call to this function
+   */
+  IndexMaintenanceStats CollectMaintenanceStats() final;
+
   /**
    * @return approximate number of bytes allocated on the heap for this index data structure
    */
@@ -81,6 +116,16 @@ class BwTreeIndex final : public Index {
   bool InsertUnique(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple,
                     TupleSlot location) final;
 
+  /**
+   * Sorts the entries by key and inserts them in key order, so that consecutive inserts land in the same leaf delta
+   * chain and the leaves split left to right. The BwTree has no bottom-up build.
+   * @param txn txn context for the calling txn, used to register abort actions
+   * @param entries keys and their values, in any order
+   * @return false if the index is unique and a key repeats, in which case nothing is loaded and the txn must abort
+   */
+  bool BulkLoad(common::ManagedPointer<transaction::TransactionContext> txn,
+                const std::vector<std::pair<const ProjectedRow *, TupleSlot>> &entries) final;
+
   /**
    * Doesn't immediately call delete on the index. Registers a commit action in the txn that will eventually register a
    * deferred action for the GC to safely call delete on the index when no more transactions need to access the key.
@@ -100,6 +145,16 @@ class BwTreeIndex final : public Index {
   void ScanKey(const transaction::TransactionContext &txn, const ProjectedRow &key,
                std::vector<TupleSlot> *value_list) final;
 
+  /**
+   * Probes the keys in ascending order, so that consecutive lookups descend through the same, already cached,
+   * nodes of the BwTree.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param keys the keys to look for
+   * @param[out] value_lists the values associated with keys[i] are placed in (*value_lists)[i]
+   */
+  void ScanKeyBatch(const transaction::TransactionContext &txn, const std::vector<const ProjectedRow *> &keys,
+                    std::vector<std::vector<TupleSlot>> *value_lists) final;
+
   /**
    * Finds all the values between the given keys in our index, sorted in ascending order.
    * @param txn txn context for the calling txn, used for visibility checks
@@ -114,6 +169,19 @@ class BwTreeIndex final : public Index {
                      ProjectedRow *low_key, ProjectedRow *high_key, uint32_t limit,
                      std::vector<TupleSlot> *value_list) final;
 
+  /**
+   * Splits the range of an ascending scan at separators of the upper levels of the BwTree.
+   * @param scan_type Scan Type
+   * @param num_attrs Number of attributes to compare
+   * @param low_key the key to start at
+   * @param high_key the key to end at
+   * @param max_partitions number of sub-ranges to split the range into at most
+   * @return the sub-ranges
+   */
+  std::unique_ptr<IndexScanPartitions> PartitionAscending(ScanType scan_type, uint32_t num_attrs,
+                                                          ProjectedRow *low_key, ProjectedRow *high_key,
+                                                          uint32_t max_partitions) final;
+
   /**
    * Finds all the values between the given keys in our index, sorted in descending order.
    * @param txn txn context for the calling txn, used for visibility checks
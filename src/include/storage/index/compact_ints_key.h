@@ -140,6 +140,26 @@ class CompactIntsKey {
     return true;
   }
 
+  /**
+   * Number of bytes that EncodeBinaryComparable writes at most
+   */
+  static constexpr uint32_t MAX_BINARY_COMPARABLE_SIZE = KeySize;
+
+  /**
+   * Writes the first num_attrs attributes of the key as bytes that order like the key under std::memcmp. The key
+   * already stores its integers big-endian with flipped sign bits, so this copies the bytes of those attributes.
+   * @param metadata index information, primarily attribute sizes and offsets
+   * @param num_attrs number of attributes to write
+   * @param[out] out buffer of at least MAX_BINARY_COMPARABLE_SIZE bytes
+   * @return number of bytes written
+   */
+  uint32_t EncodeBinaryComparable(const IndexMetadata &metadata, size_t num_attrs, byte *out) const {
+    NOISEPAGE_ASSERT(num_attrs > 0 && num_attrs <= metadata.GetAttributeSizes().size(), "num_attrs invariant failed");
+    const uint32_t size = metadata.GetCompactIntsOffsets()[num_attrs - 1] + metadata.GetAttributeSizes()[num_attrs - 1];
+    std::memcpy(out, key_data_, size);
+    return size;
+  }
+
  private:
   byte key_data_[KeySize];
 
@@ -0,0 +1,344 @@
+#pragma once
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "common/constants.h"
+#include "common/hash_util.h"
+#include "common/macros.h"
+#include "common/shared_latch.h"
+#include "storage/storage_defs.h"
+
+namespace noisepage::storage::index {
+
+/**
+ * Concurrent hash table that maps keys to lists of TupleSlots, built for HashIndex.
+ *
+ * The table is split into shards by the high bits of the hash, and every shard is an open addressing table behind its
+ * own reader-writer latch. Slots are probed in groups of 16: every slot has a one byte tag made of 7 bits of the hash,
+ * and a single SSE2 comparison finds the slots of a group whose tags match, so most probes compare one key at most.
+ *
+ * A key's first two values are stored inline in its slot, so only keys with more duplicates allocate memory for their
+ * values. When a shard fills up it does not rehash all at once: it allocates the new table and every later write to
+ * the shard moves a few groups of the old table over, while lookups search both tables until the move is done.
+ * @tparam KeyType the type of keys stored in the table
+ * @tparam Hash hash function for keys
+ * @tparam KeyEqual equality of keys
+ */
+template <typename KeyType, typename Hash = std::hash<KeyType>, typename KeyEqual = std::equal_to<KeyType>>
+class ConcurrentHashTable {
+ public:
+  /**
+   * @param hash hash function for keys
+   * @param key_equal equality of keys
+   */
+  explicit ConcurrentHashTable(Hash hash = Hash(), KeyEqual key_equal = KeyEqual())
+      : hash_(std::move(hash)), key_equal_(std::move(key_equal)) {}
+
+  DISALLOW_COPY_AND_MOVE(ConcurrentHashTable)
+
+  /**
+   * Adds a value to the values of a key. Checking the existing values and adding the new one is atomic.
+   * @param key key to add the value to
+   * @param value value to add
+   * @param predicate called on the existing values of the key, and the value is not added if it returns true for any
+   * @return false if the value already exists or the predicate returned true for an existing value, true otherwise
+   */
+  bool Insert(const KeyType &key, const TupleSlot value, const std::function<bool(TupleSlot)> &predicate) {
+    const uint64_t hash = HashKey(key);
+    Shard *const shard = &shards_[ShardOf(hash)];
+    common::SharedLatch::ScopedExclusiveLatch guard(&shard->latch_);
+    MigrateSome(shard);
+
+    Entry *entry = Find(shard, key, hash);
+    if (entry != nullptr) {
+      const TupleSlot *const begin = entry->Values();
+      const TupleSlot *const end = begin + entry->num_values_;
+      if (std::find(begin, end, value) != end || std::any_of(begin, end, predicate)) return false;
+      AddValue(shard, entry, value);
+      return true;
+    }
+
+    Table *table = shard->table_.get();
+    if (table == nullptr || table->num_used_ >= table->MaxUsed()) table = Grow(shard);
+    entry = Claim(table, hash);
+    entry->key_ = key;
+    entry->inline_values_[0] = value;
+    entry->num_values_ = 1;
+    shard->num_keys_++;
+    return true;
+  }
+
+  /**
+   * Removes a value from the values of a key, and the key once it has no values left.
+   * @param key key to remove the value from
+   * @param value value to remove
+   * @return false if the key did not have the value, true otherwise
+   */
+  bool Erase(const KeyType &key, const TupleSlot value) {
+    const uint64_t hash = HashKey(key);
+    Shard *const shard = &shards_[ShardOf(hash)];
+    common::SharedLatch::ScopedExclusiveLatch guard(&shard->latch_);
+    MigrateSome(shard);
+
+    Table *table;
+    uint32_t slot;
+    if (!Locate(shard, key, hash, &table, &slot)) return false;
+    Entry *const entry = &table->entries_[slot];
+    if (!RemoveValue(shard, entry, value)) return false;
+    if (entry->num_values_ == 0) {
+      Release(table, slot);
+      shard->num_keys_--;
+    }
+    return true;
+  }
+
+  /**
+   * @param key key to look up
+   * @param[out] values the values of the key are appended here
+   */
+  void Lookup(const KeyType &key, std::vector<TupleSlot> *const values) const {
+    const uint64_t hash = HashKey(key);
+    const Shard &shard = shards_[ShardOf(hash)];
+    common::SharedLatch::ScopedSharedLatch guard(&shard.latch_);
+    const Entry *const entry = Find(&shard, key, hash);
+    if (entry == nullptr) return;
+    values->insert(values->end(), entry->Values(), entry->Values() + entry->num_values_);
+  }
+
+  /** @return number of keys in the table */
+  uint64_t GetSize() const {
+    uint64_t size = 0;
+    for (const auto &shard : shards_) {
+      common::SharedLatch::ScopedSharedLatch guard(&shard.latch_);
+      size += shard.num_keys_;
+    }
+    return size;
+  }
+
+  /** @return number of bytes allocated for the slots and for the values that did not fit inline */
+  size_t GetHeapUsage() const {
+    size_t usage = 0;
+    for (const auto &shard : shards_) {
+      common::SharedLatch::ScopedSharedLatch guard(&shard.latch_);
+      if (shard.table_ != nullptr) usage += shard.table_->Capacity() * (sizeof(Entry) + 1);
+      if (shard.old_table_ != nullptr) usage += shard.old_table_->Capacity() * (sizeof(Entry) + 1);
+      usage += shard.num_overflow_values_ * sizeof(TupleSlot);
+    }
+    return usage;
+  }
+
+ private:
+  static constexpr uint32_t NUM_SHARDS = 16;
+  static constexpr uint32_t SHARD_BITS = 4;
+  static constexpr uint32_t GROUP_SIZE = 16;
+  static constexpr uint32_t INLINE_VALUES = 2;
+  // Groups of the old table that every write moves to the new table while a shard grows
+  static constexpr uint32_t MIGRATE_GROUPS_PER_WRITE = 4;
+  // Tags of used slots are the low 7 bits of the hash, so they never collide with these
+  static constexpr uint8_t EMPTY = 0x80;
+  static constexpr uint8_t DELETED = 0xFE;
+
+  static_assert((1U << SHARD_BITS) == NUM_SHARDS, "Shards are picked by the high bits of the hash.");
+
+  struct Entry {
+    KeyType key_;
+    uint32_t num_values_ = 0;
+    TupleSlot inline_values_[INLINE_VALUES];
+    // Holds all values instead of inline_values_ once a key has more than INLINE_VALUES values
+    std::unique_ptr<std::vector<TupleSlot>> overflow_;
+
+    TupleSlot *Values() { return overflow_ == nullptr ? inline_values_ : overflow_->data(); }
+    const TupleSlot *Values() const { return overflow_ == nullptr ? inline_values_ : overflow_->data(); }
+  };
+
+  struct Table {
+    explicit Table(const uint32_t num_groups)
+        : num_groups_(num_groups),
+          tags_(new uint8_t[num_groups * GROUP_SIZE]),
+          entries_(new Entry[num_groups * GROUP_SIZE]) {
+      std::memset(tags_.get(), EMPTY, num_groups * GROUP_SIZE);
+    }
+
+    uint32_t Capacity() const { return num_groups_ * GROUP_SIZE; }
+    // Slots that are used or deleted make probes longer, so both count towards the load factor of 7/8
+    uint32_t MaxUsed() const { return Capacity() - Capacity() / 8; }
+
+    // Bitmask of the slots in a group whose tag is the given one
+    uint32_t Match(const uint32_t group, const uint8_t tag) const {
+      const __m128i tags = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&tags_[group * GROUP_SIZE]));
+      return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(tags, _mm_set1_epi8(static_cast<char>(tag)))));
+    }
+
+    const uint32_t num_groups_;
+    // Slots that are used or deleted, and slots that are used
+    uint32_t num_used_ = 0;
+    uint32_t num_full_ = 0;
+    const std::unique_ptr<uint8_t[]> tags_;
+    const std::unique_ptr<Entry[]> entries_;
+  };
+
+  struct alignas(common::Constants::CACHELINE_SIZE) Shard {
+    mutable common::SharedLatch latch_;
+    std::unique_ptr<Table> table_;
+    // Table that is being moved into table_, every key is in exactly one of the two
+    std::unique_ptr<Table> old_table_;
+    uint32_t migrated_groups_ = 0;
+    uint64_t num_keys_ = 0;
+    uint64_t num_overflow_values_ = 0;
+  };
+
+  uint64_t HashKey(const KeyType &key) const { return common::HashUtil::ScrambleHash(hash_(key)); }
+  static uint32_t ShardOf(const uint64_t hash) { return static_cast<uint32_t>(hash >> (64 - SHARD_BITS)); }
+  static uint8_t TagOf(const uint64_t hash) { return static_cast<uint8_t>(hash & 0x7F); }
+  static uint32_t FirstGroup(const Table &table, const uint64_t hash) {
+    return static_cast<uint32_t>(hash >> 7) & (table.num_groups_ - 1);
+  }
+
+  // Probes the groups of a table until one has an empty slot, which ends every probe sequence that passed it
+  bool LocateIn(const Table &table, const KeyType &key, const uint64_t hash, uint32_t *const slot) const {
+    const uint8_t tag = TagOf(hash);
+    uint32_t group = FirstGroup(table, hash);
+    for (uint32_t i = 0; i < table.num_groups_; i++) {
+      for (uint32_t mask = table.Match(group, tag); mask != 0; mask &= mask - 1) {
+        const uint32_t candidate = group * GROUP_SIZE + __builtin_ctz(mask);
+        if (key_equal_(table.entries_[candidate].key_, key)) {
+          *slot = candidate;
+          return true;
+        }
+      }
+      if (table.Match(group, EMPTY) != 0) return false;
+      group = (group + 1) & (table.num_groups_ - 1);
+    }
+    return false;
+  }
+
+  bool Locate(const Shard *const shard, const KeyType &key, const uint64_t hash, Table **const table,
+              uint32_t *const slot) const {
+    for (Table *const candidate : {shard->table_.get(), shard->old_table_.get()}) {
+      if (candidate != nullptr && LocateIn(*candidate, key, hash, slot)) {
+        *table = candidate;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  Entry *Find(const Shard *const shard, const KeyType &key, const uint64_t hash) const {
+    Table *table;
+    uint32_t slot;
+    return Locate(shard, key, hash, &table, &slot) ? &table->entries_[slot] : nullptr;
+  }
+
+  // Takes the first empty or deleted slot on the probe sequence of the hash. The key must not be in the table.
+  static Entry *Claim(Table *const table, const uint64_t hash) {
+    uint32_t group = FirstGroup(*table, hash);
+    while (true) {
+      const uint32_t mask = table->Match(group, EMPTY) | table->Match(group, DELETED);
+      if (mask != 0) {
+        const uint32_t slot = group * GROUP_SIZE + __builtin_ctz(mask);
+        if (table->tags_[slot] == EMPTY) table->num_used_++;
+        table->num_full_++;
+        table->tags_[slot] = TagOf(hash);
+        return &table->entries_[slot];
+      }
+      group = (group + 1) & (table->num_groups_ - 1);
+    }
+  }
+
+  static void Release(Table *const table, const uint32_t slot) {
+    const uint32_t group = slot / GROUP_SIZE;
+    // If the group still has an empty slot, no probe sequence ever went past it, so the slot can become empty as well
+    if (table->Match(group, EMPTY) != 0) {
+      table->tags_[slot] = EMPTY;
+      table->num_used_--;
+    } else {
+      table->tags_[slot] = DELETED;
+    }
+    table->num_full_--;
+    table->entries_[slot].overflow_.reset();
+  }
+
+  static void AddValue(Shard *const shard, Entry *const entry, const TupleSlot value) {
+    if (entry->overflow_ == nullptr && entry->num_values_ < INLINE_VALUES) {
+      entry->inline_values_[entry->num_values_++] = value;
+      return;
+    }
+    if (entry->overflow_ == nullptr) {
+      entry->overflow_ = std::make_unique<std::vector<TupleSlot>>(entry->inline_values_,
+                                                                  entry->inline_values_ + entry->num_values_);
+      shard->num_overflow_values_ += entry->num_values_;
+    }
+    entry->overflow_->emplace_back(value);
+    entry->num_values_++;
+    shard->num_overflow_values_++;
+  }
+
+  static bool RemoveValue(Shard *const shard, Entry *const entry, const TupleSlot value) {
+    TupleSlot *const values = entry->Values();
+    TupleSlot *const end = values + entry->num_values_;
+    TupleSlot *const it = std::find(values, end, value);
+    if (it == end) return false;
+    // Values are not ordered, so the last one fills the gap
+    *it = *(end - 1);
+    entry->num_values_--;
+    if (entry->overflow_ == nullptr) return true;
+
+    entry->overflow_->pop_back();
+    shard->num_overflow_values_--;
+    if (entry->num_values_ <= INLINE_VALUES) {
+      std::copy(entry->overflow_->begin(), entry->overflow_->end(), entry->inline_values_);
+      shard->num_overflow_values_ -= entry->num_values_;
+      entry->overflow_.reset();
+    }
+    return true;
+  }
+
+  // Starts moving the shard into a new table, which is twice as large unless most used slots were deleted
+  Table *Grow(Shard *const shard) {
+    if (shard->table_ == nullptr) {
+      shard->table_ = std::make_unique<Table>(1);
+      return shard->table_.get();
+    }
+    // The previous move has to be done first, but it only is this far behind if the shard was mostly erased meanwhile
+    while (shard->old_table_ != nullptr) MigrateSome(shard);
+
+    Table *const table = shard->table_.get();
+    const bool double_size = table->num_full_ >= table->Capacity() / 2;
+    shard->old_table_ = std::move(shard->table_);
+    shard->table_ = std::make_unique<Table>(double_size ? table->num_groups_ * 2 : table->num_groups_);
+    shard->migrated_groups_ = 0;
+    return shard->table_.get();
+  }
+
+  void MigrateSome(Shard *const shard) {
+    Table *const old_table = shard->old_table_.get();
+    if (old_table == nullptr) return;
+
+    const uint32_t end = std::min(shard->migrated_groups_ + MIGRATE_GROUPS_PER_WRITE, old_table->num_groups_);
+    for (uint32_t group = shard->migrated_groups_; group < end; group++) {
+      for (uint32_t slot = group * GROUP_SIZE; slot < (group + 1) * GROUP_SIZE; slot++) {
+        const uint8_t tag = old_table->tags_[slot];
+        if (tag == EMPTY || tag == DELETED) continue;
+        Entry *const entry = &old_table->entries_[slot];
+        *Claim(shard->table_.get(), HashKey(entry->key_)) = std::move(*entry);
+        // Deleted rather than empty, so that lookups in the old table still probe past this slot
+        old_table->tags_[slot] = DELETED;
+        old_table->num_full_--;
+      }
+    }
+    shard->migrated_groups_ = end;
+    if (end == old_table->num_groups_) shard->old_table_.reset();
+  }
+
+  const Hash hash_;
+  const KeyEqual key_equal_;
+  Shard shards_[NUM_SHARDS];
+};
+
+}  // namespace noisepage::storage::index
@@ -19,7 +19,9 @@ constexpr uint16_t GENERICKEY_MAX_SIZE = 512;
 
 /**
  * GenericKey is a slower key type than CompactIntsKey for use when the constraints of CompactIntsKey make it
- * unsuitable. For example, GenericKey supports VARLEN and NULLable attributes.
+ * unsuitable. For example, GenericKey supports VARLEN and NULLable attributes. Next to the ProjectedRow, every key
+ * keeps the first 8 bytes of its first attribute's binary-comparable encoding, which settles most comparisons of keys
+ * with distinct first attributes without dispatching on the attribute types.
  * @tparam KeySize number of bytes for the key's internal buffer
  */
 template <uint16_t KeySize>
@@ -82,6 +84,8 @@ class GenericKey {
       // We recast GetProjectedRow() as a workaround for -Wclass-memaccess
       std::memcpy(static_cast<void *>(GetProjectedRow()), &from, from.Size());
     }
+
+    normalized_prefix_ = ComputeNormalizedPrefix(metadata);
   }
 
   /**
@@ -104,6 +108,12 @@ class GenericKey {
     return *metadata_;
   }
 
+  /**
+   * @return the first bytes of the first attribute's binary-comparable encoding packed big-endian. Keys whose prefixes
+   * differ order like their prefixes, so comparators only need to look at the attributes when the prefixes are equal.
+   */
+  uint64_t GetNormalizedPrefix() const { return normalized_prefix_; }
+
   /**
    * Utility class to evaluate comparisons of embedded types within a ProjectedRow. This is not exposed somewhere like
    * type/type_util.h becauase these do not enforce SQL comparison semantics (i.e. NULL comparisons evaluate to NULL).
@@ -207,6 +217,9 @@ class GenericKey {
     UNUSED_ATTRIBUTE const auto &key_cols = key_schema.GetColumns();
     NOISEPAGE_ASSERT(num_attrs > 0 && num_attrs <= key_cols.size(), "Invalid num_attrs for generic key");
 
+    // the first attribute decides whenever the prefixes of its encodings differ
+    if (normalized_prefix_ != rhs.GetNormalizedPrefix()) return normalized_prefix_ < rhs.GetNormalizedPrefix();
+
     for (uint16_t i = 0; i < num_attrs; i++) {
       const auto *const lhs_pr = GetProjectedRow();
       const auto *const rhs_pr = rhs.GetProjectedRow();
@@ -246,7 +259,131 @@ class GenericKey {
     return true;
   }
 
+  /**
+   * Number of bytes that EncodeBinaryComparable writes at most. Every attribute takes at most twice the bytes it takes
+   * in the key's ProjectedRow.
+   */
+  static constexpr uint32_t MAX_BINARY_COMPARABLE_SIZE = 2 * KeySize;
+
+  /**
+   * Writes the first num_attrs attributes of the key as bytes that order like the key under std::memcmp, so that the
+   * key can be stored in a radix tree. Every attribute starts with a byte that is 0 for NULL, which sorts NULL first,
+   * and 1 otherwise. Integers follow big-endian with flipped sign bits, and REAL follows as its bits with the sign bit
+   * flipped for positive values and all bits flipped for negative values. Varlens follow with every 0 byte escaped as
+   * 0 0xFF and end with 0 0, so that no encoded key is a prefix of another. DECIMAL has no encoding, so the binder
+   * refuses ART indexes on it.
+   * @param metadata index information, key_schema used to interpret PR data correctly
+   * @param num_attrs number of attributes to write
+   * @param[out] out buffer of at least MAX_BINARY_COMPARABLE_SIZE bytes
+   * @return number of bytes written
+   */
+  uint32_t EncodeBinaryComparable(const IndexMetadata &metadata, size_t num_attrs, byte *out) const {
+    const auto &key_cols = metadata.GetSchema().GetColumns();
+    NOISEPAGE_ASSERT(num_attrs > 0 && num_attrs <= key_cols.size(), "Invalid num_attrs for generic key");
+    const auto *const pr = GetProjectedRow();
+    auto *const bytes = reinterpret_cast<uint8_t *>(out);
+    uint32_t size = 0;
+
+    for (uint16_t i = 0; i < num_attrs; i++) {
+      const byte *const attr = pr->AccessWithNullCheck(pr->ColumnIds()[i].UnderlyingValue());
+      if (attr == nullptr) {
+        bytes[size++] = 0;
+        continue;
+      }
+      bytes[size++] = 1;
+      const uint32_t attr_size = EncodeAttribute(key_cols[i].Type(), attr, UINT32_MAX, bytes + size);
+      if (attr_size == 0) {
+        throw std::runtime_error("Unknown TypeId in noisepage::storage::index::GenericKey::EncodeBinaryComparable.");
+      }
+      size += attr_size;
+    }
+
+    NOISEPAGE_ASSERT(size <= MAX_BINARY_COMPARABLE_SIZE, "Encoded key is larger than expected.");
+    return size;
+  }
+
  private:
+  // Number of bytes of the first attribute's binary-comparable encoding that every key keeps next to its ProjectedRow
+  static constexpr uint32_t NORMALIZED_PREFIX_SIZE = sizeof(uint64_t);
+
+  // Writes the binary-comparable encoding of a non-NULL attribute without its NULL byte, but stops a varlen after the
+  // first content byte that reaches max_size. Returns the number of bytes written, or 0 for an unknown type.
+  static uint32_t EncodeAttribute(const type::TypeId type_id, const byte *const attr, const uint32_t max_size,
+                                  uint8_t *const out) {
+    switch (type_id) {
+      case type::TypeId::BOOLEAN:
+      case type::TypeId::TINYINT:
+        return EncodeSigned(*reinterpret_cast<const int8_t *>(attr), out);
+      case type::TypeId::SMALLINT:
+        return EncodeSigned(*reinterpret_cast<const int16_t *>(attr), out);
+      case type::TypeId::INTEGER:
+        return EncodeSigned(*reinterpret_cast<const int32_t *>(attr), out);
+      case type::TypeId::BIGINT:
+        return EncodeSigned(*reinterpret_cast<const int64_t *>(attr), out);
+      case type::TypeId::DATE:
+        return EncodeUnsigned(*reinterpret_cast<const uint32_t *>(attr), sizeof(uint32_t), out);
+      case type::TypeId::TIMESTAMP:
+        return EncodeUnsigned(*reinterpret_cast<const uint64_t *>(attr), sizeof(uint64_t), out);
+      case type::TypeId::REAL: {
+        // -0.0 compares equal to 0.0, so it must encode the same
+        const double stored_value = *reinterpret_cast<const double *>(attr);
+        const double value = stored_value == 0.0 ? 0.0 : stored_value;
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        constexpr uint64_t sign_bit = uint64_t{1} << 63;
+        return EncodeUnsigned((bits & sign_bit) != 0 ? ~bits : bits | sign_bit, sizeof(uint64_t), out);
+      }
+      case type::TypeId::VARCHAR:
+      case type::TypeId::VARBINARY: {
+        const uint32_t varlen_size = *reinterpret_cast<const uint32_t *>(attr);
+        const auto *const content = reinterpret_cast<const uint8_t *>(attr + sizeof(uint32_t));
+        uint32_t size = 0;
+        for (uint32_t j = 0; j < varlen_size; j++) {
+          if (size >= max_size) return size;
+          out[size++] = content[j];
+          if (content[j] == 0) out[size++] = 0xFF;
+        }
+        out[size++] = 0;
+        out[size++] = 0;
+        return size;
+      }
+      default:
+        return 0;
+    }
+  }
+
+  // Packs the first NORMALIZED_PREFIX_SIZE bytes of the first attribute's encoding big-endian, zero-padded, so that
+  // comparing two prefixes as integers orders like std::memcmp on the encodings. Unknown types keep only the NULL byte
+  // and therefore always fall back to the comparators.
+  uint64_t ComputeNormalizedPrefix(const IndexMetadata &metadata) const {
+    const auto *const pr = GetProjectedRow();
+    const byte *const attr = pr->AccessWithNullCheck(pr->ColumnIds()[0].UnderlyingValue());
+    // Room for the NULL byte and a varlen that stops on an escaped byte past the prefix, plus its terminator
+    uint8_t bytes[2 * NORMALIZED_PREFIX_SIZE + 4] = {};
+    if (attr != nullptr) {
+      bytes[0] = 1;
+      EncodeAttribute(metadata.GetSchema().GetColumns()[0].Type(), attr, NORMALIZED_PREFIX_SIZE, bytes + 1);
+    }
+    uint64_t prefix = 0;
+    for (uint32_t i = 0; i < NORMALIZED_PREFIX_SIZE; i++) prefix = (prefix << 8) | bytes[i];
+    return prefix;
+  }
+
+  // Writes the lowest num_bytes bytes of the value big-endian
+  static uint32_t EncodeUnsigned(const uint64_t value, const uint32_t num_bytes, uint8_t *const out) {
+    for (uint32_t i = 0; i < num_bytes; i++) {
+      out[i] = static_cast<uint8_t>(value >> (8 * (num_bytes - 1 - i)));
+    }
+    return num_bytes;
+  }
+
+  // Flips the sign bit, so that negative values order before positive ones
+  template <typename IntType>
+  static uint32_t EncodeSigned(const IntType value, uint8_t *const out) {
+    constexpr uint64_t sign_bit = uint64_t{1} << (8 * sizeof(IntType) - 1);
+    return EncodeUnsigned(static_cast<uint64_t>(static_cast<int64_t>(value)) ^ sign_bit, sizeof(IntType), out);
+  }
+
   ProjectedRow *GetProjectedRow() {
     auto *pr = reinterpret_cast<ProjectedRow *>(StorageUtil::AlignedPtr(sizeof(uint64_t), key_data_));
     NOISEPAGE_ASSERT(reinterpret_cast<uintptr_t>(pr) % sizeof(uint64_t) == 0,
@@ -258,6 +395,7 @@ class GenericKey {
 
   byte key_data_[KeySize];
   const IndexMetadata *metadata_ = nullptr;
+  uint64_t normalized_prefix_ = 0;
 };
 
 extern template class GenericKey<64>;
@@ -317,6 +455,9 @@ struct equal_to<noisepage::storage::index::GenericKey<KeySize>> {
    */
   bool operator()(const noisepage::storage::index::GenericKey<KeySize> &lhs,
                   const noisepage::storage::index::GenericKey<KeySize> &rhs) const {
+    // equal first attributes always have equal prefixes
+    if (lhs.GetNormalizedPrefix() != rhs.GetNormalizedPrefix()) return false;
+
     const auto &key_schema = lhs.GetIndexMetadata().GetSchema();
 
     const auto &key_cols = key_schema.GetColumns();
@@ -373,6 +514,11 @@ struct less<noisepage::storage::index::GenericKey<KeySize>> {
    */
   bool operator()(const noisepage::storage::index::GenericKey<KeySize> &lhs,
                   const noisepage::storage::index::GenericKey<KeySize> &rhs) const {
+    // the first attribute decides whenever the prefixes of its encodings differ
+    const uint64_t lhs_prefix = lhs.GetNormalizedPrefix();
+    const uint64_t rhs_prefix = rhs.GetNormalizedPrefix();
+    if (lhs_prefix != rhs_prefix) return lhs_prefix < rhs_prefix;
+
     const auto &key_schema = lhs.GetIndexMetadata().GetSchema();
     const auto &key_cols = key_schema.GetColumns();
 
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <atomic>
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <memory>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -16,6 +20,46 @@ class TransactionContext;
 
 namespace noisepage::storage::index {
 
+/**
+ * Disjoint sub-ranges of the key range of an ascending scan, in key order. Each one can be scanned on its own and in
+ * parallel with the others, and concatenating their results in order gives the result of the whole scan.
+ */
+class IndexScanPartitions {
+ public:
+  virtual ~IndexScanPartitions() = default;
+
+  /** @return number of sub-ranges */
+  virtual uint32_t NumPartitions() const = 0;
+
+  /**
+   * Finds all the values of a sub-range, sorted in ascending order.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param partition index of the sub-range, below NumPartitions()
+   * @param[out] value_list the values associated with the keys
+   */
+  virtual void Scan(const transaction::TransactionContext &txn, uint32_t partition,
+                    std::vector<TupleSlot> *value_list) const = 0;
+
+ protected:
+  /**
+   * Keeps at most max_separators of the given separators, evenly spaced, so that the sub-ranges they delimit stay of
+   * similar size
+   * @tparam KeyType type of the separators
+   * @param[in,out] separators separators in ascending order
+   * @param max_separators number of separators to keep at most
+   */
+  template <typename KeyType>
+  static void ThinSeparators(std::vector<KeyType> *const separators, const uint32_t max_separators) {
+    if (separators->size() <= max_separators) return;
+    std::vector<KeyType> kept;
+    kept.reserve(max_separators);
+    for (uint32_t i = 1; i <= max_separators; i++) {
+      kept.push_back((*separators)[i * separators->size() / (max_separators + 1)]);
+    }
+    *separators = std::move(kept);
+  }
+};
+
 /**
  * Wrapper class for the various types of indexes in our system. Semantically, we expect updates on indexed attributes
  * to be modeled as a delete and an insert (see bwtree_index_test.cpp CommitUpdate1, CommitUpdate2, etc.). This
@@ -30,6 +74,8 @@ class Index {
   friend class IndexKeyTests;
   friend class storage::RecoveryManager;
 
+  std::atomic<uint64_t> num_modifications_ = 0;
+
  protected:
   /**
    * Cached metadata that allows for performance optimizations in the index keys.
@@ -53,6 +99,15 @@ class Index {
    */
   explicit Index(IndexMetadata metadata) : metadata_(std::move(metadata)) {}
 
+  /**
+   * Counts keys physically inserted into or deleted from the underlying structure, which may leave garbage behind for
+   * PerformGarbageCollection
+   * @param num_modifications number of keys inserted or deleted
+   */
+  void RecordModifications(const uint64_t num_modifications = 1) {
+    num_modifications_.fetch_add(num_modifications, std::memory_order_relaxed);
+  }
+
  public:
   virtual ~Index() = default;
 
@@ -70,6 +125,32 @@ class Index {
    */
   virtual void PerformGarbageCollection() {}
 
+  /** @return number of keys inserted or deleted since the last call to TakeModifications */
+  uint64_t GetNumModifications() const { return num_modifications_.load(std::memory_order_relaxed); }
+
+  /**
+   * Resets the modification counter, once the garbage collector has visited the index
+   * @return number of keys inserted or deleted since the last call to this function
+   */
+  uint64_t TakeModifications() { return num_modifications_.exchange(0, std::memory_order_relaxed); }
+
+  /**
+   * Starts a thread that maintains the index in the background every period, e.g. by consolidating long delta chains
+   * before workers run into them. For most underlying index types this is a no-op.
+   * @param period sleep time between maintenance passes
+   */
+  virtual void StartBackgroundMaintenance(std::chrono::microseconds period) {}
+
+  /**
+   * Stops the thread started by StartBackgroundMaintenance, if there is one.
+   */
+  virtual void StopBackgroundMaintenance() {}
+
+  /**
+   * @return the maintenance work since the last call to this function
+   */
+  virtual IndexMaintenanceStats CollectMaintenanceStats() { return {}; }
+
   /**
    * @return approximate number of bytes allocated on the heap for this index data structure
    */
@@ -96,6 +177,52 @@ class Index {
   virtual bool InsertUnique(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple,
                             TupleSlot location) = 0;
 
+  /**
+   * Fills an empty index with many key-value pairs at once, for example when an index is built over an existing table.
+   * The entries may come in any order. Indexes that support it sort them and build their structure bottom-up instead of
+   * inserting them one at a time, which is what this default implementation does. The index must not be accessed
+   * concurrently while it is loaded.
+   * @param txn txn context for the calling txn, used to register abort actions
+   * @param entries keys and the values to associate with them. For a unique index, the tuples should be the ones
+   * visible to the calling txn.
+   * @return true if all entries were inserted. false if the index is unique and two entries share a key, in which case
+   * the calling txn must abort.
+   */
+  virtual bool BulkLoad(common::ManagedPointer<transaction::TransactionContext> txn,
+                        const std::vector<std::pair<const ProjectedRow *, TupleSlot>> &entries) {
+    const bool unique = metadata_.GetSchema().Unique();
+    for (const auto &entry : entries) {
+      const bool inserted =
+          unique ? InsertUnique(txn, *entry.first, entry.second) : Insert(txn, *entry.first, entry.second);
+      if (!inserted) return false;
+    }
+    return true;
+  }
+
+  /**
+   * Inserts many key-value pairs into a non-unique index, see Insert. Indexes that support it sort the entries and
+   * insert them in key order, so that entries which fall into the same part of the index share one traversal. This
+   * default implementation inserts them one at a time.
+   * @param txn txn context for the calling txn, used to register abort actions
+   * @param entries keys and the values to associate with them, in any order
+   */
+  virtual void InsertBatch(common::ManagedPointer<transaction::TransactionContext> txn,
+                           const std::vector<std::pair<const ProjectedRow *, TupleSlot>> &entries) {
+    NOISEPAGE_ASSERT(!metadata_.GetSchema().Unique(), "InsertBatch is designed for indexes without uniqueness.");
+    for (const auto &entry : entries) Insert(txn, *entry.first, entry.second);
+  }
+
+  /**
+   * Deletes many key-value pairs, see Delete. Indexes that support it register a single deferred action for the whole
+   * batch, which removes the entries in key order. This default implementation deletes them one at a time.
+   * @param txn txn context for the calling txn, used to register commit actions for deferred GC actions
+   * @param entries keys and the values associated with them, in any order
+   */
+  virtual void DeleteBatch(common::ManagedPointer<transaction::TransactionContext> txn,
+                           const std::vector<std::pair<const ProjectedRow *, TupleSlot>> &entries) {
+    for (const auto &entry : entries) Delete(txn, *entry.first, entry.second);
+  }
+
   /**
    * Doesn't immediately call delete on the index. Registers a commit action in the txn that will eventually register a
    * deferred action for the GC to safely call delete on the index when no more transactions need to access the key.
@@ -115,6 +242,20 @@ class Index {
   virtual void ScanKey(const transaction::TransactionContext &txn, const ProjectedRow &key,
                        std::vector<TupleSlot> *value_list) = 0;
 
+  /**
+   * Finds all the values associated with each key of a batch, see ScanKey. Indexes that probe a batch of keys faster
+   * than one key at a time override this.
+   * @param txn txn context for the calling txn, used for visibility checks
+   * @param keys the keys to look for
+   * @param[out] value_lists the values associated with keys[i] are placed in (*value_lists)[i]
+   */
+  virtual void ScanKeyBatch(const transaction::TransactionContext &txn, const std::vector<const ProjectedRow *> &keys,
+                            std::vector<std::vector<TupleSlot>> *value_lists) {
+    NOISEPAGE_ASSERT(value_lists->empty(), "Result set should begin empty.");
+    value_lists->resize(keys.size());
+    for (uint64_t i = 0; i < keys.size(); i++) ScanKey(txn, *keys[i], &(*value_lists)[i]);
+  }
+
   /**
    * Finds all the values between the given keys in our index, sorted in ascending order.
    * @param txn txn context for the calling txn, used for visibility checks
@@ -156,6 +297,24 @@ class Index {
     NOISEPAGE_ASSERT(false, "You called a method on an index type that hasn't implemented it.");
   }
 
+  /**
+   * Splits the range of an ascending scan into sub-ranges that hold similar numbers of keys, so that they can be
+   * scanned in parallel. The split follows the separators of the upper levels of the index, and only reflects the
+   * index at the time of the call, but the sub-ranges always cover exactly the range.
+   * @param scan_type Scan Type
+   * @param num_attrs Number of attributes to compare
+   * @param low_key the key to start at
+   * @param high_key the key to end at
+   * @param max_partitions number of sub-ranges to split the range into at most
+   * @return the sub-ranges, or nullptr if the index cannot split ranges, in which case the range should be scanned as
+   * a whole with ScanAscending
+   */
+  virtual std::unique_ptr<IndexScanPartitions> PartitionAscending(ScanType scan_type, uint32_t num_attrs,
+                                                                  ProjectedRow *low_key, ProjectedRow *high_key,
+                                                                  uint32_t max_partitions) {
+    return nullptr;
+  }
+
   /**
    * @return mapping from key oid to projected row offset
    */
@@ -37,6 +37,10 @@ class IndexBuilder {
 
   Index *BuildBPlusTreeGenericKey(IndexMetadata metadata) const;
 
+  Index *BuildArtIntsKey(IndexMetadata metadata) const;
+
+  Index *BuildArtGenericKey(IndexMetadata metadata) const;
+
   Index *BuildHashIntsKey(IndexMetadata metadata) const;
 
   Index *BuildHashGenericKey(IndexMetadata metadata) const;
@@ -9,7 +9,7 @@ namespace noisepage::storage::index {
  * This enum indicates the backing implementation that should be used for the index.  It is a character enum in order
  * to better match PostgreSQL's look and feel when persisted through the catalog.
  */
-enum class IndexType : char { BWTREE = 'B', HASHMAP = 'H', BPLUSTREE = 'P' };
+enum class IndexType : char { BWTREE = 'B', HASHMAP = 'H', BPLUSTREE = 'P', ART = 'A' };
 
 /**
  * Internal enum to stash with the index to represent its key type. We don't need to persist this.
@@ -29,4 +29,19 @@ enum class ScanType : uint8_t {
   OpenBoth  /* [begin(), end()] range scan */
 };
 
+/**
+ * Work an index did to keep itself compact, counted since the last time the stats were collected. Index types that do
+ * not consolidate anything report all zeros.
+ */
+struct IndexMaintenanceStats {
+  /** number of delta chains or nodes that were consolidated, including the ones in background_consolidations_ */
+  uint64_t consolidations_ = 0;
+  /** number of consolidations that a background maintenance thread did instead of a worker */
+  uint64_t background_consolidations_ = 0;
+  /** total length of the consolidated delta chains */
+  uint64_t consolidated_deltas_ = 0;
+  /** length of the longest consolidated delta chain */
+  uint64_t longest_chain_ = 0;
+};
+
 }  // namespace noisepage::storage::index
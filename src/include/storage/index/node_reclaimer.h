@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/constants.h"
+#include "common/macros.h"
+#include "common/spin_latch.h"
+
+namespace noisepage::storage::index {
+
+/**
+ * Frees the nodes that a concurrent index unlinked, once no reader that traverses the index without latches can still
+ * reach them.
+ *
+ * Readers announce themselves with a ReadGuard for as long as they may hold pointers into the index. Unlinked nodes
+ * are freed in batches: Reclaim moves the nodes retired so far into the next batch and starts a new epoch, and a later
+ * call frees them once the readers that entered before the new epoch are done. Readers count themselves in one of a
+ * few cache line aligned shards, so that readers on different threads do not write to the same cache line.
+ * @tparam NodeType type of the nodes of the index
+ */
+template <typename NodeType>
+class NodeReclaimer {
+ private:
+  // Number of shards that readers announce themselves in
+  static constexpr uint32_t NUM_READER_SHARDS = 16;
+
+  // Aligned so that readers on different threads do not write to the same cache line
+  struct alignas(common::Constants::CACHELINE_SIZE) ReaderShard {
+    // Number of readers in the shard that entered during an even and an odd epoch
+    std::array<std::atomic<uint64_t>, 2> active_ = {};
+  };
+
+ public:
+  /**
+   * Announces a reader for as long as it lives, so that the nodes it may reach are not freed under it.
+   */
+  class ReadGuard {
+   public:
+    /**
+     * @param reclaimer reclaimer of the index that is read
+     */
+    explicit ReadGuard(NodeReclaimer *reclaimer) {
+      ReaderShard &shard = reclaimer->reader_shards_[ReaderShardIndex()];
+      // The reader only counts for the epoch it entered if the epoch did not change while it was entering. Otherwise
+      // Reclaim may already have checked the shard for that epoch.
+      while (true) {
+        const uint64_t epoch = reclaimer->epoch_.load();
+        active_ = &shard.active_[epoch & 1];
+        active_->fetch_add(1);
+        if (reclaimer->epoch_.load() == epoch) break;
+        active_->fetch_sub(1);
+      }
+    }
+
+    ~ReadGuard() { active_->fetch_sub(1); }
+
+    DISALLOW_COPY_AND_MOVE(ReadGuard)
+
+   private:
+    std::atomic<uint64_t> *active_;
+  };
+
+  /**
+   * @param free_node function that frees the memory of a node
+   */
+  explicit NodeReclaimer(void (*free_node)(NodeType *)) : free_node_(free_node) {}
+
+  /**
+   * Frees all nodes that are still retired. The index must not be read any more.
+   */
+  ~NodeReclaimer() { FreeAll(); }
+
+  DISALLOW_COPY_AND_MOVE(NodeReclaimer)
+
+  /**
+   * Frees a node that was unlinked from the index once no reader can reach it any more
+   * @param node node that no new reader can reach
+   */
+  void Retire(NodeType *node) {
+    {
+      common::SpinLatch::ScopedSpinLatch guard(&latch_);
+      retired_nodes_.push_back(node);
+    }
+    Reclaim();
+  }
+
+  /**
+   * Frees the retired nodes that no reader can reach any more. Retire calls this, so calling it separately only
+   * matters to free the last batch.
+   */
+  void Reclaim() {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    if (!draining_nodes_.empty()) {
+      for (const auto &shard : reader_shards_) {
+        if (shard.active_[draining_parity_].load() != 0) return;
+      }
+      for (auto *const node : draining_nodes_) free_node_(node);
+      draining_nodes_.clear();
+    }
+    if (retired_nodes_.empty()) return;
+    draining_nodes_.swap(retired_nodes_);
+    draining_parity_ = epoch_.fetch_add(1) & 1;
+  }
+
+  /**
+   * Frees all retired nodes regardless of readers. The index must not be read concurrently.
+   */
+  void FreeAll() {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    for (auto *const node : draining_nodes_) free_node_(node);
+    draining_nodes_.clear();
+    for (auto *const node : retired_nodes_) free_node_(node);
+    retired_nodes_.clear();
+  }
+
+ private:
+  // Threads keep using the same shard
+  static uint32_t ReaderShardIndex() {
+    static thread_local const size_t thread_hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return static_cast<uint32_t>(thread_hash % NUM_READER_SHARDS);
+  }
+
+  void (*const free_node_)(NodeType *);
+  std::array<ReaderShard, NUM_READER_SHARDS> reader_shards_;
+  std::atomic<uint64_t> epoch_ = 0;
+  // Protects the retired nodes
+  common::SpinLatch latch_;
+  // Nodes retired since the epoch last changed
+  std::vector<NodeType *> retired_nodes_;
+  // Nodes retired before the epoch last changed, which are freed once the readers that entered before the change are
+  // done
+  std::vector<NodeType *> draining_nodes_;
+  uint64_t draining_parity_ = 0;
+};
+
+}  // namespace noisepage::storage::index
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <vector>
+
+#include "catalog/index_schema.h"
+#include "common/managed_pointer.h"
+#include "storage/storage_defs.h"
+
+namespace noisepage::transaction {
+class TimestampManager;
+class TransactionContext;
+class TransactionManager;
+}  // namespace noisepage::transaction
+
+namespace noisepage::storage {
+class SqlTable;
+}  // namespace noisepage::storage
+
+namespace noisepage::storage::index {
+
+class Index;
+
+/**
+ * Fills a new index with the tuples of its table while the table keeps being written to, in the manner of CREATE INDEX
+ * CONCURRENTLY.
+ *
+ * The index is marked invalid in pg_index and published in the catalog before the build starts. From then on, writers
+ * that see it in the catalog keep it up to date like every other index of the table, while lookups still ignore it. The build
+ * waits for the transactions that began before the index was published. Those writers do not know about the index, so
+ * their writes have to be visible to the scan. Then several workers scan disjoint ranges of blocks, each with a
+ * snapshot of its own, and insert the keys of the tuples they see.
+ *
+ * Writers that committed before a worker took its snapshot may already have added their tuples, so the workers look
+ * every key up before inserting it. The workers' transactions stay open until all of them are done, which keeps the
+ * build from racing with writers that commit after the snapshots were taken. A tuple inserted by such a writer is not
+ * seen by the workers, and the writer itself adds its key. The key of a deleted tuple is removed by a deferred action
+ * of the writer, which only runs once the snapshots that may still see the tuple are done. So once the workers commit,
+ * the index holds every tuple, and the caller can mark it valid in the catalog. Validity is a pg_index column, so an
+ * index whose build was cut short by a crash stays invalid after recovery, and on replicas until the primary marks it.
+ */
+class OnlineIndexBuilder {
+ public:
+  /**
+   * Creates a builder for an index of the table
+   * @param timestamp_manager timestamp manager of the system, used to wait for older transactions
+   * @param txn_manager transaction manager of the system
+   * @param table the table the index is on
+   * @param index the index to fill. It should be empty, and already marked invalid and published in the catalog.
+   * @param schema key schema of the index, whose keys are plain columns of the table
+   */
+  OnlineIndexBuilder(common::ManagedPointer<transaction::TimestampManager> timestamp_manager,
+                     common::ManagedPointer<transaction::TransactionManager> txn_manager,
+                     common::ManagedPointer<SqlTable> table, common::ManagedPointer<Index> index,
+                     const catalog::IndexSchema &schema);
+
+  /**
+   * Fills the index. It does not block writers of the table, but waits for all transactions that
+   * began before it was called, so the calling thread must not have a transaction running.
+   *
+   * A build in the background can be throttled to leave the CPU to foreground work. Every worker then pauses after
+   * each batch of tuples it scanned, for as long as it takes to keep its time spent working at the given share.
+   * @param num_workers number of threads that scan the table
+   * @param cpu_share share of their time that the workers spend working, in (0, 1]
+   * @return true if the index was built, and can be marked valid. false if a unique index found two visible tuples with
+   * the same key, or a key that a concurrent transaction is writing. The build can then be retried, or the index
+   * dropped. The failed build takes its entries back out of the index.
+   */
+  bool Build(uint32_t num_workers, double cpu_share = 1.0);
+
+ private:
+  // Scans the blocks [start_block, end_block) of the table with the txn, and inserts the keys of the visible tuples.
+  // Returns false if a unique insert failed.
+  bool BuildRange(common::ManagedPointer<transaction::TransactionContext> txn, uint32_t start_block,
+                  uint32_t end_block, double cpu_share) const;
+
+  const common::ManagedPointer<transaction::TimestampManager> timestamp_manager_;
+  const common::ManagedPointer<transaction::TransactionManager> txn_manager_;
+  const common::ManagedPointer<SqlTable> table_;
+  const common::ManagedPointer<Index> index_;
+  const catalog::IndexSchema &schema_;
+  // Columns of the table that make up the keys, without duplicates
+  std::vector<catalog::col_oid_t> key_col_oids_;
+};
+
+}  // namespace noisepage::storage::index
@@ -122,6 +122,15 @@ class PACKED ProjectedRow {
     return reinterpret_cast<byte *>(this) + AttrValueOffsets()[offset];
   }
 
+  /**
+   * @param offset The 0-indexed element to access in this ProjectedRow
+   * @return offset, in bytes, of the attribute from the start of the ProjectedRow, whether or not it is null
+   */
+  uint32_t AttrValueOffset(const uint16_t offset) const {
+    NOISEPAGE_ASSERT(offset < num_cols_, "Column offset out of bounds.");
+    return AttrValueOffsets()[offset];
+  }
+
   /**
    * Set the attribute in the ProjectedRow to be null using the internal bitmap
    * @param offset The 0-indexed element to access in this ProjectedRow
@@ -2,6 +2,7 @@
 #include <vector>
 
 #include "common/constants.h"
+#include "common/memory_accountant.h"
 #include "common/object_pool.h"
 #include "common/strong_typedef.h"
 #include "storage/undo_record.h"
@@ -42,6 +43,16 @@ class RecordBufferSegment {
     return result;
   }
 
+  /**
+   * Gives back the space of the record that was reserved last.
+   *
+   * @param record pointer to the head of the record that was reserved last
+   */
+  void Unreserve(const byte *const record) {
+    NOISEPAGE_ASSERT(record >= bytes_ && record < bytes_ + size_, "record is not in this segment");
+    size_ = static_cast<uint32_t>(record - bytes_);
+  }
+
   /**
    * Clears the buffer segment.
    *
@@ -161,6 +172,7 @@ class RecordBufferSegmentAllocator {
   RecordBufferSegment *New() {
     auto *result = new RecordBufferSegment;
     NOISEPAGE_ASSERT(reinterpret_cast<uintptr_t>(result) % 8 == 0, "buffer segments should be aligned to 8 bytes");
+    common::MemoryAccountant::Allocate(common::MemoryComponent::RECORD_BUFFERS, sizeof(RecordBufferSegment));
     return result;
   }
 
@@ -174,7 +186,10 @@ class RecordBufferSegmentAllocator {
    * Delete the given buffer segment and frees the memory
    * @param ptr the buffer to delete
    */
-  void Delete(RecordBufferSegment *const ptr) { delete ptr; }
+  void Delete(RecordBufferSegment *const ptr) {
+    common::MemoryAccountant::Free(common::MemoryComponent::RECORD_BUFFERS, sizeof(RecordBufferSegment));
+    delete ptr;
+  }
 };
 
 /**
@@ -305,11 +320,33 @@ class UndoBuffer {
    */
   byte *NewEntry(uint32_t size);
 
+  /**
+   * Reserve up to the given number of undo records of the same size that are contiguous in memory, so that a batch of
+   * records only pays for one buffer segment check. Fewer records are reserved if the current segment runs out of
+   * space, and the caller asks again for the rest.
+   * @param size the size of every undo record to allocate
+   * @param max_count the maximum number of undo records to reserve, at least 1
+   * @param[out] count the number of undo records reserved, at least 1
+   * @return the first of the new undo records, the others follow it at intervals of size
+   */
+  byte *NewEntries(uint32_t size, uint32_t max_count, uint32_t *count);
+
   /**
    * @return a pointer to the beginning of the last record requested, or nullptr if no record exists.
    */
   byte *LastRecord() const { return last_record_; }
 
+  /**
+   * Moves the records of another undo buffer of the same transaction behind the records of this one, which leaves the
+   * other buffer empty. The last record requested stays the one of this buffer.
+   * @param other the undo buffer to take the records of
+   */
+  void Append(UndoBuffer *other) {
+    buffers_.insert(buffers_.end(), other->buffers_.begin(), other->buffers_.end());
+    other->buffers_.clear();
+    other->last_record_ = nullptr;
+  }
+
  private:
   RecordBufferSegmentPool *buffer_pool_;
   std::vector<RecordBufferSegment *> buffers_;
@@ -350,11 +387,51 @@ class RedoBuffer {
    */
   void Finalize(bool flush_buffer, const transaction::TransactionPolicy &policy);
 
+  /**
+   * Hands the records requested so far to the log manager, or discards them if logging is disabled. Unlike Finalize,
+   * the buffer can still be written to afterwards, and starts over with a fresh segment.
+   * @param policy The transaction-wide policies for this log.
+   */
+  void Flush(const transaction::TransactionPolicy &policy) {
+    Finalize(true, policy);
+    buffer_seg_ = nullptr;
+    last_record_ = nullptr;
+    previous_record_ = nullptr;
+  }
+
+  /**
+   * Finalizes another redo buffer of the same transaction, as if its records had been requested from this one.
+   * @param other the redo buffer to finalize, which must not be written to afterwards
+   * @param flush_buffer whether the records of the other buffer should be logged out
+   * @param policy The transaction-wide policies for this log.
+   */
+  void Absorb(RedoBuffer *other, const bool flush_buffer, const transaction::TransactionPolicy &policy) {
+    other->Finalize(flush_buffer, policy);
+    has_flushed_ = has_flushed_ || other->has_flushed_;
+  }
+
   /**
    * @return a pointer to the beginning of the last record requested, or nullptr if no record exists.
    */
   byte *LastRecord() const { return last_record_; }
 
+  /**
+   * @return a pointer to the beginning of the record requested before the last one, or nullptr if it is not in the
+   * same buffer segment as the last one, and may already be on its way to the log manager.
+   */
+  byte *PreviousRecord() const { return previous_record_; }
+
+  /**
+   * Gives back the space of the last record requested, which must have a previous record. That record becomes the last
+   * record again. The contents of the given back record stay as they are until NewEntry is called again.
+   */
+  void RetractLastRecord() {
+    NOISEPAGE_ASSERT(previous_record_ != nullptr, "The last record has no previous record in the same segment");
+    buffer_seg_->Unreserve(last_record_);
+    last_record_ = previous_record_;
+    previous_record_ = nullptr;
+  }
+
   /**
    * @return true if this buffer has previously flushed to the log manager
    */
@@ -365,6 +442,7 @@ class RedoBuffer {
    */
   void Reset() {
     if (buffer_seg_ != nullptr) buffer_seg_->Reset();
+    previous_record_ = nullptr;
   }
 
  private:
@@ -378,5 +456,7 @@ class RedoBuffer {
   RecordBufferSegment *buffer_seg_ = nullptr;
   // reserved for aborts where we will potentially need to garbage collect the last operation (which caused the abort)
   byte *last_record_ = nullptr;
+  // the record before last_record_, if it is in buffer_seg_ as well
+  byte *previous_record_ = nullptr;
 };
 }  // namespace noisepage::storage
@@ -20,6 +20,8 @@ class AbstractLogProvider {
   /** The type of log provider that this is. */
   enum class LogProviderType : uint8_t { RESERVED = 0, DISK, REPLICATION };
 
+  virtual ~AbstractLogProvider() = default;
+
   /** @return The type of this log provider. */
   virtual LogProviderType GetType() const = 0;
 
@@ -29,7 +31,7 @@ class AbstractLogProvider {
    * @return next log record along with vector of varlen entry pointers. nullptr log record if no more logs will be
    * provided.
    */
-  std::pair<LogRecord *, std::vector<byte *>> GetNextRecord() {
+  virtual std::pair<LogRecord *, std::vector<byte *>> GetNextRecord() {
     return HasMoreRecords() ? ReadNextRecord() : std::make_pair(nullptr, std::vector<byte *>());
   }
 
@@ -73,5 +75,22 @@ class AbstractLogProvider {
    * @return next log record, along with vector of varlen entry pointers
    */
   std::pair<LogRecord *, std::vector<byte *>> ReadNextRecord();
+
+  /**
+   * Reads in a redo record that was written as its in-memory image, @see LogRecord::NATIVE_FORMAT_FLAG
+   * @param size in-memory size of the record
+   * @return the log record, along with vector of varlen entry pointers
+   */
+  std::pair<LogRecord *, std::vector<byte *>> ReadNativeRedoRecord(uint32_t size);
+
+  /**
+   * Reads in the content of a varlen entry into a newly allocated buffer, decompressing it if necessary
+   * @param serialized_size length of the varlen entry as serialized, with the flag telling if its content is compressed
+   * @return the content of the varlen entry
+   */
+  byte *ReadVarlenContent(uint32_t serialized_size);
+
+  // Holds the compressed content of the varlen being read
+  std::vector<byte> compression_buffer_;
 };
 }  // namespace noisepage::storage
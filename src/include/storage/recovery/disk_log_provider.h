@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "storage/recovery/abstract_log_provider.h"
 #include "storage/write_ahead_log/log_io.h"
@@ -16,8 +17,17 @@ class DiskLogProvider : public AbstractLogProvider {
  public:
   /**
    * @param log_file_path path to log file to read logs from
+   * @param compressed true if the log file was written with compression
    */
-  explicit DiskLogProvider(const std::string &log_file_path) : in_(BufferedLogReader(log_file_path.c_str())) {}
+  explicit DiskLogProvider(const std::string &log_file_path, const bool compressed = false)
+      : in_(BufferedLogReader(log_file_path.c_str(), compressed)) {}
+
+  /**
+   * @param log_file_paths paths to the log files to read logs from in order, e.g. the segments of a log file
+   * @param compressed true if the log files were written with compression
+   */
+  explicit DiskLogProvider(const std::vector<std::string> &log_file_paths, const bool compressed = false)
+      : in_(BufferedLogReader(log_file_paths, compressed)) {}
 
   LogProviderType GetType() const override { return LogProviderType::DISK; }
 
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <functional>
+#include <mutex>  // NOLINT
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "catalog/schema.h"
+#include "storage/projected_row.h"
+#include "storage/storage_defs.h"
+#include "transaction/transaction_defs.h"
+
+namespace noisepage::storage {
+
+/** The kind of row change that a ChangeEvent describes. */
+enum class ChangeType : uint8_t { INSERT, UPDATE, DELETE };
+
+/**
+ * A change to a row of a user table, decoded from the redo or delete record that made it. Unlike the record, which
+ * names the row by a TupleSlot that only means something inside the process that logged it, the event names the row by
+ * its table and its primary key, and carries the values of the columns that it wrote.
+ */
+struct ChangeEvent {
+  /** The kind of change. */
+  ChangeType type_;
+  /** The database of the table. */
+  catalog::db_oid_t db_oid_;
+  /** The table of the row. */
+  catalog::table_oid_t table_oid_;
+  /** The change, rendered as a single line of JSON. @see LogicalDecoder */
+  std::string json_;
+};
+
+/**
+ * The LogicalDecoder turns the committed changes that the RecoveryManager replays into a stream of ChangeEvents for
+ * downstream systems, like a search index or a cache, that need to follow the changes to the database.
+ *
+ * Each event is one line of JSON:
+ *
+ *     {"txn":42,"op":"UPDATE","db":1,"table":1001,"key":{"id":7},"columns":{"name":"x"}}
+ *
+ * where "txn" is the ID of the transaction on the primary, "key" holds the primary key of the row after the change and
+ * "columns" the columns that an insert or an update wrote. An update that changes the primary key also carries the key
+ * before the change in "old_key". Rows of tables without a primary key are named by all of their columns instead, the
+ * old ones for a delete and the new ones otherwise. Values are JSON numbers, booleans, strings or null. Dates and
+ * timestamps are sent in their text form, VARBINARY values in hex and DECIMAL values as their unscaled integer.
+ *
+ * The changes of a transaction are published once the transaction is applied, in commit order, and are sent to the
+ * sink in batches of whole transactions. A batch is sent once it holds batch_size events, or when the RecoveryManager
+ * runs out of transactions to apply for now.
+ */
+class LogicalDecoder {
+ public:
+  /**
+   * Receives a batch of changes: the ID of the last transaction in the batch and the events of the batch, one per line.
+   */
+  using ChangeSink = std::function<void(transaction::timestamp_t, std::string)>;
+
+  /**
+   * @param batch_size number of events after which a batch is sent to the sink
+   * @param sink where batches of changes are sent
+   */
+  LogicalDecoder(uint32_t batch_size, ChangeSink sink) : batch_size_(batch_size), sink_(std::move(sink)) {}
+
+  /**
+   * Decode a change to a row.
+   * @param txn_id ID of the transaction on the primary
+   * @param type kind of change
+   * @param db_oid database of the table
+   * @param table_oid table of the row
+   * @param schema schema of the table
+   * @param key_oids columns of the table's primary key, empty if it has none
+   * @param row values of the row after the change, or before it for a delete. Contains at least the key columns.
+   * @param row_map projection map of row
+   * @param old_row values of the key columns before an update, nullptr otherwise
+   * @param old_row_map projection map of old_row
+   * @param written_oids columns that an insert or an update wrote, all of which are in row
+   * @return the decoded change
+   */
+  static ChangeEvent Decode(transaction::timestamp_t txn_id, ChangeType type, catalog::db_oid_t db_oid,
+                            catalog::table_oid_t table_oid, const catalog::Schema &schema,
+                            const std::vector<catalog::col_oid_t> &key_oids, const ProjectedRow &row,
+                            const ProjectionMap &row_map, const ProjectedRow *old_row,
+                            const ProjectionMap *old_row_map, const std::vector<catalog::col_oid_t> &written_oids);
+
+  /**
+   * Publish the changes of a transaction that was applied. Transactions must be published in commit order, which is
+   * the order they are sent in. Safe to call from a replay worker.
+   * @param txn_id ID of the transaction on the primary
+   * @param changes changes of the transaction, in the order they were made
+   */
+  void Publish(transaction::timestamp_t txn_id, std::vector<ChangeEvent> &&changes);
+
+  /** Send the changes that were published since the last batch, if any. */
+  void Flush();
+
+ private:
+  /** Send the current batch. Requires batch_mutex_. */
+  void SendBatch();
+
+  const uint32_t batch_size_;
+  const ChangeSink sink_;
+
+  // Protects the batch being built
+  std::mutex batch_mutex_;
+  // The events of the batch being built, one per line
+  std::string batch_;
+  // Number of events in batch_
+  uint32_t batch_events_ = 0;
+  // The last transaction whose events were added to batch_
+  transaction::timestamp_t batch_last_txn_ = transaction::INVALID_TXN_TIMESTAMP;
+};
+
+}  // namespace noisepage::storage
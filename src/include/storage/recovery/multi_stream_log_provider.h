@@ -0,0 +1,50 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "storage/recovery/abstract_log_provider.h"
+#include "storage/recovery/disk_log_provider.h"
+
+namespace noisepage::storage {
+
+/**
+ * @brief Log provider for logs written by several log streams
+ * Merges the log files of all streams of a LogManager into a single sequence of records. Each stream is read with a
+ * DiskLogProvider. Redo, delete and abort records are handed out as soon as they are read, since the RecoveryManager
+ * buffers them per transaction anyway. Commit records are handed out in commit timestamp order across all streams.
+ * @see LogManager::LogFilePaths
+ */
+class MultiStreamLogProvider : public AbstractLogProvider {
+ public:
+  /**
+   * @param log_file_paths paths to the log file of every stream
+   * @param compressed true if the log files were written with compression
+   */
+  explicit MultiStreamLogProvider(const std::vector<std::string> &log_file_paths, bool compressed = false);
+
+  LogProviderType GetType() const override { return LogProviderType::DISK; }
+
+  /**
+   * @return next log record of any stream along with its varlen entry pointers, nullptr log record once all streams are
+   * exhausted
+   */
+  std::pair<LogRecord *, std::vector<byte *>> GetNextRecord() override;
+
+ private:
+  // Provider for the log file of each stream
+  std::vector<std::unique_ptr<DiskLogProvider>> streams_;
+  // The next record of each stream that has been read but not handed out, nullptr if the stream is exhausted
+  std::vector<std::pair<LogRecord *, std::vector<byte *>>> heads_;
+
+  /** Hands out the current head of the given stream, and reads the stream's next record */
+  std::pair<LogRecord *, std::vector<byte *>> PopHead(uint32_t stream);
+
+  // Records are read through the streams' providers, so the byte-level interface is not used
+  bool HasMoreRecords() override { return false; }
+  bool Read(void * /*dest*/, uint32_t /*size*/) override { return false; }
+};
+
+}  // namespace noisepage::storage
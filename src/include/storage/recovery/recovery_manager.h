@@ -1,8 +1,16 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>              // NOLINT
+#include <condition_variable>  // NOLINT
+#include <deque>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <optional>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -18,7 +26,12 @@
 #include "catalog/postgres/pg_namespace.h"
 #include "catalog/postgres/pg_type.h"
 #include "common/dedicated_thread_owner.h"
+#include "common/hash_defs.h"
+#include "common/shared_latch.h"
+#include "common/worker_pool.h"
+#include "storage/checkpoint/checkpoint_manager.h"
 #include "storage/recovery/abstract_log_provider.h"
+#include "storage/recovery/logical_decoder.h"
 #include "storage/sql_table.h"
 
 namespace noisepage {
@@ -70,6 +83,11 @@ class RecoveryManager : public common::DedicatedThreadOwner {
      */
     void Terminate() override { recovery_manager_->recovery_task_loop_again_ = false; }
 
+    /**
+     * @return the role of the recovery thread
+     */
+    common::ThreadRole GetThreadRole() const override { return common::ThreadRole::BACKGROUND; }
+
    private:
     RecoveryManager *recovery_manager_;
   };
@@ -83,6 +101,8 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * @param replication_manager replication manager to acknowledge applied changes
    * @param thread_registry thread registry to register tasks
    * @param store block store used for SQLTable creation during recovery
+   * @param num_replay_threads number of threads that replay committed transactions, 1 replays serially on the recovery
+   * thread
    */
   explicit RecoveryManager(const common::ManagedPointer<AbstractLogProvider> log_provider,
                            const common::ManagedPointer<catalog::Catalog> catalog,
@@ -90,14 +110,21 @@ class RecoveryManager : public common::DedicatedThreadOwner {
                            const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
                            const common::ManagedPointer<replication::ReplicationManager> replication_manager,
                            const common::ManagedPointer<noisepage::common::DedicatedThreadRegistry> thread_registry,
-                           const common::ManagedPointer<BlockStore> store)
+                           const common::ManagedPointer<BlockStore> store, const uint32_t num_replay_threads = 1)
       : DedicatedThreadOwner(thread_registry),
         log_provider_(log_provider),
         catalog_(catalog),
         txn_manager_(txn_manager),
         deferred_action_manager_(deferred_action_manager),
         replication_manager_(replication_manager),
-        block_store_(store) {
+        block_store_(store),
+        num_replay_threads_(num_replay_threads) {
+    NOISEPAGE_ASSERT(num_replay_threads_ > 0, "Recovery needs at least one replay thread");
+    if (num_replay_threads_ > 1) {
+      replay_workers_ = std::make_unique<common::WorkerPool>(num_replay_threads_, common::TaskQueue{});
+      replay_workers_->Startup();
+    }
+
     // Initialize catalog_table_schemas_ map
     catalog_table_schemas_[catalog::postgres::PgClass::CLASS_TABLE_OID] =
         catalog::postgres::Builder::GetClassTableSchema();
@@ -122,8 +149,45 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   /** @return True if the recovery task is still running. */
   bool IsRecoveryTaskRunning() const { return recovery_task_ != nullptr; }
 
+  /**
+   * Use a checkpoint for the next recovery. Changes to user tables by transactions that committed before the
+   * checkpoint's timestamp are not replayed from the logs. Instead, each table is loaded from the checkpoint once the
+   * logs have recreated it and before any later transaction modifies it. Catalog changes are always replayed.
+   * @param checkpoint the checkpoint to load, @see CheckpointManager::GetLatestCheckpoint
+   */
+  void SetCheckpoint(CheckpointInfo checkpoint);
+
+  /**
+   * Decode the changes to user tables that are replayed from now on into a stream of row changes. Changes that are
+   * loaded from a checkpoint are not decoded.
+   * @param logical_decoder the decoder to publish the changes of every applied transaction to
+   */
+  void SetLogicalDecoder(std::unique_ptr<LogicalDecoder> logical_decoder);
+
   /** @return The ID of the last transaction that was applied. */
-  transaction::timestamp_t GetLastAppliedTransactionId() const { return last_applied_txn_id_; }
+  transaction::timestamp_t GetLastAppliedTransactionId() const { return last_applied_txn_id_.load(); }
+
+  /**
+   * Begin a transaction that reads the replayed tables, like a query on a replica. It sees the changes of a prefix of
+   * the transactions in the primary's serial order, up to GetLastAppliedTransactionId(), and none of the ones that are
+   * replayed out of order by the replay workers at the time.
+   * @param read_only whether the transaction promises to never write, @see TransactionManager::BeginTransaction
+   * @param isolation_level isolation level of the transaction
+   * @param max_staleness if given, first wait until no transaction that committed on the primary was received more
+   * than this long ago and is still not applied, @see GetApplyLag
+   * @return the new transaction
+   */
+  transaction::TransactionContext *BeginReadTransaction(bool read_only, transaction::IsolationLevel isolation_level,
+                                                        std::optional<std::chrono::milliseconds> max_staleness);
+
+  /**
+   * @return How long ago the oldest committed transaction that is not applied yet was received, zero if every received
+   * transaction is applied
+   */
+  std::chrono::microseconds GetApplyLag() {
+    std::lock_guard guard(apply_progress_mutex_);
+    return ApplyLag();
+  }
 
  private:
   FRIEND_TEST(RecoveryTests, DoubleRecoveryTest);
@@ -154,6 +218,8 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   // TODO(Gus): This map may get huge, benchmark whether this becomes a problem and if we need a more sophisticated data
   // structure
   std::unordered_map<TupleSlot, TupleSlot> tuple_slot_map_;
+  // Protects tuple_slot_map_ while transactions are replayed in parallel
+  common::SharedLatch tuple_slot_map_latch_;
 
   // Used during recovery from log. Stores deferred transactions in sorted sorted order to be able to execute them in
   // serial order. Transactions are defered when there is an older active transaction at the time it committed. Even
@@ -182,7 +248,39 @@ class RecoveryManager : public common::DedicatedThreadOwner {
   // them here
   std::unordered_map<catalog::table_oid_t, catalog::Schema> catalog_table_schemas_;
 
-  transaction::timestamp_t last_applied_txn_id_ = transaction::INITIAL_TXN_TIMESTAMP;  ///< The last applied txn's ID.
+  // Checkpoint to load during the next recovery, if any.
+  std::optional<CheckpointInfo> checkpoint_ = std::nullopt;
+  // Tables of the checkpoint that have not been loaded yet.
+  std::set<std::pair<catalog::db_oid_t, catalog::table_oid_t>> unloaded_checkpoint_tables_;
+  // Start timestamps of committed txns whose changes to user tables are already contained in the checkpoint.
+  std::unordered_set<transaction::timestamp_t> checkpointed_txns_;
+
+  // Number of threads that replay committed transactions. With more than one, transactions that only modify user
+  // tables are replayed by replay_workers_, concurrently unless they write the same tuples. Everything else acts as a
+  // barrier and is replayed on the recovery thread once the workers are idle.
+  const uint32_t num_replay_threads_;
+  // Most transactions replayed by replay_workers_ before they wait for each other, @see read_snapshot_latch_
+  static constexpr uint32_t MAX_REPLAY_SEGMENT_SIZE = 1024;
+  std::unique_ptr<common::WorkerPool> replay_workers_ = nullptr;
+  // True while replay_workers_ are replaying transactions. Only written by the recovery thread while workers are idle.
+  bool replaying_in_parallel_ = false;
+  // Held exclusively while replay_workers_ replay transactions out of order, so that transactions reading the tables
+  // only begin in between, @see BeginReadTransaction
+  common::SharedLatch read_snapshot_latch_;
+
+  // The committed transactions that were received but not applied yet mapped to when they arrived, and the arrivals in
+  // the order they happened. An arrival is dropped once it is at the front and its transaction is applied.
+  std::unordered_map<transaction::timestamp_t, std::chrono::steady_clock::time_point> unapplied_txns_;
+  std::deque<std::pair<transaction::timestamp_t, std::chrono::steady_clock::time_point>> arrivals_;
+  // Protects the above, and is signalled whenever a transaction is applied
+  std::mutex apply_progress_mutex_;
+  std::condition_variable apply_progress_cv_;
+
+  // Decodes the replayed changes to user tables for downstream systems if set, @see SetLogicalDecoder
+  std::unique_ptr<LogicalDecoder> logical_decoder_ = nullptr;
+
+  // The last applied txn's ID. Read by the transactions of queries on replicas.
+  std::atomic<transaction::timestamp_t> last_applied_txn_id_{transaction::INITIAL_TXN_TIMESTAMP};
   uint32_t recovered_txns_ = 0;  ///< The number of recovered committed txns.
 
   /**
@@ -204,12 +302,92 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    */
   void ProcessCommittedTransaction(transaction::timestamp_t txn_id);
 
+  /**
+   * Replay the buffered changes of a committed transaction in a new transaction. Safe to call from a replay worker if
+   * the changes only modify user tables.
+   * @param buffered_changes list of buffered log records, taken out of buffered_changes_map_
+   * @param checkpointed true if the changes to user tables are contained in the checkpoint and must be skipped
+   * @param changes if not null, the decoded changes to user tables are appended here, @see LogicalDecoder
+   */
+  void ReplayCommittedTransaction(std::vector<std::pair<LogRecord *, std::vector<byte *>>> *buffered_changes,
+                                  bool checkpointed, std::vector<ChangeEvent> *changes = nullptr);
+
+  /**
+   * Records that a committed transaction was applied, and acknowledges it to the primary on replicas.
+   * @param txn_id start timestamp for committed transaction
+   */
+  void NotifyTransactionApplied(transaction::timestamp_t txn_id);
+
+  /** @return GetApplyLag(), with apply_progress_mutex_ held */
+  std::chrono::microseconds ApplyLag() const;
+
+  /**
+   * Replay committed transactions on replay_workers_. A transaction is replayed as soon as the earlier transactions
+   * that write some of the same tuples are, @see GetReplayConflicts, and the transactions are acknowledged to the
+   * primary in serial order. Every other transaction waits for the workers to finish and is then replayed on the
+   * recovery thread.
+   * @param txn_ids start timestamps for committed transactions, in serial order
+   */
+  void ProcessCommittedTransactionsInParallel(const std::vector<transaction::timestamp_t> &txn_ids);
+
+  /**
+   * Collects what a committed transaction conflicts with other transactions on when they are replayed in parallel: the
+   * tuples it writes, as identified by the tuple slots in the logs, or the whole table for tables with unique indexes.
+   * @param txn transaction to look up the indexes of the tables with
+   * @param txn_id start timestamp for committed transaction
+   * @param unique_tables whether the tables looked up so far have a unique index, by the hash of their oids
+   * @param[out] conflict_keys hashes of the tuples and tables the transaction writes. Collisions only add conflicts.
+   * @return false if the transaction must be replayed on the recovery thread because it modifies the catalog or tables
+   * that still have to be loaded from the checkpoint
+   */
+  bool GetReplayConflicts(transaction::TransactionContext *txn, transaction::timestamp_t txn_id,
+                          std::unordered_map<common::hash_t, bool> *unique_tables,
+                          std::vector<common::hash_t> *conflict_keys);
+
+  /**
+   * Loads the checkpointed tables that the given buffered transaction modifies and that have not been loaded yet. This
+   * must happen before the transaction is replayed, since its changes apply on top of the checkpointed contents.
+   * @param txn_id start timestamp for committed transaction
+   */
+  void LoadCheckpointTablesForTxn(transaction::timestamp_t txn_id);
+
+  /**
+   * Inserts the contents of a checkpointed table, unless the table was dropped by the replayed logs.
+   * @param db_oid database oid for table
+   * @param table_oid oid of the table to load
+   */
+  void LoadCheckpointTable(catalog::db_oid_t db_oid, catalog::table_oid_t table_oid);
+
+  /**
+   * @param record redo or delete record
+   * @return the database and table that the record modifies
+   */
+  static std::pair<catalog::db_oid_t, catalog::table_oid_t> GetRecordTable(const LogRecord *record);
+
+  /**
+   * @param record redo or delete record
+   * @return true if the record modifies a user table, i.e. a table whose contents can be covered by a checkpoint
+   */
+  static bool IsUserTableRecord(const LogRecord *record) {
+    return GetRecordTable(record).second.UnderlyingValue() >= catalog::START_OID;
+  }
+
   /**
    * Defers log records deletes with the transaction manager
    * @param txn_id txn_id for txn who's records to delete
    * @param delete_varlens true if we should delete varlens allocated for txn
    */
-  void DeferRecordDeletes(transaction::timestamp_t txn_id, bool delete_varlens);
+  void DeferRecordDeletes(transaction::timestamp_t txn_id, bool delete_varlens) {
+    DeferRecordDeletes(std::move(buffered_changes_map_[txn_id]), delete_varlens);
+  }
+
+  /**
+   * Defers log records deletes with the transaction manager
+   * @param buffered_changes records to delete, taken out of buffered_changes_map_
+   * @param delete_varlens true if we should delete varlens allocated for txn
+   */
+  void DeferRecordDeletes(std::vector<std::pair<LogRecord *, std::vector<byte *>>> &&buffered_changes,
+                          bool delete_varlens);
 
   /**
    * Replay any transaction who's txn start time is less than upper_bound. If upper_bound == transaction::NO_ACTIVE_TXN,
@@ -225,8 +403,10 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * @return new tuple slot
    */
   TupleSlot GetTupleSlotMapping(TupleSlot slot) {
-    NOISEPAGE_ASSERT(tuple_slot_map_.find(slot) != tuple_slot_map_.end(), "No tuple slot mapping exists");
-    return tuple_slot_map_[slot];
+    common::SharedLatch::ScopedSharedLatch guard(&tuple_slot_map_latch_);
+    const auto it = tuple_slot_map_.find(slot);
+    NOISEPAGE_ASSERT(it != tuple_slot_map_.end(), "No tuple slot mapping exists");
+    return it->second;
   }
 
   /**
@@ -239,8 +419,11 @@ class RecoveryManager : public common::DedicatedThreadOwner {
                                                                       catalog::db_oid_t db_oid) {
     auto db_catalog_ptr = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
     NOISEPAGE_ASSERT(db_catalog_ptr != nullptr, "No catalog for given database oid");
-    auto result UNUSED_ATTRIBUTE = db_catalog_ptr->TryLock(common::ManagedPointer(txn));
-    NOISEPAGE_ASSERT(result, "There should not be concurrent DDL changes during recovery.");
+    // Transactions replayed in parallel never modify the catalog, and would conflict with each other on the DDL lock
+    if (!replaying_in_parallel_) {
+      auto result UNUSED_ATTRIBUTE = db_catalog_ptr->TryLock(common::ManagedPointer(txn));
+      NOISEPAGE_ASSERT(result, "There should not be concurrent DDL changes during recovery.");
+    }
     return db_catalog_ptr;
   }
 
@@ -270,14 +453,45 @@ class RecoveryManager : public common::DedicatedThreadOwner {
                             const TupleSlot &tuple_slot, ProjectedRow *table_pr, bool insert);
 
   /**
-   * NYS = Not yet supported
+   * Loads a batch of tuples that were just inserted into a table into all indexes on the table at once.
+   * @param txn transaction to load with
+   * @param db_oid database oid for table
+   * @param table_oid indexed table
+   * @param table_ptr pointer to sql table
+   * @param tuples tuple slots and PRs with values for every column of the table
+   */
+  void BulkLoadIndexesOnTable(transaction::TransactionContext *txn, catalog::db_oid_t db_oid,
+                              catalog::table_oid_t table_oid, common::ManagedPointer<storage::SqlTable> table_ptr,
+                              const std::vector<std::pair<TupleSlot, ProjectedRow *>> &tuples);
+
+  /**
+   * @param txn transaction to look up the indexes with
+   * @param db_oid database oid for table
+   * @param table_oid indexed table
+   * @return the indexes on the table and their schemas
+   */
+  std::vector<std::pair<common::ManagedPointer<storage::index::Index>, const catalog::IndexSchema &>> GetIndexesOnTable(
+      transaction::TransactionContext *txn, catalog::db_oid_t db_oid, catalog::table_oid_t table_oid);
+
+  /**
+   * Copies the key columns of a table PR into an index PR
+   * @param index index to build the key for
+   * @param schema schema of the index
+   * @param pr_map projection map of the table PR
+   * @param table_pr PR with values for every column of the table
+   * @param index_pr index PR to fill
+   */
+  static void CopyIndexKey(common::ManagedPointer<storage::index::Index> index, const catalog::IndexSchema &schema,
+                           const ProjectionMap &pr_map, const ProjectedRow &table_pr, ProjectedRow *index_pr);
+
+  /**
    * Returns whether a delete or redo record is a special case catalog record. The special cases we consider are:
    *   1. Insert into pg_database (creating a database)
-   *   2. Updates into pg_class (updating a pointer, updating a schema (NYS), update to next col_oid)
+   *   2. Updates into pg_class (updating a pointer, updating a schema (drop column), update to next col_oid)
    *   3. Delete into pg_database (renaming a database, drop a database)
    *   4. Delete into pg_class (renaming a table/index, drop a table/index)
    *   5. Delete into pg_index (cascading delete from drop index)
-   *   6. Delete into pg_attribute (drop column (NYS) / cascading delete from drop table)
+   *   6. Delete into pg_attribute (drop column / cascading delete from drop table)
    *   7. Insert into pg_proc
    *   8. Updates into pg_proc
    * @param record log record we want to determine if its a special case
@@ -314,7 +528,8 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * @param record record we want to determine redo type of
    * @return true if record is an insert redo, false if it is an update redo
    */
-  bool IsInsertRecord(const RedoRecord *record) const {
+  bool IsInsertRecord(const RedoRecord *record) {
+    common::SharedLatch::ScopedSharedLatch guard(&tuple_slot_map_latch_);
     return tuple_slot_map_.find(record->GetTupleSlot()) == tuple_slot_map_.end();
   }
 
@@ -368,15 +583,42 @@ class RecoveryManager : public common::DedicatedThreadOwner {
    * Replays a redo record. Updates necessary metadata maps
    * @param txn txn to use for replay
    * @param record record to replay
+   * @param loaded_tuples if not null, an insert is appended here for BulkLoadIndexesOnTable instead of being inserted
+   *                      into the indexes of its table
+   * @param changes if not null, the decoded change is appended here. Only for records of user tables.
    */
-  void ReplayRedoRecord(transaction::TransactionContext *txn, LogRecord *record);
+  void ReplayRedoRecord(transaction::TransactionContext *txn, LogRecord *record,
+                        std::vector<std::pair<TupleSlot, ProjectedRow *>> *loaded_tuples = nullptr,
+                        std::vector<ChangeEvent> *changes = nullptr);
 
   /**
    * Replays a delete record. Updates necessary metadata
    * @param txn txn to use for delete
    * @param record record to replay
+   * @param changes if not null, the decoded change is appended here. Only for records of user tables.
+   */
+  void ReplayDeleteRecord(transaction::TransactionContext *txn, LogRecord *record,
+                          std::vector<ChangeEvent> *changes = nullptr);
+
+  /**
+   * @param txn txn to use for catalog lookup
+   * @param db_oid database of the table
+   * @param table_oid user table
+   * @return the columns of the table's primary key, empty if it has none
+   */
+  std::vector<catalog::col_oid_t> GetPrimaryKeyOids(transaction::TransactionContext *txn, catalog::db_oid_t db_oid,
+                                                    catalog::table_oid_t table_oid);
+
+  /**
+   * Reads columns of a tuple as the given txn sees it
+   * @param txn txn to read with
+   * @param sql_table table of the tuple
+   * @param slot tuple to read
+   * @param col_oids columns to read
+   * @return the columns in a buffer that the caller must delete[]
    */
-  void ReplayDeleteRecord(transaction::TransactionContext *txn, LogRecord *record);
+  static ProjectedRow *SelectColumns(transaction::TransactionContext *txn, common::ManagedPointer<SqlTable> sql_table,
+                                     TupleSlot slot, const std::vector<catalog::col_oid_t> &col_oids);
 
   /**
    * Returns the list of col oids this redo record modified
@@ -74,6 +74,12 @@ class ReplicationLogProvider final : public AbstractLogProvider {
     }
   }
 
+  /** @return True if WaitUntilEvent() would return without blocking. */
+  bool EventReady() {
+    std::unique_lock<std::mutex> lock(replication_latch_);
+    return !replication_active_ || OATReady() || NonBlockingHasMoreRecords() || NextBatchReady();
+  }
+
   /**
    * Update the latest OAT of the replication log provider.
    *
@@ -156,7 +162,7 @@ class ReplicationLogProvider final : public AbstractLogProvider {
       // Pop the next batch of records off into curr_buffer_.
       {
         const replication::RecordsBatchMsg &msg = received_batch_queue_.top();
-        std::string contents = msg.GetContents();
+        const std::string &contents = msg.GetContents();
         std::vector<unsigned char> bytes(contents.begin(), contents.end());
         network::ReadBufferView view(bytes.size(), bytes.begin());
         auto buffer = std::make_unique<network::ReadBuffer>();
@@ -20,6 +20,7 @@ class RandomSqlTableTransaction;
 
 namespace noisepage::execution::sql {
 class TableVectorIterator;
+class TupleIdList;
 class VectorProjection;
 }  // namespace noisepage::execution::sql
 
@@ -54,8 +55,11 @@ class SqlTable {
    *
    * @param store the Block store to use.
    * @param schema the initial Schema of this SqlTable
+   * @param column_groups columns to store row-wise together within a block, for tables whose tuples are mostly read
+   *                      and written whole. Every other column is stored in a column of its own.
    */
-  SqlTable(common::ManagedPointer<BlockStore> store, const catalog::Schema &schema);
+  SqlTable(common::ManagedPointer<BlockStore> store, const catalog::Schema &schema,
+           const std::vector<std::vector<catalog::col_oid_t>> &column_groups = {});
 
   /**
    * Destructs a SqlTable, frees all its members.
@@ -83,10 +87,13 @@ class SqlTable {
    * @param redo the desired change to be applied. This should be the after-image of the attributes of interest. The
    * TupleSlot in this RedoRecord must be set to the intended tuple.
    * @return true if successful, false otherwise
+   * @warning If the RedoRecord staged right before this one changes the same tuple and every attribute that this one
+   * changes, the change is folded into it and this RedoRecord is given back to the txn's RedoBuffer. It can still be
+   * read until StageWrite is called again.
    */
   bool Update(const common::ManagedPointer<transaction::TransactionContext> txn, RedoRecord *const redo) const {
     NOISEPAGE_ASSERT(redo->GetTupleSlot() != TupleSlot(nullptr, 0), "TupleSlot was never set in this RedoRecord.");
-    NOISEPAGE_ASSERT(redo == reinterpret_cast<LogRecord *>(txn->redo_buffer_.LastRecord())
+    NOISEPAGE_ASSERT(redo == reinterpret_cast<LogRecord *>(txn->RedoBufferOfThisThread()->LastRecord())
                                  ->LogRecord::GetUnderlyingRecordBodyAs<RedoRecord>(),
                      "This RedoRecord is not the most recent entry in the txn's RedoBuffer. Was StageWrite called "
                      "immediately before?");
@@ -95,6 +102,8 @@ class SqlTable {
       // For MVCC correctness, this txn must now abort for the GC to clean up the version chain in the DataTable
       // correctly.
       txn->SetMustAbort();
+    } else {
+      CoalesceRedo(txn, redo);
     }
     return result;
   }
@@ -109,7 +118,7 @@ class SqlTable {
    */
   TupleSlot Insert(const common::ManagedPointer<transaction::TransactionContext> txn, RedoRecord *const redo) const {
     NOISEPAGE_ASSERT(redo->GetTupleSlot() == TupleSlot(nullptr, 0), "TupleSlot was set in this RedoRecord.");
-    NOISEPAGE_ASSERT(redo == reinterpret_cast<LogRecord *>(txn->redo_buffer_.LastRecord())
+    NOISEPAGE_ASSERT(redo == reinterpret_cast<LogRecord *>(txn->RedoBufferOfThisThread()->LastRecord())
                                  ->LogRecord::GetUnderlyingRecordBodyAs<RedoRecord>(),
                      "This RedoRecord is not the most recent entry in the txn's RedoBuffer. Was StageWrite called "
                      "immediately before?");
@@ -118,6 +127,49 @@ class SqlTable {
     return slot;
   }
 
+  /**
+   * Inserts every tuple of the given buffer and stores the slot allocated for each, as a batch in the underlying
+   * DataTable. Unlike Insert, this call stages the RedoRecords that log the tuples itself, so StageWrite must not be
+   * called for them.
+   *
+   * @param txn the calling transaction
+   * @param db_oid the database oid of this table, for the log
+   * @param table_oid the oid of this table, for the log
+   * @param redos after-images of the inserted tuples, which are not modified
+   * @param[out] results receives the TupleSlot of every inserted tuple. It must have room for redos->NumTuples() slots.
+   */
+  void InsertBatch(common::ManagedPointer<transaction::TransactionContext> txn, catalog::db_oid_t db_oid,
+                   catalog::table_oid_t table_oid, ProjectedColumns *redos, TupleSlot *results) const;
+
+  /**
+   * Inserts every selected tuple of the given buffer and stores the slot allocated for each, as a batch in the
+   * underlying DataTable. Unlike Insert, this call stages the RedoRecords that log the tuples itself, so StageWrite
+   * must not be called for them.
+   *
+   * @param txn the calling transaction
+   * @param db_oid the database oid of this table, for the log
+   * @param table_oid the oid of this table, for the log
+   * @param redos after-images of the inserted tuples, which are not modified. Its storage column ids must be set.
+   * @param[out] results receives the TupleSlot of every inserted tuple. It must have room for
+   *                     redos->GetSelectedTupleCount() slots.
+   */
+  void InsertBatch(common::ManagedPointer<transaction::TransactionContext> txn, catalog::db_oid_t db_oid,
+                   catalog::table_oid_t table_oid, execution::sql::VectorProjection *redos, TupleSlot *results) const;
+
+  /**
+   * Materializes a batch of tuples, as visible at the timestamp of the calling txn. @see DataTable::SelectBatch
+   *
+   * @param txn the calling transaction
+   * @param slots the tuple slots to read. Row i of the output buffer receives slots[i].
+   * @param out_buffer output buffer. The object should already contain projection list information and have room for as
+   *                   many rows as the capacity of tids. It is reset, and only the visible tuples are selected.
+   * @param tids the rows of the output buffer to read. Rows whose tuple is not visible to this txn are removed.
+   */
+  void SelectBatch(const common::ManagedPointer<transaction::TransactionContext> txn, const TupleSlot *const slots,
+                   execution::sql::VectorProjection *const out_buffer, execution::sql::TupleIdList *const tids) const {
+    table_.data_table_->SelectBatch(txn, slots, out_buffer, tids);
+  }
+
   /**
    * Deletes the given TupleSlot. StageDelete must have been called as well in order for the operation to be logged.
    * @param txn the calling transaction
@@ -125,10 +177,10 @@ class SqlTable {
    * @return true if successful, false otherwise
    */
   bool Delete(const common::ManagedPointer<transaction::TransactionContext> txn, const TupleSlot slot) {
-    NOISEPAGE_ASSERT(txn->redo_buffer_.LastRecord() != nullptr,
+    NOISEPAGE_ASSERT(txn->RedoBufferOfThisThread()->LastRecord() != nullptr,
                      "The RedoBuffer is empty even though StageDelete should have been called.");
     NOISEPAGE_ASSERT(
-        reinterpret_cast<LogRecord *>(txn->redo_buffer_.LastRecord())
+        reinterpret_cast<LogRecord *>(txn->RedoBufferOfThisThread()->LastRecord())
                 ->GetUnderlyingRecordBodyAs<DeleteRecord>()
                 ->GetTupleSlot() == slot,
         "This Delete is not the most recent entry in the txn's RedoBuffer. Was StageDelete called immediately before?");
@@ -142,6 +194,22 @@ class SqlTable {
     return result;
   }
 
+  /**
+   * Locks the given TupleSlot against writes of other transactions until the txn commits or aborts, as in
+   * SELECT ... FOR UPDATE, without writing a new version of it. Nothing needs to be staged, and nothing is logged.
+   * @param txn the calling transaction
+   * @param slot the slot of the tuple to lock
+   * @return true if successful, false otherwise
+   */
+  bool Lock(const common::ManagedPointer<transaction::TransactionContext> txn, const TupleSlot slot) {
+    const auto result = table_.data_table_->Lock(txn, slot);
+    if (!result) {
+      // Same as a failed Update, this txn must now abort for the GC to clean up the version chain correctly
+      txn->SetMustAbort();
+    }
+    return result;
+  }
+
   /**
    * Sequentially scans the table starting from the given iterator(inclusive) and materializes as many tuples as would
    * fit into the given buffer, as visible to the transaction given, according to the format described by the given
@@ -169,12 +237,78 @@ class SqlTable {
    * @param txn The calling transaction.
    * @param start_pos Iterator to the starting location for the sequential scan.
    * @param out_buffer Output buffer. This buffer is always cleared of old values.
+   * @param col_idxs The columns of the output buffer to fill, or nullptr to fill all of them. @see DataTable::Scan
    */
   void Scan(const common::ManagedPointer<transaction::TransactionContext> txn, DataTable::SlotIterator *const start_pos,
-            execution::sql::VectorProjection *const out_buffer) const {
-    return table_.data_table_->Scan(txn, start_pos, out_buffer);
+            execution::sql::VectorProjection *const out_buffer,
+            const std::vector<uint16_t> *const col_idxs = nullptr) const {
+    return table_.data_table_->Scan(txn, start_pos, out_buffer, col_idxs);
+  }
+
+  /**
+   * Fills the columns a Scan left unfilled, for the selected rows of its output buffer. @see DataTable::SelectColumns
+   *
+   * @param txn The calling transaction, which made the Scan.
+   * @param out_buffer The output buffer of the Scan, whose selections are the rows to fill.
+   * @param col_idxs The columns of the output buffer to fill, in the order of the projection.
+   */
+  void SelectColumns(const common::ManagedPointer<transaction::TransactionContext> txn,
+                     execution::sql::VectorProjection *const out_buffer, const std::vector<uint16_t> &col_idxs) const {
+    table_.data_table_->SelectColumns(txn, out_buffer, col_idxs);
   }
 
+  /**
+   * Reads the tuples at the given iterator in place if they are in a FROZEN block. @see DataTable::ScanInPlace
+   *
+   * @param txn the calling transaction
+   * @param start_pos iterator to the starting location for the scan
+   * @param out_buffer output buffer. The object should already contain projection list information, with column types
+   *                   as large as the attributes they read.
+   * @return the block that was read in place, which must be passed to DataTable::ReleaseInPlaceRead, or nullptr if
+   * nothing was read
+   */
+  RawBlock *ScanInPlace(const common::ManagedPointer<transaction::TransactionContext> txn,
+                        DataTable::SlotIterator *const start_pos,
+                        execution::sql::VectorProjection *const out_buffer) const {
+    return table_.data_table_->ScanInPlace(txn, start_pos, out_buffer);
+  }
+
+  /**
+   * Checks the zone map of a block. @see DataTable::BlockMayContain
+   *
+   * @param block the block to check
+   * @param col_id the column to check
+   * @param min lower bound of the values of interest, inclusive
+   * @param max upper bound of the values of interest, inclusive
+   * @return false if no tuple in the block holds a value within [min, max] in the column
+   */
+  bool BlockMayContain(const RawBlock *const block, const col_id_t col_id, const int64_t min,
+                       const int64_t max) const {
+    return table_.data_table_->BlockMayContain(block, col_id, min, max);
+  }
+
+  /**
+   * Partitions the table by ranges of values of a column. @see DataTable::SetRangePartitioning
+   *
+   * @param col_oid the column to partition by
+   * @param bounds the lower bounds of every range but the first, in ascending order
+   */
+  void SetRangePartitioning(const catalog::col_oid_t col_oid, std::vector<int64_t> bounds) {
+    table_.data_table_->SetRangePartitioning(table_.column_map_.at(col_oid).col_id_, std::move(bounds));
+  }
+
+  /**
+   * Lets the full scans of the table share their reads. @see DataTable::SetSharedScans
+   * @param shared true if full scans start where the latest scan is
+   */
+  void SetSharedScans(const bool shared) { table_.data_table_->SetSharedScans(shared); }
+
+  /**
+   * Moves the given iterator past the remaining slots of its block. @see DataTable::SkipBlock
+   * @param pos the iterator to advance
+   */
+  void SkipBlock(DataTable::SlotIterator *const pos) const { table_.data_table_->SkipBlock(pos); }
+
   /**
    * @return the first tuple slot contained in the underlying DataTable
    */
@@ -236,13 +370,29 @@ class SqlTable {
    */
   uint64_t GetNumTuple() const { return table_.data_table_->GetNumTuple(); }
 
+  /**
+   * @return number of blocks of the table, see GetBlockedSlotIterator
+   */
+  uint32_t GetNumBlocks() const { return table_.data_table_->GetNumBlocks(); }
+
   /**
    * @return Approximate heap usage of the table
    */
   size_t EstimateHeapUsage() const { return table_.data_table_->EstimateHeapUsage(); }
 
+  /**
+   * @return Number of tuples inserted, updated or deleted by committed transactions, as counted by the GarbageCollector
+   */
+  uint64_t GetNumModifications() const { return table_.data_table_->GetNumModifications(); }
+
+  /**
+   * @return Commit time of the last transaction that changed the table, INITIAL_TXN_TIMESTAMP if none did
+   */
+  transaction::timestamp_t GetLastCommitTime() const { return table_.data_table_->GetLastCommitTime(); }
+
  private:
-  friend class RecoveryManager;  // Needs access to OID and ID mappings
+  friend class RecoveryManager;    // Needs access to OID and ID mappings
+  friend class CheckpointManager;  // Needs access to the column map and layout
   friend class noisepage::RandomSqlTableTransaction;
   friend class noisepage::LargeSqlTableTestObject;
   friend class RecoveryTests;
@@ -262,6 +412,18 @@ class SqlTable {
 
   const ColumnMap &GetColumnMap() const { return table_.column_map_; }
 
+  // Folds redo, the last record in the txn's RedoBuffer, into the record before it if that one changes the same tuple
+  // and every attribute that redo changes, and gives redo back to the RedoBuffer. Repeated updates of a tuple within a
+  // txn are then logged once.
+  void CoalesceRedo(common::ManagedPointer<transaction::TransactionContext> txn, const RedoRecord *redo) const;
+
+  // Stages a RedoRecord for each of the num_tuples tuples just inserted into slots, the i-th of which is row_at(i) and
+  // has the attributes col_ids. Defined in the translation unit only.
+  template <class RowAt>
+  void StageInserts(common::ManagedPointer<transaction::TransactionContext> txn, catalog::db_oid_t db_oid,
+                    catalog::table_oid_t table_oid, const std::vector<col_id_t> &col_ids, uint32_t num_tuples,
+                    RowAt row_at, const TupleSlot *slots) const;
+
   /**
    * Given a set of col_oids, return a vector of corresponding col_ids to use for ProjectionInitialization
    * @param col_oids set of col_oids, they must be in the table's ColumnMap
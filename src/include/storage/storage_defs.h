@@ -18,6 +18,7 @@
 #include "common/object_pool.h"
 #include "common/strong_typedef.h"
 #include "storage/block_access_controller.h"
+#include "storage/block_store.h"
 #include "transaction/transaction_defs.h"
 #include "type/type_id.h"
 
@@ -62,10 +63,10 @@ class alignas(common::Constants::BLOCK_SIZE) RawBlock {
   DataTable *data_table_;
 
   /**
-   * Padding for flags or whatever we may want in the future. Determined by size of layout_version below. See
+   * NUMA node the BlockStore placed this block on. Determined by size of layout_version below. See
    * tuple_access_strategy.h for more details on Block header layout.
    */
-  uint16_t padding_;
+  uint16_t numa_node_;
 
   /**
    * Layout version.
@@ -170,31 +171,6 @@ class TupleSlot {
   uintptr_t bytes_;
 };
 
-/**
- * Allocator that allocates a block
- */
-class BlockAllocator {
- public:
-  /**
-   * Allocates a new object by calling its constructor.
-   * @return a pointer to the allocated object.
-   */
-  RawBlock *New() { return new RawBlock(); }
-
-  /**
-   * Reuse a reused chunk of memory to be handed out again
-   * @param reused memory location, possibly filled with junk bytes
-   */
-  void Reuse(RawBlock *const reused) { /* no operation required */
-  }
-
-  /**
-   * Deletes the object by calling its destructor.
-   * @param ptr a pointer to the object to be deleted.
-   */
-  void Delete(RawBlock *const ptr) { delete ptr; }
-};
-
 /** ColumnMapInfo maps between col_oids in Schema and useful information that we need about a Column in SqlTable. */
 struct ColumnMapInfo {
   /** col_id in BlockLayout. */
@@ -203,12 +179,6 @@ struct ColumnMapInfo {
   type::TypeId col_type_;
 };
 
-/**
- * A block store is essentially an object pool. However, all blocks should be
- * aligned, so we will need to use the default constructor instead of raw
- * malloc.
- */
-using BlockStore = common::ObjectPool<RawBlock, BlockAllocator>;
 /**
  * Used by SqlTable to map between col_oids in Schema and useful necessary information.
  */
@@ -219,9 +189,10 @@ using ColumnMap = std::unordered_map<catalog::col_oid_t, ColumnMapInfo>;
 using ProjectionMap = std::unordered_map<catalog::col_oid_t, uint16_t>;
 
 /**
- * Denote whether a record modifies the logical delete column, used when DataTable inspects deltas
+ * Denote whether a record modifies the logical delete column, used when DataTable inspects deltas. A LOCK record
+ * changes nothing, and only holds the write lock on the tuple for its transaction.
  */
-enum class DeltaRecordType : uint8_t { UPDATE = 0, INSERT, DELETE };
+enum class DeltaRecordType : uint8_t { UPDATE = 0, INSERT, DELETE, LOCK };
 
 /**
  * Types of LogRecords
@@ -244,7 +215,7 @@ class VarlenEntry {
    * @param size length of the varlen content, in bytes (no C-style nul-terminator)
    * @param reclaim whether the varlen entry's content pointer can be deleted by itself. If the pointer was not
    *                    allocated by itself (e.g. inlined, or part of a dictionary batch or arrow buffer), it cannot
-   *                    be freed by the GC, which simply calls delete.
+   *                    be freed by the GC, which hands it back to the VarlenAllocator it has to come from.
    * @return constructed VarlenEntry object
    */
   static VarlenEntry Create(const byte *content, uint32_t size, bool reclaim) {
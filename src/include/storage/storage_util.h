@@ -7,6 +7,7 @@
 #include "common/macros.h"
 #include "common/strong_typedef.h"
 #include "storage/storage_defs.h"
+#include "storage/varlen_allocator.h"
 
 namespace noisepage::storage {
 class BlockLayout;
@@ -53,6 +54,19 @@ class StorageUtil {
   static void CopyAttrIntoProjection(const TupleAccessStrategy &accessor, TupleSlot from, RowType *to,
                                      uint16_t projection_list_offset);
 
+  /**
+   * Copy an attribute from a block into a ProjectedRow, together with the attributes following it in the projection
+   * list that are in the same column group. Attributes that lie at the same distance from each other in a row of the
+   * group and in the ProjectedRow are copied at once.
+   * @param accessor TupleAccessStrategy used to interact with the given block.
+   * @param from tuple slot to copy from
+   * @param to projected row to copy into
+   * @param projection_list_offset The projection_list index of the first attribute to copy on the projected row.
+   * @return number of attributes copied, which is at least 1
+   */
+  static uint16_t CopyAttrSpanIntoProjection(const TupleAccessStrategy &accessor, TupleSlot from, ProjectedRow *to,
+                                             uint16_t projection_list_offset);
+
   /**
    * Copy an attribute from a ProjectedRow into a block.
    * @param accessor TupleAccessStrategy used to interact with the given block.
@@ -178,7 +192,7 @@ class StorageUtil {
    */
   static storage::VarlenEntry CreateVarlen(const std::string &str) {
     if (str.size() > storage::VarlenEntry::InlineThreshold()) {
-      byte *contents = common::AllocationUtil::AllocateAligned(str.size());
+      byte *contents = VarlenAllocator::Allocate(static_cast<uint32_t>(str.size()));
       std::memcpy(contents, str.data(), str.size());
       return storage::VarlenEntry::Create(contents, static_cast<uint32_t>(str.size()), true);
     }
@@ -201,7 +215,7 @@ class StorageUtil {
       total_size += elem.length();
     }
 
-    byte *contents = common::AllocationUtil::AllocateAligned(total_size);
+    byte *contents = VarlenAllocator::Allocate(static_cast<uint32_t>(total_size));
     byte *head = contents;
     *reinterpret_cast<size_t *>(head) = vec.size();
     head += sizeof(size_t);
@@ -218,7 +232,7 @@ class StorageUtil {
     }
 
     auto ret = storage::VarlenEntry::CreateInline(contents, static_cast<uint32_t>(total_size));
-    delete[] contents;
+    VarlenAllocator::Deallocate(contents);
     return ret;
   }
 
@@ -237,7 +251,7 @@ class StorageUtil {
     size_t total_size = sizeof(T) * vec.size() + sizeof(size_t);
 
     // can be optimized to avoid this allocation in the inlined case if it becomes an issue
-    byte *contents = common::AllocationUtil::AllocateAligned(total_size);
+    byte *contents = VarlenAllocator::Allocate(static_cast<uint32_t>(total_size));
     *reinterpret_cast<size_t *>(contents) = vec.size();
     byte *payload = contents + sizeof(size_t);
     std::memcpy(payload, vec.data(), sizeof(T) * vec.size());
@@ -245,7 +259,7 @@ class StorageUtil {
       return storage::VarlenEntry::Create(contents, static_cast<uint32_t>(total_size), true);
     }
     auto ret = storage::VarlenEntry::CreateInline(contents, static_cast<uint32_t>(total_size));
-    delete[] contents;
+    VarlenAllocator::Deallocate(contents);
     return ret;
   }
 };
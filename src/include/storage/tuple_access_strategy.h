@@ -24,16 +24,15 @@ class TupleAccessStrategy {
    * ----------------------------------------------------
    * | null-bitmap (pad up to 8 bytes) | val1 | val2 | ... |
    * ----------------------------------------------------
+   * Columns of a group store their null-bitmaps one after the other, each padded up to 8 bytes, followed by the rows
+   * of the group, each holding the values of all columns of the group for one slot:
+   * -------------------------------------------------------------------------------------
+   * | null-bitmap a | null-bitmap b | ... | val1a | val1b | ... | val2a | val2b | ... | ... |
+   * -------------------------------------------------------------------------------------
    * Warning, 0 means null
    */
   struct MiniBlock {
     MEM_REINTERPRETATION_ONLY(MiniBlock)
-    // return a pointer to the start of the column. (use as an array)
-    byte *ColumnStart(const BlockLayout &layout, const col_id_t col_id) {
-      return StorageUtil::AlignedPtr(sizeof(uint64_t),  // always padded up to 8 bytes
-                                     varlen_contents_ + common::RawBitmap::SizeInBytes(layout.NumSlots()));
-    }
-
     // return The null-bitmap of this column
     common::RawConcurrentBitmap *NullBitmap() {
       return reinterpret_cast<common::RawConcurrentBitmap *>(varlen_contents_);
@@ -45,7 +44,7 @@ class TupleAccessStrategy {
   /*
    * Block Header layout:
    * -----------------------------------------------------------------------------------------------------------------
-   * | data_table *(64) | padding (16) | layout_version (16) | insert_head (32) |        control_block (64)          |
+   * | data_table *(64) | numa_node (16) | layout_version (16) | insert_head (32) |        control_block (64)          |
    * -----------------------------------------------------------------------------------------------------------------
    * | ArrowBlockMetadata | attr_offsets[num_col] (32) | bitmap for slots (64-bit aligned) | data (64-bit aligned)   |
    * -----------------------------------------------------------------------------------------------------------------
@@ -128,11 +127,12 @@ class TupleAccessStrategy {
   /**
    * @param block block to access
    * @param col_id id of the column
-   * @return pointer to the start of the column
+   * @return pointer to the value of the column for the first slot. The values of the following slots are
+   * BlockLayout::AttrStride bytes apart.
    */
   byte *ColumnStart(RawBlock *block, const col_id_t col_id) const {
     NOISEPAGE_ASSERT((col_id.UnderlyingValue()) < layout_.NumColumns(), "Column out of bounds!");
-    return reinterpret_cast<Block *>(block)->Column(layout_, col_id)->ColumnStart(layout_, col_id);
+    return reinterpret_cast<byte *>(block) + value_offsets_[col_id.UnderlyingValue()];
   }
 
   /**
@@ -143,7 +143,7 @@ class TupleAccessStrategy {
   byte *AccessWithNullCheck(const TupleSlot slot, const col_id_t col_id) const {
     NOISEPAGE_ASSERT(slot.GetOffset() < layout_.NumSlots(), "Offset out of bounds!");
     if (!ColumnNullBitmap(slot.GetBlock(), col_id)->Test(slot.GetOffset())) return nullptr;
-    return ColumnStart(slot.GetBlock(), col_id) + layout_.AttrSize(col_id) * slot.GetOffset();
+    return ColumnStart(slot.GetBlock(), col_id) + layout_.AttrStride(col_id) * slot.GetOffset();
   }
 
   /**
@@ -154,7 +154,7 @@ class TupleAccessStrategy {
    */
   byte *AccessWithoutNullCheck(const TupleSlot slot, const col_id_t col_id) const {
     NOISEPAGE_ASSERT(slot.GetOffset() < layout_.NumSlots(), "Offset out of bounds!");
-    return ColumnStart(slot.GetBlock(), col_id) + layout_.AttrSize(col_id) * slot.GetOffset();
+    return ColumnStart(slot.GetBlock(), col_id) + layout_.AttrStride(col_id) * slot.GetOffset();
   }
 
   /**
@@ -168,7 +168,7 @@ class TupleAccessStrategy {
     NOISEPAGE_ASSERT(slot.GetOffset() < layout_.NumSlots(), "Offset out of bounds!");
     common::RawConcurrentBitmap *bitmap = ColumnNullBitmap(slot.GetBlock(), col_id);
     if (!bitmap->Test(slot.GetOffset())) bitmap->Flip(slot.GetOffset(), false);
-    return ColumnStart(slot.GetBlock(), col_id) + layout_.AttrSize(col_id) * slot.GetOffset();
+    return ColumnStart(slot.GetBlock(), col_id) + layout_.AttrStride(col_id) * slot.GetOffset();
   }
 
   /**
@@ -221,6 +221,26 @@ class TupleAccessStrategy {
    */
   bool Allocate(RawBlock *block, TupleSlot *slot) const;
 
+  /**
+   * Allocates a contiguous run of slots from the insertion head of the block on, as many as requested or as the block
+   * has left. Like Allocate, this assumes that no other thread allocates slots in the block at the same time.
+   * @param block block to allocate the slots in.
+   * @param num_slots number of slots to allocate.
+   * @param[out] slots array of at least num_slots slots to write the allocated ones to, in order.
+   * @return number of slots allocated, 0 if the insertion head reached the end of the block.
+   */
+  uint32_t AllocateRun(RawBlock *block, uint32_t num_slots, TupleSlot *slots) const;
+
+  /**
+   * Allocates a slot that was freed behind the insertion head of the block, which Allocate never hands out again. Like
+   * Allocate, this assumes that no other thread allocates slots in the block at the same time.
+   * @param block block to allocate a slot in.
+   * @param start offset to start looking for a freed slot at.
+   * @param[out] slot tuple to write to.
+   * @return true if the allocation succeeded, false if no slot at or after start is free.
+   */
+  bool AllocateFreed(RawBlock *block, uint32_t start, TupleSlot *slot) const;
+
   /**
    * @param block the block to access
    * @return pointer to the allocation bitmap of the block
@@ -236,8 +256,7 @@ class TupleAccessStrategy {
   void Deallocate(const TupleSlot slot) const {
     NOISEPAGE_ASSERT(Allocated(slot), "Can only deallocate slots that are allocated");
     reinterpret_cast<Block *>(slot.GetBlock())->SlotAllocationBitmap(layout_)->Flip(slot.GetOffset(), true);
-    // TODO(Tianyu): Make explicit that this operation does not reset the insertion head, and the block
-    // is still considered "full" and will not be inserted into.
+    // This does not reset the insertion head, so Allocate will not hand the slot out again. AllocateFreed does.
   }
 
   /**
@@ -285,5 +304,7 @@ class TupleAccessStrategy {
   const BlockLayout layout_;
   // Start of each mini block, in offset to the start of the block
   std::vector<uint32_t> column_offsets_;
+  // Start of the values of each column, in offset to the start of the block
+  std::vector<uint32_t> value_offsets_;
 };
 }  // namespace noisepage::storage
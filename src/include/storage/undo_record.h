@@ -134,6 +134,26 @@ class UndoRecord {
     return result;
   }
 
+  /**
+   * Populates the UndoRecord to hold a row lock.
+   *
+   * @param head pointer to the byte buffer to initialize as a UndoRecord
+   * @param timestamp timestamp of the transaction that generated this UndoRecord
+   * @param slot the TupleSlot this UndoRecord points to
+   * @param table the DataTable this UndoRecord points to
+   * @return pointer to the initialized UndoRecord
+   */
+  static UndoRecord *InitializeLock(byte *const head, const transaction::timestamp_t timestamp, const TupleSlot slot,
+                                    DataTable *const table) {
+    auto *result = reinterpret_cast<UndoRecord *>(head);
+    result->type_ = DeltaRecordType::LOCK;
+    result->next_ = nullptr;
+    result->timestamp_.store(timestamp);
+    result->table_ = table;
+    result->slot_ = slot;
+    return result;
+  }
+
   /**
    * Populates the UndoRecord's members to hold an update.
    *
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+#include "common/allocator.h"
+
+namespace noisepage::storage {
+
+/**
+ * Allocator for the out-of-line contents of VarlenEntrys that need reclaiming. Every such content buffer has to come
+ * from Allocate, and has to be handed back through Deallocate, however far it travels before that (into a table,
+ * through undo records, into the loose pointers of a transaction or the compactor).
+ *
+ * Contents of up to MAX_POOLED_SIZE bytes are rounded up to one of a few size classes, and carved out of large slabs
+ * that are never returned to the system. Every thread keeps a small cache of free chunks for each size class, and only
+ * goes to the shared pool of the class to move a batch of chunks at a time. Most allocations and deallocations
+ * therefore take no latch, and the GC, which frees the contents of all the workers' old versions when it reclaims
+ * their transactions, hands them back in bulk. Larger contents are allocated from the system.
+ */
+class VarlenAllocator {
+ public:
+  VarlenAllocator() = delete;
+
+  /**
+   * Largest content, in bytes, that is allocated from a size class
+   */
+  static constexpr uint32_t MAX_POOLED_SIZE = 4096;
+
+  /**
+   * Allocates a buffer for the content of a varlen. The address is aligned to 8 bytes, like the ones returned by
+   * common::AllocationUtil::AllocateAligned.
+   * @param size size of the content, in bytes
+   * @return pointer to the buffer, which is not zeroed out
+   */
+  static byte *Allocate(uint32_t size);
+
+  /**
+   * Returns a buffer obtained from Allocate. It may be called from any thread.
+   * @param content pointer to the buffer
+   */
+  static void Deallocate(const byte *content);
+};
+
+}  // namespace noisepage::storage
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "common/strong_typedef.h"
+
+namespace noisepage::storage {
+
+/**
+ * Compression of large varlen contents where they are written out of the table, i.e. in the WAL, in checkpoints and
+ * in the log buffers that are shipped to replicas.
+ *
+ * The content is cut into chunks of CHUNK_SIZE bytes, which are compressed independently with a byte-oriented LZ77
+ * scheme, so that neither side ever holds more than a chunk worth of state. A compressed content is the sequence of
+ * its chunks, each one prefixed with its compressed length. Within a chunk, every sequence is a varint literal length,
+ * the literals, and then, unless the chunk ends there, a varint match length above MIN_MATCH and a 16-bit distance.
+ */
+class VarlenCompression {
+ public:
+  VarlenCompression() = delete;
+
+  /** Contents of at least this many bytes are compressed */
+  static constexpr uint32_t COMPRESSION_THRESHOLD = 4096;
+
+  /** Bit that is set in a serialized varlen size if its content is compressed. Sizes never use it. */
+  static constexpr uint32_t COMPRESSED_FLAG = 1U << 31;
+
+  /** Number of bytes of content that are compressed together */
+  static constexpr uint32_t CHUNK_SIZE = 1U << 16;
+
+  /**
+   * @param size size of a content, in bytes
+   * @return whether a content of this size should be compressed when it is written out
+   */
+  static bool ShouldCompress(const uint32_t size) { return size >= COMPRESSION_THRESHOLD; }
+
+  /**
+   * @param size size of a content, in bytes
+   * @return the most bytes that Compress produces for a content of this size, as only results smaller than the content
+   * are kept
+   */
+  static constexpr uint32_t MaxCompressedSize(const uint32_t size) { return size == 0 ? 0 : size - 1; }
+
+  /**
+   * Compresses a content
+   * @param content content to compress
+   * @param size size of the content, in bytes
+   * @param[out] out buffer that receives the compressed content, resized as needed
+   * @return size of the compressed content, or 0 if it is not smaller than the content itself, in which case the
+   * content should be written out as is
+   */
+  static uint32_t Compress(const byte *content, uint32_t size, std::vector<byte> *out);
+
+  /**
+   * Decompresses a content that Compress produced
+   * @param compressed the compressed content
+   * @param compressed_size size of the compressed content, in bytes
+   * @param[out] out buffer of the size of the original content
+   * @param size size of the original content, in bytes
+   * @return true if the compressed content was well-formed and decompressed to exactly size bytes
+   */
+  static bool Decompress(const byte *compressed, uint32_t compressed_size, byte *out, uint32_t size);
+};
+
+}  // namespace noisepage::storage
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <condition_variable>  // NOLINT
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -8,35 +9,53 @@
 #include "common/container/concurrent_queue.h"
 #include "common/dedicated_thread_task.h"
 #include "storage/storage_defs.h"
+#include "storage/write_ahead_log/group_commit_policy.h"
 #include "storage/write_ahead_log/log_io.h"
+#include "storage/write_ahead_log/persistent_log_ring.h"
 
 namespace noisepage::storage {
 
 /**
  * A DiskLogConsumerTask is responsible for writing serialized log records out to disk by processing buffers in the log
- * manager's filled buffer queue
+ * manager's filled buffer queue. Commits are persisted in groups. @see GroupCommitPolicy
+ *
+ * With a PersistentLogRing, every buffer written to the log file is appended to the ring as well, and the commits of
+ * the buffer are acknowledged as soon as the append returns. The log file is still persisted in groups, which resets
+ * the ring. Once the ring is full, commits are only acknowledged by persisting the log file again, until the next
+ * persist makes room in the ring.
  */
 class DiskLogConsumerTask : public common::DedicatedThreadTask {
  public:
   /**
    * Constructs a new DiskLogConsumerTask
-   * @param persist_interval Interval time for when to persist log file
+   * @param persist_interval Interval time for when to persist log file, also the maximum time a commit is held back
    * @param persist_threshold threshold of data written since the last persist to trigger another persist
    * @param buffers pointer to list of all buffers used by log manager, used to persist log file
    * @param empty_buffer_queue pointer to queue to push empty buffers to
    * @param filled_buffer_queue pointer to queue to pop filled buffers from
+   * @param preallocation_size size of the chunks of disk space reserved ahead of the end of the log file, 0 to disable
+   * @param log_file_path log file of the stream, used to name its segments
+   * @param segment_size size after which the log file is continued in a new segment, 0 to disable
+   * @param ring ring to acknowledge commits from ahead of persisting the log file, nullptr to disable. Must be drained.
    */
   explicit DiskLogConsumerTask(const std::chrono::microseconds persist_interval, uint64_t persist_threshold,
                                std::vector<BufferedLogWriter> *buffers,
                                common::ConcurrentBlockingQueue<BufferedLogWriter *> *empty_buffer_queue,
-                               common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue)
+                               common::ConcurrentQueue<storage::SerializedLogs> *filled_buffer_queue,
+                               uint64_t preallocation_size = 0, std::string log_file_path = "",
+                               uint64_t segment_size = 0, PersistentLogRing *ring = nullptr)
       : run_task_(false),
         persist_interval_(persist_interval),
         persist_threshold_(persist_threshold),
+        preallocation_size_(preallocation_size),
+        log_file_path_(std::move(log_file_path)),
+        segment_size_(segment_size),
         current_data_written_(0),
+        group_commit_policy_(persist_interval, persist_threshold),
         buffers_(buffers),
         empty_buffer_queue_(empty_buffer_queue),
-        filled_buffer_queue_(filled_buffer_queue) {}
+        filled_buffer_queue_(filled_buffer_queue),
+        ring_(ring) {}
 
   /**
    * Runs main disk log writer loop. Called by thread registry upon initialization of thread
@@ -48,6 +67,11 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
    */
   void Terminate() override;
 
+  /**
+   * @return the role of the disk log writer thread
+   */
+  common::ThreadRole GetThreadRole() const override { return common::ThreadRole::WAL; }
+
  private:
   friend class LogManager;
   // Flag to signal task to run or stop
@@ -59,8 +83,23 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
   const std::chrono::microseconds persist_interval_;
   // Threshold of data written since the last persist to trigger another persist
   uint64_t persist_threshold_;
+  // Size of the chunks of disk space reserved ahead of the end of the log file, 0 if disabled
+  const uint64_t preallocation_size_;
+  // Log file of the stream, segment files are named after it
+  const std::string log_file_path_;
+  // Size after which the log file is continued in a new segment, 0 if disabled
+  const uint64_t segment_size_;
+  // Segment that is currently written to
+  uint64_t segment_ = 0;
+  // Size of the current segment, and end of the disk space reserved for it
+  uint64_t log_file_size_ = 0;
+  uint64_t preallocated_end_ = 0;
   // Amount of data written since last persist
   uint64_t current_data_written_;
+  // Decides when to persist the commits written since the last persist
+  GroupCommitPolicy group_commit_policy_;
+  // Duration of the last fsync, used for metrics
+  uint64_t last_fsync_latency_us_ = 0;
 
   // This stores a reference to all the buffers the log manager has created. Used for persisting
   std::vector<BufferedLogWriter> *buffers_;
@@ -68,6 +107,10 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
   common::ConcurrentBlockingQueue<BufferedLogWriter *> *empty_buffer_queue_;
   // The queue containing filled buffers. Task should dequeue filled buffers from this queue to flush
   common::ConcurrentQueue<SerializedLogs> *filled_buffer_queue_;
+  // Ring that commits are acknowledged from ahead of persisting the log file, or nullptr
+  PersistentLogRing *const ring_;
+  // True if the ring holds everything written since the last persist, so that the commits written can be acknowledged
+  bool ring_holds_unpersisted_ = false;
 
   // Flag used by the serializer thread to signal the disk log consumer task thread to persist the data on disk
   volatile bool force_flush_;
@@ -86,9 +129,26 @@ class DiskLogConsumerTask : public common::DedicatedThreadTask {
   void DiskLogConsumerTaskLoop();
 
   /**
-   * Flush all buffers in the filled buffers queue to the log file
+   * Flush all buffers in the filled buffers queue to the log file. The commit callbacks of buffers that the ring holds
+   * are invoked right away, the others are collected to be invoked once the log file is persisted.
+   * @return number of commit callbacks collected from the flushed buffers
+   */
+  uint64_t WriteBuffersToLogFile();
+
+  /**
+   * Reserve another chunk of disk space once the log file grows close to the end of the reserved space
+   */
+  void PreallocateLogFile();
+
+  /**
+   * Empty the ring once everything written to the log file is persisted, so that it can hold the following writes
+   */
+  void ResetRing();
+
+  /**
+   * Seal the current segment by recording it in the manifest, and continue writing to a new segment
    */
-  void WriteBuffersToLogFile();
+  void StartNewSegment();
 
   /*
    * Persists the log file on disk by calling fsync, as well as calling callbacks for all committed transactions that
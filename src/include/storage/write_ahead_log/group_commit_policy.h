@@ -0,0 +1,121 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>  // NOLINT
+#include <cstdint>
+
+namespace noisepage::storage {
+
+/**
+ * Decides when the DiskLogConsumerTask persists the log file. Commits are held back and persisted together with a
+ * single fsync (group commit), but a commit is only ever held back if more commits are expected to arrive while it
+ * waits:
+ *   1. The log file is persisted as soon as the data written since the last persist exceeds the byte threshold.
+ *   2. Otherwise, the commits waiting to be persisted are held back by a delay derived from the observed commit
+ *      arrival rate and fsync latency. If the next commit is expected within roughly one fsync, it pays to wait for it.
+ *      If not, which is the case at low load, there is no delay and every commit is persisted right away.
+ *   3. The delay is capped by the persist interval, which bounds the added commit latency.
+ * Both the commit inter-arrival time and the fsync latency are tracked as exponentially weighted moving averages.
+ */
+class GroupCommitPolicy {
+ public:
+  /** Clock used by the policy */
+  using Clock = std::chrono::high_resolution_clock;
+
+  /**
+   * @param max_delay upper bound on how long a commit is held back
+   * @param byte_threshold amount of data written since the last persist that triggers a persist
+   */
+  GroupCommitPolicy(const std::chrono::microseconds max_delay, const uint64_t byte_threshold)
+      : max_delay_(max_delay), byte_threshold_(byte_threshold) {}
+
+  /**
+   * Record that new commits were handed to the consumer and now wait to be persisted.
+   * @param num_commits number of newly arrived commits
+   * @param now time of arrival
+   */
+  void CommitsArrived(const uint64_t num_commits, const Clock::time_point now) {
+    if (num_commits == 0) return;
+    if (has_arrival_) {
+      const auto elapsed = static_cast<double>(ToMicros(now - last_arrival_));
+      UpdateAverage(&avg_inter_arrival_us_, &has_inter_arrival_sample_, elapsed / static_cast<double>(num_commits));
+    }
+    has_arrival_ = true;
+    last_arrival_ = now;
+    if (pending_commits_ == 0) first_pending_ = now;
+    pending_commits_ += num_commits;
+  }
+
+  /**
+   * Record that the log file was persisted, which also persisted all pending commits.
+   * @param bytes_persisted data written since the last persist, no fsync happens if this is 0
+   * @param fsync_latency time the fsync took
+   */
+  void Persisted(const uint64_t bytes_persisted, const std::chrono::microseconds fsync_latency) {
+    if (bytes_persisted > 0) {
+      UpdateAverage(&avg_fsync_latency_us_, &has_fsync_latency_sample_, static_cast<double>(fsync_latency.count()));
+    }
+    pending_commits_ = 0;
+  }
+
+  /**
+   * @param bytes_written data written since the last persist
+   * @param now current time
+   * @return true if the log file should be persisted now
+   */
+  bool ShouldPersist(const uint64_t bytes_written, const Clock::time_point now) const {
+    if (bytes_written > byte_threshold_) return true;
+    return pending_commits_ > 0 && now - first_pending_ >= Delay();
+  }
+
+  /**
+   * @param now current time
+   * @return how long the consumer may sleep before the pending commits must be persisted, or the maximum delay if
+   * there are no pending commits
+   */
+  std::chrono::microseconds TimeUntilDeadline(const Clock::time_point now) const {
+    if (pending_commits_ == 0) return max_delay_;
+    const auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(first_pending_ + Delay() - now);
+    return std::max(remaining, std::chrono::microseconds(0));
+  }
+
+  /** @return how long pending commits are currently held back before they are persisted */
+  std::chrono::microseconds Delay() const {
+    const auto window = std::min(static_cast<double>(max_delay_.count()), avg_fsync_latency_us_);
+    // Only wait if another commit is expected to arrive before the wait is over
+    if (!has_inter_arrival_sample_ || avg_inter_arrival_us_ >= window) return std::chrono::microseconds(0);
+    return std::chrono::microseconds(static_cast<int64_t>(window));
+  }
+
+  /** @return number of commits waiting to be persisted */
+  uint64_t PendingCommits() const { return pending_commits_; }
+
+ private:
+  // Weight of a new sample in the moving averages
+  static constexpr double SMOOTHING_FACTOR = 0.2;
+
+  const std::chrono::microseconds max_delay_;
+  const uint64_t byte_threshold_;
+
+  // Nothing is held back until both the arrival rate and the fsync latency have been observed
+  double avg_inter_arrival_us_ = 0;
+  bool has_inter_arrival_sample_ = false;
+  double avg_fsync_latency_us_ = 0;
+  bool has_fsync_latency_sample_ = false;
+
+  bool has_arrival_ = false;
+  Clock::time_point last_arrival_;
+  Clock::time_point first_pending_;
+  uint64_t pending_commits_ = 0;
+
+  static void UpdateAverage(double *const average, bool *const has_sample, const double sample) {
+    *average = *has_sample ? SMOOTHING_FACTOR * sample + (1 - SMOOTHING_FACTOR) * *average : sample;
+    *has_sample = true;
+  }
+
+  static int64_t ToMicros(const Clock::duration duration) {
+    return std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+  }
+};
+
+}  // namespace noisepage::storage
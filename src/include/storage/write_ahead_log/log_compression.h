@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace noisepage::storage {
+
+/**
+ * Lightweight compression of serialized log buffers. The format is a byte-oriented LZ77 variant in the spirit of LZ4:
+ * a sequence of (literals, match) pairs, where a match copies previously decompressed bytes. It is fast enough to run
+ * on the log consumers' critical path, and compresses the repetitive parts of the log well, which are mostly record
+ * headers, column ids, attribute size boundaries and the unchanged parts of updated rows.
+ *
+ * Each sequence is encoded as:
+ *   token              high 4 bits: number of literals, low 4 bits: match length - MIN_MATCH (15 means extended)
+ *   [literal length]   extension of the literal length, a run of 255 bytes terminated by a byte < 255
+ *   literals
+ *   offset             2 byte distance to the start of the match, omitted in the last sequence
+ *   [match length]     extension of the match length, encoded like the literal length
+ *
+ * A compressed log buffer is stored as a frame, a FrameHeader followed by the compressed bytes. Buffers that do not
+ * compress are stored as they are.
+ */
+class LogCompression {
+ public:
+  /** Header of a compressed log buffer */
+  struct FrameHeader {
+    /** Number of bytes stored in the frame after the header. If this equals size_, the bytes are not compressed. */
+    uint32_t stored_size_;
+    /** Number of bytes the frame decompresses to */
+    uint32_t size_;
+  };
+
+  LogCompression() = delete;
+
+  /**
+   * Compress the given bytes into a frame.
+   * @param src bytes to compress
+   * @param size number of bytes to compress
+   * @param[out] frame the frame, header included
+   */
+  static void CompressFrame(const char *src, uint32_t size, std::vector<char> *frame);
+
+  /**
+   * Decompress the contents of a frame. An exception is thrown if they are not well formed.
+   * @param header header of the frame
+   * @param stored_bytes the header.stored_size_ bytes stored after the header
+   * @param dest location to write the header.size_ decompressed bytes to
+   */
+  static void DecompressFrame(const FrameHeader &header, const char *stored_bytes, char *dest);
+
+  /**
+   * @param size number of bytes to compress
+   * @return upper bound on the compressed size of the given number of bytes
+   */
+  static constexpr uint32_t MaxCompressedSize(const uint32_t size) { return size + size / 255 + 16; }
+
+  /**
+   * Compress the given bytes.
+   * @param src bytes to compress
+   * @param size number of bytes to compress
+   * @param dest location to write the compressed bytes to, must have room for at least MaxCompressedSize(size) bytes
+   * @return size of the compressed bytes
+   */
+  static uint32_t Compress(const char *src, uint32_t size, char *dest);
+
+  /**
+   * Decompress the given bytes. An exception is thrown if they are not well formed.
+   * @param src compressed bytes
+   * @param compressed_size number of compressed bytes
+   * @param dest location to write the decompressed bytes to
+   * @param size number of bytes the compressed bytes decompress to
+   */
+  static void Decompress(const char *src, uint32_t compressed_size, char *dest, uint32_t size);
+
+ private:
+  static constexpr uint32_t MIN_MATCH = 4;
+  static constexpr uint32_t MAX_OFFSET = UINT16_MAX;
+  static constexpr uint32_t HASH_BITS = 12;
+  static constexpr uint8_t LENGTH_MASK = 15;
+};
+
+}  // namespace noisepage::storage
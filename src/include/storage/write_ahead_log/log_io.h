@@ -9,6 +9,7 @@
 #include <atomic>
 #include <cerrno>
 #include <cstring>
+#include <deque>
 #include <string>
 #include <utility>
 #include <vector>
@@ -17,6 +18,7 @@
 #include "common/macros.h"
 #include "common/posix_io_wrappers.h"
 #include "loggers/storage_logger.h"
+#include "storage/write_ahead_log/log_compression.h"
 #include "transaction/transaction_defs.h"
 
 namespace noisepage::replication {
@@ -38,9 +40,12 @@ class BufferedLogWriter {
    *
    * @param log_file_path path to the the log file to write to. New entries are appended to the end of the file if the
    * file already exists; otherwise, a file is created.
+   * @param compress true if each flushed buffer is written to the log file as a compressed frame. A log file must be
+   * written with the same setting throughout. @see LogCompression
    */
-  explicit BufferedLogWriter(const char *const log_file_path)
-      : out_(PosixIoWrappers::Open(log_file_path, O_WRONLY | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR)) {}
+  explicit BufferedLogWriter(const char *const log_file_path, const bool compress = false)
+      : out_(PosixIoWrappers::Open(log_file_path, O_WRONLY | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR)),
+        compress_(compress) {}
 
   /**
    * Move constructor.
@@ -50,7 +55,7 @@ class BufferedLogWriter {
    * moved at runtime -- this exists solely so that std::vector's emplace_back requirement of being both MoveInsertable
    * and EmplaceConstructible will be satisfied.
    */
-  BufferedLogWriter(BufferedLogWriter &&other) noexcept : out_(other.out_) {
+  BufferedLogWriter(BufferedLogWriter &&other) noexcept : out_(other.out_), compress_(other.compress_) {
     memcpy(buffer_, other.buffer_, common::Constants::LOG_BUFFER_SIZE);
     buffer_size_ = other.buffer_size_;
     serialize_refcount_.store(other.serialize_refcount_.load());
@@ -61,6 +66,16 @@ class BufferedLogWriter {
    */
   void Close() { PosixIoWrappers::Close(out_); }
 
+  /**
+   * Close the current log file, and continue writing to the given one. Only the thread that flushes and persists the
+   * writer may call this. The buffered contents are retained.
+   * @param log_file_path path to the log file to write to from now on, created if it does not exist
+   */
+  void SwitchFile(const char *const log_file_path) {
+    PosixIoWrappers::Close(out_);
+    out_ = PosixIoWrappers::Open(log_file_path, O_WRONLY | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR);
+  }
+
   /**
    * Write to the log file the given amount of bytes from the given location in memory, but buffer the write so the
    * update is only written out when the BufferedLogWriter is persisted. Note that this function writes to the buffer
@@ -96,17 +111,79 @@ class BufferedLogWriter {
 #endif
   }
 
+  /**
+   * Start writing back the data flushed to the log file without waiting for it to complete. A following Persist() then
+   * only has to wait for whatever is still in flight, so the writeback overlaps with the work done in the meantime.
+   * This is only a hint, and a no-op on platforms without sync_file_range.
+   */
+  void StartWriteback() {
+#if __linux__
+    // A failed hint is not an error, Persist() still writes back everything
+    sync_file_range(out_, 0, 0, SYNC_FILE_RANGE_WRITE);
+#endif
+  }
+
+  /**
+   * Reserve disk space for the log file without changing its size, so that the writes that fill the space do not need
+   * to allocate blocks, and persisting them does not need to persist the file system metadata for the new blocks. This
+   * is only a hint, and a no-op on platforms without fallocate.
+   * @param offset start of the range to reserve
+   * @param size size of the range to reserve
+   */
+  void Preallocate(const uint64_t offset, const uint64_t size) {
+#if __linux__
+    if (fallocate(out_, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(offset), static_cast<off_t>(size)) == -1) {
+      STORAGE_LOG_WARN("fallocate of the log file failed with errno {}", errno);
+    }
+#endif
+  }
+
+  /**
+   * @return current size of the log file
+   */
+  uint64_t FileSize() const {
+    struct stat file_stat;
+    if (fstat(out_, &file_stat) == -1) throw std::runtime_error("fstat failed with errno " + std::to_string(errno));
+    return static_cast<uint64_t>(file_stat.st_size);
+  }
+
   /**
    * Flush any buffered writes.
    * @return amount of data flushed
    */
   uint64_t FlushBuffer() {
-    const auto size = buffer_size_;
-    WriteUnsynced(buffer_, buffer_size_);
+    return FlushBuffer([](const char *, uint32_t) {});
+  }
+
+  /**
+   * Flush any buffered writes, handing the bytes to the given function before they are written to the log file, e.g.
+   * to append them to a PersistentLogRing as well.
+   * @tparam F type of the function, invoked as before_write(const char *data, uint32_t size)
+   * @param before_write function to hand the bytes to, which is not invoked if there are none
+   * @return amount of data flushed
+   */
+  template <typename F>
+  uint64_t FlushBuffer(F before_write) {
+    const char *data = buffer_;
+    uint32_t size = buffer_size_;
+    if (compress_ && size > 0) {
+      const std::vector<char> &frame = CompressBuffer();
+      data = frame.data();
+      size = static_cast<uint32_t>(frame.size());
+    }
+    if (size > 0) {
+      before_write(data, size);
+      WriteUnsynced(data, size);
+    }
     buffer_size_ = 0;
     return size;
   }
 
+  /**
+   * @return true if flushed buffers are compressed
+   */
+  bool IsCompressing() const { return compress_; }
+
   /**
    * @return if the buffer is full
    */
@@ -136,7 +213,8 @@ class BufferedLogWriter {
     }
     if (policy.replication_ != transaction::ReplicationPolicy::DISABLE) {
       NOISEPAGE_ASSERT(policy.replication_ == transaction::ReplicationPolicy::SYNC ||
-                           policy.replication_ == transaction::ReplicationPolicy::ASYNC,
+                           policy.replication_ == transaction::ReplicationPolicy::ASYNC ||
+                           policy.replication_ == transaction::ReplicationPolicy::QUORUM,
                        "Unknown replication policy.");
       serialize_refcount_ += 1;
     }
@@ -158,7 +236,8 @@ class BufferedLogWriter {
  private:
   friend class replication::RecordsBatchMsg;
 
-  const int out_;  // fd of the output files
+  int out_;  // fd of the output files
+  const bool compress_;
   char buffer_[common::Constants::LOG_BUFFER_SIZE];
 
   uint32_t buffer_size_ = 0;
@@ -167,6 +246,9 @@ class BufferedLogWriter {
   bool CanBuffer(uint32_t size) { return common::Constants::LOG_BUFFER_SIZE - buffer_size_ >= size; }
 
   void WriteUnsynced(const void *data, uint32_t size) { PosixIoWrappers::WriteFully(out_, data, size); }
+
+  // Compresses the buffer into a frame, which stays valid until the next call on the same thread
+  const std::vector<char> &CompressBuffer();
 };
 
 /**
@@ -177,8 +259,29 @@ class BufferedLogReader {
   /**
    * Instantiates a new BufferedLogReader to read from the specified log file.
    * @param log_file_path path to the the log file to read from.
+   * @param compressed true if the log file consists of compressed frames
    */
-  explicit BufferedLogReader(const char *log_file_path) : in_(PosixIoWrappers::Open(log_file_path, O_RDONLY)) {}
+  explicit BufferedLogReader(const char *log_file_path, const bool compressed = false)
+      : in_(PosixIoWrappers::Open(log_file_path, O_RDONLY)), compressed_(compressed) {
+    if (compressed_) ReadNextFrameHeader();
+  }
+
+  /**
+   * Instantiates a new BufferedLogReader to read from the concatenation of the specified log files, e.g. the segments
+   * of a log that is split into several segments.
+   * @param log_file_paths paths to the files to read from, in order. There must be at least one.
+   * @param compressed true if the log files consist of compressed frames
+   */
+  explicit BufferedLogReader(const std::vector<std::string> &log_file_paths, const bool compressed = false)
+      : BufferedLogReader(log_file_paths.at(0).c_str(), compressed) {
+    if (log_file_paths.size() == 1) return;
+    remaining_files_.assign(log_file_paths.begin() + 1, log_file_paths.end());
+    // An empty first file has already been closed
+    if (in_ == -1) {
+      OpenNextFile();
+      if (compressed_) ReadNextFrameHeader();
+    }
+  }
 
   /**
    * Closes log file if it has not been closed already. While Read will close the file if it reaches the end, this will
@@ -220,9 +323,17 @@ class BufferedLogReader {
 
  private:
   int in_;  // or -1 if closed
+  // Files to continue reading from once the current one is exhausted
+  std::deque<std::string> remaining_files_;
   uint32_t read_head_ = 0, filled_size_ = 0;
   char buffer_[common::Constants::LOG_BUFFER_SIZE];
 
+  // Compressed log files are read one frame at a time. The header of the next frame is read ahead, so that the file
+  // can be closed as soon as the last frame is buffered.
+  const bool compressed_;
+  LogCompression::FrameHeader next_frame_header_{};
+  std::vector<char> frame_buffer_;
+
   void ReadFromBuffer(void *dest, uint32_t size) {
     NOISEPAGE_ASSERT(read_head_ + size <= filled_size_, "Not enough bytes in buffer for the read");
     std::memcpy(dest, buffer_ + read_head_, size);
@@ -230,6 +341,13 @@ class BufferedLogReader {
   }
 
   void RefillBuffer();
+
+  void RefillBufferFromFrame();
+
+  void ReadNextFrameHeader();
+
+  // Close the current file and open the next one, if any
+  void OpenNextFile();
 };
 
 /** A commit callback is of the form fn_(arg_), and is invoked when the corresponding commit record is persisted. */
@@ -16,6 +16,7 @@
 #include "storage/record_buffer.h"
 #include "storage/write_ahead_log/log_io.h"
 #include "storage/write_ahead_log/log_record.h"
+#include "storage/write_ahead_log/persistent_log_ring.h"
 
 namespace noisepage::replication {
 class PrimaryReplicationManager;
@@ -42,6 +43,23 @@ class DiskLogConsumerTask;
  *          c) A sufficient amount of data has been written since the last persist
  *      5. When the persist is done, the `DiskLogConsumerTask` will call the commit callbacks for any CommitRecords that
  * were just persisted.
+ *
+ * The LogManager can split logging into several independent streams, so that a single serializer does not become the
+ * bottleneck with many writer threads. Each stream has its own buffers, LogSerializerTask, DiskLogConsumerTask and log
+ * file (@see LogFilePaths). All buffers of a transaction go to the same stream, which is chosen by hashing the
+ * transaction's start timestamp. Commit records are therefore only ordered within a stream, and recovery has to merge
+ * the streams by commit timestamp (@see MultiStreamLogProvider).
+ *
+ * The log file of a stream can be split into segments of bounded size. The DiskLogConsumerTask starts a new segment
+ * once the current one exceeds the segment size after a persist, so sealed segments are complete and never written to
+ * again. Segment 0 is the stream's log file itself, segment n > 0 is written to <log file>.seg<n>. Every sealed segment
+ * is recorded in the stream's manifest <log file>.manifest, which backup tools can use to find the segments that are
+ * safe to archive (@see LogSegmentPaths).
+ *
+ * Every stream can have a PersistentLogRing in persistent memory, which its DiskLogConsumerTask acknowledges commits
+ * from before persisting the log file. The rings of several streams are named like their log files (@see
+ * LogFilePaths). Start drains whatever a ring still holds after a crash into the log file, before the log file is
+ * opened or read by recovery, so a ring must stay configured until it was drained once.
  */
 class LogManager : public common::DedicatedThreadOwner {
  public:
@@ -61,27 +79,28 @@ class LogManager : public common::DedicatedThreadOwner {
    * @param primary_replication_manager     The replication manager that handles shipping logs over the network.
    *                                        Currently only the primary does this.
    * @param thread_registry                 DedicatedThreadRegistry dependency injection
+   * @param num_streams                     Number of independent log streams. Replication requires a single stream.
+   * @param preallocation_size              Size of the chunks of disk space reserved ahead of the end of each log
+   *                                        file, 0 to disable
+   * @param compression_enable              True if log buffers are compressed before they are written and replicated
+   * @param segment_size                    Size after which the log file of a stream is continued in a new segment, 0
+   *                                        to never start a new segment
+   * @param ring_path                       Path to the ring in persistent memory that commits are acknowledged from,
+   *                                        empty to only acknowledge commits by persisting the log file
+   * @param ring_size                       Capacity of the ring of each stream
    */
   LogManager(std::string log_file_path, uint64_t num_buffers, std::chrono::microseconds serialization_interval,
              std::chrono::microseconds persist_interval, uint64_t persist_threshold,
              common::ManagedPointer<RecordBufferSegmentPool> buffer_pool,
              common::ManagedPointer<common::ConcurrentBlockingQueue<BufferedLogWriter *>> empty_buffer_queue,
              common::ManagedPointer<replication::PrimaryReplicationManager> primary_replication_manager,
-             common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry)
-      : DedicatedThreadOwner(thread_registry),
-        run_log_manager_(false),
-        log_file_path_(std::move(log_file_path)),
-        num_buffers_(num_buffers),
-        buffer_pool_(buffer_pool.Get()),
-        empty_buffer_queue_(empty_buffer_queue),
-        serialization_interval_(serialization_interval),
-        persist_interval_(persist_interval),
-        persist_threshold_(persist_threshold),
-        primary_replication_manager_(primary_replication_manager) {}
+             common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry, uint32_t num_streams = 1,
+             uint64_t preallocation_size = 0, bool compression_enable = false,
+             uint64_t segment_size = 0, std::string ring_path = "", uint64_t ring_size = 0);
 
   /**
    * Starts log manager. Does the following in order:
-   *    1. Initialize buffers to pass serialized logs to log consumers
+   *    1. Drain the rings into the log files, and initialize buffers to pass serialized logs to log consumers
    *    2. Starts up DiskLogConsumerTask
    *    3. Starts up LogSerializerTask
    */
@@ -114,9 +133,40 @@ class LogManager : public common::DedicatedThreadOwner {
    */
   void AddBufferToFlushQueue(RecordBufferSegment *buffer_segment, const transaction::TransactionPolicy &policy);
 
+  /**
+   * @param log_file_path path of the log file the LogManager was constructed with
+   * @param num_streams number of log streams
+   * @return the log file of each stream. A single stream writes to log_file_path, several streams write to
+   * log_file_path.0, log_file_path.1, etc.
+   */
+  static std::vector<std::string> LogFilePaths(const std::string &log_file_path, uint32_t num_streams);
+
+  /**
+   * @param stream_log_file_path log file of a stream
+   * @param segment segment number
+   * @return the file the given segment of the stream is written to
+   */
+  static std::string LogSegmentPath(const std::string &stream_log_file_path, uint64_t segment);
+
+  /**
+   * @param stream_log_file_path log file of a stream
+   * @return the files of all segments of the stream that exist on disk, in order. This is at least the stream's log
+   * file itself, even if it does not exist.
+   */
+  static std::vector<std::string> LogSegmentPaths(const std::string &stream_log_file_path);
+
+  /**
+   * @param stream_log_file_path log file of a stream
+   * @return the manifest that records the sealed segments of the stream, one "<segment file> <size in bytes>" per line
+   */
+  static std::string LogManifestPath(const std::string &stream_log_file_path);
+
+  /** @return number of log streams */
+  uint32_t GetNumStreams() const { return static_cast<uint32_t>(streams_.size()); }
+
   /**
    * For testing only
-   * @return number of buffers used for logging
+   * @return number of buffers used for logging, per stream
    */
   uint64_t TestGetNumBuffers() { return num_buffers_; }
 
@@ -130,9 +180,11 @@ class LogManager : public common::DedicatedThreadOwner {
   bool SetNumBuffers(uint64_t new_num_buffers) {
     if (new_num_buffers >= num_buffers_) {
       // Add in new buffers
-      for (size_t i = 0; i < new_num_buffers - num_buffers_; i++) {
-        buffers_.emplace_back(log_file_path_.c_str());
-        empty_buffer_queue_->Enqueue(&buffers_[num_buffers_ + i]);
+      for (auto &stream : streams_) {
+        for (size_t i = 0; i < new_num_buffers - num_buffers_; i++) {
+          stream->buffers_.emplace_back(stream->log_file_path_.c_str());
+          stream->empty_buffer_queue_->Enqueue(&stream->buffers_[num_buffers_ + i]);
+        }
       }
       num_buffers_ = new_num_buffers;
       return true;
@@ -153,42 +205,68 @@ class LogManager : public common::DedicatedThreadOwner {
   void EndReplication();
 
  private:
+  /**
+   * An independent log stream: buffers, tasks and log file.
+   */
+  struct LogStream {
+    // System path for the log file of this stream
+    std::string log_file_path_;
+    // This stores a reference to all the buffers the serializer or the log consumer threads use
+    std::vector<BufferedLogWriter> buffers_;
+    // Owns the empty buffer queue of every stream but the first one, which uses the queue handed to the LogManager
+    std::unique_ptr<common::ConcurrentBlockingQueue<BufferedLogWriter *>> owned_empty_buffer_queue_;
+    // The queue containing empty buffers which the serializer thread will use. We use a blocking queue because the
+    // serializer thread should block when requesting a new buffer until it receives an empty buffer
+    common::ManagedPointer<common::ConcurrentBlockingQueue<BufferedLogWriter *>> empty_buffer_queue_;
+    // The queue containing filled buffers pending flush to the disk
+    common::ConcurrentQueue<SerializedLogs> filled_buffer_queue_;
+    // Ring of this stream in persistent memory, or nullptr if there is none. Opened when the log manager first starts.
+    std::unique_ptr<PersistentLogRing> ring_;
+    // Log serializer task that processes buffers handed over by transactions and serializes them into consumer buffers
+    common::ManagedPointer<LogSerializerTask> log_serializer_task_ = common::ManagedPointer<LogSerializerTask>(nullptr);
+    // The log consumer task which flushes filled buffers to the disk
+    common::ManagedPointer<DiskLogConsumerTask> disk_log_writer_task_ =
+        common::ManagedPointer<DiskLogConsumerTask>(nullptr);
+  };
+
   // Flag to tell us when the log manager is running or during termination
   bool run_log_manager_;
 
-  // System path for log file
-  std::string log_file_path_;
-
-  // Number of buffers to use for buffering and serializing logs
+  // Number of buffers to use for buffering and serializing logs, per stream
   uint64_t num_buffers_;
 
   // TODO(Tianyu): This can be changed later to be include things that are not necessarily backed by a disk
   //  (e.g. logs can be streamed out to the network for remote replication)
   RecordBufferSegmentPool *buffer_pool_;
 
-  // This stores a reference to all the buffers the serializer or the log consumer threads use
-  std::vector<BufferedLogWriter> buffers_;
-  // The queue containing empty buffers which the serializer thread will use. We use a blocking queue because the
-  // serializer thread should block when requesting a new buffer until it receives an empty buffer
-  common::ManagedPointer<common::ConcurrentBlockingQueue<BufferedLogWriter *>> empty_buffer_queue_;
-  // The queue containing filled buffers pending flush to the disk
-  common::ConcurrentQueue<SerializedLogs> filled_buffer_queue_;
+  // The log streams. Stored as pointers so that the tasks' references into a stream stay valid.
+  std::vector<std::unique_ptr<LogStream>> streams_;
 
-  // Log serializer task that processes buffers handed over by transactions and serializes them into consumer buffers
-  common::ManagedPointer<LogSerializerTask> log_serializer_task_ = common::ManagedPointer<LogSerializerTask>(nullptr);
   // Interval used by log serialization task
   std::chrono::microseconds serialization_interval_;
 
-  // The log consumer task which flushes filled buffers to the disk
-  common::ManagedPointer<DiskLogConsumerTask> disk_log_writer_task_ =
-      common::ManagedPointer<DiskLogConsumerTask>(nullptr);
   // Interval used by disk consumer task
   const std::chrono::microseconds persist_interval_;
   // Threshold used by disk consumer task
   uint64_t persist_threshold_;
+  // Size of the chunks of disk space the disk consumer task reserves ahead of the end of the log file
+  const uint64_t preallocation_size_;
+  // True if log buffers are compressed before they are written and replicated
+  const bool compression_enable_;
+  // Size after which the disk consumer task continues the log file in a new segment, 0 if disabled
+  const uint64_t segment_size_;
+  // Path to the rings in persistent memory, empty if disabled, and the capacity of each ring
+  const std::string ring_path_;
+  const uint64_t ring_size_;
 
   common::ManagedPointer<replication::PrimaryReplicationManager> primary_replication_manager_;
 
+  /**
+   * @param buffer_segment buffer handed over by a transaction
+   * @return the stream that the buffer's transaction logs to
+   */
+  LogStream *GetStream(RecordBufferSegment *buffer_segment);
+
   /**
    * If the central registry wants to removes our thread used for the disk log consumer task, we only allow removal if
    * we are in shut down, else we need to keep the task, so we reject the removal
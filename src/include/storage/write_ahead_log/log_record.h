@@ -15,6 +15,12 @@ class LogRecord {
  public:
   MEM_REINTERPRETATION_ONLY(LogRecord)
 
+  /**
+   * Set on the serialized size of a record that is written as its in-memory image, followed by the contents of the
+   * varlen entries it points to. Records are far smaller than this flag, so it never clashes with an actual size.
+   */
+  static constexpr uint32_t NATIVE_FORMAT_FLAG = 1U << 31;
+
   /**
    * @return type of this LogRecord
    */
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <condition_variable>  // NOLINT
+#include <optional>
 #include <queue>
 #include <thread>  // NOLINT
 #include <tuple>
@@ -69,6 +70,11 @@ class LogSerializerTask : public common::DedicatedThreadTask {
     run_task_ = false;
   }
 
+  /**
+   * @return the role of the log serializer thread
+   */
+  common::ThreadRole GetThreadRole() const override { return common::ThreadRole::WAL; }
+
   /**
    * Hands a (possibly partially) filled buffer to the serializer task to be serialized
    * @param buffer_segment the (perhaps partially) filled log buffer ready to be consumed
@@ -114,6 +120,7 @@ class LogSerializerTask : public common::DedicatedThreadTask {
   std::optional<transaction::TransactionPolicy> filled_buffer_policy_;  ///< Transaction policy for the current buffer.
   std::vector<storage::CommitCallback> commits_in_buffer_;  ///< Commit callbacks for commit records in filled_buffer_.
   transaction::timestamp_t newest_buffer_txn_ = transaction::INITIAL_TXN_TIMESTAMP;  ///< Newest txn ever in buffer.
+  std::vector<byte> compression_buffer_;  ///< Holds the compressed content of the varlen being serialized.
 
   /** Used by the serializer thread to store buffers that were grabbed from the log manager. */
   std::queue<std::pair<RecordBufferSegment *, transaction::TransactionPolicy>> temp_flush_queue_;
@@ -165,6 +172,14 @@ class LogSerializerTask : public common::DedicatedThreadTask {
    */
   uint64_t SerializeRecord(const LogRecord &record);
 
+  /**
+   * Serialize out a redo record as its in-memory image, which is position-independent but for the varlen entries that
+   * point to their contents. Those contents are written after the image, for recovery to point the entries at.
+   * @param record the redo record to serialise
+   * @return bytes serialized, used for metrics
+   */
+  uint64_t SerializeRedoRecord(const LogRecord &record);
+
   /**
    * Serialize the data pointed to by val to current serialization buffer
    * @tparam T Type of the value
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "common/constants.h"
+#include "common/macros.h"
+
+namespace noisepage::storage {
+
+/**
+ * A small log tier in byte-addressable persistent memory that commits are acknowledged from, ahead of the fsync of the
+ * log file. The ring is a file mapped into memory, ideally on a DAX file system backed by persistent memory (or the
+ * memory buffer of an NVMe drive), so that an append is persistent as soon as its cache lines are flushed. On any other
+ * file system the mapping is shared with the page cache and every append is persisted with msync instead, which still
+ * avoids the metadata updates of fsyncing a growing log file.
+ *
+ * The DiskLogConsumerTask appends every buffer it writes to the log file to the ring as well, and invokes the commit
+ * callbacks of the buffer as soon as the append returns. The log file is persisted in the background as before, and the
+ * ring is reset once it is, so the ring only ever holds the tail of the log that the log file may not have persisted
+ * yet. The header of the ring records where in the log file that tail starts. After a crash, Drain writes the tail back
+ * into the log file before the log file is read by recovery.
+ *
+ * Appended bytes are stored as entries that start at a cache line, each headed by the epoch of the ring and a checksum
+ * of its bytes. Resetting the ring increments its epoch, which invalidates all entries of earlier epochs without
+ * clearing them, and an entry torn by a crash fails its checksum. The ring is only used by one thread at a time.
+ */
+class PersistentLogRing {
+ public:
+  /**
+   * Opens the ring at the given path, creating it if it does not exist. The entries of an existing ring are kept, to
+   * be drained into the log file.
+   * @param path file to map the ring from
+   * @param capacity number of bytes the ring can hold, entry headers and padding included
+   */
+  PersistentLogRing(const std::string &path, uint64_t capacity);
+
+  /** Unmaps the ring. The entries are kept. */
+  ~PersistentLogRing();
+
+  DISALLOW_COPY_AND_MOVE(PersistentLogRing);
+
+  /**
+   * Appends the given bytes to the ring, and returns once they are persistent.
+   * @param data bytes to append
+   * @param size number of bytes to append
+   * @return true if the bytes were appended, false if the ring does not have enough space left
+   */
+  bool Append(const char *data, uint32_t size);
+
+  /**
+   * Empties the ring. Must be called once everything appended is persisted in the log file.
+   * @param segment segment of the log file that the bytes appended from now on are written to
+   * @param file_offset offset in the segment that the bytes appended from now on are written at
+   */
+  void Reset(uint64_t segment, uint64_t file_offset);
+
+  /**
+   * Writes the entries that the ring holds into the log file, at the location recorded by the last Reset, and
+   * truncates the log file after them. Whatever the log file holds after that location was never acknowledged from
+   * the ring or by persisting the log file, so it is discarded. Must be called before the log file is opened for
+   * writing or read by recovery.
+   * @param stream_log_file_path log file of the stream the ring belongs to
+   * @return number of bytes written into the log file
+   */
+  uint64_t Drain(const std::string &stream_log_file_path);
+
+  /** @return number of bytes appended since the last reset, entry headers and padding included */
+  uint64_t Used() const { return tail_; }
+
+  /** @return number of bytes the ring can hold, entry headers and padding included */
+  uint64_t Capacity() const { return capacity_; }
+
+  /** @return true if the ring is mapped directly from persistent memory, false if appends are persisted with msync */
+  bool IsPersistentMemory() const { return direct_access_; }
+
+ private:
+  // Persistent header of the ring, in the first cache line of the file. A reset writes epoch_ first and
+  // committed_epoch_ last, so that the location is only valid if the two are equal.
+  struct Header {
+    uint64_t magic_;
+    uint64_t epoch_;
+    uint64_t segment_;
+    uint64_t file_offset_;
+    uint64_t committed_epoch_;
+  };
+
+  // Header of an entry, followed by the bytes appended
+  struct EntryHeader {
+    uint64_t epoch_;
+    uint32_t size_;
+    uint32_t checksum_;
+  };
+
+  static constexpr uint64_t MAGIC = 0x474e49524c415721;  // "!WALRING"
+  // The entries start on their own page, so that msync of the entries never writes back the header
+  static constexpr uint64_t ENTRIES_OFFSET = 4096;
+
+  int fd_;
+  uint64_t capacity_;
+  uint64_t mapping_size_;
+  char *mapping_;
+  bool direct_access_;
+  // End of the last entry appended, relative to the start of the entries
+  uint64_t tail_ = 0;
+
+  Header *GetHeader() { return reinterpret_cast<Header *>(mapping_); }
+
+  char *Entries() { return mapping_ + ENTRIES_OFFSET; }
+
+  static uint32_t Checksum(uint64_t epoch, const char *data, uint32_t size);
+
+  static uint64_t EntrySize(const uint32_t size) {
+    const uint64_t cacheline = common::Constants::CACHELINE_SIZE;
+    return (sizeof(EntryHeader) + size + cacheline - 1) / cacheline * cacheline;
+  }
+
+  // Makes the given range of the mapping persistent
+  void Persist(const char *start, uint64_t size);
+};
+
+}  // namespace noisepage::storage
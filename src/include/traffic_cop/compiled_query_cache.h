@@ -0,0 +1,221 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/macros.h"
+#include "type/type_id.h"
+
+namespace noisepage::execution::compiler {
+class ExecutableQuery;
+}  // namespace noisepage::execution::compiler
+
+namespace noisepage::optimizer {
+class OptimizeResult;
+}  // namespace noisepage::optimizer
+
+namespace noisepage::planner {
+class AbstractPlanNode;
+}  // namespace noisepage::planner
+
+namespace noisepage::trafficcop {
+
+/**
+ * A process-wide cache of compiled queries shared by all connections. Queries are keyed by their database, their
+ * physical plan and the types of their parameters. Two statements with different text but equal plans, e.g., the same
+ * query template sent over different connections, share one ExecutableQuery and only the first pays for code
+ * generation.
+ *
+ * Every entry records the catalog version it was compiled against. The version is bumped whenever a DDL change
+ * commits, which invalidates all entries compiled before it. The cache holds at most a fixed number of queries and
+ * evicts the least recently used one when full. Queries handed out keep their plan alive, so connections can keep
+ * running a query after it was evicted.
+ *
+ * Cached queries are also indexed by the statements they were compiled for, keyed by database, normalized query text
+ * and parameter types. A connection preparing a statement another connection prepared before finds its optimize
+ * result and compiled query there, and skips binding, optimization and code generation altogether.
+ */
+class CompiledQueryCache {
+ public:
+  /** The default number of queries the cache holds. */
+  static constexpr std::size_t DEFAULT_CAPACITY = 1024;
+
+  /**
+   * Create an empty cache.
+   * @param capacity The maximum number of queries the cache holds.
+   */
+  explicit CompiledQueryCache(std::size_t capacity = DEFAULT_CAPACITY) : capacity_(capacity) {}
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(CompiledQueryCache);
+
+  /**
+   * Look up the query compiled for an equal plan.
+   * @param db_oid The database the query runs in.
+   * @param plan The physical plan of the query.
+   * @param param_types The types of the query's parameters.
+   * @return The compiled query if there is a valid one, nullptr otherwise.
+   */
+  std::shared_ptr<execution::compiler::ExecutableQuery> Lookup(catalog::db_oid_t db_oid,
+                                                               const planner::AbstractPlanNode &plan,
+                                                               const std::vector<type::TypeId> &param_types);
+
+  /**
+   * Add a compiled query to the cache. Queries compiled against an outdated catalog version are not cached.
+   * @param db_oid The database the query runs in.
+   * @param optimize_result The optimize result owning the plan the query was compiled from. It is kept alive for as
+   *                        long as the query is.
+   * @param param_types The types of the query's parameters.
+   * @param query_text The text of the query, which the cached query refers to from then on.
+   * @param query The compiled query.
+   * @param catalog_version The catalog version the txn the query was compiled in sees.
+   * @return The query to run. This is the query compiled by another connection if it cached an equal one first.
+   */
+  std::shared_ptr<execution::compiler::ExecutableQuery> Insert(
+      catalog::db_oid_t db_oid, std::shared_ptr<optimizer::OptimizeResult> optimize_result,
+      const std::vector<type::TypeId> &param_types, const std::string &query_text,
+      std::unique_ptr<execution::compiler::ExecutableQuery> query, uint64_t catalog_version);
+
+  /** A statement's cached optimize result and compiled query. */
+  struct CachedStatement {
+    /** The optimize result owning the statement's physical plan. */
+    std::shared_ptr<optimizer::OptimizeResult> optimize_result_;
+    /** The types the binder wants the statement's parameters promoted to. */
+    std::vector<type::TypeId> desired_param_types_;
+    /** The statement's compiled query. */
+    std::shared_ptr<execution::compiler::ExecutableQuery> query_;
+  };
+
+  /**
+   * Look up the query compiled for a statement with equal text.
+   * @param db_oid The database the statement runs in.
+   * @param query_text The text of the statement. Runs of whitespace outside of quotes don't matter.
+   * @param param_types The types of the statement's parameters.
+   * @param catalog_version The catalog version the statement's txn sees. Nothing is found for any other version.
+   * @param[out] statement The statement's cached objects, if there are any.
+   * @return True if the statement was cached, false otherwise.
+   */
+  bool LookupStatement(catalog::db_oid_t db_oid, const std::string &query_text,
+                       const std::vector<type::TypeId> &param_types, uint64_t catalog_version,
+                       CachedStatement *statement);
+
+  /**
+   * Index a cached query by a statement it was compiled for. Nothing happens if the query is no longer cached, e.g.,
+   * because it was compiled against an outdated catalog version.
+   * @param db_oid The database the statement runs in.
+   * @param query_text The text of the statement.
+   * @param param_types The types of the statement's parameters.
+   * @param desired_param_types The types the binder wants the statement's parameters promoted to.
+   * @param plan The physical plan the query was compiled from.
+   */
+  void InsertStatement(catalog::db_oid_t db_oid, const std::string &query_text,
+                       const std::vector<type::TypeId> &param_types, std::vector<type::TypeId> desired_param_types,
+                       const planner::AbstractPlanNode &plan);
+
+  /**
+   * @param query_text The text of a statement.
+   * @return The text with leading and trailing whitespace and semicolons removed, and every other run of whitespace
+   *         outside of quotes replaced by a single space.
+   */
+  static std::string NormalizeQueryText(const std::string &query_text);
+
+  /**
+   * Invalidate all cached queries after a DDL change committed.
+   */
+  void BumpCatalogVersion();
+
+  /**
+   * @return The current catalog version.
+   */
+  uint64_t GetCatalogVersion() const {
+    std::lock_guard guard(mutex_);
+    return catalog_version_;
+  }
+
+  /**
+   * @return The number of cached queries.
+   */
+  std::size_t Size() const {
+    std::lock_guard guard(mutex_);
+    return entries_.size();
+  }
+
+ private:
+  // What a cached query is found by. The key points to a plan owned by either
+  // the cache entry or the caller of Lookup(). Plans can be large, so the key
+  // is hashed once when it's made rather than under the cache's lock.
+  struct Key {
+    Key(catalog::db_oid_t db_oid, const planner::AbstractPlanNode *plan, std::vector<type::TypeId> param_types);
+
+    bool operator==(const Key &other) const;
+
+    catalog::db_oid_t db_oid_;
+    const planner::AbstractPlanNode *plan_;
+    std::vector<type::TypeId> param_types_;
+    std::size_t hash_;
+  };
+
+  struct KeyHasher {
+    std::size_t operator()(const Key &key) const { return key.hash_; }
+  };
+
+  // What a cached statement is found by.
+  struct StatementKey {
+    StatementKey(catalog::db_oid_t db_oid, std::string query_text, std::vector<type::TypeId> param_types);
+
+    bool operator==(const StatementKey &other) const {
+      return hash_ == other.hash_ && db_oid_ == other.db_oid_ && param_types_ == other.param_types_ &&
+             query_text_ == other.query_text_;
+    }
+
+    catalog::db_oid_t db_oid_;
+    std::string query_text_;
+    std::vector<type::TypeId> param_types_;
+    std::size_t hash_;
+  };
+
+  struct StatementKeyHasher {
+    std::size_t operator()(const StatementKey &key) const { return key.hash_; }
+  };
+
+  // A cached query and everything it refers to.
+  struct CachedQuery {
+    std::shared_ptr<optimizer::OptimizeResult> optimize_result_;
+    std::string query_text_;
+    std::unique_ptr<execution::compiler::ExecutableQuery> query_;
+  };
+
+  struct Entry {
+    Key key_;
+    std::shared_ptr<CachedQuery> cached_;
+    // The statements indexing this entry, removed along with it.
+    std::vector<StatementKey> statement_keys_;
+  };
+
+  // The entries, most recently used first.
+  using EntryList = std::list<Entry>;
+
+  struct StatementEntry {
+    EntryList::iterator entry_;
+    std::vector<type::TypeId> desired_param_types_;
+  };
+
+  // Remove the least recently used entry and the statements indexing it.
+  void EvictEntry();
+
+  const std::size_t capacity_;
+  mutable std::mutex mutex_;
+  uint64_t catalog_version_{0};
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, KeyHasher> index_;
+  std::unordered_map<StatementKey, StatementEntry, StatementKeyHasher> statement_index_;
+};
+
+}  // namespace noisepage::trafficcop
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <list>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <unordered_map>
+#include <vector>
+
+#include "catalog/catalog_defs.h"
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+#include "parser/expression/constant_value_expression.h"
+#include "planner/plannodes/output_schema.h"
+#include "transaction/transaction_defs.h"
+
+namespace noisepage::optimizer {
+class OptimizeResult;
+}  // namespace noisepage::optimizer
+
+namespace noisepage::planner {
+class AbstractPlanNode;
+}  // namespace noisepage::planner
+
+namespace noisepage::storage {
+class SqlTable;
+}  // namespace noisepage::storage
+
+namespace noisepage::trafficcop {
+
+/**
+ * A process-wide cache of the results of read-only queries, for clients that run the same queries over and over
+ * against tables that rarely change, like dashboards. Results are keyed by their database, their physical plan and the
+ * values of their parameters. A hit writes the stored output tuples to the client without code generation or
+ * execution.
+ *
+ * A result records the start time of the txn that computed it. It is only handed to a txn that sees the same
+ * committed versions of the tables the plan reads, that is, when no transaction committed a change to any of them after
+ * either txn started, @see storage::DataTable::GetLastCommitTime(). Results that can never be handed out again are
+ * dropped when they are found. DDL changes clear the cache and bump its catalog version, in step with the
+ * CompiledQueryCache, so that the tables of a cached result are never dropped under it.
+ *
+ * The cache holds at most a fixed number of bytes of results, and evicts the least recently used ones when full.
+ */
+class ResultCache {
+ public:
+  /**
+   * The output of a query, as the batches of tuples the execution engine handed to its OutputCallback. The strings the
+   * tuples point to are copied along, so that the tuples can be written out after the query's execution is gone.
+   */
+  class Result {
+   public:
+    /**
+     * Create an empty result.
+     * @param columns The columns of the output schema of the query.
+     * @param max_size The number of bytes after which the result is too large to cache.
+     */
+    Result(const std::vector<planner::OutputSchema::Column> &columns, std::size_t max_size);
+
+    /**
+     * This class cannot be copied or moved.
+     */
+    DISALLOW_COPY_AND_MOVE(Result);
+
+    /**
+     * Append a batch of output tuples. Safe to call from several threads, like the OutputCallback.
+     * @param tuples The batch of tuples.
+     * @param num_tuples The number of tuples in the batch.
+     * @param tuple_size The size of a tuple.
+     */
+    void Append(const byte *tuples, uint32_t num_tuples, uint32_t tuple_size);
+
+    /**
+     * @return True if the result grew past the size it could be cached at, and is no longer collected.
+     */
+    bool IsTooLarge() const { return too_large_; }
+
+    /**
+     * @return The output tuples, one after the other.
+     */
+    const byte *GetTuples() const { return tuples_.data(); }
+
+    /**
+     * @return The number of output tuples.
+     */
+    uint32_t GetNumTuples() const { return num_tuples_; }
+
+    /**
+     * @return The size of an output tuple.
+     */
+    uint32_t GetTupleSize() const { return tuple_size_; }
+
+    /**
+     * @return The number of bytes the result holds.
+     */
+    std::size_t GetSize() const { return size_; }
+
+   private:
+    // The offsets of the strings in the tuples, whose contents are copied.
+    std::vector<uint32_t> varlen_offsets_;
+    const std::size_t max_size_;
+    std::mutex latch_;
+    std::vector<byte> tuples_;
+    std::vector<std::unique_ptr<byte[]>> varlens_;
+    uint32_t num_tuples_ = 0;
+    uint32_t tuple_size_ = 0;
+    std::size_t size_ = 0;
+    bool too_large_ = false;
+  };
+
+  /**
+   * Create an empty cache.
+   * @param capacity The maximum number of bytes of results the cache holds.
+   */
+  explicit ResultCache(std::size_t capacity) : capacity_(capacity) {}
+
+  /**
+   * This class cannot be copied or moved.
+   */
+  DISALLOW_COPY_AND_MOVE(ResultCache);
+
+  /**
+   * @param plan The physical plan of a query.
+   * @param[out] table_oids The tables the query reads.
+   * @return True if the result of the query only depends on the contents of the tables it reads, and can be cached.
+   */
+  static bool IsCacheable(const planner::AbstractPlanNode &plan, std::vector<catalog::table_oid_t> *table_oids);
+
+  /**
+   * Look up the result of a query for a txn.
+   * @param db_oid The database the query runs in.
+   * @param plan The physical plan of the query.
+   * @param params The values of the query's parameters.
+   * @param start_time The start time of the txn that runs the query.
+   * @return The result if there is one the txn can see, nullptr otherwise.
+   */
+  std::shared_ptr<const Result> Lookup(catalog::db_oid_t db_oid, const planner::AbstractPlanNode &plan,
+                                       const std::vector<parser::ConstantValueExpression> &params,
+                                       transaction::timestamp_t start_time);
+
+  /**
+   * Add the result of a query to the cache. Results that are too large or that are already outdated are not cached.
+   * @param db_oid The database the query ran in.
+   * @param optimize_result The optimize result owning the plan of the query. It is kept alive for as long as the
+   *                        result is.
+   * @param params The values of the query's parameters.
+   * @param tables The tables the query read.
+   * @param start_time The start time of the txn that ran the query.
+   * @param result The result of the query.
+   * @param catalog_version The catalog version the txn began with. The result isn't cached if it's out of date.
+   */
+  void Insert(catalog::db_oid_t db_oid, std::shared_ptr<optimizer::OptimizeResult> optimize_result,
+              const std::vector<parser::ConstantValueExpression> &params,
+              std::vector<common::ManagedPointer<storage::SqlTable>> tables, transaction::timestamp_t start_time,
+              std::shared_ptr<const Result> result, uint64_t catalog_version);
+
+  /**
+   * Drop all cached results once a DDL change committed, and refuse results computed against the old catalog.
+   */
+  void BumpCatalogVersion();
+
+  /**
+   * @return The maximum number of bytes of results the cache holds.
+   */
+  std::size_t GetCapacity() const { return capacity_; }
+
+  /**
+   * @return The number of cached results.
+   */
+  std::size_t Size() const {
+    std::lock_guard guard(mutex_);
+    return entries_.size();
+  }
+
+  /**
+   * @return The number of lookups that found a result.
+   */
+  uint64_t GetNumHits() const {
+    std::lock_guard guard(mutex_);
+    return num_hits_;
+  }
+
+ private:
+  // What a cached result is found by. The key points to a plan owned by either the cache entry or the caller of
+  // Lookup(), and is hashed once when it's made rather than under the cache's lock.
+  struct Key {
+    Key(catalog::db_oid_t db_oid, const planner::AbstractPlanNode *plan,
+        std::vector<parser::ConstantValueExpression> params);
+
+    bool operator==(const Key &other) const;
+
+    catalog::db_oid_t db_oid_;
+    const planner::AbstractPlanNode *plan_;
+    std::vector<parser::ConstantValueExpression> params_;
+    std::size_t hash_;
+  };
+
+  struct KeyHasher {
+    std::size_t operator()(const Key &key) const { return key.hash_; }
+  };
+
+  struct Entry {
+    Key key_;
+    std::shared_ptr<optimizer::OptimizeResult> optimize_result_;
+    std::vector<common::ManagedPointer<storage::SqlTable>> tables_;
+    transaction::timestamp_t start_time_;
+    std::shared_ptr<const Result> result_;
+  };
+
+  // The entries, most recently used first.
+  using EntryList = std::list<Entry>;
+
+  // Whether no transaction committed a change to any of the tables after the given time.
+  static bool IsUnchangedSince(const std::vector<common::ManagedPointer<storage::SqlTable>> &tables,
+                               transaction::timestamp_t time);
+
+  void EraseEntry(EntryList::iterator entry);
+
+  const std::size_t capacity_;
+  mutable std::mutex mutex_;
+  uint64_t catalog_version_{0};
+  std::size_t size_{0};
+  uint64_t num_hits_{0};
+  EntryList entries_;
+  std::unordered_map<Key, EntryList::iterator, KeyHasher> index_;
+};
+
+}  // namespace noisepage::trafficcop
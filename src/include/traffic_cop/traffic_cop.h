@@ -1,34 +1,64 @@
 #pragma once
 #include <memory>
+#include <mutex>  // NOLINT
+#include <optional>
+#include <random>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <utility>
 #include <variant>
 #include <vector>
 
+#include "catalog/catalog_cache.h"
 #include "catalog/catalog_defs.h"
 #include "common/managed_pointer.h"
 #include "execution/vm/vm_defs.h"
 #include "network/network_defs.h"
+#include "optimizer/cost_model/learned_cost_model.h"
+#include "self_driving/modeling/ou_model.h"
+#include "traffic_cop/compiled_query_cache.h"
+#include "traffic_cop/result_cache.h"
 #include "traffic_cop/traffic_cop_defs.h"
+#include "transaction/transaction_defs.h"
 
 namespace noisepage::catalog {
 class Catalog;
 }  // namespace noisepage::catalog
 
+namespace noisepage::execution::compiler {
+class ExecutableQuery;
+}  // namespace noisepage::execution::compiler
+
+namespace noisepage::execution::exec {
+class ExecutionContext;
+}  // namespace noisepage::execution::exec
+
 namespace noisepage::network {
 class ConnectionContext;
+class CopyInReader;
 class PostgresPacketWriter;
 class Statement;
 class Portal;
 }  // namespace noisepage::network
 
 namespace noisepage::optimizer {
+class CardinalityFeedback;
 class StatsStorage;
 class OptimizeResult;
 }  // namespace noisepage::optimizer
 
+namespace noisepage::metrics {
+class MetricsRowWriter;
+}  // namespace noisepage::metrics
+
+namespace noisepage::modelserver {
+class ModelServerManager;
+}  // namespace noisepage::modelserver
+
 namespace noisepage::parser {
 class ConstantValueExpression;
+class CopyStatement;
 class CreateStatement;
 class DropStatement;
 class TransactionStatement;
@@ -79,6 +109,8 @@ class TrafficCop {
    * @param optimizer_timeout for optimizer calls
    * @param use_query_cache whether to cache physical plans and generated code for Extended Query protocol
    * @param execution_mode how to run executable queries after code generation
+   * @param result_cache_size bytes of results of read-only queries to cache, 0 to not cache results
+   * @param default_isolation_level isolation level of client transactions that do not ask for one
    */
   TrafficCop(common::ManagedPointer<transaction::TransactionManager> txn_manager,
              common::ManagedPointer<catalog::Catalog> catalog,
@@ -86,7 +118,8 @@ class TrafficCop {
              common::ManagedPointer<storage::RecoveryManager> recovery_manager,
              common::ManagedPointer<settings::SettingsManager> settings_manager,
              common::ManagedPointer<optimizer::StatsStorage> stats_storage, uint64_t optimizer_timeout,
-             bool use_query_cache, const execution::vm::ExecutionMode execution_mode)
+             bool use_query_cache, const execution::vm::ExecutionMode execution_mode, uint64_t result_cache_size = 0,
+             const transaction::IsolationLevel default_isolation_level = transaction::IsolationLevel::SNAPSHOT)
       : txn_manager_(txn_manager),
         catalog_(catalog),
         replication_manager_(replication_manager),
@@ -95,7 +128,14 @@ class TrafficCop {
         stats_storage_(stats_storage),
         optimizer_timeout_(optimizer_timeout),
         use_query_cache_(use_query_cache),
-        execution_mode_(execution_mode) {}
+        execution_mode_(execution_mode),
+        default_isolation_level_(default_isolation_level),
+        catalog_cache_(std::make_unique<catalog::CatalogCache>()),
+        compiled_query_cache_(std::make_unique<CompiledQueryCache>()),
+        result_cache_(result_cache_size > 0 ? std::make_unique<ResultCache>(result_cache_size) : nullptr),
+        ou_prediction_cache_(std::make_unique<optimizer::OUPredictionCache>()),
+        ou_model_loader_(std::make_unique<selfdriving::OUModelMapLoader>()),
+        cancel_key_generator_(std::random_device{}()) {}
 
   virtual ~TrafficCop() = default;
 
@@ -105,6 +145,12 @@ class TrafficCop {
    */
   void HandBufferToReplication(std::unique_ptr<network::ReadBuffer> buffer);
 
+  /**
+   * @param database_name the name of a database
+   * @return the OID of the database, or INVALID_DATABASE_OID if there is no such database
+   */
+  catalog::db_oid_t GetDatabaseOid(const std::string &database_name) const;
+
   /**
    * Create a temporary namespace for a connection
    * @param connection_id the unique connection ID to use for the namespace name
@@ -112,7 +158,47 @@ class TrafficCop {
    * @return a pair of OIDs for the database and the temporary namespace
    */
   std::pair<catalog::db_oid_t, catalog::namespace_oid_t> CreateTempNamespace(network::connection_id_t connection_id,
-                                                                             const std::string &database_name);
+                                                                             const std::string &database_name) const;
+
+  /**
+   * Make the queries of a connection cancelable, by a CancelRequest that carries the connection's ID and a secret key.
+   * @param connection_ctx context of the connection
+   * @return the secret key
+   */
+  int32_t RegisterConnection(common::ManagedPointer<network::ConnectionContext> connection_ctx) const;
+
+  /**
+   * Forget a connection that is closing, so that its ID can be given to another one.
+   * @param connection_ctx context of the connection
+   */
+  void UnregisterConnection(common::ManagedPointer<network::ConnectionContext> connection_ctx) const;
+
+  /**
+   * Cancel the query that a connection is executing. Like in Postgres, nothing happens if the connection isn't
+   * executing a query, doesn't exist or has another key, and the client isn't told either way.
+   * @param connection_id ID of the connection
+   * @param cancel_key the secret key of the connection
+   */
+  void CancelQuery(network::connection_id_t connection_id, int32_t cancel_key) const;
+
+  /** Columns of the rows that WriteMemoryUsage() writes. */
+  static constexpr std::string_view MEMORY_USAGE_COLUMNS = "category, name, bytes";
+
+  /**
+   * Writes what holds memory, as a row per item: every component the MemoryAccountant counts (category "component"),
+   * every table and index of every database (categories "table" and "index", named "<database oid>.<oid>"), and the
+   * query every connection runs (category "query", named "<connection id>.<query id>").
+   * @param writer writer for the rows
+   */
+  void WriteMemoryUsage(metrics::MetricsRowWriter *writer) const;
+
+  /**
+   * Makes sure that the connection has a temporary namespace. Connections don't get one until they create an object in
+   * it, so that connecting doesn't change the catalog.
+   * @param connection_ctx context of the connection, which must be in a txn
+   * @return false if the temporary namespace couldn't be created
+   */
+  bool UseTempNamespace(common::ManagedPointer<network::ConnectionContext> connection_ctx) const;
 
   /**
    * Drop the temporary namespace for a connection and all enclosing database objects
@@ -134,27 +220,52 @@ class TrafficCop {
    * @param connection_ctx context containg txn and catalog accessor to be used
    * @param query bound ParseResult
    * @param parameters parameters for the query, can be nullptr if there are no parameters
+   * @param cardinality_feedback numbers of rows observed for relations of the query when it ran before, nullptr if
+   * none were
    * @return optimize result containing physical plan that can be executed and the plan meta data
    */
   std::unique_ptr<optimizer::OptimizeResult> OptimizeBoundQuery(
       common::ManagedPointer<network::ConnectionContext> connection_ctx,
       common::ManagedPointer<parser::ParseResult> query,
-      common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters) const;
+      common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters,
+      common::ManagedPointer<const optimizer::CardinalityFeedback> cardinality_feedback = nullptr) const;
+
+  /**
+   * @param connection_ctx context containg txn and catalog accessor to be used
+   * @param statement bound statement
+   * @param parameters values of the parameters of the statement
+   * @return the selectivity buckets of the comparisons with parameters, see TrafficCopUtil::ParameterSelectivityBuckets
+   */
+  std::vector<uint8_t> ParameterSelectivityBuckets(
+      common::ManagedPointer<network::ConnectionContext> connection_ctx,
+      common::ManagedPointer<network::Statement> statement,
+      common::ManagedPointer<const std::vector<parser::ConstantValueExpression>> parameters) const;
 
   /**
    * Calls to txn manager to begin txn, and updates ConnectionContext state
    * @param connection_ctx context to own this txn
+   * @param read_only whether the txn is begun by a BEGIN READ ONLY
+   * @param isolation_level isolation level asked for by a BEGIN ISOLATION LEVEL, or std::nullopt for the default
    */
-  void BeginTransaction(common::ManagedPointer<network::ConnectionContext> connection_ctx) const;
+  void BeginTransaction(common::ManagedPointer<network::ConnectionContext> connection_ctx, bool read_only = false,
+                        std::optional<transaction::IsolationLevel> isolation_level = std::nullopt) const;
 
   /**
    * Calls to txn manager to end txn, and updates ConnectionContext state
    * @param connection_ctx context to release its txn
    * @param query_type if the txn is being ended with COMMIT or ROLLBACK
+   * @return false if a serializable txn failed to COMMIT and was rolled back instead, true otherwise
    */
-  void EndTransaction(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+  bool EndTransaction(common::ManagedPointer<network::ConnectionContext> connection_ctx,
                       network::QueryType query_type) const;
 
+  /** @return the error reported to a client whose serializable txn failed to commit */
+  static common::ErrorData SerializationFailure() {
+    return {common::ErrorSeverity::ERROR,
+            "could not serialize access due to read/write dependencies among transactions",
+            common::ErrorCode::ERRCODE_T_R_SERIALIZATION_FAILURE};
+  }
+
   /**
    * Contains the logic to reason about BEGIN, COMMIT, ROLLBACK execution. Responsible for outputting results, since we
    * need to be able to do more than return a single TrafficCopResult (i.e. we may need a NOTICE and a COMPLETE)
@@ -168,7 +279,9 @@ class TrafficCop {
                                    noisepage::network::QueryType query_type) const;
 
   /**
-   * Contains logic to reason about binding, and basic IF EXISTS logic.
+   * Contains logic to reason about binding, and basic IF EXISTS logic. A statement that isn't cached by its connection
+   * picks up the optimize result and compiled query of an equal statement any connection prepared before, in which
+   * case it's not bound and doesn't need to be optimized.
    * @param connection_ctx context to be used to access the internal txn
    * @param statement parse result to be bound
    * @param parameters parameters for the query being bound, can be nullptr if there are no parameters
@@ -178,6 +291,16 @@ class TrafficCop {
                              common::ManagedPointer<network::Statement> statement,
                              common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters) const;
 
+  /**
+   * Prepares a COPY ... FROM STDIN to insert the data the client is about to send into its table.
+   * @param connection_ctx context of the connection, whose txn the rows are inserted in
+   * @param copy_stmt the COPY
+   * @return the reader that inserts the data, or an error if the table doesn't exist
+   */
+  std::variant<std::unique_ptr<network::CopyInReader>, common::ErrorData> BeginCopyIn(
+      common::ManagedPointer<network::ConnectionContext> connection_ctx,
+      common::ManagedPointer<parser::CopyStatement> copy_stmt) const;
+
   /**
    * Contains the logic to handle SET statements.
    * @param connection_ctx The context to be used to access the internal txn.
@@ -189,6 +312,9 @@ class TrafficCop {
 
   /**
    * Contains the logic to handle SHOW statements. Currently a hack to only support SHOW TRANSACTION ISOLATION LEVEL
+   * SHOW LATENCY_HISTOGRAMS, listing the latency histograms of the metrics dumped so far, and SHOW PIPELINE_SAMPLES,
+   * listing the samples of the SamplingProfiler per query and pipeline, and SHOW MEMORY_USAGE, listing what
+   * WriteMemoryUsage() writes
    * @param connection_ctx The context to be used to access the internal txn.
    * @param statement The show statement to be executed.
    * @param out Packet writer for writing results.
@@ -209,6 +335,29 @@ class TrafficCop {
                                           common::ManagedPointer<planner::AbstractPlanNode> physical_plan,
                                           noisepage::network::QueryType query_type) const;
 
+  /**
+   * Create a materialized view: a table with the columns of the output of the view's query, filled with that output
+   * unless it was created WITH NO DATA. The text of the query is stored as the definition of the view for REFRESH.
+   * @param connection_ctx context to be used to access the internal txn
+   * @param out packet writer to return results
+   * @param portal the CREATE MATERIALIZED VIEW statement, whose plan is the plan of the view's query
+   * @return result of the operation, with the number of rows the view was filled with
+   */
+  TrafficCopResult ExecuteCreateMaterializedViewStatement(
+      common::ManagedPointer<network::ConnectionContext> connection_ctx,
+      common::ManagedPointer<network::PostgresPacketWriter> out, common::ManagedPointer<network::Portal> portal) const;
+
+  /**
+   * Refresh a materialized view by emptying it and running its query again, in the connection's txn.
+   * @param connection_ctx context to be used to access the internal txn
+   * @param out packet writer to return results
+   * @param statement the REFRESH MATERIALIZED VIEW statement
+   * @return result of the operation
+   */
+  TrafficCopResult ExecuteRefreshStatement(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                                           common::ManagedPointer<network::PostgresPacketWriter> out,
+                                           common::ManagedPointer<network::Statement> statement) const;
+
   /**
    * Contains the logic to reason about DROP execution.
    * @param connection_ctx context to be used to access the internal txn
@@ -237,11 +386,41 @@ class TrafficCop {
    * @param connection_ctx context to be used to access the internal txn
    * @param out packet writer to return results
    * @param portal to be executed, may contain parameters
+   * @param suspend true if the output of a SELECT is held in the portal, which is suspended, rather than written out
    * @return result of the operation
    */
   TrafficCopResult RunExecutableQuery(common::ManagedPointer<network::ConnectionContext> connection_ctx,
                                       common::ManagedPointer<network::PostgresPacketWriter> out,
-                                      common::ManagedPointer<network::Portal> portal) const;
+                                      common::ManagedPointer<network::Portal> portal, bool suspend = false) const;
+
+  /**
+   * Serve a SELECT from the result cache, skipping code generation and execution, if the connection's txn can see a
+   * cached result of it.
+   * @param connection_ctx context to be used to access the internal txn
+   * @param out packet writer to return results
+   * @param portal to be executed, may contain parameters
+   * @param[out] result result of the operation, if there was a cached result
+   * @param suspend true if the cached result is held in the portal, which is suspended, rather than written out
+   * @return true if the result was served from the cache
+   */
+  bool SendCachedResult(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                        common::ManagedPointer<network::PostgresPacketWriter> out,
+                        common::ManagedPointer<network::Portal> portal, TrafficCopResult *result,
+                        bool suspend = false) const;
+
+  /**
+   * Contains the logic to handle EXPLAIN statements of DML. Writes the plan of the explained statement as one text row
+   * per plan node. For EXPLAIN ANALYZE, the statement is compiled with profiling enabled and run with its output
+   * discarded, and every plan node is annotated with the rows it produced and the pipelines it ran in, followed by
+   * the time and memory of every pipeline.
+   * @param connection_ctx context to be used to access the internal txn
+   * @param out packet writer to return results
+   * @param portal the explain statement, bound and optimized, may contain parameters
+   * @return result of the operation
+   */
+  TrafficCopResult ExecuteExplainStatement(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                                           common::ManagedPointer<network::PostgresPacketWriter> out,
+                                           common::ManagedPointer<network::Portal> portal) const;
 
   /**
    * Adjust the TrafficCop's optimizer timeout value (for use by SettingsManager)
@@ -249,12 +428,68 @@ class TrafficCop {
    */
   void SetOptimizerTimeout(const uint64_t optimizer_timeout) { optimizer_timeout_ = optimizer_timeout; }
 
+  /**
+   * Lets the optimizer cost plans with the operating unit models, if the learned_cost_model setting says so. The model
+   * server is started after the TrafficCop, which is why it is not a constructor argument.
+   * @param model_server_manager the model server
+   * @param model_save_path path to the trained operating unit models
+   */
+  void SetModelServerManager(common::ManagedPointer<modelserver::ModelServerManager> model_server_manager,
+                             std::string model_save_path) {
+    model_server_manager_ = model_server_manager;
+    model_save_path_ = std::move(model_save_path);
+  }
+
   /**
    * @return true if query caching enabled, false otherwise
    */
   bool UseQueryCache() const { return use_query_cache_; }
 
+  /**
+   * @return the cache of compiled queries shared by all connections
+   */
+  common::ManagedPointer<CompiledQueryCache> GetCompiledQueryCache() const {
+    return common::ManagedPointer(compiled_query_cache_);
+  }
+
+  /**
+   * @return the cache of query results shared by all connections, nullptr if results aren't cached
+   */
+  common::ManagedPointer<ResultCache> GetResultCache() const { return common::ManagedPointer(result_cache_); }
+
  private:
+  // Share the cached objects of an equal statement compiled before, if there is one. Returns true if there was.
+  bool ShareCachedStatement(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                            common::ManagedPointer<network::Statement> statement,
+                            common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters) const;
+
+  // The tables a query reads if its result may be cached for the connection's txn. Returns false if it may not be.
+  bool GetResultCacheTables(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                            common::ManagedPointer<network::Portal> portal,
+                            std::vector<common::ManagedPointer<storage::SqlTable>> *tables) const;
+
+  // Parse, bind, optimize and run a DML statement the TrafficCop issues itself in the connection's txn. Nothing is
+  // written to the client.
+  TrafficCopResult RunInternalQuery(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                                    common::ManagedPointer<network::PostgresPacketWriter> out, std::string query) const;
+
+  // Invalidate the compiled query cache once the connection's transaction commits a DDL change.
+  void InvalidateCompiledQueriesOnCommit(common::ManagedPointer<network::ConnectionContext> connection_ctx) const;
+
+  // Run a compiled query for the connection. A CancelRequest for the connection cancels it while it runs.
+  void RunQuery(common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                execution::compiler::ExecutableQuery *query,
+                common::ManagedPointer<execution::exec::ExecutionContext> exec_ctx) const;
+
+  // Set the query that a registered connection is executing, nullptr once it's done
+  void SetRunningQuery(network::connection_id_t connection_id, execution::exec::ExecutionContext *exec_ctx) const;
+
+  // A connection whose queries can be canceled, and the query it is executing
+  struct CancelableConnection {
+    int32_t cancel_key_;
+    execution::exec::ExecutionContext *running_query_;
+  };
+
   common::ManagedPointer<transaction::TransactionManager> txn_manager_;
   common::ManagedPointer<catalog::Catalog> catalog_;
   common::ManagedPointer<replication::ReplicationManager> replication_manager_;
@@ -264,6 +499,19 @@ class TrafficCop {
   uint64_t optimizer_timeout_;
   const bool use_query_cache_;
   const execution::vm::ExecutionMode execution_mode_;
+  const transaction::IsolationLevel default_isolation_level_;
+  std::unique_ptr<catalog::CatalogCache> catalog_cache_;
+  std::unique_ptr<CompiledQueryCache> compiled_query_cache_;
+  std::unique_ptr<ResultCache> result_cache_;
+  common::ManagedPointer<modelserver::ModelServerManager> model_server_manager_ = nullptr;
+  std::string model_save_path_;
+  std::unique_ptr<optimizer::OUPredictionCache> ou_prediction_cache_;
+  std::unique_ptr<selfdriving::OUModelMapLoader> ou_model_loader_;
+
+  // Cancel requests come in on connections of their own, so the connections are looked up here by their ID
+  mutable std::mutex connections_latch_;
+  mutable std::unordered_map<network::connection_id_t, CancelableConnection> connections_;
+  mutable std::mt19937 cancel_key_generator_;
 };
 
 }  // namespace noisepage::trafficcop
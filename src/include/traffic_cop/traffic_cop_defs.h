@@ -13,6 +13,13 @@ namespace noisepage::trafficcop {
  */
 static constexpr std::string_view TEMP_NAMESPACE_PREFIX = "pg_temp_";
 
+/** Backoff (ms) between attempts to create a temporary namespace, which conflicts with concurrent DDL changes */
+constexpr uint32_t INITIAL_BACKOFF_TIME = 2;
+/** Factor that the backoff grows by after each attempt */
+constexpr uint32_t BACKOFF_FACTOR = 2;
+/** Backoff (ms) after which the creation of a temporary namespace is given up */
+constexpr uint32_t MAX_BACKOFF_TIME = 20;
+
 enum class ResultType : uint8_t { COMPLETE, ERROR, NOTICE, NOOP, QUEUING, UNKNOWN };
 
 /**
@@ -6,6 +6,7 @@
 
 #include "catalog/catalog_defs.h"
 #include "common/managed_pointer.h"
+#include "execution/vm/vm_defs.h"
 #include "network/network_defs.h"
 #include "optimizer/optimize_result.h"
 
@@ -14,10 +15,12 @@ class CatalogAccessor;
 }
 
 namespace noisepage::parser {
+class AbstractExpression;
 class ConstantValueExpression;
 class ParseResult;
 class SQLStatement;
 class SelectStatement;
+class TableRef;
 }  // namespace noisepage::parser
 
 namespace noisepage::planner {
@@ -25,6 +28,7 @@ class AbstractPlanNode;
 }
 
 namespace noisepage::optimizer {
+class CardinalityFeedback;
 class StatsStorage;
 class AbstractCostModel;
 class PropertySet;
@@ -52,6 +56,8 @@ class TrafficCopUtil {
    * @param cost_model used by optimizer
    * @param optimizer_timeout used by optimizer
    * @param parameters parameters for the query, can be nullptr if there are no parameters
+   * @param optimizer_num_threads number of threads used by optimizer
+   * @param cardinality_feedback numbers of rows observed for relations of the query, nullptr if none were
    * @return physical plan that can be executed
    */
   static std::unique_ptr<optimizer::OptimizeResult> Optimize(
@@ -59,7 +65,9 @@ class TrafficCopUtil {
       common::ManagedPointer<catalog::CatalogAccessor> accessor, common::ManagedPointer<parser::ParseResult> query,
       catalog::db_oid_t db_oid, common::ManagedPointer<optimizer::StatsStorage> stats_storage,
       std::unique_ptr<optimizer::AbstractCostModel> cost_model, uint64_t optimizer_timeout,
-      common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters);
+      common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters,
+      uint32_t optimizer_num_threads = 1,
+      common::ManagedPointer<const optimizer::CardinalityFeedback> cardinality_feedback = nullptr);
 
   /**
    * Converts parser statement types (which rely on multiple enums) to a single QueryType enum from the network layer
@@ -68,9 +76,86 @@ class TrafficCopUtil {
    */
   static network::QueryType QueryTypeForStatement(common::ManagedPointer<parser::SQLStatement> statement);
 
+  /**
+   * @param statement statement to check
+   * @return true if the statement is a COPY ... TO STDOUT, which streams the result of a query to the client
+   */
+  static bool IsCopyToStdout(common::ManagedPointer<parser::SQLStatement> statement);
+
+  /**
+   * @param statement statement to check
+   * @return true if the statement is a COPY ... FROM STDIN, which inserts data the client streams into a table
+   */
+  static bool IsCopyFromStdin(common::ManagedPointer<parser::SQLStatement> statement);
+
+  /**
+   * @param statement statement to check
+   * @return true if the statement is a CREATE MATERIALIZED VIEW
+   */
+  static bool IsCreateMaterializedView(common::ManagedPointer<parser::SQLStatement> statement);
+
+  /**
+   * The text of the query of a materialized view, which is stored as its definition and run again on every REFRESH.
+   * It is the text after the top-level AS of the CREATE statement, without a trailing WITH [NO] DATA.
+   * @param create_text text of the CREATE MATERIALIZED VIEW statement
+   * @return text of the query of the view
+   */
+  static std::string MaterializedViewQueryText(const std::string &create_text);
+
+  /**
+   * @param statement statement to check
+   * @return true if the statement creates a table, index or view in the temporary namespace of the connection
+   */
+  static bool CreatesTempObject(common::ManagedPointer<parser::SQLStatement> statement);
+
+  /**
+   * Queries whose plan nodes are all estimated to produce at most this many tuples are compiled with the
+   * fast-compile optimization pipeline.
+   */
+  static constexpr int FAST_COMPILE_MAX_CARDINALITY = 1000;
+
+  /**
+   * Queries with a plan node estimated to produce at least this many tuples are compiled with the max-performance
+   * optimization pipeline.
+   */
+  static constexpr int MAX_PERFORMANCE_MIN_CARDINALITY = 1000000;
+
+  /**
+   * Pick the optimization pipeline to compile a query with from the largest output cardinality the optimizer
+   * estimated for any of its plan nodes. Point queries are dominated by compilation time, analytical queries by
+   * execution time. Queries without estimates get the balanced pipeline.
+   * @param optimize_result the optimized query
+   * @return the optimization profile to compile the query with
+   */
+  static execution::vm::OptimizationProfile ChooseOptimizationProfile(
+      common::ManagedPointer<optimizer::OptimizeResult> optimize_result);
+
+  /** Number of buckets that the selectivity of a comparison with a parameter falls into, one per order of magnitude. */
+  static constexpr uint8_t NUM_SELECTIVITY_BUCKETS = 5;
+
+  /**
+   * Bucket the selectivities that the values of the parameters give the comparisons of columns with them, as estimated
+   * from the statistics of the columns. A statement whose parameters fall into the same buckets is expected to be
+   * served well by the same plan, while one whose buckets differ may be worth a plan of its own.
+   * @param accessor used to read the statistics
+   * @param stats_storage holds the statistics
+   * @param db_oid database oid
+   * @param statement bound statement whose WHERE and join conditions are searched for comparisons
+   * @param parameters values of the parameters
+   * @return the bucket of every comparison of a column with a parameter, in the order they are found
+   */
+  static std::vector<uint8_t> ParameterSelectivityBuckets(
+      common::ManagedPointer<catalog::CatalogAccessor> accessor,
+      common::ManagedPointer<optimizer::StatsStorage> stats_storage, catalog::db_oid_t db_oid,
+      common::ManagedPointer<parser::SQLStatement> statement,
+      common::ManagedPointer<const std::vector<parser::ConstantValueExpression>> parameters);
+
  private:
   static void CollectSelectProperties(common::ManagedPointer<parser::SelectStatement> sel_stmt,
                                       optimizer::PropertySet *property_set);
+
+  static void CollectJoinConditions(common::ManagedPointer<parser::TableRef> table_ref,
+                                    std::vector<common::ManagedPointer<parser::AbstractExpression>> *conditions);
 };
 
 }  // namespace noisepage::trafficcop
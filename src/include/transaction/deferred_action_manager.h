@@ -1,8 +1,15 @@
 #pragma once
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
 #include <queue>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
+#include "common/constants.h"
+
 #include "storage/garbage_collector.h"
 #include "storage/write_ahead_log/log_manager.h"
 #include "transaction/timestamp_manager.h"
@@ -11,21 +18,32 @@
 namespace noisepage::transaction {
 
 /**
- * The deferred action manager tracks deferred actions and provides a function to process them
+ * The deferred action manager tracks deferred actions and provides a function to process them.
+ *
+ * Deferred actions are reclaimed in epochs. Every call to Process closes the current epoch and reads the current time
+ * as the epoch's end time. An action registered during the epoch was registered before this time, so it is safe to
+ * execute it once the oldest running transaction is at least as new as the epoch's end time. This way registering an
+ * action never needs to read the heavily contended transaction clock. Actions are appended to one of several shards,
+ * picked per thread, which each group them into epoch buckets, so that concurrent registrations do not contend on a
+ * single latched queue either.
+ *
+ * Actions are executed in epoch order. Within an epoch, actions registered by the same thread execute in the order
+ * they were registered.
  */
 class DeferredActionManager {
  public:
   /**
    * Constructs a new DeferredActionManager
    * @param timestamp_manager source of timestamps in the system
+   * @param num_shards number of shards that registrations are spread across, one per hardware thread if 0
    */
-  explicit DeferredActionManager(const common::ManagedPointer<TimestampManager> timestamp_manager)
-      : timestamp_manager_(timestamp_manager) {}
+  explicit DeferredActionManager(const common::ManagedPointer<TimestampManager> timestamp_manager,
+                                 const uint32_t num_shards = 0)
+      : timestamp_manager_(timestamp_manager),
+        shards_(num_shards != 0 ? num_shards : std::max(1U, std::thread::hardware_concurrency())) {}
 
   ~DeferredActionManager() {
-    common::SpinLatch::ScopedSpinLatch guard(&deferred_actions_latch_);
-    NOISEPAGE_ASSERT(back_log_.empty(), "Backlog is not empty");
-    NOISEPAGE_ASSERT(new_deferred_actions_.empty(), "Some deferred actions remaining at time of destruction");
+    NOISEPAGE_ASSERT(NumPendingActions() == 0, "Some deferred actions remaining at time of destruction");
   }
 
   /**
@@ -34,14 +52,13 @@ class DeferredActionManager {
    * transaction) is more recent than the time this function was called.
    * @param a functional implementation of the action that is deferred. @see DeferredAction
    */
-  timestamp_t RegisterDeferredAction(const DeferredAction &a) {
-    common::SpinLatch::ScopedSpinLatch guard(&deferred_actions_latch_);
-    // Timestamp needs to be fetched inside the critical section such that actions in the
-    // deferred action queue is in order. This simplifies the interleavings we need to deal
-    // with in the face of DDL changes.
-    timestamp_t result = timestamp_manager_->CurrentTime();
-    new_deferred_actions_.emplace(result, a);
-    return result;
+  void RegisterDeferredAction(const DeferredAction &a) {
+    EpochShard &shard = shards_[ShardIndex()];
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    // The epoch needs to be read inside the critical section such that the buckets of a shard are in epoch order
+    const uint64_t epoch = current_epoch_.load();
+    if (shard.buckets_.empty() || shard.buckets_.back().epoch_ != epoch) shard.buckets_.push_back({epoch, {}});
+    shard.buckets_.back().actions_.push_back(a);
   }
 
   /**
@@ -50,27 +67,58 @@ class DeferredActionManager {
    * transaction) is more recent than the time this function was called.
    * @param a functional implementation of the action that is deferred
    */
-  timestamp_t RegisterDeferredAction(const std::function<void()> &a) {
+  void RegisterDeferredAction(const std::function<void()> &a) {
     // TODO(Tianyu): Will this be a performance problem? Hopefully C++ is smart enough
     // to optimize out this call...
-    return RegisterDeferredAction([=](timestamp_t /*unused*/) { a(); });
+    RegisterDeferredAction([=](timestamp_t /*unused*/) { a(); });
+  }
+
+  /**
+   * Close the current epoch without applying any action. Actions registered from now on are applied after every action
+   * registered so far, whichever thread registered it. Only call from the thread that calls Process.
+   */
+  void CloseEpoch() {
+    // Registrations observing the old epoch happen before the end time is read below
+    const uint64_t closed_epoch = current_epoch_.fetch_add(1);
+    epoch_end_times_.emplace(closed_epoch, timestamp_manager_->CurrentTime());
   }
 
   /**
-   * Clear the queue and apply as many actions as possible
+   * Close the current epoch and apply the actions of all epochs that no running transaction can observe anymore.
+   * Actions registered while processing are never applied in the same invocation.
+   * @param oldest_txn timestamp that is older than any transaction alive
    * @return numbers of deferred actions processed
    */
   uint32_t Process(transaction::timestamp_t oldest_txn) {
-    // Check out a timestamp from the transaction manager to determine the progress of
-    // running transactions in the system.
-    const auto backlog_size = static_cast<uint32_t>(back_log_.size());
-    uint32_t processed = ClearBacklog(oldest_txn);
-    // There is no point in draining new actions if we haven't cleared the backlog.
-    // This leaves some mechanisms for the rest of the system to detect congestion
-    // at the deferred action manager and potentially backoff
-    if (backlog_size != processed) return processed;
-    // Otherwise, ingest all the new actions
-    processed += ProcessNewActions(oldest_txn);
+    CloseEpoch();
+    // The end time was read after oldest_txn, so refresh it to not hold back the epoch just closed for no reason
+    oldest_txn = std::max(oldest_txn, timestamp_manager_->OldestTransactionStartTime());
+
+    // TODO(Tianyu): This will not work if somehow the timestamps we compare against has sign bit flipped.
+    //  (for uncommiitted transactions, or on overflow)
+    // Although that should never happen, we need to be aware that this might be a problem in the future.
+    while (!epoch_end_times_.empty() && oldest_txn >= epoch_end_times_.front().second) {
+      retired_epochs_end_ = epoch_end_times_.front().first + 1;
+      epoch_end_times_.pop();
+    }
+
+    // Take the retired buckets out of the shards, so the rest of the system can continue while we process actions
+    std::vector<EpochBucket> retired;
+    for (auto &shard : shards_) {
+      common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+      while (!shard.buckets_.empty() && shard.buckets_.front().epoch_ < retired_epochs_end_) {
+        retired.emplace_back(std::move(shard.buckets_.front()));
+        shard.buckets_.pop_front();
+      }
+    }
+    std::stable_sort(retired.begin(), retired.end(),
+                     [](const EpochBucket &a, const EpochBucket &b) { return a.epoch_ < b.epoch_; });
+
+    uint32_t processed = 0;
+    for (auto &bucket : retired) {
+      for (auto &action : bucket.actions_) action(oldest_txn);
+      processed += static_cast<uint32_t>(bucket.actions_.size());
+    }
     return processed;
   }
 
@@ -83,7 +131,6 @@ class DeferredActionManager {
    */
   void FullyPerformGC(const common::ManagedPointer<storage::GarbageCollector> gc,
                       const common::ManagedPointer<storage::LogManager> log_manager) {
-    size_t pending_actions;
     do {
       // TODO(Ling): Once unlinking and deleting transaction contexts are integrated into DAF, this inner loop can be
       // removed We need it at the moment because an action may generate a transaction (e.g., deleting a database during
@@ -93,58 +140,45 @@ class DeferredActionManager {
         if (log_manager != DISABLED) log_manager->ForceFlush();
         gc->PerformGarbageCollection();
       }
-
-      {
-        common::SpinLatch::ScopedSpinLatch guard(&deferred_actions_latch_);
-        pending_actions = new_deferred_actions_.size() + back_log_.size();
-      }
-    } while (pending_actions > 0);
+    } while (NumPendingActions() > 0);
   }
 
- private:
-  const common::ManagedPointer<TimestampManager> timestamp_manager_;
-  // TODO(Tianyu): We might want to change this data structure to be more specialized than std::queue
-  std::queue<std::pair<timestamp_t, DeferredAction>> new_deferred_actions_, back_log_;
-  common::SpinLatch deferred_actions_latch_;
-
-  uint32_t ClearBacklog(timestamp_t oldest_txn) {
-    uint32_t processed = 0;
-    // Execute as many deferred actions as we can at this time from the backlog.
-    // Stop traversing
-    // TODO(Tianyu): This will not work if somehow the timestamps we compare against has sign bit flipped.
-    //  (for uncommiitted transactions, or on overflow)
-    // Although that should never happen, we need to be aware that this might be a problem in the future.
-    while (!back_log_.empty() && oldest_txn >= back_log_.front().first) {
-      back_log_.front().second(oldest_txn);
-      processed++;
-      back_log_.pop();
+  /** @return number of registered actions that have not been processed yet */
+  uint64_t NumPendingActions() {
+    uint64_t pending = 0;
+    for (auto &shard : shards_) {
+      common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+      for (const auto &bucket : shard.buckets_) pending += bucket.actions_.size();
     }
-    return processed;
+    return pending;
   }
 
-  uint32_t ProcessNewActions(timestamp_t oldest_txn) {
-    uint32_t processed = 0;
-    // swap the new actions queue with a local queue, so the rest of the system can continue
-    // while we process actions
-    std::queue<std::pair<timestamp_t, DeferredAction>> new_actions_local;
-    {
-      common::SpinLatch::ScopedSpinLatch guard(&deferred_actions_latch_);
-      new_actions_local = std::move(new_deferred_actions_);
-    }
+ private:
+  // The actions registered to a shard during one epoch
+  struct EpochBucket {
+    uint64_t epoch_;
+    std::vector<DeferredAction> actions_;
+  };
 
-    // Iterate through the new actions queue and execute as many as possible
-    while (!new_actions_local.empty() && oldest_txn >= new_actions_local.front().first) {
-      new_actions_local.front().second(oldest_txn);
-      processed++;
-      new_actions_local.pop();
-    }
+  // Aligned so that registrations to different shards do not share cache lines
+  struct alignas(common::Constants::CACHELINE_SIZE) EpochShard {
+    common::SpinLatch latch_;
+    // In epoch order, protected by latch_
+    std::deque<EpochBucket> buckets_;
+  };
 
-    // Add the rest to back log otherwise
-    while (!new_actions_local.empty()) {
-      back_log_.push(new_actions_local.front());
-      new_actions_local.pop();
-    }
-    return processed;
+  const common::ManagedPointer<TimestampManager> timestamp_manager_;
+  std::vector<EpochShard> shards_;
+  std::atomic<uint64_t> current_epoch_ = 0;
+  // Only accessed by Process. The end times of the closed epochs that are not yet retired, and the first epoch that is
+  // not retired.
+  std::queue<std::pair<uint64_t, timestamp_t>> epoch_end_times_;
+  uint64_t retired_epochs_end_ = 0;
+
+  // Threads keep using the same shard, which keeps their actions in registration order
+  uint32_t ShardIndex() const {
+    static thread_local const size_t thread_hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return static_cast<uint32_t>(thread_hash % shards_.size());
   }
 };
 }  // namespace noisepage::transaction
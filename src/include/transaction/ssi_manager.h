@@ -0,0 +1,176 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/constants.h"
+#include "common/macros.h"
+#include "common/managed_pointer.h"
+#include "common/spin_latch.h"
+#include "transaction/transaction_defs.h"
+
+namespace noisepage::storage {
+class RawBlock;
+}  // namespace noisepage::storage
+
+namespace noisepage::transaction {
+class TimestampManager;
+class TransactionContext;
+
+/**
+ * The SSI state of a serializable transaction. It outlives the TransactionContext, because a committed transaction
+ * still takes part in dangerous structures until every transaction that was concurrent with it has finished.
+ */
+struct SsiTransaction {
+  /** @param start_time start time of the transaction */
+  explicit SsiTransaction(const timestamp_t start_time) : start_time_(start_time) {}
+
+  /** Start time of the transaction */
+  const timestamp_t start_time_;
+  /** Set when the transaction must abort to break a dangerous structure. Read by the owner without the latch. */
+  std::atomic<bool> doomed_ = false;
+
+  // Everything below is guarded by the SsiManager's latch
+  /** Commit time, or the largest timestamp until it is known, which makes the transaction concurrent to everyone */
+  timestamp_t commit_time_{UINT64_MAX};
+  /** Some concurrent transaction read what this transaction wrote (rw-antidependency into this transaction) */
+  bool in_conflict_ = false;
+  /** This transaction read what some concurrent transaction wrote (rw-antidependency out of this transaction) */
+  bool out_conflict_ = false;
+  /** The transaction passed validation and is committing or committed */
+  bool committed_ = false;
+  /** The transaction aborted and no longer takes part in conflicts */
+  bool aborted_ = false;
+
+  /** Blocks this transaction holds a SIREAD lock on. Only modified by the owning thread, while it is running. */
+  std::unordered_set<const storage::RawBlock *> read_blocks_;
+};
+
+/**
+ * Implements Serializable Snapshot Isolation (Cahill et al., SIGMOD 2008) on top of the snapshot isolation of the
+ * DataTable. Only transactions begun with IsolationLevel::SERIALIZABLE are tracked, and serializability is only
+ * guaranteed amongst them.
+ *
+ * An rw-antidependency R -> W exists if R read a version that a concurrent transaction W overwrites. It is detected on
+ * either side, whoever comes second:
+ *   1. A reader that skips a version newer than its snapshot while reconstructing a tuple depends on the writer of
+ *      that version.
+ *   2. A writer depends on every concurrent reader holding a SIREAD lock on the block it writes to.
+ * SIREAD locks are taken on whole blocks instead of tuples or predicates. Index scans look up every tuple they return
+ * in the DataTable, so they lock the blocks of those tuples. This keeps the locking overhead to one latched insertion
+ * per block a transaction reads, at the cost of false positives between tuples that share a block.
+ *
+ * A transaction with both an incoming and an outgoing rw-antidependency is the pivot of a dangerous structure. It is
+ * doomed and aborts when it tries to commit, unless it already committed, in which case the transaction that completed
+ * the structure is doomed instead.
+ */
+class SsiManager {
+ public:
+  /**
+   * @param timestamp_manager source of the oldest running transaction, which decides when SSI state can be discarded
+   */
+  explicit SsiManager(common::ManagedPointer<TimestampManager> timestamp_manager)
+      : timestamp_manager_(timestamp_manager) {}
+
+  ~SsiManager();
+
+  DISALLOW_COPY_AND_MOVE(SsiManager)
+
+  /**
+   * Start tracking a transaction that was just begun with IsolationLevel::SERIALIZABLE.
+   * @param txn the transaction
+   */
+  void Begin(TransactionContext *txn);
+
+  /**
+   * Take a SIREAD lock on a block before reading a tuple in it.
+   * @param txn the reading transaction
+   * @param block the block of the tuple
+   */
+  void RegisterRead(TransactionContext *txn, const storage::RawBlock *block);
+
+  /**
+   * Record that a transaction skipped a version newer than its snapshot.
+   * @param txn the reading transaction
+   * @param version_timestamp timestamp of the skipped version
+   */
+  void RegisterNewerVersionRead(TransactionContext *txn, timestamp_t version_timestamp);
+
+  /**
+   * Record that a transaction wrote a tuple in a block. Call after the new version is installed.
+   * @param txn the writing transaction
+   * @param block the block of the tuple
+   */
+  void RegisterWrite(TransactionContext *txn, const storage::RawBlock *block);
+
+  /**
+   * Validate a transaction that is about to commit. If this succeeds, other transactions treat it as committed.
+   * @param txn the committing transaction
+   * @return true if it may commit, false if it is doomed and must abort
+   */
+  bool Validate(TransactionContext *txn);
+
+  /**
+   * Record the commit time of a validated transaction. Call before any of its versions carry the commit time.
+   * @param txn the committing transaction
+   * @param commit_time its commit time
+   */
+  void SetCommitTime(TransactionContext *txn, timestamp_t commit_time);
+
+  /**
+   * Stop tracking the conflicts of an aborted transaction.
+   * @param txn the aborted transaction
+   */
+  void Abort(TransactionContext *txn);
+
+  /** @return number of transactions whose SSI state is still kept around */
+  uint64_t NumTrackedTransactions() const {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    return by_start_time_.size();
+  }
+
+ private:
+  // How many transactions finish between two attempts to discard the state of finished transactions
+  static constexpr uint32_t CLEANUP_INTERVAL = 64;
+  static constexpr uint32_t NUM_LOCK_SHARDS = 64;
+
+  // SIREAD locks of all transactions on some of the blocks
+  struct alignas(common::Constants::CACHELINE_SIZE) LockShard {
+    std::unordered_map<const storage::RawBlock *, std::vector<SsiTransaction *>> readers_;
+    common::SpinLatch latch_;
+  };
+
+  LockShard &ShardFor(const storage::RawBlock *block) {
+    return lock_shards_[std::hash<const storage::RawBlock *>{}(block) % NUM_LOCK_SHARDS];
+  }
+
+  // Add the rw-antidependency reader -> writer and doom the pivot of any dangerous structure it completes. Requires the
+  // latch.
+  void AddConflict(SsiTransaction *reader, SsiTransaction *writer, SsiTransaction *current);
+
+  // A reader holding a SIREAD lock conflicts with a writer if their lifetimes overlapped. Requires the latch.
+  static bool Concurrent(const SsiTransaction &reader, const SsiTransaction &writer) {
+    return !reader.aborted_ && reader.commit_time_ > writer.start_time_;
+  }
+
+  // Discard the state of finished transactions that no running transaction is concurrent with. Requires the latch.
+  void CleanUp();
+
+  const common::ManagedPointer<TimestampManager> timestamp_manager_;
+
+  // Latch order is latch_ before the latch of a lock shard
+  mutable common::SpinLatch latch_;
+  std::unordered_map<timestamp_t, SsiTransaction *> by_start_time_;
+  std::unordered_map<timestamp_t, SsiTransaction *> by_commit_time_;
+  // Finished transactions, in the order they finished
+  std::deque<SsiTransaction *> finished_;
+  uint32_t finished_since_cleanup_ = 0;
+
+  LockShard lock_shards_[NUM_LOCK_SHARDS];
+};
+
+}  // namespace noisepage::transaction
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <algorithm>
-#include <unordered_set>
+#include <functional>
+#include <set>
+#include <thread>  // NOLINT
 #include <vector>
 
+#include "common/constants.h"
 #include "common/spin_latch.h"
 #include "common/strong_typedef.h"
 #include "transaction/transaction_defs.h"
@@ -14,14 +17,27 @@ class LogSerializerTask;
 }  // namespace noisepage::storage
 
 namespace noisepage::transaction {
+class TimestampManagerTests;
 class TransactionManager;
 /**
  * Generates timestamps, and keeps track of the lifetime of transactions (whether they have entered or left the system)
+ *
+ * The start times of running transactions are spread across one shard per hardware thread, and a transaction is
+ * registered with the shard of the thread that begins it. Beginning and removing transactions on different threads
+ * therefore rarely contend on a latch, and finding the oldest running transaction only looks at the oldest start time
+ * of every shard.
  */
 class TimestampManager {
  public:
+  /**
+   * @param num_shards number of shards the running transactions are spread across, one per hardware thread if 0
+   */
+  explicit TimestampManager(const uint32_t num_shards = 0)
+      : running_txns_(num_shards != 0 ? num_shards : std::max(1U, std::thread::hardware_concurrency())) {}
+
   ~TimestampManager() {
-    NOISEPAGE_ASSERT(curr_running_txns_.empty(),
+    NOISEPAGE_ASSERT(std::all_of(running_txns_.cbegin(), running_txns_.cend(),
+                                 [](const RunningTxnsShard &shard) { return shard.start_times_.empty(); }),
                      "Destroying the TimestampManager while txns are still running. That seems wrong.");
   }
 
@@ -30,6 +46,13 @@ class TimestampManager {
    */
   timestamp_t CheckOutTimestamp() { return time_++; }
 
+  /**
+   * Check out a range of unique timestamps with a single tick of the shared clock.
+   * @param num_timestamps number of timestamps to check out
+   * @return the first timestamp of the range, the others follow it consecutively
+   */
+  timestamp_t CheckOutTimestamps(const uint64_t num_timestamps) { return time_.fetch_add(num_timestamps); }
+
   /**
    * @return current time without advancing the tick
    */
@@ -39,9 +62,8 @@ class TimestampManager {
    * Get the oldest transaction alive (by start timestamp given out by this timestamp manager at this time)
    * Because of concurrent operations, it is not guaranteed that upon return the txn is still alive. However,
    * it is guaranteed that the return timestamp is older than any transactions live.
-   * @warning If logging is enabled, txns are not removed from the txn set until they are serialized. Thus, the active
-   * txn set can grow greatly in size, making this call expensive. Consider using CachedOldestTransactionStartTime for
-   * better performance at the cost of a more stale timestamp.
+   * This latches every shard in turn, so consider using CachedOldestTransactionStartTime for better performance at the
+   * cost of a more stale timestamp.
    * @return timestamp that is older than any transactions alive
    */
   timestamp_t OldestTransactionStartTime();
@@ -49,35 +71,35 @@ class TimestampManager {
   /**
    * Get the cached timestamp of the oldest active txn. The cached timestamp is only refreshed upon every invocation of
    * OldestTransactionStartTime, so it may be stale. On the other hand, this function does not require taking a latch or
-   * iterating through the running txns set, making it much cheaper than OldestTransactionStartTime. This has the same
-   * correctness guarantee as OldestTransactionStartTime, but may cause performance degradations for processes that rely
-   * on very fresh oldest txn timestamps
+   * iterating through the running txns shards, making it much cheaper than OldestTransactionStartTime. This has the
+   * same correctness guarantee as OldestTransactionStartTime, but may cause performance degradations for processes that
+   * rely on very fresh oldest txn timestamps
    * @return timestamp that is older than any transactions alive
    */
   timestamp_t CachedOldestTransactionStartTime();
 
  private:
-  // TransactionManager needs to be able to use the curr_running_txns_latch to guard more than just the
-  // duration of the following method calls --- things such as adding to the GC queue needs to be atomic
-  // along with removing a transaction from the table of active transactions. We need this for correctness
-  // in the deferred action framework when dropping tables.
+  // TransactionManager needs to be able to use the curr_running_txns_latch to guard its queue of completed
+  // transactions
   friend class TransactionManager;
   friend class storage::LogSerializerTask;
+  friend class TimestampManagerTests;
   timestamp_t BeginTransaction() {
+    RunningTxnsShard &shard = running_txns_[ShardIndex()];
     timestamp_t start_time;
     {
-      common::SpinLatch::ScopedSpinLatch running_guard(&curr_running_txns_latch_);
+      common::SpinLatch::ScopedSpinLatch running_guard(&shard.latch_);
       // There is a three-way race that needs to be prevented.  Specifically, we
       // cannot allow both a transaction to commit and the GC to poll for the
       // oldest running transaction in between this transaction acquiring its
       // begin timestamp and getting inserted into the current running
-      // transactions list.  Using the current running transactions latch
-      // prevents the GC from polling and stops the race.  This allows us to
-      // replace acquiring a shared instance of the commit latch with a
-      // read-only spin-latch and move the allocation out of a critical section.
+      // transactions list.  Holding the shard's latch prevents the GC from
+      // polling this shard, and the GC reads the current time before polling
+      // any shard, so a transaction that begins after the GC polled the shard
+      // gets a start time newer than the result.
       start_time = time_++;
 
-      const auto ret UNUSED_ATTRIBUTE = curr_running_txns_.emplace(start_time);
+      const auto ret UNUSED_ATTRIBUTE = shard.start_times_.emplace(start_time);
       NOISEPAGE_ASSERT(ret.second, "commit start time should be globally unique");
     }  // Release latch on current running transactions
     return start_time;
@@ -90,23 +112,37 @@ class TimestampManager {
   void RemoveTransaction(timestamp_t timestamp);
 
   /**
-   * Bulk remove a set of timestamps from the active txn set. Only grabs the curr_running_txns_latch_ once for all the
+   * Bulk remove a set of timestamps from the active txn set. Only grabs the latch of every shard once for all the
    * timestamps.
    * @param timestamps vector of timestamps to remove
    * @return True if there are no more running transactions after removal. False otherwise.
    */
   bool RemoveTransactions(const std::vector<timestamp_t> &timestamps);
 
+  // The start times of the running transactions begun on some of the threads. Aligned so that threads using different
+  // shards do not share cache lines.
+  struct alignas(common::Constants::CACHELINE_SIZE) RunningTxnsShard {
+    // Ordered, so that the oldest start time is always at the front
+    std::set<timestamp_t> start_times_;
+    common::SpinLatch latch_;
+  };
+
+  // A thread keeps beginning transactions in the same shard, and usually removes them from there as well
+  uint32_t ShardIndex() const {
+    static thread_local const size_t thread_hash = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return static_cast<uint32_t>(thread_hash % running_txns_.size());
+  }
+
   // TODO(Tianyu): Timestamp generation needs to be more efficient (batches)
   // TODO(Tianyu): We don't handle timestamp wrap-arounds. I doubt this would be an issue any time soon.
   std::atomic<timestamp_t> time_{INITIAL_TXN_TIMESTAMP};
   // We cache the oldest txn start time
   std::atomic<timestamp_t> cached_oldest_txn_start_time_{INITIAL_TXN_TIMESTAMP};
-  // TODO(Matt): consider a different data structure if this becomes a measured bottleneck
-  // TODO(Gus): This data structure initially only held items in the order of # of workers. With the logging change, it
-  // can hold many more, since txns are only removed when serialized. We should consider if there is a possible better
-  // data structure
-  std::unordered_set<timestamp_t> curr_running_txns_;
+  // TODO(Gus): The shards initially only held items in the order of # of workers. With the logging change, they can
+  // hold many more, since txns are only removed when serialized.
+  std::vector<RunningTxnsShard> running_txns_;
+  // Not used by the TimestampManager itself anymore. The TransactionManager uses it to guard its queue of completed
+  // transactions that are handed to the GC.
   mutable common::SpinLatch curr_running_txns_latch_;
 };
 }  // namespace noisepage::transaction
@@ -1,22 +1,29 @@
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <vector>
 
 #include "common/macros.h"
 #include "common/managed_pointer.h"
 #include "common/object_pool.h"
+#include "common/spin_latch.h"
 #include "common/strong_typedef.h"
 #include "storage/data_table.h"
 #include "storage/record_buffer.h"
 #include "storage/tuple_access_strategy.h"
 #include "storage/undo_record.h"
+#include "storage/varlen_allocator.h"
 #include "storage/write_ahead_log/log_record.h"
+#include "transaction/ssi_manager.h"
+#include "transaction/timestamp_manager.h"
 #include "transaction/transaction_util.h"
 
 namespace noisepage::storage {
 class GarbageCollector;
 class LogManager;
 class BlockCompactor;
+class DataTable;
 class LogSerializerTask;
 class SqlTable;
 class WriteAheadLoggingTests;
@@ -29,7 +36,51 @@ namespace noisepage::transaction {
  * A transaction context encapsulates the information kept while the transaction is running
  */
 class TransactionContext {
+  // The buffers that one worker of a parallel pipeline writes to on behalf of the transaction, @see WorkerScope
+  struct WorkerWriteBuffers;
+
  public:
+  /**
+   * While a worker scope is alive, the writes of the calling thread to the transaction go to buffers of the thread's
+   * own instead of the transaction's, so that the workers of a parallel pipeline can all write on behalf of the same
+   * transaction at once. The buffers are drawn on the first write only, and are handed back to the transaction when the
+   * scope ends. Their records join the transaction's on MergeWorkerWrites.
+   */
+  class WorkerScope {
+   public:
+    /**
+     * Routes the writes of the calling thread to buffers of its own
+     * @param txn the transaction that the calling thread works for
+     */
+    explicit WorkerScope(const common::ManagedPointer<TransactionContext> txn)
+        : txn_(txn.Get()), previous_(Current()) {
+      Current() = this;
+    }
+
+    /**
+     * Hands the buffers of the calling thread back to the transaction
+     */
+    ~WorkerScope() {
+      if (buffers_ != nullptr) txn_->ReleaseWorkerBuffers(buffers_);
+      Current() = previous_;
+    }
+
+    DISALLOW_COPY_AND_MOVE(WorkerScope)
+
+   private:
+    friend class TransactionContext;
+
+    // The innermost scope of the current thread, if any
+    static WorkerScope *&Current() {
+      static thread_local WorkerScope *current = nullptr;
+      return current;
+    }
+
+    TransactionContext *const txn_;
+    WorkerScope *const previous_;
+    WorkerWriteBuffers *buffers_ = nullptr;
+  };
+
   /**
    * Constructs a new transaction context.
    *
@@ -49,7 +100,9 @@ class TransactionContext {
       : start_time_(start),
         finish_time_(finish),
         undo_buffer_(buffer_pool.Get()),
-        redo_buffer_(log_manager.Get(), buffer_pool.Get()) {}
+        redo_buffer_(log_manager.Get(), buffer_pool.Get()),
+        buffer_pool_(buffer_pool.Get()),
+        log_manager_(log_manager.Get()) {}
 
   /**
    * @warning In the src/ folder this should only be called by the Garbage Collector to adhere to MVCC semantics. Tests
@@ -58,7 +111,7 @@ class TransactionContext {
    * DataTable.
    */
   ~TransactionContext() {
-    for (const byte *ptr : loose_ptrs_) delete[] ptr;
+    for (const byte *ptr : loose_ptrs_) storage::VarlenAllocator::Deallocate(ptr);
   }
 
   /**
@@ -74,6 +127,16 @@ class TransactionContext {
    */
   timestamp_t StartTime() const { return start_time_; }
 
+  /**
+   * @return a possibly stale timestamp that is older than any transaction alive, used to prune version chains inline.
+   * TransactionContexts generated outside of the TransactionManager (i.e. in tests) return INITIAL_TXN_TIMESTAMP, which
+   * prunes nothing.
+   */
+  timestamp_t CachedOldestTransactionStartTime() const {
+    if (timestamp_manager_ == nullptr) return INITIAL_TXN_TIMESTAMP;
+    return timestamp_manager_->CachedOldestTransactionStartTime();
+  }
+
   /**
    * @return finish time of this transaction if it has been aborted or logged as a commit. Otherwise, current
    * MVCC semantics define it as StartTime + INT64_MIN. TransactionContexts generated outside of the TransactionManager
@@ -91,8 +154,10 @@ class TransactionContext {
    */
   storage::UndoRecord *UndoRecordForUpdate(storage::DataTable *const table, const storage::TupleSlot slot,
                                            const storage::ProjectedRow &redo) {
+    NOISEPAGE_ASSERT(!declared_read_only_, "A transaction declared read-only cannot write.");
     const uint32_t size = storage::UndoRecord::Size(redo);
-    return storage::UndoRecord::InitializeUpdate(undo_buffer_.NewEntry(size), finish_time_.load(), slot, table, redo);
+    return storage::UndoRecord::InitializeUpdate(UndoBufferOfThisThread()->NewEntry(size), finish_time_.load(), slot,
+                                                 table, redo);
   }
 
   /**
@@ -102,10 +167,35 @@ class TransactionContext {
    * @return a persistent pointer to the head of a memory chunk large enough to hold the undo record
    */
   storage::UndoRecord *UndoRecordForInsert(storage::DataTable *const table, const storage::TupleSlot slot) {
-    byte *const result = undo_buffer_.NewEntry(sizeof(storage::UndoRecord));
+    NOISEPAGE_ASSERT(!declared_read_only_, "A transaction declared read-only cannot write.");
+    byte *const result = UndoBufferOfThisThread()->NewEntry(sizeof(storage::UndoRecord));
     return storage::UndoRecord::InitializeInsert(result, finish_time_.load(), slot, table);
   }
 
+  /**
+   * Reserve space on this transaction's undo buffer for the records to log a batch of inserts. The records are reserved
+   * a buffer segment at a time instead of one by one.
+   * @param table pointer to the updated DataTable object
+   * @param slots the TupleSlots inserted
+   * @param num_slots number of TupleSlots inserted
+   * @param[out] result receives a persistent pointer to the undo record of every TupleSlot, in the same order
+   */
+  void UndoRecordsForInsert(storage::DataTable *const table, const storage::TupleSlot *const slots,
+                            const uint32_t num_slots, storage::UndoRecord **const result) {
+    NOISEPAGE_ASSERT(!declared_read_only_, "A transaction declared read-only cannot write.");
+    const timestamp_t finish_time = finish_time_.load();
+    storage::UndoBuffer *const undo_buffer = UndoBufferOfThisThread();
+    uint32_t reserved = 0;
+    while (reserved < num_slots) {
+      uint32_t count;
+      byte *const head = undo_buffer->NewEntries(sizeof(storage::UndoRecord), num_slots - reserved, &count);
+      for (uint32_t i = 0; i < count; i++, reserved++) {
+        result[reserved] = storage::UndoRecord::InitializeInsert(head + i * sizeof(storage::UndoRecord), finish_time,
+                                                                 slots[reserved], table);
+      }
+    }
+  }
+
   /**
    * Reserve space on this transaction's undo buffer for a record to log the delete given
    * @param table pointer to the updated DataTable object
@@ -113,10 +203,24 @@ class TransactionContext {
    * @return a persistent pointer to the head of a memory chunk large enough to hold the undo record
    */
   storage::UndoRecord *UndoRecordForDelete(storage::DataTable *const table, const storage::TupleSlot slot) {
-    byte *const result = undo_buffer_.NewEntry(sizeof(storage::UndoRecord));
+    NOISEPAGE_ASSERT(!declared_read_only_, "A transaction declared read-only cannot write.");
+    byte *const result = UndoBufferOfThisThread()->NewEntry(sizeof(storage::UndoRecord));
     return storage::UndoRecord::InitializeDelete(result, finish_time_.load(), slot, table);
   }
 
+  /**
+   * Reserve space on this transaction's undo buffer for a record that holds the write lock on a tuple without changing
+   * it. Such records are never logged.
+   * @param table pointer to the DataTable object of the tuple
+   * @param slot the TupleSlot being locked
+   * @return a persistent pointer to the head of a memory chunk large enough to hold the undo record
+   */
+  storage::UndoRecord *UndoRecordForLock(storage::DataTable *const table, const storage::TupleSlot slot) {
+    NOISEPAGE_ASSERT(!declared_read_only_, "A transaction declared read-only cannot lock tuples.");
+    byte *const result = UndoBufferOfThisThread()->NewEntry(sizeof(storage::UndoRecord));
+    return storage::UndoRecord::InitializeLock(result, finish_time_.load(), slot, table);
+  }
+
   /**
    * Expose a record that can hold a change, described by the initializer given, that will be logged out to disk.
    * The change must be written in this space and then used to change the SqlTable.
@@ -132,9 +236,10 @@ class TransactionContext {
    */
   storage::RedoRecord *StageWrite(const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid,
                                   const storage::ProjectedRowInitializer &initializer) {
+    NOISEPAGE_ASSERT(!declared_read_only_, "A transaction declared read-only cannot write.");
     const uint32_t size = storage::RedoRecord::Size(initializer);
-    auto *const log_record = storage::RedoRecord::Initialize(redo_buffer_.NewEntry(size, GetTransactionPolicy()),
-                                                             start_time_, db_oid, table_oid, initializer);
+    auto *const log_record = storage::RedoRecord::Initialize(
+        RedoBufferOfThisThread()->NewEntry(size, GetTransactionPolicy()), start_time_, db_oid, table_oid, initializer);
     return log_record->GetUnderlyingRecordBodyAs<storage::RedoRecord>();
   }
 
@@ -148,9 +253,10 @@ class TransactionContext {
    */
   void StageDelete(const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid,
                    const storage::TupleSlot slot) {
+    NOISEPAGE_ASSERT(!declared_read_only_, "A transaction declared read-only cannot write.");
     const uint32_t size = storage::DeleteRecord::Size();
-    storage::DeleteRecord::Initialize(redo_buffer_.NewEntry(size, GetTransactionPolicy()), start_time_, db_oid,
-                                      table_oid, slot);
+    storage::DeleteRecord::Initialize(RedoBufferOfThisThread()->NewEntry(size, GetTransactionPolicy()), start_time_,
+                                      db_oid, table_oid, slot);
   }
 
   // TODO(Tianyu): We need to discuss what happens to the loose_ptrs field now that we have deferred actions.
@@ -159,12 +265,39 @@ class TransactionContext {
    */
   bool IsReadOnly() const { return undo_buffer_.Empty() && loose_ptrs_.empty(); }
 
+  /**
+   * @return whether the transaction staged any record to be logged. A transaction that only locked tuples did not.
+   */
+  bool HasStagedRecords() const { return redo_buffer_.LastRecord() != nullptr || redo_buffer_.HasFlushed(); }
+
+  /**
+   * Moves the records that the workers of a parallel pipeline wrote on behalf of the transaction to the transaction's
+   * own buffers, @see WorkerScope. No worker may be writing anymore.
+   * @param flush_redo whether the redo records of the workers should be logged out, or discarded on abort
+   */
+  void MergeWorkerWrites(bool flush_redo = true);
+
+  /**
+   * @return whether the transaction was begun as read-only, which lets it skip logging and the commit critical section.
+   * Such a transaction must not write, @see TransactionManager::BeginTransaction
+   */
+  bool IsDeclaredReadOnly() const { return declared_read_only_; }
+
+  /** @return whether the transaction runs at IsolationLevel::SERIALIZABLE and is tracked by the SsiManager */
+  bool IsSerializable() const { return ssi_txn_ != nullptr; }
+
+  /** @return the SsiManager that tracks this transaction, only valid if IsSerializable() */
+  common::ManagedPointer<SsiManager> GetSsiManager() const { return ssi_manager_; }
+
   /**
    * Defers an action to be called if and only if the transaction aborts.  Actions executed LIFO.
    * @param a the action to be executed. A handle to the system's deferred action manager is supplied
    * to enable further deferral of actions
    */
-  void RegisterAbortAction(const TransactionEndAction &a) { abort_actions_.push_front(a); }
+  void RegisterAbortAction(const TransactionEndAction &a) {
+    common::SpinLatch::ScopedSpinLatch guard(&end_actions_latch_);
+    abort_actions_.push_front(a);
+  }
 
   /**
    * Defers an action to be called if and only if the transaction aborts.  Actions executed LIFO.
@@ -180,7 +313,10 @@ class TransactionContext {
    * @param a the action to be executed. A handle to the system's deferred action manager is supplied
    * to enable further deferral of actions
    */
-  void RegisterCommitAction(const TransactionEndAction &a) { commit_actions_.push_front(a); }
+  void RegisterCommitAction(const TransactionEndAction &a) {
+    common::SpinLatch::ScopedSpinLatch guard(&end_actions_latch_);
+    commit_actions_.push_front(a);
+  }
 
   /**
    * Defers an action to be called if and only if the transaction commits.  Actions executed LIFO.
@@ -194,15 +330,16 @@ class TransactionContext {
   /**
    * This transaction encountered a conflict and cannot commit. Set a breakpoint at TransactionContext::SetMustAbort()
    * and run again to see why.
+   * A serializable transaction must also abort if it was doomed to break a dangerous structure.
    * @return true if txn must abort, false otherwise
    */
-  bool MustAbort() { return must_abort_; }
+  bool MustAbort() { return must_abort_ || (ssi_txn_ != nullptr && ssi_txn_->doomed_.load()); }
 
   /**
    * Flips the TransactionContext's internal flag that it cannot commit to true. This is checked by the
    * TransactionManager.
    */
-  void SetMustAbort() { must_abort_ = true; }
+  void SetMustAbort() { must_abort_.store(true); }
 
   /** Set the durability policy of the entire transaction. */
   void SetDurabilityPolicy(DurabilityPolicy durability_policy) { durability_policy_ = durability_policy; }
@@ -232,7 +369,9 @@ class TransactionContext {
  private:
   friend class storage::GarbageCollector;
   friend class TransactionManager;
+  friend class SsiManager;
   friend class storage::BlockCompactor;
+  friend class storage::DataTable;  // Frees the varlens that coalesced updates overwrite
   friend class storage::LogSerializerTask;
   friend class storage::SqlTable;
   friend class storage::WriteAheadLoggingTests;  // Needs access to redo buffer
@@ -242,6 +381,10 @@ class TransactionContext {
   std::atomic<timestamp_t> finish_time_;
   storage::UndoBuffer undo_buffer_;
   storage::RedoBuffer redo_buffer_;
+  storage::RecordBufferSegmentPool *const buffer_pool_;
+  storage::LogManager *const log_manager_;
+  // Set by the TransactionManager on begin
+  common::ManagedPointer<TimestampManager> timestamp_manager_ = nullptr;
   // TODO(Tianyu): Maybe not so much of a good idea to do this. Make explicit queue in GC?
   //
   std::vector<const byte *> loose_ptrs_;
@@ -249,6 +392,27 @@ class TransactionContext {
   // These actions will be triggered (not deferred) at abort/commit.
   std::forward_list<TransactionEndAction> abort_actions_;
   std::forward_list<TransactionEndAction> commit_actions_;
+  // Guards the registration of actions, which the optimizer may do from several threads at once
+  common::SpinLatch end_actions_latch_;
+
+  struct WorkerWriteBuffers {
+    WorkerWriteBuffers(storage::RecordBufferSegmentPool *const buffer_pool, storage::LogManager *const log_manager)
+        : undo_buffer_(buffer_pool), redo_buffer_(log_manager, buffer_pool) {}
+    storage::UndoBuffer undo_buffer_;
+    storage::RedoBuffer redo_buffer_;
+    std::vector<const byte *> loose_ptrs_;
+  };
+  // The buffers of the workers since the last merge, and the ones among them that no worker holds right now
+  std::vector<std::unique_ptr<WorkerWriteBuffers>> worker_buffers_;
+  std::vector<WorkerWriteBuffers *> idle_worker_buffers_;
+  common::SpinLatch worker_buffers_latch_;
+
+  // Set by the TransactionManager on begin. The transaction promises to never write.
+  bool declared_read_only_ = false;
+
+  // Set by the SsiManager on begin if the transaction is serializable, which also owns the SsiTransaction.
+  SsiTransaction *ssi_txn_ = nullptr;
+  common::ManagedPointer<SsiManager> ssi_manager_ = nullptr;
 
   // We need to know if the transaction is aborted. Even aborted transactions need an "abort" timestamp in order to
   // eliminate the a-b-a race described in DataTable::Select.
@@ -256,14 +420,39 @@ class TransactionContext {
 
   // This flag is used to denote that a physical change to the storage layer (tables or indexes) has occurred that
   // cannot be allowed to commit. Currently, it is flipped by indexes (on unique-key conflicts) or SqlTable (write-write
-  // conflicts) and checked in Commit().
-  bool must_abort_ = false;
+  // conflicts) and checked in Commit(). The workers of a parallel pipeline may flip it at the same time.
+  std::atomic<bool> must_abort_{false};
 
   /** The durability policy controls whether commits must wait for logs to be written to disk. */
   DurabilityPolicy durability_policy_ = DurabilityPolicy::SYNC;
   /** The replication policy controls whether logs must be applied on replicas before commits are invoked. */
   ReplicationPolicy replication_policy_ = ReplicationPolicy::DISABLE;
 
+  // The buffers of the calling thread if it works for this transaction in a WorkerScope, or nullptr
+  WorkerWriteBuffers *WorkerBuffersOfThisThread() {
+    WorkerScope *const scope = WorkerScope::Current();
+    if (scope == nullptr || scope->txn_ != this) return nullptr;
+    if (scope->buffers_ == nullptr) scope->buffers_ = AcquireWorkerBuffers();
+    return scope->buffers_;
+  }
+
+  // The buffers that the calling thread writes the records of this transaction to
+  storage::UndoBuffer *UndoBufferOfThisThread() {
+    WorkerWriteBuffers *const buffers = WorkerBuffersOfThisThread();
+    return buffers == nullptr ? &undo_buffer_ : &buffers->undo_buffer_;
+  }
+  storage::RedoBuffer *RedoBufferOfThisThread() {
+    WorkerWriteBuffers *const buffers = WorkerBuffersOfThisThread();
+    return buffers == nullptr ? &redo_buffer_ : &buffers->redo_buffer_;
+  }
+  std::vector<const byte *> *LoosePtrsOfThisThread() {
+    WorkerWriteBuffers *const buffers = WorkerBuffersOfThisThread();
+    return buffers == nullptr ? &loose_ptrs_ : &buffers->loose_ptrs_;
+  }
+
+  WorkerWriteBuffers *AcquireWorkerBuffers();
+  void ReleaseWorkerBuffers(WorkerWriteBuffers *buffers);
+
   /**
    * @warning This method is ONLY for recovery
    * Copy the log record into the transaction's redo buffer.
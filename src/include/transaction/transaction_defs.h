@@ -66,7 +66,9 @@ ENUM_DEFINE(DurabilityPolicy, uint8_t, DURABILITY_POLICY_ENUM);
   /** Synchronous: commits must wait for logs to be replicated and applied. */                             \
   T(ReplicationPolicy, SYNC)                                                                               \
   /** Asynchronous: logs will be replicated, but commits do not need to wait for replication to happen. */ \
-  T(ReplicationPolicy, ASYNC)
+  T(ReplicationPolicy, ASYNC)                                                                              \
+  /** Quorum: commits must wait for logs to be received, not applied, by a quorum of the replicas. */      \
+  T(ReplicationPolicy, QUORUM)
 /**
  * ReplicationPolicy controls whether logs should be replicated over the network,
  * and whether logs must be applied on replicas before commit callbacks are invoked.
@@ -74,6 +76,15 @@ ENUM_DEFINE(DurabilityPolicy, uint8_t, DURABILITY_POLICY_ENUM);
 ENUM_DEFINE(ReplicationPolicy, uint8_t, REPLICATION_POLICY_ENUM);
 #undef REPLICATION_POLICY_ENUM
 
+#define ISOLATION_LEVEL_ENUM(T)                                                                            \
+  /** Snapshot isolation, only write-write conflicts abort (first updater wins). */                        \
+  T(IsolationLevel, SNAPSHOT)                                                                              \
+  /** Serializable snapshot isolation, dangerous structures of rw-antidependencies abort as well. */       \
+  T(IsolationLevel, SERIALIZABLE)
+/** IsolationLevel controls which anomalies a transaction is protected from. */
+ENUM_DEFINE(IsolationLevel, uint8_t, ISOLATION_LEVEL_ENUM);
+#undef ISOLATION_LEVEL_ENUM
+
 /** Transaction-wide policies. */
 struct TransactionPolicy {
   DurabilityPolicy durability_;    ///< Durability policy for the entire transaction.
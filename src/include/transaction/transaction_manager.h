@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <queue>
 #include <unordered_set>
 #include <utility>
@@ -9,6 +10,7 @@
 #include "common/strong_typedef.h"
 #include "storage/record_buffer.h"
 #include "storage/undo_record.h"
+#include "transaction/ssi_manager.h"
 #include "transaction/timestamp_manager.h"
 #include "transaction/transaction_context.h"
 #include "transaction/transaction_defs.h"
@@ -36,15 +38,20 @@ class TransactionManager {
    * rather than waiting until durable on disk and being invoked by the WAL worker. Doesn't make sense to set to true if
    * WAL is not enabled.
    * @param log_manager the log manager in the system, or DISABLED(nulllptr) if logging is turned off.
+   * @param commit_batching true if concurrently committing transactions should check out their commit timestamps as a
+   * group, false if every transaction checks out its own
    */
   TransactionManager(const common::ManagedPointer<TimestampManager> timestamp_manager,
                      const common::ManagedPointer<DeferredActionManager> deferred_action_manager,
                      const common::ManagedPointer<storage::RecordBufferSegmentPool> buffer_pool, const bool gc_enabled,
-                     const bool wal_async_commit_enable, const common::ManagedPointer<storage::LogManager> log_manager)
+                     const bool wal_async_commit_enable, const common::ManagedPointer<storage::LogManager> log_manager,
+                     const bool commit_batching = false)
       : timestamp_manager_(timestamp_manager),
         deferred_action_manager_(deferred_action_manager),
         buffer_pool_(buffer_pool),
         gc_enabled_(gc_enabled),
+        commit_batching_(commit_batching),
+        ssi_manager_(timestamp_manager),
         log_manager_(log_manager) {
     NOISEPAGE_ASSERT(timestamp_manager_ != DISABLED, "transaction manager cannot function without a timestamp manager");
     NOISEPAGE_ASSERT(!wal_async_commit_enable || (wal_async_commit_enable && log_manager_ != DISABLED),
@@ -54,18 +61,33 @@ class TransactionManager {
     }
   }
 
+  /**
+   * Begins a transaction at snapshot isolation.
+   * @param read_only whether the transaction promises to never write. Such a transaction never logs, and commits by
+   * only leaving the set of running transactions, without checking out a commit timestamp. It may observe the writes of
+   * transactions whose commit is not yet durable, the same as a transaction with ASYNC durability.
+   * @return transaction context for the newly begun transaction
+   */
+  TransactionContext *BeginTransaction(const bool read_only = false) {
+    return BeginTransaction(read_only, IsolationLevel::SNAPSHOT);
+  }
+
   /**
    * Begins a transaction.
+   * @param read_only whether the transaction promises to never write, @see BeginTransaction(bool)
+   * @param isolation_level isolation level of the transaction
    * @return transaction context for the newly begun transaction
    */
-  TransactionContext *BeginTransaction();
+  TransactionContext *BeginTransaction(bool read_only, IsolationLevel isolation_level);
 
   /**
-   * Commits a transaction, making all of its changes visible to others.
+   * Commits a transaction, making all of its changes visible to others. A serializable transaction that fails SSI
+   * validation is aborted instead.
    * @param txn the transaction to commit
    * @param callback function pointer of the callback to invoke when commit is
    * @param callback_arg a void * argument that can be passed to the callback function when invoked
-   * @return commit timestamp of this transaction
+   * @return commit timestamp of this transaction, or INVALID_TXN_TIMESTAMP if a serializable transaction was aborted
+   * because it fails validation. The callback is invoked right away in that case.
    */
   timestamp_t Commit(TransactionContext *txn, transaction::callback_fn callback, void *callback_arg);
 
@@ -95,7 +117,8 @@ class TransactionManager {
   /** Set the default transaction replication policy. */
   void SetDefaultTransactionReplicationPolicy(const ReplicationPolicy &policy) {
     NOISEPAGE_ASSERT(default_txn_policy_.durability_ != DurabilityPolicy::DISABLE, "Replication relies on logs!");
-    NOISEPAGE_ASSERT(!(default_txn_policy_.durability_ == DurabilityPolicy::ASYNC && policy == ReplicationPolicy::SYNC),
+    NOISEPAGE_ASSERT(!(default_txn_policy_.durability_ == DurabilityPolicy::ASYNC &&
+                       (policy == ReplicationPolicy::SYNC || policy == ReplicationPolicy::QUORUM)),
                      "Weird configuration that we don't support; this would require a new approach that isn't "
                      "swap-the-commit-callback.");
     default_txn_policy_.replication_ = policy;
@@ -104,14 +127,35 @@ class TransactionManager {
   /** @return The default transaction policy. */
   const TransactionPolicy &GetDefaultTransactionPolicy() const { return default_txn_policy_; }
 
+  /** @return The SsiManager that tracks serializable transactions. */
+  common::ManagedPointer<SsiManager> GetSsiManager() { return common::ManagedPointer(&ssi_manager_); }
+
+  /** @return The TimestampManager that hands out the timestamps of transactions. */
+  common::ManagedPointer<TimestampManager> GetTimestampManager() const { return timestamp_manager_; }
+
  private:
   const common::ManagedPointer<TimestampManager> timestamp_manager_;
   const common::ManagedPointer<DeferredActionManager> deferred_action_manager_;
   const common::ManagedPointer<storage::RecordBufferSegmentPool> buffer_pool_;
   const bool gc_enabled_ = false;
+  const bool commit_batching_ = false;
 
   common::Gate txn_gate_;
 
+  // A transaction waiting for its commit timestamp in a commit batch. Lives on the stack of the committing thread.
+  struct CommitRequest {
+    TransactionContext *const txn_;
+    CommitRequest *next_ = nullptr;
+    timestamp_t commit_time_ = INVALID_TXN_TIMESTAMP;
+    std::atomic<bool> done_ = false;
+  };
+  // Requests that have not been picked up by a leader yet, most recent first
+  std::atomic<CommitRequest *> pending_commits_ = nullptr;
+  // Held by the leader of the current commit batch
+  common::SpinLatch commit_leader_latch_;
+
+  SsiManager ssi_manager_;
+
   TransactionQueue completed_txns_;
   const common::ManagedPointer<storage::LogManager> log_manager_;
 
@@ -120,6 +164,13 @@ class TransactionManager {
 
   timestamp_t UpdatingCommitCriticalSection(TransactionContext *txn);
 
+  // Flips the undo records of a committing txn to its commit time, and records it as the last commit of the tables
+  void StampCommit(TransactionContext *txn, timestamp_t commit_time);
+
+  timestamp_t BatchedCommitCriticalSection(TransactionContext *txn);
+
+  void ProcessCommitBatch(CommitRequest *batch);
+
   void LogCommit(TransactionContext *txn, timestamp_t commit_time, transaction::callback_fn commit_callback,
                  void *commit_callback_arg, timestamp_t oldest_active_txn);
 
@@ -133,6 +184,8 @@ class TransactionManager {
 
   void DeallocateInsertedTupleIfVarlen(TransactionContext *txn, storage::UndoRecord *undo,
                                        const storage::TupleAccessStrategy &accessor) const;
-  void GCLastUpdateOnAbort(TransactionContext *txn);
+  // Frees the varlens of the last update staged in the given buffers of txn, if the update was never installed
+  void GCLastUpdateOnAbort(TransactionContext *txn, const storage::RedoBuffer &redo_buffer,
+                           const storage::UndoBuffer &undo_buffer);
 };
 }  // namespace noisepage::transaction
@@ -4,6 +4,7 @@
 #include "settings/settings_defs.h"  // NOLINT
 #undef __SETTING_GFLAGS_DEFINE__     // NOLINT
 
+#include "execution/exec/sampling_profiler.h"
 #include "execution/execution_util.h"
 #include "storage/recovery/replication_log_provider.h"
 
@@ -47,10 +48,15 @@ void DBMain::ForceShutdown() {
 
 DBMain::~DBMain() { ForceShutdown(); }
 
-DBMain::ExecutionLayer::ExecutionLayer(const std::string &bytecode_handlers_path) {
-  execution::ExecutionUtil::InitTPL(bytecode_handlers_path);
+DBMain::ExecutionLayer::ExecutionLayer(const std::string &bytecode_handlers_path, const bool jit_perf_map,
+                                       const uint32_t sampling_profiler_hz) {
+  execution::ExecutionUtil::InitTPL(bytecode_handlers_path, jit_perf_map);
+  if (sampling_profiler_hz > 0) execution::exec::SamplingProfiler::Start(sampling_profiler_hz);
 }
 
-DBMain::ExecutionLayer::~ExecutionLayer() { execution::ExecutionUtil::ShutdownTPL(); }
+DBMain::ExecutionLayer::~ExecutionLayer() {
+  execution::exec::SamplingProfiler::Stop();
+  execution::ExecutionUtil::ShutdownTPL();
+}
 
 }  // namespace noisepage
@@ -1,14 +1,24 @@
 #include "messenger/messenger.h"
 
-#include <cinttypes>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <map>
+#include <memory>
 #include <mutex>  // NOLINT
+#include <utility>
 #include <vector>
 #include <zmq.hpp>
 
 #include "common/dedicated_thread_registry.h"
 #include "common/error/exception.h"
+#include "common/thread_context.h"
 #include "loggers/messenger_logger.h"
 #include "messenger/connection_destination.h"
+#include "metrics/metrics_store.h"
 
 /*
  * A crash course on ZeroMQ (ZMQ).
@@ -95,34 +105,39 @@ namespace noisepage::messenger {
 
 ZmqMessage ZmqMessage::Build(message_id_t message_id, callback_id_t source_cb_id, callback_id_t dest_cb_id,
                              const std::string &routing_id, std::string_view message) {
-  return ZmqMessage{routing_id, fmt::format("{}-{}-{}-{}", message_id.UnderlyingValue(), source_cb_id.UnderlyingValue(),
-                                            dest_cb_id.UnderlyingValue(), message)};
+  // The message is copied exactly once, into a buffer that is shared by the pending message and ZeroMQ.
+  std::string header = fmt::format("{}-{}-{}-", message_id.UnderlyingValue(), source_cb_id.UnderlyingValue(),
+                                   dest_cb_id.UnderlyingValue());
+  auto payload = std::make_shared<std::string>();
+  payload->reserve(header.size() + message.size());
+  payload->append(header).append(message);
+  std::string_view payload_view(*payload);
+  return ZmqMessage{routing_id, std::move(payload), payload_view};
 }
 
-ZmqMessage ZmqMessage::Parse(const std::string &routing_id, const std::string &message) {
-  return ZmqMessage{routing_id, message};
+ZmqMessage ZmqMessage::Parse(std::string routing_id, std::shared_ptr<const void> payload_owner,
+                             std::string_view payload) {
+  return ZmqMessage{std::move(routing_id), std::move(payload_owner), payload};
 }
 
-ZmqMessage::ZmqMessage(std::string routing_id, std::string payload)
-    : routing_id_(std::move(routing_id)), payload_(std::move(payload)), message_(payload_) {
-  uint64_t message_id;
-  uint64_t source_cb_id;
-  uint64_t dest_cb_id;
-
+ZmqMessage::ZmqMessage(std::string routing_id, std::shared_ptr<const void> payload_owner, std::string_view payload)
+    : routing_id_(std::move(routing_id)), payload_owner_(std::move(payload_owner)), payload_(payload) {
   NOISEPAGE_ASSERT(!payload_.empty(), "Payload must be defined for valid messages.");
-  // TODO(WAN): atoi, stoull, from_chars, etc? Error checking in general.
-  UNUSED_ATTRIBUTE int check =
-      std::sscanf(payload_.c_str(), "%" SCNu64 "-%" SCNu64 "-%" SCNu64 "-", &message_id, &source_cb_id, &dest_cb_id);
-  NOISEPAGE_ASSERT(3 == check, "Couldn't parse the message header.");
-
-  // Remove the prefix up to the third '-'
-  message_.remove_prefix(message_.find_first_of('-') + 1);
-  message_.remove_prefix(message_.find_first_of('-') + 1);
-  message_.remove_prefix(message_.find_first_of('-') + 1);
-
-  message_id_ = message_id_t{message_id};
-  source_cb_id_ = callback_id_t{source_cb_id};
-  dest_cb_id_ = callback_id_t{dest_cb_id};
+
+  // Parse the ID-SRC-DST- prefix in place. The payload may be a received ZeroMQ frame, which is not null-terminated.
+  std::array<uint64_t, 3> ids{};
+  std::string_view rest = payload_;
+  for (auto &id : ids) {
+    const auto [end, error] = std::from_chars(rest.data(), rest.data() + rest.size(), id);
+    NOISEPAGE_ASSERT(error == std::errc() && end != rest.data() + rest.size() && *end == '-',
+                     "Couldn't parse the message header.");
+    rest.remove_prefix(end - rest.data() + 1);
+  }
+
+  message_id_ = message_id_t{ids[0]};
+  source_cb_id_ = callback_id_t{ids[1]};
+  dest_cb_id_ = callback_id_t{ids[2]};
+  message_ = rest;
 }
 
 /** An abstraction around all the ZeroMQ poll items that the Messenger holds. */
@@ -158,8 +173,6 @@ class MessengerPolledSockets {
     return read_;
   }
 
-  /** Include the specified @p socket on all subsequent calls to pollitems. */
-
   /**
    * Add a new socket to all subsequent calls to GetPollItems().
    * @param socket      The socket to be added.
@@ -177,6 +190,23 @@ class MessengerPolledSockets {
     }
   }
 
+  /**
+   * Add a file descriptor to all subsequent calls to GetPollItems(). The file descriptor is only used to wake up poll,
+   * so its poll item has a null socket and no callback.
+   * @param fd          The file descriptor to be added.
+   */
+  void AddPollFd(int fd) {
+    zmq::pollitem_t pollitem;
+    pollitem.socket = nullptr;     // Poll on a file descriptor, not on a socket.
+    pollitem.fd = fd;              // The file descriptor to poll on.
+    pollitem.events = ZMQ_POLLIN;  // Event: at least one byte can be read from the file descriptor.
+    {
+      std::scoped_lock lock(mutex_);
+      writer_.items_.emplace_back(pollitem);
+      writer_.server_callbacks_.emplace_back(nullptr);
+    }
+  }
+
  private:
   /** The items to be polled (reader side). */
   PollItems read_;
@@ -191,8 +221,8 @@ class MessengerPolledSockets {
 namespace noisepage::messenger {
 
 /**
- * Useful ZeroMQ utility functions implemented in a naive manner. Most functions have wasteful copies.
- * If perf indicates that these functions are a bottleneck, switch to the zero-copy messages of ZeroMQ.
+ * Useful ZeroMQ utility functions. Payloads are sent and received with the zero-copy messages of ZeroMQ; only the short
+ * routing IDs are copied.
  */
 class ZmqUtil {
  private:
@@ -201,6 +231,9 @@ class ZmqUtil {
     return socket->get(zmq::sockopt::rcvmore) > 0;
   }
 
+  /** Invoked by ZeroMQ once it is done with a payload that was sent without copying. Drops ZeroMQ's reference. */
+  static void ReleasePayload(void * /*data*/, void *hint) { delete static_cast<std::shared_ptr<const void> *>(hint); }
+
  public:
   /** ZmqUtil is a static utility class that should not be instantiated. */
   ZmqUtil() = delete;
@@ -214,30 +247,39 @@ class ZmqUtil {
   }
 
   /**
-   * @return    The next string to be read off the socket.
+   * @return    The next message part to be read off the socket.
    * @warning   Socket must be effectively latched!
    */
-  static std::string Recv(const common::ManagedPointer<zmq::socket_t> socket, zmq::recv_flags flags) {
+  static zmq::message_t RecvPart(const common::ManagedPointer<zmq::socket_t> socket) {
     zmq::message_t message;
-    auto received = socket->recv(message, flags);
-    if (!received.has_value()) {
+    if (!socket->recv(message, zmq::recv_flags::none).has_value()) {
       throw MESSENGER_EXCEPTION(fmt::format("Unable to receive on socket: {}", ZmqUtil::GetRoutingId(socket)));
     }
-    return std::string(static_cast<char *>(message.data()), received.value());
+    return message;
   }
 
   /**
-   * @return    The next ZmqMessage (identity and payload) read off the socket.
+   * Read the next multipart message off the socket. A multipart message is an identity, a delimiter, and one or more
+   * payloads, since the sender may batch several messages to the same destination together.
+   *
+   * The payloads are not copied. Each ZmqMessage keeps the ZeroMQ frame that it was received in alive instead.
+   *
+   * @return    The ZmqMessages that were read off the socket, in the order that they were sent.
    * @warning   Socket must be effectively latched!
    */
-  static ZmqMessage RecvMsg(const common::ManagedPointer<zmq::socket_t> socket) {
-    std::string identity = Recv(socket, zmq::recv_flags::none);
+  static std::vector<ZmqMessage> RecvMsgs(const common::ManagedPointer<zmq::socket_t> socket) {
+    std::string identity = RecvPart(socket).to_string();
     NOISEPAGE_ASSERT(HasMoreMessagePartsToReceive(socket), "Bad multipart message.");
-    std::string delimiter = Recv(socket, zmq::recv_flags::none);
+    RecvPart(socket);  // The empty delimiter.
     NOISEPAGE_ASSERT(HasMoreMessagePartsToReceive(socket), "Bad multipart message.");
-    std::string payload = Recv(socket, zmq::recv_flags::none);
 
-    return ZmqMessage::Parse(identity, payload);
+    std::vector<ZmqMessage> msgs;
+    do {
+      auto frame = std::make_shared<zmq::message_t>(RecvPart(socket));
+      std::string_view payload(frame->data<char>(), frame->size());
+      msgs.emplace_back(ZmqMessage::Parse(identity, std::move(frame), payload));
+    } while (HasMoreMessagePartsToReceive(socket));
+    return msgs;
   }
 
   /**
@@ -254,21 +296,39 @@ class ZmqUtil {
   }
 
   /**
-   * @return    Send the specified ZmqMessage (delimiter and payload) over the socket.
+   * @return    Send the specified ZmqMessages (delimiter and all the payloads) over the socket as a multipart message.
+   *            The payloads are not copied; ZeroMQ shares ownership of them until it is done sending.
    * @warning   Socket must be effectively latched!
    */
-  static void SendMsgPayload(const common::ManagedPointer<zmq::socket_t> socket, const ZmqMessage &msg) {
+  static void SendMsgPayloads(const common::ManagedPointer<zmq::socket_t> socket,
+                              const std::vector<const ZmqMessage *> &msgs) {
+    NOISEPAGE_ASSERT(!msgs.empty(), "Must send at least one payload.");
     zmq::message_t delimiter_msg("", 0);
-    zmq::message_t payload_msg(msg.GetRawPayload().data(), msg.GetRawPayload().size());
-    bool ok = true;
-
-    ok = ok && socket->send(delimiter_msg, zmq::send_flags::sndmore).has_value();
-    ok = ok && socket->send(payload_msg, zmq::send_flags::none).has_value();
+    bool ok = socket->send(delimiter_msg, zmq::send_flags::sndmore).has_value();
+
+    for (size_t i = 0; ok && i < msgs.size(); ++i) {
+      const ZmqMessage &msg = *msgs[i];
+      auto owner = std::make_unique<std::shared_ptr<const void>>(msg.payload_owner_);
+      zmq::message_t payload_msg(const_cast<char *>(msg.payload_.data()), msg.payload_.size(),  // NOLINT
+                                 ReleasePayload, owner.get());
+      // ZeroMQ now owns the reference and will release it through ReleasePayload().
+      owner.release();  // NOLINT
+      auto flags = i + 1 < msgs.size() ? zmq::send_flags::sndmore : zmq::send_flags::none;
+      ok = socket->send(payload_msg, flags).has_value();
+    }
 
     if (!ok) {
       throw MESSENGER_EXCEPTION(fmt::format("Unable to send on socket: {}", ZmqUtil::GetRoutingId(socket)));
     }
   }
+
+  /**
+   * @return    Send the specified ZmqMessage (delimiter and payload) over the socket.
+   * @warning   Socket must be effectively latched!
+   */
+  static void SendMsgPayload(const common::ManagedPointer<zmq::socket_t> socket, const ZmqMessage &msg) {
+    SendMsgPayloads(socket, {&msg});
+  }
 };
 
 /** Utility functions for Messenger maintenance. */
@@ -379,10 +439,24 @@ Messenger::Messenger(const uint16_t port, std::string identity) : port_(port), i
 
   polled_sockets_ = std::make_unique<MessengerPolledSockets>();
   polled_sockets_->AddPollItem(zmq_default_socket_.get(), nullptr);
+
+  // Other threads wake up the server loop by writing to a pipe that the server loop polls on, e.g., when a message is
+  // queued to be sent. Both ends are non-blocking: a full pipe already has wake-ups pending, and an empty pipe is done.
+  if (0 != ::pipe(wakeup_pipe_.data())) {
+    throw MESSENGER_EXCEPTION("Unable to create the Messenger wake-up pipe.");
+  }
+  for (int fd : wakeup_pipe_) {
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);  // NOLINT
+  }
+  polled_sockets_->AddPollFd(wakeup_pipe_[0]);
   is_messenger_running_ = true;
 }
 
-Messenger::~Messenger() = default;
+Messenger::~Messenger() {
+  for (int fd : wakeup_pipe_) {
+    ::close(fd);
+  }
+}
 
 void Messenger::RunTask() {
   try {
@@ -411,6 +485,7 @@ router_id_t Messenger::ListenForConnection(const ConnectionDestination &target,
   std::unique_lock lock(routers_add_mutex_);
   router_id_t router_id = next_router_id_++;
   routers_to_be_added_.emplace_back(RouterToBeAdded{router_id, target, identity, std::move(callback)});
+  WakeUpServerLoop();
   routers_add_cvar_.wait(lock);
   return router_id;
 }
@@ -421,6 +496,7 @@ connection_id_t Messenger::MakeConnection(const ConnectionDestination &target) {
   std::unique_lock lock(connections_add_mutex_);
   connection_id_t connection_id = next_connection_id_++;
   connections_to_be_added_.emplace_back(ConnectionToBeAdded{connection_id, target});
+  WakeUpServerLoop();
   connections_add_cvar_.wait(lock);
   return connection_id;
 }
@@ -440,13 +516,10 @@ void Messenger::SendMessage(const connection_id_t connection_id, const std::stri
 
   // Build and queue the message to be sent.
   common::ManagedPointer<zmq::socket_t> socket = common::ManagedPointer(connection->socket_);
-  {
-    std::unique_lock lock(pending_messages_mutex_);
-    pending_messages_.emplace(
-        msg_id,
-        PendingMessage{socket, connection->target_name_,
-                       ZmqMessage::Build(msg_id, sender_cb_id, remote_cb_id, connection->routing_id_, message), false});
-  }
+  AddPendingMessage(msg_id, PendingMessage{socket, connection->target_name_,
+                                           ZmqMessage::Build(msg_id, sender_cb_id, remote_cb_id,
+                                                             connection->routing_id_, message),
+                                           false});
 }
 
 void Messenger::SendMessage(const router_id_t router_id, const std::string &recv_id, const std::string &message,
@@ -464,12 +537,49 @@ void Messenger::SendMessage(const router_id_t router_id, const std::string &recv
 
   // Build and send the message. Note that ConnectionRouter is a ROUTER socket.
   common::ManagedPointer<zmq::socket_t> socket = common::ManagedPointer(router->socket_);
+  AddPendingMessage(msg_id, PendingMessage{socket, recv_id,
+                                           ZmqMessage::Build(msg_id, send_cb_id, remote_cb_id, router->identity_,
+                                                             message),
+                                           true});
+}
+
+bool Messenger::WaitForPendingMessagesBelow(const connection_id_t connection_id, const uint32_t max_pending,
+                                            const std::chrono::milliseconds timeout) {
+  const std::string &destination_id = connections_.at(connection_id)->target_name_;
+  std::unique_lock lock(pending_messages_mutex_);
+  return pending_messages_cvar_.wait_for(lock, timeout, [&] {
+    auto it = destinations_.find(destination_id);
+    return it == destinations_.end() || it->second.num_pending_ < max_pending;
+  });
+}
+
+void Messenger::AddPendingMessage(const message_id_t msg_id, PendingMessage msg) {
   {
     std::unique_lock lock(pending_messages_mutex_);
-    pending_messages_.emplace(
-        msg_id, PendingMessage{socket, recv_id,
-                               ZmqMessage::Build(msg_id, send_cb_id, remote_cb_id, router->identity_, message), true});
+    destinations_[msg.destination_id_].num_pending_++;
+    pending_messages_.emplace(msg_id, std::move(msg));
   }
+  WakeUpServerLoop();
+}
+
+void Messenger::WakeUpServerLoop() {
+  // A failed write means that the pipe is full, in which case the server loop has plenty of wake-ups pending already.
+  const char byte = 0;
+  UNUSED_ATTRIBUTE ssize_t written = ::write(wakeup_pipe_[1], &byte, 1);
+}
+
+void Messenger::UpdateRoundTripTime(DestinationState *const destination, const std::chrono::microseconds rtt) {
+  if (destination->srtt_.count() == 0) {
+    destination->srtt_ = rtt;
+    destination->rttvar_ = rtt / 2;
+  } else {
+    const std::chrono::microseconds error =
+        destination->srtt_ > rtt ? destination->srtt_ - rtt : rtt - destination->srtt_;
+    destination->rttvar_ = (3 * destination->rttvar_ + error) / 4;
+    destination->srtt_ = (7 * destination->srtt_ + rtt) / 8;
+  }
+  destination->rto_ = std::clamp<std::chrono::microseconds>(destination->srtt_ + 4 * destination->rttvar_,
+                                                            MESSENGER_MIN_RTO, MESSENGER_MAX_RTO);
 }
 
 callback_id_t Messenger::GetNextSendCallbackId() {
@@ -518,47 +628,93 @@ void Messenger::ServerLoopMakeConnections() {
   }
 }
 
-void Messenger::ServerLoopSendMessages() {
+std::chrono::milliseconds Messenger::ServerLoopSendMessages() {
+  std::chrono::milliseconds timeout = MESSENGER_POLL_TIMER;
   // Note that the stale read of empty() is probably undefined behavior. If wonky behavior is observed, watch out here.
   if (!pending_messages_.empty()) {
-    std::time_t now = std::time(nullptr);
+    const auto now = std::chrono::steady_clock::now();
+    auto next_resend_time = now + MESSENGER_POLL_TIMER;
 
     std::unique_lock lock(pending_messages_mutex_);
+    // Group the messages that are due by socket and destination, preserving message ID order within each group.
+    // Each group is then sent as a few multipart messages instead of as one multipart message per pending message.
+    std::map<std::pair<zmq::socket_t *, std::string_view>, std::vector<const PendingMessage *>> batches;
     for (auto &item : pending_messages_) {
       PendingMessage &msg = item.second;
-      const common::ManagedPointer<zmq::socket_t> socket = msg.zmq_socket_;
-      const std::string &destination = msg.destination_id_;
-
-      if (now - msg.last_send_time_ <= MESSENGER_RESEND_TIMER.count()) {
+      DestinationState &destination = destinations_[msg.destination_id_];
+      if (msg.num_sends_ == 0) {
+        // New messages are only sent while the destination's window has room. Acknowledgements free up the window.
+        if (destination.num_in_flight_ >= MESSENGER_MAX_IN_FLIGHT) {
+          continue;
+        }
+        destination.num_in_flight_++;
+        msg.first_send_time_ = now;
+      } else if (now < msg.resend_time_) {
+        next_resend_time = std::min(next_resend_time, msg.resend_time_);
         continue;
       }
-      msg.last_send_time_ = now;
+      // Back off exponentially on every resend of the same message, so that a congested link is not flooded.
+      const std::chrono::microseconds backoff = destination.rto_ * (1U << std::min(msg.num_sends_, 16U));
+      msg.resend_time_ = now + std::min(backoff, std::chrono::microseconds(MESSENGER_MAX_RTO));
+      msg.num_sends_++;
+      next_resend_time = std::min(next_resend_time, msg.resend_time_);
+      batches[{msg.zmq_socket_.Get(), msg.destination_id_}].emplace_back(&msg);
+    }
+    timeout = std::chrono::ceil<std::chrono::milliseconds>(next_resend_time - now);
+
+    for (const auto &batch : batches) {
+      const common::ManagedPointer<zmq::socket_t> socket(batch.first.first);
+      const std::vector<const PendingMessage *> &msgs = batch.second;
+      const PendingMessage &first = *msgs.front();
+      const std::string &destination = first.destination_id_;
+
+      for (size_t start = 0; start < msgs.size(); start += MESSENGER_MAX_BATCH_SIZE) {
+        size_t end = std::min(msgs.size(), static_cast<size_t>(start + MESSENGER_MAX_BATCH_SIZE));
+        std::vector<const ZmqMessage *> payloads;
+        payloads.reserve(end - start);
+        for (size_t i = start; i < end; ++i) {
+          payloads.emplace_back(&msgs[i]->msg_);
+        }
 
-      if (msg.is_router_socket_) {
-        zmq::message_t router_data(destination.data(), destination.size());
-        if (!socket->send(router_data, zmq::send_flags::sndmore).has_value()) {
-          throw MESSENGER_EXCEPTION("Could not send message!");
+        if (first.is_router_socket_) {
+          zmq::message_t router_data(destination.data(), destination.size());
+          if (!socket->send(router_data, zmq::send_flags::sndmore).has_value()) {
+            throw MESSENGER_EXCEPTION("Could not send message!");
+          }
+          ZmqUtil::SendMsgIdentity(socket, first.msg_.routing_id_);
+        }
+        ZmqUtil::SendMsgPayloads(socket, payloads);
+
+        for (const ZmqMessage *msg : payloads) {
+          if (first.is_router_socket_) {
+            MESSENGER_LOG_TRACE(fmt::format("[PID={}] Messenger ({}) SENT-TO {}: {} ", ::getpid(), msg->routing_id_,
+                                            destination, msg->GetRawPayload()));
+          } else {
+            MESSENGER_LOG_TRACE(
+                fmt::format("[PID={}] Messenger SENT-TO {}: {} ", ::getpid(), destination, msg->GetRawPayload()));
+          }
         }
-        ZmqUtil::SendMsgIdentity(socket, msg.msg_.routing_id_);
       }
-      ZmqUtil::SendMsgPayload(socket, msg.msg_);
 
-      if (msg.is_router_socket_) {
-        MESSENGER_LOG_TRACE(fmt::format("[PID={}] Messenger ({}) SENT-TO {}: {} ", ::getpid(), msg.msg_.routing_id_,
-                                        destination, msg.msg_.GetRawPayload()));
-      } else {
-        MESSENGER_LOG_TRACE(
-            fmt::format("[PID={}] Messenger SENT-TO {}: {} ", ::getpid(), destination, msg.msg_.GetRawPayload()));
+      if (common::thread_context.metrics_store_ != nullptr &&
+          common::thread_context.metrics_store_->ComponentToRecord(metrics::MetricsComponent::REPLICATION)) {
+        const auto num_resent = static_cast<uint64_t>(
+            std::count_if(msgs.cbegin(), msgs.cend(), [](const PendingMessage *msg) { return msg->num_sends_ > 1; }));
+        const DestinationState &state = destinations_.at(destination);
+        common::thread_context.metrics_store_->RecordMessengerData(destination, msgs.size() - num_resent, num_resent,
+                                                                   state.num_pending_, state.srtt_.count(),
+                                                                   state.rto_.count());
       }
     }
   }
+  return timeout;
 }
 
-void Messenger::ServerLoopRecvAndProcessMessages() {
+void Messenger::ServerLoopRecvAndProcessMessages(const std::chrono::milliseconds timeout) {
   // Get the latest set of poll items.
   auto poll_items = polled_sockets_->GetPollItems();
   // Poll on the current set of poll items.
-  int num_sockets_with_data = zmq::poll(poll_items.items_, MESSENGER_POLL_TIMER);
+  int num_sockets_with_data = zmq::poll(poll_items.items_, timeout);
   for (size_t i = 0; i < poll_items.items_.size(); ++i) {
     zmq::pollitem_t &item = poll_items.items_[i];
     // If no more sockets have data, then go back to polling.
@@ -567,36 +723,57 @@ void Messenger::ServerLoopRecvAndProcessMessages() {
     }
     // Otherwise, at least some socket has data. Is it the current socket?
     bool socket_has_data = (item.revents & ZMQ_POLLIN) != 0;
-    if (socket_has_data) {
+    if (socket_has_data && item.socket == nullptr) {
+      // The wake-up pipe. Poll has returned, which was the point, so just drain the pipe.
+      std::array<char, 64> buf{};
+      while (::read(item.fd, buf.data(), buf.size()) > 0) {
+      }
+      --num_sockets_with_data;
+    } else if (socket_has_data) {
       common::ManagedPointer<zmq::socket_t> socket(reinterpret_cast<zmq::socket_t *>(&item.socket));
-      ZmqMessage msg = ZmqUtil::RecvMsg(socket);
-
-      if (msg.GetDestinationCallbackId().UnderlyingValue() != static_cast<uint8_t>(BuiltinCallback::ACK)) {
-        zmq::message_t router_data(msg.GetRoutingId().data(), msg.GetRoutingId().size());
+      std::vector<ZmqMessage> msgs = ZmqUtil::RecvMsgs(socket);
+
+      // Acknowledge every message in the batch that is not itself an ACK, with a single batch of ACKs.
+      std::vector<ZmqMessage> acks;
+      for (const ZmqMessage &msg : msgs) {
+        if (msg.GetDestinationCallbackId().UnderlyingValue() != static_cast<uint8_t>(BuiltinCallback::ACK)) {
+          acks.emplace_back(ZmqMessage::Build(msg.GetMessageId(), GetBuiltinCallback(BuiltinCallback::NOOP),
+                                              GetBuiltinCallback(BuiltinCallback::ACK), identity_, ""));
+        }
+      }
+      if (!acks.empty()) {
+        // All the messages in a batch come from the same sender.
+        std::string_view sender = msgs.front().GetRoutingId();
+        zmq::message_t router_data(sender.data(), sender.size());
         if (!socket->send(router_data, zmq::send_flags::sndmore).has_value()) {
           throw MESSENGER_EXCEPTION("Failed to set router recipient.");
         }
-        ZmqMessage ack = ZmqMessage::Build(msg.GetMessageId(), GetBuiltinCallback(BuiltinCallback::NOOP),
-                                           GetBuiltinCallback(BuiltinCallback::ACK), identity_, "");
+        std::vector<const ZmqMessage *> ack_ptrs;
+        ack_ptrs.reserve(acks.size());
+        for (const ZmqMessage &ack : acks) {
+          ack_ptrs.emplace_back(&ack);
+        }
         ZmqUtil::SendMsgIdentity(socket, identity_);
-        ZmqUtil::SendMsgPayload(socket, ack);
+        ZmqUtil::SendMsgPayloads(socket, ack_ptrs);
       }
 
       bool has_custom_serverloop = poll_items.server_callbacks_[i] != nullptr;
-      MESSENGER_LOG_TRACE("[PID={}] Messenger RECV-FR {} (custom serverloop: {}): {}", ::getpid(), msg.GetRoutingId(),
-                          has_custom_serverloop, msg.GetRawPayload());
-      // See the ProcessMessage() docstring.
-      // ProcessMessage() must always be invoked so that the callback that was passed in with SendMessage() is invoked.
-      ProcessMessage(msg);
-      if (msg.GetDestinationCallbackId().UnderlyingValue() != static_cast<uint8_t>(BuiltinCallback::ACK)) {
-        std::string sender_id(msg.GetRoutingId());
-        bool first_time = UpdateMessagesSeen(sender_id, msg.GetMessageId());
-        if (!first_time) {
-          continue;
-        }
-        if (has_custom_serverloop) {
-          auto &server_callback = poll_items.server_callbacks_[i];
-          (*server_callback)(common::ManagedPointer(this), msg);
+      for (const ZmqMessage &msg : msgs) {
+        MESSENGER_LOG_TRACE("[PID={}] Messenger RECV-FR {} (custom serverloop: {}): {}", ::getpid(),
+                            msg.GetRoutingId(), has_custom_serverloop, msg.GetRawPayload());
+        // See the ProcessMessage() docstring. ProcessMessage() must always be invoked so that the callback that was
+        // passed in with SendMessage() is invoked.
+        ProcessMessage(msg);
+        if (msg.GetDestinationCallbackId().UnderlyingValue() != static_cast<uint8_t>(BuiltinCallback::ACK)) {
+          std::string sender_id(msg.GetRoutingId());
+          bool first_time = UpdateMessagesSeen(sender_id, msg.GetMessageId());
+          if (!first_time) {
+            continue;
+          }
+          if (has_custom_serverloop) {
+            auto &server_callback = poll_items.server_callbacks_[i];
+            (*server_callback)(common::ManagedPointer(this), msg);
+          }
         }
       }
 
@@ -660,9 +837,21 @@ void Messenger::ProcessMessage(const ZmqMessage &msg) {
     }
     case static_cast<uint8_t>(BuiltinCallback::ACK): {
       std::unique_lock lock(pending_messages_mutex_);
-      message_id_t msg_id = msg.GetMessageId();
-      if (pending_messages_.find(msg_id) != pending_messages_.end()) {
-        pending_messages_.erase(msg_id);
+      auto it = pending_messages_.find(msg.GetMessageId());
+      if (it != pending_messages_.end()) {
+        const PendingMessage &pending = it->second;
+        DestinationState &destination = destinations_[pending.destination_id_];
+        // Karn's algorithm: only a message that was sent exactly once gives an unambiguous round-trip time sample.
+        if (pending.num_sends_ == 1) {
+          UpdateRoundTripTime(&destination, std::chrono::duration_cast<std::chrono::microseconds>(
+                                                std::chrono::steady_clock::now() - pending.first_send_time_));
+        }
+        if (pending.num_sends_ > 0) {
+          destination.num_in_flight_--;
+        }
+        destination.num_pending_--;
+        pending_messages_.erase(it);
+        pending_messages_cvar_.notify_all();
       }
       // Otherwise, assume this ACK is a retransmission and that it can be safely dropped.
       break;
@@ -692,10 +881,9 @@ void Messenger::ServerLoop() {
 
     ServerLoopAddRouters();
     ServerLoopMakeConnections();
-    // TODO(WAN): For higher performance in the future, Send and Recv should be fused into the same zmq socket poll.
-    //            Right now, messages are only sent every MESSENGER_POLL_TIMER instead of being sent whenever available.
-    ServerLoopSendMessages();
-    ServerLoopRecvAndProcessMessages();
+    // Poll only until the next retransmission is due. New messages to be sent wake the poll up early.
+    std::chrono::milliseconds timeout = ServerLoopSendMessages();
+    ServerLoopRecvAndProcessMessages(timeout);
   }
 }
 
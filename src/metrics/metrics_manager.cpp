@@ -1,9 +1,6 @@
 #include "metrics/metrics_manager.h"
 
-#include <sys/stat.h>
-
 #include <algorithm>
-#include <fstream>
 #include <memory>
 #include <random>
 #include <string>
@@ -14,29 +11,21 @@
 
 namespace noisepage::metrics {
 
-bool FileExists(const std::string &path) {
-  struct stat buffer;
-  return (stat(path.c_str(), &buffer) == 0);
-}
-
 template <typename abstract_raw_data>
-void OpenFiles(std::vector<std::ofstream> *outfiles) {
+void OpenWriters(MetricsSink *const sink, std::vector<MetricsRowWriter *> *writers) {
   const auto num_files = abstract_raw_data::FILES.size();
-  outfiles->reserve(num_files);
+  writers->reserve(num_files);
   for (size_t file = 0; file < num_files; file++) {
-    const auto file_name = std::string(abstract_raw_data::FILES[file]);
-    const auto file_existed = FileExists(file_name);
-    outfiles->emplace_back(file_name, std::ios_base::out | std::ios_base::app);
-    if (!file_existed) {
-      // write the column titles on the first line since we're creating a new csv file
-      if (!abstract_raw_data::FEATURE_COLUMNS[file].empty())
-        outfiles->back() << abstract_raw_data::FEATURE_COLUMNS[file] << ", ";
-      outfiles->back() << common::ResourceTracker::Metrics::COLUMNS << std::endl;
+    std::string columns;
+    if (!abstract_raw_data::FEATURE_COLUMNS[file].empty()) {
+      columns.append(abstract_raw_data::FEATURE_COLUMNS[file]).append(", ");
     }
+    columns.append(common::ResourceTracker::Metrics::COLUMNS);
+    writers->emplace_back(sink->GetWriter(abstract_raw_data::FILES[file], columns));
   }
 }
 
-MetricsManager::MetricsManager() {
+MetricsManager::MetricsManager(std::unique_ptr<MetricsSink> sink) : sink_(std::move(sink)) {
   // construct a bitset of all true (sampling rate 100) by default
   std::vector<bool> samples_mask(100, true);
   for (uint8_t i = 0; i < NUM_COMPONENTS; i++) {
@@ -121,6 +110,11 @@ void MetricsManager::ResetMetric(const MetricsComponent component) const {
         metric->Swap();
         break;
       }
+      case MetricsComponent::REPLICATION: {
+        const auto &metric = metrics_store.second->replication_metric_;
+        metric->Swap();
+        break;
+      }
     }
   }
 }
@@ -147,51 +141,60 @@ void MetricsManager::UnregisterThread() {
   common::thread_context.metrics_store_ = nullptr;
 }
 
-void MetricsManager::ToCSV() const {
+void MetricsManager::Dump() const {
   common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  LatencyHistograms latency_histograms;
   for (uint8_t component = 0; component < NUM_COMPONENTS; component++) {
     if (enabled_metrics_.test(component) && aggregated_metrics_[component] != nullptr) {
-      std::vector<std::ofstream> outfiles;
+      std::vector<MetricsRowWriter *> writers;
       switch (static_cast<MetricsComponent>(component)) {
         case MetricsComponent::LOGGING: {
-          OpenFiles<LoggingMetricRawData>(&outfiles);
+          OpenWriters<LoggingMetricRawData>(sink_.get(), &writers);
           break;
         }
         case MetricsComponent::TRANSACTION: {
-          OpenFiles<TransactionMetricRawData>(&outfiles);
+          OpenWriters<TransactionMetricRawData>(sink_.get(), &writers);
           break;
         }
         case MetricsComponent::GARBAGECOLLECTION: {
-          OpenFiles<GarbageCollectionMetricRawData>(&outfiles);
+          OpenWriters<GarbageCollectionMetricRawData>(sink_.get(), &writers);
           break;
         }
         case MetricsComponent::EXECUTION: {
-          OpenFiles<ExecutionMetricRawData>(&outfiles);
+          OpenWriters<ExecutionMetricRawData>(sink_.get(), &writers);
           break;
         }
         case MetricsComponent::EXECUTION_PIPELINE: {
-          OpenFiles<PipelineMetricRawData>(&outfiles);
+          OpenWriters<PipelineMetricRawData>(sink_.get(), &writers);
           break;
         }
         case MetricsComponent::BIND_COMMAND: {
-          OpenFiles<BindCommandMetricRawData>(&outfiles);
+          OpenWriters<BindCommandMetricRawData>(sink_.get(), &writers);
           break;
         }
         case MetricsComponent::EXECUTE_COMMAND: {
-          OpenFiles<ExecuteCommandMetricRawData>(&outfiles);
+          OpenWriters<ExecuteCommandMetricRawData>(sink_.get(), &writers);
           break;
         }
         case MetricsComponent::QUERY_TRACE: {
-          OpenFiles<QueryTraceMetricRawData>(&outfiles);
+          OpenWriters<QueryTraceMetricRawData>(sink_.get(), &writers);
+          break;
+        }
+        case MetricsComponent::REPLICATION: {
+          OpenWriters<ReplicationMetricRawData>(sink_.get(), &writers);
           break;
         }
       }
-      aggregated_metrics_[component]->ToCSV(&outfiles);
-      for (auto &file : outfiles) {
-        file.close();
-      }
+      aggregated_metrics_[component]->TakeLatencyHistograms(&latency_histograms);
+      aggregated_metrics_[component]->Write(writers);
     }
   }
+  if (!latency_histograms.Empty()) {
+    latency_histograms.Write(sink_->GetWriter(LatencyHistograms::FILE, LatencyHistograms::COLUMNS));
+    std::lock_guard histograms_guard(latency_histograms_mutex_);
+    latency_histograms_.Merge(latency_histograms);
+  }
+  sink_->Flush();
 }
 
 }  // namespace noisepage::metrics
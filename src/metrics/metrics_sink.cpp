@@ -0,0 +1,203 @@
+#include "metrics/metrics_sink.h"
+
+#include <sys/stat.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/error/error_code.h"
+#include "common/error/exception.h"
+#include "common/macros.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage::metrics {
+
+namespace {
+
+bool FileExists(const std::string &path) {
+  struct stat buffer;
+  return (stat(path.c_str(), &buffer) == 0);
+}
+
+}  // namespace
+
+std::unique_ptr<MetricsSink> MetricsSink::Create(const std::string_view type, const uint32_t ring_buffer_rows) {
+  if (type == "csv") return std::make_unique<CsvMetricsSink>();
+  if (type == "binary") return std::make_unique<BinaryMetricsSink>();
+  if (type == "ring_buffer") return std::make_unique<RingBufferMetricsSink>(ring_buffer_rows);
+  throw SETTINGS_EXCEPTION(fmt::format("Unknown metrics sink \"{}\", expected csv, binary or ring_buffer", type),
+                           common::ErrorCode::ERRCODE_INVALID_PARAMETER_VALUE);
+}
+
+/** Writes the fields of a row as text separated by ", ". */
+class CsvMetricsSink::Writer : public MetricsRowWriter {
+ public:
+  Writer(const std::string &file_name, const std::string_view columns) {
+    const auto file_existed = FileExists(file_name);
+    outfile_.open(file_name, std::ios_base::out | std::ios_base::app);
+    // write the column titles on the first line since we're creating a new csv file
+    if (!file_existed) outfile_ << columns << std::endl;
+  }
+
+  void EndRow() override {
+    outfile_ << '\n';
+    first_field_ = true;
+  }
+
+  void Flush() { outfile_.flush(); }
+
+ protected:
+  void WriteInt(const int64_t value) override { Separate() << value; }
+  void WriteUInt(const uint64_t value) override { Separate() << value; }
+  void WriteDouble(const double value) override { Separate() << value; }
+  void WriteString(const std::string_view value) override { Separate() << value; }
+
+ private:
+  std::ofstream &Separate() {
+    if (!first_field_) outfile_ << ", ";
+    first_field_ = false;
+    return outfile_;
+  }
+
+  std::ofstream outfile_;
+  bool first_field_ = true;
+};
+
+CsvMetricsSink::CsvMetricsSink() = default;
+
+CsvMetricsSink::~CsvMetricsSink() = default;
+
+MetricsRowWriter *CsvMetricsSink::GetWriter(const std::string_view output, const std::string_view columns) {
+  auto &writer = writers_[std::string(output)];
+  if (writer == nullptr) writer = std::make_unique<Writer>(std::string(output), columns);
+  return writer.get();
+}
+
+void CsvMetricsSink::Flush() {
+  for (auto &writer : writers_) writer.second->Flush();
+}
+
+/** Encodes the fields of a row into a buffer, and writes the buffer behind its length at the end of the row. */
+class BinaryMetricsSink::Writer : public MetricsRowWriter {
+ public:
+  Writer(const std::string &file_name, const std::string_view columns) {
+    const auto file_existed = FileExists(file_name);
+    outfile_.open(file_name, std::ios_base::out | std::ios_base::app | std::ios_base::binary);
+    if (!file_existed) {
+      outfile_ << MAGIC;
+      const auto length = static_cast<uint32_t>(columns.size());
+      outfile_.write(reinterpret_cast<const char *>(&length), sizeof(length));
+      outfile_ << columns;
+    }
+  }
+
+  void EndRow() override {
+    const auto length = static_cast<uint32_t>(row_.size());
+    outfile_.write(reinterpret_cast<const char *>(&length), sizeof(length));
+    outfile_.write(row_.data(), static_cast<std::streamsize>(row_.size()));
+    row_.clear();
+  }
+
+  void Flush() { outfile_.flush(); }
+
+ protected:
+  void WriteInt(const int64_t value) override { Append(FieldTag::INT, &value, sizeof(value)); }
+  void WriteUInt(const uint64_t value) override { Append(FieldTag::UINT, &value, sizeof(value)); }
+  void WriteDouble(const double value) override { Append(FieldTag::DOUBLE, &value, sizeof(value)); }
+  void WriteString(const std::string_view value) override {
+    const auto length = static_cast<uint32_t>(value.size());
+    Append(FieldTag::STRING, &length, sizeof(length));
+    row_.append(value);
+  }
+
+ private:
+  void Append(const FieldTag tag, const void *const value, const size_t size) {
+    row_.push_back(static_cast<char>(tag));
+    row_.append(reinterpret_cast<const char *>(value), size);
+  }
+
+  std::ofstream outfile_;
+  // The encoded fields of the current row, kept across rows to reuse its memory
+  std::string row_;
+};
+
+std::string BinaryMetricsSink::FilePath(const std::string_view output) {
+  std::string path(output);
+  const auto extension = path.rfind(".csv");
+  if (extension != std::string::npos && extension == path.size() - 4) path.erase(extension);
+  return path + ".bin";
+}
+
+BinaryMetricsSink::BinaryMetricsSink() = default;
+
+BinaryMetricsSink::~BinaryMetricsSink() = default;
+
+MetricsRowWriter *BinaryMetricsSink::GetWriter(const std::string_view output, const std::string_view columns) {
+  auto &writer = writers_[std::string(output)];
+  if (writer == nullptr) writer = std::make_unique<Writer>(FilePath(output), columns);
+  return writer.get();
+}
+
+void BinaryMetricsSink::Flush() {
+  for (auto &writer : writers_) writer.second->Flush();
+}
+
+/** Collects the fields of a row, and hands the row to the sink at the end of it. */
+class RingBufferMetricsSink::Writer : public MetricsRowWriter {
+ public:
+  Writer(RingBufferMetricsSink *const sink, Output *const output) : sink_(sink), output_(output) {}
+
+  void EndRow() override {
+    sink_->Append(output_, std::move(row_));
+    row_ = MetricsRow();
+  }
+
+ protected:
+  void WriteInt(const int64_t value) override { row_.emplace_back(value); }
+  void WriteUInt(const uint64_t value) override { row_.emplace_back(value); }
+  void WriteDouble(const double value) override { row_.emplace_back(value); }
+  void WriteString(const std::string_view value) override { row_.emplace_back(std::string(value)); }
+
+ private:
+  RingBufferMetricsSink *const sink_;
+  Output *const output_;
+  MetricsRow row_;
+};
+
+RingBufferMetricsSink::RingBufferMetricsSink(const uint32_t capacity) : capacity_(capacity) {}
+
+RingBufferMetricsSink::~RingBufferMetricsSink() = default;
+
+MetricsRowWriter *RingBufferMetricsSink::GetWriter(const std::string_view output, const std::string_view columns) {
+  auto &writer = writers_[std::string(output)];
+  if (writer == nullptr) {
+    std::lock_guard guard(outputs_mutex_);
+    auto &buffer = outputs_[std::string(output)];
+    buffer.columns_ = columns;
+    writer = std::make_unique<Writer>(this, &buffer);
+  }
+  return writer.get();
+}
+
+void RingBufferMetricsSink::Append(Output *const output, MetricsRow &&row) {
+  std::lock_guard guard(outputs_mutex_);
+  if (output->rows_.size() == capacity_) output->rows_.pop_front();
+  output->rows_.emplace_back(std::move(row));
+}
+
+std::vector<MetricsRow> RingBufferMetricsSink::GetRows(const std::string_view output) const {
+  std::lock_guard guard(outputs_mutex_);
+  const auto it = outputs_.find(std::string(output));
+  if (it == outputs_.end()) return {};
+  return {it->second.rows_.cbegin(), it->second.rows_.cend()};
+}
+
+std::string RingBufferMetricsSink::GetColumns(const std::string_view output) const {
+  std::lock_guard guard(outputs_mutex_);
+  const auto it = outputs_.find(std::string(output));
+  return it == outputs_.end() ? std::string() : it->second.columns_;
+}
+
+}  // namespace noisepage::metrics
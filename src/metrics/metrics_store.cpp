@@ -21,6 +21,7 @@ MetricsStore::MetricsStore(const common::ManagedPointer<metrics::MetricsManager>
   bind_command_metric_ = std::make_unique<BindCommandMetric>();
   execute_command_metric_ = std::make_unique<ExecuteCommandMetric>();
   query_trace_metric_ = std::make_unique<QueryTraceMetric>();
+  replication_metric_ = std::make_unique<ReplicationMetric>();
 }
 
 std::array<std::unique_ptr<AbstractRawData>, NUM_COMPONENTS> MetricsStore::GetDataToAggregate() {
@@ -85,6 +86,13 @@ std::array<std::unique_ptr<AbstractRawData>, NUM_COMPONENTS> MetricsStore::GetDa
           result[component] = query_trace_metric_->Swap();
           break;
         }
+        case MetricsComponent::REPLICATION: {
+          NOISEPAGE_ASSERT(
+              replication_metric_ != nullptr,
+              "ReplicationMetric cannot be a nullptr. Check the MetricsStore constructor that it was allocated.");
+          result[component] = replication_metric_->Swap();
+          break;
+        }
       }
     }
   }
@@ -1,6 +1,8 @@
 #include "network/connection_dispatcher_task.h"
 
 #include <csignal>
+#include <utility>
+#include <vector>
 
 #include "common/dedicated_thread_registry.h"
 #include "loggers/network_logger.h"
@@ -16,16 +18,20 @@ ConnectionDispatcherTask::ConnectionDispatcherTask(
     uint32_t num_handlers, common::DedicatedThreadOwner *dedicated_thread_owner,
     common::ManagedPointer<ProtocolInterpreterProvider> interpreter_provider,
     common::ManagedPointer<ConnectionHandleFactory> connection_handle_factory,
-    common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
-    std::initializer_list<int> file_descriptors)
+    common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry, const std::vector<int> &file_descriptors,
+    std::vector<int> handler_file_descriptors, common::ManagedPointer<common::WorkerPool> worker_pool)
     : NotifiableTask(MAIN_THREAD_ID),
       num_handlers_(num_handlers),
       dedicated_thread_owner_(dedicated_thread_owner),
       connection_handle_factory_(connection_handle_factory),
       thread_registry_(thread_registry),
       interpreter_provider_(interpreter_provider),
+      handler_file_descriptors_(std::move(handler_file_descriptors)),
+      worker_pool_(worker_pool),
       next_handler_(0) {
   NOISEPAGE_ASSERT(num_handlers_ > 0, "No workers that connections can be dispatched to.");
+  NOISEPAGE_ASSERT(handler_file_descriptors_.empty() || handler_file_descriptors_.size() == num_handlers_,
+                   "Either every handler or none of them listens on a file descriptor of its own.");
 
   // The libevent callback functions are defined here.
   // Note that libevent callback functions must have type (int fd, int16_t flags, void *arg) -> void.
@@ -76,9 +82,11 @@ void ConnectionDispatcherTask::DispatchConnection(uint32_t fd,
 void ConnectionDispatcherTask::RunTask() {
   // Create a pool of num_handlers_ many ConnectionHandlerTask instances.
   // The handler tasks are created using the same DedicatedThreadOwner as this ConnectionDispatcherTask.
+  // Handlers that were given file descriptors of their own accept the connections to them without the dispatcher.
   for (uint32_t task_id = 0; task_id < num_handlers_; task_id++) {
-    auto handler = thread_registry_->RegisterDedicatedThread<ConnectionHandlerTask>(dedicated_thread_owner_, task_id,
-                                                                                    connection_handle_factory_);
+    const int listen_fd = handler_file_descriptors_.empty() ? -1 : handler_file_descriptors_[task_id];
+    auto handler = thread_registry_->RegisterDedicatedThread<ConnectionHandlerTask>(
+        dedicated_thread_owner_, task_id, connection_handle_factory_, interpreter_provider_, worker_pool_, listen_fd);
     handlers_.push_back(handler);
   }
   // After all the connection handlers are ready, the main connection dispatch event loop is run.
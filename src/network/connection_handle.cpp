@@ -33,6 +33,7 @@ class ConnectionHandleStateMachineTransition {
       case Transition::NEED_READ:           return {ConnState::READ, TryRead};
       case Transition::NEED_READ_TIMEOUT:   return {ConnState::READ, WaitForReadWithTimeout};
       case Transition::NEED_RESULT:         return {ConnState::PROCESS, WaitForTerrier};
+      case Transition::NEED_DURABILITY:     return {ConnState::WAIT_DURABLE, WaitForTerrier};
       case Transition::PROCEED:             return {ConnState::WRITE, TryWrite};
       case Transition::TERMINATE:           return {ConnState::CLOSING, TryCloseConnection};
       case Transition::WAKEUP:              return {ConnState::PROCESS, GetResult};
@@ -53,6 +54,16 @@ class ConnectionHandleStateMachineTransition {
     }
   }
 
+  /** Implement transition for ConnState::WAIT_DURABLE. */
+  static ConnectionHandle::StateMachine::TransitionResult TransitionForWaitDurable(Transition transition) {
+    switch (transition) {
+      case Transition::TERMINATE:           return {ConnState::CLOSING, TryCloseConnection};
+      // The responses were written by the time the commits were deferred, so the connection carries on from there.
+      case Transition::WAKEUP:              return {ConnState::PROCESS, ResumeAfterCommitsDurable};
+      default:                              throw std::runtime_error("Undefined transition!");
+    }
+  }
+
   /** Implement transition for ConnState::CLOSING. */
   static ConnectionHandle::StateMachine::TransitionResult TransitionForClosing(Transition transition) {
     switch (transition) {
@@ -74,6 +85,7 @@ class ConnectionHandleStateMachineTransition {
 
   DEF_HANDLE_WRAPPER_FN(GetResult);
   DEF_HANDLE_WRAPPER_FN(Process);
+  DEF_HANDLE_WRAPPER_FN(ResumeAfterCommitsDurable);
   DEF_HANDLE_WRAPPER_FN(TryRead);
   DEF_HANDLE_WRAPPER_FN(TryWrite);
   DEF_HANDLE_WRAPPER_FN(TryCloseConnection);
@@ -114,6 +126,8 @@ ConnectionHandle::StateMachine::TransitionResult ConnectionHandle::StateMachine:
     case ConnState::PROCESS:   return ConnectionHandleStateMachineTransition::TransitionForProcess(transition);
     case ConnState::WRITE:     return ConnectionHandleStateMachineTransition::TransitionForWrite(transition);
     case ConnState::CLOSING:   return ConnectionHandleStateMachineTransition::TransitionForClosing(transition);
+    case ConnState::WAIT_DURABLE:
+      return ConnectionHandleStateMachineTransition::TransitionForWaitDurable(transition);
     default:                   throw std::runtime_error("Undefined transition!");
   }
   // clang-format on
@@ -169,7 +183,9 @@ void ConnectionHandle::HandleEvent(int fd, int16_t flags) {
   state_machine_.Accept(t, common::ManagedPointer<ConnectionHandle>(this));
 }
 
-Transition ConnectionHandle::TryRead() { return io_wrapper_->FillReadBuffer(); }
+Transition ConnectionHandle::TryRead() {
+  return io_wrapper_->FillReadBuffer(protocol_interpreter_->IncompleteExtendedPacket());
+}
 
 Transition ConnectionHandle::TryWrite() {
   if (io_wrapper_->ShouldFlush()) {
@@ -179,9 +195,29 @@ Transition ConnectionHandle::TryWrite() {
 }
 
 Transition ConnectionHandle::Process() {
-  auto transition = protocol_interpreter_->Process(io_wrapper_->GetReadBuffer(), io_wrapper_->GetWriteQueue(),
-                                                   traffic_cop_, common::ManagedPointer(&context_));
-  return transition;
+  // Commits made while the input is processed don't block the thread on their durability, see FinishProcessing()
+  context_.BeginProcessing();
+  if (!conn_handler_task_->HasWorkers()) {
+    return FinishProcessing(protocol_interpreter_->Process(io_wrapper_->GetReadBuffer(), io_wrapper_->GetWriteQueue(),
+                                                           traffic_cop_, common::ManagedPointer(&context_)));
+  }
+
+  // Hand the work off to a worker, so that the handler can serve its other connections in the meantime. The network
+  // event is removed until the work is done, so the buffers are left to the worker. The workpool event wakes the state
+  // machine up in GetResult() afterwards, with the transition that the work resulted in.
+  conn_handler_task_->HandOff(
+      [this] {
+        try {
+          process_result_ = protocol_interpreter_->Process(io_wrapper_->GetReadBuffer(), io_wrapper_->GetWriteQueue(),
+                                                           traffic_cop_, common::ManagedPointer(&context_));
+        } catch (const NetworkProcessException &e) {
+          // Same as in StateMachine::Accept.
+          NETWORK_LOG_ERROR("{0}\n", e.what());
+          process_result_ = Transition::TERMINATE;
+        }
+      },
+      workpool_event_);
+  return Transition::NEED_RESULT;
 }
 
 Transition ConnectionHandle::GetResult() {
@@ -189,10 +225,28 @@ Transition ConnectionHandle::GetResult() {
   EventUtil::EventAdd(network_event_, EventUtil::WAIT_FOREVER);
   // TODO(WAN): It is not clear to me what this function is doing. If someone figures it out, please update comment.
   protocol_interpreter_->GetResult(io_wrapper_->GetWriteQueue());
-  return Transition::PROCEED;
+  // Carry on from where the work that was handed off in Process() left the connection.
+  return FinishProcessing(process_result_);
+}
+
+Transition ConnectionHandle::FinishProcessing(const Transition result) {
+  if (context_.EndProcessing()) return result;
+  // The responses acknowledge commits that are not durable yet. They stay in the write queue, and the last commit to
+  // become durable wakes the connection up to go on with them through the workpool event.
+  process_result_ = result;
+  return Transition::NEED_DURABILITY;
+}
+
+Transition ConnectionHandle::ResumeAfterCommitsDurable() {
+  EventUtil::EventAdd(network_event_, EventUtil::WAIT_FOREVER);
+  return process_result_;
 }
 
 Transition ConnectionHandle::TryCloseConnection() {
+  // The callbacks of deferred commits refer to this connection. This only waits when the connection goes away in the
+  // middle of processing its input, e.g., because of an error.
+  context_.WaitForDeferredCommits();
+
   // Stop the protocol interpreter.
   protocol_interpreter_->Teardown(io_wrapper_->GetReadBuffer(), io_wrapper_->GetWriteQueue(), traffic_cop_,
                                   common::ManagedPointer(&context_));
@@ -234,10 +288,9 @@ void ConnectionHandle::UpdateEventFlags(int16_t flags, int timeout_secs) {
 void ConnectionHandle::StopReceivingNetworkEvent() { EventUtil::EventDel(network_event_); }
 
 void ConnectionHandle::Callback(void *callback_args) {
-  // TODO(WAN): this is currently unused.
+  // This runs on the thread that made the last deferred commit durable. The state machine may not have reached
+  // WAIT_DURABLE yet, but the activation is only handled on the handler's thread once it has.
   auto *const handle = reinterpret_cast<ConnectionHandle *>(callback_args);
-  NOISEPAGE_ASSERT(handle->state_machine_.CurrentState() == ConnState::PROCESS,
-                   "Should be waking up a ConnectionHandle that's in PROCESS state waiting on query result.");
   event_active(handle->workpool_event_, EV_WRITE, 0);
 }
 
@@ -251,8 +304,10 @@ void ConnectionHandle::ResetForReuse(connection_id_t connection_id, common::Mana
   state_machine_ = ConnectionHandle::StateMachine();
   network_event_ = nullptr;
   workpool_event_ = nullptr;
+  process_result_ = Transition::PROCEED;
   context_.Reset();
   context_.SetConnectionID(connection_id);
+  context_.SetCallback(Callback, this);
 }
 
 }  // namespace noisepage::network
@@ -1,12 +1,25 @@
 #include "network/connection_handler_task.h"
 
+#include <sys/socket.h>
+
+#include <cstring>
+#include <thread>  // NOLINT
+
+#include "common/worker_pool.h"
+#include "loggers/network_logger.h"
 #include "network/connection_handle_factory.h"
 
 namespace noisepage::network {
 
 ConnectionHandlerTask::ConnectionHandlerTask(const int task_id,
-                                             common::ManagedPointer<ConnectionHandleFactory> connection_handle_factory)
-    : NotifiableTask(task_id), connection_handle_factory_(connection_handle_factory) {
+                                             common::ManagedPointer<ConnectionHandleFactory> connection_handle_factory,
+                                             common::ManagedPointer<ProtocolInterpreterProvider> interpreter_provider,
+                                             common::ManagedPointer<common::WorkerPool> worker_pool,
+                                             const int listen_fd)
+    : NotifiableTask(task_id),
+      connection_handle_factory_(connection_handle_factory),
+      interpreter_provider_(interpreter_provider),
+      worker_pool_(worker_pool) {
   // This callback function just calls HandleDispatch().
   event_callback_fn handle_dispatch = [](int fd, int16_t flags, void *arg) {
     static_cast<ConnectionHandlerTask *>(arg)->HandleDispatch();
@@ -14,6 +27,20 @@ ConnectionHandlerTask::ConnectionHandlerTask(const int task_id,
 
   // Register an event that needs to be explicitly activated. When the event is handled, HandleDispatch() is called.
   notify_event_ = RegisterEvent(EventUtil::EVENT_ACTIVATE_OR_TIMEOUT_ONLY, EV_READ | EV_PERSIST, handle_dispatch, this);
+
+  if (listen_fd >= 0) {
+    // Accept a new connection every time the socket becomes readable again.
+    event_callback_fn handle_accept = [](int fd, int16_t flags, void *arg) {
+      static_cast<ConnectionHandlerTask *>(arg)->HandleAccept(fd);
+    };
+    RegisterEvent(listen_fd, EV_READ | EV_PERSIST, handle_accept, this);
+  }
+}
+
+void ConnectionHandlerTask::RunTask() {
+  EventLoop();
+  // A worker that is done activates an event of this task, so the events must not go away before the workers are done.
+  while (num_handed_off_.load() > 0) std::this_thread::yield();
 }
 
 void ConnectionHandlerTask::Notify(int conn_fd, std::unique_ptr<ProtocolInterpreter> protocol_interpreter) {
@@ -39,4 +66,31 @@ void ConnectionHandlerTask::HandleDispatch() {
   jobs_.clear();
 }
 
+void ConnectionHandlerTask::HandOff(std::function<void()> work, struct event *const done_event) {
+  NOISEPAGE_ASSERT(HasWorkers(), "There are no workers to hand the work off to.");
+  num_handed_off_++;
+  worker_pool_->SubmitTask([this, work = std::move(work), done_event] {
+    work();
+    event_active(done_event, EV_WRITE, 0);
+    // This must be the last access to the task, since it may go away as soon as there is no work left.
+    num_handed_off_--;
+  });
+}
+
+void ConnectionHandlerTask::HandleAccept(const int listen_fd) {
+  // Addr and addrlen are unused, as in the dispatcher.
+  struct sockaddr_storage addr;
+  socklen_t addrlen = sizeof(addr);
+  const int conn_fd = accept(listen_fd, reinterpret_cast<struct sockaddr *>(&addr), &addrlen);
+  if (conn_fd == -1) {
+    NETWORK_LOG_ERROR("Failed to accept a new connection: {}", strerror(errno));
+    return;
+  }
+
+  // The connection is handled right here, there is no dispatcher to wake this task up for it.
+  auto task = common::ManagedPointer<ConnectionHandlerTask>(this);
+  auto &handle = connection_handle_factory_->NewConnectionHandle(conn_fd, interpreter_provider_->Get(), task);
+  handle.RegisterToReceiveEvents();
+}
+
 }  // namespace noisepage::network
@@ -2,8 +2,11 @@
 
 #include <fcntl.h>
 #include <netinet/tcp.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
+#include <array>
+
 #include "common/utility.h"
 #include "loggers/network_logger.h"
 #include "network/network_io_utils.h"
@@ -18,10 +21,24 @@ NetworkIoWrapper::NetworkIoWrapper(const int sock_fd)
 }
 
 Transition NetworkIoWrapper::FlushAllWrites() {
-  for (auto flush_head = out_->FlushHead(); flush_head != nullptr; out_->MarkHeadFlushed()) {
-    const auto result = FlushWriteBuffer(flush_head);
-    if (result != Transition::PROCEED) return result;
-    flush_head = out_->FlushHead();
+  // Hand as many buffers as possible to each write, rather than making a system call per buffer
+  std::array<struct iovec, WRITE_QUEUE_MAX_IOVECS> iov;
+  for (auto num_iov = out_->GatherUnflushed(iov.data(), iov.size()); num_iov > 0;
+       num_iov = out_->GatherUnflushed(iov.data(), iov.size())) {
+    const auto bytes_written = writev(sock_fd_, iov.data(), static_cast<int>(num_iov));
+    if (bytes_written < 0) {
+      switch (errno) {
+        case EINTR:
+          continue;
+        case EAGAIN:
+          return Transition::NEED_WRITE;
+        case EPIPE:
+          return Transition::TERMINATE;
+        default:
+          throw NETWORK_PROCESS_EXCEPTION(fmt::format("Fatal error during write: {}", strerror(errno)));
+      }
+    }
+    out_->MarkFlushed(bytes_written);
   }
   out_->Reset();
   return Transition::PROCEED;
@@ -34,17 +51,23 @@ Transition NetworkIoWrapper::Close() {
 
 void NetworkIoWrapper::Restart() { RestartState(); }
 
-Transition NetworkIoWrapper::FillReadBuffer() {
+Transition NetworkIoWrapper::FillReadBuffer(const common::ManagedPointer<ReadBuffer> packet_buf) {
   if (!in_->HasMore()) in_->Reset();
+  // A packet that is larger than the read buffer has a buffer of its own. Once everything that was read is in there,
+  // read the rest of the packet into that buffer directly, instead of into the read buffer to be copied over.
+  if (packet_buf != nullptr && !in_->HasMore()) return FillBufferFrom(packet_buf);
   // If the read buffer still has content and the read buffer is full,
   // then the read buffer's contents is moved to the head.
   if (in_->HasMore() && in_->Full()) in_->MoveContentToHead();
+  return FillBufferFrom(common::ManagedPointer(in_));
+}
 
+Transition NetworkIoWrapper::FillBufferFrom(const common::ManagedPointer<ReadBuffer> buf) {
   // By default, the next action to take is to continue to read.
   Transition result = Transition::NEED_READ;
   // While the read buffer is not yet full,
-  while (!in_->Full()) {
-    auto bytes_read = in_->FillBufferFrom(sock_fd_);
+  while (!buf->Full()) {
+    auto bytes_read = buf->FillBufferFrom(sock_fd_);
 
     if (bytes_read > 0) {
       // If bytes were read, then the bytes can be processed.
@@ -69,26 +92,6 @@ Transition NetworkIoWrapper::FillReadBuffer() {
 
 bool NetworkIoWrapper::ShouldFlush() { return out_->ShouldFlush(); }
 
-Transition NetworkIoWrapper::FlushWriteBuffer(const common::ManagedPointer<WriteBuffer> wbuf) {
-  while (wbuf->HasMore()) {
-    auto bytes_written = wbuf->WriteOutTo(sock_fd_);
-    if (bytes_written < 0) {
-      switch (errno) {
-        case EINTR:
-          continue;
-        case EAGAIN:
-          return Transition::NEED_WRITE;
-        case EPIPE:
-          return Transition::TERMINATE;
-        default:
-          throw NETWORK_PROCESS_EXCEPTION(fmt::format("Fatal error during write: {}", strerror(errno)));
-      }
-    }
-  }
-  wbuf->Reset();
-  return Transition::PROCEED;
-}
-
 void NetworkIoWrapper::RestartState() {
   int err;          // For C-style error codes.
   int enabled = 1;  // For setting socket options.
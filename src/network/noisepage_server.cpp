@@ -4,6 +4,7 @@
 #include <sys/un.h>
 
 #include <csignal>
+#include <vector>
 
 #include "common/dedicated_thread_registry.h"
 #include "common/settings.h"
@@ -17,12 +18,17 @@ namespace noisepage::network {
 TerrierServer::TerrierServer(common::ManagedPointer<ProtocolInterpreterProvider> protocol_provider,
                              common::ManagedPointer<ConnectionHandleFactory> connection_handle_factory,
                              common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
-                             const uint16_t port, const uint16_t connection_thread_count, std::string socket_directory)
+                             const uint16_t port, const uint16_t connection_thread_count, std::string socket_directory,
+                             const uint16_t worker_thread_count, const bool reuse_port)
     : DedicatedThreadOwner(thread_registry),
       running_(false),
       port_(port),
       socket_directory_(std::move(socket_directory)),
       max_connections_(connection_thread_count),
+      reuse_port_(reuse_port),
+      worker_pool_(worker_thread_count == 0 ? nullptr
+                                            : std::make_unique<common::WorkerPool>(worker_thread_count,
+                                                                                   common::TaskQueue{})),
       connection_handle_factory_(connection_handle_factory),
       provider_(protocol_provider) {
   // If a client disconnects, the server receives a broken pipe signal SIGPIPE.
@@ -36,15 +42,13 @@ TerrierServer::TerrierServer(common::ManagedPointer<ProtocolInterpreterProvider>
 }
 
 template <TerrierServer::SocketType type>
-void TerrierServer::RegisterSocket() {
+int TerrierServer::RegisterSocket() {
   static_assert(type == NETWORKED_SOCKET || type == UNIX_DOMAIN_SOCKET, "There should only be two socket types.");
 
   constexpr auto conn_backlog = common::Settings::CONNECTION_BACKLOG;
   constexpr auto is_networked_socket = type == NETWORKED_SOCKET;
   constexpr auto socket_description = std::string_view(is_networked_socket ? "networked" : "Unix domain");
 
-  auto &socket_fd = is_networked_socket ? network_socket_fd_ : unix_domain_socket_fd_;
-
   // Get the appropriate sockaddr for the given SocketType. Abuse a lambda and auto to specialize the type.
   auto socket_addr = ([&] {
     if constexpr (is_networked_socket) {  // NOLINT
@@ -75,7 +79,7 @@ void TerrierServer::RegisterSocket() {
   })();
 
   // Create a new socket.
-  socket_fd = socket(is_networked_socket ? AF_INET : AF_UNIX, SOCK_STREAM, 0);
+  const int socket_fd = socket(is_networked_socket ? AF_INET : AF_UNIX, SOCK_STREAM, 0);
 
   // Check if the socket was successfully created.
   if (socket_fd < 0) {
@@ -90,9 +94,16 @@ void TerrierServer::RegisterSocket() {
   // time (2 * /proc/sys/net/ipv4/tcp_fin_timeout seconds). This means that when a new server
   // comes along and tries to rebind to the same (IP address, TCP port), the socket binding
   // will fail. Enabling SO_REUSEADDR opts out of this protection.
+  //
+  // Enable SO_REUSEPORT as well if every connection handler listens on its own networked socket. Any number of sockets
+  // can then be bound to the port, and the kernel spreads the incoming connections over them.
   if constexpr (is_networked_socket) {  // NOLINT
     int reuse = 1;
     setsockopt(socket_fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+    if (reuse_port_ && setsockopt(socket_fd, SOL_SOCKET, SO_REUSEPORT, &reuse, sizeof(reuse)) < 0) {
+      throw NETWORK_PROCESS_EXCEPTION(
+          fmt::format("Failed to enable SO_REUSEPORT on {} socket: {}", socket_description, strerror(errno)));
+    }
   }
 
   // Bind the socket.
@@ -130,22 +141,38 @@ void TerrierServer::RegisterSocket() {
   }
 
   NETWORK_LOG_INFO("Listening on {} socket with port {} [PID={}]", socket_description, port_, ::getpid());
+  return socket_fd;
 }
 
 void TerrierServer::RunServer() {
   // Initialize thread support for libevent as libevent will be invoked from multiple ConnectionHandlerTask threads.
   evthread_use_pthreads();
 
+  // Start the workers before any connection can hand a query off to them.
+  if (worker_pool_ != nullptr) worker_pool_->Startup();
+
   // Register the network socket.
-  RegisterSocket<NETWORKED_SOCKET>();
+  network_socket_fd_ = RegisterSocket<NETWORKED_SOCKET>();
 
   // Register the Unix domain socket.
-  RegisterSocket<UNIX_DOMAIN_SOCKET>();
+  unix_domain_socket_fd_ = RegisterSocket<UNIX_DOMAIN_SOCKET>();
+
+  // With SO_REUSEPORT, every connection handler accepts the connections to a networked socket of its own, which saves
+  // the hop through the dispatcher. The dispatcher is then left with the Unix domain socket.
+  std::vector<int> dispatcher_socket_fds{unix_domain_socket_fd_};
+  if (reuse_port_) {
+    handler_socket_fds_.emplace_back(network_socket_fd_);
+    while (handler_socket_fds_.size() < max_connections_) {
+      handler_socket_fds_.emplace_back(RegisterSocket<NETWORKED_SOCKET>());
+    }
+  } else {
+    dispatcher_socket_fds.emplace_back(network_socket_fd_);
+  }
 
   // Register the ConnectionDispatcherTask. This handles connections to the sockets created above.
   dispatcher_task_ = thread_registry_->RegisterDedicatedThread<ConnectionDispatcherTask>(
       this, max_connections_, this, common::ManagedPointer(provider_.Get()), connection_handle_factory_,
-      thread_registry_, std::initializer_list<int>({unix_domain_socket_fd_, network_socket_fd_}));
+      thread_registry_, dispatcher_socket_fds, handler_socket_fds_, common::ManagedPointer(worker_pool_));
 
   // Set the running_ flag for any waiting threads.
   {
@@ -160,8 +187,16 @@ void TerrierServer::StopServer() {
       thread_registry_->StopTask(this, dispatcher_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
   NOISEPAGE_ASSERT(is_task_stopped, "Failed to stop ConnectionDispatcherTask.");
 
-  // Close the network socket
-  TerrierClose(network_socket_fd_);
+  // The connection handlers waited for the queries that they handed off, so nothing is left for the workers.
+  if (worker_pool_ != nullptr) worker_pool_->Shutdown();
+
+  // Close the network sockets
+  if (handler_socket_fds_.empty()) {
+    TerrierClose(network_socket_fd_);
+  } else {
+    for (const int socket_fd : handler_socket_fds_) TerrierClose(socket_fd);
+    handler_socket_fds_.clear();
+  }
 
   // Close the Unix domain socket if it exists
   if (unix_domain_socket_fd_ >= 0) {
@@ -0,0 +1,548 @@
+#include "network/postgres/copy_in_reader.h"
+
+#include <endian.h>
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+#include "common/error/exception.h"
+#include "execution/sql/runtime_types.h"
+#include "network/postgres/postgres_defs.h"
+#include "spdlog/fmt/fmt.h"
+#include "storage/block_layout.h"
+#include "storage/storage_util.h"
+#include "type/type_util.h"
+
+namespace noisepage::network {
+
+namespace {
+
+template <typename T>
+void StoreFixed(const T value, uint64_t *const fixed) {
+  static_assert(sizeof(T) <= sizeof(uint64_t), "Fixed length values have to fit in a word.");
+  std::memcpy(fixed, &value, sizeof(T));
+}
+
+// Binary COPY data is in network byte order
+int16_t ReadInt16(const char *const data) {
+  uint16_t raw;
+  std::memcpy(&raw, data, sizeof(raw));
+  return static_cast<int16_t>(be16toh(raw));
+}
+
+int32_t ReadInt32(const char *const data) {
+  uint32_t raw;
+  std::memcpy(&raw, data, sizeof(raw));
+  return static_cast<int32_t>(be32toh(raw));
+}
+
+int64_t ReadInt64(const char *const data) {
+  uint64_t raw;
+  std::memcpy(&raw, data, sizeof(raw));
+  return static_cast<int64_t>(be64toh(raw));
+}
+
+std::string_view Trim(std::string_view text) {
+  while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front())) != 0) text.remove_prefix(1);
+  while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back())) != 0) text.remove_suffix(1);
+  return text;
+}
+
+int HexDigit(const char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+}  // namespace
+
+CopyInReader::CopyInReader(std::string table_name, std::unique_ptr<storage::BulkLoader> loader,
+                           std::vector<Column> columns, const parser::ExternalFileFormat format, const char delimiter,
+                           const char quote, const char escape)
+    : table_name_(std::move(table_name)),
+      loader_(std::move(loader)),
+      columns_(std::move(columns)),
+      format_(format),
+      delimiter_(delimiter),
+      quote_(quote),
+      escape_(escape),
+      values_(columns_.size()) {}
+
+bool CopyInReader::Feed(const std::string_view data) {
+  if (error_.has_value()) return false;
+  // Postgres ignores whatever follows the end of the data
+  if (done_) return true;
+  pending_.append(data);
+  switch (format_) {
+    case parser::ExternalFileFormat::TEXT:
+      return ReadTextRows(false);
+    case parser::ExternalFileFormat::CSV:
+      return ReadCsvRows(false);
+    case parser::ExternalFileFormat::BINARY:
+      return ReadBinaryRows();
+  }
+  return true;
+}
+
+bool CopyInReader::Finish() {
+  if (error_.has_value()) return false;
+  if (!done_) {
+    switch (format_) {
+      case parser::ExternalFileFormat::TEXT:
+        if (!ReadTextRows(true)) return false;
+        break;
+      case parser::ExternalFileFormat::CSV:
+        if (!ReadCsvRows(true)) return false;
+        break;
+      case parser::ExternalFileFormat::BINARY:
+        // The binary format has a trailer, so data without one was cut off
+        if (!ReadBinaryRows()) return false;
+        if (!done_) return Fail(common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT, "unexpected EOF in COPY data");
+        break;
+    }
+  }
+  loader_->Flush();
+  return true;
+}
+
+bool CopyInReader::ReadTextRows(const bool at_end) {
+  std::vector<std::optional<std::string>> fields;
+  std::size_t pos = 0;
+  while (!done_ && pos < pending_.size()) {
+    std::size_t end = pending_.find('\n', pos);
+    if (end == std::string::npos) {
+      // The last row may come without a newline, but only the end of the data says that it is complete
+      if (!at_end) break;
+      end = pending_.size();
+    }
+    std::string_view line(pending_.data() + pos, end - pos);
+    pos = std::min(end + 1, pending_.size());
+    line_++;
+    if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+    if (line == "\\.") {
+      done_ = true;
+      break;
+    }
+    if (!SplitTextLine(line, &fields) || !InsertTextRow(fields)) return false;
+  }
+  pending_.erase(0, pos);
+  return true;
+}
+
+bool CopyInReader::SplitTextLine(const std::string_view line, std::vector<std::optional<std::string>> *const fields) {
+  fields->clear();
+  std::string field;
+  // Whether the field so far is \N, which is NULL if nothing follows it
+  bool null = false;
+  const auto append = [&](const char c) {
+    if (null) field.push_back('N');
+    null = false;
+    field.push_back(c);
+  };
+
+  for (std::size_t i = 0; i < line.size(); i++) {
+    const char c = line[i];
+    if (c == delimiter_) {
+      fields->emplace_back(null ? std::nullopt : std::make_optional(std::move(field)));
+      field.clear();
+      null = false;
+      continue;
+    }
+    if (c != '\\' || i + 1 == line.size()) {
+      append(c);
+      continue;
+    }
+
+    const char escaped = line[++i];
+    switch (escaped) {
+      case 'N':
+        if (field.empty() && !null) {
+          null = true;
+        } else {
+          append('N');
+        }
+        break;
+      case 'b':
+        append('\b');
+        break;
+      case 'f':
+        append('\f');
+        break;
+      case 'n':
+        append('\n');
+        break;
+      case 'r':
+        append('\r');
+        break;
+      case 't':
+        append('\t');
+        break;
+      case 'v':
+        append('\v');
+        break;
+      case 'x': {
+        // One or two hex digits
+        int value = 0;
+        int digits = 0;
+        while (digits < 2 && i + 1 < line.size() && HexDigit(line[i + 1]) >= 0) {
+          value = value * 16 + HexDigit(line[++i]);
+          digits++;
+        }
+        append(digits > 0 ? static_cast<char>(value) : 'x');
+        break;
+      }
+      default:
+        if (escaped >= '0' && escaped <= '7') {
+          // One to three octal digits
+          int value = escaped - '0';
+          for (int digits = 1; digits < 3 && i + 1 < line.size() && line[i + 1] >= '0' && line[i + 1] <= '7';
+               digits++) {
+            value = value * 8 + (line[++i] - '0');
+          }
+          append(static_cast<char>(value));
+        } else {
+          append(escaped);
+        }
+        break;
+    }
+  }
+  fields->emplace_back(null ? std::nullopt : std::make_optional(std::move(field)));
+  return true;
+}
+
+bool CopyInReader::ReadCsvRows(const bool at_end) {
+  std::vector<std::optional<std::string>> fields;
+  std::size_t pos = 0;
+  while (!done_ && pos < pending_.size()) {
+    fields.clear();
+    std::string field;
+    bool quoted = false;
+    bool in_quotes = false;
+    bool complete = false;
+    std::size_t i = pos;
+    for (; i < pending_.size(); i++) {
+      const char c = pending_[i];
+      if (in_quotes) {
+        if (c == quote_ || c == escape_) {
+          // Whether the quote ends the value or is escaped depends on the character after it
+          if (i + 1 == pending_.size() && !at_end) break;
+          if (c == escape_ && i + 1 < pending_.size() && (pending_[i + 1] == quote_ || pending_[i + 1] == escape_)) {
+            field.push_back(pending_[++i]);
+            continue;
+          }
+          if (c == quote_) {
+            in_quotes = false;
+            continue;
+          }
+        }
+        field.push_back(c);
+      } else if (c == quote_) {
+        in_quotes = quoted = true;
+      } else if (c == delimiter_) {
+        // An unquoted empty value is NULL, a quoted one is an empty string
+        fields.emplace_back(field.empty() && !quoted ? std::nullopt : std::make_optional(std::move(field)));
+        field.clear();
+        quoted = false;
+      } else if (c == '\n') {
+        complete = true;
+        break;
+      } else {
+        field.push_back(c);
+      }
+    }
+
+    if (!complete) {
+      if (!at_end || i < pending_.size()) break;
+      if (in_quotes) {
+        line_++;
+        return Fail(common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT, "unterminated CSV quoted field");
+      }
+    }
+    pos = std::min(i + 1, pending_.size());
+    line_++;
+    if (!quoted && !field.empty() && field.back() == '\r') field.pop_back();
+    if (fields.empty() && !quoted && field == "\\.") {
+      done_ = true;
+      break;
+    }
+    fields.emplace_back(field.empty() && !quoted ? std::nullopt : std::make_optional(std::move(field)));
+    if (!InsertTextRow(fields)) return false;
+  }
+  pending_.erase(0, pos);
+  return true;
+}
+
+bool CopyInReader::InsertTextRow(const std::vector<std::optional<std::string>> &fields) {
+  if (fields.size() > columns_.size()) {
+    return Fail(common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT, "extra data after last expected column");
+  }
+  if (fields.size() < columns_.size()) {
+    return Fail(common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT,
+                fmt::format("missing data for column \"{}\"", columns_[fields.size()].name_));
+  }
+  for (uint16_t col = 0; col < columns_.size(); col++) {
+    values_[col].null_ = !fields[col].has_value();
+    if (fields[col].has_value() && !ConvertText(col, *fields[col], &values_[col])) return false;
+  }
+  return InsertRow();
+}
+
+bool CopyInReader::ReadBinaryRows() {
+  std::size_t pos = 0;
+  const auto available = [&](const std::size_t from, const std::size_t size) {
+    return pending_.size() >= from + size;
+  };
+
+  if (!read_header_) {
+    // The signature, the flags and the length of the header extension, which is skipped
+    static constexpr std::size_t header_size = POSTGRES_BINARY_COPY_SIGNATURE.size() + 2 * sizeof(int32_t);
+    if (!available(0, header_size)) return true;
+    if (std::string_view(pending_.data(), POSTGRES_BINARY_COPY_SIGNATURE.size()) != POSTGRES_BINARY_COPY_SIGNATURE) {
+      return Fail(common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT, "COPY file signature not recognized");
+    }
+    const int32_t flags = ReadInt32(pending_.data() + POSTGRES_BINARY_COPY_SIGNATURE.size());
+    if ((flags & (1 << 16)) != 0) {
+      return Fail(common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT, "COPY data with OIDs is not supported");
+    }
+    const int32_t extension_size = ReadInt32(pending_.data() + header_size - sizeof(int32_t));
+    if (extension_size < 0) {
+      return Fail(common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT, "invalid COPY file header (wrong length)");
+    }
+    if (!available(header_size, extension_size)) return true;
+    pos = header_size + extension_size;
+    read_header_ = true;
+  }
+
+  // Where the values of the tuple being read are, or -1 for NULL
+  std::vector<std::pair<std::size_t, int32_t>> fields(columns_.size());
+  while (!done_ && available(pos, sizeof(int16_t))) {
+    std::size_t next = pos;
+    const int16_t num_fields = ReadInt16(pending_.data() + next);
+    next += sizeof(int16_t);
+    if (num_fields == -1) {
+      done_ = true;
+      pos = next;
+      break;
+    }
+    if (num_fields != static_cast<int16_t>(columns_.size())) {
+      line_++;
+      return Fail(common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT,
+                  fmt::format("row field count is {}, expected {}", num_fields, columns_.size()));
+    }
+
+    bool complete = true;
+    for (auto &field : fields) {
+      if (!available(next, sizeof(int32_t))) {
+        complete = false;
+        break;
+      }
+      const int32_t size = ReadInt32(pending_.data() + next);
+      next += sizeof(int32_t);
+      if (size < -1) {
+        line_++;
+        return Fail(common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT, "invalid field size");
+      }
+      field = {next, size};
+      if (size == -1) continue;
+      if (!available(next, size)) {
+        complete = false;
+        break;
+      }
+      next += size;
+    }
+    if (!complete) break;
+
+    line_++;
+    for (uint16_t col = 0; col < columns_.size(); col++) {
+      const auto [offset, size] = fields[col];
+      values_[col].null_ = size == -1;
+      if (size != -1 && !ConvertBinary(col, std::string_view(pending_.data() + offset, size), &values_[col])) {
+        return false;
+      }
+    }
+    if (!InsertRow()) return false;
+    pos = next;
+  }
+  pending_.erase(0, pos);
+  return true;
+}
+
+bool CopyInReader::ConvertText(const uint16_t col, const std::string_view text, Value *const value) {
+  const type::TypeId type = columns_[col].type_;
+  const auto invalid = [&] {
+    return Fail(common::ErrorCode::ERRCODE_INVALID_TEXT_REPRESENTATION,
+                fmt::format("invalid input syntax for type {}: \"{}\"", type::TypeUtil::TypeIdToString(type), text),
+                col);
+  };
+  const auto integer = [&](const int64_t min, const int64_t max) {
+    const std::string_view trimmed = Trim(text);
+    int64_t parsed;
+    const auto [end, error] = std::from_chars(trimmed.data(), trimmed.data() + trimmed.size(), parsed);
+    if (end != trimmed.data() + trimmed.size() || trimmed.empty() ||
+        (error != std::errc() && error != std::errc::result_out_of_range)) {
+      return std::optional<int64_t>(std::nullopt);
+    }
+    if (error == std::errc::result_out_of_range || parsed < min || parsed > max) {
+      Fail(common::ErrorCode::ERRCODE_NUMERIC_VALUE_OUT_OF_RANGE,
+           fmt::format("value \"{}\" is out of range for type {}", text, type::TypeUtil::TypeIdToString(type)), col);
+      return std::optional<int64_t>(std::nullopt);
+    }
+    return std::make_optional(parsed);
+  };
+
+  switch (type) {
+    case type::TypeId::BOOLEAN: {
+      std::string lower(Trim(text));
+      std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+      const auto is = [&](const auto &strs) { return std::find(strs.cbegin(), strs.cend(), lower) != strs.cend(); };
+      if (is(POSTGRES_BOOLEAN_STR_TRUES)) {
+        StoreFixed<bool>(true, &value->fixed_);
+      } else if (is(POSTGRES_BOOLEAN_STR_FALSES)) {
+        StoreFixed<bool>(false, &value->fixed_);
+      } else {
+        return invalid();
+      }
+      return true;
+    }
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT: {
+      const auto size = type::TypeUtil::GetTypeSize(type);
+      const auto min = size == 8 ? std::numeric_limits<int64_t>::min() : -(int64_t{1} << (size * 8 - 1));
+      const auto max = size == 8 ? std::numeric_limits<int64_t>::max() : (int64_t{1} << (size * 8 - 1)) - 1;
+      const auto parsed = integer(min, max);
+      if (!parsed.has_value()) return error_.has_value() ? false : invalid();
+      // The attribute is the low order bytes of the value
+      StoreFixed<int64_t>(*parsed, &value->fixed_);
+      return true;
+    }
+    case type::TypeId::REAL: {
+      const std::string str(Trim(text));
+      char *end;
+      const double parsed = std::strtod(str.c_str(), &end);
+      if (str.empty() || end != str.c_str() + str.size()) return invalid();
+      StoreFixed<double>(parsed, &value->fixed_);
+      return true;
+    }
+    case type::TypeId::DATE:
+      try {
+        StoreFixed<execution::sql::Date::NativeType>(execution::sql::Date::FromString(text).ToNative(),
+                                                     &value->fixed_);
+      } catch (const ConversionException &) {
+        return invalid();
+      }
+      return true;
+    case type::TypeId::TIMESTAMP:
+      try {
+        StoreFixed<execution::sql::Timestamp::NativeType>(execution::sql::Timestamp::FromString(text).ToNative(),
+                                                          &value->fixed_);
+      } catch (const ConversionException &) {
+        return invalid();
+      }
+      return true;
+    case type::TypeId::VARCHAR:
+    case type::TypeId::VARBINARY:
+      value->varlen_.assign(text);
+      return true;
+    default:
+      return Fail(common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED,
+                  fmt::format("COPY does not support columns of type {}", type::TypeUtil::TypeIdToString(type)), col);
+  }
+}
+
+bool CopyInReader::ConvertBinary(const uint16_t col, const std::string_view bytes, Value *const value) {
+  const type::TypeId type = columns_[col].type_;
+  if (type == type::TypeId::VARCHAR || type == type::TypeId::VARBINARY) {
+    value->varlen_.assign(bytes);
+    return true;
+  }
+  if (type == type::TypeId::DECIMAL) {
+    return Fail(common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED,
+                fmt::format("COPY does not support columns of type {}", type::TypeUtil::TypeIdToString(type)), col);
+  }
+  // Fixed length values have the size of their attributes
+  if (bytes.size() != type::TypeUtil::GetTypeSize(type)) {
+    return Fail(common::ErrorCode::ERRCODE_INVALID_BINARY_REPRESENTATION, "incorrect binary data format", col);
+  }
+
+  switch (type) {
+    case type::TypeId::BOOLEAN:
+      StoreFixed<bool>(bytes[0] != 0, &value->fixed_);
+      break;
+    case type::TypeId::TINYINT:
+      StoreFixed<int8_t>(static_cast<int8_t>(bytes[0]), &value->fixed_);
+      break;
+    case type::TypeId::SMALLINT:
+      StoreFixed<int16_t>(ReadInt16(bytes.data()), &value->fixed_);
+      break;
+    case type::TypeId::INTEGER:
+      StoreFixed<int32_t>(ReadInt32(bytes.data()), &value->fixed_);
+      break;
+    case type::TypeId::BIGINT:
+    case type::TypeId::REAL:
+      // A float8 is sent as the bits of the double
+      StoreFixed<int64_t>(ReadInt64(bytes.data()), &value->fixed_);
+      break;
+    case type::TypeId::DATE:
+      // Postgres counts days from 2000-01-01 rather than from the start of the Julian calendar
+      StoreFixed<execution::sql::Date::NativeType>(ReadInt32(bytes.data()) + POSTGRES_EPOCH_JULIAN_DAY,
+                                                   &value->fixed_);
+      break;
+    case type::TypeId::TIMESTAMP:
+      StoreFixed<execution::sql::Timestamp::NativeType>(
+          ReadInt64(bytes.data()) + POSTGRES_EPOCH_JULIAN_DAY * execution::sql::K_MICRO_SECONDS_PER_DAY,
+          &value->fixed_);
+      break;
+    default:
+      break;
+  }
+  return true;
+}
+
+bool CopyInReader::InsertRow() {
+  // Only a row that is known to be good is staged, since a staged row that is not inserted has to abort the transaction
+  for (uint16_t col = 0; col < columns_.size(); col++) {
+    if (values_[col].null_ && !columns_[col].nullable_) {
+      return Fail(common::ErrorCode::ERRCODE_NOT_NULL_VIOLATION,
+                  fmt::format("null value in column \"{}\" violates not-null constraint", columns_[col].name_), col);
+    }
+  }
+
+  storage::ProjectedRow *const row = loader_->StageRow();
+  for (uint16_t col = 0; col < columns_.size(); col++) {
+    const uint16_t offset = loader_->ColumnOffset(col);
+    const Value &value = values_[col];
+    if (value.null_) {
+      row->SetNull(offset);
+    } else if (type::TypeUtil::GetTypeSize(columns_[col].type_) == storage::VARLEN_COLUMN) {
+      const storage::VarlenEntry varlen = storage::StorageUtil::CreateVarlen(value.varlen_);
+      std::memcpy(row->AccessForceNotNull(offset), &varlen, sizeof(varlen));
+    } else {
+      std::memcpy(row->AccessForceNotNull(offset), &value.fixed_,
+                  storage::AttrSizeBytes(type::TypeUtil::GetTypeSize(columns_[col].type_)));
+    }
+  }
+
+  if (!loader_->InsertRow()) {
+    return Fail(common::ErrorCode::ERRCODE_UNIQUE_VIOLATION, "duplicate key value violates unique constraint");
+  }
+  return true;
+}
+
+bool CopyInReader::Fail(const common::ErrorCode code, const std::string_view message,
+                        const std::optional<uint16_t> col) {
+  error_.emplace(common::ErrorSeverity::ERROR, message, code);
+  std::string where = fmt::format("COPY {}, line {}", table_name_, line_);
+  if (col.has_value()) where += fmt::format(", column {}", columns_[*col].name_);
+  error_->AddField(common::ErrorField::WHERE, where);
+  return false;
+}
+
+}  // namespace noisepage::network
@@ -1,16 +1,24 @@
 #include "network/postgres/postgres_network_commands.h"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
 #include <string>
 #include <variant>
+#include <vector>
 
 #include "common/thread_context.h"
 #include "metrics/metrics_store.h"
 #include "network/network_util.h"
 #include "network/postgres/postgres_packet_util.h"
 #include "network/postgres/postgres_protocol_interpreter.h"
+#include "network/postgres/query_parameterizer.h"
 #include "network/postgres/statement.h"
+#include "parser/copy_statement.h"
+#include "parser/transaction_statement.h"
+#include "spdlog/fmt/fmt.h"
 #include "traffic_cop/traffic_cop.h"
+#include "traffic_cop/traffic_cop_util.h"
 
 namespace noisepage::network {
 
@@ -20,23 +28,109 @@ static Transition FinishSimpleQueryCommand(const common::ManagedPointer<Postgres
   return Transition::PROCEED;
 }
 
+// BEGIN READ ONLY starts a transaction that takes the TransactionManager's read-only fast path
+static bool BeginsReadOnlyTransaction(const Statement &statement) {
+  if (statement.GetQueryType() != QueryType::QUERY_BEGIN) return false;
+  return statement.RootStatement().CastManagedPointerTo<parser::TransactionStatement>()->IsReadOnly();
+}
+
+// BEGIN ISOLATION LEVEL overrides the default isolation level
+static std::optional<transaction::IsolationLevel> BeginsWithIsolationLevel(const Statement &statement) {
+  if (statement.GetQueryType() != QueryType::QUERY_BEGIN) return std::nullopt;
+  return statement.RootStatement().CastManagedPointerTo<parser::TransactionStatement>()->GetIsolationLevel();
+}
+
+// COPY ... TO STDOUT streams the result of its query to the client, which is only supported in the binary COPY format
+static bool CopiesToClient(const Statement &statement) {
+  if (statement.GetQueryType() != QueryType::QUERY_COPY) return false;
+  const auto root = statement.RootStatement();
+  return trafficcop::TrafficCopUtil::IsCopyToStdout(root) &&
+         root.CastManagedPointerTo<parser::CopyStatement>()->GetExternalFileFormat() ==
+             parser::ExternalFileFormat::BINARY;
+}
+
+// Parse a Simple Query with its constants turned into parameters. Returns nullptr if there are no constants to turn
+// into parameters, or if the query isn't one whose plans are shared once they are.
+static std::unique_ptr<Statement> ParseParameterizedQuery(const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                                          const common::ManagedPointer<ConnectionContext> connection,
+                                                          const std::string &query_text,
+                                                          std::vector<parser::ConstantValueExpression> *const params) {
+  auto parameterized_text = QueryParameterizer::Parameterize(query_text, params);
+  if (!parameterized_text.has_value()) return nullptr;
+
+  auto parse_result = t_cop->ParseQuery(*parameterized_text, connection);
+  if (std::holds_alternative<std::unique_ptr<parser::ParseResult>>(parse_result)) {
+    std::vector<type::TypeId> param_types;
+    param_types.reserve(params->size());
+    for (const auto &param : *params) param_types.push_back(param.GetReturnValueType());
+    auto statement =
+        std::make_unique<Statement>(std::move(*parameterized_text),
+                                    std::move(std::get<std::unique_ptr<parser::ParseResult>>(parse_result)),
+                                    std::move(param_types));
+    if (statement->ParseResult()->NumStatements() == 1 &&
+        NetworkUtil::SharedStatementQueryType(statement->GetQueryType())) {
+      return statement;
+    }
+  }
+  params->clear();
+  return nullptr;
+}
+
+/**
+ * Write up to max_rows rows of a suspended portal, or all of its rows left if max_rows is 0. The Execute ends with
+ * PortalSuspended if rows are still left, and with CommandComplete once the last row is written.
+ */
+static void FetchPortalRows(const common::ManagedPointer<Portal> portal,
+                            const common::ManagedPointer<network::PostgresPacketWriter> out, const int32_t max_rows) {
+  const auto &rows = portal->SuspendedResult();
+  const uint32_t num_rows_left = rows.GetNumTuples() - portal->NextRow();
+  const uint32_t num_rows = max_rows > 0 ? std::min(num_rows_left, static_cast<uint32_t>(max_rows)) : num_rows_left;
+  if (num_rows > 0) {
+    const auto physical_plan = portal->OptimizeResult()->GetPlanNode();
+    out->WriteDataRows(rows.GetTuples() + static_cast<std::size_t>(portal->NextRow()) * rows.GetTupleSize(), num_rows,
+                       rows.GetTupleSize(),
+                       PostgresPacketWriter::MakeDataRowLayout(physical_plan->GetOutputSchema()->GetColumns(),
+                                                               portal->ResultFormats()));
+  }
+  portal->FetchRows(num_rows);
+
+  if (num_rows < num_rows_left) {
+    out->WritePortalSuspended();
+  } else {
+    out->WriteCommandComplete(network::QueryType::QUERY_SELECT, num_rows);
+  }
+}
+
 static void ExecutePortal(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
                           const common::ManagedPointer<Portal> portal,
                           const common::ManagedPointer<network::PostgresPacketWriter> out,
-                          const common::ManagedPointer<trafficcop::TrafficCop> t_cop, const bool explicit_txn_block) {
+                          const common::ManagedPointer<trafficcop::TrafficCop> t_cop, const bool explicit_txn_block,
+                          const int32_t max_rows = 0) {
   trafficcop::TrafficCopResult result;
 
   const auto query_type = portal->GetStatement()->GetQueryType();
   const auto physical_plan = portal->OptimizeResult()->GetPlanNode();
+  // A SELECT that an Execute may return only part of runs to completion into its portal, which it is then fetched from
+  const bool suspend = max_rows > 0 && query_type == network::QueryType::QUERY_SELECT;
+
+  if (query_type != network::QueryType::QUERY_SELECT && query_type != network::QueryType::QUERY_COPY &&
+      connection_ctx->Transaction()->IsDeclaredReadOnly()) {
+    out->WriteError({common::ErrorSeverity::ERROR, "cannot execute this statement in a read-only transaction",
+                     common::ErrorCode::ERRCODE_READ_ONLY_SQL_TRANSACTION});
+    connection_ctx->Transaction()->SetMustAbort();
+    return;
+  }
 
   // This logic relies on ordering of values in the enum's definition and is documented there as well.
-  if (NetworkUtil::DMLQueryType(query_type)) {
-    // DML query to put through codegen
-    result = t_cop->CodegenPhysicalPlan(connection_ctx, out, portal);
+  if (NetworkUtil::DMLQueryType(query_type) || query_type == network::QueryType::QUERY_COPY) {
+    // DML query, or the query of a COPY ... TO STDOUT, to put through codegen, unless its result is cached
+    if (!t_cop->SendCachedResult(connection_ctx, out, portal, &result, suspend)) {
+      result = t_cop->CodegenPhysicalPlan(connection_ctx, out, portal);
 
-    // TODO(Matt): do something with result here in case codegen fails
+      // TODO(Matt): do something with result here in case codegen fails
 
-    result = t_cop->RunExecutableQuery(connection_ctx, out, portal);
+      result = t_cop->RunExecutableQuery(connection_ctx, out, portal, suspend);
+    }
   } else if (NetworkUtil::CreateQueryType(query_type)) {
     if (explicit_txn_block && query_type == network::QueryType::QUERY_CREATE_DB) {
       out->WriteError({common::ErrorSeverity::ERROR, "CREATE DATABASE cannot run inside a transaction block",
@@ -48,6 +142,8 @@ static void ExecutePortal(const common::ManagedPointer<network::ConnectionContex
       result = t_cop->ExecuteCreateStatement(connection_ctx, physical_plan, query_type);
       result = t_cop->CodegenPhysicalPlan(connection_ctx, out, portal);
       result = t_cop->RunExecutableQuery(connection_ctx, out, portal);
+    } else if (query_type == network::QueryType::QUERY_CREATE_MATERIALIZED_VIEW) {
+      result = t_cop->ExecuteCreateMaterializedViewStatement(connection_ctx, out, portal);
     } else {
       result = t_cop->ExecuteCreateStatement(connection_ctx, physical_plan, query_type);
     }
@@ -61,8 +157,11 @@ static void ExecutePortal(const common::ManagedPointer<network::ConnectionContex
     result = t_cop->ExecuteDropStatement(connection_ctx, physical_plan, query_type);
   }
 
-  if (result.type_ == trafficcop::ResultType::COMPLETE) {
+  if (result.type_ == trafficcop::ResultType::COMPLETE && portal->IsSuspended()) {
+    FetchPortalRows(portal, out, max_rows);
+  } else if (result.type_ == trafficcop::ResultType::COMPLETE) {
     NOISEPAGE_ASSERT(std::holds_alternative<uint32_t>(result.extra_), "We're expecting number of rows here.");
+    if (query_type == network::QueryType::QUERY_COPY) out->WriteBinaryCopyOutEnd();
     out->WriteCommandComplete(query_type, std::get<uint32_t>(result.extra_));
   } else {
     NOISEPAGE_ASSERT(result.type_ == trafficcop::ResultType::ERROR,
@@ -72,43 +171,60 @@ static void ExecutePortal(const common::ManagedPointer<network::ConnectionContex
   }
 }
 
-Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
-                                    const common::ManagedPointer<PostgresPacketWriter> out,
-                                    const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
-                                    const common::ManagedPointer<ConnectionContext> connection) {
-  const auto postgres_interpreter = interpreter.CastManagedPointerTo<network::PostgresProtocolInterpreter>();
-  NOISEPAGE_ASSERT(!postgres_interpreter->WaitingForSync(),
-                   "We shouldn't be trying to execute commands while waiting for Sync message. This should have been "
-                   "caught at the protocol interpreter Process() level.");
+/** How running one statement of a Simple Query went */
+enum class SimpleQueryStatus : uint8_t { DONE, FAILED, COPY_IN };
 
-  // Parsing a SimpleQuery clears the unnamed statement and portal
-  postgres_interpreter->CloseStatement("");
-  postgres_interpreter->ClosePortal("");
+// End the txn that the statements of a Simple Query ran in, unless the client opened it with BEGIN
+static void EndImplicitTransaction(const common::ManagedPointer<PostgresProtocolInterpreter> postgres_interpreter,
+                                   const common::ManagedPointer<PostgresPacketWriter> out,
+                                   const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                   const common::ManagedPointer<ConnectionContext> connection) {
+  if (postgres_interpreter->ExplicitTransactionBlock() ||
+      connection->TransactionState() == network::NetworkTransactionStateType::IDLE) {
+    return;
+  }
+  // decide whether the txn should be committed or aborted based on the MustAbort flag, and then end the txn
+  if (!t_cop->EndTransaction(connection, connection->Transaction()->MustAbort() ? network::QueryType::QUERY_ROLLBACK
+                                                                                : network::QueryType::QUERY_COMMIT)) {
+    out->WriteError(trafficcop::TrafficCop::SerializationFailure());
+  }
+  postgres_interpreter->ResetTransactionState();
+}
 
-  auto query_text = in_.ReadString();
+/**
+ * Run one statement of a Simple Query. A statement is a single statement transaction unless the client opened a
+ * transaction block, or it is one of several statements sent together, which share one implicit transaction that the
+ * caller ends after the last of them.
+ */
+static SimpleQueryStatus ExecuteSimpleQueryStatement(
+    const common::ManagedPointer<PostgresProtocolInterpreter> postgres_interpreter,
+    const common::ManagedPointer<PostgresPacketWriter> out, const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+    const common::ManagedPointer<ConnectionContext> connection, std::string &&query_text, const bool implicit_txn_block,
+    const bool last_statement) {
+  // Queries that only differ in their constants share one cached plan once their constants are parameters
+  std::vector<parser::ConstantValueExpression> params;
+  auto statement = t_cop->UseQueryCache() ? ParseParameterizedQuery(t_cop, connection, query_text, &params) : nullptr;
 
-  auto parse_result = t_cop->ParseQuery(query_text, connection);
+  if (statement == nullptr) {
+    auto parse_result = t_cop->ParseQuery(query_text, connection);
 
-  if (std::holds_alternative<common::ErrorData>(parse_result)) {
-    out->WriteError(std::get<common::ErrorData>(parse_result));
-    if (connection->TransactionState() == network::NetworkTransactionStateType::BLOCK) {
-      // failing to parse fails a transaction in postgres
-      connection->Transaction()->SetMustAbort();
+    if (std::holds_alternative<common::ErrorData>(parse_result)) {
+      out->WriteError(std::get<common::ErrorData>(parse_result));
+      if (connection->TransactionState() == network::NetworkTransactionStateType::BLOCK) {
+        // failing to parse fails a transaction in postgres
+        connection->Transaction()->SetMustAbort();
+      }
+      return SimpleQueryStatus::FAILED;
     }
-    return FinishSimpleQueryCommand(out, connection);
-  }
-
-  const auto statement = std::make_unique<network::Statement>(
-      std::move(query_text), std::move(std::get<std::unique_ptr<parser::ParseResult>>(parse_result)));
 
-  // TODO(Matt): Clients may send multiple statements in a single SimpleQuery packet/string. Handling that would
-  // probably exist here, looping over all of the elements in the ParseResult. It's not clear to me how the binder would
-  // handle that though since you pass the ParseResult in for binding. Maybe bind ParseResult once?
+    statement = std::make_unique<network::Statement>(
+        std::move(query_text), std::move(std::get<std::unique_ptr<parser::ParseResult>>(parse_result)));
+  }
 
   // Empty queries get a special response in postgres and do not care if they're in a failed txn block
   if (statement->Empty()) {
     out->WriteEmptyQueryResponse();
-    return FinishSimpleQueryCommand(out, connection);
+    return SimpleQueryStatus::DONE;
   }
 
   const auto query_type = statement->GetQueryType();
@@ -119,7 +235,7 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
     out->WriteError({common::ErrorSeverity::ERROR,
                      "current transaction is aborted, commands ignored until end of transaction block",
                      common::ErrorCode::ERRCODE_IN_FAILED_SQL_TRANSACTION});
-    return FinishSimpleQueryCommand(out, connection);
+    return SimpleQueryStatus::FAILED;
   }
 
   // TODO(WAN): as found by Poojita, some SET TRANSACTION ... and SHOW TRANSACTION ... should be transactional.
@@ -129,16 +245,16 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
       out->WriteError({common::ErrorSeverity::ERROR, "SET cannot run inside a transaction block",
                        common::ErrorCode::ERRCODE_ACTIVE_SQL_TRANSACTION});
       connection->Transaction()->SetMustAbort();
-      return FinishSimpleQueryCommand(out, connection);
+      return SimpleQueryStatus::FAILED;
     }
 
     auto set_result = t_cop->ExecuteSetStatement(connection, common::ManagedPointer(statement));
     if (set_result.type_ == trafficcop::ResultType::ERROR) {
       out->WriteError(std::get<common::ErrorData>(set_result.extra_));
-    } else {
-      out->WriteCommandComplete(network::QueryType::QUERY_SET, 0);
+      return SimpleQueryStatus::FAILED;
     }
-    return FinishSimpleQueryCommand(out, connection);
+    out->WriteCommandComplete(network::QueryType::QUERY_SET, 0);
+    return SimpleQueryStatus::DONE;
   }
 
   // TODO(WAN): this is a temporary hack to unblock Ziqi's oltpbench work. #1188
@@ -147,50 +263,131 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
     NOISEPAGE_ASSERT(show_result.type_ == trafficcop::ResultType::COMPLETE,
                      "TODO this should be fixed to handle failure.");
     out->WriteCommandComplete(network::QueryType::QUERY_SHOW, 0);
-    return FinishSimpleQueryCommand(out, connection);
+    return SimpleQueryStatus::DONE;
   }
 
   // Begin a transaction, regardless of statement type. If it's a BEGIN statement it's implicitly in this txn
   if (connection->TransactionState() == network::NetworkTransactionStateType::IDLE) {
     NOISEPAGE_ASSERT(!postgres_interpreter->ExplicitTransactionBlock(),
                      "We shouldn't be in an explicit txn block is transaction state is IDLE.");
-    t_cop->BeginTransaction(connection);
+    // A lone SELECT is a single statement transaction that cannot write
+    const bool lone_read = !implicit_txn_block && (query_type == QueryType::QUERY_SELECT || CopiesToClient(*statement));
+    t_cop->BeginTransaction(connection, lone_read || BeginsReadOnlyTransaction(*statement),
+                            BeginsWithIsolationLevel(*statement));
   }
 
   // This logic relies on ordering of values in the enum's definition and is documented there as well.
   if (NetworkUtil::TransactionalQueryType(query_type)) {
-    t_cop->ExecuteTransactionStatement(connection, out, postgres_interpreter->ExplicitTransactionBlock(), query_type);
+    // COMMIT and ROLLBACK end an implicit transaction too, and the statements after them start a new one
+    const bool in_txn_block = postgres_interpreter->ExplicitTransactionBlock() ||
+                              (implicit_txn_block && query_type != network::QueryType::QUERY_BEGIN);
+    t_cop->ExecuteTransactionStatement(connection, out, in_txn_block, query_type);
     if (query_type == network::QueryType::QUERY_BEGIN) {
       if (!(postgres_interpreter->ExplicitTransactionBlock())) postgres_interpreter->SetExplicitTransactionBlock();
     } else {
       postgres_interpreter->ResetTransactionState();
     }
-    return FinishSimpleQueryCommand(out, connection);
+    return SimpleQueryStatus::DONE;
   }
 
-  // This logic relies on ordering of values in the enum's definition and is documented there as well.
-  if (NetworkUtil::UnsupportedQueryType(query_type)) {
+  if (query_type == network::QueryType::QUERY_COPY &&
+      trafficcop::TrafficCopUtil::IsCopyFromStdin(statement->RootStatement())) {
+    // COPY ... FROM STDIN reads the rows from the CopyData messages that follow, and replies once the client is done
+    if (connection->Transaction()->IsDeclaredReadOnly()) {
+      out->WriteError({common::ErrorSeverity::ERROR, "cannot execute COPY FROM in a read-only transaction",
+                       common::ErrorCode::ERRCODE_READ_ONLY_SQL_TRANSACTION});
+      connection->Transaction()->SetMustAbort();
+    } else if (!last_statement) {
+      // The rows that follow belong to the query, so the statements after the COPY would have to wait for them
+      out->WriteError({common::ErrorSeverity::ERROR, "COPY FROM STDIN must be the last statement of a query",
+                       common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED});
+      connection->Transaction()->SetMustAbort();
+    } else {
+      auto copy_in =
+          t_cop->BeginCopyIn(connection, statement->RootStatement().CastManagedPointerTo<parser::CopyStatement>());
+      if (std::holds_alternative<common::ErrorData>(copy_in)) {
+        out->WriteError(std::get<common::ErrorData>(copy_in));
+        connection->Transaction()->SetMustAbort();
+      } else {
+        auto reader = std::move(std::get<std::unique_ptr<CopyInReader>>(copy_in));
+        out->WriteCopyInResponse(reader->NumColumns(), reader->Format() == parser::ExternalFileFormat::BINARY
+                                                           ? FieldFormat::binary
+                                                           : FieldFormat::text);
+        postgres_interpreter->SetCopyIn(std::move(reader));
+        return SimpleQueryStatus::COPY_IN;
+      }
+    }
+  } else if (query_type == network::QueryType::QUERY_REFRESH) {
+    // REFRESH MATERIALIZED VIEW runs the statements that recompute the view itself
+    if (connection->Transaction()->IsDeclaredReadOnly()) {
+      out->WriteError({common::ErrorSeverity::ERROR,
+                       "cannot execute REFRESH MATERIALIZED VIEW in a read-only transaction",
+                       common::ErrorCode::ERRCODE_READ_ONLY_SQL_TRANSACTION});
+      connection->Transaction()->SetMustAbort();
+    } else {
+      const auto refresh_result = t_cop->ExecuteRefreshStatement(connection, out, common::ManagedPointer(statement));
+      if (refresh_result.type_ == trafficcop::ResultType::COMPLETE) {
+        out->WriteCommandComplete(query_type, 0);
+      } else {
+        out->WriteError(std::get<common::ErrorData>(refresh_result.extra_));
+        connection->Transaction()->SetMustAbort();
+      }
+    }
+  } else if (NetworkUtil::UnsupportedQueryType(query_type) && query_type != network::QueryType::QUERY_EXPLAIN &&
+             !CopiesToClient(*statement)) {
+    // UnsupportedQueryType relies on ordering of values in the enum's definition and is documented there as well.
     out->WriteError({common::ErrorSeverity::NOTICE, "we don't yet support that query type.",
                      common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED});
     out->WriteCommandComplete(query_type, 0);
   } else {
     // Try to bind the parsed statement
-    const auto bind_result = t_cop->BindQuery(connection, common::ManagedPointer(statement), nullptr);
+    auto bind_result = t_cop->BindQuery(connection, common::ManagedPointer(statement), common::ManagedPointer(&params));
+    if (bind_result.type_ == trafficcop::ResultType::ERROR && !params.empty()) {
+      // A parameter may not bind where its constant does, e.g., if its type can't be inferred. Run the query as sent.
+      auto parse_result = t_cop->ParseQuery(query_text, connection);
+      if (std::holds_alternative<std::unique_ptr<parser::ParseResult>>(parse_result)) {
+        statement = std::make_unique<network::Statement>(
+            std::move(query_text), std::move(std::get<std::unique_ptr<parser::ParseResult>>(parse_result)));
+        params.clear();
+        bind_result = t_cop->BindQuery(connection, common::ManagedPointer(statement), nullptr);
+      }
+    }
     if (bind_result.type_ == trafficcop::ResultType::COMPLETE) {
-      // Binding succeeded, optimize to generate a physical plan and then execute
-      auto optimize_result = t_cop->OptimizeBoundQuery(connection, statement->ParseResult(), nullptr);
-
-      statement->SetOptimizeResult(std::move(optimize_result));
-
-      const auto portal = std::make_unique<Portal>(common::ManagedPointer(statement));
+      // Binding succeeded, optimize to generate a physical plan unless another connection did, and then execute
+      if (statement->OptimizeResult() == nullptr) {
+        auto optimize_result =
+            t_cop->OptimizeBoundQuery(connection, statement->ParseResult(), common::ManagedPointer(&params));
 
-      if (query_type == network::QueryType::QUERY_SELECT) {
-        out->WriteRowDescription(portal->OptimizeResult()->GetPlanNode()->GetOutputSchema()->GetColumns(),
-                                 portal->ResultFormats());
+        statement->SetOptimizeResult(std::move(optimize_result));
       }
 
-      ExecutePortal(connection, common::ManagedPointer(portal), out, t_cop,
-                    postgres_interpreter->ExplicitTransactionBlock());
+      // The binary COPY format writes every attribute in binary
+      const auto result_format = query_type == network::QueryType::QUERY_COPY ? FieldFormat::binary : FieldFormat::text;
+      const auto portal = std::make_unique<Portal>(common::ManagedPointer(statement), std::move(params),
+                                                   std::vector<FieldFormat>{result_format});
+
+      if (query_type == network::QueryType::QUERY_EXPLAIN) {
+        const auto explain_result = t_cop->ExecuteExplainStatement(connection, out, common::ManagedPointer(portal));
+        if (explain_result.type_ == trafficcop::ResultType::COMPLETE) {
+          out->WriteCommandComplete(query_type, 0);
+        } else {
+          NOISEPAGE_ASSERT(std::holds_alternative<common::ErrorData>(explain_result.extra_),
+                           "We're expecting a message here.");
+          connection->Transaction()->SetMustAbort();
+          out->WriteError(std::get<common::ErrorData>(explain_result.extra_));
+        }
+      } else {
+        if (query_type == network::QueryType::QUERY_SELECT) {
+          out->WriteRowDescription(portal->OptimizeResult()->GetPlanNode()->GetOutputSchema()->GetColumns(),
+                                   portal->ResultFormats());
+        } else if (query_type == network::QueryType::QUERY_COPY) {
+          out->WriteBinaryCopyOutStart(static_cast<uint16_t>(
+              portal->OptimizeResult()->GetPlanNode()->GetOutputSchema()->GetColumns().size()));
+        }
+
+        ExecutePortal(connection, common::ManagedPointer(portal), out, t_cop,
+                      postgres_interpreter->ExplicitTransactionBlock() || implicit_txn_block);
+      }
     } else if (bind_result.type_ == trafficcop::ResultType::NOTICE) {
       NOISEPAGE_ASSERT(std::holds_alternative<common::ErrorData>(bind_result.extra_),
                        "We're expecting a message here.");
@@ -207,14 +404,45 @@ Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpr
     }
   }
 
-  if (!postgres_interpreter->ExplicitTransactionBlock()) {
-    // Single statement transaction should be ended before returning
-    // decide whether the txn should be committed or aborted based on the MustAbort flag, and then end the txn
-    t_cop->EndTransaction(connection, connection->Transaction()->MustAbort() ? network::QueryType::QUERY_ROLLBACK
-                                                                             : network::QueryType::QUERY_COMMIT);
-    postgres_interpreter->ResetTransactionState();
-  }
+  // Single statement transaction should be ended before returning
+  if (!implicit_txn_block) EndImplicitTransaction(postgres_interpreter, out, t_cop, connection);
+  return SimpleQueryStatus::DONE;
+}
+
+Transition SimpleQueryCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
+                                    const common::ManagedPointer<PostgresPacketWriter> out,
+                                    const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                    const common::ManagedPointer<ConnectionContext> connection) {
+  const auto postgres_interpreter = interpreter.CastManagedPointerTo<network::PostgresProtocolInterpreter>();
+  NOISEPAGE_ASSERT(!postgres_interpreter->WaitingForSync(),
+                   "We shouldn't be trying to execute commands while waiting for Sync message. This should have been "
+                   "caught at the protocol interpreter Process() level.");
+
+  // Parsing a SimpleQuery clears the unnamed statement and portal
+  postgres_interpreter->CloseStatement("");
+  postgres_interpreter->ClosePortal("");
 
+  auto query_text = in_.ReadString();
+  auto statements = QueryParameterizer::SplitStatements(query_text);
+  if (statements.size() == 1) {
+    const auto status = ExecuteSimpleQueryStatement(postgres_interpreter, out, t_cop, connection, std::move(query_text),
+                                                    false, true);
+    return status == SimpleQueryStatus::COPY_IN ? Transition::PROCEED : FinishSimpleQueryCommand(out, connection);
+  }
+
+  // Statements sent together run in one round trip and one implicit transaction, like a stored procedure's body would.
+  // The first statement that fails aborts that transaction and the statements after it are not run.
+  for (std::size_t i = 0; i < statements.size(); i++) {
+    const auto status = ExecuteSimpleQueryStatement(postgres_interpreter, out, t_cop, connection,
+                                                    std::move(statements[i]), true, i + 1 == statements.size());
+    // Ending a COPY FROM STDIN ends its transaction and answers the query
+    if (status == SimpleQueryStatus::COPY_IN) return Transition::PROCEED;
+    if (status == SimpleQueryStatus::FAILED ||
+        connection->TransactionState() == network::NetworkTransactionStateType::FAIL) {
+      break;
+    }
+  }
+  EndImplicitTransaction(postgres_interpreter, out, t_cop, connection);
   return FinishSimpleQueryCommand(out, connection);
 }
 
@@ -365,7 +593,7 @@ Transition BindCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> i
       !NetworkUtil::NonTransactionalQueryType(query_type)) {
     NOISEPAGE_ASSERT(!postgres_interpreter->ExplicitTransactionBlock(),
                      "We shouldn't be in an explicit txn block is transaction state is IDLE.");
-    t_cop->BeginTransaction(connection);
+    t_cop->BeginTransaction(connection, BeginsReadOnlyTransaction(*statement), BeginsWithIsolationLevel(*statement));
   }
 
   if (NetworkUtil::TransactionalQueryType(query_type) || NetworkUtil::SkipBindQueryType(query_type)) {
@@ -394,6 +622,12 @@ Transition BindCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> i
   // Bind it, plan it
   const auto bind_result = t_cop->BindQuery(connection, statement, common::ManagedPointer(&params));
   if (LIKELY(bind_result.type_ == trafficcop::ResultType::COMPLETE)) {
+    // Parameters that change the selectivity of the statement by orders of magnitude get a plan of their own
+    if (t_cop->UseQueryCache() && !params.empty()) {
+      statement->UsePlanVariant(t_cop->ParameterSelectivityBuckets(
+          connection, statement, common::ManagedPointer<const std::vector<parser::ConstantValueExpression>>(&params)));
+    }
+
     // Binding succeeded, optimize to generate a physical plan
     if (statement->OptimizeResult() == nullptr || !t_cop->UseQueryCache()) {
       // it's not cached, optimize it
@@ -501,9 +735,9 @@ Transition ExecuteCommand::Exec(const common::ManagedPointer<ProtocolInterpreter
                    "caught at the protocol interpreter Process() level.");
 
   const auto portal_name = in_.ReadString();
-  const auto max_rows UNUSED_ATTRIBUTE = in_.ReadValue<int32_t>();
-  // TODO(Matt): here's where you would reason about PortalSuspend with max_rows. Maybe just the OutputWriter would
-  // buffer the results, since I'm not sure if we can actually pause execution engine
+  // The execution engine cannot pause a query partway, so a portal that returns fewer rows than its query produces
+  // holds on to the rest of them, see Portal
+  const auto max_rows = in_.ReadValue<int32_t>();
 
   const auto portal = postgres_interpreter->GetPortal(portal_name);
 
@@ -513,6 +747,12 @@ Transition ExecuteCommand::Exec(const common::ManagedPointer<ProtocolInterpreter
     return Transition::PROCEED;
   }
 
+  // A suspended portal resumes where the previous Execute left off, without running its query again
+  if (portal->IsSuspended()) {
+    FetchPortalRows(portal, out, max_rows);
+    return Transition::PROCEED;
+  }
+
   const auto statement = portal->GetStatement();
   const auto query_type = statement->GetQueryType();
 
@@ -564,7 +804,7 @@ Transition ExecuteCommand::Exec(const common::ManagedPointer<ProtocolInterpreter
   }
 
   if (portal->OptimizeResult() != nullptr) {
-    ExecutePortal(connection, portal, out, t_cop, postgres_interpreter->ExplicitTransactionBlock());
+    ExecutePortal(connection, portal, out, t_cop, postgres_interpreter->ExplicitTransactionBlock(), max_rows);
     if (connection->TransactionState() == NetworkTransactionStateType::FAIL) {
       postgres_interpreter->SetWaitingForSync();
     }
@@ -583,8 +823,10 @@ Transition SyncCommand::Exec(common::ManagedPointer<ProtocolInterpreter> interpr
   const auto postgres_interpreter = interpreter.CastManagedPointerTo<network::PostgresProtocolInterpreter>();
   if (!postgres_interpreter->ExplicitTransactionBlock() &&
       !(connection->TransactionState() == network::NetworkTransactionStateType::IDLE)) {
-    t_cop->EndTransaction(connection, connection->Transaction()->MustAbort() ? network::QueryType::QUERY_ROLLBACK
-                                                                             : network::QueryType::QUERY_COMMIT);
+    if (!t_cop->EndTransaction(connection, connection->Transaction()->MustAbort() ? network::QueryType::QUERY_ROLLBACK
+                                                                                  : network::QueryType::QUERY_COMMIT)) {
+      out->WriteError(trafficcop::TrafficCop::SerializationFailure());
+    }
     postgres_interpreter->ResetTransactionState();
   } else if (postgres_interpreter->WaitingForSync()) {
     postgres_interpreter->ResetWaitingForSync();
@@ -617,6 +859,14 @@ Transition CloseCommand::Exec(const common::ManagedPointer<ProtocolInterpreter>
   return Transition::PROCEED;
 }
 
+Transition FlushCommand::Exec(common::ManagedPointer<ProtocolInterpreter> interpreter,
+                              common::ManagedPointer<PostgresPacketWriter> out,
+                              common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                              common::ManagedPointer<ConnectionContext> connection) {
+  // Nothing to do, the command forces the replies so far to be flushed
+  return Transition::PROCEED;
+}
+
 Transition TerminateCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
                                   const common::ManagedPointer<PostgresPacketWriter> out,
                                   const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
@@ -637,4 +887,45 @@ Transition EmptyCommand::Exec(common::ManagedPointer<ProtocolInterpreter> interp
   out->WriteReadyForQuery(NetworkTransactionStateType::IDLE);
   return Transition::PROCEED;
 }
+
+Transition CopyDataCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
+                                 const common::ManagedPointer<PostgresPacketWriter> out,
+                                 const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                 const common::ManagedPointer<ConnectionContext> connection) {
+  const auto postgres_interpreter = interpreter.CastManagedPointerTo<network::PostgresProtocolInterpreter>();
+  const auto copy_in = postgres_interpreter->GetCopyIn();
+  // The client may still be sending data for a COPY that failed, which postgres ignores
+  if (copy_in == nullptr) return Transition::PROCEED;
+
+  if (!copy_in->Feed(in_.ReadRemaining())) postgres_interpreter->EndCopyIn(out, t_cop, connection, copy_in->GetError());
+  return Transition::PROCEED;
+}
+
+Transition CopyDoneCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
+                                 const common::ManagedPointer<PostgresPacketWriter> out,
+                                 const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                 const common::ManagedPointer<ConnectionContext> connection) {
+  const auto postgres_interpreter = interpreter.CastManagedPointerTo<network::PostgresProtocolInterpreter>();
+  const auto copy_in = postgres_interpreter->GetCopyIn();
+  if (copy_in == nullptr) return Transition::PROCEED;
+
+  copy_in->Finish();
+  postgres_interpreter->EndCopyIn(out, t_cop, connection, copy_in->GetError());
+  return Transition::PROCEED;
+}
+
+Transition CopyFailCommand::Exec(const common::ManagedPointer<ProtocolInterpreter> interpreter,
+                                 const common::ManagedPointer<PostgresPacketWriter> out,
+                                 const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                 const common::ManagedPointer<ConnectionContext> connection) {
+  const auto postgres_interpreter = interpreter.CastManagedPointerTo<network::PostgresProtocolInterpreter>();
+  if (postgres_interpreter->GetCopyIn() == nullptr) return Transition::PROCEED;
+
+  postgres_interpreter->EndCopyIn(out, t_cop, connection,
+                                  common::ErrorData(common::ErrorSeverity::ERROR,
+                                                    fmt::format("COPY from stdin failed: {}", in_.ReadString()),
+                                                    common::ErrorCode::ERRCODE_QUERY_CANCELED));
+  return Transition::PROCEED;
+}
+
 }  // namespace noisepage::network
@@ -131,8 +131,20 @@ parser::ConstantValueExpression PostgresPacketUtil::BinaryValueToInternalValue(
       return {type, execution::sql::Real(read_buffer->ReadValue<double>())};
     }
     case type::TypeId::DATE: {
-      // TODO(Matt): unsure if this is correct. Need tests.
-      return {type, execution::sql::DateVal(static_cast<uint32_t>(read_buffer->ReadValue<int32_t>()))};
+      NOISEPAGE_ASSERT(size == 4, "Unexpected size for this type.");
+      // Postgres counts days from 2000-01-01 rather than from the start of the Julian calendar
+      return {type, execution::sql::DateVal(read_buffer->ReadValue<int32_t>() + POSTGRES_EPOCH_JULIAN_DAY)};
+    }
+    case type::TypeId::TIMESTAMP: {
+      NOISEPAGE_ASSERT(size == 8, "Unexpected size for this type.");
+      const auto microseconds =
+          read_buffer->ReadValue<int64_t>() + POSTGRES_EPOCH_JULIAN_DAY * execution::sql::K_MICRO_SECONDS_PER_DAY;
+      return {type, execution::sql::TimestampVal(static_cast<execution::sql::Timestamp::NativeType>(microseconds))};
+    }
+    case type::TypeId::VARCHAR:
+    case type::TypeId::VARBINARY: {
+      auto string_val = execution::sql::ValueUtil::CreateStringVal(read_buffer->ReadString(size));
+      return {type, string_val.first, std::move(string_val.second)};
     }
     default:
       // (Matt): from looking at jdbc source code, that seems like all the possible binary types
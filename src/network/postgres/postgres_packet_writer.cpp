@@ -1,5 +1,8 @@
 #include "network/postgres/postgres_packet_writer.h"
 
+#include <charconv>
+#include <limits>
+
 #include "common/error/error_data.h"
 #include "execution/sql/value.h"
 #include "network/postgres/postgres_defs.h"
@@ -11,7 +14,7 @@ void PostgresPacketWriter::WriteReadyForQuery(NetworkTransactionStateType txn_st
   BeginPacket(NetworkMessageType::PG_READY_FOR_QUERY).AppendRawValue(txn_status).EndPacket();
 }
 
-void PostgresPacketWriter::WriteStartupResponse() {
+void PostgresPacketWriter::WriteStartupResponse(const int32_t process_id, const int32_t cancel_key) {
   BeginPacket(NetworkMessageType::PG_AUTHENTICATION_REQUEST).AppendValue<int32_t>(0).EndPacket();
 
   for (auto &entry : PG_PARAMETER_STATUS_MAP)
@@ -19,6 +22,10 @@ void PostgresPacketWriter::WriteStartupResponse() {
         .AppendString(entry.first, true)
         .AppendString(entry.second, true)
         .EndPacket();
+  BeginPacket(NetworkMessageType::PG_BACKEND_KEY_DATA)
+      .AppendValue<int32_t>(process_id)
+      .AppendValue<int32_t>(cancel_key)
+      .EndPacket();
   WriteReadyForQuery(NetworkTransactionStateType::IDLE);
 }
 
@@ -48,6 +55,8 @@ void PostgresPacketWriter::WriteEmptyQueryResponse() {
 
 void PostgresPacketWriter::WriteNoData() { BeginPacket(NetworkMessageType::PG_NO_DATA_RESPONSE).EndPacket(); }
 
+void PostgresPacketWriter::WritePortalSuspended() { BeginPacket(NetworkMessageType::PG_PORTAL_SUSPENDED).EndPacket(); }
+
 void PostgresPacketWriter::WriteParameterDescription(const std::vector<type::TypeId> &param_types) {
   BeginPacket(NetworkMessageType::PG_PARAMETER_DESCRIPTION);
   AppendValue<int16_t>(static_cast<int16_t>(param_types.size()));
@@ -146,6 +155,9 @@ void PostgresPacketWriter::WriteCommandComplete(const QueryType query_type, cons
     case QueryType::QUERY_CREATE_SCHEMA:
       WriteCommandComplete("CREATE SCHEMA");
       break;
+    case QueryType::QUERY_CREATE_MATERIALIZED_VIEW:
+      WriteCommandComplete("SELECT ", num_rows);
+      break;
     case QueryType::QUERY_DROP_DB:
       WriteCommandComplete("DROP DATABASE");
       break;
@@ -167,6 +179,15 @@ void PostgresPacketWriter::WriteCommandComplete(const QueryType query_type, cons
     case QueryType::QUERY_ANALYZE:
       WriteCommandComplete("ANALYZE");
       break;
+    case QueryType::QUERY_EXPLAIN:
+      WriteCommandComplete("EXPLAIN");
+      break;
+    case QueryType::QUERY_COPY:
+      WriteCommandComplete("COPY ", num_rows);
+      break;
+    case QueryType::QUERY_REFRESH:
+      WriteCommandComplete("REFRESH MATERIALIZED VIEW");
+      break;
     default:
       WriteCommandComplete("This QueryType needs a completion message!");
       break;
@@ -241,26 +262,92 @@ void PostgresPacketWriter::WriteBindComplete() { BeginPacket(NetworkMessageType:
 void PostgresPacketWriter::WriteDataRow(const byte *const tuple,
                                         const std::vector<planner::OutputSchema::Column> &columns,
                                         const std::vector<FieldFormat> &field_formats) {
-  BeginPacket(NetworkMessageType::PG_DATA_ROW).AppendValue<int16_t>(static_cast<int16_t>(columns.size()));
+  WriteDataRows(tuple, 1, 0, MakeDataRowLayout(columns, field_formats));
+}
+
+void PostgresPacketWriter::WriteDataRows(const byte *const tuples, const uint32_t num_tuples, const uint32_t tuple_size,
+                                         const std::vector<DataRowAttribute> &attributes) {
+  const auto num_attributes = static_cast<int16_t>(attributes.size());
+  for (uint32_t row = 0; row < num_tuples; row++) {
+    const byte *const tuple = tuples + row * tuple_size;
+    BeginPacket(NetworkMessageType::PG_DATA_ROW).AppendValue<int16_t>(num_attributes);
+    for (const auto &attribute : attributes) {
+      const auto *const val = reinterpret_cast<const execution::sql::Val *const>(tuple + attribute.offset_);
+      if (attribute.format_ == FieldFormat::text) {
+        WriteTextAttribute(val, attribute.type_);
+      } else {
+        WriteBinaryAttribute(val, attribute.type_);
+      }
+    }
+    EndPacket();
+  }
+}
+
+void PostgresPacketWriter::WriteBinaryCopyOutStart(const uint16_t num_columns) {
+  // Every column is in binary format
+  BeginPacket(NetworkMessageType::PG_COPY_OUT_RESPONSE)
+      .AppendValue<int8_t>(static_cast<int8_t>(FieldFormat::binary))
+      .AppendValue<int16_t>(static_cast<int16_t>(num_columns));
+  for (uint16_t i = 0; i < num_columns; i++) AppendValue<int16_t>(static_cast<int16_t>(FieldFormat::binary));
+  EndPacket();
+
+  // The signature, no flags and no header extension
+  BeginPacket(NetworkMessageType::PG_COPY_DATA)
+      .AppendStringView(POSTGRES_BINARY_COPY_SIGNATURE, false)
+      .AppendValue<int32_t>(0)
+      .AppendValue<int32_t>(0)
+      .EndPacket();
+}
+
+void PostgresPacketWriter::WriteBinaryCopyRows(const byte *const tuples, const uint32_t num_tuples,
+                                               const uint32_t tuple_size,
+                                               const std::vector<DataRowAttribute> &attributes) {
+  // A row of the binary COPY format is laid out like the body of a DataRow with binary attributes
+  const auto num_attributes = static_cast<int16_t>(attributes.size());
+  for (uint32_t row = 0; row < num_tuples; row++) {
+    const byte *const tuple = tuples + row * tuple_size;
+    BeginPacket(NetworkMessageType::PG_COPY_DATA).AppendValue<int16_t>(num_attributes);
+    for (const auto &attribute : attributes) {
+      WriteBinaryAttribute(reinterpret_cast<const execution::sql::Val *const>(tuple + attribute.offset_),
+                           attribute.type_);
+    }
+    EndPacket();
+  }
+}
+
+void PostgresPacketWriter::WriteBinaryCopyOutEnd() {
+  // The trailer is a row with -1 attributes
+  BeginPacket(NetworkMessageType::PG_COPY_DATA).AppendValue<int16_t>(-1).EndPacket();
+  BeginPacket(NetworkMessageType::PG_COPY_DONE).EndPacket();
+}
+
+void PostgresPacketWriter::WriteCopyInResponse(const uint16_t num_columns, const FieldFormat format) {
+  // The overall format, followed by the same format for every column
+  BeginPacket(NetworkMessageType::PG_COPY_IN_RESPONSE)
+      .AppendValue<int8_t>(static_cast<int8_t>(format))
+      .AppendValue<int16_t>(static_cast<int16_t>(num_columns));
+  for (uint16_t i = 0; i < num_columns; i++) AppendValue<int16_t>(static_cast<int16_t>(format));
+  EndPacket();
+}
+
+std::vector<DataRowAttribute> PostgresPacketWriter::MakeDataRowLayout(
+    const std::vector<planner::OutputSchema::Column> &columns, const std::vector<FieldFormat> &field_formats) {
+  std::vector<DataRowAttribute> attributes;
+  attributes.reserve(columns.size());
   uint32_t curr_offset = 0;
   for (uint32_t i = 0; i < columns.size(); i++) {
-    // Reinterpret to a base value type first and check if it's NULL
-    auto alignment = execution::sql::ValUtil::GetSqlAlignment(columns[i].GetType());
+    const auto type = columns[i].GetType();
+    auto alignment = execution::sql::ValUtil::GetSqlAlignment(type);
     if (!common::MathUtil::IsAligned(curr_offset, alignment)) {
       curr_offset = static_cast<uint32_t>(common::MathUtil::AlignTo(curr_offset, alignment));
     }
-    const auto *const val = reinterpret_cast<const execution::sql::Val *const>(tuple + curr_offset);
-
     // Field formats can either be the size of the number of columns, or size 1 where they all use the same format
     const auto field_format = field_formats[i < field_formats.size() ? i : 0];
-
-    const auto type_size = field_format == FieldFormat::text ? WriteTextAttribute(val, columns[i].GetType())
-                                                             : WriteBinaryAttribute(val, columns[i].GetType());
-
-    // Advance in the buffer based on the execution engine's type size
-    curr_offset += type_size;
+    attributes.push_back({curr_offset, type, field_format});
+    // Advance in the tuple based on the execution engine's type size
+    curr_offset += execution::sql::ValUtil::GetSqlSize(type);
   }
-  EndPacket();
+  return attributes;
 }
 
 template <class native_type, class val_type>
@@ -273,17 +360,7 @@ void PostgresPacketWriter::WriteBinaryVal(const execution::sql::Val *const val,
       .AppendValue<native_type>(static_cast<native_type>(casted_val->val_));
 }
 
-template <class native_type, class val_type>
-void PostgresPacketWriter::WriteBinaryValNeedsToNative(const execution::sql::Val *const val, const type::TypeId type) {
-  const auto *const casted_val = reinterpret_cast<const val_type *const>(val);
-  NOISEPAGE_ASSERT(type::TypeUtil::GetTypeSize(type) == sizeof(native_type),
-                   "Mismatched native type size and size reported by TypeUtil.");
-  // write the length, write the attribute
-  AppendValue<int32_t>(static_cast<int32_t>(type::TypeUtil::GetTypeSize(type)))
-      .AppendValue<native_type>(static_cast<native_type>(casted_val->val_.ToNative()));
-}
-
-uint32_t PostgresPacketWriter::WriteBinaryAttribute(const execution::sql::Val *const val, const type::TypeId type) {
+void PostgresPacketWriter::WriteBinaryAttribute(const execution::sql::Val *const val, const type::TypeId type) {
   if (val->is_null_) {
     // write a -1 for the length of the column value and continue to the next value
     AppendValue<int32_t>(static_cast<int32_t>(-1));
@@ -315,11 +392,26 @@ uint32_t PostgresPacketWriter::WriteBinaryAttribute(const execution::sql::Val *c
         break;
       }
       case type::TypeId::DATE: {
-        WriteBinaryValNeedsToNative<uint32_t, execution::sql::DateVal>(val, type);
+        // Postgres counts days from 2000-01-01 rather than from the start of the Julian calendar
+        const auto *const date_val = reinterpret_cast<const execution::sql::DateVal *const>(val);
+        AppendValue<int32_t>(static_cast<int32_t>(sizeof(int32_t)))
+            .AppendValue<int32_t>(date_val->val_.ToNative() - POSTGRES_EPOCH_JULIAN_DAY);
         break;
       }
       case type::TypeId::TIMESTAMP: {
-        WriteBinaryValNeedsToNative<uint64_t, execution::sql::TimestampVal>(val, type);
+        // Postgres counts microseconds from 2000-01-01 00:00:00 rather than from the start of the Julian calendar
+        const auto *const ts_val = reinterpret_cast<const execution::sql::TimestampVal *const>(val);
+        AppendValue<int32_t>(static_cast<int32_t>(sizeof(int64_t)))
+            .AppendValue<int64_t>(static_cast<int64_t>(ts_val->val_.ToNative()) -
+                                  POSTGRES_EPOCH_JULIAN_DAY * execution::sql::K_MICRO_SECONDS_PER_DAY);
+        break;
+      }
+      case type::TypeId::VARCHAR:
+      case type::TypeId::VARBINARY: {
+        // The binary format of text and bytea is their bytes, just like the text format of text
+        const auto *const string_val = reinterpret_cast<const execution::sql::StringVal *const>(val);
+        AppendValue<int32_t>(static_cast<int32_t>(string_val->GetLength()))
+            .AppendStringView(string_val->StringView(), false);
         break;
       }
       default:
@@ -328,12 +420,9 @@ uint32_t PostgresPacketWriter::WriteBinaryAttribute(const execution::sql::Val *c
             "source code.");
     }
   }
-
-  // Advance in the buffer based on the execution engine's type size
-  return execution::sql::ValUtil::GetSqlSize(type);
 }
 
-uint32_t PostgresPacketWriter::WriteTextAttribute(const execution::sql::Val *const val, const type::TypeId type) {
+void PostgresPacketWriter::WriteTextAttribute(const execution::sql::Val *const val, const type::TypeId type) {
   if (val->is_null_) {
     // write a -1 for the length of the column value and continue to the next value
     AppendValue<int32_t>(static_cast<int32_t>(-1));
@@ -345,9 +434,13 @@ uint32_t PostgresPacketWriter::WriteTextAttribute(const execution::sql::Val *con
       case type::TypeId::SMALLINT:
       case type::TypeId::BIGINT:
       case type::TypeId::INTEGER: {
+        // Format integers on the stack rather than allocating a string
         auto *int_val = reinterpret_cast<const execution::sql::Integer *const>(val);
-        string_value = std::to_string(int_val->val_);
-        break;
+        char buffer[std::numeric_limits<int64_t>::digits10 + 2];
+        const char *const end = std::to_chars(buffer, buffer + sizeof(buffer), int_val->val_).ptr;
+        const auto length = static_cast<int32_t>(end - buffer);
+        AppendValue<int32_t>(length).AppendRaw(buffer, length);
+        return;
       }
       case type::TypeId::BOOLEAN: {
         // Don't allocate an actual string for a BOOLEAN, just wrap a std::string_view, write the value directly, and
@@ -356,7 +449,7 @@ uint32_t PostgresPacketWriter::WriteTextAttribute(const execution::sql::Val *con
         const auto str_view =
             static_cast<bool>(bool_val->val_) ? POSTGRES_BOOLEAN_STR_TRUE : POSTGRES_BOOLEAN_STR_FALSE;
         AppendValue<int32_t>(static_cast<int32_t>(str_view.length())).AppendStringView(str_view, false);
-        return execution::sql::ValUtil::GetSqlSize(type);
+        return;
       }
       case type::TypeId::REAL: {
         auto *real_val = reinterpret_cast<const execution::sql::Real *const>(val);
@@ -380,7 +473,7 @@ uint32_t PostgresPacketWriter::WriteTextAttribute(const execution::sql::Val *con
         const auto *const string_val = reinterpret_cast<const execution::sql::StringVal *const>(val);
         AppendValue<int32_t>(static_cast<int32_t>(string_val->GetLength()))
             .AppendStringView(string_val->StringView(), false);
-        return execution::sql::ValUtil::GetSqlSize(type);
+        return;
       }
       default:
         UNREACHABLE(
@@ -391,9 +484,6 @@ uint32_t PostgresPacketWriter::WriteTextAttribute(const execution::sql::Val *con
     // write the size, write the attribute
     AppendValue<int32_t>(static_cast<int32_t>(string_value.length())).AppendString(string_value, false);
   }
-
-  // Advance in the buffer based on the execution engine's type size
-  return execution::sql::ValUtil::GetSqlSize(type);
 }
 
 }  // namespace noisepage::network
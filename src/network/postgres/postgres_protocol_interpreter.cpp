@@ -2,7 +2,6 @@
 
 #include <algorithm>
 #include <string>
-#include <thread>  // NOLINT
 #include <utility>
 
 #include "common/error/error_data.h"
@@ -12,6 +11,7 @@
 #include "traffic_cop/traffic_cop.h"
 
 constexpr uint32_t SSL_MESSAGE_VERNO = 80877103;
+constexpr uint32_t CANCEL_REQUEST_CODE = 80877102;
 #define PROTO_MAJOR_VERSION(x) ((x) >> 16)
 
 namespace noisepage::network {
@@ -31,6 +31,25 @@ Transition PostgresProtocolInterpreter::Process(common::ManagedPointer<ReadBuffe
     curr_input_packet_.Clear();
     return ProcessStartup(in, out, t_cop, context);
   }
+
+  // Pipelining clients send many messages before they wait for a reply. Execute all complete messages in the read
+  // buffer back to back, and only hand control back to the connection once replies have to be flushed, e.g., at a
+  // Sync, or the write queue filled up. Replies to the messages before are sent in the same flush.
+  while (true) {
+    const Transition ret = ProcessPacket(out, t_cop, context);
+    if (ret != Transition::PROCEED || out->ShouldFlush()) return ret;
+    try {
+      if (!TryBuildPacket(in)) return Transition::PROCEED;
+    } catch (std::exception &e) {
+      NETWORK_LOG_ERROR("Encountered exception {0} when parsing packet", e.what());
+      return Transition::TERMINATE;
+    }
+  }
+}
+
+Transition PostgresProtocolInterpreter::ProcessPacket(const common::ManagedPointer<WriteQueue> out,
+                                                      const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                                      const common::ManagedPointer<ConnectionContext> context) {
   auto command = command_factory_->PacketToCommand(common::ManagedPointer<InputPacket>(&curr_input_packet_));
   PostgresPacketWriter writer(out);
   if (command->FlushOnComplete()) out->ForceFlush();
@@ -42,6 +61,28 @@ Transition PostgresProtocolInterpreter::Process(common::ManagedPointer<ReadBuffe
     return Transition::PROCEED;
   }
 
+  if (copy_in_ != nullptr) {
+    switch (curr_input_packet_.msg_type_) {
+      case NetworkMessageType::PG_COPY_DATA:
+      case NetworkMessageType::PG_COPY_DONE:
+      case NetworkMessageType::PG_COPY_FAIL:
+        break;
+      case NetworkMessageType::PG_FLUSH_COMMAND:
+      case NetworkMessageType::PG_SYNC_COMMAND:
+        // Postgres ignores these while it reads the data of a COPY ... FROM STDIN
+        curr_input_packet_.Clear();
+        return Transition::PROCEED;
+      default:
+        EndCopyIn(common::ManagedPointer(&writer), t_cop, context,
+                  common::ErrorData(common::ErrorSeverity::ERROR,
+                                    fmt::format("unexpected message type 0x{:02X} during COPY from stdin",
+                                                static_cast<uchar>(curr_input_packet_.msg_type_)),
+                                    common::ErrorCode::ERRCODE_PROTOCOL_VIOLATION));
+        curr_input_packet_.Clear();
+        return Transition::PROCEED;
+    }
+  }
+
   const Transition ret = command->Exec(common::ManagedPointer<ProtocolInterpreter>(this),
                                        common::ManagedPointer<PostgresPacketWriter>(&writer), t_cop, context);
   curr_input_packet_.Clear();
@@ -62,6 +103,15 @@ Transition PostgresProtocolInterpreter::ProcessStartup(const common::ManagedPoin
     return Transition::PROCEED;
   }
 
+  if (proto_version == CANCEL_REQUEST_CODE) {
+    // A client cancels a query on a connection of its own, with the key that the other connection got at startup.
+    // There's no reply, the connection is just closed.
+    const auto connection_id = in->ReadValue<int32_t>();
+    const auto cancel_key = in->ReadValue<int32_t>();
+    t_cop->CancelQuery(connection_id_t(static_cast<uint16_t>(connection_id)), cancel_key);
+    return Transition::TERMINATE;
+  }
+
   // Process startup packet
   if (PROTO_MAJOR_VERSION(proto_version) != 3) {
     NETWORK_LOG_TRACE("Protocol error: only protocol version 3 is supported");
@@ -86,7 +136,8 @@ Transition PostgresProtocolInterpreter::ProcessStartup(const common::ManagedPoin
   in->Skip(1);
   // TODO(Tianyu): Implement authentication. For now we always send AuthOK
 
-  // Create a temp namespace for this connection
+  // Look up the database. The temp namespace for this connection is only created once it's used, see
+  // TrafficCop::UseTempNamespace, so that a storm of connections doesn't turn into a storm of DDL changes.
   std::string db_name = catalog::DEFAULT_DATABASE;
   auto &cmdline_args = context->CommandLineArgs();
   if (cmdline_args.find("database") != cmdline_args.end()) {
@@ -96,41 +147,21 @@ Transition PostgresProtocolInterpreter::ProcessStartup(const common::ManagedPoin
     }
   }
 
-  std::pair<catalog::db_oid_t, catalog::namespace_oid_t> oids;
-
-  uint32_t sleep_time = INITIAL_BACKOFF_TIME;
-
-  // we loop with exponential backoff because in case there are multiple other pg connections also starting
-  // at the same time, creating DDL conflicts when creating the temp namespace
-  do {
-    oids = t_cop->CreateTempNamespace(context->GetConnectionID(), db_name);
-    if (oids.first == catalog::INVALID_DATABASE_OID || oids.second != catalog::INVALID_NAMESPACE_OID) break;
-    std::this_thread::sleep_for(std::chrono::milliseconds{sleep_time});
-    sleep_time *= BACKOFF_FACTOR;
-  } while (sleep_time <= MAX_BACKOFF_TIME);
-
-  if (oids.first == catalog::INVALID_DATABASE_OID) {
+  const catalog::db_oid_t db_oid = t_cop->GetDatabaseOid(db_name);
+  if (db_oid == catalog::INVALID_DATABASE_OID) {
     // Invalid database name
     writer.WriteError({common::ErrorSeverity::FATAL, fmt::format("Database \"{}\" does not exist", db_name),
                        common::ErrorCode::ERRCODE_UNDEFINED_DATABASE});
     return Transition::TERMINATE;
   }
-  if (oids.second == catalog::INVALID_NAMESPACE_OID) {
-    // Failed to create temporary namespace. Client should retry.
-    writer.WriteError({common::ErrorSeverity::FATAL,
-                       "Failed to create a temporary namespace for this connection. There may be a concurrent "
-                       "DDL change. Please retry.",
-                       common::ErrorCode::ERRCODE_CONNECTION_FAILURE});
-    return Transition::TERMINATE;
-  }
 
-  // Temp namespace creation succeeded, stash some metadata about it in the ConnectionContext
+  // Stash some metadata about the database in the ConnectionContext
   context->SetDatabaseName(std::move(db_name));
-  context->SetDatabaseOid(oids.first);
-  context->SetTempNamespaceOid(oids.second);
+  context->SetDatabaseOid(db_oid);
 
   // All done
-  writer.WriteStartupResponse();
+  const int32_t cancel_key = t_cop->RegisterConnection(context);
+  writer.WriteStartupResponse(context->GetConnectionID().UnderlyingValue(), cancel_key);
   startup_ = false;
   return Transition::PROCEED;
 }
@@ -139,6 +170,9 @@ void PostgresProtocolInterpreter::Teardown(const common::ManagedPointer<ReadBuff
                                            const common::ManagedPointer<WriteQueue> out,
                                            const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
                                            const common::ManagedPointer<ConnectionContext> context) {
+  // A COPY ... FROM STDIN that the client didn't finish is dropped along with its txn
+  ResetCopyIn();
+
   // Close any open transaction
   if (context->Transaction() != nullptr) {
     t_cop->EndTransaction(context, QueryType::QUERY_ROLLBACK);
@@ -153,15 +187,41 @@ void PostgresProtocolInterpreter::Teardown(const common::ManagedPointer<ReadBuff
     return;
   }
 
-  // It's possible that temporary namespace failed to be
-  // created and we're closing the connection for that reason, in
-  // case there's nothing to drop
+  t_cop->UnregisterConnection(context);
+
+  // The temporary namespace is only created once the connection uses it, so there may be nothing to drop
   if (context->GetTempNamespaceOid() != catalog::INVALID_NAMESPACE_OID) {
     while (!t_cop->DropTempNamespace(context->GetDatabaseOid(), context->GetTempNamespaceOid())) {
     }
   }
 }
 
+void PostgresProtocolInterpreter::EndCopyIn(const common::ManagedPointer<PostgresPacketWriter> out,
+                                            const common::ManagedPointer<trafficcop::TrafficCop> t_cop,
+                                            const common::ManagedPointer<ConnectionContext> context,
+                                            const std::optional<common::ErrorData> &error) {
+  NOISEPAGE_ASSERT(copy_in_ != nullptr, "No COPY ... FROM STDIN in progress.");
+  if (error.has_value()) {
+    out->WriteError(*error);
+    context->Transaction()->SetMustAbort();
+  } else {
+    out->WriteCommandComplete(QueryType::QUERY_COPY, static_cast<uint32_t>(copy_in_->NumRows()));
+  }
+  // The reader inserts into the txn, so it goes first
+  ResetCopyIn();
+
+  if (!ExplicitTransactionBlock()) {
+    // The COPY is a single statement txn, which commits unless the data was bad
+    if (!t_cop->EndTransaction(context, context->Transaction()->MustAbort() ? QueryType::QUERY_ROLLBACK
+                                                                           : QueryType::QUERY_COMMIT)) {
+      out->WriteError(trafficcop::TrafficCop::SerializationFailure());
+    }
+    ResetTransactionState();
+  }
+  out->WriteReadyForQuery(context->TransactionState());
+  out->ForceFlush();
+}
+
 size_t PostgresProtocolInterpreter::GetPacketHeaderSize() { return startup_ ? sizeof(uint32_t) : 1 + sizeof(uint32_t); }
 
 void PostgresProtocolInterpreter::SetPacketMessageType(const common::ManagedPointer<ReadBuffer> in) {
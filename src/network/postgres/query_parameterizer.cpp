@@ -0,0 +1,288 @@
+#include "network/postgres/query_parameterizer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <limits>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+
+#include "execution/sql/value_util.h"
+
+namespace noisepage::network {
+
+namespace {
+
+enum class TokenType : uint8_t { NONE, WORD, NUMBER, STRING, QUOTED_IDENTIFIER, SYMBOL };
+
+struct Token {
+  TokenType type_ = TokenType::NONE;
+  // Upper-cased for words, the character for symbols and empty for everything else
+  std::string text_;
+};
+
+// What the parenthesized part of the query a constant is found in keeps constant
+struct Scope {
+  bool select_list_ = false;
+  bool by_list_ = false;
+  bool function_args_ = false;
+
+  bool KeepsConstants() const { return select_list_ || by_list_ || function_args_; }
+};
+
+bool IsSpace(const char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; }
+bool IsDigit(const char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; }
+bool IsWordChar(const char c) { return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_' || c == '$'; }
+
+// Keywords an operand follows
+bool IsOperandKeyword(const std::string &word) {
+  static const std::unordered_set<std::string> keywords = {"WHERE", "AND",  "OR", "NOT", "BETWEEN", "WHEN",
+                                                           "THEN",  "ELSE", "HAVING", "ON", "IN", "VALUES"};
+  return keywords.count(word) > 0;
+}
+
+// Keywords a parenthesis follows without making it a function call
+bool IsClauseKeyword(const std::string &word) {
+  static const std::unordered_set<std::string> keywords = {"SELECT", "FROM", "JOIN", "EXISTS", "AS", "UNION"};
+  return keywords.count(word) > 0;
+}
+
+// Whether a constant after the token is an operand that a parameter can stand in for
+bool StartsOperand(const Token &token) {
+  switch (token.type_) {
+    case TokenType::WORD:
+      return IsOperandKeyword(token.text_);
+    case TokenType::SYMBOL:
+      return token.text_.size() == 1 && std::string_view("=<>(,+-*/%").find(token.text_[0]) != std::string_view::npos;
+    default:
+      return false;
+  }
+}
+
+// Whether the text at pos, after any whitespace, casts what precedes it
+bool IsFollowedByCast(const std::string &text, std::size_t pos) {
+  while (pos < text.size() && IsSpace(text[pos])) pos++;
+  return text.compare(pos, 2, "::") == 0;
+}
+
+// The constant for a numeric literal, typed the way the parser types it
+std::optional<parser::ConstantValueExpression> MakeNumber(const std::string &literal) {
+  const auto num_dots = std::count(literal.begin(), literal.end(), '.');
+  if (num_dots > 1) return std::nullopt;
+  if (num_dots == 1) {
+    return parser::ConstantValueExpression(type::TypeId::REAL, execution::sql::Real(std::stod(literal)));
+  }
+  int64_t value;
+  const auto [end, error] = std::from_chars(literal.data(), literal.data() + literal.size(), value);
+  if (error != std::errc() || end != literal.data() + literal.size()) return std::nullopt;
+  const bool is_integer =
+      value >= std::numeric_limits<int32_t>::min() && value <= std::numeric_limits<int32_t>::max();
+  return parser::ConstantValueExpression(is_integer ? type::TypeId::INTEGER : type::TypeId::BIGINT,
+                                         execution::sql::Integer(value));
+}
+
+parser::ConstantValueExpression MakeString(const std::string &value) {
+  auto string_val = execution::sql::ValueUtil::CreateStringVal(value);
+  return parser::ConstantValueExpression(type::TypeId::VARCHAR, string_val.first, std::move(string_val.second));
+}
+
+}  // namespace
+
+std::optional<std::string> QueryParameterizer::Parameterize(const std::string &query_text,
+                                                            std::vector<parser::ConstantValueExpression> *parameters) {
+  std::string result;
+  result.reserve(query_text.size());
+  std::vector<parser::ConstantValueExpression> constants;
+  std::vector<Scope> scopes(1);
+  Token prev, prev_prev;
+  // Where in the result the last minus sign was written
+  std::size_t minus_pos = 0;
+
+  std::size_t pos = 0;
+  while (pos < query_text.size()) {
+    const char c = query_text[pos];
+    if (IsSpace(c)) {
+      result.push_back(c);
+      pos++;
+      continue;
+    }
+
+    Token token;
+    std::size_t end = pos + 1;
+    std::optional<parser::ConstantValueExpression> constant;
+    // A minus sign that negates the number after it rather than subtracting it
+    bool negates = false;
+
+    if (c == '\'') {
+      std::string value;
+      bool closed = false;
+      while (end < query_text.size()) {
+        if (query_text[end] == '\'') {
+          end++;
+          // A doubled quote is a quote inside the string
+          if (end == query_text.size() || query_text[end] != '\'') {
+            closed = true;
+            break;
+          }
+        }
+        value.push_back(query_text[end++]);
+      }
+      if (!closed) return std::nullopt;
+      token.type_ = TokenType::STRING;
+      constant = MakeString(value);
+    } else if (c == '"') {
+      while (end < query_text.size() && query_text[end] != '"') end++;
+      if (end++ == query_text.size()) return std::nullopt;
+      token.type_ = TokenType::QUOTED_IDENTIFIER;
+    } else if (IsDigit(c) || (c == '.' && pos + 1 < query_text.size() && IsDigit(query_text[pos + 1]))) {
+      while (end < query_text.size() && (IsDigit(query_text[end]) || query_text[end] == '.')) end++;
+      token.type_ = TokenType::NUMBER;
+      if (end < query_text.size() && IsWordChar(query_text[end])) {
+        // An exponent, or something the parser has to make sense of
+        while (end < query_text.size() && (IsWordChar(query_text[end]) || query_text[end] == '.')) end++;
+      } else {
+        negates = prev.type_ == TokenType::SYMBOL && prev.text_ == "-" && StartsOperand(prev_prev);
+        constant = MakeNumber((negates ? "-" : "") + query_text.substr(pos, end - pos));
+      }
+    } else if (IsWordChar(c)) {
+      // Parameters and dollar-quoted strings are left to the parser
+      if (c == '$') return std::nullopt;
+      while (end < query_text.size() && IsWordChar(query_text[end])) end++;
+      token.type_ = TokenType::WORD;
+      for (std::size_t i = pos; i < end; i++) {
+        token.text_.push_back(static_cast<char>(std::toupper(static_cast<unsigned char>(query_text[i]))));
+      }
+    } else {
+      // Comments could hide anything
+      if ((c == '-' || c == '/') && end < query_text.size() && query_text[end] == (c == '-' ? '-' : '*')) {
+        return std::nullopt;
+      }
+      token.type_ = TokenType::SYMBOL;
+      token.text_ = std::string(1, c);
+    }
+
+    if (prev.type_ == TokenType::NONE &&
+        (token.type_ != TokenType::WORD || (token.text_ != "SELECT" && token.text_ != "INSERT" &&
+                                            token.text_ != "UPDATE" && token.text_ != "DELETE"))) {
+      return std::nullopt;
+    }
+
+    Scope &scope = scopes.back();
+    if (token.type_ == TokenType::WORD) {
+      const auto &word = token.text_;
+      if (word == "SELECT") {
+        scope.select_list_ = true;
+      } else if (word == "FROM" || word == "WHERE" || word == "INTO") {
+        scope.select_list_ = false;
+      } else if (word == "BY" && prev.type_ == TokenType::WORD && (prev.text_ == "ORDER" || prev.text_ == "GROUP")) {
+        scope.by_list_ = true;
+      } else if (word == "LIMIT" || word == "OFFSET" || word == "HAVING" || word == "UNION" || word == "INTERSECT" ||
+                 word == "EXCEPT" || word == "FETCH" || word == "FOR" || word == "WINDOW") {
+        scope.by_list_ = false;
+      }
+    } else if (token.type_ == TokenType::SYMBOL) {
+      if (c == '(') {
+        Scope inner = scope;
+        inner.function_args_ |=
+            prev.type_ == TokenType::WORD && !IsOperandKeyword(prev.text_) && !IsClauseKeyword(prev.text_);
+        scopes.push_back(inner);
+      } else if (c == ')') {
+        if (scopes.size() == 1) return std::nullopt;
+        scopes.pop_back();
+      } else if (c == ';' && query_text.find_first_not_of("; \t\n\r\f\v", pos) != std::string::npos) {
+        // Only one statement at a time
+        return std::nullopt;
+      } else if (c == '-') {
+        minus_pos = result.size();
+      }
+    }
+
+    if (constant.has_value() && !scopes.back().KeepsConstants() && StartsOperand(negates ? prev_prev : prev) &&
+        !IsFollowedByCast(query_text, end)) {
+      if (negates) result.resize(minus_pos);
+      constants.emplace_back(std::move(*constant));
+      result += "$" + std::to_string(constants.size());
+    } else {
+      result.append(query_text, pos, end - pos);
+    }
+
+    prev_prev = std::move(prev);
+    prev = std::move(token);
+    pos = end;
+  }
+
+  if (constants.empty()) return std::nullopt;
+  *parameters = std::move(constants);
+  return result;
+}
+
+std::vector<std::string> QueryParameterizer::SplitStatements(const std::string &query_text) {
+  std::vector<std::string> statements;
+  std::size_t begin = 0;
+  const auto end_statement = [&](const std::size_t end) {
+    const auto first = query_text.find_first_not_of(" \t\n\r\f\v", begin);
+    if (first < end) statements.emplace_back(query_text, first, end - first);
+    begin = end + 1;
+  };
+
+  std::size_t pos = 0;
+  while (pos < query_text.size()) {
+    const char c = query_text[pos];
+    const char next = pos + 1 < query_text.size() ? query_text[pos + 1] : '\0';
+    if (c == ';') {
+      end_statement(pos++);
+    } else if (c == '\'' || c == '"') {
+      // E'...' strings escape with backslashes, everything else by doubling the quote
+      const bool escape_prefix = pos > 0 && (query_text[pos - 1] == 'E' || query_text[pos - 1] == 'e') &&
+                                 (pos == 1 || !IsWordChar(query_text[pos - 2]));
+      const bool backslash_escapes = c == '\'' && escape_prefix;
+      pos++;
+      while (pos < query_text.size()) {
+        if (backslash_escapes && query_text[pos] == '\\') {
+          pos += 2;
+        } else if (query_text[pos++] == c) {
+          if (pos == query_text.size() || query_text[pos] != c) break;
+          pos++;
+        }
+      }
+    } else if (c == '-' && next == '-') {
+      pos = query_text.find('\n', pos);
+    } else if (c == '/' && next == '*') {
+      // Block comments nest
+      uint32_t depth = 1;
+      pos += 2;
+      while (pos < query_text.size() && depth > 0) {
+        if (query_text.compare(pos, 2, "/*") == 0) {
+          depth++;
+          pos += 2;
+        } else if (query_text.compare(pos, 2, "*/") == 0) {
+          depth--;
+          pos += 2;
+        } else {
+          pos++;
+        }
+      }
+    } else if (c == '$' && (pos == 0 || !IsWordChar(query_text[pos - 1])) && !IsDigit(next)) {
+      // A dollar-quoted string runs to the next occurrence of its $tag$, while $1 is a parameter
+      const auto tag_end = query_text.find('$', pos + 1);
+      bool is_tag = tag_end != std::string::npos;
+      for (std::size_t i = pos + 1; is_tag && i < tag_end; i++) is_tag = IsWordChar(query_text[i]);
+      if (is_tag) {
+        const auto tag = query_text.substr(pos, tag_end + 1 - pos);
+        const auto close = query_text.find(tag, tag_end + 1);
+        pos = close == std::string::npos ? close : close + tag.size();
+      } else {
+        pos++;
+      }
+    } else {
+      pos++;
+    }
+  }
+  end_statement(query_text.size());
+
+  if (statements.empty()) statements.push_back(query_text);
+  return statements;
+}
+
+}  // namespace noisepage::network
@@ -119,6 +119,22 @@ void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const RightHashJoin *op) {}
 void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const OuterHashJoin *op) {}
 void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const LeftSemiHashJoin *op) { DeriveForJoin(); }
 
+void ChildPropertyDeriver::Visit(const InnerMergeJoin *op) {
+  // Both children must be sorted on their join keys. The output follows the order of the right
+  // child, so the join provides the sort on the right keys.
+  const auto &left_keys = op->GetLeftKeys();
+  const auto &right_keys = op->GetRightKeys();
+  auto left_prop =
+      new PropertySort(left_keys, std::vector<OrderByOrderingType>(left_keys.size(), OrderByOrderingType::ASC));
+  auto right_prop =
+      new PropertySort(right_keys, std::vector<OrderByOrderingType>(right_keys.size(), OrderByOrderingType::ASC));
+
+  auto provided_prop = new PropertySet(std::vector<Property *>{right_prop->Copy()});
+  std::vector<PropertySet *> children{new PropertySet(std::vector<Property *>{left_prop}),
+                                      new PropertySet(std::vector<Property *>{right_prop})};
+  output_.emplace_back(provided_prop, std::move(children));
+}
+
 void ChildPropertyDeriver::Visit(UNUSED_ATTRIBUTE const Insert *op) {
   std::vector<PropertySet *> child_input_properties;
   output_.emplace_back(requirements_->Copy(), std::move(child_input_properties));
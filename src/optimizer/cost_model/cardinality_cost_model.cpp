@@ -0,0 +1,116 @@
+#include "optimizer/cost_model/cardinality_cost_model.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "optimizer/group.h"
+#include "optimizer/group_expression.h"
+#include "optimizer/memo.h"
+#include "optimizer/physical_operators.h"
+#include "optimizer/statistics/stats_storage.h"
+
+namespace noisepage::optimizer {
+
+double CardinalityCostModel::CalculateCost(UNUSED_ATTRIBUTE transaction::TransactionContext *txn,
+                                           catalog::CatalogAccessor *accessor, Memo *memo, GroupExpression *gexpr) {
+  gexpr_ = gexpr;
+  memo_ = memo;
+  accessor_ = accessor;
+  output_cost_ = 0;
+  gexpr_->Contents()->Accept(common::ManagedPointer<OperatorVisitor>(this));
+  return output_cost_;
+}
+
+double CardinalityCostModel::GroupRows(const group_id_t group_id) const {
+  auto *group = memo_->GetGroupByID(group_id);
+  if (!group->HasNumRows()) return DEFAULT_NUM_ROWS;
+  return std::max(static_cast<double>(group->GetNumRows()), 1.0);
+}
+
+double CardinalityCostModel::OutputRows() const { return GroupRows(gexpr_->GetGroupID()); }
+
+double CardinalityCostModel::ChildRows(const size_t child_idx) const {
+  return GroupRows(gexpr_->GetChildGroupId(static_cast<int>(child_idx)));
+}
+
+void CardinalityCostModel::Visit(const SeqScan *op) {
+  double table_rows = DEFAULT_NUM_ROWS;
+  if (op->GetTableOID() != catalog::INVALID_TABLE_OID) {
+    const auto latched_table_stats_reference =
+        stats_storage_->GetTableStats(op->GetDatabaseOID(), op->GetTableOID(), accessor_);
+    // A table that was never analyzed has no rows as far as its statistics know
+    const auto num_rows = latched_table_stats_reference.table_stats_.GetNumRows();
+    if (num_rows != 0) table_rows = static_cast<double>(num_rows);
+  }
+  // Every tuple of the table is read, whatever the predicates filter out
+  output_cost_ = InParallel(table_rows * SEQ_SCAN_TUPLE_COST);
+}
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const IndexScan *op) {
+  // Only the tuples that match the bounds are read, but each of them is a random access
+  output_cost_ = INDEX_PROBE_COST + OutputRows() * INDEX_SCAN_TUPLE_COST;
+}
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const QueryDerivedScan *op) { output_cost_ = 0; }
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const OrderBy *op) {
+  const auto rows = ChildRows(0);
+  output_cost_ = InParallel(rows * std::log2(rows + 1) * SORT_TUPLE_COST);
+}
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const Limit *op) { output_cost_ = 0; }
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const InnerIndexJoin *op) {
+  // The inner table is probed once for every outer tuple
+  output_cost_ = ChildRows(0) * INDEX_PROBE_COST + OutputRows() * (INDEX_SCAN_TUPLE_COST + OUTPUT_TUPLE_COST);
+}
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const InnerNLJoin *op) { CostNLJoin(); }
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const LeftNLJoin *op) { CostNLJoin(); }
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const RightNLJoin *op) { CostNLJoin(); }
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const OuterNLJoin *op) { CostNLJoin(); }
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const InnerHashJoin *op) { CostHashJoin(); }
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const LeftHashJoin *op) { CostHashJoin(); }
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const RightHashJoin *op) { CostHashJoin(); }
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const OuterHashJoin *op) { CostHashJoin(); }
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const LeftSemiHashJoin *op) { CostHashJoin(); }
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const InnerMergeJoin *op) {
+  // Both inputs are already ordered, so each of them is walked once
+  output_cost_ = (ChildRows(0) + ChildRows(1)) * MERGE_TUPLE_COST + OutputRows() * OUTPUT_TUPLE_COST;
+}
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const HashGroupBy *op) {
+  // Every input tuple is looked up in the hash table, and every group takes up an entry in it
+  output_cost_ =
+      InParallel(ChildRows(0) * (HASH_PROBE_TUPLE_COST + AGG_TUPLE_COST) + OutputRows() * HASH_BUILD_TUPLE_COST);
+}
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const SortGroupBy *op) {
+  const auto rows = ChildRows(0);
+  output_cost_ = InParallel(rows * std::log2(rows + 1) * SORT_TUPLE_COST) + rows * AGG_TUPLE_COST;
+}
+
+void CardinalityCostModel::Visit(UNUSED_ATTRIBUTE const Aggregate *op) {
+  output_cost_ = InParallel(ChildRows(0) * AGG_TUPLE_COST);
+}
+
+void CardinalityCostModel::CostNLJoin() {
+  output_cost_ = ChildRows(0) * ChildRows(1) * NLJOIN_PAIR_COST + OutputRows() * OUTPUT_TUPLE_COST;
+}
+
+void CardinalityCostModel::CostHashJoin() {
+  // The left input builds the hash table and the right one probes it
+  output_cost_ = InParallel(ChildRows(0) * HASH_BUILD_TUPLE_COST + ChildRows(1) * HASH_PROBE_TUPLE_COST +
+                            OutputRows() * OUTPUT_TUPLE_COST);
+}
+
+}  // namespace noisepage::optimizer
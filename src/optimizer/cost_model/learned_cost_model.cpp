@@ -0,0 +1,255 @@
+#include "optimizer/cost_model/learned_cost_model.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "catalog/catalog_accessor.h"
+#include "catalog/index_schema.h"
+#include "common/hash_util.h"
+#include "loggers/optimizer_logger.h"
+#include "metrics/metrics_util.h"
+#include "optimizer/group.h"
+#include "optimizer/group_expression.h"
+#include "optimizer/memo.h"
+#include "optimizer/physical_operators.h"
+#include "optimizer/statistics/stats_storage.h"
+#include "self_driving/model_server/model_server_manager.h"
+#include "self_driving/modeling/operating_unit_recorder.h"
+#include "self_driving/modeling/operating_unit_util.h"
+
+namespace noisepage::optimizer {
+
+using selfdriving::ExecutionOperatingUnitType;
+
+size_t OUPredictionCache::KeyHasher::operator()(const Key &key) const {
+  const auto type_hash = common::HashUtil::Hash(key.first);
+  const auto features_hash = common::HashUtil::HashBytes(reinterpret_cast<const byte *>(key.second.data()),
+                                                         key.second.size() * sizeof(double));
+  return common::HashUtil::CombineHashes(type_hash, features_hash);
+}
+
+std::optional<double> OUPredictionCache::Get(const ExecutionOperatingUnitType type,
+                                             const std::vector<double> &features) {
+  std::lock_guard<std::mutex> guard(latch_);
+  const auto it = predictions_.find(Key(type, features));
+  if (it == predictions_.end()) return std::nullopt;
+  return it->second;
+}
+
+void OUPredictionCache::Put(const ExecutionOperatingUnitType type, const std::vector<double> &features,
+                            const double elapsed_us) {
+  std::lock_guard<std::mutex> guard(latch_);
+  // The features are mostly cardinalities, so there is no end to them. Starting over is crude, but cheap.
+  if (predictions_.size() >= MAX_ENTRIES) predictions_.clear();
+  predictions_[Key(type, features)] = elapsed_us;
+}
+
+LearnedCostModel::LearnedCostModel(common::ManagedPointer<StatsStorage> stats_storage, catalog::db_oid_t db_oid,
+                                   common::ManagedPointer<modelserver::ModelServerManager> model_server_manager,
+                                   std::string model_save_path, std::chrono::milliseconds timeout,
+                                   std::shared_ptr<const selfdriving::OUModelMap> ou_models,
+                                   common::ManagedPointer<OUPredictionCache> cache, uint8_t execution_mode,
+                                   std::unique_ptr<AbstractCostModel> fallback)
+    : stats_storage_(stats_storage),
+      db_oid_(db_oid),
+      model_server_manager_(model_server_manager),
+      model_save_path_(std::move(model_save_path)),
+      timeout_(timeout),
+      ou_models_(std::move(ou_models)),
+      cache_(cache),
+      fallback_(std::move(fallback)),
+      cpu_mhz_(metrics::MetricsUtil::GetHardwareContext().cpu_mhz_),
+      execution_mode_(execution_mode) {}
+
+double LearnedCostModel::CalculateCost(transaction::TransactionContext *txn, catalog::CatalogAccessor *accessor,
+                                       Memo *memo, GroupExpression *gexpr) {
+  if (use_fallback_) return fallback_->CalculateCost(txn, accessor, memo, gexpr);
+
+  gexpr_ = gexpr;
+  memo_ = memo;
+  accessor_ = accessor;
+  ous_.clear();
+  gexpr_->Contents()->Accept(common::ManagedPointer<OperatorVisitor>(this));
+  // Operators without operating units (limits, DML, ...) have no alternatives to choose between
+  if (ous_.empty()) return 0;
+
+  const auto elapsed_us = Predict();
+  if (!elapsed_us.has_value()) {
+    OPTIMIZER_LOG_WARN("Operating unit models did not answer in time, costing with the fallback cost model");
+    use_fallback_ = true;
+    return fallback_->CalculateCost(txn, accessor, memo, gexpr);
+  }
+  return *elapsed_us;
+}
+
+std::optional<double> LearnedCostModel::Predict() {
+  double elapsed_us = 0;
+
+  // Batch the features that were not predicted yet by operating unit, which is how the models are asked
+  std::unordered_map<ExecutionOperatingUnitType, std::vector<std::vector<double>>> uncached;
+  for (const auto &[type, features] : ous_) {
+    const auto cached = cache_->Get(type, features);
+    if (cached.has_value()) {
+      elapsed_us += *cached;
+    } else {
+      uncached[type].push_back(features);
+    }
+  }
+
+  for (const auto &[type, features] : uncached) {
+    std::vector<std::vector<double>> predictions;
+    const auto *model = ou_models_ != nullptr ? ou_models_->GetModel(type) : nullptr;
+    if (model != nullptr && model->NumFeatures() == features[0].size()) {
+      predictions = model->Predict(features);
+    } else {
+      auto result = model_server_manager_->InferOUModel(
+          selfdriving::OperatingUnitUtil::ExecutionOperatingUnitTypeToString(type), model_save_path_, features,
+          timeout_);
+      if (!result.second) return std::nullopt;
+      predictions = std::move(result.first);
+    }
+    if (predictions.size() != features.size()) return std::nullopt;
+    for (size_t i = 0; i < features.size(); i++) {
+      // The elapsed time is the last of the labels that the models predict
+      if (predictions[i].empty()) return std::nullopt;
+      const auto prediction = std::max(predictions[i].back(), 0.0);
+      cache_->Put(type, features[i], prediction);
+      elapsed_us += prediction;
+    }
+  }
+  return elapsed_us;
+}
+
+double LearnedCostModel::GroupRows(const group_id_t group_id) const {
+  auto *group = memo_->GetGroupByID(group_id);
+  if (!group->HasNumRows()) return 1;
+  return std::max(static_cast<double>(group->GetNumRows()), 1.0);
+}
+
+double LearnedCostModel::OutputRows() const { return GroupRows(gexpr_->GetGroupID()); }
+
+double LearnedCostModel::ChildRows(const size_t child_idx) const {
+  return GroupRows(gexpr_->GetChildGroupId(static_cast<int>(child_idx)));
+}
+
+double LearnedCostModel::TableRows(const catalog::table_oid_t table_oid) const {
+  const auto latched_table_stats_reference = stats_storage_->GetTableStats(db_oid_, table_oid, accessor_);
+  return std::max(static_cast<double>(latched_table_stats_reference.table_stats_.GetNumRows()), 1.0);
+}
+
+size_t LearnedCostModel::KeySize(const std::vector<common::ManagedPointer<parser::AbstractExpression>> &keys,
+                                 size_t *num_keys) {
+  size_t key_size = 0;
+  for (const auto &key : keys) {
+    selfdriving::OperatingUnitRecorder::AdjustKeyWithType(key->GetReturnValueType(), &key_size, num_keys);
+  }
+  return key_size;
+}
+
+void LearnedCostModel::AddOU(const ExecutionOperatingUnitType type, const double num_rows, const size_t key_size,
+                             const size_t num_keys, const double cardinality, const double num_loops) {
+  // In the order of PilotUtil::GroupFeaturesByOU and ExecutionOperatingUnitFeature::GetAllAttributes, with the memory
+  // factor of 1 and no concurrency that the OperatingUnitRecorder starts out with
+  ous_.emplace_back(type, std::vector<double>{cpu_mhz_, execution_mode_, num_rows, static_cast<double>(key_size),
+                                              static_cast<double>(num_keys), cardinality, 1.0, num_loops, 0.0});
+}
+
+void LearnedCostModel::Visit(const SeqScan *op) {
+  if (op->GetTableOID() == catalog::INVALID_TABLE_OID) return;
+  size_t key_size = 0;
+  size_t num_keys = 0;
+  for (const auto &col : accessor_->GetSchema(op->GetTableOID()).GetColumns()) {
+    selfdriving::OperatingUnitRecorder::AdjustKeyWithType(col.Type(), &key_size, &num_keys);
+  }
+  const auto rows = TableRows(op->GetTableOID());
+  AddOU(ExecutionOperatingUnitType::SEQ_SCAN, rows, key_size, num_keys, rows);
+}
+
+void LearnedCostModel::Visit(const IndexScan *op) {
+  size_t key_size = 0;
+  size_t num_keys = 0;
+  for (const auto &col : accessor_->GetIndexSchema(op->GetIndexOID()).GetColumns()) {
+    selfdriving::OperatingUnitRecorder::AdjustKeyWithType(col.Type(), &key_size, &num_keys);
+  }
+  AddOU(ExecutionOperatingUnitType::IDX_SCAN, TableRows(op->GetTableOID()), key_size, num_keys, OutputRows());
+}
+
+void LearnedCostModel::Visit(UNUSED_ATTRIBUTE const OrderBy *op) {
+  const auto rows = ChildRows(0);
+  AddOU(ExecutionOperatingUnitType::SORT_BUILD, rows, 0, 0, rows);
+  AddOU(ExecutionOperatingUnitType::SORT_ITERATE, rows, 0, 0, rows);
+}
+
+void LearnedCostModel::Visit(const InnerIndexJoin *op) {
+  size_t key_size = 0;
+  size_t num_keys = 0;
+  for (const auto &col : accessor_->GetIndexSchema(op->GetIndexOID()).GetColumns()) {
+    selfdriving::OperatingUnitRecorder::AdjustKeyWithType(col.Type(), &key_size, &num_keys);
+  }
+  // The index is scanned once for every outer tuple
+  const auto outer_rows = ChildRows(0);
+  AddOU(ExecutionOperatingUnitType::IDX_SCAN, TableRows(op->GetTableOID()), key_size, num_keys,
+        std::max(OutputRows() / outer_rows, 1.0), outer_rows);
+}
+
+void LearnedCostModel::Visit(UNUSED_ATTRIBUTE const InnerNLJoin *op) { AddNLJoin(); }
+
+void LearnedCostModel::Visit(UNUSED_ATTRIBUTE const LeftNLJoin *op) { AddNLJoin(); }
+
+void LearnedCostModel::Visit(UNUSED_ATTRIBUTE const RightNLJoin *op) { AddNLJoin(); }
+
+void LearnedCostModel::Visit(UNUSED_ATTRIBUTE const OuterNLJoin *op) { AddNLJoin(); }
+
+void LearnedCostModel::Visit(const InnerHashJoin *op) { AddHashJoin(op->GetLeftKeys()); }
+
+void LearnedCostModel::Visit(const LeftHashJoin *op) { AddHashJoin(op->GetLeftKeys()); }
+
+void LearnedCostModel::Visit(UNUSED_ATTRIBUTE const RightHashJoin *op) { AddHashJoin({}); }
+
+void LearnedCostModel::Visit(UNUSED_ATTRIBUTE const OuterHashJoin *op) { AddHashJoin({}); }
+
+void LearnedCostModel::Visit(const LeftSemiHashJoin *op) { AddHashJoin(op->GetLeftKeys()); }
+
+void LearnedCostModel::Visit(const InnerMergeJoin *op) {
+  // There is no operating unit for merging, but it walks its sorted inputs like iterating a sorter does
+  size_t num_keys = 0;
+  const auto key_size = KeySize(op->GetLeftKeys(), &num_keys);
+  AddOU(ExecutionOperatingUnitType::SORT_ITERATE, ChildRows(0) + ChildRows(1), key_size, num_keys, OutputRows());
+}
+
+void LearnedCostModel::Visit(const HashGroupBy *op) {
+  size_t num_keys = 0;
+  const auto key_size = KeySize(op->GetColumns(), &num_keys);
+  const auto groups = OutputRows();
+  AddOU(ExecutionOperatingUnitType::AGGREGATE_BUILD, ChildRows(0), key_size, num_keys, groups);
+  AddOU(ExecutionOperatingUnitType::AGGREGATE_ITERATE, groups, key_size, num_keys, groups);
+}
+
+void LearnedCostModel::Visit(const SortGroupBy *op) {
+  size_t num_keys = 0;
+  const auto key_size = KeySize(op->GetColumns(), &num_keys);
+  const auto rows = ChildRows(0);
+  AddOU(ExecutionOperatingUnitType::SORT_BUILD, rows, key_size, num_keys, OutputRows());
+  AddOU(ExecutionOperatingUnitType::SORT_ITERATE, rows, key_size, num_keys, OutputRows());
+}
+
+void LearnedCostModel::Visit(UNUSED_ATTRIBUTE const Aggregate *op) {
+  AddOU(ExecutionOperatingUnitType::AGGREGATE_BUILD, ChildRows(0), 0, 0, 1);
+  AddOU(ExecutionOperatingUnitType::AGGREGATE_ITERATE, 1, 0, 0, 1);
+}
+
+void LearnedCostModel::AddNLJoin() {
+  // The inner input is scanned again for every outer tuple, which the recorder accounts for with the number of loops
+  const auto inner_rows = ChildRows(1);
+  AddOU(ExecutionOperatingUnitType::SEQ_SCAN, inner_rows, 0, 0, inner_rows, ChildRows(0));
+}
+
+void LearnedCostModel::AddHashJoin(const std::vector<common::ManagedPointer<parser::AbstractExpression>> &left_keys) {
+  // The left input builds the hash table and the right one probes it
+  size_t num_keys = 0;
+  const auto key_size = KeySize(left_keys, &num_keys);
+  AddOU(ExecutionOperatingUnitType::HASHJOIN_BUILD, ChildRows(0), key_size, num_keys, ChildRows(0));
+  AddOU(ExecutionOperatingUnitType::HASHJOIN_PROBE, ChildRows(1), key_size, num_keys, OutputRows());
+}
+
+}  // namespace noisepage::optimizer
@@ -1,5 +1,7 @@
 #include "optimizer/index_util.h"
 
+#include <algorithm>
+#include <deque>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -9,6 +11,8 @@
 #include "catalog/catalog_accessor.h"
 #include "catalog/index_schema.h"
 #include "optimizer/properties.h"
+#include "parser/expression/constant_value_expression.h"
+#include "parser/expression/function_expression.h"
 #include "parser/expression_util.h"
 
 namespace noisepage::optimizer {
@@ -16,7 +20,7 @@ namespace noisepage::optimizer {
 bool IndexUtil::SatisfiesSortWithIndex(catalog::CatalogAccessor *accessor, const PropertySort *prop,
                                        catalog::table_oid_t tbl_oid, catalog::index_oid_t idx_oid) {
   auto &index_schema = accessor->GetIndexSchema(idx_oid);
-  if (!SatisfiesBaseColumnRequirement(index_schema)) {
+  if (!SatisfiesBaseColumnRequirement(index_schema) || index_schema.Predicate() != nullptr) {
     return false;
   }
 
@@ -58,7 +62,7 @@ std::pair<bool, bool> IndexUtil::SatisfiesPredicateWithIndex(
     planner::IndexScanType *scan_type,
     std::unordered_map<catalog::indexkeycol_oid_t, std::vector<planner::IndexExpression>> *bounds) {
   auto &index_schema = accessor->GetIndexSchema(index_oid);
-  if (!SatisfiesBaseColumnRequirement(index_schema)) {
+  if (!SatisfiesIndexPredicate(index_schema, predicates)) {
     return std::make_pair(false, false);
   }
 
@@ -77,6 +81,109 @@ std::pair<bool, bool> IndexUtil::SatisfiesPredicateWithIndex(
                          bounds);
 }
 
+bool IndexUtil::SatisfiesColumnsWithIndexKey(catalog::CatalogAccessor *accessor, catalog::table_oid_t tbl_oid,
+                                             catalog::index_oid_t index_oid, planner::IndexScanType scan_type,
+                                             const std::vector<catalog::col_oid_t> &col_oids) {
+  // Range scans only know the bounds of the key, not the key of every entry they find
+  if (scan_type != planner::IndexScanType::Exact) return false;
+
+  auto &index_schema = accessor->GetIndexSchema(index_oid);
+  if (!SatisfiesBaseColumnRequirement(index_schema)) {
+    return false;
+  }
+
+  std::vector<catalog::col_oid_t> mapped_cols;
+  std::unordered_map<catalog::col_oid_t, catalog::indexkeycol_oid_t> lookup;
+  if (!ConvertIndexKeyOidToColOid(accessor, tbl_oid, index_schema, &lookup, &mapped_cols)) {
+    return false;
+  }
+
+  return std::all_of(col_oids.begin(), col_oids.end(),
+                     [&lookup](catalog::col_oid_t col_oid) { return lookup.find(col_oid) != lookup.end(); });
+}
+
+bool IndexUtil::SatisfiesIndexPredicate(const catalog::IndexSchema &schema,
+                                        const std::vector<AnnotatedExpression> &predicates) {
+  if (schema.Predicate() == nullptr) return true;
+
+  // a = 'x' and 'x' = a are the same predicate
+  auto implies = [](const parser::AbstractExpression &conjunct, const parser::AbstractExpression &pred) {
+    if (MatchesIndexExpression(conjunct, pred)) return true;
+    switch (pred.GetExpressionType()) {
+      case parser::ExpressionType::COMPARE_EQUAL:
+      case parser::ExpressionType::COMPARE_NOT_EQUAL:
+      case parser::ExpressionType::COMPARE_LESS_THAN:
+      case parser::ExpressionType::COMPARE_GREATER_THAN:
+      case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+      case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+        return conjunct.GetExpressionType() ==
+                   parser::ExpressionUtil::ReverseComparisonExpressionType(pred.GetExpressionType()) &&
+               MatchesIndexExpression(*conjunct.GetChild(0), *pred.GetChild(1)) &&
+               MatchesIndexExpression(*conjunct.GetChild(1), *pred.GetChild(0));
+      default:
+        return false;
+    }
+  };
+
+  std::deque<const parser::AbstractExpression *> expr_queue{schema.Predicate().Get()};
+  while (!expr_queue.empty()) {
+    const auto *conjunct = expr_queue.front();
+    expr_queue.pop_front();
+    if (conjunct->GetExpressionType() == parser::ExpressionType::CONJUNCTION_AND) {
+      for (const auto &child : conjunct->GetChildren()) expr_queue.emplace_back(child.Get());
+      continue;
+    }
+
+    auto implied = std::any_of(predicates.begin(), predicates.end(), [&](const AnnotatedExpression &pred) {
+      return implies(*conjunct, *pred.GetExpr());
+    });
+    if (!implied) return false;
+  }
+  return true;
+}
+
+bool IndexUtil::MatchesIndexExpression(const parser::AbstractExpression &index_expr,
+                                       const parser::AbstractExpression &expr) {
+  if (index_expr.GetExpressionType() != expr.GetExpressionType()) return false;
+  if (index_expr.GetReturnValueType() != expr.GetReturnValueType()) return false;
+  if (index_expr.GetChildrenSize() != expr.GetChildrenSize()) return false;
+
+  switch (expr.GetExpressionType()) {
+    case parser::ExpressionType::COLUMN_VALUE: {
+      const auto &index_cve = dynamic_cast<const parser::ColumnValueExpression &>(index_expr);
+      const auto &cve = dynamic_cast<const parser::ColumnValueExpression &>(expr);
+      if (index_cve.GetTableOid() != cve.GetTableOid()) return false;
+      if (index_cve.GetColumnOid() != catalog::INVALID_COLUMN_OID) {
+        return index_cve.GetColumnOid() == cve.GetColumnOid();
+      }
+      return index_cve.GetColumnName() == cve.GetColumnName();
+    }
+    case parser::ExpressionType::VALUE_CONSTANT: {
+      const auto &index_value = dynamic_cast<const parser::ConstantValueExpression &>(index_expr);
+      const auto &value = dynamic_cast<const parser::ConstantValueExpression &>(expr);
+      if (index_value.IsNull() || value.IsNull()) return index_value.IsNull() && value.IsNull();
+      return index_value.ToString() == value.ToString();
+    }
+    case parser::ExpressionType::FUNCTION: {
+      const auto &index_func = dynamic_cast<const parser::FunctionExpression &>(index_expr);
+      const auto &func = dynamic_cast<const parser::FunctionExpression &>(expr);
+      if (index_func.GetFuncName() != func.GetFuncName()) return false;
+      break;
+    }
+    case parser::ExpressionType::VALUE_PARAMETER:
+    case parser::ExpressionType::ROW_SUBQUERY:
+      // Their values are not known until the query runs
+      return false;
+    default:
+      break;
+  }
+
+  for (size_t i = 0; i < expr.GetChildrenSize(); i++) {
+    if (!MatchesIndexExpression(*index_expr.GetChild(i), *expr.GetChild(i))) return false;
+  }
+  return true;
+}
+
 std::pair<bool, bool> IndexUtil::CheckPredicates(
     const catalog::IndexSchema &schema, catalog::table_oid_t tbl_oid, const std::string &tbl_alias,
     const std::unordered_map<catalog::col_oid_t, catalog::indexkeycol_oid_t> &lookup,
@@ -104,22 +211,24 @@ std::pair<bool, bool> IndexUtil::CheckPredicates(
       case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO: {
         // TODO(wz2): Support more complex/predicates on indexes
 
-        // Currently supports [column] (=/!=/>/>=/</<=) [value/parameter]
+        // Currently supports [column] (=/!=/>/>=/</<=) [value/parameter], where [column] may also be an expression
+        // that an index key column stores
         // [column] = [column] will force a seq scan
         // [value] = [value] will force a seq scan (rewriter should fix this)
         auto ltype = expr->GetChild(0)->GetExpressionType();
         auto rtype = expr->GetChild(1)->GetExpressionType();
+        auto lvalue =
+            ltype == parser::ExpressionType::VALUE_CONSTANT || ltype == parser::ExpressionType::VALUE_PARAMETER;
+        auto rvalue =
+            rtype == parser::ExpressionType::VALUE_CONSTANT || rtype == parser::ExpressionType::VALUE_PARAMETER;
 
-        common::ManagedPointer<parser::ColumnValueExpression> tv_expr;
+        common::ManagedPointer<parser::AbstractExpression> tv_expr;
         common::ManagedPointer<parser::AbstractExpression> idx_expr;
-        if (ltype == parser::ExpressionType::COLUMN_VALUE &&
-            (rtype == parser::ExpressionType::VALUE_CONSTANT || rtype == parser::ExpressionType::VALUE_PARAMETER)) {
-          tv_expr = expr->GetChild(0).CastManagedPointerTo<parser::ColumnValueExpression>();
+        if (!lvalue && rvalue) {
+          tv_expr = expr->GetChild(0);
           idx_expr = expr->GetChild(1);
-        } else if (rtype == parser::ExpressionType::COLUMN_VALUE &&
-                   (ltype == parser::ExpressionType::VALUE_CONSTANT ||
-                    ltype == parser::ExpressionType::VALUE_PARAMETER)) {
-          tv_expr = expr->GetChild(1).CastManagedPointerTo<parser::ColumnValueExpression>();
+        } else if (lvalue && !rvalue) {
+          tv_expr = expr->GetChild(1);
           idx_expr = expr->GetChild(0);
           type = parser::ExpressionUtil::ReverseComparisonExpressionType(type);
         } else if (allow_cves &&
@@ -128,11 +237,11 @@ std::pair<bool, bool> IndexUtil::CheckPredicates(
           auto rexpr = expr->GetChild(1).CastManagedPointerTo<parser::ColumnValueExpression>();
           if (lexpr->GetTableOid() == tbl_oid &&
               (rexpr->GetTableOid() != tbl_oid || lexpr->GetTableName() == tbl_alias)) {
-            tv_expr = lexpr;
+            tv_expr = expr->GetChild(0);
             idx_expr = expr->GetChild(1);
             left_side = true;
           } else {
-            tv_expr = rexpr;
+            tv_expr = expr->GetChild(1);
             idx_expr = expr->GetChild(0);
             left_side = false;
           }
@@ -142,9 +251,23 @@ std::pair<bool, bool> IndexUtil::CheckPredicates(
           continue;
         }
 
-        auto col_oid = tv_expr->GetColumnOid();
-        if (mapped_cols.find(col_oid) != mapped_cols.end()) {
-          auto idxkey = lookup.find(col_oid)->second;
+        auto idxkey = catalog::INVALID_INDEXKEYCOL_OID;
+        if (tv_expr->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE) {
+          auto col_oid = tv_expr.CastManagedPointerTo<parser::ColumnValueExpression>()->GetColumnOid();
+          if (mapped_cols.find(col_oid) != mapped_cols.end()) idxkey = lookup.find(col_oid)->second;
+        } else {
+          for (const auto &col : schema.GetColumns()) {
+            if (col.StoredExpression()->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE &&
+                MatchesIndexExpression(*col.StoredExpression(), *tv_expr)) {
+              idxkey = col.Oid();
+              break;
+            }
+          }
+          // Let the scan_predicate() evaluate expressions that no index key stores
+          if (idxkey == catalog::INVALID_INDEXKEYCOL_OID) continue;
+        }
+
+        if (idxkey != catalog::INVALID_INDEXKEYCOL_OID) {
           if (type == parser::ExpressionType::COMPARE_EQUAL) {
             // Exact is simulated as open high of idx_expr and open low of idx_expr
             open_highs[idxkey] = idx_expr;
@@ -245,7 +368,6 @@ bool IndexUtil::ConvertIndexKeyOidToColOid(catalog::CatalogAccessor *accessor, c
                                            const catalog::IndexSchema &schema,
                                            std::unordered_map<catalog::col_oid_t, catalog::indexkeycol_oid_t> *key_map,
                                            std::vector<catalog::col_oid_t> *col_oids) {
-  NOISEPAGE_ASSERT(SatisfiesBaseColumnRequirement(schema), "GetIndexColOid() pre-cond not satisfied");
   auto &tbl_schema = accessor->GetSchema(tbl_oid);
   if (tbl_schema.GetColumns().size() < schema.GetColumns().size()) {
     return false;
@@ -221,6 +221,8 @@ void InputColumnDeriver::Visit(const LeftSemiHashJoin *op) { JoinHelper(op); }
 
 void InputColumnDeriver::Visit(const LeftHashJoin *op) { JoinHelper(op); }
 
+void InputColumnDeriver::Visit(const InnerMergeJoin *op) { JoinHelper(op); }
+
 void InputColumnDeriver::Visit(UNUSED_ATTRIBUTE const RightHashJoin *op) {
   NOISEPAGE_ASSERT(0, "RightHashJoin not supported");
 }
@@ -384,6 +386,11 @@ void InputColumnDeriver::JoinHelper(const BaseOperatorNodeContents *op) {
     join_conds = join_op->GetJoinPredicates();
     left_keys = join_op->GetLeftKeys();
     right_keys = join_op->GetRightKeys();
+  } else if (op->GetOpType() == OpType::INNERMERGEJOIN) {
+    auto join_op = reinterpret_cast<const InnerMergeJoin *>(op);
+    join_conds = join_op->GetJoinPredicates();
+    left_keys = join_op->GetLeftKeys();
+    right_keys = join_op->GetRightKeys();
   }
 
   ExprSet input_cols_set;
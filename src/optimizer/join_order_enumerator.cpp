@@ -0,0 +1,261 @@
+#include "optimizer/join_order_enumerator.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "loggers/optimizer_logger.h"
+#include "optimizer/group.h"
+#include "optimizer/group_expression.h"
+#include "optimizer/logical_operators.h"
+#include "optimizer/operator_node.h"
+#include "optimizer/optimizer_context.h"
+#include "optimizer/statistics/cardinality_feedback.h"
+#include "optimizer/statistics/stats_calculator.h"
+
+namespace noisepage::optimizer {
+
+bool JoinOrderEnumerator::OrderJoins(group_id_t root_group_id) {
+  auto *gexpr = context_->GetMemo().GetGroupByID(root_group_id)->GetLogicalExpression();
+  if (gexpr->Contents()->GetOpType() != OpType::LOGICALINNERJOIN) {
+    bool ordered = false;
+    for (const auto child_group_id : gexpr->GetChildGroupIDs()) ordered |= OrderJoins(child_group_id);
+    return ordered;
+  }
+
+  leaves_.clear();
+  predicates_.clear();
+  CollectJoinTree(root_group_id);
+  const auto leaves = leaves_;
+
+  bool ordered = false;
+  if (leaves_.size() >= MIN_RELATIONS && leaves_.size() <= MAX_RELATIONS) {
+    ReorderJoin(root_group_id);
+    ordered = true;
+  }
+
+  // The relations may themselves have joins under them, such as in a derived table
+  for (const auto leaf : leaves) ordered |= OrderJoins(leaf);
+  return ordered;
+}
+
+void JoinOrderEnumerator::CollectJoinTree(group_id_t group_id) {
+  auto *gexpr = context_->GetMemo().GetGroupByID(group_id)->GetLogicalExpression();
+  if (gexpr->Contents()->GetOpType() != OpType::LOGICALINNERJOIN) {
+    leaves_.push_back(group_id);
+    return;
+  }
+
+  for (const auto &predicate : gexpr->Contents()->GetContentsAs<LogicalInnerJoin>()->GetJoinPredicates()) {
+    predicates_.push_back({predicate, 0, 1});
+  }
+  for (const auto child_group_id : gexpr->GetChildGroupIDs()) CollectJoinTree(child_group_id);
+}
+
+void JoinOrderEnumerator::DeriveStats(group_id_t group_id) {
+  auto *gexpr = context_->GetMemo().GetGroupByID(group_id)->GetLogicalExpression();
+  if (gexpr->HasDerivedStats()) return;
+  for (const auto child_group_id : gexpr->GetChildGroupIDs()) DeriveStats(child_group_id);
+
+  StatsCalculator calculator;
+  calculator.CalculateStats(gexpr, context_);
+  gexpr->SetDerivedStats();
+}
+
+void JoinOrderEnumerator::ReorderJoin(group_id_t group_id) {
+  leaf_rows_.clear();
+  for (const auto leaf : leaves_) {
+    DeriveStats(leaf);
+    auto *group = context_->GetMemo().GetGroupByID(leaf);
+    leaf_rows_.push_back(group->HasNumRows() ? std::max(static_cast<double>(group->GetNumRows()), 1.0)
+                                             : DEFAULT_NUM_ROWS);
+  }
+  for (auto &predicate : predicates_) {
+    predicate.relations_ = Relations(predicate.expr_);
+    predicate.selectivity_ = Selectivity(predicate.expr_, predicate.relations_);
+  }
+
+  plans_.clear();
+  if (leaves_.size() <= MAX_DP_RELATIONS) {
+    EnumerateDP();
+  } else {
+    EnumerateGreedy();
+  }
+
+  std::vector<bool> applied(predicates_.size(), false);
+  const auto all_relations =
+      leaves_.size() == MAX_RELATIONS ? ~RelationSet{0} : (RelationSet{1} << leaves_.size()) - 1;
+  auto tree = BuildTree(all_relations, &applied);
+  OPTIMIZER_LOG_TRACE("Ordered a join of " + std::to_string(leaves_.size()) + " relations with estimated cost " +
+                      std::to_string(plans_.at(all_relations).cost_));
+  context_->ReplaceRewriteExpression(common::ManagedPointer(tree), group_id);
+}
+
+JoinOrderEnumerator::RelationSet JoinOrderEnumerator::Relations(const AnnotatedExpression &predicate) const {
+  RelationSet relations = 0;
+  const auto &aliases = predicate.GetTableAliasSet();
+  for (size_t i = 0; i < leaves_.size(); i++) {
+    for (const auto &alias : context_->GetMemo().GetGroupByID(leaves_[i])->GetTableAliases()) {
+      if (aliases.count(alias) != 0) {
+        relations |= RelationSet{1} << i;
+        break;
+      }
+    }
+  }
+  return relations;
+}
+
+double JoinOrderEnumerator::Selectivity(const AnnotatedExpression &predicate, RelationSet relations) const {
+  // Like the StatsCalculator, only an equality between the columns of two relations is known to filter anything
+  std::vector<Group *> groups;
+  for (size_t i = 0; i < leaves_.size(); i++) {
+    if ((relations & (RelationSet{1} << i)) != 0) groups.push_back(context_->GetMemo().GetGroupByID(leaves_[i]));
+  }
+  if (groups.size() != 2) return 1;
+  return StatsCalculator::EstimateJoinSelectivity(groups[0], groups[1], {predicate});
+}
+
+double JoinOrderEnumerator::Rows(RelationSet relations) const {
+  // A join whose rows were observed when the query ran before has them, like its group will
+  if (const auto feedback = context_->GetCardinalityFeedback(); feedback != nullptr && !feedback->Empty()) {
+    std::unordered_set<std::string> aliases;
+    for (size_t i = 0; i < leaves_.size(); i++) {
+      if ((relations & (RelationSet{1} << i)) == 0) continue;
+      const auto &leaf_aliases = context_->GetMemo().GetGroupByID(leaves_[i])->GetTableAliases();
+      aliases.insert(leaf_aliases.begin(), leaf_aliases.end());
+    }
+    if (const auto observed = feedback->Lookup(aliases); observed.has_value()) {
+      return std::max(static_cast<double>(*observed), 1.0);
+    }
+  }
+
+  double rows = 1;
+  for (size_t i = 0; i < leaves_.size(); i++) {
+    if ((relations & (RelationSet{1} << i)) != 0) rows *= leaf_rows_[i];
+  }
+  for (const auto &predicate : predicates_) {
+    if ((predicate.relations_ & ~relations) == 0) rows *= predicate.selectivity_;
+  }
+  return std::max(rows, 1.0);
+}
+
+bool JoinOrderEnumerator::Connected(RelationSet left, RelationSet right) const {
+  // A predicate connects the two sides if it needs both of them and nothing else, which makes it a hyperedge
+  return std::any_of(predicates_.begin(), predicates_.end(), [=](const JoinPredicate &predicate) {
+    return (predicate.relations_ & ~(left | right)) == 0 && (predicate.relations_ & left) != 0 &&
+           (predicate.relations_ & right) != 0;
+  });
+}
+
+JoinOrderEnumerator::JoinPlan JoinOrderEnumerator::MakePlan(const JoinPlan &left, RelationSet left_relations,
+                                                            const JoinPlan &right, RelationSet right_relations) const {
+  const auto rows = Rows(left_relations | right_relations);
+  // The left child of a hash join builds the hash table, which should be the smaller side
+  if (left.rows_ > right.rows_) std::swap(left_relations, right_relations);
+  return {rows, left.cost_ + right.cost_ + rows, left_relations, right_relations};
+}
+
+void JoinOrderEnumerator::EnumerateDP() {
+  const auto num_relations = leaves_.size();
+  const auto all_relations = (RelationSet{1} << num_relations) - 1;
+  std::vector<std::optional<JoinPlan>> best(all_relations + 1);
+  for (size_t i = 0; i < num_relations; i++) best[RelationSet{1} << i] = JoinPlan{leaf_rows_[i], 0, 0, 0};
+
+  // Every subset of a set is smaller than it, so its best plan is known by the time the set is visited
+  for (RelationSet relations = 1; relations <= all_relations; relations++) {
+    if (best[relations].has_value()) continue;
+    const auto lowest = relations & (~relations + 1);
+
+    // Relations that no predicate connects are joined with a cross product, but only if there is no other way
+    for (const bool connected_only : {true, false}) {
+      // Every split is visited once, with the lowest relation on the left
+      for (auto left = (relations - 1) & relations; left != 0; left = (left - 1) & relations) {
+        const auto right = relations ^ left;
+        if ((left & lowest) == 0 || (connected_only && !Connected(left, right))) continue;
+        auto plan = MakePlan(*best[left], left, *best[right], right);
+        if (!best[relations].has_value() || plan.cost_ < best[relations]->cost_) best[relations] = plan;
+      }
+      if (best[relations].has_value()) break;
+    }
+  }
+
+  // Only the plans that make up the chosen join tree are kept
+  std::vector<RelationSet> stack{all_relations};
+  while (!stack.empty()) {
+    const auto relations = stack.back();
+    stack.pop_back();
+    const auto &plan = *best[relations];
+    plans_.emplace(relations, plan);
+    if (plan.left_ != 0) {
+      stack.push_back(plan.left_);
+      stack.push_back(plan.right_);
+    }
+  }
+}
+
+void JoinOrderEnumerator::EnumerateGreedy() {
+  std::vector<RelationSet> trees;
+  for (size_t i = 0; i < leaves_.size(); i++) {
+    trees.push_back(RelationSet{1} << i);
+    plans_.emplace(trees.back(), JoinPlan{leaf_rows_[i], 0, 0, 0});
+  }
+
+  // Join the two trees with the smallest result, preferring the ones that a predicate connects
+  while (trees.size() > 1) {
+    size_t best_left = 0;
+    size_t best_right = 0;
+    bool best_connected = false;
+    double best_rows = std::numeric_limits<double>::max();
+    for (size_t left = 0; left < trees.size(); left++) {
+      for (size_t right = left + 1; right < trees.size(); right++) {
+        const bool connected = Connected(trees[left], trees[right]);
+        if (best_connected && !connected) continue;
+        const auto rows = Rows(trees[left] | trees[right]);
+        if ((connected && !best_connected) || rows < best_rows) {
+          best_left = left;
+          best_right = right;
+          best_connected = connected;
+          best_rows = rows;
+        }
+      }
+    }
+
+    const auto left = trees[best_left];
+    const auto right = trees[best_right];
+    plans_.emplace(left | right, MakePlan(plans_.at(left), left, plans_.at(right), right));
+    trees[best_left] = left | right;
+    trees.erase(trees.begin() + best_right);
+  }
+}
+
+std::unique_ptr<AbstractOptimizerNode> JoinOrderEnumerator::BuildTree(RelationSet relations,
+                                                                       std::vector<bool> *applied) const {
+  auto *txn = context_->GetTxn();
+  const auto &plan = plans_.at(relations);
+  std::vector<std::unique_ptr<AbstractOptimizerNode>> children;
+  if (plan.left_ == 0) {
+    const auto leaf = static_cast<size_t>(__builtin_ctzll(relations));
+    return std::make_unique<OperatorNode>(LeafOperator::Make(leaves_[leaf]).RegisterWithTxnContext(txn),
+                                          std::move(children), txn);
+  }
+
+  children.emplace_back(BuildTree(plan.left_, applied));
+  children.emplace_back(BuildTree(plan.right_, applied));
+
+  // Every predicate is evaluated by the lowest join that has all of its relations
+  std::vector<AnnotatedExpression> join_predicates;
+  for (size_t i = 0; i < predicates_.size(); i++) {
+    if ((*applied)[i] || (predicates_[i].relations_ & ~relations) != 0) continue;
+    (*applied)[i] = true;
+    join_predicates.push_back(predicates_[i].expr_);
+  }
+  return std::make_unique<OperatorNode>(
+      LogicalInnerJoin::Make(std::move(join_predicates)).RegisterWithTxnContext(txn), std::move(children), txn);
+}
+
+}  // namespace noisepage::optimizer
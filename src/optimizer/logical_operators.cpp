@@ -851,7 +851,8 @@ BaseOperatorNodeContents *LogicalCreateIndex::Copy() const { return new LogicalC
 
 Operator LogicalCreateIndex::Make(catalog::namespace_oid_t namespace_oid, catalog::table_oid_t table_oid,
                                   parser::IndexType index_type, bool unique, std::string index_name,
-                                  std::vector<common::ManagedPointer<parser::AbstractExpression>> index_attrs) {
+                                  std::vector<common::ManagedPointer<parser::AbstractExpression>> index_attrs,
+                                  common::ManagedPointer<parser::AbstractExpression> index_predicate) {
   auto *op = new LogicalCreateIndex();
   op->namespace_oid_ = namespace_oid;
   op->table_oid_ = table_oid;
@@ -859,6 +860,7 @@ Operator LogicalCreateIndex::Make(catalog::namespace_oid_t namespace_oid, catalo
   op->unique_index_ = unique;
   op->index_name_ = std::move(index_name);
   op->index_attrs_ = std::move(index_attrs);
+  op->index_predicate_ = index_predicate;
   return Operator(common::ManagedPointer<BaseOperatorNodeContents>(op));
 }
 
@@ -872,6 +874,7 @@ common::hash_t LogicalCreateIndex::Hash() const {
   for (const auto &attr : index_attrs_) {
     hash = common::HashUtil::CombineHashes(hash, attr->Hash());
   }
+  if (index_predicate_ != nullptr) hash = common::HashUtil::CombineHashes(hash, index_predicate_->Hash());
   return hash;
 }
 
@@ -887,7 +890,9 @@ bool LogicalCreateIndex::operator==(const BaseOperatorNodeContents &r) {
   for (size_t i = 0; i < index_attrs_.size(); i++) {
     if (*(index_attrs_[i]) != *(node.index_attrs_[i])) return false;
   }
-  return (true);
+  if (index_predicate_ == nullptr || node.index_predicate_ == nullptr)
+    return index_predicate_ == nullptr && node.index_predicate_ == nullptr;
+  return *index_predicate_ == *node.index_predicate_;
 }
 
 //===--------------------------------------------------------------------===//
@@ -1,16 +1,22 @@
 #include "optimizer/optimizer.h"
 
+#include <algorithm>
 #include <memory>
+#include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "common/error/exception.h"
 #include "common/scoped_timer.h"
+#include "loggers/optimizer_logger.h"
 #include "optimizer/binding.h"
 #include "optimizer/input_column_deriver.h"
+#include "optimizer/join_order_enumerator.h"
 #include "optimizer/operator_visitor.h"
 #include "optimizer/optimization_context.h"
 #include "optimizer/optimizer_task_pool.h"
+#include "optimizer/physical_operators.h"
 #include "optimizer/plan_generator.h"
 #include "optimizer/properties.h"
 #include "optimizer/property_enforcer.h"
@@ -29,6 +35,7 @@ std::unique_ptr<OptimizeResult> Optimizer::BuildPlanTree(
   context_->SetCatalogAccessor(accessor);
   context_->SetStatsStorage(storage);
   context_->SetParams(parameters);
+  context_->SetCardinalityFeedback(cardinality_feedback_);
   auto optimize_result = std::make_unique<OptimizeResult>();
 
   // Generate initial operator tree from query tree
@@ -54,7 +61,7 @@ std::unique_ptr<OptimizeResult> Optimizer::BuildPlanTree(
   }
 
   try {
-    PlanGenerator generator(optimize_result->GetPlanMetaData());
+    PlanGenerator generator(optimize_result->GetPlanMetaData(), common::ManagedPointer(context_->GetStatsStorage()));
     auto best_plan = ChooseBestPlan(txn, accessor, root_id, phys_properties, output_exprs, &generator);
     optimize_result->SetPlanNode(std::move(best_plan));
     // Reset memo after finishing the optimization
@@ -111,7 +118,12 @@ std::unique_ptr<planner::AbstractPlanNode> Optimizer::ChooseBestPlan(
   // Derive root plan
   auto *op = new OperatorNode(gexpr->Contents(), {}, txn);
 
-  planner::PlanMetaData::PlanNodeMetaData plan_node_meta_data(context_->GetMemo().GetGroupByID(id)->GetNumRows());
+  // Scans and joins are known by their tables, so that the rows they are observed to produce can be fed back
+  const auto &logical_exprs = group->GetLogicalExpressions();
+  const auto op_type = logical_exprs.empty() ? OpType::UNDEFINED : logical_exprs[0]->Contents()->GetOpType();
+  const bool is_relation = op_type == OpType::LOGICALGET || op_type == OpType::LOGICALINNERJOIN;
+  planner::PlanMetaData::PlanNodeMetaData plan_node_meta_data(
+      group->GetNumRows(), is_relation ? group->GetTableAliases() : std::unordered_set<std::string>{});
   auto plan = generator->ConvertOpNode(txn, accessor, op, required_props, required_cols, output_cols,
                                        std::move(children_plans), std::move(children_expr_map), plan_node_meta_data);
   OPTIMIZER_LOG_TRACE("Finish Choosing best plan for group " + std::to_string(id.UnderlyingValue()));
@@ -129,7 +141,21 @@ void Optimizer::OptimizeLoop(group_id_t root_group_id, PropertySet *required_pro
   // Perform rewrite first
   task_stack->Push(new TopDownRewrite(root_group_id, root_context, RuleSetName::PREDICATE_PUSH_DOWN));
   task_stack->Push(new BottomUpRewrite(root_group_id, root_context, RuleSetName::UNNEST_SUBQUERY, false));
-  ExecuteTaskStack(task_stack, root_group_id, root_context);
+  ExecuteTaskStack(task_stack, root_group_id, root_context, 0);
+
+  // Point queries have a single plan worth having, so there is nothing to explore
+  if (OptimizePointQuery(root_group_id, required_props, root_context)) return;
+
+  // Pick the order of multi-way joins up front instead of exploring all of them with the rules
+  if (JoinOrderEnumerator(context_.get()).OrderJoins(root_group_id)) context_->SetJoinsOrdered();
+
+  // Optimize the independent parts of the query on several threads first, which counts against the same timeout
+  uint64_t elapsed_time = 0;
+  if (num_threads_ > 1) {
+    elapsed_time = OptimizeIndependentGroups(root_group_id);
+    task_stack = new OptimizerTaskStack();
+    context_->SetTaskPool(task_stack);
+  }
 
   // Perform optimization after the rewrite
   Memo &memo = context_->GetMemo();
@@ -138,16 +164,135 @@ void Optimizer::OptimizeLoop(group_id_t root_group_id, PropertySet *required_pro
   // Derive stats for the only one logical expression before optimizing
   task_stack->Push(new DeriveStats(memo.GetGroupByID(root_group_id)->GetLogicalExpression(), root_context));
 
-  ExecuteTaskStack(task_stack, root_group_id, root_context);
+  ExecuteTaskStack(task_stack, root_group_id, root_context, elapsed_time);
+}
+
+bool Optimizer::OptimizePointQuery(group_id_t root_group_id, PropertySet *required_props,
+                                   OptimizationContext *root_context) {
+  if (!required_props->Properties().empty()) return false;
+
+  // The groups from the root down to the scan of the table, which is the only one without a child
+  Memo &memo = context_->GetMemo();
+  std::vector<GroupExpression *> logical_exprs;
+  for (auto group_id = root_group_id;;) {
+    const auto &exprs = memo.GetGroupByID(group_id)->GetLogicalExpressions();
+    if (exprs.size() != 1) return false;
+    auto *const gexpr = exprs[0];
+    const auto op_type = gexpr->Contents()->GetOpType();
+    if (op_type == OpType::LOGICALGET && gexpr->GetChildrenGroupsSize() == 0) {
+      logical_exprs.push_back(gexpr);
+      break;
+    }
+    if ((op_type != OpType::LOGICALUPDATE && op_type != OpType::LOGICALDELETE) ||
+        gexpr->GetChildrenGroupsSize() != 1) {
+      return false;
+    }
+    logical_exprs.push_back(gexpr);
+    group_id = gexpr->GetChildGroupId(0);
+  }
+
+  // Implement them bottom up, so that nothing is added to the memo unless the scan is an exact unique index lookup
+  auto *accessor = context_->GetCatalogAccessor();
+  auto *txn = context_->GetTxn();
+  for (auto it = logical_exprs.rbegin(); it != logical_exprs.rend(); ++it) {
+    auto *const gexpr = *it;
+    std::vector<std::unique_ptr<AbstractOptimizerNode>> transformed;
+    for (auto *rule : context_->GetRuleSet().GetRulesByName(RuleSetName::PHYSICAL_IMPLEMENTATION)) {
+      if (rule->GetMatchPattern()->Type() != gexpr->Contents()->GetOpType()) continue;
+      GroupExprBindingIterator iterator(memo, gexpr, rule->GetMatchPattern(), txn);
+      while (iterator.HasNext()) {
+        auto before = iterator.Next();
+        if (rule->Check(common::ManagedPointer(before.get()), root_context)) {
+          rule->Transform(common::ManagedPointer(before.get()), &transformed, root_context);
+        }
+      }
+    }
+
+    const auto chosen = std::find_if(transformed.begin(), transformed.end(), [&](const auto &node) {
+      if (gexpr->GetChildrenGroupsSize() > 0) return node->Contents()->IsPhysical();
+      const auto scan = node->Contents()->template GetContentsAs<IndexScan>();
+      return scan != nullptr && scan->GetIndexScanType() == planner::IndexScanType::Exact &&
+             accessor->GetIndexSchema(scan->GetIndexOID()).Unique();
+    });
+    if (chosen == transformed.end()) {
+      NOISEPAGE_ASSERT(it == logical_exprs.rbegin(), "only the scan can fail to be implemented");
+      return false;
+    }
+
+    // It is the only plan of its group, so its cost doesn't matter
+    const auto group_id = gexpr->GetGroupID();
+    GroupExpression *physical_expr = nullptr;
+    context_->RecordOptimizerNodeIntoGroup(common::ManagedPointer(*chosen), &physical_expr, group_id);
+    std::vector<PropertySet *> input_props;
+    for (size_t idx = 0; idx < physical_expr->GetChildrenGroupsSize(); idx++) input_props.push_back(new PropertySet());
+    physical_expr->SetLocalHashTable(required_props->Copy(), input_props, 0);
+    auto *const group = memo.GetGroupByID(group_id);
+    group->SetExpressionCost(physical_expr, 0, required_props->Copy());
+    group->SetNumRows(1);
+  }
+  OPTIMIZER_LOG_TRACE("Planned point query without exploring the memo");
+  return true;
+}
+
+uint64_t Optimizer::OptimizeIndependentGroups(group_id_t root_group_id) {
+  Memo &memo = context_->GetMemo();
+  std::vector<std::vector<group_id_t>> waves;
+  std::vector<bool> visited(memo.NumGroups(), false);
+  if (!CollectIndependentGroups(root_group_id, 0, &waves, &visited)) return 0;
+
+  size_t num_groups = 0;
+  for (const auto &wave : waves) num_groups += wave.size();
+  if (num_groups < MIN_PARALLEL_GROUPS) return 0;
+
+  uint64_t elapsed_time = 0;
+  {
+    common::ScopedTimer<std::chrono::milliseconds> timer(&elapsed_time);
+    auto *pool = new ConcurrentOptimizerTaskPool(num_threads_);
+    context_->SetTaskPool(pool);
+
+    // Every job gets its own context, because optimizing a group lowers the cost upper bound of its context
+    auto make_context = [&] {
+      auto *context = new OptimizationContext(context_.get(), new PropertySet());
+      context_->AddOptimizationContext(context);
+      return context;
+    };
+
+    // The stats of every group are needed to cost it, and deriving them is cheap
+    pool->Push(new DeriveStats(memo.GetGroupByID(root_group_id)->GetLogicalExpression(), make_context()));
+    pool->ExecuteJobs();
+
+    for (auto wave = waves.rbegin(); wave != waves.rend(); ++wave) {
+      for (const auto group_id : *wave) pool->Push(new OptimizeGroup(memo.GetGroupByID(group_id), make_context()));
+      pool->ExecuteJobs();
+    }
+  }
+  OPTIMIZER_LOG_TRACE("Optimized " + std::to_string(num_groups) + " independent groups in " +
+                      std::to_string(elapsed_time) + " ms");
+  return elapsed_time;
+}
+
+bool Optimizer::CollectIndependentGroups(group_id_t group_id, size_t depth,
+                                         std::vector<std::vector<group_id_t>> *waves, std::vector<bool> *visited) {
+  const auto idx = group_id.UnderlyingValue();
+  if ((*visited)[idx]) return false;
+  (*visited)[idx] = true;
+
+  const auto &child_group_ids = context_->GetMemo().GetGroupByID(group_id)->GetLogicalExpression()->GetChildGroupIDs();
+  if (child_group_ids.size() > 1 && waves->size() <= depth) waves->resize(depth + 1);
+  for (const auto child_group_id : child_group_ids) {
+    if (child_group_ids.size() > 1) (*waves)[depth].push_back(child_group_id);
+    if (!CollectIndependentGroups(child_group_id, child_group_ids.size() > 1 ? depth + 1 : depth, waves, visited)) {
+      return false;
+    }
+  }
+  return true;
 }
 
 void Optimizer::ExecuteTaskStack(OptimizerTaskStack *task_stack, group_id_t root_group_id,
-                                 OptimizationContext *root_context) {
+                                 OptimizationContext *root_context, uint64_t elapsed_time) {
   auto root_group = context_->GetMemo().GetGroupByID(root_group_id);
   const auto &required_props = root_context->GetRequiredProperties();
 
-  uint64_t elapsed_time = 0;
-
   // Iterate through the task stack
   while (!task_stack->Empty()) {
     // Check to see if we have at least one plan, and if we have exceeded our
@@ -0,0 +1,72 @@
+#include "optimizer/optimizer_task_pool.h"
+
+#include <memory>
+
+namespace noisepage::optimizer {
+
+namespace {
+/** Stack of the job that the thread runs, if it runs one */
+thread_local OptimizerTaskStack *job_stack = nullptr;
+}  // namespace
+
+ConcurrentOptimizerTaskPool::ConcurrentOptimizerTaskPool(const uint32_t num_threads)
+    : workers_(num_threads, common::TaskQueue{}) {
+  workers_.Startup();
+}
+
+ConcurrentOptimizerTaskPool::~ConcurrentOptimizerTaskPool() {
+  workers_.Shutdown();
+  for (auto *job : jobs_) delete job;
+}
+
+OptimizerTask *ConcurrentOptimizerTaskPool::Pop() {
+  if (job_stack != nullptr) return job_stack->Pop();
+
+  // ownership handed off to caller
+  auto *job = jobs_.back();
+  jobs_.pop_back();
+  return job;
+}
+
+void ConcurrentOptimizerTaskPool::Push(OptimizerTask *task) {
+  if (job_stack != nullptr) {
+    job_stack->Push(task);
+  } else {
+    jobs_.push_back(task);
+  }
+}
+
+bool ConcurrentOptimizerTaskPool::Empty() { return job_stack != nullptr ? job_stack->Empty() : jobs_.empty(); }
+
+void ConcurrentOptimizerTaskPool::ExecuteJobs() {
+  for (auto *job : jobs_) workers_.SubmitTask([this, job] { ExecuteJob(job); });
+  jobs_.clear();
+  workers_.WaitUntilAllFinished();
+
+  if (failed_) {
+    failed_ = false;
+    auto exception = exception_;
+    exception_ = nullptr;
+    std::rethrow_exception(exception);
+  }
+}
+
+void ConcurrentOptimizerTaskPool::ExecuteJob(OptimizerTask *job) {
+  // The stack deletes the tasks that did not run if the job stops early
+  OptimizerTaskStack stack;
+  stack.Push(job);
+  job_stack = &stack;
+  try {
+    while (!stack.Empty() && !failed_) {
+      std::unique_ptr<OptimizerTask> task(stack.Pop());
+      task->Execute();
+    }
+  } catch (...) {
+    common::SpinLatch::ScopedSpinLatch guard(&exception_latch_);
+    if (exception_ == nullptr) exception_ = std::current_exception();
+    failed_ = true;
+  }
+  job_stack = nullptr;
+}
+
+}  // namespace noisepage::optimizer
@@ -1,5 +1,6 @@
 #include "optimizer/plan_generator.h"
 
+#include <cmath>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -10,12 +11,16 @@
 #include "common/error/exception.h"
 #include "execution/sql/value.h"
 #include "optimizer/abstract_optimizer_node.h"
+#include "optimizer/index_util.h"
 #include "optimizer/operator_node.h"
 #include "optimizer/physical_operators.h"
 #include "optimizer/properties.h"
 #include "optimizer/property_set.h"
+#include "optimizer/statistics/column_stats.h"
+#include "optimizer/statistics/stats_storage.h"
 #include "optimizer/util.h"
 #include "parser/expression/abstract_expression.h"
+#include "parser/expression/column_value_expression.h"
 #include "parser/expression/constant_value_expression.h"
 #include "parser/expression_util.h"
 #include "planner/plannodes/aggregate_plan_node.h"
@@ -41,6 +46,7 @@
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "planner/plannodes/insert_plan_node.h"
 #include "planner/plannodes/limit_plan_node.h"
+#include "planner/plannodes/merge_join_plan_node.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/projection_plan_node.h"
@@ -52,8 +58,9 @@
 
 namespace noisepage::optimizer {
 
-PlanGenerator::PlanGenerator(common::ManagedPointer<planner::PlanMetaData> plan_meta_data)
-    : plan_id_counter_(0), plan_meta_data_(plan_meta_data) {}
+PlanGenerator::PlanGenerator(common::ManagedPointer<planner::PlanMetaData> plan_meta_data,
+                             common::ManagedPointer<StatsStorage> stats_storage)
+    : plan_id_counter_(0), plan_meta_data_(plan_meta_data), stats_storage_(stats_storage) {}
 
 std::unique_ptr<planner::AbstractPlanNode> PlanGenerator::ConvertOpNode(
     transaction::TransactionContext *txn, catalog::CatalogAccessor *accessor, AbstractOptimizerNode *op,
@@ -225,6 +232,11 @@ void PlanGenerator::Visit(const IndexScan *op) {
   // An IndexScan (for now at least) will output all columns of its table
   std::vector<catalog::col_oid_t> column_ids = GenerateColumnsForScan(predicate);
 
+  // Scans feeding an update or delete keep reading the table, which is where the write happens
+  auto type = op->GetIndexScanType();
+  bool index_only = !op->GetIsForUpdate() &&
+                    IndexUtil::SatisfiesColumnsWithIndexKey(accessor_, tbl_oid, op->GetIndexOID(), type, column_ids);
+
   auto builder = planner::IndexScanPlanNode::Builder();
   builder.SetOutputSchema(std::move(output_schema));
   builder.SetPlanNodeId(GetNextPlanNodeID());
@@ -237,8 +249,9 @@ void PlanGenerator::Visit(const IndexScan *op) {
   builder.SetTableNumTuple(table_num_tuple);
   builder.SetIndexSize(accessor_->GetTable(tbl_oid)->GetNumTuple());
   builder.SetCoverAllColumns(op->GetCoverAllColumns());
-
-  auto type = op->GetIndexScanType();
+  builder.SetIndexOnly(index_only);
+  // The index provides the sort order that the parent requires, so no sort is planned above the scan
+  builder.SetOrdered(required_props_->GetPropertyOfType(PropertyType::SORT) != nullptr);
   builder.SetScanType(type);
   for (auto bound : op->GetBounds()) {
     if (type == planner::IndexScanType::Exact) {
@@ -264,6 +277,8 @@ void PlanGenerator::Visit(const IndexScan *op) {
 
 void PlanGenerator::Visit(const ExternalFileScan *op) {
   switch (op->GetFormat()) {
+    case parser::ExternalFileFormat::TEXT:
+      // Files in the text format are scanned like CSV files, without undoing the backslash escapes
     case parser::ExternalFileFormat::CSV: {
       // First construct the output column descriptions
       std::vector<type::TypeId> value_types;
@@ -716,6 +731,39 @@ void PlanGenerator::Visit(const LeftSemiHashJoin *op) {
   output_plan_ = builder.Build();
 }
 
+void PlanGenerator::Visit(const InnerMergeJoin *op) {
+  auto proj_schema = GenerateProjectionForJoin();
+
+  auto comb_pred = parser::ExpressionUtil::JoinAnnotatedExprs(op->GetJoinPredicates());
+  auto eval_pred =
+      parser::ExpressionUtil::EvaluateExpression(children_expr_map_, common::ManagedPointer(comb_pred.get()));
+  auto join_predicate =
+      parser::ExpressionUtil::ConvertExprCVNodes(common::ManagedPointer(eval_pred.get()), children_expr_map_).release();
+  RegisterPointerCleanup<parser::AbstractExpression>(join_predicate, true, true);
+
+  auto builder = planner::MergeJoinPlanNode::Builder();
+  builder.SetOutputSchema(std::move(proj_schema));
+  builder.SetPlanNodeId(GetNextPlanNodeID());
+
+  for (auto &expr : op->GetLeftKeys()) {
+    auto left_key = parser::ExpressionUtil::EvaluateExpression(children_expr_map_, expr).release();
+    RegisterPointerCleanup<parser::AbstractExpression>(left_key, true, true);
+    builder.AddLeftMergeKey(common::ManagedPointer(left_key));
+  }
+
+  for (auto &expr : op->GetRightKeys()) {
+    auto right_key = parser::ExpressionUtil::EvaluateExpression(children_expr_map_, expr).release();
+    RegisterPointerCleanup<parser::AbstractExpression>(right_key, true, true);
+    builder.AddRightMergeKey(common::ManagedPointer(right_key));
+  }
+
+  builder.AddChild(std::move(children_plans_[0]));
+  builder.AddChild(std::move(children_plans_[1]));
+  builder.SetJoinPredicate(common::ManagedPointer(join_predicate));
+  builder.SetJoinType(planner::LogicalJoinType::INNER);
+  output_plan_ = builder.Build();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // Aggregations (when the groups are greater than individuals)
 ///////////////////////////////////////////////////////////////////////////////
@@ -792,10 +840,54 @@ void PlanGenerator::BuildAggregatePlan(
   builder.SetPlanNodeId(GetNextPlanNodeID());
   builder.SetHavingClausePredicate(common::ManagedPointer(predicate));
   builder.SetAggregateStrategyType(aggr_type);
+  if (aggr_type == planner::AggregateStrategyType::HASH && groupby_cols->size() == 1) {
+    int64_t min_key, max_key;
+    if (GetGroupByKeyRange(groupby_cols->front(), &min_key, &max_key)) {
+      builder.SetGroupByKeyRange(min_key, max_key);
+    }
+  }
   builder.AddChild(std::move(children_plans_[0]));
   output_plan_ = builder.Build();
 }
 
+bool PlanGenerator::GetGroupByKeyRange(common::ManagedPointer<parser::AbstractExpression> groupby_col,
+                                       int64_t *min_key, int64_t *max_key) const {
+  if (stats_storage_ == nullptr || groupby_col->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) {
+    return false;
+  }
+  switch (groupby_col->GetReturnValueType()) {
+    case type::TypeId::TINYINT:
+    case type::TypeId::SMALLINT:
+    case type::TypeId::INTEGER:
+    case type::TypeId::BIGINT:
+      break;
+    default:
+      return false;
+  }
+  auto column = groupby_col.CastManagedPointerTo<parser::ColumnValueExpression>();
+  if (column->GetTableOid() == catalog::INVALID_TABLE_OID || column->GetColumnOid() == catalog::INVALID_COLUMN_OID) {
+    return false;
+  }
+
+  // Columns that were never analyzed have an empty histogram
+  const auto latched_table_stats_reference =
+      stats_storage_->GetTableStats(column->GetDatabaseOid(), column->GetTableOid(), accessor_);
+  const auto &table_stats = latched_table_stats_reference.table_stats_;
+  if (!table_stats.HasColumnStats(column->GetColumnOid())) {
+    return false;
+  }
+  auto column_stats = table_stats.GetColumnStats(column->GetColumnOid())
+                          .CastManagedPointerTo<ColumnStats<execution::sql::Integer>>();
+  auto histogram = column_stats->GetHistogram();
+  if (histogram == nullptr || histogram->GetTotalValueCount() == 0 ||
+      histogram->GetMinValue() > histogram->GetMaxValue()) {
+    return false;
+  }
+  *min_key = std::llround(histogram->GetMinValue());
+  *max_key = std::llround(histogram->GetMaxValue());
+  return true;
+}
+
 void PlanGenerator::Visit(const HashGroupBy *op) {
   auto having_predicates = parser::ExpressionUtil::JoinAnnotatedExprs(op->GetHaving());
   BuildAggregatePlan(planner::AggregateStrategyType::HASH, &op->GetColumns(),
@@ -902,6 +994,11 @@ void PlanGenerator::Visit(const Update *op) {
       parser::ExpressionUtil::GetTupleValueExprs(
           &cves, common::ManagedPointer(const_cast<parser::AbstractExpression *>(column.StoredExpression().Get())));
     }
+    // Updating a column of a partial index's predicate may add the tuple to the index or remove it
+    if (index.second.Predicate() != nullptr) {
+      parser::ExpressionUtil::GetTupleValueExprs(
+          &cves, common::ManagedPointer(const_cast<parser::AbstractExpression *>(index.second.Predicate().Get())));
+    }
   }
 
   std::unordered_set<std::string> update_column_names;
@@ -989,6 +1086,7 @@ void PlanGenerator::Visit(const CreateIndex *create_index) {
   }
   auto idx_schema = std::make_unique<catalog::IndexSchema>(std::move(cols), schema->Type(), schema->Unique(),
                                                            schema->Primary(), schema->Exclusion(), schema->Immediate());
+  if (schema->Predicate() != nullptr) idx_schema->SetPredicate(schema->Predicate()->Copy());
   auto out_schema = std::make_unique<planner::OutputSchema>();
 
   output_plan_ = planner::CreateIndexPlanNode::Builder()
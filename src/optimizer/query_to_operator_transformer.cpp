@@ -12,11 +12,14 @@
 #include "catalog/catalog_accessor.h"
 #include "common/macros.h"
 #include "common/managed_pointer.h"
+#include "execution/sql/functions/arithmetic_functions.h"
 #include "loggers/optimizer_logger.h"
 #include "optimizer/logical_operators.h"
 #include "optimizer/operator_node.h"
 #include "parser/expression/column_value_expression.h"
 #include "parser/expression/comparison_expression.h"
+#include "parser/expression/conjunction_expression.h"
+#include "parser/expression/constant_value_expression.h"
 #include "parser/expression/operator_expression.h"
 #include "parser/expression/subquery_expression.h"
 #include "parser/expression_util.h"
@@ -26,6 +29,153 @@
 
 namespace noisepage::optimizer {
 
+namespace {
+
+bool IsIntegral(const type::TypeId type) { return type >= type::TypeId::TINYINT && type <= type::TypeId::BIGINT; }
+
+// The constant that expr is, nullptr if it is anything else or NULL
+common::ManagedPointer<parser::ConstantValueExpression> NonNullConstant(
+    const common::ManagedPointer<parser::AbstractExpression> expr) {
+  if (expr->GetExpressionType() != parser::ExpressionType::VALUE_CONSTANT) return nullptr;
+  const auto constant = expr.CastManagedPointerTo<parser::ConstantValueExpression>();
+  return constant->IsNull() ? nullptr : constant;
+}
+
+// Whether expr is a boolean constant other than NULL, and which
+bool GetBoolConstant(const common::ManagedPointer<parser::AbstractExpression> expr, bool *const value) {
+  const auto constant = NonNullConstant(expr);
+  if (constant == nullptr || constant->GetReturnValueType() != type::TypeId::BOOLEAN) return false;
+  *value = constant->GetBoolVal().val_;
+  return true;
+}
+
+std::unique_ptr<parser::AbstractExpression> BoolConstant(const bool value) {
+  return std::make_unique<parser::ConstantValueExpression>(type::TypeId::BOOLEAN, execution::sql::BoolVal(value));
+}
+
+// Evaluates lhs op rhs with the functions the execution engine runs. Returns nullptr if the operands are not both
+// integers or both reals, or if the execution would report an error, which is left for it to do.
+std::unique_ptr<parser::AbstractExpression> FoldArithmetic(const parser::ExpressionType op,
+                                                           const type::TypeId result_type,
+                                                           const parser::ConstantValueExpression &lhs,
+                                                           const parser::ConstantValueExpression &rhs) {
+  using execution::sql::ArithmeticFunctions;
+  bool error = false;
+  if (IsIntegral(lhs.GetReturnValueType()) && IsIntegral(rhs.GetReturnValueType())) {
+    execution::sql::Integer result(0);
+    switch (op) {
+      case parser::ExpressionType::OPERATOR_PLUS:
+        ArithmeticFunctions::Add(&result, lhs.GetInteger(), rhs.GetInteger(), &error);
+        break;
+      case parser::ExpressionType::OPERATOR_MINUS:
+        ArithmeticFunctions::Sub(&result, lhs.GetInteger(), rhs.GetInteger(), &error);
+        break;
+      case parser::ExpressionType::OPERATOR_MULTIPLY:
+        ArithmeticFunctions::Mul(&result, lhs.GetInteger(), rhs.GetInteger(), &error);
+        break;
+      case parser::ExpressionType::OPERATOR_DIVIDE:
+        ArithmeticFunctions::IntDiv(&result, lhs.GetInteger(), rhs.GetInteger(), &error);
+        break;
+      case parser::ExpressionType::OPERATOR_MOD:
+        ArithmeticFunctions::IntMod(&result, lhs.GetInteger(), rhs.GetInteger(), &error);
+        break;
+      default:
+        return nullptr;
+    }
+    if (error) return nullptr;
+    return std::make_unique<parser::ConstantValueExpression>(result_type, result);
+  }
+  if (lhs.GetReturnValueType() == type::TypeId::REAL && rhs.GetReturnValueType() == type::TypeId::REAL) {
+    execution::sql::Real result(0.0);
+    switch (op) {
+      case parser::ExpressionType::OPERATOR_PLUS:
+        ArithmeticFunctions::Add(&result, lhs.GetReal(), rhs.GetReal());
+        break;
+      case parser::ExpressionType::OPERATOR_MINUS:
+        ArithmeticFunctions::Sub(&result, lhs.GetReal(), rhs.GetReal());
+        break;
+      case parser::ExpressionType::OPERATOR_MULTIPLY:
+        ArithmeticFunctions::Mul(&result, lhs.GetReal(), rhs.GetReal());
+        break;
+      case parser::ExpressionType::OPERATOR_DIVIDE:
+        ArithmeticFunctions::Div(&result, lhs.GetReal(), rhs.GetReal(), &error);
+        break;
+      case parser::ExpressionType::OPERATOR_MOD:
+        ArithmeticFunctions::Mod(&result, lhs.GetReal(), rhs.GetReal(), &error);
+        break;
+      default:
+        return nullptr;
+    }
+    if (error) return nullptr;
+    return std::make_unique<parser::ConstantValueExpression>(result_type, result);
+  }
+  return nullptr;
+}
+
+// Whether the constant on the given side of op leaves the other operand as it is, like the 1 of x * 1
+bool IsIdentity(const parser::ExpressionType op, const parser::ConstantValueExpression &constant, const bool on_right) {
+  double value;
+  if (IsIntegral(constant.GetReturnValueType())) {
+    value = static_cast<double>(constant.GetInteger().val_);
+  } else if (constant.GetReturnValueType() == type::TypeId::REAL) {
+    value = constant.GetReal().val_;
+  } else {
+    return false;
+  }
+  switch (op) {
+    case parser::ExpressionType::OPERATOR_PLUS:
+      return value == 0;
+    case parser::ExpressionType::OPERATOR_MINUS:
+      return on_right && value == 0;
+    case parser::ExpressionType::OPERATOR_MULTIPLY:
+      return value == 1;
+    case parser::ExpressionType::OPERATOR_DIVIDE:
+      return on_right && value == 1;
+    default:
+      return false;
+  }
+}
+
+template <typename T>
+bool Compare(const parser::ExpressionType op, const T &lhs, const T &rhs) {
+  switch (op) {
+    case parser::ExpressionType::COMPARE_EQUAL:
+      return lhs == rhs;
+    case parser::ExpressionType::COMPARE_NOT_EQUAL:
+      return lhs != rhs;
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+      return lhs < rhs;
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+      return lhs <= rhs;
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+      return lhs > rhs;
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      return lhs >= rhs;
+    default:
+      UNREACHABLE("Not a comparison of two values.");
+  }
+}
+
+// Evaluates lhs op rhs, nullptr if the constants are not of types that compare as they are stored
+std::unique_ptr<parser::AbstractExpression> FoldComparison(const parser::ExpressionType op,
+                                                           const parser::ConstantValueExpression &lhs,
+                                                           const parser::ConstantValueExpression &rhs) {
+  const type::TypeId lhs_type = lhs.GetReturnValueType();
+  const type::TypeId rhs_type = rhs.GetReturnValueType();
+  if (IsIntegral(lhs_type) && IsIntegral(rhs_type)) {
+    return BoolConstant(Compare(op, lhs.GetInteger().val_, rhs.GetInteger().val_));
+  }
+  if (lhs_type == type::TypeId::REAL && rhs_type == type::TypeId::REAL) {
+    return BoolConstant(Compare(op, lhs.GetReal().val_, rhs.GetReal().val_));
+  }
+  if (lhs_type == type::TypeId::BOOLEAN && rhs_type == type::TypeId::BOOLEAN) {
+    return BoolConstant(Compare(op, lhs.GetBoolVal().val_, rhs.GetBoolVal().val_));
+  }
+  return nullptr;
+}
+
+}  // namespace
+
 QueryToOperatorTransformer::QueryToOperatorTransformer(
     const common::ManagedPointer<catalog::CatalogAccessor> catalog_accessor, const catalog::db_oid_t db_oid)
     : accessor_(catalog_accessor), db_oid_(db_oid) {
@@ -346,7 +496,8 @@ void QueryToOperatorTransformer::Visit(common::ManagedPointer<parser::CreateStat
       }
       create_expr = std::make_unique<OperatorNode>(
           LogicalCreateIndex::Make(accessor_->GetDefaultNamespace(), accessor_->GetTableOid(op->GetTableName()),
-                                   op->GetIndexType(), op->IsUniqueIndex(), op->GetIndexName(), std::move(entries))
+                                   op->GetIndexType(), op->IsUniqueIndex(), op->GetIndexName(), std::move(entries),
+                                   op->GetIndexPredicate())
               .RegisterWithTxnContext(txn_context),
           std::vector<std::unique_ptr<AbstractOptimizerNode>>{}, txn_context);
       break;
@@ -377,6 +528,10 @@ void QueryToOperatorTransformer::Visit(common::ManagedPointer<parser::CreateStat
               .RegisterWithTxnContext(txn_context),
           std::vector<std::unique_ptr<AbstractOptimizerNode>>{}, txn_context);
       break;
+    case parser::CreateStatement::CreateType::kMaterializedView:
+      // The view's query is planned, and the TrafficCop creates and fills the table from the output of the plan
+      op->GetViewQuery()->Accept(common::ManagedPointer(this).CastManagedPointerTo<SqlNodeVisitor>());
+      return;
   }
 
   output_expr_ = std::move(create_expr);
@@ -456,7 +611,7 @@ void QueryToOperatorTransformer::Visit(common::ManagedPointer<parser::DeleteStat
   std::unique_ptr<OperatorNode> table_scan;
   if (op->GetDeleteCondition() != nullptr) {
     std::vector<AnnotatedExpression> predicates;
-    QueryToOperatorTransformer::ExtractPredicates(op->GetDeleteCondition(), &predicates);
+    QueryToOperatorTransformer::ExtractPredicates(SimplifyExpression(op->GetDeleteCondition()), &predicates);
     table_scan = std::make_unique<OperatorNode>(
         LogicalGet::Make(target_db_id, target_table_id, predicates, target_table_alias, true)
             .RegisterWithTxnContext(txn_context),
@@ -537,7 +692,7 @@ void QueryToOperatorTransformer::Visit(common::ManagedPointer<parser::UpdateStat
 
   if (op->GetUpdateCondition() != nullptr) {
     std::vector<AnnotatedExpression> predicates;
-    QueryToOperatorTransformer::ExtractPredicates(op->GetUpdateCondition(), &predicates);
+    QueryToOperatorTransformer::ExtractPredicates(SimplifyExpression(op->GetUpdateCondition()), &predicates);
     table_scan = std::make_unique<OperatorNode>(
         LogicalGet::Make(target_db_id, target_table_id, predicates, target_table_alias, true)
             .RegisterWithTxnContext(txn_context),
@@ -704,7 +859,109 @@ void QueryToOperatorTransformer::CollectPredicates(common::ManagedPointer<parser
   // (a IN test.b), after the rewrite, we can extract the table aliases
   // information correctly
   expr->Accept(common::ManagedPointer(this).CastManagedPointerTo<SqlNodeVisitor>());
-  QueryToOperatorTransformer::ExtractPredicates(expr, predicates);
+  QueryToOperatorTransformer::ExtractPredicates(SimplifyExpression(expr), predicates);
+}
+
+common::ManagedPointer<parser::AbstractExpression> QueryToOperatorTransformer::SimplifyExpression(
+    const common::ManagedPointer<parser::AbstractExpression> expr) {
+  if (expr == nullptr) return expr;
+  auto simplified = Simplify(expr);
+  if (simplified == nullptr) return expr;
+  parse_result_->AddExpression(std::move(simplified));
+  return common::ManagedPointer(parse_result_->GetExpressions().back());
+}
+
+std::unique_ptr<parser::AbstractExpression> QueryToOperatorTransformer::Simplify(
+    const common::ManagedPointer<parser::AbstractExpression> expr) {
+  const parser::ExpressionType type = expr->GetExpressionType();
+  // Aggregates are matched against the ones of the select list by what they are written as
+  if (parser::ExpressionUtil::IsAggregateExpression(type) || type == parser::ExpressionType::ROW_SUBQUERY) {
+    return nullptr;
+  }
+  for (size_t i = 0; i < expr->GetChildrenSize(); i++) {
+    const auto simplified = Simplify(expr->GetChild(i));
+    if (simplified != nullptr) expr->SetChild(static_cast<int>(i), common::ManagedPointer(simplified));
+  }
+
+  switch (type) {
+    case parser::ExpressionType::OPERATOR_CAST: {
+      // The binder already converted a constant to the type it is cast to
+      const auto child = expr->GetChild(0);
+      if (child->GetExpressionType() != parser::ExpressionType::VALUE_CONSTANT ||
+          child->GetReturnValueType() != expr->GetReturnValueType()) {
+        return nullptr;
+      }
+      return child->Copy();
+    }
+    case parser::ExpressionType::OPERATOR_PLUS:
+    case parser::ExpressionType::OPERATOR_MINUS:
+    case parser::ExpressionType::OPERATOR_MULTIPLY:
+    case parser::ExpressionType::OPERATOR_DIVIDE:
+    case parser::ExpressionType::OPERATOR_MOD: {
+      if (expr->GetChildrenSize() != 2) return nullptr;
+      const auto lhs = NonNullConstant(expr->GetChild(0));
+      const auto rhs = NonNullConstant(expr->GetChild(1));
+      if (lhs != nullptr && rhs != nullptr) return FoldArithmetic(type, expr->GetReturnValueType(), *lhs, *rhs);
+      // Only drop the constant if the other operand already has the type of the result
+      for (size_t i = 0; i < 2; i++) {
+        const auto constant = i == 0 ? lhs : rhs;
+        const auto other = expr->GetChild(1 - i);
+        if (constant != nullptr && other->GetReturnValueType() == expr->GetReturnValueType() &&
+            IsIdentity(type, *constant, i == 1)) {
+          return other->Copy();
+        }
+      }
+      return nullptr;
+    }
+    case parser::ExpressionType::OPERATOR_NOT: {
+      bool value;
+      return GetBoolConstant(expr->GetChild(0), &value) ? BoolConstant(!value) : nullptr;
+    }
+    case parser::ExpressionType::CONJUNCTION_AND:
+    case parser::ExpressionType::CONJUNCTION_OR: {
+      // TRUE is dropped from an AND and decides an OR, FALSE the other way around. NULL stays: NULL AND TRUE is NULL.
+      const bool is_and = type == parser::ExpressionType::CONJUNCTION_AND;
+      std::vector<std::unique_ptr<parser::AbstractExpression>> kept;
+      bool dropped = false;
+      for (const auto &child : expr->GetChildren()) {
+        bool value;
+        if (!GetBoolConstant(child, &value)) {
+          kept.emplace_back(child->Copy());
+        } else if (value == is_and) {
+          dropped = true;
+        } else {
+          return BoolConstant(value);
+        }
+      }
+      if (!dropped) return nullptr;
+      if (kept.empty()) return BoolConstant(is_and);
+      if (kept.size() == 1) return std::move(kept[0]);
+      auto conjunction = std::make_unique<parser::ConjunctionExpression>(type, std::move(kept));
+      conjunction->DeriveDepth();
+      conjunction->DeriveSubqueryFlag();
+      return conjunction;
+    }
+    case parser::ExpressionType::COMPARE_EQUAL:
+    case parser::ExpressionType::COMPARE_NOT_EQUAL:
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO: {
+      const auto lhs = NonNullConstant(expr->GetChild(0));
+      const auto rhs = NonNullConstant(expr->GetChild(1));
+      if (lhs != nullptr && rhs != nullptr) return FoldComparison(type, *lhs, *rhs);
+      // Put the column first, which is the shape the filters of the execution engine are the fastest for
+      if (parser::ExpressionUtil::IsConstCompareWithColumn(*expr)) {
+        const auto value = expr->GetChild(0)->Copy();
+        expr->SetChild(0, expr->GetChild(1));
+        expr->SetChild(1, common::ManagedPointer(value));
+        expr->SetExpressionType(parser::ExpressionUtil::ReverseComparisonExpressionType(type));
+      }
+      return nullptr;
+    }
+    default:
+      return nullptr;
+  }
 }
 
 bool QueryToOperatorTransformer::IsSupportedConjunctivePredicate(
@@ -819,6 +1076,10 @@ void QueryToOperatorTransformer::ExtractPredicates(common::ManagedPointer<parser
   QueryToOperatorTransformer::SplitPredicates(expr, &predicates);
 
   for (auto predicate : predicates) {
+    // What was simplified to TRUE filters nothing
+    bool value;
+    if (GetBoolConstant(predicate, &value) && value) continue;
+
     std::unordered_set<std::string> table_alias_set;
     QueryToOperatorTransformer::GenerateTableAliasSet(predicate, &table_alias_set);
 
@@ -1,5 +1,6 @@
 #include "optimizer/rules/implementation_rules.h"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -18,6 +19,7 @@
 #include "optimizer/properties.h"
 #include "optimizer/util.h"
 #include "parser/expression_util.h"
+#include "storage/index/index.h"
 #include "storage/storage_defs.h"
 
 namespace noisepage::optimizer {
@@ -126,6 +128,8 @@ void LogicalGetToPhysicalIndexScan::Transform(common::ManagedPointer<AbstractOpt
     if (IndexUtil::CheckSortProperty(sort_prop)) {
       auto indexes = accessor->GetIndexOids(get->GetTableOid());
       for (auto index : indexes) {
+        // Indexes that are still being built may miss tuples
+        if (!accessor->IsIndexValid(index)) continue;
         if (IndexUtil::SatisfiesSortWithIndex(accessor, sort_prop, get->GetTableOid(), index)) {
           std::vector<AnnotatedExpression> preds = get->GetPredicates();
           planner::IndexScanType scan_type;
@@ -148,6 +152,7 @@ void LogicalGetToPhysicalIndexScan::Transform(common::ManagedPointer<AbstractOpt
     // Find match index for the predicates
     auto indexes = accessor->GetIndexOids(get->GetTableOid());
     for (auto &index : indexes) {
+      if (!accessor->IsIndexValid(index)) continue;
       planner::IndexScanType scan_type;
       std::unordered_map<catalog::indexkeycol_oid_t, std::vector<planner::IndexExpression>> bounds;
       std::vector<AnnotatedExpression> preds = get->GetPredicates();
@@ -624,6 +629,100 @@ void LogicalInnerJoinToPhysicalInnerHashJoin::Transform(
   }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+/// LogicalInnerJoinToPhysicalInnerMergeJoin
+///////////////////////////////////////////////////////////////////////////////
+LogicalInnerJoinToPhysicalInnerMergeJoin::LogicalInnerJoinToPhysicalInnerMergeJoin() {
+  type_ = RuleType::INNER_JOIN_TO_MERGE_JOIN;
+
+  auto left_child(new Pattern(OpType::LEAF));
+  auto right_child(new Pattern(OpType::LEAF));
+
+  // Initialize a pattern for optimizer to match
+  match_pattern_ = new Pattern(OpType::LOGICALINNERJOIN);
+
+  // Add node - we match join relation R and S
+  match_pattern_->AddChild(left_child);
+  match_pattern_->AddChild(right_child);
+}
+
+bool LogicalInnerJoinToPhysicalInnerMergeJoin::Check(common::ManagedPointer<AbstractOptimizerNode> plan,
+                                                     OptimizationContext *context) const {
+  (void)context;
+  (void)plan;
+  return true;
+}
+
+size_t LogicalInnerJoinToPhysicalInnerMergeJoin::NumIndexOrderedKeys(
+    OptimizationContext *context, group_id_t group_id,
+    const std::vector<common::ManagedPointer<parser::AbstractExpression>> &keys) {
+  auto *accessor = context->GetOptimizerContext()->GetCatalogAccessor();
+  auto *group = context->GetOptimizerContext()->GetMemo().GetGroupByID(group_id);
+
+  size_t num_keys = 0;
+  for (const auto *gexpr : group->GetLogicalExpressions()) {
+    if (gexpr->Contents()->GetOpType() != OpType::LOGICALGET) continue;
+    const auto get = gexpr->Contents()->GetContentsAs<LogicalGet>();
+    if (get->GetTableOid() == catalog::INVALID_TABLE_OID) continue;
+
+    for (auto index : accessor->GetIndexOids(get->GetTableOid())) {
+      // Indexes that are still being built may miss tuples
+      if (!accessor->IsIndexValid(index)) continue;
+      for (size_t prefix_size = keys.size(); prefix_size > num_keys; prefix_size--) {
+        PropertySort sort({keys.begin(), keys.begin() + prefix_size},
+                          std::vector<OrderByOrderingType>(prefix_size, OrderByOrderingType::ASC));
+        if (IndexUtil::CheckSortProperty(&sort) &&
+            IndexUtil::SatisfiesSortWithIndex(accessor, &sort, get->GetTableOid(), index)) {
+          num_keys = prefix_size;
+          break;
+        }
+      }
+    }
+  }
+  return num_keys;
+}
+
+void LogicalInnerJoinToPhysicalInnerMergeJoin::Transform(
+    common::ManagedPointer<AbstractOptimizerNode> input,
+    std::vector<std::unique_ptr<AbstractOptimizerNode>> *transformed,
+    UNUSED_ATTRIBUTE OptimizationContext *context) const {
+  const auto inner_join = input->Contents()->GetContentsAs<LogicalInnerJoin>();
+
+  auto children = input->GetChildren();
+  NOISEPAGE_ASSERT(children.size() == 2, "Inner Join should have two children");
+  auto left_group_id = children[0]->Contents()->GetContentsAs<LeafOperator>()->GetOriginGroup();
+  auto right_group_id = children[1]->Contents()->GetContentsAs<LeafOperator>()->GetOriginGroup();
+  auto &left_group_alias = context->GetOptimizerContext()->GetMemo().GetGroupByID(left_group_id)->GetTableAliases();
+  auto &right_group_alias = context->GetOptimizerContext()->GetMemo().GetGroupByID(right_group_id)->GetTableAliases();
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> left_keys;
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> right_keys;
+
+  std::vector<AnnotatedExpression> join_preds = inner_join->GetJoinPredicates();
+  OptimizerUtil::ExtractEquiJoinKeys(join_preds, &left_keys, &right_keys, left_group_alias, right_group_alias);
+  NOISEPAGE_ASSERT(right_keys.size() == left_keys.size(), "# left/right keys should equal");
+
+  // The cost model cannot tell a sort apart from an index that already
+  // provides the order, so only merge when both sides are scans an index
+  // produces in key order. The merge is on the leading keys both indexes
+  // order on, the join predicate checks the rest.
+  auto num_keys = std::min(NumIndexOrderedKeys(context, left_group_id, left_keys),
+                           NumIndexOrderedKeys(context, right_group_id, right_keys));
+  if (num_keys == 0) {
+    return;
+  }
+  left_keys.resize(num_keys);
+  right_keys.resize(num_keys);
+
+  std::vector<std::unique_ptr<AbstractOptimizerNode>> child;
+  child.emplace_back(children[0]->Copy());
+  child.emplace_back(children[1]->Copy());
+  auto result = std::make_unique<OperatorNode>(
+      InnerMergeJoin::Make(std::move(join_preds), std::move(left_keys), std::move(right_keys))
+          .RegisterWithTxnContext(context->GetOptimizerContext()->GetTxn()),
+      std::move(child), context->GetOptimizerContext()->GetTxn());
+  transformed->emplace_back(std::move(result));
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 /// LogicalSemiJoinToPhysicalSemiLeftHashJoin
 ///////////////////////////////////////////////////////////////////////////////
@@ -922,6 +1021,9 @@ void LogicalCreateIndexToPhysicalCreateIndex::Transform(
     case parser::IndexType::BPLUSTREE:
       idx_type = storage::index::IndexType::BPLUSTREE;
       break;
+    case parser::IndexType::ART:
+      idx_type = storage::index::IndexType::ART;
+      break;
     default:
       NOISEPAGE_ASSERT(false, "Unsupported index type encountered");
       break;
@@ -931,6 +1033,7 @@ void LogicalCreateIndexToPhysicalCreateIndex::Transform(
                                                        false,   // is_primary
                                                        false,   // is_exclusion
                                                        false);  // is_immediate
+  if (ci_op->GetIndexPredicate() != nullptr) schema->SetPredicate(ci_op->GetIndexPredicate()->Copy());
 
   auto op = std::make_unique<OperatorNode>(
       CreateIndex::Make(ci_op->GetNamespaceOid(), ci_op->GetTableOid(), ci_op->GetIndexName(), std::move(schema))
@@ -22,6 +22,20 @@
 
 namespace noisepage::optimizer {
 
+namespace {
+
+// Adds the predicates implied by the equalities between columns among them, @see
+// OptimizerUtil::InferTransitivePredicates. The txn frees the expressions of the inferred predicates.
+void AddTransitivePredicates(std::vector<AnnotatedExpression> *predicates, OptimizationContext *context) {
+  std::vector<std::unique_ptr<parser::AbstractExpression>> inferred_exprs;
+  OptimizerUtil::InferTransitivePredicates(predicates, &inferred_exprs);
+  for (auto &expr : inferred_exprs) {
+    context->GetOptimizerContext()->RegisterExprWithTxn(expr.release());
+  }
+}
+
+}  // namespace
+
 ///////////////////////////////////////////////////////////////////////////////
 /// PushFilterThroughJoin
 ///////////////////////////////////////////////////////////////////////////////
@@ -54,7 +68,8 @@ void RewritePushImplicitFilterThroughJoin::Transform(common::ManagedPointer<Abst
 
   const auto &left_group_aliases_set = memo.GetGroupByID(left_group_id)->GetTableAliases();
   const auto &right_group_aliases_set = memo.GetGroupByID(right_group_id)->GetTableAliases();
-  auto &predicates = input->Contents()->GetContentsAs<LogicalInnerJoin>()->GetJoinPredicates();
+  auto predicates = input->Contents()->GetContentsAs<LogicalInnerJoin>()->GetJoinPredicates();
+  AddTransitivePredicates(&predicates, context);
 
   std::vector<AnnotatedExpression> left_predicates;
   std::vector<AnnotatedExpression> right_predicates;
@@ -166,16 +181,10 @@ void RewritePushExplicitFilterThroughJoin::Transform(common::ManagedPointer<Abst
   // already extract these predicates from the original.
   // E.g. An expression (test.a = test1.b and test.a = 5) would become
   // {test.a = test1.b, test.a = 5}
-  for (auto &predicate : input_join_predicates) {
-    if (OptimizerUtil::IsSubset(left_group_aliases_set, predicate.GetTableAliasSet())) {
-      left_predicates.emplace_back(predicate);
-    } else if (OptimizerUtil::IsSubset(right_group_aliases_set, predicate.GetTableAliasSet())) {
-      right_predicates.emplace_back(predicate);
-    } else {
-      join_predicates.emplace_back(predicate);
-    }
-  }
-  for (auto &predicate : filter_predicates) {
+  std::vector<AnnotatedExpression> predicates = input_join_predicates;
+  predicates.insert(predicates.end(), filter_predicates.begin(), filter_predicates.end());
+  AddTransitivePredicates(&predicates, context);
+  for (auto &predicate : predicates) {
     if (OptimizerUtil::IsSubset(left_group_aliases_set, predicate.GetTableAliasSet())) {
       left_predicates.emplace_back(predicate);
     } else if (OptimizerUtil::IsSubset(right_group_aliases_set, predicate.GetTableAliasSet())) {
@@ -83,9 +83,9 @@ LogicalInnerJoinAssociativity::LogicalInnerJoinAssociativity() {
 
 bool LogicalInnerJoinAssociativity::Check(common::ManagedPointer<AbstractOptimizerNode> plan,
                                           OptimizationContext *context) const {
-  (void)context;
   (void)plan;
-  return true;
+  // The JoinOrderEnumerator already picked the join tree, and reassociating it would undo that
+  return !context->GetOptimizerContext()->JoinsOrdered();
 }
 
 void LogicalInnerJoinAssociativity::Transform(common::ManagedPointer<AbstractOptimizerNode> input,
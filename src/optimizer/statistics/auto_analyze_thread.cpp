@@ -0,0 +1,164 @@
+#include "optimizer/statistics/auto_analyze_thread.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "catalog/catalog_accessor.h"
+#include "catalog/database_catalog.h"
+#include "execution/compiler/compilation_context.h"
+#include "execution/compiler/executable_query.h"
+#include "execution/exec/execution_context.h"
+#include "execution/exec/execution_settings.h"
+#include "execution/exec/output.h"
+#include "loggers/optimizer_logger.h"
+#include "optimizer/cost_model/trivial_cost_model.h"
+#include "optimizer/logical_operators.h"
+#include "optimizer/operator_node.h"
+#include "optimizer/optimize_result.h"
+#include "optimizer/optimizer.h"
+#include "optimizer/property_set.h"
+#include "planner/plannodes/abstract_plan_node.h"
+#include "settings/settings_manager.h"
+#include "storage/sql_table.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace noisepage::optimizer {
+
+AutoAnalyzeThread::AutoAnalyzeThread(common::ManagedPointer<catalog::Catalog> catalog,
+                                     common::ManagedPointer<transaction::TransactionManager> txn_manager,
+                                     common::ManagedPointer<StatsStorage> stats_storage,
+                                     common::ManagedPointer<settings::SettingsManager> settings_manager,
+                                     std::chrono::microseconds interval, uint64_t threshold, double scale_factor,
+                                     uint64_t optimizer_timeout)
+    : catalog_(catalog),
+      txn_manager_(txn_manager),
+      stats_storage_(stats_storage),
+      settings_manager_(settings_manager),
+      interval_(interval),
+      threshold_(threshold),
+      scale_factor_(scale_factor),
+      optimizer_timeout_(optimizer_timeout),
+      run_(true),
+      auto_analyze_thread_(std::thread([this] { AutoAnalyzeThreadLoop(); })) {}
+
+void AutoAnalyzeThread::StopAutoAnalyze() {
+  {
+    std::lock_guard<std::mutex> guard(run_mutex_);
+    if (!run_) return;
+    run_ = false;
+  }
+  run_cvar_.notify_all();
+  auto_analyze_thread_.join();
+}
+
+void AutoAnalyzeThread::AutoAnalyzeThreadLoop() {
+  std::unique_lock<std::mutex> lock(run_mutex_);
+  while (!run_cvar_.wait_for(lock, interval_, [this] { return !run_; })) {
+    lock.unlock();
+    AnalyzeModifiedTables();
+    lock.lock();
+  }
+}
+
+uint32_t AutoAnalyzeThread::AnalyzeModifiedTables() {
+  // Find the tables to analyze in one read-only transaction, and then analyze each of them in a transaction of its own
+  std::vector<std::pair<TableStatsKey, uint64_t>> to_analyze;
+  std::unordered_map<TableStatsKey, uint64_t> analyzed_modifications;
+  auto *txn = txn_manager_->BeginTransaction();
+  const auto common_txn = common::ManagedPointer(txn);
+  for (const auto db_oid : catalog_->GetDatabaseOids(common_txn)) {
+    auto db_catalog = catalog_->GetDatabaseCatalog(common_txn, db_oid);
+    if (db_catalog == nullptr) continue;
+    auto accessor = catalog_->GetAccessor(common_txn, db_oid, DISABLED);
+    for (const auto table_oid : db_catalog->GetTableOids(common_txn)) {
+      // The statistics of the catalog tables are not used for planning.
+      if (table_oid.UnderlyingValue() < catalog::START_OID) continue;
+      const auto table = db_catalog->GetTable(common_txn, table_oid);
+      if (table == nullptr) continue;
+
+      const TableStatsKey key{db_oid, table_oid};
+      const uint64_t num_modifications = table->GetNumModifications();
+      const auto analyzed_it = analyzed_modifications_.find(key);
+      const uint64_t analyzed = analyzed_it == analyzed_modifications_.end() ? 0 : analyzed_it->second;
+      analyzed_modifications.emplace(key, analyzed);
+      if (num_modifications - analyzed <= threshold_) continue;
+
+      const auto num_rows = stats_storage_->GetTableStats(db_oid, table_oid, accessor.get()).table_stats_.GetNumRows();
+      if (static_cast<double>(num_modifications - analyzed - threshold_) <= scale_factor_ * num_rows) continue;
+      to_analyze.emplace_back(key, num_modifications);
+    }
+  }
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  // Only the tables that still exist are remembered
+  analyzed_modifications_ = std::move(analyzed_modifications);
+
+  uint32_t num_analyzed = 0;
+  for (const auto &[key, num_modifications] : to_analyze) {
+    if (!AnalyzeTable(key.db_oid_, key.table_oid_)) continue;
+    // Modifications that committed after the count was read are picked up by the next check.
+    analyzed_modifications_[key] = num_modifications;
+    num_analyzed++;
+  }
+  return num_analyzed;
+}
+
+bool AutoAnalyzeThread::AnalyzeTable(const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid) {
+  auto *txn = txn_manager_->BeginTransaction();
+  const auto common_txn = common::ManagedPointer(txn);
+  auto accessor = catalog_->GetAccessor(common_txn, db_oid, DISABLED);
+
+  std::vector<catalog::col_oid_t> col_oids;
+  for (const auto &column : accessor->GetSchema(table_oid).GetColumns()) col_oids.emplace_back(column.Oid());
+
+  try {
+    // The same operators that the QueryToOperatorTransformer builds for "ANALYZE table"
+    std::vector<catalog::col_oid_t> analyze_cols = col_oids;
+    auto analyze_expr = std::make_unique<OperatorNode>(
+        LogicalAnalyze::Make(db_oid, table_oid, std::move(analyze_cols)).RegisterWithTxnContext(txn),
+        std::vector<std::unique_ptr<AbstractOptimizerNode>>{}, txn);
+    auto aggregate_expr =
+        std::make_unique<OperatorNode>(LogicalAggregateAndGroupBy::Make().RegisterWithTxnContext(txn),
+                                       std::vector<std::unique_ptr<AbstractOptimizerNode>>{}, txn);
+    auto get_expr = std::make_unique<OperatorNode>(
+        LogicalGet::Make(db_oid, table_oid, {}, "", false).RegisterWithTxnContext(txn),
+        std::vector<std::unique_ptr<AbstractOptimizerNode>>{}, txn);
+    aggregate_expr->PushChild(std::move(get_expr));
+    analyze_expr->PushChild(std::move(aggregate_expr));
+
+    Optimizer optimizer(std::make_unique<TrivialCostModel>(), optimizer_timeout_);
+    PropertySet property_set;
+    QueryInfo query_info(parser::StatementType::ANALYZE, {}, &property_set);
+    auto optimize_result = optimizer.BuildPlanTree(txn, accessor.get(), stats_storage_.Get(), query_info,
+                                                   std::move(analyze_expr), nullptr);
+    const auto plan = optimize_result->GetPlanNode();
+
+    execution::exec::ExecutionSettings exec_settings{};
+    if (settings_manager_ != DISABLED) exec_settings.UpdateFromSettingsManager(settings_manager_);
+    execution::exec::NoOpResultConsumer consumer;
+    execution::exec::OutputCallback callback = consumer;
+    auto exec_query = execution::compiler::CompilationContext::Compile(*plan, exec_settings, accessor.get(),
+                                                                       execution::compiler::CompilationMode::OneShot);
+    auto exec_ctx = std::make_unique<execution::exec::ExecutionContext>(
+        db_oid, common_txn, callback, plan->GetOutputSchema().Get(), common::ManagedPointer(accessor), exec_settings,
+        DISABLED, DISABLED, DISABLED);
+    exec_query->Run(common::ManagedPointer(exec_ctx), execution::vm::ExecutionMode::Interpret);
+  } catch (const std::exception &e) {
+    OPTIMIZER_LOG_WARN("Automatic ANALYZE of table {} in database {} failed: {}", table_oid.UnderlyingValue(),
+                       db_oid.UnderlyingValue(), e.what());
+    txn->SetMustAbort();
+  }
+
+  // A concurrent ANALYZE of the same table makes this one conflict on pg_statistic
+  if (txn->MustAbort()) {
+    txn_manager_->Abort(txn);
+    return false;
+  }
+  txn->RegisterCommitAction([=]() { stats_storage_->MarkStatsStale(db_oid, table_oid, col_oids); });
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  return true;
+}
+
+}  // namespace noisepage::optimizer
@@ -1,5 +1,7 @@
 #include "optimizer/statistics/selectivity_util.h"
 
+#include <unordered_map>
+
 #include "loggers/optimizer_logger.h"
 #include "parser/expression_defs.h"
 
@@ -58,6 +60,89 @@ double SelectivityUtil::ComputeSelectivity(const TableStats &table_stats, const
   }
 }
 
+double SelectivityUtil::ComputeJoinSelectivity(const DerivedColumnStats &left_stats,
+                                               const DerivedColumnStats &right_stats) {
+  const double left_distinct = std::max(left_stats.GetDistinctValues(), 1.0);
+  const double right_distinct = std::max(right_stats.GetDistinctValues(), 1.0);
+  const double left_non_null = 1.0 - left_stats.GetFracNull();
+  const double right_non_null = 1.0 - right_stats.GetFracNull();
+  const auto &left_mcvs = left_stats.GetMostCommonValues();
+  const auto &right_mcvs = right_stats.GetMostCommonValues();
+  if (left_mcvs.empty() || right_mcvs.empty()) {
+    // Every value of the side with fewer distinct values is assumed to find its match on the other side
+    return left_non_null * right_non_null / std::max(left_distinct, right_distinct);
+  }
+
+  std::unordered_map<hash_t, double> right_frequencies(right_mcvs.begin(), right_mcvs.end());
+  double match_frequency = 0;
+  double left_matched = 0;
+  double right_matched = 0;
+  double left_common = 0;
+  double right_common = 0;
+  double num_matches = 0;
+  for (const auto &[value, frequency] : left_mcvs) {
+    left_common += frequency;
+    const auto it = right_frequencies.find(value);
+    if (it == right_frequencies.end()) continue;
+    match_frequency += frequency * it->second;
+    left_matched += frequency;
+    right_matched += it->second;
+    num_matches++;
+  }
+  for (const auto &[value, frequency] : right_mcvs) right_common += frequency;
+
+  const double left_unmatched = std::max(left_common - left_matched, 0.0);
+  const double right_unmatched = std::max(right_common - right_matched, 0.0);
+  const double left_other = std::max(left_non_null - left_common, 0.0);
+  const double right_other = std::max(right_non_null - right_common, 0.0);
+  const auto left_num_mcvs = static_cast<double>(left_mcvs.size());
+  const auto right_num_mcvs = static_cast<double>(right_mcvs.size());
+
+  // The unmatched common values of one side can only match the values of the other side that are not common ones,
+  // and the other values of one side match any of the values of the other side that were not matched
+  double left_selectivity = match_frequency;
+  if (right_distinct > right_num_mcvs) {
+    left_selectivity += left_unmatched * right_other / (right_distinct - right_num_mcvs);
+  }
+  if (right_distinct > num_matches) {
+    left_selectivity += left_other * (right_other + right_unmatched) / (right_distinct - num_matches);
+  }
+  double right_selectivity = match_frequency;
+  if (left_distinct > left_num_mcvs) {
+    right_selectivity += right_unmatched * left_other / (left_distinct - left_num_mcvs);
+  }
+  if (left_distinct > num_matches) {
+    right_selectivity += right_other * (left_other + left_unmatched) / (left_distinct - num_matches);
+  }
+  return std::clamp(std::min(left_selectivity, right_selectivity), 0.0, 1.0);
+}
+
+double SelectivityUtil::ComputeSemiJoinSelectivity(const DerivedColumnStats &left_stats,
+                                                   const DerivedColumnStats &right_stats) {
+  double left_distinct = std::max(left_stats.GetDistinctValues(), 1.0);
+  double right_distinct = std::max(right_stats.GetDistinctValues(), 1.0);
+  const double left_non_null = 1.0 - left_stats.GetFracNull();
+
+  double match_frequency = 0;
+  double num_matches = 0;
+  const auto &right_mcvs = right_stats.GetMostCommonValues();
+  if (!right_mcvs.empty()) {
+    std::unordered_map<hash_t, double> right_frequencies(right_mcvs.begin(), right_mcvs.end());
+    for (const auto &[value, frequency] : left_stats.GetMostCommonValues()) {
+      if (right_frequencies.count(value) == 0) continue;
+      match_frequency += frequency;
+      num_matches++;
+    }
+  }
+
+  // The distinct values that are known to match are left out of the guess for the rest of the rows
+  left_distinct -= num_matches;
+  right_distinct -= num_matches;
+  const double uncertain_frac = left_distinct <= right_distinct ? 1.0 : std::max(right_distinct, 0.0) / left_distinct;
+  const double uncertain = std::clamp(left_non_null - match_frequency, 0.0, 1.0);
+  return std::clamp(match_frequency + uncertain_frac * uncertain, 0.0, 1.0);
+}
+
 template <typename T>
 double SelectivityUtil::ComputeSelectivity(common::ManagedPointer<ColumnStats<T>> column_stats,
                                            const ValueCondition &condition) {
@@ -108,8 +193,11 @@ double SelectivityUtil::LessThanOrEqualTo(common::ManagedPointer<ColumnStats<T>>
 
   if (histogram->IsLessThanMinValue(value)) return 0;
   if (histogram->IsGreaterThanOrEqualToMaxValue(value)) return 1.0 - column_stats->GetFracNull();
-  double res =
-      static_cast<double>(histogram->EstimateItemCount(value)) / static_cast<double>(column_stats->GetNumRows());
+  // ANALYZE may have built the histogram over a sample of the table, so its counts are scaled up to the column
+  const double total = histogram->GetTotalValueCount();
+  const double scale = total > 0 ? static_cast<double>(column_stats->GetNonNullRows()) / total : 1.0;
+  double res = static_cast<double>(histogram->EstimateItemCount(value)) * scale /
+               static_cast<double>(column_stats->GetNumRows());
   // There is a possibility that histogram's <= estimate is lesser than it is supposed to be.
   // In the case where the estimate is smaller than estimate for equal, we adjust the selectivity to
   // that of the Equal operator.
@@ -135,7 +223,10 @@ double SelectivityUtil::Equal(common::ManagedPointer<ColumnStats<T>> column_stat
   // Find frequency of the value if present in the top K elements.
   auto value_frequency_estimate = top_k->EstimateItemCount(value);
 
-  double res = value_frequency_estimate / static_cast<double>(numrows);
+  // ANALYZE may have built the top-k over a sample of the table, so its counts are scaled up to the column
+  const auto total = static_cast<double>(top_k->GetTotalCount());
+  const double scale = total > 0 ? static_cast<double>(column_stats->GetNonNullRows()) / total : 1.0;
+  double res = static_cast<double>(value_frequency_estimate) * scale / static_cast<double>(numrows);
 
   NOISEPAGE_ASSERT(res >= 0 && res <= 1, "Selectivity of operator must be within valid range");
   return res;
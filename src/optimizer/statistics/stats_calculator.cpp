@@ -2,9 +2,12 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -13,6 +16,8 @@
 #include "optimizer/memo.h"
 #include "optimizer/optimizer_context.h"
 #include "optimizer/physical_operators.h"
+#include "optimizer/statistics/cardinality_feedback.h"
+#include "optimizer/statistics/column_group_stats.h"
 #include "optimizer/statistics/selectivity_util.h"
 #include "optimizer/statistics/stats_storage.h"
 #include "optimizer/statistics/table_stats.h"
@@ -23,6 +28,130 @@
 
 namespace noisepage::optimizer {
 
+namespace {
+
+/** @return the column of a [column = value] or [value = column] predicate, INVALID_COLUMN_OID for other predicates */
+catalog::col_oid_t GetEqualityColumn(common::ManagedPointer<parser::AbstractExpression> expr) {
+  if (expr->GetExpressionType() != parser::ExpressionType::COMPARE_EQUAL) return catalog::INVALID_COLUMN_OID;
+  for (size_t col_idx = 0; col_idx < 2; col_idx++) {
+    const auto value_type = expr->GetChild(1 - col_idx)->GetExpressionType();
+    const bool is_value =
+        value_type == parser::ExpressionType::VALUE_CONSTANT || value_type == parser::ExpressionType::VALUE_PARAMETER;
+    if (expr->GetChild(col_idx)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE && is_value) {
+      return expr->GetChild(col_idx).CastManagedPointerTo<parser::ColumnValueExpression>()->GetColumnOid();
+    }
+  }
+  return catalog::INVALID_COLUMN_OID;
+}
+
+/** @return the name under which a Group keeps the statistics of a column group, @see Group::AddStats() */
+std::string GetColumnGroupName(std::vector<std::string> column_names) {
+  std::sort(column_names.begin(), column_names.end());
+  std::string name;
+  for (const auto &column_name : column_names) {
+    if (!name.empty()) name += ",";
+    name += column_name;
+  }
+  return name;
+}
+
+/** @return the number of rows of a group, at least one so that it can be divided by */
+double GetGroupRows(Group *group) { return std::max(static_cast<double>(group->GetNumRows()), 1.0); }
+
+/** @return the number of rows of an estimate as stored in a Group */
+int ToGroupRows(double num_rows) {
+  return static_cast<int>(std::clamp(num_rows, 0.0, static_cast<double>(std::numeric_limits<int>::max())));
+}
+
+/** @return the number of rows a scan or join was observed to have when the query ran before, if it was */
+std::optional<double> GetObservedRows(OptimizerContext *context, Group *group) {
+  const auto feedback = context->GetCardinalityFeedback();
+  if (feedback == nullptr) return std::nullopt;
+  const auto num_rows = feedback->Lookup(group->GetTableAliases());
+  if (!num_rows.has_value()) return std::nullopt;
+  return static_cast<double>(*num_rows);
+}
+
+/**
+ * The pairs of columns that the equalities among the join predicates compare, with the column of the left side first.
+ * @return the full names of the columns
+ */
+std::vector<std::pair<std::string, std::string>> GetJoinKeys(Group *left_group,
+                                                             const std::vector<AnnotatedExpression> &predicates) {
+  std::vector<std::pair<std::string, std::string>> join_keys;
+  for (const auto &annotated_expr : predicates) {
+    const auto expr = annotated_expr.GetExpr();
+    if (expr->GetExpressionType() != parser::ExpressionType::COMPARE_EQUAL ||
+        expr->GetChild(0)->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE ||
+        expr->GetChild(1)->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) {
+      continue;
+    }
+    const auto lhs = expr->GetChild(0).CastManagedPointerTo<parser::ColumnValueExpression>();
+    const auto rhs = expr->GetChild(1).CastManagedPointerTo<parser::ColumnValueExpression>();
+    if (left_group->GetTableAliases().count(lhs->GetTableName()) != 0) {
+      join_keys.emplace_back(lhs->GetFullName(), rhs->GetFullName());
+    } else {
+      join_keys.emplace_back(rhs->GetFullName(), lhs->GetFullName());
+    }
+  }
+  return join_keys;
+}
+
+/** @return the number of distinct values of the columns of one side of a join together */
+double GetJoinKeyDistinctValues(Group *group, const std::vector<std::string> &column_names) {
+  if (const auto *group_stats = group->GetStats(GetColumnGroupName(column_names)); group_stats != nullptr) {
+    return group_stats->GetDistinctValues();
+  }
+  double num_distinct = 1;
+  for (const auto &column_name : column_names) {
+    const auto *column_stats = group->GetStats(column_name);
+    num_distinct *= column_stats != nullptr ? column_stats->GetDistinctValues() : GetGroupRows(group);
+  }
+  return std::min(num_distinct, GetGroupRows(group));
+}
+
+/** Copy the statistics of the columns of a child group to a group with num_rows rows */
+void DeriveChildStats(Group *group, Group *child_group, double num_rows) {
+  for (const auto &[column_name, column_stats] : child_group->GetAllStats()) {
+    group->AddStats(column_name, column_stats.Limit(num_rows));
+  }
+}
+
+}  // namespace
+
+double StatsCalculator::EstimateJoinSelectivity(Group *left_group, Group *right_group,
+                                                const std::vector<AnnotatedExpression> &predicates) {
+  const auto join_keys = GetJoinKeys(left_group, predicates);
+  const double left_rows = GetGroupRows(left_group);
+  const double right_rows = GetGroupRows(right_group);
+
+  double selectivity = 1.0;
+  std::vector<std::string> left_columns;
+  std::vector<std::string> right_columns;
+  for (const auto &[left_column, right_column] : join_keys) {
+    const auto *left_stats = left_group->GetStats(left_column);
+    const auto *right_stats = right_group->GetStats(right_column);
+    if (left_stats != nullptr && right_stats != nullptr) {
+      selectivity *= SelectivityUtil::ComputeJoinSelectivity(*left_stats, *right_stats);
+    } else {
+      // Without statistics every row of the smaller side is assumed to match one row of the larger side
+      selectivity /= std::max(left_rows, right_rows);
+    }
+    left_columns.emplace_back(left_column);
+    right_columns.emplace_back(right_column);
+  }
+
+  // The columns of a key over several columns may be correlated, e.g. the columns of a multi-column index, in which
+  // case the combinations of their values are much fewer than the independent estimate assumes
+  if (join_keys.size() > 1 && (left_group->GetStats(GetColumnGroupName(left_columns)) != nullptr ||
+                               right_group->GetStats(GetColumnGroupName(right_columns)) != nullptr)) {
+    const double num_distinct = std::max(GetJoinKeyDistinctValues(left_group, left_columns),
+                                         GetJoinKeyDistinctValues(right_group, right_columns));
+    selectivity = std::max(selectivity, 1.0 / std::max(num_distinct, 1.0));
+  }
+  return selectivity;
+}
+
 void StatsCalculator::CalculateStats(GroupExpression *gexpr, OptimizerContext *context) {
   gexpr_ = gexpr;
   context_ = context;
@@ -44,10 +173,12 @@ void StatsCalculator::Visit(const LogicalGet *op) {
 
     NOISEPAGE_ASSERT(latched_table_stats_reference.table_stats_.GetColumnCount() != 0,
                      "Should have table stats for all tables");
-    // Use predicates to estimate cardinality.
-    auto est = EstimateCardinalityForFilter(latched_table_stats_reference.table_stats_.GetNumRows(),
-                                            latched_table_stats_reference.table_stats_, op->GetPredicates());
-    root_group->SetNumRows(static_cast<int>(est));
+    // Use predicates to estimate cardinality, unless it was observed when the query ran before.
+    const auto &table_stats = latched_table_stats_reference.table_stats_;
+    const auto filtered = EstimateCardinalityForFilter(table_stats.GetNumRows(), table_stats, op->GetPredicates());
+    const double est = GetObservedRows(context_, root_group).value_or(static_cast<double>(filtered));
+    root_group->SetNumRows(ToGroupRows(est));
+    DeriveColumnStats(op, table_stats, est);
   }
 }
 
@@ -66,23 +197,27 @@ void StatsCalculator::Visit(const LogicalInnerJoin *op) {
 
   // Calculate output num rows first
   if (root_group->GetNumRows() == -1) {
-    size_t curr_rows = left_child_group->GetNumRows() * right_child_group->GetNumRows();
-    for (const auto &annotated_expr : op->GetJoinPredicates()) {
-      // See if there are join conditions
-      if (annotated_expr.GetExpr()->GetExpressionType() == parser::ExpressionType::COMPARE_EQUAL &&
-          annotated_expr.GetExpr()->GetChild(0)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE &&
-          annotated_expr.GetExpr()->GetChild(1)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE) {
-        NOISEPAGE_ASSERT(left_child_group->HasNumRows() && right_child_group->HasNumRows(),
-                         "Child groups should have their stats derived");
-        /*
-         * TODO(Joseph Koshakow) This isn't really that accurate, it doesn't take into account overlap of predicates
-         *  i.e. if predicate 1 matches two rows and predicate 2 matches the same two rows, then predicate 2 will have
-         *  no affect on the total row count but we will unnecessary lower the total row count.
-         */
-        curr_rows /= std::max(std::max(left_child_group->GetNumRows(), right_child_group->GetNumRows()), 1);
-      }
+    NOISEPAGE_ASSERT(
+        op->GetJoinPredicates().empty() || (left_child_group->HasNumRows() && right_child_group->HasNumRows()),
+        "Child groups should have their stats derived");
+    const double num_rows = GetObservedRows(context_, root_group)
+                                .value_or(static_cast<double>(left_child_group->GetNumRows()) *
+                                          static_cast<double>(right_child_group->GetNumRows()) *
+                                          EstimateJoinSelectivity(left_child_group, right_child_group,
+                                                                  op->GetJoinPredicates()));
+    root_group->SetNumRows(ToGroupRows(num_rows));
+
+    // Both columns of an equality are left with the distinct values they have in common
+    DeriveChildStats(root_group, left_child_group, num_rows);
+    DeriveChildStats(root_group, right_child_group, num_rows);
+    for (const auto &[left_column, right_column] : GetJoinKeys(left_child_group, op->GetJoinPredicates())) {
+      const auto *left_stats = root_group->GetStats(left_column);
+      const auto *right_stats = root_group->GetStats(right_column);
+      if (left_stats == nullptr || right_stats == nullptr) continue;
+      const double num_distinct = std::min(left_stats->GetDistinctValues(), right_stats->GetDistinctValues());
+      root_group->AddStats(left_column, DerivedColumnStats(num_distinct, 0, left_stats->GetMostCommonValues()));
+      root_group->AddStats(right_column, DerivedColumnStats(num_distinct, 0, right_stats->GetMostCommonValues()));
     }
-    root_group->SetNumRows(static_cast<int>(curr_rows));
   }
 
   // TODO(boweic): calculate stats based on predicates other than join conditions
@@ -97,23 +232,23 @@ void StatsCalculator::Visit(const LogicalSemiJoin *op) {
 
   // Calculate output num rows first
   if (root_group->GetNumRows() == -1) {
-    size_t curr_rows = left_child_group->GetNumRows() * right_child_group->GetNumRows();
-    for (const auto &annotated_expr : op->GetJoinPredicates()) {
-      // See if there are join conditions
-      if (annotated_expr.GetExpr()->GetExpressionType() == parser::ExpressionType::COMPARE_EQUAL &&
-          annotated_expr.GetExpr()->GetChild(0)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE &&
-          annotated_expr.GetExpr()->GetChild(1)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE) {
-        NOISEPAGE_ASSERT(left_child_group->HasNumRows() && right_child_group->HasNumRows(),
-                         "Child groups should have their stats derived");
-        /*
-         * TODO(Joseph Koshakow) This isn't really that accurate, it doesn't take into account overlap of predicates
-         *  i.e. if predicate 1 matches two rows and predicate 2 matches the same two rows, then predicate 2 will have
-         *  no affect on the total row count but we will unnecessary lower the total row count.
-         */
-        curr_rows /= std::max(std::max(left_child_group->GetNumRows(), right_child_group->GetNumRows()), 1);
+    NOISEPAGE_ASSERT(
+        op->GetJoinPredicates().empty() || (left_child_group->HasNumRows() && right_child_group->HasNumRows()),
+        "Child groups should have their stats derived");
+    const double left_rows = GetGroupRows(left_child_group);
+    const double right_rows = GetGroupRows(right_child_group);
+    double num_rows = left_child_group->GetNumRows();
+    for (const auto &[left_column, right_column] : GetJoinKeys(left_child_group, op->GetJoinPredicates())) {
+      const auto *left_stats = left_child_group->GetStats(left_column);
+      const auto *right_stats = right_child_group->GetStats(right_column);
+      if (left_stats != nullptr && right_stats != nullptr) {
+        num_rows *= SelectivityUtil::ComputeSemiJoinSelectivity(*left_stats, *right_stats);
+      } else {
+        num_rows *= std::min(right_rows / std::max(left_rows, right_rows), 1.0);
       }
     }
-    root_group->SetNumRows(static_cast<int>(curr_rows));
+    root_group->SetNumRows(ToGroupRows(num_rows));
+    DeriveChildStats(root_group, left_child_group, num_rows);
   }
 }
 
@@ -123,7 +258,9 @@ void StatsCalculator::Visit(UNUSED_ATTRIBUTE const LogicalAggregateAndGroupBy *o
 
   // First, set num rows
   auto *child_group = context_->GetMemo().GetGroupByID(gexpr_->GetChildGroupId(0));
-  context_->GetMemo().GetGroupByID(gexpr_->GetGroupID())->SetNumRows(child_group->GetNumRows());
+  auto *group = context_->GetMemo().GetGroupByID(gexpr_->GetGroupID());
+  group->SetNumRows(child_group->GetNumRows());
+  DeriveChildStats(group, child_group, group->GetNumRows());
 }
 
 void StatsCalculator::Visit(const LogicalLimit *op) {
@@ -132,15 +269,61 @@ void StatsCalculator::Visit(const LogicalLimit *op) {
   auto *child_group = context_->GetMemo().GetGroupByID(gexpr_->GetChildGroupId(0));
   auto *group = context_->GetMemo().GetGroupByID(gexpr_->GetGroupID());
   group->SetNumRows(std::min(static_cast<int>(op->GetLimit()), child_group->GetNumRows()));
+  DeriveChildStats(group, child_group, group->GetNumRows());
+}
+
+void StatsCalculator::DeriveColumnStats(const LogicalGet *op, const TableStats &table_stats, double num_rows) {
+  auto *root_group = context_->GetMemo().GetGroupByID(gexpr_->GetGroupID());
+  const auto &schema = context_->GetCatalogAccessor()->GetSchema(op->GetTableOid());
+  const auto column_name = [&](catalog::col_oid_t col_oid) {
+    return op->GetTableAlias() + "." + schema.GetColumn(col_oid).Name();
+  };
+
+  // A column that an equality filters on is left with the one value
+  std::unordered_set<catalog::col_oid_t> equality_columns;
+  for (const auto &annotated_expr : op->GetPredicates()) {
+    const auto col_oid = GetEqualityColumn(annotated_expr.GetExpr());
+    if (col_oid != catalog::INVALID_COLUMN_OID) equality_columns.emplace(col_oid);
+  }
+
+  for (const auto &column_stats : table_stats.GetColumnStats()) {
+    const auto col_oid = column_stats->GetColumnID();
+    if (equality_columns.count(col_oid) != 0) {
+      root_group->AddStats(column_name(col_oid), DerivedColumnStats(1, 0, {}));
+      continue;
+    }
+    DerivedColumnStats stats(static_cast<double>(column_stats->GetDistinctValues()), column_stats->GetFracNull(),
+                             column_stats->GetMostCommonValues());
+    root_group->AddStats(column_name(col_oid), stats.Limit(num_rows));
+
+    for (const auto &group_stats : column_stats->GetColumnGroupStats()) {
+      std::vector<std::string> column_names;
+      for (const auto group_col_oid : group_stats.GetColumnOids()) {
+        column_names.emplace_back(column_name(group_col_oid));
+      }
+      DerivedColumnStats column_group_stats(static_cast<double>(group_stats.GetDistinctValues()), 0, {});
+      root_group->AddStats(GetColumnGroupName(std::move(column_names)), column_group_stats.Limit(num_rows));
+    }
+  }
 }
 
 size_t StatsCalculator::EstimateCardinalityForFilter(size_t num_rows, const TableStats &predicate_stats,
                                                      const std::vector<AnnotatedExpression> &predicates) {
   double selectivity = 1.F;
+  // Equalities between a column and a value are set aside, as the columns may be correlated
+  std::unordered_map<catalog::col_oid_t, double> equality_selectivities;
   for (const auto &annotated_expr : predicates) {
     // Loop over conjunction exprs
-    selectivity *= CalculateSelectivityForPredicate(predicate_stats, annotated_expr.GetExpr());
+    const auto expr = annotated_expr.GetExpr();
+    const double predicate_selectivity = CalculateSelectivityForPredicate(predicate_stats, expr);
+    const auto col_oid = GetEqualityColumn(expr);
+    if (col_oid != catalog::INVALID_COLUMN_OID && equality_selectivities.count(col_oid) == 0) {
+      equality_selectivities.emplace(col_oid, predicate_selectivity);
+    } else {
+      selectivity *= predicate_selectivity;
+    }
   }
+  selectivity *= CalculateSelectivityForEqualities(predicate_stats, &equality_selectivities);
 
   // Update selectivity
   return static_cast<size_t>(static_cast<double>(num_rows) * selectivity);
@@ -217,4 +400,35 @@ double StatsCalculator::CalculateSelectivityForPredicate(const TableStats &predi
   return selectivity;
 }
 
+double StatsCalculator::CalculateSelectivityForEqualities(
+    const TableStats &predicate_table_stats, std::unordered_map<catalog::col_oid_t, double> *equality_selectivities) {
+  // Larger groups capture more of the correlation between the columns, so they are used first
+  std::vector<const ColumnGroupStats *> groups;
+  for (const auto &column_stats : predicate_table_stats.GetColumnStats()) {
+    for (const auto &group : column_stats->GetColumnGroupStats()) groups.emplace_back(&group);
+  }
+  std::stable_sort(groups.begin(), groups.end(), [](const ColumnGroupStats *lhs, const ColumnGroupStats *rhs) {
+    return lhs->GetColumnOids().size() > rhs->GetColumnOids().size();
+  });
+
+  double selectivity = 1.F;
+  for (const auto *group : groups) {
+    // A group is only used if every one of its columns has an equality that no other group used
+    std::vector<double> selectivities;
+    for (const auto col_oid : group->GetColumnOids()) {
+      const auto it = equality_selectivities->find(col_oid);
+      if (it == equality_selectivities->end()) break;
+      selectivities.emplace_back(it->second);
+    }
+    if (selectivities.size() != group->GetColumnOids().size()) continue;
+
+    selectivity *= group->EstimateEqualitySelectivity(selectivities);
+    for (const auto col_oid : group->GetColumnOids()) equality_selectivities->erase(col_oid);
+  }
+
+  for (const auto &[col_oid, column_selectivity] : *equality_selectivities) selectivity *= column_selectivity;
+  equality_selectivities->clear();
+  return selectivity;
+}
+
 }  // namespace noisepage::optimizer
@@ -19,7 +19,7 @@ LatchedTableStatsReference StatsStorage::GetTableStats(const catalog::db_oid_t d
     InsertTableStats(database_id, table_id, accessor);
   }
 
-  common::SharedLatchGuard shared_stats_storage_latch{&stats_storage_latch_};
+  common::BigReaderLatchGuard shared_stats_storage_latch{&stats_storage_latch_};
 
   TableStatsKey table_stats_key{database_id, table_id};
   auto table_it = table_stats_storage_.find(table_stats_key);
@@ -28,7 +28,7 @@ LatchedTableStatsReference StatsStorage::GetTableStats(const catalog::db_oid_t d
 
   UpdateStaleColumns(table_id, &table_stats_value, accessor);
 
-  common::SharedLatchGuard shared_table_stats_latch{&table_stats_value.shared_latch_};
+  common::BigReaderLatchGuard shared_table_stats_latch{&table_stats_value.shared_latch_};
   return LatchedTableStatsReference(table_stats_value.table_stats_, std::move(shared_stats_storage_latch),
                                     std::move(shared_table_stats_latch));
 }
@@ -36,7 +36,7 @@ LatchedTableStatsReference StatsStorage::GetTableStats(const catalog::db_oid_t d
 void StatsStorage::MarkStatsStale(catalog::db_oid_t database_id, catalog::table_oid_t table_id,
                                   const std::vector<catalog::col_oid_t> &col_ids) {
   TableStatsKey table_stats_key{database_id, table_id};
-  common::SharedLatch::ScopedSharedLatch shared_stats_storage_latch{&stats_storage_latch_};
+  common::BigReaderLatch::ScopedSharedLatch shared_stats_storage_latch{&stats_storage_latch_};
   auto table_stats_value_it = table_stats_storage_.find(table_stats_key);
   if (table_stats_value_it != table_stats_storage_.end()) {
     auto &stats_storage_value = table_stats_storage_.at(table_stats_key);
@@ -44,7 +44,7 @@ void StatsStorage::MarkStatsStale(catalog::db_oid_t database_id, catalog::table_
      * We don't need an exclusive latch because it's ok to mark something stale while someone is reading it. The worst
      * that happens is they end up using slightly stale statistics without realizing it.
      */
-    common::SharedLatch::ScopedSharedLatch shared_table_stats_latch{&stats_storage_value.shared_latch_};
+    common::BigReaderLatch::ScopedSharedLatch shared_table_stats_latch{&stats_storage_value.shared_latch_};
     for (const auto &col_id : col_ids) {
       stats_storage_value.table_stats_.GetColumnStats(col_id)->MarkStale();
     }
@@ -52,14 +52,14 @@ void StatsStorage::MarkStatsStale(catalog::db_oid_t database_id, catalog::table_
 }
 
 bool StatsStorage::ContainsTableStats(catalog::db_oid_t database_id, catalog::table_oid_t table_id) {
-  common::SharedLatch::ScopedSharedLatch shared_stats_storage_latch{&stats_storage_latch_};
+  common::BigReaderLatch::ScopedSharedLatch shared_stats_storage_latch{&stats_storage_latch_};
   TableStatsKey table_stats_key{database_id, table_id};
   return table_stats_storage_.count(table_stats_key) > 0;
 }
 
 void StatsStorage::InsertTableStats(catalog::db_oid_t database_id, catalog::table_oid_t table_id,
                                     catalog::CatalogAccessor *accessor) {
-  common::SharedLatch::ScopedExclusiveLatch exclusive_stats_storage_latch{&stats_storage_latch_};
+  common::BigReaderLatch::ScopedExclusiveLatch exclusive_stats_storage_latch{&stats_storage_latch_};
 
   TableStatsKey table_stats_key{database_id, table_id};
   if (table_stats_storage_.count(table_stats_key) == 0) {
@@ -70,13 +70,13 @@ void StatsStorage::InsertTableStats(catalog::db_oid_t database_id, catalog::tabl
 void StatsStorage::UpdateStaleColumns(catalog::table_oid_t table_id, TableStatsValue *table_stats_value,
                                       catalog::CatalogAccessor *accessor) {
   {
-    common::SharedLatch::ScopedSharedLatch shared_table_latch{&table_stats_value->shared_latch_};
+    common::BigReaderLatch::ScopedSharedLatch shared_table_latch{&table_stats_value->shared_latch_};
     if (!table_stats_value->table_stats_.HasStaleValues()) {
       return;
     }
   }
 
-  common::SharedLatch::ScopedExclusiveLatch exclusive_table_latch{&table_stats_value->shared_latch_};
+  common::BigReaderLatch::ScopedExclusiveLatch exclusive_table_latch{&table_stats_value->shared_latch_};
 
   auto &table_stats = table_stats_value->table_stats_;
   for (auto column_stat : table_stats.GetColumnStats()) {
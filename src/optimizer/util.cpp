@@ -1,11 +1,14 @@
 #include "optimizer/util.h"
 
+#include <algorithm>
+#include <memory>
 #include <string>
 #include <unordered_set>
 #include <vector>
 
 #include "catalog/catalog_accessor.h"
 #include "optimizer/optimizer_defs.h"
+#include "parser/expression/column_value_expression.h"
 #include "parser/expression/star_expression.h"
 #include "parser/expression_util.h"
 
@@ -46,6 +49,92 @@ void OptimizerUtil::ExtractEquiJoinKeys(const std::vector<AnnotatedExpression> &
   }
 }
 
+namespace {
+
+// Whether the expression is a comparison that can be carried over to a column equal to the one it compares, and if so
+// the index of the child that is that column
+bool IsTransferableComparison(const parser::AbstractExpression &expr, size_t *column_idx) {
+  switch (expr.GetExpressionType()) {
+    case parser::ExpressionType::COMPARE_EQUAL:
+    case parser::ExpressionType::COMPARE_NOT_EQUAL:
+    case parser::ExpressionType::COMPARE_LESS_THAN:
+    case parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO:
+    case parser::ExpressionType::COMPARE_GREATER_THAN:
+    case parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO:
+      break;
+    default:
+      return false;
+  }
+  for (size_t idx = 0; idx < 2; idx++) {
+    const auto other_type = expr.GetChild(1 - idx)->GetExpressionType();
+    const bool is_value =
+        other_type == parser::ExpressionType::VALUE_CONSTANT || other_type == parser::ExpressionType::VALUE_PARAMETER;
+    if (expr.GetChild(idx)->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE && is_value) {
+      *column_idx = idx;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool IsSameColumn(const parser::ColumnValueExpression &lhs, const parser::ColumnValueExpression &rhs) {
+  return lhs.GetColumnOid() != catalog::INVALID_COLUMN_OID && lhs.GetColumnOid() == rhs.GetColumnOid() &&
+         lhs.GetTableName() == rhs.GetTableName();
+}
+
+}  // namespace
+
+void OptimizerUtil::InferTransitivePredicates(
+    std::vector<AnnotatedExpression> *predicates,
+    std::vector<std::unique_ptr<parser::AbstractExpression>> *inferred_exprs) {
+  bool inferred = true;
+  while (inferred) {
+    inferred = false;
+    for (size_t eq_idx = 0; eq_idx < predicates->size(); eq_idx++) {
+      const auto equality = (*predicates)[eq_idx].GetExpr();
+      if (equality->GetExpressionType() != parser::ExpressionType::COMPARE_EQUAL ||
+          equality->GetChild(0)->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE ||
+          equality->GetChild(1)->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) {
+        continue;
+      }
+      const auto lhs = equality->GetChild(0).CastManagedPointerTo<parser::ColumnValueExpression>();
+      const auto rhs = equality->GetChild(1).CastManagedPointerTo<parser::ColumnValueExpression>();
+      // Comparisons between values of different types may not compare the same way
+      if (lhs->GetTableName() == rhs->GetTableName() || lhs->GetReturnValueType() != rhs->GetReturnValueType() ||
+          lhs->GetDepth() != rhs->GetDepth()) {
+        continue;
+      }
+
+      for (size_t pred_idx = 0; pred_idx < predicates->size(); pred_idx++) {
+        const auto predicate = (*predicates)[pred_idx].GetExpr();
+        size_t column_idx;
+        if (!IsTransferableComparison(*predicate, &column_idx)) continue;
+        const auto &column = *predicate->GetChild(column_idx).CastManagedPointerTo<parser::ColumnValueExpression>();
+        common::ManagedPointer<parser::ColumnValueExpression> other_column;
+        if (IsSameColumn(column, *lhs)) {
+          other_column = rhs;
+        } else if (IsSameColumn(column, *rhs)) {
+          other_column = lhs;
+        } else {
+          continue;
+        }
+
+        std::vector<std::unique_ptr<parser::AbstractExpression>> children;
+        children.emplace_back(predicate->GetChild(0)->Copy());
+        children.emplace_back(predicate->GetChild(1)->Copy());
+        children[column_idx] = other_column->Copy();
+        auto expr = predicate->CopyWithChildren(std::move(children));
+        AnnotatedExpression inferred_predicate(common::ManagedPointer(expr), {other_column->GetTableName()});
+        if (std::find(predicates->begin(), predicates->end(), inferred_predicate) != predicates->end()) continue;
+
+        predicates->emplace_back(std::move(inferred_predicate));
+        inferred_exprs->emplace_back(std::move(expr));
+        inferred = true;
+      }
+    }
+  }
+}
+
 std::vector<parser::AbstractExpression *> OptimizerUtil::GenerateTableColumnValueExprs(
     catalog::CatalogAccessor *accessor, const std::string &alias, catalog::db_oid_t db_oid,
     catalog::table_oid_t tbl_oid) {
@@ -3,11 +3,13 @@
 #include <algorithm>
 #include <cstdio>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_set>
 #include <utility>
 #include <vector>
 
+#include "catalog/catalog_defs.h"
 #include "common/error/exception.h"
 #include "execution/sql/value_util.h"
 #include "libpg_query/pg_list.h"
@@ -103,6 +105,10 @@ std::unique_ptr<SQLStatement> PostgresParser::NodeTransform(ParseResult *parse_r
       result = CreateDatabaseTransform(parse_result, reinterpret_cast<CreateDatabaseStmt *>(node));
       break;
     }
+    case T_CreateTableAsStmt: {
+      result = CreateMaterializedViewTransform(parse_result, reinterpret_cast<CreateTableAsStmt *>(node));
+      break;
+    }
     case T_CreateFunctionStmt: {
       result = CreateFunctionTransform(parse_result, reinterpret_cast<CreateFunctionStmt *>(node));
       break;
@@ -143,6 +149,10 @@ std::unique_ptr<SQLStatement> PostgresParser::NodeTransform(ParseResult *parse_r
       result = PrepareTransform(parse_result, reinterpret_cast<PrepareStmt *>(node));
       break;
     }
+    case T_RefreshMatViewStmt: {
+      result = RefreshTransform(parse_result, reinterpret_cast<RefreshMatViewStmt *>(node));
+      break;
+    }
     case T_SelectStmt: {
       result = SelectTransform(parse_result, reinterpret_cast<SelectStmt *>(node));
       break;
@@ -1127,7 +1137,16 @@ std::unique_ptr<CopyStatement> PostgresParser::CopyTransform(ParseResult *parse_
 
   std::unique_ptr<TableRef> table;
   std::unique_ptr<SelectStatement> select_stmt;
-  if (root->relation_ != nullptr) {
+  if (root->relation_ != nullptr && !root->is_from_) {
+    // Copying a table out copies the result of SELECT * FROM table
+    auto star = std::make_unique<TableStarExpression>();
+    std::vector<common::ManagedPointer<AbstractExpression>> select_list{
+        common::ManagedPointer<AbstractExpression>(star.get())};
+    parse_result->AddExpression(std::move(star));
+    select_stmt = std::make_unique<SelectStatement>(std::move(select_list), false,
+                                                    RangeVarTransform(parse_result, root->relation_), nullptr,
+                                                    nullptr, nullptr, nullptr);
+  } else if (root->relation_ != nullptr) {
     table = RangeVarTransform(parse_result, root->relation_);
   } else {
     select_stmt = SelectTransform(parse_result, reinterpret_cast<SelectStmt *>(root->query_));
@@ -1136,8 +1155,8 @@ std::unique_ptr<CopyStatement> PostgresParser::CopyTransform(ParseResult *parse_
   auto file_path = root->filename_ != nullptr ? root->filename_ : "";
   auto is_from = root->is_from_;
 
-  char delimiter = ',';
-  ExternalFileFormat format = ExternalFileFormat::CSV;
+  std::optional<char> delimiter;
+  ExternalFileFormat format = ExternalFileFormat::TEXT;
   char quote = '"';
   char escape = '"';
   if (root->options_ != nullptr) {
@@ -1147,7 +1166,9 @@ std::unique_ptr<CopyStatement> PostgresParser::CopyTransform(ParseResult *parse_
       if (strncmp(def_elem->defname_, k_format_tok, sizeof(k_format_tok)) == 0) {
         auto format_cstr = reinterpret_cast<value *>(def_elem->arg_)->val_.str_;
         // lowercase
-        if (strcmp(format_cstr, "csv") == 0) {
+        if (strcmp(format_cstr, "text") == 0) {
+          format = ExternalFileFormat::TEXT;
+        } else if (strcmp(format_cstr, "csv") == 0) {
           format = ExternalFileFormat::CSV;
         } else if (strcmp(format_cstr, "binary") == 0) {
           format = ExternalFileFormat::BINARY;
@@ -1168,8 +1189,10 @@ std::unique_ptr<CopyStatement> PostgresParser::CopyTransform(ParseResult *parse_
     }
   }
 
+  // Like in postgres, values are separated by tabs in the text format and by commas in CSV
   auto result = std::make_unique<CopyStatement>(std::move(table), std::move(select_stmt), file_path, format, is_from,
-                                                delimiter, quote, escape);
+                                                delimiter.value_or(format == ExternalFileFormat::TEXT ? '\t' : ','),
+                                                quote, escape);
   return result;
 }
 
@@ -1178,6 +1201,8 @@ std::unique_ptr<SQLStatement> PostgresParser::CreateTransform(ParseResult *parse
   RangeVar *relation = root->relation_;
   auto table_name = relation->relname_ != nullptr ? relation->relname_ : "";
   auto schema_name = relation->schemaname_ != nullptr ? relation->schemaname_ : "";
+  // CREATE TEMP TABLE creates the table in the temporary namespace of the connection, 't' is RELPERSISTENCE_TEMP
+  if (relation->relpersistence_ == 't') schema_name = catalog::TEMP_NAMESPACE_ALIAS;
   auto database_name = relation->catalogname_ != nullptr ? relation->catalogname_ : "";
   std::unique_ptr<TableInfo> table_info = std::make_unique<TableInfo>(table_name, schema_name, database_name);
 
@@ -1376,6 +1401,19 @@ std::unique_ptr<SQLStatement> PostgresParser::CreateIndexTransform(ParseResult *
     index_name += "_idx";
   }
 
+  auto index_predicate = common::ManagedPointer<AbstractExpression>(nullptr);
+  if (root->where_clause_ != nullptr) {
+    // Recovery does not evaluate index predicates and would insert tuples outside of the predicate, whose keys need
+    // not be unique.
+    if (unique) {
+      PARSER_LOG_DEBUG("CreateIndexTransform: unique partial indexes not supported");
+      throw NOT_IMPLEMENTED_EXCEPTION("CreateIndexTransform error");
+    }
+    auto expr = ExprTransform(parse_result, root->where_clause_, nullptr);
+    index_predicate = common::ManagedPointer(expr);
+    parse_result->AddExpression(std::move(expr));
+  }
+
   char *access_method = root->access_method_;
   IndexType index_type;
   // TODO(WAN): do we need to do case conversion?
@@ -1387,13 +1425,15 @@ std::unique_ptr<SQLStatement> PostgresParser::CreateIndexTransform(ParseResult *
     index_type = IndexType::BPLUSTREE;
   } else if (strcmp(access_method, "hash") == 0) {
     index_type = IndexType::HASH;
+  } else if (strcmp(access_method, "art") == 0) {
+    index_type = IndexType::ART;
   } else {
     PARSER_LOG_DEBUG("CreateIndexTransform: IndexType {} not supported", access_method);
     throw NOT_IMPLEMENTED_EXCEPTION("CreateIndexTransform error");
   }
 
   return std::make_unique<CreateStatement>(std::move(table_info), index_type, unique, index_name,
-                                           std::move(index_attrs));
+                                           std::move(index_attrs), index_predicate);
 }
 
 // Postgres.CreateSchemaStmt -> noisepage.CreateStatement
@@ -1502,6 +1542,45 @@ std::unique_ptr<SQLStatement> PostgresParser::CreateViewTransform(ParseResult *p
   return result;
 }
 
+// Postgres.CreateTableAsStmt -> noisepage.CreateStatement
+std::unique_ptr<SQLStatement> PostgresParser::CreateMaterializedViewTransform(ParseResult *parse_result,
+                                                                              CreateTableAsStmt *root) {
+  if (root->relkind_ != ObjectType::OBJECT_MATVIEW) {
+    PARSER_LOG_DEBUG("CREATE TABLE AS is not supported");
+    throw PARSER_EXCEPTION("CREATE TABLE AS is not supported");
+  }
+
+  std::unique_ptr<SelectStatement> view_query;
+  switch (root->query_->type) {
+    case T_SelectStmt: {
+      view_query = SelectTransform(parse_result, reinterpret_cast<SelectStmt *>(root->query_));
+      break;
+    }
+    default: {
+      PARSER_LOG_DEBUG("CREATE MATERIALIZED VIEW as query only supports SELECT");
+      throw PARSER_EXCEPTION("CREATE MATERIALIZED VIEW as query only supports SELECT");
+    }
+  }
+
+  RangeVar *relation = root->into_->rel_;
+  auto table_name = relation->relname_ != nullptr ? relation->relname_ : "";
+  auto schema_name = relation->schemaname_ != nullptr ? relation->schemaname_ : "";
+  if (relation->relpersistence_ == 't') schema_name = catalog::TEMP_NAMESPACE_ALIAS;
+  auto database_name = relation->catalogname_ != nullptr ? relation->catalogname_ : "";
+  auto table_info = std::make_unique<TableInfo>(table_name, schema_name, database_name);
+
+  std::vector<std::string> view_columns;
+  if (root->into_->col_names_ != nullptr) {
+    for (auto cell = root->into_->col_names_->head; cell != nullptr; cell = cell->next) {
+      view_columns.emplace_back(reinterpret_cast<value *>(cell->data.ptr_value)->val_.str_);
+    }
+  }
+
+  auto result = std::make_unique<CreateStatement>(std::move(table_info), std::move(view_query),
+                                                  std::move(view_columns), !root->into_->skip_data_);
+  return result;
+}
+
 // Postgres.ColumnDef -> noisepage.ColumnDefinition
 PostgresParser::ColumnDefTransResult PostgresParser::ColumnDefTransform(ParseResult *parse_result, ColumnDef *root) {
   auto type_name = root->type_name_;
@@ -1717,7 +1796,9 @@ std::unique_ptr<DropStatement> PostgresParser::DropTransform(ParseResult *parse_
     case ObjectType::OBJECT_SCHEMA: {
       return DropSchemaTransform(parse_result, root);
     }
+    case ObjectType::OBJECT_MATVIEW:
     case ObjectType::OBJECT_TABLE: {
+      // A materialized view is dropped as the table that holds its rows
       return DropTableTransform(parse_result, root);
     }
     case ObjectType::OBJECT_TRIGGER: {
@@ -1876,7 +1957,24 @@ std::vector<common::ManagedPointer<AbstractExpression>> PostgresParser::ParamLis
 std::unique_ptr<ExplainStatement> PostgresParser::ExplainTransform(ParseResult *parse_result, ExplainStmt *root) {
   std::unique_ptr<ExplainStatement> result;
   auto query = NodeTransform(parse_result, root->query_);
-  result = std::make_unique<ExplainStatement>(std::move(query));
+  bool analyze = false;
+  if (root->options_ != nullptr) {
+    for (ListCell *cell = root->options_->head; cell != nullptr; cell = cell->next) {
+      auto def_elem = reinterpret_cast<DefElem *>(cell->data.ptr_value);
+      // EXPLAIN ANALYZE and EXPLAIN (ANALYZE [boolean]) both give an "analyze" option
+      if (strcmp(def_elem->defname_, "analyze") == 0) {
+        auto arg = reinterpret_cast<value *>(def_elem->arg_);
+        if (arg == nullptr) {
+          analyze = true;
+        } else if (arg->type_ == T_Integer) {
+          analyze = arg->val_.ival_ != 0;
+        } else {
+          analyze = strcmp(arg->val_.str_, "false") != 0 && strcmp(arg->val_.str_, "off") != 0;
+        }
+      }
+    }
+  }
+  result = std::make_unique<ExplainStatement>(std::move(query), analyze);
   return result;
 }
 
@@ -1971,7 +2069,24 @@ std::unique_ptr<TransactionStatement> PostgresParser::TransactionTransform(Trans
 
   switch (transaction_stmt->kind_) {
     case TRANS_STMT_BEGIN: {
-      result = std::make_unique<TransactionStatement>(TransactionStatement::kBegin);
+      bool read_only = false;
+      std::optional<transaction::IsolationLevel> isolation_level = std::nullopt;
+      if (transaction_stmt->options_ != nullptr) {
+        for (ListCell *cell = transaction_stmt->options_->head; cell != nullptr; cell = cell->next) {
+          auto def_elem = reinterpret_cast<DefElem *>(cell->data.ptr_value);
+          // READ ONLY and READ WRITE set this option to an integer constant
+          if (strcmp(def_elem->defname_, "transaction_read_only") == 0) {
+            read_only = reinterpret_cast<A_Const *>(def_elem->arg_)->val_.val_.ival_ != 0;
+          }
+          // Every isolation level below SERIALIZABLE gets snapshot isolation, which is stronger than all of them
+          if (strcmp(def_elem->defname_, "transaction_isolation") == 0) {
+            const char *const level = reinterpret_cast<A_Const *>(def_elem->arg_)->val_.val_.str_;
+            isolation_level = strcmp(level, "serializable") == 0 ? transaction::IsolationLevel::SERIALIZABLE
+                                                                 : transaction::IsolationLevel::SNAPSHOT;
+          }
+        }
+      }
+      result = std::make_unique<TransactionStatement>(TransactionStatement::kBegin, read_only, isolation_level);
       break;
     }
     case TRANS_STMT_COMMIT: {
@@ -2016,6 +2131,18 @@ std::unique_ptr<PrepareStatement> PostgresParser::PrepareTransform(ParseResult *
   return result;
 }
 
+// Postgres.RefreshMatViewStmt -> noisepage.RefreshStatement
+std::unique_ptr<RefreshStatement> PostgresParser::RefreshTransform(ParseResult *parse_result,
+                                                                   RefreshMatViewStmt *root) {
+  if (root->concurrent_) {
+    PARSER_LOG_DEBUG("REFRESH MATERIALIZED VIEW CONCURRENTLY is not supported");
+    throw PARSER_EXCEPTION("REFRESH MATERIALIZED VIEW CONCURRENTLY is not supported");
+  }
+  auto view = RangeVarTransform(parse_result, root->relation_);
+  auto result = std::make_unique<RefreshStatement>(std::move(view), !root->skip_data_);
+  return result;
+}
+
 // Postgres.VacuumStmt -> noisepage.AnalyzeStatement
 std::unique_ptr<AnalyzeStatement> PostgresParser::VacuumTransform(ParseResult *parse_result, VacuumStmt *root) {
   std::unique_ptr<AnalyzeStatement> result;
@@ -12,7 +12,8 @@ namespace noisepage::planner {
 std::unique_ptr<AggregatePlanNode> AggregatePlanNode::Builder::Build() {
   return std::unique_ptr<AggregatePlanNode>(
       new AggregatePlanNode(std::move(children_), std::move(output_schema_), std::move(groupby_terms_),
-                            having_clause_predicate_, std::move(aggregate_terms_), aggregate_strategy_, plan_node_id_));
+                            having_clause_predicate_, std::move(aggregate_terms_), aggregate_strategy_,
+                            has_group_by_key_range_, group_by_key_min_, group_by_key_max_, plan_node_id_));
 }
 
 AggregatePlanNode::AggregatePlanNode(std::vector<std::unique_ptr<AbstractPlanNode>> &&children,
@@ -20,12 +21,16 @@ AggregatePlanNode::AggregatePlanNode(std::vector<std::unique_ptr<AbstractPlanNod
                                      std::vector<GroupByTerm> groupby_terms,
                                      common::ManagedPointer<parser::AbstractExpression> having_clause_predicate,
                                      std::vector<AggregateTerm> aggregate_terms,
-                                     AggregateStrategyType aggregate_strategy, plan_node_id_t plan_node_id)
+                                     AggregateStrategyType aggregate_strategy, bool has_group_by_key_range,
+                                     int64_t group_by_key_min, int64_t group_by_key_max, plan_node_id_t plan_node_id)
     : AbstractPlanNode(std::move(children), std::move(output_schema), plan_node_id),
       groupby_terms_(std::move(groupby_terms)),
       having_clause_predicate_(having_clause_predicate),
       aggregate_terms_(std::move(aggregate_terms)),
-      aggregate_strategy_(aggregate_strategy) {}
+      aggregate_strategy_(aggregate_strategy),
+      has_group_by_key_range_(has_group_by_key_range),
+      group_by_key_min_(group_by_key_min),
+      group_by_key_max_(group_by_key_max) {}
 
 common::hash_t AggregatePlanNode::Hash() const {
   common::hash_t hash = AbstractPlanNode::Hash();
@@ -48,6 +53,12 @@ common::hash_t AggregatePlanNode::Hash() const {
   // Aggregate Strategy
   hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(aggregate_strategy_));
 
+  // Group By Key Range
+  if (has_group_by_key_range_) {
+    hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(group_by_key_min_));
+    hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(group_by_key_max_));
+  }
+
   return hash;
 }
 
@@ -83,7 +94,12 @@ bool AggregatePlanNode::operator==(const AbstractPlanNode &rhs) const {
   }
 
   // Aggregate Strategy
-  return aggregate_strategy_ == other.aggregate_strategy_;
+  if (aggregate_strategy_ != other.aggregate_strategy_) return false;
+
+  // Group By Key Range
+  if (has_group_by_key_range_ != other.has_group_by_key_range_) return false;
+  return !has_group_by_key_range_ ||
+         (group_by_key_min_ == other.group_by_key_min_ && group_by_key_max_ == other.group_by_key_max_);
 }
 
 nlohmann::json AggregatePlanNode::ToJson() const {
@@ -95,6 +111,9 @@ nlohmann::json AggregatePlanNode::ToJson() const {
   j["groupby_terms"] = groupby_terms_;
   j["aggregate_terms"] = aggregate_terms_;
   j["aggregate_strategy"] = aggregate_strategy_;
+  j["has_group_by_key_range"] = has_group_by_key_range_;
+  j["group_by_key_min"] = group_by_key_min_;
+  j["group_by_key_max"] = group_by_key_max_;
   return j;
 }
 
@@ -133,6 +152,9 @@ std::vector<std::unique_ptr<parser::AbstractExpression>> AggregatePlanNode::From
   }
 
   aggregate_strategy_ = j.at("aggregate_strategy").get<AggregateStrategyType>();
+  has_group_by_key_range_ = j.at("has_group_by_key_range").get<bool>();
+  group_by_key_min_ = j.at("group_by_key_min").get<int64_t>();
+  group_by_key_max_ = j.at("group_by_key_max").get<int64_t>();
   return exprs;
 }
 
@@ -14,7 +14,7 @@ std::unique_ptr<IndexScanPlanNode> IndexScanPlanNode::Builder::Build() {
       std::move(children_), std::move(output_schema_), scan_predicate_, std::move(column_oids_), is_for_update_,
       database_oid_, index_oid_, table_oid_, scan_type_, std::move(lo_index_cols_), std::move(hi_index_cols_),
       scan_limit_, scan_has_limit_, scan_offset_, scan_has_offset_, index_size_, table_num_tuple_, cover_all_columns_,
-      plan_node_id_));
+      index_only_, ordered_, plan_node_id_));
 }
 
 IndexScanPlanNode::IndexScanPlanNode(
@@ -24,7 +24,7 @@ IndexScanPlanNode::IndexScanPlanNode(
     IndexScanType scan_type, std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> &&lo_index_cols,
     std::unordered_map<catalog::indexkeycol_oid_t, IndexExpression> &&hi_index_cols, uint32_t scan_limit,
     bool scan_has_limit, uint32_t scan_offset, bool scan_has_offset, uint64_t index_size, uint64_t table_num_tuple,
-    bool cover_all_columns, plan_node_id_t plan_node_id)
+    bool cover_all_columns, bool index_only, bool ordered, plan_node_id_t plan_node_id)
     : AbstractScanPlanNode(std::move(children), std::move(output_schema), predicate, is_for_update, database_oid,
                            scan_limit, scan_has_limit, scan_offset, scan_has_offset, plan_node_id),
       scan_type_(scan_type),
@@ -35,7 +35,9 @@ IndexScanPlanNode::IndexScanPlanNode(
       hi_index_cols_(std::move(hi_index_cols)),
       table_num_tuple_(table_num_tuple),
       index_size_(index_size),
-      cover_all_columns_(cover_all_columns) {}
+      cover_all_columns_(cover_all_columns),
+      index_only_(index_only),
+      ordered_(ordered) {}
 
 common::hash_t IndexScanPlanNode::Hash() const {
   common::hash_t hash = AbstractScanPlanNode::Hash();
@@ -47,6 +49,10 @@ common::hash_t IndexScanPlanNode::Hash() const {
 
   hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(cover_all_columns_));
 
+  hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(index_only_));
+
+  hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(ordered_));
+
   return hash;
 }
 
@@ -59,6 +65,10 @@ bool IndexScanPlanNode::operator==(const AbstractPlanNode &rhs) const {
 
   if (cover_all_columns_ != other.cover_all_columns_) return false;
 
+  if (index_only_ != other.index_only_) return false;
+
+  if (ordered_ != other.ordered_) return false;
+
   // Index Oid
   return (index_oid_ == other.index_oid_);
 }
@@ -68,6 +78,8 @@ nlohmann::json IndexScanPlanNode::ToJson() const {
   j["index_oid"] = index_oid_;
   j["column_oids"] = column_oids_;
   j["cover_all_columns"] = cover_all_columns_;
+  j["index_only"] = index_only_;
+  j["ordered"] = ordered_;
   return j;
 }
 
@@ -78,6 +90,8 @@ std::vector<std::unique_ptr<parser::AbstractExpression>> IndexScanPlanNode::From
   index_oid_ = j.at("index_oid").get<catalog::index_oid_t>();
   column_oids_ = j.at("column_oids").get<std::vector<catalog::col_oid_t>>();
   cover_all_columns_ = j.at("cover_all_columns").get<bool>();
+  index_only_ = j.at("index_only").get<bool>();
+  ordered_ = j.at("ordered").get<bool>();
   return exprs;
 }
 
@@ -18,6 +18,8 @@ std::string PlanNodeTypeToString(PlanNodeType type) {
       return "NestedLoop";
     case PlanNodeType::HASHJOIN:
       return "HashJoin";
+    case PlanNodeType::MERGEJOIN:
+      return "MergeJoin";
     case PlanNodeType::INDEXNLJOIN:
       return "IndexNestedLoopJoin";
     case PlanNodeType::UPDATE:
@@ -68,6 +70,8 @@ std::string PlanNodeTypeToString(PlanNodeType type) {
       return "Hash";
     case PlanNodeType::SETOP:
       return "SetOperation";
+    case PlanNodeType::WINDOW:
+      return "Window";
     case PlanNodeType::EXPORT_EXTERNAL_FILE:
       return "ExportExternalFile";
     case PlanNodeType::RESULT:
@@ -100,6 +104,8 @@ std::string JoinTypeToString(LogicalJoinType type) {
       return "RightSemi";
     case LogicalJoinType::RIGHT_ANTI:
       return "RightAnti";
+    case LogicalJoinType::RIGHT_MARK:
+      return "RightMark";
   }
   UNREACHABLE("Impossible to reach. All join types handled.");
 }
@@ -0,0 +1,166 @@
+#include "planner/plannodes/window_plan_node.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "common/hash_util.h"
+#include "common/json.h"
+#include "planner/plannodes/output_schema.h"
+
+namespace noisepage::planner {
+
+std::unique_ptr<WindowPlanNode> WindowPlanNode::Builder::Build() {
+  return std::unique_ptr<WindowPlanNode>(new WindowPlanNode(std::move(children_), std::move(output_schema_),
+                                                            std::move(partition_by_terms_), std::move(sort_keys_),
+                                                            std::move(window_functions_), plan_node_id_));
+}
+
+WindowPlanNode::WindowPlanNode(std::vector<std::unique_ptr<AbstractPlanNode>> &&children,
+                               std::unique_ptr<OutputSchema> output_schema,
+                               std::vector<PartitionByTerm> partition_by_terms, std::vector<SortKey> sort_keys,
+                               std::vector<WindowFunction> window_functions, plan_node_id_t plan_node_id)
+    : AbstractPlanNode(std::move(children), std::move(output_schema), plan_node_id),
+      partition_by_terms_(std::move(partition_by_terms)),
+      sort_keys_(std::move(sort_keys)),
+      window_functions_(std::move(window_functions)) {}
+
+std::vector<size_t> WindowPlanNode::GetMemoryAllocatingAggregatorIndexes() const {
+  std::vector<size_t> memory_allocating_aggregator_indexes;
+  for (size_t func_idx = 0; func_idx < window_functions_.size(); func_idx++) {
+    const auto &aggregate = window_functions_[func_idx].second;
+    if (aggregate != nullptr && aggregate->RequiresCleanup()) {
+      memory_allocating_aggregator_indexes.emplace_back(func_idx);
+    }
+  }
+  return memory_allocating_aggregator_indexes;
+}
+
+common::hash_t WindowPlanNode::Hash() const {
+  common::hash_t hash = AbstractPlanNode::Hash();
+
+  // Partition By Terms
+  for (const auto &term : partition_by_terms_) {
+    hash = common::HashUtil::CombineHashes(hash, term->Hash());
+  }
+
+  // Sort Keys
+  for (const auto &sort_key : sort_keys_) {
+    hash = common::HashUtil::CombineHashes(hash, sort_key.first->Hash());
+    hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(sort_key.second));
+  }
+
+  // Window Functions
+  for (const auto &[type, aggregate] : window_functions_) {
+    hash = common::HashUtil::CombineHashes(hash, common::HashUtil::Hash(type));
+    if (aggregate != nullptr) {
+      hash = common::HashUtil::CombineHashes(hash, aggregate->Hash());
+    }
+  }
+
+  return hash;
+}
+
+bool WindowPlanNode::operator==(const AbstractPlanNode &rhs) const {
+  if (!AbstractPlanNode::operator==(rhs)) return false;
+
+  auto &other = static_cast<const WindowPlanNode &>(rhs);
+
+  // Partition By Terms
+  if (partition_by_terms_.size() != other.partition_by_terms_.size()) return false;
+  for (auto i = 0U; i < partition_by_terms_.size(); i++) {
+    if (*partition_by_terms_[i] != *other.partition_by_terms_[i]) return false;
+  }
+
+  // Sort Keys
+  if (sort_keys_.size() != other.sort_keys_.size()) return false;
+  for (auto i = 0U; i < sort_keys_.size(); i++) {
+    if (sort_keys_[i].second != other.sort_keys_[i].second) return false;
+    if (*sort_keys_[i].first != *other.sort_keys_[i].first) return false;
+  }
+
+  // Window Functions
+  if (window_functions_.size() != other.window_functions_.size()) return false;
+  for (auto i = 0U; i < window_functions_.size(); i++) {
+    const auto &[type, aggregate] = window_functions_[i];
+    const auto &[other_type, other_aggregate] = other.window_functions_[i];
+    if (type != other_type) return false;
+    if ((aggregate == nullptr) != (other_aggregate == nullptr)) return false;
+    if (aggregate != nullptr && *aggregate != *other_aggregate) return false;
+  }
+
+  return true;
+}
+
+nlohmann::json WindowPlanNode::ToJson() const {
+  nlohmann::json j = AbstractPlanNode::ToJson();
+
+  std::vector<nlohmann::json> partition_by_terms;
+  partition_by_terms.reserve(partition_by_terms_.size());
+  for (const auto &term : partition_by_terms_) {
+    partition_by_terms.emplace_back(term->ToJson());
+  }
+  j["partition_by_terms"] = partition_by_terms;
+
+  std::vector<std::pair<nlohmann::json, optimizer::OrderByOrderingType>> sort_keys;
+  sort_keys.reserve(sort_keys_.size());
+  for (const auto &key : sort_keys_) {
+    sort_keys.emplace_back(key.first->ToJson(), key.second);
+  }
+  j["sort_keys"] = sort_keys;
+
+  std::vector<std::pair<WindowFunctionType, nlohmann::json>> window_functions;
+  window_functions.reserve(window_functions_.size());
+  for (const auto &[type, aggregate] : window_functions_) {
+    window_functions.emplace_back(type, aggregate == nullptr ? nlohmann::json() : aggregate->ToJson());
+  }
+  j["window_functions"] = window_functions;
+  return j;
+}
+
+std::vector<std::unique_ptr<parser::AbstractExpression>> WindowPlanNode::FromJson(const nlohmann::json &j) {
+  std::vector<std::unique_ptr<parser::AbstractExpression>> exprs;
+  auto e1 = AbstractPlanNode::FromJson(j);
+  exprs.insert(exprs.end(), std::make_move_iterator(e1.begin()), std::make_move_iterator(e1.end()));
+
+  // Deserialize partition by terms
+  auto partition_by_terms = j.at("partition_by_terms").get<std::vector<nlohmann::json>>();
+  for (const auto &json : partition_by_terms) {
+    auto deserialized = parser::DeserializeExpression(json);
+    partition_by_terms_.emplace_back(common::ManagedPointer(deserialized.result_));
+    exprs.emplace_back(std::move(deserialized.result_));
+    exprs.insert(exprs.end(), std::make_move_iterator(deserialized.non_owned_exprs_.begin()),
+                 std::make_move_iterator(deserialized.non_owned_exprs_.end()));
+  }
+
+  // Deserialize sort keys
+  auto sort_keys = j.at("sort_keys").get<std::vector<std::pair<nlohmann::json, optimizer::OrderByOrderingType>>>();
+  for (const auto &key_json : sort_keys) {
+    auto deserialized = parser::DeserializeExpression(key_json.first);
+    sort_keys_.emplace_back(common::ManagedPointer(deserialized.result_), key_json.second);
+    exprs.emplace_back(std::move(deserialized.result_));
+    exprs.insert(exprs.end(), std::make_move_iterator(deserialized.non_owned_exprs_.begin()),
+                 std::make_move_iterator(deserialized.non_owned_exprs_.end()));
+  }
+
+  // Deserialize window functions
+  auto window_functions = j.at("window_functions").get<std::vector<std::pair<WindowFunctionType, nlohmann::json>>>();
+  for (const auto &[type, aggregate_json] : window_functions) {
+    if (aggregate_json.is_null()) {
+      window_functions_.emplace_back(type, nullptr);
+      continue;
+    }
+    auto deserialized = parser::DeserializeExpression(aggregate_json);
+    auto agg_ptr = common::ManagedPointer(deserialized.result_).CastManagedPointerTo<parser::AggregateExpression>();
+    window_functions_.emplace_back(type, agg_ptr);
+    exprs.emplace_back(std::move(deserialized.result_));
+    exprs.insert(exprs.end(), std::make_move_iterator(deserialized.non_owned_exprs_.begin()),
+                 std::make_move_iterator(deserialized.non_owned_exprs_.end()));
+  }
+
+  return exprs;
+}
+
+DEFINE_JSON_BODY_DECLARATIONS(WindowPlanNode);
+
+}  // namespace noisepage::planner
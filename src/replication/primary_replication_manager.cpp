@@ -1,16 +1,28 @@
 #include "replication/primary_replication_manager.h"
 
-#include "common/json.h"
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <utility>
+
+#include "common/error/exception.h"
+#include "common/thread_context.h"
 #include "loggers/replication_logger.h"
+#include "metrics/metrics_store.h"
 #include "replication/replication_messages.h"
+#include "storage/checkpoint/checkpoint_manager.h"
 
 namespace noisepage::replication {
 
 PrimaryReplicationManager::PrimaryReplicationManager(
     common::ManagedPointer<messenger::Messenger> messenger, const std::string &network_identity, uint16_t port,
     const std::string &replication_hosts_path,
-    common::ManagedPointer<common::ConcurrentBlockingQueue<storage::BufferedLogWriter *>> empty_buffer_queue)
-    : ReplicationManager(messenger, network_identity, port, replication_hosts_path, empty_buffer_queue) {}
+    common::ManagedPointer<common::ConcurrentBlockingQueue<storage::BufferedLogWriter *>> empty_buffer_queue,
+    const uint32_t quorum_size, std::string checkpoint_root)
+    : ReplicationManager(messenger, network_identity, port, replication_hosts_path, empty_buffer_queue),
+      quorum_size_(quorum_size),
+      checkpoint_root_(std::move(checkpoint_root)) {}
 
 PrimaryReplicationManager::~PrimaryReplicationManager() = default;
 
@@ -22,6 +34,14 @@ void PrimaryReplicationManager::EventLoop(common::ManagedPointer<messenger::Mess
       Handle(zmq_msg, *msg.CastManagedPointerTo<TxnAppliedMsg>());
       break;
     }
+    case ReplicationMessageType::BATCHES_RECEIVED: {
+      Handle(zmq_msg, *msg.CastManagedPointerTo<BatchesReceivedMsg>());
+      break;
+    }
+    case ReplicationMessageType::CHECKPOINT_REQUEST: {
+      Handle(zmq_msg, *msg.CastManagedPointerTo<CheckpointRequestMsg>());
+      break;
+    }
     default: {
       // Delegate to the common ReplicationManager event loop.
       ReplicationManager::EventLoop(messenger, zmq_msg, msg);
@@ -37,11 +57,20 @@ void PrimaryReplicationManager::ReplicateBatchOfRecords(storage::BufferedLogWrit
   REPLICATION_LOG_TRACE(fmt::format("[SEND] Preparing ReplicateBatchOfRecords."));
   NOISEPAGE_ASSERT(policy != transaction::ReplicationPolicy::DISABLE, "Replication is disabled, so why are we here?");
 
+  // The batch ID is picked before the batch is sent, so that no replica can acknowledge it before it is known here.
+  const record_batch_id_t batch_id = records_batch != nullptr ? GetNextBatchId() : last_sent_batch_id_;
+
   if (policy == transaction::ReplicationPolicy::ASYNC) {
     // In asynchronous replication, just invoke the commit callbacks immediately.
     for (const auto &cb : commit_callbacks) {
       cb.fn_(cb.arg_);
     }
+  } else if (policy == transaction::ReplicationPolicy::QUORUM) {
+    // In quorum replication, the callbacks are invoked once a quorum of the replicas has received the batch. Callbacks
+    // without a batch of their own are from read-only transactions, and only wait for the batches before them.
+    std::unique_lock lock(callbacks_mutex_);
+    quorum_callbacks_.emplace(batch_id, commit_callbacks);
+    ProcessQuorumCallbacks();
   } else {
     // Copy the commit callbacks into our local list. The callbacks are invoked when the replicas notify the primary
     // that the replicas have applied their corresponding transactions.
@@ -59,15 +88,16 @@ void PrimaryReplicationManager::ReplicateBatchOfRecords(storage::BufferedLogWrit
   }
 
   if (records_batch != nullptr) {
-    // Send the batch of records to all replicas.
+    // Send the batch of records to all replicas, once they have caught up enough to take more.
+    WaitForReplicasToKeepUp();
     ReplicationMessageMetadata metadata(GetNextMessageId());
-    RecordsBatchMsg msg(metadata, GetNextBatchId(), records_batch);
+    RecordsBatchMsg msg(metadata, batch_id, records_batch);
     REPLICATION_LOG_TRACE(fmt::format("[SEND] BATCH {}", msg.GetBatchId()));
 
     messenger::callback_id_t destination_cb =
         messenger::Messenger::GetBuiltinCallback(messenger::Messenger::BuiltinCallback::NOOP);
     const msg_id_t msg_id = msg.GetMessageId();
-    const std::string msg_string = msg.ToJson().dump();
+    const std::string msg_string = msg.Serialize();
     for (const auto &replica : replicas_) {
       Send(replica.first, msg_id, msg_string, messenger::CallbackFns::Noop, destination_cb);
     }
@@ -76,6 +106,12 @@ void PrimaryReplicationManager::ReplicateBatchOfRecords(storage::BufferedLogWrit
                      "The assumption is that transactions are monotonically increasing.");
     newest_txn_sent_ = newest_buffer_txn;
 
+    if (common::thread_context.metrics_store_ != nullptr &&
+        common::thread_context.metrics_store_->ComponentToRecord(metrics::MetricsComponent::REPLICATION)) {
+      common::thread_context.metrics_store_->RecordReplicationBatchSentData(
+          batch_id.UnderlyingValue(), msg_string.size(), replicas_.size(), newest_buffer_txn.UnderlyingValue());
+    }
+
     // Return the buffered log writer to the pool if necessary.
     if (records_batch->MarkSerialized()) {
       empty_buffer_queue_->Enqueue(records_batch);
@@ -92,7 +128,7 @@ void PrimaryReplicationManager::NotifyReplicasOfOAT(transaction::timestamp_t old
       messenger::Messenger::GetBuiltinCallback(messenger::Messenger::BuiltinCallback::NOOP);
 
   const msg_id_t msg_id = msg.GetMessageId();
-  const std::string msg_string = msg.ToJson().dump();
+  const std::string msg_string = msg.Serialize();
   for (const auto &replica : replicas_) {
     Send(replica.first, msg_id, msg_string, messenger::CallbackFns::Noop, destination_cb);
   }
@@ -114,6 +150,13 @@ void PrimaryReplicationManager::Handle(const messenger::ZmqMessage &zmq_msg, con
   transaction::timestamp_t txn_id = msg.GetAppliedTxnId();
   {
     std::unique_lock lock(callbacks_mutex_);
+    transaction::timestamp_t &applied =
+        last_txn_applied_on_replicas_.try_emplace(std::string(zmq_msg.GetRoutingId()), txn_id).first->second;
+    applied = std::max(applied, txn_id);
+    RecordReplicaProgress(std::string(zmq_msg.GetRoutingId()));
+    // The callbacks of synchronous transactions are added before their records are sent. Without any, the transaction
+    // was replicated under another policy, and nothing waits for it to be applied.
+    if (txn_callbacks_.empty()) return;
     if (txns_applied_on_replicas_.find(txn_id) == txns_applied_on_replicas_.end()) {
       txns_applied_on_replicas_.emplace(txn_id, std::unordered_set<std::string>{});
     }
@@ -127,6 +170,21 @@ void PrimaryReplicationManager::Handle(const messenger::ZmqMessage &zmq_msg, con
   }
 }
 
+void PrimaryReplicationManager::WaitForReplicasToKeepUp() {
+  for (const auto &replica : replicas_) {
+    const std::string &name = replica.first;
+    // A replica that already timed out is only checked, not waited on, until it catches up.
+    const bool is_lagging = lagging_replicas_.find(name) != lagging_replicas_.end();
+    const std::chrono::milliseconds timeout = is_lagging ? std::chrono::milliseconds(0) : BACKPRESSURE_TIMEOUT;
+    if (WaitForPendingMessages(name, MAX_PENDING_MESSAGES_PER_REPLICA, timeout)) {
+      lagging_replicas_.erase(name);
+    } else if (!is_lagging) {
+      REPLICATION_LOG_WARN(fmt::format("[SEND] Replica {} is not keeping up, no longer waiting for it.", name));
+      lagging_replicas_.emplace(name);
+    }
+  }
+}
+
 void PrimaryReplicationManager::ProcessTxnCallbacks() {
   while (!txn_callbacks_.empty()) {
     // Check that each respective callback's transaction has been applied on all the replicas.
@@ -154,4 +212,100 @@ void PrimaryReplicationManager::ProcessTxnCallbacks() {
   }
 }
 
+void PrimaryReplicationManager::Handle(const messenger::ZmqMessage &zmq_msg, const BatchesReceivedMsg &msg) {
+  REPLICATION_LOG_TRACE(fmt::format("[RECV] BatchesReceivedMsg from {}: ID {} BATCH {}", zmq_msg.GetRoutingId(),
+                                    msg.GetMessageId(), msg.GetBatchId()));
+  std::unique_lock lock(callbacks_mutex_);
+  // Acknowledgements may overtake each other, and only ever move forward.
+  record_batch_id_t &received =
+      batches_received_on_replicas_.try_emplace(std::string(zmq_msg.GetRoutingId()), INVALID_RECORD_BATCH_ID)
+          .first->second;
+  received = std::max(received, msg.GetBatchId());
+  RecordReplicaProgress(std::string(zmq_msg.GetRoutingId()));
+  ProcessQuorumCallbacks();
+}
+
+void PrimaryReplicationManager::RecordReplicaProgress(const std::string &replica) {
+  if (common::thread_context.metrics_store_ != nullptr &&
+      common::thread_context.metrics_store_->ComponentToRecord(metrics::MetricsComponent::REPLICATION)) {
+    auto received = batches_received_on_replicas_.find(replica);
+    auto applied = last_txn_applied_on_replicas_.find(replica);
+    const record_batch_id_t received_batch_id =
+        received != batches_received_on_replicas_.end() ? received->second : INVALID_RECORD_BATCH_ID;
+    const transaction::timestamp_t applied_txn_id =
+        applied != last_txn_applied_on_replicas_.end() ? applied->second : transaction::INITIAL_TXN_TIMESTAMP;
+    common::thread_context.metrics_store_->RecordReplicaProgressData(
+        replica, last_sent_batch_id_.UnderlyingValue(), received_batch_id.UnderlyingValue(),
+        newest_txn_sent_.UnderlyingValue(), applied_txn_id.UnderlyingValue());
+  }
+}
+
+void PrimaryReplicationManager::ProcessQuorumCallbacks() {
+  // Every batch up to the k-th newest batch received by a replica has been received by at least k replicas.
+  const auto quorum = std::min<std::size_t>(quorum_size_, replicas_.size());
+  record_batch_id_t quorum_batch_id = INVALID_RECORD_BATCH_ID;
+  if (quorum == 0) {
+    quorum_batch_id = last_sent_batch_id_;
+  } else if (batches_received_on_replicas_.size() >= quorum) {
+    std::vector<record_batch_id_t> received;
+    received.reserve(batches_received_on_replicas_.size());
+    for (const auto &replica : batches_received_on_replicas_) received.emplace_back(replica.second);
+    std::nth_element(received.begin(), received.begin() + (quorum - 1), received.end(), std::greater<>());
+    quorum_batch_id = received[quorum - 1];
+  }
+
+  while (!quorum_callbacks_.empty() && quorum_callbacks_.front().first <= quorum_batch_id) {
+    for (const auto &callback : quorum_callbacks_.front().second) {
+      callback.fn_(callback.arg_);
+      REPLICATION_LOG_TRACE(fmt::format("Quorum commit callback invoked for txn: {}", callback.txn_start_time_));
+    }
+    quorum_callbacks_.pop();
+  }
+}
+
+void PrimaryReplicationManager::Handle(const messenger::ZmqMessage &zmq_msg, const CheckpointRequestMsg &msg) {
+  REPLICATION_LOG_TRACE(
+      fmt::format("[RECV] CheckpointRequestMsg from {}: ID {}", zmq_msg.GetRoutingId(), msg.GetMessageId()));
+  const std::string replica(zmq_msg.GetRoutingId());
+  if (replicas_.find(replica) == replicas_.end()) {
+    REPLICATION_LOG_WARN(fmt::format("Checkpoint requested by unknown replica {}", replica));
+    return;
+  }
+  messenger::callback_id_t destination_cb =
+      messenger::Messenger::GetBuiltinCallback(messenger::Messenger::BuiltinCallback::NOOP);
+
+  // The checkpoint is read from disk in pieces and sent as it is read, so that it is never held in memory at once.
+  const std::optional<storage::CheckpointInfo> checkpoint =
+      checkpoint_root_.empty() ? std::nullopt : storage::CheckpointManager::GetLatestCheckpoint(checkpoint_root_);
+  uint64_t num_chunks = 0;
+  if (checkpoint.has_value()) {
+    for (const auto &table : checkpoint->tables_) {
+      const std::string file_name = storage::CheckpointManager::TableFileName(table.first, table.second);
+      std::ifstream file(checkpoint->path_ + "/" + file_name, std::ios::binary);
+      if (!file.is_open()) throw REPLICATION_EXCEPTION(fmt::format("Missing checkpoint file {}", file_name));
+      uint64_t offset = 0;
+      std::string contents(CHECKPOINT_CHUNK_SIZE, '\0');
+      // Every file is sent in at least one piece, so that empty tables are created on the replica too
+      do {
+        file.read(contents.data(), CHECKPOINT_CHUNK_SIZE);
+        const auto size = static_cast<uint64_t>(file.gcount());
+        CheckpointChunkMsg chunk(ReplicationMessageMetadata(GetNextMessageId()), checkpoint->timestamp_, file_name,
+                                 offset, contents.substr(0, size));
+        Send(replica, chunk.GetMessageId(), chunk.Serialize(), messenger::CallbackFns::Noop, destination_cb);
+        offset += size;
+        num_chunks++;
+      } while (file.good());
+    }
+  }
+
+  const auto timestamp = checkpoint.has_value() ? checkpoint->timestamp_ : transaction::INVALID_TXN_TIMESTAMP;
+  auto tables = checkpoint.has_value() ? checkpoint->tables_
+                                       : std::vector<std::pair<catalog::db_oid_t, catalog::table_oid_t>>{};
+  CheckpointShippedMsg shipped(ReplicationMessageMetadata(GetNextMessageId()), timestamp, num_chunks,
+                               std::move(tables));
+  REPLICATION_LOG_TRACE(fmt::format("[SEND] CheckpointShippedMsg -> {}: TIMESTAMP {} CHUNKS {}", replica,
+                                    shipped.GetTimestamp(), num_chunks));
+  Send(replica, shipped.GetMessageId(), shipped.Serialize(), messenger::CallbackFns::Noop, destination_cb);
+}
+
 }  // namespace noisepage::replication
@@ -1,6 +1,11 @@
 #include "replication/replica_replication_manager.h"
 
-#include "common/json.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include "common/error/exception.h"
 #include "loggers/replication_logger.h"
 #include "replication/replication_messages.h"
 
@@ -26,6 +31,77 @@ void ReplicaReplicationManager::Handle(const messenger::ZmqMessage &zmq_msg, con
                                     msg.GetMessageId(), msg.GetBatchId()));
   // Add the batch of log records directly to the provider, which handles out of order batches.
   provider_.AddBatchOfRecords(msg);
+
+  // Acknowledge the batches that are now received without gaps, all of them with one message.
+  batches_received_early_.emplace(msg.GetBatchId());
+  const record_batch_id_t last_received = last_received_batch_id_;
+  while (!batches_received_early_.empty() &&
+         *batches_received_early_.begin() == RecordsBatchMsg::NextBatchId(last_received_batch_id_)) {
+    last_received_batch_id_ = *batches_received_early_.begin();
+    batches_received_early_.erase(batches_received_early_.begin());
+  }
+  if (last_received_batch_id_ != last_received) NotifyPrimaryBatchesReceived();
+}
+
+void ReplicaReplicationManager::Handle(const messenger::ZmqMessage &zmq_msg, const CheckpointChunkMsg &msg) {
+  REPLICATION_LOG_TRACE(fmt::format("[RECV] CheckpointChunkMsg from {}: ID {} FILE {} OFFSET {}",
+                                    zmq_msg.GetRoutingId(), msg.GetMessageId(), msg.GetFileName(), msg.GetOffset()));
+  {
+    std::unique_lock lock(checkpoint_mutex_);
+    if (checkpoint_root_.empty()) throw REPLICATION_EXCEPTION("Received a checkpoint that was never requested.");
+    const auto checkpoint_dir = storage::CheckpointManager::CheckpointDirectory(checkpoint_root_, msg.GetTimestamp());
+    std::filesystem::create_directories(checkpoint_dir);
+    const auto path = checkpoint_dir + "/" + msg.GetFileName();
+    // Pieces may arrive in any order, so each one is written at its own offset.
+    std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+    if (!file.is_open()) file.open(path, std::ios::out | std::ios::binary);
+    file.seekp(static_cast<std::streamoff>(msg.GetOffset()));
+    file.write(msg.GetContents().data(), static_cast<std::streamsize>(msg.GetContents().size()));
+    if (!file.good()) throw REPLICATION_EXCEPTION(fmt::format("Failed to write checkpoint file {}", path));
+    checkpoint_chunks_received_++;
+  }
+  checkpoint_cv_.notify_all();
+}
+
+void ReplicaReplicationManager::Handle(const messenger::ZmqMessage &zmq_msg, const CheckpointShippedMsg &msg) {
+  REPLICATION_LOG_TRACE(fmt::format("[RECV] CheckpointShippedMsg from {}: ID {} TIMESTAMP {} CHUNKS {}",
+                                    zmq_msg.GetRoutingId(), msg.GetMessageId(), msg.GetTimestamp(),
+                                    msg.GetNumChunks()));
+  {
+    std::unique_lock lock(checkpoint_mutex_);
+    checkpoint_shipped_ = msg;
+  }
+  checkpoint_cv_.notify_all();
+}
+
+std::optional<storage::CheckpointInfo> ReplicaReplicationManager::RequestCheckpoint(
+    const std::string &checkpoint_root) {
+  {
+    std::unique_lock lock(checkpoint_mutex_);
+    checkpoint_root_ = checkpoint_root;
+    checkpoint_chunks_received_ = 0;
+    checkpoint_shipped_ = std::nullopt;
+  }
+
+  msg_id_t msg_id = GetNextMessageId();
+  REPLICATION_LOG_TRACE(fmt::format("[SEND] CheckpointRequestMsg -> primary: ID {}", msg_id));
+  CheckpointRequestMsg msg{ReplicationMessageMetadata(msg_id)};
+  Send("primary", msg_id, msg.Serialize(), nullptr,
+       messenger::Messenger::GetBuiltinCallback(messenger::Messenger::BuiltinCallback::NOOP));
+
+  std::unique_lock lock(checkpoint_mutex_);
+  checkpoint_cv_.wait(lock, [&] {
+    return checkpoint_shipped_.has_value() && checkpoint_chunks_received_ == checkpoint_shipped_->GetNumChunks();
+  });
+  const auto timestamp = checkpoint_shipped_->GetTimestamp();
+  checkpoint_root_.clear();
+  if (timestamp == transaction::INVALID_TXN_TIMESTAMP) return std::nullopt;
+
+  // The checkpoint only counts as complete once every table file is written, like one taken locally.
+  const auto checkpoint_dir = storage::CheckpointManager::CheckpointDirectory(checkpoint_root, timestamp);
+  std::filesystem::create_directories(checkpoint_dir);
+  storage::CheckpointManager::WriteManifest(checkpoint_dir, timestamp, checkpoint_shipped_->GetTables());
+  return storage::CheckpointInfo{timestamp, checkpoint_dir, checkpoint_shipped_->GetTables()};
 }
 
 void ReplicaReplicationManager::EventLoop(common::ManagedPointer<messenger::Messenger> messenger,
@@ -40,6 +116,14 @@ void ReplicaReplicationManager::EventLoop(common::ManagedPointer<messenger::Mess
       Handle(zmq_msg, *msg.CastManagedPointerTo<RecordsBatchMsg>());
       break;
     }
+    case ReplicationMessageType::CHECKPOINT_CHUNK: {
+      Handle(zmq_msg, *msg.CastManagedPointerTo<CheckpointChunkMsg>());
+      break;
+    }
+    case ReplicationMessageType::CHECKPOINT_SHIPPED: {
+      Handle(zmq_msg, *msg.CastManagedPointerTo<CheckpointShippedMsg>());
+      break;
+    }
     default: {
       // Delegate to the common ReplicationManager event loop.
       ReplicationManager::EventLoop(messenger, zmq_msg, msg);
@@ -48,14 +132,44 @@ void ReplicaReplicationManager::EventLoop(common::ManagedPointer<messenger::Mess
   }
 }
 
+void ReplicaReplicationManager::NotifyPrimaryBatchesReceived() {
+  msg_id_t msg_id = GetNextMessageId();
+  REPLICATION_LOG_TRACE(
+      fmt::format("[SEND] BatchesReceivedMsg -> primary: ID {} BATCH {}", msg_id, last_received_batch_id_));
+
+  BatchesReceivedMsg msg(ReplicationMessageMetadata(msg_id), last_received_batch_id_);
+  const std::string msg_string = msg.Serialize();
+  Send("primary", msg_id, msg_string, nullptr,
+       messenger::Messenger::GetBuiltinCallback(messenger::Messenger::BuiltinCallback::NOOP));
+}
+
 void ReplicaReplicationManager::NotifyPrimaryTransactionApplied(transaction::timestamp_t txn_start_time) {
   msg_id_t msg_id = GetNextMessageId();
   REPLICATION_LOG_TRACE(fmt::format("[SEND] TxnAppliedMsg -> primary: ID {} START {}", msg_id, txn_start_time));
 
   TxnAppliedMsg msg(ReplicationMessageMetadata(msg_id), txn_start_time);
-  const std::string msg_string = msg.ToJson().dump();
+  const std::string msg_string = msg.Serialize();
   Send("primary", msg_id, msg_string, nullptr,
        messenger::Messenger::GetBuiltinCallback(messenger::Messenger::BuiltinCallback::NOOP));
 }
 
+void ReplicaReplicationManager::SendChangeBatch(const std::string &subscriber, transaction::timestamp_t last_txn_id,
+                                                std::string changes) {
+  const std::chrono::milliseconds timeout =
+      subscriber_lagging_ ? std::chrono::milliseconds(0) : CHANGE_BATCH_BACKPRESSURE_TIMEOUT;
+  if (WaitForPendingMessages(subscriber, MAX_PENDING_CHANGE_BATCHES, timeout)) {
+    subscriber_lagging_ = false;
+  } else if (!subscriber_lagging_) {
+    REPLICATION_LOG_WARN(fmt::format("[SEND] Subscriber {} is not keeping up, no longer waiting for it.", subscriber));
+    subscriber_lagging_ = true;
+  }
+
+  msg_id_t msg_id = GetNextMessageId();
+  REPLICATION_LOG_TRACE(fmt::format("[SEND] ChangeBatchMsg -> {}: ID {} LAST {}", subscriber, msg_id, last_txn_id));
+
+  ChangeBatchMsg msg(ReplicationMessageMetadata(msg_id), last_txn_id, std::move(changes));
+  Send(subscriber, msg_id, msg.Serialize(), nullptr,
+       messenger::Messenger::GetBuiltinCallback(messenger::Messenger::BuiltinCallback::NOOP));
+}
+
 }  // namespace noisepage::replication
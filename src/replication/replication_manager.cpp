@@ -3,7 +3,6 @@
 #include <fstream>
 
 #include "common/error/exception.h"
-#include "common/json.h"
 #include "loggers/replication_logger.h"
 
 namespace noisepage::replication {
@@ -19,8 +18,7 @@ ReplicationManager::ReplicationManager(
   messenger_->ListenForConnection(
       listen_destination, network_identity,
       [this](common::ManagedPointer<messenger::Messenger> messenger, const messenger::ZmqMessage &msg) {
-        auto json = nlohmann::json::parse(msg.GetMessage());
-        auto replication_msg = BaseReplicationMessage::ParseFromJson(json);
+        auto replication_msg = BaseReplicationMessage::ParseFromBinary(msg.GetMessage());
         EventLoop(messenger, msg, common::ManagedPointer(replication_msg));
       });
   // Connect to all of the other nodes.
@@ -113,6 +111,11 @@ void ReplicationManager::Send(const std::string &destination, UNUSED_ATTRIBUTE c
   messenger_->SendMessage(con_id, message, source_callback, destination_callback);
 }
 
+bool ReplicationManager::WaitForPendingMessages(const std::string &destination, const uint32_t max_pending,
+                                                const std::chrono::milliseconds timeout) {
+  return messenger_->WaitForPendingMessagesBelow(GetNodeConnection(destination), max_pending, timeout);
+}
+
 void ReplicationManager::EventLoop(common::ManagedPointer<messenger::Messenger> messenger,
                                    const messenger::ZmqMessage &zmq_msg,
                                    common::ManagedPointer<BaseReplicationMessage> msg) {
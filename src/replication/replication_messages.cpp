@@ -1,62 +1,95 @@
 #include "replication/replication_messages.h"
 
-#include "common/json.h"
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/error/exception.h"
 #include "storage/write_ahead_log/log_io.h"
 
 namespace noisepage::replication {
 
-// All the string keys. Hopefully having them in one place minimizes conflict.
+namespace {
 
-const char *ReplicationMessageMetadata::key_message_id = "message_id";
-const char *BaseReplicationMessage::key_message_type = "message_type";
-const char *BaseReplicationMessage::key_metadata = "metadata";
-const char *NotifyOATMsg::key_batch_id = "oat_batch";
-const char *NotifyOATMsg::key_oldest_active_txn = "oat_ts";
-const char *RecordsBatchMsg::key_batch_id = "batch_id";
-const char *RecordsBatchMsg::key_contents = "contents";
-const char *TxnAppliedMsg::key_applied_txn_id = "applied_txn_id";
+// Append the bytes of a field to a binary message.
+template <typename T>
+void Write(std::string *out, const T &value) {
+  static_assert(std::is_trivially_copyable_v<T>, "Fields are sent as they are laid out in memory.");
+  out->append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
 
-// ReplicationMessageMetadata
+// Consume a field from the front of a binary message.
+template <typename T>
+T Read(std::string_view *in) {
+  static_assert(std::is_trivially_copyable_v<T>, "Fields are sent as they are laid out in memory.");
+  if (in->size() < sizeof(T)) throw REPLICATION_EXCEPTION("ReplicationMessage is too short.");
+  T value;
+  std::memcpy(&value, in->data(), sizeof(T));
+  in->remove_prefix(sizeof(T));
+  return value;
+}
+
+// Append a length-prefixed string of bytes to a binary message.
+void WriteBytes(std::string *out, const std::string_view bytes) {
+  Write(out, static_cast<uint64_t>(bytes.size()));
+  out->append(bytes);
+}
 
-common::json ReplicationMessageMetadata::ToJson() const {
-  common::json json;
-  json[key_message_id] = msg_id_;
-  return json;
+// Consume a length-prefixed string of bytes from the front of a binary message.
+std::string ReadBytes(std::string_view *in) {
+  const auto size = Read<uint64_t>(in);
+  if (in->size() < size) throw REPLICATION_EXCEPTION("ReplicationMessage is too short.");
+  std::string bytes(in->substr(0, size));
+  in->remove_prefix(size);
+  return bytes;
 }
 
-ReplicationMessageMetadata::ReplicationMessageMetadata(const common::json &json) : msg_id_(json[key_message_id]) {}
+}  // namespace
+
+// ReplicationMessageMetadata
+
+void ReplicationMessageMetadata::Serialize(std::string *out) const { Write(out, msg_id_); }
+
+ReplicationMessageMetadata::ReplicationMessageMetadata(std::string_view *in) : msg_id_(Read<msg_id_t>(in)) {}
 
 ReplicationMessageMetadata::ReplicationMessageMetadata(msg_id_t msg_id) : msg_id_(msg_id) {}
 
 // BaseReplicationMessage
 
-common::json BaseReplicationMessage::ToJson() const {
-  common::json json;
-  json[key_message_type] = ReplicationMessageTypeToString(type_);
-  json[key_metadata] = metadata_.ToJson();
-  return json;
+std::string BaseReplicationMessage::Serialize() const {
+  std::string out;
+  SerializeHeader(&out);
+  return out;
+}
+
+void BaseReplicationMessage::SerializeHeader(std::string *out) const {
+  Write(out, type_);
+  metadata_.Serialize(out);
 }
 
-BaseReplicationMessage::BaseReplicationMessage(const common::json &json)
-    : type_(ReplicationMessageTypeFromString(json[key_message_type].get<std::string>())),
-      metadata_(ReplicationMessageMetadata(json[key_metadata].get<common::json>())) {}
+BaseReplicationMessage::BaseReplicationMessage(std::string_view *in)
+    : type_(Read<ReplicationMessageType>(in)), metadata_(in) {}
 
 BaseReplicationMessage::BaseReplicationMessage(ReplicationMessageType type, ReplicationMessageMetadata metadata)
     : type_(type), metadata_(metadata) {}
 
 // NotifyOATMsg
 
-common::json NotifyOATMsg::ToJson() const {
-  common::json json = BaseReplicationMessage::ToJson();
-  json[key_batch_id] = batch_id_;
-  json[key_oldest_active_txn] = oldest_active_txn_;
-  return json;
+std::string NotifyOATMsg::Serialize() const {
+  std::string out;
+  SerializeHeader(&out);
+  Write(&out, batch_id_);
+  Write(&out, oldest_active_txn_);
+  return out;
 }
 
-NotifyOATMsg::NotifyOATMsg(const common::json &json)
-    : BaseReplicationMessage(json),
-      batch_id_(json[key_batch_id].get<record_batch_id_t>()),
-      oldest_active_txn_(json[key_oldest_active_txn].get<transaction::timestamp_t>()) {}
+NotifyOATMsg::NotifyOATMsg(std::string_view *in)
+    : BaseReplicationMessage(in),
+      batch_id_(Read<record_batch_id_t>(in)),
+      oldest_active_txn_(Read<transaction::timestamp_t>(in)) {}
 
 NotifyOATMsg::NotifyOATMsg(ReplicationMessageMetadata metadata, record_batch_id_t batch_id,
                            transaction::timestamp_t oldest_active_txn)
@@ -66,52 +99,207 @@ NotifyOATMsg::NotifyOATMsg(ReplicationMessageMetadata metadata, record_batch_id_
 
 // RecordsBatchMsg
 
-common::json RecordsBatchMsg::ToJson() const {
-  common::json json = BaseReplicationMessage::ToJson();
-  json[key_batch_id] = batch_id_;
-  json[key_contents] = nlohmann::json::to_cbor(contents_);
-  return json;
+std::string_view RecordsBatchMsg::GetContentsToSend() const {
+  if (buffer_ == nullptr) return contents_;
+  return std::string_view(buffer_->buffer_, buffer_->buffer_size_);
 }
 
-RecordsBatchMsg::RecordsBatchMsg(const common::json &json)
-    : BaseReplicationMessage(json),
-      batch_id_(json[key_batch_id].get<record_batch_id_t>()),
-      contents_(nlohmann::json::from_cbor(json[key_contents].get<std::vector<uint8_t>>())) {}
+std::string RecordsBatchMsg::Serialize() const {
+  // The contents are copied straight into the message, which is the only copy of them made to send them
+  const std::string_view contents = GetContentsToSend();
+  std::string out;
+  out.reserve(sizeof(ReplicationMessageType) + sizeof(msg_id_t) + sizeof(batch_id_) + sizeof(compressed_) +
+              sizeof(uint64_t) + contents.size());
+  SerializeHeader(&out);
+  Write(&out, batch_id_);
+  Write(&out, compressed_);
+  Write(&out, static_cast<uint64_t>(contents.size()));
+  out.append(contents);
+  return out;
+}
+
+RecordsBatchMsg::RecordsBatchMsg(std::string_view *in)
+    : BaseReplicationMessage(in),
+      batch_id_(Read<record_batch_id_t>(in)),
+      buffer_(nullptr),
+      compressed_(Read<bool>(in)) {
+  const auto size = Read<uint64_t>(in);
+  if (in->size() < size) throw REPLICATION_EXCEPTION("RecordsBatchMsg is too short.");
+  const std::string_view contents = in->substr(0, size);
+  in->remove_prefix(size);
+  if (!compressed_) {
+    contents_ = std::string(contents);
+    return;
+  }
+  // Decompress on receipt, so that the contents can be read like any other batch
+  storage::LogCompression::FrameHeader header;
+  if (contents.size() < sizeof(header)) throw REPLICATION_EXCEPTION("Compressed RecordsBatchMsg is too short.");
+  std::memcpy(&header, contents.data(), sizeof(header));
+  if (contents.size() != sizeof(header) + header.stored_size_) {
+    throw REPLICATION_EXCEPTION("Compressed RecordsBatchMsg has the wrong size.");
+  }
+  contents_ = std::string(header.size_, '\0');
+  storage::LogCompression::DecompressFrame(header, contents.data() + sizeof(header), contents_.data());
+  compressed_ = false;
+}
 
 RecordsBatchMsg::RecordsBatchMsg(ReplicationMessageMetadata metadata, record_batch_id_t batch_id,
                                  storage::BufferedLogWriter *buffer)
     : BaseReplicationMessage(ReplicationMessageType::RECORDS_BATCH, metadata),
       batch_id_(batch_id),
-      contents_(std::string(buffer->buffer_, buffer->buffer_size_)) {}
+      buffer_(buffer->IsCompressing() ? nullptr : buffer),
+      compressed_(buffer->IsCompressing()) {
+  if (compressed_) {
+    std::vector<char> frame;
+    storage::LogCompression::CompressFrame(buffer->buffer_, buffer->buffer_size_, &frame);
+    contents_ = std::string(frame.begin(), frame.end());
+  }
+}
 
 // TxnAppliedMsg
 
-common::json TxnAppliedMsg::ToJson() const {
-  common::json json = BaseReplicationMessage::ToJson();
-  json[key_applied_txn_id] = applied_txn_id_;
-  return json;
+std::string TxnAppliedMsg::Serialize() const {
+  std::string out;
+  SerializeHeader(&out);
+  Write(&out, applied_txn_id_);
+  return out;
 }
 
-TxnAppliedMsg::TxnAppliedMsg(const common::json &json)
-    : BaseReplicationMessage(json), applied_txn_id_(json[key_applied_txn_id].get<transaction::timestamp_t>()) {}
+TxnAppliedMsg::TxnAppliedMsg(std::string_view *in)
+    : BaseReplicationMessage(in), applied_txn_id_(Read<transaction::timestamp_t>(in)) {}
 
 TxnAppliedMsg::TxnAppliedMsg(ReplicationMessageMetadata metadata, transaction::timestamp_t applied_txn_id)
     : BaseReplicationMessage(ReplicationMessageType::TXN_APPLIED, metadata), applied_txn_id_(applied_txn_id) {}
 
-std::unique_ptr<BaseReplicationMessage> BaseReplicationMessage::ParseFromJson(const common::json &json) {
-  // BaseReplicationMessage switches on the json's key_message_type to figure out what type of message to create.
-  ReplicationMessageType msg_type = ReplicationMessageTypeFromString(json[key_message_type]);
+// BatchesReceivedMsg
+
+std::string BatchesReceivedMsg::Serialize() const {
+  std::string out;
+  SerializeHeader(&out);
+  Write(&out, batch_id_);
+  return out;
+}
+
+BatchesReceivedMsg::BatchesReceivedMsg(std::string_view *in)
+    : BaseReplicationMessage(in), batch_id_(Read<record_batch_id_t>(in)) {}
+
+BatchesReceivedMsg::BatchesReceivedMsg(ReplicationMessageMetadata metadata, record_batch_id_t batch_id)
+    : BaseReplicationMessage(ReplicationMessageType::BATCHES_RECEIVED, metadata), batch_id_(batch_id) {}
+
+// CheckpointRequestMsg
+
+CheckpointRequestMsg::CheckpointRequestMsg(std::string_view *in) : BaseReplicationMessage(in) {}
+
+CheckpointRequestMsg::CheckpointRequestMsg(ReplicationMessageMetadata metadata)
+    : BaseReplicationMessage(ReplicationMessageType::CHECKPOINT_REQUEST, metadata) {}
+
+// CheckpointChunkMsg
+
+std::string CheckpointChunkMsg::Serialize() const {
+  std::string out;
+  out.reserve(sizeof(ReplicationMessageType) + sizeof(msg_id_t) + sizeof(timestamp_) + sizeof(offset_) +
+              2 * sizeof(uint64_t) + file_name_.size() + contents_.size());
+  SerializeHeader(&out);
+  Write(&out, timestamp_);
+  WriteBytes(&out, file_name_);
+  Write(&out, offset_);
+  WriteBytes(&out, contents_);
+  return out;
+}
+
+CheckpointChunkMsg::CheckpointChunkMsg(std::string_view *in)
+    : BaseReplicationMessage(in),
+      timestamp_(Read<transaction::timestamp_t>(in)),
+      file_name_(ReadBytes(in)),
+      offset_(Read<uint64_t>(in)),
+      contents_(ReadBytes(in)) {}
+
+CheckpointChunkMsg::CheckpointChunkMsg(ReplicationMessageMetadata metadata, transaction::timestamp_t timestamp,
+                                       std::string file_name, uint64_t offset, std::string contents)
+    : BaseReplicationMessage(ReplicationMessageType::CHECKPOINT_CHUNK, metadata),
+      timestamp_(timestamp),
+      file_name_(std::move(file_name)),
+      offset_(offset),
+      contents_(std::move(contents)) {}
+
+// CheckpointShippedMsg
+
+std::string CheckpointShippedMsg::Serialize() const {
+  std::string out;
+  SerializeHeader(&out);
+  Write(&out, timestamp_);
+  Write(&out, num_chunks_);
+  Write(&out, static_cast<uint64_t>(tables_.size()));
+  for (const auto &table : tables_) {
+    Write(&out, table.first);
+    Write(&out, table.second);
+  }
+  return out;
+}
+
+CheckpointShippedMsg::CheckpointShippedMsg(std::string_view *in)
+    : BaseReplicationMessage(in),
+      timestamp_(Read<transaction::timestamp_t>(in)),
+      num_chunks_(Read<uint64_t>(in)) {
+  const auto num_tables = Read<uint64_t>(in);
+  for (uint64_t i = 0; i < num_tables; i++) {
+    const auto db_oid = Read<catalog::db_oid_t>(in);
+    tables_.emplace_back(db_oid, Read<catalog::table_oid_t>(in));
+  }
+}
+
+CheckpointShippedMsg::CheckpointShippedMsg(ReplicationMessageMetadata metadata, transaction::timestamp_t timestamp,
+                                           uint64_t num_chunks,
+                                           std::vector<std::pair<catalog::db_oid_t, catalog::table_oid_t>> tables)
+    : BaseReplicationMessage(ReplicationMessageType::CHECKPOINT_SHIPPED, metadata),
+      timestamp_(timestamp),
+      num_chunks_(num_chunks),
+      tables_(std::move(tables)) {}
+
+// ChangeBatchMsg
+
+std::string ChangeBatchMsg::Serialize() const {
+  std::string out;
+  out.reserve(sizeof(ReplicationMessageType) + sizeof(msg_id_t) + sizeof(last_txn_id_) + sizeof(uint64_t) +
+              changes_.size());
+  SerializeHeader(&out);
+  Write(&out, last_txn_id_);
+  WriteBytes(&out, changes_);
+  return out;
+}
+
+ChangeBatchMsg::ChangeBatchMsg(std::string_view *in)
+    : BaseReplicationMessage(in), last_txn_id_(Read<transaction::timestamp_t>(in)), changes_(ReadBytes(in)) {}
+
+ChangeBatchMsg::ChangeBatchMsg(ReplicationMessageMetadata metadata, transaction::timestamp_t last_txn_id,
+                               std::string changes)
+    : BaseReplicationMessage(ReplicationMessageType::CHANGE_BATCH, metadata),
+      last_txn_id_(last_txn_id),
+      changes_(std::move(changes)) {}
+
+std::unique_ptr<BaseReplicationMessage> BaseReplicationMessage::ParseFromBinary(std::string_view message) {
+  // BaseReplicationMessage switches on the message type at the front to figure out what type of message to create.
+  std::string_view type_field = message;
+  const auto msg_type = Read<ReplicationMessageType>(&type_field);
+  std::unique_ptr<BaseReplicationMessage> msg;
   switch (msg_type) {
       // clang-format off
-    case ReplicationMessageType::NOTIFY_OAT:          { return std::make_unique<NotifyOATMsg>(json); }
-    case ReplicationMessageType::RECORDS_BATCH:       { return std::make_unique<RecordsBatchMsg>(json); }
-    case ReplicationMessageType::TXN_APPLIED:         { return std::make_unique<TxnAppliedMsg>(json); }
+    case ReplicationMessageType::NOTIFY_OAT:          { msg = std::make_unique<NotifyOATMsg>(&message); break; }
+    case ReplicationMessageType::RECORDS_BATCH:       { msg = std::make_unique<RecordsBatchMsg>(&message); break; }
+    case ReplicationMessageType::TXN_APPLIED:         { msg = std::make_unique<TxnAppliedMsg>(&message); break; }
+    case ReplicationMessageType::BATCHES_RECEIVED:    { msg = std::make_unique<BatchesReceivedMsg>(&message); break; }
+    case ReplicationMessageType::CHECKPOINT_REQUEST:  { msg = std::make_unique<CheckpointRequestMsg>(&message); break; }
+    case ReplicationMessageType::CHECKPOINT_CHUNK:    { msg = std::make_unique<CheckpointChunkMsg>(&message); break; }
+    case ReplicationMessageType::CHECKPOINT_SHIPPED:  { msg = std::make_unique<CheckpointShippedMsg>(&message); break; }
+    case ReplicationMessageType::CHANGE_BATCH:        { msg = std::make_unique<ChangeBatchMsg>(&message); break; }
     case ReplicationMessageType::INVALID:             // Fall-through.
-    case ReplicationMessageType::NUM_ENUM_ENTRIES:
+    case ReplicationMessageType::NUM_ENUM_ENTRIES:    // Fall-through.
+    default:
       throw REPLICATION_EXCEPTION("Got an INVALID ReplicationMessage?");
       // clang-format on
   }
-  throw REPLICATION_EXCEPTION("This case is impossible but GCC can't figure it out.");
+  if (!message.empty()) throw REPLICATION_EXCEPTION("ReplicationMessage is too long.");
+  return msg;
 }
 
 }  // namespace noisepage::replication
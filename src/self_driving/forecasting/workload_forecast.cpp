@@ -1,6 +1,9 @@
 #include "self_driving/forecasting/workload_forecast.h"
 
+#include <fstream>
 #include <map>
+#include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -14,7 +17,47 @@
 
 namespace noisepage::selfdriving {
 
-WorkloadForecast::WorkloadForecast(uint64_t forecast_interval) : forecast_interval_(forecast_interval) {
+namespace {
+
+/**
+ * Calls parse_line on every line appended to a file since the given offset, skipping the header, and moves the offset
+ * past them. A line that the metrics thread is still writing is left for the next call.
+ */
+template <typename F>
+void ReadNewLines(const std::string_view file_name, std::streamoff *const offset, F parse_line) {
+  // Create an input filestream
+  std::ifstream file{std::string(file_name)};
+  // Make sure the file is open
+  if (!file.is_open())
+    throw PILOT_EXCEPTION(fmt::format("Could not open file {}", file_name), common::ErrorCode::ERRCODE_IO_ERROR);
+
+  // A file shorter than what was read of it has been started over
+  file.seekg(0, std::ios_base::end);
+  if (file.tellg() < *offset) *offset = 0;
+  file.seekg(*offset);
+  if (!file.good()) throw PILOT_EXCEPTION("File stream is not good", common::ErrorCode::ERRCODE_IO_ERROR);
+
+  // Only lines followed by a newline are complete, and getline() sets eof on the one that is not
+  std::string line;
+  if (*offset == 0) {
+    // ignore header
+    if (!std::getline(file, line) || file.eof()) return;
+    *offset = file.tellg();
+  }
+  while (std::getline(file, line) && !file.eof()) {
+    parse_line(&line);
+    *offset = file.tellg();
+  }
+}
+
+}  // namespace
+
+WorkloadForecast::WorkloadForecast(uint64_t forecast_interval, uint64_t max_segments)
+    : forecast_interval_(forecast_interval), max_segments_(max_segments) {
+  Update();
+}
+
+void WorkloadForecast::Update() {
   LoadQueryText();
   LoadQueryTrace();
   CreateSegments();
@@ -25,26 +68,32 @@ WorkloadForecast::WorkloadForecast(uint64_t forecast_interval) : forecast_interv
  * and then partitioned by timestamps and forecast_interval into segments.
  *
  * These segments will eventually store the result of workload/query arrival rate prediction.
+ *
+ * The last segment stays open, so that the queries of the next update that fall into its interval are counted in it.
  */
 void WorkloadForecast::CreateSegments() {
-  std::unordered_map<execution::query_id_t, uint64_t> curr_segment;
-
-  uint64_t curr_time = query_timestamp_to_id_.begin()->first;
+  // The open segment is replaced by itself with the new queries counted in
+  if (!open_segment_.empty()) forecast_segments_.pop_back();
 
   // We assume the traces are sorted by timestamp in increasing order
   for (auto &it : query_timestamp_to_id_) {
-    if (it.first > curr_time + forecast_interval_) {
-      forecast_segments_.emplace_back(std::move(curr_segment));
-      curr_time = it.first;
-      curr_segment = std::unordered_map<execution::query_id_t, uint64_t>();
+    if (open_segment_.empty()) {
+      open_segment_start_ = it.first;
+    } else if (it.first > open_segment_start_ + forecast_interval_) {
+      forecast_segments_.emplace_back(std::move(open_segment_));
+      open_segment_start_ = it.first;
+      open_segment_ = std::unordered_map<execution::query_id_t, uint64_t>();
     }
-
-    if (curr_segment.find(it.second) == curr_segment.end()) curr_segment.emplace(it.second, 0);
-    curr_segment[it.second] += 1;
+    open_segment_[it.second] += 1;
   }
+  query_timestamp_to_id_.clear();
 
-  if (!curr_segment.empty()) {
-    forecast_segments_.emplace_back(std::move(curr_segment));
+  if (!open_segment_.empty()) {
+    forecast_segments_.emplace_back(open_segment_);
+  }
+  // Only the most recent segments are kept to forecast the workload that follows them
+  if (max_segments_ > 0 && forecast_segments_.size() > max_segments_) {
+    forecast_segments_.erase(forecast_segments_.begin(), forecast_segments_.end() - max_segments_);
   }
   num_forecast_segment_ = forecast_segments_.size();
 }
@@ -56,20 +105,7 @@ void WorkloadForecast::LoadQueryText() {
   uint8_t query_text_col = std::count(tmp.begin(), tmp.end(), ',');
   // Parse qid and query text, assuming they are the first two columns, with query text wrapped in quotations marks
 
-  // Create an input filestream
-  std::ifstream query_text_file(std::string(metrics::QueryTraceMetricRawData::FILES[0]).c_str());
-  // Make sure the file is open
-  if (!query_text_file.is_open())
-    throw PILOT_EXCEPTION(fmt::format("Could not open file {}", metrics::QueryTraceMetricRawData::FILES[0]),
-                          common::ErrorCode::ERRCODE_IO_ERROR);
-
   // Helper vars
-  std::string line;
-  if (!query_text_file.good()) throw PILOT_EXCEPTION("File stream is not good", common::ErrorCode::ERRCODE_IO_ERROR);
-
-  // ignore header
-  std::getline(query_text_file, line);
-
   bool parse_succ;
   uint64_t db_oid;
   execution::query_id_t query_id;
@@ -78,7 +114,8 @@ void WorkloadForecast::LoadQueryText() {
   std::vector<std::string> val_vec(num_cols, "");
 
   // Read data, line by line
-  while (std::getline(query_text_file, line)) {
+  ReadNewLines(metrics::QueryTraceMetricRawData::FILES[0], &query_text_offset_, [&](std::string *const line_ptr) {
+    std::string &line = *line_ptr;
     std::vector<type::TypeId> param_types;
     colnum = 0;
     parse_succ = true;
@@ -107,7 +144,9 @@ void WorkloadForecast::LoadQueryText() {
       line.erase(0, pos + 2);
       colnum++;
     }
-    if (!parse_succ) continue;
+    // The last field is not followed by a separator
+    if (parse_succ && colnum == num_cols - 1) val_vec[colnum] = line;
+    if (!parse_succ) return;
 
     db_oid = static_cast<uint64_t>(std::stoi(val_vec[0]));
     query_id = static_cast<execution::query_id_t>(std::stoi(val_vec[1]));
@@ -123,36 +162,23 @@ void WorkloadForecast::LoadQueryText() {
 
     query_id_to_dboid_[query_id] = db_oid;
     query_id_to_param_types_[query_id] = std::move(param_types);
-  }
-  // Close file
-  query_text_file.close();
+  });
 }
 
 void WorkloadForecast::LoadQueryTrace() {
   std::string feat_cols = std::string{metrics::QueryTraceMetricRawData::FEATURE_COLUMNS[1]};
   uint8_t num_cols = std::count(feat_cols.begin(), feat_cols.end(), ',') + 1;
 
-  // Create an input filestream
-  std::ifstream trace_file(std::string(metrics::QueryTraceMetricRawData::FILES[1]).c_str());
-  // Make sure the file is open
-  if (!trace_file.is_open())
-    throw PILOT_EXCEPTION(fmt::format("Could not open file {}", metrics::QueryTraceMetricRawData::FILES[1]),
-                          common::ErrorCode::ERRCODE_IO_ERROR);
-
   // Helper vars
-  std::string line, param_string;
-  if (!trace_file.good()) throw PILOT_EXCEPTION("File stream is not good", common::ErrorCode::ERRCODE_IO_ERROR);
-
-  // ignore header
-  std::getline(trace_file, line);
-
+  std::string param_string;
   bool parse_succ;
   execution::query_id_t query_id;
   size_t pos, colnum;
   std::vector<std::string> val_vec(num_cols, "");
 
   // Read data, line by line
-  while (std::getline(trace_file, line)) {
+  ReadNewLines(metrics::QueryTraceMetricRawData::FILES[1], &query_trace_offset_, [&](std::string *const line_ptr) {
+    std::string &line = *line_ptr;
     colnum = 0;
     parse_succ = true;
     val_vec.assign(num_cols, "");
@@ -169,11 +195,14 @@ void WorkloadForecast::LoadQueryTrace() {
       line.erase(0, pos + 2);
       colnum++;
     }
+    // The last field is not followed by a separator
+    if (parse_succ && colnum == num_cols - 1) val_vec[colnum] = line;
 
-    if (!parse_succ) continue;
+    if (!parse_succ) return;
 
-    query_id = static_cast<execution::query_id_t>(std::stoi(val_vec[0]));
-    param_string = val_vec[2];
+    // The columns are db_oid, query_id, timestamp, connection_id, latency_us and parameters
+    query_id = static_cast<execution::query_id_t>(std::stoi(val_vec[1]));
+    param_string = val_vec[5];
 
     // extract each parameter in the param_string
     std::vector<parser::ConstantValueExpression> param_vec;
@@ -187,10 +216,8 @@ void WorkloadForecast::LoadQueryTrace() {
     if (query_id_to_params_[query_id].size() < num_sample_) {
       query_id_to_params_[query_id].push_back(param_vec);
     }
-    query_timestamp_to_id_.insert(std::make_pair(std::stoull(val_vec[1]), query_id));
-  }
-  // Close file
-  trace_file.close();
+    query_timestamp_to_id_.insert(std::make_pair(std::stoull(val_vec[2]), query_id));
+  });
 }
 
 }  // namespace noisepage::selfdriving
@@ -8,6 +8,8 @@
 #endif
 #include <sys/wait.h>
 
+#include <cstring>
+#include <memory>
 #include <thread>  // NOLINT
 
 #include "common/json.h"
@@ -33,6 +35,108 @@ static constexpr const char *COVERAGE_INCLUDE_PATH = "*/script/self_driving/*";
  */
 static constexpr const unsigned char MODEL_SERVER_SUBPROCESS_ERROR = 128;
 
+namespace {
+
+constexpr std::string_view BASE64_ALPHABET = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+std::string Base64Encode(const std::string_view bytes) {
+  std::string encoded;
+  encoded.reserve((bytes.size() + 2) / 3 * 4);
+  for (size_t i = 0; i < bytes.size(); i += 3) {
+    const size_t num_bytes = std::min<size_t>(3, bytes.size() - i);
+    uint32_t group = 0;
+    for (size_t j = 0; j < 3; j++) {
+      group = (group << 8) | (j < num_bytes ? static_cast<uint8_t>(bytes[i + j]) : 0);
+    }
+    for (size_t j = 0; j < 4; j++) {
+      encoded.push_back(j <= num_bytes ? BASE64_ALPHABET[(group >> (18 - 6 * j)) & 0x3F] : '=');
+    }
+  }
+  return encoded;
+}
+
+std::optional<std::string> Base64Decode(const std::string_view encoded) {
+  if (encoded.size() % 4 != 0) return std::nullopt;
+  std::string bytes;
+  bytes.reserve(encoded.size() / 4 * 3);
+  for (size_t i = 0; i < encoded.size(); i += 4) {
+    uint32_t group = 0;
+    size_t num_padding = 0;
+    for (size_t j = 0; j < 4; j++) {
+      const char c = encoded[i + j];
+      uint32_t value = 0;
+      if (c == '=' && i + 4 == encoded.size() && j >= 2) {
+        num_padding++;
+      } else {
+        const auto pos = BASE64_ALPHABET.find(c);
+        if (pos == std::string_view::npos || num_padding > 0) return std::nullopt;
+        value = static_cast<uint32_t>(pos);
+      }
+      group = (group << 6) | value;
+    }
+    for (size_t j = 0; j < 3 - num_padding; j++) bytes.push_back(static_cast<char>((group >> (16 - 8 * j)) & 0xFF));
+  }
+  return bytes;
+}
+
+// The doubles of encoded matrices are copied as they are in memory
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "Matrices are encoded as little endian doubles.");
+
+// Completes a future with the predictions of a batched inference, or with the failure of it
+void CompleteOUBatch(const std::string_view message, ModelServerFuture<OUMatrices> *const future) {
+  try {
+    nlohmann::json res = nlohmann::json::parse(message);
+    if (!res.at("success").get<bool>()) {
+      future->Fail(res.at("err").get<std::string>());
+      return;
+    }
+    OUMatrices predictions;
+    for (const auto &[opunit, encoded] : res.at("result").items()) {
+      if (!DecodeMatrix(encoded, &predictions[opunit])) {
+        future->Fail("WRONG_RESULT_FORMAT");
+        return;
+      }
+    }
+    future->Success(predictions);
+  } catch (nlohmann::json::exception &e) {
+    future->Fail("WRONG_RESULT_FORMAT");
+  }
+}
+
+}  // namespace
+
+nlohmann::json EncodeMatrix(const std::vector<std::vector<double>> &matrix) {
+  const size_t num_cols = matrix.empty() ? 0 : matrix[0].size();
+  std::string bytes;
+  bytes.reserve(matrix.size() * num_cols * sizeof(double));
+  for (const auto &row : matrix) {
+    NOISEPAGE_ASSERT(row.size() == num_cols, "Rows of a matrix must have the same size.");
+    bytes.append(reinterpret_cast<const char *>(row.data()), row.size() * sizeof(double));
+  }
+
+  nlohmann::json encoded;
+  encoded["shape"] = {matrix.size(), num_cols};
+  encoded["data"] = Base64Encode(bytes);
+  return encoded;
+}
+
+bool DecodeMatrix(const nlohmann::json &encoded, std::vector<std::vector<double>> *const matrix) {
+  try {
+    const auto shape = encoded.at("shape").get<std::vector<size_t>>();
+    const auto bytes = Base64Decode(encoded.at("data").get<std::string>());
+    if (shape.size() != 2 || !bytes.has_value() || bytes->size() != shape[0] * shape[1] * sizeof(double)) {
+      return false;
+    }
+    matrix->assign(shape[0], std::vector<double>(shape[1]));
+    for (size_t row = 0; row < shape[0] && shape[1] > 0; row++) {
+      std::memcpy((*matrix)[row].data(), bytes->data() + row * shape[1] * sizeof(double), shape[1] * sizeof(double));
+    }
+    return true;
+  } catch (nlohmann::json::exception &e) {
+    return false;
+  }
+}
+
 messenger::router_id_t ListenAndMakeConnection(const common::ManagedPointer<messenger::Messenger> &messenger,
                                                const std::string &ipc_path, messenger::CallbackFn model_server_logic) {
   // Create an IPC connection that the Python process will talk to.
@@ -258,7 +362,8 @@ bool ModelServerManager::TrainInterferenceModel(const std::vector<std::string> &
 
 template <class Result>
 std::pair<Result, bool> ModelServerManager::InferModel(ModelType::Type model, const std::string &model_path,
-                                                       nlohmann::json *payload) {
+                                                       nlohmann::json *payload,
+                                                       std::optional<std::chrono::milliseconds> timeout) {
   nlohmann::json j;
   j["cmd"] = "INFER";
   if (payload) {
@@ -269,13 +374,13 @@ std::pair<Result, bool> ModelServerManager::InferModel(ModelType::Type model, co
   j["data"]["type"] = ModelType::TypeToString(model);
   j["data"]["model_path"] = model_path;
 
-  // Sync communication
-  ModelServerFuture<Result> future;
+  // Sync communication. The future is shared with the callback, which may run after a waiter that timed out is gone.
+  auto future = std::make_shared<ModelServerFuture<Result>>();
 
   // Callback to notify waiter with result
-  auto callback = [&](common::ManagedPointer<messenger::Messenger> messenger, const messenger::ZmqMessage &msg) {
+  auto callback = [future](common::ManagedPointer<messenger::Messenger> messenger, const messenger::ZmqMessage &msg) {
     MODEL_SERVER_LOG_DEBUG("Callback :recv_cb_id={}, message={}", msg.GetDestinationCallbackId(), msg.GetMessage());
-    future.Done(msg.GetMessage());
+    future->Done(msg.GetMessage());
   };
 
   // Fail to send the message
@@ -283,15 +388,58 @@ std::pair<Result, bool> ModelServerManager::InferModel(ModelType::Type model, co
     return {{}, false};
   }
 
-  return future.Wait();
+  if (timeout.has_value()) {
+    return future->WaitFor(*timeout);
+  }
+  return future->Wait();
 }
 
 std::pair<std::vector<std::vector<double>>, bool> ModelServerManager::InferOUModel(
-    const std::string &opunit, const std::string &model_path, const std::vector<std::vector<double>> &features) {
+    const std::string &opunit, const std::string &model_path, const std::vector<std::vector<double>> &features,
+    std::optional<std::chrono::milliseconds> timeout) {
   nlohmann::json j;
   j["opunit"] = opunit;
   j["features"] = features;
-  return InferModel<std::vector<std::vector<double>>>(ModelType::Type::OperatingUnit, model_path, &j);
+  return InferModel<std::vector<std::vector<double>>>(ModelType::Type::OperatingUnit, model_path, &j, timeout);
+}
+
+template <class FuturePtr>
+bool ModelServerManager::SendInferOUBatch(const std::string &model_path, const OUMatrices &features,
+                                          FuturePtr future) {
+  nlohmann::json j;
+  j["cmd"] = "INFER_BATCH";
+  j["data"]["type"] = ModelType::TypeToString(ModelType::Type::OperatingUnit);
+  j["data"]["model_path"] = model_path;
+  j["data"]["features"] = nlohmann::json::object();
+  for (const auto &[opunit, opunit_features] : features) j["data"]["features"][opunit] = EncodeMatrix(opunit_features);
+
+  // Callback to notify the waiter for result, or failure to parse the result.
+  auto callback = [future](common::ManagedPointer<messenger::Messenger> messenger, const messenger::ZmqMessage &msg) {
+    MODEL_SERVER_LOG_DEBUG("Callback :recv_cb_id={}, message={}", msg.GetDestinationCallbackId(), msg.GetMessage());
+    CompleteOUBatch(msg.GetMessage(), &*future);
+  };
+
+  return SendMessage(j.dump(), callback);
+}
+
+bool ModelServerManager::InferOUModelsAsync(const std::string &model_path, const OUMatrices &features,
+                                            common::ManagedPointer<ModelServerFuture<OUMatrices>> future) {
+  return SendInferOUBatch(model_path, features, future);
+}
+
+std::pair<OUMatrices, bool> ModelServerManager::InferOUModels(const std::string &model_path,
+                                                              const OUMatrices &features,
+                                                              std::optional<std::chrono::milliseconds> timeout) {
+  // The future is shared with the callback, which may run after a waiter that timed out is gone.
+  auto future = std::make_shared<ModelServerFuture<OUMatrices>>();
+  if (!SendInferOUBatch(model_path, features, future)) {
+    return {{}, false};
+  }
+
+  if (timeout.has_value()) {
+    return future->WaitFor(*timeout);
+  }
+  return future->Wait();
 }
 
 std::pair<selfdriving::WorkloadForecastPrediction, bool> ModelServerManager::InferForecastModel(
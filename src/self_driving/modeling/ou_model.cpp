@@ -0,0 +1,291 @@
+#include "self_driving/modeling/ou_model.h"
+
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include "loggers/selfdriving_logger.h"
+#include "self_driving/modeling/operating_unit_util.h"
+
+namespace noisepage::selfdriving {
+
+namespace {
+
+/** Version of the format that export_model_map() writes. */
+constexpr uint32_t EXPORT_VERSION = 1;
+
+/** _TRANSFORM_EPSILON of data_transforming_util.py. */
+constexpr double TRANSFORM_EPSILON = 1;
+
+/** Below roughly this cardinality the memory of an operating unit is constant (data_transforming_util.py). */
+constexpr double MEMORY_CARDINALITY_OFFSET = 250;
+
+void CheckSize(const size_t size, const size_t expected, const char *what) {
+  if (size != expected) throw std::invalid_argument(what);
+}
+
+}  // namespace
+
+OUModel::OUModel(const nlohmann::json &exported)
+    : num_features_(exported.at("num_features").get<uint32_t>()),
+      num_labels_(exported.at("num_labels").get<uint32_t>()),
+      log_transform_(exported.at("log_transform").get<bool>()),
+      log_epsilon_(exported.at("log_epsilon").get<double>()),
+      x_mean_(exported.at("x_mean").get<std::vector<double>>()),
+      x_scale_(exported.at("x_scale").get<std::vector<double>>()),
+      y_mean_(exported.at("y_mean").get<std::vector<double>>()),
+      y_scale_(exported.at("y_scale").get<std::vector<double>>()),
+      x_transform_(ParseTransform(exported.at("x_transform").get<std::string>())),
+      y_transform_(ParseTransform(exported.at("y_transform").get<std::string>())),
+      num_rows_index_(exported.at("num_rows_index").get<uint32_t>()),
+      cardinality_index_(exported.at("cardinality_index").get<uint32_t>()),
+      memory_label_index_(exported.at("memory_label_index").get<uint32_t>()) {
+  if (num_features_ == 0 || num_labels_ == 0) throw std::invalid_argument("empty model");
+  // The model is normalized either both ways or not at all
+  CheckSize(x_scale_.size(), x_mean_.size(), "x_scale");
+  CheckSize(y_scale_.size(), y_mean_.size(), "y_scale");
+  if (!x_mean_.empty()) CheckSize(x_mean_.size(), num_features_, "x_mean");
+  if (!y_mean_.empty()) CheckSize(y_mean_.size(), num_labels_, "y_mean");
+  if (num_rows_index_ >= num_features_ || cardinality_index_ >= num_features_ || memory_label_index_ >= num_labels_) {
+    throw std::invalid_argument("transform index");
+  }
+
+  const auto &regressor = exported.at("regressor");
+  const auto kind = regressor.at("kind").get<std::string>();
+  if (kind == "linear") {
+    coef_ = regressor.at("coef").get<std::vector<std::vector<double>>>();
+    intercept_ = regressor.at("intercept").get<std::vector<double>>();
+    CheckSize(coef_.size(), num_labels_, "coef");
+    CheckSize(intercept_.size(), num_labels_, "intercept");
+    for (const auto &coef : coef_) CheckSize(coef.size(), num_features_, "coef");
+  } else if (kind == "trees") {
+    LoadTrees(regressor);
+  } else {
+    throw std::invalid_argument("regressor kind");
+  }
+}
+
+OUModel::Transform OUModel::ParseTransform(const std::string &name) {
+  if (name == "none") return Transform::NONE;
+  if (name == "num_rows_linear") return Transform::NUM_ROWS_LINEAR;
+  if (name == "num_rows_memory_cardinality_linear") return Transform::NUM_ROWS_MEMORY_CARDINALITY_LINEAR;
+  if (name == "num_rows_log_cardinality_linear") return Transform::NUM_ROWS_LOG_CARDINALITY_LINEAR;
+  if (name == "num_rows_linear_log") return Transform::NUM_ROWS_LINEAR_LOG;
+  if (name == "num_rows_log") return Transform::NUM_ROWS_LOG;
+  if (name == "cardinality_linear") return Transform::CARDINALITY_LINEAR;
+  if (name == "num_rows_cardinality_linear") return Transform::NUM_ROWS_CARDINALITY_LINEAR;
+  throw std::invalid_argument("transform " + name);
+}
+
+void OUModel::LoadTrees(const nlohmann::json &regressor) {
+  float_features_ = regressor.at("float_features").get<bool>();
+  base_ = regressor.at("base").get<std::vector<double>>();
+  tree_scale_ = regressor.at("scale").get<double>();
+  CheckSize(base_.size(), num_labels_, "base");
+
+  for (const auto &exported : regressor.at("trees")) {
+    const auto feature = exported.at("feature").get<std::vector<int64_t>>();
+    const auto threshold = exported.at("threshold").get<std::vector<double>>();
+    const auto left = exported.at("left").get<std::vector<int64_t>>();
+    const auto value = exported.at("value").get<std::vector<double>>();
+
+    Tree tree;
+    tree.root_ = static_cast<uint32_t>(feature_.size());
+    tree.labels_ = exported.at("labels").get<std::vector<uint32_t>>();
+    tree.values_offset_ = static_cast<uint32_t>(values_.size());
+    const size_t num_nodes = feature.size();
+    if (num_nodes == 0 || tree.labels_.empty()) throw std::invalid_argument("empty tree");
+    CheckSize(threshold.size(), num_nodes, "threshold");
+    CheckSize(left.size(), num_nodes, "left");
+    CheckSize(value.size(), num_nodes * tree.labels_.size(), "value");
+    for (const auto label : tree.labels_) {
+      if (label >= num_labels_) throw std::invalid_argument("label");
+    }
+
+    // Children always come after their parent, so the depth of every node is known once its children's are
+    std::vector<uint32_t> depth(num_nodes, 0);
+    for (size_t i = num_nodes; i-- > 0;) {
+      if (left[i] < 0) continue;
+      if (left[i] <= static_cast<int64_t>(i) || left[i] + 1 >= static_cast<int64_t>(num_nodes)) {
+        throw std::invalid_argument("child");
+      }
+      if (feature[i] < 0 || feature[i] >= num_features_) throw std::invalid_argument("feature");
+      depth[i] = 1 + std::max(depth[left[i]], depth[left[i] + 1]);
+    }
+    tree.depth_ = depth[0];
+
+    for (size_t i = 0; i < num_nodes; i++) {
+      const auto node = static_cast<uint32_t>(tree.root_ + i);
+      const bool leaf = left[i] < 0;
+      // A leaf steps to itself, since nothing is greater than infinity
+      feature_.push_back(leaf ? 0 : static_cast<uint32_t>(feature[i]));
+      threshold_.push_back(leaf ? std::numeric_limits<double>::infinity() : threshold[i]);
+      left_.push_back(leaf ? node : static_cast<uint32_t>(tree.root_ + left[i]));
+    }
+    values_.insert(values_.end(), value.begin(), value.end());
+    trees_.emplace_back(std::move(tree));
+  }
+}
+
+std::vector<std::vector<double>> OUModel::Predict(const std::vector<std::vector<double>> &features) const {
+  std::vector<std::vector<double>> labels(features.size());
+  std::vector<double> x(BATCH_SIZE * num_features_);
+  std::vector<double> y(BATCH_SIZE * num_labels_);
+  for (size_t start = 0; start < features.size(); start += BATCH_SIZE) {
+    const auto num_rows = static_cast<uint32_t>(std::min<size_t>(BATCH_SIZE, features.size() - start));
+    for (uint32_t row = 0; row < num_rows; row++) {
+      TransformFeatures(features[start + row], &x[row * num_features_]);
+    }
+    Regress(x.data(), num_rows, y.data());
+    for (uint32_t row = 0; row < num_rows; row++) {
+      TransformLabels(features[start + row], &y[row * num_labels_], &labels[start + row]);
+    }
+  }
+  return labels;
+}
+
+void OUModel::TransformFeatures(const std::vector<double> &features, double *const x) const {
+  NOISEPAGE_ASSERT(features.size() == num_features_, "Wrong number of features for the model.");
+  std::copy(features.begin(), features.end(), x);
+  if (x_transform_ == Transform::NUM_ROWS_CARDINALITY_LINEAR) {
+    x[cardinality_index_] /= features[num_rows_index_] + TRANSFORM_EPSILON;
+  }
+  for (uint32_t i = 0; i < num_features_; i++) {
+    if (log_transform_) x[i] = std::log(x[i] + log_epsilon_);
+    if (!x_mean_.empty()) x[i] = (x[i] - x_mean_[i]) / x_scale_[i];
+    // scikit-learn trees compare the features as floats, and the thresholds lie halfway between floats
+    if (float_features_) x[i] = static_cast<float>(x[i]);
+  }
+}
+
+void OUModel::Regress(const double *const x, const uint32_t num_rows, double *const y) const {
+  if (trees_.empty()) {
+    for (uint32_t row = 0; row < num_rows; row++) {
+      const double *const row_x = &x[row * num_features_];
+      for (uint32_t label = 0; label < num_labels_; label++) {
+        double sum = intercept_[label];
+        for (uint32_t i = 0; i < num_features_; i++) sum += coef_[label][i] * row_x[i];
+        y[row * num_labels_ + label] = sum;
+      }
+    }
+    return;
+  }
+
+  std::fill(y, y + num_rows * num_labels_, 0.0);
+  std::array<uint32_t, BATCH_SIZE> nodes;
+  for (const auto &tree : trees_) {
+    nodes.fill(tree.root_);
+    for (uint32_t level = 0; level < tree.depth_; level++) {
+      for (uint32_t row = 0; row < num_rows; row++) {
+        const uint32_t node = nodes[row];
+        nodes[row] = left_[node] + static_cast<uint32_t>(x[row * num_features_ + feature_[node]] > threshold_[node]);
+      }
+    }
+    const auto num_tree_labels = static_cast<uint32_t>(tree.labels_.size());
+    for (uint32_t row = 0; row < num_rows; row++) {
+      const double *const values = &values_[tree.values_offset_ + (nodes[row] - tree.root_) * num_tree_labels];
+      for (uint32_t i = 0; i < num_tree_labels; i++) y[row * num_labels_ + tree.labels_[i]] += values[i];
+    }
+  }
+  for (uint32_t row = 0; row < num_rows; row++) {
+    for (uint32_t label = 0; label < num_labels_; label++) {
+      y[row * num_labels_ + label] = base_[label] + tree_scale_ * y[row * num_labels_ + label];
+    }
+  }
+}
+
+void OUModel::TransformLabels(const std::vector<double> &features, const double *const y,
+                              std::vector<double> *const labels) const {
+  labels->assign(y, y + num_labels_);
+  for (uint32_t label = 0; label < num_labels_; label++) {
+    double &value = (*labels)[label];
+    if (!y_mean_.empty()) value = value * y_scale_[label] + y_mean_[label];
+    if (log_transform_) value = std::max(std::exp(value) - log_epsilon_, 0.0);
+  }
+
+  const double num_rows = features[num_rows_index_];
+  const double cardinality = features[cardinality_index_];
+  double factor = 1;
+  switch (y_transform_) {
+    case Transform::NUM_ROWS_LINEAR:
+      factor = num_rows;
+      break;
+    case Transform::NUM_ROWS_MEMORY_CARDINALITY_LINEAR:
+      factor = num_rows + TRANSFORM_EPSILON;
+      (*labels)[memory_label_index_] *= (cardinality + MEMORY_CARDINALITY_OFFSET) / factor;
+      break;
+    case Transform::NUM_ROWS_LOG_CARDINALITY_LINEAR:
+      factor = (std::log2(num_rows) + TRANSFORM_EPSILON) * cardinality;
+      break;
+    case Transform::NUM_ROWS_LINEAR_LOG:
+      factor = num_rows * std::log2(num_rows) + TRANSFORM_EPSILON;
+      break;
+    case Transform::NUM_ROWS_LOG:
+      factor = std::log2(num_rows) + TRANSFORM_EPSILON;
+      break;
+    case Transform::CARDINALITY_LINEAR:
+      factor = cardinality + TRANSFORM_EPSILON;
+      break;
+    default:
+      break;
+  }
+  for (auto &value : *labels) value *= factor;
+}
+
+std::string OUModelMap::ExportPath(const std::string &model_save_path) {
+  return std::filesystem::path(model_save_path).replace_extension(".json").string();
+}
+
+std::unique_ptr<OUModelMap> OUModelMap::Load(const std::string &path) {
+  std::ifstream file(path);
+  if (!file.is_open()) return nullptr;
+  try {
+    const auto exported = nlohmann::json::parse(file);
+    if (exported.at("version").get<uint32_t>() != EXPORT_VERSION) {
+      SELFDRIVING_LOG_WARN("Exported operating unit models at {} have an unknown version", path);
+      return nullptr;
+    }
+    auto model_map = std::make_unique<OUModelMap>();
+    for (const auto &[name, model] : exported.at("models").items()) {
+      model_map->models_.emplace(name, std::make_unique<OUModel>(model));
+    }
+    return model_map;
+  } catch (nlohmann::json::exception &e) {
+    SELFDRIVING_LOG_WARN("Malformed exported operating unit models at {}: {}", path, e.what());
+  } catch (std::invalid_argument &e) {
+    SELFDRIVING_LOG_WARN("Malformed exported operating unit models at {}: {}", path, e.what());
+  }
+  return nullptr;
+}
+
+const OUModel *OUModelMap::GetModel(const ExecutionOperatingUnitType type) const {
+  const auto it = models_.find(OperatingUnitUtil::ExecutionOperatingUnitTypeToString(type));
+  return it == models_.end() ? nullptr : it->second.get();
+}
+
+std::shared_ptr<const OUModelMap> OUModelMapLoader::Get(const std::string &model_save_path) {
+  const auto path = OUModelMap::ExportPath(model_save_path);
+  struct stat file_stat {};
+  std::lock_guard<std::mutex> guard(latch_);
+  if (stat(path.c_str(), &file_stat) != 0) {
+    path_.clear();
+    models_ = nullptr;
+    return nullptr;
+  }
+  // The model server replaces the export as a whole, so a new modification time means new models
+  if (path != path_ || file_stat.st_mtim.tv_sec != modified_.tv_sec || file_stat.st_mtim.tv_nsec != modified_.tv_nsec) {
+    path_ = path;
+    modified_ = file_stat.st_mtim;
+    models_ = OUModelMap::Load(path);
+  }
+  return models_;
+}
+
+}  // namespace noisepage::selfdriving
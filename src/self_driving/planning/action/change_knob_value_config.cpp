@@ -9,8 +9,17 @@ std::map<settings::Param, std::vector<std::pair<bool, bool>>> ChangeKnobValueCon
 
 std::map<settings::Param, std::vector<std::pair<int32_t, int32_t>>> ChangeKnobValueConfig::int_change_value_map = {
     {settings::Param::wal_serialization_interval, {{10, -10}, {100, -100}}},
+    {settings::Param::gc_interval, {{100, -100}, {1000, -1000}}},
+    {settings::Param::num_parallel_execution_threads, {{1, -1}, {4, -4}}},
 };
 
-std::map<settings::Param, std::vector<std::pair<int64_t, int64_t>>> ChangeKnobValueConfig::int64_change_value_map = {};
+// The memory budgets are 0 for no limit, so the first increment sets a limit and its reverse lifts it again
+std::map<settings::Param, std::vector<std::pair<int64_t, int64_t>>> ChangeKnobValueConfig::int64_change_value_map = {
+    {settings::Param::wal_num_buffers, {{10, -10}, {100, -100}}},
+    {settings::Param::query_memory_budget, {{int64_t{1} << 28, -(int64_t{1} << 28)}}},
+    {settings::Param::aggregation_memory_budget, {{int64_t{1} << 26, -(int64_t{1} << 26)}}},
+    {settings::Param::join_memory_budget, {{int64_t{1} << 26, -(int64_t{1} << 26)}}},
+    {settings::Param::sort_memory_budget, {{int64_t{1} << 26, -(int64_t{1} << 26)}}},
+};
 
 }  // namespace noisepage::selfdriving::pilot
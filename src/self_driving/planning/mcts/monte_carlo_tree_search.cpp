@@ -31,10 +31,14 @@ MonteCarloTreeSearch::MonteCarloTreeSearch(common::ManagedPointer<Pilot> pilot,
     SELFDRIVING_LOG_INFO("Generated action: ID {} Command {}", it.first, it.second->GetSQLCommand());
   }
 
+  // the time to build an index adds to the cost of the segment that creates it
+  PilotUtil::EstimateCreateIndexActions(pilot, txn, action_map_);
+
   pilot->txn_manager_->Abort(txn);
 
   // create root_
   auto later_cost = PilotUtil::ComputeCost(pilot, forecast, 0, end_segment_index);
+  segment_cost_ = later_cost / (end_segment_index + 1);
   // root correspond to no action applied to any segment
   root_ = std::make_unique<TreeNode>(nullptr, static_cast<action_id_t>(NULL_ACTION), 0, later_cost);
 }
@@ -123,7 +123,8 @@ void TreeNode::ChildrenRollout(common::ManagedPointer<Pilot> pilot,
     PilotUtil::ApplyAction(pilot, action_map.at(action_id)->GetSQLCommand(),
                            action_map.at(action_id)->GetDatabaseOid());
 
-    double child_segment_cost = PilotUtil::ComputeCost(pilot, forecast, start_segment_index, start_segment_index);
+    double child_segment_cost = PilotUtil::ComputeCost(pilot, forecast, start_segment_index, start_segment_index) +
+                                static_cast<double>(action_map.at(action_id)->GetEstimatedMetrics().elapsed_us_);
     double later_segments_cost = 0;
     if (start_segment_index != end_segment_index)
       later_segments_cost = PilotUtil::ComputeCost(pilot, forecast, start_segment_index + 1, end_segment_index);
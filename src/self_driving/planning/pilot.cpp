@@ -1,6 +1,9 @@
 #include "self_driving/planning/pilot.h"
 
+#include <algorithm>
 #include <memory>
+#include <optional>
+#include <thread>  // NOLINT
 #include <utility>
 
 #include "common/action_context.h"
@@ -48,7 +51,17 @@ void Pilot::PerformForecasterTrain() {
 }
 
 void Pilot::PerformPlanning() {
-  forecast_ = std::make_unique<WorkloadForecast>(workload_forecast_interval_);
+  // Plan for the most recent segments of the workload, counting in the queries traced since the last round
+  if (forecast_ == nullptr) {
+    forecast_ = std::make_unique<WorkloadForecast>(workload_forecast_interval_, action_planning_horizon_);
+  } else {
+    forecast_->Update();
+  }
+  if (forecast_->GetNumberOfSegments() == 0) return;
+
+  uint64_t num_cached_predictions = 0;
+  for (const auto &ou_predictions : ou_prediction_cache_) num_cached_predictions += ou_predictions.second.size();
+  if (num_cached_predictions > MAX_CACHED_OU_PREDICTIONS) ou_prediction_cache_.clear();
 
   metrics_thread_->PauseMetrics();
   std::vector<std::pair<const std::string, catalog::db_oid_t>> best_action_seq;
@@ -68,8 +81,20 @@ void Pilot::ActionSearch(std::vector<std::pair<const std::string, catalog::db_oi
                                      best_action_seq->at(i).first,
                                      static_cast<uint32_t>(best_action_seq->at(i).second)));
   }
-  PilotUtil::ApplyAction(common::ManagedPointer(this), best_action_seq->begin()->first,
-                         best_action_seq->begin()->second);
+  if (best_action_seq->empty()) return;
+
+  // Indexes are built online and throttled, leaving the CPU time that the forecasted workload needs to it
+  std::optional<double> index_build_cpu_share;
+  const auto &sql_command = best_action_seq->begin()->first;
+  if (sql_command.rfind("create index", 0) == 0) {
+    const double max_share = settings_manager_->GetInt(settings::Param::pilot_index_build_cpu_share) / 100.0;
+    const double load = mcst.GetSegmentCost() / static_cast<double>(workload_forecast_interval_ *
+                                                                     std::max(std::thread::hardware_concurrency(), 1U));
+    const double min_share = std::min(MIN_INDEX_BUILD_CPU_SHARE, max_share);
+    index_build_cpu_share = std::clamp(max_share * (1 - load), min_share, max_share);
+  }
+  PilotUtil::ApplyAction(common::ManagedPointer(this), sql_command, best_action_seq->begin()->second,
+                         index_build_cpu_share);
 }
 
 void Pilot::ExecuteForecast(std::map<std::pair<execution::query_id_t, execution::pipeline_id_t>,
@@ -107,7 +132,7 @@ void Pilot::ExecuteForecast(std::map<std::pair<execution::query_id_t, execution:
                                                           end_segment_index, &pipeline_qids);
   // Then we perform inference through model server to get ou prediction results for all pipelines
   PilotUtil::InferenceWithFeatures(model_save_path_, model_server_manager_, pipeline_qids, pipeline_data,
-                                   pipeline_to_prediction);
+                                   common::ManagedPointer(&ou_prediction_cache_), pipeline_to_prediction);
 
   // restore the old parameters
   action_context = std::make_unique<common::ActionContext>(common::action_id_t(4));
@@ -1,6 +1,11 @@
 #include "self_driving/planning/pilot_util.h"
 
+#include <algorithm>
+#include <set>
+#include <thread>
+
 #include "binder/bind_node_visitor.h"
+#include "catalog/catalog_accessor.h"
 #include "common/error/error_code.h"
 #include "common/error/exception.h"
 #include "common/managed_pointer.h"
@@ -16,22 +21,29 @@
 #include "metrics/metrics_util.h"
 #include "network/postgres/statement.h"
 #include "optimizer/cost_model/trivial_cost_model.h"
+#include "optimizer/statistics/stats_storage.h"
 #include "parser/expression/constant_value_expression.h"
 #include "parser/postgresparser.h"
 #include "parser/variable_set_statement.h"
 #include "planner/plannodes/abstract_plan_node.h"
+#include "planner/plannodes/create_index_plan_node.h"
 #include "self_driving/forecasting/workload_forecast.h"
 #include "self_driving/model_server/model_server_manager.h"
 #include "self_driving/modeling/operating_unit.h"
+#include "self_driving/modeling/operating_unit_recorder.h"
+#include "self_driving/modeling/operating_unit_util.h"
+#include "self_driving/planning/action/create_index_action.h"
 #include "self_driving/planning/pilot.h"
 #include "settings/settings_manager.h"
+#include "storage/index/index.h"
+#include "storage/index/online_index_builder.h"
 #include "traffic_cop/traffic_cop_util.h"
 #include "transaction/transaction_manager.h"
 
 namespace noisepage::selfdriving {
 
 void PilotUtil::ApplyAction(common::ManagedPointer<Pilot> pilot, const std::string &sql_query,
-                            catalog::db_oid_t db_oid) {
+                            catalog::db_oid_t db_oid, std::optional<double> index_build_cpu_share) {
   auto txn_manager = pilot->txn_manager_;
   auto catalog = pilot->catalog_;
 
@@ -75,9 +87,15 @@ void PilotUtil::ApplyAction(common::ManagedPointer<Pilot> pilot, const std::stri
         // TODO(lin): We actually don't need to populate the index tuples after creating the index placeholder for the
         //  "what-if" API. But since we need to execute the query to get the features, we need to compile and execute
         //  the query for now.
-        execution::sql::DDLExecutors::CreateIndexExecutor(common::ManagedPointer<planner::AbstractPlanNode>(out_plan)
-                                                              .CastManagedPointerTo<planner::CreateIndexPlanNode>(),
+        const auto create_index = common::ManagedPointer<planner::AbstractPlanNode>(out_plan)
+                                      .CastManagedPointerTo<planner::CreateIndexPlanNode>();
+        execution::sql::DDLExecutors::CreateIndexExecutor(create_index,
                                                           common::ManagedPointer<catalog::CatalogAccessor>(accessor));
+        if (index_build_cpu_share.has_value() &&
+            CreateIndexOnline(pilot, txn, common::ManagedPointer<catalog::CatalogAccessor>(accessor), create_index,
+                              db_oid, *index_build_cpu_share)) {
+          return;
+        }
       }
 
       auto exec_query = execution::compiler::CompilationContext::Compile(*out_plan, exec_settings, accessor.get(),
@@ -94,6 +112,116 @@ void PilotUtil::ApplyAction(common::ManagedPointer<Pilot> pilot, const std::stri
   }
 }
 
+bool PilotUtil::CreateIndexOnline(common::ManagedPointer<Pilot> pilot, transaction::TransactionContext *txn,
+                                  common::ManagedPointer<catalog::CatalogAccessor> accessor,
+                                  common::ManagedPointer<planner::CreateIndexPlanNode> plan, catalog::db_oid_t db_oid,
+                                  double cpu_share) {
+  const auto index_oid = accessor->GetIndexOid(plan->GetIndexName());
+  const auto &schema = accessor->GetIndexSchema(index_oid);
+  if (schema.Predicate() != nullptr || schema.GetIndexedColOids().size() != schema.GetColumns().size()) return false;
+  for (const auto &column : schema.GetColumns()) {
+    if (column.StoredExpression()->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) return false;
+  }
+
+  // Writers that begin once the index is published maintain it, while the optimizer leaves it alone until it is built
+  const auto index = accessor->GetIndex(index_oid);
+  const auto table = accessor->GetTable(plan->GetTableOid());
+  const bool UNUSED_ATTRIBUTE marked = accessor->SetIndexValid(index_oid, false);
+  NOISEPAGE_ASSERT(marked, "The txn that created the index already holds the DDL lock.");
+  pilot->txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  const auto num_threads =
+      static_cast<uint32_t>(pilot->settings_manager_->GetInt(settings::Param::pilot_index_build_threads));
+  SELFDRIVING_LOG_INFO("Building index {} online with {} threads at {:.0f}% of their time", plan->GetIndexName(),
+                       num_threads, cpu_share * 100);
+  storage::index::OnlineIndexBuilder builder(pilot->txn_manager_->GetTimestampManager(), pilot->txn_manager_, table,
+                                             index, schema);
+  if (!builder.Build(num_threads, cpu_share)) {
+    SELFDRIVING_LOG_WARN("Building index {} online failed, dropping it", plan->GetIndexName());
+    ApplyAction(pilot, "drop index " + plan->GetIndexName() + ";", db_oid);
+    return true;
+  }
+
+  // Marking the index valid is a DDL change, which has to be retried while another one is in progress
+  while (true) {
+    auto *const valid_txn = pilot->txn_manager_->BeginTransaction();
+    const auto valid_accessor = pilot->catalog_->GetAccessor(common::ManagedPointer(valid_txn), db_oid, DISABLED);
+    if (valid_accessor->SetIndexValid(index_oid, true)) {
+      pilot->txn_manager_->Commit(valid_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+      break;
+    }
+    pilot->txn_manager_->Abort(valid_txn);
+    std::this_thread::yield();
+  }
+  return true;
+}
+
+void PilotUtil::EstimateCreateIndexActions(
+    common::ManagedPointer<Pilot> pilot, transaction::TransactionContext *txn,
+    const std::map<pilot::action_id_t, std::unique_ptr<pilot::AbstractAction>> &action_map) {
+  const auto num_threads =
+      static_cast<double>(pilot->settings_manager_->GetInt(settings::Param::pilot_index_build_threads));
+  auto &cached_predictions = pilot->ou_prediction_cache_[ExecutionOperatingUnitType::CREATE_INDEX];
+  std::vector<std::pair<pilot::AbstractAction *, std::vector<double>>> action_features;
+  std::set<std::vector<double>> uncached_features;
+  for (const auto &[action_id, action] : action_map) {
+    if (action->GetActionFamily() != pilot::ActionType::CREATE_INDEX) continue;
+    const auto *create_index = static_cast<const pilot::CreateIndexAction *>(action.get());
+    auto accessor = pilot->catalog_->GetAccessor(common::ManagedPointer(txn), action->GetDatabaseOid(), DISABLED);
+    const auto table_oid = accessor->GetTableOid(create_index->GetTableName());
+    if (table_oid == catalog::INVALID_TABLE_OID) continue;
+
+    // The key of the index, like the OperatingUnitRecorder measures it for CREATE INDEX
+    const auto &schema = accessor->GetSchema(table_oid);
+    size_t key_size = 0;
+    size_t num_keys = 0;
+    for (const auto &column : create_index->GetColumns()) {
+      const auto type = schema.GetColumn(column.GetColumnName()).Type();
+      OperatingUnitRecorder::AdjustKeyWithType(type, &key_size, &num_keys);
+      if (type == type::TypeId::VARCHAR) key_size += 8;
+    }
+    const auto num_rows = static_cast<double>(
+        pilot->stats_storage_->GetTableStats(action->GetDatabaseOid(), table_oid, accessor.get())
+            .table_stats_.GetNumRows());
+
+    // In the order of the features of an operating unit, with every tuple going into the index
+    std::vector<double> features{metrics::MetricsUtil::GetHardwareContext().cpu_mhz_,
+                                 static_cast<double>(execution::vm::ExecutionMode::Interpret),
+                                 num_rows,
+                                 static_cast<double>(key_size),
+                                 static_cast<double>(num_keys),
+                                 num_rows,
+                                 1.0,
+                                 0.0,
+                                 num_threads};
+    if (cached_predictions.find(features) == cached_predictions.end()) uncached_features.insert(features);
+    action_features.emplace_back(action.get(), std::move(features));
+  }
+
+  if (!uncached_features.empty()) {
+    std::vector<std::vector<double>> features(uncached_features.begin(), uncached_features.end());
+    auto res = pilot->model_server_manager_->InferOUModel(
+        OperatingUnitUtil::ExecutionOperatingUnitTypeToString(ExecutionOperatingUnitType::CREATE_INDEX),
+        pilot->model_save_path_, features);
+    if (!res.second || res.first.size() != features.size()) {
+      SELFDRIVING_LOG_WARN("Could not predict the time to build the indexes of the create index actions");
+      return;
+    }
+    for (uint64_t i = 0; i < features.size(); i++) {
+      cached_predictions.emplace(std::move(features[i]), std::move(res.first[i]));
+    }
+  }
+
+  for (const auto &[action, features] : action_features) {
+    const auto &prediction = cached_predictions.at(features);
+    if (prediction.empty()) continue;
+    // The elapsed time is the last label that the models predict
+    auto metrics = action->GetEstimatedMetrics();
+    metrics.elapsed_us_ = static_cast<uint64_t>(std::max(prediction.back(), 0.0));
+    action->SetEstimatedMetrics(metrics);
+  }
+}
+
 std::unique_ptr<planner::AbstractPlanNode> PilotUtil::GenerateQueryPlan(
     transaction::TransactionContext *txn, common::ManagedPointer<catalog::CatalogAccessor> accessor,
     common::ManagedPointer<std::vector<parser::ConstantValueExpression>> params,
@@ -178,7 +306,7 @@ double PilotUtil::ComputeCost(common::ManagedPointer<Pilot> pilot, common::Manag
   return total_cost;
 }
 
-const std::list<metrics::PipelineMetricRawData::PipelineData> &PilotUtil::CollectPipelineFeatures(
+const common::ChunkedList<metrics::PipelineMetricRawData::PipelineData> &PilotUtil::CollectPipelineFeatures(
     common::ManagedPointer<selfdriving::Pilot> pilot, common::ManagedPointer<selfdriving::WorkloadForecast> forecast,
     uint64_t start_segment_index, uint64_t end_segment_index, std::vector<execution::query_id_t> *pipeline_qids) {
   auto txn_manager = pilot->txn_manager_;
@@ -249,12 +377,15 @@ const std::list<metrics::PipelineMetricRawData::PipelineData> &PilotUtil::Collec
   return aggregated_data->pipeline_data_;
 }
 
-void PilotUtil::InferenceWithFeatures(const std::string &model_save_path,
-                                      common::ManagedPointer<modelserver::ModelServerManager> model_server_manager,
-                                      const std::vector<execution::query_id_t> &pipeline_qids,
-                                      const std::list<metrics::PipelineMetricRawData::PipelineData> &pipeline_data,
-                                      std::map<std::pair<execution::query_id_t, execution::pipeline_id_t>,
-                                               std::vector<std::vector<std::vector<double>>>> *pipeline_to_prediction) {
+void PilotUtil::InferenceWithFeatures(
+    const std::string &model_save_path, common::ManagedPointer<modelserver::ModelServerManager> model_server_manager,
+    const std::vector<execution::query_id_t> &pipeline_qids,
+    const common::ChunkedList<metrics::PipelineMetricRawData::PipelineData> &pipeline_data,
+    common::ManagedPointer<
+        std::unordered_map<ExecutionOperatingUnitType, std::map<std::vector<double>, std::vector<double>>>>
+        ou_prediction_cache,
+    std::map<std::pair<execution::query_id_t, execution::pipeline_id_t>, std::vector<std::vector<std::vector<double>>>>
+        *pipeline_to_prediction) {
   std::unordered_map<ExecutionOperatingUnitType, std::vector<std::vector<double>>> ou_to_features;
   std::list<std::tuple<execution::query_id_t, execution::pipeline_id_t,
                        std::vector<std::pair<ExecutionOperatingUnitType, uint64_t>>>>
@@ -263,14 +394,46 @@ void PilotUtil::InferenceWithFeatures(const std::string &model_save_path,
   PilotUtil::GroupFeaturesByOU(&pipeline_to_ou_position, pipeline_qids, pipeline_data, &ou_to_features);
   NOISEPAGE_ASSERT(model_server_manager->ModelServerStarted(), "Model Server should have been started");
   std::unordered_map<ExecutionOperatingUnitType, std::vector<std::vector<double>>> inference_result;
+  // Only infer the features that were not inferred before, once each, with the models of all ous in one request
+  modelserver::OUMatrices features_to_infer;
+  std::unordered_map<std::string, ExecutionOperatingUnitType> opunit_types;
   for (auto &ou_map_it : ou_to_features) {
-    auto res = model_server_manager->InferOUModel(
-        selfdriving::OperatingUnitUtil::ExecutionOperatingUnitTypeToString(ou_map_it.first), model_save_path,
-        ou_map_it.second);
+    auto &cached_predictions = (*ou_prediction_cache)[ou_map_it.first];
+    std::set<std::vector<double>> uncached_features;
+    for (const auto &features : ou_map_it.second) {
+      if (cached_predictions.find(features) == cached_predictions.end()) uncached_features.insert(features);
+    }
+    if (!uncached_features.empty()) {
+      auto opunit = selfdriving::OperatingUnitUtil::ExecutionOperatingUnitTypeToString(ou_map_it.first);
+      opunit_types.emplace(opunit, ou_map_it.first);
+      features_to_infer.emplace(std::move(opunit),
+                                std::vector<std::vector<double>>(uncached_features.begin(), uncached_features.end()));
+    }
+  }
+
+  if (!features_to_infer.empty()) {
+    auto res = model_server_manager->InferOUModels(model_save_path, features_to_infer);
     if (!res.second) {
       throw PILOT_EXCEPTION("Inference through model server manager has error", common::ErrorCode::ERRCODE_WARNING);
     }
-    inference_result.emplace(ou_map_it.first, res.first);
+    for (auto &[opunit, features] : features_to_infer) {
+      auto &predictions = res.first[opunit];
+      if (predictions.size() != features.size()) {
+        throw PILOT_EXCEPTION("Inference through model server manager has error", common::ErrorCode::ERRCODE_WARNING);
+      }
+      auto &cached_predictions = ou_prediction_cache->at(opunit_types.at(opunit));
+      for (uint64_t i = 0; i < features.size(); i++) {
+        cached_predictions.emplace(std::move(features[i]), std::move(predictions[i]));
+      }
+    }
+  }
+
+  for (auto &ou_map_it : ou_to_features) {
+    const auto &cached_predictions = ou_prediction_cache->at(ou_map_it.first);
+    std::vector<std::vector<double>> predictions;
+    predictions.reserve(ou_map_it.second.size());
+    for (const auto &features : ou_map_it.second) predictions.push_back(cached_predictions.at(features));
+    inference_result.emplace(ou_map_it.first, std::move(predictions));
   }
 
   // populate pipeline_to_prediction using pipeline_to_ou_position and inference_result
@@ -294,10 +457,10 @@ void PilotUtil::GroupFeaturesByOU(
     std::list<std::tuple<execution::query_id_t, execution::pipeline_id_t,
                          std::vector<std::pair<ExecutionOperatingUnitType, uint64_t>>>> *pipeline_to_ou_position,
     const std::vector<execution::query_id_t> &pipeline_qids,
-    const std::list<metrics::PipelineMetricRawData::PipelineData> &pipeline_data,
+    const common::ChunkedList<metrics::PipelineMetricRawData::PipelineData> &pipeline_data,
     std::unordered_map<ExecutionOperatingUnitType, std::vector<std::vector<double>>> *ou_to_features) {
   // if no pipeline data is recorded, there's no work to be done
-  if (pipeline_data.empty()) return;
+  if (pipeline_data.Empty()) return;
 
   // Otherwise, we look over all entries in pipeline_data
   // prev_qid and pipeline_idx is to keep mapping the current qid to the qid at pipeline_idx in pipeline_qids to
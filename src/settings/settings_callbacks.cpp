@@ -52,7 +52,7 @@ void Callbacks::BlockStoreReuseLimit(void *const old_value, void *const new_valu
 void Callbacks::WalNumBuffers(void *const old_value, void *const new_value, DBMain *const db_main,
                               common::ManagedPointer<common::ActionContext> action_context) {
   action_context->SetState(common::ActionState::IN_PROGRESS);
-  int new_size = *static_cast<int *>(new_value);
+  int64_t new_size = *static_cast<int64_t *>(new_value);
   bool success = db_main->GetLogManager()->SetNumBuffers(new_size);
   if (success)
     action_context->SetState(common::ActionState::SUCCESS);
@@ -68,6 +68,17 @@ void Callbacks::WalSerializationInterval(void *const old_value, void *const new_
   action_context->SetState(common::ActionState::SUCCESS);
 }
 
+void Callbacks::GcInterval(void *const old_value, void *const new_value, DBMain *const db_main,
+                           common::ManagedPointer<common::ActionContext> action_context) {
+  action_context->SetState(common::ActionState::IN_PROGRESS);
+  int new_interval = *static_cast<int *>(new_value);
+  // Without a GC thread there is nothing that runs at the interval
+  if (db_main->GetGarbageCollectorThread() != DISABLED) {
+    db_main->GetGarbageCollectorThread()->SetGCPeriod(std::chrono::microseconds{new_interval});
+  }
+  action_context->SetState(common::ActionState::SUCCESS);
+}
+
 void Callbacks::MetricsLogging(void *const old_value, void *const new_value, DBMain *const db_main,
                                common::ManagedPointer<common::ActionContext> action_context) {
   action_context->SetState(common::ActionState::IN_PROGRESS);
@@ -173,6 +184,17 @@ void Callbacks::MetricsQueryTrace(void *const old_value, void *const new_value,
   action_context->SetState(common::ActionState::SUCCESS);
 }
 
+void Callbacks::MetricsReplication(void *const old_value, void *const new_value, DBMain *const db_main,
+                                   common::ManagedPointer<common::ActionContext> action_context) {
+  action_context->SetState(common::ActionState::IN_PROGRESS);
+  bool new_status = *static_cast<bool *>(new_value);
+  if (new_status)
+    db_main->GetMetricsManager()->EnableMetric(metrics::MetricsComponent::REPLICATION);
+  else
+    db_main->GetMetricsManager()->DisableMetric(metrics::MetricsComponent::REPLICATION);
+  action_context->SetState(common::ActionState::SUCCESS);
+}
+
 void Callbacks::PilotEnablePlanning(void *const old_value, void *const new_value, DBMain *const db_main,
                                     common::ManagedPointer<common::ActionContext> action_context) {
   action_context->SetState(common::ActionState::IN_PROGRESS);
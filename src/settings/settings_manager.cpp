@@ -70,10 +70,10 @@ void SettingsManager::ValidateSetting(Param param, const parser::ConstantValueEx
   }
 }
 
-#define DEFINE_SETTINGS_MANAGER_GET(Name, CppType)         \
-  CppType SettingsManager::Get##Name(Param param) {        \
-    common::SharedLatch::ScopedSharedLatch guard(&latch_); \
-    return GetValue(param).Peek<CppType>();                \
+#define DEFINE_SETTINGS_MANAGER_GET(Name, CppType)            \
+  CppType SettingsManager::Get##Name(Param param) {           \
+    common::BigReaderLatch::ScopedSharedLatch guard(&latch_); \
+    return GetValue(param).Peek<CppType>();                   \
   }
 
 DEFINE_SETTINGS_MANAGER_GET(Bool, bool)
@@ -84,7 +84,7 @@ DEFINE_SETTINGS_MANAGER_GET(Double, double)
 #undef DEFINE_SETTINGS_MANAGER_GET
 
 std::string SettingsManager::GetString(Param param) {
-  common::SharedLatch::ScopedSharedLatch guard(&latch_);
+  common::BigReaderLatch::ScopedSharedLatch guard(&latch_);
   const auto &value = GetValue(param);
   return std::string(value.Peek<std::string_view>());
 }
@@ -99,7 +99,7 @@ std::string SettingsManager::GetString(Param param) {
     const auto max_value = static_cast<CppType>(param_info.max_value_);                                             \
                                                                                                                     \
     /* Check new value is within bounds. */                                                                         \
-    common::SharedLatch::ScopedExclusiveLatch guard(&latch_);                                                       \
+    common::BigReaderLatch::ScopedExclusiveLatch guard(&latch_);                                                    \
     if ((ShouldCheckMinMaxBounds) && !(value >= min_value && value <= max_value)) {                                 \
       action_context->SetState(ActionState::FAILURE);                                                               \
       setter_callback(action_context);                                                                              \
@@ -146,7 +146,7 @@ void SettingsManager::SetString(Param param, const std::string_view &value,
 
   const auto &param_info = param_map_.find(param)->second;
 
-  common::SharedLatch::ScopedExclusiveLatch guard(&latch_);
+  common::BigReaderLatch::ScopedExclusiveLatch guard(&latch_);
   auto old_cve = std::unique_ptr<parser::ConstantValueExpression>{
       reinterpret_cast<parser::ConstantValueExpression *>(GetValue(param).Copy().release())};
 
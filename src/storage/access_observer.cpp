@@ -1,12 +1,19 @@
 #include "storage/access_observer.h"
 
+#include <algorithm>
+
 #include "storage/block_compactor.h"
 
 namespace noisepage::storage {
 void AccessObserver::ObserveGCInvocation() {
   gc_epoch_++;
   for (auto it = last_touched_.begin(), end = last_touched_.end(); it != end;) {
-    if (it->second + COLD_DATA_EPOCH_THRESHOLD < gc_epoch_) {
+    const TupleAccessStrategy &accessor = it->first->data_table_->accessor_;
+    // Inserts that refill the free slots of the block hold its busy status, and leave it alone once it is queued. A
+    // block that is being refilled is written to, so it is not cold anyway.
+    if (ShouldFreeze(it->first, &it->second) && accessor.SetBlockBusyStatus(it->first)) {
+      accessor.GetArrowBlockMetadata(it->first).GetAccessStats(accessor.GetBlockLayout()).queued_ = true;
+      accessor.ClearBlockBusyStatus(it->first);
       compactor_->PutInQueue(it->first);
       it = last_touched_.erase(it);
     } else {
@@ -18,8 +25,40 @@ void AccessObserver::ObserveGCInvocation() {
 void AccessObserver::ObserveWrite(RawBlock *block) {
   // The compactor is only concerned with blocks that are already full. We assume that partially empty blocks are
   // always hot.
-  if (block->GetInsertHead() == block->data_table_->accessor_.GetBlockLayout().NumSlots())
-    last_touched_[block] = gc_epoch_;
+  const TupleAccessStrategy &accessor = block->data_table_->accessor_;
+  if (block->GetInsertHead() != accessor.GetBlockLayout().NumSlots()) return;
+
+  // Writes of the compactor itself leave the block cooling, so only user writes find a queued block hot
+  BlockAccessStats &stats = accessor.GetArrowBlockMetadata(block).GetAccessStats(accessor.GetBlockLayout());
+  if (stats.queued_ && block->controller_.GetBlockState()->load() == BlockState::HOT) {
+    stats.queued_ = false;
+    stats.num_preemptions_++;
+    stats.last_preemption_epoch_ = gc_epoch_;
+  }
+
+  auto result = last_touched_.emplace(block, BlockTemperature{gc_epoch_, 0, 0});
+  result.first->second.last_touched_ = gc_epoch_;
+  result.first->second.writes_++;
+}
+
+bool AccessObserver::ShouldFreeze(RawBlock *const block, BlockTemperature *const temperature) const {
+  const TupleAccessStrategy &accessor = block->data_table_->accessor_;
+  const BlockLayout &layout = accessor.GetBlockLayout();
+  BlockAccessStats &stats = accessor.GetArrowBlockMetadata(block).GetAccessStats(layout);
+  temperature->writes_ *= policy_.decay_;
+  temperature->scans_ = temperature->scans_ * policy_.decay_ + stats.num_scans_.exchange(0, std::memory_order_relaxed);
+
+  // Blocks that were preempted lately have to stay cold for longer
+  uint64_t cold_epochs = policy_.cold_epochs_;
+  if (stats.num_preemptions_ > 0 && stats.last_preemption_epoch_ + policy_.preemption_memory_ > gc_epoch_)
+    cold_epochs <<= std::min(stats.num_preemptions_, policy_.max_backoff_);
+  if (temperature->last_touched_ + cold_epochs >= gc_epoch_) return false;
+
+  const double empty_fraction =
+      1.0 - static_cast<double>(accessor.AllocationBitmap(block)->NumSet(layout.NumSlots())) / layout.NumSlots();
+  const double benefit =
+      policy_.freeze_benefit_ + policy_.gap_benefit_ * empty_fraction + policy_.scan_benefit_ * temperature->scans_;
+  return benefit >= policy_.write_cost_ * temperature->writes_;
 }
 
 }  // namespace noisepage::storage
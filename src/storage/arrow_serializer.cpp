@@ -6,16 +6,24 @@
 #include <string>
 #include <vector>
 
+#include "common/posix_io_wrappers.h"
+#include "storage/projected_row.h"
+
 namespace noisepage::storage {
 
 constexpr int32_t FLATBUF_CONTINUZATION = -1;
+constexpr int32_t END_OF_STREAM = 0;
 constexpr uint8_t ARROW_ALIGNMENT = 8;
 constexpr char ALIGNMENT[8] = {0};
 constexpr flatbuf::MetadataVersion METADATA_VERSION = flatbuf::MetadataVersion_V4;
 
-void ArrowSerializer::WriteDataBlock(std::ofstream &outfile, const char *src, size_t len) {
-  len = StorageUtil::PadUpToSize(ARROW_ALIGNMENT, len);
-  outfile.write(src, len);
+void ArrowIpcFdSink::Write(const char *src, size_t len) { PosixIoWrappers::WriteFully(fd_, src, len); }
+
+void ArrowSerializer::WriteDataBlock(ArrowIpcSink *sink, const char *src, size_t len) {
+  // Not every buffer is allocated up to arrow alignment, so the padding is written separately
+  sink->Write(src, len);
+  const size_t padded_len = StorageUtil::PadUpToSize(ARROW_ALIGNMENT, len);
+  if (padded_len != len) sink->Write(ALIGNMENT, padded_len - len);
 }
 
 void ArrowSerializer::AddBufferInfo(size_t *offset, size_t len, std::vector<flatbuf::Buffer> *buffers) {
@@ -24,23 +32,24 @@ void ArrowSerializer::AddBufferInfo(size_t *offset, size_t len, std::vector<flat
   *offset += len;
 }
 
-void ArrowSerializer::AssembleMetadataBuffer(std::ofstream &outfile, flatbuf::MessageHeader header_type,
+void ArrowSerializer::AssembleMetadataBuffer(ArrowIpcSink *sink, flatbuf::MessageHeader header_type,
                                              flatbuffers::Offset<void> header, int64_t body_len,
                                              flatbuffers::FlatBufferBuilder *flatbuf_builder) {
   auto message = flatbuf::CreateMessage(*flatbuf_builder, METADATA_VERSION, header_type, header, body_len);
   flatbuf_builder->Finish(message);
   int32_t flatbuf_size = flatbuf_builder->GetSize();
   auto padded_flatbuf_size = StorageUtil::PadUpToSize(ARROW_ALIGNMENT, flatbuf_size);
-  outfile.write(reinterpret_cast<const char *>(&FLATBUF_CONTINUZATION), sizeof(int32_t));
-  outfile.write(reinterpret_cast<const char *>(&padded_flatbuf_size), sizeof(int32_t));
-  outfile.write(reinterpret_cast<const char *>(flatbuf_builder->GetBufferPointer()), flatbuf_size);
+  sink->Write(reinterpret_cast<const char *>(&FLATBUF_CONTINUZATION), sizeof(int32_t));
+  sink->Write(reinterpret_cast<const char *>(&padded_flatbuf_size), sizeof(int32_t));
+  sink->Write(reinterpret_cast<const char *>(flatbuf_builder->GetBufferPointer()), flatbuf_size);
   if (padded_flatbuf_size != static_cast<uint32_t>(flatbuf_size)) {
-    outfile.write(ALIGNMENT, padded_flatbuf_size - flatbuf_size);
+    sink->Write(ALIGNMENT, padded_flatbuf_size - flatbuf_size);
   }
-  outfile.flush();
+  // Otherwise, every message would carry the flatbuffers of all messages before it
+  flatbuf_builder->Clear();
 }
 
-void ArrowSerializer::WriteSchemaMessage(std::ofstream &outfile, std::unordered_map<col_id_t, int64_t> *dictionary_ids,
+void ArrowSerializer::WriteSchemaMessage(ArrowIpcSink *sink, std::unordered_map<col_id_t, int64_t> *dictionary_ids,
                                          std::vector<type::TypeId> *col_types,
                                          flatbuffers::FlatBufferBuilder *flatbuf_builder) {
   RawBlock *block = *data_table_.GetBlocks().begin();
@@ -119,15 +128,16 @@ void ArrowSerializer::WriteSchemaMessage(std::ofstream &outfile, std::unordered_
 
   auto schema =
       flatbuf::CreateSchema(*flatbuf_builder, flatbuf::Endianness_Little, flatbuf_builder->CreateVector(fields));
-  AssembleMetadataBuffer(outfile, flatbuf::MessageHeader_Schema, schema.Union(), 0, flatbuf_builder);
+  AssembleMetadataBuffer(sink, flatbuf::MessageHeader_Schema, schema.Union(), 0, flatbuf_builder);
+  sink->Flush();
 }
 
-void ArrowSerializer::WriteDictionaryMessage(std::ofstream &outfile, int64_t dictionary_id,
-                                             const ArrowVarlenColumn &varlen_col,
+void ArrowSerializer::WriteDictionaryMessage(ArrowIpcSink *sink, int64_t dictionary_id, const uint64_t *offsets,
+                                             uint32_t offsets_length, const byte *values, uint32_t values_length,
                                              flatbuffers::FlatBufferBuilder *flatbuf_builder) {
   std::vector<flatbuf::FieldNode> field_nodes;
   std::vector<flatbuf::Buffer> buffers;
-  uint32_t num_elements = varlen_col.OffsetsLength() - 1;
+  uint32_t num_elements = offsets_length - 1;
   size_t buffer_offset = 0;
   field_nodes.emplace_back(num_elements, 0);
 
@@ -136,147 +146,238 @@ void ArrowSerializer::WriteDictionaryMessage(std::ofstream &outfile, int64_t dic
   // in one RecordBatch. RecordBatch is something requires a validity buffer
   buffers.emplace_back(buffer_offset, 0);
 
-  AddBufferInfo(&buffer_offset, varlen_col.OffsetsLength() * sizeof(uint64_t), &buffers);
+  AddBufferInfo(&buffer_offset, offsets_length * sizeof(uint64_t), &buffers);
 
-  AddBufferInfo(&buffer_offset, varlen_col.ValuesLength(), &buffers);
+  AddBufferInfo(&buffer_offset, values_length, &buffers);
 
   auto record_batch =
       flatbuf::CreateRecordBatch(*flatbuf_builder, num_elements, flatbuf_builder->CreateVectorOfStructs(field_nodes),
                                  flatbuf_builder->CreateVectorOfStructs(buffers));
   auto dictionary_batch = flatbuf::CreateDictionaryBatch(*flatbuf_builder, dictionary_id, record_batch);
   auto aligned_offset = StorageUtil::PadUpToSize(ARROW_ALIGNMENT, buffer_offset);
-  AssembleMetadataBuffer(outfile, flatbuf::MessageHeader_DictionaryBatch, dictionary_batch.Union(), aligned_offset,
+  AssembleMetadataBuffer(sink, flatbuf::MessageHeader_DictionaryBatch, dictionary_batch.Union(), aligned_offset,
                          flatbuf_builder);
-  WriteDataBlock(outfile, reinterpret_cast<const char *>(varlen_col.Offsets()),
-                 varlen_col.OffsetsLength() * sizeof(uint64_t));
+  WriteDataBlock(sink, reinterpret_cast<const char *>(offsets), offsets_length * sizeof(uint64_t));
 
-  WriteDataBlock(outfile, reinterpret_cast<const char *>(varlen_col.Values()), varlen_col.ValuesLength());
+  WriteDataBlock(sink, reinterpret_cast<const char *>(values), values_length);
 
-  outfile.flush();
+  sink->Flush();
 }
 
-void ArrowSerializer::ExportTable(const std::string &file_name, std::vector<type::TypeId> *col_types) {
-  flatbuffers::FlatBufferBuilder flatbuf_builder;
-  std::ofstream outfile(file_name, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
-  std::unordered_map<col_id_t, int64_t> dictionary_ids;
-  WriteSchemaMessage(outfile, &dictionary_ids, col_types, &flatbuf_builder);
+void ArrowSerializer::WriteRecordBatchMessage(ArrowIpcSink *sink, uint32_t num_rows,
+                                              const std::vector<flatbuf::FieldNode> &field_nodes,
+                                              const std::vector<BodyBuffer> &body,
+                                              flatbuffers::FlatBufferBuilder *flatbuf_builder) {
+  // First pass, write metadata_flatbuffer
+  std::vector<flatbuf::Buffer> buffers;
+  size_t buffer_offset = 0;
+  for (const auto &buffer : body) AddBufferInfo(&buffer_offset, buffer.second, &buffers);
+  auto record_batch =
+      flatbuf::CreateRecordBatch(*flatbuf_builder, num_rows, flatbuf_builder->CreateVectorOfStructs(field_nodes),
+                                 flatbuf_builder->CreateVectorOfStructs(buffers));
+  auto aligned_offset = StorageUtil::PadUpToSize(ARROW_ALIGNMENT, buffer_offset);
+  AssembleMetadataBuffer(sink, flatbuf::MessageHeader_RecordBatch, record_batch.Union(), aligned_offset,
+                         flatbuf_builder);
 
+  // Second pass, write data.
+  for (const auto &buffer : body) WriteDataBlock(sink, buffer.first, buffer.second);
+  sink->Flush();
+}
+
+void ArrowSerializer::WriteFrozenBlock(ArrowIpcSink *sink, RawBlock *block,
+                                       std::unordered_map<col_id_t, int64_t> *dictionary_ids,
+                                       flatbuffers::FlatBufferBuilder *flatbuf_builder) {
   const BlockLayout &layout = data_table_.accessor_.GetBlockLayout();
   auto column_ids = layout.AllColumns();
+  ArrowBlockMetadata &metadata = data_table_.accessor_.GetArrowBlockMetadata(block);
+  uint32_t num_slots = metadata.NumRecords();
+  size_t column_id_size = column_ids.size();
 
-  for (auto it : data_table_.GetBlocks()) {  // NOLINT
-    RawBlock *block = it;
-    std::vector<flatbuf::FieldNode> field_nodes;
-    std::vector<flatbuf::Buffer> buffers;
-
-    // Make sure varlen columns have correct data when reading
-    while (!block->controller_.TryAcquireInPlaceRead()) {
-    }
-    ArrowBlockMetadata &metadata = data_table_.accessor_.GetArrowBlockMetadata(block);
-    uint32_t num_slots = metadata.NumRecords();
-
-    size_t buffer_offset = 0;
-    size_t column_id_size = column_ids.size();
-
-    // First pass, write metadata_flatbuffer
-    for (size_t i = 0; i < column_id_size; ++i) {
-      auto col_id = column_ids[i];
-      common::RawConcurrentBitmap *column_bitmap = data_table_.accessor_.ColumnNullBitmap(block, col_id);
-      std::byte *column_start = data_table_.accessor_.ColumnStart(block, col_id);
+  std::vector<flatbuf::FieldNode> field_nodes;
+  std::vector<BodyBuffer> body;
+  // Values of columns in a column group, copied out so that they are contiguous
+  std::vector<std::vector<byte>> gathered_columns;
+  const uint32_t bitmap_size =
+      StorageUtil::PadUpToSize(sizeof(uint64_t), common::RawBitmap::SizeInBytes(layout.NumSlots()));
+  for (size_t i = 0; i < column_id_size; ++i) {
+    auto col_id = column_ids[i];
+    common::RawConcurrentBitmap *column_bitmap = data_table_.accessor_.ColumnNullBitmap(block, col_id);
+    std::byte *column_start = data_table_.accessor_.ColumnStart(block, col_id);
 
-      ArrowColumnInfo &col_info = metadata.GetColumnInfo(layout, col_id);
-      field_nodes.emplace_back(num_slots, metadata.NullCount(col_id));
+    ArrowColumnInfo &col_info = metadata.GetColumnInfo(layout, col_id);
+    field_nodes.emplace_back(num_slots, metadata.NullCount(col_id));
 
-      AddBufferInfo(&buffer_offset,
-                    reinterpret_cast<uintptr_t>(column_start) - reinterpret_cast<uintptr_t>(column_bitmap), &buffers);
-      if (layout.IsVarlen(col_id) && !(col_info.Type() == ArrowColumnType::FIXED_LENGTH)) {
-        switch (col_info.Type()) {
-          case ArrowColumnType::GATHERED_VARLEN: {
-            ArrowVarlenColumn &varlen_col = col_info.VarlenColumn();
-            AddBufferInfo(&buffer_offset, varlen_col.OffsetsLength() * sizeof(uint64_t), &buffers);
-            AddBufferInfo(&buffer_offset, varlen_col.ValuesLength(), &buffers);
-            break;
-          }
-          case ArrowColumnType::DICTIONARY_COMPRESSED: {
-            ArrowVarlenColumn &varlen_col = col_info.VarlenColumn();
-            WriteDictionaryMessage(outfile, dictionary_ids[col_id], varlen_col, &flatbuf_builder);
-            AddBufferInfo(&buffer_offset, num_slots * sizeof(uint64_t), &buffers);
-            break;
-          }
-          default:
-            throw std::runtime_error("unexpected control flow");
+    body.emplace_back(reinterpret_cast<const char *>(column_bitmap), bitmap_size);
+    if (layout.IsVarlen(col_id) && !(col_info.Type() == ArrowColumnType::FIXED_LENGTH)) {
+      switch (col_info.Type()) {
+        case ArrowColumnType::GATHERED_VARLEN: {
+          ArrowVarlenColumn &varlen_col = col_info.VarlenColumn();
+          body.emplace_back(reinterpret_cast<const char *>(varlen_col.Offsets()),
+                            varlen_col.OffsetsLength() * sizeof(uint64_t));
+          body.emplace_back(reinterpret_cast<const char *>(varlen_col.Values()), varlen_col.ValuesLength());
+          break;
         }
-      } else {
-        int32_t cur_buffer_len;
-        // Calculate the length of the data region of current column. For the columns except the last one, we calculate
-        // their length by using the start of next column's bit map - the start of current column's data. For the
-        // last column, we calculate the length by using the beginning address of the next block - the start of current
-        // column data.
-        if (i == column_id_size - 1) {
-          auto casted_column_start = reinterpret_cast<uintptr_t>(column_start);
-          uintptr_t mask = common::Constants::BLOCK_SIZE - 1;
-          cur_buffer_len = ((casted_column_start + mask) & (~mask)) - casted_column_start;
-        } else {
-          cur_buffer_len =
-              reinterpret_cast<uintptr_t>(data_table_.accessor_.ColumnNullBitmap(block, column_ids[i + 1])) -
-              reinterpret_cast<uintptr_t>(column_start);
+        case ArrowColumnType::DICTIONARY_COMPRESSED: {
+          ArrowVarlenColumn &varlen_col = col_info.VarlenColumn();
+          WriteDictionaryMessage(sink, (*dictionary_ids)[col_id], varlen_col.Offsets(), varlen_col.OffsetsLength(),
+                                 varlen_col.Values(), varlen_col.ValuesLength(), flatbuf_builder);
+          body.emplace_back(reinterpret_cast<const char *>(col_info.Indices()), num_slots * sizeof(uint64_t));
+          break;
         }
-        AddBufferInfo(&buffer_offset, cur_buffer_len, &buffers);
+        default:
+          throw std::runtime_error("unexpected control flow");
+      }
+    } else if (!layout.IsColumnar(col_id)) {
+      const uint16_t size = layout.AttrSize(col_id);
+      const uint16_t stride = layout.AttrStride(col_id);
+      std::vector<byte> &values =
+          gathered_columns.emplace_back(StorageUtil::PadUpToSize(sizeof(uint64_t), num_slots * size));
+      for (uint32_t slot = 0; slot < num_slots; slot++)
+        std::memcpy(values.data() + slot * size, column_start + slot * stride, size);
+      body.emplace_back(reinterpret_cast<const char *>(values.data()), values.size());
+    } else {
+      int32_t cur_buffer_len;
+      // Calculate the length of the data region of current column. For the columns except the last one, it is the
+      // padded size of the values of all slots, which reaches up to the next mini block. For the last column, we
+      // calculate the length by using the beginning address of the next block - the start of current column data.
+      if (i == column_id_size - 1) {
+        auto casted_column_start = reinterpret_cast<uintptr_t>(column_start);
+        uintptr_t mask = common::Constants::BLOCK_SIZE - 1;
+        cur_buffer_len = ((casted_column_start + mask) & (~mask)) - casted_column_start;
+      } else {
+        cur_buffer_len = StorageUtil::PadUpToSize(sizeof(uint64_t), layout.AttrSize(col_id) * layout.NumSlots());
       }
+      body.emplace_back(reinterpret_cast<const char *>(column_start), cur_buffer_len);
     }
-    auto record_batch =
-        flatbuf::CreateRecordBatch(flatbuf_builder, num_slots, flatbuf_builder.CreateVectorOfStructs(field_nodes),
-                                   flatbuf_builder.CreateVectorOfStructs(buffers));
-    auto aligned_offset = StorageUtil::PadUpToSize(ARROW_ALIGNMENT, buffer_offset);
-    AssembleMetadataBuffer(outfile, flatbuf::MessageHeader_RecordBatch, record_batch.Union(), aligned_offset,
-                           &flatbuf_builder);
-
-    // Second pass, write data.
-    for (size_t i = 0; i < column_id_size; ++i) {
-      auto col_id = column_ids[i];
-      common::RawConcurrentBitmap *column_bitmap = data_table_.accessor_.ColumnNullBitmap(block, col_id);
-      std::byte *column_start = data_table_.accessor_.ColumnStart(block, col_id);
-
-      ArrowColumnInfo &col_info = metadata.GetColumnInfo(layout, col_id);
-      field_nodes.emplace_back(num_slots, metadata.NullCount(col_id));
+  }
+  WriteRecordBatchMessage(sink, num_slots, field_nodes, body, flatbuf_builder);
+}
 
-      WriteDataBlock(outfile, reinterpret_cast<const char *>(column_bitmap),
-                     reinterpret_cast<uintptr_t>(column_start) - reinterpret_cast<uintptr_t>(column_bitmap));
+void ArrowSerializer::WriteMaterializedBlock(ArrowIpcSink *sink, RawBlock *block,
+                                             common::ManagedPointer<transaction::TransactionContext> txn,
+                                             const std::vector<ArrowColumnType> &export_types,
+                                             std::unordered_map<col_id_t, int64_t> *dictionary_ids,
+                                             flatbuffers::FlatBufferBuilder *flatbuf_builder) {
+  const BlockLayout &layout = data_table_.accessor_.GetBlockLayout();
+  auto column_ids = layout.AllColumns();
+  auto initializer = ProjectedRowInitializer::Create(layout, column_ids);
+  byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  ProjectedRow *row = initializer.InitializeRow(buffer);
+  // The projected row orders its columns by size
+  std::vector<uint16_t> projection_index(layout.NumColumns());
+  for (uint16_t j = 0; j < row->NumColumns(); j++) projection_index[row->ColumnIds()[j].UnderlyingValue()] = j;
 
-      if (layout.IsVarlen(col_id) && !(col_info.Type() == ArrowColumnType::FIXED_LENGTH)) {
-        switch (col_info.Type()) {
-          case ArrowColumnType::GATHERED_VARLEN: {
-            ArrowVarlenColumn &varlen_col = col_info.VarlenColumn();
-            WriteDataBlock(outfile, reinterpret_cast<const char *>(varlen_col.Offsets()),
-                           varlen_col.OffsetsLength() * sizeof(uint64_t));
-            WriteDataBlock(outfile, reinterpret_cast<const char *>(varlen_col.Values()), varlen_col.ValuesLength());
-            break;
-          }
-          case ArrowColumnType::DICTIONARY_COMPRESSED: {
-            auto indices = col_info.Indices();
-            WriteDataBlock(outfile, reinterpret_cast<const char *>(indices), num_slots * sizeof(uint64_t));
-            break;
-          }
-          default:
-            throw std::runtime_error("unexpected control flow");
-        }
+  // Null bitmap, values and, for varlens, offsets of every column, in the layout it is exported with
+  struct MaterializedColumn {
+    std::vector<uint8_t> bitmap_;
+    std::vector<byte> values_;
+    std::vector<uint64_t> offsets_{0};
+    uint32_t null_count_ = 0;
+  };
+  std::vector<MaterializedColumn> columns(column_ids.size());
+  uint32_t num_rows = 0;
+  for (uint32_t offset = 0; offset < block->GetInsertHead(); offset++) {
+    if (!data_table_.Select(txn, TupleSlot(block, offset), row)) continue;
+    for (size_t i = 0; i < column_ids.size(); i++) {
+      const col_id_t col_id = column_ids[i];
+      MaterializedColumn &column = columns[i];
+      if (num_rows % 8 == 0) column.bitmap_.push_back(0);
+      const byte *value = row->AccessWithNullCheck(projection_index[col_id.UnderlyingValue()]);
+      if (value == nullptr) {
+        column.null_count_++;
       } else {
-        int32_t cur_buffer_len;
-        if (i == column_id_size - 1) {
-          auto casted_column_start = reinterpret_cast<uintptr_t>(column_start);
-          uintptr_t mask = common::Constants::BLOCK_SIZE - 1;
-          cur_buffer_len = ((casted_column_start + mask) & (~mask)) - casted_column_start;
-        } else {
-          cur_buffer_len =
-              reinterpret_cast<uintptr_t>(data_table_.accessor_.ColumnNullBitmap(block, column_ids[i + 1])) -
-              reinterpret_cast<uintptr_t>(column_start);
+        column.bitmap_.back() = static_cast<uint8_t>(column.bitmap_.back() | (1U << (num_rows % 8)));
+      }
+      if (!layout.IsVarlen(col_id) || export_types[i] == ArrowColumnType::FIXED_LENGTH) {
+        const uint8_t size = layout.AttrSize(col_id);
+        if (value == nullptr)
+          column.values_.resize(column.values_.size() + size);
+        else
+          column.values_.insert(column.values_.end(), value, value + size);
+      } else {
+        // A null is an empty entry, which keeps the dictionary code of every row equal to its position
+        if (value != nullptr) {
+          const auto *entry = reinterpret_cast<const VarlenEntry *>(value);
+          column.values_.insert(column.values_.end(), entry->Content(), entry->Content() + entry->Size());
         }
-        WriteDataBlock(outfile, reinterpret_cast<const char *>(column_start), cur_buffer_len);
+        column.offsets_.push_back(column.values_.size());
       }
     }
-    outfile.flush();
-    block->controller_.ReleaseInPlaceRead();
+    num_rows++;
+  }
+  delete[] buffer;
+  if (num_rows == 0) return;
+
+  std::vector<uint64_t> indices(num_rows);
+  for (uint32_t i = 0; i < num_rows; i++) indices[i] = i;
+  std::vector<flatbuf::FieldNode> field_nodes;
+  std::vector<BodyBuffer> body;
+  for (size_t i = 0; i < column_ids.size(); i++) {
+    const col_id_t col_id = column_ids[i];
+    MaterializedColumn &column = columns[i];
+    field_nodes.emplace_back(num_rows, column.null_count_);
+    body.emplace_back(reinterpret_cast<const char *>(column.bitmap_.data()), column.bitmap_.size());
+    if (!layout.IsVarlen(col_id) || export_types[i] == ArrowColumnType::FIXED_LENGTH) {
+      body.emplace_back(reinterpret_cast<const char *>(column.values_.data()), column.values_.size());
+      continue;
+    }
+    switch (export_types[i]) {
+      case ArrowColumnType::GATHERED_VARLEN:
+        body.emplace_back(reinterpret_cast<const char *>(column.offsets_.data()),
+                          column.offsets_.size() * sizeof(uint64_t));
+        body.emplace_back(reinterpret_cast<const char *>(column.values_.data()), column.values_.size());
+        break;
+      case ArrowColumnType::DICTIONARY_COMPRESSED:
+        WriteDictionaryMessage(sink, (*dictionary_ids)[col_id], column.offsets_.data(),
+                               static_cast<uint32_t>(column.offsets_.size()), column.values_.data(),
+                               static_cast<uint32_t>(column.values_.size()), flatbuf_builder);
+        body.emplace_back(reinterpret_cast<const char *>(indices.data()), num_rows * sizeof(uint64_t));
+        break;
+      default:
+        throw std::runtime_error("unexpected control flow");
+    }
   }
+  WriteRecordBatchMessage(sink, num_rows, field_nodes, body, flatbuf_builder);
+}
+
+void ArrowSerializer::ExportTable(const std::string &file_name, std::vector<type::TypeId> *col_types) {
+  std::ofstream outfile(file_name, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+  ArrowIpcFileSink sink(&outfile);
+  ExportTable(&sink, col_types);
   outfile.close();
 }
+
+void ArrowSerializer::ExportTable(ArrowIpcSink *sink, std::vector<type::TypeId> *col_types,
+                                  common::ManagedPointer<transaction::TransactionContext> txn) {
+  flatbuffers::FlatBufferBuilder flatbuf_builder;
+  std::unordered_map<col_id_t, int64_t> dictionary_ids;
+  WriteSchemaMessage(sink, &dictionary_ids, col_types, &flatbuf_builder);
+
+  // The schema message decides how a column is encoded from the first block, so materialized blocks follow it too
+  const BlockLayout &layout = data_table_.accessor_.GetBlockLayout();
+  std::vector<ArrowColumnType> export_types;
+  ArrowBlockMetadata &first_metadata = data_table_.accessor_.GetArrowBlockMetadata(*data_table_.GetBlocks().begin());
+  for (col_id_t col_id : layout.AllColumns())
+    export_types.push_back(layout.IsVarlen(col_id) ? first_metadata.GetColumnInfo(layout, col_id).Type()
+                                                   : ArrowColumnType::FIXED_LENGTH);
+
+  for (auto it : data_table_.GetBlocks()) {  // NOLINT
+    RawBlock *block = it;
+    // Make sure varlen columns have correct data when reading
+    data_table_.MakeResident(block);
+    if (block->controller_.TryAcquireInPlaceRead()) {
+      WriteFrozenBlock(sink, block, &dictionary_ids, &flatbuf_builder);
+      block->controller_.ReleaseInPlaceRead();
+    } else if (txn != nullptr) {
+      WriteMaterializedBlock(sink, block, txn, export_types, &dictionary_ids, &flatbuf_builder);
+    } else {
+      while (!block->controller_.TryAcquireInPlaceRead()) data_table_.MakeResident(block);
+      WriteFrozenBlock(sink, block, &dictionary_ids, &flatbuf_builder);
+      block->controller_.ReleaseInPlaceRead();
+    }
+  }
+  sink->Write(reinterpret_cast<const char *>(&FLATBUF_CONTINUZATION), sizeof(int32_t));
+  sink->Write(reinterpret_cast<const char *>(&END_OF_STREAM), sizeof(int32_t));
+  sink->Flush();
+}
 }  // namespace noisepage::storage
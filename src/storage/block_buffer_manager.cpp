@@ -0,0 +1,219 @@
+#include "storage/block_buffer_manager.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <thread>  // NOLINT
+#include <utility>
+
+#include "common/posix_io_wrappers.h"
+#include "storage/data_table.h"
+#include "transaction/deferred_action_manager.h"
+
+namespace noisepage::storage {
+
+namespace {
+
+// Everything before this offset is the header of a block of the layout, which stays in memory. The rest of the block
+// starts at a page boundary, so that its memory can be returned to the system.
+uint64_t EvictableStart(const BlockLayout &layout) {
+  static const auto page_size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  return (layout.HeaderSize() + page_size - 1) / page_size * page_size;
+}
+
+}  // namespace
+
+BlockBufferManager::BlockBufferManager(std::string path, const uint64_t memory_budget,
+                                       const common::ManagedPointer<transaction::DeferredActionManager>
+                                           deferred_action_manager)
+    : path_(std::move(path)),
+      fd_(PosixIoWrappers::Open(path_.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR)),
+      deferred_action_manager_(deferred_action_manager),
+      memory_budget_(memory_budget) {}
+
+BlockBufferManager::~BlockBufferManager() {
+  NOISEPAGE_ASSERT(tables_.empty(), "tables are still using the block file");
+  PosixIoWrappers::Close(fd_);
+  std::remove(path_.c_str());
+}
+
+void BlockBufferManager::RegisterTable(DataTable *const table) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  NOISEPAGE_ASSERT(table->buffer_manager_ == nullptr, "a table can only be registered once");
+  tables_.insert(table);
+  table->buffer_manager_ = this;
+}
+
+void BlockBufferManager::UnregisterTable(DataTable *const table) {
+  // The blocks may not go back to the block store while they are written out or read back
+  while (!TryUnregisterTable(table)) std::this_thread::yield();
+}
+
+bool BlockBufferManager::TryUnregisterTable(DataTable *const table) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  for (const auto &entry : frames_)
+    if (entry.second.table_ == table && entry.second.paging_) return false;
+
+  for (auto it = frames_.begin(); it != frames_.end();) {
+    if (it->second.table_ != table) {
+      ++it;
+      continue;
+    }
+    if (it->first->controller_.GetBlockState()->load() == BlockState::EVICTED) num_evicted_--;
+    if (it->second.file_slot_ != NO_FILE_SLOT) free_file_slots_.push_back(it->second.file_slot_);
+    it = frames_.erase(it);
+  }
+  clock_.erase(std::remove_if(clock_.begin(), clock_.end(),
+                              [=](RawBlock *const block) { return block->data_table_ == table; }),
+               clock_.end());
+  clock_hand_ = 0;
+  tables_.erase(table);
+  table->buffer_manager_ = nullptr;
+  return true;
+}
+
+uint32_t BlockBufferManager::EvictColdBlocks() {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  // Blocks that are not frozen cannot be evicted, but they still count against the budget
+  uint64_t num_resident = 0;
+  for (DataTable *const table : tables_) {
+    for (RawBlock *const block : table->GetBlocks()) {
+      const BlockState state = block->controller_.GetBlockState()->load();
+      if (state != BlockState::EVICTING && state != BlockState::EVICTED) num_resident++;
+      if (state >= BlockState::FROZEN && frames_.emplace(block, Frame{table}).second) clock_.push_back(block);
+    }
+  }
+
+  const uint64_t budget = memory_budget_ / common::Constants::BLOCK_SIZE;
+  uint32_t num_marked = 0;
+  // The first turn of the hand may only clear reference bits
+  for (uint64_t steps = 0; num_resident > budget && steps < 2 * clock_.size(); steps++) {
+    RawBlock *const block = clock_[clock_hand_];
+    clock_hand_ = (clock_hand_ + 1) % clock_.size();
+    if (block->controller_.GetBlockState()->load() != BlockState::FROZEN) continue;
+    Frame &frame = frames_.at(block);
+    const TupleAccessStrategy &accessor = frame.table_->accessor_;
+    auto &stats = accessor.GetArrowBlockMetadata(block).GetAccessStats(accessor.GetBlockLayout());
+    if (stats.referenced_.exchange(false)) continue;
+    if (TryMarkForEviction(block, &frame)) {
+      num_marked++;
+      num_resident--;
+    }
+  }
+  return num_marked;
+}
+
+bool BlockBufferManager::TryMarkForEviction(RawBlock *const block, Frame *const frame) {
+  // In-place readers hold on to the block, and are not covered by the transactions the deferred action waits for
+  if (!block->controller_.UpdateAtomically({BlockState::FROZEN, 0}, {BlockState::EVICTING, 0})) return false;
+  const uint64_t eviction_id = ++next_eviction_id_;
+  frame->eviction_id_ = eviction_id;
+  deferred_action_manager_->RegisterDeferredAction([this, block, eviction_id] { FinishEviction(block, eviction_id); });
+  return true;
+}
+
+void BlockBufferManager::FinishEviction(RawBlock *const block, const uint64_t eviction_id) {
+  uint64_t offset;
+  uint64_t begin;
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    // The table may be gone, or the block was accessed and marked again since. The latch keeps it from being marked
+    // again between this check and flipping its status.
+    auto it = frames_.find(block);
+    if (it == frames_.end() || it->second.eviction_id_ != eviction_id) return;
+    BlockState state = BlockState::EVICTING;
+    if (!block->controller_.GetBlockState()->compare_exchange_strong(state, BlockState::PAGING)) return;
+    Frame &frame = it->second;
+    if (frame.file_slot_ == NO_FILE_SLOT) frame.file_slot_ = AllocateFileSlot();
+    frame.paging_ = true;
+    offset = frame.file_slot_ * common::Constants::BLOCK_SIZE;
+    begin = EvictableStart(frame.table_->accessor_.GetBlockLayout());
+  }
+
+  byte *const evictable = reinterpret_cast<byte *>(block) + begin;
+  const uint64_t size = common::Constants::BLOCK_SIZE - begin;
+  bool evicted = true;
+  try {
+    PosixIoWrappers::PwriteFully(fd_, evictable, size, static_cast<off_t>(offset + begin));
+    // If the memory cannot be returned, it still holds the contents, which are read back over anyway
+    madvise(evictable, size, MADV_DONTNEED);
+  } catch (std::runtime_error &) {
+    // The block stays in memory if it cannot be written out
+    evicted = false;
+  }
+  block->controller_.GetBlockState()->store(evicted ? BlockState::EVICTED : BlockState::FROZEN);
+
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  frames_.at(block).paging_ = false;
+  if (evicted) num_evicted_++;
+}
+
+void BlockBufferManager::Fault(RawBlock *const block) {
+  std::atomic<BlockState> *const state = block->controller_.GetBlockState();
+  while (true) {
+    BlockState current = state->load();
+    switch (current) {
+      case BlockState::EVICTING:
+        // Cancel the eviction
+        if (state->compare_exchange_strong(current, BlockState::FROZEN)) return;
+        continue;
+      case BlockState::PAGING:
+        // Someone else is writing the block out or reading it back
+        std::this_thread::yield();
+        continue;
+      case BlockState::EVICTED:
+        if (!state->compare_exchange_strong(current, BlockState::PAGING)) continue;
+        ReadBack(block);
+        return;
+      default:
+        return;
+    }
+  }
+}
+
+void BlockBufferManager::ReadBack(RawBlock *const block) {
+  uint64_t offset;
+  uint64_t begin;
+  const TupleAccessStrategy *accessor;
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    Frame &frame = frames_.at(block);
+    frame.paging_ = true;
+    offset = frame.file_slot_ * common::Constants::BLOCK_SIZE;
+    accessor = &frame.table_->accessor_;
+    begin = EvictableStart(accessor->GetBlockLayout());
+  }
+
+  const uint64_t size = common::Constants::BLOCK_SIZE - begin;
+  try {
+    const uint32_t bytes_read = PosixIoWrappers::PreadFully(fd_, reinterpret_cast<byte *>(block) + begin, size,
+                                                            static_cast<off_t>(offset + begin));
+    if (bytes_read != size) throw std::runtime_error("block file is truncated");
+  } catch (std::runtime_error &) {
+    // The block is left evicted, so that the next access tries again
+    block->controller_.GetBlockState()->store(BlockState::EVICTED);
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    frames_.at(block).paging_ = false;
+    throw;
+  }
+  // The block was just accessed, so it should not be the next one to go
+  accessor->GetArrowBlockMetadata(block).GetAccessStats(accessor->GetBlockLayout()).referenced_.store(true);
+  block->controller_.GetBlockState()->store(BlockState::FROZEN);
+
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  frames_.at(block).paging_ = false;
+  num_evicted_--;
+}
+
+uint64_t BlockBufferManager::AllocateFileSlot() {
+  if (free_file_slots_.empty()) return num_file_slots_++;
+  const uint64_t slot = free_file_slots_.back();
+  free_file_slots_.pop_back();
+  return slot;
+}
+
+}  // namespace noisepage::storage
@@ -1,70 +1,105 @@
 #include "storage/block_compactor.h"
 
 #include <algorithm>
+#include <limits>
 #include <queue>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "storage/sql_table.h"
+#include "storage/varlen_allocator.h"
 #include "transaction/deferred_action_manager.h"
 #include "transaction/transaction_util.h"
 
 namespace noisepage::storage {
+
+namespace {
+// The varlen entries of a column are a stride apart, which is more than their size if the column is in a column group
+VarlenEntry &EntryAt(byte *const values, const uint16_t stride, const uint32_t i) {
+  return *reinterpret_cast<VarlenEntry *>(values + static_cast<uint64_t>(stride) * i);
+}
+}  // namespace
+
 void BlockCompactor::ProcessCompactionQueue(transaction::DeferredActionManager *deferred_action_manager,
                                             transaction::TransactionManager *txn_manager) {
-  std::queue<RawBlock *> to_process = std::move(compaction_queue_);
-  while (!to_process.empty()) {
+  std::queue<RawBlock *> to_process;
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&queue_latch_);
+    to_process.swap(compaction_queue_);
+  }
+  // A block can be queued more than once, but two steps on the same block must not run at the same time
+  std::unordered_set<RawBlock *> seen;
+  for (; !to_process.empty(); to_process.pop()) {
     RawBlock *block = to_process.front();
-    BlockAccessController &controller = block->controller_;
-    switch (controller.GetBlockState()->load()) {
-      case BlockState::HOT: {
-        // TODO(Tianyu): The policy about how to group blocks together into compaction group can be a lot
-        // more sophisticated. Compacting more blocks together frees up more memory per compaction run,
-        // but makes the compaction transaction larger, which can have performance impact on the rest
-        // of the system. As it currently stands, no memory is freed from this one-block-per-group scheme.
-        CompactionGroup cg(txn_manager->BeginTransaction(), block->data_table_);
-        // TODO(Tianyu): Additionally, frozen blocks can still have empty slots within them. To make sure
-        // these memory are not gone forever, we still need to periodically shuffle tuples around within
-        // frozen blocks. Although code can be reused for doing the compaction, some logic needs to be
-        // written to enqueue these frozen blocks into the compaction queue.
-        cg.blocks_to_compact_.emplace(block, std::vector<uint32_t>());
-        if (EliminateGaps(&cg)) {
-          controller.GetBlockState()->store(BlockState::COOLING);
-          // If no compaction was performed, we still need to shut out any potentially racey transactions that
-          // are alive at the same time as us flipping the block status flag to cooling. However, we must manually
-          // ask the GC to enqueue this block, because no access will be observed from the empty compaction transaction.
-          if (cg.txn_->IsReadOnly())
-            deferred_action_manager->RegisterDeferredAction([this, block]() { PutInQueue(block); });
-          txn_manager->Commit(cg.txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
-        } else {
-          txn_manager->Abort(cg.txn_);
-        }
-        break;
+    if (!seen.insert(block).second) continue;
+    if (workers_ == nullptr)
+      ProcessBlock(block, deferred_action_manager, txn_manager);
+    else
+      workers_->SubmitTask([=] { ProcessBlock(block, deferred_action_manager, txn_manager); });
+  }
+  if (workers_ != nullptr) workers_->WaitUntilAllFinished();
+}
+
+void BlockCompactor::ProcessBlock(RawBlock *block, transaction::DeferredActionManager *deferred_action_manager,
+                                  transaction::TransactionManager *txn_manager) {
+  BlockAccessController &controller = block->controller_;
+  switch (controller.GetBlockState()->load()) {
+    case BlockState::HOT: {
+      // TODO(Tianyu): The policy about how to group blocks together into compaction group can be a lot
+      // more sophisticated. Compacting more blocks together frees up more memory per compaction run,
+      // but makes the compaction transaction larger, which can have performance impact on the rest
+      // of the system. As it currently stands, no memory is freed from this one-block-per-group scheme.
+      CompactionGroup cg(txn_manager->BeginTransaction(), block->data_table_);
+      // TODO(Tianyu): Additionally, frozen blocks can still have empty slots within them. To make sure
+      // these memory are not gone forever, we still need to periodically shuffle tuples around within
+      // frozen blocks. Although code can be reused for doing the compaction, some logic needs to be
+      // written to enqueue these frozen blocks into the compaction queue.
+      cg.blocks_to_compact_.emplace(block, std::vector<uint32_t>());
+      if (EliminateGaps(&cg)) {
+        controller.GetBlockState()->store(BlockState::COOLING);
+        // If no compaction was performed, we still need to shut out any potentially racey transactions that
+        // are alive at the same time as us flipping the block status flag to cooling. However, we must manually
+        // ask the GC to enqueue this block, because no access will be observed from the empty compaction transaction.
+        if (cg.txn_->IsReadOnly())
+          deferred_action_manager->RegisterDeferredAction([this, block]() { PutInQueue(block); });
+        txn_manager->Commit(cg.txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
+      } else {
+        txn_manager->Abort(cg.txn_);
       }
-      case BlockState::COOLING: {
-        if (!CheckForVersionsAndGaps(block->data_table_->accessor_, block)) continue;
-        // This is used to clean up any dangling pointers using a deferred action in GC.
-        // We need this piece of memory to live on the heap, so its life time extends to
-        // beyond this function call.
-        auto *loose_ptrs = new std::vector<const byte *>;
-        GatherVarlens(loose_ptrs, block, block->data_table_);
-        controller.GetBlockState()->store(BlockState::FROZEN);
-        // When the old variable length values are no longer visible by running transactions, delete them.
-        deferred_action_manager->RegisterDeferredAction([=]() {
-          for (auto *loose_ptr : *loose_ptrs) delete[] loose_ptr;
-          delete loose_ptrs;
-        });
+      break;
+    }
+    case BlockState::COOLING: {
+      // The versions left behind by the compaction transaction, or by a writer that preempted it, are only pruned by
+      // the GC. Instead of waiting for them, which would never finish on the GC thread, the block is resumed in the
+      // next pass in whatever state it is in by then.
+      if (!CheckForVersionsAndGaps(block->data_table_->accessor_, block)) {
+        PutInQueue(block);
         break;
       }
-      case BlockState::FROZEN:
-        // This is okay. In a rare race, the block can show up in the compaction queue, be accessed, compacted,
-        // and show up again because of the early access.
-        break;
-      default:
-        throw std::runtime_error("unexpected control flow");
+      // This is used to clean up any dangling pointers using a deferred action in GC.
+      // We need this piece of memory to live on the heap, so its life time extends to
+      // beyond this function call.
+      auto *loose_ptrs = new std::vector<const byte *>;
+      GatherVarlens(loose_ptrs, block, block->data_table_);
+      controller.GetBlockState()->store(BlockState::FROZEN);
+      // When the old variable length values are no longer visible by running transactions, delete them.
+      deferred_action_manager->RegisterDeferredAction([=]() {
+        for (auto *loose_ptr : *loose_ptrs) VarlenAllocator::Deallocate(loose_ptr);
+        delete loose_ptrs;
+      });
+      break;
     }
-    to_process.pop();
+    case BlockState::FROZEN:
+    case BlockState::EVICTING:
+    case BlockState::PAGING:
+    case BlockState::EVICTED:
+      // This is okay. In a rare race, the block can show up in the compaction queue, be accessed, compacted,
+      // and show up again because of the early access.
+      break;
+    default:
+      throw std::runtime_error("unexpected control flow");
   }
 }
 
@@ -175,7 +210,7 @@ bool BlockCompactor::MoveTuple(CompactionGroup *cg, TupleSlot from, TupleSlot to
       *entry = VarlenEntry::CreateInline(entry->Content(), entry->Size());
     } else {
       // TODO(Tianyu): Copying for correctness. This is not yet shown to be expensive, but might be in the future.
-      byte *copied = common::AllocationUtil::AllocateAligned(entry->Size());
+      byte *copied = VarlenAllocator::Allocate(entry->Size());
       std::memcpy(copied, entry->Content(), entry->Size());
       *entry = VarlenEntry::Create(copied, entry->Size(), true);
     }
@@ -248,18 +283,40 @@ void BlockCompactor::GatherVarlens(std::vector<const byte *> *loose_ptrs, RawBlo
       // Only need to count null for non-varlens
       for (uint32_t i = 0; i < metadata.NumRecords(); i++)
         if (!column_bitmap->Test(i)) metadata.NullCount(col_id)++;
+      // The zone map widened over the lifetime of the block, and is now tightened to the values that are left. Scans
+      // may check it concurrently, so the bounds are computed on the side and replaced once.
+      if (table->HasColumnZone(col_id)) {
+        int64_t min = std::numeric_limits<int64_t>::max();
+        int64_t max = std::numeric_limits<int64_t>::min();
+        const uint8_t size = layout.AttrSize(col_id);
+        const uint16_t stride = layout.AttrStride(col_id);
+        const byte *const column = accessor.ColumnStart(block, col_id);
+        for (uint32_t i = 0; i < metadata.NumRecords(); i++) {
+          if (!column_bitmap->Test(i)) continue;
+          const int64_t value = ColumnZone::Read(column + i * stride, size);
+          min = std::min(min, value);
+          max = std::max(max, value);
+        }
+        metadata.GetColumnZone(layout, col_id).Tighten(min, max);
+        // Nobody reads the block in place until it is frozen, so the encoded copy of the last freeze can be replaced.
+        // Columns of a column group are never read in place, so they are not encoded.
+        if (layout.IsColumnar(col_id))
+          metadata.GetColumnInfo(layout, col_id).Encoded() =
+              EncodedColumn::Encode(column, size, column_bitmap, metadata.NumRecords(), min, max);
+      }
       continue;
     }
 
     // Otherwise, the column is varlen, need to first check what to do for it
     ArrowColumnInfo &col_info = metadata.GetColumnInfo(layout, col_id);
-    auto *values = reinterpret_cast<VarlenEntry *>(accessor.ColumnStart(block, col_id));
+    byte *values = accessor.ColumnStart(block, col_id);
+    const uint16_t stride = layout.AttrStride(col_id);
     switch (col_info.Type()) {
       case ArrowColumnType::GATHERED_VARLEN:
-        CopyToArrowVarlen(loose_ptrs, &metadata, col_id, column_bitmap, &col_info, values);
+        CopyToArrowVarlen(loose_ptrs, &metadata, col_id, column_bitmap, &col_info, values, stride);
         break;
       case ArrowColumnType::DICTIONARY_COMPRESSED:
-        BuildDictionary(loose_ptrs, &metadata, col_id, column_bitmap, &col_info, values);
+        BuildDictionary(loose_ptrs, &metadata, col_id, column_bitmap, &col_info, values, stride);
         break;
       default:
         throw std::runtime_error("unexpected control flow");
@@ -269,7 +326,7 @@ void BlockCompactor::GatherVarlens(std::vector<const byte *> *loose_ptrs, RawBlo
 
 void BlockCompactor::CopyToArrowVarlen(std::vector<const byte *> *loose_ptrs, ArrowBlockMetadata *metadata,
                                        col_id_t col_id, common::RawConcurrentBitmap *column_bitmap,
-                                       ArrowColumnInfo *col, VarlenEntry *values) {
+                                       ArrowColumnInfo *col, byte *const values, const uint16_t stride) {
   uint32_t varlen_size = 0;
   // Read through every tuple and update null count and total varlen size
   metadata->NullCount(col_id) = 0;
@@ -279,7 +336,7 @@ void BlockCompactor::CopyToArrowVarlen(std::vector<const byte *> *loose_ptrs, Ar
       metadata->NullCount(col_id)++;
     else
       // count the total size of varlens
-      varlen_size += values[i].Size();
+      varlen_size += EntryAt(values, stride, i).Size();
   }
 
   // We cannot deallocate the old information yet, because entries in the table may point to values within
@@ -290,7 +347,7 @@ void BlockCompactor::CopyToArrowVarlen(std::vector<const byte *> *loose_ptrs, Ar
     if (!column_bitmap->Test(i)) continue;
 
     // Only do a gather operation if the column is varlen
-    VarlenEntry &entry = values[i];
+    VarlenEntry &entry = EntryAt(values, stride, i);
     std::memcpy(new_col.Values() + acc, entry.Content(), entry.Size());
 
     // Need to GC
@@ -310,7 +367,7 @@ void BlockCompactor::CopyToArrowVarlen(std::vector<const byte *> *loose_ptrs, Ar
 
 void BlockCompactor::BuildDictionary(std::vector<const byte *> *loose_ptrs, ArrowBlockMetadata *metadata,
                                      col_id_t col_id, common::RawConcurrentBitmap *column_bitmap, ArrowColumnInfo *col,
-                                     VarlenEntry *values) {
+                                     byte *const values, const uint16_t stride) {
   VarlenEntryMap<uint32_t> dictionary;
   // Read through every tuple and update null count and build the dictionary
   uint32_t varlen_size = 0;
@@ -321,9 +378,9 @@ void BlockCompactor::BuildDictionary(std::vector<const byte *> *loose_ptrs, Arro
       metadata->NullCount(col_id)++;
       continue;
     }
-    auto ret = dictionary.emplace(values[i], 0);
+    auto ret = dictionary.emplace(EntryAt(values, stride, i), 0);
     // If the string has not been seen before, should add it to dictionary when counting total length.
-    if (ret.second) varlen_size += values[i].Size();
+    if (ret.second) varlen_size += EntryAt(values, stride, i).Size();
   }
   ArrowColumnInfo new_col_info;
   new_col_info.Type() = col->Type();
@@ -336,6 +393,8 @@ void BlockCompactor::BuildDictionary(std::vector<const byte *> *loose_ptrs, Arro
   std::vector<VarlenEntry> corpus;
   for (auto &entry : dictionary) corpus.push_back(entry.first);
   std::sort(corpus.begin(), corpus.end(), VarlenContentCompare());
+  new_col_info.Dictionary() =
+      common::AllocationUtil::AllocateAligned<VarlenEntry>(static_cast<uint32_t>(corpus.size()));
   // Write the dictionary content to Arrow
   for (uint32_t i = 0, acc = 0; i < corpus.size(); i++) {
     VarlenEntry &entry = corpus[i];
@@ -343,6 +402,7 @@ void BlockCompactor::BuildDictionary(std::vector<const byte *> *loose_ptrs, Arro
     dictionary[entry] = i;
     std::memcpy(new_col.Values() + acc, entry.Content(), entry.Size());
     new_col.Offsets()[i] = acc;
+    new_col_info.Dictionary()[i] = VarlenEntry::Create(new_col.Values() + acc, entry.Size(), false);
     acc += entry.Size();
   }
   new_col.Offsets()[corpus.size()] = new_col.ValuesLength();
@@ -351,7 +411,7 @@ void BlockCompactor::BuildDictionary(std::vector<const byte *> *loose_ptrs, Arro
   for (uint32_t i = 0; i < metadata->NumRecords(); i++) {
     if (!column_bitmap->Test(i)) continue;
     // Only do a gather operation if the column is varlen
-    VarlenEntry &entry = values[i];
+    VarlenEntry &entry = EntryAt(values, stride, i);
     // Need to GC
     if (entry.NeedReclaim()) loose_ptrs->push_back(entry.Content());
     uint64_t dictionary_code = new_col_info.Indices()[i] = dictionary[entry];
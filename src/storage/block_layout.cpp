@@ -8,22 +8,73 @@
 #include "storage/storage_util.h"
 
 namespace noisepage::storage {
-BlockLayout::BlockLayout(std::vector<uint16_t> attr_sizes)
+namespace {
+// Values are aligned to the largest power of two that divides their size, but to no more than 8 bytes
+uint8_t ValueAlignment(const uint16_t size) {
+  const auto lowest_bit = static_cast<uint16_t>(size & -size);
+  return static_cast<uint8_t>(lowest_bit == 0 || lowest_bit > sizeof(uint64_t) ? sizeof(uint64_t) : lowest_bit);
+}
+}  // namespace
+
+BlockLayout::BlockLayout(std::vector<uint16_t> attr_sizes) : BlockLayout(std::move(attr_sizes), {}) {}
+
+BlockLayout::BlockLayout(std::vector<uint16_t> attr_sizes, std::vector<std::vector<col_id_t>> column_groups)
     : attr_sizes_(std::move(attr_sizes)),
       tuple_size_(ComputeTupleSize()),
-      static_header_size_(ComputeStaticHeaderSize()),
-      num_slots_(ComputeNumSlots()),
-      header_size_(ComputeHeaderSize()) {
+      static_header_size_(ComputeStaticHeaderSize()) {
   for (uint16_t size UNUSED_ATTRIBUTE : attr_sizes_)
     NOISEPAGE_ASSERT(size == VARLEN_COLUMN || (size >= 0 && size <= INT16_MAX), "Invalid size of a column");
   NOISEPAGE_ASSERT(!attr_sizes_.empty() && static_cast<uint16_t>(attr_sizes_.size()) <= common::Constants::MAX_COL,
                    "number of columns must be between 1 and MAX_COL");
-  NOISEPAGE_ASSERT(num_slots_ != 0, "number of slots cannot be 0!");
   // sort the attributes when laying out memory to minimize impact of padding
   // skip the reserved columns because we still want those first and shouldn't mess up 8-byte alignment
   std::sort(attr_sizes_.begin() + NUM_RESERVED_COLUMNS, attr_sizes_.end(), std::greater<>());
   for (uint32_t i = 0; i < attr_sizes_.size(); i++)
     if (attr_sizes_[i] == VARLEN_COLUMN) varlens_.emplace_back(i);
+  // The groups refer to the sorted columns, and how many slots fit in a block depends on them
+  ComputeColumnGroups(std::move(column_groups));
+  num_slots_ = ComputeNumSlots();
+  header_size_ = ComputeHeaderSize();
+  NOISEPAGE_ASSERT(num_slots_ != 0, "number of slots cannot be 0!");
+}
+
+void BlockLayout::ComputeColumnGroups(std::vector<std::vector<col_id_t>> column_groups) {
+  constexpr uint16_t NO_GROUP = UINT16_MAX;
+  attr_groups_.assign(NumColumns(), NO_GROUP);
+  attr_strides_.resize(NumColumns());
+  attr_group_offsets_.resize(NumColumns());
+  for (auto &group : column_groups) {
+    NOISEPAGE_ASSERT(group.size() > 1, "a column group needs at least two columns");
+    std::sort(group.begin(), group.end());
+    for (const col_id_t col_id : group) {
+      NOISEPAGE_ASSERT(col_id.UnderlyingValue() >= NUM_RESERVED_COLUMNS && col_id.UnderlyingValue() < NumColumns(),
+                       "reserved columns and columns out of bounds cannot be in a group");
+      NOISEPAGE_ASSERT(attr_groups_[col_id.UnderlyingValue()] == NO_GROUP, "a column can only be in one group");
+      attr_groups_[col_id.UnderlyingValue()] = 0;
+    }
+  }
+  for (uint16_t i = 0; i < NumColumns(); i++)
+    if (attr_groups_[i] == NO_GROUP) column_groups.push_back({col_id_t(i)});
+  // Laying the groups out in the order of their first columns keeps a purely columnar layout in column order
+  std::sort(column_groups.begin(), column_groups.end(),
+            [](const std::vector<col_id_t> &a, const std::vector<col_id_t> &b) { return a[0] < b[0]; });
+
+  for (uint16_t group_id = 0; group_id < column_groups.size(); group_id++) {
+    const std::vector<col_id_t> &group = column_groups[group_id];
+    // Sizes descend within a group, so values are padded within a row the same way a ProjectedRow pads them, and a
+    // row is padded to the alignment of its first value
+    uint32_t row_size = 0;
+    for (const col_id_t col_id : group) {
+      row_size = StorageUtil::PadUpToSize(ValueAlignment(AttrSize(col_id)), row_size);
+      attr_groups_[col_id.UnderlyingValue()] = group_id;
+      attr_group_offsets_[col_id.UnderlyingValue()] = static_cast<uint16_t>(row_size);
+      row_size += AttrSize(col_id);
+    }
+    const uint32_t stride = StorageUtil::PadUpToSize(ValueAlignment(AttrSize(group[0])), row_size);
+    NOISEPAGE_ASSERT(stride <= UINT16_MAX, "rows of a column group are too wide");
+    for (const col_id_t col_id : group) attr_strides_[col_id.UnderlyingValue()] = static_cast<uint16_t>(stride);
+  }
+  column_groups_ = std::move(column_groups);
 }
 
 uint32_t BlockLayout::ComputeTupleSize() const {
@@ -44,12 +95,15 @@ uint32_t BlockLayout::ComputeStaticHeaderSize() const {
 
 uint32_t BlockLayout::ComputeNumSlots() const {
   uint32_t bytes_available = common::Constants::BLOCK_SIZE - static_header_size_;
-  // account for paddings up to 64 bits-aligned. There is padding between every bitmap and value field.
-  // Each column has a bitmap and a value buffer. The first column can have padding against header. The
-  // last column has nothing to pad to.
-  bytes_available -= static_cast<uint32_t>(sizeof(uint64_t)) * 2 * NumColumns();
+  // account for paddings up to 64 bits-aligned. There is padding after every bitmap and value field.
+  // Each column has a bitmap, and each group of columns a value buffer. The first column can have padding against
+  // header. The last column has nothing to pad to.
+  bytes_available -= static_cast<uint32_t>(sizeof(uint64_t) * (NumColumns() + column_groups_.size()));
+  // A row of a group takes up its stride, which is just the attribute size for a column on its own
+  uint32_t row_size = 0;
+  for (const auto &group : column_groups_) row_size += AttrStride(group[0]);
   // Every column needs a bit for bitmap, plus a global presence bit for the whole tuple
-  uint32_t bits_per_tuple = BYTE_SIZE * tuple_size_ + NumColumns() + 1;
+  uint32_t bits_per_tuple = BYTE_SIZE * row_size + NumColumns() + 1;
   return BYTE_SIZE * bytes_available / bits_per_tuple;
 }
 
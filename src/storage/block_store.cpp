@@ -0,0 +1,209 @@
+#include "storage/block_store.h"
+
+#if __linux__
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+
+#include "common/memory_accountant.h"
+#include "common/numa_topology.h"
+#include "storage/storage_defs.h"
+
+namespace noisepage::storage {
+
+namespace {
+
+// The default huge page size of the kernel, which is what an anonymous MAP_HUGETLB mapping is backed with
+uint64_t DefaultHugePageSize() {
+  std::ifstream meminfo("/proc/meminfo");
+  std::string line;
+  while (std::getline(meminfo, line)) {
+    // The line looks like "Hugepagesize:       2048 kB"
+    if (line.rfind("Hugepagesize:", 0) != 0) continue;
+    std::stringstream stream(line.substr(line.find(':') + 1));
+    uint64_t size_kb = 0;
+    stream >> size_kb;
+    return size_kb * 1024;
+  }
+  return 0;
+}
+
+}  // namespace
+
+BlockStore::BlockStore(const uint64_t size_limit, const uint64_t reuse_limit, const bool huge_pages)
+    : reuse_queues_(NumNodes()), size_limit_(size_limit), reuse_limit_(reuse_limit) {
+  if (huge_pages) ReserveArena(size_limit);
+}
+
+BlockStore::~BlockStore() {
+  for (auto &queue : reuse_queues_) {
+    while (!queue.empty()) {
+      Free(queue.front());
+      queue.pop();
+    }
+  }
+#if __linux__
+  if (arena_mapping_ != nullptr) munmap(arena_mapping_, arena_mapping_size_);
+#endif
+}
+
+void BlockStore::ReserveArena(const uint64_t num_blocks) {
+#if __linux__
+  const uint64_t arena_size = num_blocks * common::Constants::BLOCK_SIZE;
+  // A MAP_HUGETLB mapping reserves all of its huge pages right away, so it fails instead of faulting later if the huge
+  // page pool is too small
+  const uint64_t huge_page_size = DefaultHugePageSize();
+  if (huge_page_size >= ARENA_ALIGNMENT) {
+    const uint64_t mapping_size = (arena_size + huge_page_size - 1) / huge_page_size * huge_page_size;
+    void *const mapping =
+        mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (mapping != MAP_FAILED) {
+      arena_mapping_ = mapping;
+      arena_mapping_size_ = mapping_size;
+      arena_ = static_cast<byte *>(mapping);
+      arena_capacity_ = num_blocks;
+      return;
+    }
+  }
+
+  // Otherwise, only reserve the address space and let the kernel back it with transparent huge pages as it is touched.
+  // THP only uses huge pages for aligned ranges.
+  const uint64_t mapping_size = arena_size + ARENA_ALIGNMENT;
+  void *const mapping =
+      mmap(nullptr, mapping_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (mapping == MAP_FAILED) return;
+  if (madvise(mapping, mapping_size, MADV_HUGEPAGE) != 0) {
+    munmap(mapping, mapping_size);
+    return;
+  }
+  arena_mapping_ = mapping;
+  arena_mapping_size_ = mapping_size;
+  const auto address = reinterpret_cast<uintptr_t>(mapping);
+  arena_ = reinterpret_cast<byte *>((address + ARENA_ALIGNMENT - 1) / ARENA_ALIGNMENT * ARENA_ALIGNMENT);
+  arena_capacity_ = num_blocks;
+#endif
+}
+
+RawBlock *BlockStore::Get(const uint16_t node) {
+  NOISEPAGE_ASSERT(node < reuse_queues_.size(), "NUMA node out of range.");
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  RawBlock *result = nullptr;
+  // A local block is preferred over a new one, and a new one, as long as the size limit allows it, over a remote one
+  if (!reuse_queues_[node].empty()) {
+    result = reuse_queues_[node].front();
+    reuse_queues_[node].pop();
+    num_reusable_--;
+    return result;
+  }
+  if (current_size_ < size_limit_) {
+    result = Allocate(node);
+    // result could be null because the system may not find enough memory space
+    if (result == nullptr) throw common::AllocatorFailureException();
+    current_size_++;
+    return result;
+  }
+  result = TakeReusable(node);
+  if (result == nullptr) throw common::NoMoreObjectException(size_limit_);
+  NOISEPAGE_ASSERT(current_size_ <= size_limit_, "Block store has exceeded its size limit.");
+  return result;
+}
+
+void BlockStore::Release(RawBlock *const block) {
+  NOISEPAGE_ASSERT(block != nullptr, "releasing a null pointer");
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  if (num_reusable_ >= reuse_limit_) {
+    Free(block);
+    current_size_--;
+  } else {
+    reuse_queues_[NodeOf(block)].push(block);
+    num_reusable_++;
+  }
+}
+
+bool BlockStore::SetSizeLimit(const uint64_t new_size) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  if (new_size < current_size_) return false;
+  size_limit_ = new_size;
+  return true;
+}
+
+void BlockStore::SetReuseLimit(const uint64_t new_reuse_limit) {
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  reuse_limit_ = new_reuse_limit;
+  // Free the blocks of the fullest pools first, so that every node keeps some blocks to reuse
+  while (num_reusable_ > reuse_limit_) {
+    auto *fullest = &reuse_queues_.front();
+    for (auto &queue : reuse_queues_) {
+      if (queue.size() > fullest->size()) fullest = &queue;
+    }
+    Free(fullest->front());
+    fullest->pop();
+    num_reusable_--;
+    current_size_--;
+  }
+}
+
+RawBlock *BlockStore::TakeReusable(const uint16_t preferred_node) {
+  for (uint16_t i = 0; i < reuse_queues_.size(); i++) {
+    auto &queue = reuse_queues_[(preferred_node + i) % reuse_queues_.size()];
+    if (queue.empty()) continue;
+    RawBlock *const result = queue.front();
+    queue.pop();
+    num_reusable_--;
+    return result;
+  }
+  return nullptr;
+}
+
+uint16_t BlockStore::NumNodes() { return common::NumaTopology::Get().NumNodes(); }
+
+uint16_t BlockStore::CurrentNode() { return common::NumaTopology::Get().CurrentNode(); }
+
+uint16_t BlockStore::NodeOf(const RawBlock *const block) { return block->numa_node_; }
+
+RawBlock *BlockStore::Allocate(const uint16_t node) {
+  void *memory = nullptr;
+  if (!arena_free_.empty()) {
+    memory = arena_free_.back();
+    arena_free_.pop_back();
+  } else if (arena_next_ < arena_capacity_) {
+    memory = arena_ + arena_next_++ * common::Constants::BLOCK_SIZE;
+  } else {
+    // The size limit was raised above what the arena was reserved for, or there is no arena
+    memory = ::operator new(sizeof(RawBlock), std::align_val_t(alignof(RawBlock)), std::nothrow);
+  }
+  if (memory == nullptr) return nullptr;
+#if __linux__
+  // Ask the kernel to back the block with memory of the node before its pages are touched. This is only a preference,
+  // so it does not matter if it fails. The page faults of the first touch below then place the memory on the node too,
+  // if the calling thread runs on it.
+  if (NumNodes() > 1 && node < sizeof(unsigned long) * 8 - 1) {  // NOLINT
+    const unsigned long node_mask = 1UL << node;                 // NOLINT
+    // The kernel only looks at the first maxnode - 1 bits of the mask
+    syscall(SYS_mbind, memory, sizeof(RawBlock), MPOL_PREFERRED, &node_mask, sizeof(node_mask) * 8, 0);
+  }
+#endif
+  auto *const block = new (memory) RawBlock();
+  block->numa_node_ = node;
+  common::MemoryAccountant::Allocate(common::MemoryComponent::BLOCK_STORE, sizeof(RawBlock));
+  return block;
+}
+
+void BlockStore::Free(RawBlock *const block) {
+  block->~RawBlock();
+  common::MemoryAccountant::Free(common::MemoryComponent::BLOCK_STORE, sizeof(RawBlock));
+  if (InArena(block)) {
+    arena_free_.push_back(block);
+    return;
+  }
+  ::operator delete(block, std::align_val_t(alignof(RawBlock)));
+}
+
+}  // namespace noisepage::storage
@@ -0,0 +1,127 @@
+#include "storage/bulk_loader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "catalog/index_schema.h"
+#include "catalog/schema.h"
+#include "storage/index/index.h"
+#include "storage/sql_table.h"
+#include "storage/write_ahead_log/log_record.h"
+#include "transaction/transaction_context.h"
+
+namespace noisepage::storage {
+
+namespace {
+uint32_t WordsFor(const uint32_t size) { return (size + sizeof(uint64_t) - 1) / sizeof(uint64_t); }
+
+std::vector<catalog::col_oid_t> ColOids(const catalog::Schema &schema) {
+  std::vector<catalog::col_oid_t> col_oids;
+  col_oids.reserve(schema.GetColumns().size());
+  for (const auto &col : schema.GetColumns()) col_oids.emplace_back(col.Oid());
+  return col_oids;
+}
+}  // namespace
+
+bool BulkLoader::SupportsIndex(const catalog::IndexSchema &index_schema) {
+  if (index_schema.Predicate() != nullptr) return false;
+  return std::all_of(index_schema.GetColumns().cbegin(), index_schema.GetColumns().cend(), [](const auto &key_col) {
+    return key_col.StoredExpression()->GetExpressionType() == parser::ExpressionType::COLUMN_VALUE;
+  });
+}
+
+BulkLoader::BulkLoader(
+    const common::ManagedPointer<transaction::TransactionContext> txn, const catalog::db_oid_t db_oid,
+    const catalog::table_oid_t table_oid, const common::ManagedPointer<SqlTable> table, const catalog::Schema &schema,
+    const std::vector<std::pair<common::ManagedPointer<index::Index>, const catalog::IndexSchema &>> &indexes)
+    : txn_(txn),
+      db_oid_(db_oid),
+      table_oid_(table_oid),
+      table_(table),
+      initializer_(table->InitializerForProjectedRow(ColOids(schema))) {
+  const std::vector<catalog::col_oid_t> col_oids = ColOids(schema);
+  const ProjectionMap projection_map = table_->ProjectionMapForOids(col_oids);
+  column_offsets_.reserve(col_oids.size());
+  for (const auto col_oid : col_oids) column_offsets_.emplace_back(projection_map.at(col_oid));
+
+  uint32_t unique_key_words = 0;
+  for (const auto &[index, index_schema] : indexes) {
+    NOISEPAGE_ASSERT(SupportsIndex(index_schema), "The loader cannot maintain this index.");
+    IndexKeys index_keys;
+    index_keys.index_ = index;
+    index_keys.unique_ = index_schema.Unique();
+    index_keys.key_words_ = WordsFor(index->GetProjectedRowInitializer().ProjectedRowSize());
+    const auto &indexed_col_oids = index_schema.GetIndexedColOids();
+    for (uint16_t col_idx = 0; col_idx < indexed_col_oids.size(); col_idx++) {
+      const auto &key_col = index_schema.GetColumn(col_idx);
+      index_keys.columns_.push_back({index->GetKeyOidToOffsetMap().at(key_col.Oid()),
+                                     projection_map.at(indexed_col_oids[col_idx]),
+                                     static_cast<uint8_t>(AttrSizeBytes(key_col.AttributeLength()))});
+    }
+    if (index_keys.unique_) unique_key_words = std::max(unique_key_words, index_keys.key_words_);
+    indexes_.emplace_back(std::move(index_keys));
+  }
+  unique_key_.resize(unique_key_words);
+}
+
+ProjectedRow *BulkLoader::StageRow() {
+  redo_ = txn_->StageWrite(db_oid_, table_oid_, initializer_);
+  return redo_->Delta();
+}
+
+bool BulkLoader::InsertRow() {
+  NOISEPAGE_ASSERT(redo_ != nullptr, "No row was staged.");
+  const TupleSlot slot = table_->Insert(txn_, redo_);
+  num_rows_++;
+
+  for (auto &index_keys : indexes_) {
+    if (index_keys.unique_) {
+      if (!index_keys.index_->InsertUnique(txn_, *BuildKey(index_keys, unique_key_.data()), slot)) return false;
+      continue;
+    }
+    const std::size_t key_start = index_keys.keys_.size();
+    index_keys.keys_.resize(key_start + index_keys.key_words_);
+    BuildKey(index_keys, index_keys.keys_.data() + key_start);
+    index_keys.slots_.emplace_back(slot);
+    if (index_keys.slots_.size() == INDEX_BATCH_SIZE) FlushIndex(&index_keys);
+  }
+  return true;
+}
+
+void BulkLoader::Flush() {
+  for (auto &index_keys : indexes_) {
+    if (!index_keys.slots_.empty()) FlushIndex(&index_keys);
+  }
+}
+
+ProjectedRow *BulkLoader::BuildKey(const IndexKeys &index_keys, uint64_t *const dest) const {
+  // Copy the values of the row into the key, the same way the online index builder builds keys
+  ProjectedRow *const key =
+      index_keys.index_->GetProjectedRowInitializer().InitializeRow(reinterpret_cast<byte *>(dest));
+  const ProjectedRow &row = *redo_->Delta();
+  for (const auto &column : index_keys.columns_) {
+    const byte *const value = row.AccessWithNullCheck(column.row_offset_);
+    if (value == nullptr) {
+      key->SetNull(column.key_offset_);
+    } else {
+      std::memcpy(key->AccessForceNotNull(column.key_offset_), value, column.size_);
+    }
+  }
+  return key;
+}
+
+void BulkLoader::FlushIndex(IndexKeys *const index_keys) {
+  // The keys are only addressed once the batch is complete, since the buffer moves as it grows
+  std::vector<std::pair<const ProjectedRow *, TupleSlot>> entries;
+  entries.reserve(index_keys->slots_.size());
+  for (std::size_t i = 0; i < index_keys->slots_.size(); i++) {
+    entries.emplace_back(reinterpret_cast<const ProjectedRow *>(index_keys->keys_.data() + i * index_keys->key_words_),
+                         index_keys->slots_[i]);
+  }
+  index_keys->index_->InsertBatch(txn_, entries);
+  index_keys->keys_.clear();
+  index_keys->slots_.clear();
+}
+
+}  // namespace noisepage::storage
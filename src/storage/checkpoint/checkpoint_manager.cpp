@@ -0,0 +1,234 @@
+#include "storage/checkpoint/checkpoint_manager.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/catalog.h"
+#include "catalog/database_catalog.h"
+#include "loggers/storage_logger.h"
+#include "storage/sql_table.h"
+#include "storage/varlen_compression.h"
+#include "storage/write_ahead_log/log_io.h"
+#include "storage/write_ahead_log/log_record.h"
+#include "transaction/transaction_context.h"
+#include "transaction/transaction_manager.h"
+
+namespace noisepage::storage {
+
+namespace {
+constexpr const char *CHECKPOINT_DIR_PREFIX = "checkpoint_";
+}  // namespace
+
+std::string CheckpointManager::CheckpointDirectory(const std::string &checkpoint_root,
+                                                   const transaction::timestamp_t timestamp) {
+  return checkpoint_root + "/" + CHECKPOINT_DIR_PREFIX + std::to_string(timestamp.UnderlyingValue());
+}
+
+CheckpointManager::CheckpointManager(std::string checkpoint_root,
+                                     const common::ManagedPointer<transaction::TransactionManager> txn_manager,
+                                     const common::ManagedPointer<catalog::Catalog> catalog)
+    : checkpoint_root_(std::move(checkpoint_root)), txn_manager_(txn_manager), catalog_(catalog) {
+  std::filesystem::create_directories(checkpoint_root_);
+}
+
+transaction::timestamp_t CheckpointManager::TakeCheckpoint() {
+  // The snapshot transaction defines the checkpoint. Everything that committed before it started is in the checkpoint.
+  auto *txn = txn_manager_->BeginTransaction(true);
+  const auto common_txn = common::ManagedPointer(txn);
+  const auto timestamp = txn->StartTime();
+  const auto checkpoint_dir = CheckpointDirectory(checkpoint_root_, timestamp);
+  std::filesystem::create_directories(checkpoint_dir);
+
+  std::vector<std::pair<catalog::db_oid_t, catalog::table_oid_t>> tables;
+  uint64_t num_tuples = 0;
+  for (const auto db_oid : catalog_->GetDatabaseOids(common_txn)) {
+    auto db_catalog = catalog_->GetDatabaseCatalog(common_txn, db_oid);
+    for (const auto table_oid : db_catalog->GetTableOids(common_txn)) {
+      // Catalog tables are rebuilt from the WAL on recovery.
+      if (table_oid.UnderlyingValue() < catalog::START_OID) continue;
+      auto table = db_catalog->GetTable(common_txn, table_oid);
+      if (table == nullptr) continue;
+      const auto file_path = checkpoint_dir + "/" + TableFileName(db_oid, table_oid);
+      num_tuples += CheckpointTable(common_txn, db_oid, table_oid, table, file_path);
+      tables.emplace_back(db_oid, table_oid);
+    }
+  }
+
+  // The snapshot transaction is read-only, so committing it has no side effects.
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  WriteManifest(checkpoint_dir, timestamp, tables);
+  STORAGE_LOG_INFO("Checkpoint {} completed: {} tables, {} tuples", timestamp.UnderlyingValue(), tables.size(),
+                   num_tuples);
+  return timestamp;
+}
+
+void CheckpointManager::WriteManifest(const std::string &checkpoint_dir, const transaction::timestamp_t timestamp,
+                                      const std::vector<std::pair<catalog::db_oid_t, catalog::table_oid_t>> &tables) {
+  // Write the manifest last and rename it into place, so that a crash never leaves behind an incomplete checkpoint that
+  // looks complete.
+  const auto manifest_path = checkpoint_dir + "/" + MANIFEST_FILE_NAME;
+  const auto temp_manifest_path = manifest_path + ".tmp";
+  {
+    std::ofstream manifest(temp_manifest_path, std::ios::trunc);
+    manifest << timestamp.UnderlyingValue() << "\n";
+    for (const auto &table : tables) {
+      manifest << table.first.UnderlyingValue() << " " << table.second.UnderlyingValue() << "\n";
+    }
+    manifest.flush();
+    if (!manifest.good()) throw std::runtime_error("Failed to write checkpoint manifest " + temp_manifest_path);
+  }
+  std::filesystem::rename(temp_manifest_path, manifest_path);
+}
+
+void CheckpointManager::PurgeOldCheckpoints() const {
+  const auto latest = GetLatestCheckpoint(checkpoint_root_);
+  if (!latest.has_value()) return;
+
+  const std::string prefix = CHECKPOINT_DIR_PREFIX;
+  for (const auto &entry : std::filesystem::directory_iterator(checkpoint_root_)) {
+    const auto name = entry.path().filename().string();
+    if (!entry.is_directory() || name.rfind(prefix, 0) != 0) continue;
+    if (std::stoull(name.substr(prefix.size())) < latest->timestamp_.UnderlyingValue()) {
+      std::filesystem::remove_all(entry.path());
+    }
+  }
+}
+
+std::optional<CheckpointInfo> CheckpointManager::GetLatestCheckpoint(const std::string &checkpoint_root) {
+  if (!std::filesystem::is_directory(checkpoint_root)) return std::nullopt;
+
+  std::optional<CheckpointInfo> latest = std::nullopt;
+  const std::string prefix = CHECKPOINT_DIR_PREFIX;
+  for (const auto &entry : std::filesystem::directory_iterator(checkpoint_root)) {
+    const auto name = entry.path().filename().string();
+    if (!entry.is_directory() || name.rfind(prefix, 0) != 0) continue;
+
+    // A checkpoint without a manifest was interrupted and is ignored.
+    std::ifstream manifest(entry.path() / MANIFEST_FILE_NAME);
+    if (!manifest.is_open()) continue;
+
+    uint64_t timestamp;
+    if (!(manifest >> timestamp)) continue;
+    if (latest.has_value() && latest->timestamp_.UnderlyingValue() >= timestamp) continue;
+
+    CheckpointInfo info{transaction::timestamp_t(timestamp), entry.path().string(), {}};
+    uint32_t db_oid, table_oid;
+    while (manifest >> db_oid >> table_oid) {
+      info.tables_.emplace_back(catalog::db_oid_t(db_oid), catalog::table_oid_t(table_oid));
+    }
+    latest = std::move(info);
+  }
+  return latest;
+}
+
+std::string CheckpointManager::TableFileName(const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid) {
+  return std::to_string(db_oid.UnderlyingValue()) + "_" + std::to_string(table_oid.UnderlyingValue()) + ".ckpt";
+}
+
+uint64_t CheckpointManager::CheckpointTable(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                            const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid,
+                                            const common::ManagedPointer<SqlTable> table,
+                                            const std::string &file_path) {
+  std::vector<catalog::col_oid_t> col_oids;
+  col_oids.reserve(table->GetColumnMap().size());
+  for (const auto &column : table->GetColumnMap()) col_oids.emplace_back(column.first);
+
+  // The in-memory size of a REDO record for a full row, which is what recovery allocates for each record.
+  const auto record_size = RedoRecord::Size(table->InitializerForProjectedRow(col_oids));
+
+  // Scan one block's worth of tuples at a time.
+  const auto pci = table->InitializerForProjectedColumns(col_oids, table->table_.layout_.NumSlots());
+  auto *buffer = common::AllocationUtil::AllocateAligned(pci.ProjectedColumnsSize());
+  auto *columns = pci.Initialize(buffer);
+
+  BufferedLogWriter out(file_path.c_str());
+  std::vector<byte> compression_buffer;
+  uint64_t num_tuples = 0;
+  auto it = table->begin();
+  while (it != table->end()) {
+    table->Scan(txn, &it, columns);
+    for (uint32_t i = 0; i < columns->NumTuples(); i++) {
+      SerializeTuple(&out, txn->StartTime(), db_oid, table_oid, record_size, columns->TupleSlots()[i],
+                     columns->InterpretAsRow(i), &compression_buffer);
+    }
+    num_tuples += columns->NumTuples();
+  }
+  out.FlushBuffer();
+  out.Persist();
+  out.Close();
+
+  delete[] buffer;
+  return num_tuples;
+}
+
+void CheckpointManager::SerializeTuple(BufferedLogWriter *const out, const transaction::timestamp_t timestamp,
+                                       const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid,
+                                       const uint32_t record_size, const TupleSlot slot,
+                                       const ProjectedColumns::RowView &row,
+                                       std::vector<byte> *const compression_buffer) {
+  const auto &block_layout = slot.GetBlock()->data_table_->GetBlockLayout();
+
+  WriteValue(out, record_size);
+  WriteValue(out, LogRecordType::REDO);
+  WriteValue(out, timestamp);
+  WriteValue(out, db_oid);
+  WriteValue(out, table_oid);
+  // The original tuple slot lets recovery map WAL records that were written after the checkpoint onto the new slot.
+  WriteValue(out, slot);
+
+  const auto num_cols = row.NumColumns();
+  WriteValue(out, num_cols);
+  WriteValue(out, row.ColumnIds(), static_cast<uint32_t>(sizeof(col_id_t)) * num_cols);
+
+  uint16_t boundaries[NUM_ATTR_BOUNDARIES];
+  memset(boundaries, 0, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
+  StorageUtil::ComputeAttributeSizeBoundaries(block_layout, row.ColumnIds(), num_cols, boundaries);
+  WriteValue(out, boundaries, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
+
+  // A RowView does not have a contiguous null bitmap like a ProjectedRow, so build one.
+  std::vector<uint8_t> bitmap_bytes(common::RawBitmap::SizeInBytes(num_cols), 0);
+  auto *bitmap = reinterpret_cast<common::RawBitmap *>(bitmap_bytes.data());
+  for (uint16_t i = 0; i < num_cols; i++) {
+    if (!row.IsNull(i)) bitmap->Set(i, true);
+  }
+  WriteValue(out, bitmap_bytes.data(), static_cast<uint32_t>(bitmap_bytes.size()));
+
+  for (uint16_t i = 0; i < num_cols; i++) {
+    const auto *column_value_address = row.AccessWithNullCheck(i);
+    if (column_value_address == nullptr) continue;
+    const col_id_t col_id = row.ColumnIds()[i];
+    if (block_layout.IsVarlen(col_id)) {
+      const auto *varlen_entry = reinterpret_cast<const VarlenEntry *>(column_value_address);
+      const uint32_t compressed_size =
+          VarlenCompression::ShouldCompress(varlen_entry->Size())
+              ? VarlenCompression::Compress(varlen_entry->Content(), varlen_entry->Size(), compression_buffer)
+              : 0;
+      if (compressed_size != 0) {
+        WriteValue(out, varlen_entry->Size() | VarlenCompression::COMPRESSED_FLAG);
+        WriteValue(out, compressed_size);
+        WriteValue(out, compression_buffer->data(), compressed_size);
+        continue;
+      }
+      WriteValue(out, varlen_entry->Size());
+      WriteValue(out, varlen_entry->IsInlined() ? varlen_entry->Prefix() : varlen_entry->Content(),
+                 varlen_entry->Size());
+    } else {
+      WriteValue(out, column_value_address, block_layout.AttrSize(col_id));
+    }
+  }
+}
+
+void CheckpointManager::WriteValue(BufferedLogWriter *const out, const void *const val, const uint32_t size) {
+  uint32_t size_written = 0;
+  while (size_written < size) {
+    const byte *val_byte = reinterpret_cast<const byte *>(val) + size_written;
+    size_written += out->BufferWrite(val_byte, size - size_written);
+    if (out->IsBufferFull()) out->FlushBuffer();
+  }
+}
+
+}  // namespace noisepage::storage
@@ -0,0 +1,189 @@
+#include "storage/column_encoding.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <utility>
+
+#include "common/allocator.h"
+#include "storage/arrow_block_metadata.h"
+
+namespace noisepage::storage {
+
+namespace {
+
+constexpr uint32_t BITS_PER_WORD = 64;
+
+// Unpacks the GROUP_SIZE distances of a group, which takes up BITS words. The number of bits is a constant, so that the
+// shifts and masks of every value are known at compile time and the loop is unrolled and vectorized.
+template <uint32_t BITS>
+void UnpackGroup(const uint64_t *const in, uint64_t *const out) {
+  if constexpr (BITS == 0) {
+    std::fill_n(out, EncodedColumn::GROUP_SIZE, 0);
+  } else {
+    constexpr uint64_t mask = BITS == BITS_PER_WORD ? ~uint64_t{0} : (uint64_t{1} << BITS) - 1;
+    for (uint32_t i = 0; i < EncodedColumn::GROUP_SIZE; i++) {
+      const uint32_t bit = i * BITS;
+      const uint32_t word = bit / BITS_PER_WORD;
+      const uint32_t shift = bit % BITS_PER_WORD;
+      uint64_t value = in[word] >> shift;
+      // The value is split across two words
+      if (shift + BITS > BITS_PER_WORD) value |= in[word + 1] << (BITS_PER_WORD - shift);
+      out[i] = value & mask;
+    }
+  }
+}
+
+using UnpackFn = void (*)(const uint64_t *, uint64_t *);
+
+template <std::size_t... BITS>
+constexpr std::array<UnpackFn, sizeof...(BITS)> MakeUnpackers(std::index_sequence<BITS...> /*unused*/) {
+  return {{&UnpackGroup<BITS>...}};
+}
+
+// One unpacking routine for every bit width from 0 to 64
+constexpr std::array<UnpackFn, BITS_PER_WORD + 1> UNPACKERS =
+    MakeUnpackers(std::make_index_sequence<BITS_PER_WORD + 1>());
+
+uint8_t BitsNeeded(const uint64_t range) {
+  return range == 0 ? 0 : static_cast<uint8_t>(BITS_PER_WORD - __builtin_clzll(range));
+}
+
+uint64_t NumGroups(const uint32_t num_values) {
+  return (num_values + EncodedColumn::GROUP_SIZE - 1) / EncodedColumn::GROUP_SIZE;
+}
+
+}  // namespace
+
+EncodedColumn EncodedColumn::Encode(const byte *const values, const uint8_t size,
+                                    const common::RawConcurrentBitmap *const present, const uint32_t num_values,
+                                    const int64_t min, const int64_t max) {
+  EncodedColumn result;
+  result.num_values_ = num_values;
+  if (num_values == 0) return result;
+
+  // A column without present values decodes to the reference value, and so does every null slot
+  const int64_t reference = min <= max ? min : 0;
+  const uint64_t range = min <= max ? static_cast<uint64_t>(max) - static_cast<uint64_t>(min) : 0;
+  const uint8_t bit_width = BitsNeeded(range);
+  const uint64_t for_size = NumGroups(num_values) * bit_width * sizeof(uint64_t);
+
+  // Null slots continue the run before them, so that they never start a run of their own
+  uint32_t num_runs = 0;
+  int64_t run_value = reference;
+  for (uint32_t i = 0; i < num_values; i++) {
+    if (!present->Test(i)) {
+      if (i == 0) num_runs++;
+      continue;
+    }
+    const int64_t value = ColumnZone::Read(values + i * size, size);
+    if (i == 0 || value != run_value) num_runs++;
+    run_value = value;
+  }
+  const uint64_t rle_size = RunValuesOffset(num_runs) + static_cast<uint64_t>(num_runs) * sizeof(int64_t);
+
+  const uint64_t plain_size = static_cast<uint64_t>(num_values) * size;
+  if (std::min(for_size, rle_size) >= plain_size) return result;
+
+  if (for_size <= rle_size) {
+    // Frame-of-reference decodes with fewer branches, so it wins ties
+    result.encoding_ = ColumnEncoding::FRAME_OF_REFERENCE;
+    result.bit_width_ = bit_width;
+    result.reference_ = reference;
+    if (bit_width == 0) return result;
+    result.data_ = common::AllocationUtil::AllocateAligned(for_size);
+    auto *const words = reinterpret_cast<uint64_t *>(result.data_);
+    std::memset(words, 0, for_size);
+    // Groups are laid out back to back, so the bit position of a value does not depend on its group
+    for (uint32_t i = 0; i < num_values; i++) {
+      if (!present->Test(i)) continue;
+      const uint64_t delta =
+          static_cast<uint64_t>(ColumnZone::Read(values + i * size, size)) - static_cast<uint64_t>(reference);
+      const uint64_t bit = static_cast<uint64_t>(i) * bit_width;
+      const uint64_t word = bit / BITS_PER_WORD;
+      const uint32_t shift = bit % BITS_PER_WORD;
+      words[word] |= delta << shift;
+      if (shift + bit_width > BITS_PER_WORD) words[word + 1] |= delta >> (BITS_PER_WORD - shift);
+    }
+    return result;
+  }
+
+  result.encoding_ = ColumnEncoding::RUN_LENGTH;
+  result.num_runs_ = num_runs;
+  result.data_ = common::AllocationUtil::AllocateAligned(rle_size);
+  auto *const run_ends = reinterpret_cast<uint32_t *>(result.data_);
+  auto *const run_values = reinterpret_cast<int64_t *>(result.data_ + RunValuesOffset(num_runs));
+  uint32_t run = 0;
+  run_values[0] = reference;
+  for (uint32_t i = 0; i < num_values; i++) {
+    if (!present->Test(i)) continue;
+    const int64_t value = ColumnZone::Read(values + i * size, size);
+    if (i != 0 && value != run_values[run]) {
+      run_ends[run] = i;
+      run++;
+    }
+    run_values[run] = value;
+  }
+  run_ends[run] = num_values;
+  NOISEPAGE_ASSERT(run + 1 == num_runs, "the runs should be counted the same way they are written");
+  return result;
+}
+
+void EncodedColumn::Decode(const uint32_t begin, const uint32_t count, const uint8_t size, byte *const out) const {
+  NOISEPAGE_ASSERT(encoding_ != ColumnEncoding::PLAIN, "a plain column has nothing to decode");
+  NOISEPAGE_ASSERT(begin % GROUP_SIZE == 0, "decoding has to start at a group");
+  NOISEPAGE_ASSERT(begin + count <= num_values_, "decoding past the end of the column");
+  switch (size) {
+    case 1:
+      DecodeValues(begin, count, reinterpret_cast<int8_t *>(out));
+      break;
+    case 2:
+      DecodeValues(begin, count, reinterpret_cast<int16_t *>(out));
+      break;
+    case 4:
+      DecodeValues(begin, count, reinterpret_cast<int32_t *>(out));
+      break;
+    default:
+      DecodeValues(begin, count, reinterpret_cast<int64_t *>(out));
+      break;
+  }
+}
+
+template <typename T>
+void EncodedColumn::DecodeValues(const uint32_t begin, const uint32_t count, T *const out) const {
+  if (encoding_ == ColumnEncoding::FRAME_OF_REFERENCE) {
+    const UnpackFn unpack = UNPACKERS[bit_width_];
+    const auto *const words = reinterpret_cast<const uint64_t *>(data_);
+    const auto reference = static_cast<uint64_t>(reference_);
+    uint64_t deltas[GROUP_SIZE];
+    for (uint32_t decoded = 0; decoded < count; decoded += GROUP_SIZE) {
+      // A column of a bit width of 0 has no buffer
+      unpack(words + static_cast<uint64_t>(begin + decoded) / GROUP_SIZE * bit_width_, deltas);
+      const uint32_t num = std::min(GROUP_SIZE, count - decoded);
+      for (uint32_t i = 0; i < num; i++) out[decoded + i] = static_cast<T>(reference + deltas[i]);
+    }
+    return;
+  }
+
+  const uint32_t *const run_ends = RunEnds();
+  const int64_t *const run_values = RunValues();
+  uint32_t run = static_cast<uint32_t>(std::upper_bound(run_ends, run_ends + num_runs_, begin) - run_ends);
+  for (uint32_t pos = begin; pos < begin + count; run++) {
+    const uint32_t run_end = std::min(run_ends[run], begin + count);
+    std::fill(out + (pos - begin), out + (run_end - begin), static_cast<T>(run_values[run]));
+    pos = run_end;
+  }
+}
+
+uint64_t EncodedColumn::EncodedSize() const {
+  switch (encoding_) {
+    case ColumnEncoding::FRAME_OF_REFERENCE:
+      return NumGroups(num_values_) * bit_width_ * sizeof(uint64_t);
+    case ColumnEncoding::RUN_LENGTH:
+      return RunValuesOffset(num_runs_) + static_cast<uint64_t>(num_runs_) * sizeof(int64_t);
+    default:
+      return 0;
+  }
+}
+
+}  // namespace noisepage::storage
@@ -1,11 +1,21 @@
 #include "storage/data_table.h"
 
+#include <emmintrin.h>
+
+#include <algorithm>
 #include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include "common/allocator.h"
+#include "execution/sql/tuple_id_list.h"
 #include "execution/sql/vector_projection.h"
+#include "execution/util/memory.h"
 #include "storage/block_access_controller.h"
+#include "storage/block_buffer_manager.h"
 #include "storage/storage_util.h"
+#include "transaction/ssi_manager.h"
 #include "transaction/transaction_context.h"
 #include "transaction/transaction_util.h"
 
@@ -13,66 +23,254 @@ namespace noisepage::storage {
 
 DataTable::DataTable(common::ManagedPointer<BlockStore> store, const BlockLayout &layout,
                      const layout_version_t layout_version)
-    : accessor_(layout), block_store_(store), layout_version_(layout_version) {
+    : accessor_(layout), block_store_(store), layout_version_(layout_version), free_space_map_(layout.NumSlots()) {
   NOISEPAGE_ASSERT(layout.AttrSize(VERSION_POINTER_COLUMN_ID) == 8,
                    "First column must have size 8 for the version chain.");
   NOISEPAGE_ASSERT(layout.NumColumns() > NUM_RESERVED_COLUMNS,
                    "First column is reserved for version info, second column is reserved for logical delete.");
-  if (store != DISABLED) {
-    blocks_.push_back(NewBlock());
-    blocks_size_++;
-  }
+  if (store != DISABLED) AppendBlock(NewBlock());
 }
 
 DataTable::~DataTable() {
-  common::SharedLatch::ScopedExclusiveLatch latch(&blocks_latch_);
-  for (auto block : blocks_) {
+  if (buffer_manager_ != nullptr) buffer_manager_->UnregisterTable(this);
+  for (uint64_t i = 0; i < blocks_size_; i++) {
+    RawBlock *const block = blocks_[i];
     StorageUtil::DeallocateVarlens(block, accessor_);
-    for (col_id_t i : accessor_.GetBlockLayout().Varlens())
+    // Fixed-length columns may hold an encoded copy of their values too
+    for (col_id_t i : accessor_.GetBlockLayout().AllColumns())
       accessor_.GetArrowBlockMetadata(block).GetColumnInfo(accessor_.GetBlockLayout(), i).Deallocate();
     block_store_.operator->()->Release(block);
   }
 }
 
+void DataTable::FaultIn(RawBlock *const block) const { buffer_manager_->Fault(block); }
+
 bool DataTable::Select(const common::ManagedPointer<transaction::TransactionContext> txn, TupleSlot slot,
                        ProjectedRow *out_buffer) const {
   return SelectIntoBuffer(txn, slot, out_buffer);
 }
 
+void DataTable::SelectBatch(const common::ManagedPointer<transaction::TransactionContext> txn,
+                            const TupleSlot *const slots, execution::sql::VectorProjection *const out_buffer,
+                            execution::sql::TupleIdList *const tids) const {
+  NOISEPAGE_ASSERT(tids->GetCapacity() <= out_buffer->GetTupleCapacity(), "The output buffer cannot hold all rows.");
+  out_buffer->Reset(tids->GetCapacity());
+
+  // Index lookups usually hit tuples all over the table, so every version pointer is a cache miss. Issuing them all
+  // up front lets them overlap instead of paying for them one after the other. Runs of slots from the same block,
+  // as returned by range scans on clustered keys, only need to check the SIREAD lock once.
+  const RawBlock *locked_block = nullptr;
+  tids->ForEach([&](const uint32_t tid) {
+    const TupleSlot slot = slots[tid];
+    execution::util::Memory::Prefetch<true, execution::Locality::Low>(
+        accessor_.AccessWithoutNullCheck(slot, VERSION_POINTER_COLUMN_ID));
+    if (txn->IsSerializable() && slot.GetBlock() != locked_block) {
+      txn->GetSsiManager()->RegisterRead(txn.Get(), slot.GetBlock());
+      locked_block = slot.GetBlock();
+    }
+  });
+
+  tids->Filter([&](const uint32_t tid) {
+    execution::sql::VectorProjection::RowView row = out_buffer->InterpretAsRow(tid);
+    row.SetTupleSlot(slots[tid]);
+    return SelectIntoBuffer(txn, slots[tid], &row, false);
+  });
+  out_buffer->SetFilteredSelections(*tids);
+}
+
+template <class ReadSlot>
+uint32_t DataTable::ScanBlock(const common::ManagedPointer<transaction::TransactionContext> txn,
+                              SlotIterator *const pos, const uint32_t num_rows, ReadSlot read_slot) const {
+  RawBlock *const block = pos->current_slot_.GetBlock();
+  // A scan is counted once it enters a block
+  if (pos->slot_num_ == 0) RecordScan(block);
+  MakeResident(block);
+  if (txn->IsSerializable()) txn->GetSsiManager()->RegisterRead(txn.Get(), block);
+  // The header of the next block is needed as soon as this one is done
+  if (pos->block_index_ + 1 < pos->end_index_) {
+    RawBlock *const next = blocks_[pos->block_index_ + 1];
+    execution::util::Memory::Prefetch<true, execution::Locality::Low>(next);
+    execution::util::Memory::Prefetch<true, execution::Locality::Low>(accessor_.AllocationBitmap(next));
+  }
+
+  const common::RawConcurrentBitmap *const allocation_bitmap = accessor_.AllocationBitmap(block);
+  const auto *const version_ptrs =
+      reinterpret_cast<const std::atomic<UndoRecord *> *>(accessor_.ColumnStart(block, VERSION_POINTER_COLUMN_ID));
+  constexpr uint32_t word_size = 64;
+  uint32_t slot_num = pos->slot_num_;
+  uint32_t num_read = 0;
+  while (slot_num < pos->max_slot_num_ && num_read < num_rows) {
+    // The allocated slots among the ones left in the current word of the allocation bitmap
+    const uint32_t word_end = std::min(pos->max_slot_num_, (slot_num / word_size + 1) * word_size);
+    uint64_t allocated = allocation_bitmap->Word(slot_num / word_size) >> (slot_num % word_size);
+    if (word_end - slot_num < word_size) allocated &= (uint64_t{1} << (word_end - slot_num)) - 1;
+
+    // Only tuples with versions have undo records to look at, which are all over the memory. Issuing their loads up
+    // front lets them overlap.
+    for (uint64_t bits = allocated; bits != 0; bits &= bits - 1) {
+      const UndoRecord *const version_ptr =
+          version_ptrs[slot_num + __builtin_ctzll(bits)].load(std::memory_order_relaxed);
+      if (version_ptr != nullptr) execution::util::Memory::Prefetch<true, execution::Locality::Low>(version_ptr);
+    }
+
+    uint32_t next_slot = word_end;
+    for (; allocated != 0; allocated &= allocated - 1) {
+      const uint32_t offset = slot_num + __builtin_ctzll(allocated);
+      if (read_slot(TupleSlot(block, offset)) && ++num_read == num_rows) {
+        next_slot = offset + 1;
+        break;
+      }
+    }
+    slot_num = next_slot;
+  }
+
+  if (slot_num < pos->max_slot_num_) {
+    pos->slot_num_ = slot_num;
+    pos->current_slot_ = {block, slot_num};
+  } else {
+    pos->block_index_++;
+    pos->UpdateFromNextBlock();
+  }
+  return num_read;
+}
+
 void DataTable::Scan(const common::ManagedPointer<transaction::TransactionContext> txn, SlotIterator *const start_pos,
                      ProjectedColumns *const out_buffer) const {
-  // TODO(Tianyu): So far this is not that much better than tuple-at-a-time access,
-  // but can be improved if block is read-only, or if we implement version synopsis, to just use std::memcpy when it's
-  // safe
+  // Blocks are read a word of their allocation bitmap at a time, which skips over empty slots without looking at them
   uint32_t filled = 0;
-  while (filled < out_buffer->MaxTuples() && *start_pos != end()) {
+  auto read_slot = [&](const TupleSlot slot) {
     ProjectedColumns::RowView row = out_buffer->InterpretAsRow(filled);
-    const TupleSlot slot = **start_pos;
-    // Only fill the buffer with valid, visible tuples
-    if (SelectIntoBuffer(txn, slot, &row)) {
-      out_buffer->TupleSlots()[filled] = slot;
-      filled++;
-    }
-    ++(*start_pos);
-  }
+    // Only fill the buffer with visible tuples
+    if (!SelectAllocatedIntoBuffer(txn, slot, &row)) return false;
+    out_buffer->TupleSlots()[filled++] = slot;
+    return true;
+  };
+  while (filled < out_buffer->MaxTuples() && *start_pos != end())
+    ScanBlock(txn, start_pos, out_buffer->MaxTuples() - filled, read_slot);
   out_buffer->SetNumTuples(filled);
 }
 
 void DataTable::Scan(const common::ManagedPointer<transaction::TransactionContext> txn, SlotIterator *const start_pos,
-                     execution::sql::VectorProjection *const out_buffer) const {
+                     execution::sql::VectorProjection *const out_buffer,
+                     const std::vector<uint16_t> *const col_idxs) const {
+  std::vector<col_id_t> col_ids;
+  if (col_idxs != nullptr) {
+    for (const auto col_idx : *col_idxs) col_ids.push_back(out_buffer->ColumnIds()[col_idx]);
+  }
   uint32_t filled = 0;
+  auto read_slot = [&](const TupleSlot slot) {
+    execution::sql::VectorProjection::RowView row = col_idxs == nullptr
+                                                        ? out_buffer->InterpretAsRow(filled)
+                                                        : out_buffer->InterpretAsRow(filled, col_idxs, &col_ids);
+    // Only fill the buffer with visible tuples
+    if (!SelectAllocatedIntoBuffer(txn, slot, &row)) return false;
+    row.SetTupleSlot(slot);
+    filled++;
+    return true;
+  };
   while (filled < out_buffer->GetTupleCapacity() && *start_pos != end() &&
-         **start_pos != SlotIterator::InvalidTupleSlot()) {
-    execution::sql::VectorProjection::RowView row = out_buffer->InterpretAsRow(filled);
-    const TupleSlot slot = **start_pos;
-    // Only fill the buffer with valid, visible tuples
-    if (SelectIntoBuffer(txn, slot, &row)) {
-      row.SetTupleSlot(slot);
-      filled++;
+         **start_pos != SlotIterator::InvalidTupleSlot())
+    ScanBlock(txn, start_pos, out_buffer->GetTupleCapacity() - filled, read_slot);
+  out_buffer->Reset(filled);
+}
+
+void DataTable::SelectColumns(const common::ManagedPointer<transaction::TransactionContext> txn,
+                              execution::sql::VectorProjection *const out_buffer,
+                              const std::vector<uint16_t> &col_idxs) const {
+  if (col_idxs.empty()) return;
+  std::vector<col_id_t> col_ids;
+  for (const auto col_idx : col_idxs) col_ids.push_back(out_buffer->ColumnIds()[col_idx]);
+
+  // The tuples were found visible by the Scan, and the SIREAD locks of their blocks were taken then
+  auto read_row = [&](const uint32_t row_offset) {
+    execution::sql::VectorProjection::RowView row = out_buffer->InterpretAsRow(row_offset, &col_idxs, &col_ids);
+    SelectIntoBuffer(txn, out_buffer->GetTupleSlot(row_offset), &row, false);
+  };
+  if (out_buffer->IsFiltered()) {
+    out_buffer->GetFilteredTupleIdList()->ForEach(read_row);
+  } else {
+    for (uint32_t row_offset = 0; row_offset < out_buffer->GetTotalTupleCount(); row_offset++) read_row(row_offset);
+  }
+}
+
+RawBlock *DataTable::ScanInPlace(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                 SlotIterator *const start_pos,
+                                 execution::sql::VectorProjection *const out_buffer) const {
+  // A writer to a block waits for its in-place readers, so a transaction that holds an in-place read could wait for
+  // itself when it writes to the tuples it just read
+  if (!txn->IsDeclaredReadOnly() || *start_pos == end()) return nullptr;
+  const TupleSlot first = **start_pos;
+  RawBlock *const block = first.GetBlock();
+  // The null masks of the vectors are built from the presence bitmaps of the block a word at a time
+  if (block == nullptr || first.GetOffset() % 64 != 0) return nullptr;
+  // Vectors can only reference values that are stored contiguously
+  const BlockLayout &layout = accessor_.GetBlockLayout();
+  for (uint32_t i = 0; i < out_buffer->GetColumnCount(); i++) {
+    const col_id_t col_id = out_buffer->ColumnIds()[i];
+    const auto type_size = execution::sql::GetTypeIdSize(out_buffer->GetColumn(i)->GetTypeId());
+    if (type_size != layout.AttrSize(col_id) || !layout.IsColumnar(col_id)) return nullptr;
+  }
+  MakeResident(block);
+  if (!block->controller_.TryAcquireInPlaceRead()) return nullptr;
+
+  // A frozen block has no versions and no gaps, so all of its tuples are visible to every transaction
+  const uint32_t begin = first.GetOffset();
+  const uint32_t num_records = accessor_.GetArrowBlockMetadata(block).NumRecords();
+  if (begin >= num_records) {
+    block->controller_.ReleaseInPlaceRead();
+    start_pos->block_index_++;
+    start_pos->UpdateFromNextBlock();
+    return nullptr;
+  }
+  if (txn->IsSerializable()) txn->GetSsiManager()->RegisterRead(txn.Get(), block);
+  if (begin == 0) RecordScan(block);
+  const auto num_tuples =
+      static_cast<uint32_t>(std::min<uint64_t>(num_records - begin, out_buffer->GetTupleCapacity()));
+
+  out_buffer->Reset(num_tuples);
+  for (uint32_t i = 0; i < out_buffer->GetColumnCount(); i++) {
+    const col_id_t col_id = out_buffer->ColumnIds()[i];
+    execution::sql::Vector *const column = out_buffer->GetColumn(i);
+    byte *values = accessor_.ColumnStart(block, col_id) + begin * layout.AttrSize(col_id);
+    // An encoded column is decoded into the vector's own chunk of the projection, which reads less of the block
+    if (!layout.IsVarlen(col_id) && out_buffer->OwnsData() && num_tuples <= common::Constants::K_DEFAULT_VECTOR_SIZE) {
+      const EncodedColumn &encoded = accessor_.GetArrowBlockMetadata(block).GetColumnInfo(layout, col_id).Encoded();
+      if (encoded.Encoding() != ColumnEncoding::PLAIN) {
+        encoded.Decode(begin, num_tuples, layout.AttrSize(col_id), column->GetData());
+        values = column->GetData();
+      }
+    }
+    column->Reference(values, nullptr, num_tuples);
+    // The block marks the values that are present, the vector those that are null. The bitmap is followed by the
+    // values of the column, so reading whole words past its end stays within the block.
+    const auto *const bitmap = reinterpret_cast<const byte *>(accessor_.ColumnNullBitmap(block, col_id));
+    const byte *const present = bitmap + begin / common::Constants::K_BITS_PER_BYTE;
+    execution::sql::Vector::NullMask *const nulls = column->GetMutableNullMask();
+    for (uint32_t w = 0; w < nulls->GetNumWords(); w++) {
+      uint64_t word;
+      std::memcpy(&word, present + w * sizeof(uint64_t), sizeof(uint64_t));
+      nulls->SetWord(w, ~word);
+    }
+    // Strings of a dictionary-compressed column also come with their codes, for operations on the distinct values
+    if (layout.IsVarlen(col_id)) {
+      ArrowColumnInfo &col_info = accessor_.GetArrowBlockMetadata(block).GetColumnInfo(layout, col_id);
+      if (col_info.Type() == ArrowColumnType::DICTIONARY_COMPRESSED) {
+        column->SetDictionary(col_info.Indices() + begin, col_info.Dictionary(),
+                              col_info.VarlenColumn().OffsetsLength() - 1);
+      }
     }
-    ++(*start_pos);
   }
-  out_buffer->Reset(filled);
+  for (uint32_t i = 0; i < num_tuples; i++) out_buffer->SetTupleSlot({block, begin + i}, i);
+
+  // Slots past the last record of a frozen block are empty
+  if (begin + num_tuples == num_records) {
+    start_pos->block_index_++;
+    start_pos->UpdateFromNextBlock();
+  } else {
+    start_pos->slot_num_ = begin + num_tuples;
+    start_pos->current_slot_ = {block, start_pos->slot_num_};
+  }
+  return block;
 }
 
 bool DataTable::Update(const common::ManagedPointer<transaction::TransactionContext> txn, const TupleSlot slot,
@@ -80,8 +278,10 @@ bool DataTable::Update(const common::ManagedPointer<transaction::TransactionCont
   NOISEPAGE_ASSERT(redo.NumColumns() <= accessor_.GetBlockLayout().NumColumns() - NUM_RESERVED_COLUMNS,
                    "The input buffer cannot change the reserved columns, so it should have fewer attributes.");
   NOISEPAGE_ASSERT(redo.NumColumns() > 0, "The input buffer should modify at least one attribute.");
+  MakeHot(slot.GetBlock());
+  if (CoalesceUpdate(txn, slot, redo)) return true;
+
   UndoRecord *const undo = txn->UndoRecordForUpdate(this, slot, redo);
-  slot.GetBlock()->controller_.WaitUntilHot();
   UndoRecord *version_ptr;
   do {
     version_ptr = AtomicallyReadVersionPtr(slot, accessor_);
@@ -102,6 +302,8 @@ bool DataTable::Update(const common::ManagedPointer<transaction::TransactionCont
     // Update the next pointer of the new head of the version chain
     undo->Next() = version_ptr;
   } while (!CompareAndSwapVersionPtr(slot, accessor_, version_ptr, undo));
+  PruneVersionChain(txn, undo);
+  if (txn->IsSerializable()) txn->GetSsiManager()->RegisterWrite(txn.Get(), slot.GetBlock());
 
   // Update in place with the new value.
   for (uint16_t i = 0; i < redo.NumColumns(); i++) {
@@ -112,79 +314,175 @@ bool DataTable::Update(const common::ManagedPointer<transaction::TransactionCont
     // that's difficult with this implementation
     StorageUtil::CopyAttrFromProjection(accessor_, slot, redo, i);
   }
+  WidenColumnZones(redo, slot);
 
   return true;
 }
 
 TupleSlot DataTable::Insert(const common::ManagedPointer<transaction::TransactionContext> txn,
                             const ProjectedRow &redo) {
-  NOISEPAGE_ASSERT(redo.NumColumns() == accessor_.GetBlockLayout().NumColumns() - NUM_RESERVED_COLUMNS,
-                   "The input buffer never changes the version pointer column, so it should have  exactly 1 fewer "
+  NOISEPAGE_ASSERT(redo.NumColumns() <= accessor_.GetBlockLayout().NumColumns() - NUM_RESERVED_COLUMNS,
+                   "The input buffer never changes the version pointer column, so it should have at most 1 fewer "
                    "attribute than the DataTable's layout.");
 
-  // Insertion index points to the first block that has free tuple slots
-  // Once a txn arrives, it will start from the insertion index to find the first
-  // idle (no other txn is trying to get tuple slots in that block) and non-full block.
-  // If no such block is found, the txn will create a new block.
-  // Before the txn writes to the block, it will set block status to busy.
-  // The first bit of block insert_head_ is used to indicate if the block is busy
-  // If the first bit is 1, it indicates one txn is writing to the block.
   TupleSlot result;
-  uint64_t current_insert_idx = insert_index_.load();
-  RawBlock *block;
-  while (true) {
-    // No free block left
-    uint64_t size = blocks_size_;
-    if (current_insert_idx >= size) {
-      block = NewBlock();
-      common::SharedLatch::ScopedExclusiveLatch latch(&blocks_latch_);
-      blocks_.push_back(block);
-      blocks_size_ = blocks_.size();
-      current_insert_idx = blocks_size_ - 1;
-    } else {
-      common::SharedLatch::ScopedSharedLatch latch(&blocks_latch_);
-      block = blocks_[current_insert_idx];
-    }
-    if (accessor_.SetBlockBusyStatus(block)) {
-      // No one is inserting into this block
-      if (accessor_.Allocate(block, &result)) {
-        // The block is not full, succeed
-        break;
-      }
+  if (IsPartitioned()) {
+    AllocateSlotInPartition(PartitionOf(redo), &result);
+  } else {
+    AllocateSlots(1, &result);
+  }
+  InsertInto(txn, redo, result);
+  return result;
+}
 
-      // if the full block is the insertion_header, move the insertion_header
-      // Next insert txn will search from the new insertion_header
-      if (current_insert_idx == insert_index_.load()) {
-        // if we fail, that's ok because that means that someone else incremented insert_index_
-        // so we retry on the next index
-        bool UNUSED_ATTRIBUTE result =
-            insert_index_.compare_exchange_strong(current_insert_idx, current_insert_idx + 1);
-        NOISEPAGE_ASSERT(result, "only one thread should be able to try (and fail) to insert into a block at a time");
-      }
+void DataTable::InsertBatch(const common::ManagedPointer<transaction::TransactionContext> txn,
+                            ProjectedColumns *const redos, TupleSlot *const results) {
+  NOISEPAGE_ASSERT(redos->NumColumns() <= accessor_.GetBlockLayout().NumColumns() - NUM_RESERVED_COLUMNS,
+                   "The input buffer never changes the version pointer column, so it should have at most 1 fewer "
+                   "attribute than the DataTable's layout.");
+  InsertRows(txn, redos->NumTuples(), [=](const uint32_t i) { return redos->InterpretAsRow(i); }, results);
+}
 
-      // Fail to insert into the block, flip back the status bit
-      accessor_.ClearBlockBusyStatus(block);
-    }
-    // The block is full or the block is being inserted by other txn, try next block
-    ++current_insert_idx;
+void DataTable::InsertBatch(const common::ManagedPointer<transaction::TransactionContext> txn,
+                            execution::sql::VectorProjection *const redos, TupleSlot *const results) {
+  NOISEPAGE_ASSERT(redos->GetColumnCount() <=
+                       static_cast<uint32_t>(accessor_.GetBlockLayout().NumColumns() - NUM_RESERVED_COLUMNS),
+                   "The input buffer never changes the version pointer column, so it should have at most 1 fewer "
+                   "attribute than the DataTable's layout.");
+  std::vector<uint32_t> rows;
+  rows.reserve(redos->GetSelectedTupleCount());
+  redos->owned_tid_list_.ForEach([&](const uint32_t tid) { rows.push_back(tid); });
+  InsertRows(txn, static_cast<uint32_t>(rows.size()), [&](const uint32_t i) { return redos->InterpretAsRow(rows[i]); },
+             results);
+}
+
+template <class RowAt>
+void DataTable::InsertRows(const common::ManagedPointer<transaction::TransactionContext> txn,
+                           const uint32_t num_tuples, RowAt row_at, TupleSlot *const results) {
+  if (num_tuples == 0) return;
+  if (IsPartitioned()) {
+    for (uint32_t i = 0; i < num_tuples; i++) AllocateSlotInPartition(PartitionOf(row_at(i)), results + i);
+  } else {
+    AllocateSlots(num_tuples, results);
   }
+  std::vector<UndoRecord *> undos(num_tuples);
+  txn->UndoRecordsForInsert(this, results, num_tuples, undos.data());
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    InstallInsert(row_at(i), results[i], undos[i]);
+    // Consecutive slots share a block, which only needs to be registered once all of its new versions are installed
+    const bool block_done = i + 1 == num_tuples || results[i + 1].GetBlock() != results[i].GetBlock();
+    if (block_done && txn->IsSerializable()) txn->GetSsiManager()->RegisterWrite(txn.Get(), results[i].GetBlock());
+  }
+}
 
-  // Do not need to wait unit finish inserting,
-  // can flip back the status bit once the thread gets the allocated tuple slot
-  accessor_.ClearBlockBusyStatus(block);
-  InsertInto(txn, redo, result);
+void DataTable::AllocateSlots(const uint32_t num_slots, TupleSlot *const results) {
+  // Every thread first tries the block of its insertion head, which it usually has to itself under contention. The
+  // first bit of block insert_head_ is used to indicate if the block is busy. If the first bit is 1, it indicates one
+  // txn is writing to the block.
+  InsertHead &head = InsertHeadForThread();
+  RawBlock *block = head.block_.load(std::memory_order_relaxed);
+  // The offset may belong to another block if threads that share the head raced, which only costs a scan of the block
+  uint32_t reuse_offset = head.reuse_offset_.load(std::memory_order_relaxed);
+  uint32_t allocated = 0;
+  if (block != nullptr && accessor_.SetBlockBusyStatus(block)) {
+    allocated = AllocateInBlock(block, &reuse_offset, num_slots, results);
+    accessor_.ClearBlockBusyStatus(block);
+  }
+  while (allocated < num_slots) {
+    // The block of the insertion head is full, or another thread is inserting into it
+    block = AllocateFromInsertionIndex(results + allocated++, &reuse_offset);
+    allocated += AllocateInBlock(block, &reuse_offset, num_slots - allocated, results + allocated);
+    // Do not need to wait unit finish inserting,
+    // can flip back the status bit once the thread gets the allocated tuple slots
+    accessor_.ClearBlockBusyStatus(block);
+    head.block_.store(block, std::memory_order_relaxed);
+  }
+  head.reuse_offset_.store(reuse_offset, std::memory_order_relaxed);
+}
 
-  return result;
+bool DataTable::AllocateInBlock(RawBlock *const block, uint32_t *const reuse_offset, TupleSlot *const result) {
+  if (accessor_.Allocate(block, result)) return true;
+  if (*reuse_offset == NO_REUSE) return false;
+  if (!CanReuseFreeSlots(block) || !accessor_.AllocateFreed(block, *reuse_offset, result)) {
+    *reuse_offset = NO_REUSE;
+    return false;
+  }
+  *reuse_offset = result->GetOffset() + 1;
+  return true;
+}
+
+uint32_t DataTable::AllocateInBlock(RawBlock *const block, uint32_t *const reuse_offset, const uint32_t num_slots,
+                                   TupleSlot *const results) {
+  uint32_t allocated = accessor_.AllocateRun(block, num_slots, results);
+  while (allocated < num_slots && AllocateInBlock(block, reuse_offset, results + allocated)) allocated++;
+  return allocated;
+}
+
+RawBlock *DataTable::TakeBlockWithFreeSlots() {
+  while (RawBlock *const block = free_space_map_.TakeBlock()) {
+    // A busy block is being filled already
+    if (!accessor_.SetBlockBusyStatus(block)) continue;
+    if (CanReuseFreeSlots(block)) return block;
+    accessor_.ClearBlockBusyStatus(block);
+  }
+  return nullptr;
+}
+
+bool DataTable::CanReuseFreeSlots(RawBlock *const block) const {
+  return block->controller_.GetBlockState()->load() == BlockState::HOT &&
+         !accessor_.GetArrowBlockMetadata(block).GetAccessStats(accessor_.GetBlockLayout()).queued_;
+}
+
+void DataTable::SetRangePartitioning(const col_id_t col_id, std::vector<int64_t> bounds) {
+  NOISEPAGE_ASSERT(HasColumnZone(col_id), "the blocks of a range are only skipped by the zone map of the column");
+  NOISEPAGE_ASSERT(std::is_sorted(bounds.begin(), bounds.end()), "bounds must be in ascending order");
+  NOISEPAGE_ASSERT(blocks_size_ <= 1 && (blocks_size_ == 0 || blocks_[0]->GetInsertHead() == 0),
+                   "the tuples inserted so far would not be in the blocks of their ranges");
+  partition_col_id_ = col_id;
+  partition_bounds_ = std::move(bounds);
+  partitions_ = std::make_unique<Partition[]>(NumPartitions());
+  // The empty block the table starts with goes to the first range
+  if (blocks_size_ == 1) partitions_[0].block_ = blocks_[0];
+}
+
+template <class RowType>
+uint32_t DataTable::PartitionOf(const RowType &redo) const {
+  for (uint16_t i = 0; i < redo.NumColumns(); i++) {
+    if (redo.ColumnIds()[i] != partition_col_id_) continue;
+    const byte *const value = redo.AccessWithNullCheck(i);
+    if (value == nullptr) return 0;
+    const int64_t key = ColumnZone::Read(value, accessor_.GetBlockLayout().AttrSize(partition_col_id_));
+    return static_cast<uint32_t>(
+        std::upper_bound(partition_bounds_.begin(), partition_bounds_.end(), key) - partition_bounds_.begin());
+  }
+  return 0;
+}
+
+void DataTable::AllocateSlotInPartition(const uint32_t partition, TupleSlot *const result) {
+  Partition &range = partitions_[partition];
+  common::SpinLatch::ScopedSpinLatch guard(&range.latch_);
+  if (range.block_ != nullptr && accessor_.Allocate(range.block_, result)) return;
+  RawBlock *const block = NewBlock();
+  const bool UNUSED_ATTRIBUTE allocated = accessor_.Allocate(block, result);
+  NOISEPAGE_ASSERT(allocated, "a new block has free slots");
+  AppendBlock(block);
+  range.block_ = block;
 }
 
 void DataTable::InsertInto(const common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &redo,
                            TupleSlot dest) {
-  NOISEPAGE_ASSERT(accessor_.Allocated(dest), "destination slot must already be allocated");
-  NOISEPAGE_ASSERT(accessor_.IsNull(dest, VERSION_POINTER_COLUMN_ID),
-                   "The slot needs to be logically deleted to every running transaction");
   // At this point, sequential scan down the block can still see this, except it thinks it is logically deleted if we 0
   // the primary key column
   UndoRecord *undo = txn->UndoRecordForInsert(this, dest);
+  InstallInsert(redo, dest, undo);
+  if (txn->IsSerializable()) txn->GetSsiManager()->RegisterWrite(txn.Get(), dest.GetBlock());
+}
+
+template <class RowType>
+void DataTable::InstallInsert(const RowType &redo, const TupleSlot dest, UndoRecord *const undo) {
+  NOISEPAGE_ASSERT(accessor_.Allocated(dest), "destination slot must already be allocated");
+  NOISEPAGE_ASSERT(accessor_.IsNull(dest, VERSION_POINTER_COLUMN_ID),
+                   "The slot needs to be logically deleted to every running transaction");
   NOISEPAGE_ASSERT(dest.GetBlock()->controller_.GetBlockState()->load() == BlockState::HOT,
                    "Should only be able to insert into hot blocks");
   AtomicallyWriteVersionPtr(dest, accessor_, undo);
@@ -196,11 +494,44 @@ void DataTable::InsertInto(const common::ManagedPointer<transaction::Transaction
                      "Insert buffer should not change the version pointer column.");
     StorageUtil::CopyAttrFromProjection(accessor_, dest, redo, i);
   }
+  // Columns the row leaves out, like the ones dropped from the table's schema, are null rather than whatever a
+  // reclaimed tuple left in the slot
+  const BlockLayout &layout = accessor_.GetBlockLayout();
+  if (redo.NumColumns() + NUM_RESERVED_COLUMNS < layout.NumColumns()) {
+    // The row's column ids are not sorted, so mark the written ones in a bitmap on the stack that fits any layout
+    byte written_buffer[common::RawBitmap::SizeInBytes(common::Constants::MAX_COL + NUM_RESERVED_COLUMNS)];
+    auto *const written = reinterpret_cast<common::RawBitmap *>(written_buffer);
+    written->Clear(layout.NumColumns());
+    for (uint16_t i = 0; i < redo.NumColumns(); i++) written->Set(redo.ColumnIds()[i].UnderlyingValue(), true);
+    for (uint16_t i = NUM_RESERVED_COLUMNS; i < layout.NumColumns(); i++) {
+      if (!written->Test(i)) accessor_.SetNull(dest, col_id_t(i));
+    }
+  }
+  WidenColumnZones(redo, dest);
+}
+
+template <class RowType>
+void DataTable::WidenColumnZones(const RowType &redo, const TupleSlot slot) {
+  const BlockLayout &layout = accessor_.GetBlockLayout();
+  ArrowBlockMetadata &metadata = accessor_.GetArrowBlockMetadata(slot.GetBlock());
+  for (uint16_t i = 0; i < redo.NumColumns(); i++) {
+    const col_id_t col_id = redo.ColumnIds()[i];
+    const byte *const value = redo.AccessWithNullCheck(i);
+    if (value == nullptr || !HasColumnZone(col_id)) continue;
+    metadata.GetColumnZone(layout, col_id).Widen(ColumnZone::Read(value, layout.AttrSize(col_id)));
+  }
+}
+
+bool DataTable::BlockMayContain(const RawBlock *const block, const col_id_t col_id, const int64_t min,
+                                const int64_t max) const {
+  if (!HasColumnZone(col_id)) return true;
+  const auto &metadata = accessor_.GetArrowBlockMetadata(const_cast<RawBlock *>(block));
+  return metadata.GetColumnZone(accessor_.GetBlockLayout(), col_id).Overlaps(min, max);
 }
 
 bool DataTable::Delete(const common::ManagedPointer<transaction::TransactionContext> txn, const TupleSlot slot) {
   UndoRecord *const undo = txn->UndoRecordForDelete(this, slot);
-  slot.GetBlock()->controller_.WaitUntilHot();
+  MakeHot(slot.GetBlock());
   UndoRecord *version_ptr;
   do {
     version_ptr = AtomicallyReadVersionPtr(slot, accessor_);
@@ -216,30 +547,68 @@ bool DataTable::Delete(const common::ManagedPointer<transaction::TransactionCont
     // Update the next pointer of the new head of the version chain
     undo->Next() = version_ptr;
   } while (!CompareAndSwapVersionPtr(slot, accessor_, version_ptr, undo));
+  PruneVersionChain(txn, undo);
+  if (txn->IsSerializable()) txn->GetSsiManager()->RegisterWrite(txn.Get(), slot.GetBlock());
 
   // We have the write lock. Go ahead and flip the logically deleted bit to true
   accessor_.SetNull(slot, VERSION_POINTER_COLUMN_ID);
   return true;
 }
 
+bool DataTable::Lock(const common::ManagedPointer<transaction::TransactionContext> txn, const TupleSlot slot) {
+  MakeHot(slot.GetBlock());
+  // The txn already holds the write lock if it wrote or locked the tuple before
+  UndoRecord *version_ptr = AtomicallyReadVersionPtr(slot, accessor_);
+  if (version_ptr != nullptr && version_ptr->Timestamp().load() == txn->FinishTime()) return Visible(slot, accessor_);
+
+  UndoRecord *const undo = txn->UndoRecordForLock(this, slot);
+  do {
+    version_ptr = AtomicallyReadVersionPtr(slot, accessor_);
+    if (HasConflict(*txn, version_ptr) || !Visible(slot, accessor_)) {
+      // Same as a failed Update or Delete, the record was never installed
+      undo->Table() = nullptr;
+      return false;
+    }
+    undo->Next() = version_ptr;
+  } while (!CompareAndSwapVersionPtr(slot, accessor_, version_ptr, undo));
+  PruneVersionChain(txn, undo);
+  return true;
+}
+
 template <class RowType>
 bool DataTable::SelectIntoBuffer(const common::ManagedPointer<transaction::TransactionContext> txn,
-                                 const TupleSlot slot, RowType *const out_buffer) const {
+                                 const TupleSlot slot, RowType *const out_buffer, const bool register_read) const {
+  // This cannot be visible if it's already deallocated.
+  if (!accessor_.Allocated(slot)) return false;
+  MakeResident(slot.GetBlock());
+
+  // Take the SIREAD lock before looking at the version chain. A concurrent writer then either finds the lock, or
+  // installed its version early enough for us to skip it below.
+  if (register_read && txn->IsSerializable()) txn->GetSsiManager()->RegisterRead(txn.Get(), slot.GetBlock());
+  return SelectAllocatedIntoBuffer(txn, slot, out_buffer);
+}
+
+template <class RowType>
+bool DataTable::SelectAllocatedIntoBuffer(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                          const TupleSlot slot, RowType *const out_buffer) const {
   NOISEPAGE_ASSERT(out_buffer->NumColumns() <= accessor_.GetBlockLayout().NumColumns() - NUM_RESERVED_COLUMNS,
                    "The output buffer never returns the version pointer columns, so it should have "
                    "fewer attributes.");
   NOISEPAGE_ASSERT(out_buffer->NumColumns() > 0, "The output buffer should return at least one attribute.");
-  // This cannot be visible if it's already deallocated.
-  if (!accessor_.Allocated(slot)) return false;
-
   // Copy the current (most recent) tuple into the output buffer. These operations don't need to be atomic,
   // because so long as we set the version ptr before updating in place, the reader will chase the version chain
   // and apply the pre-image of the writer before returning anyway.  In the worst case, we accidentally overwrite
   // a good read with the exact same data, but there is no way to detect this.
-  for (uint16_t i = 0; i < out_buffer->NumColumns(); i++) {
+  for (uint16_t i = 0; i < out_buffer->NumColumns();) {
     NOISEPAGE_ASSERT(out_buffer->ColumnIds()[i] != VERSION_POINTER_COLUMN_ID,
                      "Output buffer should not read the version pointer column.");
-    StorageUtil::CopyAttrIntoProjection(accessor_, slot, out_buffer, i);
+    // Attributes stored together in a column group are stored together in a ProjectedRow too
+    if constexpr (std::is_same_v<RowType, ProjectedRow>) {
+      i += StorageUtil::CopyAttrSpanIntoProjection(accessor_, slot, out_buffer, i);
+    } else {  // NOLINT
+      StorageUtil::CopyAttrIntoProjection(accessor_, slot, out_buffer, i);
+      i++;
+    }
   }
 
   bool visible = !accessor_.IsNull(slot, VERSION_POINTER_COLUMN_ID);
@@ -252,6 +621,8 @@ bool DataTable::SelectIntoBuffer(const common::ManagedPointer<transaction::Trans
   }
 
   // Apply deltas until we reconstruct a version safe for us to read
+  UndoRecord *last_applied = nullptr;
+  uint32_t num_applied = 0;
   while (version_ptr != nullptr &&
          transaction::TransactionUtil::NewerThan(version_ptr->Timestamp().load(), txn->StartTime())) {
     switch (version_ptr->Type()) {
@@ -265,21 +636,85 @@ bool DataTable::SelectIntoBuffer(const common::ManagedPointer<transaction::Trans
       case DeltaRecordType::DELETE:
         visible = true;
         break;
+      case DeltaRecordType::LOCK:
+        break;
       default:
         throw std::runtime_error("unexpected delta record type");
     }
+    // The writer of a version newer than our snapshot overwrote what we read
+    if (txn->IsSerializable() && version_ptr->Type() != DeltaRecordType::LOCK) {
+      txn->GetSsiManager()->RegisterNewerVersionRead(txn.Get(), version_ptr->Timestamp().load());
+    }
+    last_applied = version_ptr;
+    num_applied++;
     version_ptr = version_ptr->Next();
   }
 
+  // A long walk is a sign of a hot tuple whose version chain grows faster than the GC truncates it
+  if (num_applied > PRUNE_TRAVERSAL_THRESHOLD) PruneVersionChain(txn, last_applied);
+
   return visible;
 }
 
 template bool DataTable::SelectIntoBuffer<ProjectedRow>(
     const common::ManagedPointer<transaction::TransactionContext> txn, const TupleSlot slot,
-    ProjectedRow *const out_buffer) const;
+    ProjectedRow *const out_buffer, const bool register_read) const;
 template bool DataTable::SelectIntoBuffer<ProjectedColumns::RowView>(
     const common::ManagedPointer<transaction::TransactionContext> txn, const TupleSlot slot,
-    ProjectedColumns::RowView *const out_buffer) const;
+    ProjectedColumns::RowView *const out_buffer, const bool register_read) const;
+
+bool DataTable::CoalesceUpdate(const common::ManagedPointer<transaction::TransactionContext> txn, const TupleSlot slot,
+                               const ProjectedRow &redo) {
+  // Nobody else can install a version on top of a record of txn, so this needs no compare-and-swap
+  UndoRecord *const head = AtomicallyReadVersionPtr(slot, accessor_);
+  if (head == nullptr || head->Timestamp().load() != txn->FinishTime() || !Visible(slot, accessor_)) return false;
+  switch (head->Type()) {
+    case DeltaRecordType::INSERT:
+      // Rolling back the insert removes the tuple altogether
+      break;
+    case DeltaRecordType::UPDATE: {
+      const ProjectedRow &before_image = *head->Delta();
+      for (uint16_t i = 0; i < redo.NumColumns(); i++) {
+        const col_id_t *const end = before_image.ColumnIds() + before_image.NumColumns();
+        if (std::find(before_image.ColumnIds(), end, redo.ColumnIds()[i]) == end) return false;
+      }
+      break;
+    }
+    default:
+      return false;
+  }
+
+  const BlockLayout &layout = accessor_.GetBlockLayout();
+  for (uint16_t i = 0; i < redo.NumColumns(); i++) {
+    const col_id_t col_id = redo.ColumnIds()[i];
+    // txn wrote the value that is overwritten, and nothing else refers to it once the log has been written out
+    if (layout.IsVarlen(col_id)) {
+      auto *const varlen = reinterpret_cast<VarlenEntry *>(accessor_.AccessWithNullCheck(slot, col_id));
+      if (varlen != nullptr && varlen->NeedReclaim()) txn->LoosePtrsOfThisThread()->push_back(varlen->Content());
+    }
+    StorageUtil::CopyAttrFromProjection(accessor_, slot, redo, i);
+  }
+  WidenColumnZones(redo, slot);
+  return true;
+}
+
+void DataTable::PruneVersionChain(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                  UndoRecord *const from) const {
+  const transaction::timestamp_t oldest = txn->CachedOldestTransactionStartTime();
+  // Same as the GarbageCollector's truncation below the head of the version chain. The chain is sorted newest-to-oldest
+  // and only ever grows at the head, so cutting it below a record is a blind store, and concurrent pruners and the GC
+  // can at worst cut it at different points. A reader still traversing the removed records stops there anyway, and the
+  // records stay allocated until the GC deallocates their transactions after every such reader has finished.
+  UndoRecord *curr = from;
+  UndoRecord *next;
+  while ((next = curr->Next().load()) != nullptr) {
+    if (transaction::TransactionUtil::NewerThan(oldest, next->Timestamp().load())) {
+      curr->Next().store(nullptr);
+      return;
+    }
+    curr = next;
+  }
+}
 
 UndoRecord *DataTable::AtomicallyReadVersionPtr(const TupleSlot slot, const TupleAccessStrategy &accessor) const {
   // Okay to ignore presence bit, because we use that for logical delete, not for validity of the version pointer value
@@ -300,7 +735,12 @@ bool DataTable::Visible(const TupleSlot slot, const TupleAccessStrategy &accesso
   return present && not_deleted;
 }
 
-bool DataTable::HasConflict(const transaction::TransactionContext &txn, UndoRecord *const version_ptr) const {
+bool DataTable::HasConflict(const transaction::TransactionContext &txn, UndoRecord *version_ptr) const {
+  // A row lock that is not held anymore changed nothing, so only the versions below it can conflict
+  while (version_ptr != nullptr && version_ptr->Type() == DeltaRecordType::LOCK &&
+         transaction::TransactionUtil::Committed(version_ptr->Timestamp().load())) {
+    version_ptr = version_ptr->Next().load();
+  }
   if (version_ptr == nullptr) return false;  // Nobody owns this tuple's write lock, no older version visible
   const transaction::timestamp_t version_timestamp = version_ptr->Timestamp().load();
   const transaction::timestamp_t txn_id = txn.FinishTime();
@@ -319,6 +759,65 @@ bool DataTable::CompareAndSwapVersionPtr(const TupleSlot slot, const TupleAccess
   return reinterpret_cast<std::atomic<UndoRecord *> *>(ptr_location)->compare_exchange_strong(expected, desired);
 }
 
+RawBlock *DataTable::AllocateFromInsertionIndex(TupleSlot *const result, uint32_t *const reuse_offset) {
+  // Insertion index points to the first block that has free tuple slots
+  // Once a txn arrives, it will start from the insertion index to find the first
+  // idle (no other txn is trying to get tuple slots in that block) and non-full block.
+  // If no such block is found, the txn will create a new block.
+  // Before the txn writes to the block, it will set block status to busy.
+  uint64_t current_insert_idx = insert_index_.load();
+  RawBlock *block;
+  *reuse_offset = NO_REUSE;
+  while (true) {
+    // No free block left
+    if (current_insert_idx >= blocks_size_) {
+      // Fill the slots that deletes freed before growing the table
+      while ((block = TakeBlockWithFreeSlots()) != nullptr) {
+        *reuse_offset = 0;
+        if (AllocateInBlock(block, reuse_offset, result)) return block;
+        accessor_.ClearBlockBusyStatus(block);
+      }
+      block = NewBlock();
+      current_insert_idx = AppendBlock(block);
+    } else {
+      block = blocks_[current_insert_idx];
+    }
+    if (accessor_.SetBlockBusyStatus(block)) {
+      // No one is inserting into this block
+      if (accessor_.Allocate(block, result)) {
+        // The block is not full, succeed
+        return block;
+      }
+
+      // if the full block is the insertion_header, move the insertion_header
+      // Next insert txn will search from the new insertion_header
+      if (current_insert_idx == insert_index_.load()) {
+        // if we fail, that's ok because that means that someone else incremented insert_index_
+        // so we retry on the next index
+        bool UNUSED_ATTRIBUTE result =
+            insert_index_.compare_exchange_strong(current_insert_idx, current_insert_idx + 1);
+        NOISEPAGE_ASSERT(result, "only one thread should be able to try (and fail) to insert into a block at a time");
+      }
+
+      // Fail to insert into the block, flip back the status bit
+      accessor_.ClearBlockBusyStatus(block);
+    }
+    // The block is full or the block is being inserted by other txn, try next block
+    ++current_insert_idx;
+  }
+}
+
+uint64_t DataTable::AppendBlock(RawBlock *const block) {
+  const uint64_t index = blocks_.Append(block);
+  // Appends that reserved an earlier index publish their block first, so readers never see a gap
+  uint64_t expected = index;
+  while (!blocks_size_.compare_exchange_weak(expected, index + 1)) {
+    expected = index;
+    _mm_pause();
+  }
+  return index;
+}
+
 RawBlock *DataTable::NewBlock() {
   RawBlock *new_block = block_store_->Get();
   accessor_.InitializeRawBlock(this, new_block, layout_version_);
@@ -326,11 +825,14 @@ RawBlock *DataTable::NewBlock() {
 }
 
 bool DataTable::HasConflict(const transaction::TransactionContext &txn, const TupleSlot slot) const {
+  MakeResident(slot.GetBlock());
   UndoRecord *const version_ptr = AtomicallyReadVersionPtr(slot, accessor_);
   return HasConflict(txn, version_ptr);
 }
 
 bool DataTable::IsVisible(const transaction::TransactionContext &txn, const TupleSlot slot) const {
+  // Index scans and unique checks call this on slots of blocks that may have been evicted
+  MakeResident(slot.GetBlock());
   UndoRecord *version_ptr;
   bool visible;
   do {
@@ -358,6 +860,9 @@ bool DataTable::IsVisible(const transaction::TransactionContext &txn, const Tupl
         break;
       case DeltaRecordType::DELETE:
         visible = true;
+        break;
+      case DeltaRecordType::LOCK:
+        break;
     }
     version_ptr = version_ptr->Next();
   }
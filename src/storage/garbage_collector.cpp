@@ -1,9 +1,13 @@
 #include "storage/garbage_collector.h"
 
+#include <algorithm>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include "common/macros.h"
+#include "common/scoped_timer.h"
 #include "common/thread_context.h"
 #include "loggers/storage_logger.h"
 #include "metrics/metrics_store.h"
@@ -21,14 +25,22 @@ namespace noisepage::storage {
 GarbageCollector::GarbageCollector(
     const common::ManagedPointer<transaction::TimestampManager> timestamp_manager,
     const common::ManagedPointer<transaction::DeferredActionManager> deferred_action_manager,
-    const common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer)
+    const common::ManagedPointer<transaction::TransactionManager> txn_manager, AccessObserver *observer,
+    const uint32_t num_gc_threads, const std::chrono::microseconds index_maintenance_interval)
     : timestamp_manager_(timestamp_manager),
       deferred_action_manager_(deferred_action_manager),
       txn_manager_(txn_manager),
       observer_(observer),
-      last_unlinked_{0} {
+      last_unlinked_{0},
+      num_gc_threads_(num_gc_threads),
+      index_maintenance_interval_(index_maintenance_interval) {
   NOISEPAGE_ASSERT(txn_manager_->GCEnabled(),
                    "The TransactionManager needs to be instantiated with gc_enabled true for GC to work!");
+  NOISEPAGE_ASSERT(num_gc_threads_ > 0, "GC needs at least one thread");
+  if (num_gc_threads_ > 1) {
+    gc_workers_ = std::make_unique<common::WorkerPool>(num_gc_threads_, common::TaskQueue{});
+    gc_workers_->Startup();
+  }
 }
 
 std::pair<uint32_t, uint32_t> GarbageCollector::PerformGarbageCollection() {
@@ -41,8 +53,9 @@ std::pair<uint32_t, uint32_t> GarbageCollector::PerformGarbageCollection() {
   const transaction::timestamp_t oldest_txn = timestamp_manager_->OldestTransactionStartTime();
   uint32_t txns_deallocated = ProcessDeallocateQueue(oldest_txn);
   STORAGE_LOG_TRACE("GarbageCollector::PerformGarbageCollection(): txns_deallocated: {}", txns_deallocated);
-  uint32_t txns_unlinked, buffer_unlinked, readonly_unlinked;
-  std::tie(txns_unlinked, buffer_unlinked, readonly_unlinked) = ProcessUnlinkQueue(oldest_txn);
+  uint32_t txns_unlinked, buffer_unlinked, readonly_unlinked, version_chains_truncated;
+  std::tie(txns_unlinked, buffer_unlinked, readonly_unlinked, version_chains_truncated) =
+      ProcessUnlinkQueue(oldest_txn);
   STORAGE_LOG_TRACE("GarbageCollector::PerformGarbageCollection(): txns_unlinked: {}", txns_unlinked);
   if (txns_unlinked > 0) {
     // Only update this field if we actually unlinked anything, otherwise we're being too conservative about when it's
@@ -52,15 +65,23 @@ std::pair<uint32_t, uint32_t> GarbageCollector::PerformGarbageCollection() {
   STORAGE_LOG_TRACE("GarbageCollector::PerformGarbageCollection(): last_unlinked_: {}",
                     last_unlinked_.UnderlyingValue());
   ProcessDeferredActions(oldest_txn);
-  ProcessIndexes();
+  std::vector<IndexMaintenanceData> index_maintenance;
+  ProcessIndexes(gc_metrics_enabled ? &index_maintenance : nullptr);
 
-  if ((txns_deallocated > 0 || txns_unlinked > 0) && gc_metrics_enabled) {
+  if ((txns_deallocated > 0 || txns_unlinked > 0 || !index_maintenance.empty()) && gc_metrics_enabled) {
     if (common::thread_context.resource_tracker_.IsRunning()) {
       // Stop the resource tracker for this operating unit
       common::thread_context.resource_tracker_.Stop();
       auto &resource_metrics = common::thread_context.resource_tracker_.GetMetrics();
       common::thread_context.metrics_store_->RecordGCData(txns_deallocated, txns_unlinked, buffer_unlinked,
-                                                          readonly_unlinked, gc_interval_, resource_metrics);
+                                                          readonly_unlinked, version_chains_truncated,
+                                                          num_gc_threads_, gc_interval_, resource_metrics);
+      for (const auto &data : index_maintenance) {
+        common::thread_context.metrics_store_->RecordIndexMaintenanceData(
+            static_cast<char>(data.type_), data.num_keys_, data.heap_usage_, data.stats_.consolidations_,
+            data.stats_.background_consolidations_, data.stats_.consolidated_deltas_, data.stats_.longest_chain_,
+            data.modifications_, data.gc_elapsed_us_, resource_metrics);
+      }
     }
     common::thread_context.resource_tracker_.Start();
   }
@@ -85,7 +106,8 @@ uint32_t GarbageCollector::ProcessDeallocateQueue(transaction::timestamp_t oldes
   return txns_processed;
 }
 
-std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(transaction::timestamp_t oldest_txn) {
+std::tuple<uint32_t, uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(
+    transaction::timestamp_t oldest_txn) {
   transaction::TransactionContext *txn = nullptr;
 
   // Get the completed transactions from the TransactionManager
@@ -96,12 +118,12 @@ std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(tr
   }
 
   uint32_t txns_processed = 0, buffer_processed = 0, readonly_processed = 0;
+  // Slots of the tuples that the unlinked transactions deleted
+  std::vector<TupleSlot> deleted_slots;
   // Certain transactions might not be yet safe to gc. Need to requeue them
   transaction::TransactionQueue requeue;
-  // It is sufficient to truncate each version chain once in a GC invocation because we only read the maximal safe
-  // timestamp once, and the version chain is sorted by timestamp. Here we keep a set of slots to truncate to avoid
-  // wasteful traversals of the version chain.
-  std::unordered_set<TupleSlot> visited_slots;
+  // Transactions whose versions are no longer visible to any running transaction
+  transaction::TransactionQueue unlinkable;
 
   // Process every transaction in the unlink queue
   while (!txns_to_unlink_.empty()) {
@@ -115,23 +137,7 @@ std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(tr
       readonly_processed++;
     } else if (transaction::TransactionUtil::NewerThan(oldest_txn, txn->FinishTime())) {
       // Safe to garbage collect.
-      for (auto &undo_record : txn->undo_buffer_) {
-        // It is possible for the table field to be null, for aborted transaction's last conflicting record
-        DataTable *&table = undo_record.Table();
-        // Each version chain needs to be traversed and truncated at most once every GC period. Check
-        // if we have already visited this tuple slot; if not, proceed to prune the version chain.
-        if (table != nullptr && visited_slots.insert(undo_record.Slot()).second)
-          TruncateVersionChain(table, undo_record.Slot(), oldest_txn);
-        // Regardless of the version chain we will need to reclaim deleted slots and any dangling pointers to varlens,
-        // unless the transaction is aborted, and the record holds a version that is still visible.
-        if (!txn->Aborted()) {
-          ReclaimBufferIfVarlen(txn, &undo_record);
-          ReclaimSlotIfDeleted(&undo_record);
-        }
-        if (observer_ != nullptr) observer_->ObserveWrite(undo_record.Slot().GetBlock());
-        buffer_processed++;
-      }
-      txns_to_deallocate_.push_front(txn);
+      unlinkable.push_front(txn);
       txns_processed++;
     } else {
       // This is a committed txn that is still visible, requeue for next GC run
@@ -139,10 +145,72 @@ std::tuple<uint32_t, uint32_t, uint32_t> GarbageCollector::ProcessUnlinkQueue(tr
     }
   }
 
+  // Truncating the version chains is the expensive part, and can be spread across the GC workers
+  const uint32_t version_chains_truncated = TruncateVersionChains(unlinkable, oldest_txn);
+
+  for (auto *const unlinked_txn : unlinkable) {
+    for (auto &undo_record : unlinked_txn->undo_buffer_) {
+      buffer_processed++;
+      // A row lock changed nothing
+      if (undo_record.Type() == DeltaRecordType::LOCK) continue;
+      // Regardless of the version chain we will need to reclaim deleted slots and any dangling pointers to varlens,
+      // unless the transaction is aborted, and the record holds a version that is still visible.
+      if (!unlinked_txn->Aborted()) {
+        ReclaimBufferIfVarlen(unlinked_txn, &undo_record);
+        if (undo_record.Type() == DeltaRecordType::DELETE) deleted_slots.push_back(undo_record.Slot());
+        undo_record.Table()->num_modifications_.fetch_add(1, std::memory_order_relaxed);
+      }
+      if (observer_ != nullptr) observer_->ObserveWrite(undo_record.Slot().GetBlock());
+    }
+  }
+  if (!deleted_slots.empty()) ReclaimSlots(std::move(deleted_slots));
+  txns_to_deallocate_.splice_after(txns_to_deallocate_.cbefore_begin(), std::move(unlinkable));
+
   // Requeue any txns that we were still visible to running transactions
   txns_to_unlink_ = transaction::TransactionQueue(std::move(requeue));
 
-  return std::make_tuple(txns_processed, buffer_processed, readonly_processed);
+  return std::make_tuple(txns_processed, buffer_processed, readonly_processed, version_chains_truncated);
+}
+
+uint32_t GarbageCollector::TruncateVersionChains(const transaction::TransactionQueue &txns,
+                                                 const transaction::timestamp_t oldest_txn) {
+  // It is sufficient to truncate each version chain once in a GC invocation because we only read the maximal safe
+  // timestamp once, and the version chain is sorted by timestamp. Here we keep a set of slots to truncate to avoid
+  // wasteful traversals of the version chain.
+  if (gc_workers_ == nullptr) {
+    std::unordered_set<TupleSlot> visited_slots;
+    for (auto *const txn : txns) {
+      for (auto &undo_record : txn->undo_buffer_) {
+        // It is possible for the table field to be null, for aborted transaction's last conflicting record
+        DataTable *const table = undo_record.Table();
+        if (table != nullptr && visited_slots.insert(undo_record.Slot()).second)
+          TruncateVersionChain(table, undo_record.Slot(), oldest_txn);
+      }
+    }
+    return static_cast<uint32_t>(visited_slots.size());
+  }
+
+  // TruncateVersionChain relies on being the only GC thread that modifies a version chain, so the slots are sharded
+  // and every slot is truncated by exactly one worker.
+  std::vector<std::unordered_map<TupleSlot, DataTable *>> shards(num_gc_threads_);
+  const std::hash<TupleSlot> slot_hash;
+  uint32_t num_slots = 0;
+  for (auto *const txn : txns) {
+    for (auto &undo_record : txn->undo_buffer_) {
+      DataTable *const table = undo_record.Table();
+      if (table == nullptr) continue;
+      const TupleSlot slot = undo_record.Slot();
+      if (shards[slot_hash(slot) % num_gc_threads_].emplace(slot, table).second) num_slots++;
+    }
+  }
+  for (const auto &shard : shards) {
+    if (shard.empty()) continue;
+    gc_workers_->SubmitTask([this, &shard, oldest_txn] {
+      for (const auto &[slot, table] : shard) TruncateVersionChain(table, slot, oldest_txn);
+    });
+  }
+  gc_workers_->WaitUntilAllFinished();
+  return num_slots;
 }
 
 void GarbageCollector::ProcessDeferredActions(transaction::timestamp_t oldest_txn) {
@@ -171,8 +239,8 @@ void GarbageCollector::TruncateVersionChain(DataTable *const table, const TupleS
     return;
   }
 
-  // a version chain is guaranteed to not change when not at the head (assuming single-threaded GC), so we are safe
-  // to traverse and update pointers without CAS
+  // below the head a version chain can only be cut shorter, by readers and writers pruning it inline
+  // (@see DataTable::PruneVersionChain), so we are safe to traverse and update pointers without CAS
   UndoRecord *curr = version_ptr;
   UndoRecord *next;
   // Traverse until we find the earliest UndoRecord that can be unlinked.
@@ -194,8 +262,19 @@ void GarbageCollector::TruncateVersionChain(DataTable *const table, const TupleS
     TruncateVersionChain(table, slot, oldest);
 }
 
-void GarbageCollector::ReclaimSlotIfDeleted(UndoRecord *const undo_record) const {
-  if (undo_record->Type() == DeltaRecordType::DELETE) undo_record->Table()->accessor_.Deallocate(undo_record->Slot());
+void GarbageCollector::ReclaimSlots(std::vector<TupleSlot> &&slots) {
+  if (deferred_action_manager_ == DISABLED) {
+    // Nothing defers index deletes
+    for (const TupleSlot slot : slots) slot.GetBlock()->data_table_->ReclaimSlot(slot);
+    return;
+  }
+  // The deleting transactions deferred their index deletes when they committed, which was before this GC run started.
+  // Closing the epoch puts the reclamation in a later epoch than those deletes, so it is applied after them, whichever
+  // thread registered them. It still comes before the table can be freed, which dropping the table defers three times.
+  deferred_action_manager_->CloseEpoch();
+  deferred_action_manager_->RegisterDeferredAction([slots{std::move(slots)}]() {
+    for (const TupleSlot slot : slots) slot.GetBlock()->data_table_->ReclaimSlot(slot);
+  });
 }
 
 void GarbageCollector::ReclaimBufferIfVarlen(transaction::TransactionContext *const txn,
@@ -204,6 +283,7 @@ void GarbageCollector::ReclaimBufferIfVarlen(transaction::TransactionContext *co
   const BlockLayout &layout = accessor.GetBlockLayout();
   switch (undo_record->Type()) {
     case DeltaRecordType::INSERT:
+    case DeltaRecordType::LOCK:
       return;  // no possibility of outdated varlen to gc
     case DeltaRecordType::DELETE:
       // TODO(Tianyu): Potentially need to be more efficient than linear in column size?
@@ -234,20 +314,61 @@ void GarbageCollector::ReclaimBufferIfVarlen(transaction::TransactionContext *co
 void GarbageCollector::RegisterIndexForGC(const common::ManagedPointer<index::Index> index) {
   NOISEPAGE_ASSERT(index != nullptr, "Index cannot be nullptr.");
   common::SharedLatch::ScopedExclusiveLatch guard(&indexes_latch_);
-  NOISEPAGE_ASSERT(indexes_.count(index) == 0, "Trying to register an index that has already been registered.");
-  indexes_.insert(index);
+  NOISEPAGE_ASSERT(std::none_of(indexes_.cbegin(), indexes_.cend(),
+                               [=](const RegisteredIndex &registered) { return registered.index_ == index; }),
+                   "Trying to register an index that has already been registered.");
+  // Whatever the index holds was built before it was registered, so it is garbage collected once modified
+  indexes_.push_back({index, 0});
+  if (index_maintenance_interval_.count() > 0) index->StartBackgroundMaintenance(index_maintenance_interval_);
 }
 
 void GarbageCollector::UnregisterIndexForGC(const common::ManagedPointer<index::Index> index) {
   NOISEPAGE_ASSERT(index != nullptr, "Index cannot be nullptr.");
   common::SharedLatch::ScopedExclusiveLatch guard(&indexes_latch_);
-  NOISEPAGE_ASSERT(indexes_.count(index) == 1, "Trying to unregister an index that has not been registered.");
-  indexes_.erase(index);
+  const auto it = std::find_if(indexes_.begin(), indexes_.end(),
+                               [=](const RegisteredIndex &registered) { return registered.index_ == index; });
+  NOISEPAGE_ASSERT(it != indexes_.end(), "Trying to unregister an index that has not been registered.");
+  const auto position = static_cast<size_t>(it - indexes_.begin());
+  indexes_.erase(it);
+  // Keep the next invocation starting at the same index
+  if (position < next_index_) next_index_--;
+  if (next_index_ >= indexes_.size()) next_index_ = 0;
+  if (index_maintenance_interval_.count() > 0) index->StopBackgroundMaintenance();
 }
 
-void GarbageCollector::ProcessIndexes() {
+void GarbageCollector::ProcessIndexes(std::vector<IndexMaintenanceData> *const maintenance_data) {
   common::SharedLatch::ScopedSharedLatch guard(&indexes_latch_);
-  for (const auto &index : indexes_) index->PerformGarbageCollection();
+  const auto start = std::chrono::steady_clock::now();
+  bool visited_any = false;
+  for (size_t i = 0; i < indexes_.size(); i++) {
+    const size_t position = (next_index_ + i) % indexes_.size();
+    auto &registered = indexes_[position];
+    const auto index = registered.index_;
+    uint64_t modifications = 0;
+    uint64_t gc_elapsed_us = 0;
+    if (registered.passes_left_ > 0 || index->GetNumModifications() > 0) {
+      // Always make progress on one index, even if a single index takes longer than the budget
+      if (visited_any && std::chrono::steady_clock::now() - start >= INDEX_GC_BUDGET) {
+        next_index_ = position;
+        break;
+      }
+      visited_any = true;
+      modifications = index->TakeModifications();
+      {
+        common::ScopedTimer<std::chrono::microseconds> timer(&gc_elapsed_us);
+        index->PerformGarbageCollection();
+      }
+      registered.passes_left_ = modifications > 0 ? INDEX_GC_PASSES - 1 : registered.passes_left_ - 1;
+      next_index_ = (position + 1) % indexes_.size();
+    }
+    if (maintenance_data == nullptr) continue;
+    // Consolidations happen on every index access, so they are collected from the indexes that were not visited too
+    const auto stats = index->CollectMaintenanceStats();
+    if (stats.consolidations_ > 0 || modifications > 0) {
+      maintenance_data->push_back(
+          {index->Type(), index->GetSize(), index->EstimateHeapUsage(), stats, modifications, gc_elapsed_us});
+    }
+  }
 }
 
 }  // namespace noisepage::storage
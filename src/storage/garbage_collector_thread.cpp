@@ -5,15 +5,18 @@
 namespace noisepage::storage {
 GarbageCollectorThread::GarbageCollectorThread(common::ManagedPointer<GarbageCollector> gc,
                                                std::chrono::microseconds gc_period,
-                                               common::ManagedPointer<metrics::MetricsManager> metrics_manager)
+                                               common::ManagedPointer<metrics::MetricsManager> metrics_manager,
+                                               common::ManagedPointer<common::ThreadPlacement> thread_placement)
     : gc_(gc),
       metrics_manager_(metrics_manager),
+      thread_placement_(thread_placement),
       run_gc_(true),
       gc_paused_(false),
       gc_period_(gc_period),
       gc_thread_(std::thread([this] {
+        if (thread_placement_ != nullptr) thread_placement_->Apply(common::ThreadRole::GARBAGE_COLLECTION);
         if (metrics_manager_ != DISABLED) metrics_manager_->RegisterThread();
-        gc_->SetGCInterval(gc_period_.count());
+        gc_->SetGCInterval(gc_period_.load().count());
         GCThreadLoop();
       })) {}
 
@@ -0,0 +1,999 @@
+#include "storage/index/adaptive_radix_tree.h"
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace noisepage::storage::index {
+
+namespace {
+
+// Number of prefix bytes that an inner node stores. A longer prefix is only stored by its length, and its other bytes
+// are read from a leaf below the node when they are needed (the hybrid scheme of the ART paper).
+constexpr uint32_t MAX_STORED_PREFIX = 8;
+
+// Layout of the version of an inner node: bit 0 marks an obsolete node, bit 1 a locked node, and the other bits count
+// the times the node was unlocked
+constexpr uint64_t OBSOLETE_BIT = 0b01;
+constexpr uint64_t LOCKED_BIT = 0b10;
+
+// Child pointers to leaves have their lowest bit set
+constexpr uintptr_t LEAF_TAG = 1;
+
+// Marks a byte without a child in a Node48
+constexpr uint8_t EMPTY_INDEX = 0xFF;
+
+enum class NodeType : uint8_t { NODE4, NODE16, NODE48, NODE256 };
+
+}  // namespace
+
+/**
+ * Header of all inner nodes. Readers may read any field while a writer changes it, so every read must be validated
+ * against the version before its result is used.
+ */
+struct AdaptiveRadixTree::Node {
+  Node(const NodeType type, const uint8_t *const prefix, const uint32_t prefix_len)
+      : type_(type), prefix_len_(prefix_len) {
+    if (prefix_len > 0) std::memcpy(prefix_, prefix, std::min(prefix_len, MAX_STORED_PREFIX));
+  }
+
+  // Returns the version to validate reads against, and restarts if a writer holds the node or unlinked it
+  uint64_t ReadLockOrRestart(bool *const restart) const {
+    const uint64_t version = version_.load();
+    if ((version & (LOCKED_BIT | OBSOLETE_BIT)) != 0) *restart = true;
+    return version;
+  }
+
+  // Restarts if the node changed since the version was read
+  void CheckOrRestart(const uint64_t version, bool *const restart) const {
+    if (version_.load() != version) *restart = true;
+  }
+
+  // Locks the node, and restarts if it changed since the version was read
+  void UpgradeToWriteLockOrRestart(uint64_t version, bool *const restart) {
+    if (!version_.compare_exchange_strong(version, version + LOCKED_BIT)) *restart = true;
+  }
+
+  void WriteLockOrRestart(bool *const restart) {
+    const uint64_t version = ReadLockOrRestart(restart);
+    if (!*restart) UpgradeToWriteLockOrRestart(version, restart);
+  }
+
+  void WriteUnlock() { version_.fetch_add(LOCKED_BIT); }
+
+  void WriteUnlockObsolete() { version_.fetch_add(LOCKED_BIT | OBSOLETE_BIT); }
+
+  uint32_t Capacity() const {
+    switch (type_) {
+      case NodeType::NODE4:
+        return 4;
+      case NodeType::NODE16:
+        return 16;
+      case NodeType::NODE48:
+        return 48;
+      default:
+        return 256;
+    }
+  }
+
+  bool IsFull() const { return num_children_ == Capacity(); }
+
+  // Whether the node has to shrink (or, for a Node4, be replaced by its other child) once a child is removed
+  bool UnderflowsOnRemove() const {
+    switch (type_) {
+      case NodeType::NODE4:
+        return num_children_ <= 2;
+      case NodeType::NODE16:
+        return num_children_ <= 4;
+      case NodeType::NODE48:
+        return num_children_ <= 13;
+      default:
+        return num_children_ <= 38;
+    }
+  }
+
+  // Whether the stored bytes of the prefix match the key. Bytes of a longer prefix that are not stored are checked
+  // against the whole key at the leaf.
+  bool PrefixMatches(const uint8_t *const key, const uint32_t key_len, const uint32_t depth,
+                     const uint32_t prefix_len) const {
+    const uint32_t stored_len = std::min(prefix_len, MAX_STORED_PREFIX);
+    if (depth + stored_len > key_len) return false;
+    return std::memcmp(prefix_, key + depth, stored_len) == 0;
+  }
+
+  // Prepends the prefix of the parent and the byte this node is found under in the parent to the prefix of the node
+  void PrependPrefix(const Node *const parent, const uint8_t key_byte) {
+    uint8_t prefix[MAX_STORED_PREFIX];
+    const uint32_t parent_stored_len = std::min(parent->prefix_len_, MAX_STORED_PREFIX);
+    std::memcpy(prefix, parent->prefix_, parent_stored_len);
+    if (parent_stored_len < MAX_STORED_PREFIX) {
+      prefix[parent_stored_len] = key_byte;
+      const uint32_t stored_len = std::min(prefix_len_, MAX_STORED_PREFIX - parent_stored_len - 1);
+      std::memcpy(prefix + parent_stored_len + 1, prefix_, stored_len);
+    }
+    std::memcpy(prefix_, prefix, MAX_STORED_PREFIX);
+    prefix_len_ += parent->prefix_len_ + 1;
+  }
+
+  // Number of positions that ChildAt iterates over
+  uint32_t NumPositions() const {
+    switch (type_) {
+      case NodeType::NODE4:
+      case NodeType::NODE16:
+        return std::min<uint32_t>(num_children_, Capacity());
+      default:
+        return 256;
+    }
+  }
+
+  Node *ChildAt(uint32_t position, uint8_t *key_byte) const;
+  Node *AnyChild() const;
+  Node **FindChild(uint8_t key_byte);
+  Node *GetChild(const uint8_t key_byte) {
+    Node **const child = FindChild(key_byte);
+    return child == nullptr ? nullptr : *child;
+  }
+  void ReplaceChild(const uint8_t key_byte, Node *const child) {
+    Node **const slot = FindChild(key_byte);
+    NOISEPAGE_ASSERT(slot != nullptr, "Replaced child must exist.");
+    *slot = child;
+  }
+  void AddChild(uint8_t key_byte, Node *child);
+  void RemoveChild(uint8_t key_byte);
+  Node *Grow() const;
+  Node *Shrink(uint8_t removed_key_byte) const;
+  void CopyChildrenTo(Node *node, int32_t skipped_key_byte) const;
+
+  // Number of bytes allocated for an inner node or a leaf
+  static size_t SizeOf(const Node *node);
+
+  std::atomic<uint64_t> version_ = 0;
+  const NodeType type_;
+  uint16_t num_children_ = 0;
+  uint32_t prefix_len_;
+  uint8_t prefix_[MAX_STORED_PREFIX];
+};
+
+/**
+ * Inner node with up to 4 children, kept sorted by key byte.
+ */
+struct AdaptiveRadixTree::Node4 : public Node {
+  Node4(const uint8_t *const prefix, const uint32_t prefix_len) : Node(NodeType::NODE4, prefix, prefix_len) {}
+  uint8_t keys_[4] = {};
+  Node *children_[4] = {};
+};
+
+/**
+ * Inner node with up to 16 children, kept sorted by key byte and searched with SSE2.
+ */
+struct AdaptiveRadixTree::Node16 : public Node {
+  Node16(const uint8_t *const prefix, const uint32_t prefix_len) : Node(NodeType::NODE16, prefix, prefix_len) {}
+  uint8_t keys_[16] = {};
+  Node *children_[16] = {};
+};
+
+/**
+ * Inner node with up to 48 children, indexed by key byte through a 256 entry array.
+ */
+struct AdaptiveRadixTree::Node48 : public Node {
+  Node48(const uint8_t *const prefix, const uint32_t prefix_len) : Node(NodeType::NODE48, prefix, prefix_len) {
+    std::memset(child_index_, EMPTY_INDEX, sizeof(child_index_));
+  }
+  uint8_t child_index_[256];
+  Node *children_[48] = {};
+};
+
+/**
+ * Inner node with a child for every key byte.
+ */
+struct AdaptiveRadixTree::Node256 : public Node {
+  Node256(const uint8_t *const prefix, const uint32_t prefix_len) : Node(NodeType::NODE256, prefix, prefix_len) {}
+  Node *children_[256] = {};
+};
+
+/**
+ * Immutable leaf, followed in memory by its values and then by its key bytes. Leaves are linked into their parents as
+ * tagged Node pointers.
+ */
+struct AdaptiveRadixTree::Leaf {
+  static bool IsLeaf(const Node *const node) { return (reinterpret_cast<uintptr_t>(node) & LEAF_TAG) != 0; }
+  static const Leaf *FromNode(const Node *const node) {
+    return reinterpret_cast<const Leaf *>(reinterpret_cast<uintptr_t>(node) & ~LEAF_TAG);
+  }
+  static size_t AllocationSize(const uint32_t key_len, const uint32_t num_values) {
+    return sizeof(Leaf) + num_values * sizeof(TupleSlot) + key_len;
+  }
+
+  // Allocates a leaf whose values the caller fills in
+  static Leaf *Allocate(const uint8_t *const key, const uint32_t key_len, const uint32_t num_values) {
+    auto *const leaf = static_cast<Leaf *>(::operator new(AllocationSize(key_len, num_values)));
+    leaf->key_len_ = key_len;
+    leaf->num_values_ = num_values;
+    std::memcpy(leaf->Key(), key, key_len);
+    return leaf;
+  }
+
+  Node *ToNode() { return reinterpret_cast<Node *>(reinterpret_cast<uintptr_t>(this) | LEAF_TAG); }
+  TupleSlot *Values() { return reinterpret_cast<TupleSlot *>(this + 1); }
+  const TupleSlot *Values() const { return reinterpret_cast<const TupleSlot *>(this + 1); }
+  uint8_t *Key() { return reinterpret_cast<uint8_t *>(Values() + num_values_); }
+  const uint8_t *Key() const { return reinterpret_cast<const uint8_t *>(Values() + num_values_); }
+  bool KeyEquals(const uint8_t *const key, const uint32_t key_len) const {
+    return key_len_ == key_len && std::memcmp(Key(), key, key_len) == 0;
+  }
+  size_t Size() const { return AllocationSize(key_len_, num_values_); }
+
+  uint32_t key_len_;
+  uint32_t num_values_;
+};
+
+/**
+ * Bounds and output of a scan. The bounds move past the keys already scanned when the scan restarts.
+ */
+struct AdaptiveRadixTree::ScanState {
+  bool ascending_;
+  const uint8_t *low_key_;
+  uint32_t low_key_len_;
+  // Whether the low key itself is out of the bounds
+  bool low_exclusive_;
+  const uint8_t *high_key_;
+  uint32_t high_key_len_;
+  // Whether only the first high_key_len_ bytes of a key are compared against the high key
+  bool high_is_prefix_;
+  // Whether the high key itself is out of the bounds
+  bool high_exclusive_;
+  uint32_t limit_;
+  const std::function<bool(TupleSlot)> *predicate_;
+  std::vector<TupleSlot> *values_;
+  // Last leaf whose values were all appended
+  const Leaf *last_leaf_;
+};
+
+AdaptiveRadixTree::Node *AdaptiveRadixTree::Node::ChildAt(const uint32_t position, uint8_t *const key_byte) const {
+  switch (type_) {
+    case NodeType::NODE4: {
+      const auto *const node = static_cast<const Node4 *>(this);
+      *key_byte = node->keys_[position];
+      return node->children_[position];
+    }
+    case NodeType::NODE16: {
+      const auto *const node = static_cast<const Node16 *>(this);
+      *key_byte = node->keys_[position];
+      return node->children_[position];
+    }
+    case NodeType::NODE48: {
+      const auto *const node = static_cast<const Node48 *>(this);
+      *key_byte = static_cast<uint8_t>(position);
+      const uint8_t index = node->child_index_[position];
+      return index < 48 ? node->children_[index] : nullptr;
+    }
+    default: {
+      *key_byte = static_cast<uint8_t>(position);
+      return static_cast<const Node256 *>(this)->children_[position];
+    }
+  }
+}
+
+AdaptiveRadixTree::Node *AdaptiveRadixTree::Node::AnyChild() const {
+  const uint32_t num_positions = NumPositions();
+  for (uint32_t position = 0; position < num_positions; position++) {
+    uint8_t key_byte;
+    Node *const child = ChildAt(position, &key_byte);
+    if (child != nullptr) return child;
+  }
+  return nullptr;
+}
+
+AdaptiveRadixTree::Node **AdaptiveRadixTree::Node::FindChild(const uint8_t key_byte) {
+  switch (type_) {
+    case NodeType::NODE4: {
+      auto *const node = static_cast<Node4 *>(this);
+      const uint32_t num_children = std::min<uint32_t>(num_children_, 4);
+      for (uint32_t i = 0; i < num_children; i++) {
+        if (node->keys_[i] == key_byte) return &node->children_[i];
+      }
+      return nullptr;
+    }
+    case NodeType::NODE16: {
+      auto *const node = static_cast<Node16 *>(this);
+      const uint32_t num_children = std::min<uint32_t>(num_children_, 16);
+      const __m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(key_byte)),
+                                             _mm_loadu_si128(reinterpret_cast<const __m128i *>(node->keys_)));
+      const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(matches)) & ((1U << num_children) - 1);
+      return mask == 0 ? nullptr : &node->children_[__builtin_ctz(mask)];
+    }
+    case NodeType::NODE48: {
+      auto *const node = static_cast<Node48 *>(this);
+      const uint8_t index = node->child_index_[key_byte];
+      return index < 48 ? &node->children_[index] : nullptr;
+    }
+    default: {
+      auto *const node = static_cast<Node256 *>(this);
+      return node->children_[key_byte] == nullptr ? nullptr : &node->children_[key_byte];
+    }
+  }
+}
+
+void AdaptiveRadixTree::Node::AddChild(const uint8_t key_byte, Node *const child) {
+  NOISEPAGE_ASSERT(!IsFull(), "Node must have room for the child.");
+  switch (type_) {
+    case NodeType::NODE4:
+    case NodeType::NODE16: {
+      uint8_t *const keys =
+          type_ == NodeType::NODE4 ? static_cast<Node4 *>(this)->keys_ : static_cast<Node16 *>(this)->keys_;
+      Node **const children =
+          type_ == NodeType::NODE4 ? static_cast<Node4 *>(this)->children_ : static_cast<Node16 *>(this)->children_;
+      uint32_t position = 0;
+      while (position < num_children_ && keys[position] < key_byte) position++;
+      std::memmove(keys + position + 1, keys + position, num_children_ - position);
+      std::memmove(children + position + 1, children + position, (num_children_ - position) * sizeof(Node *));
+      keys[position] = key_byte;
+      children[position] = child;
+      break;
+    }
+    case NodeType::NODE48: {
+      auto *const node = static_cast<Node48 *>(this);
+      uint8_t index = 0;
+      while (node->children_[index] != nullptr) index++;
+      node->children_[index] = child;
+      node->child_index_[key_byte] = index;
+      break;
+    }
+    default:
+      static_cast<Node256 *>(this)->children_[key_byte] = child;
+      break;
+  }
+  num_children_++;
+}
+
+void AdaptiveRadixTree::Node::RemoveChild(const uint8_t key_byte) {
+  switch (type_) {
+    case NodeType::NODE4:
+    case NodeType::NODE16: {
+      uint8_t *const keys =
+          type_ == NodeType::NODE4 ? static_cast<Node4 *>(this)->keys_ : static_cast<Node16 *>(this)->keys_;
+      Node **const children =
+          type_ == NodeType::NODE4 ? static_cast<Node4 *>(this)->children_ : static_cast<Node16 *>(this)->children_;
+      uint32_t position = 0;
+      while (keys[position] != key_byte) position++;
+      NOISEPAGE_ASSERT(position < num_children_, "Removed child must exist.");
+      std::memmove(keys + position, keys + position + 1, num_children_ - position - 1);
+      std::memmove(children + position, children + position + 1, (num_children_ - position - 1) * sizeof(Node *));
+      break;
+    }
+    case NodeType::NODE48: {
+      auto *const node = static_cast<Node48 *>(this);
+      node->children_[node->child_index_[key_byte]] = nullptr;
+      node->child_index_[key_byte] = EMPTY_INDEX;
+      break;
+    }
+    default:
+      static_cast<Node256 *>(this)->children_[key_byte] = nullptr;
+      break;
+  }
+  num_children_--;
+}
+
+void AdaptiveRadixTree::Node::CopyChildrenTo(Node *const node, const int32_t skipped_key_byte) const {
+  const uint32_t num_positions = NumPositions();
+  for (uint32_t position = 0; position < num_positions; position++) {
+    uint8_t key_byte;
+    Node *const child = ChildAt(position, &key_byte);
+    if (child != nullptr && key_byte != skipped_key_byte) node->AddChild(key_byte, child);
+  }
+}
+
+AdaptiveRadixTree::Node *AdaptiveRadixTree::Node::Grow() const {
+  Node *bigger;
+  switch (type_) {
+    case NodeType::NODE4:
+      bigger = new Node16(prefix_, prefix_len_);
+      break;
+    case NodeType::NODE16:
+      bigger = new Node48(prefix_, prefix_len_);
+      break;
+    default:
+      NOISEPAGE_ASSERT(type_ == NodeType::NODE48, "A Node256 cannot grow.");
+      bigger = new Node256(prefix_, prefix_len_);
+      break;
+  }
+  CopyChildrenTo(bigger, -1);
+  return bigger;
+}
+
+AdaptiveRadixTree::Node *AdaptiveRadixTree::Node::Shrink(const uint8_t removed_key_byte) const {
+  Node *smaller;
+  switch (type_) {
+    case NodeType::NODE16:
+      smaller = new Node4(prefix_, prefix_len_);
+      break;
+    case NodeType::NODE48:
+      smaller = new Node16(prefix_, prefix_len_);
+      break;
+    default:
+      NOISEPAGE_ASSERT(type_ == NodeType::NODE256, "A Node4 cannot shrink.");
+      smaller = new Node48(prefix_, prefix_len_);
+      break;
+  }
+  CopyChildrenTo(smaller, removed_key_byte);
+  return smaller;
+}
+
+size_t AdaptiveRadixTree::Node::SizeOf(const Node *const node) {
+  if (Leaf::IsLeaf(node)) return Leaf::FromNode(node)->Size();
+  switch (node->type_) {
+    case NodeType::NODE4:
+      return sizeof(Node4);
+    case NodeType::NODE16:
+      return sizeof(Node16);
+    case NodeType::NODE48:
+      return sizeof(Node48);
+    default:
+      return sizeof(Node256);
+  }
+}
+
+AdaptiveRadixTree::AdaptiveRadixTree() : root_(new Node256(nullptr, 0)) {}
+
+AdaptiveRadixTree::~AdaptiveRadixTree() { FreeSubtree(root_); }
+
+void AdaptiveRadixTree::FreeNode(Node *const node) {
+  if (Leaf::IsLeaf(node)) {
+    ::operator delete(const_cast<Leaf *>(Leaf::FromNode(node)));
+    return;
+  }
+  switch (node->type_) {
+    case NodeType::NODE4:
+      delete static_cast<Node4 *>(node);
+      break;
+    case NodeType::NODE16:
+      delete static_cast<Node16 *>(node);
+      break;
+    case NodeType::NODE48:
+      delete static_cast<Node48 *>(node);
+      break;
+    default:
+      delete static_cast<Node256 *>(node);
+      break;
+  }
+}
+
+void AdaptiveRadixTree::FreeSubtree(Node *const node) {
+  if (!Leaf::IsLeaf(node)) {
+    const uint32_t num_positions = node->NumPositions();
+    for (uint32_t position = 0; position < num_positions; position++) {
+      uint8_t key_byte;
+      Node *const child = node->ChildAt(position, &key_byte);
+      if (child != nullptr) FreeSubtree(child);
+    }
+  }
+  FreeNode(node);
+}
+
+AdaptiveRadixTree::Node *AdaptiveRadixTree::TrackNode(Node *const node) {
+  heap_usage_.fetch_add(Node::SizeOf(node));
+  return node;
+}
+
+void AdaptiveRadixTree::Retire(Node *const node) {
+  heap_usage_.fetch_sub(Node::SizeOf(node));
+  reclaimer_.Retire(node);
+}
+
+AdaptiveRadixTree::Node *AdaptiveRadixTree::NewLeaf(const uint8_t *const key, const uint32_t key_len,
+                                                    const TupleSlot value) {
+  Leaf *const leaf = Leaf::Allocate(key, key_len, 1);
+  leaf->Values()[0] = value;
+  return TrackNode(leaf->ToNode());
+}
+
+AdaptiveRadixTree::Node *AdaptiveRadixTree::NewLeafWith(const Leaf *const leaf, const TupleSlot value) {
+  Leaf *const new_leaf = Leaf::Allocate(leaf->Key(), leaf->key_len_, leaf->num_values_ + 1);
+  std::copy(leaf->Values(), leaf->Values() + leaf->num_values_, new_leaf->Values());
+  new_leaf->Values()[leaf->num_values_] = value;
+  return TrackNode(new_leaf->ToNode());
+}
+
+AdaptiveRadixTree::Node *AdaptiveRadixTree::NewLeafWithout(const Leaf *const leaf, const TupleSlot value) {
+  Leaf *const new_leaf = Leaf::Allocate(leaf->Key(), leaf->key_len_, leaf->num_values_ - 1);
+  std::remove_copy(leaf->Values(), leaf->Values() + leaf->num_values_, new_leaf->Values(), value);
+  return TrackNode(new_leaf->ToNode());
+}
+
+bool AdaptiveRadixTree::Insert(const byte *const key, const uint32_t key_len, const TupleSlot value,
+                               const std::function<bool(TupleSlot)> &predicate) {
+  NodeReclaimer<Node>::ReadGuard guard(&reclaimer_);
+  bool inserted = false;
+  while (!TryInsert(reinterpret_cast<const uint8_t *>(key), key_len, value, predicate, &inserted)) {
+  }
+  return inserted;
+}
+
+bool AdaptiveRadixTree::TryInsert(const uint8_t *const key, const uint32_t key_len, const TupleSlot value,
+                                  const std::function<bool(TupleSlot)> &predicate, bool *const inserted) {
+  bool restart = false;
+  Node *parent = nullptr;
+  uint64_t parent_version = 0;
+  uint8_t parent_key_byte = 0;
+  Node *node = root_;
+  uint64_t version = node->ReadLockOrRestart(&restart);
+  if (restart) return false;
+  uint32_t depth = 0;
+
+  while (true) {
+    const uint32_t prefix_len = node->prefix_len_;
+    if (prefix_len > 0) {
+      // Find where the key leaves the prefix. The bytes of a long prefix that the node does not store are the same in
+      // every key below it, so any leaf below it has them.
+      uint8_t stored_prefix[MAX_STORED_PREFIX];
+      const uint8_t *prefix = stored_prefix;
+      if (prefix_len <= MAX_STORED_PREFIX) {
+        std::memcpy(stored_prefix, node->prefix_, prefix_len);
+      } else {
+        Node *descendant = node;
+        uint64_t descendant_version = version;
+        while (!Leaf::IsLeaf(descendant)) {
+          Node *const child = descendant->AnyChild();
+          descendant->CheckOrRestart(descendant_version, &restart);
+          if (restart || child == nullptr) return false;
+          if (!Leaf::IsLeaf(child)) {
+            const uint64_t child_version = child->ReadLockOrRestart(&restart);
+            if (restart) return false;
+            descendant->CheckOrRestart(descendant_version, &restart);
+            if (restart) return false;
+            descendant_version = child_version;
+          }
+          descendant = child;
+        }
+        prefix = Leaf::FromNode(descendant)->Key() + depth;
+      }
+      node->CheckOrRestart(version, &restart);
+      if (restart) return false;
+
+      uint32_t mismatch = 0;
+      while (mismatch < prefix_len && depth + mismatch < key_len && prefix[mismatch] == key[depth + mismatch]) {
+        mismatch++;
+      }
+      if (mismatch < prefix_len) {
+        NOISEPAGE_ASSERT(depth + mismatch < key_len, "No key may be a prefix of another key.");
+        // Split the prefix: a new node holds the matching part, and branches to the node and to the new leaf
+        parent->UpgradeToWriteLockOrRestart(parent_version, &restart);
+        if (restart) return false;
+        node->UpgradeToWriteLockOrRestart(version, &restart);
+        if (restart) {
+          parent->WriteUnlock();
+          return false;
+        }
+        Node *const new_node = TrackNode(new Node4(prefix, mismatch));
+        new_node->AddChild(prefix[mismatch], node);
+        new_node->AddChild(key[depth + mismatch], NewLeaf(key, key_len, value));
+        const uint32_t remaining_prefix_len = prefix_len - mismatch - 1;
+        std::memmove(node->prefix_, prefix + mismatch + 1, std::min(remaining_prefix_len, MAX_STORED_PREFIX));
+        node->prefix_len_ = remaining_prefix_len;
+        parent->ReplaceChild(parent_key_byte, new_node);
+        node->WriteUnlock();
+        parent->WriteUnlock();
+        num_keys_.fetch_add(1);
+        *inserted = true;
+        return true;
+      }
+      depth += prefix_len;
+    }
+
+    NOISEPAGE_ASSERT(depth < key_len, "No key may be a prefix of another key.");
+    const uint8_t key_byte = key[depth];
+    Node *const child = node->GetChild(key_byte);
+    node->CheckOrRestart(version, &restart);
+    if (restart) return false;
+
+    if (child == nullptr) {
+      if (!node->IsFull()) {
+        node->UpgradeToWriteLockOrRestart(version, &restart);
+        if (restart) return false;
+        node->AddChild(key_byte, NewLeaf(key, key_len, value));
+        node->WriteUnlock();
+      } else {
+        // Replace the node with a bigger copy, which needs the parent's lock to link it
+        parent->UpgradeToWriteLockOrRestart(parent_version, &restart);
+        if (restart) return false;
+        node->UpgradeToWriteLockOrRestart(version, &restart);
+        if (restart) {
+          parent->WriteUnlock();
+          return false;
+        }
+        Node *const bigger = TrackNode(node->Grow());
+        bigger->AddChild(key_byte, NewLeaf(key, key_len, value));
+        parent->ReplaceChild(parent_key_byte, bigger);
+        node->WriteUnlockObsolete();
+        parent->WriteUnlock();
+        Retire(node);
+      }
+      num_keys_.fetch_add(1);
+      *inserted = true;
+      return true;
+    }
+
+    if (Leaf::IsLeaf(child)) {
+      const Leaf *const leaf = Leaf::FromNode(child);
+      if (leaf->KeyEquals(key, key_len)) {
+        // Replace the leaf with a copy that has the value too. The node's lock keeps other writers of the key out, so
+        // checking the predicate and adding the value is atomic.
+        node->UpgradeToWriteLockOrRestart(version, &restart);
+        if (restart) return false;
+        for (uint32_t i = 0; i < leaf->num_values_; i++) {
+          if (leaf->Values()[i] == value || predicate(leaf->Values()[i])) {
+            node->WriteUnlock();
+            *inserted = false;
+            return true;
+          }
+        }
+        node->ReplaceChild(key_byte, NewLeafWith(leaf, value));
+        node->WriteUnlock();
+        Retire(child);
+        *inserted = true;
+        return true;
+      }
+
+      // Replace the leaf with a new node that branches to it and to the new leaf where the keys first differ
+      node->UpgradeToWriteLockOrRestart(version, &restart);
+      if (restart) return false;
+      const uint8_t *const leaf_key = leaf->Key();
+      const uint32_t common_len = std::min(key_len, leaf->key_len_) - depth - 1;
+      uint32_t prefix_len = 0;
+      while (prefix_len < common_len && key[depth + 1 + prefix_len] == leaf_key[depth + 1 + prefix_len]) prefix_len++;
+      NOISEPAGE_ASSERT(prefix_len < common_len, "No key may be a prefix of another key.");
+      Node *const new_node = TrackNode(new Node4(key + depth + 1, prefix_len));
+      new_node->AddChild(leaf_key[depth + 1 + prefix_len], child);
+      new_node->AddChild(key[depth + 1 + prefix_len], NewLeaf(key, key_len, value));
+      node->ReplaceChild(key_byte, new_node);
+      node->WriteUnlock();
+      num_keys_.fetch_add(1);
+      *inserted = true;
+      return true;
+    }
+
+    const uint64_t child_version = child->ReadLockOrRestart(&restart);
+    if (restart) return false;
+    node->CheckOrRestart(version, &restart);
+    if (restart) return false;
+    parent = node;
+    parent_version = version;
+    parent_key_byte = key_byte;
+    node = child;
+    version = child_version;
+    depth++;
+  }
+}
+
+bool AdaptiveRadixTree::Delete(const byte *const key, const uint32_t key_len, const TupleSlot value) {
+  NodeReclaimer<Node>::ReadGuard guard(&reclaimer_);
+  bool deleted = false;
+  while (!TryDelete(reinterpret_cast<const uint8_t *>(key), key_len, value, &deleted)) {
+  }
+  return deleted;
+}
+
+bool AdaptiveRadixTree::TryDelete(const uint8_t *const key, const uint32_t key_len, const TupleSlot value,
+                                  bool *const deleted) {
+  bool restart = false;
+  Node *parent = nullptr;
+  uint64_t parent_version = 0;
+  uint8_t parent_key_byte = 0;
+  Node *node = root_;
+  uint64_t version = node->ReadLockOrRestart(&restart);
+  if (restart) return false;
+  uint32_t depth = 0;
+  *deleted = false;
+
+  while (true) {
+    const uint32_t prefix_len = node->prefix_len_;
+    const bool prefix_matches = node->PrefixMatches(key, key_len, depth, prefix_len);
+    node->CheckOrRestart(version, &restart);
+    if (restart) return false;
+    depth += prefix_len;
+    if (!prefix_matches || depth >= key_len) return true;
+
+    const uint8_t key_byte = key[depth];
+    Node *const child = node->GetChild(key_byte);
+    node->CheckOrRestart(version, &restart);
+    if (restart) return false;
+    if (child == nullptr) return true;
+
+    if (Leaf::IsLeaf(child)) {
+      const Leaf *const leaf = Leaf::FromNode(child);
+      if (!leaf->KeyEquals(key, key_len) ||
+          std::find(leaf->Values(), leaf->Values() + leaf->num_values_, value) == leaf->Values() + leaf->num_values_) {
+        return true;
+      }
+
+      if (leaf->num_values_ > 1) {
+        // The key keeps its other values
+        node->UpgradeToWriteLockOrRestart(version, &restart);
+        if (restart) return false;
+        node->ReplaceChild(key_byte, NewLeafWithout(leaf, value));
+        node->WriteUnlock();
+      } else if (node == root_ || !node->UnderflowsOnRemove()) {
+        node->UpgradeToWriteLockOrRestart(version, &restart);
+        if (restart) return false;
+        node->RemoveChild(key_byte);
+        node->WriteUnlock();
+        num_keys_.fetch_sub(1);
+      } else {
+        // Replace the node with a smaller copy, or a Node4 with its other child, which needs the parent's lock
+        parent->UpgradeToWriteLockOrRestart(parent_version, &restart);
+        if (restart) return false;
+        node->UpgradeToWriteLockOrRestart(version, &restart);
+        if (restart) {
+          parent->WriteUnlock();
+          return false;
+        }
+        if (node->type_ == NodeType::NODE4) {
+          const auto *const node4 = static_cast<const Node4 *>(node);
+          const uint32_t other_position = node4->keys_[0] == key_byte ? 1 : 0;
+          Node *const other_child = node4->children_[other_position];
+          if (!Leaf::IsLeaf(other_child)) {
+            // The other child takes over the node's prefix, which readers of the child notice by its version
+            other_child->WriteLockOrRestart(&restart);
+            if (restart) {
+              node->WriteUnlock();
+              parent->WriteUnlock();
+              return false;
+            }
+            other_child->PrependPrefix(node, node4->keys_[other_position]);
+            other_child->WriteUnlock();
+          }
+          parent->ReplaceChild(parent_key_byte, other_child);
+        } else {
+          parent->ReplaceChild(parent_key_byte, TrackNode(node->Shrink(key_byte)));
+        }
+        node->WriteUnlockObsolete();
+        parent->WriteUnlock();
+        Retire(node);
+        num_keys_.fetch_sub(1);
+      }
+      Retire(child);
+      *deleted = true;
+      return true;
+    }
+
+    const uint64_t child_version = child->ReadLockOrRestart(&restart);
+    if (restart) return false;
+    node->CheckOrRestart(version, &restart);
+    if (restart) return false;
+    parent = node;
+    parent_version = version;
+    parent_key_byte = key_byte;
+    node = child;
+    version = child_version;
+    depth++;
+  }
+}
+
+void AdaptiveRadixTree::Lookup(const byte *const key, const uint32_t key_len, std::vector<TupleSlot> *const values) {
+  NodeReclaimer<Node>::ReadGuard guard(&reclaimer_);
+  while (!TryLookup(reinterpret_cast<const uint8_t *>(key), key_len, values)) {
+  }
+}
+
+bool AdaptiveRadixTree::TryLookup(const uint8_t *const key, const uint32_t key_len,
+                                  std::vector<TupleSlot> *const values) {
+  bool restart = false;
+  Node *node = root_;
+  uint64_t version = node->ReadLockOrRestart(&restart);
+  if (restart) return false;
+  uint32_t depth = 0;
+
+  while (true) {
+    const uint32_t prefix_len = node->prefix_len_;
+    const bool prefix_matches = node->PrefixMatches(key, key_len, depth, prefix_len);
+    node->CheckOrRestart(version, &restart);
+    if (restart) return false;
+    depth += prefix_len;
+    if (!prefix_matches || depth >= key_len) return true;
+
+    Node *const child = node->GetChild(key[depth]);
+    node->CheckOrRestart(version, &restart);
+    if (restart) return false;
+    if (child == nullptr) return true;
+
+    if (Leaf::IsLeaf(child)) {
+      const Leaf *const leaf = Leaf::FromNode(child);
+      if (leaf->KeyEquals(key, key_len)) {
+        values->insert(values->end(), leaf->Values(), leaf->Values() + leaf->num_values_);
+      }
+      return true;
+    }
+
+    const uint64_t child_version = child->ReadLockOrRestart(&restart);
+    if (restart) return false;
+    node->CheckOrRestart(version, &restart);
+    if (restart) return false;
+    node = child;
+    version = child_version;
+    depth++;
+  }
+}
+
+void AdaptiveRadixTree::ScanAscending(const byte *const low_key, const uint32_t low_key_len, const byte *const high_key,
+                                      const uint32_t high_key_len, const uint32_t limit,
+                                      const std::function<bool(TupleSlot)> &predicate,
+                                      std::vector<TupleSlot> *const values) {
+  ScanState state{true,
+                  reinterpret_cast<const uint8_t *>(low_key),
+                  low_key_len,
+                  false,
+                  reinterpret_cast<const uint8_t *>(high_key),
+                  high_key_len,
+                  true,
+                  false,
+                  limit,
+                  &predicate,
+                  values,
+                  nullptr};
+  Scan(&state);
+}
+
+void AdaptiveRadixTree::ScanDescending(const byte *const low_key, const uint32_t low_key_len,
+                                       const byte *const high_key, const uint32_t high_key_len, const uint32_t limit,
+                                       const std::function<bool(TupleSlot)> &predicate,
+                                       std::vector<TupleSlot> *const values) {
+  ScanState state{false,
+                  reinterpret_cast<const uint8_t *>(low_key),
+                  low_key_len,
+                  false,
+                  reinterpret_cast<const uint8_t *>(high_key),
+                  high_key_len,
+                  true,
+                  false,
+                  limit,
+                  &predicate,
+                  values,
+                  nullptr};
+  Scan(&state);
+}
+
+void AdaptiveRadixTree::Scan(ScanState *const state) {
+  // The guard spans the restarts, so that the last leaf scanned stays readable
+  NodeReclaimer<Node>::ReadGuard guard(&reclaimer_);
+  while (true) {
+    bool restart = false;
+    const uint64_t version = root_->ReadLockOrRestart(&restart);
+    if (!restart && ScanNode(root_, version, 0, state->low_key_ != nullptr, state->high_key_ != nullptr, state) !=
+                        ScanResult::RESTART) {
+      return;
+    }
+    // Continue after the last leaf whose values were all appended
+    if (state->last_leaf_ == nullptr) continue;
+    if (state->ascending_) {
+      state->low_key_ = state->last_leaf_->Key();
+      state->low_key_len_ = state->last_leaf_->key_len_;
+      state->low_exclusive_ = true;
+    } else {
+      state->high_key_ = state->last_leaf_->Key();
+      state->high_key_len_ = state->last_leaf_->key_len_;
+      state->high_is_prefix_ = false;
+      state->high_exclusive_ = true;
+    }
+  }
+}
+
+AdaptiveRadixTree::ScanResult AdaptiveRadixTree::ScanNode(Node *const node, const uint64_t version, uint32_t depth,
+                                                          bool low_eq, bool high_eq, ScanState *const state) {
+  // low_eq and high_eq tell whether the path to the node equals the low and the high key so far. Only then can the
+  // bounds cut off children, all other keys below the node are within that bound.
+  const ScanResult below_low = state->ascending_ ? ScanResult::CONTINUE : ScanResult::DONE;
+  const ScanResult above_high = state->ascending_ ? ScanResult::DONE : ScanResult::CONTINUE;
+  bool restart = false;
+
+  const uint32_t prefix_len = node->prefix_len_;
+  for (uint32_t i = 0; i < prefix_len && (low_eq || high_eq); i++) {
+    if (i == MAX_STORED_PREFIX) {
+      // The bytes that are not stored decide nothing, the leaves are checked against the bounds anyway
+      low_eq = false;
+      high_eq = false;
+      break;
+    }
+    const uint8_t prefix_byte = node->prefix_[i];
+    const uint32_t position = depth + i;
+    if (low_eq) {
+      if (position >= state->low_key_len_ || prefix_byte > state->low_key_[position]) {
+        low_eq = false;
+      } else if (prefix_byte < state->low_key_[position]) {
+        node->CheckOrRestart(version, &restart);
+        return restart ? ScanResult::RESTART : below_low;
+      }
+    }
+    if (high_eq) {
+      if (position >= state->high_key_len_ && state->high_is_prefix_) {
+        high_eq = false;
+      } else if (position >= state->high_key_len_ || prefix_byte > state->high_key_[position]) {
+        node->CheckOrRestart(version, &restart);
+        return restart ? ScanResult::RESTART : above_high;
+      } else if (prefix_byte < state->high_key_[position]) {
+        high_eq = false;
+      }
+    }
+  }
+  depth += prefix_len;
+  if (low_eq && depth >= state->low_key_len_) low_eq = false;
+  if (high_eq && depth >= state->high_key_len_) {
+    if (!state->high_is_prefix_) {
+      node->CheckOrRestart(version, &restart);
+      return restart ? ScanResult::RESTART : above_high;
+    }
+    high_eq = false;
+  }
+
+  const uint32_t num_positions = node->NumPositions();
+  for (uint32_t i = 0; i < num_positions; i++) {
+    uint8_t key_byte;
+    Node *const child = node->ChildAt(state->ascending_ ? i : num_positions - 1 - i, &key_byte);
+    node->CheckOrRestart(version, &restart);
+    if (restart) return ScanResult::RESTART;
+    if (child == nullptr) continue;
+
+    bool child_low_eq = false;
+    if (low_eq) {
+      if (key_byte < state->low_key_[depth]) {
+        if (state->ascending_) continue;
+        return ScanResult::DONE;
+      }
+      child_low_eq = key_byte == state->low_key_[depth];
+    }
+    bool child_high_eq = false;
+    if (high_eq) {
+      if (key_byte > state->high_key_[depth]) {
+        if (!state->ascending_) continue;
+        return ScanResult::DONE;
+      }
+      child_high_eq = key_byte == state->high_key_[depth];
+    }
+
+    ScanResult result;
+    if (Leaf::IsLeaf(child)) {
+      result = ScanLeaf(Leaf::FromNode(child), state);
+    } else {
+      const uint64_t child_version = child->ReadLockOrRestart(&restart);
+      if (restart) return ScanResult::RESTART;
+      node->CheckOrRestart(version, &restart);
+      if (restart) return ScanResult::RESTART;
+      result = ScanNode(child, child_version, depth + 1, child_low_eq, child_high_eq, state);
+    }
+    if (result != ScanResult::CONTINUE) return result;
+  }
+  return ScanResult::CONTINUE;
+}
+
+AdaptiveRadixTree::ScanResult AdaptiveRadixTree::ScanLeaf(const Leaf *const leaf, ScanState *const state) {
+  const uint8_t *const key = leaf->Key();
+  const uint32_t key_len = leaf->key_len_;
+
+  if (state->low_key_ != nullptr) {
+    int cmp = std::memcmp(key, state->low_key_, std::min(key_len, state->low_key_len_));
+    if (cmp == 0) cmp = static_cast<int>(key_len) - static_cast<int>(state->low_key_len_);
+    if (cmp < 0 || (cmp == 0 && state->low_exclusive_)) {
+      return state->ascending_ ? ScanResult::CONTINUE : ScanResult::DONE;
+    }
+  }
+  if (state->high_key_ != nullptr) {
+    int cmp = std::memcmp(key, state->high_key_, std::min(key_len, state->high_key_len_));
+    if (cmp == 0 && (key_len < state->high_key_len_ || !state->high_is_prefix_)) {
+      cmp = static_cast<int>(key_len) - static_cast<int>(state->high_key_len_);
+    }
+    if (cmp > 0 || (cmp == 0 && state->high_exclusive_)) {
+      return state->ascending_ ? ScanResult::DONE : ScanResult::CONTINUE;
+    }
+  }
+
+  for (uint32_t i = 0; i < leaf->num_values_; i++) {
+    if (!(*state->predicate_)(leaf->Values()[i])) continue;
+    state->values_->emplace_back(leaf->Values()[i]);
+    if (state->limit_ != 0 && state->values_->size() >= state->limit_) return ScanResult::DONE;
+  }
+  state->last_leaf_ = leaf;
+  return ScanResult::CONTINUE;
+}
+
+}  // namespace noisepage::storage::index
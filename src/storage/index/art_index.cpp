@@ -0,0 +1,236 @@
+#include "storage/index/art_index.h"
+
+#include <cstring>
+
+#include "storage/index/adaptive_radix_tree.h"
+#include "storage/index/compact_ints_key.h"
+#include "storage/index/generic_key.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/transaction_context.h"
+
+namespace noisepage::storage::index {
+
+template <typename KeyType>
+ArtIndex<KeyType>::ArtIndex(IndexMetadata &&metadata)
+    : Index(std::move(metadata)), art_{new AdaptiveRadixTree} {}
+
+template <typename KeyType>
+uint32_t ArtIndex<KeyType>::EncodeTreeKey(const KeyType &index_key, const TupleSlot location, byte *const out) const {
+  uint32_t size = index_key.EncodeBinaryComparable(metadata_, metadata_.GetSchema().GetColumns().size(), out);
+  if (!metadata_.GetSchema().Unique()) {
+    std::memcpy(out + size, &location, sizeof(TupleSlot));
+    size += sizeof(TupleSlot);
+  }
+  return size;
+}
+
+template <typename KeyType>
+void ArtIndex<KeyType>::PerformGarbageCollection() {
+  art_->ReclaimRetiredNodes();
+}
+
+template <typename KeyType>
+size_t ArtIndex<KeyType>::EstimateHeapUsage() const {
+  return art_->GetHeapUsage();
+}
+
+template <typename KeyType>
+bool ArtIndex<KeyType>::Insert(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple,
+                               TupleSlot location) {
+  NOISEPAGE_ASSERT(!(metadata_.GetSchema().Unique()),
+                   "This Insert is designed for secondary indexes with no uniqueness constraints.");
+  KeyType index_key;
+  index_key.SetFromProjectedRow(tuple, metadata_, metadata_.GetSchema().GetColumns().size());
+
+  auto predicate = [](const TupleSlot slot) -> bool { return false; };
+
+  byte tree_key[KeyType::MAX_BINARY_COMPARABLE_SIZE + sizeof(TupleSlot)];
+  const uint32_t tree_key_len = EncodeTreeKey(index_key, location, tree_key);
+  const bool result = art_->Insert(tree_key, tree_key_len, location, predicate);
+  RecordModifications();
+
+  NOISEPAGE_ASSERT(result,
+                   "non-unique index shouldn't fail to insert. If it did, something went wrong deep inside the ART.");
+  // Register an abort action with the txn context in case of rollback
+  txn->RegisterAbortAction([=]() {
+    byte tree_key[KeyType::MAX_BINARY_COMPARABLE_SIZE + sizeof(TupleSlot)];
+    const uint32_t tree_key_len = EncodeTreeKey(index_key, location, tree_key);
+    const bool UNUSED_ATTRIBUTE result = art_->Delete(tree_key, tree_key_len, location);
+    NOISEPAGE_ASSERT(result, "Delete on the index failed.");
+    RecordModifications();
+  });
+  return result;
+}
+
+template <typename KeyType>
+bool ArtIndex<KeyType>::InsertUnique(common::ManagedPointer<transaction::TransactionContext> txn,
+                                     const ProjectedRow &tuple, TupleSlot location) {
+  NOISEPAGE_ASSERT(metadata_.GetSchema().Unique(), "This Insert is designed for indexes with uniqueness constraints.");
+  KeyType index_key;
+  index_key.SetFromProjectedRow(tuple, metadata_, metadata_.GetSchema().GetColumns().size());
+
+  // The predicate checks if any matching keys have write-write conflicts or are still visible to the calling txn.
+  auto predicate = [txn](const TupleSlot slot) -> bool {
+    const auto *const data_table = slot.GetBlock()->data_table_;
+    const auto has_conflict = data_table->HasConflict(*txn, slot);
+    const auto is_visible = data_table->IsVisible(*txn, slot);
+    return has_conflict || is_visible;
+  };
+
+  // Insert a key-value pair
+  byte tree_key[KeyType::MAX_BINARY_COMPARABLE_SIZE + sizeof(TupleSlot)];
+  const uint32_t tree_key_len = EncodeTreeKey(index_key, location, tree_key);
+  const bool result = art_->Insert(tree_key, tree_key_len, location, predicate);
+
+  if (result) {
+    RecordModifications();
+    // Register an abort action with the txn context in case of rollback
+    txn->RegisterAbortAction([=]() {
+      byte tree_key[KeyType::MAX_BINARY_COMPARABLE_SIZE + sizeof(TupleSlot)];
+      const uint32_t tree_key_len = EncodeTreeKey(index_key, location, tree_key);
+      const bool UNUSED_ATTRIBUTE result = art_->Delete(tree_key, tree_key_len, location);
+      NOISEPAGE_ASSERT(result, "Delete on the index failed.");
+      RecordModifications();
+    });
+  } else {
+    // Presumably you've already made modifications to a DataTable (the source of the TupleSlot argument to this
+    // function) however, the index found a constraint violation and cannot allow that operation to succeed. For MVCC
+    // correctness, this txn must now abort for the GC to clean up the version chain in the DataTable correctly.
+    txn->SetMustAbort();
+  }
+
+  return result;
+}
+
+template <typename KeyType>
+void ArtIndex<KeyType>::Delete(common::ManagedPointer<transaction::TransactionContext> txn, const ProjectedRow &tuple,
+                               TupleSlot location) {
+  KeyType index_key;
+  index_key.SetFromProjectedRow(tuple, metadata_, metadata_.GetSchema().GetColumns().size());
+
+  NOISEPAGE_ASSERT(!(location.GetBlock()->data_table_->HasConflict(*txn, location)) &&
+                       !(location.GetBlock()->data_table_->IsVisible(*txn, location)),
+                   "Called index delete on a TupleSlot that has a conflict with this txn or is still visible.");
+
+  // Register a deferred action for the GC with txn manager. See base function comment.
+  txn->RegisterCommitAction([=](transaction::DeferredActionManager *deferred_action_manager) {
+    deferred_action_manager->RegisterDeferredAction([=]() {
+      byte tree_key[KeyType::MAX_BINARY_COMPARABLE_SIZE + sizeof(TupleSlot)];
+      const uint32_t tree_key_len = EncodeTreeKey(index_key, location, tree_key);
+      const bool UNUSED_ATTRIBUTE result = art_->Delete(tree_key, tree_key_len, location);
+      NOISEPAGE_ASSERT(result, "Deferred delete on the index failed.");
+      RecordModifications();
+    });
+  });
+}
+
+template <typename KeyType>
+void ArtIndex<KeyType>::ScanKey(const transaction::TransactionContext &txn, const ProjectedRow &key,
+                                std::vector<TupleSlot> *value_list) {
+  NOISEPAGE_ASSERT(value_list->empty(), "Result set should begin empty.");
+
+  // Build search key
+  KeyType index_key;
+  index_key.SetFromProjectedRow(key, metadata_, metadata_.GetSchema().GetColumns().size());
+  byte search_key[KeyType::MAX_BINARY_COMPARABLE_SIZE];
+  const uint32_t search_key_len =
+      index_key.EncodeBinaryComparable(metadata_, metadata_.GetSchema().GetColumns().size(), search_key);
+
+  if (metadata_.GetSchema().Unique()) {
+    std::vector<TupleSlot> results;
+    art_->Lookup(search_key, search_key_len, &results);
+
+    // Perform visibility check on result
+    for (const auto &result : results) {
+      if (IsVisible(txn, result)) value_list->emplace_back(result);
+    }
+  } else {
+    // The entries of the key are the tree keys that start with the search key
+    auto predicate = [&txn](const TupleSlot slot) -> bool { return IsVisible(txn, slot); };
+    art_->ScanAscending(search_key, search_key_len, search_key, search_key_len, 0, predicate, value_list);
+  }
+
+  NOISEPAGE_ASSERT(!(metadata_.GetSchema().Unique()) || (metadata_.GetSchema().Unique() && value_list->size() <= 1),
+                   "Invalid number of results for unique index.");
+}
+
+template <typename KeyType>
+void ArtIndex<KeyType>::ScanAscending(const transaction::TransactionContext &txn, ScanType scan_type,
+                                      uint32_t num_attrs, ProjectedRow *low_key, ProjectedRow *high_key,
+                                      uint32_t limit, std::vector<TupleSlot> *value_list) {
+  NOISEPAGE_ASSERT(value_list->empty(), "Result set should begin empty.");
+  NOISEPAGE_ASSERT(scan_type == ScanType::Closed || scan_type == ScanType::OpenLow || scan_type == ScanType::OpenHigh ||
+                       scan_type == ScanType::OpenBoth,
+                   "Invalid scan_type passed into ArtIndex::Scan");
+
+  bool low_key_exists = (scan_type == ScanType::Closed || scan_type == ScanType::OpenHigh);
+  bool high_key_exists = (scan_type == ScanType::Closed || scan_type == ScanType::OpenLow);
+
+  // The predicate checks if any matching keys are still visible to the calling txn.
+  auto predicate = [&txn](const TupleSlot slot) -> bool { return IsVisible(txn, slot); };
+
+  // Build search keys. The tree compares keys against the high key only up to its length, so a key whose first
+  // num_attrs attributes equal the high key is within the scan.
+  KeyType index_low_key, index_high_key;
+  byte low_search_key[KeyType::MAX_BINARY_COMPARABLE_SIZE];
+  byte high_search_key[KeyType::MAX_BINARY_COMPARABLE_SIZE];
+  uint32_t low_search_key_len = 0, high_search_key_len = 0;
+  if (low_key_exists) {
+    index_low_key.SetFromProjectedRow(*low_key, metadata_, num_attrs);
+    low_search_key_len = index_low_key.EncodeBinaryComparable(metadata_, num_attrs, low_search_key);
+  }
+  if (high_key_exists) {
+    index_high_key.SetFromProjectedRow(*high_key, metadata_, num_attrs);
+    high_search_key_len = index_high_key.EncodeBinaryComparable(metadata_, num_attrs, high_search_key);
+  }
+
+  art_->ScanAscending(low_key_exists ? low_search_key : nullptr, low_search_key_len,
+                      high_key_exists ? high_search_key : nullptr, high_search_key_len, limit, predicate, value_list);
+}
+
+template <typename KeyType>
+void ArtIndex<KeyType>::ScanDescending(const transaction::TransactionContext &txn, const ProjectedRow &low_key,
+                                       const ProjectedRow &high_key, std::vector<TupleSlot> *value_list) {
+  ScanLimitDescending(txn, low_key, high_key, value_list, 0);
+}
+
+template <typename KeyType>
+void ArtIndex<KeyType>::ScanLimitDescending(const transaction::TransactionContext &txn, const ProjectedRow &low_key,
+                                            const ProjectedRow &high_key, std::vector<TupleSlot> *value_list,
+                                            uint32_t limit) {
+  NOISEPAGE_ASSERT(value_list->empty(), "Result set should begin empty.");
+
+  // The predicate checks if any matching keys are still visible to the calling txn.
+  auto predicate = [&txn](const TupleSlot slot) -> bool { return IsVisible(txn, slot); };
+
+  // Build search keys
+  KeyType index_low_key, index_high_key;
+  index_low_key.SetFromProjectedRow(low_key, metadata_, metadata_.GetSchema().GetColumns().size());
+  index_high_key.SetFromProjectedRow(high_key, metadata_, metadata_.GetSchema().GetColumns().size());
+  byte low_search_key[KeyType::MAX_BINARY_COMPARABLE_SIZE];
+  byte high_search_key[KeyType::MAX_BINARY_COMPARABLE_SIZE];
+  const uint32_t low_search_key_len =
+      index_low_key.EncodeBinaryComparable(metadata_, metadata_.GetSchema().GetColumns().size(), low_search_key);
+  const uint32_t high_search_key_len =
+      index_high_key.EncodeBinaryComparable(metadata_, metadata_.GetSchema().GetColumns().size(), high_search_key);
+
+  art_->ScanDescending(low_search_key, low_search_key_len, high_search_key, high_search_key_len, limit, predicate,
+                       value_list);
+}
+
+template <typename KeyType>
+uint64_t ArtIndex<KeyType>::GetSize() const {
+  return art_->GetSize();
+}
+
+template class ArtIndex<CompactIntsKey<8>>;
+template class ArtIndex<CompactIntsKey<16>>;
+template class ArtIndex<CompactIntsKey<24>>;
+template class ArtIndex<CompactIntsKey<32>>;
+
+template class ArtIndex<GenericKey<64>>;
+template class ArtIndex<GenericKey<128>>;
+template class ArtIndex<GenericKey<256>>;
+template class ArtIndex<GenericKey<512>>;
+
+}  // namespace noisepage::storage::index
@@ -1,5 +1,12 @@
 #include "storage/index/bplustree_index.h"
 
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "storage/index/bplustree.h"
 #include "storage/index/compact_ints_key.h"
 #include "storage/index/generic_key.h"
@@ -12,6 +19,11 @@ template <typename KeyType>
 BPlusTreeIndex<KeyType>::BPlusTreeIndex(IndexMetadata &&metadata)
     : Index(std::move(metadata)), bplustree_{new BPlusTree<KeyType, TupleSlot>} {}
 
+template <typename KeyType>
+void BPlusTreeIndex<KeyType>::PerformGarbageCollection() {
+  bplustree_->ReclaimRetiredNodes();
+}
+
 template <typename KeyType>
 size_t BPlusTreeIndex<KeyType>::EstimateHeapUsage() const {
   return bplustree_->EstimateHeapUsage();
@@ -28,6 +40,7 @@ bool BPlusTreeIndex<KeyType>::Insert(common::ManagedPointer<transaction::Transac
   auto predicate = [](const TupleSlot slot) -> bool { return false; };
 
   const bool result = bplustree_->Insert(bplustree_->GetElement(index_key, location), predicate);
+  RecordModifications();
 
   NOISEPAGE_ASSERT(
       result,
@@ -37,6 +50,7 @@ bool BPlusTreeIndex<KeyType>::Insert(common::ManagedPointer<transaction::Transac
     const bool UNUSED_ATTRIBUTE result = bplustree_->DeleteElement(bplustree_->GetElement(index_key, location));
 
     NOISEPAGE_ASSERT(result, "Delete on the index failed.");
+    RecordModifications();
   });
   return result;
 }
@@ -60,10 +74,12 @@ bool BPlusTreeIndex<KeyType>::InsertUnique(common::ManagedPointer<transaction::T
   const bool result = bplustree_->Insert(bplustree_->GetElement(index_key, location), predicate);
 
   if (result) {
+    RecordModifications();
     // Register an abort action with the txn context in case of rollback
     txn->RegisterAbortAction([=]() {
       const bool UNUSED_ATTRIBUTE result = bplustree_->DeleteElement(bplustree_->GetElement(index_key, location));
       NOISEPAGE_ASSERT(result, "Delete on the index failed.");
+      RecordModifications();
     });
   } else {
     // Presumably you've already made modifications to a DataTable (the source of the TupleSlot argument to this
@@ -75,6 +91,103 @@ bool BPlusTreeIndex<KeyType>::InsertUnique(common::ManagedPointer<transaction::T
   return result;
 }
 
+template <typename KeyType>
+bool BPlusTreeIndex<KeyType>::BulkLoad(common::ManagedPointer<transaction::TransactionContext> txn,
+                                       const std::vector<std::pair<const ProjectedRow *, TupleSlot>> &entries) {
+  // The tree can only be built bottom-up while it is empty
+  if (!bplustree_->IsEmpty()) return Index::BulkLoad(txn, entries);
+
+  std::vector<std::pair<KeyType, TupleSlot>> elements;
+  elements.reserve(entries.size());
+  for (const auto &entry : entries) {
+    KeyType index_key;
+    index_key.SetFromProjectedRow(*entry.first, metadata_, metadata_.GetSchema().GetColumns().size());
+    elements.emplace_back(index_key, entry.second);
+  }
+  tbb::parallel_sort(elements.begin(), elements.end(),
+                     [](const std::pair<KeyType, TupleSlot> &lhs, const std::pair<KeyType, TupleSlot> &rhs) {
+                       return std::less<KeyType>()(lhs.first, rhs.first);  // NOLINT
+                     });
+
+  if (metadata_.GetSchema().Unique()) {
+    for (uint64_t i = 1; i < elements.size(); i++) {
+      if (std::equal_to<KeyType>()(elements[i - 1].first, elements[i].first)) {  // NOLINT
+        // Same as InsertUnique, the txn already wrote the tuples and must abort for the GC to clean them up
+        txn->SetMustAbort();
+        return false;
+      }
+    }
+  }
+
+  bplustree_->BulkLoad(elements);
+
+  // Register a single abort action for the whole load in case of rollback
+  txn->RegisterAbortAction([this, elements{std::move(elements)}]() {
+    for (const auto &element : elements) {
+      const bool UNUSED_ATTRIBUTE result = bplustree_->DeleteElement(element);
+      NOISEPAGE_ASSERT(result, "Delete on the index failed.");
+    }
+    RecordModifications(elements.size());
+  });
+  return true;
+}
+
+template <typename KeyType>
+std::vector<std::pair<KeyType, TupleSlot>> BPlusTreeIndex<KeyType>::SortedElements(
+    const std::vector<std::pair<const ProjectedRow *, TupleSlot>> &entries) const {
+  std::vector<std::pair<KeyType, TupleSlot>> elements;
+  elements.reserve(entries.size());
+  for (const auto &entry : entries) {
+    KeyType index_key;
+    index_key.SetFromProjectedRow(*entry.first, metadata_, metadata_.GetSchema().GetColumns().size());
+    elements.emplace_back(index_key, entry.second);
+  }
+  std::sort(elements.begin(), elements.end(),
+            [](const std::pair<KeyType, TupleSlot> &lhs, const std::pair<KeyType, TupleSlot> &rhs) {
+              return std::less<KeyType>()(lhs.first, rhs.first);  // NOLINT
+            });
+  return elements;
+}
+
+template <typename KeyType>
+void BPlusTreeIndex<KeyType>::InsertBatch(common::ManagedPointer<transaction::TransactionContext> txn,
+                                          const std::vector<std::pair<const ProjectedRow *, TupleSlot>> &entries) {
+  NOISEPAGE_ASSERT(!(metadata_.GetSchema().Unique()),
+                   "This InsertBatch is designed for secondary indexes with no uniqueness constraints.");
+  auto elements = SortedElements(entries);
+
+  const uint64_t UNUSED_ATTRIBUTE num_inserted = bplustree_->InsertElements(elements);
+  NOISEPAGE_ASSERT(num_inserted == elements.size(), "non-unique index shouldn't fail to insert.");
+  RecordModifications(elements.size());
+
+  // Register a single abort action for the whole batch in case of rollback
+  txn->RegisterAbortAction([this, elements{std::move(elements)}]() {
+    for (const auto &element : elements) {
+      const bool UNUSED_ATTRIBUTE result = bplustree_->DeleteElement(element);
+      NOISEPAGE_ASSERT(result, "Delete on the index failed.");
+    }
+    RecordModifications(elements.size());
+  });
+}
+
+template <typename KeyType>
+void BPlusTreeIndex<KeyType>::DeleteBatch(common::ManagedPointer<transaction::TransactionContext> txn,
+                                          const std::vector<std::pair<const ProjectedRow *, TupleSlot>> &entries) {
+  auto elements = SortedElements(entries);
+
+  // Register a single deferred action for the GC with txn manager. See base function comment.
+  txn->RegisterCommitAction(
+      [this, elements{std::move(elements)}](transaction::DeferredActionManager *deferred_action_manager) mutable {
+        deferred_action_manager->RegisterDeferredAction([this, elements{std::move(elements)}]() {
+          for (const auto &element : elements) {
+            const bool UNUSED_ATTRIBUTE result = bplustree_->DeleteElement(element);
+            NOISEPAGE_ASSERT(result, "Deferred delete on the index failed.");
+          }
+          RecordModifications(elements.size());
+        });
+      });
+}
+
 template <typename KeyType>
 void BPlusTreeIndex<KeyType>::Delete(common::ManagedPointer<transaction::TransactionContext> txn,
                                      const ProjectedRow &tuple, TupleSlot location) {
@@ -91,6 +204,7 @@ void BPlusTreeIndex<KeyType>::Delete(common::ManagedPointer<transaction::Transac
       const bool UNUSED_ATTRIBUTE result = bplustree_->DeleteElement(bplustree_->GetElement(index_key, location));
 
       NOISEPAGE_ASSERT(result, "Deferred delete on the index failed.");
+      RecordModifications();
     });
   });
 }
@@ -121,6 +235,33 @@ void BPlusTreeIndex<KeyType>::ScanKey(const transaction::TransactionContext &txn
                    "Invalid number of results for unique index.");
 }
 
+template <typename KeyType>
+void BPlusTreeIndex<KeyType>::ScanKeyBatch(const transaction::TransactionContext &txn,
+                                           const std::vector<const ProjectedRow *> &keys,
+                                           std::vector<std::vector<TupleSlot>> *value_lists) {
+  NOISEPAGE_ASSERT(value_lists->empty(), "Result set should begin empty.");
+
+  // Build search keys
+  std::vector<KeyType> index_keys(keys.size());
+  for (uint64_t i = 0; i < keys.size(); i++) {
+    index_keys[i].SetFromProjectedRow(*keys[i], metadata_, metadata_.GetSchema().GetColumns().size());
+  }
+
+  // Perform lookups in BPlusTree
+  std::vector<std::vector<TupleSlot>> results(keys.size());
+  bplustree_->FindValuesOfKeys(index_keys, &results);
+
+  // Perform visibility check on results
+  value_lists->resize(keys.size());
+  for (uint64_t i = 0; i < keys.size(); i++) {
+    for (const auto &result : results[i]) {
+      if (IsVisible(txn, result)) (*value_lists)[i].emplace_back(result);
+    }
+    NOISEPAGE_ASSERT(!(metadata_.GetSchema().Unique()) || (*value_lists)[i].size() <= 1,
+                     "Invalid number of results for unique index.");
+  }
+}
+
 template <typename KeyType>
 void BPlusTreeIndex<KeyType>::ScanAscending(const transaction::TransactionContext &txn, ScanType scan_type,
                                             uint32_t num_attrs, ProjectedRow *low_key, ProjectedRow *high_key,
@@ -150,6 +291,79 @@ void BPlusTreeIndex<KeyType>::ScanAscending(const transaction::TransactionContex
   }
 }
 
+template <typename KeyType>
+class BPlusTreeIndex<KeyType>::ScanPartitions final : public IndexScanPartitions {
+ public:
+  ScanPartitions(BPlusTreeIndex *const index, const bool low_key_exists, const KeyType &low_key,
+                 const bool high_key_exists, const KeyType &high_key, const uint32_t num_attrs,
+                 std::vector<KeyType> &&separators, const uint32_t max_partitions)
+      : index_(index),
+        low_key_exists_(low_key_exists),
+        low_key_(low_key),
+        high_key_exists_(high_key_exists),
+        high_key_(high_key),
+        num_attrs_(num_attrs),
+        separators_(std::move(separators)) {
+    ThinSeparators(&separators_, max_partitions - 1);
+  }
+
+  uint32_t NumPartitions() const final { return static_cast<uint32_t>(separators_.size()) + 1; }
+
+  void Scan(const transaction::TransactionContext &txn, const uint32_t partition,
+            std::vector<TupleSlot> *const value_list) const final {
+    NOISEPAGE_ASSERT(value_list->empty(), "Result set should begin empty.");
+    NOISEPAGE_ASSERT(partition < NumPartitions(), "Sub-range out of bounds.");
+
+    // The predicate checks if any matching keys are still visible to the calling txn.
+    auto predicate = [&txn](const TupleSlot slot) -> bool { return IsVisible(txn, slot); };
+
+    // Every sub-range but the first starts at a separator, and every one but the last stops before the next separator.
+    // All of them stop at the high key, since separators are only a hint of where the keys were.
+    const bool starts_at_separator = partition > 0;
+    const KeyType &start_key = starts_at_separator ? separators_[partition - 1] : low_key_;
+    const KeyType *const end_key = partition < separators_.size() ? &separators_[partition] : nullptr;
+
+    bool scan_completed = false;
+    while (!scan_completed) {
+      value_list->clear();
+      scan_completed = index_->bplustree_->ScanAscending(start_key, high_key_, starts_at_separator || low_key_exists_,
+                                                         num_attrs_, high_key_exists_, 0, value_list,
+                                                         &index_->metadata_, predicate, end_key);
+    }
+  }
+
+ private:
+  BPlusTreeIndex *const index_;
+  const bool low_key_exists_;
+  const KeyType low_key_;
+  const bool high_key_exists_;
+  const KeyType high_key_;
+  const uint32_t num_attrs_;
+  std::vector<KeyType> separators_;
+};
+
+template <typename KeyType>
+std::unique_ptr<IndexScanPartitions> BPlusTreeIndex<KeyType>::PartitionAscending(ScanType scan_type,
+                                                                                 uint32_t num_attrs,
+                                                                                 ProjectedRow *low_key,
+                                                                                 ProjectedRow *high_key,
+                                                                                 uint32_t max_partitions) {
+  NOISEPAGE_ASSERT(max_partitions > 0, "A range is split into at least one sub-range.");
+
+  bool low_key_exists = (scan_type == ScanType::Closed || scan_type == ScanType::OpenHigh);
+  bool high_key_exists = (scan_type == ScanType::Closed || scan_type == ScanType::OpenLow);
+
+  // Build search keys
+  KeyType index_low_key, index_high_key;
+  if (low_key_exists) index_low_key.SetFromProjectedRow(*low_key, metadata_, num_attrs);
+  if (high_key_exists) index_high_key.SetFromProjectedRow(*high_key, metadata_, num_attrs);
+
+  auto separators = bplustree_->GetSeparators(low_key_exists ? &index_low_key : nullptr,
+                                              high_key_exists ? &index_high_key : nullptr, max_partitions - 1);
+  return std::make_unique<ScanPartitions>(this, low_key_exists, index_low_key, high_key_exists, index_high_key,
+                                          num_attrs, std::move(separators), max_partitions);
+}
+
 template <typename KeyType>
 void BPlusTreeIndex<KeyType>::ScanDescending(const transaction::TransactionContext &txn, const ProjectedRow &low_key,
                                              const ProjectedRow &high_key, std::vector<TupleSlot> *value_list) {
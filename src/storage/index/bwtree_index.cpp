@@ -1,5 +1,13 @@
 #include "storage/index/bwtree_index.h"
 
+#include <tbb/parallel_sort.h>
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <utility>
+#include <vector>
+
 #include "bwtree/bwtree.h"
 #include "storage/index/compact_ints_key.h"
 #include "storage/index/generic_key.h"
@@ -12,11 +20,50 @@ template <typename KeyType>
 BwTreeIndex<KeyType>::BwTreeIndex(IndexMetadata metadata)
     : Index(std::move(metadata)), bwtree_(std::make_unique<third_party::bwtree::BwTree<KeyType, TupleSlot>>(false)) {}
 
+template <typename KeyType>
+BwTreeIndex<KeyType>::~BwTreeIndex() {
+  StopBackgroundMaintenance();
+}
+
 template <typename KeyType>
 void BwTreeIndex<KeyType>::PerformGarbageCollection() {
+  common::SpinLatch::ScopedSpinLatch guard(&epoch_gc_latch_);
   bwtree_->PerformGarbageCollection();
 }
 
+template <typename KeyType>
+void BwTreeIndex<KeyType>::StartBackgroundMaintenance(const std::chrono::microseconds period) {
+  NOISEPAGE_ASSERT(!run_maintenance_, "Background maintenance should not already be running.");
+  run_maintenance_ = true;
+  maintenance_thread_ = std::thread([this, period] {
+    // Consolidate chains well before a worker would, but not so early that every other insert causes a consolidation
+    constexpr int leaf_threshold = LEAF_DELTA_CHAIN_LENGTH_THRESHOLD / 2;    // constant from bwtree.h
+    constexpr int inner_threshold = INNER_DELTA_CHAIN_LENGTH_THRESHOLD / 2;  // constant from bwtree.h
+    while (run_maintenance_) {
+      std::this_thread::sleep_for(period);
+      bwtree_->ConsolidateDeltaChains(leaf_threshold, inner_threshold);
+      PerformGarbageCollection();
+    }
+  });
+}
+
+template <typename KeyType>
+void BwTreeIndex<KeyType>::StopBackgroundMaintenance() {
+  if (!run_maintenance_) return;
+  run_maintenance_ = false;
+  maintenance_thread_.join();
+}
+
+template <typename KeyType>
+IndexMaintenanceStats BwTreeIndex<KeyType>::CollectMaintenanceStats() {
+  IndexMaintenanceStats stats;
+  stats.consolidations_ = bwtree_->consolidation_count.exchange(0);
+  stats.background_consolidations_ = bwtree_->background_consolidation_count.exchange(0);
+  stats.consolidated_deltas_ = bwtree_->consolidated_delta_count.exchange(0);
+  stats.longest_chain_ = bwtree_->longest_consolidated_chain.exchange(0);
+  return stats;
+}
+
 template <typename KeyType>
 size_t BwTreeIndex<KeyType>::EstimateHeapUsage() const {
   // This is a back-of-the-envelope calculation that could be innacurate: it does not account for deltas within the
@@ -54,6 +101,7 @@ bool BwTreeIndex<KeyType>::Insert(const common::ManagedPointer<transaction::Tran
   KeyType index_key;
   index_key.SetFromProjectedRow(tuple, metadata_, metadata_.GetSchema().GetColumns().size());
   const bool result = bwtree_->Insert(index_key, location, false);
+  RecordModifications();
 
   NOISEPAGE_ASSERT(
       result,
@@ -65,6 +113,7 @@ bool BwTreeIndex<KeyType>::Insert(const common::ManagedPointer<transaction::Tran
   txn->RegisterAbortAction([=]() {
     const bool UNUSED_ATTRIBUTE result = bwtree_->Delete(index_key, location);
     NOISEPAGE_ASSERT(result, "Delete on the index failed.");
+    RecordModifications();
   });
   return result;
 }
@@ -90,6 +139,7 @@ bool BwTreeIndex<KeyType>::InsertUnique(const common::ManagedPointer<transaction
   NOISEPAGE_ASSERT(predicate_satisfied != result, "If predicate is not satisfied then insertion should succeed.");
 
   if (result) {
+    RecordModifications();
     // TODO(wuwenw): transaction context is not thread safe for now, and a latch is used here to protect it, may need
     // a better way
     common::SpinLatch::ScopedSpinLatch guard(&transaction_context_latch_);
@@ -97,6 +147,7 @@ bool BwTreeIndex<KeyType>::InsertUnique(const common::ManagedPointer<transaction
     txn->RegisterAbortAction([=]() {
       const bool UNUSED_ATTRIBUTE result = bwtree_->Delete(index_key, location);
       NOISEPAGE_ASSERT(result, "Delete on the index failed.");
+      RecordModifications();
     });
   } else {
     // Presumably you've already made modifications to a DataTable (the source of the TupleSlot argument to this
@@ -108,6 +159,49 @@ bool BwTreeIndex<KeyType>::InsertUnique(const common::ManagedPointer<transaction
   return result;
 }
 
+template <typename KeyType>
+bool BwTreeIndex<KeyType>::BulkLoad(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                    const std::vector<std::pair<const ProjectedRow *, TupleSlot>> &entries) {
+  std::vector<std::pair<KeyType, TupleSlot>> elements;
+  elements.reserve(entries.size());
+  for (const auto &entry : entries) {
+    KeyType index_key;
+    index_key.SetFromProjectedRow(*entry.first, metadata_, metadata_.GetSchema().GetColumns().size());
+    elements.emplace_back(index_key, entry.second);
+  }
+  tbb::parallel_sort(elements.begin(), elements.end(),
+                     [](const std::pair<KeyType, TupleSlot> &lhs, const std::pair<KeyType, TupleSlot> &rhs) {
+                       return std::less<KeyType>()(lhs.first, rhs.first);  // NOLINT
+                     });
+
+  if (metadata_.GetSchema().Unique()) {
+    for (uint64_t i = 1; i < elements.size(); i++) {
+      if (std::equal_to<KeyType>()(elements[i - 1].first, elements[i].first)) {  // NOLINT
+        // Same as InsertUnique, the txn already wrote the tuples and must abort for the GC to clean them up
+        txn->SetMustAbort();
+        return false;
+      }
+    }
+  }
+
+  for (const auto &element : elements) {
+    const bool UNUSED_ATTRIBUTE result = bwtree_->Insert(element.first, element.second, false);
+    NOISEPAGE_ASSERT(result, "Insert into an index without repeated entries shouldn't fail.");
+  }
+  RecordModifications(elements.size());
+
+  common::SpinLatch::ScopedSpinLatch guard(&transaction_context_latch_);
+  // Register a single abort action for the whole load in case of rollback
+  txn->RegisterAbortAction([this, elements{std::move(elements)}]() {
+    for (const auto &element : elements) {
+      const bool UNUSED_ATTRIBUTE result = bwtree_->Delete(element.first, element.second);
+      NOISEPAGE_ASSERT(result, "Delete on the index failed.");
+    }
+    RecordModifications(elements.size());
+  });
+  return true;
+}
+
 template <typename KeyType>
 void BwTreeIndex<KeyType>::Delete(const common::ManagedPointer<transaction::TransactionContext> txn,
                                   const ProjectedRow &tuple, const TupleSlot location) {
@@ -123,6 +217,7 @@ void BwTreeIndex<KeyType>::Delete(const common::ManagedPointer<transaction::Tran
     deferred_action_manager->RegisterDeferredAction([=]() {
       const bool UNUSED_ATTRIBUTE result = bwtree_->Delete(index_key, location);
       NOISEPAGE_ASSERT(result, "Deferred delete on the index failed.");
+      RecordModifications();
     });
   });
 }
@@ -153,6 +248,37 @@ void BwTreeIndex<KeyType>::ScanKey(const transaction::TransactionContext &txn, c
                    "Invalid number of results for unique index.");
 }
 
+template <typename KeyType>
+void BwTreeIndex<KeyType>::ScanKeyBatch(const transaction::TransactionContext &txn,
+                                        const std::vector<const ProjectedRow *> &keys,
+                                        std::vector<std::vector<TupleSlot>> *value_lists) {
+  NOISEPAGE_ASSERT(value_lists->empty(), "Result set should begin empty.");
+
+  // Build search keys
+  std::vector<KeyType> index_keys(keys.size());
+  for (uint64_t i = 0; i < keys.size(); i++) {
+    index_keys[i].SetFromProjectedRow(*keys[i], metadata_, metadata_.GetSchema().GetColumns().size());
+  }
+  std::vector<uint32_t> order(keys.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](const uint32_t lhs, const uint32_t rhs) {
+    return std::less<KeyType>()(index_keys[lhs], index_keys[rhs]);  // NOLINT
+  });
+
+  // Perform lookups in BwTree, then visibility check on results
+  value_lists->resize(keys.size());
+  std::vector<TupleSlot> results;
+  for (const uint32_t i : order) {
+    results.clear();
+    bwtree_->GetValue(index_keys[i], results);
+    for (const auto &result : results) {
+      if (IsVisible(txn, result)) (*value_lists)[i].emplace_back(result);
+    }
+    NOISEPAGE_ASSERT(!(metadata_.GetSchema().Unique()) || (*value_lists)[i].size() <= 1,
+                     "Invalid number of results for unique index.");
+  }
+}
+
 template <typename KeyType>
 void BwTreeIndex<KeyType>::ScanAscending(const transaction::TransactionContext &txn, ScanType scan_type,
                                          uint32_t num_attrs, ProjectedRow *low_key, ProjectedRow *high_key,
@@ -182,6 +308,78 @@ void BwTreeIndex<KeyType>::ScanAscending(const transaction::TransactionContext &
   }
 }
 
+template <typename KeyType>
+class BwTreeIndex<KeyType>::ScanPartitions final : public IndexScanPartitions {
+ public:
+  ScanPartitions(BwTreeIndex *const index, const bool low_key_exists, const KeyType &low_key,
+                 const bool high_key_exists, const KeyType &high_key, const uint32_t num_attrs,
+                 std::vector<KeyType> &&separators, const uint32_t max_partitions)
+      : index_(index),
+        low_key_exists_(low_key_exists),
+        low_key_(low_key),
+        high_key_exists_(high_key_exists),
+        high_key_(high_key),
+        num_attrs_(num_attrs),
+        separators_(std::move(separators)) {
+    ThinSeparators(&separators_, max_partitions - 1);
+  }
+
+  uint32_t NumPartitions() const final { return static_cast<uint32_t>(separators_.size()) + 1; }
+
+  void Scan(const transaction::TransactionContext &txn, const uint32_t partition,
+            std::vector<TupleSlot> *const value_list) const final {
+    NOISEPAGE_ASSERT(value_list->empty(), "Result set should begin empty.");
+    NOISEPAGE_ASSERT(partition < NumPartitions(), "Sub-range out of bounds.");
+
+    // Every sub-range but the first starts at a separator, and every one but the last stops before the next separator.
+    // All of them stop at the high key, since separators are only a hint of where the keys were.
+    const bool starts_at_separator = partition > 0;
+    const KeyType *const end_key = partition < separators_.size() ? &separators_[partition] : nullptr;
+
+    // Perform lookup in BwTree
+    auto &bwtree = *index_->bwtree_;
+    auto scan_itr = starts_at_separator ? bwtree.Begin(separators_[partition - 1])
+                                        : (low_key_exists_ ? bwtree.Begin(low_key_) : bwtree.Begin());
+
+    while (!scan_itr.IsEnd() && (end_key == nullptr || bwtree.KeyCmpLess(scan_itr->first, *end_key)) &&
+           (!high_key_exists_ || scan_itr->first.PartialLessThan(high_key_, &index_->metadata_, num_attrs_))) {
+      // Perform visibility check on result
+      if (IsVisible(txn, scan_itr->second)) value_list->emplace_back(scan_itr->second);
+      scan_itr++;
+    }
+  }
+
+ private:
+  BwTreeIndex *const index_;
+  const bool low_key_exists_;
+  const KeyType low_key_;
+  const bool high_key_exists_;
+  const KeyType high_key_;
+  const uint32_t num_attrs_;
+  std::vector<KeyType> separators_;
+};
+
+template <typename KeyType>
+std::unique_ptr<IndexScanPartitions> BwTreeIndex<KeyType>::PartitionAscending(ScanType scan_type, uint32_t num_attrs,
+                                                                              ProjectedRow *low_key,
+                                                                              ProjectedRow *high_key,
+                                                                              uint32_t max_partitions) {
+  NOISEPAGE_ASSERT(max_partitions > 0, "A range is split into at least one sub-range.");
+
+  bool low_key_exists = (scan_type == ScanType::Closed || scan_type == ScanType::OpenHigh);
+  bool high_key_exists = (scan_type == ScanType::Closed || scan_type == ScanType::OpenLow);
+
+  // Build search keys
+  KeyType index_low_key, index_high_key;
+  if (low_key_exists) index_low_key.SetFromProjectedRow(*low_key, metadata_, num_attrs);
+  if (high_key_exists) index_high_key.SetFromProjectedRow(*high_key, metadata_, num_attrs);
+
+  auto separators = bwtree_->GetSeparators(low_key_exists ? &index_low_key : nullptr,
+                                           high_key_exists ? &index_high_key : nullptr, max_partitions - 1);
+  return std::make_unique<ScanPartitions>(this, low_key_exists, index_low_key, high_key_exists, index_high_key,
+                                          num_attrs, std::move(separators), max_partitions);
+}
+
 template <typename KeyType>
 void BwTreeIndex<KeyType>::BwTreeIndex::ScanDescending(const transaction::TransactionContext &txn,
                                                        const ProjectedRow &low_key, const ProjectedRow &high_key,
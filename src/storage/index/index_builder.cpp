@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "catalog/catalog_defs.h"
+#include "storage/index/art_index.h"
 #include "storage/index/bplustree_index.h"
 #include "storage/index/bwtree_index.h"
 #include "storage/index/compact_ints_key.h"
@@ -46,6 +47,10 @@ Index *IndexBuilder::Build() const {
         return BuildBPlusTreeIntsKey(std::move(metadata));
       return BuildBPlusTreeGenericKey(std::move(metadata));
     }
+    case IndexType::ART: {
+      if (simple_key && metadata.KeySize() <= COMPACTINTSKEY_MAX_SIZE) return BuildArtIntsKey(std::move(metadata));
+      return BuildArtGenericKey(std::move(metadata));
+    }
     default:
       return nullptr;
   }
@@ -138,6 +143,47 @@ Index *IndexBuilder::BuildBPlusTreeGenericKey(IndexMetadata metadata) const {
   return index;
 }
 
+Index *IndexBuilder::BuildArtIntsKey(IndexMetadata metadata) const {
+  metadata.SetKeyKind(IndexKeyKind::COMPACTINTSKEY);
+  const auto key_size = metadata.KeySize();
+  NOISEPAGE_ASSERT(key_size <= COMPACTINTSKEY_MAX_SIZE, "Key size exceeds maximum for this key type.");
+  Index *index = nullptr;
+  if (key_size <= 8) {
+    index = new ArtIndex<CompactIntsKey<8>>(std::move(metadata));
+  } else if (key_size <= 16) {
+    index = new ArtIndex<CompactIntsKey<16>>(std::move(metadata));
+  } else if (key_size <= 24) {
+    index = new ArtIndex<CompactIntsKey<24>>(std::move(metadata));
+  } else if (key_size <= 32) {
+    index = new ArtIndex<CompactIntsKey<32>>(std::move(metadata));
+  }
+  NOISEPAGE_ASSERT(index != nullptr, "Failed to create an IntsKey index.");
+  return index;
+}
+
+Index *IndexBuilder::BuildArtGenericKey(IndexMetadata metadata) const {
+  metadata.SetKeyKind(IndexKeyKind::GENERICKEY);
+  const auto pr_size = metadata.GetInlinedPRInitializer().ProjectedRowSize();
+  Index *index = nullptr;
+
+  const auto key_size =
+      (pr_size + 8) +
+      sizeof(uintptr_t);  // account for potential padding of the PR and the size of the pointer for metadata
+  NOISEPAGE_ASSERT(key_size <= GENERICKEY_MAX_SIZE, "Key size exceeds maximum for this key type.");
+
+  if (key_size <= 64) {
+    index = new ArtIndex<GenericKey<64>>(std::move(metadata));
+  } else if (key_size <= 128) {
+    index = new ArtIndex<GenericKey<128>>(std::move(metadata));
+  } else if (key_size <= 256) {
+    index = new ArtIndex<GenericKey<256>>(std::move(metadata));
+  } else if (key_size <= 512) {
+    index = new ArtIndex<GenericKey<512>>(std::move(metadata));
+  }
+  NOISEPAGE_ASSERT(index != nullptr, "Failed to create an GenericKey index.");
+  return index;
+}
+
 Index *IndexBuilder::BuildHashIntsKey(IndexMetadata metadata) const {
   metadata.SetKeyKind(IndexKeyKind::HASHKEY);
   const auto key_size = metadata.KeySize();
@@ -0,0 +1,128 @@
+#include "storage/index/online_index_builder.h"
+
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <cstring>
+#include <thread>  // NOLINT
+
+#include "common/allocator.h"
+#include "storage/index/index.h"
+#include "storage/projected_columns.h"
+#include "storage/sql_table.h"
+#include "transaction/timestamp_manager.h"
+#include "transaction/transaction_manager.h"
+#include "transaction/transaction_util.h"
+
+namespace noisepage::storage::index {
+
+OnlineIndexBuilder::OnlineIndexBuilder(const common::ManagedPointer<transaction::TimestampManager> timestamp_manager,
+                                       const common::ManagedPointer<transaction::TransactionManager> txn_manager,
+                                       const common::ManagedPointer<SqlTable> table,
+                                       const common::ManagedPointer<Index> index, const catalog::IndexSchema &schema)
+    : timestamp_manager_(timestamp_manager),
+      txn_manager_(txn_manager),
+      table_(table),
+      index_(index),
+      schema_(schema),
+      key_col_oids_(schema.GetIndexedColOids()) {
+  NOISEPAGE_ASSERT(key_col_oids_.size() == schema.GetColumns().size(), "only keys made of plain columns are supported");
+  std::sort(key_col_oids_.begin(), key_col_oids_.end());
+  key_col_oids_.erase(std::unique(key_col_oids_.begin(), key_col_oids_.end()), key_col_oids_.end());
+}
+
+bool OnlineIndexBuilder::Build(const uint32_t num_workers, const double cpu_share) {
+  NOISEPAGE_ASSERT(num_workers > 0, "the table needs at least one worker to scan it");
+  NOISEPAGE_ASSERT(cpu_share > 0 && cpu_share <= 1, "the workers need a share of the CPU to make progress");
+  // Transactions that began before this point may not know about the index, and may be writing to the table without
+  // maintaining it. Their writes have to be visible to the workers.
+  const transaction::timestamp_t published = timestamp_manager_->CurrentTime();
+  while (transaction::TransactionUtil::NewerThan(published, timestamp_manager_->OldestTransactionStartTime()))
+    std::this_thread::yield();
+
+  std::vector<transaction::TransactionContext *> txns(num_workers);
+  for (auto &txn : txns) txn = txn_manager_->BeginTransaction();
+  // Blocks appended from now on only hold tuples that the snapshots cannot see
+  const uint32_t num_blocks = table_->GetNumBlocks();
+
+  std::atomic<bool> succeeded = true;
+  tbb::task_arena limited_arena(static_cast<int>(num_workers));
+  limited_arena.execute([&] {
+    tbb::parallel_for(tbb::blocked_range<uint32_t>(0, num_workers, 1), [&](const tbb::blocked_range<uint32_t> &range) {
+      for (uint32_t worker = range.begin(); worker < range.end(); worker++) {
+        const uint32_t start_block = static_cast<uint32_t>(uint64_t{num_blocks} * worker / num_workers);
+        const uint32_t end_block = static_cast<uint32_t>(uint64_t{num_blocks} * (worker + 1) / num_workers);
+        if (start_block == end_block) continue;
+        if (!BuildRange(common::ManagedPointer(txns[worker]), start_block, end_block, cpu_share)) succeeded = false;
+      }
+    });
+  });
+
+  // Aborting the transactions takes the entries of a failed build back out of the index
+  for (auto *txn : txns) {
+    if (succeeded)
+      txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    else
+      txn_manager_->Abort(txn);
+  }
+  return succeeded;
+}
+
+bool OnlineIndexBuilder::BuildRange(const common::ManagedPointer<transaction::TransactionContext> txn,
+                                    const uint32_t start_block, const uint32_t end_block,
+                                    const double cpu_share) const {
+  const ProjectionMap projection_map = table_->ProjectionMapForOids(key_col_oids_);
+  const ProjectedColumnsInitializer columns_initializer =
+      table_->InitializerForProjectedColumns(key_col_oids_, common::Constants::K_DEFAULT_VECTOR_SIZE);
+  byte *const columns_buffer = common::AllocationUtil::AllocateAligned(columns_initializer.ProjectedColumnsSize());
+  ProjectedColumns *const columns = columns_initializer.Initialize(columns_buffer);
+  byte *const key_buffer =
+      common::AllocationUtil::AllocateAligned(index_->GetProjectedRowInitializer().ProjectedRowSize());
+  ProjectedRow *const key = index_->GetProjectedRowInitializer().InitializeRow(key_buffer);
+  const auto &indexed_col_oids = schema_.GetIndexedColOids();
+  std::vector<TupleSlot> existing;
+
+  bool succeeded = true;
+  DataTable::SlotIterator it = table_->GetBlockedSlotIterator(start_block, end_block);
+  while (succeeded && it != table_->end()) {
+    const auto batch_start = std::chrono::steady_clock::now();
+    table_->Scan(txn, &it, columns);
+    for (uint32_t i = 0; succeeded && i < columns->NumTuples(); i++) {
+      const ProjectedColumns::RowView row = columns->InterpretAsRow(i);
+      // Copy the values of the tuple into the key, the same way the recovery manager rebuilds keys
+      for (uint16_t col_idx = 0; col_idx < indexed_col_oids.size(); col_idx++) {
+        const auto &key_col = schema_.GetColumn(col_idx);
+        const uint16_t key_offset = index_->GetKeyOidToOffsetMap().at(key_col.Oid());
+        const uint16_t row_offset = projection_map.at(indexed_col_oids[col_idx]);
+        if (row.IsNull(row_offset)) {
+          key->SetNull(key_offset);
+        } else {
+          std::memcpy(key->AccessForceNotNull(key_offset), row.AccessWithNullCheck(row_offset),
+                      AttrSizeBytes(key_col.AttributeLength()));
+        }
+      }
+
+      // A writer that committed before the snapshot was taken may have added the tuple already
+      const TupleSlot slot = columns->TupleSlots()[i];
+      existing.clear();
+      index_->ScanKey(*txn, *key, &existing);
+      if (std::find(existing.cbegin(), existing.cend(), slot) != existing.cend()) continue;
+      succeeded = schema_.Unique() ? index_->InsertUnique(txn, *key, slot) : index_->Insert(txn, *key, slot);
+    }
+
+    if (cpu_share < 1) {
+      // Pause for as long as working on the batch took, scaled so that working takes the share of the time
+      const std::chrono::duration<double> worked = std::chrono::steady_clock::now() - batch_start;
+      std::this_thread::sleep_for(worked * ((1 - cpu_share) / cpu_share));
+    }
+  }
+
+  delete[] key_buffer;
+  delete[] columns_buffer;
+  return succeeded;
+}
+
+}  // namespace noisepage::storage::index
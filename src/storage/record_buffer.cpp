@@ -1,5 +1,7 @@
 #include "storage/record_buffer.h"
 
+#include <algorithm>
+
 #include "storage/write_ahead_log/log_manager.h"
 
 namespace noisepage::storage {
@@ -14,7 +16,21 @@ byte *UndoBuffer::NewEntry(const uint32_t size) {
   return last_record_;
 }
 
+byte *UndoBuffer::NewEntries(const uint32_t size, const uint32_t max_count, uint32_t *const count) {
+  NOISEPAGE_ASSERT(max_count > 0, "must reserve at least one record");
+  byte *const result = NewEntry(size);
+  RecordBufferSegment *const segment = buffers_.back();
+  const uint32_t fit = (common::Constants::BUFFER_SEGMENT_SIZE - segment->size_) / size;
+  *count = 1 + std::min(max_count - 1, fit);
+  if (*count > 1) {
+    segment->Reserve((*count - 1) * size);
+    last_record_ = result + (*count - 1) * size;
+  }
+  return result;
+}
+
 byte *RedoBuffer::NewEntry(const uint32_t size, const transaction::TransactionPolicy &policy) {
+  previous_record_ = last_record_;
   if (buffer_seg_ == nullptr) {
     // this is the first write
     buffer_seg_ = buffer_pool_->Get();
@@ -29,6 +45,7 @@ byte *RedoBuffer::NewEntry(const uint32_t size, const transaction::TransactionPo
       buffer_pool_->Release(buffer_seg_);
     }
     buffer_seg_ = buffer_pool_->Get();
+    previous_record_ = nullptr;
   }
   NOISEPAGE_ASSERT(buffer_seg_->HasBytesLeft(size),
                    "Staged write does not fit into redo buffer (even after a fresh one is requested)");
@@ -4,6 +4,8 @@
 #include <vector>
 
 #include "storage/projected_row.h"
+#include "storage/varlen_allocator.h"
+#include "storage/varlen_compression.h"
 
 namespace noisepage::storage {
 
@@ -12,6 +14,7 @@ std::pair<LogRecord *, std::vector<byte *>> AbstractLogProvider::ReadNextRecord(
   std::vector<byte *> varlen_contents;
   // Read in LogRecord header data
   auto size = ReadValue<uint32_t>();
+  if ((size & LogRecord::NATIVE_FORMAT_FLAG) != 0) return ReadNativeRedoRecord(size & ~LogRecord::NATIVE_FORMAT_FLAG);
   byte *buf = common::AllocationUtil::AllocateAligned(size);
   auto record_type = ReadValue<storage::LogRecordType>();
   auto txn_begin = ReadValue<transaction::timestamp_t>();
@@ -103,22 +106,20 @@ std::pair<LogRecord *, std::vector<byte *>> AbstractLogProvider::ReadNextRecord(
         auto *column_value_address = delta->AccessForceNotNull(i);
         // Need to mask off sign bit from VARLEN_COLUMN to get the varlen size
         if (attr_sizes[i] == AttrSizeBytes(VARLEN_COLUMN)) {
-          // Read how many bytes this varlen actually is.
-          const auto varlen_attribute_size = ReadValue<uint32_t>();
+          // Read how many bytes this varlen actually is, and whether its content was compressed.
+          const auto serialized_size = ReadValue<uint32_t>();
+          const auto varlen_attribute_size = serialized_size & ~VarlenCompression::COMPRESSED_FLAG;
 
           // Create the varlen entry depending on whether it can be inlined or not
           storage::VarlenEntry varlen_entry;
-          if (varlen_attribute_size <= storage::VarlenEntry::InlineThreshold()) {
+          if ((serialized_size & VarlenCompression::COMPRESSED_FLAG) == 0 &&
+              varlen_attribute_size <= storage::VarlenEntry::InlineThreshold()) {
             // Because it's inline, we can just read it into a stack object, as the varlen constructor will memcpy it
             byte varlen_attribute_content[varlen_attribute_size];
             Read(&varlen_attribute_content, varlen_attribute_size);
             varlen_entry = storage::VarlenEntry::CreateInline(varlen_attribute_content, varlen_attribute_size);
           } else {
-            // Allocate a varlen buffer of this many bytes.
-            auto *varlen_attribute_content = common::AllocationUtil::AllocateAligned(varlen_attribute_size);
-            // Fill the entry with the next bytes from the log file.
-            Read(varlen_attribute_content, varlen_attribute_size);
-
+            auto *varlen_attribute_content = ReadVarlenContent(serialized_size);
             varlen_entry = storage::VarlenEntry::Create(varlen_attribute_content, varlen_attribute_size, true);
             varlen_contents.push_back(varlen_attribute_content);
           }
@@ -143,4 +144,61 @@ std::pair<LogRecord *, std::vector<byte *>> AbstractLogProvider::ReadNextRecord(
                                std::to_string(static_cast<uint8_t>(record_type)));
   }
 }
+
+std::pair<LogRecord *, std::vector<byte *>> AbstractLogProvider::ReadNativeRedoRecord(const uint32_t size) {
+  if (size < sizeof(LogRecord) + sizeof(RedoRecord) || size > common::Constants::BUFFER_SEGMENT_SIZE) {
+    throw std::runtime_error("Size of redo record deserialized is out of bounds. possible data corruption");
+  }
+  std::vector<byte *> varlen_contents;
+  // The image holds everything but the contents of the varlen entries that are not inlined
+  byte *buf = common::AllocationUtil::AllocateAligned(size);
+  Read(buf, size);
+  auto *result = reinterpret_cast<LogRecord *>(buf);
+  if (result->RecordType() != LogRecordType::REDO || result->Size() != size) {
+    throw std::runtime_error("Header of redo record deserialized does not match its size. possible data corruption");
+  }
+  auto *delta = result->GetUnderlyingRecordBodyAs<RedoRecord>()->Delta();
+
+  const auto num_out_of_line = ReadValue<uint16_t>();
+  for (uint16_t i = 0; i < num_out_of_line; i++) {
+    const auto col_idx = ReadValue<uint16_t>();
+    if (col_idx >= delta->NumColumns()) {
+      throw std::runtime_error("Varlen column deserialized is not in the redo record. possible data corruption");
+    }
+    const auto serialized_size = ReadValue<uint32_t>();
+    auto *varlen_attribute_content = ReadVarlenContent(serialized_size);
+    *reinterpret_cast<VarlenEntry *>(delta->AccessForceNotNull(col_idx)) = VarlenEntry::Create(
+        varlen_attribute_content, serialized_size & ~VarlenCompression::COMPRESSED_FLAG, true);
+    // Store reference to varlen content to clean up incase of abort
+    varlen_contents.push_back(varlen_attribute_content);
+  }
+  return {result, std::move(varlen_contents)};
+}
+
+byte *AbstractLogProvider::ReadVarlenContent(const uint32_t serialized_size) {
+  const auto varlen_attribute_size = serialized_size & ~VarlenCompression::COMPRESSED_FLAG;
+  if (varlen_attribute_size > common::Constants::MAX_VARLEN_SIZE) {
+    throw std::runtime_error("Size of varlen deserialized exceeds max varlen size. possible data corruption");
+  }
+  if ((serialized_size & VarlenCompression::COMPRESSED_FLAG) != 0) {
+    const auto compressed_size = ReadValue<uint32_t>();
+    if (compressed_size > VarlenCompression::MaxCompressedSize(varlen_attribute_size)) {
+      throw std::runtime_error("Size of compressed varlen deserialized is out of bounds. possible data corruption");
+    }
+    compression_buffer_.resize(compressed_size);
+    Read(compression_buffer_.data(), compressed_size);
+    // Allocate a varlen buffer of this many bytes.
+    auto *varlen_attribute_content = VarlenAllocator::Allocate(varlen_attribute_size);
+    if (!VarlenCompression::Decompress(compression_buffer_.data(), compressed_size, varlen_attribute_content,
+                                       varlen_attribute_size)) {
+      VarlenAllocator::Deallocate(varlen_attribute_content);
+      throw std::runtime_error("Compressed varlen content deserialized is malformed. possible data corruption");
+    }
+    return varlen_attribute_content;
+  }
+  // Allocate a varlen buffer of this many bytes, and fill it with the next bytes from the log file.
+  auto *varlen_attribute_content = VarlenAllocator::Allocate(varlen_attribute_size);
+  Read(varlen_attribute_content, varlen_attribute_size);
+  return varlen_attribute_content;
+}
 }  // namespace noisepage::storage
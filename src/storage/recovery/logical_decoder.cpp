@@ -0,0 +1,151 @@
+#include "storage/recovery/logical_decoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "common/json.h"
+#include "execution/sql/runtime_types.h"
+
+namespace noisepage::storage {
+
+namespace {
+
+// Render an unscaled DECIMAL, which does not fit any JSON number, as a string of digits.
+std::string DecimalToString(__int128 value) {
+  const bool negative = value < 0;
+  auto magnitude = negative ? -static_cast<unsigned __int128>(value) : static_cast<unsigned __int128>(value);
+  std::string digits;
+  do {
+    digits.push_back(static_cast<char>('0' + static_cast<int>(magnitude % 10)));
+    magnitude /= 10;
+  } while (magnitude != 0);
+  if (negative) digits.push_back('-');
+  std::reverse(digits.begin(), digits.end());
+  return digits;
+}
+
+// Render the value of a column of a ProjectedRow as JSON.
+common::json ValueToJson(const type::TypeId type, const ProjectedRow &row, const uint16_t offset) {
+  const byte *const value = row.AccessWithNullCheck(offset);
+  if (value == nullptr) return nullptr;
+  switch (type) {
+    case type::TypeId::BOOLEAN:
+      return *reinterpret_cast<const bool *>(value);
+    case type::TypeId::TINYINT:
+      return *reinterpret_cast<const int8_t *>(value);
+    case type::TypeId::SMALLINT:
+      return *reinterpret_cast<const int16_t *>(value);
+    case type::TypeId::INTEGER:
+      return *reinterpret_cast<const int32_t *>(value);
+    case type::TypeId::BIGINT:
+      return *reinterpret_cast<const int64_t *>(value);
+    case type::TypeId::REAL:
+      return *reinterpret_cast<const double *>(value);
+    case type::TypeId::DECIMAL: {
+      __int128 decimal;
+      std::memcpy(&decimal, value, sizeof(decimal));
+      return DecimalToString(decimal);
+    }
+    case type::TypeId::DATE:
+      return execution::sql::Date::FromNative(*reinterpret_cast<const execution::sql::Date::NativeType *>(value))
+          .ToString();
+    case type::TypeId::TIMESTAMP:
+      return execution::sql::Timestamp::FromNative(
+                 *reinterpret_cast<const execution::sql::Timestamp::NativeType *>(value))
+          .ToString();
+    case type::TypeId::VARCHAR:
+      return std::string(reinterpret_cast<const VarlenEntry *>(value)->StringView());
+    case type::TypeId::VARBINARY: {
+      // Arbitrary bytes are not valid JSON strings
+      static constexpr char HEX_DIGITS[] = "0123456789abcdef";
+      const auto bytes = reinterpret_cast<const VarlenEntry *>(value)->StringView();
+      std::string hex;
+      hex.reserve(2 * bytes.size());
+      for (const auto c : bytes) {
+        hex.push_back(HEX_DIGITS[static_cast<uint8_t>(c) >> 4]);
+        hex.push_back(HEX_DIGITS[static_cast<uint8_t>(c) & 0xF]);
+      }
+      return hex;
+    }
+    default:
+      throw std::runtime_error("Unsupported column type in a user table.");
+  }
+}
+
+// Render the given columns of a ProjectedRow as a JSON object from column name to value.
+common::json ColumnsToJson(const catalog::Schema &schema, const std::vector<catalog::col_oid_t> &col_oids,
+                           const ProjectedRow &row, const ProjectionMap &row_map) {
+  auto columns = common::json::object();
+  for (const auto col_oid : col_oids) {
+    const auto &column = schema.GetColumn(col_oid);
+    columns[column.Name()] = ValueToJson(column.Type(), row, row_map.at(col_oid));
+  }
+  return columns;
+}
+
+// @return the oids of all the columns of a table
+std::vector<catalog::col_oid_t> AllColumnOids(const catalog::Schema &schema) {
+  std::vector<catalog::col_oid_t> col_oids;
+  col_oids.reserve(schema.GetColumns().size());
+  for (const auto &column : schema.GetColumns()) col_oids.emplace_back(column.Oid());
+  return col_oids;
+}
+
+constexpr const char *CHANGE_TYPE_NAMES[] = {"INSERT", "UPDATE", "DELETE"};
+
+}  // namespace
+
+ChangeEvent LogicalDecoder::Decode(const transaction::timestamp_t txn_id, const ChangeType type,
+                                   const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid,
+                                   const catalog::Schema &schema, const std::vector<catalog::col_oid_t> &key_oids,
+                                   const ProjectedRow &row, const ProjectionMap &row_map, const ProjectedRow *old_row,
+                                   const ProjectionMap *old_row_map,
+                                   const std::vector<catalog::col_oid_t> &written_oids) {
+  common::json event;
+  event["txn"] = txn_id.UnderlyingValue();
+  event["op"] = CHANGE_TYPE_NAMES[static_cast<uint8_t>(type)];
+  event["db"] = db_oid.UnderlyingValue();
+  event["table"] = table_oid.UnderlyingValue();
+
+  // Without a primary key, only the whole row identifies it
+  const auto identity_oids = key_oids.empty() ? AllColumnOids(schema) : key_oids;
+  event["key"] = ColumnsToJson(schema, identity_oids, row, row_map);
+  if (type == ChangeType::UPDATE && old_row != nullptr) {
+    auto old_key = ColumnsToJson(schema, key_oids, *old_row, *old_row_map);
+    if (old_key != event["key"]) event["old_key"] = std::move(old_key);
+  }
+  if (type != ChangeType::DELETE) event["columns"] = ColumnsToJson(schema, written_oids, row, row_map);
+
+  // VARCHAR values are not checked to be UTF-8 when they are written
+  return {type, db_oid, table_oid, event.dump(-1, ' ', false, common::json::error_handler_t::replace)};
+}
+
+void LogicalDecoder::Publish(const transaction::timestamp_t txn_id, std::vector<ChangeEvent> &&changes) {
+  if (changes.empty()) return;
+  std::lock_guard guard(batch_mutex_);
+  for (const auto &change : changes) {
+    batch_.append(change.json_);
+    batch_.push_back('\n');
+  }
+  batch_events_ += static_cast<uint32_t>(changes.size());
+  batch_last_txn_ = txn_id;
+  // Transactions are never split across batches, so a batch may run over the size by one transaction
+  if (batch_events_ >= batch_size_) SendBatch();
+}
+
+void LogicalDecoder::Flush() {
+  std::lock_guard guard(batch_mutex_);
+  if (batch_events_ > 0) SendBatch();
+}
+
+void LogicalDecoder::SendBatch() {
+  sink_(batch_last_txn_, std::move(batch_));
+  batch_ = std::string();
+  batch_events_ = 0;
+}
+
+}  // namespace noisepage::storage
@@ -0,0 +1,48 @@
+#include "storage/recovery/multi_stream_log_provider.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "storage/write_ahead_log/log_manager.h"
+
+namespace noisepage::storage {
+
+MultiStreamLogProvider::MultiStreamLogProvider(const std::vector<std::string> &log_file_paths, const bool compressed) {
+  streams_.reserve(log_file_paths.size());
+  heads_.reserve(log_file_paths.size());
+  for (const auto &path : log_file_paths) {
+    streams_.emplace_back(std::make_unique<DiskLogProvider>(LogManager::LogSegmentPaths(path), compressed));
+    heads_.emplace_back(streams_.back()->GetNextRecord());
+  }
+}
+
+std::pair<LogRecord *, std::vector<byte *>> MultiStreamLogProvider::GetNextRecord() {
+  // Anything but a commit can be handed out right away
+  for (uint32_t stream = 0; stream < heads_.size(); stream++) {
+    auto *const head = heads_[stream].first;
+    if (head != nullptr && head->RecordType() != LogRecordType::COMMIT) return PopHead(stream);
+  }
+
+  // Every stream is either exhausted or stopped at a commit record, so hand out the oldest commit
+  auto oldest = static_cast<uint32_t>(heads_.size());
+  for (uint32_t stream = 0; stream < heads_.size(); stream++) {
+    auto *const head = heads_[stream].first;
+    if (head == nullptr) continue;
+    if (oldest == heads_.size() ||
+        head->GetUnderlyingRecordBodyAs<CommitRecord>()->CommitTime() <
+            heads_[oldest].first->GetUnderlyingRecordBodyAs<CommitRecord>()->CommitTime()) {
+      oldest = stream;
+    }
+  }
+  if (oldest == heads_.size()) return {nullptr, std::vector<byte *>()};
+  return PopHead(oldest);
+}
+
+std::pair<LogRecord *, std::vector<byte *>> MultiStreamLogProvider::PopHead(const uint32_t stream) {
+  auto result = std::move(heads_[stream]);
+  heads_[stream] = streams_[stream]->GetNextRecord();
+  return result;
+}
+
+}  // namespace noisepage::storage
@@ -1,6 +1,11 @@
 #include "storage/recovery/recovery_manager.h"
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <mutex>  // NOLINT
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -17,12 +22,18 @@
 #include "catalog/postgres/pg_proc.h"
 #include "catalog/postgres/pg_type.h"
 #include "common/dedicated_thread_registry.h"
+#include "common/hash_util.h"
 #include "common/json.h"
+#include "common/thread_context.h"
+#include "metrics/metrics_store.h"
 #include "replication/replica_replication_manager.h"
 #include "storage/index/index.h"
 #include "storage/index/index_builder.h"
 #include "storage/index/index_metadata.h"
+#include "storage/recovery/disk_log_provider.h"
 #include "storage/recovery/replication_log_provider.h"
+#include "storage/storage_util.h"
+#include "storage/varlen_allocator.h"
 #include "storage/write_ahead_log/log_io.h"
 #include "transaction/deferred_action_manager.h"
 #include "transaction/transaction_manager.h"
@@ -45,12 +56,26 @@ void RecoveryManager::WaitForRecoveryToFinish() {
   recovery_task_ = nullptr;
 }
 
+void RecoveryManager::SetCheckpoint(CheckpointInfo checkpoint) {
+  NOISEPAGE_ASSERT(recovery_task_ == nullptr, "The checkpoint must be set before recovery starts");
+  unloaded_checkpoint_tables_.clear();
+  unloaded_checkpoint_tables_.insert(checkpoint.tables_.cbegin(), checkpoint.tables_.cend());
+  checkpoint_ = std::move(checkpoint);
+}
+
+void RecoveryManager::SetLogicalDecoder(std::unique_ptr<LogicalDecoder> logical_decoder) {
+  NOISEPAGE_ASSERT(recovery_task_ == nullptr, "The logical decoder must be set before recovery starts");
+  logical_decoder_ = std::move(logical_decoder);
+}
+
 void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogProvider> log_provider) {
   // Replay logs until the log provider no longer gives us logs
   while (true) {
     if (replication_manager_ != DISABLED && replication_manager_->IsReplica() &&
         log_provider->GetType() == AbstractLogProvider::LogProviderType::REPLICATION) {
       auto rlp = log_provider.CastManagedPointerTo<ReplicationLogProvider>();
+      // Changes are batched for as long as there is more to apply right away, and sent before waiting for more
+      if (logical_decoder_ != nullptr && !rlp->EventReady()) logical_decoder_->Flush();
       auto event = rlp->WaitUntilEvent();
 
       if (event == ReplicationLogProvider::ReplicationEvent::END) {
@@ -85,6 +110,19 @@ void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogPr
         NOISEPAGE_ASSERT(pair.second.empty(), "Commit records should not have any varlen pointers");
         auto *commit_record = log_record->GetUnderlyingRecordBodyAs<CommitRecord>();
 
+        // Everything that committed before the checkpoint was taken is visible to the checkpoint's snapshot
+        if (checkpoint_.has_value() && commit_record->CommitTime() < checkpoint_->timestamp_) {
+          checkpointed_txns_.insert(log_record->TxnBegin());
+        }
+
+        {
+          // Queries on replicas may wait for the transaction to be applied, @see BeginReadTransaction
+          std::lock_guard guard(apply_progress_mutex_);
+          const auto now = std::chrono::steady_clock::now();
+          unapplied_txns_.emplace(log_record->TxnBegin(), now);
+          arrivals_.emplace_back(log_record->TxnBegin(), now);
+        }
+
         // We defer all transactions initially
         deferred_txns_.insert(log_record->TxnBegin());
         // Process any deferred transactions that are safe to execute
@@ -105,6 +143,15 @@ void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogPr
   ProcessDeferredTransactions(transaction::INVALID_TXN_TIMESTAMP);
   NOISEPAGE_ASSERT(deferred_txns_.empty(),
                    "We should have no unprocessed deferred transactions at the end of recovery");
+  if (logical_decoder_ != nullptr) logical_decoder_->Flush();
+
+  // Load the checkpointed tables that were not modified by any transaction after the checkpoint
+  if (checkpoint_.has_value()) {
+    for (const auto &table : unloaded_checkpoint_tables_) LoadCheckpointTable(table.first, table.second);
+    unloaded_checkpoint_tables_.clear();
+    checkpointed_txns_.clear();
+    checkpoint_ = std::nullopt;
+  }
 
   // If we have unprocessed buffered changes, then these transactions were in-process at the time of system shutdown.
   // They are unrecoverable, so we need to clean up the memory of their records.
@@ -117,33 +164,73 @@ void RecoveryManager::RecoverFromLogs(const common::ManagedPointer<AbstractLogPr
 }
 
 void RecoveryManager::ProcessCommittedTransaction(noisepage::transaction::timestamp_t txn_id) {
+  // Changes that the checkpoint does not contain must be applied on top of the checkpointed table contents
+  const bool checkpointed = checkpointed_txns_.erase(txn_id) > 0;
+  if (!checkpointed) LoadCheckpointTablesForTxn(txn_id);
+
+  auto buffered_changes = std::move(buffered_changes_map_[txn_id]);
+  buffered_changes_map_.erase(txn_id);
+  std::vector<ChangeEvent> changes;
+  ReplayCommittedTransaction(&buffered_changes, checkpointed, logical_decoder_ != nullptr ? &changes : nullptr);
+  if (logical_decoder_ != nullptr) logical_decoder_->Publish(txn_id, std::move(changes));
+  NotifyTransactionApplied(txn_id);
+}
+
+void RecoveryManager::ReplayCommittedTransaction(
+    std::vector<std::pair<LogRecord *, std::vector<byte *>>> *const buffered_changes, const bool checkpointed,
+    std::vector<ChangeEvent> *const changes) {
   // Begin a txn to replay changes with.
   auto *txn = txn_manager_->BeginTransaction();
 
   // Apply all buffered changes. They should all succeed. After applying we can safely delete the record
-  for (uint32_t idx = 0; idx < buffered_changes_map_[txn_id].size(); idx++) {
-    auto *buffered_record = buffered_changes_map_[txn_id][idx].first;
+  for (uint32_t idx = 0; idx < buffered_changes->size(); idx++) {
+    auto *buffered_record = (*buffered_changes)[idx].first;
     NOISEPAGE_ASSERT(
         buffered_record->RecordType() == LogRecordType::REDO || buffered_record->RecordType() == LogRecordType::DELETE,
         "Buffered record must be a redo or delete.");
 
+    if (checkpointed && IsUserTableRecord(buffered_record)) {
+      // The checkpoint already contains this change. Its varlens were never handed to a table, so free them here.
+      for (auto *varlen_entry : (*buffered_changes)[idx].second) VarlenAllocator::Deallocate(varlen_entry);
+      continue;
+    }
+
     if (IsSpecialCaseCatalogRecord(buffered_record)) {
-      idx += ProcessSpecialCaseCatalogRecord(txn, &buffered_changes_map_[txn_id], idx);
+      idx += ProcessSpecialCaseCatalogRecord(txn, buffered_changes, idx);
     } else if (buffered_record->RecordType() == LogRecordType::REDO) {
-      ReplayRedoRecord(txn, buffered_record);
+      ReplayRedoRecord(txn, buffered_record, nullptr, IsUserTableRecord(buffered_record) ? changes : nullptr);
     } else {
-      ReplayDeleteRecord(txn, buffered_record);
+      ReplayDeleteRecord(txn, buffered_record, IsUserTableRecord(buffered_record) ? changes : nullptr);
     }
   }
 
   // Defer deletes of the log records
-  DeferRecordDeletes(txn_id, false);
-  buffered_changes_map_.erase(txn_id);
+  DeferRecordDeletes(std::move(*buffered_changes), false);
 
   // Commit the txn
   txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+void RecoveryManager::NotifyTransactionApplied(const transaction::timestamp_t txn_id) {
+  std::optional<std::chrono::steady_clock::time_point> arrival;
+  {
+    std::lock_guard guard(apply_progress_mutex_);
+    last_applied_txn_id_ = std::max(last_applied_txn_id_.load(), txn_id);
+    auto it = unapplied_txns_.find(txn_id);
+    if (it != unapplied_txns_.end()) {
+      arrival = it->second;
+      unapplied_txns_.erase(it);
+    }
+    while (!arrivals_.empty() && unapplied_txns_.count(arrivals_.front().first) == 0) arrivals_.pop_front();
+  }
+  apply_progress_cv_.notify_all();
 
-  last_applied_txn_id_ = std::max(last_applied_txn_id_, txn_id);
+  if (arrival.has_value() && common::thread_context.metrics_store_ != nullptr &&
+      common::thread_context.metrics_store_->ComponentToRecord(metrics::MetricsComponent::REPLICATION)) {
+    const auto apply_latency =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - *arrival);
+    common::thread_context.metrics_store_->RecordReplicationApplyData(txn_id.UnderlyingValue(), apply_latency.count());
+  }
   if (replication_manager_ != DISABLED) {
     // Replicas have to send back their list of deferred transactions that were processed, periodically.
     // TODO(WAN): Per Joe's comment, it may be worth sending back transaction IDs to the primary in batches.
@@ -155,14 +242,233 @@ void RecoveryManager::ProcessCommittedTransaction(noisepage::transaction::timest
   }
 }
 
-void RecoveryManager::DeferRecordDeletes(noisepage::transaction::timestamp_t txn_id, bool delete_varlens) {
+std::chrono::microseconds RecoveryManager::ApplyLag() const {
+  if (arrivals_.empty()) return std::chrono::microseconds(0);
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() -
+                                                               arrivals_.front().second);
+}
+
+transaction::TransactionContext *RecoveryManager::BeginReadTransaction(
+    const bool read_only, const transaction::IsolationLevel isolation_level,
+    const std::optional<std::chrono::milliseconds> max_staleness) {
+  if (max_staleness.has_value()) {
+    // The lag only shrinks when a transaction is applied
+    std::unique_lock lock(apply_progress_mutex_);
+    apply_progress_cv_.wait(lock, [&] { return ApplyLag() <= *max_staleness; });
+  }
+  // Replayed transactions that commit in serial order are atomic to new transactions, the rest happen under the latch
+  common::SharedLatch::ScopedSharedLatch guard(&read_snapshot_latch_);
+  return txn_manager_->BeginTransaction(read_only, isolation_level);
+}
+
+void RecoveryManager::ProcessCommittedTransactionsInParallel(const std::vector<transaction::timestamp_t> &txn_ids) {
+  /** A committed transaction that was handed to the replay workers. */
+  struct ParallelReplayTxn {
+    transaction::timestamp_t txn_id_;
+    std::vector<std::pair<LogRecord *, std::vector<byte *>>> buffered_changes_;
+    bool checkpointed_;
+    // The decoded changes of the transaction, published when it is acknowledged
+    std::vector<ChangeEvent> changes_;
+    // Later transactions of the segment that wait for this one, because they write some of the same tuples
+    std::vector<uint32_t> dependents_;
+    // Earlier transactions of the segment that this one still waits for
+    std::atomic<uint32_t> num_dependencies_{0};
+    bool applied_ = false;
+  };
+  // Transactions are only appended while no worker runs, and a deque never moves its elements
+  std::deque<ParallelReplayTxn> segment;
+  // The last transaction of the segment to write a tuple or table, @see GetReplayConflicts
+  std::unordered_map<common::hash_t, uint32_t> last_writers;
+  std::unordered_map<common::hash_t, bool> unique_tables;
+  std::vector<common::hash_t> conflict_keys;
+  // Looks up the indexes of the tables, begun after the last barrier so that it sees the indexes the barrier created
+  transaction::TransactionContext *lookup_txn = nullptr;
+  std::mutex progress_mutex;
+  uint32_t next_to_notify = 0;
+
+  // Replays a transaction, then the transactions that only waited for it
+  std::function<void(uint32_t)> replay = [&](const uint32_t idx) {
+    auto &replay_txn = segment[idx];
+    ReplayCommittedTransaction(&replay_txn.buffered_changes_, replay_txn.checkpointed_,
+                               logical_decoder_ != nullptr ? &replay_txn.changes_ : nullptr);
+    {
+      // Acknowledge transactions in commit order, once all the ones before them are applied too
+      std::lock_guard guard(progress_mutex);
+      replay_txn.applied_ = true;
+      while (next_to_notify < segment.size() && segment[next_to_notify].applied_) {
+        auto &applied_txn = segment[next_to_notify++];
+        if (logical_decoder_ != nullptr) {
+          logical_decoder_->Publish(applied_txn.txn_id_, std::move(applied_txn.changes_));
+        }
+        NotifyTransactionApplied(applied_txn.txn_id_);
+      }
+    }
+    for (const auto dependent : replay_txn.dependents_) {
+      if (--segment[dependent].num_dependencies_ == 0) {
+        replay_workers_->SubmitTask([&replay, dependent] { replay(dependent); });
+      }
+    }
+  };
+
+  // Replays the current segment of transactions on the workers and waits until it is done
+  const auto replay_segment = [&] {
+    if (lookup_txn != nullptr) {
+      txn_manager_->Commit(lookup_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+      lookup_txn = nullptr;
+    }
+    if (segment.empty()) return;
+    {
+      // Transactions that read the tables see all of the segment or none of it
+      common::SharedLatch::ScopedExclusiveLatch guard(&read_snapshot_latch_);
+      replaying_in_parallel_ = true;
+      // Transactions are only submitted by the workers once the first ones are all submitted, or they may run twice
+      std::vector<uint32_t> roots;
+      for (uint32_t idx = 0; idx < segment.size(); idx++) {
+        if (segment[idx].num_dependencies_ == 0) roots.push_back(idx);
+      }
+      for (const auto idx : roots) replay_workers_->SubmitTask([&replay, idx] { replay(idx); });
+      replay_workers_->WaitUntilAllFinished();
+      replaying_in_parallel_ = false;
+    }
+    NOISEPAGE_ASSERT(next_to_notify == segment.size(), "Every transaction of the segment should have been applied");
+
+    segment.clear();
+    last_writers.clear();
+    unique_tables.clear();
+    next_to_notify = 0;
+  };
+
+  for (const auto txn_id : txn_ids) {
+    if (lookup_txn == nullptr) lookup_txn = txn_manager_->BeginTransaction();
+    conflict_keys.clear();
+    if (!GetReplayConflicts(lookup_txn, txn_id, &unique_tables, &conflict_keys)) {
+      // Barrier: everything before this transaction must be applied before it, and everything after it waits for it
+      replay_segment();
+      ProcessCommittedTransaction(txn_id);
+      continue;
+    }
+
+    const auto idx = static_cast<uint32_t>(segment.size());
+    auto &replay_txn = segment.emplace_back();
+    replay_txn.txn_id_ = txn_id;
+    replay_txn.buffered_changes_ = std::move(buffered_changes_map_[txn_id]);
+    replay_txn.checkpointed_ = checkpointed_txns_.erase(txn_id) > 0;
+    buffered_changes_map_.erase(txn_id);
+    for (const auto key : conflict_keys) {
+      const auto it = last_writers.find(key);
+      if (it != last_writers.end() && it->second != idx) {
+        // Transactions are added in order, so a dependency found twice was just added
+        auto &dependents = segment[it->second].dependents_;
+        if (dependents.empty() || dependents.back() != idx) {
+          dependents.push_back(idx);
+          replay_txn.num_dependencies_++;
+        }
+      }
+      last_writers[key] = idx;
+    }
+    // Transactions that read the tables cannot begin while a segment is replayed, so keep them from waiting too long
+    if (segment.size() == MAX_REPLAY_SEGMENT_SIZE) replay_segment();
+  }
+  replay_segment();
+}
+
+bool RecoveryManager::GetReplayConflicts(transaction::TransactionContext *const txn,
+                                         const transaction::timestamp_t txn_id,
+                                         std::unordered_map<common::hash_t, bool> *const unique_tables,
+                                         std::vector<common::hash_t> *const conflict_keys) {
+  const bool checkpointed = checkpointed_txns_.find(txn_id) != checkpointed_txns_.end();
+  for (const auto &buffered_pair : buffered_changes_map_[txn_id]) {
+    const LogRecord *const record = buffered_pair.first;
+    if (!IsUserTableRecord(record)) return false;
+    const auto table = GetRecordTable(record);
+    if (!checkpointed && unloaded_checkpoint_tables_.count(table) > 0) return false;
+
+    const common::hash_t table_key = common::HashUtil::CombineHashes(
+        common::HashUtil::Hash(table.first.UnderlyingValue()), common::HashUtil::Hash(table.second.UnderlyingValue()));
+    auto it = unique_tables->find(table_key);
+    if (it == unique_tables->end()) {
+      const auto db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), table.first);
+      NOISEPAGE_ASSERT(db_catalog != nullptr, "No catalog for given database oid");
+      bool unique = false;
+      for (const auto &index : db_catalog->GetIndexes(common::ManagedPointer(txn), table.second)) {
+        unique = unique || index.second.Unique();
+      }
+      it = unique_tables->emplace(table_key, unique).first;
+    }
+
+    // The entries of a unique index may clash between transactions that write different tuples, like one deleting a
+    // key and one inserting it again, so those tables are written in serial order as a whole
+    if (it->second) {
+      conflict_keys->push_back(table_key);
+    } else {
+      const TupleSlot slot = record->RecordType() == LogRecordType::REDO
+                                 ? record->GetUnderlyingRecordBodyAs<RedoRecord>()->GetTupleSlot()
+                                 : record->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTupleSlot();
+      conflict_keys->push_back(common::HashUtil::CombineHashes(table_key, std::hash<TupleSlot>{}(slot)));
+    }
+  }
+  return true;
+}
+
+void RecoveryManager::LoadCheckpointTablesForTxn(const transaction::timestamp_t txn_id) {
+  if (unloaded_checkpoint_tables_.empty()) return;
+  for (const auto &buffered_pair : buffered_changes_map_[txn_id]) {
+    if (!IsUserTableRecord(buffered_pair.first)) continue;
+    const auto table = GetRecordTable(buffered_pair.first);
+    if (unloaded_checkpoint_tables_.erase(table) > 0) LoadCheckpointTable(table.first, table.second);
+  }
+}
+
+void RecoveryManager::LoadCheckpointTable(const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid) {
+  NOISEPAGE_ASSERT(checkpoint_.has_value(), "Loading a table requires a checkpoint");
+  auto *txn = txn_manager_->BeginTransaction();
+
+  // The table may have been dropped by the replayed logs, in which case its checkpointed contents are obsolete
+  auto db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+  if (db_catalog != nullptr) {
+    const auto table_oids = db_catalog->GetTableOids(common::ManagedPointer(txn));
+    if (std::find(table_oids.cbegin(), table_oids.cend(), table_oid) != table_oids.cend()) {
+      DiskLogProvider checkpoint_provider(checkpoint_->path_ + "/" +
+                                          CheckpointManager::TableFileName(db_oid, table_oid));
+      // The indexes are loaded in one batch after the table, rather than one insert per tuple
+      std::vector<std::pair<TupleSlot, ProjectedRow *>> loaded_tuples;
+      while (true) {
+        auto *log_record = checkpoint_provider.GetNextRecord().first;
+        if (log_record == nullptr) break;
+        NOISEPAGE_ASSERT(log_record->RecordType() == LogRecordType::REDO, "Checkpoints only contain redo records");
+        // Each record carries the tuple slot the tuple had when the checkpoint was taken, so this also creates the
+        // mappings that the records after the checkpoint rely on. The table takes ownership of the varlens.
+        ReplayRedoRecord(txn, log_record, &loaded_tuples);
+        deferred_action_manager_->RegisterDeferredAction([=] { delete[] reinterpret_cast<byte *>(log_record); });
+      }
+      if (!loaded_tuples.empty()) {
+        BulkLoadIndexesOnTable(txn, db_oid, table_oid, GetSqlTable(txn, db_oid, table_oid), loaded_tuples);
+      }
+    }
+  }
+
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+std::pair<catalog::db_oid_t, catalog::table_oid_t> RecoveryManager::GetRecordTable(const LogRecord *const record) {
+  if (record->RecordType() == LogRecordType::REDO) {
+    const auto *redo_record = record->GetUnderlyingRecordBodyAs<RedoRecord>();
+    return {redo_record->GetDatabaseOid(), redo_record->GetTableOid()};
+  }
+  NOISEPAGE_ASSERT(record->RecordType() == LogRecordType::DELETE, "Record must be a redo or delete");
+  const auto *delete_record = record->GetUnderlyingRecordBodyAs<DeleteRecord>();
+  return {delete_record->GetDatabaseOid(), delete_record->GetTableOid()};
+}
+
+void RecoveryManager::DeferRecordDeletes(std::vector<std::pair<LogRecord *, std::vector<byte *>>> &&buffered_changes,
+                                         bool delete_varlens) {
   // Capture the changes by value except for changes which we can move
-  deferred_action_manager_->RegisterDeferredAction([=, buffered_changes{std::move(buffered_changes_map_[txn_id])}]() {
+  deferred_action_manager_->RegisterDeferredAction([=, buffered_changes{std::move(buffered_changes)}]() {
     for (auto &buffered_pair : buffered_changes) {
       delete[] reinterpret_cast<byte *>(buffered_pair.first);
       if (delete_varlens) {
         for (auto *varlen_entry : buffered_pair.second) {
-          delete[] varlen_entry;
+          VarlenAllocator::Deallocate(varlen_entry);
         }
       }
     }
@@ -177,9 +483,15 @@ uint32_t RecoveryManager::ProcessDeferredTransactions(noisepage::transaction::ti
       (upper_bound_ts == transaction::INVALID_TXN_TIMESTAMP) ? transaction::timestamp_t(INT64_MAX) : upper_bound_ts;
   auto upper_bound_it = deferred_txns_.upper_bound(upper_bound_ts);
 
-  for (auto it = deferred_txns_.begin(); it != upper_bound_it; it++) {
-    ProcessCommittedTransaction(*it);
-    txns_processed++;
+  if (replay_workers_ != nullptr) {
+    const std::vector<transaction::timestamp_t> txn_ids(deferred_txns_.begin(), upper_bound_it);
+    ProcessCommittedTransactionsInParallel(txn_ids);
+    txns_processed += txn_ids.size();
+  } else {
+    for (auto it = deferred_txns_.begin(); it != upper_bound_it; it++) {
+      ProcessCommittedTransaction(*it);
+      txns_processed++;
+    }
   }
 
   // If we actually processed some txns, remove them from the set
@@ -188,7 +500,9 @@ uint32_t RecoveryManager::ProcessDeferredTransactions(noisepage::transaction::ti
   return txns_processed;
 }
 
-void RecoveryManager::ReplayRedoRecord(transaction::TransactionContext *txn, LogRecord *record) {
+void RecoveryManager::ReplayRedoRecord(transaction::TransactionContext *txn, LogRecord *record,
+                                       std::vector<std::pair<TupleSlot, ProjectedRow *>> *loaded_tuples,
+                                       std::vector<ChangeEvent> *changes) {
   auto *redo_record = record->GetUnderlyingRecordBodyAs<RedoRecord>();
   auto sql_table_ptr = GetSqlTable(txn, redo_record->GetDatabaseOid(), redo_record->GetTableOid());
   if (IsInsertRecord(redo_record)) {
@@ -203,24 +517,71 @@ void RecoveryManager::ReplayRedoRecord(transaction::TransactionContext *txn, Log
                      "ProjectedRow of original and staged records must be identical");
     // Insert will always succeed
     auto new_tuple_slot = sql_table_ptr->Insert(common::ManagedPointer(txn), staged_record);
-    UpdateIndexesOnTable(txn, staged_record->GetDatabaseOid(), staged_record->GetTableOid(), sql_table_ptr,
-                         new_tuple_slot, staged_record->Delta(), true /* insert */);
+    if (loaded_tuples != nullptr) {
+      // The staged record lives in the redo buffer, which may be handed off before the indexes are loaded
+      loaded_tuples->emplace_back(new_tuple_slot, redo_record->Delta());
+    } else {
+      UpdateIndexesOnTable(txn, staged_record->GetDatabaseOid(), staged_record->GetTableOid(), sql_table_ptr,
+                           new_tuple_slot, staged_record->Delta(), true /* insert */);
+    }
     NOISEPAGE_ASSERT(staged_record->GetTupleSlot() == new_tuple_slot,
                      "Insert should update redo record with new tuple slot");
+    if (changes != nullptr) {
+      // An insert writes every column, so its delta is the whole row
+      const auto db_catalog_ptr = GetDatabaseCatalog(txn, staged_record->GetDatabaseOid());
+      const auto written_oids = GetOidsForRedoRecord(sql_table_ptr, staged_record);
+      changes->emplace_back(LogicalDecoder::Decode(
+          record->TxnBegin(), ChangeType::INSERT, staged_record->GetDatabaseOid(), staged_record->GetTableOid(),
+          GetTableSchema(txn, db_catalog_ptr, staged_record->GetTableOid()),
+          GetPrimaryKeyOids(txn, staged_record->GetDatabaseOid(), staged_record->GetTableOid()),
+          *staged_record->Delta(), sql_table_ptr->ProjectionMapForOids(written_oids), nullptr, nullptr,
+          written_oids));
+    }
     // Create a mapping of the old to new tuple. The new tuple slot should be used for future updates and deletes.
+    common::SharedLatch::ScopedExclusiveLatch guard(&tuple_slot_map_latch_);
     tuple_slot_map_[old_tuple_slot] = new_tuple_slot;
   } else {
-    auto new_tuple_slot = tuple_slot_map_[redo_record->GetTupleSlot()];
+    auto new_tuple_slot = GetTupleSlotMapping(redo_record->GetTupleSlot());
     redo_record->SetTupleSlot(new_tuple_slot);
+
+    // An update that changes the primary key also names the row by its key before the update
+    std::vector<catalog::col_oid_t> key_oids;
+    std::vector<catalog::col_oid_t> written_oids;
+    ProjectedRow *old_key = nullptr;
+    if (changes != nullptr) {
+      key_oids = GetPrimaryKeyOids(txn, redo_record->GetDatabaseOid(), redo_record->GetTableOid());
+      written_oids = GetOidsForRedoRecord(sql_table_ptr, redo_record);
+      const bool writes_key = std::any_of(key_oids.cbegin(), key_oids.cend(), [&](const catalog::col_oid_t oid) {
+        return std::find(written_oids.cbegin(), written_oids.cend(), oid) != written_oids.cend();
+      });
+      if (writes_key) old_key = SelectColumns(txn, sql_table_ptr, new_tuple_slot, key_oids);
+    }
+
     // Stage the write. This way the recovery operation is logged if logging is enabled
     auto staged_record = txn->StageRecoveryWrite(record);
     NOISEPAGE_ASSERT(staged_record->GetTupleSlot() == new_tuple_slot, "Staged record must have the mapped tuple slot");
     bool result UNUSED_ATTRIBUTE = sql_table_ptr->Update(common::ManagedPointer(txn), staged_record);
     NOISEPAGE_ASSERT(result, "Buffered changes should always succeed during commit");
+
+    if (changes != nullptr) {
+      // The delta only holds the written columns, so the key is read from the whole row after the update
+      const auto db_catalog_ptr = GetDatabaseCatalog(txn, staged_record->GetDatabaseOid());
+      const auto &schema = GetTableSchema(txn, db_catalog_ptr, staged_record->GetTableOid());
+      std::vector<catalog::col_oid_t> all_oids;
+      for (const auto &col : schema.GetColumns()) all_oids.push_back(col.Oid());
+      auto *row = SelectColumns(txn, sql_table_ptr, new_tuple_slot, all_oids);
+      const auto old_key_map = old_key != nullptr ? sql_table_ptr->ProjectionMapForOids(key_oids) : ProjectionMap();
+      changes->emplace_back(LogicalDecoder::Decode(
+          record->TxnBegin(), ChangeType::UPDATE, staged_record->GetDatabaseOid(), staged_record->GetTableOid(), schema,
+          key_oids, *row, sql_table_ptr->ProjectionMapForOids(all_oids), old_key, &old_key_map, written_oids));
+      delete[] reinterpret_cast<byte *>(row);
+      delete[] reinterpret_cast<byte *>(old_key);
+    }
   }
 }
 
-void RecoveryManager::ReplayDeleteRecord(transaction::TransactionContext *txn, LogRecord *record) {
+void RecoveryManager::ReplayDeleteRecord(transaction::TransactionContext *txn, LogRecord *record,
+                                         std::vector<ChangeEvent> *changes) {
   auto *delete_record = record->GetUnderlyingRecordBodyAs<DeleteRecord>();
   // Get tuple slot
   auto new_tuple_slot = GetTupleSlotMapping(delete_record->GetTupleSlot());
@@ -240,6 +601,12 @@ void RecoveryManager::ReplayDeleteRecord(transaction::TransactionContext *txn, L
   auto *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
   auto pr = initializer.InitializeRow(buffer);
   sql_table_ptr->Select(common::ManagedPointer(txn), new_tuple_slot, pr);
+  if (changes != nullptr) {
+    changes->emplace_back(LogicalDecoder::Decode(
+        record->TxnBegin(), ChangeType::DELETE, delete_record->GetDatabaseOid(), delete_record->GetTableOid(), schema,
+        GetPrimaryKeyOids(txn, delete_record->GetDatabaseOid(), delete_record->GetTableOid()), *pr,
+        sql_table_ptr->ProjectionMapForOids(all_table_oids), nullptr, nullptr, {}));
+  }
 
   // Delete from the table
   bool result UNUSED_ATTRIBUTE = sql_table_ptr->Delete(common::ManagedPointer(txn), new_tuple_slot);
@@ -249,14 +616,36 @@ void RecoveryManager::ReplayDeleteRecord(transaction::TransactionContext *txn, L
   UpdateIndexesOnTable(txn, delete_record->GetDatabaseOid(), delete_record->GetTableOid(), sql_table_ptr,
                        new_tuple_slot, pr, false /* delete */);
   // We can delete the TupleSlot from the map
-  tuple_slot_map_.erase(delete_record->GetTupleSlot());
+  {
+    common::SharedLatch::ScopedExclusiveLatch guard(&tuple_slot_map_latch_);
+    tuple_slot_map_.erase(delete_record->GetTupleSlot());
+  }
   delete[] buffer;
 }
 
-void RecoveryManager::UpdateIndexesOnTable(transaction::TransactionContext *txn, catalog::db_oid_t db_oid,
-                                           catalog::table_oid_t table_oid,
-                                           common::ManagedPointer<storage::SqlTable> table_ptr,
-                                           const TupleSlot &tuple_slot, ProjectedRow *table_pr, const bool insert) {
+std::vector<catalog::col_oid_t> RecoveryManager::GetPrimaryKeyOids(transaction::TransactionContext *txn,
+                                                                   const catalog::db_oid_t db_oid,
+                                                                   const catalog::table_oid_t table_oid) {
+  for (const auto &index : GetIndexesOnTable(txn, db_oid, table_oid)) {
+    if (index.second.Primary()) return index.second.GetIndexedColOids();
+  }
+  return {};
+}
+
+ProjectedRow *RecoveryManager::SelectColumns(transaction::TransactionContext *txn,
+                                             const common::ManagedPointer<SqlTable> sql_table, const TupleSlot slot,
+                                             const std::vector<catalog::col_oid_t> &col_oids) {
+  auto initializer = sql_table->InitializerForProjectedRow(col_oids);
+  auto *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  auto *pr = initializer.InitializeRow(buffer);
+  bool result UNUSED_ATTRIBUTE = sql_table->Select(common::ManagedPointer(txn), slot, pr);
+  NOISEPAGE_ASSERT(result, "Replayed tuples should be visible to the txn that replays them");
+  return pr;
+}
+
+std::vector<std::pair<common::ManagedPointer<index::Index>, const catalog::IndexSchema &>>
+RecoveryManager::GetIndexesOnTable(transaction::TransactionContext *txn, const catalog::db_oid_t db_oid,
+                                   const catalog::table_oid_t table_oid) {
   auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid);
 
   // Stores index objects and schemas
@@ -349,6 +738,38 @@ void RecoveryManager::UpdateIndexesOnTable(transaction::TransactionContext *txn,
       index_objects = db_catalog_ptr->GetIndexes(common::ManagedPointer(txn), table_oid);
   }
 
+  return index_objects;
+}
+
+void RecoveryManager::CopyIndexKey(const common::ManagedPointer<index::Index> index,
+                                   const catalog::IndexSchema &schema, const ProjectionMap &pr_map,
+                                   const ProjectedRow &table_pr, ProjectedRow *const index_pr) {
+  const auto &indexed_attributes = schema.GetIndexedColOids();
+  // Copy in each value from the table PR into the index PR
+  auto num_index_cols = schema.GetColumns().size();
+  NOISEPAGE_ASSERT(num_index_cols == indexed_attributes.size(),
+                   "Only support index keys that are a single column oid");
+  for (uint32_t col_idx = 0; col_idx < num_index_cols; col_idx++) {
+    const auto &col = schema.GetColumn(col_idx);
+    auto index_col_oid = col.Oid();
+    const catalog::col_oid_t &table_col_oid = indexed_attributes[col_idx];
+    if (table_pr.IsNull(pr_map.at(table_col_oid))) {
+      index_pr->SetNull(index->GetKeyOidToOffsetMap().at(index_col_oid));
+    } else {
+      auto size = AttrSizeBytes(col.AttributeLength());
+      std::memcpy(index_pr->AccessForceNotNull(index->GetKeyOidToOffsetMap().at(index_col_oid)),
+                  table_pr.AccessWithNullCheck(pr_map.at(table_col_oid)), size);
+    }
+  }
+}
+
+void RecoveryManager::UpdateIndexesOnTable(transaction::TransactionContext *txn, catalog::db_oid_t db_oid,
+                                           catalog::table_oid_t table_oid,
+                                           common::ManagedPointer<storage::SqlTable> table_ptr,
+                                           const TupleSlot &tuple_slot, ProjectedRow *table_pr, const bool insert) {
+  auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid);
+  const auto index_objects = GetIndexesOnTable(txn, db_oid, table_oid);
+
   // If there's no indexes on the table, we can return
   if (index_objects.empty()) return;
 
@@ -370,31 +791,15 @@ void RecoveryManager::UpdateIndexesOnTable(transaction::TransactionContext *txn,
   NOISEPAGE_ASSERT(pr_map.size() == table_pr->NumColumns(), "Projected row should contain all attributes");
 
   // TODO(Gus): We are going to assume no indexes on expressions below. Having indexes on expressions would require to
-  // evaluate expressions and that's a nightmare
+  // evaluate expressions and that's a nightmare. The same goes for the predicates of partial indexes, so those get an
+  // entry for every tuple. Scans recheck their predicates, so the extra entries are only a cost. Partial indexes are
+  // never unique (see PostgresParser::CreateIndexTransform), so those entries cannot make an insert conflict.
   for (const auto &index_obj : index_objects) {
     auto index = index_obj.first;
     const auto &schema = index_obj.second;
-    const auto &indexed_attributes = schema.GetIndexedColOids();
 
-    // Build the index PR
     auto *index_pr = index->GetProjectedRowInitializer().InitializeRow(index_buffer);
-
-    // Copy in each value from the table PR into the index PR
-    auto num_index_cols = schema.GetColumns().size();
-    NOISEPAGE_ASSERT(num_index_cols == indexed_attributes.size(),
-                     "Only support index keys that are a single column oid");
-    for (uint32_t col_idx = 0; col_idx < num_index_cols; col_idx++) {
-      const auto &col = schema.GetColumn(col_idx);
-      auto index_col_oid = col.Oid();
-      const catalog::col_oid_t &table_col_oid = indexed_attributes[col_idx];
-      if (table_pr->IsNull(pr_map[table_col_oid])) {
-        index_pr->SetNull(index->GetKeyOidToOffsetMap().at(index_col_oid));
-      } else {
-        auto size = AttrSizeBytes(col.AttributeLength());
-        std::memcpy(index_pr->AccessForceNotNull(index->GetKeyOidToOffsetMap().at(index_col_oid)),
-                    table_pr->AccessWithNullCheck(pr_map[table_col_oid]), size);
-      }
-    }
+    CopyIndexKey(index, schema, pr_map, *table_pr, index_pr);
 
     if (insert) {
       bool result UNUSED_ATTRIBUTE = (index->metadata_.GetSchema().Unique())
@@ -409,6 +814,44 @@ void RecoveryManager::UpdateIndexesOnTable(transaction::TransactionContext *txn,
   delete[] index_buffer;
 }
 
+void RecoveryManager::BulkLoadIndexesOnTable(
+    transaction::TransactionContext *txn, const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid,
+    const common::ManagedPointer<storage::SqlTable> table_ptr,
+    const std::vector<std::pair<TupleSlot, ProjectedRow *>> &tuples) {
+  auto db_catalog_ptr = GetDatabaseCatalog(txn, db_oid);
+  const auto index_objects = GetIndexesOnTable(txn, db_oid, table_oid);
+  if (index_objects.empty()) return;
+
+  const auto &table_schema = GetTableSchema(txn, db_catalog_ptr, table_oid);
+  std::vector<catalog::col_oid_t> all_table_oids;
+  for (const auto &col : table_schema.GetColumns()) {
+    all_table_oids.push_back(col.Oid());
+  }
+  auto pr_map = table_ptr->ProjectionMapForOids(all_table_oids);
+
+  for (const auto &index_obj : index_objects) {
+    auto index = index_obj.first;
+    const auto &schema = index_obj.second;
+
+    // Build the keys of every tuple into one buffer, which only has to outlive the load
+    const auto &initializer = index->GetProjectedRowInitializer();
+    const uint32_t key_size = StorageUtil::PadUpToSize(sizeof(uint64_t), initializer.ProjectedRowSize());
+    auto *index_buffer = common::AllocationUtil::AllocateAligned(key_size * tuples.size());
+    std::vector<std::pair<const ProjectedRow *, TupleSlot>> entries;
+    entries.reserve(tuples.size());
+    for (uint64_t i = 0; i < tuples.size(); i++) {
+      NOISEPAGE_ASSERT(pr_map.size() == tuples[i].second->NumColumns(), "Projected row should contain all attributes");
+      auto *index_pr = initializer.InitializeRow(index_buffer + i * key_size);
+      CopyIndexKey(index, schema, pr_map, *tuples[i].second, index_pr);
+      entries.emplace_back(index_pr, tuples[i].first);
+    }
+
+    bool result UNUSED_ATTRIBUTE = index->BulkLoad(common::ManagedPointer(txn), entries);
+    NOISEPAGE_ASSERT(result, "Loading the index should always succeed for a checkpointed table");
+    delete[] index_buffer;
+  }
+}
+
 uint32_t RecoveryManager::ProcessSpecialCaseCatalogRecord(
     transaction::TransactionContext *txn, std::vector<std::pair<LogRecord *, std::vector<byte *>>> *buffered_changes,
     uint32_t start_idx) {
@@ -438,11 +881,25 @@ uint32_t RecoveryManager::ProcessSpecialCaseCatalogRecord(
       NOISEPAGE_ASSERT(curr_record->RecordType() == LogRecordType::DELETE,
                        "Special case pg_attribute record must be a delete");
       // A delete into pg_attribute means we are deleting a column. There are two cases:
-      //  1. Drop column: This requires some additional processing to actually clean up the column
-      //  2. Cascading delete from drop table: In this case, we don't process the record because the DeleteTable catalog
-      //  function will clean up the columns
-      // We currently don't support Case 1
-      return 0;  // Case 2, no additional records processed
+      //  1. Drop column: The table's columns are deleted and the kept ones reinserted, followed by an update of the
+      //  schema in pg_class. We replay the delete like any other, and swap the schema when we reach that update
+      //  2. Cascading delete from drop table/index: The columns are followed by the delete of the pg_class entry. In
+      //  this case, we don't process the record because the DeleteTable catalog function will clean up the columns
+      auto next_idx = start_idx + 1;
+      while (next_idx < buffered_changes->size() &&
+             buffered_changes->at(next_idx).first->RecordType() == LogRecordType::DELETE &&
+             buffered_changes->at(next_idx).first->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTableOid() ==
+                 catalog::postgres::PgAttribute::COLUMN_TABLE_OID) {
+        next_idx++;
+      }
+      if (next_idx < buffered_changes->size() &&
+          buffered_changes->at(next_idx).first->RecordType() == LogRecordType::DELETE &&
+          buffered_changes->at(next_idx).first->GetUnderlyingRecordBodyAs<DeleteRecord>()->GetTableOid() ==
+              catalog::postgres::PgClass::CLASS_TABLE_OID) {
+        return 0;  // Case 2, no additional records processed
+      }
+      ReplayDeleteRecord(txn, curr_record, nullptr);
+      return 0;  // Case 1, no additional records processed
     }
 
     case (catalog::postgres::PgIndex::INDEX_TABLE_OID.UnderlyingValue()): {
@@ -607,8 +1064,8 @@ uint32_t RecoveryManager::ProcessSpecialCasePGClassRecord(
 
     // Updates to pg_class will happen in the following 3 cases:
     //  1. If we update the next col oid. In this case, we don't need to do anything special, just apply the update
-    //  2. If we update the schema column, we need to check if this a DDL change (add/drop column). We don't do
-    //  anything yet because we don't support DDL changes in the catalog
+    //  2. If we update the schema column of a table that was already recreated, this is a DDL change (drop column),
+    //  and we need to rebuild the schema from the columns in pg_attribute
     //  3. If we update the ptr column, this means we've inserted a new object and we need to recreate the object, and
     //  set the pointer again.
     auto pg_class_ptr = db_catalog->pg_core_.classes_;
@@ -623,7 +1080,44 @@ uint32_t RecoveryManager::ProcessSpecialCasePGClassRecord(
       }
 
       case (catalog::postgres::PgClass::REL_SCHEMA.oid_.UnderlyingValue()): {  // Case 2
-        // TODO(Gus): Add support for recovering DDL changes.
+        // Step 1: Get the class oid, kind, schema and pointer of the object we're updating
+        std::vector<catalog::col_oid_t> col_oids = {
+            catalog::postgres::PgClass::RELOID.oid_, catalog::postgres::PgClass::RELKIND.oid_,
+            catalog::postgres::PgClass::REL_SCHEMA.oid_, catalog::postgres::PgClass::REL_PTR.oid_};
+        auto pr_init = pg_class_ptr->InitializerForProjectedRow(col_oids);
+        auto pr_map = pg_class_ptr->ProjectionMapForOids(col_oids);
+        auto *buffer = common::AllocationUtil::AllocateAligned(pr_init.ProjectedRowSize());
+        auto *pr = pr_init.InitializeRow(buffer);
+        pg_class_ptr->Select(common::ManagedPointer(txn), GetTupleSlotMapping(redo_record->GetTupleSlot()), pr);
+        auto class_oid =
+            *(reinterpret_cast<uint32_t *>(pr->AccessWithNullCheck(pr_map[catalog::postgres::PgClass::RELOID.oid_])));
+        auto class_kind = *(reinterpret_cast<catalog::postgres::PgClass::RelKind *>(
+            pr->AccessWithNullCheck(pr_map[catalog::postgres::PgClass::RELKIND.oid_])));
+        auto *const old_schema_ptr = pr->AccessWithNullCheck(pr_map[catalog::postgres::PgClass::REL_SCHEMA.oid_]);
+        const bool recreated = pr->AccessWithNullCheck(pr_map[catalog::postgres::PgClass::REL_PTR.oid_]) != nullptr;
+        auto *const old_schema =
+            old_schema_ptr == nullptr ? nullptr : *reinterpret_cast<catalog::Schema **>(old_schema_ptr);
+        delete[] buffer;
+
+        // The schema of an object that is not recreated yet is set when its pointer is (Case 3)
+        if (class_kind != catalog::postgres::PgClass::RelKind::REGULAR_TABLE || !recreated) {
+          return 0;  // No additional logs processed
+        }
+
+        // Step 2: Rebuild the schema from the columns that were kept in pg_attribute, and swap it in. The table
+        // itself is untouched, since dropping columns does not rewrite its tuples.
+        auto schema_cols = db_catalog->GetColumns<catalog::Schema::Column, catalog::table_oid_t, catalog::col_oid_t>(
+            common::ManagedPointer(txn), catalog::table_oid_t(class_oid));
+        auto *schema = new catalog::Schema(std::move(schema_cols));
+        bool result UNUSED_ATTRIBUTE = db_catalog->SetTableSchemaPointer<RecoveryManager>(
+            common::ManagedPointer(txn), catalog::table_oid_t(class_oid), schema);
+        NOISEPAGE_ASSERT(result, "Setting table schema pointer should succeed, entry should be in pg_class already");
+
+        // Step 3: Free the old schema once no transaction can be reading it, as UpdateSchema does
+        txn->RegisterCommitAction([=](transaction::DeferredActionManager *deferred_action_manager) {
+          deferred_action_manager->RegisterDeferredAction(
+              [=]() { deferred_action_manager->RegisterDeferredAction([=]() { delete old_schema; }); });
+        });
         return 0;  // No additional logs processed
       }
 
@@ -694,7 +1188,7 @@ uint32_t RecoveryManager::ProcessSpecialCasePGClassRecord(
             col_oids.clear();
             col_oids = {catalog::postgres::PgIndex::INDISUNIQUE.oid_, catalog::postgres::PgIndex::INDISPRIMARY.oid_,
                         catalog::postgres::PgIndex::INDISEXCLUSION.oid_, catalog::postgres::PgIndex::INDIMMEDIATE.oid_,
-                        catalog::postgres::PgIndex::IND_TYPE.oid_};
+                        catalog::postgres::PgIndex::IND_TYPE.oid_, catalog::postgres::PgIndex::INDPRED.oid_};
             auto pg_index_pr_init = db_catalog->pg_core_.indexes_->InitializerForProjectedRow(col_oids);
             auto pg_index_pr_map = db_catalog->pg_core_.indexes_->ProjectionMapForOids(col_oids);
             delete[] buffer;  // Delete old buffer, it won't be large enough for this PR
@@ -714,9 +1208,16 @@ uint32_t RecoveryManager::ProcessSpecialCasePGClassRecord(
             storage::index::IndexType index_type = *(reinterpret_cast<storage::index::IndexType *>(
                 pr->AccessWithNullCheck(pg_index_pr_map[catalog::postgres::PgIndex::IND_TYPE.oid_])));
 
+            const auto *pred_varlen = reinterpret_cast<VarlenEntry *>(
+                pr->AccessWithNullCheck(pg_index_pr_map[catalog::postgres::PgIndex::INDPRED.oid_]));
+
             // Step 4: Create and set IndexSchema in catalog
             auto *index_schema =
                 new catalog::IndexSchema(index_cols, index_type, is_unique, is_primary, is_exclusion, is_immediate);
+            if (pred_varlen != nullptr) {
+              auto deserialized = parser::DeserializeExpression(nlohmann::json::parse(pred_varlen->StringView()));
+              index_schema->SetPredicate(std::move(deserialized.result_));
+            }
             result = db_catalog->SetIndexSchemaPointer<RecoveryManager>(common::ManagedPointer(txn),
                                                                         catalog::index_oid_t(class_oid), index_schema);
             NOISEPAGE_ASSERT(result,
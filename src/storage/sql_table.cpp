@@ -1,16 +1,20 @@
 #include "storage/sql_table.h"
 
+#include <algorithm>
 #include <map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "catalog/schema.h"
 #include "common/macros.h"
+#include "execution/sql/vector_projection.h"
 #include "storage/storage_util.h"
 
 namespace noisepage::storage {
 
-SqlTable::SqlTable(const common::ManagedPointer<BlockStore> store, const catalog::Schema &schema) {
+SqlTable::SqlTable(const common::ManagedPointer<BlockStore> store, const catalog::Schema &schema,
+                   const std::vector<std::vector<catalog::col_oid_t>> &column_groups) {
   // Begin with the NUM_RESERVED_COLUMNS in the attr_sizes
   std::vector<uint16_t> attr_sizes;
   attr_sizes.reserve(NUM_RESERVED_COLUMNS + schema.GetColumns().size());
@@ -52,10 +56,87 @@ SqlTable::SqlTable(const common::ManagedPointer<BlockStore> store, const catalog
     }
   }
 
-  auto layout = storage::BlockLayout(attr_sizes);
+  std::vector<std::vector<col_id_t>> group_col_ids;
+  for (const auto &group : column_groups) {
+    auto &col_ids = group_col_ids.emplace_back();
+    for (const catalog::col_oid_t oid : group) col_ids.push_back(col_map.at(oid).col_id_);
+  }
+
+  auto layout = storage::BlockLayout(attr_sizes, std::move(group_col_ids));
   table_ = {new DataTable(store, layout, layout_version_t(0)), layout, col_map};
 }
 
+void SqlTable::InsertBatch(const common::ManagedPointer<transaction::TransactionContext> txn,
+                           const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid,
+                           ProjectedColumns *const redos, TupleSlot *const results) const {
+  table_.data_table_->InsertBatch(txn, redos, results);
+  const std::vector<col_id_t> col_ids(redos->ColumnIds(), redos->ColumnIds() + redos->NumColumns());
+  StageInserts(txn, db_oid, table_oid, col_ids, redos->NumTuples(),
+               [=](const uint32_t i) { return redos->InterpretAsRow(i); }, results);
+}
+
+void SqlTable::InsertBatch(const common::ManagedPointer<transaction::TransactionContext> txn,
+                           const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid,
+                           execution::sql::VectorProjection *const redos, TupleSlot *const results) const {
+  table_.data_table_->InsertBatch(txn, redos, results);
+  std::vector<uint32_t> rows;
+  rows.reserve(redos->GetSelectedTupleCount());
+  execution::sql::TupleIdList tids(redos->GetTotalTupleCount());
+  redos->CopySelectionsTo(&tids);
+  tids.ForEach([&](const uint32_t tid) { rows.push_back(tid); });
+  StageInserts(txn, db_oid, table_oid, redos->ColumnIds(), static_cast<uint32_t>(rows.size()),
+               [&](const uint32_t i) { return redos->InterpretAsRow(rows[i]); }, results);
+}
+
+template <class RowAt>
+void SqlTable::StageInserts(const common::ManagedPointer<transaction::TransactionContext> txn,
+                            const catalog::db_oid_t db_oid, const catalog::table_oid_t table_oid,
+                            const std::vector<col_id_t> &col_ids, const uint32_t num_tuples, RowAt row_at,
+                            const TupleSlot *const slots) const {
+  if (num_tuples == 0) return;
+  const auto initializer = ProjectedRowInitializer::Create(table_.layout_, col_ids);
+  // The redo records order their attributes by size, which need not be the order of the batch
+  std::vector<uint16_t> batch_index(initializer.NumColumns());
+  for (uint16_t i = 0; i < initializer.NumColumns(); i++) {
+    batch_index[i] = static_cast<uint16_t>(std::find(col_ids.begin(), col_ids.end(), initializer.ColId(i)) -
+                                           col_ids.begin());
+  }
+  for (uint32_t t = 0; t < num_tuples; t++) {
+    // A staged record is only valid until the next one is staged, so each is completed right away
+    RedoRecord *const redo = txn->StageWrite(db_oid, table_oid, initializer);
+    const auto row = row_at(t);
+    for (uint16_t i = 0; i < initializer.NumColumns(); i++) {
+      StorageUtil::CopyWithNullCheck(row.AccessWithNullCheck(batch_index[i]), redo->Delta(),
+                                     table_.layout_.AttrSize(initializer.ColId(i)), i);
+    }
+    redo->SetTupleSlot(slots[t]);
+  }
+}
+
+void SqlTable::CoalesceRedo(const common::ManagedPointer<transaction::TransactionContext> txn,
+                            const RedoRecord *const redo) const {
+  auto *const previous = reinterpret_cast<LogRecord *>(txn->RedoBufferOfThisThread()->PreviousRecord());
+  if (previous == nullptr || previous->RecordType() != LogRecordType::REDO) return;
+  auto *const previous_redo = previous->GetUnderlyingRecordBodyAs<RedoRecord>();
+  if (previous_redo->GetTupleSlot() != redo->GetTupleSlot() || previous_redo->GetTableOid() != redo->GetTableOid() ||
+      previous_redo->GetDatabaseOid() != redo->GetDatabaseOid()) {
+    return;
+  }
+
+  // Both deltas order their attributes the same way, so one pass tells whether the previous one covers this one
+  const ProjectedRow &delta = *redo->Delta();
+  ProjectedRow *const previous_delta = previous_redo->Delta();
+  uint16_t previous_i = 0;
+  for (uint16_t i = 0; i < delta.NumColumns(); i++, previous_i++) {
+    while (previous_i < previous_delta->NumColumns() && previous_delta->ColumnIds()[previous_i] != delta.ColumnIds()[i])
+      previous_i++;
+    if (previous_i == previous_delta->NumColumns()) return;
+  }
+
+  StorageUtil::ApplyDelta(table_.layout_, delta, previous_delta);
+  txn->RedoBufferOfThisThread()->RetractLastRecord();
+}
+
 std::vector<col_id_t> SqlTable::ColIdsForOids(const std::vector<catalog::col_oid_t> &col_oids) const {
   NOISEPAGE_ASSERT(!col_oids.empty(), "Should be used to access at least one column.");
   std::vector<col_id_t> col_ids;
@@ -51,6 +51,40 @@ template void StorageUtil::CopyAttrIntoProjection<ProjectedColumns::RowView>(con
 template void StorageUtil::CopyAttrIntoProjection<execution::sql::VectorProjection::RowView>(
     const TupleAccessStrategy &, TupleSlot, execution::sql::VectorProjection::RowView *, uint16_t);
 
+uint16_t StorageUtil::CopyAttrSpanIntoProjection(const TupleAccessStrategy &accessor, const TupleSlot from,
+                                                 ProjectedRow *const to, const uint16_t projection_list_offset) {
+  const BlockLayout &layout = accessor.GetBlockLayout();
+  const col_id_t first = to->ColumnIds()[projection_list_offset];
+  const uint32_t first_offset = to->AttrValueOffset(projection_list_offset);
+  auto end = static_cast<uint16_t>(projection_list_offset + 1);
+  if (!layout.IsColumnar(first)) {
+    for (; end < to->NumColumns(); end++) {
+      const col_id_t col_id = to->ColumnIds()[end];
+      if (layout.ColumnGroup(col_id) != layout.ColumnGroup(first)) break;
+      // Both are laid out in ascending order of column ids, but either may have padding the other does not
+      const auto distance = static_cast<uint32_t>(layout.AttrGroupOffset(col_id) - layout.AttrGroupOffset(first));
+      if (distance != to->AttrValueOffset(end) - first_offset) break;
+    }
+  }
+  if (end == projection_list_offset + 1) {
+    CopyAttrIntoProjection(accessor, from, to, projection_list_offset);
+    return 1;
+  }
+
+  // The values of null attributes, and the padding between the values, are copied along but never read
+  const col_id_t last = to->ColumnIds()[end - 1];
+  const auto span_size =
+      static_cast<uint32_t>(layout.AttrGroupOffset(last) + layout.AttrSize(last) - layout.AttrGroupOffset(first));
+  std::memcpy(reinterpret_cast<byte *>(to) + first_offset, accessor.AccessWithoutNullCheck(from, first), span_size);
+  for (uint16_t i = projection_list_offset; i < end; i++) {
+    if (accessor.IsNull(from, to->ColumnIds()[i]))
+      to->SetNull(i);
+    else
+      to->SetNotNull(i);
+  }
+  return static_cast<uint16_t>(end - projection_list_offset);
+}
+
 template <class RowType>
 void StorageUtil::CopyAttrFromProjection(const TupleAccessStrategy &accessor, const TupleSlot to, const RowType &from,
                                          const uint16_t projection_list_offset) {
@@ -211,7 +245,7 @@ void StorageUtil::DeallocateVarlens(RawBlock *block, const TupleAccessStrategy &
       if (!accessor.Allocated(slot)) continue;
       auto *entry = reinterpret_cast<VarlenEntry *>(accessor.AccessWithNullCheck(slot, col));
       // If entry is null here, the varlen entry is a null SQL value.
-      if (entry != nullptr && entry->NeedReclaim()) delete[] entry->Content();
+      if (entry != nullptr && entry->NeedReclaim()) VarlenAllocator::Deallocate(entry->Content());
     }
   }
 }
@@ -1,5 +1,6 @@
 #include "storage/tuple_access_strategy.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "common/container/concurrent_bitmap.h"
@@ -7,19 +8,23 @@
 namespace noisepage::storage {
 
 TupleAccessStrategy::TupleAccessStrategy(BlockLayout layout)
-    : layout_(std::move(layout)), column_offsets_(layout_.NumColumns()) {
+    : layout_(std::move(layout)), column_offsets_(layout_.NumColumns()), value_offsets_(layout_.NumColumns()) {
   // Calculate the start position of each column
   // we use 64-bit vectorized scans on bitmaps.
   uint32_t acc_offset = layout_.HeaderSize();
   NOISEPAGE_ASSERT(acc_offset % sizeof(uint64_t) == 0,
                    "size of a header should already be padded to aligned to 8 bytes");
-  for (uint16_t i = 0; i < layout_.NumColumns(); i++) {
-    column_offsets_[i] = acc_offset;
-    uint32_t column_size =
-        layout_.AttrSize(col_id_t(i)) * layout_.NumSlots()  // content
-        + StorageUtil::PadUpToSize(sizeof(uint64_t),
-                                   common::RawBitmap::SizeInBytes(layout_.NumSlots()));  // padded-bitmap size
-    acc_offset += StorageUtil::PadUpToSize(sizeof(uint64_t), column_size);
+  const uint32_t bitmap_size =
+      StorageUtil::PadUpToSize(sizeof(uint64_t), common::RawBitmap::SizeInBytes(layout_.NumSlots()));
+  for (const auto &group : layout_.ColumnGroups()) {
+    for (const col_id_t col_id : group) {
+      column_offsets_[col_id.UnderlyingValue()] = acc_offset;
+      acc_offset += bitmap_size;  // padded-bitmap size
+    }
+    // The rows of the group follow the bitmaps of all of its columns
+    for (const col_id_t col_id : group)
+      value_offsets_[col_id.UnderlyingValue()] = acc_offset + layout_.AttrGroupOffset(col_id);
+    acc_offset += StorageUtil::PadUpToSize(sizeof(uint64_t), layout_.AttrStride(group[0]) * layout_.NumSlots());
     NOISEPAGE_ASSERT(acc_offset <= common::Constants::BLOCK_SIZE, "Offsets cannot be out of block bounds");
   }
 }
@@ -45,20 +50,34 @@ void TupleAccessStrategy::InitializeRawBlock(storage::DataTable *const data_tabl
 }
 
 bool TupleAccessStrategy::Allocate(RawBlock *const block, TupleSlot *const slot) const {
+  return AllocateRun(block, 1, slot) == 1;
+}
+
+uint32_t TupleAccessStrategy::AllocateRun(RawBlock *const block, const uint32_t num_slots,
+                                          TupleSlot *const slots) const {
   common::RawConcurrentBitmap *bitmap = reinterpret_cast<Block *>(block)->SlotAllocationBitmap(layout_);
   const uint32_t start = block->GetInsertHead();
+  // We are not allowed to insert into this block any more once the head reached the end
+  const uint32_t num = std::min(num_slots, layout_.NumSlots() - start);
+  if (num == 0) return 0;
 
-  // We are not allowed to insert into this block any more
-  if (start == layout_.NumSlots()) return false;
-
-  uint32_t pos = start;
   // We do not support concurrent insertion to the same block anymore
   // Assumption: Different threads cannot insert into the same block at the same time
-  // If the block is not full, the function should always succeed (Flip should always return true)
+  // The slots from the head on were never allocated, so the run is claimed a word at a time
+  bitmap->SetRange(start, num);
+  for (uint32_t i = 0; i < num; i++) slots[i] = TupleSlot(block, start + i);
+  // The busy bit of the head is its most significant one, which the offset never reaches
+  block->insert_head_ += num;
+  return num;
+}
+
+bool TupleAccessStrategy::AllocateFreed(RawBlock *const block, const uint32_t start, TupleSlot *const slot) const {
+  common::RawConcurrentBitmap *bitmap = reinterpret_cast<Block *>(block)->SlotAllocationBitmap(layout_);
+  uint32_t pos;
+  if (!bitmap->FirstUnsetPosWide(block->GetInsertHead(), start, &pos)) return false;
   bool UNUSED_ATTRIBUTE flip_res = bitmap->Flip(pos, false);
   NOISEPAGE_ASSERT(flip_res, "Flip should always succeed");
   *slot = TupleSlot(block, pos);
-  block->insert_head_++;
   return true;
 }
 }  // namespace noisepage::storage
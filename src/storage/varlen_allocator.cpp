@@ -0,0 +1,149 @@
+#include "storage/varlen_allocator.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+#include "common/macros.h"
+#include "common/memory_accountant.h"
+#include "common/spin_latch.h"
+
+namespace noisepage::storage {
+
+namespace {
+
+// Sizes of the contents the size classes hold. They grow by about half every step, so no more than a third of a chunk
+// goes unused.
+constexpr std::array<uint32_t, 16> CLASS_SIZES = {16,  32,  48,   64,   96,   128,  192,  256,
+                                                  384, 512, 768, 1024, 1536, 2048, 3072, 4096};
+static_assert(CLASS_SIZES.back() == VarlenAllocator::MAX_POOLED_SIZE);
+constexpr uint32_t NUM_CLASSES = CLASS_SIZES.size();
+
+constexpr uint64_t SLAB_SIZE = 1 << 18;
+// Number of free chunks of a size class a thread holds on to, and how many it moves to or from the shared pool at once
+constexpr uint32_t CACHE_CAPACITY = 64;
+constexpr uint32_t BATCH_SIZE = CACHE_CAPACITY / 2;
+// Tells contents of this allocator apart from ones allocated otherwise, in debug builds
+constexpr uint32_t HEADER_TAG = 0x7661726C;
+
+// Stored right before the content. It keeps the content aligned to 8 bytes.
+struct ChunkHeader {
+  // Contents too large for the size classes store their size instead, which is larger than any size class
+  uint32_t size_class_;
+  uint32_t tag_;
+};
+static_assert(sizeof(ChunkHeader) == sizeof(uint64_t));
+
+uint32_t SizeClassOf(const uint32_t size) {
+  return static_cast<uint32_t>(std::lower_bound(CLASS_SIZES.begin(), CLASS_SIZES.end(), size) - CLASS_SIZES.begin());
+}
+
+uint64_t ChunkSize(const uint32_t size_class) { return sizeof(ChunkHeader) + CLASS_SIZES[size_class]; }
+
+// The free chunks of a size class that no thread holds on to
+class SizeClassPool {
+ public:
+  // Moves num free chunks into chunks, carving new ones out of a slab if there are not enough
+  void Take(std::vector<byte *> *const chunks, const uint32_t num, const uint64_t chunk_size) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    const uint32_t num_free = std::min(num, static_cast<uint32_t>(free_.size()));
+    chunks->insert(chunks->end(), free_.end() - num_free, free_.end());
+    free_.resize(free_.size() - num_free);
+    for (uint32_t i = num_free; i < num; i++) {
+      if (slab_end_ - slab_cursor_ < static_cast<int64_t>(chunk_size)) {
+        slab_cursor_ = common::AllocationUtil::AllocateAligned(SLAB_SIZE);
+        slab_end_ = slab_cursor_ + SLAB_SIZE;
+        slabs_.push_back(slab_cursor_);
+      }
+      chunks->push_back(slab_cursor_);
+      slab_cursor_ += chunk_size;
+    }
+  }
+
+  // Hands back num chunks
+  void Give(byte *const *const chunks, const uint32_t num) {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    free_.insert(free_.end(), chunks, chunks + num);
+  }
+
+ private:
+  common::SpinLatch latch_;
+  std::vector<byte *> free_;
+  byte *slab_cursor_ = nullptr;
+  byte *slab_end_ = nullptr;
+  std::vector<byte *> slabs_;
+};
+
+// The pools are never destroyed, so that threads that exit late can still hand their chunks back
+std::array<SizeClassPool, NUM_CLASSES> &Pools() {
+  static auto *const pools = new std::array<SizeClassPool, NUM_CLASSES>;
+  return *pools;
+}
+
+// The free chunks a thread holds on to
+class ThreadCache {
+ public:
+  ThreadCache() = default;
+
+  ~ThreadCache() {
+    for (uint32_t size_class = 0; size_class < NUM_CLASSES; size_class++) {
+      std::vector<byte *> &chunks = chunks_[size_class];
+      if (!chunks.empty()) Pools()[size_class].Give(chunks.data(), static_cast<uint32_t>(chunks.size()));
+    }
+  }
+
+  DISALLOW_COPY_AND_MOVE(ThreadCache)
+
+  byte *Allocate(const uint32_t size_class) {
+    std::vector<byte *> &chunks = chunks_[size_class];
+    if (chunks.empty()) {
+      chunks.reserve(CACHE_CAPACITY);
+      Pools()[size_class].Take(&chunks, BATCH_SIZE, ChunkSize(size_class));
+    }
+    byte *const chunk = chunks.back();
+    chunks.pop_back();
+    return chunk;
+  }
+
+  void Deallocate(const uint32_t size_class, byte *const chunk) {
+    std::vector<byte *> &chunks = chunks_[size_class];
+    if (chunks.size() == CACHE_CAPACITY) {
+      Pools()[size_class].Give(chunks.data() + CACHE_CAPACITY - BATCH_SIZE, BATCH_SIZE);
+      chunks.resize(CACHE_CAPACITY - BATCH_SIZE);
+    }
+    chunks.push_back(chunk);
+  }
+
+ private:
+  std::array<std::vector<byte *>, NUM_CLASSES> chunks_;
+};
+
+thread_local ThreadCache thread_cache;
+
+}  // namespace
+
+byte *VarlenAllocator::Allocate(const uint32_t size) {
+  const bool large = size > MAX_POOLED_SIZE;
+  const uint32_t size_class = large ? size : SizeClassOf(size);
+  byte *const chunk = large ? common::AllocationUtil::AllocateAligned(sizeof(ChunkHeader) + size)
+                            : thread_cache.Allocate(size_class);
+  *reinterpret_cast<ChunkHeader *>(chunk) = {size_class, HEADER_TAG};
+  common::MemoryAccountant::Allocate(common::MemoryComponent::VARLEN,
+                                     large ? sizeof(ChunkHeader) + size : ChunkSize(size_class));
+  return chunk + sizeof(ChunkHeader);
+}
+
+void VarlenAllocator::Deallocate(const byte *const content) {
+  auto *const chunk = const_cast<byte *>(content) - sizeof(ChunkHeader);  // NOLINT
+  const ChunkHeader header = *reinterpret_cast<const ChunkHeader *>(chunk);
+  NOISEPAGE_ASSERT(header.tag_ == HEADER_TAG, "varlen content was not allocated by the varlen allocator");
+  if (header.size_class_ >= NUM_CLASSES) {
+    common::MemoryAccountant::Free(common::MemoryComponent::VARLEN, sizeof(ChunkHeader) + header.size_class_);
+    delete[] chunk;
+    return;
+  }
+  common::MemoryAccountant::Free(common::MemoryComponent::VARLEN, ChunkSize(header.size_class_));
+  thread_cache.Deallocate(header.size_class_, chunk);
+}
+
+}  // namespace noisepage::storage
@@ -0,0 +1,170 @@
+#include "storage/varlen_compression.h"
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace noisepage::storage {
+
+namespace {
+
+// Shortest match that is encoded as a match instead of literals
+constexpr uint32_t MIN_MATCH = 4;
+// Farthest back a match may start, which is what a 16-bit distance holds
+constexpr uint32_t MAX_DISTANCE = UINT16_MAX;
+// log2 of the number of positions that the compressor remembers, by the hash of the 4 bytes they start with
+constexpr uint32_t HASH_BITS = 13;
+
+uint32_t HashAt(const uint8_t *const pos) {
+  uint32_t word;
+  std::memcpy(&word, pos, sizeof(word));
+  return (word * 2654435761U) >> (32 - HASH_BITS);
+}
+
+// Writes into a buffer of fixed size, and remembers if it ran out of room instead of writing past it
+class Writer {
+ public:
+  Writer(uint8_t *const begin, uint8_t *const end) : begin_(begin), pos_(begin), end_(end) {}
+
+  bool Overflowed() const { return overflowed_; }
+  uint32_t Offset() const { return static_cast<uint32_t>(pos_ - begin_); }
+  uint8_t *Position() const { return pos_; }
+
+  void PutBytes(const uint8_t *const bytes, const uint32_t size) {
+    if (overflowed_ || static_cast<uint32_t>(end_ - pos_) < size) {
+      overflowed_ = true;
+      return;
+    }
+    std::memcpy(pos_, bytes, size);
+    pos_ += size;
+  }
+
+  void PutVarint(uint32_t value) {
+    uint8_t bytes[5];
+    uint32_t size = 0;
+    for (; value >= 0x80; value >>= 7) bytes[size++] = static_cast<uint8_t>(value | 0x80);
+    bytes[size++] = static_cast<uint8_t>(value);
+    PutBytes(bytes, size);
+  }
+
+  void PutDistance(const uint32_t distance) {
+    const uint8_t bytes[2] = {static_cast<uint8_t>(distance), static_cast<uint8_t>(distance >> 8)};
+    PutBytes(bytes, sizeof(bytes));
+  }
+
+ private:
+  uint8_t *const begin_;
+  uint8_t *pos_;
+  uint8_t *const end_;
+  bool overflowed_ = false;
+};
+
+bool GetVarint(const uint8_t **const pos, const uint8_t *const end, uint32_t *const value) {
+  *value = 0;
+  for (uint32_t shift = 0; shift < 35; shift += 7) {
+    if (*pos == end) return false;
+    const uint8_t next = *(*pos)++;
+    *value |= static_cast<uint32_t>(next & 0x7F) << shift;
+    if ((next & 0x80) == 0) return true;
+  }
+  return false;
+}
+
+void CompressChunk(const uint8_t *const in, const uint32_t size, uint32_t *const table, Writer *const out) {
+  std::fill(table, table + (1U << HASH_BITS), 0);
+  uint32_t anchor = 0;
+  uint32_t pos = 0;
+  while (pos + MIN_MATCH <= size) {
+    const uint32_t hash = HashAt(in + pos);
+    // Positions are stored plus one, so that 0 means that there is none
+    const uint32_t candidate = table[hash];
+    table[hash] = pos + 1;
+    if (candidate == 0 || pos - (candidate - 1) > MAX_DISTANCE ||
+        std::memcmp(in + candidate - 1, in + pos, MIN_MATCH) != 0) {
+      // Move faster the longer there has not been a match, so that incompressible contents are given up on quickly
+      pos += 1 + ((pos - anchor) >> 6);
+      continue;
+    }
+    const uint32_t match = candidate - 1;
+    uint32_t length = MIN_MATCH;
+    while (pos + length < size && in[match + length] == in[pos + length]) length++;
+
+    out->PutVarint(pos - anchor);
+    out->PutBytes(in + anchor, pos - anchor);
+    out->PutVarint(length - MIN_MATCH);
+    out->PutDistance(pos - match);
+    if (out->Overflowed()) return;
+    pos += length;
+    anchor = pos;
+  }
+  // The chunk always ends with a run of literals, which may be empty
+  out->PutVarint(size - anchor);
+  out->PutBytes(in + anchor, size - anchor);
+}
+
+bool DecompressChunk(const uint8_t *in, const uint8_t *const in_end, uint8_t *const out, const uint32_t size) {
+  uint32_t pos = 0;
+  while (true) {
+    uint32_t literals;
+    if (!GetVarint(&in, in_end, &literals)) return false;
+    if (literals > size - pos || literals > static_cast<uint32_t>(in_end - in)) return false;
+    std::memcpy(out + pos, in, literals);
+    in += literals;
+    pos += literals;
+    if (in == in_end) return pos == size;
+
+    uint32_t length;
+    if (!GetVarint(&in, in_end, &length) || in_end - in < 2) return false;
+    length += MIN_MATCH;
+    const uint32_t distance = static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8);
+    in += 2;
+    if (distance == 0 || distance > pos || length > size - pos) return false;
+    // The match may overlap the bytes that it produces, so copy byte by byte
+    for (uint32_t i = 0; i < length; i++, pos++) out[pos] = out[pos - distance];
+  }
+}
+
+}  // namespace
+
+uint32_t VarlenCompression::Compress(const byte *const content, const uint32_t size, std::vector<byte> *const out) {
+  // Only a result that is smaller than the content is of any use, so never write more than that
+  out->resize(size);
+  auto *const begin = reinterpret_cast<uint8_t *>(out->data());
+  Writer writer(begin, begin + size);
+  std::vector<uint32_t> table(1U << HASH_BITS);
+  const auto *const in = reinterpret_cast<const uint8_t *>(content);
+
+  for (uint32_t offset = 0; offset < size; offset += CHUNK_SIZE) {
+    const uint32_t chunk_size = std::min(CHUNK_SIZE, size - offset);
+    // Leave room for the compressed length of the chunk, which is only known after it is compressed
+    uint8_t *const length_pos = writer.Position();
+    const uint32_t length_offset = writer.Offset();
+    const uint32_t placeholder = 0;
+    writer.PutBytes(reinterpret_cast<const uint8_t *>(&placeholder), sizeof(placeholder));
+    CompressChunk(in + offset, chunk_size, table.data(), &writer);
+    if (writer.Overflowed()) return 0;
+    const uint32_t chunk_length = writer.Offset() - length_offset - static_cast<uint32_t>(sizeof(uint32_t));
+    std::memcpy(length_pos, &chunk_length, sizeof(chunk_length));
+  }
+  return writer.Offset() < size ? writer.Offset() : 0;
+}
+
+bool VarlenCompression::Decompress(const byte *const compressed, const uint32_t compressed_size, byte *const out,
+                                   const uint32_t size) {
+  const auto *in = reinterpret_cast<const uint8_t *>(compressed);
+  const auto *const in_end = in + compressed_size;
+  auto *const out_bytes = reinterpret_cast<uint8_t *>(out);
+
+  for (uint32_t offset = 0; offset < size; offset += CHUNK_SIZE) {
+    uint32_t chunk_length;
+    if (in_end - in < static_cast<int64_t>(sizeof(chunk_length))) return false;
+    std::memcpy(&chunk_length, in, sizeof(chunk_length));
+    in += sizeof(chunk_length);
+    if (chunk_length > static_cast<uint32_t>(in_end - in)) return false;
+    if (!DecompressChunk(in, in + chunk_length, out_bytes + offset, std::min(CHUNK_SIZE, size - offset))) return false;
+    in += chunk_length;
+  }
+  return in == in_end;
+}
+
+}  // namespace noisepage::storage
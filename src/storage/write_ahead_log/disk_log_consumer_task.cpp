@@ -1,14 +1,24 @@
 #include "storage/write_ahead_log/disk_log_consumer_task.h"
 
+#include <filesystem>
+#include <fstream>
+#include <string>
 #include <thread>  // NOLINT
 
 #include "common/scoped_timer.h"
 #include "common/thread_context.h"
 #include "metrics/metrics_store.h"
+#include "storage/write_ahead_log/log_manager.h"
 
 namespace noisepage::storage {
 
 void DiskLogConsumerTask::RunTask() {
+  // The log manager opened the buffers on the last segment of the log file
+  if (segment_size_ > 0) segment_ = LogManager::LogSegmentPaths(log_file_path_).size() - 1;
+  log_file_size_ = buffers_->front().FileSize();
+  preallocated_end_ = log_file_size_;
+  // The log manager drained the ring into the log file, so everything it held is in the log file
+  ResetRing();
   run_task_ = true;
   DiskLogConsumerTaskLoop();
 }
@@ -22,41 +32,99 @@ void DiskLogConsumerTask::Terminate() {
   disk_log_writer_thread_cv_.notify_one();
 }
 
-void DiskLogConsumerTask::WriteBuffersToLogFile() {
+uint64_t DiskLogConsumerTask::WriteBuffersToLogFile() {
+  const auto num_callbacks = commit_callbacks_.size();
   // Persist all the filled buffers to the disk
   SerializedLogs logs;
   while (!filled_buffer_queue_->Empty()) {
     // Dequeue filled buffers and flush them to disk, as well as storing commit callbacks
     filled_buffer_queue_->Dequeue(&logs);
-    if (logs.first != nullptr) {
+    if (logs.first != nullptr && ring_holds_unpersisted_) {
       // Need the nullptr check because read-only txns don't serialize any buffers, but generate callbacks to be invoked
+      current_data_written_ += logs.first->FlushBuffer(
+          [this](const char *data, uint32_t size) { ring_holds_unpersisted_ = ring_->Append(data, size); });
+    } else if (logs.first != nullptr) {
       current_data_written_ += logs.first->FlushBuffer();
     }
-    commit_callbacks_.insert(commit_callbacks_.end(), logs.second.begin(), logs.second.end());
+    if (ring_holds_unpersisted_) {
+      // Everything this buffer's commits depend on is in the ring, so they are persistent already
+      for (auto &callback : logs.second) callback.fn_(callback.arg_);
+    } else {
+      commit_callbacks_.insert(commit_callbacks_.end(), logs.second.begin(), logs.second.end());
+    }
     // Enqueue the flushed buffer to the empty buffer queue if all serializers are done with it.
     if (logs.first != nullptr && logs.first->MarkSerialized()) {
       // nullptr check for the same reason as above
       empty_buffer_queue_->Enqueue(logs.first);
     }
   }
+  return commit_callbacks_.size() - num_callbacks;
+}
+
+void DiskLogConsumerTask::PreallocateLogFile() {
+  if (preallocation_size_ == 0) return;
+  // Reserve the next chunk once less than half of the current one is left, so the writes never catch up with it
+  if (log_file_size_ + current_data_written_ + preallocation_size_ / 2 < preallocated_end_) return;
+  buffers_->front().Preallocate(preallocated_end_, preallocation_size_);
+  preallocated_end_ += preallocation_size_;
 }
 
 uint64_t DiskLogConsumerTask::PersistLogFile() {
+  uint64_t fsync_latency_us = 0;
+  log_file_size_ += current_data_written_;
   if (current_data_written_ > 0) {
     // Force the buffers to be written to disk. Because all buffers log to the same file, it suffices to call persist on
     // any buffer.
+    common::ScopedTimer<std::chrono::microseconds> timer(&fsync_latency_us);
     buffers_->front().Persist();
   }
+  group_commit_policy_.Persisted(current_data_written_, std::chrono::microseconds(fsync_latency_us));
+  last_fsync_latency_us_ = fsync_latency_us;
+  // The ring is reset before the callbacks are invoked, so that a commit acknowledged by persisting the log file is
+  // never after the location that the ring would be drained to after a crash
+  if (ring_ != nullptr && (ring_->Used() > 0 || !ring_holds_unpersisted_)) ResetRing();
   const auto num_buffers = commit_callbacks_.size();
   // Execute the callbacks for the transactions that have been persisted
   for (auto &callback : commit_callbacks_) callback.fn_(callback.arg_);
   commit_callbacks_.clear();
+  // Everything written to the current segment is persisted, so it can be sealed
+  if (segment_size_ > 0 && log_file_size_ >= segment_size_) StartNewSegment();
   return num_buffers;
 }
 
+void DiskLogConsumerTask::ResetRing() {
+  if (ring_ == nullptr) return;
+  ring_->Reset(segment_, log_file_size_);
+  ring_holds_unpersisted_ = true;
+}
+
+void DiskLogConsumerTask::StartNewSegment() {
+  {
+    std::ofstream manifest(LogManager::LogManifestPath(log_file_path_), std::ios::app);
+    manifest << LogManager::LogSegmentPath(log_file_path_, segment_) << " " << log_file_size_ << "\n";
+    manifest.flush();
+    if (!manifest.good()) STORAGE_LOG_WARN("Failed to record log segment {} in the manifest", segment_);
+  }
+
+  segment_++;
+  const auto segment_path = LogManager::LogSegmentPath(log_file_path_, segment_);
+  for (auto &buffer : *buffers_) buffer.SwitchFile(segment_path.c_str());
+  log_file_size_ = preallocated_end_ = 0;
+  ResetRing();
+
+  // Persist the directory entry of the new segment, fdatasync on the segment itself does not cover it
+  auto directory = std::filesystem::path(segment_path).parent_path();
+  if (directory.empty()) directory = ".";
+  const auto directory_fd = PosixIoWrappers::Open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+  if (fsync(directory_fd) == -1) throw std::runtime_error("fsync failed with errno " + std::to_string(errno));
+  PosixIoWrappers::Close(directory_fd);
+}
+
 void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
   // input for this operating unit
   uint64_t num_bytes = 0, num_buffers = 0;
+  // group commit metrics of the last persist
+  uint64_t fsync_latency_us = 0, group_commit_delay_us = 0;
 
   // Keeps track of how much data we've written to the log file since the last persist
   current_data_written_ = 0;
@@ -86,36 +154,53 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
       // 1) The serializer thread has signalled to persist all non-empty buffers to disk
       // 2) There is a filled buffer to write to the disk
       // 3) LogManager has shut down the task
-      // 4) Our persist interval timed out
-
+      // 4) Our persist interval timed out, or the pending commits reached their group commit deadline
+      const auto wait_time =
+          group_commit_policy_.PendingCommits() > 0
+              ? std::min(curr_sleep, group_commit_policy_.TimeUntilDeadline(GroupCommitPolicy::Clock::now()))
+              : curr_sleep;
       bool signaled = disk_log_writer_thread_cv_.wait_for(
-          lock, curr_sleep, [&] { return force_flush_ || !filled_buffer_queue_->Empty() || !run_task_; });
+          lock, wait_time, [&] { return force_flush_ || !filled_buffer_queue_->Empty() || !run_task_; });
       next_sleep = signaled ? persist_interval_ : curr_sleep * 2;
       next_sleep = std::min(next_sleep, max_sleep);
     }
 
     // Flush all the buffers to the log file
-    WriteBuffersToLogFile();
+    const auto data_written_before = current_data_written_;
+    const auto num_commits = WriteBuffersToLogFile();
+    const auto now = GroupCommitPolicy::Clock::now();
+    group_commit_policy_.CommitsArrived(num_commits, now);
+    PreallocateLogFile();
 
     // We persist the log file if the following conditions are met
-    // 1) The persist interval amount of time has passed since the last persist
-    // 2) We have written more data since the last persist than the threshold
+    // 1) The group commit policy decides that the pending commits should be persisted, either because we have written
+    //    more data since the last persist than the threshold or because the pending commits reached their deadline
+    // 2) There is data without commits that has not been persisted for longer than the persist interval
     // 3) We are signaled to persist
     // 4) We are shutting down this task
-    bool timeout = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() -
-                                                                         last_persist) > curr_sleep;
-
-    if (timeout || current_data_written_ > persist_threshold_ || force_flush_ || !run_task_) {
+    // 5) The ring is half full or full, so the log file has to catch up before the ring runs out of space
+    bool timeout = group_commit_policy_.PendingCommits() == 0 && current_data_written_ > 0 &&
+                   std::chrono::duration_cast<std::chrono::microseconds>(now - last_persist) > curr_sleep;
+    bool ring_filling = ring_ != nullptr && current_data_written_ > 0 &&
+                        (!ring_holds_unpersisted_ || ring_->Used() > ring_->Capacity() / 2);
+
+    if (group_commit_policy_.ShouldPersist(current_data_written_, now) || timeout || ring_filling || force_flush_ ||
+        !run_task_) {
       std::unique_lock<std::mutex> lock(persist_lock_);
+      group_commit_delay_us = static_cast<uint64_t>(group_commit_policy_.Delay().count());
       num_buffers = PersistLogFile();
       num_bytes = current_data_written_;
+      fsync_latency_us = last_fsync_latency_us_;
       // Reset meta data
-      last_persist = std::chrono::high_resolution_clock::now();
+      last_persist = GroupCommitPolicy::Clock::now();
       current_data_written_ = 0;
       force_flush_ = false;
 
       // Signal anyone who forced a persist that the persist has finished
       persist_cv_.notify_all();
+    } else if (current_data_written_ > data_written_before) {
+      // The new data is not persisted yet, but its writeback can already overlap with waiting for more commits
+      buffers_->front().StartWriteback();
     }
 
     if (logging_metrics_enabled && num_buffers > 0) {
@@ -124,6 +209,8 @@ void DiskLogConsumerTask::DiskLogConsumerTaskLoop() {
       auto &resource_metrics = common::thread_context.resource_tracker_.GetMetrics();
       common::thread_context.metrics_store_->RecordConsumerData(num_bytes, num_buffers, persist_interval_.count(),
                                                                 resource_metrics);
+      common::thread_context.metrics_store_->RecordGroupCommitData(num_buffers, num_bytes, fsync_latency_us,
+                                                                   group_commit_delay_us, resource_metrics);
       num_bytes = num_buffers = 0;
     }
   } while (run_task_);
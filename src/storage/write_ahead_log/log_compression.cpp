@@ -0,0 +1,134 @@
+#include "storage/write_ahead_log/log_compression.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+namespace noisepage::storage {
+
+namespace {
+uint32_t Load32(const char *src) {
+  uint32_t value;
+  std::memcpy(&value, src, sizeof(value));
+  return value;
+}
+
+char *WriteLength(char *dest, uint32_t length) {
+  for (; length >= UINT8_MAX; length -= UINT8_MAX) *dest++ = static_cast<char>(UINT8_MAX);
+  *dest++ = static_cast<char>(length);
+  return dest;
+}
+
+const char *ReadLength(const char *src, const char *const end, uint32_t *const length) {
+  uint8_t next;
+  do {
+    if (src == end) throw std::runtime_error("Malformed compressed log buffer: truncated length");
+    next = static_cast<uint8_t>(*src++);
+    *length += next;
+  } while (next == UINT8_MAX);
+  return src;
+}
+}  // namespace
+
+void LogCompression::CompressFrame(const char *const src, const uint32_t size, std::vector<char> *const frame) {
+  frame->resize(sizeof(FrameHeader) + MaxCompressedSize(size));
+  FrameHeader header{Compress(src, size, frame->data() + sizeof(FrameHeader)), size};
+  if (header.stored_size_ >= size) {
+    header.stored_size_ = size;
+    std::memcpy(frame->data() + sizeof(FrameHeader), src, size);
+  }
+  std::memcpy(frame->data(), &header, sizeof(FrameHeader));
+  frame->resize(sizeof(FrameHeader) + header.stored_size_);
+}
+
+void LogCompression::DecompressFrame(const FrameHeader &header, const char *const stored_bytes, char *const dest) {
+  if (header.stored_size_ == header.size_) {
+    std::memcpy(dest, stored_bytes, header.size_);
+    return;
+  }
+  Decompress(stored_bytes, header.stored_size_, dest, header.size_);
+}
+
+uint32_t LogCompression::Compress(const char *const src, const uint32_t size, char *const dest) {
+  // Position of the last occurrence of each hashed 4 byte sequence
+  std::array<uint32_t, 1 << HASH_BITS> last_seen;
+  last_seen.fill(UINT32_MAX);
+
+  char *out = dest;
+  uint32_t anchor = 0, pos = 0;
+  // Emits the literals since the anchor, followed by a match if match_length > 0
+  const auto emit = [&](const uint32_t match_offset, const uint32_t match_length) {
+    const uint32_t num_literals = pos - anchor;
+    const uint32_t extra_match_length = match_length > 0 ? match_length - MIN_MATCH : 0;
+    auto *const token = out++;
+    *token = static_cast<char>((std::min<uint32_t>(num_literals, LENGTH_MASK) << 4) |
+                               std::min<uint32_t>(extra_match_length, LENGTH_MASK));
+    if (num_literals >= LENGTH_MASK) out = WriteLength(out, num_literals - LENGTH_MASK);
+    std::memcpy(out, src + anchor, num_literals);
+    out += num_literals;
+    if (match_length == 0) return;
+    const auto offset = static_cast<uint16_t>(match_offset);
+    std::memcpy(out, &offset, sizeof(offset));
+    out += sizeof(offset);
+    if (extra_match_length >= LENGTH_MASK) out = WriteLength(out, extra_match_length - LENGTH_MASK);
+  };
+
+  while (pos + MIN_MATCH <= size) {
+    const uint32_t sequence = Load32(src + pos);
+    const uint32_t hash = (sequence * 2654435761U) >> (32 - HASH_BITS);
+    const uint32_t candidate = last_seen[hash];
+    last_seen[hash] = pos;
+    if (candidate == UINT32_MAX || pos - candidate > MAX_OFFSET || Load32(src + candidate) != sequence) {
+      pos++;
+      continue;
+    }
+    uint32_t match_length = MIN_MATCH;
+    while (pos + match_length < size && src[candidate + match_length] == src[pos + match_length]) match_length++;
+    emit(pos - candidate, match_length);
+    pos += match_length;
+    anchor = pos;
+  }
+  pos = size;
+  if (anchor < size) emit(0, 0);
+  return static_cast<uint32_t>(out - dest);
+}
+
+void LogCompression::Decompress(const char *src, const uint32_t compressed_size, char *const dest,
+                                const uint32_t size) {
+  const char *const src_end = src + compressed_size;
+  char *out = dest;
+  char *const dest_end = dest + size;
+  while (src < src_end) {
+    const auto token = static_cast<uint8_t>(*src++);
+    uint32_t num_literals = token >> 4;
+    if (num_literals == LENGTH_MASK) src = ReadLength(src, src_end, &num_literals);
+    if (num_literals > static_cast<uint32_t>(src_end - src) || num_literals > static_cast<uint32_t>(dest_end - out)) {
+      throw std::runtime_error("Malformed compressed log buffer: literals out of bounds");
+    }
+    std::memcpy(out, src, num_literals);
+    src += num_literals;
+    out += num_literals;
+    // The last sequence has no match
+    if (src == src_end) break;
+
+    uint16_t offset;
+    if (static_cast<uint32_t>(src_end - src) < sizeof(offset)) {
+      throw std::runtime_error("Malformed compressed log buffer: truncated match offset");
+    }
+    std::memcpy(&offset, src, sizeof(offset));
+    src += sizeof(offset);
+    uint32_t match_length = token & LENGTH_MASK;
+    if (match_length == LENGTH_MASK) src = ReadLength(src, src_end, &match_length);
+    match_length += MIN_MATCH;
+    if (offset == 0 || offset > out - dest || match_length > static_cast<uint32_t>(dest_end - out)) {
+      throw std::runtime_error("Malformed compressed log buffer: match out of bounds");
+    }
+    // The match may overlap with the bytes it produces, so copy byte by byte
+    const char *match = out - offset;
+    for (uint32_t i = 0; i < match_length; i++) *out++ = *match++;
+  }
+  if (out != dest_end) throw std::runtime_error("Malformed compressed log buffer: unexpected decompressed size");
+}
+
+}  // namespace noisepage::storage
@@ -1,6 +1,8 @@
 #include "storage/write_ahead_log/log_io.h"
 
 #include <algorithm>
+#include <vector>
+
 namespace noisepage::storage {
 
 bool BufferedLogReader::Read(void *dest, uint32_t size) {
@@ -25,12 +27,64 @@ void BufferedLogReader::RefillBuffer() {
   NOISEPAGE_ASSERT(read_head_ == filled_size_, "Refilling a buffer that is not fully read results in loss of data");
   if (in_ == -1) throw std::runtime_error("No more bytes left in the log file");
   read_head_ = 0;
-  filled_size_ = PosixIoWrappers::ReadFully(in_, buffer_, common::Constants::LOG_BUFFER_SIZE);
-  if (filled_size_ < common::Constants::LOG_BUFFER_SIZE) {
+  if (compressed_) {
+    RefillBufferFromFrame();
+    return;
+  }
+  filled_size_ = 0;
+  while (in_ != -1 && filled_size_ < common::Constants::LOG_BUFFER_SIZE) {
+    filled_size_ +=
+        PosixIoWrappers::ReadFully(in_, buffer_ + filled_size_, common::Constants::LOG_BUFFER_SIZE - filled_size_);
     // TODO(Tianyu): Is it better to make this an explicit close?
-    PosixIoWrappers::Close(in_);
-    in_ = -1;
+    if (filled_size_ < common::Constants::LOG_BUFFER_SIZE) OpenNextFile();
+  }
+}
+
+void BufferedLogReader::OpenNextFile() {
+  if (in_ != -1) PosixIoWrappers::Close(in_);
+  in_ = -1;
+  if (remaining_files_.empty()) return;
+  in_ = PosixIoWrappers::Open(remaining_files_.front().c_str(), O_RDONLY);
+  remaining_files_.pop_front();
+}
+
+void BufferedLogReader::RefillBufferFromFrame() {
+  const auto header = next_frame_header_;
+  frame_buffer_.resize(header.stored_size_);
+  if (PosixIoWrappers::ReadFully(in_, frame_buffer_.data(), header.stored_size_) < header.stored_size_) {
+    // A frame that was torn by a crash was never persisted, so the log ends before it
+    STORAGE_LOG_WARN("Ignoring incomplete frame at the end of a compressed log file");
+    filled_size_ = 0;
+    remaining_files_.clear();
+    OpenNextFile();
+    return;
+  }
+  LogCompression::DecompressFrame(header, frame_buffer_.data(), buffer_);
+  filled_size_ = header.size_;
+  ReadNextFrameHeader();
+}
+
+void BufferedLogReader::ReadNextFrameHeader() {
+  // Frames never span files, so skip over files until one has a frame left
+  while (in_ != -1) {
+    const auto header_size = PosixIoWrappers::ReadFully(in_, &next_frame_header_, sizeof(next_frame_header_));
+    if (header_size == sizeof(next_frame_header_)) {
+      if (next_frame_header_.size_ > common::Constants::LOG_BUFFER_SIZE ||
+          next_frame_header_.stored_size_ > LogCompression::MaxCompressedSize(next_frame_header_.size_)) {
+        throw std::runtime_error("Malformed frame header in compressed log file");
+      }
+      return;
+    }
+    // Either no frame is left in this file, or the header of the last frame was torn by a crash
+    OpenNextFile();
   }
 }
 
+const std::vector<char> &BufferedLogWriter::CompressBuffer() {
+  // Each consumer thread flushes one buffer at a time, so the frame can be reused across flushes
+  thread_local std::vector<char> frame;
+  LogCompression::CompressFrame(buffer_, buffer_size_, &frame);
+  return frame;
+}
+
 }  // namespace noisepage::storage
@@ -1,84 +1,196 @@
 #include "storage/write_ahead_log/log_manager.h"
 
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "common/dedicated_thread_registry.h"
+#include "common/hash_util.h"
 #include "storage/write_ahead_log/disk_log_consumer_task.h"
 #include "storage/write_ahead_log/log_serializer_task.h"
 #include "transaction/transaction_context.h"
 
 namespace noisepage::storage {
 
+LogManager::LogManager(std::string log_file_path, uint64_t num_buffers,
+                       std::chrono::microseconds serialization_interval, std::chrono::microseconds persist_interval,
+                       uint64_t persist_threshold, common::ManagedPointer<RecordBufferSegmentPool> buffer_pool,
+                       common::ManagedPointer<common::ConcurrentBlockingQueue<BufferedLogWriter *>> empty_buffer_queue,
+                       common::ManagedPointer<replication::PrimaryReplicationManager> primary_replication_manager,
+                       common::ManagedPointer<common::DedicatedThreadRegistry> thread_registry,
+                       const uint32_t num_streams, const uint64_t preallocation_size,
+                       const bool compression_enable, const uint64_t segment_size, std::string ring_path,
+                       const uint64_t ring_size)
+    : DedicatedThreadOwner(thread_registry),
+      run_log_manager_(false),
+      num_buffers_(num_buffers),
+      buffer_pool_(buffer_pool.Get()),
+      serialization_interval_(serialization_interval),
+      persist_interval_(persist_interval),
+      persist_threshold_(persist_threshold),
+      preallocation_size_(preallocation_size),
+      compression_enable_(compression_enable),
+      segment_size_(segment_size),
+      ring_path_(std::move(ring_path)),
+      ring_size_(ring_size),
+      primary_replication_manager_(primary_replication_manager) {
+  NOISEPAGE_ASSERT(num_streams > 0, "LogManager needs at least one log stream");
+  NOISEPAGE_ASSERT(num_streams == 1 || primary_replication_manager == nullptr,
+                   "Replication ships a single log stream to the replicas");
+  for (auto &path : LogFilePaths(log_file_path, num_streams)) {
+    auto stream = std::make_unique<LogStream>();
+    stream->log_file_path_ = std::move(path);
+    if (streams_.empty()) {
+      stream->empty_buffer_queue_ = empty_buffer_queue;
+    } else {
+      stream->owned_empty_buffer_queue_ = std::make_unique<common::ConcurrentBlockingQueue<BufferedLogWriter *>>();
+      stream->empty_buffer_queue_ = common::ManagedPointer(stream->owned_empty_buffer_queue_);
+    }
+    streams_.emplace_back(std::move(stream));
+  }
+}
+
+std::vector<std::string> LogManager::LogFilePaths(const std::string &log_file_path, const uint32_t num_streams) {
+  if (num_streams == 1) return {log_file_path};
+  std::vector<std::string> paths;
+  paths.reserve(num_streams);
+  for (uint32_t i = 0; i < num_streams; i++) paths.emplace_back(log_file_path + "." + std::to_string(i));
+  return paths;
+}
+
+std::string LogManager::LogSegmentPath(const std::string &stream_log_file_path, const uint64_t segment) {
+  if (segment == 0) return stream_log_file_path;
+  return stream_log_file_path + ".seg" + std::to_string(segment);
+}
+
+std::vector<std::string> LogManager::LogSegmentPaths(const std::string &stream_log_file_path) {
+  std::vector<std::string> paths{stream_log_file_path};
+  for (uint64_t segment = 1;; segment++) {
+    auto path = LogSegmentPath(stream_log_file_path, segment);
+    if (!std::filesystem::exists(path)) break;
+    paths.emplace_back(std::move(path));
+  }
+  return paths;
+}
+
+std::string LogManager::LogManifestPath(const std::string &stream_log_file_path) {
+  return stream_log_file_path + ".manifest";
+}
+
 void LogManager::Start() {
   NOISEPAGE_ASSERT(!run_log_manager_, "Can't call Start on already started LogManager");
   // Initialize buffers for logging
-  for (size_t i = 0; i < num_buffers_; i++) {
-    buffers_.emplace_back(log_file_path_.c_str());
-  }
-  for (size_t i = 0; i < num_buffers_; i++) {
-    empty_buffer_queue_->Enqueue(&buffers_[i]);
+  const auto ring_paths = ring_path_.empty() ? std::vector<std::string>() : LogFilePaths(ring_path_, GetNumStreams());
+  for (uint32_t i = 0; i < GetNumStreams(); i++) {
+    auto &stream = streams_[i];
+    if (!ring_paths.empty()) {
+      // Recover the commits that were only acknowledged from the ring before the log file is opened
+      if (stream->ring_ == nullptr) stream->ring_ = std::make_unique<PersistentLogRing>(ring_paths[i], ring_size_);
+      stream->ring_->Drain(stream->log_file_path_);
+    }
+    // Continue writing to the last segment written before
+    const auto segment = LogSegmentPaths(stream->log_file_path_).size() - 1;
+    const auto segment_path = LogSegmentPath(stream->log_file_path_, segment);
+    for (size_t i = 0; i < num_buffers_; i++) {
+      stream->buffers_.emplace_back(segment_path.c_str(), compression_enable_);
+    }
+    for (size_t i = 0; i < num_buffers_; i++) {
+      stream->empty_buffer_queue_->Enqueue(&stream->buffers_[i]);
+    }
   }
 
   run_log_manager_ = true;
 
-  // Register DiskLogConsumerTask
-  disk_log_writer_task_ = thread_registry_->RegisterDedicatedThread<DiskLogConsumerTask>(
-      this /* requester */, persist_interval_, persist_threshold_, &buffers_, empty_buffer_queue_.Get(),
-      &filled_buffer_queue_);
-
-  // Register LogSerializerTask
-  log_serializer_task_ = thread_registry_->RegisterDedicatedThread<LogSerializerTask>(
-      this /* requester */, serialization_interval_, buffer_pool_, empty_buffer_queue_, &filled_buffer_queue_,
-      &disk_log_writer_task_->disk_log_writer_thread_cv_, primary_replication_manager_);
+  for (auto &stream : streams_) {
+    // Register DiskLogConsumerTask
+    stream->disk_log_writer_task_ = thread_registry_->RegisterDedicatedThread<DiskLogConsumerTask>(
+        this /* requester */, persist_interval_, persist_threshold_, &stream->buffers_,
+        stream->empty_buffer_queue_.Get(), &stream->filled_buffer_queue_, preallocation_size_, stream->log_file_path_,
+        segment_size_, stream->ring_.get());
+
+    // Register LogSerializerTask
+    stream->log_serializer_task_ = thread_registry_->RegisterDedicatedThread<LogSerializerTask>(
+        this /* requester */, serialization_interval_, buffer_pool_, stream->empty_buffer_queue_,
+        &stream->filled_buffer_queue_, &stream->disk_log_writer_task_->disk_log_writer_thread_cv_,
+        primary_replication_manager_);
+  }
 }
 
 void LogManager::ForceFlush() {
-  // Force the serializer task to serialize buffers
-  log_serializer_task_->Process();
-  // Signal the disk log consumer task thread to persist the buffers to disk
-  std::unique_lock<std::mutex> lock(disk_log_writer_task_->persist_lock_);
-  disk_log_writer_task_->force_flush_ = true;
-  disk_log_writer_task_->disk_log_writer_thread_cv_.notify_one();
-
-  // Wait for the disk log consumer task thread to persist the logs
-  disk_log_writer_task_->persist_cv_.wait(lock, [&] { return !disk_log_writer_task_->force_flush_; });
+  // Force the serializer tasks to serialize buffers
+  for (auto &stream : streams_) stream->log_serializer_task_->Process();
+
+  // Signal the disk log consumer task threads to persist the buffers to disk. All streams are signaled before waiting,
+  // so that they persist concurrently.
+  for (auto &stream : streams_) {
+    std::unique_lock<std::mutex> lock(stream->disk_log_writer_task_->persist_lock_);
+    stream->disk_log_writer_task_->force_flush_ = true;
+    stream->disk_log_writer_task_->disk_log_writer_thread_cv_.notify_one();
+  }
+
+  // Wait for the disk log consumer task threads to persist the logs
+  for (auto &stream : streams_) {
+    auto *const task = stream->disk_log_writer_task_.Get();
+    std::unique_lock<std::mutex> lock(task->persist_lock_);
+    task->persist_cv_.wait(lock, [&] { return !task->force_flush_; });
+  }
 }
 
 void LogManager::PersistAndStop() {
   NOISEPAGE_ASSERT(run_log_manager_, "Can't call PersistAndStop on an un-started LogManager");
   run_log_manager_ = false;
 
-  // Signal all tasks to stop. The shutdown of the tasks will trigger any remaining logs to be serialized, writen to the
-  // log file, and persisted. The order in which we shut down the tasks is important, we must first serialize, then
-  // shutdown the disk consumer task (reverse order of Start())
-  auto result UNUSED_ATTRIBUTE =
-      thread_registry_->StopTask(this, log_serializer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
-  NOISEPAGE_ASSERT(result, "LogSerializerTask should have been stopped");
-
-  result = thread_registry_->StopTask(this, disk_log_writer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
-  NOISEPAGE_ASSERT(result, "DiskLogConsumerTask should have been stopped");
-  NOISEPAGE_ASSERT(filled_buffer_queue_.Empty(), "disk log consumer task should have processed all filled buffers\n");
-
-  // Close the buffers corresponding to the log file
-  for (auto &buf : buffers_) {
-    buf.Close();
+  for (auto &stream : streams_) {
+    // Signal all tasks to stop. The shutdown of the tasks will trigger any remaining logs to be serialized, writen to
+    // the log file, and persisted. The order in which we shut down the tasks is important, we must first serialize,
+    // then shutdown the disk consumer task (reverse order of Start())
+    auto result UNUSED_ATTRIBUTE = thread_registry_->StopTask(
+        this, stream->log_serializer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
+    NOISEPAGE_ASSERT(result, "LogSerializerTask should have been stopped");
+
+    result = thread_registry_->StopTask(
+        this, stream->disk_log_writer_task_.CastManagedPointerTo<common::DedicatedThreadTask>());
+    NOISEPAGE_ASSERT(result, "DiskLogConsumerTask should have been stopped");
+    NOISEPAGE_ASSERT(stream->filled_buffer_queue_.Empty(),
+                     "disk log consumer task should have processed all filled buffers\n");
+
+    // Close the buffers corresponding to the log file
+    for (auto &buf : stream->buffers_) {
+      buf.Close();
+    }
+    // Clear buffer queues
+    stream->empty_buffer_queue_->Clear();
+    stream->filled_buffer_queue_.Clear();
+    stream->buffers_.clear();
   }
-  // Clear buffer queues
-  empty_buffer_queue_->Clear();
-  filled_buffer_queue_.Clear();
-  buffers_.clear();
 }
 
 void LogManager::AddBufferToFlushQueue(RecordBufferSegment *const buffer_segment,
                                        const transaction::TransactionPolicy &policy) {
   NOISEPAGE_ASSERT(run_log_manager_, "Must call Start on log manager before handing it buffers");
-  log_serializer_task_->AddBufferToFlushQueue(buffer_segment, policy);
+  GetStream(buffer_segment)->log_serializer_task_->AddBufferToFlushQueue(buffer_segment, policy);
+}
+
+LogManager::LogStream *LogManager::GetStream(RecordBufferSegment *const buffer_segment) {
+  if (streams_.size() == 1) return streams_.front().get();
+  // Every buffer of a transaction starts with one of its records, so all of them end up in the same stream
+  IterableBufferSegment<LogRecord> records(buffer_segment);
+  if (records.begin() == records.end()) return streams_.front().get();
+  const auto txn_begin = (*records.begin()).TxnBegin();
+  return streams_[common::HashUtil::Hash(txn_begin.UnderlyingValue()) % streams_.size()].get();
 }
 
 void LogManager::SetSerializationInterval(int32_t interval) {
   NOISEPAGE_ASSERT(interval > 0, "Log serialization interval should be greater than 0");
   serialization_interval_ = std::chrono::microseconds(interval);
-  if (log_serializer_task_ != nullptr) log_serializer_task_->SetSerializationInterval(interval);
+  for (auto &stream : streams_) {
+    if (stream->log_serializer_task_ != nullptr) stream->log_serializer_task_->SetSerializationInterval(interval);
+  }
 }
 
-void LogManager::EndReplication() { log_serializer_task_->EndReplication(); }
+void LogManager::EndReplication() {
+  for (auto &stream : streams_) stream->log_serializer_task_->EndReplication();
+}
 
 }  // namespace noisepage::storage
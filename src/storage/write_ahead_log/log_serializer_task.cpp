@@ -7,6 +7,7 @@
 #include "common/thread_context.h"
 #include "metrics/metrics_store.h"
 #include "replication/primary_replication_manager.h"
+#include "storage/varlen_compression.h"
 #include "transaction/transaction_context.h"
 #include "transaction/transaction_manager.h"
 
@@ -242,75 +243,20 @@ std::tuple<uint64_t, uint64_t, uint64_t> LogSerializerTask::SerializeBuffer(
 }
 
 uint64_t LogSerializerTask::SerializeRecord(const noisepage::storage::LogRecord &record) {
+  // Redo records make up most of the log, and are copied as a whole instead of field by field
+  if (record.RecordType() == LogRecordType::REDO) return SerializeRedoRecord(record);
+
   uint64_t num_bytes = 0;
   // First, serialize out fields common across all LogRecordType's.
 
-  // Note: This is the in-memory size of the log record itself, i.e. inclusive of padding and not considering the size
-  // of any potential varlen entries. It is logically different from the size of the serialized record, which the log
-  // manager generates in this function. In particular, the later value is very likely to be strictly smaller when the
-  // LogRecordType is REDO. On recovery, the goal is to turn the serialized format back into an in-memory log record of
-  // this size.
+  // Note: This is the in-memory size of the log record itself, i.e. inclusive of padding. On recovery, the goal is to
+  // turn the serialized format back into an in-memory log record of this size.
   num_bytes += WriteValue(record.Size());
 
   num_bytes += WriteValue(record.RecordType());
   num_bytes += WriteValue(record.TxnBegin());
 
   switch (record.RecordType()) {
-    case LogRecordType::REDO: {
-      auto *record_body = record.GetUnderlyingRecordBodyAs<RedoRecord>();
-      num_bytes += WriteValue(record_body->GetDatabaseOid());
-      num_bytes += WriteValue(record_body->GetTableOid());
-      num_bytes += WriteValue(record_body->GetTupleSlot());
-
-      auto *delta = record_body->Delta();
-      // Write out which column ids this redo record is concerned with. On recovery, we can construct the appropriate
-      // ProjectedRowInitializer from these ids and their corresponding block layout.
-      num_bytes += WriteValue(delta->NumColumns());
-      num_bytes += WriteValue(delta->ColumnIds(), static_cast<uint32_t>(sizeof(col_id_t)) * delta->NumColumns());
-
-      // Write out the attr sizes boundaries, this way we can deserialize the records without the need of the block
-      // layout
-      const auto &block_layout = record_body->GetTupleSlot().GetBlock()->data_table_->GetBlockLayout();
-      uint16_t boundaries[NUM_ATTR_BOUNDARIES];
-      memset(boundaries, 0, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
-      StorageUtil::ComputeAttributeSizeBoundaries(block_layout, delta->ColumnIds(), delta->NumColumns(), boundaries);
-      WriteValue(boundaries, sizeof(uint16_t) * NUM_ATTR_BOUNDARIES);
-
-      // Write out the null bitmap.
-      num_bytes += WriteValue(&(delta->Bitmap()), common::RawBitmap::SizeInBytes(delta->NumColumns()));
-
-      // Write out attribute values
-      for (uint16_t i = 0; i < delta->NumColumns(); i++) {
-        const auto *column_value_address = delta->AccessWithNullCheck(i);
-        if (column_value_address == nullptr) {
-          // If the column in this REDO record is null, then there's nothing to serialize out. The bitmap contains all
-          // the relevant information.
-          continue;
-        }
-        // Get the column id of the current column in the ProjectedRow.
-        col_id_t col_id = delta->ColumnIds()[i];
-
-        if (block_layout.IsVarlen(col_id)) {
-          // Inline column value is a pointer to a VarlenEntry, so reinterpret as such.
-          const auto *varlen_entry = reinterpret_cast<const VarlenEntry *>(column_value_address);
-          // Serialize out length of the varlen entry.
-          num_bytes += WriteValue(varlen_entry->Size());
-          if (varlen_entry->IsInlined()) {
-            // Serialize out the prefix of the varlen entry.
-            num_bytes += WriteValue(varlen_entry->Prefix(), varlen_entry->Size());
-          } else {
-            // Serialize out the content field of the varlen entry.
-            num_bytes += WriteValue(varlen_entry->Content(), varlen_entry->Size());
-          }
-        } else {
-          // Inline column value is the actual data we want to serialize out.
-          // Note that by writing out AttrSize(col_id) bytes instead of just the difference between successive offsets
-          // of the delta record, we avoid serializing out any potential padding.
-          num_bytes += WriteValue(column_value_address, block_layout.AttrSize(col_id));
-        }
-      }
-      break;
-    }
     case LogRecordType::DELETE: {
       auto *record_body = record.GetUnderlyingRecordBodyAs<DeleteRecord>();
       num_bytes += WriteValue(record_body->GetDatabaseOid());
@@ -324,8 +270,9 @@ uint64_t LogSerializerTask::SerializeRecord(const noisepage::storage::LogRecord
       num_bytes += WriteValue(record_body->OldestActiveTxn());
       break;
     }
+    case LogRecordType::REDO:
     case LogRecordType::ABORT: {
-      // AbortRecord does not hold any additional metadata
+      // Redo records were serialized above, and AbortRecord does not hold any additional metadata
       break;
     }
   }
@@ -333,6 +280,49 @@ uint64_t LogSerializerTask::SerializeRecord(const noisepage::storage::LogRecord
   return num_bytes;
 }
 
+uint64_t LogSerializerTask::SerializeRedoRecord(const noisepage::storage::LogRecord &record) {
+  uint64_t num_bytes = 0;
+  // The delta only refers to its attributes by offsets from its own start, and the tuple slot is mapped to the
+  // recovered one the same way as in the field by field format, so the image of the record can be written as is
+  num_bytes += WriteValue(record.Size() | LogRecord::NATIVE_FORMAT_FLAG);
+  num_bytes += WriteValue(&record, record.Size());
+
+  // Then write out the contents of the varlen entries that are not inlined, which recovery points the entries at
+  auto *record_body = record.GetUnderlyingRecordBodyAs<RedoRecord>();
+  const auto *delta = record_body->Delta();
+  const auto &block_layout = record_body->GetTupleSlot().GetBlock()->data_table_->GetBlockLayout();
+  const bool has_varlens = !block_layout.Varlens().empty();
+  auto out_of_line_varlen = [&](const uint16_t i) -> const VarlenEntry * {
+    if (!block_layout.IsVarlen(delta->ColumnIds()[i])) return nullptr;
+    const auto *varlen_entry = reinterpret_cast<const VarlenEntry *>(delta->AccessWithNullCheck(i));
+    return varlen_entry != nullptr && !varlen_entry->IsInlined() ? varlen_entry : nullptr;
+  };
+  uint16_t num_out_of_line = 0;
+  for (uint16_t i = 0; has_varlens && i < delta->NumColumns(); i++) {
+    if (out_of_line_varlen(i) != nullptr) num_out_of_line++;
+  }
+  num_bytes += WriteValue(num_out_of_line);
+  for (uint16_t i = 0; num_out_of_line > 0 && i < delta->NumColumns(); i++) {
+    const VarlenEntry *varlen_entry = out_of_line_varlen(i);
+    if (varlen_entry == nullptr) continue;
+    num_bytes += WriteValue(i);
+    // Large contents are compressed if that makes them smaller, which the flag on their length tells recovery.
+    const uint32_t compressed_size =
+        VarlenCompression::ShouldCompress(varlen_entry->Size())
+            ? VarlenCompression::Compress(varlen_entry->Content(), varlen_entry->Size(), &compression_buffer_)
+            : 0;
+    if (compressed_size != 0) {
+      num_bytes += WriteValue(varlen_entry->Size() | VarlenCompression::COMPRESSED_FLAG);
+      num_bytes += WriteValue(compressed_size);
+      num_bytes += WriteValue(compression_buffer_.data(), compressed_size);
+    } else {
+      num_bytes += WriteValue(varlen_entry->Size());
+      num_bytes += WriteValue(varlen_entry->Content(), varlen_entry->Size());
+    }
+  }
+  return num_bytes;
+}
+
 uint32_t LogSerializerTask::WriteValue(const void *val, const uint32_t size) {
   // Serialize the value and copy it to the buffer
   BufferedLogWriter *out = GetCurrentWriteBuffer();
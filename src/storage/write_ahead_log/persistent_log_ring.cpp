@@ -0,0 +1,146 @@
+#include "storage/write_ahead_log/persistent_log_ring.h"
+
+#include <fcntl.h>
+#include <immintrin.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#include "common/hash_util.h"
+#include "common/posix_io_wrappers.h"
+#include "loggers/storage_logger.h"
+#include "storage/write_ahead_log/log_manager.h"
+
+namespace noisepage::storage {
+
+PersistentLogRing::PersistentLogRing(const std::string &path, const uint64_t capacity)
+    : fd_(PosixIoWrappers::Open(path.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR)) {
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) == -1) throw std::runtime_error("fstat failed with errno " + std::to_string(errno));
+  // An existing ring that is larger than requested keeps its size, so that none of its entries are lost
+  const auto file_size = static_cast<uint64_t>(file_stat.st_size);
+  capacity_ = (capacity + ENTRIES_OFFSET - 1) / ENTRIES_OFFSET * ENTRIES_OFFSET;
+  if (file_size > ENTRIES_OFFSET) capacity_ = std::max(capacity_, file_size - ENTRIES_OFFSET);
+  mapping_size_ = ENTRIES_OFFSET + capacity_;
+  // Allocate the whole file up front, a store to a hole that cannot be allocated would raise SIGBUS
+  const int result = posix_fallocate(fd_, 0, static_cast<off_t>(mapping_size_));
+  if (result != 0) throw std::runtime_error("posix_fallocate failed with errno " + std::to_string(result));
+
+  void *mapping = MAP_FAILED;
+#ifdef MAP_SYNC
+  // Only succeeds on a DAX file system, where stores go to the persistent memory without the page cache
+  mapping = mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED_VALIDATE | MAP_SYNC, fd_, 0);
+#endif
+  direct_access_ = mapping != MAP_FAILED;
+  if (!direct_access_) mapping = mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+  if (mapping == MAP_FAILED) throw std::runtime_error("mmap failed with errno " + std::to_string(errno));
+  mapping_ = reinterpret_cast<char *>(mapping);
+  if (!direct_access_) STORAGE_LOG_WARN("{} is not on persistent memory, appends to the log ring use msync", path);
+
+  Header *const header = GetHeader();
+  if (header->magic_ != MAGIC) {
+    *header = Header{MAGIC, 0, 0, 0, 0};
+    Persist(mapping_, sizeof(Header));
+  }
+  // Nothing can be appended before the first reset, which must follow draining the entries left by the last run
+  tail_ = capacity_;
+}
+
+PersistentLogRing::~PersistentLogRing() {
+  munmap(mapping_, mapping_size_);
+  PosixIoWrappers::Close(fd_);
+}
+
+bool PersistentLogRing::Append(const char *const data, const uint32_t size) {
+  const uint64_t entry_size = EntrySize(size);
+  if (tail_ + entry_size > capacity_) return false;
+  char *const entry = Entries() + tail_;
+  auto *const entry_header = reinterpret_cast<EntryHeader *>(entry);
+  entry_header->epoch_ = GetHeader()->epoch_;
+  entry_header->size_ = size;
+  entry_header->checksum_ = Checksum(entry_header->epoch_, data, size);
+  std::memcpy(entry + sizeof(EntryHeader), data, size);
+  // The entry is persisted as a whole, a crash that tears it leaves it with a wrong checksum
+  Persist(entry, sizeof(EntryHeader) + size);
+  tail_ += entry_size;
+  return true;
+}
+
+void PersistentLogRing::Reset(const uint64_t segment, const uint64_t file_offset) {
+  Header *const header = GetHeader();
+  // Invalidate the entries of the old epoch before moving the location they are drained to
+  header->epoch_++;
+  Persist(mapping_, sizeof(Header));
+  header->segment_ = segment;
+  header->file_offset_ = file_offset;
+  Persist(mapping_, sizeof(Header));
+  header->committed_epoch_ = header->epoch_;
+  Persist(mapping_, sizeof(Header));
+  tail_ = 0;
+}
+
+uint64_t PersistentLogRing::Drain(const std::string &stream_log_file_path) {
+  const Header *const header = GetHeader();
+  // Either the ring was never reset, or a reset was interrupted, which only happens once the log file is persisted
+  if (header->epoch_ == 0 || header->committed_epoch_ != header->epoch_) return 0;
+
+  const auto segment_path = LogManager::LogSegmentPath(stream_log_file_path, header->segment_);
+  const int log_fd = PosixIoWrappers::Open(segment_path.c_str(), O_WRONLY | O_CREAT, S_IRUSR | S_IWUSR);
+  struct stat file_stat;
+  if (fstat(log_fd, &file_stat) == -1) throw std::runtime_error("fstat failed with errno " + std::to_string(errno));
+  if (static_cast<uint64_t>(file_stat.st_size) < header->file_offset_) {
+    // The log file lost data that was persisted before the ring was reset, so it is not the log the ring belongs to
+    STORAGE_LOG_WARN("{} is shorter than the log ring expects, the ring is not drained into it", segment_path);
+    PosixIoWrappers::Close(log_fd);
+    return 0;
+  }
+
+  uint64_t offset = header->file_offset_;
+  for (uint64_t pos = 0; pos + sizeof(EntryHeader) <= capacity_;) {
+    const auto *const entry_header = reinterpret_cast<const EntryHeader *>(Entries() + pos);
+    if (entry_header->epoch_ != header->epoch_ || pos + EntrySize(entry_header->size_) > capacity_) break;
+    const char *const data = Entries() + pos + sizeof(EntryHeader);
+    if (entry_header->checksum_ != Checksum(entry_header->epoch_, data, entry_header->size_)) break;
+    PosixIoWrappers::PwriteFully(log_fd, data, entry_header->size_, static_cast<off_t>(offset));
+    offset += entry_header->size_;
+    pos += EntrySize(entry_header->size_);
+  }
+  if (ftruncate(log_fd, static_cast<off_t>(offset)) == -1) {
+    throw std::runtime_error("ftruncate failed with errno " + std::to_string(errno));
+  }
+  if (fsync(log_fd) == -1) throw std::runtime_error("fsync failed with errno " + std::to_string(errno));
+  PosixIoWrappers::Close(log_fd);
+
+  const uint64_t drained = offset - header->file_offset_;
+  if (drained > 0) STORAGE_LOG_INFO("Recovered {} bytes of {} from the log ring", drained, segment_path);
+  return drained;
+}
+
+uint32_t PersistentLogRing::Checksum(const uint64_t epoch, const char *const data, const uint32_t size) {
+  return static_cast<uint32_t>(common::HashUtil::Hash(reinterpret_cast<const uint8_t *>(data), size, epoch));
+}
+
+void PersistentLogRing::Persist(const char *const start, const uint64_t size) {
+  const auto end = reinterpret_cast<uintptr_t>(start) + size;
+  if (direct_access_) {
+    const uint64_t cacheline = common::Constants::CACHELINE_SIZE;
+    for (auto line = reinterpret_cast<uintptr_t>(start) / cacheline * cacheline; line < end; line += cacheline) {
+      _mm_clflush(reinterpret_cast<const void *>(line));
+    }
+    _mm_sfence();
+    return;
+  }
+  // The mapping starts at a page, and ENTRIES_OFFSET is a page
+  const auto first_page = reinterpret_cast<uintptr_t>(start) / ENTRIES_OFFSET * ENTRIES_OFFSET;
+  if (msync(reinterpret_cast<void *>(first_page), end - first_page, MS_SYNC) == -1) {
+    throw std::runtime_error("msync failed with errno " + std::to_string(errno));
+  }
+}
+
+}  // namespace noisepage::storage
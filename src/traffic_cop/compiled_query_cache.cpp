@@ -0,0 +1,166 @@
+#include "traffic_cop/compiled_query_cache.h"
+
+#include <cctype>
+#include <utility>
+
+#include "common/hash_util.h"
+#include "execution/compiler/executable_query.h"
+#include "optimizer/optimize_result.h"
+#include "planner/plannodes/abstract_plan_node.h"
+
+namespace noisepage::trafficcop {
+
+CompiledQueryCache::Key::Key(const catalog::db_oid_t db_oid, const planner::AbstractPlanNode *plan,
+                             std::vector<type::TypeId> param_types)
+    : db_oid_(db_oid), plan_(plan), param_types_(std::move(param_types)) {
+  hash_ = common::HashUtil::CombineHashes(common::HashUtil::Hash(db_oid_.UnderlyingValue()), plan_->Hash());
+  for (const auto type : param_types_) {
+    hash_ = common::HashUtil::CombineHashes(hash_, common::HashUtil::Hash(type));
+  }
+}
+
+bool CompiledQueryCache::Key::operator==(const Key &other) const {
+  return hash_ == other.hash_ && db_oid_ == other.db_oid_ && param_types_ == other.param_types_ &&
+         *plan_ == *other.plan_;
+}
+
+CompiledQueryCache::StatementKey::StatementKey(const catalog::db_oid_t db_oid, std::string query_text,
+                                               std::vector<type::TypeId> param_types)
+    : db_oid_(db_oid), query_text_(std::move(query_text)), param_types_(std::move(param_types)) {
+  hash_ = common::HashUtil::CombineHashes(common::HashUtil::Hash(db_oid_.UnderlyingValue()),
+                                          common::HashUtil::Hash(query_text_));
+  for (const auto type : param_types_) {
+    hash_ = common::HashUtil::CombineHashes(hash_, common::HashUtil::Hash(type));
+  }
+}
+
+std::string CompiledQueryCache::NormalizeQueryText(const std::string &query_text) {
+  std::string normalized;
+  normalized.reserve(query_text.size());
+  char quote = '\0';
+  bool pending_space = false;
+  for (const char c : query_text) {
+    if (quote == '\0' && std::isspace(static_cast<unsigned char>(c))) {
+      pending_space = !normalized.empty();
+      continue;
+    }
+    if (pending_space) {
+      normalized.push_back(' ');
+      pending_space = false;
+    }
+    normalized.push_back(c);
+    // Doubled quotes inside a quoted string close and reopen it, which leaves the state as it was.
+    if (quote == '\0' && (c == '\'' || c == '"')) {
+      quote = c;
+    } else if (c == quote) {
+      quote = '\0';
+    }
+  }
+  while (!normalized.empty() && (normalized.back() == ';' || normalized.back() == ' ')) {
+    normalized.pop_back();
+  }
+  return normalized;
+}
+
+std::shared_ptr<execution::compiler::ExecutableQuery> CompiledQueryCache::Lookup(
+    const catalog::db_oid_t db_oid, const planner::AbstractPlanNode &plan,
+    const std::vector<type::TypeId> &param_types) {
+  const Key key(db_oid, &plan, param_types);
+
+  std::lock_guard guard(mutex_);
+  const auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  // Move the entry to the front, it's the most recently used now.
+  entries_.splice(entries_.begin(), entries_, it->second);
+  const auto &cached = it->second->cached_;
+  return std::shared_ptr<execution::compiler::ExecutableQuery>(cached, cached->query_.get());
+}
+
+std::shared_ptr<execution::compiler::ExecutableQuery> CompiledQueryCache::Insert(
+    const catalog::db_oid_t db_oid, std::shared_ptr<optimizer::OptimizeResult> optimize_result,
+    const std::vector<type::TypeId> &param_types, const std::string &query_text,
+    std::unique_ptr<execution::compiler::ExecutableQuery> query, const uint64_t catalog_version) {
+  Key key(db_oid, optimize_result->GetPlanNode().Get(), param_types);
+
+  std::lock_guard guard(mutex_);
+  // Compiled against a catalog that has changed since. The caller's statement
+  // owns the plan, so the query can run without the cache's help.
+  if (catalog_version != catalog_version_) {
+    return std::shared_ptr<execution::compiler::ExecutableQuery>(std::move(query));
+  }
+
+  // Another connection cached an equal query at the same time.
+  if (const auto it = index_.find(key); it != index_.end()) {
+    const auto &cached = it->second->cached_;
+    return std::shared_ptr<execution::compiler::ExecutableQuery>(cached, cached->query_.get());
+  }
+
+  if (entries_.size() == capacity_) {
+    EvictEntry();
+  }
+
+  // The statement the query was compiled for may go away before the query
+  // does, so the query refers to its own copy of the text.
+  auto cached = std::make_shared<CachedQuery>(CachedQuery{std::move(optimize_result), query_text, std::move(query)});
+  cached->query_->SetQueryText(common::ManagedPointer<const std::string>(&cached->query_text_));
+
+  entries_.push_front(Entry{std::move(key), cached, {}});
+  index_.emplace(entries_.front().key_, entries_.begin());
+  return std::shared_ptr<execution::compiler::ExecutableQuery>(cached, cached->query_.get());
+}
+
+bool CompiledQueryCache::LookupStatement(const catalog::db_oid_t db_oid, const std::string &query_text,
+                                         const std::vector<type::TypeId> &param_types,
+                                         const uint64_t catalog_version, CachedStatement *statement) {
+  const StatementKey key(db_oid, NormalizeQueryText(query_text), param_types);
+
+  std::lock_guard guard(mutex_);
+  const auto it = statement_index_.find(key);
+  if (catalog_version != catalog_version_ || it == statement_index_.end()) {
+    return false;
+  }
+  const auto entry = it->second.entry_;
+  entries_.splice(entries_.begin(), entries_, entry);
+  const auto &cached = entry->cached_;
+  statement->optimize_result_ = cached->optimize_result_;
+  statement->desired_param_types_ = it->second.desired_param_types_;
+  statement->query_ = std::shared_ptr<execution::compiler::ExecutableQuery>(cached, cached->query_.get());
+  return true;
+}
+
+void CompiledQueryCache::InsertStatement(const catalog::db_oid_t db_oid, const std::string &query_text,
+                                         const std::vector<type::TypeId> &param_types,
+                                         std::vector<type::TypeId> desired_param_types,
+                                         const planner::AbstractPlanNode &plan) {
+  const Key key(db_oid, &plan, param_types);
+  StatementKey statement_key(db_oid, NormalizeQueryText(query_text), param_types);
+
+  std::lock_guard guard(mutex_);
+  const auto it = index_.find(key);
+  if (it == index_.end() || statement_index_.find(statement_key) != statement_index_.end()) {
+    return;
+  }
+  it->second->statement_keys_.push_back(statement_key);
+  statement_index_.emplace(std::move(statement_key), StatementEntry{it->second, std::move(desired_param_types)});
+}
+
+void CompiledQueryCache::EvictEntry() {
+  auto &entry = entries_.back();
+  for (const auto &statement_key : entry.statement_keys_) {
+    statement_index_.erase(statement_key);
+  }
+  index_.erase(entry.key_);
+  entries_.pop_back();
+}
+
+void CompiledQueryCache::BumpCatalogVersion() {
+  std::lock_guard guard(mutex_);
+  catalog_version_++;
+  statement_index_.clear();
+  index_.clear();
+  entries_.clear();
+}
+
+}  // namespace noisepage::trafficcop
@@ -0,0 +1,184 @@
+#include "traffic_cop/result_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+#include "common/hash_util.h"
+#include "execution/sql/value.h"
+#include "network/postgres/postgres_packet_writer.h"
+#include "optimizer/optimize_result.h"
+#include "planner/plannodes/abstract_plan_node.h"
+#include "planner/plannodes/index_join_plan_node.h"
+#include "planner/plannodes/index_scan_plan_node.h"
+#include "planner/plannodes/seq_scan_plan_node.h"
+#include "storage/sql_table.h"
+
+namespace noisepage::trafficcop {
+
+ResultCache::Result::Result(const std::vector<planner::OutputSchema::Column> &columns, const std::size_t max_size)
+    : max_size_(max_size) {
+  // The format only decides how an attribute is written, not where it is
+  const std::vector<network::FieldFormat> formats(columns.size(), network::FieldFormat::text);
+  for (const auto &attribute : network::PostgresPacketWriter::MakeDataRowLayout(columns, formats)) {
+    if (attribute.type_ == type::TypeId::VARCHAR || attribute.type_ == type::TypeId::VARBINARY) {
+      varlen_offsets_.emplace_back(attribute.offset_);
+    }
+  }
+}
+
+void ResultCache::Result::Append(const byte *const tuples, const uint32_t num_tuples, const uint32_t tuple_size) {
+  std::lock_guard guard(latch_);
+  if (too_large_) return;
+  tuple_size_ = tuple_size;
+
+  const std::size_t batch_size = static_cast<std::size_t>(num_tuples) * tuple_size;
+  if (size_ + batch_size > max_size_) {
+    too_large_ = true;
+    return;
+  }
+  const std::size_t batch_start = tuples_.size();
+  tuples_.insert(tuples_.end(), tuples, tuples + batch_size);
+  size_ += batch_size;
+  num_tuples_ += num_tuples;
+
+  // The strings that are not inlined live in the execution's memory, which goes away with it
+  for (uint32_t row = 0; row < num_tuples; row++) {
+    byte *const tuple = tuples_.data() + batch_start + static_cast<std::size_t>(row) * tuple_size;
+    for (const auto offset : varlen_offsets_) {
+      auto *const val = reinterpret_cast<execution::sql::StringVal *>(tuple + offset);
+      if (val->is_null_ || val->val_.IsInlined()) continue;
+      const uint32_t varlen_size = val->val_.Size();
+      if (size_ + varlen_size > max_size_) {
+        too_large_ = true;
+        return;
+      }
+      auto &content = varlens_.emplace_back(new byte[varlen_size]);
+      std::memcpy(content.get(), val->val_.Content(), varlen_size);
+      val->val_ = storage::VarlenEntry::Create(content.get(), varlen_size, false);
+      size_ += varlen_size;
+    }
+  }
+}
+
+ResultCache::Key::Key(const catalog::db_oid_t db_oid, const planner::AbstractPlanNode *plan,
+                      std::vector<parser::ConstantValueExpression> params)
+    : db_oid_(db_oid), plan_(plan), params_(std::move(params)) {
+  hash_ = common::HashUtil::CombineHashes(common::HashUtil::Hash(db_oid_.UnderlyingValue()), plan_->Hash());
+  for (const auto &param : params_) {
+    hash_ = common::HashUtil::CombineHashes(hash_, param.Hash());
+  }
+}
+
+bool ResultCache::Key::operator==(const Key &other) const {
+  return hash_ == other.hash_ && db_oid_ == other.db_oid_ && params_ == other.params_ && *plan_ == *other.plan_;
+}
+
+bool ResultCache::IsCacheable(const planner::AbstractPlanNode &plan, std::vector<catalog::table_oid_t> *table_oids) {
+  switch (plan.GetPlanNodeType()) {
+    case planner::PlanNodeType::SEQSCAN:
+      table_oids->emplace_back(static_cast<const planner::SeqScanPlanNode &>(plan).GetTableOid());
+      break;
+    case planner::PlanNodeType::INDEXSCAN:
+      table_oids->emplace_back(static_cast<const planner::IndexScanPlanNode &>(plan).GetTableOid());
+      break;
+    case planner::PlanNodeType::INDEXNLJOIN:
+      table_oids->emplace_back(static_cast<const planner::IndexJoinPlanNode &>(plan).GetTableOid());
+      break;
+    case planner::PlanNodeType::NESTLOOP:
+    case planner::PlanNodeType::HASHJOIN:
+    case planner::PlanNodeType::MERGEJOIN:
+    case planner::PlanNodeType::AGGREGATE:
+    case planner::PlanNodeType::ORDERBY:
+    case planner::PlanNodeType::PROJECTION:
+    case planner::PlanNodeType::LIMIT:
+    case planner::PlanNodeType::DISTINCT:
+    case planner::PlanNodeType::HASH:
+    case planner::PlanNodeType::SETOP:
+    case planner::PlanNodeType::WINDOW:
+    case planner::PlanNodeType::RESULT:
+      break;
+    default:
+      // Files and everything that changes something, whose results aren't a function of the tables
+      return false;
+  }
+  for (const auto child : plan.GetChildren()) {
+    if (!IsCacheable(*child, table_oids)) return false;
+  }
+  return true;
+}
+
+bool ResultCache::IsUnchangedSince(const std::vector<common::ManagedPointer<storage::SqlTable>> &tables,
+                                   const transaction::timestamp_t time) {
+  for (const auto table : tables) {
+    if (table->GetLastCommitTime() >= time) return false;
+  }
+  return true;
+}
+
+std::shared_ptr<const ResultCache::Result> ResultCache::Lookup(
+    const catalog::db_oid_t db_oid, const planner::AbstractPlanNode &plan,
+    const std::vector<parser::ConstantValueExpression> &params, const transaction::timestamp_t start_time) {
+  const Key key(db_oid, &plan, params);
+
+  std::lock_guard guard(mutex_);
+  const auto it = index_.find(key);
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  const auto entry = it->second;
+  // The txn sees the same versions of the tables as the txn that computed the result if nothing changed them after
+  // the earlier of the two began.
+  if (!IsUnchangedSince(entry->tables_, std::min(entry->start_time_, start_time))) {
+    // A txn that began before the result was computed may still see it, unless the tables changed before that.
+    if (!IsUnchangedSince(entry->tables_, entry->start_time_)) EraseEntry(entry);
+    return nullptr;
+  }
+  entries_.splice(entries_.begin(), entries_, entry);
+  num_hits_++;
+  return entry->result_;
+}
+
+void ResultCache::Insert(const catalog::db_oid_t db_oid, std::shared_ptr<optimizer::OptimizeResult> optimize_result,
+                         const std::vector<parser::ConstantValueExpression> &params,
+                         std::vector<common::ManagedPointer<storage::SqlTable>> tables,
+                         const transaction::timestamp_t start_time, std::shared_ptr<const Result> result,
+                         const uint64_t catalog_version) {
+  if (result->IsTooLarge() || result->GetSize() > capacity_ || !IsUnchangedSince(tables, start_time)) return;
+  Key key(db_oid, optimize_result->GetPlanNode().Get(), params);
+
+  std::lock_guard guard(mutex_);
+  // The tables may have been dropped since, and are only safe to look at until the next time the cache is cleared
+  if (catalog_version != catalog_version_) return;
+
+  // Keep the result of the later txn, which more txns to come can see
+  if (const auto it = index_.find(key); it != index_.end()) {
+    if (it->second->start_time_ >= start_time) return;
+    EraseEntry(it->second);
+  }
+  while (size_ + result->GetSize() > capacity_) {
+    EraseEntry(std::prev(entries_.end()));
+  }
+
+  size_ += result->GetSize();
+  entries_.push_front(
+      Entry{std::move(key), std::move(optimize_result), std::move(tables), start_time, std::move(result)});
+  index_.emplace(entries_.front().key_, entries_.begin());
+}
+
+void ResultCache::EraseEntry(const EntryList::iterator entry) {
+  size_ -= entry->result_->GetSize();
+  index_.erase(entry->key_);
+  entries_.erase(entry);
+}
+
+void ResultCache::BumpCatalogVersion() {
+  std::lock_guard guard(mutex_);
+  catalog_version_++;
+  index_.clear();
+  entries_.clear();
+  size_ = 0;
+}
+
+}  // namespace noisepage::trafficcop
@@ -1,8 +1,13 @@
 #include "traffic_cop/traffic_cop.h"
 
+#include <chrono>  // NOLINT
 #include <future>  // NOLINT
+#include <limits>
 #include <memory>
+#include <mutex>  // NOLINT
 #include <string>
+#include <string_view>
+#include <thread>  // NOLINT
 #include <utility>
 #include <vector>
 
@@ -10,54 +15,128 @@
 #include "binder/binder_util.h"
 #include "catalog/catalog.h"
 #include "catalog/catalog_accessor.h"
+#include "catalog/database_catalog.h"
 #include "common/error/error_data.h"
 #include "common/error/exception.h"
+#include "common/memory_accountant.h"
 #include "common/thread_context.h"
 #include "execution/compiler/compilation_context.h"
 #include "execution/exec/execution_context.h"
 #include "execution/exec/execution_settings.h"
 #include "execution/exec/output.h"
+#include "execution/exec/query_profile.h"
+#include "execution/exec/sampling_profiler.h"
 #include "execution/sql/ddl_executors.h"
 #include "execution/vm/module.h"
+#include "metrics/metrics_manager.h"
+#include "metrics/metrics_sink.h"
 #include "metrics/metrics_store.h"
 #include "network/connection_context.h"
+#include "network/network_util.h"
+#include "network/postgres/copy_in_reader.h"
 #include "network/postgres/portal.h"
 #include "network/postgres/postgres_packet_writer.h"
 #include "network/postgres/statement.h"
+#include "optimizer/cost_model/cardinality_cost_model.h"
+#include "optimizer/cost_model/learned_cost_model.h"
 #include "optimizer/cost_model/trivial_cost_model.h"
+#include "optimizer/statistics/cardinality_feedback.h"
 #include "optimizer/statistics/stats_storage.h"
+#include "parser/copy_statement.h"
+#include "parser/create_statement.h"
 #include "parser/drop_statement.h"
+#include "parser/explain_statement.h"
+#include "parser/expression/function_expression.h"
 #include "parser/postgresparser.h"
+#include "parser/refresh_statement.h"
 #include "parser/variable_set_statement.h"
 #include "parser/variable_show_statement.h"
 #include "planner/plannodes/abstract_plan_node.h"
 #include "planner/plannodes/analyze_plan_node.h"
+#include "replication/replication_manager.h"
+#include "self_driving/model_server/model_server_manager.h"
 #include "settings/settings_manager.h"
+#include "spdlog/fmt/fmt.h"
+#include "storage/bulk_loader.h"
+#include "storage/index/index.h"
+#include "storage/recovery/recovery_manager.h"
 #include "storage/recovery/replication_log_provider.h"
+#include "storage/sql_table.h"
 #include "traffic_cop/traffic_cop_defs.h"
 #include "traffic_cop/traffic_cop_util.h"
 #include "transaction/transaction_manager.h"
 
 namespace noisepage::trafficcop {
 
+namespace {
+
+/** Writes the rows of a metrics output to the client as DataRows, every field as text. */
+class DataRowMetricsWriter : public metrics::MetricsRowWriter {
+ public:
+  DataRowMetricsWriter(const common::ManagedPointer<network::PostgresPacketWriter> out,
+                       const std::vector<planner::OutputSchema::Column> &cols)
+      : out_(out), cols_(cols) {}
+
+  void EndRow() override {
+    // Every column is a VARCHAR, so the row the packet writer expects is an array of StringVals over the fields
+    std::vector<execution::sql::StringVal> vals;
+    vals.reserve(fields_.size());
+    for (const auto &field : fields_) vals.emplace_back(field.data(), static_cast<uint32_t>(field.size()));
+    out_->WriteDataRow(reinterpret_cast<const byte *>(vals.data()), cols_, {network::FieldFormat::text});
+    fields_.clear();
+  }
+
+ protected:
+  void WriteInt(const int64_t value) override { fields_.emplace_back(std::to_string(value)); }
+  void WriteUInt(const uint64_t value) override { fields_.emplace_back(std::to_string(value)); }
+  void WriteDouble(const double value) override { fields_.emplace_back(std::to_string(value)); }
+  void WriteString(const std::string_view value) override { fields_.emplace_back(value); }
+
+ private:
+  const common::ManagedPointer<network::PostgresPacketWriter> out_;
+  const std::vector<planner::OutputSchema::Column> &cols_;
+  std::vector<std::string> fields_;
+};
+
+/** @return VARCHAR output columns named after the columns of a metrics output, like "query_id, count" */
+std::vector<planner::OutputSchema::Column> MetricsOutputColumns(std::string_view column_names) {
+  std::vector<planner::OutputSchema::Column> cols;
+  while (!column_names.empty()) {
+    const auto separator = column_names.find(", ");
+    const std::string name(column_names.substr(0, separator));
+    column_names.remove_prefix(separator == std::string_view::npos ? column_names.size() : separator + 2);
+    auto expr = std::make_unique<parser::ConstantValueExpression>(type::TypeId::VARCHAR);
+    expr->SetAlias(name);
+    cols.emplace_back(name, type::TypeId::VARCHAR, std::move(expr));
+  }
+  return cols;
+}
+
+}  // namespace
+
 /** The commit callback argument. */
 struct CommitCallbackArg {
   std::atomic<uint8_t> persist_countdown_;  ///< A countdown latch for what else needs to persist.
   std::promise<bool> ready_to_commit_;      ///< Set this promise to true to wake up the thread for commit.
+  /** The connection that deferred the commit, which owns this argument; null if a thread waits for the commit. */
+  network::ConnectionContext *deferring_connection_;
 
-  explicit CommitCallbackArg(const transaction::TransactionPolicy &policy) {
+  explicit CommitCallbackArg(const transaction::TransactionPolicy &policy,
+                             network::ConnectionContext *const deferring_connection = nullptr)
+      : deferring_connection_(deferring_connection) {
     // The value for the persist_countdown_ field.
     // Note that the field will be decremented exactly once every time a commit callback is invoked.
     persist_countdown_ = 0;
 
     // Cases: Durability, Replication
-    // - ASYNC, SYNC => This is too weird. Not supporting this.
+    // - ASYNC, SYNC or QUORUM => This is too weird. Not supporting this.
     // - ASYNC, ASYNC => 1. The callback is invoked immediately in TransactionManager.
     // - SYNC, ASYNC => 2. The callback is invoked by DiskLogConsumerTask and PrimaryReplicationManager.
-    // - SYNC, SYNC => 2. The callback is invoked by DiskLogConsumerTask and PrimaryReplicationManager.
+    // - SYNC, SYNC or QUORUM => 2. The callback is invoked by DiskLogConsumerTask and PrimaryReplicationManager.
 
     NOISEPAGE_ASSERT(!(policy.durability_ == transaction::DurabilityPolicy::ASYNC &&
-                       policy.replication_ == transaction::ReplicationPolicy::SYNC),
+                       (policy.replication_ == transaction::ReplicationPolicy::SYNC ||
+                        policy.replication_ == transaction::ReplicationPolicy::QUORUM)),
                      "Haven't reasoned about this case.");
 
     const transaction::DurabilityPolicy &dur = policy.durability_;
@@ -86,34 +165,95 @@ static void CommitCallback(void *const callback_arg) {
       "Every component should have invoked the callback already. The policy may not have been correctly initialized?");
   const bool was_last_callback = count_before_sub == 1;
   if (was_last_callback) {
-    cb_arg->ready_to_commit_.set_value(true);
+    if (cb_arg->deferring_connection_ != nullptr) {
+      auto *const connection = cb_arg->deferring_connection_;
+      delete cb_arg;
+      connection->DeferredCommitDurable();
+    } else {
+      cb_arg->ready_to_commit_.set_value(true);
+    }
+  }
+}
+
+// The name of a table as SQL text, quoted so that it reads back the same
+static std::string QuoteTableName(const std::string &namespace_name, const std::string &table_name) {
+  const auto quote = [](const std::string &identifier) {
+    std::string quoted = "\"";
+    for (const char c : identifier) quoted += c == '"' ? std::string("\"\"") : std::string(1, c);
+    return quoted + "\"";
+  };
+  return namespace_name.empty() ? quote(table_name) : quote(namespace_name) + "." + quote(table_name);
+}
+
+// Append a line for the plan node and, indented below it, lines for its children
+static void AppendExplainLines(const planner::AbstractPlanNode &plan, const uint32_t depth,
+                               const execution::exec::QueryProfile *const profile, std::vector<std::string> *lines) {
+  std::string line = depth == 0 ? "" : std::string(4 * depth - 4, ' ') + "->  ";
+  line += fmt::format("{}  (node={}", planner::PlanNodeTypeToString(plan.GetPlanNodeType()),
+                      plan.GetPlanNodeId().UnderlyingValue());
+  if (const auto *op = profile == nullptr ? nullptr : profile->GetOperatorProfile(plan.GetPlanNodeId())) {
+    line += fmt::format(", actual rows={}, pipelines=", op->rows_);
+    for (std::size_t i = 0; i < op->pipelines_.size(); i++) {
+      line += fmt::format("{}{}", i == 0 ? "" : ",", op->pipelines_[i].UnderlyingValue());
+    }
+  }
+  lines->emplace_back(line + ")");
+  for (const auto child : plan.GetChildren()) {
+    AppendExplainLines(*child, depth + 1, profile, lines);
   }
 }
 
-void TrafficCop::BeginTransaction(const common::ManagedPointer<network::ConnectionContext> connection_ctx) const {
+void TrafficCop::BeginTransaction(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                                  const bool read_only,
+                                  const std::optional<transaction::IsolationLevel> isolation_level) const {
   NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::IDLE,
                    "Invalid ConnectionContext state, already in a transaction.");
-  const auto txn = txn_manager_->BeginTransaction();
+  // Read before the txn begins, so a DDL change committing in between shows up as a newer version. The plans of a
+  // connection with a temporary namespace may refer to its temporary objects, so they aren't shared at all.
+  const bool has_temp_namespace = connection_ctx->GetTempNamespaceOid() != catalog::INVALID_NAMESPACE_OID;
+  connection_ctx->SetTransactionCatalogVersion(
+      has_temp_namespace ? std::nullopt : std::optional<uint64_t>(compiled_query_cache_->GetCatalogVersion()));
+  const auto level = isolation_level.value_or(default_isolation_level_);
+  transaction::TransactionContext *txn;
+  if (replication_manager_ != DISABLED && replication_manager_->IsReplica() && recovery_manager_ != DISABLED) {
+    // Replicas serve reads at the last transaction of the primary that they applied, and as fresh as the client asks
+    std::optional<std::chrono::milliseconds> max_staleness = std::nullopt;
+    const auto staleness_ms =
+        settings_manager_ != nullptr ? settings_manager_->GetInt(settings::Param::replica_max_staleness) : -1;
+    if (staleness_ms >= 0) max_staleness = std::chrono::milliseconds(staleness_ms);
+    txn = recovery_manager_->BeginReadTransaction(read_only, level, max_staleness);
+  } else {
+    txn = txn_manager_->BeginTransaction(read_only, level);
+  }
   connection_ctx->SetTransaction(common::ManagedPointer(txn));
   connection_ctx->SetAccessor(catalog_->GetAccessor(common::ManagedPointer(txn), connection_ctx->GetDatabaseOid(),
-                                                    connection_ctx->GetCatalogCache()));
+                                                    common::ManagedPointer(catalog_cache_)));
+  if (has_temp_namespace) connection_ctx->Accessor()->SetTempNamespace(connection_ctx->GetTempNamespaceOid());
 }
 
-void TrafficCop::EndTransaction(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+bool TrafficCop::EndTransaction(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
                                 const network::QueryType query_type) const {
   NOISEPAGE_ASSERT(query_type == network::QueryType::QUERY_COMMIT || query_type == network::QueryType::QUERY_ROLLBACK,
                    "EndTransaction called with invalid QueryType.");
   const auto txn = connection_ctx->Transaction();
+  bool committed = true;
   if (query_type == network::QueryType::QUERY_COMMIT) {
     NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
                      "Invalid ConnectionContext state, not in a transaction that can be committed.");
-    // Set up a blocking callback. Will be invoked when we can tell the client that commit is complete.
-    CommitCallbackArg cb_arg(txn->GetTransactionPolicy());
-    auto future = cb_arg.ready_to_commit_.get_future();
-    NOISEPAGE_ASSERT(future.valid(), "future must be valid for synchronization to work.");
-    txn_manager_->Commit(txn.Get(), CommitCallback, &cb_arg);
-    future.wait();
-    NOISEPAGE_ASSERT(future.get(), "Got past the wait() without the value being set to true. That's weird.");
+    if (connection_ctx->DeferCommit()) {
+      // The connection holds its responses back until the commit is durable, so that this thread, and every other
+      // connection of its handler, doesn't wait on the log flush.
+      auto *const cb_arg = new CommitCallbackArg(txn->GetTransactionPolicy(), connection_ctx.Get());
+      committed = txn_manager_->Commit(txn.Get(), CommitCallback, cb_arg) != transaction::INVALID_TXN_TIMESTAMP;
+    } else {
+      // Set up a blocking callback. Will be invoked when we can tell the client that commit is complete.
+      CommitCallbackArg cb_arg(txn->GetTransactionPolicy());
+      auto future = cb_arg.ready_to_commit_.get_future();
+      NOISEPAGE_ASSERT(future.valid(), "future must be valid for synchronization to work.");
+      committed = txn_manager_->Commit(txn.Get(), CommitCallback, &cb_arg) != transaction::INVALID_TXN_TIMESTAMP;
+      future.wait();
+      NOISEPAGE_ASSERT(future.get(), "Got past the wait() without the value being set to true. That's weird.");
+    }
   } else {
     NOISEPAGE_ASSERT(connection_ctx->TransactionState() != network::NetworkTransactionStateType::IDLE,
                      "Invalid ConnectionContext state, not in a transaction that can be aborted.");
@@ -121,6 +261,7 @@ void TrafficCop::EndTransaction(const common::ManagedPointer<network::Connection
   }
   connection_ctx->SetTransaction(nullptr);
   connection_ctx->SetAccessor(nullptr);
+  return committed;
 }
 
 void TrafficCop::ExecuteTransactionStatement(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
@@ -152,7 +293,10 @@ void TrafficCop::ExecuteTransactionStatement(const common::ManagedPointer<networ
         out->WriteCommandComplete(network::QueryType::QUERY_ROLLBACK, 0);
         return;
       }
-      EndTransaction(connection_ctx, network::QueryType::QUERY_COMMIT);
+      if (!EndTransaction(connection_ctx, network::QueryType::QUERY_COMMIT)) {
+        out->WriteError(SerializationFailure());
+        return;
+      }
       break;
     }
     case network::QueryType::QUERY_ROLLBACK: {
@@ -173,13 +317,54 @@ void TrafficCop::ExecuteTransactionStatement(const common::ManagedPointer<networ
 std::unique_ptr<optimizer::OptimizeResult> TrafficCop::OptimizeBoundQuery(
     const common::ManagedPointer<network::ConnectionContext> connection_ctx,
     const common::ManagedPointer<parser::ParseResult> query,
-    common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters) const {
+    common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters,
+    const common::ManagedPointer<const optimizer::CardinalityFeedback> cardinality_feedback) const {
   NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
                    "Not in a valid txn. This should have been caught before calling this function.");
 
+  std::unique_ptr<optimizer::AbstractCostModel> cost_model;
+  if (settings_manager_ != nullptr && settings_manager_->GetBool(settings::Param::cardinality_cost_model)) {
+    // Parallel plans are only cheaper if the execution engine runs them in parallel
+    const auto num_threads = settings_manager_->GetBool(settings::Param::parallel_execution)
+                                 ? settings_manager_->GetInt(settings::Param::num_parallel_execution_threads)
+                                 : 1;
+    cost_model =
+        std::make_unique<optimizer::CardinalityCostModel>(stats_storage_, static_cast<uint32_t>(num_threads));
+  } else {
+    cost_model = std::make_unique<optimizer::TrivialCostModel>();
+  }
+  if (settings_manager_ != nullptr && settings_manager_->GetBool(settings::Param::learned_cost_model) &&
+      model_server_manager_ != nullptr) {
+    std::shared_ptr<const selfdriving::OUModelMap> ou_models;
+    if (settings_manager_->GetBool(settings::Param::learned_cost_model_in_process)) {
+      ou_models = ou_model_loader_->Get(model_save_path_);
+    }
+    if (ou_models != nullptr || model_server_manager_->ModelServerStarted()) {
+      const std::chrono::milliseconds timeout{settings_manager_->GetInt(settings::Param::learned_cost_model_timeout)};
+      cost_model = std::make_unique<optimizer::LearnedCostModel>(
+          stats_storage_, connection_ctx->GetDatabaseOid(), model_server_manager_, model_save_path_, timeout,
+          std::move(ou_models), common::ManagedPointer(ou_prediction_cache_), static_cast<uint8_t>(execution_mode_),
+          std::move(cost_model));
+    }
+  }
+
+  const auto num_threads = settings_manager_ != nullptr
+                               ? static_cast<uint32_t>(settings_manager_->GetInt(settings::Param::optimizer_num_threads))
+                               : 1;
   return TrafficCopUtil::Optimize(connection_ctx->Transaction(), connection_ctx->Accessor(), query,
-                                  connection_ctx->GetDatabaseOid(), stats_storage_,
-                                  std::make_unique<optimizer::TrivialCostModel>(), optimizer_timeout_, parameters);
+                                  connection_ctx->GetDatabaseOid(), stats_storage_, std::move(cost_model),
+                                  optimizer_timeout_, parameters, num_threads, cardinality_feedback);
+}
+
+std::vector<uint8_t> TrafficCop::ParameterSelectivityBuckets(
+    const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+    const common::ManagedPointer<network::Statement> statement,
+    const common::ManagedPointer<const std::vector<parser::ConstantValueExpression>> parameters) const {
+  NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
+                   "Not in a valid txn. This should have been caught before calling this function.");
+  return TrafficCopUtil::ParameterSelectivityBuckets(connection_ctx->Accessor(), stats_storage_,
+                                                     connection_ctx->GetDatabaseOid(), statement->RootStatement(),
+                                                     parameters);
 }
 
 TrafficCopResult TrafficCop::ExecuteSetStatement(common::ManagedPointer<network::ConnectionContext> connection_ctx,
@@ -210,6 +395,51 @@ TrafficCopResult TrafficCop::ExecuteSetStatement(common::ManagedPointer<network:
   return {ResultType::COMPLETE, 0u};
 }
 
+std::variant<std::unique_ptr<network::CopyInReader>, common::ErrorData> TrafficCop::BeginCopyIn(
+    const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+    const common::ManagedPointer<parser::CopyStatement> copy_stmt) const {
+  NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
+                   "Not in a valid txn. This should have been caught before calling this function.");
+  const auto accessor = connection_ctx->Accessor();
+  const auto table_ref = copy_stmt->GetCopyTable();
+
+  catalog::table_oid_t table_oid = catalog::INVALID_TABLE_OID;
+  if (table_ref->GetNamespaceName().empty()) {
+    table_oid = accessor->GetTableOid(table_ref->GetTableName());
+  } else {
+    const auto ns_oid = accessor->GetNamespaceOid(table_ref->GetNamespaceName());
+    if (ns_oid != catalog::INVALID_NAMESPACE_OID) table_oid = accessor->GetTableOid(ns_oid, table_ref->GetTableName());
+  }
+  if (table_oid == catalog::INVALID_TABLE_OID) {
+    return common::ErrorData(common::ErrorSeverity::ERROR,
+                             fmt::format("relation \"{}\" does not exist", table_ref->GetTableName()),
+                             common::ErrorCode::ERRCODE_UNDEFINED_TABLE);
+  }
+
+  auto indexes = accessor->GetIndexes(table_oid);
+  for (const auto &index : indexes) {
+    if (!storage::BulkLoader::SupportsIndex(index.second)) {
+      return common::ErrorData(
+          common::ErrorSeverity::ERROR,
+          fmt::format("COPY into \"{}\" is not supported, it has a partial or expression index",
+                      table_ref->GetTableName()),
+          common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED);
+    }
+  }
+
+  const auto &schema = accessor->GetSchema(table_oid);
+  std::vector<network::CopyInReader::Column> columns;
+  columns.reserve(schema.GetColumns().size());
+  for (const auto &column : schema.GetColumns()) columns.push_back({column.Name(), column.Type(), column.Nullable()});
+
+  // The rows are inserted in the connection's txn, which keeps the table and its indexes alive until it ends
+  auto loader = std::make_unique<storage::BulkLoader>(connection_ctx->Transaction(), connection_ctx->GetDatabaseOid(),
+                                                      table_oid, accessor->GetTable(table_oid), schema, indexes);
+  return std::make_unique<network::CopyInReader>(table_ref->GetTableName(), std::move(loader), std::move(columns),
+                                                 copy_stmt->GetExternalFileFormat(), copy_stmt->GetDelimiter(),
+                                                 copy_stmt->GetQuoteChar(), copy_stmt->GetEscapeChar());
+}
+
 TrafficCopResult TrafficCop::ExecuteShowStatement(
     common::ManagedPointer<network::ConnectionContext> connection_ctx,
     common::ManagedPointer<network::Statement> statement,
@@ -219,8 +449,35 @@ TrafficCopResult TrafficCop::ExecuteShowStatement(
   NOISEPAGE_ASSERT(statement->GetQueryType() == network::QueryType::QUERY_SHOW,
                    "ExecuteSetStatement called with invalid QueryType.");
 
-  const auto &show_stmt UNUSED_ATTRIBUTE =
-      statement->RootStatement().CastManagedPointerTo<parser::VariableShowStatement>();
+  const auto &show_stmt = statement->RootStatement().CastManagedPointerTo<parser::VariableShowStatement>();
+
+  if (show_stmt->GetName() == "latency_histograms") {
+    const auto cols = MetricsOutputColumns(metrics::LatencyHistograms::COLUMNS);
+    out->WriteRowDescription(cols, {network::FieldFormat::text});
+
+    // The histograms live in the MetricsManager, which this thread only knows of if it collects metrics
+    if (common::thread_context.metrics_store_ != nullptr) {
+      DataRowMetricsWriter writer(out, cols);
+      common::thread_context.metrics_store_->MetricsManager()->GetLatencyHistograms().Write(&writer);
+    }
+    return {ResultType::COMPLETE, 0u};
+  }
+
+  if (show_stmt->GetName() == "memory_usage") {
+    const auto cols = MetricsOutputColumns(MEMORY_USAGE_COLUMNS);
+    out->WriteRowDescription(cols, {network::FieldFormat::text});
+    DataRowMetricsWriter writer(out, cols);
+    WriteMemoryUsage(&writer);
+    return {ResultType::COMPLETE, 0u};
+  }
+
+  if (show_stmt->GetName() == "pipeline_samples") {
+    const auto cols = MetricsOutputColumns(execution::exec::SamplingProfiler::COLUMNS);
+    out->WriteRowDescription(cols, {network::FieldFormat::text});
+    DataRowMetricsWriter writer(out, cols);
+    execution::exec::SamplingProfiler::Write(&writer);
+    return {ResultType::COMPLETE, 0u};
+  }
 
   NOISEPAGE_ASSERT(show_stmt->GetName() == "transaction_isolation", "Nothing else is supported right now.");
 
@@ -235,6 +492,83 @@ TrafficCopResult TrafficCop::ExecuteShowStatement(
   return {ResultType::COMPLETE, 0u};
 }
 
+void TrafficCop::InvalidateCompiledQueriesOnCommit(
+    const common::ManagedPointer<network::ConnectionContext> connection_ctx) const {
+  // Queries compiled before the change may have been planned against the old catalog, both for this txn and for
+  // everyone once it commits.
+  connection_ctx->SetTransactionCatalogVersion(std::nullopt);
+  connection_ctx->Transaction()->RegisterCommitAction(
+      [cache = common::ManagedPointer(compiled_query_cache_), result_cache = common::ManagedPointer(result_cache_)]() {
+        cache->BumpCatalogVersion();
+        // After the CompiledQueryCache, so that a txn with the new catalog version never sees the old one here
+        if (result_cache != nullptr) result_cache->BumpCatalogVersion();
+      });
+}
+
+bool TrafficCop::GetResultCacheTables(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                                      const common::ManagedPointer<network::Portal> portal,
+                                      std::vector<common::ManagedPointer<storage::SqlTable>> *const tables) const {
+  // A serializable txn has to track what it reads, and a txn that wrote something sees versions no one else does. The
+  // plans of a txn that changed the catalog may refer to tables no one else sees, see BeginTransaction().
+  const auto txn = connection_ctx->Transaction();
+  if (result_cache_ == nullptr || portal->GetStatement()->GetQueryType() != network::QueryType::QUERY_SELECT ||
+      txn->IsSerializable() || !txn->IsReadOnly() || !connection_ctx->TransactionCatalogVersion().has_value()) {
+    return false;
+  }
+  std::vector<catalog::table_oid_t> table_oids;
+  if (!ResultCache::IsCacheable(*portal->OptimizeResult()->GetPlanNode(), &table_oids)) return false;
+
+  // The result must only depend on the tables, which rules out UDFs and the functions that look at the system
+  const auto accessor = connection_ctx->Accessor();
+  auto exprs = portal->GetStatement()->ParseResult()->GetExpressions();
+  while (!exprs.empty()) {
+    const auto expr = exprs.back();
+    exprs.pop_back();
+    if (expr->GetExpressionType() == parser::ExpressionType::FUNCTION) {
+      const auto func_expr = expr.CastManagedPointerTo<parser::FunctionExpression>();
+      const auto &name = func_expr->GetFuncName();
+      if (!accessor->GetFunctionContext(func_expr->GetProcOid())->IsBuiltin() ||
+          name == "replication_get_last_txn_id" || name.rfind("nprunners", 0) == 0) {
+        return false;
+      }
+    }
+    for (const auto child : expr->GetChildren()) exprs.emplace_back(child);
+  }
+
+  for (const auto table_oid : table_oids) tables->emplace_back(accessor->GetTable(table_oid));
+  return true;
+}
+
+bool TrafficCop::SendCachedResult(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                                  const common::ManagedPointer<network::PostgresPacketWriter> out,
+                                  const common::ManagedPointer<network::Portal> portal,
+                                  TrafficCopResult *const result, const bool suspend) const {
+  NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
+                   "Not in a valid txn. This should have been caught before calling this function.");
+  std::vector<common::ManagedPointer<storage::SqlTable>> tables;
+  if (!GetResultCacheTables(connection_ctx, portal, &tables)) return false;
+
+  const auto physical_plan = portal->OptimizeResult()->GetPlanNode();
+  const auto cached = result_cache_->Lookup(connection_ctx->GetDatabaseOid(), *physical_plan, *portal->Parameters(),
+                                            connection_ctx->Transaction()->StartTime());
+  if (cached == nullptr) return false;
+
+  if (suspend) {
+    // The portal shares the cached tuples rather than copying them
+    *result = {ResultType::COMPLETE, cached->GetNumTuples()};
+    portal->Suspend(cached);
+    return true;
+  }
+
+  if (cached->GetNumTuples() > 0) {
+    out->WriteDataRows(cached->GetTuples(), cached->GetNumTuples(), cached->GetTupleSize(),
+                       network::PostgresPacketWriter::MakeDataRowLayout(
+                           physical_plan->GetOutputSchema()->GetColumns(), portal->ResultFormats()));
+  }
+  *result = {ResultType::COMPLETE, cached->GetNumTuples()};
+  return true;
+}
+
 TrafficCopResult TrafficCop::ExecuteCreateStatement(
     const common::ManagedPointer<network::ConnectionContext> connection_ctx,
     const common::ManagedPointer<planner::AbstractPlanNode> physical_plan,
@@ -246,6 +580,7 @@ TrafficCopResult TrafficCop::ExecuteCreateStatement(
           query_type == network::QueryType::QUERY_CREATE_INDEX || query_type == network::QueryType::QUERY_CREATE_DB ||
           query_type == network::QueryType::QUERY_CREATE_VIEW || query_type == network::QueryType::QUERY_CREATE_TRIGGER,
       "ExecuteCreateStatement called with invalid QueryType.");
+  InvalidateCompiledQueriesOnCommit(connection_ctx);
   switch (query_type) {
     case network::QueryType::QUERY_CREATE_TABLE: {
       if (execution::sql::DDLExecutors::CreateTableExecutor(
@@ -289,6 +624,133 @@ TrafficCopResult TrafficCop::ExecuteCreateStatement(
                                                common::ErrorCode::ERRCODE_DATA_EXCEPTION)};
 }
 
+TrafficCopResult TrafficCop::ExecuteCreateMaterializedViewStatement(
+    const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+    const common::ManagedPointer<network::PostgresPacketWriter> out,
+    const common::ManagedPointer<network::Portal> portal) const {
+  NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
+                   "Not in a valid txn. This should have been caught before calling this function.");
+  NOISEPAGE_ASSERT(portal->GetStatement()->GetQueryType() == network::QueryType::QUERY_CREATE_MATERIALIZED_VIEW,
+                   "ExecuteCreateMaterializedViewStatement called with invalid QueryType.");
+  InvalidateCompiledQueriesOnCommit(connection_ctx);
+
+  const auto create_stmt = portal->GetStatement()->RootStatement().CastManagedPointerTo<parser::CreateStatement>();
+  const auto view_query = TrafficCopUtil::MaterializedViewQueryText(portal->GetStatement()->GetQueryText());
+  const auto &output_columns = portal->OptimizeResult()->GetPlanNode()->GetOutputSchema()->GetColumns();
+  const auto &view_columns = create_stmt->GetViewColumns();
+  if (view_query.empty() || view_columns.size() > output_columns.size()) {
+    connection_ctx->Transaction()->SetMustAbort();
+    return {ResultType::ERROR,
+            common::ErrorData(common::ErrorSeverity::ERROR,
+                              view_query.empty() ? "failed to find the query of the materialized view"
+                                                 : "too many column names were specified",
+                              common::ErrorCode::ERRCODE_SYNTAX_ERROR)};
+  }
+
+  // The columns of the view are the columns of the output of its query, renamed by the column list if there is one
+  std::vector<catalog::Schema::Column> columns;
+  columns.reserve(output_columns.size());
+  for (std::size_t i = 0; i < output_columns.size(); i++) {
+    auto name = i < view_columns.size() ? view_columns[i] : output_columns[i].GetName();
+    if (name.empty()) name = fmt::format("column{}", i + 1);
+    const auto type = output_columns[i].GetType();
+    if (type == type::TypeId::VARCHAR || type == type::TypeId::VARBINARY) {
+      columns.emplace_back(std::move(name), type, -1, true, parser::ConstantValueExpression(type));
+    } else {
+      columns.emplace_back(std::move(name), type, true, parser::ConstantValueExpression(type));
+    }
+  }
+
+  const auto accessor = connection_ctx->Accessor();
+  const auto ns_oid = accessor->GetNamespaceOid(create_stmt->GetNamespaceName());
+  const auto table_oid = ns_oid == catalog::INVALID_NAMESPACE_OID
+                             ? catalog::INVALID_TABLE_OID
+                             : accessor->CreateTable(ns_oid, create_stmt->GetTableName(),
+                                                     catalog::Schema(std::move(columns)), view_query);
+  if (table_oid == catalog::INVALID_TABLE_OID) {
+    connection_ctx->Transaction()->SetMustAbort();
+    return {ResultType::ERROR, common::ErrorData(common::ErrorSeverity::ERROR, "failed to execute CREATE",
+                                                 common::ErrorCode::ERRCODE_DATA_EXCEPTION)};
+  }
+  auto *const table = new storage::SqlTable(accessor->GetBlockStore(), accessor->GetSchema(table_oid));
+  const bool set_table UNUSED_ATTRIBUTE = accessor->SetTablePointer(table_oid, table);
+  NOISEPAGE_ASSERT(set_table, "CreateTable succeeded, SetTablePointer must also succeed.");
+
+  if (!create_stmt->IsWithData()) return {ResultType::COMPLETE, 0u};
+  auto result = RunInternalQuery(
+      connection_ctx, out,
+      "INSERT INTO " + QuoteTableName(create_stmt->GetNamespaceName(), create_stmt->GetTableName()) + " " + view_query);
+  if (result.type_ != ResultType::COMPLETE) connection_ctx->Transaction()->SetMustAbort();
+  return result;
+}
+
+TrafficCopResult TrafficCop::ExecuteRefreshStatement(
+    const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+    const common::ManagedPointer<network::PostgresPacketWriter> out,
+    const common::ManagedPointer<network::Statement> statement) const {
+  NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
+                   "Not in a valid txn. This should have been caught before calling this function.");
+  NOISEPAGE_ASSERT(statement->GetQueryType() == network::QueryType::QUERY_REFRESH,
+                   "ExecuteRefreshStatement called with invalid QueryType.");
+  const auto accessor = connection_ctx->Accessor();
+  const auto refresh_stmt = statement->RootStatement().CastManagedPointerTo<parser::RefreshStatement>();
+  const auto view = refresh_stmt->GetView();
+
+  catalog::table_oid_t table_oid = catalog::INVALID_TABLE_OID;
+  if (view->GetNamespaceName().empty()) {
+    table_oid = accessor->GetTableOid(view->GetTableName());
+  } else {
+    const auto ns_oid = accessor->GetNamespaceOid(view->GetNamespaceName());
+    if (ns_oid != catalog::INVALID_NAMESPACE_OID) table_oid = accessor->GetTableOid(ns_oid, view->GetTableName());
+  }
+  if (table_oid == catalog::INVALID_TABLE_OID) {
+    return {ResultType::ERROR, common::ErrorData(common::ErrorSeverity::ERROR,
+                                                 fmt::format("relation \"{}\" does not exist", view->GetTableName()),
+                                                 common::ErrorCode::ERRCODE_UNDEFINED_TABLE)};
+  }
+  const auto view_query = accessor->GetViewDefinition(table_oid);
+  if (!view_query.has_value()) {
+    return {ResultType::ERROR,
+            common::ErrorData(common::ErrorSeverity::ERROR,
+                              fmt::format("\"{}\" is not a materialized view", view->GetTableName()),
+                              common::ErrorCode::ERRCODE_WRONG_OBJECT_TYPE)};
+  }
+
+  // The view is recomputed in full, in the same txn, so that other txns see either the old or the new contents
+  const auto view_name = QuoteTableName(view->GetNamespaceName(), view->GetTableName());
+  auto result = RunInternalQuery(connection_ctx, out, "DELETE FROM " + view_name);
+  if (result.type_ == ResultType::COMPLETE && refresh_stmt->IsWithData()) {
+    result = RunInternalQuery(connection_ctx, out, "INSERT INTO " + view_name + " " + *view_query);
+  }
+  if (result.type_ != ResultType::COMPLETE) return result;
+  return {ResultType::COMPLETE, 0u};
+}
+
+TrafficCopResult TrafficCop::RunInternalQuery(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                                              const common::ManagedPointer<network::PostgresPacketWriter> out,
+                                              std::string query) const {
+  auto parse_result = ParseQuery(query, connection_ctx);
+  if (std::holds_alternative<common::ErrorData>(parse_result)) {
+    return {ResultType::ERROR, std::get<common::ErrorData>(parse_result)};
+  }
+  network::Statement statement(std::move(query),
+                               std::move(std::get<std::unique_ptr<parser::ParseResult>>(parse_result)));
+  NOISEPAGE_ASSERT(network::NetworkUtil::DMLQueryType(statement.GetQueryType()), "Internal queries are DML.");
+
+  std::vector<parser::ConstantValueExpression> params;
+  auto result = BindQuery(connection_ctx, common::ManagedPointer(&statement), common::ManagedPointer(&params));
+  if (result.type_ != ResultType::COMPLETE) return result;
+  if (statement.OptimizeResult() == nullptr) {
+    statement.SetOptimizeResult(
+        OptimizeBoundQuery(connection_ctx, statement.ParseResult(), common::ManagedPointer(&params)));
+  }
+
+  network::Portal portal(common::ManagedPointer(&statement));
+  result = CodegenPhysicalPlan(connection_ctx, out, common::ManagedPointer(&portal));
+  if (result.type_ != ResultType::COMPLETE) return result;
+  return RunExecutableQuery(connection_ctx, out, common::ManagedPointer(&portal));
+}
+
 TrafficCopResult TrafficCop::ExecuteDropStatement(
     const common::ManagedPointer<network::ConnectionContext> connection_ctx,
     const common::ManagedPointer<planner::AbstractPlanNode> physical_plan,
@@ -300,6 +762,7 @@ TrafficCopResult TrafficCop::ExecuteDropStatement(
           query_type == network::QueryType::QUERY_DROP_INDEX || query_type == network::QueryType::QUERY_DROP_DB ||
           query_type == network::QueryType::QUERY_DROP_VIEW || query_type == network::QueryType::QUERY_DROP_TRIGGER,
       "ExecuteDropStatement called with invalid QueryType.");
+  InvalidateCompiledQueriesOnCommit(connection_ctx);
   switch (query_type) {
     case network::QueryType::QUERY_DROP_TABLE: {
       if (execution::sql::DDLExecutors::DropTableExecutor(
@@ -365,7 +828,20 @@ TrafficCopResult TrafficCop::BindQuery(
   NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
                    "Not in a valid txn. This should have been caught before calling this function.");
 
+  // The temporary namespace of the connection is created once a statement creates something in it
+  if (TrafficCopUtil::CreatesTempObject(statement->RootStatement()) && !UseTempNamespace(connection_ctx)) {
+    return {ResultType::ERROR,
+            common::ErrorData(common::ErrorSeverity::ERROR,
+                              "Failed to create a temporary namespace for this connection. There may be a concurrent "
+                              "DDL change. Please retry.",
+                              common::ErrorCode::ERRCODE_T_R_SERIALIZATION_FAILURE)};
+  }
+
   try {
+    if (statement->OptimizeResult() == nullptr && UseQueryCache()) {
+      // another connection may have prepared the same statement already
+      ShareCachedStatement(connection_ctx, statement, parameters);
+    }
     if (statement->OptimizeResult() == nullptr || !UseQueryCache()) {
       // it's not cached, bind it
       binder::BindNodeVisitor visitor(connection_ctx->Accessor(), connection_ctx->GetDatabaseOid());
@@ -377,7 +853,7 @@ TrafficCopResult TrafficCop::BindQuery(
       } else {
         visitor.BindNameToNode(statement->ParseResult(), nullptr, nullptr);
       }
-    } else {
+    } else if (parameters != nullptr) {
       // it's cached. use the desired_param_types to fast-path the binding
       binder::BinderUtil::PromoteParameters(parameters, statement->GetDesiredParamTypes());
     }
@@ -400,6 +876,30 @@ TrafficCopResult TrafficCop::BindQuery(
   return {ResultType::COMPLETE, 0u};
 }
 
+bool TrafficCop::ShareCachedStatement(
+    const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+    const common::ManagedPointer<network::Statement> statement,
+    const common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters) const {
+  if (!network::NetworkUtil::SharedStatementQueryType(statement->GetQueryType())) return false;
+
+  const auto catalog_version = connection_ctx->TransactionCatalogVersion();
+  if (!catalog_version.has_value()) return false;
+
+  CompiledQueryCache::CachedStatement cached;
+  if (!compiled_query_cache_->LookupStatement(connection_ctx->GetDatabaseOid(), statement->GetQueryText(),
+                                              statement->ParamTypes(), *catalog_version, &cached)) {
+    return false;
+  }
+  // Parameters can be bound without declaring their types, so the types alone don't say how many there are.
+  const std::size_t num_params = parameters == nullptr ? 0 : parameters->size();
+  if (cached.desired_param_types_.size() != num_params) return false;
+
+  statement->SetOptimizeResult(std::move(cached.optimize_result_));
+  if (num_params > 0) statement->SetDesiredParamTypes(std::move(cached.desired_param_types_));
+  statement->SetExecutableQuery(std::move(cached.query_));
+  return true;
+}
+
 TrafficCopResult TrafficCop::CodegenPhysicalPlan(
     const common::ManagedPointer<network::ConnectionContext> connection_ctx,
     const common::ManagedPointer<network::PostgresPacketWriter> out,
@@ -411,50 +911,81 @@ TrafficCopResult TrafficCop::CodegenPhysicalPlan(
   NOISEPAGE_ASSERT(
       query_type == network::QueryType::QUERY_SELECT || query_type == network::QueryType::QUERY_INSERT ||
           query_type == network::QueryType::QUERY_CREATE_INDEX || query_type == network::QueryType::QUERY_UPDATE ||
-          query_type == network::QueryType::QUERY_DELETE || query_type == network::QueryType::QUERY_ANALYZE,
+          query_type == network::QueryType::QUERY_DELETE || query_type == network::QueryType::QUERY_ANALYZE ||
+          query_type == network::QueryType::QUERY_COPY,
       "CodegenAndRunPhysicalPlan called with invalid QueryType.");
 
-  if (portal->GetStatement()->GetExecutableQuery() != nullptr && use_query_cache_) {
+  const auto statement = portal->GetStatement();
+  if (statement->GetExecutableQuery() != nullptr && use_query_cache_) {
     // We've already codegen'd this, move on...
     return {ResultType::COMPLETE, 0u};
   }
 
-  // TODO(WAN): see #1047
-  execution::exec::ExecutionSettings exec_settings{};
-  exec_settings.UpdateFromSettingsManager(settings_manager_);
+  // Another statement, possibly on another connection, may have codegen'd an equal plan already.
+  const auto db_oid = connection_ctx->GetDatabaseOid();
+  std::shared_ptr<execution::compiler::ExecutableQuery> exec_query = nullptr;
+  if (use_query_cache_) {
+    exec_query = compiled_query_cache_->Lookup(db_oid, *physical_plan, statement->ParamTypes());
+  }
+  // The plan of a txn that changed the catalog itself may refer to objects no one else sees, so it isn't shared.
+  const auto catalog_version = connection_ctx->TransactionCatalogVersion();
+  const bool share_query = use_query_cache_ && catalog_version.has_value();
 
-  auto exec_query = execution::compiler::CompilationContext::Compile(
-      *physical_plan, exec_settings, connection_ctx->Accessor().Get(),
-      execution::compiler::CompilationMode::Interleaved,
-      common::ManagedPointer<const std::string>(&portal->GetStatement()->GetQueryText()));
+  if (exec_query == nullptr) {
+    // TODO(WAN): see #1047
+    execution::exec::ExecutionSettings exec_settings{};
+    exec_settings.UpdateFromSettingsManager(settings_manager_);
+    exec_settings.SetOptimizationProfile(TrafficCopUtil::ChooseOptimizationProfile(portal->OptimizeResult()));
 
-  // TODO(Matt): handle code generation failing
+    auto compiled_query = execution::compiler::CompilationContext::Compile(
+        *physical_plan, exec_settings, connection_ctx->Accessor().Get(),
+        execution::compiler::CompilationMode::Interleaved,
+        common::ManagedPointer<const std::string>(&statement->GetQueryText()));
+
+    // TODO(Matt): handle code generation failing
+
+    if (share_query) {
+      exec_query =
+          compiled_query_cache_->Insert(db_oid, statement->ShareOptimizeResult(), statement->ParamTypes(),
+                                        statement->GetQueryText(), std::move(compiled_query), *catalog_version);
+    } else {
+      exec_query = std::move(compiled_query);
+    }
+  }
+
+  // Let other connections preparing the same statement skip straight to here.
+  if (share_query && network::NetworkUtil::SharedStatementQueryType(statement->GetQueryType())) {
+    compiled_query_cache_->InsertStatement(db_oid, statement->GetQueryText(), statement->ParamTypes(),
+                                           statement->GetDesiredParamTypes(), *physical_plan);
+  }
 
   const bool query_trace_metrics_enabled =
       common::thread_context.metrics_store_ != nullptr &&
       common::thread_context.metrics_store_->ComponentToRecord(metrics::MetricsComponent::QUERY_TRACE);
   if (query_trace_metrics_enabled) {
-    common::thread_context.metrics_store_->RecordQueryText(connection_ctx->GetDatabaseOid(), exec_query->GetQueryId(),
-                                                           portal->GetStatement()->GetQueryText(), portal->Parameters(),
-                                                           metrics::MetricsUtil::Now());
+    common::thread_context.metrics_store_->RecordQueryText(db_oid, exec_query->GetQueryId(), statement->GetQueryText(),
+                                                           portal->Parameters(), metrics::MetricsUtil::Now());
   }
 
-  portal->GetStatement()->SetExecutableQuery(std::move(exec_query));
+  statement->SetExecutableQuery(std::move(exec_query));
 
   return {ResultType::COMPLETE, 0u};
 }
 
 TrafficCopResult TrafficCop::RunExecutableQuery(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
                                                 const common::ManagedPointer<network::PostgresPacketWriter> out,
-                                                const common::ManagedPointer<network::Portal> portal) const {
+                                                const common::ManagedPointer<network::Portal> portal,
+                                                const bool suspend) const {
   NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
                    "Not in a valid txn. This should have been caught before calling this function.");
   const auto query_type = portal->GetStatement()->GetQueryType();
+  NOISEPAGE_ASSERT(!suspend || query_type == network::QueryType::QUERY_SELECT, "Only a SELECT suspends its portal.");
   const auto physical_plan = portal->OptimizeResult()->GetPlanNode();
   NOISEPAGE_ASSERT(
       query_type == network::QueryType::QUERY_SELECT || query_type == network::QueryType::QUERY_INSERT ||
           query_type == network::QueryType::QUERY_CREATE_INDEX || query_type == network::QueryType::QUERY_UPDATE ||
-          query_type == network::QueryType::QUERY_DELETE || query_type == network::QueryType::QUERY_ANALYZE,
+          query_type == network::QueryType::QUERY_DELETE || query_type == network::QueryType::QUERY_ANALYZE ||
+          query_type == network::QueryType::QUERY_COPY,
       "CodegenAndRunPhysicalPlan called with invalid QueryType.");
 
   /*
@@ -470,7 +1001,8 @@ TrafficCopResult TrafficCop::RunExecutableQuery(const common::ManagedPointer<net
         [=]() { stats_storage_->MarkStatsStale(db_oid, table_oid, col_oids); });
   }
 
-  execution::exec::OutputWriter writer(physical_plan->GetOutputSchema(), out, portal->ResultFormats());
+  execution::exec::OutputWriter writer(physical_plan->GetOutputSchema(), out, portal->ResultFormats(),
+                                       query_type == network::QueryType::QUERY_COPY);
 
   // A std::function<> requires the target to be CopyConstructible and CopyAssignable. In certain
   // cases constructing a std::function<> copies the target. This can lead to cases where invoking
@@ -480,8 +1012,32 @@ TrafficCopResult TrafficCop::RunExecutableQuery(const common::ManagedPointer<net
   // created during execution to write to the output consumer using the same writer instance
   // (which will also yield a correct writer.NumRows()).
   execution::exec::OutputWriter *capture_writer = &writer;
-  execution::exec::OutputCallback callback = [capture_writer](byte *tuples, uint32_t num_tuples, uint32_t tuple_size) {
-    (*capture_writer)(tuples, num_tuples, tuple_size);
+
+  // The batches are also kept for the result cache along the way, if the result may be cached
+  std::vector<common::ManagedPointer<storage::SqlTable>> cache_tables;
+  std::shared_ptr<ResultCache::Result> cache_result = nullptr;
+  if (GetResultCacheTables(connection_ctx, portal, &cache_tables)) {
+    cache_result = std::make_shared<ResultCache::Result>(physical_plan->GetOutputSchema()->GetColumns(),
+                                                         result_cache_->GetCapacity());
+  }
+  ResultCache::Result *capture_result = cache_result.get();
+
+  // A suspended portal keeps the whole output, which it hands out over several Executes
+  std::shared_ptr<ResultCache::Result> portal_result = nullptr;
+  if (suspend) {
+    portal_result = std::make_shared<ResultCache::Result>(physical_plan->GetOutputSchema()->GetColumns(),
+                                                          std::numeric_limits<std::size_t>::max());
+  }
+  ResultCache::Result *capture_portal_result = portal_result.get();
+
+  execution::exec::OutputCallback callback = [capture_writer, capture_result, capture_portal_result](
+                                                 byte *tuples, uint32_t num_tuples, uint32_t tuple_size) {
+    if (capture_portal_result != nullptr) {
+      capture_portal_result->Append(tuples, num_tuples, tuple_size);
+    } else {
+      (*capture_writer)(tuples, num_tuples, tuple_size);
+    }
+    if (capture_result != nullptr) capture_result->Append(tuples, num_tuples, tuple_size);
   };
 
   execution::exec::ExecutionSettings exec_settings{};
@@ -498,10 +1054,61 @@ TrafficCopResult TrafficCop::RunExecutableQuery(const common::ManagedPointer<net
 
   exec_ctx->SetParams(portal->Parameters());
 
-  const auto exec_query = portal->GetStatement()->GetExecutableQuery();
+  // A SELECT may check the sizes of its hash join build sides against the estimates of the optimizer
+  const int64_t max_cardinality_error =
+      settings_manager_ != nullptr && query_type == network::QueryType::QUERY_SELECT
+          ? settings_manager_->GetInt(settings::Param::reoptimization_cardinality_error)
+          : 0;
+  if (max_cardinality_error > 0) {
+    exec_ctx->SetCardinalityCheck(portal->OptimizeResult()->GetPlanMetaData(), max_cardinality_error);
+  }
+
+  auto exec_query = portal->GetStatement()->GetExecutableQuery();
+
+  const bool query_trace_metrics_enabled =
+      common::thread_context.metrics_store_ != nullptr &&
+      common::thread_context.metrics_store_->ComponentToRecord(metrics::MetricsComponent::QUERY_TRACE);
+  const uint64_t start_time = query_trace_metrics_enabled ? metrics::MetricsUtil::Now() : 0;
+
+  // Kept alive until the end of the query, if it is re-optimized
+  std::unique_ptr<optimizer::OptimizeResult> reoptimized_result;
+  std::unique_ptr<execution::compiler::ExecutableQuery> reoptimized_query;
 
   try {
-    exec_query->Run(common::ManagedPointer(exec_ctx), execution_mode_);
+    RunQuery(connection_ctx, exec_query.Get(), common::ManagedPointer(exec_ctx));
+
+    if (exec_ctx->NeedsReoptimization() &&
+        connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK) {
+      // The query stopped after a build side far off its estimate, before it produced any output, since the build
+      // sides are done before the pipelines that probe them. It is optimized again with the sizes observed so far and
+      // restarts, only once, under a plan that is compiled for this run alone.
+      optimizer::CardinalityFeedback feedback;
+      const auto estimates = portal->OptimizeResult()->GetPlanMetaData();
+      for (const auto &[plan_node_id, num_rows] : exec_ctx->GetObservedCardinalities()) {
+        const auto &table_aliases = estimates->GetPlanNodeMetaData(plan_node_id).GetTableAliases();
+        if (!table_aliases.empty()) feedback.Add(table_aliases, num_rows);
+      }
+
+      auto params = *portal->Parameters();
+      reoptimized_result =
+          OptimizeBoundQuery(connection_ctx, portal->GetStatement()->ParseResult(), common::ManagedPointer(&params),
+                             common::ManagedPointer<const optimizer::CardinalityFeedback>(&feedback));
+      const auto reoptimized_plan = reoptimized_result->GetPlanNode();
+      exec_settings.SetOptimizationProfile(
+          TrafficCopUtil::ChooseOptimizationProfile(common::ManagedPointer(reoptimized_result)));
+      reoptimized_query = execution::compiler::CompilationContext::Compile(
+          *reoptimized_plan, exec_settings, connection_ctx->Accessor().Get(),
+          execution::compiler::CompilationMode::Interleaved,
+          common::ManagedPointer<const std::string>(&portal->GetStatement()->GetQueryText()));
+      exec_query = common::ManagedPointer(reoptimized_query);
+
+      exec_ctx = std::make_unique<execution::exec::ExecutionContext>(
+          connection_ctx->GetDatabaseOid(), connection_ctx->Transaction(), callback,
+          reoptimized_plan->GetOutputSchema().Get(), connection_ctx->Accessor(), exec_settings, metrics,
+          replication_manager_, recovery_manager_);
+      exec_ctx->SetParams(portal->Parameters());
+      RunQuery(connection_ctx, exec_query.Get(), common::ManagedPointer(exec_ctx));
+    }
   } catch (ExecutionException &e) {
     /*
      * An ExecutionException is thrown in the case of some failure caused by a software bug or caused by some data
@@ -515,19 +1122,29 @@ TrafficCopResult TrafficCop::RunExecutableQuery(const common::ManagedPointer<net
     return {ResultType::ERROR, error};
   }
 
-  const bool query_trace_metrics_enabled =
-      common::thread_context.metrics_store_ != nullptr &&
-      common::thread_context.metrics_store_->ComponentToRecord(metrics::MetricsComponent::QUERY_TRACE);
-
   if (query_trace_metrics_enabled) {
-    common::thread_context.metrics_store_->RecordQueryTrace(connection_ctx->GetDatabaseOid(), exec_query->GetQueryId(),
-                                                            metrics::MetricsUtil::Now(), portal->Parameters());
+    const uint64_t end_time = metrics::MetricsUtil::Now();
+    common::thread_context.metrics_store_->RecordQueryTrace(
+        connection_ctx->GetDatabaseOid(), exec_query->GetQueryId(), end_time, end_time - start_time,
+        connection_ctx->GetConnectionID().UnderlyingValue(), portal->Parameters());
   }
 
   if (connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK) {
     // Execution didn't set us to FAIL state, go ahead and return command complete
-    if (query_type == network::QueryType::QUERY_SELECT) {
-      // For selects we rely on the OutputWriter to store the number of rows affected because sequential scan
+    if (query_type == network::QueryType::QUERY_SELECT || query_type == network::QueryType::QUERY_COPY) {
+      // The query didn't write anything after all, or its result would be one no other txn sees
+      if (cache_result != nullptr && connection_ctx->Transaction()->IsReadOnly()) {
+        result_cache_->Insert(connection_ctx->GetDatabaseOid(), portal->GetStatement()->ShareOptimizeResult(),
+                              *portal->Parameters(), std::move(cache_tables),
+                              connection_ctx->Transaction()->StartTime(), std::move(cache_result),
+                              *connection_ctx->TransactionCatalogVersion());
+      }
+      if (portal_result != nullptr) {
+        const uint32_t num_rows = portal_result->GetNumTuples();
+        portal->Suspend(std::move(portal_result));
+        return {ResultType::COMPLETE, num_rows};
+      }
+      // For selects and copies we rely on the OutputWriter to store the number of rows affected because sequential scan
       // iteration can happen in multiple pipelines
       return {ResultType::COMPLETE, writer.NumRows()};
     }
@@ -542,8 +1159,193 @@ TrafficCopResult TrafficCop::RunExecutableQuery(const common::ManagedPointer<net
                                                common::ErrorCode::ERRCODE_T_R_SERIALIZATION_FAILURE)};
 }
 
+TrafficCopResult TrafficCop::ExecuteExplainStatement(
+    const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+    const common::ManagedPointer<network::PostgresPacketWriter> out,
+    const common::ManagedPointer<network::Portal> portal) const {
+  NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
+                   "Not in a valid txn. This should have been caught before calling this function.");
+  NOISEPAGE_ASSERT(portal->GetStatement()->GetQueryType() == network::QueryType::QUERY_EXPLAIN,
+                   "ExecuteExplainStatement called with invalid QueryType.");
+
+  const auto explain_stmt = portal->GetStatement()->RootStatement().CastManagedPointerTo<parser::ExplainStatement>();
+  const auto explained_type = TrafficCopUtil::QueryTypeForStatement(explain_stmt->GetSQLStatement());
+  if (!network::NetworkUtil::DMLQueryType(explained_type) || explained_type == network::QueryType::QUERY_ANALYZE) {
+    return {ResultType::ERROR, common::ErrorData(common::ErrorSeverity::ERROR, "EXPLAIN only supports DML statements.",
+                                                 common::ErrorCode::ERRCODE_FEATURE_NOT_SUPPORTED)};
+  }
+  if (explain_stmt->IsAnalyze() && explained_type != network::QueryType::QUERY_SELECT &&
+      connection_ctx->Transaction()->IsDeclaredReadOnly()) {
+    return {ResultType::ERROR,
+            common::ErrorData(common::ErrorSeverity::ERROR, "cannot execute this statement in a read-only transaction",
+                              common::ErrorCode::ERRCODE_READ_ONLY_SQL_TRANSACTION)};
+  }
+
+  const auto physical_plan = portal->OptimizeResult()->GetPlanNode();
+  std::unique_ptr<execution::exec::ExecutionContext> exec_ctx;
+  uint64_t num_output_rows = 0;
+  execution::exec::OutputCallback callback = [&num_output_rows](byte *, uint32_t num_tuples, uint32_t) {
+    num_output_rows += num_tuples;
+  };
+
+  if (explain_stmt->IsAnalyze()) {
+    // Profiling changes the generated code, so the query is compiled for this run only and never cached
+    execution::exec::ExecutionSettings exec_settings{};
+    exec_settings.UpdateFromSettingsManager(settings_manager_);
+    exec_settings.SetOptimizationProfile(TrafficCopUtil::ChooseOptimizationProfile(portal->OptimizeResult()));
+    exec_settings.SetIsProfilingEnabled(true);
+
+    auto exec_query = execution::compiler::CompilationContext::Compile(
+        *physical_plan, exec_settings, connection_ctx->Accessor().Get(),
+        execution::compiler::CompilationMode::Interleaved,
+        common::ManagedPointer<const std::string>(&portal->GetStatement()->GetQueryText()));
+
+    common::ManagedPointer<metrics::MetricsManager> metrics = nullptr;
+    if (common::thread_context.metrics_store_ != nullptr) {
+      metrics = common::thread_context.metrics_store_->MetricsManager();
+    }
+
+    exec_ctx = std::make_unique<execution::exec::ExecutionContext>(
+        connection_ctx->GetDatabaseOid(), connection_ctx->Transaction(), callback,
+        physical_plan->GetOutputSchema().Get(), connection_ctx->Accessor(), exec_settings, metrics,
+        replication_manager_, recovery_manager_);
+    exec_ctx->SetParams(portal->Parameters());
+
+    try {
+      RunQuery(connection_ctx, exec_query.get(), common::ManagedPointer(exec_ctx));
+    } catch (ExecutionException &e) {
+      connection_ctx->Transaction()->SetMustAbort();
+      auto error = common::ErrorData(common::ErrorSeverity::ERROR, e.what(), e.code_);
+      error.AddField(common::ErrorField::LINE, std::to_string(e.GetLine()));
+      error.AddField(common::ErrorField::FILE, e.GetFile());
+      return {ResultType::ERROR, error};
+    }
+
+    if (connection_ctx->TransactionState() != network::NetworkTransactionStateType::BLOCK) {
+      return {ResultType::ERROR, common::ErrorData(common::ErrorSeverity::ERROR, "Query failed.",
+                                                   common::ErrorCode::ERRCODE_T_R_SERIALIZATION_FAILURE)};
+    }
+  }
+
+  // The plan tree, then the measurements of every pipeline
+  const auto *profile = exec_ctx == nullptr ? nullptr : exec_ctx->GetQueryProfile();
+  std::vector<std::string> lines;
+  AppendExplainLines(*physical_plan, 0, profile, &lines);
+  if (profile != nullptr) {
+    for (const auto pipeline_id : profile->GetPipelineIds()) {
+      const auto *pipeline = profile->GetPipelineProfile(pipeline_id);
+      lines.emplace_back(fmt::format("Pipeline {}: time={:.3f} ms, cycles={}, memory={} bytes",
+                                     pipeline_id.UnderlyingValue(), pipeline->nanoseconds_ / 1e6, pipeline->cycles_,
+                                     pipeline->memory_bytes_));
+    }
+    lines.emplace_back(fmt::format("Output rows: {}", num_output_rows));
+  }
+
+  auto expr = std::make_unique<parser::ConstantValueExpression>(type::TypeId::VARCHAR);
+  expr->SetAlias("QUERY PLAN");
+  std::vector<noisepage::planner::OutputSchema::Column> cols;
+  cols.emplace_back("QUERY PLAN", type::TypeId::VARCHAR, std::move(expr));
+
+  out->WriteRowDescription(cols, {network::FieldFormat::text});
+  for (const auto &line : lines) {
+    execution::sql::StringVal row(line.c_str(), line.size());
+    out->WriteDataRow(reinterpret_cast<const byte *>(&row), cols, {network::FieldFormat::text});
+  }
+  return {ResultType::COMPLETE, static_cast<uint32_t>(lines.size())};
+}
+
+catalog::db_oid_t TrafficCop::GetDatabaseOid(const std::string &database_name) const {
+  auto *const txn = txn_manager_->BeginTransaction(true);
+  txn->SetReplicationPolicy(transaction::ReplicationPolicy::DISABLE);
+  const auto db_oid = catalog_->GetDatabaseOid(common::ManagedPointer(txn), database_name);
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  return db_oid;
+}
+
+int32_t TrafficCop::RegisterConnection(const common::ManagedPointer<network::ConnectionContext> connection_ctx) const {
+  std::lock_guard<std::mutex> guard(connections_latch_);
+  const auto cancel_key = static_cast<int32_t>(cancel_key_generator_());
+  connections_[connection_ctx->GetConnectionID()] = {cancel_key, nullptr};
+  return cancel_key;
+}
+
+void TrafficCop::UnregisterConnection(const common::ManagedPointer<network::ConnectionContext> connection_ctx) const {
+  std::lock_guard<std::mutex> guard(connections_latch_);
+  connections_.erase(connection_ctx->GetConnectionID());
+}
+
+void TrafficCop::CancelQuery(const network::connection_id_t connection_id, const int32_t cancel_key) const {
+  std::lock_guard<std::mutex> guard(connections_latch_);
+  const auto it = connections_.find(connection_id);
+  if (it == connections_.end() || it->second.cancel_key_ != cancel_key || it->second.running_query_ == nullptr) return;
+  it->second.running_query_->Cancel();
+}
+
+void TrafficCop::WriteMemoryUsage(metrics::MetricsRowWriter *const writer) const {
+  for (uint8_t i = 0; i < common::MemoryAccountant::NUM_COMPONENTS; i++) {
+    const auto component = static_cast<common::MemoryComponent>(i);
+    *writer << "component" << common::MemoryAccountant::ComponentName(component)
+            << common::MemoryAccountant::GetBytes(component);
+    writer->EndRow();
+  }
+
+  // The tables and indexes are only looked up when asked for, since they know their own sizes
+  auto *const txn = txn_manager_->BeginTransaction();
+  const auto common_txn = common::ManagedPointer(txn);
+  for (const auto db_oid : catalog_->GetDatabaseOids(common_txn)) {
+    auto db_catalog = catalog_->GetDatabaseCatalog(common_txn, db_oid);
+    if (db_catalog == nullptr) continue;
+    for (const auto table_oid : db_catalog->GetTableOids(common_txn)) {
+      const auto table = db_catalog->GetTable(common_txn, table_oid);
+      if (table == nullptr) continue;
+      *writer << "table" << fmt::format("{}.{}", db_oid.UnderlyingValue(), table_oid.UnderlyingValue())
+              << table->EstimateHeapUsage();
+      writer->EndRow();
+      for (const auto index_oid : db_catalog->GetIndexOids(common_txn, table_oid)) {
+        const auto index = db_catalog->GetIndex(common_txn, index_oid);
+        if (index == nullptr) continue;
+        *writer << "index" << fmt::format("{}.{}", db_oid.UnderlyingValue(), index_oid.UnderlyingValue())
+                << index->EstimateHeapUsage();
+        writer->EndRow();
+      }
+    }
+  }
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // A running query can't end while the latch is held, see SetRunningQuery()
+  std::lock_guard<std::mutex> guard(connections_latch_);
+  for (const auto &[connection_id, connection] : connections_) {
+    if (connection.running_query_ == nullptr) continue;
+    const auto *const query = connection.running_query_;
+    *writer << "query" << fmt::format("{}.{}", connection_id.UnderlyingValue(), query->GetQueryId().UnderlyingValue())
+            << query->GetMemoryTracker()->GetMergedAllocatedSize();
+    writer->EndRow();
+  }
+}
+
+void TrafficCop::SetRunningQuery(const network::connection_id_t connection_id,
+                                 execution::exec::ExecutionContext *const exec_ctx) const {
+  std::lock_guard<std::mutex> guard(connections_latch_);
+  const auto it = connections_.find(connection_id);
+  if (it != connections_.end()) it->second.running_query_ = exec_ctx;
+}
+
+void TrafficCop::RunQuery(const common::ManagedPointer<network::ConnectionContext> connection_ctx,
+                          execution::compiler::ExecutableQuery *const query,
+                          const common::ManagedPointer<execution::exec::ExecutionContext> exec_ctx) const {
+  // The execution context must not be canceled once it's gone, however the query ends
+  SetRunningQuery(connection_ctx->GetConnectionID(), exec_ctx.Get());
+  try {
+    query->Run(exec_ctx, execution_mode_);
+  } catch (...) {
+    SetRunningQuery(connection_ctx->GetConnectionID(), nullptr);
+    throw;
+  }
+  SetRunningQuery(connection_ctx->GetConnectionID(), nullptr);
+}
+
 std::pair<catalog::db_oid_t, catalog::namespace_oid_t> TrafficCop::CreateTempNamespace(
-    const network::connection_id_t connection_id, const std::string &database_name) {
+    const network::connection_id_t connection_id, const std::string &database_name) const {
   auto *const txn = txn_manager_->BeginTransaction();
   txn->SetReplicationPolicy(transaction::ReplicationPolicy::DISABLE);
 
@@ -569,6 +1371,30 @@ std::pair<catalog::db_oid_t, catalog::namespace_oid_t> TrafficCop::CreateTempNam
   return {db_oid, ns_oid};
 }
 
+bool TrafficCop::UseTempNamespace(const common::ManagedPointer<network::ConnectionContext> connection_ctx) const {
+  NOISEPAGE_ASSERT(connection_ctx->TransactionState() == network::NetworkTransactionStateType::BLOCK,
+                   "Not in a valid txn. This should have been caught before calling this function.");
+  if (connection_ctx->GetTempNamespaceOid() != catalog::INVALID_NAMESPACE_OID) return true;
+
+  // The namespace is created in a txn of its own, so that it doesn't go away if the connection's txn aborts. We loop
+  // with exponential backoff because the creation conflicts with concurrent DDL changes.
+  std::pair<catalog::db_oid_t, catalog::namespace_oid_t> oids;
+  uint32_t sleep_time = INITIAL_BACKOFF_TIME;
+  do {
+    oids = CreateTempNamespace(connection_ctx->GetConnectionID(), connection_ctx->GetDatabaseName());
+    if (oids.first == catalog::INVALID_DATABASE_OID || oids.second != catalog::INVALID_NAMESPACE_OID) break;
+    std::this_thread::sleep_for(std::chrono::milliseconds{sleep_time});
+    sleep_time *= BACKOFF_FACTOR;
+  } while (sleep_time <= MAX_BACKOFF_TIME);
+  if (oids.second == catalog::INVALID_NAMESPACE_OID) return false;
+
+  connection_ctx->SetTempNamespaceOid(oids.second);
+  connection_ctx->Accessor()->SetTempNamespace(oids.second);
+  // From now on the plans of the connection may refer to its temporary objects, see BeginTransaction
+  connection_ctx->SetTransactionCatalogVersion(std::nullopt);
+  return true;
+}
+
 bool TrafficCop::DropTempNamespace(const catalog::db_oid_t db_oid, const catalog::namespace_oid_t ns_oid) {
   NOISEPAGE_ASSERT(db_oid != catalog::INVALID_DATABASE_OID, "Called DropTempNamespace() with an invalid database oid.");
   NOISEPAGE_ASSERT(ns_oid != catalog::INVALID_NAMESPACE_OID,
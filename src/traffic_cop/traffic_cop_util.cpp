@@ -1,5 +1,13 @@
 #include "traffic_cop/traffic_cop_util.h"
 
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
 #include "catalog/catalog_accessor.h"
 #include "optimizer/abstract_optimizer.h"
 #include "optimizer/cost_model/trivial_cost_model.h"
@@ -9,13 +17,26 @@
 #include "optimizer/properties.h"
 #include "optimizer/property_set.h"
 #include "optimizer/query_to_operator_transformer.h"
+#include "optimizer/statistics/selectivity_util.h"
 #include "optimizer/statistics/stats_storage.h"
+#include "optimizer/statistics/value_condition.h"
 #include "parser/analyze_statement.h"
+#include "parser/copy_statement.h"
+#include "parser/create_statement.h"
+#include "parser/delete_statement.h"
 #include "parser/drop_statement.h"
+#include "parser/explain_statement.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/constant_value_expression.h"
+#include "parser/expression/parameter_value_expression.h"
+#include "parser/expression_util.h"
 #include "parser/insert_statement.h"
 #include "parser/parser_defs.h"
 #include "parser/postgresparser.h"
+#include "parser/select_statement.h"
+#include "parser/table_ref.h"
 #include "parser/transaction_statement.h"
+#include "parser/update_statement.h"
 #include "planner/plannodes/abstract_plan_node.h"
 
 namespace noisepage::trafficcop {
@@ -26,13 +47,31 @@ std::unique_ptr<optimizer::OptimizeResult> TrafficCopUtil::Optimize(
     const common::ManagedPointer<parser::ParseResult> query, const catalog::db_oid_t db_oid,
     common::ManagedPointer<optimizer::StatsStorage> stats_storage,
     std::unique_ptr<optimizer::AbstractCostModel> cost_model, const uint64_t optimizer_timeout,
-    common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters) {
+    common::ManagedPointer<std::vector<parser::ConstantValueExpression>> parameters,
+    const uint32_t optimizer_num_threads,
+    const common::ManagedPointer<const optimizer::CardinalityFeedback> cardinality_feedback) {
+  // EXPLAIN plans the statement it explains, COPY ... TO STDOUT the query whose result it streams to the client, and
+  // CREATE MATERIALIZED VIEW the query whose output gives the columns of the view
+  auto statement = query->GetStatement(0);
+  if (statement->GetType() == parser::StatementType::EXPLAIN) {
+    statement = statement.CastManagedPointerTo<parser::ExplainStatement>()->GetSQLStatement();
+  } else if (IsCreateMaterializedView(statement)) {
+    statement = statement.CastManagedPointerTo<parser::CreateStatement>()
+                    ->GetViewQuery()
+                    .CastManagedPointerTo<parser::SQLStatement>();
+  } else if (IsCopyToStdout(statement)) {
+    statement = statement.CastManagedPointerTo<parser::CopyStatement>()
+                    ->GetSelectStatement()
+                    .CastManagedPointerTo<parser::SQLStatement>();
+  }
+
   // Optimizer transforms annotated ParseResult to logical expressions (ephemeral Optimizer structure)
   optimizer::QueryToOperatorTransformer transformer(accessor, db_oid);
-  auto logical_exprs = transformer.ConvertToOpExpression(query->GetStatement(0), query);
+  auto logical_exprs = transformer.ConvertToOpExpression(statement, query);
 
   // TODO(Matt): is the cost model to use going to become an arg to this function eventually?
-  optimizer::Optimizer optimizer(std::move(cost_model), optimizer_timeout);
+  optimizer::Optimizer optimizer(std::move(cost_model), optimizer_timeout, optimizer_num_threads);
+  optimizer.SetCardinalityFeedback(cardinality_feedback);
   optimizer::PropertySet property_set;
   std::vector<common::ManagedPointer<parser::AbstractExpression>> output;
 
@@ -40,9 +79,9 @@ std::unique_ptr<optimizer::OptimizeResult> TrafficCopUtil::Optimize(
   // If any more logic like this is needed in the future, we should break this into its own function somewhere since
   // this is Optimizer-specific stuff.
 
-  const auto type = query->GetStatement(0)->GetType();
+  const auto type = statement->GetType();
   if (type == parser::StatementType::SELECT) {
-    const auto sel_stmt = query->GetStatement(0).CastManagedPointerTo<parser::SelectStatement>();
+    const auto sel_stmt = statement.CastManagedPointerTo<parser::SelectStatement>();
 
     // Output
     output = sel_stmt->GetSelectColumns();  // TODO(Matt): this is making a local copy. Revisit the life cycle and
@@ -50,8 +89,8 @@ std::unique_ptr<optimizer::OptimizeResult> TrafficCopUtil::Optimize(
 
     CollectSelectProperties(sel_stmt, &property_set);
   } else if (type == parser::StatementType::INSERT &&
-             query->GetStatement(0).CastManagedPointerTo<parser::InsertStatement>()->GetSelect() != nullptr) {
-    const auto sel_stmt = query->GetStatement(0).CastManagedPointerTo<parser::InsertStatement>()->GetSelect();
+             statement.CastManagedPointerTo<parser::InsertStatement>()->GetSelect() != nullptr) {
+    const auto sel_stmt = statement.CastManagedPointerTo<parser::InsertStatement>()->GetSelect();
 
     // Inset into select output will be pushed down to select
     output = sel_stmt->GetSelectColumns();  // TODO(Matt): this is making a local copy. Revisit the life cycle and
@@ -94,6 +133,237 @@ void TrafficCopUtil::CollectSelectProperties(common::ManagedPointer<parser::Sele
   }
 }
 
+execution::vm::OptimizationProfile TrafficCopUtil::ChooseOptimizationProfile(
+    const common::ManagedPointer<optimizer::OptimizeResult> optimize_result) {
+  const auto meta_data = optimize_result->GetPlanMetaData();
+
+  // The largest estimate over all plan nodes, -1 if there is none.
+  int max_cardinality = -1;
+  std::vector<common::ManagedPointer<planner::AbstractPlanNode>> plans{optimize_result->GetPlanNode()};
+  while (!plans.empty()) {
+    const auto plan = plans.back();
+    plans.pop_back();
+    if (meta_data->HasPlanNodeMetaData(plan->GetPlanNodeId())) {
+      max_cardinality =
+          std::max(max_cardinality, meta_data->GetPlanNodeMetaData(plan->GetPlanNodeId()).GetCardinality());
+    }
+    for (const auto child : plan->GetChildren()) {
+      plans.push_back(child);
+    }
+  }
+
+  if (max_cardinality < 0) {
+    return execution::vm::OptimizationProfile::Balanced;
+  }
+  if (max_cardinality <= FAST_COMPILE_MAX_CARDINALITY) {
+    return execution::vm::OptimizationProfile::FastCompile;
+  }
+  if (max_cardinality >= MAX_PERFORMANCE_MIN_CARDINALITY) {
+    return execution::vm::OptimizationProfile::MaxPerformance;
+  }
+  return execution::vm::OptimizationProfile::Balanced;
+}
+
+void TrafficCopUtil::CollectJoinConditions(
+    const common::ManagedPointer<parser::TableRef> table_ref,
+    std::vector<common::ManagedPointer<parser::AbstractExpression>> *const conditions) {
+  if (table_ref == nullptr) return;
+  if (table_ref->GetJoin() != nullptr) {
+    const auto join = table_ref->GetJoin();
+    if (join->GetJoinCondition() != nullptr) conditions->emplace_back(join->GetJoinCondition());
+    CollectJoinConditions(join->GetLeftTable(), conditions);
+    CollectJoinConditions(join->GetRightTable(), conditions);
+  }
+  for (const auto &child : table_ref->GetList()) {
+    CollectJoinConditions(child, conditions);
+  }
+}
+
+std::vector<uint8_t> TrafficCopUtil::ParameterSelectivityBuckets(
+    const common::ManagedPointer<catalog::CatalogAccessor> accessor,
+    const common::ManagedPointer<optimizer::StatsStorage> stats_storage, const catalog::db_oid_t db_oid,
+    const common::ManagedPointer<parser::SQLStatement> statement,
+    const common::ManagedPointer<const std::vector<parser::ConstantValueExpression>> parameters) {
+  std::vector<uint8_t> buckets;
+  if (stats_storage == nullptr || parameters == nullptr || parameters->empty()) return buckets;
+
+  std::vector<common::ManagedPointer<parser::AbstractExpression>> exprs;
+  switch (statement->GetType()) {
+    case parser::StatementType::SELECT: {
+      const auto select = statement.CastManagedPointerTo<parser::SelectStatement>();
+      if (select->GetSelectCondition() != nullptr) exprs.emplace_back(select->GetSelectCondition());
+      CollectJoinConditions(select->GetSelectTable(), &exprs);
+      break;
+    }
+    case parser::StatementType::UPDATE: {
+      const auto condition = statement.CastManagedPointerTo<parser::UpdateStatement>()->GetUpdateCondition();
+      if (condition != nullptr) exprs.emplace_back(condition);
+      break;
+    }
+    case parser::StatementType::DELETE: {
+      const auto condition = statement.CastManagedPointerTo<parser::DeleteStatement>()->GetDeleteCondition();
+      if (condition != nullptr) exprs.emplace_back(condition);
+      break;
+    }
+    default:
+      return buckets;
+  }
+
+  while (!exprs.empty()) {
+    const auto expr = exprs.back();
+    exprs.pop_back();
+    for (const auto &child : expr->GetChildren()) {
+      exprs.emplace_back(child);
+    }
+
+    // Only [column (operator) parameter] and [parameter (operator) column] comparisons are bucketed
+    const auto expr_type = expr->GetExpressionType();
+    const bool is_comparison = expr_type == parser::ExpressionType::COMPARE_EQUAL ||
+                               expr_type == parser::ExpressionType::COMPARE_NOT_EQUAL ||
+                               expr_type == parser::ExpressionType::COMPARE_LESS_THAN ||
+                               expr_type == parser::ExpressionType::COMPARE_LESS_THAN_OR_EQUAL_TO ||
+                               expr_type == parser::ExpressionType::COMPARE_GREATER_THAN ||
+                               expr_type == parser::ExpressionType::COMPARE_GREATER_THAN_OR_EQUAL_TO;
+    if (!is_comparison || expr->GetChildrenSize() != 2) continue;
+    const int param_index = expr->GetChild(1)->GetExpressionType() == parser::ExpressionType::VALUE_PARAMETER ? 1 : 0;
+    const auto param_expr = expr->GetChild(param_index);
+    const auto col_expr = expr->GetChild(1 - param_index);
+    if (param_expr->GetExpressionType() != parser::ExpressionType::VALUE_PARAMETER ||
+        col_expr->GetExpressionType() != parser::ExpressionType::COLUMN_VALUE) {
+      continue;
+    }
+
+    const auto param_idx = param_expr.CastManagedPointerTo<parser::ParameterValueExpression>()->GetValueIdx();
+    const auto cve = col_expr.CastManagedPointerTo<parser::ColumnValueExpression>();
+    if (param_idx >= parameters->size() || parameters->at(param_idx).IsNull() ||
+        cve->GetTableOid() == catalog::INVALID_TABLE_OID) {
+      continue;
+    }
+
+    double selectivity;
+    {
+      const auto latched_table_stats = stats_storage->GetTableStats(db_oid, cve->GetTableOid(), accessor.Get());
+      const auto &table_stats = latched_table_stats.table_stats_;
+      if (!table_stats.HasColumnStats(cve->GetColumnOid())) continue;
+      const auto comparison =
+          param_index == 0 ? parser::ExpressionUtil::ReverseComparisonExpressionType(expr_type) : expr_type;
+      auto value = std::unique_ptr<parser::ConstantValueExpression>{
+          reinterpret_cast<parser::ConstantValueExpression *>(parameters->at(param_idx).Copy().release())};
+      optimizer::ValueCondition condition(cve->GetColumnOid(), cve->GetFullName(), comparison, std::move(value));
+      selectivity = optimizer::SelectivityUtil::ComputeSelectivity(table_stats, condition);
+    }
+
+    // A bucket per order of magnitude of the selectivity, the last one taking everything smaller
+    constexpr auto last_bucket = static_cast<double>(NUM_SELECTIVITY_BUCKETS - 1);
+    const double magnitude = selectivity > 0 ? std::floor(-std::log10(std::min(selectivity, 1.0))) : last_bucket;
+    buckets.emplace_back(static_cast<uint8_t>(std::min(magnitude, last_bucket)));
+  }
+  return buckets;
+}
+
+bool TrafficCopUtil::IsCopyToStdout(const common::ManagedPointer<parser::SQLStatement> statement) {
+  if (statement->GetType() != parser::StatementType::COPY) return false;
+  const auto copy_stmt = statement.CastManagedPointerTo<parser::CopyStatement>();
+  // The parser leaves the file path empty for STDIN and STDOUT
+  return !copy_stmt->IsFrom() && copy_stmt->GetFilePath().empty();
+}
+
+bool TrafficCopUtil::IsCopyFromStdin(const common::ManagedPointer<parser::SQLStatement> statement) {
+  if (statement->GetType() != parser::StatementType::COPY) return false;
+  const auto copy_stmt = statement.CastManagedPointerTo<parser::CopyStatement>();
+  return copy_stmt->IsFrom() && copy_stmt->GetFilePath().empty();
+}
+
+bool TrafficCopUtil::IsCreateMaterializedView(const common::ManagedPointer<parser::SQLStatement> statement) {
+  return statement->GetType() == parser::StatementType::CREATE &&
+         statement.CastManagedPointerTo<parser::CreateStatement>()->GetCreateType() ==
+             parser::CreateStatement::CreateType::kMaterializedView;
+}
+
+std::string TrafficCopUtil::MaterializedViewQueryText(const std::string &create_text) {
+  // The words outside of parentheses, quotes and comments, with where they start and end
+  std::vector<std::tuple<std::string, std::size_t, std::size_t>> words;
+  int32_t depth = 0;
+  std::size_t i = 0;
+  while (i < create_text.size()) {
+    const char c = create_text[i];
+    if (c == '\'' || c == '"') {
+      const auto close = create_text.find(c, i + 1);
+      i = close == std::string::npos ? create_text.size() : close + 1;
+    } else if (c == '-' && i + 1 < create_text.size() && create_text[i + 1] == '-') {
+      const auto eol = create_text.find('\n', i);
+      i = eol == std::string::npos ? create_text.size() : eol + 1;
+    } else if (c == '(' || c == ')') {
+      depth += c == '(' ? 1 : -1;
+      i++;
+    } else if (std::isalpha(static_cast<unsigned char>(c)) != 0 || c == '_') {
+      const auto start = i;
+      while (i < create_text.size() && (std::isalnum(static_cast<unsigned char>(create_text[i])) != 0 ||
+                                        create_text[i] == '_' || create_text[i] == '$')) {
+        i++;
+      }
+      if (depth == 0) {
+        std::string word = create_text.substr(start, i - start);
+        std::transform(word.begin(), word.end(), word.begin(), ::toupper);
+        words.emplace_back(std::move(word), start, i);
+      }
+    } else {
+      i++;
+    }
+  }
+
+  const auto as =
+      std::find_if(words.cbegin(), words.cend(), [](const auto &word) { return std::get<0>(word) == "AS"; });
+  if (as == words.cend()) return "";
+  std::size_t begin = std::get<2>(*as);
+  std::size_t end = create_text.size();
+
+  // WITH DATA and WITH NO DATA are the only words that may follow the query
+  const auto num_words = words.size();
+  if (num_words >= 2 && std::get<0>(words[num_words - 1]) == "DATA") {
+    const bool no = std::get<0>(words[num_words - 2]) == "NO";
+    const auto with = num_words - (no ? 3 : 2);
+    if (with < num_words && std::get<0>(words[with]) == "WITH" && std::get<1>(words[with]) > begin) {
+      end = std::get<1>(words[with]);
+    }
+  }
+
+  const auto is_trailing = [](const char c) { return std::isspace(static_cast<unsigned char>(c)) != 0 || c == ';'; };
+  while (begin < end && is_trailing(create_text[begin])) begin++;
+  while (end > begin && is_trailing(create_text[end - 1])) end--;
+
+  // A query in parentheses would read as a column list after INSERT INTO
+  while (end - begin >= 2 && create_text[begin] == '(' && create_text[end - 1] == ')') {
+    int32_t paren_depth = 0;
+    bool encloses = true;
+    for (std::size_t j = begin; j < end - 1 && encloses; j++) {
+      if (create_text[j] == '(') paren_depth++;
+      if (create_text[j] == ')') paren_depth--;
+      encloses = paren_depth > 0;
+    }
+    if (!encloses) break;
+    begin++;
+    end--;
+    while (begin < end && std::isspace(static_cast<unsigned char>(create_text[begin])) != 0) begin++;
+    while (end > begin && std::isspace(static_cast<unsigned char>(create_text[end - 1])) != 0) end--;
+  }
+  return create_text.substr(begin, end - begin);
+}
+
+bool TrafficCopUtil::CreatesTempObject(const common::ManagedPointer<parser::SQLStatement> statement) {
+  if (statement->GetType() != parser::StatementType::CREATE) return false;
+  const auto create_stmt = statement.CastManagedPointerTo<parser::CreateStatement>();
+  switch (create_stmt->GetCreateType()) {
+    case parser::CreateStatement::CreateType::kTable:
+    case parser::CreateStatement::CreateType::kIndex:
+    case parser::CreateStatement::CreateType::kView:
+    case parser::CreateStatement::CreateType::kMaterializedView:
+      return create_stmt->GetNamespaceName() == catalog::TEMP_NAMESPACE_ALIAS;
+    default:
+      return false;
+  }
+}
+
 network::QueryType TrafficCopUtil::QueryTypeForStatement(const common::ManagedPointer<parser::SQLStatement> statement) {
   const auto statement_type = statement->GetType();
   switch (statement_type) {
@@ -131,6 +401,8 @@ network::QueryType TrafficCopUtil::QueryTypeForStatement(const common::ManagedPo
           return network::QueryType::QUERY_CREATE_SCHEMA;
         case parser::CreateStatement::CreateType::kView:
           return network::QueryType::QUERY_CREATE_VIEW;
+        case parser::CreateStatement::CreateType::kMaterializedView:
+          return network::QueryType::QUERY_CREATE_MATERIALIZED_VIEW;
       }
     }
     case parser::StatementType::DROP: {
@@ -166,6 +438,8 @@ network::QueryType TrafficCopUtil::QueryTypeForStatement(const common::ManagedPo
       return network::QueryType::QUERY_ALTER;
     case parser::StatementType::COPY:
       return network::QueryType::QUERY_COPY;
+    case parser::StatementType::REFRESH:
+      return network::QueryType::QUERY_REFRESH;
     case parser::StatementType::ANALYZE:
       return network::QueryType::QUERY_ANALYZE;
     case parser::StatementType::EXPLAIN:
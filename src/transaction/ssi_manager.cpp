@@ -0,0 +1,126 @@
+#include "transaction/ssi_manager.h"
+
+#include <algorithm>
+
+#include "transaction/timestamp_manager.h"
+#include "transaction/transaction_context.h"
+#include "transaction/transaction_util.h"
+
+namespace noisepage::transaction {
+
+SsiManager::~SsiManager() {
+  for (auto &entry : by_start_time_) delete entry.second;
+}
+
+void SsiManager::Begin(TransactionContext *const txn) {
+  auto *const ssi_txn = new SsiTransaction(txn->StartTime());
+  {
+    common::SpinLatch::ScopedSpinLatch guard(&latch_);
+    by_start_time_.emplace(txn->StartTime(), ssi_txn);
+  }
+  txn->ssi_txn_ = ssi_txn;
+  txn->ssi_manager_ = common::ManagedPointer(this);
+}
+
+void SsiManager::RegisterRead(TransactionContext *const txn, const storage::RawBlock *const block) {
+  SsiTransaction *const ssi_txn = txn->ssi_txn_;
+  // Only the first read of a block takes the lock, every later one is covered by it
+  if (!ssi_txn->read_blocks_.insert(block).second) return;
+  LockShard &shard = ShardFor(block);
+  common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+  shard.readers_[block].push_back(ssi_txn);
+}
+
+void SsiManager::RegisterNewerVersionRead(TransactionContext *const txn, const timestamp_t version_timestamp) {
+  SsiTransaction *const reader = txn->ssi_txn_;
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  SsiTransaction *writer = nullptr;
+  if (TransactionUtil::Committed(version_timestamp)) {
+    const auto it = by_commit_time_.find(version_timestamp);
+    if (it != by_commit_time_.end()) writer = it->second;
+  } else {
+    // An uncommitted version carries the txn id of its writer, which is its start time offset by INT64_MIN
+    const auto it = by_start_time_.find(version_timestamp + INT64_MIN);
+    if (it != by_start_time_.end()) writer = it->second;
+  }
+  // Writers that are not serializable, and aborts, do not take part in SSI
+  if (writer == nullptr || writer == reader) return;
+  AddConflict(reader, writer, reader);
+}
+
+void SsiManager::RegisterWrite(TransactionContext *const txn, const storage::RawBlock *const block) {
+  SsiTransaction *const writer = txn->ssi_txn_;
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  LockShard &shard = ShardFor(block);
+  common::SpinLatch::ScopedSpinLatch shard_guard(&shard.latch_);
+  const auto it = shard.readers_.find(block);
+  if (it == shard.readers_.end()) return;
+  for (SsiTransaction *const reader : it->second) {
+    if (reader != writer && Concurrent(*reader, *writer)) AddConflict(reader, writer, writer);
+  }
+}
+
+bool SsiManager::Validate(TransactionContext *const txn) {
+  SsiTransaction *const ssi_txn = txn->ssi_txn_;
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  if (ssi_txn->doomed_.load() || (ssi_txn->in_conflict_ && ssi_txn->out_conflict_)) return false;
+  ssi_txn->committed_ = true;
+  return true;
+}
+
+void SsiManager::SetCommitTime(TransactionContext *const txn, const timestamp_t commit_time) {
+  SsiTransaction *const ssi_txn = txn->ssi_txn_;
+  NOISEPAGE_ASSERT(ssi_txn->committed_, "Only a validated transaction can commit.");
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  ssi_txn->commit_time_ = commit_time;
+  by_commit_time_.emplace(commit_time, ssi_txn);
+  finished_.push_back(ssi_txn);
+  CleanUp();
+}
+
+void SsiManager::Abort(TransactionContext *const txn) {
+  SsiTransaction *const ssi_txn = txn->ssi_txn_;
+  common::SpinLatch::ScopedSpinLatch guard(&latch_);
+  ssi_txn->aborted_ = true;
+  finished_.push_back(ssi_txn);
+  CleanUp();
+}
+
+void SsiManager::AddConflict(SsiTransaction *const reader, SsiTransaction *const writer,
+                             SsiTransaction *const current) {
+  if (reader->aborted_ || writer->aborted_) return;
+  reader->out_conflict_ = true;
+  writer->in_conflict_ = true;
+  for (SsiTransaction *const pivot : {reader, writer}) {
+    if (!pivot->in_conflict_ || !pivot->out_conflict_) continue;
+    // A pivot that already committed cannot be aborted anymore, so the transaction that completed the structure aborts
+    (pivot->committed_ ? current : pivot)->doomed_.store(true);
+  }
+}
+
+void SsiManager::CleanUp() {
+  if (++finished_since_cleanup_ < CLEANUP_INTERVAL) return;
+  finished_since_cleanup_ = 0;
+
+  // A transaction that committed before the oldest running transaction began is not concurrent with any transaction
+  // that is running or will run
+  const timestamp_t oldest = timestamp_manager_->OldestTransactionStartTime();
+  while (!finished_.empty()) {
+    SsiTransaction *const ssi_txn = finished_.front();
+    if (!ssi_txn->aborted_ && !TransactionUtil::NewerThan(oldest, ssi_txn->commit_time_)) break;
+    finished_.pop_front();
+
+    for (const storage::RawBlock *const block : ssi_txn->read_blocks_) {
+      LockShard &shard = ShardFor(block);
+      common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+      auto &readers = shard.readers_[block];
+      readers.erase(std::find(readers.begin(), readers.end(), ssi_txn));
+      if (readers.empty()) shard.readers_.erase(block);
+    }
+    if (!ssi_txn->aborted_) by_commit_time_.erase(ssi_txn->commit_time_);
+    by_start_time_.erase(ssi_txn->start_time_);
+    delete ssi_txn;
+  }
+}
+
+}  // namespace noisepage::transaction
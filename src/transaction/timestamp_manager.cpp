@@ -6,9 +6,12 @@
 namespace noisepage::transaction {
 
 timestamp_t TimestampManager::OldestTransactionStartTime() {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  const auto &oldest_txn = std::min_element(curr_running_txns_.cbegin(), curr_running_txns_.cend());
-  timestamp_t result = (oldest_txn != curr_running_txns_.end()) ? *oldest_txn : time_.load();
+  // Any transaction that is not registered in its shard by the time we poll it begins after this
+  timestamp_t result = time_.load();
+  for (auto &shard : running_txns_) {
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    if (!shard.start_times_.empty()) result = std::min(result, *shard.start_times_.cbegin());
+  }
   cached_oldest_txn_start_time_.store(result);  // Cache the timestamp
   return result;
 }
@@ -16,18 +19,28 @@ timestamp_t TimestampManager::OldestTransactionStartTime() {
 timestamp_t TimestampManager::CachedOldestTransactionStartTime() { return cached_oldest_txn_start_time_.load(); }
 
 void TimestampManager::RemoveTransaction(timestamp_t timestamp) {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  const size_t ret UNUSED_ATTRIBUTE = curr_running_txns_.erase(timestamp);
-  NOISEPAGE_ASSERT(ret == 1, "erased timestamp did not exist");
+  // Most transactions are removed by the thread that began them, so start looking in its shard
+  const uint32_t first_shard = ShardIndex();
+  for (uint32_t i = 0; i < running_txns_.size(); i++) {
+    auto &shard = running_txns_[(first_shard + i) % running_txns_.size()];
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    if (shard.start_times_.erase(timestamp) == 1) return;
+  }
+  NOISEPAGE_ASSERT(false, "erased timestamp did not exist");
 }
 
 bool TimestampManager::RemoveTransactions(const std::vector<noisepage::transaction::timestamp_t> &timestamps) {
-  common::SpinLatch::ScopedSpinLatch guard(&curr_running_txns_latch_);
-  for (const auto &timestamp : timestamps) {
-    const size_t ret UNUSED_ATTRIBUTE = curr_running_txns_.erase(timestamp);
-    NOISEPAGE_ASSERT(ret == 1, "erased timestamp did not exist");
+  // The serialized transactions were begun on many threads, so look for them in every shard
+  std::vector<timestamp_t> remaining(timestamps);
+  bool all_removed = true;
+  for (auto &shard : running_txns_) {
+    common::SpinLatch::ScopedSpinLatch guard(&shard.latch_);
+    const auto removed = [&](const timestamp_t timestamp) { return shard.start_times_.erase(timestamp) == 1; };
+    remaining.erase(std::remove_if(remaining.begin(), remaining.end(), removed), remaining.end());
+    all_removed = all_removed && shard.start_times_.empty();
   }
-  return curr_running_txns_.empty();
+  NOISEPAGE_ASSERT(remaining.empty(), "erased timestamp did not exist");
+  return all_removed;
 }
 
 }  // namespace noisepage::transaction
@@ -0,0 +1,38 @@
+#include "transaction/transaction_context.h"
+
+#include <memory>
+
+namespace noisepage::transaction {
+
+TransactionContext::WorkerWriteBuffers *TransactionContext::AcquireWorkerBuffers() {
+  common::SpinLatch::ScopedSpinLatch guard(&worker_buffers_latch_);
+  if (!idle_worker_buffers_.empty()) {
+    WorkerWriteBuffers *const buffers = idle_worker_buffers_.back();
+    idle_worker_buffers_.pop_back();
+    return buffers;
+  }
+  // The workers hand their redo segments to the log manager as soon as they fill up, so the records that were staged
+  // before the workers started have to be on their way first
+  if (worker_buffers_.empty()) redo_buffer_.Flush(GetTransactionPolicy());
+  worker_buffers_.push_back(std::make_unique<WorkerWriteBuffers>(buffer_pool_, log_manager_));
+  return worker_buffers_.back().get();
+}
+
+void TransactionContext::ReleaseWorkerBuffers(WorkerWriteBuffers *const buffers) {
+  common::SpinLatch::ScopedSpinLatch guard(&worker_buffers_latch_);
+  idle_worker_buffers_.push_back(buffers);
+}
+
+void TransactionContext::MergeWorkerWrites(const bool flush_redo) {
+  common::SpinLatch::ScopedSpinLatch guard(&worker_buffers_latch_);
+  NOISEPAGE_ASSERT(idle_worker_buffers_.size() == worker_buffers_.size(), "Workers are still writing.");
+  for (const auto &buffers : worker_buffers_) {
+    undo_buffer_.Append(&buffers->undo_buffer_);
+    redo_buffer_.Absorb(&buffers->redo_buffer_, flush_redo, GetTransactionPolicy());
+    loose_ptrs_.insert(loose_ptrs_.end(), buffers->loose_ptrs_.begin(), buffers->loose_ptrs_.end());
+  }
+  worker_buffers_.clear();
+  idle_worker_buffers_.clear();
+}
+
+}  // namespace noisepage::transaction
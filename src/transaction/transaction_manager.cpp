@@ -1,5 +1,7 @@
 #include "transaction/transaction_manager.h"
 
+#include <emmintrin.h>
+
 #include <unordered_set>
 #include <utility>
 
@@ -8,7 +10,7 @@
 #include "metrics/metrics_store.h"
 
 namespace noisepage::transaction {
-TransactionContext *TransactionManager::BeginTransaction() {
+TransactionContext *TransactionManager::BeginTransaction(const bool read_only, const IsolationLevel isolation_level) {
   timestamp_t start_time;
   TransactionContext *result;
 
@@ -20,6 +22,9 @@ TransactionContext *TransactionManager::BeginTransaction() {
   if (txn_metrics_enabled) common::thread_context.resource_tracker_.Start();
   start_time = timestamp_manager_->BeginTransaction();
   result = new TransactionContext(start_time, start_time + INT64_MIN, buffer_pool_, log_manager_);
+  result->timestamp_manager_ = timestamp_manager_;
+  result->declared_read_only_ = read_only;
+  if (isolation_level == IsolationLevel::SERIALIZABLE) ssi_manager_.Begin(result);
   // Set the current default policies for durability and replication.
   result->SetDurabilityPolicy(default_txn_policy_.durability_);
   result->SetReplicationPolicy(default_txn_policy_.replication_);
@@ -38,6 +43,8 @@ TransactionContext *TransactionManager::BeginTransaction() {
 void TransactionManager::LogCommit(TransactionContext *const txn, const timestamp_t commit_time,
                                    const callback_fn commit_callback, void *const commit_callback_arg,
                                    const timestamp_t oldest_active_txn) {
+  // A transaction that only locked tuples has nothing to redo, the same as a read-only one
+  const bool nothing_to_redo = !txn->HasStagedRecords();
   if (log_manager_ != DISABLED) {
     if (txn->GetDurabilityPolicy() == DurabilityPolicy::SYNC) {
       // At this point the commit has already happened for the rest of the system.
@@ -45,17 +52,18 @@ void TransactionManager::LogCommit(TransactionContext *const txn, const timestam
       byte *const commit_record =
           txn->redo_buffer_.NewEntry(storage::CommitRecord::Size(), txn->GetTransactionPolicy());
       storage::CommitRecord::Initialize(commit_record, txn->StartTime(), commit_time, commit_callback,
-                                        commit_callback_arg, oldest_active_txn, txn->IsReadOnly(), txn,
+                                        commit_callback_arg, oldest_active_txn, nothing_to_redo, txn,
                                         timestamp_manager_.Get());
     } else if (txn->GetDurabilityPolicy() == DurabilityPolicy::ASYNC) {
       NOISEPAGE_ASSERT(
-          txn->GetReplicationPolicy() != ReplicationPolicy::SYNC,
-          "SYNC replication with ASYNC durability is a rather weird setup."
+          txn->GetReplicationPolicy() != ReplicationPolicy::SYNC &&
+              txn->GetReplicationPolicy() != ReplicationPolicy::QUORUM,
+          "SYNC or QUORUM replication with ASYNC durability is a rather weird setup."
           "More importantly, it does not fit in nicely with the swap-in-callback model that we have going.");
       NOISEPAGE_ASSERT(txn->GetReplicationPolicy() == ReplicationPolicy::ASYNC ||
                            txn->GetReplicationPolicy() == ReplicationPolicy::DISABLE,
                        "The below code has only been reasoned about for these cases. See TrafficCop::CommitCallback.");
-      if (txn->IsReadOnly()) {
+      if (nothing_to_redo) {
         // Read-only txns have no external dependencies through the system, so remove it from running transactions
         // table immediately
         timestamp_manager_->RemoveTransaction(txn->StartTime());
@@ -67,7 +75,7 @@ void TransactionManager::LogCommit(TransactionContext *const txn, const timestam
         byte *const commit_record =
             txn->redo_buffer_.NewEntry(storage::CommitRecord::Size(), txn->GetTransactionPolicy());
         storage::CommitRecord::Initialize(commit_record, txn->StartTime(), commit_time, TransactionUtil::EmptyCallback,
-                                          nullptr, oldest_active_txn, txn->IsReadOnly(), txn, timestamp_manager_.Get());
+                                          nullptr, oldest_active_txn, false, txn, timestamp_manager_.Get());
       }
       commit_callback(commit_callback_arg);
     } else {
@@ -99,14 +107,82 @@ timestamp_t TransactionManager::UpdatingCommitCriticalSection(TransactionContext
   //  Make sure you solve this problem before you remove this gate for whatever reason.
   common::Gate::ScopedLock gate(&txn_gate_);
   const timestamp_t commit_time = timestamp_manager_->CheckOutTimestamp();
+  // Readers must be able to attribute the committed versions of a serializable transaction to it
+  if (txn->IsSerializable()) ssi_manager_.SetCommitTime(txn, commit_time);
 
   // flip all timestamps to be committed
-  for (auto &it : txn->undo_buffer_) it.Timestamp().store(commit_time);
+  StampCommit(txn, commit_time);
   return commit_time;
 }
 
+void TransactionManager::StampCommit(TransactionContext *const txn, const timestamp_t commit_time) {
+  storage::DataTable *last_table = nullptr;
+  for (auto &it : txn->undo_buffer_) {
+    it.Timestamp().store(commit_time);
+    // Records of the same table tend to follow each other, which spares most of the updates
+    if (it.Table() != nullptr && it.Table() != last_table) {
+      last_table = it.Table();
+      last_table->UpdateLastCommitTime(commit_time);
+    }
+  }
+}
+
+timestamp_t TransactionManager::BatchedCommitCriticalSection(TransactionContext *const txn) {
+  CommitRequest request{txn};
+  request.next_ = pending_commits_.load();
+  while (!pending_commits_.compare_exchange_weak(request.next_, &request)) {
+  }
+
+  // Whoever holds the leader latch checks out timestamps for everyone that queued up in the meantime. A follower waits
+  // for a leader to pick up its request, or becomes the next leader once the current one is done.
+  while (!request.done_.load(std::memory_order_acquire)) {
+    if (commit_leader_latch_.TryLock()) {
+      CommitRequest *const batch = pending_commits_.exchange(nullptr);
+      if (batch != nullptr) ProcessCommitBatch(batch);
+      commit_leader_latch_.Unlock();
+    } else {
+      _mm_pause();
+    }
+  }
+  return request.commit_time_;
+}
+
+void TransactionManager::ProcessCommitBatch(CommitRequest *batch) {
+  // Restore arrival order, so that commit timestamps follow the order in which transactions asked for them
+  CommitRequest *ordered = nullptr;
+  uint64_t batch_size = 0;
+  while (batch != nullptr) {
+    CommitRequest *const next = batch->next_;
+    batch->next_ = ordered;
+    ordered = batch;
+    batch = next;
+    batch_size++;
+  }
+
+  // The same reasoning as in UpdatingCommitCriticalSection applies to the whole batch
+  common::Gate::ScopedLock gate(&txn_gate_);
+  timestamp_t commit_time = timestamp_manager_->CheckOutTimestamps(batch_size);
+  while (ordered != nullptr) {
+    // The request lives on its committing thread's stack and is gone as soon as it is marked done
+    CommitRequest *const next = ordered->next_;
+    if (ordered->txn_->IsSerializable()) ssi_manager_.SetCommitTime(ordered->txn_, commit_time);
+    StampCommit(ordered->txn_, commit_time);
+    ordered->commit_time_ = commit_time++;
+    ordered->done_.store(true, std::memory_order_release);
+    ordered = next;
+  }
+}
+
 timestamp_t TransactionManager::Commit(TransactionContext *const txn, transaction::callback_fn callback,
                                        void *callback_arg) {
+  txn->MergeWorkerWrites();
+  if (txn->IsSerializable() && !ssi_manager_.Validate(txn)) {
+    // The transaction is the pivot of a dangerous structure, or was doomed to break one
+    Abort(txn);
+    callback(callback_arg);
+    return INVALID_TXN_TIMESTAMP;
+  }
+
   timestamp_t result;
   const bool txn_metrics_enabled =
       common::thread_context.metrics_store_ != nullptr &&
@@ -119,7 +195,20 @@ timestamp_t TransactionManager::Commit(TransactionContext *const txn, transactio
       !txn->must_abort_,
       "This txn was marked that it must abort. Set a breakpoint at TransactionContext::MustAbort() to see a "
       "stack trace for when this flag is getting tripped.");
-  result = txn->IsReadOnly() ? timestamp_manager_->CheckOutTimestamp() : UpdatingCommitCriticalSection(txn);
+  if (txn->IsDeclaredReadOnly()) {
+    // A transaction that promised not to write has no use for a commit timestamp
+    NOISEPAGE_ASSERT(txn->IsReadOnly(), "A transaction declared read-only cannot write.");
+    result = txn->StartTime();
+    // SSI still needs a unique point in time at which the transaction finished
+    if (txn->IsSerializable()) ssi_manager_.SetCommitTime(txn, timestamp_manager_->CheckOutTimestamp());
+  } else if (commit_batching_) {
+    result = BatchedCommitCriticalSection(txn);
+  } else if (txn->IsReadOnly()) {
+    result = timestamp_manager_->CheckOutTimestamp();
+    if (txn->IsSerializable()) ssi_manager_.SetCommitTime(txn, result);
+  } else {
+    result = UpdatingCommitCriticalSection(txn);
+  }
 
   txn->finish_time_.store(result);
 
@@ -157,7 +246,13 @@ timestamp_t TransactionManager::Commit(TransactionContext *const txn, transactio
     // See docs/design_replication.md for more details.
     oldest_active_txn = timestamp_manager_->CachedOldestTransactionStartTime();
   }
-  LogCommit(txn, result, callback, callback_arg, oldest_active_txn);
+  if (txn->IsDeclaredReadOnly()) {
+    // There is nothing to log, so the transaction leaves the running transactions right away
+    timestamp_manager_->RemoveTransaction(txn->StartTime());
+    callback(callback_arg);
+  } else {
+    LogCommit(txn, result, callback, callback_arg, oldest_active_txn);
+  }
 
   // We hand off txn to GC, however, it won't be GC'd until the LogManager marks it as serialized
   if (gc_enabled_) {
@@ -203,6 +298,13 @@ void TransactionManager::LogAbort(TransactionContext *const txn) {
 }
 
 timestamp_t TransactionManager::Abort(TransactionContext *const txn) {
+  // A parallel pipeline that failed leaves the writes of its workers behind. Their last updates are checked the same
+  // way as the transaction's own further down, while the redo records that hold them are still around.
+  for (const auto &buffers : txn->worker_buffers_) {
+    GCLastUpdateOnAbort(txn, buffers->redo_buffer_, buffers->undo_buffer_);
+  }
+  txn->MergeWorkerWrites(false);
+
   // Immediately clear the abort actions stack
   while (!txn->abort_actions_.empty()) {
     NOISEPAGE_ASSERT(deferred_action_manager_ != DISABLED, "No deferred action manager exists to process actions");
@@ -229,10 +331,11 @@ timestamp_t TransactionManager::Abort(TransactionContext *const txn) {
   for (auto &it : txn->undo_buffer_) it.Timestamp().store(abort_time);
   txn->finish_time_.store(abort_time);
   txn->aborted_ = true;
+  if (txn->IsSerializable()) ssi_manager_.Abort(txn);
 
   // The last update might not have been installed, and thus Rollback would miss it if it contains a
   // varlen entry whose memory content needs to be freed. We have to check for this case manually.
-  GCLastUpdateOnAbort(txn);
+  GCLastUpdateOnAbort(txn, txn->redo_buffer_, txn->undo_buffer_);
 
   LogAbort(txn);
 
@@ -248,9 +351,10 @@ timestamp_t TransactionManager::Abort(TransactionContext *const txn) {
   return abort_time;
 }
 
-void TransactionManager::GCLastUpdateOnAbort(TransactionContext *const txn) {
-  auto *last_log_record = reinterpret_cast<storage::LogRecord *>(txn->redo_buffer_.LastRecord());
-  auto *last_undo_record = reinterpret_cast<storage::UndoRecord *>(txn->undo_buffer_.LastRecord());
+void TransactionManager::GCLastUpdateOnAbort(TransactionContext *const txn, const storage::RedoBuffer &redo_buffer,
+                                             const storage::UndoBuffer &undo_buffer) {
+  auto *last_log_record = reinterpret_cast<storage::LogRecord *>(redo_buffer.LastRecord());
+  auto *last_undo_record = reinterpret_cast<storage::UndoRecord *>(undo_buffer.LastRecord());
   // It is possible that there is nothing to do here, because we aborted for reasons other than a
   // write-write conflict (client calling abort, validation phase failure, etc.). We can
   // tell whether a write-write conflict happened by checking the last entry of the undo to see
@@ -263,8 +367,8 @@ void TransactionManager::GCLastUpdateOnAbort(TransactionContext *const txn) {
   // Last update can potentially contain a varlen that needs to be gc-ed. We now need to check if it
   // was installed or not.
   auto *redo = last_log_record->GetUnderlyingRecordBodyAs<storage::RedoRecord>();
-  NOISEPAGE_ASSERT(redo->GetTupleSlot() == last_undo_record->Slot(),
-                   "Last undo record and redo record must correspond to each other");
+  // An update that was coalesced into an earlier undo record of the tuple has none of its own, and was installed
+  if (redo->GetTupleSlot() != last_undo_record->Slot()) return;
   if (last_undo_record->Table() != nullptr) return;  // the update was installed and will be handled by the GC
 
   // We need to free any varlen memory in the last update if the code reaches here
@@ -321,6 +425,9 @@ void TransactionManager::Rollback(TransactionContext *txn, const storage::UndoRe
       case storage::DeltaRecordType::DELETE:
         accessor.SetNotNull(slot, storage::VERSION_POINTER_COLUMN_ID);
         break;
+      case storage::DeltaRecordType::LOCK:
+        // Nothing was changed
+        break;
       default:
         throw std::runtime_error("unexpected delta record type");
     }
@@ -5,6 +5,7 @@
 #include "binder/bind_node_visitor.h"
 #include "catalog/catalog.h"
 #include "catalog/postgres/pg_proc.h"
+#include "common/constants.h"
 #include "loggers/binder_logger.h"
 #include "main/db_main.h"
 #include "parser/expression/aggregate_expression.h"
@@ -862,6 +863,17 @@ TEST_F(BinderCorrectnessTest, CreateTableSimpleForeignViolateTest) {
   EXPECT_THROW(binder_->BindNameToNode(common::ManagedPointer(parse_tree), nullptr, nullptr), BinderException);
 }
 
+// NOLINTNEXTLINE
+TEST_F(BinderCorrectnessTest, CreateTableTooManyColumnsTest) {
+  BINDER_LOG_DEBUG("Checking create table with more columns than a block can hold");
+
+  std::string create_sql = "CREATE TABLE D (D0 int";
+  for (uint32_t i = 1; i <= common::Constants::MAX_COL; i++) create_sql += ", D" + std::to_string(i) + " int";
+  create_sql += ");";
+  auto parse_tree = parser::PostgresParser::BuildParseTree(create_sql);
+  EXPECT_THROW(binder_->BindNameToNode(common::ManagedPointer(parse_tree), nullptr, nullptr), BinderException);
+}
+
 // NOLINTNEXTLINE
 TEST_F(BinderCorrectnessTest, CreateIndexTest) {
   BINDER_LOG_DEBUG("Checking create index");
@@ -871,6 +883,24 @@ TEST_F(BinderCorrectnessTest, CreateIndexTest) {
   binder_->BindNameToNode(common::ManagedPointer(parse_tree), nullptr, nullptr);
 }
 
+// NOLINTNEXTLINE
+TEST_F(BinderCorrectnessTest, CreateArtIndexDecimalKeyTest) {
+  BINDER_LOG_DEBUG("Checking create ART index on a DECIMAL column");
+
+  std::vector<catalog::Schema::Column> cols_d;
+  cols_d.emplace_back("d1", type::TypeId::DECIMAL, true, parser::ConstantValueExpression(type::TypeId::DECIMAL));
+  cols_d.emplace_back("d2", type::TypeId::INTEGER, true, parser::ConstantValueExpression(type::TypeId::INTEGER));
+  EXPECT_NE(accessor_->CreateTable(accessor_->GetDefaultNamespace(), "d", catalog::Schema(cols_d)),
+            catalog::INVALID_TABLE_OID);
+
+  auto parse_tree = parser::PostgresParser::BuildParseTree("CREATE INDEX idx_d ON d USING art (d2, d1);");
+  EXPECT_THROW(binder_->BindNameToNode(common::ManagedPointer(parse_tree), nullptr, nullptr), BinderException);
+  parse_tree = parser::PostgresParser::BuildParseTree("CREATE INDEX idx_d ON d USING art (d2);");
+  binder_->BindNameToNode(common::ManagedPointer(parse_tree), nullptr, nullptr);
+  parse_tree = parser::PostgresParser::BuildParseTree("CREATE INDEX idx_d ON d (d1);");
+  binder_->BindNameToNode(common::ManagedPointer(parse_tree), nullptr, nullptr);
+}
+
 // NOLINTNEXTLINE
 TEST_F(BinderCorrectnessTest, CreateTriggerTest) {
   BINDER_LOG_DEBUG("Checking create trigger");
@@ -7,12 +7,14 @@
 #include <vector>
 
 #include "catalog/catalog_accessor.h"
+#include "catalog/catalog_cache.h"
 #include "catalog/catalog_defs.h"
 #include "catalog/database_catalog.h"
 #include "catalog/postgres/pg_namespace.h"
 #include "execution/functions/function_context.h"
 #include "main/db_main.h"
 #include "parser/expression/column_value_expression.h"
+#include "parser/expression/comparison_expression.h"
 #include "parser/expression/constant_value_expression.h"
 #include "storage/index/index_builder.h"
 #include "storage/sql_table.h"
@@ -351,6 +353,224 @@ TEST_F(CatalogTests, UserIndexTest) {
   txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
 }
 
+/*
+ * Drop a column from a user table, and check that new tuples leave its storage null.
+ */
+// NOLINTNEXTLINE
+TEST_F(CatalogTests, DropColumnTest) {
+  auto txn = txn_manager_->BeginTransaction();
+  auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, DISABLED);
+  std::vector<catalog::Schema::Column> cols;
+  cols.emplace_back("id", type::TypeId::INTEGER, false, parser::ConstantValueExpression(type::TypeId::INTEGER));
+  cols.emplace_back("user_col_1", type::TypeId::INTEGER, true, parser::ConstantValueExpression(type::TypeId::INTEGER));
+  cols.emplace_back("user_col_2", type::TypeId::INTEGER, false, parser::ConstantValueExpression(type::TypeId::INTEGER));
+  auto table_oid = accessor->CreateTable(accessor->GetDefaultNamespace(), "test_table", catalog::Schema(cols));
+  auto schema = accessor->GetSchema(table_oid);
+  auto table = new storage::SqlTable(db_main_->GetStorageLayer()->GetBlockStore(), schema);
+  EXPECT_TRUE(accessor->SetTablePointer(table_oid, table));
+  std::vector<catalog::IndexSchema::Column> key_cols{catalog::IndexSchema::Column{
+      "id", type::TypeId::INTEGER, false, parser::ColumnValueExpression(db_, table_oid, schema.GetColumn("id").Oid())}};
+  auto index_schema = catalog::IndexSchema(key_cols, storage::index::IndexType::BPLUSTREE, true, true, false, true);
+  EXPECT_NE(accessor->CreateIndex(accessor->GetDefaultNamespace(), table_oid, "test_index", index_schema),
+            catalog::INVALID_INDEX_OID);
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  const catalog::col_oid_t id_oid = schema.GetColumn("id").Oid();
+  const catalog::col_oid_t dropped_oid = schema.GetColumn("user_col_1").Oid();
+  const catalog::col_oid_t kept_oid = schema.GetColumn("user_col_2").Oid();
+
+  // The indexed column cannot be dropped
+  txn = txn_manager_->BeginTransaction();
+  accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, DISABLED);
+  EXPECT_FALSE(accessor->UpdateSchema(table_oid, new catalog::Schema({schema.GetColumn("user_col_1"),
+                                                                       schema.GetColumn("user_col_2")})));
+  txn_manager_->Abort(txn);
+
+  txn = txn_manager_->BeginTransaction();
+  accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, DISABLED);
+  EXPECT_TRUE(
+      accessor->UpdateSchema(table_oid, new catalog::Schema({schema.GetColumn("id"), schema.GetColumn("user_col_2")})));
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // The remaining columns keep their OIDs, and an insert of just them leaves the dropped column null
+  txn = txn_manager_->BeginTransaction();
+  accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, DISABLED);
+  const auto &new_schema = accessor->GetSchema(table_oid);
+  ASSERT_EQ(new_schema.GetColumns().size(), 2);
+  EXPECT_EQ(new_schema.GetColumn("id").Oid(), id_oid);
+  EXPECT_EQ(new_schema.GetColumn("user_col_2").Oid(), kept_oid);
+  const std::vector<catalog::col_oid_t> insert_oids{id_oid, kept_oid};
+  auto *redo = txn->StageWrite(db_, table_oid, table->InitializerForProjectedRow(insert_oids));
+  for (const auto &[oid, offset] : table->ProjectionMapForOids(insert_oids)) {
+    *reinterpret_cast<int32_t *>(redo->Delta()->AccessForceNotNull(offset)) = 42;
+  }
+  const storage::TupleSlot slot = table->Insert(common::ManagedPointer(txn), redo);
+
+  const std::vector<catalog::col_oid_t> all_oids{id_oid, dropped_oid, kept_oid};
+  const auto select_initializer = table->InitializerForProjectedRow(all_oids);
+  auto *buffer = common::AllocationUtil::AllocateAligned(select_initializer.ProjectedRowSize());
+  auto *row = select_initializer.InitializeRow(buffer);
+  EXPECT_TRUE(table->Select(common::ManagedPointer(txn), slot, row));
+  for (const auto &[oid, offset] : table->ProjectionMapForOids(all_oids)) {
+    EXPECT_EQ(row->IsNull(offset), oid == dropped_oid);
+  }
+  delete[] buffer;
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+/*
+ * Check that transactions sharing the CatalogCache see the catalog as of when they started, and a DDL change of their
+ * own right away.
+ */
+// NOLINTNEXTLINE
+TEST_F(CatalogTests, CatalogCacheTest) {
+  catalog::CatalogCache cache;
+  auto txn = txn_manager_->BeginTransaction();
+  auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, common::ManagedPointer(&cache));
+
+  std::vector<catalog::Schema::Column> cols;
+  cols.emplace_back("id", type::TypeId::INTEGER, false, parser::ConstantValueExpression(type::TypeId::INTEGER));
+  auto table_oid = accessor->CreateTable(accessor->GetDefaultNamespace(), "test_table", catalog::Schema(cols));
+  const auto &schema = accessor->GetSchema(table_oid);
+  auto table = new storage::SqlTable(db_main_->GetStorageLayer()->GetBlockStore(), schema);
+  EXPECT_TRUE(accessor->SetTablePointer(table_oid, table));
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // Both txns share the cached lookups of the catalog as of the CREATE TABLE
+  auto *old_txn = txn_manager_->BeginTransaction();
+  auto old_accessor = catalog_->GetAccessor(common::ManagedPointer(old_txn), db_, common::ManagedPointer(&cache));
+  EXPECT_TRUE(old_accessor->GetIndexOids(table_oid).empty());
+  EXPECT_EQ(common::ManagedPointer(table), old_accessor->GetTable(table_oid));
+
+  txn = txn_manager_->BeginTransaction();
+  accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, common::ManagedPointer(&cache));
+  EXPECT_TRUE(accessor->GetIndexOids(table_oid).empty());
+  EXPECT_EQ(&old_accessor->GetSchema(table_oid), &accessor->GetSchema(table_oid));
+
+  // The txn that creates an index sees it, even though it looked the indexes up in the cache before
+  std::vector<catalog::IndexSchema::Column> key_cols{catalog::IndexSchema::Column{
+      "id", type::TypeId::INTEGER, false, parser::ColumnValueExpression(db_, table_oid, schema.GetColumn("id").Oid())}};
+  auto index_schema = catalog::IndexSchema(key_cols, storage::index::IndexType::BPLUSTREE, true, true, false, true);
+  auto idx_oid = accessor->CreateIndex(accessor->GetDefaultNamespace(), table_oid, "test_index", index_schema);
+  EXPECT_NE(idx_oid, catalog::INVALID_INDEX_OID);
+  storage::index::IndexBuilder index_builder;
+  index_builder.SetKeySchema(accessor->GetIndexSchema(idx_oid));
+  EXPECT_TRUE(accessor->SetIndexPointer(idx_oid, index_builder.Build()));
+  EXPECT_EQ(accessor->GetIndexOids(table_oid), std::vector<catalog::index_oid_t>{idx_oid});
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // A txn that started before the CREATE INDEX committed still doesn't see it, but the next one does
+  EXPECT_TRUE(old_accessor->GetIndexOids(table_oid).empty());
+  txn_manager_->Commit(old_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  txn = txn_manager_->BeginTransaction();
+  accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, common::ManagedPointer(&cache));
+  EXPECT_EQ(accessor->GetIndexOids(table_oid), std::vector<catalog::index_oid_t>{idx_oid});
+  EXPECT_NE(accessor->GetIndex(idx_oid), nullptr);
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+/*
+ * Publish an index as invalid, mark it valid later, and check that the validity is versioned like the rest of pg_index.
+ */
+// NOLINTNEXTLINE
+TEST_F(CatalogTests, IndexValidTest) {
+  catalog::CatalogCache cache;
+  auto txn = txn_manager_->BeginTransaction();
+  auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, common::ManagedPointer(&cache));
+
+  std::vector<catalog::Schema::Column> cols;
+  cols.emplace_back("id", type::TypeId::INTEGER, false, parser::ConstantValueExpression(type::TypeId::INTEGER));
+  auto table_oid = accessor->CreateTable(accessor->GetDefaultNamespace(), "test_table", catalog::Schema(cols));
+  const auto &schema = accessor->GetSchema(table_oid);
+  EXPECT_TRUE(accessor->SetTablePointer(
+      table_oid, new storage::SqlTable(db_main_->GetStorageLayer()->GetBlockStore(), schema)));
+  std::vector<catalog::IndexSchema::Column> key_cols{catalog::IndexSchema::Column{
+      "id", type::TypeId::INTEGER, false, parser::ColumnValueExpression(db_, table_oid, schema.GetColumn("id").Oid())}};
+  auto index_schema = catalog::IndexSchema(key_cols, storage::index::IndexType::BPLUSTREE, true, true, false, true);
+  auto idx_oid = accessor->CreateIndex(accessor->GetDefaultNamespace(), table_oid, "test_index", index_schema);
+  EXPECT_NE(idx_oid, catalog::INVALID_INDEX_OID);
+  storage::index::IndexBuilder index_builder;
+  index_builder.SetKeySchema(accessor->GetIndexSchema(idx_oid));
+  EXPECT_TRUE(accessor->SetIndexPointer(idx_oid, index_builder.Build()));
+  EXPECT_TRUE(accessor->IsIndexValid(idx_oid));
+  EXPECT_TRUE(accessor->SetIndexValid(idx_oid, false));
+  EXPECT_FALSE(accessor->IsIndexValid(idx_oid));
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  auto *old_txn = txn_manager_->BeginTransaction();
+  auto old_accessor = catalog_->GetAccessor(common::ManagedPointer(old_txn), db_, common::ManagedPointer(&cache));
+  EXPECT_FALSE(old_accessor->IsIndexValid(idx_oid));
+
+  txn = txn_manager_->BeginTransaction();
+  accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, common::ManagedPointer(&cache));
+  EXPECT_TRUE(accessor->SetIndexValid(idx_oid, true));
+  EXPECT_TRUE(accessor->IsIndexValid(idx_oid));
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // A txn that started before the index was marked valid keeps planning without it, but the next one uses it
+  EXPECT_FALSE(old_accessor->IsIndexValid(idx_oid));
+  txn_manager_->Commit(old_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  txn = txn_manager_->BeginTransaction();
+  accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, common::ManagedPointer(&cache));
+  EXPECT_TRUE(accessor->IsIndexValid(idx_oid));
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
+/*
+ * Create a partial index and check that its predicate survives the round trip through the catalog.
+ */
+// NOLINTNEXTLINE
+TEST_F(CatalogTests, PartialIndexTest) {
+  auto txn = txn_manager_->BeginTransaction();
+  auto accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_, DISABLED);
+
+  std::vector<catalog::Schema::Column> cols;
+  cols.emplace_back("id", type::TypeId::INTEGER, false, parser::ConstantValueExpression(type::TypeId::INTEGER));
+  cols.emplace_back("user_col_1", type::TypeId::INTEGER, false, parser::ConstantValueExpression(type::TypeId::INTEGER));
+  auto tmp_schema = catalog::Schema(cols);
+
+  auto table_oid = accessor->CreateTable(accessor->GetDefaultNamespace(), "test_table", tmp_schema);
+  auto schema = accessor->GetSchema(table_oid);
+  auto table = new storage::SqlTable(db_main_->GetStorageLayer()->GetBlockStore(), schema);
+  EXPECT_TRUE(accessor->SetTablePointer(table_oid, table));
+
+  // user_col_1 > 5
+  std::vector<std::unique_ptr<parser::AbstractExpression>> children;
+  children.emplace_back(
+      std::make_unique<parser::ColumnValueExpression>(db_, table_oid, schema.GetColumn("user_col_1").Oid()));
+  children.emplace_back(
+      std::make_unique<parser::ConstantValueExpression>(type::TypeId::INTEGER, execution::sql::Integer(5)));
+  parser::ComparisonExpression predicate(parser::ExpressionType::COMPARE_GREATER_THAN, std::move(children));
+
+  std::vector<catalog::IndexSchema::Column> key_cols{catalog::IndexSchema::Column{
+      "id", type::TypeId::INTEGER, false, parser::ColumnValueExpression(db_, table_oid, schema.GetColumn("id").Oid())}};
+  auto index_schema = catalog::IndexSchema(key_cols, storage::index::IndexType::BPLUSTREE, false, false, false, true);
+  index_schema.SetPredicate(predicate.Copy());
+  auto idx_oid = accessor->CreateIndex(accessor->GetDefaultNamespace(), table_oid, "test_table_partial_index",
+                                       index_schema);
+  EXPECT_NE(idx_oid, catalog::INVALID_INDEX_OID);
+
+  const auto &true_schema = accessor->GetIndexSchema(idx_oid);
+  ASSERT_NE(true_schema.Predicate(), nullptr);
+  EXPECT_EQ(*true_schema.Predicate(), predicate);
+
+  // The predicate is also kept through a copy of the schema and through its serialization
+  auto copy = true_schema;
+  ASSERT_NE(copy.Predicate(), nullptr);
+  EXPECT_EQ(*copy.Predicate(), predicate);
+  auto deserialized = catalog::IndexSchema::DeserializeSchema(true_schema.ToJson());
+  ASSERT_NE(deserialized->Predicate(), nullptr);
+  EXPECT_EQ(*deserialized->Predicate(), predicate);
+
+  storage::index::IndexBuilder index_builder;
+  index_builder.SetKeySchema(true_schema);
+  EXPECT_TRUE(accessor->SetIndexPointer(idx_oid, index_builder.Build()));
+
+  EXPECT_TRUE(accessor->DropIndex(idx_oid));
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
 /*
  * Create a user table and index. Drop them both by dropping the table using cascading drop logic.
  */
@@ -0,0 +1,109 @@
+#include "common/big_reader_latch.h"
+
+#include <atomic>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_util/multithread_test_util.h"
+
+namespace noisepage {
+
+// Readers share the latch and exclude a writer, and a writer excludes everyone
+// NOLINTNEXTLINE
+TEST(BigReaderLatchTests, ExclusionTest) {
+  common::BigReaderLatch latch;
+  EXPECT_TRUE(latch.TryLockShared());
+  EXPECT_TRUE(latch.TryLockShared());
+  EXPECT_FALSE(latch.TryExclusiveLock());
+  latch.UnlockShared();
+  EXPECT_FALSE(latch.TryExclusiveLock());
+  latch.UnlockShared();
+
+  EXPECT_TRUE(latch.TryExclusiveLock());
+  EXPECT_FALSE(latch.TryLockShared());
+  EXPECT_FALSE(latch.TryExclusiveLock());
+  latch.UnlockExclusive();
+  EXPECT_TRUE(latch.TryLockShared());
+  latch.UnlockShared();
+
+  // The movable guard works through std::shared_lock
+  {
+    common::BigReaderLatchGuard guard(&latch);
+    EXPECT_FALSE(latch.TryExclusiveLock());
+  }
+  EXPECT_TRUE(latch.TryExclusiveLock());
+  latch.UnlockExclusive();
+}
+
+// A latch that one thread acquired can be released by another, which spreads over different reader slots
+// NOLINTNEXTLINE
+TEST(BigReaderLatchTests, ReleaseOnOtherThreadTest) {
+  common::BigReaderLatch latch;
+  latch.LockShared();
+  std::thread([&] { latch.UnlockShared(); }).join();
+  EXPECT_TRUE(latch.TryExclusiveLock());
+  latch.UnlockExclusive();
+
+  std::thread([&] { latch.LockShared(); }).join();
+  EXPECT_FALSE(latch.TryExclusiveLock());
+  latch.UnlockShared();
+  EXPECT_TRUE(latch.TryExclusiveLock());
+  latch.UnlockExclusive();
+}
+
+// A reader that latches again while a writer waits for it gets in, rather than deadlocking with the writer
+// NOLINTNEXTLINE
+TEST(BigReaderLatchTests, RecursiveReaderTest) {
+  common::BigReaderLatch latch;
+  std::atomic<bool> written = false;
+  latch.LockShared();
+  std::thread writer([&] {
+    common::BigReaderLatch::ScopedExclusiveLatch guard(&latch);
+    written = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  latch.LockShared();
+  EXPECT_FALSE(written.load());
+  latch.UnlockShared();
+  latch.UnlockShared();
+  writer.join();
+  EXPECT_TRUE(written.load());
+}
+
+// Writers never see readers or other writers in the middle of their updates
+// NOLINTNEXTLINE
+TEST(BigReaderLatchTests, ConcurrentTest) {
+  const uint32_t num_threads = MultiThreadTestUtil::HardwareConcurrency() + 2;
+  const uint32_t num_iterations = 10000;
+  common::BigReaderLatch latch;
+  // Writers keep both values equal whenever they release the latch
+  uint64_t first = 0;
+  uint64_t second = 0;
+  std::atomic<uint32_t> num_mismatches = 0;
+
+  std::vector<std::thread> threads;
+  for (uint32_t thread = 0; thread < num_threads; thread++) {
+    threads.emplace_back([&, thread] {
+      for (uint32_t i = 0; i < num_iterations; i++) {
+        if (thread % 4 == 0 && i % 16 == 0) {
+          common::BigReaderLatch::ScopedExclusiveLatch guard(&latch);
+          first++;
+          std::this_thread::yield();
+          second++;
+        } else {
+          common::BigReaderLatch::ScopedSharedLatch guard(&latch);
+          if (first != second) num_mismatches++;
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+
+  EXPECT_EQ(num_mismatches.load(), 0);
+  const uint64_t num_writes = ((num_threads + 3) / 4) * (num_iterations / 16);
+  EXPECT_EQ(first, num_writes);
+  EXPECT_EQ(second, num_writes);
+}
+
+}  // namespace noisepage
@@ -0,0 +1,69 @@
+#include "common/container/chunked_list.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+namespace noisepage {
+
+// Tests that elements come back in the order they were added, across chunks and splices
+// NOLINTNEXTLINE
+TEST(ChunkedListTests, SpliceOrderTest) {
+  const uint32_t num_elements = 3 * common::ChunkedList<std::string>::CHUNK_SIZE + 7;
+  common::ChunkedList<std::string> list, other;
+
+  for (uint32_t i = 0; i < num_elements; i++) {
+    // Every other run of 100 elements goes to the other list first, so that the lists have partial chunks
+    auto *const target = (i / 100) % 2 == 0 ? &list : &other;
+    target->EmplaceBack(std::to_string(i));
+    if (target == &other && (i + 1) % 100 == 0) {
+      list.Splice(&other);
+      EXPECT_TRUE(other.Empty());
+    }
+  }
+  list.Splice(&other);
+
+  EXPECT_EQ(list.Size(), num_elements);
+  uint32_t num_seen = 0;
+  for (const auto &element : list) {
+    EXPECT_EQ(element, std::to_string(num_seen));
+    num_seen++;
+  }
+  EXPECT_EQ(num_seen, num_elements);
+
+  const common::ChunkedList<std::string> copy(list);
+  EXPECT_EQ(copy.Size(), num_elements);
+  EXPECT_EQ(*copy.begin(), "0");
+
+  list.Clear();
+  EXPECT_TRUE(list.Empty());
+  EXPECT_TRUE(list.begin() == list.end());
+  EXPECT_EQ(copy.Size(), num_elements);
+}
+
+// Tests that every element is destroyed exactly once, whether the list is cleared, moved or destroyed
+// NOLINTNEXTLINE
+TEST(ChunkedListTests, DestructionTest) {
+  auto counter = std::make_shared<int>(0);
+  {
+    common::ChunkedList<std::shared_ptr<int>> list;
+    for (uint32_t i = 0; i < 2 * common::ChunkedList<std::shared_ptr<int>>::CHUNK_SIZE + 1; i++) {
+      list.EmplaceBack(counter);
+    }
+    EXPECT_EQ(counter.use_count(), list.Size() + 1);
+
+    common::ChunkedList<std::shared_ptr<int>> moved(std::move(list));
+    EXPECT_EQ(counter.use_count(), moved.Size() + 1);
+    moved.EmplaceBack(counter);
+    moved.Clear();
+    EXPECT_EQ(counter.use_count(), 1);
+
+    moved.EmplaceBack(counter);
+    EXPECT_EQ(counter.use_count(), 2);
+  }
+  EXPECT_EQ(counter.use_count(), 1);
+}
+
+}  // namespace noisepage
@@ -49,6 +49,65 @@ TEST(ConcurrentBitmapTests, SimpleCorrectnessTest) {
     common::RawConcurrentBitmap::Deallocate(bitmap);
   }
 }
+
+// Counting the set bits agrees with a reference count, for sizes that do not end on a byte boundary too
+// NOLINTNEXTLINE
+TEST(ConcurrentBitmapTests, NumSetTest) {
+  std::default_random_engine generator;
+  const uint32_t num_bitmap_sizes = 50;
+  const uint32_t max_bitmap_size = 1000;
+
+  for (uint32_t iter = 0; iter < num_bitmap_sizes; ++iter) {
+    auto num_elements = std::uniform_int_distribution(1U, max_bitmap_size)(generator);
+    common::RawConcurrentBitmap *bitmap = common::RawConcurrentBitmap::Allocate(num_elements);
+    EXPECT_EQ(bitmap->NumSet(num_elements), 0);
+
+    uint32_t expected = 0;
+    for (uint32_t i = 0; i < num_elements; ++i) {
+      if (std::uniform_int_distribution(0, 1)(generator) == 0) continue;
+      bitmap->Flip(i, false);
+      expected++;
+    }
+    EXPECT_EQ(bitmap->NumSet(num_elements), expected);
+    common::RawConcurrentBitmap::Deallocate(bitmap);
+  }
+}
+
+// Setting a range agrees with flipping its bits one at a time, and the wide search agrees with FirstUnsetPos
+// NOLINTNEXTLINE
+TEST(ConcurrentBitmapTests, SetRangeAndFirstUnsetPosWideTest) {
+  std::default_random_engine generator;
+  const uint32_t num_iterations = 200;
+  const uint32_t max_bitmap_size = 3000;
+
+  for (uint32_t iter = 0; iter < num_iterations; ++iter) {
+    const auto num_elements = std::uniform_int_distribution(1U, max_bitmap_size)(generator);
+    common::RawConcurrentBitmap *bitmap = common::RawConcurrentBitmap::Allocate(num_elements);
+    std::vector<bool> expected(num_elements, false);
+
+    // Mostly long runs, so that the search has whole words and SIMD lanes to skip. Every range is unset before.
+    for (uint32_t i = 0; i < 10; i++) {
+      const auto start = std::uniform_int_distribution(0U, num_elements - 1)(generator);
+      auto end = std::uniform_int_distribution(start, num_elements)(generator);
+      while (end > start && expected[end - 1]) end--;
+      auto range_start = end;
+      while (range_start > start && !expected[range_start - 1]) range_start--;
+      bitmap->SetRange(range_start, end - range_start);
+      for (uint32_t pos = range_start; pos < end; pos++) expected[pos] = true;
+    }
+    for (uint32_t pos = 0; pos < num_elements; pos++) EXPECT_EQ(bitmap->Test(pos), expected[pos]);
+
+    for (uint32_t i = 0; i < 20; i++) {
+      const auto start = std::uniform_int_distribution(0U, num_elements)(generator);
+      uint32_t pos = 0, wide_pos = 0;
+      const bool found = bitmap->FirstUnsetPos(num_elements, start, &pos);
+      EXPECT_EQ(bitmap->FirstUnsetPosWide(num_elements, start, &wide_pos), found);
+      if (found) EXPECT_EQ(wide_pos, pos);
+    }
+    common::RawConcurrentBitmap::Deallocate(bitmap);
+  }
+}
+
 // The test exercises FirstUnsetPos in a single-threaded context
 // NOLINTNEXTLINE
 TEST(ConcurrentBitmapTests, FirstUnsetPosTest) {
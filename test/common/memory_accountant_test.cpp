@@ -0,0 +1,70 @@
+#include "common/memory_accountant.h"
+
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "storage/varlen_allocator.h"
+
+namespace noisepage {
+
+// Counts of threads are exact once they exited, wherever the memory was freed
+// NOLINTNEXTLINE
+TEST(MemoryAccountantTests, MergeTest) {
+  constexpr auto component = common::MemoryComponent::EXECUTION;
+  const int64_t before = common::MemoryAccountant::GetBytes(component);
+
+  // Below the threshold, the count stays with the thread until it exits
+  std::thread([=] {
+    common::MemoryAccountant::Allocate(component, 100);
+    EXPECT_EQ(common::MemoryAccountant::GetBytes(component), before);
+  }).join();
+  EXPECT_EQ(common::MemoryAccountant::GetBytes(component), before + 100);
+
+  // Above it, the count is merged right away
+  std::thread([=] {
+    common::MemoryAccountant::Allocate(component, common::MemoryAccountant::MERGE_THRESHOLD);
+    EXPECT_EQ(common::MemoryAccountant::GetBytes(component), before + 100 + common::MemoryAccountant::MERGE_THRESHOLD);
+  }).join();
+
+  // Threads free what others allocated
+  std::vector<std::thread> threads;
+  for (uint32_t i = 0; i < 4; i++) {
+    threads.emplace_back([=] {
+      for (uint32_t j = 0; j < 1000; j++) common::MemoryAccountant::Free(component, 100);
+    });
+  }
+  for (auto &thread : threads) thread.join();
+  EXPECT_EQ(common::MemoryAccountant::GetBytes(component),
+            before + 100 + common::MemoryAccountant::MERGE_THRESHOLD - 4 * 1000 * 100);
+
+  std::thread([=] {
+    common::MemoryAccountant::Free(component, 100 + common::MemoryAccountant::MERGE_THRESHOLD - 4 * 1000 * 100);
+  }).join();
+  EXPECT_EQ(common::MemoryAccountant::GetBytes(component), before);
+}
+
+// Varlen contents are counted while they are allocated, whether they come from a size class or not
+// NOLINTNEXTLINE
+TEST(MemoryAccountantTests, VarlenTest) {
+  constexpr auto component = common::MemoryComponent::VARLEN;
+  const int64_t before = common::MemoryAccountant::GetBytes(component);
+
+  std::vector<byte *> contents;
+  std::thread([&] {
+    for (const uint32_t size : {1u, 20u, 4096u, 4097u, 1u << 20}) {
+      contents.push_back(storage::VarlenAllocator::Allocate(size));
+    }
+  }).join();
+  // Contents take at least their size, and the header of a chunk is small
+  const int64_t allocated = common::MemoryAccountant::GetBytes(component) - before;
+  EXPECT_GE(allocated, 1 + 20 + 4096 + 4097 + (1 << 20));
+  EXPECT_LE(allocated, 2 * (1 + 20 + 4096 + 4097 + (1 << 20)));
+
+  std::thread([&] {
+    for (auto *const content : contents) storage::VarlenAllocator::Deallocate(content);
+  }).join();
+  EXPECT_EQ(common::MemoryAccountant::GetBytes(component), before);
+}
+
+}  // namespace noisepage
@@ -69,6 +69,43 @@ TEST(ObjectPoolTests, ResetLimitTest) {
   }
 }
 
+// Objects that a thread releases into its magazine are handed out to other threads once the pool runs out
+// NOLINTNEXTLINE
+TEST(ObjectPoolTests, MagazineTest) {
+  const uint64_t size_limit = 100;
+  const uint64_t reuse_limit = 100000;
+  common::ObjectPool<uint32_t> tested(size_limit, reuse_limit);
+
+  std::unordered_set<uint32_t *> used_ptrs;
+  for (uint64_t i = 0; i < size_limit; i++) used_ptrs.insert(tested.Get());
+  EXPECT_THROW(tested.Get(), common::NoMoreObjectException);
+  for (auto *ptr : used_ptrs) tested.Release(ptr);
+
+  // The same thread gets back what it released last first
+  uint32_t *first = tested.Get();
+  uint32_t *second = tested.Get();
+  tested.Release(first);
+  tested.Release(second);
+  EXPECT_EQ(tested.Get(), second);
+  EXPECT_EQ(tested.Get(), first);
+  tested.Release(first);
+  tested.Release(second);
+
+  // Another thread gets every object, wherever it is cached, and nothing more
+  std::thread other([&] {
+    std::unordered_set<uint32_t *> ptrs;
+    for (uint64_t i = 0; i < size_limit; i++) ptrs.insert(tested.Get());
+    EXPECT_EQ(ptrs, used_ptrs);
+    EXPECT_THROW(tested.Get(), common::NoMoreObjectException);
+    for (auto *ptr : ptrs) tested.Release(ptr);
+  });
+  other.join();
+
+  // A small reuse limit frees the cached objects
+  tested.SetReuseLimit(0);
+  EXPECT_TRUE(tested.SetSizeLimit(0));
+}
+
 class ObjectPoolTestType {
  public:
   ObjectPoolTestType *Use(uint32_t thread_id) {
@@ -0,0 +1,70 @@
+#include "common/thread_placement.h"
+
+#include <sched.h>
+
+#include <algorithm>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "common/error/exception.h"
+#include "gtest/gtest.h"
+
+namespace noisepage {
+
+// NOLINTNEXTLINE
+TEST(ThreadPlacementTests, ParseCpuListTest) {
+  EXPECT_TRUE(common::ThreadPlacement::ParseCpuList("").empty());
+  EXPECT_EQ(common::ThreadPlacement::ParseCpuList("3"), std::vector<uint32_t>({3}));
+  EXPECT_EQ(common::ThreadPlacement::ParseCpuList("8, 0-3,2"), std::vector<uint32_t>({0, 1, 2, 3, 8}));
+  // Every machine has a node 0, which is the only one on machines without NUMA nodes
+  EXPECT_NO_THROW(common::ThreadPlacement::ParseCpuList("node0"));
+
+  EXPECT_THROW(common::ThreadPlacement::ParseCpuList("a"), SettingsException);
+  EXPECT_THROW(common::ThreadPlacement::ParseCpuList("3-1"), SettingsException);
+  EXPECT_THROW(common::ThreadPlacement::ParseCpuList("1-"), SettingsException);
+  EXPECT_THROW(common::ThreadPlacement::ParseCpuList("node100000"), SettingsException);
+}
+
+// Roles without CPUs of their own stay off the CPUs of isolated roles
+// NOLINTNEXTLINE
+TEST(ThreadPlacementTests, IsolationTest) {
+  common::ThreadPlacement placement;
+  EXPECT_FALSE(placement.IsEnabled());
+  EXPECT_TRUE(placement.CpusOf(common::ThreadRole::WAL).empty());
+  EXPECT_TRUE(placement.CpusOf(common::ThreadRole::OTHER).empty());
+
+  placement.SetPolicy(common::ThreadRole::WAL, {{0}, false, false});
+  EXPECT_TRUE(placement.IsEnabled());
+  EXPECT_EQ(placement.CpusOf(common::ThreadRole::WAL), std::vector<uint32_t>({0}));
+  const std::vector<uint32_t> all_cpus = placement.CpusOf(common::ThreadRole::OTHER);
+  EXPECT_FALSE(all_cpus.empty());
+
+  placement.SetPolicy(common::ThreadRole::WAL, {{0}, true, false});
+  const std::vector<uint32_t> other_cpus = placement.CpusOf(common::ThreadRole::OTHER);
+  if (all_cpus.size() > 1) {
+    EXPECT_EQ(other_cpus.size(), all_cpus.size() - 1);
+    EXPECT_EQ(std::find(other_cpus.begin(), other_cpus.end(), 0), other_cpus.end());
+  } else {
+    // The isolated role took every CPU, so the other roles share it
+    EXPECT_EQ(other_cpus, all_cpus);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST(ThreadPlacementTests, ApplyTest) {
+  common::ThreadPlacement placement;
+  const uint32_t cpu = std::max(sched_getcpu(), 0);
+  placement.SetPolicy(common::ThreadRole::NETWORK, {{cpu}, false, false});
+
+  std::thread thread([&] {
+    placement.Apply(common::ThreadRole::NETWORK);
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    ASSERT_EQ(sched_getaffinity(0, sizeof(set), &set), 0);
+    EXPECT_EQ(CPU_COUNT(&set), 1);
+    EXPECT_TRUE(CPU_ISSET(cpu, &set));
+  });
+  thread.join();
+}
+
+}  // namespace noisepage
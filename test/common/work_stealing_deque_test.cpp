@@ -0,0 +1,65 @@
+#include "common/container/work_stealing_deque.h"
+
+#include <atomic>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_util/multithread_test_util.h"
+
+namespace noisepage {
+
+// The owner pops in LIFO order and thieves steal in FIFO order, across growing the deque
+// NOLINTNEXTLINE
+TEST(WorkStealingDequeTests, OrderTest) {
+  common::WorkStealingDeque<uint32_t> deque(1);
+  std::vector<uint32_t> values(100);
+  EXPECT_TRUE(deque.Empty());
+  EXPECT_EQ(deque.Pop(), nullptr);
+  EXPECT_EQ(deque.Steal(), nullptr);
+
+  for (uint32_t i = 0; i < values.size(); i++) {
+    values[i] = i;
+    deque.Push(&values[i]);
+  }
+  EXPECT_FALSE(deque.Empty());
+  for (uint32_t i = 0; i < values.size() / 2; i++) EXPECT_EQ(*deque.Steal(), i);
+  for (uint32_t i = values.size(); i > values.size() / 2; i--) EXPECT_EQ(*deque.Pop(), i - 1);
+  EXPECT_TRUE(deque.Empty());
+  EXPECT_EQ(deque.Pop(), nullptr);
+}
+
+// Every element is taken exactly once while the owner pushes and pops and other threads steal at the same time
+// NOLINTNEXTLINE
+TEST(WorkStealingDequeTests, ConcurrentStealTest) {
+  const uint32_t num_thieves = MultiThreadTestUtil::HardwareConcurrency();
+  const uint32_t num_values = 100000;
+  common::WorkStealingDeque<uint32_t> deque(2);
+  std::vector<uint32_t> values(num_values);
+  std::vector<std::atomic<uint32_t>> taken(num_values);
+  std::atomic<bool> done(false);
+
+  std::vector<std::thread> thieves;
+  for (uint32_t i = 0; i < num_thieves; i++) {
+    thieves.emplace_back([&] {
+      while (!done.load() || !deque.Empty()) {
+        if (auto *value = deque.Steal(); value != nullptr) taken[*value].fetch_add(1);
+      }
+    });
+  }
+
+  for (uint32_t i = 0; i < num_values; i++) {
+    values[i] = i;
+    deque.Push(&values[i]);
+    if (i % 3 == 0) {
+      if (auto *value = deque.Pop(); value != nullptr) taken[*value].fetch_add(1);
+    }
+  }
+  while (auto *value = deque.Pop()) taken[*value].fetch_add(1);
+  done.store(true);
+  for (auto &thief : thieves) thief.join();
+
+  for (uint32_t i = 0; i < num_values; i++) EXPECT_EQ(taken[i].load(), 1) << i;
+}
+
+}  // namespace noisepage
@@ -74,4 +74,47 @@ TEST(WorkerPoolTests, MoreTest) {
   }
   thread_pool.Shutdown();
 }
+
+// Tasks that the workers submit themselves are waited on too, whether they run on the worker or are stolen
+// NOLINTNEXTLINE
+TEST(WorkerPoolTests, NestedSubmitTest) {
+  common::WorkerPool thread_pool(4, {});
+  thread_pool.Startup();
+  std::atomic<uint32_t> counter(0);
+
+  const uint32_t num_tasks = 100;
+  const uint32_t num_nested_tasks = 10;
+  for (uint32_t round = 1; round <= 10; round++) {
+    for (uint32_t i = 0; i < num_tasks; i++) {
+      thread_pool.SubmitTask([&] {
+        for (uint32_t j = 0; j < num_nested_tasks; j++) thread_pool.SubmitTask([&] { counter.fetch_add(1); });
+        counter.fetch_add(1);
+      });
+    }
+    thread_pool.WaitUntilAllFinished();
+    EXPECT_EQ(counter.load(), round * num_tasks * (num_nested_tasks + 1));
+  }
+  thread_pool.Shutdown();
+}
+
+// The tasks that the pool is created with run once it starts, and it runs tasks again after a restart
+// NOLINTNEXTLINE
+TEST(WorkerPoolTests, RestartTest) {
+  std::atomic<uint32_t> counter(0);
+  common::TaskQueue tasks;
+  for (uint32_t i = 0; i < 10; i++) tasks.emplace([&] { counter.fetch_add(1); });
+  common::WorkerPool thread_pool(2, std::move(tasks));
+
+  thread_pool.Startup();
+  thread_pool.WaitUntilAllFinished();
+  EXPECT_EQ(counter.load(), 10);
+  thread_pool.Shutdown();
+
+  thread_pool.SetNumWorkers(3);
+  thread_pool.Startup();
+  for (uint32_t i = 0; i < 10; i++) thread_pool.SubmitTask([&] { counter.fetch_add(1); });
+  thread_pool.WaitUntilAllFinished();
+  EXPECT_EQ(counter.load(), 20);
+  thread_pool.Shutdown();
+}
 }  // namespace noisepage
@@ -200,6 +200,93 @@ TEST_F(CompilerTest, SimpleSeqScanTest) {
   EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec, exp_vec));
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, ProfiledSeqScanTest) {
+  // SELECT colA FROM test_1 WHERE colA < 500, profiled for EXPLAIN ANALYZE
+  auto accessor = MakeAccessor();
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  ExpressionMaker expr_maker;
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
+  {
+    auto cola_oid = table_schema.GetColumn("colA").Oid();
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    seq_scan_out.AddOutput("col1", common::ManagedPointer(col1));
+    auto schema = seq_scan_out.MakeSchema();
+    auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(500));
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan = builder.SetOutputSchema(std::move(schema))
+                   .SetColumnOids({cola_oid})
+                   .SetScanPredicate(predicate)
+                   .SetIsForUpdateFlag(false)
+                   .SetTableOid(table_oid)
+                   .SetPlanNodeId(planner::plan_node_id_t(7))
+                   .Build();
+  }
+
+  uint64_t num_output_rows = 0;
+  exec::OutputCallback callback_fn = [&](byte *, uint32_t num_tuples, uint32_t) { num_output_rows += num_tuples; };
+  SetProfilingEnabled(true);
+  auto exec_ctx = MakeExecCtx(&callback_fn, seq_scan->GetOutputSchema().Get());
+  SetProfilingEnabled(false);
+
+  auto executable = execution::compiler::CompilationContext::Compile(*seq_scan, exec_ctx->GetExecutionSettings(),
+                                                                     exec_ctx->GetAccessor());
+  executable->Run(common::ManagedPointer(exec_ctx), MODE);
+
+  // The scan produced every row that was output, all in the only pipeline
+  const auto *profile = exec_ctx->GetQueryProfile();
+  ASSERT_NE(nullptr, profile);
+  EXPECT_EQ(500u, num_output_rows);
+  const auto *scan_profile = profile->GetOperatorProfile(planner::plan_node_id_t(7));
+  ASSERT_NE(nullptr, scan_profile);
+  EXPECT_EQ(num_output_rows, scan_profile->rows_);
+  ASSERT_EQ(1u, scan_profile->pipelines_.size());
+  ASSERT_EQ(1u, profile->GetPipelineIds().size());
+  EXPECT_EQ(scan_profile->pipelines_[0], profile->GetPipelineIds()[0]);
+  EXPECT_LT(0u, profile->GetPipelineProfile(scan_profile->pipelines_[0])->cycles_);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, CanceledSeqScanTest) {
+  // SELECT colA FROM test_1, from a query that was canceled
+  auto accessor = MakeAccessor();
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  ExpressionMaker expr_maker;
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan;
+  OutputSchemaHelper seq_scan_out{0, &expr_maker};
+  {
+    auto cola_oid = table_schema.GetColumn("colA").Oid();
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    seq_scan_out.AddOutput("col1", common::ManagedPointer(col1));
+    auto schema = seq_scan_out.MakeSchema();
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan = builder.SetOutputSchema(std::move(schema))
+                   .SetColumnOids({cola_oid})
+                   .SetIsForUpdateFlag(false)
+                   .SetTableOid(table_oid)
+                   .Build();
+  }
+
+  uint64_t num_output_rows = 0;
+  exec::OutputCallback callback_fn = [&](byte *, uint32_t num_tuples, uint32_t) { num_output_rows += num_tuples; };
+  auto exec_ctx = MakeExecCtx(&callback_fn, seq_scan->GetOutputSchema().Get());
+  auto executable = execution::compiler::CompilationContext::Compile(*seq_scan, exec_ctx->GetExecutionSettings(),
+                                                                     exec_ctx->GetAccessor());
+
+  // The scan stops before it reads its first vector
+  exec_ctx->Cancel();
+  try {
+    executable->Run(common::ManagedPointer(exec_ctx), MODE);
+    FAIL();
+  } catch (const ExecutionException &e) {
+    EXPECT_EQ(common::ErrorCode::ERRCODE_QUERY_CANCELED, e.code_);
+  }
+  EXPECT_EQ(0u, num_output_rows);
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SimpleSeqScanNonVecFilterTest) {
   // SELECT col1, col2, col1 * col2, col1 >= 100*col2 FROM test_1
@@ -499,6 +586,54 @@ TEST_F(CompilerTest, SimpleIndexScanTest) {
   EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec, exp_vec));
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, SimpleIndexOnlyScanTest) {
+  // SELECT colA FROM test_1 WHERE colA = 500;
+  // index_1 is on colA, so the scan reads colA from the key instead of the table
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto index_oid = accessor->GetIndexOid(NSOid(), "index_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  std::unique_ptr<planner::AbstractPlanNode> index_scan;
+  OutputSchemaHelper index_scan_out{0, &expr_maker};
+  {
+    // OIDs
+    auto cola_oid = table_schema.GetColumn("colA").Oid();
+    // Get Table columns
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    auto const_500 = expr_maker.Constant(500);
+    index_scan_out.AddOutput("col1", col1);
+    auto schema = index_scan_out.MakeSchema();
+    planner::IndexScanPlanNode::Builder builder;
+    index_scan = builder.SetTableOid(table_oid)
+                     .SetColumnOids({cola_oid})
+                     .SetIndexOid(index_oid)
+                     .AddIndexColumn(catalog::indexkeycol_oid_t(1), const_500)
+                     .SetOutputSchema(std::move(schema))
+                     .SetScanType(planner::IndexScanType::Exact)
+                     .SetScanLimit(0)
+                     .SetScanPredicate(nullptr)
+                     .SetIndexOnly(true)
+                     .Build();
+  }
+  NumChecker num_checker(1);
+  SingleIntComparisonChecker col1_checker(std::equal_to<>(), 0, 500);
+  MultiChecker multi_checker{std::vector<OutputChecker *>{&col1_checker, &num_checker}};
+  // Create the execution context
+  OutputStore store{&multi_checker, index_scan->GetOutputSchema().Get()};
+  exec::OutputPrinter printer(index_scan->GetOutputSchema().Get());
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+  exec::OutputCallback callback_fn = callback.ConstructOutputCallback();
+  auto exec_ctx = MakeExecCtx(&callback_fn, index_scan->GetOutputSchema().Get());
+
+  // Run & Check
+  auto executable = execution::compiler::CompilationContext::Compile(*index_scan, exec_ctx->GetExecutionSettings(),
+                                                                     exec_ctx->GetAccessor());
+  executable->Run(common::ManagedPointer(exec_ctx), MODE);
+  multi_checker.CheckCorrectness();
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SimpleIndexScanAscendingTest) {
   // SELECT colA, colB FROM test_1 WHERE colA BETWEEN 495 AND 505 ORDER BY colA;
@@ -1538,6 +1673,97 @@ TEST_F(CompilerTest, SimpleHashJoinTest) {
   EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec1, exp_vec1));
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, MarkHashJoinTest) {
+  // SELECT t2.col1, t2.col1 IN (SELECT t1.col1 FROM t1 WHERE t1.col1 < 40) FROM t2 WHERE t2.col1 < 80
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid1 = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_oid2 = accessor->GetTableOid(NSOid(), "test_2");
+  auto table_schema1 = accessor->GetSchema(table_oid1);
+  auto table_schema2 = accessor->GetSchema(table_oid2);
+
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan1;
+  OutputSchemaHelper seq_scan_out1{0, &expr_maker};
+  {
+    auto cola_oid = table_schema1.GetColumn("colA").Oid();
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    seq_scan_out1.AddOutput("col1", col1);
+    auto schema = seq_scan_out1.MakeSchema();
+    auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(40));
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan1 = builder.SetOutputSchema(std::move(schema))
+                    .SetColumnOids({cola_oid})
+                    .SetScanPredicate(predicate)
+                    .SetIsForUpdateFlag(false)
+                    .SetTableOid(table_oid1)
+                    .Build();
+  }
+  std::unique_ptr<planner::AbstractPlanNode> seq_scan2;
+  OutputSchemaHelper seq_scan_out2{1, &expr_maker};
+  {
+    auto cola_oid = table_schema2.GetColumn("col1").Oid();
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::SMALLINT);
+    seq_scan_out2.AddOutput("col1", col1);
+    auto schema = seq_scan_out2.MakeSchema();
+    auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(80));
+    planner::SeqScanPlanNode::Builder builder;
+    seq_scan2 = builder.SetOutputSchema(std::move(schema))
+                    .SetColumnOids({cola_oid})
+                    .SetScanPredicate(predicate)
+                    .SetIsForUpdateFlag(false)
+                    .SetTableOid(table_oid2)
+                    .Build();
+  }
+  // Make the mark join. The mark is the probe-side attribute after the probe child's columns.
+  std::unique_ptr<planner::AbstractPlanNode> hash_join;
+  OutputSchemaHelper hash_join_out{0, &expr_maker};
+  {
+    auto t1_col1 = seq_scan_out1.GetOutput("col1");
+    auto t2_col1 = seq_scan_out2.GetOutput("col1");
+    hash_join_out.AddOutput("t2.col1", t2_col1);
+    hash_join_out.AddOutput("mark", expr_maker.DVE(type::TypeId::BOOLEAN, 1, 1));
+    auto schema = hash_join_out.MakeSchema();
+    auto predicate = expr_maker.ComparisonEq(t1_col1, t2_col1);
+    planner::HashJoinPlanNode::Builder builder;
+    hash_join = builder.AddChild(std::move(seq_scan1))
+                    .AddChild(std::move(seq_scan2))
+                    .SetOutputSchema(std::move(schema))
+                    .AddLeftHashKey(t1_col1)
+                    .AddRightHashKey(t2_col1)
+                    .SetJoinType(planner::LogicalJoinType::RIGHT_MARK)
+                    .SetJoinPredicate(predicate)
+                    .Build();
+  }
+  // Every probe tuple is produced once, and only the ones below 40 have a join partner
+  uint32_t num_output_rows{0};
+  uint32_t num_expected_rows{80};
+  RowChecker row_checker = [&num_output_rows, num_expected_rows](const std::vector<sql::Val *> &vals) {
+    auto col1 = static_cast<sql::Integer *>(vals[0]);
+    auto mark = static_cast<sql::BoolVal *>(vals[1]);
+    ASSERT_FALSE(col1->is_null_ || mark->is_null_);
+    ASSERT_EQ(col1->val_ < 40, mark->val_);
+    num_output_rows++;
+    ASSERT_LE(num_output_rows, num_expected_rows);
+  };
+  CorrectnessFn correctness_fn = [&num_output_rows, num_expected_rows]() {
+    ASSERT_EQ(num_output_rows, num_expected_rows);
+  };
+  GenericChecker checker(row_checker, correctness_fn);
+
+  OutputStore store{&checker, hash_join->GetOutputSchema().Get()};
+  exec::OutputPrinter printer(hash_join->GetOutputSchema().Get());
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+  exec::OutputCallback callback_fn = callback.ConstructOutputCallback();
+  auto exec_ctx = MakeExecCtx(&callback_fn, hash_join->GetOutputSchema().Get());
+
+  // Run & Check
+  auto executable = execution::compiler::CompilationContext::Compile(*hash_join, exec_ctx->GetExecutionSettings(),
+                                                                     exec_ctx->GetAccessor());
+  executable->Run(common::ManagedPointer(exec_ctx), MODE);
+  checker.CheckCorrectness();
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, MultiWayHashJoinTest) {
   // SELECT t1.col1, t2.col1, t3.col1, t1.col1 + t2.col1 + t3.col1
@@ -2265,6 +2491,89 @@ TEST_F(CompilerTest, SimpleNestedLoopJoinTest) {
   EXPECT_TRUE(CheckFeatureVectorEquality(feature_vec0, exp_vec0));
 }
 
+// NOLINTNEXTLINE
+TEST_F(CompilerTest, NestedLoopJoinInnerFilterTest) {
+  // SELECT t1.colA, t2.colA FROM test_1 AS t1 INNER JOIN test_1 AS t2
+  // ON t1.colA = t2.colA AND t2.colA <= t1.colA AND t1.colA < 500 AND t1.colA + t2.colB >= t2.colB
+  // WHERE t1.colA < 1000 AND t2.colA < 80
+  // All but the last conjunct compare an inner column with an outer value, and are filters of the inner scan.
+  auto accessor = MakeAccessor();
+  ExpressionMaker expr_maker;
+  auto table_oid = accessor->GetTableOid(NSOid(), "test_1");
+  auto table_schema = accessor->GetSchema(table_oid);
+  auto cola_oid = table_schema.GetColumn("colA").Oid();
+  auto colb_oid = table_schema.GetColumn("colB").Oid();
+
+  auto make_scan = [&](OutputSchemaHelper *scan_out, int32_t limit) {
+    auto col1 = expr_maker.CVE(cola_oid, type::TypeId::INTEGER);
+    auto col2 = expr_maker.CVE(colb_oid, type::TypeId::INTEGER);
+    scan_out->AddOutput("colA", col1);
+    scan_out->AddOutput("colB", col2);
+    auto schema = scan_out->MakeSchema();
+    auto predicate = expr_maker.ComparisonLt(col1, expr_maker.Constant(limit));
+    planner::SeqScanPlanNode::Builder builder;
+    return builder.SetOutputSchema(std::move(schema))
+        .SetColumnOids({cola_oid, colb_oid})
+        .SetScanPredicate(predicate)
+        .SetIsForUpdateFlag(false)
+        .SetTableOid(table_oid)
+        .Build();
+  };
+  OutputSchemaHelper inner_out{0, &expr_maker};
+  std::unique_ptr<planner::AbstractPlanNode> inner_scan = make_scan(&inner_out, 1000);
+  OutputSchemaHelper outer_out{1, &expr_maker};
+  std::unique_ptr<planner::AbstractPlanNode> outer_scan = make_scan(&outer_out, 80);
+
+  std::unique_ptr<planner::AbstractPlanNode> nl_join;
+  OutputSchemaHelper nl_join_out{0, &expr_maker};
+  {
+    auto t1_cola = inner_out.GetOutput("colA");
+    auto t2_cola = outer_out.GetOutput("colA");
+    auto t2_colb = outer_out.GetOutput("colB");
+    nl_join_out.AddOutput("t1.colA", t1_cola);
+    nl_join_out.AddOutput("t2.colA", t2_cola);
+    auto schema = nl_join_out.MakeSchema();
+    auto predicate = expr_maker.ConjunctionAnd(
+        expr_maker.ConjunctionAnd(expr_maker.ComparisonEq(t1_cola, t2_cola), expr_maker.ComparisonLe(t2_cola, t1_cola)),
+        expr_maker.ConjunctionAnd(expr_maker.ComparisonLt(t1_cola, expr_maker.Constant(500)),
+                                  expr_maker.ComparisonGe(expr_maker.OpSum(t1_cola, t2_colb), t2_colb)));
+    planner::NestedLoopJoinPlanNode::Builder builder;
+    nl_join = builder.AddChild(std::move(inner_scan))
+                  .AddChild(std::move(outer_scan))
+                  .SetOutputSchema(std::move(schema))
+                  .SetJoinType(planner::LogicalJoinType::INNER)
+                  .SetJoinPredicate(predicate)
+                  .Build();
+  }
+
+  // Every outer tuple matches exactly one inner tuple
+  uint32_t num_output_rows{0};
+  uint32_t num_expected_rows{80};
+  RowChecker row_checker = [&num_output_rows, num_expected_rows](const std::vector<sql::Val *> &vals) {
+    auto col1 = static_cast<sql::Integer *>(vals[0]);
+    auto col2 = static_cast<sql::Integer *>(vals[1]);
+    ASSERT_FALSE(col1->is_null_ || col2->is_null_);
+    ASSERT_EQ(col1->val_, col2->val_);
+    num_output_rows++;
+    ASSERT_LE(num_output_rows, num_expected_rows);
+  };
+  CorrectnessFn correctness_fn = [&num_output_rows, num_expected_rows]() {
+    ASSERT_EQ(num_output_rows, num_expected_rows);
+  };
+  GenericChecker checker(row_checker, correctness_fn);
+
+  OutputStore store{&checker, nl_join->GetOutputSchema().Get()};
+  exec::OutputPrinter printer(nl_join->GetOutputSchema().Get());
+  MultiOutputCallback callback{std::vector<exec::OutputCallback>{store, printer}};
+  exec::OutputCallback callback_fn = callback.ConstructOutputCallback();
+  auto exec_ctx = MakeExecCtx(&callback_fn, nl_join->GetOutputSchema().Get());
+
+  auto executable = execution::compiler::CompilationContext::Compile(*nl_join, exec_ctx->GetExecutionSettings(),
+                                                                     exec_ctx->GetAccessor());
+  executable->Run(common::ManagedPointer(exec_ctx), MODE);
+  checker.CheckCorrectness();
+}
+
 // NOLINTNEXTLINE
 TEST_F(CompilerTest, SimpleIndexNestedLoopJoinTest) {
   // SELECT t1.col1, t2.col1, t2.col2, t1.col2 + t2.col2 FROM test_2 AS t2 INNER JOIN test_1 AS t1 ON t1.col1=t2.col1
@@ -0,0 +1,112 @@
+#include <functional>
+#include <string>
+
+#include "execution/ast/context.h"
+#include "execution/compiled_tpl_test.h"
+#include "execution/compiler/compiler.h"
+#include "execution/sema/error_reporter.h"
+#include "execution/util/region.h"
+#include "execution/vm/llvm_engine.h"
+#include "execution/vm/module.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage::execution::test {
+
+class LLVMEngineTest : public CompiledTplTest {
+ public:
+  LLVMEngineTest() : region_("llvm_engine_test") {}
+
+  util::Region region_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(LLVMEngineTest, PartitionedCompilationTest) {
+  sema::ErrorReporter error_reporter(&region_);
+  ast::Context context(&region_, &error_reporter);
+
+  // Many independent pairs of functions, large enough to be split into partitions. Each caller
+  // must end up in the same partition as its callee.
+  constexpr uint32_t num_functions = 256;
+  std::string src;
+  for (uint32_t i = 0; i < num_functions; i++) {
+    src += fmt::format(R"(
+    fun sum{0}(n: int64) -> int64 {{
+      var s: int64 = 0
+      for (var i: int64 = 0; i < n; i = i + 1) {{
+        if (i % 2 == 0) {{
+          s = s + i * {0}
+        }} else {{
+          s = s - i
+        }}
+      }}
+      return s
+    }}
+    fun call{0}(n: int64) -> int64 {{
+      return sum{0}(n) + sum{0}(n / 2)
+    }})",
+                       i);
+  }
+
+  auto input = compiler::Compiler::Input("Partitioned Compilation", &context, &src);
+  auto module = compiler::Compiler::RunCompilationSimple(input);
+  ASSERT_FALSE(module == nullptr);
+
+  vm::LLVMEngine::CompilerOptions options;
+  options.SetMaxPartitions(4);
+  auto compiled_module = vm::LLVMEngine::Compile(*module->GetBytecodeModule(), options);
+  ASSERT_TRUE(compiled_module->IsLoaded());
+
+  for (uint32_t i = 0; i < num_functions; i++) {
+    const auto name = fmt::format("call{}", i);
+    auto compiled = reinterpret_cast<int64_t (*)(int64_t)>(compiled_module->GetFunctionPointer(name));
+    ASSERT_NE(nullptr, compiled);
+
+    std::function<int64_t(int64_t)> interpreted;
+    ASSERT_TRUE(module->GetFunction(name, vm::ExecutionMode::Interpret, &interpreted));
+    EXPECT_EQ(interpreted(100), compiled(100));
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(LLVMEngineTest, OptimizationProfileTest) {
+  sema::ErrorReporter error_reporter(&region_);
+  ast::Context context(&region_, &error_reporter);
+
+  const std::string src = R"(
+    fun scale(x: int64) -> int64 { return x * 3 + 1 }
+    fun sum(n: int64) -> int64 {
+      var s: int64 = 0
+      for (var i: int64 = 0; i < n; i = i + 1) {
+        if (i % 3 == 0) {
+          s = s + scale(i)
+        } else {
+          s = s - i
+        }
+      }
+      return s
+    })";
+
+  auto input = compiler::Compiler::Input("Optimization Profiles", &context, &src);
+  auto module = compiler::Compiler::RunCompilationSimple(input);
+  ASSERT_FALSE(module == nullptr);
+
+  std::function<int64_t(int64_t)> interpreted;
+  ASSERT_TRUE(module->GetFunction("sum", vm::ExecutionMode::Interpret, &interpreted));
+
+  // Every pipeline must generate code computing the same results.
+  for (const auto profile : {vm::OptimizationProfile::FastCompile, vm::OptimizationProfile::Balanced,
+                             vm::OptimizationProfile::MaxPerformance}) {
+    vm::LLVMEngine::CompilerOptions options;
+    options.SetOptimizationProfile(profile);
+    auto compiled_module = vm::LLVMEngine::Compile(*module->GetBytecodeModule(), options);
+    ASSERT_TRUE(compiled_module->IsLoaded());
+
+    auto compiled = reinterpret_cast<int64_t (*)(int64_t)>(compiled_module->GetFunctionPointer("sum"));
+    ASSERT_NE(nullptr, compiled);
+    for (const int64_t n : {0, 1, 10, 1000}) {
+      EXPECT_EQ(interpreted(n), compiled(n));
+    }
+  }
+}
+
+}  // namespace noisepage::execution::test
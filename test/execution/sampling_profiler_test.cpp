@@ -0,0 +1,77 @@
+#include "execution/exec/sampling_profiler.h"
+
+#include <chrono>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "execution/tpl_test.h"
+#include "metrics/metrics_sink.h"
+
+namespace noisepage::execution::exec::test {
+
+namespace {
+
+// Burn CPU for the given time, so that the profiling timer fires
+void Spin(const std::chrono::milliseconds duration) {
+  const auto end = std::chrono::steady_clock::now() + duration;
+  volatile uint64_t sink = 0;
+  while (std::chrono::steady_clock::now() < end) sink = sink + 1;
+}
+
+}  // namespace
+
+// NOLINTNEXTLINE
+TEST(SamplingProfilerTest, TagsSamples) {
+  SamplingProfiler::Start(1000);
+  EXPECT_TRUE(SamplingProfiler::IsRunning());
+  {
+    SamplingProfiler::TagScope outer({7, 1});
+    Spin(std::chrono::milliseconds(300));
+    {
+      SamplingProfiler::TagScope inner({7, 2});
+      Spin(std::chrono::milliseconds(100));
+    }
+    // The outer tag is back once the inner scope ends
+    Spin(std::chrono::milliseconds(300));
+  }
+  // Untagged CPU time is only counted in total
+  Spin(std::chrono::milliseconds(100));
+
+  // A worker that joins the work of a query on its own
+  std::thread worker([] {
+    const SamplingProfiler::Tag tag{8, 3};
+    SamplingProfiler::SetThreadTag(&tag);
+    Spin(std::chrono::milliseconds(200));
+    SamplingProfiler::SetThreadTag(nullptr);
+  });
+  worker.join();
+  SamplingProfiler::Stop();
+  EXPECT_FALSE(SamplingProfiler::IsRunning());
+
+  const auto samples = SamplingProfiler::GetSamples();
+  ASSERT_GE(samples.size(), 2);
+  uint64_t num_tagged = 0;
+  for (const auto &tagged : samples) num_tagged += tagged.count_;
+  EXPECT_GE(SamplingProfiler::NumSamples(), num_tagged);
+
+  // The most CPU time went to the outer tag
+  EXPECT_EQ(samples[0].tag_.query_id_, 7);
+  EXPECT_EQ(samples[0].tag_.pipeline_id_, 1);
+  for (uint32_t i = 1; i < samples.size(); i++) EXPECT_GE(samples[i - 1].count_, samples[i].count_);
+
+  // Stopping keeps the samples, and they are written most first
+  metrics::RingBufferMetricsSink sink(10);
+  SamplingProfiler::Write(sink.GetWriter("samples", SamplingProfiler::COLUMNS));
+  const auto rows = sink.GetRows("samples");
+  ASSERT_EQ(rows.size(), samples.size());
+  EXPECT_EQ(std::get<uint64_t>(rows[0][0]), 7);
+  EXPECT_EQ(std::get<uint64_t>(rows[0][2]), samples[0].count_);
+
+  // Starting again drops them
+  SamplingProfiler::Start(1000);
+  SamplingProfiler::Stop();
+  EXPECT_TRUE(SamplingProfiler::GetSamples().empty());
+}
+
+}  // namespace noisepage::execution::exec::test
@@ -1,8 +1,10 @@
 #include <tbb/tbb.h>
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <random>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -170,6 +172,46 @@ TEST_F(AggregationHashTableTest, IterationTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, DenseDomainTest) {
+  // Keys are selected continuously from [0, 20), but only [5, 15) is dense.
+  // Keys outside of it must go through the hash table like NULL keys do.
+  const uint32_t num_inserts = 10000;
+  const uint32_t num_groups = 20;
+  const int64_t min_key = 5;
+  const uint32_t num_keys = 10;
+  AggTable()->SetDenseDomain(min_key, num_keys);
+
+  for (uint32_t idx = 0; idx < num_inserts; idx++) {
+    InputTuple input(idx % num_groups, 1);
+    const Integer key(input.key_);
+    const bool in_domain = input.key_ >= min_key && input.key_ < min_key + num_keys;
+    auto *existing = reinterpret_cast<AggTuple *>(AggTable()->LookupDense(key));
+    // Groups of keys in the domain are found directly once they exist
+    EXPECT_EQ(in_domain && idx >= num_groups, existing != nullptr);
+    if (existing == nullptr) {
+      existing = reinterpret_cast<AggTuple *>(
+          AggTable()->Lookup(input.Hash(), AggTupleKeyEq, reinterpret_cast<const void *>(&input)));
+      if (existing == nullptr) {
+        existing = new (AggTable()->AllocInputTuple(input.Hash())) AggTuple(input);
+        AggTable()->InsertDense(key, reinterpret_cast<byte *>(existing));
+        continue;
+      }
+    }
+    existing->Advance(input);
+  }
+  EXPECT_EQ(nullptr, AggTable()->LookupDense(Integer::Null()));
+
+  // Every group was created exactly once
+  uint32_t group_count = 0;
+  for (AHTIterator iter(*AggTable()); iter.HasNext(); iter.Next()) {
+    auto *agg_tuple = reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow());
+    EXPECT_EQ(num_inserts / num_groups, agg_tuple->count1_);
+    group_count++;
+  }
+  EXPECT_EQ(num_groups, group_count);
+}
+
 // NOLINTNEXTLINE
 TEST_F(AggregationHashTableTest, SimplePartitionedInsertionTest) {
   const uint32_t num_tuples = 10000;
@@ -438,4 +480,288 @@ TEST_F(AggregationHashTableTest, ParallelAggregationTest) {
   EXPECT_EQ(num_aggs, query_state.row_count_.load(std::memory_order_seq_cst));
 }
 
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, ParallelAggregationSpillTest) {
+  // Every flush of a thread-local table puts its thread over the budget
+  SetAggregationMemoryBudget(1);
+  auto exec_ctx = MakeExecCtx();
+  tbb::task_scheduler_init sched;
+
+  struct QueryState {
+    std::atomic<uint32_t> row_count_;
+    std::atomic<uint64_t> count_sum_;
+  };
+
+  QueryState query_state{0, 0};
+  MemoryPool memory(nullptr);
+  ThreadStateContainer container(&memory);
+
+  container.Reset(
+      sizeof(AggregationHashTable),
+      [](void *ctx, void *aht) {
+        auto exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+        new (aht) AggregationHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(AggTuple));
+      },
+      [](void *ctx, void *aht) { std::destroy_at(reinterpret_cast<AggregationHashTable *>(aht)); }, exec_ctx.get());
+
+  // Enough groups that every thread-local table flushes, and spills, several times
+  constexpr uint32_t num_aggs = 100000;
+  constexpr uint32_t num_inputs = 200000;
+  LaunchParallel(4, [&](auto tid) {
+    auto agg_table = container.AccessCurrentThreadStateAs<AggregationHashTable>();
+
+    std::mt19937 generator(tid);
+    std::uniform_int_distribution<uint64_t> distribution(0, num_aggs - 1);
+
+    for (uint32_t idx = 0; idx < num_inputs; idx++) {
+      InputTuple input(distribution(generator), 1);
+      auto *existing = reinterpret_cast<AggTuple *>(
+          agg_table->Lookup(input.Hash(), AggTupleKeyEq, reinterpret_cast<const void *>(&input)));
+      if (existing != nullptr) {
+        existing->Advance(input);
+      } else {
+        auto *new_agg = agg_table->AllocInputTuplePartitioned(input.Hash());
+        new (new_agg) AggTuple(input);
+      }
+    }
+    EXPECT_GT(agg_table->GetStatistics()->num_spills_, 0);
+  });
+
+  AggregationHashTable main_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(AggTuple));
+  main_table.TransferMemoryAndPartitions(
+      &container, 0, [](void *ctx, AggregationHashTable *table, AHTOverflowPartitionIterator *iter) {
+        for (; iter->HasNext(); iter->Next()) {
+          auto *partial_agg = iter->GetRowAs<AggTuple>();
+          auto *existing = reinterpret_cast<AggTuple *>(table->Lookup(iter->GetRowHash(), AggAggKeyEq, partial_agg));
+          if (existing != nullptr) {
+            existing->Merge(*partial_agg);
+          } else {
+            table->Insert(iter->GetEntryForRow());
+          }
+        }
+      });
+  container.Clear();
+
+  // Spilled aggregates are read back and merged with the ones that stayed in memory, so that every group shows up
+  // exactly once with all of its inputs
+  main_table.ExecuteParallelPartitionedScan(
+      &query_state, &container, [](void *query_state, void *thread_state, const AggregationHashTable *agg_table) {
+        auto *qs = reinterpret_cast<QueryState *>(query_state);
+        qs->row_count_ += agg_table->GetTupleCount();
+        for (AHTIterator iter(*agg_table); iter.HasNext(); iter.Next()) {
+          qs->count_sum_ += reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow())->count1_;
+        }
+      });
+
+  EXPECT_LE(query_state.row_count_.load(), num_aggs);
+  EXPECT_GT(query_state.row_count_.load(), num_aggs * 9 / 10);
+  EXPECT_EQ(query_state.count_sum_.load(), 4 * num_inputs);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, ParallelStringKeyTest) {
+  auto exec_ctx = MakeExecCtx();
+  tbb::task_scheduler_init sched;
+
+  // A group on a string key, which is compared by its size and prefix before its contents
+  struct StringAggTuple {
+    StringVal key_;
+    uint64_t count_;
+  };
+  struct QueryState {
+    std::atomic<uint32_t> row_count_;
+    std::atomic<uint64_t> count_sum_;
+    std::atomic<uint32_t> num_bad_keys_;
+  };
+
+  QueryState query_state{0, 0, 0};
+  MemoryPool memory(nullptr);
+  ThreadStateContainer container(&memory);
+
+  container.Reset(
+      sizeof(AggregationHashTable),
+      [](void *ctx, void *aht) {
+        auto exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+        new (aht) AggregationHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(StringAggTuple));
+      },
+      [](void *ctx, void *aht) { std::destroy_at(reinterpret_cast<AggregationHashTable *>(aht)); }, exec_ctx.get());
+
+  // Even keys are short enough to be inlined, odd keys are not. All keys share a prefix.
+  constexpr uint32_t num_aggs = 1000;
+  constexpr uint32_t num_inputs = 20000;
+  LaunchParallel(4, [&](auto tid) {
+    auto agg_table = container.AccessCurrentThreadStateAs<AggregationHashTable>();
+
+    std::mt19937 generator(tid);
+    std::uniform_int_distribution<uint32_t> distribution(0, num_aggs - 1);
+
+    // Keys are built in a single buffer that is overwritten by every input, like the ones of a scan
+    std::string buffer;
+    for (uint32_t idx = 0; idx < num_inputs; idx++) {
+      const uint32_t key = distribution(generator);
+      buffer = (key % 2 == 0 ? "k-" : "key-that-is-not-inlined-") + std::to_string(key);
+      StringVal input(buffer.data(), buffer.size());
+      const hash_t hash = input.val_.Hash();
+
+      auto *existing = reinterpret_cast<StringAggTuple *>(
+          agg_table->Lookup(hash,
+                            [](const void *agg, const void *probe) {
+                              return reinterpret_cast<const StringAggTuple *>(agg)->key_ ==
+                                     *reinterpret_cast<const StringVal *>(probe);
+                            },
+                            &input));
+      if (existing != nullptr) {
+        existing->count_++;
+      } else {
+        auto *new_agg = reinterpret_cast<StringAggTuple *>(agg_table->AllocInputTuplePartitioned(hash));
+        new_agg->key_ = input;
+        new_agg->count_ = 1;
+        agg_table->InternStringKey(&new_agg->key_);
+        // Long keys are copied into the table, short keys stay inlined
+        EXPECT_EQ(key % 2 == 0, new_agg->key_.GetContent() == input.GetContent());
+      }
+      std::fill(buffer.begin(), buffer.end(), '?');
+    }
+  });
+
+  AggregationHashTable main_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(StringAggTuple));
+  main_table.TransferMemoryAndPartitions(
+      &container, 0, [](void *ctx, AggregationHashTable *table, AHTOverflowPartitionIterator *iter) {
+        for (; iter->HasNext(); iter->Next()) {
+          auto *partial_agg = iter->GetRowAs<StringAggTuple>();
+          auto *existing = reinterpret_cast<StringAggTuple *>(table->Lookup(
+              iter->GetRowHash(),
+              [](const void *agg_1, const void *agg_2) {
+                return reinterpret_cast<const StringAggTuple *>(agg_1)->key_ ==
+                       reinterpret_cast<const StringAggTuple *>(agg_2)->key_;
+              },
+              partial_agg));
+          if (existing != nullptr) {
+            existing->count_ += partial_agg->count_;
+          } else {
+            table->Insert(iter->GetEntryForRow());
+          }
+        }
+      });
+
+  // The keys copied into the thread-local tables outlive them
+  container.Clear();
+
+  main_table.ExecuteParallelPartitionedScan(
+      &query_state, &container, [](void *query_state, void *thread_state, const AggregationHashTable *agg_table) {
+        auto *qs = reinterpret_cast<QueryState *>(query_state);
+        qs->row_count_ += agg_table->GetTupleCount();
+        for (AHTIterator iter(*agg_table); iter.HasNext(); iter.Next()) {
+          auto *agg = reinterpret_cast<const StringAggTuple *>(iter.GetCurrentAggregateRow());
+          const auto key = agg->key_.StringView();
+          if (key.find('?') != std::string_view::npos || (key.substr(0, 2) != "k-" && key.substr(0, 4) != "key-")) {
+            qs->num_bad_keys_++;
+          }
+          qs->count_sum_ += agg->count_;
+        }
+      });
+
+  EXPECT_EQ(num_aggs, query_state.row_count_.load());
+  EXPECT_EQ(0u, query_state.num_bad_keys_.load());
+  EXPECT_EQ(4 * num_inputs, query_state.count_sum_.load());
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregationHashTableTest, BatchProcessBypassTest) {
+  auto exec_ctx = MakeExecCtx();
+  tbb::task_scheduler_init sched;
+
+  struct QueryState {
+    std::atomic<uint32_t> row_count_;
+    std::atomic<uint64_t> count_sum_;
+  };
+
+  QueryState query_state{0, 0};
+  MemoryPool memory(nullptr);
+  ThreadStateContainer container(&memory);
+
+  container.Reset(
+      sizeof(AggregationHashTable),
+      [](void *ctx, void *aht) {
+        auto exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+        new (aht) AggregationHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(AggTuple));
+      },
+      [](void *ctx, void *aht) { std::destroy_at(reinterpret_cast<AggregationHashTable *>(aht)); }, exec_ctx.get());
+  auto agg_table = container.AccessCurrentThreadStateAs<AggregationHashTable>();
+
+  VectorProjection vector_projection;
+  vector_projection.Initialize({TypeId::Integer, TypeId::Integer});
+  vector_projection.Reset(common::Constants::K_DEFAULT_VECTOR_SIZE);
+
+  auto process_batches = [&](const uint32_t num_batches, auto make_key) {
+    for (uint32_t run = 0; run < num_batches; run++) {
+      auto keys = reinterpret_cast<uint32_t *>(vector_projection.GetColumn(0)->GetData());
+      for (uint32_t i = 0; i < common::Constants::K_DEFAULT_VECTOR_SIZE; i++) {
+        keys[i] = make_key(run * common::Constants::K_DEFAULT_VECTOR_SIZE + i);
+      }
+      VectorProjectionIterator vpi(&vector_projection);
+      agg_table->ProcessBatch(
+          &vpi, {0},
+          [](VectorProjectionIterator *new_aggs, VectorProjectionIterator *input) {
+            VectorProjectionIterator::SynchronizedForEach({new_aggs, input}, [&]() {
+              auto *e = *new_aggs->GetValue<sql::HashTableEntry *, false>(1, nullptr);
+              auto agg = const_cast<AggTuple *>(e->PayloadAs<AggTuple>());
+              agg->key_ = *input->GetValue<uint32_t, false>(0, nullptr);
+              agg->count1_ = agg->count2_ = agg->count3_ = 0;
+            });
+          },
+          [](VectorProjectionIterator *aggs, VectorProjectionIterator *input) {
+            VectorProjectionIterator::SynchronizedForEach({aggs, input}, [&]() {
+              auto *e = *aggs->GetValue<sql::HashTableEntry *, false>(1, nullptr);
+              const_cast<AggTuple *>(e->PayloadAs<AggTuple>())->count1_++;
+            });
+          },
+          true /* Partitioned? */);
+    }
+  };
+
+  // Unique keys don't reduce at all, so after the first flush the table stops
+  // pre-aggregating them.
+  constexpr uint32_t num_batches = 64;
+  constexpr uint32_t num_low_cardinality_keys = 64;
+  process_batches(num_batches, [](uint32_t i) { return num_low_cardinality_keys + i; });
+  const uint64_t num_bypassed = agg_table->GetStatistics()->num_bypassed_;
+  EXPECT_GT(num_bypassed, 0);
+
+  // A few keys reduce well, so the table soon pre-aggregates again.
+  process_batches(num_batches, [](uint32_t i) { return i % num_low_cardinality_keys; });
+  EXPECT_LT(agg_table->GetStatistics()->num_bypassed_ - num_bypassed,
+            num_batches * common::Constants::K_DEFAULT_VECTOR_SIZE / 2);
+
+  AggregationHashTable main_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(AggTuple));
+  main_table.TransferMemoryAndPartitions(
+      &container, 0, [](void *ctx, AggregationHashTable *table, AHTOverflowPartitionIterator *iter) {
+        for (; iter->HasNext(); iter->Next()) {
+          auto *partial_agg = iter->GetRowAs<AggTuple>();
+          auto *existing = reinterpret_cast<AggTuple *>(table->Lookup(iter->GetRowHash(), AggAggKeyEq, partial_agg));
+          if (existing != nullptr) {
+            existing->Merge(*partial_agg);
+          } else {
+            table->Insert(iter->GetEntryForRow());
+          }
+        }
+      });
+  container.Clear();
+
+  // Bypassed tuples are merged with the pre-aggregated ones, so that every
+  // group shows up exactly once with all of its inputs.
+  main_table.ExecuteParallelPartitionedScan(
+      &query_state, &container, [](void *query_state, void *thread_state, const AggregationHashTable *agg_table) {
+        auto *qs = reinterpret_cast<QueryState *>(query_state);
+        qs->row_count_ += agg_table->GetTupleCount();
+        for (AHTIterator iter(*agg_table); iter.HasNext(); iter.Next()) {
+          qs->count_sum_ += reinterpret_cast<const AggTuple *>(iter.GetCurrentAggregateRow())->count1_;
+        }
+      });
+
+  EXPECT_EQ(query_state.row_count_.load(),
+            num_low_cardinality_keys + num_batches * common::Constants::K_DEFAULT_VECTOR_SIZE);
+  EXPECT_EQ(query_state.count_sum_.load(), 2 * num_batches * common::Constants::K_DEFAULT_VECTOR_SIZE);
+}
+
 }  // namespace noisepage::execution::sql
@@ -1,3 +1,6 @@
+#include <limits>
+
+#include "common/error/exception.h"
 #include "execution/sql/aggregators.h"
 #include "execution/sql/value.h"
 #include "execution/sql_test.h"
@@ -504,6 +507,62 @@ TEST_F(AggregatorsTest, Avg) {
   EXPECT_DOUBLE_EQ(0.0, avg1.GetResultAvg().val_);
 }
 
+// NOLINTNEXTLINE
+TEST_F(AggregatorsTest, SumDecimal) {
+  DecimalSumAggregate sum1, sum2;
+  EXPECT_TRUE(sum1.GetResultSum().is_null_);
+
+  // Intermediate sums beyond the range of a decimal are fine, as long as the final sum is back within it
+  sum1.Advance(DecimalVal(std::numeric_limits<int64_t>::max()));
+  sum1.Advance(DecimalVal::Null());
+  sum1.Advance(DecimalVal(int64_t{10}));
+  EXPECT_THROW(sum1.GetResultSum(), ExecutionException);
+  sum2.Advance(DecimalVal(int64_t{-20}));
+  sum1.Merge(sum2);
+  EXPECT_FALSE(sum1.GetResultSum().is_null_);
+  EXPECT_EQ(std::numeric_limits<int64_t>::max() - 10, static_cast<int64_t>(sum1.GetResultSum().val_));
+
+  // Merging a NULL sum leaves the sum as it is
+  DecimalSumAggregate null_sum;
+  sum1.Merge(null_sum);
+  EXPECT_EQ(std::numeric_limits<int64_t>::max() - 10, static_cast<int64_t>(sum1.GetResultSum().val_));
+
+  sum1.Reset();
+  EXPECT_TRUE(sum1.GetResultSum().is_null_);
+}
+
+// NOLINTNEXTLINE
+TEST_F(AggregatorsTest, AvgDecimal) {
+  DecimalAvgAggregate avg1, avg2;
+  EXPECT_TRUE(avg1.GetResultAvg().is_null_);
+
+  // The average of the encoded values 1, 2, 2 is 1.67, which rounds to 2
+  avg1.Advance(DecimalVal(int64_t{1}));
+  avg1.Advance(DecimalVal(int64_t{2}));
+  avg1.Advance(DecimalVal::Null());
+  avg1.Advance(DecimalVal(int64_t{2}));
+  EXPECT_EQ(2, static_cast<int64_t>(avg1.GetResultAvg().val_));
+
+  // Negative averages round half away from zero too: (1 + 2 + 2 - 10) / 4 = -1.25 rounds to -1
+  avg2.Advance(DecimalVal(int64_t{-10}));
+  avg1.Merge(avg2);
+  EXPECT_EQ(-1, static_cast<int64_t>(avg1.GetResultAvg().val_));
+  // ... and (-1 - 2) / 2 = -1.5 rounds to -2
+  DecimalAvgAggregate half;
+  half.Advance(DecimalVal(int64_t{-1}));
+  half.Advance(DecimalVal(int64_t{-2}));
+  EXPECT_EQ(-2, static_cast<int64_t>(half.GetResultAvg().val_));
+
+  // The sum of large values does not overflow
+  DecimalAvgAggregate large;
+  large.Advance(DecimalVal(std::numeric_limits<int64_t>::max()));
+  large.Advance(DecimalVal(std::numeric_limits<int64_t>::max()));
+  EXPECT_EQ(std::numeric_limits<int64_t>::max(), static_cast<int64_t>(large.GetResultAvg().val_));
+
+  avg1.Reset();
+  EXPECT_TRUE(avg1.GetResultAvg().is_null_);
+}
+
 // ---------------------------------------------------------
 // TOP K Test
 // ---------------------------------------------------------
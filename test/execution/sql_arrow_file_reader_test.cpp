@@ -0,0 +1,119 @@
+#include <unistd.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "execution/sql/arrow_file_reader.h"
+#include "execution/sql/vector_projection.h"
+#include "execution/tpl_test.h"
+#include "storage/arrow_serializer.h"
+#include "storage/garbage_collector.h"
+#include "storage/tuple_access_strategy.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/transaction_manager.h"
+
+namespace noisepage::execution::sql::test {
+
+class ArrowFileReaderTest : public TplTest {
+ public:
+  storage::BlockStore block_store_{100, 100};
+  storage::RecordBufferSegmentPool buffer_pool_{10000, 10000};
+};
+
+// NOLINTNEXTLINE
+TEST_F(ArrowFileReaderTest, ReadExportedTable) {
+  const std::string file_name = "arrow_file_reader_test_table.arrow";
+  // Columns are ordered by size, so the varlen column comes first
+  storage::BlockLayout layout({8, 8, storage::VARLEN_COLUMN});
+  const storage::col_id_t varlen_col(1), int_col(2);
+  storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                           storage::layout_version_t(0));
+  transaction::TimestampManager timestamp_manager;
+  transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+  transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                              common::ManagedPointer(&deferred_action_manager),
+                                              common::ManagedPointer(&buffer_pool_),
+                                              true,
+                                              false,
+                                              DISABLED};
+  storage::GarbageCollector gc{common::ManagedPointer(&timestamp_manager),
+                               common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&txn_manager),
+                               DISABLED};
+
+  // More rows than fit into one vector. Some strings are inlined, the others are not, and every tenth is NULL.
+  const uint32_t num_tuples = common::Constants::K_DEFAULT_VECTOR_SIZE + 100;
+  std::vector<std::string> values;
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    values.push_back((i % 2 == 0 ? "value-" : "a-much-longer-value-") + std::to_string(i % 7));
+  }
+  auto initializer = storage::ProjectedRowInitializer::Create(layout, {varlen_col, int_col});
+  byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  auto *row = initializer.InitializeRow(buffer);
+  const uint16_t varlen_index = row->ColumnIds()[0] == varlen_col ? 0 : 1;
+  std::vector<storage::TupleSlot> slots;
+  auto *txn = txn_manager.BeginTransaction();
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    if (i % 10 == 0) {
+      row->SetNull(varlen_index);
+    } else {
+      *reinterpret_cast<storage::VarlenEntry *>(row->AccessForceNotNull(varlen_index)) =
+          storage::VarlenEntry::Create(values[i]);
+    }
+    *reinterpret_cast<int64_t *>(row->AccessForceNotNull(1 - varlen_index)) = i;
+    slots.push_back(table.Insert(common::ManagedPointer(txn), *row));
+  }
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  delete[] buffer;
+
+  std::vector<type::TypeId> column_types(layout.NumColumns());
+  column_types[varlen_col.UnderlyingValue()] = type::TypeId::VARCHAR;
+  column_types[int_col.UnderlyingValue()] = type::TypeId::BIGINT;
+  auto &arrow_metadata = storage::TupleAccessStrategy(layout).GetArrowBlockMetadata(slots[0].GetBlock());
+  arrow_metadata.GetColumnInfo(layout, int_col).Type() = storage::ArrowColumnType::FIXED_LENGTH;
+
+  // Strings are read the same whether they are gathered or dictionary-encoded
+  for (const auto varlen_type : {storage::ArrowColumnType::GATHERED_VARLEN,
+                                 storage::ArrowColumnType::DICTIONARY_COMPRESSED}) {
+    arrow_metadata.GetColumnInfo(layout, varlen_col).Type() = varlen_type;
+    auto *export_txn = txn_manager.BeginTransaction();
+    std::ofstream outfile(file_name, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+    storage::ArrowIpcFileSink sink(&outfile);
+    storage::ArrowSerializer(table).ExportTable(&sink, &column_types, common::ManagedPointer(export_txn));
+    outfile.close();
+    txn_manager.Commit(export_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    ArrowFileReader reader(file_name);
+    ASSERT_EQ(2u, reader.GetColumnCount());
+    EXPECT_EQ(TypeId::Varchar, reader.GetColumnType(0));
+    EXPECT_EQ(TypeId::BigInt, reader.GetColumnType(1));
+    EXPECT_EQ(num_tuples, reader.GetRowCount());
+
+    // Read the columns in the opposite order, a vector at a time
+    VectorProjection vector_projection;
+    vector_projection.Initialize({TypeId::BigInt, TypeId::Varchar});
+    uint32_t num_read = 0;
+    for (uint32_t batch_idx = 0; batch_idx < reader.GetBatchCount(); batch_idx++) {
+      uint32_t n;
+      for (uint64_t row_offset = 0; (n = reader.ReadBatch(batch_idx, row_offset, {1, 0}, &vector_projection)) > 0;
+           row_offset += n, num_read += n) {
+        EXPECT_GE(common::Constants::K_DEFAULT_VECTOR_SIZE, n);
+        for (uint32_t i = 0; i < n; i++) {
+          const uint32_t tuple = num_read + i;
+          EXPECT_EQ(GenericValue::CreateBigInt(tuple), vector_projection.GetColumn(0)->GetValue(i));
+          EXPECT_EQ(tuple % 10 == 0 ? GenericValue::CreateNull(TypeId::Varchar)
+                                    : GenericValue::CreateVarchar(values[tuple]),
+                    vector_projection.GetColumn(1)->GetValue(i));
+        }
+        vector_projection.CheckIntegrity();
+      }
+    }
+    EXPECT_EQ(num_tuples, num_read);
+    unlink(file_name.c_str());
+  }
+
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();  // Second call to deallocate.
+}
+
+}  // namespace noisepage::execution::sql::test
@@ -4,6 +4,8 @@
 
 #include "common/hash_util.h"
 #include "execution/sql/bloom_filter.h"
+#include "execution/sql/tuple_id_list.h"
+#include "execution/sql/vector.h"
 #include "execution/tpl_test.h"
 
 namespace noisepage::execution::sql::test {
@@ -110,4 +112,49 @@ TEST_F(BloomFilterTest, Comprehensive) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(BloomFilterTest, ContainsBatch) {
+  const uint32_t num_filter_elems = 10000;
+
+  std::vector<uint32_t> insertions;
+  GenerateRandom32(insertions, num_filter_elems);
+  std::unordered_set<uint32_t> check(insertions.begin(), insertions.end());
+
+  BloomFilter filter(Memory(), num_filter_elems);
+  for (const auto elem : insertions) {
+    filter.Add(Hash(elem));
+  }
+
+  // Half of the lookups were inserted
+  std::vector<uint32_t> lookups;
+  GenerateRandom32(lookups, common::Constants::K_DEFAULT_VECTOR_SIZE);
+  Mix(lookups, insertions, 0.5);
+
+  Vector hashes(TypeId::Hash, true, false);
+  hashes.Resize(lookups.size());
+  auto *raw_hashes = reinterpret_cast<hash_t *>(hashes.GetData());
+  for (uint32_t i = 0; i < lookups.size(); i++) {
+    raw_hashes[i] = Hash(lookups[i]);
+  }
+
+  // Check all elements, then only every third one
+  for (const uint32_t step : {1, 3}) {
+    TupleIdList tid_list(lookups.size());
+    for (uint32_t i = 0; i < lookups.size(); i += step) {
+      tid_list.Add(i);
+    }
+
+    filter.ContainsBatch(hashes, &tid_list);
+
+    // The batch agrees with one-at-a-time checks, and never drops an inserted element
+    for (uint32_t i = 0; i < lookups.size(); i++) {
+      const bool selected = i % step == 0;
+      EXPECT_EQ(selected && filter.Contains(raw_hashes[i]), tid_list.Contains(i));
+      if (selected && check.count(lookups[i]) != 0) {
+        EXPECT_TRUE(tid_list.Contains(i));
+      }
+    }
+  }
+}
+
 }  // namespace noisepage::execution::sql::test
@@ -95,6 +95,33 @@ TEST_F(ChainingHashTableTest, TaggedInsertion) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(ChainingHashTableTest, BatchLookup) {
+  constexpr uint32_t num_entries = 5000;
+  std::vector<TestEntry> entries;
+  for (uint32_t i = 0; i < num_entries; i++) entries.emplace_back(i, i);
+
+  auto check = [&](auto *table) {
+    table->SetSize(num_entries, nullptr);
+    for (auto &entry : entries) table->template Insert<false>(&entry);
+
+    // Half the keys are present. An odd count leaves a tail that isn't a full SIMD group.
+    std::vector<hash_t> hashes;
+    for (uint32_t i = 0; i < num_entries * 2 + 3; i++) hashes.push_back(common::HashUtil::Hash(i));
+
+    std::vector<const HashTableEntry *> heads(hashes.size());
+    table->FindChainHeadBatch(hashes.data(), heads.data(), hashes.size());
+    for (uint32_t i = 0; i < hashes.size(); i++) {
+      EXPECT_EQ(table->FindChainHead(hashes[i]), heads[i]);
+    }
+  };
+
+  UntaggedChainingHashTable untagged;
+  check(&untagged);
+  TaggedChainingHashTable tagged;
+  check(&tagged);
+}
+
 // NOLINTNEXTLINE
 TEST_F(ChainingHashTableTest, ConcurrentInsertion) {
   constexpr uint32_t num_entries = 5000;
@@ -189,4 +189,58 @@ TEST_F(FilterManagerTest, AdaptiveCheckTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(FilterManagerTest, LearnedOrderTest) {
+  auto exec_ctx = MakeExecCtx();
+  FilterOrderCache order_cache;
+
+  // colA < 500 AND colB < 7, where the first term is slower and less selective. Both filters must be given the same
+  // term functions for the second to find the order of the first.
+  const std::vector<FilterManager::MatchFn> terms = {
+      [](auto exec_ctx, auto vp, auto tids, auto ctx) {
+        std::this_thread::sleep_for(50us);  // Fake a sleep.
+        const auto val = GenericValue::CreateInteger(500);
+        VectorFilterExecutor::SelectLessThanVal(
+            reinterpret_cast<exec::ExecutionContext *>(exec_ctx)->GetExecutionSettings(), vp, Col::A, val, tids);
+      },
+      [](auto exec_ctx, auto vp, auto tids, auto ctx) {
+        const auto val = GenericValue::CreateInteger(7);
+        VectorFilterExecutor::SelectLessThanVal(
+            reinterpret_cast<exec::ExecutionContext *>(exec_ctx)->GetExecutionSettings(), vp, Col::B, val, tids);
+      }};
+
+  VectorProjection vp;
+  vp.Initialize({TypeId::Integer, TypeId::Integer});
+  vp.Reset(common::Constants::K_DEFAULT_VECTOR_SIZE);
+  VectorOps::Generate(vp.GetColumn(Col::A), 0, 1);
+  VectorOps::Generate(vp.GetColumn(Col::B), 0, 1);
+
+  // The first execution learns that the second term should run first, and saves that when it is destroyed
+  {
+    FilterManager filter(exec_ctx->GetExecutionSettings(), true, nullptr, common::ManagedPointer(&order_cache));
+    filter.StartNewClause();
+    filter.InsertClauseTerms(terms);
+    for (uint32_t i = 0; i < 1000; i++) {
+      vp.Reset(common::Constants::K_DEFAULT_VECTOR_SIZE);
+      VectorProjectionIterator vpi(&vp);
+      filter.RunFilters(exec_ctx.get(), &vpi);
+    }
+    EXPECT_THAT(filter.GetOptimalClauseOrder()[0]->GetOptimalTermOrder(), ::testing::ElementsAre(1, 0));
+  }
+
+  // The next execution starts from the learned order
+  FilterManager filter(exec_ctx->GetExecutionSettings(), true, nullptr, common::ManagedPointer(&order_cache));
+  filter.StartNewClause();
+  filter.InsertClauseTerms(terms);
+  vp.Reset(common::Constants::K_DEFAULT_VECTOR_SIZE);
+  VectorProjectionIterator vpi(&vp);
+  filter.RunFilters(exec_ctx.get(), &vpi);
+  EXPECT_THAT(filter.GetOptimalClauseOrder()[0]->GetOptimalTermOrder(), ::testing::ElementsAre(1, 0));
+  vpi.ForEach([&]() {
+    auto cola = *vpi.GetValue<int32_t, false>(Col::A, nullptr);
+    auto colb = *vpi.GetValue<int32_t, false>(Col::B, nullptr);
+    EXPECT_TRUE(cola < 500 && colb < 7);
+  });
+}
+
 }  // namespace noisepage::execution::sql::test
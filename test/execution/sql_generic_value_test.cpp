@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "execution/sql/generic_value.h"
+#include "execution/sql/value.h"
 #include "execution/tpl_test.h"
 
 namespace noisepage::execution::sql::test {
@@ -94,4 +95,15 @@ TEST_F(GenericValueTests, Equality) {
   EXPECT_NE(string_val, GenericValue::CreateNull(TypeId::Varchar));
 }
 
+// NOLINTNEXTLINE
+TEST_F(GenericValueTests, FromRuntimeValue) {
+  EXPECT_EQ(GenericValue::CreateInteger(7), GenericValue::CreateFromRuntimeValue(TypeId::Integer, Integer(7)));
+  EXPECT_EQ(GenericValue::CreateVarchar("hello"),
+            GenericValue::CreateFromRuntimeValue(TypeId::Varchar, StringVal("hello")));
+
+  // NULL runtime values stay NULL, whatever their value
+  EXPECT_TRUE(GenericValue::CreateFromRuntimeValue(TypeId::Integer, Integer::Null()).IsNull());
+  EXPECT_TRUE(GenericValue::CreateFromRuntimeValue(TypeId::Varchar, StringVal::Null()).IsNull());
+}
+
 }  // namespace noisepage::execution::sql::test
@@ -1,5 +1,7 @@
 #include <tbb/tbb.h>
 
+#include <algorithm>
+#include <memory>
 #include <random>
 #include <vector>
 
@@ -217,6 +219,223 @@ TEST_F(JoinHashTableTest, ParallelBuildTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, RadixPartitionedBuildTest) {
+  const uint32_t num_tuples = 10000;
+  const uint32_t num_thread_local_tables = 4;
+  tbb::task_scheduler_init sched;
+
+  // No partitioning, a few partitions, and many partitions of only a few buckets each
+  for (const int64_t radix_bits : {0, 3, 10}) {
+    SetJoinBuildPartitionBits(radix_bits);
+    auto exec_ctx = MakeExecCtx();
+
+    ThreadStateContainer container(exec_ctx->GetMemoryPool());
+    container.Reset(
+        sizeof(JoinHashTable),
+        [](void *ctx, void *s) {
+          auto exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+          new (s) JoinHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(Tuple));
+        },
+        [](void *ctx, void *s) { std::destroy_at(reinterpret_cast<JoinHashTable *>(s)); }, exec_ctx.get());
+    LaunchParallel(num_thread_local_tables, [&](auto tid) {
+      PopulateJoinHashTable(container.AccessCurrentThreadStateAs<JoinHashTable>(), num_tuples, 1);
+    });
+
+    JoinHashTable main_jht(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple));
+    main_jht.MergeParallel(&container, 0);
+    EXPECT_EQ(num_tuples * num_thread_local_tables, main_jht.GetTupleCount());
+
+    // Every key finds all of its duplicates, whichever partition they were built in
+    for (uint32_t i = 0; i < num_tuples; i++) {
+      auto probe = Tuple{i, 1, 2, 3};
+      uint32_t count = 0;
+      for (auto iter = main_jht.Lookup<false>(probe.Hash()); iter.HasNext();) {
+        count += reinterpret_cast<const Tuple *>(iter.GetMatchPayload())->a_ == probe.a_;
+      }
+      EXPECT_EQ(num_thread_local_tables, count);
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, CompactLayoutTest) {
+  const uint32_t num_tuples = 10000;
+  const uint32_t dup_scale_factor = 4;
+  tbb::task_scheduler_init sched;
+
+  // Built serially, the table spans several slices of buckets that are laid out in parallel
+  for (const bool parallel : {false, true}) {
+    auto exec_ctx = MakeExecCtx();
+    JoinHashTable join_hash_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple));
+    join_hash_table.EnableCompactLayout();
+
+    ThreadStateContainer container(exec_ctx->GetMemoryPool());
+    if (parallel) {
+      container.Reset(
+          sizeof(JoinHashTable),
+          [](void *ctx, void *s) {
+            auto exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+            new (s) JoinHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(Tuple));
+          },
+          [](void *ctx, void *s) { std::destroy_at(reinterpret_cast<JoinHashTable *>(s)); }, exec_ctx.get());
+      LaunchParallel(dup_scale_factor, [&](auto tid) {
+        PopulateJoinHashTable(container.AccessCurrentThreadStateAs<JoinHashTable>(), num_tuples, 1);
+      });
+      join_hash_table.MergeParallel(&container, 0);
+    } else {
+      PopulateJoinHashTable(&join_hash_table, num_tuples, dup_scale_factor);
+      join_hash_table.Build();
+    }
+
+    // Only the tuples themselves are stored
+    ASSERT_TRUE(join_hash_table.UsingCompactLayout());
+    EXPECT_EQ(num_tuples * dup_scale_factor, join_hash_table.GetTupleCount());
+    EXPECT_EQ(num_tuples * dup_scale_factor * sizeof(Tuple), join_hash_table.GetBufferedTupleMemoryUsage());
+
+    // Every key finds all of its duplicates, and keys that were not inserted find no partner
+    for (uint32_t i = 0; i < num_tuples * 2; i++) {
+      auto probe = Tuple{i, 1, 2, 3};
+      uint32_t count = 0;
+      for (auto iter = join_hash_table.Lookup<false>(probe.Hash()); iter.HasNext();) {
+        count += reinterpret_cast<const Tuple *>(iter.GetMatchPayload())->a_ == probe.a_;
+      }
+      EXPECT_EQ(i < num_tuples ? dup_scale_factor : 0, count);
+    }
+
+    // Iteration visits every tuple once
+    std::vector<uint32_t> counts(num_tuples, 0);
+    for (JoinHashTableIterator iter(join_hash_table); iter.HasNext(); iter.Next()) {
+      counts[iter.GetCurrentRowAs<Tuple>()->a_]++;
+    }
+    EXPECT_TRUE(std::all_of(counts.begin(), counts.end(), [&](auto count) { return count == dup_scale_factor; }));
+  }
+
+  // Disabled in the settings, the table keeps its entries
+  SetJoinCompactLayoutEnabled(false);
+  auto exec_ctx = MakeExecCtx();
+  JoinHashTable join_hash_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple));
+  join_hash_table.EnableCompactLayout();
+  PopulateJoinHashTable(&join_hash_table, num_tuples, 1);
+  join_hash_table.Build();
+  EXPECT_FALSE(join_hash_table.UsingCompactLayout());
+  EXPECT_EQ(num_tuples, join_hash_table.GetTupleCount());
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, SpillTest) {
+  // A quarter of the build side fits into the budget
+  const uint32_t num_tuples = 10000;
+  const uint32_t dup_scale_factor = 4;
+  SetJoinMemoryBudget(num_tuples * dup_scale_factor * HashTableEntry::ComputeEntrySize(sizeof(Tuple)) / 4);
+  auto exec_ctx = MakeExecCtx();
+  tbb::task_scheduler_init sched;
+
+  struct QueryState {
+    JoinHashTable *jht_;
+    std::vector<uint32_t> match_counts_;
+
+    void Probe(const Tuple &probe) {
+      for (auto iter = jht_->Lookup<false>(probe.Hash()); iter.HasNext();) {
+        if (reinterpret_cast<const Tuple *>(iter.GetMatchPayload())->a_ == probe.a_) {
+          match_counts_[probe.a_]++;
+        }
+      }
+    }
+  };
+
+  // Probe with keys of which half find partners, once the table is built either serially or in parallel
+  for (const bool parallel : {false, true}) {
+    JoinHashTable join_hash_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple));
+    join_hash_table.EnableSpilling(sizeof(Tuple));
+
+    ThreadStateContainer container(exec_ctx->GetMemoryPool());
+    if (parallel) {
+      container.Reset(
+          sizeof(JoinHashTable),
+          [](void *ctx, void *s) {
+            auto exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+            new (s) JoinHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(Tuple));
+          },
+          [](void *ctx, void *s) { std::destroy_at(reinterpret_cast<JoinHashTable *>(s)); }, exec_ctx.get());
+      LaunchParallel(dup_scale_factor, [&](auto tid) {
+        PopulateJoinHashTable(container.AccessCurrentThreadStateAs<JoinHashTable>(), num_tuples, 1);
+      });
+      join_hash_table.MergeParallel(&container, 0);
+    } else {
+      PopulateJoinHashTable(&join_hash_table, num_tuples, dup_scale_factor);
+      join_hash_table.Build();
+    }
+
+    ASSERT_TRUE(join_hash_table.HasSpilledPartitions());
+    EXPECT_LT(join_hash_table.GetTupleCount(), num_tuples * dup_scale_factor);
+
+    QueryState query_state{&join_hash_table, std::vector<uint32_t>(num_tuples * 2)};
+    for (uint32_t i = 0; i < num_tuples * 2; i++) {
+      const auto probe = Tuple{i, 0, 0, 0};
+      if (join_hash_table.IsSpilled(probe.Hash())) {
+        join_hash_table.SpillProbeTuple(probe.Hash(), reinterpret_cast<const byte *>(&probe));
+      } else {
+        query_state.Probe(probe);
+      }
+    }
+    join_hash_table.ProcessSpilledPartitions(&query_state, nullptr, [](void *qs, void *, const byte *probe) {
+      reinterpret_cast<QueryState *>(qs)->Probe(*reinterpret_cast<const Tuple *>(probe));
+    });
+    EXPECT_FALSE(join_hash_table.HasSpilledPartitions());
+
+    // Every key found all of its partners exactly once
+    for (uint32_t i = 0; i < num_tuples * 2; i++) {
+      EXPECT_EQ(i < num_tuples ? dup_scale_factor : 0, query_state.match_counts_[i]) << "key " << i;
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinHashTableTest, RuntimeFilterTest) {
+  const uint32_t num_tuples = 10000;
+  auto exec_ctx = MakeExecCtx();
+  tbb::task_scheduler_init sched;
+
+  // The filter covers the whole build side, whether the table is built serially or in parallel
+  for (const bool parallel : {false, true}) {
+    JoinHashTable join_hash_table(exec_ctx->GetExecutionSettings(), exec_ctx.get(), sizeof(Tuple));
+    EXPECT_TRUE(join_hash_table.MayContain(Tuple{num_tuples, 0, 0, 0}.Hash()));
+    join_hash_table.EnableRuntimeFilter();
+
+    ThreadStateContainer container(exec_ctx->GetMemoryPool());
+    if (parallel) {
+      container.Reset(
+          sizeof(JoinHashTable),
+          [](void *ctx, void *s) {
+            auto exec_ctx = reinterpret_cast<exec::ExecutionContext *>(ctx);
+            new (s) JoinHashTable(exec_ctx->GetExecutionSettings(), exec_ctx, sizeof(Tuple));
+          },
+          [](void *ctx, void *s) { std::destroy_at(reinterpret_cast<JoinHashTable *>(s)); }, exec_ctx.get());
+      LaunchParallel(4, [&](auto tid) {
+        PopulateJoinHashTable(container.AccessCurrentThreadStateAs<JoinHashTable>(), num_tuples, 1);
+      });
+      join_hash_table.MergeParallel(&container, 0);
+    } else {
+      PopulateJoinHashTable(&join_hash_table, num_tuples, 1);
+      join_hash_table.Build();
+    }
+
+    ASSERT_TRUE(join_hash_table.HasBloomFilter());
+    uint32_t num_passed = 0;
+    for (uint32_t i = 0; i < num_tuples * 2; i++) {
+      const bool may_contain = join_hash_table.MayContain(Tuple{i, 0, 0, 0}.Hash());
+      if (i < num_tuples) {
+        EXPECT_TRUE(may_contain) << "key " << i;
+      } else {
+        num_passed += static_cast<uint32_t>(may_contain);
+      }
+    }
+    // Most keys without a partner are ruled out
+    EXPECT_LT(num_passed, num_tuples / 10);
+  }
+}
+
 #if 0
 // NOLINTNEXTLINE
 TEST_F(JoinHashTableTest, PerfTest) {
@@ -1,6 +1,10 @@
+#include <cstdlib>
+#include <thread>  // NOLINT
 #include <utility>
+#include <vector>
 
 #include "execution/sql/memory_pool.h"
+#include "execution/sql/memory_tracker.h"
 #include "execution/tpl_test.h"
 
 namespace noisepage::execution::sql::test {
@@ -59,4 +63,43 @@ TEST_F(MemoryPoolTest, ComplexPointers) {
   pool.DeleteObject(std::move(obj1));
 }
 
+// NOLINTNEXTLINE
+TEST_F(MemoryPoolTest, SlabAllocations) {
+  MemoryTracker tracker;
+  MemoryPool pool{common::ManagedPointer<MemoryTracker>(&tracker)};
+
+  // Threads allocate, fill and free blocks of all size classes, some of which other threads allocated first
+  const std::vector<std::size_t> sizes = {1, 8, 24, 64, 100, 1000, 4096, 5000, MemoryPool::MAX_SLAB_ALLOCATION_SIZE};
+  auto work = [&](const uint32_t thread_idx) {
+    for (uint32_t round = 0; round < 10; round++) {
+      std::vector<std::pair<std::byte *, std::size_t>> allocations;
+      for (uint32_t i = 0; i < 100; i++) {
+        const auto size = sizes[(i + thread_idx) % sizes.size()];
+        auto *ptr = static_cast<std::byte *>(pool.AllocateAligned(size, alignof(uint64_t), i % 2 == 0));
+        EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(ptr) % MemoryPool::SLAB_ALLOCATION_ALIGNMENT);
+        if (i % 2 == 0) {
+          EXPECT_EQ(std::to_integer<uint32_t>(ptr[size - 1]), 0u);
+        }
+        std::memset(ptr, static_cast<int>(thread_idx), size);
+        allocations.emplace_back(ptr, size);
+      }
+      for (const auto &[ptr, size] : allocations) {
+        EXPECT_EQ(std::to_integer<uint32_t>(ptr[0]), thread_idx);
+        EXPECT_EQ(std::to_integer<uint32_t>(ptr[size - 1]), thread_idx);
+        pool.Deallocate(ptr, size);
+      }
+    }
+  };
+  std::vector<std::thread> threads;
+  for (uint32_t thread_idx = 0; thread_idx < 4; thread_idx++) {
+    threads.emplace_back(work, thread_idx);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // Everything was freed, up to what the threads haven't merged into the total yet
+  EXPECT_LT(std::abs(tracker.GetTotalAllocatedSize()), 4 * MemoryTracker::MERGE_THRESHOLD);
+}
+
 }  // namespace noisepage::execution::sql::test
@@ -158,6 +158,118 @@ TEST_F(SorterTest, TopKTest) {
   TestAllIntegral(TestTopKRandomTupleSize, exec_ctx.get(), num_iters, max_elems, &generator_);
 }
 
+// NOLINTNEXTLINE
+TEST_F(SorterTest, SpillSortTest) {
+  // Every 1000 buffered tuples are spilled as a sorted run
+  SetSortMemoryBudget(1000 * sizeof(int64_t));
+  auto exec_ctx = MakeExecCtx();
+  const auto cmp_fn = [](const void *a, const void *b) -> int32_t {
+    const auto val_a = *reinterpret_cast<const int64_t *>(a);
+    const auto val_b = *reinterpret_cast<const int64_t *>(b);
+    return val_a < val_b ? -1 : (val_a == val_b ? 0 : 1);
+  };
+
+  for (const uint32_t num_elems : {999, 1000, 1001, 50000}) {
+    std::uniform_int_distribution<int64_t> rng(0, num_elems / 2);
+    std::vector<int64_t> reference;
+    Sorter sorter(exec_ctx.get(), cmp_fn, sizeof(int64_t));
+    for (uint32_t i = 0; i < num_elems; i++) {
+      reference.push_back(rng(generator_));
+      *reinterpret_cast<int64_t *>(sorter.AllocInputTuple()) = reference.back();
+    }
+
+    std::sort(reference.begin(), reference.end());
+    sorter.Sort();
+    EXPECT_EQ(num_elems > 1000, sorter.IsSpilled());
+    EXPECT_EQ(num_elems, sorter.GetTupleCount());
+
+    SorterIterator iter(sorter);
+    for (uint32_t i = 0; i < num_elems; i++) {
+      EXPECT_EQ(*reinterpret_cast<const int64_t *>(*iter), reference[i]);
+      ++iter;
+    }
+    EXPECT_FALSE(iter.HasNext());
+
+    // Skipping rows on disk lands on the right row
+    SorterIterator skip_iter(sorter);
+    skip_iter.AdvanceBy(num_elems / 3);
+    EXPECT_EQ(num_elems - num_elems / 3, skip_iter.NumRemaining());
+    EXPECT_EQ(*reinterpret_cast<const int64_t *>(*skip_iter), reference[num_elems / 3]);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, NormalizedKeySortTest) {
+  using Tuple = std::pair<int64_t, int64_t>;
+  const auto cmp_fn = [](const void *a, const void *b) -> int32_t {
+    const auto &val_a = *reinterpret_cast<const Tuple *>(a);
+    const auto &val_b = *reinterpret_cast<const Tuple *>(b);
+    return val_a < val_b ? -1 : (val_a == val_b ? 0 : 1);
+  };
+  // Only the upper bits of the first column, so that many tuples tie on their key
+  const auto key_fn = [](const void *a) -> uint64_t {
+    const auto first = reinterpret_cast<const Tuple *>(a)->first;
+    return (static_cast<uint64_t>(first) ^ (uint64_t{1} << 63u)) >> 20u;
+  };
+
+  for (const int64_t memory_budget : {int64_t{0}, int64_t{1000 * sizeof(Tuple)}}) {
+    SetSortMemoryBudget(memory_budget);
+    auto exec_ctx = MakeExecCtx();
+    for (const uint32_t num_elems : {1, 100, 50000}) {
+      std::uniform_int_distribution<int64_t> rng(-(int64_t{1} << 30), int64_t{1} << 30);
+      std::vector<Tuple> reference;
+      Sorter sorter(exec_ctx.get(), cmp_fn, sizeof(Tuple));
+      sorter.SetNormalizedKeyFunction(key_fn);
+      for (uint32_t i = 0; i < num_elems; i++) {
+        reference.emplace_back(rng(generator_), rng(generator_) % 10);
+        *reinterpret_cast<Tuple *>(sorter.AllocInputTuple()) = reference.back();
+      }
+
+      std::sort(reference.begin(), reference.end());
+      sorter.Sort();
+
+      SorterIterator iter(sorter);
+      for (uint32_t i = 0; i < num_elems; i++) {
+        EXPECT_EQ(*reinterpret_cast<const Tuple *>(*iter), reference[i]);
+        ++iter;
+      }
+      EXPECT_FALSE(iter.HasNext());
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(SorterTest, TopKBoundTest) {
+  const auto cmp_fn = [](const void *a, const void *b) -> int32_t {
+    const auto val_a = *reinterpret_cast<const int64_t *>(a);
+    const auto val_b = *reinterpret_cast<const int64_t *>(b);
+    return val_a < val_b ? -1 : (val_a == val_b ? 0 : 1);
+  };
+  const auto key_fn = [](const void *a) -> uint64_t {
+    return static_cast<uint64_t>(*reinterpret_cast<const int64_t *>(a)) ^ (uint64_t{1} << 63u);
+  };
+  const uint32_t top_k = 10, num_elems = 1000;
+  auto exec_ctx = MakeExecCtx();
+  Sorter sorter(exec_ctx.get(), cmp_fn, sizeof(int64_t)), shared(exec_ctx.get(), cmp_fn, sizeof(int64_t));
+  sorter.SetNormalizedKeyFunction(key_fn);
+  sorter.ShareTopKBound(&shared);
+
+  // Nothing is ruled out until the heap is full, then the bound is the key of the K-th smallest value so far
+  std::uniform_int_distribution<int64_t> rng(-1000000, 1000000);
+  std::vector<int64_t> reference;
+  for (uint32_t i = 0; i < num_elems; i++) {
+    reference.push_back(rng(generator_));
+    *reinterpret_cast<int64_t *>(sorter.AllocInputTupleTopK(top_k)) = reference.back();
+    sorter.AllocInputTupleTopKFinish(top_k);
+
+    std::vector<int64_t> sorted = reference;
+    std::sort(sorted.begin(), sorted.end());
+    const uint64_t expected = reference.size() < top_k ? ~uint64_t{0} : key_fn(&sorted[top_k - 1]);
+    EXPECT_EQ(expected, sorter.GetTopKBound());
+    EXPECT_EQ(expected, shared.GetTopKBound());
+  }
+}
+
 template <uint32_t N>
 struct TestTuple {
   uint32_t key_;
@@ -262,4 +374,15 @@ TEST_F(SorterTest, UnbalancedParallelSortTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(SorterTest, SpillParallelSortTest) {
+  // Thread-local sorters spill a sorted run every 100 tuples, and the runs are
+  // merged on disk
+  SetSortMemoryBudget(100 * sizeof(TestTuple<2>));
+  auto exec_ctx = MakeExecCtx();
+  TestParallelSort<2>(exec_ctx.get(), {1000});
+  TestParallelSort<2>(exec_ctx.get(), {1000, 10, 5000, 0});
+  TestParallelSort<2>(exec_ctx.get(), {10000, 10000, 10000, 10000});
+}
+
 }  // namespace noisepage::execution::sql::test
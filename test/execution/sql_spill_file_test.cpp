@@ -0,0 +1,42 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "execution/sql/spill_file.h"
+#include "execution/tpl_test.h"
+
+namespace noisepage::execution::sql::test {
+
+class SpillFileTest : public TplTest {};
+
+// NOLINTNEXTLINE
+TEST_F(SpillFileTest, AppendAndRead) {
+  SpillFile file;
+  EXPECT_EQ(file.GetSize(), 0);
+
+  // Two blocks of random bytes, the second one larger than a read buffer would typically be
+  std::mt19937 generator;
+  std::vector<byte> small(100), large(10 << 20);
+  for (auto &b : small) b = static_cast<byte>(generator());
+  for (auto &b : large) b = static_cast<byte>(generator());
+
+  EXPECT_EQ(file.Append(small.data(), small.size()), 0);
+  EXPECT_EQ(file.Append(large.data(), large.size()), small.size());
+  EXPECT_EQ(file.GetSize(), small.size() + large.size());
+
+  // Read back in a different order and at offsets that straddle the blocks
+  std::vector<byte> read(large.size());
+  file.Read(small.size(), read.data(), large.size());
+  EXPECT_EQ(read, large);
+
+  read.resize(small.size());
+  file.Read(0, read.data(), small.size());
+  EXPECT_EQ(read, small);
+
+  read.resize(20);
+  file.Read(90, read.data(), 20);
+  EXPECT_TRUE(std::equal(small.begin() + 90, small.end(), read.begin()));
+  EXPECT_TRUE(std::equal(large.begin(), large.begin() + 10, read.begin() + 10));
+}
+
+}  // namespace noisepage::execution::sql::test
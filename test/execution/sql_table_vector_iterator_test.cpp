@@ -1,4 +1,5 @@
 #include <array>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -131,6 +132,104 @@ TEST_F(TableVectorIteratorTest, IteratorColOidsTest) {
   EXPECT_EQ(sql::TEST2_SIZE, num_tuples);
 }
 
+// NOLINTNEXTLINE
+TEST_F(TableVectorIteratorTest, SampleBlocksTest) {
+  //
+  // A sample of at least as many blocks as the table has reads the whole table, and the counts need no scaling
+  //
+
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "test_1");
+  const uint32_t num_blocks = exec_ctx_->GetAccessor()->GetTable(table_oid)->GetNumBlocks();
+  std::array<uint32_t, 1> col_oids{1};
+  TableVectorIterator iter(exec_ctx_.get(), table_oid.UnderlyingValue(), col_oids.data(),
+                           static_cast<uint32_t>(col_oids.size()));
+  iter.Init();
+  iter.SampleBlocks(num_blocks);
+
+  uint32_t num_tuples = 0;
+  while (iter.Advance()) {
+    num_tuples += iter.GetVectorProjectionIterator()->GetTotalTupleCount();
+  }
+  EXPECT_EQ(sql::TEST1_SIZE, num_tuples);
+  EXPECT_EQ(sql::TEST1_SIZE, exec_ctx_->ScaleSampledCount(num_tuples));
+
+  // A sample of a tenth of the table scales the counts over it up tenfold
+  exec_ctx_->SetSampleScale(10.0);
+  EXPECT_EQ(1000, exec_ctx_->ScaleSampledCount(100));
+  // Few distinct values in the sample are taken to be all of them
+  EXPECT_EQ(5, exec_ctx_->ScaleSampledDistinct(5, 100));
+  // Many distinct values scale with the table, but there are never more of them than values
+  EXPECT_EQ(500, exec_ctx_->ScaleSampledDistinct(50, 100));
+  EXPECT_EQ(1000, exec_ctx_->ScaleSampledDistinct(100, 100));
+}
+
+// NOLINTNEXTLINE
+TEST_F(TableVectorIteratorTest, LateMaterializeTest) {
+  //
+  // A column read only for the tuples that pass a filter holds the same values as when it is read with the projection
+  //
+
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "test_1");
+  // colB is filtered on, colA is read late
+  std::array<uint32_t, 2> col_oids{2, 1};
+
+  auto scan = [&](bool late) {
+    TableVectorIterator iter(exec_ctx_.get(), table_oid.UnderlyingValue(), col_oids.data(),
+                             static_cast<uint32_t>(col_oids.size()));
+    iter.Init();
+    if (late) iter.LateMaterialize(1);
+    std::vector<int32_t> values;
+    while (iter.Advance()) {
+      auto *vpi = iter.GetVectorProjectionIterator();
+      vpi->RunFilter([vpi] { return *vpi->GetValue<int32_t, false>(0, nullptr) == 0; });
+      iter.FetchLateColumns();
+      for (; vpi->HasNext(); vpi->Advance()) {
+        values.push_back(*vpi->GetValue<int32_t, false>(1, nullptr));
+      }
+    }
+    return values;
+  };
+
+  const std::vector<int32_t> expected = scan(false);
+  EXPECT_FALSE(expected.empty());
+  EXPECT_EQ(expected, scan(true));
+}
+
+// NOLINTNEXTLINE
+TEST_F(TableVectorIteratorTest, SharedScanTest) {
+  //
+  // A scan of a table that shares its scans starts where the latest one is, and still reads every tuple once
+  //
+
+  auto table_oid = exec_ctx_->GetAccessor()->GetTableOid(NSOid(), "test_1");
+  auto table = exec_ctx_->GetAccessor()->GetTable(table_oid);
+  table->SetSharedScans(true);
+  std::array<uint32_t, 1> col_oids{1};
+
+  auto scan = [&](uint32_t max_vectors) {
+    TableVectorIterator iter(exec_ctx_.get(), table_oid.UnderlyingValue(), col_oids.data(),
+                             static_cast<uint32_t>(col_oids.size()));
+    iter.Init();
+    std::vector<bool> seen(sql::TEST1_SIZE, false);
+    uint32_t num_tuples = 0;
+    for (uint32_t num_vectors = 0; num_vectors < max_vectors && iter.Advance(); num_vectors++) {
+      for (auto *vpi = iter.GetVectorProjectionIterator(); vpi->HasNext(); vpi->Advance()) {
+        const auto *val = vpi->GetValue<int32_t, false>(0, nullptr);
+        EXPECT_FALSE(seen[*val]);
+        seen[*val] = true;
+        num_tuples++;
+      }
+    }
+    return num_tuples;
+  };
+
+  // The first scan stops midway through the table, and the next one joins it there
+  const uint32_t num_blocks = table->GetNumBlocks();
+  scan(num_blocks / 2 + 1);
+  EXPECT_EQ(sql::TEST1_SIZE, scan(std::numeric_limits<uint32_t>::max()));
+  table->SetSharedScans(false);
+}
+
 // NOLINTNEXTLINE
 TEST_F(TableVectorIteratorTest, ParallelScanTest) {
   //
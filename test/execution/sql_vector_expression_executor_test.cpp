@@ -0,0 +1,51 @@
+#include "execution/exec/execution_settings.h"
+#include "execution/sql/tuple_id_list.h"
+#include "execution/sql/vector_expression_executor.h"
+#include "execution/sql/vector_operations/vector_operations.h"
+#include "execution/sql/vector_projection.h"
+#include "execution/tpl_test.h"
+
+namespace noisepage::execution::sql::test {
+
+class VectorExpressionExecutorTest : public TplTest {};
+
+// NOLINTNEXTLINE
+TEST_F(VectorExpressionExecutorTest, ExtendedProjectionArithmetic) {
+  exec::ExecutionSettings exec_settings{};
+
+  // col0 = [0,1,2,3,4,5,6,7,8,9]
+  // col1 = [0.0,1.0,2.0,...,9.0]
+  VectorProjection input;
+  input.Initialize({TypeId::Integer, TypeId::Double});
+  input.Reset(10);
+  VectorOps::Generate(input.GetColumn(0), 0, 1);
+  VectorOps::Generate(input.GetColumn(1), 0, 1);
+
+  TupleIdList tid_list(input.GetTotalTupleCount());
+  tid_list = {1, 3, 9};
+  input.SetFilteredSelections(tid_list);
+
+  // col2 = bigint(col0), col3 = col2 * 10, col4 = col3 - col2, col5 = 1.0 - col1
+  VectorProjection result;
+  result.Initialize({TypeId::Integer, TypeId::Double, TypeId::BigInt, TypeId::BigInt, TypeId::BigInt,
+                     TypeId::Double});
+  VectorExpressionExecutor::Extend(&result, &input);
+  VectorExpressionExecutor::Cast(exec_settings, &result, 2, 0);
+  VectorExpressionExecutor::MultiplyVal(exec_settings, &result, 3, 2, Integer(10));
+  VectorExpressionExecutor::Subtract(exec_settings, &result, 4, 3, 2);
+  VectorExpressionExecutor::SubtractFromVal(exec_settings, &result, 5, Real(1.0), 1);
+
+  // The extended projection keeps the selections of its input.
+  EXPECT_TRUE(result.IsFiltered());
+  EXPECT_EQ(3u, result.GetSelectedTupleCount());
+  EXPECT_EQ(GenericValue::CreateInteger(3), result.GetColumn(0)->GetValue(1));
+  EXPECT_EQ(GenericValue::CreateBigInt(9), result.GetColumn(4)->GetValue(0));
+  EXPECT_EQ(GenericValue::CreateBigInt(27), result.GetColumn(4)->GetValue(1));
+  EXPECT_EQ(GenericValue::CreateBigInt(81), result.GetColumn(4)->GetValue(2));
+  EXPECT_EQ(GenericValue::CreateDouble(0.0), result.GetColumn(5)->GetValue(0));
+  EXPECT_EQ(GenericValue::CreateDouble(-2.0), result.GetColumn(5)->GetValue(1));
+  EXPECT_EQ(GenericValue::CreateDouble(-8.0), result.GetColumn(5)->GetValue(2));
+  result.CheckIntegrity();
+}
+
+}  // namespace noisepage::execution::sql::test
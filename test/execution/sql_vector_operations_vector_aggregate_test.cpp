@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "common/error/exception.h"
+#include "execution/sql/aggregators.h"
+#include "execution/sql/tuple_id_list.h"
+#include "execution/sql/vector.h"
+#include "execution/sql/vector_operations/vector_operations.h"
+#include "execution/sql_test.h"
+
+namespace noisepage::execution::sql::test {
+
+class VectorAggregateTest : public TplTest {};
+
+// NULLs and tuples outside the filter are skipped, and nothing is written without a value
+// NOLINTNEXTLINE
+TEST_F(VectorAggregateTest, FilteredWithNulls) {
+  // vec = [1, -5, NULL, 7, 3]
+  auto vec = MakeIntegerVector({1, -5, 0, 7, 3}, {false, false, true, false, false});
+  int64_t result = 0;
+
+  EXPECT_EQ(4, VectorOps::CountNotNull(*vec));
+  EXPECT_TRUE(VectorOps::Sum(*vec, &result));
+  EXPECT_EQ(6, result);
+  EXPECT_TRUE(VectorOps::Min(*vec, &result));
+  EXPECT_EQ(-5, result);
+  EXPECT_TRUE(VectorOps::Max(*vec, &result));
+  EXPECT_EQ(7, result);
+
+  auto tids = TupleIdList(vec->GetSize());
+  tids = {2, 3, 4};
+  vec->SetFilteredTupleIdList(&tids, tids.GetTupleCount());
+  EXPECT_EQ(2, VectorOps::CountNotNull(*vec));
+  EXPECT_TRUE(VectorOps::Sum(*vec, &result));
+  EXPECT_EQ(10, result);
+  EXPECT_TRUE(VectorOps::Min(*vec, &result));
+  EXPECT_EQ(3, result);
+
+  // Only the NULL is left
+  tids = {2};
+  vec->SetFilteredTupleIdList(&tids, tids.GetTupleCount());
+  result = 42;
+  EXPECT_EQ(0, VectorOps::CountNotNull(*vec));
+  EXPECT_FALSE(VectorOps::Sum(*vec, &result));
+  EXPECT_FALSE(VectorOps::Max(*vec, &result));
+  EXPECT_EQ(42, result);
+
+  // Integers fold into integers only, and reals into reals
+  double real_result;
+  EXPECT_THROW(VectorOps::Sum(*vec, &real_result), ExecutionException);
+  auto reals = MakeDoubleVector({1.5, 2.5}, {false, false});
+  EXPECT_THROW(VectorOps::Sum(*reals, &result), ExecutionException);
+  EXPECT_TRUE(VectorOps::Sum(*reals, &real_result));
+  EXPECT_DOUBLE_EQ(4.0, real_result);
+}
+
+// The aggregates advanced a vector at a time agree with the ones advanced a tuple at a time, whether
+// whole words of the vector are selected, some of them, or none
+// NOLINTNEXTLINE
+TEST_F(VectorAggregateTest, AgreesWithTupleAtATime) {
+  std::default_random_engine generator;
+  std::uniform_int_distribution<int32_t> value_dist(std::numeric_limits<int32_t>::min(),
+                                                    std::numeric_limits<int32_t>::max());
+  std::uniform_real_distribution<double> real_dist(-1000.0, 1000.0);
+  std::uniform_int_distribution<uint32_t> percent_dist(0, 99);
+
+  for (const uint32_t size : {common::Constants::K_DEFAULT_VECTOR_SIZE, 1000u, 63u}) {
+    for (const uint32_t null_percent : {0u, 1u, 50u}) {
+      for (const uint32_t selected_percent : {100u, 99u, 10u, 0u}) {
+        std::vector<int32_t> ints(size);
+        std::vector<double> reals(size);
+        std::vector<bool> nulls(size), selected(size);
+        for (uint32_t i = 0; i < size; i++) {
+          ints[i] = value_dist(generator);
+          reals[i] = real_dist(generator);
+          nulls[i] = percent_dist(generator) < null_percent;
+          selected[i] = percent_dist(generator) < selected_percent;
+        }
+        auto int_vec = MakeIntegerVector(ints, nulls);
+        auto real_vec = MakeDoubleVector(reals, nulls);
+        auto tids = TupleIdList(size);
+        for (uint32_t i = 0; i < size; i++) {
+          if (selected[i]) tids.Add(i);
+        }
+        if (selected_percent != 100) {
+          int_vec->SetFilteredTupleIdList(&tids, tids.GetTupleCount());
+          real_vec->SetFilteredTupleIdList(&tids, tids.GetTupleCount());
+        }
+
+        CountAggregate count, expected_count;
+        IntegerSumAggregate sum, expected_sum;
+        IntegerMinAggregate min, expected_min;
+        IntegerMaxAggregate max, expected_max;
+        RealSumAggregate real_sum, expected_real_sum;
+        RealMinAggregate real_min, expected_real_min;
+        RealMaxAggregate real_max, expected_real_max;
+        for (uint32_t i = 0; i < size; i++) {
+          if (!selected[i]) continue;
+          auto val = nulls[i] ? Integer::Null() : Integer(ints[i]);
+          auto real_val = nulls[i] ? Real::Null() : Real(reals[i]);
+          expected_count.Advance(val);
+          expected_sum.Advance(val);
+          expected_min.Advance(val);
+          expected_max.Advance(val);
+          expected_real_sum.Advance(real_val);
+          expected_real_min.Advance(real_val);
+          expected_real_max.Advance(real_val);
+        }
+        count.AdvanceVector(*int_vec);
+        sum.AdvanceVector(*int_vec);
+        min.AdvanceVector(*int_vec);
+        max.AdvanceVector(*int_vec);
+        real_sum.AdvanceVector(*real_vec);
+        real_min.AdvanceVector(*real_vec);
+        real_max.AdvanceVector(*real_vec);
+
+        EXPECT_EQ(expected_count.GetCountResult().val_, count.GetCountResult().val_);
+        EXPECT_EQ(expected_sum.GetResultSum().is_null_, sum.GetResultSum().is_null_);
+        EXPECT_EQ(expected_sum.GetResultSum().val_, sum.GetResultSum().val_);
+        EXPECT_EQ(expected_min.GetResultMin().is_null_, min.GetResultMin().is_null_);
+        EXPECT_EQ(expected_min.GetResultMin().val_, min.GetResultMin().val_);
+        EXPECT_EQ(expected_max.GetResultMax().is_null_, max.GetResultMax().is_null_);
+        EXPECT_EQ(expected_max.GetResultMax().val_, max.GetResultMax().val_);
+        EXPECT_EQ(expected_real_sum.GetResultSum().is_null_, real_sum.GetResultSum().is_null_);
+        EXPECT_NEAR(expected_real_sum.GetResultSum().val_, real_sum.GetResultSum().val_, 1e-6);
+        EXPECT_EQ(expected_real_min.GetResultMin().is_null_, real_min.GetResultMin().is_null_);
+        EXPECT_DOUBLE_EQ(expected_real_min.GetResultMin().val_, real_min.GetResultMin().val_);
+        EXPECT_EQ(expected_real_max.GetResultMax().is_null_, real_max.GetResultMax().is_null_);
+        EXPECT_DOUBLE_EQ(expected_real_max.GetResultMax().val_, real_max.GetResultMax().val_);
+      }
+    }
+  }
+}
+
+}  // namespace noisepage::execution::sql::test
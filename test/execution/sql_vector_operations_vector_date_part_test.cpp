@@ -0,0 +1,102 @@
+#include <random>
+#include <vector>
+
+#include "common/error/exception.h"
+#include "execution/sql/functions/date_time_functions.h"
+#include "execution/sql/vector.h"
+#include "execution/sql/vector_operations/vector_operations.h"
+#include "execution/sql_test.h"
+
+namespace noisepage::execution::sql::test {
+
+class VectorDatePartTest : public TplTest {};
+
+// The vector kernels agree with the tuple-at-a-time functions, across centuries, leap years and
+// the turn of every month
+// NOLINTNEXTLINE
+TEST_F(VectorDatePartTest, Timestamps) {
+  exec::ExecutionSettings exec_settings{};
+
+  std::default_random_engine generator;
+  std::uniform_int_distribution<int32_t> year_dist(1, 2500), month_dist(1, 12), day_dist(1, 28), hour_dist(0, 23),
+      minute_dist(0, 59);
+  std::vector<Timestamp> timestamps;
+  for (uint64_t i = 0; i < common::Constants::K_DEFAULT_VECTOR_SIZE; i++) {
+    // The last days of months test the most
+    const int32_t day = i % 4 == 0 ? 28 + static_cast<int32_t>(i % 3) : day_dist(generator);
+    const int32_t month = day > 28 ? 1 : month_dist(generator);
+    timestamps.push_back(Timestamp::FromYMDHMSMU(year_dist(generator), month, day, hour_dist(generator),
+                                                 minute_dist(generator), minute_dist(generator), i % 1000,
+                                                 (i * 7) % 1000));
+  }
+  auto input = MakeVector(TypeId::Timestamp, timestamps.size());
+  for (uint64_t i = 0; i < timestamps.size(); i++) {
+    input->SetValue(i, GenericValue::CreateTimestamp(timestamps[i]));
+  }
+  auto result = Vector(TypeId::Integer, true, false);
+
+#define CHECK_PART(PART, FUNCTION)                                               \
+  {                                                                              \
+    VectorOps::DatePart(exec_settings, *input, DatePartType::PART, &result);     \
+    EXPECT_EQ(input->GetCount(), result.GetCount());                             \
+    for (uint64_t i = 0; i < timestamps.size(); i++) {                           \
+      Integer expected(0);                                                       \
+      DateTimeFunctions::FUNCTION(&expected, TimestampVal(timestamps[i]));       \
+      EXPECT_EQ(GenericValue::CreateInteger(expected.val_), result.GetValue(i)); \
+    }                                                                            \
+  }
+
+  CHECK_PART(CENTURY, Century);
+  CHECK_PART(DECADE, Decade);
+  CHECK_PART(YEAR, Year);
+  CHECK_PART(QUARTER, Quarter);
+  CHECK_PART(MONTH, Month);
+  CHECK_PART(DAY, Day);
+  CHECK_PART(DOW, DayOfWeek);
+  CHECK_PART(DOY, DayOfYear);
+  CHECK_PART(HOUR, Hour);
+  CHECK_PART(MINUTE, Minute);
+  CHECK_PART(SECOND, Second);
+  CHECK_PART(MILLISECOND, Millisecond);
+  CHECK_PART(MICROSECOND, Microseconds);
+#undef CHECK_PART
+}
+
+// Dates are at midnight, and keep the NULLs and the filter of their vector
+// NOLINTNEXTLINE
+TEST_F(VectorDatePartTest, FilteredDatesWithNulls) {
+  exec::ExecutionSettings exec_settings{};
+
+  // dates = [2000-02-29, 1999-12-31, NULL, 2020-03-01, 1600-01-01]
+  auto dates = MakeDateVector({Date::FromYMD(2000, 2, 29), Date::FromYMD(1999, 12, 31), Date::FromYMD(2000, 1, 1),
+                               Date::FromYMD(2020, 3, 1), Date::FromYMD(1600, 1, 1)},
+                              {false, false, true, false, false});
+  auto result = Vector(TypeId::Integer, true, false);
+
+  VectorOps::DatePart(exec_settings, *dates, DatePartType::DOY, &result);
+  EXPECT_EQ(GenericValue::CreateInteger(60), result.GetValue(0));
+  EXPECT_EQ(GenericValue::CreateInteger(365), result.GetValue(1));
+  EXPECT_TRUE(result.IsNull(2));
+  EXPECT_EQ(GenericValue::CreateInteger(61), result.GetValue(3));
+  EXPECT_EQ(GenericValue::CreateInteger(1), result.GetValue(4));
+
+  auto tids = TupleIdList(dates->GetSize());
+  tids = {1, 2, 3};
+  dates->SetFilteredTupleIdList(&tids, tids.GetTupleCount());
+  VectorOps::DatePart(exec_settings, *dates, DatePartType::YEAR, &result);
+  EXPECT_EQ(3, result.GetCount());
+  EXPECT_EQ(&tids, result.GetFilteredTupleIdList());
+  EXPECT_EQ(GenericValue::CreateInteger(1999), result.GetValue(0));
+  EXPECT_TRUE(result.IsNull(1));
+  EXPECT_EQ(GenericValue::CreateInteger(2020), result.GetValue(2));
+
+  VectorOps::DatePart(exec_settings, *dates, DatePartType::HOUR, &result);
+  EXPECT_EQ(GenericValue::CreateInteger(0), result.GetValue(0));
+
+  // Only dates and timestamps have parts, and not every part has a kernel
+  auto integers = MakeIntegerVector(10);
+  EXPECT_THROW(VectorOps::DatePart(exec_settings, *integers, DatePartType::YEAR, &result), ExecutionException);
+  EXPECT_THROW(VectorOps::DatePart(exec_settings, *dates, DatePartType::WEEK, &result), ExecutionException);
+}
+
+}  // namespace noisepage::execution::sql::test
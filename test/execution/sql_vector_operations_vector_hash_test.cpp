@@ -68,6 +68,39 @@ TEST_F(VectorHashTest, HashWithNullInput) {
   EXPECT_EQ(hash_t{0}, raw_hash[4]);  // The last element is NULL, so hash=0.
 }
 
+// NOLINTNEXTLINE
+TEST_F(VectorHashTest, FusedPairHash) {
+  // dates = [2001-01-01, NULL, 2003-01-01, 2004-01-01, 2005-01-01]
+  // ints  = [1, 2, NULL, 4, 5]
+  // Only the odd TIDs are active.
+  auto dates = MakeDateVector({Date::FromYMD(2001, 01, 01), Date::FromYMD(2002, 01, 01), Date::FromYMD(2003, 01, 01),
+                               Date::FromYMD(2004, 01, 01), Date::FromYMD(2005, 01, 01)},
+                              {false, true, false, false, false});
+  auto ints = MakeIntegerVector({1, 2, 3, 4, 5}, {false, false, true, false, false});
+  auto strings = MakeVarcharVector({"a", "b", "c", "d", "e"}, {false, false, false, false, false});
+  TupleIdList tids(dates->GetSize());
+  tids = {1, 3};
+  for (auto *vec : {dates.get(), ints.get(), strings.get()}) vec->SetFilteredTupleIdList(&tids, tids.GetTupleCount());
+
+  // Fused pairs and the fallback must hash like one column after the other
+  for (const auto &[first, second] : {std::pair{dates.get(), ints.get()}, std::pair{ints.get(), dates.get()},
+                                      std::pair{ints.get(), ints.get()}, std::pair{strings.get(), ints.get()}}) {
+    auto pair_hash = Vector(TypeId::Hash, true, false);
+    auto expected_hash = Vector(TypeId::Hash, true, false);
+    VectorOps::Hash(*first, *second, &pair_hash);
+    VectorOps::Hash(*first, &expected_hash);
+    VectorOps::HashCombine(*second, &expected_hash);
+
+    EXPECT_EQ(first->GetSize(), pair_hash.GetSize());
+    EXPECT_EQ(2u, pair_hash.GetCount());
+    EXPECT_EQ(&tids, pair_hash.GetFilteredTupleIdList());
+    for (const auto tid : {1, 3}) {
+      EXPECT_EQ(reinterpret_cast<hash_t *>(expected_hash.GetData())[tid],
+                reinterpret_cast<hash_t *>(pair_hash.GetData())[tid]);
+    }
+  }
+}
+
 // NOLINTNEXTLINE
 TEST_F(VectorHashTest, StringHash) {
   // input = [s, NULL, s, s]
@@ -91,4 +124,27 @@ TEST_F(VectorHashTest, StringHash) {
   EXPECT_EQ(Hash<storage::VarlenEntry>{}(raw_input[3], input->IsNull(3)), raw_hash[3]);
 }
 
+// NOLINTNEXTLINE
+TEST_F(VectorHashTest, DictionaryStringHash) {
+  // input = [s, NULL, t, s, t], encoded with the dictionary [s, t]
+  const char *refs[] = {"short",
+                        "I'm trying to right my wrongs, but it's funny, them same wrongs help me write this song"};
+  const storage::VarlenEntry dictionary[] = {storage::VarlenEntry::Create(refs[0]),
+                                             storage::VarlenEntry::Create(refs[1])};
+  const uint64_t codes[] = {0, 0, 1, 0, 1};
+  auto input = MakeVarcharVector({refs[0], {}, refs[1], refs[0], refs[1]}, {false, true, false, false, false});
+  input->SetDictionary(codes, dictionary, 2);
+  auto hash = MakeVector(TypeId::Hash, input->GetSize());
+
+  VectorOps::Hash(*input, hash.get());
+
+  EXPECT_EQ(input->GetSize(), hash->GetSize());
+  auto raw_input = reinterpret_cast<const storage::VarlenEntry *>(input->GetData());
+  auto raw_hash = reinterpret_cast<hash_t *>(hash->GetData());
+  for (uint32_t i = 0; i < input->GetSize(); i++) {
+    EXPECT_EQ(Hash<storage::VarlenEntry>{}(raw_input[i], input->IsNull(i)), raw_hash[i]);
+  }
+  EXPECT_EQ(hash_t{0}, raw_hash[1]);  // The second element is NULL, so hash=0.
+}
+
 }  // namespace noisepage::execution::sql::test
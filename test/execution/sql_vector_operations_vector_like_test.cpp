@@ -1,10 +1,16 @@
+#include <string>
+#include <string_view>
+#include <vector>
+
 #include "common/error/exception.h"
 #include "execution/sql/constant_vector.h"
+#include "execution/sql/operators/like_operators.h"
 #include "execution/sql/tuple_id_list.h"
 #include "execution/sql/vector.h"
 #include "execution/sql/vector_operations/vector_operations.h"
 #include "execution/sql_test.h"
 #include "execution/tpl_test.h"
+#include "spdlog/fmt/fmt.h"
 
 namespace noisepage::execution::sql::test {
 
@@ -91,4 +97,68 @@ TEST_F(VectorLikeTest, LikeVectorOfPatterns) {
   EXPECT_EQ(3u, tid_list[1]);
 }
 
+// NOLINTNEXTLINE
+TEST_F(VectorLikeTest, LikeDictionary) {
+  exec::ExecutionSettings exec_settings{};
+  // strings = [second, NULL, first, second, third], encoded with the dictionary [first, second, third]
+  const storage::VarlenEntry dictionary[] = {storage::VarlenEntry::Create("first"),
+                                             storage::VarlenEntry::Create("second"),
+                                             storage::VarlenEntry::Create("third")};
+  const uint64_t codes[] = {1, 0, 0, 1, 2};
+  auto strings = MakeVarcharVector({"second", {}, "first", "second", "third"}, {false, true, false, false, false});
+  strings->SetDictionary(codes, dictionary, 3);
+  auto pattern = ConstantVector(GenericValue::CreateVarchar("%d"));
+  auto tid_list = TupleIdList(strings->GetSize());
+
+  // strings LIKE '%d' = [0, 3, 4]
+  tid_list.AddAll();
+  VectorOps::SelectLike(exec_settings, *strings, pattern, &tid_list);
+  EXPECT_EQ(3u, tid_list.GetTupleCount());
+  EXPECT_EQ(0u, tid_list[0]);
+  EXPECT_EQ(3u, tid_list[1]);
+  EXPECT_EQ(4u, tid_list[2]);
+
+  // strings NOT LIKE '%d' = [2]
+  tid_list.AddAll();
+  VectorOps::SelectNotLike(exec_settings, *strings, pattern, &tid_list);
+  EXPECT_EQ(1u, tid_list.GetTupleCount());
+  EXPECT_EQ(2u, tid_list[0]);
+}
+
+// NOLINTNEXTLINE
+TEST_F(VectorLikeTest, LikeSimplePatterns) {
+  exec::ExecutionSettings exec_settings{};
+  // Strings of all lengths, inlined or not, in a vector long enough to be matched a word of TIDs at a time
+  std::vector<std::string> values;
+  for (uint32_t i = 0; i < 150; i++) {
+    values.push_back(fmt::format("{}key{}", std::string(i % 11, 'x'), i).substr(0, i % 17));
+  }
+  std::vector<std::string_view> views(values.begin(), values.end());
+  std::vector<bool> nulls(values.size(), false);
+  nulls[3] = nulls[70] = true;
+  auto strings = MakeVarcharVector(views, nulls);
+  auto tid_list = TupleIdList(strings->GetSize());
+
+  // Every pattern must match exactly the strings the general implementation matches
+  for (const std::string pattern_str : {"", "%", "%%", "x", "xxk", "xxxxkey", "xxxxxxxxkey9", "x%", "xxxk%",
+                                        "xxxxxxkey%", "%y", "%ey7", "%key1", "%e%", "%xkey%", "%xxxxxxxkey10%", "x%y",
+                                        "_key%", "%\\%"}) {
+    auto pattern = ConstantVector(GenericValue::CreateVarchar(pattern_str));
+    for (const bool negated : {false, true}) {
+      tid_list.AddAll();
+      if (negated) {
+        VectorOps::SelectNotLike(exec_settings, *strings, pattern, &tid_list);
+      } else {
+        VectorOps::SelectLike(exec_settings, *strings, pattern, &tid_list);
+      }
+      for (uint32_t i = 0; i < values.size(); i++) {
+        const bool like = !nulls[i] && Like::Impl(values[i].data(), values[i].size(), pattern_str.data(),
+                                                   pattern_str.size()) != negated;
+        EXPECT_EQ(like, tid_list.Contains(i)) << "'" << values[i] << "' " << (negated ? "NOT LIKE" : "LIKE") << " '"
+                                              << pattern_str << "'";
+      }
+    }
+  }
+}
+
 }  // namespace noisepage::execution::sql::test
@@ -1,3 +1,5 @@
+#include <limits>
+
 #include "common/error/exception.h"
 #include "execution/sql/constant_vector.h"
 #include "execution/sql/vector.h"
@@ -215,4 +217,103 @@ TEST_F(VectorArithmeticTest, InPlaceAdditionFilteredWithNulls) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(VectorArithmeticTest, DecimalRescale) {
+  // Encoded decimals of scale 2: [1.25, -1.25, 1.24, -1.26, NULL]
+  auto a = MakeBigIntVector({125, -125, 124, -126, 0}, {false, false, false, false, true});
+  auto result = Vector(TypeId::BigInt, true, false);
+
+  // Scaling down rounds half away from zero
+  VectorOps::DecimalRescale(*a, 2, 1, &result);
+  EXPECT_EQ(a->GetCount(), result.GetCount());
+  EXPECT_EQ(GenericValue::CreateBigInt(13), result.GetValue(0));
+  EXPECT_EQ(GenericValue::CreateBigInt(-13), result.GetValue(1));
+  EXPECT_EQ(GenericValue::CreateBigInt(12), result.GetValue(2));
+  EXPECT_EQ(GenericValue::CreateBigInt(-13), result.GetValue(3));
+  EXPECT_TRUE(result.IsNull(4));
+
+  VectorOps::DecimalRescale(*a, 2, 5, &result);
+  EXPECT_EQ(GenericValue::CreateBigInt(125000), result.GetValue(0));
+  EXPECT_EQ(GenericValue::CreateBigInt(-126000), result.GetValue(3));
+  EXPECT_TRUE(result.IsNull(4));
+
+  // A value that does not fit once scaled up is an error, unless it is NULL
+  auto b = MakeBigIntVector({1, std::numeric_limits<int64_t>::max()}, {false, true});
+  EXPECT_NO_THROW(VectorOps::DecimalRescale(*b, 0, 3, &result));
+  b->SetNull(1, false);
+  EXPECT_THROW(VectorOps::DecimalRescale(*b, 0, 3, &result), ExecutionException);
+  EXPECT_THROW(VectorOps::DecimalRescale(*b, 0, 30, &result), ExecutionException);
+
+  // Decimals are only held in BigInt vectors
+  auto c = MakeIntegerVector(10);
+  EXPECT_THROW(VectorOps::DecimalRescale(*c, 0, 1, &result), ExecutionException);
+}
+
+// NOLINTNEXTLINE
+TEST_F(VectorArithmeticTest, DecimalAddSubtract) {
+  // a holds decimals of scale 1: [0.0, 0.1, 0.2, ...]
+  // b holds decimals of scale 3: [0.000, 0.003, 0.006, ...]
+  auto a = MakeBigIntVector(100);
+  auto b = MakeBigIntVector(100);
+  auto result = Vector(TypeId::BigInt, true, false);
+  VectorOps::Generate(a.get(), 0, 1);
+  VectorOps::Generate(b.get(), 0, 3);
+
+  // The results have the larger scale, 3
+  VectorOps::DecimalAdd(*a, 1, *b, 3, &result);
+  for (uint64_t i = 0; i < result.GetCount(); i++) {
+    EXPECT_EQ(GenericValue::CreateBigInt(i * 100 + i * 3), result.GetValue(i));
+  }
+  VectorOps::DecimalSubtract(*b, 3, *a, 1, &result);
+  for (uint64_t i = 0; i < result.GetCount(); i++) {
+    EXPECT_EQ(GenericValue::CreateBigInt(static_cast<int64_t>(i * 3) - static_cast<int64_t>(i * 100)),
+              result.GetValue(i));
+  }
+
+  // Filtered, with a constant: 1.5 + b
+  auto tid_list = TupleIdList(b->GetSize());
+  tid_list = {0, 10, 20, 30, 40, 50, 60, 70, 80, 90};
+  b->SetFilteredTupleIdList(&tid_list, tid_list.GetTupleCount());
+  b->SetNull(10, true);
+  VectorOps::DecimalAdd(ConstantVector(GenericValue::CreateBigInt(15)), 1, *b, 3, &result);
+  EXPECT_EQ(tid_list.GetTupleCount(), result.GetCount());
+  EXPECT_EQ(b->GetFilteredTupleIdList(), result.GetFilteredTupleIdList());
+  for (uint64_t i = 0; i < result.GetCount(); i++) {
+    if (tid_list[i] == 10) {
+      EXPECT_TRUE(result.IsNull(i));
+    } else {
+      EXPECT_EQ(GenericValue::CreateBigInt(1500 + tid_list[i] * 3), result.GetValue(i));
+    }
+  }
+
+  // Adding a NULL constant gives only NULLs
+  VectorOps::DecimalAdd(*b, 3, ConstantVector(GenericValue::CreateNull(TypeId::BigInt)), 1, &result);
+  for (uint64_t i = 0; i < result.GetCount(); i++) {
+    EXPECT_TRUE(result.IsNull(i));
+  }
+
+  // Overflow, at the same and at different scales
+  auto big = MakeBigIntVector({std::numeric_limits<int64_t>::max()}, {false});
+  auto one = MakeBigIntVector({1}, {false});
+  EXPECT_THROW(VectorOps::DecimalAdd(*big, 2, *one, 2, &result), ExecutionException);
+  EXPECT_THROW(VectorOps::DecimalAdd(*big, 2, *one, 3, &result), ExecutionException);
+  EXPECT_THROW(VectorOps::DecimalSubtract(*one, 2, *big, 0, &result), ExecutionException);
+  EXPECT_NO_THROW(VectorOps::DecimalSubtract(*big, 2, *one, 2, &result));
+}
+
+// NOLINTNEXTLINE
+TEST_F(VectorArithmeticTest, DecimalMultiply) {
+  // 1.5 * [0.25, -0.02, NULL] = [0.375, -0.030, NULL] at scale 1 + 2 = 3
+  auto a = MakeBigIntVector({25, -2, 7}, {false, false, true});
+  auto result = Vector(TypeId::BigInt, true, false);
+  VectorOps::DecimalMultiply(ConstantVector(GenericValue::CreateBigInt(15)), *a, &result);
+  EXPECT_EQ(GenericValue::CreateBigInt(375), result.GetValue(0));
+  EXPECT_EQ(GenericValue::CreateBigInt(-30), result.GetValue(1));
+  EXPECT_TRUE(result.IsNull(2));
+
+  auto big = MakeBigIntVector({std::numeric_limits<int64_t>::max() / 2}, {false});
+  EXPECT_THROW(VectorOps::DecimalMultiply(*big, ConstantVector(GenericValue::CreateBigInt(3)), &result),
+               ExecutionException);
+}
+
 }  // namespace noisepage::execution::sql::test
@@ -262,4 +262,51 @@ TEST_F(VectorSelectTest, IsNullAndIsNotNull) {
   EXPECT_EQ(2u, tid_list[0]);
 }
 
+// NOLINTNEXTLINE
+TEST_F(VectorSelectTest, DictionaryStringSelection) {
+  exec::ExecutionSettings exec_settings{};
+
+  // a = [green, NULL, red, green, blue, red], encoded with the dictionary [blue, green, red]
+  const storage::VarlenEntry dictionary[] = {storage::VarlenEntry::Create("blue"),
+                                             storage::VarlenEntry::Create("green"),
+                                             storage::VarlenEntry::Create("red")};
+  const uint64_t codes[] = {1, 0, 2, 1, 0, 2};
+  auto a = MakeVarcharVector({"green", {}, "red", "green", "blue", "red"}, {false, true, false, false, false, false});
+  a->SetDictionary(codes, dictionary, 3);
+  EXPECT_TRUE(a->IsDictionaryEncoded());
+  auto red = ConstantVector(GenericValue::CreateVarchar("red"));
+  auto null = ConstantVector(GenericValue::CreateNull(TypeId::Varchar));
+  auto tid_list = TupleIdList(a->GetSize());
+
+  // a == 'red' = [2, 5]
+  tid_list.AddAll();
+  VectorOps::SelectEqual(exec_settings, *a, red, &tid_list);
+  EXPECT_EQ(2u, tid_list.GetTupleCount());
+  EXPECT_EQ(2u, tid_list[0]);
+  EXPECT_EQ(5u, tid_list[1]);
+
+  // 'red' > a = [0, 3, 4]
+  tid_list.AddAll();
+  VectorOps::SelectGreaterThan(exec_settings, red, *a, &tid_list);
+  EXPECT_EQ(3u, tid_list.GetTupleCount());
+  EXPECT_EQ(0u, tid_list[0]);
+  EXPECT_EQ(3u, tid_list[1]);
+  EXPECT_EQ(4u, tid_list[2]);
+
+  // a == NULL = []
+  tid_list.AddAll();
+  VectorOps::SelectEqual(exec_settings, *a, null, &tid_list);
+  EXPECT_EQ(0u, tid_list.GetTupleCount());
+
+  // With fewer TIDs than distinct values, the strings are compared: a[1,2,4] != 'red' = [4]
+  tid_list = {1, 2, 4};
+  VectorOps::SelectNotEqual(exec_settings, *a, red, &tid_list);
+  EXPECT_EQ(1u, tid_list.GetTupleCount());
+  EXPECT_EQ(4u, tid_list[0]);
+
+  // Changing the vector drops the encoding
+  a->Resize(a->GetSize());
+  EXPECT_FALSE(a->IsDictionaryEncoded());
+}
+
 }  // namespace noisepage::execution::sql::test
@@ -316,6 +316,46 @@ TEST_F(VectorUtilTest, BitToSelectionVector_Sparse_vs_Dense) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(VectorUtilTest, BitToSelectionVector_PartialByte) {
+  // The dense implementation must not write past num_bits when the bit vector ends within a byte
+  for (uint32_t num_bits : {1, 7, 63, 65, 100, 127}) {
+    BitVector bv(num_bits);
+    for (uint32_t i = 0; i < num_bits; i++) {
+      bv.Set(i, i % 3 != 0);
+    }
+
+    // Guard entries after the num_bits entries of the selection vector
+    constexpr sel_t guard = 0xFFFF;
+    std::vector<sel_t> sel(num_bits + 8, guard);
+    const uint32_t size = util::VectorUtil::BitVectorToSelectionVectorDense(bv.GetWords(), num_bits, sel.data());
+
+    ASSERT_EQ(bv.CountOnes(), size);
+    for (uint32_t i = 0; i < size; i++) {
+      EXPECT_TRUE(bv[sel[i]]);
+    }
+    for (uint32_t i = num_bits; i < sel.size(); i++) {
+      EXPECT_EQ(guard, sel[i]);
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(VectorUtilTest, SelectionToBitVector) {
+  constexpr uint32_t num_bits = 200;
+  BitVector bv(num_bits);
+  bv.Set(3);
+
+  // Bits already set are kept, and the selection vector need not be sorted
+  sel_t sel[] = {0, 5, 63, 64, 130, 199, 2};
+  util::VectorUtil::SelectionVectorToBitVector(sel, sizeof(sel) / sizeof(sel[0]), bv.GetWords());
+
+  EXPECT_EQ(8u, bv.CountOnes());
+  for (const uint32_t i : {0, 2, 3, 5, 63, 64, 130, 199}) {
+    EXPECT_TRUE(bv[i]);
+  }
+}
+
 // NOLINTNEXTLINE
 TEST_F(VectorUtilTest, DiffSelected) {
   sel_t input[common::Constants::K_DEFAULT_VECTOR_SIZE] = {0, 2, 3, 5, 7, 9};
@@ -318,4 +318,46 @@ TEST_F(BytecodeGeneratorTest, FunctionTest) {
   EXPECT_EQ(20, s.b_);
 }
 
+// NOLINTNEXTLINE
+TEST_F(BytecodeGeneratorTest, OptimizedBytecodeTest) {
+  // Copies of locals, repeated computations and jumps to jumps are optimized away without changing the result
+  auto src = R"(
+    fun test(x: int32) -> int32 {
+      var a = x
+      var b = a
+      var c = b + b
+      var d = b + b
+      var sum: int32 = 0
+      for (var i: int32 = 0; i < x; i = i + 1) {
+        var t = sum
+        sum = t + d
+      }
+      if (sum > 100) {
+        return sum
+      }
+      return c
+    })";
+  auto compiler = ModuleCompiler();
+  auto module = compiler.CompileToModule(src);
+  ASSERT_TRUE(module != nullptr);
+
+  std::function<int32_t(int32_t)> f;
+  EXPECT_TRUE(module->GetFunction("test", ExecutionMode::Interpret, &f)) << "Function 'test' not found in module";
+  for (int32_t x = 0; x < 20; x++) {
+    EXPECT_EQ(2 * x * x > 100 ? 2 * x * x : 2 * x, f(x));
+  }
+
+  // No copy between locals is left, and no jump goes to the instruction after it
+  const BytecodeModule *bytecode_module = module->GetBytecodeModule();
+  const FunctionInfo *func_info = bytecode_module->LookupFuncInfoByName("test");
+  ASSERT_NE(nullptr, func_info);
+  for (auto iter = bytecode_module->GetBytecodeForFunction(*func_info); !iter.Done(); iter.Advance()) {
+    EXPECT_NE(Bytecode::Deref4, iter.CurrentBytecode());
+    if (Bytecodes::IsJump(iter.CurrentBytecode())) {
+      const uint32_t operand_index = Bytecodes::IsConditionalJump(iter.CurrentBytecode()) ? 1 : 0;
+      EXPECT_NE(static_cast<int32_t>(sizeof(int32_t)), iter.GetJumpOffsetOperand(operand_index));
+    }
+  }
+}
+
 }  // namespace noisepage::execution::vm::test
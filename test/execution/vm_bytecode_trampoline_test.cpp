@@ -24,6 +24,8 @@ class BytecodeTrampolineTest : public TplTest {
   void *GetTrampoline(const vm::Module &module, const std::string &func_name) {
     return module.GetBytecodeImpl(module.GetFuncInfoByName(func_name)->GetId());
   }
+
+  void Compile(vm::Module *module) { module->CompileToMachineCode(); }
 };
 
 // NOLINTNEXTLINE
@@ -222,6 +224,33 @@ TEST_F(BytecodeTrampolineTest, CodeGenComparisonFunctionSorterTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(BytecodeTrampolineTest, SwitchToCompiledCodeTest) {
+  auto src = R"(
+    fun sum(n: int64) -> int64 {
+      var s: int64 = 0
+      for (var i: int64 = 0; i < n; i = i + 1) {
+        s = s + i
+      }
+      return s
+    })";
+  auto compiler = ModuleCompiler();
+  auto module = compiler.CompileToModule(src);
+
+  EXPECT_FALSE(compiler.HasErrors());
+
+  // Callers hold on to the trampoline across the compilation
+  auto sum = reinterpret_cast<int64_t (*)(int64_t)>(GetTrampoline(*module, "sum"));
+  EXPECT_EQ(45, sum(10));
+
+  Compile(module.get());
+
+  // The trampoline now forwards to the compiled implementation
+  EXPECT_NE(GetTrampoline(*module, "sum"), module->GetRawFunctionImpl(module->GetFuncInfoByName("sum")->GetId()));
+  EXPECT_EQ(45, sum(10));
+  EXPECT_EQ(4950, sum(100));
+}
+
 // NOLINTNEXTLINE
 TEST_F(BytecodeTrampolineTest, DISABLED_PerfGenComparisonForSortTest) {
   // Try sorting through trampoline
@@ -75,6 +75,27 @@ class SqlBasedTest : public TplTest {
     return catalog_->GetAccessor(common::ManagedPointer(test_txn_), test_db_oid_, DISABLED);
   }
 
+  /** Set the memory budget of parallel aggregations in execution contexts made from now on. */
+  void SetAggregationMemoryBudget(int64_t budget) { exec_settings_->aggregation_memory_budget_ = budget; }
+
+  /** Set the percentage of new groups at which pre-aggregation is bypassed in contexts made from now on. */
+  void SetAggregationBypassThreshold(int64_t threshold) { exec_settings_->aggregation_bypass_threshold_ = threshold; }
+
+  /** Set the memory budget of hash joins in execution contexts made from now on. */
+  void SetJoinMemoryBudget(int64_t budget) { exec_settings_->join_memory_budget_ = budget; }
+
+  /** Set the memory budget of sorters in execution contexts made from now on. */
+  void SetSortMemoryBudget(int64_t budget) { exec_settings_->sort_memory_budget_ = budget; }
+
+  /** Set the radix bits parallel hash join builds partition on in execution contexts made from now on. */
+  void SetJoinBuildPartitionBits(int64_t bits) { exec_settings_->join_build_partition_bits_ = bits; }
+
+  /** Set whether hash join tables in execution contexts made from now on may use the compact layout. */
+  void SetJoinCompactLayoutEnabled(bool enabled) { exec_settings_->is_join_compact_layout_enabled_ = enabled; }
+
+  /** Set whether queries compiled for execution contexts made from now on are profiled. */
+  void SetProfilingEnabled(bool enabled) { exec_settings_->SetIsProfilingEnabled(enabled); }
+
  protected:
   std::unique_ptr<catalog::CatalogAccessor> accessor_;
   catalog::db_oid_t test_db_oid_{0};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <algorithm>
 #include <cinttypes>
 #include <cstdio>
 #include <cstring>
@@ -24,6 +25,7 @@
 #include "storage/storage_util.h"
 #include "storage/tuple_access_strategy.h"
 #include "storage/undo_record.h"
+#include "storage/varlen_allocator.h"
 #include "test_util/multithread_test_util.h"
 #include "test_util/random_test_util.h"
 #include "transaction/transaction_manager.h"
@@ -94,6 +96,27 @@ class StorageTestUtil {
     return RandomLayout(max_cols, generator, true);
   }
 
+  // Returns a layout with the same columns as the given one, some of which are stored in randomly formed column groups
+  template <typename Random>
+  static storage::BlockLayout RandomlyGroupedLayout(const storage::BlockLayout &layout, Random *const generator) {
+    std::vector<uint16_t> attr_sizes;
+    for (uint16_t i = 0; i < layout.NumColumns(); i++) {
+      const storage::col_id_t col_id(i);
+      attr_sizes.push_back(layout.IsVarlen(col_id) ? storage::VARLEN_COLUMN : layout.AttrSize(col_id));
+    }
+    // The sizes are sorted the same way again, so the columns keep their ids
+    std::vector<storage::col_id_t> col_ids = layout.AllColumns();
+    std::shuffle(col_ids.begin(), col_ids.end(), *generator);
+    std::vector<std::vector<storage::col_id_t>> column_groups;
+    std::uniform_int_distribution<int64_t> group_size(1, 8);
+    for (auto it = col_ids.begin(); it != col_ids.end();) {
+      const auto size = std::min(group_size(*generator), static_cast<int64_t>(col_ids.end() - it));
+      if (size > 1) column_groups.emplace_back(it, it + size);
+      it += size;
+    }
+    return storage::BlockLayout(attr_sizes, column_groups);
+  }
+
   // Returns a random schema that is guaranteed to be valid.
   template <typename Random>
   static catalog::Schema *RandomSchemaNoVarlen(const uint16_t max_cols, Random *const generator) {
@@ -128,7 +151,7 @@ class StorageTestUtil {
         if (layout.IsVarlen(col)) {
           uint32_t size = varlen_size(*generator);
           if (size > storage::VarlenEntry::InlineThreshold()) {
-            byte *varlen = common::AllocationUtil::AllocateAligned(size);
+            byte *varlen = storage::VarlenAllocator::Allocate(size);
             FillWithRandomBytes(size, varlen, generator);
             // varlen entries always start off not inlined
             *reinterpret_cast<storage::VarlenEntry *>(row->AccessForceNotNull(projection_list_idx)) =
@@ -350,7 +373,7 @@ class StorageTestUtil {
       if (original_entry->IsInlined()) {
         *copied_entry = *original_entry;
       } else {
-        byte *copied_content = common::AllocationUtil::AllocateAligned(original_entry->Size());
+        byte *copied_content = storage::VarlenAllocator::Allocate(original_entry->Size());
         std::memcpy(copied_content, original_entry->Content(), original_entry->Size());
         // Always needs reclaim because we just made a copy
         *copied_entry = storage::VarlenEntry::Create(copied_content, original_entry->Size(), true);
@@ -11,6 +11,7 @@
 #include "catalog/schema.h"
 #include "storage/garbage_collector.h"
 #include "storage/projected_row.h"
+#include "storage/varlen_allocator.h"
 #include "test_util/catalog_test_util.h"
 
 namespace noisepage::tpcc {
@@ -97,7 +98,7 @@ struct Util {
                                                 static_cast<uint32_t>(astring.length()));
     }
 
-    auto *const varlen = common::AllocationUtil::AllocateAligned(astring.length());
+    auto *const varlen = storage::VarlenAllocator::Allocate(static_cast<uint32_t>(astring.length()));
     std::memcpy(varlen, astring.data(), astring.length());
     return storage::VarlenEntry::Create(varlen, static_cast<uint32_t>(astring.length()), true);
   }
@@ -121,7 +122,7 @@ struct Util {
                                                 static_cast<uint32_t>(last_name.length()));
     }
 
-    auto *const varlen = common::AllocationUtil::AllocateAligned(last_name.length());
+    auto *const varlen = storage::VarlenAllocator::Allocate(static_cast<uint32_t>(last_name.length()));
     std::memcpy(varlen, last_name.data(), last_name.length());
     return storage::VarlenEntry::Create(varlen, static_cast<uint32_t>(last_name.length()), true);
   }
@@ -154,7 +155,7 @@ struct Util {
 
     astring.replace(original_index, 8, "ORIGINAL");
 
-    auto *const varlen = common::AllocationUtil::AllocateAligned(astring.length());
+    auto *const varlen = storage::VarlenAllocator::Allocate(static_cast<uint32_t>(astring.length()));
     std::memcpy(varlen, astring.data(), astring.length());
     return storage::VarlenEntry::Create(varlen, static_cast<uint32_t>(astring.length()), true);
   }
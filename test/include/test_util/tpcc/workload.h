@@ -272,9 +272,11 @@ std::vector<std::vector<TransactionArgs>> PrecomputeArgs(Random *const generator
  * @param txn_manager pointer to the txn_manager
  * @param precomputed_args all of the precomputed args for this TPC-C run
  * @param workers preallocated workers with buffers to use for execution
+ * @param latencies_us if not null, filled with the latency (us) of every txn, in the order of its precomputed args
  */
 void Workload(int8_t worker_id, Database *tpcc_db, transaction::TransactionManager *txn_manager,
-              const std::vector<std::vector<TransactionArgs>> &precomputed_args, std::vector<Worker> *workers);
+              const std::vector<std::vector<TransactionArgs>> &precomputed_args, std::vector<Worker> *workers,
+              std::vector<uint64_t> *latencies_us = nullptr);
 
 /**
  * Clean up the buffers from any non-inlined VarlenEntrys in the precomputed args
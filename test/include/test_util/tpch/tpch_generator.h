@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace noisepage::tpch {
+
+/**
+ * Generates the TPC-H tables at a scale factor, so that benchmarks do not depend on an external dbgen. The data follows
+ * the cardinalities, key relationships and value domains of the specification (section 4.2.3), which is what the
+ * queries' selectivities depend on, while the free text columns are made of random words.
+ *
+ * The tables are written as a .schema and a .data file each, in the format that execution::sql::TableReader reads
+ * and tpch::Workload loads.
+ */
+class TPCHGenerator {
+ public:
+  /** Names of the generated tables, in the order they are written. */
+  static const std::vector<std::string> TABLE_NAMES;
+
+  /**
+   * Write the tables to a directory
+   * @param scale_factor TPC-H scale factor, 1 for about 1GB of data. Every table has at least one row.
+   * @param dir_name directory to write to, which must exist and end in a '/'
+   * @param seed seed of the random values, so that runs on the same scale factor see the same data
+   * @return number of rows written per table, in the order of TABLE_NAMES
+   */
+  static std::vector<uint64_t> Generate(double scale_factor, const std::string &dir_name, uint64_t seed = 0);
+};
+
+}  // namespace noisepage::tpch
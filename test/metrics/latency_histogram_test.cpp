@@ -0,0 +1,106 @@
+#include "metrics/latency_histogram.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "metrics/metrics_sink.h"
+
+namespace noisepage {
+
+// Tests that every latency falls in a bucket whose bounds contain it, within the promised precision
+// NOLINTNEXTLINE
+TEST(LatencyHistogramTests, BucketTest) {
+  std::vector<uint64_t> latencies;
+  for (uint64_t latency = 0; latency < 4096; latency++) latencies.push_back(latency);
+  for (uint32_t bit = 12; bit < 64; bit++) {
+    const uint64_t power = uint64_t{1} << bit;
+    latencies.push_back(power - 1);
+    latencies.push_back(power);
+    latencies.push_back(power + power / 3);
+  }
+  latencies.push_back(std::numeric_limits<uint64_t>::max());
+
+  uint32_t prev_index = 0;
+  for (const auto latency : latencies) {
+    const auto index = metrics::LatencyHistogram::BucketIndex(latency);
+    ASSERT_LT(index, metrics::LatencyHistogram::NUM_BUCKETS);
+    EXPECT_GE(index, prev_index);
+    const auto upper_bound = metrics::LatencyHistogram::BucketUpperBound(index);
+    EXPECT_GE(upper_bound, latency);
+    EXPECT_LE(upper_bound - latency, latency / metrics::LatencyHistogram::SUB_BUCKETS);
+    if (index > 0) {
+      EXPECT_LT(metrics::LatencyHistogram::BucketUpperBound(index - 1), latency);
+    }
+    prev_index = index;
+  }
+  EXPECT_EQ(metrics::LatencyHistogram::BucketIndex(std::numeric_limits<uint64_t>::max()),
+            metrics::LatencyHistogram::NUM_BUCKETS - 1);
+}
+
+// Tests that the percentiles of a histogram, and of histograms merged together, are close to the exact ones
+// NOLINTNEXTLINE
+TEST(LatencyHistogramTests, PercentileTest) {
+  std::default_random_engine generator;
+  std::uniform_int_distribution<uint64_t> distribution(1, 1000000);
+  std::vector<uint64_t> latencies;
+  metrics::LatencyHistogram first, second;
+  for (uint32_t i = 0; i < 100000; i++) {
+    latencies.push_back(distribution(generator));
+    (i % 2 == 0 ? first : second).Record(latencies.back());
+  }
+  first.Merge(second);
+  std::sort(latencies.begin(), latencies.end());
+
+  EXPECT_EQ(first.Count(), latencies.size());
+  EXPECT_EQ(first.Max(), latencies.back());
+  EXPECT_EQ(first.Percentile(100), latencies.back());
+  EXPECT_EQ(first.Percentile(0), metrics::LatencyHistogram::BucketUpperBound(
+                                     metrics::LatencyHistogram::BucketIndex(latencies.front())));
+  for (const double percentile : {1.0, 50.0, 90.0, 99.0, 99.9}) {
+    const auto exact = latencies[static_cast<size_t>(percentile / 100 * latencies.size()) - 1];
+    const auto estimate = first.Percentile(percentile);
+    EXPECT_GE(estimate, exact);
+    EXPECT_LE(estimate - exact, exact / metrics::LatencyHistogram::SUB_BUCKETS);
+  }
+
+  const metrics::LatencyHistogram empty;
+  EXPECT_EQ(empty.Count(), 0);
+  EXPECT_EQ(empty.Percentile(99), 0);
+  EXPECT_EQ(empty.Mean(), 0);
+}
+
+// Tests that histograms are kept per kind of latency and query, and written in order as rows of the sink
+// NOLINTNEXTLINE
+TEST(LatencyHistogramTests, HistogramsTest) {
+  metrics::LatencyHistograms histograms, other;
+  histograms.Record(metrics::LatencyKind::PIPELINE, 10, 2);
+  histograms.Record(metrics::LatencyKind::TXN_COMMIT, 5);
+  other.Record(metrics::LatencyKind::PIPELINE, 30, 2);
+  other.Record(metrics::LatencyKind::PIPELINE, 20, 1);
+  histograms.Merge(other);
+  EXPECT_EQ(histograms.Histograms().size(), 3);
+
+  metrics::RingBufferMetricsSink sink(10);
+  histograms.Write(sink.GetWriter(metrics::LatencyHistograms::FILE, metrics::LatencyHistograms::COLUMNS));
+  const auto rows = sink.GetRows(metrics::LatencyHistograms::FILE);
+  ASSERT_EQ(rows.size(), 3);
+  EXPECT_EQ(std::get<std::string>(rows[0][0]), "txn_commit");
+  EXPECT_EQ(std::get<std::string>(rows[1][0]), "pipeline");
+  EXPECT_EQ(std::get<uint64_t>(rows[1][1]), 1);
+  EXPECT_EQ(std::get<std::string>(rows[2][0]), "pipeline");
+  EXPECT_EQ(std::get<uint64_t>(rows[2][1]), 2);
+  // count, mean and maximum of the merged histogram
+  EXPECT_EQ(std::get<uint64_t>(rows[2][2]), 2);
+  EXPECT_EQ(std::get<uint64_t>(rows[2][3]), 20);
+  EXPECT_EQ(std::get<uint64_t>(rows[2][8]), 30);
+
+  histograms.Clear();
+  EXPECT_TRUE(histograms.Empty());
+}
+
+}  // namespace noisepage
@@ -1,3 +1,6 @@
+#include <cstring>
+#include <fstream>
+#include <iterator>
 #include <memory>
 #include <pqxx/pqxx>  // NOLINT
 #include <random>
@@ -5,9 +8,12 @@
 #include <thread>  //NOLINT
 #include <unordered_map>
 #include <utility>
+#include <variant>
 
+#include "common/thread_context.h"
 #include "main/db_main.h"
 #include "metrics/metrics_manager.h"
+#include "metrics/metrics_sink.h"
 #include "metrics/metrics_store.h"
 #include "settings/settings_callbacks.h"
 #include "settings/settings_manager.h"
@@ -100,17 +106,18 @@ TEST_F(MetricsTests, LoggingCSVTest) {
   const auto aggregated_data = reinterpret_cast<LoggingMetricRawData *>(
       metrics_manager_->AggregatedMetrics().at(static_cast<uint8_t>(MetricsComponent::LOGGING)).get());
   EXPECT_NE(aggregated_data, nullptr);
-  EXPECT_GE(aggregated_data->serializer_data_.size(), 0);  // 1 data point recorded
-  if (!(aggregated_data->serializer_data_.empty())) {
+  EXPECT_GE(aggregated_data->serializer_data_.Size(), 0);  // 1 data point recorded
+  if (!(aggregated_data->serializer_data_.Empty())) {
     EXPECT_GE(aggregated_data->serializer_data_.begin()->num_records_, 0);  // 2 records: insert, commit
   }
-  EXPECT_GE(aggregated_data->consumer_data_.size(), 0);  // 1 data point recorded
-  if (!(aggregated_data->consumer_data_.empty())) {
+  EXPECT_GE(aggregated_data->consumer_data_.Size(), 0);  // 1 data point recorded
+  if (!(aggregated_data->consumer_data_.Empty())) {
     EXPECT_GE(aggregated_data->consumer_data_.begin()->num_buffers_, 0);  // 1 buffer flushed
   }
-  metrics_manager_->ToCSV();
-  EXPECT_EQ(aggregated_data->serializer_data_.size(), 0);
-  EXPECT_EQ(aggregated_data->consumer_data_.size(), 0);
+  metrics_manager_->Dump();
+  EXPECT_EQ(aggregated_data->serializer_data_.Size(), 0);
+  EXPECT_EQ(aggregated_data->consumer_data_.Size(), 0);
+  EXPECT_EQ(aggregated_data->group_commit_data_.Size(), 0);
 
   Insert();
   Insert();
@@ -118,17 +125,18 @@ TEST_F(MetricsTests, LoggingCSVTest) {
   std::this_thread::sleep_for(std::chrono::seconds(1));
 
   metrics_manager_->Aggregate();
-  EXPECT_GE(aggregated_data->serializer_data_.size(), 0);  // 1 data point recorded
-  if (!(aggregated_data->serializer_data_.empty())) {
+  EXPECT_GE(aggregated_data->serializer_data_.Size(), 0);  // 1 data point recorded
+  if (!(aggregated_data->serializer_data_.Empty())) {
     EXPECT_GE(aggregated_data->serializer_data_.begin()->num_records_, 0);  // 4 records: 2 insert, 2 commit
   }
-  EXPECT_GE(aggregated_data->consumer_data_.size(), 0);  // 1 data point recorded
-  if (!(aggregated_data->consumer_data_.empty())) {
+  EXPECT_GE(aggregated_data->consumer_data_.Size(), 0);  // 1 data point recorded
+  if (!(aggregated_data->consumer_data_.Empty())) {
     EXPECT_GE(aggregated_data->consumer_data_.begin()->num_buffers_, 0);  // 2 buffers flushed
   }
-  metrics_manager_->ToCSV();
-  EXPECT_EQ(aggregated_data->serializer_data_.size(), 0);
-  EXPECT_EQ(aggregated_data->consumer_data_.size(), 0);
+  metrics_manager_->Dump();
+  EXPECT_EQ(aggregated_data->serializer_data_.Size(), 0);
+  EXPECT_EQ(aggregated_data->consumer_data_.Size(), 0);
+  EXPECT_EQ(aggregated_data->group_commit_data_.Size(), 0);
 
   Insert();
   Insert();
@@ -137,17 +145,18 @@ TEST_F(MetricsTests, LoggingCSVTest) {
   std::this_thread::sleep_for(std::chrono::seconds(1));
 
   metrics_manager_->Aggregate();
-  EXPECT_GE(aggregated_data->serializer_data_.size(), 0);  // 1 data point recorded
-  if (!(aggregated_data->serializer_data_.empty())) {
+  EXPECT_GE(aggregated_data->serializer_data_.Size(), 0);  // 1 data point recorded
+  if (!(aggregated_data->serializer_data_.Empty())) {
     EXPECT_GE(aggregated_data->serializer_data_.begin()->num_records_, 0);  // 6 records: 3 insert, 3 commit
   }
-  EXPECT_GE(aggregated_data->consumer_data_.size(), 0);  // 1 data point recorded
-  if (!(aggregated_data->consumer_data_.empty())) {
+  EXPECT_GE(aggregated_data->consumer_data_.Size(), 0);  // 1 data point recorded
+  if (!(aggregated_data->consumer_data_.Empty())) {
     EXPECT_GE(aggregated_data->consumer_data_.begin()->num_buffers_, 0);  // 3 buffers flushed
   }
-  metrics_manager_->ToCSV();
-  EXPECT_EQ(aggregated_data->serializer_data_.size(), 0);
-  EXPECT_EQ(aggregated_data->consumer_data_.size(), 0);
+  metrics_manager_->Dump();
+  EXPECT_EQ(aggregated_data->serializer_data_.Size(), 0);
+  EXPECT_EQ(aggregated_data->consumer_data_.Size(), 0);
+  EXPECT_EQ(aggregated_data->group_commit_data_.Size(), 0);
 
   action_context = std::make_unique<common::ActionContext>(common::action_id_t(2));
   settings_manager_->SetBool(settings::Param::logging_metrics_enable, false, common::ManagedPointer(action_context),
@@ -175,11 +184,11 @@ TEST_F(MetricsTests, TransactionCSVTest) {
   const auto aggregated_data = reinterpret_cast<TransactionMetricRawData *>(
       metrics_manager_->AggregatedMetrics().at(static_cast<uint8_t>(MetricsComponent::TRANSACTION)).get());
   EXPECT_NE(aggregated_data, nullptr);
-  EXPECT_GE(aggregated_data->begin_data_.size(), 0);   // 1 txn recorded
-  EXPECT_GE(aggregated_data->commit_data_.size(), 0);  // 1 txn recorded
-  metrics_manager_->ToCSV();
-  EXPECT_EQ(aggregated_data->begin_data_.size(), 0);
-  EXPECT_EQ(aggregated_data->commit_data_.size(), 0);
+  EXPECT_GE(aggregated_data->begin_data_.Size(), 0);   // 1 txn recorded
+  EXPECT_GE(aggregated_data->commit_data_.Size(), 0);  // 1 txn recorded
+  metrics_manager_->Dump();
+  EXPECT_EQ(aggregated_data->begin_data_.Size(), 0);
+  EXPECT_EQ(aggregated_data->commit_data_.Size(), 0);
 
   Insert();
   Insert();
@@ -187,11 +196,11 @@ TEST_F(MetricsTests, TransactionCSVTest) {
   std::this_thread::sleep_for(std::chrono::seconds(1));
 
   metrics_manager_->Aggregate();
-  EXPECT_GE(aggregated_data->begin_data_.size(), 0);   // 2 txns recorded
-  EXPECT_GE(aggregated_data->commit_data_.size(), 0);  // 2 txns recorded
-  metrics_manager_->ToCSV();
-  EXPECT_EQ(aggregated_data->begin_data_.size(), 0);
-  EXPECT_EQ(aggregated_data->commit_data_.size(), 0);
+  EXPECT_GE(aggregated_data->begin_data_.Size(), 0);   // 2 txns recorded
+  EXPECT_GE(aggregated_data->commit_data_.Size(), 0);  // 2 txns recorded
+  metrics_manager_->Dump();
+  EXPECT_EQ(aggregated_data->begin_data_.Size(), 0);
+  EXPECT_EQ(aggregated_data->commit_data_.Size(), 0);
 
   Insert();
   Insert();
@@ -200,11 +209,11 @@ TEST_F(MetricsTests, TransactionCSVTest) {
   std::this_thread::sleep_for(std::chrono::seconds(1));
 
   metrics_manager_->Aggregate();
-  EXPECT_GE(aggregated_data->begin_data_.size(), 0);   // 3 txns recorded
-  EXPECT_GE(aggregated_data->commit_data_.size(), 0);  // 3 txns recorded
-  metrics_manager_->ToCSV();
-  EXPECT_EQ(aggregated_data->begin_data_.size(), 0);
-  EXPECT_EQ(aggregated_data->commit_data_.size(), 0);
+  EXPECT_GE(aggregated_data->begin_data_.Size(), 0);   // 3 txns recorded
+  EXPECT_GE(aggregated_data->commit_data_.Size(), 0);  // 3 txns recorded
+  metrics_manager_->Dump();
+  EXPECT_EQ(aggregated_data->begin_data_.Size(), 0);
+  EXPECT_EQ(aggregated_data->commit_data_.Size(), 0);
 
   action_context = std::make_unique<common::ActionContext>(common::action_id_t(2));
   settings_manager_->SetBool(settings::Param::transaction_metrics_enable, false, common::ManagedPointer(action_context),
@@ -270,11 +279,11 @@ TEST_F(MetricsTests, PipelineCSVTest) {
         metrics_manager_->AggregatedMetrics().at(static_cast<uint8_t>(MetricsComponent::EXECUTION_PIPELINE)).get());
     EXPECT_EQ(aggregated_data != nullptr, enable_metric);
     if (aggregated_data != nullptr) {
-      EXPECT_EQ(aggregated_data->pipeline_data_.size(), expected_points);
-      metrics_manager_->ToCSV();
+      EXPECT_EQ(aggregated_data->pipeline_data_.Size(), expected_points);
+      metrics_manager_->Dump();
 
-      // After ToCSV(), we should expect no more data points
-      EXPECT_EQ(aggregated_data->pipeline_data_.size(), 0);
+      // After Dump(), we should expect no more data points
+      EXPECT_EQ(aggregated_data->pipeline_data_.Size(), 0);
     }
 
     if (enable_metric) {
@@ -335,24 +344,141 @@ TEST_F(MetricsTests, QueryCSVTest) {
   const auto aggregated_data = reinterpret_cast<QueryTraceMetricRawData *>(
       metrics_manager_->AggregatedMetrics().at(static_cast<uint8_t>(MetricsComponent::QUERY_TRACE)).get());
   EXPECT_NE(aggregated_data, nullptr);
-  EXPECT_EQ(aggregated_data->query_trace_.size(), 2);  // 2 data point recorded
-  EXPECT_EQ(aggregated_data->query_text_.size(), 2);   // 2 data point recorded
-  if (!(aggregated_data->query_text_.empty())) {
+  EXPECT_EQ(aggregated_data->query_trace_.Size(), 2);  // 2 data point recorded
+  EXPECT_EQ(aggregated_data->query_text_.Size(), 2);   // 2 data point recorded
+  if (!(aggregated_data->query_text_.Empty())) {
     EXPECT_EQ(aggregated_data->query_text_.begin()->query_text_, "\"INSERT INTO TableA VALUES (1, 'abc');\"");
-    if (!(aggregated_data->query_trace_.empty())) {
+    if (!(aggregated_data->query_trace_.Empty())) {
       EXPECT_EQ(aggregated_data->query_trace_.begin()->query_id_,
                 aggregated_data->query_text_.begin()->query_id_);  // 2 records: insert, select
     }
   }
-  metrics_manager_->ToCSV();
-  EXPECT_EQ(aggregated_data->query_trace_.size(), 0);
-  EXPECT_EQ(aggregated_data->query_text_.size(), 0);
+  metrics_manager_->Dump();
+  EXPECT_EQ(aggregated_data->query_trace_.Size(), 0);
+  EXPECT_EQ(aggregated_data->query_text_.Size(), 0);
 
   action_context = std::make_unique<common::ActionContext>(common::action_id_t(2));
   settings_manager_->SetBool(settings::Param::query_trace_metrics_enable, false, common::ManagedPointer(action_context),
                              setter_callback);
 }
 
+/**
+ *  Testing replication metric stats collection and persistence, single thread
+ */
+// NOLINTNEXTLINE
+TEST_F(MetricsTests, ReplicationCSVTest) {
+  for (const auto &file : metrics::ReplicationMetricRawData::FILES) unlink(std::string(file).c_str());
+  const settings::setter_callback_fn setter_callback = MetricsTests::EmptySetterCallback;
+  auto action_context = std::make_unique<common::ActionContext>(common::action_id_t(1));
+  settings_manager_->SetBool(settings::Param::replication_metrics_enable, true, common::ManagedPointer(action_context),
+                             setter_callback);
+
+  // Replication is not running, so record on behalf of the primary, the replica and the Messenger from this thread.
+  metrics_manager_->RegisterThread();
+  auto *const metrics_store = common::thread_context.metrics_store_;
+  metrics_store->RecordReplicationBatchSentData(1, 4096, 2, 15);
+  metrics_store->RecordReplicationBatchSentData(2, 1024, 2, 21);
+  metrics_store->RecordReplicaProgressData("replica1", 2, 1, 21, 15);
+  metrics_store->RecordReplicationApplyData(15, 250);
+  metrics_store->RecordMessengerData("replica1", 1, 1, 2, 500, 20000);
+
+  metrics_manager_->Aggregate();
+  const auto aggregated_data = reinterpret_cast<ReplicationMetricRawData *>(
+      metrics_manager_->AggregatedMetrics().at(static_cast<uint8_t>(MetricsComponent::REPLICATION)).get());
+  EXPECT_NE(aggregated_data, nullptr);
+  EXPECT_EQ(aggregated_data->batch_sent_data_.Size(), 2);
+  EXPECT_EQ(aggregated_data->batch_sent_data_.begin()->num_bytes_, 4096);
+  EXPECT_EQ(aggregated_data->replica_progress_data_.Size(), 1);
+  EXPECT_EQ(aggregated_data->replica_progress_data_.begin()->replica_, "replica1");
+  EXPECT_EQ(aggregated_data->replica_progress_data_.begin()->received_batch_id_, 1);
+  EXPECT_EQ(aggregated_data->apply_data_.Size(), 1);
+  EXPECT_EQ(aggregated_data->apply_data_.begin()->apply_latency_us_, 250);
+  EXPECT_EQ(aggregated_data->messenger_data_.Size(), 1);
+  EXPECT_EQ(aggregated_data->messenger_data_.begin()->num_resent_, 1);
+  metrics_manager_->Dump();
+  EXPECT_EQ(aggregated_data->batch_sent_data_.Size(), 0);
+  EXPECT_EQ(aggregated_data->replica_progress_data_.Size(), 0);
+  EXPECT_EQ(aggregated_data->apply_data_.Size(), 0);
+  EXPECT_EQ(aggregated_data->messenger_data_.Size(), 0);
+  metrics_manager_->UnregisterThread();
+
+  action_context = std::make_unique<common::ActionContext>(common::action_id_t(2));
+  settings_manager_->SetBool(settings::Param::replication_metrics_enable, false, common::ManagedPointer(action_context),
+                             setter_callback);
+}
+
+/**
+ *  Testing that the ring buffer sink keeps the latest rows of each output, and the binary sink writes them to disk
+ */
+// NOLINTNEXTLINE
+TEST_F(MetricsTests, SinkTest) {
+  const auto apply_output = ReplicationMetricRawData::FILES[2];
+
+  // The ring buffer keeps the latest 2 rows of each output
+  MetricsManager ring_buffer_manager(std::make_unique<RingBufferMetricsSink>(2));
+  ring_buffer_manager.EnableMetric(MetricsComponent::REPLICATION);
+  ring_buffer_manager.RegisterThread();
+  for (uint64_t txn_id = 1; txn_id <= 3; txn_id++) {
+    common::thread_context.metrics_store_->RecordReplicationApplyData(txn_id, 10 * txn_id);
+  }
+  common::thread_context.metrics_store_->RecordReplicaProgressData("replica1", 2, 1, 21, 15);
+  ring_buffer_manager.Aggregate();
+  ring_buffer_manager.Dump();
+  ring_buffer_manager.UnregisterThread();
+
+  const auto *const ring_buffer = ring_buffer_manager.GetSink().CastManagedPointerTo<RingBufferMetricsSink>().Get();
+  EXPECT_EQ(ring_buffer->GetColumns(apply_output),
+            std::string(ReplicationMetricRawData::FEATURE_COLUMNS[2]) + ", " +
+                std::string(common::ResourceTracker::Metrics::COLUMNS));
+  const auto apply_rows = ring_buffer->GetRows(apply_output);
+  ASSERT_EQ(apply_rows.size(), 2);
+  EXPECT_EQ(std::get<uint64_t>(apply_rows[0][1]), 2);
+  EXPECT_EQ(std::get<uint64_t>(apply_rows[0][2]), 20);
+  EXPECT_EQ(std::get<uint64_t>(apply_rows[1][1]), 3);
+  const auto progress_rows = ring_buffer->GetRows(ReplicationMetricRawData::FILES[1]);
+  ASSERT_EQ(progress_rows.size(), 1);
+  EXPECT_EQ(std::get<std::string>(progress_rows[0][1]), "replica1");
+  EXPECT_TRUE(ring_buffer->GetRows(ReplicationMetricRawData::FILES[0]).empty());
+
+  // The binary sink writes a header and then every row behind its length
+  const auto binary_file = BinaryMetricsSink::FilePath(apply_output);
+  unlink(binary_file.c_str());
+  {
+    MetricsManager binary_manager(std::make_unique<BinaryMetricsSink>());
+    binary_manager.EnableMetric(MetricsComponent::REPLICATION);
+    binary_manager.RegisterThread();
+    common::thread_context.metrics_store_->RecordReplicationApplyData(15, 250);
+    binary_manager.Aggregate();
+    binary_manager.Dump();
+    binary_manager.UnregisterThread();
+  }
+
+  std::ifstream binary(binary_file, std::ios_base::binary);
+  const std::string contents((std::istreambuf_iterator<char>(binary)), std::istreambuf_iterator<char>());
+  ASSERT_GE(contents.size(), BinaryMetricsSink::MAGIC.size() + sizeof(uint32_t));
+  EXPECT_EQ(contents.substr(0, BinaryMetricsSink::MAGIC.size()), BinaryMetricsSink::MAGIC);
+  size_t offset = BinaryMetricsSink::MAGIC.size();
+  const auto read_uint32 = [&contents, &offset] {
+    uint32_t value;
+    std::memcpy(&value, contents.data() + offset, sizeof(value));
+    offset += sizeof(value);
+    return value;
+  };
+  offset += read_uint32();  // skip the column names
+  // One row of three uint64 features: a timestamp, the transaction and its apply latency
+  ASSERT_EQ(read_uint32(), 3 * (1 + sizeof(uint64_t)));
+  uint64_t fields[3];
+  for (auto &field : fields) {
+    EXPECT_EQ(contents[offset], static_cast<char>(BinaryMetricsSink::FieldTag::UINT));
+    std::memcpy(&field, contents.data() + offset + 1, sizeof(field));
+    offset += 1 + sizeof(field);
+  }
+  EXPECT_EQ(fields[1], 15);
+  EXPECT_EQ(fields[2], 250);
+  EXPECT_EQ(offset, contents.size());
+  unlink(binary_file.c_str());
+}
+
 /**
  *  Testing that we can enable and disable per-component metrics
  *
@@ -439,5 +565,18 @@ TEST_F(MetricsTests, ToggleSettings) {
                              callback);
   EXPECT_EQ(action_context->GetState(), common::ActionState::SUCCESS);
   EXPECT_FALSE(metrics_manager_->ComponentEnabled(metrics::MetricsComponent::QUERY_TRACE));
+
+  // replication_metrics_enable
+  EXPECT_FALSE(metrics_manager_->ComponentEnabled(metrics::MetricsComponent::REPLICATION));
+  action_context = std::make_unique<common::ActionContext>(common::action_id_t(13));
+  settings_manager_->SetBool(settings::Param::replication_metrics_enable, true, common::ManagedPointer(action_context),
+                             callback);
+  EXPECT_EQ(action_context->GetState(), common::ActionState::SUCCESS);
+  EXPECT_TRUE(metrics_manager_->ComponentEnabled(metrics::MetricsComponent::REPLICATION));
+  action_context = std::make_unique<common::ActionContext>(common::action_id_t(14));
+  settings_manager_->SetBool(settings::Param::replication_metrics_enable, false, common::ManagedPointer(action_context),
+                             callback);
+  EXPECT_EQ(action_context->GetState(), common::ActionState::SUCCESS);
+  EXPECT_FALSE(metrics_manager_->ComponentEnabled(metrics::MetricsComponent::REPLICATION));
 }
 }  // namespace noisepage::metrics
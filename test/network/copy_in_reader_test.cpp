@@ -0,0 +1,294 @@
+#include "network/postgres/copy_in_reader.h"
+
+#include <endian.h>
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "execution/sql/runtime_types.h"
+#include "network/postgres/postgres_defs.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/constant_value_expression.h"
+#include "parser/expression/operator_expression.h"
+#include "storage/bulk_loader.h"
+#include "storage/garbage_collector.h"
+#include "storage/index/index.h"
+#include "storage/index/index_builder.h"
+#include "storage/sql_table.h"
+#include "test_util/catalog_test_util.h"
+#include "test_util/storage_test_util.h"
+#include "test_util/test_harness.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/transaction_manager.h"
+
+namespace noisepage::network {
+
+class CopyInReaderTests : public TerrierTest {
+ protected:
+  storage::BlockStore block_store_{1000, 1000};
+  storage::RecordBufferSegmentPool buffer_pool_{1000000, 100000};
+  transaction::TimestampManager timestamp_manager_;
+  transaction::DeferredActionManager deferred_action_manager_{common::ManagedPointer(&timestamp_manager_)};
+  transaction::TransactionManager txn_manager_{common::ManagedPointer(&timestamp_manager_),
+                                               common::ManagedPointer(&deferred_action_manager_),
+                                               common::ManagedPointer(&buffer_pool_),
+                                               true,
+                                               false,
+                                               DISABLED};
+  storage::GarbageCollector gc_{common::ManagedPointer(&timestamp_manager_),
+                                common::ManagedPointer(&deferred_action_manager_),
+                                common::ManagedPointer(&txn_manager_), DISABLED};
+
+  // A table of an INTEGER id, a VARCHAR name and a DATE, with an index on the id
+  catalog::Schema table_schema_;
+  storage::SqlTable *sql_table_;
+  std::unique_ptr<catalog::IndexSchema> index_schema_;
+  storage::index::Index *index_;
+
+  void SetUp() override {
+    TerrierTest::SetUp();
+    std::vector<catalog::Schema::Column> cols;
+    cols.emplace_back("id", type::TypeId::INTEGER, false, parser::ConstantValueExpression(type::TypeId::INTEGER));
+    cols.emplace_back("name", type::TypeId::VARCHAR, 64, true, parser::ConstantValueExpression(type::TypeId::VARCHAR));
+    cols.emplace_back("day", type::TypeId::DATE, true, parser::ConstantValueExpression(type::TypeId::DATE));
+    for (uint32_t i = 0; i < cols.size(); i++) StorageTestUtil::ForceOid(&cols[i], catalog::col_oid_t(i + 1));
+    table_schema_ = catalog::Schema(cols);
+    sql_table_ = new storage::SqlTable(common::ManagedPointer(&block_store_), table_schema_);
+  }
+
+  void TearDown() override {
+    delete index_;
+    gc_.PerformGarbageCollection();
+    gc_.PerformGarbageCollection();  // Second call to deallocate.
+    delete sql_table_;
+  }
+
+  void MakeIndex(const bool unique) {
+    std::vector<catalog::IndexSchema::Column> keycols;
+    keycols.emplace_back("", type::TypeId::INTEGER, false,
+                         parser::ColumnValueExpression(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID,
+                                                       catalog::col_oid_t(1)));
+    StorageTestUtil::ForceOid(&(keycols[0]), catalog::indexkeycol_oid_t(1));
+    index_schema_ = std::make_unique<catalog::IndexSchema>(keycols, storage::index::IndexType::BWTREE, unique, unique,
+                                                           false, true);
+    index_ = storage::index::IndexBuilder().SetKeySchema(*index_schema_).Build();
+  }
+
+  std::unique_ptr<CopyInReader> MakeReader(transaction::TransactionContext *txn,
+                                           const parser::ExternalFileFormat format, const char delimiter) {
+    auto loader = std::make_unique<storage::BulkLoader>(
+        common::ManagedPointer(txn), CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID,
+        common::ManagedPointer(sql_table_), table_schema_,
+        std::vector<std::pair<common::ManagedPointer<storage::index::Index>, const catalog::IndexSchema &>>{
+            {common::ManagedPointer(index_), *index_schema_}});
+    std::vector<CopyInReader::Column> columns;
+    for (const auto &col : table_schema_.GetColumns()) columns.push_back({col.Name(), col.Type(), col.Nullable()});
+    return std::make_unique<CopyInReader>("foo", std::move(loader), std::move(columns), format, delimiter, '"', '"');
+  }
+
+  // Feeds the data in pieces of the given size, the way it may be split into CopyData messages
+  static bool Feed(CopyInReader *reader, const std::string &data, const std::size_t piece) {
+    for (std::size_t pos = 0; pos < data.size(); pos += piece) {
+      if (!reader->Feed(std::string_view(data).substr(pos, piece))) return false;
+    }
+    return reader->Finish();
+  }
+
+  // The visible rows of the table as "id|name|day", with NULL for nulls
+  std::vector<std::string> ReadRows() {
+    const std::vector<catalog::col_oid_t> col_oids{catalog::col_oid_t(1), catalog::col_oid_t(2),
+                                                   catalog::col_oid_t(3)};
+    const auto initializer = sql_table_->InitializerForProjectedRow(col_oids);
+    const auto map = sql_table_->ProjectionMapForOids(col_oids);
+    byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+    auto *row = initializer.InitializeRow(buffer);
+
+    std::vector<std::string> rows;
+    auto *txn = txn_manager_.BeginTransaction();
+    for (auto it = sql_table_->begin(); it != sql_table_->end(); it++) {
+      if (!sql_table_->Select(common::ManagedPointer(txn), *it, row)) continue;
+      const auto *id = row->AccessWithNullCheck(map.at(col_oids[0]));
+      const auto *name = row->AccessWithNullCheck(map.at(col_oids[1]));
+      const auto *day = row->AccessWithNullCheck(map.at(col_oids[2]));
+      rows.emplace_back(
+          std::to_string(*reinterpret_cast<const int32_t *>(id)) + "|" +
+          (name == nullptr ? "NULL" : std::string(reinterpret_cast<const storage::VarlenEntry *>(name)->StringView())) +
+          "|" +
+          (day == nullptr ? "NULL"
+                          : execution::sql::Date::FromNative(*reinterpret_cast<const int32_t *>(day)).ToString()));
+    }
+    txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    delete[] buffer;
+    std::sort(rows.begin(), rows.end());
+    return rows;
+  }
+
+  // Number of tuples the index finds under the id
+  std::size_t CountKey(const int32_t id) {
+    byte *key_buffer = common::AllocationUtil::AllocateAligned(index_->GetProjectedRowInitializer().ProjectedRowSize());
+    auto *key = index_->GetProjectedRowInitializer().InitializeRow(key_buffer);
+    *reinterpret_cast<int32_t *>(key->AccessForceNotNull(0)) = id;
+    std::vector<storage::TupleSlot> results;
+    auto *txn = txn_manager_.BeginTransaction();
+    index_->ScanKey(*txn, *key, &results);
+    txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    delete[] key_buffer;
+    return results.size();
+  }
+
+  static void AppendInt16(std::string *data, const int16_t value) {
+    const uint16_t raw = htobe16(static_cast<uint16_t>(value));
+    data->append(reinterpret_cast<const char *>(&raw), sizeof(raw));
+  }
+
+  static void AppendInt32(std::string *data, const int32_t value) {
+    const uint32_t raw = htobe32(static_cast<uint32_t>(value));
+    data->append(reinterpret_cast<const char *>(&raw), sizeof(raw));
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(CopyInReaderTests, TextFormat) {
+  MakeIndex(false);
+  auto *txn = txn_manager_.BeginTransaction();
+  auto reader = MakeReader(txn, parser::ExternalFileFormat::TEXT, '\t');
+  // Rows split across messages, escapes, NULLs, a CRLF line ending and a last row without a newline
+  const std::string data = "1\tfoo\t2020-01-02\n2\t\\N\t\\N\r\n3\tb\\tar\\\\\t\\N\n3\t\\101\\x42\t2000-01-01";
+  ASSERT_TRUE(Feed(reader.get(), data, 3));
+  EXPECT_EQ(reader->NumRows(), 4u);
+  txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  EXPECT_EQ(ReadRows(), (std::vector<std::string>{"1|foo|2020-01-02", "2|NULL|NULL", "3|AB|2000-01-01",
+                                                  "3|b\tar\\|NULL"}));
+  EXPECT_EQ(CountKey(1), 1u);
+  EXPECT_EQ(CountKey(3), 2u);
+  EXPECT_EQ(index_->GetSize(), 4u);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CopyInReaderTests, CsvFormat) {
+  MakeIndex(false);
+  auto *txn = txn_manager_.BeginTransaction();
+  auto reader = MakeReader(txn, parser::ExternalFileFormat::CSV, ',');
+  // An unquoted empty value is NULL and a quoted one is empty. Quoted values may hold delimiters, quotes and newlines.
+  const std::string data = "1,\"a,b\",2020-01-02\n2,,\n3,\"\",\n4,\"say \"\"hi\"\"\nbye\",\n\\.\n5,ignored,\n";
+  ASSERT_TRUE(Feed(reader.get(), data, 1));
+  EXPECT_EQ(reader->NumRows(), 4u);
+  txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  EXPECT_EQ(ReadRows(),
+            (std::vector<std::string>{"1|a,b|2020-01-02", "2|NULL|NULL", "3||NULL", "4|say \"hi\"\nbye|NULL"}));
+  EXPECT_EQ(index_->GetSize(), 4u);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CopyInReaderTests, BinaryFormat) {
+  MakeIndex(false);
+  std::string data(POSTGRES_BINARY_COPY_SIGNATURE);
+  AppendInt32(&data, 0);
+  // A header extension, which is skipped
+  AppendInt32(&data, 2);
+  data.append("xx");
+  for (int32_t id = 0; id < 3; id++) {
+    AppendInt16(&data, 3);
+    AppendInt32(&data, 4);
+    AppendInt32(&data, id);
+    AppendInt32(&data, 3);
+    data.append("abc");
+    // Days count from 2000-01-01
+    AppendInt32(&data, 4);
+    AppendInt32(&data, id);
+  }
+  AppendInt16(&data, 3);
+  AppendInt32(&data, 4);
+  AppendInt32(&data, 7);
+  AppendInt32(&data, -1);
+  AppendInt32(&data, -1);
+  AppendInt16(&data, -1);
+
+  auto *txn = txn_manager_.BeginTransaction();
+  auto reader = MakeReader(txn, parser::ExternalFileFormat::BINARY, '\t');
+  ASSERT_TRUE(Feed(reader.get(), data, 5));
+  EXPECT_EQ(reader->NumRows(), 4u);
+  txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  EXPECT_EQ(ReadRows(), (std::vector<std::string>{"0|abc|2000-01-01", "1|abc|2000-01-02", "2|abc|2000-01-03",
+                                                  "7|NULL|NULL"}));
+  EXPECT_EQ(CountKey(7), 1u);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CopyInReaderTests, BadData) {
+  MakeIndex(false);
+  const auto error = [&](const parser::ExternalFileFormat format, const std::string &data) {
+    auto *txn = txn_manager_.BeginTransaction();
+    auto reader = MakeReader(txn, format, format == parser::ExternalFileFormat::CSV ? ',' : '\t');
+    EXPECT_FALSE(Feed(reader.get(), data, 4));
+    txn_manager_.Abort(txn);
+    return *reader->GetError();
+  };
+
+  auto bad = error(parser::ExternalFileFormat::TEXT, "1\ta\t\\N\nx\tb\t\\N\n");
+  EXPECT_EQ(bad.GetCode(), common::ErrorCode::ERRCODE_INVALID_TEXT_REPRESENTATION);
+  EXPECT_EQ(bad.Fields().back().second, "COPY foo, line 2, column id");
+
+  bad = error(parser::ExternalFileFormat::TEXT, "3000000000\ta\t\\N\n");
+  EXPECT_EQ(bad.GetCode(), common::ErrorCode::ERRCODE_NUMERIC_VALUE_OUT_OF_RANGE);
+
+  bad = error(parser::ExternalFileFormat::CSV, ",a,\n");
+  EXPECT_EQ(bad.GetCode(), common::ErrorCode::ERRCODE_NOT_NULL_VIOLATION);
+
+  bad = error(parser::ExternalFileFormat::CSV, "1,a\n");
+  EXPECT_EQ(bad.GetCode(), common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT);
+
+  bad = error(parser::ExternalFileFormat::CSV, "1,\"a,\n");
+  EXPECT_EQ(bad.GetCode(), common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT);
+
+  bad = error(parser::ExternalFileFormat::BINARY, "PGCOPY\nnot quite");
+  EXPECT_EQ(bad.GetCode(), common::ErrorCode::ERRCODE_BAD_COPY_FILE_FORMAT);
+
+  // None of it made it into the table
+  EXPECT_TRUE(ReadRows().empty());
+}
+
+// NOLINTNEXTLINE
+TEST_F(CopyInReaderTests, UniqueViolation) {
+  MakeIndex(true);
+  auto *txn = txn_manager_.BeginTransaction();
+  auto reader = MakeReader(txn, parser::ExternalFileFormat::TEXT, '\t');
+  EXPECT_FALSE(Feed(reader.get(), "1\ta\t\\N\n2\tb\t\\N\n1\tc\t\\N\n", 64));
+  EXPECT_EQ(reader->GetError()->GetCode(), common::ErrorCode::ERRCODE_UNIQUE_VIOLATION);
+  EXPECT_EQ(reader->GetError()->Fields().back().second, "COPY foo, line 3");
+  txn_manager_.Abort(txn);
+  EXPECT_TRUE(ReadRows().empty());
+}
+
+// NOLINTNEXTLINE
+TEST_F(CopyInReaderTests, SupportsIndex) {
+  MakeIndex(false);
+  EXPECT_TRUE(storage::BulkLoader::SupportsIndex(*index_schema_));
+
+  // A partial index
+  index_schema_->SetPredicate(std::make_unique<parser::ConstantValueExpression>(type::TypeId::BOOLEAN,
+                                                                                execution::sql::BoolVal(true)));
+  EXPECT_FALSE(storage::BulkLoader::SupportsIndex(*index_schema_));
+
+  // An index on an expression of a column
+  std::vector<std::unique_ptr<parser::AbstractExpression>> children;
+  children.emplace_back(std::make_unique<parser::ColumnValueExpression>(
+      CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, catalog::col_oid_t(1)));
+  children.emplace_back(
+      std::make_unique<parser::ConstantValueExpression>(type::TypeId::INTEGER, execution::sql::Integer(1)));
+  std::vector<catalog::IndexSchema::Column> keycols;
+  keycols.emplace_back("", type::TypeId::INTEGER, false,
+                       parser::OperatorExpression(parser::ExpressionType::OPERATOR_PLUS, type::TypeId::INTEGER,
+                                                  std::move(children)));
+  const catalog::IndexSchema expression_schema(keycols, storage::index::IndexType::BWTREE, false, false, false, true);
+  EXPECT_FALSE(storage::BulkLoader::SupportsIndex(expression_schema));
+}
+
+}  // namespace noisepage::network
@@ -0,0 +1,124 @@
+#include "network/network_io_utils.h"
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include "network/network_io_wrapper.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::network {
+
+class NetworkIoUtilsTests : public TerrierTest {
+ protected:
+  // Bytes 0, 1, 2, ... that span several write buffers
+  static std::vector<uchar> Bytes(const size_t len) {
+    std::vector<uchar> bytes(len);
+    for (size_t i = 0; i < len; i++) bytes[i] = static_cast<uchar>(i);
+    return bytes;
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(NetworkIoUtilsTests, GatherUnflushedTest) {
+  WriteQueue queue;
+  std::array<struct iovec, 4> iov;
+  EXPECT_EQ(queue.GatherUnflushed(iov.data(), iov.size()), 0);
+
+  const auto bytes = Bytes(2 * SOCKET_BUFFER_CAPACITY + 100);
+  queue.BufferWriteRaw(bytes.data(), bytes.size());
+  ASSERT_EQ(queue.GatherUnflushed(iov.data(), iov.size()), 3);
+  EXPECT_EQ(iov[0].iov_len, SOCKET_BUFFER_CAPACITY);
+  EXPECT_EQ(iov[1].iov_len, SOCKET_BUFFER_CAPACITY);
+  EXPECT_EQ(iov[2].iov_len, 100);
+  EXPECT_EQ(queue.GatherUnflushed(iov.data(), 2), 2);
+
+  // A write that stops in the middle of a buffer resumes from there
+  queue.MarkFlushed(SOCKET_BUFFER_CAPACITY + 10);
+  ASSERT_EQ(queue.GatherUnflushed(iov.data(), iov.size()), 2);
+  EXPECT_EQ(iov[0].iov_len, SOCKET_BUFFER_CAPACITY - 10);
+  EXPECT_EQ(*reinterpret_cast<uchar *>(iov[0].iov_base), bytes[SOCKET_BUFFER_CAPACITY + 10]);
+  EXPECT_EQ(iov[1].iov_len, 100);
+
+  queue.MarkFlushed(SOCKET_BUFFER_CAPACITY - 10 + 100);
+  EXPECT_EQ(queue.GatherUnflushed(iov.data(), iov.size()), 0);
+}
+
+// NOLINTNEXTLINE
+TEST_F(NetworkIoUtilsTests, RecycleBuffersTest) {
+  WriteQueue queue;
+  const auto bytes = Bytes(3 * SOCKET_BUFFER_CAPACITY);
+  queue.BufferWriteRaw(bytes.data(), bytes.size());
+  std::vector<WriteBuffer *> buffers;
+  for (auto head = queue.FlushHead(); head != nullptr; head = queue.FlushHead()) {
+    buffers.push_back(head.Get());
+    queue.MarkHeadFlushed();
+  }
+  ASSERT_EQ(buffers.size(), 3);
+
+  // The buffers after the first one are handed out again after a reset, empty
+  queue.Reset();
+  queue.BufferWriteRaw(bytes.data(), bytes.size());
+  std::array<struct iovec, 4> iov;
+  ASSERT_EQ(queue.GatherUnflushed(iov.data(), iov.size()), 3);
+  for (size_t i = 0; i < 3; i++) {
+    EXPECT_EQ(iov[i].iov_len, SOCKET_BUFFER_CAPACITY);
+    EXPECT_EQ(std::memcmp(iov[i].iov_base, bytes.data() + i * SOCKET_BUFFER_CAPACITY, SOCKET_BUFFER_CAPACITY), 0);
+  }
+  EXPECT_EQ(queue.FlushHead().Get(), buffers[0]);
+  queue.MarkHeadFlushed();
+  EXPECT_NE(std::find(buffers.begin(), buffers.end(), queue.FlushHead().Get()), buffers.end());
+}
+
+// NOLINTNEXTLINE
+TEST_F(NetworkIoUtilsTests, FlushAllWritesTest) {
+  int fds[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+  NetworkIoWrapper io_wrapper(fds[0]);
+
+  const auto bytes = Bytes(5 * SOCKET_BUFFER_CAPACITY + 7);
+  io_wrapper.GetWriteQueue()->BufferWriteRaw(bytes.data(), bytes.size());
+  EXPECT_EQ(io_wrapper.FlushAllWrites(), Transition::PROCEED);
+  EXPECT_EQ(io_wrapper.GetWriteQueue()->FlushHead()->Capacity(), SOCKET_BUFFER_CAPACITY);
+
+  std::vector<uchar> received(bytes.size());
+  size_t len = 0;
+  while (len < received.size()) {
+    const auto bytes_read = read(fds[1], received.data() + len, received.size() - len);
+    ASSERT_GT(bytes_read, 0);
+    len += bytes_read;
+  }
+  EXPECT_EQ(received, bytes);
+
+  io_wrapper.Close();
+  close(fds[1]);
+}
+
+// NOLINTNEXTLINE
+TEST_F(NetworkIoUtilsTests, FillPacketBufferTest) {
+  int fds[2];
+  ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+  NetworkIoWrapper io_wrapper(fds[0]);
+
+  // The rest of a large packet goes into its own buffer, but no further than the end of the packet
+  const auto bytes = Bytes(3 * SOCKET_BUFFER_CAPACITY);
+  ASSERT_EQ(write(fds[1], bytes.data(), bytes.size()), static_cast<ssize_t>(bytes.size()));
+  ReadBuffer packet_buf(2 * SOCKET_BUFFER_CAPACITY);
+  EXPECT_EQ(io_wrapper.FillReadBuffer(common::ManagedPointer(&packet_buf)), Transition::PROCEED);
+  EXPECT_TRUE(packet_buf.Full());
+  EXPECT_EQ(packet_buf.ReadValue<uchar>(), 0);
+
+  EXPECT_EQ(io_wrapper.FillReadBuffer(), Transition::PROCEED);
+  EXPECT_EQ(io_wrapper.GetReadBuffer()->BytesAvailable(), SOCKET_BUFFER_CAPACITY);
+  EXPECT_EQ(io_wrapper.GetReadBuffer()->ReadValue<uchar>(), bytes[2 * SOCKET_BUFFER_CAPACITY]);
+
+  io_wrapper.Close();
+  close(fds[1]);
+}
+
+}  // namespace noisepage::network
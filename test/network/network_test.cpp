@@ -1,3 +1,4 @@
+#include <atomic>
 #include <cstring>
 #include <memory>
 #include <pqxx/pqxx>  // NOLINT
@@ -83,12 +84,16 @@ class NetworkTests : public TerrierTest {
     spdlog::flush_every(std::chrono::seconds(1));
 #endif
 
+    handle_factory_ = std::make_unique<ConnectionHandleFactory>(common::ManagedPointer(tcop_));
+    LaunchServer(0, false);
+  }
+
+  void LaunchServer(const uint16_t worker_thread_count, const bool reuse_port) {
     try {
-      handle_factory_ = std::make_unique<ConnectionHandleFactory>(common::ManagedPointer(tcop_));
       server_ = std::make_unique<TerrierServer>(
           common::ManagedPointer<ProtocolInterpreterProvider>(&protocol_provider_),
           common::ManagedPointer(handle_factory_.get()), common::ManagedPointer(&thread_registry_), port_,
-          connection_thread_count_, socket_directory_);
+          connection_thread_count_, socket_directory_, worker_thread_count, reuse_port);
       server_->RunServer();
     } catch (NetworkProcessException &exception) {
       NETWORK_LOG_ERROR("[LaunchServer] exception when launching server");
@@ -148,8 +153,9 @@ class NetworkTests : public TerrierTest {
     io_socket->FlushAllWrites();
     EXPECT_TRUE(ManualPacketUtil::ReadUntilReadyOrClose(io_socket));
 
-    // CloseCommand
+    // CloseCommand, whose reply is sent at the next SyncCommand
     writer.WriteCloseCommand(DescribeCommandObjectType::STATEMENT, stmt_name);
+    writer.WriteSyncCommand();
     io_socket->FlushAllWrites();
     EXPECT_TRUE(ManualPacketUtil::ReadUntilReadyOrClose(io_socket));
 
@@ -271,6 +277,35 @@ TEST_F(NetworkTests, PgNetworkCommandsTest) {
   }
 }
 
+/**
+ * Send a whole pipeline of extended query messages at once, which the server answers in one go at the Sync
+ */
+// NOLINTNEXTLINE
+TEST_F(NetworkTests, PipelinedExtendedQueryTest) {
+  try {
+    auto io_socket_unique_ptr = network::ManualPacketUtil::StartConnection(port_);
+    auto io_socket = common::ManagedPointer(io_socket_unique_ptr);
+    io_socket->GetWriteQueue()->Reset();
+
+    PostgresPacketWriter writer(io_socket->GetWriteQueue());
+    writer.WriteParseCommand("", "SELECT name FROM employee WHERE id = 1;", {});
+    for (int i = 0; i < 3; i++) {
+      writer.WriteBindCommand("", "", {}, {}, {});
+      writer.WriteExecuteCommand("", 0);
+    }
+    writer.WriteCloseCommand(DescribeCommandObjectType::STATEMENT, "");
+    writer.WriteSyncCommand();
+    io_socket->FlushAllWrites();
+    EXPECT_TRUE(ManualPacketUtil::ReadUntilReadyOrClose(io_socket));
+
+    ManualPacketUtil::TerminateConnection(io_socket->GetSocketFd());
+    io_socket->Close();
+  } catch (const std::exception &e) {
+    NETWORK_LOG_ERROR("[PipelinedExtendedQueryTest] Exception occurred: {0}", e.what());
+    EXPECT_TRUE(false);
+  }
+}
+
 // NOLINTNEXTLINE
 TEST_F(NetworkTests, LargePacketsTest) {
   try {
@@ -312,6 +347,37 @@ TEST_F(NetworkTests, MultipleConnectionTest) {
   }
 }
 
+/**
+ * Runs queries on many connections at once with a server whose handlers accept their own connections with SO_REUSEPORT
+ * and hand the queries off to a worker pool.
+ */
+// NOLINTNEXTLINE
+TEST_F(NetworkTests, WorkerPoolTest) {
+  server_->StopServer();
+  LaunchServer(2, true);
+
+  std::vector<std::thread> threads;
+  std::atomic<uint32_t> successes = 0;
+  for (uint32_t i = 0; i < connection_thread_count_ * 4u; i++) {
+    threads.emplace_back([this, &successes] {
+      try {
+        pqxx::connection c(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                       port_, catalog::DEFAULT_DATABASE));
+        for (uint32_t j = 0; j < 10; j++) {
+          pqxx::work txn(c);
+          txn.exec("SELECT name FROM employee where id=1;");
+          txn.commit();
+        }
+        successes++;
+      } catch (const std::exception &e) {
+        NETWORK_LOG_ERROR("[WorkerPoolTest] Exception occurred: {0}", e.what());
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+  EXPECT_EQ(successes, connection_thread_count_ * 4u);
+}
+
 /**
  * This is meant to overload the network layer with multiple concurrent client threads. It was made to uncover
  * a bug where ConnectionHandlerTask had a few race conditions amongst its fields. Two threads using the same
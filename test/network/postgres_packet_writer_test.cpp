@@ -0,0 +1,122 @@
+#include "network/postgres/postgres_packet_writer.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "execution/sql/value.h"
+#include "gtest/gtest.h"
+#include "network/network_io_utils.h"
+#include "network/postgres/postgres_defs.h"
+#include "network/postgres/postgres_packet_util.h"
+#include "parser/expression/constant_value_expression.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::network {
+
+class PostgresPacketWriterTests : public TerrierTest {
+ protected:
+  // A row of a DATE, a TIMESTAMP and a VARCHAR, laid out the way the execution engine outputs it
+  void SetUp() override {
+    TerrierTest::SetUp();
+    columns_.emplace_back("d", type::TypeId::DATE, nullptr);
+    columns_.emplace_back("ts", type::TypeId::TIMESTAMP, nullptr);
+    columns_.emplace_back("s", type::TypeId::VARCHAR, nullptr);
+    layout_ = PostgresPacketWriter::MakeDataRowLayout(columns_, {FieldFormat::binary});
+    new (tuple_ + layout_[0].offset_) execution::sql::DateVal(execution::sql::Date::FromYMD(2000, 1, 2));
+    new (tuple_ + layout_[1].offset_)
+        execution::sql::TimestampVal(execution::sql::Timestamp::FromYMDHMS(1999, 12, 31, 23, 59, 59));
+    new (tuple_ + layout_[2].offset_) execution::sql::StringVal("noisepage");
+  }
+
+  // The bytes of the messages the writer wrote so far, without the first skip bytes
+  ReadBufferView Written(const size_t skip) {
+    auto buffer = write_queue_->FlushHead();
+    return ReadBufferView(buffer->Capacity() - skip, buffer->Begin() + skip);
+  }
+
+  std::vector<planner::OutputSchema::Column> columns_;
+  std::vector<DataRowAttribute> layout_;
+  alignas(16) byte tuple_[128] = {};
+  std::unique_ptr<WriteQueue> write_queue_ = std::make_unique<WriteQueue>();
+  PostgresPacketWriter out_{common::ManagedPointer(write_queue_)};
+};
+
+// NOLINTNEXTLINE
+TEST_F(PostgresPacketWriterTests, BinaryDataRowTest) {
+  out_.WriteDataRows(tuple_, 1, 0, layout_);
+
+  // Skip the message type and length
+  auto view = Written(5);
+  EXPECT_EQ(view.ReadValue<int16_t>(), 3);
+
+  // Dates and timestamps count from 2000-01-01
+  EXPECT_EQ(view.ReadValue<int32_t>(), 4);
+  EXPECT_EQ(view.ReadValue<int32_t>(), 1);
+  EXPECT_EQ(view.ReadValue<int32_t>(), 8);
+  EXPECT_EQ(view.ReadValue<int64_t>(), -1000000);
+  EXPECT_EQ(view.ReadValue<int32_t>(), 9);
+  EXPECT_EQ(view.ReadString(9), "noisepage");
+}
+
+// NOLINTNEXTLINE
+TEST_F(PostgresPacketWriterTests, BinaryRoundTripTest) {
+  // Results written in binary read back as the same parameters
+  out_.WriteDataRows(tuple_, 1, 0, layout_);
+
+  auto view = Written(7);
+  for (const auto &column : columns_) {
+    const auto size = view.ReadValue<int32_t>();
+    const auto value = PostgresPacketUtil::BinaryValueToInternalValue(common::ManagedPointer(&view), size,
+                                                                       column.GetType());
+    switch (column.GetType()) {
+      case type::TypeId::DATE:
+        EXPECT_EQ(value.GetDateVal().val_, execution::sql::Date::FromYMD(2000, 1, 2));
+        break;
+      case type::TypeId::TIMESTAMP:
+        EXPECT_EQ(value.GetTimestampVal().val_, execution::sql::Timestamp::FromYMDHMS(1999, 12, 31, 23, 59, 59));
+        break;
+      default:
+        EXPECT_EQ(value.GetStringVal().StringView(), "noisepage");
+        break;
+    }
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(PostgresPacketWriterTests, BinaryCopyOutTest) {
+  out_.WriteBinaryCopyOutStart(3);
+  out_.WriteBinaryCopyRows(tuple_, 1, 0, layout_);
+  out_.WriteBinaryCopyOutEnd();
+
+  auto view = Written(0);
+
+  // CopyOutResponse with every column in binary
+  EXPECT_EQ(view.ReadValue<uchar>(), static_cast<uchar>(NetworkMessageType::PG_COPY_OUT_RESPONSE));
+  EXPECT_EQ(view.ReadValue<int32_t>(), 4 + 1 + 2 + 3 * 2);
+  EXPECT_EQ(view.ReadValue<int8_t>(), 1);
+  EXPECT_EQ(view.ReadValue<int16_t>(), 3);
+  for (int i = 0; i < 3; i++) EXPECT_EQ(view.ReadValue<int16_t>(), 1);
+
+  // The header: signature, flags and header extension length
+  EXPECT_EQ(view.ReadValue<uchar>(), static_cast<uchar>(NetworkMessageType::PG_COPY_DATA));
+  EXPECT_EQ(view.ReadValue<int32_t>(), 4 + 11 + 4 + 4);
+  EXPECT_EQ(view.ReadString(11), std::string(POSTGRES_BINARY_COPY_SIGNATURE));
+  EXPECT_EQ(view.ReadValue<int32_t>(), 0);
+  EXPECT_EQ(view.ReadValue<int32_t>(), 0);
+
+  // The row, laid out like the body of a DataRow
+  EXPECT_EQ(view.ReadValue<uchar>(), static_cast<uchar>(NetworkMessageType::PG_COPY_DATA));
+  EXPECT_EQ(view.ReadValue<int32_t>(), 4 + 2 + (4 + 4) + (4 + 8) + (4 + 9));
+  EXPECT_EQ(view.ReadValue<int16_t>(), 3);
+  view.ReadString(4 + 4 + 4 + 8 + 4 + 9);
+
+  // The trailer and CopyDone
+  EXPECT_EQ(view.ReadValue<uchar>(), static_cast<uchar>(NetworkMessageType::PG_COPY_DATA));
+  EXPECT_EQ(view.ReadValue<int32_t>(), 4 + 2);
+  EXPECT_EQ(view.ReadValue<int16_t>(), -1);
+  EXPECT_EQ(view.ReadValue<uchar>(), static_cast<uchar>(NetworkMessageType::PG_COPY_DONE));
+  EXPECT_EQ(view.ReadValue<int32_t>(), 4);
+}
+
+}  // namespace noisepage::network
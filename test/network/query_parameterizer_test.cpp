@@ -0,0 +1,95 @@
+#include "network/postgres/query_parameterizer.h"
+
+#include <string>
+#include <vector>
+
+#include "execution/sql/value_util.h"
+#include "gtest/gtest.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::network {
+
+class QueryParameterizerTests : public TerrierTest {
+ public:
+  // Parameterize a query and check what it became
+  static void CheckParameterized(const std::string &query_text, const std::string &expected_text,
+                                 const std::vector<parser::ConstantValueExpression> &expected_params) {
+    std::vector<parser::ConstantValueExpression> params;
+    const auto parameterized_text = QueryParameterizer::Parameterize(query_text, &params);
+    ASSERT_TRUE(parameterized_text.has_value()) << query_text;
+    EXPECT_EQ(*parameterized_text, expected_text);
+    EXPECT_EQ(params, expected_params) << query_text;
+  }
+
+  // Check that a query is left as it is
+  static void CheckUnchanged(const std::string &query_text) {
+    std::vector<parser::ConstantValueExpression> params;
+    EXPECT_FALSE(QueryParameterizer::Parameterize(query_text, &params).has_value()) << query_text;
+    EXPECT_TRUE(params.empty());
+  }
+
+  static parser::ConstantValueExpression Int(int64_t value) {
+    return parser::ConstantValueExpression(type::TypeId::INTEGER, execution::sql::Integer(value));
+  }
+
+  static parser::ConstantValueExpression String(const std::string &value) {
+    auto string_val = execution::sql::ValueUtil::CreateStringVal(value);
+    return parser::ConstantValueExpression(type::TypeId::VARCHAR, string_val.first, std::move(string_val.second));
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(QueryParameterizerTests, PredicatesAndValues) {
+  CheckParameterized("SELECT a FROM foo WHERE id = 42 AND name <> 'it''s'",
+                     "SELECT a FROM foo WHERE id = $1 AND name <> $2", {Int(42), String("it's")});
+  CheckParameterized("select * from foo where id in (1, -2) or id between 3 and 4",
+                     "select * from foo where id in ($1, $2) or id between $3 and $4",
+                     {Int(1), Int(-2), Int(3), Int(4)});
+  const parser::ConstantValueExpression big_int(type::TypeId::BIGINT, execution::sql::Integer(5000000000));
+  CheckParameterized("SELECT * FROM foo WHERE a - 1 > 5000000000", "SELECT * FROM foo WHERE a - $1 > $2",
+                     {Int(1), big_int});
+  CheckParameterized("INSERT INTO foo VALUES (1, 'a'), (2, 'b');", "INSERT INTO foo VALUES ($1, $2), ($3, $4);",
+                     {Int(1), String("a"), Int(2), String("b")});
+  CheckParameterized("UPDATE foo SET a = 1.5 WHERE id = 7", "UPDATE foo SET a = $1 WHERE id = $2",
+                     {parser::ConstantValueExpression(type::TypeId::REAL, execution::sql::Real(1.5)), Int(7)});
+  CheckParameterized("DELETE FROM foo WHERE id IN (SELECT 1 FROM bar WHERE b = 2)",
+                     "DELETE FROM foo WHERE id IN (SELECT 1 FROM bar WHERE b = $1)", {Int(2)});
+}
+
+// NOLINTNEXTLINE
+TEST_F(QueryParameterizerTests, ConstantsThatStay) {
+  // Select lists, positions, limits, function arguments, typed literals and casts
+  CheckParameterized("SELECT 1, 'a' FROM foo WHERE a = 2 GROUP BY 1 ORDER BY 2 DESC LIMIT 10 OFFSET 5",
+                     "SELECT 1, 'a' FROM foo WHERE a = $1 GROUP BY 1 ORDER BY 2 DESC LIMIT 10 OFFSET 5", {Int(2)});
+  CheckParameterized("SELECT * FROM foo WHERE substr(s, 1, 2) = 'ab' AND d > DATE '2020-01-01' AND e = '5'::int",
+                     "SELECT * FROM foo WHERE substr(s, 1, 2) = $1 AND d > DATE '2020-01-01' AND e = '5'::int",
+                     {String("ab")});
+  CheckUnchanged("SELECT * FROM foo WHERE s LIKE 'a%'");
+  CheckUnchanged("SELECT 1");
+  // Other statements, comments, parameters and more than one statement
+  CheckUnchanged("CREATE TABLE foo (a INT DEFAULT 1)");
+  CheckUnchanged("SELECT * FROM foo WHERE a = 1 -- comment");
+  CheckUnchanged("SELECT * FROM foo WHERE a = $1");
+  CheckUnchanged("SELECT * FROM foo WHERE a = 1; SELECT 2");
+  CheckUnchanged("SELECT * FROM foo WHERE a = 'unterminated");
+}
+
+// NOLINTNEXTLINE
+TEST_F(QueryParameterizerTests, SplitStatements) {
+  using Statements = std::vector<std::string>;
+  EXPECT_EQ(QueryParameterizer::SplitStatements("SELECT 1;"), Statements{"SELECT 1"});
+  EXPECT_EQ(QueryParameterizer::SplitStatements("BEGIN; INSERT INTO foo VALUES (1);\n COMMIT ;;  "),
+            (Statements{"BEGIN", "INSERT INTO foo VALUES (1)", "COMMIT "}));
+  // Semicolons that do not end a statement
+  EXPECT_EQ(QueryParameterizer::SplitStatements("SELECT 'a;''b'; SELECT \"c;d\" FROM foo"),
+            (Statements{"SELECT 'a;''b'", "SELECT \"c;d\" FROM foo"}));
+  EXPECT_EQ(QueryParameterizer::SplitStatements("SELECT E'\\';' -- x;\n; /* y; /* z; */ */ SELECT $1"),
+            (Statements{"SELECT E'\\';' -- x;\n", "/* y; /* z; */ */ SELECT $1"}));
+  EXPECT_EQ(QueryParameterizer::SplitStatements("SELECT $tag$;$$;$tag$; SELECT $$;$$"),
+            (Statements{"SELECT $tag$;$$;$tag$", "SELECT $$;$$"}));
+  // Queries without a statement are left as they are
+  EXPECT_EQ(QueryParameterizer::SplitStatements(""), Statements{""});
+  EXPECT_EQ(QueryParameterizer::SplitStatements(" ; ;"), Statements{" ; ;"});
+}
+
+}  // namespace noisepage::network
@@ -0,0 +1,142 @@
+#include "optimizer/cost_model/cardinality_cost_model.h"
+
+#include <cmath>
+#include <string>
+
+#include "gtest/gtest.h"
+#include "optimizer/group.h"
+#include "optimizer/optimizer_context.h"
+#include "optimizer/physical_operators.h"
+#include "test_util/end_to_end_test.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::optimizer {
+class CardinalityCostModelTests : public test::EndToEndTest {
+ protected:
+  OptimizerContext context_{nullptr};
+  std::string table_name_1_ = "empty_nullable_table";
+  std::string table_name_2_ = "empty_table2";
+  catalog::table_oid_t table_oid_1_;
+  catalog::table_oid_t table_oid_2_;
+
+ public:
+  void SetUp() override {
+    EndToEndTest::SetUp();
+    auto exec_ctx = MakeExecCtx();
+    GenerateTestTables(exec_ctx.get());
+
+    context_.SetStatsStorage(stats_storage_.Get());
+    context_.SetCatalogAccessor(accessor_.get());
+
+    table_oid_1_ = accessor_->GetTableOid(table_name_1_);
+    table_oid_2_ = accessor_->GetTableOid(table_name_2_);
+  }
+
+  double Cost(GroupExpression *gexpr, uint32_t num_threads = 1) {
+    CardinalityCostModel cost_model(stats_storage_, num_threads);
+    return cost_model.CalculateCost(test_txn_, accessor_.get(), &context_.GetMemo(), gexpr);
+  }
+};
+
+// NOLINTNEXTLINE
+TEST_F(CardinalityCostModelTests, ScanChoiceTest) {
+  std::string insert = "INSERT INTO " + table_name_1_ + " VALUES (0)";
+  for (int i = 1; i < 1000; i++) insert += ", (" + std::to_string(i) + ")";
+  RunQuery(insert + ";");
+  RunQuery("ANALYZE " + table_name_1_ + ";");
+  txn_manager_->Commit(test_txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
+  test_txn_ = txn_manager_->BeginTransaction();
+
+  Operator seq_scan =
+      SeqScan::Make(test_db_oid_, table_oid_1_, {}, table_name_1_, false).RegisterWithTxnContext(test_txn_);
+  GroupExpression *seq_scan_gexpr = new GroupExpression(seq_scan, {}, test_txn_);
+  seq_scan_gexpr = context_.GetMemo().InsertExpression(seq_scan_gexpr, false);
+
+  Operator index_scan = IndexScan::Make(test_db_oid_, table_oid_1_, catalog::index_oid_t(1), {}, false,
+                                        planner::IndexScanType::Exact, {}, false)
+                            .RegisterWithTxnContext(test_txn_);
+  GroupExpression *index_scan_gexpr = new GroupExpression(index_scan, {}, test_txn_);
+  index_scan_gexpr = context_.GetMemo().InsertExpression(index_scan_gexpr, seq_scan_gexpr->GetGroupID(), false);
+  auto *group = context_.GetMemo().GetGroupByID(seq_scan_gexpr->GetGroupID());
+
+  // A selective predicate makes the index scan cheaper, since it reads a single tuple instead of the whole table
+  group->SetNumRows(1);
+  EXPECT_DOUBLE_EQ(Cost(seq_scan_gexpr), 1000 * CardinalityCostModel::SEQ_SCAN_TUPLE_COST);
+  EXPECT_LT(Cost(index_scan_gexpr), Cost(seq_scan_gexpr));
+
+  // Reading the whole table through the index is more expensive than reading it sequentially
+  group->SetNumRows(1000);
+  EXPECT_LT(Cost(seq_scan_gexpr), Cost(index_scan_gexpr));
+}
+
+// NOLINTNEXTLINE
+TEST_F(CardinalityCostModelTests, JoinChoiceTest) {
+  Operator scan_1 =
+      SeqScan::Make(test_db_oid_, table_oid_1_, {}, table_name_1_, false).RegisterWithTxnContext(test_txn_);
+  GroupExpression *scan_1_gexpr =
+      context_.GetMemo().InsertExpression(new GroupExpression(scan_1, {}, test_txn_), false);
+  Operator scan_2 =
+      SeqScan::Make(test_db_oid_, table_oid_2_, {}, table_name_2_, false).RegisterWithTxnContext(test_txn_);
+  GroupExpression *scan_2_gexpr =
+      context_.GetMemo().InsertExpression(new GroupExpression(scan_2, {}, test_txn_), false);
+  auto *left_group = context_.GetMemo().GetGroupByID(scan_1_gexpr->GetGroupID());
+  auto *right_group = context_.GetMemo().GetGroupByID(scan_2_gexpr->GetGroupID());
+
+  Operator nl_join = InnerNLJoin::Make({}).RegisterWithTxnContext(test_txn_);
+  GroupExpression *nl_join_gexpr = context_.GetMemo().InsertExpression(
+      new GroupExpression(nl_join, {scan_1_gexpr->GetGroupID(), scan_2_gexpr->GetGroupID()}, test_txn_), false);
+  Operator hash_join = InnerHashJoin::Make({}, {}, {}).RegisterWithTxnContext(test_txn_);
+  GroupExpression *hash_join_gexpr = context_.GetMemo().InsertExpression(
+      new GroupExpression(hash_join, {scan_1_gexpr->GetGroupID(), scan_2_gexpr->GetGroupID()}, test_txn_),
+      nl_join_gexpr->GetGroupID(), false);
+  auto *join_group = context_.GetMemo().GetGroupByID(nl_join_gexpr->GetGroupID());
+
+  // Looping over a single tuple is cheaper than building and probing a hash table
+  left_group->SetNumRows(1);
+  right_group->SetNumRows(10000);
+  join_group->SetNumRows(1);
+  EXPECT_LT(Cost(nl_join_gexpr), Cost(hash_join_gexpr));
+
+  // Two large inputs are joined much faster with a hash table
+  left_group->SetNumRows(10000);
+  join_group->SetNumRows(10000);
+  EXPECT_LT(Cost(hash_join_gexpr), Cost(nl_join_gexpr));
+}
+
+// NOLINTNEXTLINE
+TEST_F(CardinalityCostModelTests, UnknownCardinalityTest) {
+  // A table that was never analyzed and a group whose cardinality was never derived both count as DEFAULT_NUM_ROWS
+  Operator scan =
+      SeqScan::Make(test_db_oid_, table_oid_1_, {}, table_name_1_, false).RegisterWithTxnContext(test_txn_);
+  GroupExpression *scan_gexpr = context_.GetMemo().InsertExpression(new GroupExpression(scan, {}, test_txn_), false);
+  Operator order_by = OrderBy::Make().RegisterWithTxnContext(test_txn_);
+  GroupExpression *order_by_gexpr = context_.GetMemo().InsertExpression(
+      new GroupExpression(order_by, {scan_gexpr->GetGroupID()}, test_txn_), false);
+
+  const auto rows = CardinalityCostModel::DEFAULT_NUM_ROWS;
+  EXPECT_DOUBLE_EQ(Cost(scan_gexpr), rows * CardinalityCostModel::SEQ_SCAN_TUPLE_COST);
+  EXPECT_DOUBLE_EQ(Cost(order_by_gexpr), rows * std::log2(rows + 1) * CardinalityCostModel::SORT_TUPLE_COST);
+}
+
+// NOLINTNEXTLINE
+TEST_F(CardinalityCostModelTests, ParallelismTest) {
+  Operator scan =
+      SeqScan::Make(test_db_oid_, table_oid_1_, {}, table_name_1_, false).RegisterWithTxnContext(test_txn_);
+  GroupExpression *scan_gexpr = context_.GetMemo().InsertExpression(new GroupExpression(scan, {}, test_txn_), false);
+  Operator index_scan = IndexScan::Make(test_db_oid_, table_oid_1_, catalog::index_oid_t(1), {}, false,
+                                        planner::IndexScanType::AscendingClosed, {}, false)
+                            .RegisterWithTxnContext(test_txn_);
+  GroupExpression *index_scan_gexpr = context_.GetMemo().InsertExpression(
+      new GroupExpression(index_scan, {}, test_txn_), scan_gexpr->GetGroupID(), false);
+  context_.GetMemo().GetGroupByID(scan_gexpr->GetGroupID())->SetNumRows(300);
+
+  // The threads split the sequential scan, but an index scan runs on one of them
+  EXPECT_DOUBLE_EQ(Cost(scan_gexpr, 4), Cost(scan_gexpr) / 4);
+  EXPECT_DOUBLE_EQ(Cost(index_scan_gexpr, 4), Cost(index_scan_gexpr));
+
+  // So reading a third of the table through the index only pays off without them
+  EXPECT_LT(Cost(index_scan_gexpr), Cost(scan_gexpr));
+  EXPECT_LT(Cost(scan_gexpr, 4), Cost(index_scan_gexpr, 4));
+}
+
+}  // namespace noisepage::optimizer
@@ -0,0 +1,193 @@
+#include "optimizer/join_order_enumerator.h"
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "optimizer/group.h"
+#include "optimizer/logical_operators.h"
+#include "optimizer/operator_node.h"
+#include "optimizer/optimizer_context.h"
+#include "optimizer/util.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/comparison_expression.h"
+#include "storage/record_buffer.h"
+#include "test_util/test_harness.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/timestamp_manager.h"
+#include "transaction/transaction_manager.h"
+
+namespace noisepage::optimizer {
+
+class JoinOrderEnumeratorTests : public TerrierTest {
+ protected:
+  void SetUp() override {
+    TerrierTest::SetUp();
+    deferred_action_manager_ =
+        std::make_unique<transaction::DeferredActionManager>(common::ManagedPointer(&timestamp_manager_));
+    buffer_pool_ = std::make_unique<storage::RecordBufferSegmentPool>(100, 2);
+    txn_manager_ = std::make_unique<transaction::TransactionManager>(
+        common::ManagedPointer(&timestamp_manager_), common::ManagedPointer(deferred_action_manager_),
+        common::ManagedPointer(buffer_pool_), false, false, nullptr);
+    txn_ = txn_manager_->BeginTransaction();
+    context_.SetTxn(txn_);
+  }
+
+  void TearDown() override {
+    // All operators created during optimization are cleaned up on abort
+    txn_manager_->Abort(txn_);
+    delete txn_;
+    TerrierTest::TearDown();
+  }
+
+  std::string Alias(size_t relation) { return "t" + std::to_string(relation); }
+
+  /** @return a join predicate between the first columns of two relations */
+  AnnotatedExpression Equality(size_t left, size_t right) {
+    std::vector<std::unique_ptr<parser::AbstractExpression>> children;
+    children.emplace_back(std::make_unique<parser::ColumnValueExpression>(Alias(left), "x"));
+    children.emplace_back(std::make_unique<parser::ColumnValueExpression>(Alias(right), "x"));
+    exprs_.emplace_back(
+        std::make_unique<parser::ComparisonExpression>(parser::ExpressionType::COMPARE_EQUAL, std::move(children)));
+    return AnnotatedExpression(common::ManagedPointer(exprs_.back()), {Alias(left), Alias(right)});
+  }
+
+  /**
+   * Inserts a left-deep join of the relations, in the given order, with every predicate on the topmost join
+   * @return group of the topmost join
+   */
+  group_id_t InsertJoin(const std::vector<size_t> &order, std::vector<AnnotatedExpression> predicates) {
+    std::unique_ptr<AbstractOptimizerNode> tree;
+    for (size_t i = 0; i < order.size(); i++) {
+      auto get = std::make_unique<OperatorNode>(
+          LogicalGet::Make(catalog::db_oid_t(1), catalog::INVALID_TABLE_OID, {}, Alias(order[i]), false)
+              .RegisterWithTxnContext(txn_),
+          std::vector<std::unique_ptr<AbstractOptimizerNode>>{}, txn_);
+      if (tree == nullptr) {
+        tree = std::move(get);
+        continue;
+      }
+      std::vector<std::unique_ptr<AbstractOptimizerNode>> children;
+      children.emplace_back(std::move(tree));
+      children.emplace_back(std::move(get));
+      auto join_predicates = i + 1 == order.size() ? std::move(predicates) : std::vector<AnnotatedExpression>{};
+      tree = std::make_unique<OperatorNode>(
+          LogicalInnerJoin::Make(std::move(join_predicates)).RegisterWithTxnContext(txn_), std::move(children), txn_);
+    }
+
+    GroupExpression *gexpr;
+    context_.RecordOptimizerNodeIntoGroup(common::ManagedPointer(tree), &gexpr);
+    return gexpr->GetGroupID();
+  }
+
+  /** Sets the cardinality of a relation that InsertJoin inserted */
+  void SetRows(size_t relation, int rows) {
+    for (size_t id = 0;; id++) {
+      auto *group = context_.GetMemo().GetGroupByID(group_id_t(id));
+      if (group->GetLogicalExpression()->Contents()->GetOpType() == OpType::LOGICALGET &&
+          group->GetTableAliases().count(Alias(relation)) != 0) {
+        group->SetNumRows(rows);
+        return;
+      }
+    }
+  }
+
+  /**
+   * Checks that every join of the tree under a group evaluates a predicate, which means that there is no cross
+   * product, and that every predicate is evaluated as low in the tree as possible
+   * @return number of joins in the tree
+   */
+  size_t CheckJoinTree(group_id_t group_id) {
+    auto *gexpr = context_.GetMemo().GetGroupByID(group_id)->GetLogicalExpression();
+    if (gexpr->Contents()->GetOpType() != OpType::LOGICALINNERJOIN) return 0;
+
+    const auto &predicates = gexpr->Contents()->GetContentsAs<LogicalInnerJoin>()->GetJoinPredicates();
+    EXPECT_FALSE(predicates.empty());
+    for (const auto &predicate : predicates) {
+      for (const auto child_group_id : gexpr->GetChildGroupIDs()) {
+        const auto &child_aliases = context_.GetMemo().GetGroupByID(child_group_id)->GetTableAliases();
+        EXPECT_FALSE(OptimizerUtil::IsSubset(child_aliases, predicate.GetTableAliasSet()));
+      }
+    }
+    return 1 + CheckJoinTree(gexpr->GetChildGroupId(0)) + CheckJoinTree(gexpr->GetChildGroupId(1));
+  }
+
+  transaction::TimestampManager timestamp_manager_;
+  std::unique_ptr<transaction::DeferredActionManager> deferred_action_manager_;
+  std::unique_ptr<storage::RecordBufferSegmentPool> buffer_pool_;
+  std::unique_ptr<transaction::TransactionManager> txn_manager_;
+  transaction::TransactionContext *txn_;
+  OptimizerContext context_{nullptr};
+  std::vector<std::unique_ptr<parser::AbstractExpression>> exprs_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(JoinOrderEnumeratorTests, SmallJoinTest) {
+  // A join of three relations is left to the rules
+  const auto root = InsertJoin({0, 1, 2}, {Equality(0, 1), Equality(1, 2)});
+  EXPECT_FALSE(JoinOrderEnumerator(&context_).OrderJoins(root));
+  auto *gexpr = context_.GetMemo().GetGroupByID(root)->GetLogicalExpression();
+  EXPECT_EQ(gexpr->Contents()->GetContentsAs<LogicalInnerJoin>()->GetJoinPredicates().size(), 2);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinOrderEnumeratorTests, AvoidCrossProductTest) {
+  // t0 - t1 - t2 - t3, written in an order that starts with a cross product of the two largest relations
+  const auto root = InsertJoin({0, 3, 1, 2}, {Equality(0, 1), Equality(1, 2), Equality(2, 3)});
+  SetRows(0, 1000000);
+  SetRows(1, 10);
+  SetRows(2, 10);
+  SetRows(3, 1000000);
+
+  EXPECT_TRUE(JoinOrderEnumerator(&context_).OrderJoins(root));
+  EXPECT_EQ(CheckJoinTree(root), 3);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinOrderEnumeratorTests, SmallestIntermediateResultTest) {
+  // A star around t0, where joining the selective t1 first keeps every intermediate result small
+  const auto root = InsertJoin({0, 3, 2, 1}, {Equality(0, 1), Equality(0, 2), Equality(0, 3)});
+  SetRows(0, 100000);
+  SetRows(1, 1);
+  SetRows(2, 100000);
+  SetRows(3, 100000);
+
+  EXPECT_TRUE(JoinOrderEnumerator(&context_).OrderJoins(root));
+  EXPECT_EQ(CheckJoinTree(root), 3);
+
+  // The lowest join is the one between t0 and t1
+  auto *gexpr = context_.GetMemo().GetGroupByID(root)->GetLogicalExpression();
+  while (true) {
+    auto *left = context_.GetMemo().GetGroupByID(gexpr->GetChildGroupId(0))->GetLogicalExpression();
+    auto *right = context_.GetMemo().GetGroupByID(gexpr->GetChildGroupId(1))->GetLogicalExpression();
+    if (left->Contents()->GetOpType() == OpType::LOGICALINNERJOIN) {
+      gexpr = left;
+    } else if (right->Contents()->GetOpType() == OpType::LOGICALINNERJOIN) {
+      gexpr = right;
+    } else {
+      break;
+    }
+  }
+  const std::unordered_set<std::string> expected{Alias(0), Alias(1)};
+  EXPECT_EQ(context_.GetMemo().GetGroupByID(gexpr->GetGroupID())->GetTableAliases(), expected);
+}
+
+// NOLINTNEXTLINE
+TEST_F(JoinOrderEnumeratorTests, GreedyJoinTest) {
+  // A chain of more relations than dynamic programming handles, written in the worst order
+  const size_t num_relations = JoinOrderEnumerator::MAX_DP_RELATIONS + 5;
+  std::vector<size_t> order;
+  std::vector<AnnotatedExpression> predicates;
+  for (size_t i = 0; i < num_relations; i += 2) order.push_back(i);
+  for (size_t i = 1; i < num_relations; i += 2) order.push_back(i);
+  for (size_t i = 1; i < num_relations; i++) predicates.push_back(Equality(i - 1, i));
+  const auto root = InsertJoin(order, std::move(predicates));
+  for (size_t i = 0; i < num_relations; i++) SetRows(i, static_cast<int>(10 * (i + 1)));
+
+  EXPECT_TRUE(JoinOrderEnumerator(&context_).OrderJoins(root));
+  EXPECT_EQ(CheckJoinTree(root), num_relations - 1);
+}
+
+}  // namespace noisepage::optimizer
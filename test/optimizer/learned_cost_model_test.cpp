@@ -0,0 +1,57 @@
+#include "optimizer/cost_model/learned_cost_model.h"
+
+#include <chrono>  // NOLINT
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "self_driving/model_server/model_server_manager.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::optimizer {
+
+class LearnedCostModelTests : public TerrierTest {};
+
+// NOLINTNEXTLINE
+TEST_F(LearnedCostModelTests, PredictionCacheTest) {
+  OUPredictionCache cache;
+  const std::vector<double> features{2000, 0, 100, 8, 0, 100, 1, 0, 0};
+  EXPECT_FALSE(cache.Get(selfdriving::ExecutionOperatingUnitType::SEQ_SCAN, features).has_value());
+
+  cache.Put(selfdriving::ExecutionOperatingUnitType::SEQ_SCAN, features, 42);
+  EXPECT_EQ(cache.Get(selfdriving::ExecutionOperatingUnitType::SEQ_SCAN, features), 42);
+
+  // Both the operating unit and every feature are part of the key
+  EXPECT_FALSE(cache.Get(selfdriving::ExecutionOperatingUnitType::IDX_SCAN, features).has_value());
+  auto other_features = features;
+  other_features[2] = 101;
+  EXPECT_FALSE(cache.Get(selfdriving::ExecutionOperatingUnitType::SEQ_SCAN, other_features).has_value());
+
+  // A full cache starts over
+  for (size_t i = 0; i < OUPredictionCache::MAX_ENTRIES; i++) {
+    other_features[2] = 1000 + static_cast<double>(i);
+    cache.Put(selfdriving::ExecutionOperatingUnitType::SEQ_SCAN, other_features, 1);
+  }
+  EXPECT_FALSE(cache.Get(selfdriving::ExecutionOperatingUnitType::SEQ_SCAN, features).has_value());
+  EXPECT_EQ(cache.Get(selfdriving::ExecutionOperatingUnitType::SEQ_SCAN, other_features), 1);
+}
+
+// NOLINTNEXTLINE
+TEST_F(LearnedCostModelTests, ModelServerTimeoutTest) {
+  // The model is only asked for as long as the optimizer is willing to wait
+  modelserver::ModelServerFuture<std::string> future;
+  const auto start = std::chrono::steady_clock::now();
+  const auto result = future.WaitFor(std::chrono::milliseconds(10));
+  EXPECT_FALSE(result.second);
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(10));
+
+  // An answer that comes in time is returned
+  std::thread server([&] { future.Success("prediction"); });
+  const auto answer = future.WaitFor(std::chrono::seconds(10));
+  server.join();
+  EXPECT_TRUE(answer.second);
+  EXPECT_EQ(answer.first, "prediction");
+}
+
+}  // namespace noisepage::optimizer
@@ -326,6 +326,30 @@ TEST_F(OperatorTransformerTest, UpdateStatementSimpleTest) {
             logical_get->GetPredicates()[0].GetExpr()->GetExpressionType());
 }
 
+// NOLINTNEXTLINE
+TEST_F(OperatorTransformerTest, UpdateStatementSimplifiedPredicateTest) {
+  OPTIMIZER_LOG_DEBUG("Parsing sql query");
+  std::string update_sql = "UPDATE A SET A1 = 999 WHERE 1 + 2 < A1 * 1 AND TRUE";
+
+  auto parse_tree = parser::PostgresParser::BuildParseTree(update_sql);
+  auto statement = parse_tree->GetStatements()[0];
+  binder_->BindNameToNode(common::ManagedPointer(parse_tree), nullptr, nullptr);
+  operator_transformer_ =
+      std::make_unique<optimizer::QueryToOperatorTransformer>(common::ManagedPointer(accessor_), db_oid_);
+  operator_tree_ = operator_transformer_->ConvertToOpExpression(statement, common::ManagedPointer(parse_tree));
+
+  // The predicate is simplified to A1 > 3
+  auto logical_get = operator_tree_->GetChildren()[0]->Contents()->GetContentsAs<optimizer::LogicalGet>();
+  ASSERT_EQ(logical_get->GetPredicates().size(), 1);
+  auto predicate = logical_get->GetPredicates()[0].GetExpr();
+  EXPECT_EQ(parser::ExpressionType::COMPARE_GREATER_THAN, predicate->GetExpressionType());
+  EXPECT_EQ(parser::ExpressionType::COLUMN_VALUE, predicate->GetChild(0)->GetExpressionType());
+  EXPECT_EQ("a1", predicate->GetChild(0).CastManagedPointerTo<parser::ColumnValueExpression>()->GetColumnName());
+  auto constant = predicate->GetChild(1).CastManagedPointerTo<parser::ConstantValueExpression>();
+  EXPECT_EQ(parser::ExpressionType::VALUE_CONSTANT, constant->GetExpressionType());
+  EXPECT_EQ(constant->GetInteger().val_, 3);
+}
+
 // NOLINTNEXTLINE
 TEST_F(OperatorTransformerTest, SelectStatementAggregateTest) {
   OPTIMIZER_LOG_DEBUG("Parsing sql query");
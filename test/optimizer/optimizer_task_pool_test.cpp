@@ -0,0 +1,80 @@
+#include "optimizer/optimizer_task_pool.h"
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "test_util/test_harness.h"
+
+namespace noisepage::optimizer {
+
+class OptimizerTaskPoolTests : public TerrierTest {};
+
+/**
+ * Task that records itself in the log of its job, and then pushes the tasks that count down from it
+ */
+class CountdownTask : public OptimizerTask {
+ public:
+  struct Log {
+    std::vector<int> values_;
+    std::vector<std::thread::id> threads_;
+  };
+
+  CountdownTask(OptimizerTaskPool *pool, Log *log, int value)
+      : OptimizerTask(nullptr, OptimizerTaskType::OPTIMIZE_GROUP), pool_(pool), log_(log), value_(value) {}
+
+  void Execute() override {
+    log_->values_.push_back(value_);
+    log_->threads_.push_back(std::this_thread::get_id());
+    if (value_ < 0) throw std::runtime_error("countdown failed");
+    // The task pushed last runs first, so the job counts down in order
+    for (int value = 0; value < value_; value++) pool_->Push(new CountdownTask(pool_, log_, value));
+  }
+
+ private:
+  OptimizerTaskPool *pool_;
+  Log *log_;
+  int value_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(OptimizerTaskPoolTests, JobStackOrderTest) {
+  const int num_jobs = 16;
+  const int num_values = 5;
+  ConcurrentOptimizerTaskPool pool(4);
+  std::vector<CountdownTask::Log> logs(num_jobs);
+  for (auto &log : logs) pool.Push(new CountdownTask(&pool, &log, num_values));
+  EXPECT_FALSE(pool.Empty());
+  pool.ExecuteJobs();
+  EXPECT_TRUE(pool.Empty());
+
+  // Every task of a job ran on the same thread, in stack order
+  for (const auto &log : logs) {
+    ASSERT_FALSE(log.values_.empty());
+    EXPECT_EQ(log.values_.front(), num_values);
+    for (const auto thread : log.threads_) EXPECT_EQ(thread, log.threads_.front());
+    EXPECT_EQ(log.values_.back(), 0);
+  }
+
+  // The pool can run more jobs afterwards
+  CountdownTask::Log log;
+  pool.Push(new CountdownTask(&pool, &log, 1));
+  pool.ExecuteJobs();
+  EXPECT_EQ(log.values_, (std::vector<int>{1, 0}));
+}
+
+// NOLINTNEXTLINE
+TEST_F(OptimizerTaskPoolTests, JobExceptionTest) {
+  ConcurrentOptimizerTaskPool pool(2);
+  CountdownTask::Log failing_log;
+  CountdownTask::Log log;
+  pool.Push(new CountdownTask(&pool, &failing_log, -1));
+  pool.Push(new CountdownTask(&pool, &log, 3));
+  EXPECT_THROW(pool.ExecuteJobs(), std::runtime_error);
+
+  // The failure is only reported once
+  pool.Push(new CountdownTask(&pool, &log, 0));
+  EXPECT_NO_THROW(pool.ExecuteJobs());
+}
+
+}  // namespace noisepage::optimizer
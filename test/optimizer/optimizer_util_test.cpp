@@ -0,0 +1,88 @@
+#include "optimizer/util.h"
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "execution/sql/value.h"
+#include "gtest/gtest.h"
+#include "optimizer/optimizer_defs.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/comparison_expression.h"
+#include "parser/expression/constant_value_expression.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::optimizer {
+
+class OptimizerUtilTests : public TerrierTest {
+ protected:
+  // The integer column col of a table
+  std::unique_ptr<parser::AbstractExpression> Column(const std::string &table) const {
+    const auto table_oid = catalog::table_oid_t(table[0]);
+    return std::make_unique<parser::ColumnValueExpression>(table, "col", catalog::db_oid_t(1), table_oid,
+                                                           catalog::col_oid_t(1), type::TypeId::INTEGER);
+  }
+
+  // Add the predicate (lhs cmp_type rhs) on the given tables
+  void AddPredicate(parser::ExpressionType cmp_type, std::unique_ptr<parser::AbstractExpression> lhs,
+                    std::unique_ptr<parser::AbstractExpression> rhs, std::unordered_set<std::string> aliases) {
+    std::vector<std::unique_ptr<parser::AbstractExpression>> children;
+    children.emplace_back(std::move(lhs));
+    children.emplace_back(std::move(rhs));
+    exprs_.emplace_back(std::make_unique<parser::ComparisonExpression>(cmp_type, std::move(children)));
+    predicates_.emplace_back(common::ManagedPointer(exprs_.back()), std::move(aliases));
+  }
+
+  std::unique_ptr<parser::AbstractExpression> Constant(int64_t value) const {
+    return std::make_unique<parser::ConstantValueExpression>(type::TypeId::INTEGER, execution::sql::Integer(value));
+  }
+
+  std::vector<std::unique_ptr<parser::AbstractExpression>> exprs_;
+  std::vector<AnnotatedExpression> predicates_;
+};
+
+// NOLINTNEXTLINE
+TEST_F(OptimizerUtilTests, InferTransitivePredicatesTest) {
+  // a.col = b.col AND b.col = c.col AND 5 > a.col
+  AddPredicate(parser::ExpressionType::COMPARE_EQUAL, Column("a"), Column("b"), {"a", "b"});
+  AddPredicate(parser::ExpressionType::COMPARE_EQUAL, Column("b"), Column("c"), {"b", "c"});
+  AddPredicate(parser::ExpressionType::COMPARE_GREATER_THAN, Constant(5), Column("a"), {"a"});
+
+  std::vector<std::unique_ptr<parser::AbstractExpression>> inferred_exprs;
+  OptimizerUtil::InferTransitivePredicates(&predicates_, &inferred_exprs);
+
+  // 5 > b.col follows from the first equality, and 5 > c.col from the second one
+  ASSERT_EQ(inferred_exprs.size(), 2);
+  ASSERT_EQ(predicates_.size(), 5);
+  for (size_t idx = 0; idx < 2; idx++) {
+    const auto &predicate = predicates_[3 + idx];
+    const std::string table = idx == 0 ? "b" : "c";
+    EXPECT_EQ(predicate.GetExpr().Get(), inferred_exprs[idx].get());
+    EXPECT_EQ(predicate.GetTableAliasSet(), std::unordered_set<std::string>{table});
+    EXPECT_EQ(predicate.GetExpr()->GetExpressionType(), parser::ExpressionType::COMPARE_GREATER_THAN);
+    EXPECT_EQ(*predicate.GetExpr()->GetChild(0), *Constant(5));
+    EXPECT_EQ(*predicate.GetExpr()->GetChild(1), *Column(table));
+  }
+
+  // Everything that can be inferred is there already
+  inferred_exprs.clear();
+  OptimizerUtil::InferTransitivePredicates(&predicates_, &inferred_exprs);
+  EXPECT_TRUE(inferred_exprs.empty());
+  EXPECT_EQ(predicates_.size(), 5);
+}
+
+// NOLINTNEXTLINE
+TEST_F(OptimizerUtilTests, InferTransitivePredicatesIgnoresJoinsTest) {
+  // a.col = b.col AND a.col < c.col compares a.col with a column, not a value
+  AddPredicate(parser::ExpressionType::COMPARE_EQUAL, Column("a"), Column("b"), {"a", "b"});
+  AddPredicate(parser::ExpressionType::COMPARE_LESS_THAN, Column("a"), Column("c"), {"a", "c"});
+
+  std::vector<std::unique_ptr<parser::AbstractExpression>> inferred_exprs;
+  OptimizerUtil::InferTransitivePredicates(&predicates_, &inferred_exprs);
+  EXPECT_TRUE(inferred_exprs.empty());
+  EXPECT_EQ(predicates_.size(), 2);
+}
+
+}  // namespace noisepage::optimizer
@@ -3,6 +3,7 @@
 #include "gtest/gtest.h"
 #include "optimizer/logical_operators.h"
 #include "optimizer/optimizer_context.h"
+#include "optimizer/statistics/cardinality_feedback.h"
 #include "parser/expression/column_value_expression.h"
 #include "parser/expression/comparison_expression.h"
 #include "parser/expression/conjunction_expression.h"
@@ -77,6 +78,31 @@ TEST_F(StatsCalculatorTests, TestLogicalGet) {
   EXPECT_TRUE(root_group->HasNumRows());
 }
 
+// NOLINTNEXTLINE
+TEST_F(StatsCalculatorTests, TestLogicalGetCardinalityFeedback) {
+  RunQuery("INSERT INTO " + table_name_1_ + " VALUES(1), (NULL), (3);");
+  RunQuery("ANALYZE " + table_name_1_ + ";");
+  txn_manager_->Commit(test_txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
+  test_txn_ = txn_manager_->BeginTransaction();
+
+  // The scan was observed to produce far more rows than the statistics say it has
+  CardinalityFeedback feedback;
+  feedback.Add({table_name_1_}, 1000);
+  context_.SetCardinalityFeedback(common::ManagedPointer<const CardinalityFeedback>(&feedback));
+
+  Operator logical_get =
+      LogicalGet::Make(test_db_oid_, table_oid_1_, {}, table_name_1_, false).RegisterWithTxnContext(test_txn_);
+  GroupExpression *gexpr = new GroupExpression(logical_get, {}, test_txn_);
+  gexpr->SetGroupID(group_id_t(1));
+  context_.GetMemo().InsertExpression(gexpr, false);
+
+  stats_calculator_.CalculateStats(gexpr, &context_);
+
+  auto *root_group = context_.GetMemo().GetGroupByID(gexpr->GetGroupID());
+  EXPECT_EQ(root_group->GetNumRows(), 1000);
+  EXPECT_TRUE(root_group->HasNumRows());
+}
+
 // NOLINTNEXTLINE
 TEST_F(StatsCalculatorTests, TestInvalidLogicalGet) {
   // Constructing logical get with no predicates from invalid table
@@ -376,6 +402,56 @@ TEST_F(StatsCalculatorTests, TestMultipleParamPredicate) {
   EXPECT_TRUE(root_group->HasNumRows());
 }
 
+// NOLINTNEXTLINE
+TEST_F(StatsCalculatorTests, TestColumnGroupPredicates) {
+  RunQuery("INSERT INTO " + table_name_2_ + " VALUES(1, TRUE), (1, TRUE), (2, FALSE), (2, FALSE);");
+  RunQuery("ANALYZE " + table_name_2_ + ";");
+  txn_manager_->Commit(test_txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
+  test_txn_ = txn_manager_->BeginTransaction();
+
+  // Constructing Logical Get with two predicates "colA = 1 AND colB = TRUE" from "empty_table2"
+  parser::ColumnValueExpression col_a(table_name_2_, table_2_col_1_name_, test_db_oid_, table_oid_2_,
+                                      table_2_col_1_oid_, type::TypeId::INTEGER);
+  parser::ColumnValueExpression col_b(table_name_2_, table_2_col_2_name_, test_db_oid_, table_oid_2_,
+                                      table_2_col_2_oid_, type::TypeId::BOOLEAN);
+
+  std::vector<std::unique_ptr<parser::AbstractExpression>> equal1_child_exprs;
+  equal1_child_exprs.emplace_back(col_a.Copy());
+  equal1_child_exprs.emplace_back(
+      std::make_unique<parser::ConstantValueExpression>(type::TypeId::INTEGER, execution::sql::Integer(1)));
+  parser::ComparisonExpression equals1(parser::ExpressionType::COMPARE_EQUAL, std::move(equal1_child_exprs));
+  AnnotatedExpression annotated_equals1(common::ManagedPointer<parser::AbstractExpression>(&equals1), {});
+
+  std::vector<std::unique_ptr<parser::AbstractExpression>> equal2_child_exprs;
+  equal2_child_exprs.emplace_back(col_b.Copy());
+  equal2_child_exprs.emplace_back(
+      std::make_unique<parser::ConstantValueExpression>(type::TypeId::BOOLEAN, execution::sql::BoolVal(true)));
+  parser::ComparisonExpression equals2(parser::ExpressionType::COMPARE_EQUAL, std::move(equal2_child_exprs));
+  AnnotatedExpression annotated_equals2(common::ManagedPointer<parser::AbstractExpression>(&equals2), {});
+
+  const auto estimate = [&](group_id_t group_id) {
+    Operator logical_get =
+        LogicalGet::Make(test_db_oid_, table_oid_2_, {annotated_equals1, annotated_equals2}, table_name_2_, false)
+            .RegisterWithTxnContext(test_txn_);
+    GroupExpression *gexpr = new GroupExpression(logical_get, {}, test_txn_);
+    gexpr->SetGroupID(group_id);
+    context_.GetMemo().InsertExpression(gexpr, false);
+    stats_calculator_.CalculateStats(gexpr, &context_);
+    return context_.GetMemo().GetGroupByID(gexpr->GetGroupID())->GetNumRows();
+  };
+
+  // Half of the rows match each predicate, and the columns are taken to be independent
+  EXPECT_EQ(estimate(group_id_t(1)), 1);
+
+  // colA determines colB, so the rows that match colA = 1 also match colB = TRUE
+  {
+    auto table_stats = stats_storage_->GetTableStats(test_db_oid_, table_oid_2_, accessor_.get());
+    table_stats.table_stats_.GetColumnStats(table_2_col_1_oid_)
+        ->SetColumnGroupStats({ColumnGroupStats({table_2_col_1_oid_, table_2_col_2_oid_}, 2, {1.0, 1.0})});
+  }
+  EXPECT_EQ(estimate(group_id_t(2)), 2);
+}
+
 // NOLINTNEXTLINE
 TEST_F(StatsCalculatorTests, TestAndPredicate) {
   RunQuery("INSERT INTO " + table_name_1_ + " VALUES(1), (NULL), (3);");
@@ -641,6 +717,80 @@ TEST_F(StatsCalculatorTests, TestLogicalInnerJoin) {
   auto *get2_group = context_.GetMemo().GetGroupByID(get_gexpr2->GetGroupID());
   EXPECT_EQ(get2_group->GetNumRows(), 4);
   EXPECT_TRUE(get2_group->HasNumRows());
+
+  // The join keys are left with the distinct values they have in common
+  ASSERT_NE(root_group->GetStats(col_a1.GetFullName()), nullptr);
+  ASSERT_NE(root_group->GetStats(col_a2.GetFullName()), nullptr);
+  EXPECT_EQ(root_group->GetStats(col_a1.GetFullName())->GetDistinctValues(), 2);
+  EXPECT_EQ(root_group->GetStats(col_a2.GetFullName())->GetDistinctValues(), 2);
+  EXPECT_NE(root_group->GetStats(col_b.GetFullName()), nullptr);
+}
+
+// NOLINTNEXTLINE
+TEST_F(StatsCalculatorTests, TestLogicalInnerJoinWithoutCommonValues) {
+  RunQuery("INSERT INTO " + table_name_1_ + " VALUES(1), (2);");
+  RunQuery("ANALYZE " + table_name_1_ + ";");
+
+  RunQuery("INSERT INTO " + table_name_2_ + " VALUES(5, TRUE), (5, FALSE), (666, TRUE), (666, FALSE);");
+  RunQuery("ANALYZE " + table_name_2_ + ";");
+  txn_manager_->Commit(test_txn_, transaction::TransactionUtil::EmptyCallback, nullptr);
+  test_txn_ = txn_manager_->BeginTransaction();
+
+  // Constructing Logical Inner Join with join predicates "JOIN empty_nullable_table AND empty_table2
+  //  ON empty_nullable_table.colA = empty_table2.colA"
+  Operator logical_get1 =
+      LogicalGet::Make(test_db_oid_, table_oid_1_, {}, table_name_1_, false).RegisterWithTxnContext(test_txn_);
+  GroupExpression *get_gexpr1 = new GroupExpression(logical_get1, {}, test_txn_);
+  get_gexpr1->SetGroupID(group_id_t(0));
+  context_.GetMemo().InsertExpression(get_gexpr1, true);
+
+  Operator logical_get2 =
+      LogicalGet::Make(test_db_oid_, table_oid_2_, {}, table_name_2_, false).RegisterWithTxnContext(test_txn_);
+  GroupExpression *get_gexpr2 = new GroupExpression(logical_get2, {}, test_txn_);
+  get_gexpr2->SetGroupID(group_id_t(1));
+  context_.GetMemo().InsertExpression(get_gexpr2, true);
+
+  parser::ColumnValueExpression col_a1(table_name_1_, table_1_col_1_name_, test_db_oid_, table_oid_1_, table_1_col_oid_,
+                                       type::TypeId::INTEGER);
+  parser::ColumnValueExpression col_a2(table_name_2_, table_2_col_1_name_, test_db_oid_, table_oid_2_,
+                                       table_2_col_1_oid_, type::TypeId::INTEGER);
+  parser::ColumnValueExpression col_b(table_name_2_, table_2_col_2_name_, test_db_oid_, table_oid_2_,
+                                      table_2_col_2_oid_, type::TypeId::INTEGER);
+
+  std::vector<std::unique_ptr<parser::AbstractExpression>> equal_child_exprs;
+  equal_child_exprs.emplace_back(col_a1.Copy());
+  equal_child_exprs.emplace_back(col_a2.Copy());
+  parser::ComparisonExpression equals(parser::ExpressionType::COMPARE_EQUAL, std::move(equal_child_exprs));
+  common::ManagedPointer<parser::AbstractExpression> equal_expr(&equals);
+  AnnotatedExpression annotated_equals(equal_expr, {});
+
+  Operator logical_inner_join = LogicalInnerJoin::Make({annotated_equals}).RegisterWithTxnContext(test_txn_);
+  GroupExpression *join_gexpr = new GroupExpression(logical_inner_join, {group_id_t(0), group_id_t(1)}, test_txn_);
+  join_gexpr->SetGroupID(group_id_t(2));
+  context_.GetMemo().InsertExpression(join_gexpr, false);
+
+  ExprSet get1_required_cols;
+  ExprSet get2_required_cols;
+  ExprSet join_required_cols;
+  get1_required_cols.emplace(&col_a1);
+  get2_required_cols.emplace(&col_a2);
+  get2_required_cols.emplace(&col_b);
+  join_required_cols.emplace(&col_a1);
+  join_required_cols.emplace(&col_a2);
+  join_required_cols.emplace(&col_b);
+
+  stats_calculator_.CalculateStats(get_gexpr1, &context_);
+  stats_calculator_.CalculateStats(get_gexpr2, &context_);
+  stats_calculator_.CalculateStats(join_gexpr, &context_);
+
+  // None of the most common values of one side is on the other side, and the columns hold no other values
+  auto *root_group = context_.GetMemo().GetGroupByID(join_gexpr->GetGroupID());
+  EXPECT_EQ(root_group->GetNumRows(), 0);
+  auto *get2_group = context_.GetMemo().GetGroupByID(get_gexpr2->GetGroupID());
+  EXPECT_EQ(get2_group->GetNumRows(), 4);
+  ASSERT_NE(get2_group->GetStats(col_a2.GetFullName()), nullptr);
+  EXPECT_EQ(get2_group->GetStats(col_a2.GetFullName())->GetDistinctValues(), 2);
+  EXPECT_EQ(get2_group->GetStats(col_a2.GetFullName())->GetMostCommonValues().size(), 2);
 }
 
 }  // namespace noisepage::optimizer
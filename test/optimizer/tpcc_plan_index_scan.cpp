@@ -223,4 +223,24 @@ TEST_F(TpccPlanIndexScanTests, IndexFulfillSortAndPredicateWithLimitOffset) {
   OptimizeQuery(query, tbl_new_order_, check);
 }
 
+// NOLINTNEXTLINE
+TEST_F(TpccPlanIndexScanTests, PointQueryIndexScan) {
+  auto check = [](TpccPlanTest *test, parser::SelectStatement *sel_stmt, catalog::table_oid_t tbl_oid,
+                  std::unique_ptr<planner::AbstractPlanNode> plan) {
+    // Every column of the New Order Primary Key (NO_W_ID, NO_D_ID, NO_O_ID) is pinned, so it is looked up
+    EXPECT_EQ(plan->GetPlanNodeType(), planner::PlanNodeType::INDEXSCAN);
+    EXPECT_EQ(plan->GetChildrenSize(), 0);
+    auto index_plan = reinterpret_cast<planner::IndexScanPlanNode *>(plan.get());
+    EXPECT_EQ(index_plan->GetIndexOid(), test->pk_new_order_);
+    EXPECT_EQ(index_plan->GetScanType(), planner::IndexScanType::Exact);
+    EXPECT_EQ(index_plan->GetLoIndexColumns().size(), 3);
+    EXPECT_EQ(index_plan->IsForUpdate(), false);
+    EXPECT_EQ(index_plan->GetDatabaseOid(), test->db_);
+    EXPECT_EQ(index_plan->GetOutputSchema()->GetColumns().size(), 1);
+  };
+
+  std::string query = "SELECT NO_O_ID FROM \"NEW ORDER\" WHERE NO_W_ID = 1 AND NO_D_ID = 2 AND NO_O_ID = 3";
+  OptimizeQuery(query, tbl_new_order_, check);
+}
+
 }  // namespace noisepage::optimizer
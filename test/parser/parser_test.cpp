@@ -76,6 +76,17 @@ TEST_F(ParserTestBase, CopyTest) {
   auto copy_stmt = result->GetStatement(0).CastManagedPointerTo<CopyStatement>();
   EXPECT_EQ(copy_stmt->GetType(), StatementType::COPY);
   EXPECT_EQ(copy_stmt->GetExternalFileFormat(), ExternalFileFormat::BINARY);
+
+  // The text format is the default, and it separates values with tabs unless told otherwise
+  result = parser::PostgresParser::BuildParseTree("COPY foo FROM STDIN;");
+  copy_stmt = result->GetStatement(0).CastManagedPointerTo<CopyStatement>();
+  EXPECT_EQ(copy_stmt->GetExternalFileFormat(), ExternalFileFormat::TEXT);
+  EXPECT_EQ(copy_stmt->GetDelimiter(), '\t');
+
+  result = parser::PostgresParser::BuildParseTree("COPY foo FROM STDIN WITH (FORMAT csv);");
+  copy_stmt = result->GetStatement(0).CastManagedPointerTo<CopyStatement>();
+  EXPECT_EQ(copy_stmt->GetExternalFileFormat(), ExternalFileFormat::CSV);
+  EXPECT_EQ(copy_stmt->GetDelimiter(), ',');
 }
 
 // NOLINTNEXTLINE
@@ -215,6 +226,33 @@ TEST_F(ParserTestBase, CreateIndexTest) {
   EXPECT_EQ(ia2r->GetColumnName(), "o");
 }
 
+// NOLINTNEXTLINE
+TEST_F(ParserTestBase, PartialIndexTest) {
+  std::string query = "CREATE INDEX open_email ON users (lower(email)) WHERE status = 'open';";
+  auto result = parser::PostgresParser::BuildParseTree(query);
+  auto create_stmt = result->GetStatement(0).CastManagedPointerTo<CreateStatement>();
+
+  EXPECT_EQ(create_stmt->GetCreateType(), CreateStatement::kIndex);
+  EXPECT_EQ(create_stmt->GetIndexName(), "open_email");
+  ASSERT_EQ(create_stmt->GetIndexAttributes().size(), 1);
+  auto attr = create_stmt->GetIndexAttributes()[0].GetExpression();
+  EXPECT_EQ(attr->GetExpressionType(), ExpressionType::FUNCTION);
+  EXPECT_EQ(attr.CastManagedPointerTo<FunctionExpression>()->GetFuncName(), "lower");
+
+  auto predicate = create_stmt->GetIndexPredicate();
+  ASSERT_NE(predicate, nullptr);
+  EXPECT_EQ(predicate->GetExpressionType(), ExpressionType::COMPARE_EQUAL);
+  EXPECT_EQ(predicate->GetChild(0).CastManagedPointerTo<ColumnValueExpression>()->GetColumnName(), "status");
+  EXPECT_EQ(predicate->GetChild(1)->GetExpressionType(), ExpressionType::VALUE_CONSTANT);
+
+  result = parser::PostgresParser::BuildParseTree("CREATE INDEX plain ON users (email);");
+  create_stmt = result->GetStatement(0).CastManagedPointerTo<CreateStatement>();
+  EXPECT_EQ(create_stmt->GetIndexPredicate(), nullptr);
+
+  query = "CREATE UNIQUE INDEX open_email ON users (email) WHERE status = 'open';";
+  EXPECT_THROW(parser::PostgresParser::BuildParseTree(query), NotImplementedException);
+}
+
 // NOLINTNEXTLINE
 TEST_F(ParserTestBase, CreateTableTest) {
   std::string query =
@@ -242,6 +280,18 @@ TEST_F(ParserTestBase, CreateTableTest) {
   EXPECT_THROW(parser::PostgresParser::BuildParseTree(query), ParserException);
 }
 
+// NOLINTNEXTLINE
+TEST_F(ParserTestBase, CreateTempTableTest) {
+  auto result = parser::PostgresParser::BuildParseTree("CREATE TEMP TABLE foo (a INT);");
+  auto create_stmt = result->GetStatement(0).CastManagedPointerTo<CreateStatement>();
+  EXPECT_EQ(create_stmt->GetTableName(), "foo");
+  EXPECT_EQ(create_stmt->GetNamespaceName(), catalog::TEMP_NAMESPACE_ALIAS);
+
+  result = parser::PostgresParser::BuildParseTree("CREATE TABLE foo (a INT);");
+  create_stmt = result->GetStatement(0).CastManagedPointerTo<CreateStatement>();
+  EXPECT_TRUE(create_stmt->GetNamespaceName().empty());
+}
+
 // NOLINTNEXTLINE
 TEST_F(ParserTestBase, CreateViewTest) {
   auto result = parser::PostgresParser::BuildParseTree("CREATE VIEW foo AS SELECT * FROM bar WHERE baz = 1;");
@@ -263,6 +313,49 @@ TEST_F(ParserTestBase, CreateViewTest) {
   EXPECT_EQ(right_child.CastManagedPointerTo<ConstantValueExpression>()->Peek<int64_t>(), 1);
 }
 
+// NOLINTNEXTLINE
+TEST_F(ParserTestBase, CreateMaterializedViewTest) {
+  auto result = parser::PostgresParser::BuildParseTree(
+      "CREATE MATERIALIZED VIEW foo (a, b) AS SELECT baz, COUNT(*) FROM bar GROUP BY baz;");
+  auto create_stmt = result->GetStatement(0).CastManagedPointerTo<CreateStatement>();
+
+  EXPECT_EQ(create_stmt->GetCreateType(), CreateStatement::CreateType::kMaterializedView);
+  EXPECT_EQ(create_stmt->GetTableName(), "foo");
+  EXPECT_EQ(create_stmt->GetViewColumns(), std::vector<std::string>({"a", "b"}));
+  EXPECT_TRUE(create_stmt->IsWithData());
+  auto view_query = create_stmt->GetViewQuery();
+  EXPECT_NE(view_query, nullptr);
+  EXPECT_EQ(view_query->GetSelectTable()->GetTableName(), "bar");
+  EXPECT_EQ(view_query->GetSelectColumns().size(), 2);
+  EXPECT_NE(view_query->GetSelectGroupBy(), nullptr);
+
+  result = parser::PostgresParser::BuildParseTree("CREATE MATERIALIZED VIEW foo AS SELECT * FROM bar WITH NO DATA;");
+  create_stmt = result->GetStatement(0).CastManagedPointerTo<CreateStatement>();
+  EXPECT_TRUE(create_stmt->GetViewColumns().empty());
+  EXPECT_FALSE(create_stmt->IsWithData());
+
+  EXPECT_THROW(parser::PostgresParser::BuildParseTree("CREATE TABLE foo AS SELECT * FROM bar;"), ParserException);
+}
+
+// NOLINTNEXTLINE
+TEST_F(ParserTestBase, RefreshMaterializedViewTest) {
+  auto result = parser::PostgresParser::BuildParseTree("REFRESH MATERIALIZED VIEW foo;");
+  EXPECT_EQ(result->GetStatement(0)->GetType(), StatementType::REFRESH);
+  auto refresh_stmt = result->GetStatement(0).CastManagedPointerTo<RefreshStatement>();
+  EXPECT_EQ(refresh_stmt->GetView()->GetTableName(), "foo");
+  EXPECT_TRUE(refresh_stmt->IsWithData());
+
+  result = parser::PostgresParser::BuildParseTree("REFRESH MATERIALIZED VIEW bar.foo WITH NO DATA;");
+  refresh_stmt = result->GetStatement(0).CastManagedPointerTo<RefreshStatement>();
+  EXPECT_EQ(refresh_stmt->GetView()->GetNamespaceName(), "bar");
+  EXPECT_FALSE(refresh_stmt->IsWithData());
+
+  result = parser::PostgresParser::BuildParseTree("DROP MATERIALIZED VIEW foo;");
+  auto drop_stmt = result->GetStatement(0).CastManagedPointerTo<DropStatement>();
+  EXPECT_EQ(drop_stmt->GetDropType(), DropStatement::DropType::kTable);
+  EXPECT_EQ(drop_stmt->GetTableName(), "foo");
+}
+
 // NOLINTNEXTLINE
 TEST_F(ParserTestBase, DropDBTest) {
   auto result = parser::PostgresParser::BuildParseTree("DROP DATABASE test_db;");
@@ -1267,6 +1360,54 @@ TEST_F(ParserTestBase, OldTransactionTest) {
   EXPECT_EQ(transac_stmt->GetTransactionType(), TransactionStatement::kRollback);
 }
 
+// NOLINTNEXTLINE
+TEST_F(ParserTestBase, ReadOnlyTransactionTest) {
+  std::string query = "BEGIN;";
+  auto result = parser::PostgresParser::BuildParseTree(query);
+  auto transac_stmt = result->GetStatement(0).CastManagedPointerTo<TransactionStatement>();
+  EXPECT_FALSE(transac_stmt->IsReadOnly());
+
+  query = "BEGIN READ ONLY;";
+  result = parser::PostgresParser::BuildParseTree(query);
+  transac_stmt = result->GetStatement(0).CastManagedPointerTo<TransactionStatement>();
+  EXPECT_EQ(transac_stmt->GetTransactionType(), TransactionStatement::kBegin);
+  EXPECT_TRUE(transac_stmt->IsReadOnly());
+
+  query = "BEGIN TRANSACTION ISOLATION LEVEL SERIALIZABLE, READ ONLY;";
+  result = parser::PostgresParser::BuildParseTree(query);
+  transac_stmt = result->GetStatement(0).CastManagedPointerTo<TransactionStatement>();
+  EXPECT_TRUE(transac_stmt->IsReadOnly());
+
+  query = "BEGIN READ WRITE;";
+  result = parser::PostgresParser::BuildParseTree(query);
+  transac_stmt = result->GetStatement(0).CastManagedPointerTo<TransactionStatement>();
+  EXPECT_FALSE(transac_stmt->IsReadOnly());
+}
+
+// NOLINTNEXTLINE
+TEST_F(ParserTestBase, IsolationLevelTransactionTest) {
+  std::string query = "BEGIN;";
+  auto result = parser::PostgresParser::BuildParseTree(query);
+  auto transac_stmt = result->GetStatement(0).CastManagedPointerTo<TransactionStatement>();
+  EXPECT_FALSE(transac_stmt->GetIsolationLevel().has_value());
+
+  query = "BEGIN ISOLATION LEVEL SERIALIZABLE;";
+  result = parser::PostgresParser::BuildParseTree(query);
+  transac_stmt = result->GetStatement(0).CastManagedPointerTo<TransactionStatement>();
+  EXPECT_EQ(transac_stmt->GetIsolationLevel(), transaction::IsolationLevel::SERIALIZABLE);
+
+  query = "BEGIN TRANSACTION ISOLATION LEVEL SERIALIZABLE, READ ONLY;";
+  result = parser::PostgresParser::BuildParseTree(query);
+  transac_stmt = result->GetStatement(0).CastManagedPointerTo<TransactionStatement>();
+  EXPECT_EQ(transac_stmt->GetIsolationLevel(), transaction::IsolationLevel::SERIALIZABLE);
+  EXPECT_TRUE(transac_stmt->IsReadOnly());
+
+  query = "BEGIN ISOLATION LEVEL REPEATABLE READ;";
+  result = parser::PostgresParser::BuildParseTree(query);
+  transac_stmt = result->GetStatement(0).CastManagedPointerTo<TransactionStatement>();
+  EXPECT_EQ(transac_stmt->GetIsolationLevel(), transaction::IsolationLevel::SNAPSHOT);
+}
+
 // NOLINTNEXTLINE
 TEST_F(ParserTestBase, OldCreateIndexTest) {
   std::string query = "CREATE UNIQUE INDEX IDX_ORDER ON oorder (O_W_ID, O_D_ID);";
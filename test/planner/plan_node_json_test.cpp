@@ -33,6 +33,7 @@
 #include "planner/plannodes/index_scan_plan_node.h"
 #include "planner/plannodes/insert_plan_node.h"
 #include "planner/plannodes/limit_plan_node.h"
+#include "planner/plannodes/merge_join_plan_node.h"
 #include "planner/plannodes/nested_loop_join_plan_node.h"
 #include "planner/plannodes/order_by_plan_node.h"
 #include "planner/plannodes/output_schema.h"
@@ -41,6 +42,7 @@
 #include "planner/plannodes/seq_scan_plan_node.h"
 #include "planner/plannodes/set_op_plan_node.h"
 #include "planner/plannodes/update_plan_node.h"
+#include "planner/plannodes/window_plan_node.h"
 #include "test_util/storage_test_util.h"
 #include "test_util/test_harness.h"
 #include "type/type_id.h"
@@ -639,6 +641,7 @@ TEST(PlanNodeJsonTest, IndexScanPlanNodeJsonTest) {
                        .SetIsForUpdateFlag(false)
                        .SetDatabaseOid(catalog::db_oid_t(0))
                        .SetIndexOid(catalog::index_oid_t(0))
+                       .SetIndexOnly(true)
                        .Build();
 
   // Serialize to Json
@@ -650,6 +653,7 @@ TEST(PlanNodeJsonTest, IndexScanPlanNodeJsonTest) {
   auto deserialized_plan = common::ManagedPointer(deserialized.result_).CastManagedPointerTo<IndexScanPlanNode>();
   EXPECT_TRUE(deserialized_plan != nullptr);
   EXPECT_EQ(PlanNodeType::INDEXSCAN, deserialized_plan->GetPlanNodeType());
+  EXPECT_TRUE(deserialized_plan->IsIndexOnly());
   EXPECT_EQ(*plan_node, *deserialized_plan);
   EXPECT_EQ(plan_node->Hash(), deserialized_plan->Hash());
 }
@@ -740,6 +744,35 @@ TEST(PlanNodeJsonTest, LimitPlanNodeJsonTest) {
   EXPECT_EQ(plan_node->Hash(), deserialized_plan->Hash());
 }
 
+// NOLINTNEXTLINE
+TEST(PlanNodeJsonTest, MergeJoinPlanNodeJoinTest) {
+  // Construct MergeJoinPlanNode
+  auto left_merge_key = std::make_unique<parser::ColumnValueExpression>("table1", "col1");
+  auto right_merge_key = std::make_unique<parser::ColumnValueExpression>("table2", "col2");
+  auto join_pred = PlanNodeJsonTest::BuildDummyPredicate();
+  MergeJoinPlanNode::Builder builder;
+  auto plan_node =
+      builder.SetOutputSchema(PlanNodeJsonTest::BuildDummyOutputSchema())
+          .SetJoinType(LogicalJoinType::INNER)
+          .SetJoinPredicate(common::ManagedPointer(join_pred))
+          .AddLeftMergeKey(common::ManagedPointer(left_merge_key).CastManagedPointerTo<parser::AbstractExpression>())
+          .AddRightMergeKey(common::ManagedPointer(right_merge_key).CastManagedPointerTo<parser::AbstractExpression>())
+          .Build();
+
+  // Serialize to Json
+  auto json = plan_node->ToJson();
+  EXPECT_FALSE(json.is_null());
+
+  // Deserialize plan node
+  auto deserialized = DeserializePlanNode(json);
+  auto deserialized_plan = common::ManagedPointer(deserialized.result_).CastManagedPointerTo<MergeJoinPlanNode>();
+  EXPECT_TRUE(deserialized_plan != nullptr);
+  EXPECT_EQ(PlanNodeType::MERGEJOIN, deserialized_plan->GetPlanNodeType());
+  EXPECT_EQ(1U, deserialized_plan->GetLeftMergeKeys().size());
+  EXPECT_EQ(*plan_node, *deserialized_plan);
+  EXPECT_EQ(plan_node->Hash(), deserialized_plan->Hash());
+}
+
 // NOLINTNEXTLINE
 TEST(PlanNodeJsonTest, NestedLoopJoinPlanNodeJoinTest) {
   // Construct NestedLoopJoinPlanNode
@@ -900,4 +933,40 @@ TEST(PlanNodeJsonTest, UpdatePlanNodeJsonTest) {
   EXPECT_EQ(plan_node->Hash(), deserialized_plan->Hash());
 }
 
+// NOLINTNEXTLINE
+TEST(PlanNodeJsonTest, WindowPlanNodeJsonTest) {
+  // Construct WindowPlanNode
+  std::unique_ptr<parser::AbstractExpression> partition_term =
+      std::make_unique<parser::DerivedValueExpression>(type::TypeId::INTEGER, 0, 0);
+  std::unique_ptr<parser::AbstractExpression> sort_key =
+      std::make_unique<parser::DerivedValueExpression>(type::TypeId::INTEGER, 0, 1);
+  std::vector<std::unique_ptr<parser::AbstractExpression>> children;
+  children.push_back(std::make_unique<parser::DerivedValueExpression>(type::TypeId::INTEGER, 0, 1));
+  auto agg_term = std::make_unique<parser::AggregateExpression>(parser::ExpressionType::AGGREGATE_SUM,
+                                                                std::move(children), false);
+
+  WindowPlanNode::Builder builder;
+  auto plan_node = builder.SetOutputSchema(PlanNodeJsonTest::BuildDummyOutputSchema())
+                       .AddPartitionByTerm(common::ManagedPointer(partition_term))
+                       .AddSortKey(common::ManagedPointer(sort_key), optimizer::OrderByOrderingType::DESC)
+                       .AddWindowFunction(WindowFunctionType::ROW_NUMBER)
+                       .AddWindowFunction(WindowFunctionType::DENSE_RANK)
+                       .AddWindowFunction(WindowFunctionType::AGGREGATE, common::ManagedPointer(agg_term))
+                       .Build();
+
+  // Serialize to Json
+  auto json = plan_node->ToJson();
+  EXPECT_FALSE(json.is_null());
+
+  // Deserialize plan node
+  auto deserialized = DeserializePlanNode(json);
+  auto deserialized_plan = common::ManagedPointer(deserialized.result_).CastManagedPointerTo<WindowPlanNode>();
+  EXPECT_TRUE(deserialized_plan != nullptr);
+  EXPECT_EQ(PlanNodeType::WINDOW, deserialized_plan->GetPlanNodeType());
+  EXPECT_EQ(*plan_node, *deserialized_plan);
+  EXPECT_EQ(plan_node->Hash(), deserialized_plan->Hash());
+  EXPECT_EQ(3U, deserialized_plan->GetWindowFunctions().size());
+  EXPECT_TRUE(deserialized_plan->GetWindowFunctions()[0].second == nullptr);
+}
+
 }  // namespace noisepage::planner
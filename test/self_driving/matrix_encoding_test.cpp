@@ -0,0 +1,47 @@
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "self_driving/model_server/model_server_manager.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::modelserver {
+
+// Tests that matrices come back from their binary encoding bit for bit, and that malformed encodings are rejected
+// NOLINTNEXTLINE
+TEST(MatrixEncodingTests, RoundTripTest) {
+  std::default_random_engine generator;
+  std::uniform_real_distribution<double> distribution(-1e9, 1e9);
+  // Every number of rows and columns, so that the base64 encoding ends in every possible padding
+  for (size_t num_rows = 1; num_rows < 5; num_rows++) {
+    for (size_t num_cols = 1; num_cols < 7; num_cols++) {
+      std::vector<std::vector<double>> matrix(num_rows, std::vector<double>(num_cols));
+      for (auto &row : matrix) {
+        for (auto &value : row) value = distribution(generator);
+      }
+      std::vector<std::vector<double>> decoded;
+      ASSERT_TRUE(DecodeMatrix(EncodeMatrix(matrix), &decoded));
+      EXPECT_EQ(decoded, matrix);
+    }
+  }
+
+  // 1.5 and 2 as little endian doubles
+  const auto encoded = EncodeMatrix({{1.5, 2}});
+  EXPECT_EQ(encoded.at("data").get<std::string>(), "AAAAAAAA+D8AAAAAAAAAQA==");
+  EXPECT_EQ(encoded.at("shape").get<std::vector<size_t>>(), (std::vector<size_t>{1, 2}));
+
+  std::vector<std::vector<double>> decoded;
+  EXPECT_TRUE(DecodeMatrix(EncodeMatrix({}), &decoded));
+  EXPECT_TRUE(decoded.empty());
+
+  auto malformed = encoded;
+  malformed["shape"] = {2, 2};
+  EXPECT_FALSE(DecodeMatrix(malformed, &decoded));
+  malformed = encoded;
+  malformed["data"] = "AAAAAAAA+D8AAAAAAAAAQA=A";
+  EXPECT_FALSE(DecodeMatrix(malformed, &decoded));
+  malformed.erase("data");
+  EXPECT_FALSE(DecodeMatrix(malformed, &decoded));
+}
+
+}  // namespace noisepage::modelserver
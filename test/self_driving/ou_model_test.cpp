@@ -0,0 +1,124 @@
+#include "self_driving/modeling/ou_model.h"
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::selfdriving {
+
+namespace {
+
+// A model of 3 features and 2 labels without any transformations, for the regressor to be filled in
+nlohmann::json PlainModel(const nlohmann::json &regressor) {
+  const auto empty = nlohmann::json::array();
+  return {{"num_features", 3},   {"num_labels", 2},      {"log_transform", false}, {"log_epsilon", 1e-4},
+          {"x_mean", empty},     {"x_scale", empty},     {"y_mean", empty},        {"y_scale", empty},
+          {"x_transform", "none"}, {"y_transform", "none"}, {"num_rows_index", 0}, {"cardinality_index", 0},
+          {"memory_label_index", 0}, {"regressor", regressor}};
+}
+
+// Feature 0 <= 1 goes to a leaf, and the rest is split on feature 2 <= 5
+const nlohmann::json TREES = {
+    {"kind", "trees"},
+    {"float_features", false},
+    {"base", {10, 20}},
+    {"scale", 0.5},
+    {"trees",
+     {{{"labels", {0, 1}},
+       {"feature", {0, -1, 2, -1, -1}},
+       {"threshold", {1, 0, 5, 0, 0}},
+       {"left", {1, -1, 3, -1, -1}},
+       {"value", {0, 0, 1, 2, 0, 0, 3, 4, 5, 6}}},
+      {{"labels", {1}}, {"feature", {-1}}, {"threshold", {0}}, {"left", {-1}}, {"value", {100}}}}}};
+
+}  // namespace
+
+// Tests that the trees of a model route every row of a batch to the leaves that the features call for
+// NOLINTNEXTLINE
+TEST(OUModelTests, TreesTest) {
+  const OUModel model(PlainModel(TREES));
+  ASSERT_EQ(model.NumFeatures(), 3);
+  ASSERT_EQ(model.NumLabels(), 2);
+
+  // More rows than fit in a batch
+  std::vector<std::vector<double>> features;
+  for (int i = 0; i < 40; i++) features.push_back({static_cast<double>(i % 3), 0, static_cast<double>(i % 10)});
+  const auto labels = model.Predict(features);
+  ASSERT_EQ(labels.size(), features.size());
+  for (size_t i = 0; i < features.size(); i++) {
+    // The second tree adds 100 to the second label of every row, and the sums are scaled by half
+    const bool first_leaf = features[i][0] <= 1;
+    const bool second_leaf = features[i][2] <= 5;
+    const double first = first_leaf ? 1 : (second_leaf ? 3 : 5);
+    const double second = first_leaf ? 2 : (second_leaf ? 4 : 6);
+    EXPECT_EQ(labels[i], std::vector<double>({10 + 0.5 * first, 20 + 0.5 * (second + 100)})) << i;
+  }
+}
+
+// Tests that the features and labels are transformed around a linear model like Model.predict() does
+// NOLINTNEXTLINE
+TEST(OUModelTests, LinearTransformTest) {
+  auto exported = PlainModel({{"kind", "linear"}, {"coef", {{1, 0, 2}, {0, 1, 0}}}, {"intercept", {0.5, -1}}});
+  exported["log_transform"] = true;
+  exported["x_mean"] = {1, 2, 3};
+  exported["x_scale"] = {2, 4, 8};
+  exported["y_mean"] = {1, 0};
+  exported["y_scale"] = {3, 1};
+  exported["x_transform"] = "num_rows_cardinality_linear";
+  exported["y_transform"] = "num_rows_memory_cardinality_linear";
+  exported["num_rows_index"] = 0;
+  exported["cardinality_index"] = 1;
+  exported["memory_label_index"] = 1;
+  const OUModel model(exported);
+
+  const std::vector<double> features{9, 30, 4};
+  std::vector<double> x{9, 30 / (9 + 1.0), 4};
+  for (size_t i = 0; i < x.size(); i++) x[i] = (std::log(x[i] + 1e-4) - (i + 1.0)) / (2 << i);
+  std::vector<double> y{0.5 + x[0] + 2 * x[2], -1 + x[1]};
+  y[0] = std::max(std::exp(y[0] * 3 + 1) - 1e-4, 0.0) * (9 + 1);
+  y[1] = std::max(std::exp(y[1]) - 1e-4, 0.0) * (30 + 250);
+
+  const auto labels = model.Predict({features});
+  ASSERT_EQ(labels.size(), 1);
+  ASSERT_EQ(labels[0].size(), 2);
+  EXPECT_NEAR(labels[0][0], y[0], 1e-9 * y[0]);
+  EXPECT_NEAR(labels[0][1], y[1], 1e-9 * y[1]);
+}
+
+// Tests that exported model maps are loaded by the name of the operating units, and that malformed ones are not
+// NOLINTNEXTLINE
+TEST(OUModelTests, LoadTest) {
+  const std::string model_save_path = "./ou_model_test.pickle";
+  const auto path = OUModelMap::ExportPath(model_save_path);
+  EXPECT_EQ(path, "./ou_model_test.json");
+  EXPECT_EQ(OUModelMap::Load(path), nullptr);
+
+  OUModelMapLoader loader;
+  EXPECT_EQ(loader.Get(model_save_path), nullptr);
+
+  std::ofstream(path) << nlohmann::json{{"version", 1}, {"models", {{"SEQ_SCAN", PlainModel(TREES)}}}}.dump();
+  const auto models = loader.Get(model_save_path);
+  ASSERT_NE(models, nullptr);
+  ASSERT_NE(models->GetModel(ExecutionOperatingUnitType::SEQ_SCAN), nullptr);
+  EXPECT_EQ(models->GetModel(ExecutionOperatingUnitType::SEQ_SCAN)->Predict({{0, 0, 0}})[0],
+            std::vector<double>({10.5, 71}));
+  EXPECT_EQ(models->GetModel(ExecutionOperatingUnitType::IDX_SCAN), nullptr);
+  // Nothing changed
+  EXPECT_EQ(loader.Get(model_save_path), models);
+
+  // A child that comes before its parent could loop forever
+  auto malformed = TREES;
+  malformed["trees"][0]["left"][2] = 1;
+  std::ofstream(path) << nlohmann::json{{"version", 1}, {"models", {{"SEQ_SCAN", PlainModel(malformed)}}}}.dump();
+  EXPECT_EQ(OUModelMap::Load(path), nullptr);
+
+  std::remove(path.c_str());
+  EXPECT_EQ(loader.Get(model_save_path), nullptr);
+}
+
+}  // namespace noisepage::selfdriving
@@ -0,0 +1,74 @@
+#include "self_driving/forecasting/workload_forecast.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "gtest/gtest.h"
+#include "metrics/query_trace_metric.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::selfdriving {
+
+class WorkloadForecastTests : public TerrierTest {
+ protected:
+  void SetUp() override {
+    RemoveFiles();
+    Append(metrics::QueryTraceMetricRawData::FILES[0],
+           std::string(metrics::QueryTraceMetricRawData::FEATURE_COLUMNS[0]) + "\n1, 1, 0, \"SELECT 1\", \n" +
+               "1, 2, 0, \"SELECT $1\", INTEGER;\n");
+    Append(metrics::QueryTraceMetricRawData::FILES[1],
+           std::string(metrics::QueryTraceMetricRawData::FEATURE_COLUMNS[1]) + "\n1, 1, 100, \n1, 2, 150, 7;\n");
+  }
+
+  void TearDown() override { RemoveFiles(); }
+
+  static void RemoveFiles() {
+    for (const auto &file_name : metrics::QueryTraceMetricRawData::FILES) std::remove(std::string(file_name).c_str());
+  }
+
+  static void Append(const std::string_view file_name, const std::string &lines) {
+    std::ofstream file(std::string(file_name), std::ios_base::app);
+    file << lines;
+  }
+};
+
+// Tests that updates count the newly traced queries into the open segment or new ones, and only keep the latest
+// NOLINTNEXTLINE
+TEST_F(WorkloadForecastTests, UpdateTest) {
+  WorkloadForecast forecast(1000, 2);
+  ASSERT_EQ(forecast.GetNumberOfSegments(), 1);
+  EXPECT_EQ(forecast.GetSegmentByIndex(0).GetIdToNumexec().at(execution::query_id_t(1)), 1);
+  EXPECT_EQ(forecast.GetSegmentByIndex(0).GetIdToNumexec().at(execution::query_id_t(2)), 1);
+  EXPECT_EQ(forecast.GetDboidByQid(execution::query_id_t(2)), 1);
+  EXPECT_EQ(forecast.GetQueryparamsByQid(execution::query_id_t(2))->at(0).at(0).Peek<int64_t>(), 7);
+
+  // Nothing was traced since
+  forecast.Update();
+  ASSERT_EQ(forecast.GetNumberOfSegments(), 1);
+  EXPECT_EQ(forecast.GetSegmentByIndex(0).GetIdToNumexec().at(execution::query_id_t(1)), 1);
+
+  // A query within the interval of the open segment, and one the metrics thread is still writing
+  Append(metrics::QueryTraceMetricRawData::FILES[1], "1, 1, 900, \n1, 2, 1");
+  forecast.Update();
+  ASSERT_EQ(forecast.GetNumberOfSegments(), 1);
+  EXPECT_EQ(forecast.GetSegmentByIndex(0).GetIdToNumexec().at(execution::query_id_t(1)), 2);
+  EXPECT_EQ(forecast.GetSegmentByIndex(0).GetIdToNumexec().at(execution::query_id_t(2)), 1);
+
+  // The rest of that query falls past the interval and starts a new segment
+  Append(metrics::QueryTraceMetricRawData::FILES[1], "500, 8;\n");
+  forecast.Update();
+  ASSERT_EQ(forecast.GetNumberOfSegments(), 2);
+  EXPECT_EQ(forecast.GetSegmentByIndex(1).GetIdToNumexec().at(execution::query_id_t(2)), 1);
+  EXPECT_EQ(forecast.GetSegmentByIndex(1).GetIdToNumexec().count(execution::query_id_t(1)), 0);
+
+  // A third segment drops the first
+  Append(metrics::QueryTraceMetricRawData::FILES[1], "1, 1, 5000, \n");
+  forecast.Update();
+  ASSERT_EQ(forecast.GetNumberOfSegments(), 2);
+  EXPECT_EQ(forecast.GetSegmentByIndex(0).GetIdToNumexec().at(execution::query_id_t(2)), 1);
+  EXPECT_EQ(forecast.GetSegmentByIndex(1).GetIdToNumexec().at(execution::query_id_t(1)), 1);
+}
+
+}  // namespace noisepage::selfdriving
@@ -122,6 +122,33 @@ TEST_F(ModelServerTest, OUAndInterferenceModelTest) {
   result = ms_manager->InferOUModel("OP_SUPER_MAGICAL_DIVIDE", ou_model_save_path, features);
   ASSERT_FALSE(result.second);
 
+  // Batched inference predicts the same as inference one opunit at a time
+  OUMatrices batch{
+      {OpUnitToString(selfdriving::ExecutionOperatingUnitType::OP_INTEGER_PLUS_OR_MINUS), features},
+      {OpUnitToString(selfdriving::ExecutionOperatingUnitType::OP_REAL_COMPARE), {features[0]}},
+  };
+  ModelServerFuture<OUMatrices> batch_future;
+  ASSERT_TRUE(ms_manager->InferOUModelsAsync(ou_model_save_path, batch,
+                                             common::ManagedPointer<ModelServerFuture<OUMatrices>>(&batch_future)));
+  auto batch_result = batch_future.Wait();
+  ASSERT_TRUE(batch_result.second);
+  ASSERT_EQ(batch_result.first.size(), batch.size());
+  for (const auto &[opunit, opunit_features] : batch) {
+    auto single_result = ms_manager->InferOUModel(opunit, ou_model_save_path, opunit_features);
+    ASSERT_TRUE(single_result.second);
+    ASSERT_EQ(batch_result.first.at(opunit).size(), opunit_features.size());
+    for (size_t i = 0; i < opunit_features.size(); i++) {
+      ASSERT_EQ(batch_result.first.at(opunit)[i].size(), single_result.first[i].size());
+      for (size_t j = 0; j < single_result.first[i].size(); j++) {
+        EXPECT_DOUBLE_EQ(batch_result.first.at(opunit)[i][j], single_result.first[i][j]);
+      }
+    }
+  }
+
+  // A batch fails as a whole with an invalid opunit name
+  batch.emplace("OP_SUPER_MAGICAL_DIVIDE", features);
+  ASSERT_FALSE(ms_manager->InferOUModels(ou_model_save_path, batch).second);
+
   // -------------------------------------------------------
   // Start the interference model test
   // (the interference model test cannot be a separate test because it needs the OU models during training)
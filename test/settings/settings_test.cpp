@@ -217,6 +217,56 @@ TEST_F(SettingsTests, LogManagerSettingsTest) {
   EXPECT_EQ(new_serializatio_interval, log_manager_->GetSerializationInterval());
 }
 
+// NOLINTNEXTLINE
+TEST_F(SettingsTests, GarbageCollectorSettingsTest) {
+  std::unordered_map<Param, ParamInfo> param_map;
+  SettingsManager::ConstructParamMap(param_map);
+  auto db_main = DBMain::Builder()
+                     .SetSettingsParameterMap(std::move(param_map))
+                     .SetUseSettingsManager(true)
+                     .SetUseGC(true)
+                     .SetUseGCThread(true)
+                     .Build();
+  auto settings_manager = db_main->GetSettingsManager();
+  auto gc_thread = db_main->GetGarbageCollectorThread();
+
+  // Check default value is correctly passed to the gc thread
+  auto gc_interval = settings_manager->GetInt(Param::gc_interval);
+  EXPECT_EQ(gc_interval, gc_thread->GetGCPeriod().count());
+
+  // Change value
+  auto new_gc_interval = gc_interval * 2;
+  auto action_context = std::make_unique<common::ActionContext>(common::action_id_t(1));
+  settings_manager->SetInt(Param::gc_interval, new_gc_interval, common::ManagedPointer(action_context),
+                           SettingsTests::EmptySetterCallback);
+
+  // Check new value is propagated
+  EXPECT_EQ(action_context->GetState(), common::ActionState::SUCCESS);
+  EXPECT_EQ(new_gc_interval, settings_manager->GetInt(Param::gc_interval));
+  EXPECT_EQ(new_gc_interval, gc_thread->GetGCPeriod().count());
+}
+
+// A primary that replicates its log cannot split it into several streams, so it refuses to start.
+// NOLINTNEXTLINE
+TEST_F(SettingsTests, ReplicationLogStreamsTest) {
+  std::unordered_map<Param, ParamInfo> param_map;
+  SettingsManager::ConstructParamMap(param_map);
+  param_map.erase(Param::replication_enable);
+  param_map.emplace(Param::replication_enable,
+                    ParamInfo("replication_enable", parser::ConstantValueExpression(type::TypeId::BOOLEAN,
+                                                                                    execution::sql::BoolVal(true)),
+                              "", parser::ConstantValueExpression(type::TypeId::BOOLEAN, execution::sql::BoolVal(false)),
+                              false, 0, 0, Callbacks::NoOp));
+  param_map.erase(Param::wal_num_streams);
+  param_map.emplace(
+      Param::wal_num_streams,
+      ParamInfo("wal_num_streams", parser::ConstantValueExpression(type::TypeId::INTEGER, execution::sql::Integer(2)),
+                "", parser::ConstantValueExpression(type::TypeId::INTEGER, execution::sql::Integer(1)), false, 1, 64,
+                Callbacks::NoOp));
+  EXPECT_THROW(DBMain::Builder().SetSettingsParameterMap(std::move(param_map)).SetUseSettingsManager(true).Build(),
+               SettingsException);
+}
+
 // Test concurrent modification to buffer pool size.
 // NOLINTNEXTLINE
 TEST_F(SettingsTests, ConcurrentModifyTest) {
@@ -59,6 +59,67 @@ TEST(AccessObserverTest, FilledBlocksObserved) {
   for (uint32_t i = 0; i <= COLD_DATA_EPOCH_THRESHOLD; i++) tested.ObserveGCInvocation();
   delete fake_block;
 }
+
+// Tests that a block written to after it was sent to the compactor has to stay cold for twice as long
+// NOLINTNEXTLINE
+TEST(AccessObserverTest, PreemptedBlocksBackOff) {
+  std::default_random_engine generator;
+  storage::BlockLayout layout = StorageTestUtil::RandomLayoutNoVarlen(100, &generator);
+  storage::TupleAccessStrategy accessor(layout);
+  storage::DataTable table(nullptr, layout, storage::layout_version_t(0));
+  auto *fake_block = new storage::RawBlock;
+  accessor.InitializeRawBlock(&table, fake_block, storage::layout_version_t(0));
+  fake_block->insert_head_ = layout.NumSlots();
+
+  MockBlockCompactor mock_compactor;
+  storage::AccessObserver tested(&mock_compactor);
+  // NOLINTNEXTLINE
+  EXPECT_CALL(mock_compactor, PutInQueue(fake_block)).Times(1);
+  tested.ObserveWrite(fake_block);
+  for (uint32_t i = 0; i <= COLD_DATA_EPOCH_THRESHOLD; i++) tested.ObserveGCInvocation();
+  ::testing::Mock::VerifyAndClearExpectations(&mock_compactor);
+  EXPECT_TRUE(accessor.GetArrowBlockMetadata(fake_block).GetAccessStats(layout).queued_);
+
+  // The block is still hot when it is written to again
+  tested.ObserveWrite(fake_block);
+  EXPECT_EQ(accessor.GetArrowBlockMetadata(fake_block).GetAccessStats(layout).num_preemptions_, 1);
+  // NOLINTNEXTLINE
+  EXPECT_CALL(mock_compactor, PutInQueue(::testing::_)).Times(0);
+  for (uint32_t i = 0; i < 2 * COLD_DATA_EPOCH_THRESHOLD; i++) tested.ObserveGCInvocation();
+  ::testing::Mock::VerifyAndClearExpectations(&mock_compactor);
+  // NOLINTNEXTLINE
+  EXPECT_CALL(mock_compactor, PutInQueue(fake_block)).Times(1);
+  tested.ObserveGCInvocation();
+  delete fake_block;
+}
+
+// Tests that a block that was written to a lot waits until its write frequency decays
+// NOLINTNEXTLINE
+TEST(AccessObserverTest, FrequentlyWrittenBlocksWait) {
+  std::default_random_engine generator;
+  storage::BlockLayout layout = StorageTestUtil::RandomLayoutNoVarlen(100, &generator);
+  storage::TupleAccessStrategy accessor(layout);
+  storage::DataTable table(nullptr, layout, storage::layout_version_t(0));
+  auto *fake_block = new storage::RawBlock;
+  accessor.InitializeRawBlock(&table, fake_block, storage::layout_version_t(0));
+  fake_block->insert_head_ = layout.NumSlots();
+
+  MockBlockCompactor mock_compactor;
+  storage::AccessObserver tested(&mock_compactor);
+  // The write frequency halves every GC invocation, and each write costs as much as freezing 16 full blocks gains
+  const uint32_t num_writes = 1024;
+  for (uint32_t i = 0; i < num_writes; i++) tested.ObserveWrite(fake_block);
+  // NOLINTNEXTLINE
+  EXPECT_CALL(mock_compactor, PutInQueue(::testing::_)).Times(0);
+  for (uint32_t i = 0; i <= COLD_DATA_EPOCH_THRESHOLD; i++) tested.ObserveGCInvocation();
+  ::testing::Mock::VerifyAndClearExpectations(&mock_compactor);
+
+  // Freezing an empty block gains twice as much as freezing a full one, so it is frozen once 1024 * 16 / 2^n <= 2
+  // NOLINTNEXTLINE
+  EXPECT_CALL(mock_compactor, PutInQueue(fake_block)).Times(1);
+  for (uint32_t n = COLD_DATA_EPOCH_THRESHOLD + 2; n <= 13; n++) tested.ObserveGCInvocation();
+  delete fake_block;
+}
 }  // namespace noisepage
 
 int main(int argc, char **argv) {
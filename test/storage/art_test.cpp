@@ -0,0 +1,243 @@
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "storage/index/adaptive_radix_tree.h"
+#include "storage/storage_defs.h"
+#include "test_util/multithread_test_util.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::storage::index {
+
+class AdaptiveRadixTreeTests : public TerrierTest {
+ public:
+  const uint32_t num_threads_ = 4;
+  common::WorkerPool thread_pool_{num_threads_, {}};
+
+  // The tree only stores and compares TupleSlots, so any 8 bytes make a value
+  static TupleSlot Slot(uint64_t value) {
+    TupleSlot slot;
+    std::memcpy(&slot, &value, sizeof(TupleSlot));
+    return slot;
+  }
+
+  static uint64_t Value(TupleSlot slot) {
+    uint64_t value;
+    std::memcpy(&value, &slot, sizeof(TupleSlot));
+    return value;
+  }
+
+  // Big-endian, so that memcmp order matches integer order
+  static std::string FixedKey(uint64_t x) {
+    std::string key;
+    for (int i = 7; i >= 0; i--) key.push_back(static_cast<char>((x >> (8 * i)) & 0xFF));
+    return key;
+  }
+
+  // Escaped and terminated the way GenericKey encodes varlens, so that no key is a prefix of another
+  static std::string VarlenKey(std::default_random_engine *generator) {
+    std::string key;
+    const uint32_t len = (*generator)() % 20;
+    for (uint32_t i = 0; i < len; i++) {
+      const char c = "ab\0c"[(*generator)() % 4];
+      key.push_back(c);
+      if (c == 0) key.push_back(static_cast<char>(0xFF));
+    }
+    key.push_back(0);
+    key.push_back(0);
+    return key;
+  }
+
+  static const byte *Bytes(const std::string &key) { return reinterpret_cast<const byte *>(key.data()); }
+
+ protected:
+  void SetUp() override { thread_pool_.Startup(); }
+
+  void TearDown() override { thread_pool_.Shutdown(); }
+};
+
+/**
+ * Applies random inserts, deletes and lookups of fixed and variable length keys, and checks every result and
+ * periodically the scans against a std::map. Keys with a long common prefix exercise prefixes longer than the part a
+ * node stores.
+ */
+// NOLINTNEXTLINE
+TEST_F(AdaptiveRadixTreeTests, RandomOperations) {
+  const auto never = [](TupleSlot) { return false; };
+  const auto always = [](TupleSlot) { return true; };
+
+  for (uint32_t mode = 0; mode < 3; mode++) {
+    AdaptiveRadixTree tree;
+    std::map<std::string, std::set<uint64_t>> reference;
+    std::default_random_engine generator(mode);
+
+    auto gen_key = [&] {
+      if (mode == 0) return FixedKey(generator() % 2000);
+      if (mode == 1) return VarlenKey(&generator);
+      return std::string(20, 'p') + std::string(generator() % 3, 'q') + VarlenKey(&generator);
+    };
+
+    for (uint32_t i = 0; i < 100000; i++) {
+      const auto key = gen_key();
+      const uint64_t value = (generator() % 4 + 1) * 8;
+      switch (generator() % 3) {
+        case 0: {
+          const bool expected = reference[key].insert(value).second;
+          EXPECT_EQ(tree.Insert(Bytes(key), key.size(), Slot(value), never), expected);
+          break;
+        }
+        case 1: {
+          auto it = reference.find(key);
+          const bool expected = it != reference.end() && it->second.erase(value) == 1;
+          if (it != reference.end() && it->second.empty()) reference.erase(it);
+          EXPECT_EQ(tree.Delete(Bytes(key), key.size(), Slot(value)), expected);
+          break;
+        }
+        default: {
+          std::vector<TupleSlot> values;
+          tree.Lookup(Bytes(key), key.size(), &values);
+          auto it = reference.find(key);
+          EXPECT_EQ(values.size(), it == reference.end() ? 0 : it->second.size());
+          for (const auto slot : values) EXPECT_EQ(it->second.count(Value(slot)), 1);
+        }
+      }
+
+      if (i % 5000 == 0) {
+        auto low = gen_key();
+        auto high = gen_key();
+        if (low > high) std::swap(low, high);
+        // A prefix of a key bounds the scan from above as well
+        if (mode == 0) high.resize(generator() % 9);
+
+        // The values of one key are not ordered, so only compare what the scans return
+        std::multiset<uint64_t> expected;
+        size_t total = 0;
+        for (const auto &[entry_key, values] : reference) {
+          total += values.size();
+          if (entry_key < low || entry_key.compare(0, high.size(), high) > 0) continue;
+          expected.insert(values.begin(), values.end());
+        }
+
+        std::vector<TupleSlot> ascending;
+        tree.ScanAscending(Bytes(low), low.size(), Bytes(high), high.size(), 0, always, &ascending);
+        std::multiset<uint64_t> scanned;
+        for (const auto slot : ascending) scanned.insert(Value(slot));
+        EXPECT_EQ(scanned, expected);
+
+        std::vector<TupleSlot> descending;
+        tree.ScanDescending(Bytes(low), low.size(), Bytes(high), high.size(), 0, always, &descending);
+        scanned.clear();
+        for (const auto slot : descending) scanned.insert(Value(slot));
+        EXPECT_EQ(scanned, expected);
+
+        std::vector<TupleSlot> limited;
+        tree.ScanAscending(nullptr, 0, nullptr, 0, 7, always, &limited);
+        EXPECT_EQ(limited.size(), std::min<size_t>(7, total));
+        EXPECT_EQ(tree.GetSize(), reference.size());
+        tree.ReclaimRetiredNodes();
+      }
+    }
+  }
+}
+
+/**
+ * Checks that the predicate can reject an insert, and that scans skip the values the predicate rejects without
+ * counting them towards the limit.
+ */
+// NOLINTNEXTLINE
+TEST_F(AdaptiveRadixTreeTests, Predicates) {
+  AdaptiveRadixTree tree;
+  const auto never = [](TupleSlot) { return false; };
+  const auto key = FixedKey(42);
+
+  EXPECT_TRUE(tree.Insert(Bytes(key), key.size(), Slot(8), never));
+  EXPECT_FALSE(tree.Insert(Bytes(key), key.size(), Slot(8), never));
+  EXPECT_FALSE(tree.Insert(Bytes(key), key.size(), Slot(16), [](TupleSlot slot) { return Value(slot) == 8; }));
+  EXPECT_TRUE(tree.Insert(Bytes(key), key.size(), Slot(16), never));
+
+  for (uint64_t x = 0; x < 100; x++) {
+    const auto other = FixedKey(1000 + x);
+    EXPECT_TRUE(tree.Insert(Bytes(other), other.size(), Slot((x + 1) * 8), never));
+  }
+  EXPECT_EQ(tree.GetSize(), 101);
+
+  std::vector<TupleSlot> values;
+  tree.ScanDescending(nullptr, 0, nullptr, 0, 5, [](TupleSlot slot) { return Value(slot) % 16 == 0; }, &values);
+  ASSERT_EQ(values.size(), 5);
+  EXPECT_EQ(Value(values[0]), 800);
+  EXPECT_EQ(Value(values[4]), 736);
+
+  EXPECT_TRUE(tree.Delete(Bytes(key), key.size(), Slot(8)));
+  EXPECT_TRUE(tree.Delete(Bytes(key), key.size(), Slot(16)));
+  EXPECT_FALSE(tree.Delete(Bytes(key), key.size(), Slot(16)));
+  EXPECT_EQ(tree.GetSize(), 100);
+}
+
+/**
+ * Writers insert and delete keys while readers look up and scan a set of keys that is never changed. Readers must
+ * always find every stable key exactly once, and in order.
+ */
+// NOLINTNEXTLINE
+TEST_F(AdaptiveRadixTreeTests, ConcurrentReadersAndWriters) {
+  AdaptiveRadixTree tree;
+  const auto never = [](TupleSlot) { return false; };
+  const uint64_t num_stable_keys = 10000;
+
+  // Multiples of 4 are stable, writers only touch the keys in between
+  for (uint64_t i = 0; i < num_stable_keys; i++) {
+    const auto key = FixedKey(i * 4);
+    tree.Insert(Bytes(key), key.size(), Slot((i * 4 + 1) * 8), never);
+  }
+
+  std::atomic<uint32_t> writers_done = 0;
+  auto workload = [&](uint32_t worker_id) {
+    std::default_random_engine generator(worker_id);
+    if (worker_id % 2 == 0) {
+      for (uint32_t i = 0; i < 100000; i++) {
+        const uint64_t x = (generator() % num_stable_keys) * 4 + 1 + generator() % 3;
+        const auto key = FixedKey(x);
+        if (generator() % 2 == 0) {
+          tree.Insert(Bytes(key), key.size(), Slot((x + 1) * 8), never);
+        } else {
+          tree.Delete(Bytes(key), key.size(), Slot((x + 1) * 8));
+        }
+        if (i % 1000 == 0) tree.ReclaimRetiredNodes();
+      }
+      writers_done++;
+      return;
+    }
+
+    const auto stable = [](TupleSlot slot) { return (Value(slot) / 8 - 1) % 4 == 0; };
+    while (writers_done.load() < num_threads_ / 2) {
+      const uint64_t x = (generator() % num_stable_keys) * 4;
+      const auto key = FixedKey(x);
+      std::vector<TupleSlot> values;
+      tree.Lookup(Bytes(key), key.size(), &values);
+      ASSERT_EQ(values.size(), 1);
+      EXPECT_EQ(Value(values[0]), (x + 1) * 8);
+
+      if (generator() % 50 == 0) {
+        std::vector<TupleSlot> scanned;
+        tree.ScanAscending(nullptr, 0, nullptr, 0, 0, stable, &scanned);
+        ASSERT_EQ(scanned.size(), num_stable_keys);
+        for (uint32_t i = 1; i < scanned.size(); i++) EXPECT_LT(Value(scanned[i - 1]), Value(scanned[i]));
+      }
+    }
+  };
+
+  for (uint32_t i = 0; i < num_threads_; i++) {
+    thread_pool_.SubmitTask([i, &workload] { workload(i); });
+  }
+  thread_pool_.WaitUntilAllFinished();
+
+  std::vector<TupleSlot> scanned;
+  tree.ScanAscending(nullptr, 0, nullptr, 0, 0, [](TupleSlot) { return true; }, &scanned);
+  EXPECT_EQ(scanned.size(), tree.GetSize());
+}
+
+}  // namespace noisepage::storage::index
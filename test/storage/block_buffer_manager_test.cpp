@@ -0,0 +1,254 @@
+#include "storage/block_buffer_manager.h"
+
+#include <memory>
+#include <vector>
+
+#include "execution/sql/vector_projection.h"
+#include "parser/expression/column_value_expression.h"
+#include "storage/block_access_controller.h"
+#include "storage/block_compactor.h"
+#include "storage/garbage_collector.h"
+#include "storage/index/index.h"
+#include "storage/index/index_builder.h"
+#include "storage/storage_defs.h"
+#include "test_util/catalog_test_util.h"
+#include "test_util/storage_test_util.h"
+#include "test_util/test_harness.h"
+#include "transaction/deferred_action_manager.h"
+
+#define BLOCK_FILE_NAME "./test_block_buffer_manager.blocks"
+
+namespace noisepage {
+
+struct BlockBufferManagerTest : public ::noisepage::TerrierTest {
+  storage::BlockStore block_store_{100, 100};
+  storage::RecordBufferSegmentPool buffer_pool_{100000, 100000};
+  transaction::TimestampManager timestamp_manager_;
+  transaction::DeferredActionManager deferred_action_manager_{common::ManagedPointer(&timestamp_manager_)};
+  transaction::TransactionManager txn_manager_{common::ManagedPointer(&timestamp_manager_),
+                                               common::ManagedPointer(&deferred_action_manager_),
+                                               common::ManagedPointer(&buffer_pool_),
+                                               true,
+                                               false,
+                                               DISABLED};
+  storage::GarbageCollector gc_{common::ManagedPointer(&timestamp_manager_),
+                                common::ManagedPointer(&deferred_action_manager_),
+                                common::ManagedPointer(&txn_manager_), DISABLED};
+  storage::BlockLayout layout_{{8, 8, 8}};
+
+  // Fills num_blocks blocks of the table with tuples whose columns hold their index, and freezes them
+  std::vector<storage::RawBlock *> FillAndFreeze(storage::DataTable *table, const uint32_t num_blocks) {
+    auto initializer =
+        storage::ProjectedRowInitializer::Create(layout_, StorageTestUtil::ProjectionListAllColumns(layout_));
+    byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+    auto *row = initializer.InitializeRow(buffer);
+    transaction::TransactionContext *txn = txn_manager_.BeginTransaction();
+    std::vector<storage::RawBlock *> blocks;
+    for (uint32_t i = 0; i < num_blocks * layout_.NumSlots(); i++) {
+      for (uint16_t j = 0; j < row->NumColumns(); j++) *reinterpret_cast<int64_t *>(row->AccessForceNotNull(j)) = i;
+      const storage::TupleSlot slot = table->Insert(common::ManagedPointer(txn), *row);
+      if (slot.GetOffset() == 0) blocks.push_back(slot.GetBlock());
+    }
+    txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    delete[] buffer;
+
+    storage::BlockCompactor compactor;
+    for (storage::RawBlock *block : blocks) compactor.PutInQueue(block);
+    compactor.ProcessCompactionQueue(&deferred_action_manager_, &txn_manager_);  // compaction pass
+    // Need to prune the version chain in order to make sure that the second pass succeeds
+    gc_.PerformGarbageCollection();
+    gc_.PerformGarbageCollection();
+    for (storage::RawBlock *block : blocks) compactor.PutInQueue(block);
+    compactor.ProcessCompactionQueue(&deferred_action_manager_, &txn_manager_);  // gathering pass
+    for (storage::RawBlock *block : blocks)
+      EXPECT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::FROZEN);
+    return blocks;
+  }
+
+  // Reads every tuple of the table and checks that its columns hold its index
+  void VerifyTable(const storage::DataTable &table) {
+    auto initializer =
+        storage::ProjectedRowInitializer::Create(layout_, StorageTestUtil::ProjectionListAllColumns(layout_));
+    byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+    auto *row = initializer.InitializeRow(buffer);
+    transaction::TransactionContext *txn = txn_manager_.BeginTransaction();
+    uint32_t num_read = 0;
+    for (auto it = table.begin(); it != table.end(); it++) {
+      if (!table.Select(common::ManagedPointer(txn), *it, row)) continue;
+      for (uint16_t j = 0; j < row->NumColumns(); j++)
+        EXPECT_EQ(*reinterpret_cast<int64_t *>(row->AccessForceNotNull(j)), static_cast<int64_t>(num_read));
+      num_read++;
+    }
+    txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    delete[] buffer;
+    EXPECT_EQ(num_read, table.GetNumBlocks() * layout_.NumSlots());
+  }
+};
+
+// Frozen blocks are evicted once no transaction can be reading them, and faulted back in when they are read
+// NOLINTNEXTLINE
+TEST_F(BlockBufferManagerTest, EvictAndFault) {
+  const uint32_t num_blocks = 4;
+  // The budget leaves room for one block
+  storage::BlockBufferManager buffer_manager(BLOCK_FILE_NAME, common::Constants::BLOCK_SIZE,
+                                             common::ManagedPointer(&deferred_action_manager_));
+  // The table unregisters itself from the buffer manager when it is destroyed
+  storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout_,
+                           storage::layout_version_t(0));
+  std::vector<storage::RawBlock *> blocks = FillAndFreeze(&table, num_blocks);
+  ASSERT_EQ(table.GetNumBlocks(), num_blocks);
+
+  buffer_manager.RegisterTable(&table);
+  // A transaction that is running when the blocks are marked holds up their eviction
+  transaction::TransactionContext *txn = txn_manager_.BeginTransaction();
+  EXPECT_EQ(buffer_manager.EvictColdBlocks(), num_blocks - 1);
+  EXPECT_EQ(buffer_manager.EvictColdBlocks(), 0);
+  gc_.PerformGarbageCollection();
+  gc_.PerformGarbageCollection();
+  EXPECT_EQ(buffer_manager.NumEvictedBlocks(), 0);
+  txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  gc_.PerformGarbageCollection();
+  gc_.PerformGarbageCollection();
+  EXPECT_EQ(buffer_manager.NumEvictedBlocks(), num_blocks - 1);
+  uint32_t num_evicted = 0;
+  for (storage::RawBlock *block : blocks)
+    if (block->controller_.GetBlockState()->load() == storage::BlockState::EVICTED) num_evicted++;
+  EXPECT_EQ(num_evicted, num_blocks - 1);
+
+  // Reading the table faults every block back in
+  VerifyTable(table);
+  EXPECT_EQ(buffer_manager.NumEvictedBlocks(), 0);
+  for (storage::RawBlock *block : blocks)
+    EXPECT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::FROZEN);
+
+  // All blocks were just read, so the first turn of the clock hand only clears their reference bits
+  EXPECT_EQ(buffer_manager.EvictColdBlocks(), num_blocks - 1);
+  gc_.PerformGarbageCollection();
+  gc_.PerformGarbageCollection();
+  EXPECT_EQ(buffer_manager.NumEvictedBlocks(), num_blocks - 1);
+
+  // An in-place scan faults a block in too
+  execution::sql::VectorProjection projection;
+  const std::vector<storage::col_id_t> all_cols = StorageTestUtil::ProjectionListAllColumns(layout_);
+  projection.SetStorageColIds(all_cols);
+  projection.Initialize(std::vector<execution::sql::TypeId>(all_cols.size(), execution::sql::TypeId::BigInt));
+  txn = txn_manager_.BeginTransaction(true);
+  auto it = table.begin();
+  storage::RawBlock *const first = it->GetBlock();
+  ASSERT_EQ(table.ScanInPlace(common::ManagedPointer(txn), &it, &projection), first);
+  EXPECT_EQ(reinterpret_cast<int64_t *>(projection.GetColumn(0)->GetData())[0], 0);
+  storage::DataTable::ReleaseInPlaceRead(first);
+  txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  EXPECT_EQ(first->controller_.GetBlockState()->load(), storage::BlockState::FROZEN);
+
+  VerifyTable(table);
+  gc_.PerformGarbageCollection();
+  gc_.PerformGarbageCollection();  // Second call to deallocate.
+}
+
+// An access to a block marked for eviction cancels the eviction, and writes make an evicted block hot again
+// NOLINTNEXTLINE
+TEST_F(BlockBufferManagerTest, CancelAndWrite) {
+  const uint32_t num_blocks = 2;
+  storage::BlockBufferManager buffer_manager(BLOCK_FILE_NAME, 0, common::ManagedPointer(&deferred_action_manager_));
+  // The table unregisters itself from the buffer manager when it is destroyed
+  storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout_,
+                           storage::layout_version_t(0));
+  std::vector<storage::RawBlock *> blocks = FillAndFreeze(&table, num_blocks);
+
+  buffer_manager.RegisterTable(&table);
+  EXPECT_EQ(buffer_manager.EvictColdBlocks(), num_blocks);
+  for (storage::RawBlock *block : blocks)
+    EXPECT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::EVICTING);
+
+  // Reading a tuple of the first block keeps it in memory
+  auto initializer =
+      storage::ProjectedRowInitializer::Create(layout_, StorageTestUtil::ProjectionListAllColumns(layout_));
+  byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  auto *row = initializer.InitializeRow(buffer);
+  transaction::TransactionContext *txn = txn_manager_.BeginTransaction();
+  EXPECT_TRUE(table.Select(common::ManagedPointer(txn), {blocks[0], 0}, row));
+  txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  gc_.PerformGarbageCollection();
+  gc_.PerformGarbageCollection();
+  EXPECT_EQ(blocks[0]->controller_.GetBlockState()->load(), storage::BlockState::FROZEN);
+  EXPECT_EQ(blocks[1]->controller_.GetBlockState()->load(), storage::BlockState::EVICTED);
+  EXPECT_EQ(buffer_manager.NumEvictedBlocks(), 1);
+
+  // Updating a tuple of the evicted block faults it in and thaws it
+  const storage::TupleSlot updated(blocks[1], 1);
+  auto update_initializer = storage::ProjectedRowInitializer::Create(layout_, {storage::col_id_t(1)});
+  byte *update_buffer = common::AllocationUtil::AllocateAligned(update_initializer.ProjectedRowSize());
+  auto *update = update_initializer.InitializeRow(update_buffer);
+  *reinterpret_cast<int64_t *>(update->AccessForceNotNull(0)) = -1;
+  txn = txn_manager_.BeginTransaction();
+  EXPECT_TRUE(table.Update(common::ManagedPointer(txn), updated, *update));
+  txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  delete[] update_buffer;
+  EXPECT_EQ(blocks[1]->controller_.GetBlockState()->load(), storage::BlockState::HOT);
+  EXPECT_EQ(buffer_manager.NumEvictedBlocks(), 0);
+
+  // The rest of the block came back as it was
+  txn = txn_manager_.BeginTransaction();
+  for (uint32_t i = 0; i < layout_.NumSlots(); i++) {
+    EXPECT_TRUE(table.Select(common::ManagedPointer(txn), {blocks[1], i}, row));
+    const int64_t expected = layout_.NumSlots() + i;
+    for (uint16_t j = 0; j < row->NumColumns(); j++) {
+      const int64_t value = *reinterpret_cast<int64_t *>(row->AccessForceNotNull(j));
+      EXPECT_EQ(value, row->ColumnIds()[j] == storage::col_id_t(1) && i == 1 ? -1 : expected);
+    }
+  }
+  txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  delete[] buffer;
+
+  gc_.PerformGarbageCollection();
+  gc_.PerformGarbageCollection();  // Second call to deallocate.
+}
+
+// Index lookups check the visibility of tuples in evicted blocks, which faults them back in
+// NOLINTNEXTLINE
+TEST_F(BlockBufferManagerTest, IndexLookupFaults) {
+  const uint32_t num_blocks = 2;
+  storage::BlockBufferManager buffer_manager(BLOCK_FILE_NAME, 0, common::ManagedPointer(&deferred_action_manager_));
+  // The table unregisters itself from the buffer manager when it is destroyed
+  storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout_,
+                           storage::layout_version_t(0));
+  std::vector<storage::RawBlock *> blocks = FillAndFreeze(&table, num_blocks);
+
+  std::vector<catalog::IndexSchema::Column> keycols;
+  keycols.emplace_back("", type::TypeId::BIGINT, false,
+                       parser::ColumnValueExpression(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID,
+                                                     catalog::col_oid_t(1)));
+  StorageTestUtil::ForceOid(&(keycols[0]), catalog::indexkeycol_oid_t(1));
+  const catalog::IndexSchema index_schema(keycols, storage::index::IndexType::BPLUSTREE, true, true, false, true);
+  std::unique_ptr<storage::index::Index> index(storage::index::IndexBuilder().SetKeySchema(index_schema).Build());
+  byte *const key_buffer =
+      common::AllocationUtil::AllocateAligned(index->GetProjectedRowInitializer().ProjectedRowSize());
+  auto *const key = index->GetProjectedRowInitializer().InitializeRow(key_buffer);
+  const storage::TupleSlot slot(blocks[1], 0);
+  *reinterpret_cast<int64_t *>(key->AccessForceNotNull(0)) = layout_.NumSlots();
+  transaction::TransactionContext *txn = txn_manager_.BeginTransaction();
+  EXPECT_TRUE(index->InsertUnique(common::ManagedPointer(txn), *key, slot));
+  txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  buffer_manager.RegisterTable(&table);
+  EXPECT_EQ(buffer_manager.EvictColdBlocks(), num_blocks);
+  gc_.PerformGarbageCollection();
+  gc_.PerformGarbageCollection();
+  ASSERT_EQ(blocks[1]->controller_.GetBlockState()->load(), storage::BlockState::EVICTED);
+
+  // The tuple is found, and its key cannot be inserted again
+  txn = txn_manager_.BeginTransaction();
+  std::vector<storage::TupleSlot> results;
+  index->ScanKey(*txn, *key, &results);
+  EXPECT_EQ(results, std::vector<storage::TupleSlot>{slot});
+  EXPECT_EQ(blocks[1]->controller_.GetBlockState()->load(), storage::BlockState::FROZEN);
+  EXPECT_FALSE(index->InsertUnique(common::ManagedPointer(txn), *key, storage::TupleSlot(blocks[0], 0)));
+  txn_manager_.Abort(txn);
+  delete[] key_buffer;
+
+  gc_.PerformGarbageCollection();
+  gc_.PerformGarbageCollection();  // Second call to deallocate.
+}
+
+}  // namespace noisepage
@@ -1,9 +1,11 @@
 #include "storage/block_compactor.h"
 
+#include <limits>
 #include <unordered_map>
 #include <vector>
 
 #include "common/hash_util.h"
+#include "execution/sql/vector_projection.h"
 #include "storage/block_access_controller.h"
 #include "storage/garbage_collector.h"
 #include "storage/storage_defs.h"
@@ -166,6 +168,8 @@ TEST_F(BlockCompactorTest, GatherTest) {
   uint32_t repeat = 10;
   for (uint32_t iteration = 0; iteration < repeat; iteration++) {
     storage::BlockLayout layout = StorageTestUtil::RandomLayoutWithVarlens(100, &generator_);
+    // Every other block stores some of its columns row-wise, in column groups
+    if (iteration % 2 == 1) layout = StorageTestUtil::RandomlyGroupedLayout(layout, &generator_);
     storage::TupleAccessStrategy accessor(layout);
     // Technically, the block above is not "in" the table, but since we don't sequential scan that does not matter
     storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
@@ -276,6 +280,8 @@ TEST_F(BlockCompactorTest, DictionaryCompressionTest) {
   uint32_t repeat = 10;
   for (uint32_t iteration = 0; iteration < repeat; iteration++) {
     storage::BlockLayout layout = StorageTestUtil::RandomLayoutWithVarlens(100, &generator_);
+    // Every other block stores some of its columns row-wise, in column groups
+    if (iteration % 2 == 1) layout = StorageTestUtil::RandomlyGroupedLayout(layout, &generator_);
     storage::TupleAccessStrategy accessor(layout);
     // Technically, the block above is not "in" the table, but since we don't sequential scan that does not matter
     storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
@@ -363,6 +369,9 @@ TEST_F(BlockCompactorTest, DictionaryCompressionTest) {
         if (varlen == nullptr) continue;
         auto size UNUSED_ATTRIBUTE = varlen->Size();
         auto dict_code = arrow_metadata.GetColumnInfo(layout, id).Indices()[i];
+        // The decoded dictionary holds the same word
+        EXPECT_TRUE(storage::VarlenContentDeepEqual()(
+            *varlen, arrow_metadata.GetColumnInfo(layout, id).Dictionary()[dict_code]));
         // Safe to do plus 1, because length array will always have one more element
         EXPECT_EQ(arrow_column.Offsets()[dict_code + 1] - arrow_column.Offsets()[dict_code], varlen->Size());
         if (!varlen->IsInlined()) {
@@ -394,4 +403,391 @@ TEST_F(BlockCompactorTest, DictionaryCompressionTest) {
   }
 }
 
+// This test freezes a block of a table and reads it in place. It then verifies that the vectors point into the block,
+// and that only read-only transactions read frozen blocks in place.
+// NOLINTNEXTLINE
+TEST_F(BlockCompactorTest, ScanInPlaceTest) {
+  storage::BlockLayout layout({8, 8, 8});
+  // The compactor only freezes full blocks
+  const uint32_t num_tuples = layout.NumSlots();
+  storage::TupleAccessStrategy accessor(layout);
+  storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                           storage::layout_version_t(0));
+  transaction::TimestampManager timestamp_manager;
+  transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+  transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                              common::ManagedPointer(&deferred_action_manager),
+                                              common::ManagedPointer(&buffer_pool_),
+                                              true,
+                                              false,
+                                              DISABLED};
+  storage::GarbageCollector gc{common::ManagedPointer(&timestamp_manager),
+                               common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&txn_manager),
+                               DISABLED};
+
+  // Every column has some nulls. The values are spread over the whole range of the type, so that the columns are not
+  // encoded and the vectors point into the block.
+  const auto value_of = [](const uint32_t i) { return static_cast<int64_t>(i * 0x9E3779B97F4A7C15ULL); };
+  std::vector<storage::col_id_t> all_cols = StorageTestUtil::ProjectionListAllColumns(layout);
+  auto initializer = storage::ProjectedRowInitializer::Create(layout, all_cols);
+  byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  auto *row = initializer.InitializeRow(buffer);
+  transaction::TransactionContext *txn = txn_manager.BeginTransaction();
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    for (uint16_t j = 0; j < row->NumColumns(); j++) {
+      if (i % 3 == j) {
+        row->SetNull(j);
+      } else {
+        *reinterpret_cast<int64_t *>(row->AccessForceNotNull(j)) = value_of(i);
+      }
+    }
+    table.Insert(common::ManagedPointer(txn), *row);
+  }
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  delete[] buffer;
+
+  storage::RawBlock *block = table.begin()->GetBlock();
+  storage::BlockCompactor compactor;
+  compactor.PutInQueue(block);
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // compaction pass
+  // Need to prune the version chain in order to make sure that the second pass succeeds
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();
+  compactor.PutInQueue(block);
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // gathering pass
+  ASSERT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::FROZEN);
+
+  execution::sql::VectorProjection projection;
+  projection.SetStorageColIds(all_cols);
+  projection.Initialize(std::vector<execution::sql::TypeId>(all_cols.size(), execution::sql::TypeId::BigInt));
+
+  // A transaction that may write does not read in place
+  txn = txn_manager.BeginTransaction();
+  auto it = table.begin();
+  EXPECT_EQ(table.ScanInPlace(common::ManagedPointer(txn), &it, &projection), nullptr);
+  EXPECT_EQ(it, table.begin());
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // A read-only transaction reads the block a vector at a time
+  txn = txn_manager.BeginTransaction(true);
+  uint32_t num_read = 0;
+  while (it != table.end()) {
+    ASSERT_EQ(table.ScanInPlace(common::ManagedPointer(txn), &it, &projection), block);
+    const auto count = static_cast<uint32_t>(projection.GetSelectedTupleCount());
+    for (uint16_t j = 0; j < all_cols.size(); j++) {
+      const execution::sql::Vector *column = projection.GetColumn(j);
+      EXPECT_EQ(column->GetData(), accessor.ColumnStart(block, all_cols[j]) + num_read * sizeof(int64_t));
+      for (uint32_t i = 0; i < count; i++) {
+        EXPECT_EQ(column->IsNull(i), (num_read + i) % 3 == j);
+        if (!column->IsNull(i)) {
+          EXPECT_EQ(reinterpret_cast<int64_t *>(column->GetData())[i], value_of(num_read + i));
+        }
+      }
+    }
+    for (uint32_t i = 0; i < count; i++) EXPECT_EQ(projection.GetTupleSlot(i), storage::TupleSlot(block, num_read + i));
+    storage::DataTable::ReleaseInPlaceRead(block);
+    num_read += count;
+  }
+  EXPECT_EQ(num_read, num_tuples);
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();  // Second call to deallocate.
+}
+
+// This test freezes a block whose columns are a constant, a small range and a few long runs. It then verifies that
+// every column is encoded, and that reading the block in place decodes the values.
+// NOLINTNEXTLINE
+TEST_F(BlockCompactorTest, EncodedScanInPlaceTest) {
+  storage::BlockLayout layout({8, 8, 4, 2});
+  const storage::col_id_t constant_col(1), range_col(2), run_col(3);
+  const uint32_t num_tuples = layout.NumSlots();
+  storage::TupleAccessStrategy accessor(layout);
+  storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                           storage::layout_version_t(0));
+  transaction::TimestampManager timestamp_manager;
+  transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+  transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                              common::ManagedPointer(&deferred_action_manager),
+                                              common::ManagedPointer(&buffer_pool_),
+                                              true,
+                                              false,
+                                              DISABLED};
+  storage::GarbageCollector gc{common::ManagedPointer(&timestamp_manager),
+                               common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&txn_manager),
+                               DISABLED};
+
+  const auto is_null = [](const uint32_t i) { return i % 7 == 3; };
+  const int64_t constant = int64_t{1} << 40;
+  const auto range_value = [](const uint32_t i) { return static_cast<int32_t>(i % 1000) - 1000000; };
+  const auto run_value = [](const uint32_t i) { return static_cast<int16_t>(i / 300); };
+  std::vector<storage::col_id_t> all_cols = StorageTestUtil::ProjectionListAllColumns(layout);
+  auto initializer = storage::ProjectedRowInitializer::Create(layout, all_cols);
+  byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  auto *row = initializer.InitializeRow(buffer);
+  transaction::TransactionContext *txn = txn_manager.BeginTransaction();
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    for (uint16_t j = 0; j < row->NumColumns(); j++) {
+      const storage::col_id_t col_id = row->ColumnIds()[j];
+      if (col_id == constant_col) {
+        *reinterpret_cast<int64_t *>(row->AccessForceNotNull(j)) = constant;
+      } else if (col_id == range_col) {
+        *reinterpret_cast<int32_t *>(row->AccessForceNotNull(j)) = range_value(i);
+      } else {
+        *reinterpret_cast<int16_t *>(row->AccessForceNotNull(j)) = run_value(i);
+      }
+      // Nulls in the middle of a run do not break it up
+      if (is_null(i)) row->SetNull(j);
+    }
+    table.Insert(common::ManagedPointer(txn), *row);
+  }
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  delete[] buffer;
+
+  storage::RawBlock *block = table.begin()->GetBlock();
+  storage::BlockCompactor compactor;
+  compactor.PutInQueue(block);
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // compaction pass
+  // Need to prune the version chain in order to make sure that the second pass succeeds
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();
+  compactor.PutInQueue(block);
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // gathering pass
+  ASSERT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::FROZEN);
+
+  storage::ArrowBlockMetadata &metadata = accessor.GetArrowBlockMetadata(block);
+  const storage::EncodedColumn &constant_encoded = metadata.GetColumnInfo(layout, constant_col).Encoded();
+  EXPECT_EQ(constant_encoded.Encoding(), storage::ColumnEncoding::FRAME_OF_REFERENCE);
+  EXPECT_EQ(constant_encoded.BitWidth(), 0);
+  EXPECT_EQ(constant_encoded.EncodedSize(), 0);
+  const storage::EncodedColumn &range_encoded = metadata.GetColumnInfo(layout, range_col).Encoded();
+  EXPECT_EQ(range_encoded.Encoding(), storage::ColumnEncoding::FRAME_OF_REFERENCE);
+  EXPECT_EQ(range_encoded.BitWidth(), 10);
+  EXPECT_LT(range_encoded.EncodedSize(), num_tuples * sizeof(int32_t));
+  const storage::EncodedColumn &run_encoded = metadata.GetColumnInfo(layout, run_col).Encoded();
+  EXPECT_EQ(run_encoded.Encoding(), storage::ColumnEncoding::RUN_LENGTH);
+  EXPECT_EQ(run_encoded.NumRuns(), (num_tuples + 299) / 300);
+
+  execution::sql::VectorProjection projection;
+  projection.SetStorageColIds(all_cols);
+  projection.Initialize({execution::sql::TypeId::BigInt, execution::sql::TypeId::Integer,
+                         execution::sql::TypeId::SmallInt});
+
+  txn = txn_manager.BeginTransaction(true);
+  auto it = table.begin();
+  uint32_t num_read = 0;
+  while (it != table.end()) {
+    ASSERT_EQ(table.ScanInPlace(common::ManagedPointer(txn), &it, &projection), block);
+    const auto count = static_cast<uint32_t>(projection.GetSelectedTupleCount());
+    for (uint16_t j = 0; j < all_cols.size(); j++) {
+      const execution::sql::Vector *column = projection.GetColumn(j);
+      // The values are decoded into the projection instead of being read from the block
+      EXPECT_NE(column->GetData(), accessor.ColumnStart(block, all_cols[j]) + num_read * layout.AttrSize(all_cols[j]));
+      for (uint32_t i = 0; i < count; i++) {
+        EXPECT_EQ(column->IsNull(i), is_null(num_read + i));
+        if (column->IsNull(i)) continue;
+        if (all_cols[j] == constant_col) {
+          EXPECT_EQ(reinterpret_cast<int64_t *>(column->GetData())[i], constant);
+        } else if (all_cols[j] == range_col) {
+          EXPECT_EQ(reinterpret_cast<int32_t *>(column->GetData())[i], range_value(num_read + i));
+        } else {
+          EXPECT_EQ(reinterpret_cast<int16_t *>(column->GetData())[i], run_value(num_read + i));
+        }
+      }
+    }
+    storage::DataTable::ReleaseInPlaceRead(block);
+    num_read += count;
+  }
+  EXPECT_EQ(num_read, num_tuples);
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();  // Second call to deallocate.
+}
+
+// Zone maps widen as a block is written to, and are tightened to the values that are left when it is frozen
+// NOLINTNEXTLINE
+TEST_F(BlockCompactorTest, ZoneMapTest) {
+  storage::BlockLayout layout({8, 8, 4});
+  const storage::col_id_t big_col(1), small_col(2);
+  const uint32_t num_tuples = layout.NumSlots();
+  storage::TupleAccessStrategy accessor(layout);
+  storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                           storage::layout_version_t(0));
+  transaction::TimestampManager timestamp_manager;
+  transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+  transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                              common::ManagedPointer(&deferred_action_manager),
+                                              common::ManagedPointer(&buffer_pool_),
+                                              true,
+                                              false,
+                                              DISABLED};
+  storage::GarbageCollector gc{common::ManagedPointer(&timestamp_manager),
+                               common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&txn_manager),
+                               DISABLED};
+
+  std::vector<storage::col_id_t> all_cols = StorageTestUtil::ProjectionListAllColumns(layout);
+  auto initializer = storage::ProjectedRowInitializer::Create(layout, all_cols);
+  byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  auto *row = initializer.InitializeRow(buffer);
+  transaction::TransactionContext *txn = txn_manager.BeginTransaction();
+  std::vector<storage::TupleSlot> slots;
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    for (uint16_t j = 0; j < row->NumColumns(); j++) {
+      if (row->ColumnIds()[j] == big_col) {
+        *reinterpret_cast<int64_t *>(row->AccessForceNotNull(j)) = i + 10;
+      } else {
+        *reinterpret_cast<int32_t *>(row->AccessForceNotNull(j)) = -static_cast<int32_t>(i);
+      }
+    }
+    slots.push_back(table.Insert(common::ManagedPointer(txn), *row));
+  }
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  delete[] buffer;
+
+  storage::RawBlock *block = slots[0].GetBlock();
+  const auto &big_zone = accessor.GetArrowBlockMetadata(block).GetColumnZone(layout, big_col);
+  const auto &small_zone = accessor.GetArrowBlockMetadata(block).GetColumnZone(layout, small_col);
+  EXPECT_EQ(big_zone.min_.load(), 10);
+  EXPECT_EQ(big_zone.max_.load(), num_tuples + 9);
+  EXPECT_EQ(small_zone.min_.load(), -static_cast<int64_t>(num_tuples - 1));
+  EXPECT_EQ(small_zone.max_.load(), 0);
+
+  // The update widens the zone map, and it stays wide after the tuple is deleted
+  auto update_initializer = storage::ProjectedRowInitializer::Create(layout, {big_col});
+  buffer = common::AllocationUtil::AllocateAligned(update_initializer.ProjectedRowSize());
+  row = update_initializer.InitializeRow(buffer);
+  *reinterpret_cast<int64_t *>(row->AccessForceNotNull(0)) = 1000000;
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(table.Update(common::ManagedPointer(txn), slots[0], *row));
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  delete[] buffer;
+  EXPECT_EQ(big_zone.max_.load(), 1000000);
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(table.Delete(common::ManagedPointer(txn), slots[0]));
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  // Reclaim the slot of the deleted tuple, which leaves a gap for the compactor to fill
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();
+  EXPECT_TRUE(table.BlockMayContain(block, big_col, 1000000, 1000000));
+  EXPECT_TRUE(table.BlockMayContain(block, small_col, 0, 5));
+
+  storage::BlockCompactor compactor;
+  compactor.PutInQueue(block);
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // compaction pass
+  // Need to prune the version chain in order to make sure that the second pass succeeds
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();
+  compactor.PutInQueue(block);
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // gathering pass
+  ASSERT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::FROZEN);
+
+  // Only the deleted tuple held the values at the ends of the ranges
+  EXPECT_EQ(big_zone.min_.load(), 11);
+  EXPECT_EQ(big_zone.max_.load(), num_tuples + 9);
+  EXPECT_EQ(small_zone.min_.load(), -static_cast<int64_t>(num_tuples - 1));
+  EXPECT_EQ(small_zone.max_.load(), -1);
+  EXPECT_FALSE(table.BlockMayContain(block, big_col, 1000000, 1000000));
+  EXPECT_FALSE(table.BlockMayContain(block, big_col, std::numeric_limits<int64_t>::min(), 10));
+  EXPECT_TRUE(table.BlockMayContain(block, big_col, 11, 11));
+  EXPECT_FALSE(table.BlockMayContain(block, small_col, 0, 5));
+  EXPECT_TRUE(table.BlockMayContain(block, small_col, -5, 0));
+
+  // A scan that rules out the block skips all of its slots
+  auto it = table.begin();
+  table.SkipBlock(&it);
+  EXPECT_EQ(it, table.end());
+
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();  // Second call to deallocate.
+}
+
+// This test compacts several blocks on a pool of compaction workers. It then verifies that blocks whose versions are
+// not pruned yet are resumed in a later pass, and that no tuple is lost.
+// NOLINTNEXTLINE
+TEST_F(BlockCompactorTest, ParallelCompactionTest) {
+  storage::BlockLayout layout({8, 8, 8});
+  const uint32_t num_blocks = 8;
+  storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                           storage::layout_version_t(0));
+  transaction::TimestampManager timestamp_manager;
+  transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+  transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                              common::ManagedPointer(&deferred_action_manager),
+                                              common::ManagedPointer(&buffer_pool_),
+                                              true,
+                                              false,
+                                              DISABLED};
+  storage::GarbageCollector gc{common::ManagedPointer(&timestamp_manager),
+                               common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&txn_manager),
+                               DISABLED};
+
+  std::vector<storage::col_id_t> all_cols = StorageTestUtil::ProjectionListAllColumns(layout);
+  auto initializer = storage::ProjectedRowInitializer::Create(layout, all_cols);
+  byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  auto *row = initializer.InitializeRow(buffer);
+  transaction::TransactionContext *txn = txn_manager.BeginTransaction();
+  std::vector<storage::TupleSlot> slots;
+  for (uint32_t i = 0; i < num_blocks * layout.NumSlots(); i++) {
+    for (uint16_t j = 0; j < row->NumColumns(); j++) *reinterpret_cast<int64_t *>(row->AccessForceNotNull(j)) = i;
+    slots.push_back(table.Insert(common::ManagedPointer(txn), *row));
+  }
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // Leave a gap at the start of every block, so that every compaction group moves a tuple
+  std::vector<storage::RawBlock *> blocks;
+  uint64_t expected_sum = 0;
+  txn = txn_manager.BeginTransaction();
+  for (uint32_t i = 0; i < slots.size(); i++) {
+    if (slots[i].GetOffset() == 0) {
+      blocks.push_back(slots[i].GetBlock());
+      EXPECT_TRUE(table.Delete(common::ManagedPointer(txn), slots[i]));
+    } else {
+      expected_sum += i;
+    }
+  }
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  EXPECT_EQ(blocks.size(), num_blocks);
+  // Reclaim the slots of the deleted tuples
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();
+
+  storage::BlockCompactor compactor(4);
+  EXPECT_EQ(compactor.NumWorkers(), 4);
+  for (storage::RawBlock *block : blocks) compactor.PutInQueue(block);
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // compaction pass
+  for (storage::RawBlock *block : blocks)
+    EXPECT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::COOLING);
+
+  // The versions of the compaction transactions are still alive, so the blocks are parked instead of gathered
+  for (storage::RawBlock *block : blocks) compactor.PutInQueue(block);
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);
+  for (storage::RawBlock *block : blocks)
+    EXPECT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::COOLING);
+
+  // Once the version chains are pruned, the parked blocks are resumed without being queued again
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();
+  compactor.ProcessCompactionQueue(&deferred_action_manager, &txn_manager);  // gathering pass
+  for (storage::RawBlock *block : blocks)
+    EXPECT_EQ(block->controller_.GetBlockState()->load(), storage::BlockState::FROZEN);
+
+  txn = txn_manager.BeginTransaction();
+  uint32_t num_read = 0;
+  uint64_t sum = 0;
+  for (auto it = table.begin(); it != table.end(); it++) {
+    // The slots at the end of every block are left empty
+    if (!table.Select(common::ManagedPointer(txn), *it, row)) continue;
+    sum += *reinterpret_cast<int64_t *>(row->AccessForceNotNull(0));
+    num_read++;
+  }
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  delete[] buffer;
+  EXPECT_EQ(num_read, num_blocks * (layout.NumSlots() - 1));
+  EXPECT_EQ(sum, expected_sum);
+
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();  // Second call to deallocate.
+}
+
 }  // namespace noisepage
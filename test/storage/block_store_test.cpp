@@ -0,0 +1,89 @@
+#include "storage/block_store.h"
+
+#include <unordered_set>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "storage/storage_defs.h"
+
+namespace noisepage::storage {
+
+// Released blocks are handed out again, and the size limit holds across all nodes
+// NOLINTNEXTLINE
+TEST(BlockStoreTests, ReuseAndLimits) {
+  const uint64_t size_limit = 4;
+  BlockStore tested(size_limit, size_limit);
+  std::unordered_set<RawBlock *> used_blocks;
+  for (uint64_t i = 0; i < size_limit; i++) used_blocks.insert(tested.Get());
+  EXPECT_EQ(used_blocks.size(), size_limit);
+  EXPECT_THROW(tested.Get(), common::NoMoreObjectException);
+  EXPECT_FALSE(tested.SetSizeLimit(size_limit - 1));
+
+  for (auto *const block : used_blocks) tested.Release(block);
+  tested.SetReuseLimit(size_limit / 2);
+  EXPECT_TRUE(tested.SetSizeLimit(size_limit / 2));
+
+  // Only the blocks that were kept for reuse can be handed out, no matter which node asks for them
+  std::vector<RawBlock *> blocks;
+  for (uint64_t i = 0; i < size_limit / 2; i++) {
+    RawBlock *const block = tested.Get(static_cast<uint16_t>(i % BlockStore::NumNodes()));
+    EXPECT_NE(used_blocks.find(block), used_blocks.end());
+    blocks.push_back(block);
+  }
+  EXPECT_THROW(tested.Get(), common::NoMoreObjectException);
+  for (auto *const block : blocks) tested.Release(block);
+}
+
+// Every block remembers the node it was placed on, and a node reuses its own blocks first
+// NOLINTNEXTLINE
+TEST(BlockStoreTests, NodePlacement) {
+  const uint16_t num_nodes = BlockStore::NumNodes();
+  EXPECT_GE(num_nodes, 1);
+  EXPECT_LT(BlockStore::CurrentNode(), num_nodes);
+
+  BlockStore tested(2 * num_nodes, 2 * num_nodes);
+  std::vector<RawBlock *> blocks;
+  for (uint16_t node = 0; node < num_nodes; node++) {
+    RawBlock *const block = tested.Get(node);
+    EXPECT_EQ(BlockStore::NodeOf(block), node);
+    blocks.push_back(block);
+  }
+  for (auto *const block : blocks) tested.Release(block);
+
+  for (uint16_t node = 0; node < num_nodes; node++) {
+    RawBlock *const block = tested.Get(node);
+    EXPECT_EQ(block, blocks[node]);
+    EXPECT_EQ(BlockStore::NodeOf(block), node);
+  }
+  for (auto *const block : blocks) tested.Release(block);
+}
+
+// Blocks from the huge page arena are aligned and reused, and the store falls back to the heap once the arena is full
+// NOLINTNEXTLINE
+TEST(BlockStoreTests, HugePageArena) {
+  const uint64_t size_limit = 4;
+  BlockStore tested(size_limit, size_limit, true);
+  std::vector<RawBlock *> blocks;
+  for (uint64_t i = 0; i < size_limit; i++) {
+    RawBlock *const block = tested.Get();
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(block) % common::Constants::BLOCK_SIZE, 0);
+    blocks.push_back(block);
+  }
+  EXPECT_THROW(tested.Get(), common::NoMoreObjectException);
+
+  // Raising the size limit beyond the arena still hands out blocks
+  EXPECT_TRUE(tested.SetSizeLimit(size_limit + 1));
+  RawBlock *const extra = tested.Get();
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(extra) % common::Constants::BLOCK_SIZE, 0);
+  blocks.push_back(extra);
+
+  // Without reuse, freed arena blocks are carved out again
+  tested.SetReuseLimit(0);
+  RawBlock *const freed = blocks.front();
+  tested.Release(freed);
+  blocks.front() = tested.Get();
+  if (tested.UsesHugePages()) EXPECT_EQ(blocks.front(), freed);
+  for (auto *const block : blocks) tested.Release(block);
+}
+
+}  // namespace noisepage::storage
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstring>
 #include <map>
 #include <memory>
@@ -10,6 +11,7 @@
 #include "storage/index/index_builder.h"
 #include "storage/projected_row.h"
 #include "storage/sql_table.h"
+#include "storage/storage_util.h"
 #include "test_util/catalog_test_util.h"
 #include "test_util/storage_test_util.h"
 #include "test_util/test_harness.h"
@@ -321,6 +323,68 @@ TEST_F(BPlusTreeIndexTests, ScanAscending) {
   txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
 }
 
+/**
+ * Splits scans of an index with enough keys to have inner levels into sub-ranges, and checks that scanning the
+ * sub-ranges in order finds what scanning the whole range finds
+ */
+// NOLINTNEXTLINE
+TEST_F(BPlusTreeIndexTests, PartitionAscending) {
+  // populate index with [0..2*num_keys) even keys
+  const int32_t num_keys = 100000;
+  auto *const insert_txn = txn_manager_->BeginTransaction();
+  for (int32_t i = 0; i < 2 * num_keys; i += 2) {
+    auto *const insert_redo =
+        insert_txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_initializer_);
+    auto *const insert_tuple = insert_redo->Delta();
+    *reinterpret_cast<int32_t *>(insert_tuple->AccessForceNotNull(0)) = i;
+    const auto tuple_slot = sql_table_->Insert(common::ManagedPointer(insert_txn), insert_redo);
+
+    auto *const insert_key = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer_1_);
+    *reinterpret_cast<int32_t *>(insert_key->AccessForceNotNull(0)) = i;
+    EXPECT_TRUE(default_index_->Insert(common::ManagedPointer(insert_txn), *insert_key, tuple_slot));
+  }
+  txn_manager_->Commit(insert_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  auto *const scan_txn = txn_manager_->BeginTransaction();
+
+  auto *const low_key_pr = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer_1_);
+  auto *const high_key_pr = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer_2_);
+  *reinterpret_cast<int32_t *>(low_key_pr->AccessForceNotNull(0)) = 1001;
+  *reinterpret_cast<int32_t *>(high_key_pr->AccessForceNotNull(0)) = 150000;
+
+  const uint32_t max_partitions = 16;
+  for (const auto scan_type : {storage::index::ScanType::Closed, storage::index::ScanType::OpenLow,
+                               storage::index::ScanType::OpenHigh, storage::index::ScanType::OpenBoth}) {
+    std::vector<storage::TupleSlot> expected;
+    default_index_->ScanAscending(*scan_txn, scan_type, 1, low_key_pr, high_key_pr, 0, &expected);
+
+    const auto partitions = default_index_->PartitionAscending(scan_type, 1, low_key_pr, high_key_pr, max_partitions);
+    ASSERT_NE(partitions, nullptr);
+    EXPECT_GT(partitions->NumPartitions(), 1);
+    EXPECT_LE(partitions->NumPartitions(), max_partitions);
+
+    std::vector<storage::TupleSlot> results;
+    for (uint32_t partition = 0; partition < partitions->NumPartitions(); partition++) {
+      std::vector<storage::TupleSlot> partition_results;
+      partitions->Scan(*scan_txn, partition, &partition_results);
+      results.insert(results.end(), partition_results.begin(), partition_results.end());
+    }
+    EXPECT_EQ(expected, results);
+  }
+
+  // A range between two adjacent keys holds no separator, so it is not split
+  *reinterpret_cast<int32_t *>(low_key_pr->AccessForceNotNull(0)) = 1001;
+  *reinterpret_cast<int32_t *>(high_key_pr->AccessForceNotNull(0)) = 1003;
+  const auto partitions =
+      default_index_->PartitionAscending(storage::index::ScanType::Closed, 1, low_key_pr, high_key_pr, max_partitions);
+  EXPECT_EQ(partitions->NumPartitions(), 1);
+  std::vector<storage::TupleSlot> results;
+  partitions->Scan(*scan_txn, 0, &results);
+  EXPECT_EQ(results.size(), 1);
+
+  txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
 /**
  * Tests basic scan behavior using various windows to scan over (some out of of bounds of keyspace, some matching
  * exactly, etc.)
@@ -981,6 +1045,35 @@ TEST_F(BPlusTreeIndexTests, AbortInsert1) {
   txn_manager_->Commit(txn2, transaction::TransactionUtil::EmptyCallback, nullptr);
 }
 
+/**
+ * The index counts the keys inserted into and deleted from the tree, including the ones that an abort deletes again, so
+ * that the GC only visits it after it changed
+ */
+// NOLINTNEXTLINE
+TEST_F(BPlusTreeIndexTests, ModificationCounter) {
+  // The GC thread resets the counter of the indexes registered with it
+  const auto gc = db_main_->GetStorageLayer()->GetGarbageCollector();
+  gc->UnregisterIndexForGC(common::ManagedPointer<Index>(default_index_));
+  EXPECT_EQ(default_index_->GetNumModifications(), 0);
+
+  auto *txn0 = txn_manager_->BeginTransaction();
+  auto *insert_redo =
+      txn0->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_initializer_);
+  *reinterpret_cast<int32_t *>(insert_redo->Delta()->AccessForceNotNull(0)) = 15721;
+  const auto tuple_slot = sql_table_->Insert(common::ManagedPointer(txn0), insert_redo);
+  auto *const insert_key = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer_1_);
+  *reinterpret_cast<int32_t *>(insert_key->AccessForceNotNull(0)) = 15721;
+  EXPECT_TRUE(default_index_->Insert(common::ManagedPointer(txn0), *insert_key, tuple_slot));
+  EXPECT_EQ(default_index_->GetNumModifications(), 1);
+
+  // The abort action deletes the key from the tree
+  txn_manager_->Abort(txn0);
+  EXPECT_EQ(default_index_->TakeModifications(), 2);
+  EXPECT_EQ(default_index_->GetNumModifications(), 0);
+
+  gc->RegisterIndexForGC(common::ManagedPointer<Index>(default_index_));
+}
+
 //    Txn #0 | Txn #1 | Txn #2 |
 //    --------------------------
 //    BEGIN  |        |        |
@@ -1929,4 +2022,54 @@ TEST_F(BPlusTreeIndexTests, AbortDelete2) {
   txn_manager_->Commit(txn2, transaction::TransactionUtil::EmptyCallback, nullptr);
 }
 
+/**
+ * Probes a batch of keys, with repeated and missing keys in random order, and checks that every key gets the same
+ * results as probing it on its own.
+ */
+// NOLINTNEXTLINE
+TEST_F(BPlusTreeIndexTests, ScanKeyBatch) {
+  const uint32_t num_inserts = 10000;  // every even key in [0, 2 * num_inserts) has two values
+  auto *const insert_txn = txn_manager_->BeginTransaction();
+  auto *const insert_key = default_index_->GetProjectedRowInitializer().InitializeRow(key_buffer_1_);
+  for (uint32_t i = 0; i < num_inserts * 2; i++) {
+    auto *const insert_redo =
+        insert_txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_initializer_);
+    *reinterpret_cast<int32_t *>(insert_redo->Delta()->AccessForceNotNull(0)) = i / 2 * 2;
+    const auto tuple_slot = sql_table_->Insert(common::ManagedPointer(insert_txn), insert_redo);
+    *reinterpret_cast<int32_t *>(insert_key->AccessForceNotNull(0)) = i / 2 * 2;
+    EXPECT_TRUE(default_index_->Insert(common::ManagedPointer(insert_txn), *insert_key, tuple_slot));
+  }
+  txn_manager_->Commit(insert_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  const uint32_t batch_size = 4096;
+  const auto &initializer = default_index_->GetProjectedRowInitializer();
+  const uint32_t key_size = StorageUtil::PadUpToSize(sizeof(uint64_t), initializer.ProjectedRowSize());
+  auto *const batch_buffer = common::AllocationUtil::AllocateAligned(key_size * batch_size);
+  std::uniform_int_distribution<int32_t> distribution(-1, num_inserts * 2);
+  std::vector<const ProjectedRow *> keys;
+  for (uint32_t i = 0; i < batch_size; i++) {
+    auto *const key = initializer.InitializeRow(batch_buffer + i * key_size);
+    *reinterpret_cast<int32_t *>(key->AccessForceNotNull(0)) = distribution(generator_);
+    keys.emplace_back(key);
+  }
+
+  auto *const scan_txn = txn_manager_->BeginTransaction();
+  std::vector<std::vector<storage::TupleSlot>> batch_results;
+  default_index_->ScanKeyBatch(*scan_txn, keys, &batch_results);
+  EXPECT_EQ(batch_results.size(), batch_size);
+
+  std::vector<storage::TupleSlot> results;
+  for (uint32_t i = 0; i < batch_size; i++) {
+    results.clear();
+    default_index_->ScanKey(*scan_txn, *keys[i], &results);
+    const int32_t key = *reinterpret_cast<const int32_t *>(keys[i]->AccessWithNullCheck(0));
+    EXPECT_EQ(results.size(), key >= 0 && key < static_cast<int32_t>(num_inserts * 2) && key % 2 == 0 ? 2 : 0);
+    EXPECT_TRUE(
+        std::is_permutation(results.begin(), results.end(), batch_results[i].begin(), batch_results[i].end()));
+  }
+
+  txn_manager_->Commit(scan_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  delete[] batch_buffer;
+}
+
 }  // namespace noisepage::storage::index
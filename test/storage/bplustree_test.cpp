@@ -1,6 +1,9 @@
+#include <atomic>
 #include <cstdlib>
+#include <random>
 #include <set>
 #include <unordered_map>
+#include <vector>
 
 #include "storage/index/bplustree.h"
 #include "storage/storage_defs.h"
@@ -1503,4 +1506,158 @@ TEST_F(BPlusTreeTests, MultiThreadedDeleteTest) {
   delete tree;
 }
 
+// NOLINTNEXTLINE
+TEST_F(BPlusTreeTests, MultiThreadedOptimisticReadTest) {
+  /**
+   * Tests lookups that descend the B+ Tree without latches while other threads split and merge its nodes
+   */
+  std::function<bool(const int64_t)> predicate = [](const int64_t slot) -> bool { return false; };
+  const int64_t key_num = 100 * 1000;
+
+  auto *const tree = new BPlusTree<int64_t, int64_t>;
+  // The even keys stay in the tree throughout, the odd keys are inserted and deleted by the writers
+  for (int64_t i = 0; i < key_num; i++) {
+    BPlusTree<int64_t, int64_t>::KeyElementPair p1;
+    p1.first = i * 2;
+    p1.second = i * 2;
+    tree->Insert(p1, predicate);
+  }
+
+  const uint32_t num_writers = num_threads_ / 2;
+  std::atomic<uint32_t> writers_done = 0;
+  auto workload = [&](uint32_t worker_id) {
+    if (worker_id < num_writers) {
+      for (uint32_t round = 0; round < 3; round++) {
+        for (int64_t i = worker_id; i < key_num; i += num_writers) {
+          BPlusTree<int64_t, int64_t>::KeyElementPair p1;
+          p1.first = i * 2 + 1;
+          p1.second = i * 2 + 1;
+          tree->Insert(p1, predicate);
+        }
+        for (int64_t i = worker_id; i < key_num; i += num_writers) {
+          BPlusTree<int64_t, int64_t>::KeyElementPair p1;
+          p1.first = i * 2 + 1;
+          p1.second = i * 2 + 1;
+          tree->DeleteElement(p1);
+        }
+      }
+      writers_done++;
+      return;
+    }
+
+    std::default_random_engine generator(worker_id);
+    std::uniform_int_distribution<int64_t> distribution(0, key_num - 1);
+    std::vector<int64_t> results;
+    while (writers_done < num_writers) {
+      const int64_t key = distribution(generator) * 2;
+      results.clear();
+      tree->FindValueOfKey(key, &results);
+      EXPECT_EQ(results.size(), 1);
+      if (!results.empty()) EXPECT_EQ(results[0], key);
+    }
+  };
+
+  // Run the workload
+  for (uint32_t i = 0; i < num_threads_; i++) {
+    thread_pool_.SubmitTask([i, &workload] { workload(i); });
+  }
+  thread_pool_.WaitUntilAllFinished();
+
+  EXPECT_EQ(tree->GetSize(), key_num);
+
+  // Verify Structural Integrity
+  std::set<int64_t> keys_present;
+  for (int64_t i = 0; i < key_num; i++) keys_present.insert(i * 2);
+  EXPECT_EQ(tree->StructuralIntegrityVerification(0, (key_num - 1) * 2, &keys_present, tree->GetRoot()), true);
+
+  delete tree;
+}
+
+// NOLINTNEXTLINE
+TEST_F(BPlusTreeTests, BulkLoadTest) {
+  /**
+   * Builds B+ Trees bottom-up from sorted elements of several sizes, and checks that they stay well formed as they
+   * are modified afterwards
+   */
+  std::function<bool(const int64_t)> predicate = [](const int64_t slot) -> bool { return false; };
+  for (const int64_t key_num : {1, 100, 129, 10 * 1000, 1000 * 1000}) {
+    auto *const tree = new BPlusTree<int64_t, int64_t>;
+    // Every key has two values
+    std::vector<BPlusTree<int64_t, int64_t>::KeyElementPair> elements;
+    for (int64_t i = 0; i < key_num; i++) {
+      elements.emplace_back(i * 2, i * 2);
+      elements.emplace_back(i * 2, -i * 2);
+    }
+    tree->BulkLoad(elements);
+    EXPECT_EQ(tree->GetSize(), key_num);
+
+    std::set<int64_t> keys;
+    for (int64_t i = 0; i < key_num; i++) keys.insert(i * 2);
+    EXPECT_EQ(tree->StructuralIntegrityVerification(0, (key_num - 1) * 2, &keys, tree->GetRoot()), true);
+
+    std::vector<int64_t> results;
+    for (int64_t i = 0; i < key_num; i++) {
+      results.clear();
+      tree->FindValueOfKey(i * 2, &results);
+      EXPECT_EQ(results.size(), 2);
+    }
+
+    // Fill the gaps between the loaded keys, then remove the loaded keys again
+    for (int64_t i = 0; i < key_num; i++) {
+      BPlusTree<int64_t, int64_t>::KeyElementPair p1;
+      p1.first = i * 2 + 1;
+      p1.second = i * 2 + 1;
+      tree->Insert(p1, predicate);
+    }
+    for (const auto &element : elements) tree->DeleteElement(element);
+    EXPECT_EQ(tree->GetSize(), key_num);
+
+    keys.clear();
+    for (int64_t i = 0; i < key_num; i++) keys.insert(i * 2 + 1);
+    EXPECT_EQ(tree->StructuralIntegrityVerification(1, key_num * 2 - 1, &keys, tree->GetRoot()), true);
+
+    delete tree;
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(BPlusTreeTests, InsertElementsTest) {
+  /**
+   * Inserts sorted batches into trees that already hold every third key, so that batches run into full leaves and
+   * split them, and checks that duplicate elements are not inserted twice
+   */
+  std::function<bool(const int64_t)> predicate = [](const int64_t slot) -> bool { return false; };
+  for (const int64_t key_num : {1, 100, 10 * 1000, 100 * 1000}) {
+    auto *const tree = new BPlusTree<int64_t, int64_t>;
+    // A batch into an empty tree has to create the root first
+    std::vector<BPlusTree<int64_t, int64_t>::KeyElementPair> elements;
+    for (int64_t i = 0; i < key_num; i += 3) elements.emplace_back(i, i);
+    EXPECT_EQ(tree->InsertElements(elements), elements.size());
+
+    elements.clear();
+    for (int64_t i = 0; i < key_num; i++) {
+      elements.emplace_back(i, i);
+      elements.emplace_back(i, -i - 1);
+    }
+    EXPECT_EQ(tree->InsertElements(elements), key_num * 2 - (key_num + 2) / 3);
+    EXPECT_EQ(tree->GetSize(), key_num);
+
+    std::set<int64_t> keys;
+    for (int64_t i = 0; i < key_num; i++) keys.insert(i);
+    EXPECT_EQ(tree->StructuralIntegrityVerification(0, key_num - 1, &keys, tree->GetRoot()), true);
+
+    std::vector<int64_t> results;
+    for (int64_t i = 0; i < key_num; i++) {
+      results.clear();
+      tree->FindValueOfKey(i, &results);
+      EXPECT_EQ(results.size(), 2);
+    }
+
+    for (const auto &element : elements) EXPECT_TRUE(tree->DeleteElement(element));
+    EXPECT_EQ(tree->GetSize(), 0);
+
+    delete tree;
+  }
+}
+
 }  // namespace noisepage::storage::index
@@ -514,4 +514,53 @@ TEST_F(BwTreeTests, DISABLED_EpochManager) {
   delete tree;
 }
 
+/**
+ * Workers insert and delete keys while another thread keeps consolidating every delta chain in the background. The
+ * background consolidations must not lose or resurrect any key, and must show up in the consolidation statistics.
+ */
+// NOLINTNEXTLINE
+TEST_F(BwTreeTests, BackgroundConsolidation) {
+  const int64_t key_num = 64 * 1024;
+  common::WorkerPool thread_pool(num_threads_, {});
+  thread_pool.Startup();
+  auto *const tree = BwTreeTestUtil::GetEmptyTree();
+  std::atomic<uint32_t> workers_done = 0;
+
+  // Thread 0 consolidates, the others insert every key of their stripe and delete the odd ones again
+  auto workload = [&](uint32_t id) {
+    const uint32_t gcid = id + 1;
+    tree->AssignGCID(gcid);
+    if (id == 0) {
+      while (workers_done.load() < num_threads_ - 1) tree->ConsolidateDeltaChains(1, 1);
+    } else {
+      for (int64_t key = id - 1; key < key_num; key += num_threads_ - 1) tree->Insert(key, key);
+      for (int64_t key = id - 1; key < key_num; key += num_threads_ - 1) {
+        if (key % 2 == 1) tree->Delete(key, key);
+      }
+      workers_done++;
+    }
+    tree->UnregisterThread(gcid);
+  };
+
+  tree->UpdateThreadLocal(num_threads_ + 1);
+  MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, num_threads_, workload);
+  tree->UpdateThreadLocal(1);
+
+  for (int64_t key = 0; key < key_num; key++) {
+    auto s = tree->GetValue(key);
+    if (key % 2 == 1) {
+      EXPECT_TRUE(s.empty());
+    } else {
+      EXPECT_EQ(s.size(), 1);
+      EXPECT_EQ(*s.begin(), key);
+    }
+  }
+  EXPECT_EQ(tree->GetSize(), key_num / 2);
+  EXPECT_GT(tree->background_consolidation_count.load(), 0);
+  EXPECT_LE(tree->background_consolidation_count.load(), tree->consolidation_count.load());
+  EXPECT_LE(tree->longest_consolidated_chain.load(), tree->consolidated_delta_count.load());
+
+  delete tree;
+}
+
 }  // namespace noisepage
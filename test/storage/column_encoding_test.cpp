@@ -0,0 +1,133 @@
+#include "storage/column_encoding.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "common/container/concurrent_bitmap.h"
+#include "common/macros.h"
+#include "gtest/gtest.h"
+
+namespace noisepage::storage {
+
+namespace {
+
+// A column of values of the given size, with every seventh value null
+class TestColumn {
+ public:
+  TestColumn(const uint8_t size, const uint32_t num_values)
+      : size_(size),
+        num_values_(num_values),
+        values_(static_cast<size_t>(size) * num_values),
+        present_(common::RawConcurrentBitmap::Allocate(num_values)) {
+    for (uint32_t i = 0; i < num_values; i++)
+      if (i % 7 != 3) present_->Flip(i, false);
+  }
+
+  ~TestColumn() { common::RawConcurrentBitmap::Deallocate(present_); }
+
+  DISALLOW_COPY_AND_MOVE(TestColumn)
+
+  void Set(const uint32_t i, const int64_t value) {
+    if (!present_->Test(i)) return;
+    // Truncating the value keeps the bytes of its low end on a little-endian machine
+    std::memcpy(&values_[static_cast<size_t>(i) * size_], &value, size_);
+    min_ = std::min(min_, Read(i));
+    max_ = std::max(max_, Read(i));
+  }
+
+  int64_t Read(const uint32_t i) const {
+    switch (size_) {
+      case 1:
+        return *reinterpret_cast<const int8_t *>(&values_[i]);
+      case 2:
+        return *reinterpret_cast<const int16_t *>(&values_[static_cast<size_t>(i) * 2]);
+      case 4:
+        return *reinterpret_cast<const int32_t *>(&values_[static_cast<size_t>(i) * 4]);
+      default:
+        return *reinterpret_cast<const int64_t *>(&values_[static_cast<size_t>(i) * 8]);
+    }
+  }
+
+  EncodedColumn Encode() const {
+    return EncodedColumn::Encode(values_.data(), size_, present_, num_values_, min_, max_);
+  }
+
+  // Decodes the column a range at a time, and checks that every present value comes back
+  void Verify(const EncodedColumn &encoded, const uint32_t range_size) const {
+    std::vector<byte> decoded(static_cast<size_t>(range_size) * size_);
+    for (uint32_t begin = 0; begin < num_values_; begin += range_size) {
+      const uint32_t count = std::min(range_size, num_values_ - begin);
+      encoded.Decode(begin, count, size_, decoded.data());
+      for (uint32_t i = 0; i < count; i++) {
+        if (!present_->Test(begin + i)) continue;
+        EXPECT_EQ(std::memcmp(&decoded[static_cast<size_t>(i) * size_], &values_[(begin + i) * size_], size_), 0);
+      }
+    }
+  }
+
+ private:
+  const uint8_t size_;
+  const uint32_t num_values_;
+  std::vector<byte> values_;
+  common::RawConcurrentBitmap *const present_;
+  int64_t min_ = INT64_MAX;
+  int64_t max_ = INT64_MIN;
+};
+
+}  // namespace
+
+// Values of a small range are packed into as many bits as the range needs, for every attribute size
+// NOLINTNEXTLINE
+TEST(ColumnEncodingTests, FrameOfReference) {
+  std::default_random_engine generator;
+  // The last group is not full
+  const uint32_t num_values = 4000;
+  for (const uint8_t size : {1, 2, 4, 8}) {
+    for (uint8_t bits = 0; bits < size * 8; bits++) {
+      TestColumn column(size, num_values);
+      std::uniform_int_distribution<uint64_t> distribution(0, bits == 0 ? 0 : (uint64_t{1} << bits) - 1);
+      // The reference is negative, and the largest value is of the full bit width
+      const int64_t reference = -(int64_t{1} << (size * 8 - 2));
+      for (uint32_t i = 0; i < num_values; i++)
+        column.Set(i, reference + static_cast<int64_t>(i == 0 ? distribution.max() : distribution(generator)));
+
+      const EncodedColumn encoded = column.Encode();
+      EXPECT_EQ(encoded.Encoding(), ColumnEncoding::FRAME_OF_REFERENCE);
+      EXPECT_EQ(encoded.BitWidth(), bits);
+      EXPECT_LT(encoded.EncodedSize(), num_values * size);
+      column.Verify(encoded, 2048);
+      column.Verify(encoded, 64 * 3);
+    }
+  }
+}
+
+// Long runs of equal values are stored once, and values that take up the whole type are not encoded
+// NOLINTNEXTLINE
+TEST(ColumnEncodingTests, RunLengthAndPlain) {
+  std::default_random_engine generator;
+  const uint32_t num_values = 5000;
+  for (const uint8_t size : {2, 4, 8}) {
+    TestColumn runs(size, num_values);
+    std::uniform_int_distribution<int64_t> distribution(INT16_MIN, INT16_MAX);
+    int64_t value = 0;
+    for (uint32_t i = 0; i < num_values; i++) {
+      if (i % 500 == 0) value = distribution(generator);
+      runs.Set(i, value);
+    }
+    const EncodedColumn encoded = runs.Encode();
+    EXPECT_EQ(encoded.Encoding(), ColumnEncoding::RUN_LENGTH);
+    EXPECT_LE(encoded.NumRuns(), num_values / 500);
+    runs.Verify(encoded, 2048);
+    runs.Verify(encoded, 64);
+
+    TestColumn random(size, num_values);
+    std::uniform_int_distribution<int64_t> full_range(INT64_MIN, INT64_MAX);
+    for (uint32_t i = 0; i < num_values; i++) random.Set(i, full_range(generator));
+    EXPECT_EQ(random.Encode().Encoding(), ColumnEncoding::PLAIN);
+  }
+}
+
+}  // namespace noisepage::storage
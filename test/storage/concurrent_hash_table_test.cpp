@@ -0,0 +1,186 @@
+#include "storage/index/concurrent_hash_table.h"
+
+#include <atomic>
+#include <cstring>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "storage/storage_defs.h"
+#include "test_util/multithread_test_util.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::storage::index {
+
+class ConcurrentHashTableTests : public TerrierTest {
+ public:
+  const uint32_t num_threads_ = 4;
+  common::WorkerPool thread_pool_{num_threads_, {}};
+
+  // Maps many keys to the same hash, so that probes have to skip other keys' slots
+  struct CollidingHash {
+    size_t operator()(const uint64_t key) const { return key % 7; }
+  };
+
+  // The table only stores and compares TupleSlots, so any 8 bytes make a value
+  static TupleSlot Slot(uint64_t value) {
+    TupleSlot slot;
+    std::memcpy(&slot, &value, sizeof(TupleSlot));
+    return slot;
+  }
+
+  static uint64_t Value(TupleSlot slot) {
+    uint64_t value;
+    std::memcpy(&value, &slot, sizeof(TupleSlot));
+    return value;
+  }
+
+  template <typename Table>
+  static void CheckKey(const Table &table, const uint64_t key,
+                       const std::map<uint64_t, std::set<uint64_t>> &reference) {
+    std::vector<TupleSlot> values;
+    table.Lookup(key, &values);
+    auto it = reference.find(key);
+    ASSERT_EQ(values.size(), it == reference.end() ? 0 : it->second.size());
+    for (const auto slot : values) EXPECT_EQ(it->second.count(Value(slot)), 1);
+  }
+
+ protected:
+  void SetUp() override { thread_pool_.Startup(); }
+
+  void TearDown() override { thread_pool_.Shutdown(); }
+};
+
+/**
+ * Applies random inserts, erases and lookups and checks every result against a std::map. Keys get up to eight values,
+ * so they move between inline and overflowing values, and the tables grow and rehash their deleted slots while keys
+ * are spread over the old and the new table.
+ */
+// NOLINTNEXTLINE
+TEST_F(ConcurrentHashTableTests, RandomOperations) {
+  const auto never = [](TupleSlot) { return false; };
+
+  auto run = [&](auto *table, const uint64_t num_keys) {
+    std::map<uint64_t, std::set<uint64_t>> reference;
+    std::default_random_engine generator(num_keys);
+
+    for (uint32_t i = 0; i < 200000; i++) {
+      const uint64_t key = generator() % num_keys;
+      const uint64_t value = (generator() % 8 + 1) * 8;
+      switch (generator() % 3) {
+        case 0: {
+          const bool expected = reference[key].insert(value).second;
+          EXPECT_EQ(table->Insert(key, Slot(value), never), expected);
+          break;
+        }
+        case 1: {
+          auto it = reference.find(key);
+          const bool expected = it != reference.end() && it->second.erase(value) == 1;
+          if (it != reference.end() && it->second.empty()) reference.erase(it);
+          EXPECT_EQ(table->Erase(key, Slot(value)), expected);
+          break;
+        }
+        default:
+          CheckKey(*table, key, reference);
+      }
+      if (i % 10000 == 0) EXPECT_EQ(table->GetSize(), reference.size());
+    }
+
+    for (uint64_t key = 0; key < num_keys; key++) CheckKey(*table, key, reference);
+
+    // Erasing every value empties the table
+    for (const auto &[key, values] : reference) {
+      for (const auto value : values) EXPECT_TRUE(table->Erase(key, Slot(value)));
+    }
+    EXPECT_EQ(table->GetSize(), 0);
+  };
+
+  for (const uint64_t num_keys : {100, 5000}) {
+    ConcurrentHashTable<uint64_t> table;
+    run(&table, num_keys);
+  }
+  ConcurrentHashTable<uint64_t, CollidingHash> colliding_table;
+  run(&colliding_table, 300);
+}
+
+/**
+ * Checks that the predicate can reject an insert, and that it sees every existing value of the key.
+ */
+// NOLINTNEXTLINE
+TEST_F(ConcurrentHashTableTests, Predicates) {
+  ConcurrentHashTable<uint64_t> table;
+  const auto never = [](TupleSlot) { return false; };
+
+  EXPECT_TRUE(table.Insert(42, Slot(8), never));
+  EXPECT_FALSE(table.Insert(42, Slot(8), never));
+  EXPECT_FALSE(table.Insert(42, Slot(16), [](TupleSlot slot) { return Value(slot) == 8; }));
+  EXPECT_TRUE(table.Insert(42, Slot(16), never));
+  EXPECT_TRUE(table.Insert(42, Slot(24), never));
+
+  // The third value no longer fits inline
+  EXPECT_FALSE(table.Insert(42, Slot(32), [](TupleSlot slot) { return Value(slot) == 24; }));
+  EXPECT_TRUE(table.Insert(42, Slot(32), never));
+  EXPECT_EQ(table.GetSize(), 1);
+
+  std::vector<TupleSlot> values;
+  table.Lookup(42, &values);
+  EXPECT_EQ(values.size(), 4);
+
+  EXPECT_TRUE(table.Erase(42, Slot(8)));
+  EXPECT_FALSE(table.Erase(42, Slot(8)));
+  EXPECT_FALSE(table.Erase(43, Slot(16)));
+  EXPECT_GT(table.GetHeapUsage(), 0);
+}
+
+/**
+ * Writers insert and erase keys while readers look up a set of keys that is never changed. Readers must always find
+ * every stable key with its value, even while the shards grow underneath them.
+ */
+// NOLINTNEXTLINE
+TEST_F(ConcurrentHashTableTests, ConcurrentReadersAndWriters) {
+  ConcurrentHashTable<uint64_t> table;
+  const auto never = [](TupleSlot) { return false; };
+  const uint64_t num_stable_keys = 10000;
+
+  // Multiples of 4 are stable, writers only touch the keys in between
+  for (uint64_t i = 0; i < num_stable_keys; i++) table.Insert(i * 4, Slot((i * 4 + 1) * 8), never);
+
+  std::atomic<uint32_t> writers_done = 0;
+  auto workload = [&](uint32_t worker_id) {
+    std::default_random_engine generator(worker_id);
+    if (worker_id % 2 == 0) {
+      for (uint32_t i = 0; i < 200000; i++) {
+        const uint64_t x = (generator() % (num_stable_keys * 4)) * 4 + 1 + generator() % 3;
+        if (generator() % 2 == 0) {
+          table.Insert(x, Slot((x + 1) * 8), never);
+        } else {
+          table.Erase(x, Slot((x + 1) * 8));
+        }
+      }
+      writers_done++;
+      return;
+    }
+
+    while (writers_done.load() < num_threads_ / 2) {
+      const uint64_t x = (generator() % num_stable_keys) * 4;
+      std::vector<TupleSlot> values;
+      table.Lookup(x, &values);
+      ASSERT_EQ(values.size(), 1);
+      EXPECT_EQ(Value(values[0]), (x + 1) * 8);
+    }
+  };
+
+  for (uint32_t i = 0; i < num_threads_; i++) {
+    thread_pool_.SubmitTask([i, &workload] { workload(i); });
+  }
+  thread_pool_.WaitUntilAllFinished();
+
+  for (uint64_t i = 0; i < num_stable_keys; i++) {
+    std::vector<TupleSlot> values;
+    table.Lookup(i * 4, &values);
+    EXPECT_EQ(values.size(), 1);
+  }
+}
+
+}  // namespace noisepage::storage::index
@@ -1,5 +1,6 @@
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "storage/data_table.h"
@@ -124,6 +125,45 @@ TEST_F(DataTableConcurrentTests, ConcurrentInsert) {
   }
 }
 
+// Concurrent inserters spread over several blocks that are appended while other threads insert. Every inserted tuple
+// must show up exactly once when scanning the table afterwards.
+// NOLINTNEXTLINE
+TEST_F(DataTableConcurrentTests, ConcurrentInsertScan) {
+  const uint32_t num_iterations = 10;
+  const uint32_t num_inserts = 100000;
+  const uint16_t max_columns = 20;
+  const uint32_t num_threads = MultiThreadTestUtil::HardwareConcurrency();
+  common::WorkerPool thread_pool(num_threads, {});
+  thread_pool.Startup();
+
+  for (uint32_t iteration = 0; iteration < num_iterations; iteration++) {
+    storage::BlockLayout layout = StorageTestUtil::RandomLayoutNoVarlen(max_columns, &generator_);
+    storage::DataTable tested(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                              storage::layout_version_t(0));
+    std::vector<std::unique_ptr<FakeTransaction>> fake_txns;
+    for (uint32_t thread = 0; thread < num_threads; thread++)
+      fake_txns.emplace_back(std::make_unique<FakeTransaction>(layout, &tested, null_ratio_(generator_),
+                                                               transaction::timestamp_t(0), transaction::timestamp_t(0),
+                                                               &buffer_pool_));
+    auto workload = [&](uint32_t id) {
+      std::default_random_engine thread_generator(id);
+      for (uint32_t i = 0; i < num_inserts / num_threads; i++) fake_txns[id]->InsertRandomTuple(&thread_generator);
+    };
+    MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, num_threads, workload);
+
+    std::unordered_set<storage::TupleSlot> inserted;
+    for (auto &fake_txn : fake_txns) {
+      inserted.insert(fake_txn->InsertedTuples().begin(), fake_txn->InsertedTuples().end());
+    }
+    EXPECT_EQ(inserted.size(), num_inserts / num_threads * num_threads);
+
+    std::unordered_set<storage::TupleSlot> scanned;
+    for (auto it = tested.begin(); it != tested.end(); it++) EXPECT_TRUE(scanned.insert(*it).second);
+    EXPECT_EQ(scanned, inserted);
+    EXPECT_EQ(tested.GetBlocks().size(), tested.GetNumBlocks());
+  }
+}
+
 // Spawns multiple transactions that all begin at the same time.
 // Each transaction attempts to update the same tuple.
 // Therefore only one transaction should win, which is what we test for.
@@ -2,10 +2,13 @@
 
 #include <cstring>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "common/object_pool.h"
+#include "execution/sql/tuple_id_list.h"
+#include "execution/sql/vector_projection.h"
 #include "storage/storage_util.h"
 #include "test_util/storage_test_util.h"
 #include "test_util/test_harness.h"
@@ -290,6 +293,54 @@ TEST_F(DataTableTests, SimpleSequentialScanBlocks) {
   }
 }
 
+// Deletes a random subset of the tuples of a few blocks, and scans them with a buffer that fills up in the middle of a
+// block. Each scan sees every tuple exactly once, and the deleted ones only when it reads from before the deletes.
+// NOLINTNEXTLINE
+TEST_F(DataTableTests, SequentialScanSmallBatches) {
+  const uint16_t max_columns = 20;
+  const uint32_t batch_size = 37;
+  RandomDataTableTestObject tested(&block_store_, max_columns, null_ratio_(generator_), &generator_);
+  const uint32_t num_inserts = 2 * tested.Layout().NumSlots() + 100;
+  for (uint32_t i = 0; i < num_inserts; ++i)
+    tested.InsertRandomTuple(transaction::timestamp_t(0), &generator_, &buffer_pool_);
+
+  auto *delete_txn = new transaction::TransactionContext(transaction::timestamp_t(1), transaction::timestamp_t(1),
+                                                         common::ManagedPointer(&buffer_pool_), DISABLED);
+  std::unordered_set<storage::TupleSlot> deleted;
+  std::bernoulli_distribution delete_dist(0.5);
+  for (const storage::TupleSlot slot : tested.InsertedTuples()) {
+    if (!delete_dist(generator_)) continue;
+    EXPECT_TRUE(tested.GetTable().Delete(common::ManagedPointer(delete_txn), slot));
+    deleted.insert(slot);
+  }
+
+  std::vector<storage::col_id_t> all_cols = StorageTestUtil::ProjectionListAllColumns(tested.Layout());
+  storage::ProjectedColumnsInitializer initializer(tested.Layout(), all_cols, batch_size);
+  auto *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedColumnsSize());
+  storage::ProjectedColumns *columns = initializer.Initialize(buffer);
+  for (const transaction::timestamp_t timestamp : {transaction::timestamp_t(0), transaction::timestamp_t(2)}) {
+    std::unordered_set<storage::TupleSlot> seen;
+    auto it = tested.GetTable().begin();
+    while (it != tested.GetTable().end()) {
+      tested.Scan(&it, timestamp, columns, &buffer_pool_);
+      EXPECT_LE(columns->NumTuples(), batch_size);
+      for (uint32_t i = 0; i < columns->NumTuples(); i++) {
+        const storage::TupleSlot slot = columns->TupleSlots()[i];
+        EXPECT_TRUE(seen.insert(slot).second);
+        storage::ProjectedColumns::RowView stored = columns->InterpretAsRow(i);
+        const storage::ProjectedRow *ref = tested.GetReferenceVersionedTuple(slot, timestamp);
+        EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), &stored, ref));
+      }
+    }
+    EXPECT_EQ(seen.size(), timestamp == transaction::timestamp_t(0) ? num_inserts : num_inserts - deleted.size());
+    if (timestamp != transaction::timestamp_t(0)) {
+      for (const storage::TupleSlot slot : deleted) EXPECT_EQ(seen.count(slot), 0);
+    }
+  }
+  delete[] buffer;
+  delete delete_txn;
+}
+
 // Generates a random table layout and coin flip bias for an attribute being null, inserts 1 random tuple into an empty
 // DataTable. Then, randomly updates the tuple num_updates times. Finally, Selects at each timestamp to verify that the
 // delta chain produces the correct tuple. Repeats for num_iterations.
@@ -413,4 +464,169 @@ TEST_F(DataTableTests, SlotIteraterSingleThreadedTest) {
     delete txn;
   }
 }
+
+// Inserts a batch of random tuples that spans several blocks, and checks that every block is filled before the next
+// one is used and that every tuple reads back as inserted.
+// NOLINTNEXTLINE
+TEST_F(DataTableTests, InsertBatchSelect) {
+  const uint32_t num_iterations = 5;
+  const uint16_t max_columns = 20;
+  for (uint32_t iteration = 0; iteration < num_iterations; ++iteration) {
+    RandomDataTableTestObject tested(&block_store_, max_columns, null_ratio_(generator_), &generator_);
+    const storage::BlockLayout &layout = tested.Layout();
+    const uint32_t num_inserts = 2 * layout.NumSlots() + 7;
+
+    std::vector<storage::col_id_t> all_cols = StorageTestUtil::ProjectionListAllColumns(layout);
+    storage::ProjectedColumnsInitializer columns_initializer(layout, all_cols, num_inserts);
+    auto *columns_buffer = common::AllocationUtil::AllocateAligned(columns_initializer.ProjectedColumnsSize());
+    storage::ProjectedColumns *redos = columns_initializer.Initialize(columns_buffer);
+    storage::ProjectedRowInitializer row_initializer = storage::ProjectedRowInitializer::Create(layout, all_cols);
+    std::vector<byte *> rows;
+    for (uint32_t i = 0; i < num_inserts; i++) {
+      rows.push_back(common::AllocationUtil::AllocateAligned(row_initializer.ProjectedRowSize()));
+      storage::ProjectedRow *row = row_initializer.InitializeRow(rows.back());
+      StorageTestUtil::PopulateRandomRow(row, layout, null_ratio_(generator_), &generator_);
+      storage::ProjectedColumns::RowView view = redos->InterpretAsRow(i);
+      for (uint16_t j = 0; j < row->NumColumns(); j++)
+        storage::StorageUtil::CopyWithNullCheck(row->AccessWithNullCheck(j), &view,
+                                                layout.AttrSize(row->ColumnIds()[j]), j);
+    }
+    redos->SetNumTuples(num_inserts);
+
+    auto *txn = new transaction::TransactionContext(transaction::timestamp_t(0), transaction::timestamp_t(0),
+                                                    common::ManagedPointer(&buffer_pool_), DISABLED);
+    std::vector<storage::TupleSlot> slots(num_inserts);
+    tested.GetTable().InsertBatch(common::ManagedPointer(txn), redos, slots.data());
+
+    auto *reader = new transaction::TransactionContext(transaction::timestamp_t(1), transaction::timestamp_t(1),
+                                                       common::ManagedPointer(&buffer_pool_), DISABLED);
+    auto *select_buffer = common::AllocationUtil::AllocateAligned(row_initializer.ProjectedRowSize());
+    storage::ProjectedRow *stored = row_initializer.InitializeRow(select_buffer);
+    std::unordered_set<storage::RawBlock *> blocks;
+    for (uint32_t i = 0; i < num_inserts; i++) {
+      blocks.insert(slots[i].GetBlock());
+      EXPECT_EQ(slots[i].GetOffset(), i % layout.NumSlots());
+      EXPECT_TRUE(tested.GetTable().Select(common::ManagedPointer(reader), slots[i], stored));
+      EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(
+          layout, stored, reinterpret_cast<const storage::ProjectedRow *>(rows[i])));
+    }
+    EXPECT_EQ(blocks.size(), 3);
+
+    delete[] select_buffer;
+    delete reader;
+    delete txn;
+    for (auto *row : rows) delete[] row;
+    delete[] columns_buffer;
+  }
+}
+
+// Selects a batch of tuples of which only some are visible, and checks that exactly the visible ones are selected
+// NOLINTNEXTLINE
+TEST_F(DataTableTests, SelectBatch) {
+  const uint32_t num_tuples = 100;
+  storage::BlockLayout layout({8, 8, 8});
+  storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                           storage::layout_version_t(0));
+  std::vector<storage::col_id_t> all_cols = StorageTestUtil::ProjectionListAllColumns(layout);
+  storage::ProjectedRowInitializer initializer = storage::ProjectedRowInitializer::Create(layout, all_cols);
+  auto *row_buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  storage::ProjectedRow *row = initializer.InitializeRow(row_buffer);
+
+  // Even tuples are inserted before the reader starts, odd ones after
+  auto *old_txn = new transaction::TransactionContext(transaction::timestamp_t(0), transaction::timestamp_t(0),
+                                                      common::ManagedPointer(&buffer_pool_), DISABLED);
+  auto *new_txn = new transaction::TransactionContext(transaction::timestamp_t(2), transaction::timestamp_t(2),
+                                                      common::ManagedPointer(&buffer_pool_), DISABLED);
+  std::vector<storage::TupleSlot> slots;
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    for (uint16_t j = 0; j < row->NumColumns(); j++) *reinterpret_cast<int64_t *>(row->AccessForceNotNull(j)) = i;
+    slots.push_back(table.Insert(common::ManagedPointer(i % 2 == 0 ? old_txn : new_txn), *row));
+  }
+
+  execution::sql::VectorProjection projection;
+  projection.SetStorageColIds(all_cols);
+  projection.Initialize(std::vector<execution::sql::TypeId>(all_cols.size(), execution::sql::TypeId::BigInt));
+  execution::sql::TupleIdList tids(num_tuples);
+  tids.AddAll();
+  // Rows that are not asked for stay unselected
+  tids.Remove(0);
+
+  auto *reader = new transaction::TransactionContext(transaction::timestamp_t(1), transaction::timestamp_t(1),
+                                                     common::ManagedPointer(&buffer_pool_), DISABLED);
+  table.SelectBatch(common::ManagedPointer(reader), slots.data(), &projection, &tids);
+  EXPECT_EQ(tids.GetTupleCount(), num_tuples / 2 - 1);
+  EXPECT_EQ(projection.GetSelectedTupleCount(), num_tuples / 2 - 1);
+  tids.ForEach([&](const uint32_t tid) {
+    EXPECT_EQ(tid % 2, 0);
+    EXPECT_NE(tid, 0);
+    EXPECT_EQ(projection.GetTupleSlot(tid), slots[tid]);
+    for (uint16_t j = 0; j < all_cols.size(); j++)
+      EXPECT_EQ(reinterpret_cast<int64_t *>(projection.GetColumn(j)->GetData())[tid], tid);
+  });
+
+  delete reader;
+  delete new_txn;
+  delete old_txn;
+  delete[] row_buffer;
+}
+
+// Inserts into a table partitioned by ranges of a column, and checks that the tuples of a range share blocks that the
+// zone maps prune from scans of the other ranges
+// NOLINTNEXTLINE
+TEST_F(DataTableTests, RangePartitioning) {
+  storage::BlockLayout layout({8, 8, 8});
+  const storage::col_id_t key_col(1);
+  const uint32_t num_tuples = layout.NumSlots() + 10;
+  storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                           storage::layout_version_t(0));
+  table.SetRangePartitioning(key_col, {100, 200});
+  EXPECT_EQ(table.NumPartitions(), 3);
+  std::vector<storage::col_id_t> all_cols = StorageTestUtil::ProjectionListAllColumns(layout);
+  storage::ProjectedRowInitializer initializer = storage::ProjectedRowInitializer::Create(layout, all_cols);
+  auto *row_buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  storage::ProjectedRow *row = initializer.InitializeRow(row_buffer);
+  auto *txn = new transaction::TransactionContext(transaction::timestamp_t(0), transaction::timestamp_t(0),
+                                                  common::ManagedPointer(&buffer_pool_), DISABLED);
+
+  // Tuple i has the key i % 3 * 100, so that the tuples of the three ranges are interleaved
+  std::vector<storage::TupleSlot> slots;
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    for (uint16_t j = 0; j < row->NumColumns(); j++) {
+      *reinterpret_cast<int64_t *>(row->AccessForceNotNull(j)) = row->ColumnIds()[j] == key_col ? i % 3 * 100 : i;
+    }
+    slots.push_back(table.Insert(common::ManagedPointer(txn), *row));
+  }
+  // Null keys go to the first range
+  for (uint16_t j = 0; j < row->NumColumns(); j++) {
+    if (row->ColumnIds()[j] == key_col) row->SetNull(j);
+  }
+  const storage::TupleSlot null_slot = table.Insert(common::ManagedPointer(txn), *row);
+  EXPECT_EQ(null_slot.GetBlock(), slots[0].GetBlock());
+
+  std::unordered_map<storage::RawBlock *, uint32_t> range_of_block;
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    const uint32_t range = i % 3;
+    const auto it = range_of_block.emplace(slots[i].GetBlock(), range).first;
+    EXPECT_EQ(it->second, range);
+    for (uint32_t other = 0; other < 3; other++) {
+      const auto key = static_cast<int64_t>(other * 100);
+      EXPECT_EQ(table.BlockMayContain(slots[i].GetBlock(), key_col, key, key + 99), other == range);
+    }
+  }
+  // Every range filled a block of its own, and none had to move on to a second one yet
+  EXPECT_EQ(range_of_block.size(), 3);
+
+  // Once the block of a range is full, its tuples go to a new block
+  for (uint16_t j = 0; j < row->NumColumns(); j++) *reinterpret_cast<int64_t *>(row->AccessForceNotNull(j)) = 150;
+  const uint32_t num_in_range = (num_tuples + 1) / 3;
+  std::unordered_set<storage::RawBlock *> blocks;
+  for (uint32_t i = num_in_range; i <= layout.NumSlots(); i++) {
+    blocks.insert(table.Insert(common::ManagedPointer(txn), *row).GetBlock());
+  }
+  EXPECT_EQ(blocks.size(), 2);
+  EXPECT_EQ(table.GetBlocks().size(), 4);
+
+  delete txn;
+  delete[] row_buffer;
+}
 }  // namespace noisepage
@@ -1,8 +1,12 @@
+#include <fcntl.h>
+
 #include <fstream>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "common/hash_util.h"
+#include "common/posix_io_wrappers.h"
 #include "storage/arrow_serializer.h"
 #include "storage/block_access_controller.h"
 #include "storage/block_compactor.h"
@@ -368,4 +372,96 @@ TEST_F(ExportTableTest, ExportVarlenTableTest) {
   gc.PerformGarbageCollection();  // Second call to deallocate.
 }
 
+// A block that is not frozen is materialized with the exporting transaction. The stream goes to a file descriptor,
+// which could just as well be a socket.
+// NOLINTNEXTLINE
+TEST_F(ExportTableTest, ExportHotTableTest) {
+  unlink(EXPORT_TEST_EXPORT_TABLE_NAME);
+  unlink(EXPORT_TEST_CSV_TABLE_NAME);
+  unlink(EXPORT_TEST_PYSCRIPT_NAME);
+  std::ofstream outfile(EXPORT_TEST_PYSCRIPT_NAME, std::ios_base::out);
+  outfile << EXPORT_TEST_PYSCRIPT;
+  outfile.close();
+  // Columns are ordered by size, so the varlen column comes first
+  storage::BlockLayout layout({8, 8, storage::VARLEN_COLUMN});
+  const storage::col_id_t varlen_col(1), int_col(2);
+  storage::DataTable table(common::ManagedPointer<storage::BlockStore>(&block_store_), layout,
+                           storage::layout_version_t(0));
+  transaction::TimestampManager timestamp_manager;
+  transaction::DeferredActionManager deferred_action_manager{common::ManagedPointer(&timestamp_manager)};
+  transaction::TransactionManager txn_manager{common::ManagedPointer(&timestamp_manager),
+                                              common::ManagedPointer(&deferred_action_manager),
+                                              common::ManagedPointer(&buffer_pool_),
+                                              true,
+                                              false,
+                                              DISABLED};
+  storage::GarbageCollector gc{common::ManagedPointer(&timestamp_manager),
+                               common::ManagedPointer(&deferred_action_manager), common::ManagedPointer(&txn_manager),
+                               DISABLED};
+
+  // Some values are inlined, the others point to the strings
+  const uint32_t num_tuples = 100;
+  std::vector<std::string> values;
+  for (uint32_t i = 0; i < num_tuples; i++)
+    values.push_back((i % 2 == 0 ? "value-" : "a-much-longer-value-") + std::to_string(i));
+  auto initializer = storage::ProjectedRowInitializer::Create(layout, {varlen_col, int_col});
+  byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  auto *row = initializer.InitializeRow(buffer);
+  const uint16_t varlen_index = row->ColumnIds()[0] == varlen_col ? 0 : 1;
+  std::vector<storage::TupleSlot> slots;
+  auto *txn = txn_manager.BeginTransaction();
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    if (i % 10 == 0) {
+      row->SetNull(varlen_index);
+    } else {
+      *reinterpret_cast<storage::VarlenEntry *>(row->AccessForceNotNull(varlen_index)) =
+          storage::VarlenEntry::Create(values[i]);
+    }
+    *reinterpret_cast<int64_t *>(row->AccessForceNotNull(1 - varlen_index)) = i;
+    slots.push_back(table.Insert(common::ManagedPointer(txn), *row));
+  }
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(table.Delete(common::ManagedPointer(txn), slots[5]));
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  std::vector<type::TypeId> column_types(layout.NumColumns());
+  column_types[varlen_col.UnderlyingValue()] = type::TypeId::VARCHAR;
+  column_types[int_col.UnderlyingValue()] = type::TypeId::BIGINT;
+  auto &arrow_metadata = storage::TupleAccessStrategy(layout).GetArrowBlockMetadata(slots[0].GetBlock());
+  arrow_metadata.GetColumnInfo(layout, varlen_col).Type() = storage::ArrowColumnType::GATHERED_VARLEN;
+  arrow_metadata.GetColumnInfo(layout, int_col).Type() = storage::ArrowColumnType::FIXED_LENGTH;
+
+  // A tuple inserted after the export began is not exported
+  auto *export_txn = txn_manager.BeginTransaction();
+  txn = txn_manager.BeginTransaction();
+  row->SetNull(varlen_index);
+  *reinterpret_cast<int64_t *>(row->AccessForceNotNull(1 - varlen_index)) = num_tuples;
+  table.Insert(common::ManagedPointer(txn), *row);
+  txn_manager.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  delete[] buffer;
+
+  storage::ArrowSerializer arrow_serializer(table);
+  const int fd = storage::PosixIoWrappers::Open(EXPORT_TEST_EXPORT_TABLE_NAME, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  storage::ArrowIpcFdSink sink(fd);
+  arrow_serializer.ExportTable(&sink, &column_types, common::ManagedPointer(export_txn));
+  storage::PosixIoWrappers::Close(fd);
+  txn_manager.Commit(export_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  EXPECT_EQ(system((std::string("python3 ") + EXPORT_TEST_PYSCRIPT_NAME).c_str()), 0);
+
+  std::ifstream csv_file(EXPORT_TEST_CSV_TABLE_NAME, std::ios_base::in);
+  std::string line;
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    if (i == 5) continue;
+    ASSERT_TRUE(std::getline(csv_file, line));
+    EXPECT_EQ(line, (i % 10 == 0 ? "" : "b'" + values[i] + "'") + "," + std::to_string(i));
+  }
+  EXPECT_FALSE(std::getline(csv_file, line));
+  csv_file.close();
+  unlink(EXPORT_TEST_EXPORT_TABLE_NAME);
+
+  gc.PerformGarbageCollection();
+  gc.PerformGarbageCollection();  // Second call to deallocate.
+}
+
 }  // namespace noisepage
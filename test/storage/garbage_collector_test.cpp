@@ -1,14 +1,21 @@
 #include "storage/garbage_collector.h"
 
+#include <atomic>
 #include <cstring>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "common/object_pool.h"
 #include "main/db_main.h"
+#include "parser/expression/column_value_expression.h"
 #include "storage/data_table.h"
+#include "storage/index/index.h"
+#include "storage/index/index_builder.h"
+#include "storage/sql_table.h"
 #include "storage/storage_util.h"
+#include "test_util/catalog_test_util.h"
 #include "test_util/data_table_test_util.h"
 #include "test_util/storage_test_util.h"
 #include "test_util/test_harness.h"
@@ -70,6 +77,15 @@ class GarbageCollectorDataTableTestObject {
     return select_row;
   }
 
+  uint32_t VersionChainLength(const storage::TupleSlot slot) const {
+    const storage::TupleAccessStrategy accessor(layout_);
+    auto *const version_ptr = reinterpret_cast<std::atomic<storage::UndoRecord *> *>(
+        accessor.AccessWithoutNullCheck(slot, storage::VERSION_POINTER_COLUMN_ID));
+    uint32_t length = 0;
+    for (storage::UndoRecord *record = version_ptr->load(); record != nullptr; record = record->Next()) length++;
+    return length;
+  }
+
   storage::BlockLayout layout_;
   storage::DataTable table_;
   // We want null_bias_ to be zero when testing CC. We already evaluate null correctness in other directed tests, and
@@ -699,4 +715,336 @@ TEST_F(GarbageCollectorTests, InsertUpdate1) {
     EXPECT_EQ(std::make_pair(2U, 0U), gc->PerformGarbageCollection());
   }
 }
+
+// Readers that walk a long version chain and writers installing a new version prune the versions that no running
+// transaction can see anymore, without waiting for the GC.
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, InlinePruning) {
+  for (uint32_t iteration = 0; iteration < num_iterations_; ++iteration) {
+    auto db_main = DBMain::Builder().SetUseGC(true).Build();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    auto timestamp_manager = db_main->GetTransactionLayer()->GetTimestampManager();
+    auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+    GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_,
+                                               &generator_);
+
+    auto *insert_tuple = tested.GenerateRandomTuple(&generator_);
+    auto *txn = txn_manager->BeginTransaction();
+    storage::TupleSlot slot = tested.table_.Insert(common::ManagedPointer(txn), *insert_tuple);
+    txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // The reader keeps all updates from here on visible
+    auto *reader = txn_manager->BeginTransaction();
+    const uint32_t num_updates = 10;
+    for (uint32_t i = 0; i < num_updates; i++) {
+      txn = txn_manager->BeginTransaction();
+      EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn), slot, *tested.GenerateRandomUpdate(&generator_)));
+      txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    }
+    EXPECT_EQ(num_updates + 1, tested.VersionChainLength(slot));
+
+    // Only the Insert's UndoRecord is older than the reader, who prunes it while walking past the updates
+    timestamp_manager->OldestTransactionStartTime();
+    storage::ProjectedRow *select_tuple = tested.SelectIntoBuffer(reader, slot);
+    EXPECT_TRUE(tested.select_result_);
+    EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, insert_tuple));
+    EXPECT_EQ(num_updates, tested.VersionChainLength(slot));
+    txn_manager->Commit(reader, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // Without any running transaction, the next writer prunes everything below its own version
+    timestamp_manager->OldestTransactionStartTime();
+    txn = txn_manager->BeginTransaction();
+    EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn), slot, *tested.GenerateRandomUpdate(&generator_)));
+    EXPECT_EQ(1U, tested.VersionChainLength(slot));
+    txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    // The GC still unlinks and deallocates every transaction
+    EXPECT_EQ(std::make_pair(0U, num_updates + 3), gc->PerformGarbageCollection());
+    EXPECT_EQ(std::make_pair(num_updates + 2, 0U), gc->PerformGarbageCollection());
+  }
+}
+
+// A transaction declared read-only commits without a commit timestamp and is deallocated right away, same as any
+// other read-only transaction.
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, DeclaredReadOnly) {
+  for (uint32_t iteration = 0; iteration < num_iterations_; ++iteration) {
+    auto db_main = DBMain::Builder().SetUseGC(true).Build();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    auto timestamp_manager = db_main->GetTransactionLayer()->GetTimestampManager();
+    auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+    GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_,
+                                               &generator_);
+
+    auto *insert_tuple = tested.GenerateRandomTuple(&generator_);
+    auto *txn = txn_manager->BeginTransaction();
+    storage::TupleSlot slot = tested.table_.Insert(common::ManagedPointer(txn), *insert_tuple);
+    txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    auto *reader = txn_manager->BeginTransaction(true);
+    EXPECT_TRUE(reader->IsDeclaredReadOnly());
+    storage::ProjectedRow *select_tuple = tested.SelectIntoBuffer(reader, slot);
+    EXPECT_TRUE(tested.select_result_);
+    EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, insert_tuple));
+
+    const transaction::timestamp_t time = timestamp_manager->CurrentTime();
+    EXPECT_EQ(reader->StartTime(), txn_manager->Commit(reader, transaction::TransactionUtil::EmptyCallback, nullptr));
+    EXPECT_EQ(time, timestamp_manager->CurrentTime());
+
+    // Unlink both txns, then deallocate the Insert
+    EXPECT_EQ(std::make_pair(0U, 2U), gc->PerformGarbageCollection());
+    EXPECT_EQ(std::make_pair(1U, 0U), gc->PerformGarbageCollection());
+  }
+}
+
+// The GC counts the tuples modified by committed transactions as it unlinks them, and skips aborted transactions.
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, NumModifications) {
+  auto db_main = DBMain::Builder().SetUseGC(true).Build();
+  auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+  auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+  GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_,
+                                             &generator_);
+  EXPECT_EQ(0U, tested.table_.GetNumModifications());
+
+  auto *txn = txn_manager->BeginTransaction();
+  storage::TupleSlot slot = tested.table_.Insert(common::ManagedPointer(txn), *tested.GenerateRandomTuple(&generator_));
+  tested.table_.Insert(common::ManagedPointer(txn), *tested.GenerateRandomTuple(&generator_));
+  txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // Nothing is counted until the GC unlinks the transaction
+  EXPECT_EQ(0U, tested.table_.GetNumModifications());
+  gc->PerformGarbageCollection();
+  EXPECT_EQ(2U, tested.table_.GetNumModifications());
+
+  txn = txn_manager->BeginTransaction();
+  EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn), slot, *tested.GenerateRandomUpdate(&generator_)));
+  txn_manager->Abort(txn);
+  gc->PerformGarbageCollection();
+  EXPECT_EQ(2U, tested.table_.GetNumModifications());
+
+  txn = txn_manager->BeginTransaction();
+  EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn), slot, *tested.GenerateRandomUpdate(&generator_)));
+  EXPECT_TRUE(tested.table_.Delete(common::ManagedPointer(txn), slot));
+  txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  gc->PerformGarbageCollection();
+  gc->PerformGarbageCollection();
+  EXPECT_EQ(4U, tested.table_.GetNumModifications());
+}
+
+// Updates of a tuple that a transaction already updated reuse its UndoRecord, and older readers and aborts still see
+// the version from before the transaction.
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, CoalesceRepeatedUpdates) {
+  for (uint32_t iteration = 0; iteration < num_iterations_; ++iteration) {
+    auto db_main = DBMain::Builder().SetUseGC(true).Build();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+    GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_,
+                                               &generator_);
+
+    auto *insert_tuple = tested.GenerateRandomTuple(&generator_);
+    auto *txn = txn_manager->BeginTransaction();
+    storage::TupleSlot slot = tested.table_.Insert(common::ManagedPointer(txn), *insert_tuple);
+    txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    auto *reader = txn_manager->BeginTransaction();
+    txn = txn_manager->BeginTransaction();
+    storage::ProjectedRow *update = tested.GenerateRandomUpdate(&generator_);
+    EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn), slot, *update));
+    const uint32_t chain_length = tested.VersionChainLength(slot);
+    storage::ProjectedRow *expected = tested.GenerateVersionFromUpdate(*update, *insert_tuple);
+    for (uint32_t i = 0; i < 10; i++) {
+      // Same attributes, new values
+      StorageTestUtil::PopulateRandomRow(update, tested.Layout(), 0, &generator_);
+      EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn), slot, *update));
+      expected = tested.GenerateVersionFromUpdate(*update, *expected);
+    }
+    EXPECT_EQ(chain_length, tested.VersionChainLength(slot));
+
+    storage::ProjectedRow *select_tuple = tested.SelectIntoBuffer(txn, slot);
+    EXPECT_TRUE(tested.select_result_);
+    EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, expected));
+    select_tuple = tested.SelectIntoBuffer(reader, slot);
+    EXPECT_TRUE(tested.select_result_);
+    EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, insert_tuple));
+
+    // Rolling back the one UndoRecord restores the tuple from before all the updates
+    txn_manager->Abort(txn);
+    txn_manager->Commit(reader, transaction::TransactionUtil::EmptyCallback, nullptr);
+    txn = txn_manager->BeginTransaction();
+    select_tuple = tested.SelectIntoBuffer(txn, slot);
+    EXPECT_TRUE(tested.select_result_);
+    EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, insert_tuple));
+    txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    gc->PerformGarbageCollection();
+    gc->PerformGarbageCollection();
+  }
+}
+
+// A row lock keeps other transactions from writing the tuple until it is released, and then never conflicts with them,
+// without changing the tuple or counting as a modification.
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, RowLock) {
+  auto db_main = DBMain::Builder().SetUseGC(true).Build();
+  auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+  auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+  GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_,
+                                             &generator_);
+  auto *insert_tuple = tested.GenerateRandomTuple(&generator_);
+  auto *txn = txn_manager->BeginTransaction();
+  storage::TupleSlot slot = tested.table_.Insert(common::ManagedPointer(txn), *insert_tuple);
+  txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  auto *locker = txn_manager->BeginTransaction();
+  EXPECT_TRUE(tested.table_.Lock(common::ManagedPointer(locker), slot));
+  // Locking the tuple again takes no further lock
+  EXPECT_TRUE(tested.table_.Lock(common::ManagedPointer(locker), slot));
+
+  // Writers conflict with the lock, and readers do not see it
+  auto *writer = txn_manager->BeginTransaction();
+  EXPECT_FALSE(tested.table_.Update(common::ManagedPointer(writer), slot, *tested.GenerateRandomUpdate(&generator_)));
+  storage::ProjectedRow *select_tuple = tested.SelectIntoBuffer(writer, slot);
+  EXPECT_TRUE(tested.select_result_);
+  EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, insert_tuple));
+  txn_manager->Abort(writer);
+
+  // A transaction that started while the lock was held can write once it is released
+  writer = txn_manager->BeginTransaction();
+  txn_manager->Commit(locker, transaction::TransactionUtil::EmptyCallback, nullptr);
+  auto *update = tested.GenerateRandomUpdate(&generator_);
+  EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(writer), slot, *update));
+  txn_manager->Commit(writer, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  txn = txn_manager->BeginTransaction();
+  select_tuple = tested.SelectIntoBuffer(txn, slot);
+  EXPECT_TRUE(tested.select_result_);
+  EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple,
+                                                          tested.GenerateVersionFromUpdate(*update, *insert_tuple)));
+  txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  gc->PerformGarbageCollection();
+  gc->PerformGarbageCollection();
+  // The insert and the update
+  EXPECT_EQ(2U, tested.table_.GetNumModifications());
+}
+
+// Delete every tuple of a table, and confirm that inserts fill the freed slots instead of growing the table.
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, ReuseFreedSlots) {
+  auto db_main = DBMain::Builder().SetUseGC(true).Build();
+  auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+  auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+  GarbageCollectorDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_,
+                                             &generator_);
+  const uint32_t num_tuples = 2 * tested.Layout().NumSlots();
+  auto *const tuple = tested.GenerateRandomTuple(&generator_);
+
+  auto *txn = txn_manager->BeginTransaction();
+  std::vector<storage::TupleSlot> slots;
+  for (uint32_t i = 0; i < num_tuples; i++) slots.push_back(tested.table_.Insert(common::ManagedPointer(txn), *tuple));
+  txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  const uint32_t num_blocks = tested.table_.GetNumBlocks();
+
+  txn = txn_manager->BeginTransaction();
+  for (const auto &slot : slots) EXPECT_TRUE(tested.table_.Delete(common::ManagedPointer(txn), slot));
+  txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  // Slots are freed once the deletes are unlinked
+  EXPECT_EQ(0U, tested.table_.GetNumFreeSlots());
+  gc->PerformGarbageCollection();
+  gc->PerformGarbageCollection();
+  EXPECT_EQ(num_tuples, tested.table_.GetNumFreeSlots());
+
+  txn = txn_manager->BeginTransaction();
+  std::unordered_set<storage::TupleSlot> reused;
+  for (uint32_t i = 0; i < num_tuples; i++) {
+    const storage::TupleSlot slot = tested.table_.Insert(common::ManagedPointer(txn), *tuple);
+    EXPECT_TRUE(reused.insert(slot).second);
+    storage::ProjectedRow *select_tuple = tested.SelectIntoBuffer(txn, slot);
+    EXPECT_TRUE(tested.select_result_);
+    EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, tuple));
+  }
+  txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  EXPECT_EQ(num_blocks, tested.table_.GetNumBlocks());
+  EXPECT_EQ(0U, tested.table_.GetNumFreeSlots());
+  gc->PerformGarbageCollection();
+  gc->PerformGarbageCollection();
+}
+
+// Delete a row, and insert another one while the index delete that the first transaction deferred is still pending.
+// The deleted row's slot must not be filled before the index forgets the old key, or the old key finds the new row.
+// NOLINTNEXTLINE
+TEST_F(GarbageCollectorTests, ReclaimSlotAfterIndexDelete) {
+  auto db_main = DBMain::Builder().SetUseGC(true).Build();
+  auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+  auto deferred_action_manager = db_main->GetTransactionLayer()->GetDeferredActionManager();
+  auto gc = db_main->GetStorageLayer()->GetGarbageCollector();
+
+  auto col = catalog::Schema::Column("attribute", type::TypeId::INTEGER, false,
+                                     parser::ConstantValueExpression(type::TypeId::INTEGER));
+  StorageTestUtil::ForceOid(&(col), catalog::col_oid_t(1));
+  const catalog::Schema table_schema({col});
+  storage::SqlTable table(db_main->GetStorageLayer()->GetBlockStore(), table_schema);
+  const storage::ProjectedRowInitializer row_initializer = table.InitializerForProjectedRow({catalog::col_oid_t(1)});
+
+  std::vector<catalog::IndexSchema::Column> keycols;
+  keycols.emplace_back("", type::TypeId::INTEGER, false,
+                       parser::ColumnValueExpression(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID,
+                                                     catalog::col_oid_t(1)));
+  StorageTestUtil::ForceOid(&(keycols[0]), catalog::indexkeycol_oid_t(1));
+  const catalog::IndexSchema index_schema(keycols, storage::index::IndexType::BPLUSTREE, true, true, false, true);
+  std::unique_ptr<storage::index::Index> index(storage::index::IndexBuilder().SetKeySchema(index_schema).Build());
+  auto *const key_buffer =
+      common::AllocationUtil::AllocateAligned(index->GetProjectedRowInitializer().ProjectedRowSize());
+  auto *const key = index->GetProjectedRowInitializer().InitializeRow(key_buffer);
+
+  // Inserts a row into the table, and its key into the unique index
+  const auto insert = [&](transaction::TransactionContext *const txn, const int32_t value) {
+    auto *const redo = txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, row_initializer);
+    *reinterpret_cast<int32_t *>(redo->Delta()->AccessForceNotNull(0)) = value;
+    const storage::TupleSlot slot = table.Insert(common::ManagedPointer(txn), redo);
+    *reinterpret_cast<int32_t *>(key->AccessForceNotNull(0)) = value;
+    EXPECT_TRUE(index->InsertUnique(common::ManagedPointer(txn), *key, slot));
+    return slot;
+  };
+
+  auto *txn = txn_manager->BeginTransaction();
+  const storage::TupleSlot old_slot = insert(txn, 1);
+  txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  txn = txn_manager->BeginTransaction();
+  txn->StageDelete(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, old_slot);
+  EXPECT_TRUE(table.Delete(common::ManagedPointer(txn), old_slot));
+  *reinterpret_cast<int32_t *>(key->AccessForceNotNull(0)) = 1;
+  index->Delete(common::ManagedPointer(txn), *key, old_slot);
+  txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // The reader is newer than the delete, so the delete is unlinked, but it holds back the deferred index delete
+  auto *const reader = txn_manager->BeginTransaction();
+  gc->PerformGarbageCollection();
+
+  txn = txn_manager->BeginTransaction();
+  EXPECT_NE(old_slot, insert(txn, 2));
+  txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // The old key finds nothing, and can be inserted again
+  txn = txn_manager->BeginTransaction();
+  std::vector<storage::TupleSlot> results;
+  *reinterpret_cast<int32_t *>(key->AccessForceNotNull(0)) = 1;
+  index->ScanKey(*txn, *key, &results);
+  EXPECT_TRUE(results.empty());
+  insert(txn, 1);
+  txn_manager->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  txn_manager->Commit(reader, transaction::TransactionUtil::EmptyCallback, nullptr);
+  deferred_action_manager->FullyPerformGC(gc, DISABLED);
+  delete[] key_buffer;
+}
 }  // namespace noisepage
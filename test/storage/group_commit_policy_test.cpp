@@ -0,0 +1,99 @@
+#include "storage/write_ahead_log/group_commit_policy.h"
+
+#include <chrono>  // NOLINT
+
+#include "gtest/gtest.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::storage {
+
+class GroupCommitPolicyTests : public TerrierTest {
+ protected:
+  static constexpr std::chrono::microseconds MAX_DELAY{100};
+  static constexpr uint64_t BYTE_THRESHOLD = 1 << 20;
+  const GroupCommitPolicy::Clock::time_point start_ = GroupCommitPolicy::Clock::now();
+
+  GroupCommitPolicy::Clock::time_point At(const uint64_t micros) const {
+    return start_ + std::chrono::microseconds(micros);
+  }
+};
+
+// Without any observed load, commits are persisted right away
+// NOLINTNEXTLINE
+TEST_F(GroupCommitPolicyTests, NoDelayWithoutHistory) {
+  GroupCommitPolicy policy(MAX_DELAY, BYTE_THRESHOLD);
+  EXPECT_FALSE(policy.ShouldPersist(0, At(0)));
+
+  policy.CommitsArrived(1, At(0));
+  EXPECT_EQ(policy.PendingCommits(), 1);
+  EXPECT_EQ(policy.Delay(), std::chrono::microseconds(0));
+  EXPECT_TRUE(policy.ShouldPersist(100, At(0)));
+  EXPECT_EQ(policy.TimeUntilDeadline(At(0)), std::chrono::microseconds(0));
+
+  policy.Persisted(100, std::chrono::microseconds(50));
+  EXPECT_EQ(policy.PendingCommits(), 0);
+  EXPECT_FALSE(policy.ShouldPersist(0, At(0)));
+}
+
+// At high load, commits are held back for about one fsync so that they can share it
+// NOLINTNEXTLINE
+TEST_F(GroupCommitPolicyTests, DelayAtHighLoad) {
+  GroupCommitPolicy policy(MAX_DELAY, BYTE_THRESHOLD);
+  // A commit arrives every 10us, and an fsync takes 50us
+  uint64_t now = 0;
+  for (uint32_t i = 0; i < 10; i++, now += 10) {
+    policy.CommitsArrived(1, At(now));
+    policy.Persisted(100, std::chrono::microseconds(50));
+  }
+
+  policy.CommitsArrived(1, At(now));
+  EXPECT_EQ(policy.Delay(), std::chrono::microseconds(50));
+  EXPECT_FALSE(policy.ShouldPersist(100, At(now)));
+  EXPECT_EQ(policy.TimeUntilDeadline(At(now + 20)), std::chrono::microseconds(30));
+
+  // More commits join the group, but the deadline is set by the first one
+  policy.CommitsArrived(3, At(now + 30));
+  EXPECT_EQ(policy.PendingCommits(), 4);
+  EXPECT_FALSE(policy.ShouldPersist(400, At(now + 30)));
+  EXPECT_TRUE(policy.ShouldPersist(400, At(now + 50)));
+  EXPECT_EQ(policy.TimeUntilDeadline(At(now + 60)), std::chrono::microseconds(0));
+
+  // The byte threshold always triggers a persist
+  EXPECT_TRUE(policy.ShouldPersist(BYTE_THRESHOLD + 1, At(now + 30)));
+}
+
+// The delay never exceeds the maximum delay, even if fsyncs are slow
+// NOLINTNEXTLINE
+TEST_F(GroupCommitPolicyTests, DelayIsCapped) {
+  GroupCommitPolicy policy(MAX_DELAY, BYTE_THRESHOLD);
+  uint64_t now = 0;
+  for (uint32_t i = 0; i < 10; i++, now += 10) {
+    policy.CommitsArrived(1, At(now));
+    policy.Persisted(100, std::chrono::microseconds(5000));
+  }
+  policy.CommitsArrived(1, At(now));
+  EXPECT_EQ(policy.Delay(), MAX_DELAY);
+}
+
+// Once the load drops, commits stop being held back
+// NOLINTNEXTLINE
+TEST_F(GroupCommitPolicyTests, NoDelayAtLowLoad) {
+  GroupCommitPolicy policy(MAX_DELAY, BYTE_THRESHOLD);
+  uint64_t now = 0;
+  for (uint32_t i = 0; i < 10; i++, now += 10) {
+    policy.CommitsArrived(1, At(now));
+    policy.Persisted(100, std::chrono::microseconds(50));
+  }
+  // A commit arrives every 1ms
+  for (uint32_t i = 0; i < 10; i++) {
+    now += 1000;
+    policy.CommitsArrived(1, At(now));
+    policy.Persisted(100, std::chrono::microseconds(50));
+  }
+  now += 1000;
+  policy.CommitsArrived(1, At(now));
+  EXPECT_EQ(policy.Delay(), std::chrono::microseconds(0));
+  EXPECT_TRUE(policy.ShouldPersist(100, At(now)));
+}
+
+}  // namespace noisepage::storage
@@ -4,6 +4,8 @@
 #include <limits>
 #include <map>
 #include <random>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "catalog/index_schema.h"
@@ -1278,4 +1280,63 @@ TEST_F(IndexKeyTests, GenericKeyBuilderVarlenSizeEdgeCaseTest) {
   delete index;
 }
 
+/**
+ * Composite keys whose first attribute shares a long prefix must order the same with and without the normalized prefix
+ * deciding the comparison, so compare the functors against a reference order of the values.
+ */
+// NOLINTNEXTLINE
+TEST_F(IndexKeyTests, GenericKeyNormalizedPrefixComparisons) {
+  std::vector<catalog::IndexSchema::Column> key_cols;
+  key_cols.emplace_back("", type::TypeId::VARCHAR, 24, true, parser::ConstantValueExpression(type::TypeId::VARCHAR));
+  StorageTestUtil::ForceOid(&(key_cols.back()), catalog::indexkeycol_oid_t(0));
+  key_cols.emplace_back("", type::TypeId::INTEGER, true, parser::ConstantValueExpression(type::TypeId::INTEGER));
+  StorageTestUtil::ForceOid(&(key_cols.back()), catalog::indexkeycol_oid_t(1));
+
+  const IndexMetadata metadata(
+      catalog::IndexSchema(key_cols, storage::index::IndexType::BPLUSTREE, false, false, false, true));
+  const auto &initializer = metadata.GetProjectedRowInitializer();
+  auto *const pr_buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+  auto *const pr = initializer.InitializeRow(pr_buffer);
+  const uint16_t varchar_offset = metadata.GetKeyOidToOffsetMap().at(catalog::indexkeycol_oid_t(0));
+  const uint16_t integer_offset = metadata.GetKeyOidToOffsetMap().at(catalog::indexkeycol_oid_t(1));
+
+  // An empty string stands for NULL, which orders first just like it
+  using Reference = std::pair<std::string, int32_t>;
+  const std::vector<std::string> prefixes = {"", "a", "abc", "abcdefg", "abcdefgh", std::string("ab\0cdefgh", 9)};
+  std::uniform_int_distribution<uint32_t> suffix_length(0, 4);
+  std::uniform_int_distribution<int32_t> integer(-3, 3);
+
+  std::vector<GenericKey<128>> keys(500);
+  std::vector<Reference> references;
+  for (auto &key : keys) {
+    std::string value = prefixes[generator_() % prefixes.size()];
+    if (!value.empty()) {
+      for (uint32_t i = suffix_length(generator_); i > 0; i--) value.push_back("\0az"[generator_() % 3]);
+    }
+    const int32_t number = integer(generator_);
+
+    if (value.empty()) {
+      pr->SetNull(varchar_offset);
+    } else {
+      // the key copies the content, so the entry may point into the string
+      *reinterpret_cast<VarlenEntry *>(pr->AccessForceNotNull(varchar_offset)) = VarlenEntry::Create(value);
+    }
+    *reinterpret_cast<int32_t *>(pr->AccessForceNotNull(integer_offset)) = number;
+    key.SetFromProjectedRow(*pr, metadata, 2);
+    references.emplace_back(value, number);
+  }
+
+  const auto generic_eq128 = std::equal_to<GenericKey<128>>();  // NOLINT transparent functors can't figure out template
+  const auto generic_lt128 = std::less<GenericKey<128>>();      // NOLINT transparent functors can't figure out template
+  for (uint32_t i = 0; i < keys.size(); i++) {
+    for (uint32_t j = 0; j < keys.size(); j++) {
+      EXPECT_EQ(generic_lt128(keys[i], keys[j]), references[i] < references[j]);
+      EXPECT_EQ(generic_eq128(keys[i], keys[j]), references[i] == references[j]);
+      EXPECT_EQ(keys[i].PartialLessThan(keys[j], &metadata, 1), references[i].first <= references[j].first);
+    }
+  }
+
+  delete[] pr_buffer;
+}
+
 }  // namespace noisepage::storage::index
@@ -0,0 +1,76 @@
+#include "storage/write_ahead_log/log_compression.h"
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::storage {
+
+class LogCompressionTests : public TerrierTest {
+ protected:
+  std::default_random_engine generator_;
+
+  // Compresses the input, checks that it decompresses to the input again, and returns the compressed size
+  static uint32_t RoundTrip(const std::string &input) {
+    const auto size = static_cast<uint32_t>(input.size());
+    std::vector<char> compressed(LogCompression::MaxCompressedSize(size));
+    const auto compressed_size = LogCompression::Compress(input.data(), size, compressed.data());
+    EXPECT_LE(compressed_size, LogCompression::MaxCompressedSize(size));
+
+    std::string output(size, '\0');
+    LogCompression::Decompress(compressed.data(), compressed_size, output.data(), size);
+    EXPECT_EQ(input, output);
+    return compressed_size;
+  }
+};
+
+// Inputs without any redundancy survive the round trip and are not expanded beyond the bound
+// NOLINTNEXTLINE
+TEST_F(LogCompressionTests, RandomInput) {
+  std::uniform_int_distribution<int> byte_dist(0, UINT8_MAX);
+  for (const uint32_t size : {0, 1, 3, 4, 15, 16, 300, 4096, 100000}) {
+    std::string input(size, '\0');
+    for (auto &c : input) c = static_cast<char>(byte_dist(generator_));
+    RoundTrip(input);
+  }
+}
+
+// Repetitive inputs, including long runs and long literal sequences, shrink considerably
+// NOLINTNEXTLINE
+TEST_F(LogCompressionTests, RepetitiveInput) {
+  EXPECT_LT(RoundTrip(std::string(100000, 'a')), 1000);
+
+  std::string records;
+  std::uniform_int_distribution<uint32_t> value_dist(0, 9);
+  for (uint32_t i = 0; records.size() < 100000; i++) {
+    records += "REDO|db=1|table=1001|cols=0,1,2,3|";
+    records += std::to_string(value_dist(generator_));
+    records += "|";
+  }
+  EXPECT_LT(RoundTrip(records), records.size() / 4);
+}
+
+// Malformed input is rejected instead of writing past the output
+// NOLINTNEXTLINE
+TEST_F(LogCompressionTests, MalformedInput) {
+  const std::string input(1000, 'a');
+  std::vector<char> compressed(LogCompression::MaxCompressedSize(input.size()));
+  const auto compressed_size = LogCompression::Compress(input.data(), input.size(), compressed.data());
+
+  std::string output(input.size(), '\0');
+  // Wrong decompressed size
+  EXPECT_THROW(LogCompression::Decompress(compressed.data(), compressed_size, output.data(), input.size() - 1),
+               std::runtime_error);
+  // Truncated input
+  EXPECT_THROW(LogCompression::Decompress(compressed.data(), compressed_size - 1, output.data(), input.size()),
+               std::runtime_error);
+  // A match that reaches before the start of the output
+  const char bad_offset[] = {0x10, 'a', 0x02, 0x00};
+  EXPECT_THROW(LogCompression::Decompress(bad_offset, sizeof(bad_offset), output.data(), 5), std::runtime_error);
+}
+
+}  // namespace noisepage::storage
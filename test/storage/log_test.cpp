@@ -11,6 +11,8 @@
 #include "storage/projected_row.h"
 #include "storage/sql_table.h"
 #include "storage/storage_defs.h"
+#include "storage/varlen_allocator.h"
+#include "storage/varlen_compression.h"
 #include "storage/write_ahead_log/log_manager.h"
 #include "test_util/catalog_test_util.h"
 #include "test_util/data_table_test_util.h"
@@ -58,6 +60,9 @@ class WriteAheadLoggingTests : public TerrierTest {
    */
   storage::LogRecord *ReadNextRecord(storage::BufferedLogReader *in) {
     auto size = in->ReadValue<uint32_t>();
+    if ((size & storage::LogRecord::NATIVE_FORMAT_FLAG) != 0) {
+      return ReadNativeRedoRecord(in, size & ~storage::LogRecord::NATIVE_FORMAT_FLAG);
+    }
     byte *buf = common::AllocationUtil::AllocateAligned(size);
     auto record_type = in->ReadValue<storage::LogRecordType>();
     auto txn_begin = in->ReadValue<transaction::timestamp_t>();
@@ -133,17 +138,26 @@ class WriteAheadLoggingTests : public TerrierTest {
       // The column is not null, so set the bitmap accordingly and get access to the column value.
       auto *column_value_address = delta->AccessForceNotNull(i);
       if (attr_sizes[i] == AttrSizeBytes(VARLEN_COLUMN)) {
-        // Read how many bytes this varlen actually is.
-        const auto varlen_attribute_size = in->ReadValue<uint32_t>();
+        // Read how many bytes this varlen actually is, and whether its content was compressed.
+        const auto serialized_size = in->ReadValue<uint32_t>();
+        const auto varlen_attribute_size = serialized_size & ~storage::VarlenCompression::COMPRESSED_FLAG;
         // Allocate a varlen buffer of this many bytes.
-        auto *varlen_attribute_content = common::AllocationUtil::AllocateAligned(varlen_attribute_size);
+        auto *varlen_attribute_content = storage::VarlenAllocator::Allocate(varlen_attribute_size);
         // Fill the entry with the next bytes from the log file.
-        in->Read(varlen_attribute_content, varlen_attribute_size);
+        if ((serialized_size & storage::VarlenCompression::COMPRESSED_FLAG) != 0) {
+          std::vector<byte> compressed(in->ReadValue<uint32_t>());
+          const auto compressed_size = static_cast<uint32_t>(compressed.size());
+          in->Read(compressed.data(), compressed_size);
+          EXPECT_TRUE(storage::VarlenCompression::Decompress(compressed.data(), compressed_size,
+                                                             varlen_attribute_content, varlen_attribute_size));
+        } else {
+          in->Read(varlen_attribute_content, varlen_attribute_size);
+        }
         // Create the varlen entry depending on whether it can be inlined or not
         storage::VarlenEntry varlen_entry;
         if (varlen_attribute_size <= storage::VarlenEntry::InlineThreshold()) {
           varlen_entry = storage::VarlenEntry::CreateInline(varlen_attribute_content, varlen_attribute_size);
-          delete[] varlen_attribute_content;
+          storage::VarlenAllocator::Deallocate(varlen_attribute_content);
         } else {
           varlen_entry = storage::VarlenEntry::Create(varlen_attribute_content, varlen_attribute_size, true);
         }
@@ -163,6 +177,36 @@ class WriteAheadLoggingTests : public TerrierTest {
     return result;
   }
 
+  // Redo records are written as their in-memory image, followed by the contents of their varlens that are not inlined
+  storage::LogRecord *ReadNativeRedoRecord(storage::BufferedLogReader *in, const uint32_t size) {
+    byte *buf = common::AllocationUtil::AllocateAligned(size);
+    in->Read(buf, size);
+    auto *result = reinterpret_cast<storage::LogRecord *>(buf);
+    EXPECT_EQ(storage::LogRecordType::REDO, result->RecordType());
+    EXPECT_EQ(size, result->Size());
+    auto *delta = result->GetUnderlyingRecordBodyAs<RedoRecord>()->Delta();
+
+    const auto num_out_of_line = in->ReadValue<uint16_t>();
+    for (uint16_t i = 0; i < num_out_of_line; i++) {
+      const auto col_idx = in->ReadValue<uint16_t>();
+      const auto serialized_size = in->ReadValue<uint32_t>();
+      const auto varlen_attribute_size = serialized_size & ~storage::VarlenCompression::COMPRESSED_FLAG;
+      auto *varlen_attribute_content = storage::VarlenAllocator::Allocate(varlen_attribute_size);
+      if ((serialized_size & storage::VarlenCompression::COMPRESSED_FLAG) != 0) {
+        std::vector<byte> compressed(in->ReadValue<uint32_t>());
+        const auto compressed_size = static_cast<uint32_t>(compressed.size());
+        in->Read(compressed.data(), compressed_size);
+        EXPECT_TRUE(storage::VarlenCompression::Decompress(compressed.data(), compressed_size,
+                                                           varlen_attribute_content, varlen_attribute_size));
+      } else {
+        in->Read(varlen_attribute_content, varlen_attribute_size);
+      }
+      *reinterpret_cast<storage::VarlenEntry *>(delta->AccessForceNotNull(col_idx)) =
+          storage::VarlenEntry::Create(varlen_attribute_content, varlen_attribute_size, true);
+    }
+    return result;
+  }
+
   storage::RedoBuffer &GetRedoBuffer(transaction::TransactionContext *txn) { return txn->redo_buffer_; }
 };
 
@@ -448,4 +492,34 @@ TEST_F(WriteAheadLoggingTests, ReadOnlyCallbackTest) {
   // DeferredAction
   db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete sql_table; });
 }
+
+// Verify that reserving disk space and starting writeback early do not change the contents of the log file
+// NOLINTNEXTLINE
+TEST_F(WriteAheadLoggingTests, PreallocatedLogFileTest) {
+  log_manager_->PersistAndStop();
+  unlink(LOG_TEST_LOG_FILE_NAME);
+
+  const uint64_t preallocation_size = 1 << 20;
+  const uint32_t num_values = 1000;
+  BufferedLogWriter out(LOG_TEST_LOG_FILE_NAME);
+  out.Preallocate(0, preallocation_size);
+  // The reserved space is not part of the log file
+  EXPECT_EQ(out.FileSize(), 0);
+
+  for (uint32_t i = 0; i < num_values; i++) {
+    EXPECT_EQ(out.BufferWrite(&i, sizeof(i)), sizeof(i));
+    if (i % 100 == 0) {
+      out.FlushBuffer();
+      out.StartWriteback();
+    }
+  }
+  out.FlushBuffer();
+  out.Persist();
+  EXPECT_EQ(out.FileSize(), num_values * sizeof(uint32_t));
+  out.Close();
+
+  BufferedLogReader in(LOG_TEST_LOG_FILE_NAME);
+  for (uint32_t i = 0; i < num_values; i++) EXPECT_EQ(in.ReadValue<uint32_t>(), i);
+  EXPECT_FALSE(in.HasMore());
+}
 }  // namespace noisepage::storage
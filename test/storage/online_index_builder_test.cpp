@@ -0,0 +1,208 @@
+#include "storage/index/online_index_builder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>  // NOLINT
+#include <random>
+#include <thread>  // NOLINT
+#include <utility>
+#include <vector>
+
+#include "catalog/schema.h"
+#include "parser/expression/column_value_expression.h"
+#include "parser/expression/constant_value_expression.h"
+#include "storage/garbage_collector.h"
+#include "storage/index/index.h"
+#include "storage/index/index_builder.h"
+#include "storage/sql_table.h"
+#include "test_util/catalog_test_util.h"
+#include "test_util/storage_test_util.h"
+#include "test_util/test_harness.h"
+#include "transaction/deferred_action_manager.h"
+#include "transaction/transaction_manager.h"
+
+namespace noisepage::storage::index {
+
+struct OnlineIndexBuilderTests : public TerrierTest {
+  storage::BlockStore block_store_{1000, 1000};
+  storage::RecordBufferSegmentPool buffer_pool_{1000000, 100000};
+  transaction::TimestampManager timestamp_manager_;
+  transaction::DeferredActionManager deferred_action_manager_{common::ManagedPointer(&timestamp_manager_)};
+  transaction::TransactionManager txn_manager_{common::ManagedPointer(&timestamp_manager_),
+                                               common::ManagedPointer(&deferred_action_manager_),
+                                               common::ManagedPointer(&buffer_pool_),
+                                               true,
+                                               false,
+                                               DISABLED};
+  storage::GarbageCollector gc_{common::ManagedPointer(&timestamp_manager_),
+                                common::ManagedPointer(&deferred_action_manager_),
+                                common::ManagedPointer(&txn_manager_), DISABLED};
+
+  catalog::Schema table_schema_;
+  storage::SqlTable *sql_table_;
+  storage::ProjectedRowInitializer tuple_initializer_ =
+      storage::ProjectedRowInitializer::Create(std::vector<uint16_t>{1}, std::vector<uint16_t>{1});
+
+  void SetUp() override {
+    auto col = catalog::Schema::Column("attribute", type::TypeId::INTEGER, false,
+                                       parser::ConstantValueExpression(type::TypeId::INTEGER));
+    StorageTestUtil::ForceOid(&(col), catalog::col_oid_t(1));
+    table_schema_ = catalog::Schema({col});
+    sql_table_ = new storage::SqlTable(common::ManagedPointer(&block_store_), table_schema_);
+    tuple_initializer_ = sql_table_->InitializerForProjectedRow({catalog::col_oid_t(1)});
+  }
+
+  void TearDown() override {
+    gc_.PerformGarbageCollection();
+    gc_.PerformGarbageCollection();  // Second call to deallocate.
+    delete sql_table_;
+  }
+
+  static catalog::IndexSchema KeySchema(const bool unique) {
+    std::vector<catalog::IndexSchema::Column> keycols;
+    keycols.emplace_back("", type::TypeId::INTEGER, false,
+                         parser::ColumnValueExpression(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID,
+                                                       catalog::col_oid_t(1)));
+    StorageTestUtil::ForceOid(&(keycols[0]), catalog::indexkeycol_oid_t(1));
+    return catalog::IndexSchema(keycols, storage::index::IndexType::BWTREE, unique, unique, false, true);
+  }
+
+  // Inserts a tuple with the given value, and its key into the index unless it is nullptr
+  storage::TupleSlot InsertTuple(transaction::TransactionContext *txn, const int32_t value, Index *index) {
+    auto *redo = txn->StageWrite(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, tuple_initializer_);
+    *reinterpret_cast<int32_t *>(redo->Delta()->AccessForceNotNull(0)) = value;
+    const storage::TupleSlot slot = sql_table_->Insert(common::ManagedPointer(txn), redo);
+    if (index != nullptr) {
+      byte *key_buffer = common::AllocationUtil::AllocateAligned(index->GetProjectedRowInitializer().ProjectedRowSize());
+      auto *key = index->GetProjectedRowInitializer().InitializeRow(key_buffer);
+      *reinterpret_cast<int32_t *>(key->AccessForceNotNull(0)) = value;
+      EXPECT_TRUE(index->Insert(common::ManagedPointer(txn), *key, slot));
+      delete[] key_buffer;
+    }
+    return slot;
+  }
+
+  // Checks that the index finds every visible tuple of the table under its value, and returns the number of them
+  uint32_t VerifyIndex(Index *index) {
+    auto *txn = txn_manager_.BeginTransaction();
+    byte *buffer = common::AllocationUtil::AllocateAligned(tuple_initializer_.ProjectedRowSize());
+    auto *row = tuple_initializer_.InitializeRow(buffer);
+    byte *key_buffer = common::AllocationUtil::AllocateAligned(index->GetProjectedRowInitializer().ProjectedRowSize());
+    auto *key = index->GetProjectedRowInitializer().InitializeRow(key_buffer);
+    uint32_t num_visible = 0;
+    std::vector<storage::TupleSlot> results;
+    for (auto it = sql_table_->begin(); it != sql_table_->end(); it++) {
+      if (!sql_table_->Select(common::ManagedPointer(txn), *it, row)) continue;
+      num_visible++;
+      const int32_t value = *reinterpret_cast<int32_t *>(row->AccessWithNullCheck(0));
+      *reinterpret_cast<int32_t *>(key->AccessForceNotNull(0)) = value;
+      results.clear();
+      index->ScanKey(*txn, *key, &results);
+      EXPECT_EQ(std::count(results.begin(), results.end(), *it), 1);
+    }
+    txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    delete[] key_buffer;
+    delete[] buffer;
+    return num_visible;
+  }
+};
+
+// Builds an index while a writer that began before it was published is still running, and others insert and delete
+// tuples and maintain the index themselves. The finished index holds exactly the visible tuples.
+// NOLINTNEXTLINE
+TEST_F(OnlineIndexBuilderTests, ConcurrentWrites) {
+  const int32_t num_initial = 20000;
+  const uint32_t num_writers = 3;
+  auto *txn = txn_manager_.BeginTransaction();
+  for (int32_t i = 0; i < num_initial; i++) InsertTuple(txn, i, nullptr);
+  txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  const catalog::IndexSchema schema = KeySchema(false);
+  Index *index = IndexBuilder().SetKeySchema(schema).Build();
+
+  // This writer does not know about the index, and commits while the build is waiting for it
+  auto *old_txn = txn_manager_.BeginTransaction();
+  for (int32_t i = 0; i < 100; i++) InsertTuple(old_txn, -i - 1, nullptr);
+
+  // The index is published from here on, so writers that begin now maintain it
+  std::atomic<bool> done = false;
+  auto writer = [&](const uint32_t id) {
+    std::default_random_engine generator(id);
+    std::vector<std::pair<storage::TupleSlot, int32_t>> inserted;
+    byte *key_buffer = common::AllocationUtil::AllocateAligned(index->GetProjectedRowInitializer().ProjectedRowSize());
+    auto *key = index->GetProjectedRowInitializer().InitializeRow(key_buffer);
+    for (int32_t value = num_initial + static_cast<int32_t>(id); !done; value += num_writers) {
+      auto *writer_txn = txn_manager_.BeginTransaction();
+      if (!inserted.empty() && std::bernoulli_distribution(0.3)(generator)) {
+        // Delete one of the tuples this writer inserted
+        const auto victim = inserted.back();
+        inserted.pop_back();
+        writer_txn->StageDelete(CatalogTestUtil::TEST_DB_OID, CatalogTestUtil::TEST_TABLE_OID, victim.first);
+        EXPECT_TRUE(sql_table_->Delete(common::ManagedPointer(writer_txn), victim.first));
+        *reinterpret_cast<int32_t *>(key->AccessForceNotNull(0)) = victim.second;
+        index->Delete(common::ManagedPointer(writer_txn), *key, victim.first);
+      } else {
+        inserted.emplace_back(InsertTuple(writer_txn, value, index), value);
+      }
+      txn_manager_.Commit(writer_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+    }
+    delete[] key_buffer;
+  };
+  std::vector<std::thread> writers;
+  for (uint32_t id = 0; id < num_writers; id++) writers.emplace_back(writer, id);
+  std::thread old_writer([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    txn_manager_.Commit(old_txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  });
+
+  OnlineIndexBuilder builder{common::ManagedPointer(&timestamp_manager_), common::ManagedPointer(&txn_manager_),
+                             common::ManagedPointer(sql_table_), common::ManagedPointer(index), schema};
+  EXPECT_TRUE(builder.Build(4));
+  done = true;
+  for (auto &thread : writers) thread.join();
+  old_writer.join();
+
+  const uint32_t num_visible = VerifyIndex(index);
+  EXPECT_GE(num_visible, num_initial + 100);
+  // Once the deferred deletes ran, the index holds nothing but the visible tuples
+  gc_.PerformGarbageCollection();
+  gc_.PerformGarbageCollection();
+  EXPECT_EQ(index->GetSize(), num_visible);
+  delete index;
+}
+
+// A build throttled to a share of the CPU pauses between batches, and still ends up with every tuple
+// NOLINTNEXTLINE
+TEST_F(OnlineIndexBuilderTests, Throttled) {
+  const int32_t num_tuples = 10000;
+  auto *txn = txn_manager_.BeginTransaction();
+  for (int32_t i = 0; i < num_tuples; i++) InsertTuple(txn, i, nullptr);
+  txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  const catalog::IndexSchema schema = KeySchema(false);
+  Index *index = IndexBuilder().SetKeySchema(schema).Build();
+  OnlineIndexBuilder builder{common::ManagedPointer(&timestamp_manager_), common::ManagedPointer(&txn_manager_),
+                             common::ManagedPointer(sql_table_), common::ManagedPointer(index), schema};
+  EXPECT_TRUE(builder.Build(2, 0.25));
+  EXPECT_EQ(VerifyIndex(index), num_tuples);
+  EXPECT_EQ(index->GetSize(), num_tuples);
+  delete index;
+}
+
+// A unique index over a column with duplicates cannot be built, and the failed build leaves no entries behind
+// NOLINTNEXTLINE
+TEST_F(OnlineIndexBuilderTests, UniqueViolation) {
+  auto *txn = txn_manager_.BeginTransaction();
+  for (int32_t i = 0; i < 1000; i++) InsertTuple(txn, i % 999, nullptr);
+  txn_manager_.Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  const catalog::IndexSchema schema = KeySchema(true);
+  Index *index = IndexBuilder().SetKeySchema(schema).Build();
+  OnlineIndexBuilder builder{common::ManagedPointer(&timestamp_manager_), common::ManagedPointer(&txn_manager_),
+                             common::ManagedPointer(sql_table_), common::ManagedPointer(index), schema};
+  EXPECT_FALSE(builder.Build(2));
+  EXPECT_EQ(index->GetSize(), 0);
+  delete index;
+}
+
+}  // namespace noisepage::storage::index
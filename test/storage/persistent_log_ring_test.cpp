@@ -0,0 +1,120 @@
+#include "storage/write_ahead_log/persistent_log_ring.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "common/posix_io_wrappers.h"
+#include "gtest/gtest.h"
+#include "test_util/test_harness.h"
+
+#define RING_TEST_RING_FILE_NAME "./test_persistent_log_ring_test.ring"
+#define RING_TEST_LOG_FILE_NAME "./test_persistent_log_ring_test.log"
+
+namespace noisepage::storage {
+
+class PersistentLogRingTests : public TerrierTest {
+ protected:
+  void SetUp() override {
+    unlink(RING_TEST_RING_FILE_NAME);
+    unlink(RING_TEST_LOG_FILE_NAME);
+  }
+
+  void TearDown() override {
+    unlink(RING_TEST_RING_FILE_NAME);
+    unlink(RING_TEST_LOG_FILE_NAME);
+  }
+
+  static void AppendToLog(const std::string &contents) {
+    std::ofstream log(RING_TEST_LOG_FILE_NAME, std::ios::binary | std::ios::app);
+    log << contents;
+  }
+
+  static std::string ReadLog() {
+    std::ifstream log(RING_TEST_LOG_FILE_NAME, std::ios::binary);
+    std::stringstream contents;
+    contents << log.rdbuf();
+    return contents.str();
+  }
+
+  static bool Append(PersistentLogRing *ring, const std::string &data) {
+    return ring->Append(data.data(), static_cast<uint32_t>(data.size()));
+  }
+};
+
+// The entries left in the ring by a crash replace whatever was written to the log file after the ring was reset
+// NOLINTNEXTLINE
+TEST_F(PersistentLogRingTests, DrainAfterCrash) {
+  const std::string persisted(100, 'p');
+  AppendToLog(persisted);
+  {
+    PersistentLogRing ring(RING_TEST_RING_FILE_NAME, 1 << 16);
+    // Nothing can be appended before the entries of the last run are drained and the ring is reset
+    EXPECT_FALSE(Append(&ring, "lost"));
+    EXPECT_EQ(ring.Drain(RING_TEST_LOG_FILE_NAME), 0);
+    ring.Reset(0, persisted.size());
+    EXPECT_TRUE(Append(&ring, "hello"));
+    EXPECT_TRUE(Append(&ring, "world!"));
+    // The write of the first entry to the log file was torn by the crash
+    AppendToLog("hel");
+  }
+
+  PersistentLogRing ring(RING_TEST_RING_FILE_NAME, 1 << 16);
+  EXPECT_EQ(ring.Drain(RING_TEST_LOG_FILE_NAME), 11);
+  EXPECT_EQ(ReadLog(), persisted + "helloworld!");
+  // Draining again, e.g. after crashing once more before the reset, writes the same bytes
+  EXPECT_EQ(ring.Drain(RING_TEST_LOG_FILE_NAME), 11);
+  EXPECT_EQ(ReadLog(), persisted + "helloworld!");
+
+  // Once the log file is persisted, the reset invalidates the entries
+  ring.Reset(0, persisted.size() + 11);
+  EXPECT_EQ(ring.Used(), 0);
+  EXPECT_EQ(ring.Drain(RING_TEST_LOG_FILE_NAME), 0);
+  EXPECT_EQ(ReadLog(), persisted + "helloworld!");
+}
+
+// Draining stops at the first entry that was torn by the crash, and a log file that is shorter than the location the
+// ring was reset to is not the log the ring belongs to
+// NOLINTNEXTLINE
+TEST_F(PersistentLogRingTests, DrainStopsAtTornEntry) {
+  {
+    PersistentLogRing ring(RING_TEST_RING_FILE_NAME, 1 << 16);
+    ring.Reset(0, 0);
+    EXPECT_TRUE(Append(&ring, "first"));
+    EXPECT_TRUE(Append(&ring, "second"));
+    EXPECT_TRUE(Append(&ring, "third"));
+  }
+  // Every entry starts at its own cache line after the first page: a 16 byte header followed by the bytes appended
+  const int fd = PosixIoWrappers::Open(RING_TEST_RING_FILE_NAME, O_WRONLY);
+  PosixIoWrappers::PwriteFully(fd, "X", 1, 4096 + 64 + 16);
+  PosixIoWrappers::Close(fd);
+
+  PersistentLogRing ring(RING_TEST_RING_FILE_NAME, 1 << 16);
+  EXPECT_EQ(ring.Drain(RING_TEST_LOG_FILE_NAME), 5);
+  EXPECT_EQ(ReadLog(), "first");
+
+  ring.Reset(0, 1000);
+  EXPECT_TRUE(Append(&ring, "unreachable"));
+  EXPECT_EQ(ring.Drain(RING_TEST_LOG_FILE_NAME), 0);
+  EXPECT_EQ(ReadLog(), "first");
+}
+
+// Appends fail once the ring is full, until it is reset
+// NOLINTNEXTLINE
+TEST_F(PersistentLogRingTests, FullRing) {
+  PersistentLogRing ring(RING_TEST_RING_FILE_NAME, 4096);
+  EXPECT_EQ(ring.Capacity(), 4096);
+  ring.Reset(0, 0);
+  // Each entry takes 1024 bytes with its header, padded to a cache line
+  const std::string data(1000, 'd');
+  for (uint32_t i = 0; i < 4; i++) EXPECT_TRUE(Append(&ring, data));
+  EXPECT_EQ(ring.Used(), ring.Capacity());
+  EXPECT_FALSE(Append(&ring, "x"));
+  ring.Reset(0, 0);
+  EXPECT_TRUE(Append(&ring, data));
+}
+
+}  // namespace noisepage::storage
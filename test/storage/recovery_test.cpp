@@ -1,15 +1,23 @@
+#include <chrono>  // NOLINT
+#include <filesystem>
+#include <fstream>
 #include <memory>
+#include <optional>
+#include <sstream>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "catalog/catalog.h"
 #include "catalog/postgres/pg_namespace.h"
+#include "common/json.h"
 #include "gtest/gtest.h"
 #include "main/db_main.h"
+#include "storage/checkpoint/checkpoint_manager.h"
 #include "storage/garbage_collector_thread.h"
 #include "storage/index/index_builder.h"
 #include "storage/recovery/disk_log_provider.h"
+#include "storage/recovery/multi_stream_log_provider.h"
 #include "storage/recovery/recovery_manager.h"
 #include "storage/sql_table.h"
 #include "storage/write_ahead_log/log_manager.h"
@@ -24,6 +32,7 @@
 // executions will read old test's data, and the cause of the errors will be hard to identify. Trust me it will drive
 // you nuts...
 #define RECOVERY_TEST_LOG_FILE_NAME "./test_recovery_test.log"
+#define RECOVERY_TEST_CHECKPOINT_DIR "./test_recovery_test_checkpoints"
 
 namespace noisepage::storage {
 class RecoveryTests : public TerrierTest {
@@ -36,6 +45,9 @@ class RecoveryTests : public TerrierTest {
   common::ManagedPointer<storage::LogManager> log_manager_;
   common::ManagedPointer<storage::BlockStore> block_store_;
   common::ManagedPointer<catalog::Catalog> catalog_;
+  uint32_t num_log_streams_ = 1;
+  bool compress_log_ = false;
+  uint64_t log_segment_size_ = 0;
 
   // Recovery Components
   std::unique_ptr<DBMain> recovery_db_main_;
@@ -48,18 +60,9 @@ class RecoveryTests : public TerrierTest {
   void SetUp() override {
     // Unlink log file incase one exists from previous test iteration
     unlink(RECOVERY_TEST_LOG_FILE_NAME);
+    std::filesystem::remove_all(RECOVERY_TEST_CHECKPOINT_DIR);
 
-    db_main_ = noisepage::DBMain::Builder()
-                   .SetWalFilePath(RECOVERY_TEST_LOG_FILE_NAME)
-                   .SetUseLogging(true)
-                   .SetUseGC(true)
-                   .SetUseGCThread(true)
-                   .SetUseCatalog(true)
-                   .Build();
-    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
-    log_manager_ = db_main_->GetLogManager();
-    block_store_ = db_main_->GetStorageLayer()->GetBlockStore();
-    catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+    StartOriginalSystem(1);
 
     recovery_db_main_ = noisepage::DBMain::Builder()
                             .SetUseThreadRegistry(true)
@@ -77,7 +80,50 @@ class RecoveryTests : public TerrierTest {
 
   void TearDown() override {
     // Delete log file
-    unlink(RECOVERY_TEST_LOG_FILE_NAME);
+    RemoveLogFiles();
+    std::filesystem::remove_all(RECOVERY_TEST_CHECKPOINT_DIR);
+  }
+
+  // Deletes the log files of all streams, including their segments and manifests
+  void RemoveLogFiles() const {
+    for (const auto &path : LogManager::LogFilePaths(RECOVERY_TEST_LOG_FILE_NAME, num_log_streams_)) {
+      for (const auto &segment_path : LogManager::LogSegmentPaths(path)) unlink(segment_path.c_str());
+      unlink(LogManager::LogManifestPath(path).c_str());
+    }
+  }
+
+  // (Re)starts the original system, logging to the given number of log streams
+  void StartOriginalSystem(const uint32_t num_log_streams, const bool compress_log = false,
+                           const uint64_t log_segment_size = 0) {
+    db_main_.reset();
+    num_log_streams_ = num_log_streams;
+    compress_log_ = compress_log;
+    log_segment_size_ = log_segment_size;
+    RemoveLogFiles();
+
+    db_main_ = noisepage::DBMain::Builder()
+                   .SetWalFilePath(RECOVERY_TEST_LOG_FILE_NAME)
+                   .SetWalNumStreams(num_log_streams_)
+                   .SetWalCompression(compress_log_)
+                   .SetWalSegmentSize(log_segment_size_)
+                   .SetUseLogging(true)
+                   .SetUseGC(true)
+                   .SetUseGCThread(true)
+                   .SetUseCatalog(true)
+                   .Build();
+    txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
+    log_manager_ = db_main_->GetLogManager();
+    block_store_ = db_main_->GetStorageLayer()->GetBlockStore();
+    catalog_ = db_main_->GetCatalogLayer()->GetCatalog();
+  }
+
+  // Provides the logs of the original system
+  std::unique_ptr<AbstractLogProvider> MakeLogProvider() const {
+    if (num_log_streams_ == 1) {
+      return std::make_unique<DiskLogProvider>(LogManager::LogSegmentPaths(RECOVERY_TEST_LOG_FILE_NAME), compress_log_);
+    }
+    return std::make_unique<MultiStreamLogProvider>(
+        LogManager::LogFilePaths(RECOVERY_TEST_LOG_FILE_NAME, num_log_streams_), compress_log_);
   }
 
   catalog::IndexSchema DummyIndexSchema() {
@@ -184,23 +230,37 @@ class RecoveryTests : public TerrierTest {
     recovery_manager.WaitForRecoveryToFinish();
   }
 
-  void RunTest(const LargeSqlTableTestConfiguration &config) {
+  void RunTest(const LargeSqlTableTestConfiguration &config, const bool take_checkpoint = false,
+               const uint32_t num_replay_threads = 1) {
     // Run workload
     auto *tested =
         new LargeSqlTableTestObject(config, txn_manager_.Get(), catalog_.Get(), block_store_.Get(), &generator_);
     tested->SimulateOltp(100, 4);
 
+    // Checkpoint halfway through the workload, so that recovery has to combine the checkpoint with the log
+    if (take_checkpoint) {
+      CheckpointManager checkpoint_manager(RECOVERY_TEST_CHECKPOINT_DIR, txn_manager_, catalog_);
+      checkpoint_manager.TakeCheckpoint();
+      tested->SimulateOltp(100, 4);
+    }
+
     ShutdownAndRestartSystem();
 
     // Instantiate recovery manager, and recover the tables.
-    DiskLogProvider log_provider{RECOVERY_TEST_LOG_FILE_NAME};
-    RecoveryManager recovery_manager{common::ManagedPointer<AbstractLogProvider>(&log_provider),
+    auto log_provider = MakeLogProvider();
+    RecoveryManager recovery_manager{common::ManagedPointer(log_provider),
                                      recovery_catalog_,
                                      recovery_txn_manager_,
                                      recovery_deferred_action_manager_,
                                      DISABLED,
                                      recovery_thread_registry_,
-                                     recovery_block_store_};
+                                     recovery_block_store_,
+                                     num_replay_threads};
+    if (take_checkpoint) {
+      auto checkpoint = CheckpointManager::GetLatestCheckpoint(RECOVERY_TEST_CHECKPOINT_DIR);
+      EXPECT_TRUE(checkpoint.has_value());
+      recovery_manager.SetCheckpoint(*checkpoint);
+    }
     recovery_manager.StartRecovery();
     recovery_manager.WaitForRecoveryToFinish();
 
@@ -250,6 +310,225 @@ TEST_F(RecoveryTests, SingleTableTest) {
   RecoveryTests::RunTest(config);
 }
 
+// This test takes a checkpoint in the middle of the workload. It then recovers from the checkpoint and the log, and
+// verifies that the recovered tables are the same as the original tables
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, CheckpointTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(2)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config, true);
+}
+
+// This test replays the log with multiple threads. Transactions that write different tuples are replayed concurrently,
+// while transactions that touch the catalog act as barriers
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, ParallelReplayTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(5)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(1)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config, false, 4);
+}
+
+// This test replays the log of a single table with multiple threads, so that concurrent transactions write the same
+// table, and transactions that write the same tuples have to wait for each other
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, ParallelReplaySingleTableTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(1)
+                                              .SetNumTables(1)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config, false, 4);
+}
+
+// This test begins transactions that read the replayed tables while the log is replayed with multiple threads, and
+// checks that the replay caught up with every transaction once it is done
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, ReadTransactionTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(1)
+                                              .SetNumTables(2)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  auto *tested =
+      new LargeSqlTableTestObject(config, txn_manager_.Get(), catalog_.Get(), block_store_.Get(), &generator_);
+  tested->SimulateOltp(100, 4);
+  ShutdownAndRestartSystem();
+
+  auto log_provider = MakeLogProvider();
+  RecoveryManager recovery_manager{common::ManagedPointer(log_provider),
+                                   recovery_catalog_,
+                                   recovery_txn_manager_,
+                                   recovery_deferred_action_manager_,
+                                   DISABLED,
+                                   recovery_thread_registry_,
+                                   recovery_block_store_,
+                                   4};
+  recovery_manager.StartRecovery();
+  // Readers never see the replay half way through a segment, and do not wait for it without a staleness bound
+  for (uint32_t i = 0; i < 100; i++) {
+    auto *const txn = recovery_manager.BeginReadTransaction(true, transaction::IsolationLevel::SNAPSHOT, std::nullopt);
+    recovery_txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  }
+  recovery_manager.WaitForRecoveryToFinish();
+
+  // Everything that was received is applied, so a reader that asks for the latest state does not wait
+  EXPECT_EQ(recovery_manager.GetApplyLag().count(), 0);
+  EXPECT_GT(recovery_manager.GetLastAppliedTransactionId(), transaction::INITIAL_TXN_TIMESTAMP);
+  auto *const txn = recovery_manager.BeginReadTransaction(true, transaction::IsolationLevel::SNAPSHOT,
+                                                          std::chrono::milliseconds(0));
+  EXPECT_GT(txn->StartTime(), recovery_manager.GetLastAppliedTransactionId());
+  recovery_txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete tested; });
+}
+
+// This test decodes the replayed changes into row change events, and checks that they arrive in batches of whole
+// transactions that name each row by its key
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, LogicalDecodingTest) {
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(1)
+                                              .SetNumTables(2)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  auto *tested =
+      new LargeSqlTableTestObject(config, txn_manager_.Get(), catalog_.Get(), block_store_.Get(), &generator_);
+  tested->SimulateOltp(100, 4);
+  ShutdownAndRestartSystem();
+
+  constexpr uint32_t batch_size = 100;
+  std::vector<std::pair<transaction::timestamp_t, std::string>> batches;
+  auto log_provider = MakeLogProvider();
+  RecoveryManager recovery_manager{common::ManagedPointer(log_provider),
+                                   recovery_catalog_,
+                                   recovery_txn_manager_,
+                                   recovery_deferred_action_manager_,
+                                   DISABLED,
+                                   recovery_thread_registry_,
+                                   recovery_block_store_,
+                                   4};
+  recovery_manager.SetLogicalDecoder(std::make_unique<LogicalDecoder>(
+      batch_size, [&batches](const transaction::timestamp_t last_txn_id, std::string changes) {
+        batches.emplace_back(last_txn_id, std::move(changes));
+      }));
+  recovery_manager.StartRecovery();
+  recovery_manager.WaitForRecoveryToFinish();
+
+  ASSERT_FALSE(batches.empty());
+  uint64_t num_inserts = 0;
+  for (uint32_t i = 0; i < batches.size(); i++) {
+    std::istringstream lines(batches[i].second);
+    std::string line;
+    uint32_t num_events = 0;
+    uint64_t last_txn_id = 0;
+    while (std::getline(lines, line)) {
+      const auto event = common::json::parse(line);
+      const auto op = event.at("op").get<std::string>();
+      EXPECT_TRUE(op == "INSERT" || op == "UPDATE" || op == "DELETE");
+      EXPECT_GE(event.at("table").get<uint32_t>(), catalog::START_OID);
+      EXPECT_FALSE(event.at("key").empty());
+      EXPECT_EQ(event.contains("columns"), op != "DELETE");
+      if (op == "INSERT") num_inserts++;
+      last_txn_id = event.at("txn").get<uint64_t>();
+      num_events++;
+    }
+    // Only the last batch is sent before it is full, and transactions are never split across batches
+    if (i + 1 < batches.size()) EXPECT_GE(num_events, batch_size);
+    EXPECT_EQ(last_txn_id, batches[i].first.UnderlyingValue());
+  }
+  // Every tuple of the initial tables was inserted by a logged transaction
+  EXPECT_GE(num_inserts, 2 * 1000);
+
+  db_main_->GetTransactionLayer()->GetDeferredActionManager()->RegisterDeferredAction([=]() { delete tested; });
+}
+
+// This test logs to several log streams, and recovers by merging them
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, MultiStreamTest) {
+  StartOriginalSystem(4);
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(2)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config);
+}
+
+// This test writes a compressed log, and recovers from it
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, CompressedLogTest) {
+  StartOriginalSystem(1, true);
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(2)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config);
+}
+
+// This test splits the log into many small segments, and recovers from all of them
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, SegmentedLogTest) {
+  StartOriginalSystem(1, false, 1 << 16);
+  LargeSqlTableTestConfiguration config = LargeSqlTableTestConfiguration::Builder()
+                                              .SetNumDatabases(2)
+                                              .SetNumTables(2)
+                                              .SetMaxColumns(5)
+                                              .SetInitialTableSize(1000)
+                                              .SetTxnLength(5)
+                                              .SetInsertUpdateSelectDeleteRatio({0.2, 0.5, 0.2, 0.1})
+                                              .SetVarlenAllowed(true)
+                                              .Build();
+  RecoveryTests::RunTest(config);
+
+  // Every segment but the last one is sealed and recorded in the manifest
+  const auto segments = LogManager::LogSegmentPaths(RECOVERY_TEST_LOG_FILE_NAME);
+  EXPECT_GT(segments.size(), 1);
+  std::ifstream manifest(LogManager::LogManifestPath(RECOVERY_TEST_LOG_FILE_NAME));
+  std::string segment_path;
+  uint64_t segment_size;
+  for (uint32_t i = 0; i + 1 < segments.size(); i++) {
+    ASSERT_TRUE(manifest >> segment_path >> segment_size);
+    EXPECT_EQ(segment_path, segments[i]);
+    EXPECT_EQ(segment_size, std::filesystem::file_size(segments[i]));
+    EXPECT_GE(segment_size, 1 << 16);
+  }
+}
+
 // This test checks that we recover correctly in a high abort rate workload. We achieve the high abort rate by having
 // large transaction lengths (number of updates). Further, to ensure that more aborted transactions flush logs before
 // aborting, we have transactions make large updates (by having high number columns). This will cause RedoBuffers to
@@ -340,6 +619,55 @@ TEST_F(RecoveryTests, DropTableTest) {
   recovery_txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
 }
 
+// Tests that we correctly process records corresponding to dropping a column of a table.
+// NOLINTNEXTLINE
+TEST_F(RecoveryTests, DropColumnTest) {
+  std::string database_name = "testdb";
+  auto namespace_oid = catalog::postgres::PgNamespace::NAMESPACE_DEFAULT_NAMESPACE_OID;
+  std::string table_name = "testtable";
+
+  // Create database and a table with two columns
+  auto *txn = txn_manager_->BeginTransaction();
+  auto db_oid = CreateDatabase(txn, catalog_, database_name);
+  auto db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+  std::vector<catalog::Schema::Column> cols;
+  cols.emplace_back("kept", type::TypeId::INTEGER, false, parser::ConstantValueExpression(type::TypeId::INTEGER));
+  cols.emplace_back("dropped", type::TypeId::INTEGER, false, parser::ConstantValueExpression(type::TypeId::INTEGER));
+  auto table_oid =
+      db_catalog->CreateTable(common::ManagedPointer(txn), namespace_oid, table_name, catalog::Schema(cols));
+  EXPECT_NE(catalog::INVALID_TABLE_OID, table_oid);
+  const auto &schema = db_catalog->GetSchema(common::ManagedPointer(txn), table_oid);
+  auto *table_ptr = new storage::SqlTable(block_store_, schema);
+  EXPECT_TRUE(db_catalog->SetTablePointer(common::ManagedPointer(txn), table_oid, table_ptr));
+  const auto kept_oid = schema.GetColumn("kept").Oid();
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  // Drop one of the columns
+  txn = txn_manager_->BeginTransaction();
+  db_catalog = catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+  const auto &old_schema = db_catalog->GetSchema(common::ManagedPointer(txn), table_oid);
+  EXPECT_TRUE(db_catalog->UpdateSchema(common::ManagedPointer(txn), table_oid,
+                                       new catalog::Schema({old_schema.GetColumn("kept")})));
+  txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+  ShutdownAndRestartSystem();
+
+  // Instantiate recovery manager, and recover the catalog
+  SingleRecovery();
+
+  // Assert the recovered table only has the kept column
+  txn = recovery_txn_manager_->BeginTransaction();
+  db_catalog = recovery_catalog_->GetDatabaseCatalog(common::ManagedPointer(txn), db_oid);
+  EXPECT_TRUE(db_catalog);
+  EXPECT_EQ(table_oid, db_catalog->GetTableOid(common::ManagedPointer(txn), namespace_oid, table_name));
+  const auto &recovered_schema = db_catalog->GetSchema(common::ManagedPointer(txn), table_oid);
+  EXPECT_EQ(1, recovered_schema.GetColumns().size());
+  EXPECT_EQ(kept_oid, recovered_schema.GetColumns()[0].Oid());
+  EXPECT_EQ("kept", recovered_schema.GetColumns()[0].Name());
+  EXPECT_TRUE(db_catalog->GetTable(common::ManagedPointer(txn), table_oid));
+  recovery_txn_manager_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+}
+
 // Tests that we correctly process records corresponding to a drop index command.
 // NOLINTNEXTLINE
 TEST_F(RecoveryTests, DropIndexTest) {
@@ -107,6 +107,49 @@ TEST_F(TupleAccessStrategyTests, Nulls) {
   }
 }
 
+// Tests that runs of slots are claimed from the insertion head on, and that freed slots behind it are found again
+// NOLINTNEXTLINE
+TEST_F(TupleAccessStrategyTests, AllocateRun) {
+  std::default_random_engine generator;
+  const uint32_t repeat = 10;
+  for (uint32_t i = 0; i < repeat; i++) {
+    storage::BlockLayout layout = StorageTestUtil::RandomLayoutNoVarlen(common::Constants::MAX_COL, &generator);
+    storage::TupleAccessStrategy tested(layout);
+    std::memset(reinterpret_cast<void *>(raw_block_), 0, sizeof(storage::RawBlock));
+    tested.InitializeRawBlock(nullptr, raw_block_, storage::layout_version_t(0));
+
+    std::vector<storage::TupleSlot> slots(layout.NumSlots());
+    storage::TupleSlot single;
+    EXPECT_TRUE(tested.Allocate(raw_block_, &single));
+    EXPECT_EQ(single.GetOffset(), 0);
+    // A run that is longer than what is left of the block stops at its end
+    const uint32_t num_run = std::uniform_int_distribution<uint32_t>(1, layout.NumSlots() - 1)(generator);
+    EXPECT_EQ(tested.AllocateRun(raw_block_, num_run, slots.data()), num_run);
+    EXPECT_EQ(tested.AllocateRun(raw_block_, layout.NumSlots(), slots.data() + num_run),
+              layout.NumSlots() - 1 - num_run);
+    for (uint32_t j = 0; j + 1 < layout.NumSlots(); j++) {
+      EXPECT_EQ(slots[j], storage::TupleSlot(raw_block_, j + 1));
+      EXPECT_TRUE(tested.Allocated(slots[j]));
+    }
+    EXPECT_EQ(raw_block_->GetInsertHead(), layout.NumSlots());
+    EXPECT_EQ(tested.AllocateRun(raw_block_, 1, slots.data()), 0);
+    EXPECT_FALSE(tested.Allocate(raw_block_, &single));
+
+    // Freed slots are only handed out again behind the head, in order
+    const uint32_t first_freed = std::uniform_int_distribution<uint32_t>(0, layout.NumSlots() - 1)(generator);
+    const uint32_t last_freed = std::uniform_int_distribution<uint32_t>(first_freed, layout.NumSlots() - 1)(generator);
+    tested.Deallocate(storage::TupleSlot(raw_block_, last_freed));
+    if (first_freed != last_freed) tested.Deallocate(storage::TupleSlot(raw_block_, first_freed));
+    EXPECT_TRUE(tested.AllocateFreed(raw_block_, 0, &single));
+    EXPECT_EQ(single.GetOffset(), first_freed);
+    if (last_freed != first_freed) {
+      EXPECT_TRUE(tested.AllocateFreed(raw_block_, first_freed + 1, &single));
+      EXPECT_EQ(single.GetOffset(), last_freed);
+    }
+    EXPECT_FALSE(tested.AllocateFreed(raw_block_, 0, &single));
+  }
+}
+
 // Tests that we can allocate a tuple slot, write things into the slot and get them out.
 // NOLINTNEXTLINE
 TEST_F(TupleAccessStrategyTests, SimpleInsert) {
@@ -205,4 +248,59 @@ TEST_F(TupleAccessStrategyTests, Alignment) {
     }
   }
 }
+
+// This test generates randomized block layouts with column groups, and checks that the values of a group are stored
+// row-wise within the block. It then fills the block and checks that the tuples read back the same, whether they are
+// copied out an attribute at a time or a span of a column group at a time.
+// NOLINTNEXTLINE
+TEST_F(TupleAccessStrategyTests, ColumnGroups) {
+  const uint32_t repeat = 50;
+  const uint32_t max_cols = 100;
+  std::default_random_engine generator;
+  for (uint32_t i = 0; i < repeat; i++) {
+    TupleAccessStrategyTestObject test_obj;
+
+    storage::BlockLayout layout = StorageTestUtil::RandomlyGroupedLayout(
+        StorageTestUtil::RandomLayoutNoVarlen(max_cols, &generator), &generator);
+    storage::TupleAccessStrategy tested(layout);
+    std::memset(reinterpret_cast<void *>(raw_block_), 0, sizeof(storage::RawBlock));
+    tested.InitializeRawBlock(nullptr, raw_block_, storage::layout_version_t(0));
+
+    void *upper_bound = raw_block_ + sizeof(storage::RawBlock);
+    for (const auto &group : layout.ColumnGroups()) {
+      const storage::col_id_t first = group[0];
+      for (const storage::col_id_t col_id : group) {
+        EXPECT_EQ(layout.AttrStride(col_id), layout.AttrStride(first));
+        EXPECT_EQ(layout.IsColumnar(col_id), group.size() == 1);
+        // The value of a column comes after the values of the previous columns of the group in the same row
+        EXPECT_EQ(tested.ColumnStart(raw_block_, col_id),
+                  tested.ColumnStart(raw_block_, first) + layout.AttrGroupOffset(col_id));
+        StorageTestUtil::CheckAlignment(tested.ColumnStart(raw_block_, col_id),
+                                        layout.AttrSize(col_id) > 8 ? 8 : layout.AttrSize(col_id));
+        // The last byte of the value of the last slot is still within the block
+        const uint64_t last_byte = (layout.NumSlots() - 1) * layout.AttrStride(col_id) + layout.AttrSize(col_id) - 1;
+        StorageTestUtil::CheckInBounds(
+            StorageTestUtil::IncrementByBytes(tested.ColumnStart(raw_block_, col_id), last_byte),
+            tested.ColumnNullBitmap(raw_block_, col_id), upper_bound);
+      }
+      EXPECT_LE(layout.AttrGroupOffset(group.back()) + layout.AttrSize(group.back()), layout.AttrStride(first));
+    }
+
+    std::unordered_map<storage::TupleSlot, storage::ProjectedRow *> tuples;
+    for (uint32_t j = 0; j < layout.NumSlots(); j++)
+      test_obj.TryInsertFakeTuple(layout, tested, raw_block_, &tuples, &generator);
+
+    storage::ProjectedRowInitializer initializer =
+        storage::ProjectedRowInitializer::Create(layout, StorageTestUtil::ProjectionListAllColumns(layout));
+    byte *buffer = common::AllocationUtil::AllocateAligned(initializer.ProjectedRowSize());
+    storage::ProjectedRow *row = initializer.InitializeRow(buffer);
+    for (auto &entry : tuples) {
+      StorageTestUtil::CheckTupleEqualShallow(*(entry.second), tested, layout, entry.first);
+      for (uint16_t j = 0; j < row->NumColumns();)
+        j = static_cast<uint16_t>(j + storage::StorageUtil::CopyAttrSpanIntoProjection(tested, entry.first, row, j));
+      EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(layout, row, entry.second));
+    }
+    delete[] buffer;
+  }
+}
 }  // namespace noisepage
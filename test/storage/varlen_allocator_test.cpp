@@ -0,0 +1,68 @@
+#include "storage/varlen_allocator.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "common/worker_pool.h"
+#include "storage/storage_defs.h"
+#include "test_util/multithread_test_util.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage {
+
+// Freed contents of a size class are handed out again, and contents too large for the size classes still work
+// NOLINTNEXTLINE
+TEST(VarlenAllocatorTests, ReuseAndLarge) {
+  for (const uint32_t size : {13u, 16u, 17u, 100u, 1000u, storage::VarlenAllocator::MAX_POOLED_SIZE,
+                              storage::VarlenAllocator::MAX_POOLED_SIZE + 1, 100000u}) {
+    byte *const content = storage::VarlenAllocator::Allocate(size);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(content) % sizeof(uint64_t), 0);
+    std::memset(content, 0xFF, size);
+    storage::VarlenAllocator::Deallocate(content);
+
+    byte *const reused = storage::VarlenAllocator::Allocate(size);
+    if (size <= storage::VarlenAllocator::MAX_POOLED_SIZE) {
+      EXPECT_EQ(reused, content);
+    }
+    std::memset(reused, 0, size);
+    storage::VarlenAllocator::Deallocate(reused);
+  }
+}
+
+// Contents allocated by one thread can be freed by another, the way the GC frees the old versions of all workers
+// NOLINTNEXTLINE
+TEST(VarlenAllocatorTests, ConcurrentAllocateAndFree) {
+  const uint32_t num_threads = MultiThreadTestUtil::HardwareConcurrency();
+  const uint32_t num_contents = 1000;
+  common::WorkerPool thread_pool(num_threads, {});
+  std::vector<std::vector<std::pair<byte *, uint32_t>>> contents(num_threads);
+
+  auto allocate = [&](const uint32_t id) {
+    std::default_random_engine generator(id);
+    std::uniform_int_distribution<uint32_t> size_dist(storage::VarlenEntry::InlineThreshold() + 1,
+                                                    2 * storage::VarlenAllocator::MAX_POOLED_SIZE);
+    for (uint32_t i = 0; i < num_contents; i++) {
+      const uint32_t size = size_dist(generator);
+      byte *const content = storage::VarlenAllocator::Allocate(size);
+      std::memset(content, static_cast<int>(id), size);
+      contents[id].emplace_back(content, size);
+    }
+  };
+  MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, num_threads, allocate);
+
+  // Every thread frees what its neighbour allocated, after checking that no other allocation overwrote it
+  auto check_and_free = [&](const uint32_t id) {
+    const uint32_t owner = (id + 1) % num_threads;
+    for (const auto &[content, size] : contents[owner]) {
+      EXPECT_TRUE(std::all_of(content, content + size, [=](const byte b) { return b == static_cast<byte>(owner); }));
+      storage::VarlenAllocator::Deallocate(content);
+    }
+  };
+  MultiThreadTestUtil::RunThreadsUntilFinish(&thread_pool, num_threads, check_and_free);
+}
+
+}  // namespace noisepage
@@ -0,0 +1,73 @@
+#include "storage/varlen_compression.h"
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "test_util/test_harness.h"
+
+namespace noisepage::storage {
+
+struct VarlenCompressionTests : public TerrierTest {
+  // A JSON document of the given size, which repeats its keys like most real ones do
+  static std::string JsonDocument(const uint32_t size, std::default_random_engine *const generator) {
+    std::uniform_int_distribution<uint32_t> value(0, 999999);
+    std::string document = "[";
+    while (document.size() < size) {
+      document += R"({"id": )" + std::to_string(value(*generator)) + R"(, "name": "customer)" +
+                  std::to_string(value(*generator)) + R"(", "active": true, "tags": ["a", "b"]},)";
+    }
+    document.resize(size);
+    return document;
+  }
+
+  // Compress the content, and check that it decompresses to what it was. Returns the compressed size.
+  static uint32_t RoundTrip(const std::string &content) {
+    const auto *const bytes = reinterpret_cast<const byte *>(content.data());
+    const auto size = static_cast<uint32_t>(content.size());
+    std::vector<byte> compressed;
+    const uint32_t compressed_size = VarlenCompression::Compress(bytes, size, &compressed);
+    if (compressed_size == 0) return size;
+
+    EXPECT_LE(compressed_size, VarlenCompression::MaxCompressedSize(size));
+    std::vector<byte> decompressed(size);
+    EXPECT_TRUE(VarlenCompression::Decompress(compressed.data(), compressed_size, decompressed.data(), size));
+    EXPECT_EQ(0, std::memcmp(bytes, decompressed.data(), size));
+    // Any truncation of the compressed content is detected
+    EXPECT_FALSE(VarlenCompression::Decompress(compressed.data(), compressed_size - 1, decompressed.data(), size));
+    return compressed_size;
+  }
+
+  std::default_random_engine generator_;
+};
+
+// Documents of a single and of several chunks shrink, and come back the same
+// NOLINTNEXTLINE
+TEST_F(VarlenCompressionTests, JsonRoundTrip) {
+  const uint32_t multiple_chunks = 3 * VarlenCompression::CHUNK_SIZE + 1;
+  for (const uint32_t size : {VarlenCompression::COMPRESSION_THRESHOLD, 10000U, multiple_chunks}) {
+    const std::string document = JsonDocument(size, &generator_);
+    EXPECT_LT(RoundTrip(document), size / 2);
+  }
+}
+
+// Runs of one byte compress into overlapping matches
+// NOLINTNEXTLINE
+TEST_F(VarlenCompressionTests, RepeatedByte) {
+  const std::string content(100000, 'x');
+  EXPECT_LT(RoundTrip(content), 1000);
+}
+
+// Random contents do not get any smaller, and are left as they are
+// NOLINTNEXTLINE
+TEST_F(VarlenCompressionTests, Incompressible) {
+  std::uniform_int_distribution<int> value(0, UINT8_MAX);
+  std::string content(20000, '\0');
+  for (auto &c : content) c = static_cast<char>(value(generator_));
+  std::vector<byte> compressed;
+  EXPECT_EQ(0, VarlenCompression::Compress(reinterpret_cast<const byte *>(content.data()),
+                                           static_cast<uint32_t>(content.size()), &compressed));
+}
+
+}  // namespace noisepage::storage
@@ -6,6 +6,7 @@
 #include "common/allocator.h"
 #include "storage/storage_defs.h"
 #include "storage/storage_util.h"
+#include "storage/varlen_allocator.h"
 #include "test_util/storage_test_util.h"
 #include "test_util/test_harness.h"
 
@@ -74,7 +75,7 @@ TEST(VarlenEntryTests, Array) {
     const auto varlen_entry = storage::StorageUtil::CreateVarlen(test_data);
     const std::vector<int32_t> test_view = varlen_entry.DeserializeArray<int32_t>();
     EXPECT_EQ(test_data, test_view);
-    delete[] varlen_entry.Content();
+    storage::VarlenAllocator::Deallocate(varlen_entry.Content());
   }
 
   // test inline
@@ -96,7 +97,7 @@ TEST(VarlenEntryTests, Array) {
     const auto varlen_entry = storage::StorageUtil::CreateVarlen(test_data);
     std::vector<std::string_view> test_view = varlen_entry.DeserializeArrayVarlen();
     EXPECT_EQ(sv_test_data, test_view);
-    delete[] varlen_entry.Content();
+    storage::VarlenAllocator::Deallocate(varlen_entry.Content());
   }
 }
 
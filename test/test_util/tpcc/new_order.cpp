@@ -3,6 +3,8 @@
 #include <string>
 #include <vector>
 
+#include "storage/varlen_allocator.h"
+
 namespace noisepage::tpcc {
 
 // 2.4.2
@@ -259,7 +261,7 @@ bool NewOrder::Execute(transaction::TransactionManager *const txn_manager, Datab
           order_line_insert_tuple->AccessForceNotNull(ol_dist_info_insert_pr_offset_)) = s_dist_xx;
 
     } else {
-      auto *const varlen = common::AllocationUtil::AllocateAligned(s_dist_xx.Size());
+      auto *const varlen = storage::VarlenAllocator::Allocate(s_dist_xx.Size());
       std::memcpy(varlen, s_dist_xx.Content(), s_dist_xx.Size());
       const auto varlen_entry = storage::VarlenEntry::Create(varlen, s_dist_xx.Size(), true);
       *reinterpret_cast<storage::VarlenEntry *>(
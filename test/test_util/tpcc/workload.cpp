@@ -1,18 +1,24 @@
 #include "test_util/tpcc/workload.h"
 
+#include <chrono>  // NOLINT
 #include <vector>
 
+#include "storage/varlen_allocator.h"
+
 namespace noisepage::tpcc {
 
 void Workload(const int8_t worker_id, Database *const tpcc_db, transaction::TransactionManager *const txn_manager,
-              const std::vector<std::vector<TransactionArgs>> &precomputed_args, std::vector<Worker> *const workers) {
+              const std::vector<std::vector<TransactionArgs>> &precomputed_args, std::vector<Worker> *const workers,
+              std::vector<uint64_t> *const latencies_us) {
   auto new_order = NewOrder(tpcc_db);
   auto payment = Payment(tpcc_db);
   auto order_status = OrderStatus(tpcc_db);
   auto delivery = Delivery(tpcc_db);
   auto stock_level = StockLevel(tpcc_db);
 
+  if (latencies_us != nullptr) latencies_us->reserve(precomputed_args[worker_id].size());
   for (const auto &txn_args : precomputed_args[worker_id]) {
+    const auto start = std::chrono::steady_clock::now();
     switch (txn_args.type_) {
       case TransactionType::NewOrder: {
         new_order.Execute(txn_manager, tpcc_db, &((*workers)[worker_id]), txn_args);
@@ -37,6 +43,10 @@ void Workload(const int8_t worker_id, Database *const tpcc_db, transaction::Tran
       default:
         throw std::runtime_error("Unexpected transaction type.");
     }
+    if (latencies_us != nullptr) {
+      latencies_us->push_back(static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count()));
+    }
   }
 }
 
@@ -45,7 +55,7 @@ void CleanUpVarlensInPrecomputedArgs(const std::vector<std::vector<TransactionAr
     for (const auto &args : worker_id) {
       if ((args.type_ == TransactionType::Payment || args.type_ == TransactionType::OrderStatus) && args.use_c_last_ &&
           !args.c_last_.IsInlined()) {
-        delete[] args.c_last_.Content();
+        storage::VarlenAllocator::Deallocate(args.c_last_.Content());
       }
     }
   }
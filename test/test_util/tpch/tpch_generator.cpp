@@ -0,0 +1,372 @@
+#include "test_util/tpch/tpch_generator.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "common/macros.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace noisepage::tpch {
+
+const std::vector<std::string> TPCHGenerator::TABLE_NAMES{"region",   "nation", "supplier", "part",
+                                                          "partsupp", "customer", "orders", "lineitem"};
+
+namespace {
+
+// Value domains of the specification (section 4.2.2.13 and 4.2.3)
+constexpr std::array<std::string_view, 5> REGIONS{"AFRICA", "AMERICA", "ASIA", "EUROPE", "MIDDLE EAST"};
+constexpr std::array<std::pair<std::string_view, int32_t>, 25> NATIONS{
+    {{"ALGERIA", 0},       {"ARGENTINA", 1},  {"BRAZIL", 1},        {"CANADA", 1},        {"EGYPT", 4},
+     {"ETHIOPIA", 0},      {"FRANCE", 3},     {"GERMANY", 3},       {"INDIA", 2},         {"INDONESIA", 2},
+     {"IRAN", 4},          {"IRAQ", 4},       {"JAPAN", 2},         {"JORDAN", 4},        {"KENYA", 0},
+     {"MOROCCO", 0},       {"MOZAMBIQUE", 0}, {"PERU", 1},          {"CHINA", 2},         {"ROMANIA", 3},
+     {"SAUDI ARABIA", 4},  {"VIETNAM", 2},    {"RUSSIA", 3},        {"UNITED KINGDOM", 3}, {"UNITED STATES", 1}}};
+constexpr std::array<std::string_view, 92> COLORS{
+    "almond",    "antique",   "aquamarine", "azure",     "beige",     "bisque",    "black",     "blanched",
+    "blue",      "blush",     "brown",      "burlywood", "burnished", "chartreuse", "chiffon",  "chocolate",
+    "coral",     "cornflower", "cornsilk",  "cream",     "cyan",      "dark",      "deep",      "dim",
+    "dodger",    "drab",      "firebrick",  "floral",    "forest",    "frosted",   "gainsboro", "ghost",
+    "goldenrod", "green",     "grey",       "honeydew",  "hot",       "indian",    "ivory",     "khaki",
+    "lace",      "lavender",  "lawn",       "lemon",     "light",     "lime",      "linen",     "magenta",
+    "maroon",    "medium",    "metallic",   "midnight",  "mint",      "misty",     "moccasin",  "navajo",
+    "navy",      "olive",     "orange",     "orchid",    "pale",      "papaya",    "peach",     "peru",
+    "pink",      "plum",      "powder",     "puff",      "purple",    "red",       "rose",      "rosy",
+    "royal",     "saddle",    "salmon",     "sandy",     "seashell",  "sienna",    "sky",       "slate",
+    "smoke",     "snow",      "spring",     "steel",     "tan",       "thistle",   "tomato",    "turquoise",
+    "violet",    "wheat",     "white",      "yellow"};
+constexpr std::array<std::string_view, 6> TYPE_SIZES{"STANDARD", "SMALL", "MEDIUM", "LARGE", "ECONOMY", "PROMO"};
+constexpr std::array<std::string_view, 5> TYPE_FINISHES{"ANODIZED", "BURNISHED", "PLATED", "POLISHED", "BRUSHED"};
+constexpr std::array<std::string_view, 5> TYPE_METALS{"TIN", "NICKEL", "BRASS", "STEEL", "COPPER"};
+constexpr std::array<std::string_view, 5> CONTAINER_SIZES{"SM", "LG", "MED", "JUMBO", "WRAP"};
+constexpr std::array<std::string_view, 8> CONTAINER_KINDS{"CASE", "BOX", "BAG", "JAR", "PKG", "PACK", "CAN", "DRUM"};
+constexpr std::array<std::string_view, 5> SEGMENTS{"AUTOMOBILE", "BUILDING", "FURNITURE", "MACHINERY", "HOUSEHOLD"};
+constexpr std::array<std::string_view, 5> PRIORITIES{"1-URGENT", "2-HIGH", "3-MEDIUM", "4-NOT SPECIFIED", "5-LOW"};
+constexpr std::array<std::string_view, 4> INSTRUCTIONS{"DELIVER IN PERSON", "COLLECT COD", "NONE",
+                                                       "TAKE BACK RETURN"};
+constexpr std::array<std::string_view, 7> SHIP_MODES{"REG AIR", "AIR", "RAIL", "SHIP", "TRUCK", "MAIL", "FOB"};
+// The words of the comments, with those that Q13 and Q16 look for
+constexpr std::array<std::string_view, 32> WORDS{
+    "furiously", "quickly",  "carefully", "blithely", "slyly",    "ironic",  "final",    "regular",
+    "express",   "pending",  "bold",      "even",     "special",  "silent",  "unusual", "fluffy",
+    "requests",  "deposits", "packages",  "accounts", "theodolites", "pinto", "beans",   "instructions",
+    "foxes",     "ideas",    "dependencies", "excuses", "platelets", "asymptotes", "courts", "dolphins"};
+
+// Days since 1970-01-01 of a date, and the date of such a day (http://howardhinnant.github.io/date_algorithms.html)
+int64_t DaysFromCivil(int64_t y, const int64_t m, const int64_t d) {
+  y -= static_cast<int64_t>(m <= 2);
+  const int64_t era = (y >= 0 ? y : y - 399) / 400;
+  const int64_t yoe = y - era * 400;
+  const int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097 + doe - 719468;
+}
+
+std::string CivilFromDays(int64_t z) {
+  z += 719468;
+  const int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+  const int64_t doe = z - era * 146097;
+  const int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+  const int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+  const int64_t mp = (5 * doy + 2) / 153;
+  const int64_t d = doy - (153 * mp + 2) / 5 + 1;
+  const int64_t m = mp + (mp < 10 ? 3 : -9);
+  return fmt::format("{:04}-{:02}-{:02}", yoe + era * 400 + static_cast<int64_t>(m <= 2), m, d);
+}
+
+const int64_t START_DATE = DaysFromCivil(1992, 1, 1);
+const int64_t END_DATE = DaysFromCivil(1998, 12, 31);
+const int64_t CURRENT_DATE = DaysFromCivil(1995, 6, 17);
+
+class Random {
+ public:
+  explicit Random(const uint64_t seed) : generator_(seed) {}
+
+  int64_t Uniform(const int64_t low, const int64_t high) {
+    return std::uniform_int_distribution<int64_t>(low, high)(generator_);
+  }
+
+  template <class T, size_t N>
+  std::string_view Pick(const std::array<T, N> &values) {
+    return values[Uniform(0, N - 1)];
+  }
+
+  // A decimal of two digits between the bounds, which are given in cents
+  std::string Money(const int64_t low_cents, const int64_t high_cents) { return Cents(Uniform(low_cents, high_cents)); }
+
+  static std::string Cents(const int64_t cents) {
+    return fmt::format("{}{}.{:02}", cents < 0 ? "-" : "", std::abs(cents) / 100, std::abs(cents) % 100);
+  }
+
+  // Random words of a length between the bounds
+  std::string Text(const size_t min_length, const size_t max_length) {
+    const auto length = static_cast<size_t>(Uniform(min_length, max_length));
+    std::string text;
+    while (text.size() < length) {
+      if (!text.empty()) text += ' ';
+      text += Pick(WORDS);
+    }
+    text.resize(length);
+    while (!text.empty() && text.back() == ' ') text.pop_back();
+    return text;
+  }
+
+  // A random alphanumeric string of a length between the bounds
+  std::string Address(const size_t min_length, const size_t max_length) {
+    static constexpr std::string_view CHARS = "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    std::string address(static_cast<size_t>(Uniform(min_length, max_length)), ' ');
+    for (auto &c : address) c = CHARS[Uniform(0, CHARS.size() - 1)];
+    return address;
+  }
+
+  std::string Phone(const int64_t nation_key) {
+    return fmt::format("{:02}-{:03}-{:03}-{:04}", nation_key + 10, Uniform(100, 999), Uniform(100, 999),
+                       Uniform(1000, 9999));
+  }
+
+ private:
+  std::mt19937_64 generator_;
+};
+
+// The schema of a table, with an index on the columns of its primary key
+void WriteSchema(const std::string &dir_name, const std::string &table_name,
+                 const std::vector<std::pair<std::string, std::string>> &columns,
+                 const std::vector<uint16_t> &primary_key) {
+  std::ofstream schema(dir_name + table_name + ".schema");
+  schema << table_name << ' ' << columns.size() << '\n';
+  for (const auto &[name, type] : columns) schema << name << ' ' << type << '\n';
+  schema << (primary_key.empty() ? 0 : 1) << '\n';
+  if (!primary_key.empty()) {
+    schema << table_name << "_pk " << primary_key.size();
+    for (const auto col_idx : primary_key) schema << ' ' << col_idx;
+    schema << '\n';
+  }
+}
+
+// Fields of a row are written as dbgen does, each followed by a '|'
+class DataWriter {
+ public:
+  DataWriter(const std::string &dir_name, const std::string &table_name) : file_(dir_name + table_name + ".data") {}
+
+  template <class... Fields>
+  void WriteRow(const Fields &... fields) {
+    ((file_ << fields << '|'), ...);
+    file_ << '\n';
+    num_rows_++;
+  }
+
+  uint64_t NumRows() const { return num_rows_; }
+
+ private:
+  std::ofstream file_;
+  uint64_t num_rows_ = 0;
+};
+
+// Retail price of a part, which is not random so that lineitems can price their parts (section 4.2.3)
+int64_t RetailPriceCents(const int64_t part_key) {
+  return 90000 + ((part_key / 10) % 20001) + 100 * (part_key % 1000);
+}
+
+// The i-th supplier of a part out of num_suppliers (section 4.2.3, PS_SUPPKEY)
+int64_t PartSupplier(const int64_t part_key, const int64_t i, const int64_t num_suppliers) {
+  if (num_suppliers < 4) return (part_key + i) % num_suppliers + 1;
+  return (part_key + (i * (num_suppliers / 4 + (part_key - 1) / num_suppliers))) % num_suppliers + 1;
+}
+
+}  // namespace
+
+std::vector<uint64_t> TPCHGenerator::Generate(const double scale_factor, const std::string &dir_name,
+                                              const uint64_t seed) {
+  NOISEPAGE_ASSERT(scale_factor > 0, "The scale factor has to be positive");
+  const auto scaled = [scale_factor](const double rows) {
+    return std::max<int64_t>(1, static_cast<int64_t>(std::llround(rows * scale_factor)));
+  };
+  const int64_t num_suppliers = scaled(10000);
+  const int64_t num_parts = scaled(200000);
+  const int64_t num_customers = scaled(150000);
+  const int64_t num_orders = scaled(1500000);
+  const int64_t num_clerks = scaled(1000);
+  const int64_t suppliers_per_part = std::min<int64_t>(4, num_suppliers);
+  Random random(seed);
+  std::vector<uint64_t> num_rows;
+
+  WriteSchema(dir_name, "region",
+              {{"r_regionkey", "int 0"}, {"r_name", "varchar 0 25"}, {"r_comment", "varchar 0 152"}}, {0});
+  DataWriter region(dir_name, "region");
+  for (size_t i = 0; i < REGIONS.size(); i++) region.WriteRow(i, REGIONS[i], random.Text(31, 115));
+  num_rows.push_back(region.NumRows());
+
+  WriteSchema(dir_name, "nation",
+              {{"n_nationkey", "int 0"},
+               {"n_name", "varchar 0 25"},
+               {"n_regionkey", "int 0"},
+               {"n_comment", "varchar 0 152"}},
+              {0});
+  DataWriter nation(dir_name, "nation");
+  for (size_t i = 0; i < NATIONS.size(); i++) {
+    nation.WriteRow(i, NATIONS[i].first, NATIONS[i].second, random.Text(31, 114));
+  }
+  num_rows.push_back(nation.NumRows());
+
+  WriteSchema(dir_name, "supplier",
+              {{"s_suppkey", "int 0"},
+               {"s_name", "varchar 0 25"},
+               {"s_address", "varchar 0 40"},
+               {"s_nationkey", "int 0"},
+               {"s_phone", "varchar 0 15"},
+               {"s_acctbal", "decimal 0"},
+               {"s_comment", "varchar 0 101"}},
+              {0});
+  DataWriter supplier(dir_name, "supplier");
+  for (int64_t key = 1; key <= num_suppliers; key++) {
+    const int64_t nation_key = random.Uniform(0, NATIONS.size() - 1);
+    std::string comment = random.Text(25, 100);
+    // 5 in 10000 suppliers have had complaints (Q16), and as many recommendations
+    const int64_t remark = random.Uniform(0, 9999);
+    if (remark < 10) {
+      comment = fmt::format("{} Customer {}", comment.substr(0, 40), remark < 5 ? "Complaints" : "Recommends");
+    }
+    supplier.WriteRow(key, fmt::format("Supplier#{:09}", key), random.Address(10, 40), nation_key,
+                      random.Phone(nation_key), random.Money(-99999, 999999), comment);
+  }
+  num_rows.push_back(supplier.NumRows());
+
+  WriteSchema(dir_name, "part",
+              {{"p_partkey", "int 0"},
+               {"p_name", "varchar 0 55"},
+               {"p_mfgr", "varchar 0 25"},
+               {"p_brand", "varchar 0 10"},
+               {"p_type", "varchar 0 25"},
+               {"p_size", "int 0"},
+               {"p_container", "varchar 0 10"},
+               {"p_retailprice", "decimal 0"},
+               {"p_comment", "varchar 0 23"}},
+              {0});
+  DataWriter part(dir_name, "part");
+  for (int64_t key = 1; key <= num_parts; key++) {
+    std::string name;
+    for (int i = 0; i < 5; i++) name += (i == 0 ? "" : " ") + std::string(random.Pick(COLORS));
+    const int64_t manufacturer = random.Uniform(1, 5);
+    part.WriteRow(key, name, fmt::format("Manufacturer#{}", manufacturer),
+                  fmt::format("Brand#{}{}", manufacturer, random.Uniform(1, 5)),
+                  fmt::format("{} {} {}", random.Pick(TYPE_SIZES), random.Pick(TYPE_FINISHES),
+                              random.Pick(TYPE_METALS)),
+                  random.Uniform(1, 50),
+                  fmt::format("{} {}", random.Pick(CONTAINER_SIZES), random.Pick(CONTAINER_KINDS)),
+                  Random::Cents(RetailPriceCents(key)), random.Text(5, 22));
+  }
+  num_rows.push_back(part.NumRows());
+
+  WriteSchema(dir_name, "partsupp",
+              {{"ps_partkey", "int 0"},
+               {"ps_suppkey", "int 0"},
+               {"ps_availqty", "int 0"},
+               {"ps_supplycost", "decimal 0"},
+               {"ps_comment", "varchar 0 199"}},
+              {0, 1});
+  DataWriter partsupp(dir_name, "partsupp");
+  for (int64_t key = 1; key <= num_parts; key++) {
+    for (int64_t i = 0; i < suppliers_per_part; i++) {
+      partsupp.WriteRow(key, PartSupplier(key, i, num_suppliers), random.Uniform(1, 9999), random.Money(100, 100000),
+                        random.Text(49, 198));
+    }
+  }
+  num_rows.push_back(partsupp.NumRows());
+
+  WriteSchema(dir_name, "customer",
+              {{"c_custkey", "int 0"},
+               {"c_name", "varchar 0 25"},
+               {"c_address", "varchar 0 40"},
+               {"c_nationkey", "int 0"},
+               {"c_phone", "varchar 0 15"},
+               {"c_acctbal", "decimal 0"},
+               {"c_mktsegment", "varchar 0 10"},
+               {"c_comment", "varchar 0 117"}},
+              {0});
+  DataWriter customer(dir_name, "customer");
+  for (int64_t key = 1; key <= num_customers; key++) {
+    const int64_t nation_key = random.Uniform(0, NATIONS.size() - 1);
+    customer.WriteRow(key, fmt::format("Customer#{:09}", key), random.Address(10, 40), nation_key,
+                      random.Phone(nation_key), random.Money(-99999, 999999), random.Pick(SEGMENTS),
+                      random.Text(29, 116));
+  }
+  num_rows.push_back(customer.NumRows());
+
+  WriteSchema(dir_name, "orders",
+              {{"o_orderkey", "int 0"},
+               {"o_custkey", "int 0"},
+               {"o_orderstatus", "varchar 0 1"},
+               {"o_totalprice", "decimal 0"},
+               {"o_orderdate", "date 0"},
+               {"o_orderpriority", "varchar 0 15"},
+               {"o_clerk", "varchar 0 15"},
+               {"o_shippriority", "int 0"},
+               {"o_comment", "varchar 0 79"}},
+              {0});
+  WriteSchema(dir_name, "lineitem",
+              {{"l_orderkey", "int 0"},
+               {"l_partkey", "int 0"},
+               {"l_suppkey", "int 0"},
+               {"l_linenumber", "int 0"},
+               {"l_quantity", "decimal 0"},
+               {"l_extendedprice", "decimal 0"},
+               {"l_discount", "decimal 0"},
+               {"l_tax", "decimal 0"},
+               {"l_returnflag", "varchar 0 1"},
+               {"l_linestatus", "varchar 0 1"},
+               {"l_shipdate", "date 0"},
+               {"l_commitdate", "date 0"},
+               {"l_receiptdate", "date 0"},
+               {"l_shipinstruct", "varchar 0 25"},
+               {"l_shipmode", "varchar 0 10"},
+               {"l_comment", "varchar 0 44"}},
+              {0, 3});
+  DataWriter orders(dir_name, "orders");
+  DataWriter lineitem(dir_name, "lineitem");
+  for (int64_t i = 0; i < num_orders; i++) {
+    // Only the first 8 of every 32 keys are used, and a third of the customers never order
+    const int64_t order_key = (i / 8) * 32 + i % 8 + 1;
+    int64_t customer_key = random.Uniform(1, num_customers);
+    while (num_customers >= 3 && customer_key % 3 == 0) customer_key = random.Uniform(1, num_customers);
+    const int64_t order_date = random.Uniform(START_DATE, END_DATE - 151);
+
+    int64_t total_cents = 0;
+    int64_t num_shipped = 0;
+    const int64_t num_lines = random.Uniform(1, 7);
+    for (int64_t line = 1; line <= num_lines; line++) {
+      const int64_t part_key = random.Uniform(1, num_parts);
+      const int64_t quantity = random.Uniform(1, 50);
+      const int64_t price_cents = quantity * RetailPriceCents(part_key);
+      const int64_t discount = random.Uniform(0, 10);
+      const int64_t tax = random.Uniform(0, 8);
+      const int64_t ship_date = order_date + random.Uniform(1, 121);
+      const int64_t receipt_date = ship_date + random.Uniform(1, 30);
+      const bool shipped = ship_date <= CURRENT_DATE;
+      num_shipped += shipped ? 1 : 0;
+      total_cents += price_cents * (100 + tax) * (100 - discount) / 10000;
+      lineitem.WriteRow(order_key, part_key,
+                        PartSupplier(part_key, random.Uniform(0, suppliers_per_part - 1), num_suppliers), line,
+                        quantity, Random::Cents(price_cents), Random::Cents(discount), Random::Cents(tax),
+                        receipt_date <= CURRENT_DATE ? (random.Uniform(0, 1) == 0 ? "R" : "A") : "N",
+                        shipped ? "F" : "O", CivilFromDays(ship_date),
+                        CivilFromDays(order_date + random.Uniform(30, 90)), CivilFromDays(receipt_date),
+                        random.Pick(INSTRUCTIONS), random.Pick(SHIP_MODES), random.Text(10, 43));
+    }
+
+    const char *status = num_shipped == num_lines ? "F" : (num_shipped == 0 ? "O" : "P");
+    orders.WriteRow(order_key, customer_key, status, Random::Cents(total_cents), CivilFromDays(order_date),
+                    random.Pick(PRIORITIES), fmt::format("Clerk#{:09}", random.Uniform(1, num_clerks)), 0,
+                    random.Text(19, 78));
+  }
+  num_rows.push_back(orders.NumRows());
+  num_rows.push_back(lineitem.NumRows());
+  return num_rows;
+}
+
+}  // namespace noisepage::tpch
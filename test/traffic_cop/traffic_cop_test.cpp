@@ -1,24 +1,41 @@
 #include "traffic_cop/traffic_cop.h"
 
+#include <chrono>  // NOLINT
 #include <memory>
 #include <pqxx/pqxx>  // NOLINT
 #include <string>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "common/settings.h"
+#include "execution/sql/value.h"
 #include "gtest/gtest.h"
 #include "main/db_main.h"
+#include "network/postgres/statement.h"
+#include "optimizer/optimize_result.h"
+#include "parser/expression/constant_value_expression.h"
+#include "parser/postgresparser.h"
+#include "settings/settings_callbacks.h"
+#include "test_util/manual_packet_util.h"
 #include "test_util/test_harness.h"
 
 namespace noisepage::trafficcop {
 
 class TrafficCopTests : public TerrierTest {
  protected:
-  void StartServer(const bool wal_async_commit_enable) {
+  void StartServer(const bool wal_async_commit_enable, const int64_t result_cache_size = 0) {
     std::unordered_map<settings::Param, settings::ParamInfo> param_map;
     noisepage::settings::SettingsManager::ConstructParamMap(param_map);
+    param_map.erase(settings::Param::result_cache_size);
+    param_map.emplace(
+        settings::Param::result_cache_size,
+        settings::ParamInfo("result_cache_size",
+                            parser::ConstantValueExpression(type::TypeId::BIGINT,
+                                                            execution::sql::Integer(result_cache_size)),
+                            "", parser::ConstantValueExpression(type::TypeId::BIGINT, execution::sql::Integer(0)),
+                            false, 0, 1 << 30, settings::Callbacks::NoOp));
 
     db_main_ = noisepage::DBMain::Builder()
                    .SetSettingsParameterMap(std::move(param_map))
@@ -41,6 +58,17 @@ class TrafficCopTests : public TerrierTest {
     txn_manager_ = db_main_->GetTransactionLayer()->GetTransactionManager();
   }
 
+  // A table whose three-way cross join, LONG_QUERY, takes much longer than the tests wait
+  static constexpr int64_t LONG_QUERY_TABLE_SIZE = 1000;
+  static constexpr const char *LONG_QUERY = "SELECT COUNT(*) FROM foo AS a, foo AS b, foo AS c;";
+
+  static void CreateLongQueryTable(pqxx::nontransaction *const txn) {
+    txn->exec("CREATE TABLE foo (a INT);");
+    std::string insert = "INSERT INTO foo VALUES (0)";
+    for (int64_t i = 1; i < LONG_QUERY_TABLE_SIZE; i++) insert += fmt::format(", ({})", i);
+    txn->exec(insert + ";");
+  }
+
   std::unique_ptr<DBMain> db_main_;
   uint16_t port_;
   common::ManagedPointer<catalog::Catalog> catalog_;
@@ -145,31 +173,280 @@ TEST_F(TrafficCopTests, BasicTest) {
 }
 
 /**
- * Test whether a temporary namespace is created for a connection to the database
+ * Test that equal plans share one compiled query across connections, and that DDL invalidates it
  */
 // NOLINTNEXTLINE
-TEST_F(TrafficCopTests, TemporaryNamespaceTest) {
+TEST_F(TrafficCopTests, CompiledQueryCacheTest) {
   StartServer(false);
   try {
+    const auto cache = db_main_->GetTrafficCop()->GetCompiledQueryCache();
+    pqxx::connection connection1(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                             port_, catalog::DEFAULT_DATABASE));
+    pqxx::connection connection2(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                             port_, catalog::DEFAULT_DATABASE));
+
+    {
+      pqxx::work txn(connection1);
+      txn.exec("CREATE TABLE TableA (id INT PRIMARY KEY, data TEXT);");
+      txn.exec("INSERT INTO TableA VALUES (1, 'abc');");
+      txn.commit();
+    }
+    // Committing the DDL dropped everything compiled before it
+    EXPECT_EQ(cache->Size(), 0U);
+
+    {
+      pqxx::work txn(connection1);
+      pqxx::result r = txn.exec("SELECT * FROM TableA");
+      EXPECT_EQ(r.size(), 1);
+      txn.commit();
+    }
+    EXPECT_EQ(cache->Size(), 1U);
+
+    // Different text for the same plan on another connection reuses the compiled query
+    {
+      pqxx::work txn(connection2);
+      pqxx::result r = txn.exec("select *   from tablea");
+      EXPECT_EQ(r.size(), 1);
+      txn.commit();
+    }
+    EXPECT_EQ(cache->Size(), 1U);
+
+    {
+      pqxx::work txn(connection2);
+      txn.exec("DROP TABLE TableA");
+      txn.commit();
+    }
+    EXPECT_EQ(cache->Size(), 0U);
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false);
+  }
+}
+
+/**
+ * Test that a repeated read-only query is served from the result cache until a write to its table commits
+ */
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, ResultCacheTest) {
+  StartServer(false, 1 << 20);
+  try {
+    const auto cache = db_main_->GetTrafficCop()->GetResultCache();
+    ASSERT_NE(cache.Get(), nullptr);
     pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
                                             port_, catalog::DEFAULT_DATABASE));
+    // Long enough not to be inlined, so the cache keeps a copy of its own
+    const std::string data = "a string that does not fit in a varlen entry";
 
-    pqxx::work txn1(connection);
+    {
+      pqxx::work txn(connection);
+      txn.exec("CREATE TABLE TableA (id INT PRIMARY KEY, data TEXT);");
+      txn.exec(fmt::format("INSERT INTO TableA VALUES (1, '{}');", data));
+      txn.commit();
+    }
 
-    // Create a new namespace and make sure that its OID is higher than the default start OID,
-    // which should have been assigned to the temporary namespace for this connection
-    catalog::namespace_oid_t new_namespace_oid = catalog::INVALID_NAMESPACE_OID;
-    do {
-      auto txn = txn_manager_->BeginTransaction();
-      auto db_oid = catalog_->GetDatabaseOid(common::ManagedPointer(txn), catalog::DEFAULT_DATABASE);
-      EXPECT_NE(db_oid, catalog::INVALID_DATABASE_OID);
-      auto db_accessor = catalog_->GetAccessor(common::ManagedPointer(txn), db_oid, DISABLED);
-      EXPECT_NE(db_accessor, nullptr);
-      new_namespace_oid = db_accessor->CreateNamespace(std::string(trafficcop::TEMP_NAMESPACE_PREFIX));
-      txn_manager_->Abort(txn);
-    } while (new_namespace_oid == catalog::INVALID_NAMESPACE_OID);
-    EXPECT_GT(new_namespace_oid.UnderlyingValue(), catalog::START_OID);
-    txn1.commit();
+    for (int i = 0; i < 2; i++) {
+      pqxx::work txn(connection);
+      pqxx::result r = txn.exec("SELECT * FROM TableA WHERE id > 0");
+      ASSERT_EQ(r.size(), 1);
+      EXPECT_EQ(r[0][1].as<std::string>(), data);
+      txn.commit();
+    }
+    EXPECT_EQ(cache->Size(), 1U);
+    EXPECT_EQ(cache->GetNumHits(), 1U);
+
+    // The cached result is out of date once the insert commits
+    {
+      pqxx::work txn(connection);
+      txn.exec("INSERT INTO TableA VALUES (2, 'b');");
+      txn.commit();
+    }
+    {
+      pqxx::work txn(connection);
+      pqxx::result r = txn.exec("SELECT * FROM TableA WHERE id > 0");
+      EXPECT_EQ(r.size(), 2);
+      txn.commit();
+    }
+    EXPECT_EQ(cache->Size(), 1U);
+    EXPECT_EQ(cache->GetNumHits(), 1U);
+
+    {
+      pqxx::work txn(connection);
+      txn.exec("DROP TABLE TableA");
+      txn.commit();
+    }
+    EXPECT_EQ(cache->Size(), 0U);
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false);
+  }
+}
+
+/**
+ * Test that a statement prepared on one connection is found by another connection preparing it again
+ */
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, SharedPreparedStatementTest) {
+  EXPECT_EQ(trafficcop::CompiledQueryCache::NormalizeQueryText("  SELECT *\n\tFROM t  WHERE s = ' a  b ';  "),
+            "SELECT * FROM t WHERE s = ' a  b '");
+
+  StartServer(false);
+  try {
+    const auto cache = db_main_->GetTrafficCop()->GetCompiledQueryCache();
+    pqxx::connection connection1(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                             port_, catalog::DEFAULT_DATABASE));
+    pqxx::connection connection2(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                             port_, catalog::DEFAULT_DATABASE));
+
+    {
+      pqxx::work txn(connection1);
+      txn.exec("CREATE TABLE TableA (id INT PRIMARY KEY, data TEXT);");
+      txn.exec("INSERT INTO TableA VALUES (1, 'abc');");
+      txn.exec("INSERT INTO TableA VALUES (2, 'def');");
+      txn.commit();
+    }
+
+    connection1.prepare("select_data", "SELECT data FROM TableA WHERE id = $1");
+    {
+      pqxx::work txn(connection1);
+      pqxx::result r = txn.exec_prepared("select_data", 1);
+      ASSERT_EQ(r.size(), 1);
+      EXPECT_EQ(r[0][0].as<std::string>(), "abc");
+      txn.commit();
+    }
+    EXPECT_EQ(cache->Size(), 1U);
+
+    // The other connection finds the statement, whitespace aside, and binds it to its own parameters
+    connection2.prepare("select_data", "SELECT data  FROM TableA\nWHERE id = $1;");
+    {
+      pqxx::work txn(connection2);
+      pqxx::result r = txn.exec_prepared("select_data", 2);
+      ASSERT_EQ(r.size(), 1);
+      EXPECT_EQ(r[0][0].as<std::string>(), "def");
+      txn.commit();
+    }
+    EXPECT_EQ(cache->Size(), 1U);
+
+    {
+      pqxx::work txn(connection2);
+      txn.exec("DROP TABLE TableA");
+      txn.commit();
+    }
+    EXPECT_EQ(cache->Size(), 0U);
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false);
+  }
+}
+
+/**
+ * Test that a statement keeps a plan for each selectivity bucket of its parameters, and evicts the oldest one
+ */
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, PlanVariantTest) {
+  std::string query_text = "SELECT * FROM t WHERE s = $1";
+  auto parse_result = parser::PostgresParser::BuildParseTree(query_text);
+  network::Statement statement(std::move(query_text), std::move(parse_result));
+
+  // The first plan is adopted for the buckets it is first bound with
+  const auto first = std::make_shared<optimizer::OptimizeResult>();
+  statement.SetOptimizeResult(first);
+  statement.UsePlanVariant({0});
+  EXPECT_EQ(statement.OptimizeResult().Get(), first.get());
+
+  // Other buckets leave the statement to be optimized again, and their plans become current
+  std::vector<std::shared_ptr<optimizer::OptimizeResult>> variants{first};
+  for (uint8_t bucket = 1; bucket <= network::Statement::MAX_PLAN_VARIANTS; bucket++) {
+    statement.UsePlanVariant({bucket});
+    EXPECT_EQ(statement.OptimizeResult().Get(), nullptr);
+    variants.emplace_back(std::make_shared<optimizer::OptimizeResult>());
+    statement.SetOptimizeResult(variants.back());
+  }
+
+  // Binding the same buckets again keeps the current plan, binding earlier ones brings their plans back
+  statement.UsePlanVariant({network::Statement::MAX_PLAN_VARIANTS});
+  EXPECT_EQ(statement.OptimizeResult().Get(), variants.back().get());
+  statement.UsePlanVariant({1});
+  EXPECT_EQ(statement.OptimizeResult().Get(), variants[1].get());
+
+  // The plan for the first buckets was the oldest one set aside once there were too many
+  statement.UsePlanVariant({0});
+  EXPECT_EQ(statement.OptimizeResult().Get(), nullptr);
+
+  statement.ClearCachedObjects();
+  statement.UsePlanVariant({1});
+  EXPECT_EQ(statement.OptimizeResult().Get(), nullptr);
+}
+
+/**
+ * Test that a prepared statement returns the right rows for parameters that select few and many rows alike
+ */
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, ParameterSensitivePlanTest) {
+  StartServer(false);
+  try {
+    pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                            port_, catalog::DEFAULT_DATABASE));
+
+    {
+      pqxx::work txn(connection);
+      txn.exec("CREATE TABLE orders (id INT, status VARCHAR(16));");
+      std::string insert = "INSERT INTO orders VALUES (0, 'rare')";
+      for (int i = 1; i < 1000; i++) insert += fmt::format(", ({}, 'common')", i);
+      txn.exec(insert + ";");
+      txn.exec("ANALYZE orders;");
+      txn.commit();
+    }
+
+    connection.prepare("count_status", "SELECT COUNT(*) FROM orders WHERE status = $1");
+    for (const auto &[status, count] : std::vector<std::pair<std::string, int64_t>>{
+             {"rare", 1}, {"common", 999}, {"rare", 1}, {"missing", 0}, {"common", 999}}) {
+      pqxx::work txn(connection);
+      pqxx::result r = txn.exec_prepared("count_status", status);
+      ASSERT_EQ(r.size(), 1);
+      EXPECT_EQ(r[0][0].as<int64_t>(), count);
+      txn.commit();
+    }
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false);
+  }
+}
+
+/**
+ * Test that the temporary namespace of a connection is created with its first temporary table, and that its temporary
+ * tables are not visible to other connections
+ */
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, TemporaryNamespaceTest) {
+  StartServer(false);
+  try {
+    pqxx::connection connection1(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                             port_, catalog::DEFAULT_DATABASE));
+    pqxx::connection connection2(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                             port_, catalog::DEFAULT_DATABASE));
+
+    // Until a connection creates a temporary table, pg_temp refers to nothing
+    {
+      pqxx::work txn(connection1);
+      EXPECT_THROW(txn.exec("SELECT a FROM pg_temp.foo;"), pqxx::sql_error);
+    }
+
+    {
+      pqxx::work txn(connection1);
+      txn.exec("CREATE TEMP TABLE foo (a INT);");
+      txn.commit();
+    }
+    {
+      pqxx::work txn(connection1);
+      txn.exec("INSERT INTO foo VALUES (1);");
+      EXPECT_EQ(txn.exec("SELECT a FROM pg_temp.foo;").size(), 1);
+      txn.commit();
+    }
+
+    {
+      pqxx::work txn(connection2);
+      EXPECT_THROW(txn.exec("SELECT a FROM foo;"), pqxx::sql_error);
+    }
+    {
+      pqxx::work txn(connection2);
+      EXPECT_THROW(txn.exec("SELECT a FROM pg_temp.foo;"), pqxx::sql_error);
+    }
   } catch (const std::exception &e) {
     EXPECT_TRUE(false);
   }
@@ -191,6 +468,57 @@ TEST_F(TrafficCopTests, ArithmeticErrorTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, StatementTimeoutTest) {
+  StartServer(false);
+  pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                          port_, catalog::DEFAULT_DATABASE));
+  pqxx::nontransaction txn(connection);
+  CreateLongQueryTable(&txn);
+
+  txn.exec("SET statement_timeout = 100;");
+  try {
+    txn.exec(LONG_QUERY);
+    EXPECT_TRUE(false);
+  } catch (const pqxx::sql_error &e) {
+    EXPECT_EQ(e.sqlstate(), "57014");
+    EXPECT_NE(std::string(e.what()).find("statement timeout"), std::string::npos);
+  }
+
+  txn.exec("SET statement_timeout = 0;");
+  pqxx::result r = txn.exec("SELECT COUNT(*) FROM foo;");
+  EXPECT_EQ(r[0][0].as<int64_t>(), LONG_QUERY_TABLE_SIZE);
+}
+
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, CancelRequestTest) {
+  StartServer(false);
+  pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                          port_, catalog::DEFAULT_DATABASE));
+  pqxx::nontransaction txn(connection);
+  CreateLongQueryTable(&txn);
+  // Don't wait forever if the cancel request comes in before the query starts
+  txn.exec("SET statement_timeout = 10000;");
+
+  std::thread canceler([&connection] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    connection.cancel_query();
+  });
+  try {
+    txn.exec(LONG_QUERY);
+    EXPECT_TRUE(false);
+  } catch (const pqxx::sql_error &e) {
+    EXPECT_EQ(e.sqlstate(), "57014");
+    EXPECT_NE(std::string(e.what()).find("user request"), std::string::npos);
+  }
+  canceler.join();
+
+  // The connection carries on
+  txn.exec("SET statement_timeout = 0;");
+  pqxx::result r = txn.exec("SELECT COUNT(*) FROM foo;");
+  EXPECT_EQ(r[0][0].as<int64_t>(), LONG_QUERY_TABLE_SIZE);
+}
+
 // NOLINTNEXTLINE
 TEST_F(TrafficCopTests, AsyncCommitTest) {
   StartServer(true);
@@ -210,4 +538,87 @@ TEST_F(TrafficCopTests, AsyncCommitTest) {
   }
 }
 
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, SyncCommitTest) {
+  StartServer(false);
+  try {
+    pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                            port_, catalog::DEFAULT_DATABASE));
+    pqxx::nontransaction setup(connection);
+    setup.exec("CREATE TABLE TableA (id INT PRIMARY KEY);");
+    setup.commit();
+
+    // Every commit waits for its log records to be durable without holding up the connection handler thread
+    for (int32_t i = 0; i < 10; i++) {
+      pqxx::work txn(connection);
+      txn.exec(fmt::format("INSERT INTO TableA VALUES ({});", i));
+      txn.commit();
+    }
+
+    // Several commits in one query string are acknowledged once all of them are durable
+    pqxx::nontransaction txn(connection);
+    txn.exec("BEGIN; INSERT INTO TableA VALUES (10); COMMIT; BEGIN; INSERT INTO TableA VALUES (11); COMMIT;");
+
+    pqxx::connection other(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                       port_, catalog::DEFAULT_DATABASE));
+    pqxx::work check(other);
+    pqxx::result r = check.exec("SELECT COUNT(*) FROM TableA;");
+    EXPECT_EQ(r[0][0].as<int64_t>(), 12);
+    check.commit();
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false);
+  }
+}
+
+// NOLINTNEXTLINE
+TEST_F(TrafficCopTests, PortalSuspendTest) {
+  StartServer(false);
+  try {
+    pqxx::connection connection(fmt::format("host=127.0.0.1 port={0} user={1} sslmode=disable application_name=psql",
+                                            port_, catalog::DEFAULT_DATABASE));
+    pqxx::nontransaction setup(connection);
+    setup.exec("CREATE TABLE foo (a INT);");
+    setup.exec("INSERT INTO foo VALUES (1), (2), (3), (4), (5);");
+  } catch (const std::exception &e) {
+    EXPECT_TRUE(false);
+  }
+
+  // libpq always fetches every row of a portal, so the messages are written by hand
+  auto io_socket_unique_ptr = network::ManualPacketUtil::StartConnection(port_);
+  auto io_socket = common::ManagedPointer(io_socket_unique_ptr);
+  network::PostgresPacketWriter writer(io_socket->GetWriteQueue());
+  writer.WriteParseCommand("", "SELECT a FROM foo;", {});
+  writer.WriteBindCommand("", "", {}, {}, {});
+  // Two rows, two rows, and the last row
+  writer.WriteExecuteCommand("", 2);
+  writer.WriteExecuteCommand("", 2);
+  writer.WriteExecuteCommand("", 2);
+  writer.WriteSyncCommand();
+  io_socket->FlushAllWrites();
+
+  uint32_t num_data_rows = 0;
+  uint32_t num_suspended = 0;
+  uint32_t num_complete = 0;
+  bool ready = false;
+  while (!ready && io_socket->FillReadBuffer() != network::Transition::TERMINATE) {
+    while (io_socket->GetReadBuffer()->HasMore()) {
+      const auto type = io_socket->GetReadBuffer()->ReadValue<network::NetworkMessageType>();
+      const auto size = io_socket->GetReadBuffer()->ReadValue<int32_t>();
+      if (size >= 4) io_socket->GetReadBuffer()->Skip(static_cast<size_t>(size - 4));
+      num_data_rows += static_cast<uint32_t>(type == network::NetworkMessageType::PG_DATA_ROW);
+      num_suspended += static_cast<uint32_t>(type == network::NetworkMessageType::PG_PORTAL_SUSPENDED);
+      num_complete += static_cast<uint32_t>(type == network::NetworkMessageType::PG_COMMAND_COMPLETE);
+      ready = ready || type == network::NetworkMessageType::PG_READY_FOR_QUERY;
+    }
+    io_socket->GetReadBuffer()->Reset();
+  }
+  EXPECT_TRUE(ready);
+  EXPECT_EQ(num_data_rows, 5);
+  EXPECT_EQ(num_suspended, 2);
+  EXPECT_EQ(num_complete, 1);
+
+  network::ManualPacketUtil::TerminateConnection(io_socket->GetSocketFd());
+  io_socket->Close();
+}
+
 }  // namespace noisepage::trafficcop
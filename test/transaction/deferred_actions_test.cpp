@@ -1,4 +1,5 @@
 #include <memory>
+#include <thread>  // NOLINT
 #include <vector>
 
 #include "main/db_main.h"
@@ -241,4 +242,38 @@ TEST_F(DeferredActionsTest, CommitBootstrapDefer) {
   EXPECT_TRUE(defer1);
   EXPECT_TRUE(defer2);
 }
+
+// Test that actions registered concurrently by many threads are all executed exactly once, and that the actions of a
+// single thread are executed in the order they were registered.
+// NOLINTNEXTLINE
+TEST_F(DeferredActionsTest, ConcurrentDefer) {
+  const uint32_t num_threads = 8;
+  const uint32_t num_actions = 1000;
+  std::vector<std::vector<uint32_t>> executed(num_threads);
+  auto *txn = txn_mgr_->BeginTransaction();
+
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t] {
+      for (uint32_t i = 0; i < num_actions; i++) {
+        deferred_action_manager_->RegisterDeferredAction([&, t, i]() { executed[t].push_back(i); });
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+
+  gc_->PerformGarbageCollection();
+  for (const auto &thread_executed : executed) EXPECT_TRUE(thread_executed.empty());  // txn is still open
+  EXPECT_EQ(num_threads * num_actions, deferred_action_manager_->NumPendingActions());
+
+  txn_mgr_->Commit(txn, transaction::TransactionUtil::EmptyCallback, nullptr);
+  gc_->PerformGarbageCollection();
+  gc_->PerformGarbageCollection();
+
+  EXPECT_EQ(0U, deferred_action_manager_->NumPendingActions());
+  for (const auto &thread_executed : executed) {
+    ASSERT_EQ(num_actions, thread_executed.size());
+    for (uint32_t i = 0; i < num_actions; i++) EXPECT_EQ(i, thread_executed[i]);
+  }
+}
 }  // namespace noisepage
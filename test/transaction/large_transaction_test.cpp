@@ -7,10 +7,10 @@
 namespace noisepage {
 class LargeTransactionTests : public TerrierTest {
  public:
-  void RunTest(const LargeDataTableTestConfiguration &config) {
+  void RunTest(const LargeDataTableTestConfiguration &config, const bool commit_batching = false) {
     for (uint32_t iteration = 0; iteration < config.NumIterations(); iteration++) {
       std::default_random_engine generator;
-      auto db_main = DBMain::Builder().Build();
+      auto db_main = DBMain::Builder().SetTxnCommitBatching(commit_batching).Build();
       LargeDataTableTestObject tested(config, db_main->GetStorageLayer()->GetBlockStore().Get(),
                                       db_main->GetTransactionLayer()->GetTransactionManager().Get(), &generator,
                                       DISABLED);
@@ -74,6 +74,22 @@ TEST_F(LargeTransactionTests, LowAbortHighThroughput) {
   RunTest(config);
 }
 
+// This test is a duplicate of LowAbortHighThroughput but with commit timestamps checked out in batches
+// NOLINTNEXTLINE
+TEST_F(LargeTransactionTests, LowAbortHighThroughputCommitBatching) {
+  auto config = LargeDataTableTestConfiguration::Builder()
+                    .SetNumIterations(10)
+                    .SetNumTxns(1000)
+                    .SetNumConcurrentTxns(2 * MultiThreadTestUtil::HardwareConcurrency())
+                    .SetUpdateSelectRatio({0.5, 0.5})
+                    .SetTxnLength(1)
+                    .SetInitialTableSize(1000)
+                    .SetMaxColumns(20)
+                    .SetVarlenAllowed(false)
+                    .Build();
+  RunTest(config, true);
+}
+
 // This test is a duplicate of LowAbortHighThroughput but with higher number of thread swapouts
 // NOLINTNEXTLINE
 TEST_F(LargeTransactionTests, LowAbortHighThroughputHighThread) {
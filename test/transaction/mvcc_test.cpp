@@ -1,4 +1,5 @@
 #include <cstring>
+#include <thread>  // NOLINT
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -1369,4 +1370,203 @@ TEST_F(MVCCTests, SimpleDelete2) {
     txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
   }
 }
+
+//    Txn #0 | Txn #1 | Txn #2 |
+//    --------------------------
+//    BEGIN  |        |        |
+//    W(X)   |        |        |
+//    W(Y)   |        |        |
+//    COMMIT |        |        |
+//           | BEGIN  |        |
+//           |        | BEGIN  |
+//           | R(X)   |        |
+//           | R(Y)   |        |
+//           |        | R(X)   |
+//           |        | R(Y)   |
+//           | W(X)   |        |
+//           |        | W(Y)   |
+//           | COMMIT |        |
+//           |        | COMMIT |
+//
+// Under snapshot isolation both Txn #1 and Txn #2 commit, although no serial order of the two produces this result
+//
+// This test confirms that snapshot isolation is susceptible to the WRITE SKEW anomaly
+// NOLINTNEXTLINE
+TEST_F(MVCCTests, WriteSkewSnapshot) {
+  for (uint32_t iteration = 0; iteration < num_iterations_; ++iteration) {
+    auto db_main = DBMain::Builder().Build();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    MVCCDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_, &generator_);
+
+    auto *txn0 = txn_manager->BeginTransaction();
+    tested.loose_txns_.push_back(txn0);
+    storage::TupleSlot x = tested.table_.Insert(common::ManagedPointer(txn0), *tested.GenerateRandomTuple(&generator_));
+    storage::TupleSlot y = tested.table_.Insert(common::ManagedPointer(txn0), *tested.GenerateRandomTuple(&generator_));
+    txn_manager->Commit(txn0, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    auto *txn1 = txn_manager->BeginTransaction(false, transaction::IsolationLevel::SNAPSHOT);
+    tested.loose_txns_.push_back(txn1);
+    auto *txn2 = txn_manager->BeginTransaction(false, transaction::IsolationLevel::SNAPSHOT);
+    tested.loose_txns_.push_back(txn2);
+    EXPECT_FALSE(txn1->IsSerializable());
+
+    for (auto *txn : {txn1, txn2}) {
+      tested.SelectIntoBuffer(txn, x);
+      EXPECT_TRUE(tested.select_result_);
+      tested.SelectIntoBuffer(txn, y);
+      EXPECT_TRUE(tested.select_result_);
+    }
+    EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn1), x, *tested.GenerateRandomUpdate(&generator_)));
+    EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn2), y, *tested.GenerateRandomUpdate(&generator_)));
+
+    EXPECT_NE(transaction::INVALID_TXN_TIMESTAMP,
+              txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr));
+    EXPECT_NE(transaction::INVALID_TXN_TIMESTAMP,
+              txn_manager->Commit(txn2, transaction::TransactionUtil::EmptyCallback, nullptr));
+  }
+}
+
+// The same schedule as in WriteSkewSnapshot. Txn #1 -rw-> Txn #2 -rw-> Txn #1 is a dangerous structure, so under
+// serializable isolation they cannot both commit.
+//
+// This test confirms that serializable isolation is not susceptible to the WRITE SKEW anomaly
+// NOLINTNEXTLINE
+TEST_F(MVCCTests, WriteSkewSerializable) {
+  for (uint32_t iteration = 0; iteration < num_iterations_; ++iteration) {
+    auto db_main = DBMain::Builder().Build();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    MVCCDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_, &generator_);
+
+    auto *txn0 = txn_manager->BeginTransaction();
+    tested.loose_txns_.push_back(txn0);
+    storage::TupleSlot x = tested.table_.Insert(common::ManagedPointer(txn0), *tested.GenerateRandomTuple(&generator_));
+    storage::TupleSlot y = tested.table_.Insert(common::ManagedPointer(txn0), *tested.GenerateRandomTuple(&generator_));
+    txn_manager->Commit(txn0, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    auto *txn1 = txn_manager->BeginTransaction(false, transaction::IsolationLevel::SERIALIZABLE);
+    tested.loose_txns_.push_back(txn1);
+    auto *txn2 = txn_manager->BeginTransaction(false, transaction::IsolationLevel::SERIALIZABLE);
+    tested.loose_txns_.push_back(txn2);
+    EXPECT_TRUE(txn1->IsSerializable());
+
+    for (auto *txn : {txn1, txn2}) {
+      tested.SelectIntoBuffer(txn, x);
+      EXPECT_TRUE(tested.select_result_);
+      tested.SelectIntoBuffer(txn, y);
+      EXPECT_TRUE(tested.select_result_);
+    }
+    EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn1), x, *tested.GenerateRandomUpdate(&generator_)));
+    EXPECT_FALSE(txn1->MustAbort());
+    EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn2), y, *tested.GenerateRandomUpdate(&generator_)));
+    // Txn #2 completed the structure
+    EXPECT_TRUE(txn2->MustAbort());
+
+    const transaction::timestamp_t commit1 =
+        txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+    const transaction::timestamp_t commit2 =
+        txn_manager->Commit(txn2, transaction::TransactionUtil::EmptyCallback, nullptr);
+    EXPECT_TRUE(commit1 == transaction::INVALID_TXN_TIMESTAMP || commit2 == transaction::INVALID_TXN_TIMESTAMP);
+    EXPECT_EQ(transaction::INVALID_TXN_TIMESTAMP, commit2);
+  }
+}
+
+//    Txn #0 | Txn #1 | Txn #2 |
+//    --------------------------
+//    BEGIN  |        |        |
+//    W(X)   |        |        |
+//    COMMIT |        |        |
+//           | BEGIN  |        |
+//           |        | BEGIN  |
+//           | R(X)   |        |
+//           |        | W(X)   |
+//           |        | COMMIT |
+//           | R(X)   |        |
+//           | COMMIT |        |
+//
+// Txn #1 -rw-> Txn #2 is the only rw-antidependency, and Txn #1 before Txn #2 is a serial order that explains it
+//
+// This test confirms that serializable isolation does not abort transactions without a dangerous structure
+// NOLINTNEXTLINE
+TEST_F(MVCCTests, SingleAntiDependencySerializable) {
+  for (uint32_t iteration = 0; iteration < num_iterations_; ++iteration) {
+    auto db_main = DBMain::Builder().Build();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    MVCCDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_, &generator_);
+
+    auto *txn0 = txn_manager->BeginTransaction();
+    tested.loose_txns_.push_back(txn0);
+    auto *insert_tuple = tested.GenerateRandomTuple(&generator_);
+    storage::TupleSlot slot = tested.table_.Insert(common::ManagedPointer(txn0), *insert_tuple);
+    txn_manager->Commit(txn0, transaction::TransactionUtil::EmptyCallback, nullptr);
+
+    auto *txn1 = txn_manager->BeginTransaction(false, transaction::IsolationLevel::SERIALIZABLE);
+    tested.loose_txns_.push_back(txn1);
+    auto *txn2 = txn_manager->BeginTransaction(false, transaction::IsolationLevel::SERIALIZABLE);
+    tested.loose_txns_.push_back(txn2);
+
+    tested.SelectIntoBuffer(txn1, slot);
+    EXPECT_TRUE(tested.select_result_);
+    EXPECT_TRUE(tested.table_.Update(common::ManagedPointer(txn2), slot, *tested.GenerateRandomUpdate(&generator_)));
+    EXPECT_NE(transaction::INVALID_TXN_TIMESTAMP,
+              txn_manager->Commit(txn2, transaction::TransactionUtil::EmptyCallback, nullptr));
+
+    storage::ProjectedRow *select_tuple = tested.SelectIntoBuffer(txn1, slot);
+    EXPECT_TRUE(tested.select_result_);
+    EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, insert_tuple));
+    EXPECT_FALSE(txn1->MustAbort());
+    EXPECT_NE(transaction::INVALID_TXN_TIMESTAMP,
+              txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr));
+  }
+}
+
+// Several threads insert on behalf of the same transaction, each in a worker scope of its own, like the workers of a
+// parallel pipeline do. The transaction commits or aborts all of their inserts as one.
+// NOLINTNEXTLINE
+TEST_F(MVCCTests, WorkerInserts) {
+  const uint32_t num_workers = 4;
+  const uint32_t num_inserts = 1000;
+  for (const bool commit : {true, false}) {
+    auto db_main = DBMain::Builder().Build();
+    auto txn_manager = db_main->GetTransactionLayer()->GetTransactionManager();
+    MVCCDataTableTestObject tested(db_main->GetStorageLayer()->GetBlockStore().Get(), max_columns_, &generator_);
+    auto *insert_tuple = tested.GenerateRandomTuple(&generator_);
+
+    auto *txn0 = txn_manager->BeginTransaction();
+    tested.loose_txns_.push_back(txn0);
+    std::vector<std::vector<storage::TupleSlot>> slots(num_workers);
+    std::vector<std::thread> workers;
+    for (uint32_t worker = 0; worker < num_workers; worker++) {
+      workers.emplace_back([&, worker] {
+        transaction::TransactionContext::WorkerScope worker_scope{common::ManagedPointer(txn0)};
+        for (uint32_t i = 0; i < num_inserts; i++) {
+          slots[worker].push_back(tested.table_.Insert(common::ManagedPointer(txn0), *insert_tuple));
+        }
+      });
+    }
+    for (auto &worker : workers) worker.join();
+    // The inserts were not written to the undo buffer of the transaction itself
+    EXPECT_TRUE(txn0->IsReadOnly());
+
+    if (commit) {
+      txn0->MergeWorkerWrites();
+      EXPECT_FALSE(txn0->IsReadOnly());
+      txn_manager->Commit(txn0, transaction::TransactionUtil::EmptyCallback, nullptr);
+    } else {
+      txn_manager->Abort(txn0);
+    }
+
+    auto *txn1 = txn_manager->BeginTransaction();
+    tested.loose_txns_.push_back(txn1);
+    for (const auto &worker_slots : slots) {
+      for (const auto slot : worker_slots) {
+        storage::ProjectedRow *select_tuple = tested.SelectIntoBuffer(txn1, slot);
+        EXPECT_EQ(commit, tested.select_result_);
+        if (commit) {
+          EXPECT_TRUE(StorageTestUtil::ProjectionListEqualShallow(tested.Layout(), select_tuple, insert_tuple));
+        }
+      }
+    }
+    txn_manager->Commit(txn1, transaction::TransactionUtil::EmptyCallback, nullptr);
+  }
+}
 }  // namespace noisepage
@@ -0,0 +1,83 @@
+#include "transaction/timestamp_manager.h"
+
+#include <algorithm>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test_util/test_harness.h"
+
+namespace noisepage::transaction {
+
+class TimestampManagerTests : public TerrierTest {
+ protected:
+  static timestamp_t BeginTransaction(TimestampManager *const timestamp_manager) {
+    return timestamp_manager->BeginTransaction();
+  }
+
+  static void RemoveTransaction(TimestampManager *const timestamp_manager, const timestamp_t timestamp) {
+    timestamp_manager->RemoveTransaction(timestamp);
+  }
+
+  static bool RemoveTransactions(TimestampManager *const timestamp_manager,
+                                 const std::vector<timestamp_t> &timestamps) {
+    return timestamp_manager->RemoveTransactions(timestamps);
+  }
+};
+
+// Without running transactions, the oldest start time is the current time
+// NOLINTNEXTLINE
+TEST_F(TimestampManagerTests, NoRunningTransactions) {
+  TimestampManager timestamp_manager(4);
+  timestamp_manager.CheckOutTimestamp();
+  EXPECT_EQ(timestamp_manager.CurrentTime(), timestamp_manager.OldestTransactionStartTime());
+  EXPECT_EQ(timestamp_manager.CurrentTime(), timestamp_manager.CachedOldestTransactionStartTime());
+
+  const timestamp_t start = BeginTransaction(&timestamp_manager);
+  RemoveTransaction(&timestamp_manager, start);
+  EXPECT_EQ(timestamp_manager.CurrentTime(), timestamp_manager.OldestTransactionStartTime());
+}
+
+// Transactions begun on many threads end up in different shards, and the oldest of them is found across all shards
+// NOLINTNEXTLINE
+TEST_F(TimestampManagerTests, OldestAcrossShards) {
+  const uint32_t num_threads = 8;
+  const uint32_t num_txns = 100;
+  TimestampManager timestamp_manager(4);
+  std::vector<std::vector<timestamp_t>> start_times(num_threads);
+
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < num_threads; t++) {
+    threads.emplace_back([&, t] {
+      // Every thread removes every other transaction itself
+      for (uint32_t i = 0; i < num_txns; i++) {
+        const timestamp_t start = BeginTransaction(&timestamp_manager);
+        if (i % 2 == 0) {
+          RemoveTransaction(&timestamp_manager, start);
+        } else {
+          start_times[t].push_back(start);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) thread.join();
+
+  std::vector<timestamp_t> running;
+  for (const auto &thread_start_times : start_times) {
+    running.insert(running.end(), thread_start_times.cbegin(), thread_start_times.cend());
+  }
+  std::sort(running.begin(), running.end());
+  EXPECT_EQ(running.front(), timestamp_manager.OldestTransactionStartTime());
+  EXPECT_EQ(running.front(), timestamp_manager.CachedOldestTransactionStartTime());
+
+  // Remove the oldest half on a different thread, like the log serializer does
+  const std::vector<timestamp_t> oldest_half(running.begin(), running.begin() + running.size() / 2);
+  EXPECT_FALSE(RemoveTransactions(&timestamp_manager, oldest_half));
+  EXPECT_EQ(running[running.size() / 2], timestamp_manager.OldestTransactionStartTime());
+
+  const std::vector<timestamp_t> newest_half(running.begin() + running.size() / 2, running.end());
+  EXPECT_TRUE(RemoveTransactions(&timestamp_manager, newest_half));
+  EXPECT_EQ(timestamp_manager.CurrentTime(), timestamp_manager.OldestTransactionStartTime());
+}
+
+}  // namespace noisepage::transaction
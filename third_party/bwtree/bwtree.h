@@ -2,6 +2,8 @@
 
 // 2020-08-27: modified by Wan to track index_size, exposed via GetSize()
 // 2020-10-05: modified by Wan to disable ASAN per function, because apparently gcc refuses to add fsanitize-blacklist.
+// 2026-10-15: modified to count consolidations, and to consolidate delta chains from a background thread via
+//             ConsolidateDeltaChains()
 
 // As we have learned from recent events, if we do not test for something, then it does not exist.
 #define NO_ASAN __attribute__((no_sanitize("address")))
@@ -2283,6 +2285,10 @@ class BwTree : public BwTreeBase {
         update_op_count{0},
         update_abort_count{0},
         index_size{0},
+        consolidation_count{0},
+        background_consolidation_count{0},
+        consolidated_delta_count{0},
+        longest_consolidated_chain{0},
 
         // Epoch Manager that does garbage collection
         epoch_manager{this} {
@@ -5580,12 +5586,28 @@ class BwTree : public BwTreeBase {
     NOISEPAGE_ASSERT(false, "Cannot reach here.");
   }
 
+  /*
+   * RecordConsolidation() - Updates the consolidation statistics after a
+   *                         delta chain has been replaced
+   */
+  NO_ASAN inline void RecordConsolidation(int chain_length) {
+    consolidation_count.fetch_add(1, std::memory_order_relaxed);
+    consolidated_delta_count.fetch_add(chain_length, std::memory_order_relaxed);
+
+    int longest = longest_consolidated_chain.load(std::memory_order_relaxed);
+    while (chain_length > longest &&
+           !longest_consolidated_chain.compare_exchange_weak(longest, chain_length, std::memory_order_relaxed)) {
+    }
+  }
+
   /*
    * ConsolidateLeafNode() - Consolidates a leaf delta chian unconditionally
    *
    * This function does not check delta chain size
+   *
+   * Returns true if the consolidated node replaced the delta chain
    */
-  NO_ASAN inline void ConsolidateLeafNode(NodeSnapshot *snapshot_p) {
+  NO_ASAN inline bool ConsolidateLeafNode(NodeSnapshot *snapshot_p) {
     NOISEPAGE_ASSERT(snapshot_p->node_p->IsOnLeafDeltaChain(), "Leaf node must be on delta chain.");
 
     LeafNode *leaf_node_p = CollectAllValuesOnLeaf(snapshot_p);
@@ -5593,20 +5615,25 @@ class BwTree : public BwTreeBase {
     bool ret = InstallNodeToReplace(snapshot_p->node_id, leaf_node_p, snapshot_p->node_p);
 
     if (ret) {
+      RecordConsolidation(snapshot_p->node_p->GetDepth());
       epoch_manager.AddGarbageNode(snapshot_p->node_p);
 
       snapshot_p->node_p = leaf_node_p;
     } else {
       epoch_manager.AddGarbageNode(leaf_node_p);
     }
+
+    return ret;
   }
 
   /*
    * ConsolidateInnerNode() - Consolidates inner node unconditionally
    *
    * This function does not check for inner delta chain length
+   *
+   * Returns true if the consolidated node replaced the delta chain
    */
-  NO_ASAN inline void ConsolidateInnerNode(NodeSnapshot *snapshot_p) {
+  NO_ASAN inline bool ConsolidateInnerNode(NodeSnapshot *snapshot_p) {
     NOISEPAGE_ASSERT(!snapshot_p->node_p->IsOnLeafDeltaChain(), "Inner node cannot be on delta chain.");
 
     InnerNode *inner_node_p = CollectAllSepsOnInner(snapshot_p);
@@ -5614,12 +5641,15 @@ class BwTree : public BwTreeBase {
     bool ret = InstallNodeToReplace(snapshot_p->node_id, inner_node_p, snapshot_p->node_p);
 
     if (ret) {
+      RecordConsolidation(snapshot_p->node_p->GetDepth());
       epoch_manager.AddGarbageNode(snapshot_p->node_p);
 
       snapshot_p->node_p = inner_node_p;
     } else {
       epoch_manager.AddGarbageNode(inner_node_p);
     }
+
+    return ret;
   }
 
   /*
@@ -5629,16 +5659,38 @@ class BwTree : public BwTreeBase {
    * want to prevent other threads from seeing the finished SMO and
    * do an useless consolidation on the parent node
    *
-   * NOTE: This function does not return any value reflecting the status
-   * of CAS operation, since consolidation is an optional operation, and it
-   * would not have any effect even if it fails
+   * NOTE: Callers on the SMO path ignore the status of the CAS operation,
+   * since consolidation is an optional operation, and it would not have any
+   * effect even if it fails. ConsolidateDeltaChains() counts it
    */
-  NO_ASAN void ConsolidateNode(NodeSnapshot *snapshot_p) {
+  NO_ASAN bool ConsolidateNode(NodeSnapshot *snapshot_p) {
     if (snapshot_p->node_p->IsOnLeafDeltaChain()) {
-      ConsolidateLeafNode(snapshot_p);
-    } else {
-      ConsolidateInnerNode(snapshot_p);
-    }  // if on leaf/inner node
+      return ConsolidateLeafNode(snapshot_p);
+    }
+    return ConsolidateInnerNode(snapshot_p);
+  }
+
+  /*
+   * IsInsertDeleteChain() - Returns true if the delta chain only consists of
+   *                         insert and delete deltas on top of a base node
+   *
+   * Chains with a split, merge, remove or abort delta belong to an SMO that
+   * might not be finished yet, and only workers help along SMOs
+   */
+  NO_ASAN static bool IsInsertDeleteChain(const BaseNode *node_p) {
+    while (node_p->IsDeltaNode()) {
+      switch (node_p->GetType()) {
+        case NodeType::LeafInsertType:
+        case NodeType::LeafDeleteType:
+        case NodeType::InnerInsertType:
+        case NodeType::InnerDeleteType:
+          break;
+        default:
+          return false;
+      }
+      node_p = static_cast<const DeltaNode *>(node_p)->child_node_p;
+    }
+    return true;
   }
 
   /*
@@ -6888,6 +6940,51 @@ class BwTree : public BwTreeBase {
     epoch_manager.PerformGarbageCollection();
   }
 
+  /*
+   * ConsolidateDeltaChains() - Consolidates every delta chain that is at
+   *                            least as long as the given threshold
+   *
+   * This is meant to be called periodically by a background thread with
+   * thresholds below the ones workers use in TryConsolidateNode(), so that
+   * hot nodes are consolidated before a worker has to do it on its own
+   * critical path. The pass walks the mapping table and joins an epoch
+   * like any worker, and it only installs a consolidated node with a CAS,
+   * so a concurrent change of the node simply makes it skip the node.
+   *
+   * Chains of an SMO in progress are left alone, see IsInsertDeleteChain()
+   *
+   * Returns the number of delta chains that were consolidated
+   */
+  NO_ASAN size_t ConsolidateDeltaChains(int leaf_threshold, int inner_threshold) {
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    size_t consolidated = 0;
+    const NodeID end_node_id = next_unused_node_id.load();
+    for (NodeID node_id = INVALID_NODE_ID + 1; node_id < end_node_id; node_id++) {
+      const BaseNode *node_p = GetNode(node_id);
+
+      // Unused NodeIDs are nullptr, and base nodes are already consolidated
+      if (node_p == nullptr || !node_p->IsDeltaNode()) {
+        continue;
+      }
+
+      const int threshold = node_p->IsOnLeafDeltaChain() ? leaf_threshold : inner_threshold;
+      if (node_p->GetDepth() < threshold || !IsInsertDeleteChain(node_p)) {
+        continue;
+      }
+
+      NodeSnapshot snapshot{node_id, node_p};
+      if (ConsolidateNode(&snapshot)) {
+        consolidated++;
+      }
+    }
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    background_consolidation_count.fetch_add(consolidated, std::memory_order_relaxed);
+    return consolidated;
+  }
+
  public:
   // Key comparator
   const KeyComparator key_cmp_obj;
@@ -6940,6 +7037,13 @@ class BwTree : public BwTreeBase {
 
   std::atomic<uint64_t> index_size;
 
+  // Consolidation statistics. They are only ever added to, users that want
+  // the numbers since their last look exchange them with 0
+  std::atomic<uint64_t> consolidation_count;
+  std::atomic<uint64_t> background_consolidation_count;
+  std::atomic<uint64_t> consolidated_delta_count;
+  std::atomic<int> longest_consolidated_chain;
+
   // InteractiveDebugger idb;
 
   EpochManager epoch_manager;
@@ -7619,6 +7723,68 @@ class BwTree : public BwTreeBase {
     }
   };  // Epoch manager
 
+  /*
+   * GetSeparators() - Collects the separators of the upper levels of the tree
+   *                   that fall in a key range
+   *
+   * The separators split a scan of the range into sub-ranges of similar size.
+   * This goes down one level at a time, until it found enough separators or
+   * reached the leaves. Since the tree may change right after, the separators
+   * are only a hint of where the keys are.
+   *
+   * Separators are greater than the low key and at most the high key. Either
+   * key may be nullptr for a range without that bound. The separators are
+   * returned in ascending order.
+   */
+  NO_ASAN std::vector<KeyType> GetSeparators(const KeyType *low_key_p, const KeyType *high_key_p,
+                                             size_t separator_count) {
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    std::vector<KeyType> separators;
+    // The nodes of the current level whose keys overlap the range
+    std::vector<NodeID> level{root_id.load()};
+
+    while (separators.size() < separator_count && !level.empty()) {
+      std::vector<NodeID> children;
+      for (const NodeID node_id : level) {
+        NodeSnapshot snapshot{node_id, GetNode(node_id)};
+        // Nodes that are being removed or that an SMO is holding cannot be consolidated
+        if (snapshot.node_p == nullptr || snapshot.IsLeaf() ||
+            snapshot.node_p->GetType() == NodeType::InnerRemoveType ||
+            snapshot.node_p->GetType() == NodeType::InnerAbortType) {
+          continue;
+        }
+
+        InnerNode *inner_node_p = CollectAllSepsOnInner(&snapshot);
+        // The first item only holds the low key of the node, which is not a separator, and its child
+        for (const KeyNodeIDPair *item_p = inner_node_p->Begin(); item_p != inner_node_p->End(); item_p++) {
+          const KeyNodeIDPair *next_item_p = item_p + 1;
+          const bool first = item_p == inner_node_p->Begin();
+          const bool starts_below_high = first || high_key_p == nullptr || KeyCmpLessEqual(item_p->first, *high_key_p);
+          const bool ends_above_low = next_item_p == inner_node_p->End() || low_key_p == nullptr ||
+                                      KeyCmpGreater(next_item_p->first, *low_key_p);
+          if (starts_below_high && ends_above_low) children.push_back(item_p->second);
+          if (!first && starts_below_high && (low_key_p == nullptr || KeyCmpGreater(item_p->first, *low_key_p))) {
+            separators.push_back(item_p->first);
+          }
+        }
+        inner_node_p->~InnerNode();
+        inner_node_p->Destroy();
+      }
+      level = std::move(children);
+    }
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    // A separator moves up when its node splits, so the levels hold different separators that interleave
+    std::sort(separators.begin(), separators.end(),
+              [this](const KeyType &key1, const KeyType &key2) { return KeyCmpLess(key1, key2); });
+    separators.erase(std::unique(separators.begin(), separators.end(),
+                                 [this](const KeyType &key1, const KeyType &key2) { return KeyCmpEqual(key1, key2); }),
+                     separators.end());
+    return separators;
+  }
+
   /*
    * Iterator Interface
    */
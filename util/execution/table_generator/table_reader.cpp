@@ -1,17 +1,169 @@
 #include "execution/table_generator/table_reader.h"
 
-#include <storage/index/index_builder.h>
+#include <immintrin.h>
+#include <tbb/parallel_for.h>
 
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
 #include <string>
+#include <utility>
 #include <vector>
 
-#include "csv/csv.hpp"  // NOLINT
+#include "common/error/error_code.h"
+#include "common/error/exception.h"
+#include "execution/exec/task_scheduler.h"
 #include "execution/sql/value.h"
+#include "execution/util/bit_util.h"
+#include "execution/util/file.h"
+#include "spdlog/fmt/fmt.h"
 #include "storage/index/index.h"
+#include "storage/index/index_builder.h"
 #include "storage/sql_table.h"
+#include "storage/storage_util.h"
+#include "storage/varlen_allocator.h"
 
 namespace noisepage::execution::sql {
 
+namespace {
+
+// The data file is split into chunks of about this many bytes, each parsed by one task
+constexpr std::size_t CHUNK_SIZE = std::size_t{8} << 20;
+
+// File reads report their size as a 32-bit integer, so at most this many bytes are read at a time
+constexpr std::size_t MAX_READ_SIZE = std::size_t{1} << 30;
+
+// Rows are inserted into the table in batches of at most this many rows
+constexpr uint32_t BATCH_SIZE = 8 * common::Constants::K_DEFAULT_VECTOR_SIZE;
+
+// The quote around fields that contain delimiters or newlines. A quote inside a quoted field is doubled.
+constexpr char QUOTE = '"';
+
+// The delimiters a data file may use
+constexpr std::array<char, 4> DELIMITERS{',', '|', '\t', ';'};
+
+// Finds the first occurrence of either of two bytes, comparing 32 bytes at a time.
+class ByteFinder {
+ public:
+  ByteFinder(const char a, const char b) : a_(a), b_(b), a_vec_(_mm256_set1_epi8(a)), b_vec_(_mm256_set1_epi8(b)) {}
+
+  // Return the first position in [pos, end) holding either byte, or end if there is none
+  const char *Find(const char *pos, const char *const end) const {
+    for (; pos + 32 <= end; pos += 32) {
+      const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+      const __m256i eq = _mm256_or_si256(_mm256_cmpeq_epi8(block, a_vec_), _mm256_cmpeq_epi8(block, b_vec_));
+      const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+      if (mask != 0) return pos + util::BitUtil::CountTrailingZeros(mask);
+    }
+    // Tail
+    for (; pos < end; pos++) {
+      if (*pos == a_ || *pos == b_) return pos;
+    }
+    return end;
+  }
+
+ private:
+  const char a_, b_;
+  const __m256i a_vec_, b_vec_;
+};
+
+// Count the quotes in [begin, end), 32 bytes at a time
+uint64_t CountQuotes(const char *const begin, const char *const end) {
+  const __m256i quote = _mm256_set1_epi8(QUOTE);
+  uint64_t count = 0;
+  const char *pos = begin;
+  for (; pos + 32 <= end; pos += 32) {
+    const __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(pos));
+    const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, quote)));
+    count += util::BitUtil::CountPopulation(mask);
+  }
+  return count + std::count(pos, end, QUOTE);
+}
+
+// Split the records in [begin, end) into chunks of about CHUNK_SIZE bytes. A chunk ends after the first newline past
+// its size that is not inside quotes, which is found by counting the quotes before it. Returns the start of the bytes
+// that didn't make up a whole chunk.
+const char *SplitChunks(const char *const begin, const char *const end, std::vector<std::string_view> *chunks) {
+  const ByteFinder record_end_finder('\n', QUOTE);
+  const char *chunk_start = begin;
+  while (static_cast<std::size_t>(end - chunk_start) > CHUNK_SIZE) {
+    const char *pos = chunk_start + CHUNK_SIZE;
+    bool in_quotes = CountQuotes(chunk_start, pos) % 2 == 1;
+    const char *chunk_end = nullptr;
+    for (; (pos = record_end_finder.Find(pos, end)) != end; pos++) {
+      if (*pos == QUOTE) {
+        in_quotes = !in_quotes;
+      } else if (!in_quotes) {
+        chunk_end = pos + 1;
+        break;
+      }
+    }
+    if (chunk_end == nullptr) break;
+    chunks->emplace_back(chunk_start, chunk_end - chunk_start);
+    chunk_start = chunk_end;
+  }
+  return chunk_start;
+}
+
+// Guess the delimiter from the first record of a data file: the one splitting it into as many fields as the table has
+// columns, allowing for a trailing delimiter, or else the most frequent one
+char GuessDelimiter(const std::string_view record, const std::size_t num_cols) {
+  char best = DELIMITERS[0];
+  std::size_t best_count = 0;
+  for (const char delimiter : DELIMITERS) {
+    const auto count = static_cast<std::size_t>(std::count(record.begin(), record.end(), delimiter));
+    if (count + 1 == num_cols || count == num_cols) return delimiter;
+    if (count > best_count) {
+      best = delimiter;
+      best_count = count;
+    }
+  }
+  return best;
+}
+
+// Whether the first record of a data file holds the names of the table's columns rather than data
+bool IsHeader(std::string_view record, const char delimiter, const TableInfo &info) {
+  if (!record.empty() && record.back() == '\r') record.remove_suffix(1);
+  for (const auto &col : info.cols_) {
+    const std::size_t field_size = std::min(record.find(delimiter), record.size());
+    std::string_view field = record.substr(0, field_size);
+    if (field.size() >= 2 && field.front() == QUOTE && field.back() == QUOTE) field = field.substr(1, field.size() - 2);
+    const auto &name = col.Name();
+    const bool same_name = std::equal(field.begin(), field.end(), name.begin(), name.end(), [](char a, char b) {
+      return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+    });
+    if (!same_name) return false;
+    record.remove_prefix(std::min(field_size + 1, record.size()));
+  }
+  return true;
+}
+
+template <typename T>
+T ParseInteger(const std::string_view field) {
+  std::size_t i = 0;
+  while (i < field.size() && field[i] == ' ') i++;
+  const bool negative = i < field.size() && field[i] == '-';
+  if (negative || (i < field.size() && field[i] == '+')) i++;
+  int64_t val = 0;
+  for (; i < field.size() && field[i] >= '0' && field[i] <= '9'; i++) {
+    val = val * 10 + (field[i] - '0');
+  }
+  return static_cast<T>(negative ? -val : val);
+}
+
+double ParseReal(const std::string_view field) {
+  // strtod needs a terminated string, which a field within the chunk isn't
+  char buffer[64];
+  const std::size_t size = std::min(field.size(), sizeof(buffer) - 1);
+  std::memcpy(buffer, field.data(), size);
+  buffer[size] = '\0';
+  return std::strtod(buffer, nullptr);
+}
+
+}  // namespace
+
 uint32_t TableReader::ReadTable(const std::string &schema_file, const std::string &data_file) {
   uint32_t val_written = 0;
   // Read schema and create table and indexes
@@ -19,14 +171,14 @@ uint32_t TableReader::ReadTable(const std::string &schema_file, const std::strin
   auto table_info = schema_reader.ReadTableInfo(schema_file);
   auto table_oid = CreateTable(table_info.get());
 
-  // Init table projected row
+  // Init table projected columns
   auto table = exec_ctx_->GetAccessor()->GetTable(table_oid);
   auto &table_schema = exec_ctx_->GetAccessor()->GetSchema(table_oid);
   std::vector<catalog::col_oid_t> table_cols;
   for (const auto &col : table_schema.GetColumns()) {
     table_cols.emplace_back(col.Oid());
   }
-  auto pri = table->InitializerForProjectedRow(table_cols);
+  auto initializer = table->InitializerForProjectedColumns(table_cols, BATCH_SIZE);
 
   // Set table column offsets
   auto offset_map = table->ProjectionMapForOids(table_cols);
@@ -38,36 +190,93 @@ uint32_t TableReader::ReadTable(const std::string &schema_file, const std::strin
 
   // Create Indexes
   CreateIndexes(table_info.get(), table_oid);
+  std::vector<std::vector<std::pair<const storage::ProjectedRow *, storage::TupleSlot>>> index_entries(
+      table_info->indexes_.size());
+  std::vector<byte *> key_buffers;
 
-  // Iterate through CSV file
-  std::vector<std::string> col_names;
-  for (const auto &col : table_info->cols_) {
-    col_names.emplace_back(col.Name());
+  util::File file(data_file, util::File::FLAG_OPEN | util::File::FLAG_READ);
+  if (file.HasError()) {
+    throw EXECUTION_EXCEPTION(fmt::format("Could not open data file {}: {}", data_file,
+                                          util::File::ErrorToString(file.GetErrorIndicator())),
+                              common::ErrorCode::ERRCODE_IO_ERROR);
   }
-  csv::CSVReader reader(data_file);
-  for (csv::CSVRow &row : reader) {
-    // Write table data
-    auto *const redo = exec_ctx_->GetTxn()->StageWrite(exec_ctx_->DBOid(), table_oid, pri);
-    uint16_t col_idx = 0;
-    for (csv::CSVField &field : row) {
-      auto col_offset = table_offsets[col_idx];
-      auto col_type = table_info->cols_[col_idx].Type();
-      WriteTableCol(redo->Delta(), col_offset, col_type, &field);
-      col_idx++;
+
+  // Read enough of the file at a time to give every thread a couple of chunks. The bytes after the last whole chunk
+  // are carried over to the next read.
+  const std::size_t read_size =
+      std::min(MAX_READ_SIZE, 2 * CHUNK_SIZE * exec::TaskScheduler::MaxConcurrency(exec_ctx_->GetExecutionSettings()));
+  std::vector<char> buffer;
+  std::size_t carried = 0;
+  char delimiter = DELIMITERS[0];
+  bool first_read = true;
+  for (bool end_of_file = false; !end_of_file;) {
+    buffer.resize(carried + read_size);
+    const int32_t bytes_read = file.ReadFull(reinterpret_cast<std::byte *>(buffer.data() + carried), read_size);
+    if (bytes_read < 0) {
+      throw EXECUTION_EXCEPTION(fmt::format("Could not read data file {}: {}", data_file,
+                                            util::File::ErrorToString(file.GetErrorIndicator())),
+                                common::ErrorCode::ERRCODE_IO_ERROR);
+    }
+    end_of_file = static_cast<std::size_t>(bytes_read) < read_size;
+    const char *begin = buffer.data();
+    const char *const end = begin + carried + bytes_read;
+
+    // The format is guessed from the first record
+    if (first_read) {
+      const auto *first_record_end = static_cast<const char *>(std::memchr(begin, '\n', end - begin));
+      const std::string_view first_record(begin, (first_record_end == nullptr ? end : first_record_end) - begin);
+      delimiter = GuessDelimiter(first_record, table_info->cols_.size());
+      if (IsHeader(first_record, delimiter, *table_info)) {
+        begin = first_record_end == nullptr ? end : first_record_end + 1;
+      }
+      first_read = false;
+    }
+
+    std::vector<std::string_view> chunks;
+    const char *rest = SplitChunks(begin, end, &chunks);
+    if (end_of_file && rest != end) {
+      chunks.emplace_back(rest, end - rest);
+      rest = end;
     }
-    // Insert into sql table
-    auto slot = table->Insert(exec_ctx_->GetTxn(), redo);
-    val_written++;
 
-    // Write index data
-    for (auto &index_info : table_info->indexes_) {
-      WriteIndexEntry(index_info.get(), redo->Delta(), table_offsets, slot);
+    // Parse every chunk on its own thread
+    std::vector<std::vector<byte *>> batches(chunks.size());
+    exec::TaskScheduler::Execute(exec_ctx_, chunks.size(), [&] {
+      tbb::parallel_for(std::size_t{0}, chunks.size(), [&](const std::size_t i) {
+        ParseChunk(chunks[i], delimiter, *table_info, table_offsets, initializer, &batches[i]);
+      });
+    });
+
+    // Insert the rows in the order of the file. The txn's buffers can only be written to by one thread.
+    std::vector<storage::TupleSlot> slots(BATCH_SIZE);
+    for (const auto &chunk_batches : batches) {
+      for (byte *batch : chunk_batches) {
+        auto *rows = reinterpret_cast<storage::ProjectedColumns *>(batch);
+        table->InsertBatch(exec_ctx_->GetTxn(), exec_ctx_->DBOid(), table_oid, rows, slots.data());
+        val_written += rows->NumTuples();
+
+        // Collect index entries
+        for (uint32_t i = 0; i < table_info->indexes_.size(); i++) {
+          key_buffers.push_back(
+              WriteIndexEntries(*table_info->indexes_[i], rows, table_offsets, slots.data(), &index_entries[i]));
+        }
+        delete[] batch;
+      }
     }
+
+    carried = end - rest;
+    std::memmove(buffer.data(), rest, carried);
+  }
+
+  // Build the indexes from all their entries at once, rather than inserting them one at a time
+  for (uint32_t i = 0; i < table_info->indexes_.size(); i++) {
+    bool result UNUSED_ATTRIBUTE = table_info->indexes_[i]->index_ptr_->BulkLoad(exec_ctx_->GetTxn(), index_entries[i]);
+    NOISEPAGE_ASSERT(result, "Loading a non-unique index should always succeed");
   }
 
   // Deallocate
-  for (auto &index_info : table_info->indexes_) {
-    delete[] reinterpret_cast<byte *>(index_info->index_pr_);
+  for (byte *key_buffer : key_buffers) {
+    delete[] key_buffer;
   }
 
   // Return
@@ -104,83 +313,155 @@ void TableReader::CreateIndexes(TableInfo *info, catalog::table_oid_t table_oid)
       auto &index_col = schema.GetColumn(index_col_name);
       index_info->offsets_.emplace_back(index->GetKeyOidToOffsetMap().at(index_col.Oid()));
     }
+  }
+}
+
+void TableReader::ParseChunk(const std::string_view chunk, const char delimiter, const TableInfo &info,
+                             const std::vector<uint16_t> &table_offsets,
+                             const storage::ProjectedColumnsInitializer &initializer, std::vector<byte *> *batches) {
+  const ByteFinder field_end_finder(delimiter, '\n');
+  const auto num_cols = static_cast<uint16_t>(info.cols_.size());
+  std::string unquoted;
+  storage::ProjectedColumns *rows = nullptr;
+  const char *pos = chunk.data();
+  const char *const end = pos + chunk.size();
+  while (pos < end) {
+    // Skip empty lines
+    if (*pos == '\n' || (*pos == '\r' && pos + 1 < end && pos[1] == '\n')) {
+      pos += *pos == '\n' ? 1 : 2;
+      continue;
+    }
+
+    // Start a new batch when the current one is full
+    if (rows == nullptr || rows->NumTuples() == rows->MaxTuples()) {
+      byte *batch = common::AllocationUtil::AllocateAligned(initializer.ProjectedColumnsSize());
+      rows = initializer.Initialize(batch);
+      rows->SetNumTuples(0);
+      batches->push_back(batch);
+    }
+    auto row = rows->InterpretAsRow(rows->NumTuples());
+
+    uint16_t col_idx = 0;
+    for (bool end_of_record = false; !end_of_record; col_idx++) {
+      std::string_view field;
+      const char *field_end;
+      if (pos < end && *pos == QUOTE) {
+        // A quoted field ends at the first quote that isn't doubled
+        unquoted.clear();
+        for (pos++;;) {
+          const auto *quote = static_cast<const char *>(std::memchr(pos, QUOTE, end - pos));
+          if (quote == nullptr) {
+            unquoted.append(pos, end);
+            pos = end;
+            break;
+          }
+          unquoted.append(pos, quote);
+          pos = quote + 1;
+          if (pos == end || *pos != QUOTE) break;
+          unquoted.push_back(QUOTE);
+          pos++;
+        }
+        field = unquoted;
+        field_end = field_end_finder.Find(pos, end);
+      } else {
+        field_end = field_end_finder.Find(pos, end);
+        field = std::string_view(pos, field_end - pos);
+      }
+      end_of_record = field_end == end || *field_end == '\n';
+      if (end_of_record && !field.empty() && field.back() == '\r') field.remove_suffix(1);
+
+      // Fields past the columns of the table, such as those after a trailing delimiter, are ignored
+      if (col_idx < num_cols) {
+        WriteTableCol(&row, table_offsets[col_idx], info.cols_[col_idx].Type(), field);
+      }
+      pos = field_end == end ? end : field_end + 1;
+    }
 
-    // Create Projected Row
-    auto &index_pri = index->GetProjectedRowInitializer();
-    byte *index_buffer = common::AllocationUtil::AllocateAligned(index_pri.ProjectedRowSize());
-    index_info->index_pr_ = index_pri.InitializeRow(index_buffer);
+    // Missing fields are null
+    for (; col_idx < num_cols; col_idx++) {
+      row.SetNull(table_offsets[col_idx]);
+    }
+    rows->SetNumTuples(rows->NumTuples() + 1);
   }
 }
 
-void TableReader::WriteIndexEntry(IndexInfo *index_info, storage::ProjectedRow *table_pr,
-                                  const std::vector<uint16_t> &table_offsets, const storage::TupleSlot &slot) {
-  for (uint32_t index_col_idx = 0; index_col_idx < index_info->offsets_.size(); index_col_idx++) {
-    // Get the offset of this column in the table
-    uint16_t table_col_idx = index_info->index_map_[index_col_idx];
-    uint16_t table_offset = table_offsets[table_col_idx];
-    // Get the offset of this column in the index
-    uint16_t index_offset = index_info->offsets_[index_col_idx];
-    // Check null and write bytes.
-    if (index_info->cols_[index_col_idx].Nullable() && table_pr->IsNull(table_offset)) {
-      index_info->index_pr_->SetNull(index_offset);
-    } else {
-      byte *index_data = index_info->index_pr_->AccessForceNotNull(index_offset);
-      uint8_t type_size = type::TypeUtil::GetTypeTrueSize(index_info->cols_[index_col_idx].Type());
-      std::memcpy(index_data, table_pr->AccessForceNotNull(table_offset), type_size);
-    }
-  }
-  // Insert into index
-  index_info->index_ptr_->Insert(exec_ctx_->GetTxn(), *index_info->index_pr_, slot);
+byte *TableReader::WriteIndexEntries(
+    const IndexInfo &index_info, storage::ProjectedColumns *rows, const std::vector<uint16_t> &table_offsets,
+    const storage::TupleSlot *slots,
+    std::vector<std::pair<const storage::ProjectedRow *, storage::TupleSlot>> *entries) {
+  const auto &index_pri = index_info.index_ptr_->GetProjectedRowInitializer();
+  const uint32_t key_size = storage::StorageUtil::PadUpToSize(sizeof(uint64_t), index_pri.ProjectedRowSize());
+  byte *key_buffer = common::AllocationUtil::AllocateAligned(key_size * rows->NumTuples());
+  for (uint32_t i = 0; i < rows->NumTuples(); i++) {
+    auto table_row = rows->InterpretAsRow(i);
+    auto *index_pr = index_pri.InitializeRow(key_buffer + i * key_size);
+    for (uint32_t index_col_idx = 0; index_col_idx < index_info.offsets_.size(); index_col_idx++) {
+      // Get the offset of this column in the table
+      uint16_t table_col_idx = index_info.index_map_[index_col_idx];
+      uint16_t table_offset = table_offsets[table_col_idx];
+      // Get the offset of this column in the index
+      uint16_t index_offset = index_info.offsets_[index_col_idx];
+      // Check null and write bytes.
+      if (index_info.cols_[index_col_idx].Nullable() && table_row.IsNull(table_offset)) {
+        index_pr->SetNull(index_offset);
+      } else {
+        byte *index_data = index_pr->AccessForceNotNull(index_offset);
+        uint8_t type_size = type::TypeUtil::GetTypeTrueSize(index_info.cols_[index_col_idx].Type());
+        std::memcpy(index_data, table_row.AccessForceNotNull(table_offset), type_size);
+      }
+    }
+    entries->emplace_back(index_pr, slots[i]);
+  }
+  return key_buffer;
 }
 
-void TableReader::WriteTableCol(storage::ProjectedRow *insert_pr, uint16_t col_offset, type::TypeId type,
-                                csv::CSVField *field) {
-  if (*field == NULL_STRING) {
-    insert_pr->SetNull(col_offset);
+void TableReader::WriteTableCol(storage::ProjectedColumns::RowView *row, uint16_t col_offset, type::TypeId type,
+                                const std::string_view field) {
+  if (field == NULL_STRING) {
+    row->SetNull(col_offset);
     return;
   }
-  byte *insert_offset = insert_pr->AccessForceNotNull(col_offset);
+  byte *insert_offset = row->AccessForceNotNull(col_offset);
   switch (type) {
     case type::TypeId::TINYINT: {
-      auto val = field->get<int8_t>();
+      auto val = ParseInteger<int8_t>(field);
       std::memcpy(insert_offset, &val, sizeof(int8_t));
       break;
     }
     case type::TypeId::SMALLINT: {
-      auto val = field->get<int16_t>();
+      auto val = ParseInteger<int16_t>(field);
       std::memcpy(insert_offset, &val, sizeof(int16_t));
       break;
     }
     case type::TypeId::INTEGER: {
-      auto val = field->get<int32_t>();
+      auto val = ParseInteger<int32_t>(field);
       std::memcpy(insert_offset, &val, sizeof(int32_t));
       break;
     }
     case type::TypeId::BIGINT: {
-      auto val = field->get<int64_t>();
+      auto val = ParseInteger<int64_t>(field);
       std::memcpy(insert_offset, &val, sizeof(int64_t));
       break;
     }
     case type::TypeId::REAL: {
-      auto val = field->get<double>();
+      auto val = ParseReal(field);
       std::memcpy(insert_offset, &val, sizeof(double));
       break;
     }
     case type::TypeId::DATE: {
-      auto val = sql::Date::FromString(field->get<std::string>());
+      auto val = sql::Date::FromString(field);
       std::memcpy(insert_offset, &val, sizeof(uint32_t));
       break;
     }
     case type::TypeId::VARCHAR: {
-      auto val = field->get<std::string_view>();
-      auto content_size = static_cast<uint32_t>(val.size());
+      auto content_size = static_cast<uint32_t>(field.size());
       if (content_size <= storage::VarlenEntry::InlineThreshold()) {
         *reinterpret_cast<storage::VarlenEntry *>(insert_offset) =
-            storage::VarlenEntry::CreateInline(reinterpret_cast<const byte *>(val.data()), content_size);
+            storage::VarlenEntry::CreateInline(reinterpret_cast<const byte *>(field.data()), content_size);
       } else {
         // TODO(Amadou): Use execCtx allocator
-        auto content = common::AllocationUtil::AllocateAligned(content_size);
-        std::memcpy(content, val.data(), content_size);
+        auto content = storage::VarlenAllocator::Allocate(content_size);
+        std::memcpy(content, field.data(), content_size);
         *reinterpret_cast<storage::VarlenEntry *>(insert_offset) =
             storage::VarlenEntry::Create(content, content_size, true);
       }
@@ -52,11 +52,6 @@ struct IndexInfo {
    * Precomputed offsets into the projected row
    */
   std::vector<uint16_t> offsets_{};
-
-  /**
-   * Projected row to use for inserts
-   */
-  storage::ProjectedRow *index_pr_;
 };
 
 /**
@@ -3,21 +3,21 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include "execution/exec/execution_context.h"
 #include "execution/table_generator/schema_reader.h"
+#include "storage/projected_columns.h"
 #include "transaction/transaction_context.h"
 #include "type/type_id.h"
 
-// Forward declaration
-namespace csv {
-class CSVField;
-}
-
 namespace noisepage::execution::sql {
 /**
- * This class reads table from files
+ * This class reads table from files. The data file is read a few chunks at a time. The records of every chunk are
+ * parsed on their own worker thread into batches of rows, which are inserted into the table a batch at a time. Indexes
+ * are built once all rows are in the table, by bulk loading them.
  */
 class TableReader {
  public:
@@ -31,10 +31,12 @@ class TableReader {
       : exec_ctx_{exec_ctx}, store_{store}, ns_oid_{ns_oid} {}
 
   /**
-   * Read a table given a schema file and a data file
+   * Read a table given a schema file and a data file. The fields of the data file are separated by one of ',', '|',
+   * '\t' or ';', whichever its first record suggests, and may be quoted with '"'. A first record that holds the names
+   * of the columns is skipped.
    * @param schema_file file containing the schema
    * @param data_file csv file containing the data
-   * @return
+   * @return the number of rows read
    */
   uint32_t ReadTable(const std::string &schema_file, const std::string &data_file);
 
@@ -45,12 +47,19 @@ class TableReader {
   // Create indexes
   void CreateIndexes(TableInfo *info, catalog::table_oid_t table_oid);
 
+  // Parse the records of a chunk of the data file into batches of rows, allocated from the initializer
+  static void ParseChunk(std::string_view chunk, char delimiter, const TableInfo &info,
+                         const std::vector<uint16_t> &table_offsets,
+                         const storage::ProjectedColumnsInitializer &initializer, std::vector<byte *> *batches);
+
   // Writes a column according to its type.
-  void WriteTableCol(storage::ProjectedRow *insert_pr, uint16_t col_offset, type::TypeId type, csv::CSVField *field);
+  static void WriteTableCol(storage::ProjectedColumns::RowView *row, uint16_t col_offset, type::TypeId type,
+                            std::string_view field);
 
-  // Write an index entry
-  void WriteIndexEntry(IndexInfo *index_info, storage::ProjectedRow *table_pr,
-                       const std::vector<uint16_t> &table_offsets, const storage::TupleSlot &slot);
+  // Write the index entries of a batch of inserted rows into a new key buffer
+  static byte *WriteIndexEntries(const IndexInfo &index_info, storage::ProjectedColumns *rows,
+                                 const std::vector<uint16_t> &table_offsets, const storage::TupleSlot *slots,
+                                 std::vector<std::pair<const storage::ProjectedRow *, storage::TupleSlot>> *entries);
 
  private:
   // Postgres NULL string